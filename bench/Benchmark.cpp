@@ -0,0 +1,515 @@
+/*
+ * Benchmark.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkHelper.h"
+#include <LLGL/Version.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/* ----- Configuration ----- */
+
+struct BenchmarkConfig
+{
+    std::uint32_t   numFrames           = 60;       // Number of frames for each rendering scenario
+    std::uint32_t   numDrawCalls        = 2000;     // Number of draw calls per frame ("draw_calls", "state_changes", "resource_heaps")
+    std::uint32_t   numResourceHeaps    = 64;       // Number of different resource heaps ("resource_heaps")
+    std::uint32_t   numPipelines        = 64;       // Number of pipelines to create ("pipeline_creation")
+    std::uint32_t   numUploads          = 256;      // Number of buffer updates ("buffer_upload")
+    std::uint32_t   uploadSize          = (1 << 20);// Size (in bytes) of each buffer update ("buffer_upload")
+    std::uint32_t   numReadbacks        = 16;       // Number of texture readbacks ("texture_readback")
+    std::uint32_t   textureSize         = 1024;     // Width and height of the textures ("texture_readback", "mip_generation")
+    std::uint32_t   numMipTextures      = 8;        // Number of textures ("mip_generation")
+};
+
+// Result of a single benchmark scenario
+struct BenchmarkResult
+{
+    std::string     module;
+    std::string     scenario;
+    std::string     error;              // Error message if the scenario or module failed, empty otherwise
+    std::uint64_t   iterations  = 0;    // Number of operations that have been measured (e.g. draw calls or bytes)
+    double          totalMs     = 0.0;  // Total duration in milliseconds
+    std::string     unit;               // Unit of the operations (e.g. "draws" or "bytes")
+};
+
+
+/* ----- Benchmark class ----- */
+
+class Benchmark
+{
+
+    public:
+
+        Benchmark(const std::string& module, const BenchmarkConfig& config) :
+            module_ { module },
+            config_ { config }
+        {
+        }
+
+        ~Benchmark()
+        {
+            if (renderer_)
+                LLGL::RenderSystem::Unload(std::move(renderer_));
+        }
+
+        // Loads the render system and creates all resources that are shared by the scenarios.
+        void Load()
+        {
+            renderer_ = LLGL::RenderSystem::Load(module_);
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution            = { 640, 480 };
+                contextDesc.vsync.enabled                   = false;
+                contextDesc.profileOpenGL.contextProfile    = LLGL::OpenGLContextProfile::CoreProfile;
+            }
+            context_    = renderer_->CreateRenderContext(contextDesc);
+            queue_      = renderer_->GetCommandQueue();
+            commands_   = renderer_->CreateCommandBuffer();
+
+            CreateVertexBuffer();
+            shaderProgram_ = CreateTriangleShaderProgram(*renderer_, vertexFormat_);
+            CreatePipelineLayout();
+            CreatePipelines();
+        }
+
+        // Runs all scenarios and appends their results.
+        void Run(std::vector<BenchmarkResult>& results)
+        {
+            RunScenario(results, "draw_calls",          "draws",        std::bind(&Benchmark::TestDrawCalls,        this));
+            RunScenario(results, "state_changes",       "draws",        std::bind(&Benchmark::TestStateChanges,     this));
+            RunScenario(results, "resource_heaps",      "bindings",     std::bind(&Benchmark::TestResourceHeaps,    this));
+            RunScenario(results, "buffer_upload",       "bytes",        std::bind(&Benchmark::TestBufferUpload,     this));
+            RunScenario(results, "texture_readback",    "bytes",        std::bind(&Benchmark::TestTextureReadback,  this));
+            RunScenario(results, "pipeline_creation",   "pipelines",    std::bind(&Benchmark::TestPipelineCreation, this));
+            RunScenario(results, "mip_generation",      "textures",     std::bind(&Benchmark::TestMipGeneration,    this));
+        }
+
+    private:
+
+        struct Vertex
+        {
+            float               position[2];
+            LLGL::ColorRGBAub   color;
+        };
+
+        void CreateVertexBuffer()
+        {
+            /* Create tiny triangle, so the scenarios are bound by the CPU and not by the rasterizer */
+            const float s = 0.01f;
+
+            Vertex vertices[] =
+            {
+                { {  0,  s }, { 255, 0, 0, 255 } },
+                { {  s, -s }, { 0, 255, 0, 255 } },
+                { { -s, -s }, { 0, 0, 255, 255 } },
+            };
+
+            vertexFormat_.AppendAttribute({ "position", LLGL::Format::RG32Float  });
+            vertexFormat_.AppendAttribute({ "color",    LLGL::Format::RGBA8UNorm });
+            vertexFormat_.stride = sizeof(Vertex);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type                 = LLGL::BufferType::Vertex;
+                bufferDesc.size                 = sizeof(vertices);
+                bufferDesc.vertexBuffer.format  = vertexFormat_;
+            }
+            vertexBuffer_ = renderer_->CreateBuffer(bufferDesc, vertices);
+        }
+
+        void CreatePipelineLayout()
+        {
+            /* Create layout with a single constant buffer, which does not have to be used by the shaders */
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings = { LLGL::BindingDescriptor{ LLGL::ResourceType::ConstantBuffer, LLGL::StageFlags::VertexStage, 0 } };
+            }
+            pipelineLayout_ = renderer_->CreatePipelineLayout(layoutDesc);
+
+            /* Create one constant buffer and resource heap for each binding */
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type = LLGL::BufferType::Constant;
+                bufferDesc.size = 256;
+            }
+            for (std::uint32_t i = 0; i < config_.numResourceHeaps; ++i)
+            {
+                auto buffer = renderer_->CreateBuffer(bufferDesc);
+
+                LLGL::ResourceHeapDescriptor heapDesc;
+                {
+                    heapDesc.pipelineLayout = pipelineLayout_;
+                    heapDesc.resourceViews  = { buffer };
+                }
+                resourceHeaps_.push_back(renderer_->CreateResourceHeap(heapDesc));
+            }
+        }
+
+        // Returns a graphics pipeline descriptor whose render states are varied by the specified index.
+        LLGL::GraphicsPipelineDescriptor GetPipelineDesc(std::uint32_t variant) const
+        {
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram          = shaderProgram_;
+                pipelineDesc.pipelineLayout         = pipelineLayout_;
+                pipelineDesc.rasterizer.cullMode    = ((variant & 1) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+                pipelineDesc.rasterizer.frontCCW    = ((variant & 2) != 0);
+                pipelineDesc.blend.blendEnabled     = ((variant & 4) != 0);
+                pipelineDesc.blend.targets.resize(1);
+                pipelineDesc.blend.targets[0].colorMask.a = ((variant & 8) == 0);
+            }
+            return pipelineDesc;
+        }
+
+        void CreatePipelines()
+        {
+            for (std::uint32_t i = 0; i < 2; ++i)
+                pipelines_[i] = renderer_->CreateGraphicsPipeline(GetPipelineDesc(i * 4));
+        }
+
+        // Measures the elapsed time of the specified callback (including all GPU work) and adds it to the duration of the current scenario.
+        void MeasureTime(const std::function<void()>& callback)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            {
+                callback();
+                queue_->WaitIdle();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            scenarioMs_ += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        // Renders the specified number of frames, where each frame calls the specified function before each draw call.
+        void RenderFrames(const std::function<void(std::uint32_t)>& drawCallback)
+        {
+            const auto& resolution = context_->GetVideoMode().resolution;
+
+            MeasureTime(
+                [&]()
+                {
+                    for (std::uint32_t frame = 0; frame < config_.numFrames; ++frame)
+                    {
+                        commands_->SetRenderTarget(*context_);
+                        commands_->SetViewport(LLGL::Viewport{ { 0, 0 }, resolution });
+                        commands_->Clear(LLGL::ClearFlags::Color);
+                        commands_->SetGraphicsPipeline(*pipelines_[0]);
+                        commands_->SetVertexBuffer(*vertexBuffer_);
+
+                        for (std::uint32_t i = 0; i < config_.numDrawCalls; ++i)
+                        {
+                            drawCallback(i);
+                            commands_->Draw(3, 0);
+                        }
+
+                        context_->Present();
+                    }
+                }
+            );
+        }
+
+        /* ----- Scenarios ----- */
+
+        std::uint64_t TestDrawCalls()
+        {
+            RenderFrames([](std::uint32_t) {});
+            return static_cast<std::uint64_t>(config_.numFrames) * config_.numDrawCalls;
+        }
+
+        std::uint64_t TestStateChanges()
+        {
+            RenderFrames(
+                [this](std::uint32_t i)
+                {
+                    commands_->SetGraphicsPipeline(*pipelines_[i % 2]);
+                }
+            );
+            return static_cast<std::uint64_t>(config_.numFrames) * config_.numDrawCalls;
+        }
+
+        std::uint64_t TestResourceHeaps()
+        {
+            RenderFrames(
+                [this](std::uint32_t i)
+                {
+                    commands_->SetGraphicsResourceHeap(*resourceHeaps_[i % resourceHeaps_.size()]);
+                }
+            );
+            return static_cast<std::uint64_t>(config_.numFrames) * config_.numDrawCalls;
+        }
+
+        std::uint64_t TestBufferUpload()
+        {
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type                 = LLGL::BufferType::Storage;
+                bufferDesc.size                 = config_.uploadSize;
+                bufferDesc.flags                = LLGL::BufferFlags::DynamicUsage;
+                bufferDesc.storageBuffer.stride = 4;
+            }
+            auto buffer = renderer_->CreateBuffer(bufferDesc);
+
+            std::vector<char> data(config_.uploadSize, 0x7F);
+
+            MeasureTime(
+                [&]()
+                {
+                    for (std::uint32_t i = 0; i < config_.numUploads; ++i)
+                        renderer_->WriteBuffer(*buffer, data.data(), data.size(), 0);
+                }
+            );
+
+            renderer_->Release(*buffer);
+
+            return static_cast<std::uint64_t>(config_.numUploads) * config_.uploadSize;
+        }
+
+        std::uint64_t TestTextureReadback()
+        {
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type    = LLGL::TextureType::Texture2D;
+                textureDesc.format  = LLGL::Format::RGBA8UNorm;
+                textureDesc.extent  = { config_.textureSize, config_.textureSize, 1 };
+            }
+            auto texture = renderer_->CreateTexture(textureDesc);
+
+            std::vector<LLGL::ColorRGBAub> image(config_.textureSize * config_.textureSize);
+            const LLGL::DstImageDescriptor imageDesc
+            {
+                LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), image.size() * sizeof(LLGL::ColorRGBAub)
+            };
+
+            MeasureTime(
+                [&]()
+                {
+                    for (std::uint32_t i = 0; i < config_.numReadbacks; ++i)
+                        renderer_->ReadTexture(*texture, 0, imageDesc);
+                }
+            );
+
+            renderer_->Release(*texture);
+
+            return static_cast<std::uint64_t>(config_.numReadbacks) * imageDesc.dataSize;
+        }
+
+        std::uint64_t TestPipelineCreation()
+        {
+            std::vector<LLGL::GraphicsPipeline*> pipelines;
+
+            MeasureTime(
+                [&]()
+                {
+                    for (std::uint32_t i = 0; i < config_.numPipelines; ++i)
+                        pipelines.push_back(renderer_->CreateGraphicsPipeline(GetPipelineDesc(i)));
+                }
+            );
+
+            for (auto pipeline : pipelines)
+                renderer_->Release(*pipeline);
+
+            return config_.numPipelines;
+        }
+
+        std::uint64_t TestMipGeneration()
+        {
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type    = LLGL::TextureType::Texture2D;
+                textureDesc.format  = LLGL::Format::RGBA8UNorm;
+                textureDesc.extent  = { config_.textureSize, config_.textureSize, 1 };
+            }
+
+            std::vector<LLGL::Texture*> textures;
+            for (std::uint32_t i = 0; i < config_.numMipTextures; ++i)
+                textures.push_back(renderer_->CreateTexture(textureDesc));
+
+            MeasureTime(
+                [&]()
+                {
+                    for (auto texture : textures)
+                        renderer_->GenerateMips(*texture);
+                }
+            );
+
+            for (auto texture : textures)
+                renderer_->Release(*texture);
+
+            return config_.numMipTextures;
+        }
+
+        void RunScenario(
+            std::vector<BenchmarkResult>&           results,
+            const char*                             scenario,
+            const char*                             unit,
+            const std::function<std::uint64_t()>&   callback)
+        {
+            BenchmarkResult result;
+            {
+                result.module   = module_;
+                result.scenario = scenario;
+                result.unit     = unit;
+            }
+
+            std::cerr << "run " << module_ << '/' << scenario << " ..." << std::endl;
+
+            try
+            {
+                /* Only the sections within MeasureTime are accumulated, so the creation of temporary resources is excluded */
+                scenarioMs_         = 0.0;
+                result.iterations   = callback();
+                result.totalMs      = scenarioMs_;
+            }
+            catch (const std::exception& e)
+            {
+                result.error = e.what();
+            }
+
+            results.push_back(result);
+        }
+
+    private:
+
+        std::string                         module_;
+        BenchmarkConfig                     config_;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer_;
+        LLGL::RenderContext*                context_            = nullptr;
+        LLGL::CommandQueue*                 queue_              = nullptr;
+        LLGL::CommandBuffer*                commands_           = nullptr;
+
+        LLGL::VertexFormat                  vertexFormat_;
+        LLGL::Buffer*                       vertexBuffer_       = nullptr;
+        LLGL::ShaderProgram*                shaderProgram_      = nullptr;
+        LLGL::PipelineLayout*               pipelineLayout_     = nullptr;
+        LLGL::GraphicsPipeline*             pipelines_[2]       = {};
+        std::vector<LLGL::ResourceHeap*>    resourceHeaps_;
+
+        double                              scenarioMs_         = 0.0;
+
+};
+
+
+/* ----- JSON output ----- */
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<BenchmarkResult>& results)
+{
+    s << "{\n";
+    s << "  \"version\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+
+        s << (i > 0 ? ",\n" : "\n");
+        s << "    { \"module\": \"" << EscapeJSON(r.module) << "\", \"scenario\": \"" << EscapeJSON(r.scenario) << '\"';
+
+        if (r.error.empty())
+        {
+            const auto perSecond = (r.totalMs > 0.0 ? static_cast<double>(r.iterations) * 1000.0 / r.totalMs : 0.0);
+            s << ", \"iterations\": " << r.iterations;
+            s << ", \"unit\": \"" << EscapeJSON(r.unit) << '\"';
+            s << ", \"total_ms\": " << r.totalMs;
+            s << ", \"per_second\": " << perSecond;
+        }
+        else
+            s << ", \"error\": \"" << EscapeJSON(r.error) << '\"';
+
+        s << " }";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+
+/* ----- Main ----- */
+
+static void PrintHelp()
+{
+    std::cerr << "usage: Benchmark [--output FILE] [--frames N] [--draws N] [MODULE ...]" << std::endl;
+    std::cerr << "  Runs all scenarios against each specified module (by default all modules from LLGL::RenderSystem::FindModules)," << std::endl;
+    std::cerr << "  and writes the results as JSON to FILE (by default to the standard output)." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig             config;
+    std::string                 outputFile;
+    std::vector<std::string>    modules;
+
+    /* Parse command line arguments */
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else if (arg == "--output" && i + 1 < argc)
+            outputFile = argv[++i];
+        else if (arg == "--frames" && i + 1 < argc)
+            config.numFrames = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--draws" && i + 1 < argc)
+            config.numDrawCalls = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else
+            modules.push_back(arg);
+    }
+
+    if (modules.empty())
+        modules = LLGL::RenderSystem::FindModules();
+
+    /* Run benchmark for each module; failing modules are reported in the results */
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& module : modules)
+    {
+        try
+        {
+            Benchmark benchmark { module, config };
+            benchmark.Load();
+            benchmark.Run(results);
+        }
+        catch (const std::exception& e)
+        {
+            BenchmarkResult result;
+            {
+                result.module   = module;
+                result.scenario = "load";
+                result.error    = e.what();
+            }
+            results.push_back(result);
+        }
+    }
+
+    /* Write results */
+    if (outputFile.empty())
+        WriteResultsJSON(std::cout, results);
+    else
+    {
+        std::ofstream file { outputFile };
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << outputFile << std::endl;
+            return 1;
+        }
+        WriteResultsJSON(file, results);
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,120 @@
+/*
+ * BenchmarkHelper.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BENCHMARK_HELPER_H
+#define LLGL_BENCHMARK_HELPER_H
+
+
+#include <LLGL/LLGL.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+#ifndef LLGL_BENCHMARK_SHADER_PATH
+#define LLGL_BENCHMARK_SHADER_PATH ""
+#endif
+
+
+// Returns the specified string with all JSON control characters escaped.
+inline std::string EscapeJSON(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size());
+
+    for (auto c : s)
+    {
+        switch (c)
+        {
+            case '\"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+                break;
+        }
+    }
+
+    return out;
+}
+
+// Returns true if the specified render system supports the specified shading language.
+inline bool HasShadingLanguage(const LLGL::RenderSystem& renderer, const LLGL::ShadingLanguage language)
+{
+    const auto& languages = renderer.GetRenderingCaps().shadingLanguages;
+    return (std::find(languages.begin(), languages.end(), language) != languages.end());
+}
+
+// Returns the path of the specified shader file from the first tutorial.
+inline std::string GetShaderPath(const char* filename)
+{
+    return (std::string(LLGL_BENCHMARK_SHADER_PATH) + filename);
+}
+
+/*
+Creates the shader program of the first tutorial (Tutorial01_HelloTriangle) for the specified render system,
+which expects a vertex format with a "position" (RG32Float) and a "color" (RGBA8UNorm) attribute.
+*/
+inline LLGL::ShaderProgram* CreateTriangleShaderProgram(LLGL::RenderSystem& renderer, const LLGL::VertexFormat& vertexFormat)
+{
+    LLGL::Shader* vertShader = nullptr;
+    LLGL::Shader* fragShader = nullptr;
+
+    if (HasShadingLanguage(renderer, LLGL::ShadingLanguage::GLSL))
+    {
+        auto vertFile = GetShaderPath("vertex.glsl"), fragFile = GetShaderPath("fragment.glsl");
+        vertShader = renderer.CreateShader({ LLGL::ShaderType::Vertex,   vertFile.c_str() });
+        fragShader = renderer.CreateShader({ LLGL::ShaderType::Fragment, fragFile.c_str() });
+    }
+    else if (HasShadingLanguage(renderer, LLGL::ShadingLanguage::SPIRV))
+    {
+        auto vertFile = GetShaderPath("vertex.450core.spv"), fragFile = GetShaderPath("fragment.450core.spv");
+        LLGL::ShaderDescriptor vertDesc { LLGL::ShaderType::Vertex,   vertFile.c_str() };
+        LLGL::ShaderDescriptor fragDesc { LLGL::ShaderType::Fragment, fragFile.c_str() };
+        vertDesc.sourceType = LLGL::ShaderSourceType::BinaryFile;
+        fragDesc.sourceType = LLGL::ShaderSourceType::BinaryFile;
+        vertShader = renderer.CreateShader(vertDesc);
+        fragShader = renderer.CreateShader(fragDesc);
+    }
+    else if (HasShadingLanguage(renderer, LLGL::ShadingLanguage::HLSL))
+    {
+        auto file = GetShaderPath("shader.hlsl");
+        vertShader = renderer.CreateShader({ LLGL::ShaderType::Vertex,   file.c_str(), "VS", "vs_5_0" });
+        fragShader = renderer.CreateShader({ LLGL::ShaderType::Fragment, file.c_str(), "PS", "ps_5_0" });
+    }
+    else
+        throw std::runtime_error("no supported shading language for benchmark shaders");
+
+    for (auto shader : { vertShader, fragShader })
+    {
+        if (shader->HasErrors())
+            throw std::runtime_error(shader->QueryInfoLog());
+    }
+
+    LLGL::ShaderProgramDescriptor programDesc;
+    {
+        programDesc.vertexFormats   = { vertexFormat };
+        programDesc.vertexShader    = vertShader;
+        programDesc.fragmentShader  = fragShader;
+    }
+    auto shaderProgram = renderer.CreateShaderProgram(programDesc);
+
+    if (shaderProgram->HasErrors())
+        throw std::runtime_error(shaderProgram->QueryInfoLog());
+
+    return shaderProgram;
+}
+
+
+#endif
+
+
+
+// ================================================================================
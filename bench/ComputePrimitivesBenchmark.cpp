@@ -0,0 +1,349 @@
+/*
+ * ComputePrimitivesBenchmark.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkHelper.h"
+#include <LLGL/ComputePrimitives.h>
+#include <LLGL/Version.h>
+#include <LLGL/Timer.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/* ----- Configuration ----- */
+
+struct SortConfig
+{
+    std::uint32_t               numIterations   = 10;       // Number of measured iterations per element count
+    std::uint32_t               numWarmups      = 2;        // Number of iterations before the measurement starts
+    std::vector<std::uint32_t>  elementCounts   = { 1u << 14, 1u << 17, 1u << 20, 1u << 22 };
+};
+
+// Mean duration (in milliseconds) of sorting a number of keys on the GPU and with std::sort on the CPU
+struct SortStatistics
+{
+    std::string     module;
+    std::string     error;              // Error message if the module failed, empty otherwise
+    std::uint32_t   numElements = 0;
+    bool            valid       = false;
+    double          gpuMs       = 0.0;
+    double          gpuPairsMs  = 0.0;
+    double          cpuMs       = 0.0;
+};
+
+static double TicksToMs(std::uint64_t ticks)
+{
+    return static_cast<double>(ticks) * 1000.0 / static_cast<double>(LLGL::Timer::GetTickFrequency());
+}
+
+
+/* ----- Compute primitives benchmark class ----- */
+
+class ComputePrimitivesBenchmark
+{
+
+    public:
+
+        ComputePrimitivesBenchmark(const std::string& module, const SortConfig& config) :
+            module_ { module },
+            config_ { config }
+        {
+        }
+
+        ~ComputePrimitivesBenchmark()
+        {
+            compute_.reset();
+            if (renderer_)
+                LLGL::RenderSystem::Unload(std::move(renderer_));
+        }
+
+        // Loads the render system and creates the compute primitives for the largest element count.
+        void Load()
+        {
+            renderer_ = LLGL::RenderSystem::Load(module_);
+
+            /* Render context is only required to create the device, its window is never shown */
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution            = { 64, 64 };
+                contextDesc.profileOpenGL.contextProfile    = LLGL::OpenGLContextProfile::CoreProfile;
+                contextDesc.profileOpenGL.majorVersion      = 4;
+                contextDesc.profileOpenGL.minorVersion      = 3;
+            }
+            renderer_->CreateRenderContext(contextDesc);
+
+            commands_   = renderer_->CreateCommandBuffer();
+            queue_      = renderer_->GetCommandQueue();
+
+            for (auto n : config_.elementCounts)
+                maxNumElements_ = std::max(maxNumElements_, n);
+
+            LLGL::ComputePrimitivesDescriptor computeDesc;
+            {
+                computeDesc.maxNumElements = maxNumElements_;
+            }
+            compute_ = std::unique_ptr<LLGL::ComputePrimitives>(new LLGL::ComputePrimitives{ *renderer_, computeDesc });
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type                         = LLGL::BufferType::Storage;
+                bufferDesc.size                         = maxNumElements_ * sizeof(std::uint32_t);
+                bufferDesc.flags                        = LLGL::BufferFlags::MapReadAccess | LLGL::BufferFlags::MapWriteAccess;
+                bufferDesc.storageBuffer.storageType    = LLGL::StorageBufferType::RWStructuredBuffer;
+                bufferDesc.storageBuffer.stride         = sizeof(std::uint32_t);
+            }
+            keyBuffer_      = renderer_->CreateBuffer(bufferDesc);
+            valueBuffer_    = renderer_->CreateBuffer(bufferDesc);
+        }
+
+        // Sorts random keys of each element count and appends the statistics.
+        void Run(std::vector<SortStatistics>& results)
+        {
+            for (auto n : config_.elementCounts)
+            {
+                std::cerr << "run " << module_ << "/" << n << " ..." << std::endl;
+
+                SortStatistics stats;
+                {
+                    stats.module        = module_;
+                    stats.numElements   = n;
+                }
+
+                GenerateKeys(n);
+
+                /* Measure GPU sort of keys and key-value pairs, and validate the result of the last iteration */
+                stats.gpuMs         = MeasureGPU(n, false);
+                stats.gpuPairsMs    = MeasureGPU(n, true);
+                stats.valid         = ValidateResult(n);
+
+                /* Measure CPU sort of the same keys */
+                std::uint64_t cpuTicks = 0;
+                for (std::uint32_t i = 0; i < config_.numIterations; ++i)
+                {
+                    auto keys = keys_;
+                    const auto startTick = LLGL::Timer::Tick();
+                    std::sort(keys.begin(), keys.end());
+                    cpuTicks += LLGL::Timer::Tick() - startTick;
+                }
+                stats.cpuMs = TicksToMs(cpuTicks) / config_.numIterations;
+
+                results.push_back(stats);
+            }
+        }
+
+    private:
+
+        void GenerateKeys(std::uint32_t numElements)
+        {
+            std::mt19937 rng { numElements };
+            keys_.resize(numElements);
+            for (auto& key : keys_)
+                key = rng();
+        }
+
+        void UploadKeys(bool withValues)
+        {
+            const auto size = keys_.size() * sizeof(std::uint32_t);
+
+            renderer_->WriteBuffer(*keyBuffer_, keys_.data(), size, 0);
+
+            if (withValues)
+            {
+                std::vector<std::uint32_t> values(keys_.size());
+                for (std::size_t i = 0; i < values.size(); ++i)
+                    values[i] = static_cast<std::uint32_t>(i);
+                renderer_->WriteBuffer(*valueBuffer_, values.data(), size, 0);
+            }
+        }
+
+        // Returns the mean duration (in milliseconds) from recording until the GPU has completed the sort.
+        double MeasureGPU(std::uint32_t numElements, bool withValues)
+        {
+            std::uint64_t gpuTicks = 0;
+
+            for (std::uint32_t i = 0; i < config_.numWarmups + config_.numIterations; ++i)
+            {
+                UploadKeys(withValues);
+                queue_->WaitIdle();
+
+                const auto startTick = LLGL::Timer::Tick();
+                {
+                    if (withValues)
+                        compute_->RadixSort(*commands_, *keyBuffer_, *valueBuffer_, numElements);
+                    else
+                        compute_->RadixSort(*commands_, *keyBuffer_, numElements);
+                    queue_->Submit(*commands_);
+                    queue_->WaitIdle();
+                }
+                if (i >= config_.numWarmups)
+                    gpuTicks += LLGL::Timer::Tick() - startTick;
+            }
+
+            return TicksToMs(gpuTicks) / config_.numIterations;
+        }
+
+        // Returns true if the keys in the GPU buffer are sorted and the values refer to the original keys.
+        bool ValidateResult(std::uint32_t numElements)
+        {
+            std::vector<std::uint32_t> keys(numElements), values(numElements);
+
+            if (auto data = renderer_->MapBuffer(*keyBuffer_, LLGL::CPUAccess::ReadOnly, 0, numElements * sizeof(std::uint32_t)))
+            {
+                std::memcpy(keys.data(), data, numElements * sizeof(std::uint32_t));
+                renderer_->UnmapBuffer(*keyBuffer_);
+            }
+            if (auto data = renderer_->MapBuffer(*valueBuffer_, LLGL::CPUAccess::ReadOnly, 0, numElements * sizeof(std::uint32_t)))
+            {
+                std::memcpy(values.data(), data, numElements * sizeof(std::uint32_t));
+                renderer_->UnmapBuffer(*valueBuffer_);
+            }
+
+            for (std::uint32_t i = 0; i < numElements; ++i)
+            {
+                if (i > 0 && keys[i - 1] > keys[i])
+                    return false;
+                if (values[i] >= numElements || keys_[values[i]] != keys[i])
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+
+        std::string                                 module_;
+        SortConfig                                  config_;
+
+        std::unique_ptr<LLGL::RenderSystem>         renderer_;
+        LLGL::CommandBuffer*                        commands_       = nullptr;
+        LLGL::CommandQueue*                         queue_          = nullptr;
+        std::unique_ptr<LLGL::ComputePrimitives>    compute_;
+        std::uint32_t                               maxNumElements_ = 0;
+
+        LLGL::Buffer*                               keyBuffer_      = nullptr;
+        LLGL::Buffer*                               valueBuffer_    = nullptr;
+        std::vector<std::uint32_t>                  keys_;
+
+};
+
+
+/* ----- JSON output ----- */
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<SortStatistics>& results)
+{
+    s << "{\n";
+    s << "  \"version\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+
+        s << (i > 0 ? ",\n" : "\n");
+        s << "    { \"module\": \"" << EscapeJSON(r.module) << '\"';
+
+        if (r.error.empty())
+        {
+            s << ", \"elements\": " << r.numElements;
+            s << ", \"valid\": " << (r.valid ? "true" : "false");
+            s << ", \"gpu_keys_ms\": " << r.gpuMs;
+            s << ", \"gpu_pairs_ms\": " << r.gpuPairsMs;
+            s << ", \"cpu_std_sort_ms\": " << r.cpuMs;
+        }
+        else
+            s << ", \"error\": \"" << EscapeJSON(r.error) << '\"';
+
+        s << " }";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+
+/* ----- Main ----- */
+
+static void PrintHelp()
+{
+    std::cerr << "usage: ComputePrimitivesBenchmark [--output FILE] [--elements N] [--iterations N] [MODULE ...]" << std::endl;
+    std::cerr << "  Measures the duration of LLGL::ComputePrimitives::RadixSort (keys and key-value pairs) against std::sort (in milliseconds)" << std::endl;
+    std::cerr << "  for each specified module (by default all modules from LLGL::RenderSystem::FindModules)." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    SortConfig                  config;
+    std::string                 outputFile;
+    std::vector<std::string>    modules;
+
+    /* Parse command line arguments */
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else if (arg == "--output" && i + 1 < argc)
+            outputFile = argv[++i];
+        else if (arg == "--elements" && i + 1 < argc)
+            config.elementCounts = { static_cast<std::uint32_t>(std::stoul(argv[++i])) };
+        else if (arg == "--iterations" && i + 1 < argc)
+            config.numIterations = std::max(1u, static_cast<std::uint32_t>(std::stoul(argv[++i])));
+        else
+            modules.push_back(arg);
+    }
+
+    if (modules.empty())
+        modules = LLGL::RenderSystem::FindModules();
+
+    /* Run benchmark for each module */
+    std::vector<SortStatistics> results;
+
+    for (const auto& module : modules)
+    {
+        try
+        {
+            ComputePrimitivesBenchmark benchmark { module, config };
+            benchmark.Load();
+            benchmark.Run(results);
+        }
+        catch (const std::exception& e)
+        {
+            SortStatistics stats;
+            {
+                stats.module    = module;
+                stats.error     = e.what();
+            }
+            results.push_back(stats);
+        }
+    }
+
+    /* Write results */
+    if (outputFile.empty())
+        WriteResultsJSON(std::cout, results);
+    else
+    {
+        std::ofstream file { outputFile };
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << outputFile << std::endl;
+            return 1;
+        }
+        WriteResultsJSON(file, results);
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
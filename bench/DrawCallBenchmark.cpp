@@ -0,0 +1,511 @@
+/*
+ * DrawCallBenchmark.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkHelper.h"
+#include <LLGL/Version.h>
+#include <LLGL/Timer.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/RenderingDebugger.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/* ----- Configuration ----- */
+
+struct DrawCallConfig
+{
+    std::uint32_t   numFrames           = 20;       // Number of measured frames per pass
+    std::uint32_t   numWarmupFrames     = 4;        // Number of frames that are rendered before the measurement starts
+    std::uint32_t   numObjects          = 10000;    // Number of tiny objects per frame, i.e. one draw call per object
+    std::uint32_t   numResourceHeaps    = 64;       // Number of resource heaps that are alternated between objects
+    std::uint32_t   switchInterval      = 8;        // Number of objects between two pipeline switches
+};
+
+// Statistics of the CPU cost of a single command buffer function
+struct CallStatistics
+{
+    std::string     module;
+    bool            debugLayer  = false;
+    std::string     pass;
+    std::string     call;
+    std::string     error;              // Error message if the module failed, empty otherwise
+    std::size_t     samples     = 0;
+    double          meanNs      = 0.0;
+    double          p50Ns       = 0.0;
+    double          p90Ns       = 0.0;
+    double          p99Ns       = 0.0;
+    double          maxNs       = 0.0;
+};
+
+
+/* ----- Sample recorder ----- */
+
+/*
+Records the duration (in nanoseconds) of individual command buffer calls with the non-virtual LLGL::Timer::Tick function.
+The constant overhead of the timer itself is measured once and subtracted from each sample.
+*/
+class CallRecorder
+{
+
+    public:
+
+        CallRecorder()
+        {
+            nsPerTick_ = 1.0e9 / static_cast<double>(LLGL::Timer::GetTickFrequency());
+            Calibrate();
+        }
+
+        // Measures the specified callback and appends its duration to the specified samples.
+        template <typename Callback>
+        void Measure(std::vector<double>& samples, Callback callback)
+        {
+            const auto startTick = LLGL::Timer::Tick();
+            {
+                callback();
+            }
+            const auto ticks = LLGL::Timer::Tick() - startTick;
+            samples.push_back(std::max(0.0, static_cast<double>(ticks) * nsPerTick_ - overheadNs_));
+        }
+
+    private:
+
+        // Determines the median duration of an empty measurement.
+        void Calibrate()
+        {
+            std::vector<double> samples;
+            samples.reserve(1000);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const auto startTick = LLGL::Timer::Tick();
+                samples.push_back(static_cast<double>(LLGL::Timer::Tick() - startTick) * nsPerTick_);
+            }
+
+            std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+            overheadNs_ = samples[samples.size() / 2];
+        }
+
+    private:
+
+        double  nsPerTick_  = 1.0;
+        double  overheadNs_ = 0.0;
+
+};
+
+// Returns the statistics of the specified samples, which are sorted in place.
+static CallStatistics GetStatistics(std::vector<double>& samples)
+{
+    CallStatistics stats;
+
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    auto percentile = [&samples](double p)
+    {
+        const auto idx = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[idx];
+    };
+
+    double sum = 0.0;
+    for (auto s : samples)
+        sum += s;
+
+    stats.samples   = samples.size();
+    stats.meanNs    = sum / static_cast<double>(samples.size());
+    stats.p50Ns     = percentile(0.50);
+    stats.p90Ns     = percentile(0.90);
+    stats.p99Ns     = percentile(0.99);
+    stats.maxNs     = samples.back();
+
+    return stats;
+}
+
+
+/* ----- Draw call benchmark class ----- */
+
+class DrawCallBenchmark
+{
+
+    public:
+
+        DrawCallBenchmark(const std::string& module, bool debugLayer, const DrawCallConfig& config) :
+            module_     { module     },
+            debugLayer_ { debugLayer },
+            config_     { config     }
+        {
+        }
+
+        ~DrawCallBenchmark()
+        {
+            if (renderer_)
+                LLGL::RenderSystem::Unload(std::move(renderer_));
+        }
+
+        // Loads the render system (optionally with the debug layer, i.e. DbgRenderSystem) and creates all resources.
+        void Load()
+        {
+            if (debugLayer_)
+                renderer_ = LLGL::RenderSystem::Load(module_, &profiler_, &debugger_);
+            else
+                renderer_ = LLGL::RenderSystem::Load(module_);
+
+            /* Render context is only used to submit the frames, its window is never shown */
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution            = { 256, 256 };
+                contextDesc.vsync.enabled                   = false;
+                contextDesc.profileOpenGL.contextProfile    = LLGL::OpenGLContextProfile::CoreProfile;
+            }
+            context_    = renderer_->CreateRenderContext(contextDesc);
+            commands_   = renderer_->CreateCommandBuffer();
+
+            CreateRenderTarget();
+            CreateGeometry();
+            CreateResourceHeaps();
+            CreatePipelines();
+        }
+
+        // Renders all passes and appends the statistics of each measured call.
+        void Run(std::vector<CallStatistics>& results)
+        {
+            RunPass(results, "draw_only",   false);
+            RunPass(results, "interleaved", true);
+        }
+
+    private:
+
+        struct Vertex
+        {
+            float               position[2];
+            LLGL::ColorRGBAub   color;
+        };
+
+        void CreateRenderTarget()
+        {
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type    = LLGL::TextureType::Texture2D;
+                textureDesc.format  = LLGL::Format::RGBA8UNorm;
+                textureDesc.flags   = LLGL::TextureFlags::AttachmentUsage;
+                textureDesc.extent  = { 256, 256, 1 };
+            }
+            auto colorTexture = renderer_->CreateTexture(textureDesc);
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution     = { 256, 256 };
+                renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, colorTexture } };
+            }
+            renderTarget_ = renderer_->CreateRenderTarget(renderTargetDesc);
+        }
+
+        void CreateGeometry()
+        {
+            /* Create tiny quad, so the draw calls are bound by the CPU and not by the rasterizer */
+            const float s = 0.005f;
+
+            Vertex vertices[] =
+            {
+                { { -s, -s }, { 255, 0, 0, 255 } },
+                { { -s,  s }, { 0, 255, 0, 255 } },
+                { {  s,  s }, { 0, 0, 255, 255 } },
+                { {  s, -s }, { 255, 255, 0, 255 } },
+            };
+
+            const std::uint16_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+            vertexFormat_.AppendAttribute({ "position", LLGL::Format::RG32Float  });
+            vertexFormat_.AppendAttribute({ "color",    LLGL::Format::RGBA8UNorm });
+            vertexFormat_.stride = sizeof(Vertex);
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.type                   = LLGL::BufferType::Vertex;
+                vertexBufferDesc.size                   = sizeof(vertices);
+                vertexBufferDesc.vertexBuffer.format    = vertexFormat_;
+            }
+            vertexBuffer_ = renderer_->CreateBuffer(vertexBufferDesc, vertices);
+
+            LLGL::BufferDescriptor indexBufferDesc;
+            {
+                indexBufferDesc.type                = LLGL::BufferType::Index;
+                indexBufferDesc.size                = sizeof(indices);
+                indexBufferDesc.indexBuffer.format  = LLGL::IndexFormat { LLGL::DataType::UInt16 };
+            }
+            indexBuffer_ = renderer_->CreateBuffer(indexBufferDesc, indices);
+        }
+
+        void CreateResourceHeaps()
+        {
+            /* Create layout with a single constant buffer, which does not have to be used by the shaders */
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings = { LLGL::BindingDescriptor{ LLGL::ResourceType::ConstantBuffer, LLGL::StageFlags::VertexStage, 0 } };
+            }
+            pipelineLayout_ = renderer_->CreatePipelineLayout(layoutDesc);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type = LLGL::BufferType::Constant;
+                bufferDesc.size = 256;
+            }
+            for (std::uint32_t i = 0; i < config_.numResourceHeaps; ++i)
+            {
+                LLGL::ResourceHeapDescriptor heapDesc;
+                {
+                    heapDesc.pipelineLayout = pipelineLayout_;
+                    heapDesc.resourceViews  = { renderer_->CreateBuffer(bufferDesc) };
+                }
+                resourceHeaps_.push_back(renderer_->CreateResourceHeap(heapDesc));
+            }
+        }
+
+        void CreatePipelines()
+        {
+            auto shaderProgram = CreateTriangleShaderProgram(*renderer_, vertexFormat_);
+
+            /* Create two pipelines with different render states, so each switch changes the native pipeline state */
+            for (std::uint32_t i = 0; i < 2; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.shaderProgram          = shaderProgram;
+                    pipelineDesc.pipelineLayout         = pipelineLayout_;
+                    pipelineDesc.renderTarget           = renderTarget_;
+                    pipelineDesc.rasterizer.cullMode    = (i == 0 ? LLGL::CullMode::Disabled : LLGL::CullMode::Front);
+                    pipelineDesc.blend.blendEnabled     = (i != 0);
+                    pipelineDesc.blend.targets.resize(1);
+                }
+                pipelines_[i] = renderer_->CreateGraphicsPipeline(pipelineDesc);
+            }
+        }
+
+        // Renders one frame with one draw call per object. If 'samples' is non-null, the individual calls are measured.
+        void RenderFrame(bool interleaved, std::vector<double>* samples)
+        {
+            commands_->SetRenderTarget(*renderTarget_);
+            commands_->SetViewport(LLGL::Viewport{ { 0, 0 }, renderTarget_->GetResolution() });
+            commands_->Clear(LLGL::ClearFlags::Color);
+            commands_->SetGraphicsPipeline(*pipelines_[0]);
+            commands_->SetVertexBuffer(*vertexBuffer_);
+            commands_->SetIndexBuffer(*indexBuffer_);
+            commands_->SetGraphicsResourceHeap(*resourceHeaps_[0]);
+
+            for (std::uint32_t i = 0; i < config_.numObjects; ++i)
+            {
+                if (interleaved)
+                {
+                    auto& resourceHeap = *resourceHeaps_[i % resourceHeaps_.size()];
+                    if (samples != nullptr)
+                        recorder_.Measure(samples[1], [&]() { commands_->SetGraphicsResourceHeap(resourceHeap); });
+                    else
+                        commands_->SetGraphicsResourceHeap(resourceHeap);
+
+                    if (i % config_.switchInterval == 0)
+                    {
+                        auto& pipeline = *pipelines_[(i / config_.switchInterval) % 2];
+                        if (samples != nullptr)
+                            recorder_.Measure(samples[2], [&]() { commands_->SetGraphicsPipeline(pipeline); });
+                        else
+                            commands_->SetGraphicsPipeline(pipeline);
+                    }
+                }
+
+                if (samples != nullptr)
+                    recorder_.Measure(samples[0], [&]() { commands_->DrawIndexed(6, 0); });
+                else
+                    commands_->DrawIndexed(6, 0);
+            }
+
+            context_->Present();
+        }
+
+        void RunPass(std::vector<CallStatistics>& results, const char* pass, bool interleaved)
+        {
+            std::cerr << "run " << module_ << (debugLayer_ ? " (debug layer)/" : "/") << pass << " ..." << std::endl;
+
+            /* Samples for DrawIndexed, SetGraphicsResourceHeap, and SetGraphicsPipeline */
+            std::vector<double> samples[3];
+
+            for (std::uint32_t frame = 0; frame < config_.numWarmupFrames; ++frame)
+                RenderFrame(interleaved, nullptr);
+
+            for (std::uint32_t frame = 0; frame < config_.numFrames; ++frame)
+                RenderFrame(interleaved, samples);
+
+            renderer_->GetCommandQueue()->WaitIdle();
+
+            const char* calls[3] = { "draw", "bind", "pipeline_switch" };
+
+            for (int i = 0; i < 3; ++i)
+            {
+                if (samples[i].empty())
+                    continue;
+
+                auto stats = GetStatistics(samples[i]);
+                {
+                    stats.module        = module_;
+                    stats.debugLayer    = debugLayer_;
+                    stats.pass          = pass;
+                    stats.call          = calls[i];
+                }
+                results.push_back(stats);
+            }
+        }
+
+    private:
+
+        std::string                         module_;
+        bool                                debugLayer_         = false;
+        DrawCallConfig                      config_;
+
+        LLGL::RenderingProfiler             profiler_;
+        LLGL::RenderingDebugger             debugger_;
+        std::unique_ptr<LLGL::RenderSystem> renderer_;
+        LLGL::RenderContext*                context_            = nullptr;
+        LLGL::CommandBuffer*                commands_           = nullptr;
+        LLGL::RenderTarget*                 renderTarget_       = nullptr;
+
+        LLGL::VertexFormat                  vertexFormat_;
+        LLGL::Buffer*                       vertexBuffer_       = nullptr;
+        LLGL::Buffer*                       indexBuffer_        = nullptr;
+        LLGL::PipelineLayout*               pipelineLayout_     = nullptr;
+        LLGL::GraphicsPipeline*             pipelines_[2]       = {};
+        std::vector<LLGL::ResourceHeap*>    resourceHeaps_;
+
+        CallRecorder                        recorder_;
+
+};
+
+
+/* ----- JSON output ----- */
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<CallStatistics>& results)
+{
+    s << "{\n";
+    s << "  \"version\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+
+        s << (i > 0 ? ",\n" : "\n");
+        s << "    { \"module\": \"" << EscapeJSON(r.module) << "\", \"debug_layer\": " << (r.debugLayer ? "true" : "false");
+
+        if (r.error.empty())
+        {
+            s << ", \"pass\": \"" << r.pass << "\", \"call\": \"" << r.call << '\"';
+            s << ", \"samples\": " << r.samples;
+            s << ", \"mean_ns\": " << r.meanNs;
+            s << ", \"p50_ns\": " << r.p50Ns;
+            s << ", \"p90_ns\": " << r.p90Ns;
+            s << ", \"p99_ns\": " << r.p99Ns;
+            s << ", \"max_ns\": " << r.maxNs;
+        }
+        else
+            s << ", \"error\": \"" << EscapeJSON(r.error) << '\"';
+
+        s << " }";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+
+/* ----- Main ----- */
+
+static void PrintHelp()
+{
+    std::cerr << "usage: DrawCallBenchmark [--output FILE] [--objects N] [--frames N] [--no-debug-layer] [MODULE ...]" << std::endl;
+    std::cerr << "  Measures the CPU cost of DrawIndexed, SetGraphicsResourceHeap, and SetGraphicsPipeline (in nanoseconds per call)" << std::endl;
+    std::cerr << "  for each specified module (by default all modules from LLGL::RenderSystem::FindModules), with and without the debug layer." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    DrawCallConfig              config;
+    std::string                 outputFile;
+    std::vector<std::string>    modules;
+    bool                        withDebugLayer = true;
+
+    /* Parse command line arguments */
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else if (arg == "--output" && i + 1 < argc)
+            outputFile = argv[++i];
+        else if (arg == "--objects" && i + 1 < argc)
+            config.numObjects = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--frames" && i + 1 < argc)
+            config.numFrames = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--no-debug-layer")
+            withDebugLayer = false;
+        else
+            modules.push_back(arg);
+    }
+
+    if (modules.empty())
+        modules = LLGL::RenderSystem::FindModules();
+
+    /* Run benchmark for each module with and without debug layer */
+    std::vector<CallStatistics> results;
+
+    for (const auto& module : modules)
+    {
+        for (int debugLayer = 0; debugLayer < (withDebugLayer ? 2 : 1); ++debugLayer)
+        {
+            try
+            {
+                DrawCallBenchmark benchmark { module, (debugLayer != 0), config };
+                benchmark.Load();
+                benchmark.Run(results);
+            }
+            catch (const std::exception& e)
+            {
+                CallStatistics stats;
+                {
+                    stats.module        = module;
+                    stats.debugLayer    = (debugLayer != 0);
+                    stats.error         = e.what();
+                }
+                results.push_back(stats);
+            }
+        }
+    }
+
+    /* Write results */
+    if (outputFile.empty())
+        WriteResultsJSON(std::cout, results);
+    else
+    {
+        std::ofstream file { outputFile };
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << outputFile << std::endl;
+            return 1;
+        }
+        WriteResultsJSON(file, results);
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,171 @@
+/*
+ * Replay.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/CaptureReplay.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/* ----- Configuration ----- */
+
+// Timing statistics of all replayed frames of a single module
+struct ReplayStatistics
+{
+    std::string     module;
+    std::string     error;              // Error message if the module failed, empty otherwise
+    std::size_t     frames      = 0;
+    double          firstMs     = 0.0;  // Duration of the first frame, which includes the creation of all resources
+    double          meanMs      = 0.0;
+    double          minMs       = 0.0;
+    double          maxMs       = 0.0;
+};
+
+
+/* ----- Replay ----- */
+
+static ReplayStatistics ReplayModule(const LLGL::CaptureReplay& trace, const std::string& module, std::uint32_t numRepeats)
+{
+    ReplayStatistics stats;
+    stats.module = module;
+
+    auto renderer = LLGL::RenderSystem::Load(module);
+
+    /* Measure the duration between two presented frames */
+    const double msPerTick = 1000.0 / static_cast<double>(LLGL::Timer::GetTickFrequency());
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(trace.GetNumFrames() * numRepeats);
+
+    for (std::uint32_t i = 0; i < numRepeats; ++i)
+    {
+        auto startTick = LLGL::Timer::Tick();
+
+        trace.Replay(
+            *renderer,
+            [&](std::uint32_t /*frame*/)
+            {
+                const auto endTick = LLGL::Timer::Tick();
+                frameTimes.push_back(static_cast<double>(endTick - startTick) * msPerTick);
+                startTick = endTick;
+            }
+        );
+    }
+
+    LLGL::RenderSystem::Unload(std::move(renderer));
+
+    /* Accumulate statistics, the first frame is reported separately */
+    stats.frames = frameTimes.size();
+
+    if (!frameTimes.empty())
+    {
+        stats.firstMs = frameTimes.front();
+
+        if (frameTimes.size() > 1)
+        {
+            const auto begin = frameTimes.begin() + 1;
+            double sum = 0.0;
+            for (auto it = begin; it != frameTimes.end(); ++it)
+                sum += *it;
+
+            stats.meanMs    = sum / static_cast<double>(frameTimes.size() - 1);
+            stats.minMs     = *std::min_element(begin, frameTimes.end());
+            stats.maxMs     = *std::max_element(begin, frameTimes.end());
+        }
+    }
+
+    return stats;
+}
+
+
+/* ----- Main ----- */
+
+static void PrintHelp()
+{
+    std::cerr << "usage: llgl-replay [--repeat N] TRACE [MODULE ...]" << std::endl;
+    std::cerr << "  Replays the specified trace (recorded with LLGL::RenderSystemDescriptor::captureFilename) N times (by default 1)" << std::endl;
+    std::cerr << "  for each specified module (by default all modules from LLGL::RenderSystem::FindModules), and prints the frame times in milliseconds." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string                 traceFile;
+    std::vector<std::string>    modules;
+    std::uint32_t               numRepeats = 1;
+
+    /* Parse command line arguments */
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else if (arg == "--repeat" && i + 1 < argc)
+            numRepeats = std::max(1u, static_cast<std::uint32_t>(std::stoul(argv[++i])));
+        else if (traceFile.empty())
+            traceFile = arg;
+        else
+            modules.push_back(arg);
+    }
+
+    if (traceFile.empty())
+    {
+        PrintHelp();
+        return 1;
+    }
+
+    LLGL::CaptureReplay trace;
+    if (!trace.Load(traceFile))
+    {
+        std::cerr << "failed to load trace: " << traceFile << std::endl;
+        return 1;
+    }
+
+    if (modules.empty())
+        modules = LLGL::RenderSystem::FindModules();
+
+    /* Replay trace for each module */
+    std::cout << "trace: " << traceFile << " (" << trace.GetNumFrames() << " frames, " << numRepeats << " repeats)" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (const auto& module : modules)
+    {
+        ReplayStatistics stats;
+
+        try
+        {
+            stats = ReplayModule(trace, module, numRepeats);
+        }
+        catch (const std::exception& e)
+        {
+            stats.module    = module;
+            stats.error     = e.what();
+        }
+
+        if (!stats.error.empty())
+            std::cout << module << ": error: " << stats.error << std::endl;
+        else
+        {
+            std::cout
+                << module << ": " << stats.frames << " frames, first " << stats.firstMs << " ms"
+                << ", mean " << stats.meanMs << " ms, min " << stats.minMs << " ms, max " << stats.maxMs << " ms"
+                << std::endl;
+        }
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
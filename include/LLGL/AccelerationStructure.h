@@ -0,0 +1,81 @@
+/*
+ * AccelerationStructure.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ACCELERATION_STRUCTURE_H
+#define LLGL_ACCELERATION_STRUCTURE_H
+
+
+#include "Resource.h"
+#include "AccelerationStructureFlags.h"
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Acceleration structure interface for hardware ray queries.
+\remarks Top-level acceleration structures can be bound in a ResourceHeap with ResourceType::AccelerationStructure,
+e.g. as \c RaytracingAccelerationStructure in HLSL or \c accelerationStructureEXT in GLSL, to trace inline ray queries in compute and fragment shaders.
+\see RenderSystem::CreateAccelerationStructure
+\see CommandBuffer::BuildAccelerationStructures
+*/
+class LLGL_EXPORT AccelerationStructure : public Resource
+{
+
+    public:
+
+        //! Returns ResourceType::AccelerationStructure.
+        ResourceType QueryResourceType() const override;
+
+        /**
+        \brief Returns the device address of this acceleration structure.
+        \remarks This is used to reference bottom-level acceleration structures in the instances of top-level acceleration structures.
+        \see AccelerationStructureInstance::accelerationStructure
+        */
+        virtual std::uint64_t GetDeviceAddress() const = 0;
+
+        /**
+        \brief Queries the compacted size (in bytes) that has been written by the last build of this acceleration structure.
+        \return Compacted size, or zero if the acceleration structure has not been created with AccelerationStructureFlags::AllowCompaction,
+        or if the last build has not been completed on the GPU yet.
+        \remarks The returned size can be used to create the destination of CommandBuffer::CompactAccelerationStructure (see AccelerationStructureDescriptor::compactedSize).
+        */
+        virtual std::uint64_t QueryCompactedSize() = 0;
+
+        //! Returns the type of this acceleration structure.
+        inline AccelerationStructureType GetType() const
+        {
+            return type_;
+        }
+
+        //! Returns the creation flags of this acceleration structure (see AccelerationStructureFlags).
+        inline long GetFlags() const
+        {
+            return flags_;
+        }
+
+    protected:
+
+        AccelerationStructure(const AccelerationStructureType type, long flags);
+
+    private:
+
+        AccelerationStructureType   type_   = AccelerationStructureType::BottomLevel;
+        long                        flags_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
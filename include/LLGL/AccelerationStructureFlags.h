@@ -0,0 +1,206 @@
+/*
+ * AccelerationStructureFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ACCELERATION_STRUCTURE_FLAGS_H
+#define LLGL_ACCELERATION_STRUCTURE_FLAGS_H
+
+
+#include "Format.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class Buffer;
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Acceleration structure type enumeration.
+\see AccelerationStructureDescriptor::type
+*/
+enum class AccelerationStructureType
+{
+    //! Bottom-level acceleration structure (BLAS), which contains triangle geometry.
+    BottomLevel,
+
+    //! Top-level acceleration structure (TLAS), which contains instances of bottom-level acceleration structures.
+    TopLevel,
+};
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Acceleration structure creation flags enumeration.
+\see AccelerationStructureDescriptor::flags
+*/
+struct AccelerationStructureFlags
+{
+    enum
+    {
+        /**
+        \brief The acceleration structure can be the source of CommandBuffer::CompactAccelerationStructure.
+        \remarks Each build writes the compacted size, which can be read with AccelerationStructure::QueryCompactedSize once the build has been completed on the GPU.
+        \see CommandBuffer::CompactAccelerationStructure
+        */
+        AllowCompaction = (1 << 0),
+
+        //! Hint to the renderer to prioritize trace performance over build time, e.g. for static geometry.
+        PreferFastTrace = (1 << 1),
+
+        //! Hint to the renderer to prioritize build time over trace performance, e.g. for a top-level structure that is rebuilt every frame.
+        PreferFastBuild = (1 << 2),
+    };
+};
+
+/**
+\brief Acceleration structure instance flags enumeration.
+\remarks These flags have the same values as \c D3D12_RAYTRACING_INSTANCE_FLAGS and \c VkGeometryInstanceFlagsKHR.
+\see AccelerationStructureInstance::flags
+*/
+struct AccelerationStructureInstanceFlags
+{
+    enum
+    {
+        //! Disables face culling for the triangles of this instance.
+        DisableTriangleCull = (1 << 0),
+
+        //! Flips the winding of the front facing triangles of this instance.
+        FrontCounterClockwise = (1 << 1),
+
+        //! Treats all geometry of this instance as opaque.
+        ForceOpaque = (1 << 2),
+
+        //! Treats all geometry of this instance as non-opaque.
+        ForceNonOpaque = (1 << 3),
+    };
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Triangle geometry descriptor structure for bottom-level acceleration structures.
+\remarks The vertex and index buffers must have been created with the BufferFlags::AccelerationStructureInput flag.
+\see AccelerationStructureDescriptor::geometries
+*/
+struct AccelerationStructureTriangles
+{
+    //! Specifies the buffer that contains the vertex positions. This must not be null.
+    Buffer*         vertexBuffer    = nullptr;
+
+    //! Specifies the offset (in bytes) of the first vertex within the vertex buffer. By default 0.
+    std::uint64_t   vertexOffset    = 0;
+
+    //! Specifies the stride (in bytes) between two vertices. By default 12, i.e. the size of three 32-bit floats.
+    std::uint32_t   vertexStride    = 12;
+
+    //! Specifies the number of vertices. By default 0.
+    std::uint32_t   numVertices     = 0;
+
+    //! Specifies the format of the vertex positions. This must be either Format::RGB32Float, Format::RG32Float, Format::RGBA16Float, or Format::RG16Float. By default Format::RGB32Float.
+    Format          vertexFormat    = Format::RGB32Float;
+
+    //! Specifies the buffer that contains the indices, or null if the triangles are not indexed. By default null.
+    Buffer*         indexBuffer     = nullptr;
+
+    //! Specifies the offset (in bytes) of the first index within the index buffer. By default 0.
+    std::uint64_t   indexOffset     = 0;
+
+    //! Specifies the number of indices. This is ignored if there is no index buffer. By default 0.
+    std::uint32_t   numIndices      = 0;
+
+    //! Specifies the format of the indices. This must be either Format::R16UInt or Format::R32UInt. By default Format::R32UInt.
+    Format          indexFormat     = Format::R32UInt;
+
+    //! Specifies whether the geometry is opaque, i.e. any-hit evaluations are skipped for its triangles. By default true.
+    bool            opaque          = true;
+};
+
+/**
+\brief Instance structure of top-level acceleration structures, as it is stored in the instance buffer.
+\remarks This structure has the same memory layout as \c D3D12_RAYTRACING_INSTANCE_DESC and \c VkAccelerationStructureInstanceKHR.
+\see AccelerationStructureDescriptor::instanceBuffer
+*/
+struct AccelerationStructureInstance
+{
+    //! Row-major 3x4 transformation matrix from object space into world space.
+    float           transform[3][4];
+
+    //! User defined 24-bit instance ID, which is returned by the \c InstanceID intrinsic in shaders.
+    std::uint32_t   instanceID              : 24;
+
+    //! 8-bit visibility mask, which is combined with the mask of each ray query.
+    std::uint32_t   mask                    : 8;
+
+    //! 24-bit offset into the hit group table. This is only used for ray tracing pipelines and should be 0 for ray queries.
+    std::uint32_t   hitGroupOffset          : 24;
+
+    //! 8-bit bitmask of AccelerationStructureInstanceFlags entries.
+    std::uint32_t   flags                   : 8;
+
+    //! Device address of the bottom-level acceleration structure (see AccelerationStructure::GetDeviceAddress).
+    std::uint64_t   accelerationStructure;
+};
+
+/**
+\brief Acceleration structure descriptor structure.
+\remarks The geometry or instance inputs are read each time the acceleration structure is built with CommandBuffer::BuildAccelerationStructures,
+so the buffers must remain valid as long as the acceleration structure is built from them.
+\see RenderSystem::CreateAccelerationStructure
+*/
+struct AccelerationStructureDescriptor
+{
+    //! Specifies the acceleration structure type. By default AccelerationStructureType::BottomLevel.
+    AccelerationStructureType                   type            = AccelerationStructureType::BottomLevel;
+
+    /**
+    \brief Specifies the creation flags. This can be a bitwise OR combination of the entries of the AccelerationStructureFlags enumeration. By default 0.
+    \see AccelerationStructureFlags
+    */
+    long                                        flags           = 0;
+
+    //! Specifies the triangle geometries of a bottom-level acceleration structure. This must be empty for top-level acceleration structures.
+    std::vector<AccelerationStructureTriangles> geometries;
+
+    /**
+    \brief Specifies the buffer that contains the instances of a top-level acceleration structure. By default null.
+    \remarks The buffer must have been created with the BufferFlags::AccelerationStructureInput flag,
+    and it contains an array of \c numInstances entries of the AccelerationStructureInstance structure.
+    This must be null for bottom-level acceleration structures.
+    */
+    Buffer*                                     instanceBuffer  = nullptr;
+
+    //! Specifies the offset (in bytes) of the first instance within the instance buffer. This must be a multiple of 16. By default 0.
+    std::uint64_t                               instanceOffset  = 0;
+
+    //! Specifies the number of instances of a top-level acceleration structure. By default 0.
+    std::uint32_t                               numInstances    = 0;
+
+    /**
+    \brief Specifies the compacted size (in bytes) of another acceleration structure, or zero to determine the size from the inputs. By default 0.
+    \remarks If this is non-zero, the acceleration structure can only be the destination of CommandBuffer::CompactAccelerationStructure,
+    and the source of that command must have been queried with AccelerationStructure::QueryCompactedSize.
+    The geometry and instance inputs are ignored for such acceleration structures, but the type must match the type of the source.
+    */
+    std::uint64_t                               compactedSize   = 0;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
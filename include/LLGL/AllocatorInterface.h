@@ -0,0 +1,68 @@
+/*
+ * AllocatorInterface.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ALLOCATOR_INTERFACE_H
+#define LLGL_ALLOCATOR_INTERFACE_H
+
+
+#include "Export.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Host memory allocator interface, which can be used to route the memory of LLGL into custom allocation tracking or memory arenas.
+\remarks An instance of this interface is passed to RenderSystem::Load with RenderSystemDescriptor::allocator.
+All functions may be called from multiple threads concurrently, e.g. by worker threads or by the Vulkan driver.
+\see RenderSystemDescriptor::allocator
+*/
+class LLGL_EXPORT AllocatorInterface
+{
+
+    public:
+
+        virtual ~AllocatorInterface() = default;
+
+        /**
+        \brief Allocates a block of host memory.
+        \param[in] size Specifies the size (in bytes) of the memory block. This is always greater than zero.
+        \param[in] alignment Specifies the alignment (in bytes) of the memory block. This is always a power of two.
+        \return Pointer to the new memory block, or null if the allocation failed.
+        */
+        virtual void* Allocate(std::size_t size, std::size_t alignment) = 0;
+
+        /**
+        \brief Resizes a block of host memory with the same semantics as \c realloc.
+        \param[in] ptr Specifies the memory block that was allocated with this allocator. If this is null, the function behaves like Allocate.
+        \param[in] size Specifies the new size (in bytes) of the memory block. If this is zero, the function behaves like Free and returns null.
+        \param[in] alignment Specifies the alignment (in bytes) of the memory block, which is the same as for the original allocation.
+        \return Pointer to the resized memory block, which contains the original data up to the smaller of the old and new size,
+        or null if the allocation failed, in which case the original memory block is left untouched.
+        \remarks This is only used by the Vulkan driver (see \c VkAllocationCallbacks).
+        */
+        virtual void* Reallocate(void* ptr, std::size_t size, std::size_t alignment) = 0;
+
+        /**
+        \brief Releases a block of host memory that was allocated with this allocator.
+        \param[in] ptr Specifies the memory block to release. This may be null, in which case the function has no effect.
+        */
+        virtual void Free(void* ptr) = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
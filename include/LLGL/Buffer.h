@@ -35,6 +35,13 @@ class LLGL_EXPORT Buffer : public Resource
             return type_;
         }
 
+        /**
+        \brief Returns the GPU virtual address of this buffer, or zero if the renderer does not expose buffer addresses.
+        \remarks This can be used to fill the VertexBufferIndirectArguments structure for CommandBuffer::ExecuteIndirect.
+        \note Only supported with: Direct3D 12.
+        */
+        virtual std::uint64_t GetDeviceAddress() const;
+
     protected:
 
         Buffer(const BufferType type);
@@ -44,6 +44,7 @@ enum class BufferType
 
     /**
     \brief Stream output buffer type (also called "Transform Feedback Buffer").
+    \remarks Stream output buffers can also be bound as vertex buffers, e.g. to draw the captured vertices with CommandBuffer::DrawStreamOutput.
     \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
     */
     StreamOutput,
@@ -51,7 +52,13 @@ enum class BufferType
 
 /**
 \brief Storage buffer type enumeration.
-\note Only supported with: Direct3D 11, Direct3D 12.
+\remarks The hidden counter of append and consume buffers can be set and copied with CommandBuffer::SetBufferCounter and CommandBuffer::CopyCounterToBuffer.
+For Direct3D, this is the counter of the unordered access view (UAV).
+For OpenGL, this is a separate atomic counter buffer (GL_ATOMIC_COUNTER_BUFFER), which is bound to the same binding slot as the storage buffer (e.g. "layout(binding = 1) uniform atomic_uint").
+For Vulkan, the counter is stored as 32-bit unsigned integer behind the elements of the storage buffer (aligned to 4 bytes).
+\note Only supported with: Direct3D 11, Direct3D 12. The hidden counters of append and consume buffers are also supported with OpenGL and Vulkan.
+\see CommandBuffer::SetBufferCounter
+\see CommandBuffer::CopyCounterToBuffer
 */
 enum class StorageBufferType
 {
@@ -62,8 +69,8 @@ enum class StorageBufferType
     RWBuffer,                   //!< Typed read/write buffer.
     RWStructuredBuffer,         //!< Structured read/write buffer.
     RWByteAddressBuffer,        //!< Byte-address read/write buffer.
-    AppendStructuredBuffer,     //!< Append structured buffer.
-    ConsumeStructuredBuffer,    //!< Consume structured buffer.
+    AppendStructuredBuffer,     //!< Append structured buffer with a hidden counter.
+    ConsumeStructuredBuffer,    //!< Consume structured buffer with a hidden counter.
 };
 
 /**
@@ -96,9 +103,47 @@ struct BufferFlags
         /**
         \brief Hint to the renderer that the buffer will be frequently updated from the CPU.
         \remarks This is useful for a constant buffer for instance, that is updated by the host program every frame.
+        For Direct3D 11, vertex, index, and constant buffers without the MapReadAccess, MapWriteAccess, and IndirectArguments flags are created with dynamic usage.
+        Small vertex and index buffers are stored in a ring of regions: each call to RenderSystem::WriteBuffer writes the entire buffer into the next region
+        with \c D3D11_MAP_WRITE_NO_OVERWRITE and only discards the buffer with \c D3D11_MAP_WRITE_DISCARD when the ring rolls over.
+        Because each update moves the buffer to a new region, the buffer must be bound again after each update and cannot be part of a buffer array.
+        Such buffers cannot be the destination of copy commands.
         \see RenderSystem::WriteBuffer
         */
         DynamicUsage        = (1 << 2),
+
+        /**
+        \brief Hint to the renderer that the buffer is a stream that is overwritten by the CPU several times per frame.
+        \remarks For OpenGL (with GL_ARB_buffer_storage), the buffer is stored in persistently and coherently mapped memory with three regions (triple buffering).
+        Each call to RenderSystem::WriteBuffer or RenderSystem::MapBuffer with write access advances to the next region,
+        which is guarded by a fence, so the data is written with a plain memory copy and without implicit synchronization in the driver.
+        Without GL_ARB_buffer_storage (e.g. for OpenGL ES 3), the three regions are stored in mutable storage instead, and each update writes the next region
+        with \c glMapBufferRange and the \c GL_MAP_INVALIDATE_RANGE_BIT and \c GL_MAP_UNSYNCHRONIZED_BIT flags.
+        If the GPU is still reading from that region, the buffer is orphaned with \c glBufferData instead of waiting for the GPU.
+        Writing the entire buffer at once is the fastest path, since the content of a partial write is merged with the previous region.
+        Because each update moves the buffer to a new region, the buffer must be bound again (e.g. with CommandBuffer::SetVertexBuffer) after each update.
+        This is only supported for vertex and constant buffers that are not part of a buffer array or resource heap. Other renderers ignore this flag.
+        \see RenderSystem::WriteBuffer
+        \see RenderSystem::MapBuffer
+        */
+        PersistentMapping   = (1 << 3),
+
+        /**
+        \brief Buffer can be used as source of draw and dispatch arguments.
+        \remarks This is required for the buffer argument of the indirect draw and dispatch commands.
+        \see CommandBuffer::DrawIndirect
+        \see CommandBuffer::DrawIndexedIndirect
+        \see CommandBuffer::DispatchIndirect
+        */
+        IndirectArguments   = (1 << 4),
+
+        /**
+        \brief Buffer can be used as geometry or instance input of acceleration structure builds.
+        \remarks For Vulkan, this enables the device address of the buffer, which requires RenderingFeatures::hasRayQueries.
+        \see AccelerationStructureTriangles
+        \see AccelerationStructureDescriptor::instanceBuffer
+        */
+        AccelerationStructureInput = (1 << 5),
     };
 };
 
@@ -115,6 +160,8 @@ struct BufferDescriptor
         \brief Specifies the vertex format layout.
         \remarks This is required to tell the renderer how the vertex attributes are stored inside the vertex buffer and
         it must be the same vertex format which is used for the respective graphics pipeline shader program.
+        For a stream-output buffer (i.e. BufferType::StreamOutput), this specifies the layout of the captured vertices,
+        when the buffer is used as vertex buffer (see CommandBuffer::DrawStreamOutput).
         */
         VertexFormat format;
     };
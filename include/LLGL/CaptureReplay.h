@@ -0,0 +1,84 @@
+/*
+ * CaptureReplay.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_REPLAY_H
+#define LLGL_CAPTURE_REPLAY_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+
+/**
+\brief Replays a binary trace of API calls that has been recorded with RenderSystemDescriptor::captureFilename.
+\remarks This can be used to reproduce the rendering of an application without the application itself,
+e.g. to compare the performance of different renderers for the same workload or to attach a graphics debugger to a minimal reproduction.
+All objects of the trace are created with the specified render system, render contexts are created with their own window and V-sync disabled.
+The primary command buffers that have been used since the last presentation are submitted to their command queue right before the render context is presented.
+\code
+LLGL::CaptureReplay myReplay;
+if (myReplay.Load("frames.trace"))
+{
+    myReplay.Replay(*myRenderer, [](std::uint32_t frame) {
+        std::cout << "frame " << frame << " presented" << std::endl;
+    });
+}
+\endcode
+\see RenderSystemDescriptor::captureFilename
+*/
+class LLGL_EXPORT CaptureReplay : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Reads the specified binary trace into memory.
+        \return True if the file has been read successfully. If the file does not exist or is invalid, the return value is false and no exception is thrown.
+        */
+        bool Load(const std::string& filename);
+
+        /**
+        \brief Replays all calls of the trace with the specified render system.
+        \param[in] renderSystem Specifies the render system the objects are created with.
+        \param[in] frameCallback Optional callback that is invoked after each presented frame with the zero-based frame index.
+        \remarks All objects that have been created by the replay are released at the end, so the trace can be replayed multiple times.
+        \throws std::runtime_error If the trace is corrupted or refers to objects that could not be created.
+        */
+        void Replay(RenderSystem& renderSystem, const std::function<void(std::uint32_t frame)>& frameCallback = nullptr) const;
+
+        //! Returns the number of frames of the loaded trace.
+        inline std::uint32_t GetNumFrames() const
+        {
+            return numFrames_;
+        }
+
+    private:
+
+        std::vector<char>   data_;
+        std::uint32_t       numFrames_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
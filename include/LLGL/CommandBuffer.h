@@ -16,18 +16,40 @@
 
 #include "Buffer.h"
 #include "BufferArray.h"
+#include "IndexFormat.h"
 #include "ResourceHeap.h"
 #include "PipelineLayoutFlags.h"
 
+#include "Texture.h"
 #include "RenderTarget.h"
+#include "RenderPass.h"
 #include "ShaderProgram.h"
 #include "GraphicsPipeline.h"
 #include "ComputePipeline.h"
 #include "Query.h"
+#include "QueryHeap.h"
+#include "IndirectCommandLayout.h"
+#include "AccelerationStructure.h"
 
 #include <cstdint>
 
 
+/**
+\brief Declaration specifiers for the hot command buffer functions (e.g. Draw, SetGraphicsPipeline, etc.).
+\remarks If LLGL_BACKEND_DIRECT_DISPATCH is defined (see CMake option LLGL_BACKEND), these functions are not virtual,
+but implemented directly by the only render system that has been linked statically. This allows the compiler to inline the recording path.
+*/
+#ifdef LLGL_BACKEND_DIRECT_DISPATCH
+#   define LLGL_DISPATCH_VIRTUAL
+#   define LLGL_DISPATCH_ABSTRACT
+#   define LLGL_DISPATCH_OVERRIDE
+#else
+#   define LLGL_DISPATCH_VIRTUAL    virtual
+#   define LLGL_DISPATCH_ABSTRACT   = 0
+#   define LLGL_DISPATCH_OVERRIDE   override
+#endif
+
+
 namespace LLGL
 {
 
@@ -77,7 +99,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \remarks Similar to SetViewports but only a single viewport is set.
         \see SetViewports
         */
-        virtual void SetViewport(const Viewport& viewport) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetViewport(const Viewport& viewport) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Sets an array of viewports.
@@ -98,7 +120,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \remarks Similar to SetScissors but only a single scissor rectangle is set.
         \see SetScissors
         */
-        virtual void SetScissor(const Scissor& scissor) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetScissor(const Scissor& scissor) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Sets an array of scissor rectangles, but only if the scissor test was enabled in the previously set graphics pipeline (otherwise, this function has no effect).
@@ -175,7 +197,18 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \see RenderSystem::WriteBuffer
         \see SetVertexBufferArray
         */
-        virtual void SetVertexBuffer(Buffer& buffer) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetVertexBuffer(Buffer& buffer) LLGL_DISPATCH_ABSTRACT;
+
+        /**
+        \brief Sets the specified vertex buffer with a byte offset for subsequent drawing operations.
+        \param[in] buffer Specifies the vertex buffer to set. This buffer must have been created with the buffer type: BufferType::Vertex.
+        \param[in] offset Specifies the offset (in bytes) of the first vertex within the buffer. This must be less than the buffer size.
+        \remarks This allows to pack the vertices of many meshes into a single buffer, even if they have different vertex strides,
+        since the offset does not need to be a multiple of the stride of the vertex format the buffer has been created with.
+        For OpenGL, a non-zero offset requires the extension \c GL_ARB_vertex_attrib_binding.
+        \see SetVertexBuffer(Buffer&)
+        */
+        virtual void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) = 0;
 
         /**
         \brief Sets the specified array of vertex buffers for subsequent drawing operations.
@@ -193,7 +226,21 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \remarks An active index buffer is only required for any "DrawIndexed" or "DrawIndexedInstanced" draw call.
         \see RenderSystem::WriteIndexBuffer
         */
-        virtual void SetIndexBuffer(Buffer& buffer) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetIndexBuffer(Buffer& buffer) LLGL_DISPATCH_ABSTRACT;
+
+        /**
+        \brief Sets the active index buffer with an index format and a byte offset for subsequent drawing operations.
+        \param[in] buffer Specifies the index buffer to set. This buffer must have been created with the buffer type: BufferType::Index.
+        \param[in] format Specifies the format of the indices, which overrides the format the buffer has been created with.
+        This must be either DataType::UInt16 or DataType::UInt32.
+        \param[in] offset Specifies the offset (in bytes) of the first index within the buffer.
+        This must be a multiple of the size of the index format and less than the buffer size.
+        \remarks This allows to pack the indices of many meshes into a single buffer, even if they have different index formats.
+        The first index of each draw command is relative to this offset.
+        For OpenGL, the offset is not applied to the arguments of DrawIndexedIndirect, whose first index must include the offset.
+        \see SetIndexBuffer(Buffer&)
+        */
+        virtual void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) = 0;
 
         /* ----- Stream Output Buffers ------ */
 
@@ -222,29 +269,102 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
 
         /**
         \brief Ends the current stream-output.
+        \remarks After the stream-output has ended, the stream-output buffers can be used as vertex buffers, e.g. for DrawStreamOutput.
         \see BeginStreamOutput
         */
         virtual void EndStreamOutput() = 0;
 
+        /**
+        \brief Pauses the current stream-output, so subsequent draw calls are not captured until the stream-output is resumed.
+        \remarks The vertices that have been captured so far are preserved.
+        \note Only supported with: OpenGL (with GL_ARB_transform_feedback2), Direct3D 11.
+        \see ResumeStreamOutput
+        */
+        virtual void PauseStreamOutput() = 0;
+
+        /**
+        \brief Resumes the paused stream-output, so subsequent draw calls append their vertices to the stream-output buffers.
+        \note Only supported with: OpenGL (with GL_ARB_transform_feedback2), Direct3D 11.
+        \see PauseStreamOutput
+        */
+        virtual void ResumeStreamOutput() = 0;
+
         /* ----- Resource Heaps ----- */
 
         /**
         \brief Binds the specified resource heap to the graphics pipeline.
         \param[in] resourceHeap Specifies the resource heap that contains all shader resources that will be bound to the shader pipeline.
         \param[in] firstSet Specifies the set number of the first layout descriptor.
+        \param[in] numDynamicOffsets Specifies the number of dynamic offsets. This must be equal to the number of bindings with BindingFlags::DynamicOffset in the pipeline layout of the resource heap.
+        \param[in] dynamicOffsets Pointer to an array of 'numDynamicOffsets' offsets (in bytes), one for each binding with BindingFlags::DynamicOffset in ascending order of their binding slots.
+        Each offset must be a multiple of RenderingLimits::constantBufferOffsetAlignment. This can only be null if 'numDynamicOffsets' is zero.
         \remarks This may invalidate the previously bound resource heap for both the graphics and compute pipeline.
+        Binding the same resource heap with different dynamic offsets is meant to be cheap, so a single resource heap can serve many objects whose constants are packed in one buffer.
         \note Parameter 'firstSet' is only supported with: Vulkan.
+        \see BindingFlags::DynamicOffset
         */
-        virtual void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) = 0;
+        virtual void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) = 0;
 
         /**
         \brief Binds the specified resource heap to the compute pipeline.
         \param[in] resourceHeap Specifies the resource heap that contains all shader resources that will be bound to the shader pipeline.
         \param[in] firstSet Specifies the set number of the first layout descriptor.
+        \param[in] numDynamicOffsets Specifies the number of dynamic offsets.
+        \param[in] dynamicOffsets Pointer to an array of 'numDynamicOffsets' offsets (in bytes).
         \remarks This may invalidate the previously bound resource heap for both the graphics and compute pipeline.
         \note Parameter 'firstSet' is only supported with: Vulkan.
+        \see SetGraphicsResourceHeap
         */
-        virtual void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) = 0;
+        virtual void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) = 0;
+
+        /* ----- Constants ----- */
+
+        /**
+        \brief Sets the values of the constants that are declared in the pipeline layout of the currently bound pipeline.
+        \param[in] stageFlags Specifies the shader stages the constants are set for. This can be a bitwise OR combination of the StageFlags bitmasks.
+        If this contains StageFlags::ComputeStage, the constants of the compute pipeline are set, otherwise the constants of the graphics pipeline are set.
+        \param[in] offset Specifies the offset (in bytes) into the constants. This must be a multiple of 4.
+        \param[in] size Specifies the number of bytes to set. This must be a multiple of 4, and 'offset + size' must not be greater than the size of the constants.
+        \param[in] data Raw pointer to the new values. This must not be null.
+        \remarks This is the fastest way to change tiny per-draw data, because it neither requires a buffer update nor a resource heap binding.
+        The graphics or compute pipeline must be bound before the constants are set, and the values remain until they are overwritten.
+        The values are undefined after a pipeline with a different pipeline layout has been bound.
+        \see ConstantsDescriptor
+        \see PipelineLayoutDescriptor::constants
+        */
+        virtual void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) = 0;
+
+        /* ----- Transient Memory ----- */
+
+        /**
+        \brief Allocates transient memory for constant data that is only used by the commands of the current recording, e.g. per-draw constants.
+        \param[in] size Specifies the size (in bytes) of the allocation. This must not be zero.
+        \param[in] alignment Specifies the alignment (in bytes) of the offset within the buffer.
+        If this is zero, RenderingLimits::constantBufferOffsetAlignment is used. By default 0.
+        \return Allocation with the CPU pointer, the constant buffer, and the offset within that buffer.
+        The range can be bound with CommandBufferExt::SetConstantBufferRange, or as dynamic offset of a resource heap that contains the buffer.
+        \remarks The memory is sub-allocated from a persistently mapped ring buffer of each command buffer, so this function neither allocates nor copies any memory.
+        The ring is created with the first allocation and holds 4 MB. Its memory is recycled as soon as the GPU has completed the submission (see CommandQueue::Submit) that used it,
+        so all allocations between two submissions of the same command buffer must fit into the ring.
+        The data must be written before the next draw or dispatch command is recorded, because Direct3D 11 and OpenGL without GL_ARB_buffer_storage
+        transfer the data before such a command. The buffer of the allocations is the same for all allocations of a command buffer,
+        so a resource heap with dynamic offsets only needs to be created once.
+        \throws std::out_of_range If 'size' is zero or the allocations of the current recording exceed the capacity of the ring.
+        \throws std::runtime_error If transient memory is not supported by this command buffer,
+        i.e. for secondary command buffers with Direct3D 12 and Vulkan, for Direct3D 11 without constant buffer offsetting, and for OpenGL command buffers with CommandBufferFlags::DeferredSubmit.
+        \see RenderingFeatures::hasDynamicOffsets
+        */
+        virtual TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) = 0;
 
         /* ----- Render Targets ----- */
 
@@ -265,6 +385,79 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void SetRenderTarget(RenderContext& renderContext) = 0;
 
+        /**
+        \brief Begins a render pass on the specified render target with explicit load and store operations for its attachments.
+        \param[in] renderTarget Specifies the render target to render into.
+        \param[in] renderPass Optional pointer to the render pass that specifies the load and store operations.
+        If this is null, all attachments are loaded and stored, which is equivalent to calling SetRenderTarget(RenderTarget&). By default null.
+        \param[in] numClearValues Specifies the number of entries in the 'clearValues' array. By default 0.
+        \param[in] clearValues Optional pointer to an array of clear values for the attachments with AttachmentLoadOp::Clear.
+        The clear values are consumed in the order of these attachments, i.e. first the color attachments in ascending order, and then the depth-stencil attachment.
+        Attachments without clear value use the values from SetClearColor, SetClearDepth, and SetClearStencil. By default null.
+        \remarks This should be preferred over SetRenderTarget followed by Clear, because the renderer can clear (or discard) the attachments
+        when the render pass begins, instead of loading their previous content first. Each render pass must be ended with EndRenderPass.
+        \note This function may invalidate the viewports and scissor rectangles, just like SetRenderTarget.
+        \see RenderSystem::CreateRenderPass
+        \see EndRenderPass
+        */
+        virtual void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) = 0;
+
+        /**
+        \brief Begins a render pass on the back buffer (or rather swap-chain) of the specified render context with explicit load and store operations.
+        \remarks The back buffer has a single color attachment, and optionally a depth-stencil attachment.
+        \see BeginRenderPass(RenderTarget&, const RenderPass*, std::uint32_t, const ClearValue*)
+        */
+        virtual void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) = 0;
+
+        /**
+        \brief Ends the current render pass, and applies the store operations of its attachments.
+        \remarks Attachments with AttachmentStoreOp::Undefined have an undefined content after this call.
+        \see BeginRenderPass
+        */
+        virtual void EndRenderPass() = 0;
+
+        /**
+        \brief Resolves the specified color attachment of a multi-sampled render target into a single-sampled texture.
+        \param[in] srcRenderTarget Specifies the source render target. This should be a multi-sampled render target.
+        If the render target is not multi-sampled, its color attachment is copied.
+        \param[in] dstTexture Specifies the destination texture whose first MIP-map level and array layer receive the resolved color attachment.
+        This texture must be a single-sampled texture that was created with the TextureFlags::AttachmentUsage flag,
+        and it must have the same format and at least the same extent as the render target.
+        \param[in] srcColorAttachment Specifies the zero-based index of the color attachment that is to be resolved. By default 0.
+        \remarks This must not be called inside a render pass. Multi-sampled render targets without custom multi-sampling
+        are still resolved into their attached textures when another render target is bound,
+        unless their color attachments have been discarded with DiscardAttachments or a render pass with AttachmentStoreOp::Undefined.
+        \note Only supported with: OpenGL, Direct3D 11.
+        Render targets are not multi-sampled with Vulkan yet, and they are not supported with Direct3D 12 yet, so this command is ignored there.
+        \see DiscardAttachments
+        */
+        virtual void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) = 0;
+
+        /**
+        \brief Discards the content of the specified group of attachments of the active render target.
+        \param[in] flags Specifies which attachments are discarded. This can be a bitwise OR combination of the "ClearFlags" enumeration entries.
+        If this contains the ClearFlags::Color bit, all color attachments of the active render target are discarded.
+        \remarks The content of the discarded attachments is undefined afterwards, which saves memory bandwidth especially on tile-based GPUs,
+        because the renderer does not need to store their content. If the color attachments of a multi-sampled render target are discarded,
+        the render target is also not resolved into its attached textures when another render target is bound.
+        This can be used after ResolveRenderTarget, or for attachments that are only used within the current frame such as depth buffers.
+        With Direct3D, the depth-stencil attachment is only discarded if ClearFlags::DepthStencil is specified.
+        \note Only supported with: OpenGL, Direct3D 11.1, Direct3D 12. Vulkan can only discard attachments with the store operations of a render pass.
+        \see BeginRenderPass
+        \see AttachmentStoreOp::Undefined
+        */
+        virtual void DiscardAttachments(long flags) = 0;
+
         /* ----- Pipeline States ----- */
 
         /**
@@ -286,7 +479,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \endcode
         \see RenderSystem::CreateGraphicsPipeline
         */
-        virtual void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Sets the active compute pipeline state.
@@ -295,7 +488,70 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         A valid compute pipeline must always be set before any compute operation can be performed.
         \see RenderSystem::CreateComputePipeline
         */
-        virtual void SetComputePipeline(ComputePipeline& computePipeline) = 0;
+        LLGL_DISPATCH_VIRTUAL void SetComputePipeline(ComputePipeline& computePipeline) LLGL_DISPATCH_ABSTRACT;
+
+        /**
+        \brief Sets the shading rate for all subsequent draw commands, e.g. to shade distant or peripheral objects with a coarser rate.
+        \param[in] rate Specifies the new shading rate. The initial shading rate is ShadingRate::Rate1x1.
+        \remarks If a shading rate image is bound, the rate of the shading rate image takes precedence over this rate.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 12.
+        For OpenGL, this is emulated with the palette of the GL_NV_shading_rate_image extension.
+        For Vulkan, the graphics pipeline must have been created while the VK_KHR_fragment_shading_rate extension was enabled.
+        \see RenderingFeatures::hasVariableRateShading
+        */
+        virtual void SetShadingRate(const ShadingRate rate) = 0;
+
+        /**
+        \brief Sets the shading rate image, which specifies the shading rate for each tile of the render target.
+        \param[in] texture Pointer to the shading rate image or null to disable the image-based shading rate.
+        This must be a 2D texture with format Format::R8UInt that has been created with the BindFlags::Sampled flag.
+        Each texel contains the value of a ShadingRate entry for a tile of RenderingLimits::shadingRateImageTileSize pixels.
+        \remarks The shading rate image takes precedence over the rate that has been set with SetShadingRate.
+        \note Only supported with: OpenGL (GL_NV_shading_rate_image), Direct3D 12 (variable rate shading tier 2).
+        \see RenderingFeatures::hasShadingRateImage
+        \see RenderingLimits::shadingRateImageTileSize
+        */
+        virtual void SetShadingRateImage(Texture* texture) = 0;
+
+        /**
+        \brief Sets the stencil reference value for both the front and back faces.
+        \param[in] reference Specifies the new stencil reference value.
+        \remarks This is only used by graphics pipelines that have been created with DynamicStateFlags::StencilReference,
+        and it must be set after such a graphics pipeline has been bound.
+        \see StencilFaceDescriptor::reference
+        */
+        virtual void SetStencilReference(std::uint32_t reference) = 0;
+
+        /**
+        \brief Sets the blend factor that is used by the blend operations BlendOp::BlendFactor and BlendOp::InvBlendFactor.
+        \param[in] color Specifies the new blend factor.
+        \remarks This is only used by graphics pipelines that have been created with DynamicStateFlags::BlendFactor,
+        and it must be set after such a graphics pipeline has been bound.
+        \see BlendDescriptor::blendFactor
+        */
+        virtual void SetBlendFactor(const ColorRGBAf& color) = 0;
+
+        /**
+        \brief Sets the parameters to bias fragment depth values.
+        \param[in] depthBias Specifies the new depth bias parameters.
+        \remarks This is only used by graphics pipelines that have been created with DynamicStateFlags::DepthBias,
+        and it must be set after such a graphics pipeline has been bound.
+        \note Only supported with: OpenGL, Vulkan.
+        \see RasterizerDescriptor::depthBias
+        */
+        virtual void SetDepthBias(const DepthBiasDescriptor& depthBias) = 0;
+
+        /**
+        \brief Sets the range of the depth bounds test.
+        \param[in] minBounds Specifies the minimum depth bound in the range [0, 1].
+        \param[in] maxBounds Specifies the maximum depth bound in the range [0, 1].
+        \remarks This is only used by graphics pipelines that have been created with DynamicStateFlags::DepthBounds and an enabled depth bounds test,
+        and it must be set after such a graphics pipeline has been bound.
+        \note Only supported with: OpenGL, Vulkan.
+        \see DepthDescriptor::boundsTestEnabled
+        \see RenderingFeatures::hasDepthBoundsTest
+        */
+        virtual void SetDepthBounds(float minBounds, float maxBounds) = 0;
 
         /* ----- Queries ----- */
 
@@ -364,6 +620,128 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void EndRenderCondition() = 0;
 
+        /**
+        \brief Begins the specified query within a query heap.
+        \param[in] queryHeap Specifies the query heap that contains the query.
+        \param[in] query Specifies the zero-based index of the query within the heap. This must be less than QueryHeap::GetNumQueries.
+        \see RenderSystem::CreateQueryHeap
+        \see EndQuery(QueryHeap&, std::uint32_t)
+        */
+        virtual void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) = 0;
+
+        /**
+        \brief Ends the specified query within a query heap.
+        \see BeginQuery(QueryHeap&, std::uint32_t)
+        */
+        virtual void EndQuery(QueryHeap& queryHeap, std::uint32_t query) = 0;
+
+        /**
+        \brief Begins a render condition with the specified query within a query heap.
+        \param[in] queryHeap Specifies the query heap that contains the occlusion query.
+        \param[in] query Specifies the zero-based index of the query within the heap. This must be less than QueryHeap::GetNumQueries.
+        \param[in] mode Specifies the mode of the render condition.
+        \remarks This is equivalent to BeginRenderCondition(Query&, const RenderConditionMode), but the occlusion results of many objects
+        can be stored in a single query heap, so the visibility of each object remains on the GPU without any readback to the CPU.
+        The render condition must be ended with EndRenderCondition, and render conditions cannot be nested.
+        Queries can be issued within a render condition, i.e. the draw commands of a query are discarded if the condition fails,
+        which allows to test the bounding volume of an object only if the bounding volume of its parent is visible.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 11, Direct3D 12. With Direct3D 11, this requires a query heap of type
+        QueryType::AnySamplesPassed or QueryType::AnySamplesPassedConservative. With Vulkan, this requires the device extension
+        \c VK_EXT_conditional_rendering; otherwise, non-inverted conditions fall back to \c VK_KHR_draw_indirect_count,
+        in which case draw commands with multiple indirect arguments are not discarded. Secondary command buffers ignore render conditions with Vulkan.
+        \see EndRenderCondition
+        \see OcclusionCuller
+        */
+        virtual void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) = 0;
+
+        /**
+        \brief Retrieves the results of a range of queries within a query heap.
+        \param[in] queryHeap Specifies the query heap whose results are to be retrieved.
+        \param[in] firstQuery Specifies the zero-based index of the first query.
+        \param[in] numQueries Specifies the number of queries.
+        \param[out] results Pointer to an array of at least 'numQueries' entries, which receives the results.
+        \return True if the results of all queries in the range are available, otherwise false in which case 'results' is not modified.
+        \remarks This function never blocks. Either all results of the range are written or none of them.
+        \see ResolveQueries
+        */
+        virtual bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) = 0;
+
+        /**
+        \brief Copies the results of a range of queries within a query heap into a GPU buffer in a single command.
+        \param[in] queryHeap Specifies the query heap whose results are to be resolved.
+        \param[in] firstQuery Specifies the zero-based index of the first query.
+        \param[in] numQueries Specifies the number of queries.
+        \param[in] dstBuffer Specifies the destination buffer. Each result is written as 64-bit unsigned integer.
+        \param[in] dstOffset Specifies the offset (in bytes) into the destination buffer. This should be a multiple of 8.
+        \remarks The GPU waits for the results of the queries, but the CPU never does.
+        This is only supported by the Vulkan and Direct3D 12 renderers, and by the OpenGL renderer if the extension "GL_ARB_query_buffer_object" is available.
+        Otherwise, this function has no effect and the results must be retrieved with QueryResults.
+        \see QueryResults
+        */
+        virtual void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) = 0;
+
+        /* ----- Timer Scopes ----- */
+
+        /**
+        \brief Begins a named GPU timer scope, e.g. <code>BeginTimerScope("shadow")</code>.
+        \param[in] name Specifies the null-terminated name of the timer scope. The string is copied.
+        \remarks Timer scopes can be nested and each must be ended with a call to EndTimerScope.
+        The elapsed GPU time of each scope is measured with timestamp queries from a pool that is owned by this command buffer,
+        and all scopes between two presentations of the render context (see RenderContext::Present) form one frame.
+        The results are retrieved a few frames later with QueryTimerScopes, which never stalls the GPU.
+        If the timestamp pool of a frame is exhausted, the remaining scopes of that frame are ignored.
+        \note Secondary command buffers ignore timer scopes.
+        \see EndTimerScope
+        \see QueryTimerScopes
+        */
+        virtual void BeginTimerScope(const char* name) = 0;
+
+        /**
+        \brief Ends the innermost timer scope.
+        \see BeginTimerScope
+        */
+        virtual void EndTimerScope() = 0;
+
+        /**
+        \brief Retrieves the timer scopes of the oldest frame whose results are available.
+        \param[out] frame Specifies the output frame with the hierarchy of its timer scopes.
+        \return True if the results of a frame have been retrieved, otherwise false in which case 'frame' is not modified.
+        \remarks This function does not block. Frames whose results have not been retrieved within a few frames are discarded.
+        \see BeginTimerScope
+        \see TimerScopeFrame
+        */
+        virtual bool QueryTimerScopes(TimerScopeFrame& frame) = 0;
+
+        /* ----- Debug Markers ----- */
+
+        /**
+        \brief Begins a named debug group, e.g. <code>PushDebugGroup("shadow pass")</code>.
+        \param[in] name Specifies the null-terminated name of the debug group.
+        \remarks Debug groups annotate the commands of a command buffer for external GPU profilers and debuggers (such as PIX, RenderDoc, or Nsight).
+        They can be nested and each must be ended with a call to PopDebugGroup within the same command buffer.
+        In contrast to timer scopes, debug groups are not measured by LLGL and have no effect on the rendering.
+        This maps to \c vkCmdBeginDebugUtilsLabelEXT for Vulkan (if the instance extension \c VK_EXT_debug_utils is available),
+        to \c ID3D12GraphicsCommandList::BeginEvent for Direct3D 12, to \c ID3DUserDefinedAnnotation::BeginEvent for Direct3D 11,
+        and to \c glPushDebugGroup for OpenGL (if the extension \c GL_KHR_debug is available).
+        \note If LLGL is compiled without the \c LLGL_ENABLE_DEBUG_MARKERS flag, this function has no effect.
+        \see PopDebugGroup
+        \see BeginTimerScope
+        */
+        virtual void PushDebugGroup(const char* name) = 0;
+
+        /**
+        \brief Ends the innermost debug group.
+        \see PushDebugGroup
+        */
+        virtual void PopDebugGroup() = 0;
+
+        /**
+        \brief Inserts a single named debug marker, e.g. <code>InsertDebugMarker("upload finished")</code>.
+        \param[in] name Specifies the null-terminated name of the debug marker.
+        \see PushDebugGroup
+        */
+        virtual void InsertDebugMarker(const char* name) = 0;
+
         /* ----- Drawing ----- */
 
         /**
@@ -376,10 +754,10 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         but the system value <code>gl_VertexID</code> in GLSL (or <code>gl_VertexIndex</code> for Vulkan)
         will start with the value of <code>firstVertex</code>.
         */
-        virtual void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) = 0;
+        LLGL_DISPATCH_VIRTUAL void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) LLGL_DISPATCH_ABSTRACT;
 
         //! \see DrawIndexed(std::uint32_t, std::uint32_t, std::int32_t)
-        virtual void DrawIndexed(std::uint32_t numVertices, std::uint32_t firstIndex) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawIndexed(std::uint32_t numVertices, std::uint32_t firstIndex) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Draws the specified amount of primitives from the currently set vertex- and index buffers.
@@ -387,10 +765,10 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] firstIndex Specifies the zero-based offset of the first index from the index buffer.
         \param[in] vertexOffset Specifies the base vertex offset (positive or negative) which is added to each index from the index buffer.
         */
-        virtual void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_ABSTRACT;
 
         //! \see DrawInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t)
-        virtual void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t firstInstance) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t firstInstance) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Draws the specified amount of instances of primitives from the currently set vertex buffer.
@@ -405,13 +783,13 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         will start with the value of <code>firstVertex</code>.
         The same holds true for the parameter <code>firstInstance</code> and the system values <code>SV_InstanceID</code> in HLSL and <code>gl_InstanceID</code> in GLSL (or <code>gl_InstanceIndex</code> for Vulkan).
         */
-        virtual void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) LLGL_DISPATCH_ABSTRACT;
 
         //! \see DrawIndexedInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t, std::uint32_t)
-        virtual void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) LLGL_DISPATCH_ABSTRACT;
 
         //! \see DrawIndexedInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t, std::uint32_t)
-        virtual void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_ABSTRACT;
 
         /**
         \brief Draws the specified amount of instances of primitives from the currently set vertex- and index buffers.
@@ -426,7 +804,99 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         but the system value <code>gl_InstanceID</code> in GLSL (or <code>gl_InstanceIndex</code> for Vulkan)
         will start with the value of <code>firstInstance</code>.
         */
-        virtual void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) = 0;
+        LLGL_DISPATCH_VIRTUAL void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) LLGL_DISPATCH_ABSTRACT;
+
+        //! \see DrawIndirect(Buffer&, std::uint64_t, std::uint32_t, std::uint32_t)
+        virtual void DrawIndirect(Buffer& buffer, std::uint64_t offset) = 0;
+
+        /**
+        \brief Draws primitives from the currently set vertex buffer with the arguments from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the draw arguments. This buffer must have been created with the BufferFlags::IndirectArguments flag.
+        \param[in] offset Specifies the offset (in bytes) of the first argument structure within the buffer. This must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands. Each command reads one DrawIndirectArguments structure.
+        \param[in] stride Specifies the stride (in bytes) between the argument structures. This must be a multiple of 4 and at least <code>sizeof(DrawIndirectArguments)</code>.
+        \remarks If the renderer does not support multiple draw commands in a single call, they are submitted one after another.
+        \see DrawIndirectArguments
+        \see RenderingFeatures::hasIndirectDrawing
+        */
+        virtual void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) = 0;
+
+        //! \see DrawIndexedIndirect(Buffer&, std::uint64_t, std::uint32_t, std::uint32_t)
+        virtual void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) = 0;
+
+        /**
+        \brief Draws primitives from the currently set vertex- and index buffers with the arguments from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the draw arguments. This buffer must have been created with the BufferFlags::IndirectArguments flag.
+        \param[in] offset Specifies the offset (in bytes) of the first argument structure within the buffer. This must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands. Each command reads one DrawIndexedIndirectArguments structure.
+        \param[in] stride Specifies the stride (in bytes) between the argument structures. This must be a multiple of 4 and at least <code>sizeof(DrawIndexedIndirectArguments)</code>.
+        \remarks If the renderer does not support multiple draw commands in a single call, they are submitted one after another.
+        \see DrawIndexedIndirectArguments
+        \see RenderingFeatures::hasIndirectDrawing
+        */
+        virtual void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) = 0;
+
+        /**
+        \brief Executes indirect commands with the layout of the specified indirect command layout, e.g. to change a vertex buffer and a material index per draw.
+        \param[in] layout Specifies the layout of each command in the argument buffer.
+        \param[in] argumentBuffer Specifies the buffer which contains the commands. This buffer must have been created with the BufferFlags::IndirectArguments flag.
+        \param[in] argumentOffset Specifies the offset (in bytes) of the first command within the argument buffer. This must be a multiple of 4.
+        \param[in] maxNumCommands Specifies the maximum number of commands. If no count buffer is specified, this is the number of commands.
+        \param[in] countBuffer Optional pointer to a buffer which contains the actual number of commands as 32-bit unsigned integer,
+        e.g. written by a culling compute shader. This buffer must have been created with the BufferFlags::IndirectArguments flag. By default null.
+        \param[in] countOffset Specifies the offset (in bytes) of the command count within the count buffer. This must be a multiple of 4. By default 0.
+        \remarks The vertex buffers and constants that are changed by the commands are undefined afterwards and must be set again before the next draw command.
+        \see RenderSystem::CreateIndirectCommandLayout
+        \see RenderingFeatures::hasIndirectCommandLayouts
+        */
+        virtual void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) = 0;
+
+        /**
+        \brief Draws all vertices that have been captured into the currently set vertex buffer by the last stream-output.
+        \remarks The number of vertices is recorded by the GPU during the stream-output, so it never needs to be read back by the CPU
+        (also referred to as "DrawAuto" or "glDrawTransformFeedback").
+        The vertex buffer must be a stream-output buffer, which has been bound with SetVertexBuffer after the stream-output has ended.
+        Its vertex layout is specified by BufferDescriptor::vertexBuffer when the stream-output buffer is created.
+        For OpenGL, the n-th buffer of a stream-output buffer array is drawn with the number of vertices of the n-th vertex stream (GL_ARB_transform_feedback3),
+        and the primitive topology of the current graphics pipeline is used.
+        \note Only supported with: OpenGL (with GL_ARB_transform_feedback2), Direct3D 11.
+        \see BeginStreamOutput
+        \see EndStreamOutput
+        */
+        virtual void DrawStreamOutput() = 0;
+
+        /**
+        \brief Draws mesh tasks with the currently set mesh shader pipeline.
+        \param[in] groupSizeX Specifies the number of thread groups in the X-dimension.
+        \param[in] groupSizeY Specifies the number of thread groups in the Y-dimension.
+        \param[in] groupSizeZ Specifies the number of thread groups in the Z-dimension.
+        \remarks The thread groups are launched for the amplification shader, or for the mesh shader if the pipeline has no amplification shader.
+        No vertex or index buffers are used for this draw command.
+        \note For OpenGL (with GL_NV_mesh_shader), only one-dimensional tasks are supported, i.e. \c groupSizeY and \c groupSizeZ must be 1.
+        \see ShaderProgramDescriptor::meshShader
+        \see RenderingFeatures::hasMeshShaders
+        \see RenderingLimits::maxMeshTaskWorkGroups
+        */
+        virtual void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) = 0;
+
+        /**
+        \brief Draws mesh tasks with the currently set mesh shader pipeline and the number of thread groups from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the draw arguments. This buffer must have been created with the BufferFlags::IndirectArguments flag.
+        \param[in] offset Specifies the offset (in bytes) of the first argument structure within the buffer. This must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands. Each command reads one DrawMeshTasksIndirectArguments structure.
+        \param[in] stride Specifies the stride (in bytes) between the argument structures. This must be a multiple of 4 and at least <code>sizeof(DrawMeshTasksIndirectArguments)</code>.
+        \note Only supported with: Vulkan (with VK_EXT_mesh_shader).
+        \see DrawMeshTasksIndirectArguments
+        \see RenderingFeatures::hasMeshShaders
+        */
+        virtual void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) = 0;
 
         /* ----- Compute ----- */
 
@@ -438,7 +908,220 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \see SetComputePipeline
         \see RenderingLimits::maxNumComputeShaderWorkGroups
         */
-        virtual void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) = 0;
+        LLGL_DISPATCH_VIRTUAL void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) LLGL_DISPATCH_ABSTRACT;
+
+        /**
+        \brief Dispachtes a compute command with the number of thread groups from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the dispatch arguments. This buffer must have been created with the BufferFlags::IndirectArguments flag.
+        \param[in] offset Specifies the offset (in bytes) of the DispatchIndirectArguments structure within the buffer. This must be a multiple of 4.
+        \see DispatchIndirectArguments
+        \see RenderingFeatures::hasIndirectDrawing
+        */
+        virtual void DispatchIndirect(Buffer& buffer, std::uint64_t offset) = 0;
+
+        /**
+        \brief Makes the shader writes of all previous compute dispatches visible to subsequent dispatches, indirect arguments, and copy commands.
+        \remarks Dispatches do not synchronize with each other implicitly.
+        Use this command between two dispatches where the second one reads the output of the first one, for instance between the passes of a multi-pass compute algorithm.
+        \note Direct3D 11 and Metal track these hazards implicitly, so this command has no effect for these backends.
+        \see Dispatch
+        \see DispatchIndirect
+        */
+        virtual void DispatchBarrier() = 0;
+
+        /* ----- Acceleration Structures ----- */
+
+        /**
+        \brief Builds the specified acceleration structures from the geometry or instance inputs they have been created with.
+        \param[in] numAccelerationStructures Specifies the number of acceleration structures in the array.
+        \param[in] accelerationStructures Pointer to an array of acceleration structures that are built. This must not be null if \c numAccelerationStructures is non-zero.
+        \remarks All builds of one call are batched and may execute concurrently on the GPU, since each acceleration structure has its own scratch memory.
+        A single barrier after the batch makes the results visible to subsequent commands, so a top-level acceleration structure
+        must be built with a separate call after the bottom-level acceleration structures it references:
+        \code
+        myCmdBuffer->BuildAccelerationStructures(static_cast<std::uint32_t>(myBLASes.size()), myBLASes.data());
+        myCmdBuffer->BuildAccelerationStructures(1, &myTLAS);
+        \endcode
+        An acceleration structure can be rebuilt at any time, e.g. after its instance buffer has been updated.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see RenderingFeatures::hasRayQueries
+        */
+        virtual void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) = 0;
+
+        /**
+        \brief Copies an acceleration structure into a compacted acceleration structure, which usually requires much less memory.
+        \param[in] dstAccelerationStructure Specifies the destination acceleration structure. This must have been created with the compacted size of the source (see AccelerationStructureDescriptor::compactedSize).
+        \param[in] srcAccelerationStructure Specifies the source acceleration structure. This must have been created with the AccelerationStructureFlags::AllowCompaction flag and must have been built.
+        \remarks The compacted acceleration structure can be used in place of the source, which can be released afterwards.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see AccelerationStructure::QueryCompactedSize
+        */
+        virtual void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) = 0;
+
+        /* ----- Copy ----- */
+
+        /**
+        \brief Copies a range of bytes from one buffer into another buffer on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer.
+        \param[in] srcBuffer Specifies the source buffer.
+        \param[in] srcOffset Specifies the offset (in bytes) within the source buffer.
+        \param[in] size Specifies the number of bytes to copy.
+        \remarks If source and destination are the same buffer, the two ranges must not overlap.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note For OpenGL, this requires GL 3.1 or the extension GL_ARB_copy_buffer.
+        */
+        virtual void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) = 0;
+
+        /**
+        \brief Copies the hidden counter of a storage buffer into another buffer on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer. The counter is written as 32-bit unsigned integer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer. This must be a multiple of 4.
+        \param[in] srcBuffer Specifies the storage buffer whose counter is copied.
+        This must have been created with the storage type StorageBufferType::AppendStructuredBuffer or StorageBufferType::ConsumeStructuredBuffer.
+        \remarks This can be used to feed the number of elements that a compute shader has appended to a buffer into the arguments of an indirect draw command,
+        e.g. into the \c numInstances field of DrawIndirectArguments for GPU-driven culling, without reading the counter back to the CPU.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \see SetBufferCounter
+        \see DrawIndirect
+        */
+        virtual void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) = 0;
+
+        /**
+        \brief Sets the hidden counter of a storage buffer on the GPU.
+        \param[in] buffer Specifies the storage buffer whose counter is set.
+        This must have been created with the storage type StorageBufferType::AppendStructuredBuffer or StorageBufferType::ConsumeStructuredBuffer.
+        \param[in] value Specifies the new counter value, e.g. zero to reset an append buffer, or the number of elements that can be consumed from a consume buffer.
+        \remarks The counter of a new buffer is zero.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \see CopyCounterToBuffer
+        */
+        virtual void SetBufferCounter(Buffer& buffer, std::uint32_t value) = 0;
+
+        /**
+        \brief Fills a range of a buffer with a 32-bit value on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer. This must be a multiple of 4.
+        \param[in] fillSize Specifies the number of bytes to fill. This must be a multiple of 4.
+        \param[in] value Specifies the 32-bit value that is repeated over the entire range, e.g. zero to reset counters or histograms.
+        \remarks This avoids uploading a CPU-side buffer of the same pattern with RenderSystem::WriteBuffer.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note For OpenGL, this requires GL 4.3 or the extension GL_ARB_clear_buffer_object. Otherwise, the pattern is uploaded with \c glBufferSubData.
+        For Direct3D 11, only storage buffers of type StorageBufferType::RWByteAddressBuffer are filled entirely on the GPU; all other buffers are updated with the pattern.
+        For Direct3D 12, the pattern is copied from the transient memory of the command buffer (see AllocateTransient).
+        \see ClearTexture
+        */
+        virtual void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) = 0;
+
+        /**
+        \brief Copies a region of texels from one texture into another texture on the GPU.
+        \param[in] dstTexture Specifies the destination texture.
+        \param[in] dstLocation Specifies the MIP-map level and offset within the destination texture.
+        \param[in] srcTexture Specifies the source texture.
+        \param[in] srcRegion Specifies the region of the source texture. Its extent also determines the region within the destination texture.
+        \remarks Both textures must have the same format (or at least compatible formats of equal texel size), and the same number of samples.
+        If source and destination are the same texture, the two regions must not overlap.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note For OpenGL, this requires GL 4.3 or the extension GL_ARB_copy_image.
+        */
+        virtual void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) = 0;
+
+        /**
+        \brief Clears a range of MIP-map levels and array layers of a texture on the GPU without binding it as render target attachment.
+        \param[in] texture Specifies the texture to clear. This must not have a compressed format.
+        \param[in] subresource Specifies the MIP-map levels and array layers to clear. For 3D textures, all slices of each MIP-map level are cleared
+        and the array layer range must be 0 to 1.
+        \param[in] clearValue Specifies the clear value. Color textures are cleared with ClearValue::color, whose components are converted to integers for integer formats.
+        Depth-stencil textures are cleared with ClearValue::depth and ClearValue::stencil.
+        \remarks This can be used to clear storage textures (e.g. a histogram) or any other texture, whose content must be reset, without a render pass.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note For OpenGL, this requires GL 4.4 or the extension GL_ARB_clear_texture.
+        For Direct3D 11, the texture must have been created with TextureFlags::AttachmentUsage.
+        Not supported by Direct3D 12 yet.
+        \see FillBuffer
+        */
+        virtual void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) = 0;
+
+        /**
+        \brief Copies the texel data from a buffer into a region of a texture on the GPU.
+        \param[in] dstTexture Specifies the destination texture. This must not be a multi-sampled texture.
+        \param[in] dstRegion Specifies the region of the destination texture.
+        \param[in] srcBuffer Specifies the source buffer.
+        \param[in] srcOffset Specifies the offset (in bytes) of the texel data within the source buffer. This must be a multiple of the texel size.
+        \param[in] rowStride Specifies the size (in bytes) of each row of texels within the buffer. This must be a multiple of the texel size.
+        If this is zero, the rows are tightly packed, i.e. the row stride is <code>dstRegion.extent.width * texelSize</code>. By default 0.
+        \remarks The texel data must have the hardware format of the texture. Each slice (or array layer) consists of <code>dstRegion.extent.height</code> rows,
+        and the slices are tightly packed. Compressed and depth-stencil formats are not supported.
+        This command must not be used inside a render pass (i.e. between BeginRenderPass and EndRenderPass).
+        \note For Direct3D 12, the row stride must be a multiple of 256 and the offset must be a multiple of 512.
+        For Direct3D 11, this command is emulated by mapping a staging copy of the buffer range, which synchronizes the CPU with the GPU.
+        \see FormatBitSize
+        */
+        virtual void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) = 0;
+
+        /**
+        \brief Copies the texel data from a region of a texture into a buffer on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer.
+        \param[in] dstOffset Specifies the offset (in bytes) of the texel data within the destination buffer. This must be a multiple of the texel size.
+        \param[in] srcTexture Specifies the source texture. This must not be a multi-sampled texture.
+        \param[in] srcRegion Specifies the region of the source texture.
+        \param[in] rowStride Specifies the size (in bytes) of each row of texels within the buffer. By default 0.
+        \remarks The same layout rules apply as for the CopyBufferToTexture function.
+        \note For OpenGL, copying only a part of a MIP-map level requires GL 4.5 or the extension GL_ARB_get_texture_sub_image.
+        For Direct3D 11, this command is emulated by mapping a staging copy of the texture, which synchronizes the CPU with the GPU.
+        \see CopyBufferToTexture
+        */
+        virtual void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) = 0;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        /**
+        \brief Begins a new recording of this secondary command buffer.
+        \remarks The commands are recorded after the next call to \c BeginRenderPass (or \c SetRenderTarget), which specifies the render target the commands will be executed with.
+        The previous recording is released, but remains valid for all primary command buffers that have already executed it until they have been completed by the GPU.
+        This is only required after the recording has been ended explicitly, see \c End.
+        \note This has no effect on primary command buffers, which begin and end their recordings implicitly.
+        \see End
+        */
+        virtual void Begin() = 0;
+
+        /**
+        \brief Ends the current recording of this secondary command buffer and keeps it for reuse.
+        \remarks After this call, the recording can be executed any number of times and in any frame with \c ExecuteCommands, i.e. the commands of static scene passes only need to be recorded once.
+        Without an explicit \c End, the next call to \c BeginRenderPass after the recording has been executed implicitly begins a new recording.
+        After this call, no commands must be recorded into this command buffer until \c Begin is called, and \c BeginRenderPass throws an exception.
+        \note This has no effect on primary command buffers, which begin and end their recordings implicitly.
+        With Direct3D 12, reused bundles must not bind resource heaps, since their descriptors are only valid for the frame they have been recorded in.
+        \see Begin
+        \see ExecuteCommands
+        */
+        virtual void End() = 0;
+
+        /**
+        \brief Executes the commands of the specified secondary command buffer within the current render target of this command buffer.
+        \param[in] secondaryCommandBuffer Specifies the secondary command buffer whose recording is to be executed.
+        This must have been created with RenderSystem::CreateSecondaryCommandBuffer, and its render target must be compatible to the current render target of this command buffer.
+        \remarks This ends the recording of the secondary command buffer. The same recording can be executed multiple times until the secondary command buffer begins a new recording.
+        After this call, the states of this command buffer (i.e. pipeline states, resource heaps, vertex- and index buffers, viewports, and scissors) are undefined and must be set again before the next draw command.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see RenderSystem::CreateSecondaryCommandBuffer
+        \see RenderingFeatures::hasSecondaryCommandBuffers
+        */
+        virtual void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) = 0;
 
     protected:
 
@@ -20,7 +20,8 @@ namespace LLGL
 /**
 \brief Extended command buffer interface with dynamic state access for shader resources (i.e. Constant Buffers, Storage Buffers, Textures, and Samplers).
 \remarks This is an extended command interface for the legacy graphics APIs such as OpenGL and Direct3D 11 to dynamically change bounded shader resources.
-\note Only supported with: OpenGL, Direct3D 11.
+With Vulkan, the bound pipeline must have a pipeline layout, whose bindings determine which of the individually bound resources are written into a transient descriptor set before the next draw or dispatch command.
+\note Only supported with: OpenGL, Direct3D 11, Vulkan.
 */
 class LLGL_EXPORT CommandBufferExt : public CommandBuffer
 {
@@ -41,6 +42,26 @@ class LLGL_EXPORT CommandBufferExt : public CommandBuffer
         */
         virtual void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) = 0;
 
+        /**
+        \brief Sets a range of the specified constant buffer at the specified slot index for subsequent drawing and compute operations.
+        \param[in] buffer Specifies the constant buffer to set. This buffer must have been created with the buffer type: BufferType::Constant.
+        \param[in] slot Specifies the slot index where to put the constant buffer.
+        \param[in] offset Specifies the offset (in bytes) of the range. This must be a multiple of RenderingLimits::constantBufferOffsetAlignment.
+        \param[in] size Specifies the size (in bytes) of the range. For Direct3D 11, this must be a multiple of 256.
+        \param[in] stageFlags Specifies at which shader stages the constant buffer is to be set. By default all shader stages are affected.
+        \remarks This allows to store the constants of many objects in a single large constant buffer, instead of one small constant buffer per object.
+        If RenderingFeatures::hasDynamicOffsets is false, the range is ignored and the entire buffer is bound.
+        \see ConstantBufferAllocator
+        \see RenderingFeatures::hasDynamicOffsets
+        */
+        virtual void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) = 0;
+
         /* ----- Storage Buffers ----- */
 
         /**
@@ -10,12 +10,15 @@
 
 
 #include "ColorRGBA.h"
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+class Buffer;
+
 /* ----- Enumerations ----- */
 
 /**
@@ -36,8 +39,98 @@ enum class RenderConditionMode
 };
 
 
+/**
+\brief Command queue type enumeration.
+\see RenderSystem::GetCommandQueue(const QueueType)
+\see CommandBufferDescriptor::queueType
+*/
+enum class QueueType
+{
+    Graphics,   //!< Queue for all kinds of commands, i.e. graphics, compute, and copy commands. This is the default queue.
+    Compute,    //!< Queue for compute and copy commands only, which can be executed asynchronously to the graphics queue.
+
+    /**
+    \brief Queue for compute and copy commands with a lower priority than the graphics and compute queues.
+    \remarks Intended for streaming work that is not bound to a frame, such as texture transcoding or MIP-map generation,
+    which then preferably runs in the idle time of the graphics queue instead of competing with the frame.
+    Command buffers for this queue have the same restrictions as command buffers for the compute queue.
+    \see RenderingFeatures::hasBackgroundQueue
+    */
+    Background,
+};
+
+
 /* ----- Structures ----- */
 
+/**
+\brief Command buffer creation flags enumeration.
+\see CommandBufferDescriptor::flags
+*/
+struct CommandBufferFlags
+{
+    enum
+    {
+        /**
+        \brief Commands are recorded into a buffer and only executed when the command buffer is submitted to the command queue.
+        \remarks This allows to record a command buffer on another thread and to submit the same recording multiple times.
+        The first command that is recorded after the command buffer has been submitted discards the previous recording.
+        For Direct3D 11, the commands are recorded into a deferred context with its own state cache, which is executed on the immediate context with each submission.
+        Each submission executes all commands since the previous submission, unless the recording is enclosed by CommandBuffer::Begin and CommandBuffer::End,
+        in which case the same recording can be submitted multiple times. Query results and timer scopes cannot be retrieved from such a command buffer.
+        Direct3D 12 and Vulkan record their commands anyway.
+        \see CommandQueue::Submit(CommandBuffer&)
+        */
+        DeferredSubmit      = (1 << 0),
+
+        /**
+        \brief Consecutive non-instanced draw commands with the same render states are coalesced into a single multi-draw command.
+        \remarks This reduces the CPU overhead of many small draw commands (e.g. for user interfaces or particle systems).
+        Pending draw commands are submitted as soon as any other command is issued, the render context is presented, the command buffer is submitted,
+        or a buffer or texture is modified with the RenderSystem interface.
+        Only OpenGL makes use of this flag and only for immediate command buffers, since all other renderers record their commands anyway.
+        \see CommandBuffer::Draw
+        \see CommandBuffer::DrawIndexed
+        */
+        MultiDrawBatching = (1 << 1),
+
+        /**
+        \brief Timer scopes additionally collect pipeline statistics, e.g. the number of vertex and fragment shader invocations of each scope.
+        \remarks The statistics are resolved together with the timestamps, i.e. a few frames later without waiting for the GPU (see TimerScope::statistics).
+        Since pipeline statistics queries cannot be nested, the commands between two consecutive begins or ends of any timer scope are measured by one query each,
+        whose results are accumulated into all scopes that are open in between.
+        The command buffer must therefore not record its own pipeline statistics queries (see QueryType::PipelineStatistics) while any timer scope is open.
+        This flag is ignored if the renderer does not support pipeline statistics queries (e.g. OpenGL without \c GL_ARB_pipeline_statistics_query).
+        \see CommandBuffer::BeginTimerScope
+        */
+        TimerScopeStatistics = (1 << 2),
+    };
+};
+
+/**
+\brief Command buffer descriptor structure.
+\see RenderSystem::CreateCommandBuffer
+*/
+struct CommandBufferDescriptor
+{
+    /**
+    \brief Specifies the command buffer creation flags. By default 0.
+    \remarks This can be bitwise OR combination of the entries of the CommandBufferFlags enumeration.
+    \see CommandBufferFlags
+    */
+    long        flags       = 0;
+
+    /**
+    \brief Specifies the type of command queue the command buffer will be submitted to. By default QueueType::Graphics.
+    \remarks Command buffers for the compute queue can only record compute and copy commands, i.e. no render passes and no draw commands.
+    They are always in recording state and each submission with CommandQueue::Submit(CommandBuffer&) begins a new recording.
+    Use timeline fences to synchronize the compute queue with the graphics queue (see CommandQueue::Signal and CommandQueue::Wait).
+    The same applies to command buffers for the background queue.
+    \see RenderingFeatures::hasComputeQueue
+    \see RenderingFeatures::hasBackgroundQueue
+    */
+    QueueType   queueType   = QueueType::Graphics;
+};
+
 /**
 \brief Command buffer clear flags.
 \see CommandBuffer::Clear
@@ -133,6 +226,69 @@ struct AttachmentClear
     ClearValue      clearValue;
 };
 
+/**
+\brief Argument structure of an indirect draw command.
+\remarks The memory layout of this structure is equal for all renderers, so it can be written directly into a buffer by the host program or a compute shader.
+\see CommandBuffer::DrawIndirect
+*/
+struct DrawIndirectArguments
+{
+    std::uint32_t   numVertices;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstVertex;
+    std::uint32_t   firstInstance;
+};
+
+/**
+\brief Argument structure of an indirect indexed draw command.
+\remarks The memory layout of this structure is equal for all renderers, so it can be written directly into a buffer by the host program or a compute shader.
+\see CommandBuffer::DrawIndexedIndirect
+*/
+struct DrawIndexedIndirectArguments
+{
+    std::uint32_t   numIndices;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstIndex;
+    std::int32_t    vertexOffset;
+    std::uint32_t   firstInstance;
+};
+
+/**
+\brief Argument structure of an indirect dispatch command.
+\see CommandBuffer::DispatchIndirect
+*/
+struct DispatchIndirectArguments
+{
+    std::uint32_t   numThreadGroups[3];
+};
+
+/**
+\brief Argument structure of an indirect mesh tasks draw command.
+\remarks The memory layout of this structure is equal for Vulkan (\c VkDrawMeshTasksIndirectCommandEXT) and Direct3D 12 (\c D3D12_DISPATCH_MESH_ARGUMENTS).
+\see CommandBuffer::DrawMeshTasksIndirect
+*/
+struct DrawMeshTasksIndirectArguments
+{
+    std::uint32_t   numThreadGroups[3];
+};
+
+/**
+\brief Transient memory allocation structure.
+\remarks The allocated memory is only valid for the commands of the current recording of the command buffer.
+\see CommandBuffer::AllocateTransient
+*/
+struct TransientAllocation
+{
+    //! Pointer to the allocated memory, which can only be written by the CPU. The memory is not initialized.
+    void*           data    = nullptr;
+
+    //! Constant buffer that contains the allocated memory. This buffer is owned by the command buffer and must not be released.
+    Buffer*         buffer  = nullptr;
+
+    //! Offset (in bytes) of the allocated memory within 'buffer'.
+    std::uint64_t   offset  = 0;
+};
+
 /**
 \brief Graphics API dependent state descriptor for the OpenGL renderer.
 \remarks This descriptor is used to compensate a few differences between OpenGL and the other rendering APIs.
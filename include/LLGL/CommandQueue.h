@@ -41,6 +41,26 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void Submit(CommandBuffer& commandBuffer) = 0;
 
+        /**
+        \brief Submits multiple command buffers to the command queue in a single batch.
+        \param[in] numCommandBuffers Specifies the number of command buffers.
+        \param[in] commandBuffers Pointer to an array of command buffers. These are executed in the order of the array.
+        \param[in] signalFence Optional pointer to a timeline fence that is signaled once all command buffers of this batch have been completed. By default null.
+        \param[in] signalValue Specifies the value the timeline fence is signaled with. This is ignored if 'signalFence' is null. By default 0.
+        \remarks This is equivalent to submitting each command buffer with Submit(CommandBuffer&) followed by Signal(*signalFence, signalValue),
+        but Direct3D 12 and Vulkan submit the command buffers with a single call to \c ExecuteCommandLists and \c vkQueueSubmit respectively,
+        which avoids the overhead of one submission per command buffer, e.g. when the command buffers have been recorded by multiple threads.
+        The waits that have been issued with Wait(Fence&, std::uint64_t) apply to the entire batch.
+        \see Signal
+        \see Wait
+        */
+        virtual void Submit(
+            std::uint32_t           numCommandBuffers,
+            CommandBuffer* const*   commandBuffers,
+            Fence*                  signalFence = nullptr,
+            std::uint64_t           signalValue = 0
+        ) = 0;
+
         /* ----- Fences ----- */
 
         //! Submits the specified fence to the command queue for CPU/GPU synchronization.
@@ -68,6 +88,64 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void WaitIdle() = 0;
 
+        /* ----- Timeline fences ----- */
+
+        /**
+        \brief Signals the specified timeline fence with a value once the GPU has completed all previously submitted commands.
+        \param[in] fence Specifies the timeline fence to signal.
+        \param[in] value Specifies the value the fence is signaled with. This must be greater than all values the fence has been signaled with before.
+        \remarks In contrast to Submit(Fence&), the fence does not need to be waited for before it is signaled again,
+        and each value can be waited for individually by the CPU (see WaitFenceValue) and the GPU (see Wait).
+        \see Fence::GetCompletedValue
+        \see RenderingFeatures::hasTimelineFences
+        */
+        virtual void Signal(Fence& fence, std::uint64_t value) = 0;
+
+        /**
+        \brief Lets the GPU wait until the specified timeline fence has been signaled with a value greater than or equal to the specified value, without blocking the CPU.
+        \param[in] fence Specifies the timeline fence to wait for.
+        \param[in] value Specifies the value the fence must have been signaled with before subsequently submitted commands are executed.
+        \remarks This allows to synchronize with fences that are signaled from another thread without a round trip to the CPU,
+        e.g. with fences signaled by an OpenGL worker thread (see RenderSystem::AttachWorkerThread).
+        For Vulkan, the wait applies to the next command buffer submission, which happens when the render context is presented,
+        or for the compute queue, when the next command buffer is submitted with Submit(CommandBuffer&).
+        For OpenGL and Direct3D 11, the respective Signal call must have been made before this function is called.
+        Direct3D 11 executes all commands in order, so this function has no effect there.
+        \see Signal
+        */
+        virtual void Wait(Fence& fence, std::uint64_t value) = 0;
+
+        /**
+        \brief Blocks the CPU execution until the specified timeline fence has been signaled with a value greater than or equal to the specified value.
+        \param[in] fence Specifies the timeline fence to wait for.
+        \param[in] value Specifies the value to wait for.
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds).
+        \return True on success, or false if the fence has a timeout or the device is lost.
+        \see Signal
+        */
+        virtual bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) = 0;
+
+        /**
+        \brief Blocks the CPU execution until all of the specified fences have been signaled.
+        \param[in] numFences Specifies the number of fences.
+        \param[in] fences Pointer to an array of fences to wait for.
+        \param[in] values Optional pointer to an array of timeline values, one for each fence.
+        If this is null, the fences are waited for like binary fences (see WaitFence). Otherwise, each fence is waited for like a timeline fence (see WaitFenceValue).
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds).
+        \return True on success, or false if any of the fences has a timeout or the device is lost.
+        \remarks This is more efficient than waiting for each fence individually, e.g. when a loader thread waits for the completion of multiple resource uploads.
+        Direct3D 12 and Vulkan wait for all fences with a single operation.
+        Waiting for fences is thread-safe, i.e. multiple threads can wait for the same fences concurrently.
+        \see WaitFence
+        \see WaitFenceValue
+        */
+        virtual bool WaitFences(
+            std::uint32_t           numFences,
+            Fence* const*           fences,
+            const std::uint64_t*    values,
+            std::uint64_t           timeout
+        ) = 0;
+
     protected:
 
         CommandQueue() = default;
@@ -0,0 +1,220 @@
+/*
+ * ComputePrimitives.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COMPUTE_PRIMITIVES_H
+#define LLGL_COMPUTE_PRIMITIVES_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class CommandBuffer;
+class Buffer;
+class Shader;
+class ShaderProgram;
+class PipelineLayout;
+class ComputePipeline;
+class ResourceHeap;
+
+/**
+\brief Compute primitives descriptor structure.
+\see ComputePrimitives::ComputePrimitives
+*/
+struct ComputePrimitivesDescriptor
+{
+    /**
+    \brief Specifies the maximum number of elements that can be processed with a single operation. This must be greater than zero. By default 0.
+    \remarks The internal storage buffers of the compute primitives are allocated for this number of 32-bit elements.
+    */
+    std::uint32_t maxNumElements = 0;
+
+    /**
+    \brief Specifies the number of threads per wave (or warp) of the device. By default 0.
+    \remarks If this is zero, the wave size is taken from RenderingLimits::maxSubgroupSize. If the renderer does not report a subgroup size,
+    the wave size is derived from the vendor of the renderer (see RendererInfo::vendorName), i.e. 32 for NVIDIA, 64 for AMD, 16 for Intel, and 32 for any other vendor. The size of each thread group is a multiple of the wave size between 64 and 256.
+    */
+    std::uint32_t waveSize       = 0;
+};
+
+/**
+\brief Parallel prefix sum, radix sort, and stream compaction of 32-bit unsigned integers on the GPU.
+
+This class is not required for any interaction with the render system.
+It can be used as utility for GPU-driven pipelines (e.g. culling, particle sorting, order-independent transparency)
+that would otherwise need backend specific compute kernels. All operations are recorded into a command buffer and never wait for the GPU.
+\remarks The operations work on internal storage buffers, so the source and destination buffers only need to be valid for copy commands (see CommandBuffer::CopyBuffer).
+The data is copied into the internal buffers at the beginning of each operation and copied back at the end,
+hence the same ComputePrimitives instance can record several operations into one command buffer in sequence, but not into multiple command buffers concurrently.
+\note Only supported with render systems that compile HLSL or GLSL compute shaders at runtime (i.e. Direct3D 11 and OpenGL 4.3+).
+\code
+LLGL::ComputePrimitivesDescriptor computeDesc;
+computeDesc.maxNumElements = numParticles;
+LLGL::ComputePrimitives myCompute { *myRenderer, computeDesc };
+
+// Sort the particle indices by their quantized view depth:
+myCompute.RadixSort(*myCmdBuffer, *myDepthKeys, *myParticleIndices, numParticles);
+\endcode
+*/
+class LLGL_EXPORT ComputePrimitives : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs the compute primitives, compiles all compute kernels, and creates the internal storage buffers with the specified render system.
+        \throws std::invalid_argument If 'desc.maxNumElements' is zero or exceeds the number of elements that can be dispatched with a single dimension of thread groups.
+        \throws std::runtime_error If the render system does not support compute shaders, or supports neither HLSL nor GLSL.
+        */
+        ComputePrimitives(RenderSystem& renderSystem, const ComputePrimitivesDescriptor& desc);
+
+        //! Releases all compute pipelines and storage buffers of these compute primitives.
+        ~ComputePrimitives();
+
+        /**
+        \brief Computes the exclusive prefix sum of 32-bit unsigned integers.
+        \param[in] commandBuffer Specifies the command buffer to record the operation into.
+        \param[out] dstBuffer Specifies the buffer that receives the prefix sums. This can be the same as 'srcBuffer'.
+        \param[in] srcBuffer Specifies the buffer with the input values.
+        \param[in] numElements Specifies the number of 32-bit elements. This must not be greater than GetMaxNumElements.
+        \remarks The element \c i of the destination buffer is the sum of all source elements in the range <code>[0, i)</code>, with wrap around on overflow.
+        */
+        void PrefixSum(CommandBuffer& commandBuffer, Buffer& dstBuffer, Buffer& srcBuffer, std::uint32_t numElements);
+
+        /**
+        \brief Sorts 32-bit unsigned integer keys in ascending order.
+        \param[in] commandBuffer Specifies the command buffer to record the operation into.
+        \param[in,out] keyBuffer Specifies the buffer with the keys, which are sorted in place.
+        \param[in] numElements Specifies the number of keys. This must not be greater than GetMaxNumElements.
+        \param[in] numKeyBits Specifies the number of low-order bits of each key that are sorted. This must be in the range [1, 32]. By default 32.
+        Sorting fewer bits saves one pass for every 4 bits, but all remaining high-order bits must be zero.
+        \remarks The sort is stable. Floating-point keys must be converted into an order preserving unsigned integer representation beforehand.
+        */
+        void RadixSort(CommandBuffer& commandBuffer, Buffer& keyBuffer, std::uint32_t numElements, std::uint32_t numKeyBits = 32);
+
+        /**
+        \brief Sorts key-value pairs by their 32-bit unsigned integer keys in ascending order.
+        \param[in] commandBuffer Specifies the command buffer to record the operation into.
+        \param[in,out] keyBuffer Specifies the buffer with the keys, which are sorted in place.
+        \param[in,out] valueBuffer Specifies the buffer with one 32-bit value per key, which are reordered together with their keys.
+        \param[in] numElements Specifies the number of key-value pairs. This must not be greater than GetMaxNumElements.
+        \param[in] numKeyBits Specifies the number of low-order bits of each key that are sorted. This must be in the range [1, 32]. By default 32.
+        All remaining high-order bits must be zero.
+        \remarks The sort is stable, i.e. values with equal keys keep their relative order.
+        */
+        void RadixSort(CommandBuffer& commandBuffer, Buffer& keyBuffer, Buffer& valueBuffer, std::uint32_t numElements, std::uint32_t numKeyBits = 32);
+
+        /**
+        \brief Compacts all 32-bit elements whose flag is non-zero into a contiguous range, preserving their order.
+        \param[in] commandBuffer Specifies the command buffer to record the operation into.
+        \param[out] dstBuffer Specifies the buffer that receives the selected elements. All elements after the selected ones are undefined.
+        \param[out] countBuffer Specifies the buffer that receives the number of selected elements as 32-bit unsigned integer,
+        e.g. to generate the arguments of an indirect draw or dispatch command.
+        \param[in] countOffset Specifies the offset (in bytes) into 'countBuffer' where the number of selected elements is written to.
+        \param[in] srcBuffer Specifies the buffer with the input elements.
+        \param[in] flagBuffer Specifies the buffer with one 32-bit flag per input element.
+        \param[in] numElements Specifies the number of input elements. This must not be greater than GetMaxNumElements.
+        */
+        void Compact(
+            CommandBuffer&  commandBuffer,
+            Buffer&         dstBuffer,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            Buffer&         srcBuffer,
+            Buffer&         flagBuffer,
+            std::uint32_t   numElements
+        );
+
+        //! Returns the maximum number of elements that can be processed with a single operation.
+        inline std::uint32_t GetMaxNumElements() const
+        {
+            return maxNumElements_;
+        }
+
+        //! Returns the number of threads per thread group of all compute kernels.
+        inline std::uint32_t GetThreadGroupSize() const
+        {
+            return threadGroupSize_;
+        }
+
+    private:
+
+        enum Kernel
+        {
+            Kernel_ScanGroups = 0,
+            Kernel_AddGroupSums,
+            Kernel_RadixCount,
+            Kernel_RadixScatter,
+            Kernel_CompactFlags,
+            Kernel_CompactScatter,
+
+            Kernel_Num,
+        };
+
+        void CreateStorageBuffers();
+        void CreateKernels();
+        void CreateResourceHeaps();
+
+        void AssertNumElements(std::uint32_t numElements) const;
+
+        std::uint32_t GetNumGroups(std::uint32_t numElements) const;
+
+        // Constants of all compute kernels, which are set with CommandBuffer::SetConstants.
+        struct KernelConstants
+        {
+            std::uint32_t numElements   = 0;
+            std::uint32_t dataOffset    = 0;    // Offset (in elements) of the data to scan within the scan buffer
+            std::uint32_t sumsOffset    = 0;    // Offset (in elements) of the group sums within the scan buffer
+            std::uint32_t numGroups     = 0;    // Number of thread groups of the radix sort passes
+            std::uint32_t shift         = 0;    // Bit shift of the radix sort digit
+            std::uint32_t hasValues     = 0;    // Specifies whether values are reordered together with their keys
+            std::uint32_t padding[2]    = {};
+        };
+
+        // Records a dispatch of the specified kernel with one thread per element.
+        void Dispatch(CommandBuffer& commandBuffer, Kernel kernel, const KernelConstants& constants, std::uint32_t pingPong = 0);
+
+        // Records the exclusive prefix sum of the scan buffer at the specified level (recursively for all higher levels).
+        void ScanLevel(CommandBuffer& commandBuffer, std::uint32_t level, std::uint32_t numElements);
+
+        void SortPasses(CommandBuffer& commandBuffer, std::uint32_t numElements, std::uint32_t numKeyBits, bool hasValues);
+
+    private:
+
+        RenderSystem&                   renderSystem_;
+        std::uint32_t                   maxNumElements_     = 0;
+        std::uint32_t                   threadGroupSize_    = 0;
+
+        Buffer*                         keyBuffers_[2]      = {};
+        Buffer*                         valueBuffers_[2]    = {};
+        Buffer*                         scanBuffer_         = nullptr;      // Prefix sums and group sums of all levels
+        std::vector<std::uint32_t>      scanLevelOffsets_;                  // Offsets (in elements) of each level within the scan buffer
+
+        std::vector<Shader*>            shaders_;
+        std::vector<ShaderProgram*>     shaderPrograms_;
+        PipelineLayout*                 pipelineLayout_     = nullptr;
+        ComputePipeline*                pipelines_[Kernel_Num] = {};
+        ResourceHeap*                   resourceHeaps_[2]   = {};           // Resource heaps for both directions of the ping-pong buffers
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
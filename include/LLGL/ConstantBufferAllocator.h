@@ -0,0 +1,146 @@
+/*
+ * ConstantBufferAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CONSTANT_BUFFER_ALLOCATOR_H
+#define LLGL_CONSTANT_BUFFER_ALLOCATOR_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Buffer;
+
+/**
+\brief Constant buffer allocator descriptor structure.
+\see ConstantBufferAllocator::ConstantBufferAllocator
+*/
+struct ConstantBufferAllocatorDescriptor
+{
+    /**
+    \brief Specifies the size (in bytes) of the constant buffer, i.e. the capacity for all allocations of one frame. By default 65536.
+    \remarks For Direct3D 11, a single range must not be larger than 65536 bytes, but the buffer itself can be larger.
+    */
+    std::uint64_t size = 65536;
+};
+
+/**
+\brief Range of a constant buffer that has been allocated with a ConstantBufferAllocator.
+\see ConstantBufferAllocator::Allocate
+*/
+struct ConstantBufferRange
+{
+    //! Offset (in bytes) of the range. This is a multiple of RenderingLimits::constantBufferOffsetAlignment.
+    std::uint64_t offset    = 0;
+
+    //! Size (in bytes) of the range. This is rounded up to a multiple of RenderingLimits::constantBufferOffsetAlignment.
+    std::uint64_t size      = 0;
+};
+
+/**
+\brief Per-frame linear allocator for the constants of many objects within a single large constant buffer.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to replace many small constant buffers (e.g. one per object) by ranges of one large constant buffer,
+which reduces the number of buffer objects and the number of RenderSystem::WriteBuffer calls to one per frame.
+\remarks The ranges are bound with CommandBufferExt::SetConstantBufferRange or with the dynamic offsets of a resource heap,
+which requires RenderingFeatures::hasDynamicOffsets.
+\code
+LLGL::ConstantBufferAllocatorDescriptor allocatorDesc;
+allocatorDesc.size = 1024 * 1024;
+LLGL::ConstantBufferAllocator myAllocator { *myRenderer, allocatorDesc };
+
+// Each frame:
+myAllocator.Reset();
+for (auto& obj : myObjects)
+    obj.constantsRange = myAllocator.Allocate(&obj.constants, sizeof(obj.constants));
+myAllocator.Flush();
+
+for (auto& obj : myObjects)
+{
+    myCmdBufferExt->SetConstantBufferRange(myAllocator.GetBuffer(), 0, obj.constantsRange.offset, obj.constantsRange.size);
+    DrawObject(*myCmdBufferExt, obj);
+}
+\endcode
+\see CommandBufferExt::SetConstantBufferRange
+*/
+class LLGL_EXPORT ConstantBufferAllocator : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs the constant buffer allocator and creates its constant buffer with the specified render system.
+        \remarks The constant buffer is created with BufferFlags::DynamicUsage.
+        \throws std::invalid_argument If 'desc.size' is zero.
+        */
+        ConstantBufferAllocator(RenderSystem& renderSystem, const ConstantBufferAllocatorDescriptor& desc);
+
+        //! Releases the constant buffer of this allocator.
+        ~ConstantBufferAllocator();
+
+        /**
+        \brief Allocates a new range and copies the specified constants into the CPU shadow of the constant buffer.
+        \param[in] data Raw pointer to the constants. This may be null to only reserve the range.
+        \param[in] dataSize Specifies the size (in bytes) of the constants.
+        \return Range of the constant buffer. The constants are only written into the constant buffer with the next call to Flush.
+        \throws std::out_of_range If the constant buffer has not enough space left for the range.
+        */
+        ConstantBufferRange Allocate(const void* data, std::uint64_t dataSize);
+
+        /**
+        \brief Writes all ranges that have been allocated since the last flush into the constant buffer.
+        \remarks This must be called before any command that uses these ranges is executed.
+        \see RenderSystem::WriteBuffer
+        */
+        void Flush();
+
+        /**
+        \brief Discards all allocations and starts with the next frame at the beginning of the constant buffer.
+        \remarks Ranges that have not been flushed are lost.
+        */
+        void Reset();
+
+        //! Returns the constant buffer that holds all ranges of this allocator.
+        inline Buffer& GetBuffer() const
+        {
+            return *buffer_;
+        }
+
+        //! Returns the number of bytes that have been allocated since the last reset.
+        inline std::uint64_t GetAllocatedSize() const
+        {
+            return offset_;
+        }
+
+    private:
+
+        RenderSystem&       renderSystem_;
+        Buffer*             buffer_         = nullptr;
+        std::vector<char>   shadow_;
+        std::uint64_t       alignment_      = 16;
+        std::uint64_t       offset_         = 0;
+        std::uint64_t       flushedOffset_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
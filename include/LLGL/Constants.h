@@ -47,6 +47,18 @@ static const std::uint32_t  invalidSlot         = ~0;
 */
 static const std::uint64_t  invalidQueryResult  = ~0;
 
+/**
+\brief Specifies an invalid index of a timer scope, i.e. the parent index of a root scope.
+\see TimerScope::parent
+*/
+static const std::uint32_t  invalidTimerScope   = ~0;
+
+/**
+\brief Specifies an invalid identifier of a transient render graph texture, i.e. a render graph pass without depth-stencil attachment.
+\see RenderGraphPassDescriptor::depthStencilAttachment
+*/
+static const std::uint32_t  invalidRenderGraphTexture = ~0;
+
 
 } // /namespace Constants
 
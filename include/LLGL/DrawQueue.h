@@ -0,0 +1,160 @@
+/*
+ * DrawQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DRAW_QUEUE_H
+#define LLGL_DRAW_QUEUE_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class CommandBuffer;
+class GraphicsPipeline;
+class ResourceHeap;
+class Buffer;
+
+/**
+\brief Draw packet structure with all states and arguments of a single draw call.
+\see DrawQueue::Push
+*/
+struct DrawPacket
+{
+    /**
+    \brief Specifies the sort key of this draw packet. Packets are submitted in ascending order of their sort keys.
+    \remarks The most expensive state changes should be encoded in the most significant bits,
+    e.g. the pipeline in bits [48, 64), the resource heap in bits [32, 48), and the quantized depth in the lower bits.
+    Packets with equal sort keys keep the order in which they have been pushed.
+    */
+    std::uint64_t       sortKey         = 0;
+
+    //! Specifies the graphics pipeline. This must not be null.
+    GraphicsPipeline*   pipeline        = nullptr;
+
+    //! Specifies the optional resource heap. If this is null, the previously bound resource heap remains active.
+    ResourceHeap*       resourceHeap    = nullptr;
+
+    //! Specifies the optional vertex buffer. If this is null, the previously bound vertex buffer remains active.
+    Buffer*             vertexBuffer    = nullptr;
+
+    //! Specifies the optional index buffer. If this is non-null, the packet is drawn with indices.
+    Buffer*             indexBuffer     = nullptr;
+
+    //! Specifies the number of vertices, or the number of indices if 'indexBuffer' is non-null.
+    std::uint32_t       numVertices     = 0;
+
+    //! Specifies the first vertex, or the first index if 'indexBuffer' is non-null.
+    std::uint32_t       firstVertex     = 0;
+
+    //! Specifies the base vertex offset for indexed draw calls. This is ignored if 'indexBuffer' is null.
+    std::int32_t        vertexOffset    = 0;
+
+    //! Specifies the number of instances. By default 1.
+    std::uint32_t       numInstances    = 1;
+
+    //! Specifies the first instance. By default 0.
+    std::uint32_t       firstInstance   = 0;
+};
+
+/**
+\brief Queue of draw packets that are sorted by their keys and submitted with a minimal number of state changes.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to record draw calls in any order and let the queue determine the order of submission,
+instead of sorting the draw calls by their states on the application side.
+\code
+LLGL::DrawQueue myDrawQueue;
+
+// Each frame:
+myDrawQueue.Clear();
+for (auto& obj : myObjects)
+{
+    LLGL::DrawPacket packet;
+    {
+        packet.sortKey      = (std::uint64_t(obj.pipelineID) << 48) | (std::uint64_t(obj.materialID) << 32) | obj.quantizedDepth;
+        packet.pipeline     = obj.pipeline;
+        packet.resourceHeap = obj.material;
+        packet.vertexBuffer = obj.vertexBuffer;
+        packet.indexBuffer  = obj.indexBuffer;
+        packet.numVertices  = obj.numIndices;
+    }
+    myDrawQueue.Push(packet);
+}
+myDrawQueue.Sort();
+
+myCmdBuffer->BeginRenderPass(...);
+myDrawQueue.Submit(*myCmdBuffer);
+myCmdBuffer->EndRenderPass();
+\endcode
+*/
+class LLGL_EXPORT DrawQueue : public NonCopyable
+{
+
+    public:
+
+        //! Removes all draw packets from this queue. The memory of the queue is kept for the next frame.
+        void Clear();
+
+        //! Reserves memory for the specified number of draw packets.
+        void Reserve(std::size_t numPackets);
+
+        //! Appends the specified draw packet to this queue.
+        void Push(const DrawPacket& packet);
+
+        /**
+        \brief Sorts all draw packets in ascending order of their sort keys.
+        \remarks This is a stable radix sort. Large queues are sorted with multiple threads.
+        Only the bytes in which the sort keys actually differ are processed, so keys with only a few distinct bits are sorted in fewer passes.
+        */
+        void Sort();
+
+        /**
+        \brief Records all draw packets into the specified command buffer in the current order, i.e. in sorted order after a call to Sort.
+        \remarks States that are equal to the states of the previous packet are not bound again.
+        The resource heap is always bound again after the pipeline changed, since a different pipeline layout invalidates the bound resources.
+        This must be called inside a render pass. The queue is not cleared by this function, so it can be submitted multiple times.
+        \throws std::invalid_argument If the pipeline of any draw packet is null.
+        */
+        void Submit(CommandBuffer& commandBuffer) const;
+
+        //! Returns the number of draw packets in this queue.
+        inline std::size_t GetNumPackets() const
+        {
+            return packets_.size();
+        }
+
+    private:
+
+        struct SortEntry
+        {
+            std::uint64_t sortKey;
+            std::uint32_t index;
+        };
+
+    private:
+
+        std::vector<DrawPacket> packets_;
+        std::vector<SortEntry>  entries_;
+        std::vector<SortEntry>  entriesTemp_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
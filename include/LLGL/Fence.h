@@ -10,6 +10,7 @@
 
 
 #include "RenderSystemChild.h"
+#include <cstdint>
 
 
 namespace LLGL
@@ -18,11 +19,28 @@ namespace LLGL
 
 /**
 \brief Fence interface for CPU/GPU synchronization.
+\remarks A fence can either be used as binary fence with CommandQueue::Submit(Fence&) and CommandQueue::WaitFence,
+or as 64-bit timeline fence with CommandQueue::Signal, CommandQueue::Wait, and CommandQueue::WaitFenceValue.
+Both kinds of operations must not be mixed on the same fence.
 \see RenderSystem::CreateFence
 \see CommandQueue::Submit(Fence&)
 \see CommandQueue::WaitFence
+\see CommandQueue::Signal
 */
-class LLGL_EXPORT Fence : public RenderSystemChild { };
+class LLGL_EXPORT Fence : public RenderSystemChild
+{
+
+    public:
+
+        /**
+        \brief Returns the greatest value the GPU has signaled this timeline fence with. Initially 0.
+        \remarks This does not block the CPU execution.
+        \see CommandQueue::Signal
+        \see RenderingFeatures::hasTimelineFences
+        */
+        virtual std::uint64_t GetCompletedValue() = 0;
+
+};
 
 
 } // /namespace LLGL
@@ -10,6 +10,7 @@
 
 
 #include "Export.h"
+#include "Types.h"
 #include <cstdint>
 
 
@@ -105,6 +106,11 @@ enum class Format
     BGRA8SInt,          //!< Color format: blue, green, red, alpha 8-bit signed integer components. \note Only supported with: Vulkan, Metal.
     BGRA8sRGB,          //!< Color format: blue, green, red, alpha 8-bit normalized unsigned integer components in sRGB non-linear color space. \note Only supported with: Vulkan, Direct3D 11, Direct3D 12, Metal.
 
+    /* --- Packed color formats --- */
+    RGB10A2UNorm,       //!< Packed color format: red, green, blue 10-bit and alpha 2-bit normalized unsigned integer components in a single 32-bit value (red in the least significant bits). \see QuantizeRGB10A2UNorm
+    RGB10A2UInt,        //!< Packed color format: red, green, blue 10-bit and alpha 2-bit unsigned integer components in a single 32-bit value (red in the least significant bits). \note Not supported as vertex attribute format with OpenGL.
+    RG11B10Float,       //!< Packed color format: red, green 11-bit and blue 10-bit unsigned floating point components in a single 32-bit value (red in the least significant bits).
+
     /* --- Depth-stencil formats --- */
     D16UNorm,           //!< Depth-stencil format: depth 16-bit normalized unsigned integer component.
     D24UNormS8UInt,     //!< Depth-stencil format: depth 24-bit normalized unsigned integer component, and 8-bit unsigned integer stencil component.
@@ -116,6 +122,58 @@ enum class Format
     BC1RGBA,            //!< Compressed color format: RGBA S3TC DXT1 with 8 bytes per 4x4 block.
     BC2RGBA,            //!< Compressed color format: RGBA S3TC DXT3 with 16 bytes per 4x4 block.
     BC3RGBA,            //!< Compressed color format: RGBA S3TC DXT5 with 16 bytes per 4x4 block.
+    BC1RGBAsRGB,        //!< Compressed color format: RGBA S3TC DXT1 with 8 bytes per 4x4 block in sRGB non-linear color space.
+    BC2RGBAsRGB,        //!< Compressed color format: RGBA S3TC DXT3 with 16 bytes per 4x4 block in sRGB non-linear color space.
+    BC3RGBAsRGB,        //!< Compressed color format: RGBA S3TC DXT5 with 16 bytes per 4x4 block in sRGB non-linear color space.
+    BC4RUNorm,          //!< Compressed color format: red component RGTC1 with 8 bytes per 4x4 block (normalized unsigned).
+    BC4RSNorm,          //!< Compressed color format: red component RGTC1 with 8 bytes per 4x4 block (normalized signed).
+    BC5RGUNorm,         //!< Compressed color format: red, green components RGTC2 with 16 bytes per 4x4 block (normalized unsigned).
+    BC5RGSNorm,         //!< Compressed color format: red, green components RGTC2 with 16 bytes per 4x4 block (normalized signed).
+    BC6HRGBUFloat,      //!< Compressed color format: RGB BPTC unsigned floating-point with 16 bytes per 4x4 block (HDR).
+    BC6HRGBSFloat,      //!< Compressed color format: RGB BPTC signed floating-point with 16 bytes per 4x4 block (HDR).
+    BC7RGBAUNorm,       //!< Compressed color format: RGBA BPTC with 16 bytes per 4x4 block.
+    BC7RGBAsRGB,        //!< Compressed color format: RGBA BPTC with 16 bytes per 4x4 block in sRGB non-linear color space.
+
+    /* --- ETC2/EAC and ASTC compressed color formats --- */
+    ETC2RGB8UNorm,      //!< Compressed color format: RGB ETC2 with 8 bytes per 4x4 block. \note Only supported with: OpenGL, Vulkan.
+    ETC2RGB8sRGB,       //!< Compressed color format: RGB ETC2 with 8 bytes per 4x4 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ETC2RGB8A1UNorm,    //!< Compressed color format: RGB ETC2 with 1-bit punch-through alpha and 8 bytes per 4x4 block. \note Only supported with: OpenGL, Vulkan.
+    ETC2RGB8A1sRGB,     //!< Compressed color format: RGB ETC2 with 1-bit punch-through alpha and 8 bytes per 4x4 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ETC2RGBA8UNorm,     //!< Compressed color format: RGBA ETC2 with EAC alpha and 16 bytes per 4x4 block. \note Only supported with: OpenGL, Vulkan.
+    ETC2RGBA8sRGB,      //!< Compressed color format: RGBA ETC2 with EAC alpha and 16 bytes per 4x4 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    EACR11UNorm,        //!< Compressed color format: red component EAC with 8 bytes per 4x4 block (normalized unsigned). \note Only supported with: OpenGL, Vulkan.
+    EACR11SNorm,        //!< Compressed color format: red component EAC with 8 bytes per 4x4 block (normalized signed). \note Only supported with: OpenGL, Vulkan.
+    EACRG11UNorm,       //!< Compressed color format: red, green components EAC with 16 bytes per 4x4 block (normalized unsigned). \note Only supported with: OpenGL, Vulkan.
+    EACRG11SNorm,       //!< Compressed color format: red, green components EAC with 16 bytes per 4x4 block (normalized signed). \note Only supported with: OpenGL, Vulkan.
+
+    ASTC4x4UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 4x4 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC4x4sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 4x4 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC5x4UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 5x4 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC5x4sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 5x4 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC5x5UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 5x5 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC5x5sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 5x5 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC6x5UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 6x5 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC6x5sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 6x5 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC6x6UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 6x6 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC6x6sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 6x6 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x5UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 8x5 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x5sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 8x5 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x6UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 8x6 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x6sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 8x6 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x8UNorm,       //!< Compressed color format: RGBA ASTC with 16 bytes per 8x8 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC8x8sRGB,        //!< Compressed color format: RGBA ASTC with 16 bytes per 8x8 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x5UNorm,      //!< Compressed color format: RGBA ASTC with 16 bytes per 10x5 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x5sRGB,       //!< Compressed color format: RGBA ASTC with 16 bytes per 10x5 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x6UNorm,      //!< Compressed color format: RGBA ASTC with 16 bytes per 10x6 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x6sRGB,       //!< Compressed color format: RGBA ASTC with 16 bytes per 10x6 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x8UNorm,      //!< Compressed color format: RGBA ASTC with 16 bytes per 10x8 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x8sRGB,       //!< Compressed color format: RGBA ASTC with 16 bytes per 10x8 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x10UNorm,     //!< Compressed color format: RGBA ASTC with 16 bytes per 10x10 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC10x10sRGB,      //!< Compressed color format: RGBA ASTC with 16 bytes per 10x10 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC12x10UNorm,     //!< Compressed color format: RGBA ASTC with 16 bytes per 12x10 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC12x10sRGB,      //!< Compressed color format: RGBA ASTC with 16 bytes per 12x10 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
+    ASTC12x12UNorm,     //!< Compressed color format: RGBA ASTC with 16 bytes per 12x12 block. \note Only supported with: OpenGL, Vulkan.
+    ASTC12x12sRGB,      //!< Compressed color format: RGBA ASTC with 16 bytes per 12x12 block in sRGB non-linear color space. \note Only supported with: OpenGL, Vulkan.
 };
 
 /**
@@ -151,10 +209,31 @@ enum class DataType
 \brief Returns the bit size of the specified hardware format.
 \return Number of bits for one vector of the specified hardware format.
 \remarks This function does not return the size in bytes because some compressed block formats require less than one byte for a single color vector.
+For ASTC formats whose blocks do not have an integral number of bits per texel, the bit size is rounded up.
+Use FormatBlockSize and FormatBlockExtent to determine the exact size of compressed image data.
 \see Format
 */
 LLGL_EXPORT std::uint32_t FormatBitSize(const Format format);
 
+/**
+\brief Returns the size (in bytes) of a single block of the specified hardware format.
+\return Number of bytes for one block of a compressed format (e.g. 8 for Format::BC1RGBA and 16 for Format::BC7RGBAUNorm),
+or the number of bytes for one texel of an uncompressed format. Returns 0 if the size is not a multiple of 8 bits or the format is undefined.
+\see FormatBlockExtent
+*/
+LLGL_EXPORT std::uint32_t FormatBlockSize(const Format format);
+
+/**
+\brief Returns the dimension (in texels) of a single block of the specified hardware format.
+\return Width and height of one block of a compressed format (e.g. 4x4 for Format::BC1RGBA and 8x6 for Format::ASTC8x6UNorm),
+or 1x1 for all uncompressed formats.
+\remarks The size of an image region of compressed format is determined by the number of blocks that are required to cover the region,
+i.e. a MIP-map level of 2x2 texels with a 4x4 block format still requires one entire block.
+\see FormatBlockSize
+\see TextureBufferSize(const Format, const Extent3D&)
+*/
+LLGL_EXPORT Extent2D FormatBlockExtent(const Format format);
+
 /**
 \brief Splits the specified hardware format into a data type and the number of components.
 \see DataType
@@ -164,11 +243,32 @@ LLGL_EXPORT bool SplitFormat(const Format format, DataType& dataType, std::uint3
 
 /**
 \brief Returns true if the specified hardware format is a compressed format,
-i.e. either Format::BC1RGB, Format::BC1RGBA, Format::BC2RGBA, or Format::BC3RGBA.
+i.e. any format of the BC, ETC2/EAC, or ASTC families (from Format::BC1RGB to Format::ASTC12x12sRGB).
 \see Format
 */
 LLGL_EXPORT bool IsCompressedFormat(const Format format);
 
+/**
+\brief Returns true if the specified hardware format is a block-compressed format of the BC family (also "S3TC", "RGTC", and "BPTC"),
+i.e. from Format::BC1RGB to Format::BC7RGBAsRGB.
+\see RenderingFeatures::hasTextureCompressionBC
+*/
+LLGL_EXPORT bool IsCompressedFormatBC(const Format format);
+
+/**
+\brief Returns true if the specified hardware format is a block-compressed format of the ETC2 or EAC family,
+i.e. from Format::ETC2RGB8UNorm to Format::EACRG11SNorm.
+\see RenderingFeatures::hasTextureCompressionETC2
+*/
+LLGL_EXPORT bool IsCompressedFormatETC2(const Format format);
+
+/**
+\brief Returns true if the specified hardware format is a block-compressed format of the ASTC family (LDR profile),
+i.e. from Format::ASTC4x4UNorm to Format::ASTC12x12sRGB.
+\see RenderingFeatures::hasTextureCompressionASTC
+*/
+LLGL_EXPORT bool IsCompressedFormatASTC(const Format format);
+
 /**
 \brief Returns true if the specified hardware format is a depth or depth-stencil format,
 i.e. either Format::DepthComponent, or Format::DepthStencil.
@@ -13,6 +13,7 @@ namespace LLGL
 {
 
 
+class AccelerationStructure;
 class Buffer;
 class BufferArray;
 class Canvas;
@@ -22,9 +23,13 @@ class CommandQueue;
 class ComputePipeline;
 class Fence;
 class GraphicsPipeline;
+class IndirectCommandLayout;
 class PipelineLayout;
 class Query;
+class QueryHeap;
 class RenderContext;
+class RenderGraph;
+class RenderPass;
 class RenderSystem;
 class RenderTarget;
 class Resource;
@@ -38,9 +43,13 @@ class Texture;
 class Timer;
 class Window;
 
+struct AccelerationStructureDescriptor;
+struct AccelerationStructureInstance;
+struct AccelerationStructureTriangles;
 struct ApplicationDescriptor;
 struct AttachmentClear;
 struct AttachmentDescriptor;
+struct AttachmentOpsDescriptor;
 struct BindingDescriptor;
 struct BlendDescriptor;
 struct BlendTargetDescriptor;
@@ -52,11 +61,14 @@ struct DepthDescriptor;
 struct DisplayModeDescriptor;
 struct GraphicsPipelineDescriptor;
 struct ImageInitialization;
+struct IndirectArgumentDescriptor;
+struct IndirectCommandLayoutDescriptor;
 struct MultiSamplingDescriptor;
 struct OpenGLDependentStateDescriptor;
 struct PipelineLayoutDescriptor;
 struct ProfileOpenGLDescriptor;
 struct QueryDescriptor;
+struct QueryHeapDescriptor;
 struct QueryPipelineStatistics;
 struct RasterizerDescriptor;
 struct RendererInfo;
@@ -64,6 +76,8 @@ struct RenderingFeatures;
 struct RenderingLimits;
 struct RenderingCapabilities;
 struct RenderContextDescriptor;
+struct RenderGraphPassDescriptor;
+struct RenderPassDescriptor;
 struct RenderSystemConfiguration;
 struct RenderSystemDescriptor;
 struct RenderTargetDescriptor;
@@ -74,6 +88,7 @@ struct Scissor;
 struct ShaderDescriptor;
 struct ShaderProgramDescriptor;
 struct ShaderReflectionDescriptor;
+struct ShaderSpecializationConstant;
 struct SrcImageDescriptor;
 struct StencilDescriptor;
 struct StencilFaceDescriptor;
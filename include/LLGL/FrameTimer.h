@@ -0,0 +1,163 @@
+/*
+ * FrameTimer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_FRAME_TIMER_H
+#define LLGL_FRAME_TIMER_H
+
+
+#include "Export.h"
+#include "Timer.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Statistics of the samples of a frame timer. All durations are in seconds.
+\see FrameTimer::GetStatistics
+*/
+struct FrameTimerStatistics
+{
+    //! Number of samples the statistics have been computed from.
+    std::size_t numSamples  = 0;
+
+    //! Shortest duration of all samples.
+    double      minTime     = 0.0;
+
+    //! Average duration of all samples.
+    double      meanTime    = 0.0;
+
+    //! Median duration of all samples.
+    double      medianTime  = 0.0;
+
+    //! 99th percentile duration, i.e. 99% of all samples are shorter than or equal to this duration.
+    double      p99Time     = 0.0;
+
+    //! Longest duration of all samples.
+    double      maxTime     = 0.0;
+};
+
+/**
+\brief Lightweight non-virtual timer that keeps a ring buffer of the most recent samples.
+\remarks This timer is based on the Timer::Tick function and is cheap enough to measure individual command buffer calls.
+Only the most recent samples are kept, so the statistics are rolling over the last frames. Example:
+\code
+LLGL::FrameTimer drawTimer;
+for (auto& object : objects)
+{
+    LLGL::ScopedTimer scope { drawTimer };
+    commands->DrawIndexed(object.numIndices, 0);
+}
+auto stats = drawTimer.GetStatistics();
+std::cout << "draw: " << stats.meanTime * 1.0e9 << " ns (p99: " << stats.p99Time * 1.0e9 << " ns)" << std::endl;
+\endcode
+\see ScopedTimer
+\see Timer::Tick
+*/
+class LLGL_EXPORT FrameTimer
+{
+
+    public:
+
+        /**
+        \brief Initializes the frame timer with the specified capacity of its ring buffer.
+        \param[in] capacity Specifies the maximum number of samples. If this is zero, it is clamped to one.
+        */
+        explicit FrameTimer(std::size_t capacity = 256);
+
+        //! Starts a new sample.
+        inline void Start()
+        {
+            startTick_ = Timer::Tick();
+        }
+
+        //! Stops the current sample, adds it to the ring buffer, and returns its duration (in ticks).
+        inline std::uint64_t Stop()
+        {
+            const auto ticks = Timer::Tick() - startTick_;
+            AddSample(ticks);
+            return ticks;
+        }
+
+        /**
+        \brief Adds the specified sample (in ticks of Timer::Tick) to the ring buffer.
+        \remarks If the ring buffer is full, the oldest sample is overwritten.
+        */
+        void AddSample(std::uint64_t ticks);
+
+        //! Removes all samples.
+        void Reset();
+
+        //! Returns the statistics of all samples of the ring buffer.
+        FrameTimerStatistics GetStatistics() const;
+
+        //! Returns the number of samples that are currently in the ring buffer.
+        inline std::size_t GetNumSamples() const
+        {
+            return numSamples_;
+        }
+
+        //! Returns the maximum number of samples of the ring buffer.
+        inline std::size_t GetCapacity() const
+        {
+            return samples_.size();
+        }
+
+    private:
+
+        std::vector<std::uint64_t>  samples_;
+        std::size_t                 nextSample_ = 0;
+        std::size_t                 numSamples_ = 0;
+        std::uint64_t               startTick_  = 0;
+
+};
+
+/**
+\brief Measures the lifetime of this object and adds it as sample to a frame timer.
+\see FrameTimer
+*/
+class ScopedTimer
+{
+
+    public:
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator = (const ScopedTimer&) = delete;
+
+        //! Starts the measurement for the specified frame timer.
+        inline ScopedTimer(FrameTimer& frameTimer) :
+            frameTimer_ { frameTimer    },
+            startTick_  { Timer::Tick() }
+        {
+        }
+
+        //! Stops the measurement and adds the sample to the frame timer.
+        inline ~ScopedTimer()
+        {
+            frameTimer_.AddSample(Timer::Tick() - startTick_);
+        }
+
+    private:
+
+        FrameTimer&     frameTimer_;
+        std::uint64_t   startTick_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
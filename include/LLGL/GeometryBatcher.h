@@ -0,0 +1,188 @@
+/*
+ * GeometryBatcher.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GEOMETRY_BATCHER_H
+#define LLGL_GEOMETRY_BATCHER_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "VertexFormat.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class CommandBuffer;
+class GraphicsPipeline;
+class ResourceHeap;
+class Buffer;
+
+/**
+\brief Geometry batcher descriptor structure.
+\see GeometryBatcher::GeometryBatcher
+*/
+struct GeometryBatcherDescriptor
+{
+    //! Specifies the vertex format of all batched vertices. Its stride must be greater than zero.
+    VertexFormat    vertexFormat;
+
+    /**
+    \brief Specifies the size (in bytes) of each region of the vertex ring buffer. By default 1 MB.
+    \remarks Each flush uploads its vertices into one region, so this limits the number of vertices per flush.
+    */
+    std::uint64_t   regionSize      = 1024 * 1024;
+
+    /**
+    \brief Specifies the number of regions of the vertex ring buffer. By default 8.
+    \remarks A region is overwritten after all other regions have been used, so this must be greater than the number of flushes of all frames that are in flight.
+    */
+    std::uint32_t   numRegions      = 8;
+
+    /**
+    \brief Specifies whether the batches of each flush are reordered to merge all vertices with the same pipeline and resource heap into a single draw call. By default false.
+    \remarks This is only suitable for geometry whose drawing order does not matter (e.g. opaque debug lines), but not for blended UI elements.
+    If this is false, only consecutive vertices with the same states are merged.
+    */
+    bool            sortByState     = false;
+};
+
+/**
+\brief Batches many small dynamic meshes (e.g. sprites, UI elements, and debug lines) into a few large draw calls.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to replace one RenderSystem::WriteBuffer call and one draw call per tiny mesh.
+The vertices are accumulated on the CPU, and consecutive vertices with the same graphics pipeline and resource heap are merged into one draw call.
+Each flush uploads all pending vertices with a single RenderSystem::WriteBuffer call into the next region of a vertex ring buffer
+and records the draw calls through the CommandBuffer interface, so it works with every renderer.
+A flush happens automatically when the current region is full, and at the end of each batch.
+\remarks The graphics pipelines must use a list topology (e.g. PrimitiveTopology::TriangleList or PrimitiveTopology::LineList),
+since the vertices of different meshes are drawn with the same draw call.
+The vertex buffer of the batcher stays bound after each flush, while the pipeline and resource heap of the last draw call remain active.
+\code
+LLGL::GeometryBatcherDescriptor batcherDesc;
+batcherDesc.vertexFormat = mySpriteVertexFormat;
+LLGL::GeometryBatcher myBatcher { *myRenderer, batcherDesc };
+
+myCmdBuffer->BeginRenderPass(...);
+myBatcher.Begin(*myCmdBuffer);
+for (auto& sprite : mySprites)
+{
+    auto vertices = reinterpret_cast<SpriteVertex*>(myBatcher.AddVertices(*mySpritePipeline, sprite.atlasHeap, 6));
+    WriteSpriteQuad(vertices, sprite);
+}
+myBatcher.End();
+myCmdBuffer->EndRenderPass();
+\endcode
+\see DrawQueue
+*/
+class LLGL_EXPORT GeometryBatcher : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs the geometry batcher and creates its vertex ring buffer with the specified render system.
+        \throws std::invalid_argument If the vertex format has a zero stride, if 'desc.numRegions' is zero,
+        or if 'desc.regionSize' is smaller than a single vertex.
+        */
+        GeometryBatcher(RenderSystem& renderSystem, const GeometryBatcherDescriptor& desc);
+
+        //! Releases the vertex ring buffer of this geometry batcher.
+        ~GeometryBatcher();
+
+        /**
+        \brief Begins a new batch that records its draw calls into the specified command buffer.
+        \remarks This must be called inside a render pass, and End must be called before the render pass ends.
+        \throws std::runtime_error If a batch has already been begun.
+        */
+        void Begin(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Allocates the specified number of vertices with the specified states, and returns a pointer to the uninitialized vertex memory.
+        \param[in] pipeline Specifies the graphics pipeline to draw the vertices with.
+        \param[in] resourceHeap Specifies the optional resource heap (e.g. for the texture of a sprite). If this is null, the previously bound resource heap remains active.
+        \param[in] numVertices Specifies the number of vertices.
+        \return Pointer to the memory of 'numVertices' vertices, which must be written before the next call to AddVertices, Flush, or End.
+        \remarks If the vertices do not fit into the current region anymore, the pending vertices are flushed first.
+        \throws std::runtime_error If no batch has been begun.
+        \throws std::out_of_range If the vertices do not fit into a single region.
+        */
+        void* AddVertices(GraphicsPipeline& pipeline, ResourceHeap* resourceHeap, std::uint32_t numVertices);
+
+        /**
+        \brief Uploads all pending vertices into the next region of the vertex ring buffer and records their draw calls.
+        \remarks This is called automatically by AddVertices and End, but it can be called explicitly before other draw calls are recorded
+        that must be drawn after the pending vertices.
+        */
+        void Flush();
+
+        /**
+        \brief Flushes all pending vertices and ends the current batch.
+        \throws std::runtime_error If no batch has been begun.
+        */
+        void End();
+
+        //! Returns the vertex ring buffer of this geometry batcher.
+        inline Buffer& GetBuffer() const
+        {
+            return *buffer_;
+        }
+
+        //! Returns the number of draw calls that have been recorded since the last call to Begin.
+        inline std::uint32_t GetNumDrawCalls() const
+        {
+            return numDrawCalls_;
+        }
+
+    private:
+
+        struct Batch
+        {
+            GraphicsPipeline*   pipeline;
+            ResourceHeap*       resourceHeap;
+            std::uint32_t       firstVertex;
+            std::uint32_t       numVertices;
+        };
+
+    private:
+
+        void SortBatchesByState();
+        void RecordDrawCalls(std::uint64_t firstRegionVertex);
+
+    private:
+
+        RenderSystem&       renderSystem_;
+        Buffer*             buffer_             = nullptr;
+        std::uint32_t       vertexStride_       = 0;
+        std::uint32_t       maxVertices_        = 0;
+        std::uint32_t       numRegions_         = 0;
+        std::uint32_t       region_             = 0;
+        bool                sortByState_        = false;
+
+        CommandBuffer*      commandBuffer_      = nullptr;
+        std::vector<char>   vertices_;
+        std::vector<char>   sortedVertices_;
+        std::vector<Batch>  batches_;
+        std::uint32_t       numVertices_        = 0;
+        std::uint32_t       numDrawCalls_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -19,9 +19,22 @@ namespace LLGL
 /**
 \brief Graphics pipeline interface.
 \see RenderSystem::CreateGraphicsPipeline
+\see RenderSystem::CreateGraphicsPipelineAsync
 \see CommandBuffer::SetGraphicsPipeline
 */
-class LLGL_EXPORT GraphicsPipeline : public RenderSystemChild { };
+class LLGL_EXPORT GraphicsPipeline : public RenderSystemChild
+{
+
+    public:
+
+        /**
+        \brief Returns true if this graphics pipeline has been created and can be bound without blocking.
+        \remarks This is always true for graphics pipelines that have been created with RenderSystem::CreateGraphicsPipeline.
+        \see RenderSystem::CreateGraphicsPipelineAsync
+        */
+        virtual bool IsReady() const;
+
+};
 
 
 } // /namespace LLGL
@@ -232,6 +232,64 @@ enum class LogicOp
     Equiv,          //!< Resulting operation: ~(src ^ dst).
 };
 
+/**
+\brief Variable shading rate enumeration, i.e. the size (in pixels) of the area that is covered by a single fragment shader invocation.
+\remarks The value of each entry is encoded as <code>(log2(width) << 2) | log2(height)</code>,
+which is also the value of each texel in a shading rate image (see CommandBuffer::SetShadingRateImage).
+\note Only supported with: OpenGL (GL_NV_shading_rate_image), Vulkan (VK_KHR_fragment_shading_rate), Direct3D 12 (variable rate shading tier 1 or higher).
+\see CommandBuffer::SetShadingRate
+\see RenderingFeatures::hasVariableRateShading
+*/
+enum class ShadingRate
+{
+    Rate1x1 = 0x0,  //!< One fragment shader invocation per pixel (i.e. full shading rate).
+    Rate1x2 = 0x1,  //!< One fragment shader invocation per 1x2 pixels.
+    Rate2x1 = 0x4,  //!< One fragment shader invocation per 2x1 pixels.
+    Rate2x2 = 0x5,  //!< One fragment shader invocation per 2x2 pixels.
+    Rate2x4 = 0x6,  //!< One fragment shader invocation per 2x4 pixels. Requires RenderingFeatures::hasAdditionalShadingRates.
+    Rate4x2 = 0x9,  //!< One fragment shader invocation per 4x2 pixels. Requires RenderingFeatures::hasAdditionalShadingRates.
+    Rate4x4 = 0xA,  //!< One fragment shader invocation per 4x4 pixels. Requires RenderingFeatures::hasAdditionalShadingRates.
+};
+
+/**
+\brief Graphics pipeline state flags for states that are set with the command buffer instead of the graphics pipeline.
+\remarks The respective values of the graphics pipeline descriptor are ignored for all dynamic states,
+so pipelines that only differ in these values can be merged into a single pipeline.
+\see GraphicsPipelineDescriptor::dynamicStates
+*/
+struct DynamicStateFlags
+{
+    enum
+    {
+        /**
+        \brief The stencil reference value is set with CommandBuffer::SetStencilReference.
+        \see StencilFaceDescriptor::reference
+        */
+        StencilReference    = (1 << 0),
+
+        /**
+        \brief The blend factor is set with CommandBuffer::SetBlendFactor.
+        \see BlendDescriptor::blendFactor
+        */
+        BlendFactor         = (1 << 1),
+
+        /**
+        \brief The depth bias is set with CommandBuffer::SetDepthBias.
+        \note Only supported with: OpenGL, Vulkan.
+        \see RasterizerDescriptor::depthBias
+        */
+        DepthBias           = (1 << 2),
+
+        /**
+        \brief The depth bounds are set with CommandBuffer::SetDepthBounds.
+        \note Only supported with: OpenGL, Vulkan.
+        \see DepthDescriptor::boundsMin
+        \see DepthDescriptor::boundsMax
+        */
+        DepthBounds         = (1 << 3),
+    };
+};
+
 
 /* ----- Structures ----- */
 
@@ -392,6 +450,28 @@ struct DepthDescriptor
 
     //! Specifies the depth test comparison function. By default CompareOp::Less.
     CompareOp   compareOp       = CompareOp::Less;
+
+    /**
+    \brief Specifies whether the depth bounds test is enabled or disabled. By default disabled.
+    \remarks The depth bounds test discards all fragments whose stored depth value lies outside the range [boundsMin, boundsMax],
+    e.g. to skip all pixels outside the volume of a light source in a deferred lighting pass.
+    \note Only supported with: OpenGL (if the extension "GL_EXT_depth_bounds_test" is supported), Vulkan.
+    \see https://www.khronos.org/registry/OpenGL/extensions/EXT/EXT_depth_bounds_test.txt
+    \see RenderingFeatures::hasDepthBoundsTest
+    */
+    bool        boundsTestEnabled   = false;
+
+    /**
+    \brief Specifies the minimum depth bound in the range [0, 1]. By default 0.0.
+    \remarks This is ignored if the graphics pipeline has been created with DynamicStateFlags::DepthBounds.
+    */
+    float       boundsMin           = 0.0f;
+
+    /**
+    \brief Specifies the maximum depth bound in the range [0, 1]. By default 1.0.
+    \remarks This is ignored if the graphics pipeline has been created with DynamicStateFlags::DepthBounds.
+    */
+    float       boundsMax           = 1.0f;
 };
 
 //! Stencil face descriptor structure.
@@ -507,7 +587,8 @@ struct RasterizerDescriptor
 
     /**
     \brief If true, conservative rasterization is enabled. By default disabled.
-    \note Only supported with: Direct3D 12, Direct3D 11.3, OpenGL (if the extension "GL_NV_conservative_raster" or "GL_INTEL_conservative_rasterization" is supported).
+    \note Only supported with: Direct3D 12, Direct3D 11.3, OpenGL (if the extension "GL_NV_conservative_raster" or "GL_INTEL_conservative_rasterization" is supported),
+    Vulkan (if the extension "VK_EXT_conservative_rasterization" is supported).
     \see https://www.opengl.org/registry/specs/NV/conservative_raster.txt
     \see https://www.opengl.org/registry/specs/INTEL/conservative_rasterization.txt
     \see RenderingFeatures::hasConservativeRasterization
@@ -662,6 +743,26 @@ struct GraphicsPipelineDescriptor
 
     //! Specifies the blending state descriptor.
     BlendDescriptor         blend;
+
+    /**
+    \brief Specifies which states are set dynamically with the command buffer. This can be a bitwise OR combination of the DynamicStateFlags entries. By default 0.
+    \remarks The values of dynamic states are undefined until they are set with the command buffer after the graphics pipeline has been bound.
+    \see DynamicStateFlags
+    */
+    long                    dynamicStates       = 0;
+
+    /**
+    \brief Specifies the bit mask of views the graphics pipeline renders into with multiview rendering. By default 0.
+    \remarks Bit \c i enables the view with index \c i. If this is 0, multiview rendering is disabled for this graphics pipeline.
+    Otherwise, the graphics pipeline can only be used with render targets that have been created with RenderTargetDescriptor::numViews greater than 1.
+    This must be <code>(1 << numViews) - 1</code>, i.e. the graphics pipeline always renders into all views of the render target.
+    For Vulkan, the render target is specified by the 'renderTarget' member, whose render pass determines the view mask.
+    For OpenGL, the number of views is declared in the vertex shader with <code>layout(num_views = N) in;</code>.
+    \note Only supported with: Vulkan, OpenGL.
+    \see RenderTargetDescriptor::numViews
+    \see RenderingFeatures::hasMultiView
+    */
+    std::uint32_t           viewMask            = 0;
 };
 
 
@@ -12,13 +12,49 @@
 #include "Export.h"
 #include "Types.h"
 #include "ImageFlags.h"
+#include "ImageView.h"
 #include "SamplerFlags.h"
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+/**
+\brief Image MIP-map chain with all MIP-map levels in a single contiguous image buffer.
+\see Image::GenerateMipChain
+\see SrcImageDescriptor::mipLevels
+*/
+struct ImageMipChain
+{
+    //! Returns a source image descriptor for the entire MIP-map chain, which can be passed to RenderSystem::CreateTexture.
+    inline SrcImageDescriptor QuerySrcDesc() const
+    {
+        SrcImageDescriptor imageDesc { format, dataType, data.get(), dataSize };
+        imageDesc.mipLevels = static_cast<std::uint32_t>(mipOffsets.size());
+        return imageDesc;
+    }
+
+    //! Image format of all MIP-map levels.
+    ImageFormat                 format      = ImageFormat::RGBA;
+
+    //! Data type of all MIP-map levels.
+    DataType                    dataType    = DataType::UInt8;
+
+    //! Image buffer with all MIP-map levels, which are tightly packed one after another beginning with the first MIP-map level.
+    ByteBuffer                  data;
+
+    //! Size (in bytes) of the entire image buffer.
+    std::size_t                 dataSize    = 0;
+
+    //! Offsets (in bytes) of each MIP-map level within the image buffer. The number of MIP-map levels is the size of this container.
+    std::vector<std::size_t>    mipOffsets;
+
+    //! Extents of each MIP-map level. This container has the same size as 'mipOffsets'.
+    std::vector<Extent3D>       mipExtents;
+};
+
 /**
 \brief Utility class to manage the storage and attributes of an image.
 
@@ -108,11 +144,61 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Nearest maps to ImageResizeFilter::Nearest and SamplerFilter::Linear maps to ImageResizeFilter::Bilinear.
+        \param[in] threadCount Specifies the number of threads to use for resampling. By default 0.
+        \see Resize(const Extent3D&, const ImageResizeFilter, std::size_t, const ImageColorSpace)
         */
-        void Resize(const Extent3D& extent, const SamplerFilter filter);
+        void Resize(const Extent3D& extent, const SamplerFilter filter, std::size_t threadCount = 0);
+
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer.
+        \param[in] extent Specifies the new image size.
+        \param[in] filter Specifies the resampling filter. Each dimension is resampled separately.
+        \param[in] threadCount Specifies the number of threads to use for resampling.
+        If this is less than 2, the image is resampled on the calling thread. If this is Constants::maxThreadCount, all available hardware threads are used. By default 0.
+        \param[in] colorSpace Specifies the color space of the color components. If this is ImageColorSpace::sRGB, the pixels are resampled in linear color space,
+        which avoids darkened edges when sRGB images are minified. This requires the data type DataType::UInt8. By default ImageColorSpace::Linear.
+        \remarks The pixels are resampled in single precision (or double precision for DataType::Float64) and clamped to the range of the data type.
+        Integer pixel values are not normalized, i.e. 32-bit integers with large magnitudes may lose precision.
+        \throws std::invalid_argument If the image has a compressed or depth-stencil format.
+        \throws std::invalid_argument If 'colorSpace' is ImageColorSpace::sRGB and the data type is not DataType::UInt8.
+        */
+        void Resize(
+            const Extent3D&         extent,
+            const ImageResizeFilter filter,
+            std::size_t             threadCount = 0,
+            const ImageColorSpace   colorSpace  = ImageColorSpace::Linear
+        );
+
+        /**
+        \brief Generates a MIP-map chain of this image into a single contiguous image buffer.
+        \param[in] textureType Specifies the type of texture the MIP-map chain is generated for. This determines which dimensions are reduced:
+        Only the width is reduced for 1D textures (the height denotes the array layers of 1D array textures),
+        the width and height are reduced for 2D and cube textures (the depth denotes the array layers or cube faces), and all dimensions are reduced for 3D textures.
+        \param[in] filter Specifies the resampling filter. Each MIP-map level is resampled from its previous MIP-map level. By default ImageResizeFilter::Box.
+        \param[in] numMipLevels Specifies the maximum number of MIP-map levels (including the first one). If this is 0, the full MIP-map chain is generated. By default 0.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see Resize). By default 0.
+        \param[in] colorSpace Specifies the color space of the color components. Use ImageColorSpace::sRGB for images that are uploaded into sRGB textures,
+        so the MIP-map levels are filtered in linear color space (see Resize). By default ImageColorSpace::Linear.
+        \return The MIP-map chain, whose first MIP-map level is a copy of this image. Its image descriptor can be passed to RenderSystem::CreateTexture to upload all MIP-map levels at once.
+        If this image has no image buffer, the returned MIP-map chain is empty.
+        \code
+        LLGL::Image image = ...;
+        auto mipChain = image.GenerateMipChain(LLGL::TextureType::Texture2D, LLGL::ImageResizeFilter::Box);
+        auto imageDesc = mipChain.QuerySrcDesc();
+        auto myTexture = myRenderer->CreateTexture(myTextureDesc, &imageDesc);
+        \endcode
+        \throws std::invalid_argument If the image has a compressed or depth-stencil format, or if 'textureType' denotes a multi-sampled texture.
+        \throws std::invalid_argument If 'colorSpace' is ImageColorSpace::sRGB and the data type is not DataType::UInt8.
+        \see SrcImageDescriptor::mipLevels
+        */
+        ImageMipChain GenerateMipChain(
+            const TextureType       textureType,
+            const ImageResizeFilter filter          = ImageResizeFilter::Box,
+            std::uint32_t           numMipLevels    = 0,
+            std::size_t             threadCount     = 0,
+            const ImageColorSpace   colorSpace      = ImageColorSpace::Linear
+        ) const;
 
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
@@ -140,11 +226,23 @@ class LLGL_EXPORT Image
         If the source image is the same object as this image and the destination and source regions overlap, an internal temporary copy is allocated for reading the data.
         \param[in] srcRegionOffset Specifies the offset within the source image. This will be clamped if it exceeds the source image area.
         \param[in] srcRegionExtent Specifies the extent of the region to copy. This will be clamped if it exceeds the source or destination image area.
+        \param[in] threadCount Specifies the number of threads to use for copying. The region is split into bands of rows (or depth slices) that are copied in parallel.
+        If this is less than 2, the region is copied on the calling thread. If this is Constants::maxThreadCount, all available hardware threads are used. By default 0.
         \remarks If one of the region offsets is clamped, the region extent will be adjusted respectively.
         If the source image has a different format or data type compared to this image, the function has no effect.
+        \remarks Large regions are written with non-temporal stores (where supported) to avoid evicting the cache.
         \see ConvertImageBuffer
         */
-        void Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent);
+        void Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount = 0);
+
+        /**
+        \brief Copies a region of the specified source image view into this image.
+        \param[in] srcView Specifies the source image view, e.g. to external or memory-mapped image data. This must have the same format and data type as this image.
+        If the source view refers to the image buffer of this image and the destination and source regions overlap, an internal temporary copy of the source region is allocated for reading the data.
+        \remarks See Blit(Offset3D, const Image&, Offset3D, Extent3D, std::size_t) for the remaining parameters.
+        \see BlitImageView
+        */
+        void Blit(Offset3D dstRegionOffset, const ImageView& srcView, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount = 0);
 
         /**
         \brief Fills a region of this image by the specified color.
@@ -161,7 +259,7 @@ class LLGL_EXPORT Image
         \param[in] extent Specifies the region extent within this image to read from.
         \param[in] imageDesc Specifies the destination image descriptor to write the region to.
         If the 'data' member of this descriptor is null or if the sub-image region is not inside the image, this function has no effect.
-        \param[in] threadCount Specifies the number of threads to use if the data needs to be converted (see ConvertImageBuffer for more details). By default 0.
+        \param[in] threadCount Specifies the number of threads to use for copying the region and, if the data needs to be converted, for the conversion (see ConvertImageBuffer for more details). By default 0.
         \remarks To read a single pixel, use the following code example:
         \code
         LLGL::ColorRGBAub ReadSinglePixelRGBAub(const LLGL::Image& image, const LLGL::Offset3D& position) {
@@ -184,32 +282,41 @@ class LLGL_EXPORT Image
         \param[in] extent Specifies the region extent within this image to write to.
         \param[in] imageDesc Specifies the source image descriptor to read the region from.
         If the 'data' member of this descriptor is null or if the sub-image region is not inside the image, this function has no effect.
-        \param[in] threadCount Specifies the number of threads to use if the data needs to be converted (see ConvertImageBuffer for more details). By default 0.
+        \param[in] threadCount Specifies the number of threads to use for copying the region and, if the data needs to be converted, for the conversion (see ConvertImageBuffer for more details). By default 0.
         \see IsRegionInside
         \see ConvertImageBuffer
         */
         void WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, std::size_t threadCount = 0);
 
         /**
-        \brief Mirrors the image at the YZ plane.
-        \todo Not implemented yet
+        \brief Mirrors the image at the YZ plane, i.e. reverses the pixels of each row.
+        \see MirrorImageView
         */
         void MirrorYZPlane();
 
         /**
-        \brief Mirrors the image at the XZ plane.
-        \todo Not implemented yet
+        \brief Mirrors the image at the XZ plane, i.e. reverses the rows of each depth slice.
+        \see MirrorImageView
         */
         void MirrorXZPlane();
 
         /**
-        \brief Mirrors the image at the XY plane.
-        \todo Not implemented yet
+        \brief Mirrors the image at the XY plane, i.e. reverses the depth slices.
+        \see MirrorImageView
         */
         void MirrorXYPlane();
 
         /* ----- Attributes ----- */
 
+        /**
+        \brief Returns a non-owning view of this image with read-only access to the image data.
+        \remarks The view is invalidated when the image buffer is reallocated, e.g. by Convert, Resize, or Reset.
+        */
+        ImageView GetView() const;
+
+        //! Returns a non-owning view of this image with read/write access to the image data (see GetView() const).
+        MutableImageView GetView();
+
         //! Returns a source image descriptor for this image with read-only access to the image data.
         SrcImageDescriptor QuerySrcDesc() const;
 
@@ -288,8 +395,6 @@ class LLGL_EXPORT Image
 
         std::size_t GetDataPtrOffset(const Offset3D& offset) const;
 
-        void ClampRegion(Offset3D& offset, Extent3D& extent) const;
-
         Extent3D    extent_;
         ImageFormat format_     = ImageFormat::RGBA;
         DataType    dataType_   = DataType::UInt8;
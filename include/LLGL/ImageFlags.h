@@ -62,6 +62,31 @@ enum class ImageFormat
     CompressedRGBA, //!< Generic compressed format with four color components: Red, Green, Blue, Alpha.
 };
 
+/**
+\brief Resampling filter enumeration for resizing images.
+\remarks When an image is minified, the filter kernel is widened by the scaling factor, so all source pixels contribute to the result.
+\see Image::Resize(const Extent3D&, const ImageResizeFilter, std::size_t, const ImageColorSpace)
+*/
+enum class ImageResizeFilter
+{
+    Nearest,        //!< Takes the nearest source pixel. This does not blend any pixels.
+    Box,            //!< Averages all source pixels that are covered by a destination pixel. This is well suited for generating MIP-maps.
+    Bilinear,       //!< Blends the source pixels with a triangle (or tent) filter.
+    Lanczos,        //!< Blends the source pixels with a 3-lobed Lanczos filter. This gives the sharpest result, but may overshoot at hard edges.
+};
+
+/**
+\brief Color space enumeration for the color components of an image.
+\remarks Filtering sRGB images in linear color space avoids darkened edges and MIP-maps.
+\see Image::Resize(const Extent3D&, const ImageResizeFilter, std::size_t, const ImageColorSpace)
+\see DecodeSRGBImageBuffer
+*/
+enum class ImageColorSpace
+{
+    Linear,         //!< The color components are stored linearly.
+    sRGB,           //!< The color components are stored in sRGB non-linear color space. The alpha component is always stored linearly.
+};
+
 
 /* ----- Structures ----- */
 
@@ -89,16 +114,29 @@ struct SrcImageDescriptor
     }
 
     //! Specifies the image format. By default ImageFormat::RGBA.
-    ImageFormat format      = ImageFormat::RGBA;
+    ImageFormat     format      = ImageFormat::RGBA;
 
     //! Specifies the image data type. This must be DataType::UInt8 for compressed images. By default DataType::UInt8.
-    DataType    dataType    = DataType::UInt8;
+    DataType        dataType    = DataType::UInt8;
 
     //! Pointer to the read-only image data.
-    const void* data        = nullptr;
+    const void*     data        = nullptr;
 
     //! Specifies the size (in bytes) of the image data. This is primarily used for compressed images and serves for robustness.
-    std::size_t dataSize    = 0;
+    std::size_t     dataSize    = 0;
+
+    /**
+    \brief Specifies the number of MIP-map levels the image data contains. By default 1.
+    \remarks If this is greater than 1, the image data contains an entire MIP-map chain, which is uploaded at once by RenderSystem::CreateTexture.
+    All MIP-map levels are tightly packed one after another, beginning with the first (and largest) MIP-map level,
+    and each MIP-map level contains all of its array layers (or cube faces) in the same layout as the first MIP-map level.
+    The 'dataSize' member must then specify the size of the entire MIP-map chain.
+    MIP-map levels beyond the number of MIP-map levels of the texture are ignored.
+    \note This is only used by RenderSystem::CreateTexture; RenderSystem::WriteTexture always writes a single MIP-map level.
+    \see Image::GenerateMipChain
+    \see TextureDescriptor::mipLevels
+    */
+    std::uint32_t   mipLevels   = 1;
 };
 
 /**
@@ -135,6 +173,49 @@ struct DstImageDescriptor
     std::size_t dataSize    = 0;
 };
 
+/**
+\brief Descriptor structure for the image data of a single MIP-map level and a range of array layers of a texture.
+\remarks This is used to initialize all MIP-map levels of a texture at once, e.g. with the images of a TextureContainer.
+\see RenderSystem::CreateTexture(const TextureDescriptor&, std::uint32_t, const TextureSubresourceImage*)
+*/
+struct TextureSubresourceImage
+{
+    //! MIP-map level of the image, where 0 is the base texture, and N > 0 is the N-th MIP-map level. By default 0.
+    std::uint32_t       mipLevel        = 0;
+
+    /**
+    \brief First array layer of the image. By default 0.
+    \remarks For cube textures, this is the first cube face (see TextureDescriptor::arrayLayers).
+    */
+    std::uint32_t       baseArrayLayer  = 0;
+
+    /**
+    \brief Number of array layers of the image. By default 1.
+    \remarks The array layers must be tightly packed within the image data.
+    */
+    std::uint32_t       numArrayLayers  = 1;
+
+    //! Source image data descriptor.
+    SrcImageDescriptor  image;
+};
+
+/**
+\brief Descriptor structure for the image data of a single region of a texture, i.e. a box within one MIP-map level and a range of array layers.
+\see RenderSystem::WriteTextureRegions
+*/
+struct SubTextureImage
+{
+    /**
+    \brief Specifies the MIP-map level, offset, and extent of the region.
+    \remarks The range of array layers is specified in the same way as for RenderSystem::WriteTexture,
+    i.e. by the Z components of 'offset' and 'extent' (or by the Y components for 1D-array textures).
+    */
+    SubTextureDescriptor    subTexture;
+
+    //! Source image data descriptor. Its "data" member must not be null.
+    SrcImageDescriptor      image;
+};
+
 
 /* ----- Functions ----- */
 
@@ -240,6 +321,74 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t                 threadCount = 0
 );
 
+/**
+\brief Decodes an 8-bit sRGB image into linear 32-bit floating-point values in the range [0, 1].
+\param[in] srcImageDesc Specifies the source image descriptor. Its data type must be DataType::UInt8.
+\param[out] dstImageDesc Specifies the destination image descriptor. Its data type must be DataType::Float32 and its format must be the same as the source format.
+\param[in] threadCount Specifies the number of threads to use for decoding (see ConvertImageBuffer). By default 0.
+\remarks The color components are decoded with a lookup table, and the alpha component is only normalized.
+This can be used to filter sRGB image data in linear color space or to upload it into a floating-point texture.
+\throw std::invalid_argument If the source or destination has an unexpected data type, or if the formats differ or are not uncompressed color formats.
+\throw std::invalid_argument If the destination buffer size is too small for the source image.
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see EncodeSRGBImageBuffer
+*/
+LLGL_EXPORT void DecodeSRGBImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Encodes linear 32-bit floating-point values into an 8-bit sRGB image.
+\param[in] srcImageDesc Specifies the source image descriptor. Its data type must be DataType::Float32.
+\param[out] dstImageDesc Specifies the destination image descriptor. Its data type must be DataType::UInt8 and its format must be the same as the source format.
+\param[in] threadCount Specifies the number of threads to use for encoding (see ConvertImageBuffer). By default 0.
+\remarks The source values are clamped to the range [0, 1]. The color components are encoded with a vectorized approximation of the sRGB curve,
+which may differ by one step from the exact conversion. The alpha component is only quantized.
+\throw std::invalid_argument If the source or destination has an unexpected data type, or if the formats differ or are not uncompressed color formats.
+\throw std::invalid_argument If the destination buffer size is too small for the source image.
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see DecodeSRGBImageBuffer
+*/
+LLGL_EXPORT void EncodeSRGBImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Returns true if the specified hardware format can be generated with CompressImageBuffer.
+\remarks The supported formats are Format::BC1RGB, Format::BC1RGBA, Format::BC2RGBA, Format::BC3RGBA, Format::BC4RUNorm, Format::BC5RGUNorm, Format::BC7RGBAUNorm,
+and the sRGB variants of these formats.
+\see CompressImageBuffer
+*/
+LLGL_EXPORT bool IsImageCompressionSupported(const Format format);
+
+/**
+\brief Compresses the source image into the specified block-compressed hardware format and returns the new generated image buffer.
+\param[in] srcImageDesc Specifies the source image descriptor. This must be an uncompressed color image. It is converted into ImageFormat::RGBA and DataType::UInt8 beforehand if necessary.
+\param[in] extent Specifies the extent (in pixels) of the source image. Each depth slice (or array layer) is compressed separately.
+\param[in] dstFormat Specifies the destination hardware format (see IsImageCompressionSupported).
+\param[in] threadCount Specifies the number of threads to use for compression (see ConvertImageBuffer). By default 0.
+\return Byte buffer with the compressed blocks of all depth slices, which can be passed directly to RenderSystem::CreateTexture with a texture of the same format.
+Its size is determined by TextureBufferSize(dstFormat, extent). If the extent is empty, the return value is null.
+\remarks Blocks that exceed the image extent are padded by replicating the edge pixels.
+The endpoints of each block are fitted to the principal axis of its pixels and refined once with a least-squares fit.
+BC7 blocks are only encoded with mode 6 (a single subset with 4-bit indices), which gives better quality than BC3 for most images in a fraction of the time of an exhaustive search.
+For the sRGB formats, the source image is expected to be in sRGB color space already.
+\throw std::invalid_argument If the destination format is not supported.
+\throw std::invalid_argument If the source image has a compressed or depth-stencil format, or its buffer is too small for the specified extent.
+\throw std::invalid_argument If the source buffer is a null pointer.
+\see TextureBufferSize(const Format, const Extent3D&)
+*/
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const Format                dstFormat,
+    std::size_t                 threadCount = 0
+);
+
 /**
 \brief Generates an image buffer with the specified fill data for each pixel.
 \param[in] format Specifies the image format of each pixel in the output image.
@@ -0,0 +1,273 @@
+/*
+ * ImageView.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_VIEW_H
+#define LLGL_IMAGE_VIEW_H
+
+
+#include "Export.h"
+#include "Types.h"
+#include "ImageFlags.h"
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Non-owning read-only view of a 1D, 2D, or 3D image in CPU memory.
+\remarks An image view does not take the ownership of the image data. It can refer to external image data (e.g. a decoded video frame or a memory-mapped file)
+or to a region of another image, in which case the row and depth strides are larger than the extent of the view.
+This can be used to process image data in place with BlitImageView, ConvertImageBuffer, ResizeImageView, or Image::Blit without copying it into an Image first.
+\see MutableImageView
+\see Image::GetView
+*/
+struct ImageView
+{
+    ImageView() = default;
+    ImageView(const ImageView&) = default;
+
+    /**
+    \brief Constructor to initialize all attributes.
+    \param[in] format Specifies the image format.
+    \param[in] dataType Specifies the data type of each pixel component.
+    \param[in] data Pointer to the first pixel of the view.
+    \param[in] extent Specifies the extent (in pixels) of the view.
+    \param[in] rowStride Specifies the stride (in bytes) between two rows. If this is zero, the rows are tightly packed. By default 0.
+    \param[in] depthStride Specifies the stride (in bytes) between two depth slices. If this is zero, the slices are tightly packed. By default 0.
+    */
+    inline ImageView(
+        ImageFormat     format,
+        DataType        dataType,
+        const void*     data,
+        const Extent3D& extent,
+        std::uint32_t   rowStride   = 0,
+        std::uint32_t   depthStride = 0) :
+            format      { format      },
+            dataType    { dataType    },
+            data        { data        },
+            extent      { extent      },
+            rowStride   { rowStride   },
+            depthStride { depthStride }
+    {
+    }
+
+    //! Returns the size (in bytes) of each pixel.
+    inline std::uint32_t GetBytesPerPixel() const
+    {
+        return (ImageFormatSize(format) * DataTypeSize(dataType));
+    }
+
+    //! Returns the stride (in bytes) between two rows. If the 'rowStride' member is zero, this is the size of a tightly packed row.
+    inline std::uint32_t GetRowStride() const
+    {
+        return (rowStride > 0 ? rowStride : GetBytesPerPixel() * extent.width);
+    }
+
+    //! Returns the stride (in bytes) between two depth slices. If the 'depthStride' member is zero, this is the size of tightly packed rows.
+    inline std::uint32_t GetDepthStride() const
+    {
+        return (depthStride > 0 ? depthStride : GetRowStride() * extent.height);
+    }
+
+    //! Returns true if all pixels of this view are tightly packed, i.e. the view refers to a contiguous memory range.
+    inline bool IsTightlyPacked() const
+    {
+        return (GetRowStride() == GetBytesPerPixel() * extent.width && GetDepthStride() == GetRowStride() * extent.height);
+    }
+
+    //! Specifies the image format. By default ImageFormat::RGBA.
+    ImageFormat     format      = ImageFormat::RGBA;
+
+    //! Specifies the data type of each pixel component. By default DataType::UInt8.
+    DataType        dataType    = DataType::UInt8;
+
+    //! Pointer to the first pixel of the read-only image data.
+    const void*     data        = nullptr;
+
+    //! Specifies the extent (in pixels) of the view.
+    Extent3D        extent;
+
+    //! Specifies the stride (in bytes) between two rows. If this is zero, the rows are tightly packed. By default 0.
+    std::uint32_t   rowStride   = 0;
+
+    //! Specifies the stride (in bytes) between two depth slices. If this is zero, the slices are tightly packed. By default 0.
+    std::uint32_t   depthStride = 0;
+};
+
+/**
+\brief Non-owning read/write view of a 1D, 2D, or 3D image in CPU memory.
+\remarks This is the mutable counterpart of ImageView and can be implicitly converted to ImageView.
+\see ImageView
+*/
+struct MutableImageView
+{
+    MutableImageView() = default;
+    MutableImageView(const MutableImageView&) = default;
+
+    //! Constructor to initialize all attributes (see ImageView::ImageView).
+    inline MutableImageView(
+        ImageFormat     format,
+        DataType        dataType,
+        void*           data,
+        const Extent3D& extent,
+        std::uint32_t   rowStride   = 0,
+        std::uint32_t   depthStride = 0) :
+            format      { format      },
+            dataType    { dataType    },
+            data        { data        },
+            extent      { extent      },
+            rowStride   { rowStride   },
+            depthStride { depthStride }
+    {
+    }
+
+    //! Returns a read-only view of the same image data.
+    inline operator ImageView () const
+    {
+        return ImageView{ format, dataType, data, extent, rowStride, depthStride };
+    }
+
+    //! Returns the size (in bytes) of each pixel.
+    inline std::uint32_t GetBytesPerPixel() const
+    {
+        return ImageView{ *this }.GetBytesPerPixel();
+    }
+
+    //! Returns the stride (in bytes) between two rows (see ImageView::GetRowStride).
+    inline std::uint32_t GetRowStride() const
+    {
+        return ImageView{ *this }.GetRowStride();
+    }
+
+    //! Returns the stride (in bytes) between two depth slices (see ImageView::GetDepthStride).
+    inline std::uint32_t GetDepthStride() const
+    {
+        return ImageView{ *this }.GetDepthStride();
+    }
+
+    //! Specifies the image format. By default ImageFormat::RGBA.
+    ImageFormat     format      = ImageFormat::RGBA;
+
+    //! Specifies the data type of each pixel component. By default DataType::UInt8.
+    DataType        dataType    = DataType::UInt8;
+
+    //! Pointer to the first pixel of the read/write image data.
+    void*           data        = nullptr;
+
+    //! Specifies the extent (in pixels) of the view.
+    Extent3D        extent;
+
+    //! Specifies the stride (in bytes) between two rows. If this is zero, the rows are tightly packed. By default 0.
+    std::uint32_t   rowStride   = 0;
+
+    //! Specifies the stride (in bytes) between two depth slices. If this is zero, the slices are tightly packed. By default 0.
+    std::uint32_t   depthStride = 0;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\defgroup group_imageview Image view functions to process external image data in place.
+\addtogroup group_imageview
+@{
+*/
+
+/**
+\brief Returns a view of a sub-region of the specified image view, which shares the row and depth strides of the specified view.
+\remarks The region is not clamped to the extent of the specified view.
+*/
+LLGL_EXPORT ImageView GetSubImageView(const ImageView& imageView, const Offset3D& offset, const Extent3D& extent);
+
+//! Returns a mutable view of a sub-region of the specified mutable image view (see GetSubImageView(const ImageView&, const Offset3D&, const Extent3D&)).
+LLGL_EXPORT MutableImageView GetSubImageView(const MutableImageView& imageView, const Offset3D& offset, const Extent3D& extent);
+
+/**
+\brief Copies a region of the source view into the destination view.
+\param[in] dstView Specifies the destination image view.
+\param[in] dstRegionOffset Specifies the offset within the destination view. This can also be outside of the view.
+\param[in] srcView Specifies the source image view. This must have the same format and data type as the destination view.
+\param[in] srcRegionOffset Specifies the offset within the source view. This will be clamped if it exceeds the source view.
+\param[in] srcRegionExtent Specifies the extent of the region to copy. This will be clamped if it exceeds the source or destination view.
+\param[in] threadCount Specifies the number of threads to use for copying (see Image::Blit). By default 0.
+\return True if the region has been copied. Otherwise, the views have different formats or data types, or the clamped region is empty.
+\note If both views refer to overlapping memory, the behavior is undefined. Use Image::Blit to copy overlapping regions within the same image.
+\see Image::Blit
+*/
+LLGL_EXPORT bool BlitImageView(
+    const MutableImageView& dstView,
+    Offset3D                dstRegionOffset,
+    const ImageView&        srcView,
+    Offset3D                srcRegionOffset,
+    Extent3D                srcRegionExtent,
+    std::size_t             threadCount = 0
+);
+
+/**
+\brief Converts the image format and data type of the source view into the destination view (only uncompressed color formats).
+\param[in] srcView Specifies the source image view.
+\param[in] dstView Specifies the destination image view. This must have the same extent as the source view.
+\param[in] threadCount Specifies the number of threads to use for conversion (see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t)). By default 0.
+\return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination view is not modified! Use BlitImageView to copy views of the same format and data type.
+\remarks Tightly packed views are converted at once. Otherwise, the views are converted row by row.
+\throw std::invalid_argument If the source and destination views have different extents.
+\throw std::invalid_argument If a compressed or depth-stencil format is specified either as source or destination.
+\throw std::invalid_argument If the source or destination data is a null pointer.
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const ImageView&        srcView,
+    const MutableImageView& dstView,
+    std::size_t             threadCount = 0
+);
+
+/**
+\brief Resamples the source view into the destination view.
+\param[in] srcView Specifies the source image view.
+\param[in] dstView Specifies the destination image view. This must have the same format and data type as the source view. Its extent determines the new image size.
+\param[in] filter Specifies the resampling filter. Each dimension is resampled separately.
+\param[in] threadCount Specifies the number of threads to use for resampling (see Image::Resize). By default 0.
+\param[in] colorSpace Specifies the color space of the color components. If this is ImageColorSpace::sRGB, the color components are decoded into linear color space before they are filtered,
+and encoded back into sRGB color space afterwards. By default ImageColorSpace::Linear.
+\throw std::invalid_argument If the views have different formats or data types, or a compressed or depth-stencil format.
+\throw std::invalid_argument If 'colorSpace' is ImageColorSpace::sRGB and the data type is not DataType::UInt8.
+\see Image::Resize(const Extent3D&, const ImageResizeFilter, std::size_t, const ImageColorSpace)
+*/
+LLGL_EXPORT void ResizeImageView(
+    const ImageView&        srcView,
+    const MutableImageView& dstView,
+    const ImageResizeFilter filter,
+    std::size_t             threadCount = 0,
+    const ImageColorSpace   colorSpace  = ImageColorSpace::Linear
+);
+
+/**
+\brief Mirrors the image view in place.
+\param[in] imageView Specifies the image view to mirror.
+\param[in] mirrorX Specifies whether to mirror at the YZ plane, i.e. reverse the pixels of each row.
+\param[in] mirrorY Specifies whether to mirror at the XZ plane, i.e. reverse the rows of each depth slice.
+\param[in] mirrorZ Specifies whether to mirror at the XY plane, i.e. reverse the depth slices.
+\remarks The pixels are swapped pairwise, so no temporary image buffer is allocated.
+\see Image::MirrorYZPlane
+*/
+LLGL_EXPORT void MirrorImageView(const MutableImageView& imageView, bool mirrorX, bool mirrorY, bool mirrorZ);
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,71 @@
+/*
+ * IndirectCommandLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_INDIRECT_COMMAND_LAYOUT_H
+#define LLGL_INDIRECT_COMMAND_LAYOUT_H
+
+
+#include "RenderSystemChild.h"
+#include "IndirectCommandLayoutFlags.h"
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Indirect command layout interface, i.e. the layout of the commands in an argument buffer for CommandBuffer::ExecuteIndirect.
+\see RenderSystem::CreateIndirectCommandLayout
+\see CommandBuffer::ExecuteIndirect
+*/
+class LLGL_EXPORT IndirectCommandLayout : public RenderSystemChild
+{
+
+    public:
+
+        //! Returns the stride (in bytes) between two commands in the argument buffer.
+        inline std::uint32_t GetStride() const
+        {
+            return stride_;
+        }
+
+        //! Returns the type of the draw argument, i.e. either IndirectArgumentType::Draw or IndirectArgumentType::DrawIndexed.
+        inline IndirectArgumentType GetDrawType() const
+        {
+            return drawType_;
+        }
+
+        //! Returns the offset (in bytes) of the draw argument within each command.
+        inline std::uint32_t GetDrawOffset() const
+        {
+            return drawOffset_;
+        }
+
+        //! Returns the size (in bytes) of the specified argument within a command.
+        static std::uint32_t GetArgumentSize(const IndirectArgumentDescriptor& argumentDesc);
+
+    protected:
+
+        IndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc);
+
+    private:
+
+        std::uint32_t           stride_     = 0;
+        IndirectArgumentType    drawType_   = IndirectArgumentType::DrawIndexed;
+        std::uint32_t           drawOffset_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
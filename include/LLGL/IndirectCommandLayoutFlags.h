@@ -0,0 +1,125 @@
+/*
+ * IndirectCommandLayoutFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_INDIRECT_COMMAND_LAYOUT_FLAGS_H
+#define LLGL_INDIRECT_COMMAND_LAYOUT_FLAGS_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class PipelineLayout;
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Indirect argument type enumeration.
+\see IndirectArgumentDescriptor::type
+*/
+enum class IndirectArgumentType
+{
+    //! Draw command with a DrawIndirectArguments structure. This must be the last argument of a layout.
+    Draw,
+
+    //! Indexed draw command with a DrawIndexedIndirectArguments structure. This must be the last argument of a layout.
+    DrawIndexed,
+
+    //! Vertex buffer binding with a VertexBufferIndirectArguments structure.
+    VertexBuffer,
+
+    //! 32-bit constants that are written into the constants of the pipeline layout (see PipelineLayoutDescriptor::constants).
+    Constants,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Argument structure of an indirect vertex buffer binding.
+\remarks This structure has the same memory layout as \c D3D12_VERTEX_BUFFER_VIEW.
+\see IndirectArgumentType::VertexBuffer
+\see Buffer::GetDeviceAddress
+*/
+struct VertexBufferIndirectArguments
+{
+    //! GPU virtual address of the vertex buffer, i.e. the device address of the buffer plus an offset.
+    std::uint64_t   address;
+
+    //! Size (in bytes) of the vertex buffer range.
+    std::uint32_t   size;
+
+    //! Stride (in bytes) between two vertices.
+    std::uint32_t   stride;
+};
+
+/**
+\brief Indirect argument descriptor structure.
+\see IndirectCommandLayoutDescriptor::arguments
+*/
+struct IndirectArgumentDescriptor
+{
+    IndirectArgumentDescriptor() = default;
+
+    inline IndirectArgumentDescriptor(IndirectArgumentType type, std::uint32_t slot = 0, std::uint32_t numValues = 0) :
+        type      { type      },
+        slot      { slot      },
+        numValues { numValues }
+    {
+    }
+
+    //! Specifies the argument type. By default IndirectArgumentType::DrawIndexed.
+    IndirectArgumentType    type        = IndirectArgumentType::DrawIndexed;
+
+    /**
+    \brief Specifies the binding slot for vertex buffer arguments, or the first 32-bit value within the constants for constant arguments. By default 0.
+    \remarks This is ignored for draw arguments.
+    */
+    std::uint32_t           slot        = 0;
+
+    //! Specifies the number of 32-bit values for constant arguments. This is ignored for all other argument types. By default 0.
+    std::uint32_t           numValues   = 0;
+};
+
+/**
+\brief Indirect command layout descriptor structure.
+\remarks Each command in the argument buffer consists of all arguments in the order they are specified, tightly packed, followed by the padding up to the stride.
+\see RenderSystem::CreateIndirectCommandLayout
+*/
+struct IndirectCommandLayoutDescriptor
+{
+    /**
+    \brief Specifies the pipeline layout whose constants are changed by the commands. By default null.
+    \remarks This must be non-null if any argument has the type IndirectArgumentType::Constants,
+    and it must be the same pipeline layout as the one of the graphics pipeline that is bound when the commands are executed.
+    */
+    PipelineLayout*                         pipelineLayout  = nullptr;
+
+    //! Specifies the arguments of each command. Exactly one of them must be a draw argument, which must be the last one.
+    std::vector<IndirectArgumentDescriptor> arguments;
+
+    /**
+    \brief Specifies the stride (in bytes) between two commands in the argument buffer. By default 0.
+    \remarks If this is zero, the stride is the sum of all argument sizes. Otherwise, it must be a multiple of 4 and at least that sum.
+    */
+    std::uint32_t                           stride          = 0;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -19,6 +19,8 @@ namespace LLGL
 {
 
 
+class InputEventQueue;
+
 /**
 \brief Default window event listener to receive user input.
 \remarks This class stores all received user input for a simple evaluation.
@@ -91,6 +93,15 @@ class LLGL_EXPORT Input : public Window::EventListener
             return anyKeyCount_;
         }
 
+        /**
+        \brief Updates the input states with all events from the specified queue, as if they had been received in a call to Window::ProcessEvents.
+        \remarks Use this instead of adding this Input instance as event listener to a window,
+        if the window events are processed on another thread than the one that reads the input states.
+        \note This must only be called by the consumer thread of the queue.
+        \see InputEventQueue
+        */
+        void ProcessEventQueue(InputEventQueue& queue);
+
     protected:
 
         void OnProcessEvents(Window& sender) override;
@@ -124,6 +135,7 @@ class LLGL_EXPORT Input : public Window::EventListener
         };
 
         void InitArray(KeyStateArray& keyStates);
+        void ResetFrameStates();
 
         KeyStateArray       keyPressed_;
         KeyStateArray       keyDown_;
@@ -0,0 +1,173 @@
+/*
+ * InputEventQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_INPUT_EVENT_QUEUE_H
+#define LLGL_INPUT_EVENT_QUEUE_H
+
+
+#include "Export.h"
+#include "Window.h"
+#include "Key.h"
+#include "Types.h"
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+//! Input event type enumeration.
+enum class InputEventType
+{
+    KeyDown,        //!< Key has been pushed. Uses InputEvent::keyCode.
+    KeyUp,          //!< Key has been released. Uses InputEvent::keyCode.
+    DoubleClick,    //!< Mouse button has been double clicked. Uses InputEvent::keyCode.
+    Char,           //!< Character has been typed. Uses InputEvent::chr.
+    WheelMotion,    //!< Mouse wheel has been moved. Uses InputEvent::wheelMotion.
+    LocalMotion,    //!< Mouse has been moved on the window. Uses InputEvent::offset for the new local position.
+    GlobalMotion,   //!< Global mouse position has changed. Uses InputEvent::offset for the motion.
+    Resize,         //!< Window has been resized. Uses InputEvent::size.
+    GetFocus,       //!< Window got the keyboard focus.
+    LoseFocus,      //!< Window lost the keyboard focus.
+};
+
+/**
+\brief Window event with a timestamp as it is stored in an InputEventQueue.
+\see InputEventQueue
+*/
+struct InputEvent
+{
+    //! Specifies the type of this event.
+    InputEventType  type        = InputEventType::KeyDown;
+
+    //! Timestamp when this event has been received by the queue (see Timer::Tick).
+    std::uint64_t   timestamp   = 0;
+
+    //! Window that sent this event.
+    Window*         sender      = nullptr;
+
+    //! Key code for the KeyDown, KeyUp, and DoubleClick events.
+    Key             keyCode     = Key::Any;
+
+    //! Character for the Char event.
+    wchar_t         chr         = 0;
+
+    //! Wheel motion for the WheelMotion event.
+    int             wheelMotion = 0;
+
+    //! Mouse position for the LocalMotion event and mouse motion for the GlobalMotion event.
+    Offset2D        offset;
+
+    //! Client area size for the Resize event.
+    Extent2D        size;
+};
+
+/**
+\brief Window event listener that publishes all user input into a lock-free single-producer/single-consumer queue of timestamped events.
+\remarks This decouples input sampling from rendering: the thread that calls Window::ProcessEvents is the only producer,
+and a simulation thread is the only consumer, which reads the events with Pop or forwards them to an Input instance with Input::ProcessEventQueue.
+Neither thread ever waits for the other one. If the queue is full, new events are dropped (see GetNumDroppedEvents). Example:
+\code
+// Event thread (the thread that created the window):
+auto inputQueue = std::make_shared<LLGL::InputEventQueue>();
+myWindow->AddEventListener(inputQueue);
+while (myWindow->ProcessEvents()) {
+    // Wait for more events ...
+}
+
+// Simulation thread:
+LLGL::Input myInput;
+while (running) {
+    myInput.ProcessEventQueue(*inputQueue);
+    if (myInput.KeyDown(LLGL::Key::Escape))
+        break;
+    // Simulation goes here ...
+}
+\endcode
+\note Most windowing systems require that the window events are processed on the same thread that created the window.
+On Linux, XInitThreads must be called before any other Xlib function, if the window is also accessed from other threads (e.g. by the render context).
+\see Input::ProcessEventQueue
+*/
+class LLGL_EXPORT InputEventQueue : public Window::EventListener
+{
+
+    public:
+
+        /**
+        \brief Constructs the event queue with the specified capacity.
+        \param[in] capacity Specifies the maximum number of events the queue can hold. This is rounded up to the next power of two.
+        By default 1024.
+        */
+        InputEventQueue(std::size_t capacity = 1024);
+
+        /**
+        \brief Pops the oldest event from the queue.
+        \param[out] event Specifies the output event.
+        \return True if an event has been popped, or false if the queue is empty.
+        \note This must only be called by the consumer thread.
+        */
+        bool Pop(InputEvent& event);
+
+        //! Returns the maximum number of events the queue can hold.
+        inline std::size_t GetCapacity() const
+        {
+            return events_.size();
+        }
+
+        //! Returns the number of events that have been dropped so far, because the queue was full.
+        inline std::uint64_t GetNumDroppedEvents() const
+        {
+            return numDroppedEvents_.load(std::memory_order_relaxed);
+        }
+
+    protected:
+
+        void OnKeyDown(Window& sender, Key keyCode) override;
+        void OnKeyUp(Window& sender, Key keyCode) override;
+
+        void OnDoubleClick(Window& sender, Key keyCode) override;
+
+        void OnChar(Window& sender, wchar_t chr) override;
+
+        void OnWheelMotion(Window& sender, int motion) override;
+
+        void OnLocalMotion(Window& sender, const Offset2D& position) override;
+        void OnGlobalMotion(Window& sender, const Offset2D& motion) override;
+
+        void OnResize(Window& sender, const Extent2D& clientAreaSize) override;
+
+        void OnGetFocus(Window& sender) override;
+        void OnLoseFocus(Window& sender) override;
+
+    private:
+
+        InputEvent* BeginPush(Window& sender, InputEventType type);
+        void EndPush();
+
+    private:
+
+        std::vector<InputEvent>     events_;
+        std::size_t                 mask_               = 0;
+
+        std::atomic<std::size_t>    writeIndex_;        // Only modified by the producer thread
+        std::atomic<std::size_t>    readIndex_;         // Only modified by the consumer thread
+        std::atomic<std::uint64_t>  numDroppedEvents_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
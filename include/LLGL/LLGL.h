@@ -14,7 +14,9 @@
 #include "Canvas.h"
 #include "Display.h"
 #include "Input.h"
+#include "InputEventQueue.h"
 #include "Timer.h"
+#include "FrameTimer.h"
 #include "ColorRGB.h"
 #include "ColorRGBA.h"
 #include "RenderSystem.h"
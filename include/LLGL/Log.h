@@ -11,6 +11,33 @@
 
 #include "Export.h"
 #include <ostream>
+#include <string>
+
+
+/**
+\brief Minimal severity of messages that are compiled in with the LLGL_LOG macro. By default 0, i.e. all messages are compiled in.
+\remarks Define this macro before including this header (e.g. with a compiler option) to strip messages of lower severity at compile time.
+For example, a value of 2 strips all messages with Log::Severity::Debug and Log::Severity::Info.
+*/
+#ifndef LLGL_LOG_MIN_SEVERITY
+#define LLGL_LOG_MIN_SEVERITY 0
+#endif
+
+/**
+\brief Posts a message with the specified severity (Debug, Info, Warning, or Error) to the log.
+\remarks The message expression is not evaluated if the severity is below LLGL_LOG_MIN_SEVERITY.
+\code
+LLGL_LOG(Warning, "texture " + name + " has no MIP-maps");
+\endcode
+\see LLGL::Log::Post
+*/
+#define LLGL_LOG(SEVERITY, MESSAGE)                                                                     \
+    do                                                                                                  \
+    {                                                                                                   \
+        if (static_cast<int>(LLGL::Log::Severity::SEVERITY) >= LLGL_LOG_MIN_SEVERITY)                   \
+            LLGL::Log::Post(LLGL::Log::Severity::SEVERITY, MESSAGE);                                    \
+    }                                                                                                   \
+    while (false)
 
 
 namespace LLGL
@@ -20,6 +47,16 @@ namespace Log
 {
 
 
+//! Log message severity enumeration.
+enum class Severity
+{
+    Debug   = 0,    //!< Debug message. Written to the standard output stream.
+    Info    = 1,    //!< Informational message. Written to the standard output stream.
+    Warning = 2,    //!< Warning message. Written to the standard output stream for error and warning messages.
+    Error   = 3,    //!< Error message. Written to the standard output stream for error and warning messages.
+};
+
+
 //! Sets the standard output stream. By default std::cout.
 LLGL_EXPORT void SetStdOut(std::ostream& stream);
 
@@ -32,6 +69,44 @@ LLGL_EXPORT std::ostream& StdOut();
 //! Returns the standard output stream for error and warning messages.
 LLGL_EXPORT std::ostream& StdErr();
 
+/**
+\brief Posts a message with the specified severity to the log.
+\param[in] severity Specifies the severity of the message. Messages with a severity below the one specified by SetMinSeverity are discarded.
+\param[in] message Specifies the message text. A new-line character is appended when the message is written.
+\remarks If asynchronous logging is disabled (which is the default), the message is written immediately to StdOut or StdErr.
+Otherwise, the message is moved into a lock-free ring buffer and written by a background thread, so the calling thread never waits for console or file I/O.
+If the ring buffer is full, the message is dropped and the number of dropped messages is reported with the next written message.
+This function is thread-safe.
+\see EnableAsync
+\see LLGL_LOG
+*/
+LLGL_EXPORT void Post(Severity severity, std::string message);
+
+/**
+\brief Sets the minimal severity of messages that are posted to the log. By default Severity::Debug.
+\remarks To strip messages at compile time, use the LLGL_LOG_MIN_SEVERITY macro.
+*/
+LLGL_EXPORT void SetMinSeverity(Severity severity);
+
+//! Returns the minimal severity of messages that are posted to the log.
+LLGL_EXPORT Severity GetMinSeverity();
+
+/**
+\brief Enables or disables asynchronous logging. By default disabled.
+\remarks When asynchronous logging is enabled, a background thread is started that writes all posted messages.
+When it is disabled, all pending messages are written before the background thread is stopped.
+The output streams must not be changed by SetStdOut or SetStdErr while asynchronous logging is enabled.
+This must not be called from multiple threads simultaneously.
+\see Post
+*/
+LLGL_EXPORT void EnableAsync(bool enable);
+
+/**
+\brief Blocks until all messages that have been posted before this call have been written.
+\remarks This has no effect if asynchronous logging is disabled.
+*/
+LLGL_EXPORT void Flush();
+
 
 } // /namespace Log
 
@@ -0,0 +1,130 @@
+/*
+ * MeshUtility.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MESH_UTILITY_H
+#define LLGL_MESH_UTILITY_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include "IndexFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\defgroup group_mesh_util Global utility functions to preprocess triangle meshes before they are uploaded into vertex and index buffers.
+\addtogroup group_mesh_util
+@{
+*/
+
+/* ----- Vertex cache optimization ----- */
+
+/**
+\brief Reorders the triangles of the specified triangle list to improve the hit rate of the post-transform vertex cache.
+\param[in,out] indices Pointer to the triangle list of \c numIndices indices. The number of indices must be a multiple of 3.
+\param[in] numIndices Specifies the number of indices.
+\param[in] numVertices Specifies the number of vertices. All indices must be less than this value.
+\remarks This implements the "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth with a simulated LRU cache of 32 entries,
+which performs well on a wide range of GPUs without knowing the exact cache size.
+\see OptimizeOverdraw
+*/
+LLGL_EXPORT void OptimizeVertexCache(std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices);
+
+//! \see OptimizeVertexCache(std::uint32_t*, std::size_t, std::size_t)
+LLGL_EXPORT void OptimizeVertexCache(std::uint16_t* indices, std::size_t numIndices, std::size_t numVertices);
+
+/* ----- Overdraw optimization ----- */
+
+/**
+\brief Reorders clusters of triangles of the specified triangle list to reduce overdraw, while keeping most of the vertex cache efficiency.
+\param[in,out] indices Pointer to the triangle list of \c numIndices indices. This should already be optimized with OptimizeVertexCache.
+\param[in] numIndices Specifies the number of indices. This must be a multiple of 3.
+\param[in] positions Pointer to the first vertex position. Each position consists of 3 floats (X, Y, Z).
+\param[in] numVertices Specifies the number of vertices. All indices must be less than this value.
+\param[in] positionStride Specifies the distance (in bytes) between two consecutive vertex positions, i.e. the vertex stride.
+\param[in] threshold Specifies how much the vertex cache efficiency may degrade. A value of 1.05 allows the average cache miss ratio to grow by 5%.
+Values less than 1 are clamped to 1, in which case only the boundaries where the vertex cache is flushed anyway are used to split the triangle list into clusters.
+\remarks This follows the cluster sorting of "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander et al., 2007):
+The triangle list is split into clusters that can be reordered without exceeding the cache miss threshold,
+and the clusters are sorted such that outward facing clusters are drawn first, which increases the efficiency of early depth tests.
+*/
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint32_t*  indices,
+    std::size_t     numIndices,
+    const float*    positions,
+    std::size_t     numVertices,
+    std::size_t     positionStride,
+    float           threshold       = 1.05f
+);
+
+//! \see OptimizeOverdraw(std::uint32_t*, std::size_t, const float*, std::size_t, std::size_t, float)
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint16_t*  indices,
+    std::size_t     numIndices,
+    const float*    positions,
+    std::size_t     numVertices,
+    std::size_t     positionStride,
+    float           threshold       = 1.05f
+);
+
+/* ----- Vertex fetch optimization ----- */
+
+/**
+\brief Reorders the specified vertices in the order they are first referenced by the index list, and remaps the indices accordingly.
+\param[in,out] vertices Pointer to the vertex array of \c numVertices vertices.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] vertexStride Specifies the size (in bytes) of each vertex.
+\param[in,out] indices Pointer to the index list of \c numIndices indices. All indices must be less than \c numVertices.
+\param[in] numIndices Specifies the number of indices.
+\return Number of vertices that are referenced by the index list. Unreferenced vertices are moved to the end of the vertex array
+and this value can be used as the new number of vertices when the vertex buffer is created.
+\remarks This improves the locality of vertex fetches and should be called after OptimizeVertexCache and OptimizeOverdraw.
+*/
+LLGL_EXPORT std::size_t OptimizeVertexFetch(void* vertices, std::size_t numVertices, std::size_t vertexStride, std::uint32_t* indices, std::size_t numIndices);
+
+//! \see OptimizeVertexFetch(void*, std::size_t, std::size_t, std::uint32_t*, std::size_t)
+LLGL_EXPORT std::size_t OptimizeVertexFetch(void* vertices, std::size_t numVertices, std::size_t vertexStride, std::uint16_t* indices, std::size_t numIndices);
+
+/* ----- Index compaction ----- */
+
+/**
+\brief Compacts the specified 32-bit indices into 16-bit indices in-place if all indices are small enough.
+\param[in,out] indices Pointer to the index list of \c numIndices indices.
+If all indices are less than 0xFFFF, the first half of this array is overwritten with the 16-bit indices.
+\param[in] numIndices Specifies the number of indices.
+\return Index format of the resulting index list, i.e. either DataType::UInt16 or DataType::UInt32.
+This can be passed to BufferDescriptor::IndexBuffer::format. The size of the index buffer is \c numIndices times IndexFormat::GetFormatSize bytes.
+\remarks The index 0xFFFF is never used in the compacted list, because it is reserved for primitive restart.
+*/
+LLGL_EXPORT IndexFormat CompactIndices(std::uint32_t* indices, std::size_t numIndices);
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#else
+
+#error LLGL was not compiled with LLGL_ENABLE_UTILITY option
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
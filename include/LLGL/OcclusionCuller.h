@@ -0,0 +1,166 @@
+/*
+ * OcclusionCuller.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_OCCLUSION_CULLER_H
+#define LLGL_OCCLUSION_CULLER_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "QueryFlags.h"
+#include "CommandBufferFlags.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class CommandBuffer;
+class QueryHeap;
+class Buffer;
+
+/**
+\brief Occlusion culler descriptor structure.
+\see OcclusionCuller::OcclusionCuller
+*/
+struct OcclusionCullerDescriptor
+{
+    //! Specifies the number of objects that can be tested within one frame. This must be greater than zero. By default 1.
+    std::uint32_t       numObjects      = 1;
+
+    /**
+    \brief Specifies whether the occlusion tests may be conservative. By default false.
+    \remarks If true, the query heap is created with QueryType::AnySamplesPassedConservative,
+    which allows the renderer to report an object as visible even if none of its samples passed the depth test.
+    */
+    bool                conservative    = false;
+
+    /**
+    \brief Specifies the mode of the render conditions for the conditional draw commands. By default RenderConditionMode::NoWait.
+    \remarks With a non-waiting mode, the GPU never stalls on a pending occlusion test but draws the object as if it were visible.
+    */
+    RenderConditionMode mode            = RenderConditionMode::NoWait;
+};
+
+/**
+\brief Batched occlusion culling layer above the command buffer.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to test the bounding volumes of many objects and to discard the draw commands of all occluded objects on the GPU,
+without a separate Query object per object and without waiting for any query result on the CPU.
+All occlusion tests are stored in a single query heap, and the draw commands of each object are issued within a render condition of its test.
+\remarks The tests are hierarchical if the test of an object is issued while the render condition of its parent is active,
+i.e. the bounding volumes of the children are only rasterized if the bounding volume of the parent is visible.
+The visibility of all objects can also be resolved into a GPU buffer with ResolveVisibility,
+e.g. to generate the arguments for indirect draw commands in a compute shader.
+\code
+LLGL::OcclusionCullerDescriptor cullerDesc;
+cullerDesc.numObjects = numObjects;
+LLGL::OcclusionCuller myCuller { *myRenderer, cullerDesc };
+
+// Each frame (after the occluders have been drawn):
+myCmdBuffer->SetGraphicsPipeline(*myBoundingBoxPipeline); // Pipeline without color and depth writes
+for (std::uint32_t i = 0; i < numObjects; ++i)
+{
+    myCuller.BeginTest(*myCmdBuffer, i);
+    DrawBoundingBox(*myCmdBuffer, i);
+    myCuller.EndTest(*myCmdBuffer, i);
+}
+
+myCmdBuffer->SetGraphicsPipeline(*myScenePipeline);
+for (std::uint32_t i = 0; i < numObjects; ++i)
+{
+    myCuller.BeginConditionalDraw(*myCmdBuffer, i);
+    DrawObject(*myCmdBuffer, i);
+    myCuller.EndConditionalDraw(*myCmdBuffer);
+}
+\endcode
+\see CommandBuffer::BeginRenderCondition(QueryHeap&, std::uint32_t, const RenderConditionMode)
+*/
+class LLGL_EXPORT OcclusionCuller : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs the occlusion culler and creates its query heap with the specified render system.
+        \throws std::invalid_argument If 'desc.numObjects' is zero.
+        */
+        OcclusionCuller(RenderSystem& renderSystem, const OcclusionCullerDescriptor& desc);
+
+        //! Releases the query heap of this occlusion culler.
+        ~OcclusionCuller();
+
+        /**
+        \brief Begins the occlusion test of the specified object. All draw commands until EndTest contribute to the bounding volume of this object.
+        \param[in] commandBuffer Specifies the command buffer to record the test into.
+        \param[in] object Specifies the zero-based index of the object. This must be less than GetNumObjects.
+        \see EndTest
+        */
+        void BeginTest(CommandBuffer& commandBuffer, std::uint32_t object);
+
+        //! Ends the occlusion test of the specified object.
+        void EndTest(CommandBuffer& commandBuffer, std::uint32_t object);
+
+        /**
+        \brief Begins the conditional draw commands of the specified object, which are discarded on the GPU if the object was occluded.
+        \remarks The occlusion test of the object must have been recorded before. The renderers that do not support render conditions draw the object unconditionally.
+        \see EndConditionalDraw
+        */
+        void BeginConditionalDraw(CommandBuffer& commandBuffer, std::uint32_t object);
+
+        //! Ends the conditional draw commands of the current object.
+        void EndConditionalDraw(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Writes the visibility of all objects into the specified GPU buffer. Each object is written as 64-bit unsigned integer, where zero means occluded.
+        \remarks The CPU never waits for the results.
+        \see CommandBuffer::ResolveQueries
+        */
+        void ResolveVisibility(CommandBuffer& commandBuffer, Buffer& dstBuffer, std::uint64_t dstOffset = 0);
+
+        /**
+        \brief Retrieves the visibility of a range of objects on the CPU. Each object is written as 64-bit unsigned integer, where zero means occluded.
+        \return True if the results of all objects in the range are available, otherwise false.
+        \see CommandBuffer::QueryResults
+        */
+        bool QueryVisibility(CommandBuffer& commandBuffer, std::uint32_t firstObject, std::uint32_t numObjects, std::uint64_t* visibility);
+
+        //! Returns the query heap that stores the occlusion tests of all objects.
+        inline QueryHeap& GetQueryHeap() const
+        {
+            return *queryHeap_;
+        }
+
+        //! Returns the number of objects this occlusion culler can test within one frame.
+        inline std::uint32_t GetNumObjects() const
+        {
+            return numObjects_;
+        }
+
+    private:
+
+        void AssertObjectRange(std::uint32_t firstObject, std::uint32_t numObjects) const;
+
+        RenderSystem&       renderSystem_;
+        QueryHeap*          queryHeap_      = nullptr;
+        std::uint32_t       numObjects_     = 0;
+        RenderConditionMode mode_           = RenderConditionMode::NoWait;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
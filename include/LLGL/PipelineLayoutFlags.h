@@ -13,6 +13,7 @@
 #include "ResourceFlags.h"
 #include "BufferFlags.h"
 #include "ShaderFlags.h"
+#include "SamplerFlags.h"
 #include <vector>
 
 
@@ -20,6 +21,44 @@ namespace LLGL
 {
 
 
+/* ----- Flags ----- */
+
+/**
+\brief Binding descriptor flags enumeration.
+\see BindingDescriptor::flags
+*/
+struct BindingFlags
+{
+    enum
+    {
+        /**
+        \brief Specifies that the binding is an array of resources that is indexed dynamically in the shader, e.g. with an index from a constant buffer.
+        \remarks A bindless binding consumes 'arraySize' consecutive entries of ResourceHeapDescriptor::resourceViews instead of only one,
+        so a single resource heap can hold a large table of textures (or buffers) that is bound only once for many draw calls.
+        The index must be dynamically uniform, i.e. it must not diverge within a single draw call.
+        For OpenGL with the GL_ARB_bindless_texture extension, a bindless texture binding is a shader storage buffer at binding point 'slot'
+        that contains the 64-bit texture handles, e.g. <code>layout(std430, binding = 0) buffer Textures { uvec2 handles[]; }</code> and <code>sampler2D(handles[i])</code>.
+        Without that extension, the array elements are bound to the consecutive binding points starting at 'slot' (as for Direct3D 11).
+        \see RenderingFeatures::hasBindlessResources
+        */
+        Bindless = (1 << 0),
+
+        /**
+        \brief Specifies that a constant buffer binding is bound with a dynamic offset, which is passed to CommandBuffer::SetGraphicsResourceHeap or CommandBuffer::SetComputeResourceHeap.
+        \remarks This allows to pack the constants of many objects into a single large buffer and bind them all with the same resource heap, changing only the offset per object.
+        The shader sees the range of 'dynamicRangeSize' bytes beginning at the dynamic offset.
+        This can only be used for bindings of type ResourceType::ConstantBuffer with an array size of 1, and it cannot be combined with BindingFlags::Bindless.
+        For Vulkan, this is a descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC.
+        For Direct3D 12, this is a root constant buffer view instead of an entry in the descriptor table.
+        For Direct3D 11, this requires Direct3D 11.1 (otherwise the offset is ignored and the entire buffer is bound).
+        \see BindingDescriptor::dynamicRangeSize
+        \see RenderingFeatures::hasDynamicOffsets
+        */
+        DynamicOffset = (1 << 1),
+    };
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -41,26 +80,116 @@ struct BindingDescriptor
     }
 
     //! Resource view type for this layout binding. By default ResourceType::Undefined.
-    ResourceType    type        = ResourceType::Undefined;
+    ResourceType    type                = ResourceType::Undefined;
 
     /**
     \brief Specifies which shader stages are affected by this layout binding. By default 0.
     \remarks This can be a bitwise OR combination of the StageFlags bitmasks.
     \see StageFlags
     */
-    long            stageFlags  = 0;
+    long            stageFlags          = 0;
 
     /**
     \brief Specifies the zero-based binding slot. By default 0.
     \note For Vulkan, each binding slot of all layout bindings must have a different value within a pipeline layout.
     */
-    std::uint32_t   slot        = 0;
+    std::uint32_t   slot                = 0;
 
     /**
     \brief Specifies the number of binding slots for an array resource. By default 1.
     \note For Vulkan, this number specifies the size of an array of resources (e.g. an array of uniform buffers).
     */
-    std::uint32_t   arraySize   = 1;
+    std::uint32_t   arraySize           = 1;
+
+    /**
+    \brief Specifies optional binding flags. By default 0.
+    \remarks This can be a bitwise OR combination of the BindingFlags entries.
+    \see BindingFlags
+    */
+    long            flags               = 0;
+
+    /**
+    \brief Specifies the size (in bytes) of the buffer range that is visible to the shader for a binding with a dynamic offset. By default 0.
+    \remarks This must be greater than zero if 'flags' contains BindingFlags::DynamicOffset, and is ignored otherwise.
+    Each dynamic offset plus this size must not be greater than the size of the bound buffer.
+    \see BindingFlags::DynamicOffset
+    */
+    std::uint32_t   dynamicRangeSize    = 0;
+};
+
+/**
+\brief Layout structure for the small block of constants of a pipeline layout, which is set with CommandBuffer::SetConstants.
+\remarks The constants are meant for tiny per-draw data such as an object index or a tint color,
+which can then be changed without any buffer update or resource heap binding.
+For Vulkan, the constants are a push constant range, i.e. <code>layout(push_constant) uniform Constants { ... }</code>.
+For Direct3D 12, the constants are root constants at the constant buffer register 'slot', i.e. <code>cbuffer Constants : register(b0) { ... }</code>.
+For Direct3D 11 and OpenGL, the constants are emulated with a hidden constant buffer (or uniform buffer) that is bound to 'slot'.
+For Metal, the constants are set inline into the buffer argument table at index 'slot' (i.e. with <code>setVertexBytes</code> and <code>setFragmentBytes</code>).
+\see PipelineLayoutDescriptor::constants
+*/
+struct ConstantsDescriptor
+{
+    /**
+    \brief Size (in bytes) of the constants. By default 0, i.e. the pipeline layout has no constants.
+    \remarks This must be a multiple of 4 and must not be greater than RenderingLimits::maxConstantsSize.
+    */
+    std::uint32_t   size        = 0;
+
+    /**
+    \brief Specifies which shader stages can access the constants. By default StageFlags::AllStages.
+    \remarks This can be a bitwise OR combination of the StageFlags bitmasks.
+    */
+    long            stageFlags  = StageFlags::AllStages;
+
+    /**
+    \brief Specifies the zero-based constant buffer slot of the constants. By default 0.
+    \remarks This must not collide with any constant buffer binding of the same pipeline layout.
+    \note Only supported with: Direct3D 11, Direct3D 12, OpenGL, Metal.
+    */
+    std::uint32_t   slot        = 0;
+};
+
+/**
+\brief Layout structure for an immutable sampler, whose state is baked into the pipeline layout.
+\remarks Static samplers are meant for samplers that never change, since they require neither a Sampler object nor a resource view in the resource heap.
+For Direct3D 12, a static sampler is a static sampler of the root signature, i.e. it does not occupy any space in the sampler descriptor heap.
+For Vulkan, a static sampler is an immutable sampler of the descriptor set layout, so it is bound together with any resource heap of the pipeline layout
+(i.e. a resource heap must be bound even if the pipeline layout has no other bindings).
+\note Only supported with: Direct3D 12, Vulkan.
+\see PipelineLayoutDescriptor::staticSamplers
+\see RenderingFeatures::hasStaticSamplers
+*/
+struct StaticSamplerDescriptor
+{
+    StaticSamplerDescriptor() = default;
+    StaticSamplerDescriptor(const StaticSamplerDescriptor&) = default;
+
+    //! Constructor with all attributes.
+    inline StaticSamplerDescriptor(long stageFlags, std::uint32_t slot, const SamplerDescriptor& sampler) :
+        stageFlags { stageFlags },
+        slot       { slot       },
+        sampler    { sampler    }
+    {
+    }
+
+    /**
+    \brief Specifies which shader stages can access the sampler. By default 0.
+    \remarks This can be a bitwise OR combination of the StageFlags bitmasks.
+    \see StageFlags
+    */
+    long                stageFlags  = 0;
+
+    /**
+    \brief Specifies the zero-based binding slot of the sampler. By default 0.
+    \note For Vulkan, this slot must be different from the slots of all layout bindings within a pipeline layout.
+    */
+    std::uint32_t       slot        = 0;
+
+    /**
+    \brief Specifies the immutable sampler state.
+    \note For Direct3D 12, only the same three predefined border colors as for Vulkan are supported: (0, 0, 0, 0), (0, 0, 0, 1), and (1, 1, 1, 1).
+    */
+    SamplerDescriptor   sampler;
 };
 
 /**
@@ -69,7 +198,9 @@ struct BindingDescriptor
 */
 struct PipelineLayoutDescriptor
 {
-    std::vector<BindingDescriptor> bindings; //!< List of layout resource bindings.
+    std::vector<BindingDescriptor>          bindings;       //!< List of layout resource bindings.
+    ConstantsDescriptor                     constants;      //!< Layout of the constants that are set with CommandBuffer::SetConstants. By default no constants.
+    std::vector<StaticSamplerDescriptor>    staticSamplers; //!< List of immutable samplers, which are not part of the resource heaps. By default empty.
 };
 
 
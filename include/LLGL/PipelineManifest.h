@@ -0,0 +1,183 @@
+/*
+ * PipelineManifest.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PIPELINE_MANIFEST_H
+#define LLGL_PIPELINE_MANIFEST_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "GraphicsPipelineFlags.h"
+#include "ComputePipelineFlags.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class GraphicsPipeline;
+class ComputePipeline;
+class ShaderProgram;
+class PipelineLayout;
+class RenderTarget;
+
+/**
+\brief Records all pipeline states of a session into a manifest, which can be replayed at the next start of the application.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to create all pipeline states that were used in a previous session up front, e.g. behind a loading screen,
+so that pipeline requests at runtime are served from the pre-warmed pipelines instead of being created in the middle of a frame.
+Since the pipeline descriptors refer to other objects by pointer, the manifest refers to shader programs, pipeline layouts, and render targets
+by identifiers that must be stable across application runs, e.g. a hash of the shader source code.
+\code
+LLGL::PipelineManifest myManifest { *myRenderer };
+
+// At startup (or behind a loading screen):
+myManifest.RegisterShaderProgram(myShaderHash, *myShaderProgram);
+myManifest.Load("pipelines.manifest");
+myManifest.Prewarm();
+
+// At runtime, instead of myRenderer->CreateGraphicsPipeline(myPipelineDesc):
+auto myPipeline = myManifest.GetGraphicsPipeline(myPipelineDesc);
+
+// At shutdown:
+myManifest.Save("pipelines.manifest");
+\endcode
+\see RenderSystem::SavePipelineCache
+*/
+class LLGL_EXPORT PipelineManifest : public NonCopyable
+{
+
+    public:
+
+        //! Constructs an empty pipeline manifest for the specified render system.
+        PipelineManifest(RenderSystem& renderSystem);
+
+        //! Releases all pipeline states that have been created by this manifest.
+        ~PipelineManifest();
+
+        /**
+        \brief Registers the specified shader program under an identifier, which must be stable across application runs.
+        \remarks Pipeline states that refer to an unregistered shader program are still cached by GetGraphicsPipeline and GetComputePipeline, but they are not recorded.
+        \throws std::invalid_argument If 'id' is zero.
+        */
+        void RegisterShaderProgram(std::uint64_t id, ShaderProgram& shaderProgram);
+
+        /**
+        \brief Registers the specified pipeline layout under an identifier, which must be stable across application runs.
+        \throws std::invalid_argument If 'id' is zero.
+        */
+        void RegisterPipelineLayout(std::uint64_t id, PipelineLayout& pipelineLayout);
+
+        /**
+        \brief Registers the specified render target under an identifier, which must be stable across application runs.
+        \throws std::invalid_argument If 'id' is zero.
+        */
+        void RegisterRenderTarget(std::uint64_t id, RenderTarget& renderTarget);
+
+        /**
+        \brief Returns the graphics pipeline for the specified descriptor and records it in the manifest.
+        \remarks If a pipeline with an equal descriptor has already been created or pre-warmed, that pipeline is returned.
+        Otherwise, a new pipeline is created with RenderSystem::CreateGraphicsPipeline.
+        The returned pipeline is owned by this manifest and must not be released by the client programmer.
+        */
+        GraphicsPipeline* GetGraphicsPipeline(const GraphicsPipelineDescriptor& desc);
+
+        //! Returns the compute pipeline for the specified descriptor and records it in the manifest.
+        ComputePipeline* GetComputePipeline(const ComputePipelineDescriptor& desc);
+
+        /**
+        \brief Creates all pipeline states of the manifest whose shader programs, pipeline layouts, and render targets are registered.
+        \return Number of pipeline states that have been created by this call.
+        \remarks Graphics pipelines are created with RenderSystem::CreateGraphicsPipelineAsync, so they are compiled in parallel with the renderers that support it.
+        Pipeline states that have already been created are skipped, so this can be called again after more objects have been registered.
+        \see RenderSystem::CreateGraphicsPipelineAsync
+        */
+        std::size_t Prewarm();
+
+        //! Removes all recorded entries from the manifest. Pipeline states that have already been created are kept.
+        void Clear();
+
+        /**
+        \brief Writes all recorded entries into the specified binary file.
+        \return True if the file has been written successfully.
+        */
+        bool Save(const std::string& filename) const;
+
+        /**
+        \brief Reads the entries of the specified binary file and adds them to the manifest.
+        \return True if the file has been read successfully. If the file does not exist or is invalid, the return value is false and no exception is thrown.
+        \remarks This does not create any pipeline states. Call Prewarm afterwards.
+        */
+        bool Load(const std::string& filename);
+
+        //! Returns the number of recorded entries in this manifest.
+        inline std::size_t GetNumEntries() const
+        {
+            return entries_.size();
+        }
+
+    private:
+
+        struct PipelineEntry
+        {
+            GraphicsPipeline*   graphicsPipeline    = nullptr;
+            ComputePipeline*    computePipeline     = nullptr;
+            bool                recorded            = false;
+        };
+
+        // Registered objects by identifier and vice versa.
+        struct ObjectRegistry
+        {
+            void            Register(std::uint64_t id, void* obj);
+            std::uint64_t   FindID(const void* obj) const;
+            void*           FindObject(std::uint64_t id) const;
+
+            std::map<std::uint64_t, void*>          objects;
+            std::map<const void*, std::uint64_t>    ids;
+        };
+
+    private:
+
+        bool EncodeGraphicsPipeline(const GraphicsPipelineDescriptor& desc, std::string& key) const;
+        bool EncodeComputePipeline(const ComputePipelineDescriptor& desc, std::string& key) const;
+
+        bool DecodeGraphicsPipeline(const std::string& key, GraphicsPipelineDescriptor& desc) const;
+        bool DecodeComputePipeline(const std::string& key, ComputePipelineDescriptor& desc) const;
+
+        void RecordEntry(const std::string& key);
+
+    private:
+
+        RenderSystem&                               renderSystem_;
+
+        ObjectRegistry                              shaderPrograms_;
+        ObjectRegistry                              pipelineLayouts_;
+        ObjectRegistry                              renderTargets_;
+
+        std::vector<std::string>                    entries_;           // Encoded descriptors in the order of their first use
+        std::map<std::string, PipelineEntry>        pipelines_;         // Pipelines by encoded descriptor, including the unrecorded ones
+
+        std::vector<GraphicsPipeline*>              graphicsPipelines_;
+        std::vector<ComputePipeline*>               computePipelines_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
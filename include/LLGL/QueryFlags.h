@@ -11,6 +11,8 @@
 
 #include "Constants.h"
 #include <cstdint>
+#include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -123,6 +125,86 @@ struct QueryDescriptor
     bool        renderCondition = false;
 };
 
+/**
+\brief Query heap descriptor structure.
+\see RenderSystem::CreateQueryHeap
+*/
+struct QueryHeapDescriptor
+{
+    QueryHeapDescriptor() = default;
+
+    inline QueryHeapDescriptor(QueryType type, std::uint32_t numQueries) :
+        type       { type       },
+        numQueries { numQueries }
+    {
+    }
+
+    /**
+    \brief Specifies the type of all queries in the heap. By default QueryType::SamplesPassed (occlusion query).
+    \remarks This can only have one of the following values:
+    QueryType::SamplesPassed, QueryType::AnySamplesPassed, or QueryType::AnySamplesPassedConservative.
+    */
+    QueryType       type        = QueryType::SamplesPassed;
+
+    //! Specifies the number of queries in the heap. This must be greater than zero. By default 1.
+    std::uint32_t   numQueries  = 1;
+};
+
+/**
+\brief GPU timer scope structure, i.e. a single node in the hierarchy of timer scopes of a frame.
+\see CommandBuffer::BeginTimerScope
+\see TimerScopeFrame
+*/
+struct TimerScope
+{
+    //! Name of the timer scope as specified in CommandBuffer::BeginTimerScope.
+    std::string     name;
+
+    //! Index of the parent scope within TimerScopeFrame::scopes, or Constants::invalidTimerScope if this is a root scope.
+    std::uint32_t   parent      = Constants::invalidTimerScope;
+
+    //! Nesting depth of the timer scope. Root scopes have a depth of zero.
+    std::uint32_t   depth       = 0;
+
+    //! Elapsed GPU time (in nanoseconds) of the timer scope. Scopes that are still open at the end of their frame are ended automatically.
+    std::uint64_t   elapsedTime = 0;
+
+    /**
+    \brief GPU timestamp at the beginning of the timer scope, in the time domain of TimestampCalibration::gpuTimestamp.
+    \remarks This can be converted into the CPU timeline with RenderSystem::QueryTimestampCalibration.
+    For Direct3D 11, the frequency of these timestamps may change between frames, so they cannot be calibrated.
+    \see TimestampCalibration
+    */
+    std::uint64_t   beginTimestamp = 0;
+
+    /**
+    \brief Specifies whether the 'statistics' member is valid. By default false.
+    \remarks This is only true if the command buffer has been created with the CommandBufferFlags::TimerScopeStatistics flag,
+    the renderer supports pipeline statistics queries, and the frame did not exceed the internal limit of statistics queries.
+    */
+    bool            hasStatistics = false;
+
+    /**
+    \brief Pipeline statistics of all commands within the timer scope, including its child scopes. Only valid if 'hasStatistics' is true.
+    \remarks Members that are not supported by the renderer are set to Constants::invalidQueryResult.
+    \see CommandBufferFlags::TimerScopeStatistics
+    */
+    QueryPipelineStatistics statistics;
+};
+
+/**
+\brief Timer scopes of a single frame.
+\see CommandBuffer::QueryTimerScopes
+*/
+struct TimerScopeFrame
+{
+    //! Zero-based index of the frame (counted per command buffer) in which the timer scopes have been recorded.
+    std::uint64_t           index   = 0;
+
+    //! All timer scopes of the frame in depth-first order, i.e. each scope is directly followed by its children in the order they have been recorded.
+    std::vector<TimerScope> scopes;
+};
+
 
 } // /namespace LLGL
 
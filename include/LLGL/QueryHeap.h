@@ -0,0 +1,63 @@
+/*
+ * QueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_QUERY_HEAP_H
+#define LLGL_QUERY_HEAP_H
+
+
+#include "RenderSystemChild.h"
+#include "QueryFlags.h"
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Query heap interface, i.e. an array of queries of the same type.
+\see RenderSystem::CreateQueryHeap
+\see CommandBuffer::BeginQuery(QueryHeap&, std::uint32_t)
+\see CommandBuffer::QueryResults
+\see CommandBuffer::ResolveQueries
+*/
+class LLGL_EXPORT QueryHeap : public RenderSystemChild
+{
+
+    public:
+
+        //! Returns the type of all queries in this heap.
+        inline QueryType GetType() const
+        {
+            return type_;
+        }
+
+        //! Returns the number of queries in this heap.
+        inline std::uint32_t GetNumQueries() const
+        {
+            return numQueries_;
+        }
+
+    protected:
+
+        QueryHeap(const QueryHeapDescriptor& desc);
+
+    private:
+
+        QueryType       type_;
+        std::uint32_t   numQueries_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
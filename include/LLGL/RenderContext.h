@@ -51,6 +51,31 @@ class LLGL_EXPORT RenderContext : public RenderSystemChild
         //! Swaps the back buffer with the front buffer to present it on the screen (or rather on this render context).
         virtual void Present() = 0;
 
+        /**
+        \brief Blocks the calling thread until the swap-chain is ready to accept the next frame.
+        \remarks Call this at the beginning of each frame, before the user input is polled, to reduce the latency between input and presentation.
+        For Direct3D 11 and 12, this waits for the frame latency waitable object of a flip-model swap chain (see VideoModeDescriptor::presentMode and RenderContextDescriptor::maxFrameLatency).
+        For all other renderers, this has no effect, since frames are already paced by the Present function.
+        \see VideoModeDescriptor::presentMode
+        \see RenderContextDescriptor::framesInFlight
+        \see RenderContextDescriptor::maxFrameLatency
+        */
+        virtual void WaitForNextFrame();
+
+        /**
+        \brief Queries the statistics of the frames that have been presented by this render context.
+        \param[out] frameStats Specifies the output frame statistics. This is only modified if the function succeeds.
+        \return True on success, otherwise the frame statistics are not available.
+        \remarks For Direct3D 11 and 12, the statistics are sourced from IDXGISwapChain::GetFrameStatistics, which requires a flip-model swap chain or fullscreen mode.
+        For Vulkan, they are sourced from the extension VK_GOOGLE_display_timing.
+        For OpenGL on Linux, they are sourced from the extension GLX_OML_sync_control.
+        Missing present timestamps are estimated from the most recent vertical blank, and a missing refresh duration is derived from two consecutive queries.
+        If the event log of the RenderingProfiler is enabled, the debug layer queries these statistics on each call to Present and records them as display events.
+        \see FrameStatistics
+        \see RenderingProfiler::RecordFrameStatistics
+        */
+        bool QueryFrameStatistics(FrameStatistics& frameStats);
+
         /**
         \brief Returns the color format of this render context.
         \remarks This may depend on the settings specified for the video mode.
@@ -143,6 +168,15 @@ class LLGL_EXPORT RenderContext : public RenderSystemChild
         */
         virtual bool OnSetVsync(const VsyncDescriptor& vsyncDesc) = 0;
 
+        /**
+        \brief Callback to query the native frame statistics of the swap-chain.
+        \param[out] frameStats Specifies the output frame statistics. Members that are not supported by the renderer must be zero.
+        \return True on success, otherwise the frame statistics are not available. The default implementation returns false.
+        \remarks The member 'missedVblanks' is ignored, since it is accumulated by QueryFrameStatistics.
+        \see QueryFrameStatistics
+        */
+        virtual bool OnQueryFrameStatistics(FrameStatistics& frameStats);
+
         /**
         \brief Sets the render context surface or creates one if 'surface' is null, and switches to fullscreen mode if enabled.
         \param[in] surface Optional shared pointer to a surface which will be used as main render target.
@@ -193,6 +227,8 @@ class LLGL_EXPORT RenderContext : public RenderSystemChild
 
         std::unique_ptr<Offset2D>   cachedSurfacePos_;
 
+        FrameStatistics             frameStats_;        // Frame statistics of the most recent frame that reached the display, see QueryFrameStatistics
+
 };
 
 
@@ -50,6 +50,29 @@ enum class OpenGLContextProfile
     ESProfile,
 };
 
+/**
+\brief Swap-chain presentation mode enumeration.
+\remarks Modes that are not supported by the renderer or the surface fall back to the closest supported mode (see VideoModeDescriptor::presentMode).
+\see VideoModeDescriptor::presentMode
+*/
+enum class PresentMode
+{
+    //! Presentation mode is derived from the V-sync configuration, i.e. Fifo if VsyncDescriptor::enabled is true, otherwise Mailbox or Immediate. This is the default.
+    Default,
+
+    //! Frames are queued and presented at the vertical blank with the interval specified by VsyncDescriptor::interval. No tearing occurs.
+    Fifo,
+
+    //! Like Fifo, but a frame that misses its vertical blank is presented immediately. Tearing may occur for late frames only.
+    FifoRelaxed,
+
+    //! Only the latest frame is kept and presented at the next vertical blank, so the CPU never blocks on presentation. No tearing occurs.
+    Mailbox,
+
+    //! Frames are presented immediately without waiting for the vertical blank. Tearing may occur.
+    Immediate,
+};
+
 
 /* ----- Structures ----- */
 
@@ -124,6 +147,17 @@ struct VideoModeDescriptor
     If this value is 0, the video mode is invalid.
     */
     std::uint32_t   swapChainSize   = 2;
+
+    /**
+    \brief Swap-chain presentation mode. By default PresentMode::Default.
+    \remarks For Vulkan, a mode that is not supported by the surface falls back to PresentMode::Fifo.
+    For Direct3D 11 and 12, any mode other than PresentMode::Default enables the frame latency waitable object of the flip-model swap chain,
+    and PresentMode::FifoRelaxed behaves like PresentMode::Fifo.
+    Presentation without V-sync tears on Direct3D 11 if DXGI 1.5 supports it, otherwise PresentMode::Immediate behaves like PresentMode::Mailbox.
+    For OpenGL, PresentMode::FifoRelaxed requires adaptive V-sync (WGL/GLX_EXT_swap_control_tear), and PresentMode::Mailbox behaves like PresentMode::Immediate.
+    \see RenderContext::WaitForNextFrame
+    */
+    PresentMode     presentMode     = PresentMode::Default;
 };
 
 //TODO: move this into RenderSystemDescriptor, and make GL context creation part of GLRenderSystem instead of each GLRenderContext instance
@@ -166,9 +200,80 @@ struct RenderContextDescriptor
 
     //! Debuging callback function object.
     DebugCallback           debugCallback;
+
+    /**
+    \brief Number of frames the CPU can record ahead of the GPU. Must be in the range [1, 3]. By default 2.
+    \remarks With a value of 1, the CPU waits for the GPU to finish the previous frame before the next one is recorded.
+    With higher values, the CPU can record frame N+1 while the GPU is still rendering frame N, at the cost of additional latency.
+    This is only used by the Vulkan renderer, which allocates one pair of presentation semaphores and one primary command buffer per frame in flight,
+    and by the Metal renderer, which waits for the oldest frame in flight before it acquires the next drawable of the CAMetalLayer (i.e. a value of 3 enables triple buffering).
+    Values outside the valid range are clamped.
+    */
+    std::uint32_t           framesInFlight  = 2;
+
+    /**
+    \brief Maximum number of frames the presentation engine can queue up before Present blocks. Must be in the range [1, 16], or 0 for the default. By default 0.
+    \remarks A low value reduces the latency between user input and presentation, at the cost of less overlap between CPU and GPU work.
+    For Direct3D 11, a non-zero value enables the frame latency waitable object of a flip-model swap chain, so RenderContext::WaitForNextFrame must be called at the beginning of each frame.
+    For legacy swap chains, this is the maximum frame latency of the DXGI device, which applies to all render contexts. The default of DXGI is 3.
+    For Direct3D 12, the default is the number of frames in flight of the render system.
+    This is ignored by all other renderers. Values outside the valid range are clamped.
+    \see RenderContext::WaitForNextFrame
+    */
+    std::uint32_t           maxFrameLatency = 0;
+
+    /**
+    \brief Specifies whether the swap-chain is presented on an internal dedicated thread. By default false.
+    \remarks If enabled, RenderContext::Present submits the commands of the frame and hands the presentation over to that thread,
+    so the calling thread can record the next frame while the presentation blocks (e.g. in PresentMode::Fifo).
+    The presentation of a frame is always finished before the commands of the next frame are submitted,
+    i.e. the calling thread only blocks in RenderContext::Present if the previous presentation is still pending.
+    Errors of the presentation are reported by the next call to RenderContext::Present.
+    This is only supported by the Direct3D 12 and Vulkan renderers, and ignored by all other renderers.
+    */
+    bool                    threadedPresent = false;
+};
+
+/**
+\brief Frame statistics structure of a render context, i.e. when presented frames actually reached the display.
+\remarks All timestamps are in nanoseconds of the monotonic system clock (i.e. QueryPerformanceCounter on Windows and CLOCK_MONOTONIC on Linux),
+which is also the clock of std::chrono::steady_clock on these platforms, so they can be compared with the CPU timestamps of the RenderingProfiler.
+Members that are not supported by the renderer are zero.
+\see RenderContext::QueryFrameStatistics
+*/
+struct FrameStatistics
+{
+    /**
+    \brief ID of the most recent frame that reached the display.
+    \remarks Present IDs increase by one with each call to RenderContext::Present, but their origin depends on the renderer.
+    */
+    std::uint64_t   presentID           = 0;
+
+    //! Vertical refresh count at which the frame 'presentID' reached the display. Zero if unknown.
+    std::uint64_t   presentRefreshCount = 0;
+
+    //! Timestamp (in nanoseconds) at which the frame 'presentID' reached the display. Zero if unknown.
+    std::uint64_t   presentTime         = 0;
+
+    //! Vertical refresh count of the most recent vertical blank. Zero if unknown.
+    std::uint64_t   syncRefreshCount    = 0;
+
+    //! Timestamp (in nanoseconds) of the most recent vertical blank. Zero if unknown.
+    std::uint64_t   syncTime            = 0;
+
+    //! Duration (in nanoseconds) of a refresh cycle of the display. Zero if unknown.
+    std::uint64_t   refreshDuration     = 0;
+
+    /**
+    \brief Accumulated number of vertical blanks at which no new frame reached the display although one was expected.
+    \remarks With V-sync, each frame is expected to be displayed 'VsyncDescriptor::interval' refresh cycles after its predecessor.
+    This is accumulated over all calls to RenderContext::QueryFrameStatistics, so it should be queried once per frame.
+    */
+    std::uint64_t   missedVblanks       = 0;
 };
 
 
+
 /* ----- Operators ----- */
 
 //! Compares the two specified V-sync descriptors on equality.
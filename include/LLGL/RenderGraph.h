@@ -0,0 +1,188 @@
+/*
+ * RenderGraph.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_GRAPH_H
+#define LLGL_RENDER_GRAPH_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "RenderGraphFlags.h"
+#include "TextureFlags.h"
+#include "RenderPassFlags.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Texture;
+class RenderTarget;
+class RenderPass;
+
+/**
+\brief Frame graph layer above the command buffer to manage the transient render target attachments of a frame.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to declare the passes of a frame and the transient textures they write and read.
+When the graph is compiled, the lifetime of each transient texture is determined by the first and last pass that uses it.
+Transient textures with equal descriptors and disjoint lifetimes share the same physical texture,
+so a chain of post-processing passes only requires as many physical textures as are alive at the same time.
+\remarks The load and store operations of each attachment are derived from the graph as well:
+an attachment is neither loaded when it is written for the first time, nor stored when it is not used by any later pass (unless it is exported).
+The resource transitions between the passes are issued by the render system when the render passes begin and the resources are bound.
+\code
+LLGL::RenderGraph myGraph { *myRenderer };
+
+auto sceneColor = myGraph.DeclareTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, 800, 600));
+auto sceneDepth = myGraph.DeclareTexture(LLGL::Texture2DDesc(LLGL::Format::D32Float, 800, 600));
+
+LLGL::RenderGraphPassDescriptor scenePass;
+{
+    scenePass.colorAttachments          = { sceneColor };
+    scenePass.depthStencilAttachment    = sceneDepth;
+    scenePass.clear                     = true;
+    scenePass.execute                   = [&](LLGL::CommandBuffer& cmds) { DrawScene(cmds); };
+}
+myGraph.AddPass(scenePass);
+
+LLGL::RenderGraphPassDescriptor finalPass;
+{
+    finalPass.inputs                    = { sceneColor };
+    finalPass.renderContext             = myContext;
+    finalPass.execute                   = [&](LLGL::CommandBuffer& cmds) { DrawFullscreenQuad(cmds); };
+}
+myGraph.AddPass(finalPass);
+
+myGraph.Compile();
+// Create resource heaps with myGraph.GetTexture(sceneColor) ...
+
+// Each frame:
+myGraph.Execute(*myCmdBuffer);
+\endcode
+*/
+class LLGL_EXPORT RenderGraph : public NonCopyable
+{
+
+    public:
+
+        //! Constructs an empty render graph whose resources are created with the specified render system.
+        RenderGraph(RenderSystem& renderSystem);
+
+        //! Releases all physical resources of this render graph.
+        ~RenderGraph();
+
+        /**
+        \brief Declares a new transient texture and returns its identifier.
+        \param[in] textureDesc Specifies the texture descriptor. The flag TextureFlags::AttachmentUsage is always added.
+        \remarks All textures that are used as attachments by the same pass must have the same extent.
+        \throws std::logic_error If the graph has already been compiled.
+        */
+        std::uint32_t DeclareTexture(const TextureDescriptor& textureDesc);
+
+        /**
+        \brief Marks the specified transient texture to be exported, i.e. its content must be preserved after the last pass.
+        \remarks An exported texture stays alive until the end of the graph and never shares its physical texture with a transient texture that is used after it.
+        \throws std::logic_error If the graph has already been compiled.
+        */
+        void ExportTexture(std::uint32_t texture);
+
+        /**
+        \brief Appends a new pass to this render graph. The passes are executed in the order they were added.
+        \throws std::invalid_argument If the pass refers to an undeclared texture, or if it reads a texture that has not been written by an earlier pass.
+        \throws std::logic_error If the graph has already been compiled.
+        */
+        void AddPass(const RenderGraphPassDescriptor& passDesc);
+
+        /**
+        \brief Computes the lifetimes of all transient textures, assigns the physical textures, and creates all render targets and render passes.
+        \remarks After this call, no more textures or passes can be added until Reset is called.
+        */
+        void Compile();
+
+        /**
+        \brief Records all passes into the specified command buffer.
+        \remarks The graph must have been compiled. The command buffer must be in recording state, and no render pass must be active.
+        */
+        void Execute(CommandBuffer& commandBuffer);
+
+        //! Releases all physical resources and removes all textures and passes from this graph.
+        void Reset();
+
+        /**
+        \brief Returns the physical texture of the specified transient texture.
+        \remarks The graph must have been compiled. Different transient textures may return the same physical texture.
+        */
+        Texture* GetTexture(std::uint32_t texture) const;
+
+        //! Returns the number of physical textures that were created to back all transient textures. This is 0 until the graph is compiled.
+        inline std::uint32_t GetNumPhysicalTextures() const
+        {
+            return static_cast<std::uint32_t>(physicalTextures_.size());
+        }
+
+    private:
+
+        struct TransientTexture
+        {
+            TextureDescriptor   desc;
+            std::uint32_t       firstPass   = 0;        // Index of the first pass that uses this texture
+            std::uint32_t       lastPass    = 0;        // Index of the last pass that uses this texture
+            bool                written     = false;
+            bool                exported    = false;
+            std::uint32_t       physical    = 0;        // Index into 'physicalTextures_'
+        };
+
+        struct PhysicalTexture
+        {
+            TextureDescriptor   desc;
+            Texture*            texture     = nullptr;
+            std::uint32_t       lastPass    = 0;        // Index of the last pass that uses this physical texture
+        };
+
+        struct Pass
+        {
+            RenderGraphPassDescriptor   desc;
+            RenderTarget*               renderTarget    = nullptr;
+            RenderPass*                 renderPass      = nullptr;
+        };
+
+        void AssertNotCompiled(const char* funcName) const;
+        const TransientTexture& GetTransientTexture(std::uint32_t texture) const;
+        Texture* GetPhysicalTexture(std::uint32_t texture) const;
+
+        void UseTexture(std::uint32_t texture, std::uint32_t pass, bool write);
+        void AssignPhysicalTextures();
+
+        AttachmentOpsDescriptor GetAttachmentOps(std::uint32_t texture, std::uint32_t pass) const;
+        RenderPassDescriptor GetRenderPassDesc(std::uint32_t pass) const;
+
+        void CreatePassResources(std::uint32_t pass);
+        void ReleaseResources();
+
+        RenderSystem&                   renderSystem_;
+
+        std::vector<TransientTexture>   transientTextures_;
+        std::vector<PhysicalTexture>    physicalTextures_;
+        std::vector<Pass>               passes_;
+
+        bool                            compiled_       = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
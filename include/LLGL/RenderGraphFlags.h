@@ -0,0 +1,94 @@
+/*
+ * RenderGraphFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_GRAPH_FLAGS_H
+#define LLGL_RENDER_GRAPH_FLAGS_H
+
+
+#include "CommandBufferFlags.h"
+#include "Constants.h"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class CommandBuffer;
+class RenderContext;
+
+/* ----- Types ----- */
+
+/**
+\brief Render graph pass callback function interface.
+\param[in] commandBuffer Specifies the command buffer the render graph is executed with. The render pass of this graph pass has already begun.
+\remarks The callback must not begin or end any render pass on its own.
+\see RenderGraphPassDescriptor::execute
+*/
+using RenderGraphPassFunc = std::function<void(CommandBuffer& commandBuffer)>;
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Render graph pass descriptor structure.
+\remarks All textures are specified by the identifiers that are returned by RenderGraph::DeclareTexture.
+\see RenderGraph::AddPass
+*/
+struct RenderGraphPassDescriptor
+{
+    /**
+    \brief Transient textures that are written as color attachments by this pass.
+    \remarks If this is empty and 'renderContext' is null, the pass must have a depth-stencil attachment.
+    */
+    std::vector<std::uint32_t>  colorAttachments;
+
+    //! Transient texture that is written as depth-stencil attachment by this pass. By default Constants::invalidRenderGraphTexture.
+    std::uint32_t               depthStencilAttachment  = Constants::invalidRenderGraphTexture;
+
+    /**
+    \brief Transient textures that are read (e.g. sampled) by this pass.
+    \remarks A texture must be written by an earlier pass before it can be read.
+    The physical textures can be retrieved with RenderGraph::GetTexture after the graph has been compiled, e.g. to create the resource heaps of this pass.
+    */
+    std::vector<std::uint32_t>  inputs;
+
+    /**
+    \brief Optional render context this pass renders into instead of the attachments. By default null.
+    \remarks If this is non-null, 'colorAttachments' and 'depthStencilAttachment' are ignored. This is typically used for the final pass of a frame.
+    */
+    RenderContext*              renderContext           = nullptr;
+
+    /**
+    \brief Specifies whether the attachments are cleared when they are written for the first time. By default false.
+    \remarks If this is false, the previous content of an attachment that is written for the first time is undefined,
+    i.e. the pass is expected to overwrite the entire attachment.
+    \see clearValues
+    */
+    bool                        clear                   = false;
+
+    /**
+    \brief Clear values for the attachments of this pass, in the same order as for CommandBuffer::BeginRenderPass.
+    \remarks This is only used if 'clear' is true.
+    */
+    std::vector<ClearValue>     clearValues;
+
+    //! Callback that records the commands of this pass. This must not be null.
+    RenderGraphPassFunc         execute;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,63 @@
+/*
+ * RenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_PASS_H
+#define LLGL_RENDER_PASS_H
+
+
+#include "RenderSystemChild.h"
+#include "RenderPassFlags.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Render pass interface, i.e. the load and store operations of the render target attachments.
+\remarks A render pass specifies which attachment contents must be loaded at the beginning and stored at the end of rendering.
+This allows the renderer to avoid redundant clears, loads, and stores, which is in particular important for tile-based GPUs.
+\see RenderSystem::CreateRenderPass
+\see CommandBuffer::BeginRenderPass
+*/
+class LLGL_EXPORT RenderPass : public RenderSystemChild
+{
+
+    public:
+
+        //! Returns the descriptor this render pass has been created with.
+        inline const RenderPassDescriptor& GetDesc() const
+        {
+            return desc_;
+        }
+
+        //! Returns the operations of the specified color attachment, or the default operations if the render pass does not specify this attachment.
+        const AttachmentOpsDescriptor& GetColorAttachmentOps(std::uint32_t colorAttachment) const;
+
+        //! Returns the number of attachments that are cleared at the beginning of this render pass, for the specified number of color attachments and the presence of a depth-stencil attachment.
+        std::uint32_t GetNumClearAttachments(std::uint32_t numColorAttachments, bool hasDepthStencil) const;
+
+    protected:
+
+        RenderPass(const RenderPassDescriptor& desc);
+
+    private:
+
+        RenderPassDescriptor desc_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,105 @@
+/*
+ * RenderPassFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_PASS_FLAGS_H
+#define LLGL_RENDER_PASS_FLAGS_H
+
+
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Enumeration of the operations that are applied to an attachment at the beginning of a render pass.
+\see AttachmentOpsDescriptor::loadOp
+*/
+enum class AttachmentLoadOp
+{
+    /**
+    \brief The previous content of the attachment is undefined (i.e. it does not need to be preserved).
+    \remarks This is the cheapest operation and should be used if the entire attachment is overwritten during the render pass.
+    */
+    Undefined,
+
+    //! The previous content of the attachment is preserved.
+    Load,
+
+    /**
+    \brief The attachment is cleared with the respective clear value.
+    \remarks This is cheaper than a separate clear command after the render pass has begun, because many GPUs can clear the attachment while the tiles are initialized.
+    \see CommandBuffer::BeginRenderPass
+    */
+    Clear,
+};
+
+/**
+\brief Enumeration of the operations that are applied to an attachment at the end of a render pass.
+\see AttachmentOpsDescriptor::storeOp
+*/
+enum class AttachmentStoreOp
+{
+    /**
+    \brief The content of the attachment is undefined after the render pass (i.e. it does not need to be written back into memory).
+    \remarks This should be used for transient attachments that are only needed during the render pass, e.g. a depth buffer.
+    */
+    Undefined,
+
+    //! The content of the attachment is stored into memory.
+    Store,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Descriptor structure for the load and store operations of a single render pass attachment.
+\see RenderPassDescriptor
+*/
+struct AttachmentOpsDescriptor
+{
+    //! Specifies the operation at the beginning of the render pass. By default AttachmentLoadOp::Load.
+    AttachmentLoadOp    loadOp  = AttachmentLoadOp::Load;
+
+    //! Specifies the operation at the end of the render pass. By default AttachmentStoreOp::Store.
+    AttachmentStoreOp   storeOp = AttachmentStoreOp::Store;
+};
+
+/**
+\brief Render pass descriptor structure.
+\remarks A render pass only describes how the attachments of a render target are accessed, but not the render target itself.
+The same render pass can therefore be used with each render target (or render context) that has the same number of color attachments.
+\see RenderSystem::CreateRenderPass
+*/
+struct RenderPassDescriptor
+{
+    /**
+    \brief Specifies the load and store operations for each color attachment.
+    \remarks Color attachments of the render target that are not specified here use the default operations, i.e. AttachmentLoadOp::Load and AttachmentStoreOp::Store.
+    */
+    std::vector<AttachmentOpsDescriptor>    colorAttachments;
+
+    //! Specifies the load and store operations for the depth component of the depth-stencil attachment.
+    AttachmentOpsDescriptor                 depthAttachment;
+
+    //! Specifies the load and store operations for the stencil component of the depth-stencil attachment.
+    AttachmentOpsDescriptor                 stencilAttachment;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,7 @@
 #include "CommandBufferExt.h"
 #include "RenderSystemFlags.h"
 #include "RenderingProfiler.h"
+#include "RenderingStatistics.h"
 #include "RenderingDebugger.h"
 
 #include "Buffer.h"
@@ -24,17 +25,25 @@
 #include "ResourceHeap.h"
 
 #include "RenderTarget.h"
+#include "RenderPass.h"
 #include "Shader.h"
 #include "ShaderProgram.h"
 #include "PipelineLayout.h"
 #include "GraphicsPipeline.h"
 #include "ComputePipeline.h"
 #include "Query.h"
+#include "QueryHeap.h"
+#include "IndirectCommandLayout.h"
+#include "AccelerationStructure.h"
 #include "Fence.h"
+#include "VideoAdapter.h"
 
 #include <string>
 #include <memory>
 #include <vector>
+#include <functional>
+#include <mutex>
+#include <atomic>
 #include <cstdint>
 
 
@@ -59,6 +68,9 @@ renderSystem->WriteBuffer(*buffer, modificationData, ...);
 // Release object
 renderSystem->Release(*buffer);
 \endcode
+\remarks Objects can be released at any time, even while they are still referenced by commands that have been recorded or submitted during the current frame.
+Render systems with explicit GPU synchronization (i.e. Vulkan and Direct3D 12) defer the destruction of such objects
+until the GPU has completed the frame they were released in, without waiting for the device to be idle.
 */
 class LLGL_EXPORT RenderSystem : public NonCopyable
 {
@@ -70,9 +82,33 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         /**
         \brief Returns the list of all available render system modules for the current platform.
         \remarks For example, on Win32 this might be { "OpenGL", "Direct3D11", "Direct3D12" }, but on MacOS it might be only { "OpenGL" }.
+        Each module is only probed once per process, and all modules that need to be probed are loaded in parallel.
+        Modules that have been loaded before and are stored in the module cache (see SetModuleCacheFilename) are not probed again.
         */
         static std::vector<std::string> FindModules();
 
+        /**
+        \brief Sets the filename of the persistent module cache. By default empty, i.e. the module cache is not persisted.
+        \remarks If the file exists, its entries are read immediately.
+        Whenever a render system is loaded, its renderer info and rendering capabilities are stored in the module cache and the file is updated if they changed (e.g. after a driver update).
+        Renderers that only query their capabilities with the first render context (i.e. OpenGL) are stored when they are unloaded with Unload.
+        All entries are discarded if the file was written by a different build of LLGL, and an entry is ignored if its module file has been modified.
+        \see QueryRendererCaps
+        */
+        static void SetModuleCacheFilename(const std::string& filename);
+
+        /**
+        \brief Queries the rendering capabilities of the specified module without loading the module or creating a render system.
+        \param[in] moduleName Specifies the module name, e.g. "OpenGL".
+        \param[out] caps Specifies the output capabilities.
+        \param[out] info Optional pointer to the output renderer info. By default null.
+        \return True if the module cache contains an entry for the specified module, otherwise false.
+        \remarks The returned capabilities are the ones of the last render system that has been loaded from this module.
+        A driver update is therefore only reflected after the module has been loaded again.
+        \see SetModuleCacheFilename
+        */
+        static bool QueryRendererCaps(const std::string& moduleName, RenderingCapabilities& caps, RendererInfo* info = nullptr);
+
         /**
         \brief Loads a new render system from the specified module.
         \param[in] renderSystemDesc Specifies the render system descriptor structure. The 'moduleName' member of this strucutre must not be empty.
@@ -100,6 +136,12 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         static void Unload(std::unique_ptr<RenderSystem>&& renderSystem);
 
+        //! Allocates the render system with the host allocator of its descriptor (see RenderSystemDescriptor::allocator).
+        static void* operator new (std::size_t size);
+
+        //! Releases the render system with the host allocator it has been allocated with.
+        static void operator delete (void* ptr);
+
         /**
         \brief Rendering API identification number.
         \remarks This can be a value of the RendererID entries.
@@ -131,10 +173,20 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         \brief Returns the rendering capabilities.
         \remarks The validity of these information is only guaranteed if this function is called
         after a valid render context has been created. Otherwise the behavior is undefined!
+        Capabilities that are expensive to query (such as the list of supported texture formats) are only queried with the first call to this function.
+        For OpenGL, the first call must therefore be made on a thread with a current GL context.
+        */
+        const RenderingCapabilities& GetRenderingCaps() const;
+
+        /**
+        \brief Returns the descriptors of all video adapters (GPUs) that are available to this render system.
+        \remarks The adapter this render system has been created for can be selected with RenderSystemDescriptor::adapterIndex or RenderSystemDescriptor::adapterLUID,
+        and its name is reported by RendererInfo::deviceName. This list is empty for OpenGL.
+        \see RenderSystemDescriptor::adapterIndex
         */
-        inline const RenderingCapabilities& GetRenderingCaps() const
+        inline const std::vector<VideoAdapterDescriptor>& GetVideoAdapters() const
         {
-            return caps_;
+            return videoAdapters_;
         }
 
         /**
@@ -161,7 +213,10 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         \param[in] surface Optional shared pointer to a surface for the render context.
         If this is null, the render context will create its own platform specific surface, which can be accessed by "RenderContext::GetSurface".
         \remarks The render system takes the ownership of this object. All render contexts are deleted in the destructor of this render system.
+        Render contexts are optional for Vulkan, i.e. command buffers that only render into render targets are submitted by CommandQueue::Submit.
+        OpenGL requires a render context unless the render system has been loaded in headless mode.
         \see RenderContext::GetSurface
+        \see OpenGLRendererConfiguration::headless
         */
         virtual RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) = 0;
 
@@ -173,31 +228,69 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Returns the single instance of the command queue.
         virtual CommandQueue* GetCommandQueue() = 0;
 
+        /**
+        \brief Returns the single instance of the command queue of the specified type, or null if that queue type is not supported.
+        \remarks QueueType::Graphics always returns the same command queue as GetCommandQueue().
+        Command buffers that are submitted to the compute queue must have been created with CommandBufferDescriptor::queueType set to QueueType::Compute.
+        Command buffers that are submitted to the background queue must have been created with either QueueType::Background or QueueType::Compute.
+        The compute queue is not synchronized with the graphics queue, so use timeline fences to order their commands:
+        \code
+        computeQueue->Submit(*particleCmdBuffer);
+        computeQueue->Signal(*computeFence, ++computeFenceValue);
+        graphicsQueue->Wait(*computeFence, computeFenceValue);
+        \endcode
+        Resources that have been written with this render system (e.g. with WriteBuffer) are only guaranteed to be visible to the compute queue
+        once the graphics queue has signaled a timeline fence that the compute queue waits for.
+        \see RenderingFeatures::hasComputeQueue
+        \see RenderingFeatures::hasBackgroundQueue
+        */
+        virtual CommandQueue* GetCommandQueue(const QueueType type);
+
         /* ----- Command buffers ----- */
 
         /**
         \brief Creates a new command buffer.
+        \param[in] desc Specifies the command buffer descriptor. By default, OpenGL and Direct3D 11 command buffers execute their commands immediately.
         \remarks All render systems can create multiple command buffers,
         but especially for the legacy graphics APIs such as OpenGL and Direct3D 11, this doesn't provide any benefit,
         since all graphics and compute commands are submitted sequentially to the GPU.
+        \see CommandBufferFlags::DeferredSubmit
         */
-        virtual CommandBuffer* CreateCommandBuffer() = 0;
+        virtual CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) = 0;
 
         /**
         \brief Creates a new extended command buffer (if supported) with dynamic state access for shader resources (i.e. Constant Buffers, Storage Buffers, Textures, and Samplers).
         \return Pointer to the new CommandBufferExt object, or null if the render system does not support extended command buffers.
         \remarks For those render systems that do not support dynamic state access for shader resources, use the ResourceHeap interface.
-        \note Only supported with: OpenGL, Direct3D 11.
+        \note Only supported with: OpenGL, Direct3D 11, Vulkan.
         \see RenderingCapabilities::hasCommandBufferExt
         \see CreateResourceHeap
         */
         virtual CommandBufferExt* CreateCommandBufferExt() = 0;
 
+        /**
+        \brief Creates a new secondary command buffer (if supported), which can be recorded on a worker thread and executed by a primary command buffer.
+        \return Pointer to the new CommandBuffer object, or null if the render system does not support secondary command buffers.
+        \remarks Each secondary command buffer has its own command allocator, so different secondary command buffers can be recorded on different threads simultaneously.
+        Recording begins with the first call to \c SetRenderTarget, which specifies the render target the commands will be executed with (but does not bind it),
+        and ends when the secondary command buffer is passed to CommandBuffer::ExecuteCommands. The next call to \c SetRenderTarget begins a new recording,
+        unless the recording has been ended explicitly with CommandBuffer::End, in which case it is kept for reuse until CommandBuffer::Begin is called.
+        Secondary command buffers cannot be submitted to the command queue directly.
+        \note Only supported with: Vulkan, Direct3D 12.
+        With Direct3D 12, secondary command buffers are bundles that inherit viewports and scissors from the primary command buffer, and clear commands are ignored.
+        Bundles that bind resource heaps must be executed before the render context presents the frame they have been recorded in.
+        \see RenderingFeatures::hasSecondaryCommandBuffers
+        \see CommandBuffer::ExecuteCommands
+        \see CommandBuffer::End
+        */
+        virtual CommandBuffer* CreateSecondaryCommandBuffer() = 0;
+
         /**
         \brief Releases the specified command buffer. After this call, the specified object must no longer be used.
         \remarks This can be used for both CommandBuffer and CommandBufferExt objects as the latter one inherits from the former one.
         \see CreateCommandBuffer
         \see CreateCommandBufferExt
+        \see CreateSecondaryCommandBuffer
         */
         virtual void Release(CommandBuffer& commandBuffer) = 0;
 
@@ -213,6 +306,24 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) = 0;
 
+        /**
+        \brief Creates a new generic hardware buffer and streams its initial data from the specified file.
+        \param[in] desc Specifies the buffer descriptor. The 'size' member determines how many bytes are read from the file.
+        \param[in] filename Specifies the file from which the buffer is to be initialized.
+        \param[in] offset Specifies the offset (in bytes) within the file at which the buffer data begins. By default 0.
+        \param[in] chunkSize Specifies the size (in bytes) of each chunk that is uploaded at once. If this is zero, chunks of 1 MB are used. By default 0.
+        \remarks The file is memory-mapped and uploaded chunk by chunk with WriteBuffer, i.e. through the staging memory of the render system (e.g. the staging ring for Vulkan).
+        The next chunk is read ahead while the current chunk is uploaded, and the pages of uploaded chunks are released from physical memory,
+        so that large buffers (e.g. terrain or point clouds) can be loaded without holding the entire file in memory.
+        The chunk size should not exceed half of the staging ring size for Vulkan (see VulkanRendererConfiguration::stagingRingSize).
+        \throws std::runtime_error If the file could not be opened.
+        \throws std::invalid_argument If the file is smaller than 'offset' plus the buffer size.
+        \note Constant buffers cannot be partially updated with Direct3D 11, so they must not exceed the chunk size.
+        \see CreateBuffer
+        \see WriteBuffer
+        */
+        Buffer* CreateBufferFromFile(const BufferDescriptor& desc, const std::string& filename, std::uint64_t offset = 0, std::size_t chunkSize = 0);
+
         /**
         \brief Creates a new buffer array.
         \param[in] numBuffers Specifies the number of buffers in the array. This must be greater than 0.
@@ -254,12 +365,63 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual void* MapBuffer(Buffer& buffer, const CPUAccess access) = 0;
 
+        /**
+        \brief Maps the specified range of a buffer from GPU to CPU memory space.
+        \param[in] buffer Specifies the buffer which is to be mapped.
+        \param[in] access Specifies the CPU buffer access requirement, i.e. if the CPU can read and/or write the mapped memory.
+        \param[in] offset Specifies the offset (in bytes) of the range which is to be mapped.
+        \param[in] length Specifies the size (in bytes) of the range which is to be mapped.
+        This offset plus the range size (i.e. 'offset + length') must be less than or equal to the size of the buffer.
+        \return Raw pointer to the first byte of the mapped range, i.e. the returned pointer already includes the offset.
+        \remarks Only the mapped range is copied between GPU and CPU memory space (if the renderer requires such a copy at all),
+        so mapping a small range of a large buffer is much cheaper than mapping the entire buffer.
+        For Vulkan, buffers with CPU access are allocated in device local memory that is also host visible (e.g. with resizable BAR) if such memory is available,
+        in which case the buffer is mapped directly without any intermediate copy.
+        \see UnmapBuffer
+        */
+        virtual void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) = 0;
+
         /**
         \brief Unmaps the specified buffer.
         \see MapBuffer
         */
         virtual void UnmapBuffer(Buffer& buffer) = 0;
 
+        /**
+        \brief Enqueues an asynchronous read of the specified buffer range.
+        \param[in] buffer Specifies the buffer to read from. This buffer does not require any CPU access flags.
+        \param[in] offset Specifies the offset (in bytes) of the range to read.
+        \param[in] size Specifies the size (in bytes) of the range to read.
+        This offset plus the range size (i.e. 'offset + size') must be less than or equal to the size of the buffer.
+        \param[in] fence Specifies the fence that is submitted right after the copy command. Once this fence has been signaled, the buffer data is available.
+        \return Identifier of the new buffer readback. This must be passed to 'ReadBufferAsyncResult' exactly once.
+        \remarks In contrast to 'MapBuffer' with CPUAccess::ReadOnly, this function does not block the CPU. The buffer range is copied into a pooled readback buffer,
+        which is returned to its pool by 'ReadBufferAsyncResult', so recurring readbacks (e.g. culling statistics or picking results read every frame)
+        do not allocate any GPU memory. Retrieve the result a few frames later, once its fence has been signaled:
+        \code
+        // Enqueue readback of the current frame
+        auto myReadback = myRenderSystem->ReadBufferAsync(*myBuffer, 0, sizeof(MyStats), *myFence);
+
+        // A few frames later: check if the data is available without blocking
+        if (myCmdQueue->WaitFence(*myFence, 0))
+            myRenderSystem->ReadBufferAsyncResult(myReadback, &myStats, sizeof(MyStats));
+        \endcode
+        \see ReadBufferAsyncResult
+        \see ReadTextureAsync
+        */
+        virtual std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) = 0;
+
+        /**
+        \brief Retrieves the data of an asynchronous buffer read, and returns its readback buffer to the pool.
+        \param[in] readback Specifies the buffer readback identifier that has been returned by 'ReadBufferAsync'.
+        \param[out] data Raw pointer to the output data. This must not be null.
+        \param[in] dataSize Specifies the size (in bytes) of the output data. This must be greater than or equal to the size that has been passed to 'ReadBufferAsync'.
+        \remarks If the fence that has been passed to 'ReadBufferAsync' has not been signaled yet, this function blocks the CPU until the data is available.
+        \throws std::invalid_argument If 'readback' does not denote a pending buffer readback, or if 'dataSize' is less than the required size.
+        \see ReadBufferAsync
+        */
+        virtual void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) = 0;
+
         /* ----- Textures ----- */
 
         /**
@@ -268,12 +430,38 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         \param[in] imageDesc Optional pointer to the image data descriptor.
         If this is null, the texture will be initialized with the currently configured default image color.
         If this is non-null, it is used to initialize the texture data.
+        If its 'mipLevels' member is greater than 1, all MIP-map levels it contains are uploaded at once (see Image::GenerateMipChain).
         This parameter will be ignored if the texture type is a multi-sampled texture (i.e. TextureType::Texture2DMS or TextureType::Texture2DMSArray).
         \see WriteTexture
         \see RenderSystemConfiguration::imageInitialization
         */
         virtual Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) = 0;
 
+        /**
+        \brief Creates a new texture and initializes any number of its MIP-map levels and array layers.
+        \param[in] textureDesc Specifies the texture descriptor.
+        \param[in] numImages Specifies the number of images in the array 'images'.
+        \param[in] images Pointer to an array of sub-resource images. Each image is passed to the render system as is, i.e. without any intermediate copy or conversion.
+        \remarks This is primarily used to upload the pre-compressed MIP-map chain of a TextureContainer.
+        If no image covers all array layers of the first MIP-map level, the texture is created without the default image initialization.
+        \see TextureContainer
+        \see WriteTexture
+        */
+        Texture* CreateTexture(const TextureDescriptor& textureDesc, std::uint32_t numImages, const TextureSubresourceImage* images);
+
+        /**
+        \brief Creates a new texture view that shares the memory of the specified texture.
+        \param[in] sharedTexture Specifies the texture whose memory is shared with the new texture view. This must not be a texture view itself.
+        \param[in] textureViewDesc Specifies the texture view descriptor.
+        \return Pointer to the new texture view, which is released with the 'Release(Texture&)' function like any other texture.
+        \remarks Texture views can only be bound as shader resources (e.g. for sampling to process the faces of a cube texture individually,
+        or to read an sRGB texture with linear texel values), but they cannot be used for copy commands, render target attachments, or the
+        WriteTexture, ReadTexture, and GenerateMips functions. The shared texture must not be released as long as any of its views is in use.
+        \note Only supported if RenderingFeatures::hasTextureViews is true.
+        \see TextureViewDescriptor
+        */
+        virtual Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) = 0;
+
         //! Releases the specified texture object. After this call, the specified object must no longer be used.
         virtual void Release(Texture& texture) = 0;
 
@@ -286,6 +474,53 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Updates the image data of several regions of the specified texture at once, e.g. all MIP-map levels and array layers of a texture array.
+        \param[in] texture Specifies the texture whose data is to be updated.
+        \param[in] numRegions Specifies the number of regions in the array 'regions'.
+        \param[in] regions Pointer to an array of sub-texture images. This must point to at least 'numRegions' elements.
+        \remarks The result is the same as calling WriteTexture for each region in order, but the number of API round trips does not scale with the number of regions:
+        For Direct3D 12 and Vulkan, the image data of all regions is copied into one staging allocation and all copy commands are recorded as a single upload.
+        For all other renderers, each region is written with WriteTexture within an upload batch (see BeginUploadBatch).
+        \see WriteTexture
+        \see SubTextureImage
+        */
+        virtual void WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions);
+
+        /**
+        \brief Begins an upload of the image data of the specified texture region, and returns the staging memory the CPU can write the texel data to.
+        \param[in] texture Specifies the texture whose data is to be updated.
+        \param[in] subTextureDesc Specifies the sub-texture descriptor.
+        \return Staging memory of the texture region. Its layout is determined by the renderer, so the row and slice pitch must be respected.
+        \remarks In contrast to WriteTexture, the texel data is not copied from user memory into staging memory,
+        i.e. an image decoder can write its output directly into the upload memory of the renderer:
+        \code
+        auto myUpload = myRenderSystem->BeginTextureUpload(*myTexture, mySubTextureDesc);
+        {
+            for (std::uint32_t y = 0; y < mySubTextureDesc.extent.height; ++y)
+                MyDecodeRow(y, static_cast<char*>(myUpload.data) + y * myUpload.rowPitch);
+        }
+        myRenderSystem->EndTextureUpload();
+        \endcode
+        For Direct3D 12 and Vulkan, the staging memory is allocated from the upload ring of the renderer.
+        For all other renderers, the staging memory is a tightly packed CPU buffer, which is written to the texture with WriteTexture.
+        Only one texture upload can be in progress at a time, and no other resources must be created or written until the upload has been ended.
+        \note Only supported for textures that are neither multi-sampled nor have a depth-stencil format.
+        \throws std::invalid_argument If the texture is multi-sampled or has a depth-stencil format.
+        \throws std::runtime_error If another texture upload is already in progress.
+        \see EndTextureUpload
+        \see TextureUploadMemory
+        */
+        virtual TextureUploadMemory BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc);
+
+        /**
+        \brief Ends the texture upload that has been started with BeginTextureUpload, and records the copy from staging memory into the texture.
+        \remarks After this call, the staging memory returned by BeginTextureUpload must no longer be used.
+        \throws std::runtime_error If no texture upload is in progress.
+        \see BeginTextureUpload
+        */
+        virtual void EndTextureUpload();
+
         /**
         \brief Reads the image data from the specified texture.
         \param[in] texture Specifies the texture object to read from.
@@ -320,6 +555,41 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Enqueues an asynchronous read of the image data from the specified texture region.
+        \param[in] texture Specifies the texture object to read from.
+        \param[in] region Specifies the texture region to read. The array layers are specified in the same way as for the SubTextureDescriptor structure.
+        \param[in] fence Specifies the fence that is submitted right after the copy command. Once this fence has been signaled, the image data is available.
+        \return Identifier of the new texture readback. This must be passed to 'ReadTextureAsyncResult' exactly once.
+        \remarks In contrast to 'ReadTexture', this function does not block the CPU. The texture region is copied into a pooled staging resource,
+        which is returned to its pool by 'ReadTextureAsyncResult', so recurring readbacks of the same size do not allocate any GPU memory.
+        To poll whether the data is available, wait for the fence with a timeout of zero:
+        \code
+        // Enqueue readback of the current frame
+        auto myReadback = myRenderSystem->ReadTextureAsync(*myTexture, myRegion, *myFence);
+
+        // A few frames later: check if the data is available without blocking
+        if (myCmdQueue->WaitFence(*myFence, 0))
+            myRenderSystem->ReadTextureAsyncResult(myReadback, myImageDesc);
+        \endcode
+        \note Only supported for uncompressed color formats that are not multi-sampled.
+        \throws std::invalid_argument If the texture has a compressed, depth-stencil, or multi-sampled format.
+        \see ReadTextureAsyncResult
+        \see CommandQueue::WaitFence
+        */
+        virtual std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) = 0;
+
+        /**
+        \brief Retrieves the image data of an asynchronous texture read, and returns its staging resource to the pool.
+        \param[in] readback Specifies the texture readback identifier that has been returned by 'ReadTextureAsync'.
+        \param[out] imageDesc Specifies the destination image descriptor to write the texture data to.
+        The image data is tightly packed, and converted into the format and data type of this descriptor if they differ from the texture format.
+        \remarks If the fence that has been passed to 'ReadTextureAsync' has not been signaled yet, this function blocks the CPU until the data is available.
+        \throws std::invalid_argument If 'readback' does not denote a pending texture readback, or if 'imageDesc.dataSize' is less than the required size.
+        \see ReadTextureAsync
+        */
+        virtual void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) = 0;
+
         /**
         \brief Generates all MIP-maps for the specified texture.
         \param[in,out] texture Specifies the texture whose MIP-maps are to be generated.
@@ -346,16 +616,57 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) = 0;
 
+        /**
+        \brief Queries the tile shape of sparse textures with the specified format and type.
+        \param[in] format Specifies the texture format.
+        \param[in] type Specifies the texture type.
+        \param[out] tileShape Specifies the output extent (in texels) of a single tile.
+        \return True if sparse textures with the specified format and type are supported. Otherwise, the output parameter is not modified.
+        \remarks The offset and extent of each region that is committed with CommitTextureTiles must be a multiple of this tile shape,
+        except for the region boundaries at the end of a MIP-map level.
+        \see TextureFlags::Sparse
+        \see CommitTextureTiles
+        */
+        virtual bool QuerySparseTileShape(const Format format, const TextureType type, Extent3D& tileShape);
+
+        /**
+        \brief Commits or decommits the physical memory of the specified region of a sparse texture.
+        \param[in,out] texture Specifies the sparse texture whose memory is to be committed or decommitted. This texture must have been created with the TextureFlags::Sparse flag.
+        \param[in] region Specifies the region of tiles. The array layers are specified in the same way as for the SubTextureDescriptor structure.
+        \param[in] commit Specifies whether the memory of the region is to be committed (true) or decommitted (false).
+        \remarks The content of newly committed tiles is undefined until it is written with WriteTexture.
+        With this function, only the visible pages of a huge virtual texture must be resident in memory.
+        \throws std::runtime_error If the renderer does not support sparse textures.
+        \see QuerySparseTileShape
+        \see RenderingFeatures::hasSparseTextures
+        */
+        virtual void CommitTextureTiles(Texture& texture, const TextureRegion& region, bool commit);
+
+        /**
+        \brief Clamps the sampling of the specified texture to the MIP-map levels that are greater than or equal to the specified level of detail.
+        \param[in,out] texture Specifies the texture whose sampling is to be clamped. This must not be a texture view.
+        \param[in] minLOD Specifies the minimum level of detail. A value of 0 removes the clamp.
+        \remarks This allows to keep only the lower MIP-map levels of a texture resident (or initialized), while the higher MIP-map levels are streamed in incrementally.
+        For OpenGL, the level of detail is rounded up to the next MIP-map level, since it is implemented with the base level of the texture (GL_TEXTURE_BASE_LEVEL).
+        For Direct3D 12, the clamp only applies to resource heaps that are created after this call (ResourceMinLODClamp).
+        \throws std::runtime_error If the renderer does not support this feature.
+        \see RenderingFeatures::hasTextureMinLOD
+        \see TextureStreamer
+        */
+        virtual void SetTextureMinLOD(Texture& texture, float minLOD);
+
         /* ----- Samplers ---- */
 
         /**
         \brief Creates a new Sampler object.
+        \remarks Sampler objects are shared between identical sampler descriptors, i.e. this function may return the same object for multiple calls.
+        Each call to this function must be paired with a call to \c Release, and a shared sampler is only destroyed when its last reference has been released.
         \throws std::runtime_error If the renderer does not support Sampler objects (e.g. if OpenGL 3.1 or lower is used).
         \see GetRenderingCaps
         */
         virtual Sampler* CreateSampler(const SamplerDescriptor& desc) = 0;
 
-        //! Releases the specified Sampler object. After this call, the specified object must no longer be used.
+        //! Releases the specified Sampler object. After this call, the specified object must no longer be used (even if it is still shared with other references).
         virtual void Release(Sampler& sampler) = 0;
 
         /* ----- Resource Heaps ----- */
@@ -374,6 +685,22 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Releases the specified ResourceHeap object. After this call, the specified object must no longer be used.
         virtual void Release(ResourceHeap& resourceHeap) = 0;
 
+        /**
+        \brief Replaces resource views of the specified resource heap in place, without releasing and re-creating the heap.
+        \param[in] resourceHeap Specifies the resource heap whose resource views are to be replaced.
+        \param[in] firstDescriptor Specifies the zero-based index of the first resource view that is to be replaced.
+        This refers to the order of the resource views in ResourceHeapDescriptor::resourceViews when the heap was created.
+        \param[in] numResourceViews Specifies the number of resource views that are to be replaced.
+        \param[in] resourceViews Pointer to an array of the new resource views. This must point to at least 'numResourceViews' elements.
+        \remarks Each new resource must be of the same type as the resource it replaces, since the layout of the heap is determined by its pipeline layout.
+        This is intended for resources that are frequently exchanged, such as streamed textures or material parameters, where re-creating the heap would allocate a new descriptor set every time.
+        The change only affects subsequent calls to CommandBuffer::SetGraphicsResourceHeap and CommandBuffer::SetComputeResourceHeap.
+        \note For the Vulkan backend, the resource heap must not be in use by any command buffer that has been submitted but has not completed yet.
+        \throws std::out_of_range If 'firstDescriptor' plus 'numResourceViews' exceeds the number of resource views of the heap.
+        \see CreateResourceHeap
+        */
+        virtual void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) = 0;
+
         /* ----- Render Targets ----- */
 
         /**
@@ -385,6 +712,19 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Releases the specified RenderTarget object. After this call, the specified object must no longer be used.
         virtual void Release(RenderTarget& renderTarget) = 0;
 
+        /* ----- Render Passes ----- */
+
+        /**
+        \brief Creates a new RenderPass object with the specified load and store operations for the attachments.
+        \remarks A render pass is not bound to a specific render target and can be used with any render target (or render context) via CommandBuffer::BeginRenderPass.
+        \see RenderPassDescriptor
+        \see CommandBuffer::BeginRenderPass
+        */
+        virtual RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) = 0;
+
+        //! Releases the specified RenderPass object. After this call, the specified object must no longer be used.
+        virtual void Release(RenderPass& renderPass) = 0;
+
         /* ----- Shader ----- */
 
         /**
@@ -441,6 +781,19 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) = 0;
 
+        /**
+        \brief Creates a new graphics pipeline state object on a background thread.
+        \param[in] desc Specifies the graphics pipeline descriptor. The descriptor is copied,
+        but all objects it refers to (e.g. the shader program and pipeline layout) must stay alive until the pipeline is ready.
+        \remarks The returned pipeline can be used immediately, but binding it with CommandBuffer::SetGraphicsPipeline blocks until its creation has finished.
+        Use GraphicsPipeline::IsReady to query whether the pipeline can be bound without blocking, e.g. to keep drawing a fallback material in the meantime.
+        Errors during the asynchronous creation are rethrown when the pipeline is bound for the first time.
+        \note Only supported with: Vulkan, Direct3D 12. All other renderers create the pipeline synchronously.
+        \see CreateGraphicsPipeline
+        \see GraphicsPipeline::IsReady
+        */
+        virtual GraphicsPipeline* CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc);
+
         /**
         \brief Creates a new and initialized compute pipeline state object.
         \param[in] desc Specifies the compute pipeline descriptor. This will describe the shader states.
@@ -455,6 +808,101 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Releases the specified ComputePipeline object. After this call, the specified object must no longer be used.
         virtual void Release(ComputePipeline& computePipeline) = 0;
 
+        /* ----- Pipeline Caches ----- */
+
+        /**
+        \brief Returns the binary blob of the internal pipeline state cache.
+        \return Binary blob of the pipeline cache, or an empty container if the render system does not support pipeline caches.
+        \remarks All graphics and compute pipelines are created with this internal cache.
+        The returned blob can be stored on disk and passed to 'SetPipelineCacheData' on the next launch of the application,
+        so the driver can skip the compilation of all pipeline states that have already been compiled before.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see SetPipelineCacheData
+        \see SavePipelineCache
+        */
+        virtual std::vector<char> GetPipelineCacheData() const;
+
+        /**
+        \brief Merges the specified binary blob into the internal pipeline state cache.
+        \param[in] data Raw pointer to the pipeline cache blob, which has previously been returned by 'GetPipelineCacheData'.
+        \param[in] dataSize Specifies the size (in bytes) of the pipeline cache blob.
+        \return True if the blob has been merged into the pipeline cache. Otherwise, the render system does not support pipeline caches,
+        or the blob was created with a different device or driver version and was ignored.
+        \remarks This should be called before any pipeline state is created, otherwise those pipelines will not benefit from this cache.
+        With Direct3D 12, the blob replaces the internal pipeline library instead of being merged into it.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see GetPipelineCacheData
+        \see LoadPipelineCache
+        */
+        virtual bool SetPipelineCacheData(const void* data, std::size_t dataSize);
+
+        /**
+        \brief Writes the blob of the internal pipeline state cache into the specified binary file.
+        \return True if the render system supports pipeline caches and the file has been written successfully.
+        \see GetPipelineCacheData
+        */
+        bool SavePipelineCache(const std::string& filename) const;
+
+        /**
+        \brief Reads the specified binary file and merges its content into the internal pipeline state cache.
+        \return True if the file has been read successfully and its content has been accepted by the render system.
+        If the file does not exist, the return value is false and no exception is thrown.
+        \see SetPipelineCacheData
+        */
+        bool LoadPipelineCache(const std::string& filename);
+
+        /* ----- Statistics ----- */
+
+        /**
+        \brief Retrieves the rendering statistics of this render system and all of its command buffers.
+        \param[out] statistics Specifies the output statistics. The counters accumulate since the previous reset.
+        \param[in] reset Specifies whether all counters are reset to zero after they have been retrieved. Resetting once per frame yields per-frame statistics.
+        \return True if the statistics are available, i.e. LLGL was compiled with the "LLGL_ENABLE_STATISTICS" flag. Otherwise, all values are zero.
+        \remarks In contrast to the RenderingProfiler, this does not require the debug layer. The counters are atomic, so command buffers can be recorded from multiple threads.
+        \see RenderingStatistics
+        */
+        virtual bool QueryStatistics(RenderingStatistics& statistics, bool reset = true);
+
+        /**
+        \brief Retrieves the GPU memory statistics of this render system, i.e. the allocated and used memory and the memory budget for each memory heap.
+        \param[out] statistics Specifies the output statistics.
+        \return True if the statistics are available. Otherwise, the list of memory heaps is empty.
+        \remarks The memory budget is queried from the operating system each time this function is called, so it should not be called more than once per frame.
+        The sources of the statistics depend on the backend:
+        - Vulkan: allocated and used memory of the device memory manager; budget and usage with the \c VK_EXT_memory_budget extension.
+        - Direct3D 11 and 12: budget and usage with \c IDXGIAdapter3::QueryVideoMemoryInfo (requires DXGI 1.4) for the local and non-local memory segment groups.
+        - OpenGL: a single device local heap with the \c GL_NVX_gpu_memory_info or \c GL_ATI_meminfo extension. With the latter, only the available memory is known,
+        which is reported as budget with zero usage.
+        \see MemoryStatistics
+        */
+        virtual bool QueryMemoryStatistics(MemoryStatistics& statistics);
+
+        /**
+        \brief Samples a GPU timestamp together with a CPU timestamp, to place GPU timestamps (e.g. of timer scopes) in the CPU timeline.
+        \param[out] calibration Specifies the output calibration. This is only modified if the function succeeds.
+        \return True if calibrated timestamps are supported. Otherwise, GPU timestamps cannot be correlated with CPU timestamps.
+        \remarks The sources of the calibration depend on the backend:
+        - Vulkan: \c vkGetCalibratedTimestampsEXT with the \c VK_EXT_calibrated_timestamps extension, if the device supports the time domain of Timer::Tick.
+        - Direct3D 12: \c ID3D12CommandQueue::GetClockCalibration of the graphics queue.
+        - OpenGL: \c GL_TIMESTAMP with \c glGetInteger64v, sampled against Timer::Tick (requires \c GL_ARB_timer_query). This does not provide a maximum deviation.
+        - Direct3D 11 and Metal: not supported.
+        \see TimestampCalibration
+        \see Timer::Tick
+        */
+        virtual bool QueryTimestampCalibration(TimestampCalibration& calibration);
+
+        /**
+        \brief Aggregates the allocated memory of all buffers and textures by the prefix of their debug names, to attribute memory to the subsystems that own it.
+        \param[out] report Specifies the output report. This is only modified if the function succeeds.
+        \param[in] separator Specifies the character that terminates the name prefix, e.g. the prefix of "Terrain/HeightMap" is "Terrain" with the default separator '/'.
+        If this is the null character, or the name does not contain the separator, the entire name is used as prefix. By default '/'.
+        \return True if the report is supported. This requires the debug layer (i.e. the render system must have been loaded with a profiler or debugger),
+        which tracks the debug names (see RenderSystemChild::SetName) and sizes of all resources.
+        \remarks This must not be called while other threads create or release buffers or textures.
+        \see ResourceMemoryReport
+        */
+        virtual bool QueryResourceMemoryReport(ResourceMemoryReport& report, char separator = '/');
+
         /* ----- Queries ----- */
 
         //! Creates a new query.
@@ -463,6 +911,49 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Releases the specified Query object. After this call, the specified object must no longer be used.
         virtual void Release(Query& query) = 0;
 
+        /**
+        \brief Creates a new query heap, i.e. an array of queries that is backed by a single native query pool.
+        \remarks Query heaps avoid the overhead of individual query objects, and their results can be retrieved in a single batch.
+        \throws std::invalid_argument If 'desc.numQueries' is zero or 'desc.type' is not an occlusion query type.
+        \see QueryHeapDescriptor
+        \see CommandBuffer::QueryResults
+        \see CommandBuffer::ResolveQueries
+        */
+        virtual QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) = 0;
+
+        //! Releases the specified QueryHeap object. After this call, the specified object must no longer be used.
+        virtual void Release(QueryHeap& queryHeap) = 0;
+
+        /* ----- Indirect Command Layouts ----- */
+
+        /**
+        \brief Creates a new indirect command layout, which allows indirect draw commands to change vertex buffers and constants per draw.
+        \remarks The default implementation throws an exception, since only a few renderers support this feature.
+        \throws std::runtime_error If the renderer does not support indirect command layouts (see RenderingFeatures::hasIndirectCommandLayouts).
+        \throws std::invalid_argument If the descriptor does not specify exactly one draw argument as last argument.
+        \see IndirectCommandLayoutDescriptor
+        \see CommandBuffer::ExecuteIndirect
+        */
+        virtual IndirectCommandLayout* CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc);
+
+        //! Releases the specified IndirectCommandLayout object. After this call, the specified object must no longer be used.
+        virtual void Release(IndirectCommandLayout& indirectCommandLayout);
+
+        /* ----- Acceleration Structures ----- */
+
+        /**
+        \brief Creates a new acceleration structure for hardware ray queries.
+        \remarks The storage and scratch memory are allocated from the size of the specified inputs, but the acceleration structure is only built by CommandBuffer::BuildAccelerationStructures.
+        The default implementation throws an exception, since only a few renderers support this feature.
+        \throws std::runtime_error If the renderer does not support ray queries (see RenderingFeatures::hasRayQueries).
+        \see AccelerationStructureDescriptor
+        \see CommandBuffer::BuildAccelerationStructures
+        */
+        virtual AccelerationStructure* CreateAccelerationStructure(const AccelerationStructureDescriptor& desc);
+
+        //! Releases the specified AccelerationStructure object. After this call, the specified object must no longer be used.
+        virtual void Release(AccelerationStructure& accelerationStructure);
+
         /* ----- Fences ----- */
 
         /**
@@ -475,6 +966,70 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Releases the specified Fence object. After this call, the specified object must no longer be used.
         virtual void Release(Fence& fence) = 0;
 
+        /* ----- Upload batches ----- */
+
+        /**
+        \brief Begins a batch of resource uploads, e.g. to create a large number of buffers and textures while a level is loaded.
+        \remarks All upload commands of CreateBuffer, WriteBuffer, CreateTexture, WriteTexture, EndTextureUpload, and GenerateMips are recorded into a single command buffer,
+        which is submitted once by EndUploadBatch instead of once per resource, so the load time scales with the amount of data rather than the number of resources:
+        \code
+        myRenderSystem->BeginUploadBatch();
+        {
+            for (const auto& myImage : myImages)
+                myTextures.push_back(myRenderSystem->CreateTexture(myImage.textureDesc, &(myImage.imageDesc)));
+        }
+        myRenderSystem->EndUploadBatch();
+        \endcode
+        Upload batches can be nested, in which case only the outermost call to EndUploadBatch submits the batch.
+        The resources of a batch must not be used by any command buffer that is submitted before the batch has been ended.
+        Functions that read resources back to the CPU (e.g. ReadTextureAsync) submit all pending uploads of the current batch immediately.
+        \note Upload batches can only be used on the render thread. For Direct3D 12, each resource upload is otherwise submitted individually.
+        For Vulkan, all uploads are recorded into the current batch of the staging ring anyway, which is submitted by EndUploadBatch.
+        For all other renderers, this function has no effect.
+        \see EndUploadBatch
+        */
+        virtual void BeginUploadBatch();
+
+        /**
+        \brief Ends the batch of resource uploads that has been started with BeginUploadBatch, and submits all recorded upload commands without waiting for the GPU.
+        \see BeginUploadBatch
+        */
+        virtual void EndUploadBatch();
+
+        /* ----- Worker threads ----- */
+
+        /**
+        \brief Prepares the calling thread to create and upload resources concurrently to the render thread, e.g. to stream assets from a loader thread.
+        \return True if the calling thread is ready for resource uploads. Otherwise, resources must be created and uploaded on the render thread.
+        \remarks For OpenGL, this makes a worker context current on the calling thread, which shares all objects with the render contexts.
+        While a worker thread is attached, it can use the following functions: CreateBuffer (except for vertex buffers, since vertex array objects are not shared between GL contexts),
+        CreateTexture, WriteBuffer, MapBuffer, UnmapBuffer, WriteTexture, GenerateMips(Texture&), CreateFence, and CommandQueue::Submit(Fence&).
+        After the uploads have been issued, the worker thread submits a fence, and the render thread waits for that fence with CommandQueue::WaitFence before the resources are used.
+        Resources must still be released on the render thread with OpenGL.
+        At least one render context must have been created before a worker thread can be attached.
+        \remarks For Vulkan, this requires a dedicated transfer queue family and timeline fences (see RenderingFeatures::hasTimelineFences).
+        While a worker thread is attached, it can use CreateBuffer, CreateTexture, WriteBuffer, WriteTexture, CommandQueue::Submit(Fence&), and CommandQueue::Signal.
+        The uploads are recorded into a separate staging ring and submitted to the transfer queue, and every subsequent submission of the other queues waits for them on the GPU.
+        Resources must not be in use by the GPU while a worker thread writes into them.
+        \remarks For Direct3D 11, this requires native driver support for command lists, and creates a deferred context for the calling thread.
+        While a worker thread is attached, it can use CreateBuffer, CreateTexture, WriteBuffer (except for buffers with dynamic CPU access), WriteTexture, GenerateMips, CreateSampler, and CommandQueue::Submit(Fence&).
+        The uploads are executed by the render thread before its next submission and before it waits for a fence, and the fence must not be released until then.
+        \remarks For Direct3D 12, resource creation and uploads are synchronized internally, so this always succeeds and does nothing.
+        \remarks For Vulkan, Direct3D 11, and Direct3D 12, resources can also be released on worker threads, once they are no longer in use by the GPU or any other thread.
+        Other renderers do not support worker threads.
+        \see DetachWorkerThread
+        \see CommandQueue::Submit(Fence&)
+        \see CommandQueue::WaitFence
+        */
+        virtual bool AttachWorkerThread();
+
+        /**
+        \brief Releases the worker context of the calling thread, which has been attached with AttachWorkerThread.
+        \remarks This must be called on the same thread that attached itself, before that thread terminates.
+        \see AttachWorkerThread
+        */
+        virtual void DetachWorkerThread();
+
     protected:
 
         RenderSystem() = default;
@@ -485,6 +1040,16 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Sets the rendering capabilities.
         void SetRenderingCaps(const RenderingCapabilities& caps);
 
+        /**
+        \brief Sets a function that completes the rendering capabilities with the first call to GetRenderingCaps.
+        \remarks This allows to defer expensive queries that are not needed to initialize the render system.
+        The function is invoked at most once and must not call GetRenderingCaps or SetRenderingCaps.
+        */
+        void SetDeferredRenderingCaps(const std::function<void(RenderingCapabilities& caps)>& query);
+
+        //! Sets the descriptors of all available video adapters.
+        void SetVideoAdapters(const std::vector<VideoAdapterDescriptor>& videoAdapters);
+
         //! Validates the specified buffer descriptor to be used for buffer creation.
         void AssertCreateBuffer(const BufferDescriptor& desc, std::uint64_t maxSize);
 
@@ -500,15 +1065,28 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         //! Validates the specified image data size against the required size (in bytes).
         void AssertImageDataSize(std::size_t dataSize, std::size_t requiredDataSize, const char* info = nullptr);
 
+        //! Validates the specified output data size of a buffer readback against the required size (in bytes).
+        void AssertBufferReadbackDataSize(std::size_t dataSize, std::uint64_t requiredDataSize);
+
     private:
 
         int                         rendererID_ = 0;
         std::string                 name_;
 
         RendererInfo                info_;
-        RenderingCapabilities       caps_;
+
+        mutable RenderingCapabilities                               caps_;
+        mutable std::function<void(RenderingCapabilities& caps)>    capsQuery_;         // Deferred query of the rendering capabilities
+        mutable std::mutex                                          capsMutex_;
+        mutable std::atomic<bool>                                   capsDeferred_       { false };
         RenderSystemConfiguration   config_;
 
+        std::vector<VideoAdapterDescriptor> videoAdapters_;
+
+        Texture*                    uploadTexture_  = nullptr;  // Texture of the pending upload with the default implementation of BeginTextureUpload
+        SubTextureDescriptor        uploadRegion_;
+        std::vector<char>           uploadBuffer_;
+
 };
 
 
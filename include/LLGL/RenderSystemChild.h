@@ -10,14 +10,39 @@
 
 
 #include "NonCopyable.h"
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
-//! Base class for all interfaces whoes instances are owned by the RenderSystem.
-class LLGL_EXPORT RenderSystemChild : public NonCopyable { };
+/**
+\brief Base class for all interfaces whoes instances are owned by the RenderSystem.
+\remarks Instances are allocated with the host allocator of the render system (see RenderSystemDescriptor::allocator).
+*/
+class LLGL_EXPORT RenderSystemChild : public NonCopyable
+{
+
+    public:
+
+        //! Allocates the instance with the host allocator of the render system.
+        static void* operator new (std::size_t size);
+
+        //! Releases the instance with the host allocator it has been allocated with.
+        static void operator delete (void* ptr);
+
+        /**
+        \brief Sets the debug name of this object, which is shown in external GPU debuggers and profilers.
+        \param[in] name Pointer to a null-terminated string, or null to reset the name.
+        \remarks Buffers, textures, and samplers forward their name to \c vkSetDebugUtilsObjectNameEXT (Vulkan), \c WKPDID_D3DDebugObjectName (Direct3D),
+        \c glObjectLabel (OpenGL with \c GL_KHR_debug), or the \c label property (Metal, except for samplers), if LLGL was built with \c LLGL_ENABLE_DEBUG_MARKERS.
+        For all other objects this has no effect by default.
+        With the debug layer, the names of buffers and textures are also used to attribute their memory (see RenderSystem::QueryResourceMemoryReport).
+        */
+        virtual void SetName(const char* name);
+
+};
 
 
 } // /namespace LLGL
@@ -12,7 +12,9 @@
 #include "Export.h"
 #include "CommandBufferFlags.h"
 #include "TextureFlags.h"
+#include "RenderContextFlags.h"
 #include "Constants.h"
+#include "AllocatorInterface.h"
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -69,10 +71,13 @@ enum class ShadingLanguage
     HLSL_5_0        = (0x30000 | 500),  //!< HLSL 5.0 (since Direct3D 11).
     HLSL_5_1        = (0x30000 | 510),  //!< HLSL 5.1 (since Direct3D 12 and Direct3D 11.3).
 
-    Metal           = (0x40000),        //!< Metal Shading Language. \note Not supported yet
-    Metal_1_0       = (0x40000 | 100),  //!< Metal 1.0 (since iOS 8.0). \note Not supported yet
-    Metal_1_1       = (0x40000 | 110),  //!< Metal 1.1 (since iOS 9.0 and OS X 10.11). \note Not supported yet
-    Metal_1_2       = (0x40000 | 120),  //!< Metal 1.2 (since iOS 10.0 and macOS 10.12). \note Not supported yet
+    Metal           = (0x40000),        //!< Metal Shading Language.
+    Metal_1_0       = (0x40000 | 100),  //!< Metal 1.0 (since iOS 8.0).
+    Metal_1_1       = (0x40000 | 110),  //!< Metal 1.1 (since iOS 9.0 and OS X 10.11).
+    Metal_1_2       = (0x40000 | 120),  //!< Metal 1.2 (since iOS 10.0 and macOS 10.12).
+    Metal_2_0       = (0x40000 | 200),  //!< Metal 2.0 (since iOS 11.0 and macOS 10.13).
+    Metal_2_1       = (0x40000 | 210),  //!< Metal 2.1 (since iOS 12.0 and macOS 10.14).
+    Metal_2_2       = (0x40000 | 220),  //!< Metal 2.2 (since iOS 13.0 and macOS 10.15).
 
     SPIRV           = (0x50000),        //!< SPIR-V Shading Language.
     SPIRV_100       = (0x50000 | 100),  //!< SPIR-V 1.0.
@@ -123,6 +128,49 @@ enum class CPUAccess
     ReadWrite,  //!< CPU read and write access.
 };
 
+/**
+\brief Vulkan device memory sub-allocation strategies.
+\see VulkanRendererConfiguration::deviceMemoryAllocator
+*/
+enum class VulkanDeviceMemoryAllocator
+{
+    /**
+    \brief Linear search for free blocks within each device memory chunk.
+    \remarks This strategy can be tuned with VulkanRendererConfiguration::reduceDeviceMemoryFragmentation.
+    */
+    Linear,
+
+    /**
+    \brief Two-Level Segregated Fit (TLSF) allocator with constant time allocation and release of device memory regions.
+    \remarks This is recommended for applications that allocate a large number of small buffers.
+    */
+    TLSF,
+};
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Subgroup operation flags (also referred to as "wave operations" or "warp operations").
+\remarks These flags specify which classes of subgroup operations are supported in shaders,
+i.e. the GLSL functions of the \c GL_KHR_shader_subgroup_* extensions or the HLSL Shader Model 6 wave intrinsics.
+\see RenderingLimits::subgroupOperations
+*/
+struct SubgroupFlags
+{
+    enum
+    {
+        Basic           = (1 << 0), //!< Basic subgroup operations, e.g. \c subgroupElect and \c subgroupBarrier in GLSL or \c WaveIsFirstLane in HLSL.
+        Vote            = (1 << 1), //!< Vote operations, e.g. \c subgroupAll in GLSL or \c WaveActiveAllTrue in HLSL.
+        Arithmetic      = (1 << 2), //!< Arithmetic reductions and scans, e.g. \c subgroupAdd in GLSL or \c WavePrefixSum in HLSL.
+        Ballot          = (1 << 3), //!< Ballot and broadcast operations, e.g. \c subgroupBallot in GLSL or \c WaveActiveBallot in HLSL.
+        Shuffle         = (1 << 4), //!< Shuffle operations with arbitrary lane indices, e.g. \c subgroupShuffle in GLSL or \c WaveReadLaneAt in HLSL.
+        ShuffleRelative = (1 << 5), //!< Shuffle operations with relative lane indices, e.g. \c subgroupShuffleUp in GLSL.
+        Clustered       = (1 << 6), //!< Clustered reductions, e.g. \c subgroupClusteredAdd in GLSL.
+        Quad            = (1 << 7), //!< Quad operations, e.g. \c subgroupQuadBroadcast in GLSL or \c QuadReadAcrossX in HLSL.
+    };
+};
+
 
 /* ----- Structures ----- */
 
@@ -157,6 +205,51 @@ struct RenderSystemConfiguration
     \see Constants::maxThreadCount
     */
     std::size_t         threadCount         = Constants::maxThreadCount;
+
+    /**
+    \brief Specifies the directory of the on-disk shader cache. By default empty, which disables the shader cache.
+    \remarks If this is not empty, the compiled byte code of each shader that is created from source code
+    (i.e. ShaderSourceType::CodeString or ShaderSourceType::CodeFile) is stored in this directory,
+    and reused the next time a shader with the same source code, entry point, profile, and compile flags is created.
+    The directory must already exist. Cache entries that can not be read or written are silently ignored and the shader is compiled as usual.
+    \remarks For OpenGL, the linked binary of each shader program is cached instead (requires GL_ARB_get_program_binary),
+    keyed by the shader sources, vertex attributes, stream-output attributes, and the driver strings of the RendererInfo.
+    Shader compilation is then deferred until it is required, i.e. until Shader::HasErrors or Shader::QueryInfoLog is called,
+    or until the shader program can not be restored from the cache.
+    \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+    */
+    std::string         shaderCacheDirectory;
+
+    /**
+    \brief Specifies whether RenderSystem::GenerateMips uses a single-pass compute shader to generate the MIP-maps. By default false.
+    \remarks If this is true, the MIP levels are generated by a built-in compute shader that reduces up to twelve MIP levels with a single dispatch,
+    instead of one blit operation per MIP level. This is mainly beneficial for large textures, where the barriers between the MIP levels dominate.
+    Only 2D and 2D array textures with uncompressed, non-sRGB color formats are supported. All other textures are processed as usual.
+    \note Only supported with: OpenGL (requires GL_ARB_compute_shader, GL_ARB_shader_image_load_store, and GL_ARB_shader_storage_buffer_object).
+    */
+    bool                singlePassMipGeneration = false;
+
+    /**
+    \brief Specifies the size (in bytes) of the staging buffer that is used to stream texture data in RenderSystem::WriteTexture. By default 0.
+    \remarks If this is greater than zero, the image data is copied into a persistently mapped staging ring buffer,
+    from which the GPU copies the data into the texture asynchronously, instead of letting the driver copy the data synchronously.
+    The ring buffer is divided into four segments. Image data that is larger than a segment is uploaded directly.
+    A value of 0 disables the staging buffer.
+    \note Only supported with: OpenGL (requires GL_ARB_buffer_storage).
+    */
+    std::size_t         textureStagingBufferSize = 0;
+
+    /**
+    \brief Specifies whether the initial image data of textures is converted into the hardware texture format on the GPU. By default false.
+    \remarks If this is true, the initial image data of RenderSystem::CreateTexture is uploaded as it is and converted by a built-in compute shader,
+    instead of converting it on the CPU with ConvertImageBuffer. This reduces the upload size of 3-component images (e.g. ImageFormat::RGB into Format::RGBA8UNorm),
+    and avoids a temporary copy of the entire MIP chain on the CPU.
+    Only 2D, 2D array, and cube textures with 8-bit RGBA or BGRA formats (including sRGB) and source images with the data type DataType::UInt8 are supported.
+    Such textures are created with unordered access, which might reduce the sampling performance on some hardware. All other textures are processed as usual.
+    \note Only supported with: Direct3D 12.
+    \see ConvertImageBuffer
+    */
+    bool                gpuImageConversion = false;
 };
 
 /**
@@ -216,7 +309,7 @@ struct VulkanRendererConfiguration
     \brief Application descriptor used when a Vulkan debug or validation layer is enabled.
     \see ApplicationDescriptor
     */
-    ApplicationDescriptor   application;
+    ApplicationDescriptor       application;
 
     /**
     \brief Minimal allocation size for a device memory chunk. By default 1024*1024, i.e. 1 MB of VRAM.
@@ -224,7 +317,7 @@ struct VulkanRendererConfiguration
     This member specifies the minimum size used for hardware memory allocation of such a memory chunk.
     The Vulkan render system automatically manages sub-region allocation and defragmentation.
     */
-    std::uint64_t           minDeviceMemoryAllocationSize   = 1024*1024;
+    std::uint64_t               minDeviceMemoryAllocationSize   = 1024*1024;
 
     /**
     \brief Specifies whether fragmentation of the device memory blocks shall be kept low. By default false.
@@ -232,7 +325,86 @@ struct VulkanRendererConfiguration
     within a single VkDeviceMemory chunk (which might be potentially slower).
     Whenever a VkDeviceMemory chunk is full, the memory manager tries to reduce fragmentation anyways.
     */
-    bool                    reduceDeviceMemoryFragmentation = false;
+    bool                        reduceDeviceMemoryFragmentation = false;
+
+    /**
+    \brief Specifies the strategy for sub-allocations within device memory chunks. By default VulkanDeviceMemoryAllocator::Linear.
+    \remarks If this is VulkanDeviceMemoryAllocator::TLSF, the member \c reduceDeviceMemoryFragmentation is ignored.
+    \see VulkanDeviceMemoryAllocator
+    */
+    VulkanDeviceMemoryAllocator deviceMemoryAllocator           = VulkanDeviceMemoryAllocator::Linear;
+
+    /**
+    \brief Size (in bytes) of the persistently mapped staging ring buffer for resource uploads. By default 4*1024*1024, i.e. 4 MB.
+    \remarks Buffer and texture uploads are copied into this ring buffer and submitted asynchronously to the graphics queue.
+    Uploads that are larger than half of the ring buffer use a temporary staging buffer instead.
+    If this is zero, all uploads use temporary staging buffers.
+    */
+    std::uint64_t               stagingRingSize                 = 4*1024*1024;
+};
+
+/**
+\brief Structure for a Direct3D 12 renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct Direct3D12RendererConfiguration
+{
+    /**
+    \brief Number of frames the CPU can record ahead of the GPU for each render context. By default 2.
+    \remarks Each frame in flight has its own command allocator and fence value,
+    so the CPU only waits for the GPU when it wraps around to a frame that is still being executed.
+    This value is clamped to the range [1, 8].
+    */
+    std::uint32_t numFramesInFlight           = 2;
+
+    /**
+    \brief Size (in bytes) of the persistently mapped upload heap for buffer and texture updates. By default 4*1024*1024, i.e. 4 MB.
+    \remarks All updates are bump-allocated from this heap and recycled once the GPU has finished the respective copy commands.
+    Updates that are larger than half of the upload heap use a temporary upload buffer instead.
+    */
+    std::uint64_t uploadHeapSize              = 4*1024*1024;
+
+    /**
+    \brief Number of descriptors in the global shader-visible CBV/SRV/UAV descriptor heap. By default 65536.
+    \remarks Resource heaps are copied into this descriptor heap whenever they are bound to a command buffer,
+    so this limits the number of descriptors that can be bound within the frames in flight.
+    */
+    std::uint32_t numShaderVisibleDescriptors = 65536;
+};
+
+/**
+\brief Structure for a Metal renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct MetalRendererConfiguration
+{
+    /**
+    \brief Minimal size (in bytes) of each MTLHeap that GPU-only buffers and textures are sub-allocated from. By default 64*1024*1024, i.e. 64 MB.
+    \remarks Resources that are larger than this size get their own heap. If this is zero, all resources are allocated directly from the device.
+    */
+    std::uint64_t heapBlockSize = 64*1024*1024;
+};
+
+/**
+\brief Structure for an OpenGL renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct OpenGLRendererConfiguration
+{
+    /**
+    \brief Specifies whether the render system runs headless, i.e. without any window or display server. By default false.
+    \remarks If this is true, the render system creates its own offscreen GL context when it is loaded,
+    and command buffers can only render into render targets. Render contexts cannot be created in this mode.
+    On Linux, this requires a surfaceless EGL context, i.e. LLGL must be built with the \c LLGL_GL_ENABLE_EGL option.
+    Headless GL contexts are not supported on other platforms yet.
+    */
+    bool                    headless        = false;
+
+    /**
+    \brief OpenGL profile of the headless GL context. This is ignored if 'headless' is false.
+    \see ProfileOpenGLDescriptor
+    */
+    ProfileOpenGLDescriptor profileOpenGL;
 };
 
 /**
@@ -288,6 +460,8 @@ struct RenderSystemDescriptor
     \endcode
     \see rendererConfigSize
     \see VulkanRendererConfiguration
+    \see Direct3D12RendererConfiguration
+    \see OpenGLRendererConfiguration
     */
     const void* rendererConfig      = nullptr;
 
@@ -297,6 +471,49 @@ struct RenderSystemDescriptor
     \see rendererConfig
     */
     std::size_t rendererConfigSize  = 0;
+
+    /**
+    \brief Index of the video adapter (GPU) the render system is to be created for. By default 0xFFFFFFFF to select the default adapter.
+    \remarks The index refers to the list of video adapters returned by RenderSystem::GetVideoAdapters, which is in the same order for all processes.
+    If the index is out of range, the default adapter is selected.
+    The default adapter is the primary adapter for Direct3D, and the first discrete GPU (or the first suitable GPU if there is no discrete one) for Vulkan.
+    This is ignored by OpenGL, whose adapter is determined by the window system.
+    \see RenderSystem::GetVideoAdapters
+    \see adapterLUID
+    */
+    std::uint32_t adapterIndex      = ~0u;
+
+    /**
+    \brief Locally unique identifier (LUID) of the video adapter the render system is to be created for. By default 0.
+    \remarks If this is non-zero, it takes precedence over 'adapterIndex'. If no adapter has this LUID, the default adapter is selected.
+    This is only supported by Direct3D 11 and Direct3D 12.
+    \see VideoAdapterDescriptor::luid
+    */
+    std::uint64_t adapterLUID       = 0;
+
+    /**
+    \brief Filename of a binary trace the API calls are recorded into. By default empty.
+    \remarks If this is non-empty, the render system is wrapped by the debug layer (even without profiler and debugger),
+    which records the creation of all objects, the contents of all buffer and texture uploads, and the commands of all command buffers
+    into the specified file. The trace is finalized when the render system is unloaded.
+    A trace can be replayed on any renderer of the same platform with the CaptureReplay class, e.g. to compare the performance of the renderers.
+    This requires LLGL to be compiled with the debug layer (\c LLGL_ENABLE_DEBUG_LAYER).
+    \see CaptureReplay
+    */
+    std::string captureFilename;
+
+    /**
+    \brief Optional host memory allocator for the internal allocations of the render system. By default null.
+    \remarks If this is non-null, all interfaces that are owned by the render system (i.e. the render system itself and all instances of RenderSystemChild)
+    are allocated with this allocator, and the Vulkan renderer forwards it to the driver as \c VkAllocationCallbacks.
+    The allocator is process-wide: objects are allocated with the allocator of the most recently loaded render system,
+    but each object is always released with the allocator it has been allocated with.
+    The allocator must therefore outlive all render systems that have been loaded with it.
+    All Vulkan render systems of the process must use the same allocator, since the driver requires objects to be destroyed with the callbacks they have been created with.
+    Internal containers of the renderers still use the standard allocator.
+    \see AllocatorInterface
+    */
+    AllocatorInterface* allocator   = nullptr;
 };
 
 /**
@@ -307,12 +524,20 @@ struct RenderingFeatures
 {
     /**
     \brief Specifies whether the render system supports extended command buffers with dynamic state access for shader resources.
-    \remarks This is only supported by older graphics APIs such as OpenGL and Direct3D 11.
+    \remarks This is supported by older graphics APIs such as OpenGL and Direct3D 11, and by Vulkan with transient descriptor sets.
     \see RenderSystem::CreateCommandBufferExt
     \see CommandBufferExt
     */
     bool hasCommandBufferExt            = false;
 
+    /**
+    \brief Specifies whether the render system supports secondary command buffers, which can be recorded on worker threads and executed by a primary command buffer.
+    \remarks This is only supported by modern graphics APIs such as Vulkan (secondary command buffers) and Direct3D 12 (bundles).
+    \see RenderSystem::CreateSecondaryCommandBuffer
+    \see CommandBuffer::ExecuteCommands
+    */
+    bool hasSecondaryCommandBuffers     = false;
+
     //! Specifies whether render targets (also "framebuffer objects") are supported.
     bool hasRenderTargets               = false;
 
@@ -348,6 +573,25 @@ struct RenderingFeatures
     */
     bool hasMultiSampleTextures         = false;
 
+    /**
+    \brief Specifies whether block-compressed texture formats of the BC family (BC1-BC7, also "S3TC", "RGTC", and "BPTC") are supported.
+    \remarks Individual formats might still be unsupported, which are then not listed in RenderingCapabilities::textureFormats.
+    \see IsCompressedFormatBC
+    */
+    bool hasTextureCompressionBC        = false;
+
+    /**
+    \brief Specifies whether block-compressed texture formats of the ETC2 and EAC family are supported.
+    \see IsCompressedFormatETC2
+    */
+    bool hasTextureCompressionETC2      = false;
+
+    /**
+    \brief Specifies whether block-compressed texture formats of the ASTC family (LDR profile) are supported.
+    \see IsCompressedFormatASTC
+    */
+    bool hasTextureCompressionASTC      = false;
+
     //! Specifies whether samplers are supported.
     bool hasSamplers                    = false;
 
@@ -393,6 +637,23 @@ struct RenderingFeatures
     */
     bool hasOffsetInstancing            = false;
 
+    /**
+    \brief Specifies whether indirect draw and dispatch commands are supported.
+    \see CommandBuffer::DrawIndirect
+    \see CommandBuffer::DrawIndexedIndirect
+    \see CommandBuffer::DispatchIndirect
+    \see BufferFlags::IndirectArguments
+    */
+    bool hasIndirectDrawing             = false;
+
+    /**
+    \brief Specifies whether indirect command layouts are supported, i.e. indirect commands that change vertex buffers and constants per draw.
+    \remarks For Vulkan, only layouts with a single draw argument are supported, and a count buffer requires the \c VK_KHR_draw_indirect_count extension.
+    \see RenderSystem::CreateIndirectCommandLayout
+    \see CommandBuffer::ExecuteIndirect
+    */
+    bool hasIndirectCommandLayouts      = false;
+
     /**
     \brief Specifies whether multiple viewports, depth-ranges, and scissors at once are supported.
     \see RenderingLimits::maxNumViewports
@@ -405,6 +666,29 @@ struct RenderingFeatures
     */
     bool hasConservativeRasterization   = false;
 
+    /**
+    \brief Specifies whether the depth bounds test is supported.
+    \see DepthDescriptor::boundsTestEnabled
+    \see CommandBuffer::SetDepthBounds
+    */
+    bool hasDepthBoundsTest             = false;
+
+    /**
+    \brief Specifies whether mesh shader pipelines are supported, i.e. amplification and mesh shaders that replace the input assembler and all vertex processing stages.
+    \remarks For OpenGL, this requires the \c GL_NV_mesh_shader extension and for Vulkan, the \c VK_EXT_mesh_shader extension.
+    \see ShaderProgramDescriptor::meshShader
+    \see CommandBuffer::DrawMeshTasks
+    */
+    bool hasMeshShaders                 = false;
+
+    /**
+    \brief Specifies whether acceleration structures and inline ray queries in compute and fragment shaders are supported.
+    \remarks For Direct3D 12, this requires DXR tier 1.1 and for Vulkan, the \c VK_KHR_acceleration_structure and \c VK_KHR_ray_query extensions.
+    \see RenderSystem::CreateAccelerationStructure
+    \see CommandBuffer::BuildAccelerationStructures
+    */
+    bool hasRayQueries                  = false;
+
     /**
     \brief Specifies whether stream-output is supported.
     \see ShaderSource::streamOutput
@@ -418,6 +702,113 @@ struct RenderingFeatures
     \see BlendDescriptor::logicOp
     */
     bool hasLogicOp                     = false;
+
+    /**
+    \brief Specifies whether arrays of resources can be indexed dynamically in shaders, i.e. whether bindless bindings are natively supported.
+    \remarks If this is false, bindless bindings are emulated with consecutive binding slots and the number of resources is limited by the binding slots of the shader stage.
+    \see BindingFlags::Bindless
+    */
+    bool hasBindlessResources           = false;
+
+    /**
+    \brief Specifies whether constant buffers can be bound with dynamic offsets through a resource heap or with CommandBufferExt::SetConstantBufferRange.
+    \remarks This is false for Direct3D 11.0 and for Direct3D 11.1 drivers without constant buffer offsetting,
+    in which case the offsets are ignored and the entire buffers are bound.
+    \see BindingFlags::DynamicOffset
+    \see CommandBufferExt::SetConstantBufferRange
+    */
+    bool hasDynamicOffsets              = false;
+
+    /**
+    \brief Specifies whether immutable samplers can be baked into pipeline layouts.
+    \see PipelineLayoutDescriptor::staticSamplers
+    */
+    bool hasStaticSamplers              = false;
+
+    /**
+    \brief Specifies whether sparse textures are supported, i.e. textures whose memory is committed tile by tile.
+    \see TextureFlags::Sparse
+    \see RenderSystem::CommitTextureTiles
+    */
+    bool hasSparseTextures              = false;
+
+    /**
+    \brief Specifies whether texture views can be created, i.e. textures that share the memory of another texture.
+    \see RenderSystem::CreateTextureView
+    \see TextureFlags::MutableFormat
+    */
+    bool hasTextureViews                = false;
+
+    /**
+    \brief Specifies whether the sampling of a texture can be clamped to a minimum MIP-map level, e.g. to stream the higher MIP-map levels of a texture incrementally.
+    \see RenderSystem::SetTextureMinLOD
+    \see TextureStreamer
+    */
+    bool hasTextureMinLOD               = false;
+
+    /**
+    \brief Specifies whether fences can be used as 64-bit timeline fences.
+    \remarks For Vulkan, this requires the VK_KHR_timeline_semaphore extension. For OpenGL, this requires GL_ARB_sync.
+    \see CommandQueue::Signal
+    \see CommandQueue::Wait
+    \see CommandQueue::WaitFenceValue
+    */
+    bool hasTimelineFences              = false;
+
+    /**
+    \brief Specifies whether a dedicated compute queue is supported, whose commands can be executed asynchronously to the graphics queue.
+    \remarks For Vulkan, this requires a queue family with compute but without graphics capabilities, and the VK_KHR_timeline_semaphore extension.
+    \see RenderSystem::GetCommandQueue(const QueueType)
+    \see CommandBufferDescriptor::queueType
+    */
+    bool hasComputeQueue                = false;
+
+    /**
+    \brief Specifies whether a background queue is supported, whose commands are executed with a lower priority than the graphics and compute queues.
+    \remarks For Vulkan, this requires a dedicated compute queue family with at least two queues; the background queue is the second queue of that family
+    and is created with the lowest queue priority. For Direct3D 12, the graphics and compute queues are created with high priority and the background queue with normal priority.
+    \see QueueType::Background
+    \see RenderSystem::GetCommandQueue(const QueueType)
+    */
+    bool hasBackgroundQueue             = false;
+
+    /**
+    \brief Specifies whether the shading rate can be changed per draw command (also referred to as "variable rate shading").
+    \remarks For Vulkan, this requires the VK_KHR_fragment_shading_rate extension with pipeline fragment shading rates.
+    For OpenGL, this requires the GL_NV_shading_rate_image extension. For Direct3D 12, this requires variable rate shading tier 1.
+    \see CommandBuffer::SetShadingRate
+    */
+    bool hasVariableRateShading         = false;
+
+    /**
+    \brief Specifies whether the coarse shading rates 2x4, 4x2, and 4x4 are supported.
+    \see ShadingRate
+    */
+    bool hasAdditionalShadingRates      = false;
+
+    /**
+    \brief Specifies whether the shading rate can be specified per tile of the render target with a shading rate image.
+    \remarks For OpenGL, this requires the GL_NV_shading_rate_image extension. For Direct3D 12, this requires variable rate shading tier 2.
+    \see CommandBuffer::SetShadingRateImage
+    */
+    bool hasShadingRateImage            = false;
+
+    /**
+    \brief Specifies whether multiview rendering is supported, i.e. a single draw command can render into multiple array layers (e.g. for stereo rendering).
+    \remarks For Vulkan, this requires the VK_KHR_multiview extension. For OpenGL, this requires the GL_OVR_multiview2 extension.
+    \see RenderTargetDescriptor::numViews
+    \see GraphicsPipelineDescriptor::viewMask
+    */
+    bool hasMultiView                   = false;
+
+    /**
+    \brief Specifies whether subgroup operations are supported in shaders (also referred to as "wave operations" or "warp operations").
+    \remarks For Vulkan, this requires a Vulkan 1.1 device. For OpenGL, this requires the GL_KHR_shader_subgroup extension.
+    For Direct3D 12, this requires Shader Model 6.0 wave intrinsics, which are only available in precompiled DXIL shaders.
+    \see RenderingLimits::minSubgroupSize
+    \see RenderingLimits::subgroupOperations
+    */
+    bool hasSubgroups                   = false;
 };
 
 /**
@@ -492,6 +883,19 @@ struct RenderingLimits
     //! Specifies the maximum work group size in a compute shader.
     std::uint32_t   maxComputeShaderWorkGroupSize[3]    = { 0, 0, 0 };
 
+    /**
+    \brief Specifies the maximum number of work groups for mesh tasks. This is 0 if mesh shaders are not supported.
+    \see CommandBuffer::DrawMeshTasks
+    \see RenderingFeatures::hasMeshShaders
+    */
+    std::uint32_t   maxMeshTaskWorkGroups[3]            = { 0, 0, 0 };
+
+    //! Specifies the maximum number of output vertices of a mesh shader work group. This is 0 if mesh shaders are not supported.
+    std::uint32_t   maxMeshOutputVertices               = 0;
+
+    //! Specifies the maximum number of output primitives of a mesh shader work group. This is 0 if mesh shaders are not supported.
+    std::uint32_t   maxMeshOutputPrimitives             = 0;
+
     /**
     \brief Specifies the maximum number of viewports and scissor rectangles. Most render systems have a maximum of 16.
     \see CommandBuffer::SetViewports
@@ -521,6 +925,63 @@ struct RenderingLimits
     \see BufferDescriptor::size
     */
     std::uint64_t   maxConstantBufferSize               = 0;
+
+    /**
+    \brief Specifies the maximum size (in bytes) of the constants that can be declared in a pipeline layout.
+    \remarks This is at least 128 for all render systems.
+    \see ConstantsDescriptor::size
+    \see CommandBuffer::SetConstants
+    */
+    std::uint32_t   maxConstantsSize                    = 0;
+
+    /**
+    \brief Specifies the required alignment (in bytes) of the dynamic offsets for constant buffers.
+    \remarks This is 256 for Direct3D 11 and Direct3D 12.
+    \see CommandBuffer::SetGraphicsResourceHeap
+    \see BindingFlags::DynamicOffset
+    */
+    std::uint32_t   constantBufferOffsetAlignment       = 0;
+
+    /**
+    \brief Specifies the width and height (in pixels) of the tile that is covered by a single texel of a shading rate image.
+    \remarks This is 0 if shading rate images are not supported.
+    \see CommandBuffer::SetShadingRateImage
+    \see RenderingFeatures::hasShadingRateImage
+    */
+    std::uint32_t   shadingRateImageTileSize            = 0;
+
+    /**
+    \brief Specifies the maximum number of views for multiview rendering.
+    \remarks This is 0 if multiview rendering is not supported.
+    \see RenderTargetDescriptor::numViews
+    \see RenderingFeatures::hasMultiView
+    */
+    std::uint32_t   maxNumViews                         = 0;
+
+    /**
+    \brief Specifies the minimum number of invocations per subgroup. This is 0 if subgroups are not supported.
+    \remarks Only Direct3D 12 reports a range of subgroup sizes. For all other render systems, this is equal to 'maxSubgroupSize'.
+    \see RenderingFeatures::hasSubgroups
+    */
+    std::uint32_t   minSubgroupSize                     = 0;
+
+    /**
+    \brief Specifies the maximum number of invocations per subgroup. This is 0 if subgroups are not supported.
+    \see RenderingFeatures::hasSubgroups
+    */
+    std::uint32_t   maxSubgroupSize                     = 0;
+
+    /**
+    \brief Specifies the shader stages in which subgroup operations are supported. This can be a bitwise OR combination of the StageFlags entries.
+    \see StageFlags
+    */
+    long            subgroupStageFlags                  = 0;
+
+    /**
+    \brief Specifies the classes of subgroup operations that are supported. This can be a bitwise OR combination of the SubgroupFlags entries.
+    \see SubgroupFlags
+    */
+    long            subgroupOperations                  = 0;
 };
 
 /**
@@ -81,6 +81,15 @@ class LLGL_EXPORT RenderTarget : public RenderSystemChild
         */
         void ValidateMipResolution(const Texture& texture, std::uint32_t mipLevel);
 
+        /**
+        \brief Validates the array layers of all attachments for layered rendering.
+        \return Number of array layers that are attached for layered rendering, or 1 if the render target is not layered.
+        \throws std::invalid_argument If the array layers of an attachment exceed its texture,
+        or if a layered render target has an attachment without texture, attachments with different number of array layers, or multiple views.
+        \see AttachmentDescriptor::numArrayLayers
+        */
+        std::uint32_t ValidateAttachmentLayers(const RenderTargetDescriptor& desc);
+
     private:
 
         Extent2D resolution_;
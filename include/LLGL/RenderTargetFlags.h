@@ -72,6 +72,8 @@ struct AttachmentDescriptor
     \brief Pointer to the texture which is to be used as target output. By default null.
     \remarks If this is null, the attribute 'type' must not be AttachmentType::Color.
     The texture must also have been created with the flag 'TextureFlags::AttachmentUsage'.
+    For depth-stencil attachments, the texture must have a depth-stencil format (e.g. Format::D32Float),
+    and it can be sampled after the render pass without copying it, if it was also created with the flag 'TextureFlags::SampleUsage'.
     \see AttachmentDescriptor::type
     \see TextureFlags::AttachmentUsage
     */
@@ -94,6 +96,22 @@ struct AttachmentDescriptor
     \see TextureDescriptor::arrayLayer
     */
     std::uint32_t   arrayLayer  = 0;
+
+    /**
+    \brief Specifies the number of array layers, starting at 'arrayLayer', which are attached for layered rendering. By default 1.
+    \remarks If this is greater than 1, the attachment is layered and each primitive is rendered into the array layer
+    that is selected by the vertex or geometry shader (i.e. \c SV_RenderTargetArrayIndex in HLSL, or \c gl_Layer in GLSL).
+    Combined with instancing, this allows to render all cascades of a shadow map, or all faces of a cube map, with a single draw command.
+    For 3D textures, this specifies the number of depth slices instead.
+    All attachments of a layered render target must refer to a texture and have the same number of array layers,
+    and layered rendering cannot be combined with multiview rendering (see RenderTargetDescriptor::numViews).
+    Selecting the layer in the vertex shader requires Direct3D 11.3 or the Vulkan device extension \c VK_EXT_shader_viewport_index_layer,
+    otherwise a geometry shader must be used.
+    \note For OpenGL, layered attachments always bind all array layers of their texture, so 'arrayLayer' must be 0.
+    For Vulkan, depth slices of 3D textures cannot be attached as layers.
+    \note Not supported with: Direct3D 12.
+    */
+    std::uint32_t   numArrayLayers  = 1;
 };
 
 /**
@@ -137,6 +155,21 @@ struct RenderTargetDescriptor
     */
     bool                                customMultiSampling = false;
 
+    /**
+    \brief Number of views for multiview rendering (also referred to as "single-pass stereo rendering"). By default 0.
+    \remarks If this is greater than 1, each draw command is broadcast to all views, and the shaders can read the index of the current view
+    (i.e. \c gl_ViewIndex in Vulkan GLSL, or \c gl_ViewID_OVR in OpenGL GLSL).
+    Each view renders into another array layer of the attachments, starting at AttachmentDescriptor::arrayLayer,
+    so all attachments must refer to a texture of type TextureType::Texture2DArray with at least that many array layers.
+    Values of 0 and 1 both disable multiview rendering.
+    For OpenGL, this requires the GL_OVR_multiview2 extension and is not supported in combination with multi-sampling.
+    \note Only supported with: Vulkan, OpenGL.
+    \see GraphicsPipelineDescriptor::viewMask
+    \see RenderingFeatures::hasMultiView
+    \see RenderingLimits::maxNumViews
+    */
+    std::uint32_t                       numViews            = 0;
+
     /**
     \brief Specifies all render target attachment descriptors.
     \remarks This container can also be empty, if the respective fragment shader has no direct output but writes into a storage texture instead
@@ -12,6 +12,8 @@
 #include "Export.h"
 #include <map>
 #include <string>
+#include <atomic>
+#include <cstdint>
 
 
 namespace LLGL
@@ -33,21 +35,48 @@ enum class WarningType
     ImproperArgument,   //!< Warning due to improper argument (e.g. generating 4 vertices while having triangle list as primitive topology).
     ImproperState,      //!< Warning due to improper state (e.g. rendering while viewport is not visible).
     PointlessOperation, //!< Warning due to a operation without any effect (e.g. drawing with 0 vertices).
+    Performance,        //!< Warning due to a valid but inefficient usage (e.g. binding the same graphics pipeline twice in a row). Each kind of performance warning is posted with the same message, so it is summarized once per frame.
 };
 
 
+/**
+\brief Sampling configuration of the debug layer validation, to reduce its overhead (e.g. in soak-test builds).
+\remarks Cheap checks (e.g. whether a pipeline or a vertex buffer is bound) are always performed.
+Expensive checks of draw commands (e.g. vertex layout, vertex limits, and indirect arguments) are only performed for the sampled draw commands.
+A draw command is sampled if it is selected by 'drawInterval' and its combination of graphics pipeline and resource heap
+has not been validated 'maxStateValidations' times yet. By default, every draw command is fully validated.
+\see RenderingDebugger::SetValidationSampling
+*/
+struct ValidationSamplingDescriptor
+{
+    //! Only every N-th draw command (per command buffer) is fully validated. By default 1, i.e. all draw commands are validated. A value of 0 is treated as 1.
+    std::uint32_t drawInterval          = 1;
+
+    //! Maximal number of full validations for each unique combination of graphics pipeline and resource heap. By default 0, which means unlimited.
+    std::uint32_t maxStateValidations   = 0;
+};
+
 /**
 \brief Rendering debugger interface.
 \remarks This can be used to profile the renderer draw calls and buffer updates.
+Messages can be posted from multiple threads simultaneously (e.g. while command buffers are recorded in parallel) without any lock:
+each thread posts into its own buffer, where repeated messages only increment an occurrence counter.
+All buffers are merged when the messages are flushed, which the debug layer does on RenderContext::Present.
+Only then the callbacks OnError and OnWarning are invoked, from the thread that flushes the messages.
+\see FlushMessages
 */
 class LLGL_EXPORT RenderingDebugger
 {
 
     public:
 
+        RenderingDebugger();
         virtual ~RenderingDebugger();
 
-        //! Sets the new source function name.
+        RenderingDebugger(const RenderingDebugger&) = delete;
+        RenderingDebugger& operator = (const RenderingDebugger&) = delete;
+
+        //! Sets the new source function name for the calling thread. The string must remain valid until the messages have been flushed.
         void SetSource(const char* source);
 
         /**
@@ -66,6 +95,27 @@ class LLGL_EXPORT RenderingDebugger
         */
         void PostWarning(const WarningType type, const std::string& message);
 
+        /**
+        \brief Merges the messages that have been posted by all threads since the previous flush and invokes the callbacks OnError and OnWarning.
+        \remarks Each distinct message invokes its callback at most once per flush, and Message::GetOccurrences includes all occurrences of all threads.
+        Messages that have been blocked are no longer recorded by any thread. This must not be called from multiple threads simultaneously.
+        \see OnError
+        \see OnWarning
+        */
+        void FlushMessages();
+
+        /**
+        \brief Sets the sampling configuration of the debug layer validation. This must not be called while command buffers are being recorded.
+        \see ValidationSamplingDescriptor
+        */
+        void SetValidationSampling(const ValidationSamplingDescriptor& desc);
+
+        //! Returns the sampling configuration of the debug layer validation.
+        inline const ValidationSamplingDescriptor& GetValidationSampling() const
+        {
+            return validationSampling_;
+        }
+
     protected:
 
         //! Rendering debugger message class.
@@ -114,7 +164,7 @@ class LLGL_EXPORT RenderingDebugger
 
                 friend class RenderingDebugger;
 
-                void IncOccurrence();
+                void IncOccurrence(std::size_t count = 1);
 
             private:
 
@@ -132,7 +182,7 @@ class LLGL_EXPORT RenderingDebugger
         \code
         class MyDebugger : public LLGL::RenderingDebugger {
             void OnError(ErrorType type, Message& message) override {
-                LLGL::Log::StdErr() << "ERROR (" << LLGL::ToString(type) << "): in '" << message.GetSource() << "': " << message.GetText() << std::endl;
+                LLGL_LOG(Error, std::string("ERROR (") + LLGL::ToString(type) + "): in '" + message.GetSource() + "': " + message.GetText());
                 message.Block();
             }
         };
@@ -151,9 +201,18 @@ class LLGL_EXPORT RenderingDebugger
 
     private:
 
+        struct ThreadBuffer;
+
+        // Returns the message buffer of the calling thread.
+        ThreadBuffer& GetThreadBuffer();
+
         std::map<std::string, Message>  errors_;
         std::map<std::string, Message>  warnings_;
-        const char*                     source_     = "";
+
+        std::uint64_t                   id_             = 0;
+        std::atomic<ThreadBuffer*>      threadBuffers_;
+
+        ValidationSamplingDescriptor    validationSampling_;
 
 };
 
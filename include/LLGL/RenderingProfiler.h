@@ -12,7 +12,12 @@
 #include "Export.h"
 #include "RenderContextFlags.h"
 #include "GraphicsPipelineFlags.h"
+#include "QueryFlags.h"
+#include "RenderingStatistics.h"
 #include <cstdint>
+#include <string>
+#include <deque>
+#include <iosfwd>
 
 
 namespace LLGL
@@ -72,6 +77,38 @@ class LLGL_EXPORT RenderingProfiler
 
         };
 
+        /**
+        \brief Profiling event of a single frame.
+        \remarks CPU events are recorded by the debug layer for each command buffer and render system function (if the event log is enabled).
+        GPU events are recorded from the timer scopes of CommandBuffer::QueryTimerScopes. If the GPU timestamps can be calibrated (see RenderSystem::QueryTimestampCalibration),
+        their start time is the absolute begin time of the timer scope in the CPU timeline. Otherwise, their start time is reconstructed by placing root scopes back-to-back
+        (beginning at the start of the frame in which they have been queried) and child scopes back-to-back within their parent scope.
+        Display events are recorded from the frame statistics of RenderContext::QueryFrameStatistics. They start when a frame reached the display and last for one refresh cycle.
+        \see RenderingProfiler::EnableEventLog
+        */
+        struct Event
+        {
+            std::string     name;               //!< Event name, e.g. the command buffer function or the timer scope name.
+            const char*     category    = "";   //!< Event category, e.g. "Draw" or "Binding". This must point to a static string.
+            std::uint64_t   startTime   = 0;    //!< Start time (in nanoseconds) relative to the creation of the profiler.
+            std::uint64_t   duration    = 0;    //!< Duration (in nanoseconds).
+            std::uint64_t   frame       = 0;    //!< Zero-based index of the frame in which the event has been recorded.
+            std::uint32_t   depth       = 0;    //!< Nesting depth of GPU events. This is always zero for CPU events.
+            bool            gpu         = false;//!< Specifies whether this is a GPU event (from timer scopes) or a CPU event.
+            bool            display     = false;//!< Specifies whether this is a display event (from frame statistics). This is never true for GPU events.
+
+            /**
+            \brief Pipeline statistics of a GPU event. Only valid if 'hasStatistics' is true.
+            \see TimerScope::statistics
+            */
+            QueryPipelineStatistics statistics;
+
+            //! Specifies whether 'statistics' is valid. This is only true for GPU events of command buffers with CommandBufferFlags::TimerScopeStatistics.
+            bool            hasStatistics = false;
+        };
+
+        RenderingProfiler();
+
         /**
         \brief Resets all counters.
         \see Counter::Reset
@@ -81,6 +118,76 @@ class LLGL_EXPORT RenderingProfiler
         void RecordDrawCall(const PrimitiveTopology topology, Counter::ValueType numVertices);
         void RecordDrawCall(const PrimitiveTopology topology, Counter::ValueType numVertices, Counter::ValueType numInstances);
 
+        /**
+        \brief Enables or disables the event log. By default disabled.
+        \remarks The event log keeps the events of the last 'maxEventLogFrames' frames.
+        \see WriteTrace
+        */
+        void EnableEventLog(bool enable);
+
+        //! Returns true if the event log is enabled.
+        inline bool IsEventLogEnabled() const
+        {
+            return eventLogEnabled_;
+        }
+
+        //! Returns the current CPU timestamp (in nanoseconds) relative to the creation of the profiler.
+        std::uint64_t GetTimestamp() const;
+
+        //! Records a CPU event for the current frame with the specified start and end timestamps. This has no effect if the event log is disabled.
+        void RecordEvent(const char* name, const char* category, std::uint64_t startTime, std::uint64_t endTime);
+
+        /**
+        \brief Records the timer scopes of the specified frame as GPU events for the current frame. This has no effect if the event log is disabled.
+        \param[in] timerScopeFrame Specifies the timer scopes that have been queried with CommandBuffer::QueryTimerScopes.
+        \param[in] calibration Optional pointer to a timestamp calibration, which converts the begin timestamps of the timer scopes into the CPU timeline.
+        If this is null, the start times of the GPU events are reconstructed from their elapsed times.
+        \see RenderSystem::QueryTimestampCalibration
+        */
+        void RecordTimerScopes(const TimerScopeFrame& timerScopeFrame, const TimestampCalibration* calibration = nullptr);
+
+        /**
+        \brief Records a display event for the most recent frame that reached the display. This has no effect if the event log is disabled.
+        \remarks Each present ID is only recorded once, and the missed vertical blanks are written with the counters of the current frame.
+        \see RenderContext::QueryFrameStatistics
+        */
+        void RecordFrameStatistics(const FrameStatistics& frameStats);
+
+        //! Begins a new frame and discards all events that are older than 'maxEventLogFrames' frames. This is called by the debug layer on RenderContext::Present.
+        void NextFrame();
+
+        //! Returns the zero-based index of the current frame.
+        inline std::uint64_t GetFrame() const
+        {
+            return frame_;
+        }
+
+        //! Discards all recorded events.
+        void ClearEvents();
+
+        //! Returns all recorded events in the order they have been recorded.
+        inline const std::deque<Event>& GetEvents() const
+        {
+            return events_;
+        }
+
+        /**
+        \brief Writes all recorded events to the specified stream in the Chrome trace event format (JSON).
+        \remarks The output can be viewed with "chrome://tracing" or Perfetto, and it can be converted for the Tracy profiler with its "import-chrome" tool.
+        CPU, GPU, and display events are written to separate tracks, and the counters of this profiler are written as counter events per frame.
+        */
+        void WriteTrace(std::ostream& stream) const;
+
+        /**
+        \brief Writes all recorded events to the specified file in the Chrome trace event format (JSON).
+        \throws std::runtime_error If the file could not be created.
+        \see WriteTrace
+        */
+        void WriteTraceFile(const std::string& filename) const;
+
+        //! Maximal number of frames the event log keeps. By default 120.
+        std::uint64_t maxEventLogFrames = 120;
+
         Counter writeBuffer;            //!< Counter for buffer writings. \see RenderSystem::WriteBuffer
         Counter mapBuffer;              //!< Counter for buffer mappings. \see RenderSystem::MapBuffer
 
@@ -110,6 +217,30 @@ class LLGL_EXPORT RenderingProfiler
         Counter renderedTriangles;      //!< Counter for rendered triangle primitives.
         Counter renderedPatches;        //!< Counter for rendered patch primitives.
 
+    private:
+
+        // Counter values of a finished frame, which are written as counter events.
+        struct FrameCounters
+        {
+            std::uint64_t       frame           = 0;
+            std::uint64_t       endTime         = 0;
+            Counter::ValueType  drawCalls       = 0;
+            Counter::ValueType  triangles       = 0;
+            Counter::ValueType  bindings        = 0;
+            std::uint64_t       missedVblanks   = 0;
+        };
+
+        Counter::ValueType GetNumBindings() const;
+
+        bool                        eventLogEnabled_    = false;
+        std::uint64_t               epoch_              = 0;
+        std::uint64_t               frame_              = 0;
+        std::uint64_t               frameStartTime_     = 0;
+        std::uint64_t               lastPresentID_      = 0;
+        std::uint64_t               missedVblanks_      = 0;
+        std::deque<Event>           events_;
+        std::deque<FrameCounters>   frameCounters_;
+
 };
 
 
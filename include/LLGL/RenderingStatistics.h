@@ -0,0 +1,160 @@
+/*
+ * RenderingStatistics.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDERING_STATISTICS_H
+#define LLGL_RENDERING_STATISTICS_H
+
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Lightweight rendering statistics of a render system.
+\remarks In contrast to the RenderingProfiler, these statistics do not require the debug layer and have no validation cost.
+They are counted by the command buffers and the render system of each backend itself,
+but only if LLGL was compiled with the "LLGL_ENABLE_STATISTICS" flag. Otherwise, all values remain zero.
+Commands are counted when they are recorded, except for deferred OpenGL command buffers, whose commands are counted when they are submitted.
+\see RenderSystem::QueryStatistics
+\see RenderingProfiler
+*/
+struct RenderingStatistics
+{
+    //! Number of draw commands, including indirect draw commands.
+    std::uint64_t drawCalls         = 0;
+
+    //! Number of compute dispatch commands, including indirect dispatch commands.
+    std::uint64_t dispatchCalls     = 0;
+
+    //! Number of resource bindings, i.e. vertex, index, constant, storage, and stream-output buffers, textures, samplers, and resource heaps.
+    std::uint64_t resourceBindings  = 0;
+
+    //! Number of pipeline state changes, i.e. graphics and compute pipeline bindings.
+    std::uint64_t pipelineBindings  = 0;
+
+    //! Number of render target changes, i.e. render passes and render target bindings.
+    std::uint64_t renderPasses      = 0;
+
+    //! Number of bytes uploaded to GPU resources with RenderSystem::WriteBuffer and RenderSystem::WriteTexture.
+    std::uint64_t bytesUploaded     = 0;
+};
+
+/**
+\brief Memory statistics of a single GPU memory heap.
+\remarks All sizes are specified in bytes, and each value is zero if the backend cannot determine it.
+\see MemoryStatistics
+*/
+struct MemoryHeapStatistics
+{
+    //! Specifies whether this heap is local to the GPU (i.e. video memory). Otherwise, it is system memory that is accessible by the GPU.
+    bool            deviceLocal     = false;
+
+    //! Total size of this heap.
+    std::uint64_t   size            = 0;
+
+    /**
+    \brief Size of all GPU memory allocations that have been made by the render system from this heap.
+    \remarks With Direct3D, where each resource is a committed resource with its own allocation, this is the same as \c usage.
+    */
+    std::uint64_t   allocatedBytes  = 0;
+
+    //! Size of the allocated memory that is in use by resources. This is less than or equal to \c allocatedBytes.
+    std::uint64_t   usedBytes       = 0;
+
+    /**
+    \brief Memory budget of this heap, which the operating system grants the current process.
+    \remarks If the process exceeds this budget, the operating system may page out resources, which causes unpredictable stalls.
+    Applications should size their resource caches (e.g. for texture streaming) against this value.
+    */
+    std::uint64_t   budget          = 0;
+
+    //! Size of the memory of this heap that is currently in use by the process, as reported by the operating system.
+    std::uint64_t   usage           = 0;
+};
+
+/**
+\brief GPU memory statistics of a render system.
+\see RenderSystem::QueryMemoryStatistics
+*/
+struct MemoryStatistics
+{
+    //! List of all memory heaps. Only the first heap is guaranteed to be device local.
+    std::vector<MemoryHeapStatistics> heaps;
+};
+
+/**
+\brief Memory of all resources whose debug names share the same prefix.
+\see ResourceMemoryReport
+*/
+struct ResourceMemoryEntry
+{
+    //! Prefix of the debug names (see RenderSystemChild::SetName). This is empty for all resources without a name.
+    std::string     prefix;
+
+    //! Number of buffers with this name prefix.
+    std::uint32_t   numBuffers      = 0;
+
+    //! Number of textures with this name prefix. Texture views are not counted, since they share the memory of another texture.
+    std::uint32_t   numTextures     = 0;
+
+    /**
+    \brief Allocated bytes of all buffers and textures with this name prefix.
+    \remarks This is the size of the resources as described on creation (for textures all MIP-map levels, array layers, and samples),
+    i.e. it does not include the alignment and padding the driver may add to each allocation.
+    */
+    std::uint64_t   allocatedBytes  = 0;
+};
+
+/**
+\brief Memory of all resources, aggregated by the prefix of their debug names.
+\see RenderSystem::QueryResourceMemoryReport
+*/
+struct ResourceMemoryReport
+{
+    //! List of all name prefixes, sorted by their allocated bytes in descending order.
+    std::vector<ResourceMemoryEntry>    entries;
+
+    //! Allocated bytes of all buffers and textures.
+    std::uint64_t                       totalAllocatedBytes = 0;
+};
+
+/**
+\brief Pair of CPU and GPU timestamps that have been sampled at the same moment, to correlate GPU timestamps with the CPU timeline.
+\remarks A GPU timestamp \c t is converted into CPU ticks with <code>cpuTimestamp + (t - gpuTimestamp) * Timer::GetTickFrequency() / gpuFrequency</code>.
+Since the GPU clock may drift against the CPU clock, the calibration should be repeated regularly (e.g. once per frame).
+\see RenderSystem::QueryTimestampCalibration
+\see TimerScope::beginTimestamp
+*/
+struct TimestampCalibration
+{
+    //! CPU timestamp in ticks of Timer::Tick.
+    std::uint64_t   cpuTimestamp    = 0;
+
+    //! GPU timestamp in the time domain of the timestamps the renderer writes for timer scopes and timestamp queries.
+    std::uint64_t   gpuTimestamp    = 0;
+
+    //! Frequency of the GPU timestamps, or rather 'ticks per second'.
+    std::uint64_t   gpuFrequency    = 0;
+
+    //! Maximum deviation (in nanoseconds) between the moments both timestamps have been sampled. Zero if unknown.
+    std::uint64_t   maxDeviation    = 0;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
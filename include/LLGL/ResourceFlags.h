@@ -74,6 +74,12 @@ enum class ResourceType
     \see Sampler
     */
     Sampler,
+
+    /**
+    \brief Acceleration structure resource for hardware ray queries.
+    \see AccelerationStructure
+    */
+    AccelerationStructure,
 };
 
 
@@ -68,7 +68,12 @@ struct ResourceHeapDescriptor
     //! Reference to the pipeline layout. This must not be null, when a resource heap is created.
     PipelineLayout*                     pipelineLayout = nullptr;
 
-    //! List of all resource view descriptors.
+    /**
+    \brief List of all resource view descriptors.
+    \remarks Each binding of the pipeline layout consumes one resource view, except for bindless bindings,
+    which consume as many consecutive resource views as the array size of the binding. None of the resource views must be null.
+    \see BindingFlags::Bindless
+    */
     std::vector<ResourceViewDescriptor> resourceViews;
 };
 
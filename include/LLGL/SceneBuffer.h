@@ -0,0 +1,171 @@
+/*
+ * SceneBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SCENE_BUFFER_H
+#define LLGL_SCENE_BUFFER_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "BufferFlags.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Buffer;
+
+/**
+\brief Scene buffer descriptor structure.
+\see SceneBuffer::SceneBuffer
+*/
+struct SceneBufferDescriptor
+{
+    /**
+    \brief Specifies the descriptor of the persistent GPU buffer (e.g. an instance vertex buffer or a structured storage buffer).
+    \remarks The buffer size must be a non-zero multiple of 'elementSize'.
+    The BufferFlags::DynamicUsage flag is ignored, since the buffer contents must persist across partial updates.
+    */
+    BufferDescriptor    buffer;
+
+    //! Specifies the size (in bytes) of each element (e.g. the size of one instance). This must be greater than zero. By default 0.
+    std::uint32_t       elementSize     = 0;
+
+    /**
+    \brief Specifies the maximal number of clean elements between two dirty ranges that are uploaded together with them. By default 4.
+    \remarks Merging nearby dirty ranges trades a few redundant bytes for fewer buffer updates.
+    */
+    std::uint32_t       mergeDistance   = 4;
+};
+
+/**
+\brief Persistent GPU buffer of scene elements (e.g. per-instance transforms), which only uploads the elements that have changed.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to replace a buffer that is rewritten entirely every frame, although only a few of its elements change.
+The elements are modified in a CPU shadow of the buffer, which tracks the dirty element ranges.
+Each call to Flush merges the dirty ranges and uploads only these ranges with RenderSystem::WriteBuffer,
+so the upload bandwidth scales with the number of changes instead of the size of the scene.
+\remarks For Vulkan and Direct3D 12, all ranges of one flush are copied through the staging memory of the render system
+and recorded into the same upload command buffer, i.e. they are submitted together.
+\code
+LLGL::SceneBufferDescriptor sceneDesc;
+sceneDesc.buffer.type   = LLGL::BufferType::Storage;
+sceneDesc.buffer.size   = sizeof(Instance) * numInstances;
+sceneDesc.elementSize   = sizeof(Instance);
+LLGL::SceneBuffer mySceneBuffer { *myRenderer, sceneDesc, myInstances.data() };
+
+// Each frame:
+for (auto i : myMovedInstances)
+    mySceneBuffer.WriteElements(i, 1, &myInstances[i]);
+mySceneBuffer.Flush();
+\endcode
+\see ConstantBufferAllocator
+*/
+class LLGL_EXPORT SceneBuffer : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs the scene buffer and creates its GPU buffer with the specified render system.
+        \param[in] renderSystem Specifies the render system to create the buffer with.
+        \param[in] desc Specifies the scene buffer descriptor.
+        \param[in] initialData Optional raw pointer to the initial data of all elements. If this is null, all elements are initialized with zeros.
+        \throws std::invalid_argument If 'desc.elementSize' is zero, or if 'desc.buffer.size' is zero or not a multiple of 'desc.elementSize'.
+        */
+        SceneBuffer(RenderSystem& renderSystem, const SceneBufferDescriptor& desc, const void* initialData = nullptr);
+
+        //! Releases the GPU buffer of this scene buffer.
+        ~SceneBuffer();
+
+        /**
+        \brief Copies the specified elements into the CPU shadow of the buffer and marks them as dirty.
+        \param[in] firstElement Specifies the index of the first element to write.
+        \param[in] numElements Specifies the number of elements to write.
+        \param[in] data Raw pointer to the new data of all elements, i.e. <code>numElements * GetElementSize()</code> bytes.
+        \remarks The elements are only written into the GPU buffer with the next call to Flush.
+        \throws std::out_of_range If the element range exceeds the number of elements.
+        */
+        void WriteElements(std::uint32_t firstElement, std::uint32_t numElements, const void* data);
+
+        /**
+        \brief Marks the specified elements as dirty and returns a pointer to them within the CPU shadow of the buffer.
+        \remarks This can be used to modify the elements in place. The pointer is valid for the lifetime of this scene buffer.
+        \throws std::out_of_range If the element range exceeds the number of elements.
+        */
+        void* MapElements(std::uint32_t firstElement, std::uint32_t numElements);
+
+        /**
+        \brief Uploads all dirty elements into the GPU buffer.
+        \return Number of bytes that have been uploaded, including the clean elements between merged dirty ranges.
+        \remarks This must be called before any command that reads the modified elements is executed.
+        \see RenderSystem::WriteBuffer
+        */
+        std::uint64_t Flush();
+
+        //! Returns the persistent GPU buffer of this scene buffer.
+        inline Buffer& GetBuffer() const
+        {
+            return *buffer_;
+        }
+
+        //! Returns the number of elements in this scene buffer.
+        inline std::uint32_t GetNumElements() const
+        {
+            return numElements_;
+        }
+
+        //! Returns the size (in bytes) of each element.
+        inline std::uint32_t GetElementSize() const
+        {
+            return elementSize_;
+        }
+
+        //! Returns true if any element has been modified since the last flush.
+        inline bool IsDirty() const
+        {
+            return !dirtyRanges_.empty();
+        }
+
+    private:
+
+        struct ElementRange
+        {
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+
+    private:
+
+        void MarkDirty(std::uint32_t firstElement, std::uint32_t numElements);
+
+    private:
+
+        RenderSystem&               renderSystem_;
+        Buffer*                     buffer_         = nullptr;
+        std::vector<char>           shadow_;
+        std::uint32_t               elementSize_    = 0;
+        std::uint32_t               numElements_    = 0;
+        std::uint32_t               mergeDistance_  = 0;
+        std::vector<ElementRange>   dirtyRanges_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
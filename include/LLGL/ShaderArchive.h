@@ -0,0 +1,169 @@
+/*
+ * ShaderArchive.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SHADER_ARCHIVE_H
+#define LLGL_SHADER_ARCHIVE_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "ShaderFlags.h"
+#include "RenderSystemFlags.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class MappedFile;
+
+/**
+\brief Shader archive entry descriptor structure, which describes a single shader blob to be written into a shader archive.
+\see ShaderArchive::Save
+*/
+struct ShaderArchiveEntry
+{
+    /**
+    \brief Specifies the key by which the shader is referenced in the archive (e.g. "Scene.Vertex").
+    \remarks Multiple entries can share the same key to provide the same shader in different shading languages (e.g. SPIR-V, DXBC, and GLSL).
+    */
+    std::string         key;
+
+    //! Specifies the type of the shader. By default ShaderType::Undefined.
+    ShaderType          type        = ShaderType::Undefined;
+
+    /**
+    \brief Specifies the shading language of the shader blob. By default ShadingLanguage::SPIRV.
+    \remarks This is compared against the shading languages that are supported by a renderer (see RenderingCapabilities::shadingLanguages).
+    For DXBC byte code, use the HLSL shading language together with ShaderSourceType::BinaryBuffer.
+    */
+    ShadingLanguage     language    = ShadingLanguage::SPIRV;
+
+    /**
+    \brief Specifies the type of the shader blob. This must be either ShaderSourceType::CodeString or ShaderSourceType::BinaryBuffer. By default ShaderSourceType::BinaryBuffer.
+    \remarks Code strings are stored with a null terminator, so they can be passed to a renderer without copying them.
+    */
+    ShaderSourceType    sourceType  = ShaderSourceType::BinaryBuffer;
+
+    //! Optional shader entry point (see ShaderDescriptor::entryPoint).
+    std::string         entryPoint;
+
+    //! Optional shader target profile (see ShaderDescriptor::profile).
+    std::string         profile;
+
+    //! Shader source code or binary code.
+    std::vector<char>   data;
+};
+
+/**
+\brief Utility class to load precompiled shaders from a single memory-mapped shader archive file.
+
+This class is not required for any interaction with the render system.
+It can be used as utility to load all shaders of an application with a single file open,
+instead of opening and reading one file per shader (e.g. with ShaderDescFromFile).
+Each shader is referenced by a key, and the same key can hold one blob per shading language,
+so that the same archive can be shared across all renderers.
+\remarks The archive file is memory-mapped and stays mapped for the lifetime of this object.
+All shader descriptors returned by GetShaderDesc point directly into the mapped file, i.e. the shader code is not copied.
+Therefore, the shader descriptors must no longer be used after this object has been destroyed or another file has been loaded.
+\code
+LLGL::ShaderArchive archive { "Shaders.llsa" };
+const auto& languages = myRenderer->GetRenderingCaps().shadingLanguages;
+auto myVertexShader = myRenderer->CreateShader(archive.GetShaderDesc("Scene.Vertex", languages));
+\endcode
+\see TextureContainer
+*/
+class LLGL_EXPORT ShaderArchive : public NonCopyable
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        ShaderArchive();
+
+        /**
+        \brief Constructor to load the specified shader archive file.
+        \see Load
+        */
+        ShaderArchive(const std::string& filename);
+
+        //! Move constructor which takes the ownership of the mapped file.
+        ShaderArchive(ShaderArchive&& rhs);
+
+        ~ShaderArchive();
+
+        /* ----- Operators ----- */
+
+        //! Move operator which takes the ownership of the mapped file.
+        ShaderArchive& operator = (ShaderArchive&& rhs);
+
+        /* ----- Storage ----- */
+
+        /**
+        \brief Loads the specified shader archive file.
+        \remarks The index of the archive is validated once, but the shader blobs are neither read nor copied until they are used by a renderer.
+        \throws std::runtime_error If the file could not be opened or if the file is malformed.
+        */
+        void Load(const std::string& filename);
+
+        /**
+        \brief Writes the specified shader entries into a new shader archive file.
+        \remarks The order of entries with the same key is preserved, since it determines which blob is preferred by GetShaderDesc.
+        \return True on success. Otherwise, the file could not be written.
+        \throws std::invalid_argument If any entry has an empty key, an invalid shader type, or a source type other than ShaderSourceType::CodeString or ShaderSourceType::BinaryBuffer.
+        */
+        static bool Save(const std::string& filename, const std::vector<ShaderArchiveEntry>& entries);
+
+        /* ----- Shaders ----- */
+
+        /**
+        \brief Looks up the shader with the specified key and returns its descriptor.
+        \param[in] key Specifies the key of the shader.
+        \param[in] languages Specifies the shading languages that are supported by the renderer (see RenderingCapabilities::shadingLanguages).
+        The first blob of the key (in the order it was written into the archive) whose shading language is contained in this list is selected.
+        \param[out] shaderDesc Specifies the output shader descriptor. Its 'source' member points directly into the mapped archive file.
+        \return True if a suitable blob has been found. Otherwise, the output descriptor is not modified.
+        */
+        bool FindShaderDesc(const char* key, const std::vector<ShadingLanguage>& languages, ShaderDescriptor& shaderDesc) const;
+
+        /**
+        \brief Returns the descriptor of the shader with the specified key (see FindShaderDesc).
+        \throws std::runtime_error If the archive does not contain a blob for the specified key in any of the specified shading languages.
+        */
+        ShaderDescriptor GetShaderDesc(const char* key, const std::vector<ShadingLanguage>& languages) const;
+
+        //! Returns true if the archive contains a blob for the specified key in the specified shading language.
+        bool HasShader(const char* key, const ShadingLanguage language) const;
+
+        //! Returns the number of blobs in this archive.
+        std::size_t GetNumEntries() const;
+
+    private:
+
+        const char* GetEntry(std::size_t index) const;
+        const char* GetString(std::uint32_t offset) const;
+
+        std::unique_ptr<MappedFile> file_;
+        const char*                 entries_    = nullptr;
+        std::size_t                 numEntries_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
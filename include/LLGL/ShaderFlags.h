@@ -10,8 +10,12 @@
 
 
 #include "Export.h"
+#include "Format.h"
 #include "StreamOutputFormat.h"
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 
 namespace LLGL
@@ -33,6 +37,8 @@ enum class ShaderType
     Geometry,       //!< Geometry shader type.
     Fragment,       //!< Fragment shader type (also "Pixel Shader").
     Compute,        //!< Compute shader type.
+    Amplification,  //!< Amplification shader type (also "Task Shader"). Only supported if RenderingFeatures::hasMeshShaders is true.
+    Mesh,           //!< Mesh shader type. Only supported if RenderingFeatures::hasMeshShaders is true.
 };
 
 /**
@@ -64,6 +70,16 @@ struct ShaderCompileFlags
         O2          = (1 << 2), //!< Optimization level 2.
         O3          = (1 << 3), //!< Optimization level 3.
         WarnError   = (1 << 4), //!< Warnings are treated as errors.
+
+        /**
+        \brief Compiles the shader asynchronously on a worker thread, i.e. RenderSystem::CreateShader returns immediately.
+        \remarks Any function that depends on the compiled byte code blocks until the compilation has finished,
+        e.g. Shader::HasErrors, Shader::QueryInfoLog, and creating a pipeline state.
+        Shader programs with such shaders are linked asynchronously as well. Use ShaderProgram::IsReady to poll for completion.
+        \note Only supported with: Direct3D 11, Direct3D 12.
+        \see ShaderProgram::IsReady
+        */
+        Async       = (1 << 5),
     };
 };
 
@@ -100,6 +116,9 @@ struct StageFlags
         */
         ReadOnlyResource    = (1 << 6),
 
+        AmplificationStage  = (1 << 7), //!< Specifies the amplification shader stage (also "Task Shader").
+        MeshStage           = (1 << 8), //!< Specifies the mesh shader stage.
+
         //! Specifies all tessellation stages, i.e. tessellation-control-, tessellation-evaluation shader stages.
         AllTessStages       = (TessControlStage | TessEvaluationStage),
 
@@ -108,12 +127,71 @@ struct StageFlags
 
         //! Specifies all shader stages.
         AllStages           = (AllGraphicsStages | ComputeStage),
+
+        /**
+        \brief Specifies all mesh pipeline shader stages, i.e. amplification- and mesh shader stages.
+        \remarks These stages are not included in AllStages, since they are only available if RenderingFeatures::hasMeshShaders is true.
+        */
+        AllMeshStages       = (AmplificationStage | MeshStage),
     };
 };
 
 
 /* ----- Structures ----- */
 
+/**
+\brief Shader specialization constant structure.
+\remarks Specialization constants let the driver constant-fold branches and loop counts of a shader without compiling a separate permutation for each value.
+For SPIR-V binaries, the constant with the specified ID is specialized when the shader is created (i.e. \c VkSpecializationInfo for Vulkan and \c glSpecializeShader for OpenGL).
+For GLSL and HLSL source code, the constant is injected as macro definition with the specified name (e.g. <code>#define MAX_LIGHTS 4</code>).
+\see ShaderDescriptor::specializationConstants
+*/
+struct ShaderSpecializationConstant
+{
+    ShaderSpecializationConstant() = default;
+    ShaderSpecializationConstant(const ShaderSpecializationConstant&) = default;
+    ShaderSpecializationConstant& operator = (const ShaderSpecializationConstant&) = default;
+
+    //! Constructor to initialize the specialization constant with a 32-bit signed integer (or a boolean).
+    inline ShaderSpecializationConstant(std::uint32_t id, const char* name, std::int32_t value) :
+        id    { id                                  },
+        name  { name                                },
+        type  { DataType::Int32                     },
+        value { static_cast<std::uint32_t>(value)   }
+    {
+    }
+
+    //! Constructor to initialize the specialization constant with a 32-bit unsigned integer.
+    inline ShaderSpecializationConstant(std::uint32_t id, const char* name, std::uint32_t value) :
+        id    { id               },
+        name  { name             },
+        type  { DataType::UInt32 },
+        value { value            }
+    {
+    }
+
+    //! Constructor to initialize the specialization constant with a 32-bit floating-point value.
+    inline ShaderSpecializationConstant(std::uint32_t id, const char* name, float value) :
+        id    { id                },
+        name  { name              },
+        type  { DataType::Float32 }
+    {
+        std::memcpy(&(this->value), &value, sizeof(value));
+    }
+
+    //! Specifies the ID of the specialization constant (i.e. the \c constant_id layout qualifier in GLSL). This is only used for SPIR-V binaries.
+    std::uint32_t   id      = 0;
+
+    //! Specifies the name of the macro definition. This is only used for shader source code. If this is null, the constant is ignored for shader source code.
+    const char*     name    = nullptr;
+
+    //! Specifies the data type of the value. This must be DataType::Int32, DataType::UInt32, or DataType::Float32. Boolean constants are specified as 32-bit integers. By default DataType::Int32.
+    DataType        type    = DataType::Int32;
+
+    //! Specifies the 32-bit pattern of the value in the respective data type. By default 0.
+    std::uint32_t   value   = 0;
+};
+
 /**
 \brief Shader source and binary code descriptor structure.
 \see RenderSystem::CreateShader
@@ -149,7 +227,15 @@ struct ShaderDescriptor
     //! Additional descriptor for stream outputs.
     struct StreamOutput
     {
-        StreamOutputFormat format;  //!< Stream-output buffer format.
+        //! Stream-output buffer format. Each attribute specifies its vertex stream and output slot.
+        StreamOutputFormat  format;
+
+        /**
+        \brief Zero-based index of the vertex stream that is sent to the rasterizer when a geometry shader writes multiple vertex streams. By default 0.
+        \remarks For OpenGL, only the vertex stream 0 is rasterized.
+        \note Only supported with: Direct3D 11.
+        */
+        std::uint32_t       rasterizedStream    = 0;
     };
 
     //! Specifies the type of the shader, i.e. if it is either a vertex or fragment shader or the like. By default ShaderType::Undefined.
@@ -205,6 +291,23 @@ struct ShaderDescriptor
 
     //! Optional stream output descriptor for a geometry shader (or a vertex shader when used with OpenGL).
     StreamOutput        streamOutput;
+
+    /**
+    \brief Optional list of specialization constants. By default empty.
+    \remarks Constants of SPIR-V binaries are specialized by their IDs, and constants of shader source code are injected as macro definitions by their names.
+    Shader binaries other than SPIR-V (e.g. DXBC) cannot be specialized and ignore this list.
+    \note Only supported with: Vulkan (SPIR-V), OpenGL (GLSL, and SPIR-V with GL_ARB_gl_spirv), Direct3D 11 and Direct3D 12 (HLSL).
+    \see ShaderSpecializationConstant
+    */
+    std::vector<ShaderSpecializationConstant> specializationConstants;
+
+    /**
+    \brief Specifies the number of threads per work group of a compute shader. By default (1, 1, 1).
+    \remarks Metal kernel functions do not declare their thread group size in the shader code (unlike 'numthreads' in HLSL and 'local_size' in GLSL),
+    so it must be specified when the shader is created. CommandBuffer::Dispatch then specifies the number of work groups as for all other renderers.
+    \note Only supported with: Metal.
+    */
+    Extent3D            workGroupSize   = { 1, 1, 1 };
 };
 
 
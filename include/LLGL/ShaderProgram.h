@@ -39,6 +39,17 @@ class LLGL_EXPORT ShaderProgram : public RenderSystemChild
         //! Returns the information log after the shader linkage.
         virtual std::string QueryInfoLog() = 0;
 
+        /**
+        \brief Returns true if the compilation and linking of this shader program has finished, i.e. querying its status does not block.
+        \remarks Shader programs are compiled and linked in the background if the driver supports it (OpenGL with GL_KHR_parallel_shader_compile),
+        or if any of its shaders has been created with ShaderCompileFlags::Async (Direct3D 11 and Direct3D 12).
+        In that case, CreateShaderProgram returns immediately, and this function can be polled to spread the loading of many shader programs over several frames.
+        All other functions of this shader program, as well as creating a pipeline state with it, block until the shader program is ready.
+        For all other render systems, this is always true.
+        \see ShaderCompileFlags::Async
+        */
+        virtual bool IsReady() const = 0;
+
         /**
         \brief Returns a descriptor of the shader pipeline layout with all required shader resources.
         \remarks The list of resource views in the output descriptor (i.e. 'resourceViews' attribute) is always sorted in the following manner:
@@ -89,7 +100,10 @@ class LLGL_EXPORT ShaderProgram : public RenderSystemChild
         }
         \endcode
         \note Only supported with: OpenGL.
+        \remarks For OpenGL 4.1+ (or the \c GL_ARB_separate_shader_objects extension), the uniforms are set directly to the shader program,
+        i.e. the shader program is not bound and locking and unlocking does not change the pipeline state.
         \see UnlockShaderUniform
+        \see ShaderUniform::SetUniforms
         */
         virtual ShaderUniform* LockShaderUniform() = 0;
 
@@ -45,7 +45,7 @@ struct ShaderProgramDescriptor
 
     /**
     \brief Specifies the vertex shader.
-    \remarks Each graphics shader program must have at least a vertex shader.
+    \remarks Each graphics shader program must have at least a vertex shader, unless it is a mesh shader program.
     For a compute shader program, only a compute shader must be specified.
     With OpenGL, this shader may also have a stream output.
     \see ShaderDescriptor::streamOutput
@@ -85,6 +85,24 @@ struct ShaderProgramDescriptor
     \remarks This shader cannot be used in conjunction with any other shaders.
     */
     Shader*                     computeShader           = nullptr;
+
+    /**
+    \brief Specifies an optional amplification shader (also referred to as "Task Shader").
+    \remarks This can only be used in conjunction with a mesh shader.
+    \see meshShader
+    */
+    Shader*                     amplificationShader     = nullptr;
+
+    /**
+    \brief Specifies the mesh shader.
+    \remarks A mesh shader program replaces the input assembler and all vertex processing stages,
+    i.e. it must not have a vertex, tessellation, or geometry shader and the vertex formats must be empty.
+    It can be used in conjunction with an optional amplification shader and an optional fragment shader.
+    Mesh shader programs are drawn with CommandBuffer::DrawMeshTasks and CommandBuffer::DrawMeshTasksIndirect.
+    \see amplificationShader
+    \see RenderingFeatures::hasMeshShaders
+    */
+    Shader*                     meshShader              = nullptr;
 };
 
 /**
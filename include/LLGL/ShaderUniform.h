@@ -83,6 +83,29 @@ class LLGL_EXPORT ShaderUniform : public NonCopyable
         virtual void SetUniform3x3fv(const char* name, const float* value, std::size_t count = 1) = 0;
         virtual void SetUniform4x4fv(const char* name, const float* value, std::size_t count = 1) = 0;
 
+        /**
+        \brief Sets multiple uniforms with a single call.
+        \param[in] numUniforms Specifies the number of uniforms to set.
+        \param[in] locations Pointer to an array of 'numUniforms' uniform locations. Each location must refer to the first element of an active uniform.
+        \param[in] data Pointer to the tightly packed values of all uniforms in the same order as their locations.
+        Each uniform occupies 4 bytes per component (integral and boolean components included) times its array size, i.e. all array elements are always set.
+        \param[in] dataSize Specifies the size (in bytes) of the 'data' buffer.
+        \remarks This is the preferred way to set many uniforms at once, because the uniform types are resolved by the shader program
+        and the values are set without one interface call per uniform.
+        Only single-precision floating-point, signed integer, and boolean scalars and vectors, square matrices, and sampler or image bindings are supported.
+        \throws std::invalid_argument If a location does not refer to an active uniform, if the type of a uniform is not supported, or if 'dataSize' is too small.
+        \code
+        struct MyUniforms {
+            float projection[16];
+            float lightColor[4];
+            int   diffuseMap;
+        };
+        const LLGL::UniformLocation myLocations[3] = { projectionLoc, lightColorLoc, diffuseMapLoc };
+        myUniformHandler->SetUniforms(3, myLocations, &myUniforms, sizeof(myUniforms));
+        \endcode
+        */
+        virtual void SetUniforms(std::size_t numUniforms, const UniformLocation* locations, const void* data, std::size_t dataSize) = 0;
+
 };
 
 
@@ -51,6 +51,8 @@ struct LLGL_EXPORT StreamOutputAttribute
     /**
     \brief Stream-output buffer output slot.
     \remarks This is used when multiple stream-output buffers are used simultaneously.
+    For OpenGL (with GL_ARB_transform_feedback3), the attributes must be sorted by their output slots,
+    since the varyings of the next buffer are separated by the "gl_NextBuffer" pseudo varying.
     */
     std::uint8_t    outputSlot      = 0;
 };
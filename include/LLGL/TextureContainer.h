@@ -0,0 +1,111 @@
+/*
+ * TextureContainer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_CONTAINER_H
+#define LLGL_TEXTURE_CONTAINER_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "TextureFlags.h"
+#include "ImageFlags.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class MappedFile;
+
+/**
+\brief Utility class to load the pre-compressed image data of a texture container file, i.e. DDS (DirectDraw Surface) or KTX2 (Khronos Texture 2.0).
+
+This class is not required for any interaction with the render system.
+It can be used as utility to upload all MIP-map levels of a texture container without any CPU side decoding.
+\remarks The container file is memory-mapped and stays mapped for the lifetime of this object.
+All images returned by GetImages point directly into the mapped file, i.e. the image data is neither copied nor converted.
+Therefore, the images must no longer be used after this object has been destroyed or another file has been loaded.
+\code
+LLGL::TextureContainer container { "MyTexture.dds" };
+const auto& images = container.GetImages();
+auto myTexture = myRenderer->CreateTexture(container.GetDesc(), static_cast<std::uint32_t>(images.size()), images.data());
+\endcode
+\see Image
+\see RenderSystem::CreateTexture(const TextureDescriptor&, std::uint32_t, const TextureSubresourceImage*)
+*/
+class LLGL_EXPORT TextureContainer : public NonCopyable
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        TextureContainer();
+
+        /**
+        \brief Constructor to load the specified texture container file.
+        \see Load
+        */
+        TextureContainer(const std::string& filename);
+
+        //! Move constructor which takes the ownership of the mapped file.
+        TextureContainer(TextureContainer&& rhs);
+
+        ~TextureContainer();
+
+        /* ----- Operators ----- */
+
+        //! Move operator which takes the ownership of the mapped file.
+        TextureContainer& operator = (TextureContainer&& rhs);
+
+        /* ----- Storage ----- */
+
+        /**
+        \brief Loads the specified texture container file. The file type is determined by its content, not by the file extension.
+        \remarks DDS files are supported with the legacy header and with the DX10 header extension (including array and cube textures).
+        KTX2 files are supported without supercompression only.
+        \throws std::runtime_error If the file could not be opened, if the file is malformed, or if its format is not supported.
+        */
+        void Load(const std::string& filename);
+
+        /* ----- Attributes ----- */
+
+        //! Returns the texture descriptor that describes the loaded texture container, including its type, format, extent, array layers, and MIP-map levels.
+        inline const TextureDescriptor& GetDesc() const
+        {
+            return textureDesc_;
+        }
+
+        //! Returns the list of sub-resource images, which point directly into the mapped container file.
+        inline const std::vector<TextureSubresourceImage>& GetImages() const
+        {
+            return images_;
+        }
+
+    private:
+
+        void LoadDDS(const char* data, std::size_t size);
+        void LoadKTX2(const char* data, std::size_t size);
+
+        std::unique_ptr<MappedFile>             file_;
+        TextureDescriptor                       textureDesc_;
+        std::vector<TextureSubresourceImage>    images_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -36,7 +36,6 @@ enum class TextureType
     Texture2DMSArray,   //!< 2-Dimensional multi-sample array texture.
 };
 
-#if 0//TODO: currently unused
 /**
 \brief Texture component swizzle enumeration.
 \remarks Can be used to change the order of texel components independently of a shader.
@@ -51,7 +50,6 @@ enum class TextureSwizzle
     Blue,   //!< The component is replaced by blue component.
     Alpha   //!< The component is replaced by alpha component.
 };
-#endif
 
 /**
 \brief Texture creation flags enumeration.
@@ -103,7 +101,11 @@ struct TextureFlags
         */
         SampleUsage         = (1 << 4),
 
-        //! Texture can be used as storage texture (e.g. "image2D" in GLSL, or "RWTexture2D" in HLSL).
+        /**
+        \brief Texture can be used as storage texture (e.g. "image2D" in GLSL, or "RWTexture2D" in HLSL).
+        \remarks For OpenGL, a texture with this flag is bound to the image unit of its binding slot (MIP level 0 with all layers and read/write access)
+        in addition to its texture unit, when it is part of a resource heap.
+        */
         StorageUsage        = (1 << 5),
 
         /**
@@ -114,6 +116,43 @@ struct TextureFlags
         */
         FixedSamples        = (1 << 6),
 
+        /**
+        \brief Texture is created as sparse texture, i.e. without physical memory for its texels.
+        \remarks The memory of a sparse texture is committed tile by tile with RenderSystem::CommitTextureTiles,
+        which allows to use textures much larger than the available video memory (e.g. for virtual texturing).
+        Reading uncommitted tiles in a shader returns undefined values, and writing to them has no effect.
+        Sparse textures cannot be created with initial image data.
+        This can only be used with 2D, 3D, cube, 2D array, and cube array textures (i.e. TextureType::Texture2D, TextureType::Texture3D,
+        TextureType::TextureCube, TextureType::Texture2DArray, TextureType::TextureCubeArray).
+        \note Only supported if RenderingFeatures::hasSparseTextures is true.
+        \see RenderSystem::QuerySparseTileShape
+        \see RenderSystem::CommitTextureTiles
+        */
+        Sparse              = (1 << 7),
+
+        /**
+        \brief Texture can be shared with texture views of a different format.
+        \remarks Without this flag, a texture view must have the same format as the texture it refers to.
+        With this flag, the format of a texture view can be any other format of the same size per texel (e.g. Format::RGBA8sRGB for a texture of format Format::RGBA8UNorm).
+        For Direct3D, the formats must also have the same components with the same number of bits, i.e. they must only differ in their data type (e.g. UNorm, sRGB, UInt).
+        This flag might reduce the performance of the texture, since the driver can disable the compression of its texels.
+        \see TextureViewDescriptor::format
+        \see RenderSystem::CreateTextureView
+        */
+        MutableFormat       = (1 << 8),
+
+        /**
+        \brief Texture is a transient render target attachment whose content does not outlive a render pass.
+        \remarks This is meant for intermediate attachments that are neither loaded nor stored (e.g. depth buffers or multi-sampled color buffers),
+        which tile-based GPUs can keep entirely in tile memory without allocating any video memory.
+        For Vulkan, the texture is created with \c VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT and lazily allocated memory if the device supports it.
+        For OpenGL, the content of the attachment is invalidated with \c glInvalidateFramebuffer at the end of each render pass.
+        This flag must be combined with TextureFlags::AttachmentUsage, and it cannot be combined with TextureFlags::SampleUsage, TextureFlags::StorageUsage, or TextureFlags::Sparse.
+        Transient textures cannot be created with initial image data, and they cannot be the source or destination of any copy, read, write, or MIP-map generation command.
+        \see AttachmentDescriptor::texture
+        */
+        Transient           = (1 << 9),
+
         /**
         \brief Default texture flags: (AttachmentUsage | SampleUsage | FixedSamples).
         \see AttachmentUsage
@@ -127,10 +166,10 @@ struct TextureFlags
 
 /* ----- Structures ----- */
 
-#if 0//TODO: currently unused
 /**
 \brief Texture component swizzle structure for red, green, blue, and alpha components.
 \remarks Can be used to change the order of texel components independently of a shader.
+\see TextureViewDescriptor::swizzle
 */
 struct TextureSwizzleRGBA
 {
@@ -139,7 +178,65 @@ struct TextureSwizzleRGBA
     TextureSwizzle b = TextureSwizzle::Blue;    //!< Blue component swizzle. By default TextureSwizzle::Blue.
     TextureSwizzle a = TextureSwizzle::Alpha;   //!< Alpha component swizzle. By default TextureSwizzle::Alpha.
 };
-#endif
+
+/**
+\brief Texture subresource structure: range of MIP-map levels and array layers.
+\see TextureViewDescriptor::subresource
+*/
+struct TextureSubresource
+{
+    //! First MIP-map level of the subresource. By default 0.
+    std::uint32_t   baseMipLevel    = 0;
+
+    //! Number of MIP-map levels of the subresource. By default 1.
+    std::uint32_t   numMipLevels    = 1;
+
+    /**
+    \brief First array layer of the subresource. By default 0.
+    \remarks For cube textures, this specifies the first cube face (see TextureDescriptor::arrayLayers).
+    */
+    std::uint32_t   baseArrayLayer  = 0;
+
+    /**
+    \brief Number of array layers of the subresource. By default 1.
+    \remarks For cube textures, this specifies the number of cube faces, and must be a multiple of 6 if the view is a cube texture.
+    */
+    std::uint32_t   numArrayLayers  = 1;
+};
+
+/**
+\brief Texture view descriptor structure.
+\remarks A texture view shares the memory of another texture, i.e. no texel data is copied,
+but it can refer to a range of MIP-map levels and array layers and reinterpret the texture format.
+\see RenderSystem::CreateTextureView
+*/
+struct TextureViewDescriptor
+{
+    /**
+    \brief Texture type of the view. By default TextureType::Texture1D.
+    \remarks This must be compatible with the type of the shared texture,
+    e.g. a TextureType::Texture2D view can refer to a single array layer or cube face of a TextureType::TextureCube texture.
+    For Direct3D, a view of a single array layer other than the first one is created as array view with one layer,
+    so the shader must declare it as array texture (e.g. "Texture2DArray" in HLSL).
+    */
+    TextureType         type        = TextureType::Texture1D;
+
+    /**
+    \brief Texture format of the view. By default Format::RGBA8UNorm.
+    \remarks This must be equal to the format of the shared texture, unless the shared texture has been created with the TextureFlags::MutableFormat flag.
+    \see TextureFlags::MutableFormat
+    */
+    Format              format      = Format::RGBA8UNorm;
+
+    //! Range of MIP-map levels and array layers of the shared texture the view refers to.
+    TextureSubresource  subresource;
+
+    /**
+    \brief Component swizzle of the view. By default the identity mapping (Red, Green, Blue, Alpha).
+    \note Not supported with: Direct3D 11.
+    */
+    TextureSwizzleRGBA  swizzle;
+};
 
 /**
 \brief Texture descriptor structure.
@@ -236,6 +333,69 @@ struct SubTextureDescriptor
     Extent3D        extent      = { 1, 1, 1 };
 };
 
+/**
+\brief Staging memory for a texture upload, which is written directly by the CPU.
+\remarks The texel data must be written in the hardware format of the texture, i.e. no image conversion is performed.
+Each row of texels (or row of blocks for compressed formats) starts at a multiple of 'rowPitch',
+and each depth slice or array layer starts at a multiple of 'slicePitch' (for 1D-array textures, each array layer is a single row).
+\see RenderSystem::BeginTextureUpload
+*/
+struct TextureUploadMemory
+{
+    //! Pointer to the first texel of the staging memory. This is only valid until RenderSystem::EndTextureUpload is called.
+    void*           data        = nullptr;
+
+    //! Size (in bytes) between the start of two consecutive rows. This may be larger than the size of a tightly packed row.
+    std::uint32_t   rowPitch    = 0;
+
+    //! Size (in bytes) between the start of two consecutive depth slices or array layers.
+    std::uint64_t   slicePitch  = 0;
+};
+
+/**
+\brief Texture location structure: MIP-map level and offset within a texture.
+\remarks This is used to specify the destination of a texture copy command.
+\see CommandBuffer::CopyTexture
+*/
+struct TextureLocation
+{
+    //! MIP-map level, where 0 is the base texture, and N > 0 is the N-th MIP-map level. By default 0.
+    std::uint32_t   mipLevel    = 0;
+
+    /**
+    \brief Texel offset within the MIP-map level. By default (0, 0, 0).
+    \remarks The array layer is specified in the same way as for SubTextureDescriptor::offset.
+    \see SubTextureDescriptor::offset
+    */
+    Offset3D        offset      = { 0, 0, 0 };
+};
+
+/**
+\brief Texture region structure: MIP-map level, offset, and extent of a region within a texture.
+\remarks This is used to specify the source and destination regions of the copy commands.
+The array layers are specified in the same way as for the SubTextureDescriptor structure.
+\see CommandBuffer::CopyTexture
+\see CommandBuffer::CopyBufferToTexture
+\see CommandBuffer::CopyTextureToBuffer
+*/
+struct TextureRegion
+{
+    //! MIP-map level, where 0 is the base texture, and N > 0 is the N-th MIP-map level. By default 0.
+    std::uint32_t   mipLevel    = 0;
+
+    /**
+    \brief Texel offset of the region. By default (0, 0, 0).
+    \see SubTextureDescriptor::offset
+    */
+    Offset3D        offset      = { 0, 0, 0 };
+
+    /**
+    \brief Extent of the region. By default (1, 1, 1).
+    \see SubTextureDescriptor::extent
+    */
+    Extent3D        extent      = { 1, 1, 1 };
+};
+
 
 /* ----- Functions ----- */
 
@@ -275,6 +435,19 @@ For the DXT compressed texture formats, this must be a multiple of 16, since the
 */
 LLGL_EXPORT std::uint32_t TextureBufferSize(const Format format, std::uint32_t numTexels);
 
+/**
+\brief Returns the required buffer size (in bytes) of a texture region with the specified hardware format and extent.
+\param[in] format Specifies the texture format.
+\param[in] extent Specifies the extent of the texture region (where the depth denotes the number of slices or array layers).
+\return The required buffer size (in bytes), or zero if the input is invalid.
+\remarks For compressed formats, the width and height are rounded up to the next multiple of the block dimension,
+i.e. each slice of a region with 2x2 texels still requires one entire 4x4 block of a BC format.
+This is the size that must be provided for each MIP-map level of a compressed texture.
+\see FormatBlockExtent
+\see FormatBlockSize
+*/
+LLGL_EXPORT std::uint32_t TextureBufferSize(const Format format, const Extent3D& extent);
+
 /**
 \brief Returns the texture size (in texels) of the specified texture descriptor, or zero if the texture type is invalid.
 \see TextureDescriptor::type
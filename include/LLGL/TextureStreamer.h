@@ -0,0 +1,165 @@
+/*
+ * TextureStreamer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_STREAMER_H
+#define LLGL_TEXTURE_STREAMER_H
+
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "TextureFlags.h"
+#include "ImageFlags.h"
+#include <cstdint>
+#include <vector>
+#include <map>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Texture;
+
+/**
+\brief Streams the MIP-map levels of many textures incrementally, so that only the MIP-map levels that are demanded on screen are resident.
+
+This class is not required for any interaction with the render system.
+Each texture is created with its full MIP-map chain, but only its lowest MIP-map levels are uploaded initially.
+The sampling of each texture is clamped to its resident MIP-map levels (see RenderSystem::SetTextureMinLOD),
+and the client programmer reports the demanded MIP-map level and a priority of each texture (e.g. from its screen-space size or from a feedback buffer).
+Each call to Update uploads the next higher MIP-map levels of the textures with the highest priority within an upload budget,
+through the regular upload path of the render system (i.e. the staging ring for Vulkan and the upload heap for Direct3D 12).
+\remarks If a texture is created with the TextureFlags::Sparse flag and the renderer supports sparse textures,
+the memory of each MIP-map level is only committed while it is resident, so the memory consumption follows the demand.
+Otherwise, the entire MIP-map chain is allocated, but only the resident MIP-map levels are uploaded.
+\remarks The image data of all textures must remain valid until the textures have been released, since the higher MIP-map levels are uploaded on demand.
+This is typically the memory-mapped file of a TextureContainer.
+\code
+LLGL::TextureContainer container { "MyTexture.dds" };
+LLGL::TextureStreamer streamer { *myRenderer };
+
+const auto& images = container.GetImages();
+auto myTexture = streamer.CreateTexture(container.GetDesc(), static_cast<std::uint32_t>(images.size()), images.data());
+
+// Every frame:
+streamer.RequestMipLevel(*myTexture, myDemandedMipLevel, myScreenCoverage);
+streamer.Update();
+\endcode
+\note Only supported if RenderingFeatures::hasTextureMinLOD is true.
+\see RenderSystem::SetTextureMinLOD
+\see TextureContainer
+*/
+class LLGL_EXPORT TextureStreamer : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Constructs a texture streamer for the specified render system.
+        \param[in] renderSystem Specifies the render system to create the textures with.
+        \param[in] uploadBudget Specifies the maximum number of bytes that are uploaded with each call to Update. By default 4 MB.
+        \throws std::runtime_error If the render system does not support RenderingFeatures::hasTextureMinLOD.
+        */
+        TextureStreamer(RenderSystem& renderSystem, std::uint64_t uploadBudget = 4 * 1024 * 1024);
+
+        //! Releases all textures that have been created by this streamer.
+        ~TextureStreamer();
+
+        /**
+        \brief Creates a new streaming texture with its full MIP-map chain and uploads its lowest MIP-map levels.
+        \param[in] textureDesc Specifies the texture descriptor. If the TextureFlags::Sparse flag is specified but sparse textures are not supported, this flag is ignored.
+        \param[in] numImages Specifies the number of images in the array 'images'.
+        \param[in] images Pointer to an array of sub-resource images. The array is copied, but the image data must remain valid until the texture is released.
+        \param[in] numResidentMipLevels Specifies the number of MIP-map levels that are initially resident, beginning with the smallest one. By default 1.
+        \return Pointer to the new texture, which is owned by this streamer and must be released with TextureStreamer::Release.
+        \remarks A MIP-map level can only become resident if the images cover it. Initially, the texture is demanded down to its base MIP-map level with a priority of zero.
+        \throws std::invalid_argument If the texture descriptor specifies a multi-sampled texture, or if the images do not cover the smallest MIP-map level.
+        */
+        Texture* CreateTexture(
+            const TextureDescriptor&        textureDesc,
+            std::uint32_t                   numImages,
+            const TextureSubresourceImage*  images,
+            std::uint32_t                   numResidentMipLevels = 1
+        );
+
+        //! Releases the specified texture, which must have been created by this streamer.
+        void Release(Texture& texture);
+
+        /**
+        \brief Reports the demanded MIP-map level and the streaming priority of the specified texture.
+        \param[in] texture Specifies the texture, which must have been created by this streamer.
+        \param[in] mipLevel Specifies the finest MIP-map level that is demanded on screen.
+        If this is greater than the finest resident MIP-map level of a sparse texture, the finer MIP-map levels are evicted with the next call to Update.
+        \param[in] priority Specifies the priority of this texture. Textures with a higher priority are streamed first. By default 1.
+        */
+        void RequestMipLevel(Texture& texture, std::uint32_t mipLevel, float priority = 1.0f);
+
+        /**
+        \brief Evicts and uploads MIP-map levels according to the demands of all textures.
+        \return Number of MIP-map levels that have been uploaded by this call.
+        \remarks At least one MIP-map level is uploaded per call if any texture demands one, even if it exceeds the upload budget.
+        */
+        std::uint32_t Update();
+
+        //! Returns the finest MIP-map level of the specified texture that is resident.
+        std::uint32_t GetResidentMipLevel(const Texture& texture) const;
+
+        //! Returns the size (in bytes) of the image data of all resident MIP-map levels.
+        inline std::uint64_t GetResidentSize() const
+        {
+            return residentSize_;
+        }
+
+        //! Sets the maximum number of bytes that are uploaded with each call to Update.
+        inline void SetUploadBudget(std::uint64_t uploadBudget)
+        {
+            uploadBudget_ = uploadBudget;
+        }
+
+    private:
+
+        struct StreamingTexture
+        {
+            TextureDescriptor                                   desc;
+            std::vector<std::vector<TextureSubresourceImage>>   mipImages;                  // Images of each MIP-map level
+            std::uint32_t                                       residentMipLevel    = 0;
+            std::uint32_t                                       requestedMipLevel   = 0;
+            float                                               priority            = 0.0f;
+            bool                                                sparse              = false;
+        };
+
+    private:
+
+        StreamingTexture& GetStreamingTexture(const Texture& texture);
+        const StreamingTexture& GetStreamingTexture(const Texture& texture) const;
+
+        // Commits the memory of the specified MIP-map level for sparse textures, and uploads all its images. Returns the size (in bytes) of the uploaded data.
+        std::uint64_t UploadMipLevel(Texture& texture, StreamingTexture& entry, std::uint32_t mipLevel);
+
+        // Evicts all MIP-map levels that are finer than the requested level of a sparse texture.
+        void EvictMipLevels(Texture& texture, StreamingTexture& entry);
+
+    private:
+
+        RenderSystem&                           renderSystem_;
+        std::uint64_t                           uploadBudget_       = 0;
+        std::uint64_t                           residentSize_       = 0;
+        bool                                    sparseSupported_    = false;
+        std::map<Texture*, StreamingTexture>    textures_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
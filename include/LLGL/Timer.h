@@ -30,6 +30,21 @@ class LLGL_EXPORT Timer : public NonCopyable
         //! Creates a platform specific timer object.
         static std::unique_ptr<Timer> Create();
 
+        /**
+        \brief Returns the current ticks of the high-resolution monotonic clock of the platform.
+        \remarks In contrast to the Start and Stop functions, this is not a virtual function and does not require a timer object,
+        which makes it cheap enough to measure individual function calls. The ticks are only meaningful relative to each other.
+        \see GetTickFrequency
+        \see FrameTimer
+        */
+        static std::uint64_t Tick();
+
+        /**
+        \brief Returns the frequency resolution of the Tick function, or rather 'ticks per second'.
+        \see Tick
+        */
+        static std::uint64_t GetTickFrequency();
+
         //! Starts the timer.
         virtual void Start() = 0;
 
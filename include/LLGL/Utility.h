@@ -23,6 +23,8 @@ THIS HEADER MUST BE EXPLICITLY INCLUDED
 #include "ShaderProgramFlags.h"
 #include "PipelineLayoutFlags.h"
 #include <initializer_list>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace LLGL
@@ -160,6 +162,52 @@ Hence, this utility function cannot be used in conjunction with all renderer ver
 */
 LLGL_EXPORT PipelineLayoutDescriptor PipelineLayoutDesc(const ShaderReflectionDescriptor& reflectionDesc);
 
+/* ----- Vertex quantization utility functions ----- */
+
+/**
+\brief Quantizes the specified 32-bit floats into 16-bit floats, e.g. for vertex attributes of the format Format::RG16Float or Format::RGBA16Float.
+\param[in] src Pointer to the input array of \c count floats.
+\param[out] dst Pointer to the output array of \c count 16-bit floats (represented as 16-bit unsigned integers).
+\remarks This uses F16C instructions on x86 (if supported by the CPU) and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void QuantizeFloat16(const float* src, std::uint16_t* dst, std::size_t count);
+
+/**
+\brief Quantizes the specified 32-bit floats into 16-bit normalized signed integers, e.g. for vertex attributes of the format Format::RG16SNorm or Format::RGBA16SNorm.
+\param[in] src Pointer to the input array of \c count floats. The values are clamped to the range [-1, 1].
+\param[out] dst Pointer to the output array of \c count 16-bit signed integers.
+\remarks The values are rounded to the nearest representable value.
+This uses SSE2 instructions on x86 and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void QuantizeSNorm16(const float* src, std::int16_t* dst, std::size_t count);
+
+/**
+\brief Quantizes the specified RGBA vectors into the packed Format::RGB10A2UNorm format.
+\param[in] src Pointer to the input array of \c count vectors with 4 floats each (red, green, blue, alpha). The values are clamped to the range [0, 1].
+\param[out] dst Pointer to the output array of \c count 32-bit values. The red component is stored in the least significant bits.
+\remarks This is suitable for tangent vectors or vertex colors, where the 2-bit alpha component can store the handedness of the bitangent, for instance.
+This uses SSE2 instructions on x86 and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void QuantizeRGB10A2UNorm(const float* src, std::uint32_t* dst, std::size_t count);
+
+/**
+\brief Encodes the specified unit vectors into octahedral coordinates with two 16-bit normalized signed integers each.
+\param[in] src Pointer to the input array of \c count vectors with 3 floats each (X, Y, Z). These vectors must be normalized.
+\param[out] dst Pointer to the output array of \c count pairs of 16-bit signed integers, e.g. for vertex attributes of the format Format::RG16SNorm.
+\remarks This reduces a vertex normal from 12 to 4 bytes. The normal can be decoded in the vertex shader like this:
+\code
+vec3 DecodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+\endcode
+This uses SSE2 instructions on x86 and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void QuantizeOctahedralSNorm16(const float* src, std::int16_t* dst, std::size_t count);
+
 /** @} */
 
 
@@ -36,7 +36,7 @@ struct VideoOutputDescriptor
 /**
 \brief Video adapter descriptor structure.
 \remarks A video adapter determines the output capabilities of a GPU.
-\todo Currently unused in the interface.
+\see RenderSystem::GetVideoAdapters
 */
 struct VideoAdapterDescriptor
 {
@@ -49,6 +49,13 @@ struct VideoAdapterDescriptor
     //! Video memory size (in bytes).
     std::uint64_t                       videoMemory = 0;
 
+    /**
+    \brief Locally unique identifier (LUID) of the adapter, which is only valid until the system is restarted. By default 0.
+    \remarks This can be used to select the same adapter in another process (see RenderSystemDescriptor::adapterLUID).
+    This is only provided by Direct3D 11 and Direct3D 12.
+    */
+    std::uint64_t                       luid        = 0;
+
     //! List of all adapter output descriptors.
     std::vector<VideoOutputDescriptor>  outputs;
 };
@@ -0,0 +1,186 @@
+/*
+ * ColorSpace.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ColorSpace.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_SRGB_SSE2
+#   include <emmintrin.h>
+#elif (defined __ARM_NEON && defined __aarch64__) || defined _M_ARM64
+#   define LLGL_SRGB_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Linear values below this threshold are encoded with the linear segment of the sRGB curve
+static const float g_srgbLinearThreshold = 0.0031308f;
+
+// Lookup table of all 8-bit sRGB values decoded into linear values.
+struct SRGBDecodeTable
+{
+    SRGBDecodeTable()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            const auto s = static_cast<double>(i) / 255.0;
+            values[i] = static_cast<float>(s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4));
+        }
+    }
+
+    float values[256];
+};
+
+static const SRGBDecodeTable& GetSRGBDecodeTable()
+{
+    static const SRGBDecodeTable table;
+    return table;
+}
+
+/*
+Approximates the sRGB curve 1.055 * x^(1/2.4) - 0.055 with a weighted sum of x^(1/2), x^(1/4), and x^(1/8),
+so it can be evaluated with square roots only. The result is within one step of the exact 8-bit encoding.
+*/
+static float ApproxSRGBCurve(float x)
+{
+    const auto s1 = std::sqrt(x);
+    const auto s2 = std::sqrt(s1);
+    const auto s3 = std::sqrt(s2);
+    return (0.662002687f * s1 + 0.684122060f * s2 - 0.323583601f * s3 - 0.0225411470f * x);
+}
+
+LLGL_EXPORT std::size_t GetAlphaComponentIndex(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA:
+            return 3;
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR:
+            return 0;
+        default:
+            return ImageFormatSize(format);
+    }
+}
+
+LLGL_EXPORT float DecodeSRGB8(std::uint8_t value)
+{
+    return GetSRGBDecodeTable().values[value];
+}
+
+LLGL_EXPORT std::uint8_t EncodeSRGB8(float value)
+{
+    value = std::max(0.0f, std::min(value, 1.0f));
+    if (value <= g_srgbLinearThreshold)
+        value *= 12.92f;
+    else
+        value = std::min(ApproxSRGBCurve(value), 1.0f);
+    return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+}
+
+LLGL_EXPORT void DecodeSRGB8Array(const std::uint8_t* src, float* dst, std::size_t count, std::size_t numComponents, std::size_t alphaIndex)
+{
+    const auto& table = GetSRGBDecodeTable().values;
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = table[src[i]];
+
+    /* Replace alpha components by their normalized values */
+    if (alphaIndex < numComponents)
+    {
+        for (auto j = alphaIndex; j < count; j += numComponents)
+            dst[j] = static_cast<float>(src[j]) / 255.0f;
+    }
+}
+
+LLGL_EXPORT void EncodeSRGB8Array(const float* src, std::uint8_t* dst, std::size_t count, std::size_t numComponents, std::size_t alphaIndex)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SRGB_SSE2
+
+    const auto zero         = _mm_setzero_ps();
+    const auto one          = _mm_set1_ps(1.0f);
+    const auto threshold    = _mm_set1_ps(g_srgbLinearThreshold);
+    const auto linearScale  = _mm_set1_ps(12.92f);
+    const auto c1           = _mm_set1_ps(0.662002687f);
+    const auto c2           = _mm_set1_ps(0.684122060f);
+    const auto c3           = _mm_set1_ps(-0.323583601f);
+    const auto c4           = _mm_set1_ps(-0.0225411470f);
+    const auto scale        = _mm_set1_ps(255.0f);
+    const auto half         = _mm_set1_ps(0.5f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        /* Evaluate both segments of the sRGB curve and select by threshold */
+        auto x      = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), zero), one);
+        auto s1     = _mm_sqrt_ps(x);
+        auto s2     = _mm_sqrt_ps(s1);
+        auto s3     = _mm_sqrt_ps(s2);
+        auto curve  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c1, s1), _mm_mul_ps(c2, s2)), _mm_add_ps(_mm_mul_ps(c3, s3), _mm_mul_ps(c4, x)));
+        auto mask   = _mm_cmple_ps(x, threshold);
+        auto s      = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(x, linearScale)), _mm_andnot_ps(mask, _mm_min_ps(curve, one)));
+
+        /* Scale to [0, 255], round, and pack into four bytes */
+        auto v32    = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(s, scale), half));
+        auto v16    = _mm_packs_epi32(v32, v32);
+        auto v8     = _mm_packus_epi16(v16, v16);
+        auto bytes  = _mm_cvtsi128_si32(v8);
+        std::copy(reinterpret_cast<const std::uint8_t*>(&bytes), reinterpret_cast<const std::uint8_t*>(&bytes) + 4, dst + i);
+    }
+
+    #elif defined LLGL_SRGB_NEON
+
+    const auto zero         = vdupq_n_f32(0.0f);
+    const auto one          = vdupq_n_f32(1.0f);
+    const auto threshold    = vdupq_n_f32(g_srgbLinearThreshold);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        /* Evaluate both segments of the sRGB curve and select by threshold */
+        auto x      = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+        auto s1     = vsqrtq_f32(x);
+        auto s2     = vsqrtq_f32(s1);
+        auto s3     = vsqrtq_f32(s2);
+        auto curve  = vmulq_n_f32(s1, 0.662002687f);
+        curve       = vmlaq_n_f32(curve, s2, 0.684122060f);
+        curve       = vmlaq_n_f32(curve, s3, -0.323583601f);
+        curve       = vmlaq_n_f32(curve, x, -0.0225411470f);
+        auto s      = vbslq_f32(vcleq_f32(x, threshold), vmulq_n_f32(x, 12.92f), vminq_f32(curve, one));
+
+        /* Scale to [0, 255], round, and narrow into four bytes */
+        auto v32    = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(s, 255.0f), vdupq_n_f32(0.5f)));
+        auto v16    = vmovn_u32(v32);
+        auto v8     = vmovn_u16(vcombine_u16(v16, v16));
+        vst1_lane_u32(reinterpret_cast<std::uint32_t*>(dst + i), vreinterpret_u32_u8(v8), 0);
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = EncodeSRGB8(src[i]);
+
+    /* Replace alpha components by their linearly quantized values */
+    if (alphaIndex < numComponents)
+    {
+        for (auto j = alphaIndex; j < count; j += numComponents)
+            dst[j] = static_cast<std::uint8_t>(std::max(0.0f, std::min(src[j], 1.0f)) * 255.0f + 0.5f);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,51 @@
+/*
+ * ColorSpace.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COLOR_SPACE_H
+#define LLGL_COLOR_SPACE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/ImageFlags.h>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Returns the index of the alpha component within each pixel of the specified image format, or the number of components if the format has no alpha channel.
+LLGL_EXPORT std::size_t GetAlphaComponentIndex(const ImageFormat format);
+
+// Decodes the specified 8-bit sRGB value into a linear value in the range [0, 1]. This uses a lookup table.
+LLGL_EXPORT float DecodeSRGB8(std::uint8_t value);
+
+// Encodes the specified linear value into an 8-bit sRGB value. The value is clamped to [0, 1] and may differ by one step from the exact conversion.
+LLGL_EXPORT std::uint8_t EncodeSRGB8(float value);
+
+/*
+Decodes the specified array of 8-bit sRGB components into linear 32-bit floats in the range [0, 1].
+The component at 'alphaIndex' of each pixel is only normalized, since alpha is always stored linearly.
+*/
+LLGL_EXPORT void DecodeSRGB8Array(const std::uint8_t* src, float* dst, std::size_t count, std::size_t numComponents, std::size_t alphaIndex);
+
+/*
+Encodes the specified array of linear 32-bit floats into 8-bit sRGB components (see 'DecodeSRGB8Array').
+This uses a polynomial approximation of the sRGB curve with SSE2 instructions on x86 and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void EncodeSRGB8Array(const float* src, std::uint8_t* dst, std::size_t count, std::size_t numComponents, std::size_t alphaIndex);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,11 +7,86 @@
 
 #include "Float16Compressor.h"
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   if defined __F16C__
+#       define LLGL_FLOAT16_F16C
+#       define LLGL_TARGET_F16C
+#   elif defined __GNUC__ || defined __clang__
+#       define LLGL_FLOAT16_F16C
+#       define LLGL_FLOAT16_F16C_DISPATCH
+#       define LLGL_TARGET_F16C __attribute__((target("avx,f16c")))
+#       include <cpuid.h>
+#   elif defined _MSC_VER
+#       define LLGL_FLOAT16_F16C
+#       define LLGL_FLOAT16_F16C_DISPATCH
+#       define LLGL_TARGET_F16C
+#       include <intrin.h>
+#   endif
+#   include <immintrin.h>
+#elif (defined __ARM_NEON && defined __aarch64__) || defined _M_ARM64
+#   define LLGL_FLOAT16_NEON
+#   include <arm_neon.h>
+#endif
+
 
 namespace LLGL
 {
 
 
+#ifdef LLGL_FLOAT16_F16C_DISPATCH
+
+// Returns true if the CPU supports the F16C instructions and the OS preserves the AVX register state.
+static bool QueryF16CSupport()
+{
+    unsigned int ecx = 0;
+
+    #ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    ecx = static_cast<unsigned int>(info[2]);
+    #else
+    unsigned int eax = 0, ebx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    #endif
+
+    const unsigned int osxsaveBit   = (1u << 27);
+    const unsigned int avxBit       = (1u << 28);
+    const unsigned int f16cBit      = (1u << 29);
+
+    if ((ecx & (osxsaveBit | avxBit | f16cBit)) != (osxsaveBit | avxBit | f16cBit))
+        return false;
+
+    /* Check if XMM and YMM register states are enabled by the OS */
+    #ifdef _MSC_VER
+    const auto xcr0 = static_cast<unsigned long long>(_xgetbv(0));
+    #else
+    unsigned int xcr0Lo = 0, xcr0Hi = 0;
+    __asm__ __volatile__ ("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    const auto xcr0 = static_cast<unsigned long long>(xcr0Lo);
+    #endif
+
+    return ((xcr0 & 0x6) == 0x6);
+}
+
+#endif // /LLGL_FLOAT16_F16C_DISPATCH
+
+#ifdef LLGL_FLOAT16_F16C
+
+// Returns true if the F16C kernels can be used.
+static bool HasF16C()
+{
+    #ifdef LLGL_FLOAT16_F16C_DISPATCH
+    static const bool supported = QueryF16CSupport();
+    return supported;
+    #else
+    return true;
+    #endif
+}
+
+#endif // /LLGL_FLOAT16_F16C
+
+
 /*
 This class has been adopted from a public-domain code sample.
 see http://stackoverflow.com/questions/1659440/32-bit-to-16-bit-floating-point-conversion
@@ -58,8 +133,119 @@ class Float16Compressor
             return v.f;
         }
 
+        static void CompressArray(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+
+            #if defined LLGL_FLOAT16_F16C
+            if (HasF16C())
+                i = CompressArrayF16C(src, dst, count);
+            #elif defined LLGL_FLOAT16_NEON
+            i = CompressArrayNEON(src, dst, count);
+            #endif
+
+            for (; i < count; ++i)
+                dst[i] = Compress(src[i]);
+        }
+
+        static void DecompressArray(const std::uint16_t* src, float* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+
+            #if defined LLGL_FLOAT16_F16C
+            if (HasF16C())
+                i = DecompressArrayF16C(src, dst, count);
+            #elif defined LLGL_FLOAT16_NEON
+            for (; i + 4 <= count; i += 4)
+                vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+            #endif
+
+            for (; i < count; ++i)
+                dst[i] = Decompress(src[i]);
+        }
+
     private:
 
+        #if defined LLGL_FLOAT16_F16C
+
+        // Compresses 8 floats at a time and returns the number of converted elements.
+        LLGL_TARGET_F16C
+        static std::size_t CompressArrayF16C(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            const auto absMask  = _mm256_castsi256_ps(_mm256_set1_epi32(~signN));
+            const auto maxHalf  = _mm256_set1_ps(65504.0f);
+            const auto signHalf = _mm_set1_epi16(static_cast<short>(signC));
+            const auto infHalf  = _mm_set1_epi16(0x7c00);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                /* Round towards zero, to match the truncation of 'Compress' */
+                auto v = _mm256_loadu_ps(src + i);
+                auto h = _mm256_cvtps_ph(v, _MM_FROUND_TO_ZERO);
+
+                /* Map values beyond the maximal 16-bit normal to infinity (instead of clamping them), to match 'Compress' */
+                auto overflow   = _mm256_castps_si256(_mm256_cmp_ps(_mm256_and_ps(v, absMask), maxHalf, _CMP_GT_OQ));
+                auto overflow16 = _mm_packs_epi32(_mm256_castsi256_si128(overflow), _mm256_extractf128_si256(overflow, 1));
+                auto infSigned  = _mm_or_si128(_mm_and_si128(h, signHalf), infHalf);
+
+                h = _mm_or_si128(_mm_andnot_si128(overflow16, h), _mm_and_si128(overflow16, infSigned));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+            }
+
+            return i;
+        }
+
+        // Decompresses 8 floats at a time and returns the number of converted elements.
+        LLGL_TARGET_F16C
+        static std::size_t DecompressArrayF16C(const std::uint16_t* src, float* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+            return i;
+        }
+
+        #elif defined LLGL_FLOAT16_NEON
+
+        // Compresses 4 floats at a time with the same bit operations as 'Compress' and returns the number of converted elements.
+        static std::size_t CompressArrayNEON(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            const auto vsignN   = vdupq_n_s32(signN);
+            const auto vinfN    = vdupq_n_s32(infN);
+            const auto vnanN    = vdupq_n_s32(nanN);
+            const auto vmaxN    = vdupq_n_s32(maxN);
+            const auto vminN    = vdupq_n_s32(minN);
+            const auto vmaxC    = vdupq_n_s32(maxC);
+            const auto vsubC    = vdupq_n_s32(subC);
+            const auto vmaxD    = vdupq_n_s32(maxD);
+            const auto vminD    = vdupq_n_s32(minD);
+            const auto vmulN    = vreinterpretq_f32_s32(vdupq_n_s32(mulN));
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                auto v      = vreinterpretq_s32_f32(vld1q_f32(src + i));
+                auto sign   = vandq_s32(v, vsignN);
+                v = veorq_s32(v, sign);
+
+                auto s = vcvtq_s32_f32(vmulq_f32(vmulN, vreinterpretq_f32_s32(v))); // correct subnormals
+                v = vbslq_s32(vcgtq_s32(vminN, v), s, v);
+                v = vbslq_s32(vandq_u32(vcgtq_s32(vinfN, v), vcgtq_s32(v, vmaxN)), vinfN, v);
+                v = vbslq_s32(vandq_u32(vcgtq_s32(vnanN, v), vcgtq_s32(v, vinfN)), vnanN, v);
+                v = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), shift));
+                v = vbslq_s32(vcgtq_s32(v, vmaxC), vsubq_s32(v, vmaxD), v);
+                v = vbslq_s32(vcgtq_s32(v, vsubC), vsubq_s32(v, vminD), v);
+
+                auto h = vorrq_u32(vreinterpretq_u32_s32(v), vshrq_n_u32(vreinterpretq_u32_s32(sign), shiftSign));
+                vst1_u16(dst + i, vmovn_u32(h));
+            }
+
+            return i;
+        }
+
+        #endif
+
         union Bits
         {
             float           f;
@@ -103,6 +289,16 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    Float16Compressor::CompressArray(src, dst, count);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    Float16Compressor::DecompressArray(src, dst, count);
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/Export.h>
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -23,6 +24,16 @@ LLGL_EXPORT std::uint16_t CompressFloat16(float value);
 // Decompresses the specified 16-bit float (represented as 16-bit unsigned integer) into a 32-bit float.
 LLGL_EXPORT float DecompressFloat16(std::uint16_t value);
 
+/*
+Compresses the specified array of 32-bit floats into 16-bit floats. The results are identical to 'CompressFloat16',
+except for the payload bits of NaNs, which may differ between the vectorized and the scalar path (NaNs remain NaNs).
+This uses F16C instructions on x86 (if supported by the CPU, which is determined at runtime) and NEON instructions on ARM64.
+*/
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count);
+
+// Decompresses the specified array of 16-bit floats into 32-bit floats (see 'CompressFloat16Array').
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count);
+
 
 } // /namespace LLGL
 
@@ -45,6 +45,24 @@ LLGL_EXPORT std::vector<char> ReadFileBuffer(const char* filename)
     return buffer;
 }
 
+LLGL_EXPORT void AccumulateHash(std::uint64_t& hash, const void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+
+LLGL_EXPORT void AccumulateHash(std::uint64_t& hash, const char* str)
+{
+    /* Include null terminator, so consecutive strings can't be confused (e.g. "ab"+"c" vs. "a"+"bc") */
+    if (str == nullptr)
+        str = "";
+    AccumulateHash(hash, str, std::strlen(str) + 1);
+}
+
 
 } // /namespace LLGL
 
@@ -17,7 +17,6 @@
 #include <vector>
 #include <list>
 #include <algorithm>
-#include <set>
 #include <string>
 #include <cstring>
 #include <sstream>
@@ -118,29 +117,6 @@ void RemoveFromSharedList(std::vector<std::shared_ptr<T>>& cont, const TBase* en
     }
 }
 
-template <typename T, typename TBase>
-void RemoveFromUniqueSet(std::set<std::unique_ptr<T>>& cont, const TBase* entry)
-{
-    if (entry)
-    {
-        RemoveFromListIf(
-            cont,
-            [entry](const std::unique_ptr<T>& e)
-            {
-                return (e.get() == entry);
-            }
-        );
-    }
-}
-
-template <typename BaseType, typename SubType>
-SubType* TakeOwnership(std::set<std::unique_ptr<BaseType>>& objectSet, std::unique_ptr<SubType>&& object)
-{
-    auto ref = object.get();
-    objectSet.emplace(std::forward<std::unique_ptr<SubType>>(object));
-    return ref;
-}
-
 template <typename BaseType, typename SubType>
 SubType* TakeOwnership(std::vector<std::unique_ptr<BaseType>>& objectSet, std::unique_ptr<SubType>&& object)
 {
@@ -206,6 +182,15 @@ LLGL_EXPORT std::string ReadFileString(const char* filename);
 //! Reads the specified binary file into a buffer.
 LLGL_EXPORT std::vector<char> ReadFileBuffer(const char* filename);
 
+//! Initial value for the 'AccumulateHash' function (offset basis of the 64-bit FNV-1a hash function).
+static const std::uint64_t g_hashOffsetBasis = 0xcbf29ce484222325ull;
+
+//! Accumulates the specified data into the 64-bit FNV-1a hash value. This is only meant for cache keys, not for cryptographic purposes.
+LLGL_EXPORT void AccumulateHash(std::uint64_t& hash, const void* data, std::size_t size);
+
+//! Accumulates the specified null-terminated string including its terminator into the hash value. A null pointer is treated as empty string.
+LLGL_EXPORT void AccumulateHash(std::uint64_t& hash, const char* str);
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,76 @@
+/*
+ * HostAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "HostAllocator.h"
+#include <atomic>
+#include <new>
+
+
+namespace LLGL
+{
+
+
+// Header in front of each memory block, padded to keep the block aligned
+union HostMemoryHeader
+{
+    AllocatorInterface* allocator;
+    std::max_align_t    padding;
+};
+
+static std::atomic<AllocatorInterface*> g_hostAllocator { nullptr };
+
+LLGL_EXPORT void SetHostAllocator(AllocatorInterface* allocator)
+{
+    g_hostAllocator.store(allocator);
+}
+
+LLGL_EXPORT AllocatorInterface* GetHostAllocator()
+{
+    return g_hostAllocator.load();
+}
+
+LLGL_EXPORT void* AllocateHostMemory(std::size_t size)
+{
+    auto allocator = g_hostAllocator.load();
+
+    /* Allocate memory block with header */
+    void* block = nullptr;
+    if (allocator != nullptr)
+    {
+        block = allocator->Allocate(sizeof(HostMemoryHeader) + size, alignof(std::max_align_t));
+        if (block == nullptr)
+            throw std::bad_alloc();
+    }
+    else
+        block = ::operator new(sizeof(HostMemoryHeader) + size);
+
+    /* Store allocator in header and return memory behind it */
+    auto header = static_cast<HostMemoryHeader*>(block);
+    header->allocator = allocator;
+
+    return (header + 1);
+}
+
+LLGL_EXPORT void FreeHostMemory(void* ptr)
+{
+    if (ptr != nullptr)
+    {
+        /* Release memory block with the allocator it was allocated with */
+        auto header = static_cast<HostMemoryHeader*>(ptr) - 1;
+        if (auto allocator = header->allocator)
+            allocator->Free(header);
+        else
+            ::operator delete(header);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,45 @@
+/*
+ * HostAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_HOST_ALLOCATOR_H
+#define LLGL_HOST_ALLOCATOR_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/AllocatorInterface.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Sets the process-wide host allocator for subsequent allocations. Null restores the standard allocator.
+LLGL_EXPORT void SetHostAllocator(AllocatorInterface* allocator);
+
+// Returns the process-wide host allocator, or null if the standard allocator is used.
+LLGL_EXPORT AllocatorInterface* GetHostAllocator();
+
+/*
+Allocates host memory with the process-wide host allocator and the alignment of std::max_align_t.
+The allocator is stored in front of the memory block, so it is always released with the same allocator.
+Throws std::bad_alloc on failure.
+*/
+LLGL_EXPORT void* AllocateHostMemory(std::size_t size);
+
+// Releases host memory that was allocated with AllocateHostMemory.
+LLGL_EXPORT void FreeHostMemory(void* ptr);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,14 +6,78 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/Constants.h>
+#include "ThreadPool.h"
+#include "Assertion.h"
 #include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <cstdint>
 #include <string.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_IMAGE_SSE2
+#   include <emmintrin.h>
+#endif
+
 
 namespace LLGL
 {
 
 
+// Minimal number of bytes each thread copies at once in BitBlit
+static const std::size_t g_blitGrainSize = (256 * 1024);
+
+// Minimal number of bytes of a BitBlit operation to use non-temporal stores, so large regions do not evict the entire cache
+static const std::size_t g_blitStreamingSize = (4 * 1024 * 1024);
+
+// Copies the specified number of bytes, optionally with non-temporal stores for the destination (requires a call to FlushStreamingStores)
+static void CopyBytes(char* dst, const char* src, std::size_t size, bool streaming)
+{
+    #ifdef LLGL_IMAGE_SSE2
+    if (streaming)
+    {
+        /* Copy leading bytes until destination is aligned to 16 bytes */
+        const auto head = std::min(size, static_cast<std::size_t>((16u - (reinterpret_cast<std::uintptr_t>(dst) & 15u)) & 15u));
+        ::memcpy(dst, src, head);
+        dst     += head;
+        src     += head;
+        size    -= head;
+
+        /* Copy 64 bytes per iteration with non-temporal stores */
+        for (; size >= 64; size -= 64, dst += 64, src += 64)
+        {
+            const auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src     ));
+            const auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+            const auto v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+            const auto v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst     ), v0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), v1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), v2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), v3);
+        }
+
+        for (; size >= 16; size -= 16, dst += 16, src += 16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+    #endif // /LLGL_IMAGE_SSE2
+
+    ::memcpy(dst, src, size);
+}
+
+// Makes all non-temporal stores of the calling thread visible before other threads read the destination
+static void FlushStreamingStores(bool streaming)
+{
+    #ifdef LLGL_IMAGE_SSE2
+    if (streaming)
+        _mm_sfence();
+    #endif // /LLGL_IMAGE_SSE2
+}
+
+/*
+Copies the specified region row by row, or in larger blocks if rows or slices are contiguous.
+The region is split into bands of rows (or byte ranges) that are distributed among 'threadCount' threads.
+*/
 static void BitBlit(
     const Extent3D& copyExtent,
     std::uint32_t   bpp,
@@ -22,53 +86,339 @@ static void BitBlit(
     std::uint32_t   dstDepthStride,
     const char*     src,
     std::uint32_t   srcRowStride,
-    std::uint32_t   srcDepthStride)
+    std::uint32_t   srcDepthStride,
+    std::size_t     threadCount)
 {
-    const auto copyRowStride    = bpp * copyExtent.width;
+    const auto copyRowStride    = static_cast<std::size_t>(bpp) * copyExtent.width;
     const auto copyDepthStride  = copyRowStride * copyExtent.height;
+    const auto copySize         = copyDepthStride * copyExtent.depth;
+
+    if (copySize == 0)
+        return;
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    const bool streaming = (copySize >= g_blitStreamingSize);
+
+    if (srcRowStride == dstRowStride && copyRowStride == dstRowStride && srcDepthStride == dstDepthStride && copyDepthStride == dstDepthStride)
+    {
+        /* Copy entire region at once, split into byte ranges */
+        ThreadPool::Get().ParallelFor(
+            copySize, g_blitGrainSize, threadCount,
+            [=](std::size_t begin, std::size_t end)
+            {
+                CopyBytes(dst + begin, src + begin, end - begin, streaming);
+                FlushStreamingStores(streaming);
+            }
+        );
+    }
+    else
+    {
+        /* Copy entire slices at once if the rows of each slice are contiguous */
+        const bool          copySlices      = (srcRowStride == dstRowStride && copyRowStride == dstRowStride);
+        const std::size_t   numRowsPerSlice = (copySlices ? 1u : copyExtent.height);
+        const std::size_t   numRows         = numRowsPerSlice * copyExtent.depth;
+        const std::size_t   rowSize         = (copySlices ? copyDepthStride : copyRowStride);
+        const std::size_t   grainSize       = std::max<std::size_t>(1u, g_blitGrainSize / rowSize);
+
+        ThreadPool::Get().ParallelFor(
+            numRows, grainSize, threadCount,
+            [=](std::size_t begin, std::size_t end)
+            {
+                for (auto row = begin; row < end; ++row)
+                {
+                    /* Copy current row (or slice) */
+                    const auto z = row / numRowsPerSlice;
+                    const auto y = row % numRowsPerSlice;
+                    CopyBytes(
+                        dst + z * dstDepthStride + y * dstRowStride,
+                        src + z * srcDepthStride + y * srcRowStride,
+                        rowSize,
+                        streaming
+                    );
+                }
+                FlushStreamingStores(streaming);
+            }
+        );
+    }
+}
+
+/* ----- Image view functions ----- */
+
+static std::size_t GetImageViewDataOffset(const ImageView& imageView, const Offset3D& offset)
+{
+    return
+    (
+        static_cast<std::size_t>(offset.x) * imageView.GetBytesPerPixel() +
+        static_cast<std::size_t>(offset.y) * imageView.GetRowStride() +
+        static_cast<std::size_t>(offset.z) * imageView.GetDepthStride()
+    );
+}
+
+LLGL_EXPORT ImageView GetSubImageView(const ImageView& imageView, const Offset3D& offset, const Extent3D& extent)
+{
+    return ImageView
+    {
+        imageView.format,
+        imageView.dataType,
+        reinterpret_cast<const char*>(imageView.data) + GetImageViewDataOffset(imageView, offset),
+        extent,
+        imageView.GetRowStride(),
+        imageView.GetDepthStride()
+    };
+}
+
+LLGL_EXPORT MutableImageView GetSubImageView(const MutableImageView& imageView, const Offset3D& offset, const Extent3D& extent)
+{
+    return MutableImageView
+    {
+        imageView.format,
+        imageView.dataType,
+        reinterpret_cast<char*>(imageView.data) + GetImageViewDataOffset(imageView, offset),
+        extent,
+        imageView.GetRowStride(),
+        imageView.GetDepthStride()
+    };
+}
 
-    if (srcRowStride == dstRowStride && copyRowStride == dstRowStride)
+static bool ShiftNegative1DRegion(std::int32_t& dstOffset, std::uint32_t dstExtent, std::int32_t& srcOffset, std::uint32_t& srcExtent)
+{
+    if (dstOffset < 0)
     {
-        if (srcDepthStride == dstDepthStride && copyDepthStride && dstDepthStride)
+        auto dstOffsetInv = static_cast<std::uint32_t>(-dstOffset);
+        if (dstOffsetInv < srcExtent)
         {
-            /* Copy region directly into output data */
-            ::memcpy(dst, src, copyDepthStride * copyExtent.depth);
+            /* Reduce source region extent, and clamp destination offset to zero */
+            srcExtent -= dstOffsetInv;
+            srcOffset -= dstOffset;
+            dstOffset = 0;
         }
         else
         {
-            /* Copy region directly into output data */
-            for (std::uint32_t z = 0; z < copyExtent.depth; ++z)
-            {
-                /* Copy current slice */
-                ::memcpy(dst, src, copyDepthStride);
+            /* Shift operation will set the extent to zero, so no blitting is necessary */
+            return false;
+        }
+    }
 
-                /* Move pointers to next slice */
-                dst += dstDepthStride;
-                src += srcDepthStride;
-            }
+    if (static_cast<std::uint32_t>(dstOffset) + srcExtent > dstExtent)
+    {
+        auto shift = static_cast<std::uint32_t>(dstOffset) + srcExtent - dstExtent;
+        if (shift < srcExtent)
+        {
+            /* Reduce source region extent */
+            srcExtent -= shift;
+        }
+        else
+        {
+            /* Shift operation will set the extent to zero, so no blitting is necessary */
+            return false;
         }
     }
-    else
+
+    return true;
+}
+
+static bool Overlap1DRegion(std::int32_t dstOffset, std::int32_t srcOffset, std::uint32_t extent)
+{
+    auto dstOffsetMin = static_cast<std::uint32_t>(dstOffset);
+    auto dstOffsetMax = dstOffsetMin + extent;
+
+    auto srcOffsetMin = static_cast<std::uint32_t>(srcOffset);
+    auto srcOffsetMax = srcOffsetMin + extent;
+
+    return (dstOffsetMin <= srcOffsetMax && dstOffsetMax >= srcOffsetMin);
+}
+
+static bool Overlap3DRegion(const Offset3D& dstOffset, const Offset3D& srcOffset, const Extent3D& extent)
+{
+    return
+    (
+        Overlap1DRegion(dstOffset.x, srcOffset.x, extent.width ) &&
+        Overlap1DRegion(dstOffset.y, srcOffset.y, extent.height) &&
+        Overlap1DRegion(dstOffset.z, srcOffset.z, extent.depth )
+    );
+}
+
+// Clamps the offset and extent of the region to the specified 1D limit, and returns false if the region is empty
+static bool Clamp1DRegion(std::int32_t& offset, std::uint32_t& extent, std::uint32_t limit)
+{
+    if (offset < 0)
     {
-        /* Adjust depth stride */
-        srcDepthStride -= srcRowStride * copyExtent.height;
+        const auto offsetInv = static_cast<std::uint32_t>(-offset);
+        if (offsetInv >= extent)
+            return false;
+        extent -= offsetInv;
+        offset = 0;
+    }
+
+    if (static_cast<std::uint32_t>(offset) >= limit)
+        return false;
+
+    extent = std::min(extent, limit - static_cast<std::uint32_t>(offset));
+
+    return (extent > 0);
+}
+
+// Clamps the source region to the source extent, then shifts the destination region into the destination extent
+static bool ClampBlitRegion(
+    Offset3D&       dstRegionOffset,
+    const Extent3D& dstExtent,
+    Offset3D&       srcRegionOffset,
+    const Extent3D& srcExtent,
+    Extent3D&       srcRegionExtent)
+{
+    return
+    (
+        Clamp1DRegion(srcRegionOffset.x, srcRegionExtent.width,  srcExtent.width ) &&
+        Clamp1DRegion(srcRegionOffset.y, srcRegionExtent.height, srcExtent.height) &&
+        Clamp1DRegion(srcRegionOffset.z, srcRegionExtent.depth,  srcExtent.depth ) &&
+        ShiftNegative1DRegion(dstRegionOffset.x, dstExtent.width,  srcRegionOffset.x, srcRegionExtent.width ) &&
+        ShiftNegative1DRegion(dstRegionOffset.y, dstExtent.height, srcRegionOffset.y, srcRegionExtent.height) &&
+        ShiftNegative1DRegion(dstRegionOffset.z, dstExtent.depth,  srcRegionOffset.z, srcRegionExtent.depth )
+    );
+}
+
+LLGL_EXPORT bool BlitImageView(
+    const MutableImageView& dstView,
+    Offset3D                dstRegionOffset,
+    const ImageView&        srcView,
+    Offset3D                srcRegionOffset,
+    Extent3D                srcRegionExtent,
+    std::size_t             threadCount)
+{
+    if (dstView.format != srcView.format || dstView.dataType != srcView.dataType || !dstView.data || !srcView.data)
+        return false;
+
+    if (!ClampBlitRegion(dstRegionOffset, dstView.extent, srcRegionOffset, srcView.extent, srcRegionExtent))
+        return false;
+
+    const auto dst = GetSubImageView(dstView, dstRegionOffset, srcRegionExtent);
+    const auto src = GetSubImageView(srcView, srcRegionOffset, srcRegionExtent);
+
+    BitBlit(
+        srcRegionExtent, src.GetBytesPerPixel(),
+        reinterpret_cast<char*>(dst.data), dst.rowStride, dst.depthStride,
+        reinterpret_cast<const char*>(src.data), src.rowStride, src.depthStride,
+        threadCount
+    );
+
+    return true;
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const ImageView&        srcView,
+    const MutableImageView& dstView,
+    std::size_t             threadCount)
+{
+    /* Validate input parameters */
+    if (srcView.extent != dstView.extent)
+        throw std::invalid_argument("cannot convert image view into image view of different extent");
+    LLGL_ASSERT_PTR(srcView.data);
+    LLGL_ASSERT_PTR(dstView.data);
+
+    if (srcView.format == dstView.format && srcView.dataType == dstView.dataType)
+        return false;
+
+    const auto& extent = srcView.extent;
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        return true;
+
+    if (srcView.IsTightlyPacked() && ImageView{ dstView }.IsTightlyPacked())
+    {
+        /* Convert entire image buffer at once */
+        const std::size_t numPixels = extent.width * extent.height * extent.depth;
+        return ConvertImageBuffer(
+            SrcImageDescriptor{ srcView.format, srcView.dataType, srcView.data, numPixels * srcView.GetBytesPerPixel() },
+            DstImageDescriptor{ dstView.format, dstView.dataType, dstView.data, numPixels * dstView.GetBytesPerPixel() },
+            threadCount
+        );
+    }
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Convert image view row by row, and distribute the rows among all threads */
+    const std::size_t   numRows         = extent.height * extent.depth;
+    const std::size_t   srcRowSize      = srcView.GetBytesPerPixel() * extent.width;
+    const std::size_t   dstRowSize      = dstView.GetBytesPerPixel() * extent.width;
+    const std::size_t   srcRowStride    = srcView.GetRowStride();
+    const std::size_t   srcDepthStride  = srcView.GetDepthStride();
+    const std::size_t   dstRowStride    = dstView.GetRowStride();
+    const std::size_t   dstDepthStride  = dstView.GetDepthStride();
+    const auto          src             = reinterpret_cast<const char*>(srcView.data);
+    const auto          dst             = reinterpret_cast<char*>(dstView.data);
+
+    ThreadPool::Get().ParallelFor(
+        numRows, std::max<std::size_t>(1u, g_blitGrainSize / std::max(srcRowSize, dstRowSize)), threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto row = begin; row < end; ++row)
+            {
+                const auto z = row / extent.height;
+                const auto y = row % extent.height;
+                ConvertImageBuffer(
+                    SrcImageDescriptor{ srcView.format, srcView.dataType, src + z * srcDepthStride + y * srcRowStride, srcRowSize },
+                    DstImageDescriptor{ dstView.format, dstView.dataType, dst + z * dstDepthStride + y * dstRowStride, dstRowSize },
+                    0
+                );
+            }
+        }
+    );
+
+    return true;
+}
 
-        /* Copy region directly into output data */
-        for (std::uint32_t z = 0; z < copyExtent.depth; ++z)
+LLGL_EXPORT void MirrorImageView(const MutableImageView& imageView, bool mirrorX, bool mirrorY, bool mirrorZ)
+{
+    if (!imageView.data)
+        return;
+
+    const auto&         extent      = imageView.extent;
+    const std::size_t   bpp         = imageView.GetBytesPerPixel();
+    const std::size_t   rowSize     = bpp * extent.width;
+    const std::size_t   rowStride   = imageView.GetRowStride();
+    const std::size_t   depthStride = imageView.GetDepthStride();
+    const auto          data        = reinterpret_cast<char*>(imageView.data);
+
+    if (mirrorX)
+    {
+        /* Swap pixels of each row */
+        for (std::uint32_t z = 0; z < extent.depth; ++z)
         {
-            /* Copy current slice */
-            for (std::uint32_t y = 0; y < copyExtent.height; ++y)
+            for (std::uint32_t y = 0; y < extent.height; ++y)
             {
-                /* Copy current row */
-                ::memcpy(dst, src, copyRowStride);
+                auto row = data + z * depthStride + y * rowStride;
+                for (std::uint32_t x = 0; x < extent.width / 2; ++x)
+                    std::swap_ranges(row + x * bpp, row + (x + 1) * bpp, row + (extent.width - 1 - x) * bpp);
+            }
+        }
+    }
 
-                /* Move pointers to next row */
-                dst += dstRowStride;
-                src += srcRowStride;
+    if (mirrorY)
+    {
+        /* Swap rows of each depth slice */
+        for (std::uint32_t z = 0; z < extent.depth; ++z)
+        {
+            auto slice = data + z * depthStride;
+            for (std::uint32_t y = 0; y < extent.height / 2; ++y)
+            {
+                auto row = slice + y * rowStride;
+                std::swap_ranges(row, row + rowSize, slice + (extent.height - 1 - y) * rowStride);
             }
+        }
+    }
 
-            /* Move pointers to next slice */
-            src += srcDepthStride;
+    if (mirrorZ)
+    {
+        /* Swap depth slices row by row */
+        for (std::uint32_t z = 0; z < extent.depth / 2; ++z)
+        {
+            for (std::uint32_t y = 0; y < extent.height; ++y)
+            {
+                auto row = data + z * depthStride + y * rowStride;
+                std::swap_ranges(row, row + rowSize, data + (extent.depth - 1 - z) * depthStride + y * rowStride);
+            }
         }
     }
 }
@@ -206,9 +556,118 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
     }
 }
 
-void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
+void Image::Resize(const Extent3D& extent, const SamplerFilter filter, std::size_t threadCount)
+{
+    if (filter == SamplerFilter::Nearest)
+        Resize(extent, ImageResizeFilter::Nearest, threadCount);
+    else
+        Resize(extent, ImageResizeFilter::Bilinear, threadCount);
+}
+
+void Image::Resize(const Extent3D& extent, const ImageResizeFilter filter, std::size_t threadCount, const ImageColorSpace colorSpace)
+{
+    if (extent != GetExtent())
+    {
+        if (data_ && GetNumPixels() > 0 && extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            /* Resample previous image buffer into new image buffer */
+            auto data = GenerateEmptyByteBuffer(ImageDataSize(GetFormat(), GetDataType(), extent.width * extent.height * extent.depth), false);
+            ResizeImageView(GetView(), MutableImageView{ GetFormat(), GetDataType(), data.get(), extent }, filter, threadCount, colorSpace);
+
+            extent_ = extent;
+            data_   = std::move(data);
+        }
+        else
+        {
+            /* Nothing to resample */
+            Resize(extent);
+        }
+    }
+}
+
+// Returns the extent of the specified MIP level for an image with the specified extent (dimensions that denote array layers are not reduced)
+static Extent3D GetImageMipExtent(const TextureType textureType, const Extent3D& extent, std::uint32_t mipLevel)
+{
+    switch (textureType)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return { std::max(1u, extent.width >> mipLevel), extent.height, extent.depth };
+
+        case TextureType::Texture3D:
+            return { std::max(1u, extent.width >> mipLevel), std::max(1u, extent.height >> mipLevel), std::max(1u, extent.depth >> mipLevel) };
+
+        default:
+            return { std::max(1u, extent.width >> mipLevel), std::max(1u, extent.height >> mipLevel), extent.depth };
+    }
+}
+
+// Returns the number of MIP levels for an image with the specified extent
+static std::uint32_t GetImageNumMipLevels(const TextureType textureType, const Extent3D& extent)
 {
-    //todo
+    switch (textureType)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return NumMipLevels(extent.width);
+
+        case TextureType::Texture3D:
+            return NumMipLevels(extent.width, extent.height, extent.depth);
+
+        default:
+            return NumMipLevels(extent.width, extent.height);
+    }
+}
+
+ImageMipChain Image::GenerateMipChain(
+    const TextureType       textureType,
+    const ImageResizeFilter filter,
+    std::uint32_t           numMipLevels,
+    std::size_t             threadCount,
+    const ImageColorSpace   colorSpace) const
+{
+    if (IsMultiSampleTexture(textureType))
+        throw std::invalid_argument("cannot generate MIP-map chain for multi-sampled texture type");
+    if (IsCompressedFormat(GetFormat()) || GetFormat() == ImageFormat::DepthStencil)
+        throw std::invalid_argument("cannot generate MIP-map chain for image with compressed or depth-stencil format");
+
+    ImageMipChain mipChain;
+    {
+        mipChain.format     = GetFormat();
+        mipChain.dataType   = GetDataType();
+    }
+
+    if (!data_ || GetNumPixels() == 0)
+        return mipChain;
+
+    /* Determine extent and offset of each MIP level */
+    const auto maxNumMipLevels = GetImageNumMipLevels(textureType, GetExtent());
+    numMipLevels = (numMipLevels == 0 ? maxNumMipLevels : std::min(numMipLevels, maxNumMipLevels));
+
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto extent = GetImageMipExtent(textureType, GetExtent(), mipLevel);
+        mipChain.mipOffsets.push_back(mipChain.dataSize);
+        mipChain.mipExtents.push_back(extent);
+        mipChain.dataSize += ImageDataSize(GetFormat(), GetDataType(), extent.width * extent.height * extent.depth);
+    }
+
+    /* Copy first MIP level, then resample each MIP level from its previous MIP level */
+    mipChain.data = GenerateEmptyByteBuffer(mipChain.dataSize, false);
+    ::memcpy(mipChain.data.get(), data_.get(), GetDataSize());
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        ResizeImageView(
+            ImageView{ GetFormat(), GetDataType(), mipChain.data.get() + mipChain.mipOffsets[mipLevel - 1], mipChain.mipExtents[mipLevel - 1] },
+            MutableImageView{ GetFormat(), GetDataType(), mipChain.data.get() + mipChain.mipOffsets[mipLevel], mipChain.mipExtents[mipLevel] },
+            filter,
+            threadCount,
+            colorSpace
+        );
+    }
+
+    return mipChain;
 }
 
 void Image::Swap(Image& rhs)
@@ -241,104 +700,42 @@ ByteBuffer Image::Release()
 
 /* ----- Pixels ----- */
 
-static bool ShiftNegative1DRegion(std::int32_t& dstOffset, std::uint32_t dstExtent, std::int32_t& srcOffset, std::uint32_t& srcExtent)
+void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount)
 {
-    if (dstOffset < 0)
-    {
-        auto dstOffsetInv = static_cast<std::uint32_t>(-dstOffset);
-        if (dstOffsetInv < srcExtent)
-        {
-            /* Reduce source region extent, and clamp destination offset to zero */
-            srcExtent -= dstOffsetInv;
-            srcOffset -= dstOffset;
-            dstOffset = 0;
-        }
-        else
-        {
-            /* Shift operation will set the extent to zero, so no blitting is necessary */
-            return false;
-        }
-    }
-
-    if (static_cast<std::uint32_t>(dstOffset) + srcExtent > dstExtent)
-    {
-        auto shift = static_cast<std::uint32_t>(dstOffset) + srcExtent - dstExtent;
-        if (shift < srcExtent)
-        {
-            /* Reduce source region extent */
-            srcExtent -= shift;
-        }
-        else
-        {
-            /* Shift operation will set the extent to zero, so no blitting is necessary */
-            return false;
-        }
-    }
-
-    return true;
+    Blit(dstRegionOffset, srcImage.GetView(), srcRegionOffset, srcRegionExtent, threadCount);
 }
 
-static bool Overlap1DRegion(std::int32_t dstOffset, std::int32_t srcOffset, std::uint32_t extent)
+void Image::Blit(Offset3D dstRegionOffset, const ImageView& srcView, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount)
 {
-    auto dstOffsetMin = static_cast<std::uint32_t>(dstOffset);
-    auto dstOffsetMax = dstOffsetMin + extent;
-
-    auto srcOffsetMin = static_cast<std::uint32_t>(srcOffset);
-    auto srcOffsetMax = srcOffsetMin + extent;
-
-    return (dstOffsetMin <= srcOffsetMax && dstOffsetMax >= srcOffsetMin);
-}
+    if (GetFormat() == srcView.format && GetDataType() == srcView.dataType && data_ && srcView.data)
+    {
+        /* Clamp source and destination regions */
+        if (ClampBlitRegion(dstRegionOffset, GetExtent(), srcRegionOffset, srcView.extent, srcRegionExtent))
+        {
+            auto srcRegion = GetSubImageView(srcView, srcRegionOffset, srcRegionExtent);
 
-static bool Overlap3DRegion(const Offset3D& dstOffset, const Offset3D& srcOffset, const Extent3D& extent)
-{
-    return
-    (
-        Overlap1DRegion(dstOffset.x, srcOffset.x, extent.width ) &&
-        Overlap1DRegion(dstOffset.y, srcOffset.y, extent.height) &&
-        Overlap1DRegion(dstOffset.z, srcOffset.z, extent.depth )
-    );
-}
+            /* Check if a temporary copy of the source region must be allocated */
+            Image srcRegionTemp;
 
-void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent)
-{
-    if (GetFormat() == srcImage.GetFormat() && GetDataType() == srcImage.GetDataType())
-    {
-        /* First clamp source region to source image dimension */
-        srcImage.ClampRegion(srcRegionOffset, srcRegionExtent);
+            const auto srcBegin = reinterpret_cast<const char*>(srcView.data);
+            const auto srcEnd   = srcBegin + static_cast<std::size_t>(srcView.GetDepthStride()) * srcView.extent.depth;
+            const auto dstBegin = data_.get();
+            const auto dstEnd   = dstBegin + GetDataSize();
 
-        /* Then shift negative destination region */
-        if ( ShiftNegative1DRegion(dstRegionOffset.x, GetExtent().width,  srcRegionOffset.x, srcRegionExtent.width ) &&
-             ShiftNegative1DRegion(dstRegionOffset.y, GetExtent().height, srcRegionOffset.y, srcRegionExtent.height) &&
-             ShiftNegative1DRegion(dstRegionOffset.z, GetExtent().depth,  srcRegionOffset.z, srcRegionExtent.depth ) )
-        {
-            /* Check if a temporary copy of the source image must be allocated */
-            Image srcImageTemp;
-            const Image* srcImageRef = &srcImage;
+            bool overlap = (srcBegin < dstEnd && dstBegin < srcEnd);
+            if (overlap && srcBegin == dstBegin && srcView.extent == GetExtent() && srcView.IsTightlyPacked())
+                overlap = Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent);
 
-            if (srcImageRef == this && Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent))
+            if (overlap)
             {
-                /* Copy source image */
-                srcImageTemp = *this;
-                srcImageRef = &srcImageTemp;
+                /* Copy source region into tightly packed temporary image */
+                srcRegionTemp = Image{ srcRegionExtent, GetFormat(), GetDataType() };
+                BlitImageView(srcRegionTemp.GetView(), { 0, 0, 0 }, srcRegion, { 0, 0, 0 }, srcRegionExtent, threadCount);
+                srcRegion = srcRegionTemp.GetView();
             }
 
-            /* Get destination image parameters */
-            const auto  bpp             = GetBytesPerPixel();
-            const auto  dstRowStride    = bpp * GetExtent().width;
-            const auto  dstDepthStride  = dstRowStride * GetExtent().height;
-            auto        dst             = data_.get() + GetDataPtrOffset(dstRegionOffset);
-
-            /* Get source image parameters */
-            const auto  srcRowStride    = bpp * srcImageRef->GetExtent().width;
-            const auto  srcDepthStride  = srcRowStride * srcImageRef->GetExtent().height;
-            auto        src             = srcImageRef->data_.get() + srcImageRef->GetDataPtrOffset(srcRegionOffset);
-
-            /* Blit source image into region */
-            BitBlit(
-                srcRegionExtent, bpp,
-                dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
-            );
+            /* Blit source region into this image */
+            BlitImageView(GetView(), dstRegionOffset, srcRegion, { 0, 0, 0 }, srcRegionExtent, threadCount);
         }
     }
 }
@@ -403,7 +800,8 @@ void Image::ReadPixels(const Offset3D& offset, const Extent3D& extent, const Dst
             BitBlit(
                 extent, bpp,
                 dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
+                src, srcRowStride, srcDepthStride,
+                threadCount
             );
         }
         else
@@ -414,7 +812,8 @@ void Image::ReadPixels(const Offset3D& offset, const Extent3D& extent, const Dst
             BitBlit(
                 extent, bpp,
                 reinterpret_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
-                src, srcRowStride, srcDepthStride
+                src, srcRowStride, srcDepthStride,
+                threadCount
             );
 
             /* Convert sub-image */
@@ -450,7 +849,8 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Sr
             BitBlit(
                 extent, bpp,
                 dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
+                src, srcRowStride, srcDepthStride,
+                threadCount
             );
         }
         else
@@ -466,7 +866,8 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Sr
             BitBlit(
                 extent, bpp,
                 dst, dstRowStride, dstDepthStride,
-                reinterpret_cast<const char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride()
+                reinterpret_cast<const char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
+                threadCount
             );
         }
     }
@@ -474,17 +875,17 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Sr
 
 void Image::MirrorYZPlane()
 {
-    //TODO
+    MirrorImageView(GetView(), true, false, false);
 }
 
 void Image::MirrorXZPlane()
 {
-    //TODO
+    MirrorImageView(GetView(), false, true, false);
 }
 
 void Image::MirrorXYPlane()
 {
-    //TODO
+    MirrorImageView(GetView(), false, false, true);
 }
 
 /* ----- Attributes ----- */
@@ -513,6 +914,16 @@ DstImageDescriptor Image::QueryDstDesc()
     return imageDesc;
 }
 
+ImageView Image::GetView() const
+{
+    return ImageView{ GetFormat(), GetDataType(), GetData(), GetExtent() };
+}
+
+MutableImageView Image::GetView()
+{
+    return MutableImageView{ GetFormat(), GetDataType(), GetData(), GetExtent() };
+}
+
 std::uint32_t Image::GetBytesPerPixel() const
 {
     return (ImageFormatSize(format_) * DataTypeSize(dataType_));
@@ -576,17 +987,6 @@ std::size_t Image::GetDataPtrOffset(const Offset3D& offset) const
     return (bpp * (x + (y + z * h) * w));
 }
 
-void Image::ClampRegion(Offset3D& offset, Extent3D& extent) const
-{
-    offset.x        = std::max(offset.x, 0);
-    offset.y        = std::max(offset.y, 0);
-    offset.z        = std::max(offset.z, 0);
-
-    extent.width    = std::min(extent.width, GetExtent().width);
-    extent.height   = std::min(extent.height, GetExtent().height);
-    extent.depth    = std::min(extent.depth, GetExtent().depth);
-}
-
 
 } // /namespace LLGL
 
@@ -0,0 +1,725 @@
+/*
+ * ImageCompressor.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Constants.h>
+#include "ThreadPool.h"
+#include "Assertion.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Block of 4x4 pixels with 8-bit RGBA components, which is the input of all block encoders.
+struct BlockRGBA8
+{
+    std::uint8_t pixels[16][4];
+};
+
+// Function that encodes a single block of 4x4 pixels into the destination block.
+using BlockEncoder = void (*)(const BlockRGBA8& block, std::uint8_t* dst);
+
+// Writes bit fields into a zero-initialized block, beginning with the least significant bit of the first byte.
+struct BlockBitWriter
+{
+    void Write(std::uint32_t value, std::uint32_t numBits)
+    {
+        for (std::uint32_t i = 0; i < numBits; ++i, ++pos)
+        {
+            if (((value >> i) & 0x1) != 0)
+                data[pos >> 3] |= static_cast<std::uint8_t>(1u << (pos & 0x7));
+        }
+    }
+
+    std::uint8_t*   data;
+    std::uint32_t   pos;
+};
+
+// Number of blocks each task of the thread pool processes (smaller images are compressed on the calling thread only)
+static const std::size_t g_compressGrainSize = 64;
+
+// Interpolation weights (in 64ths) of the 4-bit indices of BC7
+static const std::uint32_t g_bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+/* ----- Endpoint fitting ----- */
+
+template <typename T>
+static T ClampComponent(T value, T maxValue)
+{
+    return std::max(T(0), std::min(value, maxValue));
+}
+
+/*
+Computes two endpoints along the principal axis of the specified points, which is determined with power iteration over the covariance matrix.
+The endpoints are the extreme projections of the points onto the axis, so all points lie between them.
+*/
+template <std::size_t N>
+static void FitEndpointsPCA(const float (&points)[16][N], std::size_t numPoints, float (&e0)[N], float (&e1)[N])
+{
+    float mean[N] = {};
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        for (std::size_t c = 0; c < N; ++c)
+            mean[c] += points[i][c];
+    }
+    for (std::size_t c = 0; c < N; ++c)
+        mean[c] /= static_cast<float>(numPoints);
+
+    /* Accumulate covariance matrix */
+    float cov[N][N] = {};
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        float d[N];
+        for (std::size_t c = 0; c < N; ++c)
+            d[c] = points[i][c] - mean[c];
+        for (std::size_t a = 0; a < N; ++a)
+        {
+            for (std::size_t b = 0; b < N; ++b)
+                cov[a][b] += d[a] * d[b];
+        }
+    }
+
+    /* Find principal axis with power iteration */
+    float axis[N];
+    for (std::size_t c = 0; c < N; ++c)
+        axis[c] = 1.0f;
+
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[N] = {};
+        float maxComponent = 0.0f;
+        for (std::size_t a = 0; a < N; ++a)
+        {
+            for (std::size_t b = 0; b < N; ++b)
+                next[a] += cov[a][b] * axis[b];
+            maxComponent = std::max(maxComponent, std::abs(next[a]));
+        }
+
+        if (maxComponent < 1.0e-6f)
+        {
+            /* All points are equal (or the axis is orthogonal to the variance) */
+            for (std::size_t c = 0; c < N; ++c)
+                e0[c] = e1[c] = mean[c];
+            return;
+        }
+
+        for (std::size_t c = 0; c < N; ++c)
+            axis[c] = next[c] / maxComponent;
+    }
+
+    /* Project points onto axis */
+    float minProj = 0.0f, maxProj = 0.0f;
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        float proj = 0.0f;
+        for (std::size_t c = 0; c < N; ++c)
+            proj += (points[i][c] - mean[c]) * axis[c];
+        minProj = std::min(minProj, proj);
+        maxProj = std::max(maxProj, proj);
+    }
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        e0[c] = ClampComponent(mean[c] + axis[c] * minProj, 255.0f);
+        e1[c] = ClampComponent(mean[c] + axis[c] * maxProj, 255.0f);
+    }
+}
+
+/*
+Refits the endpoints with a least-squares solution for the specified interpolation weights of each point,
+i.e. minimizes the error of 'points[i] ~ (1 - weights[i]) * e0 + weights[i] * e1'. Returns false if the system is singular.
+*/
+template <std::size_t N>
+static bool RefitEndpoints(const float (&points)[16][N], const float* weights, std::size_t numPoints, float (&e0)[N], float (&e1)[N])
+{
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[N] = {}, bx[N] = {};
+
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        const auto b = weights[i];
+        const auto a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            ax[c] += a * points[i][c];
+            bx[c] += b * points[i][c];
+        }
+    }
+
+    const auto det = aa * bb - ab * ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    const auto invDet = 1.0f / det;
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        e0[c] = ClampComponent((ax[c] * bb - bx[c] * ab) * invDet, 255.0f);
+        e1[c] = ClampComponent((bx[c] * aa - ax[c] * ab) * invDet, 255.0f);
+    }
+
+    return true;
+}
+
+
+/* ----- BC1 color blocks ----- */
+
+static std::uint16_t PackRGB565(const float (&color)[3])
+{
+    const auto r = ClampComponent(static_cast<int>(color[0] * (31.0f / 255.0f) + 0.5f), 31);
+    const auto g = ClampComponent(static_cast<int>(color[1] * (63.0f / 255.0f) + 0.5f), 63);
+    const auto b = ClampComponent(static_cast<int>(color[2] * (31.0f / 255.0f) + 0.5f), 31);
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(std::uint16_t value, int (&color)[3])
+{
+    const int r = (value >> 11) & 0x1F;
+    const int g = (value >>  5) & 0x3F;
+    const int b = (value      ) & 0x1F;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Color palette, indices, and error of an encoded BC1 color block.
+struct BC1ColorBlock
+{
+    std::uint16_t   color0;
+    std::uint16_t   color1;
+    std::uint8_t    indices[16];
+    float           error;
+};
+
+// Selects the nearest palette entry for each pixel; transparent pixels get index 3 in 3-color mode.
+static void FindBC1Indices(const float (&points)[16][3], std::uint32_t transparentMask, bool threeColorMode, BC1ColorBlock& result)
+{
+    int c0[3], c1[3], palette[4][3];
+    UnpackRGB565(result.color0, c0);
+    UnpackRGB565(result.color1, c1);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[0][c] = c0[c];
+        palette[1][c] = c1[c];
+        if (threeColorMode)
+        {
+            palette[2][c] = (c0[c] + c1[c]) / 2;
+            palette[3][c] = 0;
+        }
+        else
+        {
+            palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+            palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+        }
+    }
+
+    const int numColors = (threeColorMode ? 3 : 4);
+    result.error = 0.0f;
+
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        if (((transparentMask >> i) & 0x1) != 0)
+        {
+            result.indices[i] = 3;
+            continue;
+        }
+
+        float minError = 0.0f;
+        for (int j = 0; j < numColors; ++j)
+        {
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c)
+            {
+                const auto d = points[i][c] - static_cast<float>(palette[j][c]);
+                error += d * d;
+            }
+            if (j == 0 || error < minError)
+            {
+                minError            = error;
+                result.indices[i]   = static_cast<std::uint8_t>(j);
+            }
+        }
+        result.error += minError;
+    }
+}
+
+// Quantizes the endpoints, orders them for the respective mode, and selects the indices.
+static void QuantizeBC1ColorBlock(
+    const float (&points)[16][3],
+    const float (&e0)[3],
+    const float (&e1)[3],
+    std::uint32_t   transparentMask,
+    BC1ColorBlock&  result)
+{
+    const bool threeColorMode = (transparentMask != 0);
+
+    result.color0 = PackRGB565(e0);
+    result.color1 = PackRGB565(e1);
+
+    /* 4-color mode requires color0 > color1, 3-color mode requires color0 <= color1 */
+    if (threeColorMode ? (result.color0 > result.color1) : (result.color0 < result.color1))
+        std::swap(result.color0, result.color1);
+
+    /* Equal endpoints are decoded in 3-color mode, where all opaque pixels take the first color */
+    FindBC1Indices(points, transparentMask, threeColorMode || result.color0 == result.color1, result);
+}
+
+/*
+Encodes the RGB components of the block into an 8-byte BC1 color block.
+If 'punchThrough' is true, pixels with an alpha value below 128 are encoded as transparent black in 3-color mode.
+*/
+static void EncodeBC1ColorBlock(const BlockRGBA8& block, std::uint8_t* dst, bool punchThrough)
+{
+    /* Gather opaque pixels */
+    float points[16][3];
+    std::uint32_t transparentMask = 0;
+    std::size_t numOpaque = 0;
+
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+            points[i][c] = static_cast<float>(block.pixels[i][c]);
+        if (punchThrough && block.pixels[i][3] < 128)
+            transparentMask |= (1u << i);
+    }
+
+    float opaquePoints[16][3];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            std::copy(std::begin(points[i]), std::end(points[i]), opaquePoints[numOpaque]);
+            ++numOpaque;
+        }
+    }
+
+    BC1ColorBlock result;
+
+    if (numOpaque == 0)
+    {
+        /* All pixels are transparent */
+        result.color0 = 0;
+        result.color1 = 0;
+        std::fill(std::begin(result.indices), std::end(result.indices), std::uint8_t(3));
+    }
+    else
+    {
+        /* Fit endpoints to opaque pixels, then refine them once with the selected indices */
+        float e0[3], e1[3];
+        FitEndpointsPCA(opaquePoints, numOpaque, e0, e1);
+        QuantizeBC1ColorBlock(points, e0, e1, transparentMask, result);
+
+        const bool threeColorMode = (transparentMask != 0);
+        const float indexWeights[2][4] =
+        {
+            { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f },
+            { 0.0f, 1.0f, 0.5f,        0.0f        },
+        };
+
+        float weights[16];
+        std::size_t numWeights = 0;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            if (((transparentMask >> i) & 0x1) == 0)
+                weights[numWeights++] = indexWeights[threeColorMode ? 1 : 0][result.indices[i]];
+        }
+
+        /* Endpoints may have been swapped during quantization, so refit in the order of the quantized colors */
+        int c0[3], c1[3];
+        UnpackRGB565(result.color0, c0);
+        UnpackRGB565(result.color1, c1);
+        for (int c = 0; c < 3; ++c)
+        {
+            e0[c] = static_cast<float>(c0[c]);
+            e1[c] = static_cast<float>(c1[c]);
+        }
+
+        if (result.error > 0.0f && RefitEndpoints(opaquePoints, weights, numOpaque, e0, e1))
+        {
+            BC1ColorBlock refined;
+            QuantizeBC1ColorBlock(points, e0, e1, transparentMask, refined);
+            if (refined.error < result.error)
+                result = refined;
+        }
+    }
+
+    /* Write color endpoints and 2-bit indices */
+    dst[0] = static_cast<std::uint8_t>(result.color0 & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(result.color0 >> 8);
+    dst[2] = static_cast<std::uint8_t>(result.color1 & 0xFF);
+    dst[3] = static_cast<std::uint8_t>(result.color1 >> 8);
+
+    for (std::size_t row = 0; row < 4; ++row)
+    {
+        dst[4 + row] = static_cast<std::uint8_t>(
+            (result.indices[row*4 + 0]     ) |
+            (result.indices[row*4 + 1] << 2) |
+            (result.indices[row*4 + 2] << 4) |
+            (result.indices[row*4 + 3] << 6)
+        );
+    }
+}
+
+
+/* ----- BC4 single channel blocks ----- */
+
+// Encodes 16 single channel values into an 8-byte BC4 block with 8 interpolated values between the minimum and maximum.
+static void EncodeBC4ChannelBlock(const std::uint8_t (&values)[16], std::uint8_t* dst)
+{
+    const auto minmax   = std::minmax_element(std::begin(values), std::end(values));
+    const int  minValue = *minmax.first;
+    const int  maxValue = *minmax.second;
+    const int  range    = maxValue - minValue;
+
+    /* Write endpoints with maximum first to select the mode with 6 interpolated values */
+    dst[0] = static_cast<std::uint8_t>(maxValue);
+    dst[1] = static_cast<std::uint8_t>(minValue);
+
+    std::uint64_t bits = 0;
+    if (range > 0)
+    {
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            /* Map the nearest step between minimum (0) and maximum (7) to the palette index */
+            const int step  = ((values[i] - minValue) * 14 + range) / (2 * range);
+            const int index = (step == 7 ? 0 : step == 0 ? 1 : 8 - step);
+            bits |= (static_cast<std::uint64_t>(index) << (3 * i));
+        }
+    }
+
+    for (std::size_t i = 0; i < 6; ++i)
+        dst[2 + i] = static_cast<std::uint8_t>((bits >> (8 * i)) & 0xFF);
+}
+
+static void GetBlockChannel(const BlockRGBA8& block, std::size_t channel, std::uint8_t (&values)[16])
+{
+    for (std::size_t i = 0; i < 16; ++i)
+        values[i] = block.pixels[i][channel];
+}
+
+
+/* ----- BC7 blocks ----- */
+
+// Quantizes an RGBA endpoint to 7 bits per component with a shared p-bit (mode 6), and selects the p-bit with the smaller error.
+static void QuantizeBC7Endpoint(const float (&endpoint)[4], std::uint32_t (&quantized)[4], std::uint32_t& pbit)
+{
+    float minError = 0.0f;
+
+    for (std::uint32_t p = 0; p < 2; ++p)
+    {
+        std::uint32_t q[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+            q[c] = static_cast<std::uint32_t>(ClampComponent(static_cast<int>((endpoint[c] - static_cast<float>(p)) * 0.5f + 0.5f), 127));
+            const auto d = static_cast<float>((q[c] << 1) | p) - endpoint[c];
+            error += d * d;
+        }
+        if (p == 0 || error < minError)
+        {
+            minError = error;
+            pbit = p;
+            std::copy(std::begin(q), std::end(q), std::begin(quantized));
+        }
+    }
+}
+
+// Quantized endpoints, indices, and error of an encoded BC7 mode 6 block.
+struct BC7Mode6Block
+{
+    std::uint32_t   endpoints[2][4];
+    std::uint32_t   pbits[2];
+    std::uint8_t    indices[16];
+    float           error;
+};
+
+static void QuantizeBC7Mode6Block(const float (&points)[16][4], const float (&e0)[4], const float (&e1)[4], BC7Mode6Block& result)
+{
+    QuantizeBC7Endpoint(e0, result.endpoints[0], result.pbits[0]);
+    QuantizeBC7Endpoint(e1, result.endpoints[1], result.pbits[1]);
+
+    /* Build palette of 16 interpolated colors */
+    float palette[16][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        const auto v0 = (result.endpoints[0][c] << 1) | result.pbits[0];
+        const auto v1 = (result.endpoints[1][c] << 1) | result.pbits[1];
+        for (std::size_t j = 0; j < 16; ++j)
+            palette[j][c] = static_cast<float>(((64 - g_bc7Weights4[j]) * v0 + g_bc7Weights4[j] * v1 + 32) >> 6);
+    }
+
+    /* Select the nearest palette entry for each pixel */
+    result.error = 0.0f;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        float minError = 0.0f;
+        for (std::size_t j = 0; j < 16; ++j)
+        {
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                const auto d = points[i][c] - palette[j][c];
+                error += d * d;
+            }
+            if (j == 0 || error < minError)
+            {
+                minError            = error;
+                result.indices[i]   = static_cast<std::uint8_t>(j);
+            }
+        }
+        result.error += minError;
+    }
+}
+
+/*
+Encodes the block into a 16-byte BC7 block with mode 6 only, i.e. a single subset with RGBA endpoints of 7 bits plus a p-bit each, and 4-bit indices.
+This is the fast mode of the encoder: it does not search partitions or separate alpha, but gives better quality than BC3 for most images.
+*/
+static void EncodeBC7Block(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    float points[16][4];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+            points[i][c] = static_cast<float>(block.pixels[i][c]);
+    }
+
+    /* Fit endpoints, then refine them once with the selected indices */
+    float e0[4], e1[4];
+    FitEndpointsPCA(points, 16, e0, e1);
+
+    BC7Mode6Block result;
+    QuantizeBC7Mode6Block(points, e0, e1, result);
+
+    if (result.error > 0.0f)
+    {
+        float weights[16];
+        for (std::size_t i = 0; i < 16; ++i)
+            weights[i] = static_cast<float>(g_bc7Weights4[result.indices[i]]) / 64.0f;
+
+        if (RefitEndpoints(points, weights, 16, e0, e1))
+        {
+            BC7Mode6Block refined;
+            QuantizeBC7Mode6Block(points, e0, e1, refined);
+            if (refined.error < result.error)
+                result = refined;
+        }
+    }
+
+    /* The most significant bit of the first index is implicitly zero, so swap the endpoints if necessary */
+    if ((result.indices[0] & 0x8) != 0)
+    {
+        for (int c = 0; c < 4; ++c)
+            std::swap(result.endpoints[0][c], result.endpoints[1][c]);
+        std::swap(result.pbits[0], result.pbits[1]);
+        for (auto& index : result.indices)
+            index = static_cast<std::uint8_t>(15 - index);
+    }
+
+    /* Write mode 6 bit, endpoints per component, p-bits, and indices */
+    std::memset(dst, 0, 16);
+    BlockBitWriter writer { dst, 0 };
+
+    writer.Write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c)
+    {
+        writer.Write(result.endpoints[0][c], 7);
+        writer.Write(result.endpoints[1][c], 7);
+    }
+    writer.Write(result.pbits[0], 1);
+    writer.Write(result.pbits[1], 1);
+
+    writer.Write(result.indices[0], 3);
+    for (std::size_t i = 1; i < 16; ++i)
+        writer.Write(result.indices[i], 4);
+}
+
+
+/* ----- Block encoders ----- */
+
+static void EncodeBC1RGBBlock(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    EncodeBC1ColorBlock(block, dst, false);
+}
+
+static void EncodeBC1RGBABlock(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    EncodeBC1ColorBlock(block, dst, true);
+}
+
+static void EncodeBC2Block(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    /* Write explicit 4-bit alpha values */
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        const auto a0 = (block.pixels[i*2 + 0][3] * 15 + 127) / 255;
+        const auto a1 = (block.pixels[i*2 + 1][3] * 15 + 127) / 255;
+        dst[i] = static_cast<std::uint8_t>(a0 | (a1 << 4));
+    }
+    EncodeBC1ColorBlock(block, dst + 8, false);
+}
+
+static void EncodeBC3Block(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    std::uint8_t alpha[16];
+    GetBlockChannel(block, 3, alpha);
+    EncodeBC4ChannelBlock(alpha, dst);
+    EncodeBC1ColorBlock(block, dst + 8, false);
+}
+
+static void EncodeBC4Block(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    std::uint8_t red[16];
+    GetBlockChannel(block, 0, red);
+    EncodeBC4ChannelBlock(red, dst);
+}
+
+static void EncodeBC5Block(const BlockRGBA8& block, std::uint8_t* dst)
+{
+    std::uint8_t red[16], green[16];
+    GetBlockChannel(block, 0, red);
+    GetBlockChannel(block, 1, green);
+    EncodeBC4ChannelBlock(red, dst);
+    EncodeBC4ChannelBlock(green, dst + 8);
+}
+
+static BlockEncoder GetBlockEncoder(const Format format)
+{
+    switch (format)
+    {
+        case Format::BC1RGB:        return EncodeBC1RGBBlock;
+        case Format::BC1RGBA:       /* pass */
+        case Format::BC1RGBAsRGB:   return EncodeBC1RGBABlock;
+        case Format::BC2RGBA:       /* pass */
+        case Format::BC2RGBAsRGB:   return EncodeBC2Block;
+        case Format::BC3RGBA:       /* pass */
+        case Format::BC3RGBAsRGB:   return EncodeBC3Block;
+        case Format::BC4RUNorm:     return EncodeBC4Block;
+        case Format::BC5RGUNorm:    return EncodeBC5Block;
+        case Format::BC7RGBAUNorm:  /* pass */
+        case Format::BC7RGBAsRGB:   return EncodeBC7Block;
+        default:                    return nullptr;
+    }
+}
+
+// Reads a block of 4x4 pixels from the RGBA8 image, and replicates the edge pixels for blocks that exceed the image.
+static void ReadBlockRGBA8(const std::uint8_t* src, const Extent3D& extent, std::uint32_t x, std::uint32_t y, std::uint32_t z, BlockRGBA8& block)
+{
+    const auto slice = src + static_cast<std::size_t>(z) * extent.width * extent.height * 4;
+    for (std::uint32_t j = 0; j < 4; ++j)
+    {
+        const auto row = slice + static_cast<std::size_t>(std::min(y + j, extent.height - 1)) * extent.width * 4;
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            const auto pixel = row + static_cast<std::size_t>(std::min(x + i, extent.width - 1)) * 4;
+            std::copy(pixel, pixel + 4, block.pixels[j*4 + i]);
+        }
+    }
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT bool IsImageCompressionSupported(const Format format)
+{
+    return (GetBlockEncoder(format) != nullptr);
+}
+
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const Format                dstFormat,
+    std::size_t                 threadCount)
+{
+    /* Validate input parameters */
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+
+    const auto encoder = GetBlockEncoder(dstFormat);
+    if (!encoder)
+        throw std::invalid_argument("cannot compress image into unsupported format");
+    if (IsCompressedFormat(srcImageDesc.format) || IsDepthStencilFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot compress image with compressed or depth-stencil format");
+
+    const std::size_t numPixels = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+    if (numPixels == 0)
+        return nullptr;
+
+    const auto srcDataSize = numPixels * ImageFormatSize(srcImageDesc.format) * DataTypeSize(srcImageDesc.dataType);
+    if (srcImageDesc.dataSize < srcDataSize)
+        throw std::invalid_argument("source image data size is too small for image compression");
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Convert source image into RGBA8 if necessary */
+    ByteBuffer rgba8;
+    auto src = reinterpret_cast<const std::uint8_t*>(srcImageDesc.data);
+
+    if (srcImageDesc.format != ImageFormat::RGBA || srcImageDesc.dataType != DataType::UInt8)
+    {
+        rgba8 = ConvertImageBuffer(
+            SrcImageDescriptor{ srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, srcDataSize },
+            ImageFormat::RGBA,
+            DataType::UInt8,
+            threadCount
+        );
+        src = reinterpret_cast<const std::uint8_t*>(rgba8.get());
+    }
+
+    /* Encode all blocks in parallel, slice by slice */
+    const std::size_t numBlocksX    = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY    = (extent.height + 3) / 4;
+    const std::size_t numBlocks     = numBlocksX * numBlocksY * extent.depth;
+    const std::size_t blockSize     = FormatBlockSize(dstFormat);
+
+    auto dstImage   = GenerateEmptyByteBuffer(numBlocks * blockSize, false);
+    auto dst        = reinterpret_cast<std::uint8_t*>(dstImage.get());
+
+    ThreadPool::Get().ParallelFor(
+        numBlocks, g_compressGrainSize, threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            BlockRGBA8 block;
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto z = i / (numBlocksX * numBlocksY);
+                const auto y = (i / numBlocksX) % numBlocksY;
+                const auto x = i % numBlocksX;
+                ReadBlockRGBA8(
+                    src,
+                    extent,
+                    static_cast<std::uint32_t>(x * 4),
+                    static_cast<std::uint32_t>(y * 4),
+                    static_cast<std::uint32_t>(z),
+                    block
+                );
+                encoder(block, dst + i * blockSize);
+            }
+        }
+    );
+
+    return dstImage;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
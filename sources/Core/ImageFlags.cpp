@@ -14,6 +14,22 @@
 #include <cstring>
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "ColorSpace.h"
+#include "ThreadPool.h"
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_IMAGE_SSE2
+#   if defined __SSSE3__ || defined __AVX__
+#       define LLGL_IMAGE_SSSE3
+#   endif
+#   if defined __AVX2__
+#       define LLGL_IMAGE_AVX2
+#   endif
+#   include <immintrin.h>
+#elif (defined __ARM_NEON && defined __aarch64__) || defined _M_ARM64
+#   define LLGL_IMAGE_NEON
+#   include <arm_neon.h>
+#endif
 
 
 namespace LLGL
@@ -166,7 +182,348 @@ static ByteBuffer AllocByteArray(std::size_t size)
     return ByteBuffer { new char[size] };
 }
 
-// Worker thread procedure for the "ConvertImageBufferDataType" function
+/* ----- Fast conversion paths ----- */
+
+/*
+Specialized kernels for the most common conversions.
+Each kernel converts the largest part of the index range [idxBegin, idxEnd) it can handle,
+and returns the index where the generic conversion has to continue.
+*/
+
+#ifdef LLGL_IMAGE_SSE2
+
+// Converts four 32-bit floats from the range [0, 1] into four 32-bit integers in the range [0, max] (multiplied in double precision and truncated like the generic path).
+static __m128i ConvertNormalizedFloat4ToInt4(const float* src, __m128d vmax)
+{
+    auto v = _mm_loadu_ps(src);
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    auto lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(v), vmax));
+    auto hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), vmax));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+#endif
+
+#ifdef LLGL_IMAGE_NEON
+
+// Converts four 32-bit floats from the range [0, 1] into four 32-bit unsigned integers in the range [0, max] (multiplied in double precision and truncated like the generic path).
+static uint32x4_t ConvertNormalizedFloat4ToUInt4(const float* src, float64x2_t vmax)
+{
+    auto v = vld1q_f32(src);
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    auto lo = vcvtq_u64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(v)), vmax));
+    auto hi = vcvtq_u64_f64(vmulq_f64(vcvt_high_f64_f32(v), vmax));
+    return vcombine_u32(vmovn_u64(lo), vmovn_u64(hi));
+}
+
+#endif
+
+static std::size_t ConvertUInt8ToFloat32(const std::uint8_t* src, float* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_AVX2
+
+    const auto vmax = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), vmax));
+    }
+
+    #elif defined LLGL_IMAGE_SSE2
+
+    const auto zero = _mm_setzero_si128();
+    const auto vmax = _mm_set1_ps(255.0f);
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto v16lo  = _mm_unpacklo_epi8(v8, zero);
+        auto v16hi  = _mm_unpackhi_epi8(v8, zero);
+        _mm_storeu_ps(dst + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16lo, zero)), vmax));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16lo, zero)), vmax));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16hi, zero)), vmax));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16hi, zero)), vmax));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto vmax = vdupq_n_f32(255.0f);
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = vld1q_u8(src + i);
+        auto v16lo  = vmovl_u8(vget_low_u8(v8));
+        auto v16hi  = vmovl_u8(vget_high_u8(v8));
+        vst1q_f32(dst + i     , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16lo))), vmax));
+        vst1q_f32(dst + i +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16lo))), vmax));
+        vst1q_f32(dst + i +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16hi))), vmax));
+        vst1q_f32(dst + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16hi))), vmax));
+    }
+
+    #endif
+
+    return i;
+}
+
+static std::size_t ConvertFloat32ToUInt8(const float* src, std::uint8_t* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto vmax = _mm_set1_pd(255.0);
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v16lo = _mm_packs_epi32(ConvertNormalizedFloat4ToInt4(src + i    , vmax), ConvertNormalizedFloat4ToInt4(src + i +  4, vmax));
+        auto v16hi = _mm_packs_epi32(ConvertNormalizedFloat4ToInt4(src + i + 8, vmax), ConvertNormalizedFloat4ToInt4(src + i + 12, vmax));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v16lo, v16hi));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto vmax = vdupq_n_f64(255.0);
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v16lo = vcombine_u16(vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i    , vmax)), vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i +  4, vmax)));
+        auto v16hi = vcombine_u16(vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i + 8, vmax)), vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i + 12, vmax)));
+        vst1q_u8(dst + i, vcombine_u8(vmovn_u16(v16lo), vmovn_u16(v16hi)));
+    }
+
+    #endif
+
+    return i;
+}
+
+static std::size_t ConvertUInt16ToFloat32(const std::uint16_t* src, float* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_AVX2
+
+    const auto vmax = _mm256_set1_ps(65535.0f);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), vmax));
+    }
+
+    #elif defined LLGL_IMAGE_SSE2
+
+    const auto zero = _mm_setzero_si128();
+    const auto vmax = _mm_set1_ps(65535.0f);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i    , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16, zero)), vmax));
+        _mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16, zero)), vmax));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto vmax = vdupq_n_f32(65535.0f);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = vld1q_u16(src + i);
+        vst1q_f32(dst + i    , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16))), vmax));
+        vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16))), vmax));
+    }
+
+    #endif
+
+    return i;
+}
+
+static std::size_t ConvertFloat32ToUInt16(const float* src, std::uint16_t* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    /* Bias values into signed 16-bit range, since SSE2 only provides signed saturation for 32-bit integers */
+    const auto vmax     = _mm_set1_pd(65535.0);
+    const auto bias32   = _mm_set1_epi32(32768);
+    const auto bias16   = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v32lo = _mm_sub_epi32(ConvertNormalizedFloat4ToInt4(src + i    , vmax), bias32);
+        auto v32hi = _mm_sub_epi32(ConvertNormalizedFloat4ToInt4(src + i + 4, vmax), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(_mm_packs_epi32(v32lo, v32hi), bias16));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto vmax = vdupq_n_f64(65535.0);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16lo = vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i    , vmax));
+        auto v16hi = vmovn_u32(ConvertNormalizedFloat4ToUInt4(src + i + 4, vmax));
+        vst1q_u16(dst + i, vcombine_u16(v16lo, v16hi));
+    }
+
+    #endif
+
+    return i;
+}
+
+static std::size_t ConvertFloat16ToFloat32(const std::uint16_t* src, float* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    DecompressFloat16Array(src + idxBegin, dst + idxBegin, idxEnd - idxBegin);
+    return idxEnd;
+}
+
+static std::size_t ConvertFloat32ToFloat16(const float* src, std::uint16_t* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    CompressFloat16Array(src + idxBegin, dst + idxBegin, idxEnd - idxBegin);
+    return idxEnd;
+}
+
+// Converts the specified range with a specialized kernel if there is one for the specified data types.
+static std::size_t ConvertImageBufferDataTypeFast(
+    DataType srcDataType, const VariantConstBuffer& srcBuffer,
+    DataType dstDataType, VariantBuffer& dstBuffer,
+    std::size_t idxBegin, std::size_t idxEnd)
+{
+    if (dstDataType == DataType::Float32)
+    {
+        switch (srcDataType)
+        {
+            case DataType::UInt8:
+                return ConvertUInt8ToFloat32(srcBuffer.uint8, dstBuffer.real32, idxBegin, idxEnd);
+            case DataType::UInt16:
+                return ConvertUInt16ToFloat32(srcBuffer.uint16, dstBuffer.real32, idxBegin, idxEnd);
+            case DataType::Float16:
+                return ConvertFloat16ToFloat32(srcBuffer.uint16, dstBuffer.real32, idxBegin, idxEnd);
+            default:
+                break;
+        }
+    }
+    else if (srcDataType == DataType::Float32)
+    {
+        switch (dstDataType)
+        {
+            case DataType::UInt8:
+                return ConvertFloat32ToUInt8(srcBuffer.real32, dstBuffer.uint8, idxBegin, idxEnd);
+            case DataType::UInt16:
+                return ConvertFloat32ToUInt16(srcBuffer.real32, dstBuffer.uint16, idxBegin, idxEnd);
+            case DataType::Float16:
+                return ConvertFloat32ToFloat16(srcBuffer.real32, dstBuffer.uint16, idxBegin, idxEnd);
+            default:
+                break;
+        }
+    }
+    return idxBegin;
+}
+
+// Converts 8-bit RGB into 8-bit RGBA pixels (with alpha = 255), optionally swapping the red and blue components.
+static std::size_t ConvertUInt8RGBToRGBA(const std::uint8_t* src, std::uint8_t* dst, std::size_t idxBegin, std::size_t idxEnd, bool swapRB)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSSE3
+
+    /* Shuffle 4 pixels at a time (reads 16 bytes, so keep at least 6 pixels in the range) */
+    const auto mask = (swapRB ?
+        _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) :
+        _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+    );
+    const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 6 <= idxEnd; i += 4)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto rgb = vld3q_u8(src + i*3);
+        uint8x16x4_t rgba;
+        {
+            rgba.val[0] = (swapRB ? rgb.val[2] : rgb.val[0]);
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = (swapRB ? rgb.val[0] : rgb.val[2]);
+            rgba.val[3] = vdupq_n_u8(0xFF);
+        }
+        vst4q_u8(dst + i*4, rgba);
+    }
+
+    #endif
+
+    /* Convert remaining pixels */
+    const std::size_t r = (swapRB ? 2 : 0);
+    const std::size_t b = (swapRB ? 0 : 2);
+    for (; i < idxEnd; ++i)
+    {
+        auto s = src + i*3;
+        auto d = dst + i*4;
+        d[0] = s[r];
+        d[1] = s[1];
+        d[2] = s[b];
+        d[3] = 0xFF;
+    }
+
+    return i;
+}
+
+// Converts 8-bit RGBA into 8-bit BGRA pixels or vice versa.
+static std::size_t ConvertUInt8RGBAToBGRA(const std::uint8_t* src, std::uint8_t* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSSE3
+
+    const auto mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_shuffle_epi8(v, mask));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v = vld4q_u8(src + i*4);
+        std::swap(v.val[0], v.val[2]);
+        vst4q_u8(dst + i*4, v);
+    }
+
+    #endif
+
+    /* Convert remaining pixels */
+    for (; i < idxEnd; ++i)
+    {
+        auto s = src + i*4;
+        auto d = dst + i*4;
+        d[0] = s[2];
+        d[1] = s[1];
+        d[2] = s[0];
+        d[3] = s[3];
+    }
+
+    return i;
+}
+
+// Converts the specified range of pixels with a specialized kernel if there is one for the specified formats.
+static std::size_t ConvertImageBufferFormatFast(
+    ImageFormat srcFormat, DataType srcDataType, const VariantConstBuffer& srcBuffer,
+    ImageFormat dstFormat, VariantBuffer& dstBuffer,
+    std::size_t idxBegin, std::size_t idxEnd)
+{
+    if (srcDataType == DataType::UInt8)
+    {
+        if ((srcFormat == ImageFormat::RGB && dstFormat == ImageFormat::RGBA) || (srcFormat == ImageFormat::BGR && dstFormat == ImageFormat::BGRA))
+            return ConvertUInt8RGBToRGBA(srcBuffer.uint8, dstBuffer.uint8, idxBegin, idxEnd, false);
+        if ((srcFormat == ImageFormat::RGB && dstFormat == ImageFormat::BGRA) || (srcFormat == ImageFormat::BGR && dstFormat == ImageFormat::RGBA))
+            return ConvertUInt8RGBToRGBA(srcBuffer.uint8, dstBuffer.uint8, idxBegin, idxEnd, true);
+        if ((srcFormat == ImageFormat::RGBA && dstFormat == ImageFormat::BGRA) || (srcFormat == ImageFormat::BGRA && dstFormat == ImageFormat::RGBA))
+            return ConvertUInt8RGBAToBGRA(srcBuffer.uint8, dstBuffer.uint8, idxBegin, idxEnd);
+    }
+    return idxBegin;
+}
+
+// Worker procedure for the "ConvertImageBufferDataType" function
 static void ConvertImageBufferDataTypeWorker(
     DataType srcDataType, const VariantConstBuffer& srcBuffer,
     DataType dstDataType, VariantBuffer& dstBuffer,
@@ -174,6 +531,9 @@ static void ConvertImageBufferDataTypeWorker(
 {
     double value = 0.0;
 
+    /* Convert as much as possible with a specialized kernel */
+    idxBegin = ConvertImageBufferDataTypeFast(srcDataType, srcBuffer, dstDataType, dstBuffer, idxBegin, idxEnd);
+
     for (auto i = idxBegin; i < idxEnd; ++i)
     {
         /* Read normalized variant from source buffer */
@@ -184,8 +544,8 @@ static void ConvertImageBufferDataTypeWorker(
     }
 }
 
-// Minimal number of entries each worker thread shall process
-static const std::size_t g_threadMinWorkSize = 64;
+// Maximal number of entries each task of the thread pool processes (smaller images are converted on the calling thread only)
+static const std::size_t g_threadGrainSize = 16384;
 
 static void ConvertImageBufferDataType(
     DataType    srcDataType,
@@ -207,42 +567,14 @@ static void ConvertImageBufferDataType(
     VariantConstBuffer src { srcBuffer };
     VariantBuffer dst { dstBuffer };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
+    /* Execute conversion in parallel */
+    ThreadPool::Get().ParallelFor(
+        imageSize, g_threadGrainSize, threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType, std::ref(src),
-                dstDataType, std::ref(dst),
-                offset, offset + workSize
-            );
-            offset += workSize;
+            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, idxBegin, idxEnd);
         }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
-    }
+    );
 }
 
 static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
@@ -411,12 +743,15 @@ static void WriteRGBAFormattedVariant(
     TransferRGBAFormattedVariantColor(dstFormat, dataType, dstBuffer, idx, value);
 }
 
-// Worker thread procedure for the "ConvertImageBufferFormat" function
+// Worker procedure for the "ConvertImageBufferFormat" function
 static void ConvertImageBufferFormatWorker(
     ImageFormat srcFormat, DataType srcDataType, const VariantConstBuffer& srcBuffer,
     ImageFormat dstFormat, VariantBuffer& dstBuffer,
     std::size_t idxBegin, std::size_t idxEnd)
 {
+    /* Convert as much as possible with a specialized kernel */
+    idxBegin = ConvertImageBufferFormatFast(srcFormat, srcDataType, srcBuffer, dstFormat, dstBuffer, idxBegin, idxEnd);
+
     /* Get size for source and destination formats */
     auto srcFormatSize  = ImageFormatSize(srcFormat);
     auto dstFormatSize  = ImageFormatSize(dstFormat);
@@ -463,52 +798,225 @@ static void ConvertImageBufferFormat(
     VariantConstBuffer src { srcImageDesc.data };
     VariantBuffer dst { dstImageDesc.data };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format, srcImageDesc.dataType, std::ref(src),
-                dstImageDesc.format, std::ref(dst),
-                offset, offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
+    /* Execute conversion in parallel */
+    ThreadPool::Get().ParallelFor(
+        imageSize, g_threadGrainSize, threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
             ConvertImageBufferFormatWorker(
                 srcImageDesc.format, srcImageDesc.dataType, src,
                 dstImageDesc.format, dst,
-                offset, offset + workSizeRemain
+                idxBegin, idxEnd
             );
         }
+    );
+}
+
+
+/* ----- Fused format and data type conversion ----- */
+
+/*
+Fused conversion of format and data type reads each source pixel once and writes each destination pixel once,
+instead of converting the data type into an intermediate buffer and the format in a second pass.
+*/
+
+// Compile-time component layout of the image formats that are supported by the specialized fused kernels.
+template <ImageFormat Format>
+struct FusedFormatTraits;
 
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+template <>
+struct FusedFormatTraits<ImageFormat::RGB>
+{
+    enum { numComponents = 3, idxR = 0, idxG = 1, idxB = 2, idxA = 0, hasAlpha = 0 };
+};
+
+template <>
+struct FusedFormatTraits<ImageFormat::BGR>
+{
+    enum { numComponents = 3, idxR = 2, idxG = 1, idxB = 0, idxA = 0, hasAlpha = 0 };
+};
+
+template <>
+struct FusedFormatTraits<ImageFormat::RGBA>
+{
+    enum { numComponents = 4, idxR = 0, idxG = 1, idxB = 2, idxA = 3, hasAlpha = 1 };
+};
+
+template <>
+struct FusedFormatTraits<ImageFormat::BGRA>
+{
+    enum { numComponents = 4, idxR = 2, idxG = 1, idxB = 0, idxA = 3, hasAlpha = 1 };
+};
+
+// Normalized component conversion between the data types that are supported by the specialized fused kernels (same results as the generic path).
+template <typename TSrc, typename TDst>
+struct FusedDataTypeTraits;
+
+template <>
+struct FusedDataTypeTraits<std::uint8_t, float>
+{
+    static float Convert(std::uint8_t value)
+    {
+        return static_cast<float>(ReadNormalizedVariant(value));
     }
-    else
+    static float One()
     {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(
-            srcImageDesc.format, srcImageDesc.dataType, src,
-            dstImageDesc.format, dst,
-            0, imageSize
-        );
+        return 1.0f;
+    }
+};
+
+template <>
+struct FusedDataTypeTraits<float, std::uint8_t>
+{
+    static std::uint8_t Convert(float value)
+    {
+        std::uint8_t result;
+        WriteNormalizedVariant(result, static_cast<double>(value));
+        return result;
+    }
+    static std::uint8_t One()
+    {
+        return std::numeric_limits<std::uint8_t>::max();
+    }
+};
+
+// Converts the specified range of pixels from one format and data type into another format and data type in a single pass.
+template <typename TSrc, ImageFormat SrcFormat, typename TDst, ImageFormat DstFormat>
+std::size_t ConvertImageBufferFusedKernel(const TSrc* src, TDst* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    using SrcTraits     = FusedFormatTraits<SrcFormat>;
+    using DstTraits     = FusedFormatTraits<DstFormat>;
+    using ValueTraits   = FusedDataTypeTraits<TSrc, TDst>;
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        auto s = src + i*SrcTraits::numComponents;
+        auto d = dst + i*DstTraits::numComponents;
+        d[DstTraits::idxR] = ValueTraits::Convert(s[SrcTraits::idxR]);
+        d[DstTraits::idxG] = ValueTraits::Convert(s[SrcTraits::idxG]);
+        d[DstTraits::idxB] = ValueTraits::Convert(s[SrcTraits::idxB]);
+        if (DstTraits::hasAlpha)
+            d[DstTraits::idxA] = (SrcTraits::hasAlpha ? ValueTraits::Convert(s[SrcTraits::idxA]) : ValueTraits::One());
+    }
+
+    return idxEnd;
+}
+
+// Converts the specified range of pixels with a specialized fused kernel if there is one for the specified formats.
+template <typename TSrc, typename TDst>
+std::size_t ConvertImageBufferFusedFast(
+    ImageFormat srcFormat, const TSrc* src, ImageFormat dstFormat, TDst* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    /* Dispatch the format combinations of texture uploads (e.g. RGB to RGBA) and texture readbacks (e.g. RGBA to RGB or BGRA) */
+    switch (srcFormat)
+    {
+        case ImageFormat::RGB:
+            if (dstFormat == ImageFormat::RGBA)
+                return ConvertImageBufferFusedKernel<TSrc, ImageFormat::RGB, TDst, ImageFormat::RGBA>(src, dst, idxBegin, idxEnd);
+            break;
+        case ImageFormat::BGR:
+            if (dstFormat == ImageFormat::RGBA)
+                return ConvertImageBufferFusedKernel<TSrc, ImageFormat::BGR, TDst, ImageFormat::RGBA>(src, dst, idxBegin, idxEnd);
+            break;
+        case ImageFormat::RGBA:
+            if (dstFormat == ImageFormat::RGB)
+                return ConvertImageBufferFusedKernel<TSrc, ImageFormat::RGBA, TDst, ImageFormat::RGB>(src, dst, idxBegin, idxEnd);
+            if (dstFormat == ImageFormat::BGRA)
+                return ConvertImageBufferFusedKernel<TSrc, ImageFormat::RGBA, TDst, ImageFormat::BGRA>(src, dst, idxBegin, idxEnd);
+            break;
+        case ImageFormat::BGRA:
+            if (dstFormat == ImageFormat::RGBA)
+                return ConvertImageBufferFusedKernel<TSrc, ImageFormat::BGRA, TDst, ImageFormat::RGBA>(src, dst, idxBegin, idxEnd);
+            break;
+        default:
+            break;
     }
+    return idxBegin;
+}
+
+// Returns the RGBA channel index (0 = red, 1 = green, 2 = blue, 3 = alpha) of each component of the specified color format.
+static const std::uint32_t* GetImageFormatChannelOrder(const ImageFormat format)
+{
+    static const std::uint32_t orderRGBA[] = { 0, 1, 2, 3 };
+    static const std::uint32_t orderBGRA[] = { 2, 1, 0, 3 };
+    static const std::uint32_t orderARGB[] = { 3, 0, 1, 2 };
+    static const std::uint32_t orderABGR[] = { 3, 2, 1, 0 };
+
+    switch (format)
+    {
+        case ImageFormat::BGR:
+        case ImageFormat::BGRA:
+            return orderBGRA;
+        case ImageFormat::ARGB:
+            return orderARGB;
+        case ImageFormat::ABGR:
+            return orderABGR;
+        default:
+            return orderRGBA;
+    }
+}
+
+// Worker procedure for the "ConvertImageBufferFormatAndDataType" function
+static void ConvertImageBufferFormatAndDataTypeWorker(
+    ImageFormat srcFormat, DataType srcDataType, const VariantConstBuffer& srcBuffer,
+    ImageFormat dstFormat, DataType dstDataType, VariantBuffer& dstBuffer,
+    std::size_t idxBegin, std::size_t idxEnd)
+{
+    /* Convert as much as possible with a specialized kernel */
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+        idxBegin = ConvertImageBufferFusedFast(srcFormat, srcBuffer.uint8, dstFormat, dstBuffer.real32, idxBegin, idxEnd);
+    else if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+        idxBegin = ConvertImageBufferFusedFast(srcFormat, srcBuffer.real32, dstFormat, dstBuffer.uint8, idxBegin, idxEnd);
+
+    /* Get size and channel order for source and destination formats */
+    auto srcFormatSize  = ImageFormatSize(srcFormat);
+    auto dstFormatSize  = ImageFormatSize(dstFormat);
+    auto srcOrder       = GetImageFormatChannelOrder(srcFormat);
+    auto dstOrder       = GetImageFormatChannelOrder(dstFormat);
+
+    /* Initialize default normalized color (0, 0, 0, 1) */
+    double value[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        /* Read normalized components from source buffer */
+        for (std::uint32_t c = 0; c < srcFormatSize; ++c)
+            value[srcOrder[c]] = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i*srcFormatSize + c);
+
+        /* Write normalized components to destination buffer */
+        for (std::uint32_t c = 0; c < dstFormatSize; ++c)
+            WriteNormalizedTypedVariant(dstDataType, dstBuffer, i*dstFormatSize + c, value[dstOrder[c]]);
+    }
+}
+
+static void ConvertImageBufferFormatAndDataType(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount)
+{
+    /* Validate destination buffer size */
+    auto imageSize              = srcImageDesc.dataSize / (ImageFormatSize(srcImageDesc.format) * DataTypeSize(srcImageDesc.dataType));
+    auto requiredDstBufferSize  = imageSize * ImageFormatSize(dstImageDesc.format) * DataTypeSize(dstImageDesc.dataType);
+
+    if (dstImageDesc.dataSize != requiredDstBufferSize)
+        throw std::invalid_argument("cannot convert image format and data type with destination buffer size mismatch");
+
+    /* Get variant buffer for source and destination images */
+    VariantConstBuffer src { srcImageDesc.data };
+    VariantBuffer dst { dstImageDesc.data };
+
+    /* Execute conversion in parallel */
+    ThreadPool::Get().ParallelFor(
+        imageSize, g_threadGrainSize, threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            ConvertImageBufferFormatAndDataTypeWorker(
+                srcImageDesc.format, srcImageDesc.dataType, src,
+                dstImageDesc.format, dstImageDesc.dataType, dst,
+                idxBegin, idxEnd
+            );
+        }
+    );
 }
 
 
@@ -625,6 +1133,8 @@ static std::tuple<ImageFormat, DataType> FindSuitableImageFormatPrimary(const Fo
         case Format::BC1RGBA:           return T{ ImageFormat::CompressedRGBA, DataType::Int8 };
         case Format::BC2RGBA:           return T{ ImageFormat::CompressedRGBA, DataType::Int16 };
         case Format::BC3RGBA:           return T{ ImageFormat::CompressedRGBA, DataType::Int16 };
+
+        default:                        break;
     }
 
     /* Return an invalid image format */
@@ -677,28 +1187,8 @@ LLGL_EXPORT bool ConvertImageBuffer(
 
     if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
     {
-        /* Convert image data type with intermediate buffer */
-        auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstImageDesc.dataType);
-        auto intermediateBuffer     = AllocByteArray(intermediateBufferSize);
-
-        ConvertImageBufferDataType(
-            srcImageDesc.dataType, srcImageDesc.data, srcImageDesc.dataSize,
-            dstImageDesc.dataType, intermediateBuffer.get(), intermediateBufferSize,
-            threadCount
-        );
-
-        /* Set new source buffer and source data type */
-        const SrcImageDescriptor intermediateImageDesc
-        {
-            srcImageDesc.format,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize
-        };
-
-        /* Convert image format */
-        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
-
+        /* Convert image format and data type in a single pass */
+        ConvertImageBufferFormatAndDataType(srcImageDesc, dstImageDesc, threadCount);
         return true;
     }
     else if (srcImageDesc.dataType != dstImageDesc.dataType)
@@ -746,30 +1236,11 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
 
     if (srcImageDesc.dataType != dstDataType && srcImageDesc.format != dstFormat)
     {
+        /* Convert image format and data type in a single pass */
         auto dstImage = AllocByteArray(dstImageDesc.dataSize);
         {
-            /* Convert image data type with intermediate buffer */
-            auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstDataType);
-            auto intermediateBuffer     = AllocByteArray(intermediateBufferSize);
-
-            ConvertImageBufferDataType(
-                srcImageDesc.dataType, srcImageDesc.data, srcImageDesc.dataSize,
-                dstDataType, intermediateBuffer.get(), intermediateBufferSize,
-                threadCount
-            );
-
-            /* Set new source buffer and source data type */
-            const SrcImageDescriptor intermediateImageDesc
-            {
-                srcImageDesc.format,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize
-            };
-
-            /* Convert image format */
             dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
+            ConvertImageBufferFormatAndDataType(srcImageDesc, dstImageDesc, threadCount);
         }
         return dstImage;
     }
@@ -801,6 +1272,83 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     return nullptr;
 }
 
+static void ValidateSRGBConversionParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    DataType                    srcDataType,
+    DataType                    dstDataType)
+{
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+    if (srcImageDesc.dataType != srcDataType || dstImageDesc.dataType != dstDataType)
+        throw std::invalid_argument("invalid data types for sRGB image conversion");
+    if (srcImageDesc.format != dstImageDesc.format)
+        throw std::invalid_argument("cannot convert image format during sRGB image conversion");
+    if (IsCompressedFormat(srcImageDesc.format) || IsDepthStencilFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot convert compressed or depth-stencil images between sRGB and linear color space");
+
+    const auto numComponents = srcImageDesc.dataSize / DataTypeSize(srcDataType);
+    if (dstImageDesc.dataSize < numComponents * DataTypeSize(dstDataType))
+        throw std::invalid_argument("cannot convert sRGB image with destination buffer size mismatch");
+}
+
+// Distributes the pixels of an sRGB conversion among the threads, so each task begins with the first component of a pixel
+template <typename TConvert>
+static void ParallelForSRGBConversion(ImageFormat format, std::size_t numComponents, std::size_t threadCount, const TConvert& convert)
+{
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    const std::size_t pixelSize = ImageFormatSize(format);
+    const std::size_t alphaIndex = GetAlphaComponentIndex(format);
+
+    ThreadPool::Get().ParallelFor(
+        numComponents / pixelSize, g_threadGrainSize, threadCount,
+        [&](std::size_t pixelBegin, std::size_t pixelEnd)
+        {
+            convert(pixelBegin * pixelSize, (pixelEnd - pixelBegin) * pixelSize, pixelSize, alphaIndex);
+        }
+    );
+}
+
+LLGL_EXPORT void DecodeSRGBImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount)
+{
+    ValidateSRGBConversionParams(srcImageDesc, dstImageDesc, DataType::UInt8, DataType::Float32);
+
+    auto src = reinterpret_cast<const std::uint8_t*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<float*>(dstImageDesc.data);
+
+    ParallelForSRGBConversion(
+        srcImageDesc.format, srcImageDesc.dataSize, threadCount,
+        [src, dst](std::size_t offset, std::size_t count, std::size_t pixelSize, std::size_t alphaIndex)
+        {
+            DecodeSRGB8Array(src + offset, dst + offset, count, pixelSize, alphaIndex);
+        }
+    );
+}
+
+LLGL_EXPORT void EncodeSRGBImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount)
+{
+    ValidateSRGBConversionParams(srcImageDesc, dstImageDesc, DataType::Float32, DataType::UInt8);
+
+    auto src = reinterpret_cast<const float*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstImageDesc.data);
+
+    ParallelForSRGBConversion(
+        srcImageDesc.format, srcImageDesc.dataSize / sizeof(float), threadCount,
+        [src, dst](std::size_t offset, std::size_t count, std::size_t pixelSize, std::size_t alphaIndex)
+        {
+            EncodeSRGB8Array(src + offset, dst + offset, count, pixelSize, alphaIndex);
+        }
+    );
+}
+
 LLGL_EXPORT ByteBuffer GenerateImageBuffer(
     ImageFormat         format,
     DataType            dataType,
@@ -0,0 +1,653 @@
+/*
+ * ImageResize.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageView.h>
+#include "Float16Compressor.h"
+#include "ColorSpace.h"
+#include "ThreadPool.h"
+#include <LLGL/Constants.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <stdexcept>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_RESIZE_SSE2
+#   if defined __AVX__
+#       define LLGL_RESIZE_AVX
+#   endif
+#   include <immintrin.h>
+#elif (defined __ARM_NEON && defined __aarch64__) || defined _M_ARM64
+#   define LLGL_RESIZE_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// 16-bit floating-point component, to distinguish DataType::Float16 from DataType::UInt16.
+struct Half
+{
+    std::uint16_t bits;
+};
+
+// Range of source pixels that contribute to a single destination pixel.
+struct ResizeContributor
+{
+    std::size_t first;  // Index of the first source pixel
+    std::size_t count;  // Number of source pixels
+    std::size_t offset; // Offset of the first weight in 'ResizeAxis::weights'
+};
+
+// Normalized filter weights of all destination pixels along a single dimension.
+template <typename F>
+struct ResizeAxis
+{
+    std::vector<ResizeContributor>  contributors;
+    std::vector<F>                  weights;
+};
+
+// Maximal number of components each task of the thread pool processes (smaller images are resized on the calling thread only)
+static const std::size_t g_resizeGrainSize = 16384;
+
+static const double g_pi = 3.14159265358979323846;
+
+
+/* ----- Filter kernels ----- */
+
+// Returns the radius of the specified filter (in source pixels, if the image is not minified).
+static double GetFilterRadius(const ImageResizeFilter filter)
+{
+    switch (filter)
+    {
+        case ImageResizeFilter::Box:        return 0.5;
+        case ImageResizeFilter::Bilinear:   return 1.0;
+        case ImageResizeFilter::Lanczos:    return 3.0;
+        default:                            return 0.0;
+    }
+}
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= g_pi;
+    return std::sin(x) / x;
+}
+
+// Returns the weight of the specified filter at the distance 'x' from the filter center.
+static double EvalFilter(const ImageResizeFilter filter, double x)
+{
+    x = std::abs(x);
+    switch (filter)
+    {
+        case ImageResizeFilter::Box:        return (x <= 0.5 ? 1.0 : 0.0);
+        case ImageResizeFilter::Bilinear:   return std::max(0.0, 1.0 - x);
+        case ImageResizeFilter::Lanczos:    return (x < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0);
+        default:                            return 0.0;
+    }
+}
+
+// Computes the contributors and normalized weights for each destination pixel along one dimension.
+template <typename F>
+static void BuildResizeAxis(ResizeAxis<F>& axis, std::uint32_t srcSize, std::uint32_t dstSize, const ImageResizeFilter filter)
+{
+    const auto scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+    axis.contributors.resize(dstSize);
+    axis.weights.clear();
+
+    if (filter == ImageResizeFilter::Nearest)
+    {
+        /* Take a single source pixel per destination pixel */
+        for (std::uint32_t i = 0; i < dstSize; ++i)
+        {
+            auto first = static_cast<std::size_t>((static_cast<double>(i) + 0.5) * scale);
+            axis.contributors[i] = { std::min<std::size_t>(first, srcSize - 1), 1, axis.weights.size() };
+            axis.weights.push_back(F(1));
+        }
+        return;
+    }
+
+    /* Widen filter by the scaling factor when the image is minified, so that all source pixels contribute */
+    const auto filterScale  = std::max(1.0, scale);
+    const auto radius       = GetFilterRadius(filter) * filterScale;
+
+    std::vector<double> weights;
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        const auto center   = (static_cast<double>(i) + 0.5) * scale;
+        const auto begin    = static_cast<std::size_t>(std::max(0.0, std::floor(center - radius)));
+        const auto end      = static_cast<std::size_t>(std::min(static_cast<double>(srcSize), std::ceil(center + radius)));
+
+        /* Evaluate filter for all source pixels within the radius, and skip the pixels with zero weight at both ends */
+        weights.clear();
+        auto first = begin;
+        auto sum = 0.0;
+
+        for (auto j = begin; j < end; ++j)
+        {
+            auto w = EvalFilter(filter, (static_cast<double>(j) + 0.5 - center) / filterScale);
+            if (w == 0.0 && weights.empty())
+                ++first;
+            else
+            {
+                weights.push_back(w);
+                sum += w;
+            }
+        }
+
+        while (!weights.empty() && weights.back() == 0.0)
+            weights.pop_back();
+
+        if (weights.empty() || sum == 0.0)
+        {
+            /* Fall back to nearest source pixel */
+            axis.contributors[i] = { std::min<std::size_t>(static_cast<std::size_t>(center), srcSize - 1), 1, axis.weights.size() };
+            axis.weights.push_back(F(1));
+        }
+        else
+        {
+            /* Store normalized weights, so that the image brightness is preserved at the borders */
+            axis.contributors[i] = { first, weights.size(), axis.weights.size() };
+            for (auto w : weights)
+                axis.weights.push_back(static_cast<F>(w / sum));
+        }
+    }
+}
+
+
+/* ----- Row conversion ----- */
+
+template <typename T, typename F>
+static void ReadResizeRow(const T* src, F* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<F>(src[i]);
+}
+
+static void ReadResizeRow(const Half* src, float* dst, std::size_t count)
+{
+    DecompressFloat16Array(reinterpret_cast<const std::uint16_t*>(src), dst, count);
+}
+
+static void ReadResizeRow(const std::uint8_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_RESIZE_SSE2
+
+    const auto zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        auto v8     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto v16lo  = _mm_unpacklo_epi8(v8, zero);
+        auto v16hi  = _mm_unpackhi_epi8(v8, zero);
+        _mm_storeu_ps(dst + i     , _mm_cvtepi32_ps(_mm_unpacklo_epi16(v16lo, zero)));
+        _mm_storeu_ps(dst + i +  4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(v16lo, zero)));
+        _mm_storeu_ps(dst + i +  8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(v16hi, zero)));
+        _mm_storeu_ps(dst + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(v16hi, zero)));
+    }
+
+    #elif defined LLGL_RESIZE_NEON
+
+    for (; i + 16 <= count; i += 16)
+    {
+        auto v8     = vld1q_u8(src + i);
+        auto v16lo  = vmovl_u8(vget_low_u8(v8));
+        auto v16hi  = vmovl_u8(vget_high_u8(v8));
+        vst1q_f32(dst + i     , vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16lo))));
+        vst1q_f32(dst + i +  4, vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16lo))));
+        vst1q_f32(dst + i +  8, vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16hi))));
+        vst1q_f32(dst + i + 12, vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16hi))));
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+
+// Rounds the specified value to the nearest integer and clamps it to the range of the integral type 'T'.
+template <typename T, typename F>
+static T SaturateResizeValue(F value)
+{
+    const auto minValue = static_cast<F>(std::numeric_limits<T>::min());
+    const auto maxValue = static_cast<F>(std::numeric_limits<T>::max());
+
+    if (value <= minValue)
+        return std::numeric_limits<T>::min();
+    if (value >= maxValue)
+        return std::numeric_limits<T>::max();
+
+    return static_cast<T>(std::floor(value + F(0.5)));
+}
+
+template <typename T, typename F>
+static void WriteResizeRow(const F* src, T* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = SaturateResizeValue<T>(src[i]);
+}
+
+static void WriteResizeRow(const float* src, float* dst, std::size_t count)
+{
+    std::copy(src, src + count, dst);
+}
+
+static void WriteResizeRow(const double* src, double* dst, std::size_t count)
+{
+    std::copy(src, src + count, dst);
+}
+
+static void WriteResizeRow(const float* src, Half* dst, std::size_t count)
+{
+    CompressFloat16Array(src, reinterpret_cast<std::uint16_t*>(dst), count);
+}
+
+static void WriteResizeRow(const float* src, std::uint8_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    /* Round to nearest and saturate with the pack instructions */
+    #if defined LLGL_RESIZE_SSE2
+
+    for (; i + 16 <= count; i += 16)
+    {
+        auto v16lo = _mm_packs_epi32(_mm_cvtps_epi32(_mm_loadu_ps(src + i    )), _mm_cvtps_epi32(_mm_loadu_ps(src + i +  4)));
+        auto v16hi = _mm_packs_epi32(_mm_cvtps_epi32(_mm_loadu_ps(src + i + 8)), _mm_cvtps_epi32(_mm_loadu_ps(src + i + 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v16lo, v16hi));
+    }
+
+    #elif defined LLGL_RESIZE_NEON
+
+    for (; i + 16 <= count; i += 16)
+    {
+        auto v16lo = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(src + i    ))), vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(src + i +  4))));
+        auto v16hi = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(src + i + 8))), vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(src + i + 12))));
+        vst1q_u8(dst + i, vcombine_u8(vqmovun_s16(v16lo), vqmovun_s16(v16hi)));
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = SaturateResizeValue<std::uint8_t>(src[i]);
+}
+
+
+// Color space of the components of a resized row (only used for 8-bit unsigned integers).
+struct ResizeColorSpace
+{
+    bool        sRGB;
+    std::size_t numComponents;
+    std::size_t alphaIndex;
+};
+
+template <typename T, typename F>
+static void ReadResizeRow(const T* src, F* dst, std::size_t count, const ResizeColorSpace& /*colorSpace*/)
+{
+    ReadResizeRow(src, dst, count);
+}
+
+// Reads a row of 8-bit components and decodes sRGB components into linear values in the range [0, 255] with a lookup table.
+static void ReadResizeRow(const std::uint8_t* src, float* dst, std::size_t count, const ResizeColorSpace& colorSpace)
+{
+    if (colorSpace.sRGB)
+    {
+        DecodeSRGB8Array(src, dst, count, colorSpace.numComponents, colorSpace.alphaIndex);
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] *= 255.0f;
+    }
+    else
+        ReadResizeRow(src, dst, count);
+}
+
+template <typename T, typename F>
+static void WriteResizeRow(F* src, T* dst, std::size_t count, const ResizeColorSpace& /*colorSpace*/)
+{
+    WriteResizeRow(src, dst, count);
+}
+
+// Writes a row of 8-bit components and encodes linear values in the range [0, 255] into sRGB components. The source row is modified.
+static void WriteResizeRow(float* src, std::uint8_t* dst, std::size_t count, const ResizeColorSpace& colorSpace)
+{
+    if (colorSpace.sRGB)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            src[i] *= (1.0f / 255.0f);
+        EncodeSRGB8Array(src, dst, count, colorSpace.numComponents, colorSpace.alphaIndex);
+    }
+    else
+        WriteResizeRow(src, dst, count);
+}
+
+
+/* ----- Resampling kernels ----- */
+
+// Resamples a single row along the horizontal dimension.
+template <typename F>
+static void ResampleRowGeneric(const F* src, F* dst, const ResizeAxis<F>& axis, std::size_t numComponents)
+{
+    for (std::size_t x = 0; x < axis.contributors.size(); ++x)
+    {
+        const auto& contrib = axis.contributors[x];
+        const auto  weights = axis.weights.data() + contrib.offset;
+        const auto  srcPixels = src + contrib.first * numComponents;
+
+        for (std::size_t c = 0; c < numComponents; ++c)
+        {
+            F sum = F(0);
+            for (std::size_t k = 0; k < contrib.count; ++k)
+                sum += weights[k] * srcPixels[k * numComponents + c];
+            dst[x * numComponents + c] = sum;
+        }
+    }
+}
+
+template <typename F>
+static void ResampleRow(const F* src, F* dst, const ResizeAxis<F>& axis, std::size_t numComponents)
+{
+    ResampleRowGeneric(src, dst, axis, numComponents);
+}
+
+// Resamples a single row of 32-bit floats; pixels with four components are processed as a single vector.
+static void ResampleRow(const float* src, float* dst, const ResizeAxis<float>& axis, std::size_t numComponents)
+{
+    #if defined LLGL_RESIZE_SSE2 || defined LLGL_RESIZE_NEON
+
+    if (numComponents == 4)
+    {
+        for (std::size_t x = 0; x < axis.contributors.size(); ++x)
+        {
+            const auto& contrib = axis.contributors[x];
+            const auto  weights = axis.weights.data() + contrib.offset;
+            const auto  srcPixels = src + contrib.first * 4;
+
+            #ifdef LLGL_RESIZE_SSE2
+            auto sum = _mm_setzero_ps();
+            for (std::size_t k = 0; k < contrib.count; ++k)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(srcPixels + k * 4)));
+            _mm_storeu_ps(dst + x * 4, sum);
+            #else
+            auto sum = vdupq_n_f32(0.0f);
+            for (std::size_t k = 0; k < contrib.count; ++k)
+                sum = vmlaq_n_f32(sum, vld1q_f32(srcPixels + k * 4), weights[k]);
+            vst1q_f32(dst + x * 4, sum);
+            #endif
+        }
+        return;
+    }
+
+    #endif
+
+    ResampleRowGeneric(src, dst, axis, numComponents);
+}
+
+// Accumulates the weighted source rows into the destination row, i.e. dst[i] = sum(weights[k] * src[k * srcStride + i]), starting at index 'begin'.
+template <typename F>
+static void CombineRowsGeneric(const F* src, std::size_t srcStride, const F* weights, std::size_t count, F* dst, std::size_t length, std::size_t begin)
+{
+    for (auto i = begin; i < length; ++i)
+    {
+        F sum = F(0);
+        for (std::size_t k = 0; k < count; ++k)
+            sum += weights[k] * src[k * srcStride + i];
+        dst[i] = sum;
+    }
+}
+
+static void CombineRows(const double* src, std::size_t srcStride, const double* weights, std::size_t count, double* dst, std::size_t length)
+{
+    CombineRowsGeneric(src, srcStride, weights, count, dst, length, 0);
+}
+
+// Accumulates the weighted source rows of 32-bit floats; all components of a row share the same weight, so the row is processed in vectors.
+static void CombineRows(const float* src, std::size_t srcStride, const float* weights, std::size_t count, float* dst, std::size_t length)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_RESIZE_AVX
+
+    for (; i + 8 <= length; i += 8)
+    {
+        auto sum = _mm256_setzero_ps();
+        for (std::size_t k = 0; k < count; ++k)
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(src + k * srcStride + i)));
+        _mm256_storeu_ps(dst + i, sum);
+    }
+
+    #elif defined LLGL_RESIZE_SSE2
+
+    for (; i + 4 <= length; i += 4)
+    {
+        auto sum = _mm_setzero_ps();
+        for (std::size_t k = 0; k < count; ++k)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(src + k * srcStride + i)));
+        _mm_storeu_ps(dst + i, sum);
+    }
+
+    #elif defined LLGL_RESIZE_NEON
+
+    for (; i + 4 <= length; i += 4)
+    {
+        auto sum = vdupq_n_f32(0.0f);
+        for (std::size_t k = 0; k < count; ++k)
+            sum = vmlaq_n_f32(sum, vld1q_f32(src + k * srcStride + i), weights[k]);
+        vst1q_f32(dst + i, sum);
+    }
+
+    #endif
+
+    CombineRowsGeneric(src, srcStride, weights, count, dst, length, i);
+}
+
+// Returns the number of rows each task of the thread pool processes.
+static std::size_t GetResizeGrainSize(std::size_t rowLength)
+{
+    return std::max<std::size_t>(1, g_resizeGrainSize / std::max<std::size_t>(1, rowLength));
+}
+
+/*
+Resizes the image view in up to three separable passes, with components of type 'T' and intermediate values of type 'F':
+1. Resample each source row horizontally into an intermediate buffer.
+2. Combine the intermediate rows vertically, either into the destination buffer or into a second intermediate buffer if the depth changes.
+3. Combine the slices of the second intermediate buffer into the destination buffer.
+*/
+template <typename T, typename F>
+static void ResizeImageBufferTyped(
+    const ImageView&        srcView,
+    const MutableImageView& dstView,
+    const ResizeColorSpace& colorSpace,
+    const ImageResizeFilter filter,
+    std::size_t             threadCount)
+{
+    const auto  numComponents = colorSpace.numComponents;
+    const auto& srcExtent   = srcView.extent;
+    const auto& dstExtent   = dstView.extent;
+    const bool  resizeDepth = (srcExtent.depth != dstExtent.depth);
+
+    ResizeAxis<F> axisX, axisY, axisZ;
+    BuildResizeAxis(axisX, srcExtent.width, dstExtent.width, filter);
+    BuildResizeAxis(axisY, srcExtent.height, dstExtent.height, filter);
+    if (resizeDepth)
+        BuildResizeAxis(axisZ, srcExtent.depth, dstExtent.depth, filter);
+
+    const std::size_t srcRowLength  = srcExtent.width * numComponents;
+    const std::size_t dstRowLength  = dstExtent.width * numComponents;
+    const std::size_t srcHeight     = srcExtent.height;
+    const std::size_t dstHeight     = dstExtent.height;
+
+    /* Get strides (in bytes) of source and destination views */
+    const auto          src             = reinterpret_cast<const char*>(srcView.data);
+    const std::size_t   srcRowStride    = srcView.GetRowStride();
+    const std::size_t   srcDepthStride  = srcView.GetDepthStride();
+    const auto          dst             = reinterpret_cast<char*>(dstView.data);
+    const std::size_t   dstRowStride    = dstView.GetRowStride();
+    const std::size_t   dstDepthStride  = dstView.GetDepthStride();
+
+    auto GetSrcRow = [=](std::size_t row) -> const T*
+    {
+        return reinterpret_cast<const T*>(src + (row / srcHeight) * srcDepthStride + (row % srcHeight) * srcRowStride);
+    };
+
+    auto GetDstRow = [=](std::size_t row) -> T*
+    {
+        return reinterpret_cast<T*>(dst + (row / dstHeight) * dstDepthStride + (row % dstHeight) * dstRowStride);
+    };
+
+    auto& threadPool = ThreadPool::Get();
+
+    /* Resample all source rows horizontally */
+    const std::size_t numRowsX = srcHeight * srcExtent.depth;
+    std::vector<F> rowsX(numRowsX * dstRowLength);
+
+    threadPool.ParallelFor(
+        numRowsX, GetResizeGrainSize(srcRowLength), threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<F> srcRow(srcRowLength);
+            for (auto row = begin; row < end; ++row)
+            {
+                ReadResizeRow(GetSrcRow(row), srcRow.data(), srcRowLength, colorSpace);
+                ResampleRow(srcRow.data(), rowsX.data() + row * dstRowLength, axisX, numComponents);
+            }
+        }
+    );
+
+    /* Combine rows vertically within each source slice */
+    const std::size_t numRowsY = dstHeight * srcExtent.depth;
+    std::vector<F> rowsY(resizeDepth ? numRowsY * dstRowLength : 0);
+
+    threadPool.ParallelFor(
+        numRowsY, GetResizeGrainSize(dstRowLength), threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<F> dstRow(resizeDepth ? 0 : dstRowLength);
+            for (auto row = begin; row < end; ++row)
+            {
+                const auto  z       = row / dstHeight;
+                const auto& contrib = axisY.contributors[row % dstHeight];
+                const auto  srcRows = rowsX.data() + (z * srcHeight + contrib.first) * dstRowLength;
+                const auto  weights = axisY.weights.data() + contrib.offset;
+
+                if (resizeDepth)
+                    CombineRows(srcRows, dstRowLength, weights, contrib.count, rowsY.data() + row * dstRowLength, dstRowLength);
+                else
+                {
+                    CombineRows(srcRows, dstRowLength, weights, contrib.count, dstRow.data(), dstRowLength);
+                    WriteResizeRow(dstRow.data(), GetDstRow(row), dstRowLength, colorSpace);
+                }
+            }
+        }
+    );
+
+    if (resizeDepth)
+    {
+        /* Combine slices */
+        const std::size_t sliceLength   = dstHeight * dstRowLength;
+        const std::size_t numRowsZ      = dstHeight * dstExtent.depth;
+
+        threadPool.ParallelFor(
+            numRowsZ, GetResizeGrainSize(dstRowLength), threadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                std::vector<F> dstRow(dstRowLength);
+                for (auto row = begin; row < end; ++row)
+                {
+                    const auto& contrib = axisZ.contributors[row / dstHeight];
+                    const auto  srcRows = rowsY.data() + contrib.first * sliceLength + (row % dstHeight) * dstRowLength;
+                    const auto  weights = axisZ.weights.data() + contrib.offset;
+
+                    CombineRows(srcRows, sliceLength, weights, contrib.count, dstRow.data(), dstRowLength);
+                    WriteResizeRow(dstRow.data(), GetDstRow(row), dstRowLength, colorSpace);
+                }
+            }
+        );
+    }
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT void ResizeImageView(
+    const ImageView&        srcView,
+    const MutableImageView& dstView,
+    const ImageResizeFilter filter,
+    std::size_t             threadCount,
+    const ImageColorSpace   colorSpace)
+{
+    if (srcView.format != dstView.format || srcView.dataType != dstView.dataType)
+        throw std::invalid_argument("cannot resize image view into image view of different format or data type");
+    if (IsCompressedFormat(srcView.format) || srcView.format == ImageFormat::DepthStencil)
+        throw std::invalid_argument("cannot resize image with compressed or depth-stencil format");
+    if (colorSpace == ImageColorSpace::sRGB && srcView.dataType != DataType::UInt8)
+        throw std::invalid_argument("cannot resize sRGB image with data type other than UInt8");
+
+    const auto& srcExtent = srcView.extent;
+    const auto& dstExtent = dstView.extent;
+
+    if (srcExtent.width == 0 || srcExtent.height == 0 || srcExtent.depth == 0 ||
+        dstExtent.width == 0 || dstExtent.height == 0 || dstExtent.depth == 0)
+    {
+        return;
+    }
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    const ResizeColorSpace resizeColorSpace
+    {
+        (colorSpace == ImageColorSpace::sRGB && srcView.format != ImageFormat::Depth),
+        ImageFormatSize(srcView.format),
+        GetAlphaComponentIndex(srcView.format)
+    };
+
+    switch (srcView.dataType)
+    {
+        case DataType::Int8:
+            ResizeImageBufferTyped<std::int8_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::UInt8:
+            ResizeImageBufferTyped<std::uint8_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::Int16:
+            ResizeImageBufferTyped<std::int16_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::UInt16:
+            ResizeImageBufferTyped<std::uint16_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::Int32:
+            ResizeImageBufferTyped<std::int32_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::UInt32:
+            ResizeImageBufferTyped<std::uint32_t, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::Float16:
+            ResizeImageBufferTyped<Half, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::Float32:
+            ResizeImageBufferTyped<float, float>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+        case DataType::Float64:
+            ResizeImageBufferTyped<double, double>(srcView, dstView, resizeColorSpace, filter, threadCount);
+            break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
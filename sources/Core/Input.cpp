@@ -6,6 +6,7 @@
  */
 
 #include <LLGL/Input.h>
+#include <LLGL/InputEventQueue.h>
 #include <algorithm>
 
 
@@ -56,6 +57,30 @@ bool Input::KeyDoubleClick(Key keyCode) const
     return false;
 }
 
+void Input::ProcessEventQueue(InputEventQueue& queue)
+{
+    ResetFrameStates();
+
+    /* Apply all queued events in the order they have been received */
+    InputEvent event;
+    while (queue.Pop(event))
+    {
+        auto& sender = *event.sender;
+        switch (event.type)
+        {
+            case InputEventType::KeyDown:       OnKeyDown(sender, event.keyCode);           break;
+            case InputEventType::KeyUp:         OnKeyUp(sender, event.keyCode);             break;
+            case InputEventType::DoubleClick:   OnDoubleClick(sender, event.keyCode);       break;
+            case InputEventType::Char:          OnChar(sender, event.chr);                  break;
+            case InputEventType::WheelMotion:   OnWheelMotion(sender, event.wheelMotion);   break;
+            case InputEventType::LocalMotion:   OnLocalMotion(sender, event.offset);        break;
+            case InputEventType::GlobalMotion:  OnGlobalMotion(sender, event.offset);       break;
+            case InputEventType::LoseFocus:     OnLoseFocus(sender);                        break;
+            default:                                                                        break;
+        }
+    }
+}
+
 
 /*
  * ======= Protected: =======
@@ -63,16 +88,7 @@ bool Input::KeyDoubleClick(Key keyCode) const
 
 void Input::OnProcessEvents(Window& sender)
 {
-    wheelMotion_ = 0;
-    mouseMotion_ = { 0, 0 };
-
-    keyDownTracker_.Reset(keyDown_);
-    keyDownRepeatedTracker_.Reset(keyDownRepeated_);
-    keyUpTracker_.Reset(keyUp_);
-
-    std::fill(doubleClick_.begin(), doubleClick_.end(), false);
-
-    chars_.clear();
+    ResetFrameStates();
 }
 
 void Input::OnKeyDown(Window& sender, Key keyCode)
@@ -172,6 +188,20 @@ void Input::InitArray(KeyStateArray& keyStates)
     std::fill(keyStates.begin(), keyStates.end(), false);
 }
 
+void Input::ResetFrameStates()
+{
+    wheelMotion_ = 0;
+    mouseMotion_ = { 0, 0 };
+
+    keyDownTracker_.Reset(keyDown_);
+    keyDownRepeatedTracker_.Reset(keyDownRepeated_);
+    keyUpTracker_.Reset(keyUp_);
+
+    std::fill(doubleClick_.begin(), doubleClick_.end(), false);
+
+    chars_.clear();
+}
+
 
 /*
  * KeyTracker structure
@@ -0,0 +1,177 @@
+/*
+ * InputEventQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/InputEventQueue.h>
+#include <LLGL/Timer.h>
+
+
+namespace LLGL
+{
+
+
+// Returns the smallest power of two that is greater than or equal to the specified value (at least 2).
+static std::size_t GetNextPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 2;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+InputEventQueue::InputEventQueue(std::size_t capacity) :
+    events_           { GetNextPowerOfTwo(capacity) },
+    mask_             { events_.size() - 1          },
+    writeIndex_       { 0                           },
+    readIndex_        { 0                           },
+    numDroppedEvents_ { 0                           }
+{
+}
+
+bool InputEventQueue::Pop(InputEvent& event)
+{
+    const auto readIndex = readIndex_.load(std::memory_order_relaxed);
+
+    /* Acquire the event that has been published by the producer */
+    if (readIndex == writeIndex_.load(std::memory_order_acquire))
+        return false;
+
+    event = events_[readIndex & mask_];
+
+    /* Release the slot for the producer */
+    readIndex_.store(readIndex + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+/*
+ * ======= Protected: =======
+ */
+
+void InputEventQueue::OnKeyDown(Window& sender, Key keyCode)
+{
+    if (auto event = BeginPush(sender, InputEventType::KeyDown))
+    {
+        event->keyCode = keyCode;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnKeyUp(Window& sender, Key keyCode)
+{
+    if (auto event = BeginPush(sender, InputEventType::KeyUp))
+    {
+        event->keyCode = keyCode;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnDoubleClick(Window& sender, Key keyCode)
+{
+    if (auto event = BeginPush(sender, InputEventType::DoubleClick))
+    {
+        event->keyCode = keyCode;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnChar(Window& sender, wchar_t chr)
+{
+    if (auto event = BeginPush(sender, InputEventType::Char))
+    {
+        event->chr = chr;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnWheelMotion(Window& sender, int motion)
+{
+    if (auto event = BeginPush(sender, InputEventType::WheelMotion))
+    {
+        event->wheelMotion = motion;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnLocalMotion(Window& sender, const Offset2D& position)
+{
+    if (auto event = BeginPush(sender, InputEventType::LocalMotion))
+    {
+        event->offset = position;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnGlobalMotion(Window& sender, const Offset2D& motion)
+{
+    if (auto event = BeginPush(sender, InputEventType::GlobalMotion))
+    {
+        event->offset = motion;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnResize(Window& sender, const Extent2D& clientAreaSize)
+{
+    if (auto event = BeginPush(sender, InputEventType::Resize))
+    {
+        event->size = clientAreaSize;
+        EndPush();
+    }
+}
+
+void InputEventQueue::OnGetFocus(Window& sender)
+{
+    if (BeginPush(sender, InputEventType::GetFocus))
+        EndPush();
+}
+
+void InputEventQueue::OnLoseFocus(Window& sender)
+{
+    if (BeginPush(sender, InputEventType::LoseFocus))
+        EndPush();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+InputEvent* InputEventQueue::BeginPush(Window& sender, InputEventType type)
+{
+    const auto writeIndex = writeIndex_.load(std::memory_order_relaxed);
+
+    /* Drop event if the consumer has not released enough slots yet */
+    if (writeIndex - readIndex_.load(std::memory_order_acquire) >= events_.size())
+    {
+        numDroppedEvents_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    /* Initialize event in the next free slot */
+    auto event = &(events_[writeIndex & mask_]);
+    {
+        *event              = InputEvent{};
+        event->type         = type;
+        event->timestamp    = Timer::Tick();
+        event->sender       = &sender;
+    }
+    return event;
+}
+
+void InputEventQueue::EndPush()
+{
+    /* Publish the event in the current slot to the consumer */
+    writeIndex_.store(writeIndex_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
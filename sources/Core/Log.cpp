@@ -7,6 +7,13 @@
 
 #include <LLGL/Log.h>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -16,6 +23,23 @@ namespace Log
 {
 
 
+// Number of entries in the ring buffer of asynchronous logging (must be a power of two)
+static const std::uint64_t g_ringBufferSize = 1024;
+
+// Interval in which the background thread writes pending messages
+static const std::chrono::milliseconds g_flushInterval { 5 };
+
+/*
+Entry of the bounded MPSC ring buffer: 'sequence' equals the enqueue position when the entry is free,
+the enqueue position plus one when the entry has been filled, and the position of the next round once the entry has been written.
+*/
+struct LogEntry
+{
+    std::atomic<std::uint64_t>  sequence { 0 };
+    Severity                    severity = Severity::Info;
+    std::string                 text;
+};
+
 struct LogState
 {
     LogState() :
@@ -24,13 +48,136 @@ struct LogState
     {
     }
 
-    std::ostream* stdOut = nullptr;
-    std::ostream* stdErr = nullptr;
+    ~LogState()
+    {
+        EnableAsync(false);
+    }
+
+    std::ostream*                   stdOut          = nullptr;
+    std::ostream*                   stdErr          = nullptr;
+    std::atomic<int>                minSeverity     { static_cast<int>(Severity::Debug) };
+
+    /* Asynchronous logging */
+    std::atomic<bool>               asyncEnabled    { false };
+    std::unique_ptr<LogEntry[]>     entries;
+    std::atomic<std::uint64_t>      enqueuePos      { 0 };
+    std::uint64_t                   dequeuePos      = 0;        // Only accessed by the writing thread
+    std::atomic<std::uint64_t>      writtenPos      { 0 };
+    std::atomic<std::uint64_t>      numDropped      { 0 };
+
+    std::thread                     thread;
+    std::mutex                      mutex;
+    std::condition_variable         workSignal;
+    std::condition_variable         flushSignal;
+    bool                            quit            = false;
+    bool                            flushRequested  = false;
 };
 
 static LogState g_logState;
 
 
+static std::ostream& GetStream(Severity severity)
+{
+    return (severity >= Severity::Warning ? *(g_logState.stdErr) : *(g_logState.stdOut));
+}
+
+static void WriteMessage(Severity severity, const std::string& text)
+{
+    GetStream(severity) << text << '\n';
+}
+
+// Writes all filled entries of the ring buffer. Returns true if any message has been written.
+static bool DrainRingBuffer()
+{
+    auto& state = g_logState;
+    bool written = false;
+
+    for (;; ++state.dequeuePos)
+    {
+        auto& entry = state.entries[state.dequeuePos & (g_ringBufferSize - 1)];
+        if (entry.sequence.load(std::memory_order_acquire) != state.dequeuePos + 1)
+            break;
+
+        WriteMessage(entry.severity, entry.text);
+        entry.text.clear();
+
+        /* Release entry for the next round of the ring buffer */
+        entry.sequence.store(state.dequeuePos + g_ringBufferSize, std::memory_order_release);
+        written = true;
+    }
+
+    /* Report messages that have been dropped because the ring buffer was full */
+    if (auto numDropped = state.numDropped.exchange(0, std::memory_order_relaxed))
+    {
+        *(state.stdErr) << "LLGL log: " << numDropped << " message(s) dropped (ring buffer full)\n";
+        written = true;
+    }
+
+    if (written)
+    {
+        state.stdOut->flush();
+        state.stdErr->flush();
+    }
+
+    state.writtenPos.store(state.dequeuePos, std::memory_order_release);
+
+    return written;
+}
+
+static void WriterThreadProc()
+{
+    auto& state = g_logState;
+    std::unique_lock<std::mutex> lock { state.mutex };
+
+    while (!state.quit)
+    {
+        state.workSignal.wait_for(lock, g_flushInterval, [&state]() { return (state.quit || state.flushRequested); });
+        state.flushRequested = false;
+
+        lock.unlock();
+        {
+            DrainRingBuffer();
+        }
+        lock.lock();
+
+        state.flushSignal.notify_all();
+    }
+}
+
+static void EnqueueMessage(Severity severity, std::string&& message)
+{
+    auto& state = g_logState;
+    auto pos = state.enqueuePos.load(std::memory_order_relaxed);
+
+    /* Claim next free entry of the ring buffer without a lock */
+    LogEntry* entry = nullptr;
+    for (;;)
+    {
+        entry = &(state.entries[pos & (g_ringBufferSize - 1)]);
+        auto seq = entry->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::int64_t>(seq - pos);
+        if (diff == 0)
+        {
+            if (state.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            /* Ring buffer is full: drop message instead of blocking the calling thread */
+            state.numDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+            pos = state.enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    /* Fill entry and publish it to the writing thread */
+    entry->severity = severity;
+    entry->text     = std::move(message);
+    entry->sequence.store(pos + 1, std::memory_order_release);
+}
+
+
 LLGL_EXPORT void SetStdOut(std::ostream& stream)
 {
     g_logState.stdOut = &stream;
@@ -51,6 +198,83 @@ LLGL_EXPORT std::ostream& StdErr()
     return *(g_logState.stdErr);
 }
 
+LLGL_EXPORT void Post(Severity severity, std::string message)
+{
+    if (static_cast<int>(severity) < g_logState.minSeverity.load(std::memory_order_relaxed))
+        return;
+
+    if (g_logState.asyncEnabled.load(std::memory_order_acquire))
+        EnqueueMessage(severity, std::move(message));
+    else
+        GetStream(severity) << message << std::endl;
+}
+
+LLGL_EXPORT void SetMinSeverity(Severity severity)
+{
+    g_logState.minSeverity.store(static_cast<int>(severity), std::memory_order_relaxed);
+}
+
+LLGL_EXPORT Severity GetMinSeverity()
+{
+    return static_cast<Severity>(g_logState.minSeverity.load(std::memory_order_relaxed));
+}
+
+LLGL_EXPORT void EnableAsync(bool enable)
+{
+    auto& state = g_logState;
+
+    if (enable && !state.asyncEnabled.load())
+    {
+        /* Allocate ring buffer and initialize sequence of each entry with its enqueue position */
+        if (!state.entries)
+        {
+            state.entries = std::unique_ptr<LogEntry[]>(new LogEntry[g_ringBufferSize]);
+            for (std::uint64_t i = 0; i < g_ringBufferSize; ++i)
+                state.entries[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /* Start background thread */
+        state.quit = false;
+        state.thread = std::thread(WriterThreadProc);
+        state.asyncEnabled.store(true, std::memory_order_release);
+    }
+    else if (!enable && state.asyncEnabled.load())
+    {
+        state.asyncEnabled.store(false, std::memory_order_release);
+
+        /* Stop background thread and write all remaining messages */
+        {
+            std::lock_guard<std::mutex> guard { state.mutex };
+            state.quit = true;
+        }
+        state.workSignal.notify_one();
+        state.thread.join();
+
+        DrainRingBuffer();
+    }
+}
+
+LLGL_EXPORT void Flush()
+{
+    auto& state = g_logState;
+    if (!state.asyncEnabled.load(std::memory_order_acquire))
+        return;
+
+    /* Wake up background thread and wait until all messages posted so far have been written */
+    const auto targetPos = state.enqueuePos.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock { state.mutex };
+    state.flushRequested = true;
+    state.workSignal.notify_one();
+    state.flushSignal.wait(
+        lock,
+        [&state, targetPos]()
+        {
+            return (state.quit || state.writtenPos.load(std::memory_order_acquire) >= targetPos);
+        }
+    );
+}
+
 
 } // /namespace Log
 
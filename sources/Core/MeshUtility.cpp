@@ -0,0 +1,450 @@
+/*
+ * MeshUtility.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/MeshUtility.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Vertex cache optimization ----- */
+
+// Size of the simulated LRU cache for the vertex cache optimization
+static const int            g_forsythCacheSize      = 32;
+
+// Scoring parameters of the Forsyth algorithm
+static const float          g_forsythLastTriScore   = 0.75f;
+static const float          g_forsythDecayPower     = 1.5f;
+static const float          g_forsythValenceScale   = 2.0f;
+static const float          g_forsythValencePower   = 0.5f;
+
+// Returns the score of a vertex with the specified position in the LRU cache (or -1) and the number of remaining triangles.
+static float ForsythVertexScore(int cachePos, std::uint32_t numRemainingTris)
+{
+    if (numRemainingTris == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+
+    if (cachePos >= 0)
+    {
+        if (cachePos < 3)
+        {
+            /* Vertices of the last triangle get a fixed score to avoid consuming its strip-like neighbors too aggressively */
+            score = g_forsythLastTriScore;
+        }
+        else
+        {
+            const float scale = 1.0f / static_cast<float>(g_forsythCacheSize - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePos - 3) * scale, g_forsythDecayPower);
+        }
+    }
+
+    /* Boost vertices with few remaining triangles to avoid leftover triangles */
+    score += g_forsythValenceScale * std::pow(static_cast<float>(numRemainingTris), -g_forsythValencePower);
+
+    return score;
+}
+
+template <typename TIndex>
+static void OptimizeVertexCacheTmpl(TIndex* indices, std::size_t numIndices, std::size_t numVertices)
+{
+    const std::size_t numTris = numIndices / 3;
+    if (numTris == 0 || numVertices == 0)
+        return;
+
+    /* Build vertex-triangle adjacency */
+    std::vector<std::uint32_t> numRemainingTris(numVertices, 0);
+
+    for (std::size_t i = 0; i < numTris*3; ++i)
+        ++numRemainingTris[indices[i]];
+
+    std::vector<std::uint32_t> adjacencyOffsets(numVertices + 1, 0);
+
+    for (std::size_t v = 0; v < numVertices; ++v)
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + numRemainingTris[v];
+
+    std::vector<std::uint32_t> adjacency(numTris*3);
+    {
+        std::vector<std::uint32_t> adjacencyCount(numVertices, 0);
+        for (std::size_t i = 0; i < numTris*3; ++i)
+        {
+            const auto v = indices[i];
+            adjacency[adjacencyOffsets[v] + adjacencyCount[v]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    /* Initialize vertex and triangle scores */
+    std::vector<int>    cachePos(numVertices, -1);
+    std::vector<float>  vertexScores(numVertices);
+    std::vector<float>  triScores(numTris, 0.0f);
+    std::vector<bool>   triEmitted(numTris, false);
+
+    for (std::size_t v = 0; v < numVertices; ++v)
+        vertexScores[v] = ForsythVertexScore(-1, numRemainingTris[v]);
+
+    std::size_t bestTri = 0;
+
+    for (std::size_t t = 0; t < numTris; ++t)
+    {
+        triScores[t] = vertexScores[indices[t*3]] + vertexScores[indices[t*3 + 1]] + vertexScores[indices[t*3 + 2]];
+        if (triScores[t] > triScores[bestTri])
+            bestTri = t;
+    }
+
+    /* Emit triangles in order of their scores; the LRU cache has 3 extra entries for the vertices that are pushed out by each triangle */
+    std::vector<TIndex> output(numTris*3);
+    std::uint32_t       cache[g_forsythCacheSize + 3];
+    int                 cacheSize   = 0;
+    std::size_t         scanCursor  = 0;
+
+    for (std::size_t outputTri = 0; outputTri < numTris; ++outputTri)
+    {
+        if (bestTri == numTris)
+        {
+            /* No triangle in the cache is left, so continue with the first triangle that has not been emitted yet */
+            while (triEmitted[scanCursor])
+                ++scanCursor;
+            bestTri = scanCursor;
+        }
+
+        /* Emit best triangle and remove it from the adjacency of its vertices */
+        triEmitted[bestTri] = true;
+
+        std::uint32_t newCache[g_forsythCacheSize + 3];
+        int newCacheSize = 0;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto v = indices[bestTri*3 + i];
+            output[outputTri*3 + i] = v;
+
+            auto first  = adjacency.begin() + adjacencyOffsets[v];
+            auto last   = first + numRemainingTris[v];
+            std::iter_swap(std::find(first, last, static_cast<std::uint32_t>(bestTri)), last - 1);
+            --numRemainingTris[v];
+
+            newCache[newCacheSize++] = v;
+        }
+
+        /* Move the vertices of the emitted triangle to the front of the LRU cache */
+        for (int i = 0; i < cacheSize; ++i)
+        {
+            const auto v = cache[i];
+            if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+                newCache[newCacheSize++] = v;
+        }
+
+        /* Update scores of all vertices that were in the cache, including the ones that have just been evicted */
+        for (int i = 0; i < newCacheSize; ++i)
+        {
+            const auto v = newCache[i];
+            cachePos[v] = (i < g_forsythCacheSize ? i : -1);
+            vertexScores[v] = ForsythVertexScore(cachePos[v], numRemainingTris[v]);
+        }
+
+        /* Update scores of the remaining triangles of those vertices and select the next best triangle among them only */
+        bestTri = numTris;
+        float bestScore = -1.0f;
+
+        for (int i = 0; i < newCacheSize; ++i)
+        {
+            const auto v = newCache[i];
+            for (std::uint32_t j = 0; j < numRemainingTris[v]; ++j)
+            {
+                const auto t = adjacency[adjacencyOffsets[v] + j];
+                triScores[t] = vertexScores[indices[t*3]] + vertexScores[indices[t*3 + 1]] + vertexScores[indices[t*3 + 2]];
+                if (triScores[t] > bestScore)
+                {
+                    bestScore   = triScores[t];
+                    bestTri     = t;
+                }
+            }
+        }
+
+        cacheSize = std::min(newCacheSize, g_forsythCacheSize);
+        std::copy(newCache, newCache + cacheSize, cache);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+LLGL_EXPORT void OptimizeVertexCache(std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices)
+{
+    OptimizeVertexCacheTmpl(indices, numIndices, numVertices);
+}
+
+LLGL_EXPORT void OptimizeVertexCache(std::uint16_t* indices, std::size_t numIndices, std::size_t numVertices)
+{
+    OptimizeVertexCacheTmpl(indices, numIndices, numVertices);
+}
+
+/* ----- Overdraw optimization ----- */
+
+// Size of the simulated FIFO cache to determine the cluster boundaries for the overdraw optimization
+static const std::uint32_t  g_overdrawCacheSize     = 16;
+
+struct TriangleCluster
+{
+    std::size_t firstTri;
+    std::size_t numTris;
+    float       sortKey;
+};
+
+// Returns a pointer to the position of the specified vertex.
+static const float* GetPosition(const float* positions, std::size_t positionStride, std::size_t index)
+{
+    return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + index * positionStride);
+}
+
+template <typename TIndex>
+static void OptimizeOverdrawTmpl(
+    TIndex*         indices,
+    std::size_t     numIndices,
+    const float*    positions,
+    std::size_t     numVertices,
+    std::size_t     positionStride,
+    float           threshold)
+{
+    const std::size_t numTris = numIndices / 3;
+    if (numTris == 0 || numVertices == 0)
+        return;
+
+    /* Determine average cache miss ratio (ACMR) of the entire triangle list with a FIFO cache */
+    std::vector<std::uint32_t> cacheTimestamps(numVertices, 0);
+    std::uint32_t timestamp = g_overdrawCacheSize + 1;
+
+    auto CacheMiss = [&](std::size_t v) -> std::uint32_t
+    {
+        if (timestamp - cacheTimestamps[v] > g_overdrawCacheSize)
+        {
+            cacheTimestamps[v] = timestamp++;
+            return 1;
+        }
+        return 0;
+    };
+
+    std::size_t numMisses = 0;
+    for (std::size_t i = 0; i < numTris*3; ++i)
+        numMisses += CacheMiss(indices[i]);
+
+    const float maxClusterACMR = static_cast<float>(numMisses) / static_cast<float>(numTris) * std::max(1.0f, threshold);
+
+    /*
+    Split triangle list into clusters: each cluster starts with a flushed cache and ends as soon as its ACMR,
+    including the misses of its cold start, falls below the threshold, so the clusters can be drawn in any order.
+    */
+    std::vector<TriangleCluster> clusters;
+
+    for (std::size_t t = 0; t < numTris;)
+    {
+        TriangleCluster cluster { t, 0, 0.0f };
+        std::size_t clusterMisses = 0;
+
+        /* Flush cache */
+        timestamp += g_overdrawCacheSize + 1;
+
+        while (t < numTris)
+        {
+            clusterMisses += CacheMiss(indices[t*3]) + CacheMiss(indices[t*3 + 1]) + CacheMiss(indices[t*3 + 2]);
+            ++cluster.numTris;
+            ++t;
+
+            if (static_cast<float>(clusterMisses) <= maxClusterACMR * static_cast<float>(cluster.numTris))
+                break;
+        }
+
+        clusters.push_back(cluster);
+    }
+
+    if (clusters.size() < 2)
+        return;
+
+    /* Determine mesh centroid */
+    float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+
+    for (std::size_t v = 0; v < numVertices; ++v)
+    {
+        const auto p = GetPosition(positions, positionStride, v);
+        for (int i = 0; i < 3; ++i)
+            meshCentroid[i] += p[i];
+    }
+
+    for (int i = 0; i < 3; ++i)
+        meshCentroid[i] /= static_cast<float>(numVertices);
+
+    /* Sort key of each cluster is the distance of its area-weighted centroid from the mesh centroid along the average cluster normal */
+    for (auto& cluster : clusters)
+    {
+        float centroid[3]   = { 0.0f, 0.0f, 0.0f };
+        float normal[3]     = { 0.0f, 0.0f, 0.0f };
+        float area          = 0.0f;
+
+        for (std::size_t t = cluster.firstTri; t < cluster.firstTri + cluster.numTris; ++t)
+        {
+            const auto p0 = GetPosition(positions, positionStride, indices[t*3    ]);
+            const auto p1 = GetPosition(positions, positionStride, indices[t*3 + 1]);
+            const auto p2 = GetPosition(positions, positionStride, indices[t*3 + 2]);
+
+            const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            const float n[3]  =
+            {
+                e1[1]*e2[2] - e1[2]*e2[1],
+                e1[2]*e2[0] - e1[0]*e2[2],
+                e1[0]*e2[1] - e1[1]*e2[0],
+            };
+
+            /* Cross product length is twice the triangle area, which is fine for weighting */
+            const float triArea = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                centroid[i] += (p0[i] + p1[i] + p2[i]) * (triArea / 3.0f);
+                normal[i]   += n[i];
+            }
+
+            area += triArea;
+        }
+
+        const float normalLength = std::sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+
+        if (area > 0.0f && normalLength > 0.0f)
+        {
+            for (int i = 0; i < 3; ++i)
+                cluster.sortKey += (centroid[i] / area - meshCentroid[i]) * normal[i];
+            cluster.sortKey /= normalLength;
+        }
+    }
+
+    /* Draw outward facing clusters first */
+    std::stable_sort(
+        clusters.begin(),
+        clusters.end(),
+        [](const TriangleCluster& lhs, const TriangleCluster& rhs)
+        {
+            return (lhs.sortKey > rhs.sortKey);
+        }
+    );
+
+    std::vector<TIndex> output;
+    output.reserve(numTris*3);
+
+    for (const auto& cluster : clusters)
+        output.insert(output.end(), indices + cluster.firstTri*3, indices + (cluster.firstTri + cluster.numTris)*3);
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint32_t*  indices,
+    std::size_t     numIndices,
+    const float*    positions,
+    std::size_t     numVertices,
+    std::size_t     positionStride,
+    float           threshold)
+{
+    OptimizeOverdrawTmpl(indices, numIndices, positions, numVertices, positionStride, threshold);
+}
+
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint16_t*  indices,
+    std::size_t     numIndices,
+    const float*    positions,
+    std::size_t     numVertices,
+    std::size_t     positionStride,
+    float           threshold)
+{
+    OptimizeOverdrawTmpl(indices, numIndices, positions, numVertices, positionStride, threshold);
+}
+
+/* ----- Vertex fetch optimization ----- */
+
+template <typename TIndex>
+static std::size_t OptimizeVertexFetchTmpl(void* vertices, std::size_t numVertices, std::size_t vertexStride, TIndex* indices, std::size_t numIndices)
+{
+    /* Assign new vertex indices in the order the vertices are first referenced */
+    const std::size_t invalidIndex = ~static_cast<std::size_t>(0);
+
+    std::vector<std::size_t> remap(numVertices, invalidIndex);
+    std::size_t numReferencedVertices = 0;
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        auto& newIndex = remap[indices[i]];
+        if (newIndex == invalidIndex)
+            newIndex = numReferencedVertices++;
+        indices[i] = static_cast<TIndex>(newIndex);
+    }
+
+    /* Move unreferenced vertices to the end */
+    std::size_t numUnreferencedVertices = numReferencedVertices;
+
+    for (auto& newIndex : remap)
+    {
+        if (newIndex == invalidIndex)
+            newIndex = numUnreferencedVertices++;
+    }
+
+    /* Reorder vertices with a copy of the original vertex array */
+    auto vertexBytes = reinterpret_cast<char*>(vertices);
+    std::vector<char> originalVertices(vertexBytes, vertexBytes + numVertices * vertexStride);
+
+    for (std::size_t v = 0; v < numVertices; ++v)
+        std::memcpy(vertexBytes + remap[v] * vertexStride, originalVertices.data() + v * vertexStride, vertexStride);
+
+    return numReferencedVertices;
+}
+
+LLGL_EXPORT std::size_t OptimizeVertexFetch(void* vertices, std::size_t numVertices, std::size_t vertexStride, std::uint32_t* indices, std::size_t numIndices)
+{
+    return OptimizeVertexFetchTmpl(vertices, numVertices, vertexStride, indices, numIndices);
+}
+
+LLGL_EXPORT std::size_t OptimizeVertexFetch(void* vertices, std::size_t numVertices, std::size_t vertexStride, std::uint16_t* indices, std::size_t numIndices)
+{
+    return OptimizeVertexFetchTmpl(vertices, numVertices, vertexStride, indices, numIndices);
+}
+
+/* ----- Index compaction ----- */
+
+LLGL_EXPORT IndexFormat CompactIndices(std::uint32_t* indices, std::size_t numIndices)
+{
+    /* Keep 32-bit indices if any index collides with the 16-bit primitive restart index */
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        if (indices[i] >= 0xFFFF)
+            return IndexFormat(DataType::UInt32);
+    }
+
+    /* Write 16-bit indices in-place, which never overwrites any 32-bit index that has not been read yet */
+    auto dst = reinterpret_cast<char*>(indices);
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        const auto index = static_cast<std::uint16_t>(indices[i]);
+        std::memcpy(dst + i * sizeof(std::uint16_t), &index, sizeof(index));
+    }
+
+    return IndexFormat(DataType::UInt16);
+}
+
+
+} // /namespace LLGL
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,400 @@
+/*
+ * ShaderArchive.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ShaderArchive.h>
+#include "../Platform/MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Shader archive file layout (all integers are little-endian):
+- Header:       magic "LLSA", version (uint32), number of entries (uint32), reserved (uint32)
+- Entries:      one fixed-size entry per blob, sorted by key (entries with the same key keep their order)
+- Strings:      null terminated keys, entry points, and profiles
+- Blobs:        shader code (with null terminator) and binaries, each aligned to 16 bytes
+*/
+
+static const char           g_archiveMagic[4]   = { 'L', 'L', 'S', 'A' };
+static const std::uint32_t  g_archiveVersion    = 1;
+static const std::size_t    g_headerSize        = 16;
+static const std::size_t    g_entrySize         = 48;
+static const std::size_t    g_blobAlignment     = 16;
+
+// Byte offsets of the fields within each archive entry
+static const std::size_t    g_entryKey          = 0;
+static const std::size_t    g_entryType         = 4;
+static const std::size_t    g_entryLanguage     = 8;
+static const std::size_t    g_entrySourceType   = 12;
+static const std::size_t    g_entryEntryPoint   = 16;
+static const std::size_t    g_entryProfile      = 20;
+static const std::size_t    g_entryDataOffset   = 24;
+static const std::size_t    g_entryDataSize     = 32;
+
+
+/* ----- Internal functions ----- */
+
+static std::uint32_t ReadUInt32(const char* data)
+{
+    std::uint32_t value;
+    ::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static std::uint64_t ReadUInt64(const char* data)
+{
+    std::uint64_t value;
+    ::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static void WriteUInt32(char* data, std::uint32_t value)
+{
+    ::memcpy(data, &value, sizeof(value));
+}
+
+static void WriteUInt64(char* data, std::uint64_t value)
+{
+    ::memcpy(data, &value, sizeof(value));
+}
+
+static std::size_t AlignBlobOffset(std::size_t offset)
+{
+    return ((offset + g_blobAlignment - 1) / g_blobAlignment * g_blobAlignment);
+}
+
+static bool IsDataRangeInside(std::uint64_t offset, std::uint64_t length, std::size_t size)
+{
+    return (offset <= size && length <= size - offset);
+}
+
+// Returns true if the specified value is a valid ShaderType (must be updated when new shader types are appended).
+static bool IsValidShaderType(std::uint32_t type)
+{
+    return (type <= static_cast<std::uint32_t>(ShaderType::Mesh));
+}
+
+static bool IsValidBlobSourceType(std::uint32_t sourceType)
+{
+    return
+    (
+        sourceType == static_cast<std::uint32_t>(ShaderSourceType::CodeString) ||
+        sourceType == static_cast<std::uint32_t>(ShaderSourceType::BinaryBuffer)
+    );
+}
+
+static bool IsLanguageSupported(std::uint32_t language, const std::vector<ShadingLanguage>& languages)
+{
+    for (auto lang : languages)
+    {
+        if (static_cast<std::uint32_t>(lang) == language)
+            return true;
+    }
+    return false;
+}
+
+
+/* ----- Common ----- */
+
+ShaderArchive::ShaderArchive()
+{
+}
+
+ShaderArchive::ShaderArchive(const std::string& filename)
+{
+    Load(filename);
+}
+
+ShaderArchive::ShaderArchive(ShaderArchive&& rhs) :
+    file_       { std::move(rhs.file_) },
+    entries_    { rhs.entries_         },
+    numEntries_ { rhs.numEntries_      }
+{
+    rhs.entries_    = nullptr;
+    rhs.numEntries_ = 0;
+}
+
+ShaderArchive::~ShaderArchive()
+{
+}
+
+/* ----- Operators ----- */
+
+ShaderArchive& ShaderArchive::operator = (ShaderArchive&& rhs)
+{
+    file_           = std::move(rhs.file_);
+    entries_        = rhs.entries_;
+    numEntries_     = rhs.numEntries_;
+    rhs.entries_    = nullptr;
+    rhs.numEntries_ = 0;
+    return *this;
+}
+
+/* ----- Storage ----- */
+
+void ShaderArchive::Load(const std::string& filename)
+{
+    /* Release previous archive and map new file into memory */
+    entries_    = nullptr;
+    numEntries_ = 0;
+    file_.reset();
+
+    auto file = MappedFile::Open(filename);
+
+    const auto data = reinterpret_cast<const char*>(file->GetData());
+    const auto size = file->GetSize();
+
+    /* Validate header */
+    if (size < g_headerSize || ::memcmp(data, g_archiveMagic, sizeof(g_archiveMagic)) != 0)
+        throw std::runtime_error("unknown shader archive format: " + filename);
+    if (ReadUInt32(data + 4) != g_archiveVersion)
+        throw std::runtime_error("unsupported shader archive version: " + filename);
+
+    const auto numEntries = static_cast<std::size_t>(ReadUInt32(data + 8));
+    if (!IsDataRangeInside(g_headerSize, static_cast<std::uint64_t>(numEntries) * g_entrySize, size))
+        throw std::runtime_error("shader archive is truncated: " + filename);
+
+    /* Validate all entries once, so the lookups do not have to check any offsets */
+    auto IsValidString = [data, size](std::uint32_t offset) -> bool
+    {
+        return (offset < size && ::memchr(data + offset, '\0', size - offset) != nullptr);
+    };
+
+    const char* prevKey = nullptr;
+
+    for (std::size_t i = 0; i < numEntries; ++i)
+    {
+        const auto entry        = data + g_headerSize + i * g_entrySize;
+        const auto keyOffset    = ReadUInt32(entry + g_entryKey);
+        const auto sourceType   = ReadUInt32(entry + g_entrySourceType);
+        const auto entryPoint   = ReadUInt32(entry + g_entryEntryPoint);
+        const auto profile      = ReadUInt32(entry + g_entryProfile);
+        const auto dataOffset   = ReadUInt64(entry + g_entryDataOffset);
+        const auto dataSize     = ReadUInt64(entry + g_entryDataSize);
+
+        if (!IsValidShaderType(ReadUInt32(entry + g_entryType)) || !IsValidBlobSourceType(sourceType))
+            throw std::runtime_error("shader archive has invalid entry: " + filename);
+
+        if (!IsValidString(keyOffset) || (entryPoint != 0 && !IsValidString(entryPoint)) || (profile != 0 && !IsValidString(profile)))
+            throw std::runtime_error("shader archive has invalid string offset: " + filename);
+
+        /* Code strings must include their null terminator (check the size first, so adding the terminator cannot overflow) */
+        const bool isCode = (sourceType == static_cast<std::uint32_t>(ShaderSourceType::CodeString));
+        if (dataSize == 0 || dataSize >= size || !IsDataRangeInside(dataOffset, dataSize + (isCode ? 1 : 0), size))
+            throw std::runtime_error("shader archive has invalid blob range: " + filename);
+        if (isCode && data[dataOffset + dataSize] != '\0')
+            throw std::runtime_error("shader archive has code blob without null terminator: " + filename);
+
+        /* Keys must be sorted for binary search */
+        const auto key = data + keyOffset;
+        if (prevKey != nullptr && ::strcmp(prevKey, key) > 0)
+            throw std::runtime_error("shader archive has unsorted entries: " + filename);
+        prevKey = key;
+    }
+
+    entries_    = data + g_headerSize;
+    numEntries_ = numEntries;
+    file_       = std::move(file);
+}
+
+bool ShaderArchive::Save(const std::string& filename, const std::vector<ShaderArchiveEntry>& entries)
+{
+    /* Sort entries by key, but keep the order of entries with the same key */
+    std::vector<const ShaderArchiveEntry*> sortedEntries;
+    sortedEntries.reserve(entries.size());
+
+    for (const auto& entry : entries)
+    {
+        if (entry.key.empty())
+            throw std::invalid_argument("cannot write shader archive entry with empty key");
+        if (!IsValidShaderType(static_cast<std::uint32_t>(entry.type)))
+            throw std::invalid_argument("cannot write shader archive entry with invalid shader type: " + entry.key);
+        if (!IsValidBlobSourceType(static_cast<std::uint32_t>(entry.sourceType)))
+            throw std::invalid_argument("cannot write shader archive entry with source type other than code string or binary buffer: " + entry.key);
+        if (entry.data.empty())
+            throw std::invalid_argument("cannot write shader archive entry without data: " + entry.key);
+        sortedEntries.push_back(&entry);
+    }
+
+    std::stable_sort(
+        sortedEntries.begin(),
+        sortedEntries.end(),
+        [](const ShaderArchiveEntry* lhs, const ShaderArchiveEntry* rhs)
+        {
+            return (::strcmp(lhs->key.c_str(), rhs->key.c_str()) < 0);
+        }
+    );
+
+    /* Determine size of string table (offset 0 is reserved for empty strings, since it always points to the header) */
+    std::size_t stringsOffset = g_headerSize + sortedEntries.size() * g_entrySize;
+    std::size_t stringsSize = 0;
+
+    for (auto entry : sortedEntries)
+    {
+        stringsSize += entry->key.size() + 1;
+        if (!entry->entryPoint.empty())
+            stringsSize += entry->entryPoint.size() + 1;
+        if (!entry->profile.empty())
+            stringsSize += entry->profile.size() + 1;
+    }
+
+    /* Determine size of all blobs */
+    std::size_t blobsOffset = AlignBlobOffset(stringsOffset + stringsSize);
+    std::size_t fileSize = blobsOffset;
+
+    for (auto entry : sortedEntries)
+    {
+        const bool isCode = (entry->sourceType == ShaderSourceType::CodeString);
+        fileSize = AlignBlobOffset(fileSize) + entry->data.size() + (isCode ? 1 : 0);
+    }
+
+    if (stringsOffset + stringsSize > UINT32_MAX)
+        throw std::invalid_argument("cannot write shader archive with string table exceeding 4 GB");
+
+    /* Write entire archive into a single buffer */
+    std::vector<char> buffer(fileSize, '\0');
+
+    ::memcpy(buffer.data(), g_archiveMagic, sizeof(g_archiveMagic));
+    WriteUInt32(buffer.data() + 4, g_archiveVersion);
+    WriteUInt32(buffer.data() + 8, static_cast<std::uint32_t>(sortedEntries.size()));
+
+    auto WriteString = [&buffer, &stringsOffset](const std::string& s) -> std::uint32_t
+    {
+        if (s.empty())
+            return 0;
+        const auto offset = stringsOffset;
+        ::memcpy(&buffer[offset], s.c_str(), s.size() + 1);
+        stringsOffset += s.size() + 1;
+        return static_cast<std::uint32_t>(offset);
+    };
+
+    for (std::size_t i = 0; i < sortedEntries.size(); ++i)
+    {
+        const auto& src = *sortedEntries[i];
+        const auto  dst = buffer.data() + g_headerSize + i * g_entrySize;
+
+        blobsOffset = AlignBlobOffset(blobsOffset);
+
+        WriteUInt32(dst + g_entryKey,           WriteString(src.key));
+        WriteUInt32(dst + g_entryType,          static_cast<std::uint32_t>(src.type));
+        WriteUInt32(dst + g_entryLanguage,      static_cast<std::uint32_t>(src.language));
+        WriteUInt32(dst + g_entrySourceType,    static_cast<std::uint32_t>(src.sourceType));
+        WriteUInt32(dst + g_entryEntryPoint,    WriteString(src.entryPoint));
+        WriteUInt32(dst + g_entryProfile,       WriteString(src.profile));
+        WriteUInt64(dst + g_entryDataOffset,    blobsOffset);
+        WriteUInt64(dst + g_entryDataSize,      src.data.size());
+
+        /* Copy blob (code strings keep the null terminator from the zero-initialized buffer) */
+        ::memcpy(&buffer[blobsOffset], src.data.data(), src.data.size());
+        blobsOffset += src.data.size() + (src.sourceType == ShaderSourceType::CodeString ? 1 : 0);
+    }
+
+    std::ofstream file { filename, std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    return file.good();
+}
+
+/* ----- Shaders ----- */
+
+bool ShaderArchive::FindShaderDesc(const char* key, const std::vector<ShadingLanguage>& languages, ShaderDescriptor& shaderDesc) const
+{
+    /* Find first entry with the specified key by binary search */
+    std::size_t first = 0, count = numEntries_;
+
+    while (count > 0)
+    {
+        const auto step = count / 2;
+        if (::strcmp(GetString(ReadUInt32(GetEntry(first + step) + g_entryKey)), key) < 0)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+
+    /* Select first entry of this key with a supported shading language */
+    for (; first < numEntries_; ++first)
+    {
+        const auto entry = GetEntry(first);
+
+        if (::strcmp(GetString(ReadUInt32(entry + g_entryKey)), key) != 0)
+            break;
+
+        if (IsLanguageSupported(ReadUInt32(entry + g_entryLanguage), languages))
+        {
+            const auto entryPoint   = ReadUInt32(entry + g_entryEntryPoint);
+            const auto profile      = ReadUInt32(entry + g_entryProfile);
+
+            shaderDesc = ShaderDescriptor{};
+            {
+                shaderDesc.type         = static_cast<ShaderType>(ReadUInt32(entry + g_entryType));
+                shaderDesc.source       = GetString(0) + ReadUInt64(entry + g_entryDataOffset);
+                shaderDesc.sourceSize   = static_cast<std::size_t>(ReadUInt64(entry + g_entryDataSize));
+                shaderDesc.sourceType   = static_cast<ShaderSourceType>(ReadUInt32(entry + g_entrySourceType));
+                shaderDesc.entryPoint   = (entryPoint != 0 ? GetString(entryPoint) : nullptr);
+                shaderDesc.profile      = (profile != 0 ? GetString(profile) : nullptr);
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ShaderDescriptor ShaderArchive::GetShaderDesc(const char* key, const std::vector<ShadingLanguage>& languages) const
+{
+    ShaderDescriptor shaderDesc;
+    if (!FindShaderDesc(key, languages, shaderDesc))
+        throw std::runtime_error("shader archive does not contain shader for any supported shading language: \"" + std::string(key) + "\"");
+    return shaderDesc;
+}
+
+bool ShaderArchive::HasShader(const char* key, const ShadingLanguage language) const
+{
+    ShaderDescriptor shaderDesc;
+    return FindShaderDesc(key, { language }, shaderDesc);
+}
+
+std::size_t ShaderArchive::GetNumEntries() const
+{
+    return numEntries_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const char* ShaderArchive::GetEntry(std::size_t index) const
+{
+    return (entries_ + index * g_entrySize);
+}
+
+const char* ShaderArchive::GetString(std::uint32_t offset) const
+{
+    /* Entries start directly after the header, so the file begins at a fixed offset before them */
+    return (entries_ - g_headerSize + offset);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
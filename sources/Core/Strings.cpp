@@ -24,6 +24,8 @@ LLGL_EXPORT const char* ToString(const ShaderType t)
         case T::Geometry:       return "geometry";
         case T::Fragment:       return "fragment";
         case T::Compute:        return "compute";
+        case T::Amplification:  return "amplification";
+        case T::Mesh:           return "mesh";
     }
 
     return nullptr;
@@ -53,6 +55,7 @@ LLGL_EXPORT const char* ToString(const WarningType t)
         case T::ImproperArgument:   return "improper argument";
         case T::ImproperState:      return "improper state";
         case T::PointlessOperation: return "pointless operation";
+        case T::Performance:        return "performance";
     }
 
     return nullptr;
@@ -99,6 +102,9 @@ LLGL_EXPORT const char* ToString(const ShadingLanguage t)
         case T::Metal_1_0:  return "Metal 1.0";
         case T::Metal_1_1:  return "Metal 1.1";
         case T::Metal_1_2:  return "Metal 1.2";
+        case T::Metal_2_0:  return "Metal 2.0";
+        case T::Metal_2_1:  return "Metal 2.1";
+        case T::Metal_2_2:  return "Metal 2.2";
 
         case T::SPIRV:      return "SPIR-V";
         case T::SPIRV_100:  return "SPIR-V 1.00";
@@ -191,6 +197,11 @@ LLGL_EXPORT const char* ToString(const Format t)
         case T::BGRA8SInt:          return "BGRA8SInt";
         case T::BGRA8sRGB:          return "BGRA8sRGB";
 
+        /* --- Packed color formats --- */
+        case T::RGB10A2UNorm:       return "RGB10A2UNorm";
+        case T::RGB10A2UInt:        return "RGB10A2UInt";
+        case T::RG11B10Float:       return "RG11B10Float";
+
         /* --- Depth-stencil formats --- */
         case T::D16UNorm:           return "D16UNorm";
         case T::D32Float:           return "D32Float";
@@ -202,6 +213,57 @@ LLGL_EXPORT const char* ToString(const Format t)
         case T::BC1RGBA:            return "BC1 RGBA";
         case T::BC2RGBA:            return "BC2 RGBA";
         case T::BC3RGBA:            return "BC3 RGBA";
+        case T::BC1RGBAsRGB:        return "BC1 RGBA sRGB";
+        case T::BC2RGBAsRGB:        return "BC2 RGBA sRGB";
+        case T::BC3RGBAsRGB:        return "BC3 RGBA sRGB";
+        case T::BC4RUNorm:          return "BC4 R UNorm";
+        case T::BC4RSNorm:          return "BC4 R SNorm";
+        case T::BC5RGUNorm:         return "BC5 RG UNorm";
+        case T::BC5RGSNorm:         return "BC5 RG SNorm";
+        case T::BC6HRGBUFloat:      return "BC6H RGB UFloat";
+        case T::BC6HRGBSFloat:      return "BC6H RGB SFloat";
+        case T::BC7RGBAUNorm:       return "BC7 RGBA UNorm";
+        case T::BC7RGBAsRGB:        return "BC7 RGBA sRGB";
+
+        /* --- ETC2/EAC and ASTC compressed color formats --- */
+        case T::ETC2RGB8UNorm:      return "ETC2 RGB8 UNorm";
+        case T::ETC2RGB8sRGB:       return "ETC2 RGB8 sRGB";
+        case T::ETC2RGB8A1UNorm:    return "ETC2 RGB8A1 UNorm";
+        case T::ETC2RGB8A1sRGB:     return "ETC2 RGB8A1 sRGB";
+        case T::ETC2RGBA8UNorm:     return "ETC2 RGBA8 UNorm";
+        case T::ETC2RGBA8sRGB:      return "ETC2 RGBA8 sRGB";
+        case T::EACR11UNorm:        return "EAC R11 UNorm";
+        case T::EACR11SNorm:        return "EAC R11 SNorm";
+        case T::EACRG11UNorm:       return "EAC RG11 UNorm";
+        case T::EACRG11SNorm:       return "EAC RG11 SNorm";
+        case T::ASTC4x4UNorm:       return "ASTC4x4 UNorm";
+        case T::ASTC4x4sRGB:        return "ASTC4x4 sRGB";
+        case T::ASTC5x4UNorm:       return "ASTC5x4 UNorm";
+        case T::ASTC5x4sRGB:        return "ASTC5x4 sRGB";
+        case T::ASTC5x5UNorm:       return "ASTC5x5 UNorm";
+        case T::ASTC5x5sRGB:        return "ASTC5x5 sRGB";
+        case T::ASTC6x5UNorm:       return "ASTC6x5 UNorm";
+        case T::ASTC6x5sRGB:        return "ASTC6x5 sRGB";
+        case T::ASTC6x6UNorm:       return "ASTC6x6 UNorm";
+        case T::ASTC6x6sRGB:        return "ASTC6x6 sRGB";
+        case T::ASTC8x5UNorm:       return "ASTC8x5 UNorm";
+        case T::ASTC8x5sRGB:        return "ASTC8x5 sRGB";
+        case T::ASTC8x6UNorm:       return "ASTC8x6 UNorm";
+        case T::ASTC8x6sRGB:        return "ASTC8x6 sRGB";
+        case T::ASTC8x8UNorm:       return "ASTC8x8 UNorm";
+        case T::ASTC8x8sRGB:        return "ASTC8x8 sRGB";
+        case T::ASTC10x5UNorm:      return "ASTC10x5 UNorm";
+        case T::ASTC10x5sRGB:       return "ASTC10x5 sRGB";
+        case T::ASTC10x6UNorm:      return "ASTC10x6 UNorm";
+        case T::ASTC10x6sRGB:       return "ASTC10x6 sRGB";
+        case T::ASTC10x8UNorm:      return "ASTC10x8 UNorm";
+        case T::ASTC10x8sRGB:       return "ASTC10x8 sRGB";
+        case T::ASTC10x10UNorm:     return "ASTC10x10 UNorm";
+        case T::ASTC10x10sRGB:      return "ASTC10x10 sRGB";
+        case T::ASTC12x10UNorm:     return "ASTC12x10 UNorm";
+        case T::ASTC12x10sRGB:      return "ASTC12x10 sRGB";
+        case T::ASTC12x12UNorm:     return "ASTC12x12 UNorm";
+        case T::ASTC12x12sRGB:      return "ASTC12x12 sRGB";
     }
 
     return nullptr;
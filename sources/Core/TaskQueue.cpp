@@ -0,0 +1,88 @@
+/*
+ * TaskQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TaskQueue.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+TaskQueue::TaskQueue(std::size_t numWorkers)
+{
+    workers_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&TaskQueue::WorkerProc, this);
+}
+
+TaskQueue::~TaskQueue()
+{
+    /* Signal all worker threads to quit after the remaining tasks, and wait for them */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        quit_ = true;
+    }
+    taskSignal_.notify_all();
+
+    for (auto& w : workers_)
+        w.join();
+}
+
+TaskQueue& TaskQueue::Get()
+{
+    /* Keep one hardware thread for the main thread, but always start at least one worker */
+    static TaskQueue instance { std::max(2u, std::thread::hardware_concurrency()) - 1u };
+    return instance;
+}
+
+std::shared_future<void> TaskQueue::Enqueue(const Task& task)
+{
+    std::packaged_task<void()> packagedTask { task };
+    auto future = packagedTask.get_future().share();
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        tasks_.push_back(std::move(packagedTask));
+    }
+    taskSignal_.notify_one();
+    return future;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void TaskQueue::WorkerProc()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+
+        /* Wait for next task */
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            taskSignal_.wait(lock, [this]{ return (quit_ || !tasks_.empty()); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        /* Execute task; exceptions are stored in the future */
+        task();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,79 @@
+/*
+ * TaskQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TASK_QUEUE_H
+#define LLGL_TASK_QUEUE_H
+
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <deque>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Process-wide queue of asynchronous tasks, e.g. for background shader compilation.
+Tasks are executed in FIFO order by a fixed number of worker threads, independently of the ThreadPool for data-parallel loops.
+A task may wait for tasks that have been enqueued before it, but never for tasks that are enqueued after it.
+*/
+class TaskQueue
+{
+
+    public:
+
+        using Task = std::function<void()>;
+
+        TaskQueue(const TaskQueue&) = delete;
+        TaskQueue& operator = (const TaskQueue&) = delete;
+
+        ~TaskQueue();
+
+        // Returns the process-wide task queue. The worker threads are started with the first call.
+        static TaskQueue& Get();
+
+        // Enqueues the specified task and returns a future to wait for its completion. Exceptions of the task are rethrown by the future.
+        std::shared_future<void> Enqueue(const Task& task);
+
+    private:
+
+        TaskQueue(std::size_t numWorkers);
+
+        void WorkerProc();
+
+    private:
+
+        std::vector<std::thread>                        workers_;
+
+        std::mutex                                      mutex_;
+        std::condition_variable                         taskSignal_;
+        std::deque<std::packaged_task<void()>>          tasks_;
+        bool                                            quit_       = false;
+
+};
+
+// Returns true if the specified future is either invalid or ready, i.e. waiting for it does not block.
+inline bool IsFutureReady(const std::shared_future<void>& future)
+{
+    return (!future.valid() || future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,596 @@
+/*
+ * TextureContainer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureContainer.h>
+#include "../Platform/MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Reads a little-endian 32-bit unsigned integer from the specified unaligned memory.
+static std::uint32_t ReadUInt32(const char* data)
+{
+    std::uint32_t value;
+    ::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Reads a little-endian 64-bit unsigned integer from the specified unaligned memory.
+static std::uint64_t ReadUInt64(const char* data)
+{
+    std::uint64_t value;
+    ::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static constexpr std::uint32_t MakeFourCC(char c0, char c1, char c2, char c3)
+{
+    return
+    (
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c0))      ) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c1)) <<  8) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c2)) << 16) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c3)) << 24)
+    );
+}
+
+// Returns the image format that passes the data of the specified texture format to the render system as is, i.e. without conversion.
+static void GetContainerImageFormat(const Format format, ImageFormat& imageFormat, DataType& dataType)
+{
+    if (IsCompressedFormat(format))
+    {
+        imageFormat = ImageFormat::CompressedRGBA;
+        dataType    = DataType::UInt8;
+    }
+    else if (format == Format::BGRA8UNorm || format == Format::BGRA8UInt || format == Format::BGRA8sRGB)
+    {
+        imageFormat = ImageFormat::BGRA;
+        dataType    = DataType::UInt8;
+    }
+    else if (format == Format::BGRA8SNorm || format == Format::BGRA8SInt)
+    {
+        imageFormat = ImageFormat::BGRA;
+        dataType    = DataType::Int8;
+    }
+    else if (!FindSuitableImageFormat(format, imageFormat, dataType))
+        throw std::runtime_error("unsupported texture format in texture container");
+}
+
+// Returns the extent of the specified MIP-map level (without array layers).
+static Extent3D GetMipExtent(const Extent3D& extent, std::uint32_t mipLevel)
+{
+    return Extent3D
+    {
+        std::max(1u, extent.width  >> mipLevel),
+        std::max(1u, extent.height >> mipLevel),
+        std::max(1u, extent.depth  >> mipLevel)
+    };
+}
+
+static bool IsDataRangeInside(std::uint64_t offset, std::uint64_t length, std::size_t size)
+{
+    return (offset <= size && length <= size - offset);
+}
+
+
+/* ----- DDS (DirectDraw Surface) ----- */
+
+// Size (in bytes) of the DDS_HEADER structure
+static const std::size_t g_ddsHeaderSize        = 124;
+
+// Size (in bytes) of the DDS_HEADER_DXT10 structure
+static const std::size_t g_ddsHeaderDX10Size    = 20;
+
+// DDS_HEADER::dwFlags
+static const std::uint32_t DDSD_MIPMAPCOUNT     = 0x00020000;
+static const std::uint32_t DDSD_DEPTH           = 0x00800000;
+
+// DDS_PIXELFORMAT::dwFlags
+static const std::uint32_t DDPF_FOURCC          = 0x00000004;
+static const std::uint32_t DDPF_RGB             = 0x00000040;
+static const std::uint32_t DDPF_LUMINANCE       = 0x00020000;
+
+// DDS_HEADER::dwCaps2
+static const std::uint32_t DDSCAPS2_CUBEMAP             = 0x00000200;
+static const std::uint32_t DDSCAPS2_CUBEMAP_ALLFACES    = 0x0000FC00;
+static const std::uint32_t DDSCAPS2_VOLUME              = 0x00200000;
+
+// DDS_HEADER_DXT10::resourceDimension and DDS_HEADER_DXT10::miscFlag
+static const std::uint32_t DDS_DIMENSION_TEXTURE1D      = 2;
+static const std::uint32_t DDS_DIMENSION_TEXTURE2D      = 3;
+static const std::uint32_t DDS_DIMENSION_TEXTURE3D      = 4;
+static const std::uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x00000004;
+
+// Maps the specified DXGI_FORMAT value to a texture format, or returns Format::Undefined.
+static Format MapDDSFormatDXGI(std::uint32_t dxgiFormat)
+{
+    switch (dxgiFormat)
+    {
+        case  2: return Format::RGBA32Float;
+        case  3: return Format::RGBA32UInt;
+        case  4: return Format::RGBA32SInt;
+        case  6: return Format::RGB32Float;
+        case  7: return Format::RGB32UInt;
+        case  8: return Format::RGB32SInt;
+        case 10: return Format::RGBA16Float;
+        case 11: return Format::RGBA16UNorm;
+        case 12: return Format::RGBA16UInt;
+        case 13: return Format::RGBA16SNorm;
+        case 14: return Format::RGBA16SInt;
+        case 16: return Format::RG32Float;
+        case 17: return Format::RG32UInt;
+        case 18: return Format::RG32SInt;
+        case 28: return Format::RGBA8UNorm;
+        case 30: return Format::RGBA8UInt;
+        case 31: return Format::RGBA8SNorm;
+        case 32: return Format::RGBA8SInt;
+        case 34: return Format::RG16Float;
+        case 35: return Format::RG16UNorm;
+        case 36: return Format::RG16UInt;
+        case 37: return Format::RG16SNorm;
+        case 38: return Format::RG16SInt;
+        case 41: return Format::R32Float;
+        case 42: return Format::R32UInt;
+        case 43: return Format::R32SInt;
+        case 49: return Format::RG8UNorm;
+        case 50: return Format::RG8UInt;
+        case 51: return Format::RG8SNorm;
+        case 52: return Format::RG8SInt;
+        case 54: return Format::R16Float;
+        case 56: return Format::R16UNorm;
+        case 57: return Format::R16UInt;
+        case 58: return Format::R16SNorm;
+        case 59: return Format::R16SInt;
+        case 61: return Format::R8UNorm;
+        case 62: return Format::R8UInt;
+        case 63: return Format::R8SNorm;
+        case 64: return Format::R8SInt;
+        case 71: return Format::BC1RGBA;
+        case 72: return Format::BC1RGBAsRGB;
+        case 74: return Format::BC2RGBA;
+        case 75: return Format::BC2RGBAsRGB;
+        case 77: return Format::BC3RGBA;
+        case 78: return Format::BC3RGBAsRGB;
+        case 80: return Format::BC4RUNorm;
+        case 81: return Format::BC4RSNorm;
+        case 83: return Format::BC5RGUNorm;
+        case 84: return Format::BC5RGSNorm;
+        case 87: return Format::BGRA8UNorm;
+        case 91: return Format::BGRA8sRGB;
+        case 95: return Format::BC6HRGBUFloat;
+        case 96: return Format::BC6HRGBSFloat;
+        case 98: return Format::BC7RGBAUNorm;
+        case 99: return Format::BC7RGBAsRGB;
+        default: return Format::Undefined;
+    }
+}
+
+// Maps the specified legacy DDS_PIXELFORMAT structure to a texture format, or returns Format::Undefined.
+static Format MapDDSFormatLegacy(const char* pixelFormat)
+{
+    const auto flags        = ReadUInt32(pixelFormat + 4);
+    const auto fourCC       = ReadUInt32(pixelFormat + 8);
+    const auto bitCount     = ReadUInt32(pixelFormat + 12);
+    const auto maskR        = ReadUInt32(pixelFormat + 16);
+    const auto maskG        = ReadUInt32(pixelFormat + 20);
+    const auto maskB        = ReadUInt32(pixelFormat + 24);
+
+    if ((flags & DDPF_FOURCC) != 0)
+    {
+        switch (fourCC)
+        {
+            case MakeFourCC('D', 'X', 'T', '1'): return Format::BC1RGBA;
+            case MakeFourCC('D', 'X', 'T', '2'): return Format::BC2RGBA;
+            case MakeFourCC('D', 'X', 'T', '3'): return Format::BC2RGBA;
+            case MakeFourCC('D', 'X', 'T', '4'): return Format::BC3RGBA;
+            case MakeFourCC('D', 'X', 'T', '5'): return Format::BC3RGBA;
+            case MakeFourCC('A', 'T', 'I', '1'): return Format::BC4RUNorm;
+            case MakeFourCC('B', 'C', '4', 'U'): return Format::BC4RUNorm;
+            case MakeFourCC('B', 'C', '4', 'S'): return Format::BC4RSNorm;
+            case MakeFourCC('A', 'T', 'I', '2'): return Format::BC5RGUNorm;
+            case MakeFourCC('B', 'C', '5', 'U'): return Format::BC5RGUNorm;
+            case MakeFourCC('B', 'C', '5', 'S'): return Format::BC5RGSNorm;
+
+            /* D3DFORMAT values */
+            case  36: return Format::RGBA16UNorm;
+            case 110: return Format::RGBA16SNorm;
+            case 111: return Format::R16Float;
+            case 112: return Format::RG16Float;
+            case 113: return Format::RGBA16Float;
+            case 114: return Format::R32Float;
+            case 115: return Format::RG32Float;
+            case 116: return Format::RGBA32Float;
+
+            default:  return Format::Undefined;
+        }
+    }
+    else if ((flags & DDPF_RGB) != 0)
+    {
+        if (bitCount == 32 && maskR == 0x000000FF && maskG == 0x0000FF00 && maskB == 0x00FF0000)
+            return Format::RGBA8UNorm;
+        if (bitCount == 32 && maskR == 0x00FF0000 && maskG == 0x0000FF00 && maskB == 0x000000FF)
+            return Format::BGRA8UNorm;
+        if (bitCount == 24 && maskR == 0x000000FF && maskG == 0x0000FF00 && maskB == 0x00FF0000)
+            return Format::RGB8UNorm;
+    }
+    else if ((flags & DDPF_LUMINANCE) != 0)
+    {
+        if (bitCount == 8)
+            return Format::R8UNorm;
+    }
+
+    return Format::Undefined;
+}
+
+void TextureContainer::LoadDDS(const char* data, std::size_t size)
+{
+    if (size < 4 + g_ddsHeaderSize)
+        throw std::runtime_error("DDS file is truncated");
+
+    /* Read DDS_HEADER structure */
+    const auto header       = data + 4;
+    const auto flags        = ReadUInt32(header + 4);
+    const auto height       = ReadUInt32(header + 8);
+    const auto width        = ReadUInt32(header + 12);
+    const auto depth        = ReadUInt32(header + 20);
+    const auto mipCount     = ReadUInt32(header + 24);
+    const auto pixelFormat  = header + 72;
+    const auto caps2        = ReadUInt32(header + 108);
+
+    if (ReadUInt32(header) != g_ddsHeaderSize)
+        throw std::runtime_error("DDS file has invalid header size");
+
+    textureDesc_.extent     = { std::max(1u, width), std::max(1u, height), 1 };
+    textureDesc_.mipLevels  = ((flags & DDSD_MIPMAPCOUNT) != 0 ? std::max(1u, mipCount) : 1u);
+
+    std::size_t offset = 4 + g_ddsHeaderSize;
+
+    if (ReadUInt32(pixelFormat + 8) == MakeFourCC('D', 'X', '1', '0'))
+    {
+        /* Read DDS_HEADER_DXT10 structure */
+        if (size < offset + g_ddsHeaderDX10Size)
+            throw std::runtime_error("DDS file is truncated");
+
+        const auto headerDX10   = data + offset;
+        const auto dxgiFormat   = ReadUInt32(headerDX10);
+        const auto dimension    = ReadUInt32(headerDX10 + 4);
+        const auto miscFlag     = ReadUInt32(headerDX10 + 8);
+        const auto arraySize    = std::max(1u, ReadUInt32(headerDX10 + 12));
+
+        offset += g_ddsHeaderDX10Size;
+
+        textureDesc_.format = MapDDSFormatDXGI(dxgiFormat);
+
+        switch (dimension)
+        {
+            case DDS_DIMENSION_TEXTURE1D:
+                textureDesc_.type           = (arraySize > 1 ? TextureType::Texture1DArray : TextureType::Texture1D);
+                textureDesc_.extent.height  = 1;
+                textureDesc_.arrayLayers    = arraySize;
+                break;
+
+            case DDS_DIMENSION_TEXTURE2D:
+                if ((miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0)
+                {
+                    textureDesc_.type           = (arraySize > 1 ? TextureType::TextureCubeArray : TextureType::TextureCube);
+                    textureDesc_.arrayLayers    = arraySize * 6;
+                }
+                else
+                {
+                    textureDesc_.type           = (arraySize > 1 ? TextureType::Texture2DArray : TextureType::Texture2D);
+                    textureDesc_.arrayLayers    = arraySize;
+                }
+                break;
+
+            case DDS_DIMENSION_TEXTURE3D:
+                textureDesc_.type           = TextureType::Texture3D;
+                textureDesc_.extent.depth   = std::max(1u, depth);
+                break;
+
+            default:
+                throw std::runtime_error("DDS file has invalid resource dimension");
+        }
+    }
+    else
+    {
+        textureDesc_.format = MapDDSFormatLegacy(pixelFormat);
+
+        if ((caps2 & DDSCAPS2_CUBEMAP) != 0)
+        {
+            if ((caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+                throw std::runtime_error("DDS files with partial cube maps are not supported");
+            textureDesc_.type           = TextureType::TextureCube;
+            textureDesc_.arrayLayers    = 6;
+        }
+        else if ((caps2 & DDSCAPS2_VOLUME) != 0 && (flags & DDSD_DEPTH) != 0)
+        {
+            textureDesc_.type           = TextureType::Texture3D;
+            textureDesc_.extent.depth   = std::max(1u, depth);
+        }
+        else
+            textureDesc_.type           = TextureType::Texture2D;
+    }
+
+    if (textureDesc_.format == Format::Undefined)
+        throw std::runtime_error("unsupported pixel format in DDS file");
+
+    ImageFormat imageFormat;
+    DataType    dataType;
+    GetContainerImageFormat(textureDesc_.format, imageFormat, dataType);
+
+    /* DDS files store all MIP-map levels of each array layer (or cube face) consecutively */
+    images_.reserve(textureDesc_.arrayLayers * textureDesc_.mipLevels);
+
+    for (std::uint32_t arrayLayer = 0; arrayLayer < textureDesc_.arrayLayers; ++arrayLayer)
+    {
+        for (std::uint32_t mipLevel = 0; mipLevel < textureDesc_.mipLevels; ++mipLevel)
+        {
+            const std::size_t imageSize = TextureBufferSize(textureDesc_.format, GetMipExtent(textureDesc_.extent, mipLevel));
+            if (!IsDataRangeInside(offset, imageSize, size))
+                throw std::runtime_error("DDS file is truncated");
+
+            TextureSubresourceImage image;
+            {
+                image.mipLevel          = mipLevel;
+                image.baseArrayLayer    = arrayLayer;
+                image.numArrayLayers    = 1;
+                image.image             = SrcImageDescriptor { imageFormat, dataType, data + offset, imageSize };
+            }
+            images_.push_back(image);
+
+            offset += imageSize;
+        }
+    }
+}
+
+
+/* ----- KTX2 (Khronos Texture 2.0) ----- */
+
+static const char           g_ktx2Identifier[12]    = { '\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n' };
+
+// Size (in bytes) of the KTX2 header including the index (without the level index)
+static const std::size_t    g_ktx2HeaderSize        = 80;
+
+// Size (in bytes) of each entry in the KTX2 level index
+static const std::size_t    g_ktx2LevelIndexSize    = 24;
+
+// Maps the specified VkFormat value to a texture format, or returns Format::Undefined.
+static Format MapKTX2FormatVk(std::uint32_t vkFormat)
+{
+    /* VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK ... VK_FORMAT_ASTC_12x12_SRGB_BLOCK are in the same order as the respective texture formats */
+    if (vkFormat >= 147 && vkFormat <= 184)
+        return static_cast<Format>(static_cast<std::uint32_t>(Format::ETC2RGB8UNorm) + (vkFormat - 147));
+
+    switch (vkFormat)
+    {
+        case   9: return Format::R8UNorm;
+        case  10: return Format::R8SNorm;
+        case  13: return Format::R8UInt;
+        case  14: return Format::R8SInt;
+        case  16: return Format::RG8UNorm;
+        case  17: return Format::RG8SNorm;
+        case  20: return Format::RG8UInt;
+        case  21: return Format::RG8SInt;
+        case  23: return Format::RGB8UNorm;
+        case  24: return Format::RGB8SNorm;
+        case  27: return Format::RGB8UInt;
+        case  28: return Format::RGB8SInt;
+        case  37: return Format::RGBA8UNorm;
+        case  38: return Format::RGBA8SNorm;
+        case  41: return Format::RGBA8UInt;
+        case  42: return Format::RGBA8SInt;
+        case  44: return Format::BGRA8UNorm;
+        case  45: return Format::BGRA8SNorm;
+        case  48: return Format::BGRA8UInt;
+        case  49: return Format::BGRA8SInt;
+        case  50: return Format::BGRA8sRGB;
+        case  70: return Format::R16UNorm;
+        case  71: return Format::R16SNorm;
+        case  74: return Format::R16UInt;
+        case  75: return Format::R16SInt;
+        case  76: return Format::R16Float;
+        case  77: return Format::RG16UNorm;
+        case  78: return Format::RG16SNorm;
+        case  81: return Format::RG16UInt;
+        case  82: return Format::RG16SInt;
+        case  83: return Format::RG16Float;
+        case  84: return Format::RGB16UNorm;
+        case  85: return Format::RGB16SNorm;
+        case  88: return Format::RGB16UInt;
+        case  89: return Format::RGB16SInt;
+        case  90: return Format::RGB16Float;
+        case  91: return Format::RGBA16UNorm;
+        case  92: return Format::RGBA16SNorm;
+        case  95: return Format::RGBA16UInt;
+        case  96: return Format::RGBA16SInt;
+        case  97: return Format::RGBA16Float;
+        case  98: return Format::R32UInt;
+        case  99: return Format::R32SInt;
+        case 100: return Format::R32Float;
+        case 101: return Format::RG32UInt;
+        case 102: return Format::RG32SInt;
+        case 103: return Format::RG32Float;
+        case 104: return Format::RGB32UInt;
+        case 105: return Format::RGB32SInt;
+        case 106: return Format::RGB32Float;
+        case 107: return Format::RGBA32UInt;
+        case 108: return Format::RGBA32SInt;
+        case 109: return Format::RGBA32Float;
+        case 131: return Format::BC1RGB;
+        case 133: return Format::BC1RGBA;
+        case 134: return Format::BC1RGBAsRGB;
+        case 135: return Format::BC2RGBA;
+        case 136: return Format::BC2RGBAsRGB;
+        case 137: return Format::BC3RGBA;
+        case 138: return Format::BC3RGBAsRGB;
+        case 139: return Format::BC4RUNorm;
+        case 140: return Format::BC4RSNorm;
+        case 141: return Format::BC5RGUNorm;
+        case 142: return Format::BC5RGSNorm;
+        case 143: return Format::BC6HRGBUFloat;
+        case 144: return Format::BC6HRGBSFloat;
+        case 145: return Format::BC7RGBAUNorm;
+        case 146: return Format::BC7RGBAsRGB;
+        default:  return Format::Undefined;
+    }
+}
+
+void TextureContainer::LoadKTX2(const char* data, std::size_t size)
+{
+    if (size < g_ktx2HeaderSize)
+        throw std::runtime_error("KTX2 file is truncated");
+
+    /* Read KTX2 header */
+    const auto vkFormat         = ReadUInt32(data + 12);
+    const auto width            = ReadUInt32(data + 20);
+    const auto height           = ReadUInt32(data + 24);
+    const auto depth            = ReadUInt32(data + 28);
+    const auto layerCount       = ReadUInt32(data + 32);
+    const auto faceCount        = ReadUInt32(data + 36);
+    const auto levelCount       = ReadUInt32(data + 40);
+    const auto supercompression = ReadUInt32(data + 44);
+
+    if (supercompression != 0)
+        throw std::runtime_error("KTX2 files with supercompression are not supported");
+    if (faceCount != 1 && faceCount != 6)
+        throw std::runtime_error("KTX2 file has invalid number of faces");
+
+    textureDesc_.format = MapKTX2FormatVk(vkFormat);
+    if (textureDesc_.format == Format::Undefined)
+        throw std::runtime_error("unsupported VkFormat in KTX2 file: " + std::to_string(vkFormat));
+
+    /* Determine texture type from the texture dimensions */
+    const bool isArray = (layerCount > 0);
+
+    if (depth > 0)
+        textureDesc_.type = TextureType::Texture3D;
+    else if (faceCount == 6)
+        textureDesc_.type = (isArray ? TextureType::TextureCubeArray : TextureType::TextureCube);
+    else if (height == 0)
+        textureDesc_.type = (isArray ? TextureType::Texture1DArray : TextureType::Texture1D);
+    else
+        textureDesc_.type = (isArray ? TextureType::Texture2DArray : TextureType::Texture2D);
+
+    textureDesc_.extent         = { std::max(1u, width), std::max(1u, height), std::max(1u, depth) };
+    textureDesc_.arrayLayers    = std::max(1u, layerCount) * faceCount;
+    textureDesc_.mipLevels      = std::max(1u, levelCount);
+
+    if (!IsDataRangeInside(g_ktx2HeaderSize, g_ktx2LevelIndexSize * textureDesc_.mipLevels, size))
+        throw std::runtime_error("KTX2 file is truncated");
+
+    ImageFormat imageFormat;
+    DataType    dataType;
+    GetContainerImageFormat(textureDesc_.format, imageFormat, dataType);
+
+    /* KTX2 files store all array layers and cube faces of each MIP-map level consecutively */
+    images_.reserve(textureDesc_.mipLevels);
+
+    for (std::uint32_t mipLevel = 0; mipLevel < textureDesc_.mipLevels; ++mipLevel)
+    {
+        const auto levelIndex   = data + g_ktx2HeaderSize + g_ktx2LevelIndexSize * mipLevel;
+        const auto byteOffset   = ReadUInt64(levelIndex);
+        const auto byteLength   = ReadUInt64(levelIndex + 8);
+        const auto imageSize    = static_cast<std::uint64_t>(TextureBufferSize(textureDesc_.format, GetMipExtent(textureDesc_.extent, mipLevel))) * textureDesc_.arrayLayers;
+
+        if (!IsDataRangeInside(byteOffset, byteLength, size))
+            throw std::runtime_error("KTX2 file is truncated");
+        if (byteLength < imageSize)
+            throw std::runtime_error("KTX2 file has invalid length of MIP-map level " + std::to_string(mipLevel));
+
+        TextureSubresourceImage image;
+        {
+            image.mipLevel          = mipLevel;
+            image.baseArrayLayer    = 0;
+            image.numArrayLayers    = textureDesc_.arrayLayers;
+            image.image             = SrcImageDescriptor { imageFormat, dataType, data + byteOffset, static_cast<std::size_t>(imageSize) };
+        }
+        images_.push_back(image);
+    }
+}
+
+
+/* ----- Common ----- */
+
+TextureContainer::TextureContainer()
+{
+}
+
+TextureContainer::TextureContainer(const std::string& filename)
+{
+    Load(filename);
+}
+
+TextureContainer::TextureContainer(TextureContainer&& rhs) :
+    file_        { std::move(rhs.file_)        },
+    textureDesc_ { rhs.textureDesc_            },
+    images_      { std::move(rhs.images_)      }
+{
+}
+
+TextureContainer::~TextureContainer()
+{
+}
+
+/* ----- Operators ----- */
+
+TextureContainer& TextureContainer::operator = (TextureContainer&& rhs)
+{
+    file_           = std::move(rhs.file_);
+    textureDesc_    = rhs.textureDesc_;
+    images_         = std::move(rhs.images_);
+    return *this;
+}
+
+/* ----- Storage ----- */
+
+void TextureContainer::Load(const std::string& filename)
+{
+    /* Release previous container and map new file into memory */
+    images_.clear();
+    textureDesc_ = TextureDescriptor();
+    file_.reset();
+
+    auto file = MappedFile::Open(filename);
+
+    const auto data = reinterpret_cast<const char*>(file->GetData());
+    const auto size = file->GetSize();
+
+    /* Determine container type by its magic number */
+    try
+    {
+        if (size >= 4 && ::memcmp(data, "DDS ", 4) == 0)
+            LoadDDS(data, size);
+        else if (size >= sizeof(g_ktx2Identifier) && ::memcmp(data, g_ktx2Identifier, sizeof(g_ktx2Identifier)) == 0)
+            LoadKTX2(data, size);
+        else
+            throw std::runtime_error("unknown texture container format");
+    }
+    catch (const std::runtime_error& e)
+    {
+        /* Drop all images that point into the file that is about to be unmapped */
+        images_.clear();
+        textureDesc_ = TextureDescriptor();
+        throw std::runtime_error(std::string(e.what()) + ": " + filename);
+    }
+
+    file_ = std::move(file);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
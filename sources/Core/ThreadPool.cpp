@@ -0,0 +1,230 @@
+/*
+ * ThreadPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Maximal number of chunks per job, since chunk indices are packed into 32 bits
+static const std::size_t g_maxNumChunks = 0xFFFFFFFFu;
+
+// Flag to detect nested 'ParallelFor' calls from within a task
+static thread_local bool g_insideTask = false;
+
+static std::uint64_t PackRange(std::uint64_t begin, std::uint64_t end)
+{
+    return ((begin << 32) | end);
+}
+
+static void UnpackRange(std::uint64_t range, std::size_t& begin, std::size_t& end)
+{
+    begin   = static_cast<std::size_t>(range >> 32);
+    end     = static_cast<std::size_t>(range & 0xFFFFFFFFu);
+}
+
+ThreadPool::ThreadPool(std::size_t numWorkers) :
+    ranges_ { new std::atomic<std::uint64_t>[numWorkers + 1] }
+{
+    for (std::size_t i = 0; i <= numWorkers; ++i)
+        ranges_[i] = 0;
+
+    /* Start worker threads; slot 0 is reserved for the calling thread of 'ParallelFor' */
+    workers_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&ThreadPool::WorkerProc, this, i + 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+    /* Signal all worker threads to quit and wait for them */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        quit_ = true;
+    }
+    jobSignal_.notify_all();
+
+    for (auto& w : workers_)
+        w.join();
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    /* Keep one hardware thread for the calling thread */
+    static ThreadPool instance { std::max(1u, std::thread::hardware_concurrency()) - 1u };
+    return instance;
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grainSize, std::size_t threadCount, const TaskFunction& task)
+{
+    if (count == 0)
+        return;
+
+    /* Determine number of chunks */
+    grainSize = std::max(grainSize, std::max<std::size_t>(1, (count + g_maxNumChunks - 1) / g_maxNumChunks));
+    auto numChunks = (count + grainSize - 1) / grainSize;
+
+    /* Determine number of participating threads */
+    auto numSlots = std::min(std::min(threadCount, workers_.size() + 1), numChunks);
+
+    if (numSlots < 2 || g_insideTask)
+    {
+        /* Execute task on calling thread only */
+        task(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock { jobMutex_ };
+
+    /* Distribute chunks evenly among all participants */
+    auto chunksPerSlot  = numChunks / numSlots;
+    auto chunksRemain   = numChunks % numSlots;
+
+    std::size_t chunkOffset = 0;
+    for (std::size_t i = 0; i < numSlots; ++i)
+    {
+        auto numSlotChunks = chunksPerSlot + (i < chunksRemain ? 1 : 0);
+        ranges_[i].store(PackRange(chunkOffset, chunkOffset + numSlotChunks));
+        chunkOffset += numSlotChunks;
+    }
+
+    /* Publish job to worker threads */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        task_       = &task;
+        count_      = count;
+        grainSize_  = grainSize;
+        numSlots_   = numSlots;
+        numPending_ = numSlots - 1;
+        ++generation_;
+    }
+    jobSignal_.notify_all();
+
+    /* Participate on calling thread */
+    RunJob(0);
+
+    /* Wait until all participating workers have finished */
+    std::unique_lock<std::mutex> lock { mutex_ };
+    doneSignal_.wait(lock, [this]{ return (numPending_ == 0); });
+
+    task_ = nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::WorkerProc(std::size_t slot)
+{
+    std::uint64_t generation = 0;
+
+    while (true)
+    {
+        /* Wait for next job */
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            jobSignal_.wait(lock, [this, generation]{ return (quit_ || generation_ != generation); });
+
+            if (quit_)
+                return;
+
+            generation = generation_;
+
+            /* Skip jobs this worker does not participate in */
+            if (slot >= numSlots_)
+                continue;
+        }
+
+        RunJob(slot);
+
+        /* Notify calling thread when the last worker has finished */
+        {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            if (--numPending_ == 0)
+                doneSignal_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunJob(std::size_t slot)
+{
+    g_insideTask = true;
+
+    std::size_t chunk = 0;
+    do
+    {
+        while (PopChunk(slot, chunk))
+            ExecuteChunk(chunk);
+    }
+    while (StealChunks(slot));
+
+    g_insideTask = false;
+}
+
+bool ThreadPool::PopChunk(std::size_t slot, std::size_t& chunk)
+{
+    auto& range = ranges_[slot];
+    auto value = range.load();
+
+    std::size_t begin = 0, end = 0;
+    while (true)
+    {
+        UnpackRange(value, begin, end);
+        if (begin >= end)
+            return false;
+        if (range.compare_exchange_weak(value, PackRange(begin + 1, end)))
+            break;
+    }
+
+    chunk = begin;
+    return true;
+}
+
+bool ThreadPool::StealChunks(std::size_t slot)
+{
+    for (std::size_t i = 1; i < numSlots_; ++i)
+    {
+        auto& victim = ranges_[(slot + i) % numSlots_];
+        auto value = victim.load();
+
+        std::size_t begin = 0, end = 0;
+        while (true)
+        {
+            UnpackRange(value, begin, end);
+            if (begin >= end)
+                break;
+
+            /* Take back half of victim's range (at least one chunk) */
+            auto numStolen = (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(value, PackRange(begin, end - numStolen)))
+            {
+                /* Own range is exhausted, so no other thread modifies it except by failing to steal from it */
+                ranges_[slot].store(PackRange(end - numStolen, end));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::ExecuteChunk(std::size_t chunk)
+{
+    auto begin  = chunk * grainSize_;
+    auto end    = std::min(begin + grainSize_, count_);
+    (*task_)(begin, end);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,111 @@
+/*
+ * ThreadPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Process-wide pool of worker threads for data-parallel loops.
+The index range of each 'ParallelFor' call is split into chunks of 'grainSize' entries, which are evenly distributed among all participating threads.
+Each thread processes the chunks of its own range from the front, and steals the back half of another thread's range once its own range is exhausted.
+*/
+class ThreadPool
+{
+
+    public:
+
+        // Function that processes all entries in the range [begin, end).
+        using TaskFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        ~ThreadPool();
+
+        // Returns the process-wide thread pool. The worker threads are started with the first call.
+        static ThreadPool& Get();
+
+        /**
+        \brief Executes the specified task for all entries in the range [0, count) and blocks until all entries have been processed.
+        \param[in] count Specifies the number of entries.
+        \param[in] grainSize Specifies the maximal number of entries each invocation of the task processes. Ranges that consist of a single chunk are processed on the calling thread only.
+        \param[in] threadCount Specifies the maximal number of threads (including the calling thread) to use. If this is less than 2, the task is executed on the calling thread only.
+        \param[in] task Specifies the task function. This must not throw any exceptions.
+        \remarks Calls from within a task, i.e. nested loops, are executed on the calling thread only.
+        */
+        void ParallelFor(std::size_t count, std::size_t grainSize, std::size_t threadCount, const TaskFunction& task);
+
+        // Returns the number of worker threads (excluding the calling thread of 'ParallelFor').
+        inline std::size_t GetNumWorkers() const
+        {
+            return workers_.size();
+        }
+
+    private:
+
+        ThreadPool(std::size_t numWorkers);
+
+        void WorkerProc(std::size_t slot);
+
+        // Processes chunks of the current job until all ranges are exhausted.
+        void RunJob(std::size_t slot);
+
+        // Takes the next chunk from the front of the specified range.
+        bool PopChunk(std::size_t slot, std::size_t& chunk);
+
+        // Steals the back half of another participant's range and stores it in the specified range.
+        bool StealChunks(std::size_t slot);
+
+        void ExecuteChunk(std::size_t chunk);
+
+    private:
+
+        std::vector<std::thread>                    workers_;
+
+        std::mutex                                  jobMutex_;      // Serializes 'ParallelFor' calls from different threads
+        std::mutex                                  mutex_;
+        std::condition_variable                     jobSignal_;
+        std::condition_variable                     doneSignal_;
+        std::uint64_t                               generation_     = 0;
+        std::size_t                                 numPending_     = 0;
+        bool                                        quit_           = false;
+
+        /* Parameters of the current job */
+        const TaskFunction*                         task_           = nullptr;
+        std::size_t                                 count_          = 0;
+        std::size_t                                 grainSize_      = 0;
+        std::size_t                                 numSlots_       = 0;
+
+        // Chunk range [begin, end) of each participant, packed as (begin << 32 | end).
+        std::unique_ptr<std::atomic<std::uint64_t>[]> ranges_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -258,6 +258,12 @@ static void AssignShaderToDesc(ShaderProgramDescriptor& desc, Shader* shader)
             case ShaderType::Compute:
                 desc.computeShader = shader;
                 break;
+            case ShaderType::Amplification:
+                desc.amplificationShader = shader;
+                break;
+            case ShaderType::Mesh:
+                desc.meshShader = shader;
+                break;
         }
     }
 }
@@ -0,0 +1,290 @@
+/*
+ * VertexQuantization.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/Utility.h>
+#include "Float16Compressor.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_QUANTIZE_SSE2
+#   include <emmintrin.h>
+#elif (defined __ARM_NEON && defined __aarch64__) || defined _M_ARM64
+#   define LLGL_QUANTIZE_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+All scalar conversions round to nearest even (with the default floating-point environment),
+so they are identical to the SIMD conversions that are used for the bulk of each array.
+*/
+
+static std::int16_t QuantizeSNorm16Scalar(float value)
+{
+    value = std::max(-1.0f, std::min(value, 1.0f));
+    return static_cast<std::int16_t>(std::nearbyint(value * 32767.0f));
+}
+
+static std::uint32_t QuantizeUNormScalar(float value, float maxValue)
+{
+    value = std::max(0.0f, std::min(value, 1.0f));
+    return static_cast<std::uint32_t>(std::nearbyint(value * maxValue));
+}
+
+// Returns 1 if the specified value is greater than or equal to zero, and -1 otherwise.
+static float SignNotZero(float value)
+{
+    return (value >= 0.0f ? 1.0f : -1.0f);
+}
+
+static void QuantizeOctahedralScalar(const float* src, std::int16_t* dst)
+{
+    /* Project vector onto octahedron and fold the lower hemisphere over the diagonals */
+    const float s = std::max(std::abs(src[0]) + std::abs(src[1]) + std::abs(src[2]), 1.0e-30f);
+
+    float x = src[0] / s;
+    float y = src[1] / s;
+
+    if (src[2] < 0.0f)
+    {
+        const float wx = (1.0f - std::abs(y)) * SignNotZero(x);
+        const float wy = (1.0f - std::abs(x)) * SignNotZero(y);
+        x = wx;
+        y = wy;
+    }
+
+    dst[0] = QuantizeSNorm16Scalar(x);
+    dst[1] = QuantizeSNorm16Scalar(y);
+}
+
+#ifdef LLGL_QUANTIZE_SSE2
+
+static __m128i QuantizeSNorm16SSE2(__m128 v)
+{
+    v = _mm_max_ps(_mm_set1_ps(-1.0f), _mm_min_ps(v, _mm_set1_ps(1.0f)));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(32767.0f)));
+}
+
+static __m128i QuantizeUNormSSE2(__m128 v, float maxValue)
+{
+    v = _mm_max_ps(_mm_setzero_ps(), _mm_min_ps(v, _mm_set1_ps(1.0f)));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(maxValue)));
+}
+
+static __m128 SignNotZeroSSE2(__m128 v)
+{
+    const __m128 mask = _mm_cmpge_ps(v, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(mask, _mm_set1_ps(1.0f)), _mm_andnot_ps(mask, _mm_set1_ps(-1.0f)));
+}
+
+#endif // /LLGL_QUANTIZE_SSE2
+
+#ifdef LLGL_QUANTIZE_NEON
+
+static int32x4_t QuantizeSNorm16NEON(float32x4_t v)
+{
+    v = vmaxq_f32(vdupq_n_f32(-1.0f), vminq_f32(v, vdupq_n_f32(1.0f)));
+    return vcvtnq_s32_f32(vmulq_n_f32(v, 32767.0f));
+}
+
+static uint32x4_t QuantizeUNormNEON(float32x4_t v, float maxValue)
+{
+    v = vmaxq_f32(vdupq_n_f32(0.0f), vminq_f32(v, vdupq_n_f32(1.0f)));
+    return vcvtnq_u32_f32(vmulq_n_f32(v, maxValue));
+}
+
+static float32x4_t SignNotZeroNEON(float32x4_t v)
+{
+    return vbslq_f32(vcgeq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f), vdupq_n_f32(-1.0f));
+}
+
+#endif // /LLGL_QUANTIZE_NEON
+
+
+/* ----- Vertex quantization utility functions ----- */
+
+LLGL_EXPORT void QuantizeFloat16(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    CompressFloat16Array(src, dst, count);
+}
+
+LLGL_EXPORT void QuantizeSNorm16(const float* src, std::int16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_QUANTIZE_SSE2
+
+    /* Quantize 8 values per iteration */
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i lo = QuantizeSNorm16SSE2(_mm_loadu_ps(src + i));
+        const __m128i hi = QuantizeSNorm16SSE2(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+
+    #elif defined LLGL_QUANTIZE_NEON
+
+    /* Quantize 8 values per iteration */
+    for (; i + 8 <= count; i += 8)
+    {
+        const int16x4_t lo = vqmovn_s32(QuantizeSNorm16NEON(vld1q_f32(src + i)));
+        const int16x4_t hi = vqmovn_s32(QuantizeSNorm16NEON(vld1q_f32(src + i + 4)));
+        vst1q_s16(dst + i, vcombine_s16(lo, hi));
+    }
+
+    #endif
+
+    /* Quantize remaining values */
+    for (; i < count; ++i)
+        dst[i] = QuantizeSNorm16Scalar(src[i]);
+}
+
+LLGL_EXPORT void QuantizeRGB10A2UNorm(const float* src, std::uint32_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_QUANTIZE_SSE2
+
+    /* Quantize 4 vectors per iteration: transpose them into one register per component */
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 r = _mm_loadu_ps(src + i*4);
+        __m128 g = _mm_loadu_ps(src + i*4 + 4);
+        __m128 b = _mm_loadu_ps(src + i*4 + 8);
+        __m128 a = _mm_loadu_ps(src + i*4 + 12);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        __m128i packed = QuantizeUNormSSE2(r, 1023.0f);
+        packed = _mm_or_si128(packed, _mm_slli_epi32(QuantizeUNormSSE2(g, 1023.0f), 10));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(QuantizeUNormSSE2(b, 1023.0f), 20));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(QuantizeUNormSSE2(a, 3.0f), 30));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+
+    #elif defined LLGL_QUANTIZE_NEON
+
+    /* Quantize 4 vectors per iteration: de-interleave them into one register per component */
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x4_t v = vld4q_f32(src + i*4);
+
+        uint32x4_t packed = QuantizeUNormNEON(v.val[0], 1023.0f);
+        packed = vorrq_u32(packed, vshlq_n_u32(QuantizeUNormNEON(v.val[1], 1023.0f), 10));
+        packed = vorrq_u32(packed, vshlq_n_u32(QuantizeUNormNEON(v.val[2], 1023.0f), 20));
+        packed = vorrq_u32(packed, vshlq_n_u32(QuantizeUNormNEON(v.val[3], 3.0f), 30));
+
+        vst1q_u32(dst + i, packed);
+    }
+
+    #endif
+
+    /* Quantize remaining vectors */
+    for (; i < count; ++i)
+    {
+        const float* v = src + i*4;
+        dst[i] =
+        (
+            (QuantizeUNormScalar(v[0], 1023.0f)      ) |
+            (QuantizeUNormScalar(v[1], 1023.0f) << 10) |
+            (QuantizeUNormScalar(v[2], 1023.0f) << 20) |
+            (QuantizeUNormScalar(v[3],    3.0f) << 30)
+        );
+    }
+}
+
+LLGL_EXPORT void QuantizeOctahedralSNorm16(const float* src, std::int16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_QUANTIZE_SSE2
+
+    /* Encode 4 vectors per iteration */
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* v = src + i*3;
+        const __m128 x = _mm_setr_ps(v[0], v[3], v[6], v[ 9]);
+        const __m128 y = _mm_setr_ps(v[1], v[4], v[7], v[10]);
+        const __m128 z = _mm_setr_ps(v[2], v[5], v[8], v[11]);
+
+        /* Project vectors onto octahedron */
+        __m128 s = _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absMask), _mm_and_ps(y, absMask)), _mm_and_ps(z, absMask));
+        s = _mm_max_ps(s, _mm_set1_ps(1.0e-30f));
+
+        const __m128 px = _mm_div_ps(x, s);
+        const __m128 py = _mm_div_ps(y, s);
+
+        /* Fold lower hemisphere over the diagonals */
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 wx = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(py, absMask)), SignNotZeroSSE2(px));
+        const __m128 wy = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(px, absMask)), SignNotZeroSSE2(py));
+
+        const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+        const __m128 ex = _mm_or_ps(_mm_and_ps(lower, wx), _mm_andnot_ps(lower, px));
+        const __m128 ey = _mm_or_ps(_mm_and_ps(lower, wy), _mm_andnot_ps(lower, py));
+
+        /* Quantize and interleave X and Y coordinates */
+        const __m128i qx = QuantizeSNorm16SSE2(ex);
+        const __m128i qy = QuantizeSNorm16SSE2(ey);
+        const __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(qx, qy), _mm_unpackhi_epi32(qx, qy));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*2), packed);
+    }
+
+    #elif defined LLGL_QUANTIZE_NEON
+
+    /* Encode 4 vectors per iteration */
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x3_t v = vld3q_f32(src + i*3);
+
+        /* Project vectors onto octahedron */
+        float32x4_t s = vaddq_f32(vaddq_f32(vabsq_f32(v.val[0]), vabsq_f32(v.val[1])), vabsq_f32(v.val[2]));
+        s = vmaxq_f32(s, vdupq_n_f32(1.0e-30f));
+
+        const float32x4_t px = vdivq_f32(v.val[0], s);
+        const float32x4_t py = vdivq_f32(v.val[1], s);
+
+        /* Fold lower hemisphere over the diagonals */
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t wx = vmulq_f32(vsubq_f32(one, vabsq_f32(py)), SignNotZeroNEON(px));
+        const float32x4_t wy = vmulq_f32(vsubq_f32(one, vabsq_f32(px)), SignNotZeroNEON(py));
+
+        const uint32x4_t lower = vcltq_f32(v.val[2], vdupq_n_f32(0.0f));
+
+        /* Quantize and interleave X and Y coordinates */
+        int16x4x2_t packed;
+        packed.val[0] = vqmovn_s32(QuantizeSNorm16NEON(vbslq_f32(lower, wx, px)));
+        packed.val[1] = vqmovn_s32(QuantizeSNorm16NEON(vbslq_f32(lower, wy, py)));
+
+        vst2_s16(dst + i*2, packed);
+    }
+
+    #endif
+
+    /* Encode remaining vectors */
+    for (; i < count; ++i)
+        QuantizeOctahedralScalar(src + i*3, dst + i*2);
+}
+
+
+} // /namespace LLGL
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,66 @@
+/*
+ * FrameTimer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/FrameTimer.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+FrameTimer::FrameTimer(std::size_t capacity) :
+    samples_ ( std::max(capacity, std::size_t(1)), 0 )
+{
+}
+
+void FrameTimer::AddSample(std::uint64_t ticks)
+{
+    samples_[nextSample_] = ticks;
+    nextSample_ = (nextSample_ + 1) % samples_.size();
+    numSamples_ = std::min(numSamples_ + 1, samples_.size());
+}
+
+void FrameTimer::Reset()
+{
+    nextSample_ = 0;
+    numSamples_ = 0;
+}
+
+FrameTimerStatistics FrameTimer::GetStatistics() const
+{
+    FrameTimerStatistics stats;
+
+    if (numSamples_ == 0)
+        return stats;
+
+    /* Sort copy of the valid samples (the ring buffer is only partially filled until it wraps around) */
+    std::vector<std::uint64_t> sorted(samples_.begin(), samples_.begin() + numSamples_);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::uint64_t sum = 0;
+    for (auto s : sorted)
+        sum += s;
+
+    const auto secondsPerTick = 1.0 / static_cast<double>(Timer::GetTickFrequency());
+
+    stats.numSamples    = numSamples_;
+    stats.minTime       = static_cast<double>(sorted.front()) * secondsPerTick;
+    stats.meanTime      = static_cast<double>(sum) * secondsPerTick / static_cast<double>(numSamples_);
+    stats.medianTime    = static_cast<double>(sorted[(numSamples_ - 1) / 2]) * secondsPerTick;
+    stats.p99Time       = static_cast<double>(sorted[(numSamples_ * 99 + 99) / 100 - 1]) * secondsPerTick;
+    stats.maxTime       = static_cast<double>(sorted.back()) * secondsPerTick;
+
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
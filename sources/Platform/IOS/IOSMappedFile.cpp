@@ -0,0 +1,97 @@
+/*
+ * IOSMappedFile.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "IOSMappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Advises the kernel about the usage of the specified range, extended to page boundaries.
+static void AdviseMappedRange(void* data, std::size_t fileSize, std::size_t offset, std::size_t size, int advice)
+{
+    if (offset >= fileSize || size == 0)
+        return;
+
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const auto begin    = offset / pageSize * pageSize;
+    const auto end      = std::min(offset + size, fileSize);
+
+    madvise(reinterpret_cast<char*>(data) + begin, end - begin, advice);
+}
+
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& filename)
+{
+    return std::unique_ptr<MappedFile>(new IOSMappedFile(filename));
+}
+
+IOSMappedFile::IOSMappedFile(const std::string& filename)
+{
+    /* Open file for read access */
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::runtime_error("failed to open file: \"" + filename + "\"");
+
+    /* Query file size */
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == -1 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        throw std::runtime_error("failed to determine size of file: \"" + filename + "\"");
+    }
+
+    size_ = static_cast<std::size_t>(fileStat.st_size);
+
+    /* Map entire file into read-only memory (the mapping remains valid after the file descriptor is closed) */
+    auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        throw std::runtime_error("failed to map file into memory: \"" + filename + "\"");
+
+    data_ = data;
+}
+
+IOSMappedFile::~IOSMappedFile()
+{
+    munmap(data_, size_);
+}
+
+const void* IOSMappedFile::GetData() const
+{
+    return data_;
+}
+
+std::size_t IOSMappedFile::GetSize() const
+{
+    return size_;
+}
+
+void IOSMappedFile::Prefetch(std::size_t offset, std::size_t size) const
+{
+    AdviseMappedRange(data_, size_, offset, size, MADV_WILLNEED);
+}
+
+void IOSMappedFile::Discard(std::size_t offset, std::size_t size) const
+{
+    /* Pages of a read-only file mapping are re-read from the file if they are accessed again */
+    AdviseMappedRange(data_, size_, offset, size, MADV_DONTNEED);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
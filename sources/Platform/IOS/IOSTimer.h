@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Timer.h>
+#include <mach/mach_time.h>
 
 
 namespace LLGL
@@ -30,6 +30,23 @@ std::uint64_t IOSTimer::Stop()
     return 0;
 }
 
+std::uint64_t Timer::Tick()
+{
+    return static_cast<std::uint64_t>(mach_absolute_time());
+}
+
+std::uint64_t Timer::GetTickFrequency()
+{
+    /* Convert timebase (nanoseconds per tick as fraction) into ticks per second */
+    static const std::uint64_t frequency = []()
+    {
+        mach_timebase_info_data_t timebaseInfo;
+        mach_timebase_info(&timebaseInfo);
+        return (timebaseInfo.numer > 0 ? 1000000000ull * timebaseInfo.denom / timebaseInfo.numer : 1000000000ull);
+    }();
+    return frequency;
+}
+
 std::uint64_t IOSTimer::GetFrequency() const
 {
     return 0;
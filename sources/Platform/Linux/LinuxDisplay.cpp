@@ -26,6 +26,16 @@ LinuxSharedX11Display::LinuxSharedX11Display() :
 {
     if (!native_)
         throw std::runtime_error("failed to open connection to X server");
+
+    /* Get notified about screen configuration changes on all screens of this connection */
+    int rrErrorBase = 0;
+    if (XRRQueryExtension(native_, &rrEventBase_, &rrErrorBase))
+    {
+        for (int i = 0, n = ScreenCount(native_); i < n; ++i)
+            XRRSelectInput(native_, RootWindow(native_, i), RRScreenChangeNotifyMask);
+    }
+    else
+        rrEventBase_ = -1;
 }
  
 LinuxSharedX11Display::~LinuxSharedX11Display()
@@ -33,6 +43,25 @@ LinuxSharedX11Display::~LinuxSharedX11Display()
     XCloseDisplay(native_);
 }
 
+std::uint64_t LinuxSharedX11Display::PollScreenChanges()
+{
+    if (rrEventBase_ < 0)
+    {
+        /* Without Xrandr there are no notifications, so cached data must never be reused */
+        return ++generation_;
+    }
+
+    /* Consume all pending screen change events; this connection is not shared with any window, so no other events are queued */
+    XEvent event;
+    while (XCheckTypedEvent(native_, rrEventBase_ + RRScreenChangeNotify, &event))
+    {
+        XRRUpdateConfiguration(&event);
+        ++generation_;
+    }
+
+    return generation_;
+}
+
 
 /*
  * Display class
@@ -125,6 +154,10 @@ bool LinuxDisplay::SetDisplayMode(const DisplayModeDescriptor& displayModeDesc)
 
 DisplayModeDescriptor LinuxDisplay::GetDisplayMode() const
 {
+    UpdateCache();
+    if (hasCachedDisplayMode_)
+        return cachedDisplayMode_;
+
     DisplayModeDescriptor modeDesc;
     
     auto dpy = GetNative();
@@ -143,12 +176,19 @@ DisplayModeDescriptor LinuxDisplay::GetDisplayMode() const
             XRRFreeScreenConfigInfo(scrCfg);
         }
     }
+
+    cachedDisplayMode_      = modeDesc;
+    hasCachedDisplayMode_   = true;
     
     return modeDesc;
 }
 
 std::vector<DisplayModeDescriptor> LinuxDisplay::QuerySupportedDisplayModes() const
 {
+    UpdateCache();
+    if (hasCachedDisplayModes_)
+        return cachedDisplayModes_;
+
     std::vector<DisplayModeDescriptor> displayModeDescs;
     
     DisplayModeDescriptor modeDesc;
@@ -177,6 +217,9 @@ std::vector<DisplayModeDescriptor> LinuxDisplay::QuerySupportedDisplayModes() co
     /* Sort final display mode list and remove duplciate entries */
     FinalizeDisplayModes(displayModeDescs);
 
+    cachedDisplayModes_     = displayModeDescs;
+    hasCachedDisplayModes_  = true;
+
     return displayModeDescs;
 }
 
@@ -189,6 +232,18 @@ std::vector<DisplayModeDescriptor> LinuxDisplay::QuerySupportedDisplayModes() co
 {
     return sharedX11Display_->GetNative();
 }
+
+void LinuxDisplay::UpdateCache() const
+{
+    auto generation = sharedX11Display_->PollScreenChanges();
+    if (cacheGeneration_ != generation)
+    {
+        cacheGeneration_        = generation;
+        hasCachedDisplayMode_   = false;
+        hasCachedDisplayModes_  = false;
+        cachedDisplayModes_.clear();
+    }
+}
  
 
 } // /namespace LLGL
@@ -11,6 +11,8 @@
 
 #include <LLGL/Display.h>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include <X11/Xlib.h>
 
 
@@ -32,10 +34,18 @@ class LinuxSharedX11Display
         {
             return native_;
         }
+
+        /*
+        Returns the generation number of the screen configurations, which is incremented each time
+        the X server notifies this connection about a screen change (Xrandr's RRScreenChangeNotify event).
+        */
+        std::uint64_t PollScreenChanges();
         
     private:
     
-        ::Display* native_ = nullptr;
+        ::Display*      native_         = nullptr;
+        int             rrEventBase_    = -1;
+        std::uint64_t   generation_     = 1;
     
 };
 
@@ -62,9 +72,19 @@ class LinuxDisplay : public Display
 
         // Returns the native X11 display.
         ::Display* GetNative() const;
+
+        // Invalidates the cached display modes if the screen configuration has changed since they were queried.
+        void UpdateCache() const;
         
-        std::shared_ptr<LinuxSharedX11Display>  sharedX11Display_;
-        int                                     screen_             = 0;
+        std::shared_ptr<LinuxSharedX11Display>      sharedX11Display_;
+        int                                         screen_                 = 0;
+
+        /* Display modes are cached until the X server reports a screen change */
+        mutable std::uint64_t                       cacheGeneration_        = 0;
+        mutable bool                                hasCachedDisplayMode_   = false;
+        mutable DisplayModeDescriptor               cachedDisplayMode_;
+        mutable bool                                hasCachedDisplayModes_  = false;
+        mutable std::vector<DisplayModeDescriptor>  cachedDisplayModes_;
 
 };
 
@@ -53,6 +53,23 @@ std::uint64_t LinuxTimer::Stop()
     return 0;
 }
 
+std::uint64_t Timer::Tick()
+{
+    /* Prefer the raw monotonic clock, which is not affected by NTP frequency adjustments */
+    timespec t;
+    #ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t);
+    #else
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    #endif
+    return MonotonicTimeToUInt64(t);
+}
+
+std::uint64_t Timer::GetTickFrequency()
+{
+    return 1000000000ull;
+}
+
 std::uint64_t LinuxTimer::GetFrequency() const
 {
     return 1000000000ull;
@@ -136,48 +136,64 @@ void LinuxWindow::OnProcessEvents()
 {
     XEvent event;
 
-    XPending(display_);
-
-    while (XQLength(display_))
+    /*
+    Drain only the events that are queued at this point as one batch, so a flood of input events cannot stall the caller.
+    Motion and resize events are coalesced and posted once per batch, or before the next event whose order matters.
+    */
+    for (auto numEvents = XEventsQueued(display_, QueuedAfterFlush); numEvents > 0; --numEvents)
     {
         XNextEvent(display_, &event);
 
         switch (event.type)
         {
             case KeyPress:
+                PostPendingEvents();
                 ProcessKeyEvent(event.xkey, true);
                 break;
 
             case KeyRelease:
+                PostPendingEvents();
                 ProcessKeyEvent(event.xkey, false);
                 break;
 
             case ButtonPress:
+                PostPendingEvents();
                 ProcessMouseKeyEvent(event.xbutton, true);
                 break;
 
             case ButtonRelease:
+                PostPendingEvents();
                 ProcessMouseKeyEvent(event.xbutton, false);
                 break;
                 
             case Expose:
-                ProcessExposeEvent();
+                hasPendingResize_ = true;
                 break;
 
             case MotionNotify:
                 ProcessMotionEvent(event.xmotion);
                 break;
 
+            #ifdef LLGL_LINUX_ENABLE_XINPUT2
+            case GenericEvent:
+                ProcessGenericEvent(event.xcookie);
+                break;
+            #endif
+
             case DestroyNotify:
+                PostPendingEvents();
                 PostQuit();
                 break;
                 
             case ClientMessage:
+                PostPendingEvents();
                 ProcessClientMessage(event.xclient);
                 break;
         }
     }
 
+    PostPendingEvents();
+
     XFlush(display_);
 }
 
@@ -274,6 +290,11 @@ void LinuxWindow::OpenWindow()
     /* Enable WM_DELETE_WINDOW protocol */
     closeWndAtom_ = XInternAtom(display_, "WM_DELETE_WINDOW", False); 
     XSetWMProtocols(display_, wnd_, &closeWndAtom_, 1);
+
+    #ifdef LLGL_LINUX_ENABLE_XINPUT2
+    /* Receive unaccelerated mouse motion for global motion events */
+    EnableRawMotion();
+    #endif
 }
 
 void LinuxWindow::ProcessKeyEvent(XKeyEvent& event, bool down)
@@ -330,10 +351,9 @@ void LinuxWindow::ProcessClientMessage(XClientMessageEvent& event)
 
 void LinuxWindow::ProcessMotionEvent(XMotionEvent& event)
 {
-    const Offset2D mousePos { event.x, event.y };
-    PostLocalMotion(mousePos);
-    PostGlobalMotion({ mousePos.x - prevMousePos_.x, mousePos.y - prevMousePos_.y });
-    prevMousePos_ = mousePos;
+    /* Only keep the latest mouse position, the motion is posted once per batch */
+    pendingMousePos_    = { event.x, event.y };
+    hasPendingMotion_   = true;
 }
 
 void LinuxWindow::PostMouseKeyEvent(Key key, bool down)
@@ -344,6 +364,103 @@ void LinuxWindow::PostMouseKeyEvent(Key key, bool down)
         PostKeyUp(key);
 }
 
+void LinuxWindow::PostPendingEvents()
+{
+    if (hasPendingMotion_)
+    {
+        PostLocalMotion(pendingMousePos_);
+
+        #ifdef LLGL_LINUX_ENABLE_XINPUT2
+        /* Global motion is taken from raw motion events if available */
+        if (xiOpcode_ == -1)
+        #endif
+        PostGlobalMotion({ pendingMousePos_.x - prevMousePos_.x, pendingMousePos_.y - prevMousePos_.y });
+
+        prevMousePos_       = pendingMousePos_;
+        hasPendingMotion_   = false;
+    }
+
+    #ifdef LLGL_LINUX_ENABLE_XINPUT2
+
+    /* Post integral part of accumulated raw motion and keep the fractional part for the next batch */
+    const Offset2D rawMotion
+    {
+        static_cast<int>(pendingRawMotion_[0]),
+        static_cast<int>(pendingRawMotion_[1])
+    };
+
+    if (rawMotion.x != 0 || rawMotion.y != 0)
+    {
+        PostGlobalMotion(rawMotion);
+        pendingRawMotion_[0] -= static_cast<double>(rawMotion.x);
+        pendingRawMotion_[1] -= static_cast<double>(rawMotion.y);
+    }
+
+    #endif // /LLGL_LINUX_ENABLE_XINPUT2
+
+    if (hasPendingResize_)
+    {
+        ProcessExposeEvent();
+        hasPendingResize_ = false;
+    }
+}
+
+#ifdef LLGL_LINUX_ENABLE_XINPUT2
+
+void LinuxWindow::EnableRawMotion()
+{
+    /* Query XInput extension (version 2.0 is required for raw events) */
+    int firstEvent = 0, firstError = 0;
+    if (!XQueryExtension(display_, "XInputExtension", &xiOpcode_, &firstEvent, &firstError))
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    int major = 2, minor = 0;
+    if (XIQueryVersion(display_, &major, &minor) != Success)
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    /* Select unaccelerated motion events of all master devices (raw events are only reported on the root window) */
+    unsigned char mask[XIMaskLen(XI_RawMotion)] = {};
+    XISetMask(mask, XI_RawMotion);
+
+    XIEventMask eventMask;
+    {
+        eventMask.deviceid  = XIAllMasterDevices;
+        eventMask.mask_len  = sizeof(mask);
+        eventMask.mask      = mask;
+    }
+    XISelectEvents(display_, DefaultRootWindow(display_), &eventMask, 1);
+}
+
+void LinuxWindow::ProcessGenericEvent(XGenericEventCookie& cookie)
+{
+    if (cookie.extension == xiOpcode_ && XGetEventData(display_, &cookie))
+    {
+        if (cookie.evtype == XI_RawMotion)
+            ProcessRawMotionEvent(*reinterpret_cast<const XIRawEvent*>(cookie.data));
+        XFreeEventData(display_, &cookie);
+    }
+}
+
+void LinuxWindow::ProcessRawMotionEvent(const XIRawEvent& event)
+{
+    /* Accumulate raw values of the X and Y valuators (values are only stored for valuators whose mask bit is set) */
+    const double* value = event.raw_values;
+
+    for (int i = 0; i < 2 && i < event.valuators.mask_len * 8; ++i)
+    {
+        if (XIMaskIsSet(event.valuators.mask, i))
+            pendingRawMotion_[i] += *(value++);
+    }
+}
+
+#endif // /LLGL_LINUX_ENABLE_XINPUT2
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,10 @@
 #include <LLGL/Window.h>
 #include <X11/Xlib.h>
 
+#ifdef LLGL_LINUX_ENABLE_XINPUT2
+#   include <X11/extensions/XInput2.h>
+#endif
+
 
 namespace LLGL
 {
@@ -59,6 +63,13 @@ class LinuxWindow : public Window
         void ProcessMotionEvent(XMotionEvent& event);
 
         void PostMouseKeyEvent(Key key, bool down);
+        void PostPendingEvents();
+
+        #ifdef LLGL_LINUX_ENABLE_XINPUT2
+        void EnableRawMotion();
+        void ProcessGenericEvent(XGenericEventCookie& cookie);
+        void ProcessRawMotionEvent(const XIRawEvent& event);
+        #endif
         
         WindowDescriptor    desc_;
 
@@ -72,6 +83,16 @@ class LinuxWindow : public Window
         
         Offset2D            prevMousePos_;
 
+        /* Events that are coalesced while the event queue is drained (see PostPendingEvents) */
+        Offset2D            pendingMousePos_;
+        bool                hasPendingMotion_   = false;
+        bool                hasPendingResize_   = false;
+
+        #ifdef LLGL_LINUX_ENABLE_XINPUT2
+        int                 xiOpcode_           = -1;       // Major opcode of the XInput extension, or -1 if raw motion is not available
+        double              pendingRawMotion_[2] = { 0.0, 0.0 };
+        #endif
+
 };
 
 
@@ -0,0 +1,53 @@
+/*
+ * MappedFile.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MAPPED_FILE_H
+#define LLGL_MAPPED_FILE_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+//! Read-only memory mapped file (to access large files without copying them into memory)
+class MappedFile : public NonCopyable
+{
+
+    public:
+
+        //! Maps the entire specified file into read-only memory. Throws std::runtime_error on failure.
+        static std::unique_ptr<MappedFile> Open(const std::string& filename);
+
+        //! Returns a pointer to the mapped file content.
+        virtual const void* GetData() const = 0;
+
+        //! Returns the size (in bytes) of the mapped file.
+        virtual std::size_t GetSize() const = 0;
+
+        //! Hints the operating system to read the specified range of the file ahead of time, so the pages are resident when they are accessed.
+        virtual void Prefetch(std::size_t offset, std::size_t size) const = 0;
+
+        //! Hints the operating system that the specified range of the file is no longer needed, so its pages can be released from physical memory.
+        virtual void Discard(std::size_t offset, std::size_t size) const = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include "../../Core/Helper.h"
 #include <locale>
 #include <codecvt>
+#include <atomic>
 
 
 namespace LLGL
@@ -22,6 +23,9 @@ namespace LLGL
 // Thread local reference to the output list of the Display::QueryList function
 thread_local static std::vector<std::unique_ptr<Display>>* g_displayListRef;
 
+// Generation number of the display settings, which is incremented each time the display settings change
+static std::atomic<std::uint64_t> g_displaySettingsGeneration { 1 };
+
 static void Convert(DisplayModeDescriptor& dst, const DEVMODE& src)
 {
     dst.resolution.width    = static_cast<std::uint32_t>(src.dmPelsWidth);
@@ -59,6 +63,12 @@ static bool IsCursorVisible(bool& visible)
 }
 
 
+void Win32InvalidateDisplayModes()
+{
+    ++g_displaySettingsGeneration;
+}
+
+
 /*
  * Display class
  */
@@ -157,6 +167,7 @@ bool Win32Display::ResetDisplayMode()
 
     /* Change settings for this display to default l*/
     auto result = ChangeDisplaySettingsEx(infoEx.szDevice, nullptr, nullptr, 0, nullptr);
+    Win32InvalidateDisplayModes();
 
     return (result == DISP_CHANGE_SUCCESSFUL);
 }
@@ -175,12 +186,17 @@ bool Win32Display::SetDisplayMode(const DisplayModeDescriptor& displayModeDesc)
         Convert(devMode, displayModeDesc);
     }
     auto result = ChangeDisplaySettingsEx(infoEx.szDevice, &devMode, nullptr, CDS_FULLSCREEN, nullptr);
+    Win32InvalidateDisplayModes();
 
     return (result == DISP_CHANGE_SUCCESSFUL);
 }
 
 DisplayModeDescriptor Win32Display::GetDisplayMode() const
 {
+    UpdateCache();
+    if (hasCachedDisplayMode_)
+        return cachedDisplayMode_;
+
     /* Get display device name */
     MONITORINFOEX infoEx;
     GetInfo(infoEx);
@@ -191,9 +207,9 @@ DisplayModeDescriptor Win32Display::GetDisplayMode() const
 
     if (EnumDisplaySettings(infoEx.szDevice, ENUM_CURRENT_SETTINGS, &devMode) != FALSE)
     {
-        DisplayModeDescriptor displayModeDesc;
-        Convert(displayModeDesc, devMode);
-        return displayModeDesc;
+        Convert(cachedDisplayMode_, devMode);
+        hasCachedDisplayMode_ = true;
+        return cachedDisplayMode_;
     }
 
     return {};
@@ -201,6 +217,10 @@ DisplayModeDescriptor Win32Display::GetDisplayMode() const
 
 std::vector<DisplayModeDescriptor> Win32Display::QuerySupportedDisplayModes() const
 {
+    UpdateCache();
+    if (hasCachedDisplayModes_)
+        return cachedDisplayModes_;
+
     std::vector<DisplayModeDescriptor> displayModeDescs;
 
     /* Get display device name */
@@ -227,6 +247,9 @@ std::vector<DisplayModeDescriptor> Win32Display::QuerySupportedDisplayModes() co
     /* Sort final display mode list and remove duplciate entries */
     FinalizeDisplayModes(displayModeDescs);
 
+    cachedDisplayModes_     = displayModeDescs;
+    hasCachedDisplayModes_  = true;
+
     return displayModeDescs;
 }
 
@@ -247,6 +270,18 @@ void Win32Display::GetInfo(MONITORINFOEX& info) const
     GetMonitorInfo(monitor_, &info);
 }
 
+void Win32Display::UpdateCache() const
+{
+    auto generation = g_displaySettingsGeneration.load();
+    if (cacheGeneration_ != generation)
+    {
+        cacheGeneration_        = generation;
+        hasCachedDisplayMode_   = false;
+        hasCachedDisplayModes_  = false;
+        cachedDisplayModes_.clear();
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -12,12 +12,18 @@
 #include <LLGL/Display.h>
 #include "Win32LeanAndMean.h"
 #include <Windows.h>
+#include <vector>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+// Invalidates the cached display modes of all Win32 displays, e.g. when WM_DISPLAYCHANGE has been received.
+void Win32InvalidateDisplayModes();
+
+
 class Win32Display : public Display
 {
 
@@ -42,7 +48,17 @@ class Win32Display : public Display
         void GetInfo(MONITORINFO& info) const;
         void GetInfo(MONITORINFOEX& info) const;
 
-        HMONITOR monitor_ = nullptr;
+        // Invalidates the cached display modes if the display settings have changed since they were queried.
+        void UpdateCache() const;
+
+        HMONITOR                                    monitor_                = nullptr;
+
+        /* Display modes are cached until the display settings change */
+        mutable std::uint64_t                       cacheGeneration_        = 0;
+        mutable bool                                hasCachedDisplayMode_   = false;
+        mutable DisplayModeDescriptor               cachedDisplayMode_;
+        mutable bool                                hasCachedDisplayModes_  = false;
+        mutable std::vector<DisplayModeDescriptor>  cachedDisplayModes_;
 
 };
 
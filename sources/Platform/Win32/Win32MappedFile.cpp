@@ -0,0 +1,109 @@
+/*
+ * Win32MappedFile.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Win32MappedFile.h"
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& filename)
+{
+    return std::unique_ptr<MappedFile>(new Win32MappedFile(filename));
+}
+
+Win32MappedFile::Win32MappedFile(const std::string& filename)
+{
+    /* Open file for read access */
+    file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("failed to open file: \"" + filename + "\"");
+
+    /* Query file size */
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        Close();
+        throw std::runtime_error("failed to determine size of file: \"" + filename + "\"");
+    }
+
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+
+    /* Map entire file into read-only memory */
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr)
+        data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+
+    if (data_ == nullptr)
+    {
+        Close();
+        throw std::runtime_error("failed to map file into memory: \"" + filename + "\"");
+    }
+}
+
+Win32MappedFile::~Win32MappedFile()
+{
+    Close();
+}
+
+const void* Win32MappedFile::GetData() const
+{
+    return data_;
+}
+
+std::size_t Win32MappedFile::GetSize() const
+{
+    return size_;
+}
+
+void Win32MappedFile::Prefetch(std::size_t offset, std::size_t size) const
+{
+    #if defined _WIN32_WINNT && _WIN32_WINNT >= 0x0602
+    if (offset < size_ && size > 0)
+    {
+        /* Read range asynchronously into physical memory (since Windows 8) */
+        WIN32_MEMORY_RANGE_ENTRY range;
+        {
+            range.VirtualAddress    = reinterpret_cast<char*>(data_) + offset;
+            range.NumberOfBytes     = std::min(size, size_ - offset);
+        }
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    #endif
+}
+
+void Win32MappedFile::Discard(std::size_t offset, std::size_t size) const
+{
+    /* Unlocking pages that are not locked removes them from the working set of the process */
+    if (offset < size_ && size > 0)
+        VirtualUnlock(reinterpret_cast<char*>(data_) + offset, std::min(size, size_ - offset));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void Win32MappedFile::Close()
+{
+    if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+    if (mapping_ != nullptr)
+        CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,54 @@
+/*
+ * Win32MappedFile.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WIN32_MAPPED_FILE_H
+#define LLGL_WIN32_MAPPED_FILE_H
+
+
+#include "../MappedFile.h"
+
+#include <Windows.h>
+
+
+namespace LLGL
+{
+
+
+class Win32MappedFile : public MappedFile
+{
+
+    public:
+
+        Win32MappedFile(const std::string& filename);
+        ~Win32MappedFile();
+
+        const void* GetData() const override;
+        std::size_t GetSize() const override;
+
+        void Prefetch(std::size_t offset, std::size_t size) const override;
+        void Discard(std::size_t offset, std::size_t size) const override;
+
+    private:
+
+        void Close();
+
+        HANDLE      file_       = INVALID_HANDLE_VALUE;
+        HANDLE      mapping_    = nullptr;
+        LPVOID      data_       = nullptr;
+        std::size_t size_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
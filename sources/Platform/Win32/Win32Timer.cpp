@@ -81,6 +81,25 @@ std::uint64_t Win32Timer::Stop()
     return static_cast<std::uint64_t>(elapsedTime);
 }
 
+std::uint64_t Timer::Tick()
+{
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return static_cast<std::uint64_t>(t.QuadPart);
+}
+
+std::uint64_t Timer::GetTickFrequency()
+{
+    /* Performance counter frequency is fixed at system boot, so it is only queried once */
+    static const std::uint64_t frequency = []()
+    {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return static_cast<std::uint64_t>(f.QuadPart);
+    }();
+    return frequency;
+}
+
 std::uint64_t Win32Timer::GetFrequency() const
 {
     return static_cast<std::uint64_t>(clockFrequency_.QuadPart);
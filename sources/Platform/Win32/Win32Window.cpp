@@ -7,9 +7,11 @@
 
 #include "Win32Window.h"
 #include "Win32WindowClass.h"
+#include "Win32WindowCallback.h"
 #include "../../Core/Helper.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Platform/Platform.h>
+#include <climits>
 
 
 namespace LLGL
@@ -334,10 +336,14 @@ void Win32Window::SetDesc(const WindowDescriptor& desc)
 
 void Win32Window::OnProcessEvents()
 {
-    /* Peek all queued messages */
+    /* Read all buffered raw input at once instead of dispatching each WM_INPUT message */
+    Win32PostBufferedRawInput();
+
+    /* Peek all other queued messages; WM_INPUT messages arriving in the meantime are left for the next raw input buffer read */
     MSG message;
 
-    while (PeekMessage(&message, nullptr, 0, 0, PM_REMOVE))
+    while (PeekMessage(&message, nullptr, 0, WM_INPUT - 1, PM_REMOVE) ||
+           PeekMessage(&message, nullptr, WM_INPUT + 1, UINT_MAX, PM_REMOVE))
     {
         TranslateMessage(&message);
         DispatchMessage(&message);
@@ -7,6 +7,7 @@
 
 #include "Win32WindowCallback.h"
 #include "Win32Window.h"
+#include "Win32Display.h"
 #include "MapKey.h"
 
 #include <windowsx.h>
@@ -174,6 +175,88 @@ static void PostGlobalMouseMotion(HWND wnd, LPARAM lParam)
     }
 }
 
+#ifndef _WIN64
+
+// Returns true if this 32-bit process runs on a 64-bit system.
+static bool IsRunningUnderWow64()
+{
+    static const bool isWow64 = []() -> bool
+    {
+        BOOL wow64 = FALSE;
+        return (::IsWow64Process(GetCurrentProcess(), &wow64) != FALSE && wow64 != FALSE);
+    }();
+    return isWow64;
+}
+
+#endif
+
+// Returns the mouse data of the specified raw input that has been read with GetRawInputBuffer.
+static const RAWMOUSE& GetBufferedRawMouse(const RAWINPUT& raw)
+{
+    #ifndef _WIN64
+    /* GetRawInputBuffer returns the 64-bit layout under WOW64, where the header is 8 bytes larger */
+    if (IsRunningUnderWow64())
+        return *reinterpret_cast<const RAWMOUSE*>(reinterpret_cast<const BYTE*>(&raw.data.mouse) + 8);
+    #endif
+    return raw.data.mouse;
+}
+
+// Returns the window the raw mouse input device has been registered for, i.e. the most recently created window.
+static Win32Window* GetRawMouseInputWindow()
+{
+    RAWINPUTDEVICE devices[8];
+    UINT numDevices = sizeof(devices)/sizeof(devices[0]);
+    UINT result = GetRegisteredRawInputDevices(devices, &numDevices, sizeof(RAWINPUTDEVICE));
+
+    if (result != static_cast<UINT>(-1))
+    {
+        for (UINT i = 0; i < result; ++i)
+        {
+            if (devices[i].usUsagePage == HID_USAGE_PAGE_GENERIC && devices[i].usUsage == HID_USAGE_GENERIC_MOUSE)
+                return GetWindowFromUserData(devices[i].hwndTarget);
+        }
+    }
+
+    return nullptr;
+}
+
+void Win32PostBufferedRawInput()
+{
+    /* Read raw input in batches, so the cost per frame does not grow with the polling rate of the input devices */
+    RAWINPUT rawInputs[64];
+    LONG dx = 0, dy = 0;
+
+    for (;;)
+    {
+        UINT size = sizeof(rawInputs);
+        UINT count = GetRawInputBuffer(rawInputs, &size, sizeof(RAWINPUTHEADER));
+        if (count == 0 || count == static_cast<UINT>(-1))
+            break;
+
+        /* Accumulate relative mouse motion (NEXTRAWINPUTBLOCK takes care of the alignment of each entry) */
+        PRAWINPUT raw = rawInputs;
+        for (UINT i = 0; i < count; ++i, raw = NEXTRAWINPUTBLOCK(raw))
+        {
+            if (raw->header.dwType == RIM_TYPEMOUSE)
+            {
+                const auto& mouse = GetBufferedRawMouse(*raw);
+                if (mouse.usFlags == MOUSE_MOVE_RELATIVE)
+                {
+                    dx += mouse.lLastX;
+                    dy += mouse.lLastY;
+                }
+            }
+        }
+    }
+
+    /* Post coalesced global mouse motion event */
+    if (dx != 0 || dy != 0)
+    {
+        if (auto window = GetRawMouseInputWindow())
+            window->PostGlobalMotion({ static_cast<int>(dx), static_cast<int>(dy) });
+    }
+}
+
 
 /* --- Window callback function --- */
 
@@ -209,6 +292,13 @@ LRESULT CALLBACK Win32WindowCallback(HWND wnd, UINT msg, WPARAM wParam, LPARAM l
         }
         break;
 
+        case WM_DISPLAYCHANGE:
+        {
+            /* Display settings have changed, so all cached display modes are out of date */
+            Win32InvalidateDisplayModes();
+        }
+        break;
+
         case WM_CLOSE:
         {
             /* Post close event to window */
@@ -18,6 +18,9 @@ namespace LLGL
 
 LRESULT CALLBACK Win32WindowCallback(HWND wnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+// Reads all buffered raw input of the calling thread in batches and posts the accumulated mouse motion as a single event.
+void Win32PostBufferedRawInput();
+
 
 } // /namespace LLGL
 
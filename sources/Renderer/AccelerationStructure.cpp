@@ -0,0 +1,31 @@
+/*
+ * AccelerationStructure.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/AccelerationStructure.h>
+
+
+namespace LLGL
+{
+
+
+AccelerationStructure::AccelerationStructure(const AccelerationStructureType type, long flags) :
+    type_  { type  },
+    flags_ { flags }
+{
+}
+
+ResourceType AccelerationStructure::QueryResourceType() const
+{
+    return ResourceType::AccelerationStructure;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -13,7 +13,8 @@ namespace LLGL
 
 
 BasicPipelineLayout::BasicPipelineLayout(const PipelineLayoutDescriptor& desc) :
-    bindings_ { desc.bindings }
+    bindings_  { desc.bindings  },
+    constants_ { desc.constants }
 {
 }
 
@@ -18,7 +18,7 @@ namespace LLGL
 {
 
 
-// This class only holds a copy of the binding descriptor list.
+// This class only holds a copy of the binding descriptor list and the constants layout.
 class LLGL_EXPORT BasicPipelineLayout : public PipelineLayout
 {
 
@@ -32,9 +32,16 @@ class LLGL_EXPORT BasicPipelineLayout : public PipelineLayout
             return bindings_;
         }
 
+        // Returns the layout of the constants.
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
     private:
 
-        std::vector<BindingDescriptor> bindings_;
+        std::vector<BindingDescriptor>  bindings_;
+        ConstantsDescriptor             constants_;
 
 };
 
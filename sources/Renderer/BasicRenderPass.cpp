@@ -0,0 +1,25 @@
+/*
+ * BasicRenderPass.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BasicRenderPass.h"
+
+
+namespace LLGL
+{
+
+
+BasicRenderPass::BasicRenderPass(const RenderPassDescriptor& desc) :
+    RenderPass { desc }
+{
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
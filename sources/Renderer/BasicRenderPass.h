@@ -0,0 +1,37 @@
+/*
+ * BasicRenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BASIC_RENDER_PASS_H
+#define LLGL_BASIC_RENDER_PASS_H
+
+
+#include <LLGL/RenderPass.h>
+
+
+namespace LLGL
+{
+
+
+// This class only holds the copy of the render pass descriptor of its base class.
+class LLGL_EXPORT BasicRenderPass : public RenderPass
+{
+
+    public:
+
+        BasicRenderPass(const RenderPassDescriptor& desc);
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -30,6 +30,11 @@ ResourceType Buffer::QueryResourceType() const
     return ResourceType::Undefined;
 }
 
+std::uint64_t Buffer::GetDeviceAddress() const
+{
+    return 0;
+}
+
 
 } // /namespace LLGL
 
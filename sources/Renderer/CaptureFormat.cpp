@@ -0,0 +1,658 @@
+/*
+ * CaptureFormat.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CaptureFormat.h"
+#include "../Core/Helper.h"
+#include <LLGL/Resource.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderProgram.h>
+#include <LLGL/PipelineLayout.h>
+#include <LLGL/RenderTarget.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/*
+ * CaptureEncoder class
+ */
+
+void CaptureEncoder::AddObject(const RenderSystemChild* obj)
+{
+    const auto id = ++nextID_;
+    ids_[obj] = id;
+    Value(id);
+}
+
+void CaptureEncoder::RemoveObject(const RenderSystemChild* obj)
+{
+    auto it = ids_.find(obj);
+    if (it != ids_.end())
+    {
+        Value(it->second);
+        ids_.erase(it);
+    }
+    else
+        Value(std::uint32_t(0));
+}
+
+void CaptureEncoder::Object(const RenderSystemChild* obj)
+{
+    auto it = ids_.find(obj);
+    Value(it != ids_.end() ? it->second : std::uint32_t(0));
+}
+
+bool CaptureEncoder::HasObject(const RenderSystemChild* obj) const
+{
+    return (ids_.find(obj) != ids_.end());
+}
+
+void CaptureEncoder::Opcode(const CaptureOpcode opcode)
+{
+    data_.push_back(static_cast<char>(opcode));
+}
+
+void CaptureEncoder::Bool(bool value)
+{
+    data_.push_back(value ? 1 : 0);
+}
+
+void CaptureEncoder::Data(const void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<const char*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void CaptureEncoder::Blob(const void* data, std::size_t size)
+{
+    Value(static_cast<std::uint64_t>(data != nullptr ? size : 0));
+    if (data != nullptr)
+        Data(data, size);
+}
+
+void CaptureEncoder::String(const char* s)
+{
+    if (s != nullptr)
+    {
+        /* Encode length including the null terminator, so zero denotes a null pointer */
+        const auto len = static_cast<std::uint32_t>(std::strlen(s) + 1);
+        Value(len);
+        Data(s, len);
+    }
+    else
+        Value(std::uint32_t(0));
+}
+
+void CaptureEncoder::Descriptor(const RenderContextDescriptor& desc)
+{
+    Value(desc.vsync);
+    Value(desc.multiSampling);
+    Value(desc.videoMode);
+    Value(desc.profileOpenGL);
+    Value(desc.framesInFlight);
+    Value(desc.maxFrameLatency);
+    Bool(desc.threadedPresent);
+}
+
+void CaptureEncoder::Descriptor(const CommandBufferDescriptor& desc)
+{
+    Value(desc.flags);
+    Enum(desc.queueType);
+}
+
+void CaptureEncoder::Descriptor(const BufferDescriptor& desc)
+{
+    Enum(desc.type);
+    Value(desc.size);
+    Value(desc.flags);
+    EncodeVertexFormat(desc.vertexBuffer.format);
+    Enum(desc.indexBuffer.format.GetDataType());
+    Enum(desc.storageBuffer.storageType);
+    Enum(desc.storageBuffer.format);
+    Value(desc.storageBuffer.stride);
+}
+
+void CaptureEncoder::Descriptor(const TextureDescriptor& desc)
+{
+    Value(desc);
+}
+
+void CaptureEncoder::Descriptor(const TextureViewDescriptor& desc)
+{
+    Value(desc);
+}
+
+void CaptureEncoder::Descriptor(const SrcImageDescriptor* desc)
+{
+    Bool(desc != nullptr);
+    if (desc != nullptr)
+    {
+        Enum(desc->format);
+        Enum(desc->dataType);
+        Blob(desc->data, desc->dataSize);
+        Value(desc->mipLevels);
+    }
+}
+
+void CaptureEncoder::Descriptor(const SamplerDescriptor& desc)
+{
+    Value(desc);
+}
+
+void CaptureEncoder::Descriptor(const ResourceViewDescriptor& desc)
+{
+    Object(desc.resource);
+}
+
+void CaptureEncoder::Descriptor(const ResourceHeapDescriptor& desc)
+{
+    Object(desc.pipelineLayout);
+    Value(static_cast<std::uint32_t>(desc.resourceViews.size()));
+    for (const auto& resourceView : desc.resourceViews)
+        Descriptor(resourceView);
+}
+
+void CaptureEncoder::Descriptor(const RenderTargetDescriptor& desc)
+{
+    Value(desc.resolution);
+    Value(desc.multiSampling);
+    Bool(desc.customMultiSampling);
+    Value(desc.numViews);
+    Value(static_cast<std::uint32_t>(desc.attachments.size()));
+    for (const auto& attachment : desc.attachments)
+    {
+        Enum(attachment.type);
+        Object(attachment.texture);
+        Value(attachment.mipLevel);
+        Value(attachment.arrayLayer);
+    }
+}
+
+void CaptureEncoder::Descriptor(const RenderPassDescriptor& desc)
+{
+    Array(desc.colorAttachments.data(), static_cast<std::uint32_t>(desc.colorAttachments.size()));
+    Value(desc.depthAttachment);
+    Value(desc.stencilAttachment);
+}
+
+void CaptureEncoder::Descriptor(const ShaderDescriptor& desc)
+{
+    Enum(desc.type);
+
+    /* Embed the content of shader files, so the trace does not depend on the working directory */
+    switch (desc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+            Enum(ShaderSourceType::CodeString);
+            String(desc.source);
+            break;
+        case ShaderSourceType::CodeFile:
+            Enum(ShaderSourceType::CodeString);
+            String(ReadFileString(desc.source).c_str());
+            break;
+        case ShaderSourceType::BinaryBuffer:
+            Enum(ShaderSourceType::BinaryBuffer);
+            Blob(desc.source, desc.sourceSize);
+            break;
+        case ShaderSourceType::BinaryFile:
+        {
+            auto buffer = ReadFileBuffer(desc.source);
+            Enum(ShaderSourceType::BinaryBuffer);
+            Blob(buffer.data(), buffer.size());
+        }
+        break;
+    }
+
+    String(desc.entryPoint);
+    String(desc.profile);
+    Value(desc.flags);
+
+    Value(static_cast<std::uint32_t>(desc.streamOutput.format.attributes.size()));
+    for (const auto& attrib : desc.streamOutput.format.attributes)
+    {
+        String(attrib.name.c_str());
+        Value(attrib.stream);
+        Value(attrib.startComponent);
+        Value(attrib.components);
+        Value(attrib.semanticIndex);
+        Value(attrib.outputSlot);
+    }
+    Value(desc.streamOutput.rasterizedStream);
+
+    Value(static_cast<std::uint32_t>(desc.specializationConstants.size()));
+    for (const auto& constant : desc.specializationConstants)
+    {
+        Value(constant.id);
+        String(constant.name);
+        Enum(constant.type);
+        Value(constant.value);
+    }
+}
+
+void CaptureEncoder::Descriptor(const ShaderProgramDescriptor& desc)
+{
+    Value(static_cast<std::uint32_t>(desc.vertexFormats.size()));
+    for (const auto& vertexFormat : desc.vertexFormats)
+        EncodeVertexFormat(vertexFormat);
+
+    Object(desc.vertexShader);
+    Object(desc.tessControlShader);
+    Object(desc.tessEvaluationShader);
+    Object(desc.geometryShader);
+    Object(desc.fragmentShader);
+    Object(desc.computeShader);
+    Object(desc.amplificationShader);
+    Object(desc.meshShader);
+}
+
+void CaptureEncoder::Descriptor(const PipelineLayoutDescriptor& desc)
+{
+    Array(desc.bindings.data(), static_cast<std::uint32_t>(desc.bindings.size()));
+    Value(desc.constants);
+    Array(desc.staticSamplers.data(), static_cast<std::uint32_t>(desc.staticSamplers.size()));
+}
+
+void CaptureEncoder::Descriptor(const GraphicsPipelineDescriptor& desc)
+{
+    Object(desc.shaderProgram);
+    Object(desc.pipelineLayout);
+    Object(desc.renderTarget);
+    Enum(desc.primitiveTopology);
+    Array(desc.viewports.data(), static_cast<std::uint32_t>(desc.viewports.size()));
+    Array(desc.scissors.data(), static_cast<std::uint32_t>(desc.scissors.size()));
+    Value(desc.depth);
+    Value(desc.stencil);
+    Value(desc.rasterizer);
+    Bool(desc.blend.blendEnabled);
+    Value(desc.blend.blendFactor);
+    Bool(desc.blend.alphaToCoverageEnabled);
+    Enum(desc.blend.logicOp);
+    Array(desc.blend.targets.data(), static_cast<std::uint32_t>(desc.blend.targets.size()));
+    Value(desc.dynamicStates);
+    Value(desc.viewMask);
+}
+
+void CaptureEncoder::Descriptor(const ComputePipelineDescriptor& desc)
+{
+    Object(desc.shaderProgram);
+    Object(desc.pipelineLayout);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void CaptureEncoder::EncodeVertexFormat(const VertexFormat& format)
+{
+    Value(static_cast<std::uint32_t>(format.attributes.size()));
+    for (const auto& attrib : format.attributes)
+    {
+        String(attrib.name.c_str());
+        Enum(attrib.format);
+        Value(attrib.instanceDivisor);
+        Value(attrib.offset);
+        Value(attrib.semanticIndex);
+    }
+    Value(format.stride);
+    Value(format.inputSlot);
+}
+
+
+/*
+ * CaptureDecoder class
+ */
+
+CaptureDecoder::CaptureDecoder(const char* data, std::size_t size) :
+    data_ { data },
+    size_ { size }
+{
+}
+
+void CaptureDecoder::AddObject(RenderSystemChild* obj, const CaptureObjectType type)
+{
+    const auto id = Value<std::uint32_t>();
+    if (id == 0)
+        ThrowCorrupted();
+
+    if (id >= objects_.size())
+        objects_.resize(id + 1);
+
+    objects_[id].obj    = obj;
+    objects_[id].type   = type;
+}
+
+RenderSystemChild* CaptureDecoder::Object(CaptureObjectType* type)
+{
+    const auto id = Value<std::uint32_t>();
+    if (id == 0)
+    {
+        if (type != nullptr)
+            *type = CaptureObjectType::Undefined;
+        return nullptr;
+    }
+
+    /* References to unknown or released objects can only result from a corrupted trace */
+    if (id >= objects_.size() || objects_[id].obj == nullptr)
+        ThrowCorrupted();
+
+    if (type != nullptr)
+        *type = objects_[id].type;
+
+    return objects_[id].obj;
+}
+
+RenderSystemChild* CaptureDecoder::RemoveObject(CaptureObjectType& type)
+{
+    const auto id = Value<std::uint32_t>();
+    if (id == 0 || id >= objects_.size())
+    {
+        /* Objects that have been created before the capture started are not part of the trace */
+        type = CaptureObjectType::Undefined;
+        return nullptr;
+    }
+
+    auto obj = objects_[id].obj;
+    type = objects_[id].type;
+    objects_[id] = ObjectEntry{};
+
+    return obj;
+}
+
+bool CaptureDecoder::Opcode(CaptureOpcode& opcode)
+{
+    if (pos_ < size_)
+    {
+        opcode = static_cast<CaptureOpcode>(data_[pos_++]);
+        return true;
+    }
+    return false;
+}
+
+void CaptureDecoder::Bool(bool& value)
+{
+    value = (*reinterpret_cast<const char*>(Data(1)) != 0);
+}
+
+const void* CaptureDecoder::Data(std::size_t size)
+{
+    if (size > size_ - pos_)
+        ThrowCorrupted();
+    auto data = data_ + pos_;
+    pos_ += size;
+    return data;
+}
+
+const void* CaptureDecoder::Blob(std::size_t& size)
+{
+    const auto blobSize = Value<std::uint64_t>();
+    if (blobSize > size_ - pos_)
+        ThrowCorrupted();
+    size = static_cast<std::size_t>(blobSize);
+    return (size > 0 ? Data(size) : nullptr);
+}
+
+const char* CaptureDecoder::String()
+{
+    const auto len = Value<std::uint32_t>();
+    if (len > 0)
+    {
+        auto s = reinterpret_cast<const char*>(Data(len));
+        if (s[len - 1] != '\0')
+            ThrowCorrupted();
+        return s;
+    }
+    return nullptr;
+}
+
+void CaptureDecoder::Descriptor(RenderContextDescriptor& desc)
+{
+    Value(desc.vsync);
+    Value(desc.multiSampling);
+    Value(desc.videoMode);
+    Value(desc.profileOpenGL);
+    Value(desc.framesInFlight);
+    Value(desc.maxFrameLatency);
+    Bool(desc.threadedPresent);
+}
+
+void CaptureDecoder::Descriptor(CommandBufferDescriptor& desc)
+{
+    Value(desc.flags);
+    Enum(desc.queueType);
+}
+
+void CaptureDecoder::Descriptor(BufferDescriptor& desc)
+{
+    Enum(desc.type);
+    Value(desc.size);
+    Value(desc.flags);
+    DecodeVertexFormat(desc.vertexBuffer.format);
+
+    DataType indexType = DataType::UInt32;
+    Enum(indexType);
+    desc.indexBuffer.format = IndexFormat { indexType };
+
+    Enum(desc.storageBuffer.storageType);
+    Enum(desc.storageBuffer.format);
+    Value(desc.storageBuffer.stride);
+}
+
+void CaptureDecoder::Descriptor(TextureDescriptor& desc)
+{
+    Value(desc);
+}
+
+void CaptureDecoder::Descriptor(TextureViewDescriptor& desc)
+{
+    Value(desc);
+}
+
+bool CaptureDecoder::Descriptor(SrcImageDescriptor& desc)
+{
+    bool hasImage = false;
+    Bool(hasImage);
+    if (hasImage)
+    {
+        Enum(desc.format);
+        Enum(desc.dataType);
+        desc.data = Blob(desc.dataSize);
+        Value(desc.mipLevels);
+    }
+    return hasImage;
+}
+
+void CaptureDecoder::Descriptor(SamplerDescriptor& desc)
+{
+    Value(desc);
+}
+
+void CaptureDecoder::Descriptor(ResourceViewDescriptor& desc)
+{
+    CaptureObjectType type = CaptureObjectType::Undefined;
+    auto obj = Object(&type);
+    switch (type)
+    {
+        case CaptureObjectType::Buffer:
+        case CaptureObjectType::Texture:
+        case CaptureObjectType::Sampler:
+            desc.resource = static_cast<Resource*>(obj);
+            break;
+        default:
+            ThrowCorrupted();
+    }
+}
+
+void CaptureDecoder::Descriptor(ResourceHeapDescriptor& desc)
+{
+    desc.pipelineLayout = ObjectOf<PipelineLayout>(CaptureObjectType::PipelineLayout);
+    desc.resourceViews.resize(Value<std::uint32_t>());
+    for (auto& resourceView : desc.resourceViews)
+        Descriptor(resourceView);
+}
+
+void CaptureDecoder::Descriptor(RenderTargetDescriptor& desc)
+{
+    Value(desc.resolution);
+    Value(desc.multiSampling);
+    Bool(desc.customMultiSampling);
+    Value(desc.numViews);
+    desc.attachments.resize(Value<std::uint32_t>());
+    for (auto& attachment : desc.attachments)
+    {
+        Enum(attachment.type);
+        attachment.texture = ObjectOf<Texture>(CaptureObjectType::Texture);
+        Value(attachment.mipLevel);
+        Value(attachment.arrayLayer);
+    }
+}
+
+void CaptureDecoder::Descriptor(RenderPassDescriptor& desc)
+{
+    Array(desc.colorAttachments);
+    Value(desc.depthAttachment);
+    Value(desc.stencilAttachment);
+}
+
+void CaptureDecoder::Descriptor(ShaderDescriptor& desc)
+{
+    Enum(desc.type);
+    Enum(desc.sourceType);
+
+    if (desc.sourceType == ShaderSourceType::BinaryBuffer)
+        desc.source = reinterpret_cast<const char*>(Blob(desc.sourceSize));
+    else
+    {
+        desc.source     = String();
+        desc.sourceSize = (desc.source != nullptr ? std::strlen(desc.source) : 0);
+    }
+
+    desc.entryPoint = String();
+    desc.profile    = String();
+    Value(desc.flags);
+
+    desc.streamOutput.format.attributes.resize(Value<std::uint32_t>());
+    for (auto& attrib : desc.streamOutput.format.attributes)
+    {
+        if (auto name = String())
+            attrib.name = name;
+        Value(attrib.stream);
+        Value(attrib.startComponent);
+        Value(attrib.components);
+        Value(attrib.semanticIndex);
+        Value(attrib.outputSlot);
+    }
+    Value(desc.streamOutput.rasterizedStream);
+
+    desc.specializationConstants.resize(Value<std::uint32_t>());
+    for (auto& constant : desc.specializationConstants)
+    {
+        Value(constant.id);
+        constant.name = String();
+        Enum(constant.type);
+        Value(constant.value);
+    }
+}
+
+void CaptureDecoder::Descriptor(ShaderProgramDescriptor& desc)
+{
+    desc.vertexFormats.resize(Value<std::uint32_t>());
+    for (auto& vertexFormat : desc.vertexFormats)
+        DecodeVertexFormat(vertexFormat);
+
+    desc.vertexShader           = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.tessControlShader      = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.tessEvaluationShader   = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.geometryShader         = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.fragmentShader         = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.computeShader          = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.amplificationShader    = ObjectOf<Shader>(CaptureObjectType::Shader);
+    desc.meshShader             = ObjectOf<Shader>(CaptureObjectType::Shader);
+}
+
+void CaptureDecoder::Descriptor(PipelineLayoutDescriptor& desc)
+{
+    Array(desc.bindings);
+    Value(desc.constants);
+    Array(desc.staticSamplers);
+}
+
+void CaptureDecoder::Descriptor(GraphicsPipelineDescriptor& desc)
+{
+    desc.shaderProgram  = ObjectOf<ShaderProgram>(CaptureObjectType::ShaderProgram);
+    desc.pipelineLayout = ObjectOf<PipelineLayout>(CaptureObjectType::PipelineLayout);
+    desc.renderTarget   = ObjectOf<RenderTarget>(CaptureObjectType::RenderTarget);
+    Enum(desc.primitiveTopology);
+    Array(desc.viewports);
+    Array(desc.scissors);
+    Value(desc.depth);
+    Value(desc.stencil);
+    Value(desc.rasterizer);
+    Bool(desc.blend.blendEnabled);
+    Value(desc.blend.blendFactor);
+    Bool(desc.blend.alphaToCoverageEnabled);
+    Enum(desc.blend.logicOp);
+    Array(desc.blend.targets);
+    Value(desc.dynamicStates);
+    Value(desc.viewMask);
+}
+
+void CaptureDecoder::Descriptor(ComputePipelineDescriptor& desc)
+{
+    desc.shaderProgram  = ObjectOf<ShaderProgram>(CaptureObjectType::ShaderProgram);
+    desc.pipelineLayout = ObjectOf<PipelineLayout>(CaptureObjectType::PipelineLayout);
+}
+
+void CaptureDecoder::GetObjects(std::vector<RenderSystemChild*>& objects, std::vector<CaptureObjectType>& types) const
+{
+    objects.clear();
+    types.clear();
+    for (const auto& entry : objects_)
+    {
+        if (entry.obj != nullptr)
+        {
+            objects.push_back(entry.obj);
+            types.push_back(entry.type);
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void CaptureDecoder::DecodeVertexFormat(VertexFormat& format)
+{
+    format.attributes.resize(Value<std::uint32_t>());
+    for (auto& attrib : format.attributes)
+    {
+        if (auto name = String())
+            attrib.name = name;
+        Enum(attrib.format);
+        Value(attrib.instanceDivisor);
+        Value(attrib.offset);
+        Value(attrib.semanticIndex);
+    }
+    Value(format.stride);
+    Value(format.inputSlot);
+}
+
+void CaptureDecoder::ThrowCorrupted()
+{
+    throw std::runtime_error("corrupted trace at byte offset " + std::to_string(pos_));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
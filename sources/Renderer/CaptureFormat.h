@@ -0,0 +1,365 @@
+/*
+ * CaptureFormat.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_FORMAT_H
+#define LLGL_CAPTURE_FORMAT_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/RenderSystemChild.h>
+#include <LLGL/RenderContextFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/ShaderProgramFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/RenderTargetFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/ComputePipelineFlags.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+/*
+Binary trace of render system calls:
+The trace begins with a header (see CaptureHeader), followed by a sequence of records until the end of the file.
+Each record begins with an opcode (see CaptureOpcode), followed by the arguments of the respective call.
+Objects are referred to by 32-bit identifiers that are assigned in the order of their creation, where zero denotes a null pointer.
+Values are stored in their native memory layout, so a trace can only be replayed on the same platform it has been captured on.
+*/
+
+// Header of a trace file.
+struct CaptureHeader
+{
+    char            magic[4];   // "LLCT"
+    std::uint32_t   version;    // Trace format version, see 'g_captureVersion'
+    std::uint32_t   numFrames;  // Number of presented frames, or zero if the trace has not been closed properly
+};
+
+static const char           g_captureMagic[4]   = { 'L', 'L', 'C', 'T' };
+static const std::uint32_t  g_captureVersion    = 6;
+
+// Opcodes of the recorded calls. Command buffer opcodes are followed by the identifier of the command buffer.
+// Creation opcodes are followed by the arguments of the creation and then by the identifier of the new object.
+enum class CaptureOpcode : std::uint8_t
+{
+    /* ----- Render system ----- */
+    CreateRenderContext = 1,
+    CreateCommandBuffer,
+    CreateCommandBufferExt,
+    CreateSecondaryCommandBuffer,
+    CreateBuffer,
+    CreateBufferArray,
+    WriteBuffer,
+    CreateTexture,
+    CreateTextureView,
+    WriteTexture,
+    GenerateMips,
+    GenerateMipsRange,
+    CreateSampler,
+    CreateResourceHeap,
+    WriteResourceHeap,
+    CreateRenderTarget,
+    CreateRenderPass,
+    CreateShader,
+    CreateShaderProgram,
+    CreatePipelineLayout,
+    CreateGraphicsPipeline,
+    CreateComputePipeline,
+    Release,
+
+    /* ----- Render context ----- */
+    Present,
+
+    /* ----- Command buffer ----- */
+    SetViewport,
+    SetViewports,
+    SetScissor,
+    SetScissors,
+    SetClearColor,
+    SetClearDepth,
+    SetClearStencil,
+    Clear,
+    ClearAttachments,
+    SetVertexBuffer,
+    SetVertexBufferOffset,
+    SetVertexBufferArray,
+    SetIndexBuffer,
+    SetIndexBufferOffset,
+    SetConstantBuffer,
+    SetConstantBufferRange,
+    SetStorageBuffer,
+    SetTexture,
+    SetSampler,
+    SetGraphicsResourceHeap,
+    SetComputeResourceHeap,
+    SetConstants,
+    SetRenderTarget,
+    BeginRenderPass,
+    EndRenderPass,
+    SetGraphicsPipeline,
+    SetComputePipeline,
+    SetStencilReference,
+    SetBlendFactor,
+    Draw,
+    DrawIndexed,
+    DrawIndexedVertexOffset,
+    DrawInstanced,
+    DrawInstancedFirstInstance,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedVertexOffset,
+    DrawIndexedInstancedFirstInstance,
+    DrawIndirect,
+    DrawIndirectMulti,
+    DrawIndexedIndirect,
+    DrawIndexedIndirectMulti,
+    DrawMeshTasks,
+    DrawMeshTasksIndirect,
+    Dispatch,
+    DispatchIndirect,
+    DispatchBarrier,
+    CopyBuffer,
+    Begin,
+    End,
+    ExecuteCommands,
+};
+
+// Types of the objects that are referred to by identifiers.
+enum class CaptureObjectType : std::uint8_t
+{
+    Undefined = 0,
+    RenderContext,
+    CommandBuffer,
+    Buffer,
+    BufferArray,
+    Texture,
+    Sampler,
+    ResourceHeap,
+    RenderTarget,
+    RenderPass,
+    Shader,
+    ShaderProgram,
+    PipelineLayout,
+    GraphicsPipeline,
+    ComputePipeline,
+};
+
+// Encodes records into a byte buffer and assigns the identifiers of the recorded objects.
+class LLGL_EXPORT CaptureEncoder
+{
+
+    public:
+
+        // Assigns a new identifier to the specified object and encodes it.
+        void AddObject(const RenderSystemChild* obj);
+
+        // Encodes the identifier of the specified object and removes it from the encoder.
+        void RemoveObject(const RenderSystemChild* obj);
+
+        // Encodes the identifier of the specified object, or zero if the object is null or unknown.
+        void Object(const RenderSystemChild* obj);
+
+        // Returns true if the specified object has an identifier.
+        bool HasObject(const RenderSystemChild* obj) const;
+
+        void Opcode(const CaptureOpcode opcode);
+
+        template <typename T>
+        void Value(const T& value)
+        {
+            Data(&value, sizeof(value));
+        }
+
+        template <typename T>
+        void Enum(const T& value)
+        {
+            Value(static_cast<std::uint32_t>(value));
+        }
+
+        void Bool(bool value);
+        void Data(const void* data, std::size_t size);
+
+        // Encodes the size of the data block, followed by the data itself.
+        void Blob(const void* data, std::size_t size);
+
+        // Encodes a null terminated string, or a null pointer.
+        void String(const char* s);
+
+        template <typename T>
+        void Array(const T* values, std::uint32_t count)
+        {
+            Value(count);
+            Data(values, sizeof(T) * count);
+        }
+
+        void Descriptor(const RenderContextDescriptor& desc);
+        void Descriptor(const CommandBufferDescriptor& desc);
+        void Descriptor(const BufferDescriptor& desc);
+        void Descriptor(const TextureDescriptor& desc);
+        void Descriptor(const TextureViewDescriptor& desc);
+        void Descriptor(const SrcImageDescriptor* desc);
+        void Descriptor(const SamplerDescriptor& desc);
+        void Descriptor(const ResourceViewDescriptor& desc);
+        void Descriptor(const ResourceHeapDescriptor& desc);
+        void Descriptor(const RenderTargetDescriptor& desc);
+        void Descriptor(const RenderPassDescriptor& desc);
+        void Descriptor(const ShaderDescriptor& desc);
+        void Descriptor(const ShaderProgramDescriptor& desc);
+        void Descriptor(const PipelineLayoutDescriptor& desc);
+        void Descriptor(const GraphicsPipelineDescriptor& desc);
+        void Descriptor(const ComputePipelineDescriptor& desc);
+
+        // Returns the encoded bytes.
+        inline const std::vector<char>& GetData() const
+        {
+            return data_;
+        }
+
+        // Removes the encoded bytes, but keeps the identifiers of all objects.
+        inline void ClearData()
+        {
+            data_.clear();
+        }
+
+    private:
+
+        void EncodeVertexFormat(const VertexFormat& format);
+
+    private:
+
+        std::vector<char>                                           data_;
+        std::unordered_map<const RenderSystemChild*, std::uint32_t> ids_;
+        std::uint32_t                                               nextID_ = 0;
+
+};
+
+// Decodes records from a byte buffer. Strings and data blocks refer to the byte buffer, so it must remain valid.
+class LLGL_EXPORT CaptureDecoder
+{
+
+    public:
+
+        CaptureDecoder(const char* data, std::size_t size);
+
+        // Decodes the identifier of a new object, and registers the specified object under this identifier.
+        void AddObject(RenderSystemChild* obj, const CaptureObjectType type);
+
+        // Decodes an object identifier and returns the object or null, and its type.
+        RenderSystemChild* Object(CaptureObjectType* type = nullptr);
+
+        // Decodes an object identifier and removes the object, which is returned along with its type.
+        RenderSystemChild* RemoveObject(CaptureObjectType& type);
+
+        // Decodes an object identifier and returns the object. Throws std::runtime_error if the object has a different type.
+        template <typename T>
+        T* ObjectOf(const CaptureObjectType type)
+        {
+            CaptureObjectType objType = CaptureObjectType::Undefined;
+            auto obj = Object(&objType);
+            if (obj != nullptr && objType != type)
+                ThrowCorrupted();
+            return static_cast<T*>(obj);
+        }
+
+        // Decodes the next opcode, or returns false if the end of the trace has been reached.
+        bool Opcode(CaptureOpcode& opcode);
+
+        template <typename T>
+        void Value(T& value)
+        {
+            ::memcpy(static_cast<void*>(&value), Data(sizeof(value)), sizeof(value));
+        }
+
+        template <typename T>
+        T Value()
+        {
+            T value;
+            Value(value);
+            return value;
+        }
+
+        template <typename T>
+        void Enum(T& value)
+        {
+            value = static_cast<T>(Value<std::uint32_t>());
+        }
+
+        void Bool(bool& value);
+        const void* Data(std::size_t size);
+        const void* Blob(std::size_t& size);
+        const char* String();
+
+        template <typename T>
+        void Array(std::vector<T>& values)
+        {
+            values.resize(Value<std::uint32_t>());
+            if (!values.empty())
+                ::memcpy(static_cast<void*>(values.data()), Data(sizeof(T) * values.size()), sizeof(T) * values.size());
+        }
+
+        void Descriptor(RenderContextDescriptor& desc);
+        void Descriptor(CommandBufferDescriptor& desc);
+        void Descriptor(BufferDescriptor& desc);
+        void Descriptor(TextureDescriptor& desc);
+        void Descriptor(TextureViewDescriptor& desc);
+        bool Descriptor(SrcImageDescriptor& desc);
+        void Descriptor(SamplerDescriptor& desc);
+        void Descriptor(ResourceViewDescriptor& desc);
+        void Descriptor(ResourceHeapDescriptor& desc);
+        void Descriptor(RenderTargetDescriptor& desc);
+        void Descriptor(RenderPassDescriptor& desc);
+        void Descriptor(ShaderDescriptor& desc);
+        void Descriptor(ShaderProgramDescriptor& desc);
+        void Descriptor(PipelineLayoutDescriptor& desc);
+        void Descriptor(GraphicsPipelineDescriptor& desc);
+        void Descriptor(ComputePipelineDescriptor& desc);
+
+        // Returns all objects that have not been removed, in the order of their creation.
+        void GetObjects(std::vector<RenderSystemChild*>& objects, std::vector<CaptureObjectType>& types) const;
+
+    private:
+
+        void DecodeVertexFormat(VertexFormat& format);
+
+        [[noreturn]]
+        void ThrowCorrupted();
+
+    private:
+
+        struct ObjectEntry
+        {
+            RenderSystemChild*  obj     = nullptr;
+            CaptureObjectType   type    = CaptureObjectType::Undefined;
+        };
+
+        const char*                 data_       = nullptr;
+        std::size_t                 size_       = 0;
+        std::size_t                 pos_        = 0;
+        std::vector<ObjectEntry>    objects_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
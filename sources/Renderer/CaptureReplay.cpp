@@ -0,0 +1,893 @@
+/*
+ * CaptureReplay.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CaptureReplay.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBufferExt.h>
+#include "CaptureFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+[[noreturn]]
+static void ThrowReplayFailed(const char* reason)
+{
+    throw std::runtime_error("failed to replay trace: " + std::string(reason));
+}
+
+// Decodes an object reference that must not be null.
+template <typename T>
+static T& DecodeRef(CaptureDecoder& decoder, const CaptureObjectType type)
+{
+    auto obj = decoder.ObjectOf<T>(type);
+    if (obj == nullptr)
+        ThrowReplayFailed("missing object reference");
+    return *obj;
+}
+
+// Throws an exception if the render system failed to create an object of the trace.
+template <typename T>
+static T* AssertCreated(T* obj, const char* reason)
+{
+    if (obj == nullptr)
+        ThrowReplayFailed(reason);
+    return obj;
+}
+
+static void ReleaseObject(RenderSystem& renderSystem, RenderSystemChild* obj, const CaptureObjectType type)
+{
+    switch (type)
+    {
+        case CaptureObjectType::RenderContext:      renderSystem.Release(*static_cast<RenderContext*>(obj));    break;
+        case CaptureObjectType::CommandBuffer:      renderSystem.Release(*static_cast<CommandBuffer*>(obj));    break;
+        case CaptureObjectType::Buffer:             renderSystem.Release(*static_cast<Buffer*>(obj));           break;
+        case CaptureObjectType::BufferArray:        renderSystem.Release(*static_cast<BufferArray*>(obj));      break;
+        case CaptureObjectType::Texture:            renderSystem.Release(*static_cast<Texture*>(obj));          break;
+        case CaptureObjectType::Sampler:            renderSystem.Release(*static_cast<Sampler*>(obj));          break;
+        case CaptureObjectType::ResourceHeap:       renderSystem.Release(*static_cast<ResourceHeap*>(obj));     break;
+        case CaptureObjectType::RenderTarget:       renderSystem.Release(*static_cast<RenderTarget*>(obj));     break;
+        case CaptureObjectType::RenderPass:         renderSystem.Release(*static_cast<RenderPass*>(obj));       break;
+        case CaptureObjectType::Shader:             renderSystem.Release(*static_cast<Shader*>(obj));           break;
+        case CaptureObjectType::ShaderProgram:      renderSystem.Release(*static_cast<ShaderProgram*>(obj));    break;
+        case CaptureObjectType::PipelineLayout:     renderSystem.Release(*static_cast<PipelineLayout*>(obj));   break;
+        case CaptureObjectType::GraphicsPipeline:   renderSystem.Release(*static_cast<GraphicsPipeline*>(obj)); break;
+        case CaptureObjectType::ComputePipeline:    renderSystem.Release(*static_cast<ComputePipeline*>(obj));  break;
+        default:                                                                                                break;
+    }
+}
+
+static CommandBufferExt& GetCommandBufferExt(CommandBuffer& commandBuffer, bool isExt)
+{
+    if (!isExt)
+        ThrowReplayFailed("command requires extended command buffer");
+    return static_cast<CommandBufferExt&>(commandBuffer);
+}
+
+/*
+Stores the command buffers of the trace and the primary command buffers that have been used since the last presentation.
+The debug layer does not see the submissions to the command queues, so all primary command buffers that have been used
+within a frame are submitted right before the frame is presented.
+*/
+class CaptureReplayState
+{
+
+    public:
+
+        CaptureReplayState(RenderSystem& renderSystem) :
+            renderSystem_ { renderSystem }
+        {
+        }
+
+        void AddCommandBuffer(CommandBuffer* commandBuffer, const QueueType queueType, bool isSecondary, bool isExt)
+        {
+            commandBuffers_.push_back({ commandBuffer, queueType, isSecondary, isExt });
+        }
+
+        // Marks the specified command buffer as used and returns true if it is an extended command buffer.
+        bool UseCommandBuffer(CommandBuffer* commandBuffer)
+        {
+            auto it = std::find_if(
+                commandBuffers_.begin(), commandBuffers_.end(),
+                [commandBuffer](const CommandBufferEntry& entry) { return (entry.commandBuffer == commandBuffer); }
+            );
+            if (it == commandBuffers_.end())
+                ThrowReplayFailed("unknown command buffer");
+
+            const auto index = static_cast<std::size_t>(it - commandBuffers_.begin());
+            if (!it->isSecondary && std::find(pending_.begin(), pending_.end(), index) == pending_.end())
+                pending_.push_back(index);
+
+            return it->isExt;
+        }
+
+        void RemoveCommandBuffer(CommandBuffer* commandBuffer)
+        {
+            SubmitPending();
+            commandBuffers_.erase(
+                std::remove_if(
+                    commandBuffers_.begin(), commandBuffers_.end(),
+                    [commandBuffer](const CommandBufferEntry& entry) { return (entry.commandBuffer == commandBuffer); }
+                ),
+                commandBuffers_.end()
+            );
+        }
+
+        // Submits all pending command buffers in the order of their first use, batched by command queue.
+        void SubmitPending()
+        {
+            std::vector<CommandBuffer*> batch;
+            QueueType batchQueueType = QueueType::Graphics;
+
+            for (auto index : pending_)
+            {
+                const auto& entry = commandBuffers_[index];
+                if (!batch.empty() && entry.queueType != batchQueueType)
+                    SubmitBatch(batch, batchQueueType);
+                batch.push_back(entry.commandBuffer);
+                batchQueueType = entry.queueType;
+            }
+
+            if (!batch.empty())
+                SubmitBatch(batch, batchQueueType);
+
+            pending_.clear();
+        }
+
+    private:
+
+        struct CommandBufferEntry
+        {
+            CommandBuffer*  commandBuffer;
+            QueueType       queueType;
+            bool            isSecondary;
+            bool            isExt;
+        };
+
+        void SubmitBatch(std::vector<CommandBuffer*>& batch, const QueueType queueType)
+        {
+            if (auto commandQueue = renderSystem_.GetCommandQueue(queueType))
+                commandQueue->Submit(static_cast<std::uint32_t>(batch.size()), batch.data());
+            batch.clear();
+        }
+
+    private:
+
+        RenderSystem&                   renderSystem_;
+        std::vector<CommandBufferEntry> commandBuffers_;
+        std::vector<std::size_t>        pending_;
+
+};
+
+// Replays a single command of a command buffer. Returns false if the opcode is not a command buffer opcode.
+static bool ReplayCommand(CaptureDecoder& decoder, const CaptureOpcode opcode, CaptureReplayState& state)
+{
+    /* All command buffer opcodes follow the render system opcodes */
+    if (opcode < CaptureOpcode::SetViewport)
+        return false;
+
+    auto& cmdBuffer = DecodeRef<CommandBuffer>(decoder, CaptureObjectType::CommandBuffer);
+    const bool isExt = state.UseCommandBuffer(&cmdBuffer);
+
+    switch (opcode)
+    {
+        case CaptureOpcode::SetViewport:
+        {
+            cmdBuffer.SetViewport(decoder.Value<Viewport>());
+        }
+        break;
+
+        case CaptureOpcode::SetViewports:
+        {
+            std::vector<Viewport> viewports;
+            decoder.Array(viewports);
+            cmdBuffer.SetViewports(static_cast<std::uint32_t>(viewports.size()), viewports.data());
+        }
+        break;
+
+        case CaptureOpcode::SetScissor:
+        {
+            cmdBuffer.SetScissor(decoder.Value<Scissor>());
+        }
+        break;
+
+        case CaptureOpcode::SetScissors:
+        {
+            std::vector<Scissor> scissors;
+            decoder.Array(scissors);
+            cmdBuffer.SetScissors(static_cast<std::uint32_t>(scissors.size()), scissors.data());
+        }
+        break;
+
+        case CaptureOpcode::SetClearColor:
+        {
+            cmdBuffer.SetClearColor(decoder.Value<ColorRGBAf>());
+        }
+        break;
+
+        case CaptureOpcode::SetClearDepth:
+        {
+            cmdBuffer.SetClearDepth(decoder.Value<float>());
+        }
+        break;
+
+        case CaptureOpcode::SetClearStencil:
+        {
+            cmdBuffer.SetClearStencil(decoder.Value<std::uint32_t>());
+        }
+        break;
+
+        case CaptureOpcode::Clear:
+        {
+            cmdBuffer.Clear(static_cast<long>(decoder.Value<std::uint32_t>()));
+        }
+        break;
+
+        case CaptureOpcode::ClearAttachments:
+        {
+            std::vector<AttachmentClear> attachments;
+            decoder.Array(attachments);
+            cmdBuffer.ClearAttachments(static_cast<std::uint32_t>(attachments.size()), attachments.data());
+        }
+        break;
+
+        case CaptureOpcode::SetVertexBuffer:
+        {
+            cmdBuffer.SetVertexBuffer(DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer));
+        }
+        break;
+
+        case CaptureOpcode::SetVertexBufferOffset:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto offset         = decoder.Value<std::uint64_t>();
+            cmdBuffer.SetVertexBuffer(buffer, offset);
+        }
+        break;
+
+        case CaptureOpcode::SetVertexBufferArray:
+        {
+            cmdBuffer.SetVertexBufferArray(DecodeRef<BufferArray>(decoder, CaptureObjectType::BufferArray));
+        }
+        break;
+
+        case CaptureOpcode::SetIndexBuffer:
+        {
+            cmdBuffer.SetIndexBuffer(DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer));
+        }
+        break;
+
+        case CaptureOpcode::SetIndexBufferOffset:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto format         = decoder.Value<DataType>();
+            auto offset         = decoder.Value<std::uint64_t>();
+            cmdBuffer.SetIndexBuffer(buffer, format, offset);
+        }
+        break;
+
+        case CaptureOpcode::SetConstantBuffer:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto slot           = decoder.Value<std::uint32_t>();
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            GetCommandBufferExt(cmdBuffer, isExt).SetConstantBuffer(buffer, slot, static_cast<long>(stageFlags));
+        }
+        break;
+
+        case CaptureOpcode::SetConstantBufferRange:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto slot           = decoder.Value<std::uint32_t>();
+            auto offset         = decoder.Value<std::uint64_t>();
+            auto size           = decoder.Value<std::uint64_t>();
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            GetCommandBufferExt(cmdBuffer, isExt).SetConstantBufferRange(buffer, slot, offset, size, static_cast<long>(stageFlags));
+        }
+        break;
+
+        case CaptureOpcode::SetStorageBuffer:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto slot           = decoder.Value<std::uint32_t>();
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            GetCommandBufferExt(cmdBuffer, isExt).SetStorageBuffer(buffer, slot, static_cast<long>(stageFlags));
+        }
+        break;
+
+        case CaptureOpcode::SetTexture:
+        {
+            auto& texture       = DecodeRef<Texture>(decoder, CaptureObjectType::Texture);
+            auto slot           = decoder.Value<std::uint32_t>();
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            GetCommandBufferExt(cmdBuffer, isExt).SetTexture(texture, slot, static_cast<long>(stageFlags));
+        }
+        break;
+
+        case CaptureOpcode::SetSampler:
+        {
+            auto& sampler       = DecodeRef<Sampler>(decoder, CaptureObjectType::Sampler);
+            auto slot           = decoder.Value<std::uint32_t>();
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            GetCommandBufferExt(cmdBuffer, isExt).SetSampler(sampler, slot, static_cast<long>(stageFlags));
+        }
+        break;
+
+        case CaptureOpcode::SetGraphicsResourceHeap:
+        case CaptureOpcode::SetComputeResourceHeap:
+        {
+            auto& resourceHeap  = DecodeRef<ResourceHeap>(decoder, CaptureObjectType::ResourceHeap);
+            auto firstSet       = decoder.Value<std::uint32_t>();
+            std::vector<std::uint32_t> dynamicOffsets;
+            decoder.Array(dynamicOffsets);
+            const auto numDynamicOffsets = static_cast<std::uint32_t>(dynamicOffsets.size());
+            if (opcode == CaptureOpcode::SetGraphicsResourceHeap)
+                cmdBuffer.SetGraphicsResourceHeap(resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets.data());
+            else
+                cmdBuffer.SetComputeResourceHeap(resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets.data());
+        }
+        break;
+
+        case CaptureOpcode::SetConstants:
+        {
+            auto stageFlags     = decoder.Value<std::uint32_t>();
+            auto offset         = decoder.Value<std::uint32_t>();
+            std::size_t size    = 0;
+            auto data           = decoder.Blob(size);
+            cmdBuffer.SetConstants(static_cast<long>(stageFlags), offset, static_cast<std::uint32_t>(size), data);
+        }
+        break;
+
+        case CaptureOpcode::SetRenderTarget:
+        {
+            CaptureObjectType type = CaptureObjectType::Undefined;
+            auto target = decoder.Object(&type);
+            if (type == CaptureObjectType::RenderContext)
+                cmdBuffer.SetRenderTarget(*static_cast<RenderContext*>(target));
+            else if (type == CaptureObjectType::RenderTarget)
+                cmdBuffer.SetRenderTarget(*static_cast<RenderTarget*>(target));
+            else
+                ThrowReplayFailed("invalid render target");
+        }
+        break;
+
+        case CaptureOpcode::BeginRenderPass:
+        {
+            CaptureObjectType type = CaptureObjectType::Undefined;
+            auto target     = decoder.Object(&type);
+            auto renderPass = decoder.ObjectOf<RenderPass>(CaptureObjectType::RenderPass);
+            std::vector<ClearValue> clearValues;
+            decoder.Array(clearValues);
+            const auto numClearValues = static_cast<std::uint32_t>(clearValues.size());
+            if (type == CaptureObjectType::RenderContext)
+                cmdBuffer.BeginRenderPass(*static_cast<RenderContext*>(target), renderPass, numClearValues, clearValues.data());
+            else if (type == CaptureObjectType::RenderTarget)
+                cmdBuffer.BeginRenderPass(*static_cast<RenderTarget*>(target), renderPass, numClearValues, clearValues.data());
+            else
+                ThrowReplayFailed("invalid render target");
+        }
+        break;
+
+        case CaptureOpcode::EndRenderPass:
+        {
+            cmdBuffer.EndRenderPass();
+        }
+        break;
+
+        case CaptureOpcode::SetGraphicsPipeline:
+        {
+            cmdBuffer.SetGraphicsPipeline(DecodeRef<GraphicsPipeline>(decoder, CaptureObjectType::GraphicsPipeline));
+        }
+        break;
+
+        case CaptureOpcode::SetComputePipeline:
+        {
+            cmdBuffer.SetComputePipeline(DecodeRef<ComputePipeline>(decoder, CaptureObjectType::ComputePipeline));
+        }
+        break;
+
+        case CaptureOpcode::SetStencilReference:
+        {
+            cmdBuffer.SetStencilReference(decoder.Value<std::uint32_t>());
+        }
+        break;
+
+        case CaptureOpcode::SetBlendFactor:
+        {
+            cmdBuffer.SetBlendFactor(decoder.Value<ColorRGBAf>());
+        }
+        break;
+
+        case CaptureOpcode::Draw:
+        {
+            auto numVertices    = decoder.Value<std::uint32_t>();
+            auto firstVertex    = decoder.Value<std::uint32_t>();
+            cmdBuffer.Draw(numVertices, firstVertex);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndexed:
+        {
+            auto numIndices     = decoder.Value<std::uint32_t>();
+            auto firstIndex     = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawIndexed(numIndices, firstIndex);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndexedVertexOffset:
+        {
+            auto numIndices     = decoder.Value<std::uint32_t>();
+            auto firstIndex     = decoder.Value<std::uint32_t>();
+            auto vertexOffset   = decoder.Value<std::int32_t>();
+            cmdBuffer.DrawIndexed(numIndices, firstIndex, vertexOffset);
+        }
+        break;
+
+        case CaptureOpcode::DrawInstanced:
+        {
+            auto numVertices    = decoder.Value<std::uint32_t>();
+            auto firstVertex    = decoder.Value<std::uint32_t>();
+            auto numInstances   = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances);
+        }
+        break;
+
+        case CaptureOpcode::DrawInstancedFirstInstance:
+        {
+            auto numVertices    = decoder.Value<std::uint32_t>();
+            auto firstVertex    = decoder.Value<std::uint32_t>();
+            auto numInstances   = decoder.Value<std::uint32_t>();
+            auto firstInstance  = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndexedInstanced:
+        {
+            auto numIndices     = decoder.Value<std::uint32_t>();
+            auto numInstances   = decoder.Value<std::uint32_t>();
+            auto firstIndex     = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndexedInstancedVertexOffset:
+        {
+            auto numIndices     = decoder.Value<std::uint32_t>();
+            auto numInstances   = decoder.Value<std::uint32_t>();
+            auto firstIndex     = decoder.Value<std::uint32_t>();
+            auto vertexOffset   = decoder.Value<std::int32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndexedInstancedFirstInstance:
+        {
+            auto numIndices     = decoder.Value<std::uint32_t>();
+            auto numInstances   = decoder.Value<std::uint32_t>();
+            auto firstIndex     = decoder.Value<std::uint32_t>();
+            auto vertexOffset   = decoder.Value<std::int32_t>();
+            auto firstInstance  = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndirect:
+        case CaptureOpcode::DrawIndexedIndirect:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto offset         = decoder.Value<std::uint64_t>();
+            if (opcode == CaptureOpcode::DrawIndirect)
+                cmdBuffer.DrawIndirect(buffer, offset);
+            else
+                cmdBuffer.DrawIndexedIndirect(buffer, offset);
+        }
+        break;
+
+        case CaptureOpcode::DrawIndirectMulti:
+        case CaptureOpcode::DrawIndexedIndirectMulti:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto offset         = decoder.Value<std::uint64_t>();
+            auto numCommands    = decoder.Value<std::uint32_t>();
+            auto stride         = decoder.Value<std::uint32_t>();
+            if (opcode == CaptureOpcode::DrawIndirectMulti)
+                cmdBuffer.DrawIndirect(buffer, offset, numCommands, stride);
+            else
+                cmdBuffer.DrawIndexedIndirect(buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case CaptureOpcode::DrawMeshTasks:
+        {
+            auto groupSizeX     = decoder.Value<std::uint32_t>();
+            auto groupSizeY     = decoder.Value<std::uint32_t>();
+            auto groupSizeZ     = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawMeshTasks(groupSizeX, groupSizeY, groupSizeZ);
+        }
+        break;
+
+        case CaptureOpcode::DrawMeshTasksIndirect:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto offset         = decoder.Value<std::uint64_t>();
+            auto numCommands    = decoder.Value<std::uint32_t>();
+            auto stride         = decoder.Value<std::uint32_t>();
+            cmdBuffer.DrawMeshTasksIndirect(buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case CaptureOpcode::Dispatch:
+        {
+            auto groupSizeX     = decoder.Value<std::uint32_t>();
+            auto groupSizeY     = decoder.Value<std::uint32_t>();
+            auto groupSizeZ     = decoder.Value<std::uint32_t>();
+            cmdBuffer.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+        }
+        break;
+
+        case CaptureOpcode::DispatchIndirect:
+        {
+            auto& buffer        = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto offset         = decoder.Value<std::uint64_t>();
+            cmdBuffer.DispatchIndirect(buffer, offset);
+        }
+        break;
+
+        case CaptureOpcode::DispatchBarrier:
+        {
+            cmdBuffer.DispatchBarrier();
+        }
+        break;
+
+        case CaptureOpcode::CopyBuffer:
+        {
+            auto& dstBuffer     = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto dstOffset      = decoder.Value<std::uint64_t>();
+            auto& srcBuffer     = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+            auto srcOffset      = decoder.Value<std::uint64_t>();
+            auto size           = decoder.Value<std::uint64_t>();
+            cmdBuffer.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
+        }
+        break;
+
+        case CaptureOpcode::Begin:
+        {
+            cmdBuffer.Begin();
+        }
+        break;
+
+        case CaptureOpcode::End:
+        {
+            cmdBuffer.End();
+        }
+        break;
+
+        case CaptureOpcode::ExecuteCommands:
+        {
+            cmdBuffer.ExecuteCommands(DecodeRef<CommandBuffer>(decoder, CaptureObjectType::CommandBuffer));
+        }
+        break;
+
+        default:
+        {
+            ThrowReplayFailed("unknown opcode");
+        }
+        break;
+    }
+
+    return true;
+}
+
+
+/*
+ * CaptureReplay class
+ */
+
+bool CaptureReplay::Load(const std::string& filename)
+{
+    std::ifstream file { filename, std::ios_base::binary | std::ios_base::ate };
+    if (!file.good())
+        return false;
+
+    const auto fileSize = static_cast<std::size_t>(file.tellg());
+    if (fileSize < sizeof(CaptureHeader))
+        return false;
+
+    file.seekg(0);
+
+    /* Read and validate header */
+    CaptureHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_captureMagic, sizeof(g_captureMagic)) != 0 || header.version != g_captureVersion)
+        return false;
+
+    /* Read all records at once */
+    std::vector<char> data(fileSize - sizeof(header));
+    if (!data.empty() && !file.read(data.data(), static_cast<std::streamsize>(data.size())))
+        return false;
+
+    data_       = std::move(data);
+    numFrames_  = header.numFrames;
+
+    return true;
+}
+
+void CaptureReplay::Replay(RenderSystem& renderSystem, const std::function<void(std::uint32_t frame)>& frameCallback) const
+{
+    CaptureDecoder      decoder { data_.data(), data_.size() };
+    CaptureReplayState  state   { renderSystem };
+    CaptureOpcode       opcode  = CaptureOpcode::Present;
+    std::uint32_t       frame   = 0;
+
+    while (decoder.Opcode(opcode))
+    {
+        if (ReplayCommand(decoder, opcode, state))
+            continue;
+
+        switch (opcode)
+        {
+            case CaptureOpcode::CreateRenderContext:
+            {
+                RenderContextDescriptor desc;
+                decoder.Descriptor(desc);
+
+                /* Render as fast as possible, since the replay is mostly used for profiling */
+                desc.vsync.enabled = false;
+
+                auto renderContext = AssertCreated(renderSystem.CreateRenderContext(desc), "cannot create render context");
+                decoder.AddObject(renderContext, CaptureObjectType::RenderContext);
+            }
+            break;
+
+            case CaptureOpcode::CreateCommandBuffer:
+            {
+                CommandBufferDescriptor desc;
+                decoder.Descriptor(desc);
+                auto commandBuffer = AssertCreated(renderSystem.CreateCommandBuffer(desc), "cannot create command buffer");
+                decoder.AddObject(commandBuffer, CaptureObjectType::CommandBuffer);
+                state.AddCommandBuffer(commandBuffer, desc.queueType, false, false);
+            }
+            break;
+
+            case CaptureOpcode::CreateCommandBufferExt:
+            {
+                CommandBuffer* commandBuffer = AssertCreated(renderSystem.CreateCommandBufferExt(), "renderer does not support extended command buffers");
+                decoder.AddObject(commandBuffer, CaptureObjectType::CommandBuffer);
+                state.AddCommandBuffer(commandBuffer, QueueType::Graphics, false, true);
+            }
+            break;
+
+            case CaptureOpcode::CreateSecondaryCommandBuffer:
+            {
+                auto commandBuffer = AssertCreated(renderSystem.CreateSecondaryCommandBuffer(), "renderer does not support secondary command buffers");
+                decoder.AddObject(commandBuffer, CaptureObjectType::CommandBuffer);
+                state.AddCommandBuffer(commandBuffer, QueueType::Graphics, true, false);
+            }
+            break;
+
+            case CaptureOpcode::CreateBuffer:
+            {
+                BufferDescriptor desc;
+                decoder.Descriptor(desc);
+                std::size_t initialDataSize = 0;
+                auto initialData = decoder.Blob(initialDataSize);
+                auto buffer = renderSystem.CreateBuffer(desc, (initialDataSize > 0 ? initialData : nullptr));
+                decoder.AddObject(buffer, CaptureObjectType::Buffer);
+            }
+            break;
+
+            case CaptureOpcode::CreateBufferArray:
+            {
+                std::vector<Buffer*> buffers(decoder.Value<std::uint32_t>());
+                for (auto& buffer : buffers)
+                    buffer = &DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+                auto bufferArray = renderSystem.CreateBufferArray(static_cast<std::uint32_t>(buffers.size()), buffers.data());
+                decoder.AddObject(bufferArray, CaptureObjectType::BufferArray);
+            }
+            break;
+
+            case CaptureOpcode::WriteBuffer:
+            {
+                auto& buffer    = DecodeRef<Buffer>(decoder, CaptureObjectType::Buffer);
+                auto offset     = decoder.Value<std::uint64_t>();
+                std::size_t dataSize = 0;
+                auto data       = decoder.Blob(dataSize);
+                renderSystem.WriteBuffer(buffer, data, dataSize, static_cast<std::size_t>(offset));
+            }
+            break;
+
+            case CaptureOpcode::CreateTexture:
+            {
+                TextureDescriptor textureDesc;
+                SrcImageDescriptor imageDesc;
+                decoder.Descriptor(textureDesc);
+                const bool hasImage = decoder.Descriptor(imageDesc);
+                auto texture = renderSystem.CreateTexture(textureDesc, (hasImage ? &imageDesc : nullptr));
+                decoder.AddObject(texture, CaptureObjectType::Texture);
+            }
+            break;
+
+            case CaptureOpcode::CreateTextureView:
+            {
+                auto& sharedTexture = DecodeRef<Texture>(decoder, CaptureObjectType::Texture);
+                TextureViewDescriptor desc;
+                decoder.Descriptor(desc);
+                auto texture = AssertCreated(renderSystem.CreateTextureView(sharedTexture, desc), "cannot create texture view");
+                decoder.AddObject(texture, CaptureObjectType::Texture);
+            }
+            break;
+
+            case CaptureOpcode::WriteTexture:
+            {
+                auto& texture = DecodeRef<Texture>(decoder, CaptureObjectType::Texture);
+                auto subTextureDesc = decoder.Value<SubTextureDescriptor>();
+                SrcImageDescriptor imageDesc;
+                if (decoder.Descriptor(imageDesc))
+                    renderSystem.WriteTexture(texture, subTextureDesc, imageDesc);
+            }
+            break;
+
+            case CaptureOpcode::GenerateMips:
+            {
+                renderSystem.GenerateMips(DecodeRef<Texture>(decoder, CaptureObjectType::Texture));
+            }
+            break;
+
+            case CaptureOpcode::GenerateMipsRange:
+            {
+                auto& texture       = DecodeRef<Texture>(decoder, CaptureObjectType::Texture);
+                auto baseMipLevel   = decoder.Value<std::uint32_t>();
+                auto numMipLevels   = decoder.Value<std::uint32_t>();
+                auto baseArrayLayer = decoder.Value<std::uint32_t>();
+                auto numArrayLayers = decoder.Value<std::uint32_t>();
+                renderSystem.GenerateMips(texture, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+            }
+            break;
+
+            case CaptureOpcode::CreateSampler:
+            {
+                SamplerDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateSampler(desc), CaptureObjectType::Sampler);
+            }
+            break;
+
+            case CaptureOpcode::CreateResourceHeap:
+            {
+                ResourceHeapDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateResourceHeap(desc), CaptureObjectType::ResourceHeap);
+            }
+            break;
+
+            case CaptureOpcode::WriteResourceHeap:
+            {
+                auto& resourceHeap      = DecodeRef<ResourceHeap>(decoder, CaptureObjectType::ResourceHeap);
+                auto firstDescriptor    = decoder.Value<std::uint32_t>();
+                std::vector<ResourceViewDescriptor> resourceViews(decoder.Value<std::uint32_t>());
+                for (auto& resourceView : resourceViews)
+                    decoder.Descriptor(resourceView);
+                renderSystem.WriteResourceHeap(resourceHeap, firstDescriptor, static_cast<std::uint32_t>(resourceViews.size()), resourceViews.data());
+            }
+            break;
+
+            case CaptureOpcode::CreateRenderTarget:
+            {
+                RenderTargetDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateRenderTarget(desc), CaptureObjectType::RenderTarget);
+            }
+            break;
+
+            case CaptureOpcode::CreateRenderPass:
+            {
+                RenderPassDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateRenderPass(desc), CaptureObjectType::RenderPass);
+            }
+            break;
+
+            case CaptureOpcode::CreateShader:
+            {
+                ShaderDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateShader(desc), CaptureObjectType::Shader);
+            }
+            break;
+
+            case CaptureOpcode::CreateShaderProgram:
+            {
+                ShaderProgramDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateShaderProgram(desc), CaptureObjectType::ShaderProgram);
+            }
+            break;
+
+            case CaptureOpcode::CreatePipelineLayout:
+            {
+                PipelineLayoutDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreatePipelineLayout(desc), CaptureObjectType::PipelineLayout);
+            }
+            break;
+
+            case CaptureOpcode::CreateGraphicsPipeline:
+            {
+                GraphicsPipelineDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateGraphicsPipeline(desc), CaptureObjectType::GraphicsPipeline);
+            }
+            break;
+
+            case CaptureOpcode::CreateComputePipeline:
+            {
+                ComputePipelineDescriptor desc;
+                decoder.Descriptor(desc);
+                decoder.AddObject(renderSystem.CreateComputePipeline(desc), CaptureObjectType::ComputePipeline);
+            }
+            break;
+
+            case CaptureOpcode::Release:
+            {
+                CaptureObjectType type = CaptureObjectType::Undefined;
+                if (auto obj = decoder.RemoveObject(type))
+                {
+                    if (type == CaptureObjectType::CommandBuffer)
+                        state.RemoveCommandBuffer(static_cast<CommandBuffer*>(obj));
+                    ReleaseObject(renderSystem, obj, type);
+                }
+            }
+            break;
+
+            case CaptureOpcode::Present:
+            {
+                auto& renderContext = DecodeRef<RenderContext>(decoder, CaptureObjectType::RenderContext);
+                state.SubmitPending();
+                renderContext.Present();
+                if (frameCallback)
+                    frameCallback(frame);
+                ++frame;
+            }
+            break;
+
+            default:
+            {
+                ThrowReplayFailed("unknown opcode");
+            }
+            break;
+        }
+    }
+
+    /* Submit remaining commands and release all objects in reverse order of their creation */
+    state.SubmitPending();
+
+    std::vector<RenderSystemChild*> objects;
+    std::vector<CaptureObjectType> types;
+    decoder.GetObjects(objects, types);
+
+    for (auto i = objects.size(); i-- > 0;)
+        ReleaseObject(renderSystem, objects[i], types[i]);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
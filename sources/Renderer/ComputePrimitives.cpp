@@ -0,0 +1,711 @@
+/*
+ * ComputePrimitives.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ComputePrimitives.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+// Number of bits that are sorted with each radix sort pass, and the number of digits per pass.
+static const std::uint32_t g_radixBits = 4;
+static const std::uint32_t g_radixSize = (1u << g_radixBits);
+
+// Maximum number of thread groups in a single dimension of a dispatch command (i.e. D3D11_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION).
+static const std::uint32_t g_maxNumGroups = 65535;
+
+// Entry points of the HLSL kernels in the order of the ComputePrimitives::Kernel enumeration.
+static const char* g_kernelEntryPoints[] =
+{
+    "ScanGroups",
+    "AddGroupSums",
+    "RadixCount",
+    "RadixScatter",
+    "CompactFlags",
+    "CompactScatter",
+};
+
+/*
+Compute kernels in HLSL (Shader Model 5.0). All kernels process one element per thread.
+The scan kernels compute an exclusive prefix sum in three steps (scan of each thread group, scan of the group sums, and addition of the scanned group sums),
+where the group sums of each level are stored behind the previous level in the same scan buffer.
+The radix sort sorts 4 bits per pass: RadixCount writes the digit histograms of all thread groups (in digit-major order) into the scan buffer,
+and after the histograms have been scanned, RadixScatter sorts each thread group locally with four stable 1-bit splits and writes the elements to their global positions.
+*/
+static const char* g_computePrimitivesHLSL = R"(
+#define RADIX_SIZE 16
+
+cbuffer Constants : register(b0)
+{
+    uint numElements;
+    uint dataOffset;
+    uint sumsOffset;
+    uint numGroups;
+    uint shift;
+    uint hasValues;
+};
+
+RWStructuredBuffer<uint> keysIn     : register(u0);
+RWStructuredBuffer<uint> keysOut    : register(u1);
+RWStructuredBuffer<uint> valuesIn   : register(u2);
+RWStructuredBuffer<uint> valuesOut  : register(u3);
+RWStructuredBuffer<uint> scanData   : register(u4);
+
+groupshared uint sharedSums[GROUP_SIZE];
+groupshared uint sharedKeys[GROUP_SIZE];
+groupshared uint sharedValues[GROUP_SIZE];
+groupshared uint sharedDigits[RADIX_SIZE];
+
+uint GroupInclusiveScan(uint value, uint tid)
+{
+    sharedSums[tid] = value;
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint offset = 1; offset < GROUP_SIZE; offset <<= 1)
+    {
+        uint other = (tid >= offset ? sharedSums[tid - offset] : 0);
+        GroupMemoryBarrierWithGroupSync();
+        sharedSums[tid] += other;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    return sharedSums[tid];
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void ScanGroups(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint tid = threadID.x;
+    uint i = groupID.x * GROUP_SIZE + tid;
+
+    uint value = (i < numElements ? scanData[dataOffset + i] : 0);
+    uint sum = GroupInclusiveScan(value, tid);
+
+    if (i < numElements)
+        scanData[dataOffset + i] = sum - value;
+    if (tid == GROUP_SIZE - 1)
+        scanData[sumsOffset + groupID.x] = sum;
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void AddGroupSums(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint i = groupID.x * GROUP_SIZE + threadID.x;
+    if (i < numElements)
+        scanData[dataOffset + i] += scanData[sumsOffset + groupID.x];
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void RadixCount(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint tid = threadID.x;
+    uint i = groupID.x * GROUP_SIZE + tid;
+
+    if (tid < RADIX_SIZE)
+        sharedDigits[tid] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (i < numElements)
+        InterlockedAdd(sharedDigits[(keysIn[i] >> shift) & (RADIX_SIZE - 1)], 1);
+    GroupMemoryBarrierWithGroupSync();
+
+    if (tid < RADIX_SIZE)
+        scanData[tid * numGroups + groupID.x] = sharedDigits[tid];
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void RadixScatter(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint tid = threadID.x;
+    uint i = groupID.x * GROUP_SIZE + tid;
+
+    // Elements behind the end have the highest digit, so they are sorted behind all valid elements of the thread group
+    uint key = (i < numElements ? keysIn[i] : 0xFFFFFFFF);
+    uint value = (i < numElements && hasValues != 0 ? valuesIn[i] : 0);
+
+    // Sort the elements of this thread group by their digit with four stable 1-bit splits
+    for (uint bit = 0; bit < 4; ++bit)
+    {
+        uint isZero = 1 - ((key >> (shift + bit)) & 1);
+        uint zerosBefore = GroupInclusiveScan(isZero, tid) - isZero;
+        uint numZeros = sharedSums[GROUP_SIZE - 1];
+        uint pos = (isZero != 0 ? zerosBefore : numZeros + tid - zerosBefore);
+
+        sharedKeys[pos] = key;
+        sharedValues[pos] = value;
+        GroupMemoryBarrierWithGroupSync();
+
+        key = sharedKeys[tid];
+        value = sharedValues[tid];
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    // Determine the first position of each digit within the sorted thread group
+    uint digit = (key >> shift) & (RADIX_SIZE - 1);
+    sharedSums[tid] = digit;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (tid == 0 || sharedSums[max(tid, 1) - 1] != digit)
+        sharedDigits[digit] = tid;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (i < numElements)
+    {
+        uint pos = scanData[digit * numGroups + groupID.x] + tid - sharedDigits[digit];
+        keysOut[pos] = key;
+        if (hasValues != 0)
+            valuesOut[pos] = value;
+    }
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void CompactFlags(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint i = groupID.x * GROUP_SIZE + threadID.x;
+    if (i < numElements)
+        scanData[i] = (valuesIn[i] != 0 ? 1 : 0);
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void CompactScatter(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+{
+    uint i = groupID.x * GROUP_SIZE + threadID.x;
+    if (i < numElements)
+    {
+        uint pos = scanData[i];
+        uint flag = (valuesIn[i] != 0 ? 1 : 0);
+
+        if (flag != 0)
+            keysOut[pos] = keysIn[i];
+
+        // Last thread writes the number of selected elements behind the prefix sums
+        if (i == numElements - 1)
+            scanData[numElements] = pos + flag;
+    }
+}
+)";
+
+// Same compute kernels in GLSL (version 4.30), where the kernel is selected with the KERNEL macro.
+static const char* g_computePrimitivesGLSL = R"(#version 430 core
+
+#define RADIX_SIZE 16u
+
+layout(local_size_x = GROUP_SIZE) in;
+
+layout(std140, binding = 0) uniform Constants
+{
+    uint numElements;
+    uint dataOffset;
+    uint sumsOffset;
+    uint numGroups;
+    uint shift;
+    uint hasValues;
+};
+
+layout(std430, binding = 0) buffer KeysIn    { uint keysIn[];    };
+layout(std430, binding = 1) buffer KeysOut   { uint keysOut[];   };
+layout(std430, binding = 2) buffer ValuesIn  { uint valuesIn[];  };
+layout(std430, binding = 3) buffer ValuesOut { uint valuesOut[]; };
+layout(std430, binding = 4) buffer ScanData  { uint scanData[];  };
+
+const uint groupSize = uint(GROUP_SIZE);
+
+shared uint sharedSums[GROUP_SIZE];
+shared uint sharedKeys[GROUP_SIZE];
+shared uint sharedValues[GROUP_SIZE];
+shared uint sharedDigits[RADIX_SIZE];
+
+void GroupSync()
+{
+    memoryBarrierShared();
+    barrier();
+}
+
+uint GroupInclusiveScan(uint value, uint tid)
+{
+    sharedSums[tid] = value;
+    GroupSync();
+
+    for (uint offset = 1u; offset < groupSize; offset <<= 1u)
+    {
+        uint other = (tid >= offset ? sharedSums[tid - offset] : 0u);
+        GroupSync();
+        sharedSums[tid] += other;
+        GroupSync();
+    }
+
+    return sharedSums[tid];
+}
+
+void main()
+{
+    uint tid = gl_LocalInvocationID.x;
+    uint group = gl_WorkGroupID.x;
+    uint i = group * groupSize + tid;
+
+    #if KERNEL == 0 // ScanGroups
+
+    uint value = (i < numElements ? scanData[dataOffset + i] : 0u);
+    uint sum = GroupInclusiveScan(value, tid);
+
+    if (i < numElements)
+        scanData[dataOffset + i] = sum - value;
+    if (tid == groupSize - 1u)
+        scanData[sumsOffset + group] = sum;
+
+    #elif KERNEL == 1 // AddGroupSums
+
+    if (i < numElements)
+        scanData[dataOffset + i] += scanData[sumsOffset + group];
+
+    #elif KERNEL == 2 // RadixCount
+
+    if (tid < RADIX_SIZE)
+        sharedDigits[tid] = 0u;
+    GroupSync();
+
+    if (i < numElements)
+        atomicAdd(sharedDigits[(keysIn[i] >> shift) & (RADIX_SIZE - 1u)], 1u);
+    GroupSync();
+
+    if (tid < RADIX_SIZE)
+        scanData[tid * numGroups + group] = sharedDigits[tid];
+
+    #elif KERNEL == 3 // RadixScatter
+
+    // Elements behind the end have the highest digit, so they are sorted behind all valid elements of the thread group
+    uint key = (i < numElements ? keysIn[i] : 0xFFFFFFFFu);
+    uint value = (i < numElements && hasValues != 0u ? valuesIn[i] : 0u);
+
+    // Sort the elements of this thread group by their digit with four stable 1-bit splits
+    for (uint bit = 0u; bit < 4u; ++bit)
+    {
+        uint isZero = 1u - ((key >> (shift + bit)) & 1u);
+        uint zerosBefore = GroupInclusiveScan(isZero, tid) - isZero;
+        uint numZeros = sharedSums[groupSize - 1u];
+        uint pos = (isZero != 0u ? zerosBefore : numZeros + tid - zerosBefore);
+
+        sharedKeys[pos] = key;
+        sharedValues[pos] = value;
+        GroupSync();
+
+        key = sharedKeys[tid];
+        value = sharedValues[tid];
+        GroupSync();
+    }
+
+    // Determine the first position of each digit within the sorted thread group
+    uint digit = (key >> shift) & (RADIX_SIZE - 1u);
+    sharedSums[tid] = digit;
+    GroupSync();
+
+    if (tid == 0u || sharedSums[tid - 1u] != digit)
+        sharedDigits[digit] = tid;
+    GroupSync();
+
+    if (i < numElements)
+    {
+        uint pos = scanData[digit * numGroups + group] + tid - sharedDigits[digit];
+        keysOut[pos] = key;
+        if (hasValues != 0u)
+            valuesOut[pos] = value;
+    }
+
+    #elif KERNEL == 4 // CompactFlags
+
+    if (i < numElements)
+        scanData[i] = (valuesIn[i] != 0u ? 1u : 0u);
+
+    #elif KERNEL == 5 // CompactScatter
+
+    if (i < numElements)
+    {
+        uint pos = scanData[i];
+        uint flag = (valuesIn[i] != 0u ? 1u : 0u);
+
+        if (flag != 0u)
+            keysOut[pos] = keysIn[i];
+
+        // Last thread writes the number of selected elements behind the prefix sums
+        if (i == numElements - 1u)
+            scanData[numElements] = pos + flag;
+    }
+
+    #endif
+}
+)";
+
+// Returns the number of threads per wave for the specified vendor name.
+static std::uint32_t GetVendorWaveSize(const std::string& vendorName)
+{
+    auto contains = [&vendorName](const char* s)
+    {
+        return (vendorName.find(s) != std::string::npos);
+    };
+
+    if (contains("NVIDIA"))
+        return 32;
+    if (contains("AMD") || contains("Advanced Micro Devices") || contains("ATI"))
+        return 64;
+    if (contains("Intel"))
+        return 16;
+
+    return 32;
+}
+
+ComputePrimitives::ComputePrimitives(RenderSystem& renderSystem, const ComputePrimitivesDescriptor& desc) :
+    renderSystem_   { renderSystem        },
+    maxNumElements_ { desc.maxNumElements }
+{
+    /* Derive thread group size from the wave size, i.e. four waves per thread group but at least 64 and at most 256 threads */
+    auto waveSize = desc.waveSize;
+    if (waveSize == 0)
+    {
+        /* Prefer subgroup size reported by the renderer over the vendor heuristic */
+        waveSize = renderSystem_.GetRenderingCaps().limits.maxSubgroupSize;
+        if (waveSize == 0)
+            waveSize = GetVendorWaveSize(renderSystem_.GetRendererInfo().vendorName);
+    }
+    threadGroupSize_ = std::max(64u, std::min(256u, waveSize * 4));
+
+    if (desc.maxNumElements == 0)
+        throw std::invalid_argument("cannot create compute primitives with zero elements");
+
+    const auto limit = static_cast<std::uint64_t>(g_maxNumGroups) * threadGroupSize_;
+    if (desc.maxNumElements > limit)
+    {
+        throw std::invalid_argument(
+            "maximum number of elements for compute primitives exceeds limit (" +
+            std::to_string(desc.maxNumElements) + " specified, but limit is " + std::to_string(limit) + ")"
+        );
+    }
+
+    if (!renderSystem_.GetRenderingCaps().features.hasComputeShaders)
+        throw std::runtime_error("cannot create compute primitives for renderer without compute shaders");
+
+    CreateStorageBuffers();
+    CreateKernels();
+    CreateResourceHeaps();
+}
+
+ComputePrimitives::~ComputePrimitives()
+{
+    for (auto resourceHeap : resourceHeaps_)
+    {
+        if (resourceHeap)
+            renderSystem_.Release(*resourceHeap);
+    }
+    for (auto pipeline : pipelines_)
+    {
+        if (pipeline)
+            renderSystem_.Release(*pipeline);
+    }
+    if (pipelineLayout_)
+        renderSystem_.Release(*pipelineLayout_);
+    for (auto shaderProgram : shaderPrograms_)
+        renderSystem_.Release(*shaderProgram);
+    for (auto shader : shaders_)
+        renderSystem_.Release(*shader);
+    for (auto buffer : { keyBuffers_[0], keyBuffers_[1], valueBuffers_[0], valueBuffers_[1], scanBuffer_ })
+    {
+        if (buffer)
+            renderSystem_.Release(*buffer);
+    }
+}
+
+void ComputePrimitives::PrefixSum(CommandBuffer& commandBuffer, Buffer& dstBuffer, Buffer& srcBuffer, std::uint32_t numElements)
+{
+    AssertNumElements(numElements);
+    if (numElements == 0)
+        return;
+
+    const auto size = numElements * sizeof(std::uint32_t);
+
+    commandBuffer.CopyBuffer(*scanBuffer_, 0, srcBuffer, 0, size);
+    ScanLevel(commandBuffer, 0, numElements);
+    commandBuffer.CopyBuffer(dstBuffer, 0, *scanBuffer_, 0, size);
+}
+
+void ComputePrimitives::RadixSort(CommandBuffer& commandBuffer, Buffer& keyBuffer, std::uint32_t numElements, std::uint32_t numKeyBits)
+{
+    AssertNumElements(numElements);
+    if (numElements == 0)
+        return;
+
+    const auto size = numElements * sizeof(std::uint32_t);
+
+    commandBuffer.CopyBuffer(*keyBuffers_[0], 0, keyBuffer, 0, size);
+    SortPasses(commandBuffer, numElements, numKeyBits, false);
+    commandBuffer.CopyBuffer(keyBuffer, 0, *keyBuffers_[0], 0, size);
+}
+
+void ComputePrimitives::RadixSort(CommandBuffer& commandBuffer, Buffer& keyBuffer, Buffer& valueBuffer, std::uint32_t numElements, std::uint32_t numKeyBits)
+{
+    AssertNumElements(numElements);
+    if (numElements == 0)
+        return;
+
+    const auto size = numElements * sizeof(std::uint32_t);
+
+    commandBuffer.CopyBuffer(*keyBuffers_[0], 0, keyBuffer, 0, size);
+    commandBuffer.CopyBuffer(*valueBuffers_[0], 0, valueBuffer, 0, size);
+    SortPasses(commandBuffer, numElements, numKeyBits, true);
+    commandBuffer.CopyBuffer(keyBuffer, 0, *keyBuffers_[0], 0, size);
+    commandBuffer.CopyBuffer(valueBuffer, 0, *valueBuffers_[0], 0, size);
+}
+
+void ComputePrimitives::Compact(
+    CommandBuffer&  commandBuffer,
+    Buffer&         dstBuffer,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    Buffer&         srcBuffer,
+    Buffer&         flagBuffer,
+    std::uint32_t   numElements)
+{
+    AssertNumElements(numElements);
+
+    if (numElements == 0)
+    {
+        commandBuffer.FillBuffer(countBuffer, countOffset, sizeof(std::uint32_t), 0);
+        return;
+    }
+
+    const auto size = numElements * sizeof(std::uint32_t);
+
+    commandBuffer.CopyBuffer(*keyBuffers_[0], 0, srcBuffer, 0, size);
+    commandBuffer.CopyBuffer(*valueBuffers_[0], 0, flagBuffer, 0, size);
+
+    /* Scan the selection flags to get the destination of each selected element */
+    KernelConstants constants;
+    constants.numElements = numElements;
+
+    Dispatch(commandBuffer, Kernel_CompactFlags, constants);
+    ScanLevel(commandBuffer, 0, numElements);
+    Dispatch(commandBuffer, Kernel_CompactScatter, constants);
+
+    /* Copy selected elements and their number, which is stored behind the prefix sums */
+    commandBuffer.CopyBuffer(dstBuffer, 0, *keyBuffers_[1], 0, size);
+    commandBuffer.CopyBuffer(countBuffer, countOffset, *scanBuffer_, size, sizeof(std::uint32_t));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ComputePrimitives::CreateStorageBuffers()
+{
+    /* First level of the scan buffer must hold either the digit histograms of all thread groups or all elements plus the compaction count */
+    const auto numLevel0Elements = std::max(maxNumElements_ + 1, g_radixSize * GetNumGroups(maxNumElements_));
+
+    /* Append levels for the group sums until a level has only a single element */
+    std::uint32_t numScanElements = 0;
+    for (auto numLevelElements = numLevel0Elements;; numLevelElements = GetNumGroups(numLevelElements))
+    {
+        scanLevelOffsets_.push_back(numScanElements);
+        numScanElements += numLevelElements;
+        if (numLevelElements == 1)
+            break;
+    }
+
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                         = BufferType::Storage;
+        bufferDesc.size                         = maxNumElements_ * sizeof(std::uint32_t);
+        bufferDesc.storageBuffer.storageType    = StorageBufferType::RWStructuredBuffer;
+        bufferDesc.storageBuffer.stride         = sizeof(std::uint32_t);
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        keyBuffers_[i]      = renderSystem_.CreateBuffer(bufferDesc);
+        valueBuffers_[i]    = renderSystem_.CreateBuffer(bufferDesc);
+    }
+
+    bufferDesc.size = numScanElements * sizeof(std::uint32_t);
+    scanBuffer_ = renderSystem_.CreateBuffer(bufferDesc);
+}
+
+void ComputePrimitives::CreateKernels()
+{
+    const auto& languages = renderSystem_.GetRenderingCaps().shadingLanguages;
+
+    auto hasLanguage = [&languages](const ShadingLanguage language)
+    {
+        return (std::find(languages.begin(), languages.end(), language) != languages.end());
+    };
+
+    const bool isHLSL = hasLanguage(ShadingLanguage::HLSL);
+    if (!isHLSL && !hasLanguage(ShadingLanguage::GLSL))
+        throw std::runtime_error("cannot create compute primitives for renderer without HLSL or GLSL support");
+
+    /* Create pipeline layout with all storage buffers and the kernel constants */
+    PipelineLayoutDescriptor layoutDesc;
+    {
+        for (std::uint32_t slot = 0; slot < 5; ++slot)
+            layoutDesc.bindings.push_back(BindingDescriptor{ ResourceType::StorageBuffer, StageFlags::ComputeStage, slot });
+        layoutDesc.constants.size       = sizeof(KernelConstants);
+        layoutDesc.constants.stageFlags = StageFlags::ComputeStage;
+    }
+    pipelineLayout_ = renderSystem_.CreatePipelineLayout(layoutDesc);
+
+    /* Compile kernels with the thread group size (and the kernel index for GLSL) as macros */
+    for (int kernel = 0; kernel < Kernel_Num; ++kernel)
+    {
+        ShaderDescriptor shaderDesc;
+        {
+            shaderDesc.type         = ShaderType::Compute;
+            shaderDesc.sourceType   = ShaderSourceType::CodeString;
+            shaderDesc.specializationConstants =
+            {
+                ShaderSpecializationConstant{ 0, "GROUP_SIZE", static_cast<std::int32_t>(threadGroupSize_) },
+                ShaderSpecializationConstant{ 1, "KERNEL",     static_cast<std::int32_t>(kernel)           },
+            };
+            if (isHLSL)
+            {
+                shaderDesc.source       = g_computePrimitivesHLSL;
+                shaderDesc.entryPoint   = g_kernelEntryPoints[kernel];
+                shaderDesc.profile      = "cs_5_0";
+            }
+            else
+                shaderDesc.source       = g_computePrimitivesGLSL;
+        }
+        auto shader = renderSystem_.CreateShader(shaderDesc);
+        shaders_.push_back(shader);
+
+        if (shader->HasErrors())
+            throw std::runtime_error("failed to compile compute primitives kernel '" + std::string(g_kernelEntryPoints[kernel]) + "':\n" + shader->QueryInfoLog());
+
+        ShaderProgramDescriptor shaderProgramDesc;
+        {
+            shaderProgramDesc.computeShader = shader;
+        }
+        auto shaderProgram = renderSystem_.CreateShaderProgram(shaderProgramDesc);
+        shaderPrograms_.push_back(shaderProgram);
+
+        if (shaderProgram->HasErrors())
+            throw std::runtime_error("failed to link compute primitives kernel '" + std::string(g_kernelEntryPoints[kernel]) + "':\n" + shaderProgram->QueryInfoLog());
+
+        pipelines_[kernel] = renderSystem_.CreateComputePipeline(ComputePipelineDescriptor{ shaderProgram, pipelineLayout_ });
+    }
+}
+
+void ComputePrimitives::CreateResourceHeaps()
+{
+    /* Create one resource heap for each direction of the ping-pong buffers */
+    for (int i = 0; i < 2; ++i)
+    {
+        ResourceHeapDescriptor heapDesc;
+        {
+            heapDesc.pipelineLayout = pipelineLayout_;
+            heapDesc.resourceViews  =
+            {
+                keyBuffers_[i],
+                keyBuffers_[1 - i],
+                valueBuffers_[i],
+                valueBuffers_[1 - i],
+                scanBuffer_,
+            };
+        }
+        resourceHeaps_[i] = renderSystem_.CreateResourceHeap(heapDesc);
+    }
+}
+
+void ComputePrimitives::AssertNumElements(std::uint32_t numElements) const
+{
+    if (numElements > maxNumElements_)
+    {
+        throw std::out_of_range(
+            "number of elements for compute primitives (" + std::to_string(numElements) +
+            ") exceeds maximum (" + std::to_string(maxNumElements_) + ")"
+        );
+    }
+}
+
+std::uint32_t ComputePrimitives::GetNumGroups(std::uint32_t numElements) const
+{
+    return (numElements + threadGroupSize_ - 1) / threadGroupSize_;
+}
+
+void ComputePrimitives::Dispatch(CommandBuffer& commandBuffer, Kernel kernel, const KernelConstants& constants, std::uint32_t pingPong)
+{
+    commandBuffer.SetComputePipeline(*pipelines_[kernel]);
+    commandBuffer.SetComputeResourceHeap(*resourceHeaps_[pingPong]);
+    commandBuffer.SetConstants(StageFlags::ComputeStage, 0, sizeof(constants), &constants);
+    commandBuffer.Dispatch(GetNumGroups(constants.numElements), 1, 1);
+
+    /* Each kernel reads the output of the previous one, so make the results visible to the next pass and the final copies */
+    commandBuffer.DispatchBarrier();
+}
+
+void ComputePrimitives::ScanLevel(CommandBuffer& commandBuffer, std::uint32_t level, std::uint32_t numElements)
+{
+    KernelConstants constants;
+    {
+        constants.numElements   = numElements;
+        constants.dataOffset    = scanLevelOffsets_[level];
+        constants.sumsOffset    = scanLevelOffsets_[level + 1];
+    }
+    Dispatch(commandBuffer, Kernel_ScanGroups, constants);
+
+    /* Scan the group sums on the next level and add them to this level if there is more than one thread group */
+    const auto numGroups = GetNumGroups(numElements);
+    if (numGroups > 1)
+    {
+        ScanLevel(commandBuffer, level + 1, numGroups);
+        Dispatch(commandBuffer, Kernel_AddGroupSums, constants);
+    }
+}
+
+void ComputePrimitives::SortPasses(CommandBuffer& commandBuffer, std::uint32_t numElements, std::uint32_t numKeyBits, bool hasValues)
+{
+    if (numKeyBits == 0 || numKeyBits > 32)
+        throw std::out_of_range("number of key bits for radix sort must be in the range [1, 32], but " + std::to_string(numKeyBits) + " was specified");
+
+    const auto numGroups = GetNumGroups(numElements);
+    const auto numPasses = (numKeyBits + g_radixBits - 1) / g_radixBits;
+
+    KernelConstants constants;
+    {
+        constants.numElements   = numElements;
+        constants.numGroups     = numGroups;
+        constants.hasValues     = (hasValues ? 1 : 0);
+    }
+
+    for (std::uint32_t pass = 0; pass < numPasses; ++pass)
+    {
+        constants.shift = pass * g_radixBits;
+
+        /* Count digits of each thread group, scan the digit histograms, and scatter elements to their sorted positions */
+        Dispatch(commandBuffer, Kernel_RadixCount, constants, pass % 2);
+        ScanLevel(commandBuffer, 0, g_radixSize * numGroups);
+        Dispatch(commandBuffer, Kernel_RadixScatter, constants, pass % 2);
+    }
+
+    /* Sorted elements must end up in the first buffers */
+    if (numPasses % 2 != 0)
+    {
+        const auto size = numElements * sizeof(std::uint32_t);
+        commandBuffer.CopyBuffer(*keyBuffers_[0], 0, *keyBuffers_[1], 0, size);
+        if (hasValues)
+            commandBuffer.CopyBuffer(*valueBuffers_[0], 0, *valueBuffers_[1], 0, size);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
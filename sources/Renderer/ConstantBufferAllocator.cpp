@@ -0,0 +1,96 @@
+/*
+ * ConstantBufferAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ConstantBufferAllocator.h>
+#include <LLGL/RenderSystem.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+ConstantBufferAllocator::ConstantBufferAllocator(RenderSystem& renderSystem, const ConstantBufferAllocatorDescriptor& desc) :
+    renderSystem_ { renderSystem }
+{
+    if (desc.size == 0)
+        throw std::invalid_argument("cannot create constant buffer allocator with zero size");
+
+    /* Align all ranges to the constant buffer offset alignment (at least one 16-byte shader constant) */
+    alignment_ = std::max<std::uint64_t>(renderSystem_.GetRenderingCaps().limits.constantBufferOffsetAlignment, 16u);
+
+    /* Create dynamic constant buffer, which is written at most once per flush */
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type     = BufferType::Constant;
+        bufferDesc.size     = desc.size;
+        bufferDesc.flags    = BufferFlags::DynamicUsage;
+    }
+    buffer_ = renderSystem_.CreateBuffer(bufferDesc);
+
+    shadow_.resize(static_cast<std::size_t>(desc.size));
+}
+
+ConstantBufferAllocator::~ConstantBufferAllocator()
+{
+    renderSystem_.Release(*buffer_);
+}
+
+ConstantBufferRange ConstantBufferAllocator::Allocate(const void* data, std::uint64_t dataSize)
+{
+    /* Round size up to the alignment, so the next range is aligned as well */
+    ConstantBufferRange range;
+    {
+        range.offset    = offset_;
+        range.size      = (dataSize + alignment_ - 1) / alignment_ * alignment_;
+    }
+
+    if (range.size > shadow_.size() - range.offset)
+    {
+        throw std::out_of_range(
+            "constant buffer allocator out of memory (" + std::to_string(range.size) + " bytes requested but only " +
+            std::to_string(shadow_.size() - range.offset) + " bytes left)"
+        );
+    }
+
+    if (data != nullptr)
+        ::memcpy(&shadow_[static_cast<std::size_t>(range.offset)], data, static_cast<std::size_t>(dataSize));
+
+    offset_ += range.size;
+
+    return range;
+}
+
+void ConstantBufferAllocator::Flush()
+{
+    if (flushedOffset_ < offset_)
+    {
+        renderSystem_.WriteBuffer(
+            *buffer_,
+            &shadow_[static_cast<std::size_t>(flushedOffset_)],
+            static_cast<std::size_t>(offset_ - flushedOffset_),
+            static_cast<std::size_t>(flushedOffset_)
+        );
+        flushedOffset_ = offset_;
+    }
+}
+
+void ConstantBufferAllocator::Reset()
+{
+    offset_         = 0;
+    flushedOffset_  = 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
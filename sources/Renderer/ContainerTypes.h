@@ -9,8 +9,12 @@
 #define LLGL_CONTAINER_TYPES_H
 
 
-#include <set>
 #include <memory>
+#include <vector>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace LLGL
@@ -20,8 +24,207 @@ namespace LLGL
 template <typename T>
 using HWObjectInstance = std::unique_ptr<T>;
 
+/*
+Container for the hardware objects of a render system with O(1) insertion and removal.
+All objects are stored densely in a contiguous array, and removed objects are replaced by the last object (i.e. the order is not preserved).
+The position of each object within that array is looked up by its address in a flat hash table with linear probing,
+so neither insertion nor removal requires an allocation (except for amortized growth of the arrays).
+Insertion and removal are guarded by a mutex per container, so objects of different types can be created and released concurrently without contention.
+Iterating the container is not synchronized and must only be done when no other thread modifies it (e.g. on shutdown).
+*/
 template <typename T>
-using HWObjectContainer = std::set<HWObjectInstance<T>>;
+class HWObjectContainer
+{
+
+    public:
+
+        using iterator          = typename std::vector<HWObjectInstance<T>>::iterator;
+        using const_iterator    = typename std::vector<HWObjectInstance<T>>::const_iterator;
+
+        HWObjectContainer() = default;
+
+        HWObjectContainer(const HWObjectContainer&) = delete;
+        HWObjectContainer& operator = (const HWObjectContainer&) = delete;
+
+        // Takes ownership of the specified object and returns its raw pointer. Null pointers are not stored.
+        template <typename TSub>
+        TSub* Insert(std::unique_ptr<TSub>&& object)
+        {
+            auto ref = object.get();
+            if (ref != nullptr)
+            {
+                std::lock_guard<std::mutex> guard { mutex_ };
+                if ((objects_.size() + 1) * 2 > slots_.size())
+                    Rehash(slots_.empty() ? 16u : slots_.size() * 2);
+                objects_.emplace_back(std::move(object));
+                InsertSlot(ref, objects_.size() - 1);
+            }
+            return ref;
+        }
+
+        // Removes the specified object from this container and returns its ownership. Returns null if the object is not owned by this container.
+        HWObjectInstance<T> Take(const T* object)
+        {
+            if (object == nullptr)
+                return nullptr;
+
+            std::lock_guard<std::mutex> guard { mutex_ };
+            if (slots_.empty())
+                return nullptr;
+
+            /* Find slot of the specified object */
+            auto i = FindSlot(object);
+            if (slots_[i].object == nullptr)
+                return nullptr;
+
+            /* Move last object into the place of the removed object */
+            const auto index = slots_[i].index;
+            HWObjectInstance<T> removed = std::move(objects_[index]);
+
+            if (index + 1 < objects_.size())
+            {
+                objects_[index] = std::move(objects_.back());
+                slots_[FindSlot(objects_[index].get())].index = index;
+            }
+            objects_.pop_back();
+
+            EraseSlot(i);
+            return removed;
+        }
+
+        // Removes and destroys the specified object. Returns false if the object is not owned by this container.
+        bool Remove(const T* object)
+        {
+            /* Keep ownership until the container is consistent, since the destructor might access other objects */
+            auto removed = Take(object);
+            return (removed != nullptr);
+        }
+
+        // Destroys all objects in the order they were inserted (unless objects have been removed in the meantime).
+        void clear()
+        {
+            /* Destroy objects outside the lock, since their destructors might release other objects of this container */
+            std::vector<HWObjectInstance<T>> objects;
+            {
+                std::lock_guard<std::mutex> guard { mutex_ };
+                objects.swap(objects_);
+                for (auto& slot : slots_)
+                    slot.object = nullptr;
+            }
+            for (auto& obj : objects)
+                obj.reset();
+        }
+
+        inline bool empty() const
+        {
+            return objects_.empty();
+        }
+
+        inline std::size_t size() const
+        {
+            return objects_.size();
+        }
+
+        inline iterator begin()
+        {
+            return objects_.begin();
+        }
+
+        inline iterator end()
+        {
+            return objects_.end();
+        }
+
+        inline const_iterator begin() const
+        {
+            return objects_.begin();
+        }
+
+        inline const_iterator end() const
+        {
+            return objects_.end();
+        }
+
+    private:
+
+        struct Slot
+        {
+            const T*    object  = nullptr;
+            std::size_t index   = 0;
+        };
+
+        // Returns the preferred slot of the specified object (Fibonacci hashing of its address).
+        std::size_t HomeSlot(const T* object) const
+        {
+            const auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(object)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(hash >> (64u - slotBits_));
+        }
+
+        // Returns the slot of the specified object, or the empty slot where it would be inserted.
+        std::size_t FindSlot(const T* object) const
+        {
+            const auto mask = slots_.size() - 1;
+            auto i = HomeSlot(object);
+            while (slots_[i].object != nullptr && slots_[i].object != object)
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        void InsertSlot(const T* object, std::size_t index)
+        {
+            auto& slot = slots_[FindSlot(object)];
+            slot.object = object;
+            slot.index  = index;
+        }
+
+        // Clears the specified slot and shifts the following entries of its cluster back (no tombstones are required).
+        void EraseSlot(std::size_t i)
+        {
+            const auto mask = slots_.size() - 1;
+            for (auto j = (i + 1) & mask; slots_[j].object != nullptr; j = (j + 1) & mask)
+            {
+                /* Move entry into the free slot if its preferred slot is not cyclically within (i, j] */
+                const auto k = HomeSlot(slots_[j].object);
+                if (i <= j ? (k <= i || k > j) : (k <= i && k > j))
+                {
+                    slots_[i] = slots_[j];
+                    i = j;
+                }
+            }
+            slots_[i].object = nullptr;
+        }
+
+        // Rebuilds the hash table with the specified number of slots (must be a power of two).
+        void Rehash(std::size_t numSlots)
+        {
+            slots_.assign(numSlots, Slot{});
+            for (slotBits_ = 0; (std::size_t(1) << slotBits_) < numSlots; ++slotBits_);
+            for (std::size_t i = 0; i < objects_.size(); ++i)
+                InsertSlot(objects_[i].get(), i);
+        }
+
+    private:
+
+        std::vector<HWObjectInstance<T>>    objects_;
+        std::vector<Slot>                   slots_;
+        unsigned                            slotBits_   = 0;
+        std::mutex                          mutex_;
+
+};
+
+template <typename BaseType, typename SubType>
+SubType* TakeOwnership(HWObjectContainer<BaseType>& objectSet, std::unique_ptr<SubType>&& object)
+{
+    return objectSet.Insert(std::forward<std::unique_ptr<SubType>>(object));
+}
+
+// Removes the specified entry from the container. The entry must be null or refer to an object of type T (or a sub type).
+template <typename T, typename TBase>
+void RemoveFromUniqueSet(HWObjectContainer<T>& cont, const TBase* entry)
+{
+    if (entry)
+        cont.Remove(static_cast<const T*>(entry));
+}
 
 
 } // /namespace LLGL
@@ -10,10 +10,12 @@
 #include "../../Core/Helper.h"
 #include "../../Core/HelperMacros.h"
 #include "../../Core/Vendor.h"
+#include "../ShaderSpecialization.h"
 #include <LLGL/Shader.h>
 #include <stdexcept>
 #include <algorithm>
 #include <d3dcompiler.h>
+#include <dxgi1_4.h>
 
 
 namespace LLGL
@@ -180,9 +182,9 @@ static std::vector<ShadingLanguage> DXGetHLSLVersions(D3D_FEATURE_LEVEL featureL
     return languages;
 }
 
-static std::vector<Format> DXGetSupportedTextureFormats()
+static std::vector<Format> DXGetSupportedTextureFormats(D3D_FEATURE_LEVEL featureLevel)
 {
-    return
+    std::vector<Format> textureFormats
     {
         Format::R8UNorm,
         Format::R8SNorm,
@@ -223,6 +225,9 @@ static std::vector<Format> DXGetSupportedTextureFormats()
         Format::RGBA32UInt,
         Format::RGBA32SInt,
         Format::RGBA32Float,
+        Format::RGB10A2UNorm,
+        Format::RGB10A2UInt,
+        Format::RG11B10Float,
         Format::D16UNorm,
         Format::D32Float,
         Format::D24UNormS8UInt,
@@ -230,7 +235,28 @@ static std::vector<Format> DXGetSupportedTextureFormats()
         Format::BC1RGBA,
         Format::BC2RGBA,
         Format::BC3RGBA,
+        Format::BC1RGBAsRGB,
+        Format::BC2RGBAsRGB,
+        Format::BC3RGBAsRGB,
     };
+
+    /* BC4 and BC5 require feature level 10.0, BC6H and BC7 require feature level 11.0 */
+    if (featureLevel >= D3D_FEATURE_LEVEL_10_0)
+    {
+        textureFormats.insert(
+            textureFormats.end(),
+            { Format::BC4RUNorm, Format::BC4RSNorm, Format::BC5RGUNorm, Format::BC5RGSNorm }
+        );
+    }
+    if (featureLevel >= D3D_FEATURE_LEVEL_11_0)
+    {
+        textureFormats.insert(
+            textureFormats.end(),
+            { Format::BC6HRGBUFloat, Format::BC6HRGBSFloat, Format::BC7RGBAUNorm, Format::BC7RGBAsRGB }
+        );
+    }
+
+    return textureFormats;
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/ff476876(v=vs.85).aspx
@@ -242,7 +268,7 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
     caps.screenOrigin                               = ScreenOrigin::UpperLeft;
     caps.clippingRange                              = ClippingRange::ZeroToOne;
     caps.shadingLanguages                           = DXGetHLSLVersions(featureLevel);
-    caps.textureFormats                             = DXGetSupportedTextureFormats();
+    caps.textureFormats                             = DXGetSupportedTextureFormats(featureLevel);
 
     /* Query features */
     caps.features.hasRenderTargets                  = true;
@@ -251,6 +277,7 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
     caps.features.hasArrayTextures                  = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.features.hasCubeArrayTextures              = (featureLevel >= D3D_FEATURE_LEVEL_10_1);
     caps.features.hasMultiSampleTextures            = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
+    caps.features.hasTextureCompressionBC           = (featureLevel >= D3D_FEATURE_LEVEL_11_0);
     caps.features.hasSamplers                       = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.features.hasConstantBuffers                = true;
     caps.features.hasStorageBuffers                 = true;
@@ -260,6 +287,7 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
     caps.features.hasComputeShaders                 = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.features.hasInstancing                     = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.features.hasOffsetInstancing               = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
+    caps.features.hasIndirectDrawing                = (featureLevel >= D3D_FEATURE_LEVEL_11_0);
     caps.features.hasViewportArrays                 = true;
     caps.features.hasStreamOutputs                  = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.features.hasLogicOp                        = (featureLevel >= D3D_FEATURE_LEVEL_11_1);
@@ -374,6 +402,36 @@ UINT DXGetCompilerFlags(int flags)
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607326(v=vs.85).aspx
+void DXGetSpecializationMacros(
+    const std::vector<ShaderSpecializationConstant>&    constants,
+    std::vector<std::string>&                           values,
+    std::vector<D3D_SHADER_MACRO>&                      macros)
+{
+    values.clear();
+    macros.clear();
+
+    /* Convert values first, so the string pointers remain valid */
+    values.reserve(constants.size());
+    for (const auto& constant : constants)
+    {
+        if (constant.name != nullptr && *constant.name != '\0')
+            values.push_back(GetSpecializationConstantLiteral(constant));
+    }
+
+    if (values.empty())
+        return;
+
+    macros.reserve(values.size() + 1);
+    for (const auto& constant : constants)
+    {
+        if (constant.name != nullptr && *constant.name != '\0')
+            macros.push_back({ constant.name, values[macros.size()].c_str() });
+    }
+
+    /* Terminate list with null entry */
+    macros.push_back({ nullptr, nullptr });
+}
+
 UINT DXGetDisassemblerFlags(int flags)
 {
     UINT dxFlags = 0;
@@ -398,6 +456,7 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     videoAdapterDesc.name           = std::wstring(desc.Description);
     videoAdapterDesc.vendor         = GetVendorByID(desc.VendorId);
     videoAdapterDesc.videoMemory    = static_cast<uint64_t>(desc.DedicatedVideoMemory);
+    videoAdapterDesc.luid           = ((static_cast<std::uint64_t>(desc.AdapterLuid.HighPart) << 32) | static_cast<std::uint64_t>(desc.AdapterLuid.LowPart));
 
     /* Enumerate over all adapter outputs */
     for (UINT j = 0; adapter->EnumOutputs(j, &output) != DXGI_ERROR_NOT_FOUND; ++j)
@@ -447,6 +506,73 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     return videoAdapterDesc;
 }
 
+bool DXQueryVideoMemoryStatistics(IDXGIAdapter* adapter, MemoryStatistics& statistics)
+{
+    statistics.heaps.clear();
+
+    /* Video memory budgets are only available since DXGI 1.4 */
+    ComPtr<IDXGIAdapter3> adapter3;
+    if (adapter == nullptr || FAILED(adapter->QueryInterface(IID_PPV_ARGS(&adapter3))))
+        return false;
+
+    DXGI_ADAPTER_DESC desc;
+    adapter->GetDesc(&desc);
+
+    /* Query local (dedicated) and non-local (shared system) memory segment groups */
+    const struct
+    {
+        DXGI_MEMORY_SEGMENT_GROUP   group;
+        bool                        deviceLocal;
+        SIZE_T                      size;
+    }
+    segmentGroups[] =
+    {
+        { DXGI_MEMORY_SEGMENT_GROUP_LOCAL,     true,  desc.DedicatedVideoMemory },
+        { DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL, false, desc.SharedSystemMemory   },
+    };
+
+    for (const auto& segment : segmentGroups)
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO info;
+        if (FAILED(adapter3->QueryVideoMemoryInfo(0, segment.group, &info)))
+            continue;
+
+        /* DXGI only reports the usage of the entire process, so allocated and used bytes are the same */
+        MemoryHeapStatistics heap;
+        {
+            heap.deviceLocal    = segment.deviceLocal;
+            heap.size           = static_cast<std::uint64_t>(segment.size);
+            heap.allocatedBytes = static_cast<std::uint64_t>(info.CurrentUsage);
+            heap.usedBytes      = static_cast<std::uint64_t>(info.CurrentUsage);
+            heap.budget         = static_cast<std::uint64_t>(info.Budget);
+            heap.usage          = static_cast<std::uint64_t>(info.CurrentUsage);
+        }
+        statistics.heaps.push_back(heap);
+    }
+
+    return !statistics.heaps.empty();
+}
+
+UINT DXFindVideoAdapter(const std::vector<VideoAdapterDescriptor>& videoAdapters, const RenderSystemDescriptor& renderSystemDesc)
+{
+    /* Find adapter by LUID first */
+    if (renderSystemDesc.adapterLUID != 0)
+    {
+        for (std::size_t i = 0; i < videoAdapters.size(); ++i)
+        {
+            if (videoAdapters[i].luid == renderSystemDesc.adapterLUID)
+                return static_cast<UINT>(i);
+        }
+        return ~0u;
+    }
+
+    /* Select adapter by index */
+    if (renderSystemDesc.adapterIndex < videoAdapters.size())
+        return renderSystemDesc.adapterIndex;
+
+    return ~0u;
+}
+
 D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
 {
     switch (format)
@@ -485,6 +611,17 @@ D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
         case DXGI_FORMAT_BC1_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8   };
         case DXGI_FORMAT_BC2_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
         case DXGI_FORMAT_BC3_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
+        case DXGI_FORMAT_BC1_UNORM_SRGB:        return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
+        case DXGI_FORMAT_BC2_UNORM_SRGB:        return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
+        case DXGI_FORMAT_BC3_UNORM_SRGB:        return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
+        case DXGI_FORMAT_BC4_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8   };
+        case DXGI_FORMAT_BC4_SNORM:             return { ImageFormat::CompressedRGB,    DataType::Int8    };
+        case DXGI_FORMAT_BC5_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8   };
+        case DXGI_FORMAT_BC5_SNORM:             return { ImageFormat::CompressedRGB,    DataType::Int8    };
+        case DXGI_FORMAT_BC6H_UF16:             return { ImageFormat::CompressedRGB,    DataType::Float16 };
+        case DXGI_FORMAT_BC6H_SF16:             return { ImageFormat::CompressedRGB,    DataType::Float16 };
+        case DXGI_FORMAT_BC7_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
+        case DXGI_FORMAT_BC7_UNORM_SRGB:        return { ImageFormat::CompressedRGBA,   DataType::UInt8   };
         default:                                break;
     }
     throw std::invalid_argument("failed to map hardware texture format into image buffer format");
@@ -551,6 +688,227 @@ DXGI_FORMAT DXPickDepthStencilFormat(int depthBits, int stencilBits)
         return DXGI_FORMAT_D16_UNORM;
 }
 
+DXGI_FORMAT DXGetTypelessFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_R8_SNORM:
+        case DXGI_FORMAT_R8_UINT:
+        case DXGI_FORMAT_R8_SINT:
+            return DXGI_FORMAT_R8_TYPELESS;
+
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R8G8_SNORM:
+        case DXGI_FORMAT_R8G8_UINT:
+        case DXGI_FORMAT_R8G8_SINT:
+            return DXGI_FORMAT_R8G8_TYPELESS;
+
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_R8G8B8A8_SNORM:
+        case DXGI_FORMAT_R8G8B8A8_UINT:
+        case DXGI_FORMAT_R8G8B8A8_SINT:
+            return DXGI_FORMAT_R8G8B8A8_TYPELESS;
+
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            return DXGI_FORMAT_B8G8R8A8_TYPELESS;
+
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+        case DXGI_FORMAT_R10G10B10A2_UINT:
+            return DXGI_FORMAT_R10G10B10A2_TYPELESS;
+
+        case DXGI_FORMAT_R16_UNORM:
+        case DXGI_FORMAT_R16_SNORM:
+        case DXGI_FORMAT_R16_UINT:
+        case DXGI_FORMAT_R16_SINT:
+        case DXGI_FORMAT_R16_FLOAT:
+            return DXGI_FORMAT_R16_TYPELESS;
+
+        case DXGI_FORMAT_R16G16_UNORM:
+        case DXGI_FORMAT_R16G16_SNORM:
+        case DXGI_FORMAT_R16G16_UINT:
+        case DXGI_FORMAT_R16G16_SINT:
+        case DXGI_FORMAT_R16G16_FLOAT:
+            return DXGI_FORMAT_R16G16_TYPELESS;
+
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16G16B16A16_SNORM:
+        case DXGI_FORMAT_R16G16B16A16_UINT:
+        case DXGI_FORMAT_R16G16B16A16_SINT:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            return DXGI_FORMAT_R16G16B16A16_TYPELESS;
+
+        case DXGI_FORMAT_R32_UINT:
+        case DXGI_FORMAT_R32_SINT:
+        case DXGI_FORMAT_R32_FLOAT:
+            return DXGI_FORMAT_R32_TYPELESS;
+
+        case DXGI_FORMAT_R32G32_UINT:
+        case DXGI_FORMAT_R32G32_SINT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+            return DXGI_FORMAT_R32G32_TYPELESS;
+
+        case DXGI_FORMAT_R32G32B32_UINT:
+        case DXGI_FORMAT_R32G32B32_SINT:
+        case DXGI_FORMAT_R32G32B32_FLOAT:
+            return DXGI_FORMAT_R32G32B32_TYPELESS;
+
+        case DXGI_FORMAT_R32G32B32A32_UINT:
+        case DXGI_FORMAT_R32G32B32A32_SINT:
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            return DXGI_FORMAT_R32G32B32A32_TYPELESS;
+
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+            return DXGI_FORMAT_BC1_TYPELESS;
+
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC2_UNORM_SRGB:
+            return DXGI_FORMAT_BC2_TYPELESS;
+
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            return DXGI_FORMAT_BC3_TYPELESS;
+
+        case DXGI_FORMAT_BC4_UNORM:
+        case DXGI_FORMAT_BC4_SNORM:
+            return DXGI_FORMAT_BC4_TYPELESS;
+
+        case DXGI_FORMAT_BC5_UNORM:
+        case DXGI_FORMAT_BC5_SNORM:
+            return DXGI_FORMAT_BC5_TYPELESS;
+
+        case DXGI_FORMAT_BC6H_UF16:
+        case DXGI_FORMAT_BC6H_SF16:
+            return DXGI_FORMAT_BC6H_TYPELESS;
+
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            return DXGI_FORMAT_BC7_TYPELESS;
+
+        default:
+            return format;
+    }
+}
+
+DXGI_FORMAT DXGetDepthStencilViewFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R16_TYPELESS:      return DXGI_FORMAT_D16_UNORM;
+        case DXGI_FORMAT_R32_TYPELESS:      return DXGI_FORMAT_D32_FLOAT;
+        case DXGI_FORMAT_R24G8_TYPELESS:    return DXGI_FORMAT_D24_UNORM_S8_UINT;
+        case DXGI_FORMAT_R32G8X24_TYPELESS: return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+        default:                            return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+DXGI_FORMAT DXGetShaderResourceViewFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R16_TYPELESS:      return DXGI_FORMAT_R16_UNORM;
+        case DXGI_FORMAT_R32_TYPELESS:      return DXGI_FORMAT_R32_FLOAT;
+        case DXGI_FORMAT_R24G8_TYPELESS:    return DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+        case DXGI_FORMAT_R32G8X24_TYPELESS: return DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+        default:                            return format;
+    }
+}
+
+UINT DXGetPresentSyncInterval(const PresentMode presentMode, const VsyncDescriptor& vsyncDesc)
+{
+    switch (presentMode)
+    {
+        case PresentMode::Fifo:
+        case PresentMode::FifoRelaxed:
+            return std::max(1u, std::min(vsyncDesc.interval, 4u));
+        case PresentMode::Mailbox:
+        case PresentMode::Immediate:
+            return 0u;
+        default:
+            return (vsyncDesc.enabled ? std::max(1u, std::min(vsyncDesc.interval, 4u)) : 0u);
+    }
+}
+
+UINT DXGetMaxFrameLatency(std::uint32_t maxFrameLatency, UINT defaultValue)
+{
+    return (maxFrameLatency > 0 ? std::min(maxFrameLatency, 16u) : defaultValue);
+}
+
+// Converts the specified value of the performance counter into nanoseconds.
+static std::uint64_t DXQPCToNanoseconds(LARGE_INTEGER counter)
+{
+    static LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    /* Split conversion into seconds and remainder to avoid an overflow of the 64-bit integer */
+    const auto ticks    = static_cast<std::uint64_t>(counter.QuadPart);
+    const auto freq     = static_cast<std::uint64_t>(frequency.QuadPart);
+    return (ticks / freq) * 1000000000ull + (ticks % freq) * 1000000000ull / freq;
+}
+
+bool DXGetFrameStatistics(IDXGISwapChain* swapChain, FrameStatistics& frameStats)
+{
+    DXGI_FRAME_STATISTICS stats;
+    if (FAILED(swapChain->GetFrameStatistics(&stats)))
+        return false;
+
+    /* The sync QPC time refers to the vertical blank 'SyncRefreshCount', so the present time is estimated by RenderContext::QueryFrameStatistics */
+    frameStats.presentID            = stats.PresentCount;
+    frameStats.presentRefreshCount  = stats.PresentRefreshCount;
+    frameStats.syncRefreshCount     = stats.SyncRefreshCount;
+    frameStats.syncTime             = DXQPCToNanoseconds(stats.SyncQPCTime);
+
+    return true;
+}
+
+
+/*
+ * DXOwnedShaderDescriptor class
+ */
+
+DXOwnedShaderDescriptor::DXOwnedShaderDescriptor(const ShaderDescriptor& desc) :
+    desc_ { desc }
+{
+    /* Copy source code */
+    if (desc.sourceType == ShaderSourceType::CodeFile)
+        source_ = ReadFileString(desc.source);
+    else if (desc.sourceSize > 0)
+        source_ = std::string(desc.source, desc.sourceSize);
+    else
+        source_ = desc.source;
+
+    desc_.source        = source_.c_str();
+    desc_.sourceSize    = source_.size();
+    desc_.sourceType    = ShaderSourceType::CodeString;
+
+    /* Copy strings, but keep null pointers */
+    if (desc.entryPoint != nullptr)
+    {
+        entryPoint_         = desc.entryPoint;
+        desc_.entryPoint    = entryPoint_.c_str();
+    }
+    if (desc.profile != nullptr)
+    {
+        profile_            = desc.profile;
+        desc_.profile       = profile_.c_str();
+    }
+
+    /* Copy names of specialization constants */
+    specializationNames_.reserve(desc.specializationConstants.size());
+    for (auto& constant : desc_.specializationConstants)
+    {
+        if (constant.name != nullptr)
+        {
+            specializationNames_.push_back(constant.name);
+            constant.name = specializationNames_.back().c_str();
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -13,9 +13,13 @@
 #include <LLGL/RenderSystemFlags.h>
 #include <LLGL/VideoAdapter.h>
 #include <LLGL/ImageFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/RenderContextFlags.h>
+#include <LLGL/RenderingStatistics.h>
 #include <dxgi.h>
 #include <string>
 #include <vector>
+#include <cstring>
 #include <Windows.h>
 #include <d3dcommon.h>
 
@@ -34,6 +38,37 @@ struct D3DTextureFormatDescriptor
 };
 
 
+/*
+Shader descriptor that owns its source code and strings, e.g. for asynchronous shader compilation.
+The source file of ShaderSourceType::CodeFile is read on construction, so a missing file throws on the calling thread.
+*/
+class DXOwnedShaderDescriptor
+{
+
+    public:
+
+        DXOwnedShaderDescriptor(const ShaderDescriptor& desc);
+
+        DXOwnedShaderDescriptor(const DXOwnedShaderDescriptor&) = delete;
+        DXOwnedShaderDescriptor& operator = (const DXOwnedShaderDescriptor&) = delete;
+
+        // Returns the shader descriptor with ShaderSourceType::CodeString, whose pointers refer to the strings of this object.
+        inline const ShaderDescriptor& Get() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        std::string                 source_;
+        std::string                 entryPoint_;
+        std::string                 profile_;
+        std::vector<std::string>    specializationNames_;
+        ShaderDescriptor            desc_;
+
+};
+
+
 /* ----- Functions ----- */
 
 // Throws an std::runtime_error exception if 'hr' is not S_OK.
@@ -63,12 +98,25 @@ std::string DXFeatureLevelToShaderModel(D3D_FEATURE_LEVEL featureLevel);
 // Returns the compiler flags for the 'ShaderCompileFlags' enumeration values.
 UINT DXGetCompilerFlags(int flags);
 
+// Fills the null terminated list of shader macros for all named specialization constants. The macro values refer to the strings in 'values'.
+void DXGetSpecializationMacros(
+    const std::vector<ShaderSpecializationConstant>&    constants,
+    std::vector<std::string>&                           values,
+    std::vector<D3D_SHADER_MACRO>&                      macros
+);
+
 // Returns the disassembler flags for the 'ShaderDisassembleFlags' enumeration values.
 UINT DXGetDisassemblerFlags(int flags);
 
 // Returns the video adapter descriptor from the specified DXGI adapter.
 VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter);
 
+// Queries the local and non-local memory segment statistics of the specified DXGI adapter (requires IDXGIAdapter3). Returns false if not supported.
+bool DXQueryVideoMemoryStatistics(IDXGIAdapter* adapter, MemoryStatistics& statistics);
+
+// Returns the index of the video adapter selected by the render system descriptor (by LUID or index), or ~0u to select the default adapter.
+UINT DXFindVideoAdapter(const std::vector<VideoAdapterDescriptor>& videoAdapters, const RenderSystemDescriptor& renderSystemDesc);
+
 // Returns the LLGL format and data type for the specified DXGI format.
 D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format);
 
@@ -78,6 +126,37 @@ Format DXGetSignatureParameterType(D3D_REGISTER_COMPONENT_TYPE componentType, BY
 // Returns a suitable DXGI format for the specified depth-stencil mode.
 DXGI_FORMAT DXPickDepthStencilFormat(int depthBits, int stencilBits);
 
+// Returns the typeless format of the same format family as the specified format, or the input format if there is no typeless format for it.
+DXGI_FORMAT DXGetTypelessFormat(DXGI_FORMAT format);
+
+// Returns the format of a depth-stencil view (DSV) for the typeless format of a depth-stencil texture (see DXTypes::Map), or DXGI_FORMAT_UNKNOWN for any other format.
+DXGI_FORMAT DXGetDepthStencilViewFormat(DXGI_FORMAT format);
+
+// Returns the format of a shader-resource view (SRV) that samples the depth component of a typeless depth-stencil format, or the input format for any other format.
+DXGI_FORMAT DXGetShaderResourceViewFormat(DXGI_FORMAT format);
+
+// Returns the sync interval for IDXGISwapChain::Present for the specified presentation mode and V-sync configuration.
+UINT DXGetPresentSyncInterval(const PresentMode presentMode, const VsyncDescriptor& vsyncDesc);
+
+// Returns the maximum frame latency for IDXGISwapChain2::SetMaximumFrameLatency clamped to the range [1, 16], or the default value if the specified latency is zero.
+UINT DXGetMaxFrameLatency(std::uint32_t maxFrameLatency, UINT defaultValue);
+
+// Queries the frame statistics of the specified swap chain with IDXGISwapChain::GetFrameStatistics. Returns false if they are not available (e.g. for windowed blt-model swap chains).
+bool DXGetFrameStatistics(IDXGISwapChain* swapChain, FrameStatistics& frameStats);
+
+// Sets the debug name of the specified ID3D11DeviceChild or ID3D12Object with WKPDID_D3DDebugObjectName. A null name resets the debug name.
+template <typename T>
+void DXSetObjectName(T* obj, const char* name)
+{
+    if (obj != nullptr)
+    {
+        if (name != nullptr)
+            obj->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(std::strlen(name)), name);
+        else
+            obj->SetPrivateData(WKPDID_D3DDebugObjectName, 0, nullptr);
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,193 @@
+/*
+ * DXShaderCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DXShaderCache.h"
+#include "../../Core/Helper.h"
+#include "../ShaderSpecialization.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <Windows.h>
+#include <d3dcompiler.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Header of each shader cache entry, followed by the byte code.
+struct DXShaderCacheHeader
+{
+    char            magic[4];   // "LLSC"
+    std::uint32_t   version;    // Cache format version, see 'g_shaderCacheVersion'
+    std::uint64_t   key;        // Hash of the shader source and compiler parameters
+    std::uint64_t   size;       // Size of the byte code (in bytes)
+};
+
+static const char           g_shaderCacheMagic[4]   = { 'L', 'L', 'S', 'C' };
+static const std::uint32_t  g_shaderCacheVersion    = 1;
+
+
+/*
+ * Internal functions
+ */
+
+template <typename T>
+static void AccumulateHashValue(std::uint64_t& hash, const T& value)
+{
+    AccumulateHash(hash, &value, sizeof(value));
+}
+
+static std::uint64_t GetShaderCacheKey(const ShaderDescriptor& shaderDesc, const char* sourceCode, std::size_t sourceLength)
+{
+    auto hash = g_hashOffsetBasis;
+
+    /* Hash compiler version, so entries are invalidated when the compiler is updated */
+    AccumulateHashValue(hash, static_cast<std::uint32_t>(D3D_COMPILER_VERSION));
+
+    /* Hash all compiler parameters */
+    AccumulateHashValue(hash, static_cast<std::uint32_t>(shaderDesc.type));
+    AccumulateHash(hash, shaderDesc.entryPoint);
+    AccumulateHash(hash, shaderDesc.profile);
+    AccumulateHashValue(hash, static_cast<std::int64_t>(shaderDesc.flags & ~ShaderCompileFlags::Async));
+
+    /* Hash named specialization constants, since they are passed as macros */
+    for (const auto& constant : shaderDesc.specializationConstants)
+    {
+        if (constant.name != nullptr && *constant.name != '\0')
+        {
+            AccumulateHash(hash, constant.name);
+            AccumulateHash(hash, GetSpecializationConstantLiteral(constant).c_str());
+        }
+    }
+
+    /* Hash source code */
+    AccumulateHashValue(hash, static_cast<std::uint64_t>(sourceLength));
+    AccumulateHash(hash, sourceCode, sourceLength);
+
+    return hash;
+}
+
+static std::string KeyToHexString(std::uint64_t key)
+{
+    static const char* hexDigits = "0123456789abcdef";
+    std::string s(16, '0');
+    for (int i = 15; i >= 0; --i, key >>= 4)
+        s[i] = hexDigits[key & 0xf];
+    return s;
+}
+
+static std::uint64_t HexStringToKey(const std::string& s)
+{
+    std::uint64_t key = 0;
+    for (auto c : s)
+    {
+        key <<= 4;
+        if (c >= '0' && c <= '9')
+            key |= static_cast<std::uint64_t>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            key |= static_cast<std::uint64_t>(c - 'a' + 10);
+    }
+    return key;
+}
+
+// Extracts the key from the specified cache entry filename, i.e. the 16 hex digits in front of the file extension.
+static std::uint64_t GetKeyFromFilename(const std::string& filename)
+{
+    const auto extPos = filename.rfind('.');
+    if (extPos == std::string::npos || extPos < 16)
+        return 0;
+    return HexStringToKey(filename.substr(extPos - 16, 16));
+}
+
+
+/*
+ * Global functions
+ */
+
+std::string DXGetShaderCacheFilename(
+    const std::string&      cacheDirectory,
+    const ShaderDescriptor& shaderDesc,
+    const char*             sourceCode,
+    std::size_t             sourceLength)
+{
+    if (cacheDirectory.empty() || sourceCode == nullptr)
+        return "";
+
+    /* Source code string might be null terminated without specified length */
+    if (sourceLength == 0)
+        sourceLength = std::strlen(sourceCode);
+
+    const auto key = GetShaderCacheKey(shaderDesc, sourceCode, sourceLength);
+
+    /* Append key to directory path */
+    std::string filename = cacheDirectory;
+    if (filename.back() != '/' && filename.back() != '\\')
+        filename += '/';
+
+    return filename + KeyToHexString(key) + ".dxbc";
+}
+
+bool DXLoadShaderCacheEntry(const std::string& filename, std::vector<char>& byteCode)
+{
+    std::ifstream file { filename, std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Read and validate header */
+    DXShaderCacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_shaderCacheMagic, sizeof(g_shaderCacheMagic)) != 0 ||
+        header.version != g_shaderCacheVersion ||
+        header.key != GetKeyFromFilename(filename) ||
+        header.size == 0)
+    {
+        return false;
+    }
+
+    /* Read byte code; a truncated entry is treated as a cache miss */
+    std::vector<char> buffer(static_cast<std::size_t>(header.size));
+    if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+        return false;
+
+    byteCode = std::move(buffer);
+    return true;
+}
+
+void DXStoreShaderCacheEntry(const std::string& filename, const std::vector<char>& byteCode)
+{
+    if (byteCode.empty())
+        return;
+
+    std::ofstream file { filename, (std::ios_base::binary | std::ios_base::trunc) };
+    if (!file.good())
+        return;
+
+    DXShaderCacheHeader header;
+    {
+        std::memcpy(header.magic, g_shaderCacheMagic, sizeof(g_shaderCacheMagic));
+        header.version  = g_shaderCacheVersion;
+        header.key      = GetKeyFromFilename(filename);
+        header.size     = static_cast<std::uint64_t>(byteCode.size());
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(byteCode.data(), static_cast<std::streamsize>(byteCode.size()));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
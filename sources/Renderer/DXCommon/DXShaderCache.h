@@ -0,0 +1,49 @@
+/*
+ * DXShaderCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DX_SHADER_CACHE_H
+#define LLGL_DX_SHADER_CACHE_H
+
+
+#include <LLGL/ShaderFlags.h>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+On-disk cache for compiled HLSL byte code (DXBC), shared by the D3D11 and D3D12 render systems.
+Each cache entry is a single file whose name is a hash of the shader source and all compiler parameters.
+*/
+
+// Returns the filename of the cache entry for the specified shader source and compiler parameters, or an empty string if the cache directory is empty.
+std::string DXGetShaderCacheFilename(
+    const std::string&      cacheDirectory,
+    const ShaderDescriptor& shaderDesc,
+    const char*             sourceCode,
+    std::size_t             sourceLength
+);
+
+// Loads the byte code of the specified cache entry. Returns false if the entry does not exist or is invalid.
+bool DXLoadShaderCacheEntry(const std::string& filename, std::vector<char>& byteCode);
+
+// Stores the byte code in the specified cache entry. Failures are ignored, since the cache is optional.
+void DXStoreShaderCacheEntry(const std::string& filename, const std::vector<char>& byteCode);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -138,6 +138,11 @@ DXGI_FORMAT Map(const Format format)
         case Format::BGRA8SInt:         break;
         case Format::BGRA8sRGB:         return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
 
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      return DXGI_FORMAT_R10G10B10A2_UNORM;
+        case Format::RGB10A2UInt:       return DXGI_FORMAT_R10G10B10A2_UINT;
+        case Format::RG11B10Float:      return DXGI_FORMAT_R11G11B10_FLOAT;
+
         /* --- Depth-stencil formats --- */
         case Format::D16UNorm:          return DXGI_FORMAT_R16_TYPELESS;        // typeless format to be used with SRV and DSV
         case Format::D32Float:          return DXGI_FORMAT_R32_TYPELESS;        // typeless format to be used with SRV and DSV
@@ -149,6 +154,20 @@ DXGI_FORMAT Map(const Format format)
         case Format::BC1RGBA:           return DXGI_FORMAT_BC1_UNORM;
         case Format::BC2RGBA:           return DXGI_FORMAT_BC2_UNORM;
         case Format::BC3RGBA:           return DXGI_FORMAT_BC3_UNORM;
+        case Format::BC1RGBAsRGB:       return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case Format::BC2RGBAsRGB:       return DXGI_FORMAT_BC2_UNORM_SRGB;
+        case Format::BC3RGBAsRGB:       return DXGI_FORMAT_BC3_UNORM_SRGB;
+        case Format::BC4RUNorm:         return DXGI_FORMAT_BC4_UNORM;
+        case Format::BC4RSNorm:         return DXGI_FORMAT_BC4_SNORM;
+        case Format::BC5RGUNorm:        return DXGI_FORMAT_BC5_UNORM;
+        case Format::BC5RGSNorm:        return DXGI_FORMAT_BC5_SNORM;
+        case Format::BC6HRGBUFloat:     return DXGI_FORMAT_BC6H_UF16;
+        case Format::BC6HRGBSFloat:     return DXGI_FORMAT_BC6H_SF16;
+        case Format::BC7RGBAUNorm:      return DXGI_FORMAT_BC7_UNORM;
+        case Format::BC7RGBAsRGB:       return DXGI_FORMAT_BC7_UNORM_SRGB;
+
+        /* --- ETC2/EAC and ASTC compressed color formats (not supported by DXGI) --- */
+        default:                        break;
     }
     MapFailed("Format", "DXGI_FORMAT");
 }
@@ -262,6 +281,11 @@ Format Unmap(const DXGI_FORMAT format)
         case DXGI_FORMAT_B8G8R8A8_UNORM:        return Format::BGRA8UNorm;
         case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:   return Format::BGRA8sRGB;
 
+        /* --- Packed color formats --- */
+        case DXGI_FORMAT_R10G10B10A2_UNORM:     return Format::RGB10A2UNorm;
+        case DXGI_FORMAT_R10G10B10A2_UINT:      return Format::RGB10A2UInt;
+        case DXGI_FORMAT_R11G11B10_FLOAT:       return Format::RG11B10Float;
+
         /* --- Depth-stencil formats --- */
         case DXGI_FORMAT_D16_UNORM:             return Format::D16UNorm;
         case DXGI_FORMAT_D32_FLOAT:             return Format::D32Float;
@@ -272,6 +296,17 @@ Format Unmap(const DXGI_FORMAT format)
         case DXGI_FORMAT_BC1_UNORM:             return Format::BC1RGBA;
         case DXGI_FORMAT_BC2_UNORM:             return Format::BC2RGBA;
         case DXGI_FORMAT_BC3_UNORM:             return Format::BC3RGBA;
+        case DXGI_FORMAT_BC1_UNORM_SRGB:        return Format::BC1RGBAsRGB;
+        case DXGI_FORMAT_BC2_UNORM_SRGB:        return Format::BC2RGBAsRGB;
+        case DXGI_FORMAT_BC3_UNORM_SRGB:        return Format::BC3RGBAsRGB;
+        case DXGI_FORMAT_BC4_UNORM:             return Format::BC4RUNorm;
+        case DXGI_FORMAT_BC4_SNORM:             return Format::BC4RSNorm;
+        case DXGI_FORMAT_BC5_UNORM:             return Format::BC5RGUNorm;
+        case DXGI_FORMAT_BC5_SNORM:             return Format::BC5RGSNorm;
+        case DXGI_FORMAT_BC6H_UF16:             return Format::BC6HRGBUFloat;
+        case DXGI_FORMAT_BC6H_SF16:             return Format::BC6HRGBSFloat;
+        case DXGI_FORMAT_BC7_UNORM:             return Format::BC7RGBAUNorm;
+        case DXGI_FORMAT_BC7_UNORM_SRGB:        return Format::BC7RGBAsRGB;
 
         default:                                return Format::Undefined;
     }
@@ -0,0 +1,60 @@
+/*
+ * DbgAccelerationStructure.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_ACCELERATION_STRUCTURE_H
+#define LLGL_DBG_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+
+
+namespace LLGL
+{
+
+
+class DbgAccelerationStructure : public AccelerationStructure
+{
+
+    public:
+
+        DbgAccelerationStructure(AccelerationStructure& instance, const AccelerationStructureDescriptor& desc) :
+            AccelerationStructure { desc.type, desc.flags },
+            instance              { instance              },
+            desc                  { desc                  }
+        {
+        }
+
+        void SetName(const char* name) override
+        {
+            instance.SetName(name);
+        }
+
+        std::uint64_t GetDeviceAddress() const override
+        {
+            return instance.GetDeviceAddress();
+        }
+
+        std::uint64_t QueryCompactedSize() override
+        {
+            return instance.QueryCompactedSize();
+        }
+
+        AccelerationStructure&          instance;
+        AccelerationStructureDescriptor desc;
+        bool                            built   = false;    // True once the acceleration structure has been built or compacted
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
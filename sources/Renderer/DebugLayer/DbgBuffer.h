@@ -10,6 +10,8 @@
 
 
 #include <LLGL/Buffer.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <string>
 
 
 namespace LLGL
@@ -27,12 +29,36 @@ class DbgBuffer : public Buffer
         {
         }
 
+        void SetName(const char* name) override
+        {
+            label = (name != nullptr ? name : "");
+            instance.SetName(name);
+        }
+
         Buffer&             instance;
         BufferDescriptor    desc;
+        std::string         label;      // Debug name, see DbgRenderSystem::QueryResourceMemoryReport
         std::uint64_t       elements    = 0;
         bool                initialized = false;
         bool                mapped      = false;
 
+        // Mapped memory range, which is recorded when the buffer is unmapped (see DbgCapture).
+        struct MappedRange
+        {
+            void*           data    = nullptr;
+            std::uint64_t   offset  = 0;
+            std::uint64_t   length  = 0;
+            CPUAccess       access  = CPUAccess::ReadOnly;
+        };
+
+        MappedRange         mappedRange;
+
+        // Frame statistics for performance warnings (see DbgRenderSystem::WarnBufferWrite and DbgRenderSystem::WarnBufferReadback).
+        std::uint64_t       writeFrame      = 0;
+        std::uint32_t       writesInFrame   = 0;
+        std::uint64_t       readbackFrame   = 0;
+        std::uint32_t       readbackFrames  = 0;
+
 };
 
 
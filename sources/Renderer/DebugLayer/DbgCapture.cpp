@@ -0,0 +1,81 @@
+/*
+ * DbgCapture.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DbgCapture.h"
+#include <cstddef>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+DbgCapture::DbgCapture(const std::string& filename) :
+    file_ { filename, std::ios_base::binary }
+{
+    if (!file_.good())
+        throw std::runtime_error("failed to open trace file for writing: " + filename);
+
+    /* Write header, the number of frames is written when the trace is closed */
+    CaptureHeader header;
+    {
+        ::memcpy(header.magic, g_captureMagic, sizeof(g_captureMagic));
+        header.version      = g_captureVersion;
+        header.numFrames    = 0;
+    }
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+DbgCapture::~DbgCapture()
+{
+    FlushRecords();
+
+    /* Patch number of frames in the header */
+    file_.seekp(offsetof(CaptureHeader, numFrames));
+    file_.write(reinterpret_cast<const char*>(&numFrames_), sizeof(numFrames_));
+}
+
+void DbgCapture::Release(const RenderSystemChild* obj)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    if (encoder_.HasObject(obj))
+    {
+        encoder_.Opcode(CaptureOpcode::Release);
+        encoder_.RemoveObject(obj);
+    }
+}
+
+void DbgCapture::Present(const RenderSystemChild* renderContext)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    encoder_.Opcode(CaptureOpcode::Present);
+    encoder_.Object(renderContext);
+    ++numFrames_;
+    FlushRecords();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgCapture::FlushRecords()
+{
+    const auto& data = encoder_.GetData();
+    if (!data.empty())
+    {
+        file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        encoder_.ClearData();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,170 @@
+/*
+ * DbgCapture.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_CAPTURE_H
+#define LLGL_DBG_CAPTURE_H
+
+
+#include "../CaptureFormat.h"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+
+namespace LLGL
+{
+
+
+// Pending records are written into the file once they exceed this size (4 MB), or when a frame is presented.
+static const std::size_t g_captureMaxPendingSize = (1u << 22);
+
+// Data block argument for DbgCapture::Record.
+struct DbgCaptureData
+{
+    const void*     data;
+    std::size_t     size;
+};
+
+// Array argument for DbgCapture::Record.
+template <typename T>
+struct DbgCaptureArray
+{
+    const T*        values;
+    std::uint32_t   count;
+};
+
+template <typename T>
+DbgCaptureArray<T> MakeDbgCaptureArray(const T* values, std::uint32_t count)
+{
+    return DbgCaptureArray<T>{ values, count };
+}
+
+/*
+Records the calls of the debug layer into a binary trace file (see RenderSystemDescriptor::captureFilename).
+Calls can be recorded from multiple threads, e.g. while command buffers are recorded in parallel.
+*/
+class DbgCapture
+{
+
+    public:
+
+        DbgCapture(const std::string& filename);
+        ~DbgCapture();
+
+        DbgCapture(const DbgCapture&) = delete;
+        DbgCapture& operator = (const DbgCapture&) = delete;
+
+        // Records a call with its arguments. Objects are encoded by their identifiers, all other arguments by value.
+        template <typename... TArgs>
+        void Record(const CaptureOpcode opcode, const TArgs&... args);
+
+        // Records the release of the specified object, if it has been recorded.
+        void Release(const RenderSystemChild* obj);
+
+        // Records the presentation of the specified render context and writes all pending records into the file.
+        void Present(const RenderSystemChild* renderContext);
+
+    private:
+
+        friend class DbgCaptureRecord;
+
+        // Terminates the recursion of the variadic arguments.
+        void EncodeArgs()
+        {
+        }
+
+        template <typename TFirst, typename... TNext>
+        void EncodeArgs(const TFirst& first, const TNext&... next)
+        {
+            EncodeArg(first);
+            EncodeArgs(next...);
+        }
+
+        void EncodeArg(const RenderSystemChild* obj)
+        {
+            encoder_.Object(obj);
+        }
+
+        void EncodeArg(const DbgCaptureData& arg)
+        {
+            encoder_.Blob(arg.data, arg.size);
+        }
+
+        template <typename T>
+        void EncodeArg(const DbgCaptureArray<T>& arg)
+        {
+            encoder_.Array(arg.values, arg.count);
+        }
+
+        template <typename T>
+        typename std::enable_if<!std::is_pointer<T>::value>::type EncodeArg(const T& value)
+        {
+            encoder_.Value(value);
+        }
+
+        void FlushRecords();
+
+    private:
+
+        std::mutex      mutex_;
+        std::ofstream   file_;
+        CaptureEncoder  encoder_;
+        std::uint32_t   numFrames_  = 0;
+
+};
+
+// Records a single call while the trace is locked, e.g. to encode descriptors with the encoder directly.
+class DbgCaptureRecord
+{
+
+    public:
+
+        DbgCaptureRecord(DbgCapture& capture, const CaptureOpcode opcode) :
+            capture_ { capture                  },
+            lock_    { capture.mutex_           },
+            encoder  { capture.encoder_         }
+        {
+            encoder.Opcode(opcode);
+        }
+
+        ~DbgCaptureRecord()
+        {
+            if (encoder.GetData().size() >= g_captureMaxPendingSize)
+                capture_.FlushRecords();
+        }
+
+        DbgCaptureRecord(const DbgCaptureRecord&) = delete;
+        DbgCaptureRecord& operator = (const DbgCaptureRecord&) = delete;
+
+    private:
+
+        DbgCapture&                     capture_;
+        std::lock_guard<std::mutex>     lock_;
+
+    public:
+
+        CaptureEncoder&                 encoder;
+
+};
+
+template <typename... TArgs>
+void DbgCapture::Record(const CaptureOpcode opcode, const TArgs&... args)
+{
+    DbgCaptureRecord record { *this, opcode };
+    EncodeArgs(args...);
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
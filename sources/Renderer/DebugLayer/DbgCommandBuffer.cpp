@@ -8,6 +8,7 @@
 #include "DbgCommandBuffer.h"
 #include "DbgCore.h"
 #include "../CheckedCast.h"
+#include "../TransientRing.h"
 #include "../../Core/Helper.h"
 
 #include "DbgRenderContext.h"
@@ -17,6 +18,12 @@
 #include "DbgRenderTarget.h"
 #include "DbgShaderProgram.h"
 #include "DbgQuery.h"
+#include "DbgQueryHeap.h"
+#include "DbgIndirectCommandLayout.h"
+#include "DbgAccelerationStructure.h"
+#include "DbgRenderPass.h"
+#include "DbgCapture.h"
+#include <LLGL/RenderSystem.h>
 
 
 namespace LLGL
@@ -24,14 +31,17 @@ namespace LLGL
 
 
 DbgCommandBuffer::DbgCommandBuffer(
-    CommandBuffer& instance, CommandBufferExt* instanceExt, RenderingProfiler* profiler, RenderingDebugger* debugger, const RenderingCapabilities& caps) :
-        instance    { instance      },
-        instanceExt { instanceExt   },
-        profiler_   { profiler      },
-        debugger_   { debugger      },
-        //caps_       { caps          },
-        features_   { caps.features },
-        limits_     { caps.limits   }
+    RenderSystem& renderSystemInstance, CommandBuffer& instance, CommandBufferExt* instanceExt, RenderingProfiler* profiler,
+    RenderingDebugger* debugger, DbgCapture* capture, const RenderingCapabilities& caps) :
+        instance                { instance              },
+        instanceExt             { instanceExt           },
+        renderSystemInstance_   { renderSystemInstance  },
+        profiler_               { profiler              },
+        debugger_               { debugger              },
+        capture_                { capture               },
+        //caps_                   { caps                  },
+        features_               { caps.features         },
+        limits_                 { caps.limits           }
 {
 }
 
@@ -52,6 +62,7 @@ void DbgCommandBuffer::SetViewport(const Viewport& viewport)
         ValidateViewport(viewport);
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetViewport, this, viewport));
     instance.SetViewport(viewport);
 }
 
@@ -83,11 +94,13 @@ void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport*
         }
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetViewports, this, MakeDbgCaptureArray(viewports, numViewports)));
     instance.SetViewports(numViewports, viewports);
 }
 
 void DbgCommandBuffer::SetScissor(const Scissor& scissor)
 {
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetScissor, this, scissor));
     instance.SetScissor(scissor);
 }
 
@@ -102,6 +115,7 @@ void DbgCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sci
             LLGL_DBG_WARN(WarningType::PointlessOperation, "no scissor rectangles are specified");
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetScissors, this, MakeDbgCaptureArray(scissors, numScissors)));
     instance.SetScissors(numScissors, scissors);
 }
 
@@ -109,33 +123,49 @@ void DbgCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sci
 
 void DbgCommandBuffer::SetClearColor(const ColorRGBAf& color)
 {
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetClearColor, this, color));
     instance.SetClearColor(color);
 }
 
 void DbgCommandBuffer::SetClearDepth(float depth)
 {
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetClearDepth, this, depth));
     instance.SetClearDepth(depth);
 }
 
 void DbgCommandBuffer::SetClearStencil(std::uint32_t stencil)
 {
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetClearStencil, this, stencil));
     instance.SetClearStencil(stencil);
 }
 
 void DbgCommandBuffer::Clear(long flags)
 {
+    LLGL_DBG_PROFILER_SCOPE("Clear");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        WarnClearAfterRenderPass();
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::Clear, this, static_cast<std::uint32_t>(flags)));
     instance.Clear(flags);
 }
 
 void DbgCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_DBG_PROFILER_SCOPE("Clear");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         for (std::uint32_t i = 0; i < numAttachments; ++i)
             ValidateAttachmentClear(attachments[i]);
+        WarnClearAfterRenderPass();
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::ClearAttachments, this, MakeDbgCaptureArray(attachments, numAttachments)));
     instance.ClearAttachments(numAttachments, attachments);
 }
 
@@ -143,10 +173,19 @@ void DbgCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Atta
 
 void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        ValidateBufferType(buffer.GetType(), BufferType::Vertex);
+        if (buffer.GetType() == BufferType::StreamOutput)
+        {
+            auto& streamOutputBufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+            if (streamOutputBufferDbg.desc.vertexBuffer.format.attributes.empty())
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot bind stream-output buffer without vertex format as vertex buffer");
+        }
+        else
+            ValidateBufferType(buffer.GetType(), BufferType::Vertex);
     }
 
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
@@ -157,15 +196,53 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
         bindings_.vertexBuffers             = bindings_.vertexBufferStore;
         bindings_.numVertexBuffers          = 1;
         bindings_.anyNonEmptyVertexBuffer   = (bufferDbg.elements > 0);
+        bindings_.numVertices               = bufferDbg.elements;
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetVertexBuffer, this, &buffer));
     instance.SetVertexBuffer(bufferDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setVertexBuffer.Inc());
 }
 
+void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferType(buffer.GetType(), BufferType::Vertex);
+        if (offset >= bufferDbg.desc.size)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "vertex buffer offset out of bounds (" + std::to_string(offset) +
+                " specified but buffer size is " + std::to_string(bufferDbg.desc.size) + ")"
+            );
+        }
+
+        const auto stride = bufferDbg.desc.vertexBuffer.format.stride;
+
+        bindings_.vertexBufferStore[0]      = (&bufferDbg);
+        bindings_.vertexBuffers             = bindings_.vertexBufferStore;
+        bindings_.numVertexBuffers          = 1;
+        bindings_.anyNonEmptyVertexBuffer   = (bufferDbg.elements > 0);
+        bindings_.numVertices               = (stride > 0 && offset < bufferDbg.desc.size ? (bufferDbg.desc.size - offset) / stride : 0);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetVertexBufferOffset, this, &buffer, offset));
+    instance.SetVertexBuffer(bufferDbg.instance, offset);
+
+    LLGL_DBG_PROFILER_DO(setVertexBuffer.Inc());
+}
+
 void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -178,6 +255,7 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
     {
         bindings_.vertexBuffers         = bufferArrayDbg.buffers.data();
         bindings_.numVertexBuffers      = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
+        bindings_.numVertices           = (bufferArrayDbg.buffers.empty() ? 0 : bufferArrayDbg.buffers.front()->elements);
 
         /* Check if all vertex buffers are empty */
         bindings_.anyNonEmptyVertexBuffer = false;
@@ -191,6 +269,7 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetVertexBufferArray, this, &bufferArray));
     instance.SetVertexBufferArray(bufferArrayDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setVertexBuffer.Inc());
@@ -198,6 +277,8 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
     if (debugger_)
@@ -205,17 +286,61 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
         LLGL_DBG_SOURCE;
         ValidateBufferType(buffer.GetType(), BufferType::Index);
         bindings_.indexBuffer = (&bufferDbg);
+        bindings_.numIndices  = bufferDbg.elements;
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetIndexBuffer, this, &buffer));
     instance.SetIndexBuffer(bufferDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setIndexBuffer.Inc());
 }
 
+void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferType(buffer.GetType(), BufferType::Index);
+
+        const auto formatSize = format.GetFormatSize();
+        if (format.GetDataType() != DataType::UInt16 && format.GetDataType() != DataType::UInt32)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid index format (must be DataType::UInt16 or DataType::UInt32)");
+        else if (offset % formatSize != 0)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "index buffer offset " + std::to_string(offset) + " is not a multiple of the index size " + std::to_string(formatSize)
+            );
+        }
+        if (offset >= bufferDbg.desc.size)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "index buffer offset out of bounds (" + std::to_string(offset) +
+                " specified but buffer size is " + std::to_string(bufferDbg.desc.size) + ")"
+            );
+        }
+
+        bindings_.indexBuffer = (&bufferDbg);
+        bindings_.numIndices  = (formatSize > 0 && offset < bufferDbg.desc.size ? (bufferDbg.desc.size - offset) / formatSize : 0);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetIndexBufferOffset, this, &buffer, format.GetDataType(), offset));
+    instance.SetIndexBuffer(bufferDbg.instance, format, offset);
+
+    LLGL_DBG_PROFILER_DO(setIndexBuffer.Inc());
+}
+
 /* ----- Constant Buffers ------ */
 
 void DbgCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     AssertCommandBufferExt(__func__);
 
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
@@ -224,18 +349,53 @@ void DbgCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, lon
     {
         LLGL_DBG_SOURCE;
         ValidateBufferType(buffer.GetType(), BufferType::Constant);
-        ValidateStageFlags(stageFlags, StageFlags::AllStages);
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages);
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetConstantBuffer, this, &buffer, slot, static_cast<std::uint32_t>(stageFlags)));
     instanceExt->SetConstantBuffer(bufferDbg.instance, slot, stageFlags);
     
     LLGL_DBG_PROFILER_DO(setConstantBuffer.Inc());
 }
 
+void DbgCommandBuffer::SetConstantBufferRange(Buffer& buffer, std::uint32_t slot, std::uint64_t offset, std::uint64_t size, long stageFlags)
+{
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    AssertCommandBufferExt(__func__);
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferType(buffer.GetType(), BufferType::Constant);
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages);
+        ValidateBufferRange(bufferDbg, offset, size, "constant");
+
+        const auto alignment = limits_.constantBufferOffsetAlignment;
+        if (alignment > 0 && offset % alignment != 0)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "constant buffer range offset " + std::to_string(offset) + " is not a multiple of the constant buffer offset alignment (" +
+                std::to_string(alignment) + ")"
+            );
+        }
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetConstantBufferRange, this, &buffer, slot, offset, size, static_cast<std::uint32_t>(stageFlags)));
+    instanceExt->SetConstantBufferRange(bufferDbg.instance, slot, offset, size, stageFlags);
+
+    LLGL_DBG_PROFILER_DO(setConstantBuffer.Inc());
+}
+
 /* ----- Storage Buffers ------ */
 
 void DbgCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     AssertCommandBufferExt(__func__);
 
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
@@ -244,9 +404,10 @@ void DbgCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long
     {
         LLGL_DBG_SOURCE;
         ValidateBufferType(buffer.GetType(), BufferType::Storage);
-        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::ReadOnlyResource);
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages | StageFlags::ReadOnlyResource);
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetStorageBuffer, this, &buffer, slot, static_cast<std::uint32_t>(stageFlags)));
     instanceExt->SetStorageBuffer(bufferDbg.instance, slot, stageFlags);
     
     LLGL_DBG_PROFILER_DO(setStorageBuffer.Inc());
@@ -256,6 +417,8 @@ void DbgCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long
 
 void DbgCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     
     if (debugger_)
@@ -272,6 +435,8 @@ void DbgCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 
 void DbgCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -305,16 +470,47 @@ void DbgCommandBuffer::EndStreamOutput()
         LLGL_DBG_SOURCE;
         if (!states_.streamOutputBusy)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not started");
-        states_.streamOutputBusy = false;
+        states_.streamOutputBusy    = false;
+        states_.streamOutputPaused  = false;
     }
 
     instance.EndStreamOutput();
 }
 
+void DbgCommandBuffer::PauseStreamOutput()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!states_.streamOutputBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not started");
+        else if (states_.streamOutputPaused)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output is already paused");
+        states_.streamOutputPaused = true;
+    }
+
+    instance.PauseStreamOutput();
+}
+
+void DbgCommandBuffer::ResumeStreamOutput()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!states_.streamOutputPaused)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not been paused");
+        states_.streamOutputPaused = false;
+    }
+
+    instance.ResumeStreamOutput();
+}
+
 /* ----- Textures ----- */
 
 void DbgCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     AssertCommandBufferExt(__func__);
 
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
@@ -322,9 +518,10 @@ void DbgCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long sta
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        ValidateStageFlags(stageFlags, StageFlags::AllStages);
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetTexture, this, &texture, slot, static_cast<std::uint32_t>(stageFlags)));
     instanceExt->SetTexture(textureDbg.instance, slot, stageFlags);
     
     LLGL_DBG_PROFILER_DO(setTexture.Inc());
@@ -334,14 +531,17 @@ void DbgCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long sta
 
 void DbgCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     AssertCommandBufferExt(__func__);
 
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        ValidateStageFlags(stageFlags, StageFlags::AllStages);
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetSampler, this, &sampler, slot, static_cast<std::uint32_t>(stageFlags)));
     instanceExt->SetSampler(sampler, slot, stageFlags);
     
     LLGL_DBG_PROFILER_DO(setSampler.Inc());
@@ -350,21 +550,99 @@ void DbgCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long sta
 /* ----- Resource View Heaps ----- */
 
 //TODO: record bindings
-void DbgCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void DbgCommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
-    instance.SetGraphicsResourceHeap(resourceHeap, firstSet);
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDynamicOffsets(numDynamicOffsets, dynamicOffsets);
+        bindings_.graphicsResourceHeap = &resourceHeap;
+
+        /* Dynamic offsets may differ between bindings of the same resource heap */
+        if (perf_.graphicsResourceHeap == &resourceHeap && perf_.graphicsResourceSet == firstSet && numDynamicOffsets == 0)
+            LLGL_DBG_WARN(WarningType::Performance, "redundant binding of graphics resource heap");
+        perf_.graphicsResourceHeap  = &resourceHeap;
+        perf_.graphicsResourceSet   = firstSet;
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetGraphicsResourceHeap, this, &resourceHeap, firstSet, MakeDbgCaptureArray(dynamicOffsets, numDynamicOffsets)));
+    instance.SetGraphicsResourceHeap(resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets);
 }
 
 //TODO: record bindings
-void DbgCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void DbgCommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDynamicOffsets(numDynamicOffsets, dynamicOffsets);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetComputeResourceHeap, this, &resourceHeap, firstSet, MakeDbgCaptureArray(dynamicOffsets, numDynamicOffsets)));
+    instance.SetComputeResourceHeap(resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constants ----- */
+
+void DbgCommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
 {
-    instance.SetComputeResourceHeap(resourceHeap, firstSet);
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateStageFlags(stageFlags, StageFlags::AllStages | StageFlags::AllMeshStages);
+        ValidateConstantsRange(offset, size, data);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetConstants, this, static_cast<std::uint32_t>(stageFlags), offset, DbgCaptureData{ data, size }));
+    instance.SetConstants(stageFlags, offset, size, data);
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation DbgCommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTransientAllocation(size, alignment);
+    }
+
+    auto allocation = instance.AllocateTransient(size, alignment);
+
+    /* Wrap the ring buffer of the instance, so it can be bound like any other buffer of the debug layer */
+    auto& bufferDbg = transientBuffers_[allocation.buffer];
+    if (!bufferDbg)
+    {
+        bufferDbg = MakeUnique<DbgBuffer>(*allocation.buffer, BufferType::Constant);
+        bufferDbg->desc.type    = BufferType::Constant;
+        bufferDbg->desc.size    = g_transientRingSize;
+        bufferDbg->initialized  = true;
+    }
+    allocation.buffer = bufferDbg.get();
+
+    return allocation;
 }
 
 /* ----- Render Targets ----- */
 
 void DbgCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     auto& renderTargetDbg = LLGL_CAST(DbgRenderTarget&, renderTarget);
     
     if (debugger_)
@@ -373,6 +651,7 @@ void DbgCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
         bindings_.renderTarget  = &renderTargetDbg;
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetRenderTarget, this, &renderTarget));
     instance.SetRenderTarget(renderTargetDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
@@ -380,6 +659,8 @@ void DbgCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 
 void DbgCommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     auto& renderContextDbg = LLGL_CAST(DbgRenderContext&, renderContext);
     
     if (debugger_)
@@ -388,19 +669,142 @@ void DbgCommandBuffer::SetRenderTarget(RenderContext& renderContext)
         bindings_.renderTarget  = nullptr;
     }
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetRenderTarget, this, &renderContext));
     instance.SetRenderTarget(renderContextDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
 }
 
+void DbgCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    LLGL_DBG_PROFILER_SCOPE("RenderPass");
+
+    auto& renderTargetDbg = LLGL_CAST(DbgRenderTarget&, renderTarget);
+    auto renderPassDbg = (renderPass != nullptr ? LLGL_CAST(const DbgRenderPass*, renderPass) : nullptr);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBeginRenderPass(
+            renderPassDbg,
+            renderTargetDbg.GetNumColorAttachments(),
+            (renderTargetDbg.HasDepthAttachment() || renderTargetDbg.HasStencilAttachment()),
+            numClearValues,
+            clearValues
+        );
+        bindings_.renderContext     = nullptr;
+        bindings_.renderTarget      = &renderTargetDbg;
+        states_.renderPassActive    = true;
+        BeginPerformanceScope(renderPassDbg);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::BeginRenderPass, this, &renderTarget, renderPass, MakeDbgCaptureArray(clearValues, numClearValues)));
+    instance.BeginRenderPass(
+        renderTargetDbg.instance,
+        (renderPassDbg != nullptr ? &(renderPassDbg->instance) : nullptr),
+        numClearValues,
+        clearValues
+    );
+
+    LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+}
+
+void DbgCommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    LLGL_DBG_PROFILER_SCOPE("RenderPass");
+
+    auto& renderContextDbg = LLGL_CAST(DbgRenderContext&, renderContext);
+    auto renderPassDbg = (renderPass != nullptr ? LLGL_CAST(const DbgRenderPass*, renderPass) : nullptr);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        const auto& videoMode = renderContextDbg.GetVideoMode();
+        ValidateBeginRenderPass(
+            renderPassDbg,
+            1,
+            (videoMode.depthBits > 0 || videoMode.stencilBits > 0),
+            numClearValues,
+            clearValues
+        );
+        bindings_.renderContext     = &renderContextDbg;
+        bindings_.renderTarget      = nullptr;
+        states_.renderPassActive    = true;
+        BeginPerformanceScope(renderPassDbg);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::BeginRenderPass, this, &renderContext, renderPass, MakeDbgCaptureArray(clearValues, numClearValues)));
+    instance.BeginRenderPass(
+        renderContextDbg.instance,
+        (renderPassDbg != nullptr ? &(renderPassDbg->instance) : nullptr),
+        numClearValues,
+        clearValues
+    );
+
+    LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+}
+
+void DbgCommandBuffer::EndRenderPass()
+{
+    LLGL_DBG_PROFILER_SCOPE("RenderPass");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!states_.renderPassActive)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot end render pass that has not been begun");
+        states_.renderPassActive = false;
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::EndRenderPass, this));
+    instance.EndRenderPass();
+}
+
+void DbgCommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    LLGL_DBG_PROFILER_SCOPE("RenderPass");
+
+    auto& srcRenderTargetDbg = LLGL_CAST(DbgRenderTarget&, srcRenderTarget);
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateResolveRenderTarget(srcRenderTargetDbg, dstTextureDbg, srcColorAttachment);
+    }
+
+    instance.ResolveRenderTarget(srcRenderTargetDbg.instance, dstTextureDbg.instance, srcColorAttachment);
+}
+
+void DbgCommandBuffer::DiscardAttachments(long flags)
+{
+    LLGL_DBG_PROFILER_SCOPE("RenderPass");
+    instance.DiscardAttachments(flags);
+}
+
 /* ----- Pipeline States ----- */
 
 void DbgCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     auto& graphicsPipelineDbg = LLGL_CAST(DbgGraphicsPipeline&, graphicsPipeline);
 
     if (debugger_)
     {
+        LLGL_DBG_SOURCE;
+        if (perf_.graphicsPipeline == &graphicsPipelineDbg)
+            LLGL_DBG_WARN(WarningType::Performance, "redundant binding of graphics pipeline");
+        perf_.graphicsPipeline = &graphicsPipelineDbg;
+
         bindings_.graphicsPipeline = (&graphicsPipelineDbg);
         if (auto shaderProgram = graphicsPipelineDbg.desc.shaderProgram)
         {
@@ -409,12 +813,16 @@ void DbgCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
         }
         else
             bindings_.anyShaderAttributes = false;
+
+        if (states_.renderPassActive)
+            ValidateViewMask(graphicsPipelineDbg);
     }
 
     /* Store primitive topology used in graphics pipeline */
     topology_ = graphicsPipelineDbg.desc.primitiveTopology;
 
     /* Call wrapped function */
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetGraphicsPipeline, this, &graphicsPipeline));
     instance.SetGraphicsPipeline(graphicsPipelineDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setGraphicsPipeline.Inc());
@@ -422,95 +830,368 @@ void DbgCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void DbgCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_DBG_PROFILER_SCOPE("Binding");
+
     if (debugger_)
         bindings_.computePipeline = (&computePipeline);
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetComputePipeline, this, &computePipeline));
     instance.SetComputePipeline(computePipeline);
     
     LLGL_DBG_PROFILER_DO(setComputePipeline.Inc());
 }
 
-/* ----- Queries ----- */
-
-void DbgCommandBuffer::BeginQuery(Query& query)
+void DbgCommandBuffer::SetShadingRate(const ShadingRate rate)
 {
-    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
-
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        if (queryDbg.state == DbgQuery::State::Busy)
-            LLGL_DBG_ERROR(ErrorType::InvalidState, "query is already busy");
-        queryDbg.state = DbgQuery::State::Busy;
+        if (!features_.hasVariableRateShading)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("variable rate shading");
+        else if (!features_.hasAdditionalShadingRates && (rate == ShadingRate::Rate2x4 || rate == ShadingRate::Rate4x2 || rate == ShadingRate::Rate4x4))
+            LLGL_DBG_ERROR_NOT_SUPPORTED("additional shading rates (2x4, 4x2, 4x4)");
     }
 
-    instance.BeginQuery(queryDbg.instance);
+    instance.SetShadingRate(rate);
 }
 
-void DbgCommandBuffer::EndQuery(Query& query)
+void DbgCommandBuffer::SetShadingRateImage(Texture* texture)
 {
-    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
-
-    if (debugger_)
+    if (texture != nullptr)
     {
-        LLGL_DBG_SOURCE;
-        if (queryDbg.state != DbgQuery::State::Busy)
-            LLGL_DBG_ERROR(ErrorType::InvalidState, "query has not started");
-        queryDbg.state = DbgQuery::State::Ready;
-    }
+        auto& textureDbg = LLGL_CAST(DbgTexture&, *texture);
 
-    instance.EndQuery(queryDbg.instance);
+        if (debugger_)
+        {
+            LLGL_DBG_SOURCE;
+            if (!features_.hasShadingRateImage)
+                LLGL_DBG_ERROR_NOT_SUPPORTED("shading rate images");
+            else if (textureDbg.desc.type != TextureType::Texture2D || textureDbg.desc.format != Format::R8UInt)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shading rate image must be a 2D texture with format R8UInt");
+        }
+
+        instance.SetShadingRateImage(&(textureDbg.instance));
+    }
+    else
+        instance.SetShadingRateImage(nullptr);
 }
 
-bool DbgCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+void DbgCommandBuffer::SetStencilReference(std::uint32_t reference)
 {
-    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
-
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        if (queryDbg.state != DbgQuery::State::Ready)
-            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
+        ValidateDynamicState(DynamicStateFlags::StencilReference, "stencil reference");
     }
 
-    return instance.QueryResult(queryDbg.instance, result);
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetStencilReference, this, reference));
+    instance.SetStencilReference(reference);
 }
 
-bool DbgCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+void DbgCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 {
-    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
-
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        if (queryDbg.state != DbgQuery::State::Ready)
-            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
+        ValidateDynamicState(DynamicStateFlags::BlendFactor, "blend factor");
     }
 
-    return instance.QueryPipelineStatisticsResult(queryDbg.instance, result);
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::SetBlendFactor, this, color));
+    instance.SetBlendFactor(color);
 }
 
-void DbgCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+void DbgCommandBuffer::SetDepthBias(const DepthBiasDescriptor& depthBias)
 {
-    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
-    instance.BeginRenderCondition(queryDbg.instance, mode);
-}
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDynamicState(DynamicStateFlags::DepthBias, "depth bias");
+    }
 
-void DbgCommandBuffer::EndRenderCondition()
-{
-    instance.EndRenderCondition();
+    instance.SetDepthBias(depthBias);
 }
 
-/* ----- Drawing ----- */
-
-void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+void DbgCommandBuffer::SetDepthBounds(float minBounds, float maxBounds)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDynamicState(DynamicStateFlags::DepthBounds, "depth bounds");
+        if (minBounds < 0.0f || minBounds > maxBounds || maxBounds > 1.0f)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "invalid depth bounds [" + std::to_string(minBounds) + ", " + std::to_string(maxBounds) + "] (must satisfy 0 <= min <= max <= 1)"
+            );
+        }
+    }
+
+    instance.SetDepthBounds(minBounds, maxBounds);
+}
+
+/* ----- Queries ----- */
+
+void DbgCommandBuffer::BeginQuery(Query& query)
+{
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (queryDbg.state == DbgQuery::State::Busy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query is already busy");
+        queryDbg.state = DbgQuery::State::Busy;
+    }
+
+    instance.BeginQuery(queryDbg.instance);
+}
+
+void DbgCommandBuffer::EndQuery(Query& query)
+{
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (queryDbg.state != DbgQuery::State::Busy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query has not started");
+        queryDbg.state = DbgQuery::State::Ready;
+    }
+
+    instance.EndQuery(queryDbg.instance);
+}
+
+bool DbgCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (queryDbg.state != DbgQuery::State::Ready)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
+    }
+
+    return instance.QueryResult(queryDbg.instance, result);
+}
+
+bool DbgCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (queryDbg.state != DbgQuery::State::Ready)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
+    }
+
+    return instance.QueryPipelineStatisticsResult(queryDbg.instance, result);
+}
+
+void DbgCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+{
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBeginRenderCondition();
+    }
+
+    instance.BeginRenderCondition(queryDbg.instance, mode);
+}
+
+void DbgCommandBuffer::EndRenderCondition()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!states_.renderCondActive)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot end render condition that has not been begun");
+        states_.renderCondActive = false;
+    }
+
+    instance.EndRenderCondition();
+}
+
+void DbgCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateQueryRange(queryHeapDbg, query, 1);
+    }
+
+    instance.BeginQuery(queryHeapDbg.instance, query);
+}
+
+void DbgCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateQueryRange(queryHeapDbg, query, 1);
+    }
+
+    instance.EndQuery(queryHeapDbg.instance, query);
+}
+
+void DbgCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateQueryRange(queryHeapDbg, query, 1);
+        ValidateBeginRenderCondition();
+    }
+
+    instance.BeginRenderCondition(queryHeapDbg.instance, query, mode);
+}
+
+bool DbgCommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateQueryRange(queryHeapDbg, firstQuery, numQueries);
+        if (results == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "query results must not be null");
+    }
+
+    return instance.QueryResults(queryHeapDbg.instance, firstQuery, numQueries, results);
+}
+
+void DbgCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
+{
+    auto& queryHeapDbg  = LLGL_CAST(DbgQueryHeap&, queryHeap);
+    auto& dstBufferDbg  = LLGL_CAST(DbgBuffer&, dstBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateQueryRange(queryHeapDbg, firstQuery, numQueries);
+        if (dstOffset + static_cast<std::uint64_t>(numQueries) * sizeof(std::uint64_t) > dstBufferDbg.desc.size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "query results exceed destination buffer size");
+    }
+
+    instance.ResolveQueries(queryHeapDbg.instance, firstQuery, numQueries, dstBufferDbg.instance, dstOffset);
+}
+
+/* ----- Timer Scopes ----- */
+
+void DbgCommandBuffer::BeginTimerScope(const char* name)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (name == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "timer scope name must not be null");
+    }
+
+    instance.BeginTimerScope(name);
+
+    ++states_.timerScopeDepth;
+}
+
+void DbgCommandBuffer::EndTimerScope()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (states_.timerScopeDepth == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no timer scope has been started");
+    }
+
+    instance.EndTimerScope();
+
+    if (states_.timerScopeDepth > 0)
+        --states_.timerScopeDepth;
+}
+
+bool DbgCommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
+{
+    if (instance.QueryTimerScopes(frame))
+    {
+        if (profiler_ && profiler_->IsEventLogEnabled())
+        {
+            /* Place GPU events at their absolute time in the CPU timeline if the GPU timestamps can be calibrated */
+            TimestampCalibration calibration;
+            if (renderSystemInstance_.QueryTimestampCalibration(calibration))
+                profiler_->RecordTimerScopes(frame, &calibration);
+            else
+                profiler_->RecordTimerScopes(frame);
+        }
+        return true;
+    }
+    return false;
+}
+
+/* ----- Debug Markers ----- */
+
+void DbgCommandBuffer::PushDebugGroup(const char* name)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (name == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "debug group name must not be null");
+    }
+
+    instance.PushDebugGroup(name);
+
+    ++states_.debugGroupDepth;
+}
+
+void DbgCommandBuffer::PopDebugGroup()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (states_.debugGroupDepth == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no debug group has been pushed");
+    }
+
+    if (states_.debugGroupDepth > 0)
+    {
+        instance.PopDebugGroup();
+        --states_.debugGroupDepth;
+    }
+}
+
+void DbgCommandBuffer::InsertDebugMarker(const char* name)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (name == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "debug marker name must not be null");
+    }
+
+    instance.InsertDebugMarker(name);
+}
+
+/* ----- Drawing ----- */
+
+void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawCmd(numVertices, firstVertex, 1, 0);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::Draw, this, numVertices, firstVertex));
     instance.Draw(numVertices, firstVertex);
     
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices));
@@ -518,12 +1199,15 @@ void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex
 
 void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, 0, 0);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexed, this, numIndices, firstIndex));
     instance.DrawIndexed(numIndices, firstIndex);
     
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices));
@@ -531,12 +1215,15 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
 
 void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, vertexOffset, 0);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedVertexOffset, this, numIndices, firstIndex, vertexOffset));
     instance.DrawIndexed(numIndices, firstIndex, vertexOffset);
     
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices));
@@ -544,6 +1231,8 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
 
 void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -551,6 +1240,7 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
         ValidateDrawCmd(numVertices, firstVertex, numInstances, 0);
     }
     
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawInstanced, this, numVertices, firstVertex, numInstances));
     instance.DrawInstanced(numVertices, firstVertex, numInstances);
     
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
@@ -558,82 +1248,629 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
 
 void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        AssertOffsetInstancingSupported();
+        ValidateDrawCmd(numVertices, firstVertex, numInstances, firstInstance);
+    }
+    
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawInstancedFirstInstance, this, numVertices, firstVertex, numInstances, firstInstance));
+    instance.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+    
+    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
+}
+
+void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, 0, 0);
+    }
+    
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedInstanced, this, numIndices, numInstances, firstIndex));
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+    
+    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
+}
+
+void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, 0);
+    }
+    
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedInstancedVertexOffset, this, numIndices, numInstances, firstIndex, vertexOffset));
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+    
+    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
+}
+
+void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        AssertOffsetInstancingSupported();
+        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+    }
+    
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedInstancedFirstInstance, this, numIndices, numInstances, firstIndex, vertexOffset, firstInstance));
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+    
+    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
+}
+
+void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawIndirectCmd(bufferDbg, offset, 1, sizeof(DrawIndirectArguments), sizeof(DrawIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndirect, this, &buffer, offset));
+    instance.DrawIndirect(bufferDbg.instance, offset);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawIndirectCmd(bufferDbg, offset, numCommands, stride, sizeof(DrawIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndirectMulti, this, &buffer, offset, numCommands, stride));
+    instance.DrawIndirect(bufferDbg.instance, offset, numCommands, stride);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(numCommands));
+}
+
+void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndexBufferBound();
+        ValidateDrawIndirectCmd(bufferDbg, offset, 1, sizeof(DrawIndexedIndirectArguments), sizeof(DrawIndexedIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedIndirect, this, &buffer, offset));
+    instance.DrawIndexedIndirect(bufferDbg.instance, offset);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndexBufferBound();
+        ValidateDrawIndirectCmd(bufferDbg, offset, numCommands, stride, sizeof(DrawIndexedIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawIndexedIndirectMulti, this, &buffer, offset, numCommands, stride));
+    instance.DrawIndexedIndirect(bufferDbg.instance, offset, numCommands, stride);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(numCommands));
+}
+
+void DbgCommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  layout,
+    Buffer&                 argumentBuffer,
+    std::uint64_t           argumentOffset,
+    std::uint32_t           maxNumCommands,
+    Buffer*                 countBuffer,
+    std::uint64_t           countOffset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& layoutDbg         = LLGL_CAST(DbgIndirectCommandLayout&, layout);
+    auto& argumentBufferDbg = LLGL_CAST(DbgBuffer&, argumentBuffer);
+    auto  countBufferDbg    = LLGL_CAST(DbgBuffer*, countBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertGraphicsPipelineBound();
+        if (layoutDbg.GetDrawType() == IndirectArgumentType::DrawIndexed)
+            AssertIndexBufferBound();
+
+        /* Vertex buffers can be changed by the commands themselves, so only the ranges of the argument and count buffers are validated */
+        if (SampleDrawValidation())
+        {
+            const auto drawArgumentSize = IndirectCommandLayout::GetArgumentSize(layoutDbg.desc.arguments.back());
+            ValidateIndirectArguments(argumentBufferDbg, argumentOffset + layoutDbg.GetDrawOffset(), maxNumCommands, layoutDbg.GetStride(), drawArgumentSize);
+            if (countBufferDbg != nullptr)
+                ValidateIndirectArguments(*countBufferDbg, countOffset, 1, 0, sizeof(std::uint32_t));
+        }
+    }
+
+    instance.ExecuteIndirect(
+        layoutDbg.instance,
+        argumentBufferDbg.instance,
+        argumentOffset,
+        maxNumCommands,
+        (countBufferDbg != nullptr ? &(countBufferDbg->instance) : nullptr),
+        countOffset
+    );
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(maxNumCommands));
+}
+
+void DbgCommandBuffer::DrawStreamOutput()
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertGraphicsPipelineBound();
+        AssertVertexBufferBound();
+
+        if (bindings_.numVertexBuffers != 1 || bindings_.vertexBuffers[0]->desc.type != BufferType::StreamOutput)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot draw stream-output without a stream-output buffer bound as vertex buffer");
+        else if (bindings_.vertexBuffers[0] == bindings_.streamOutput && states_.streamOutputBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot draw stream-output from a buffer that is currently captured");
+    }
+
+    instance.DrawStreamOutput();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (groupSizeX * groupSizeY * groupSizeZ == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "thread group size has volume of 0 units");
+
+        ValidateDrawMeshTasksCmd();
+        ValidateThreadGroupLimit(groupSizeX, limits_.maxMeshTaskWorkGroups[0]);
+        ValidateThreadGroupLimit(groupSizeY, limits_.maxMeshTaskWorkGroups[1]);
+        ValidateThreadGroupLimit(groupSizeZ, limits_.maxMeshTaskWorkGroups[2]);
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawMeshTasks, this, groupSizeX, groupSizeY, groupSizeZ));
+    instance.DrawMeshTasks(groupSizeX, groupSizeY, groupSizeZ);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_DBG_PROFILER_SCOPE("Draw");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectDrawingSupported();
+        ValidateDrawMeshTasksCmd();
+        if (SampleDrawValidation())
+            ValidateIndirectArguments(bufferDbg, offset, numCommands, stride, sizeof(DrawMeshTasksIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DrawMeshTasksIndirect, this, &buffer, offset, numCommands, stride));
+    instance.DrawMeshTasksIndirect(bufferDbg.instance, offset, numCommands, stride);
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(numCommands));
+}
+
+/* ----- Compute ----- */
+
+void DbgCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_DBG_PROFILER_SCOPE("Dispatch");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (groupSizeX * groupSizeY * groupSizeZ == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "thread group size has volume of 0 units");
+
+        AssertComputePipelineBound();
+        ValidateThreadGroupLimit(groupSizeX, limits_.maxNumComputeShaderWorkGroups[0]);
+        ValidateThreadGroupLimit(groupSizeY, limits_.maxNumComputeShaderWorkGroups[1]);
+        ValidateThreadGroupLimit(groupSizeZ, limits_.maxNumComputeShaderWorkGroups[2]);
+    }
+    
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::Dispatch, this, groupSizeX, groupSizeY, groupSizeZ));
+    instance.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+    
+    LLGL_DBG_PROFILER_DO(dispatchComputeCalls.Inc());
+}
+
+void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_DBG_PROFILER_SCOPE("Dispatch");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectDrawingSupported();
+        AssertComputePipelineBound();
+        ValidateIndirectArguments(bufferDbg, offset, 1, sizeof(DispatchIndirectArguments), sizeof(DispatchIndirectArguments));
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DispatchIndirect, this, &buffer, offset));
+    instance.DispatchIndirect(bufferDbg.instance, offset);
+
+    LLGL_DBG_PROFILER_DO(dispatchComputeCalls.Inc());
+}
+
+void DbgCommandBuffer::DispatchBarrier()
+{
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::DispatchBarrier, this));
+    instance.DispatchBarrier();
+}
+
+/* ----- Acceleration Structures ----- */
+
+void DbgCommandBuffer::BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures)
+{
+    LLGL_DBG_PROFILER_SCOPE("BuildAccelerationStructures");
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (!features_.hasRayQueries)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("acceleration structures");
+        if (states_.renderPassActive)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot build acceleration structures while a render pass is active");
+
+        if (numAccelerationStructures == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "building zero acceleration structures");
+        else if (accelerationStructures == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed for array of acceleration structures");
+    }
+
+    /* Replace all acceleration structures by their instances */
+    std::vector<AccelerationStructure*> instances;
+    instances.reserve(numAccelerationStructures);
+
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureDbg = LLGL_CAST(DbgAccelerationStructure*, accelerationStructures[i]);
+        if (debugger_)
+            ValidateBuildAccelerationStructure(*accelerationStructureDbg);
+        accelerationStructureDbg->built = true;
+        instances.push_back(&(accelerationStructureDbg->instance));
+    }
+
+    instance.BuildAccelerationStructures(numAccelerationStructures, instances.data());
+}
+
+void DbgCommandBuffer::CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure)
+{
+    LLGL_DBG_PROFILER_SCOPE("CompactAccelerationStructure");
+
+    auto& dstAccelerationStructureDbg = LLGL_CAST(DbgAccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelerationStructureDbg = LLGL_CAST(DbgAccelerationStructure&, srcAccelerationStructure);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (!features_.hasRayQueries)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("acceleration structures");
+        if (states_.renderPassActive)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot compact acceleration structure while a render pass is active");
+
+        if ((srcAccelerationStructureDbg.GetFlags() & AccelerationStructureFlags::AllowCompaction) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "source of acceleration structure compaction was not created with the LLGL::AccelerationStructureFlags::AllowCompaction flag");
+        if (!srcAccelerationStructureDbg.built)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "source of acceleration structure compaction has not been built");
+        if (dstAccelerationStructureDbg.desc.compactedSize == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination of acceleration structure compaction was not created with a compacted size");
+        if (dstAccelerationStructureDbg.GetType() != srcAccelerationStructureDbg.GetType())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "type mismatch between source and destination of acceleration structure compaction");
+    }
+
+    dstAccelerationStructureDbg.built = true;
+
+    instance.CompactAccelerationStructure(dstAccelerationStructureDbg.instance, srcAccelerationStructureDbg.instance);
+}
+
+/* ----- Copy ----- */
+
+void DbgCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+        ValidateBufferRange(dstBufferDbg, dstOffset, size, "destination");
+        ValidateBufferRange(srcBufferDbg, srcOffset, size, "source");
+
+        if (size == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "copying zero bytes between buffers");
+        if (&dstBufferDbg == &srcBufferDbg && dstOffset < srcOffset + size && srcOffset < dstOffset + size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "source and destination ranges of buffer copy overlap");
+    }
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::CopyBuffer, this, &dstBuffer, dstOffset, &srcBuffer, srcOffset, size));
+    instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size);
+}
+
+void DbgCommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+        ValidateBufferCounter(srcBufferDbg);
+        ValidateBufferRange(dstBufferDbg, dstOffset, sizeof(std::uint32_t), "destination");
+
+        if (dstOffset % sizeof(std::uint32_t) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination offset of buffer counter copy must be a multiple of 4");
+    }
+
+    instance.CopyCounterToBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance);
+}
+
+void DbgCommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+        ValidateBufferCounter(bufferDbg);
+    }
+
+    instance.SetBufferCounter(bufferDbg.instance, value);
+}
+
+void DbgCommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+        ValidateBufferRange(dstBufferDbg, dstOffset, fillSize, "destination");
+
+        if (dstOffset % 4 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill offset must be a multiple of 4, but " + std::to_string(dstOffset) + " was specified");
+        if (fillSize % 4 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill size must be a multiple of 4, but " + std::to_string(fillSize) + " was specified");
+        if (fillSize == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "buffer fill with zero size");
+    }
+
+    instance.FillBuffer(dstBufferDbg.instance, dstOffset, fillSize, value);
+}
+
+void DbgCommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+        ValidateTextureRegion(dstTextureDbg, dstLocation.mipLevel, dstLocation.offset, srcRegion.extent, "destination");
+        ValidateTextureRegion(srcTextureDbg, srcRegion.mipLevel, srcRegion.offset, srcRegion.extent, "source");
+
+        if (FormatBitSize(dstTextureDbg.desc.format) != FormatBitSize(srcTextureDbg.desc.format))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy between textures with different texel sizes");
+        if (dstTextureDbg.desc.samples != srcTextureDbg.desc.samples)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy between textures with different number of samples");
+    }
+
+    instance.CopyTexture(dstTextureDbg.instance, dstLocation, srcTextureDbg.instance, srcRegion);
+}
+
+void DbgCommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCopyCmd();
+
+        const auto numArrayLayers = (textureDbg.GetType() == TextureType::Texture3D ? 1u : textureDbg.desc.arrayLayers);
+
+        if (subresource.baseMipLevel + subresource.numMipLevels > textureDbg.mipLevels)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "MIP-map range [" + std::to_string(subresource.baseMipLevel) + ", " +
+                std::to_string(subresource.baseMipLevel + subresource.numMipLevels) + ") exceeds number of MIP-map levels (" +
+                std::to_string(textureDbg.mipLevels) + ") of texture to clear"
+            );
+        }
+        if (subresource.baseArrayLayer + subresource.numArrayLayers > numArrayLayers)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "array layer range [" + std::to_string(subresource.baseArrayLayer) + ", " +
+                std::to_string(subresource.baseArrayLayer + subresource.numArrayLayers) + ") exceeds number of array layers (" +
+                std::to_string(numArrayLayers) + ") of texture to clear"
+            );
+        }
+        if (IsCompressedFormat(textureDbg.desc.format))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot clear texture with compressed format");
+        if ((textureDbg.desc.flags & TextureFlags::Transient) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot clear transient texture outside of a render pass");
+        if (subresource.numMipLevels == 0 || subresource.numArrayLayers == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "texture clear with empty subresource range");
+    }
+
+    instance.ClearTexture(textureDbg.instance, subresource, clearValue);
+}
+
+void DbgCommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcBufferDbg  = LLGL_CAST(DbgBuffer&, srcBuffer);
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        AssertInstancingSupported();
-        AssertOffsetInstancingSupported();
-        ValidateDrawCmd(numVertices, firstVertex, numInstances, firstInstance);
+        ValidateCopyCmd();
+        ValidateBufferTextureCopy(srcBufferDbg, srcOffset, dstTextureDbg, dstRegion, rowStride);
     }
-    
-    instance.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
-    
-    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
+
+    instance.CopyBufferToTexture(dstTextureDbg.instance, dstRegion, srcBufferDbg.instance, srcOffset, rowStride);
 }
 
-void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+void DbgCommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
 {
+    LLGL_DBG_PROFILER_SCOPE("Copy");
+
+    auto& dstBufferDbg  = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        AssertInstancingSupported();
-        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, 0, 0);
+        ValidateCopyCmd();
+        ValidateBufferTextureCopy(dstBufferDbg, dstOffset, srcTextureDbg, srcRegion, rowStride);
     }
-    
-    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
-    
-    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
+
+    instance.CopyTextureToBuffer(dstBufferDbg.instance, dstOffset, srcTextureDbg.instance, srcRegion, rowStride);
 }
 
-void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+/* ----- Secondary Command Buffers ----- */
+
+void DbgCommandBuffer::Begin()
 {
+    LLGL_DBG_PROFILER_SCOPE("Execute");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        AssertInstancingSupported();
-        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, 0);
+        if (!features_.hasSecondaryCommandBuffers)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("secondary command buffers");
     }
-    
-    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
-    
-    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::Begin, this));
+    instance.Begin();
 }
 
-void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+void DbgCommandBuffer::End()
 {
+    LLGL_DBG_PROFILER_SCOPE("Execute");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        AssertInstancingSupported();
-        AssertOffsetInstancingSupported();
-        ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        if (!features_.hasSecondaryCommandBuffers)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("secondary command buffers");
     }
-    
-    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
-    
-    LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numIndices, numInstances));
-}
 
-/* ----- Compute ----- */
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::End, this));
+    instance.End();
+}
 
-void DbgCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+void DbgCommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
 {
+    LLGL_DBG_PROFILER_SCOPE("Execute");
+
+    auto& secondaryCommandBufferDbg = LLGL_CAST(DbgCommandBuffer&, secondaryCommandBuffer);
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
 
-        if (groupSizeX * groupSizeY * groupSizeZ == 0)
-            LLGL_DBG_WARN(WarningType::PointlessOperation, "thread group size has volume of 0 units");
-
-        AssertComputePipelineBound();
-        ValidateThreadGroupLimit(groupSizeX, limits_.maxNumComputeShaderWorkGroups[0]);
-        ValidateThreadGroupLimit(groupSizeY, limits_.maxNumComputeShaderWorkGroups[1]);
-        ValidateThreadGroupLimit(groupSizeZ, limits_.maxNumComputeShaderWorkGroups[2]);
+        if (!features_.hasSecondaryCommandBuffers)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("secondary command buffers");
+        if (&secondaryCommandBufferDbg == this)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot execute command buffer within itself");
+        if (!bindings_.renderContext && !bindings_.renderTarget)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no render target is bound");
     }
-    
-    instance.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
-    
-    LLGL_DBG_PROFILER_DO(dispatchComputeCalls.Inc());
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::ExecuteCommands, this, &secondaryCommandBuffer));
+    instance.ExecuteCommands(secondaryCommandBufferDbg.instance);
+
+    /* All states of this command buffer are undefined after the secondary command buffer has been executed */
+    bindings_.vertexBuffers     = nullptr;
+    bindings_.numVertexBuffers  = 0;
+    bindings_.indexBuffer       = nullptr;
+    bindings_.graphicsPipeline  = nullptr;
+    bindings_.computePipeline   = nullptr;
 }
 
 
@@ -823,12 +2060,17 @@ void DbgCommandBuffer::ValidateDrawCmd(
 {
     AssertGraphicsPipelineBound();
     AssertVertexBufferBound();
-    ValidateVertexLayout();
-    ValidateNumVertices(numVertices);
     ValidateNumInstances(numInstances, firstInstance);
+    WarnInstanceableDraw(numVertices, numInstances);
 
-    if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
-        ValidateVertexLimit(numVertices + firstVertex, static_cast<std::uint32_t>(bindings_.vertexBuffers[0]->elements));
+    if (SampleDrawValidation())
+    {
+        ValidateVertexLayout();
+        ValidateNumVertices(numVertices);
+
+        if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
+            ValidateVertexLimit(numVertices + firstVertex, static_cast<std::uint32_t>(bindings_.numVertices));
+    }
 }
 
 void DbgCommandBuffer::ValidateDrawIndexedCmd(
@@ -837,12 +2079,89 @@ void DbgCommandBuffer::ValidateDrawIndexedCmd(
     AssertGraphicsPipelineBound();
     AssertVertexBufferBound();
     AssertIndexBufferBound();
-    ValidateVertexLayout();
-    ValidateNumVertices(numVertices);
     ValidateNumInstances(numInstances, firstInstance);
+    WarnInstanceableDraw(numVertices, numInstances);
+
+    if (SampleDrawValidation())
+    {
+        ValidateVertexLayout();
+        ValidateNumVertices(numVertices);
+
+        if (bindings_.indexBuffer)
+            ValidateVertexLimit(numVertices + firstIndex, static_cast<std::uint32_t>(bindings_.numIndices));
+    }
+}
 
-    if (bindings_.indexBuffer)
-        ValidateVertexLimit(numVertices + firstIndex, static_cast<std::uint32_t>(bindings_.indexBuffer->elements));
+void DbgCommandBuffer::ValidateDrawIndirectCmd(
+    DbgBuffer& bufferDbg, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride, std::uint32_t argumentSize)
+{
+    AssertIndirectDrawingSupported();
+    AssertGraphicsPipelineBound();
+    AssertVertexBufferBound();
+    WarnInstanceableDraw(0, 0);
+
+    if (SampleDrawValidation())
+    {
+        ValidateVertexLayout();
+        ValidateIndirectArguments(bufferDbg, offset, numCommands, stride, argumentSize);
+    }
+}
+
+void DbgCommandBuffer::ValidateIndirectArguments(
+    DbgBuffer& bufferDbg, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride, std::uint32_t argumentSize)
+{
+    if ((bufferDbg.desc.flags & BufferFlags::IndirectArguments) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer for indirect arguments was not created with the 'LLGL::BufferFlags::IndirectArguments' flag");
+    if (bufferDbg.mapped)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "buffer for indirect arguments used while being mapped to CPU local memory");
+
+    if (offset % 4 != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset of indirect arguments must be a multiple of 4, but " + std::to_string(offset) + " was specified");
+
+    if (numCommands == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "indirect command with zero draw commands");
+    else
+    {
+        if (numCommands > 1 && (stride < argumentSize || stride % 4 != 0))
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "stride of indirect arguments must be a multiple of 4 and at least " + std::to_string(argumentSize) +
+                ", but " + std::to_string(stride) + " was specified"
+            );
+        }
+
+        /* Validate that the last argument structure is within the buffer */
+        const auto requiredSize = offset + static_cast<std::uint64_t>(numCommands - 1) * stride + argumentSize;
+        if (requiredSize > bufferDbg.desc.size)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "indirect arguments out of bounds (" + std::to_string(requiredSize) +
+                " bytes required but buffer has " + std::to_string(bufferDbg.desc.size) + " bytes)"
+            );
+        }
+    }
+}
+
+void DbgCommandBuffer::ValidateDrawMeshTasksCmd()
+{
+    if (!features_.hasMeshShaders)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+
+    AssertGraphicsPipelineBound();
+    if (bindings_.graphicsPipeline)
+    {
+        auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, bindings_.graphicsPipeline->desc.shaderProgram);
+        if (!shaderProgramDbg->HasMeshShader())
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot draw mesh tasks with a graphics pipeline that has no mesh shader");
+    }
+}
+
+void DbgCommandBuffer::ValidateBuildAccelerationStructure(const DbgAccelerationStructure& accelerationStructureDbg)
+{
+    if (accelerationStructureDbg.desc.compactedSize > 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot build acceleration structure that has been created as destination of a compaction");
 }
 
 void DbgCommandBuffer::ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit)
@@ -889,12 +2208,255 @@ void DbgCommandBuffer::ValidateStageFlags(long stageFlags, long validFlags)
         LLGL_DBG_WARN(WarningType::PointlessOperation, "unknown shader stage flag is specified");
 }
 
+void DbgCommandBuffer::ValidateConstantsRange(std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    if (data == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "constants data must not be a null pointer");
+    if (offset % 4 != 0 || size % 4 != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset and size of constants must be multiples of 4");
+    if (offset + size > limits_.maxConstantsSize)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "constants range exceeded limit (" + std::to_string(offset + size) +
+            " specified but limit is " + std::to_string(limits_.maxConstantsSize) + ")"
+        );
+    }
+}
+
+void DbgCommandBuffer::ValidateTransientAllocation(std::uint64_t size, std::uint64_t alignment)
+{
+    if (size == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "size of transient memory allocation must not be zero");
+    if (size > g_transientRingSize)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "size of transient memory allocation exceeded ring size (" + std::to_string(size) +
+            " specified but limit is " + std::to_string(g_transientRingSize) + ")"
+        );
+    }
+    if ((alignment & (alignment - 1)) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "alignment of transient memory allocation must be a power of two");
+}
+
+void DbgCommandBuffer::ValidateDynamicOffsets(std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    if (numDynamicOffsets > 0 && dynamicOffsets == nullptr)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "dynamic offsets must not be a null pointer");
+        return;
+    }
+
+    const auto alignment = limits_.constantBufferOffsetAlignment;
+    for (std::uint32_t i = 0; i < numDynamicOffsets; ++i)
+    {
+        if (alignment > 0 && dynamicOffsets[i] % alignment != 0)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "dynamic offset " + std::to_string(dynamicOffsets[i]) + " is not a multiple of the constant buffer offset alignment (" +
+                std::to_string(alignment) + ")"
+            );
+        }
+    }
+}
+
 void DbgCommandBuffer::ValidateBufferType(const BufferType bufferType, const BufferType compareType)
 {
     if (bufferType != compareType)
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid buffer type");
 }
 
+void DbgCommandBuffer::ValidateQueryRange(const DbgQueryHeap& queryHeapDbg, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    const auto numHeapQueries = queryHeapDbg.desc.numQueries;
+    if (firstQuery >= numHeapQueries || numQueries > numHeapQueries - firstQuery)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "query range out of bounds (" + std::to_string(firstQuery) + " + " + std::to_string(numQueries) +
+            " specified but query heap has " + std::to_string(numHeapQueries) + " queries)"
+        );
+    }
+}
+
+void DbgCommandBuffer::ValidateDynamicState(long dynamicState, const char* stateName)
+{
+    if (!bindings_.graphicsPipeline)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot set dynamic " + std::string(stateName) + " without a bound graphics pipeline");
+    else if ((bindings_.graphicsPipeline->desc.dynamicStates & dynamicState) == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "dynamic " + std::string(stateName) + " is ignored by the bound graphics pipeline (missing dynamic state flag)");
+}
+
+void DbgCommandBuffer::ValidateViewMask(const DbgGraphicsPipeline& graphicsPipelineDbg)
+{
+    /* Multiview graphics pipelines can only be used with multiview render targets and vice versa */
+    const auto numViews = (bindings_.renderTarget != nullptr ? bindings_.renderTarget->GetDesc().numViews : 0u);
+    if (graphicsPipelineDbg.desc.viewMask != 0 && numViews <= 1)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot use multiview graphics pipeline with render target that has no multiple views");
+    else if (graphicsPipelineDbg.desc.viewMask == 0 && numViews > 1)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot use graphics pipeline without view mask with multiview render target");
+}
+
+void DbgCommandBuffer::ValidateBeginRenderCondition()
+{
+    if (states_.renderCondActive)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot begin render condition while another render condition is active");
+    states_.renderCondActive = true;
+}
+
+void DbgCommandBuffer::ValidateCopyCmd()
+{
+    if (states_.renderPassActive)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot copy resources while a render pass is active");
+}
+
+void DbgCommandBuffer::ValidateResolveRenderTarget(const DbgRenderTarget& renderTargetDbg, const DbgTexture& textureDbg, std::uint32_t colorAttachment)
+{
+    if (states_.renderPassActive)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot resolve render target while a render pass is active");
+
+    ValidateAttachmentLimit(colorAttachment, renderTargetDbg.GetNumColorAttachments());
+
+    /* Validate destination texture */
+    const auto& desc = textureDbg.desc;
+
+    if (IsMultiSampleTexture(desc.type) || desc.samples > 1)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot resolve render target into multi-sampled texture");
+
+    if ((desc.flags & TextureFlags::AttachmentUsage) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot resolve render target into texture that was not created with the 'LLGL::TextureFlags::AttachmentUsage' flag");
+
+    const auto& resolution = renderTargetDbg.GetResolution();
+    if (desc.extent.width < resolution.width || desc.extent.height < resolution.height)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination texture for render target resolve is smaller than the render target resolution");
+
+    /* Validate format of source color attachment */
+    std::uint32_t index = 0;
+    for (const auto& attachment : renderTargetDbg.GetDesc().attachments)
+    {
+        if (attachment.type == AttachmentType::Color)
+        {
+            if (index == colorAttachment)
+            {
+                if (auto texture = attachment.texture)
+                {
+                    auto textureDbg = LLGL_CAST(const DbgTexture*, texture);
+                    if (textureDbg->desc.format != desc.format)
+                        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot resolve render target into texture with different format");
+                }
+                break;
+            }
+            ++index;
+        }
+    }
+}
+
+void DbgCommandBuffer::ValidateBufferRange(const DbgBuffer& bufferDbg, std::uint64_t offset, std::uint64_t size, const char* bufferName)
+{
+    const auto bufferSize = bufferDbg.desc.size;
+    if (offset > bufferSize || size > bufferSize - offset)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            std::string(bufferName) + " buffer range out of bounds (" + std::to_string(offset) + " + " + std::to_string(size) +
+            " specified but buffer size is " + std::to_string(bufferSize) + ")"
+        );
+    }
+}
+
+void DbgCommandBuffer::ValidateBufferCounter(const DbgBuffer& bufferDbg)
+{
+    const auto& desc = bufferDbg.desc;
+    if (desc.type != BufferType::Storage ||
+        !(desc.storageBuffer.storageType == StorageBufferType::AppendStructuredBuffer ||
+          desc.storageBuffer.storageType == StorageBufferType::ConsumeStructuredBuffer))
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer has no hidden counter (must be an append or consume storage buffer)");
+    }
+}
+
+void DbgCommandBuffer::ValidateTextureRegion(const DbgTexture& textureDbg, std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, const char* textureName)
+{
+    if (mipLevel >= textureDbg.mipLevels)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            std::string(textureName) + " MIP-map level out of bounds (" + std::to_string(mipLevel) +
+            " specified but texture has " + std::to_string(textureDbg.mipLevels) + " MIP-map levels)"
+        );
+        return;
+    }
+
+    if (offset.x < 0 || offset.y < 0 || offset.z < 0)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, std::string(textureName) + " texture region must not have a negative offset");
+        return;
+    }
+
+    /* The extent of the MIP-map level includes the array layers (and cube faces) like the texture region */
+    const auto mipExtent = textureDbg.QueryMipExtent(mipLevel);
+    if (static_cast<std::uint32_t>(offset.x) + extent.width  > mipExtent.width  ||
+        static_cast<std::uint32_t>(offset.y) + extent.height > mipExtent.height ||
+        static_cast<std::uint32_t>(offset.z) + extent.depth  > mipExtent.depth)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, std::string(textureName) + " texture region exceeds the extent of MIP-map level " + std::to_string(mipLevel));
+    }
+
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, std::string(textureName) + " texture region is empty");
+}
+
+void DbgCommandBuffer::ValidateBufferTextureCopy(const DbgBuffer& bufferDbg, std::uint64_t offset, const DbgTexture& textureDbg, const TextureRegion& region, std::uint32_t rowStride)
+{
+    const auto format = textureDbg.desc.format;
+
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy texel data between buffer and texture with compressed or depth-stencil format");
+    if (IsMultiSampleTexture(textureDbg.GetType()))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy texel data between buffer and multi-sampled texture");
+
+    ValidateTextureRegion(textureDbg, region.mipLevel, region.offset, region.extent, "texture");
+
+    /* Validate layout of the texel data within the buffer */
+    const auto texelSize = FormatBitSize(format) / 8;
+    if (texelSize == 0)
+        return;
+
+    if (offset % texelSize != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer offset must be a multiple of the texel size (" + std::to_string(texelSize) + " bytes)");
+    if (rowStride % texelSize != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "row stride must be a multiple of the texel size (" + std::to_string(texelSize) + " bytes)");
+
+    const auto rowSize = static_cast<std::uint64_t>(region.extent.width) * texelSize;
+    if (rowStride != 0 && rowStride < rowSize)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "row stride must not be less than the size of a row of the texture region");
+
+    const auto rowPitch = (rowStride != 0 ? static_cast<std::uint64_t>(rowStride) : rowSize);
+    ValidateBufferRange(bufferDbg, offset, rowPitch * region.extent.height * region.extent.depth, "texel");
+}
+
+bool DbgCommandBuffer::SampleDrawValidation()
+{
+    const auto& sampling = debugger_->GetValidationSampling();
+
+    /* Select every N-th draw command */
+    if (sampling.drawInterval > 1 && (numDrawCmds_++ % sampling.drawInterval) != 0)
+        return false;
+
+    /* Select only the first K draw commands of each pipeline state combination */
+    if (sampling.maxStateValidations > 0)
+    {
+        auto& numValidations = stateValidations_[{ bindings_.graphicsPipeline, bindings_.graphicsResourceHeap }];
+        if (numValidations >= sampling.maxStateValidations)
+            return false;
+        ++numValidations;
+    }
+
+    return true;
+}
+
 void DbgCommandBuffer::AssertGraphicsPipelineBound()
 {
     if (!bindings_.graphicsPipeline)
@@ -950,6 +2512,51 @@ void DbgCommandBuffer::AssertOffsetInstancingSupported()
         LLGL_DBG_ERROR_NOT_SUPPORTED("offset-instancing");
 }
 
+void DbgCommandBuffer::ValidateBeginRenderPass(
+    const DbgRenderPass*    renderPassDbg,
+    std::uint32_t           numColorAttachments,
+    bool                    hasDepthStencil,
+    std::uint32_t           numClearValues,
+    const ClearValue*       clearValues)
+{
+    if (states_.renderPassActive)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot begin render pass while another render pass is active (missing call to 'EndRenderPass')");
+
+    if (numClearValues > 0 && clearValues == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "clear values must not be null if the number of clear values is non-zero");
+
+    if (renderPassDbg != nullptr)
+    {
+        const auto numRenderPassColorAttachments = static_cast<std::uint32_t>(renderPassDbg->desc.colorAttachments.size());
+        if (numRenderPassColorAttachments > numColorAttachments)
+        {
+            LLGL_DBG_WARN(
+                WarningType::ImproperArgument,
+                "render pass specifies more color attachments than the render target has (" + std::to_string(numRenderPassColorAttachments) +
+                " specified but render target has " + std::to_string(numColorAttachments) + ")"
+            );
+        }
+
+        const auto numClearAttachments = renderPassDbg->GetNumClearAttachments(numColorAttachments, hasDepthStencil);
+        if (numClearValues > numClearAttachments)
+        {
+            LLGL_DBG_WARN(
+                WarningType::PointlessOperation,
+                "too many clear values for render pass (" + std::to_string(numClearValues) +
+                " specified but only " + std::to_string(numClearAttachments) + " attachment(s) with clear operation)"
+            );
+        }
+    }
+    else if (numClearValues > 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "clear values are ignored for render pass without clear operations");
+}
+
+void DbgCommandBuffer::AssertIndirectDrawingSupported()
+{
+    if (!features_.hasIndirectDrawing)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("indirect drawing");
+}
+
 void DbgCommandBuffer::WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices)
 {
     LLGL_DBG_WARN(
@@ -959,6 +2566,63 @@ void DbgCommandBuffer::WarnImproperVertices(const std::string& topologyName, std
     );
 }
 
+// Maximal number of vertices of a draw command that is considered small enough for instancing
+static const std::uint32_t g_maxInstanceableVertices = 64;
+
+// Number of consecutive small draw commands after which a performance warning is posted
+static const std::uint32_t g_minInstanceableDraws = 16;
+
+void DbgCommandBuffer::WarnInstanceableDraw(std::uint32_t numVertices, std::uint32_t numInstances)
+{
+    perf_.clearPending = false;
+
+    if (numInstances == 1 && numVertices > 0 && numVertices <= g_maxInstanceableVertices && numVertices == perf_.drawVertices)
+    {
+        if (++perf_.drawSequence == g_minInstanceableDraws)
+        {
+            LLGL_DBG_WARN(
+                WarningType::Performance,
+                std::to_string(g_minInstanceableDraws) + " or more consecutive draw commands with the same small number of vertices; consider instancing"
+            );
+        }
+    }
+    else
+        perf_.drawSequence = 1;
+
+    perf_.drawVertices = (numInstances == 1 ? numVertices : 0);
+}
+
+void DbgCommandBuffer::WarnClearAfterRenderPass()
+{
+    if (perf_.clearPending)
+    {
+        LLGL_DBG_WARN(
+            WarningType::Performance,
+            "clear command at the beginning of a render pass without clear operations; consider AttachmentLoadOp::Clear in the render pass"
+        );
+        perf_.clearPending = false;
+    }
+}
+
+static bool HasAnyClearOp(const RenderPassDescriptor& desc)
+{
+    for (const auto& attachment : desc.colorAttachments)
+    {
+        if (attachment.loadOp == AttachmentLoadOp::Clear)
+            return true;
+    }
+    return (desc.depthAttachment.loadOp == AttachmentLoadOp::Clear || desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear);
+}
+
+void DbgCommandBuffer::BeginPerformanceScope(const DbgRenderPass* renderPassDbg)
+{
+    /* Bindings are not redundant across render passes for all backends, so only track them within a render pass */
+    perf_ = Performance{};
+
+    /* Clear commands are the only way to clear attachments without explicit render pass */
+    perf_.clearPending = (renderPassDbg != nullptr && !HasAnyClearOp(renderPassDbg->desc));
+}
+
 
 } // /namespace LLGL
 
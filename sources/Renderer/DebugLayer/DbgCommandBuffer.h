@@ -15,6 +15,9 @@
 
 #include "DbgGraphicsPipeline.h"
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
 
 
 namespace LLGL
@@ -22,8 +25,14 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgTexture;
 class DbgRenderContext;
 class DbgRenderTarget;
+class DbgQueryHeap;
+class DbgRenderPass;
+class DbgCapture;
+class DbgAccelerationStructure;
+class RenderSystem;
 
 class DbgCommandBuffer : public CommandBufferExt
 {
@@ -33,10 +42,12 @@ class DbgCommandBuffer : public CommandBufferExt
         /* ----- Common ----- */
 
         DbgCommandBuffer(
+            RenderSystem& renderSystemInstance,
             CommandBuffer& instance,
             CommandBufferExt* instanceExt,
             RenderingProfiler* profiler,
             RenderingDebugger* debugger,
+            DbgCapture* capture,
             const RenderingCapabilities& caps
         );
 
@@ -64,14 +75,24 @@ class DbgCommandBuffer : public CommandBufferExt
         /* ----- Input Assembly ------ */
 
         void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
         void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
 
         /* ----- Constant Buffers ------ */
 
         void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
 
+        void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
         /* ----- Storage Buffers ------ */
 
         void SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
@@ -84,6 +105,9 @@ class DbgCommandBuffer : public CommandBufferExt
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
@@ -94,19 +118,65 @@ class DbgCommandBuffer : public CommandBufferExt
 
         /* ----- Resource View Heaps ----- */
 
-        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
-        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
 
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
@@ -118,6 +188,28 @@ class DbgCommandBuffer : public CommandBufferExt
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
         /* ----- Drawing ----- */
 
         void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
@@ -132,9 +224,68 @@ class DbgCommandBuffer : public CommandBufferExt
         void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
         void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
 
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
 
         /* ----- Debugging members ----- */
 
@@ -157,12 +308,42 @@ class DbgCommandBuffer : public CommandBufferExt
         void ValidateDrawCmd(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance);
         void ValidateDrawIndexedCmd(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance);
 
+        void ValidateDrawIndirectCmd(DbgBuffer& bufferDbg, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride, std::uint32_t argumentSize);
+        void ValidateIndirectArguments(DbgBuffer& bufferDbg, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride, std::uint32_t argumentSize);
+        void ValidateDrawMeshTasksCmd();
+        void ValidateBuildAccelerationStructure(const DbgAccelerationStructure& accelerationStructureDbg);
+
+        void ValidateBeginRenderPass(
+            const DbgRenderPass*    renderPassDbg,
+            std::uint32_t           numColorAttachments,
+            bool                    hasDepthStencil,
+            std::uint32_t           numClearValues,
+            const ClearValue*       clearValues
+        );
+
         void ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit);
         void ValidateThreadGroupLimit(std::uint32_t size, std::uint32_t limit);
         void ValidateAttachmentLimit(std::uint32_t attachmentIndex, std::uint32_t attachmentUpperBound);
 
         void ValidateStageFlags(long stageFlags, long validFlags);
+        void ValidateConstantsRange(std::uint32_t offset, std::uint32_t size, const void* data);
+        void ValidateTransientAllocation(std::uint64_t size, std::uint64_t alignment);
+        void ValidateDynamicOffsets(std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
         void ValidateBufferType(const BufferType bufferType, const BufferType compareType);
+        void ValidateQueryRange(const DbgQueryHeap& queryHeapDbg, std::uint32_t firstQuery, std::uint32_t numQueries);
+        void ValidateBeginRenderCondition();
+        void ValidateDynamicState(long dynamicState, const char* stateName);
+        void ValidateViewMask(const DbgGraphicsPipeline& graphicsPipelineDbg);
+
+        void ValidateCopyCmd();
+        void ValidateResolveRenderTarget(const DbgRenderTarget& renderTargetDbg, const DbgTexture& textureDbg, std::uint32_t colorAttachment);
+        void ValidateBufferRange(const DbgBuffer& bufferDbg, std::uint64_t offset, std::uint64_t size, const char* bufferName);
+        void ValidateBufferCounter(const DbgBuffer& bufferDbg);
+        void ValidateTextureRegion(const DbgTexture& textureDbg, std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, const char* textureName);
+        void ValidateBufferTextureCopy(const DbgBuffer& bufferDbg, std::uint64_t offset, const DbgTexture& textureDbg, const TextureRegion& region, std::uint32_t rowStride);
+
+        // Returns true if the current draw command is selected for full validation, see ValidationSamplingDescriptor.
+        bool SampleDrawValidation();
 
         void AssertGraphicsPipelineBound();
         void AssertComputePipelineBound();
@@ -171,13 +352,24 @@ class DbgCommandBuffer : public CommandBufferExt
 
         void AssertInstancingSupported();
         void AssertOffsetInstancingSupported();
+        void AssertIndirectDrawingSupported();
 
         void WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices);
 
+        // Tracks consecutive non-instanced draw commands with the same small number of vertices, which could be merged into a single instanced draw command.
+        void WarnInstanceableDraw(std::uint32_t numVertices, std::uint32_t numInstances);
+
+        // Warns about a clear command at the beginning of a render pass, whose attachments could have been cleared by its load operations.
+        void WarnClearAfterRenderPass();
+
+        void BeginPerformanceScope(const DbgRenderPass* renderPassDbg);
+
         /* ----- Common objects ----- */
 
+        RenderSystem&                   renderSystemInstance_;  // Calibrates the timestamps of timer scopes for the profiler
         RenderingProfiler*              profiler_               = nullptr;
         RenderingDebugger*              debugger_               = nullptr;
+        DbgCapture*                     capture_                = nullptr;
 
         //const RenderingCapabilities&    caps_;
         const RenderingFeatures&        features_;
@@ -196,19 +388,43 @@ class DbgCommandBuffer : public CommandBufferExt
             std::uint32_t           numVertexBuffers        = 0;
             bool                    anyNonEmptyVertexBuffer = false;
             bool                    anyShaderAttributes     = false;
+            std::uint64_t           numVertices             = 0;        // Number of vertices in the first vertex buffer behind its binding offset
             DbgBuffer*              indexBuffer             = nullptr;
+            std::uint64_t           numIndices              = 0;        // Number of indices in the index buffer behind its binding offset
             DbgBuffer*              streamOutput            = nullptr;
             DbgGraphicsPipeline*    graphicsPipeline        = nullptr;
             ComputePipeline*        computePipeline         = nullptr;
+            ResourceHeap*           graphicsResourceHeap    = nullptr;
         }
         bindings_;
 
         struct States
         {
-            bool streamOutputBusy = false;
+            bool            streamOutputBusy    = false;
+            bool            streamOutputPaused  = false;
+            std::uint32_t   timerScopeDepth     = 0;
+            std::uint32_t   debugGroupDepth     = 0;
+            bool            renderPassActive    = false;
+            bool            renderCondActive    = false;
         }
         states_;
 
+        // States for performance warnings; these are reset at the beginning of each render pass.
+        struct Performance
+        {
+            const void*     graphicsPipeline        = nullptr;
+            const void*     graphicsResourceHeap    = nullptr;
+            std::uint32_t   graphicsResourceSet     = 0;
+            std::uint32_t   drawVertices            = 0;
+            std::uint32_t   drawSequence            = 0;
+            bool            clearPending            = false;    // True if the active render pass has no clear operations and no commands have been recorded yet
+        }
+        perf_;
+
+        std::uint64_t                                                   numDrawCmds_        = 0;
+        std::map<std::pair<const void*, const void*>, std::uint32_t>    stateValidations_;  // Number of full validations per graphics pipeline and resource heap
+        std::map<const Buffer*, std::unique_ptr<DbgBuffer>>             transientBuffers_;  // Wrappers of the transient ring buffers of the instance
+
 };
 
 
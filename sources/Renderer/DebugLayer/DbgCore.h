@@ -21,6 +21,13 @@ namespace LLGL
     if (profiler_)                  \
         profiler_->EXPR
 
+#define LLGL_DBG_PROFILER_SCOPE(CATEGORY) \
+    DbgProfilerScope profilerScope_(profiler_, __FUNCTION__, (CATEGORY))
+
+#define LLGL_DBG_CAPTURE(EXPR)  \
+    if (capture_)               \
+        capture_->EXPR
+
 #define LLGL_DBG_SOURCE \
     DbgSetSource(debugger_, __FUNCTION__)
 
@@ -52,6 +59,39 @@ inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const
         debugger->PostWarning(type, message);
 }
 
+// Records a CPU event for the lifetime of this scope, if the event log of the profiler is enabled.
+class DbgProfilerScope
+{
+
+    public:
+
+        DbgProfilerScope(RenderingProfiler* profiler, const char* name, const char* category) :
+            profiler_ { (profiler != nullptr && profiler->IsEventLogEnabled() ? profiler : nullptr) },
+            name_     { name                                                                          },
+            category_ { category                                                                      }
+        {
+            if (profiler_)
+                startTime_ = profiler_->GetTimestamp();
+        }
+
+        ~DbgProfilerScope()
+        {
+            if (profiler_)
+                profiler_->RecordEvent(name_, category_, startTime_, profiler_->GetTimestamp());
+        }
+
+        DbgProfilerScope(const DbgProfilerScope&) = delete;
+        DbgProfilerScope& operator = (const DbgProfilerScope&) = delete;
+
+    private:
+
+        RenderingProfiler*  profiler_   = nullptr;
+        const char*         name_       = nullptr;
+        const char*         category_   = nullptr;
+        std::uint64_t       startTime_  = 0;
+
+};
+
 
 } // /namespace LLGL
 
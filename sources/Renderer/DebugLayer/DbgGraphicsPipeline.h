@@ -27,6 +27,11 @@ class DbgGraphicsPipeline : public GraphicsPipeline
         {
         }
 
+        bool IsReady() const override
+        {
+            return instance.IsReady();
+        }
+
         GraphicsPipeline&                   instance;
         const GraphicsPipelineDescriptor    desc;
 
@@ -0,0 +1,44 @@
+/*
+ * DbgIndirectCommandLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_INDIRECT_COMMAND_LAYOUT_H
+#define LLGL_DBG_INDIRECT_COMMAND_LAYOUT_H
+
+
+#include <LLGL/IndirectCommandLayout.h>
+
+
+namespace LLGL
+{
+
+
+class DbgIndirectCommandLayout : public IndirectCommandLayout
+{
+
+    public:
+
+        DbgIndirectCommandLayout(IndirectCommandLayout& instance, const IndirectCommandLayoutDescriptor& desc) :
+            IndirectCommandLayout { desc     },
+            instance              { instance },
+            desc                  { desc     }
+        {
+        }
+
+        IndirectCommandLayout&          instance;
+        IndirectCommandLayoutDescriptor desc;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,44 @@
+/*
+ * DbgQueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_QUERY_HEAP_H
+#define LLGL_DBG_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+
+
+namespace LLGL
+{
+
+
+class DbgQueryHeap : public QueryHeap
+{
+
+    public:
+
+        DbgQueryHeap(QueryHeap& instance, const QueryHeapDescriptor& desc) :
+            QueryHeap { desc     },
+            instance  { instance },
+            desc      { desc     }
+        {
+        }
+
+        QueryHeap&          instance;
+        QueryHeapDescriptor desc;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
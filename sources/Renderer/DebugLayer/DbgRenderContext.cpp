@@ -6,21 +6,53 @@
  */
 
 #include "DbgRenderContext.h"
+#include "DbgCore.h"
+#include "DbgCapture.h"
 
 
 namespace LLGL
 {
 
 
-DbgRenderContext::DbgRenderContext(RenderContext& instance) :
-    instance { instance }
+DbgRenderContext::DbgRenderContext(RenderContext& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, DbgCapture* capture, std::uint64_t& frameIndex) :
+    instance    { instance   },
+    profiler_   { profiler   },
+    debugger_   { debugger   },
+    capture_    { capture    },
+    frameIndex_ { frameIndex }
 {
     ShareSurfaceAndConfig(instance);
 }
 
 void DbgRenderContext::Present()
 {
-    instance.Present();
+    LLGL_DBG_CAPTURE(Present(this));
+    {
+        LLGL_DBG_PROFILER_SCOPE("Present");
+        instance.Present();
+    }
+
+    /* Record when previous frames reached the display, so the display timeline lines up with the CPU and GPU timelines */
+    if (profiler_ != nullptr && profiler_->IsEventLogEnabled())
+    {
+        FrameStatistics frameStats;
+        if (QueryFrameStatistics(frameStats))
+            profiler_->RecordFrameStatistics(frameStats);
+    }
+
+    LLGL_DBG_PROFILER_DO(NextFrame());
+
+    ++frameIndex_;
+
+    /* Merge messages that have been posted by all threads during this frame */
+    if (debugger_)
+        debugger_->FlushMessages();
+}
+
+void DbgRenderContext::WaitForNextFrame()
+{
+    LLGL_DBG_PROFILER_SCOPE("WaitForNextFrame");
+    instance.WaitForNextFrame();
 }
 
 Format DbgRenderContext::QueryColorFormat() const
@@ -52,6 +84,11 @@ bool DbgRenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
     return result;
 }
 
+bool DbgRenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    return instance.QueryFrameStatistics(frameStats);
+}
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/RenderContext.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/RenderingDebugger.h>
 
 
 namespace LLGL
@@ -17,6 +19,7 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgCapture;
 
 class DbgRenderContext : public RenderContext
 {
@@ -25,9 +28,10 @@ class DbgRenderContext : public RenderContext
 
         /* ----- Common ----- */
 
-        DbgRenderContext(RenderContext& instance);
+        DbgRenderContext(RenderContext& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, DbgCapture* capture, std::uint64_t& frameIndex);
 
         void Present() override;
+        void WaitForNextFrame() override;
 
         Format QueryColorFormat() const override;
         Format QueryDepthStencilFormat() const override;
@@ -40,6 +44,12 @@ class DbgRenderContext : public RenderContext
 
         bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+        bool OnQueryFrameStatistics(FrameStatistics& frameStats) override;
+
+        RenderingProfiler* profiler_ = nullptr;
+        RenderingDebugger* debugger_ = nullptr;
+        DbgCapture*        capture_  = nullptr;
+        std::uint64_t&     frameIndex_;             // Frame index of the render system, which is shared by all render contexts
 
 };
 
@@ -0,0 +1,44 @@
+/*
+ * DbgRenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_RENDER_PASS_H
+#define LLGL_DBG_RENDER_PASS_H
+
+
+#include <LLGL/RenderPass.h>
+
+
+namespace LLGL
+{
+
+
+class DbgRenderPass : public RenderPass
+{
+
+    public:
+
+        DbgRenderPass(RenderPass& instance, const RenderPassDescriptor& desc) :
+            RenderPass { desc     },
+            instance   { instance },
+            desc       { desc     }
+        {
+        }
+
+        RenderPass&             instance;
+        RenderPassDescriptor    desc;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
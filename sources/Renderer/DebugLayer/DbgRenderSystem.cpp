@@ -9,6 +9,8 @@
 #include "DbgCore.h"
 #include "../../Core/Helper.h"
 #include "../CheckedCast.h"
+#include <algorithm>
+#include <map>
 
 
 namespace LLGL
@@ -25,7 +27,10 @@ All the actual render system objects are stored in the members named "instance",
 */
 
 DbgRenderSystem::DbgRenderSystem(
-    const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger) :
+    const std::shared_ptr<RenderSystem>&    instance,
+    RenderingProfiler*                      profiler,
+    RenderingDebugger*                      debugger,
+    const std::string&                      captureFilename) :
         instance_ { instance           },
         profiler_ { profiler           },
         debugger_ { debugger           },
@@ -33,10 +38,15 @@ DbgRenderSystem::DbgRenderSystem(
         features_ { caps_.features     },
         limits_   { caps_.limits       }
 {
+    if (!captureFilename.empty())
+        capture_ = MakeUnique<DbgCapture>(captureFilename);
 }
 
 DbgRenderSystem::~DbgRenderSystem()
 {
+    /* Report messages that have been posted after the last presentation */
+    if (debugger_)
+        debugger_->FlushMessages();
 }
 
 void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
@@ -53,8 +63,13 @@ RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescripto
 
     SetRendererInfo(instance_->GetRendererInfo());
     SetRenderingCaps(instance_->GetRenderingCaps());
+    SetVideoAdapters(instance_->GetVideoAdapters());
 
-    return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance));
+    return CaptureCreate(
+        CaptureOpcode::CreateRenderContext,
+        TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance, profiler_, debugger_, capture_.get(), frameIndex_)),
+        desc
+    );
 }
 
 void DbgRenderSystem::Release(RenderContext& renderContext)
@@ -69,22 +84,57 @@ CommandQueue* DbgRenderSystem::GetCommandQueue()
     return instance_->GetCommandQueue();
 }
 
+CommandQueue* DbgRenderSystem::GetCommandQueue(const QueueType type)
+{
+    return instance_->GetCommandQueue(type);
+}
+
 /* ----- Command buffers ----- */
 
-CommandBuffer* DbgRenderSystem::CreateCommandBuffer()
+CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
-        *instance_->CreateCommandBuffer(), nullptr, profiler_, debugger_, GetRenderingCaps()
-    ));
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (desc.queueType == QueueType::Compute && !features_.hasComputeQueue)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("compute queue");
+        if (desc.queueType == QueueType::Background && !features_.hasBackgroundQueue)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("background queue");
+    }
+
+    return CaptureCreate(
+        CaptureOpcode::CreateCommandBuffer,
+        TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
+            *instance_, *instance_->CreateCommandBuffer(desc), nullptr, profiler_, debugger_, capture_.get(), GetRenderingCaps()
+        )),
+        desc
+    );
 }
 
 CommandBufferExt* DbgRenderSystem::CreateCommandBufferExt()
 {
     if (auto instance = instance_->CreateCommandBufferExt())
     {
-        return TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
-            *instance, instance, profiler_, debugger_, GetRenderingCaps()
-        ));
+        return CaptureCreate(
+            CaptureOpcode::CreateCommandBufferExt,
+            TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
+                *instance_, *instance, instance, profiler_, debugger_, capture_.get(), GetRenderingCaps()
+            ))
+        );
+    }
+    return nullptr;
+}
+
+CommandBuffer* DbgRenderSystem::CreateSecondaryCommandBuffer()
+{
+    if (auto instance = instance_->CreateSecondaryCommandBuffer())
+    {
+        return CaptureCreate(
+            CaptureOpcode::CreateSecondaryCommandBuffer,
+            TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
+                *instance_, *instance, nullptr, profiler_, debugger_, capture_.get(), GetRenderingCaps()
+            ))
+        );
     }
     return nullptr;
 }
@@ -115,7 +165,17 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void*
     bufferDbg->elements     = (formatSize > 0 ? desc.size / formatSize : 0);
     bufferDbg->initialized  = (initialData != nullptr);
 
-    return TakeOwnership(buffers_, std::move(bufferDbg));
+    auto bufferDbgRef = TakeOwnership(buffers_, std::move(bufferDbg));
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::CreateBuffer };
+        record.encoder.Descriptor(desc);
+        record.encoder.Blob(initialData, (initialData != nullptr ? static_cast<std::size_t>(desc.size) : 0));
+        record.encoder.AddObject(bufferDbgRef);
+    }
+
+    return bufferDbgRef;
 }
 
 BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
@@ -142,7 +202,18 @@ BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer
     /* Store buffer references */
     bufferArrayDbg->buffers = std::move(bufferDbgArray);
 
-    return TakeOwnership(bufferArrays_, std::move(bufferArrayDbg));
+    auto bufferArrayDbgRef = TakeOwnership(bufferArrays_, std::move(bufferArrayDbg));
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::CreateBufferArray };
+        record.encoder.Value(numBuffers);
+        for (auto bufferDbg : bufferArrayDbgRef->buffers)
+            record.encoder.Object(bufferDbg);
+        record.encoder.AddObject(bufferArrayDbgRef);
+    }
+
+    return bufferArrayDbgRef;
 }
 
 void DbgRenderSystem::Release(Buffer& buffer)
@@ -157,6 +228,8 @@ void DbgRenderSystem::Release(BufferArray& bufferArray)
 
 void DbgRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_DBG_PROFILER_SCOPE("Buffer");
+
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
     if (debugger_)
@@ -174,15 +247,21 @@ void DbgRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t
 
         if (!data)
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'data' parameter");
+
+        WarnBufferWrite(bufferDbg);
     }
 
     instance_->WriteBuffer(bufferDbg.instance, data, dataSize, offset);
 
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::WriteBuffer, &buffer, static_cast<std::uint64_t>(offset), DbgCaptureData{ data, dataSize }));
+
     LLGL_DBG_PROFILER_DO(writeBuffer.Inc());
 }
 
 void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_DBG_PROFILER_SCOPE("Buffer");
+
     void* result = nullptr;
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
@@ -191,12 +270,43 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
         LLGL_DBG_SOURCE;
         ValidateBufferCPUAccess(bufferDbg, access);
         ValidateBufferMapping(bufferDbg, true);
+        WarnBufferReadback(bufferDbg, access);
     }
 
     result = instance_->MapBuffer(bufferDbg.instance, access);
 
     bufferDbg.mapped = true;
 
+    if (capture_)
+        bufferDbg.mappedRange = { result, 0, bufferDbg.desc.size, access };
+
+    LLGL_DBG_PROFILER_DO(mapBuffer.Inc());
+    return result;
+}
+
+void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    LLGL_DBG_PROFILER_SCOPE("Buffer");
+
+    void* result = nullptr;
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferCPUAccess(bufferDbg, access);
+        ValidateBufferMapping(bufferDbg, true);
+        ValidateBufferBoundary(bufferDbg.desc.size, static_cast<std::size_t>(length), static_cast<std::size_t>(offset));
+        WarnBufferReadback(bufferDbg, access);
+    }
+
+    result = instance_->MapBuffer(bufferDbg.instance, access, offset, length);
+
+    bufferDbg.mapped = true;
+
+    if (capture_)
+        bufferDbg.mappedRange = { result, offset, length, access };
+
     LLGL_DBG_PROFILER_DO(mapBuffer.Inc());
     return result;
 }
@@ -211,11 +321,55 @@ void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
         ValidateBufferMapping(bufferDbg, false);
     }
 
+    /* Record the mapped memory as buffer update, since it might have been modified by the client programmer */
+    if (capture_)
+    {
+        const auto& range = bufferDbg.mappedRange;
+        if (range.data != nullptr && range.access != CPUAccess::ReadOnly)
+        {
+            capture_->Record(
+                CaptureOpcode::WriteBuffer, &buffer, range.offset, DbgCaptureData{ range.data, static_cast<std::size_t>(range.length) }
+            );
+        }
+        bufferDbg.mappedRange = {};
+    }
+
     instance_->UnmapBuffer(bufferDbg.instance);
 
     bufferDbg.mapped = false;
 }
 
+std::uint32_t DbgRenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
+{
+    LLGL_DBG_PROFILER_SCOPE("Buffer");
+
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferBoundary(bufferDbg.desc.size, static_cast<std::size_t>(size), static_cast<std::size_t>(offset));
+        if (bufferDbg.mapped)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot read buffer asynchronously while it is mapped to CPU local memory");
+        if (size == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "asynchronous buffer readback with zero size");
+    }
+
+    return instance_->ReadBufferAsync(bufferDbg.instance, offset, size, fence);
+}
+
+void DbgRenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (data == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "output data must not be null for buffer readback");
+    }
+
+    instance_->ReadBufferAsyncResult(readback, data, dataSize);
+}
+
 /* ----- Textures ----- */
 
 Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
@@ -224,8 +378,69 @@ Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, co
     {
         LLGL_DBG_SOURCE;
         ValidateTextureDesc(textureDesc);
+        if ((textureDesc.flags & TextureFlags::Sparse) != 0)
+            ValidateSparseTextureDesc(textureDesc, imageDesc);
+        if ((textureDesc.flags & TextureFlags::Transient) != 0)
+            ValidateTransientTextureDesc(textureDesc, imageDesc);
+        if (imageDesc != nullptr && imageDesc->mipLevels > NumMipLevels(textureDesc))
+        {
+            LLGL_DBG_WARN(
+                WarningType::ImproperArgument,
+                "initial image data contains more MIP-map levels than the texture (" + std::to_string(imageDesc->mipLevels) +
+                " specified but texture has " + std::to_string(NumMipLevels(textureDesc)) + ")"
+            );
+        }
+    }
+
+    auto textureDbg = TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::CreateTexture };
+        record.encoder.Descriptor(textureDesc);
+        record.encoder.Descriptor(imageDesc);
+        record.encoder.AddObject(textureDbg);
+    }
+
+    return textureDbg;
+}
+
+Texture* DbgRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureDbg = LLGL_CAST(DbgTexture&, sharedTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureViewDesc(sharedTextureDbg, textureViewDesc);
+    }
+
+    /* Derive texture descriptor of the subresource the view refers to */
+    auto desc = sharedTextureDbg.desc;
+    {
+        const auto baseMipLevel = textureViewDesc.subresource.baseMipLevel;
+        desc.type           = textureViewDesc.type;
+        desc.format         = textureViewDesc.format;
+        desc.extent.width   = std::max(1u, desc.extent.width  >> baseMipLevel);
+        desc.extent.height  = std::max(1u, desc.extent.height >> baseMipLevel);
+        desc.extent.depth   = std::max(1u, desc.extent.depth  >> baseMipLevel);
+        desc.arrayLayers    = textureViewDesc.subresource.numArrayLayers;
+        desc.mipLevels      = textureViewDesc.subresource.numMipLevels;
+    }
+    auto textureDbg = MakeUnique<DbgTexture>(*instance_->CreateTextureView(sharedTextureDbg.instance, textureViewDesc), desc);
+    textureDbg->isView = true;
+
+    auto textureDbgRef = TakeOwnership(textures_, std::move(textureDbg));
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::CreateTextureView };
+        record.encoder.Object(&sharedTexture);
+        record.encoder.Descriptor(textureViewDesc);
+        record.encoder.AddObject(textureDbgRef);
     }
-    return TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+
+    return textureDbgRef;
 }
 
 void DbgRenderSystem::Release(Texture& texture)
@@ -240,10 +455,87 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor&
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
         ValidateMipLevelLimit(subTextureDesc.mipLevel, textureDbg.mipLevels);
+        if (IsCompressedFormat(textureDbg.desc.format) && subTextureDesc.mipLevel < textureDbg.mipLevels)
+            ValidateTextureBlockAlignment(textureDbg, subTextureDesc);
     }
 
     instance_->WriteTexture(textureDbg.instance, subTextureDesc, imageDesc);
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::WriteTexture };
+        record.encoder.Object(&texture);
+        record.encoder.Value(subTextureDesc);
+        record.encoder.Descriptor(&imageDesc);
+    }
+}
+
+void DbgRenderSystem::WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            const auto& subTextureDesc = regions[i].subTexture;
+            ValidateMipLevelLimit(subTextureDesc.mipLevel, textureDbg.mipLevels);
+            if (IsCompressedFormat(textureDbg.desc.format) && subTextureDesc.mipLevel < textureDbg.mipLevels)
+                ValidateTextureBlockAlignment(textureDbg, subTextureDesc);
+        }
+    }
+
+    instance_->WriteTextureRegions(textureDbg.instance, numRegions, regions);
+
+    if (capture_)
+    {
+        /* Record each region as individual texture write, since replaying them in order yields the same texture content */
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            DbgCaptureRecord record { *capture_, CaptureOpcode::WriteTexture };
+            record.encoder.Object(&texture);
+            record.encoder.Value(regions[i].subTexture);
+            record.encoder.Descriptor(&(regions[i].image));
+        }
+    }
+}
+
+TextureUploadMemory DbgRenderSystem::BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (uploadTexture_ != nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot begin texture upload while another texture upload is in progress");
+        ValidateTextureNoView(textureDbg);
+        ValidateMipLevelLimit(subTextureDesc.mipLevel, textureDbg.mipLevels);
+        if (IsCompressedFormat(textureDbg.desc.format) && subTextureDesc.mipLevel < textureDbg.mipLevels)
+            ValidateTextureBlockAlignment(textureDbg, subTextureDesc);
+    }
+
+    auto memory = instance_->BeginTextureUpload(textureDbg.instance, subTextureDesc);
+    uploadTexture_ = (&textureDbg);
+
+    return memory;
+}
+
+void DbgRenderSystem::EndTextureUpload()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (uploadTexture_ == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot end texture upload without a preceding call to BeginTextureUpload");
+    }
+
+    instance_->EndTextureUpload();
+    uploadTexture_ = nullptr;
 }
 
 void DbgRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
@@ -253,6 +545,7 @@ void DbgRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
 
         /* Validate MIP-level */
         ValidateMipLevelLimit(mipLevel, textureDbg.mipLevels);
@@ -274,6 +567,32 @@ void DbgRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel
     instance_->ReadTexture(textureDbg.instance, mipLevel, imageDesc);
 }
 
+std::uint32_t DbgRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
+        ValidateTextureReadbackRegion(textureDbg, region);
+    }
+
+    return instance_->ReadTextureAsync(textureDbg.instance, region, fence);
+}
+
+void DbgRenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (imageDesc.data == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "output image data must not be null for texture readback");
+    }
+
+    instance_->ReadTextureAsyncResult(readback, imageDesc);
+}
+
 void DbgRenderSystem::GenerateMips(Texture& texture)
 {
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
@@ -281,11 +600,14 @@ void DbgRenderSystem::GenerateMips(Texture& texture)
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
         if (ValidateTextureMips(textureDbg))
             ValidateTextureMipRange(textureDbg, 0, textureDbg.mipLevels);
     }
 
     instance_->GenerateMips(textureDbg.instance);
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::GenerateMips, &texture));
 }
 
 void DbgRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
@@ -295,6 +617,7 @@ void DbgRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        ValidateTextureNoView(textureDbg);
         if (ValidateTextureMips(textureDbg))
         {
             ValidateTextureMipRange(textureDbg, baseMipLevel, numMipLevels);
@@ -303,18 +626,62 @@ void DbgRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
     }
 
     instance_->GenerateMips(textureDbg.instance, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+
+    LLGL_DBG_CAPTURE(Record(CaptureOpcode::GenerateMipsRange, &texture, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers));
+}
+
+bool DbgRenderSystem::QuerySparseTileShape(const Format format, const TextureType type, Extent3D& tileShape)
+{
+    return instance_->QuerySparseTileShape(format, type, tileShape);
+}
+
+void DbgRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& region, bool commit)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureTileRegion(textureDbg, region);
+    }
+
+    instance_->CommitTextureTiles(textureDbg.instance, region, commit);
+}
+
+void DbgRenderSystem::SetTextureMinLOD(Texture& texture, float minLOD)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!features_.hasTextureMinLOD)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("texture min-LOD clamping");
+        if (textureDbg.isView)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot clamp level of detail of texture view");
+        if (minLOD < 0.0f || minLOD > static_cast<float>(textureDbg.mipLevels - 1))
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "texture min-LOD out of range (" + std::to_string(minLOD) + " specified, but range is [0, " + std::to_string(textureDbg.mipLevels - 1) + "])"
+            );
+        }
+    }
+
+    instance_->SetTextureMinLOD(textureDbg.instance, minLOD);
 }
 
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return instance_->CreateSampler(desc);
+    return CaptureCreate(CaptureOpcode::CreateSampler, instance_->CreateSampler(desc), desc);
     //return TakeOwnership(samplers_, MakeUnique<DbgSampler>());
 }
 
 void DbgRenderSystem::Release(Sampler& sampler)
 {
+    LLGL_DBG_CAPTURE(Release(&sampler));
     instance_->Release(sampler);
     //RemoveFromUniqueSet(samplers_, &sampler);
 }
@@ -326,45 +693,53 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
     auto instanceDesc = desc;
     {
         for (auto& resourceView : instanceDesc.resourceViews)
-        {
-            if (auto resource = resourceView.resource)
-            {
-                switch (resource->QueryResourceType())
-                {
-                    case ResourceType::VertexBuffer:
-                    case ResourceType::IndexBuffer:
-                    case ResourceType::ConstantBuffer:
-                    case ResourceType::StorageBuffer:
-                    case ResourceType::StreamOutputBuffer:
-                        resourceView.resource = &(LLGL_CAST(DbgBuffer*, resourceView.resource)->instance);
-                        break;
-                    case ResourceType::Texture:
-                        resourceView.resource = &(LLGL_CAST(DbgTexture*, resourceView.resource)->instance);
-                        break;
-                    case ResourceType::Sampler:
-                        //TODO: DbgSampler
-                        break;
-                    default:
-                        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid resource type passed to ResourceViewDescriptor");
-                        break;
-                }
-            }
-            else
-                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to ResourceViewDescriptor");
-        }
+            ConvertResourceViewToInstance(resourceView);
     }
-    return instance_->CreateResourceHeap(instanceDesc);
+    return CaptureCreate(CaptureOpcode::CreateResourceHeap, instance_->CreateResourceHeap(instanceDesc), desc);
 }
 
 void DbgRenderSystem::Release(ResourceHeap& resourceViewHeap)
 {
+    LLGL_DBG_CAPTURE(Release(&resourceViewHeap));
     return instance_->Release(resourceViewHeap);
 }
 
+void DbgRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (numResourceViews > 0 && resourceViews == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed for resource views to update resource heap");
+    }
+
+    std::vector<ResourceViewDescriptor> instanceResourceViews { resourceViews, resourceViews + numResourceViews };
+    for (auto& resourceView : instanceResourceViews)
+        ConvertResourceViewToInstance(resourceView);
+
+    instance_->WriteResourceHeap(resourceHeap, firstDescriptor, numResourceViews, instanceResourceViews.data());
+
+    if (capture_)
+    {
+        DbgCaptureRecord record { *capture_, CaptureOpcode::WriteResourceHeap };
+        record.encoder.Object(&resourceHeap);
+        record.encoder.Value(firstDescriptor);
+        record.encoder.Value(numResourceViews);
+        for (std::uint32_t i = 0; i < numResourceViews; ++i)
+            record.encoder.Descriptor(resourceViews[i]);
+    }
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateRenderTargetDesc(desc);
+    }
+
     auto instanceDesc = desc;
 
     for (auto& attachment : instanceDesc.attachments)
@@ -376,22 +751,49 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
         }
     }
 
-    return TakeOwnership(
-        renderTargets_,
-        MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, desc)
+    return CaptureCreate(
+        CaptureOpcode::CreateRenderTarget,
+        TakeOwnership(renderTargets_, MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, desc)),
+        desc
     );
 }
 
 void DbgRenderSystem::Release(RenderTarget& renderTarget)
 {
+    LLGL_DBG_CAPTURE(Release(&renderTarget));
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
+/* ----- Render Passes ----- */
+
+RenderPass* DbgRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateRenderPassDesc(desc);
+    }
+    return CaptureCreate(
+        CaptureOpcode::CreateRenderPass,
+        TakeOwnership(renderPasses_, MakeUnique<DbgRenderPass>(*instance_->CreateRenderPass(desc), desc)),
+        desc
+    );
+}
+
+void DbgRenderSystem::Release(RenderPass& renderPass)
+{
+    ReleaseDbg(renderPasses_, renderPass);
+}
+
 /* ----- Shader ----- */
 
 Shader* DbgRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
-    return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc.type, debugger_));
+    return CaptureCreate(
+        CaptureOpcode::CreateShader,
+        TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc.type, debugger_)),
+        desc
+    );
 }
 
 static Shader* GetInstanceShader(Shader* shader)
@@ -406,6 +808,13 @@ static Shader* GetInstanceShader(Shader* shader)
 
 ShaderProgram* DbgRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((desc.amplificationShader != nullptr || desc.meshShader != nullptr) && !features_.hasMeshShaders)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+    }
+
     ShaderProgramDescriptor instanceDesc;
     {
         instanceDesc.vertexFormats          = desc.vertexFormats;
@@ -415,8 +824,14 @@ ShaderProgram* DbgRenderSystem::CreateShaderProgram(const ShaderProgramDescripto
         instanceDesc.geometryShader         = GetInstanceShader(desc.geometryShader);
         instanceDesc.fragmentShader         = GetInstanceShader(desc.fragmentShader);
         instanceDesc.computeShader          = GetInstanceShader(desc.computeShader);
+        instanceDesc.amplificationShader    = GetInstanceShader(desc.amplificationShader);
+        instanceDesc.meshShader             = GetInstanceShader(desc.meshShader);
     }
-    return TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(instanceDesc), debugger_, desc));
+    return CaptureCreate(
+        CaptureOpcode::CreateShaderProgram,
+        TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(instanceDesc), debugger_, desc)),
+        desc
+    );
 }
 
 void DbgRenderSystem::Release(Shader& shader)
@@ -433,11 +848,18 @@ void DbgRenderSystem::Release(ShaderProgram& shaderProgram)
 
 PipelineLayout* DbgRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
 {
-    return instance_->CreatePipelineLayout(desc);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidatePipelineLayoutDesc(desc);
+    }
+
+    return CaptureCreate(CaptureOpcode::CreatePipelineLayout, instance_->CreatePipelineLayout(desc), desc);
 }
 
 void DbgRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    LLGL_DBG_CAPTURE(Release(&pipelineLayout));
     instance_->Release(pipelineLayout);
 }
 
@@ -446,24 +868,25 @@ void DbgRenderSystem::Release(PipelineLayout& pipelineLayout)
 GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
     LLGL_DBG_SOURCE;
+    return CreateGraphicsPipelineWithMode(desc, false);
+}
 
-    if (debugger_)
-        ValidateGraphicsPipelineDesc(desc);
+GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    LLGL_DBG_SOURCE;
+    return CreateGraphicsPipelineWithMode(desc, true);
+}
 
+ComputePipeline* DbgRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
+{
     if (desc.shaderProgram)
     {
         auto instanceDesc = desc;
         {
             auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, desc.shaderProgram);
             instanceDesc.shaderProgram = &(shaderProgramDbg->instance);
-
-            if (desc.renderTarget)
-            {
-                auto renderTargetDbg = LLGL_CAST(DbgRenderTarget*, desc.renderTarget);
-                instanceDesc.renderTarget = &(renderTargetDbg->instance);
-            }
         }
-        return TakeOwnership(graphicsPipelines_, MakeUnique<DbgGraphicsPipeline>(*instance_->CreateGraphicsPipeline(instanceDesc), desc));
+        return CaptureCreate(CaptureOpcode::CreateComputePipeline, instance_->CreateComputePipeline(instanceDesc), desc);
     }
     else
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shader program must not be null");
@@ -471,34 +894,109 @@ GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipeline
     return nullptr;
 }
 
-ComputePipeline* DbgRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
-{
-    if (desc.shaderProgram)
-    {
-        auto instanceDesc = desc;
-        {
-            auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, desc.shaderProgram);
-            instanceDesc.shaderProgram = &(shaderProgramDbg->instance);
-        }
-        return instance_->CreateComputePipeline(instanceDesc);
-    }
-    else
-        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shader program must not be null");
-
-    return nullptr;
-}
-
-void DbgRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
+void DbgRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
     ReleaseDbg(graphicsPipelines_, graphicsPipeline);
 }
 
 void DbgRenderSystem::Release(ComputePipeline& computePipeline)
 {
+    LLGL_DBG_CAPTURE(Release(&computePipeline));
     instance_->Release(computePipeline);
     //RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+/* ----- Pipeline Caches ----- */
+
+std::vector<char> DbgRenderSystem::GetPipelineCacheData() const
+{
+    return instance_->GetPipelineCacheData();
+}
+
+bool DbgRenderSystem::SetPipelineCacheData(const void* data, std::size_t dataSize)
+{
+    return instance_->SetPipelineCacheData(data, dataSize);
+}
+
+/* ----- Statistics ----- */
+
+bool DbgRenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    return instance_->QueryStatistics(statistics, reset);
+}
+
+bool DbgRenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    return instance_->QueryMemoryStatistics(statistics);
+}
+
+bool DbgRenderSystem::QueryTimestampCalibration(TimestampCalibration& calibration)
+{
+    return instance_->QueryTimestampCalibration(calibration);
+}
+
+// Returns the prefix of the specified debug name up to the first occurrence of the separator, or the entire name.
+static std::string GetNamePrefix(const std::string& name, char separator)
+{
+    if (separator != '\0')
+    {
+        const auto pos = name.find(separator);
+        if (pos != std::string::npos)
+            return name.substr(0, pos);
+    }
+    return name;
+}
+
+bool DbgRenderSystem::QueryResourceMemoryReport(ResourceMemoryReport& report, char separator)
+{
+    std::map<std::string, ResourceMemoryEntry> entries;
+    std::uint64_t totalAllocatedBytes = 0;
+
+    /* Aggregate sizes of all buffers by their name prefix */
+    for (const auto& buffer : buffers_)
+    {
+        auto& entry = entries[GetNamePrefix(buffer->label, separator)];
+        entry.numBuffers++;
+        entry.allocatedBytes += buffer->desc.size;
+        totalAllocatedBytes += buffer->desc.size;
+    }
+
+    /* Aggregate sizes of all textures by their name prefix; texture views share the memory of another texture */
+    for (const auto& texture : textures_)
+    {
+        if (texture->isView)
+            continue;
+        const auto size = texture->GetMemorySize();
+        auto& entry = entries[GetNamePrefix(texture->label, separator)];
+        entry.numTextures++;
+        entry.allocatedBytes += size;
+        totalAllocatedBytes += size;
+    }
+
+    /* Sort entries by their allocated bytes in descending order, so the largest owners of memory come first */
+    report.entries.clear();
+    report.entries.reserve(entries.size());
+
+    for (auto& it : entries)
+    {
+        it.second.prefix = it.first;
+        report.entries.push_back(std::move(it.second));
+    }
+
+    std::stable_sort(
+        report.entries.begin(),
+        report.entries.end(),
+        [](const ResourceMemoryEntry& lhs, const ResourceMemoryEntry& rhs)
+        {
+            return (lhs.allocatedBytes > rhs.allocatedBytes);
+        }
+    );
+
+    report.totalAllocatedBytes = totalAllocatedBytes;
+
+    return true;
+}
+
 /* ----- Queries ----- */
 
 Query* DbgRenderSystem::CreateQuery(const QueryDescriptor& desc)
@@ -511,6 +1009,63 @@ void DbgRenderSystem::Release(Query& query)
     ReleaseDbg(queries_, query);
 }
 
+QueryHeap* DbgRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<DbgQueryHeap>(*instance_->CreateQueryHeap(desc), desc));
+}
+
+void DbgRenderSystem::Release(QueryHeap& queryHeap)
+{
+    ReleaseDbg(queryHeaps_, queryHeap);
+}
+
+/* ----- Indirect Command Layouts ----- */
+
+IndirectCommandLayout* DbgRenderSystem::CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc)
+{
+    return TakeOwnership(indirectCommandLayouts_, MakeUnique<DbgIndirectCommandLayout>(*instance_->CreateIndirectCommandLayout(desc), desc));
+}
+
+void DbgRenderSystem::Release(IndirectCommandLayout& indirectCommandLayout)
+{
+    ReleaseDbg(indirectCommandLayouts_, indirectCommandLayout);
+}
+
+/* ----- Acceleration Structures ----- */
+
+// Returns the instance of the specified debug buffer, or null if the buffer is null.
+static Buffer* GetInstanceBuffer(Buffer* buffer)
+{
+    return (buffer != nullptr ? &(LLGL_CAST(DbgBuffer*, buffer)->instance) : nullptr);
+}
+
+AccelerationStructure* DbgRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& desc)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateAccelerationStructureDesc(desc);
+    }
+
+    /* Replace all input buffers by their instances */
+    auto instanceDesc = desc;
+    {
+        for (auto& geometry : instanceDesc.geometries)
+        {
+            geometry.vertexBuffer   = GetInstanceBuffer(geometry.vertexBuffer);
+            geometry.indexBuffer    = GetInstanceBuffer(geometry.indexBuffer);
+        }
+        instanceDesc.instanceBuffer = GetInstanceBuffer(desc.instanceBuffer);
+    }
+
+    return TakeOwnership(accelerationStructures_, MakeUnique<DbgAccelerationStructure>(*instance_->CreateAccelerationStructure(instanceDesc), desc));
+}
+
+void DbgRenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    ReleaseDbg(accelerationStructures_, accelerationStructure);
+}
+
 /* ----- Fences ----- */
 
 Fence* DbgRenderSystem::CreateFence()
@@ -523,6 +1078,42 @@ void DbgRenderSystem::Release(Fence& fence)
     return instance_->Release(fence);
 }
 
+/* ----- Upload batches ----- */
+
+void DbgRenderSystem::BeginUploadBatch()
+{
+    instance_->BeginUploadBatch();
+    ++uploadBatchDepth_;
+}
+
+void DbgRenderSystem::EndUploadBatch()
+{
+    if (uploadBatchDepth_ == 0)
+    {
+        if (debugger_)
+        {
+            LLGL_DBG_SOURCE;
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot end upload batch without a preceding call to BeginUploadBatch");
+        }
+        return;
+    }
+
+    instance_->EndUploadBatch();
+    --uploadBatchDepth_;
+}
+
+/* ----- Worker threads ----- */
+
+bool DbgRenderSystem::AttachWorkerThread()
+{
+    return instance_->AttachWorkerThread();
+}
+
+void DbgRenderSystem::DetachWorkerThread()
+{
+    instance_->DetachWorkerThread();
+}
+
 
 /*
  * ======= Private: =======
@@ -633,6 +1224,55 @@ void DbgRenderSystem::ValidateBufferMapping(DbgBuffer& bufferDbg, bool mapMemory
     }
 }
 
+void DbgRenderSystem::WarnBufferWrite(DbgBuffer& bufferDbg)
+{
+    if ((bufferDbg.desc.flags & BufferFlags::DynamicUsage) != 0)
+        return;
+
+    /* Count writes within the current frame */
+    if (bufferDbg.writeFrame != frameIndex_)
+    {
+        bufferDbg.writeFrame    = frameIndex_;
+        bufferDbg.writesInFrame = 0;
+    }
+
+    if (++bufferDbg.writesInFrame == 2)
+    {
+        LLGL_DBG_WARN(
+            WarningType::Performance,
+            "buffer without BufferFlags::DynamicUsage written more than once per frame; consider BufferFlags::DynamicUsage"
+        );
+    }
+}
+
+// Number of consecutive frames a buffer can be mapped for reading before a performance warning is posted
+static const std::uint32_t g_maxReadbackFrames = 3;
+
+void DbgRenderSystem::WarnBufferReadback(DbgBuffer& bufferDbg, const CPUAccess access)
+{
+    if (access == CPUAccess::WriteOnly)
+        return;
+
+    /* Count consecutive frames in which this buffer is read back */
+    if (bufferDbg.readbackFrame == frameIndex_)
+        return;
+
+    if (bufferDbg.readbackFrame + 1 == frameIndex_)
+        ++bufferDbg.readbackFrames;
+    else
+        bufferDbg.readbackFrames = 1;
+
+    bufferDbg.readbackFrame = frameIndex_;
+
+    if (bufferDbg.readbackFrames >= g_maxReadbackFrames)
+    {
+        LLGL_DBG_WARN(
+            WarningType::Performance,
+            "buffer mapped for reading every frame, which stalls the CPU until the GPU has finished; consider RenderSystem::ReadBufferAsync to read back with a latency of several frames"
+        );
+    }
+}
+
 void DbgRenderSystem::ValidateTextureDesc(const TextureDescriptor& desc)
 {
     switch (desc.type)
@@ -704,6 +1344,9 @@ void DbgRenderSystem::ValidateTextureDesc(const TextureDescriptor& desc)
 
     ValidateTextureDescMipLevels(desc);
     ValidateArrayTextureLayers(desc.type, desc.arrayLayers);
+
+    if (IsCompressedFormat(desc.format))
+        AssertTextureCompression(desc.format);
 }
 
 void DbgRenderSystem::ValidateTextureDescMipLevels(const TextureDescriptor& desc)
@@ -863,6 +1506,150 @@ void DbgRenderSystem::ValidateTextureImageDataSize(std::size_t dataSize, std::si
     }
 }
 
+void DbgRenderSystem::ValidateTextureReadbackRegion(const DbgTexture& textureDbg, const TextureRegion& region)
+{
+    const auto format = textureDbg.desc.format;
+
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot read texture with compressed or depth-stencil format asynchronously");
+    if (IsMultiSampleTexture(textureDbg.GetType()))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot read multi-sampled texture asynchronously");
+
+    if (region.mipLevel >= textureDbg.mipLevels)
+    {
+        ValidateMipLevelLimit(region.mipLevel, textureDbg.mipLevels);
+        return;
+    }
+
+    if (region.offset.x < 0 || region.offset.y < 0 || region.offset.z < 0)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture readback region must not have a negative offset");
+        return;
+    }
+
+    /* The extent of the MIP-map level includes the array layers (and cube faces) like the texture region */
+    const auto mipExtent = textureDbg.QueryMipExtent(region.mipLevel);
+    if (static_cast<std::uint32_t>(region.offset.x) + region.extent.width  > mipExtent.width  ||
+        static_cast<std::uint32_t>(region.offset.y) + region.extent.height > mipExtent.height ||
+        static_cast<std::uint32_t>(region.offset.z) + region.extent.depth  > mipExtent.depth)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture readback region exceeds the extent of MIP-map level " + std::to_string(region.mipLevel));
+    }
+
+    if (region.extent.width == 0 || region.extent.height == 0 || region.extent.depth == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "texture readback region is empty");
+}
+
+void DbgRenderSystem::ValidateSparseTextureDesc(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    if (!features_.hasSparseTextures)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("sparse textures");
+
+    Extent3D tileShape;
+    if (!instance_->QuerySparseTileShape(desc.format, desc.type, tileShape))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse textures are not supported for the specified texture format and type");
+
+    if (imageDesc != nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create sparse texture with initial image data");
+}
+
+void DbgRenderSystem::ValidateTransientTextureDesc(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    if ((desc.flags & TextureFlags::AttachmentUsage) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "transient texture requires the TextureFlags::AttachmentUsage flag");
+
+    if ((desc.flags & (TextureFlags::SampleUsage | TextureFlags::StorageUsage | TextureFlags::Sparse)) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "transient texture cannot be combined with the TextureFlags::SampleUsage, TextureFlags::StorageUsage, or TextureFlags::Sparse flags");
+
+    if (imageDesc != nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create transient texture with initial image data");
+}
+
+void DbgRenderSystem::ValidateTextureTileRegion(const DbgTexture& textureDbg, const TextureRegion& region)
+{
+    if ((textureDbg.desc.flags & TextureFlags::Sparse) == 0)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot commit tiles of texture that was not created with the TextureFlags::Sparse flag");
+        return;
+    }
+
+    if (region.mipLevel >= textureDbg.mipLevels)
+    {
+        ValidateMipLevelLimit(region.mipLevel, textureDbg.mipLevels);
+        return;
+    }
+
+    if (region.offset.x < 0 || region.offset.y < 0 || region.offset.z < 0)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture tile region must not have a negative offset");
+        return;
+    }
+
+    /* The extent of the MIP-map level includes the array layers (and cube faces) like the texture region */
+    const auto mipExtent = textureDbg.QueryMipExtent(region.mipLevel);
+    if (static_cast<std::uint32_t>(region.offset.x) + region.extent.width  > mipExtent.width  ||
+        static_cast<std::uint32_t>(region.offset.y) + region.extent.height > mipExtent.height ||
+        static_cast<std::uint32_t>(region.offset.z) + region.extent.depth  > mipExtent.depth)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture tile region exceeds the extent of MIP-map level " + std::to_string(region.mipLevel));
+        return;
+    }
+
+    /* Each region boundary must be aligned to the tile shape, except for the boundaries at the end of the MIP-map level */
+    Extent3D tileShape;
+    if (!instance_->QuerySparseTileShape(textureDbg.desc.format, textureDbg.GetType(), tileShape))
+        return;
+
+    if (textureDbg.GetType() != TextureType::Texture3D)
+        tileShape.depth = 1;
+
+    auto IsTileAligned = [](std::int32_t offset, std::uint32_t extent, std::uint32_t mipExtent, std::uint32_t tileSize) -> bool
+    {
+        const auto end = static_cast<std::uint32_t>(offset) + extent;
+        return (static_cast<std::uint32_t>(offset) % tileSize == 0 && (end % tileSize == 0 || end == mipExtent));
+    };
+
+    if (!IsTileAligned(region.offset.x, region.extent.width,  mipExtent.width,  tileShape.width ) ||
+        !IsTileAligned(region.offset.y, region.extent.height, mipExtent.height, tileShape.height) ||
+        !IsTileAligned(region.offset.z, region.extent.depth,  mipExtent.depth,  tileShape.depth ))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "texture tile region is not aligned to the tile shape (" + std::to_string(tileShape.width) + "x" +
+            std::to_string(tileShape.height) + "x" + std::to_string(tileShape.depth) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateTextureBlockAlignment(const DbgTexture& textureDbg, const SubTextureDescriptor& subTextureDesc)
+{
+    /* Each region boundary must be aligned to the block extent, except for the boundaries at the end of the MIP-map level */
+    const auto blockExtent  = FormatBlockExtent(textureDbg.desc.format);
+    const auto mipExtent    = textureDbg.QueryMipExtent(subTextureDesc.mipLevel);
+
+    auto IsBlockAligned = [](std::int32_t offset, std::uint32_t extent, std::uint32_t mipExtent, std::uint32_t blockSize) -> bool
+    {
+        const auto begin    = static_cast<std::uint32_t>(offset);
+        const auto end      = begin + extent;
+        return (begin % blockSize == 0 && (end % blockSize == 0 || end == mipExtent));
+    };
+
+    bool aligned = IsBlockAligned(subTextureDesc.offset.x, subTextureDesc.extent.width, mipExtent.width, blockExtent.width);
+
+    /* The height of 1D array textures specifies the array layers */
+    if (textureDbg.GetType() != TextureType::Texture1D && textureDbg.GetType() != TextureType::Texture1DArray)
+        aligned = (aligned && IsBlockAligned(subTextureDesc.offset.y, subTextureDesc.extent.height, mipExtent.height, blockExtent.height));
+
+    if (!aligned)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "sub-texture region is not aligned to the " + std::to_string(blockExtent.width) + "x" +
+            std::to_string(blockExtent.height) + " blocks of the compressed texture format"
+        );
+    }
+}
+
 bool DbgRenderSystem::ValidateTextureMips(const DbgTexture& textureDbg)
 {
     if (textureDbg.desc.mipLevels == 1)
@@ -870,6 +1657,11 @@ bool DbgRenderSystem::ValidateTextureMips(const DbgTexture& textureDbg)
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot generate MIP-maps for texture with only one MIP-map level");
         return false;
     }
+    if (IsCompressedFormat(textureDbg.desc.format))
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot generate MIP-maps for texture with compressed format");
+        return false;
+    }
     return true;
 }
 
@@ -907,14 +1699,296 @@ void DbgRenderSystem::ValidateTextureArrayRangeWithEnd(std::uint32_t baseArrayLa
     }
 }
 
+// Returns true if the specified texture swizzle is the identity mapping.
+static bool IsTextureSwizzleIdentity(const TextureSwizzleRGBA& swizzle)
+{
+    return
+    (
+        swizzle.r == TextureSwizzle::Red   &&
+        swizzle.g == TextureSwizzle::Green &&
+        swizzle.b == TextureSwizzle::Blue  &&
+        swizzle.a == TextureSwizzle::Alpha
+    );
+}
+
+void DbgRenderSystem::ValidateTextureViewDesc(const DbgTexture& sharedTextureDbg, const TextureViewDescriptor& desc)
+{
+    if (!features_.hasTextureViews)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("texture views");
+
+    if (sharedTextureDbg.isView)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create texture view of another texture view");
+        return;
+    }
+
+    /* Validate subresource range */
+    if (desc.subresource.numMipLevels == 0 || desc.subresource.numArrayLayers == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture view must refer to at least one MIP-map level and array layer");
+
+    ValidateTextureMipRange(sharedTextureDbg, desc.subresource.baseMipLevel, desc.subresource.numMipLevels);
+    ValidateTextureArrayRange(sharedTextureDbg, desc.subresource.baseArrayLayer, desc.subresource.numArrayLayers);
+
+    /* Validate texture type */
+    const auto sharedType = sharedTextureDbg.GetType();
+
+    if (IsMultiSampleTexture(desc.type) != IsMultiSampleTexture(sharedType) || (desc.type == TextureType::Texture3D) != (sharedType == TextureType::Texture3D))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture view type is incompatible with the type of the shared texture");
+    if (IsCubeTexture(desc.type) && (!IsCubeTexture(sharedType) || desc.subresource.numArrayLayers % 6 != 0))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cube texture view must refer to a cube texture with a multiple of 6 array layers");
+
+    /* Validate format reinterpretation */
+    const auto sharedFormat = sharedTextureDbg.desc.format;
+
+    if (desc.format != sharedFormat)
+    {
+        if ((sharedTextureDbg.desc.flags & TextureFlags::MutableFormat) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture view with different format requires shared texture with TextureFlags::MutableFormat");
+        else if (FormatBitSize(desc.format) != FormatBitSize(sharedFormat))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture view format must have the same size per texel as the format of the shared texture");
+    }
+
+    if (!IsTextureSwizzleIdentity(desc.swizzle) && GetRendererID() == RendererID::Direct3D11)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("texture view swizzle");
+}
+
+void DbgRenderSystem::ValidateTextureNoView(const DbgTexture& textureDbg)
+{
+    if (textureDbg.isView)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture views can only be used as shader resources");
+}
+
+void DbgRenderSystem::ValidatePipelineLayoutDesc(const PipelineLayoutDescriptor& desc)
+{
+    for (const auto& binding : desc.bindings)
+    {
+        if ((binding.flags & BindingFlags::DynamicOffset) != 0)
+        {
+            if (binding.type != ResourceType::ConstantBuffer)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "dynamic offsets are only supported for constant buffer bindings");
+            if ((binding.flags & BindingFlags::Bindless) != 0 || binding.arraySize > 1)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "dynamic offsets are not supported for array bindings");
+            if (binding.dynamicRangeSize == 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "binding with dynamic offset must have a range size greater than zero");
+            else
+                ValidateConstantBufferSize(binding.dynamicRangeSize);
+        }
+    }
+
+    if (desc.constants.size > 0)
+    {
+        if (desc.constants.size % 4 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "size of constants must be a multiple of 4");
+        if (desc.constants.size > limits_.maxConstantsSize)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "size of constants exceeded limit (" + std::to_string(desc.constants.size) +
+                " specified but limit is " + std::to_string(limits_.maxConstantsSize) + ")"
+            );
+        }
+    }
+
+    if (!desc.staticSamplers.empty() && !features_.hasStaticSamplers)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("static samplers");
+
+    for (const auto& staticSampler : desc.staticSamplers)
+    {
+        for (const auto& binding : desc.bindings)
+        {
+            if (binding.slot == staticSampler.slot && (binding.type == ResourceType::Sampler || GetRendererID() == RendererID::Vulkan))
+            {
+                LLGL_DBG_ERROR(
+                    ErrorType::InvalidArgument,
+                    "slot of static sampler collides with layout binding (slot " + std::to_string(staticSampler.slot) + ")"
+                );
+            }
+        }
+    }
+}
+
+void DbgRenderSystem::ValidateAccelerationStructureDesc(const AccelerationStructureDescriptor& desc)
+{
+    if (!features_.hasRayQueries)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("acceleration structures");
+
+    if ((desc.flags & AccelerationStructureFlags::PreferFastTrace) != 0 && (desc.flags & AccelerationStructureFlags::PreferFastBuild) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "acceleration structure cannot prefer both fast trace and fast build");
+
+    /* Compacted acceleration structures ignore their inputs, since they are only the destination of a compaction */
+    if (desc.compactedSize > 0)
+        return;
+
+    if (desc.type == AccelerationStructureType::BottomLevel)
+    {
+        if (desc.geometries.empty())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bottom-level acceleration structure must have at least one geometry");
+        if (desc.instanceBuffer != nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bottom-level acceleration structure must not have an instance buffer");
+
+        for (const auto& geometry : desc.geometries)
+        {
+            if (geometry.vertexFormat != Format::RGB32Float && geometry.vertexFormat != Format::RG32Float &&
+                geometry.vertexFormat != Format::RGBA16Float && geometry.vertexFormat != Format::RG16Float)
+            {
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid vertex format for acceleration structure geometry");
+            }
+
+            if (geometry.numVertices == 0)
+                LLGL_DBG_WARN(WarningType::PointlessOperation, "acceleration structure geometry with zero vertices");
+            else
+                ValidateAccelerationStructureInput(geometry.vertexBuffer, geometry.vertexOffset, static_cast<std::uint64_t>(geometry.numVertices - 1) * geometry.vertexStride + FormatBitSize(geometry.vertexFormat) / 8, "vertex buffer");
+
+            if (geometry.indexBuffer != nullptr)
+            {
+                if (geometry.indexFormat != Format::R16UInt && geometry.indexFormat != Format::R32UInt)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid index format for acceleration structure geometry");
+                if (geometry.numIndices % 3 != 0)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of indices of acceleration structure geometry must be a multiple of 3");
+                ValidateAccelerationStructureInput(geometry.indexBuffer, geometry.indexOffset, static_cast<std::uint64_t>(geometry.numIndices) * FormatBitSize(geometry.indexFormat) / 8, "index buffer");
+            }
+            else if (geometry.numVertices % 3 != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of vertices of non-indexed acceleration structure geometry must be a multiple of 3");
+        }
+    }
+    else
+    {
+        if (!desc.geometries.empty())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "top-level acceleration structure must not have any geometries");
+        if (desc.instanceOffset % 16 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset of acceleration structure instances must be a multiple of 16");
+        ValidateAccelerationStructureInput(desc.instanceBuffer, desc.instanceOffset, static_cast<std::uint64_t>(desc.numInstances) * sizeof(AccelerationStructureInstance), "instance buffer");
+    }
+}
+
+void DbgRenderSystem::ValidateAccelerationStructureInput(const Buffer* buffer, std::uint64_t offset, std::uint64_t size, const char* inputName)
+{
+    if (buffer == nullptr)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed for acceleration structure " + std::string(inputName));
+        return;
+    }
+
+    auto bufferDbg = LLGL_CAST(const DbgBuffer*, buffer);
+
+    if ((bufferDbg->desc.flags & BufferFlags::AccelerationStructureInput) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "acceleration structure " + std::string(inputName) + " was not created with the LLGL::BufferFlags::AccelerationStructureInput flag");
+
+    if (offset + size > bufferDbg->desc.size)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "acceleration structure " + std::string(inputName) + " range out of bounds (" + std::to_string(offset + size) +
+            " bytes required but buffer has " + std::to_string(bufferDbg->desc.size) + " bytes)"
+        );
+    }
+}
+
+void DbgRenderSystem::ConvertResourceViewToInstance(ResourceViewDescriptor& resourceView)
+{
+    if (auto resource = resourceView.resource)
+    {
+        switch (resource->QueryResourceType())
+        {
+            case ResourceType::VertexBuffer:
+            case ResourceType::IndexBuffer:
+            case ResourceType::ConstantBuffer:
+            case ResourceType::StorageBuffer:
+            case ResourceType::StreamOutputBuffer:
+                resourceView.resource = &(LLGL_CAST(DbgBuffer*, resourceView.resource)->instance);
+                break;
+            case ResourceType::Texture:
+                resourceView.resource = &(LLGL_CAST(DbgTexture*, resourceView.resource)->instance);
+                break;
+            case ResourceType::Sampler:
+                //TODO: DbgSampler
+                break;
+            case ResourceType::AccelerationStructure:
+                resourceView.resource = &(LLGL_CAST(DbgAccelerationStructure*, resourceView.resource)->instance);
+                break;
+            default:
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid resource type passed to ResourceViewDescriptor");
+                break;
+        }
+    }
+    else
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to ResourceViewDescriptor");
+}
+
+GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipelineWithMode(const GraphicsPipelineDescriptor& desc, bool async)
+{
+    if (debugger_)
+        ValidateGraphicsPipelineDesc(desc);
+
+    if (desc.shaderProgram)
+    {
+        auto instanceDesc = desc;
+        {
+            auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, desc.shaderProgram);
+            instanceDesc.shaderProgram = &(shaderProgramDbg->instance);
+
+            if (desc.renderTarget)
+            {
+                auto renderTargetDbg = LLGL_CAST(DbgRenderTarget*, desc.renderTarget);
+                instanceDesc.renderTarget = &(renderTargetDbg->instance);
+            }
+        }
+
+        auto instance = (async ? instance_->CreateGraphicsPipelineAsync(instanceDesc) : instance_->CreateGraphicsPipeline(instanceDesc));
+        return CaptureCreate(
+            CaptureOpcode::CreateGraphicsPipeline,
+            TakeOwnership(graphicsPipelines_, MakeUnique<DbgGraphicsPipeline>(*instance, desc)),
+            desc
+        );
+    }
+    else
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shader program must not be null");
+
+    return nullptr;
+}
+
 void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescriptor& desc)
 {
     if (desc.rasterizer.conservativeRasterization && !features_.hasConservativeRasterization)
         LLGL_DBG_ERROR_NOT_SUPPORTED("conservative rasterization");
+    if (desc.depth.boundsTestEnabled)
+    {
+        if (!features_.hasDepthBoundsTest)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("depth bounds test");
+        if ((desc.dynamicStates & DynamicStateFlags::DepthBounds) == 0)
+        {
+            if (desc.depth.boundsMin < 0.0f || desc.depth.boundsMin > desc.depth.boundsMax || desc.depth.boundsMax > 1.0f)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid depth bounds (must satisfy 0 <= boundsMin <= boundsMax <= 1)");
+        }
+    }
     if (desc.blend.targets.size() > 8)
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "too many blend state targets (limit is 8)");
 
     ValidatePrimitiveTopology(desc.primitiveTopology);
+
+    if (desc.viewMask != 0)
+    {
+        if (!features_.hasMultiView)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("multiview rendering");
+        if (desc.renderTarget == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics pipeline with view mask for render context");
+    }
+
+    if (desc.renderTarget)
+    {
+        /* Graphics pipeline must render into all views of the render target */
+        auto renderTargetDbg = LLGL_CAST(const DbgRenderTarget*, desc.renderTarget);
+        const auto numViews = renderTargetDbg->GetDesc().numViews;
+        const auto viewMask = (numViews > 1 ? (numViews < 32 ? (1u << numViews) - 1u : ~0u) : 0u);
+        if (desc.viewMask != viewMask)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "view mask of graphics pipeline (0x" + ToHex(desc.viewMask) + ") does not match the " +
+                std::to_string(numViews) + " view(s) of its render target (0x" + ToHex(viewMask) + ")"
+            );
+        }
+    }
 }
 
 void DbgRenderSystem::ValidatePrimitiveTopology(const PrimitiveTopology primitiveTopology)
@@ -934,6 +2008,68 @@ void DbgRenderSystem::ValidatePrimitiveTopology(const PrimitiveTopology primitiv
     }
 }
 
+void DbgRenderSystem::ValidateRenderTargetDesc(const RenderTargetDescriptor& desc)
+{
+    if (desc.numViews > 1)
+    {
+        if (!features_.hasMultiView)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("multiview rendering");
+
+        if (desc.numViews > limits_.maxNumViews)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "too many views for multiview render target (" + std::to_string(desc.numViews) +
+                " specified but limit is " + std::to_string(limits_.maxNumViews) + ")"
+            );
+        }
+
+        if (desc.multiSampling.SampleCount() > 1)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create multiview render target with multi-sampling");
+
+        /* Each view renders into another array layer of all attachments */
+        for (const auto& attachment : desc.attachments)
+        {
+            if (auto texture = attachment.texture)
+            {
+                auto textureDbg = LLGL_CAST(const DbgTexture*, texture);
+                if (textureDbg->GetType() != TextureType::Texture2DArray)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create multiview render target with attachment of a texture type other than Texture2DArray");
+                else
+                    ValidateTextureArrayRangeWithEnd(attachment.arrayLayer, desc.numViews, textureDbg->desc.arrayLayers);
+            }
+            else
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create multiview render target with attachment without a valid texture");
+        }
+    }
+}
+
+void DbgRenderSystem::ValidateRenderPassDesc(const RenderPassDescriptor& desc)
+{
+    const auto numColorAttachments = desc.colorAttachments.size();
+
+    if (limits_.maxNumRenderTargetAttachments > 0 && numColorAttachments > limits_.maxNumRenderTargetAttachments)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "too many color attachments for render pass (" + std::to_string(numColorAttachments) +
+            " specified but limit is " + std::to_string(limits_.maxNumRenderTargetAttachments) + ")"
+        );
+    }
+
+    /* Depth and stencil components share a single clear value, so they should be cleared together */
+    const bool clearDepth   = (desc.depthAttachment.loadOp == AttachmentLoadOp::Clear);
+    const bool clearStencil = (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear);
+
+    if (clearDepth != clearStencil && (desc.depthAttachment.loadOp == AttachmentLoadOp::Load || desc.stencilAttachment.loadOp == AttachmentLoadOp::Load))
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperArgument,
+            "depth and stencil components are loaded and cleared separately in render pass, which prevents a fast clear of the depth-stencil attachment"
+        );
+    }
+}
+
 void DbgRenderSystem::Assert3DTextures()
 {
     if (!features_.has3DTextures)
@@ -964,14 +2100,52 @@ void DbgRenderSystem::AssertMultiSampleTextures()
         LLGL_DBG_ERROR_NOT_SUPPORTED("multi-sample textures");
 }
 
+void DbgRenderSystem::AssertTextureCompression(const Format format)
+{
+    /* Individual formats of a family might be supported even if the entire family is not */
+    if (std::find(caps_.textureFormats.begin(), caps_.textureFormats.end(), format) != caps_.textureFormats.end())
+        return;
+
+    if (IsCompressedFormatBC(format) && !features_.hasTextureCompressionBC)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("BC texture compression");
+    else if (IsCompressedFormatETC2(format) && !features_.hasTextureCompressionETC2)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("ETC2 texture compression");
+    else if (IsCompressedFormatASTC(format) && !features_.hasTextureCompressionASTC)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("ASTC texture compression");
+}
+
 template <typename T, typename TBase>
-void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
+void DbgRenderSystem::ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
+    LLGL_DBG_CAPTURE(Release(&entry));
     instance_->Release(entryDbg.instance);
     RemoveFromUniqueSet(cont, &entry);
 }
 
+template <typename T>
+T* DbgRenderSystem::CaptureCreate(const CaptureOpcode opcode, T* obj)
+{
+    if (capture_ && obj != nullptr)
+    {
+        DbgCaptureRecord record { *capture_, opcode };
+        record.encoder.AddObject(obj);
+    }
+    return obj;
+}
+
+template <typename T, typename TDesc>
+T* DbgRenderSystem::CaptureCreate(const CaptureOpcode opcode, T* obj, const TDesc& desc)
+{
+    if (capture_ && obj != nullptr)
+    {
+        DbgCaptureRecord record { *capture_, opcode };
+        record.encoder.Descriptor(desc);
+        record.encoder.AddObject(obj);
+    }
+    return obj;
+}
+
 
 } // /namespace LLGL
 
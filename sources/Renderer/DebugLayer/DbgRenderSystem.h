@@ -21,8 +21,14 @@
 #include "DbgShader.h"
 #include "DbgShaderProgram.h"
 #include "DbgQuery.h"
+#include "DbgQueryHeap.h"
+#include "DbgIndirectCommandLayout.h"
+#include "DbgAccelerationStructure.h"
+#include "DbgRenderPass.h"
+#include "DbgCapture.h"
 
 #include "../ContainerTypes.h"
+#include <memory>
 
 
 namespace LLGL
@@ -36,7 +42,12 @@ class DbgRenderSystem : public RenderSystem
 
         /* ----- Common ----- */
 
-        DbgRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger);
+        DbgRenderSystem(
+            const std::shared_ptr<RenderSystem>&    instance,
+            RenderingProfiler*                      profiler,
+            RenderingDebugger*                      debugger,
+            const std::string&                      captureFilename = ""
+        );
         ~DbgRenderSystem();
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
@@ -50,11 +61,13 @@ class DbgRenderSystem : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetCommandQueue(const QueueType type) override;
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
         CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -69,20 +82,36 @@ class DbgRenderSystem : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
 
         void Release(Texture& texture) override;
 
         void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
+        void WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions) override;
+
+        TextureUploadMemory BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc) override;
+        void EndTextureUpload() override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
 
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
 
+        bool QuerySparseTileShape(const Format format, const TextureType type, Extent3D& tileShape) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& region, bool commit) override;
+        void SetTextureMinLOD(Texture& texture, float minLOD) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -95,12 +124,20 @@ class DbgRenderSystem : public RenderSystem
 
         void Release(ResourceHeap& resourceViewHeap) override;
 
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
 
         void Release(RenderTarget& renderTarget) override;
 
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& desc) override;
@@ -119,23 +156,62 @@ class DbgRenderSystem : public RenderSystem
         /* ----- Pipeline States ----- */
 
         GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        GraphicsPipeline* CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc) override;
         ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
 
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        /* ----- Pipeline Caches ----- */
+
+        std::vector<char> GetPipelineCacheData() const override;
+        bool SetPipelineCacheData(const void* data, std::size_t dataSize) override;
+
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+        bool QueryMemoryStatistics(MemoryStatistics& statistics) override;
+        bool QueryTimestampCalibration(TimestampCalibration& calibration) override;
+        bool QueryResourceMemoryReport(ResourceMemoryReport& report, char separator = '/') override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
 
         void Release(Query& query) override;
 
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
+        /* ----- Indirect Command Layouts ----- */
+
+        IndirectCommandLayout* CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc) override;
+
+        void Release(IndirectCommandLayout& indirectCommandLayout) override;
+
+        /* ----- Acceleration Structures ----- */
+
+        AccelerationStructure* CreateAccelerationStructure(const AccelerationStructureDescriptor& desc) override;
+
+        void Release(AccelerationStructure& accelerationStructure) override;
+
         /* ----- Fences ----- */
 
         Fence* CreateFence() override;
 
         void Release(Fence& fence) override;
 
+        /* ----- Upload batches ----- */
+
+        void BeginUploadBatch() override;
+        void EndUploadBatch() override;
+
+        /* ----- Worker threads ----- */
+
+        bool AttachWorkerThread() override;
+        void DetachWorkerThread() override;
+
     private:
 
         void ValidateBufferDesc(const BufferDescriptor& desc, std::uint32_t* formatSize = nullptr);
@@ -145,6 +221,9 @@ class DbgRenderSystem : public RenderSystem
         void ValidateBufferCPUAccess(DbgBuffer& bufferDbg, const CPUAccess access);
         void ValidateBufferMapping(DbgBuffer& bufferDbg, bool mapMemory);
 
+        void WarnBufferWrite(DbgBuffer& bufferDbg);
+        void WarnBufferReadback(DbgBuffer& bufferDbg, const CPUAccess access);
+
         void ValidateTextureDesc(const TextureDescriptor& desc);
         void ValidateTextureDescMipLevels(const TextureDescriptor& desc);
         void ValidateTextureSize(std::uint32_t size, std::uint32_t limit, const char* textureTypeName);
@@ -156,22 +235,49 @@ class DbgRenderSystem : public RenderSystem
         void ValidateArrayTextureLayers(const TextureType type, std::uint32_t layers);
         void ValidateMipLevelLimit(std::uint32_t mipLevel, std::uint32_t mipLevelCount);
         void ValidateTextureImageDataSize(std::size_t dataSize, std::size_t requiredDataSize);
+        void ValidateTextureReadbackRegion(const DbgTexture& textureDbg, const TextureRegion& region);
+        void ValidateTextureBlockAlignment(const DbgTexture& textureDbg, const SubTextureDescriptor& subTextureDesc);
+        void ValidateSparseTextureDesc(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
+        void ValidateTransientTextureDesc(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
+        void ValidateTextureTileRegion(const DbgTexture& textureDbg, const TextureRegion& region);
         bool ValidateTextureMips(const DbgTexture& textureDbg);
         void ValidateTextureMipRange(const DbgTexture& textureDbg, std::uint32_t baseMipLevel, std::uint32_t numMipLevels);
         void ValidateTextureArrayRange(const DbgTexture& textureDbg, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers);
         void ValidateTextureArrayRangeWithEnd(std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers, std::uint32_t arrayLayerLimit);
+        void ValidateTextureViewDesc(const DbgTexture& sharedTextureDbg, const TextureViewDescriptor& desc);
+        void ValidateTextureNoView(const DbgTexture& textureDbg);
+
+        void ValidatePipelineLayoutDesc(const PipelineLayoutDescriptor& desc);
+
+        void ValidateAccelerationStructureDesc(const AccelerationStructureDescriptor& desc);
+        void ValidateAccelerationStructureInput(const Buffer* buffer, std::uint64_t offset, std::uint64_t size, const char* inputName);
+
+        // Replaces the resource of the specified view by the instance of its debug layer object.
+        void ConvertResourceViewToInstance(ResourceViewDescriptor& resourceView);
+
+        GraphicsPipeline* CreateGraphicsPipelineWithMode(const GraphicsPipelineDescriptor& desc, bool async);
 
         void ValidateGraphicsPipelineDesc(const GraphicsPipelineDescriptor& desc);
         void ValidatePrimitiveTopology(const PrimitiveTopology primitiveTopology);
 
+        void ValidateRenderTargetDesc(const RenderTargetDescriptor& desc);
+        void ValidateRenderPassDesc(const RenderPassDescriptor& desc);
+
         void Assert3DTextures();
         void AssertCubeTextures();
         void AssertArrayTextures();
         void AssertCubeArrayTextures();
         void AssertMultiSampleTextures();
+        void AssertTextureCompression(const Format format);
 
         template <typename T, typename TBase>
-        void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
+        void ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry);
+
+        template <typename T>
+        T* CaptureCreate(const CaptureOpcode opcode, T* obj);
+
+        template <typename T, typename TDesc>
+        T* CaptureCreate(const CaptureOpcode opcode, T* obj, const TDesc& desc);
 
         /* ----- Common objects ----- */
 
@@ -180,10 +286,16 @@ class DbgRenderSystem : public RenderSystem
         RenderingProfiler*                      profiler_   = nullptr;
         RenderingDebugger*                      debugger_   = nullptr;
 
+        std::unique_ptr<DbgCapture>             capture_;   // Trace of API calls, see RenderSystemDescriptor::captureFilename
+
         const RenderingCapabilities&            caps_;
         const RenderingFeatures&                features_;
         const RenderingLimits&                  limits_;
 
+        DbgTexture*                             uploadTexture_      = nullptr;  // Texture of the pending upload, see BeginTextureUpload
+        std::uint32_t                           uploadBatchDepth_   = 0;        // Number of nested upload batches, see BeginUploadBatch
+        std::uint64_t                           frameIndex_         = 1;        // Advanced by DbgRenderContext::Present; only used for performance warnings
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<DbgRenderContext>     renderContexts_;
@@ -192,12 +304,16 @@ class DbgRenderSystem : public RenderSystem
         HWObjectContainer<DbgBufferArray>       bufferArrays_;
         HWObjectContainer<DbgTexture>           textures_;
         HWObjectContainer<DbgRenderTarget>      renderTargets_;
+        HWObjectContainer<DbgRenderPass>        renderPasses_;
         HWObjectContainer<DbgShader>            shaders_;
         HWObjectContainer<DbgShaderProgram>     shaderPrograms_;
         HWObjectContainer<DbgGraphicsPipeline>  graphicsPipelines_;
         //HWObjectContainer<DbgComputePipeline>   computePipelines_;
         //HWObjectContainer<DbgSampler>           samplers_;
         HWObjectContainer<DbgQuery>             queries_;
+        HWObjectContainer<DbgQueryHeap>         queryHeaps_;
+        HWObjectContainer<DbgIndirectCommandLayout> indirectCommandLayouts_;
+        HWObjectContainer<DbgAccelerationStructure> accelerationStructures_;
 
 };
 
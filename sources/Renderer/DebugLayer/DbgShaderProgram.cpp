@@ -16,8 +16,9 @@ namespace LLGL
 
 
 DbgShaderProgram::DbgShaderProgram(ShaderProgram& instance, RenderingDebugger* debugger, const ShaderProgramDescriptor& desc) :
-    instance  { instance },
-    debugger_ { debugger }
+    instance       { instance                       },
+    debugger_      { debugger                       },
+    hasMeshShader_ { (desc.meshShader != nullptr)   }
 {
     /* Debug all attachments and shader composition */
     if (debugger_)
@@ -29,6 +30,8 @@ DbgShaderProgram::DbgShaderProgram(ShaderProgram& instance, RenderingDebugger* d
         DebugShaderAttachment(desc.geometryShader);
         DebugShaderAttachment(desc.fragmentShader);
         DebugShaderAttachment(desc.computeShader);
+        DebugShaderAttachment(desc.amplificationShader);
+        DebugShaderAttachment(desc.meshShader);
         DebugShaderComposition();
     }
 
@@ -51,6 +54,11 @@ std::string DbgShaderProgram::QueryInfoLog()
     return instance.QueryInfoLog();
 }
 
+bool DbgShaderProgram::IsReady() const
+{
+    return instance.IsReady();
+}
+
 ShaderReflectionDescriptor DbgShaderProgram::QueryReflectionDesc() const
 {
     return instance.QueryReflectionDesc();
@@ -88,6 +96,8 @@ void DbgShaderProgram::UnlockShaderUniform()
 #define LLGL_DS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::TessEvaluation)
 #define LLGL_GS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Geometry)
 #define LLGL_CS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Compute)
+#define LLGL_AS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Amplification)
+#define LLGL_MS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Mesh)
 
 void DbgShaderProgram::DebugShaderAttachment(Shader* shader)
 {
@@ -128,6 +138,10 @@ void DbgShaderProgram::DebugShaderComposition()
         case ( LLGL_VS_MASK | LLGL_HS_MASK | LLGL_DS_MASK |                LLGL_PS_MASK ):
         case ( LLGL_VS_MASK | LLGL_HS_MASK | LLGL_DS_MASK | LLGL_GS_MASK | LLGL_PS_MASK ):
         case ( LLGL_CS_MASK ):
+        case (                LLGL_MS_MASK                ):
+        case (                LLGL_MS_MASK | LLGL_PS_MASK ):
+        case ( LLGL_AS_MASK | LLGL_MS_MASK                ):
+        case ( LLGL_AS_MASK | LLGL_MS_MASK | LLGL_PS_MASK ):
             break;
         default:
             LLGL_DBG_ERROR(ErrorType::InvalidState, "invalid shader composition");
@@ -142,6 +156,8 @@ void DbgShaderProgram::DebugShaderComposition()
 #undef LLGL_DS_MASK
 #undef LLGL_GS_MASK
 #undef LLGL_CS_MASK
+#undef LLGL_AS_MASK
+#undef LLGL_MS_MASK
 
 
 } // /namespace LLGL
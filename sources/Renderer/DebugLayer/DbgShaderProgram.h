@@ -38,6 +38,8 @@ class DbgShaderProgram : public ShaderProgram
 
         std::string QueryInfoLog() override;
 
+        bool IsReady() const override;
+
         ShaderReflectionDescriptor QueryReflectionDesc() const override;
 
         void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
@@ -51,6 +53,12 @@ class DbgShaderProgram : public ShaderProgram
             return vertexLayout_;
         }
 
+        // Returns true if this shader program has a mesh shader, i.e. it is drawn with mesh tasks.
+        inline bool HasMeshShader() const
+        {
+            return hasMeshShader_;
+        }
+
         ShaderProgram& instance;
 
     private:
@@ -63,6 +71,7 @@ class DbgShaderProgram : public ShaderProgram
 
         std::vector<ShaderType> shaderTypes_;
         VertexLayout            vertexLayout_;
+        bool                    hasMeshShader_          = false;
 
 };
 
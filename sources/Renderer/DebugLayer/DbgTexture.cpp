@@ -6,6 +6,7 @@
  */
 
 #include "DbgTexture.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -30,6 +31,35 @@ TextureDescriptor DbgTexture::QueryDesc() const
     return instance.QueryDesc();
 }
 
+void DbgTexture::SetName(const char* name)
+{
+    label = (name != nullptr ? name : "");
+    instance.SetName(name);
+}
+
+std::uint64_t DbgTexture::GetMemorySize() const
+{
+    /* Determine number of array layers (including cube faces) and samples, which are equal for all MIP-map levels */
+    const std::uint64_t numLayers   = std::max(1u, desc.arrayLayers);
+    const std::uint64_t numSamples  = (IsMultiSampleTexture(desc.type) ? std::max(1u, desc.samples) : 1u);
+
+    /* Accumulate size of each MIP-map level */
+    std::uint64_t size = 0;
+
+    for (std::uint32_t mipLevel = 0; mipLevel < mipLevels; ++mipLevel)
+    {
+        const Extent3D mipExtent
+        {
+            std::max(1u, desc.extent.width  >> mipLevel),
+            std::max(1u, desc.extent.height >> mipLevel),
+            std::max(1u, desc.extent.depth  >> mipLevel)
+        };
+        size += static_cast<std::uint64_t>(TextureBufferSize(desc.format, mipExtent)) * numLayers * numSamples;
+    }
+
+    return size;
+}
+
 
 } // /namespace LLGL
 
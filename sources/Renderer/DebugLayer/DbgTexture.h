@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Texture.h>
+#include <string>
 
 
 namespace LLGL
@@ -27,9 +28,16 @@ class DbgTexture : public Texture
 
         TextureDescriptor QueryDesc() const override;
 
+        void SetName(const char* name) override;
+
+        // Returns the size (in bytes) of all MIP-map levels, array layers, and samples of this texture as described on creation.
+        std::uint64_t GetMemorySize() const;
+
         Texture&            instance;
         TextureDescriptor   desc;
+        std::string         label;      // Debug name, see DbgRenderSystem::QueryResourceMemoryReport
         std::uint32_t       mipLevels   = 1;
+        bool                isView      = false;
 
 };
 
@@ -9,6 +9,8 @@
 #include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -26,15 +28,30 @@ D3D11Buffer::D3D11Buffer(const BufferType type, ID3D11Device* device, const D3D1
     CreateResource(device, desc, initialData, bufferFlags);
 }
 
+void D3D11Buffer::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    DXSetObjectName(GetNative(), name);
+    #endif
+}
+
 void D3D11Buffer::UpdateSubresource(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset)
 {
-    CD3D11_BOX destBox(offset, 0, 0, offset + dataSize, 1, 1);
-    context->UpdateSubresource(buffer_.Get(), 0, &destBox, data, 0, 0);
+    if (IsDynamicRing())
+        WriteDynamicRegion(context, data, dataSize, offset);
+    else
+    {
+        CD3D11_BOX destBox(offset, 0, 0, offset + dataSize, 1, 1);
+        context->UpdateSubresource(buffer_.Get(), 0, &destBox, data, 0, 0);
+    }
 }
 
 void D3D11Buffer::UpdateSubresource(ID3D11DeviceContext* context, const void* data)
 {
-    context->UpdateSubresource(buffer_.Get(), 0, nullptr, data, 0, 0);
+    if (IsDynamicRing())
+        WriteDynamicRegion(context, data, regionSize_, 0);
+    else
+        context->UpdateSubresource(buffer_.Get(), 0, nullptr, data, 0, 0);
 }
 
 static bool HasReadAccess(const CPUAccess access)
@@ -67,9 +84,41 @@ void* D3D11Buffer::Map(ID3D11DeviceContext* context, const CPUAccess access)
         hr = context->Map(GetNative(), 0, D3D11Types::Map(access), 0, &mapppedSubresource);
     }
 
+    mappedOffset_ = 0;
+    mappedLength_ = 0;
+
     return (SUCCEEDED(hr) ? mapppedSubresource.pData : nullptr);
 }
 
+void* D3D11Buffer::Map(ID3D11DeviceContext* context, const CPUAccess access, UINT offset, UINT length)
+{
+    HRESULT hr = 0;
+    D3D11_MAPPED_SUBRESOURCE mapppedSubresource;
+
+    if (cpuAccessBuffer_)
+    {
+        /* On read access -> copy only the mapped range of the storage buffer to CPU-access buffer */
+        if (HasReadAccess(access))
+        {
+            const CD3D11_BOX srcBox(offset, 0, 0, offset + length, 1, 1);
+            context->CopySubresourceRegion(cpuAccessBuffer_.Get(), 0, offset, 0, 0, GetNative(), 0, &srcBox);
+        }
+
+        /* Map CPU-access buffer */
+        hr = context->Map(cpuAccessBuffer_.Get(), 0, D3D11Types::Map(access), 0, &mapppedSubresource);
+    }
+    else
+    {
+        /* Map buffer */
+        hr = context->Map(GetNative(), 0, D3D11Types::Map(access), 0, &mapppedSubresource);
+    }
+
+    mappedOffset_ = offset;
+    mappedLength_ = length;
+
+    return (SUCCEEDED(hr) ? reinterpret_cast<char*>(mapppedSubresource.pData) + offset : nullptr);
+}
+
 void D3D11Buffer::Unmap(ID3D11DeviceContext* context, const CPUAccess access)
 {
     if (cpuAccessBuffer_)
@@ -77,9 +126,17 @@ void D3D11Buffer::Unmap(ID3D11DeviceContext* context, const CPUAccess access)
         /* Unmap CPU-access buffer */
         context->Unmap(cpuAccessBuffer_.Get(), 0);
 
-        /* On write access -> copy CPU-access buffer to storage buffer */
+        /* On write access -> copy CPU-access buffer (or only its mapped range) to storage buffer */
         if (HasWriteAccess(access))
-            context->CopyResource(GetNative(), cpuAccessBuffer_.Get());
+        {
+            if (mappedLength_ > 0)
+            {
+                const CD3D11_BOX srcBox(mappedOffset_, 0, 0, mappedOffset_ + mappedLength_, 1, 1);
+                context->CopySubresourceRegion(GetNative(), 0, mappedOffset_, 0, 0, cpuAccessBuffer_.Get(), 0, &srcBox);
+            }
+            else
+                context->CopyResource(GetNative(), cpuAccessBuffer_.Get());
+        }
     }
     else
     {
@@ -105,8 +162,31 @@ static UINT GetCPUAccessFlags(long bufferFlags)
     return flags;
 }
 
+// Maximal size (in bytes) of a dynamic ring and maximal number of its regions
+static const UINT g_dynamicRingSize         = 1024u * 1024u;
+static const UINT g_maxDynamicRingRegions   = 64u;
+
+// Returns true if the specified buffer can be created as ring of dynamic regions.
+static bool IsDynamicRingSuitable(const D3D11_BUFFER_DESC& desc, long bufferFlags)
+{
+    /* Dynamic resources cannot be the destination of copy commands, so they are not used when mapping requires a CPU-access buffer */
+    const long incompatibleFlags = (BufferFlags::MapReadWriteAccess | BufferFlags::IndirectArguments);
+    return
+    (
+        (bufferFlags & BufferFlags::DynamicUsage) != 0                                                      &&
+        (bufferFlags & incompatibleFlags) == 0                                                              &&
+        (desc.BindFlags & ~(D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER | D3D11_BIND_CONSTANT_BUFFER)) == 0
+    );
+}
+
 void D3D11Buffer::CreateResource(ID3D11Device* device, const D3D11_BUFFER_DESC& desc, const void* initialData, long bufferFlags)
 {
+    if (IsDynamicRingSuitable(desc, bufferFlags))
+    {
+        CreateDynamicRing(device, desc, initialData);
+        return;
+    }
+
     /* Setup initial subresource data */
     D3D11_SUBRESOURCE_DATA subresourceData;
 
@@ -116,8 +196,13 @@ void D3D11Buffer::CreateResource(ID3D11Device* device, const D3D11_BUFFER_DESC&
         subresourceData.pSysMem = initialData;
     }
 
+    /* Allow buffer to be used as source of indirect arguments (if required) */
+    auto descDX = desc;
+    if ((bufferFlags & BufferFlags::IndirectArguments) != 0)
+        descDX.MiscFlags |= D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+
     /* Create new D3D11 hardware buffer */
-    auto hr = device->CreateBuffer(&desc, (initialData != nullptr ? &subresourceData : nullptr), buffer_.ReleaseAndGetAddressOf());
+    auto hr = device->CreateBuffer(&descDX, (initialData != nullptr ? &subresourceData : nullptr), buffer_.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create D3D11 buffer");
 
     /* Create CPU access buffer (if required) */
@@ -153,6 +238,68 @@ void D3D11Buffer::CreateCPUAccessBuffer(ID3D11Device* device, const D3D11_BUFFER
     DXThrowIfFailed(hr, "failed to create D3D11 CPU-access buffer for storage buffer");
 }
 
+void D3D11Buffer::CreateDynamicRing(ID3D11Device* device, const D3D11_BUFFER_DESC& desc, const void* initialData)
+{
+    /*
+    Binding a constant buffer at an offset requires Direct3D 11.1, so constant buffers only have a single region.
+    Large buffers also only have a single region, i.e. each update discards the entire buffer.
+    */
+    regionSize_ = desc.ByteWidth;
+
+    if ((desc.BindFlags & D3D11_BIND_CONSTANT_BUFFER) != 0)
+        numRegions_ = 1;
+    else
+        numRegions_ = std::max(1u, std::min(g_maxDynamicRingRegions, g_dynamicRingSize / std::max(1u, regionSize_)));
+
+    /* Initialize shadow copy and first region with initial data */
+    dynamicShadow_.resize(regionSize_, 0);
+    if (initialData)
+        ::memcpy(dynamicShadow_.data(), initialData, regionSize_);
+
+    std::vector<char> initialRingData(regionSize_ * numRegions_, 0);
+    ::memcpy(initialRingData.data(), dynamicShadow_.data(), regionSize_);
+
+    D3D11_SUBRESOURCE_DATA subresourceData;
+    InitMemory(subresourceData);
+    subresourceData.pSysMem = initialRingData.data();
+
+    /* Create dynamic D3D11 hardware buffer for all regions */
+    auto descDX = desc;
+    {
+        descDX.ByteWidth        = regionSize_ * numRegions_;
+        descDX.Usage            = D3D11_USAGE_DYNAMIC;
+        descDX.CPUAccessFlags   = D3D11_CPU_ACCESS_WRITE;
+    }
+    auto hr = device->CreateBuffer(&descDX, &subresourceData, buffer_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 dynamic buffer");
+}
+
+void D3D11Buffer::WriteDynamicRegion(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset)
+{
+    /* Merge written range into shadow copy */
+    ::memcpy(dynamicShadow_.data() + offset, data, dataSize);
+
+    /*
+    Advance to the next region: the buffer is only discarded when the ring rolls over,
+    otherwise the driver is promised that no region is overwritten that the GPU might still read
+    */
+    currentRegion_ = (currentRegion_ + 1) % numRegions_;
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    auto hr = context->Map(
+        buffer_.Get(),
+        0,
+        (currentRegion_ == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE),
+        0,
+        &mappedSubresource
+    );
+    DXThrowIfFailed(hr, "failed to map D3D11 dynamic buffer");
+    {
+        ::memcpy(reinterpret_cast<char*>(mappedSubresource.pData) + GetRegionOffset(), dynamicShadow_.data(), regionSize_);
+    }
+    context->Unmap(buffer_.Get(), 0);
+}
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,7 @@
 #include <LLGL/Buffer.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d11.h>
+#include <vector>
 
 
 namespace LLGL
@@ -26,10 +27,13 @@ class D3D11Buffer : public Buffer
         D3D11Buffer(const BufferType type);
         D3D11Buffer(const BufferType type, ID3D11Device* device, const D3D11_BUFFER_DESC& desc, const void* initialData = nullptr, long bufferFlags = 0);
 
+        void SetName(const char* name) override;
+
         virtual void UpdateSubresource(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset);
         virtual void UpdateSubresource(ID3D11DeviceContext* context, const void* data);
 
         void* Map(ID3D11DeviceContext* context, const CPUAccess access);
+        void* Map(ID3D11DeviceContext* context, const CPUAccess access, UINT offset, UINT length);
         void Unmap(ID3D11DeviceContext* context, const CPUAccess access);
 
         // Returns the native ID3D11Buffer object.
@@ -38,6 +42,18 @@ class D3D11Buffer : public Buffer
             return buffer_.Get();
         }
 
+        // Returns true if this buffer is a ring of dynamic regions, i.e. each update is written into the next region of the native buffer.
+        inline bool IsDynamicRing() const
+        {
+            return (numRegions_ > 0);
+        }
+
+        // Returns the byte offset of the current region within the native buffer. This must be added to the binding offset.
+        inline UINT GetRegionOffset() const
+        {
+            return currentRegion_ * regionSize_;
+        }
+
     protected:
 
         void CreateResource(ID3D11Device* device, const D3D11_BUFFER_DESC& desc, const void* initialData, long bufferFlags);
@@ -45,10 +61,21 @@ class D3D11Buffer : public Buffer
     private:
 
         void CreateCPUAccessBuffer(ID3D11Device* device, const D3D11_BUFFER_DESC& gpuBufferDesc, UINT cpuAccessFlags);
+        void CreateDynamicRing(ID3D11Device* device, const D3D11_BUFFER_DESC& desc, const void* initialData);
+
+        void WriteDynamicRegion(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset);
 
         ComPtr<ID3D11Buffer> buffer_;
         ComPtr<ID3D11Buffer> cpuAccessBuffer_;
 
+        std::vector<char>    dynamicShadow_;        // CPU copy of the current region, since each region is written entirely
+        UINT                 regionSize_    = 0;
+        UINT                 numRegions_    = 0;    // Zero if this is not a dynamic ring
+        UINT                 currentRegion_ = 0;
+
+        UINT                 mappedOffset_  = 0;
+        UINT                 mappedLength_  = 0; // Zero if the entire buffer is mapped
+
 };
 
 
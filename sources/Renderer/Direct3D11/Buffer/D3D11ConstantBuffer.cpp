@@ -26,32 +26,25 @@ D3D11ConstantBuffer::D3D11ConstantBuffer(ID3D11Device* device, const BufferDescr
         D3D11_BIND_CONSTANT_BUFFER
     };
 
-    if ((desc.flags & BufferFlags::DynamicUsage) != 0)
-    {
-        bufferDesc.Usage            = D3D11_USAGE_DYNAMIC;
-        bufferDesc.CPUAccessFlags   = D3D11_CPU_ACCESS_WRITE;
-    }
-
-    usage_ = bufferDesc.Usage;
-
     CreateResource(device, bufferDesc, initialData, desc.flags);
     bufferSize_ = static_cast<UINT>(desc.size);
 }
 
+D3D11ConstantBuffer::D3D11ConstantBuffer(ID3D11Device* device, const D3D11_BUFFER_DESC& desc) :
+    D3D11Buffer { BufferType::Constant, device, desc },
+    bufferSize_ { desc.ByteWidth                     }
+{
+}
+
 void D3D11ConstantBuffer::UpdateSubresource(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset)
 {
     /* Validate parameters */
     LLGL_ASSERT_RANGE(dataSize + offset, bufferSize_);
 
-    if (usage_ == D3D11_USAGE_DYNAMIC)
+    if (IsDynamicRing())
     {
-        /* Update partial subresource by mapping buffer from GPU into CPU memory space */
-        D3D11_MAPPED_SUBRESOURCE subresource;
-        context->Map(GetNative(), 0, (dataSize < bufferSize_ ? D3D11_MAP_WRITE : D3D11_MAP_WRITE_DISCARD), 0, &subresource);
-        {
-            ::memcpy(reinterpret_cast<char*>(subresource.pData) + offset, data, dataSize);
-        }
-        context->Unmap(GetNative(), 0);
+        /* Update partial subresource by discarding the dynamic buffer and merging the data with its shadow copy */
+        D3D11Buffer::UpdateSubresource(context, data, dataSize, offset);
     }
     else
     {
@@ -23,12 +23,14 @@ class D3D11ConstantBuffer final : public D3D11Buffer
 
         D3D11ConstantBuffer(ID3D11Device* device, const BufferDescriptor& desc, const void* initialData = nullptr);
 
+        // Constructs a constant buffer with the specified native descriptor, e.g. a dynamic buffer that is written with D3D11_MAP_WRITE_NO_OVERWRITE.
+        D3D11ConstantBuffer(ID3D11Device* device, const D3D11_BUFFER_DESC& desc);
+
         void UpdateSubresource(ID3D11DeviceContext* context, const void* data, UINT dataSize, UINT offset) override;
 
     private:
 
-        UINT        bufferSize_ = 0;
-        D3D11_USAGE usage_      = D3D11_USAGE_DEFAULT;
+        UINT bufferSize_ = 0;
 
 };
 
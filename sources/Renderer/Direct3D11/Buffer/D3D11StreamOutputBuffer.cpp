@@ -17,10 +17,11 @@ D3D11StreamOutputBuffer::D3D11StreamOutputBuffer(ID3D11Device* device, const Buf
 {
     CreateResource(
         device,
-        CD3D11_BUFFER_DESC(static_cast<UINT>(desc.size), D3D11_BIND_STREAM_OUTPUT),
+        CD3D11_BUFFER_DESC(static_cast<UINT>(desc.size), (D3D11_BIND_STREAM_OUTPUT | D3D11_BIND_VERTEX_BUFFER)),
         initialData,
         desc.flags
     );
+    stride_ = desc.vertexBuffer.format.stride;
 }
 
 
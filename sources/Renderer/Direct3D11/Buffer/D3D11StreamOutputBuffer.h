@@ -29,9 +29,16 @@ class D3D11StreamOutputBuffer final : public D3D11Buffer
             return offset_;
         }
 
+        // Returns the vertex stride, when this buffer is used as vertex buffer.
+        inline UINT GetStride() const
+        {
+            return stride_;
+        }
+
     private:
 
         UINT offset_ = 0;
+        UINT stride_ = 0;
 
 };
 
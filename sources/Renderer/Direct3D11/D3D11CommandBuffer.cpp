@@ -8,15 +8,22 @@
 #include "D3D11CommandBuffer.h"
 #include "D3D11RenderContext.h"
 #include "D3D11Types.h"
+#include "../DXCommon/DXTypes.h"
 #include "../CheckedCast.h"
+#include "../TransientRing.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include "../../Core/Helper.h"
 #include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "RenderState/D3D11StateManager.h"
 #include "RenderState/D3D11GraphicsPipelineBase.h"
 #include "RenderState/D3D11ComputePipeline.h"
 #include "RenderState/D3D11Query.h"
+#include "RenderState/D3D11QueryHeap.h"
 #include "RenderState/D3D11ResourceHeap.h"
 
 #include "Buffer/D3D11VertexBuffer.h"
@@ -35,18 +42,34 @@ namespace LLGL
 {
 
 
-#define VS_STAGE(FLAG)  ( ((FLAG) & StageFlags::VertexStage        ) != 0 )
-#define HS_STAGE(FLAG)  ( ((FLAG) & StageFlags::TessControlStage   ) != 0 )
-#define DS_STAGE(FLAG)  ( ((FLAG) & StageFlags::TessEvaluationStage) != 0 )
-#define GS_STAGE(FLAG)  ( ((FLAG) & StageFlags::GeometryStage      ) != 0 )
-#define PS_STAGE(FLAG)  ( ((FLAG) & StageFlags::FragmentStage      ) != 0 )
-#define CS_STAGE(FLAG)  ( ((FLAG) & StageFlags::ComputeStage       ) != 0 )
-#define SRV_STAGE(FLAG) ( ((FLAG) & StageFlags::ReadOnlyResource   ) != 0 )
+#define SRV_STAGE(FLAG) ( ((FLAG) & StageFlags::ReadOnlyResource) != 0 )
 
-D3D11CommandBuffer::D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context) :
-    stateMngr_ { stateMngr },
-    context_   { context   }
+D3D11CommandBuffer::D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context, StatisticsCounter& statistics, long flags) :
+    stateMngr_       { stateMngr                                                   },
+    statistics_      { statistics                                                  },
+    context_         { context                                                     },
+    timerStatistics_ { ((flags & CommandBufferFlags::TimerScopeStatistics) != 0) }
 {
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    /* Query extended device context to discard views (optional) */
+    context_->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(context1_.ReleaseAndGetAddressOf()));
+    #endif
+
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    /* Query annotation interface for debug groups and markers (optional) */
+    context_->QueryInterface(__uuidof(ID3DUserDefinedAnnotation), reinterpret_cast<void**>(annotation_.ReleaseAndGetAddressOf()));
+    #endif
+}
+
+D3D11CommandBuffer::D3D11CommandBuffer(std::unique_ptr<D3D11StateManager>&& deferredStateMngr, const ComPtr<ID3D11DeviceContext>& deferredContext, StatisticsCounter& statistics, long flags) :
+    D3D11CommandBuffer { *deferredStateMngr, deferredContext, statistics, flags }
+{
+    deferredStateMngr_ = std::move(deferredStateMngr);
+}
+
+D3D11CommandBuffer::~D3D11CommandBuffer()
+{
+    // dummy (required for the state manager of deferred contexts)
 }
 
 /* ----- Configuration ----- */
@@ -165,17 +188,40 @@ void D3D11CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 
 void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
-    auto& vertexBufferD3D = LLGL_CAST(D3D11VertexBuffer&, buffer);
+    SetVertexBuffer(buffer, 0);
+}
+
+void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    if (buffer.GetType() == BufferType::StreamOutput)
+    {
+        /* Bind stream-output buffer as vertex buffer, e.g. for DrawStreamOutput */
+        auto& streamOutputBufferD3D = LLGL_CAST(D3D11StreamOutputBuffer&, buffer);
+
+        ID3D11Buffer* buffers[] = { streamOutputBufferD3D.GetNative() };
+        UINT strides[] = { streamOutputBufferD3D.GetStride() };
+        UINT offsets[] = { static_cast<UINT>(offset) };
+
+        context_->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+    }
+    else
+    {
+        auto& vertexBufferD3D = LLGL_CAST(D3D11VertexBuffer&, buffer);
 
-    ID3D11Buffer* buffers[] = { vertexBufferD3D.GetNative() };
-    UINT strides[] = { vertexBufferD3D.GetStride() };
-    UINT offsets[] = { 0 };
+        ID3D11Buffer* buffers[] = { vertexBufferD3D.GetNative() };
+        UINT strides[] = { vertexBufferD3D.GetStride() };
+        UINT offsets[] = { vertexBufferD3D.GetRegionOffset() + static_cast<UINT>(offset) };
 
-    context_->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+        context_->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+    }
 }
 
 void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
     context_->IASetVertexBuffers(
         0,
@@ -188,24 +234,57 @@ void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& indexBufferD3D = LLGL_CAST(D3D11IndexBuffer&, buffer);
+    context_->IASetIndexBuffer(indexBufferD3D.GetNative(), indexBufferD3D.GetFormat(), indexBufferD3D.GetRegionOffset());
+}
+
+void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& indexBufferD3D = LLGL_CAST(D3D11IndexBuffer&, buffer);
-    context_->IASetIndexBuffer(indexBufferD3D.GetNative(), indexBufferD3D.GetFormat(), 0);
+    context_->IASetIndexBuffer(
+        indexBufferD3D.GetNative(),
+        D3D11Types::Map(format.GetDataType()),
+        indexBufferD3D.GetRegionOffset() + static_cast<UINT>(offset)
+    );
 }
 
 /* ----- Constant Buffers ------ */
 
 void D3D11CommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     /* Set constant buffer resource to all shader stages */
     auto& constantBufferD3D = LLGL_CAST(D3D11ConstantBuffer&, buffer);
     auto resource = constantBufferD3D.GetNative();
-    SetConstantBuffersOnStages(slot, 1, &resource, stageFlags);
+    stateMngr_.SetConstantBuffers(slot, 1, &resource, stageFlags);
+}
+
+void D3D11CommandBuffer::SetConstantBufferRange(Buffer& buffer, std::uint32_t slot, std::uint64_t offset, std::uint64_t size, long stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    /* Set range of constant buffer resource in units of 16-byte shader constants */
+    auto& constantBufferD3D = LLGL_CAST(D3D11ConstantBuffer&, buffer);
+    stateMngr_.SetConstantBufferRange(
+        slot,
+        constantBufferD3D.GetNative(),
+        static_cast<UINT>(offset / 16u),
+        static_cast<UINT>(size / 16u),
+        stageFlags
+    );
 }
 
 /* ----- Storage Buffers ------ */
 
 void D3D11CommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& storageBufferD3D = LLGL_CAST(D3D11StorageBuffer&, buffer);
 
     if (storageBufferD3D.HasUAV() && !SRV_STAGE(stageFlags))
@@ -213,13 +292,13 @@ void D3D11CommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, lo
         /* Set UAVs to specified shader stages */
         ID3D11UnorderedAccessView* uavList[] = { storageBufferD3D.GetUAV() };
         UINT auvCounts[] = { storageBufferD3D.GetInitialCount() };
-        SetUnorderedAccessViewsOnStages(slot, 1, uavList, auvCounts, stageFlags);
+        stateMngr_.SetUnorderedAccessViews(slot, 1, uavList, auvCounts, stageFlags);
     }
     else
     {
         /* Set SRVs to specified shader stages */
         ID3D11ShaderResourceView* srvList[] = { storageBufferD3D.GetSRV() };
-        SetShaderResourcesOnStages(slot, 1, srvList, stageFlags);
+        stateMngr_.SetShaderResources(slot, 1, srvList, stageFlags);
     }
 }
 
@@ -227,32 +306,49 @@ void D3D11CommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, lo
 
 void D3D11CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& streamOutputBufferD3D = LLGL_CAST(D3D11StreamOutputBuffer&, buffer);
 
-    ID3D11Buffer* buffers[] = { streamOutputBufferD3D.GetNative() };
-    UINT offsets[] = { 0 };
+    streamOutputTargets_.buffers[0] = streamOutputBufferD3D.GetNative();
+    streamOutputTargets_.count      = 1;
 
-    context_->SOSetTargets(1, buffers, offsets);
+    SubmitStreamOutputTargets(0);
 }
 
 void D3D11CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
-    context_->SOSetTargets(
-        bufferArrayD3D.GetCount(),
-        bufferArrayD3D.GetBuffers(),
-        bufferArrayD3D.GetOffsets()
-    );
+
+    streamOutputTargets_.count = std::min(bufferArrayD3D.GetCount(), static_cast<UINT>(D3D11_SO_BUFFER_SLOT_COUNT));
+    std::copy(bufferArrayD3D.GetBuffers(), bufferArrayD3D.GetBuffers() + streamOutputTargets_.count, streamOutputTargets_.buffers);
+
+    SubmitStreamOutputTargets(0);
 }
 
 void D3D11CommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
-    // dummy
+    /* Restart stream-output at the beginning of each buffer */
+    SubmitStreamOutputTargets(0);
 }
 
 void D3D11CommandBuffer::EndStreamOutput()
 {
-    // dummy
+    /* Unbind stream-output targets, so the buffers can be used as vertex buffers for DrawStreamOutput */
+    context_->SOSetTargets(0, nullptr, nullptr);
+}
+
+void D3D11CommandBuffer::PauseStreamOutput()
+{
+    context_->SOSetTargets(0, nullptr, nullptr);
+}
+
+void D3D11CommandBuffer::ResumeStreamOutput()
+{
+    /* Append to the vertices that have been captured before the stream-output was paused */
+    SubmitStreamOutputTargets(static_cast<UINT>(-1));
 }
 
 
@@ -260,34 +356,201 @@ void D3D11CommandBuffer::EndStreamOutput()
 
 void D3D11CommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     /* Set texture resource to all shader stages */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     auto resource = textureD3D.GetSRV();
-    SetShaderResourcesOnStages(slot, 1, &resource, stageFlags);
+    stateMngr_.SetShaderResources(slot, 1, &resource, stageFlags);
 }
 
 /* ----- Sampler States ----- */
 
 void D3D11CommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     /* Set sampler state object to all shader stages */
     auto& samplerD3D = LLGL_CAST(D3D11Sampler&, sampler);
     auto resource = samplerD3D.GetNative();
-    SetSamplersOnStages(slot, 1, &resource, stageFlags);
+    stateMngr_.SetSamplers(slot, 1, &resource, stageFlags);
 }
 
 /* ----- Resource Heaps ----- */
 
-void D3D11CommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*firstSet*/)
+void D3D11CommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
-    resourceHeapD3D.BindForGraphicsPipeline(context_.Get());
+    resourceHeapD3D.BindForGraphicsPipeline(stateMngr_, numDynamicOffsets, dynamicOffsets);
 }
 
-void D3D11CommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*firstSet*/)
+void D3D11CommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
-    resourceHeapD3D.BindForComputePipeline(context_.Get());
+    resourceHeapD3D.BindForComputePipeline(stateMngr_, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constants ----- */
+
+void D3D11CommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    auto& constants = ((stageFlags & StageFlags::ComputeStage) != 0 ? computeConstants_ : graphicsConstants_);
+
+    /* Constants outside of the layout of the bound pipeline are ignored like on the other backends */
+    if (offset + size > std::min(constants.layout.size, static_cast<std::uint32_t>(maxConstantsSize)))
+        return;
+
+    ::memcpy(constants.data + offset, data, size);
+    UploadConstants(constants, stageFlags & constants.layout.stageFlags);
+}
+
+//private
+void D3D11CommandBuffer::UploadConstants(D3D11ConstantsState& constants, long stageFlags)
+{
+    if (!constants.buffer)
+    {
+        /* Create hidden constant buffer with the maximal size, so it can be shared by all pipeline layouts */
+        ComPtr<ID3D11Device> device;
+        context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+        D3D11_BUFFER_DESC bufferDesc;
+        {
+            bufferDesc.ByteWidth            = maxConstantsSize;
+            bufferDesc.Usage                = D3D11_USAGE_DYNAMIC;
+            bufferDesc.BindFlags            = D3D11_BIND_CONSTANT_BUFFER;
+            bufferDesc.CPUAccessFlags       = D3D11_CPU_ACCESS_WRITE;
+            bufferDesc.MiscFlags            = 0;
+            bufferDesc.StructureByteStride  = 0;
+        }
+        auto hr = device->CreateBuffer(&bufferDesc, nullptr, constants.buffer.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 constant buffer for constants");
+    }
+
+    /* Discard previous buffer content, since the entire shadow data is written */
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    auto hr = context_->Map(constants.buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 constant buffer for constants");
+    {
+        ::memcpy(mappedSubresource.pData, constants.data, std::min(constants.layout.size, static_cast<std::uint32_t>(maxConstantsSize)));
+    }
+    context_->Unmap(constants.buffer.Get(), 0);
+
+    ID3D11Buffer* buffer = constants.buffer.Get();
+    stateMngr_.SetConstantBuffers(constants.layout.slot, 1, &buffer, stageFlags);
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation D3D11CommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    if (size == 0 || size > g_transientRingSize)
+        throw std::out_of_range("cannot allocate transient memory of zero size or larger than the ring buffer of the command buffer");
+
+    if (!transientBuffer_)
+        CreateTransientBuffer();
+
+    /* Constant buffer ranges must start at multiples of 16 shader constants */
+    if (alignment == 0)
+        alignment = 256;
+
+    auto offset = GetAlignedSize<std::uint64_t>(transientHead_, alignment);
+
+    if (offset + size > g_transientRingSize)
+    {
+        /* Data of a previous wrap-around that has not been uploaded yet would be overwritten */
+        if (transientDiscard_ && transientPending_)
+            throw std::out_of_range("transient memory allocations since the last draw or dispatch command exceed the ring buffer of the command buffer");
+
+        /* Wrap around; the next upload discards the buffer, so the GPU can still read the previous contents */
+        offset              = 0;
+        transientDiscard_   = true;
+    }
+
+    transientHead_      = static_cast<UINT>(offset + size);
+    transientExtent_    = std::max(transientExtent_, transientHead_);
+    transientPending_   = true;
+
+    TransientAllocation allocation;
+    {
+        allocation.data     = transientShadow_.data() + offset;
+        allocation.buffer   = transientBuffer_.get();
+        allocation.offset   = offset;
+    }
+    return allocation;
+}
+
+//private
+void D3D11CommandBuffer::CreateTransientBuffer()
+{
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+    /* Transient allocations are bound as constant buffer ranges, which are written without waiting for the GPU */
+    bool hasNoOverwrite = false;
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        hasNoOverwrite = (options.MapNoOverwriteOnDynamicConstantBuffer != FALSE);
+    #endif
+
+    if (!stateMngr_.HasConstantBufferRanges() || !hasNoOverwrite)
+        throw std::runtime_error("transient memory requires Direct3D 11.1 with constant buffer offsetting");
+
+    D3D11_BUFFER_DESC bufferDesc;
+    {
+        bufferDesc.ByteWidth            = static_cast<UINT>(g_transientRingSize);
+        bufferDesc.Usage                = D3D11_USAGE_DYNAMIC;
+        bufferDesc.BindFlags            = D3D11_BIND_CONSTANT_BUFFER;
+        bufferDesc.CPUAccessFlags       = D3D11_CPU_ACCESS_WRITE;
+        bufferDesc.MiscFlags            = 0;
+        bufferDesc.StructureByteStride  = 0;
+    }
+    transientBuffer_ = MakeUnique<D3D11ConstantBuffer>(device.Get(), bufferDesc);
+    transientShadow_.resize(static_cast<std::size_t>(g_transientRingSize));
+}
+
+//private
+void D3D11CommandBuffer::UploadTransientWrites()
+{
+    auto buffer = transientBuffer_->GetNative();
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    if (transientDiscard_)
+    {
+        /* Discard the buffer and write all ranges of the shadow that might still be bound */
+        auto hr = context_->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+        DXThrowIfFailed(hr, "failed to map D3D11 transient ring buffer");
+        ::memcpy(mappedSubresource.pData, transientShadow_.data(), transientExtent_);
+        transientDiscard_ = false;
+    }
+    else
+    {
+        /* Append the range since the last upload, which is not read by any previous command */
+        auto hr = context_->Map(buffer, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedSubresource);
+        DXThrowIfFailed(hr, "failed to map D3D11 transient ring buffer");
+        ::memcpy(
+            reinterpret_cast<char*>(mappedSubresource.pData) + transientUploaded_,
+            transientShadow_.data() + transientUploaded_,
+            transientHead_ - transientUploaded_
+        );
+    }
+    context_->Unmap(buffer, 0);
+
+    transientUploaded_  = transientHead_;
+    transientPending_   = false;
 }
 
 /* ----- Render Targets ----- */
@@ -295,12 +558,14 @@ void D3D11CommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std:
 //private
 void D3D11CommandBuffer::ResolveBoundRenderTarget()
 {
-    if (boundRenderTarget_)
+    if (boundRenderTarget_ != nullptr && resolvePending_)
         boundRenderTarget_->ResolveSubresources(context_.Get());
 }
 
 void D3D11CommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+
     auto& renderTargetD3D = LLGL_CAST(D3D11RenderTarget&, renderTarget);
 
     /* Resolve previously bound render target (in case mutli-sampling is used) */
@@ -313,11 +578,14 @@ void D3D11CommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
     SubmitFramebufferView();
 
     /* Store current render target */
-    boundRenderTarget_ = &renderTargetD3D;
+    boundRenderTarget_  = &renderTargetD3D;
+    resolvePending_     = true;
 }
 
 void D3D11CommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+
     auto& renderContextD3D = LLGL_CAST(D3D11RenderContext&, renderContext);
 
     /* Resolve previously bound render target (in case mutli-sampling is used) */
@@ -333,20 +601,222 @@ void D3D11CommandBuffer::SetRenderTarget(RenderContext& renderContext)
 
     /* Reset reference to render target */
     boundRenderTarget_ = nullptr;
+
+    /* Track presentations of this render context to determine the end of each timer scope frame */
+    if (timerRenderContext_ != &renderContextD3D)
+    {
+        UpdateTimerScopeFrame();
+        timerRenderContext_ = &renderContextD3D;
+        timerPresentCount_  = renderContextD3D.GetPresentCount();
+    }
+}
+
+void D3D11CommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    SetRenderTarget(renderTarget);
+    if (renderPass != nullptr)
+        BeginRenderPassWithFramebufferView(*renderPass, numClearValues, clearValues);
+}
+
+void D3D11CommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    SetRenderTarget(renderContext);
+    if (renderPass != nullptr)
+        BeginRenderPassWithFramebufferView(*renderPass, numClearValues, clearValues);
+}
+
+void D3D11CommandBuffer::EndRenderPass()
+{
+    /* Discard all attachments whose content is not stored (multi-sampled render targets are resolved later) */
+    if (boundRenderPass_ != nullptr)
+    {
+        const bool multiSampled = (boundRenderTarget_ != nullptr && boundRenderTarget_->HasMultiSampling());
+
+        if (multiSampled)
+        {
+            /* Multi-sample render target does not need to be resolved if the content of all its color attachments is undefined */
+            bool storeColor = false;
+
+            for (std::size_t i = 0; i < framebufferView_.rtvList.size() && !storeColor; ++i)
+                storeColor = (boundRenderPass_->GetColorAttachmentOps(static_cast<std::uint32_t>(i)).storeOp != AttachmentStoreOp::Undefined);
+
+            if (!storeColor)
+                resolvePending_ = false;
+        }
+
+        if (!multiSampled || !resolvePending_)
+            DiscardRenderPassAttachments(*boundRenderPass_, false);
+
+        boundRenderPass_ = nullptr;
+    }
+}
+
+void D3D11CommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    auto& srcRenderTargetD3D = LLGL_CAST(D3D11RenderTarget&, srcRenderTarget);
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    srcRenderTargetD3D.ResolveColorAttachment(context_.Get(), srcColorAttachment, dstTextureD3D.GetNative().resource.Get(), 0);
+}
+
+void D3D11CommandBuffer::DiscardAttachments(long flags)
+{
+    /* Discarded color attachments of a multi-sample render target are not resolved */
+    if ((flags & ClearFlags::Color) != 0)
+        resolvePending_ = false;
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+    if (!context1_)
+        return;
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for (auto rtv : framebufferView_.rtvList)
+            context1_->DiscardView(rtv);
+    }
+
+    /* Depth-stencil view can only be discarded as a whole */
+    if ((flags & ClearFlags::DepthStencil) == ClearFlags::DepthStencil && framebufferView_.dsv != nullptr)
+        context1_->DiscardView(framebufferView_.dsv);
+
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+}
+
+//private
+void D3D11CommandBuffer::BeginRenderPassWithFramebufferView(const RenderPass& renderPass, std::uint32_t numClearValues, const ClearValue* clearValues)
+{
+    boundRenderPass_ = &renderPass;
+
+    /* Discard all attachments whose previous content is not loaded */
+    DiscardRenderPassAttachments(renderPass, true);
+
+    /* Clear all attachments with clear operation; clear values are consumed in the order of these attachments */
+    std::uint32_t clearValueIndex = 0;
+
+    auto NextClearValue = [&]() -> const ClearValue&
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : clearValue_);
+    };
+
+    const auto numColorAttachments = static_cast<std::uint32_t>(framebufferView_.rtvList.size());
+
+    for (std::uint32_t i = 0; i < numColorAttachments; ++i)
+    {
+        if (renderPass.GetColorAttachmentOps(i).loadOp == AttachmentLoadOp::Clear)
+            context_->ClearRenderTargetView(framebufferView_.rtvList[i], NextClearValue().color.Ptr());
+    }
+
+    if (framebufferView_.dsv != nullptr)
+    {
+        const auto& desc = renderPass.GetDesc();
+
+        /* Depth and stencil components share a single clear value */
+        UINT clearFlagsDSV = 0;
+
+        if (desc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+            clearFlagsDSV |= D3D11_CLEAR_DEPTH;
+        if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+            clearFlagsDSV |= D3D11_CLEAR_STENCIL;
+
+        if (clearFlagsDSV != 0)
+        {
+            const auto& clearValue = NextClearValue();
+            context_->ClearDepthStencilView(
+                framebufferView_.dsv,
+                clearFlagsDSV,
+                clearValue.depth,
+                static_cast<UINT8>(clearValue.stencil & 0xff)
+            );
+        }
+    }
+}
+
+//private
+void D3D11CommandBuffer::DiscardRenderPassAttachments(const RenderPass& renderPass, bool loadOps)
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+    if (!context1_)
+        return;
+
+    auto IsUndefined = [loadOps](const AttachmentOpsDescriptor& ops)
+    {
+        return (loadOps ? ops.loadOp == AttachmentLoadOp::Undefined : ops.storeOp == AttachmentStoreOp::Undefined);
+    };
+
+    for (std::size_t i = 0; i < framebufferView_.rtvList.size(); ++i)
+    {
+        if (IsUndefined(renderPass.GetColorAttachmentOps(static_cast<std::uint32_t>(i))))
+            context1_->DiscardView(framebufferView_.rtvList[i]);
+    }
+
+    /* Depth-stencil view can only be discarded as a whole */
+    if (framebufferView_.dsv != nullptr)
+    {
+        const auto& desc = renderPass.GetDesc();
+        if (IsUndefined(desc.depthAttachment) && IsUndefined(desc.stencilAttachment))
+            context1_->DiscardView(framebufferView_.dsv);
+    }
+
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
 }
 
 /* ----- Pipeline States ----- */
 
 void D3D11CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_STATISTICS_INC(pipelineBindings);
+
     auto& graphicsPipelineD3D = LLGL_CAST(D3D11GraphicsPipelineBase&, graphicsPipeline);
     graphicsPipelineD3D.Bind(stateMngr_);
+    graphicsConstants_.layout = graphicsPipelineD3D.GetConstants();
 }
 
 void D3D11CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_STATISTICS_INC(pipelineBindings);
+
     auto& computePipelineD3D = LLGL_CAST(D3D11ComputePipeline&, computePipeline);
     computePipelineD3D.Bind(stateMngr_);
+    computeConstants_.layout = computePipelineD3D.GetConstants();
+}
+
+void D3D11CommandBuffer::SetShadingRate(const ShadingRate /*rate*/)
+{
+    // dummy (not supported by D3D11, variable rate shading requires D3D12)
+}
+
+void D3D11CommandBuffer::SetShadingRateImage(Texture* /*texture*/)
+{
+    // dummy (not supported by D3D11, variable rate shading requires D3D12)
+}
+
+void D3D11CommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    stateMngr_.SetStencilRef(reference);
+}
+
+void D3D11CommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    stateMngr_.SetBlendFactor(color.Ptr());
+}
+
+void D3D11CommandBuffer::SetDepthBias(const DepthBiasDescriptor& /*depthBias*/)
+{
+    // dummy (not supported by D3D11, depth bias is part of the rasterizer state)
+}
+
+void D3D11CommandBuffer::SetDepthBounds(float /*minBounds*/, float /*maxBounds*/)
+{
+    // dummy (depth bounds test is not supported by D3D11)
 }
 
 /* ----- Queries ----- */
@@ -467,6 +937,22 @@ bool D3D11CommandBuffer::QueryResult(Query& query, std::uint64_t& result)
     return false;
 }
 
+static void Convert(QueryPipelineStatistics& dst, const D3D11_QUERY_DATA_PIPELINE_STATISTICS& src)
+{
+    dst.numPrimitivesGenerated              = src.CInvocations;
+    dst.numVerticesSubmitted                = src.IAVertices;
+    dst.numPrimitivesSubmitted              = src.IAPrimitives;
+    dst.numVertexShaderInvocations          = src.VSInvocations;
+    dst.numTessControlShaderInvocations     = src.HSInvocations;
+    dst.numTessEvaluationShaderInvocations  = src.DSInvocations;
+    dst.numGeometryShaderInvocations        = src.GSInvocations;
+    dst.numFragmentShaderInvocations        = src.PSInvocations;
+    dst.numComputeShaderInvocations         = src.CSInvocations;
+    dst.numGeometryPrimitivesGenerated      = src.GSPrimitives;
+    dst.numClippingInputPrimitives          = src.CInvocations; // <-- TODO: workaround
+    dst.numClippingOutputPrimitives         = src.CPrimitives;
+}
+
 bool D3D11CommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
 {
     auto& queryD3D = LLGL_CAST(D3D11Query&, query);
@@ -477,18 +963,7 @@ bool D3D11CommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipeli
         D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
         if (context_->GetData(queryD3D.GetQueryObject(), &data, sizeof(data), 0) == S_OK)
         {
-            result.numPrimitivesGenerated               = data.CInvocations;
-            result.numVerticesSubmitted                 = data.IAVertices;
-            result.numPrimitivesSubmitted               = data.IAPrimitives;
-            result.numVertexShaderInvocations           = data.VSInvocations;
-            result.numTessControlShaderInvocations      = data.HSInvocations;
-            result.numTessEvaluationShaderInvocations   = data.DSInvocations;
-            result.numGeometryShaderInvocations         = data.GSInvocations;
-            result.numFragmentShaderInvocations         = data.PSInvocations;
-            result.numComputeShaderInvocations          = data.CSInvocations;
-            result.numGeometryPrimitivesGenerated       = data.GSPrimitives;
-            result.numClippingInputPrimitives           = data.CInvocations; // <-- TODO: workaround
-            result.numClippingOutputPrimitives          = data.CPrimitives;
+            Convert(result, data);
             return true;
         }
     }
@@ -507,59 +982,809 @@ void D3D11CommandBuffer::EndRenderCondition()
     context_->SetPredication(nullptr, FALSE);
 }
 
-/* ----- Drawing ----- */
-
-void D3D11CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+void D3D11CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    context_->Draw(numVertices, firstVertex);
+    auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
+    context_->Begin(queryHeapD3D.GetQueryObject(query));
 }
 
-void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+void D3D11CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    context_->DrawIndexed(numIndices, firstIndex, 0);
+    auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
+    context_->End(queryHeapD3D.GetQueryObject(query));
 }
 
-void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+void D3D11CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
-    context_->DrawIndexed(numIndices, firstIndex, vertexOffset);
+    /* Only query heaps with boolean results provide predicates */
+    auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
+    if (auto predicate = queryHeapD3D.GetPredicateObject(query))
+        context_->SetPredication(predicate, (mode >= RenderConditionMode::WaitInverted));
 }
 
-void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+bool D3D11CommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
 {
-    context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
+    auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
+
+    /* Check the last query of the range first, since it is most likely the last one to complete */
+    std::uint64_t lastResult = 0;
+    if (!queryHeapD3D.GetResult(context_.Get(), firstQuery + numQueries - 1, lastResult))
+        return false;
+
+    /* Retrieve all results into intermediate storage, since the output must not be modified if any result is unavailable */
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto intermediateResults = scratch_.Allocate<std::uint64_t>(numQueries);
+    intermediateResults[numQueries - 1] = lastResult;
+
+    for (std::uint32_t i = 0; i + 1 < numQueries; ++i)
+    {
+        if (!queryHeapD3D.GetResult(context_.Get(), firstQuery + i, intermediateResults[i]))
+            return false;
+    }
+
+    std::copy(intermediateResults, intermediateResults + numQueries, results);
+
+    return true;
 }
 
-void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+void D3D11CommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
 {
-    context_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
+    // dummy (not supported by D3D11, since query results cannot be copied into a buffer on the GPU)
 }
 
-void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+/* ----- Timer Scopes ----- */
+
+void D3D11CommandBuffer::BeginTimerScope(const char* name)
 {
-    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+    UpdateTimerScopeFrame();
+    EndStatisticsSegment();
+
+    const auto firstScope = timerScopes_.IsCurrentFrameEmpty();
+
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.BeginScope(name, timestampIndex))
+    {
+        if (firstScope)
+        {
+            /* Begin disjoint query of this frame with its first timer scope */
+            auto& disjointQuery = timerDisjointQueries_[timerScopes_.GetCurrentFrame()];
+            if (!disjointQuery)
+            {
+                ComPtr<ID3D11Device> device;
+                context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+                D3D11_QUERY_DESC queryDesc;
+                {
+                    queryDesc.Query     = D3D11_QUERY_TIMESTAMP_DISJOINT;
+                    queryDesc.MiscFlags = 0;
+                }
+                auto hr = device->CreateQuery(&queryDesc, disjointQuery.ReleaseAndGetAddressOf());
+                DXThrowIfFailed(hr, "failed to create D3D11 disjoint query for timer scopes");
+            }
+            context_->Begin(disjointQuery.Get());
+        }
+        WriteTimestamp(timestampIndex);
+    }
+
+    BeginStatisticsSegment();
 }
 
-void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+void D3D11CommandBuffer::EndTimerScope()
 {
-    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.EndScope(timestampIndex))
+        WriteTimestamp(timestampIndex);
+
+    BeginStatisticsSegment();
 }
 
-void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+bool D3D11CommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
 {
-    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
-}
+    UpdateTimerScopeFrame();
 
-/* ----- Compute ----- */
+    if (!timerScopes_.HasPendingFrame())
+        return false;
 
-void D3D11CommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
-{
-    context_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
-}
+    const auto pendingFrame = timerScopes_.GetPendingFrame();
 
+    /* Check if the disjoint query of the pending frame is available without flushing the command buffer */
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+    if (context_->GetData(timerDisjointQueries_[pendingFrame].Get(), &disjointData, sizeof(disjointData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+        return false;
 
-/*
- * ======= Private: =======
- */
+    /* Timestamps are invalid if the GPU frequency has changed during the frame */
+    if (disjointData.Disjoint != FALSE)
+    {
+        timerScopes_.DiscardPendingFrame();
+        return false;
+    }
+
+    /* Read timestamps and resolve timer scopes */
+    const auto firstTimestamp   = timerScopes_.GetFirstTimestamp(pendingFrame);
+    const auto numTimestamps    = timerScopes_.GetNumTimestamps(pendingFrame);
+
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto timestamps = scratch_.Allocate<std::uint64_t>(numTimestamps);
+
+    for (std::uint32_t i = 0; i < numTimestamps; ++i)
+    {
+        UINT64 timestamp = 0;
+        if (context_->GetData(timestampQueries_[firstTimestamp + i].Get(), &timestamp, sizeof(timestamp), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            return false;
+        timestamps[i] = timestamp;
+    }
+
+    /* Read pipeline statistics of all segments */
+    QueryPipelineStatistics* statistics = nullptr;
+    if (timerStatistics_)
+    {
+        const auto firstSegment = timerScopes_.GetFirstSegment(pendingFrame);
+        const auto numSegments  = timerScopes_.GetNumSegments(pendingFrame);
+
+        statistics = scratch_.Allocate<QueryPipelineStatistics>(numSegments);
+        for (std::uint32_t i = 0; i < numSegments; ++i)
+        {
+            D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
+            if (context_->GetData(statisticsQueries_[firstSegment + i].Get(), &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+                return false;
+            Convert(statistics[i], data);
+        }
+    }
+
+    timerScopes_.ResolvePendingFrame(timestamps, 1000000000.0 / static_cast<double>(disjointData.Frequency), frame, statistics);
+
+    return true;
+}
+
+/* ----- Debug Markers ----- */
+
+#if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+// Converts the specified debug marker name to a wide string; the names are expected to be ASCII
+static std::wstring ToDebugMarkerName(const char* name)
+{
+    return (name != nullptr ? std::wstring(name, name + std::strlen(name)) : std::wstring());
+}
+
+#endif // /LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+void D3D11CommandBuffer::PushDebugGroup(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (annotation_)
+        annotation_->BeginEvent(ToDebugMarkerName(name).c_str());
+    #endif
+}
+
+void D3D11CommandBuffer::PopDebugGroup()
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (annotation_)
+        annotation_->EndEvent();
+    #endif
+}
+
+void D3D11CommandBuffer::InsertDebugMarker(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (annotation_)
+        annotation_->SetMarker(ToDebugMarkerName(name).c_str());
+    #endif
+}
+
+/* ----- Drawing ----- */
+
+void D3D11CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->Draw(numVertices, firstVertex);
+}
+
+void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexed(numIndices, firstIndex, 0);
+}
+
+void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexed(numIndices, firstIndex, vertexOffset);
+}
+
+void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
+}
+
+void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
+}
+
+void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+}
+
+void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
+}
+
+void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+
+    /* D3D11 has no multi-draw commands, so submit draw commands one after another */
+    for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+        context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+        context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
+}
+
+void D3D11CommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  /*layout*/,
+    Buffer&                 /*argumentBuffer*/,
+    std::uint64_t           /*argumentOffset*/,
+    std::uint32_t           /*maxNumCommands*/,
+    Buffer*                 /*countBuffer*/,
+    std::uint64_t           /*countOffset*/)
+{
+    // dummy (not supported by D3D11, indirect command layouts require D3D12)
+}
+
+void D3D11CommandBuffer::DrawStreamOutput()
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushGraphicsResourceBindings();
+    context_->DrawAuto();
+}
+
+void D3D11CommandBuffer::DrawMeshTasks(std::uint32_t /*groupSizeX*/, std::uint32_t /*groupSizeY*/, std::uint32_t /*groupSizeZ*/)
+{
+    // dummy (mesh shaders are not supported by D3D11)
+}
+
+void D3D11CommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    // dummy (mesh shaders are not supported by D3D11)
+}
+
+/* ----- Compute ----- */
+
+void D3D11CommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    FlushTransientWrites();
+    stateMngr_.FlushComputeResourceBindings();
+    context_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+}
+
+void D3D11CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    FlushTransientWrites();
+    stateMngr_.FlushComputeResourceBindings();
+    context_->DispatchIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
+}
+
+void D3D11CommandBuffer::DispatchBarrier()
+{
+    // dummy (hazards between dispatches are tracked by the D3D11 runtime)
+}
+
+/* ----- Acceleration Structures ----- */
+
+void D3D11CommandBuffer::BuildAccelerationStructures(std::uint32_t /*numAccelerationStructures*/, AccelerationStructure* const * /*accelerationStructures*/)
+{
+    // dummy (acceleration structures are not supported by D3D11)
+}
+
+void D3D11CommandBuffer::CompactAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/)
+{
+    // dummy (acceleration structures are not supported by D3D11)
+}
+
+/* ----- Copy ----- */
+
+// Returns the row pitch and the pitch of each 2D slice (in bytes) of texel data within a buffer.
+static void GetD3DBufferTexelPitches(const D3D11Texture& textureD3D, const D3D11_BOX& box, std::uint32_t rowStride, UINT& rowPitch, UINT& slicePitch)
+{
+    const auto texelSize = FormatBitSize(DXTypes::Unmap(textureD3D.GetFormat())) / 8;
+    rowPitch    = (rowStride > 0 ? rowStride : (box.right - box.left) * texelSize);
+    slicePitch  = rowPitch * (box.bottom - box.top);
+}
+
+void D3D11CommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
+
+    /* Copy from the current region if the source is a dynamic ring */
+    srcOffset += srcBufferD3D.GetRegionOffset();
+
+    const CD3D11_BOX srcBox(static_cast<LONG>(srcOffset), 0, 0, static_cast<LONG>(srcOffset + size), 1, 1);
+
+    context_->CopySubresourceRegion(
+        dstBufferD3D.GetNative(),
+        0,
+        static_cast<UINT>(dstOffset), 0, 0, // DstX, DstY, DstZ
+        srcBufferD3D.GetNative(),
+        0,
+        &srcBox
+    );
+}
+
+void D3D11CommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D11StorageBuffer&, srcBuffer);
+
+    context_->CopyStructureCount(dstBufferD3D.GetNative(), static_cast<UINT>(dstOffset), srcBufferD3D.GetUAV());
+}
+
+void D3D11CommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    auto& storageBufferD3D = LLGL_CAST(D3D11StorageBuffer&, buffer);
+    stateMngr_.SetUnorderedAccessViewCounter(storageBufferD3D.GetUAV(), value);
+}
+
+void D3D11CommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    static const std::uint64_t maxChunkSize = 64 * 1024;
+
+    if (fillSize == 0)
+        return;
+
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+
+    /* Clear byte-address storage buffers entirely on the GPU with a raw UAV of the destination range */
+    if (dstBuffer.GetType() == BufferType::Storage)
+    {
+        auto& storageBufferD3D = LLGL_CAST(D3D11StorageBuffer&, dstBuffer);
+        if (storageBufferD3D.HasUAV() && storageBufferD3D.IsByteAddressable())
+        {
+            ComPtr<ID3D11Device> device;
+            context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+            D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+            {
+                uavDesc.Format              = DXGI_FORMAT_R32_TYPELESS;
+                uavDesc.ViewDimension       = D3D11_UAV_DIMENSION_BUFFER;
+                uavDesc.Buffer.FirstElement = static_cast<UINT>(dstOffset / sizeof(std::uint32_t));
+                uavDesc.Buffer.NumElements  = static_cast<UINT>(fillSize / sizeof(std::uint32_t));
+                uavDesc.Buffer.Flags        = D3D11_BUFFER_UAV_FLAG_RAW;
+            }
+            ComPtr<ID3D11UnorderedAccessView> uav;
+            auto hr = device->CreateUnorderedAccessView(dstBufferD3D.GetNative(), &uavDesc, uav.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 unordered-access-view (UAV) to fill buffer");
+
+            const UINT values[4] = { value, value, value, value };
+            context_->ClearUnorderedAccessViewUint(uav.Get(), values);
+            return;
+        }
+    }
+
+    /* Update all other buffers with the pattern, which is reused for each chunk of the range */
+    const auto chunkSize = std::min(fillSize, maxChunkSize);
+    const std::vector<std::uint32_t> pattern(static_cast<std::size_t>(chunkSize / sizeof(std::uint32_t)), value);
+
+    for (std::uint64_t offset = 0; offset < fillSize; offset += chunkSize)
+    {
+        dstBufferD3D.UpdateSubresource(
+            context_.Get(),
+            pattern.data(),
+            static_cast<UINT>(std::min(chunkSize, fillSize - offset)),
+            static_cast<UINT>(dstOffset + offset)
+        );
+    }
+}
+
+void D3D11CommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
+
+    UINT        srcBaseArrayLayer = 0, dstBaseArrayLayer = 0, numArrayLayers = 0;
+    D3D11_BOX   srcBox, dstBox;
+
+    srcTextureD3D.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, srcBaseArrayLayer, numArrayLayers, srcBox);
+    dstTextureD3D.GetSubresourceRegion(dstLocation.offset, srcRegion.extent, dstBaseArrayLayer, numArrayLayers, dstBox);
+
+    /* Copy region of each array layer, since each array layer is a separate subresource */
+    for (UINT layer = 0; layer < numArrayLayers; ++layer)
+    {
+        context_->CopySubresourceRegion(
+            dstTextureD3D.GetNative().resource.Get(),
+            D3D11CalcSubresource(dstLocation.mipLevel, dstBaseArrayLayer + layer, dstTextureD3D.GetNumMipLevels()),
+            dstBox.left, dstBox.top, dstBox.front,
+            srcTextureD3D.GetNative().resource.Get(),
+            D3D11CalcSubresource(srcRegion.mipLevel, srcBaseArrayLayer + layer, srcTextureD3D.GetNumMipLevels()),
+            &srcBox
+        );
+    }
+}
+
+// Converts the subresource of a texture into a render-target-view (RTV) descriptor for the specified MIP-map level.
+static void GetD3D11RTVDesc(D3D11_RENDER_TARGET_VIEW_DESC& desc, const D3D11Texture& textureD3D, UINT mipLevel, const TextureSubresource& subresource)
+{
+    desc.Format = textureD3D.GetFormat();
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE1D;
+            desc.Texture1D.MipSlice             = mipLevel;
+            break;
+        case TextureType::Texture1DArray:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE1DARRAY;
+            desc.Texture1DArray.MipSlice        = mipLevel;
+            desc.Texture1DArray.FirstArraySlice = subresource.baseArrayLayer;
+            desc.Texture1DArray.ArraySize       = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture2D:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MipSlice             = mipLevel;
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MipSlice        = mipLevel;
+            desc.Texture2DArray.FirstArraySlice = subresource.baseArrayLayer;
+            desc.Texture2DArray.ArraySize       = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture2DMS:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            desc.ViewDimension                      = D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY;
+            desc.Texture2DMSArray.FirstArraySlice   = subresource.baseArrayLayer;
+            desc.Texture2DMSArray.ArraySize         = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture3D:
+            desc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE3D;
+            desc.Texture3D.MipSlice             = mipLevel;
+            desc.Texture3D.FirstWSlice          = 0;
+            desc.Texture3D.WSize                = UINT(-1);
+            break;
+    }
+}
+
+// Converts the subresource of a texture into a depth-stencil-view (DSV) descriptor for the specified MIP-map level.
+static void GetD3D11DSVDesc(D3D11_DEPTH_STENCIL_VIEW_DESC& desc, const D3D11Texture& textureD3D, UINT mipLevel, const TextureSubresource& subresource)
+{
+    desc.Format = DXGetDepthStencilViewFormat(textureD3D.GetFormat());
+    desc.Flags  = 0;
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            desc.ViewDimension                  = D3D11_DSV_DIMENSION_TEXTURE1D;
+            desc.Texture1D.MipSlice             = mipLevel;
+            break;
+        case TextureType::Texture1DArray:
+            desc.ViewDimension                  = D3D11_DSV_DIMENSION_TEXTURE1DARRAY;
+            desc.Texture1DArray.MipSlice        = mipLevel;
+            desc.Texture1DArray.FirstArraySlice = subresource.baseArrayLayer;
+            desc.Texture1DArray.ArraySize       = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture2D:
+            desc.ViewDimension                  = D3D11_DSV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MipSlice             = mipLevel;
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            desc.ViewDimension                  = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MipSlice        = mipLevel;
+            desc.Texture2DArray.FirstArraySlice = subresource.baseArrayLayer;
+            desc.Texture2DArray.ArraySize       = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture2DMS:
+            desc.ViewDimension                  = D3D11_DSV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            desc.ViewDimension                      = D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY;
+            desc.Texture2DMSArray.FirstArraySlice   = subresource.baseArrayLayer;
+            desc.Texture2DMSArray.ArraySize         = subresource.numArrayLayers;
+            break;
+        case TextureType::Texture3D:
+            throw std::invalid_argument("cannot clear D3D11 3D texture with depth-stencil format");
+    }
+}
+
+/*
+D3D11 can only clear textures through their views, and textures have no unordered-access-views (UAV) yet,
+so a temporary render-target-view (RTV) or depth-stencil-view (DSV) is created for each MIP-map level.
+*/
+void D3D11CommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
+
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+    const auto dsvFormat = DXGetDepthStencilViewFormat(textureD3D.GetFormat());
+
+    for (UINT mipLevel = subresource.baseMipLevel; mipLevel < subresource.baseMipLevel + subresource.numMipLevels; ++mipLevel)
+    {
+        if (dsvFormat != DXGI_FORMAT_UNKNOWN)
+        {
+            D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc;
+            GetD3D11DSVDesc(dsvDesc, textureD3D, mipLevel, subresource);
+
+            ComPtr<ID3D11DepthStencilView> dsv;
+            auto hr = device->CreateDepthStencilView(textureD3D.GetNative().resource.Get(), &dsvDesc, dsv.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil-view (DSV) to clear texture (requires TextureFlags::AttachmentUsage)");
+
+            UINT clearFlags = D3D11_CLEAR_DEPTH;
+            if (dsvFormat == DXGI_FORMAT_D24_UNORM_S8_UINT || dsvFormat == DXGI_FORMAT_D32_FLOAT_S8X24_UINT)
+                clearFlags |= D3D11_CLEAR_STENCIL;
+
+            context_->ClearDepthStencilView(dsv.Get(), clearFlags, clearValue.depth, static_cast<UINT8>(clearValue.stencil));
+        }
+        else
+        {
+            D3D11_RENDER_TARGET_VIEW_DESC rtvDesc;
+            GetD3D11RTVDesc(rtvDesc, textureD3D, mipLevel, subresource);
+
+            ComPtr<ID3D11RenderTargetView> rtv;
+            auto hr = device->CreateRenderTargetView(textureD3D.GetNative().resource.Get(), &rtvDesc, rtv.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) to clear texture (requires TextureFlags::AttachmentUsage)");
+
+            context_->ClearRenderTargetView(rtv.Get(), clearValue.color.Ptr());
+        }
+    }
+}
+
+/*
+D3D11 cannot copy between buffers and textures on the GPU (CopySubresourceRegion requires resources of the same dimension),
+so the texel data is transferred over a staging resource, which synchronizes the CPU with the GPU.
+*/
+void D3D11CommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    auto& srcBufferD3D  = LLGL_CAST(D3D11Buffer&, srcBuffer);
+
+    /* Determine layout of the texel data within the buffer */
+    UINT        baseArrayLayer = 0, numArrayLayers = 0, rowPitch = 0, slicePitch = 0;
+    D3D11_BOX   dstBox;
+
+    dstTextureD3D.GetSubresourceRegion(dstRegion.offset, dstRegion.extent, baseArrayLayer, numArrayLayers, dstBox);
+    GetD3DBufferTexelPitches(dstTextureD3D, dstBox, rowStride, rowPitch, slicePitch);
+
+    const auto dataSize = slicePitch * (dstBox.back - dstBox.front) * numArrayLayers;
+
+    /* Copy buffer range into staging buffer with CPU read access */
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+    D3D11_BUFFER_DESC stagingDesc;
+    {
+        stagingDesc.ByteWidth           = dataSize;
+        stagingDesc.Usage               = D3D11_USAGE_STAGING;
+        stagingDesc.BindFlags           = 0;
+        stagingDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_READ;
+        stagingDesc.MiscFlags           = 0;
+        stagingDesc.StructureByteStride = 0;
+    }
+    ComPtr<ID3D11Buffer> stagingBuffer;
+    auto hr = device->CreateBuffer(&stagingDesc, nullptr, stagingBuffer.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 staging buffer for buffer-to-texture copy");
+
+    const CD3D11_BOX srcBox(static_cast<LONG>(srcOffset), 0, 0, static_cast<LONG>(srcOffset + dataSize), 1, 1);
+    context_->CopySubresourceRegion(stagingBuffer.Get(), 0, 0, 0, 0, srcBufferD3D.GetNative(), 0, &srcBox);
+
+    /* Map staging buffer and write texel data into each array layer of the texture */
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    hr = context_->Map(stagingBuffer.Get(), 0, D3D11_MAP_READ, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 staging buffer for buffer-to-texture copy");
+    {
+        auto data = reinterpret_cast<const char*>(mappedSubresource.pData);
+        const auto layerSize = slicePitch * (dstBox.back - dstBox.front);
+
+        for (UINT layer = 0; layer < numArrayLayers; ++layer)
+        {
+            context_->UpdateSubresource(
+                dstTextureD3D.GetNative().resource.Get(),
+                D3D11CalcSubresource(dstRegion.mipLevel, baseArrayLayer + layer, dstTextureD3D.GetNumMipLevels()),
+                &dstBox,
+                data + layerSize * layer,
+                rowPitch,
+                slicePitch
+            );
+        }
+    }
+    context_->Unmap(stagingBuffer.Get(), 0);
+}
+
+void D3D11CommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    auto& dstBufferD3D  = LLGL_CAST(D3D11Buffer&, dstBuffer);
+    auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
+
+    /* Determine layout of the texel data within the buffer */
+    UINT        baseArrayLayer = 0, numArrayLayers = 0, rowPitch = 0, slicePitch = 0;
+    D3D11_BOX   srcBox;
+
+    srcTextureD3D.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, baseArrayLayer, numArrayLayers, srcBox);
+    GetD3DBufferTexelPitches(srcTextureD3D, srcBox, rowStride, rowPitch, slicePitch);
+
+    const auto numSlices    = (srcBox.back - srcBox.front);
+    const auto numRows      = (srcBox.bottom - srcBox.top);
+    const auto rowSize      = FormatBitSize(DXTypes::Unmap(srcTextureD3D.GetFormat())) / 8 * (srcBox.right - srcBox.left);
+
+    /* Copy texture region into staging texture with CPU read access */
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+    D3D11NativeTexture textureCopy;
+    srcTextureD3D.CreateSubresourceRegionCopyWithCPUAccess(
+        device.Get(), context_.Get(), textureCopy, srcRegion.mipLevel, baseArrayLayer, numArrayLayers, srcBox
+    );
+
+    /* Gather texel data of all array layers with the layout of the buffer */
+    std::vector<char> data(slicePitch * numSlices * numArrayLayers);
+
+    for (UINT layer = 0; layer < numArrayLayers; ++layer)
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+        auto hr = context_->Map(textureCopy.resource.Get(), D3D11CalcSubresource(0, layer, 1), D3D11_MAP_READ, 0, &mappedSubresource);
+        DXThrowIfFailed(hr, "failed to map D3D11 staging texture for texture-to-buffer copy");
+        {
+            auto src = reinterpret_cast<const char*>(mappedSubresource.pData);
+            auto dst = data.data() + slicePitch * numSlices * layer;
+
+            for (UINT slice = 0; slice < numSlices; ++slice)
+            {
+                for (UINT row = 0; row < numRows; ++row)
+                {
+                    ::memcpy(
+                        dst + slicePitch * slice + rowPitch * row,
+                        src + mappedSubresource.DepthPitch * slice + mappedSubresource.RowPitch * row,
+                        rowSize
+                    );
+                }
+            }
+        }
+        context_->Unmap(textureCopy.resource.Get(), D3D11CalcSubresource(0, layer, 1));
+    }
+
+    /* Write texel data into destination buffer */
+    dstBufferD3D.UpdateSubresource(context_.Get(), data.data(), static_cast<UINT>(data.size()), static_cast<UINT>(dstOffset));
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void D3D11CommandBuffer::Begin()
+{
+    /* Discard previous recording of deferred context */
+    if (IsDeferred())
+    {
+        commandList_.Reset();
+        recordingEnded_ = false;
+    }
+}
+
+void D3D11CommandBuffer::End()
+{
+    /* Finish recording of deferred context, so it can be submitted multiple times */
+    if (IsDeferred())
+    {
+        FinishCommandList();
+        recordingEnded_ = true;
+    }
+}
+
+void D3D11CommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+/* ----- Extended functions ----- */
+
+ID3D11CommandList* D3D11CommandBuffer::GetCommandList()
+{
+    if (!IsDeferred())
+        return nullptr;
+
+    /* Finish all commands since the last submission if the recording has not been ended explicitly */
+    if (!recordingEnded_)
+        FinishCommandList();
+
+    return commandList_.Get();
+}
+
+
+/*
+ * ======= Private: =======
+ */
 
 void D3D11CommandBuffer::SubmitFramebufferView()
 {
@@ -568,68 +1793,136 @@ void D3D11CommandBuffer::SubmitFramebufferView()
         framebufferView_.rtvList.data(),
         framebufferView_.dsv
     );
-}
 
-void D3D11CommandBuffer::SetConstantBuffersOnStages(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags)
-{
-    if (VS_STAGE(stageFlags)) { context_->VSSetConstantBuffers(startSlot, count, buffers); }
-    if (HS_STAGE(stageFlags)) { context_->HSSetConstantBuffers(startSlot, count, buffers); }
-    if (DS_STAGE(stageFlags)) { context_->DSSetConstantBuffers(startSlot, count, buffers); }
-    if (GS_STAGE(stageFlags)) { context_->GSSetConstantBuffers(startSlot, count, buffers); }
-    if (PS_STAGE(stageFlags)) { context_->PSSetConstantBuffers(startSlot, count, buffers); }
-    if (CS_STAGE(stageFlags)) { context_->CSSetConstantBuffers(startSlot, count, buffers); }
+    /* Render targets unbind SRVs of the same resources */
+    stateMngr_.InvalidateShaderResources();
 }
 
-void D3D11CommandBuffer::SetShaderResourcesOnStages(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags)
+void D3D11CommandBuffer::UpdateTimerScopeFrame()
 {
-    if (VS_STAGE(stageFlags)) { context_->VSSetShaderResources(startSlot, count, views); }
-    if (HS_STAGE(stageFlags)) { context_->HSSetShaderResources(startSlot, count, views); }
-    if (DS_STAGE(stageFlags)) { context_->DSSetShaderResources(startSlot, count, views); }
-    if (GS_STAGE(stageFlags)) { context_->GSSetShaderResources(startSlot, count, views); }
-    if (PS_STAGE(stageFlags)) { context_->PSSetShaderResources(startSlot, count, views); }
-    if (CS_STAGE(stageFlags)) { context_->CSSetShaderResources(startSlot, count, views); }
+    if (timerRenderContext_ != nullptr && timerRenderContext_->GetPresentCount() != timerPresentCount_)
+    {
+        timerPresentCount_ = timerRenderContext_->GetPresentCount();
+        CloseTimerScopeFrame();
+    }
 }
 
-void D3D11CommandBuffer::SetSamplersOnStages(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags)
+void D3D11CommandBuffer::CloseTimerScopeFrame()
 {
-    if (VS_STAGE(stageFlags)) { context_->VSSetSamplers(startSlot, count, samplers); }
-    if (HS_STAGE(stageFlags)) { context_->HSSetSamplers(startSlot, count, samplers); }
-    if (DS_STAGE(stageFlags)) { context_->DSSetSamplers(startSlot, count, samplers); }
-    if (GS_STAGE(stageFlags)) { context_->GSSetSamplers(startSlot, count, samplers); }
-    if (PS_STAGE(stageFlags)) { context_->PSSetSamplers(startSlot, count, samplers); }
-    if (CS_STAGE(stageFlags)) { context_->CSSetSamplers(startSlot, count, samplers); }
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    while (timerScopes_.HasOpenScopes())
+    {
+        if (timerScopes_.EndScope(timestampIndex))
+            WriteTimestamp(timestampIndex);
+    }
+
+    /* End disjoint query of this frame with its last timestamp */
+    if (!timerScopes_.IsCurrentFrameEmpty())
+        context_->End(timerDisjointQueries_[timerScopes_.GetCurrentFrame()].Get());
+
+    timerScopes_.CloseFrame();
 }
 
-void D3D11CommandBuffer::SetUnorderedAccessViewsOnStages(
-    UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long stageFlags)
+void D3D11CommandBuffer::WriteTimestamp(std::uint32_t timestampIndex)
 {
-    if (PS_STAGE(stageFlags))
+    if (timestampQueries_.empty())
+        timestampQueries_.resize(TimerScopeRecorder::maxNumTimestamps);
+
+    auto& query = timestampQueries_[timestampIndex];
+    if (!query)
     {
-        /* Set UAVs for pixel shader stage */
-        context_->OMSetRenderTargetsAndUnorderedAccessViews(
-            D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr,
-            startSlot, count, views, initialCounts
-        );
+        ComPtr<ID3D11Device> device;
+        context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+        D3D11_QUERY_DESC queryDesc;
+        {
+            queryDesc.Query     = D3D11_QUERY_TIMESTAMP;
+            queryDesc.MiscFlags = 0;
+        }
+        auto hr = device->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 timestamp query for timer scopes");
     }
 
-    if (CS_STAGE(stageFlags))
+    context_->End(query.Get());
+}
+
+void D3D11CommandBuffer::BeginStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerStatistics_ && timerScopes_.BeginSegment(queryIndex))
     {
-        /* Set UAVs for compute shader stage */
-        context_->CSSetUnorderedAccessViews(startSlot, count, views, initialCounts);
+        if (statisticsQueries_.empty())
+            statisticsQueries_.resize(TimerScopeRecorder::maxNumSegments);
+
+        auto& query = statisticsQueries_[queryIndex];
+        if (!query)
+        {
+            ComPtr<ID3D11Device> device;
+            context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+            D3D11_QUERY_DESC queryDesc;
+            {
+                queryDesc.Query     = D3D11_QUERY_PIPELINE_STATISTICS;
+                queryDesc.MiscFlags = 0;
+            }
+            auto hr = device->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 pipeline statistics query for timer scopes");
+        }
+
+        context_->Begin(query.Get());
     }
 }
 
-#undef VS_STAGE
-#undef HS_STAGE
-#undef DS_STAGE
-#undef GS_STAGE
-#undef PS_STAGE
-#undef CS_STAGE
+void D3D11CommandBuffer::EndStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerScopes_.EndSegment(queryIndex))
+        context_->End(statisticsQueries_[queryIndex].Get());
+}
+
+void D3D11CommandBuffer::FinishCommandList()
+{
+    /* Resolve bound render target before the recording is closed */
+    ResolveBoundRenderTarget();
+
+    auto hr = context_->FinishCommandList(FALSE, commandList_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to finish D3D11 command list of deferred context");
+
+    /* Deferred context has been reset to its default state, so all cached states are invalid */
+    stateMngr_.ResetCache();
+
+    /* The first map of the next command list must discard the transient ring buffer, and no previous range can be bound anymore */
+    transientHead_      = 0;
+    transientExtent_    = 0;
+    transientUploaded_  = 0;
+    transientPending_   = false;
+    transientDiscard_   = true;
+    framebufferView_.rtvList.clear();
+    framebufferView_.dsv    = nullptr;
+    boundRenderTarget_      = nullptr;
+    boundRenderPass_        = nullptr;
+    resolvePending_         = false;
+}
+
+void D3D11CommandBuffer::SubmitStreamOutputTargets(UINT offset)
+{
+    UINT offsets[D3D11_SO_BUFFER_SLOT_COUNT];
+    std::fill(offsets, offsets + streamOutputTargets_.count, offset);
+    context_->SOSetTargets(streamOutputTargets_.count, streamOutputTargets_.buffers, offsets);
+}
+
 #undef SRV_STAGE
 
 
 } // /namespace LLGL
 
 
+/* Implement non-virtual command buffer functions for LLGL_BACKEND=Direct3D11 */
+#define LLGL_DIRECT_DISPATCH_CLASS D3D11CommandBuffer
+#include "../DirectDispatch.h"
+
+
 
 // ================================================================================
@@ -10,11 +10,16 @@
 
 
 #include <LLGL/CommandBufferExt.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include <cstddef>
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
+#include "../TimerScopeRecorder.h"
+#include "../StatisticsCounter.h"
+#include "../ScratchArena.h"
 #include <vector>
-#include <d3d11.h>
+#include <memory>
+#include "Direct3D11.h"
 #include <dxgi.h>
 
 
@@ -24,6 +29,8 @@ namespace LLGL
 
 class D3D11StateManager;
 class D3D11RenderTarget;
+class D3D11RenderContext;
+class D3D11ConstantBuffer;
 
 class D3D11CommandBuffer final : public CommandBufferExt
 {
@@ -32,7 +39,12 @@ class D3D11CommandBuffer final : public CommandBufferExt
 
         /* ----- Common ----- */
 
-        D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context);
+        D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context, StatisticsCounter& statistics, long flags);
+
+        // Constructs a command buffer that records into the specified deferred context and takes ownership of its state manager.
+        D3D11CommandBuffer(std::unique_ptr<D3D11StateManager>&& deferredStateMngr, const ComPtr<ID3D11DeviceContext>& deferredContext, StatisticsCounter& statistics, long flags);
+
+        ~D3D11CommandBuffer();
 
         /* ----- Configuration ----- */
 
@@ -40,10 +52,10 @@ class D3D11CommandBuffer final : public CommandBufferExt
 
         /* ----- Viewport and Scissor ----- */
 
-        void SetViewport(const Viewport& viewport) override;
+        void SetViewport(const Viewport& viewport) LLGL_DISPATCH_OVERRIDE;
         void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
 
-        void SetScissor(const Scissor& scissor) override;
+        void SetScissor(const Scissor& scissor) LLGL_DISPATCH_OVERRIDE;
         void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
 
         /* ----- Clear ----- */
@@ -57,15 +69,25 @@ class D3D11CommandBuffer final : public CommandBufferExt
 
         /* ----- Input Assembly ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
 
         /* ----- Constant Buffers ------ */
 
         void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
 
+        void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
         /* ----- Storage Buffers ------ */
 
         void SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
@@ -78,6 +100,9 @@ class D3D11CommandBuffer final : public CommandBufferExt
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
@@ -88,18 +113,64 @@ class D3D11CommandBuffer final : public CommandBufferExt
 
         /* ----- Resource Heaps ----- */
 
-        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
-        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
 
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
         /* ----- Pipeline States ----- */
 
-        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
-        void SetComputePipeline(ComputePipeline& computePipeline) override;
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) LLGL_DISPATCH_OVERRIDE;
+        void SetComputePipeline(ComputePipeline& computePipeline) LLGL_DISPATCH_OVERRIDE;
+
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
 
         /* ----- Queries ----- */
 
@@ -112,26 +183,139 @@ class D3D11CommandBuffer final : public CommandBufferExt
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
         /* ----- Drawing ----- */
 
-        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) LLGL_DISPATCH_OVERRIDE;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
 
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) override;
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) override;
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
         /* ----- Compute ----- */
 
-        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) LLGL_DISPATCH_OVERRIDE;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
+
+        /* ----- Extended functions ----- */
+
+        /*
+        Returns the command list of the deferred context, or null if this command buffer records into the immediate context.
+        If the recording has not been ended with End(), all commands that have been recorded since the last call are finished into a new command list.
+        */
+        ID3D11CommandList* GetCommandList();
+
+        // Returns true if this command buffer records into a deferred context.
+        inline bool IsDeferred() const
+        {
+            return (deferredStateMngr_ != nullptr);
+        }
 
     private:
 
+        // Maximal size (in bytes) of the constants; see RenderingLimits::maxConstantsSize.
+        static const UINT maxConstantsSize = 128;
+
+        // Layout and CPU shadow of the constants of either the graphics or compute pipeline.
+        struct D3D11ConstantsState
+        {
+            ConstantsDescriptor     layout;
+            char                    data[maxConstantsSize];
+            ComPtr<ID3D11Buffer>    buffer;                     // Hidden dynamic constant buffer (created on first use)
+        };
+
+        // Stream-output buffers of the last call to SetStreamOutputBuffer(Array), which are bound again to begin or resume the stream-output.
+        struct D3D11StreamOutputTargets
+        {
+            ID3D11Buffer*   buffers[D3D11_SO_BUFFER_SLOT_COUNT] = {};
+            UINT            count                               = 0;
+        };
+
         struct D3D11FramebufferView
         {
             std::vector<ID3D11RenderTargetView*>    rtvList;
@@ -140,22 +324,98 @@ class D3D11CommandBuffer final : public CommandBufferExt
 
         void SubmitFramebufferView();
 
-        void SetConstantBuffersOnStages(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags);
-        void SetShaderResourcesOnStages(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags);
-        void SetSamplersOnStages(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags);
-        void SetUnorderedAccessViewsOnStages(UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long stageFlags);
-
         void ResolveBoundRenderTarget();
 
+        // Clears and discards the attachments of the bound framebuffer view according to the load operations of the specified render pass.
+        void BeginRenderPassWithFramebufferView(const RenderPass& renderPass, std::uint32_t numClearValues, const ClearValue* clearValues);
+
+        // Discards the attachments of the bound framebuffer view whose load operations (or store operations) are undefined.
+        void DiscardRenderPassAttachments(const RenderPass& renderPass, bool loadOps);
+
+        // Closes the current timer scope frame if the render context has been presented since the frame has begun.
+        void UpdateTimerScopeFrame();
+
+        // Ends all open timer scopes, ends the disjoint query, and closes the current timer scope frame.
+        void CloseTimerScopeFrame();
+
+        // Ends the timestamp query with the specified timestamp index (the query is created on first use).
+        void WriteTimestamp(std::uint32_t timestampIndex);
+
+        // Begins a new pipeline statistics segment for the open timer scopes (see CommandBufferFlags::TimerScopeStatistics).
+        void BeginStatisticsSegment();
+
+        // Ends the active pipeline statistics segment of the timer scopes.
+        void EndStatisticsSegment();
+
+        // Uploads the shadow data of the specified constants into its hidden constant buffer and binds it to the specified stages.
+        void UploadConstants(D3D11ConstantsState& constants, long stageFlags);
+
+        // Creates the transient ring buffer with the first transient allocation.
+        void CreateTransientBuffer();
+
+        // Writes the pending transient data from the CPU shadow into the transient ring buffer.
+        void UploadTransientWrites();
+
+        // Uploads the pending transient data before a draw or dispatch command reads it.
+        inline void FlushTransientWrites()
+        {
+            if (transientPending_)
+                UploadTransientWrites();
+        }
+
+        // Finishes the commands of the deferred context into a new command list and resets all cached states.
+        void FinishCommandList();
+
+        // Binds the stream-output targets with the specified offset for each buffer; (UINT)-1 appends to the current end of each buffer.
+        void SubmitStreamOutputTargets(UINT offset);
+
         D3D11StateManager&          stateMngr_;
+        StatisticsCounter&          statistics_;
 
         ComPtr<ID3D11DeviceContext> context_;
 
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<ID3D11DeviceContext1> context1_;                     // Only used to discard views; may be null
+        #endif
+
+        #if defined LLGL_ENABLE_DEBUG_MARKERS && LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<ID3DUserDefinedAnnotation> annotation_;              // Only used for debug groups and markers; may be null
+        #endif
+
         D3D11FramebufferView        framebufferView_;
         D3D11RenderTarget*          boundRenderTarget_  = nullptr;
+        const RenderPass*           boundRenderPass_    = nullptr;
+        bool                        resolvePending_     = false;    // True if the bound multi-sample render target is resolved when another render target is bound
 
         ClearValue                  clearValue_;
 
+        D3D11StreamOutputTargets    streamOutputTargets_;
+
+        TimerScopeRecorder          timerScopes_;
+        std::vector<ComPtr<ID3D11Query>> timestampQueries_;
+        ComPtr<ID3D11Query>         timerDisjointQueries_[TimerScopeRecorder::maxNumFrames];
+        const D3D11RenderContext*   timerRenderContext_ = nullptr;  // Render context whose presentation closes a timer scope frame
+        std::uint64_t               timerPresentCount_  = 0;
+        bool                        timerStatistics_    = false;    // Timer scopes collect pipeline statistics, see CommandBufferFlags::TimerScopeStatistics
+        std::vector<ComPtr<ID3D11Query>> statisticsQueries_;        // Pipeline statistics queries of the timer scope segments, created on demand
+
+        D3D11ConstantsState         graphicsConstants_;
+        D3D11ConstantsState         computeConstants_;
+
+        std::unique_ptr<D3D11ConstantBuffer> transientBuffer_;      // Dynamic constant buffer of the transient ring, created with the first transient allocation
+        std::vector<char>           transientShadow_;               // CPU shadow of the transient ring; allocations point into this shadow
+        UINT                        transientHead_      = 0;        // Offset (in bytes) of the end of the last transient allocation
+        UINT                        transientExtent_    = 0;        // Number of bytes at the beginning of the ring that might still be bound
+        UINT                        transientUploaded_  = 0;        // Offset (in bytes) up to which the shadow has been uploaded since the last wrap-around
+        bool                        transientPending_   = false;    // True if transient data has been allocated since the last upload
+        bool                        transientDiscard_   = true;     // True if the next upload must discard the buffer, i.e. after a wrap-around or a new command list
+
+        ScratchArena                scratch_;                       // Transient arrays of single commands
+
+        std::unique_ptr<D3D11StateManager> deferredStateMngr_;      // State manager of the deferred context; null for the immediate context
+        ComPtr<ID3D11CommandList>   commandList_;                   // Last finished command list of the deferred context
+        bool                        recordingEnded_     = false;    // True if the command list has been finished with End() and can be submitted multiple times
+
 };
 
 
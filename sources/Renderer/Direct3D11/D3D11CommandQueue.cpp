@@ -6,7 +6,10 @@
  */
 
 #include "D3D11CommandQueue.h"
+#include "D3D11CommandBuffer.h"
 #include "RenderState/D3D11Fence.h"
+#include "../CheckedCast.h"
+#include "../DXCommon/DXCore.h"
 
 
 namespace LLGL
@@ -20,30 +23,182 @@ D3D11CommandQueue::D3D11CommandQueue(ComPtr<ID3D11DeviceContext>& context) :
 
 /* ----- Command queues ----- */
 
-void D3D11CommandQueue::Submit(CommandBuffer& /*commandBuffer*/)
+void D3D11CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
-    // dummy
+    ExecutePendingUploads();
+
+    /* Execute command list of deferred command buffers (immediate command buffers have already been executed) */
+    if (auto commandBufferD3D = dynamic_cast<D3D11CommandBuffer*>(&commandBuffer))
+    {
+        if (auto commandList = commandBufferD3D->GetCommandList())
+            context_->ExecuteCommandList(commandList, TRUE);
+    }
+}
+
+void D3D11CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence, std::uint64_t signalValue)
+{
+    /* Command buffers are executed one after another, since there is no native batch submission */
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        D3D11CommandQueue::Submit(*commandBuffers[i]);
+    if (signalFence != nullptr)
+        D3D11CommandQueue::Signal(*signalFence, signalValue);
 }
 
 /* ----- Fences ----- */
 
 void D3D11CommandQueue::Submit(Fence& fence)
 {
-    //TODO: use D3D11Fence
+    /* Worker threads hand over their uploads, and the fence is submitted once the render thread has executed them */
+    if (auto workerContext = FindWorkerContext())
+    {
+        FinishWorkerUploads(workerContext, &fence);
+        return;
+    }
+
+    ExecutePendingUploads();
+
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    fenceD3D.Submit(context_.Get());
 }
 
 bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    //TODO: use D3D11Fence
-    context_->Flush();
-    return true;
+    /* Fences of worker threads are only submitted with their pending uploads */
+    ExecutePendingUploads();
+
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    return fenceD3D.Wait(context_.Get(), timeout);
 }
 
 void D3D11CommandQueue::WaitIdle()
 {
+    ExecutePendingUploads();
     context_->Flush();
 }
 
+/* ----- Timeline fences ----- */
+
+void D3D11CommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    ExecutePendingUploads();
+
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    fenceD3D.Signal(context_.Get(), value);
+}
+
+void D3D11CommandQueue::Wait(Fence& /*fence*/, std::uint64_t /*value*/)
+{
+    // dummy (the immediate context executes all commands in order)
+}
+
+bool D3D11CommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    return fenceD3D.WaitValue(value, timeout);
+}
+
+bool D3D11CommandQueue::WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout)
+{
+    /* Wait for one fence after another (the timeout applies to each fence) */
+    for (std::uint32_t i = 0; i < numFences; ++i)
+    {
+        const bool signaled = (values != nullptr ? WaitFenceValue(*fences[i], values[i], timeout) : WaitFence(*fences[i], timeout));
+        if (!signaled)
+            return false;
+    }
+    return true;
+}
+
+/* ----- Worker threads ----- */
+
+bool D3D11CommandQueue::AttachWorkerThread(ID3D11Device* device)
+{
+    /*
+    Only use deferred contexts if the driver supports command lists natively,
+    since the emulation of the runtime applies the destination box of UpdateSubresource incorrectly
+    */
+    D3D11_FEATURE_DATA_THREADING threadingSupport;
+    auto hr = device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threadingSupport, sizeof(threadingSupport));
+    if (FAILED(hr) || threadingSupport.DriverCommandLists == FALSE)
+        return false;
+
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+
+    auto& workerContext = workerContexts_[std::this_thread::get_id()];
+    if (!workerContext)
+    {
+        hr = device->CreateDeferredContext(0, workerContext.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 deferred context for worker thread");
+    }
+
+    return true;
+}
+
+void D3D11CommandQueue::DetachWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+
+    auto it = workerContexts_.find(std::this_thread::get_id());
+    if (it != workerContexts_.end())
+    {
+        /* Hand over the remaining uploads before the deferred context is released */
+        FinishWorkerUploads(it->second.Get(), nullptr);
+        workerContexts_.erase(it);
+    }
+}
+
+ID3D11DeviceContext* D3D11CommandQueue::GetUploadContext()
+{
+    if (auto workerContext = FindWorkerContext())
+        return workerContext;
+    return context_.Get();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ID3D11DeviceContext* D3D11CommandQueue::FindWorkerContext()
+{
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+    auto it = workerContexts_.find(std::this_thread::get_id());
+    return (it != workerContexts_.end() ? it->second.Get() : nullptr);
+}
+
+void D3D11CommandQueue::FinishWorkerUploads(ID3D11DeviceContext* workerContext, Fence* fence)
+{
+    ComPtr<ID3D11CommandList> commandList;
+    auto hr = workerContext->FinishCommandList(FALSE, commandList.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to finish D3D11 command list of worker thread");
+
+    std::lock_guard<std::mutex> guard { pendingUploadsMutex_ };
+    pendingUploads_.push_back({ std::move(commandList), fence });
+}
+
+void D3D11CommandQueue::ExecutePendingUploads()
+{
+    /* Take all pending uploads, so worker threads are not blocked while the command lists are executed */
+    std::vector<PendingUpload> pendingUploads;
+    {
+        std::lock_guard<std::mutex> guard { pendingUploadsMutex_ };
+        if (pendingUploads_.empty())
+            return;
+        pendingUploads.swap(pendingUploads_);
+    }
+
+    /* Restore the state of the immediate context after each command list, since the state manager caches it */
+    for (const auto& upload : pendingUploads)
+    {
+        context_->ExecuteCommandList(upload.commandList.Get(), TRUE);
+        if (upload.fence != nullptr)
+        {
+            auto& fenceD3D = LLGL_CAST(D3D11Fence&, *upload.fence);
+            fenceD3D.Submit(context_.Get());
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
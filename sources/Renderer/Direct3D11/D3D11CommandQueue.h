@@ -12,12 +12,21 @@
 #include <LLGL/CommandQueue.h>
 #include "../DXCommon/ComPtr.h"
 #include <d3d11.h>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+/*
+D3D11 command queue for the immediate context. Worker threads (see RenderSystem::AttachWorkerThread) record their uploads into their own deferred context,
+and the command lists of those uploads are executed on the immediate context by the render thread,
+before it submits the next command buffer or fence, and before it waits for a fence.
+*/
 class D3D11CommandQueue final : public CommandQueue
 {
 
@@ -28,6 +37,7 @@ class D3D11CommandQueue final : public CommandQueue
         /* ----- Command queues ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence = nullptr, std::uint64_t signalValue = 0) override;
 
         /* ----- Fences ----- */
 
@@ -36,9 +46,53 @@ class D3D11CommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+        /* ----- Timeline fences ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        bool WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout) override;
+
+    public:
+
+        // Creates a deferred context for the calling thread. Returns false if the driver does not support command lists natively.
+        bool AttachWorkerThread(ID3D11Device* device);
+
+        // Finishes the uploads of the calling thread and releases its deferred context.
+        void DetachWorkerThread();
+
+        // Returns the deferred context of the calling thread if it is an attached worker thread, or the immediate context otherwise.
+        ID3D11DeviceContext* GetUploadContext();
+
+    private:
+
+        // Uploads of a worker thread that have been finished into a command list, and the fence that is signaled after them.
+        struct PendingUpload
+        {
+            ComPtr<ID3D11CommandList>   commandList;
+            Fence*                      fence;
+        };
+
     private:
 
-        ComPtr<ID3D11DeviceContext> context_;
+        // Returns the deferred context of the calling thread, or null if it is not an attached worker thread.
+        ID3D11DeviceContext* FindWorkerContext();
+
+        // Finishes the command list of the specified deferred context and appends it to the pending uploads.
+        void FinishWorkerUploads(ID3D11DeviceContext* workerContext, Fence* fence);
+
+        // Executes all pending uploads of the worker threads on the immediate context. Must only be called on the render thread.
+        void ExecutePendingUploads();
+
+    private:
+
+        ComPtr<ID3D11DeviceContext>                                 context_;
+
+        std::map<std::thread::id, ComPtr<ID3D11DeviceContext>>      workerContexts_;        // Deferred contexts of all attached worker threads
+        std::mutex                                                  workerContextsMutex_;
+
+        std::vector<PendingUpload>                                  pendingUploads_;        // Finished uploads of the worker threads in submission order
+        std::mutex                                                  pendingUploadsMutex_;
 
 };
 
@@ -25,7 +25,8 @@ D3D11RenderContext::D3D11RenderContext(
         RenderContext     { desc.videoMode, desc.vsync       },
         device_           { device                           },
         context_          { context                          },
-        swapChainSamples_ { desc.multiSampling.SampleCount() }
+        swapChainSamples_ { desc.multiSampling.SampleCount() },
+        maxFrameLatency_  { DXGetMaxFrameLatency(desc.maxFrameLatency, 0) }
 {
     /* Setup surface for the render context */
     SetOrCreateSurface(surface, desc.videoMode, nullptr);
@@ -38,9 +39,29 @@ D3D11RenderContext::D3D11RenderContext(
     OnSetVsync(desc.vsync);
 }
 
+D3D11RenderContext::~D3D11RenderContext()
+{
+    if (frameLatencyWaitableObject_ != nullptr)
+        CloseHandle(frameLatencyWaitableObject_);
+}
+
 void D3D11RenderContext::Present()
 {
-    swapChain_->Present(swapChainInterval_, 0);
+    /* Resolve multi-sampled color buffer into back buffer */
+    if (backBuffer_.colorBufferMS)
+        context_->ResolveSubresource(backBuffer_.colorBuffer.Get(), 0, backBuffer_.colorBufferMS.Get(), 0, colorFormat_);
+
+    /* Present without V-sync may tear on flip-model swap chains, if supported */
+    const UINT flags = (swapChainInterval_ == 0 && tearingSupported_ ? DXGI_PRESENT_ALLOW_TEARING : 0);
+    swapChain_->Present(swapChainInterval_, flags);
+    ++presentCount_;
+}
+
+void D3D11RenderContext::WaitForNextFrame()
+{
+    /* Wait until the swap-chain has retired enough frames to stay within the maximum frame latency */
+    if (frameLatencyWaitableObject_ != nullptr)
+        WaitForSingleObjectEx(frameLatencyWaitableObject_, 1000, TRUE);
 }
 
 Format D3D11RenderContext::QueryColorFormat() const
@@ -75,15 +96,23 @@ bool D3D11RenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc
         return false;
     #endif
 
+    /* Update sync interval for the new presentation mode (the swap effect remains until the render context is recreated) */
+    swapChainInterval_ = DXGetPresentSyncInterval(videoModeDesc.presentMode, GetVsync());
+
     return true;
 }
 
 bool D3D11RenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 {
-    swapChainInterval_ = (vsyncDesc.enabled ? std::max(1u, std::min(vsyncDesc.interval, 4u)) : 0u);
+    swapChainInterval_ = DXGetPresentSyncInterval(GetVideoMode().presentMode, vsyncDesc);
     return true;
 }
 
+bool D3D11RenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    return DXGetFrameStatistics(swapChain_.Get(), frameStats);
+}
+
 
 /*
  * ======= Private: =======
@@ -91,10 +120,6 @@ bool D3D11RenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 
 void D3D11RenderContext::CreateSwapChain(IDXGIFactory* factory)
 {
-    /* Get current settings */
-    const auto& videoMode = GetVideoMode();
-    const auto& vsync = GetVsync();
-
     /* Pick and store color format */
     colorFormat_ = DXGI_FORMAT_R8G8B8A8_UNORM;//DXGI_FORMAT_B8G8R8A8_UNORM
 
@@ -102,6 +127,84 @@ void D3D11RenderContext::CreateSwapChain(IDXGIFactory* factory)
     NativeHandle wndHandle;
     GetSurface().GetNativeHandle(&wndHandle);
 
+    /* Prefer flip-model swap chain, which avoids the extra copy of the compositor in windowed mode (requires DXGI 1.2) */
+    ComPtr<IDXGIFactory2> factory2;
+    if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(factory2.ReleaseAndGetAddressOf()))))
+        CreateFlipModelSwapChain(factory2.Get(), wndHandle.window);
+    else
+        CreateLegacySwapChain(factory, wndHandle.window);
+}
+
+// Returns true if the DXGI factory supports tearing for flip-model swap chains, i.e. presentation without V-sync on variable refresh rate displays (requires DXGI 1.5).
+static bool IsTearingSupported(IDXGIFactory2* factory)
+{
+    BOOL allowTearing = FALSE;
+
+    ComPtr<IDXGIFactory5> factory5;
+    if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(factory5.ReleaseAndGetAddressOf()))))
+    {
+        if (FAILED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+            allowTearing = FALSE;
+    }
+
+    return (allowTearing != FALSE);
+}
+
+void D3D11RenderContext::CreateFlipModelSwapChain(IDXGIFactory2* factory, HWND window)
+{
+    const auto& videoMode = GetVideoMode();
+
+    /* Allow tearing when V-sync is disabled, and use frame latency waitable object for explicit presentation modes or an explicit frame latency */
+    tearingSupported_   = IsTearingSupported(factory);
+    swapChainFlags_     = 0;
+
+    if (tearingSupported_)
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+    if (videoMode.presentMode != PresentMode::Default || maxFrameLatency_ > 0)
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+    /* Flip-model swap chains cannot be multi-sampled, so multi-sampling is resolved from a separate color buffer (see CreateBackBuffer) */
+    DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
+    {
+        swapChainDesc.Width                 = videoMode.resolution.width;
+        swapChainDesc.Height                = videoMode.resolution.height;
+        swapChainDesc.Format                = colorFormat_;
+        swapChainDesc.Stereo                = FALSE;
+        swapChainDesc.SampleDesc.Count      = 1;
+        swapChainDesc.SampleDesc.Quality    = 0;
+        swapChainDesc.BufferUsage           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+        swapChainDesc.BufferCount           = std::max(2u, std::min(videoMode.swapChainSize, 3u));
+        swapChainDesc.Scaling               = DXGI_SCALING_STRETCH;
+        swapChainDesc.SwapEffect            = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+        swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
+        swapChainDesc.Flags                 = swapChainFlags_;
+    }
+    ComPtr<IDXGISwapChain1> swapChain1;
+    auto hr = factory->CreateSwapChainForHwnd(device_.Get(), window, &swapChainDesc, nullptr, nullptr, swapChain1.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create DXGI flip-model swap chain");
+
+    swapChain1.As(&swapChain_);
+    flipModel_ = true;
+
+    if ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
+    {
+        /* Limit the frame latency to a single frame by default, and get the waitable object for frame pacing */
+        ComPtr<IDXGISwapChain2> swapChain2;
+        if (SUCCEEDED(swapChain_.As(&swapChain2)))
+        {
+            swapChain2->SetMaximumFrameLatency(maxFrameLatency_ > 0 ? maxFrameLatency_ : 1);
+            frameLatencyWaitableObject_ = swapChain2->GetFrameLatencyWaitableObject();
+        }
+    }
+    else
+        SetDeviceMaxFrameLatency();
+}
+
+void D3D11RenderContext::CreateLegacySwapChain(IDXGIFactory* factory, HWND window)
+{
+    const auto& videoMode = GetVideoMode();
+    const auto& vsync = GetVsync();
+
     DXGI_SWAP_CHAIN_DESC swapChainDesc;
     InitMemory(swapChainDesc);
     {
@@ -114,12 +217,25 @@ void D3D11RenderContext::CreateSwapChain(IDXGIFactory* factory)
         swapChainDesc.SampleDesc.Quality                    = 0;
         swapChainDesc.BufferUsage                           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
         swapChainDesc.BufferCount                           = (videoMode.swapChainSize == 3 ? 2 : 1);
-        swapChainDesc.OutputWindow                          = wndHandle.window;
+        swapChainDesc.OutputWindow                          = window;
         swapChainDesc.Windowed                              = TRUE;//(videoMode.fullscreen ? FALSE : TRUE);
         swapChainDesc.SwapEffect                            = DXGI_SWAP_EFFECT_DISCARD;
     }
     auto hr = factory->CreateSwapChain(device_.Get(), &swapChainDesc, swapChain_.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create DXGI swap chain");
+
+    SetDeviceMaxFrameLatency();
+}
+
+void D3D11RenderContext::SetDeviceMaxFrameLatency()
+{
+    /* Swap chains without waitable object are limited by the frame latency of the DXGI device, which is shared by all render contexts */
+    if (maxFrameLatency_ > 0)
+    {
+        ComPtr<IDXGIDevice1> dxgiDevice1;
+        if (SUCCEEDED(device_.As(&dxgiDevice1)))
+            dxgiDevice1->SetMaximumFrameLatency(maxFrameLatency_);
+    }
 }
 
 void D3D11RenderContext::CreateBackBuffer(const VideoModeDescriptor& videoModeDesc)
@@ -133,9 +249,32 @@ void D3D11RenderContext::CreateBackBuffer(const VideoModeDescriptor& videoModeDe
     hr = swapChain_->GetBuffer(0, IID_PPV_ARGS(backBuffer_.colorBuffer.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to get D3D11 back buffer from swap chain");
 
-    /* Create back buffer RTV */
-    hr = device_->CreateRenderTargetView(backBuffer_.colorBuffer.Get(), nullptr, backBuffer_.rtv.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for back buffer");
+    if (flipModel_ && swapChainSamples_ > 1)
+    {
+        /* Create multi-sampled color buffer, which is resolved into the back buffer on present */
+        D3D11_TEXTURE2D_DESC texDesc;
+        backBuffer_.colorBuffer->GetDesc(&texDesc);
+        {
+            texDesc.SampleDesc.Count    = swapChainSamples_;
+            texDesc.SampleDesc.Quality  = 0;
+            texDesc.Usage               = D3D11_USAGE_DEFAULT;
+            texDesc.BindFlags           = D3D11_BIND_RENDER_TARGET;
+            texDesc.CPUAccessFlags      = 0;
+            texDesc.MiscFlags           = 0;
+        }
+        hr = device_->CreateTexture2D(&texDesc, nullptr, backBuffer_.colorBufferMS.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 multi-sampled color buffer for swap-chain");
+
+        /* Create back buffer RTV for the multi-sampled color buffer */
+        hr = device_->CreateRenderTargetView(backBuffer_.colorBufferMS.Get(), nullptr, backBuffer_.rtv.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for multi-sampled back buffer");
+    }
+    else
+    {
+        /* Create back buffer RTV */
+        hr = device_->CreateRenderTargetView(backBuffer_.colorBuffer.Get(), nullptr, backBuffer_.rtv.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for back buffer");
+    }
 
     #if 0//TODO: allow to avoid a depth-buffer
     if (videoModeDesc.depthBits > 0 || videoModeDesc.stencilBits > 0)
@@ -184,12 +323,13 @@ void D3D11RenderContext::ResizeBackBuffer(const VideoModeDescriptor& videoModeDe
 
     /* Release buffers */
     backBuffer_.colorBuffer.Reset();
+    backBuffer_.colorBufferMS.Reset();
     backBuffer_.rtv.Reset();
     backBuffer_.depthStencil.Reset();
     backBuffer_.dsv.Reset();
 
     /* Resize swap-chain buffers, let DXGI find out the client area, and preserve buffer count and format */
-    auto hr = swapChain_->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, 0);
+    auto hr = swapChain_->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, swapChainFlags_);
     DXThrowIfFailed(hr, "failed to resize DXGI swap-chain buffers");
 
     /* Recreate back buffer and reset default render target */
@@ -12,7 +12,7 @@
 #include <LLGL/RenderContext.h>
 #include "../DXCommon/ComPtr.h"
 #include <d3d11.h>
-#include <dxgi.h>
+#include <dxgi1_5.h>
 
 
 namespace LLGL
@@ -23,6 +23,7 @@ namespace LLGL
 struct D3D11BackBuffer
 {
     ComPtr<ID3D11Texture2D>         colorBuffer;
+    ComPtr<ID3D11Texture2D>         colorBufferMS;  // Multi-sampled color buffer for flip-model swap chains (resolved into 'colorBuffer' on present)
     ComPtr<ID3D11RenderTargetView>  rtv;
     ComPtr<ID3D11Texture2D>         depthStencil;
     ComPtr<ID3D11DepthStencilView>  dsv;
@@ -44,7 +45,10 @@ class D3D11RenderContext final : public RenderContext
             const std::shared_ptr<Surface>& surface
         );
 
+        ~D3D11RenderContext();
+
         void Present() override;
+        void WaitForNextFrame() override;
 
         Format QueryColorFormat() const override;
         Format QueryDepthStencilFormat() const override;
@@ -56,12 +60,22 @@ class D3D11RenderContext final : public RenderContext
             return backBuffer_;
         }
 
+        // Returns the number of times this render context has been presented.
+        inline std::uint64_t GetPresentCount() const
+        {
+            return presentCount_;
+        }
+
     private:
 
         bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+        bool OnQueryFrameStatistics(FrameStatistics& frameStats) override;
 
         void CreateSwapChain(IDXGIFactory* factory);
+        void CreateFlipModelSwapChain(IDXGIFactory2* factory, HWND window);
+        void CreateLegacySwapChain(IDXGIFactory* factory, HWND window);
+        void SetDeviceMaxFrameLatency();
         void CreateBackBuffer(const VideoModeDescriptor& videoModeDesc);
         void ResizeBackBuffer(const VideoModeDescriptor& videoModeDesc);
 
@@ -71,12 +85,19 @@ class D3D11RenderContext final : public RenderContext
         ComPtr<IDXGISwapChain>      swapChain_;
         UINT                        swapChainInterval_  = 0;
         UINT                        swapChainSamples_   = 1;
+        UINT                        swapChainFlags_     = 0;        // Must be passed to IDXGISwapChain::ResizeBuffers again
+        bool                        flipModel_          = false;    // Flip-model swap chain (DXGI 1.2), otherwise legacy DISCARD swap effect
+        bool                        tearingSupported_   = false;    // Tearing for presentation without V-sync (DXGI 1.5)
+        HANDLE                      frameLatencyWaitableObject_ = nullptr;  // Only for flip-model swap chains, see WaitForNextFrame
+        UINT                        maxFrameLatency_    = 0;        // Zero for the default frame latency of DXGI
 
         D3D11BackBuffer             backBuffer_;
 
         DXGI_FORMAT                 colorFormat_        = DXGI_FORMAT_UNKNOWN;
         DXGI_FORMAT                 depthStencilFormat_ = DXGI_FORMAT_UNKNOWN;
 
+        std::uint64_t               presentCount_       = 0;
+
 };
 
 
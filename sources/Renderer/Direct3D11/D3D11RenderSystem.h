@@ -22,7 +22,10 @@
 #include "RenderState/D3D11GraphicsPipelineBase.h"
 #include "RenderState/D3D11ComputePipeline.h"
 #include "RenderState/D3D11StateManager.h"
+#include "RenderState/D3D11StateObjectCache.h"
 #include "RenderState/D3D11Query.h"
+#include "RenderState/D3D11QueryHeap.h"
+#include "RenderState/D3D11RenderPass.h"
 #include "RenderState/D3D11Fence.h"
 #include "RenderState/D3D11ResourceHeap.h"
 #include "RenderState/D3D11PipelineLayout.h"
@@ -35,6 +38,9 @@
 #include "Texture/D3D11RenderTarget.h"
 
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
+#include "../TextureReadbackPool.h"
+#include "../StatisticsCounter.h"
 #include "../DXCommon/ComPtr.h"
 
 #include <dxgi.h>
@@ -52,7 +58,7 @@ class D3D11RenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        D3D11RenderSystem();
+        D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D11RenderSystem();
 
         /* ----- Render Context ------ */
@@ -67,8 +73,9 @@ class D3D11RenderSystem final : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
         CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -83,20 +90,30 @@ class D3D11RenderSystem final : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
 
         void Release(Texture& texture) override;
 
         void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
 
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
 
+        void SetTextureMinLOD(Texture& texture, float minLOD) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -109,12 +126,20 @@ class D3D11RenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
 
         void Release(RenderTarget& renderTarget) override;
 
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& desc) override;
@@ -137,18 +162,32 @@ class D3D11RenderSystem final : public RenderSystem
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+        bool QueryMemoryStatistics(MemoryStatistics& statistics) override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
 
         void Release(Query& query) override;
 
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
         /* ----- Fences ----- */
 
         Fence* CreateFence() override;
 
         void Release(Fence& fence) override;
 
+        /* ----- Worker threads ----- */
+
+        bool AttachWorkerThread() override;
+        void DetachWorkerThread() override;
+
         /* ----- Extended internal functions ----- */
 
         inline D3D_FEATURE_LEVEL GetFeatureLevel() const
@@ -165,7 +204,7 @@ class D3D11RenderSystem final : public RenderSystem
 
         void CreateFactory();
         void QueryVideoAdapters();
-        void CreateDevice(IDXGIAdapter* adapter);
+        void CreateDevice(const RenderSystemDescriptor& renderSystemDesc);
         bool CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr);
         void CreateStateManagerAndCommandQueue();
 
@@ -191,9 +230,8 @@ class D3D11RenderSystem final : public RenderSystem
 
         void InitializeGpuTexture(
             D3D11Texture&               textureD3D,
-            const Format                format,
+            const TextureDescriptor&    desc,
             const SrcImageDescriptor*   imageDesc,
-            const Extent3D&             extent,
             std::uint32_t               arrayLayers
         );
 
@@ -201,6 +239,7 @@ class D3D11RenderSystem final : public RenderSystem
             D3D11Texture&       textureD3D,
             const Format        format,
             SrcImageDescriptor  imageDesc,
+            std::uint32_t       mipLevel,
             const Extent3D&     extent,
             std::uint32_t       arrayLayers
         );
@@ -243,6 +282,7 @@ class D3D11RenderSystem final : public RenderSystem
         D3D_FEATURE_LEVEL                               featureLevel_           = D3D_FEATURE_LEVEL_9_1;
 
         std::unique_ptr<D3D11StateManager>              stateMngr_;
+        D3D11StateObjectCache                           stateObjectCache_;
 
         /* ----- Hardware object containers ----- */
 
@@ -253,7 +293,9 @@ class D3D11RenderSystem final : public RenderSystem
         HWObjectContainer<D3D11BufferArray>             bufferArrays_;
         HWObjectContainer<D3D11Texture>                 textures_;
         HWObjectContainer<D3D11Sampler>                 samplers_;
+        SamplerCache                                    samplerCache_;          // Shares sampler objects between identical sampler descriptors
         HWObjectContainer<D3D11RenderTarget>            renderTargets_;
+        HWObjectContainer<D3D11RenderPass>              renderPasses_;
         HWObjectContainer<D3D11Shader>                  shaders_;
         HWObjectContainer<D3D11ShaderProgram>           shaderPrograms_;
         HWObjectContainer<D3D11PipelineLayout>          pipelineLayouts_;
@@ -261,14 +303,20 @@ class D3D11RenderSystem final : public RenderSystem
         HWObjectContainer<D3D11ComputePipeline>         computePipelines_;
         HWObjectContainer<D3D11ResourceHeap>            resourceHeaps_;
         HWObjectContainer<D3D11Query>                   queries_;
+        HWObjectContainer<D3D11QueryHeap>               queryHeaps_;
         HWObjectContainer<D3D11Fence>                   fences_;
 
         /* ----- Other members ----- */
 
-        std::vector<VideoAdapterDescriptor>             videoAdatperDescs_;
+        UINT                                            adapterIndex_           = 0;    // Index of the video adapter the device has been created for
 
         CPUAccess                                       mappedBufferCPUAccess_  = CPUAccess::ReadOnly;
 
+        TextureReadbackPool<ComPtr<ID3D11Resource>>     textureReadbacks_;      // Staging textures of asynchronous texture readbacks
+        TextureReadbackPool<ComPtr<ID3D11Buffer>>       bufferReadbacks_;       // Staging buffers of asynchronous buffer readbacks
+
+        StatisticsCounter                               statistics_;            // Shared with all command buffers, see LLGL_ENABLE_STATISTICS
+
 };
 
 
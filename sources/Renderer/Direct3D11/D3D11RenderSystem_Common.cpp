@@ -15,6 +15,7 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <cstring>
 
 #include "Buffer/D3D11VertexBuffer.h"
 #include "Buffer/D3D11BufferArray.h"
@@ -32,12 +33,12 @@ namespace LLGL
 {
 
 
-D3D11RenderSystem::D3D11RenderSystem()
+D3D11RenderSystem::D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
     /* Create DXGU factory, query video adapters, and create D3D11 device */
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice(nullptr);
+    CreateDevice(renderSystemDesc);
 
     /* Initialize states and renderer information */
     CreateStateManagerAndCommandQueue();
@@ -73,14 +74,30 @@ CommandQueue* D3D11RenderSystem::GetCommandQueue()
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* D3D11RenderSystem::CreateCommandBuffer()
+CommandBuffer* D3D11RenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return CreateCommandBufferExt();
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+    {
+        /* Create deferred context with its own state manager, so the command buffer can be recorded on another thread */
+        ComPtr<ID3D11DeviceContext> deferredContext;
+        auto hr = device_->CreateDeferredContext(0, deferredContext.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 deferred device context");
+
+        auto deferredStateMngr = MakeUnique<D3D11StateManager>(deferredContext);
+        return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(std::move(deferredStateMngr), deferredContext, statistics_, desc.flags));
+    }
+    return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(*stateMngr_, context_, statistics_, desc.flags));
 }
 
 CommandBufferExt* D3D11RenderSystem::CreateCommandBufferExt()
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(*stateMngr_, context_));
+    return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(*stateMngr_, context_, statistics_, 0));
+}
+
+CommandBuffer* D3D11RenderSystem::CreateSecondaryCommandBuffer()
+{
+    /* Secondary command buffers are not supported */
+    return nullptr;
 }
 
 void D3D11RenderSystem::Release(CommandBuffer& commandBuffer)
@@ -129,8 +146,16 @@ void D3D11RenderSystem::Release(BufferArray& bufferArray)
 
 void D3D11RenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_STATISTICS_ADD(bytesUploaded, dataSize);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
-    bufferD3D.UpdateSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(offset));
+    auto context = commandQueue_->GetUploadContext();
+
+    /* Deferred contexts can only map dynamic buffers with discard, which would invalidate the other regions of the ring */
+    if (context != context_.Get() && bufferD3D.IsDynamicRing())
+        throw std::runtime_error("cannot write dynamic D3D11 buffer on worker thread");
+
+    bufferD3D.UpdateSubresource(context, data, static_cast<UINT>(dataSize), static_cast<UINT>(offset));
 }
 
 void* D3D11RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
@@ -140,12 +165,79 @@ void* D3D11RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
     return bufferD3D.Map(context_.Get(), mappedBufferCPUAccess_);
 }
 
+void* D3D11RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    mappedBufferCPUAccess_ = access;
+    return bufferD3D.Map(context_.Get(), mappedBufferCPUAccess_, static_cast<UINT>(offset), static_cast<UINT>(length));
+}
+
 void D3D11RenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     bufferD3D.Unmap(context_.Get(), mappedBufferCPUAccess_);
 }
 
+std::uint32_t D3D11RenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
+{
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    auto& fenceD3D  = LLGL_CAST(D3D11Fence&, fence);
+
+    /* Allocate readback and (re-)create its staging buffer if it is too small */
+    auto readback = bufferReadbacks_.Alloc(size);
+    auto& rb = bufferReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        D3D11_BUFFER_DESC stagingDesc;
+        {
+            stagingDesc.ByteWidth           = static_cast<UINT>(size);
+            stagingDesc.Usage               = D3D11_USAGE_STAGING;
+            stagingDesc.BindFlags           = 0;
+            stagingDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_READ;
+            stagingDesc.MiscFlags           = 0;
+            stagingDesc.StructureByteStride = 0;
+        }
+        auto hr = device_->CreateBuffer(&stagingDesc, nullptr, rb.staging.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 staging buffer for asynchronous buffer readback");
+
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.dataSize = size;
+
+    /* Copy range into the staging buffer, which is not mapped before the fence has been signaled */
+    const D3D11_BOX srcBox { static_cast<UINT>(offset), 0, 0, static_cast<UINT>(offset + size), 1, 1 };
+    context_->CopySubresourceRegion(rb.staging.Get(), 0, 0, 0, 0, bufferD3D.GetNative(), 0, &srcBox);
+    fenceD3D.Submit(context_.Get());
+
+    return readback;
+}
+
+void D3D11RenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    LLGL_ASSERT_PTR(data);
+
+    auto& rb = bufferReadbacks_.Get(readback);
+    AssertBufferReadbackDataSize(dataSize, rb.dataSize);
+
+    /* Wait until the GPU has passed the copy command, so mapping the staging buffer does not stall */
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, *rb.fence);
+    fenceD3D.Wait(context_.Get(), ~0ull);
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    auto hr = context_->Map(rb.staging.Get(), 0, D3D11_MAP_READ, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 staging buffer for buffer readback");
+    {
+        ::memcpy(data, mappedSubresource.pData, static_cast<std::size_t>(rb.dataSize));
+    }
+    context_->Unmap(rb.staging.Get(), 0);
+
+    /* Return staging buffer to the pool */
+    bufferReadbacks_.Free(readback);
+}
+
 /* ----- Textures ----- */
 
 // --> see "D3D11RenderSystem_Textures.cpp" file
@@ -154,12 +246,20 @@ void D3D11RenderSystem::UnmapBuffer(Buffer& buffer)
 
 Sampler* D3D11RenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), desc));
+    return samplerCache_.GetOrCreate(
+        desc,
+        [&]()
+        {
+            return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), desc));
+        }
+    );
 }
 
 void D3D11RenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    /* Only destroy sampler when it is no longer shared with other identical sampler descriptors */
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
 }
 
 /* ----- Resource Heaps ----- */
@@ -174,6 +274,12 @@ void D3D11RenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+void D3D11RenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
+    resourceHeapD3D.WriteResourceViews(firstDescriptor, numResourceViews, resourceViews);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* D3D11RenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
@@ -186,12 +292,24 @@ void D3D11RenderSystem::Release(RenderTarget& renderTarget)
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
+/* ----- Render Passes ----- */
+
+RenderPass* D3D11RenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    return TakeOwnership(renderPasses_, MakeUnique<D3D11RenderPass>(desc));
+}
+
+void D3D11RenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
 /* ----- Shader ----- */
 
 Shader* D3D11RenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
     AssertCreateShader(desc);
-    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), desc));
+    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), desc, GetConfiguration().shaderCacheDirectory));
 }
 
 ShaderProgram* D3D11RenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
@@ -230,7 +348,7 @@ GraphicsPipeline* D3D11RenderSystem::CreateGraphicsPipeline(const GraphicsPipeli
     if (device3_)
     {
         /* Create graphics pipeline for Direct3D 11.3 */
-        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline3>(device3_.Get(), desc));
+        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline3>(device3_.Get(), stateObjectCache_, desc));
     }
     #endif
 
@@ -238,7 +356,7 @@ GraphicsPipeline* D3D11RenderSystem::CreateGraphicsPipeline(const GraphicsPipeli
     if (device2_)
     {
         /* Create graphics pipeline for Direct3D 11.1 (there is no dedicated class for 11.2) */
-        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline1>(device2_.Get(), desc));
+        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline1>(device2_.Get(), stateObjectCache_, desc));
     }
     #endif
 
@@ -246,12 +364,12 @@ GraphicsPipeline* D3D11RenderSystem::CreateGraphicsPipeline(const GraphicsPipeli
     if (device1_)
     {
         /* Create graphics pipeline for Direct3D 11.1 */
-        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline1>(device1_.Get(), desc));
+        return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline1>(device1_.Get(), stateObjectCache_, desc));
     }
     #endif
 
     /* Create graphics pipeline for Direct3D 11.0 */
-    return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline>(device_.Get(), desc));
+    return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline>(device_.Get(), stateObjectCache_, desc));
 }
 
 ComputePipeline* D3D11RenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
@@ -262,6 +380,9 @@ ComputePipeline* D3D11RenderSystem::CreateComputePipeline(const ComputePipelineD
 void D3D11RenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
     RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+
+    /* Release state objects that are no longer shared with any other graphics pipeline */
+    stateObjectCache_.ReleaseUnusedStates();
 }
 
 void D3D11RenderSystem::Release(ComputePipeline& computePipeline)
@@ -269,6 +390,29 @@ void D3D11RenderSystem::Release(ComputePipeline& computePipeline)
     RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+/* ----- Statistics ----- */
+
+bool D3D11RenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    statistics = statistics_.Query(reset);
+    #ifdef LLGL_ENABLE_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+bool D3D11RenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    ComPtr<IDXGIAdapter> adapter;
+    if (factory_->EnumAdapters(adapterIndex_, adapter.ReleaseAndGetAddressOf()) == DXGI_ERROR_NOT_FOUND)
+    {
+        statistics.heaps.clear();
+        return false;
+    }
+    return DXQueryVideoMemoryStatistics(adapter.Get(), statistics);
+}
+
 /* ----- Queries ----- */
 
 Query* D3D11RenderSystem::CreateQuery(const QueryDescriptor& desc)
@@ -281,11 +425,21 @@ void D3D11RenderSystem::Release(Query& query)
     RemoveFromUniqueSet(queries_, &query);
 }
 
+QueryHeap* D3D11RenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<D3D11QueryHeap>(device_.Get(), desc));
+}
+
+void D3D11RenderSystem::Release(QueryHeap& queryHeap)
+{
+    RemoveFromUniqueSet(queryHeaps_, &queryHeap);
+}
+
 /* ----- Fences ----- */
 
 Fence* D3D11RenderSystem::CreateFence()
 {
-    return TakeOwnership(fences_, MakeUnique<D3D11Fence>(/*device_.Get(), 0*/));
+    return TakeOwnership(fences_, MakeUnique<D3D11Fence>(device_.Get()));
 }
 
 void D3D11RenderSystem::Release(Fence& fence)
@@ -293,6 +447,19 @@ void D3D11RenderSystem::Release(Fence& fence)
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Worker threads ----- */
+
+bool D3D11RenderSystem::AttachWorkerThread()
+{
+    /* The device is free-threaded, so worker threads only need their own deferred context for uploads */
+    return commandQueue_->AttachWorkerThread(device_.Get());
+}
+
+void D3D11RenderSystem::DetachWorkerThread()
+{
+    commandQueue_->DetachWorkerThread();
+}
+
 
 /*
  * ======= Private: =======
@@ -308,32 +475,43 @@ void D3D11RenderSystem::CreateFactory()
 void D3D11RenderSystem::QueryVideoAdapters()
 {
     /* Enumerate over all video adapters */
+    std::vector<VideoAdapterDescriptor> videoAdapterDescs;
     ComPtr<IDXGIAdapter> adapter;
 
     for (UINT i = 0; factory_->EnumAdapters(i, &adapter) != DXGI_ERROR_NOT_FOUND; ++i)
     {
         /* Add adapter to the list and release handle */
-        videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
+        videoAdapterDescs.push_back(DXGetVideoAdapterDesc(adapter.Get()));
         adapter.Reset();
     }
+
+    SetVideoAdapters(videoAdapterDescs);
 }
 
-void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter)
+void D3D11RenderSystem::CreateDevice(const RenderSystemDescriptor& renderSystemDesc)
 {
-    /* Use default adapter (null) and try all feature levels */
+    /* Use selected adapter (or default adapter if null) and try all feature levels */
+    ComPtr<IDXGIAdapter> adapter;
+
+    adapterIndex_ = DXFindVideoAdapter(GetVideoAdapters(), renderSystemDesc);
+    if (adapterIndex_ != ~0u)
+        factory_->EnumAdapters(adapterIndex_, adapter.ReleaseAndGetAddressOf());
+    else
+        adapterIndex_ = 0;
+
     auto    featureLevels   = DXGetFeatureLevels(D3D_FEATURE_LEVEL_11_1);
     HRESULT hr              = 0;
 
     #ifdef LLGL_DEBUG
 
     /* Try to create device with debug layer (only supported if Windows 8.1 SDK is installed) */
-    if (!CreateDeviceWithFlags(adapter, featureLevels, D3D11_CREATE_DEVICE_DEBUG, hr))
-        CreateDeviceWithFlags(adapter, featureLevels, 0, hr);
+    if (!CreateDeviceWithFlags(adapter.Get(), featureLevels, D3D11_CREATE_DEVICE_DEBUG, hr))
+        CreateDeviceWithFlags(adapter.Get(), featureLevels, 0, hr);
 
     #else
 
     /* Create device without debug layer */
-    CreateDeviceWithFlags(adapter, featureLevels, 0, hr);
+    CreateDeviceWithFlags(adapter.Get(), featureLevels, 0, hr);
 
     #endif
 
@@ -359,7 +537,15 @@ void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter)
 
 bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr)
 {
-    for (D3D_DRIVER_TYPE driver : { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE })
+    /* Explicit adapters require the unknown driver type, otherwise try hardware driver first and software drivers as fallback */
+    const std::vector<D3D_DRIVER_TYPE> driverTypes =
+    (
+        adapter != nullptr
+            ? std::vector<D3D_DRIVER_TYPE>{ D3D_DRIVER_TYPE_UNKNOWN }
+            : std::vector<D3D_DRIVER_TYPE>{ D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE }
+    );
+
+    for (D3D_DRIVER_TYPE driver : driverTypes)
     {
         hr = D3D11CreateDevice(
             adapter,                                    // Video adapter
@@ -413,9 +599,9 @@ void D3D11RenderSystem::QueryRendererInfo()
     info.shadingLanguageName = "HLSL " + DXFeatureLevelToShaderModel(GetFeatureLevel());
 
     /* Initialize video adapter strings */
-    if (!videoAdatperDescs_.empty())
+    if (adapterIndex_ < GetVideoAdapters().size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = GetVideoAdapters()[adapterIndex_];
         info.deviceName = std::string(videoAdapterDesc.name.begin(), videoAdapterDesc.name.end());
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -437,12 +623,18 @@ void D3D11RenderSystem::QueryRenderingCaps()
 
         caps.features.hasCommandBufferExt           = true;
         caps.features.hasConservativeRasterization  = (minorVersion >= 3);
+        caps.features.hasDynamicOffsets             = stateMngr_->HasConstantBufferRanges();
+        caps.features.hasTimelineFences             = true;
+        caps.features.hasTextureViews               = true;
+        caps.features.hasTextureMinLOD              = true;
 
         caps.limits.maxNumViewports                 = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
         caps.limits.maxViewportSize[0]              = D3D11_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxViewportSize[1]              = D3D11_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxBufferSize                   = std::numeric_limits<UINT>::max();
         caps.limits.maxConstantBufferSize           = D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+        caps.limits.maxConstantsSize                = 128u;
+        caps.limits.constantBufferOffsetAlignment   = 256u; // 16 shader constants for 'VSSetConstantBuffers1'
     }
     SetRenderingCaps(caps);
 }
@@ -8,9 +8,12 @@
 #include "D3D11RenderSystem.h"
 #include "D3D11Types.h"
 #include "../DXCommon/DXCore.h"
+#include "../DXCommon/DXTypes.h"
 #include "../CheckedCast.h"
+#include "../MipChain.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -52,6 +55,12 @@ Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
     return TakeOwnership(textures_, std::move(texture));
 }
 
+Texture* D3D11RenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureD3D = LLGL_CAST(D3D11Texture&, sharedTexture);
+    return TakeOwnership(textures_, MakeUnique<D3D11Texture>(device_.Get(), sharedTextureD3D, textureViewDesc));
+}
+
 void D3D11RenderSystem::Release(Texture& texture)
 {
     RemoveFromUniqueSet(textures_, &texture);
@@ -59,6 +68,8 @@ void D3D11RenderSystem::Release(Texture& texture)
 
 void D3D11RenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_STATISTICS_ADD(bytesUploaded, imageDesc.dataSize);
+
     /* Update generic texture at determined region */
     UpdateGenericTexture(texture, subTextureDesc.mipLevel, 0, subTextureDesc.offset, subTextureDesc.extent, imageDesc);
 }
@@ -123,6 +134,118 @@ void D3D11RenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLev
     context_->Unmap(hwTextureCopy.resource.Get(), 0);
 }
 
+std::uint32_t D3D11RenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureD3D    = LLGL_CAST(D3D11Texture&, texture);
+    auto& fenceD3D      = LLGL_CAST(D3D11Fence&, fence);
+
+    const auto format = DXTypes::Unmap(textureD3D.GetFormat());
+    if (IsMultiSampleTexture(textureD3D.GetType()) || IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot read texture with compressed, depth-stencil, or multi-sampled format asynchronously");
+
+    /* Determine array layers and box of the region */
+    UINT        baseArrayLayer = 0, numArrayLayers = 0;
+    D3D11_BOX   srcBox;
+    textureD3D.GetSubresourceRegion(region.offset, region.extent, baseArrayLayer, numArrayLayers, srcBox);
+
+    const auto size = static_cast<std::uint64_t>(FormatBitSize(format) / 8) * region.extent.width * region.extent.height * region.extent.depth;
+
+    /* Allocate readback and only reuse its staging texture if it has the same dimension, format, and extent */
+    auto readback = textureReadbacks_.Alloc(size);
+    auto& rb = textureReadbacks_.Get(readback);
+
+    bool isStagingCompatible = false;
+    if (rb.capacity > 0 && rb.format == format && rb.extent == region.extent)
+    {
+        D3D11_RESOURCE_DIMENSION srcDimension, stagingDimension;
+        textureD3D.GetNative().resource->GetType(&srcDimension);
+        rb.staging->GetType(&stagingDimension);
+        isStagingCompatible = (srcDimension == stagingDimension);
+    }
+
+    if (!isStagingCompatible)
+    {
+        D3D11NativeTexture textureCopy;
+        textureD3D.CreateSubresourceRegionStaging(device_.Get(), textureCopy, numArrayLayers, srcBox);
+        rb.staging  = textureCopy.resource;
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.format   = format;
+    rb.extent   = region.extent;
+
+    /* Copy region into the staging texture, which is not mapped before the fence has been signaled */
+    textureD3D.CopySubresourceRegionToStaging(context_.Get(), rb.staging.Get(), region.mipLevel, baseArrayLayer, numArrayLayers, srcBox);
+    fenceD3D.Submit(context_.Get());
+
+    return readback;
+}
+
+void D3D11RenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& rb = textureReadbacks_.Get(readback);
+
+    const auto numTexels = rb.extent.width * rb.extent.height * rb.extent.depth;
+    AssertImageDataSize(imageDesc.dataSize, ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels), "texture readback");
+
+    /* Wait until the GPU has passed the copy command, so mapping the staging texture does not stall */
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, *rb.fence);
+    fenceD3D.Wait(context_.Get(), ~0ull);
+
+    /* Determine extent of each array layer (i.e. of each subresource) within the staging texture */
+    D3D11_RESOURCE_DIMENSION dimension;
+    rb.staging->GetType(&dimension);
+
+    UINT        numArrayLayers  = 1;
+    Extent3D    layerExtent     = rb.extent;
+
+    if (dimension == D3D11_RESOURCE_DIMENSION_TEXTURE1D)
+    {
+        numArrayLayers      = rb.extent.height;
+        layerExtent.height  = 1;
+    }
+    else if (dimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D)
+    {
+        numArrayLayers      = rb.extent.depth;
+        layerExtent.depth   = 1;
+    }
+
+    const auto dstLayerSize = static_cast<std::size_t>(
+        ImageDataSize(imageDesc.format, imageDesc.dataType, layerExtent.width * layerExtent.height * layerExtent.depth)
+    );
+
+    /* Map each array layer and copy its texel data into the output image */
+    for (UINT layer = 0; layer < numArrayLayers; ++layer)
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+        auto hr = context_->Map(rb.staging.Get(), D3D11CalcSubresource(0, layer, 1), D3D11_MAP_READ, 0, &mappedSubresource);
+        DXThrowIfFailed(hr, "failed to map D3D11 staging texture for texture readback");
+        {
+            DstImageDescriptor layerImageDesc = imageDesc;
+            {
+                layerImageDesc.data     = reinterpret_cast<char*>(imageDesc.data) + dstLayerSize * layer;
+                layerImageDesc.dataSize = dstLayerSize;
+            }
+            CopyTextureReadbackData(
+                layerImageDesc,
+                rb.format,
+                layerExtent,
+                mappedSubresource.pData,
+                mappedSubresource.RowPitch,
+                mappedSubresource.DepthPitch,
+                GetConfiguration().threadCount
+            );
+        }
+        context_->Unmap(rb.staging.Get(), D3D11CalcSubresource(0, layer, 1));
+    }
+
+    /* Return staging texture to the pool */
+    textureReadbacks_.Free(readback);
+}
+
 void D3D11RenderSystem::GenerateMips(Texture& texture)
 {
     /* Generate MIP-maps for the default SRV */
@@ -130,7 +253,7 @@ void D3D11RenderSystem::GenerateMips(Texture& texture)
     if (auto srv = textureD3D.GetSRV())
     {
         /* Generate MIP-maps for default SRV */
-        context_->GenerateMips(srv);
+        commandQueue_->GetUploadContext()->GenerateMips(srv);
     }
     else
     {
@@ -150,7 +273,7 @@ void D3D11RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLeve
          textureD3D.GetSRV() != nullptr )
     {
         /* Generate MIP-maps for the default SRV */
-        context_->GenerateMips(textureD3D.GetSRV());
+        commandQueue_->GetUploadContext()->GenerateMips(textureD3D.GetSRV());
     }
     else
     {
@@ -159,6 +282,12 @@ void D3D11RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLeve
     }
 }
 
+void D3D11RenderSystem::SetTextureMinLOD(Texture& texture, float minLOD)
+{
+    auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
+    commandQueue_->GetUploadContext()->SetResourceMinLOD(textureD3D.GetNative().resource.Get(), minLOD);
+}
+
 
 /*
  * ======= Private: =======
@@ -167,6 +296,19 @@ void D3D11RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLeve
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/ff476203(v=vs.85).aspx
 static UINT GetDXTextureBindFlags(const TextureDescriptor& desc)
 {
+    /* Depth-stencil textures are bound as depth-stencil views (DSV), and as shader-resource views (SRV) only if they are sampled */
+    if (IsDepthStencilFormat(desc.format))
+    {
+        UINT flags = 0;
+
+        if ((desc.flags & TextureFlags::SampleUsage) != 0)
+            flags |= D3D11_BIND_SHADER_RESOURCE;
+        if ((desc.flags & TextureFlags::AttachmentUsage) != 0)
+            flags |= D3D11_BIND_DEPTH_STENCIL;
+
+        return flags;
+    }
+
     UINT flags = D3D11_BIND_SHADER_RESOURCE;
 
     /* Render target binding flag is required for MIP-map generation and render target attachment */
@@ -180,7 +322,7 @@ static UINT GetDXTextureMiscFlags(const TextureDescriptor& desc)
 {
     UINT flags = 0;
 
-    if (IsMipMappedTexture(desc))
+    if (IsMipMappedTexture(desc) && !IsDepthStencilFormat(desc.format))
         flags |= D3D11_RESOURCE_MISC_GENERATE_MIPS;
     if (IsCubeTexture(desc.type))
         flags |= D3D11_RESOURCE_MISC_TEXTURECUBE;
@@ -205,7 +347,7 @@ void D3D11RenderSystem::BuildGenericTexture1D(D3D11Texture& textureD3D, const Te
     textureD3D.CreateTexture1D(device_.Get(), descDX, desc.flags);
 
     /* Initialize texture image data */
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers);
+    InitializeGpuTexture(textureD3D, desc, imageDesc, desc.arrayLayers);
 }
 
 void D3D11RenderSystem::BuildGenericTexture2D(D3D11Texture& textureD3D, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
@@ -228,7 +370,7 @@ void D3D11RenderSystem::BuildGenericTexture2D(D3D11Texture& textureD3D, const Te
     textureD3D.CreateTexture2D(device_.Get(), descDX, desc.flags);
 
     /* Initialize texture image data */
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers);
+    InitializeGpuTexture(textureD3D, desc, imageDesc, desc.arrayLayers);
 }
 
 void D3D11RenderSystem::BuildGenericTexture3D(D3D11Texture& textureD3D, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
@@ -249,7 +391,7 @@ void D3D11RenderSystem::BuildGenericTexture3D(D3D11Texture& textureD3D, const Te
     textureD3D.CreateTexture3D(device_.Get(), descDX, desc.flags);
 
     /* Initialize texture image data */
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, 1);
+    InitializeGpuTexture(textureD3D, desc, imageDesc, 1);
 }
 
 void D3D11RenderSystem::BuildGenericTexture2DMS(D3D11Texture& textureD3D, const TextureDescriptor& desc)
@@ -283,7 +425,7 @@ void D3D11RenderSystem::UpdateGenericTexture(
     /* Get D3D texture and update subresource */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     textureD3D.UpdateSubresource(
-        context_.Get(),
+        commandQueue_->GetUploadContext(),
         static_cast<UINT>(mipLevel),
         arrayLayer,
         CD3D11_BOX(
@@ -301,20 +443,29 @@ void D3D11RenderSystem::UpdateGenericTexture(
 
 void D3D11RenderSystem::InitializeGpuTexture(
     D3D11Texture&               textureD3D,
-    const Format                format,
+    const TextureDescriptor&    desc,
     const SrcImageDescriptor*   imageDesc,
-    const Extent3D&             extent,
     std::uint32_t               arrayLayers)
 {
     if (imageDesc)
     {
-        /* Initialize texture with specified image descriptor */
-        InitializeGpuTextureWithImage(textureD3D, format, *imageDesc, extent, arrayLayers);
+        /* Initialize texture with each MIP-map level of the specified image descriptor */
+        const auto numMipLevels = NumMipChainLevels(desc, *imageDesc);
+        for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+        {
+            const Extent3D mipExtent
+            {
+                std::max(1u, desc.extent.width  >> mipLevel),
+                std::max(1u, desc.extent.height >> mipLevel),
+                std::max(1u, desc.extent.depth  >> mipLevel)
+            };
+            InitializeGpuTextureWithImage(textureD3D, desc.format, GetMipChainLevel(desc, *imageDesc, mipLevel), mipLevel, mipExtent, arrayLayers);
+        }
     }
-    else if (GetConfiguration().imageInitialization.enabled && !IsDepthStencilFormat(format))
+    else if (GetConfiguration().imageInitialization.enabled && !IsDepthStencilFormat(desc.format))
     {
         /* Initialize texture with default image data */
-        InitializeGpuTextureWithDefault(textureD3D, format, extent, arrayLayers);
+        InitializeGpuTextureWithDefault(textureD3D, desc.format, desc.extent, arrayLayers);
     }
 }
 
@@ -322,17 +473,16 @@ void D3D11RenderSystem::InitializeGpuTextureWithImage(
     D3D11Texture&       textureD3D,
     const Format        format,
     SrcImageDescriptor  imageDesc,
+    std::uint32_t       mipLevel,
     const Extent3D&     extent,
     std::uint32_t       arrayLayers)
 {
-    /* Update only the first MIP-map level for each array layer */
+    /* Update the specified MIP-map level for each array layer */
     const auto bytesPerLayer =
     (
-        extent.width                        *
-        extent.height                       *
-        extent.depth                        *
-        ImageFormatSize(imageDesc.format)   *
-        DataTypeSize(imageDesc.dataType)
+        IsCompressedFormat(format)
+            ? TextureBufferSize(format, extent)
+            : extent.width * extent.height * extent.depth * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType)
     );
 
     /* Remap image data size for a single array layer to update each subresource individually */
@@ -341,12 +491,14 @@ void D3D11RenderSystem::InitializeGpuTextureWithImage(
 
     imageDesc.dataSize /= arrayLayers;
 
+    auto context = commandQueue_->GetUploadContext();
+
     for (std::uint32_t layer = 0; layer < arrayLayers; ++layer)
     {
         /* Update subresource of current array layer */
         textureD3D.UpdateSubresource(
-            context_.Get(),
-            0, // mipLevel
+            context,
+            mipLevel,
             layer,
             CD3D11_BOX(0, 0, 0, extent.width, extent.height, extent.depth),
             imageDesc,
@@ -379,10 +531,12 @@ void D3D11RenderSystem::InitializeGpuTextureWithDefault(
         /* Update only the first MIP-map level for each array slice */
         imageDescDefault.data = imageBuffer.get();
 
+        auto context = commandQueue_->GetUploadContext();
+
         for (std::uint32_t layer = 0; layer < arrayLayers; ++layer)
         {
             textureD3D.UpdateSubresource(
-                context_.Get(),
+                context,
                 0,
                 layer,
                 CD3D11_BOX(0, 0, 0, extent.width, extent.height, extent.depth),
@@ -403,7 +557,7 @@ void D3D11RenderSystem::GenerateMipsWithSubresourceSRV(
     /* Generate MIP-maps for a subresource SRV */
     ComPtr<ID3D11ShaderResourceView> srv;
     textureD3D.CreateSubresourceSRV(device_.Get(), srv.GetAddressOf(), baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
-    context_->GenerateMips(srv.Get());
+    commandQueue_->GetUploadContext()->GenerateMips(srv.Get());
 }
 
 
@@ -7,6 +7,7 @@
 
 #include "D3D11ComputePipeline.h"
 #include "D3D11StateManager.h"
+#include "D3D11PipelineLayout.h"
 #include "../Shader/D3D11ShaderProgram.h"
 #include "../Shader/D3D11Shader.h"
 #include "../../CheckedCast.h"
@@ -24,6 +25,10 @@ D3D11ComputePipeline::D3D11ComputePipeline(const ComputePipelineDescriptor& desc
         cs_ = shaderProgramD3D->GetCS()->GetNative().cs;
     else
         throw std::invalid_argument("failed to create compute pipeline due to missing compute shader program");
+
+    /* Store layout of constants */
+    if (auto pipelineLayoutD3D = LLGL_CAST(D3D11PipelineLayout*, desc.pipelineLayout))
+        constants_ = pipelineLayoutD3D->GetConstants();
 }
 
 void D3D11ComputePipeline::Bind(D3D11StateManager& stateMngr)
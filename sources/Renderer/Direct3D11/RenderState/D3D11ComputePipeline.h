@@ -10,6 +10,7 @@
 
 
 #include <LLGL/ComputePipeline.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d11.h>
 
@@ -29,9 +30,16 @@ class D3D11ComputePipeline final : public ComputePipeline
 
         void Bind(D3D11StateManager& stateMngr);
 
+        // Returns the layout of the constants from the pipeline layout.
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
     private:
 
         ComPtr<ID3D11ComputeShader> cs_;
+        ConstantsDescriptor         constants_;
 
 };
 
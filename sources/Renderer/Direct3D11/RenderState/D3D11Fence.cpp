@@ -6,32 +6,127 @@
  */
 
 #include "D3D11Fence.h"
+#include "../../DXCommon/DXCore.h"
+#include <chrono>
+#include <thread>
 
 
 namespace LLGL
 {
 
 
-#if 0
+D3D11Fence::D3D11Fence(ID3D11Device* device) :
+    device_ { device }
+{
+    device->GetImmediateContext(context_.ReleaseAndGetAddressOf());
+    query_ = CreateEventQuery();
+}
+
+std::uint64_t D3D11Fence::GetCompletedValue()
+{
+    PollTimelineSignals();
+    return completedValue_;
+}
+
+void D3D11Fence::Submit(ID3D11DeviceContext* context)
+{
+    context->End(query_.Get());
+    submitted_ = true;
+}
+
+bool D3D11Fence::Wait(ID3D11DeviceContext* context, UINT64 timeout)
+{
+    /* Fence that has never been submitted is always signaled */
+    if (!submitted_)
+        return true;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        /* Poll event query (this also flushes the command buffer, so the query is guaranteed to be passed eventually) */
+        auto hr = context->GetData(query_.Get(), nullptr, 0, 0);
+        if (hr == S_OK)
+            return true;
+        if (hr != S_FALSE)
+            return false;
+
+        /* Check if timeout has expired */
+        if (timeout != ~0ull)
+        {
+            auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+            if (static_cast<UINT64>(elapsedTime.count()) >= timeout)
+                return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
 
-D3D11Fence::D3D11Fence(ID3D11Device5* device, UINT64 initialValue) :
-    value_ { initialValue }
+void D3D11Fence::Signal(ID3D11DeviceContext* context, UINT64 value)
 {
-    device->CreateFence(value_, D3D11_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
+    auto query = CreateEventQuery();
+    context->End(query.Get());
+    timelineSignals_.push_back({ value, query });
 }
 
-void D3D11Fence::Submit(ID3D11DeviceContext4* context)
+bool D3D11Fence::WaitValue(UINT64 value, UINT64 timeout)
 {
-    ++value_;
-    context->Signal(fence_.Get(), value_);
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        /* Poll event queries (this also flushes the command buffer) */
+        PollTimelineSignals();
+        if (completedValue_ >= value)
+            return true;
+
+        /* Check if timeout has expired */
+        if (timeout != ~0ull)
+        {
+            auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+            if (static_cast<UINT64>(elapsedTime.count()) >= timeout)
+                return false;
+        }
+
+        std::this_thread::yield();
+    }
 }
 
-bool D3D11Fence::Wait(ID3D11DeviceContext4* context)
+
+/*
+ * ======= Private: =======
+ */
+
+ComPtr<ID3D11Query> D3D11Fence::CreateEventQuery()
 {
-    return context->Wait(fence_.Get(), value_);
+    ComPtr<ID3D11Query> query;
+
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_EVENT;
+        queryDesc.MiscFlags = 0;
+    }
+    auto hr = device_->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 event query for fence");
+
+    return query;
 }
 
-#endif
+void D3D11Fence::PollTimelineSignals()
+{
+    /* Event queries are passed in order, so stop at the first one that is still pending */
+    while (!timelineSignals_.empty())
+    {
+        const auto& signal = timelineSignals_.front();
+
+        if (context_->GetData(signal.query.Get(), nullptr, 0, 0) != S_OK)
+            break;
+
+        completedValue_ = signal.value;
+        timelineSignals_.pop_front();
+    }
+}
 
 
 } // /namespace LLGL
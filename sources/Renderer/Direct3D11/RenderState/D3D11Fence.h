@@ -10,31 +10,60 @@
 
 
 #include <LLGL/Fence.h>
-//#include <d3d11_4.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+#include <deque>
 
 
 namespace LLGL
 {
 
 
+// Fence that is implemented with an event query, since native fences (ID3D11Fence) are only available with Direct3D 11.3.
 class D3D11Fence final : public Fence
 {
 
     public:
 
-        #if 0
-        D3D11Fence(ID3D11Device5* device, UINT64 initialValue);
+        D3D11Fence(ID3D11Device* device);
 
-        void Submit(ID3D11DeviceContext4* context);
-        bool Wait(ID3D11DeviceContext4* context);
-        #endif
+        std::uint64_t GetCompletedValue() override;
+
+        // Inserts the event query into the command stream of the specified device context.
+        void Submit(ID3D11DeviceContext* context);
+
+        // Polls the event query until the GPU has passed it, or the timeout (in nanoseconds) has expired.
+        bool Wait(ID3D11DeviceContext* context, UINT64 timeout);
+
+        // Inserts a new event query for the specified timeline value into the command stream of the specified device context.
+        void Signal(ID3D11DeviceContext* context, UINT64 value);
+
+        // Polls the event queries until the specified timeline value has been reached, or the timeout (in nanoseconds) has expired.
+        bool WaitValue(UINT64 value, UINT64 timeout);
+
+    private:
+
+        struct TimelineSignal
+        {
+            UINT64              value;
+            ComPtr<ID3D11Query> query;
+        };
 
     private:
 
-        #if 0
-        ComPtr<ID3D11Fence> fence_;
-        UINT64              value_  = 0;
-        #endif
+        // Creates a new event query.
+        ComPtr<ID3D11Query> CreateEventQuery();
+
+        // Removes all timeline signals whose event queries have been passed by the GPU.
+        void PollTimelineSignals();
+
+        ComPtr<ID3D11Device>        device_;
+        ComPtr<ID3D11DeviceContext> context_;
+        ComPtr<ID3D11Query>         query_;
+        bool                        submitted_      = false;
+
+        std::deque<TimelineSignal>  timelineSignals_;
+        UINT64                      completedValue_ = 0;
 
 };
 
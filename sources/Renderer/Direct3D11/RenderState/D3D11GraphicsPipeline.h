@@ -10,6 +10,7 @@
 
 
 #include "D3D11GraphicsPipelineBase.h"
+#include "D3D11StateObjectCache.h"
 
 
 namespace LLGL
@@ -24,6 +25,7 @@ class D3D11GraphicsPipeline final : public D3D11GraphicsPipelineBase
 
         D3D11GraphicsPipeline(
             ID3D11Device* device,
+            D3D11StateObjectCache& stateCache,
             const GraphicsPipelineDescriptor& desc
         );
 
@@ -31,9 +33,9 @@ class D3D11GraphicsPipeline final : public D3D11GraphicsPipelineBase
 
     private:
 
-        void CreateDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
-        void CreateRasterizerState(ID3D11Device* device, const RasterizerDescriptor& desc);
-        void CreateBlendState(ID3D11Device* device, const BlendDescriptor& desc);
+        void CreateDepthStencilState(ID3D11Device* device, D3D11StateObjectCache& stateCache, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
+        void CreateRasterizerState(ID3D11Device* device, D3D11StateObjectCache& stateCache, const RasterizerDescriptor& desc);
+        void CreateBlendState(ID3D11Device* device, D3D11StateObjectCache& stateCache, const BlendDescriptor& desc);
 
         ComPtr<ID3D11DepthStencilState> depthStencilState_;
         ComPtr<ID3D11RasterizerState>   rasterizerState_;
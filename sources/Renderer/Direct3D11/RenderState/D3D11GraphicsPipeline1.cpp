@@ -11,7 +11,7 @@
 #include "D3D11GraphicsPipeline1.h"
 #include "D3D11StateManager.h"
 #include "../D3D11Types.h"
-#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Helper.h"
 #include <LLGL/GraphicsPipelineFlags.h>
 
 
@@ -19,13 +19,13 @@ namespace LLGL
 {
 
 
-D3D11GraphicsPipeline1::D3D11GraphicsPipeline1(ID3D11Device1* device, const GraphicsPipelineDescriptor& desc) :
+D3D11GraphicsPipeline1::D3D11GraphicsPipeline1(ID3D11Device1* device, D3D11StateObjectCache& stateCache, const GraphicsPipelineDescriptor& desc) :
     D3D11GraphicsPipelineBase { desc }
 {
     /* Create render state objects for Direct3D 11.1 */
-    CreateDepthStencilState(device, desc.depth, desc.stencil);
-    CreateRasterizerState(device, desc.rasterizer);
-    CreateBlendState(device, desc.blend);
+    CreateDepthStencilState(device, stateCache, desc.depth, desc.stencil);
+    CreateRasterizerState(device, stateCache, desc.rasterizer);
+    CreateBlendState(device, stateCache, desc.blend);
 }
 
 void D3D11GraphicsPipeline1::Bind(D3D11StateManager& stateMngr)
@@ -35,8 +35,8 @@ void D3D11GraphicsPipeline1::Bind(D3D11StateManager& stateMngr)
 
     /* Setup render states */
     stateMngr.SetRasterizerState(rasterizerState_.Get());
-    stateMngr.SetDepthStencilState(depthStencilState_.Get(), GetStencilRef());
-    stateMngr.SetBlendState(blendState_.Get(), GetBlendFactor(), GetSampleMask());
+    stateMngr.SetDepthStencilState(depthStencilState_.Get(), GetStencilRef(stateMngr));
+    stateMngr.SetBlendState(blendState_.Get(), GetBlendFactor(stateMngr), GetSampleMask());
 }
 
 
@@ -44,28 +44,28 @@ void D3D11GraphicsPipeline1::Bind(D3D11StateManager& stateMngr)
  * ======= Private: =======
  */
 
-void D3D11GraphicsPipeline1::CreateDepthStencilState(ID3D11Device1* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
+void D3D11GraphicsPipeline1::CreateDepthStencilState(ID3D11Device1* device, D3D11StateObjectCache& stateCache, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
     D3D11_DEPTH_STENCIL_DESC descDX;
+    InitMemory(descDX);
     D3D11Types::Convert(descDX, depthDesc, stencilDesc);
-    auto hr = device->CreateDepthStencilState(&descDX, depthStencilState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+    depthStencilState_ = stateCache.CreateDepthStencilState(device, descDX);
 }
 
-void D3D11GraphicsPipeline1::CreateRasterizerState(ID3D11Device1* device, const RasterizerDescriptor& desc)
+void D3D11GraphicsPipeline1::CreateRasterizerState(ID3D11Device1* device, D3D11StateObjectCache& stateCache, const RasterizerDescriptor& desc)
 {
     D3D11_RASTERIZER_DESC descDX;
+    InitMemory(descDX);
     D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateRasterizerState(&descDX, rasterizerState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+    rasterizerState_ = stateCache.CreateRasterizerState(device, descDX);
 }
 
-void D3D11GraphicsPipeline1::CreateBlendState(ID3D11Device1* device, const BlendDescriptor& desc)
+void D3D11GraphicsPipeline1::CreateBlendState(ID3D11Device1* device, D3D11StateObjectCache& stateCache, const BlendDescriptor& desc)
 {
     D3D11_BLEND_DESC1 descDX;
+    InitMemory(descDX);
     D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateBlendState1(&descDX, blendState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+    blendState_ = stateCache.CreateBlendState1(device, descDX);
 }
 
 
@@ -12,6 +12,7 @@
 
 
 #include "D3D11GraphicsPipelineBase.h"
+#include "D3D11StateObjectCache.h"
 #include <d3d11_3.h>
 
 
@@ -27,6 +28,7 @@ class D3D11GraphicsPipeline3 final : public D3D11GraphicsPipelineBase
 
         D3D11GraphicsPipeline3(
             ID3D11Device3* device,
+            D3D11StateObjectCache& stateCache,
             const GraphicsPipelineDescriptor& desc
         );
 
@@ -34,9 +36,9 @@ class D3D11GraphicsPipeline3 final : public D3D11GraphicsPipelineBase
 
     private:
 
-        void CreateDepthStencilState(ID3D11Device3* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
-        void CreateRasterizerState(ID3D11Device3* device, const RasterizerDescriptor& desc);
-        void CreateBlendState(ID3D11Device3* device, const BlendDescriptor& desc);
+        void CreateDepthStencilState(ID3D11Device3* device, D3D11StateObjectCache& stateCache, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
+        void CreateRasterizerState(ID3D11Device3* device, D3D11StateObjectCache& stateCache, const RasterizerDescriptor& desc);
+        void CreateBlendState(ID3D11Device3* device, D3D11StateObjectCache& stateCache, const BlendDescriptor& desc);
 
         ComPtr<ID3D11DepthStencilState> depthStencilState_;
         ComPtr<ID3D11RasterizerState2>  rasterizerState_;
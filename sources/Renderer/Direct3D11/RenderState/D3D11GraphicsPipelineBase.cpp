@@ -7,6 +7,7 @@
 
 #include "D3D11GraphicsPipelineBase.h"
 #include "D3D11StateManager.h"
+#include "D3D11PipelineLayout.h"
 #include "../D3D11Types.h"
 #include "../Shader/D3D11ShaderProgram.h"
 #include "../Shader/D3D11Shader.h"
@@ -62,6 +63,24 @@ D3D11GraphicsPipelineBase::D3D11GraphicsPipelineBase(const GraphicsPipelineDescr
     blendFactor_[1] = desc.blend.blendFactor.g;
     blendFactor_[2] = desc.blend.blendFactor.b;
     blendFactor_[3] = desc.blend.blendFactor.a;
+
+    /* Store which of these states are set with the command buffer */
+    stencilRefDynamic_  = ((desc.dynamicStates & DynamicStateFlags::StencilReference) != 0);
+    blendFactorDynamic_ = ((desc.dynamicStates & DynamicStateFlags::BlendFactor) != 0);
+
+    /* Store layout of constants */
+    if (auto pipelineLayoutD3D = LLGL_CAST(D3D11PipelineLayout*, desc.pipelineLayout))
+        constants_ = pipelineLayoutD3D->GetConstants();
+}
+
+UINT D3D11GraphicsPipelineBase::GetStencilRef(const D3D11StateManager& stateMngr) const
+{
+    return (stencilRefDynamic_ ? stateMngr.GetStencilRef() : stencilRef_);
+}
+
+const FLOAT* D3D11GraphicsPipelineBase::GetBlendFactor(const D3D11StateManager& stateMngr) const
+{
+    return (blendFactorDynamic_ ? stateMngr.GetBlendFactor() : blendFactor_);
 }
 
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/GraphicsPipeline.h>
 #include <LLGL/ForwardDecls.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d11.h>
 
@@ -30,6 +31,12 @@ class D3D11GraphicsPipelineBase : public GraphicsPipeline
         // Binds the input layout, primitive topology, and all shader stages.
         virtual void Bind(D3D11StateManager& stateMngr);
 
+        // Returns the layout of the constants from the pipeline layout.
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
     protected:
 
         D3D11GraphicsPipelineBase(const GraphicsPipelineDescriptor& desc);
@@ -40,17 +47,11 @@ class D3D11GraphicsPipelineBase : public GraphicsPipeline
             return primitiveTopology_;
         }
 
-        // Returns the stencil reference value used for the 'OMSetDepthStencilState' function.
-        inline UINT GetStencilRef() const
-        {
-            return stencilRef_;
-        }
+        // Returns the stencil reference value used for the 'OMSetDepthStencilState' function, or the current value of the state manager if it is a dynamic state.
+        UINT GetStencilRef(const D3D11StateManager& stateMngr) const;
 
-        // Returns the pointer to an array of 4 floating-points for the blending factor for the 'OMSetBlendState' function.
-        inline const FLOAT* GetBlendFactor() const
-        {
-            return blendFactor_;
-        }
+        // Returns the pointer to an array of 4 floating-points for the blending factor for the 'OMSetBlendState' function, or the current value of the state manager if it is a dynamic state.
+        const FLOAT* GetBlendFactor(const D3D11StateManager& stateMngr) const;
 
         // Returns the 32-bit sample mask for the 'OMSetBlendState' function.
         inline UINT GetSampleMask() const
@@ -74,6 +75,10 @@ class D3D11GraphicsPipelineBase : public GraphicsPipeline
         UINT                            stencilRef_         = 0;
         FLOAT                           blendFactor_[4]     = { 0.0f, 0.0f, 0.0f, 0.0f };
         UINT                            sampleMask_         = ~0;
+        bool                            stencilRefDynamic_  = false;
+        bool                            blendFactorDynamic_ = false;
+
+        ConstantsDescriptor             constants_;
 
 };
 
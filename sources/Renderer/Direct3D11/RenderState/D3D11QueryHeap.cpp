@@ -0,0 +1,80 @@
+/*
+ * D3D11QueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11QueryHeap.h"
+#include "../../DXCommon/DXCore.h"
+
+
+namespace LLGL
+{
+
+
+D3D11QueryHeap::D3D11QueryHeap(ID3D11Device* device, const QueryHeapDescriptor& desc) :
+    QueryHeap { desc }
+{
+    /* D3D11 has no native query heaps, so create all occlusion queries individually */
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_OCCLUSION;
+        queryDesc.MiscFlags = 0;
+    }
+
+    queries_.resize(desc.numQueries);
+
+    if (desc.type == QueryType::SamplesPassed)
+    {
+        for (auto& query : queries_)
+        {
+            auto hr = device->CreateQuery(&queryDesc, query.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 query for query heap");
+        }
+    }
+    else
+    {
+        /* Create occlusion predicates for boolean results, so they can also be used as render conditions */
+        queryDesc.Query = D3D11_QUERY_OCCLUSION_PREDICATE;
+
+        predicates_.resize(desc.numQueries);
+
+        for (std::size_t i = 0; i < predicates_.size(); ++i)
+        {
+            auto hr = device->CreatePredicate(&queryDesc, predicates_[i].ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 predicate for query heap");
+            queries_[i] = predicates_[i];
+        }
+    }
+}
+
+bool D3D11QueryHeap::GetResult(ID3D11DeviceContext* context, std::uint32_t query, std::uint64_t& result) const
+{
+    if (!predicates_.empty())
+    {
+        /* Occlusion predicates return a boolean result */
+        BOOL data = FALSE;
+        if (context->GetData(predicates_[query].Get(), &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK)
+        {
+            result = (data != FALSE ? 1 : 0);
+            return true;
+        }
+        return false;
+    }
+
+    UINT64 data = 0;
+    if (context->GetData(queries_[query].Get(), &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK)
+    {
+        result = data;
+        return true;
+    }
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,58 @@
+/*
+ * D3D11QueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_QUERY_HEAP_H
+#define LLGL_D3D11_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class D3D11QueryHeap final : public QueryHeap
+{
+
+    public:
+
+        D3D11QueryHeap(ID3D11Device* device, const QueryHeapDescriptor& desc);
+
+        // Retrieves the result of the specified query without flushing the command buffer. Returns false if the result is not available yet.
+        bool GetResult(ID3D11DeviceContext* context, std::uint32_t query, std::uint64_t& result) const;
+
+        inline ID3D11Query* GetQueryObject(std::uint32_t query) const
+        {
+            return queries_[query].Get();
+        }
+
+        // Returns the predicate of the specified query, or null if this heap has type QueryType::SamplesPassed.
+        inline ID3D11Predicate* GetPredicateObject(std::uint32_t query) const
+        {
+            return (predicates_.empty() ? nullptr : predicates_[query].Get());
+        }
+
+    private:
+
+        std::vector<ComPtr<ID3D11Query>>        queries_;
+        std::vector<ComPtr<ID3D11Predicate>>    predicates_;    // Only used for the 'AnySamplesPassed' query types
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "D3D11ResourceHeap.h"
 #include "D3D11PipelineLayout.h"
+#include "D3D11StateManager.h"
 #include "../Buffer/D3D11Buffer.h"
 #include "../Texture/D3D11Sampler.h"
 #include "../Texture/D3D11Texture.h"
@@ -90,9 +91,6 @@ struct D3DResourceBinding
 
 D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc)
 {
-    /* Initialize segmentation header */
-    InitMemory(segmentationHeader_);
-
     /* Get pipeline layout object */
     auto pipelineLayoutD3D = LLGL_CAST(D3D11PipelineLayout*, desc.pipelineLayout);
     if (!pipelineLayoutD3D)
@@ -100,11 +98,60 @@ D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc)
 
     /* Validate binding descriptors */
     const auto& bindings = pipelineLayoutD3D->GetBindings();
-    if (desc.resourceViews.size() != bindings.size())
+    if (desc.resourceViews.size() != ResourceBindingIterator::GetNumResourceViews(bindings))
         throw std::invalid_argument("failed to create resource heap due to mismatch between number of resources and bindings");
 
+    /* Build buffer segments */
+    resourceViews_  = desc.resourceViews;
+    bindings_       = bindings;
+    BuildSegments();
+}
+
+void D3D11ResourceHeap::BindForGraphicsPipeline(D3D11StateManager& stateMngr, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    auto byteAlignedBuffer = buffer_.data();
+    if (segmentationHeader_.hasVSResources) { BindVSResources(stateMngr, byteAlignedBuffer); }
+    if (segmentationHeader_.hasHSResources) { BindHSResources(stateMngr, byteAlignedBuffer); }
+    if (segmentationHeader_.hasDSResources) { BindDSResources(stateMngr, byteAlignedBuffer); }
+    if (segmentationHeader_.hasGSResources) { BindGSResources(stateMngr, byteAlignedBuffer); }
+    if (segmentationHeader_.hasPSResources) { BindPSResources(stateMngr, byteAlignedBuffer); }
+    if (!dynamicBuffers_.empty()) { BindDynamicConstantBuffers(stateMngr, ~StageFlags::ComputeStage, numDynamicOffsets, dynamicOffsets); }
+}
+
+void D3D11ResourceHeap::BindForComputePipeline(D3D11StateManager& stateMngr, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    auto byteAlignedBuffer = buffer_.data();
+    byteAlignedBuffer += bufferOffsetCS_;
+    if (segmentationHeader_.hasCSResources) { BindCSResources(stateMngr, byteAlignedBuffer); }
+    if (!dynamicBuffers_.empty()) { BindDynamicConstantBuffers(stateMngr, StageFlags::ComputeStage, numDynamicOffsets, dynamicOffsets); }
+}
+
+void D3D11ResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (static_cast<std::size_t>(firstDescriptor) + numResourceViews > resourceViews_.size())
+        throw std::out_of_range("resource views out of range for resource heap update");
+
+    /* Replace resource views */
+    std::copy(resourceViews, resourceViews + numResourceViews, resourceViews_.begin() + firstDescriptor);
+
+    /* Rebuild all segments, since they are tightly packed and their layout depends on the resources (e.g. SRVs and UAVs of storage buffers) */
+    buffer_.clear();
+    dynamicBuffers_.clear();
+    BuildSegments();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11ResourceHeap::BuildSegments()
+{
+    /* Initialize segmentation header */
+    InitMemory(segmentationHeader_);
+
     /* Build buffer segments (stage after stage, so the internal buffer is constructed in the correct order) */
-    ResourceBindingIterator resourceIterator { desc.resourceViews, bindings };
+    ResourceBindingIterator resourceIterator { resourceViews_, bindings_ };
 
     BuildSegmentsForStage(resourceIterator, StageFlags::VertexStage);
     BuildSegmentsForStage(resourceIterator, StageFlags::TessControlStage);
@@ -119,38 +166,19 @@ D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc)
     bufferOffsetCS_ = static_cast<std::uint16_t>(buffer_.size());
     BuildSegmentsForStage(resourceIterator, StageFlags::ComputeStage);
 
-    StoreResourceUsage();
-}
-
-void D3D11ResourceHeap::BindForGraphicsPipeline(ID3D11DeviceContext* context)
-{
-    auto byteAlignedBuffer = buffer_.data();
-    if (segmentationHeader_.hasVSResources) { BindVSResources(context, byteAlignedBuffer); }
-    if (segmentationHeader_.hasHSResources) { BindHSResources(context, byteAlignedBuffer); }
-    if (segmentationHeader_.hasDSResources) { BindDSResources(context, byteAlignedBuffer); }
-    if (segmentationHeader_.hasGSResources) { BindGSResources(context, byteAlignedBuffer); }
-    if (segmentationHeader_.hasPSResources) { BindPSResources(context, byteAlignedBuffer); }
-}
+    BuildDynamicConstantBuffers(resourceIterator);
 
-void D3D11ResourceHeap::BindForComputePipeline(ID3D11DeviceContext* context)
-{
-    auto byteAlignedBuffer = buffer_.data();
-    byteAlignedBuffer += bufferOffsetCS_;
-    if (segmentationHeader_.hasCSResources) { BindCSResources(context, byteAlignedBuffer); }
+    StoreResourceUsage();
 }
 
-
-/*
- * ======= Private: =======
- */
-
 using D3DResourceBindingFunc = std::function<D3DResourceBinding(Resource* resource, std::uint32_t slot, long stageFlags)>;
 
 static std::vector<D3DResourceBinding> CollectD3DResourceBindings(
     ResourceBindingIterator&        resourceIterator,
     const ResourceType              resourceType,
     long                            affectedStage,
-    const D3DResourceBindingFunc&   resourceFunc)
+    const D3DResourceBindingFunc&   resourceFunc,
+    long                            ignoredBindingFlags = 0)
 {
     /* Collect all binding points of the specified resource type */
     BindingDescriptor bindingDesc;
@@ -160,7 +188,10 @@ static std::vector<D3DResourceBinding> CollectD3DResourceBindings(
     resourceBindings.reserve(resourceIterator.GetCount());
 
     while (auto resource = resourceIterator.Next(bindingDesc))
-        resourceBindings.push_back(resourceFunc(resource, bindingDesc.slot, bindingDesc.stageFlags));
+    {
+        if ((bindingDesc.flags & ignoredBindingFlags) == 0)
+            resourceBindings.push_back(resourceFunc(resource, bindingDesc.slot, bindingDesc.stageFlags));
+    }
 
     /* Sort resources by slot index */
     std::sort(
@@ -184,7 +215,7 @@ void D3D11ResourceHeap::BuildSegmentsForStage(ResourceBindingIterator& resourceI
 
 void D3D11ResourceHeap::BuildConstantBufferSegments(ResourceBindingIterator& resourceIterator, long stage)
 {
-    /* Collect all constant buffers */
+    /* Collect all constant buffers (except the ones that are bound with a dynamic offset) */
     auto resourceBindings = CollectD3DResourceBindings(
         resourceIterator,
         ResourceType::ConstantBuffer,
@@ -199,7 +230,8 @@ void D3D11ResourceHeap::BuildConstantBufferSegments(ResourceBindingIterator& res
                 resourceBinding.buffer  = bufferD3D->GetNative();
             }
             return resourceBinding;
-        }
+        },
+        BindingFlags::DynamicOffset
     );
 
     /* Build all resource segments for type <D3DResourceViewHeapSegment1> */
@@ -292,6 +324,38 @@ void D3D11ResourceHeap::BuildSamplerSegments(ResourceBindingIterator& resourceIt
     }
 }
 
+void D3D11ResourceHeap::BuildDynamicConstantBuffers(ResourceBindingIterator& resourceIterator)
+{
+    /* Collect all constant buffers that are bound with a dynamic offset */
+    BindingDescriptor bindingDesc;
+    resourceIterator.Reset(ResourceType::ConstantBuffer);
+
+    while (auto resource = resourceIterator.Next(bindingDesc))
+    {
+        if ((bindingDesc.flags & BindingFlags::DynamicOffset) != 0)
+        {
+            auto bufferD3D = LLGL_CAST(D3D11Buffer*, resource);
+            D3DDynamicBuffer dynamicBuffer;
+            {
+                dynamicBuffer.slot          = bindingDesc.slot;
+                dynamicBuffer.stages        = bindingDesc.stageFlags;
+                dynamicBuffer.buffer        = bufferD3D->GetNative();
+                dynamicBuffer.numConstants  = ((bindingDesc.dynamicRangeSize + 255u) / 256u) * 16u;
+            }
+            dynamicBuffers_.push_back(dynamicBuffer);
+        }
+    }
+
+    /* Sort buffers by slot index, since the dynamic offsets are specified in that order */
+    std::sort(
+        dynamicBuffers_.begin(), dynamicBuffers_.end(),
+        [](const D3DDynamicBuffer& lhs, const D3DDynamicBuffer& rhs)
+        {
+            return (lhs.slot < rhs.slot);
+        }
+    );
+}
+
 void D3D11ResourceHeap::BuildAllSegments(
     const std::vector<D3DResourceBinding>&  resourceBindings,
     const BuildSegmentFunc&                 buildSegmentFunc,
@@ -422,13 +486,13 @@ void D3D11ResourceHeap::StoreResourceUsage()
     #undef LLGL_STORE_STAGE_RESOURCE_USAGE
 }
 
-void D3D11ResourceHeap::BindVSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindVSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numVSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->VSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::VertexStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -436,7 +500,7 @@ void D3D11ResourceHeap::BindVSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numVSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->VSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::VertexStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -444,18 +508,18 @@ void D3D11ResourceHeap::BindVSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numVSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->VSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::VertexStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
-void D3D11ResourceHeap::BindHSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindHSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numHSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->HSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::TessControlStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -463,7 +527,7 @@ void D3D11ResourceHeap::BindHSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numHSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->HSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::TessControlStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -471,18 +535,18 @@ void D3D11ResourceHeap::BindHSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numHSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->HSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::TessControlStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
-void D3D11ResourceHeap::BindDSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindDSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numDSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->DSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::TessEvaluationStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -490,7 +554,7 @@ void D3D11ResourceHeap::BindDSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numDSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->DSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::TessEvaluationStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -498,18 +562,18 @@ void D3D11ResourceHeap::BindDSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numDSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->DSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::TessEvaluationStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
-void D3D11ResourceHeap::BindGSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindGSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numGSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->GSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::GeometryStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -517,7 +581,7 @@ void D3D11ResourceHeap::BindGSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numGSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->GSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::GeometryStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -525,18 +589,18 @@ void D3D11ResourceHeap::BindGSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numGSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->GSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::GeometryStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
-void D3D11ResourceHeap::BindPSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindPSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numPSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->PSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::FragmentStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -544,7 +608,7 @@ void D3D11ResourceHeap::BindPSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numPSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->PSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::FragmentStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -552,7 +616,7 @@ void D3D11ResourceHeap::BindPSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numPSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->PSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::FragmentStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -560,26 +624,24 @@ void D3D11ResourceHeap::BindPSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numPSUnorderedAccessViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment2*>(byteAlignedBuffer);
-        context->OMSetRenderTargetsAndUnorderedAccessViews(
-            D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL,
-            nullptr,
-            nullptr,
+        stateMngr.SetUnorderedAccessViews(
             segment->startSlot,
             segment->numViews,
             reinterpret_cast<ID3D11UnorderedAccessView* const*>(byteAlignedBuffer + sizeof(D3DResourceViewHeapSegment2)),
-            reinterpret_cast<const UINT*>(byteAlignedBuffer + segment->offsetEnd0)
+            reinterpret_cast<const UINT*>(byteAlignedBuffer + segment->offsetEnd0),
+            StageFlags::FragmentStage
         );
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
-void D3D11ResourceHeap::BindCSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer)
+void D3D11ResourceHeap::BindCSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     /* Bind all constant buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numCSConstantBufferSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->CSSetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer));
+        stateMngr.SetConstantBuffers(segment->startSlot, segment->numViews, CastToD3D11Buffers(byteAlignedBuffer), StageFlags::ComputeStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -587,7 +649,7 @@ void D3D11ResourceHeap::BindCSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numCSSamplerSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->CSSetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer));
+        stateMngr.SetSamplers(segment->startSlot, segment->numViews, CastToD3D11SamplerStates(byteAlignedBuffer), StageFlags::ComputeStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -595,7 +657,7 @@ void D3D11ResourceHeap::BindCSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numCSShaderResourceViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment1*>(byteAlignedBuffer);
-        context->CSSetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer));
+        stateMngr.SetShaderResources(segment->startSlot, segment->numViews, CastToD3D11ShaderResourceViews(byteAlignedBuffer), StageFlags::ComputeStage);
         byteAlignedBuffer += segment->segmentSize;
     }
 
@@ -603,16 +665,29 @@ void D3D11ResourceHeap::BindCSResources(ID3D11DeviceContext* context, std::int8_
     for (std::uint8_t i = 0; i < segmentationHeader_.numCSUnorderedAccessViewSegments; ++i)
     {
         auto segment = reinterpret_cast<const D3DResourceViewHeapSegment2*>(byteAlignedBuffer);
-        context->CSSetUnorderedAccessViews(
+        stateMngr.SetUnorderedAccessViews(
             segment->startSlot,
             segment->numViews,
             reinterpret_cast<ID3D11UnorderedAccessView* const*>(byteAlignedBuffer + sizeof(D3DResourceViewHeapSegment2)),
-            reinterpret_cast<const UINT*>(byteAlignedBuffer + segment->offsetEnd0)
+            reinterpret_cast<const UINT*>(byteAlignedBuffer + segment->offsetEnd0),
+            StageFlags::ComputeStage
         );
         byteAlignedBuffer += segment->segmentSize;
     }
 }
 
+void D3D11ResourceHeap::BindDynamicConstantBuffers(D3D11StateManager& stateMngr, long affectedStages, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    /* Bind all constant buffers with dynamic offsets (missing offsets are treated as zero) */
+    for (std::size_t i = 0; i < dynamicBuffers_.size(); ++i)
+    {
+        const auto& dynamicBuffer = dynamicBuffers_[i];
+        const auto offset = (i < numDynamicOffsets ? dynamicOffsets[i] : 0u);
+        if (auto stages = (dynamicBuffer.stages & affectedStages))
+            stateMngr.SetConstantBufferRange(dynamicBuffer.slot, dynamicBuffer.buffer, offset / 16u, dynamicBuffer.numConstants, stages);
+    }
+}
+
 
 } // /namespace LLGL
 
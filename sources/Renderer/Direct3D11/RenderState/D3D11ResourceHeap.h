@@ -11,6 +11,8 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include <vector>
 #include <functional>
 #include <d3d11.h>
@@ -21,6 +23,7 @@ namespace LLGL
 
 
 class ResourceBindingIterator;
+class D3D11StateManager;
 struct D3DResourceBinding;
 
 /*
@@ -34,19 +37,24 @@ class D3D11ResourceHeap final : public ResourceHeap
 
         D3D11ResourceHeap(const ResourceHeapDescriptor& desc);
 
-        void BindForGraphicsPipeline(ID3D11DeviceContext* context);
-        void BindForComputePipeline(ID3D11DeviceContext* context);
+        void BindForGraphicsPipeline(D3D11StateManager& stateMngr, std::uint32_t numDynamicOffsets = 0, const std::uint32_t* dynamicOffsets = nullptr);
+        void BindForComputePipeline(D3D11StateManager& stateMngr, std::uint32_t numDynamicOffsets = 0, const std::uint32_t* dynamicOffsets = nullptr);
+
+        // Replaces the specified resource views, starting at the view with index 'firstDescriptor', and rebuilds the binding segments.
+        void WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews);
 
     private:
 
         using D3DResourceBindingIter = std::vector<D3DResourceBinding>::const_iterator;
         using BuildSegmentFunc = std::function<void(D3DResourceBindingIter begin, UINT count)>;
 
+        void BuildSegments();
         void BuildSegmentsForStage(ResourceBindingIterator& resourceIterator, long stage);
         void BuildConstantBufferSegments(ResourceBindingIterator& resourceIterator, long stage);
         void BuildShaderResourceViewSegments(ResourceBindingIterator& resourceIterator, long stage);
         void BuildUnorderedAccessViewSegments(ResourceBindingIterator& resourceIterator, long stage);
         void BuildSamplerSegments(ResourceBindingIterator& resourceIterator, long stage);
+        void BuildDynamicConstantBuffers(ResourceBindingIterator& resourceIterator);
 
         void BuildAllSegments(
             const std::vector<D3DResourceBinding>&  resourceBindings,
@@ -66,12 +74,14 @@ class D3D11ResourceHeap final : public ResourceHeap
 
         void StoreResourceUsage();
 
-        void BindVSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
-        void BindHSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
-        void BindDSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
-        void BindGSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
-        void BindPSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
-        void BindCSResources(ID3D11DeviceContext* context, std::int8_t*& byteAlignedBuffer);
+        void BindVSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+        void BindHSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+        void BindDSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+        void BindGSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+        void BindPSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+        void BindCSResources(D3D11StateManager& stateMngr, std::int8_t*& byteAlignedBuffer);
+
+        void BindDynamicConstantBuffers(D3D11StateManager& stateMngr, long affectedStages, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
 
         /*
         Header structure to describe all segments within the raw buffer.
@@ -115,9 +125,23 @@ class D3D11ResourceHeap final : public ResourceHeap
             std::uint8_t numCSShaderResourceViewSegments;
         };
 
-        SegmentationHeader          segmentationHeader_;
-        std::uint16_t               bufferOffsetCS_         = 0;
-        std::vector<std::int8_t>    buffer_;
+        // Constant buffer that is bound with a dynamic offset.
+        struct D3DDynamicBuffer
+        {
+            UINT            slot;
+            long            stages;
+            ID3D11Buffer*   buffer;
+            UINT            numConstants;   // Range size in units of 16-byte shader constants
+        };
+
+        SegmentationHeader              segmentationHeader_;
+        std::uint16_t                   bufferOffsetCS_         = 0;
+        std::vector<std::int8_t>        buffer_;
+        std::vector<D3DDynamicBuffer>   dynamicBuffers_;        // Sorted by slot index
+
+        // Resource views and bindings the segments are built from, so they can be rebuilt after in-place updates.
+        std::vector<ResourceViewDescriptor> resourceViews_;
+        std::vector<BindingDescriptor>      bindings_;
 
 };
 
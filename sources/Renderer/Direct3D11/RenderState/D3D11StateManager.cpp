@@ -6,6 +6,7 @@
  */
 
 #include "D3D11StateManager.h"
+#include <LLGL/ShaderFlags.h>
 #include <algorithm>
 #include <cstddef>
 
@@ -14,9 +15,30 @@ namespace LLGL
 {
 
 
+const UINT D3D11StateManager::numGraphicsStages_;
+const UINT D3D11StateManager::numStages_;
+const UINT D3D11StateManager::graphicsStagesMask_;
+const UINT D3D11StateManager::computeStagesMask_;
+
 D3D11StateManager::D3D11StateManager(ComPtr<ID3D11DeviceContext>& context) :
     context_ { context }
 {
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    /* Query extended device context for constant buffer ranges (optional) */
+    context_->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(context1_.ReleaseAndGetAddressOf()));
+
+    if (context1_)
+    {
+        /* Constant buffer ranges also require driver support for constant buffer offsetting */
+        ComPtr<ID3D11Device> device;
+        context_->GetDevice(device.ReleaseAndGetAddressOf());
+
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        auto hr = device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+        if (FAILED(hr) || !options.ConstantBufferOffsetting)
+            context1_.Reset();
+    }
+    #endif
 }
 
 void D3D11StateManager::SetViewports(std::uint32_t numViewports, const Viewport* viewportArray)
@@ -193,6 +215,366 @@ void D3D11StateManager::SetBlendState(ID3D11BlendState* blendState, const FLOAT*
     }
 }
 
+void D3D11StateManager::SetStencilRef(UINT stencilRef)
+{
+    SetDepthStencilState(renderState_.depthStencilState, stencilRef);
+}
+
+void D3D11StateManager::SetBlendFactor(const FLOAT* blendFactor)
+{
+    SetBlendState(renderState_.blendState, blendFactor, renderState_.sampleMask);
+}
+
+
+/* ----- Resource bindings ----- */
+
+// Shader stage flags in the order of the internal stage indices.
+static const long g_stageFlagsOrder[] =
+{
+    StageFlags::VertexStage,
+    StageFlags::TessControlStage,
+    StageFlags::TessEvaluationStage,
+    StageFlags::GeometryStage,
+    StageFlags::FragmentStage,
+    StageFlags::ComputeStage,
+};
+
+// Device context functions for each shader stage, in the order of the internal stage indices.
+struct D3DStageFunctions
+{
+    void (STDMETHODCALLTYPE ID3D11DeviceContext::*setConstantBuffers)(UINT, UINT, ID3D11Buffer* const*);
+    void (STDMETHODCALLTYPE ID3D11DeviceContext::*setShaderResources)(UINT, UINT, ID3D11ShaderResourceView* const*);
+    void (STDMETHODCALLTYPE ID3D11DeviceContext::*setSamplers)(UINT, UINT, ID3D11SamplerState* const*);
+};
+
+static const D3DStageFunctions g_stageFunctions[] =
+{
+    { &ID3D11DeviceContext::VSSetConstantBuffers, &ID3D11DeviceContext::VSSetShaderResources, &ID3D11DeviceContext::VSSetSamplers },
+    { &ID3D11DeviceContext::HSSetConstantBuffers, &ID3D11DeviceContext::HSSetShaderResources, &ID3D11DeviceContext::HSSetSamplers },
+    { &ID3D11DeviceContext::DSSetConstantBuffers, &ID3D11DeviceContext::DSSetShaderResources, &ID3D11DeviceContext::DSSetSamplers },
+    { &ID3D11DeviceContext::GSSetConstantBuffers, &ID3D11DeviceContext::GSSetShaderResources, &ID3D11DeviceContext::GSSetSamplers },
+    { &ID3D11DeviceContext::PSSetConstantBuffers, &ID3D11DeviceContext::PSSetShaderResources, &ID3D11DeviceContext::PSSetSamplers },
+    { &ID3D11DeviceContext::CSSetConstantBuffers, &ID3D11DeviceContext::CSSetShaderResources, &ID3D11DeviceContext::CSSetSamplers },
+};
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+// Extended device context functions to bind constant buffer ranges, in the order of the internal stage indices.
+using D3DSetConstantBuffers1Func = void (STDMETHODCALLTYPE ID3D11DeviceContext1::*)(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*);
+
+static const D3DSetConstantBuffers1Func g_stageSetConstantBuffers1[] =
+{
+    &ID3D11DeviceContext1::VSSetConstantBuffers1,
+    &ID3D11DeviceContext1::HSSetConstantBuffers1,
+    &ID3D11DeviceContext1::DSSetConstantBuffers1,
+    &ID3D11DeviceContext1::GSSetConstantBuffers1,
+    &ID3D11DeviceContext1::PSSetConstantBuffers1,
+    &ID3D11DeviceContext1::CSSetConstantBuffers1,
+};
+
+#endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+// Extends the specified dirty range by the specified slot.
+template <typename TRange>
+static void ExtendDirtyRange(TRange& range, UINT slot)
+{
+    if (range.begin < range.end)
+    {
+        range.begin = std::min(range.begin, slot);
+        range.end   = std::max(range.end, slot + 1);
+    }
+    else
+    {
+        range.begin = slot;
+        range.end   = slot + 1;
+    }
+}
+
+// Stores the specified objects as pending bindings and returns true if any of them differs from the submitted bindings.
+template <typename TSlots, typename T>
+static bool StorePendingBindings(TSlots& slots, UINT maxSlots, UINT startSlot, UINT count, T* const* objects)
+{
+    bool modified = false;
+
+    for (UINT i = 0; i < count && startSlot + i < maxSlots; ++i)
+    {
+        const auto slot = startSlot + i;
+        slots.pending[slot] = objects[i];
+
+        if (slots.bound[slot] != objects[i])
+        {
+            ExtendDirtyRange(slots.dirtyRange, slot);
+            modified = true;
+        }
+
+        slots.numUsed = std::max(slots.numUsed, slot + 1);
+    }
+
+    return modified;
+}
+
+// Submits the dirty range of pending bindings with a single call to the specified device context function.
+template <typename TSlots, typename TFunc>
+static void SubmitPendingBindings(ID3D11DeviceContext* context, TSlots& slots, TFunc func)
+{
+    auto& range = slots.dirtyRange;
+    if (range.begin < range.end)
+    {
+        (context->*func)(range.begin, range.end - range.begin, slots.pending + range.begin);
+        std::copy(slots.pending + range.begin, slots.pending + range.end, slots.bound + range.begin);
+        range.begin = 0;
+        range.end   = 0;
+    }
+}
+
+void D3D11StateManager::SetConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags)
+{
+    for (UINT stage = 0; stage < numStages_; ++stage)
+    {
+        if ((stageFlags & g_stageFlagsOrder[stage]) != 0)
+        {
+            auto& bindings  = stageBindings_[stage];
+            auto& slots     = bindings.constantBuffers;
+            auto  modified  = StorePendingBindings(slots, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, startSlot, count, buffers);
+
+            /* Reset ranges, so slots that were bound with a range are bound with the entire buffer again */
+            for (UINT i = 0; i < count && startSlot + i < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT; ++i)
+            {
+                const auto slot = startSlot + i;
+                bindings.pendingConstantBufferRanges[slot] = D3DConstantBufferRange{};
+                if (bindings.boundConstantBufferRanges[slot].numConstants != 0)
+                {
+                    ExtendDirtyRange(slots.dirtyRange, slot);
+                    modified = true;
+                }
+            }
+
+            if (modified)
+                dirtyStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::SetConstantBufferRange(UINT slot, ID3D11Buffer* buffer, UINT firstConstant, UINT numConstants, long stageFlags)
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (context1_ && slot < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT)
+    {
+        for (UINT stage = 0; stage < numStages_; ++stage)
+        {
+            if ((stageFlags & g_stageFlagsOrder[stage]) != 0)
+            {
+                auto& bindings  = stageBindings_[stage];
+                auto& slots     = bindings.constantBuffers;
+                auto& range     = bindings.pendingConstantBufferRanges[slot];
+
+                slots.pending[slot] = buffer;
+                range.firstConstant = firstConstant;
+                range.numConstants  = numConstants;
+
+                const auto& boundRange = bindings.boundConstantBufferRanges[slot];
+                if (slots.bound[slot] != buffer || boundRange.firstConstant != firstConstant || boundRange.numConstants != numConstants)
+                {
+                    ExtendDirtyRange(slots.dirtyRange, slot);
+                    dirtyStages_ |= (1u << stage);
+                }
+
+                slots.numUsed = std::max(slots.numUsed, slot + 1);
+            }
+        }
+        return;
+    }
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+    /* Fall back to binding the entire buffer */
+    SetConstantBuffers(slot, 1, &buffer, stageFlags);
+}
+
+bool D3D11StateManager::HasConstantBufferRanges() const
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    return (context1_ != nullptr);
+    #else
+    return false;
+    #endif
+}
+
+void D3D11StateManager::SetShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags)
+{
+    for (UINT stage = 0; stage < numStages_; ++stage)
+    {
+        if ((stageFlags & g_stageFlagsOrder[stage]) != 0)
+        {
+            auto& slots = stageBindings_[stage].shaderResourceViews;
+            if (StorePendingBindings(slots, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, startSlot, count, views))
+                dirtyStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::SetSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags)
+{
+    for (UINT stage = 0; stage < numStages_; ++stage)
+    {
+        if ((stageFlags & g_stageFlagsOrder[stage]) != 0)
+        {
+            auto& slots = stageBindings_[stage].samplers;
+            if (StorePendingBindings(slots, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, startSlot, count, samplers))
+                dirtyStages_ |= (1u << stage);
+        }
+    }
+}
+
+static bool HasInitialCounts(UINT count, const UINT* initialCounts)
+{
+    if (initialCounts != nullptr)
+    {
+        for (UINT i = 0; i < count; ++i)
+        {
+            if (initialCounts[i] != static_cast<UINT>(-1))
+                return true;
+        }
+    }
+    return false;
+}
+
+void D3D11StateManager::SetUnorderedAccessViews(
+    UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long stageFlags)
+{
+    if ((stageFlags & StageFlags::FragmentStage) != 0)
+    {
+        /* Set UAVs for pixel shader stage (shares binding points with render targets, so it's not deferred) */
+        context_->OMSetRenderTargetsAndUnorderedAccessViews(
+            D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr,
+            startSlot, count, views, initialCounts
+        );
+        InvalidateShaderResources();
+    }
+
+    if ((stageFlags & StageFlags::ComputeStage) != 0)
+    {
+        if (HasInitialCounts(count, initialCounts) || startSlot + count > D3D11_PS_CS_UAV_REGISTER_COUNT)
+        {
+            /* Set UAVs for compute shader stage immediately, since counters must be reset even for redundant bindings */
+            FlushComputeUAVs();
+            context_->CSSetUnorderedAccessViews(startSlot, count, views, initialCounts);
+            for (UINT i = 0; i < count && startSlot + i < D3D11_PS_CS_UAV_REGISTER_COUNT; ++i)
+            {
+                computeUAVs_.pending[startSlot + i] = views[i];
+                computeUAVs_.bound[startSlot + i]   = views[i];
+            }
+            InvalidateShaderResources();
+        }
+        else if (StorePendingBindings(computeUAVs_, D3D11_PS_CS_UAV_REGISTER_COUNT, startSlot, count, views))
+            dirtyStages_ |= computeStagesMask_;
+    }
+}
+
+void D3D11StateManager::SetUnorderedAccessViewCounter(ID3D11UnorderedAccessView* view, UINT value)
+{
+    /* Bind UAV with initial count to the first compute slot and restore the previous binding without changing its counter */
+    FlushComputeUAVs();
+    context_->CSSetUnorderedAccessViews(0, 1, &view, &value);
+    context_->CSSetUnorderedAccessViews(0, 1, &(computeUAVs_.bound[0]), nullptr);
+    InvalidateShaderResources();
+}
+
+void D3D11StateManager::InvalidateShaderResources()
+{
+    for (UINT stage = 0; stage < numStages_; ++stage)
+    {
+        auto& slots = stageBindings_[stage].shaderResourceViews;
+        if (slots.numUsed > 0)
+        {
+            slots.dirtyRange.begin  = 0;
+            slots.dirtyRange.end    = slots.numUsed;
+            dirtyStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::ResetCache()
+{
+    inputAssemblyState_ = D3DInputAssemblyState{};
+    shaderState_        = D3DShaderState{};
+    renderState_        = D3DRenderState{};
+
+    for (auto& bindings : stageBindings_)
+        bindings = D3DStageBindings{};
+
+    computeUAVs_        = D3DBindingSlots<ID3D11UnorderedAccessView, D3D11_PS_CS_UAV_REGISTER_COUNT>{};
+    dirtyStages_        = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11StateManager::FlushResourceBindings(UINT firstStage, UINT lastStage)
+{
+    for (UINT stage = firstStage; stage < lastStage; ++stage)
+    {
+        if ((dirtyStages_ & (1u << stage)) != 0)
+            FlushStageResourceBindings(stage);
+    }
+}
+
+void D3D11StateManager::FlushStageResourceBindings(UINT stage)
+{
+    auto& bindings  = stageBindings_[stage];
+    auto& funcs     = g_stageFunctions[stage];
+
+    /* Submit UAVs before SRVs, so resources that switch from UAV to SRV are no longer bound as output */
+    if (stage == numGraphicsStages_)
+        FlushComputeUAVs();
+
+    const auto constantBufferRange = bindings.constantBuffers.dirtyRange;
+    SubmitPendingBindings(context_.Get(), bindings.constantBuffers, funcs.setConstantBuffers);
+    SubmitConstantBufferRanges(stage, constantBufferRange.begin, constantBufferRange.end);
+    SubmitPendingBindings(context_.Get(), bindings.shaderResourceViews, funcs.setShaderResources);
+    SubmitPendingBindings(context_.Get(), bindings.samplers, funcs.setSamplers);
+
+    dirtyStages_ &= ~(1u << stage);
+}
+
+void D3D11StateManager::SubmitConstantBufferRanges(UINT stage, UINT begin, UINT end)
+{
+    auto& bindings = stageBindings_[stage];
+
+    for (UINT slot = begin; slot < end; ++slot)
+    {
+        const auto& range = bindings.pendingConstantBufferRanges[slot];
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        /* Re-bind constant buffers with ranges, since they have just been bound entirely with the other pending bindings */
+        if (range.numConstants != 0)
+        {
+            (context1_.Get()->*g_stageSetConstantBuffers1[stage])(
+                slot, 1, bindings.constantBuffers.pending + slot, &(range.firstConstant), &(range.numConstants)
+            );
+        }
+        #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+        bindings.boundConstantBufferRanges[slot] = range;
+    }
+}
+
+void D3D11StateManager::FlushComputeUAVs()
+{
+    auto& range = computeUAVs_.dirtyRange;
+    if (range.begin < range.end)
+    {
+        context_->CSSetUnorderedAccessViews(range.begin, range.end - range.begin, computeUAVs_.pending + range.begin, nullptr);
+        std::copy(computeUAVs_.pending + range.begin, computeUAVs_.pending + range.end, computeUAVs_.bound + range.begin);
+        range.begin = 0;
+        range.end   = 0;
+
+        /* Binding UAVs unbinds SRVs of the same resources */
+        InvalidateShaderResources();
+    }
+}
+
 
 } // /namespace LLGL
 
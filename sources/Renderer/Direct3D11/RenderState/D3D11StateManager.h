@@ -13,7 +13,7 @@
 #include <LLGL/GraphicsPipelineFlags.h>
 #include <vector>
 #include <cstdint>
-#include <d3d11.h>
+#include "../Direct3D11.h"
 
 
 namespace LLGL
@@ -45,8 +45,73 @@ class D3D11StateManager
         void SetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef);
         void SetBlendState(ID3D11BlendState* blendState, const FLOAT* blendFactor, UINT sampleMask);
 
+        // Sets the stencil reference value and keeps the current depth-stencil state.
+        void SetStencilRef(UINT stencilRef);
+
+        // Sets the blend factor and keeps the current blend state and sample mask.
+        void SetBlendFactor(const FLOAT* blendFactor);
+
+        // Returns the current stencil reference value.
+        inline UINT GetStencilRef() const
+        {
+            return renderState_.stencilRef;
+        }
+
+        // Returns the pointer to an array of 4 floating-points of the current blend factor.
+        inline const FLOAT* GetBlendFactor() const
+        {
+            return renderState_.blendFactor;
+        }
+
+        /* ----- Resource bindings (deferred until the next draw or dispatch command) ----- */
+
+        void SetConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags);
+
+        /*
+        Sets a range of the specified constant buffer in units of 16-byte shader constants ('firstConstant' and 'numConstants' must be multiples of 16).
+        Without Direct3D 11.1, the range is ignored and the entire buffer is bound.
+        */
+        void SetConstantBufferRange(UINT slot, ID3D11Buffer* buffer, UINT firstConstant, UINT numConstants, long stageFlags);
+
+        // Returns true if constant buffers can be bound with ranges, i.e. Direct3D 11.1 with constant buffer offsetting is supported.
+        bool HasConstantBufferRanges() const;
+
+        void SetShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags);
+        void SetSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags);
+        void SetUnorderedAccessViews(UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long stageFlags);
+
+        // Sets the hidden counter of the specified append or consume UAV, which is only possible by binding it. The previous compute UAV binding is restored.
+        void SetUnorderedAccessViewCounter(ID3D11UnorderedAccessView* view, UINT value);
+
+        // Submits all pending resource bindings of the graphics shader stages (VS, HS, DS, GS, PS) to the device context.
+        inline void FlushGraphicsResourceBindings()
+        {
+            if ((dirtyStages_ & graphicsStagesMask_) != 0)
+                FlushResourceBindings(0, numGraphicsStages_);
+        }
+
+        // Submits all pending resource bindings of the compute shader stage to the device context.
+        inline void FlushComputeResourceBindings()
+        {
+            if ((dirtyStages_ & computeStagesMask_) != 0)
+                FlushResourceBindings(numGraphicsStages_, numStages_);
+        }
+
+        // Re-submits all shader resource views with the next flush, because the runtime unbinds SRVs that are bound as output (RTV or UAV) as well.
+        void InvalidateShaderResources();
+
+        // Resets all cached states and bindings, because the device context has been reset to its default state (e.g. after FinishCommandList).
+        void ResetCache();
+
     private:
 
+        /* ----- Constants ----- */
+
+        static const UINT numGraphicsStages_    = 5;
+        static const UINT numStages_            = 6;
+        static const UINT graphicsStagesMask_   = 0x1f;
+        static const UINT computeStagesMask_    = 0x20;
+
         /* ----- Structures ----- */
 
         struct D3DInputAssemblyState
@@ -75,14 +140,62 @@ class D3D11StateManager
             UINT                        sampleMask          = 0xffffffff;
         };
 
+        // Range of slots [begin, end) which has been modified since the last flush.
+        struct D3DDirtyRange
+        {
+            UINT begin  = 0;
+            UINT end    = 0;
+        };
+
+        // Range of a constant buffer binding in units of 16-byte shader constants (numConstants = 0 for the entire buffer).
+        struct D3DConstantBufferRange
+        {
+            UINT firstConstant  = 0;
+            UINT numConstants   = 0;
+        };
+
+        // Pending and submitted objects of one resource type for one shader stage.
+        template <typename T, UINT N>
+        struct D3DBindingSlots
+        {
+            T*              pending[N]  = {};
+            T*              bound[N]    = {};
+            D3DDirtyRange   dirtyRange;
+            UINT            numUsed     = 0;
+        };
+
+        struct D3DStageBindings
+        {
+            D3DBindingSlots<ID3D11Buffer,               D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>  constantBuffers;
+            D3DBindingSlots<ID3D11ShaderResourceView,   D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT>       shaderResourceViews;
+            D3DBindingSlots<ID3D11SamplerState,         D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT>              samplers;
+            D3DConstantBufferRange  pendingConstantBufferRanges[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+            D3DConstantBufferRange  boundConstantBufferRanges[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+        };
+
+        /* ----- Functions ----- */
+
+        void FlushResourceBindings(UINT firstStage, UINT lastStage);
+        void FlushStageResourceBindings(UINT stage);
+        void SubmitConstantBufferRanges(UINT stage, UINT begin, UINT end);
+        void FlushComputeUAVs();
+
         /* ----- Members ----- */
 
         ComPtr<ID3D11DeviceContext> context_;
 
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<ID3D11DeviceContext1> context1_;                 // Only used for constant buffer ranges; may be null
+        #endif
+
         D3DInputAssemblyState       inputAssemblyState_;
         D3DShaderState              shaderState_;
         D3DRenderState              renderState_;
 
+        D3DStageBindings            stageBindings_[numStages_];
+        D3DBindingSlots<ID3D11UnorderedAccessView, D3D11_PS_CS_UAV_REGISTER_COUNT> computeUAVs_;
+        UINT                        dirtyStages_            = 0;
+
 };
 
 
@@ -0,0 +1,161 @@
+/*
+ * D3D11StateObjectCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11StateObjectCache.h"
+#include "../../DXCommon/DXCore.h"
+#include <cstring>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Returns the FNV-1a hash of the raw bytes of the specified descriptor.
+template <typename TDesc>
+static std::size_t HashDescriptor(const TDesc& desc)
+{
+    auto bytes = reinterpret_cast<const std::uint8_t*>(&desc);
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < sizeof(TDesc); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+// Returns the cached state object for the specified descriptor, or creates and caches a new one with the specified function.
+template <typename TMap, typename TDesc, typename TCreateFunc>
+static auto FindOrCreateStateObject(TMap& map, const TDesc& desc, TCreateFunc createFunc) -> decltype(map.entries.begin()->second.state)
+{
+    const auto hash     = HashDescriptor(desc);
+    const auto range    = map.entries.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (std::memcmp(&(it->second.desc), &desc, sizeof(TDesc)) == 0)
+            return it->second.state;
+    }
+
+    /* Create new state object and store it in the cache */
+    typename TMap::Entry entry;
+    {
+        entry.desc  = desc;
+        createFunc(entry.state);
+    }
+    map.entries.insert({ hash, entry });
+
+    return entry.state;
+}
+
+// Removes all entries from the specified map whose state objects are only referenced by the cache.
+template <typename TMap>
+static void ReleaseUnusedStateObjects(TMap& map)
+{
+    for (auto it = map.entries.begin(); it != map.entries.end();)
+    {
+        /* Temporarily increment the reference counter to determine the current number of references */
+        it->second.state->AddRef();
+        if (it->second.state->Release() == 1)
+            it = map.entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+ComPtr<ID3D11DepthStencilState> D3D11StateObjectCache::CreateDepthStencilState(ID3D11Device* device, const D3D11_DEPTH_STENCIL_DESC& desc)
+{
+    return FindOrCreateStateObject(
+        depthStencilStates_, desc,
+        [device, &desc](ComPtr<ID3D11DepthStencilState>& state)
+        {
+            auto hr = device->CreateDepthStencilState(&desc, state.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+        }
+    );
+}
+
+ComPtr<ID3D11RasterizerState> D3D11StateObjectCache::CreateRasterizerState(ID3D11Device* device, const D3D11_RASTERIZER_DESC& desc)
+{
+    return FindOrCreateStateObject(
+        rasterizerStates_, desc,
+        [device, &desc](ComPtr<ID3D11RasterizerState>& state)
+        {
+            auto hr = device->CreateRasterizerState(&desc, state.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+        }
+    );
+}
+
+ComPtr<ID3D11BlendState> D3D11StateObjectCache::CreateBlendState(ID3D11Device* device, const D3D11_BLEND_DESC& desc)
+{
+    return FindOrCreateStateObject(
+        blendStates_, desc,
+        [device, &desc](ComPtr<ID3D11BlendState>& state)
+        {
+            auto hr = device->CreateBlendState(&desc, state.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+        }
+    );
+}
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+ComPtr<ID3D11BlendState1> D3D11StateObjectCache::CreateBlendState1(ID3D11Device1* device, const D3D11_BLEND_DESC1& desc)
+{
+    return FindOrCreateStateObject(
+        blendStates1_, desc,
+        [device, &desc](ComPtr<ID3D11BlendState1>& state)
+        {
+            auto hr = device->CreateBlendState1(&desc, state.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+        }
+    );
+}
+
+#endif
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+
+ComPtr<ID3D11RasterizerState2> D3D11StateObjectCache::CreateRasterizerState2(ID3D11Device3* device, const D3D11_RASTERIZER_DESC2& desc)
+{
+    return FindOrCreateStateObject(
+        rasterizerStates2_, desc,
+        [device, &desc](ComPtr<ID3D11RasterizerState2>& state)
+        {
+            auto hr = device->CreateRasterizerState2(&desc, state.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+        }
+    );
+}
+
+#endif
+
+void D3D11StateObjectCache::ReleaseUnusedStates()
+{
+    ReleaseUnusedStateObjects(depthStencilStates_);
+    ReleaseUnusedStateObjects(rasterizerStates_);
+    ReleaseUnusedStateObjects(blendStates_);
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    ReleaseUnusedStateObjects(blendStates1_);
+    #endif
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+    ReleaseUnusedStateObjects(rasterizerStates2_);
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,90 @@
+/*
+ * D3D11StateObjectCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_STATE_OBJECT_CACHE_H
+#define LLGL_D3D11_STATE_OBJECT_CACHE_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <unordered_map>
+#include <cstddef>
+#include <d3d11.h>
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+#   include <d3d11_3.h>
+#elif LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+#   include <d3d11_1.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+Cache for blend, rasterizer, and depth-stencil state objects, which is shared across all graphics pipelines.
+State objects are looked up by the hash of their descriptor, so pipelines with identical sub-states share the same objects.
+This keeps the number of unique state objects below the limit of the D3D11 runtime (4096 per type).
+*/
+class D3D11StateObjectCache
+{
+
+    public:
+
+        ComPtr<ID3D11DepthStencilState> CreateDepthStencilState(ID3D11Device* device, const D3D11_DEPTH_STENCIL_DESC& desc);
+        ComPtr<ID3D11RasterizerState> CreateRasterizerState(ID3D11Device* device, const D3D11_RASTERIZER_DESC& desc);
+        ComPtr<ID3D11BlendState> CreateBlendState(ID3D11Device* device, const D3D11_BLEND_DESC& desc);
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<ID3D11BlendState1> CreateBlendState1(ID3D11Device1* device, const D3D11_BLEND_DESC1& desc);
+        #endif
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+        ComPtr<ID3D11RasterizerState2> CreateRasterizerState2(ID3D11Device3* device, const D3D11_RASTERIZER_DESC2& desc);
+        #endif
+
+        // Releases all state objects that are not referenced by any graphics pipeline.
+        void ReleaseUnusedStates();
+
+    private:
+
+        // Map of state objects, whose keys are the hashes of their descriptors.
+        template <typename TDesc, typename TState>
+        struct StateObjectMap
+        {
+            struct Entry
+            {
+                TDesc           desc;
+                ComPtr<TState>  state;
+            };
+
+            std::unordered_multimap<std::size_t, Entry> entries;
+        };
+
+        StateObjectMap<D3D11_DEPTH_STENCIL_DESC, ID3D11DepthStencilState>   depthStencilStates_;
+        StateObjectMap<D3D11_RASTERIZER_DESC, ID3D11RasterizerState>        rasterizerStates_;
+        StateObjectMap<D3D11_BLEND_DESC, ID3D11BlendState>                  blendStates_;
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        StateObjectMap<D3D11_BLEND_DESC1, ID3D11BlendState1>                blendStates1_;
+        #endif
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+        StateObjectMap<D3D11_RASTERIZER_DESC2, ID3D11RasterizerState2>      rasterizerStates2_;
+        #endif
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,7 +8,9 @@
 #include "D3D11Shader.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include "../../DXCommon/DXShaderCache.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/TaskQueue.h"
 #include <algorithm>
 #include <stdexcept>
 #include <d3dcompiler.h>
@@ -19,20 +21,29 @@ namespace LLGL
 {
 
 
-D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc) :
+D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc, const std::string& cacheDirectory) :
     Shader { desc.type }
 {
-    if (!Build(device, desc))
+    if (!Build(device, desc, cacheDirectory))
         hasErrors_ = true;
 }
 
+D3D11Shader::~D3D11Shader()
+{
+    /* Asynchronous compilation refers to this object, so it must finish first */
+    if (compileTask_.valid())
+        compileTask_.wait();
+}
+
 bool D3D11Shader::HasErrors() const
 {
+    WaitForCompilation();
     return hasErrors_;
 }
 
 std::string D3D11Shader::Disassemble(int flags)
 {
+    WaitForCompilation();
     if (!byteCode_.empty())
     {
         ComPtr<ID3DBlob> disasm;
@@ -47,30 +58,48 @@ std::string D3D11Shader::Disassemble(int flags)
 
 std::string D3D11Shader::QueryInfoLog()
 {
+    WaitForCompilation();
     return (errors_.Get() != nullptr ? DXGetBlobString(errors_.Get()) : "");
 }
 
 void D3D11Shader::Reflect(ShaderReflectionDescriptor& reflectionDesc) const
 {
+    WaitForCompilation();
     if (!byteCode_.empty())
         ReflectShaderByteCode(reflectionDesc);
 }
 
+bool D3D11Shader::IsCompiled() const
+{
+    return IsFutureReady(compileTask_);
+}
+
+void D3D11Shader::WaitForCompilation() const
+{
+    if (compileTask_.valid())
+        compileTask_.get();
+}
+
 
 /*
  * ======= Private: =======
  */
 
-bool D3D11Shader::Build(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::Build(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(device, shaderDesc);
+    {
+        if ((shaderDesc.flags & ShaderCompileFlags::Async) != 0)
+            return CompileSourceAsync(device, shaderDesc, cacheDirectory);
+        else
+            return CompileSource(device, shaderDesc, cacheDirectory);
+    }
     else
         return LoadBinary(device, shaderDesc);
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
 {
     /* Get source code */
     std::string fileContent;
@@ -89,11 +118,25 @@ bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& sh
         sourceLength    = shaderDesc.sourceSize;
     }
 
+    /* Try to load byte code from shader cache */
+    const auto cacheFilename = DXGetShaderCacheFilename(cacheDirectory, shaderDesc, sourceCode, sourceLength);
+    if (!cacheFilename.empty() && DXLoadShaderCacheEntry(cacheFilename, byteCode_))
+    {
+        CreateNativeShader(device, shaderDesc.streamOutput, nullptr);
+        return true;
+    }
+
     /* Get parameter from union */
     const char* entry   = shaderDesc.entryPoint;
     const char* target  = (shaderDesc.profile != nullptr ? shaderDesc.profile : "");
     auto        flags   = shaderDesc.flags;
 
+    /* Define named specialization constants as macros */
+    std::vector<std::string>        macroValues;
+    std::vector<D3D_SHADER_MACRO>   macros;
+    DXGetSpecializationMacros(shaderDesc.specializationConstants, macroValues, macros);
+    const D3D_SHADER_MACRO* defines = (macros.empty() ? nullptr : macros.data());
+
     /* Compile shader code */
     ComPtr<ID3DBlob> code;
 
@@ -101,7 +144,7 @@ bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& sh
         sourceCode,
         sourceLength,
         nullptr,                            // LPCSTR               pSourceName
-        nullptr,                            // D3D_SHADER_MACRO*    pDefines
+        defines,                            // D3D_SHADER_MACRO*    pDefines
         nullptr,                            // ID3DInclude*         pInclude
         entry,                              // LPCSTR               pEntrypoint
         target,                             // LPCSTR               pTarget
@@ -116,12 +159,32 @@ bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& sh
     {
         byteCode_ = DXGetBlobData(code.Get());
         CreateNativeShader(device, shaderDesc.streamOutput, nullptr);
+
+        /* Store byte code in shader cache */
+        if (!cacheFilename.empty() && !FAILED(hr))
+            DXStoreShaderCacheEntry(cacheFilename, byteCode_);
     }
 
     /* Store if compilation was successful */
     return !FAILED(hr);
 }
 
+bool D3D11Shader::CompileSourceAsync(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
+{
+    /* Copy shader descriptor, since it is only valid during this call (ID3D11Device is thread-safe) */
+    auto ownedShaderDesc = std::make_shared<DXOwnedShaderDescriptor>(shaderDesc);
+
+    compileTask_ = TaskQueue::Get().Enqueue(
+        [this, device, ownedShaderDesc, cacheDirectory]()
+        {
+            if (!CompileSource(device, ownedShaderDesc->Get(), cacheDirectory))
+                hasErrors_ = true;
+        }
+    );
+
+    return true;
+}
+
 bool D3D11Shader::LoadBinary(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
 {
     if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
@@ -203,7 +266,7 @@ void D3D11Shader::CreateNativeShader(ID3D11Device* device, const ShaderDescripto
                     /* Create geometry shader with stream-output declaration */
                     hr = device->CreateGeometryShaderWithStreamOutput(
                         byteCode_.data(), byteCode_.size(),
-                        outputElements.data(), static_cast<UINT>(outputElements.size()), nullptr, 0, 0,
+                        outputElements.data(), static_cast<UINT>(outputElements.size()), nullptr, 0, streamOutputDesc.rasterizedStream,
                         classLinkage, native_.gs.ReleaseAndGetAddressOf()
                     );
                 }
@@ -227,6 +290,13 @@ void D3D11Shader::CreateNativeShader(ID3D11Device* device, const ShaderDescripto
                 DXThrowIfFailed(hr, "failed to create D3D11 compute shader");
             }
             break;
+
+            case ShaderType::Amplification:
+            case ShaderType::Mesh:
+                throw std::runtime_error("mesh shaders are not supported by D3D11");
+
+            default:
+                break;
         }
     }
     catch (const std::exception&)
@@ -16,6 +16,7 @@
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
 #include <string>
+#include <future>
 #include <d3d11.h>
 
 
@@ -48,7 +49,9 @@ class D3D11Shader final : public Shader
 
     public:
 
-        D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc);
+        // Constructs the shader and uses the specified on-disk shader cache if the directory is not empty.
+        D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc, const std::string& cacheDirectory = "");
+        ~D3D11Shader();
 
         bool HasErrors() const override;
 
@@ -60,22 +63,31 @@ class D3D11Shader final : public Shader
 
         void Reflect(ShaderReflectionDescriptor& reflectionDesc) const;
 
+        // Returns true if the shader is not compiled asynchronously, or if its compilation has finished.
+        bool IsCompiled() const;
+
+        // Blocks until the asynchronous compilation has finished, and rethrows its exceptions.
+        void WaitForCompilation() const;
+
         // Returns the native D3D shader object.
         inline const D3D11NativeShader& GetNative() const
         {
+            WaitForCompilation();
             return native_;
         }
 
         // Returns the shader byte code container.
         inline const std::vector<char>& GetByteCode() const
         {
+            WaitForCompilation();
             return byteCode_;
         }
 
     private:
 
-        bool Build(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
-        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
+        bool Build(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
+        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
+        bool CompileSourceAsync(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
         bool LoadBinary(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
 
         void CreateNativeShader(ID3D11Device* device, const ShaderDescriptor::StreamOutput& streamOutputDesc, ID3D11ClassLinkage* classLinkage);
@@ -88,6 +100,8 @@ class D3D11Shader final : public Shader
         ComPtr<ID3DBlob>    errors_;
         bool                hasErrors_  = false;
 
+        std::shared_future<void> compileTask_;  // Only valid for ShaderCompileFlags::Async
+
 };
 
 
@@ -11,6 +11,7 @@
 #include "../../CheckedCast.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/TaskQueue.h"
 #include <LLGL/Log.h>
 #include <LLGL/VertexFormat.h>
 #include <algorithm>
@@ -35,23 +36,53 @@ D3D11ShaderProgram::D3D11ShaderProgram(ID3D11Device* device, const ShaderProgram
     Attach(gs_, desc.geometryShader);
     Attach(ps_, desc.fragmentShader);
     Attach(cs_, desc.computeShader);
-    BuildInputLayout(device, desc.vertexFormats.size(), desc.vertexFormats.data());
-    Link();
+
+    if (HasPendingShaders())
+    {
+        /* Build input layout and link program after the asynchronous shader compilation (vertex formats must be copied) */
+        const auto vertexFormats = desc.vertexFormats;
+        linkTask_ = TaskQueue::Get().Enqueue(
+            [this, device, vertexFormats]()
+            {
+                BuildInputLayout(device, vertexFormats.size(), vertexFormats.data());
+                Link();
+            }
+        );
+    }
+    else
+    {
+        BuildInputLayout(device, desc.vertexFormats.size(), desc.vertexFormats.data());
+        Link();
+    }
+}
+
+D3D11ShaderProgram::~D3D11ShaderProgram()
+{
+    /* Asynchronous linking refers to this object, so it must finish first */
+    if (linkTask_.valid())
+        linkTask_.wait();
 }
 
 bool D3D11ShaderProgram::HasErrors() const
 {
+    WaitForLink();
     return (linkError_ != LinkError::NoError);
 }
 
 std::string D3D11ShaderProgram::QueryInfoLog()
 {
+    WaitForLink();
     if (auto s = ShaderProgram::LinkErrorToString(linkError_))
         return s;
     else
         return "";
 }
 
+bool D3D11ShaderProgram::IsReady() const
+{
+    return IsFutureReady(linkTask_);
+}
+
 ShaderReflectionDescriptor D3D11ShaderProgram::QueryReflectionDesc() const
 {
     ShaderReflectionDescriptor reflection;
@@ -167,6 +198,22 @@ void D3D11ShaderProgram::Link()
         linkError_ = LinkError::InvalidComposition;
 }
 
+bool D3D11ShaderProgram::HasPendingShaders() const
+{
+    for (auto shader : shaders_)
+    {
+        if (shader != nullptr && !shader->IsCompiled())
+            return true;
+    }
+    return false;
+}
+
+void D3D11ShaderProgram::WaitForLink() const
+{
+    if (linkTask_.valid())
+        linkTask_.get();
+}
+
 
 } // /namespace LLGL
 
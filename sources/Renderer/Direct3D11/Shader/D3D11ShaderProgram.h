@@ -12,6 +12,7 @@
 #include <LLGL/ShaderProgram.h>
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
+#include <future>
 #include <d3d11.h>
 
 
@@ -27,11 +28,14 @@ class D3D11ShaderProgram final : public ShaderProgram
     public:
 
         D3D11ShaderProgram(ID3D11Device* device, const ShaderProgramDescriptor& desc);
+        ~D3D11ShaderProgram();
 
         bool HasErrors() const override;
 
         std::string QueryInfoLog() override;
 
+        bool IsReady() const override;
+
         ShaderReflectionDescriptor QueryReflectionDesc() const override;
 
         void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
@@ -44,6 +48,7 @@ class D3D11ShaderProgram final : public ShaderProgram
 
         inline const ComPtr<ID3D11InputLayout>& GetInputLayout() const
         {
+            WaitForLink();
             return inputLayout_;
         }
 
@@ -59,6 +64,11 @@ class D3D11ShaderProgram final : public ShaderProgram
         void BuildInputLayout(ID3D11Device* device, std::size_t numVertexFormats, const VertexFormat* vertexFormats);
         void Link();
 
+        bool HasPendingShaders() const;
+
+        // Blocks until the asynchronous linking has finished, and rethrows its exceptions.
+        void WaitForLink() const;
+
         ComPtr<ID3D11InputLayout>   inputLayout_;
 
         union
@@ -77,6 +87,8 @@ class D3D11ShaderProgram final : public ShaderProgram
 
         LinkError                   linkError_      = LinkError::NoError;
 
+        std::shared_future<void>    linkTask_;      // Only valid if any shader is compiled asynchronously
+
 };
 
 
@@ -29,7 +29,8 @@ D3D11RenderTarget::D3D11RenderTarget(ID3D11Device* device, const RenderTargetDes
     else
     #endif
     {
-        /* Initialize all attachments */
+        /* Validate array layers of layered attachments, then initialize all attachments */
+        ValidateAttachmentLayers(desc);
         for (const auto& attachment : desc.attachments)
             Attach(attachment);
     }
@@ -47,7 +48,11 @@ bool D3D11RenderTarget::HasDepthAttachment() const
 
 bool D3D11RenderTarget::HasStencilAttachment() const
 {
-    return (depthStencilView_.Get() != nullptr && depthStencilFormat_ == DXGI_FORMAT_D24_UNORM_S8_UINT);
+    return
+    (
+        depthStencilView_.Get() != nullptr &&
+        (depthStencilFormat_ == DXGI_FORMAT_D24_UNORM_S8_UINT || depthStencilFormat_ == DXGI_FORMAT_D32_FLOAT_S8X24_UINT)
+    );
 }
 
 /* ----- Extended Internal Functions ----- */
@@ -66,6 +71,52 @@ void D3D11RenderTarget::ResolveSubresources(ID3D11DeviceContext* context)
     }
 }
 
+void D3D11RenderTarget::ResolveColorAttachment(ID3D11DeviceContext* context, std::uint32_t colorAttachment, ID3D11Resource* dstResource, UINT dstSubresource)
+{
+    if (colorAttachment >= renderTargetViewsRef_.size())
+        return;
+
+    /* Get source subresource from the RTV of the color attachment */
+    auto rtv = renderTargetViewsRef_[colorAttachment];
+
+    D3D11_RENDER_TARGET_VIEW_DESC rtvDesc;
+    rtv->GetDesc(&rtvDesc);
+
+    ComPtr<ID3D11Resource> srcResource;
+    rtv->GetResource(srcResource.GetAddressOf());
+
+    switch (rtvDesc.ViewDimension)
+    {
+        case D3D11_RTV_DIMENSION_TEXTURE2DMS:
+            context->ResolveSubresource(dstResource, dstSubresource, srcResource.Get(), 0, rtvDesc.Format);
+            break;
+
+        case D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY:
+            context->ResolveSubresource(dstResource, dstSubresource, srcResource.Get(), rtvDesc.Texture2DMSArray.FirstArraySlice, rtvDesc.Format);
+            break;
+
+        case D3D11_RTV_DIMENSION_TEXTURE2D:
+            context->CopySubresourceRegion(dstResource, dstSubresource, 0, 0, 0, srcResource.Get(), rtvDesc.Texture2D.MipSlice, nullptr);
+            break;
+
+        case D3D11_RTV_DIMENSION_TEXTURE2DARRAY:
+        {
+            ComPtr<ID3D11Texture2D> srcTexture;
+            if (SUCCEEDED(srcResource.As(&srcTexture)))
+            {
+                D3D11_TEXTURE2D_DESC texDesc;
+                srcTexture->GetDesc(&texDesc);
+                const auto srcSubresource = D3D11CalcSubresource(rtvDesc.Texture2DArray.MipSlice, rtvDesc.Texture2DArray.FirstArraySlice, texDesc.MipLevels);
+                context->CopySubresourceRegion(dstResource, dstSubresource, 0, 0, 0, srcResource.Get(), srcSubresource, nullptr);
+            }
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -131,7 +182,7 @@ static void FillViewDescForTexture3D(const AttachmentDescriptor& attachmentDesc,
     viewDesc.ViewDimension          = D3D11_RTV_DIMENSION_TEXTURE3D;
     viewDesc.Texture3D.MipSlice     = attachmentDesc.mipLevel;
     viewDesc.Texture3D.FirstWSlice  = attachmentDesc.arrayLayer;
-    viewDesc.Texture3D.WSize        = 1;
+    viewDesc.Texture3D.WSize        = attachmentDesc.numArrayLayers;
 }
 
 static void FillViewDescForTexture1DArray(const AttachmentDescriptor& attachmentDesc, D3D11_RENDER_TARGET_VIEW_DESC& viewDesc)
@@ -139,7 +190,7 @@ static void FillViewDescForTexture1DArray(const AttachmentDescriptor& attachment
     viewDesc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE1DARRAY;
     viewDesc.Texture1DArray.MipSlice        = attachmentDesc.mipLevel;
     viewDesc.Texture1DArray.FirstArraySlice = attachmentDesc.arrayLayer;
-    viewDesc.Texture1DArray.ArraySize       = 1;
+    viewDesc.Texture1DArray.ArraySize       = attachmentDesc.numArrayLayers;
 }
 
 static void FillViewDescForTexture2DArray(const AttachmentDescriptor& attachmentDesc, D3D11_RENDER_TARGET_VIEW_DESC& viewDesc)
@@ -147,7 +198,7 @@ static void FillViewDescForTexture2DArray(const AttachmentDescriptor& attachment
     viewDesc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
     viewDesc.Texture2DArray.MipSlice        = attachmentDesc.mipLevel;
     viewDesc.Texture2DArray.FirstArraySlice = attachmentDesc.arrayLayer;
-    viewDesc.Texture2DArray.ArraySize       = 1;
+    viewDesc.Texture2DArray.ArraySize       = attachmentDesc.numArrayLayers;
 }
 
 static void FillViewDescForTexture2DMS(const AttachmentDescriptor& attachmentDesc, D3D11_RENDER_TARGET_VIEW_DESC& viewDesc)
@@ -159,7 +210,7 @@ static void FillViewDescForTexture2DArrayMS(const AttachmentDescriptor& attachme
 {
     viewDesc.ViewDimension                      = D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY;
     viewDesc.Texture2DMSArray.FirstArraySlice   = attachmentDesc.arrayLayer;
-    viewDesc.Texture2DMSArray.ArraySize         = 1;
+    viewDesc.Texture2DMSArray.ArraySize         = attachmentDesc.numArrayLayers;
 }
 
 void D3D11RenderTarget::AttachTexture(Texture& texture, const AttachmentDescriptor& attachmentDesc)
@@ -168,6 +219,14 @@ void D3D11RenderTarget::AttachTexture(Texture& texture, const AttachmentDescript
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     ValidateMipResolution(texture, attachmentDesc.mipLevel);
 
+    /* Depth-stencil textures are attached with a DSV, so they can be sampled after rendering without copying them */
+    const auto dsvFormat = DXGetDepthStencilViewFormat(textureD3D.GetFormat());
+    if (dsvFormat != DXGI_FORMAT_UNKNOWN)
+    {
+        AttachDepthStencilTexture(textureD3D, dsvFormat, attachmentDesc);
+        return;
+    }
+
     /* Initialize RTV descriptor with attachment procedure and create RTV */
     D3D11_RENDER_TARGET_VIEW_DESC rtvDesc;
     InitMemory(rtvDesc);
@@ -180,6 +239,10 @@ void D3D11RenderTarget::AttachTexture(Texture& texture, const AttachmentDescript
     */
     if (HasMultiSampling() && !IsMultiSampleTexture(texture.GetType()))
     {
+        /* Intermediate multi-sample textures only resolve a single subresource */
+        if (attachmentDesc.numArrayLayers > 1)
+            throw std::invalid_argument("cannot attach multiple array layers of single-sampled texture to multi-sampled D3D11 render-target");
+
         /* Get RTV descriptor for intermediate multi-sample texture */
         switch (texture.GetType())
         {
@@ -258,6 +321,64 @@ void D3D11RenderTarget::AttachTexture(Texture& texture, const AttachmentDescript
     }
 }
 
+void D3D11RenderTarget::AttachDepthStencilTexture(D3D11Texture& textureD3D, DXGI_FORMAT format, const AttachmentDescriptor& attachmentDesc)
+{
+    if (depthStencilView_)
+        throw std::invalid_argument("cannot have more than one depth-stencil attachment for D3D11 render-target");
+
+    /* Depth-stencil attachments cannot be resolved, so the texture must have the same number of samples as the render target */
+    if (HasMultiSampling() && !IsMultiSampleTexture(textureD3D.GetType()))
+        throw std::invalid_argument("cannot attach single-sampled depth-stencil texture to multi-sampled D3D11 render-target");
+
+    /* Initialize DSV descriptor for the MIP-map level and array layer of the attachment */
+    D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc;
+    InitMemory(dsvDesc);
+
+    dsvDesc.Format = format;
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            dsvDesc.ViewDimension                   = D3D11_DSV_DIMENSION_TEXTURE1D;
+            dsvDesc.Texture1D.MipSlice              = attachmentDesc.mipLevel;
+            break;
+        case TextureType::Texture1DArray:
+            dsvDesc.ViewDimension                   = D3D11_DSV_DIMENSION_TEXTURE1DARRAY;
+            dsvDesc.Texture1DArray.MipSlice         = attachmentDesc.mipLevel;
+            dsvDesc.Texture1DArray.FirstArraySlice  = attachmentDesc.arrayLayer;
+            dsvDesc.Texture1DArray.ArraySize        = attachmentDesc.numArrayLayers;
+            break;
+        case TextureType::Texture2D:
+            dsvDesc.ViewDimension                   = D3D11_DSV_DIMENSION_TEXTURE2D;
+            dsvDesc.Texture2D.MipSlice              = attachmentDesc.mipLevel;
+            break;
+        case TextureType::TextureCube:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            dsvDesc.ViewDimension                   = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice         = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice  = attachmentDesc.arrayLayer;
+            dsvDesc.Texture2DArray.ArraySize        = attachmentDesc.numArrayLayers;
+            break;
+        case TextureType::Texture2DMS:
+            dsvDesc.ViewDimension                   = D3D11_DSV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY;
+            dsvDesc.Texture2DMSArray.FirstArraySlice    = attachmentDesc.arrayLayer;
+            dsvDesc.Texture2DMSArray.ArraySize          = attachmentDesc.numArrayLayers;
+            break;
+        default:
+            throw std::invalid_argument("cannot attach 3D texture as depth-stencil attachment to D3D11 render-target");
+    }
+
+    /* Create DSV for the texture resource */
+    auto hr = device_->CreateDepthStencilView(textureD3D.GetNative().resource.Get(), &dsvDesc, depthStencilView_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil-view (DSV) for texture attachment");
+
+    depthStencilFormat_ = format;
+}
+
 void D3D11RenderTarget::CreateDepthStencilAndDSV(DXGI_FORMAT format)
 {
     depthStencilFormat_ = format;
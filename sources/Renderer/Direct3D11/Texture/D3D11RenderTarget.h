@@ -39,6 +39,9 @@ class D3D11RenderTarget final : public RenderTarget
         // Resolves all multi-sampled subresources.
         void ResolveSubresources(ID3D11DeviceContext* context);
 
+        // Resolves the specified color attachment into the destination subresource (single-sampled attachments are copied).
+        void ResolveColorAttachment(ID3D11DeviceContext* context, std::uint32_t colorAttachment, ID3D11Resource* dstResource, UINT dstSubresource);
+
         // Returns the list of native render target views (RTV).
         inline const std::vector<ID3D11RenderTargetView*>& GetRenderTargetViews() const
         {
@@ -51,6 +54,9 @@ class D3D11RenderTarget final : public RenderTarget
             return depthStencilView_.Get();
         }
 
+        // Returns true if this render target has multi-sampled attachments, which are resolved when another render target is bound.
+        bool HasMultiSampling() const;
+
     private:
 
         void Attach(const AttachmentDescriptor& attachmentDesc);
@@ -58,12 +64,11 @@ class D3D11RenderTarget final : public RenderTarget
         void AttachStencilBuffer();
         void AttachDepthStencilBuffer();
         void AttachTexture(Texture& texture, const AttachmentDescriptor& attachmentDesc);
+        void AttachDepthStencilTexture(D3D11Texture& textureD3D, DXGI_FORMAT format, const AttachmentDescriptor& attachmentDesc);
 
         void CreateDepthStencilAndDSV(DXGI_FORMAT format);
         void CreateAndAppendRTV(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC& rtvDesc);
 
-        bool HasMultiSampling() const;
-
         ID3D11Device*                               device_                     = nullptr;
 
         std::vector<ComPtr<ID3D11RenderTargetView>> renderTargetViews_;
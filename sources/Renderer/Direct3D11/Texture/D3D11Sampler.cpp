@@ -46,6 +46,13 @@ D3D11Sampler::D3D11Sampler(ID3D11Device* device, const SamplerDescriptor& desc)
     DXThrowIfFailed(hr, "failed to create D3D11 sampler state");
 }
 
+void D3D11Sampler::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    DXSetObjectName(GetNative(), name);
+    #endif
+}
+
 
 } // /namespace LLGL
 
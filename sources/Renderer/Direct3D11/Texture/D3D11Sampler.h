@@ -25,6 +25,8 @@ class D3D11Sampler final : public Sampler
 
         D3D11Sampler(ID3D11Device* device, const SamplerDescriptor& desc);
 
+        void SetName(const char* name) override;
+
         // Returns the native ID3D11SamplerState object.
         inline ID3D11SamplerState* GetNative() const
         {
@@ -19,6 +19,44 @@ D3D11Texture::D3D11Texture(const TextureType type) :
 {
 }
 
+// Returns the SRV dimension for a texture view, which must be an array view to refer to any other array layer than the first one.
+static TextureType GetTextureViewSRVType(const TextureViewDescriptor& desc)
+{
+    if (desc.subresource.baseArrayLayer > 0)
+    {
+        switch (desc.type)
+        {
+            case TextureType::Texture1D:    return TextureType::Texture1DArray;
+            case TextureType::Texture2D:    return TextureType::Texture2DArray;
+            case TextureType::Texture2DMS:  return TextureType::Texture2DMSArray;
+            default:                        break;
+        }
+    }
+    return desc.type;
+}
+
+D3D11Texture::D3D11Texture(ID3D11Device* device, const D3D11Texture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture { desc.type }
+{
+    /* Share native D3D texture and store parameters of the subresource this view refers to */
+    native_.resource    = sharedTexture.GetNative().resource;
+    format_             = D3D11Types::Map(desc.format);
+    numMipLevels_       = desc.subresource.numMipLevels;
+    numArrayLayers_     = desc.subresource.numArrayLayers;
+
+    /* Create SRV for the subresource with the format of the view */
+    CreateSubresourceSRV(
+        device,
+        srv_.ReleaseAndGetAddressOf(),
+        GetTextureViewSRVType(desc),
+        format_,
+        desc.subresource.baseMipLevel,
+        desc.subresource.numMipLevels,
+        desc.subresource.baseArrayLayer,
+        desc.subresource.numArrayLayers
+    );
+}
+
 Extent3D D3D11Texture::QueryMipExtent(std::uint32_t mipLevel) const
 {
     Extent3D size;
@@ -103,7 +141,7 @@ TextureDescriptor D3D11Texture::QueryDesc() const
             D3D11_TEXTURE1D_DESC desc;
             hwTex.tex1D->GetDesc(&desc);
 
-            texDesc.format      = D3D11Types::Unmap(desc.Format);
+            texDesc.format      = D3D11Types::Unmap(format_);
             texDesc.extent      = { desc.Width, 1u, 1u };
             texDesc.arrayLayers = desc.ArraySize;
         }
@@ -115,7 +153,7 @@ TextureDescriptor D3D11Texture::QueryDesc() const
             D3D11_TEXTURE2D_DESC desc;
             hwTex.tex2D->GetDesc(&desc);
 
-            texDesc.format      = D3D11Types::Unmap(desc.Format);
+            texDesc.format      = D3D11Types::Unmap(format_);
             texDesc.extent      = { desc.Width, desc.Height, 1u };
             texDesc.arrayLayers = desc.ArraySize;
             texDesc.samples     = desc.SampleDesc.Count;
@@ -128,7 +166,7 @@ TextureDescriptor D3D11Texture::QueryDesc() const
             D3D11_TEXTURE3D_DESC desc;
             hwTex.tex3D->GetDesc(&desc);
 
-            texDesc.format  = D3D11Types::Unmap(desc.Format);
+            texDesc.format  = D3D11Types::Unmap(format_);
             texDesc.extent  = { desc.Width, desc.Height, desc.Depth };
         }
         break;
@@ -137,6 +175,23 @@ TextureDescriptor D3D11Texture::QueryDesc() const
     return texDesc;
 }
 
+void D3D11Texture::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    DXSetObjectName(GetNative().resource.Get(), name);
+    #endif
+}
+
+// Returns the resource descriptor with the typeless format of the specified descriptor if the texture can be shared with texture views of a different format.
+template <typename T>
+static T GetResourceDesc(const T& desc, long flags)
+{
+    T resourceDesc = desc;
+    if ((flags & TextureFlags::MutableFormat) != 0)
+        resourceDesc.Format = DXGetTypelessFormat(desc.Format);
+    return resourceDesc;
+}
+
 static ComPtr<ID3D11Texture1D> DXCreateTexture1D(
     ID3D11Device* device, const D3D11_TEXTURE1D_DESC& desc, const D3D11_SUBRESOURCE_DATA* initialData = nullptr)
 {
@@ -171,17 +226,14 @@ void D3D11Texture::CreateTexture1D(
     const D3D11_SUBRESOURCE_DATA*           initialData,
     const D3D11_SHADER_RESOURCE_VIEW_DESC*  srvDesc)
 {
-    /* Create native D3D texture */
-    native_.tex1D = DXCreateTexture1D(device, desc, initialData);
-
-    /* Create resource views */
-    if ((flags & TextureFlags::SampleUsage) != 0)
-        CreateDefaultSRV(device, srvDesc);
-    //if ((flags & TextureFlags::StorageUsage) != 0)
-    //    CreateDefaultUAV(device, uavDesc);
+    /* Create native D3D texture (with typeless format if it can be shared with texture views of a different format) */
+    native_.tex1D = DXCreateTexture1D(device, GetResourceDesc(desc, flags), initialData);
 
     /* Store resource parameters */
-    SetResourceParams(desc.Format, { desc.Width, 1u, 1u }, desc.ArraySize);
+    SetResourceParams(desc.Format, { desc.Width, 1u, 1u }, desc.ArraySize, desc.MipLevels);
+
+    /* Create resource views */
+    CreateDefaultSRV(device, flags, srvDesc);
 }
 
 void D3D11Texture::CreateTexture2D(
@@ -191,15 +243,14 @@ void D3D11Texture::CreateTexture2D(
     const D3D11_SUBRESOURCE_DATA*           initialData,
     const D3D11_SHADER_RESOURCE_VIEW_DESC*  srvDesc)
 {
-    /* Create native D3D texture */
-    native_.tex2D = DXCreateTexture2D(device, desc, initialData);
-
-    /* Create resource views */
-    if ((flags & TextureFlags::SampleUsage) != 0)
-        CreateDefaultSRV(device, srvDesc);
+    /* Create native D3D texture (with typeless format if it can be shared with texture views of a different format) */
+    native_.tex2D = DXCreateTexture2D(device, GetResourceDesc(desc, flags), initialData);
 
     /* Store resource parameters */
-    SetResourceParams(desc.Format, { desc.Width, desc.Height, 1u }, desc.ArraySize);
+    SetResourceParams(desc.Format, { desc.Width, desc.Height, 1u }, desc.ArraySize, desc.MipLevels);
+
+    /* Create resource views */
+    CreateDefaultSRV(device, flags, srvDesc);
 }
 
 void D3D11Texture::CreateTexture3D(
@@ -209,15 +260,14 @@ void D3D11Texture::CreateTexture3D(
     const D3D11_SUBRESOURCE_DATA*           initialData,
     const D3D11_SHADER_RESOURCE_VIEW_DESC*  srvDesc)
 {
-    /* Create native D3D texture */
-    native_.tex3D = DXCreateTexture3D(device, desc, initialData);
-
-    /* Create resource views */
-    if ((flags & TextureFlags::SampleUsage) != 0)
-        CreateDefaultSRV(device, srvDesc);
+    /* Create native D3D texture (with typeless format if it can be shared with texture views of a different format) */
+    native_.tex3D = DXCreateTexture3D(device, GetResourceDesc(desc, flags), initialData);
 
     /* Store resource parameters */
-    SetResourceParams(desc.Format, { desc.Width, desc.Height, desc.Depth }, 1);
+    SetResourceParams(desc.Format, { desc.Width, desc.Height, desc.Depth }, 1, desc.MipLevels);
+
+    /* Create resource views */
+    CreateDefaultSRV(device, flags, srvDesc);
 }
 
 void D3D11Texture::UpdateSubresource(
@@ -235,7 +285,20 @@ void D3D11Texture::UpdateSubresource(
     /* Check if source image must be converted */
     auto dstTexFormat = DXGetTextureFormatDesc(format_);
 
-    if (dstTexFormat.format != imageDesc.format || dstTexFormat.dataType != imageDesc.dataType)
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        /* Get source data stride by rows of compressed blocks */
+        const auto format           = D3D11Types::Unmap(format_);
+        const auto srcRowPitch      = TextureBufferSize(format, { dstBox.right - dstBox.left, 1u, 1u });
+        const auto srcDepthPitch    = TextureBufferSize(format, { dstBox.right - dstBox.left, dstBox.bottom - dstBox.top, 1u });
+
+        /* Update subresource with specified compressed image data */
+        context->UpdateSubresource(
+            native_.resource.Get(), dstSubresource,
+            &dstBox, imageDesc.data, srcRowPitch, srcDepthPitch
+        );
+    }
+    else if (dstTexFormat.format != imageDesc.format || dstTexFormat.dataType != imageDesc.dataType)
     {
         /* Get source data stride */
         auto srcRowPitch        = (dstBox.right - dstBox.left)*srcPitch;
@@ -356,6 +419,148 @@ void D3D11Texture::CreateSubresourceCopyWithCPUAccess(
     );
 }
 
+void D3D11Texture::CreateSubresourceRegionCopyWithCPUAccess(
+    ID3D11Device*           device,
+    ID3D11DeviceContext*    context,
+    D3D11NativeTexture&     textureCopy,
+    UINT                    mipLevel,
+    UINT                    baseArrayLayer,
+    UINT                    numArrayLayers,
+    const D3D11_BOX&        srcBox) const
+{
+    CreateSubresourceRegionStaging(device, textureCopy, numArrayLayers, srcBox);
+    CopySubresourceRegionToStaging(context, textureCopy.resource.Get(), mipLevel, baseArrayLayer, numArrayLayers, srcBox);
+}
+
+void D3D11Texture::CreateSubresourceRegionStaging(
+    ID3D11Device*           device,
+    D3D11NativeTexture&     textureCopy,
+    UINT                    numArrayLayers,
+    const D3D11_BOX&        srcBox) const
+{
+    D3D11_RESOURCE_DIMENSION dimension;
+    native_.resource->GetType(&dimension);
+
+    switch (dimension)
+    {
+        case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
+        {
+            /* Create temporary 1D texture with the size of the region */
+            D3D11_TEXTURE1D_DESC desc;
+            native_.tex1D->GetDesc(&desc);
+            {
+                desc.Width          = (srcBox.right - srcBox.left);
+                desc.MipLevels      = 1;
+                desc.ArraySize      = numArrayLayers;
+                desc.Usage          = D3D11_USAGE_STAGING;
+                desc.BindFlags      = 0;
+                desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+                desc.MiscFlags      = 0;
+            }
+            textureCopy.tex1D = DXCreateTexture1D(device, desc);
+        }
+        break;
+
+        case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+        {
+            /* Create temporary 2D texture with the size of the region (cube faces become ordinary array layers) */
+            D3D11_TEXTURE2D_DESC desc;
+            native_.tex2D->GetDesc(&desc);
+            {
+                desc.Width          = (srcBox.right - srcBox.left);
+                desc.Height         = (srcBox.bottom - srcBox.top);
+                desc.MipLevels      = 1;
+                desc.ArraySize      = numArrayLayers;
+                desc.Usage          = D3D11_USAGE_STAGING;
+                desc.BindFlags      = 0;
+                desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+                desc.MiscFlags      = 0;
+            }
+            textureCopy.tex2D = DXCreateTexture2D(device, desc);
+        }
+        break;
+
+        case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
+        {
+            /* Create temporary 3D texture with the size of the region */
+            D3D11_TEXTURE3D_DESC desc;
+            native_.tex3D->GetDesc(&desc);
+            {
+                desc.Width          = (srcBox.right - srcBox.left);
+                desc.Height         = (srcBox.bottom - srcBox.top);
+                desc.Depth          = (srcBox.back - srcBox.front);
+                desc.MipLevels      = 1;
+                desc.Usage          = D3D11_USAGE_STAGING;
+                desc.BindFlags      = 0;
+                desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+                desc.MiscFlags      = 0;
+            }
+            textureCopy.tex3D = DXCreateTexture3D(device, desc);
+        }
+        break;
+    }
+}
+
+void D3D11Texture::CopySubresourceRegionToStaging(
+    ID3D11DeviceContext*    context,
+    ID3D11Resource*         textureCopy,
+    UINT                    mipLevel,
+    UINT                    baseArrayLayer,
+    UINT                    numArrayLayers,
+    const D3D11_BOX&        srcBox) const
+{
+    /* Copy region of each array layer */
+    for (UINT layer = 0; layer < numArrayLayers; ++layer)
+    {
+        context->CopySubresourceRegion(
+            textureCopy,
+            D3D11CalcSubresource(0, layer, 1),
+            0, 0, 0, // DstX, DstY, DstZ
+            native_.resource.Get(),
+            D3D11CalcSubresource(mipLevel, baseArrayLayer + layer, numMipLevels_),
+            &srcBox
+        );
+    }
+}
+
+void D3D11Texture::GetSubresourceRegion(
+    const Offset3D& offset,
+    const Extent3D& extent,
+    UINT&           baseArrayLayer,
+    UINT&           numArrayLayers,
+    D3D11_BOX&      box) const
+{
+    switch (GetType())
+    {
+        case TextureType::Texture1DArray:
+            baseArrayLayer  = static_cast<UINT>(offset.y);
+            numArrayLayers  = extent.height;
+            box             = CD3D11_BOX(offset.x, 0, 0, offset.x + static_cast<LONG>(extent.width), 1, 1);
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray: /*pass*/
+        case TextureType::Texture2DMSArray:
+            baseArrayLayer  = static_cast<UINT>(offset.z);
+            numArrayLayers  = extent.depth;
+            box             = CD3D11_BOX(
+                offset.x, offset.y, 0,
+                offset.x + static_cast<LONG>(extent.width), offset.y + static_cast<LONG>(extent.height), 1
+            );
+            break;
+
+        default:
+            baseArrayLayer  = 0;
+            numArrayLayers  = 1;
+            box             = CD3D11_BOX(
+                offset.x, offset.y, offset.z,
+                offset.x + static_cast<LONG>(extent.width), offset.y + static_cast<LONG>(extent.height), offset.z + static_cast<LONG>(extent.depth)
+            );
+            break;
+    }
+}
+
 void D3D11Texture::CreateSubresourceSRV(
     ID3D11Device*               device,
     ID3D11ShaderResourceView**  srvOutput,
@@ -364,11 +569,24 @@ void D3D11Texture::CreateSubresourceSRV(
     UINT                        baseArrayLayer,
     UINT                        numArrayLayers)
 {
-    /* Create SRV for subresource */
+    CreateSubresourceSRV(device, srvOutput, GetType(), format_, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+}
+
+void D3D11Texture::CreateSubresourceSRV(
+    ID3D11Device*               device,
+    ID3D11ShaderResourceView**  srvOutput,
+    const TextureType           type,
+    DXGI_FORMAT                 format,
+    UINT                        baseMipLevel,
+    UINT                        numMipLevels,
+    UINT                        baseArrayLayer,
+    UINT                        numArrayLayers)
+{
+    /* Create SRV for subresource (depth-stencil textures sample their depth component) */
     D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
     {
-        srvDesc.Format          = format_;
-        srvDesc.ViewDimension   = D3D11Types::Map(GetType());
+        srvDesc.Format          = DXGetShaderResourceViewFormat(format);
+        srvDesc.ViewDimension   = D3D11Types::Map(type);
 
         switch (srvDesc.ViewDimension)
         {
@@ -410,7 +628,7 @@ void D3D11Texture::CreateSubresourceSRV(
                 srvDesc.TextureCubeArray.MostDetailedMip    = baseMipLevel;
                 srvDesc.TextureCubeArray.MipLevels          = numMipLevels;
                 srvDesc.TextureCubeArray.First2DArrayFace   = baseArrayLayer;
-                srvDesc.TextureCubeArray.NumCubes           = numArrayLayers;
+                srvDesc.TextureCubeArray.NumCubes           = numArrayLayers / 6;
                 break;
 
             case D3D11_SRV_DIMENSION_TEXTURE2DMS:
@@ -431,8 +649,18 @@ void D3D11Texture::CreateSubresourceSRV(
  * ====== Private: ======
  */
 
-void D3D11Texture::CreateDefaultSRV(ID3D11Device* device, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc)
+void D3D11Texture::CreateDefaultSRV(ID3D11Device* device, long flags, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc)
 {
+    if ((flags & TextureFlags::SampleUsage) == 0)
+        return;
+
+    /* Typeless resources, including all depth-stencil textures, require an SRV with explicit format */
+    if (srvDesc == nullptr && ((flags & TextureFlags::MutableFormat) != 0 || DXGetDepthStencilViewFormat(format_) != DXGI_FORMAT_UNKNOWN))
+    {
+        CreateSubresourceSRV(device, srv_.ReleaseAndGetAddressOf(), 0, numMipLevels_, 0, numArrayLayers_);
+        return;
+    }
+
     /* Create internal SRV for entire texture resource */
     auto hr = device->CreateShaderResourceView(
         native_.resource.Get(),
@@ -442,10 +670,11 @@ void D3D11Texture::CreateDefaultSRV(ID3D11Device* device, const D3D11_SHADER_RES
     DXThrowIfFailed(hr, "failed to create D3D11 shader-resouce-view (SRV) for texture");
 }
 
-void D3D11Texture::SetResourceParams(DXGI_FORMAT format, const Extent3D& size, UINT arraySize)
+void D3D11Texture::SetResourceParams(DXGI_FORMAT format, const Extent3D& size, UINT arraySize, UINT mipLevels)
 {
+    /* A number of 0 MIP-map levels denotes the full MIP-chain */
     format_         = format;
-    numMipLevels_   = NumMipLevels(size.width, size.height, size.height);
+    numMipLevels_   = (mipLevels > 0 ? mipLevels : NumMipLevels(size.width, size.height, size.depth));
     numArrayLayers_ = arraySize;
 }
 
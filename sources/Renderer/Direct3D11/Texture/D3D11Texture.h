@@ -43,10 +43,15 @@ class D3D11Texture final : public Texture
 
         D3D11Texture(const TextureType type);
 
+        // Creates a texture view that shares the resource of the specified texture and has its own SRV (component swizzle is not supported).
+        D3D11Texture(ID3D11Device* device, const D3D11Texture& sharedTexture, const TextureViewDescriptor& desc);
+
         Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
 
         TextureDescriptor QueryDesc() const override;
 
+        void SetName(const char* name) override;
+
         /* ----- Extended internal functions ---- */
 
         void CreateTexture1D(
@@ -91,6 +96,44 @@ class D3D11Texture final : public Texture
             UINT                    mipLevel
         ) const;
 
+        // Creates a copy of the specified region of the hardware texture with CPU read access. Each array layer of the region becomes one array layer of the copy.
+        void CreateSubresourceRegionCopyWithCPUAccess(
+            ID3D11Device*           device,
+            ID3D11DeviceContext*    context,
+            D3D11NativeTexture&     textureCopy,
+            UINT                    mipLevel,
+            UINT                    baseArrayLayer,
+            UINT                    numArrayLayers,
+            const D3D11_BOX&        srcBox
+        ) const;
+
+        // Creates a staging texture with CPU read access and the size of the specified region, but does not copy any texel data.
+        void CreateSubresourceRegionStaging(
+            ID3D11Device*           device,
+            D3D11NativeTexture&     textureCopy,
+            UINT                    numArrayLayers,
+            const D3D11_BOX&        srcBox
+        ) const;
+
+        // Copies the specified region of the hardware texture into a staging texture that has been created by 'CreateSubresourceRegionStaging'.
+        void CopySubresourceRegionToStaging(
+            ID3D11DeviceContext*    context,
+            ID3D11Resource*         textureCopy,
+            UINT                    mipLevel,
+            UINT                    baseArrayLayer,
+            UINT                    numArrayLayers,
+            const D3D11_BOX&        srcBox
+        ) const;
+
+        // Converts the texture region into the array layers and box of D3D11 subresources (array layers are specified by the Z component, or Y for 1D-array textures).
+        void GetSubresourceRegion(
+            const Offset3D&         offset,
+            const Extent3D&         extent,
+            UINT&                   baseArrayLayer,
+            UINT&                   numArrayLayers,
+            D3D11_BOX&              box
+        ) const;
+
         // Creates a shader-resource-view (SRV) of a subresource of this texture object.
         void CreateSubresourceSRV(
             ID3D11Device*               device,
@@ -101,6 +144,18 @@ class D3D11Texture final : public Texture
             UINT                        numArrayLayers
         );
 
+        // Creates a shader-resource-view (SRV) of a subresource of this texture object with the specified texture type and format.
+        void CreateSubresourceSRV(
+            ID3D11Device*               device,
+            ID3D11ShaderResourceView**  srvOutput,
+            const TextureType           type,
+            DXGI_FORMAT                 format,
+            UINT                        baseMipLevel,
+            UINT                        numMipLevels,
+            UINT                        baseArrayLayer,
+            UINT                        numArrayLayers
+        );
+
         /* ----- Hardware texture objects ----- */
 
         // Returns the native D3D texture object.
@@ -117,7 +172,7 @@ class D3D11Texture final : public Texture
 
         /* ----- Hardware texture parameters ----- */
 
-        // Returns the hardware resource format.
+        // Returns the hardware resource format (for textures with TextureFlags::MutableFormat, the resource itself has the respective typeless format).
         inline DXGI_FORMAT GetFormat() const
         {
             return format_;
@@ -137,9 +192,9 @@ class D3D11Texture final : public Texture
 
     private:
 
-        void CreateDefaultSRV(ID3D11Device* device, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr);
+        void CreateDefaultSRV(ID3D11Device* device, long flags, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr);
 
-        void SetResourceParams(DXGI_FORMAT format, const Extent3D& size, UINT arraySize);
+        void SetResourceParams(DXGI_FORMAT format, const Extent3D& size, UINT arraySize, UINT mipLevels);
 
         D3D11NativeTexture                  native_;
 
@@ -6,10 +6,13 @@
  */
 
 #include "D3D12Buffer.h"
+#include "../D3D12UploadHeap.h"
+#include "../D3D12BarrierBatch.h"
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Assertion.h"
 #include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
@@ -21,43 +24,41 @@ D3D12Buffer::D3D12Buffer(const BufferType type) :
 {
 }
 
+std::uint64_t D3D12Buffer::GetDeviceAddress() const
+{
+    return GetGPUVirtualAddress();
+}
+
+void D3D12Buffer::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    DXSetObjectName(GetNative(), name);
+    #endif
+}
+
 void D3D12Buffer::UpdateStaticSubresource(
-    ID3D12Device*               device,
     ID3D12GraphicsCommandList*  commandList,
-    ComPtr<ID3D12Resource>&     uploadBuffer,
+    D3D12BarrierBatch&          barriers,
+    D3D12UploadHeap&            uploadHeap,
     const void*                 data,
     UINT64                      bufferSize,
-    UINT64                      offset,
-    D3D12_RESOURCE_STATES       stateAfter)
+    UINT64                      offset)
 {
     LLGL_ASSERT_RANGE(offset + bufferSize, bufferSize_);
 
-    /* Create resource to upload memory from CPU to GPU */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(bufferSize),
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
-    );
+    /* Copy data into a transient region of the upload heap */
+    auto region = uploadHeap.Allocate(bufferSize, 4);
+    ::memcpy(region.mappedData, data, static_cast<std::size_t>(bufferSize));
 
-    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for upload buffer");
+    /* Transition resource for copy operation (together with all pending barriers), if it has already been used */
+    barriers.TransitionResource(resource_.Get(), resourceState_, D3D12_RESOURCE_STATE_COPY_DEST);
+    barriers.FlushForCopy(commandList);
 
-    #ifdef LLGL_DEBUG
-    uploadBuffer->SetName(L"D3D12Buffer.uploadBuffer");
-    #endif
+    /* Copy upload region into destination resource */
+    commandList->CopyBufferRegion(resource_.Get(), allocation_.bufferOffset + offset, region.resource, region.offset, bufferSize);
 
-    /* Copy data into upload buffer, then copy upload buffer into destination resource */
-    D3D12_SUBRESOURCE_DATA subresourceData;
-    {
-        subresourceData.pData       = data;
-        subresourceData.RowPitch    = static_cast<LONG_PTR>(bufferSize);
-        subresourceData.SlicePitch  = subresourceData.RowPitch;
-    }
-    UpdateSubresources<1>(commandList, resource_.Get(), uploadBuffer.Get(), 0, 0, 1, &subresourceData);
-
-    commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(resource_.Get(), D3D12_RESOURCE_STATE_COPY_DEST, stateAfter));
+    /* Begin transition back into usage state with the next flush of the barrier batch, so it can overlap subsequent copy operations */
+    BeginTransitionToUsageState(barriers);
 }
 
 void D3D12Buffer::UpdateDynamicSubresource(const void* data, UINT64 bufferSize, UINT64 offset)
@@ -67,39 +68,77 @@ void D3D12Buffer::UpdateDynamicSubresource(const void* data, UINT64 bufferSize,
     auto hr = resource_->Map(0, nullptr, &dest);
     DXThrowIfFailed(hr, "failed to map D3D12 resource");
     {
-        ::memcpy((reinterpret_cast<char*>(dest) + offset), data, static_cast<std::size_t>(bufferSize));
+        ::memcpy((reinterpret_cast<char*>(dest) + allocation_.bufferOffset + offset), data, static_cast<std::size_t>(bufferSize));
     }
     resource_->Unmap(0, nullptr);
 }
 
+void D3D12Buffer::ResolveQueryData(
+    ID3D12GraphicsCommandList*  commandList,
+    D3D12BarrierBatch&          barriers,
+    ID3D12QueryHeap*            queryHeap,
+    D3D12_QUERY_TYPE            queryType,
+    UINT                        startIndex,
+    UINT                        numQueries,
+    UINT64                      offset)
+{
+    LLGL_ASSERT_RANGE(offset + numQueries * sizeof(UINT64), bufferSize_);
+
+    if (IsHostVisible())
+        throw std::runtime_error("cannot resolve D3D12 query data into buffer of upload heap");
+
+    /* Transition resource for resolve operation (together with all pending barriers), if it has already been used */
+    barriers.TransitionResource(resource_.Get(), resourceState_, D3D12_RESOURCE_STATE_COPY_DEST);
+    barriers.FlushForCopy(commandList);
+
+    /* Resolve query data into destination resource */
+    commandList->ResolveQueryData(queryHeap, queryType, startIndex, numQueries, resource_.Get(), allocation_.bufferOffset + offset);
+
+    /* Begin transition back into usage state with the next flush of the barrier batch, so it can overlap subsequent copy operations */
+    BeginTransitionToUsageState(barriers);
+}
+
+void D3D12Buffer::TransitionResource(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState)
+{
+    if (!IsHostVisible())
+        barriers.TransitionResource(resource_.Get(), resourceState_, newState);
+}
+
+void D3D12Buffer::TransitionToUsageState(D3D12BarrierBatch& barriers)
+{
+    TransitionResource(barriers, usageState_);
+}
+
+void D3D12Buffer::BeginTransitionToUsageState(D3D12BarrierBatch& barriers)
+{
+    if (!IsHostVisible())
+        barriers.BeginTransition(resource_.Get(), resourceState_, usageState_);
+}
+
 
 /*
  * ======= Protected: =======
  */
 
-void D3D12Buffer::CreateResource(ID3D12Device* device, UINT64 bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState)
+void D3D12Buffer::CreateResource(D3D12MemoryAllocator& allocator, UINT64 bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState)
 {
-    bufferSize_ = bufferSize;
-
-    /* Create generic buffer resource */
-    CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
-    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize_);
-
-    auto hr = device->CreateCommittedResource(
-        &heapProperties,
-        D3D12_HEAP_FLAG_NONE,
-        &bufferDesc,
-        resourceState, // initial resource state
-        nullptr,
-        IID_PPV_ARGS(resource_.ReleaseAndGetAddressOf())
-    );
-
-    DXThrowIfFailed(hr, "failed to create comitted resource for D3D12 hardware buffer");
+    bufferSize_     = bufferSize;
+    heapType_       = heapType;
+    resourceState_  = resourceState;
+    usageState_     = resourceState;
+
+    /* Create generic buffer resource (placed within a heap, or sub-allocated from a shared buffer) */
+    resource_ = allocator.CreateBuffer(bufferSize_, heapType, resourceState, allocation_);
 }
 
-void D3D12Buffer::CreateResource(ID3D12Device* device, UINT64 bufferSize)
+void D3D12Buffer::CreateResource(D3D12MemoryAllocator& allocator, UINT64 bufferSize, D3D12_RESOURCE_STATES usageState, long bufferFlags)
 {
-    CreateResource(device, bufferSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COPY_DEST);
+    CreateResource(allocator, bufferSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COPY_DEST);
+    usageState_ = usageState;
+
+    /* Indirect arguments are read in the read-only state they are combined with */
+    if ((bufferFlags & BufferFlags::IndirectArguments) != 0)
+        usageState_ |= D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
 }
 
 
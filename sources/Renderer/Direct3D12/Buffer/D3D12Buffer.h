@@ -11,6 +11,7 @@
 
 #include <LLGL/Buffer.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../D3D12MemoryAllocator.h"
 #include <d3d12.h>
 
 
@@ -18,46 +19,111 @@ namespace LLGL
 {
 
 
+class D3D12UploadHeap;
+class D3D12BarrierBatch;
+
 class D3D12Buffer : public Buffer
 {
 
     public:
 
+        std::uint64_t GetDeviceAddress() const override;
+
+        void SetName(const char* name) override;
+
+        // Copies the data into a region of the upload heap and records a copy command into the command list.
+        // The transition back into the usage state is appended to the barrier batch, which must be flushed before the buffer is used.
         void UpdateStaticSubresource(
-            ID3D12Device*               device,
             ID3D12GraphicsCommandList*  commandList,
-            ComPtr<ID3D12Resource>&     uploadBuffer,
+            D3D12BarrierBatch&          barriers,
+            D3D12UploadHeap&            uploadHeap,
             const void*                 data,
             UINT64                      bufferSize,
-            UINT64                      offset,
-            D3D12_RESOURCE_STATES       stateAfter
+            UINT64                      offset
         );
 
         void UpdateDynamicSubresource(const void* data, UINT64 bufferSize, UINT64 offset);
 
-        //! Returns the native ID3D12Resource object.
+        // Records a command into the command list to resolve the results of the specified queries into this buffer.
+        void ResolveQueryData(
+            ID3D12GraphicsCommandList*  commandList,
+            D3D12BarrierBatch&          barriers,
+            ID3D12QueryHeap*            queryHeap,
+            D3D12_QUERY_TYPE            queryType,
+            UINT                        startIndex,
+            UINT                        numQueries,
+            UINT64                      offset
+        );
+
+        // Appends a transition into the specified state to the barrier batch. Buffers in an upload heap always remain in their initial state.
+        void TransitionResource(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState);
+
+        // Appends a transition back into the usage state to the barrier batch.
+        void TransitionToUsageState(D3D12BarrierBatch& barriers);
+
+        // Appends the beginning of a split transition back into the usage state to the barrier batch, which ends with the next full flush.
+        void BeginTransitionToUsageState(D3D12BarrierBatch& barriers);
+
+        // Returns true if this buffer resides in an upload heap, i.e. it can be updated with 'UpdateDynamicSubresource'.
+        inline bool IsHostVisible() const
+        {
+            return (heapType_ == D3D12_HEAP_TYPE_UPLOAD);
+        }
+
+        //! Returns the native ID3D12Resource object, which is shared with other buffers if this buffer has been sub-allocated.
         inline ID3D12Resource* GetNative() const
         {
             return resource_.Get();
         }
 
+        // Returns the offset (in bytes) of this buffer within its native resource.
+        inline UINT64 GetOffset() const
+        {
+            return allocation_.bufferOffset;
+        }
+
+        // Returns the GPU virtual address of the start of this buffer.
+        inline D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+        {
+            return (resource_->GetGPUVirtualAddress() + allocation_.bufferOffset);
+        }
+
         //! Returns the size (in bytes) of the hardware buffer.
         inline UINT64 GetBufferSize() const
         {
             return bufferSize_;
         }
 
+        // Returns the memory allocation of this buffer, which must be released with the memory allocator.
+        inline D3D12MemoryAllocation& GetMemoryAllocation()
+        {
+            return allocation_;
+        }
+
+        // Returns the residency state of the memory of this buffer, which is only tracked for buffers in the default heap.
+        inline D3D12ResidencyEntry* GetResidencyEntry() const
+        {
+            return allocation_.residencyEntry;
+        }
+
     protected:
 
         D3D12Buffer(const BufferType type);
 
-        void CreateResource(ID3D12Device* device, UINT64 bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState);
-        void CreateResource(ID3D12Device* device, UINT64 bufferSize);
+        void CreateResource(D3D12MemoryAllocator& allocator, UINT64 bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState);
+
+        // Creates the resource in the default heap, which is transitioned into the specified usage state after each update.
+        // The usage state is extended by the state for indirect arguments, if the buffer flags contain BufferFlags::IndirectArguments.
+        void CreateResource(D3D12MemoryAllocator& allocator, UINT64 bufferSize, D3D12_RESOURCE_STATES usageState, long bufferFlags = 0);
 
     private:
 
         ComPtr<ID3D12Resource>  resource_;
-        UINT64                  bufferSize_ = 0;
+        UINT64                  bufferSize_     = 0;
+        D3D12_HEAP_TYPE         heapType_       = D3D12_HEAP_TYPE_DEFAULT;
+        D3D12_RESOURCE_STATES   resourceState_  = D3D12_RESOURCE_STATE_COMMON;
+        D3D12_RESOURCE_STATES   usageState_     = D3D12_RESOURCE_STATE_COMMON;
+        D3D12MemoryAllocation   allocation_;
 
 };
 
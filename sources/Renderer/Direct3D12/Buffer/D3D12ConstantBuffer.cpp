@@ -13,10 +13,10 @@ namespace LLGL
 {
 
 
-D3D12ConstantBuffer::D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc) :
+D3D12ConstantBuffer::D3D12ConstantBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc) :
     D3D12Buffer { BufferType::Constant }
 {
-    CreateResourceWithAlignment(device, static_cast<UINT>(desc.size));
+    CreateResourceWithAlignment(allocator, static_cast<UINT>(desc.size));
 }
 
 void D3D12ConstantBuffer::UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset)
@@ -29,7 +29,7 @@ void D3D12ConstantBuffer::CreateResourceView(ID3D12Device* device, D3D12_CPU_DES
     /* Create constant buffer view (CBV) */
     D3D12_CONSTANT_BUFFER_VIEW_DESC viewDesc;
     {
-        viewDesc.BufferLocation = GetNative()->GetGPUVirtualAddress();
+        viewDesc.BufferLocation = GetGPUVirtualAddress();
         viewDesc.SizeInBytes    = bufferSize_;
     }
     device->CreateConstantBufferView(&viewDesc, cpuDescriptorHandle);
@@ -40,14 +40,14 @@ void D3D12ConstantBuffer::CreateResourceView(ID3D12Device* device, D3D12_CPU_DES
  * ======= Private: =======
  */
 
-void D3D12ConstantBuffer::CreateResourceWithAlignment(ID3D12Device* device, UINT bufferSize)
+void D3D12ConstantBuffer::CreateResourceWithAlignment(D3D12MemoryAllocator& allocator, UINT bufferSize)
 {
     /* Constant buffers are required to be 256-byte aligned */
     static const UINT alignment = 256;
     bufferSize_ = GetAlignedSize(bufferSize, alignment);
 
     /* Create hardware resource */
-    CreateResource(device, bufferSize_, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    CreateResource(allocator, bufferSize_, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
 }
 
 
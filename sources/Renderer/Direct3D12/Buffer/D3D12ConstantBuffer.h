@@ -21,7 +21,7 @@ class D3D12ConstantBuffer final : public D3D12Buffer
 
     public:
 
-        D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12ConstantBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc);
 
         void UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset = 0);
 
@@ -29,7 +29,7 @@ class D3D12ConstantBuffer final : public D3D12Buffer
 
     private:
 
-        void CreateResourceWithAlignment(ID3D12Device* device, UINT bufferSize);
+        void CreateResourceWithAlignment(D3D12MemoryAllocator& allocator, UINT bufferSize);
 
         UINT bufferSize_ = 0;
 
@@ -14,28 +14,17 @@ namespace LLGL
 {
 
 
-D3D12IndexBuffer::D3D12IndexBuffer(ID3D12Device* device, const BufferDescriptor& desc) :
+D3D12IndexBuffer::D3D12IndexBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc) :
     D3D12Buffer { BufferType::Index }
 {
     /* Create resource and initialize buffer view */
-    CreateResource(device, desc.size);
+    CreateResource(allocator, desc.size, D3D12_RESOURCE_STATE_INDEX_BUFFER, desc.flags);
 
-    view_.BufferLocation    = GetNative()->GetGPUVirtualAddress();
+    view_.BufferLocation    = GetGPUVirtualAddress();
     view_.SizeInBytes       = static_cast<UINT>(GetBufferSize());
     view_.Format            = D3D12Types::Map(desc.indexBuffer.format.GetDataType());
 }
 
-void D3D12IndexBuffer::UpdateSubresource(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer,
-    const void* data, UINT bufferSize, UINT64 offset)
-{
-    UpdateStaticSubresource(
-        device, commandList, uploadBuffer,
-        data, bufferSize, offset,
-        D3D12_RESOURCE_STATE_INDEX_BUFFER
-    );
-}
-
 
 } // /namespace LLGL
 
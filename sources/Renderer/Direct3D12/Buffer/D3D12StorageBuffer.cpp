@@ -12,7 +12,7 @@ namespace LLGL
 {
 
 
-D3D12StorageBuffer::D3D12StorageBuffer(ID3D12Device* device, const BufferDescriptor& desc) :
+D3D12StorageBuffer::D3D12StorageBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc) :
     D3D12Buffer { BufferType::Storage }
 {
     //todo...
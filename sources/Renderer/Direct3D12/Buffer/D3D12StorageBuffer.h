@@ -21,7 +21,7 @@ class D3D12StorageBuffer final : public D3D12Buffer
 
     public:
 
-        D3D12StorageBuffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12StorageBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc);
 
 };
 
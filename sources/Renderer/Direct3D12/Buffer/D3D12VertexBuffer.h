@@ -21,16 +21,7 @@ class D3D12VertexBuffer final : public D3D12Buffer
 
     public:
 
-        D3D12VertexBuffer(ID3D12Device* device, const BufferDescriptor& desc);
-
-        void UpdateSubresource(
-            ID3D12Device*               device,
-            ID3D12GraphicsCommandList*  commandList,
-            ComPtr<ID3D12Resource>&     uploadBuffer,
-            const void*                 data,
-            UINT                        bufferSize,
-            UINT64                      offset = 0
-        );
+        D3D12VertexBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc);
 
         inline const D3D12_VERTEX_BUFFER_VIEW& GetView() const
         {
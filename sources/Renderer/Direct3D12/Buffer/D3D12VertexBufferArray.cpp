@@ -20,8 +20,12 @@ D3D12VertexBufferArray::D3D12VertexBufferArray(std::uint32_t numBuffers, Buffer*
 {
     /* Store the strides and offests of each D3D12VertexBuffer inside the arrays */
     views_.reserve(numBuffers);
+    residencyEntries_.reserve(numBuffers);
     while (auto next = NextArrayResource<D3D12VertexBuffer>(numBuffers, bufferArray))
+    {
         views_.push_back(next->GetView());
+        residencyEntries_.push_back(next->GetResidencyEntry());
+    }
 }
 
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/BufferArray.h>
+#include "../D3D12ResidencyManager.h"
 #include <d3d12.h>
 #include <vector>
 
@@ -33,9 +34,16 @@ class D3D12VertexBufferArray final : public BufferArray
             return views_;
         }
 
+        // Returns the residency entries of all vertex buffers.
+        inline const std::vector<D3D12ResidencyEntry*>& GetResidencyEntries() const
+        {
+            return residencyEntries_;
+        }
+
     private:
 
-        std::vector<D3D12_VERTEX_BUFFER_VIEW> views_;
+        std::vector<D3D12_VERTEX_BUFFER_VIEW>   views_;
+        std::vector<D3D12ResidencyEntry*>       residencyEntries_;
 
 };
 
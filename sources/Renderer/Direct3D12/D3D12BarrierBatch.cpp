@@ -0,0 +1,138 @@
+/*
+ * D3D12BarrierBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12BarrierBatch.h"
+
+
+namespace LLGL
+{
+
+
+static D3D12_RESOURCE_BARRIER MakeTransitionBarrier(
+    ID3D12Resource*                 resource,
+    D3D12_RESOURCE_STATES           stateBefore,
+    D3D12_RESOURCE_STATES           stateAfter,
+    D3D12_RESOURCE_BARRIER_FLAGS    flags)
+{
+    D3D12_RESOURCE_BARRIER barrier;
+    {
+        barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags                   = flags;
+        barrier.Transition.pResource    = resource;
+        barrier.Transition.Subresource  = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.StateBefore  = stateBefore;
+        barrier.Transition.StateAfter   = stateAfter;
+    }
+    return barrier;
+}
+
+void D3D12BarrierBatch::TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES& trackedState, D3D12_RESOURCE_STATES newState)
+{
+    /* The resource is about to be accessed, so its split transition must end first */
+    EndTransition(resource);
+
+    if (trackedState == newState)
+        return;
+
+    /* Merge with the pending full transition of the same resource, which always ends in the tracked state */
+    for (auto it = barriers_.begin(); it != barriers_.end(); ++it)
+    {
+        auto& transition = it->Transition;
+        if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && it->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && transition.pResource == resource)
+        {
+            if (transition.StateBefore == newState)
+                barriers_.erase(it);
+            else
+                transition.StateAfter = newState;
+            trackedState = newState;
+            return;
+        }
+    }
+
+    /* Append new transition barrier */
+    barriers_.push_back(MakeTransitionBarrier(resource, trackedState, newState, D3D12_RESOURCE_BARRIER_FLAG_NONE));
+
+    trackedState = newState;
+}
+
+void D3D12BarrierBatch::BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES& trackedState, D3D12_RESOURCE_STATES newState)
+{
+    EndTransition(resource);
+
+    if (trackedState == newState)
+        return;
+
+    /* A pending full transition of the same resource cannot be split anymore, so merge with it instead */
+    for (const auto& barrier : barriers_)
+    {
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && barrier.Transition.pResource == resource)
+        {
+            TransitionResource(resource, trackedState, newState);
+            return;
+        }
+    }
+
+    /* Append begin barrier and remember the transition for its end barrier */
+    auto barrier = MakeTransitionBarrier(resource, trackedState, newState, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+    barriers_.push_back(barrier);
+    splitTransitions_.push_back(barrier.Transition);
+
+    trackedState = newState;
+}
+
+void D3D12BarrierBatch::Flush(ID3D12GraphicsCommandList* commandList)
+{
+    while (!splitTransitions_.empty())
+        EndTransition(splitTransitions_.back().pResource);
+    FlushForCopy(commandList);
+}
+
+void D3D12BarrierBatch::FlushForCopy(ID3D12GraphicsCommandList* commandList)
+{
+    if (!barriers_.empty())
+    {
+        commandList->ResourceBarrier(static_cast<UINT>(barriers_.size()), barriers_.data());
+        barriers_.clear();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12BarrierBatch::EndTransition(ID3D12Resource* resource)
+{
+    for (auto it = splitTransitions_.begin(); it != splitTransitions_.end(); ++it)
+    {
+        if (it->pResource == resource)
+        {
+            /* If the begin barrier has not been recorded yet, there is nothing to overlap, so it becomes a full transition */
+            for (auto& barrier : barriers_)
+            {
+                if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY && barrier.Transition.pResource == resource)
+                {
+                    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                    splitTransitions_.erase(it);
+                    return;
+                }
+            }
+
+            /* Append end barrier with the same states as the begin barrier */
+            barriers_.push_back(MakeTransitionBarrier(resource, it->StateBefore, it->StateAfter, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+            splitTransitions_.erase(it);
+            return;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
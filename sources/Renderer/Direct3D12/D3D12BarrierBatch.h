@@ -0,0 +1,73 @@
+/*
+ * D3D12BarrierBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_BARRIER_BATCH_H
+#define LLGL_D3D12_BARRIER_BATCH_H
+
+
+#include <d3d12.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Collects resource transitions, which are recorded with a single 'ResourceBarrier' call by 'Flush'.
+The current state of each resource is tracked by its owner and passed by reference, so redundant transitions are skipped,
+consecutive transitions of the same resource are merged (A -> B -> C becomes A -> C), and round trips (A -> B -> A) are removed.
+Split transitions begin with the next flush and end with the next transition of the same resource or the next full flush,
+so a transition can overlap unrelated copy operations in between.
+*/
+class D3D12BarrierBatch
+{
+
+    public:
+
+        // Appends a transition of all subresources of the specified resource into the new state, and updates the tracked state.
+        void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES& trackedState, D3D12_RESOURCE_STATES newState);
+
+        /*
+        Appends the beginning of a split transition of all subresources of the specified resource into the new state, and updates the tracked state.
+        The resource must not be accessed until the transition has ended, i.e. until the next transition of this resource or the next call to 'Flush'.
+        */
+        void BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES& trackedState, D3D12_RESOURCE_STATES newState);
+
+        // Ends all split transitions, records all pending barriers into the specified command list, and clears the batch.
+        void Flush(ID3D12GraphicsCommandList* commandList);
+
+        // Records all pending barriers into the specified command list, but keeps split transitions open, since copy operations only access their own resources.
+        void FlushForCopy(ID3D12GraphicsCommandList* commandList);
+
+        // Returns true if there are no pending barriers and no open split transitions.
+        inline bool IsEmpty() const
+        {
+            return (barriers_.empty() && splitTransitions_.empty());
+        }
+
+    private:
+
+        // Ends the open split transition of the specified resource (if any).
+        void EndTransition(ID3D12Resource* resource);
+
+    private:
+
+        std::vector<D3D12_RESOURCE_BARRIER>             barriers_;
+        std::vector<D3D12_RESOURCE_TRANSITION_BARRIER>  splitTransitions_;  // Open split transitions, whose end barriers have not been appended yet
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
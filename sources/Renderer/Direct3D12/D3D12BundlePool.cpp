@@ -0,0 +1,119 @@
+/*
+ * D3D12BundlePool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12BundlePool.h"
+#include "D3D12RenderSystem.h"
+#include "../DXCommon/DXCore.h"
+#include "../../Core/Helper.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+D3D12BundlePool::D3D12BundlePool(D3D12RenderSystem& renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+D3D12BundlePool::~D3D12BundlePool()
+{
+    /* Ensure the GPU is no longer executing any of the bundles */
+    UINT64 fenceValue = 0;
+    for (const auto& bundle : bundles_)
+        fenceValue = std::max(fenceValue, bundle->fenceValue);
+    renderSystem_.WaitForFenceValue(fenceValue);
+}
+
+ID3D12GraphicsCommandList* D3D12BundlePool::Acquire()
+{
+    Bundle* bundle = nullptr;
+
+    /* Find bundle that is neither referenced nor in flight */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        const auto completedValue = renderSystem_.GetCompletedFenceValue();
+        for (const auto& entry : bundles_)
+        {
+            if (entry->refCount == 0 && entry->fenceValue <= completedValue)
+            {
+                bundle = entry.get();
+                bundle->refCount = 1;
+                break;
+            }
+        }
+    }
+
+    if (bundle != nullptr)
+    {
+        /* Reset command allocator and bundle for the next recording */
+        auto hr = bundle->commandAlloc->Reset();
+        DXThrowIfFailed(hr, "failed to reset D3D12 command allocator for bundle");
+
+        hr = bundle->commandList->Reset(bundle->commandAlloc.Get(), nullptr);
+        DXThrowIfFailed(hr, "failed to reset D3D12 bundle");
+
+        return bundle->commandList.Get();
+    }
+
+    /* Create new bundle, which is created in recording state */
+    auto newBundle = MakeUnique<Bundle>();
+    {
+        newBundle->commandAlloc = renderSystem_.CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE);
+        newBundle->commandList  = renderSystem_.CreateDXCommandList(D3D12_COMMAND_LIST_TYPE_BUNDLE, newBundle->commandAlloc.Get());
+        newBundle->refCount     = 1;
+        newBundle->fenceValue   = 0;
+    }
+    auto commandList = newBundle->commandList.Get();
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+    bundles_.push_back(std::move(newBundle));
+
+    return commandList;
+}
+
+void D3D12BundlePool::AddRef(ID3D12GraphicsCommandList* commandList)
+{
+    std::lock_guard<std::mutex> lock { mutex_ };
+    if (auto bundle = FindBundle(commandList))
+        ++bundle->refCount;
+}
+
+void D3D12BundlePool::Release(ID3D12GraphicsCommandList* commandList, UINT64 fenceValue)
+{
+    std::lock_guard<std::mutex> lock { mutex_ };
+    if (auto bundle = FindBundle(commandList))
+    {
+        bundle->fenceValue = std::max(bundle->fenceValue, fenceValue);
+        if (bundle->refCount > 0)
+            --bundle->refCount;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+D3D12BundlePool::Bundle* D3D12BundlePool::FindBundle(ID3D12GraphicsCommandList* commandList)
+{
+    for (const auto& bundle : bundles_)
+    {
+        if (bundle->commandList.Get() == commandList)
+            return bundle.get();
+    }
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,86 @@
+/*
+ * D3D12BundlePool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_BUNDLE_POOL_H
+#define LLGL_D3D12_BUNDLE_POOL_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+
+/*
+Pool of bundles (command allocator and command list pairs) for a single secondary D3D12CommandBuffer instance.
+Each secondary command buffer has its own pool, so it can be recorded on a worker thread without any synchronization with other command buffers.
+Bundles are reference counted: a recording is referenced by its secondary command buffer until the next recording begins,
+and by each primary command buffer that executes it until it has been submitted. A bundle is recycled once it is no longer referenced
+and the GPU has reached the highest fence value it has been submitted with.
+*/
+class D3D12BundlePool
+{
+
+    public:
+
+        D3D12BundlePool(D3D12RenderSystem& renderSystem);
+        ~D3D12BundlePool();
+
+        D3D12BundlePool(const D3D12BundlePool&) = delete;
+        D3D12BundlePool& operator = (const D3D12BundlePool&) = delete;
+
+        // Returns a bundle in recording state with a reference count of 1. Must only be called by the owner of this pool.
+        ID3D12GraphicsCommandList* Acquire();
+
+        // Increments the reference count of the specified bundle.
+        void AddRef(ID3D12GraphicsCommandList* commandList);
+
+        // Decrements the reference count of the specified bundle, which must not be recycled before the specified fence value has been reached.
+        void Release(ID3D12GraphicsCommandList* commandList, UINT64 fenceValue);
+
+    private:
+
+        struct Bundle
+        {
+            ComPtr<ID3D12CommandAllocator>      commandAlloc;
+            ComPtr<ID3D12GraphicsCommandList>   commandList;
+            UINT                                refCount;
+            UINT64                              fenceValue;
+        };
+
+        Bundle* FindBundle(ID3D12GraphicsCommandList* commandList);
+
+        D3D12RenderSystem&                  renderSystem_;
+
+        std::mutex                          mutex_;
+        std::vector<std::unique_ptr<Bundle>> bundles_;
+
+};
+
+// Reference to a bundle recording, which has been executed by a primary command buffer.
+struct D3D12BundleRef
+{
+    std::shared_ptr<D3D12BundlePool>    pool;
+    ID3D12GraphicsCommandList*          commandList;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
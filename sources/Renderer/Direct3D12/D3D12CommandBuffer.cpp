@@ -9,9 +9,13 @@
 #include "D3D12RenderContext.h"
 #include "D3D12RenderSystem.h"
 #include "D3D12Types.h"
+#include "../DXCommon/DXTypes.h"
 #include "../CheckedCast.h"
 #include "../../Core/Helper.h"
 #include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include "D3DX12/d3dx12.h"
 
 #include "Buffer/D3D12VertexBuffer.h"
@@ -23,15 +27,49 @@
 #include "Texture/D3D12Texture.h"
 
 #include "RenderState/D3D12ResourceHeap.h"
+#include "RenderState/D3D12QueryHeap.h"
+#include "RenderState/D3D12IndirectCommandLayout.h"
+#include "RenderState/D3D12AccelerationStructure.h"
 
 
 namespace LLGL
 {
 
 
-D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem)
+D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem, D3D12_COMMAND_LIST_TYPE type, long flags) :
+    renderSystem_ { renderSystem                        },
+    statistics_   { renderSystem.GetStatisticsCounter() },
+    device_       { renderSystem.GetDevice()            }
 {
-    CreateDevices(renderSystem);
+    descriptorRings_[0] = &(renderSystem.GetDescriptorHeapRingCbvSrvUav());
+    descriptorRings_[1] = &(renderSystem.GetDescriptorHeapRingSampler());
+
+    if (type == D3D12_COMMAND_LIST_TYPE_BUNDLE)
+        bundlePool_ = std::make_shared<D3D12BundlePool>(renderSystem);
+    else
+    {
+        CreateDevices(renderSystem, type);
+        CreateTimerQueryHeap(renderSystem);
+        if ((flags & CommandBufferFlags::TimerScopeStatistics) != 0)
+            CreateStatisticsQueryHeap();
+    }
+}
+
+D3D12CommandBuffer::~D3D12CommandBuffer()
+{
+    /* Bundles that have never been submitted are not in flight */
+    SubmitExecutedBundles(0);
+
+    /* Release current recording; it remains alive as long as the bundle pool is referenced */
+    if (IsBundle() && commandList_)
+        bundlePool_->Release(commandList_.Get(), 0);
+
+    /* Release transient memory; command buffers are only destroyed once the GPU has completed their submissions */
+    if (transientBuffer_)
+    {
+        transientBuffer_->GetNative()->Unmap(0, nullptr);
+        renderSystem_.GetMemoryAllocator().Free(transientBuffer_->GetMemoryAllocation());
+    }
 }
 
 /* ----- Configuration ----- */
@@ -50,41 +88,61 @@ void D3D12CommandBuffer::SetViewport(const Viewport& viewport)
 
 void D3D12CommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
+    /* Bundles inherit viewports from the executing command list */
+    if (IsBundle())
+        return;
+
     numViewports = std::min(numViewports, std::uint32_t(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
 
-    /* Check if D3D12_VIEWPORT and Viewport structures can be safely reinterpret-casted */
-    if ( sizeof(D3D12_VIEWPORT)             == sizeof(Viewport)             &&
-         offsetof(D3D12_VIEWPORT, TopLeftX) == offsetof(Viewport, x       ) &&
-         offsetof(D3D12_VIEWPORT, TopLeftY) == offsetof(Viewport, y       ) &&
-         offsetof(D3D12_VIEWPORT, Width   ) == offsetof(Viewport, width   ) &&
-         offsetof(D3D12_VIEWPORT, Height  ) == offsetof(Viewport, height  ) &&
-         offsetof(D3D12_VIEWPORT, MinDepth) == offsetof(Viewport, minDepth) &&
-         offsetof(D3D12_VIEWPORT, MaxDepth) == offsetof(Viewport, maxDepth) )
-    {
-        /* Now it's safe to reinterpret cast the viewports into D3D viewports */
-        commandList_->RSSetViewports(numViewports, reinterpret_cast<const D3D12_VIEWPORT*>(viewports));
-    }
-    else
-    {
-        /* Convert viewport into D3D viewport */
-        D3D12_VIEWPORT viewportsD3D[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    /* Ignore redundant updates of a single viewport */
+    const bool viewportCached =
+    (
+        numViewports == 1 &&
+        bindingCache_.viewportValid &&
+        ::memcmp(&bindingCache_.viewport, viewports, sizeof(Viewport)) == 0
+    );
 
-        for (std::uint32_t i = 0; i < numViewports; ++i)
+    if (!viewportCached)
+    {
+        /* Check if D3D12_VIEWPORT and Viewport structures can be safely reinterpret-casted */
+        if ( sizeof(D3D12_VIEWPORT)             == sizeof(Viewport)             &&
+             offsetof(D3D12_VIEWPORT, TopLeftX) == offsetof(Viewport, x       ) &&
+             offsetof(D3D12_VIEWPORT, TopLeftY) == offsetof(Viewport, y       ) &&
+             offsetof(D3D12_VIEWPORT, Width   ) == offsetof(Viewport, width   ) &&
+             offsetof(D3D12_VIEWPORT, Height  ) == offsetof(Viewport, height  ) &&
+             offsetof(D3D12_VIEWPORT, MinDepth) == offsetof(Viewport, minDepth) &&
+             offsetof(D3D12_VIEWPORT, MaxDepth) == offsetof(Viewport, maxDepth) )
         {
-            const auto& src = viewports[i];
-            auto& dest = viewportsD3D[i];
-
-            dest.TopLeftX   = src.x;
-            dest.TopLeftY   = src.y;
-            dest.Width      = src.width;
-            dest.Height     = src.height;
-            dest.MinDepth   = src.minDepth;
-            dest.MaxDepth   = src.maxDepth;
+            /* Now it's safe to reinterpret cast the viewports into D3D viewports */
+            commandList_->RSSetViewports(numViewports, reinterpret_cast<const D3D12_VIEWPORT*>(viewports));
+        }
+        else
+        {
+            /* Convert viewport into D3D viewport */
+            D3D12_VIEWPORT viewportsD3D[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+
+            for (std::uint32_t i = 0; i < numViewports; ++i)
+            {
+                const auto& src = viewports[i];
+                auto& dest = viewportsD3D[i];
+
+                dest.TopLeftX   = src.x;
+                dest.TopLeftY   = src.y;
+                dest.Width      = src.width;
+                dest.Height     = src.height;
+                dest.MinDepth   = src.minDepth;
+                dest.MaxDepth   = src.maxDepth;
+            }
+
+            commandList_->RSSetViewports(numViewports, viewportsD3D);
         }
-
-        commandList_->RSSetViewports(numViewports, viewportsD3D);
     }
 
+    /* Only single viewports are cached */
+    bindingCache_.viewportValid = (numViewports == 1);
+    if (bindingCache_.viewportValid)
+        bindingCache_.viewport = viewports[0];
+
     /* If scissor test is disabled, update remaining scissor rectangles to extent of active framebuffer */
     if (!scissorEnabled_)
         SetScissorRectsWithFramebufferExtent(numViewports);
@@ -97,7 +155,7 @@ void D3D12CommandBuffer::SetScissor(const Scissor& scissor)
 
 void D3D12CommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
-    if (scissorEnabled_)
+    if (scissorEnabled_ && !IsBundle())
     {
         numScissors = std::min(numScissors, std::uint32_t(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
 
@@ -137,6 +195,12 @@ void D3D12CommandBuffer::SetClearStencil(std::uint32_t stencil)
 
 void D3D12CommandBuffer::Clear(long flags)
 {
+    /* Bundles cannot clear render targets */
+    if (IsBundle())
+        return;
+
+    FlushResourceBarriers();
+
     if (rtvDescHandle_.ptr != 0)
     {
         /* Clear color buffers */
@@ -178,36 +242,98 @@ void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 /* ----- Buffers ------ */
 
 void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    D3D12CommandBuffer::SetVertexBuffer(buffer, 0);
+}
+
+void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
 {
     auto& vertexBufferD3D = LLGL_CAST(D3D12VertexBuffer&, buffer);
-    commandList_->IASetVertexBuffers(0, 1, &(vertexBufferD3D.GetView()));
+    TrackResidency(vertexBufferD3D.GetResidencyEntry());
+
+    if (bindingCache_.vertexBuffers == &vertexBufferD3D && bindingCache_.vertexBufferOffset == offset)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    /* Move start of vertex buffer view by the offset */
+    auto view = vertexBufferD3D.GetView();
+    view.BufferLocation += offset;
+    view.SizeInBytes    -= static_cast<UINT>(offset);
+
+    commandList_->IASetVertexBuffers(0, 1, &view);
+
+    bindingCache_.vertexBuffers         = &vertexBufferD3D;
+    bindingCache_.vertexBufferOffset    = offset;
 }
 
 void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& vertexBufferArrayD3D = LLGL_CAST(D3D12VertexBufferArray&, bufferArray);
+    TrackResidency(vertexBufferArrayD3D.GetResidencyEntries());
+
+    if (bindingCache_.vertexBuffers == &vertexBufferArrayD3D)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
     commandList_->IASetVertexBuffers(
         0,
         static_cast<UINT>(vertexBufferArrayD3D.GetViews().size()),
         vertexBufferArrayD3D.GetViews().data()
     );
+
+    bindingCache_.vertexBuffers         = &vertexBufferArrayD3D;
+    bindingCache_.vertexBufferOffset    = 0;
 }
 
 void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
     auto& indexBufferD3D = LLGL_CAST(D3D12IndexBuffer&, buffer);
-    commandList_->IASetIndexBuffer(&(indexBufferD3D.GetView()));
+    TrackResidency(indexBufferD3D.GetResidencyEntry());
+    SetIndexBufferView(indexBufferD3D.GetView());
+}
+
+void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    auto& indexBufferD3D = LLGL_CAST(D3D12IndexBuffer&, buffer);
+    TrackResidency(indexBufferD3D.GetResidencyEntry());
+
+    /* Move start of index buffer view by the offset and override its format */
+    auto view = indexBufferD3D.GetView();
+    view.BufferLocation += offset;
+    view.SizeInBytes    -= static_cast<UINT>(offset);
+    view.Format          = D3D12Types::Map(format.GetDataType());
+
+    SetIndexBufferView(view);
+}
+
+//private
+void D3D12CommandBuffer::SetIndexBufferView(const D3D12_INDEX_BUFFER_VIEW& view)
+{
+    const auto& cachedView = bindingCache_.indexBufferView;
+    if (cachedView.BufferLocation == view.BufferLocation && cachedView.SizeInBytes == view.SizeInBytes && cachedView.Format == view.Format)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    commandList_->IASetIndexBuffer(&view);
+    bindingCache_.indexBufferView = view;
 }
 
 /* ----- Stream Output Buffers ------ */
 
 void D3D12CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     //todo...
 }
 
 void D3D12CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     //todo...
 }
 
@@ -221,41 +347,173 @@ void D3D12CommandBuffer::EndStreamOutput()
     // dummy
 }
 
+void D3D12CommandBuffer::PauseStreamOutput()
+{
+    //todo...
+}
+
+void D3D12CommandBuffer::ResumeStreamOutput()
+{
+    //todo...
+}
+
 /* ----- Resource Heaps ----- */
 
-void D3D12CommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void D3D12CommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
-    /* Get descriptor heaps */
+    LLGL_STATISTICS_INC(resourceBindings);
+
     auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
+    TrackResidency(resourceHeapD3D.GetResidencyEntries());
+
+    const D3D12_CPU_DESCRIPTOR_HANDLE srcDescHandles[2] =
+    {
+        resourceHeapD3D.GetCPUDescriptorHandleCbvSrvUav(),
+        resourceHeapD3D.GetCPUDescriptorHandleSampler(),
+    };
 
-    auto descHeaps = resourceHeapD3D.GetDescriptorHeaps();
-    auto heapCount = resourceHeapD3D.GetNumDescriptorHeaps();
+    const UINT numDescriptors[2] =
+    {
+        resourceHeapD3D.GetNumDescriptorsCbvSrvUav(),
+        resourceHeapD3D.GetNumDescriptorsSampler(),
+    };
+
+    /* Bind global descriptor heaps only once per command list */
+    BindDescriptorHeapRings();
+
+    /* Descriptor tables remain valid while the same resource heap is bound with the same root signature and has not been written to since */
+    const bool tablesBound =
+    (
+        boundResourceHeap_          == &resourceHeapD3D             &&
+        boundResourceHeapVersion_   == resourceHeapD3D.GetVersion() &&
+        boundRootSignature_         != nullptr
+    );
+    boundResourceHeap_          = &resourceHeapD3D;
+    boundResourceHeapVersion_   = resourceHeapD3D.GetVersion();
 
-    if (heapCount > 0)
+    for (UINT i = 0, rootParamIndex = 0; i < 2 && !tablesBound; ++i)
     {
-        /* Bind descriptor heaps */
-        commandList_->SetDescriptorHeaps(heapCount, descHeaps);
+        if (numDescriptors[i] > 0)
+        {
+            /* Copy descriptors of resource heap into a range of the global descriptor heap */
+            auto descriptorRing = descriptorRings_[i];
+            auto firstIndex     = descriptorRing->Allocate(numDescriptors[i]);
+
+            device_->CopyDescriptorsSimple(
+                numDescriptors[i],
+                descriptorRing->GetCPUDescriptorHandle(firstIndex),
+                srcDescHandles[i],
+                descriptorRing->GetType()
+            );
 
-        /* Bind root descriptor tables to graphics pipeline */
-        for (UINT i = 0; i < heapCount; ++i)
-            commandList_->SetGraphicsRootDescriptorTable(i, descHeaps[i]->GetGPUDescriptorHandleForHeapStart());
+            /* Bind root descriptor table to graphics pipeline */
+            commandList_->SetGraphicsRootDescriptorTable(rootParamIndex++, descriptorRing->GetGPUDescriptorHandle(firstIndex));
+        }
+    }
+
+    /* Bind root CBVs of constant buffers with dynamic offsets (missing offsets are treated as zero) */
+    const auto& dynamicBufferAddresses = resourceHeapD3D.GetDynamicBufferAddresses();
+    for (UINT i = 0; i < static_cast<UINT>(dynamicBufferAddresses.size()); ++i)
+    {
+        const auto offset = (i < numDynamicOffsets ? dynamicOffsets[i] : 0u);
+        commandList_->SetGraphicsRootConstantBufferView(
+            resourceHeapD3D.GetFirstDynamicRootParamIndex() + i,
+            dynamicBufferAddresses[i] + offset
+        );
     }
 }
 
-void D3D12CommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void D3D12CommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+
     //todo...
 }
 
+/* ----- Constants ----- */
+
+void D3D12CommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    if ((stageFlags & StageFlags::ComputeStage) != 0)
+    {
+        //todo: compute pipelines are not supported yet
+    }
+    else if (graphicsConstantsIndex_ >= 0)
+    {
+        commandList_->SetGraphicsRoot32BitConstants(
+            static_cast<UINT>(graphicsConstantsIndex_),
+            size / 4,
+            data,
+            offset / 4
+        );
+    }
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation D3D12CommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    /* Bundles can be executed multiple times, so their transient memory could not be recycled after a submission */
+    if (IsBundle())
+        throw std::runtime_error("transient memory is not supported for D3D12 bundles");
+    if (size == 0)
+        throw std::out_of_range("cannot allocate transient memory of zero size");
+
+    if (!transientBuffer_)
+        CreateTransientBuffer();
+
+    if (alignment == 0)
+        alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+    /* Wait for the oldest submissions while the ring is full */
+    std::uint64_t offset = 0;
+    auto waitForFenceValue = [this](UINT64 fenceValue)
+    {
+        renderSystem_.WaitForFenceValue(fenceValue);
+    };
+
+    if (!transientRing_.AllocateOrWait(size, alignment, offset, waitForFenceValue))
+        throw std::out_of_range("transient memory allocations since the last submission exceed the ring buffer of the command buffer");
+
+    TransientAllocation allocation;
+    {
+        allocation.data     = transientData_ + offset;
+        allocation.buffer   = transientBuffer_.get();
+        allocation.offset   = offset;
+    }
+    return allocation;
+}
+
 /* ----- Render Targets ----- */
 
 void D3D12CommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+
+    if (IsBundle())
+        BeginBundle();
     //todo
 }
 
 void D3D12CommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+
+    /* Bundles inherit the render targets from the executing command list */
+    if (IsBundle())
+    {
+        BeginBundle();
+        return;
+    }
+
     auto& renderContextD3D = LLGL_CAST(D3D12RenderContext&, renderContext);
 
     renderContextD3D.SetCommandBuffer(this);
@@ -272,6 +530,114 @@ void D3D12CommandBuffer::SetRenderTarget(RenderContext& renderContext)
     numBoundScissorRects_ = 0;
 }
 
+void D3D12CommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    /* Load and store operations are ignored until render targets are supported by this backend */
+    SetRenderTarget(renderTarget);
+}
+
+void D3D12CommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    SetRenderTarget(renderContext);
+
+    /* Bundles inherit the render targets and their content from the executing command list */
+    if (IsBundle() || renderPass == nullptr)
+        return;
+
+    auto& renderContextD3D = LLGL_CAST(D3D12RenderContext&, renderContext);
+
+    boundRenderPass_    = renderPass;
+    boundRenderContext_ = &renderContextD3D;
+
+    /* Render targets must be transitioned before they can be discarded or cleared */
+    FlushResourceBarriers();
+
+    /* Discard all attachments whose previous content is not loaded */
+    DiscardRenderPassAttachments(true);
+
+    /* Clear all attachments with clear operation; clear values are consumed in the order of these attachments */
+    std::uint32_t clearValueIndex = 0;
+
+    auto NextClearValue = [&]() -> const ClearValue&
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : clearValue_);
+    };
+
+    if (renderPass->GetColorAttachmentOps(0).loadOp == AttachmentLoadOp::Clear)
+        commandList_->ClearRenderTargetView(rtvDescHandle_, NextClearValue().color.Ptr(), 0, nullptr);
+
+    if (dsvDescHandle_.ptr != 0)
+    {
+        const auto& desc = renderPass->GetDesc();
+
+        /* Depth and stencil components share a single clear value */
+        INT dsvClearFlags = 0;
+
+        if (desc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D12_CLEAR_FLAG_DEPTH;
+        if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D12_CLEAR_FLAG_STENCIL;
+
+        if (dsvClearFlags)
+        {
+            const auto& clearValue = NextClearValue();
+            commandList_->ClearDepthStencilView(
+                dsvDescHandle_,
+                static_cast<D3D12_CLEAR_FLAGS>(dsvClearFlags),
+                clearValue.depth,
+                static_cast<UINT8>(clearValue.stencil & 0xff),
+                0,
+                nullptr
+            );
+        }
+    }
+}
+
+void D3D12CommandBuffer::EndRenderPass()
+{
+    /* Discard all attachments whose content is not stored */
+    if (boundRenderPass_ != nullptr)
+    {
+        FlushResourceBarriers();
+        DiscardRenderPassAttachments(false);
+        boundRenderPass_    = nullptr;
+        boundRenderContext_ = nullptr;
+    }
+}
+
+void D3D12CommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    // dummy (render targets are not supported yet)
+}
+
+void D3D12CommandBuffer::DiscardAttachments(long flags)
+{
+    /* Only attachments of the render context of the current render pass can be discarded */
+    if (boundRenderContext_ == nullptr)
+        return;
+
+    /* Render targets must be transitioned before they can be discarded */
+    FlushResourceBarriers();
+
+    if ((flags & ClearFlags::Color) != 0)
+        commandList_->DiscardResource(boundRenderContext_->GetCurrentColorBuffer(), nullptr);
+
+    /* Depth-stencil buffer can only be discarded as a whole */
+    if ((flags & ClearFlags::DepthStencil) == ClearFlags::DepthStencil)
+    {
+        if (auto depthStencil = boundRenderContext_->GetDepthStencilBuffer())
+            commandList_->DiscardResource(depthStencil, nullptr);
+    }
+}
+
 /* ----- Pipeline States ----- */
 
 void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
@@ -279,9 +645,33 @@ void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
     /* Set graphics root signature, graphics pipeline state, and primitive topology */
     auto& graphicsPipelineD3D = LLGL_CAST(D3D12GraphicsPipeline&, graphicsPipeline);
 
-    commandList_->SetGraphicsRootSignature(graphicsPipelineD3D.GetRootSignature());
-    commandList_->SetPipelineState(graphicsPipelineD3D.GetPipelineState());
-    commandList_->IASetPrimitiveTopology(graphicsPipelineD3D.GetPrimitiveTopology());
+    /* Root arguments are only invalidated if the root signature changes, so pipelines of identical layouts keep their bindings */
+    auto rootSignature = graphicsPipelineD3D.GetRootSignature();
+    if (boundRootSignature_ != rootSignature)
+    {
+        commandList_->SetGraphicsRootSignature(rootSignature);
+        boundRootSignature_ = rootSignature;
+        boundResourceHeap_  = nullptr;
+    }
+
+    /* Pipeline state and primitive topology are only set if they differ from the previous pipeline */
+    auto pipelineState = graphicsPipelineD3D.GetPipelineState();
+    if (bindingCache_.pipelineState != pipelineState)
+    {
+        LLGL_STATISTICS_INC(pipelineBindings);
+        commandList_->SetPipelineState(pipelineState);
+        bindingCache_.pipelineState = pipelineState;
+    }
+
+    auto primitiveTopology = graphicsPipelineD3D.GetPrimitiveTopology();
+    if (bindingCache_.primitiveTopology != primitiveTopology)
+    {
+        commandList_->IASetPrimitiveTopology(primitiveTopology);
+        bindingCache_.primitiveTopology = primitiveTopology;
+    }
+    graphicsPipelineD3D.SetOutputMergerStates(commandList_.Get());
+
+    graphicsConstantsIndex_ = graphicsPipelineD3D.GetConstantsRootParamIndex();
 
     /* Scissor rectangle must be updated (if scissor test is disabled) */
     scissorEnabled_ = graphicsPipelineD3D.IsScissorEnabled();
@@ -291,9 +681,68 @@ void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void D3D12CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_STATISTICS_INC(pipelineBindings);
+
     //todo
 }
 
+void D3D12CommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    #ifdef __ID3D12GraphicsCommandList5_INTERFACE_DEFINED__
+    /* Combine the per-draw rate with the per-primitive rate, and let the shading rate image override both */
+    ComPtr<ID3D12GraphicsCommandList5> commandList5;
+    if (SUCCEEDED(commandList_.As(&commandList5)))
+    {
+        const D3D12_SHADING_RATE_COMBINER combiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] =
+        {
+            D3D12_SHADING_RATE_COMBINER_PASSTHROUGH,
+            D3D12_SHADING_RATE_COMBINER_OVERRIDE,
+        };
+        commandList5->RSSetShadingRate(static_cast<D3D12_SHADING_RATE>(rate), combiners);
+    }
+    #endif
+}
+
+void D3D12CommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    #ifdef __ID3D12GraphicsCommandList5_INTERFACE_DEFINED__
+    ComPtr<ID3D12GraphicsCommandList5> commandList5;
+    if (SUCCEEDED(commandList_.As(&commandList5)))
+    {
+        if (texture != nullptr)
+        {
+            /* ShadingRate entries are encoded like D3D12_SHADING_RATE, so the texels can be read directly */
+            auto& textureD3D = LLGL_CAST(D3D12Texture&, *texture);
+            textureD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+            FlushResourceBarriers();
+            commandList5->RSSetShadingRateImage(textureD3D.GetNative());
+        }
+        else
+            commandList5->RSSetShadingRateImage(nullptr);
+    }
+    #endif
+}
+
+void D3D12CommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    commandList_->OMSetStencilRef(reference);
+}
+
+void D3D12CommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    commandList_->OMSetBlendFactor(color.Ptr());
+}
+
+void D3D12CommandBuffer::SetDepthBias(const DepthBiasDescriptor& /*depthBias*/)
+{
+    // dummy (not supported by D3D12, depth bias is part of the pipeline state object)
+}
+
+void D3D12CommandBuffer::SetDepthBounds(float /*minBounds*/, float /*maxBounds*/)
+{
+    // dummy (depth bounds test requires pipeline state streams, which are not used by this backend yet)
+}
+
 /* ----- Queries ----- */
 
 void D3D12CommandBuffer::BeginQuery(Query& query)
@@ -325,125 +774,1050 @@ void D3D12CommandBuffer::BeginRenderCondition(Query& query, const RenderConditio
 
 void D3D12CommandBuffer::EndRenderCondition()
 {
-    //commandList_->SetPredication(nullptr, offset, D3D12_PREDICATION_OP_EQUAL_ZERO);
-    //todo...
+    if (!IsBundle())
+        commandList_->SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
 }
 
-/* ----- Drawing ----- */
-
-void D3D12CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+void D3D12CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    commandList_->DrawInstanced(numVertices, 1, firstVertex, 0);
-}
+    if (IsBundle())
+        throw std::runtime_error("cannot record D3D12 queries in bundles");
 
-void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
-{
-    commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    commandList_->BeginQuery(queryHeapD3D.GetNative(), queryHeapD3D.GetQueryType(), query);
 }
 
-void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+void D3D12CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
-}
+    if (IsBundle())
+        throw std::runtime_error("cannot record D3D12 queries in bundles");
 
-void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
-{
-    commandList_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
-}
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    commandList_->EndQuery(queryHeapD3D.GetNative(), queryHeapD3D.GetQueryType(), query);
 
-void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
-{
-    commandList_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
+    /* Resolve result into readback buffer at the end of the frame */
+    if (queryHeapD3D.MarkDirty(query))
+        dirtyQueryHeaps_.push_back(&queryHeapD3D);
 }
 
-void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+void D3D12CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
-    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+    if (IsBundle())
+        throw std::runtime_error("cannot record D3D12 render conditions in bundles");
+
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    queryHeapD3D.ResolvePredicate(commandList_.Get(), query);
+
+    /* Predication discards the draw commands if the predicate value is zero, or non-zero if the condition is inverted */
+    auto predicateOp = (mode >= RenderConditionMode::WaitInverted ? D3D12_PREDICATION_OP_NOT_EQUAL_ZERO : D3D12_PREDICATION_OP_EQUAL_ZERO);
+    commandList_->SetPredication(queryHeapD3D.GetPredicationBuffer(), query * sizeof(UINT64), predicateOp);
 }
 
-void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+bool D3D12CommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
 {
-    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    return queryHeapD3D.ReadResults(renderSystem_.GetCompletedFenceValue(), firstQuery, numQueries, results);
 }
 
-void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+void D3D12CommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
 {
-    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+    if (IsBundle())
+        throw std::runtime_error("cannot resolve D3D12 queries in bundles");
+
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    TrackResidency(dstBufferD3D.GetResidencyEntry());
+
+    dstBufferD3D.ResolveQueryData(
+        commandList_.Get(),
+        barrierBatch_,
+        queryHeapD3D.GetNative(),
+        queryHeapD3D.GetQueryType(),
+        firstQuery,
+        numQueries,
+        dstOffset
+    );
 }
 
-/* ----- Compute ----- */
+/* ----- Timer Scopes ----- */
 
-void D3D12CommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+static void Convert(QueryPipelineStatistics& dst, const D3D12_QUERY_DATA_PIPELINE_STATISTICS& src)
 {
-    commandList_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+    dst.numPrimitivesGenerated              = src.CInvocations;
+    dst.numVerticesSubmitted                = src.IAVertices;
+    dst.numPrimitivesSubmitted              = src.IAPrimitives;
+    dst.numVertexShaderInvocations          = src.VSInvocations;
+    dst.numTessControlShaderInvocations     = src.HSInvocations;
+    dst.numTessEvaluationShaderInvocations  = src.DSInvocations;
+    dst.numGeometryShaderInvocations        = src.GSInvocations;
+    dst.numFragmentShaderInvocations        = src.PSInvocations;
+    dst.numComputeShaderInvocations         = src.CSInvocations;
+    dst.numGeometryPrimitivesGenerated      = src.GSPrimitives;
+    dst.numClippingInputPrimitives          = src.CInvocations; // <-- TODO: workaround
+    dst.numClippingOutputPrimitives         = src.CPrimitives;
 }
 
-/* ----- Extended functions ----- */
-
-void D3D12CommandBuffer::ResetCommandList(ID3D12CommandAllocator* commandAlloc, ID3D12PipelineState* pipelineState)
+void D3D12CommandBuffer::BeginTimerScope(const char* name)
 {
-    /* Reset commanb list with command allocator and pipeline state */
-    auto hr = commandList_->Reset(commandAlloc, pipelineState);
-    DXThrowIfFailed(hr, "failed to reset D3D12 command list");
-}
+    /* Bundles cannot record queries */
+    if (IsBundle())
+        return;
 
+    EndStatisticsSegment();
 
-/*
- * ======= Private: =======
- */
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.BeginScope(name, timestampIndex))
+        commandList_->EndQuery(timerQueryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, timestampIndex);
 
-void D3D12CommandBuffer::CreateDevices(D3D12RenderSystem& renderSystem)
-{
-    /* Create command allocator and graphics command list */
-    commandAlloc_   = renderSystem.CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
-    commandList_    = renderSystem.CreateDXCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, commandAlloc_.Get());
+    BeginStatisticsSegment();
 }
 
-void D3D12CommandBuffer::SetBackBufferRTV(D3D12RenderContext& renderContextD3D)
+void D3D12CommandBuffer::EndTimerScope()
 {
-    if (!renderContextD3D.HasMultiSampling())
-    {
-        /* Indicate that the back buffer will be used as render target */
-        renderContextD3D.TransitionRenderTarget(
-            D3D12_RESOURCE_STATE_PRESENT,
-            D3D12_RESOURCE_STATE_RENDER_TARGET
-        );
-    }
+    EndStatisticsSegment();
 
-    /* Set current back buffer as RTV */
-    rtvDescHandle_ = renderContextD3D.GetCPUDescriptorHandleForCurrentRTV();
-    dsvDescHandle_ = renderContextD3D.GetCPUDescriptorHandleForDSV();
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.EndScope(timestampIndex))
+        commandList_->EndQuery(timerQueryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, timestampIndex);
 
-    if (dsvDescHandle_.ptr != 0)
-    {
-        /* Set current RTV and DSV */
-        commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, &dsvDescHandle_);
-    }
-    else
-    {
-        /* Set only current RTV */
-        commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, nullptr);
-    }
+    BeginStatisticsSegment();
 }
 
-void D3D12CommandBuffer::SetScissorRectsWithFramebufferExtent(UINT numScissorRects)
+bool D3D12CommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
 {
-    numScissorRects = std::min(numScissorRects, UINT(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
+    if (!timerScopes_.HasPendingFrame())
+        return false;
+
+    /* Check if the GPU has finished the pending frame */
+    const auto pendingFrame = timerScopes_.GetPendingFrame();
+    if (renderSystem_.GetCompletedFenceValue() < timerFenceValues_[pendingFrame])
+        return false;
 
-    if (numScissorRects > numBoundScissorRects_)
+    /* Map range of the pending frame from the readback buffer and resolve timer scopes */
+    const auto firstTimestamp   = timerScopes_.GetFirstTimestamp(pendingFrame);
+    const auto numTimestamps    = timerScopes_.GetNumTimestamps(pendingFrame);
+
+    const D3D12_RANGE readRange { firstTimestamp * sizeof(UINT64), (firstTimestamp + numTimestamps) * sizeof(UINT64) };
+
+    void* data = nullptr;
+    auto hr = timerReadbackBuffer_->Map(0, &readRange, &data);
+    DXThrowIfFailed(hr, "failed to map D3D12 readback buffer for timer scopes");
+
+    /* Convert pipeline statistics of all segments */
+    QueryPipelineStatistics* statistics = nullptr;
+    if (statisticsQueryHeap_)
     {
-        /* Set scissor to render target resolution */
-        D3D12_RECT scissorRects[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+        const auto firstSegment = timerScopes_.GetFirstSegment(pendingFrame);
+        const auto numSegments  = timerScopes_.GetNumSegments(pendingFrame);
 
-        for (UINT i = 0; i < numScissorRects; ++i)
+        const D3D12_RANGE statisticsRange
         {
-            scissorRects[i].left    = 0;
-            scissorRects[i].top     = 0;
-            scissorRects[i].right   = framebufferWidth_;
-            scissorRects[i].bottom  = framebufferHeight_;
-        }
+            firstSegment * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS),
+            (firstSegment + numSegments) * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)
+        };
 
-        commandList_->RSSetScissorRects(numScissorRects, scissorRects);
+        void* statisticsData = nullptr;
+        hr = statisticsReadbackBuffer_->Map(0, &statisticsRange, &statisticsData);
+        DXThrowIfFailed(hr, "failed to map D3D12 readback buffer for timer scope statistics");
+
+        auto src = reinterpret_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS*>(statisticsData) + firstSegment;
+
+        statisticsResults_.resize(numSegments);
+        for (std::uint32_t i = 0; i < numSegments; ++i)
+            Convert(statisticsResults_[i], src[i]);
+        statistics = statisticsResults_.data();
+
+        const D3D12_RANGE statisticsWrittenRange { 0, 0 };
+        statisticsReadbackBuffer_->Unmap(0, &statisticsWrittenRange);
+    }
+
+    timerScopes_.ResolvePendingFrame(reinterpret_cast<const std::uint64_t*>(data) + firstTimestamp, timestampPeriod_, frame, statistics);
+
+    const D3D12_RANGE writtenRange { 0, 0 };
+    timerReadbackBuffer_->Unmap(0, &writtenRange);
+
+    return true;
+}
+
+/* ----- Debug Markers ----- */
+
+#ifdef LLGL_ENABLE_DEBUG_MARKERS
+
+// Metadata value for ANSI strings in ID3D12GraphicsCommandList::BeginEvent/SetMarker, as expected by PIX
+static const UINT g_debugMarkerANSIMetadata = 1;
+
+static UINT GetDebugMarkerSize(const char* name)
+{
+    return static_cast<UINT>(std::strlen(name) + 1);
+}
+
+#endif // /LLGL_ENABLE_DEBUG_MARKERS
+
+void D3D12CommandBuffer::PushDebugGroup(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    if (name == nullptr)
+        name = "";
+    commandList_->BeginEvent(g_debugMarkerANSIMetadata, name, GetDebugMarkerSize(name));
+    #endif
+}
+
+void D3D12CommandBuffer::PopDebugGroup()
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    commandList_->EndEvent();
+    #endif
+}
+
+void D3D12CommandBuffer::InsertDebugMarker(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    if (name == nullptr)
+        name = "";
+    commandList_->SetMarker(g_debugMarkerANSIMetadata, name, GetDebugMarkerSize(name));
+    #endif
+}
+
+/* ----- Drawing ----- */
+
+void D3D12CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawInstanced(numVertices, 1, firstVertex, 0);
+}
+
+void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
+}
+
+void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
+}
+
+void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
+}
+
+void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
+}
+
+void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushResourceBarriers();
+    commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+}
+
+void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    D3D12CommandBuffer::DrawIndirect(buffer, offset, 1, sizeof(DrawIndirectArguments));
+}
+
+void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    ExecuteIndirect(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, buffer, offset, numCommands, stride);
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    D3D12CommandBuffer::DrawIndexedIndirect(buffer, offset, 1, sizeof(DrawIndexedIndirectArguments));
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    ExecuteIndirect(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, buffer, offset, numCommands, stride);
+}
+
+void D3D12CommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  layout,
+    Buffer&                 argumentBuffer,
+    std::uint64_t           argumentOffset,
+    std::uint32_t           maxNumCommands,
+    Buffer*                 countBuffer,
+    std::uint64_t           countOffset)
+{
+    LLGL_STATISTICS_ADD(drawCalls, maxNumCommands);
+
+    auto& layoutD3D         = LLGL_CAST(D3D12IndirectCommandLayout&, layout);
+    auto& argumentBufferD3D = LLGL_CAST(D3D12Buffer&, argumentBuffer);
+    TrackResidency(argumentBufferD3D.GetResidencyEntry());
+
+    /* Read the actual number of commands from the count buffer, which is clamped to 'maxNumCommands' by the GPU */
+    ID3D12Resource* countResource = nullptr;
+    if (countBuffer != nullptr)
+    {
+        auto countBufferD3D = LLGL_CAST(D3D12Buffer*, countBuffer);
+        TrackResidency(countBufferD3D->GetResidencyEntry());
+        countResource   = countBufferD3D->GetNative();
+        countOffset     += countBufferD3D->GetOffset();
+    }
+
+    FlushResourceBarriers();
+    commandList_->ExecuteIndirect(
+        layoutD3D.GetNative(),
+        maxNumCommands,
+        argumentBufferD3D.GetNative(),
+        argumentBufferD3D.GetOffset() + argumentOffset,
+        countResource,
+        countOffset
+    );
+}
+
+void D3D12CommandBuffer::DrawStreamOutput()
+{
+    //todo: requires a filled-size counter for each stream-output buffer (D3D12_STREAM_OUTPUT_BUFFER_VIEW::BufferFilledSizeLocation) and ExecuteIndirect
+}
+
+void D3D12CommandBuffer::DrawMeshTasks(std::uint32_t /*groupSizeX*/, std::uint32_t /*groupSizeY*/, std::uint32_t /*groupSizeZ*/)
+{
+    // dummy (mesh shaders require pipeline state streams and DXC, which are not used by this renderer yet)
+}
+
+void D3D12CommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    // dummy (mesh shaders require pipeline state streams and DXC, which are not used by this renderer yet)
+}
+
+/* ----- Compute ----- */
+
+void D3D12CommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    FlushResourceBarriers();
+    commandList_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+}
+
+void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    ExecuteIndirect(D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH, buffer, offset, 1, sizeof(DispatchIndirectArguments));
+}
+
+void D3D12CommandBuffer::DispatchBarrier()
+{
+    /* Make unordered access writes of previous dispatches visible to subsequent commands */
+    commandList_->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::UAV(nullptr));
+}
+
+/* ----- Acceleration Structures ----- */
+
+void D3D12CommandBuffer::BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures)
+{
+    #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+    ComPtr<ID3D12GraphicsCommandList4> commandList4;
+    if (FAILED(commandList_.As(&commandList4)))
+        return;
+
+    /* Transition all input buffers at once, so the builds can run without barriers in between */
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure*, accelerationStructures[i]);
+        accelerationStructureD3D->TransitionInputs(barrierBatch_);
+    }
+    FlushResourceBarriers();
+
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure*, accelerationStructures[i]);
+        accelerationStructureD3D->Build(commandList4.Get());
+    }
+
+    /* Make results visible to subsequent builds, traces, and the postbuild info copies */
+    commandList_->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::UAV(nullptr));
+
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure*, accelerationStructures[i]);
+        accelerationStructureD3D->ResolveCompactedSize(commandList_.Get());
+        accelerationStructureD3D->TransitionInputsToUsageState(barrierBatch_);
+    }
+    #endif
+}
+
+void D3D12CommandBuffer::CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure)
+{
+    #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+    ComPtr<ID3D12GraphicsCommandList4> commandList4;
+    if (FAILED(commandList_.As(&commandList4)))
+        return;
+
+    auto& dstAccelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure&, srcAccelerationStructure);
+
+    commandList4->CopyRaytracingAccelerationStructure(
+        dstAccelerationStructureD3D.GetGPUVirtualAddress(),
+        srcAccelerationStructureD3D.GetGPUVirtualAddress(),
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT
+    );
+    commandList_->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::UAV(nullptr));
+    #endif
+}
+
+/* ----- Copy ----- */
+
+// Returns the placed footprint of the texel data for one array layer of the specified texture box within a buffer.
+static D3D12_PLACED_SUBRESOURCE_FOOTPRINT GetD3DPlacedFootprint(const D3D12Texture& textureD3D, const D3D12_BOX& box, std::uint64_t offset, std::uint32_t rowStride)
+{
+    const auto texelSize = FormatBitSize(DXTypes::Unmap(textureD3D.GetFormat())) / 8;
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+    {
+        footprint.Offset                = offset;
+        footprint.Footprint.Format      = textureD3D.GetFormat();
+        footprint.Footprint.Width       = (box.right - box.left);
+        footprint.Footprint.Height      = (box.bottom - box.top);
+        footprint.Footprint.Depth       = (box.back - box.front);
+        footprint.Footprint.RowPitch    = (rowStride > 0 ? rowStride : footprint.Footprint.Width * texelSize);
+    }
+
+    if (footprint.Footprint.RowPitch % D3D12_TEXTURE_DATA_PITCH_ALIGNMENT != 0)
+        throw std::invalid_argument("row stride for D3D12 buffer-texture copy must be a multiple of " + std::to_string(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+    if (footprint.Offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT != 0)
+        throw std::invalid_argument("buffer offset for D3D12 buffer-texture copy must be a multiple of " + std::to_string(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT));
+
+    return footprint;
+}
+
+void D3D12CommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    TrackResidency(dstBufferD3D.GetResidencyEntry());
+    TrackResidency(srcBufferD3D.GetResidencyEntry());
+
+    /* Transition resources for copy operation (together with all pending barriers, except open split transitions) */
+    dstBufferD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_DEST);
+    srcBufferD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barrierBatch_.FlushForCopy(commandList_.Get());
+
+    commandList_->CopyBufferRegion(dstBufferD3D.GetNative(), dstBufferD3D.GetOffset() + dstOffset, srcBufferD3D.GetNative(), srcBufferD3D.GetOffset() + srcOffset, size);
+
+    /* Begin transitions back into usage state with the next flush, so they can overlap subsequent copy operations */
+    dstBufferD3D.BeginTransitionToUsageState(barrierBatch_);
+    srcBufferD3D.BeginTransitionToUsageState(barrierBatch_);
+}
+
+void D3D12CommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    //todo: storage buffers with counter resources are not supported yet
+}
+
+void D3D12CommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    //todo: storage buffers with counter resources are not supported yet
+}
+
+/*
+D3D12 can only clear buffers with ClearUnorderedAccessViewUint, which requires a shader-visible UAV of the buffer,
+so the pattern is copied from a transient allocation instead, which is reused for each chunk of the range.
+*/
+void D3D12CommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    static const std::uint64_t maxChunkSize = 64 * 1024;
+
+    if (fillSize == 0)
+        return;
+
+    /* Fill transient memory with the pattern once */
+    const auto chunkSize = std::min(fillSize, maxChunkSize);
+    auto allocation = AllocateTransient(chunkSize, sizeof(std::uint32_t));
+
+    auto pattern = reinterpret_cast<std::uint32_t*>(allocation.data);
+    std::fill(pattern, pattern + chunkSize / sizeof(std::uint32_t), value);
+
+    /* Copy pattern into each chunk of the destination range */
+    for (std::uint64_t offset = 0; offset < fillSize; offset += chunkSize)
+        CopyBuffer(dstBuffer, dstOffset + offset, *allocation.buffer, allocation.offset, std::min(chunkSize, fillSize - offset));
+}
+
+void D3D12CommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+
+    TrackResidency(dstTextureD3D.GetResidencyEntry());
+    TrackResidency(srcTextureD3D.GetResidencyEntry());
+
+    UINT        srcBaseArrayLayer = 0, dstBaseArrayLayer = 0, numArrayLayers = 0;
+    D3D12_BOX   srcBox, dstBox;
+
+    srcTextureD3D.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, srcBaseArrayLayer, numArrayLayers, srcBox);
+    dstTextureD3D.GetSubresourceRegion(dstLocation.offset, srcRegion.extent, dstBaseArrayLayer, numArrayLayers, dstBox);
+
+    /* Transition resources for copy operation (together with all pending barriers, except open split transitions) */
+    dstTextureD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_DEST);
+    srcTextureD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barrierBatch_.FlushForCopy(commandList_.Get());
+
+    /* Copy region of each array layer, since each array layer is a separate subresource */
+    for (UINT layer = 0; layer < numArrayLayers; ++layer)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(
+            dstTextureD3D.GetNative(),
+            D3D12CalcSubresource(dstLocation.mipLevel, dstBaseArrayLayer + layer, 0, dstTextureD3D.GetNumMipLevels(), dstTextureD3D.GetNumArrayLayers())
+        );
+        const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(
+            srcTextureD3D.GetNative(),
+            D3D12CalcSubresource(srcRegion.mipLevel, srcBaseArrayLayer + layer, 0, srcTextureD3D.GetNumMipLevels(), srcTextureD3D.GetNumArrayLayers())
+        );
+        commandList_->CopyTextureRegion(&dstLocationD3D, dstBox.left, dstBox.top, dstBox.front, &srcLocationD3D, &srcBox);
+    }
+
+    /* Begin transitions back into usage state with the next flush, so they can overlap subsequent copy operations */
+    dstTextureD3D.BeginTransitionToUsageState(barrierBatch_);
+    srcTextureD3D.BeginTransitionToUsageState(barrierBatch_);
+}
+
+void D3D12CommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    //todo: requires render-target-views or unordered-access-views of textures, which are not supported yet
+}
+
+void D3D12CommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcBufferD3D  = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    TrackResidency(dstTextureD3D.GetResidencyEntry());
+    TrackResidency(srcBufferD3D.GetResidencyEntry());
+
+    UINT        baseArrayLayer = 0, numArrayLayers = 0;
+    D3D12_BOX   dstBox;
+
+    dstTextureD3D.GetSubresourceRegion(dstRegion.offset, dstRegion.extent, baseArrayLayer, numArrayLayers, dstBox);
+
+    auto footprint = GetD3DPlacedFootprint(dstTextureD3D, dstBox, srcBufferD3D.GetOffset() + srcOffset, rowStride);
+    const auto layerSize = static_cast<UINT64>(footprint.Footprint.RowPitch) * footprint.Footprint.Height * footprint.Footprint.Depth;
+
+    /* Transition resources for copy operation (together with all pending barriers, except open split transitions) */
+    dstTextureD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_DEST);
+    srcBufferD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barrierBatch_.FlushForCopy(commandList_.Get());
+
+    for (UINT layer = 0; layer < numArrayLayers; ++layer, footprint.Offset += layerSize)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(
+            dstTextureD3D.GetNative(),
+            D3D12CalcSubresource(dstRegion.mipLevel, baseArrayLayer + layer, 0, dstTextureD3D.GetNumMipLevels(), dstTextureD3D.GetNumArrayLayers())
+        );
+        const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(srcBufferD3D.GetNative(), footprint);
+        commandList_->CopyTextureRegion(&dstLocationD3D, dstBox.left, dstBox.top, dstBox.front, &srcLocationD3D, nullptr);
+    }
+
+    /* Begin transitions back into usage state with the next flush, so they can overlap subsequent copy operations */
+    dstTextureD3D.BeginTransitionToUsageState(barrierBatch_);
+    srcBufferD3D.BeginTransitionToUsageState(barrierBatch_);
+}
+
+void D3D12CommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    auto& dstBufferD3D  = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+
+    if (dstBufferD3D.IsHostVisible())
+        throw std::runtime_error("cannot copy D3D12 texture into buffer of upload heap");
+
+    TrackResidency(dstBufferD3D.GetResidencyEntry());
+    TrackResidency(srcTextureD3D.GetResidencyEntry());
+
+    UINT        baseArrayLayer = 0, numArrayLayers = 0;
+    D3D12_BOX   srcBox;
+
+    srcTextureD3D.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, baseArrayLayer, numArrayLayers, srcBox);
+
+    auto footprint = GetD3DPlacedFootprint(srcTextureD3D, srcBox, dstBufferD3D.GetOffset() + dstOffset, rowStride);
+    const auto layerSize = static_cast<UINT64>(footprint.Footprint.RowPitch) * footprint.Footprint.Height * footprint.Footprint.Depth;
+
+    /* Transition resources for copy operation (together with all pending barriers, except open split transitions) */
+    dstBufferD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_DEST);
+    srcTextureD3D.TransitionResource(barrierBatch_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barrierBatch_.FlushForCopy(commandList_.Get());
+
+    for (UINT layer = 0; layer < numArrayLayers; ++layer, footprint.Offset += layerSize)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(dstBufferD3D.GetNative(), footprint);
+        const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(
+            srcTextureD3D.GetNative(),
+            D3D12CalcSubresource(srcRegion.mipLevel, baseArrayLayer + layer, 0, srcTextureD3D.GetNumMipLevels(), srcTextureD3D.GetNumArrayLayers())
+        );
+        commandList_->CopyTextureRegion(&dstLocationD3D, 0, 0, 0, &srcLocationD3D, &srcBox);
+    }
+
+    /* Begin transitions back into usage state with the next flush, so they can overlap subsequent copy operations */
+    dstBufferD3D.BeginTransitionToUsageState(barrierBatch_);
+    srcTextureD3D.BeginTransitionToUsageState(barrierBatch_);
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void D3D12CommandBuffer::Begin()
+{
+    if (IsBundle())
+    {
+        /* Close current recording, so the next render pass acquires a new bundle */
+        if (bundleRecording_)
+            FinishBundle();
+        bundleEnded_ = false;
+    }
+}
+
+void D3D12CommandBuffer::End()
+{
+    if (IsBundle())
+    {
+        /* Keep current recording until the next call to Begin */
+        FinishBundle();
+        bundleEnded_ = true;
+    }
+}
+
+void D3D12CommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    auto& bundleD3D = LLGL_CAST(D3D12CommandBuffer&, secondaryCommandBuffer);
+
+    if (IsBundle())
+        throw std::runtime_error("cannot execute D3D12 bundle within another bundle");
+    if (!bundleD3D.IsBundle())
+        throw std::invalid_argument("cannot execute D3D12 direct command list as bundle");
+
+    auto bundle = bundleD3D.FinishBundle();
+
+    /* Bundles must be executed with the same descriptor heaps they have been recorded with */
+    BindDescriptorHeapRings();
+    FlushResourceBarriers();
+    commandList_->ExecuteBundle(bundle);
+
+    /* Bundles may change the root signature, root arguments, and pipeline states of this command list */
+    InvalidateRootBindings();
+    ResetBindingCache();
+
+    /* Keep bundle alive until this command list has been completed */
+    bundleD3D.bundlePool_->AddRef(bundle);
+    executedBundles_.push_back({ bundleD3D.bundlePool_, bundle });
+
+    /* Resources referenced by the bundle must be resident when this command list is executed */
+    for (auto entry : bundleD3D.residencySet_)
+        D3D12AppendResidencySet(residencySet_, entry);
+}
+
+/* ----- Extended functions ----- */
+
+void D3D12CommandBuffer::ResetCommandList(ID3D12CommandAllocator* commandAlloc, ID3D12PipelineState* pipelineState)
+{
+    /* Reset commanb list with command allocator and pipeline state */
+    auto hr = commandList_->Reset(commandAlloc, pipelineState);
+    DXThrowIfFailed(hr, "failed to reset D3D12 command list");
+
+    /* Descriptor heaps and root signature must be bound again for the new command list */
+    descriptorRingsBound_ = false;
+    InvalidateRootBindings();
+    ResetBindingCache();
+}
+
+void D3D12CommandBuffer::FlushResourceBarriers()
+{
+    barrierBatch_.Flush(commandList_.Get());
+}
+
+void D3D12CommandBuffer::SubmitExecutedBundles(UINT64 fenceValue)
+{
+    for (const auto& bundle : executedBundles_)
+        bundle.pool->Release(bundle.commandList, fenceValue);
+    executedBundles_.clear();
+}
+
+void D3D12CommandBuffer::MakeResident(ID3D12CommandQueue* queue)
+{
+    renderSystem_.GetResidencyManager().MakeResident(queue, residencySet_);
+}
+
+void D3D12CommandBuffer::SubmitTransientMemory(UINT64 fenceValue)
+{
+    transientRing_.Close(fenceValue);
+}
+
+void D3D12CommandBuffer::SubmitResidencySet(UINT64 fenceValue)
+{
+    renderSystem_.GetResidencyManager().Submit(residencySet_, fenceValue);
+    residencyLastEntries_ = nullptr;
+}
+
+void D3D12CommandBuffer::CloseTimerScopeFrame()
+{
+    if (IsBundle())
+        return;
+
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    while (timerScopes_.HasOpenScopes())
+    {
+        if (timerScopes_.EndScope(timestampIndex))
+            commandList_->EndQuery(timerQueryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, timestampIndex);
+    }
+
+    const auto currentFrame     = timerScopes_.GetCurrentFrame();
+    const auto firstTimestamp   = timerScopes_.GetFirstTimestamp(currentFrame);
+    const auto numTimestamps    = timerScopes_.GetNumTimestamps(currentFrame);
+    const auto firstSegment     = timerScopes_.GetFirstSegment(currentFrame);
+    const auto numSegments      = timerScopes_.GetNumSegments(currentFrame);
+
+    if (timerScopes_.CloseFrame())
+    {
+        /* Resolve pipeline statistics of all segments of this frame */
+        if (statisticsQueryHeap_ && numSegments > 0)
+        {
+            commandList_->ResolveQueryData(
+                statisticsQueryHeap_.Get(),
+                D3D12_QUERY_TYPE_PIPELINE_STATISTICS,
+                firstSegment,
+                numSegments,
+                statisticsReadbackBuffer_.Get(),
+                firstSegment * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)
+            );
+        }
+
+        /* Resolve all timestamps of this frame into the same range of the readback buffer */
+        commandList_->ResolveQueryData(
+            timerQueryHeap_.Get(),
+            D3D12_QUERY_TYPE_TIMESTAMP,
+            firstTimestamp,
+            numTimestamps,
+            timerReadbackBuffer_.Get(),
+            firstTimestamp * sizeof(UINT64)
+        );
+
+        /* Timestamps must not be read before the frame has been submitted */
+        timerFenceValues_[currentFrame] = UINT64_MAX;
+        timerClosedFrame_               = currentFrame;
+        timerFrameClosed_               = true;
+    }
+}
+
+void D3D12CommandBuffer::SubmitTimerScopeFrame(UINT64 fenceValue)
+{
+    if (timerFrameClosed_)
+    {
+        timerFenceValues_[timerClosedFrame_] = fenceValue;
+        timerFrameClosed_ = false;
+    }
+}
+
+void D3D12CommandBuffer::ResolveQueryHeaps()
+{
+    for (auto queryHeap : dirtyQueryHeaps_)
+    {
+        queryHeap->ResolveDirtyRange(commandList_.Get());
+        resolvedQueryHeaps_.push_back(queryHeap);
+    }
+    dirtyQueryHeaps_.clear();
+}
+
+void D3D12CommandBuffer::SubmitQueryHeaps(UINT64 fenceValue)
+{
+    for (auto queryHeap : resolvedQueryHeaps_)
+        queryHeap->SetFenceValue(fenceValue);
+    resolvedQueryHeaps_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12CommandBuffer::CreateDevices(D3D12RenderSystem& renderSystem, D3D12_COMMAND_LIST_TYPE type)
+{
+    /* Create command allocator and graphics command list (direct or compute) */
+    commandAlloc_   = renderSystem.CreateDXCommandAllocator(type);
+    commandList_    = renderSystem.CreateDXCommandList(type, commandAlloc_.Get());
+}
+
+void D3D12CommandBuffer::CreateTimerQueryHeap(D3D12RenderSystem& renderSystem)
+{
+    /* Create query heap for all timestamps of the timer scope frames */
+    D3D12_QUERY_HEAP_DESC queryHeapDesc;
+    {
+        queryHeapDesc.Type      = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        queryHeapDesc.Count     = TimerScopeRecorder::maxNumTimestamps;
+        queryHeapDesc.NodeMask  = 0;
+    }
+    auto hr = device_->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(timerQueryHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 query heap for timer scopes");
+
+    /* Create readback buffer to retrieve the resolved timestamps on the CPU */
+    hr = device_->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(TimerScopeRecorder::maxNumTimestamps * sizeof(UINT64)),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(timerReadbackBuffer_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 readback buffer for timer scopes");
+
+    /* Determine the period of timestamp ticks */
+    UINT64 frequency = 0;
+    hr = renderSystem.GetHardwareQueue()->GetTimestampFrequency(&frequency);
+    DXThrowIfFailed(hr, "failed to query timestamp frequency of D3D12 command queue");
+
+    timestampPeriod_ = 1000000000.0 / static_cast<double>(frequency);
+
+    for (auto& fenceValue : timerFenceValues_)
+        fenceValue = 0;
+}
+
+void D3D12CommandBuffer::CreateStatisticsQueryHeap()
+{
+    /* Create query heap for the pipeline statistics of all timer scope segments */
+    D3D12_QUERY_HEAP_DESC queryHeapDesc;
+    {
+        queryHeapDesc.Type      = D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+        queryHeapDesc.Count     = TimerScopeRecorder::maxNumSegments;
+        queryHeapDesc.NodeMask  = 0;
+    }
+    auto hr = device_->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(statisticsQueryHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 query heap for timer scope statistics");
+
+    hr = device_->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(TimerScopeRecorder::maxNumSegments * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(statisticsReadbackBuffer_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 readback buffer for timer scope statistics");
+}
+
+void D3D12CommandBuffer::BeginStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (statisticsQueryHeap_ && timerScopes_.BeginSegment(queryIndex))
+        commandList_->BeginQuery(statisticsQueryHeap_.Get(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS, queryIndex);
+}
+
+void D3D12CommandBuffer::EndStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerScopes_.EndSegment(queryIndex))
+        commandList_->EndQuery(statisticsQueryHeap_.Get(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS, queryIndex);
+}
+
+void D3D12CommandBuffer::CreateTransientBuffer()
+{
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type = BufferType::Constant;
+        bufferDesc.size = g_transientRingSize;
+    }
+    transientBuffer_ = MakeUnique<D3D12ConstantBuffer>(renderSystem_.GetMemoryAllocator(), bufferDesc);
+
+    /* Map upload buffer persistently; it is unmapped when the command buffer is destroyed */
+    void* mappedData = nullptr;
+    auto hr = transientBuffer_->GetNative()->Map(0, nullptr, &mappedData);
+    DXThrowIfFailed(hr, "failed to map D3D12 transient ring buffer");
+
+    transientData_ = reinterpret_cast<char*>(mappedData) + transientBuffer_->GetOffset();
+    transientRing_.Reset(g_transientRingSize);
+}
+
+void D3D12CommandBuffer::BindDescriptorHeapRings()
+{
+    if (!descriptorRingsBound_)
+    {
+        ID3D12DescriptorHeap* descHeaps[2] = { descriptorRings_[0]->GetNative(), descriptorRings_[1]->GetNative() };
+        commandList_->SetDescriptorHeaps(2, descHeaps);
+        descriptorRingsBound_ = true;
+    }
+}
+
+void D3D12CommandBuffer::InvalidateRootBindings()
+{
+    boundRootSignature_ = nullptr;
+    boundResourceHeap_  = nullptr;
+}
+
+void D3D12CommandBuffer::BeginBundle()
+{
+    if (!bundleRecording_)
+    {
+        if (bundleEnded_)
+            throw std::runtime_error("cannot record into D3D12 bundle that has been ended without beginning a new recording");
+
+        /* Release previous recording and take next bundle from the pool */
+        if (commandList_)
+            bundlePool_->Release(commandList_.Get(), 0);
+        commandList_ = bundlePool_->Acquire();
+
+        /* Resources of the previous recording are no longer referenced */
+        residencySet_.clear();
+        residencyLastEntries_ = nullptr;
+
+        bundleRecording_        = true;
+        descriptorRingsBound_   = false;
+        scissorEnabled_         = false;
+        InvalidateRootBindings();
+        ResetBindingCache();
+    }
+}
+
+ID3D12GraphicsCommandList* D3D12CommandBuffer::FinishBundle()
+{
+    if (bundleRecording_)
+    {
+        auto hr = commandList_->Close();
+        DXThrowIfFailed(hr, "failed to close D3D12 bundle");
+        bundleRecording_ = false;
+    }
+    else if (!commandList_)
+        throw std::runtime_error("cannot execute D3D12 bundle that has not been recorded");
+    return commandList_.Get();
+}
+
+void D3D12CommandBuffer::TrackResidency(D3D12ResidencyEntry* entry)
+{
+    D3D12AppendResidencySet(residencySet_, entry);
+}
+
+void D3D12CommandBuffer::TrackResidency(const std::vector<D3D12ResidencyEntry*>& entries)
+{
+    /* Skip redundant bindings of the same resource heap or buffer array */
+    if (residencyLastEntries_ == &entries)
+        return;
+
+    residencyLastEntries_ = &entries;
+
+    for (auto entry : entries)
+        D3D12AppendResidencySet(residencySet_, entry);
+}
+
+void D3D12CommandBuffer::ExecuteIndirect(D3D12_INDIRECT_ARGUMENT_TYPE type, Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TrackResidency(bufferD3D.GetResidencyEntry());
+    FlushResourceBarriers();
+    commandList_->ExecuteIndirect(
+        renderSystem_.GetCommandSignature(type, stride),
+        numCommands,
+        bufferD3D.GetNative(),
+        bufferD3D.GetOffset() + offset,
+        nullptr,
+        0
+    );
+}
+
+void D3D12CommandBuffer::DiscardRenderPassAttachments(bool loadOps)
+{
+    auto IsUndefined = [loadOps](const AttachmentOpsDescriptor& ops)
+    {
+        return (loadOps ? ops.loadOp == AttachmentLoadOp::Undefined : ops.storeOp == AttachmentStoreOp::Undefined);
+    };
+
+    /* Multi-sampled color buffer is resolved when the render context is presented, so its content must be stored */
+    if (IsUndefined(boundRenderPass_->GetColorAttachmentOps(0)) && (loadOps || !boundRenderContext_->HasMultiSampling()))
+        commandList_->DiscardResource(boundRenderContext_->GetCurrentColorBuffer(), nullptr);
+
+    /* Depth-stencil buffer can only be discarded as a whole */
+    const auto& desc = boundRenderPass_->GetDesc();
+    if (auto depthStencil = boundRenderContext_->GetDepthStencilBuffer())
+    {
+        if (IsUndefined(desc.depthAttachment) && IsUndefined(desc.stencilAttachment))
+            commandList_->DiscardResource(depthStencil, nullptr);
+    }
+}
+
+void D3D12CommandBuffer::SetBackBufferRTV(D3D12RenderContext& renderContextD3D)
+{
+    /* Indicate that the back buffer will be used as render target (the transition is skipped if it is already in that state) */
+    renderContextD3D.TransitionRenderTarget(barrierBatch_, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    /* Set current back buffer as RTV */
+    rtvDescHandle_ = renderContextD3D.GetCPUDescriptorHandleForCurrentRTV();
+    dsvDescHandle_ = renderContextD3D.GetCPUDescriptorHandleForDSV();
+
+    if (dsvDescHandle_.ptr != 0)
+    {
+        /* Set current RTV and DSV */
+        commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, &dsvDescHandle_);
+    }
+    else
+    {
+        /* Set only current RTV */
+        commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, nullptr);
+    }
+}
+
+void D3D12CommandBuffer::SetScissorRectsWithFramebufferExtent(UINT numScissorRects)
+{
+    numScissorRects = std::min(numScissorRects, UINT(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
+
+    if (numScissorRects > numBoundScissorRects_ && !IsBundle())
+    {
+        /* Set scissor to render target resolution */
+        D3D12_RECT scissorRects[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+
+        for (UINT i = 0; i < numScissorRects; ++i)
+        {
+            scissorRects[i].left    = 0;
+            scissorRects[i].top     = 0;
+            scissorRects[i].right   = framebufferWidth_;
+            scissorRects[i].bottom  = framebufferHeight_;
+        }
+
+        commandList_->RSSetScissorRects(numScissorRects, scissorRects);
 
         /* Store new number of bound scissor rectangles */
         numBoundScissorRects_ = numScissorRects;
@@ -454,5 +1828,10 @@ void D3D12CommandBuffer::SetScissorRectsWithFramebufferExtent(UINT numScissorRec
 } // /namespace LLGL
 
 
+/* Implement non-virtual command buffer functions for LLGL_BACKEND=Direct3D12 */
+#define LLGL_DIRECT_DISPATCH_CLASS D3D12CommandBuffer
+#include "../DirectDispatch.h"
+
+
 
 // ================================================================================
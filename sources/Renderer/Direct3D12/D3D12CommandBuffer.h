@@ -13,9 +13,17 @@
 #include <cstddef>
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
+#include "D3D12BundlePool.h"
+#include "D3D12BarrierBatch.h"
+#include "D3D12ResidencyManager.h"
+#include "../TimerScopeRecorder.h"
+#include "../StatisticsCounter.h"
+#include "../TransientRing.h"
 
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -24,6 +32,10 @@ namespace LLGL
 
 class D3D12RenderSystem;
 class D3D12RenderContext;
+class D3D12DescriptorHeapRing;
+class D3D12QueryHeap;
+class D3D12ResourceHeap;
+class D3D12ConstantBuffer;
 
 class D3D12CommandBuffer final : public CommandBuffer
 {
@@ -32,7 +44,9 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         /* ----- Common ----- */
 
-        D3D12CommandBuffer(D3D12RenderSystem& renderSystem);
+        // Constructs a command buffer for either direct command lists or bundles (D3D12_COMMAND_LIST_TYPE_BUNDLE).
+        D3D12CommandBuffer(D3D12RenderSystem& renderSystem, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT, long flags = 0);
+        ~D3D12CommandBuffer();
 
         /* ----- Configuration ----- */
 
@@ -40,10 +54,10 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         /* ----- Viewport and Scissor ----- */
 
-        void SetViewport(const Viewport& viewport) override;
+        void SetViewport(const Viewport& viewport) LLGL_DISPATCH_OVERRIDE;
         void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
 
-        void SetScissor(const Scissor& scissor) override;
+        void SetScissor(const Scissor& scissor) LLGL_DISPATCH_OVERRIDE;
         void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
 
         /* ----- Clear ----- */
@@ -57,10 +71,12 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         /* ----- Input Assembly ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
 
         /* ----- Stream Output Buffers ------ */
 
@@ -70,20 +86,69 @@ class D3D12CommandBuffer final : public CommandBuffer
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Resource Heaps ----- */
 
-        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
-        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
 
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
         /* ----- Pipeline States ----- */
 
-        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
-        void SetComputePipeline(ComputePipeline& computePipeline) override;
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) LLGL_DISPATCH_OVERRIDE;
+        void SetComputePipeline(ComputePipeline& computePipeline) LLGL_DISPATCH_OVERRIDE;
+
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
 
         /* ----- Queries ----- */
 
@@ -96,23 +161,104 @@ class D3D12CommandBuffer final : public CommandBuffer
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
         /* ----- Drawing ----- */
 
-        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) LLGL_DISPATCH_OVERRIDE;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) override;
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) override;
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) override;
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
 
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
         /* ----- Compute ----- */
 
-        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) LLGL_DISPATCH_OVERRIDE;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
 
         /* ----- Extended functions ----- */
 
@@ -123,17 +269,134 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         void ResetCommandList(ID3D12CommandAllocator* commandAlloc, ID3D12PipelineState* pipelineState);
 
+        // Returns the batch of pending resource barriers, which is flushed before the next draw, dispatch, clear, or copy command.
+        inline D3D12BarrierBatch& GetBarrierBatch()
+        {
+            return barrierBatch_;
+        }
+
+        // Records all pending resource barriers into the command list. Must be called before the command list is closed.
+        void FlushResourceBarriers();
+
+        // Assigns all bundles that have been executed since the last submission to the specified fence value.
+        void SubmitExecutedBundles(UINT64 fenceValue);
+
+        // Ends all open timer scopes, resolves the timestamps of the current timer scope frame into the readback buffer, and closes the frame.
+        void CloseTimerScopeFrame();
+
+        // Assigns the last closed timer scope frame to the specified fence value, after which its timestamps can be read.
+        void SubmitTimerScopeFrame(UINT64 fenceValue);
+
+        // Resolves the results of all queries that have been ended since the last call into the readback buffers of their query heaps.
+        void ResolveQueryHeaps();
+
+        // Assigns the query heaps that have been resolved since the last submission to the specified fence value.
+        void SubmitQueryHeaps(UINT64 fenceValue);
+
+        // Makes all buffers and textures that have been referenced since the last submission resident. Must be called before the command list is executed.
+        void MakeResident(ID3D12CommandQueue* queue);
+
+        // Assigns the buffers and textures that have been referenced since the last submission to the specified fence value.
+        void SubmitResidencySet(UINT64 fenceValue);
+
+        // Assigns the transient memory that has been allocated since the last submission to the specified fence value.
+        void SubmitTransientMemory(UINT64 fenceValue);
+
+        // Returns true if any transient memory has been allocated since the last submission.
+        inline bool HasTransientMemory() const
+        {
+            return transientRing_.HasOpenSegment();
+        }
+
+        // Returns true if any tracked buffers or textures have been referenced since the last submission.
+        inline bool HasResidencySet() const
+        {
+            return !residencySet_.empty();
+        }
+
+        // Returns true if any bundles have been executed since the last submission.
+        inline bool HasExecutedBundles() const
+        {
+            return !executedBundles_.empty();
+        }
+
+        // Returns true if this command buffer records bundles.
+        inline bool IsBundle() const
+        {
+            return (bundlePool_ != nullptr);
+        }
+
     private:
 
         static const UINT maxNumBuffers = 3;
 
-        void CreateDevices(D3D12RenderSystem& renderSystem);
+        // Last bound objects and parameters of the current command list, to filter redundant state changes.
+        struct BindingCache
+        {
+            ID3D12PipelineState*        pipelineState       = nullptr;
+            D3D12_PRIMITIVE_TOPOLOGY    primitiveTopology   = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+            const void*                 vertexBuffers       = nullptr;  // Buffer or buffer array bound to the first vertex input slot
+            std::uint64_t               vertexBufferOffset  = 0;
+            D3D12_INDEX_BUFFER_VIEW     indexBufferView     = {};
+            bool                        viewportValid       = false;
+            Viewport                    viewport;
+        };
+
+        void CreateDevices(D3D12RenderSystem& renderSystem, D3D12_COMMAND_LIST_TYPE type);
+        void CreateTimerQueryHeap(D3D12RenderSystem& renderSystem);
+        void CreateStatisticsQueryHeap();
+
+        // Begins a new pipeline statistics segment for the open timer scopes (see CommandBufferFlags::TimerScopeStatistics).
+        void BeginStatisticsSegment();
+
+        // Ends the active pipeline statistics segment of the timer scopes.
+        void EndStatisticsSegment();
+
+        // Creates the transient ring buffer in the upload heap with the first transient allocation.
+        void CreateTransientBuffer();
 
         // Sets the current back buffer as render target view.
+        // Discards the attachments of the current render pass whose load operations (or store operations) are undefined.
+        void DiscardRenderPassAttachments(bool loadOps);
+
         void SetBackBufferRTV(D3D12RenderContext& renderContextD3D);
 
         void SetScissorRectsWithFramebufferExtent(UINT numScissorRects);
 
+        // Binds the global shader-visible descriptor heaps, if they have not been bound since the last reset of the command list.
+        void BindDescriptorHeapRings();
+
+        // Invalidates the bound root signature and root arguments, e.g. after the command list has been reset.
+        void InvalidateRootBindings();
+
+        // Sets the specified index buffer view unless the same view is already bound.
+        void SetIndexBufferView(const D3D12_INDEX_BUFFER_VIEW& view);
+
+        // Invalidates all cached bindings, e.g. after the command list has been reset or a bundle has been executed.
+        inline void ResetBindingCache()
+        {
+            bindingCache_ = BindingCache{};
+        }
+
+        // Begins recording of the next bundle (if no bundle is being recorded).
+        void BeginBundle();
+
+        // Closes the current bundle (if it is being recorded) and returns it.
+        ID3D12GraphicsCommandList* FinishBundle();
+
+        // Appends the residency entries of the specified resources to the residency set of the next submission.
+        void TrackResidency(D3D12ResidencyEntry* entry);
+        void TrackResidency(const std::vector<D3D12ResidencyEntry*>& entries);
+
+        // Records an indirect command with the command signature of the specified argument type and stride.
+        void ExecuteIndirect(D3D12_INDIRECT_ARGUMENT_TYPE type, Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride);
+
+        D3D12RenderSystem&                  renderSystem_;
+        StatisticsCounter&                  statistics_;
+        ID3D12Device*                       device_                 = nullptr;
+        D3D12DescriptorHeapRing*            descriptorRings_[2]     = {};       // CBV/SRV/UAV and sampler descriptor heap rings
+        bool                                descriptorRingsBound_   = false;
+
         ComPtr<ID3D12CommandAllocator>      commandAlloc_;
         ComPtr<ID3D12GraphicsCommandList>   commandList_;
 
@@ -142,12 +405,57 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         ClearValue                          clearValue_;
 
+        D3D12BarrierBatch                   barrierBatch_;
+
+        const RenderPass*                   boundRenderPass_        = nullptr;
+        D3D12RenderContext*                 boundRenderContext_     = nullptr;  // Render context of the current render pass
+
         bool                                scissorEnabled_         = false;
+        INT                                 graphicsConstantsIndex_ = -1;   // Root parameter index of the constants of the bound graphics pipeline
+        ID3D12RootSignature*                boundRootSignature_     = nullptr;  // Graphics root signature whose root arguments are currently bound
+        D3D12ResourceHeap*                  boundResourceHeap_      = nullptr;  // Resource heap whose descriptor tables are currently bound to 'boundRootSignature_'
+        std::uint32_t                       boundResourceHeapVersion_ = 0;    // Version of 'boundResourceHeap_' when its descriptor tables were copied
         UINT                                numBoundScissorRects_   = 0;
+        BindingCache                        bindingCache_;
 
         LONG                                framebufferWidth_       = 0;
         LONG                                framebufferHeight_      = 0;
 
+        /* Bundles executed with this command list, which are released with the fence value of the next submission */
+        std::vector<D3D12BundleRef>         executedBundles_;
+
+        /* Bundle pool of a secondary command buffer (null for direct command lists) */
+        std::shared_ptr<D3D12BundlePool>    bundlePool_;
+        bool                                bundleRecording_        = false;
+        bool                                bundleEnded_            = false;    // Specifies whether the recording of this bundle has been ended explicitly
+
+        /* Timestamp queries of the timer scopes, partitioned into one range for each timer scope frame */
+        TimerScopeRecorder                  timerScopes_;
+        ComPtr<ID3D12QueryHeap>             timerQueryHeap_;
+        ComPtr<ID3D12Resource>              timerReadbackBuffer_;
+        UINT64                              timerFenceValues_[TimerScopeRecorder::maxNumFrames];
+        UINT                                timerClosedFrame_       = 0;
+        bool                                timerFrameClosed_       = false;    // Specifies whether 'timerClosedFrame_' awaits its fence value
+        double                              timestampPeriod_        = 1.0;      // Number of nanoseconds per timestamp tick
+
+        /* Pipeline statistics queries of the timer scope segments (only if CommandBufferFlags::TimerScopeStatistics is specified) */
+        ComPtr<ID3D12QueryHeap>             statisticsQueryHeap_;
+        ComPtr<ID3D12Resource>              statisticsReadbackBuffer_;
+        std::vector<QueryPipelineStatistics> statisticsResults_;
+
+        /* Buffers and textures referenced since the last submission, which must be resident when the command list is executed */
+        std::vector<D3D12ResidencyEntry*>   residencySet_;
+        const void*                         residencyLastEntries_   = nullptr;  // Last tracked list of residency entries, to skip redundant bindings
+
+        /* Query heaps with dirty queries, and query heaps whose results await the fence value of the next submission */
+        std::vector<D3D12QueryHeap*>        dirtyQueryHeaps_;
+        std::vector<D3D12QueryHeap*>        resolvedQueryHeaps_;
+
+        /* Persistently mapped upload buffer for transient memory, whose segments are recycled with the fence values of their submissions */
+        std::unique_ptr<D3D12ConstantBuffer> transientBuffer_;
+        char*                               transientData_          = nullptr;
+        TransientRing<UINT64>               transientRing_;
+
 };
 
 
@@ -7,6 +7,7 @@
 
 #include "D3D12CommandQueue.h"
 #include "D3D12CommandBuffer.h"
+#include "D3D12RenderSystem.h"
 #include "../CheckedCast.h"
 #include "../DXCommon/DXCore.h"
 #include "RenderState/D3D12Fence.h"
@@ -16,7 +17,8 @@ namespace LLGL
 {
 
 
-D3D12CommandQueue::D3D12CommandQueue(ComPtr<ID3D12CommandQueue>& queue, ComPtr<ID3D12CommandAllocator>& commandAlloc) :
+D3D12CommandQueue::D3D12CommandQueue(D3D12RenderSystem& renderSystem, ComPtr<ID3D12CommandQueue>& queue, ComPtr<ID3D12CommandAllocator>& commandAlloc) :
+    renderSystem_ { renderSystem },
     queue_        { queue        },
     commandAlloc_ { commandAlloc }
 {
@@ -26,22 +28,56 @@ D3D12CommandQueue::D3D12CommandQueue(ComPtr<ID3D12CommandQueue>& queue, ComPtr<I
 
 void D3D12CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
-    auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, commandBuffer);
-
-    /* Get hardware command list */
-    auto commandList = commandBufferD3D.GetCommandList();
-
-    /* Close graphics command list */
-    auto hr = commandList->Close();
-    DXThrowIfFailed(hr, "failed to close D3D12 command list");
-
-    /* Execute command list */
-    ID3D12CommandList* cmdLists[] = { commandList };
-    queue_->ExecuteCommandLists(1, cmdLists);
+    CommandBuffer* commandBuffers[] = { &commandBuffer };
+    Submit(1, commandBuffers);
+}
 
-    /* Reset command list */
-    hr = commandList->Reset(commandAlloc_.Get(), nullptr);
-    DXThrowIfFailed(hr, "failed to reset D3D12 graphics command list");
+void D3D12CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence, std::uint64_t signalValue)
+{
+    commandLists_.clear();
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, *commandBuffers[i]);
+
+        /* Record pending resource barriers, then close graphics command list */
+        auto commandList = commandBufferD3D.GetCommandList();
+        commandBufferD3D.FlushResourceBarriers();
+        auto hr = commandList->Close();
+        DXThrowIfFailed(hr, "failed to close D3D12 command list");
+
+        /* Make referenced resources resident before any command list of this batch is executed */
+        commandBufferD3D.MakeResident(queue_.Get());
+
+        commandLists_.push_back(commandList);
+    }
+
+    /* Execute all command lists with a single call */
+    if (!commandLists_.empty())
+        queue_->ExecuteCommandLists(static_cast<UINT>(commandLists_.size()), commandLists_.data());
+
+    if (signalFence != nullptr)
+        Signal(*signalFence, signalValue);
+
+    /* Recycle executed bundles and transient memory, and mark referenced resources as used until the GPU has completed this batch */
+    UINT64 fenceValue = 0;
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, *commandBuffers[i]);
+
+        if (commandBufferD3D.HasExecutedBundles() || commandBufferD3D.HasResidencySet() || commandBufferD3D.HasTransientMemory())
+        {
+            if (fenceValue == 0)
+                fenceValue = renderSystem_.SignalFenceValue();
+            commandBufferD3D.SubmitExecutedBundles(fenceValue);
+            commandBufferD3D.SubmitResidencySet(fenceValue);
+            commandBufferD3D.SubmitTransientMemory(fenceValue);
+        }
+
+        /* Reset command list */
+        commandBufferD3D.ResetCommandList(commandAlloc_.Get(), nullptr);
+    }
 }
 
 /* ----- Fences ----- */
@@ -64,6 +100,42 @@ void D3D12CommandQueue::WaitIdle()
     //renderSystem_.SyncGPU(fenceValues_[currentFrame_]);
 }
 
+/* ----- Timeline fences ----- */
+
+void D3D12CommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    fenceD3D.Signal(queue_.Get(), value);
+}
+
+void D3D12CommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    fenceD3D.QueueWait(queue_.Get(), value);
+}
+
+bool D3D12CommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    return fenceD3D.WaitValue(value, timeout);
+}
+
+bool D3D12CommandQueue::WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout)
+{
+    /* Gather native fences and the values to wait for (local arrays, since multiple threads may wait concurrently) */
+    std::vector<ID3D12Fence*>   nativeFences(numFences);
+    std::vector<UINT64>         nativeValues(numFences);
+
+    for (std::uint32_t i = 0; i < numFences; ++i)
+    {
+        auto fenceD3D = LLGL_CAST(D3D12Fence*, fences[i]);
+        nativeFences[i] = fenceD3D->GetNative();
+        nativeValues[i] = (values != nullptr ? values[i] : fenceD3D->GetValue());
+    }
+
+    return D3D12WaitForFenceValues(renderSystem_.GetDevice(), numFences, nativeFences.data(), nativeValues.data(), timeout);
+}
+
 
 } // /namespace LLGL
 
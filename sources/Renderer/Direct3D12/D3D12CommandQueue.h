@@ -12,22 +12,26 @@
 #include <LLGL/CommandQueue.h>
 #include "../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class D3D12RenderSystem;
+
 class D3D12CommandQueue final : public CommandQueue
 {
 
     public:
 
-        D3D12CommandQueue(ComPtr<ID3D12CommandQueue>& queue, ComPtr<ID3D12CommandAllocator>& commandAlloc);
+        D3D12CommandQueue(D3D12RenderSystem& renderSystem, ComPtr<ID3D12CommandQueue>& queue, ComPtr<ID3D12CommandAllocator>& commandAlloc);
 
         /* ----- Command queues ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence = nullptr, std::uint64_t signalValue = 0) override;
 
         /* ----- Fences ----- */
 
@@ -36,6 +40,13 @@ class D3D12CommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+        /* ----- Timeline fences ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        bool WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout) override;
+
         /* ----- Extended functions ----- */
 
         inline ID3D12CommandQueue* GetDxCommandQueue() const
@@ -45,9 +56,12 @@ class D3D12CommandQueue final : public CommandQueue
 
     private:
 
+        D3D12RenderSystem&              renderSystem_;
         ComPtr<ID3D12CommandQueue>      queue_;
         ComPtr<ID3D12CommandAllocator>  commandAlloc_;
 
+        std::vector<ID3D12CommandList*> commandLists_;  // Command lists of the current batch, see Submit(std::uint32_t, CommandBuffer* const*, Fence*, std::uint64_t)
+
 };
 
 
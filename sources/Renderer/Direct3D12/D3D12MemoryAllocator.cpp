@@ -0,0 +1,404 @@
+/*
+ * D3D12MemoryAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MemoryAllocator.h"
+#include "D3DX12/d3dx12.h"
+#include "../DXCommon/DXCore.h"
+#include "../../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Size of each heap for placed buffers and textures
+static const UINT64 g_heapChunkSize         = 64*1024*1024;
+
+// Size of each shared buffer for sub-allocated buffers
+static const UINT64 g_sharedBufferChunkSize = 4*1024*1024;
+
+// Maximal size of buffers that are sub-allocated from shared buffers (i.e. buffers that would waste most of the default placement alignment)
+static const UINT64 g_maxSharedBufferSize   = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+enum class D3D12MemoryChunkKind
+{
+    BufferHeap,     // ID3D12Heap for placed buffers
+    TextureHeap,    // ID3D12Heap for placed non-RT/DS textures
+    SharedBuffer,   // Buffer resource for sub-allocated buffers
+    Dedicated,      // Committed resource
+};
+
+// Chunk of memory with a free list of ranges, sorted by their offsets.
+class D3D12MemoryChunk
+{
+
+    public:
+
+        D3D12MemoryChunk(D3D12MemoryChunkKind kind, D3D12_HEAP_TYPE heapType, UINT64 size) :
+            kind     { kind     },
+            heapType { heapType },
+            size     { size     },
+            freeRanges_ { { 0, size } }
+        {
+        }
+
+        // Allocates a range of the specified size and alignment with the first fitting free range.
+        bool Alloc(UINT64 allocSize, UINT64 alignment, UINT64& offset)
+        {
+            for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it)
+            {
+                const auto alignedOffset    = GetAlignedSize(it->offset, alignment);
+                const auto rangeEnd         = it->offset + it->size;
+                const auto allocEnd         = alignedOffset + allocSize;
+
+                if (allocEnd > rangeEnd)
+                    continue;
+
+                /* Keep leading padding and trailing remainder as free ranges */
+                if (alignedOffset > it->offset)
+                {
+                    it->size = alignedOffset - it->offset;
+                    if (allocEnd < rangeEnd)
+                        freeRanges_.insert(it + 1, { allocEnd, rangeEnd - allocEnd });
+                }
+                else if (allocEnd < rangeEnd)
+                {
+                    it->offset  = allocEnd;
+                    it->size    = rangeEnd - allocEnd;
+                }
+                else
+                    freeRanges_.erase(it);
+
+                offset = alignedOffset;
+                usedSize += allocSize;
+
+                return true;
+            }
+            return false;
+        }
+
+        // Returns the specified range to the free list and merges it with its neighbours.
+        void Free(UINT64 offset, UINT64 allocSize)
+        {
+            auto it = std::lower_bound(
+                freeRanges_.begin(), freeRanges_.end(), offset,
+                [](const FreeRange& range, UINT64 value)
+                {
+                    return (range.offset < value);
+                }
+            );
+
+            it = freeRanges_.insert(it, { offset, allocSize });
+            usedSize -= allocSize;
+
+            /* Merge with next range */
+            auto next = it + 1;
+            if (next != freeRanges_.end() && it->offset + it->size == next->offset)
+            {
+                it->size += next->size;
+                freeRanges_.erase(next);
+            }
+
+            /* Merge with previous range */
+            if (it != freeRanges_.begin())
+            {
+                auto prev = it - 1;
+                if (prev->offset + prev->size == it->offset)
+                {
+                    prev->size += it->size;
+                    freeRanges_.erase(it);
+                }
+            }
+        }
+
+    public:
+
+        const D3D12MemoryChunkKind  kind;
+        const D3D12_HEAP_TYPE       heapType;
+        const UINT64                size;
+        UINT64                      usedSize    = 0;
+
+        ComPtr<ID3D12Heap>          heap;           // Heap for placed resources
+        ComPtr<ID3D12Resource>      buffer;         // Shared buffer or dedicated resource
+        D3D12ResidencyEntry         residencyEntry;
+
+    private:
+
+        struct FreeRange
+        {
+            UINT64 offset;
+            UINT64 size;
+        };
+
+        std::vector<FreeRange>      freeRanges_;
+
+};
+
+D3D12MemoryAllocator::D3D12MemoryAllocator(ID3D12Device* device, D3D12ResidencyManager& residencyManager) :
+    device_           { device           },
+    residencyManager_ { residencyManager }
+{
+}
+
+D3D12MemoryAllocator::~D3D12MemoryAllocator()
+{
+    // dummy (required for std::unique_ptr of incomplete type in header)
+}
+
+ComPtr<ID3D12Resource> D3D12MemoryAllocator::CreateBuffer(UINT64 size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation)
+{
+    ComPtr<ID3D12Resource> resource;
+
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+    if (heapType == D3D12_HEAP_TYPE_UPLOAD && size <= g_maxSharedBufferSize)
+    {
+        /* Sub-allocate small buffer from a shared buffer, aligned for constant buffer views */
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        UINT64 offset = 0;
+        auto chunk = AllocRange(D3D12MemoryChunkKind::SharedBuffer, heapType, size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, g_sharedBufferChunkSize, offset);
+
+        allocation.chunk            = chunk;
+        allocation.offset           = offset;
+        allocation.size             = size;
+        allocation.bufferOffset     = offset;
+        allocation.residencyEntry   = &(chunk->residencyEntry);
+
+        return chunk->buffer;
+    }
+
+    if (size > g_heapChunkSize / 2)
+        return CreateDedicated(bufferDesc, heapType, initialState, allocation);
+
+    /* Place buffer within a heap (buffers always use the default placement alignment) */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        UINT64 offset = 0;
+        auto chunk = AllocRange(D3D12MemoryChunkKind::BufferHeap, heapType, size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, g_heapChunkSize, offset);
+
+        allocation.chunk            = chunk;
+        allocation.offset           = offset;
+        allocation.size             = size;
+        allocation.bufferOffset     = 0;
+        allocation.residencyEntry   = &(chunk->residencyEntry);
+    }
+
+    auto hr = device_->CreatePlacedResource(
+        allocation.chunk->heap.Get(),
+        allocation.offset,
+        &bufferDesc,
+        initialState,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 placed resource for buffer");
+
+    return resource;
+}
+
+ComPtr<ID3D12Resource> D3D12MemoryAllocator::CreateTexture(D3D12_RESOURCE_DESC desc, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation)
+{
+    /* Multi-sampled textures require a larger heap alignment */
+    if (desc.SampleDesc.Count > 1)
+        return CreateDedicated(desc, D3D12_HEAP_TYPE_DEFAULT, initialState, allocation);
+
+    /* Try small placement alignment, which the device only accepts for small textures */
+    desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+    auto allocInfo = device_->GetResourceAllocationInfo(0, 1, &desc);
+
+    if (allocInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+    {
+        desc.Alignment  = 0;
+        allocInfo       = device_->GetResourceAllocationInfo(0, 1, &desc);
+    }
+
+    if (allocInfo.SizeInBytes > g_heapChunkSize / 2)
+        return CreateDedicated(desc, D3D12_HEAP_TYPE_DEFAULT, initialState, allocation);
+
+    /* Place texture within a heap */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        UINT64 offset = 0;
+        auto chunk = AllocRange(D3D12MemoryChunkKind::TextureHeap, D3D12_HEAP_TYPE_DEFAULT, allocInfo.SizeInBytes, allocInfo.Alignment, g_heapChunkSize, offset);
+
+        allocation.chunk            = chunk;
+        allocation.offset           = offset;
+        allocation.size             = allocInfo.SizeInBytes;
+        allocation.bufferOffset     = 0;
+        allocation.residencyEntry   = &(chunk->residencyEntry);
+    }
+
+    ComPtr<ID3D12Resource> resource;
+    auto hr = device_->CreatePlacedResource(
+        allocation.chunk->heap.Get(),
+        allocation.offset,
+        &desc,
+        initialState,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 placed resource for texture");
+
+    return resource;
+}
+
+void D3D12MemoryAllocator::Free(D3D12MemoryAllocation& allocation)
+{
+    if (auto chunk = allocation.chunk)
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        if (chunk->kind == D3D12MemoryChunkKind::Dedicated)
+            ReleaseChunk(chunk);
+        else
+        {
+            chunk->Free(allocation.offset, allocation.size);
+
+            /* Release empty chunk unless it is the last chunk of its kind */
+            if (chunk->usedSize == 0)
+            {
+                auto numChunksOfKind = std::count_if(
+                    chunks_.begin(), chunks_.end(),
+                    [chunk](const std::unique_ptr<D3D12MemoryChunk>& entry)
+                    {
+                        return (entry->kind == chunk->kind && entry->heapType == chunk->heapType);
+                    }
+                );
+                if (numChunksOfKind > 1)
+                    ReleaseChunk(chunk);
+            }
+        }
+
+        allocation = D3D12MemoryAllocation{};
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+D3D12MemoryChunk* D3D12MemoryAllocator::AllocChunk(D3D12MemoryChunkKind kind, D3D12_HEAP_TYPE heapType, UINT64 size)
+{
+    auto chunk = MakeUnique<D3D12MemoryChunk>(kind, heapType, size);
+
+    CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+
+    if (kind == D3D12MemoryChunkKind::SharedBuffer)
+    {
+        /* Create shared buffer, which always remains in the generic read state of the upload heap */
+        auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+        auto hr = device_->CreateCommittedResource(
+            &heapProperties,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(chunk->buffer.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfFailed(hr, "failed to create D3D12 shared buffer for sub-allocated buffers");
+    }
+    else
+    {
+        /* Create heap for buffers or textures only, which is supported by all resource heap tiers */
+        D3D12_HEAP_DESC heapDesc;
+        {
+            heapDesc.SizeInBytes    = size;
+            heapDesc.Properties     = heapProperties;
+            heapDesc.Alignment      = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            heapDesc.Flags          = (kind == D3D12MemoryChunkKind::BufferHeap ? D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES);
+        }
+        auto hr = device_->CreateHeap(&heapDesc, IID_PPV_ARGS(chunk->heap.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 heap for placed resources");
+
+        /* Track residency of heaps in video memory; upload heaps are not evicted */
+        if (heapType == D3D12_HEAP_TYPE_DEFAULT)
+            residencyManager_.Register(chunk->residencyEntry, chunk->heap.Get(), size);
+    }
+
+    chunks_.push_back(std::move(chunk));
+
+    return chunks_.back().get();
+}
+
+D3D12MemoryChunk* D3D12MemoryAllocator::AllocRange(D3D12MemoryChunkKind kind, D3D12_HEAP_TYPE heapType, UINT64 size, UINT64 alignment, UINT64 chunkSize, UINT64& offset)
+{
+    for (const auto& chunk : chunks_)
+    {
+        if (chunk->kind == kind && chunk->heapType == heapType && chunk->Alloc(size, alignment, offset))
+            return chunk.get();
+    }
+
+    auto chunk = AllocChunk(kind, heapType, chunkSize);
+    if (!chunk->Alloc(size, alignment, offset))
+        throw std::runtime_error("failed to allocate D3D12 memory from new chunk");
+
+    return chunk;
+}
+
+ComPtr<ID3D12Resource> D3D12MemoryAllocator::CreateDedicated(const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation)
+{
+    /* Create committed resource */
+    ComPtr<ID3D12Resource> resource;
+
+    CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+    auto hr = device_->CreateCommittedResource(
+        &heapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &desc,
+        initialState,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 committed resource");
+
+    /* Store committed resource in a dedicated chunk, so its residency is tracked like any heap */
+    const auto allocInfo = device_->GetResourceAllocationInfo(0, 1, &desc);
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    auto chunk = MakeUnique<D3D12MemoryChunk>(D3D12MemoryChunkKind::Dedicated, heapType, allocInfo.SizeInBytes);
+    chunk->buffer = resource;
+
+    if (heapType == D3D12_HEAP_TYPE_DEFAULT)
+        residencyManager_.Register(chunk->residencyEntry, resource.Get(), allocInfo.SizeInBytes);
+
+    allocation.chunk            = chunk.get();
+    allocation.offset           = 0;
+    allocation.size             = allocInfo.SizeInBytes;
+    allocation.bufferOffset     = 0;
+    allocation.residencyEntry   = &(chunk->residencyEntry);
+
+    chunks_.push_back(std::move(chunk));
+
+    return resource;
+}
+
+void D3D12MemoryAllocator::ReleaseChunk(D3D12MemoryChunk* chunk)
+{
+    residencyManager_.Unregister(chunk->residencyEntry);
+
+    RemoveFromListIf(
+        chunks_,
+        [chunk](const std::unique_ptr<D3D12MemoryChunk>& entry)
+        {
+            return (entry.get() == chunk);
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,99 @@
+/*
+ * D3D12MemoryAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MEMORY_ALLOCATOR_H
+#define LLGL_D3D12_MEMORY_ALLOCATOR_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include "D3D12ResidencyManager.h"
+#include <d3d12.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class D3D12MemoryChunk;
+enum class D3D12MemoryChunkKind;
+
+// Memory of a buffer or texture that has been created by the memory allocator.
+struct D3D12MemoryAllocation
+{
+    D3D12MemoryChunk*       chunk           = nullptr;
+    UINT64                  offset          = 0;        // Offset within the chunk
+    UINT64                  size            = 0;
+    UINT64                  bufferOffset    = 0;        // Offset of a sub-allocated buffer within its shared buffer resource (zero otherwise)
+    D3D12ResidencyEntry*    residencyEntry  = nullptr;  // Residency state of the chunk, i.e. placed resources are made resident or evicted together with their heap
+};
+
+/*
+D3D12 memory allocator, analogous to the Vulkan device memory manager. Memory is managed in chunks of the following kinds:
+ - Heap: a large ID3D12Heap, in which buffers or textures are placed with 'CreatePlacedResource'.
+ - Shared buffer: a large buffer resource in the upload heap, from which small buffers are sub-allocated (they share the resource and its state).
+ - Dedicated: a single committed resource, for resources that are too large for a heap or require a special alignment (e.g. multi-sampled textures).
+Released ranges are merged with their neighbours, and empty chunks are released unless they are the last chunk of their kind.
+*/
+class D3D12MemoryAllocator
+{
+
+    public:
+
+        D3D12MemoryAllocator(ID3D12Device* device, D3D12ResidencyManager& residencyManager);
+        ~D3D12MemoryAllocator();
+
+        D3D12MemoryAllocator(const D3D12MemoryAllocator&) = delete;
+        D3D12MemoryAllocator& operator = (const D3D12MemoryAllocator&) = delete;
+
+        /*
+        Creates a buffer resource in the specified heap type. Buffers in the upload heap up to 64 KB are sub-allocated from a shared buffer,
+        in which case the returned resource is shared and 'allocation.bufferOffset' specifies the start of the buffer within that resource.
+        */
+        ComPtr<ID3D12Resource> CreateBuffer(UINT64 size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation);
+
+        // Creates a texture resource in the default heap. Small textures use the small placement alignment if the device supports it for the resource.
+        ComPtr<ID3D12Resource> CreateTexture(D3D12_RESOURCE_DESC desc, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation);
+
+        // Releases the memory of the specified allocation. The resource must not be used by the GPU anymore.
+        void Free(D3D12MemoryAllocation& allocation);
+
+        inline ID3D12Device* GetDevice() const
+        {
+            return device_;
+        }
+
+    private:
+
+        D3D12MemoryChunk* AllocChunk(D3D12MemoryChunkKind kind, D3D12_HEAP_TYPE heapType, UINT64 size);
+
+        // Allocates a range from the first chunk of the specified kind and heap type that has enough space, or from a new chunk.
+        D3D12MemoryChunk* AllocRange(D3D12MemoryChunkKind kind, D3D12_HEAP_TYPE heapType, UINT64 size, UINT64 alignment, UINT64 chunkSize, UINT64& offset);
+
+        ComPtr<ID3D12Resource> CreateDedicated(const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState, D3D12MemoryAllocation& allocation);
+
+        void ReleaseChunk(D3D12MemoryChunk* chunk);
+
+        ID3D12Device*                                   device_             = nullptr;
+        D3D12ResidencyManager&                          residencyManager_;
+
+        std::vector<std::unique_ptr<D3D12MemoryChunk>>  chunks_;
+        std::mutex                                      mutex_;             // Guards the chunks, since resources may be created on worker threads
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
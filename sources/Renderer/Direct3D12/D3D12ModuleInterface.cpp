@@ -12,24 +12,25 @@
 extern "C"
 {
 
-LLGL_EXPORT int LLGL_RenderSystem_BuildID()
+LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, Direct3D12)()
 {
     return LLGL_BUILD_ID;
 }
 
-LLGL_EXPORT int LLGL_RenderSystem_RendererID()
+LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, Direct3D12)()
 {
     return LLGL::RendererID::Direct3D12;
 }
 
-LLGL_EXPORT const char* LLGL_RenderSystem_Name()
+LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, Direct3D12)()
 {
     return "Direct3D 12";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* /*renderSystemDesc*/)
+LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, Direct3D12)(const void* renderSystemDesc)
 {
-    return new LLGL::D3D12RenderSystem();
+    auto desc = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+    return new LLGL::D3D12RenderSystem(*desc);
 }
 
 } // /extern "C"
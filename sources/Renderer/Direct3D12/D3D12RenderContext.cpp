@@ -7,6 +7,7 @@
 
 #include "D3D12RenderContext.h"
 #include "D3D12RenderSystem.h"
+#include "D3D12BarrierBatch.h"
 #include "D3D12Types.h"
 #include "../CheckedCast.h"
 #include <LLGL/Platform/NativeHandle.h>
@@ -31,13 +32,17 @@ namespace LLGL
 #   define LLGL_D3D12_SET_NAME(OBJ, NAME)
 #endif
 
+const UINT D3D12RenderContext::maxNumFramesInFlight;
+
 D3D12RenderContext::D3D12RenderContext(
     D3D12RenderSystem& renderSystem,
     RenderContextDescriptor desc,
     const std::shared_ptr<Surface>& surface) :
-        RenderContext     { desc.videoMode, desc.vsync       },
-        renderSystem_     { renderSystem                     },
-        swapChainSamples_ { desc.multiSampling.SampleCount() }
+        RenderContext      { desc.videoMode, desc.vsync         },
+        renderSystem_      { renderSystem                       },
+        swapChainSamples_  { desc.multiSampling.SampleCount()   },
+        numFramesInFlight_ { renderSystem.GetNumFramesInFlight() },
+        maxFrameLatency_   { DXGetMaxFrameLatency(desc.maxFrameLatency, numFramesInFlight_) }
 {
     #if 1 //TODO: multi-sampling currently not supported!
     swapChainSamples_ = 1;
@@ -52,12 +57,22 @@ D3D12RenderContext::D3D12RenderContext(
 
     /* Initialize v-sync */
     OnSetVsync(desc.vsync);
+
+    /* Start thread for swap-chain presentation */
+    if (desc.threadedPresent)
+        presentThread_ = MakeUnique<PresentThread>();
 }
 
 D3D12RenderContext::~D3D12RenderContext()
 {
+    /* Finish pending presentation before the swap-chain is released */
+    presentThread_.reset();
+
     /* Ensure the GPU is no longer referencing resources that are about to be released */
-    MoveToNextFrame();
+    SyncGPU();
+
+    if (frameLatencyWaitableObject_ != nullptr)
+        CloseHandle(frameLatencyWaitableObject_);
 }
 
 void D3D12RenderContext::Present()
@@ -67,37 +82,70 @@ void D3D12RenderContext::Present()
         throw std::runtime_error("cannot present framebuffer without D3D12 command allocator and/or command list");
 
     auto commandList = commandBuffer_->GetCommandList();
+    auto& barriers = commandBuffer_->GetBarrierBatch();
 
     if (HasMultiSampling())
     {
         /* Blit multi-sampled texture into back-buffer */
-        ResolveRenderTarget(commandList);
+        ResolveRenderTarget(commandList, barriers);
     }
     else
     {
         /* Indicate that the render target will now be used to present when the command list is done executing */
-        TransitionRenderTarget(D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+        TransitionRenderTarget(barriers, D3D12_RESOURCE_STATE_PRESENT);
     }
 
-    /* Execute pending command list */
+    /* Resolve timestamps of the timer scopes of this frame */
+    commandBuffer_->CloseTimerScopeFrame();
+
+    /* Resolve results of the queries that have been ended in this frame */
+    commandBuffer_->ResolveQueryHeaps();
+
+    /* Record pending resource barriers, make referenced resources resident, and execute command list after the previous frame has been presented */
+    commandBuffer_->FlushResourceBarriers();
+    commandBuffer_->MakeResident(renderSystem_.GetHardwareQueue());
+    FlushPresentThread();
     renderSystem_.CloseAndExecuteCommandList(commandList);
 
     /* Present swap-chain with vsync interval */
-    auto hr = swapChain_->Present(swapChainInterval_, 0);
-    DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+    if (presentThread_)
+    {
+        /* Hand presentation over to the present thread, so the caller can record the next frame while Present blocks */
+        auto swapChain  = swapChain_.Get();
+        auto interval   = swapChainInterval_;
+        presentThread_->Enqueue(
+            [swapChain, interval]()
+            {
+                auto hr = swapChain->Present(interval, 0);
+                DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+            }
+        );
+    }
+    else
+    {
+        auto hr = swapChain_->Present(swapChainInterval_, 0);
+        DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+    }
 
-    /* Advance frame counter */
+    /* Advance frame counter (only blocks if the next frame is still in flight) */
     MoveToNextFrame();
 
-    /* Reset command allocator and command list*/
-    auto commandAlloc = commandAllocs_[currentFrame_].Get();
+    /* Reset command allocator of the next frame and command list */
+    auto commandAlloc = commandAllocs_[currentFrameInFlight_].Get();
 
-    hr = commandAlloc->Reset();
+    auto hr = commandAlloc->Reset();
     DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
 
     commandBuffer_->ResetCommandList(commandAlloc, nullptr);
 }
 
+void D3D12RenderContext::WaitForNextFrame()
+{
+    /* Wait until the swap-chain has retired enough frames to stay within the maximum frame latency */
+    if (frameLatencyWaitableObject_ != nullptr)
+        WaitForSingleObjectEx(frameLatencyWaitableObject_, 1000, TRUE);
+}
+
 Format D3D12RenderContext::QueryColorFormat() const
 {
     return DXTypes::Unmap(colorFormat_);
@@ -140,12 +188,13 @@ void D3D12RenderContext::SetCommandBuffer(D3D12CommandBuffer* commandBuffer)
     commandBuffer_ = commandBuffer;
 }
 
-void D3D12RenderContext::TransitionRenderTarget(D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+void D3D12RenderContext::TransitionRenderTarget(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState)
 {
-    /* Indicate a transition in the render-target usage and synchronize with the resource barrier */
-    commandBuffer_->GetCommandList()->ResourceBarrier(
-        1, &CD3DX12_RESOURCE_BARRIER::Transition(colorBuffers_[currentFrame_].Get(), stateBefore, stateAfter)
-    );
+    /* Indicate a transition in the render-target usage, which is synchronized with the next flush of the barrier batch */
+    if (HasMultiSampling())
+        barriers.TransitionResource(colorBuffersMS_[currentFrame_].Get(), colorBufferMSStates_[currentFrame_], newState);
+    else
+        barriers.TransitionResource(colorBuffers_[currentFrame_].Get(), colorBufferStates_[currentFrame_], newState);
 }
 
 bool D3D12RenderContext::HasMultiSampling() const
@@ -160,7 +209,8 @@ bool D3D12RenderContext::HasDepthBuffer() const
 
 void D3D12RenderContext::SyncGPU()
 {
-    renderSystem_.SyncGPU(fenceValues_[currentFrame_]);
+    FlushPresentThread();
+    renderSystem_.SyncGPU();
 }
 
 
@@ -172,6 +222,9 @@ bool D3D12RenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc
 {
     const auto& prevVideoMode = GetVideoMode();
 
+    /* Swap-chain must not be modified while the present thread is using it */
+    FlushPresentThread();
+
     /* Re-create resource that depend on the window size */
     if (prevVideoMode.resolution != videoModeDesc.resolution)
         CreateWindowSizeDependentResources(videoModeDesc);
@@ -180,26 +233,33 @@ bool D3D12RenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc
     if (prevVideoMode.fullscreen != videoModeDesc.fullscreen)
         swapChain_->SetFullscreenState(videoModeDesc.fullscreen ? TRUE : FALSE, nullptr);
 
+    /* Update sync interval for the new presentation mode */
+    swapChainInterval_ = DXGetPresentSyncInterval(videoModeDesc.presentMode, GetVsync());
+
     return true;
 }
 
 bool D3D12RenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 {
-    swapChainInterval_ = (vsyncDesc.enabled ? std::max(1u, std::min(vsyncDesc.interval, 4u)) : 0u);
+    swapChainInterval_ = DXGetPresentSyncInterval(GetVideoMode().presentMode, vsyncDesc);
     return true;
 }
 
+bool D3D12RenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    return DXGetFrameStatistics(swapChain_.Get(), frameStats);
+}
+
 void D3D12RenderContext::CreateWindowSizeDependentResources(const VideoModeDescriptor& videoModeDesc)
 {
     /* Wait until all previous GPU work is complete */
     SyncGPU();
 
-    /* Release previous window size dependent resources, and reset fence values to current value */
+    /* Release previous window size dependent resources */
     for (UINT i = 0; i < numFrames_; ++i)
     {
         colorBuffers_[i].Reset();
         colorBuffersMS_[i].Reset();
-        fenceValues_[i] = fenceValues_[currentFrame_];
     }
 
     depthStencil_.Reset();
@@ -221,7 +281,7 @@ void D3D12RenderContext::CreateWindowSizeDependentResources(const VideoModeDescr
             framebufferWidth,
             framebufferHeight,
             colorFormat_,
-            0
+            DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT
         );
 
         if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
@@ -251,11 +311,15 @@ void D3D12RenderContext::CreateWindowSizeDependentResources(const VideoModeDescr
             swapChainDesc.Scaling               = DXGI_SCALING_NONE;
             swapChainDesc.SwapEffect            = DXGI_SWAP_EFFECT_FLIP_DISCARD;
             swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
-            swapChainDesc.Flags                 = 0;
+            swapChainDesc.Flags                 = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
         }
         auto swapChain = renderSystem_.CreateDXSwapChain(swapChainDesc, wndHandle.window);
 
         swapChain.As(&swapChain_);
+
+        /* Limit the frame latency (by default to the number of frames in flight), and get the waitable object for frame pacing */
+        swapChain_->SetMaximumFrameLatency(maxFrameLatency_);
+        frameLatencyWaitableObject_ = swapChain_->GetFrameLatencyWaitableObject();
     }
 
     /* Create color buffer render target views (RTV) */
@@ -303,6 +367,7 @@ void D3D12RenderContext::CreateColorBufferRTVs(const VideoModeDescriptor& videoM
 
         /* Create render target view (RTV) */
         device->CreateRenderTargetView(colorBuffers_[i].Get(), nullptr, rtvDescHandle);
+        colorBufferStates_[i] = D3D12_RESOURCE_STATE_PRESENT;
 
         #ifdef LLGL_DEBUG
         std::wstring name = L"LLGL::D3D12RenderContext::colorBuffer" + std::to_wstring(i);
@@ -346,6 +411,7 @@ void D3D12RenderContext::CreateColorBufferRTVs(const VideoModeDescriptor& videoM
 
             /* Create render target view (RTV) */
             device->CreateRenderTargetView(colorBuffersMS_[i].Get(), nullptr, rtvDescHandle);
+            colorBufferMSStates_[i] = D3D12_RESOURCE_STATE_COMMON;
 
             rtvDescHandle.Offset(1, rtvDescSize_);
         }
@@ -409,63 +475,69 @@ void D3D12RenderContext::CreateDeviceResources()
     /* Store size of RTV descriptor */
     rtvDescSize_ = renderSystem_.GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
-    /* Create command allocators */
-    for (UINT i = 0; i < g_maxSwapChainSize; ++i)
+    /* Create one command allocator for each frame in flight */
+    for (UINT i = 0; i < numFramesInFlight_; ++i)
         commandAllocs_[i] = renderSystem_.CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
 }
 
 void D3D12RenderContext::MoveToNextFrame()
 {
-    /* Schedule signal command into the qeue */
-    auto currentFenceValue = fenceValues_[currentFrame_];
-    renderSystem_.SignalFenceValue(currentFenceValue);
+    /* Schedule signal command for the frame that has just been submitted into the queue */
+    frameFenceValues_[currentFrameInFlight_] = renderSystem_.SignalFenceValue();
 
-    /* Advance frame index */
-    currentFrame_ = swapChain_->GetCurrentBackBufferIndex();
+    /* Recycle the descriptors this frame has copied into the global descriptor heaps once the fence has been reached */
+    renderSystem_.SubmitDescriptorHeapRings(frameFenceValues_[currentFrameInFlight_]);
+
+    /* Destroy the objects released during this frame once the fence has been reached */
+    renderSystem_.SubmitReleasedObjects(frameFenceValues_[currentFrameInFlight_]);
+
+    /* Recycle the bundles this frame has executed once the fence has been reached */
+    commandBuffer_->SubmitExecutedBundles(frameFenceValues_[currentFrameInFlight_]);
+
+    /* Resources referenced in this frame can be evicted once the fence has been reached */
+    commandBuffer_->SubmitResidencySet(frameFenceValues_[currentFrameInFlight_]);
+
+    /* Timestamps of the timer scopes of this frame can be read once the fence has been reached */
+    commandBuffer_->SubmitTimerScopeFrame(frameFenceValues_[currentFrameInFlight_]);
 
-    /* Check to see if the next frame is ready to start */
-    renderSystem_.WaitForFenceValue(fenceValues_[currentFrame_]);
+    /* Query results of this frame can be read once the fence has been reached */
+    commandBuffer_->SubmitQueryHeaps(frameFenceValues_[currentFrameInFlight_]);
 
-    /* Set fence value for next frame */
-    fenceValues_[currentFrame_] = currentFenceValue + 1;
+    /* Advance frame-in-flight index */
+    currentFrameInFlight_ = (currentFrameInFlight_ + 1) % numFramesInFlight_;
+
+    /* Wait until the GPU has finished the commands that were previously recorded with the allocator of the next frame */
+    renderSystem_.WaitForFenceValue(frameFenceValues_[currentFrameInFlight_]);
+
+    /* Advance swap-chain buffer index (the present thread might not have presented yet, but the flip-model swap-chain advances sequentially) */
+    if (presentThread_)
+        currentFrame_ = (currentFrame_ + 1) % numFrames_;
+    else
+        currentFrame_ = swapChain_->GetCurrentBackBufferIndex();
+}
+
+void D3D12RenderContext::FlushPresentThread()
+{
+    if (presentThread_)
+        presentThread_->Flush();
 }
 
-void D3D12RenderContext::ResolveRenderTarget(ID3D12GraphicsCommandList* commandList)
+void D3D12RenderContext::ResolveRenderTarget(ID3D12GraphicsCommandList* commandList, D3D12BarrierBatch& barriers)
 {
+    auto colorBuffer    = colorBuffers_[currentFrame_].Get();
+    auto colorBufferMS  = colorBuffersMS_[currentFrame_].Get();
+
     /* Prepare render-target for resolving */
-    D3D12_RESOURCE_BARRIER resourceBarriersBefore[2] =
-    {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            colorBuffers_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RESOLVE_DEST
-        ),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            colorBuffersMS_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_RESOLVE_SOURCE
-        ),
-    };
-    commandList->ResourceBarrier(2, resourceBarriersBefore);
+    barriers.TransitionResource(colorBuffer, colorBufferStates_[currentFrame_], D3D12_RESOURCE_STATE_RESOLVE_DEST);
+    barriers.TransitionResource(colorBufferMS, colorBufferMSStates_[currentFrame_], D3D12_RESOURCE_STATE_RESOLVE_SOURCE);
+    barriers.Flush(commandList);
 
     /* Resolve multi-sampled render targets */
-    commandList->ResolveSubresource(
-        colorBuffers_[currentFrame_].Get(), 0,
-        colorBuffersMS_[currentFrame_].Get(), 0,
-        colorFormat_
-    );
+    commandList->ResolveSubresource(colorBuffer, 0, colorBufferMS, 0, colorFormat_);
 
-    /* Prepare render-targets for presenting */
-    D3D12_RESOURCE_BARRIER resourceBarriersAfter[2] =
-    {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            colorBuffers_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RESOLVE_DEST, D3D12_RESOURCE_STATE_PRESENT
-        ),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            colorBuffersMS_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RESOLVE_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET
-        ),
-    };
-    commandList->ResourceBarrier(2, resourceBarriersAfter);
+    /* Prepare render-targets for presenting (recorded with the next flush of the barrier batch) */
+    barriers.TransitionResource(colorBuffer, colorBufferStates_[currentFrame_], D3D12_RESOURCE_STATE_PRESENT);
+    barriers.TransitionResource(colorBufferMS, colorBufferMSStates_[currentFrame_], D3D12_RESOURCE_STATE_RENDER_TARGET);
 }
 
 #undef LLGL_D3D12_SET_NAME
@@ -12,8 +12,10 @@
 #include <LLGL/Window.h>
 #include <LLGL/RenderContext.h>
 #include <cstddef>
+#include <memory>
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
+#include "../PresentThread.h"
 
 #include <d3d12.h>
 #include <dxgi1_4.h>
@@ -25,12 +27,16 @@ namespace LLGL
 
 class D3D12RenderSystem;
 class D3D12CommandBuffer;
+class D3D12BarrierBatch;
 
 class D3D12RenderContext final : public RenderContext
 {
 
     public:
 
+        // Maximal number of frames the CPU can record ahead of the GPU.
+        static const UINT maxNumFramesInFlight = 8;
+
         D3D12RenderContext(
             D3D12RenderSystem& renderSystem,
             RenderContextDescriptor desc,
@@ -40,6 +46,7 @@ class D3D12RenderContext final : public RenderContext
         ~D3D12RenderContext();
 
         void Present() override;
+        void WaitForNextFrame() override;
 
         Format QueryColorFormat() const override;
         Format QueryDepthStencilFormat() const override;
@@ -51,13 +58,21 @@ class D3D12RenderContext final : public RenderContext
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForCurrentRTV() const;
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForDSV() const;
 
+        // Returns the native depth-stencil buffer or null if the context has no depth-stencil buffer.
+        inline ID3D12Resource* GetDepthStencilBuffer() const
+        {
+            return depthStencil_.Get();
+        }
+
         void SetCommandBuffer(D3D12CommandBuffer* commandBuffer);
 
-        void TransitionRenderTarget(D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter);
+        // Appends a transition of the current render target (i.e. the multi-sampled color buffer if multi-sampling is enabled) to the barrier batch.
+        void TransitionRenderTarget(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState);
 
         bool HasMultiSampling() const;
         bool HasDepthBuffer() const;
 
+        // Waits until the GPU has finished all frames in flight.
         void SyncGPU();
 
     private:
@@ -66,15 +81,20 @@ class D3D12RenderContext final : public RenderContext
 
         bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+        bool OnQueryFrameStatistics(FrameStatistics& frameStats) override;
 
         void CreateWindowSizeDependentResources(const VideoModeDescriptor& videoModeDesc);
         void CreateColorBufferRTVs(const VideoModeDescriptor& videoModeDesc);
         void CreateDepthStencil(const VideoModeDescriptor& videoModeDesc);
         void CreateDeviceResources();
 
+        // Signals the fence value of the current frame, and waits until the next frame in flight is no longer executed by the GPU.
         void MoveToNextFrame();
 
-        void ResolveRenderTarget(ID3D12GraphicsCommandList* commandList);
+        // Waits until the present thread (if enabled) has presented all previous frames.
+        void FlushPresentThread();
+
+        void ResolveRenderTarget(ID3D12GraphicsCommandList* commandList, D3D12BarrierBatch& barriers);
 
         D3D12RenderSystem&              renderSystem_;  // reference to its render system
         D3D12CommandBuffer*             commandBuffer_                      = nullptr;
@@ -82,6 +102,7 @@ class D3D12RenderContext final : public RenderContext
         ComPtr<IDXGISwapChain3>         swapChain_;
         UINT                            swapChainInterval_                  = 0;
         UINT                            swapChainSamples_                   = 1;
+        HANDLE                          frameLatencyWaitableObject_         = nullptr;  // Signaled when the swap-chain can accept the next frame, see WaitForNextFrame
 
         ComPtr<ID3D12DescriptorHeap>    rtvDescHeap_;
         UINT                            rtvDescSize_                        = 0;
@@ -89,16 +110,24 @@ class D3D12RenderContext final : public RenderContext
 
         ComPtr<ID3D12Resource>          colorBuffers_[g_maxSwapChainSize];
         ComPtr<ID3D12Resource>          colorBuffersMS_[g_maxSwapChainSize];
+        D3D12_RESOURCE_STATES           colorBufferStates_[g_maxSwapChainSize];     // Tracked states of the color buffers
+        D3D12_RESOURCE_STATES           colorBufferMSStates_[g_maxSwapChainSize];   // Tracked states of the multi-sampled color buffers
         DXGI_FORMAT                     colorFormat_                        = DXGI_FORMAT_B8G8R8A8_UNORM;
 
         ComPtr<ID3D12Resource>          depthStencil_;
         DXGI_FORMAT                     depthStencilFormat_                 = DXGI_FORMAT_UNKNOWN;
 
-        ComPtr<ID3D12CommandAllocator>  commandAllocs_[g_maxSwapChainSize];
-        UINT64                          fenceValues_[g_maxSwapChainSize]    = {};
-
         UINT                            numFrames_                          = 0;
-        UINT                            currentFrame_                       = 0;
+        UINT                            currentFrame_                       = 0;   // index of the current swap-chain buffer
+
+        ComPtr<ID3D12CommandAllocator>  commandAllocs_[maxNumFramesInFlight];
+        UINT64                          frameFenceValues_[maxNumFramesInFlight] = {};
+
+        UINT                            numFramesInFlight_                  = 1;
+        UINT                            currentFrameInFlight_               = 0;
+        UINT                            maxFrameLatency_                    = 1;
+
+        std::unique_ptr<PresentThread>  presentThread_;                                 // Presents the swap-chain if RenderContextDescriptor::threadedPresent is enabled
 
 };
 
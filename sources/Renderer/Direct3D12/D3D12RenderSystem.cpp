@@ -8,13 +8,19 @@
 #include "D3D12RenderSystem.h"
 #include "D3D12Types.h"
 #include "../DXCommon/DXCore.h"
+#include "../DXCommon/DXTypes.h"
 #include "../CheckedCast.h"
+#include "../MipChain.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 #include "D3DX12/d3dx12.h"
 //#include "RenderState/D3D12StateManager.h"
 #include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <cstring>
 
 #include "Buffer/D3D12VertexBuffer.h"
 #include "Buffer/D3D12VertexBufferArray.h"
@@ -27,8 +33,25 @@ namespace LLGL
 {
 
 
-D3D12RenderSystem::D3D12RenderSystem()
+D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
+    /* Extract optional renderer configuartion */
+    const Direct3D12RendererConfiguration* rendererConfigD3D = nullptr;
+
+    if (renderSystemDesc.rendererConfig != nullptr && renderSystemDesc.rendererConfigSize > 0)
+    {
+        if (renderSystemDesc.rendererConfigSize == sizeof(Direct3D12RendererConfiguration))
+            rendererConfigD3D = reinterpret_cast<const Direct3D12RendererConfiguration*>(renderSystemDesc.rendererConfig);
+        else
+            throw std::invalid_argument("invalid renderer configuration structure (expected size of 'Direct3D12RendererConfiguration' structure)");
+    }
+
+    if (rendererConfigD3D != nullptr)
+        numFramesInFlight_ = std::max(1u, std::min(rendererConfigD3D->numFramesInFlight, D3D12RenderContext::maxNumFramesInFlight));
+
+    const UINT64 uploadHeapSize = (rendererConfigD3D != nullptr ? rendererConfigD3D->uploadHeapSize : 4*1024*1024);
+    const UINT numDescriptors   = (rendererConfigD3D != nullptr ? std::max(1u, rendererConfigD3D->numShaderVisibleDescriptors) : 65536u);
+
     #ifdef LLGL_DEBUG
     EnableDebugLayer();
     #endif
@@ -36,20 +59,45 @@ D3D12RenderSystem::D3D12RenderSystem()
     /* Create DXGU factory 1.4, query video adapters, and create D3D12 device */
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice();
+    CreateDevice(renderSystemDesc);
     CreateGPUSynchObjects();
 
-    /* Create command queue, command allocator, and graphics command list */
-    queue_              = CreateDXCommandQueue();
+    /* Create pipeline library, which is replaced by SetPipelineCacheData */
+    pipelineLibrary_.Create(device_.Get());
+
+    /* Create command queue, command allocator, and graphics command list (D3D12 has no priority below normal, so foreground queues are raised instead) */
+    queue_              = CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_QUEUE_PRIORITY_HIGH);
 
     graphicsCmdAlloc_   = CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
     graphicsCmdList_    = CreateDXCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, graphicsCmdAlloc_.Get());
 
+    /* Create asynchronous compute queue and its command allocator */
+    computeQueue_       = CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE_COMPUTE, D3D12_COMMAND_QUEUE_PRIORITY_HIGH);
     computeCmdAlloc_    = CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_COMPUTE);
-    computeCmdList_     = CreateDXCommandList(D3D12_COMMAND_LIST_TYPE_COMPUTE, computeCmdAlloc_.Get());
+
+    /* Create background queue for low priority streaming work and its command allocator */
+    backgroundQueue_    = CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE_COMPUTE, D3D12_COMMAND_QUEUE_PRIORITY_NORMAL);
+    backgroundCmdAlloc_ = CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE_COMPUTE);
+
+    /* Create upload heap for transient buffer and texture updates */
+    uploadHeap_ = MakeUnique<D3D12UploadHeap>(*this, uploadHeapSize);
+
+    /* Create residency manager with the video memory budget of the selected adapter */
+    ComPtr<IDXGIAdapter> adapter;
+    factory_->EnumAdapters(adapterIndex_, adapter.ReleaseAndGetAddressOf());
+    residencyManager_ = MakeUnique<D3D12ResidencyManager>(*this, adapter.Get());
+
+    /* Create memory allocator for placed and sub-allocated buffers and textures */
+    memoryAllocator_ = MakeUnique<D3D12MemoryAllocator>(device_.Get(), *residencyManager_);
+
+    /* Create global shader-visible descriptor heaps, which are bound once per command list */
+    descriptorHeapRingCbvSrvUav_    = MakeUnique<D3D12DescriptorHeapRing>(*this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, numDescriptors);
+    descriptorHeapRingSampler_      = MakeUnique<D3D12DescriptorHeapRing>(*this, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE);
 
     /* Create command queue interface */
-    commandQueue_ = MakeUnique<D3D12CommandQueue>(queue_, graphicsCmdAlloc_);
+    commandQueue_           = MakeUnique<D3D12CommandQueue>(*this, queue_, graphicsCmdAlloc_);
+    computeCommandQueue_    = MakeUnique<D3D12CommandQueue>(*this, computeQueue_, computeCmdAlloc_);
+    backgroundCommandQueue_ = MakeUnique<D3D12CommandQueue>(*this, backgroundQueue_, backgroundCmdAlloc_);
 
     /* Initialize renderer information */
     QueryRendererInfo();
@@ -60,13 +108,14 @@ D3D12RenderSystem::~D3D12RenderSystem()
 {
     SyncGPU();
 
+    /* Destroy all deferred objects, since the GPU is idle now */
+    releaseQueue_.Clear();
+
     /*
     Release render targets first, to ensure the GPU is no longer
     referencing resources that are about to be released
     */
     renderContexts_.clear();
-
-    CloseHandle(fenceEvent_);
 }
 
 /* ----- Render Context ----- */
@@ -88,11 +137,23 @@ CommandQueue* D3D12RenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* D3D12RenderSystem::GetCommandQueue(const QueueType type)
+{
+    switch (type)
+    {
+        case QueueType::Graphics:   return commandQueue_.get();
+        case QueueType::Compute:    return computeCommandQueue_.get();
+        case QueueType::Background: return backgroundCommandQueue_.get();
+    }
+    return nullptr;
+}
+
 /* ----- Command buffers ----- */
 
-CommandBuffer* D3D12RenderSystem::CreateCommandBuffer()
+CommandBuffer* D3D12RenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<D3D12CommandBuffer>(*this));
+    const auto type = (desc.queueType == QueueType::Graphics ? D3D12_COMMAND_LIST_TYPE_DIRECT : D3D12_COMMAND_LIST_TYPE_COMPUTE);
+    return TakeOwnership(commandBuffers_, MakeUnique<D3D12CommandBuffer>(*this, type, desc.flags));
 }
 
 CommandBufferExt* D3D12RenderSystem::CreateCommandBufferExt()
@@ -101,39 +162,45 @@ CommandBufferExt* D3D12RenderSystem::CreateCommandBufferExt()
     return nullptr;
 }
 
+CommandBuffer* D3D12RenderSystem::CreateSecondaryCommandBuffer()
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<D3D12CommandBuffer>(*this, D3D12_COMMAND_LIST_TYPE_BUNDLE));
+}
+
 void D3D12RenderSystem::Release(CommandBuffer& commandBuffer)
 {
-    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+    /* Defer destruction until the frames that might still execute this command list have been completed */
+    releaseQueue_.Release(commandBuffers_, &commandBuffer);
 }
 
 /* ----- Buffers ------ */
 
 static std::unique_ptr<D3D12Buffer> MakeD3D12VertexBuffer(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer, const BufferDescriptor& desc, const void* initialData)
+    D3D12MemoryAllocator& allocator, ID3D12GraphicsCommandList* commandList, D3D12BarrierBatch& barriers, D3D12UploadHeap& uploadHeap, const BufferDescriptor& desc, const void* initialData)
 {
-    auto bufferD3D = MakeUnique<D3D12VertexBuffer>(device, desc);
+    auto bufferD3D = MakeUnique<D3D12VertexBuffer>(allocator, desc);
 
     if (initialData)
-        bufferD3D->UpdateSubresource(device, commandList, uploadBuffer, initialData, static_cast<UINT>(desc.size));
+        bufferD3D->UpdateStaticSubresource(commandList, barriers, uploadHeap, initialData, desc.size, 0);
 
     return std::move(bufferD3D);
 }
 
 static std::unique_ptr<D3D12Buffer> MakeD3D12IndexBuffer(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer, const BufferDescriptor& desc, const void* initialData)
+    D3D12MemoryAllocator& allocator, ID3D12GraphicsCommandList* commandList, D3D12BarrierBatch& barriers, D3D12UploadHeap& uploadHeap, const BufferDescriptor& desc, const void* initialData)
 {
-    auto bufferD3D = MakeUnique<D3D12IndexBuffer>(device, desc);
+    auto bufferD3D = MakeUnique<D3D12IndexBuffer>(allocator, desc);
 
     if (initialData)
-        bufferD3D->UpdateSubresource(device, commandList, uploadBuffer, initialData, static_cast<UINT>(desc.size));
+        bufferD3D->UpdateStaticSubresource(commandList, barriers, uploadHeap, initialData, desc.size, 0);
 
     return std::move(bufferD3D);
 }
 
 static std::unique_ptr<D3D12Buffer> MakeD3D12ConstantBuffer(
-    ID3D12Device* device, const BufferDescriptor& desc, const void* initialData)
+    D3D12MemoryAllocator& allocator, const BufferDescriptor& desc, const void* initialData)
 {
-    auto bufferD3D = MakeUnique<D3D12ConstantBuffer>(device, desc);
+    auto bufferD3D = MakeUnique<D3D12ConstantBuffer>(allocator, desc);
 
     if (initialData)
         bufferD3D->UpdateSubresource(initialData, static_cast<UINT>(desc.size));
@@ -141,9 +208,9 @@ static std::unique_ptr<D3D12Buffer> MakeD3D12ConstantBuffer(
     return std::move(bufferD3D);
 }
 
-static std::unique_ptr<D3D12Buffer> MakeD3D12StorageBuffer(ID3D12Device* device, const BufferDescriptor& desc, const void* /*initialData*/)
+static std::unique_ptr<D3D12Buffer> MakeD3D12StorageBuffer(D3D12MemoryAllocator& allocator, const BufferDescriptor& desc, const void* /*initialData*/)
 {
-    auto bufferD3D = MakeUnique<D3D12StorageBuffer>(device, desc);
+    auto bufferD3D = MakeUnique<D3D12StorageBuffer>(allocator, desc);
 
     //TODO...
 
@@ -151,14 +218,14 @@ static std::unique_ptr<D3D12Buffer> MakeD3D12StorageBuffer(ID3D12Device* device,
 }
 
 static std::unique_ptr<D3D12Buffer> MakeD3D12Buffer(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer, const BufferDescriptor& desc, const void* initialData)
+    D3D12MemoryAllocator& allocator, ID3D12GraphicsCommandList* commandList, D3D12BarrierBatch& barriers, D3D12UploadHeap& uploadHeap, const BufferDescriptor& desc, const void* initialData)
 {
     switch (desc.type)
     {
-        case BufferType::Vertex:    return MakeD3D12VertexBuffer(device, commandList, uploadBuffer, desc, initialData);
-        case BufferType::Index:     return MakeD3D12IndexBuffer(device, commandList, uploadBuffer, desc, initialData);
-        case BufferType::Constant:  return MakeD3D12ConstantBuffer(device, desc, initialData);
-        case BufferType::Storage:   return MakeD3D12StorageBuffer(device, desc, initialData);
+        case BufferType::Vertex:    return MakeD3D12VertexBuffer(allocator, commandList, barriers, uploadHeap, desc, initialData);
+        case BufferType::Index:     return MakeD3D12IndexBuffer(allocator, commandList, barriers, uploadHeap, desc, initialData);
+        case BufferType::Constant:  return MakeD3D12ConstantBuffer(allocator, desc, initialData);
+        case BufferType::Storage:   return MakeD3D12StorageBuffer(allocator, desc, initialData);
         default:                    return nullptr;
     }
 }
@@ -166,14 +233,16 @@ static std::unique_ptr<D3D12Buffer> MakeD3D12Buffer(
 // private
 std::unique_ptr<D3D12Buffer> D3D12RenderSystem::MakeBufferAndInitialize(const BufferDescriptor& desc, const void* initialData)
 {
-    /* Create buffer and upload data to GPU */
-    ComPtr<ID3D12Resource> uploadBuffer;
+    /* Create buffer and record upload commands */
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+    auto buffer = MakeD3D12Buffer(*memoryAllocator_, graphicsCmdList_.Get(), graphicsBarriers_, *uploadHeap_, desc, initialData);
 
-    auto buffer = MakeD3D12Buffer(device_.Get(), graphicsCmdList_.Get(), uploadBuffer, desc, initialData);
-
-    /* Execute upload commands and wait for GPU to finish execution */
-    ExecuteCommandList();
-    SyncGPU();
+    /* Execute upload commands without waiting for the GPU (upload regions are recycled by the fence) */
+    if (buffer && initialData)
+    {
+        D3D12AppendResidencySet(uploadResidencySet_, buffer->GetResidencyEntry());
+        SubmitUploads();
+    }
 
     return buffer;
 }
@@ -205,7 +274,14 @@ BufferArray* D3D12RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buff
 
 void D3D12RenderSystem::Release(Buffer& buffer)
 {
-    RemoveFromUniqueSet(buffers_, &buffer);
+    /* Defer destruction until pending uploads and frames that might still reference this buffer have been completed */
+    releaseQueue_.Release(
+        buffers_, &buffer,
+        [this](D3D12Buffer& bufferD3D)
+        {
+            memoryAllocator_->Free(bufferD3D.GetMemoryAllocation());
+        }
+    );
 }
 
 void D3D12RenderSystem::Release(BufferArray& bufferArray)
@@ -215,8 +291,23 @@ void D3D12RenderSystem::Release(BufferArray& bufferArray)
 
 void D3D12RenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_STATISTICS_ADD(bytesUploaded, dataSize);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
-    bufferD3D.UpdateDynamicSubresource(data, static_cast<UINT64>(dataSize), static_cast<UINT64>(offset));
+
+    if (bufferD3D.IsHostVisible())
+    {
+        /* Write data directly into buffer within upload heap */
+        bufferD3D.UpdateDynamicSubresource(data, static_cast<UINT64>(dataSize), static_cast<UINT64>(offset));
+    }
+    else
+    {
+        /* Copy data via upload heap and execute upload commands without waiting for the GPU */
+        std::lock_guard<std::mutex> lock { uploadMutex_ };
+        bufferD3D.UpdateStaticSubresource(graphicsCmdList_.Get(), graphicsBarriers_, *uploadHeap_, data, static_cast<UINT64>(dataSize), static_cast<UINT64>(offset));
+        D3D12AppendResidencySet(uploadResidencySet_, bufferD3D.GetResidencyEntry());
+        SubmitUploads();
+    }
 }
 
 void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
@@ -224,21 +315,115 @@ void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
     return nullptr;//todo...
 }
 
+void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    return nullptr;//todo...
+}
+
 void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 {
     //todo...
 }
 
+std::uint32_t D3D12RenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    auto& fenceD3D  = LLGL_CAST(D3D12Fence&, fence);
+
+    /* Allocate readback and (re-)create its buffer in the readback heap if it is too small */
+    auto readback = bufferReadbacks_.Alloc(size);
+    auto& rb = bufferReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+        auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+        auto hr = device_->CreateCommittedResource(
+            &heapProperties,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(rb.staging.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfFailed(hr, "failed to create D3D12 readback buffer for asynchronous buffer readback");
+
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.dataSize = size;
+
+    /* Copy range into the readback buffer */
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+    bufferD3D.TransitionResource(graphicsBarriers_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    graphicsBarriers_.Flush(graphicsCmdList_.Get());
+
+    graphicsCmdList_->CopyBufferRegion(rb.staging.Get(), 0, bufferD3D.GetNative(), offset, size);
+
+    bufferD3D.TransitionToUsageState(graphicsBarriers_);
+    D3D12AppendResidencySet(uploadResidencySet_, bufferD3D.GetResidencyEntry());
+
+    /* Execute copy command without waiting for the GPU, and signal fence once it has been completed */
+    ExecuteCommandList();
+    fenceD3D.Submit(queue_.Get());
+
+    return readback;
+}
+
+void D3D12RenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    LLGL_ASSERT_PTR(data);
+
+    auto& rb = bufferReadbacks_.Get(readback);
+    AssertBufferReadbackDataSize(dataSize, rb.dataSize);
+
+    /* Wait until the buffer data has been copied into the readback buffer */
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, *rb.fence);
+    fenceD3D.Wait(~0ull);
+
+    /* Map readback buffer and copy buffer data into the output */
+    const D3D12_RANGE readRange { 0, static_cast<SIZE_T>(rb.dataSize) };
+    void* mappedData = nullptr;
+
+    auto hr = rb.staging->Map(0, &readRange, &mappedData);
+    DXThrowIfFailed(hr, "failed to map D3D12 readback buffer");
+    {
+        ::memcpy(data, mappedData, static_cast<std::size_t>(rb.dataSize));
+    }
+    const D3D12_RANGE writtenRange { 0, 0 };
+    rb.staging->Unmap(0, &writtenRange);
+
+    /* Return readback buffer to the pool */
+    bufferReadbacks_.Free(readback);
+}
+
 /* ----- Textures ----- */
 
 Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    auto textureD3D = MakeUnique<D3D12Texture>(device_.Get(), textureDesc);
+    const bool gpuImageConversion = GetConfiguration().gpuImageConversion;
 
-    /* Upload image data */
-    ComPtr<ID3D12Resource> uploadBuffer;
+    auto textureD3D = MakeUnique<D3D12Texture>(*memoryAllocator_, textureDesc, gpuImageConversion);
 
-    if (imageDesc)
+    if (imageDesc && gpuImageConversion && D3D12ImageConverter::IsConversionSupported(*textureD3D, *imageDesc))
+    {
+        std::lock_guard<std::mutex> lock { uploadMutex_ };
+
+        /* Create built-in image converter with its first use, since it compiles its compute shader */
+        if (!imageConverter_)
+            imageConverter_ = MakeUnique<D3D12ImageConverter>(*this);
+
+        /* Upload image data as it is and convert it into the texture format on the GPU */
+        const auto numMipLevels = NumMipChainLevels(textureDesc, *imageDesc);
+        imageConverter_->UploadAndConvert(graphicsCmdList_.Get(), graphicsBarriers_, *uploadHeap_, *textureD3D, textureDesc, *imageDesc, numMipLevels);
+
+        /* Execute upload commands without waiting for the GPU */
+        D3D12AppendResidencySet(uploadResidencySet_, textureD3D->GetResidencyEntry());
+        SubmitUploads();
+    }
+    else if (imageDesc)
     {
         /* Get texture dimensions */
         auto texWidth   = textureDesc.extent.width;
@@ -248,43 +433,296 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
             texHeight = 1u;
 
         /* Check if image data conversion is necessary */
-        auto initialData    = imageDesc->data;
-        auto dstTexFormat   = DXGetTextureFormatDesc(textureD3D->GetFormat());
+        auto initialImageDesc   = *imageDesc;
+        auto dstTexFormat       = DXGetTextureFormatDesc(textureD3D->GetFormat());
 
         ByteBuffer tempImageData;
 
-        if (dstTexFormat.format != imageDesc->format || dstTexFormat.dataType != imageDesc->dataType)
+        const bool isCompressed = IsCompressedFormat(textureDesc.format);
+
+        if (!isCompressed && (dstTexFormat.format != imageDesc->format || dstTexFormat.dataType != imageDesc->dataType))
         {
-            /* Convert image data (e.g. from RGB to RGBA) */
+            /* Convert image data (e.g. from RGB to RGBA), which converts the entire MIP-map chain at once */
             tempImageData = ConvertImageBuffer(*imageDesc, dstTexFormat.format, dstTexFormat.dataType, GetConfiguration().threadCount);
-            initialData = tempImageData.get();
+
+            const auto numPixels = imageDesc->dataSize / (ImageFormatSize(imageDesc->format) * DataTypeSize(imageDesc->dataType));
+            initialImageDesc.format     = dstTexFormat.format;
+            initialImageDesc.dataType   = dstTexFormat.dataType;
+            initialImageDesc.data       = tempImageData.get();
+            initialImageDesc.dataSize   = ImageDataSize(dstTexFormat.format, dstTexFormat.dataType, static_cast<std::uint32_t>(numPixels));
         }
 
-        /* Upload image data to subresource */
-        D3D12_SUBRESOURCE_DATA subresourceData;
+        /* Set up subresource data of the first array layer for each MIP level (compressed images are addressed by rows of blocks) */
+        const auto numMipLevels = NumMipChainLevels(textureDesc, initialImageDesc);
+        std::vector<D3D12_SUBRESOURCE_DATA> subresourceData(numMipLevels);
+
+        for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
         {
-            subresourceData.pData       = initialData;
-            subresourceData.RowPitch    = ImageFormatSize(dstTexFormat.format) * DataTypeSize(dstTexFormat.dataType) * texWidth;
-            subresourceData.SlicePitch  = subresourceData.RowPitch * texHeight;
+            const auto mipWidth     = std::max(1u, texWidth  >> mipLevel);
+            const auto mipHeight    = std::max(1u, texHeight >> mipLevel);
+
+            auto& mipData = subresourceData[mipLevel];
+            {
+                mipData.pData = GetMipChainLevel(textureDesc, initialImageDesc, mipLevel).data;
+                if (isCompressed)
+                {
+                    mipData.RowPitch    = TextureBufferSize(textureDesc.format, { mipWidth, 1u, 1u });
+                    mipData.SlicePitch  = TextureBufferSize(textureDesc.format, { mipWidth, mipHeight, 1u });
+                }
+                else
+                {
+                    mipData.RowPitch    = ImageFormatSize(dstTexFormat.format) * DataTypeSize(dstTexFormat.dataType) * mipWidth;
+                    mipData.SlicePitch  = mipData.RowPitch * mipHeight;
+                }
+            }
         }
-        textureD3D->UpdateSubresource(device_.Get(), graphicsCmdList_.Get(), uploadBuffer, subresourceData);
-    }
 
-    /* Execute upload commands and wait for GPU to finish execution */
-    ExecuteCommandList();
-    SyncGPU();
+        /* Upload all MIP levels with a single region of the upload heap */
+        std::lock_guard<std::mutex> lock { uploadMutex_ };
+        textureD3D->UpdateSubresource(graphicsCmdList_.Get(), graphicsBarriers_, *uploadHeap_, subresourceData.data(), numMipLevels);
+
+        /* Execute upload commands without waiting for the GPU (upload regions are recycled by the fence) */
+        D3D12AppendResidencySet(uploadResidencySet_, textureD3D->GetResidencyEntry());
+        SubmitUploads();
+    }
 
     return TakeOwnership(textures_, std::move(textureD3D));
 }
 
+Texture* D3D12RenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureD3D = LLGL_CAST(D3D12Texture&, sharedTexture);
+    return TakeOwnership(textures_, MakeUnique<D3D12Texture>(sharedTextureD3D, textureViewDesc));
+}
+
 void D3D12RenderSystem::Release(Texture& texture)
 {
-    //RemoveFromUniqueSet(textures_, &texture);
+    /* Defer destruction until pending uploads and frames that might still reference this texture have been completed */
+    releaseQueue_.Release(
+        textures_, &texture,
+        [this](D3D12Texture& textureD3D)
+        {
+            memoryAllocator_->Free(textureD3D.GetMemoryAllocation());
+        }
+    );
+}
+
+// Returns the specified value aligned to the next multiple of 'alignment' (which must be a power of two).
+static UINT64 AlignD3D12Offset(UINT64 value, UINT64 alignment)
+{
+    return ((value + alignment - 1) & ~(alignment - 1));
 }
 
 void D3D12RenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc)
 {
-    //todo...
+    const SubTextureImage region { subTextureDesc, imageDesc };
+    WriteTextureRegions(texture, 1, &region);
+}
+
+void D3D12RenderSystem::WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions)
+{
+    if (numRegions == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+
+    const auto format = DXTypes::Unmap(textureD3D.GetFormat());
+    if (IsMultiSampleTexture(textureD3D.GetType()) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot upload texture with multi-sampled type or depth-stencil format");
+
+    /* Determine placed footprints of all regions within a single allocation of the upload heap (same layout as in BeginTextureUpload) */
+    const auto blockExtent = FormatBlockExtent(format);
+
+    std::vector<TextureUpload> uploads(numRegions);
+    UINT64 uploadSize = 0;
+
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        const auto& subTextureDesc = regions[i].subTexture;
+        const auto& imageDesc = regions[i].image;
+
+        LLGL_STATISTICS_ADD(bytesUploaded, imageDesc.dataSize);
+        AssertImageDataSize(imageDesc.dataSize, TextureBufferSize(format, subTextureDesc.extent));
+
+        auto& upload = uploads[i];
+        textureD3D.GetSubresourceRegion(subTextureDesc.offset, subTextureDesc.extent, upload.baseArrayLayer, upload.numArrayLayers, upload.dstBox);
+
+        const auto width    = (upload.dstBox.right - upload.dstBox.left);
+        const auto height   = (upload.dstBox.bottom - upload.dstBox.top);
+        const auto numRows  = (height + blockExtent.height - 1) / blockExtent.height;
+
+        auto& footprint = upload.footprint;
+        {
+            footprint.Offset                = AlignD3D12Offset(uploadSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+            footprint.Footprint.Format      = textureD3D.GetFormat();
+            footprint.Footprint.Width       = (width + blockExtent.width - 1) / blockExtent.width * blockExtent.width;
+            footprint.Footprint.Height      = numRows * blockExtent.height;
+            footprint.Footprint.Depth       = (upload.dstBox.back - upload.dstBox.front);
+            footprint.Footprint.RowPitch    = static_cast<UINT>(
+                AlignD3D12Offset(TextureBufferSize(format, Extent3D{ width, 1, 1 }), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
+            );
+        }
+
+        upload.layerSize    = AlignD3D12Offset(static_cast<UINT64>(footprint.Footprint.RowPitch) * numRows * footprint.Footprint.Depth, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+        upload.mipLevel     = subTextureDesc.mipLevel;
+        upload.texture      = (&textureD3D);
+
+        uploadSize = footprint.Offset + upload.layerSize * upload.numArrayLayers;
+    }
+
+    auto region = uploadHeap_->Allocate(uploadSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    /* Copy tightly packed rows of each region into the pitched layout of the upload heap */
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        const auto& upload      = uploads[i];
+        const auto& footprint   = upload.footprint.Footprint;
+
+        const auto srcRowSize   = TextureBufferSize(format, Extent3D{ upload.dstBox.right - upload.dstBox.left, 1, 1 });
+        const auto numRows      = footprint.Height / blockExtent.height;
+        const auto numSlices    = footprint.Depth * upload.numArrayLayers;
+
+        auto srcData = static_cast<const char*>(regions[i].image.data);
+
+        for (UINT slice = 0; slice < numSlices; ++slice)
+        {
+            const auto layer        = slice / footprint.Depth;
+            const auto sliceOffset  = upload.footprint.Offset + upload.layerSize * layer + static_cast<UINT64>(footprint.RowPitch) * numRows * (slice % footprint.Depth);
+            auto dstData = region.mappedData + sliceOffset;
+
+            for (UINT row = 0; row < numRows; ++row, srcData += srcRowSize, dstData += footprint.RowPitch)
+                ::memcpy(dstData, srcData, srcRowSize);
+        }
+    }
+
+    /* Copy all regions from the upload heap into the texture with a single pair of resource transitions */
+    textureD3D.TransitionResource(graphicsBarriers_, D3D12_RESOURCE_STATE_COPY_DEST);
+    graphicsBarriers_.Flush(graphicsCmdList_.Get());
+
+    for (const auto& upload : uploads)
+    {
+        auto footprint = upload.footprint;
+        footprint.Offset += region.offset;
+
+        for (UINT layer = 0; layer < upload.numArrayLayers; ++layer, footprint.Offset += upload.layerSize)
+        {
+            const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(
+                textureD3D.GetNative(),
+                D3D12CalcSubresource(upload.mipLevel, upload.baseArrayLayer + layer, 0, textureD3D.GetNumMipLevels(), textureD3D.GetNumArrayLayers())
+            );
+            const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(region.resource, footprint);
+            graphicsCmdList_->CopyTextureRegion(&dstLocationD3D, upload.dstBox.left, upload.dstBox.top, upload.dstBox.front, &srcLocationD3D, nullptr);
+        }
+    }
+
+    textureD3D.TransitionToUsageState(graphicsBarriers_);
+    D3D12AppendResidencySet(uploadResidencySet_, textureD3D.GetResidencyEntry());
+
+    /* Execute upload commands without waiting for the GPU */
+    SubmitUploads();
+}
+
+TextureUploadMemory D3D12RenderSystem::BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc)
+{
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+
+    if (textureUpload_.texture != nullptr)
+        throw std::runtime_error("cannot begin texture upload while another texture upload is in progress");
+
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+
+    const auto format = DXTypes::Unmap(textureD3D.GetFormat());
+    if (IsMultiSampleTexture(textureD3D.GetType()) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot upload texture with multi-sampled type or depth-stencil format");
+
+    /* Determine array layers and box of the region */
+    auto& upload = textureUpload_;
+    textureD3D.GetSubresourceRegion(subTextureDesc.offset, subTextureDesc.extent, upload.baseArrayLayer, upload.numArrayLayers, upload.dstBox);
+
+    /* Determine placed footprint of each array layer (compressed formats cover entire blocks, rows and layers must be aligned within the upload heap) */
+    const auto blockExtent  = FormatBlockExtent(format);
+    const auto width        = (upload.dstBox.right - upload.dstBox.left);
+    const auto height       = (upload.dstBox.bottom - upload.dstBox.top);
+    const auto numRows      = (height + blockExtent.height - 1) / blockExtent.height;
+
+    auto& footprint = upload.footprint;
+    {
+        footprint.Offset                = 0;
+        footprint.Footprint.Format      = textureD3D.GetFormat();
+        footprint.Footprint.Width       = (width + blockExtent.width - 1) / blockExtent.width * blockExtent.width;
+        footprint.Footprint.Height      = numRows * blockExtent.height;
+        footprint.Footprint.Depth       = (upload.dstBox.back - upload.dstBox.front);
+        footprint.Footprint.RowPitch    = static_cast<UINT>(
+            AlignD3D12Offset(TextureBufferSize(format, Extent3D{ width, 1, 1 }), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
+        );
+    }
+
+    const auto depthPitch = static_cast<UINT64>(footprint.Footprint.RowPitch) * numRows;
+    upload.layerSize = AlignD3D12Offset(depthPitch * footprint.Footprint.Depth, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    /* Allocate staging memory for all array layers from the upload heap */
+    auto region = uploadHeap_->Allocate(upload.layerSize * upload.numArrayLayers, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    footprint.Offset    = region.offset;
+    upload.srcBuffer    = region.resource;
+    upload.mipLevel     = subTextureDesc.mipLevel;
+    upload.texture      = (&textureD3D);
+
+    TextureUploadMemory memory;
+    {
+        memory.data = region.mappedData;
+        if (textureD3D.GetType() == TextureType::Texture1DArray)
+        {
+            /* Each array layer of a 1D-array texture is a single row of the upload */
+            memory.rowPitch     = static_cast<std::uint32_t>(upload.layerSize);
+            memory.slicePitch   = upload.layerSize * upload.numArrayLayers;
+        }
+        else
+        {
+            memory.rowPitch     = footprint.Footprint.RowPitch;
+            memory.slicePitch   = (upload.numArrayLayers > 1 ? upload.layerSize : depthPitch);
+        }
+    }
+    return memory;
+}
+
+void D3D12RenderSystem::EndTextureUpload()
+{
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+
+    if (textureUpload_.texture == nullptr)
+        throw std::runtime_error("cannot end texture upload without a preceding call to BeginTextureUpload");
+
+    auto& upload        = textureUpload_;
+    auto& textureD3D    = *upload.texture;
+
+    LLGL_STATISTICS_ADD(bytesUploaded, upload.layerSize * upload.numArrayLayers);
+
+    /* Copy each array layer from the upload heap into the texture */
+    textureD3D.TransitionResource(graphicsBarriers_, D3D12_RESOURCE_STATE_COPY_DEST);
+    graphicsBarriers_.Flush(graphicsCmdList_.Get());
+
+    auto footprint = upload.footprint;
+
+    for (UINT layer = 0; layer < upload.numArrayLayers; ++layer, footprint.Offset += upload.layerSize)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(
+            textureD3D.GetNative(),
+            D3D12CalcSubresource(upload.mipLevel, upload.baseArrayLayer + layer, 0, textureD3D.GetNumMipLevels(), textureD3D.GetNumArrayLayers())
+        );
+        const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(upload.srcBuffer, footprint);
+        graphicsCmdList_->CopyTextureRegion(&dstLocationD3D, upload.dstBox.left, upload.dstBox.top, upload.dstBox.front, &srcLocationD3D, nullptr);
+    }
+
+    textureD3D.TransitionToUsageState(graphicsBarriers_);
+    D3D12AppendResidencySet(uploadResidencySet_, textureD3D.GetResidencyEntry());
+
+    upload.texture = nullptr;
+
+    /* Execute upload commands without waiting for the GPU */
+    SubmitUploads();
 }
 
 void D3D12RenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
@@ -292,26 +730,191 @@ void D3D12RenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLev
     //todo
 }
 
+std::uint32_t D3D12RenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureD3D    = LLGL_CAST(D3D12Texture&, texture);
+    auto& fenceD3D      = LLGL_CAST(D3D12Fence&, fence);
+
+    const auto format = DXTypes::Unmap(textureD3D.GetFormat());
+    if (IsMultiSampleTexture(textureD3D.GetType()) || IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot read texture with compressed, depth-stencil, or multi-sampled format asynchronously");
+
+    /* Determine array layers and box of the region */
+    UINT        baseArrayLayer = 0, numArrayLayers = 0;
+    D3D12_BOX   srcBox;
+    textureD3D.GetSubresourceRegion(region.offset, region.extent, baseArrayLayer, numArrayLayers, srcBox);
+
+    /* Determine placed footprint of each array layer (rows and layers must be aligned within the readback buffer) */
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+    {
+        footprint.Offset                = 0;
+        footprint.Footprint.Format      = textureD3D.GetFormat();
+        footprint.Footprint.Width       = (srcBox.right - srcBox.left);
+        footprint.Footprint.Height      = (srcBox.bottom - srcBox.top);
+        footprint.Footprint.Depth       = (srcBox.back - srcBox.front);
+        footprint.Footprint.RowPitch    = static_cast<UINT>(
+            AlignD3D12Offset(footprint.Footprint.Width * (FormatBitSize(format) / 8), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
+        );
+    }
+
+    const auto layerSize = AlignD3D12Offset(
+        static_cast<UINT64>(footprint.Footprint.RowPitch) * footprint.Footprint.Height * footprint.Footprint.Depth,
+        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+    );
+    const auto size = layerSize * numArrayLayers;
+
+    /* Allocate readback and (re-)create its buffer in the readback heap if it is too small */
+    auto readback = textureReadbacks_.Alloc(size);
+    auto& rb = textureReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+        auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+        auto hr = device_->CreateCommittedResource(
+            &heapProperties,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(rb.staging.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfFailed(hr, "failed to create D3D12 readback buffer for asynchronous texture readback");
+
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.format   = format;
+    rb.extent   = region.extent;
+
+    if (textureD3D.GetType() == TextureType::Texture1DArray)
+    {
+        /* Each array layer of a 1D-array texture is a single row of the readback */
+        rb.rowPitch     = static_cast<std::uint32_t>(layerSize);
+        rb.slicePitch   = size;
+    }
+    else
+    {
+        rb.rowPitch     = footprint.Footprint.RowPitch;
+        rb.slicePitch   = (numArrayLayers > 1 ? layerSize : static_cast<UINT64>(footprint.Footprint.RowPitch) * footprint.Footprint.Height);
+    }
+
+    /* Copy region of each array layer into the readback buffer */
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+    textureD3D.TransitionResource(graphicsBarriers_, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    graphicsBarriers_.Flush(graphicsCmdList_.Get());
+
+    for (UINT layer = 0; layer < numArrayLayers; ++layer, footprint.Offset += layerSize)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dstLocationD3D(rb.staging.Get(), footprint);
+        const CD3DX12_TEXTURE_COPY_LOCATION srcLocationD3D(
+            textureD3D.GetNative(),
+            D3D12CalcSubresource(region.mipLevel, baseArrayLayer + layer, 0, textureD3D.GetNumMipLevels(), textureD3D.GetNumArrayLayers())
+        );
+        graphicsCmdList_->CopyTextureRegion(&dstLocationD3D, 0, 0, 0, &srcLocationD3D, &srcBox);
+    }
+
+    textureD3D.TransitionToUsageState(graphicsBarriers_);
+    D3D12AppendResidencySet(uploadResidencySet_, textureD3D.GetResidencyEntry());
+
+    /* Execute copy commands without waiting for the GPU, and signal fence once they have been completed */
+    ExecuteCommandList();
+    fenceD3D.Submit(queue_.Get());
+
+    return readback;
+}
+
+void D3D12RenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& rb = textureReadbacks_.Get(readback);
+
+    const auto numTexels = rb.extent.width * rb.extent.height * rb.extent.depth;
+    AssertImageDataSize(imageDesc.dataSize, ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels), "texture readback");
+
+    /* Wait until the texel data has been copied into the readback buffer */
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, *rb.fence);
+    fenceD3D.Wait(~0ull);
+
+    /* Map readback buffer and copy texel data into the output image */
+    const D3D12_RANGE readRange { 0, static_cast<SIZE_T>(rb.capacity) };
+    void* mappedData = nullptr;
+
+    auto hr = rb.staging->Map(0, &readRange, &mappedData);
+    DXThrowIfFailed(hr, "failed to map D3D12 readback buffer");
+    {
+        CopyTextureReadbackData(imageDesc, rb.format, rb.extent, mappedData, rb.rowPitch, rb.slicePitch, GetConfiguration().threadCount);
+    }
+    const D3D12_RANGE writtenRange { 0, 0 };
+    rb.staging->Unmap(0, &writtenRange);
+
+    /* Return readback buffer to the pool */
+    textureReadbacks_.Free(readback);
+}
+
 void D3D12RenderSystem::GenerateMips(Texture& texture)
 {
-    //todo
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    GenerateMipsRange(textureD3D, 0, textureD3D.GetNumMipLevels(), 0, textureD3D.GetNumArrayLayers());
 }
 
 void D3D12RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
-    //todo
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    GenerateMipsRange(textureD3D, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+}
+
+void D3D12RenderSystem::SetTextureMinLOD(Texture& texture, float minLOD)
+{
+    /* Descriptors are copied into resource heaps, so the clamp only applies to views that are created afterwards */
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    textureD3D.SetMinLODClamp(minLOD);
+}
+
+// private
+void D3D12RenderSystem::GenerateMipsRange(D3D12Texture& textureD3D, UINT baseMipLevel, UINT numMipLevels, UINT baseArrayLayer, UINT numArrayLayers)
+{
+    if (textureD3D.GetUAVFormat() == DXGI_FORMAT_UNKNOWN)
+    {
+        /* Textures with a single MIP level have nothing to generate */
+        if (textureD3D.GetNumMipLevels() > 1)
+            throw std::runtime_error("cannot generate MIP-maps for D3D12 texture with compressed or depth-stencil format, non-2D type, or format without typed UAV support");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+
+    /* Create built-in MIP-map generator with its first use, since it compiles its compute shader */
+    if (!mipGenerator_)
+        mipGenerator_ = MakeUnique<D3D12MipGenerator>(*this);
+
+    /* Record MIP-map generation after all pending uploads and execute it without waiting for the GPU */
+    mipGenerator_->GenerateMips(graphicsCmdList_.Get(), graphicsBarriers_, textureD3D, baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+    D3D12AppendResidencySet(uploadResidencySet_, textureD3D.GetResidencyEntry());
+    SubmitUploads();
 }
 
 /* ----- Sampler States ---- */
 
 Sampler* D3D12RenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(desc));
+    return samplerCache_.GetOrCreate(
+        desc,
+        [&]()
+        {
+            return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(desc));
+        }
+    );
 }
 
 void D3D12RenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    /* Only destroy sampler when it is no longer shared with other identical sampler descriptors */
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
 }
 
 /* ----- Resource Heaps ----- */
@@ -323,7 +926,13 @@ ResourceHeap* D3D12RenderSystem::CreateResourceHeap(const ResourceHeapDescriptor
 
 void D3D12RenderSystem::Release(ResourceHeap& resourceHeap)
 {
-    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+    releaseQueue_.Release(resourceHeaps_, &resourceHeap);
+}
+
+void D3D12RenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
+    resourceHeapD3D.WriteResourceViews(device_.Get(), firstDescriptor, numResourceViews, resourceViews);
 }
 
 /* ----- Render Targets ----- */
@@ -338,12 +947,24 @@ void D3D12RenderSystem::Release(RenderTarget& renderTarget)
     //RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
+/* ----- Render Passes ----- */
+
+RenderPass* D3D12RenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    return TakeOwnership(renderPasses_, MakeUnique<D3D12RenderPass>(desc));
+}
+
+void D3D12RenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
 /* ----- Shader ----- */
 
 Shader* D3D12RenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
     AssertCreateShader(desc);
-    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(desc));
+    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(desc, GetConfiguration().shaderCacheDirectory));
 }
 
 ShaderProgram* D3D12RenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
@@ -366,12 +987,14 @@ void D3D12RenderSystem::Release(ShaderProgram& shaderProgram)
 
 PipelineLayout* D3D12RenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
 {
-    return TakeOwnership(pipelineLayouts_, MakeUnique<D3D12PipelineLayout>(device_.Get(), desc));
+    /* Drop cached root signatures of previously released pipeline layouts */
+    rootSignatureCache_.ReleaseUnused();
+    return TakeOwnership(pipelineLayouts_, MakeUnique<D3D12PipelineLayout>(device_.Get(), desc, rootSignatureCache_));
 }
 
 void D3D12RenderSystem::Release(PipelineLayout& pipelineLayout)
 {
-    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+    releaseQueue_.Release(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
@@ -381,6 +1004,11 @@ GraphicsPipeline* D3D12RenderSystem::CreateGraphicsPipeline(const GraphicsPipeli
     return TakeOwnership(graphicsPipelines_, MakeUnique<D3D12GraphicsPipeline>(*this, desc));
 }
 
+GraphicsPipeline* D3D12RenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    return TakeOwnership(graphicsPipelines_, MakeUnique<D3D12GraphicsPipeline>(*this, desc, true));
+}
+
 ComputePipeline* D3D12RenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
 {
     return nullptr;//todo...
@@ -388,7 +1016,7 @@ ComputePipeline* D3D12RenderSystem::CreateComputePipeline(const ComputePipelineD
 
 void D3D12RenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
-    RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+    releaseQueue_.Release(graphicsPipelines_, &graphicsPipeline);
 }
 
 void D3D12RenderSystem::Release(ComputePipeline& computePipeline)
@@ -396,6 +1024,58 @@ void D3D12RenderSystem::Release(ComputePipeline& computePipeline)
     //RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+/* ----- Pipeline Caches ----- */
+
+std::vector<char> D3D12RenderSystem::GetPipelineCacheData() const
+{
+    return pipelineLibrary_.Serialize();
+}
+
+bool D3D12RenderSystem::SetPipelineCacheData(const void* data, std::size_t dataSize)
+{
+    return pipelineLibrary_.Deserialize(data, dataSize);
+}
+
+/* ----- Statistics ----- */
+
+bool D3D12RenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    statistics = statistics_.Query(reset);
+    #ifdef LLGL_ENABLE_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+bool D3D12RenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    ComPtr<IDXGIAdapter> adapter;
+    if (factory_->EnumAdapters(adapterIndex_, adapter.ReleaseAndGetAddressOf()) == DXGI_ERROR_NOT_FOUND)
+    {
+        statistics.heaps.clear();
+        return false;
+    }
+    return DXQueryVideoMemoryStatistics(adapter.Get(), statistics);
+}
+
+bool D3D12RenderSystem::QueryTimestampCalibration(TimestampCalibration& calibration)
+{
+    /* Sample GPU timestamp and CPU timestamp (from QueryPerformanceCounter, like Timer::Tick) at once */
+    UINT64 gpuTimestamp = 0, cpuTimestamp = 0, gpuFrequency = 0;
+    if (FAILED(GetHardwareQueue()->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+        return false;
+    if (FAILED(GetHardwareQueue()->GetTimestampFrequency(&gpuFrequency)))
+        return false;
+
+    calibration.cpuTimestamp    = cpuTimestamp;
+    calibration.gpuTimestamp    = gpuTimestamp;
+    calibration.gpuFrequency    = gpuFrequency;
+    calibration.maxDeviation    = 0;
+
+    return true;
+}
+
 /* ----- Queries ----- */
 
 Query* D3D12RenderSystem::CreateQuery(const QueryDescriptor& desc)
@@ -408,16 +1088,92 @@ void D3D12RenderSystem::Release(Query& query)
     //todo...
 }
 
+QueryHeap* D3D12RenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<D3D12QueryHeap>(device_.Get(), desc));
+}
+
+void D3D12RenderSystem::Release(QueryHeap& queryHeap)
+{
+    /* Defer destruction until the frames that might still reference this query heap have been completed */
+    releaseQueue_.Release(queryHeaps_, &queryHeap);
+}
+
+/* ----- Indirect Command Layouts ----- */
+
+IndirectCommandLayout* D3D12RenderSystem::CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc)
+{
+    return TakeOwnership(indirectCommandLayouts_, MakeUnique<D3D12IndirectCommandLayout>(device_.Get(), desc));
+}
+
+void D3D12RenderSystem::Release(IndirectCommandLayout& indirectCommandLayout)
+{
+    /* Defer destruction until the frames that might still reference this command signature have been completed */
+    releaseQueue_.Release(indirectCommandLayouts_, &indirectCommandLayout);
+}
+
+/* ----- Acceleration Structures ----- */
+
+AccelerationStructure* D3D12RenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& desc)
+{
+    #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+    ComPtr<ID3D12Device5> device5;
+    if (GetRenderingCaps().features.hasRayQueries && SUCCEEDED(device_.As(&device5)))
+        return TakeOwnership(accelerationStructures_, MakeUnique<D3D12AccelerationStructure>(device5.Get(), desc));
+    #endif
+    return RenderSystem::CreateAccelerationStructure(desc);
+}
+
+void D3D12RenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+    /* Defer destruction until frames that might still build or trace this acceleration structure have been completed */
+    releaseQueue_.Release(accelerationStructures_, &accelerationStructure);
+    #endif
+}
+
 /* ----- Fences ----- */
 
 Fence* D3D12RenderSystem::CreateFence()
 {
+    /* Recycle a previously released fence before a new native fence is created */
+    if (auto fence = fencePool_.Acquire())
+        return TakeOwnership(fences_, std::move(fence));
     return TakeOwnership(fences_, MakeUnique<D3D12Fence>(device_.Get(), 0));
 }
 
 void D3D12RenderSystem::Release(Fence& fence)
 {
-    RemoveFromUniqueSet(fences_, &fence);
+    fencePool_.Release(fences_, &fence);
+}
+
+/* ----- Upload batches ----- */
+
+void D3D12RenderSystem::BeginUploadBatch()
+{
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+    ++uploadBatchDepth_;
+}
+
+void D3D12RenderSystem::EndUploadBatch()
+{
+    /* Execute all upload commands that have been recorded since the outermost upload batch has been started */
+    std::lock_guard<std::mutex> lock { uploadMutex_ };
+    if (uploadBatchDepth_ > 0 && --uploadBatchDepth_ == 0 && uploadsPending_)
+        ExecuteCommandList();
+}
+
+/* ----- Worker threads ----- */
+
+bool D3D12RenderSystem::AttachWorkerThread()
+{
+    /* Resource creation and uploads are synchronized internally and the command queue is free-threaded, so any thread is ready for uploads */
+    return true;
+}
+
+void D3D12RenderSystem::DetachWorkerThread()
+{
+    // dummy
 }
 
 /* ----- Extended internal functions ----- */
@@ -432,14 +1188,15 @@ ComPtr<IDXGISwapChain1> D3D12RenderSystem::CreateDXSwapChain(const DXGI_SWAP_CHA
     return swapChain;
 }
 
-ComPtr<ID3D12CommandQueue> D3D12RenderSystem::CreateDXCommandQueue()
+ComPtr<ID3D12CommandQueue> D3D12RenderSystem::CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE type, INT priority)
 {
     ComPtr<ID3D12CommandQueue> cmdQueue;
 
     D3D12_COMMAND_QUEUE_DESC queueDesc = {};
     {
-        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-        queueDesc.Type  = D3D12_COMMAND_LIST_TYPE_DIRECT;
+        queueDesc.Flags     = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        queueDesc.Type      = type;
+        queueDesc.Priority  = priority;
     }
     auto hr = device_->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(cmdQueue.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 command queue");
@@ -469,12 +1226,7 @@ ComPtr<ID3D12GraphicsCommandList> D3D12RenderSystem::CreateDXCommandList(D3D12_C
 
 ComPtr<ID3D12PipelineState> D3D12RenderSystem::CreateDXGfxPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
 {
-    ComPtr<ID3D12PipelineState> pipelineState;
-
-    auto hr = device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
-    DXThrowIfFailed(hr, "failed to create D3D12 graphics pipeline state");
-
-    return pipelineState;
+    return pipelineLibrary_.CreateGraphicsPipelineState(device_.Get(), desc);
 }
 
 ComPtr<ID3D12DescriptorHeap> D3D12RenderSystem::CreateDXDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc)
@@ -490,12 +1242,34 @@ ComPtr<ID3D12DescriptorHeap> D3D12RenderSystem::CreateDXDescriptorHeap(const D3D
 //private
 void D3D12RenderSystem::ExecuteCommandList()
 {
-    /* Close and execute command list */
+    /* Record pending resource barriers, make referenced resources resident, then close and execute command list */
+    graphicsBarriers_.Flush(graphicsCmdList_.Get());
+    residencyManager_->MakeResident(queue_.Get(), uploadResidencySet_);
     CloseAndExecuteCommandList(graphicsCmdList_.Get());
 
+    /* Recycle upload regions and descriptors for MIP-map generation and image conversion once the GPU has passed this fence value */
+    const auto fenceValue = SignalFenceValue();
+    residencyManager_->Submit(uploadResidencySet_, fenceValue);
+    uploadHeap_->Submit(fenceValue);
+    if (mipGenerator_)
+        mipGenerator_->Submit(fenceValue);
+    if (imageConverter_)
+        imageConverter_->Submit(fenceValue);
+
     /* Reset command list */
     auto hr = graphicsCmdList_->Reset(graphicsCmdAlloc_.Get(), nullptr);
     DXThrowIfFailed(hr, "failed to reset D3D12 graphics command list");
+
+    uploadsPending_ = false;
+}
+
+void D3D12RenderSystem::SubmitUploads()
+{
+    /* Defer execution of upload commands until the current upload batch has been ended */
+    if (uploadBatchDepth_ > 0)
+        uploadsPending_ = true;
+    else
+        ExecuteCommandList();
 }
 
 void D3D12RenderSystem::CloseAndExecuteCommandList(ID3D12GraphicsCommandList* commandList)
@@ -509,42 +1283,80 @@ void D3D12RenderSystem::CloseAndExecuteCommandList(ID3D12GraphicsCommandList* co
     queue_->ExecuteCommandLists(1, cmdLists);
 }
 
-void D3D12RenderSystem::SignalFenceValue(UINT64 fenceValue)
+UINT64 D3D12RenderSystem::SignalFenceValue()
 {
-    /* Schedule signal command into the qeue */
-    auto hr = queue_->Signal(fence_.Get(), fenceValue);
+    /* Schedule signal command with the next fence value into the qeue (values must be signaled in increasing order) */
+    std::lock_guard<std::mutex> lock { fenceMutex_ };
+    ++fenceValue_;
+    auto hr = queue_->Signal(fence_.Get(), fenceValue_);
     DXThrowIfFailed(hr, "failed to signal D3D12 fence into command queue");
+    return fenceValue_;
+}
+
+UINT64 D3D12RenderSystem::GetCompletedFenceValue() const
+{
+    return fence_->GetCompletedValue();
 }
 
 void D3D12RenderSystem::WaitForFenceValue(UINT64 fenceValue)
 {
-    /* Wait until the fence has been crossed */
-    if (fence_->GetCompletedValue() < fenceValue)
-    {
-        auto hr = fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
-        DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
-        WaitForSingleObjectEx(fenceEvent_, INFINITE, FALSE);
-    }
+    /* Wait until the fence has been crossed (safe to be called from multiple threads, since each thread waits on its own event) */
+    D3D12WaitForFenceValue(fence_.Get(), fenceValue, ~0ull);
 }
 
-void D3D12RenderSystem::SyncGPU(UINT64& fenceValue)
+void D3D12RenderSystem::SyncGPU()
 {
-    /* Increment fence value */
-    ++fenceValue;
-    fenceValue_ = fenceValue;
+    WaitForFenceValue(SignalFenceValue());
+}
 
-    /* Schedule signal command into the qeue */
-    SignalFenceValue(fenceValue);
+void D3D12RenderSystem::SubmitDescriptorHeapRings(UINT64 fenceValue)
+{
+    descriptorHeapRingCbvSrvUav_->Submit(fenceValue);
+    descriptorHeapRingSampler_->Submit(fenceValue);
+}
 
-    /* Wait until the fence has been processed */
-    auto hr = fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
-    DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
-    WaitForSingleObjectEx(fenceEvent_, INFINITE, FALSE);
+void D3D12RenderSystem::SubmitReleasedObjects(UINT64 fenceValue)
+{
+    releaseQueue_.Submit(fenceValue);
+    releaseQueue_.Collect(GetCompletedFenceValue());
 }
 
-void D3D12RenderSystem::SyncGPU()
+ID3D12CommandSignature* D3D12RenderSystem::GetCommandSignature(D3D12_INDIRECT_ARGUMENT_TYPE type, UINT stride)
 {
-    SyncGPU(fenceValue_);
+    std::lock_guard<std::mutex> lock { commandSignatureMutex_ };
+
+    /* Find command signature with the same type and stride */
+    for (const auto& entry : commandSignatures_)
+    {
+        if (entry.type == type && entry.stride == stride)
+            return entry.native.Get();
+    }
+
+    /* Create new command signature with a single argument; no root signature is required for draw and dispatch arguments only */
+    D3D12_INDIRECT_ARGUMENT_DESC argumentDesc;
+    {
+        argumentDesc.Type = type;
+    }
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc;
+    {
+        signatureDesc.ByteStride        = stride;
+        signatureDesc.NumArgumentDescs  = 1;
+        signatureDesc.pArgumentDescs    = &argumentDesc;
+        signatureDesc.NodeMask          = 0;
+    }
+
+    CommandSignature entry;
+    {
+        entry.type      = type;
+        entry.stride    = stride;
+    }
+    auto hr = device_->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(entry.native.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 command signature");
+
+    commandSignatures_.push_back(entry);
+
+    return entry.native.Get();
 }
 
 
@@ -584,20 +1396,30 @@ void D3D12RenderSystem::CreateFactory()
 void D3D12RenderSystem::QueryVideoAdapters()
 {
     /* Enumerate over all video adapters */
+    std::vector<VideoAdapterDescriptor> videoAdapterDescs;
     ComPtr<IDXGIAdapter> adapter;
 
     for (UINT i = 0; factory_->EnumAdapters(i, adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i)
     {
         /* Add adapter to the list and release handle */
-        videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
+        videoAdapterDescs.push_back(DXGetVideoAdapterDesc(adapter.Get()));
         adapter.Reset();
     }
+
+    SetVideoAdapters(videoAdapterDescs);
 }
 
-void D3D12RenderSystem::CreateDevice()
+void D3D12RenderSystem::CreateDevice(const RenderSystemDescriptor& renderSystemDesc)
 {
-    /* Use default adapter (null) and try all feature levels */
+    /* Use selected adapter (or default adapter if null) and try all feature levels */
     ComPtr<IDXGIAdapter> adapter;
+
+    adapterIndex_ = DXFindVideoAdapter(GetVideoAdapters(), renderSystemDesc);
+    if (adapterIndex_ != ~0u)
+        factory_->EnumAdapters(adapterIndex_, adapter.ReleaseAndGetAddressOf());
+    else
+        adapterIndex_ = 0;
+
     auto featureLevels = DXGetFeatureLevels(D3D_FEATURE_LEVEL_12_1);
 
     /* Try to create a feature level with an hardware adapter */
@@ -633,15 +1455,6 @@ void D3D12RenderSystem::CreateGPUSynchObjects()
     UINT64 initialFenceValue = 0;
     auto hr = device_->CreateFence(initialFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 fence");
-
-    /* Create Win32 event */
-    #if 0
-    fenceEvent_ = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
-    #else
-    fenceEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-    #endif
-    if (!fenceEvent_)
-        DXThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()), "failed to create Win32 event object");
 }
 
 void D3D12RenderSystem::QueryRendererInfo()
@@ -651,9 +1464,9 @@ void D3D12RenderSystem::QueryRendererInfo()
     info.rendererName           = "Direct3D " + DXFeatureLevelToVersion(GetFeatureLevel());
     info.shadingLanguageName    = "HLSL " + DXFeatureLevelToShaderModel(GetFeatureLevel());
 
-    if (!videoAdatperDescs_.empty())
+    if (adapterIndex_ < GetVideoAdapters().size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = GetVideoAdapters()[adapterIndex_];
         info.deviceName = std::string(videoAdapterDesc.name.begin(), videoAdapterDesc.name.end());
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -671,13 +1484,64 @@ void D3D12RenderSystem::QueryRenderingCaps()
         DXGetRenderingCaps(caps, GetFeatureLevel());
 
         /* Set extended attributes */
+        caps.features.hasSecondaryCommandBuffers    = true;
         caps.features.hasConservativeRasterization  = (GetFeatureLevel() >= D3D_FEATURE_LEVEL_12_0);
+        caps.features.hasBindlessResources          = true;
+        caps.features.hasDynamicOffsets             = true;
+        caps.features.hasStaticSamplers             = true;
+        caps.features.hasTextureViews               = true;
+        caps.features.hasTextureMinLOD              = true;
+        caps.features.hasTimelineFences             = true;
+        caps.features.hasComputeQueue               = true;
+        caps.features.hasBackgroundQueue            = true;
+        caps.features.hasIndirectCommandLayouts     = true;
 
         caps.limits.maxNumViewports                 = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
         caps.limits.maxViewportSize[0]              = D3D12_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxViewportSize[1]              = D3D12_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxBufferSize                   = std::numeric_limits<UINT64>::max();
         caps.limits.maxConstantBufferSize           = D3D12_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+        caps.limits.maxConstantsSize                = 128u; // 32 of the 64 DWORDs of a root signature
+        caps.limits.constantBufferOffsetAlignment   = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+        /* Query wave intrinsics of Shader Model 6.0 (quad operations are only available in pixel and compute shaders) */
+        D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+        if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) && options1.WaveOps != FALSE)
+        {
+            caps.features.hasSubgroups      = true;
+            caps.limits.minSubgroupSize     = options1.WaveLaneCountMin;
+            caps.limits.maxSubgroupSize     = options1.WaveLaneCountMax;
+            caps.limits.subgroupStageFlags  = StageFlags::AllStages;
+            caps.limits.subgroupOperations  =
+            (
+                SubgroupFlags::Basic        |
+                SubgroupFlags::Vote         |
+                SubgroupFlags::Arithmetic   |
+                SubgroupFlags::Ballot       |
+                SubgroupFlags::Shuffle      |
+                SubgroupFlags::Quad
+            );
+        }
+
+        #ifdef __ID3D12GraphicsCommandList5_INTERFACE_DEFINED__
+        /* Query variable rate shading tier */
+        D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+        if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
+        {
+            caps.features.hasVariableRateShading    = (options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_1);
+            caps.features.hasAdditionalShadingRates = (options6.AdditionalShadingRatesSupported != FALSE);
+            caps.features.hasShadingRateImage       = (options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2);
+            if (caps.features.hasShadingRateImage)
+                caps.limits.shadingRateImageTileSize = options6.ShadingRateImageTileSize;
+        }
+        #endif
+
+        #ifdef __ID3D12GraphicsCommandList6_INTERFACE_DEFINED__
+        /* Query raytracing tier (inline ray queries require DXR 1.1) */
+        D3D12_FEATURE_DATA_D3D12_OPTIONS5 options5 = {};
+        if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options5, sizeof(options5))))
+            caps.features.hasRayQueries = (options5.RaytracingTier >= D3D12_RAYTRACING_TIER_1_1);
+        #endif
     }
     SetRenderingCaps(caps);
 }
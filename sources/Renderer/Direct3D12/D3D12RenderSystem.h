@@ -15,23 +15,42 @@
 #include "D3D12CommandQueue.h"
 #include "D3D12CommandBuffer.h"
 #include "D3D12RenderContext.h"
+#include "D3D12UploadHeap.h"
+#include "D3D12ResidencyManager.h"
+#include "D3D12MemoryAllocator.h"
+#include "D3D12BarrierBatch.h"
 
 #include "Buffer/D3D12Buffer.h"
 #include "Texture/D3D12Texture.h"
 #include "Texture/D3D12Sampler.h"
+#include "Texture/D3D12MipGenerator.h"
+#include "Texture/D3D12ImageConverter.h"
 
 #include "RenderState/D3D12Fence.h"
+#include "RenderState/D3D12DescriptorHeapRing.h"
 #include "RenderState/D3D12GraphicsPipeline.h"
 #include "RenderState/D3D12PipelineLayout.h"
+#include "RenderState/D3D12PipelineLibrary.h"
 #include "RenderState/D3D12ResourceHeap.h"
+#include "RenderState/D3D12QueryHeap.h"
+#include "RenderState/D3D12IndirectCommandLayout.h"
+#include "RenderState/D3D12AccelerationStructure.h"
+#include "RenderState/D3D12RenderPass.h"
 
 #include "Shader/D3D12Shader.h"
 #include "Shader/D3D12ShaderProgram.h"
+#include "Shader/D3D12RootSignature.h"
 
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
+#include "../ReleaseQueue.h"
+#include "../FencePool.h"
+#include "../StatisticsCounter.h"
+#include "../TextureReadbackPool.h"
 #include "../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <mutex>
 
 
 namespace LLGL
@@ -45,7 +64,7 @@ class D3D12RenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        D3D12RenderSystem();
+        D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D12RenderSystem();
 
         /* ----- Render Context ------ */
@@ -57,11 +76,13 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetCommandQueue(const QueueType type) override;
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
         CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -76,21 +97,35 @@ class D3D12RenderSystem final : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
 
         void Release(Texture& texture) override;
 
         void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
+        void WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions) override;
+
+        TextureUploadMemory BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc) override;
+        void EndTextureUpload() override;
 
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
 
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
 
+        void SetTextureMinLOD(Texture& texture, float minLOD) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -103,12 +138,20 @@ class D3D12RenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
 
         void Release(RenderTarget& renderTarget) override;
 
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& desc) override;
@@ -126,27 +169,65 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Pipeline States ----- */
 
         GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        GraphicsPipeline* CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc) override;
         ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
 
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        /* ----- Pipeline Caches ----- */
+
+        std::vector<char> GetPipelineCacheData() const override;
+        bool SetPipelineCacheData(const void* data, std::size_t dataSize) override;
+
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+        bool QueryMemoryStatistics(MemoryStatistics& statistics) override;
+        bool QueryTimestampCalibration(TimestampCalibration& calibration) override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
 
         void Release(Query& query) override;
 
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
+        /* ----- Indirect Command Layouts ----- */
+
+        IndirectCommandLayout* CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc) override;
+
+        void Release(IndirectCommandLayout& indirectCommandLayout) override;
+
+        /* ----- Acceleration Structures ----- */
+
+        AccelerationStructure* CreateAccelerationStructure(const AccelerationStructureDescriptor& desc) override;
+
+        void Release(AccelerationStructure& accelerationStructure) override;
+
         /* ----- Fences ----- */
 
         Fence* CreateFence() override;
 
         void Release(Fence& fence) override;
 
+        /* ----- Upload batches ----- */
+
+        void BeginUploadBatch() override;
+        void EndUploadBatch() override;
+
+        /* ----- Worker threads ----- */
+
+        bool AttachWorkerThread() override;
+        void DetachWorkerThread() override;
+
         /* ----- Extended internal functions ----- */
 
         ComPtr<IDXGISwapChain1> CreateDXSwapChain(const DXGI_SWAP_CHAIN_DESC1& desc, HWND wnd);
-        ComPtr<ID3D12CommandQueue> CreateDXCommandQueue();
+        ComPtr<ID3D12CommandQueue> CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT, INT priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL);
         ComPtr<ID3D12CommandAllocator> CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE type);
         ComPtr<ID3D12GraphicsCommandList> CreateDXCommandList(D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* cmdAllocator);
         ComPtr<ID3D12PipelineState> CreateDXGfxPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
@@ -155,14 +236,27 @@ class D3D12RenderSystem final : public RenderSystem
         // Close and execute command list.
         void CloseAndExecuteCommandList(ID3D12GraphicsCommandList* commandList);
 
-        // Internal fence
-        void SignalFenceValue(UINT64 fenceValue);
+        // Schedules a signal of the internal fence into the command queue and returns the new fence value.
+        UINT64 SignalFenceValue();
+
+        // Returns the last value the internal fence has reached.
+        UINT64 GetCompletedFenceValue() const;
+
+        // Blocks the CPU until the internal fence has reached the specified value (returns immediately if it already has).
         void WaitForFenceValue(UINT64 fenceValue);
 
         // Waits until the GPU has done all previous work.
-        void SyncGPU(UINT64& fenceValue);
         void SyncGPU();
 
+        // Assigns all descriptor ranges that have been allocated since the last submission to the specified fence value.
+        void SubmitDescriptorHeapRings(UINT64 fenceValue);
+
+        // Assigns all objects that have been released since the last frame to the specified frame fence value, and destroys all released objects the GPU has completed.
+        void SubmitReleasedObjects(UINT64 fenceValue);
+
+        // Returns the command signature for indirect commands of the specified type and stride, which is created with its first use.
+        ID3D12CommandSignature* GetCommandSignature(D3D12_INDIRECT_ARGUMENT_TYPE type, UINT stride);
+
         inline D3D_FEATURE_LEVEL GetFeatureLevel() const
         {
             return featureLevel_;
@@ -173,10 +267,46 @@ class D3D12RenderSystem final : public RenderSystem
             return device_.Get();
         }
 
-        /*inline ID3D12CommandQueue* GetHardwareQueue() const
+        // Returns the global shader-visible descriptor heap ring for CBVs, SRVs, and UAVs.
+        inline D3D12DescriptorHeapRing& GetDescriptorHeapRingCbvSrvUav()
+        {
+            return *descriptorHeapRingCbvSrvUav_;
+        }
+
+        // Returns the global shader-visible descriptor heap ring for samplers.
+        inline D3D12DescriptorHeapRing& GetDescriptorHeapRingSampler()
+        {
+            return *descriptorHeapRingSampler_;
+        }
+
+        // Returns the statistics counter that is shared with all command buffers.
+        inline StatisticsCounter& GetStatisticsCounter()
+        {
+            return statistics_;
+        }
+
+        // Returns the residency manager for buffers and textures in video memory.
+        inline D3D12ResidencyManager& GetResidencyManager()
+        {
+            return *residencyManager_;
+        }
+
+        // Returns the allocator for placed and sub-allocated buffers and textures.
+        inline D3D12MemoryAllocator& GetMemoryAllocator()
+        {
+            return *memoryAllocator_;
+        }
+
+        // Returns the number of frames each render context can record ahead of the GPU.
+        inline UINT GetNumFramesInFlight() const
+        {
+            return numFramesInFlight_;
+        }
+
+        inline ID3D12CommandQueue* GetHardwareQueue() const
         {
             return queue_.Get();
-        }*/
+        }
 
     private:
 
@@ -186,18 +316,24 @@ class D3D12RenderSystem final : public RenderSystem
 
         void CreateFactory();
         void QueryVideoAdapters();
-        void CreateDevice();
+        void CreateDevice(const RenderSystemDescriptor& renderSystemDesc);
         bool CreateDevice(HRESULT& hr, IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels);
         void CreateGPUSynchObjects();
 
         void QueryRendererInfo();
         void QueryRenderingCaps();
 
-        // Close, execute, and reset command list.
+        // Close, execute, and reset command list, and assigns the pending upload regions to a new fence value.
         void ExecuteCommandList();
 
+        // Executes the upload command list, or defers its execution until the current upload batch has been ended (see BeginUploadBatch).
+        void SubmitUploads();
+
         std::unique_ptr<D3D12Buffer> MakeBufferAndInitialize(const BufferDescriptor& desc, const void* initialData);
 
+        // Records the MIP-map generation into the upload command list and executes it without waiting for the GPU.
+        void GenerateMipsRange(D3D12Texture& textureD3D, UINT baseMipLevel, UINT numMipLevels, UINT baseArrayLayer, UINT numArrayLayers);
+
         /* ----- Common objects ----- */
 
         ComPtr<IDXGIFactory4>                       factory_;
@@ -207,12 +343,69 @@ class D3D12RenderSystem final : public RenderSystem
         ComPtr<ID3D12CommandQueue>                  queue_;
         ComPtr<ID3D12CommandAllocator>              graphicsCmdAlloc_;
         ComPtr<ID3D12GraphicsCommandList>           graphicsCmdList_;   // graphics command list to upload data to the GPU
+        D3D12BarrierBatch                           graphicsBarriers_;  // pending resource barriers of the upload command list
+
+        ComPtr<ID3D12CommandQueue>                  computeQueue_;      // asynchronous compute queue, see RenderSystem::GetCommandQueue(const QueueType)
         ComPtr<ID3D12CommandAllocator>              computeCmdAlloc_;
-        ComPtr<ID3D12GraphicsCommandList>           computeCmdList_;    // compute command list to generate MIP-maps
+
+        ComPtr<ID3D12CommandQueue>                  backgroundQueue_;   // low priority compute queue for streaming work, see RenderingFeatures::hasBackgroundQueue
+        ComPtr<ID3D12CommandAllocator>              backgroundCmdAlloc_;
 
         ComPtr<ID3D12Fence>                         fence_;
-        HANDLE                                      fenceEvent_             = 0;
         UINT64                                      fenceValue_             = 0;
+        std::mutex                                  fenceMutex_;            // Guards 'fenceValue_', since uploads may be submitted on worker threads
+
+        std::unique_ptr<D3D12UploadHeap>            uploadHeap_;            // transient upload memory for buffer and texture updates
+
+        std::unique_ptr<D3D12ResidencyManager>      residencyManager_;      // LRU eviction of buffers and textures under video memory pressure
+        std::vector<D3D12ResidencyEntry*>           uploadResidencySet_;    // resources referenced by the upload command list since its last execution
+        std::unique_ptr<D3D12MemoryAllocator>       memoryAllocator_;       // heaps and shared buffers for placed and sub-allocated resources
+
+        TextureReadbackPool<ComPtr<ID3D12Resource>> textureReadbacks_;      // buffers in the readback heap for asynchronous texture readbacks
+        TextureReadbackPool<ComPtr<ID3D12Resource>> bufferReadbacks_;       // buffers in the readback heap for asynchronous buffer readbacks
+
+        // Pending texture upload from a region of the upload heap, see BeginTextureUpload.
+        struct TextureUpload
+        {
+            D3D12Texture*                       texture         = nullptr;
+            ID3D12Resource*                     srcBuffer       = nullptr;
+            D3D12_PLACED_SUBRESOURCE_FOOTPRINT  footprint;      // Footprint of the first array layer
+            UINT64                              layerSize       = 0;
+            UINT                                mipLevel        = 0;
+            UINT                                baseArrayLayer  = 0;
+            UINT                                numArrayLayers  = 0;
+            D3D12_BOX                           dstBox;
+        };
+
+        TextureUpload                               textureUpload_;
+
+        std::mutex                                  uploadMutex_;           // Guards the upload command list, its barriers and residency set, and the upload heap
+        UINT                                        uploadBatchDepth_       = 0;        // number of nested upload batches, see BeginUploadBatch
+        bool                                        uploadsPending_         = false;    // upload commands have been recorded within the current upload batch
+
+        StatisticsCounter                           statistics_;            // Shared with all command buffers, see LLGL_ENABLE_STATISTICS
+
+        std::unique_ptr<D3D12DescriptorHeapRing>    descriptorHeapRingCbvSrvUav_;
+        std::unique_ptr<D3D12DescriptorHeapRing>    descriptorHeapRingSampler_;
+
+        std::unique_ptr<D3D12MipGenerator>          mipGenerator_;          // built-in compute shader to generate MIP-maps, created with its first use
+        std::unique_ptr<D3D12ImageConverter>        imageConverter_;        // built-in compute shader to convert initial image data, see RenderSystemConfiguration::gpuImageConversion
+
+        UINT                                        numFramesInFlight_      = 2;
+
+        /* Command signatures for indirect draw and dispatch commands */
+        struct CommandSignature
+        {
+            D3D12_INDIRECT_ARGUMENT_TYPE    type;
+            UINT                            stride;
+            ComPtr<ID3D12CommandSignature>  native;
+        };
+
+        std::vector<CommandSignature>               commandSignatures_;
+        std::mutex                                  commandSignatureMutex_; // Guards 'commandSignatures_', since bundles may be recorded on worker threads
+
+        D3D12RootSignatureCache                     rootSignatureCache_;    // Root signatures shared across all pipeline layouts with identical root parameters
+        mutable D3D12PipelineLibrary                pipelineLibrary_;       // Compiled pipeline states across application runs, see GetPipelineCacheData
 
         #ifdef LLGL_DEBUG
         //ComPtr<ID3D12Debug>                         debugDevice_;
@@ -223,23 +416,35 @@ class D3D12RenderSystem final : public RenderSystem
 
         HWObjectContainer<D3D12RenderContext>       renderContexts_;
         HWObjectInstance<D3D12CommandQueue>         commandQueue_;
+        HWObjectInstance<D3D12CommandQueue>         computeCommandQueue_;
+        HWObjectInstance<D3D12CommandQueue>         backgroundCommandQueue_;
         HWObjectContainer<D3D12CommandBuffer>       commandBuffers_;
         HWObjectContainer<D3D12Buffer>              buffers_;
         HWObjectContainer<BufferArray>              bufferArrays_;
         HWObjectContainer<D3D12Texture>             textures_;
         //HWObjectContainer<D3D12RenderTarget>        renderTargets_;
+        HWObjectContainer<D3D12RenderPass>          renderPasses_;
         HWObjectContainer<D3D12Shader>              shaders_;
         HWObjectContainer<D3D12ShaderProgram>       shaderPrograms_;
         HWObjectContainer<D3D12PipelineLayout>      pipelineLayouts_;
         HWObjectContainer<D3D12GraphicsPipeline>    graphicsPipelines_;
         HWObjectContainer<D3D12Sampler>             samplers_;
+        SamplerCache                                samplerCache_;          // Shares sampler objects between identical sampler descriptors
         HWObjectContainer<D3D12ResourceHeap>        resourceHeaps_;
         //HWObjectContainer<D3D12Query>               queries_;
+        HWObjectContainer<D3D12QueryHeap>           queryHeaps_;
+        HWObjectContainer<D3D12IndirectCommandLayout> indirectCommandLayouts_;
+        #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+        HWObjectContainer<D3D12AccelerationStructure> accelerationStructures_;
+        #endif
         HWObjectContainer<D3D12Fence>               fences_;
+        FencePool<D3D12Fence>                       fencePool_;             // Released fences that are recycled by CreateFence
+
+        ReleaseQueue                                releaseQueue_;          // Released objects the GPU might still reference, destroyed once their frame fence has been completed
 
         /* ----- Other members ----- */
 
-        std::vector<VideoAdapterDescriptor>         videoAdatperDescs_;
+        UINT                                        adapterIndex_           = 0;    // Index of the video adapter the device has been created for
 
 };
 
@@ -0,0 +1,213 @@
+/*
+ * D3D12ResidencyManager.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ResidencyManager.h"
+#include "D3D12RenderSystem.h"
+#include "../DXCommon/DXCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+D3D12ResidencyManager::D3D12ResidencyManager(D3D12RenderSystem& renderSystem, IDXGIAdapter* adapter) :
+    renderSystem_ { renderSystem              },
+    device_       { renderSystem.GetDevice()  }
+{
+    /* Video memory budgets are only available since DXGI 1.4; resources are not tracked otherwise */
+    if (adapter == nullptr || FAILED(adapter->QueryInterface(IID_PPV_ARGS(adapter_.ReleaseAndGetAddressOf()))))
+        return;
+
+    #ifdef __ID3D12Device3_INTERFACE_DEFINED__
+
+    /* Use asynchronous residency operations if supported, so the queue waits for resources instead of the CPU */
+    if (SUCCEEDED(device_->QueryInterface(IID_PPV_ARGS(device3_.ReleaseAndGetAddressOf()))))
+    {
+        auto hr = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 fence for residency management");
+    }
+
+    #endif // /__ID3D12Device3_INTERFACE_DEFINED__
+}
+
+void D3D12ResidencyManager::Register(D3D12ResidencyEntry& entry, ID3D12Pageable* object, UINT64 size)
+{
+    if (!IsEnabled() || object == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    entry.object        = object;
+    entry.size          = size;
+    entry.lastUsedValue = 0;
+    entry.resident      = true;
+    entry.pending       = false;
+
+    LinkBack(entry);
+}
+
+void D3D12ResidencyManager::Unregister(D3D12ResidencyEntry& entry)
+{
+    if (entry.object == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    Unlink(entry);
+    entry.object = nullptr;
+}
+
+void D3D12ResidencyManager::MakeResident(ID3D12CommandQueue* queue, std::vector<D3D12ResidencyEntry*>& residencySet)
+{
+    if (residencySet.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    /* Remove duplicate entries, since resources are tracked once per binding and placed resources share the entry of their heap */
+    std::sort(residencySet.begin(), residencySet.end());
+    residencySet.erase(std::unique(residencySet.begin(), residencySet.end()), residencySet.end());
+
+    /* Mark resources of this submission as pending, so they are not evicted to make room for each other */
+    UINT64 requiredSize = 0;
+
+    for (auto entry : residencySet)
+    {
+        entry->pending = true;
+        if (!entry->resident)
+            requiredSize += entry->size;
+    }
+
+    EvictToBudget(requiredSize);
+
+    /* Make all evicted resources of this submission resident again */
+    objects_.clear();
+
+    for (auto entry : residencySet)
+    {
+        if (!entry->resident)
+        {
+            objects_.push_back(entry->object);
+            entry->resident = true;
+        }
+    }
+
+    if (objects_.empty())
+        return;
+
+    #ifdef __ID3D12Device3_INTERFACE_DEFINED__
+
+    if (device3_)
+    {
+        /* Let the queue wait until the resources are resident, instead of blocking the CPU */
+        ++fenceValue_;
+        auto hr = device3_->EnqueueMakeResident(D3D12_RESIDENCY_FLAG_NONE, static_cast<UINT>(objects_.size()), objects_.data(), fence_.Get(), fenceValue_);
+        DXThrowIfFailed(hr, "failed to enqueue D3D12 resources to be made resident");
+
+        hr = queue->Wait(fence_.Get(), fenceValue_);
+        DXThrowIfFailed(hr, "failed to wait for D3D12 resources to be made resident");
+        return;
+    }
+
+    #endif // /__ID3D12Device3_INTERFACE_DEFINED__
+
+    auto hr = device_->MakeResident(static_cast<UINT>(objects_.size()), objects_.data());
+    DXThrowIfFailed(hr, "failed to make D3D12 resources resident");
+}
+
+void D3D12ResidencyManager::Submit(std::vector<D3D12ResidencyEntry*>& residencySet, UINT64 fenceValue)
+{
+    if (residencySet.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    for (auto entry : residencySet)
+    {
+        entry->pending          = false;
+        entry->lastUsedValue    = fenceValue;
+        Unlink(*entry);
+        LinkBack(*entry);
+    }
+
+    residencySet.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12ResidencyManager::LinkBack(D3D12ResidencyEntry& entry)
+{
+    entry.prev = tail_;
+    entry.next = nullptr;
+
+    if (tail_ != nullptr)
+        tail_->next = &entry;
+    else
+        head_ = &entry;
+
+    tail_ = &entry;
+}
+
+void D3D12ResidencyManager::Unlink(D3D12ResidencyEntry& entry)
+{
+    if (entry.prev != nullptr)
+        entry.prev->next = entry.next;
+    else
+        head_ = entry.next;
+
+    if (entry.next != nullptr)
+        entry.next->prev = entry.prev;
+    else
+        tail_ = entry.prev;
+
+    entry.prev = nullptr;
+    entry.next = nullptr;
+}
+
+void D3D12ResidencyManager::EvictToBudget(UINT64 requiredSize)
+{
+    /* Query current usage and budget of the local memory segment group */
+    DXGI_QUERY_VIDEO_MEMORY_INFO info;
+    if (FAILED(adapter_->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info)))
+        return;
+
+    auto usage = info.CurrentUsage + requiredSize;
+    if (usage <= info.Budget)
+        return;
+
+    /* Evict least recently used resources the GPU has completed, until the usage fits into the budget */
+    const auto completedValue = renderSystem_.GetCompletedFenceValue();
+
+    objects_.clear();
+
+    for (auto entry = head_; entry != nullptr && usage > info.Budget; entry = entry->next)
+    {
+        if (entry->resident && !entry->pending && entry->lastUsedValue <= completedValue)
+        {
+            objects_.push_back(entry->object);
+            entry->resident = false;
+            usage -= std::min(usage, entry->size);
+        }
+    }
+
+    if (!objects_.empty())
+    {
+        auto hr = device_->Evict(static_cast<UINT>(objects_.size()), objects_.data());
+        DXThrowIfFailed(hr, "failed to evict D3D12 resources");
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,116 @@
+/*
+ * D3D12ResidencyManager.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_RESIDENCY_MANAGER_H
+#define LLGL_D3D12_RESIDENCY_MANAGER_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <dxgi1_4.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+
+// Residency state of a pageable object, i.e. a heap or committed resource of the memory allocator, which is linked into the LRU list of the residency manager.
+struct D3D12ResidencyEntry
+{
+    ID3D12Pageable*         object          = nullptr;  // Null if this resource is not tracked
+    UINT64                  size            = 0;
+    UINT64                  lastUsedValue   = 0;        // Fence value of the last submission that referenced this resource
+    bool                    resident        = true;
+    bool                    pending         = false;    // Specifies whether this resource is referenced by the submission that is currently being prepared
+    D3D12ResidencyEntry*    prev            = nullptr;
+    D3D12ResidencyEntry*    next            = nullptr;
+};
+
+// Appends the specified entry to the residency set if it is non-null and tracked (adjacent duplicates are skipped).
+inline void D3D12AppendResidencySet(std::vector<D3D12ResidencyEntry*>& residencySet, D3D12ResidencyEntry* entry)
+{
+    if (entry != nullptr && entry->object != nullptr && (residencySet.empty() || residencySet.back() != entry))
+        residencySet.push_back(entry);
+}
+
+/*
+Residency manager for heaps and committed resources in video memory.
+All tracked objects are kept in least-recently-used order by the fence value of their last submission.
+Before each submission, resources are evicted in LRU order (only if the GPU has completed their last submission)
+until the video memory usage fits into the budget reported by 'IDXGIAdapter3::QueryVideoMemoryInfo',
+and the evicted resources the submission refers to are made resident again.
+*/
+class D3D12ResidencyManager
+{
+
+    public:
+
+        D3D12ResidencyManager(D3D12RenderSystem& renderSystem, IDXGIAdapter* adapter);
+
+        D3D12ResidencyManager(const D3D12ResidencyManager&) = delete;
+        D3D12ResidencyManager& operator = (const D3D12ResidencyManager&) = delete;
+
+        // Starts tracking the specified pageable object with the specified size (in bytes).
+        void Register(D3D12ResidencyEntry& entry, ID3D12Pageable* object, UINT64 size);
+
+        // Stops tracking the specified object. The object remains resident if it has not been evicted.
+        void Unregister(D3D12ResidencyEntry& entry);
+
+        /*
+        Evicts least recently used resources to stay within the video memory budget, and makes all resources of the residency set resident.
+        Duplicate entries are removed from the residency set. Must be called before the command lists that refer to these resources are executed on the queue.
+        */
+        void MakeResident(ID3D12CommandQueue* queue, std::vector<D3D12ResidencyEntry*>& residencySet);
+
+        // Assigns all resources of the residency set to the specified fence value, moves them to the end of the LRU list, and clears the residency set.
+        void Submit(std::vector<D3D12ResidencyEntry*>& residencySet, UINT64 fenceValue);
+
+        // Returns true if resources are tracked, i.e. the video memory budget can be queried.
+        inline bool IsEnabled() const
+        {
+            return (adapter_.Get() != nullptr);
+        }
+
+    private:
+
+        void LinkBack(D3D12ResidencyEntry& entry);
+        void Unlink(D3D12ResidencyEntry& entry);
+
+        // Evicts least recently used resources until the current usage plus the specified size fits into the budget.
+        void EvictToBudget(UINT64 requiredSize);
+
+        D3D12RenderSystem&              renderSystem_;
+        ID3D12Device*                   device_             = nullptr;
+        ComPtr<IDXGIAdapter3>           adapter_;
+
+        #ifdef __ID3D12Device3_INTERFACE_DEFINED__
+        ComPtr<ID3D12Device3>           device3_;           // Device for asynchronous 'EnqueueMakeResident' (null if not supported)
+        ComPtr<ID3D12Fence>             fence_;             // Fence that is signaled once enqueued resources are resident
+        UINT64                          fenceValue_         = 0;
+        #endif
+
+        D3D12ResidencyEntry*            head_               = nullptr;  // Least recently used entry
+        D3D12ResidencyEntry*            tail_               = nullptr;  // Most recently used entry
+
+        std::vector<ID3D12Pageable*>    objects_;           // Scratch list of objects to evict or make resident
+        std::mutex                      mutex_;             // Guards the LRU list, since resources may be created on worker threads
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,189 @@
+/*
+ * D3D12UploadHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12UploadHeap.h"
+#include "D3D12RenderSystem.h"
+#include "../DXCommon/DXCore.h"
+#include "../../Core/Helper.h"
+#include "D3DX12/d3dx12.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+D3D12UploadHeap::D3D12UploadHeap(D3D12RenderSystem& renderSystem, UINT64 size) :
+    renderSystem_ { renderSystem },
+    size_         { size         }
+{
+    if (size_ > 0)
+    {
+        buffer_ = CreateUploadBuffer(size_, mappedData_);
+        #ifdef LLGL_DEBUG
+        buffer_->SetName(L"LLGL::D3D12UploadHeap::buffer");
+        #endif
+    }
+}
+
+D3D12UploadHeap::~D3D12UploadHeap()
+{
+    if (buffer_)
+        buffer_->Unmap(0, nullptr);
+}
+
+D3D12UploadRegion D3D12UploadHeap::Allocate(UINT64 size, UINT64 alignment)
+{
+    D3D12UploadRegion region;
+
+    /* Recycle regions of all segments the GPU has already finished */
+    RetireCompletedSegments();
+
+    UINT64 offset = 0;
+    if (AllocRingRegion(size, alignment, offset))
+    {
+        /* Return region within the upload heap */
+        region.resource     = buffer_.Get();
+        region.offset       = offset;
+        region.mappedData   = mappedData_ + offset;
+    }
+    else
+    {
+        /* Create dedicated upload buffer, which is released once its submission has been completed */
+        DedicatedBuffer dedicatedBuffer;
+        {
+            dedicatedBuffer.resource    = CreateUploadBuffer(size, region.mappedData);
+            dedicatedBuffer.fenceValue  = 0;
+        }
+        region.resource = dedicatedBuffer.resource.Get();
+        dedicatedBuffers_.push_back(std::move(dedicatedBuffer));
+    }
+
+    return region;
+}
+
+void D3D12UploadHeap::Submit(UINT64 fenceValue)
+{
+    /* Close current segment of the heap */
+    if (head_ != submittedHead_)
+    {
+        segments_.push_back({ fenceValue, head_ });
+        submittedHead_ = head_;
+    }
+
+    /* Assign fence value to pending dedicated buffers */
+    for (auto& dedicatedBuffer : dedicatedBuffers_)
+    {
+        if (dedicatedBuffer.fenceValue == 0)
+            dedicatedBuffer.fenceValue = fenceValue;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ComPtr<ID3D12Resource> D3D12UploadHeap::CreateUploadBuffer(UINT64 size, char*& mappedData)
+{
+    ComPtr<ID3D12Resource> buffer;
+
+    /* Create buffer resource in upload heap */
+    auto hr = renderSystem_.GetDevice()->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(size),
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(buffer.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for upload buffer");
+
+    /* Map buffer persistently (CPU never reads from upload heaps) */
+    const D3D12_RANGE readRange = { 0, 0 };
+    void* data = nullptr;
+
+    hr = buffer->Map(0, &readRange, &data);
+    DXThrowIfFailed(hr, "failed to map D3D12 upload buffer");
+
+    mappedData = reinterpret_cast<char*>(data);
+
+    return buffer;
+}
+
+bool D3D12UploadHeap::AllocRingRegion(UINT64 size, UINT64 alignment, UINT64& offset)
+{
+    /* Reject allocations that would occupy more than half of the heap, to keep the heap available for small uploads */
+    if (size > size_ / 2)
+        return false;
+
+    while (true)
+    {
+        /* Determine aligned position within heap; wrap around to the beginning if the region does not fit until the end */
+        auto pos        = head_ % size_;
+        auto alignedPos = GetAlignedSize(pos, alignment);
+
+        if (alignedPos + size > size_)
+            alignedPos = size_;
+
+        auto padding    = alignedPos - pos;
+        auto start      = (alignedPos == size_ ? 0 : alignedPos);
+
+        if (head_ + padding + size - tail_ <= size_)
+        {
+            head_ += padding + size;
+            offset = start;
+            return true;
+        }
+
+        /* Wait for oldest segment to free heap space; if only unsubmitted regions occupy the heap, give up */
+        if (!RetireOldestSegment())
+            return false;
+    }
+}
+
+void D3D12UploadHeap::RetireCompletedSegments()
+{
+    const auto completedValue = renderSystem_.GetCompletedFenceValue();
+
+    /* Free heap space up to the end of the last completed segment */
+    while (!segments_.empty() && segments_.front().fenceValue <= completedValue)
+    {
+        tail_ = segments_.front().end;
+        segments_.pop_front();
+    }
+
+    /* Release completed dedicated buffers */
+    dedicatedBuffers_.erase(
+        std::remove_if(
+            dedicatedBuffers_.begin(), dedicatedBuffers_.end(),
+            [completedValue](const DedicatedBuffer& entry)
+            {
+                return (entry.fenceValue != 0 && entry.fenceValue <= completedValue);
+            }
+        ),
+        dedicatedBuffers_.end()
+    );
+}
+
+bool D3D12UploadHeap::RetireOldestSegment()
+{
+    if (segments_.empty())
+        return false;
+
+    renderSystem_.WaitForFenceValue(segments_.front().fenceValue);
+    RetireCompletedSegments();
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,102 @@
+/*
+ * D3D12UploadHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_UPLOAD_HEAP_H
+#define LLGL_D3D12_UPLOAD_HEAP_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <deque>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+
+// Region within an upload buffer, which can be written by the CPU and used as copy source by the GPU.
+struct D3D12UploadRegion
+{
+    ID3D12Resource* resource    = nullptr;
+    UINT64          offset      = 0;
+    char*           mappedData  = nullptr;
+};
+
+/*
+Linear allocator for transient CPU-to-GPU uploads.
+All regions are bump-allocated from a single persistently mapped buffer in an upload heap,
+and recycled as soon as the fence value they have been submitted with has been reached.
+Regions that are larger than half of the heap use a dedicated upload buffer, which is released the same way.
+*/
+class D3D12UploadHeap
+{
+
+    public:
+
+        D3D12UploadHeap(D3D12RenderSystem& renderSystem, UINT64 size);
+        ~D3D12UploadHeap();
+
+        D3D12UploadHeap(const D3D12UploadHeap&) = delete;
+        D3D12UploadHeap& operator = (const D3D12UploadHeap&) = delete;
+
+        // Allocates a region of the specified size and alignment, which remains valid until the next call to 'Submit' has been completed by the GPU.
+        D3D12UploadRegion Allocate(UINT64 size, UINT64 alignment);
+
+        // Assigns all regions that have been allocated since the last submission to the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+    private:
+
+        struct Segment
+        {
+            UINT64 fenceValue;
+            UINT64 end;
+        };
+
+        struct DedicatedBuffer
+        {
+            ComPtr<ID3D12Resource>  resource;
+            UINT64                  fenceValue;
+        };
+
+        ComPtr<ID3D12Resource> CreateUploadBuffer(UINT64 size, char*& mappedData);
+
+        // Tries to allocate a region within the heap, and waits for submitted segments if the heap is full.
+        bool AllocRingRegion(UINT64 size, UINT64 alignment, UINT64& offset);
+
+        // Releases all segments and dedicated buffers whose fence value has been reached (non-blocking).
+        void RetireCompletedSegments();
+
+        // Waits for the oldest submitted segment and releases it. Returns false if there is no submitted segment.
+        bool RetireOldestSegment();
+
+        D3D12RenderSystem&              renderSystem_;
+
+        ComPtr<ID3D12Resource>          buffer_;
+        char*                           mappedData_     = nullptr;
+        UINT64                          size_           = 0;
+        UINT64                          head_           = 0;
+        UINT64                          tail_           = 0;
+        UINT64                          submittedHead_  = 0;
+
+        std::deque<Segment>             segments_;
+        std::vector<DedicatedBuffer>    dedicatedBuffers_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,298 @@
+/*
+ * D3D12AccelerationStructure.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12AccelerationStructure.h"
+#include "../Buffer/D3D12Buffer.h"
+#include "../D3D12BarrierBatch.h"
+#include "../D3D12Types.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../CheckedCast.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+#ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
+static D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS GetD3DBuildFlags(long flags)
+{
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS buildFlags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+
+    if ((flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        buildFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+    if ((flags & AccelerationStructureFlags::PreferFastTrace) != 0)
+        buildFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+    if ((flags & AccelerationStructureFlags::PreferFastBuild) != 0)
+        buildFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_BUILD;
+
+    return buildFlags;
+}
+
+static ComPtr<ID3D12Resource> CreateD3DBuffer(
+    ID3D12Device5*          device,
+    D3D12_HEAP_TYPE         heapType,
+    UINT64                  size,
+    D3D12_RESOURCE_FLAGS    flags,
+    D3D12_RESOURCE_STATES   initialState,
+    const char*             errorContext)
+{
+    ComPtr<ID3D12Resource> resource;
+    auto hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(heapType),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(size, flags),
+        initialState,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, errorContext);
+    return resource;
+}
+
+D3D12AccelerationStructure::D3D12AccelerationStructure(ID3D12Device5* device, const AccelerationStructureDescriptor& desc) :
+    AccelerationStructure { desc.type, desc.flags }
+{
+    if (desc.compactedSize > 0)
+    {
+        /* Destinations of a compaction only need storage for the compacted size, they are never built */
+        resource_ = CreateD3DBuffer(
+            device,
+            D3D12_HEAP_TYPE_DEFAULT,
+            desc.compactedSize,
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+            "failed to create D3D12 buffer for compacted acceleration structure"
+        );
+        return;
+    }
+
+    /* Query sizes for the storage and scratch buffer */
+    inputs_.Type            = (desc.type == AccelerationStructureType::TopLevel ? D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL : D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL);
+    inputs_.Flags           = GetD3DBuildFlags(desc.flags);
+    inputs_.DescsLayout     = D3D12_ELEMENTS_LAYOUT_ARRAY;
+
+    CreateGeometryDescs(desc);
+
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+    device->GetRaytracingAccelerationStructurePrebuildInfo(&inputs_, &prebuildInfo);
+
+    resource_ = CreateD3DBuffer(
+        device,
+        D3D12_HEAP_TYPE_DEFAULT,
+        prebuildInfo.ResultDataMaxSizeInBytes,
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+        "failed to create D3D12 buffer for acceleration structure"
+    );
+
+    scratchBuffer_ = CreateD3DBuffer(
+        device,
+        D3D12_HEAP_TYPE_DEFAULT,
+        std::max<UINT64>(prebuildInfo.ScratchDataSizeInBytes, 1),
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        "failed to create D3D12 scratch buffer for acceleration structure"
+    );
+
+    if ((desc.flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        CreateCompactionBuffers(device);
+}
+
+void D3D12AccelerationStructure::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    DXSetObjectName(resource_.Get(), name);
+    #endif
+}
+
+std::uint64_t D3D12AccelerationStructure::GetDeviceAddress() const
+{
+    return GetGPUVirtualAddress();
+}
+
+std::uint64_t D3D12AccelerationStructure::QueryCompactedSize()
+{
+    if (!readbackBuffer_)
+        return 0;
+
+    /* Read compacted size from the postbuild info, which is zero until the copy of the last build has been completed */
+    const D3D12_RANGE readRange { 0, sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC) };
+    const D3D12_RANGE writtenRange { 0, 0 };
+
+    void* data = nullptr;
+    if (FAILED(readbackBuffer_->Map(0, &readRange, &data)))
+        return 0;
+
+    const auto compactedSize = reinterpret_cast<const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC*>(data)->CompactedSizeInBytes;
+    readbackBuffer_->Unmap(0, &writtenRange);
+
+    return compactedSize;
+}
+
+void D3D12AccelerationStructure::Build(ID3D12GraphicsCommandList4* commandList)
+{
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc;
+    {
+        buildDesc.DestAccelerationStructureData     = GetGPUVirtualAddress();
+        buildDesc.Inputs                            = inputs_;
+        buildDesc.SourceAccelerationStructureData   = 0;
+        buildDesc.ScratchAccelerationStructureData  = scratchBuffer_->GetGPUVirtualAddress();
+    }
+
+    if (postbuildInfoBuffer_)
+    {
+        /* Emit compacted size together with the build */
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfoDesc;
+        {
+            postbuildInfoDesc.DestBuffer    = postbuildInfoBuffer_->GetGPUVirtualAddress();
+            postbuildInfoDesc.InfoType      = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+        }
+        commandList->BuildRaytracingAccelerationStructure(&buildDesc, 1, &postbuildInfoDesc);
+    }
+    else
+        commandList->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+}
+
+void D3D12AccelerationStructure::ResolveCompactedSize(ID3D12GraphicsCommandList* commandList)
+{
+    if (!postbuildInfoBuffer_)
+        return;
+
+    /* Reset host result, so the compacted size of a previous build is not mistaken for the result of this build */
+    const D3D12_RANGE readRange { 0, 0 };
+    const D3D12_RANGE writtenRange { 0, sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC) };
+
+    void* data = nullptr;
+    if (SUCCEEDED(readbackBuffer_->Map(0, &readRange, &data)))
+    {
+        reinterpret_cast<D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC*>(data)->CompactedSizeInBytes = 0;
+        readbackBuffer_->Unmap(0, &writtenRange);
+    }
+
+    /* Copy postbuild info into readback buffer (the state is restored so the buffer never needs to be tracked) */
+    commandList->ResourceBarrier(
+        1, &CD3DX12_RESOURCE_BARRIER::Transition(postbuildInfoBuffer_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE)
+    );
+
+    commandList->CopyBufferRegion(
+        readbackBuffer_.Get(),
+        0,
+        postbuildInfoBuffer_.Get(),
+        0,
+        sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC)
+    );
+
+    commandList->ResourceBarrier(
+        1, &CD3DX12_RESOURCE_BARRIER::Transition(postbuildInfoBuffer_.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+    );
+}
+
+void D3D12AccelerationStructure::TransitionInputs(D3D12BarrierBatch& barriers)
+{
+    for (auto bufferD3D : inputBuffers_)
+        bufferD3D->TransitionResource(barriers, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+}
+
+void D3D12AccelerationStructure::TransitionInputsToUsageState(D3D12BarrierBatch& barriers)
+{
+    for (auto bufferD3D : inputBuffers_)
+        bufferD3D->TransitionToUsageState(barriers);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12AccelerationStructure::CreateGeometryDescs(const AccelerationStructureDescriptor& desc)
+{
+    if (desc.type == AccelerationStructureType::TopLevel)
+    {
+        /* Top-level acceleration structures read their instances directly from the instance buffer */
+        auto instanceBufferD3D = LLGL_CAST(D3D12Buffer*, desc.instanceBuffer);
+        inputBuffers_.push_back(instanceBufferD3D);
+
+        inputs_.NumDescs        = desc.numInstances;
+        inputs_.InstanceDescs   = instanceBufferD3D->GetGPUVirtualAddress() + desc.instanceOffset;
+    }
+    else
+    {
+        geometryDescs_.reserve(desc.geometries.size());
+
+        for (const auto& triangles : desc.geometries)
+        {
+            auto vertexBufferD3D = LLGL_CAST(D3D12Buffer*, triangles.vertexBuffer);
+            auto indexBufferD3D = LLGL_CAST(D3D12Buffer*, triangles.indexBuffer);
+
+            D3D12_RAYTRACING_GEOMETRY_DESC geometryDesc;
+            {
+                geometryDesc.Type                                   = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+                geometryDesc.Flags                                  = (triangles.opaque ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE : D3D12_RAYTRACING_GEOMETRY_FLAG_NONE);
+                geometryDesc.Triangles.Transform3x4                 = 0;
+                geometryDesc.Triangles.VertexFormat                 = D3D12Types::Map(triangles.vertexFormat);
+                geometryDesc.Triangles.VertexCount                  = triangles.numVertices;
+                geometryDesc.Triangles.VertexBuffer.StartAddress    = vertexBufferD3D->GetGPUVirtualAddress() + triangles.vertexOffset;
+                geometryDesc.Triangles.VertexBuffer.StrideInBytes   = triangles.vertexStride;
+                if (indexBufferD3D != nullptr)
+                {
+                    geometryDesc.Triangles.IndexFormat              = D3D12Types::Map(triangles.indexFormat);
+                    geometryDesc.Triangles.IndexCount               = triangles.numIndices;
+                    geometryDesc.Triangles.IndexBuffer              = indexBufferD3D->GetGPUVirtualAddress() + triangles.indexOffset;
+                }
+                else
+                {
+                    geometryDesc.Triangles.IndexFormat              = DXGI_FORMAT_UNKNOWN;
+                    geometryDesc.Triangles.IndexCount               = 0;
+                    geometryDesc.Triangles.IndexBuffer              = 0;
+                }
+            }
+            geometryDescs_.push_back(geometryDesc);
+
+            inputBuffers_.push_back(vertexBufferD3D);
+            if (indexBufferD3D != nullptr)
+                inputBuffers_.push_back(indexBufferD3D);
+        }
+
+        inputs_.NumDescs        = static_cast<UINT>(geometryDescs_.size());
+        inputs_.pGeometryDescs  = geometryDescs_.data();
+    }
+}
+
+void D3D12AccelerationStructure::CreateCompactionBuffers(ID3D12Device5* device)
+{
+    const UINT64 postbuildInfoSize = sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC);
+
+    postbuildInfoBuffer_ = CreateD3DBuffer(
+        device,
+        D3D12_HEAP_TYPE_DEFAULT,
+        postbuildInfoSize,
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        "failed to create D3D12 postbuild info buffer for acceleration structure"
+    );
+
+    readbackBuffer_ = CreateD3DBuffer(
+        device,
+        D3D12_HEAP_TYPE_READBACK,
+        postbuildInfoSize,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        "failed to create D3D12 readback buffer for acceleration structure"
+    );
+}
+
+#endif // /__ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,89 @@
+/*
+ * D3D12AccelerationStructure.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_ACCELERATION_STRUCTURE_H
+#define LLGL_D3D12_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+#ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
+class D3D12Buffer;
+class D3D12BarrierBatch;
+
+/*
+Acceleration structure with its own storage and scratch buffer, so that multiple acceleration structures can be built within the same command list without barriers in between.
+Acceleration structures that allow compaction write their compacted size into a postbuild info buffer, which is copied into a readback buffer after each build.
+*/
+class D3D12AccelerationStructure final : public AccelerationStructure
+{
+
+    public:
+
+        D3D12AccelerationStructure(ID3D12Device5* device, const AccelerationStructureDescriptor& desc);
+
+        void SetName(const char* name) override;
+
+        std::uint64_t GetDeviceAddress() const override;
+        std::uint64_t QueryCompactedSize() override;
+
+        // Records the build command into the command list. The input buffers must be in the non-pixel shader resource state.
+        void Build(ID3D12GraphicsCommandList4* commandList);
+
+        // Records the copy of the postbuild info into the readback buffer. This must be called after a UAV barrier that follows the build.
+        void ResolveCompactedSize(ID3D12GraphicsCommandList* commandList);
+
+        // Appends transitions of all input buffers into the state for acceleration structure builds.
+        void TransitionInputs(D3D12BarrierBatch& barriers);
+
+        // Appends transitions of all input buffers back into their usage state.
+        void TransitionInputsToUsageState(D3D12BarrierBatch& barriers);
+
+        // Returns the GPU virtual address of the acceleration structure, which is also used for its SRV.
+        inline D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+        {
+            return resource_->GetGPUVirtualAddress();
+        }
+
+    private:
+
+        void CreateGeometryDescs(const AccelerationStructureDescriptor& desc);
+        void CreateCompactionBuffers(ID3D12Device5* device);
+
+    private:
+
+        ComPtr<ID3D12Resource>                                  resource_;
+        ComPtr<ID3D12Resource>                                  scratchBuffer_;
+        ComPtr<ID3D12Resource>                                  postbuildInfoBuffer_;
+        ComPtr<ID3D12Resource>                                  readbackBuffer_;
+
+        std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>             geometryDescs_;
+        std::vector<D3D12Buffer*>                               inputBuffers_;
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS    inputs_         = {};
+
+};
+
+#endif // /__ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
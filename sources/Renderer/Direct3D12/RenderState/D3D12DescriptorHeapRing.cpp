@@ -0,0 +1,135 @@
+/*
+ * D3D12DescriptorHeapRing.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12DescriptorHeapRing.h"
+#include "../D3D12RenderSystem.h"
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+D3D12DescriptorHeapRing::D3D12DescriptorHeapRing(D3D12RenderSystem& renderSystem, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT numDescriptors) :
+    renderSystem_   { renderSystem   },
+    type_           { type           },
+    numDescriptors_ { numDescriptors }
+{
+    /* Create shader-visible descriptor heap */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = type;
+        heapDesc.NumDescriptors = numDescriptors;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.NodeMask       = 0;
+    }
+    heap_ = renderSystem.CreateDXDescriptorHeap(heapDesc);
+
+    #ifdef LLGL_DEBUG
+    heap_->SetName(type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? L"LLGL::D3D12DescriptorHeapRing::heapTypeSampler" : L"LLGL::D3D12DescriptorHeapRing::heapTypeCbvSrvUav");
+    #endif
+
+    cpuHeapStart_   = heap_->GetCPUDescriptorHandleForHeapStart();
+    gpuHeapStart_   = heap_->GetGPUDescriptorHandleForHeapStart();
+    descriptorSize_ = renderSystem.GetDevice()->GetDescriptorHandleIncrementSize(type);
+}
+
+UINT D3D12DescriptorHeapRing::Allocate(UINT numDescriptors)
+{
+    if (numDescriptors > numDescriptors_)
+    {
+        throw std::invalid_argument(
+            "cannot allocate " + std::to_string(numDescriptors) + " descriptors from D3D12 descriptor heap ring with capacity of " +
+            std::to_string(numDescriptors_)
+        );
+    }
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    /* Recycle ranges of all segments the GPU has already finished */
+    RetireCompletedSegments();
+
+    while (true)
+    {
+        /* Ranges must be contiguous, so wrap around to the beginning if the range does not fit until the end */
+        auto pos    = head_ % numDescriptors_;
+        auto start  = (pos + numDescriptors > numDescriptors_ ? 0 : pos);
+        auto size   = (start == 0 && pos != 0 ? numDescriptors_ - pos : 0) + numDescriptors;
+
+        if (head_ + size - tail_ <= numDescriptors_)
+        {
+            head_ += size;
+            return static_cast<UINT>(start);
+        }
+
+        /* Wait for oldest segment to free descriptors */
+        if (!RetireOldestSegment())
+            throw std::runtime_error("out of descriptors in D3D12 descriptor heap ring (too many resource heaps bound before submission)");
+    }
+}
+
+void D3D12DescriptorHeapRing::Submit(UINT64 fenceValue)
+{
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    /* Close current segment of the ring */
+    if (head_ != submittedHead_)
+    {
+        segments_.push_back({ fenceValue, head_ });
+        submittedHead_ = head_;
+    }
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorHeapRing::GetCPUDescriptorHandle(UINT index) const
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = cpuHeapStart_;
+    handle.ptr += static_cast<SIZE_T>(index) * descriptorSize_;
+    return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorHeapRing::GetGPUDescriptorHandle(UINT index) const
+{
+    D3D12_GPU_DESCRIPTOR_HANDLE handle = gpuHeapStart_;
+    handle.ptr += static_cast<UINT64>(index) * descriptorSize_;
+    return handle;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12DescriptorHeapRing::RetireCompletedSegments()
+{
+    const auto completedValue = renderSystem_.GetCompletedFenceValue();
+
+    /* Free descriptors up to the end of the last completed segment */
+    while (!segments_.empty() && segments_.front().fenceValue <= completedValue)
+    {
+        tail_ = segments_.front().end;
+        segments_.pop_front();
+    }
+}
+
+bool D3D12DescriptorHeapRing::RetireOldestSegment()
+{
+    if (segments_.empty())
+        return false;
+
+    renderSystem_.WaitForFenceValue(segments_.front().fenceValue);
+    RetireCompletedSegments();
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,105 @@
+/*
+ * D3D12DescriptorHeapRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_DESCRIPTOR_HEAP_RING_H
+#define LLGL_D3D12_DESCRIPTOR_HEAP_RING_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <deque>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+
+/*
+Global shader-visible descriptor heap with ring allocation.
+Resource heaps keep their descriptors in non-shader-visible heaps and copy them into a contiguous range of this ring when they are bound,
+so a command list only has to bind the global heaps once. Ranges are recycled as soon as the fence value they have been submitted with has been reached.
+Allocations are guarded by a mutex, since bundles are recorded on worker threads.
+*/
+class D3D12DescriptorHeapRing
+{
+
+    public:
+
+        D3D12DescriptorHeapRing(D3D12RenderSystem& renderSystem, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT numDescriptors);
+
+        D3D12DescriptorHeapRing(const D3D12DescriptorHeapRing&) = delete;
+        D3D12DescriptorHeapRing& operator = (const D3D12DescriptorHeapRing&) = delete;
+
+        // Allocates a contiguous range of descriptors and returns the index of the first descriptor.
+        UINT Allocate(UINT numDescriptors);
+
+        // Assigns all ranges that have been allocated since the last submission to the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+        // Returns the CPU descriptor handle of the specified descriptor index.
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandle(UINT index) const;
+
+        // Returns the GPU descriptor handle of the specified descriptor index.
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGPUDescriptorHandle(UINT index) const;
+
+        // Returns the native shader-visible descriptor heap.
+        inline ID3D12DescriptorHeap* GetNative() const
+        {
+            return heap_.Get();
+        }
+
+        // Returns the descriptor heap type of this ring.
+        inline D3D12_DESCRIPTOR_HEAP_TYPE GetType() const
+        {
+            return type_;
+        }
+
+    private:
+
+        struct Segment
+        {
+            UINT64 fenceValue;
+            UINT64 end;
+        };
+
+        // Releases all segments whose fence value has been reached (non-blocking).
+        void RetireCompletedSegments();
+
+        // Waits for the oldest submitted segment and releases it. Returns false if there is no submitted segment.
+        bool RetireOldestSegment();
+
+        D3D12RenderSystem&              renderSystem_;
+        D3D12_DESCRIPTOR_HEAP_TYPE      type_;
+
+        ComPtr<ID3D12DescriptorHeap>    heap_;
+        D3D12_CPU_DESCRIPTOR_HANDLE     cpuHeapStart_       = {};
+        D3D12_GPU_DESCRIPTOR_HANDLE     gpuHeapStart_       = {};
+        UINT                            descriptorSize_     = 0;
+
+        UINT64                          numDescriptors_     = 0;
+        UINT64                          head_               = 0;
+        UINT64                          tail_               = 0;
+        UINT64                          submittedHead_      = 0;
+
+        std::deque<Segment>             segments_;
+
+        std::mutex                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,26 +7,22 @@
 
 #include "D3D12Fence.h"
 #include "../../DXCommon/DXCore.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Number of times a fence is polled before the CPU blocks on an event, which avoids the overhead of the event for short waits.
+static const int g_fenceSpinCount = 64;
+
 D3D12Fence::D3D12Fence(ID3D12Device* device, UINT64 initialValue) :
     value_ { initialValue }
 {
     /* Create D3D12 fence */
     auto hr = device->CreateFence(value_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 fence");
-
-    /* Create Win32 event handle */
-    event_ = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
-}
-
-D3D12Fence::~D3D12Fence()
-{
-    CloseHandle(event_);
 }
 
 void D3D12Fence::Submit(ID3D12CommandQueue* commandQueue)
@@ -37,6 +33,52 @@ void D3D12Fence::Submit(ID3D12CommandQueue* commandQueue)
     DXThrowIfFailed(hr, "failed to signal D3D12 fence with command queue");
 }
 
+bool D3D12Fence::Wait(UINT64 timeout)
+{
+    return WaitValue(value_, timeout);
+}
+
+std::uint64_t D3D12Fence::GetCompletedValue()
+{
+    return fence_->GetCompletedValue();
+}
+
+void D3D12Fence::Signal(ID3D12CommandQueue* commandQueue, UINT64 value)
+{
+    auto hr = commandQueue->Signal(fence_.Get(), value);
+    DXThrowIfFailed(hr, "failed to signal D3D12 fence with command queue");
+    value_ = std::max(value_, value);
+}
+
+void D3D12Fence::QueueWait(ID3D12CommandQueue* commandQueue, UINT64 value)
+{
+    auto hr = commandQueue->Wait(fence_.Get(), value);
+    DXThrowIfFailed(hr, "failed to wait for D3D12 fence with command queue");
+}
+
+bool D3D12Fence::WaitValue(UINT64 value, UINT64 timeout)
+{
+    return D3D12WaitForFenceValue(fence_.Get(), value, timeout);
+}
+
+bool D3D12Fence::IsIdle()
+{
+    return (fence_->GetCompletedValue() >= value_);
+}
+
+void D3D12Fence::Recycle()
+{
+    /* Reset fence value from the CPU side */
+    auto hr = fence_->Signal(0);
+    DXThrowIfFailed(hr, "failed to reset D3D12 fence");
+    value_ = 0;
+}
+
+
+/*
+ * Global functions
+ */
+
 // Converts the specified amount of nanoseconds into milliseconds (rounded up)
 static DWORD NanosecsToMillisecs(UINT64 t)
 {
@@ -46,15 +88,94 @@ static DWORD NanosecsToMillisecs(UINT64 t)
         return static_cast<DWORD>((t + 999999) / 1000000);
 }
 
-bool D3D12Fence::Wait(UINT64 timeout)
+// Win32 event that is owned by a single thread, so waits from different threads never share an event
+struct D3D12ThreadFenceEvent
+{
+    D3D12ThreadFenceEvent() :
+        handle { CreateEvent(nullptr, FALSE, FALSE, nullptr) }
+    {
+    }
+
+    ~D3D12ThreadFenceEvent()
+    {
+        if (handle)
+            CloseHandle(handle);
+    }
+
+    HANDLE handle;
+};
+
+// Returns the event of the calling thread, which has been reset so a signal of a previously timed out wait is discarded.
+static HANDLE GetThreadFenceEvent()
+{
+    static thread_local D3D12ThreadFenceEvent threadEvent;
+    if (!threadEvent.handle)
+        DXThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()), "failed to create Win32 event object");
+    ResetEvent(threadEvent.handle);
+    return threadEvent.handle;
+}
+
+static bool HasCompletedFenceValues(UINT numFences, ID3D12Fence* const* fences, const UINT64* values)
+{
+    for (UINT i = 0; i < numFences; ++i)
+    {
+        if (fences[i]->GetCompletedValue() < values[i])
+            return false;
+    }
+    return true;
+}
+
+// Polls the specified fences for a short while and returns true if they have all been completed.
+static bool SpinForFenceValues(UINT numFences, ID3D12Fence* const* fences, const UINT64* values, UINT64 timeout)
+{
+    const int spinCount = (timeout > 0 ? g_fenceSpinCount : 1);
+    for (int i = 0; i < spinCount; ++i)
+    {
+        if (HasCompletedFenceValues(numFences, fences, values))
+            return true;
+        YieldProcessor();
+    }
+    return false;
+}
+
+bool D3D12WaitForFenceValue(ID3D12Fence* fence, UINT64 value, UINT64 timeout)
+{
+    if (SpinForFenceValues(1, &fence, &value, timeout))
+        return true;
+    if (timeout == 0)
+        return false;
+
+    /* Block on the event of this thread until the fence has been crossed */
+    HANDLE event = GetThreadFenceEvent();
+    auto hr = fence->SetEventOnCompletion(value, event);
+    DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
+    return (WaitForSingleObject(event, NanosecsToMillisecs(timeout)) == WAIT_OBJECT_0);
+}
+
+bool D3D12WaitForFenceValues(ID3D12Device* device, UINT numFences, ID3D12Fence* const* fences, const UINT64* values, UINT64 timeout)
 {
-    /* Wait until the fence has been crossed */
-    if (fence_->GetCompletedValue() < value_)
+    if (SpinForFenceValues(numFences, fences, values, timeout))
+        return true;
+    if (timeout == 0)
+        return false;
+
+    /* Block on a single event for all fences (requires ID3D12Device1) */
+    ComPtr<ID3D12Device1> device1;
+    if (numFences > 1 && SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(device1.GetAddressOf()))))
     {
-        auto hr = fence_->SetEventOnCompletion(value_, event_);
-        DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
-        return (WaitForSingleObject(event_, NanosecsToMillisecs(timeout)) == WAIT_OBJECT_0);
+        HANDLE event = GetThreadFenceEvent();
+        auto hr = device1->SetEventOnMultipleFenceCompletion(fences, values, numFences, D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL, event);
+        DXThrowIfFailed(hr, "failed to set 'on completion'-event for multiple D3D12 fences");
+        return (WaitForSingleObject(event, NanosecsToMillisecs(timeout)) == WAIT_OBJECT_0);
     }
+
+    /* Otherwise, wait for one fence after another (the timeout applies to each fence) */
+    for (UINT i = 0; i < numFences; ++i)
+    {
+        if (!D3D12WaitForFenceValue(fences[i], values[i], timeout))
+            return false;
+    }
+
     return true;
 }
 
@@ -24,20 +24,60 @@ class D3D12Fence final : public Fence
     public:
 
         D3D12Fence(ID3D12Device* device, UINT64 initialValue);
-        ~D3D12Fence();
+
+        std::uint64_t GetCompletedValue() override;
 
         void Submit(ID3D12CommandQueue* commandQueue);
         bool Wait(UINT64 timeout);
 
+        // Schedules a signal command with the specified timeline value into the queue.
+        void Signal(ID3D12CommandQueue* commandQueue, UINT64 value);
+
+        // Schedules a GPU-side wait for the specified timeline value into the queue.
+        void QueueWait(ID3D12CommandQueue* commandQueue, UINT64 value);
+
+        // Blocks the CPU until the specified timeline value has been reached, or the timeout (in nanoseconds) has expired.
+        bool WaitValue(UINT64 value, UINT64 timeout);
+
+        // Returns true if the GPU has reached all values this fence has been submitted or signaled with, i.e. the fence can be recycled.
+        bool IsIdle();
+
+        // Resets this fence to its initial value 0 for recycling. The fence must be idle.
+        void Recycle();
+
+        // Returns the value of the last submission with Submit(ID3D12CommandQueue*), or the greatest value this fence has been signaled with.
+        inline UINT64 GetValue() const
+        {
+            return value_;
+        }
+
+        inline ID3D12Fence* GetNative() const
+        {
+            return fence_.Get();
+        }
+
     private:
 
         ComPtr<ID3D12Fence> fence_;
-        HANDLE              event_  = 0;
         UINT64              value_  = 0;
 
 };
 
 
+/*
+Blocks the CPU until the specified fence has reached the specified value, or the timeout (in nanoseconds) has expired.
+Short waits are resolved by polling the fence, and longer waits block on a Win32 event of the calling thread,
+so any number of threads can wait for the same fence concurrently.
+*/
+bool D3D12WaitForFenceValue(ID3D12Fence* fence, UINT64 value, UINT64 timeout);
+
+/*
+Blocks the CPU until all specified fences have reached their respective values, or the timeout (in nanoseconds) has expired.
+This uses a single event for all fences if the device supports ID3D12Device1.
+*/
+bool D3D12WaitForFenceValues(ID3D12Device* device, UINT numFences, ID3D12Fence* const* fences, const UINT64* values, UINT64 timeout);
+
+
 } // /namespace LLGL
 
 
@@ -16,8 +16,10 @@
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
 #include "../../../Core/Assertion.h"
+#include "../../../Core/TaskQueue.h"
 #include <LLGL/GraphicsPipelineFlags.h>
 #include <algorithm>
+#include <memory>
 
 
 namespace LLGL
@@ -25,10 +27,19 @@ namespace LLGL
 
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dn770370(v=vs.85).aspx
-D3D12GraphicsPipeline::D3D12GraphicsPipeline(D3D12RenderSystem& renderSystem, const GraphicsPipelineDescriptor& desc) :
-    primitiveTopology_ { D3D12Types::Map(desc.primitiveTopology) },
-    scissorEnabled_    { desc.rasterizer.scissorTestEnabled      }
+D3D12GraphicsPipeline::D3D12GraphicsPipeline(D3D12RenderSystem& renderSystem, const GraphicsPipelineDescriptor& desc, bool async) :
+    primitiveTopology_  { D3D12Types::Map(desc.primitiveTopology)                             },
+    scissorEnabled_     { desc.rasterizer.scissorTestEnabled                                  },
+    stencilRef_         { desc.stencil.front.reference                                        },
+    stencilRefDynamic_  { ((desc.dynamicStates & DynamicStateFlags::StencilReference) != 0) },
+    blendFactorDynamic_ { ((desc.dynamicStates & DynamicStateFlags::BlendFactor) != 0)      }
 {
+    /* Store blend factor */
+    blendFactor_[0] = desc.blend.blendFactor.r;
+    blendFactor_[1] = desc.blend.blendFactor.g;
+    blendFactor_[2] = desc.blend.blendFactor.b;
+    blendFactor_[3] = desc.blend.blendFactor.a;
+
     /* Validate pointers and get D3D shader program */
     LLGL_ASSERT_PTR(desc.shaderProgram);
 
@@ -36,16 +47,50 @@ D3D12GraphicsPipeline::D3D12GraphicsPipeline(D3D12RenderSystem& renderSystem, co
 
     if (auto pipelineLayout = desc.pipelineLayout)
     {
-        /* Create pipeline state with root signature from pipeline layout */
+        /* Use root signature from pipeline layout */
         auto pipelineLayoutD3D = LLGL_CAST(D3D12PipelineLayout*, pipelineLayout);
-        CreatePipelineState(renderSystem, *shaderProgramD3D, pipelineLayoutD3D->GetRootSignature(), desc);
+        rootSignature_              = pipelineLayoutD3D->GetRootSignature();
+        constantsRootParamIndex_    = pipelineLayoutD3D->GetConstantsRootParamIndex();
     }
     else
     {
-        /* Create pipeline state with default root signature */
+        /* Use default root signature */
         CreateDefaultRootSignature(renderSystem.GetDevice());
-        CreatePipelineState(renderSystem, *shaderProgramD3D, defaultRootSignature_.Get(), desc);
+        rootSignature_ = defaultRootSignature_.Get();
     }
+
+    /* Create pipeline state with the selected root signature */
+    if (async)
+        CreatePipelineStateAsync(renderSystem, *shaderProgramD3D, rootSignature_, desc);
+    else
+        CreatePipelineState(renderSystem, *shaderProgramD3D, rootSignature_, desc);
+}
+
+D3D12GraphicsPipeline::~D3D12GraphicsPipeline()
+{
+    /* Pipeline must not be destroyed while it is still being created */
+    if (createTask_.valid())
+        createTask_.wait();
+}
+
+bool D3D12GraphicsPipeline::IsReady() const
+{
+    return IsFutureReady(createTask_);
+}
+
+ID3D12PipelineState* D3D12GraphicsPipeline::GetPipelineState() const
+{
+    if (createTask_.valid())
+        createTask_.get();
+    return pipelineState_.Get();
+}
+
+void D3D12GraphicsPipeline::SetOutputMergerStates(ID3D12GraphicsCommandList* commandList) const
+{
+    if (!stencilRefDynamic_)
+        commandList->OMSetStencilRef(stencilRef_);
+    if (!blendFactorDynamic_)
+        commandList->OMSetBlendFactor(blendFactor_);
 }
 
 void D3D12GraphicsPipeline::CreateDefaultRootSignature(ID3D12Device* device)
@@ -194,9 +239,6 @@ void D3D12GraphicsPipeline::CreatePipelineState(
     ID3D12RootSignature*                rootSignature,
     const GraphicsPipelineDescriptor&   desc)
 {
-    /* Store used root signature */
-    rootSignature_ = rootSignature;
-
     /* Get number of render-target attachments */
     UINT numAttachments = 1u; //TODO
 
@@ -319,6 +361,23 @@ void D3D12GraphicsPipeline::CreatePipelineState(
     pipelineState_ = renderSystem.CreateDXGfxPipelineState(stateDesc);
 }
 
+void D3D12GraphicsPipeline::CreatePipelineStateAsync(
+    D3D12RenderSystem&                  renderSystem,
+    D3D12ShaderProgram&                 shaderProgram,
+    ID3D12RootSignature*                rootSignature,
+    const GraphicsPipelineDescriptor&   desc)
+{
+    /* Copy descriptor for the worker thread (ID3D12Device is free-threaded) */
+    auto ownedDesc = std::make_shared<GraphicsPipelineDescriptor>(desc);
+
+    createTask_ = TaskQueue::Get().Enqueue(
+        [this, &renderSystem, &shaderProgram, rootSignature, ownedDesc]()
+        {
+            CreatePipelineState(renderSystem, shaderProgram, rootSignature, *ownedDesc);
+        }
+    );
+}
+
 
 } // /namespace LLGL
 
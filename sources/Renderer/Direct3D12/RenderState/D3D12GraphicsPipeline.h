@@ -12,6 +12,7 @@
 #include <LLGL/GraphicsPipeline.h>
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
+#include <future>
 #include <d3d12.h>
 
 
@@ -31,8 +32,12 @@ class D3D12GraphicsPipeline final : public GraphicsPipeline
         D3D12GraphicsPipeline(
             D3D12RenderSystem& renderSystem,
             //ID3D12RootSignature* rootSignature,
-            const GraphicsPipelineDescriptor& desc
+            const GraphicsPipelineDescriptor& desc,
+            bool async = false
         );
+        ~D3D12GraphicsPipeline();
+
+        bool IsReady() const override;
 
         // Returns the internal ID3D12RootSignature object.
         inline ID3D12RootSignature* GetRootSignature() const
@@ -40,11 +45,8 @@ class D3D12GraphicsPipeline final : public GraphicsPipeline
             return rootSignature_;
         }
 
-        // Returns the internal ID3D12PipelineState object.
-        inline ID3D12PipelineState* GetPipelineState() const
-        {
-            return pipelineState_.Get();
-        }
+        // Returns the internal ID3D12PipelineState object. This waits until the pipeline state has been created if it was created asynchronously.
+        ID3D12PipelineState* GetPipelineState() const;
 
         // Returns the primitive topology.
         inline D3D12_PRIMITIVE_TOPOLOGY GetPrimitiveTopology() const
@@ -58,6 +60,15 @@ class D3D12GraphicsPipeline final : public GraphicsPipeline
             return scissorEnabled_;
         }
 
+        // Returns the root parameter index of the root constants from the pipeline layout, or -1 if there are no constants.
+        inline INT GetConstantsRootParamIndex() const
+        {
+            return constantsRootParamIndex_;
+        }
+
+        // Sets the stencil reference value and blend factor of this pipeline, unless they are dynamic states.
+        void SetOutputMergerStates(ID3D12GraphicsCommandList* commandList) const;
+
     private:
 
         void CreateDefaultRootSignature(ID3D12Device* device);
@@ -69,17 +80,32 @@ class D3D12GraphicsPipeline final : public GraphicsPipeline
             const GraphicsPipelineDescriptor&   desc
         );
 
+        void CreatePipelineStateAsync(
+            D3D12RenderSystem&                  renderSystem,
+            D3D12ShaderProgram&                 shaderProgram,
+            ID3D12RootSignature*                rootSignature,
+            const GraphicsPipelineDescriptor&   desc
+        );
+
         ComPtr<ID3D12PipelineState> pipelineState_;
         ID3D12RootSignature*        rootSignature_      = nullptr;
 
         D3D12_PRIMITIVE_TOPOLOGY    primitiveTopology_  = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 
         bool                        scissorEnabled_     = false;
+        INT                         constantsRootParamIndex_ = -1;
+
+        UINT                        stencilRef_         = 0;
+        FLOAT                       blendFactor_[4]     = { 0.0f, 0.0f, 0.0f, 0.0f };
+        bool                        stencilRefDynamic_  = false;
+        bool                        blendFactorDynamic_ = false;
 
         #if 1//TODO: replace this by D3D12PipelineLayout
         ComPtr<ID3D12RootSignature> defaultRootSignature_;
         #endif
 
+        std::shared_future<void>    createTask_;
+
 };
 
 
@@ -0,0 +1,88 @@
+/*
+ * D3D12IndirectCommandLayout.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12IndirectCommandLayout.h"
+#include "D3D12PipelineLayout.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../CheckedCast.h"
+#include <vector>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static D3D12_INDIRECT_ARGUMENT_DESC ToD3D12IndirectArgument(const IndirectArgumentDescriptor& argumentDesc, INT constantsRootParamIndex)
+{
+    D3D12_INDIRECT_ARGUMENT_DESC desc = {};
+    switch (argumentDesc.type)
+    {
+        case IndirectArgumentType::Draw:
+            desc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+            break;
+        case IndirectArgumentType::DrawIndexed:
+            desc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+            break;
+        case IndirectArgumentType::VertexBuffer:
+            desc.Type                   = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+            desc.VertexBuffer.Slot      = argumentDesc.slot;
+            break;
+        case IndirectArgumentType::Constants:
+            if (constantsRootParamIndex < 0)
+                throw std::invalid_argument("cannot create indirect command layout with constant arguments for pipeline layout without constants");
+            desc.Type                               = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+            desc.Constant.RootParameterIndex        = static_cast<UINT>(constantsRootParamIndex);
+            desc.Constant.DestOffsetIn32BitValues   = argumentDesc.slot;
+            desc.Constant.Num32BitValuesToSet       = argumentDesc.numValues;
+            break;
+    }
+    return desc;
+}
+
+D3D12IndirectCommandLayout::D3D12IndirectCommandLayout(ID3D12Device* device, const IndirectCommandLayoutDescriptor& desc) :
+    IndirectCommandLayout { desc }
+{
+    /* Only command signatures that change root arguments require a root signature */
+    ID3D12RootSignature*    rootSignature           = nullptr;
+    INT                     constantsRootParamIndex = -1;
+
+    for (const auto& argument : desc.arguments)
+    {
+        if (argument.type == IndirectArgumentType::Constants)
+        {
+            auto pipelineLayoutD3D  = LLGL_CAST(D3D12PipelineLayout*, desc.pipelineLayout);
+            rootSignature           = pipelineLayoutD3D->GetRootSignature();
+            constantsRootParamIndex = pipelineLayoutD3D->GetConstantsRootParamIndex();
+            break;
+        }
+    }
+
+    /* Convert arguments in the same order as they appear in the argument buffer */
+    std::vector<D3D12_INDIRECT_ARGUMENT_DESC> argumentDescs;
+    argumentDescs.reserve(desc.arguments.size());
+
+    for (const auto& argument : desc.arguments)
+        argumentDescs.push_back(ToD3D12IndirectArgument(argument, constantsRootParamIndex));
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc;
+    {
+        signatureDesc.ByteStride        = GetStride();
+        signatureDesc.NumArgumentDescs  = static_cast<UINT>(argumentDescs.size());
+        signatureDesc.pArgumentDescs    = argumentDescs.data();
+        signatureDesc.NodeMask          = 0;
+    }
+    auto hr = device->CreateCommandSignature(&signatureDesc, rootSignature, IID_PPV_ARGS(commandSignature_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 command signature");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,48 @@
+/*
+ * D3D12IndirectCommandLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_INDIRECT_COMMAND_LAYOUT_H
+#define LLGL_D3D12_INDIRECT_COMMAND_LAYOUT_H
+
+
+#include <LLGL/IndirectCommandLayout.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+// Indirect command layout with a native command signature. The root signature of the pipeline layout is only bound to the signature if it changes constants.
+class D3D12IndirectCommandLayout final : public IndirectCommandLayout
+{
+
+    public:
+
+        D3D12IndirectCommandLayout(ID3D12Device* device, const IndirectCommandLayoutDescriptor& desc);
+
+        inline ID3D12CommandSignature* GetNative() const
+        {
+            return commandSignature_.Get();
+        }
+
+    private:
+
+        ComPtr<ID3D12CommandSignature> commandSignature_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
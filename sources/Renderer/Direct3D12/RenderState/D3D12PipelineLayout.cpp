@@ -7,31 +7,48 @@
 
 #include "D3D12PipelineLayout.h"
 #include "../Shader/D3D12RootSignature.h"
+#include "../D3D12Types.h"
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-D3D12PipelineLayout::D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc)
+D3D12PipelineLayout::D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc, D3D12RootSignatureCache& rootSignatureCache) :
+    bindings_ { desc.bindings }
 {
     D3D12RootSignature rootSignature;
-    rootSignature.Reset(desc.bindings.size(), 0);
+    rootSignature.Reset(desc.bindings.size() + 1, static_cast<UINT>(desc.staticSamplers.size()));
 
     /* Build root parameter for each descriptor range type */
-    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_CBV,     desc, ResourceType::ConstantBuffer);
-    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Texture       );
-    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::StorageBuffer );
-    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, desc, ResourceType::Sampler       );
+    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_CBV,     desc, ResourceType::ConstantBuffer       );
+    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Texture              );
+    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::AccelerationStructure);
+    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::StorageBuffer        );
+    BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, desc, ResourceType::Sampler              );
+
+    /* Build root constant buffer views for all bindings with dynamic offsets */
+    BuildDynamicRootParameters(rootSignature, desc);
+
+    /* Build root constants after all descriptor tables, so the root parameter indices of the tables remain unchanged */
+    if (desc.constants.size > 0)
+    {
+        constantsRootParamIndex_ = rootSignature.GetNumRootParameters();
+        rootSignature.AppendRootParameter()->InitAsConstants(desc.constants.slot, desc.constants.size / 4);
+    }
+
+    /* Bake immutable samplers into the root signature, so they don't occupy the sampler descriptor heap */
+    BuildStaticSamplers(rootSignature, desc);
 
     /* Get root signature flags */
     D3D12_ROOT_SIGNATURE_FLAGS signatureFlags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
     BuildRootSignatureFlags(signatureFlags, desc);
 
-    /* Build final root signature descriptor */
-    rootSignature_ = rootSignature.Finalize(device, signatureFlags);
+    /* Build final root signature descriptor, or share it with identical previous ones */
+    rootSignature_ = rootSignature.Finalize(device, rootSignatureCache, signatureFlags);
 }
 
 
@@ -47,7 +64,7 @@ void D3D12PipelineLayout::BuildRootParameter(
 {
     for (const auto& binding : layoutDesc.bindings)
     {
-        if (binding.type == resourceType)
+        if (binding.type == resourceType && (binding.flags & BindingFlags::DynamicOffset) == 0)
         {
             if (auto rootParam = rootSignature.FindCompatibleRootParameter(descRangeType))
             {
@@ -65,6 +82,83 @@ void D3D12PipelineLayout::BuildRootParameter(
     }
 }
 
+void D3D12PipelineLayout::BuildDynamicRootParameters(D3D12RootSignature& rootSignature, const PipelineLayoutDescriptor& layoutDesc)
+{
+    /* Collect slots of all constant buffers with dynamic offsets */
+    std::vector<UINT> slots;
+
+    for (const auto& binding : layoutDesc.bindings)
+    {
+        if (binding.type == ResourceType::ConstantBuffer && (binding.flags & BindingFlags::DynamicOffset) != 0)
+            slots.push_back(binding.slot);
+    }
+
+    /* Append one root CBV per binding in ascending order of their slots, since the dynamic offsets are specified in that order */
+    std::sort(slots.begin(), slots.end());
+
+    firstDynamicRootParamIndex_ = rootSignature.GetNumRootParameters();
+    numDynamicRootParams_       = static_cast<UINT>(slots.size());
+
+    for (auto slot : slots)
+        rootSignature.AppendRootParameter()->InitAsDescriptor(D3D12_ROOT_PARAMETER_TYPE_CBV, slot);
+}
+
+// Returns the shader visibility for the specified stage flags, which is restricted to a single stage if possible.
+static D3D12_SHADER_VISIBILITY GetD3DShaderVisibility(long stageFlags)
+{
+    switch (stageFlags & StageFlags::AllStages)
+    {
+        case StageFlags::VertexStage:           return D3D12_SHADER_VISIBILITY_VERTEX;
+        case StageFlags::TessControlStage:      return D3D12_SHADER_VISIBILITY_HULL;
+        case StageFlags::TessEvaluationStage:   return D3D12_SHADER_VISIBILITY_DOMAIN;
+        case StageFlags::GeometryStage:         return D3D12_SHADER_VISIBILITY_GEOMETRY;
+        case StageFlags::FragmentStage:         return D3D12_SHADER_VISIBILITY_PIXEL;
+        default:                                return D3D12_SHADER_VISIBILITY_ALL;
+    }
+}
+
+// Returns the predefined border color that is closest to the specified color (static samplers don't support arbitrary border colors).
+static D3D12_STATIC_BORDER_COLOR GetD3DStaticBorderColor(const ColorRGBAf& color)
+{
+    if (color.a > 0.5f)
+    {
+        if (color.r <= 0.5f && color.g <= 0.5f && color.b <= 0.5f)
+            return D3D12_STATIC_BORDER_COLOR_OPAQUE_BLACK;
+        if (color.r > 0.5f && color.g > 0.5f && color.b > 0.5f)
+            return D3D12_STATIC_BORDER_COLOR_OPAQUE_WHITE;
+    }
+    return D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+}
+
+static void Convert(D3D12_STATIC_SAMPLER_DESC& dst, const StaticSamplerDescriptor& src)
+{
+    const auto& samplerDesc = src.sampler;
+
+    dst.Filter              = D3D12Types::Map(samplerDesc);
+    dst.AddressU            = D3D12Types::Map(samplerDesc.addressModeU);
+    dst.AddressV            = D3D12Types::Map(samplerDesc.addressModeV);
+    dst.AddressW            = D3D12Types::Map(samplerDesc.addressModeW);
+    dst.MipLODBias          = samplerDesc.mipMapLODBias;
+    dst.MaxAnisotropy       = samplerDesc.maxAnisotropy;
+    dst.ComparisonFunc      = (samplerDesc.compareEnabled ? D3D12Types::Map(samplerDesc.compareOp) : D3D12_COMPARISON_FUNC_ALWAYS);
+    dst.BorderColor         = GetD3DStaticBorderColor(samplerDesc.borderColor);
+    dst.MinLOD              = (samplerDesc.mipMapping ? samplerDesc.minLOD : 0.0f);
+    dst.MaxLOD              = (samplerDesc.mipMapping ? samplerDesc.maxLOD : 0.0f);
+    dst.ShaderRegister      = src.slot;
+    dst.RegisterSpace       = 0;
+    dst.ShaderVisibility    = GetD3DShaderVisibility(src.stageFlags);
+}
+
+void D3D12PipelineLayout::BuildStaticSamplers(D3D12RootSignature& rootSignature, const PipelineLayoutDescriptor& layoutDesc)
+{
+    for (const auto& staticSampler : layoutDesc.staticSamplers)
+    {
+        D3D12_STATIC_SAMPLER_DESC samplerDesc;
+        Convert(samplerDesc, staticSampler);
+        rootSignature.AppendStaticSampler(samplerDesc);
+    }
+}
+
 //TODO: properly enable D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT and D3D12_ROOT_SIGNATURE_FLAG_ALLOW_STREAM_OUTPUT
 void D3D12PipelineLayout::BuildRootSignatureFlags(
     D3D12_ROOT_SIGNATURE_FLAGS&     signatureFlags,
@@ -76,6 +170,8 @@ void D3D12PipelineLayout::BuildRootSignatureFlags(
     long stageFlags = 0;
     for (const auto& binding : layoutDesc.bindings)
         stageFlags |= binding.stageFlags;
+    for (const auto& staticSampler : layoutDesc.staticSamplers)
+        stageFlags |= staticSampler.stageFlags;
 
     /* Deny access to root signature for shader stages that are not affected by any binding point */
     if ((stageFlags & StageFlags::VertexStage) == 0)
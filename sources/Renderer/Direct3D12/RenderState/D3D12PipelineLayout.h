@@ -21,13 +21,14 @@ namespace LLGL
 
 
 class D3D12RootSignature;
+class D3D12RootSignatureCache;
 
 class D3D12PipelineLayout final : public PipelineLayout
 {
 
     public:
 
-        D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc);
+        D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc, D3D12RootSignatureCache& rootSignatureCache);
 
         // Returns the native ID3D12RootSignature object.
         inline ID3D12RootSignature* GetRootSignature() const
@@ -35,6 +36,30 @@ class D3D12PipelineLayout final : public PipelineLayout
             return rootSignature_.Get();
         }
 
+        // Returns the list of all layout bindings.
+        inline const std::vector<BindingDescriptor>& GetBindings() const
+        {
+            return bindings_;
+        }
+
+        // Returns the root parameter index of the first root CBV for the constant buffers with dynamic offsets.
+        inline UINT GetFirstDynamicRootParamIndex() const
+        {
+            return firstDynamicRootParamIndex_;
+        }
+
+        // Returns the number of root CBVs for the constant buffers with dynamic offsets.
+        inline UINT GetNumDynamicRootParams() const
+        {
+            return numDynamicRootParams_;
+        }
+
+        // Returns the root parameter index of the root constants, or -1 if this layout has no constants.
+        inline INT GetConstantsRootParamIndex() const
+        {
+            return constantsRootParamIndex_;
+        }
+
     private:
 
         void BuildRootParameter(
@@ -44,12 +69,19 @@ class D3D12PipelineLayout final : public PipelineLayout
             const ResourceType              resourceType
         );
 
+        void BuildDynamicRootParameters(D3D12RootSignature& rootSignature, const PipelineLayoutDescriptor& layoutDesc);
+        void BuildStaticSamplers(D3D12RootSignature& rootSignature, const PipelineLayoutDescriptor& layoutDesc);
+
         void BuildRootSignatureFlags(
             D3D12_ROOT_SIGNATURE_FLAGS&     signatureFlags,
             const PipelineLayoutDescriptor& layoutDesc
         );
 
-        ComPtr<ID3D12RootSignature> rootSignature_;
+        ComPtr<ID3D12RootSignature>     rootSignature_;
+        std::vector<BindingDescriptor>  bindings_;
+        UINT                            firstDynamicRootParamIndex_ = 0;
+        UINT                            numDynamicRootParams_       = 0;
+        INT                             constantsRootParamIndex_    = -1;
 
 };
 
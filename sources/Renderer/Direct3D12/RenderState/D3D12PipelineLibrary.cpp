@@ -0,0 +1,195 @@
+/*
+ * D3D12PipelineLibrary.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12PipelineLibrary.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Helper.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+template <typename T>
+static void AccumulateHashValue(std::uint64_t& hash, const T& value)
+{
+    AccumulateHash(hash, &value, sizeof(value));
+}
+
+static void AccumulateHashByteCode(std::uint64_t& hash, const D3D12_SHADER_BYTECODE& byteCode)
+{
+    AccumulateHashValue(hash, static_cast<std::uint64_t>(byteCode.BytecodeLength));
+    if (byteCode.pShaderBytecode != nullptr)
+        AccumulateHash(hash, byteCode.pShaderBytecode, byteCode.BytecodeLength);
+}
+
+/*
+Returns the name of the specified pipeline state within the library, i.e. the hash of all descriptor fields and shader byte codes.
+The root signature is not part of the name, since it is only known by pointer.
+A different root signature under the same name is rejected by LoadGraphicsPipeline, in which case the pipeline state is created without the library.
+*/
+static std::wstring GetGraphicsPipelineStateName(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    auto hash = g_hashOffsetBasis;
+
+    /* Hash shader byte codes */
+    AccumulateHashByteCode(hash, desc.VS);
+    AccumulateHashByteCode(hash, desc.PS);
+    AccumulateHashByteCode(hash, desc.DS);
+    AccumulateHashByteCode(hash, desc.HS);
+    AccumulateHashByteCode(hash, desc.GS);
+
+    /* Hash stream-output declaration */
+    for (UINT i = 0; i < desc.StreamOutput.NumEntries; ++i)
+    {
+        const auto& entry = desc.StreamOutput.pSODeclaration[i];
+        AccumulateHashValue(hash, entry.Stream);
+        AccumulateHash(hash, entry.SemanticName);
+        AccumulateHashValue(hash, entry.SemanticIndex);
+        AccumulateHashValue(hash, entry.StartComponent);
+        AccumulateHashValue(hash, entry.ComponentCount);
+        AccumulateHashValue(hash, entry.OutputSlot);
+    }
+    for (UINT i = 0; i < desc.StreamOutput.NumStrides; ++i)
+        AccumulateHashValue(hash, desc.StreamOutput.pBufferStrides[i]);
+    AccumulateHashValue(hash, desc.StreamOutput.RasterizedStream);
+
+    /* Hash fixed-function states */
+    AccumulateHashValue(hash, desc.BlendState);
+    AccumulateHashValue(hash, desc.SampleMask);
+    AccumulateHashValue(hash, desc.RasterizerState);
+    AccumulateHashValue(hash, desc.DepthStencilState);
+
+    /* Hash input layout */
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+    {
+        const auto& element = desc.InputLayout.pInputElementDescs[i];
+        AccumulateHash(hash, element.SemanticName);
+        AccumulateHashValue(hash, element.SemanticIndex);
+        AccumulateHashValue(hash, element.Format);
+        AccumulateHashValue(hash, element.InputSlot);
+        AccumulateHashValue(hash, element.AlignedByteOffset);
+        AccumulateHashValue(hash, element.InputSlotClass);
+        AccumulateHashValue(hash, element.InstanceDataStepRate);
+    }
+
+    /* Hash output formats and remaining states */
+    AccumulateHashValue(hash, desc.IBStripCutValue);
+    AccumulateHashValue(hash, desc.PrimitiveTopologyType);
+    AccumulateHashValue(hash, desc.NumRenderTargets);
+    AccumulateHashValue(hash, desc.RTVFormats);
+    AccumulateHashValue(hash, desc.DSVFormat);
+    AccumulateHashValue(hash, desc.SampleDesc);
+    AccumulateHashValue(hash, desc.NodeMask);
+    AccumulateHashValue(hash, desc.Flags);
+
+    /* Convert hash to hex string */
+    static const wchar_t* hexDigits = L"0123456789abcdef";
+    std::wstring name(16, L'0');
+    for (int i = 15; i >= 0; --i, hash >>= 4)
+        name[i] = hexDigits[hash & 0xf];
+
+    return name;
+}
+
+
+/*
+ * D3D12PipelineLibrary class
+ */
+
+void D3D12PipelineLibrary::Create(ID3D12Device* device)
+{
+    /* Pipeline libraries require ID3D12Device1 (Windows 10 Anniversary Update) */
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(device_.ReleaseAndGetAddressOf()))))
+        return;
+
+    /* Create empty pipeline library; this fails if the driver does not support pipeline libraries */
+    if (FAILED(device_->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(library_.ReleaseAndGetAddressOf()))))
+        device_.Reset();
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateGraphicsPipelineState(ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    ComPtr<ID3D12PipelineState> pipelineState;
+
+    if (library_)
+    {
+        const auto name = GetGraphicsPipelineStateName(desc);
+
+        std::lock_guard<std::mutex> guard { mutex_ };
+
+        /* Try to load pipeline state from library */
+        auto hr = library_->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        if (SUCCEEDED(hr))
+            return pipelineState;
+
+        /* Create new pipeline state and store it in the library, unless the name is already in use (E_INVALIDARG) */
+        hr = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 graphics pipeline state");
+
+        library_->StorePipeline(name.c_str(), pipelineState.Get());
+    }
+    else
+    {
+        auto hr = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 graphics pipeline state");
+    }
+
+    return pipelineState;
+}
+
+std::vector<char> D3D12PipelineLibrary::Serialize()
+{
+    std::vector<char> data;
+
+    if (library_)
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        data.resize(library_->GetSerializedSize());
+        if (!data.empty() && FAILED(library_->Serialize(data.data(), data.size())))
+            data.clear();
+    }
+
+    return data;
+}
+
+bool D3D12PipelineLibrary::Deserialize(const void* data, std::size_t dataSize)
+{
+    if (!device_ || data == nullptr || dataSize == 0)
+        return false;
+
+    /* Copy blob, since the library refers to it for its entire lifetime */
+    std::vector<char> libraryData(dataSize);
+    ::memcpy(libraryData.data(), data, dataSize);
+
+    /* Create library from blob; this fails if the blob was created with a different adapter or driver version */
+    ComPtr<ID3D12PipelineLibrary> library;
+    auto hr = device_->CreatePipelineLibrary(libraryData.data(), libraryData.size(), IID_PPV_ARGS(library.ReleaseAndGetAddressOf()));
+    if (FAILED(hr))
+        return false;
+
+    /* Replace previous library; pipeline states that have been created with it remain valid */
+    std::lock_guard<std::mutex> guard { mutex_ };
+    library_ = std::move(library);
+    libraryData_ = std::move(libraryData);
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
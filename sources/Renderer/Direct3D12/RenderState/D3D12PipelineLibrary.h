@@ -0,0 +1,66 @@
+/*
+ * D3D12PipelineLibrary.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_PIPELINE_LIBRARY_H
+#define LLGL_D3D12_PIPELINE_LIBRARY_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Wrapper for an ID3D12PipelineLibrary, which stores the compiled pipeline states across application runs.
+Each pipeline state is stored under the hash of its descriptor and shader byte codes.
+If the device does not support pipeline libraries (requires ID3D12Device1), all pipeline states are created without this cache.
+*/
+class D3D12PipelineLibrary
+{
+
+    public:
+
+        D3D12PipelineLibrary() = default;
+
+        D3D12PipelineLibrary(const D3D12PipelineLibrary&) = delete;
+        D3D12PipelineLibrary& operator = (const D3D12PipelineLibrary&) = delete;
+
+        // Creates an empty pipeline library for the specified device.
+        void Create(ID3D12Device* device);
+
+        // Loads the specified graphics pipeline state from the library, or creates and stores a new one. This function is thread-safe.
+        ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+        // Returns the serialized pipeline library, or an empty container if pipeline libraries are not supported.
+        std::vector<char> Serialize();
+
+        // Replaces the pipeline library with the specified serialized blob. Returns false if the blob is incompatible with the device or driver.
+        bool Deserialize(const void* data, std::size_t dataSize);
+
+    private:
+
+        ComPtr<ID3D12Device1>           device_;
+        ComPtr<ID3D12PipelineLibrary>   library_;
+        std::vector<char>               libraryData_;   // Serialized blob, which must outlive 'library_'
+        std::mutex                      mutex_;         // Guards 'library_', since pipeline states may be created on worker threads
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,158 @@
+/*
+ * D3D12QueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12QueryHeap.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static D3D12_QUERY_TYPE GetD3DQueryType(const QueryType type)
+{
+    /* Only 'SamplesPassed' requires the exact number of samples */
+    return (type == QueryType::SamplesPassed ? D3D12_QUERY_TYPE_OCCLUSION : D3D12_QUERY_TYPE_BINARY_OCCLUSION);
+}
+
+D3D12QueryHeap::D3D12QueryHeap(ID3D12Device* device, const QueryHeapDescriptor& desc) :
+    QueryHeap  { desc                       },
+    queryType_ { GetD3DQueryType(desc.type) }
+{
+    /* Create native query heap for all queries */
+    D3D12_QUERY_HEAP_DESC queryHeapDesc;
+    {
+        queryHeapDesc.Type      = D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+        queryHeapDesc.Count     = desc.numQueries;
+        queryHeapDesc.NodeMask  = 0;
+    }
+    auto hr = device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(queryHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 query heap");
+
+    /* Create readback buffer to retrieve the resolved results on the CPU */
+    hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(desc.numQueries * sizeof(UINT64)),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(readbackBuffer_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 readback buffer for query heap");
+
+    /* Create predication buffer to use the results as render conditions without any readback */
+    hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(desc.numQueries * sizeof(UINT64)),
+        D3D12_RESOURCE_STATE_PREDICATION,
+        nullptr,
+        IID_PPV_ARGS(predicationBuffer_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 predication buffer for query heap");
+}
+
+bool D3D12QueryHeap::MarkDirty(std::uint32_t query)
+{
+    if (dirtyBegin_ < dirtyEnd_)
+    {
+        dirtyBegin_ = std::min(dirtyBegin_, query);
+        dirtyEnd_   = std::max(dirtyEnd_, query + 1);
+        return false;
+    }
+    else
+    {
+        dirtyBegin_ = query;
+        dirtyEnd_   = query + 1;
+        return true;
+    }
+}
+
+void D3D12QueryHeap::ResolveDirtyRange(ID3D12GraphicsCommandList* commandList)
+{
+    if (dirtyBegin_ < dirtyEnd_)
+    {
+        /* Resolve dirty range into the same range of the readback buffer */
+        commandList->ResolveQueryData(
+            queryHeap_.Get(),
+            queryType_,
+            dirtyBegin_,
+            dirtyEnd_ - dirtyBegin_,
+            readbackBuffer_.Get(),
+            dirtyBegin_ * sizeof(UINT64)
+        );
+
+        /* Results must not be read before the command list has been submitted */
+        resolvedBegin_  = dirtyBegin_;
+        resolvedEnd_    = dirtyEnd_;
+        resolvePending_ = true;
+        fenceValue_     = UINT64_MAX;
+
+        dirtyBegin_     = 0;
+        dirtyEnd_       = 0;
+    }
+}
+
+void D3D12QueryHeap::SetFenceValue(UINT64 fenceValue)
+{
+    if (resolvePending_)
+    {
+        fenceValue_     = fenceValue;
+        resolvePending_ = false;
+    }
+}
+
+void D3D12QueryHeap::ResolvePredicate(ID3D12GraphicsCommandList* commandList, std::uint32_t query)
+{
+    /* Resolve query into predication buffer (the state is restored so the buffer never needs to be tracked) */
+    commandList->ResourceBarrier(
+        1, &CD3DX12_RESOURCE_BARRIER::Transition(predicationBuffer_.Get(), D3D12_RESOURCE_STATE_PREDICATION, D3D12_RESOURCE_STATE_COPY_DEST)
+    );
+
+    commandList->ResolveQueryData(queryHeap_.Get(), queryType_, query, 1, predicationBuffer_.Get(), query * sizeof(UINT64));
+
+    commandList->ResourceBarrier(
+        1, &CD3DX12_RESOURCE_BARRIER::Transition(predicationBuffer_.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PREDICATION)
+    );
+}
+
+bool D3D12QueryHeap::ReadResults(UINT64 completedFenceValue, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
+{
+    const auto lastQuery = firstQuery + numQueries;
+
+    /* Check if any query of the range has been ended but not resolved yet */
+    if (dirtyBegin_ < dirtyEnd_ && firstQuery < dirtyEnd_ && dirtyBegin_ < lastQuery)
+        return false;
+
+    /* Check if the GPU has finished the resolve of the range */
+    if (firstQuery < resolvedEnd_ && resolvedBegin_ < lastQuery && completedFenceValue < fenceValue_)
+        return false;
+
+    /* Map range from the readback buffer and copy results */
+    const D3D12_RANGE readRange { firstQuery * sizeof(UINT64), lastQuery * sizeof(UINT64) };
+
+    void* data = nullptr;
+    auto hr = readbackBuffer_->Map(0, &readRange, &data);
+    DXThrowIfFailed(hr, "failed to map D3D12 readback buffer for query heap");
+
+    ::memcpy(results, reinterpret_cast<const UINT64*>(data) + firstQuery, numQueries * sizeof(UINT64));
+
+    const D3D12_RANGE writtenRange { 0, 0 };
+    readbackBuffer_->Unmap(0, &writtenRange);
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
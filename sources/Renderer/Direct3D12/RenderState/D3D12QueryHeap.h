@@ -0,0 +1,89 @@
+/*
+ * D3D12QueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_QUERY_HEAP_H
+#define LLGL_D3D12_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Query heap with a readback buffer for the host results.
+Queries that have been ended are marked as dirty, and the command buffer resolves the dirty range into the readback buffer once per frame.
+The host results can be read as soon as the fence value of that frame has been reached.
+*/
+class D3D12QueryHeap final : public QueryHeap
+{
+
+    public:
+
+        D3D12QueryHeap(ID3D12Device* device, const QueryHeapDescriptor& desc);
+
+        // Marks the specified query as dirty, i.e. its result must be resolved before it can be read. Returns true if the heap was not dirty before.
+        bool MarkDirty(std::uint32_t query);
+
+        // Resolves the range of dirty queries into the readback buffer. The results are only valid after the next call to 'SetFenceValue'.
+        void ResolveDirtyRange(ID3D12GraphicsCommandList* commandList);
+
+        // Assigns the fence value after which the resolved results can be read.
+        void SetFenceValue(UINT64 fenceValue);
+
+        // Reads the results of the specified range from the readback buffer. Returns false if the results are not available yet.
+        bool ReadResults(UINT64 completedFenceValue, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results);
+
+        // Resolves the specified query into the predication buffer, which can then be used with 'SetPredication' at the offset 'query * sizeof(UINT64)'.
+        void ResolvePredicate(ID3D12GraphicsCommandList* commandList, std::uint32_t query);
+
+        // Returns the buffer for predicated rendering, i.e. render conditions.
+        inline ID3D12Resource* GetPredicationBuffer() const
+        {
+            return predicationBuffer_.Get();
+        }
+
+        inline ID3D12QueryHeap* GetNative() const
+        {
+            return queryHeap_.Get();
+        }
+
+        // Returns the query type for BeginQuery, EndQuery, and ResolveQueryData.
+        inline D3D12_QUERY_TYPE GetQueryType() const
+        {
+            return queryType_;
+        }
+
+    private:
+
+        ComPtr<ID3D12QueryHeap> queryHeap_;
+        ComPtr<ID3D12Resource>  readbackBuffer_;
+        ComPtr<ID3D12Resource>  predicationBuffer_;
+        D3D12_QUERY_TYPE        queryType_      = D3D12_QUERY_TYPE_OCCLUSION;
+
+        UINT                    dirtyBegin_     = 0;
+        UINT                    dirtyEnd_       = 0;
+        UINT                    resolvedBegin_  = 0;
+        UINT                    resolvedEnd_    = 0;
+        bool                    resolvePending_ = false;    // Specifies whether the resolved range awaits its fence value
+        UINT64                  fenceValue_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,29 @@
+/*
+ * D3D12RenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_RENDER_PASS_H
+#define LLGL_D3D12_RENDER_PASS_H
+
+
+#include "../../BasicRenderPass.h"
+
+
+namespace LLGL
+{
+
+
+using D3D12RenderPass = BasicRenderPass;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,32 +6,128 @@
  */
 
 #include "D3D12ResourceHeap.h"
-//#include "D3D12PipelineLayout.h"
+#include "D3D12PipelineLayout.h"
 #include "../Buffer/D3D12ConstantBuffer.h"
 #include "../Texture/D3D12Sampler.h"
 #include "../Texture/D3D12Texture.h"
+#include "D3D12AccelerationStructure.h"
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../CheckedCast.h"
 #include <LLGL/Resource.h>
 #include <functional>
+#include <algorithm>
+#include <utility>
 
 
 namespace LLGL
 {
 
 
-D3D12ResourceHeap::D3D12ResourceHeap(ID3D12Device* device, const ResourceHeapDescriptor& desc)
+D3D12ResourceHeap::D3D12ResourceHeap(ID3D12Device* device, const ResourceHeapDescriptor& desc) :
+    viewLocations_ { desc.resourceViews.size() }
 {
+    /* Collect constant buffers with dynamic offsets, which are bound as root CBVs instead of descriptors */
+    std::vector<bool> dynamicViews(desc.resourceViews.size(), false);
+    CollectDynamicConstantBuffers(desc, dynamicViews);
+
     /* Create descriptor heaps */
-    auto cpuDescHandleCbvSrvUav = CreateHeapTypeCbvSrvUav(device, desc);
-    auto cpuDescHandleSampler   = CreateHeapTypeSampler(device, desc);
+    cpuDescHandleCbvSrvUav_ = CreateHeapTypeCbvSrvUav(device, desc);
+    cpuDescHandleSampler_   = CreateHeapTypeSampler(device, desc);
+
+    auto cpuDescHandleCbvSrvUav = cpuDescHandleCbvSrvUav_;
+    auto cpuDescHandleSampler   = cpuDescHandleSampler_;
 
     /* Create descriptors */
-    CreateConstantBufferViews(device, cpuDescHandleCbvSrvUav, desc);
+    CreateConstantBufferViews(device, cpuDescHandleCbvSrvUav, desc, dynamicViews);
     CreateShaderResourceViews(device, cpuDescHandleCbvSrvUav, desc);
     CreateUnorderedAccessViews(device, cpuDescHandleCbvSrvUav, desc);
     CreateSamplers(device, cpuDescHandleSampler, desc);
+
+    /* Collect buffers and textures that must be resident when this resource heap is used */
+    CollectResidencyEntries(desc);
+
+    /* Store location of each descriptor for in-place updates */
+    BuildViewLocations(desc);
+}
+
+static D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleAt(D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, UINT index, UINT cpuDescStride)
+{
+    cpuDescHandle.ptr += static_cast<SIZE_T>(index) * cpuDescStride;
+    return cpuDescHandle;
+}
+
+void D3D12ResourceHeap::WriteResourceViews(ID3D12Device* device, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (static_cast<std::size_t>(firstDescriptor) + numResourceViews > viewLocations_.size())
+        throw std::out_of_range("resource views out of range for resource heap update");
+
+    UINT cpuDescStrideCbvSrvUav = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    UINT cpuDescStrideSampler   = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    for (std::uint32_t i = 0; i < numResourceViews; ++i)
+    {
+        auto resource = resourceViews[i].resource;
+        if (!resource)
+            throw std::invalid_argument("cannot write resource heap with null pointer in resource view");
+
+        /* Replacements must be of the same type, since the descriptor layout of the heap is fixed */
+        const auto& location = viewLocations_[firstDescriptor + i];
+        if (resource->QueryResourceType() != location.type)
+            throw std::invalid_argument("cannot write resource heap with mismatching resource type in resource view");
+
+        /* Re-create descriptor in its existing slot (the heaps are not shader-visible, so in-flight copies are not affected) */
+        switch (location.type)
+        {
+            case ResourceType::ConstantBuffer:
+            {
+                auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, *resource);
+                if (location.dynamic)
+                    dynamicBufferAddresses_[location.index] = constantBufferD3D.GetGPUVirtualAddress();
+                else
+                    constantBufferD3D.CreateResourceView(device, GetCPUDescriptorHandleAt(cpuDescHandleCbvSrvUav_, location.index, cpuDescStrideCbvSrvUav));
+                residencyEntries_[location.residencyIndex] = constantBufferD3D.GetResidencyEntry();
+            }
+            break;
+
+            case ResourceType::Texture:
+            {
+                auto& textureD3D = LLGL_CAST(D3D12Texture&, *resource);
+                textureD3D.CreateResourceView(device, GetCPUDescriptorHandleAt(cpuDescHandleCbvSrvUav_, location.index, cpuDescStrideCbvSrvUav));
+                residencyEntries_[location.residencyIndex] = textureD3D.GetResidencyEntry();
+            }
+            break;
+
+            #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+            case ResourceType::AccelerationStructure:
+            {
+                auto& accelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure&, *resource);
+                CreateAccelerationStructureView(device, GetCPUDescriptorHandleAt(cpuDescHandleCbvSrvUav_, location.index, cpuDescStrideCbvSrvUav), accelerationStructureD3D);
+            }
+            break;
+            #endif
+
+            case ResourceType::StorageBuffer:
+            {
+                /* Unordered access views are not created yet (see CreateUnorderedAccessViews), so only the residency is updated */
+                residencyEntries_[location.residencyIndex] = LLGL_CAST(D3D12Buffer&, *resource).GetResidencyEntry();
+            }
+            break;
+
+            case ResourceType::Sampler:
+            {
+                auto& samplerD3D = LLGL_CAST(D3D12Sampler&, *resource);
+                samplerD3D.CreateResourceView(device, GetCPUDescriptorHandleAt(cpuDescHandleSampler_, location.index, cpuDescStrideSampler));
+            }
+            break;
+
+            default:
+                break;
+        }
+    }
+
+    /* Invalidate descriptor tables that have been copied from this resource heap */
+    ++version_;
 }
 
 
@@ -44,6 +140,135 @@ static void ErrNullPointerInResource()
     throw std::invalid_argument("cannot create resource heap with null pointer in resource view");
 }
 
+void D3D12ResourceHeap::CollectResidencyEntries(const ResourceHeapDescriptor& desc)
+{
+    for (const auto& resourceView : desc.resourceViews)
+    {
+        if (auto resource = resourceView.resource)
+        {
+            switch (resource->QueryResourceType())
+            {
+                case ResourceType::ConstantBuffer:
+                case ResourceType::StorageBuffer:
+                    residencyEntries_.push_back(LLGL_CAST(D3D12Buffer&, *resource).GetResidencyEntry());
+                    break;
+                case ResourceType::Texture:
+                    residencyEntries_.push_back(LLGL_CAST(D3D12Texture&, *resource).GetResidencyEntry());
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void D3D12ResourceHeap::CollectDynamicConstantBuffers(const ResourceHeapDescriptor& desc, std::vector<bool>& dynamicViews)
+{
+    auto pipelineLayoutD3D = LLGL_CAST(D3D12PipelineLayout*, desc.pipelineLayout);
+    if (!pipelineLayoutD3D)
+        return;
+
+    firstDynamicRootParamIndex_ = pipelineLayoutD3D->GetFirstDynamicRootParamIndex();
+
+    /* Find resource views of all bindings with dynamic offsets (bindless bindings consume one view per array element) */
+    std::vector<std::pair<UINT, std::size_t>> dynamicBuffers;
+    std::size_t viewIndex = 0;
+
+    for (const auto& binding : pipelineLayoutD3D->GetBindings())
+    {
+        if (viewIndex >= desc.resourceViews.size())
+            break;
+
+        if ((binding.flags & BindingFlags::Bindless) != 0)
+            viewIndex += std::max(binding.arraySize, 1u);
+        else
+        {
+            if (binding.type == ResourceType::ConstantBuffer && (binding.flags & BindingFlags::DynamicOffset) != 0)
+            {
+                auto resource = desc.resourceViews[viewIndex].resource;
+                if (!resource)
+                    ErrNullPointerInResource();
+
+                dynamicBuffers.push_back({ binding.slot, viewIndex });
+                dynamicViews[viewIndex] = true;
+            }
+            ++viewIndex;
+        }
+    }
+
+    /* Store addresses in ascending order of their slots, which is the order of the root CBVs and the dynamic offsets */
+    std::sort(dynamicBuffers.begin(), dynamicBuffers.end());
+
+    dynamicBufferAddresses_.reserve(dynamicBuffers.size());
+    for (const auto& dynamicBuffer : dynamicBuffers)
+    {
+        auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, *desc.resourceViews[dynamicBuffer.second].resource);
+        viewLocations_[dynamicBuffer.second].dynamic    = true;
+        viewLocations_[dynamicBuffer.second].index      = static_cast<UINT>(dynamicBufferAddresses_.size());
+        dynamicBufferAddresses_.push_back(constantBufferD3D.GetGPUVirtualAddress());
+    }
+}
+
+void D3D12ResourceHeap::BuildViewLocations(const ResourceHeapDescriptor& desc)
+{
+    /* Determine number of CBVs and SRVs, which precede the UAVs in the CBV/SRV/UAV heap (acceleration structure SRVs follow the texture SRVs) */
+    UINT numCBVs = 0, numSRVs = 0, numAccelerationStructureSRVs = 0;
+
+    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
+    {
+        switch (desc.resourceViews[i].resource->QueryResourceType())
+        {
+            case ResourceType::ConstantBuffer:
+                if (!viewLocations_[i].dynamic)
+                    ++numCBVs;
+                break;
+            case ResourceType::Texture:
+                ++numSRVs;
+                break;
+            case ResourceType::AccelerationStructure:
+                ++numAccelerationStructureSRVs;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* Store descriptor index of each view in the same order as the descriptors have been created */
+    UINT cbvIndex = 0, srvIndex = numCBVs, accelerationStructureIndex = numCBVs + numSRVs, uavIndex = numCBVs + numSRVs + numAccelerationStructureSRVs, samplerIndex = 0;
+    std::size_t residencyIndex = 0;
+
+    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
+    {
+        auto& location = viewLocations_[i];
+        location.type = desc.resourceViews[i].resource->QueryResourceType();
+
+        switch (location.type)
+        {
+            case ResourceType::ConstantBuffer:
+                if (!location.dynamic)
+                    location.index = cbvIndex++;
+                location.residencyIndex = residencyIndex++;
+                break;
+            case ResourceType::Texture:
+                location.index = srvIndex++;
+                location.residencyIndex = residencyIndex++;
+                break;
+            case ResourceType::AccelerationStructure:
+                location.index = accelerationStructureIndex++;
+                break;
+            case ResourceType::StorageBuffer:
+                location.index = uavIndex++;
+                location.residencyIndex = residencyIndex++;
+                break;
+            case ResourceType::Sampler:
+                location.index = samplerIndex++;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeCbvSrvUav(ID3D12Device* device, const ResourceHeapDescriptor& desc)
 {
     /* Determine number of view descriptors */
@@ -55,9 +280,10 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeCbvSrvUav(ID3D12Dev
         {
             switch (resource->QueryResourceType())
             {
-                case ResourceType::ConstantBuffer:  // CBV
-                case ResourceType::Texture:         // SRV
-                case ResourceType::StorageBuffer:   // UAV
+                case ResourceType::ConstantBuffer:          // CBV
+                case ResourceType::Texture:                 // SRV
+                case ResourceType::AccelerationStructure:   // SRV
+                case ResourceType::StorageBuffer:           // UAV
                     ++numDescriptors;
                     break;
                 default:
@@ -68,14 +294,17 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeCbvSrvUav(ID3D12Dev
             ErrNullPointerInResource();
     }
 
+    /* Constant buffers with dynamic offsets are bound as root CBVs */
+    numDescriptors -= static_cast<UINT>(dynamicBufferAddresses_.size());
+
     if (numDescriptors > 0)
     {
-        /* Create descriptor heap for views (CBV, SRV, UAV) */
+        /* Create non-shader-visible descriptor heap for views (CBV, SRV, UAV) */
         D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
         {
             heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
             heapDesc.NumDescriptors = numDescriptors;
-            heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+            heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
             heapDesc.NodeMask       = 0;
         }
         auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(heapTypeCbvSrvUav_.ReleaseAndGetAddressOf()));
@@ -85,8 +314,7 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeCbvSrvUav(ID3D12Dev
         heapTypeCbvSrvUav_->SetName(L"LLGL::D3D12ResourceHeap::heapTypeCbvSrvUav");
         #endif
 
-        /* Store in array for quick access */
-        AppendDescriptorHeapToArray(heapTypeCbvSrvUav_.Get());
+        numDescriptorsCbvSrvUav_ = numDescriptors;
 
         return heapTypeCbvSrvUav_->GetCPUDescriptorHandleForHeapStart();
     }
@@ -118,12 +346,12 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeSampler(ID3D12Devic
 
     if (numDescriptors > 0)
     {
-        /* Create descriptor heap for samplers */
+        /* Create non-shader-visible descriptor heap for samplers */
         D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
         {
             heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
             heapDesc.NumDescriptors = numDescriptors;
-            heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+            heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
             heapDesc.NodeMask       = 0;
         }
         auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(heapTypeSampler_.ReleaseAndGetAddressOf()));
@@ -133,8 +361,7 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeSampler(ID3D12Devic
         heapTypeSampler_->SetName(L"LLGL::D3D12ResourceHeap::heapTypeSampler");
         #endif
 
-        /* Store in array for quick access */
-        AppendDescriptorHeapToArray(heapTypeSampler_.Get());
+        numDescriptorsSampler_ = numDescriptors;
 
         return heapTypeSampler_->GetCPUDescriptorHandleForHeapStart();
     }
@@ -145,19 +372,20 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12ResourceHeap::CreateHeapTypeSampler(ID3D12Devic
 static void ForEachResourceViewOfType(
     const ResourceHeapDescriptor&                   desc,
     const ResourceType                              resourceType,
-    const std::function<void(Resource& resource)>&  callback)
+    const std::function<void(Resource& resource)>&  callback,
+    const std::vector<bool>*                        ignoredViews = nullptr)
 {
-    for (const auto& resourceView : desc.resourceViews)
+    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
     {
-        if (auto resource = resourceView.resource)
+        if (auto resource = desc.resourceViews[i].resource)
         {
-            if (resource->QueryResourceType() == resourceType)
+            if (resource->QueryResourceType() == resourceType && (ignoredViews == nullptr || !(*ignoredViews)[i]))
                 callback(*resource);
         }
     }
 }
 
-void D3D12ResourceHeap::CreateConstantBufferViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc)
+void D3D12ResourceHeap::CreateConstantBufferViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc, const std::vector<bool>& dynamicViews)
 {
     UINT cpuDescStride = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
@@ -168,7 +396,8 @@ void D3D12ResourceHeap::CreateConstantBufferViews(ID3D12Device* device, D3D12_CP
             auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, resource);
             constantBufferD3D.CreateResourceView(device, cpuDescHandle);
             cpuDescHandle.ptr += cpuDescStride;
-        }
+        },
+        &dynamicViews
     );
 }
 
@@ -185,8 +414,37 @@ void D3D12ResourceHeap::CreateShaderResourceViews(ID3D12Device* device, D3D12_CP
             cpuDescHandle.ptr += cpuDescStride;
         }
     );
+
+    #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+    ForEachResourceViewOfType(
+        desc, ResourceType::AccelerationStructure,
+        [&](Resource& resource)
+        {
+            auto& accelerationStructureD3D = LLGL_CAST(D3D12AccelerationStructure&, resource);
+            CreateAccelerationStructureView(device, cpuDescHandle, accelerationStructureD3D);
+            cpuDescHandle.ptr += cpuDescStride;
+        }
+    );
+    #endif
 }
 
+#ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
+void D3D12ResourceHeap::CreateAccelerationStructureView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const D3D12AccelerationStructure& accelerationStructureD3D)
+{
+    /* Acceleration structure SRVs refer to the GPU virtual address only, so no resource is passed */
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                                      = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
+        srvDesc.Shader4ComponentMapping                     = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.RaytracingAccelerationStructure.Location    = accelerationStructureD3D.GetGPUVirtualAddress();
+    }
+    device->CreateShaderResourceView(nullptr, &srvDesc, cpuDescHandle);
+}
+
+#endif // /__ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+
 void D3D12ResourceHeap::CreateUnorderedAccessViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc)
 {
     //TODO
@@ -207,11 +465,6 @@ void D3D12ResourceHeap::CreateSamplers(ID3D12Device* device, D3D12_CPU_DESCRIPTO
     );
 }
 
-void D3D12ResourceHeap::AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap)
-{
-    descriptorHeaps_[numDescriptorHeaps_++] = descriptorHeap;
-}
-
 
 } // /namespace LLGL
 
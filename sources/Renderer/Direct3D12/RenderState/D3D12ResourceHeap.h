@@ -11,13 +11,17 @@
 
 #include <LLGL/ResourceHeap.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../D3D12ResidencyManager.h"
 #include <d3d12.h>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class D3D12AccelerationStructure;
+
 class D3D12ResourceHeap final : public ResourceHeap
 {
 
@@ -25,33 +29,102 @@ class D3D12ResourceHeap final : public ResourceHeap
 
         D3D12ResourceHeap(ID3D12Device* device, const ResourceHeapDescriptor& desc);
 
-        inline ID3D12DescriptorHeap* const* GetDescriptorHeaps() const
+        // Re-creates the descriptors of the specified resource views in place, starting at the view with index 'firstDescriptor'.
+        void WriteResourceViews(ID3D12Device* device, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews);
+
+        // Returns the first CPU descriptor handle of the non-shader-visible CBV/SRV/UAV heap.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleCbvSrvUav() const
+        {
+            return cpuDescHandleCbvSrvUav_;
+        }
+
+        // Returns the first CPU descriptor handle of the non-shader-visible sampler heap.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleSampler() const
+        {
+            return cpuDescHandleSampler_;
+        }
+
+        // Returns the number of CBV, SRV, and UAV descriptors.
+        inline UINT GetNumDescriptorsCbvSrvUav() const
+        {
+            return numDescriptorsCbvSrvUav_;
+        }
+
+        // Returns the number of sampler descriptors.
+        inline UINT GetNumDescriptorsSampler() const
+        {
+            return numDescriptorsSampler_;
+        }
+
+        // Returns the root parameter index of the first root CBV for the constant buffers with dynamic offsets.
+        inline UINT GetFirstDynamicRootParamIndex() const
+        {
+            return firstDynamicRootParamIndex_;
+        }
+
+        // Returns the GPU virtual addresses of the constant buffers with dynamic offsets (in ascending order of their binding slots).
+        inline const std::vector<D3D12_GPU_VIRTUAL_ADDRESS>& GetDynamicBufferAddresses() const
+        {
+            return dynamicBufferAddresses_;
+        }
+
+        // Returns the residency entries of all buffers and textures this resource heap refers to.
+        inline const std::vector<D3D12ResidencyEntry*>& GetResidencyEntries() const
         {
-            return descriptorHeaps_;
+            return residencyEntries_;
         }
 
-        inline UINT GetNumDescriptorHeaps() const
+        // Returns the version of this resource heap, which is incremented with every call to 'WriteResourceViews'.
+        inline std::uint32_t GetVersion() const
         {
-            return numDescriptorHeaps_;
+            return version_;
         }
 
     private:
 
+        // Location of a resource view within this resource heap.
+        struct D3D12ResourceViewLocation
+        {
+            ResourceType    type            = ResourceType::Undefined;
+            UINT            index           = 0;        // Descriptor index within its heap, or index into 'dynamicBufferAddresses_'
+            bool            dynamic         = false;    // Constant buffer with dynamic offset, i.e. a root CBV
+            std::size_t     residencyIndex  = 0;        // Index into 'residencyEntries_' (for buffers and textures only)
+        };
+
+        void CollectResidencyEntries(const ResourceHeapDescriptor& desc);
+        void CollectDynamicConstantBuffers(const ResourceHeapDescriptor& desc, std::vector<bool>& dynamicViews);
+        void BuildViewLocations(const ResourceHeapDescriptor& desc);
+
         D3D12_CPU_DESCRIPTOR_HANDLE CreateHeapTypeCbvSrvUav(ID3D12Device* device, const ResourceHeapDescriptor& desc);
         D3D12_CPU_DESCRIPTOR_HANDLE CreateHeapTypeSampler(ID3D12Device* device, const ResourceHeapDescriptor& desc);
 
-        void CreateConstantBufferViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc);
+        void CreateConstantBufferViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc, const std::vector<bool>& dynamicViews);
         void CreateShaderResourceViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc);
         void CreateUnorderedAccessViews(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc);
         void CreateSamplers(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, const ResourceHeapDescriptor& desc);
 
-        void AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap);
+        #ifdef __ID3D12GraphicsCommandList4_INTERFACE_DEFINED__
+        void CreateAccelerationStructureView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const D3D12AccelerationStructure& accelerationStructureD3D);
+        #endif
 
+        // Non-shader-visible heaps, which are copied into the global descriptor heap rings when they are bound.
         ComPtr<ID3D12DescriptorHeap>    heapTypeCbvSrvUav_;
         ComPtr<ID3D12DescriptorHeap>    heapTypeSampler_;
 
-        ID3D12DescriptorHeap*           descriptorHeaps_[2] = {};   // References to the ComPtr objects
-        UINT                            numDescriptorHeaps_ = 0;
+        D3D12_CPU_DESCRIPTOR_HANDLE     cpuDescHandleCbvSrvUav_     = {};
+        D3D12_CPU_DESCRIPTOR_HANDLE     cpuDescHandleSampler_       = {};
+        UINT                            numDescriptorsCbvSrvUav_    = 0;
+        UINT                            numDescriptorsSampler_      = 0;
+
+        // Root CBVs of the constant buffers with dynamic offsets, which are not part of the descriptor heap.
+        UINT                                    firstDynamicRootParamIndex_ = 0;
+        std::vector<D3D12_GPU_VIRTUAL_ADDRESS>  dynamicBufferAddresses_;
+
+        // Residency entries of the referenced resources, which must be resident whenever this resource heap is used.
+        std::vector<D3D12ResidencyEntry*>       residencyEntries_;
+
+        std::vector<D3D12ResourceViewLocation>  viewLocations_;     // Location of each resource view in the order of 'ResourceHeapDescriptor::resourceViews'
+        std::uint32_t                           version_            = 0;
 
 };
 
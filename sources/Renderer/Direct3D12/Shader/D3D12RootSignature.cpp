@@ -17,6 +17,7 @@ void D3D12RootSignature::Reset(UINT maxNumRootParamters, UINT maxNumStaticSample
 {
     nativeRootParams_.reserve(maxNumRootParamters);
     rootParams_.reserve(maxNumRootParamters);
+    staticSamplers_.reserve(maxNumStaticSamplers);
 }
 
 void D3D12RootSignature::ResetAndAlloc(UINT maxNumRootParamters, UINT maxNumStaticSamplers)
@@ -45,6 +46,11 @@ D3D12RootParameter* D3D12RootSignature::FindCompatibleRootParameter(D3D12_DESCRI
     return nullptr;
 }
 
+void D3D12RootSignature::AppendStaticSampler(const D3D12_STATIC_SAMPLER_DESC& samplerDesc)
+{
+    staticSamplers_.push_back(samplerDesc);
+}
+
 static ComPtr<ID3DBlob> DXSerializeRootSignature(
     const D3D12_ROOT_SIGNATURE_DESC& signatureDesc,
     const D3D_ROOT_SIGNATURE_VERSION signatureversion)
@@ -97,13 +103,68 @@ ComPtr<ID3D12RootSignature> D3D12RootSignature::Finalize(ID3D12Device* device, D
     {
         signatureDesc.NumParameters     = static_cast<UINT>(nativeRootParams_.size());
         signatureDesc.pParameters       = nativeRootParams_.data();
-        signatureDesc.NumStaticSamplers = 0;
-        signatureDesc.pStaticSamplers   = nullptr;
+        signatureDesc.NumStaticSamplers = static_cast<UINT>(staticSamplers_.size());
+        signatureDesc.pStaticSamplers   = (staticSamplers_.empty() ? nullptr : staticSamplers_.data());
         signatureDesc.Flags             = flags;
     }
     return DXCreateRootSignature(device, signatureDesc);
 }
 
+ComPtr<ID3D12RootSignature> D3D12RootSignature::Finalize(ID3D12Device* device, D3D12RootSignatureCache& cache, D3D12_ROOT_SIGNATURE_FLAGS flags)
+{
+    D3D12_ROOT_SIGNATURE_DESC signatureDesc;
+    {
+        signatureDesc.NumParameters     = static_cast<UINT>(nativeRootParams_.size());
+        signatureDesc.pParameters       = nativeRootParams_.data();
+        signatureDesc.NumStaticSamplers = static_cast<UINT>(staticSamplers_.size());
+        signatureDesc.pStaticSamplers   = (staticSamplers_.empty() ? nullptr : staticSamplers_.data());
+        signatureDesc.Flags             = flags;
+    }
+    auto signature = DXSerializeRootSignature(signatureDesc, D3D_ROOT_SIGNATURE_VERSION_1);
+    return cache.GetOrCreate(device, signature.Get());
+}
+
+
+/* ----- D3D12RootSignatureCache ----- */
+
+ComPtr<ID3D12RootSignature> D3D12RootSignatureCache::GetOrCreate(ID3D12Device* device, ID3DBlob* signatureBlob)
+{
+    /* Find root signature with the same serialized blob (the key is hashed by the map) */
+    std::string key(
+        reinterpret_cast<const char*>(signatureBlob->GetBufferPointer()),
+        static_cast<std::size_t>(signatureBlob->GetBufferSize())
+    );
+
+    auto& rootSignature = rootSignatures_[key];
+
+    if (!rootSignature)
+    {
+        /* Create new root signature from serialized blob */
+        auto hr = device->CreateRootSignature(
+            0,
+            signatureBlob->GetBufferPointer(),
+            signatureBlob->GetBufferSize(),
+            IID_PPV_ARGS(rootSignature.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfFailed(hr, "failed to create D3D12 root signature");
+    }
+
+    return rootSignature;
+}
+
+void D3D12RootSignatureCache::ReleaseUnused()
+{
+    for (auto it = rootSignatures_.begin(); it != rootSignatures_.end();)
+    {
+        /* Determine current reference count, which is 1 if only this cache refers to the root signature */
+        it->second->AddRef();
+        if (it->second->Release() == 1)
+            it = rootSignatures_.erase(it);
+        else
+            ++it;
+    }
+}
+
 
 } // /namespace LLGL
 
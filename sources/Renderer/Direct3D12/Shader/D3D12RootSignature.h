@@ -13,12 +13,16 @@
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <vector>
+#include <string>
+#include <unordered_map>
 
 
 namespace LLGL
 {
 
 
+class D3D12RootSignatureCache;
+
 // Helper class to manage a root parameter of a root signature
 class D3D12RootSignature
 {
@@ -31,8 +35,14 @@ class D3D12RootSignature
         D3D12RootParameter* AppendRootParameter();
         D3D12RootParameter* FindCompatibleRootParameter(D3D12_DESCRIPTOR_RANGE_TYPE rangeType);
 
+        // Appends a static sampler, which is baked into the root signature and doesn't occupy a root parameter.
+        void AppendStaticSampler(const D3D12_STATIC_SAMPLER_DESC& samplerDesc);
+
         ComPtr<ID3D12RootSignature> Finalize(ID3D12Device* device, D3D12_ROOT_SIGNATURE_FLAGS flags = D3D12_ROOT_SIGNATURE_FLAG_NONE);
 
+        // Finalizes the root signature and shares it with all previous root signatures of the cache that have the same serialized blob.
+        ComPtr<ID3D12RootSignature> Finalize(ID3D12Device* device, D3D12RootSignatureCache& cache, D3D12_ROOT_SIGNATURE_FLAGS flags = D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
         inline const D3D12RootParameter& operator [] (std::size_t idx) const
         {
             return rootParams_[idx];
@@ -43,10 +53,38 @@ class D3D12RootSignature
             return rootParams_[idx];
         }
 
+        // Returns the number of root parameters that have been appended so far.
+        inline UINT GetNumRootParameters() const
+        {
+            return static_cast<UINT>(rootParams_.size());
+        }
+
+    private:
+
+        std::vector<D3D12_ROOT_PARAMETER>       nativeRootParams_;
+        std::vector<D3D12RootParameter>         rootParams_;
+        std::vector<D3D12_STATIC_SAMPLER_DESC>  staticSamplers_;
+
+};
+
+/*
+Cache of root signatures that are keyed by their serialized blob, so all pipeline layouts with identical root parameters share one ID3D12RootSignature.
+This allows the command buffer to skip 'SetGraphicsRootSignature' and the re-binding of root arguments when pipelines are switched.
+*/
+class D3D12RootSignatureCache
+{
+
+    public:
+
+        // Returns the shared root signature for the specified serialized blob, or creates a new one.
+        ComPtr<ID3D12RootSignature> GetOrCreate(ID3D12Device* device, ID3DBlob* signatureBlob);
+
+        // Releases all root signatures that are no longer referenced outside of this cache.
+        void ReleaseUnused();
+
     private:
 
-        std::vector<D3D12_ROOT_PARAMETER>   nativeRootParams_;
-        std::vector<D3D12RootParameter>     rootParams_;
+        std::unordered_map<std::string, ComPtr<ID3D12RootSignature>> rootSignatures_;
 
 };
 
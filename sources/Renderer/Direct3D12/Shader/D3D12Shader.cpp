@@ -8,7 +8,9 @@
 #include "D3D12Shader.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include "../../DXCommon/DXShaderCache.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/TaskQueue.h"
 #include <algorithm>
 #include <stdexcept>
 #include <d3dcompiler.h>
@@ -18,20 +20,29 @@ namespace LLGL
 {
 
 
-D3D12Shader::D3D12Shader(const ShaderDescriptor& desc) :
+D3D12Shader::D3D12Shader(const ShaderDescriptor& desc, const std::string& cacheDirectory) :
     Shader { desc.type }
 {
-    if (!Build(desc))
+    if (!Build(desc, cacheDirectory))
         hasErrors_ = true;
 }
 
+D3D12Shader::~D3D12Shader()
+{
+    /* Asynchronous compilation refers to this object, so it must finish first */
+    if (compileTask_.valid())
+        compileTask_.wait();
+}
+
 bool D3D12Shader::HasErrors() const
 {
+    WaitForCompilation();
     return hasErrors_;
 }
 
 std::string D3D12Shader::Disassemble(int flags)
 {
+    WaitForCompilation();
     if (!byteCode_.empty())
     {
         ComPtr<ID3DBlob> disasm;
@@ -46,11 +57,14 @@ std::string D3D12Shader::Disassemble(int flags)
 
 std::string D3D12Shader::QueryInfoLog()
 {
+    WaitForCompilation();
     return (errors_.Get() != nullptr ? DXGetBlobString(errors_.Get()) : "");
 }
 
 D3D12_SHADER_BYTECODE D3D12Shader::GetByteCode() const
 {
+    WaitForCompilation();
+
     D3D12_SHADER_BYTECODE byteCode;
 
     byteCode.pShaderBytecode    = byteCode_.data();
@@ -61,25 +75,42 @@ D3D12_SHADER_BYTECODE D3D12Shader::GetByteCode() const
 
 void D3D12Shader::Reflect(ShaderReflectionDescriptor& reflectionDesc) const
 {
+    WaitForCompilation();
     if (!byteCode_.empty())
         ReflectShaderByteCode(reflectionDesc);
 }
 
+bool D3D12Shader::IsCompiled() const
+{
+    return IsFutureReady(compileTask_);
+}
+
+void D3D12Shader::WaitForCompilation() const
+{
+    if (compileTask_.valid())
+        compileTask_.get();
+}
+
 
 /*
  * ======= Private: =======
  */
 
-bool D3D12Shader::Build(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::Build(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(shaderDesc);
+    {
+        if ((shaderDesc.flags & ShaderCompileFlags::Async) != 0)
+            return CompileSourceAsync(shaderDesc, cacheDirectory);
+        else
+            return CompileSource(shaderDesc, cacheDirectory);
+    }
     else
         return LoadBinary(shaderDesc);
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
 {
     /* Get source code */
     std::string fileContent;
@@ -98,11 +129,22 @@ bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
         sourceLength    = shaderDesc.sourceSize;
     }
 
+    /* Try to load byte code from shader cache */
+    const auto cacheFilename = DXGetShaderCacheFilename(cacheDirectory, shaderDesc, sourceCode, sourceLength);
+    if (!cacheFilename.empty() && DXLoadShaderCacheEntry(cacheFilename, byteCode_))
+        return true;
+
     /* Get parameter from union */
     const char* entry   = shaderDesc.entryPoint;
     const char* target  = (shaderDesc.profile != nullptr ? shaderDesc.profile : "");
     auto        flags   = shaderDesc.flags;
 
+    /* Define named specialization constants as macros */
+    std::vector<std::string>        macroValues;
+    std::vector<D3D_SHADER_MACRO>   macros;
+    DXGetSpecializationMacros(shaderDesc.specializationConstants, macroValues, macros);
+    const D3D_SHADER_MACRO* defines = (macros.empty() ? nullptr : macros.data());
+
     /* Compile shader code */
     ComPtr<ID3DBlob> code;
 
@@ -110,7 +152,7 @@ bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
         sourceCode,
         sourceLength,
         nullptr,                            // LPCSTR               pSourceName
-        nullptr,                            // D3D_SHADER_MACRO*    pDefines
+        defines,                            // D3D_SHADER_MACRO*    pDefines
         nullptr,                            // ID3DInclude*         pInclude
         entry,                              // LPCSTR               pEntrypoint
         target,                             // LPCSTR               pTarget
@@ -122,12 +164,34 @@ bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
 
     /* Get byte code from blob */
     if (code)
+    {
         byteCode_ = DXGetBlobData(code.Get());
 
+        /* Store byte code in shader cache */
+        if (!cacheFilename.empty() && !FAILED(hr))
+            DXStoreShaderCacheEntry(cacheFilename, byteCode_);
+    }
+
     /* Store if compilation was successful */
     return !FAILED(hr);
 }
 
+bool D3D12Shader::CompileSourceAsync(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory)
+{
+    /* Copy shader descriptor, since it is only valid during this call */
+    auto ownedShaderDesc = std::make_shared<DXOwnedShaderDescriptor>(shaderDesc);
+
+    compileTask_ = TaskQueue::Get().Enqueue(
+        [this, ownedShaderDesc, cacheDirectory]()
+        {
+            if (!CompileSource(ownedShaderDesc->Get(), cacheDirectory))
+                hasErrors_ = true;
+        }
+    );
+
+    return true;
+}
+
 bool D3D12Shader::LoadBinary(const ShaderDescriptor& shaderDesc)
 {
     if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
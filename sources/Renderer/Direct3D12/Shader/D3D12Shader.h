@@ -15,6 +15,8 @@
 #include <LLGL/BufferFlags.h>
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
+#include <string>
+#include <future>
 #include <d3d12.h>
 
 
@@ -27,7 +29,9 @@ class D3D12Shader final : public Shader
 
     public:
 
-        D3D12Shader(const ShaderDescriptor& desc);
+        // Constructs the shader and uses the specified on-disk shader cache if the directory is not empty.
+        D3D12Shader(const ShaderDescriptor& desc, const std::string& cacheDirectory = "");
+        ~D3D12Shader();
 
         bool HasErrors() const override;
 
@@ -41,10 +45,17 @@ class D3D12Shader final : public Shader
 
         void Reflect(ShaderReflectionDescriptor& reflectionDesc) const;
 
+        // Returns true if the shader is not compiled asynchronously, or if its compilation has finished.
+        bool IsCompiled() const;
+
+        // Blocks until the asynchronous compilation has finished, and rethrows its exceptions.
+        void WaitForCompilation() const;
+
     private:
 
-        bool Build(const ShaderDescriptor& shaderDesc);
-        bool CompileSource(const ShaderDescriptor& shaderDesc);
+        bool Build(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
+        bool CompileSource(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
+        bool CompileSourceAsync(const ShaderDescriptor& shaderDesc, const std::string& cacheDirectory);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
         void ReflectShaderByteCode(ShaderReflectionDescriptor& reflectionDesc) const;
@@ -53,6 +64,8 @@ class D3D12Shader final : public Shader
         ComPtr<ID3DBlob>    errors_;
         bool                hasErrors_  = false;
 
+        std::shared_future<void> compileTask_;  // Only valid for ShaderCompileFlags::Async
+
 };
 
 
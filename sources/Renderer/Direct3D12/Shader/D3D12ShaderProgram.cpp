@@ -10,6 +10,7 @@
 #include "../D3D12Types.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/TaskQueue.h"
 #include <LLGL/Log.h>
 #include <LLGL/VertexFormat.h>
 #include <algorithm>
@@ -35,22 +36,41 @@ D3D12ShaderProgram::D3D12ShaderProgram(const ShaderProgramDescriptor& desc)
     Attach(ps_, desc.fragmentShader);
     Attach(cs_, desc.computeShader);
     BuildInputLayout(desc.vertexFormats.size(), desc.vertexFormats.data());
-    Link();
+
+    /* Link program after the asynchronous shader compilation */
+    if (HasPendingShaders())
+        linkTask_ = TaskQueue::Get().Enqueue([this]() { Link(); });
+    else
+        Link();
+}
+
+D3D12ShaderProgram::~D3D12ShaderProgram()
+{
+    /* Asynchronous linking refers to this object, so it must finish first */
+    if (linkTask_.valid())
+        linkTask_.wait();
 }
 
 bool D3D12ShaderProgram::HasErrors() const
 {
+    WaitForLink();
     return (linkError_ != LinkError::NoError);
 }
 
 std::string D3D12ShaderProgram::QueryInfoLog()
 {
+    WaitForLink();
     if (auto s = ShaderProgram::LinkErrorToString(linkError_))
         return s;
     else
         return "";
 }
 
+bool D3D12ShaderProgram::IsReady() const
+{
+    return IsFutureReady(linkTask_);
+}
+
 ShaderReflectionDescriptor D3D12ShaderProgram::QueryReflectionDesc() const
 {
     ShaderReflectionDescriptor reflection;
@@ -176,6 +196,22 @@ void D3D12ShaderProgram::Link()
         linkError_ = LinkError::InvalidComposition;
 }
 
+bool D3D12ShaderProgram::HasPendingShaders() const
+{
+    for (auto shader : shaders_)
+    {
+        if (shader != nullptr && !shader->IsCompiled())
+            return true;
+    }
+    return false;
+}
+
+void D3D12ShaderProgram::WaitForLink() const
+{
+    if (linkTask_.valid())
+        linkTask_.get();
+}
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,7 @@
 #include <LLGL/ShaderProgram.h>
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
+#include <future>
 #include <d3d12.h>
 
 
@@ -27,11 +28,14 @@ class D3D12ShaderProgram final : public ShaderProgram
     public:
 
         D3D12ShaderProgram(const ShaderProgramDescriptor& desc);
+        ~D3D12ShaderProgram();
 
         bool HasErrors() const override;
 
         std::string QueryInfoLog() override;
 
+        bool IsReady() const override;
+
         ShaderReflectionDescriptor QueryReflectionDesc() const override;
 
         void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
@@ -56,6 +60,11 @@ class D3D12ShaderProgram final : public ShaderProgram
         void BuildInputLayout(std::size_t numVertexFormats, const VertexFormat* vertexFormats);
         void Link();
 
+        bool HasPendingShaders() const;
+
+        // Blocks until the asynchronous linking has finished, and rethrows its exceptions.
+        void WaitForLink() const;
+
         std::vector<D3D12_INPUT_ELEMENT_DESC>   inputElements_;
         std::vector<std::string>                inputElementNames_; // custom string container to hold valid string pointers.
 
@@ -75,6 +84,8 @@ class D3D12ShaderProgram final : public ShaderProgram
 
         LinkError                               linkError_  = LinkError::NoError;
 
+        std::shared_future<void>                linkTask_;  // Only valid if any shader is compiled asynchronously
+
 };
 
 
@@ -0,0 +1,319 @@
+/*
+ * D3D12ImageConverter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ImageConverter.h"
+#include "D3D12Texture.h"
+#include "../D3D12RenderSystem.h"
+#include "../D3D12BarrierBatch.h"
+#include "../D3D12UploadHeap.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../MipChain.h"
+#include <d3dcompiler.h>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Number of descriptors per dispatch: one SRV for the source image data and one UAV for the destination MIP level
+static const UINT g_numDescriptorsPerDispatch = 2;
+
+// Number of descriptors in the ring of the image converter
+static const UINT g_numDescriptors = 256;
+
+// Number of threads in X and Y dimension of each thread group
+static const UINT g_threadGroupSize = 8;
+
+/*
+Each thread reads the components of one pixel from the raw source data (8 bits per component, not aligned to 4 bytes),
+and writes them into the RGBA channels of the texture as specified by the channel order (2 bits per component).
+Missing channels are initialized to (0, 0, 0, 1) like in 'ConvertImageBuffer'.
+sRGB textures are written through UNORM views, so the source data is stored without any color space conversion.
+*/
+static const char* g_imageConverterShaderSource = R"(
+cbuffer Constants : register(b0)
+{
+    uint    SrcOffset;
+    uint    SrcRowPitch;
+    uint    SrcSlicePitch;
+    uint    NumComponents;
+    uint    ChannelOrder;
+    uint    Width;
+    uint    Height;
+};
+
+ByteAddressBuffer           SrcData : register(t0);
+RWTexture2DArray<float4>    DstMip  : register(u0);
+
+uint LoadByte(uint addr)
+{
+    uint word = SrcData.Load(addr & ~3u);
+    return ((word >> ((addr & 3u) * 8u)) & 0xFFu);
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dtid : SV_DispatchThreadID)
+{
+    if (dtid.x >= Width || dtid.y >= Height)
+        return;
+
+    uint addr = SrcOffset + dtid.z * SrcSlicePitch + dtid.y * SrcRowPitch + dtid.x * NumComponents;
+
+    float color[4] = { 0.0, 0.0, 0.0, 1.0 };
+    for (uint i = 0; i < NumComponents; ++i)
+        color[(ChannelOrder >> (i * 2u)) & 3u] = (float)LoadByte(addr + i) / 255.0;
+
+    DstMip[dtid] = float4(color[0], color[1], color[2], color[3]);
+}
+)";
+
+// Root constants of the image conversion shader
+struct D3D12ImageConverterConstants
+{
+    UINT srcOffset;
+    UINT srcRowPitch;
+    UINT srcSlicePitch;
+    UINT numComponents;
+    UINT channelOrder;
+    UINT width;
+    UINT height;
+};
+
+D3D12ImageConverter::D3D12ImageConverter(D3D12RenderSystem& renderSystem) :
+    device_         { renderSystem.GetDevice()                                                },
+    descriptorRing_ { renderSystem, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, g_numDescriptors }
+{
+    CreateRootSignature(device_);
+    CreatePipelineState(device_);
+}
+
+// Returns the RGBA channel order (2 bits per component) of the specified color format, or ~0 if the format is not supported.
+static UINT GetImageFormatChannelOrder(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R:    return 0x00;    // R
+        case ImageFormat::RG:   return 0x04;    // R, G
+        case ImageFormat::RGB:  return 0x24;    // R, G, B
+        case ImageFormat::BGR:  return 0x06;    // B, G, R
+        case ImageFormat::RGBA: return 0xE4;    // R, G, B, A
+        case ImageFormat::BGRA: return 0xC6;    // B, G, R, A
+        case ImageFormat::ARGB: return 0x93;    // A, R, G, B
+        case ImageFormat::ABGR: return 0x1B;    // A, B, G, R
+        default:                return ~0u;
+    }
+}
+
+bool D3D12ImageConverter::IsConversionSupported(const D3D12Texture& textureD3D, const SrcImageDescriptor& imageDesc)
+{
+    /* Texture must allow UAVs with an 8-bit RGBA format, and source image must have a different format with 8-bit components */
+    const auto dstTexFormat = DXGetTextureFormatDesc(textureD3D.GetFormat());
+    return
+    (
+        textureD3D.GetUAVFormat() != DXGI_FORMAT_UNKNOWN &&
+        dstTexFormat.dataType == DataType::UInt8 &&
+        ImageFormatSize(dstTexFormat.format) == 4 &&
+        imageDesc.dataType == DataType::UInt8 &&
+        imageDesc.format != dstTexFormat.format &&
+        GetImageFormatChannelOrder(imageDesc.format) != ~0u
+    );
+}
+
+void D3D12ImageConverter::UploadAndConvert(
+    ID3D12GraphicsCommandList*  commandList,
+    D3D12BarrierBatch&          barriers,
+    D3D12UploadHeap&            uploadHeap,
+    D3D12Texture&               textureD3D,
+    const TextureDescriptor&    textureDesc,
+    const SrcImageDescriptor&   imageDesc,
+    UINT                        numMipLevels)
+{
+    /* Copy raw image data into a single region of the upload heap (rounded up to 4 bytes for the raw buffer view) */
+    const auto srcBase  = reinterpret_cast<const char*>(imageDesc.data);
+    const auto srcSize  = (static_cast<UINT64>(imageDesc.dataSize) + 3u) & ~3ull;
+    auto region         = uploadHeap.Allocate(srcSize, D3D12_RAW_UAV_SRV_BYTE_ALIGNMENT);
+
+    ::memcpy(region.mappedData, srcBase, imageDesc.dataSize);
+
+    /* Transition texture for write access (together with all pending barriers) */
+    textureD3D.TransitionResource(barriers, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    barriers.Flush(commandList);
+
+    ID3D12DescriptorHeap* descHeaps[] = { descriptorRing_.GetNative() };
+    commandList->SetDescriptorHeaps(1, descHeaps);
+    commandList->SetComputeRootSignature(rootSignature_.Get());
+    commandList->SetPipelineState(pipelineState_.Get());
+
+    const auto numComponents    = ImageFormatSize(imageDesc.format);
+    const auto numArrayLayers   = textureD3D.GetNumArrayLayers();
+
+    for (UINT mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        /* Get source data of the current MIP level within the MIP-map chain */
+        const auto mipImageDesc = GetMipChainLevel(textureDesc, imageDesc, mipLevel);
+        const auto mipExtent    = GetMipExtent(textureDesc, mipLevel);
+        const auto mipWidth     = mipExtent.width;
+        const auto mipHeight    = mipExtent.height;
+
+        /* Write descriptors into the ring and bind them */
+        const auto firstDescriptor = descriptorRing_.Allocate(g_numDescriptorsPerDispatch);
+        CreateResourceViews(device_, region.resource, region.offset, srcSize, textureD3D, mipLevel, firstDescriptor);
+        commandList->SetComputeRootDescriptorTable(1, descriptorRing_.GetGPUDescriptorHandle(firstDescriptor));
+
+        D3D12ImageConverterConstants constants;
+        {
+            constants.srcOffset     = static_cast<UINT>(reinterpret_cast<const char*>(mipImageDesc.data) - srcBase);
+            constants.srcRowPitch   = numComponents * mipWidth;
+            constants.srcSlicePitch = constants.srcRowPitch * mipHeight;
+            constants.numComponents = numComponents;
+            constants.channelOrder  = GetImageFormatChannelOrder(imageDesc.format);
+            constants.width         = mipWidth;
+            constants.height        = mipHeight;
+        }
+        commandList->SetComputeRoot32BitConstants(0, sizeof(constants) / 4, &constants, 0);
+
+        commandList->Dispatch(
+            (mipWidth  + g_threadGroupSize - 1) / g_threadGroupSize,
+            (mipHeight + g_threadGroupSize - 1) / g_threadGroupSize,
+            numArrayLayers
+        );
+    }
+
+    /* Transition texture back for shader access with the next flush of the barrier batch */
+    textureD3D.TransitionToUsageState(barriers);
+}
+
+void D3D12ImageConverter::Submit(UINT64 fenceValue)
+{
+    descriptorRing_.Submit(fenceValue);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12ImageConverter::CreateRootSignature(ID3D12Device* device)
+{
+    /* Setup root parameters: constants, and a descriptor table for the source SRV and destination UAV */
+    CD3DX12_DESCRIPTOR_RANGE descRanges[2];
+    descRanges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+    descRanges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0);
+
+    CD3DX12_ROOT_PARAMETER rootParams[2];
+    rootParams[0].InitAsConstants(sizeof(D3D12ImageConverterConstants) / 4, 0);
+    rootParams[1].InitAsDescriptorTable(2, descRanges);
+
+    CD3DX12_ROOT_SIGNATURE_DESC signatureDesc;
+    signatureDesc.Init(2, rootParams, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    /* Create serialized root signature */
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+
+    auto hr = D3D12SerializeRootSignature(
+        &signatureDesc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        signature.ReleaseAndGetAddressOf(),
+        error.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && error)
+        throw std::runtime_error("failed to serialize D3D12 root signature for image conversion: " + DXGetBlobString(error.Get()));
+
+    DXThrowIfFailed(hr, "failed to serialize D3D12 root signature for image conversion");
+
+    /* Create actual root signature */
+    hr = device->CreateRootSignature(
+        0,
+        signature->GetBufferPointer(),
+        signature->GetBufferSize(),
+        IID_PPV_ARGS(rootSignature_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 root signature for image conversion");
+}
+
+void D3D12ImageConverter::CreatePipelineState(ID3D12Device* device)
+{
+    /* Compile built-in compute shader */
+    ComPtr<ID3DBlob> byteCode;
+    ComPtr<ID3DBlob> errors;
+
+    auto hr = D3DCompile(
+        g_imageConverterShaderSource,
+        std::strlen(g_imageConverterShaderSource),
+        "LLGL::D3D12ImageConverter",
+        nullptr,
+        nullptr,
+        "CSMain",
+        "cs_5_0",
+        D3DCOMPILE_OPTIMIZATION_LEVEL3,
+        0,
+        byteCode.ReleaseAndGetAddressOf(),
+        errors.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && errors)
+        throw std::runtime_error("failed to compile D3D12 shader for image conversion: " + DXGetBlobString(errors.Get()));
+
+    DXThrowIfFailed(hr, "failed to compile D3D12 shader for image conversion");
+
+    /* Create compute pipeline state */
+    D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc = {};
+    {
+        stateDesc.pRootSignature        = rootSignature_.Get();
+        stateDesc.CS.pShaderBytecode    = byteCode->GetBufferPointer();
+        stateDesc.CS.BytecodeLength     = byteCode->GetBufferSize();
+    }
+    hr = device->CreateComputePipelineState(&stateDesc, IID_PPV_ARGS(pipelineState_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 compute pipeline state for image conversion");
+}
+
+void D3D12ImageConverter::CreateResourceViews(
+    ID3D12Device*   device,
+    ID3D12Resource* srcBuffer,
+    UINT64          srcOffset,
+    UINT64          srcSize,
+    D3D12Texture&   textureD3D,
+    UINT            mipLevel,
+    UINT            firstDescriptor)
+{
+    /* Create raw buffer SRV for the source image data in the upload heap */
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                      = DXGI_FORMAT_R32_TYPELESS;
+        srvDesc.ViewDimension               = D3D12_SRV_DIMENSION_BUFFER;
+        srvDesc.Shader4ComponentMapping     = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Buffer.FirstElement         = srcOffset / 4;
+        srvDesc.Buffer.NumElements          = static_cast<UINT>(srcSize / 4);
+        srvDesc.Buffer.StructureByteStride  = 0;
+        srvDesc.Buffer.Flags                = D3D12_BUFFER_SRV_FLAG_RAW;
+    }
+    device->CreateShaderResourceView(srcBuffer, &srvDesc, descriptorRing_.GetCPUDescriptorHandle(firstDescriptor));
+
+    /* Create UAV for the destination MIP level of all array layers (cube textures are viewed as 2D-array textures) */
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+    {
+        uavDesc.Format                          = textureD3D.GetUAVFormat();
+        uavDesc.ViewDimension                   = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+        uavDesc.Texture2DArray.MipSlice         = mipLevel;
+        uavDesc.Texture2DArray.FirstArraySlice  = 0;
+        uavDesc.Texture2DArray.ArraySize        = textureD3D.GetNumArrayLayers();
+        uavDesc.Texture2DArray.PlaneSlice       = 0;
+    }
+    device->CreateUnorderedAccessView(textureD3D.GetNative(), nullptr, &uavDesc, descriptorRing_.GetCPUDescriptorHandle(firstDescriptor + 1));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,97 @@
+/*
+ * D3D12ImageConverter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_IMAGE_CONVERTER_H
+#define LLGL_D3D12_IMAGE_CONVERTER_H
+
+
+#include "../RenderState/D3D12DescriptorHeapRing.h"
+#include "../../DXCommon/ComPtr.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+class D3D12Texture;
+class D3D12BarrierBatch;
+class D3D12UploadHeap;
+
+/*
+Converts the initial image data of textures with a built-in compute shader, instead of converting it on the CPU with 'ConvertImageBuffer'.
+The source image is uploaded as it is (e.g. 3 bytes per pixel for RGB images) and read as raw buffer,
+and each pixel is expanded into the texture via a typed UAV (see D3D12Texture::GetUAVFormat).
+The descriptors of each dispatch are allocated from an own descriptor heap ring, which is submitted together with the upload command list.
+*/
+class D3D12ImageConverter
+{
+
+    public:
+
+        D3D12ImageConverter(D3D12RenderSystem& renderSystem);
+
+        D3D12ImageConverter(const D3D12ImageConverter&) = delete;
+        D3D12ImageConverter& operator = (const D3D12ImageConverter&) = delete;
+
+        // Returns true if the specified source image must be converted into the format of the specified texture and this can be done on the GPU.
+        static bool IsConversionSupported(const D3D12Texture& textureD3D, const SrcImageDescriptor& imageDesc);
+
+        /*
+        Uploads the image data of the first 'numMipLevels' MIP levels of all array layers and records the commands to convert it into the texture.
+        The image data must be laid out like the initial data of RenderSystem::CreateTexture, i.e. the array layers of each MIP level are consecutive.
+        The transition back into the state for shader access is appended to the barrier batch.
+        */
+        void UploadAndConvert(
+            ID3D12GraphicsCommandList*  commandList,
+            D3D12BarrierBatch&          barriers,
+            D3D12UploadHeap&            uploadHeap,
+            D3D12Texture&               textureD3D,
+            const TextureDescriptor&    textureDesc,
+            const SrcImageDescriptor&   imageDesc,
+            UINT                        numMipLevels
+        );
+
+        // Assigns all descriptor ranges that have been allocated since the last submission to the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+    private:
+
+        void CreateRootSignature(ID3D12Device* device);
+        void CreatePipelineState(ID3D12Device* device);
+
+        void CreateResourceViews(
+            ID3D12Device*   device,
+            ID3D12Resource* srcBuffer,
+            UINT64          srcOffset,
+            UINT64          srcSize,
+            D3D12Texture&   textureD3D,
+            UINT            mipLevel,
+            UINT            firstDescriptor
+        );
+
+        ID3D12Device*                   device_         = nullptr;
+
+        ComPtr<ID3D12RootSignature>     rootSignature_;
+        ComPtr<ID3D12PipelineState>     pipelineState_;
+
+        D3D12DescriptorHeapRing         descriptorRing_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,391 @@
+/*
+ * D3D12MipGenerator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MipGenerator.h"
+#include "D3D12Texture.h"
+#include "../D3D12RenderSystem.h"
+#include "../D3D12BarrierBatch.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include <d3dcompiler.h>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Maximal number of MIP levels that are generated by a single dispatch
+static const UINT g_maxMipLevelsPerDispatch = 4;
+
+// Number of descriptors per dispatch: one SRV for the source MIP level and one UAV for each destination MIP level
+static const UINT g_numDescriptorsPerDispatch = 1 + g_maxMipLevelsPerDispatch;
+
+// Number of descriptors in the ring of the MIP-map generator
+static const UINT g_numDescriptors = 1024;
+
+// Number of threads in X and Y dimension of each thread group
+static const UINT g_threadGroupSize = 8;
+
+/*
+Each thread samples the center of a 2x2 quad of the source MIP level with a bilinear filter.
+The results are then reduced within the 8x8 thread group via groupshared memory for the next three MIP levels.
+sRGB textures are sampled with an sRGB view (i.e. in linear space), but written through UNORM views, so the shader must encode the output.
+*/
+static const char* g_mipGeneratorShaderSource = R"(
+cbuffer Constants : register(b0)
+{
+    uint    NumMipLevels;
+    uint    IsSRGB;
+    float2  TexelSize;
+};
+
+Texture2DArray<float4>      SrcMip      : register(t0);
+RWTexture2DArray<float4>    OutMip1     : register(u0);
+RWTexture2DArray<float4>    OutMip2     : register(u1);
+RWTexture2DArray<float4>    OutMip3     : register(u2);
+RWTexture2DArray<float4>    OutMip4     : register(u3);
+SamplerState                LinearClamp : register(s0);
+
+groupshared float4 g_tile[64];
+
+float4 EncodeColor(float4 color)
+{
+    if (IsSRGB != 0)
+    {
+        float3 lo = color.rgb * 12.92;
+        float3 hi = 1.055 * pow(abs(color.rgb), 1.0/2.4) - 0.055;
+        color.rgb = (color.rgb <= 0.0031308 ? lo : hi);
+    }
+    return color;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint gi : SV_GroupIndex, uint3 dtid : SV_DispatchThreadID)
+{
+    float2 uv = TexelSize * (dtid.xy + 0.5);
+    float4 color = SrcMip.SampleLevel(LinearClamp, float3(uv, dtid.z), 0);
+    OutMip1[dtid] = EncodeColor(color);
+
+    if (NumMipLevels == 1)
+        return;
+
+    g_tile[gi] = color;
+    GroupMemoryBarrierWithGroupSync();
+
+    if ((gi & 0x09) == 0)
+    {
+        color = 0.25 * (color + g_tile[gi + 0x01] + g_tile[gi + 0x08] + g_tile[gi + 0x09]);
+        OutMip2[uint3(dtid.xy / 2, dtid.z)] = EncodeColor(color);
+        g_tile[gi] = color;
+    }
+
+    if (NumMipLevels == 2)
+        return;
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if ((gi & 0x1B) == 0)
+    {
+        color = 0.25 * (color + g_tile[gi + 0x02] + g_tile[gi + 0x10] + g_tile[gi + 0x12]);
+        OutMip3[uint3(dtid.xy / 4, dtid.z)] = EncodeColor(color);
+        g_tile[gi] = color;
+    }
+
+    if (NumMipLevels == 3)
+        return;
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (gi == 0)
+    {
+        color = 0.25 * (color + g_tile[gi + 0x04] + g_tile[gi + 0x20] + g_tile[gi + 0x24]);
+        OutMip4[uint3(dtid.xy / 8, dtid.z)] = EncodeColor(color);
+    }
+}
+)";
+
+// Root constants of the MIP-map generation shader
+struct D3D12MipGeneratorConstants
+{
+    UINT    numMipLevels;
+    UINT    isSRGB;
+    FLOAT   texelSize[2];
+};
+
+D3D12MipGenerator::D3D12MipGenerator(D3D12RenderSystem& renderSystem) :
+    device_         { renderSystem.GetDevice()                                                },
+    descriptorRing_ { renderSystem, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, g_numDescriptors }
+{
+    CreateRootSignature(device_);
+    CreatePipelineState(device_);
+}
+
+// Returns true if the specified format is an sRGB format.
+static bool IsSRGBFormat(DXGI_FORMAT format)
+{
+    return (format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB);
+}
+
+// Returns the extent of the specified MIP level.
+static UINT GetMipExtent(UINT64 extent, UINT mipLevel)
+{
+    return std::max(1u, static_cast<UINT>(extent >> mipLevel));
+}
+
+// Appends the transitions of the specified MIP levels of all selected array layers.
+static void AppendMipTransitions(
+    std::vector<D3D12_RESOURCE_BARRIER>&    barriers,
+    D3D12Texture&                           textureD3D,
+    UINT                                    baseMipLevel,
+    UINT                                    numMipLevels,
+    UINT                                    baseArrayLayer,
+    UINT                                    numArrayLayers,
+    D3D12_RESOURCE_STATES                   stateBefore,
+    D3D12_RESOURCE_STATES                   stateAfter)
+{
+    for (UINT mipLevel = baseMipLevel; mipLevel < baseMipLevel + numMipLevels; ++mipLevel)
+    {
+        for (UINT arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + numArrayLayers; ++arrayLayer)
+        {
+            const auto subresource = D3D12CalcSubresource(mipLevel, arrayLayer, 0, textureD3D.GetNumMipLevels(), textureD3D.GetNumArrayLayers());
+            barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(textureD3D.GetNative(), stateBefore, stateAfter, subresource));
+        }
+    }
+}
+
+void D3D12MipGenerator::GenerateMips(
+    ID3D12GraphicsCommandList*  commandList,
+    D3D12BarrierBatch&          barriers,
+    D3D12Texture&               textureD3D,
+    UINT                        baseMipLevel,
+    UINT                        numMipLevels,
+    UINT                        baseArrayLayer,
+    UINT                        numArrayLayers)
+{
+    /* Clamp MIP-map and array layer range to the texture */
+    const auto maxMipLevels = textureD3D.GetNumMipLevels();
+    const auto maxArrayLayers = textureD3D.GetNumArrayLayers();
+
+    if (baseMipLevel + 1 >= maxMipLevels || baseArrayLayer >= maxArrayLayers)
+        return;
+
+    numMipLevels    = std::min(numMipLevels, maxMipLevels - baseMipLevel);
+    numArrayLayers  = std::min(numArrayLayers, maxArrayLayers - baseArrayLayer);
+
+    if (numMipLevels < 2 || numArrayLayers == 0)
+        return;
+
+    /* All subresources are read in the state for non-pixel shader access, only the destination MIP levels of each dispatch are written as UAVs */
+    textureD3D.TransitionResource(barriers, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    barriers.Flush(commandList);
+
+    ID3D12DescriptorHeap* descHeaps[] = { descriptorRing_.GetNative() };
+    commandList->SetDescriptorHeaps(1, descHeaps);
+    commandList->SetComputeRootSignature(rootSignature_.Get());
+    commandList->SetPipelineState(pipelineState_.Get());
+
+    const auto resourceDesc = textureD3D.GetNative()->GetDesc();
+    const bool isSRGB       = IsSRGBFormat(textureD3D.GetFormat());
+
+    std::vector<D3D12_RESOURCE_BARRIER> mipBarriers;
+
+    for (UINT srcMipLevel = baseMipLevel; srcMipLevel + 1 < baseMipLevel + numMipLevels;)
+    {
+        /* Determine number of destination MIP levels for this dispatch */
+        const auto numDstMipLevels  = std::min(g_maxMipLevelsPerDispatch, baseMipLevel + numMipLevels - srcMipLevel - 1);
+        const auto dstWidth         = GetMipExtent(resourceDesc.Width, srcMipLevel + 1);
+        const auto dstHeight        = GetMipExtent(resourceDesc.Height, srcMipLevel + 1);
+
+        /* Write descriptors into the ring and bind them */
+        const auto firstDescriptor = descriptorRing_.Allocate(g_numDescriptorsPerDispatch);
+        CreateResourceViews(device_, textureD3D, srcMipLevel, numDstMipLevels, baseArrayLayer, numArrayLayers, firstDescriptor);
+        commandList->SetComputeRootDescriptorTable(1, descriptorRing_.GetGPUDescriptorHandle(firstDescriptor));
+
+        D3D12MipGeneratorConstants constants;
+        {
+            constants.numMipLevels  = numDstMipLevels;
+            constants.isSRGB        = (isSRGB ? 1u : 0u);
+            constants.texelSize[0]  = 1.0f / static_cast<FLOAT>(dstWidth);
+            constants.texelSize[1]  = 1.0f / static_cast<FLOAT>(dstHeight);
+        }
+        commandList->SetComputeRoot32BitConstants(0, sizeof(constants) / 4, &constants, 0);
+
+        /* Transition destination MIP levels for write access */
+        mipBarriers.clear();
+        AppendMipTransitions(
+            mipBarriers, textureD3D, srcMipLevel + 1, numDstMipLevels, baseArrayLayer, numArrayLayers,
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+        );
+        commandList->ResourceBarrier(static_cast<UINT>(mipBarriers.size()), mipBarriers.data());
+
+        commandList->Dispatch(
+            (dstWidth  + g_threadGroupSize - 1) / g_threadGroupSize,
+            (dstHeight + g_threadGroupSize - 1) / g_threadGroupSize,
+            numArrayLayers
+        );
+
+        /* Transition destination MIP levels back, so the last of them can be read by the next dispatch */
+        for (auto& barrier : mipBarriers)
+            std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+        commandList->ResourceBarrier(static_cast<UINT>(mipBarriers.size()), mipBarriers.data());
+
+        srcMipLevel += numDstMipLevels;
+    }
+
+    /* Transition texture back for shader access with the next flush of the barrier batch */
+    textureD3D.TransitionToUsageState(barriers);
+}
+
+void D3D12MipGenerator::Submit(UINT64 fenceValue)
+{
+    descriptorRing_.Submit(fenceValue);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12MipGenerator::CreateRootSignature(ID3D12Device* device)
+{
+    /* Setup root parameters: constants, and a descriptor table for the source SRV and destination UAVs */
+    CD3DX12_DESCRIPTOR_RANGE descRanges[2];
+    descRanges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+    descRanges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, g_maxMipLevelsPerDispatch, 0);
+
+    CD3DX12_ROOT_PARAMETER rootParams[2];
+    rootParams[0].InitAsConstants(sizeof(D3D12MipGeneratorConstants) / 4, 0);
+    rootParams[1].InitAsDescriptorTable(2, descRanges);
+
+    CD3DX12_STATIC_SAMPLER_DESC linearClampSampler(
+        0,
+        D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP
+    );
+
+    CD3DX12_ROOT_SIGNATURE_DESC signatureDesc;
+    signatureDesc.Init(2, rootParams, 1, &linearClampSampler, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    /* Create serialized root signature */
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+
+    auto hr = D3D12SerializeRootSignature(
+        &signatureDesc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        signature.ReleaseAndGetAddressOf(),
+        error.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && error)
+        throw std::runtime_error("failed to serialize D3D12 root signature for MIP-map generation: " + DXGetBlobString(error.Get()));
+
+    DXThrowIfFailed(hr, "failed to serialize D3D12 root signature for MIP-map generation");
+
+    /* Create actual root signature */
+    hr = device->CreateRootSignature(
+        0,
+        signature->GetBufferPointer(),
+        signature->GetBufferSize(),
+        IID_PPV_ARGS(rootSignature_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 root signature for MIP-map generation");
+}
+
+void D3D12MipGenerator::CreatePipelineState(ID3D12Device* device)
+{
+    /* Compile built-in compute shader */
+    ComPtr<ID3DBlob> byteCode;
+    ComPtr<ID3DBlob> errors;
+
+    auto hr = D3DCompile(
+        g_mipGeneratorShaderSource,
+        std::strlen(g_mipGeneratorShaderSource),
+        "LLGL::D3D12MipGenerator",
+        nullptr,
+        nullptr,
+        "CSMain",
+        "cs_5_0",
+        D3DCOMPILE_OPTIMIZATION_LEVEL3,
+        0,
+        byteCode.ReleaseAndGetAddressOf(),
+        errors.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && errors)
+        throw std::runtime_error("failed to compile D3D12 shader for MIP-map generation: " + DXGetBlobString(errors.Get()));
+
+    DXThrowIfFailed(hr, "failed to compile D3D12 shader for MIP-map generation");
+
+    /* Create compute pipeline state */
+    D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc = {};
+    {
+        stateDesc.pRootSignature        = rootSignature_.Get();
+        stateDesc.CS.pShaderBytecode    = byteCode->GetBufferPointer();
+        stateDesc.CS.BytecodeLength     = byteCode->GetBufferSize();
+    }
+    hr = device->CreateComputePipelineState(&stateDesc, IID_PPV_ARGS(pipelineState_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 compute pipeline state for MIP-map generation");
+}
+
+void D3D12MipGenerator::CreateResourceViews(
+    ID3D12Device*   device,
+    D3D12Texture&   textureD3D,
+    UINT            srcMipLevel,
+    UINT            numMipLevels,
+    UINT            baseArrayLayer,
+    UINT            numArrayLayers,
+    UINT            firstDescriptor)
+{
+    /* Create SRV for the source MIP level (cube textures are viewed as 2D-array textures) */
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                                  = textureD3D.GetFormat();
+        srvDesc.ViewDimension                           = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+        srvDesc.Shader4ComponentMapping                 = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2DArray.MostDetailedMip          = srcMipLevel;
+        srvDesc.Texture2DArray.MipLevels                = 1;
+        srvDesc.Texture2DArray.FirstArraySlice          = baseArrayLayer;
+        srvDesc.Texture2DArray.ArraySize                = numArrayLayers;
+        srvDesc.Texture2DArray.PlaneSlice               = 0;
+        srvDesc.Texture2DArray.ResourceMinLODClamp      = 0.0f;
+    }
+    device->CreateShaderResourceView(textureD3D.GetNative(), &srvDesc, descriptorRing_.GetCPUDescriptorHandle(firstDescriptor));
+
+    /* Create UAVs for the destination MIP levels (unused slots get null descriptors) */
+    for (UINT i = 0; i < g_maxMipLevelsPerDispatch; ++i)
+    {
+        D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+        {
+            uavDesc.Format                          = textureD3D.GetUAVFormat();
+            uavDesc.ViewDimension                   = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+            uavDesc.Texture2DArray.MipSlice         = srcMipLevel + 1 + std::min(i, numMipLevels - 1);
+            uavDesc.Texture2DArray.FirstArraySlice  = baseArrayLayer;
+            uavDesc.Texture2DArray.ArraySize        = numArrayLayers;
+            uavDesc.Texture2DArray.PlaneSlice       = 0;
+        }
+        device->CreateUnorderedAccessView(
+            (i < numMipLevels ? textureD3D.GetNative() : nullptr),
+            nullptr,
+            &uavDesc,
+            descriptorRing_.GetCPUDescriptorHandle(firstDescriptor + 1 + i)
+        );
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
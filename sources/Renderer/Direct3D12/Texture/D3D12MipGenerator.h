@@ -0,0 +1,90 @@
+/*
+ * D3D12MipGenerator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MIP_GENERATOR_H
+#define LLGL_D3D12_MIP_GENERATOR_H
+
+
+#include "../RenderState/D3D12DescriptorHeapRing.h"
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+class D3D12Texture;
+class D3D12BarrierBatch;
+
+/*
+Generates MIP-maps with a built-in compute shader, since D3D12 has no equivalent to 'ID3D11DeviceContext::GenerateMips'.
+Each dispatch downsamples up to four MIP levels of all selected array layers at once, using groupshared memory for the intermediate levels.
+The descriptors of each dispatch are allocated from an own descriptor heap ring, which is submitted together with the upload command list.
+*/
+class D3D12MipGenerator
+{
+
+    public:
+
+        D3D12MipGenerator(D3D12RenderSystem& renderSystem);
+
+        D3D12MipGenerator(const D3D12MipGenerator&) = delete;
+        D3D12MipGenerator& operator = (const D3D12MipGenerator&) = delete;
+
+        /*
+        Records the commands to generate the MIP levels in the range (baseMipLevel, baseMipLevel + numMipLevels) from the base MIP level.
+        The texture must support MIP-map generation (see D3D12Texture::GetUAVFormat).
+        The transition back into the state for shader access is appended to the barrier batch.
+        */
+        void GenerateMips(
+            ID3D12GraphicsCommandList*  commandList,
+            D3D12BarrierBatch&          barriers,
+            D3D12Texture&               textureD3D,
+            UINT                        baseMipLevel,
+            UINT                        numMipLevels,
+            UINT                        baseArrayLayer,
+            UINT                        numArrayLayers
+        );
+
+        // Assigns all descriptor ranges that have been allocated since the last submission to the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+    private:
+
+        void CreateRootSignature(ID3D12Device* device);
+        void CreatePipelineState(ID3D12Device* device);
+
+        void CreateResourceViews(
+            ID3D12Device*   device,
+            D3D12Texture&   textureD3D,
+            UINT            srcMipLevel,
+            UINT            numMipLevels,
+            UINT            baseArrayLayer,
+            UINT            numArrayLayers,
+            UINT            firstDescriptor
+        );
+
+        ID3D12Device*                   device_         = nullptr;
+
+        ComPtr<ID3D12RootSignature>     rootSignature_;
+        ComPtr<ID3D12PipelineState>     pipelineState_;
+
+        D3D12DescriptorHeapRing         descriptorRing_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
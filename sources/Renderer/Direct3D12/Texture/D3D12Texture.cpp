@@ -9,30 +9,35 @@
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
 #include "../D3D12Types.h"
+#include "../D3D12UploadHeap.h"
+#include "../D3D12BarrierBatch.h"
 #include <algorithm>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
-#define _DEB_DISABLE_MIPS
-
 static void Convert(D3D12_RESOURCE_DESC& dst, const TextureDescriptor& src)
 {
     dst.Dimension           = D3D12Types::ToResourceDimension(src.type);
     dst.Alignment           = 0;
-    #ifndef _DEB_DISABLE_MIPS//TODO: mipmapping is not supported yet
     dst.MipLevels           = NumMipLevels(src);
-    #else
-    dst.MipLevels           = 1;
-    #endif
     dst.Format              = D3D12Types::Map(src.format);
     dst.SampleDesc.Count    = 1;
     dst.SampleDesc.Quality  = 0;
     dst.Layout              = D3D12_TEXTURE_LAYOUT_UNKNOWN;
     dst.Flags               = D3D12_RESOURCE_FLAG_NONE;
 
+    /* Depth-stencil attachments are only created with an SRV if they are sampled */
+    if (IsDepthStencilFormat(src.format) && (src.flags & TextureFlags::AttachmentUsage) != 0)
+    {
+        dst.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+        if ((src.flags & TextureFlags::SampleUsage) == 0)
+            dst.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+    }
+
     switch (src.type)
     {
         case TextureType::Texture1D:
@@ -67,20 +72,142 @@ static void Convert(D3D12_RESOURCE_DESC& dst, const TextureDescriptor& src)
     }
 }
 
-D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc) :
+// Returns true if MIP-maps can be generated with a compute shader for the specified texture type and format.
+static bool IsMipGenerationSupported(const TextureType type, const Format format)
+{
+    /* MIP-maps are generated for 2D textures only, i.e. each array layer and cube face is processed as 2D texture */
+    switch (type)
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            return (!IsCompressedFormat(format) && !IsDepthStencilFormat(format));
+        default:
+            return false;
+    }
+}
+
+// Returns true if image data can be converted with a compute shader for the specified texture type and hardware format (see D3D12ImageConverter).
+static bool IsImageConversionSupported(const TextureType type, DXGI_FORMAT format)
+{
+    switch (type)
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            break;
+        default:
+            return false;
+    }
+    switch (format)
+    {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the format of the UAVs to generate MIP-maps for the specified texture format, since sRGB formats cannot be written as UAVs.
+static DXGI_FORMAT GetMipGenerationUAVFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:   return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:   return DXGI_FORMAT_B8G8R8A8_UNORM;
+        default:                                return format;
+    }
+}
+
+// Returns the typeless format for the resource of the specified format, if it must be viewed with different formats to generate MIP-maps.
+static DXGI_FORMAT GetMipGenerationResourceFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:   return DXGI_FORMAT_R8G8B8A8_TYPELESS;
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:   return DXGI_FORMAT_B8G8R8A8_TYPELESS;
+        default:                                return format;
+    }
+}
+
+// Returns true if the specified format can be written with typed UAV stores.
+static bool IsUAVTypedStoreSupported(ID3D12Device* device, DXGI_FORMAT format)
+{
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { format, D3D12_FORMAT_SUPPORT1_NONE, D3D12_FORMAT_SUPPORT2_NONE };
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport));
+    return (SUCCEEDED(hr) && (formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_STORE) != 0);
+}
+
+D3D12Texture::D3D12Texture(D3D12MemoryAllocator& allocator, const TextureDescriptor& desc, bool allowImageConversion) :
     Texture         { desc.type                    },
     format_         { D3D12Types::Map(desc.format) },
-    #ifndef _DEB_DISABLE_MIPS//TODO: mipmapping not supported yet
     numMipLevels_   { NumMipLevels(desc)           },
-    #else
-    numMipLevels_   { 1                            },
-    #endif
     numArrayLayers_ { desc.arrayLayers             }
 {
-    /* Setup resource descriptor by texture descriptor and create hardware resource */
+    /* Setup resource descriptor by texture descriptor */
     D3D12_RESOURCE_DESC descD3D;
     Convert(descD3D, desc);
-    CreateResource(device, descD3D);
+
+    /* Allow UAVs for MIP-map generation if the texture has a MIP chain, or for image conversion, if its format supports typed UAV stores */
+    if ( ( numMipLevels_ > 1 && IsMipGenerationSupported(GetType(), desc.format) ) ||
+         ( allowImageConversion && IsImageConversionSupported(GetType(), format_) ) )
+    {
+        const auto uavFormat = GetMipGenerationUAVFormat(format_);
+        if (IsUAVTypedStoreSupported(allocator.GetDevice(), uavFormat))
+        {
+            uavFormat_      = uavFormat;
+            descD3D.Format  = GetMipGenerationResourceFormat(format_);
+            descD3D.Flags   |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+        }
+    }
+
+    /* Use typeless format if the texture can be shared with texture views of a different format */
+    if ((desc.flags & TextureFlags::MutableFormat) != 0)
+        descD3D.Format = DXGetTypelessFormat(descD3D.Format);
+
+    /* Create hardware resource */
+    CreateResource(allocator, descD3D);
+}
+
+// Returns the D3D12 shader component for the specified texture swizzle.
+static D3D12_SHADER_COMPONENT_MAPPING GetD3DShaderComponentMapping(const TextureSwizzle swizzle)
+{
+    switch (swizzle)
+    {
+        case TextureSwizzle::Zero:  return D3D12_SHADER_COMPONENT_MAPPING_FORCE_VALUE_0;
+        case TextureSwizzle::One:   return D3D12_SHADER_COMPONENT_MAPPING_FORCE_VALUE_1;
+        case TextureSwizzle::Red:   return D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0;
+        case TextureSwizzle::Green: return D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1;
+        case TextureSwizzle::Blue:  return D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2;
+        case TextureSwizzle::Alpha: return D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3;
+    }
+    return D3D12_SHADER_COMPONENT_MAPPING_FORCE_VALUE_0;
+}
+
+D3D12Texture::D3D12Texture(const D3D12Texture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture             { desc.type                       },
+    resource_           { sharedTexture.resource_         },
+    format_             { D3D12Types::Map(desc.format)    },
+    numMipLevels_       { desc.subresource.numMipLevels   },
+    numArrayLayers_     { desc.subresource.numArrayLayers },
+    sharedTexture_      { &sharedTexture                  },
+    baseMipLevel_       { desc.subresource.baseMipLevel   },
+    baseArrayLayer_     { desc.subresource.baseArrayLayer },
+    componentMapping_
+    {
+        D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(
+            GetD3DShaderComponentMapping(desc.swizzle.r),
+            GetD3DShaderComponentMapping(desc.swizzle.g),
+            GetD3DShaderComponentMapping(desc.swizzle.b),
+            GetD3DShaderComponentMapping(desc.swizzle.a)
+        )
+    }
+{
 }
 
 Extent3D D3D12Texture::QueryMipExtent(std::uint32_t mipLevel) const
@@ -139,7 +266,7 @@ TextureDescriptor D3D12Texture::QueryDesc() const
     auto desc = resource_->GetDesc();
 
     texDesc.type   = GetType();
-    texDesc.format = D3D12Types::Unmap(desc.Format);
+    texDesc.format = D3D12Types::Unmap(format_);  // resource format may be typeless for MIP-map generation
     texDesc.flags  = 0;
 
     switch (GetType())
@@ -178,128 +305,203 @@ TextureDescriptor D3D12Texture::QueryDesc() const
     return texDesc;
 }
 
+void D3D12Texture::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    /* Texture views have no resource of their own, so the name of the shared texture is left unchanged */
+    if (sharedTexture_ == nullptr)
+        DXSetObjectName(GetNative(), name);
+    #endif
+}
+
+// Returns the specified upload size aligned to the placement alignment of texture data
+static UINT64 AlignD3D12UploadSize(UINT64 size)
+{
+    return ((size + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) & ~static_cast<UINT64>(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1));
+}
+
 void D3D12Texture::UpdateSubresource(
-    ID3D12Device*               device,
-    ID3D12GraphicsCommandList*  commandList,
-    ComPtr<ID3D12Resource>&     uploadBuffer,
-    D3D12_SUBRESOURCE_DATA&     subresourceData,
-    UINT                        firstArrayLayer,
-    UINT                        numArrayLayers)
+    ID3D12GraphicsCommandList*      commandList,
+    D3D12BarrierBatch&              barriers,
+    D3D12UploadHeap&                uploadHeap,
+    const D3D12_SUBRESOURCE_DATA*   subresourceData,
+    UINT                            numMipLevels,
+    UINT                            firstArrayLayer,
+    UINT                            numArrayLayers)
 {
     /* Clamp arguments */
+    numMipLevels    = std::max(1u, std::min(numMipLevels, numMipLevels_));
     firstArrayLayer = std::min(firstArrayLayer, numArrayLayers_ - 1u);
     numArrayLayers  = std::min(numArrayLayers, numArrayLayers_ - firstArrayLayer);
 
-    /* Create the GPU upload buffer */
-    UINT64 uploadBufferSize     = GetRequiredIntermediateSize(resource_.Get(), 0, numArrayLayers);
-    UINT64 uploadBufferOffset   = 0;
-
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
+    /* Transition texture resource for copy operation (together with all pending barriers), if it has already been used */
+    barriers.TransitionResource(resource_.Get(), resourceState_, D3D12_RESOURCE_STATE_COPY_DEST);
+    barriers.FlushForCopy(commandList);
+
+    /* Allocate a single transient upload region for all MIP levels of all array layers (the MIP levels of each array layer are consecutive subresources) */
+    const auto layerUploadSize = AlignD3D12UploadSize(
+        GetRequiredIntermediateSize(resource_.Get(), D3D12CalcSubresource(0, firstArrayLayer, 0, numMipLevels_, numArrayLayers_), numMipLevels)
     );
 
-    /* Upload subresource for each array layer */
+    auto region = uploadHeap.Allocate(layerUploadSize * numArrayLayers, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    /* Upload subresources for each array layer */
+    std::vector<D3D12_SUBRESOURCE_DATA> layerData(subresourceData, subresourceData + numMipLevels);
+
     for (UINT arrayLayer = 0; arrayLayer < numArrayLayers; ++arrayLayer)
     {
-        /* Update subresource for current array layer */
         UINT subresourceIndex = D3D12CalcSubresource(0, firstArrayLayer + arrayLayer, 0, numMipLevels_, numArrayLayers_);
 
         UpdateSubresources(
-            commandList,        // pCmdList
-            resource_.Get(),    // pDestinationResource
-            uploadBuffer.Get(), // pIntermediate
-            uploadBufferOffset, // IntermediateOffset
-            subresourceIndex,   // FirstSubresource
-            1,                  // NumSubresources
-            &subresourceData    // pSrcData
+            commandList,                                    // pCmdList
+            resource_.Get(),                                // pDestinationResource
+            region.resource,                                // pIntermediate
+            region.offset + layerUploadSize * arrayLayer,   // IntermediateOffset
+            subresourceIndex,                               // FirstSubresource
+            numMipLevels,                                   // NumSubresources
+            layerData.data()                                // pSrcData
         );
 
-        /* Move to next buffer region */
-        subresourceData.pData = (reinterpret_cast<const std::int8_t*>(subresourceData.pData) + subresourceData.SlicePitch);
-        uploadBufferOffset += subresourceData.SlicePitch;
+        /* Move to next array layer of each MIP level */
+        for (auto& mipData : layerData)
+            mipData.pData = (reinterpret_cast<const std::int8_t*>(mipData.pData) + mipData.SlicePitch);
     }
 
-    /* Transition texture resource for shader access */
-    auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        resource_.Get(),
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
-    );
+    /* Begin transition for shader access with the next flush of the barrier batch, so it can overlap subsequent uploads */
+    BeginTransitionToUsageState(barriers);
+}
 
-    commandList->ResourceBarrier(1, &resourceBarrier);
+void D3D12Texture::TransitionResource(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState)
+{
+    barriers.TransitionResource(resource_.Get(), resourceState_, newState);
+}
+
+void D3D12Texture::TransitionToUsageState(D3D12BarrierBatch& barriers)
+{
+    TransitionResource(barriers, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+void D3D12Texture::BeginTransitionToUsageState(D3D12BarrierBatch& barriers)
+{
+    barriers.BeginTransition(resource_.Get(), resourceState_, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+void D3D12Texture::GetSubresourceRegion(
+    const Offset3D& offset,
+    const Extent3D& extent,
+    UINT&           baseArrayLayer,
+    UINT&           numArrayLayers,
+    D3D12_BOX&      box) const
+{
+    switch (GetType())
+    {
+        case TextureType::Texture1DArray:
+            baseArrayLayer  = static_cast<UINT>(offset.y);
+            numArrayLayers  = extent.height;
+            box             = CD3DX12_BOX(offset.x, offset.x + static_cast<LONG>(extent.width));
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray: /*pass*/
+        case TextureType::Texture2DMSArray:
+            baseArrayLayer  = static_cast<UINT>(offset.z);
+            numArrayLayers  = extent.depth;
+            box             = CD3DX12_BOX(
+                offset.x, offset.y,
+                offset.x + static_cast<LONG>(extent.width), offset.y + static_cast<LONG>(extent.height)
+            );
+            break;
+
+        default:
+            baseArrayLayer  = 0;
+            numArrayLayers  = 1;
+            box             = CD3DX12_BOX(
+                offset.x, offset.y, offset.z,
+                offset.x + static_cast<LONG>(extent.width), offset.y + static_cast<LONG>(extent.height), offset.z + static_cast<LONG>(extent.depth)
+            );
+            break;
+    }
+}
+
+// Returns the array texture type for the specified texture type, since SRVs of any other array layer than the first one must be array views.
+static TextureType GetArrayTextureType(const TextureType type)
+{
+    switch (type)
+    {
+        case TextureType::Texture1D:    return TextureType::Texture1DArray;
+        case TextureType::Texture2D:    return TextureType::Texture2DArray;
+        case TextureType::Texture2DMS:  return TextureType::Texture2DMSArray;
+        default:                        return type;
+    }
 }
 
 void D3D12Texture::CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle)
 {
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
     {
-        srvDesc.Format                  = format_;
-        srvDesc.ViewDimension           = D3D12Types::Map(GetType());
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Format                  = DXGetShaderResourceViewFormat(format_);
+        srvDesc.ViewDimension           = D3D12Types::Map(baseArrayLayer_ > 0 ? GetArrayTextureType(GetType()) : GetType());
+        srvDesc.Shader4ComponentMapping = componentMapping_;
 
         switch (srvDesc.ViewDimension)
         {
             case D3D12_SRV_DIMENSION_TEXTURE1D:
-                srvDesc.Texture1D.MostDetailedMip               = 0;
+                srvDesc.Texture1D.MostDetailedMip               = baseMipLevel_;
                 srvDesc.Texture1D.MipLevels                     = numMipLevels_;
-                srvDesc.Texture1D.ResourceMinLODClamp           = 0.0f;
+                srvDesc.Texture1D.ResourceMinLODClamp           = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE1DARRAY:
-                srvDesc.Texture1DArray.MostDetailedMip          = 0;
+                srvDesc.Texture1DArray.MostDetailedMip          = baseMipLevel_;
                 srvDesc.Texture1DArray.MipLevels                = numMipLevels_;
-                srvDesc.Texture1DArray.FirstArraySlice          = 0;
+                srvDesc.Texture1DArray.FirstArraySlice          = baseArrayLayer_;
                 srvDesc.Texture1DArray.ArraySize                = numArrayLayers_;
-                srvDesc.Texture1DArray.ResourceMinLODClamp      = 0.0f;
+                srvDesc.Texture1DArray.ResourceMinLODClamp      = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE2D:
-                srvDesc.Texture2D.MostDetailedMip               = 0;
+                srvDesc.Texture2D.MostDetailedMip               = baseMipLevel_;
                 srvDesc.Texture2D.MipLevels                     = numMipLevels_;
                 srvDesc.Texture2D.PlaneSlice                    = 0;
-                srvDesc.Texture2D.ResourceMinLODClamp           = 0.0f;
+                srvDesc.Texture2D.ResourceMinLODClamp           = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:
-                srvDesc.Texture2DArray.MostDetailedMip          = 0;
+                srvDesc.Texture2DArray.MostDetailedMip          = baseMipLevel_;
                 srvDesc.Texture2DArray.MipLevels                = numMipLevels_;
-                srvDesc.Texture2DArray.FirstArraySlice          = 0;
+                srvDesc.Texture2DArray.FirstArraySlice          = baseArrayLayer_;
                 srvDesc.Texture2DArray.ArraySize                = numArrayLayers_;
                 srvDesc.Texture2DArray.PlaneSlice               = 0;
-                srvDesc.Texture2DArray.ResourceMinLODClamp      = 0.0f;
+                srvDesc.Texture2DArray.ResourceMinLODClamp      = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE2DMS:
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY:
-                srvDesc.Texture2DMSArray.FirstArraySlice        = 0;
+                srvDesc.Texture2DMSArray.FirstArraySlice        = baseArrayLayer_;
                 srvDesc.Texture2DMSArray.ArraySize              = numArrayLayers_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURE3D:
-                srvDesc.Texture3D.MostDetailedMip               = 0;
+                srvDesc.Texture3D.MostDetailedMip               = baseMipLevel_;
                 srvDesc.Texture3D.MipLevels                     = numMipLevels_;
-                srvDesc.Texture3D.ResourceMinLODClamp           = 0.0f;
+                srvDesc.Texture3D.ResourceMinLODClamp           = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURECUBE:
-                srvDesc.TextureCube.MostDetailedMip             = 0;
+                srvDesc.TextureCube.MostDetailedMip             = baseMipLevel_;
                 srvDesc.TextureCube.MipLevels                   = numMipLevels_;
-                srvDesc.TextureCube.ResourceMinLODClamp         = 0.0f;
+                srvDesc.TextureCube.ResourceMinLODClamp         = minLODClamp_;
                 break;
 
             case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY:
-                srvDesc.TextureCubeArray.MostDetailedMip        = 0;
+                srvDesc.TextureCubeArray.MostDetailedMip        = baseMipLevel_;
                 srvDesc.TextureCubeArray.MipLevels              = numMipLevels_;
-                srvDesc.TextureCubeArray.First2DArrayFace       = 0;
-                srvDesc.TextureCubeArray.NumCubes               = numArrayLayers_;
-                srvDesc.TextureCubeArray.ResourceMinLODClamp    = 0.0f;
+                srvDesc.TextureCubeArray.First2DArrayFace       = baseArrayLayer_;
+                srvDesc.TextureCubeArray.NumCubes               = numArrayLayers_ / 6;
+                srvDesc.TextureCubeArray.ResourceMinLODClamp    = minLODClamp_;
                 break;
 
             default:
@@ -314,18 +516,10 @@ void D3D12Texture::CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR
  * ======= Private: =======
  */
 
-void D3D12Texture::CreateResource(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc)
+void D3D12Texture::CreateResource(D3D12MemoryAllocator& allocator, const D3D12_RESOURCE_DESC& desc)
 {
-    /* Create hardware resource for the texture */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        nullptr,
-        IID_PPV_ARGS(resource_.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for texture");
+    /* Create hardware resource for the texture (placed within a heap, or committed for large and multi-sampled textures) */
+    resource_ = allocator.CreateTexture(desc, D3D12_RESOURCE_STATE_COPY_DEST, allocation_);
 }
 
 
@@ -12,36 +12,76 @@
 #include <LLGL/Texture.h>
 #include <d3d12.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../D3D12MemoryAllocator.h"
 
 
 namespace LLGL
 {
 
 
+class D3D12UploadHeap;
+class D3D12BarrierBatch;
+
 class D3D12Texture final : public Texture
 {
 
     public:
 
-        D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc);
+        // Creates a texture. If 'allowImageConversion' is true, the texture allows UAVs to convert image data on the GPU (see D3D12ImageConverter).
+        D3D12Texture(D3D12MemoryAllocator& allocator, const TextureDescriptor& desc, bool allowImageConversion = false);
+
+        // Creates a texture view that shares the resource of the specified texture. Resource states and residency are tracked by the shared texture.
+        D3D12Texture(const D3D12Texture& sharedTexture, const TextureViewDescriptor& desc);
 
         Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
 
         TextureDescriptor QueryDesc() const override;
 
+        void SetName(const char* name) override;
+
         /* ----- Extended internal functions ---- */
 
+        /*
+        Uploads the subresource data of the first 'numMipLevels' MIP levels via a single region of the upload heap.
+        'subresourceData' provides one entry for each MIP level of the first array layer, and the data of each subsequent array layer
+        is located at the end of the previous one (i.e. 'SlicePitch' bytes later). The transition for shader access is appended to the barrier batch.
+        */
         void UpdateSubresource(
-            ID3D12Device*               device,
-            ID3D12GraphicsCommandList*  commandList,
-            ComPtr<ID3D12Resource>&     uploadBuffer,
-            D3D12_SUBRESOURCE_DATA&     subresourceData,
-            UINT                        firstArrayLayer = 0,
-            UINT                        numArrayLayers  = ~0
+            ID3D12GraphicsCommandList*      commandList,
+            D3D12BarrierBatch&              barriers,
+            D3D12UploadHeap&                uploadHeap,
+            const D3D12_SUBRESOURCE_DATA*   subresourceData,
+            UINT                            numMipLevels    = 1,
+            UINT                            firstArrayLayer = 0,
+            UINT                            numArrayLayers  = ~0
         );
 
         void CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle);
 
+        // Sets the minimum LOD that is used as 'ResourceMinLODClamp' for all shader resource views that are created afterwards.
+        inline void SetMinLODClamp(float minLOD)
+        {
+            minLODClamp_ = minLOD;
+        }
+
+        // Appends a transition into the specified state to the barrier batch.
+        void TransitionResource(D3D12BarrierBatch& barriers, D3D12_RESOURCE_STATES newState);
+
+        // Appends a transition back into the state for shader access to the barrier batch.
+        void TransitionToUsageState(D3D12BarrierBatch& barriers);
+
+        // Appends the beginning of a split transition back into the state for shader access to the barrier batch, which ends with the next full flush.
+        void BeginTransitionToUsageState(D3D12BarrierBatch& barriers);
+
+        // Converts the texture region into the array layers and box of D3D12 subresources (array layers are specified by the Z component, or Y for 1D-array textures).
+        void GetSubresourceRegion(
+            const Offset3D& offset,
+            const Extent3D& extent,
+            UINT&           baseArrayLayer,
+            UINT&           numArrayLayers,
+            D3D12_BOX&      box
+        ) const;
+
         //! Returns the native ID3D12Resource object.
         inline ID3D12Resource* GetNative() const
         {
@@ -66,15 +106,44 @@ class D3D12Texture final : public Texture
             return numArrayLayers_;
         }
 
+        // Returns the format of the UAVs to generate MIP-maps and convert image data, or DXGI_FORMAT_UNKNOWN if this texture does not allow UAVs.
+        inline DXGI_FORMAT GetUAVFormat() const
+        {
+            return uavFormat_;
+        }
+
+        // Returns the memory allocation of this texture, which must be released with the memory allocator.
+        inline D3D12MemoryAllocation& GetMemoryAllocation()
+        {
+            return allocation_;
+        }
+
+        // Returns the residency state of the memory of this texture (for texture views, this is the residency state of the shared texture).
+        inline D3D12ResidencyEntry* GetResidencyEntry() const
+        {
+            return (sharedTexture_ != nullptr ? sharedTexture_->GetResidencyEntry() : allocation_.residencyEntry);
+        }
+
     private:
 
-        void CreateResource(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc);
+        void CreateResource(D3D12MemoryAllocator& allocator, const D3D12_RESOURCE_DESC& desc);
 
         ComPtr<ID3D12Resource>  resource_;
+        D3D12_RESOURCE_STATES   resourceState_  = D3D12_RESOURCE_STATE_COPY_DEST;
 
         DXGI_FORMAT             format_         = DXGI_FORMAT_UNKNOWN;
         UINT                    numMipLevels_   = 0;
         UINT                    numArrayLayers_ = 0;
+        DXGI_FORMAT             uavFormat_      = DXGI_FORMAT_UNKNOWN;
+        FLOAT                   minLODClamp_    = 0.0f;
+
+        D3D12MemoryAllocation   allocation_;
+
+        /* Texture view parameters */
+        const D3D12Texture*     sharedTexture_      = nullptr;
+        UINT                    baseMipLevel_       = 0;
+        UINT                    baseArrayLayer_     = 0;
+        UINT                    componentMapping_   = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 
 };
 
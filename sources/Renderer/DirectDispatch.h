@@ -0,0 +1,131 @@
+/*
+ * DirectDispatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_BACKEND_DIRECT_DISPATCH
+
+
+// THIS FILE MUST NOT HAVE A HEADER GUARD
+
+/*
+Implements the hot command buffer functions that are not virtual with LLGL_BACKEND_DIRECT_DISPATCH (see LLGL_DISPATCH_VIRTUAL).
+This file must be included at the end of the source file that implements the command buffer class of the only render system,
+after LLGL_DIRECT_DISPATCH_CLASS has been defined to that class, e.g.:
+    #define LLGL_DIRECT_DISPATCH_CLASS VKCommandBuffer
+    #include "../DirectDispatch.h"
+Each function calls the backend implementation non-virtually, so the compiler can inline it into these functions.
+*/
+
+
+#ifndef LLGL_DIRECT_DISPATCH_CLASS
+#   error Missing definition of LLGL_DIRECT_DISPATCH_CLASS
+#endif
+
+#define LLGL_DIRECT_DISPATCH(FUNC, ARGS) \
+    static_cast<LLGL_DIRECT_DISPATCH_CLASS*>(this)->LLGL_DIRECT_DISPATCH_CLASS::FUNC ARGS
+
+
+namespace LLGL
+{
+
+
+/* ----- Viewport and Scissor ----- */
+
+void CommandBuffer::SetViewport(const Viewport& viewport)
+{
+    LLGL_DIRECT_DISPATCH(SetViewport, (viewport));
+}
+
+void CommandBuffer::SetScissor(const Scissor& scissor)
+{
+    LLGL_DIRECT_DISPATCH(SetScissor, (scissor));
+}
+
+/* ----- Input Assembly ------ */
+
+void CommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    LLGL_DIRECT_DISPATCH(SetVertexBuffer, (buffer));
+}
+
+void CommandBuffer::SetIndexBuffer(Buffer& buffer)
+{
+    LLGL_DIRECT_DISPATCH(SetIndexBuffer, (buffer));
+}
+
+/* ----- Pipeline States ----- */
+
+void CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    LLGL_DIRECT_DISPATCH(SetGraphicsPipeline, (graphicsPipeline));
+}
+
+void CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    LLGL_DIRECT_DISPATCH(SetComputePipeline, (computePipeline));
+}
+
+/* ----- Drawing ----- */
+
+void CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_DIRECT_DISPATCH(Draw, (numVertices, firstVertex));
+}
+
+void CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_DIRECT_DISPATCH(DrawIndexed, (numIndices, firstIndex));
+}
+
+void CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_DIRECT_DISPATCH(DrawIndexed, (numIndices, firstIndex, vertexOffset));
+}
+
+void CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_DIRECT_DISPATCH(DrawInstanced, (numVertices, firstVertex, numInstances));
+}
+
+void CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_DIRECT_DISPATCH(DrawInstanced, (numVertices, firstVertex, numInstances, firstInstance));
+}
+
+void CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_DIRECT_DISPATCH(DrawIndexedInstanced, (numIndices, numInstances, firstIndex));
+}
+
+void CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_DIRECT_DISPATCH(DrawIndexedInstanced, (numIndices, numInstances, firstIndex, vertexOffset));
+}
+
+void CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_DIRECT_DISPATCH(DrawIndexedInstanced, (numIndices, numInstances, firstIndex, vertexOffset, firstInstance));
+}
+
+/* ----- Compute ----- */
+
+void CommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_DIRECT_DISPATCH(Dispatch, (groupSizeX, groupSizeY, groupSizeZ));
+}
+
+
+} // /namespace LLGL
+
+
+#undef LLGL_DIRECT_DISPATCH
+
+
+#endif // /LLGL_BACKEND_DIRECT_DISPATCH
+
+
+
+// ================================================================================
@@ -0,0 +1,196 @@
+/*
+ * DrawQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/DrawQueue.h>
+#include <LLGL/CommandBuffer.h>
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+// Minimal number of draw packets per thread to sort a queue with multiple threads.
+static const std::size_t g_sortGrainSize = 16384;
+
+// Number of buckets per radix sort pass, i.e. one pass per byte of the sort keys.
+static const std::size_t g_numRadixBuckets = 256;
+
+void DrawQueue::Clear()
+{
+    packets_.clear();
+}
+
+void DrawQueue::Reserve(std::size_t numPackets)
+{
+    packets_.reserve(numPackets);
+}
+
+void DrawQueue::Push(const DrawPacket& packet)
+{
+    packets_.push_back(packet);
+}
+
+void DrawQueue::Sort()
+{
+    const auto numPackets = packets_.size();
+    if (numPackets < 2)
+        return;
+
+    /* Gather sort keys and determine in which bytes they differ at all */
+    entries_.resize(numPackets);
+    entriesTemp_.resize(numPackets);
+
+    std::uint64_t diffBits = 0;
+    for (std::size_t i = 0; i < numPackets; ++i)
+    {
+        entries_[i].sortKey = packets_[i].sortKey;
+        entries_[i].index   = static_cast<std::uint32_t>(i);
+        diffBits |= (packets_[i].sortKey ^ packets_[0].sortKey);
+    }
+
+    if (diffBits == 0)
+        return;
+
+    /* Split entries into one chunk per thread; each chunk has its own histogram, so the passes stay stable */
+    const auto maxThreads   = std::max(1u, std::thread::hardware_concurrency());
+    const auto numChunks    = std::max<std::size_t>(1, std::min<std::size_t>(maxThreads, numPackets / g_sortGrainSize));
+    const auto chunkSize    = (numPackets + numChunks - 1) / numChunks;
+
+    std::vector<std::size_t> histograms(numChunks * g_numRadixBuckets);
+
+    auto& threadPool = ThreadPool::Get();
+
+    for (std::uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        /* Skip all passes over bytes that are equal in all sort keys */
+        if (((diffBits >> shift) & 0xFF) == 0)
+            continue;
+
+        /* Count digits of each chunk */
+        std::fill(histograms.begin(), histograms.end(), 0);
+
+        threadPool.ParallelFor(
+            numChunks, 1, numChunks,
+            [&](std::size_t chunkBegin, std::size_t chunkEnd)
+            {
+                for (auto chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+                {
+                    auto histogram = &histograms[chunk * g_numRadixBuckets];
+                    for (auto i = chunk * chunkSize, n = std::min(i + chunkSize, numPackets); i < n; ++i)
+                        ++histogram[(entries_[i].sortKey >> shift) & 0xFF];
+                }
+            }
+        );
+
+        /* Convert counts into output offsets, ordered by digit first and chunk second */
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < g_numRadixBuckets; ++digit)
+        {
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                auto& count = histograms[chunk * g_numRadixBuckets + digit];
+                const auto n = count;
+                count = offset;
+                offset += n;
+            }
+        }
+
+        /* Scatter entries of each chunk into their buckets */
+        threadPool.ParallelFor(
+            numChunks, 1, numChunks,
+            [&](std::size_t chunkBegin, std::size_t chunkEnd)
+            {
+                for (auto chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+                {
+                    auto offsets = &histograms[chunk * g_numRadixBuckets];
+                    for (auto i = chunk * chunkSize, n = std::min(i + chunkSize, numPackets); i < n; ++i)
+                        entriesTemp_[offsets[(entries_[i].sortKey >> shift) & 0xFF]++] = entries_[i];
+                }
+            }
+        );
+
+        entries_.swap(entriesTemp_);
+    }
+
+    /* Reorder draw packets by the sorted entries */
+    std::vector<DrawPacket> sortedPackets;
+    sortedPackets.reserve(packets_.capacity());
+
+    for (const auto& entry : entries_)
+        sortedPackets.push_back(packets_[entry.index]);
+
+    packets_.swap(sortedPackets);
+}
+
+void DrawQueue::Submit(CommandBuffer& commandBuffer) const
+{
+    GraphicsPipeline*   boundPipeline       = nullptr;
+    ResourceHeap*       boundResourceHeap   = nullptr;
+    Buffer*             boundVertexBuffer   = nullptr;
+    Buffer*             boundIndexBuffer    = nullptr;
+
+    for (const auto& packet : packets_)
+    {
+        if (packet.pipeline == nullptr)
+            throw std::invalid_argument("cannot submit draw packet without graphics pipeline");
+
+        /* Bind states that differ from the previous draw packet */
+        if (packet.pipeline != boundPipeline)
+        {
+            commandBuffer.SetGraphicsPipeline(*packet.pipeline);
+            boundPipeline       = packet.pipeline;
+            boundResourceHeap   = nullptr;
+        }
+
+        if (packet.resourceHeap != nullptr && packet.resourceHeap != boundResourceHeap)
+        {
+            commandBuffer.SetGraphicsResourceHeap(*packet.resourceHeap);
+            boundResourceHeap = packet.resourceHeap;
+        }
+
+        if (packet.vertexBuffer != nullptr && packet.vertexBuffer != boundVertexBuffer)
+        {
+            commandBuffer.SetVertexBuffer(*packet.vertexBuffer);
+            boundVertexBuffer = packet.vertexBuffer;
+        }
+
+        /* Draw with the simplest overload that covers the arguments */
+        if (packet.indexBuffer != nullptr)
+        {
+            if (packet.indexBuffer != boundIndexBuffer)
+            {
+                commandBuffer.SetIndexBuffer(*packet.indexBuffer);
+                boundIndexBuffer = packet.indexBuffer;
+            }
+
+            if (packet.firstInstance != 0)
+                commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset, packet.firstInstance);
+            else if (packet.numInstances != 1)
+                commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset);
+            else
+                commandBuffer.DrawIndexed(packet.numVertices, packet.firstVertex, packet.vertexOffset);
+        }
+        else
+        {
+            if (packet.firstInstance != 0 || packet.numInstances != 1)
+                commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances, packet.firstInstance);
+            else
+                commandBuffer.Draw(packet.numVertices, packet.firstVertex);
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
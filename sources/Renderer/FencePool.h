@@ -0,0 +1,87 @@
+/*
+ * FencePool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_FENCE_POOL_H
+#define LLGL_FENCE_POOL_H
+
+
+#include "ContainerTypes.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of released fences a fence pool keeps for recycling. Fences that are released while the pool is full are destroyed.
+static const std::size_t g_maxFencePoolSize = 32;
+
+/*
+Pool of released fences, which are recycled by subsequent fence creations instead of allocating a new native fence object each time.
+A fence is only handed out again once the GPU no longer references it, which is determined by the 'IsIdle' function of the fence type,
+and its 'Recycle' function must reset it to the state of a newly created fence.
+*/
+template <typename T>
+class FencePool
+{
+
+    public:
+
+        FencePool() = default;
+
+        FencePool(const FencePool&) = delete;
+        FencePool& operator = (const FencePool&) = delete;
+
+        // Takes the ownership of the specified fence from the container and keeps it for recycling.
+        template <typename TBase>
+        void Release(HWObjectContainer<T>& cont, const TBase* entry)
+        {
+            if (auto fence = cont.Take(static_cast<const T*>(entry)))
+            {
+                if (fences_.size() < g_maxFencePoolSize)
+                    fences_.emplace_back(std::move(fence));
+            }
+        }
+
+        // Returns a recycled fence the GPU is done with, or null if there is none.
+        HWObjectInstance<T> Acquire()
+        {
+            for (auto it = fences_.begin(); it != fences_.end(); ++it)
+            {
+                if ((*it)->IsIdle())
+                {
+                    auto fence = std::move(*it);
+                    fences_.erase(it);
+                    fence->Recycle();
+                    return fence;
+                }
+            }
+            return nullptr;
+        }
+
+        // Destroys all fences of this pool.
+        void Clear()
+        {
+            fences_.clear();
+        }
+
+    private:
+
+        std::vector<HWObjectInstance<T>> fences_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -68,6 +68,11 @@ LLGL_EXPORT std::uint32_t FormatBitSize(const Format format)
         case Format::RGB64Float:        return 192;
         case Format::RGBA64Float:       return 256;
 
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      return 32;
+        case Format::RGB10A2UInt:       return 32;
+        case Format::RG11B10Float:      return 32;
+
         /* --- Depth-stencil formats --- */
         case Format::D16UNorm:          return 16;  // 16-bit depth
         case Format::D32Float:          return 32;  // 32-bit depth
@@ -79,9 +84,95 @@ LLGL_EXPORT std::uint32_t FormatBitSize(const Format format)
         case Format::BC1RGBA:           return 4;   // 64-bit per 4x4 block
         case Format::BC2RGBA:           return 8;   // 128-bit per 4x4 block
         case Format::BC3RGBA:           return 8;   // 128-bit per 4x4 block
+        case Format::BC1RGBAsRGB:       return 4;   // 64-bit per 4x4 block
+        case Format::BC2RGBAsRGB:       return 8;   // 128-bit per 4x4 block
+        case Format::BC3RGBAsRGB:       return 8;   // 128-bit per 4x4 block
+        case Format::BC4RUNorm:         return 4;   // 64-bit per 4x4 block
+        case Format::BC4RSNorm:         return 4;   // 64-bit per 4x4 block
+        case Format::BC5RGUNorm:        return 8;   // 128-bit per 4x4 block
+        case Format::BC5RGSNorm:        return 8;   // 128-bit per 4x4 block
+        case Format::BC6HRGBUFloat:     return 8;   // 128-bit per 4x4 block
+        case Format::BC6HRGBSFloat:     return 8;   // 128-bit per 4x4 block
+        case Format::BC7RGBAUNorm:      return 8;   // 128-bit per 4x4 block
+        case Format::BC7RGBAsRGB:       return 8;   // 128-bit per 4x4 block
+
+        /* --- ETC2/EAC compressed color formats --- */
+        case Format::ETC2RGB8UNorm:     return 4;   // 64-bit per 4x4 block
+        case Format::ETC2RGB8sRGB:      return 4;   // 64-bit per 4x4 block
+        case Format::ETC2RGB8A1UNorm:   return 4;   // 64-bit per 4x4 block
+        case Format::ETC2RGB8A1sRGB:    return 4;   // 64-bit per 4x4 block
+        case Format::ETC2RGBA8UNorm:    return 8;   // 128-bit per 4x4 block
+        case Format::ETC2RGBA8sRGB:     return 8;   // 128-bit per 4x4 block
+        case Format::EACR11UNorm:       return 4;   // 64-bit per 4x4 block
+        case Format::EACR11SNorm:       return 4;   // 64-bit per 4x4 block
+        case Format::EACRG11UNorm:      return 8;   // 128-bit per 4x4 block
+        case Format::EACRG11SNorm:      return 8;   // 128-bit per 4x4 block
+
+        default:                        break;
+    }
 
-        default:                        return 0;
+    if (IsCompressedFormatASTC(format))
+    {
+        /* Round up bits per texel of 128-bit ASTC blocks */
+        const auto blockExtent = FormatBlockExtent(format);
+        const auto blockTexels = blockExtent.width * blockExtent.height;
+        return ((128 + blockTexels - 1) / blockTexels);
+    }
+
+    return 0;
+}
+
+LLGL_EXPORT std::uint32_t FormatBlockSize(const Format format)
+{
+    /* ASTC blocks always have 128 bits, all other compressed formats have blocks of 4x4 texels */
+    if (IsCompressedFormatASTC(format))
+        return 16;
+    if (IsCompressedFormat(format))
+        return (FormatBitSize(format) * 16 / 8);
+
+    const auto bitSize = FormatBitSize(format);
+    return (bitSize % 8 == 0 ? bitSize / 8 : 0);
+}
+
+LLGL_EXPORT Extent2D FormatBlockExtent(const Format format)
+{
+    switch (format)
+    {
+        case Format::ASTC4x4UNorm:      /*pass*/
+        case Format::ASTC4x4sRGB:       return Extent2D{ 4, 4 };
+        case Format::ASTC5x4UNorm:      /*pass*/
+        case Format::ASTC5x4sRGB:       return Extent2D{ 5, 4 };
+        case Format::ASTC5x5UNorm:      /*pass*/
+        case Format::ASTC5x5sRGB:       return Extent2D{ 5, 5 };
+        case Format::ASTC6x5UNorm:      /*pass*/
+        case Format::ASTC6x5sRGB:       return Extent2D{ 6, 5 };
+        case Format::ASTC6x6UNorm:      /*pass*/
+        case Format::ASTC6x6sRGB:       return Extent2D{ 6, 6 };
+        case Format::ASTC8x5UNorm:      /*pass*/
+        case Format::ASTC8x5sRGB:       return Extent2D{ 8, 5 };
+        case Format::ASTC8x6UNorm:      /*pass*/
+        case Format::ASTC8x6sRGB:       return Extent2D{ 8, 6 };
+        case Format::ASTC8x8UNorm:      /*pass*/
+        case Format::ASTC8x8sRGB:       return Extent2D{ 8, 8 };
+        case Format::ASTC10x5UNorm:     /*pass*/
+        case Format::ASTC10x5sRGB:      return Extent2D{ 10, 5 };
+        case Format::ASTC10x6UNorm:     /*pass*/
+        case Format::ASTC10x6sRGB:      return Extent2D{ 10, 6 };
+        case Format::ASTC10x8UNorm:     /*pass*/
+        case Format::ASTC10x8sRGB:      return Extent2D{ 10, 8 };
+        case Format::ASTC10x10UNorm:    /*pass*/
+        case Format::ASTC10x10sRGB:     return Extent2D{ 10, 10 };
+        case Format::ASTC12x10UNorm:    /*pass*/
+        case Format::ASTC12x10sRGB:     return Extent2D{ 12, 10 };
+        case Format::ASTC12x12UNorm:    /*pass*/
+        case Format::ASTC12x12sRGB:     return Extent2D{ 12, 12 };
+        default:                        break;
     }
+
+    if (IsCompressedFormat(format))
+        return Extent2D{ 4, 4 };
+    else
+        return Extent2D{ 1, 1 };
 }
 
 static std::tuple<DataType, std::uint32_t> SplitFormatPrimary(const Format format)
@@ -158,6 +249,11 @@ static std::tuple<DataType, std::uint32_t> SplitFormatPrimary(const Format forma
         case Format::RGB64Float:        return T{ DataType::Float64, 3 };
         case Format::RGBA64Float:       return T{ DataType::Float64, 4 };
 
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      break;
+        case Format::RGB10A2UInt:       break;
+        case Format::RG11B10Float:      break;
+
         /* --- Depth-stencil formats --- */
         case Format::D16UNorm:          break;
         case Format::D32Float:          break;
@@ -169,6 +265,57 @@ static std::tuple<DataType, std::uint32_t> SplitFormatPrimary(const Format forma
         case Format::BC1RGBA:           break;
         case Format::BC2RGBA:           break;
         case Format::BC3RGBA:           break;
+        case Format::BC1RGBAsRGB:       break;
+        case Format::BC2RGBAsRGB:       break;
+        case Format::BC3RGBAsRGB:       break;
+        case Format::BC4RUNorm:         break;
+        case Format::BC4RSNorm:         break;
+        case Format::BC5RGUNorm:        break;
+        case Format::BC5RGSNorm:        break;
+        case Format::BC6HRGBUFloat:     break;
+        case Format::BC6HRGBSFloat:     break;
+        case Format::BC7RGBAUNorm:      break;
+        case Format::BC7RGBAsRGB:       break;
+
+        /* --- ETC2/EAC and ASTC compressed color formats --- */
+        case Format::ETC2RGB8UNorm:     break;
+        case Format::ETC2RGB8sRGB:      break;
+        case Format::ETC2RGB8A1UNorm:   break;
+        case Format::ETC2RGB8A1sRGB:    break;
+        case Format::ETC2RGBA8UNorm:    break;
+        case Format::ETC2RGBA8sRGB:     break;
+        case Format::EACR11UNorm:       break;
+        case Format::EACR11SNorm:       break;
+        case Format::EACRG11UNorm:      break;
+        case Format::EACRG11SNorm:      break;
+        case Format::ASTC4x4UNorm:      break;
+        case Format::ASTC4x4sRGB:       break;
+        case Format::ASTC5x4UNorm:      break;
+        case Format::ASTC5x4sRGB:       break;
+        case Format::ASTC5x5UNorm:      break;
+        case Format::ASTC5x5sRGB:       break;
+        case Format::ASTC6x5UNorm:      break;
+        case Format::ASTC6x5sRGB:       break;
+        case Format::ASTC6x6UNorm:      break;
+        case Format::ASTC6x6sRGB:       break;
+        case Format::ASTC8x5UNorm:      break;
+        case Format::ASTC8x5sRGB:       break;
+        case Format::ASTC8x6UNorm:      break;
+        case Format::ASTC8x6sRGB:       break;
+        case Format::ASTC8x8UNorm:      break;
+        case Format::ASTC8x8sRGB:       break;
+        case Format::ASTC10x5UNorm:     break;
+        case Format::ASTC10x5sRGB:      break;
+        case Format::ASTC10x6UNorm:     break;
+        case Format::ASTC10x6sRGB:      break;
+        case Format::ASTC10x8UNorm:     break;
+        case Format::ASTC10x8sRGB:      break;
+        case Format::ASTC10x10UNorm:    break;
+        case Format::ASTC10x10sRGB:     break;
+        case Format::ASTC12x10UNorm:    break;
+        case Format::ASTC12x10sRGB:     break;
+        case Format::ASTC12x12UNorm:    break;
+        case Format::ASTC12x12sRGB:     break;
     }
 
     /* Return an invalid image format */
@@ -195,7 +342,22 @@ LLGL_EXPORT bool SplitFormat(const Format format, DataType& dataType, std::uint3
 
 LLGL_EXPORT bool IsCompressedFormat(const Format format)
 {
-    return (format >= Format::BC1RGB && format <= Format::BC3RGBA);
+    return (format >= Format::BC1RGB && format <= Format::ASTC12x12sRGB);
+}
+
+LLGL_EXPORT bool IsCompressedFormatBC(const Format format)
+{
+    return (format >= Format::BC1RGB && format <= Format::BC7RGBAsRGB);
+}
+
+LLGL_EXPORT bool IsCompressedFormatETC2(const Format format)
+{
+    return (format >= Format::ETC2RGB8UNorm && format <= Format::EACRG11SNorm);
+}
+
+LLGL_EXPORT bool IsCompressedFormatASTC(const Format format)
+{
+    return (format >= Format::ASTC4x4UNorm && format <= Format::ASTC12x12sRGB);
 }
 
 LLGL_EXPORT bool IsDepthStencilFormat(const Format format)
@@ -224,6 +386,7 @@ LLGL_EXPORT bool IsNormalizedFormat(const Format format)
         case Format::RGBA16UNorm:
         case Format::RGBA16SNorm:
         case Format::BGRA8UNorm:
+        case Format::RGB10A2UNorm:
             return true;
         default:
             return false;
@@ -232,7 +395,7 @@ LLGL_EXPORT bool IsNormalizedFormat(const Format format)
 
 LLGL_EXPORT bool IsIntegralFormat(const Format format)
 {
-    if (format >= Format::R8UNorm && format <= Format::BGRA8sRGB)
+    if (format >= Format::R8UNorm && format <= Format::RG11B10Float)
         return !IsFloatFormat(format);
     else
         return false;
@@ -254,6 +417,7 @@ LLGL_EXPORT bool IsFloatFormat(const Format format)
         case Format::RG64Float:
         case Format::RGB64Float:
         case Format::RGBA64Float:
+        case Format::RG11B10Float:
             return true;
         default:
             return false;
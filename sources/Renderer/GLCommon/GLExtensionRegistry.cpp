@@ -6,23 +6,69 @@
  */
 
 #include "GLExtensionRegistry.h"
+#include <LLGL/Log.h>
 #include <array>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
-static std::array<bool, static_cast<std::size_t>(GLExt::Count)> g_registeredExtensions { { false } };
+GLExtensionBitset g_loadedExtensions;
+GLExtensionBitset g_deferredExtensions;
+
+static std::array<GLExtensionLoadingProc, static_cast<std::size_t>(GLExt::Count)> g_deferredLoadingProcs { { nullptr } };
+static std::array<std::once_flag, static_cast<std::size_t>(GLExt::Count)>         g_deferredLoadingFlags;
+static std::array<bool, static_cast<std::size_t>(GLExt::Count)>                   g_deferredLoadingResults { { false } };
 
 void RegisterExtension(GLExt extension)
 {
-    g_registeredExtensions[static_cast<std::size_t>(extension)] = true;
+    g_loadedExtensions.set(static_cast<std::size_t>(extension));
+}
+
+void RegisterDeferredExtension(GLExt extension, GLExtensionLoadingProc loadingProc)
+{
+    const auto idx = static_cast<std::size_t>(extension);
+    g_deferredExtensions.set(idx);
+    g_deferredLoadingProcs[idx] = loadingProc;
 }
 
-bool HasExtension(const GLExt extension)
+static bool LoadDeferredExtensionOnce(std::size_t idx)
 {
-    return g_registeredExtensions[static_cast<std::size_t>(extension)];
+    auto loadingProc = g_deferredLoadingProcs[idx];
+
+    if (loadingProc != nullptr && loadingProc(false))
+        return true;
+
+    #ifdef LLGL_GL_ENABLE_EXT_PLACEHOLDERS
+    /* Keep dummy procedures to detect illegal use of OpenGL extension */
+    if (loadingProc != nullptr)
+        loadingProc(true);
+    #endif
+
+    Log::StdErr() << "failed to load deferred OpenGL extension (ID = " << idx << ")" << std::endl;
+
+    return false;
+}
+
+bool LoadDeferredExtension(GLExt extension)
+{
+    const auto idx = static_cast<std::size_t>(extension);
+
+    /*
+    Only try to load deferred entry points once. Worker contexts can query extensions concurrently,
+    so the registry bitsets are never modified here and the result is published by the once-flag instead.
+    */
+    std::call_once(
+        g_deferredLoadingFlags[idx],
+        [idx]()
+        {
+            g_deferredLoadingResults[idx] = LoadDeferredExtensionOnce(idx);
+        }
+    );
+
+    return g_deferredLoadingResults[idx];
 }
 
 
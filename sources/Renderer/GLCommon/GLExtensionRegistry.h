@@ -9,6 +9,10 @@
 #define LLGL_GL_EXTENSION_REGISTRY_H
 
 
+#include <bitset>
+#include <cstddef>
+
+
 namespace LLGL
 {
 
@@ -35,9 +39,18 @@ enum class GLExt
     ARB_instanced_arrays,
     ARB_vertex_array_object,
     ARB_framebuffer_object,
+    ARB_invalidate_subdata,
+    ARB_copy_buffer,
+    ARB_clear_buffer_object,
+    ARB_map_buffer_range,
+    ARB_copy_image,
+    ARB_get_texture_sub_image,
     ARB_draw_instanced,
     ARB_draw_elements_base_vertex,
+    EXT_multi_draw_arrays,
     ARB_base_instance,
+    ARB_draw_indirect,
+    ARB_multi_draw_indirect,
     ARB_shader_objects,
     ARB_tessellation_shader,
     ARB_compute_shader,
@@ -51,9 +64,12 @@ enum class GLExt
     ARB_viewport_array,
     EXT_stencil_two_side,//ATI_separate_stencil,
     KHR_debug,
+    KHR_parallel_shader_compile,
     ARB_clip_control,
     EXT_transform_feedback,
     NV_transform_feedback,
+    ARB_transform_feedback2,
+    ARB_transform_feedback3,
     EXT_gpu_shader4,
     ARB_pipeline_statistics_query,
     ARB_sync,
@@ -69,6 +85,14 @@ enum class GLExt
     ARB_texture_view,
     ARB_shader_image_load_store,
     ARB_framebuffer_no_attachments,
+    ARB_bindless_texture,
+    ARB_vertex_attrib_binding,
+    ARB_sparse_texture,
+    NV_shading_rate_image,
+    OVR_multiview,
+    ARB_separate_shader_objects,
+    EXT_depth_bounds_test,
+    NV_mesh_shader,
 
     /* Extensions without procedures */
     ARB_texture_cube_map,
@@ -77,17 +101,58 @@ enum class GLExt
     ARB_geometry_shader4,
     NV_conservative_raster,
     INTEL_conservative_rasterization,
+    ARB_query_buffer_object,
+    ARB_shader_atomic_counters,
+    EXT_texture_compression_s3tc,
+    EXT_texture_sRGB,
+    ARB_texture_compression_rgtc,
+    ARB_texture_compression_bptc,
+    ARB_ES3_compatibility,
+    KHR_texture_compression_astc_ldr,
+    NVX_gpu_memory_info,
+    ATI_meminfo,
+    OVR_multiview2,
+    KHR_shader_subgroup,
 
     /* Enumeration entry counter */
     Count,
 };
 
 
-// Registers the specified OpenGL extension support.
+// Bitset of OpenGL extensions, indexed by the GLExt enumeration.
+using GLExtensionBitset = std::bitset<static_cast<std::size_t>(GLExt::Count)>;
+
+// Procedure to load all entry points of an OpenGL extension (or their placeholders if 'usePlaceholder' is true).
+using GLExtensionLoadingProc = bool (*)(bool usePlaceholder);
+
+// Supported OpenGL extensions whose entry points have been loaded.
+extern GLExtensionBitset g_loadedExtensions;
+
+// Supported OpenGL extensions whose entry points are loaded on first use. Both bitsets are only modified while the extensions are loaded.
+extern GLExtensionBitset g_deferredExtensions;
+
+// Registers the specified OpenGL extension support. Its entry points must already be loaded.
 void RegisterExtension(GLExt extension);
 
-// Returns true if the specified OpenGL extension is supported.
-bool HasExtension(const GLExt extension);
+// Registers the specified OpenGL extension support, but defers loading its entry points until the first call to 'HasExtension'.
+void RegisterDeferredExtension(GLExt extension, GLExtensionLoadingProc loadingProc);
+
+// Loads the entry points of the specified deferred OpenGL extension and returns true on success. This is thread-safe and loads each extension only once.
+bool LoadDeferredExtension(GLExt extension);
+
+// Returns true if the specified OpenGL extension is supported and loads its entry points if they have been deferred.
+inline bool HasExtension(const GLExt extension)
+{
+    const auto idx = static_cast<std::size_t>(extension);
+    return (g_loadedExtensions[idx] || (g_deferredExtensions[idx] && LoadDeferredExtension(extension)));
+}
+
+// Returns true if the specified OpenGL extension is supported, without loading any deferred entry points.
+inline bool IsExtensionSupported(const GLExt extension)
+{
+    const auto idx = static_cast<std::size_t>(extension);
+    return (g_loadedExtensions[idx] || g_deferredExtensions[idx]);
+}
 
 
 } // /namespace LLGL
@@ -122,6 +122,11 @@ GLenum MapOrZero(const Format format)
         case Format::BGRA8SInt:         return 0;
         case Format::BGRA8sRGB:         return 0;
 
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      return GL_RGB10_A2;
+        case Format::RGB10A2UInt:       return GL_RGB10_A2UI;
+        case Format::RG11B10Float:      return GL_R11F_G11F_B10F;
+
         /* --- Depth-stencil formats --- */
         case Format::D16UNorm:          return GL_DEPTH_COMPONENT16;
         case Format::D32Float:          return GL_DEPTH_COMPONENT32;//GL_DEPTH_COMPONENT;
@@ -136,6 +141,72 @@ GLenum MapOrZero(const Format format)
         case Format::BC3RGBA:           return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
         #endif
 
+        #ifdef GL_EXT_texture_sRGB
+        case Format::BC1RGBAsRGB:       return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case Format::BC2RGBAsRGB:       return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+        case Format::BC3RGBAsRGB:       return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        #endif
+
+        #ifdef GL_ARB_texture_compression_rgtc
+        case Format::BC4RUNorm:         return GL_COMPRESSED_RED_RGTC1;
+        case Format::BC4RSNorm:         return GL_COMPRESSED_SIGNED_RED_RGTC1;
+        case Format::BC5RGUNorm:        return GL_COMPRESSED_RG_RGTC2;
+        case Format::BC5RGSNorm:        return GL_COMPRESSED_SIGNED_RG_RGTC2;
+        #endif
+
+        #ifdef GL_ARB_texture_compression_bptc
+        case Format::BC6HRGBUFloat:     return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+        case Format::BC6HRGBSFloat:     return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+        case Format::BC7RGBAUNorm:      return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case Format::BC7RGBAsRGB:       return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+        #endif
+
+        #if defined GL_ARB_ES3_compatibility || defined GL_ES_VERSION_3_0
+        /* --- ETC2/EAC compressed color formats --- */
+        case Format::ETC2RGB8UNorm:     return GL_COMPRESSED_RGB8_ETC2;
+        case Format::ETC2RGB8sRGB:      return GL_COMPRESSED_SRGB8_ETC2;
+        case Format::ETC2RGB8A1UNorm:   return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case Format::ETC2RGB8A1sRGB:    return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case Format::ETC2RGBA8UNorm:    return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case Format::ETC2RGBA8sRGB:     return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+        case Format::EACR11UNorm:       return GL_COMPRESSED_R11_EAC;
+        case Format::EACR11SNorm:       return GL_COMPRESSED_SIGNED_R11_EAC;
+        case Format::EACRG11UNorm:      return GL_COMPRESSED_RG11_EAC;
+        case Format::EACRG11SNorm:      return GL_COMPRESSED_SIGNED_RG11_EAC;
+        #endif
+
+        #ifdef GL_KHR_texture_compression_astc_ldr
+        /* --- ASTC compressed color formats --- */
+        case Format::ASTC4x4UNorm:      return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case Format::ASTC4x4sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+        case Format::ASTC5x4UNorm:      return GL_COMPRESSED_RGBA_ASTC_5x4_KHR;
+        case Format::ASTC5x4sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR;
+        case Format::ASTC5x5UNorm:      return GL_COMPRESSED_RGBA_ASTC_5x5_KHR;
+        case Format::ASTC5x5sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR;
+        case Format::ASTC6x5UNorm:      return GL_COMPRESSED_RGBA_ASTC_6x5_KHR;
+        case Format::ASTC6x5sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR;
+        case Format::ASTC6x6UNorm:      return GL_COMPRESSED_RGBA_ASTC_6x6_KHR;
+        case Format::ASTC6x6sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR;
+        case Format::ASTC8x5UNorm:      return GL_COMPRESSED_RGBA_ASTC_8x5_KHR;
+        case Format::ASTC8x5sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR;
+        case Format::ASTC8x6UNorm:      return GL_COMPRESSED_RGBA_ASTC_8x6_KHR;
+        case Format::ASTC8x6sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR;
+        case Format::ASTC8x8UNorm:      return GL_COMPRESSED_RGBA_ASTC_8x8_KHR;
+        case Format::ASTC8x8sRGB:       return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR;
+        case Format::ASTC10x5UNorm:     return GL_COMPRESSED_RGBA_ASTC_10x5_KHR;
+        case Format::ASTC10x5sRGB:      return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR;
+        case Format::ASTC10x6UNorm:     return GL_COMPRESSED_RGBA_ASTC_10x6_KHR;
+        case Format::ASTC10x6sRGB:      return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR;
+        case Format::ASTC10x8UNorm:     return GL_COMPRESSED_RGBA_ASTC_10x8_KHR;
+        case Format::ASTC10x8sRGB:      return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR;
+        case Format::ASTC10x10UNorm:    return GL_COMPRESSED_RGBA_ASTC_10x10_KHR;
+        case Format::ASTC10x10sRGB:     return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR;
+        case Format::ASTC12x10UNorm:    return GL_COMPRESSED_RGBA_ASTC_12x10_KHR;
+        case Format::ASTC12x10sRGB:     return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR;
+        case Format::ASTC12x12UNorm:    return GL_COMPRESSED_RGBA_ASTC_12x12_KHR;
+        case Format::ASTC12x12sRGB:     return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR;
+        #endif
+
         default:                        return 0;
     }
 }
@@ -474,6 +545,10 @@ GLenum Map(const ShaderType shaderType)
         #if defined(GL_VERSION_4_3) || defined(GL_ES_VERSION_3_1)
         case ShaderType::Compute:           return GL_COMPUTE_SHADER;
         #endif
+        #ifdef GL_NV_mesh_shader
+        case ShaderType::Amplification:     return GL_TASK_SHADER_NV;
+        case ShaderType::Mesh:              return GL_MESH_SHADER_NV;
+        #endif
         default:                            break;
     }
     MapFailed("ShaderType");
@@ -544,6 +619,37 @@ GLenum Map(const LogicOp logicOp)
     MapFailed("LogicOp");
 }
 
+GLenum Map(const ShadingRate shadingRate)
+{
+    #ifdef GL_NV_shading_rate_image
+    switch (shadingRate)
+    {
+        case ShadingRate::Rate1x1:  return GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV;
+        case ShadingRate::Rate1x2:  return GL_SHADING_RATE_1_INVOCATION_PER_1X2_PIXELS_NV;
+        case ShadingRate::Rate2x1:  return GL_SHADING_RATE_1_INVOCATION_PER_2X1_PIXELS_NV;
+        case ShadingRate::Rate2x2:  return GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV;
+        case ShadingRate::Rate2x4:  return GL_SHADING_RATE_1_INVOCATION_PER_2X4_PIXELS_NV;
+        case ShadingRate::Rate4x2:  return GL_SHADING_RATE_1_INVOCATION_PER_4X2_PIXELS_NV;
+        case ShadingRate::Rate4x4:  return GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV;
+    }
+    #endif
+    MapFailed("ShadingRate");
+}
+
+GLint Map(const TextureSwizzle textureSwizzle)
+{
+    switch (textureSwizzle)
+    {
+        case TextureSwizzle::Zero:  return GL_ZERO;
+        case TextureSwizzle::One:   return GL_ONE;
+        case TextureSwizzle::Red:   return GL_RED;
+        case TextureSwizzle::Green: return GL_GREEN;
+        case TextureSwizzle::Blue:  return GL_BLUE;
+        case TextureSwizzle::Alpha: return GL_ALPHA;
+    }
+    MapFailed("TextureSwizzle");
+}
+
 
 /* ----- Unmap functions ----- */
 
@@ -829,6 +935,11 @@ static Format UnmapTextureFormat(const GLenum internalFormat)
         case GL_RGBA32I:                        return Format::RGBA32SInt;
         case GL_RGBA32F:                        return Format::RGBA32Float;
 
+        /* --- Packed color formats --- */
+        case GL_RGB10_A2:                       return Format::RGB10A2UNorm;
+        case GL_RGB10_A2UI:                     return Format::RGB10A2UInt;
+        case GL_R11F_G11F_B10F:                 return Format::RG11B10Float;
+
         /* --- Depth-stencil formats --- */
         case GL_DEPTH_COMPONENT16:              return Format::D16UNorm;
         case GL_DEPTH_COMPONENT32:              /* pass */
@@ -839,10 +950,65 @@ static Format UnmapTextureFormat(const GLenum internalFormat)
 
         #ifdef LLGL_OPENGL
         /* --- Compressed color formats --- */
-        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:   return Format::BC1RGB;
-        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:  return Format::BC1RGBA;
-        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:  return Format::BC2RGBA;
-        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:  return Format::BC3RGBA;
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:               return Format::BC1RGB;
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:              return Format::BC1RGBA;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:              return Format::BC2RGBA;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:              return Format::BC3RGBA;
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:        return Format::BC1RGBAsRGB;
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:        return Format::BC2RGBAsRGB;
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:        return Format::BC3RGBAsRGB;
+        case GL_COMPRESSED_RED_RGTC1:                       return Format::BC4RUNorm;
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:                return Format::BC4RSNorm;
+        case GL_COMPRESSED_RG_RGTC2:                        return Format::BC5RGUNorm;
+        case GL_COMPRESSED_SIGNED_RG_RGTC2:                 return Format::BC5RGSNorm;
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:         return Format::BC6HRGBUFloat;
+        case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:           return Format::BC6HRGBSFloat;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:                 return Format::BC7RGBAUNorm;
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:           return Format::BC7RGBAsRGB;
+        #endif
+
+        #if defined GL_ARB_ES3_compatibility || defined GL_ES_VERSION_3_0
+        case GL_COMPRESSED_RGB8_ETC2:                       return Format::ETC2RGB8UNorm;
+        case GL_COMPRESSED_SRGB8_ETC2:                      return Format::ETC2RGB8sRGB;
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:   return Format::ETC2RGB8A1UNorm;
+        case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:  return Format::ETC2RGB8A1sRGB;
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:                  return Format::ETC2RGBA8UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:           return Format::ETC2RGBA8sRGB;
+        case GL_COMPRESSED_R11_EAC:                         return Format::EACR11UNorm;
+        case GL_COMPRESSED_SIGNED_R11_EAC:                  return Format::EACR11SNorm;
+        case GL_COMPRESSED_RG11_EAC:                        return Format::EACRG11UNorm;
+        case GL_COMPRESSED_SIGNED_RG11_EAC:                 return Format::EACRG11SNorm;
+        #endif
+
+        #ifdef GL_KHR_texture_compression_astc_ldr
+        case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:               return Format::ASTC4x4UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR:       return Format::ASTC4x4sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_5x4_KHR:               return Format::ASTC5x4UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR:       return Format::ASTC5x4sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_5x5_KHR:               return Format::ASTC5x5UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR:       return Format::ASTC5x5sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_6x5_KHR:               return Format::ASTC6x5UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR:       return Format::ASTC6x5sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_6x6_KHR:               return Format::ASTC6x6UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR:       return Format::ASTC6x6sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_8x5_KHR:               return Format::ASTC8x5UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR:       return Format::ASTC8x5sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_8x6_KHR:               return Format::ASTC8x6UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR:       return Format::ASTC8x6sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_8x8_KHR:               return Format::ASTC8x8UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR:       return Format::ASTC8x8sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_10x5_KHR:              return Format::ASTC10x5UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR:      return Format::ASTC10x5sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_10x6_KHR:              return Format::ASTC10x6UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR:      return Format::ASTC10x6sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_10x8_KHR:              return Format::ASTC10x8UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR:      return Format::ASTC10x8sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_10x10_KHR:             return Format::ASTC10x10UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR:     return Format::ASTC10x10sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_12x10_KHR:             return Format::ASTC12x10UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR:     return Format::ASTC12x10sRGB;
+        case GL_COMPRESSED_RGBA_ASTC_12x12_KHR:             return Format::ASTC12x12UNorm;
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR:     return Format::ASTC12x12sRGB;
         #endif
 
         default:                                break;
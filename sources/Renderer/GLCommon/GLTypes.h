@@ -51,6 +51,8 @@ GLenum Map( const ShaderType            shaderType          );
 GLenum Map( const BufferType            bufferType          );
 GLenum Map( const RenderConditionMode   renderConditionMode );
 GLenum Map( const LogicOp               logicOp             );
+GLenum Map( const ShadingRate           shadingRate         ); // GL_SHADING_RATE_1_INVOCATION_PER_*_NV
+GLint  Map( const TextureSwizzle        textureSwizzle      ); // GL_ZERO, GL_ONE, GL_RED, ...
 
 // Returns an enum in [GL_TEXTURE_CUBE_MAP_POSITIVE_X, ..., GL_TEXTURE_CUBE_MAP_NEGATIVE_Z] for (arrayLayer % 6).
 GLenum ToTextureCubeMap(std::uint32_t arrayLayer);
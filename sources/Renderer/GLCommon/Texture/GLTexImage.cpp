@@ -10,6 +10,7 @@
 #include "../GLImport.h"
 #include "../GLImportExt.h"
 #include "../GLExtensionRegistry.h"
+#include "GLTexSubImage.h"
 #include <array>
 #include <algorithm>
 
@@ -60,6 +61,28 @@ static bool IsSecondaryCubeFaceTarget(GLenum target)
 
 #endif // /GL_ARB_texture_storage
 
+// Returns the size (in bytes) of a compressed image with the specified extent, or 'dataSize' if initial image data is specified.
+static GLsizei GLCompressedImageSize(
+    const Format    textureFormat,
+    GLsizei         width,
+    GLsizei         height,
+    GLsizei         depth,
+    const void*     data        = nullptr,
+    std::size_t     dataSize    = 0)
+{
+    if (data != nullptr)
+        return static_cast<GLsizei>(dataSize);
+
+    const Extent3D extent
+    {
+        static_cast<std::uint32_t>(width),
+        static_cast<std::uint32_t>(height),
+        static_cast<std::uint32_t>(depth)
+    };
+
+    return static_cast<GLsizei>(TextureBufferSize(textureFormat, extent));
+}
+
 /* ----- Back-end OpenGL functions ----- */
 
 #ifdef LLGL_OPENGL
@@ -87,7 +110,7 @@ static void GLTexImage1DBase(
         if (data != nullptr)
         {
             if (IsCompressedFormat(textureFormat))
-                glCompressedTexSubImage1D(target, 0, 0, sx, format, static_cast<GLsizei>(dataSize), data);
+                glCompressedTexSubImage1D(target, 0, 0, sx, internalFormat, static_cast<GLsizei>(dataSize), data);
             else
                 glTexSubImage1D(target, 0, 0, sx, format, type, data);
         }
@@ -97,7 +120,7 @@ static void GLTexImage1DBase(
     {
         /* Allocate mutable texture storage and initialize highest MIP level */
         if (IsCompressedFormat(textureFormat))
-            glCompressedTexImage1D(target, 0, internalFormat, sx, 0, static_cast<GLsizei>(dataSize), data);
+            glCompressedTexImage1D(target, 0, internalFormat, sx, 0, GLCompressedImageSize(textureFormat, sx, 1, 1, data, dataSize), data);
         else
             glTexImage1D(target, 0, internalFormat, sx, 0, format, type, data);
 
@@ -107,7 +130,10 @@ static void GLTexImage1DBase(
             for (std::uint32_t i = 1; i < mipLevels; ++i)
             {
                 sx = std::max(1u, sx / 2u);
-                glTexImage1D(target, static_cast<GLint>(i), internalFormat, sx, 0, format, type, nullptr);
+                if (IsCompressedFormat(textureFormat))
+                    glCompressedTexImage1D(target, static_cast<GLint>(i), internalFormat, sx, 0, GLCompressedImageSize(textureFormat, sx, 1, 1), nullptr);
+                else
+                    glTexImage1D(target, static_cast<GLint>(i), internalFormat, sx, 0, format, type, nullptr);
             }
         }
     }
@@ -143,7 +169,7 @@ static void GLTexImage2DBase(
         if (data != nullptr)
         {
             if (IsCompressedFormat(textureFormat))
-                glCompressedTexSubImage2D(target, 0, 0, 0, sx, sy, format, static_cast<GLsizei>(dataSize), data);
+                glCompressedTexSubImage2D(target, 0, 0, 0, sx, sy, internalFormat, static_cast<GLsizei>(dataSize), data);
             else
                 glTexSubImage2D(target, 0, 0, 0, sx, sy, format, type, data);
         }
@@ -153,7 +179,7 @@ static void GLTexImage2DBase(
     {
         /* Allocate mutable texture storage and initialize highest MIP level */
         if (IsCompressedFormat(textureFormat))
-            glCompressedTexImage2D(target, 0, internalFormat, sx, sy, 0, static_cast<GLsizei>(dataSize), data);
+            glCompressedTexImage2D(target, 0, internalFormat, sx, sy, 0, GLCompressedImageSize(textureFormat, sx, sy, 1, data, dataSize), data);
         else
             glTexImage2D(target, 0, internalFormat, sx, sy, 0, format, type, data);
 
@@ -165,7 +191,10 @@ static void GLTexImage2DBase(
                 for (std::uint32_t i = 1; i < mipLevels; ++i)
                 {
                     sx = std::max(1u, sx / 2u);
-                    glTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, format, type, nullptr);
+                    if (IsCompressedFormat(textureFormat))
+                        glCompressedTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, GLCompressedImageSize(textureFormat, sx, sy, 1), nullptr);
+                    else
+                        glTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, format, type, nullptr);
                 }
             }
             else
@@ -174,7 +203,10 @@ static void GLTexImage2DBase(
                 {
                     sx = std::max(1u, sx / 2u);
                     sy = std::max(1u, sy / 2u);
-                    glTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, format, type, nullptr);
+                    if (IsCompressedFormat(textureFormat))
+                        glCompressedTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, GLCompressedImageSize(textureFormat, sx, sy, 1), nullptr);
+                    else
+                        glTexImage2D(target, static_cast<GLint>(i), internalFormat, sx, sy, 0, format, type, nullptr);
                 }
             }
         }
@@ -208,7 +240,7 @@ static void GLTexImage3DBase(
         if (data != nullptr)
         {
             if (IsCompressedFormat(textureFormat))
-                glCompressedTexSubImage3D(target, 0, 0, 0, 0, sx, sy, sz, format, static_cast<GLsizei>(dataSize), data);
+                glCompressedTexSubImage3D(target, 0, 0, 0, 0, sx, sy, sz, internalFormat, static_cast<GLsizei>(dataSize), data);
             else
                 glTexSubImage3D(target, 0, 0, 0, 0, sx, sy, sz, format, type, data);
         }
@@ -218,7 +250,7 @@ static void GLTexImage3DBase(
     {
         /* Allocate mutable texture storage and initialize highest MIP level */
         if (IsCompressedFormat(textureFormat))
-            glCompressedTexImage3D(target, 0, internalFormat, sx, sy, sz, 0, static_cast<GLsizei>(dataSize), data);
+            glCompressedTexImage3D(target, 0, internalFormat, sx, sy, sz, 0, GLCompressedImageSize(textureFormat, sx, sy, sz, data, dataSize), data);
         else
             glTexImage3D(target, 0, internalFormat, sx, sy, sz, 0, format, type, data);
 
@@ -232,7 +264,10 @@ static void GLTexImage3DBase(
                     sx = std::max(1u, sx / 2u);
                     sy = std::max(1u, sy / 2u);
                     sz = std::max(1u, sz / 2u);
-                    glTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, format, type, nullptr);
+                    if (IsCompressedFormat(textureFormat))
+                        glCompressedTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, GLCompressedImageSize(textureFormat, sx, sy, sz), nullptr);
+                    else
+                        glTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, format, type, nullptr);
                 }
             }
             else
@@ -241,7 +276,10 @@ static void GLTexImage3DBase(
                 {
                     sx = std::max(1u, sx / 2u);
                     sy = std::max(1u, sy / 2u);
-                    glTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, format, type, nullptr);
+                    if (IsCompressedFormat(textureFormat))
+                        glCompressedTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, GLCompressedImageSize(textureFormat, sx, sy, sz), nullptr);
+                    else
+                        glTexImage3D(target, static_cast<GLint>(i), internalFormat, sx, sy, sz, 0, format, type, nullptr);
                 }
             }
         }
@@ -622,7 +660,7 @@ void GLTexImageCube(const TextureDescriptor& desc, const SrcImageDescriptor* ima
         auto imageFaceStride    = (desc.extent.width * desc.extent.height * ImageFormatSize(imageDesc->format) * DataTypeSize(imageDesc->dataType));
 
         if (IsCompressedFormat(desc.format))
-            imageFaceStride = static_cast<std::uint32_t>(imageDesc->dataSize);
+            imageFaceStride = TextureBufferSize(desc.format, { desc.extent.width, desc.extent.height, 1u });
 
         auto dataFormatGL       = GLTypes::Map(imageDesc->format);
         auto dataTypeGL         = GLTypes::Map(imageDesc->dataType);
@@ -638,7 +676,7 @@ void GLTexImageCube(const TextureDescriptor& desc, const SrcImageDescriptor* ima
                 dataFormatGL,
                 dataTypeGL,
                 imageFace,
-                imageDesc->dataSize
+                imageFaceStride
             );
             imageFace += imageFaceStride;
         }
@@ -899,6 +937,113 @@ void GLTexImage2DMSArray(const TextureDescriptor& desc)
     );
 }
 
+#if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+void GLTextureStorage(GLuint texID, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    const auto mipLevels            = static_cast<GLsizei>(NumMipLevels(desc));
+    const auto internalFormat       = GLTypes::Map(desc.format);
+    const auto sx                   = static_cast<GLsizei>(desc.extent.width);
+    const auto sy                   = static_cast<GLsizei>(desc.extent.height);
+    const auto fixedSampleLocations = static_cast<GLboolean>((desc.flags & TextureFlags::FixedSamples) != 0 ? GL_TRUE : GL_FALSE);
+
+    /* Region of the first MIP level (array layers and cube faces are written at once) */
+    auto subImageType = desc.type;
+
+    SubTextureDescriptor subTextureDesc;
+    {
+        subTextureDesc.mipLevel = 0;
+        subTextureDesc.extent   = { desc.extent.width, 1u, 1u };
+    }
+
+    /* Allocate immutable texture storage */
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+            glTextureStorage1D(texID, mipLevels, internalFormat, sx);
+            break;
+
+        case TextureType::Texture2D:
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, sy);
+            subTextureDesc.extent.height = desc.extent.height;
+            break;
+
+        case TextureType::Texture3D:
+            glTextureStorage3D(texID, mipLevels, internalFormat, sx, sy, static_cast<GLsizei>(desc.extent.depth));
+            subTextureDesc.extent.height = desc.extent.height;
+            subTextureDesc.extent.depth  = desc.extent.depth;
+            break;
+
+        case TextureType::TextureCube:
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, sy);
+            subImageType                 = TextureType::TextureCubeArray;
+            subTextureDesc.extent.height = desc.extent.height;
+            subTextureDesc.extent.depth  = desc.arrayLayers;
+            break;
+
+        case TextureType::Texture1DArray:
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, static_cast<GLsizei>(desc.arrayLayers));
+            subTextureDesc.extent.height = desc.arrayLayers;
+            break;
+
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            glTextureStorage3D(texID, mipLevels, internalFormat, sx, sy, static_cast<GLsizei>(desc.arrayLayers));
+            subTextureDesc.extent.height = desc.extent.height;
+            subTextureDesc.extent.depth  = desc.arrayLayers;
+            break;
+
+        case TextureType::Texture2DMS:
+            glTextureStorage2DMultisample(texID, static_cast<GLsizei>(desc.samples), internalFormat, sx, sy, fixedSampleLocations);
+            return;
+
+        case TextureType::Texture2DMSArray:
+            glTextureStorage3DMultisample(texID, static_cast<GLsizei>(desc.samples), internalFormat, sx, sy, static_cast<GLsizei>(desc.arrayLayers), fixedSampleLocations);
+            return;
+    }
+
+    const auto numTexels = subTextureDesc.extent.width * subTextureDesc.extent.height * subTextureDesc.extent.depth;
+
+    /* Initialize highest MIP level */
+    if (imageDesc)
+    {
+        /* Setup texture image from descriptor */
+        GLTextureSubImage(texID, subImageType, subTextureDesc, *imageDesc);
+    }
+    else if (IsDepthStencilFormat(desc.format))
+    {
+        /* Only 2D and 2D array textures can be initialized with a default depth */
+        if (desc.type != TextureType::Texture2D && desc.type != TextureType::Texture2DArray)
+            ErrIllegalUseOfDepthFormat();
+
+        if (g_imageInitialization.enabled)
+        {
+            //TODO: add support for default initialization of stencil values
+            /* Initialize depth texture image with default depth */
+            auto image = GenImageDataRf(numTexels, g_imageInitialization.clearValue.depth);
+            GLTextureSubImage(
+                texID,
+                subImageType,
+                subTextureDesc,
+                SrcImageDescriptor { ImageFormat::Depth, DataType::Float32, image.data(), image.size() * sizeof(float) }
+            );
+        }
+    }
+    else if (!IsCompressedFormat(desc.format) && g_imageInitialization.enabled)
+    {
+        /* Initialize texture image with default color */
+        auto image = GenImageDataRGBAf(numTexels, g_imageInitialization.clearValue.color);
+        GLTextureSubImage(
+            texID,
+            subImageType,
+            subTextureDesc,
+            SrcImageDescriptor { ImageFormat::RGBA, DataType::Float32, image.data(), image.size() * sizeof(ColorRGBAf) }
+        );
+    }
+}
+
+#endif // /GL_ARB_direct_state_access
+
 #endif
 
 
@@ -12,6 +12,7 @@
 #include <LLGL/ImageFlags.h>
 #include <LLGL/TextureFlags.h>
 #include <LLGL/RenderSystemFlags.h>
+#include "../GLImport.h"
 
 
 namespace LLGL
@@ -32,6 +33,13 @@ void GLTexImageCubeArray(const TextureDescriptor& desc, const SrcImageDescriptor
 void GLTexImage2DMS     (const TextureDescriptor& desc);
 void GLTexImage2DMSArray(const TextureDescriptor& desc);
 
+#if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+// Allocates the immutable storage of the specified named texture and initializes its first MIP level without binding it (GL_ARB_direct_state_access).
+void GLTextureStorage(GLuint texID, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
+
+#endif
+
 #else
 
 void GLTexImage2D       (const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
@@ -17,6 +17,18 @@ namespace LLGL
 {
 
 
+// Returns the internal format of the specified texture MIP-map level, since compressed image data must be uploaded with the exact internal format.
+static GLenum GLGetTexLevelInternalFormat(GLenum target, std::uint32_t mipLevel, const ImageFormat imageFormat)
+{
+    #ifdef LLGL_OPENGL
+    GLint internalFormat = 0;
+    glGetTexLevelParameteriv(target, static_cast<GLint>(mipLevel), GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    if (internalFormat != 0)
+        return static_cast<GLenum>(internalFormat);
+    #endif
+    return GLTypes::Map(imageFormat);
+}
+
 #ifdef LLGL_OPENGL
 
 static void GLTexSubImage1DBase(
@@ -33,7 +45,7 @@ static void GLTexSubImage1DBase(
             static_cast<GLint>(mipLevel),
             x,
             static_cast<GLsizei>(width),
-            GLTypes::Map(imageDesc.format),
+            GLGetTexLevelInternalFormat(target, mipLevel, imageDesc.format),
             static_cast<GLsizei>(imageDesc.dataSize),
             imageDesc.data
         );
@@ -72,7 +84,7 @@ static void GLTexSubImage2DBase(
             y,
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
-            GLTypes::Map(imageDesc.format),
+            GLGetTexLevelInternalFormat(target, mipLevel, imageDesc.format),
             static_cast<GLsizei>(imageDesc.dataSize),
             imageDesc.data
         );
@@ -115,7 +127,7 @@ static void GLTexSubImage3DBase(
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
             static_cast<GLsizei>(depth),
-            GLTypes::Map(imageDesc.format),
+            GLGetTexLevelInternalFormat(target, mipLevel, imageDesc.format),
             static_cast<GLsizei>(imageDesc.dataSize),
             imageDesc.data
         );
@@ -329,6 +341,209 @@ void GLTexSubImageCubeArray(const SubTextureDescriptor& desc, const SrcImageDesc
 
 #endif
 
+bool GLTexSubImage(const TextureType type, const SubTextureDescriptor& desc, const SrcImageDescriptor& imageDesc)
+{
+    switch (type)
+    {
+        #ifdef LLGL_OPENGL
+        case TextureType::Texture1D:
+            GLTexSubImage1D(desc, imageDesc);
+            return true;
+        #endif
+
+        case TextureType::Texture2D:
+            GLTexSubImage2D(desc, imageDesc);
+            return true;
+
+        case TextureType::Texture3D:
+            GLTexSubImage3D(desc, imageDesc);
+            return true;
+
+        case TextureType::TextureCube:
+            GLTexSubImageCube(desc, imageDesc);
+            return true;
+
+        #ifdef LLGL_OPENGL
+        case TextureType::Texture1DArray:
+            GLTexSubImage1DArray(desc, imageDesc);
+            return true;
+        #endif
+
+        case TextureType::Texture2DArray:
+            GLTexSubImage2DArray(desc, imageDesc);
+            return true;
+
+        #ifdef LLGL_OPENGL
+        case TextureType::TextureCubeArray:
+            GLTexSubImageCubeArray(desc, imageDesc);
+            return true;
+        #endif
+
+        default:
+            return false;
+    }
+}
+
+#if defined LLGL_OPENGL && defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+// Returns the internal format of the specified MIP-map level of a named texture.
+static GLenum GLGetTextureLevelInternalFormat(GLuint texID, std::uint32_t mipLevel, const ImageFormat imageFormat)
+{
+    GLint internalFormat = 0;
+    glGetTextureLevelParameteriv(texID, static_cast<GLint>(mipLevel), GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    if (internalFormat != 0)
+        return static_cast<GLenum>(internalFormat);
+    return GLTypes::Map(imageFormat);
+}
+
+static void GLTextureSubImage1DBase(
+    GLuint                      texID,
+    std::uint32_t               mipLevel,
+    std::int32_t                x,
+    std::uint32_t               width,
+    const SrcImageDescriptor&   imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        glCompressedTextureSubImage1D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            static_cast<GLsizei>(width),
+            GLGetTextureLevelInternalFormat(texID, mipLevel, imageDesc.format),
+            static_cast<GLsizei>(imageDesc.dataSize),
+            imageDesc.data
+        );
+    }
+    else
+    {
+        glTextureSubImage1D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            static_cast<GLsizei>(width),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.data
+        );
+    }
+}
+
+static void GLTextureSubImage2DBase(
+    GLuint                      texID,
+    std::uint32_t               mipLevel,
+    std::int32_t                x,
+    std::int32_t                y,
+    std::uint32_t               width,
+    std::uint32_t               height,
+    const SrcImageDescriptor&   imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        glCompressedTextureSubImage2D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            y,
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            GLGetTextureLevelInternalFormat(texID, mipLevel, imageDesc.format),
+            static_cast<GLsizei>(imageDesc.dataSize),
+            imageDesc.data
+        );
+    }
+    else
+    {
+        glTextureSubImage2D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            y,
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.data
+        );
+    }
+}
+
+static void GLTextureSubImage3DBase(
+    GLuint                      texID,
+    std::uint32_t               mipLevel,
+    std::int32_t                x,
+    std::int32_t                y,
+    std::int32_t                z,
+    std::uint32_t               width,
+    std::uint32_t               height,
+    std::uint32_t               depth,
+    const SrcImageDescriptor&   imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        glCompressedTextureSubImage3D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            y,
+            z,
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            static_cast<GLsizei>(depth),
+            GLGetTextureLevelInternalFormat(texID, mipLevel, imageDesc.format),
+            static_cast<GLsizei>(imageDesc.dataSize),
+            imageDesc.data
+        );
+    }
+    else
+    {
+        glTextureSubImage3D(
+            texID,
+            static_cast<GLint>(mipLevel),
+            x,
+            y,
+            z,
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            static_cast<GLsizei>(depth),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.data
+        );
+    }
+}
+
+bool GLTextureSubImage(GLuint texID, const TextureType type, const SubTextureDescriptor& desc, const SrcImageDescriptor& imageDesc)
+{
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            GLTextureSubImage1DBase(texID, desc.mipLevel, desc.offset.x, desc.extent.width, imageDesc);
+            return true;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture1DArray:
+            GLTextureSubImage2DBase(texID, desc.mipLevel, desc.offset.x, desc.offset.y, desc.extent.width, desc.extent.height, imageDesc);
+            return true;
+
+        case TextureType::TextureCube:
+            /* Named cube textures are written like an array of six layers, so the Z offset selects the cube face */
+            GLTextureSubImage3DBase(texID, desc.mipLevel, desc.offset.x, desc.offset.y, desc.offset.z, desc.extent.width, desc.extent.height, 1, imageDesc);
+            return true;
+
+        case TextureType::Texture3D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            GLTextureSubImage3DBase(texID, desc.mipLevel, desc.offset.x, desc.offset.y, desc.offset.z, desc.extent.width, desc.extent.height, desc.extent.depth, imageDesc);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+#endif // /GL_ARB_direct_state_access
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/ImageFlags.h>
 #include <LLGL/TextureFlags.h>
+#include "../GLImport.h"
 
 
 namespace LLGL
@@ -36,6 +37,16 @@ void GLTexSubImage2DArray(const SubTextureDescriptor& desc, const SrcImageDescri
 
 #endif
 
+// Writes the sub data of the texture that is currently bound to the target of the specified type. Returns false if the type is not supported.
+bool GLTexSubImage(const TextureType type, const SubTextureDescriptor& desc, const SrcImageDescriptor& imageDesc);
+
+#if defined LLGL_OPENGL && defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+// Writes the sub data of the specified named texture without binding it (GL_ARB_direct_state_access). Returns false if the type is not supported.
+bool GLTextureSubImage(GLuint texID, const TextureType type, const SubTextureDescriptor& desc, const SrcImageDescriptor& imageDesc);
+
+#endif
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,212 @@
+/*
+ * GeometryBatcher.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GeometryBatcher.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+GeometryBatcher::GeometryBatcher(RenderSystem& renderSystem, const GeometryBatcherDescriptor& desc) :
+    renderSystem_ { renderSystem             },
+    vertexStride_ { desc.vertexFormat.stride },
+    numRegions_   { desc.numRegions          },
+    sortByState_  { desc.sortByState         }
+{
+    if (desc.vertexFormat.stride == 0)
+        throw std::invalid_argument("cannot create geometry batcher with zero vertex stride");
+    if (desc.numRegions == 0)
+        throw std::invalid_argument("cannot create geometry batcher with zero regions");
+    if (desc.regionSize < desc.vertexFormat.stride)
+    {
+        throw std::invalid_argument(
+            "cannot create geometry batcher with region size of " + std::to_string(desc.regionSize) +
+            " bytes, which is smaller than a single vertex of " + std::to_string(desc.vertexFormat.stride) + " bytes"
+        );
+    }
+
+    /* Round region size down to whole vertices, so all regions can be drawn from the same vertex buffer binding */
+    maxVertices_ = static_cast<std::uint32_t>(std::min<std::uint64_t>(desc.regionSize / vertexStride_, UINT32_MAX / numRegions_));
+
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                 = BufferType::Vertex;
+        bufferDesc.size                 = static_cast<std::uint64_t>(maxVertices_) * vertexStride_ * numRegions_;
+        bufferDesc.vertexBuffer.format  = desc.vertexFormat;
+    }
+    buffer_ = renderSystem_.CreateBuffer(bufferDesc);
+
+    vertices_.resize(static_cast<std::size_t>(maxVertices_) * vertexStride_);
+}
+
+GeometryBatcher::~GeometryBatcher()
+{
+    renderSystem_.Release(*buffer_);
+}
+
+void GeometryBatcher::Begin(CommandBuffer& commandBuffer)
+{
+    if (commandBuffer_ != nullptr)
+        throw std::runtime_error("cannot begin geometry batch while another batch is active");
+
+    commandBuffer_  = &commandBuffer;
+    numDrawCalls_   = 0;
+}
+
+void* GeometryBatcher::AddVertices(GraphicsPipeline& pipeline, ResourceHeap* resourceHeap, std::uint32_t numVertices)
+{
+    if (commandBuffer_ == nullptr)
+        throw std::runtime_error("cannot add vertices to geometry batcher without an active batch");
+    if (numVertices > maxVertices_)
+    {
+        throw std::out_of_range(
+            "cannot add " + std::to_string(numVertices) + " vertices to geometry batcher with only " +
+            std::to_string(maxVertices_) + " vertices per region"
+        );
+    }
+
+    /* Flush pending vertices if the current region is full */
+    if (numVertices > maxVertices_ - numVertices_)
+        Flush();
+
+    /* Extend the previous batch if the states are equal, otherwise begin a new batch */
+    if (!batches_.empty() && batches_.back().pipeline == &pipeline && batches_.back().resourceHeap == resourceHeap)
+        batches_.back().numVertices += numVertices;
+    else
+        batches_.push_back({ &pipeline, resourceHeap, numVertices_, numVertices });
+
+    auto data = &vertices_[static_cast<std::size_t>(numVertices_) * vertexStride_];
+    numVertices_ += numVertices;
+
+    return data;
+}
+
+void GeometryBatcher::Flush()
+{
+    if (numVertices_ == 0)
+        return;
+
+    if (sortByState_ && batches_.size() > 1)
+        SortBatchesByState();
+
+    /* Upload all pending vertices into the next region with a single buffer update */
+    const auto regionSize   = static_cast<std::uint64_t>(maxVertices_) * vertexStride_;
+    const auto regionOffset = regionSize * region_;
+
+    renderSystem_.WriteBuffer(
+        *buffer_,
+        vertices_.data(),
+        static_cast<std::size_t>(numVertices_) * vertexStride_,
+        static_cast<std::size_t>(regionOffset)
+    );
+
+    RecordDrawCalls(static_cast<std::uint64_t>(maxVertices_) * region_);
+
+    /* Move on to the next region of the ring buffer */
+    region_ = (region_ + 1) % numRegions_;
+
+    batches_.clear();
+    numVertices_ = 0;
+}
+
+void GeometryBatcher::End()
+{
+    if (commandBuffer_ == nullptr)
+        throw std::runtime_error("cannot end geometry batch without an active batch");
+
+    Flush();
+
+    commandBuffer_ = nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GeometryBatcher::SortBatchesByState()
+{
+    /* Sort batches by their states and keep the order of batches with equal states */
+    std::stable_sort(
+        batches_.begin(),
+        batches_.end(),
+        [](const Batch& lhs, const Batch& rhs)
+        {
+            if (lhs.pipeline != rhs.pipeline)
+                return std::less<GraphicsPipeline*>()(lhs.pipeline, rhs.pipeline);
+            return std::less<ResourceHeap*>()(lhs.resourceHeap, rhs.resourceHeap);
+        }
+    );
+
+    /* Gather vertices in sorted order and merge batches with equal states */
+    sortedVertices_.resize(vertices_.size());
+
+    std::uint32_t   numVertices = 0;
+    std::size_t     numBatches  = 0;
+
+    for (const auto& batch : batches_)
+    {
+        ::memcpy(
+            &sortedVertices_[static_cast<std::size_t>(numVertices) * vertexStride_],
+            &vertices_[static_cast<std::size_t>(batch.firstVertex) * vertexStride_],
+            static_cast<std::size_t>(batch.numVertices) * vertexStride_
+        );
+
+        if (numBatches > 0 && batches_[numBatches - 1].pipeline == batch.pipeline && batches_[numBatches - 1].resourceHeap == batch.resourceHeap)
+            batches_[numBatches - 1].numVertices += batch.numVertices;
+        else
+            batches_[numBatches++] = { batch.pipeline, batch.resourceHeap, numVertices, batch.numVertices };
+
+        numVertices += batch.numVertices;
+    }
+
+    batches_.resize(numBatches);
+    vertices_.swap(sortedVertices_);
+}
+
+void GeometryBatcher::RecordDrawCalls(std::uint64_t firstRegionVertex)
+{
+    GraphicsPipeline*   boundPipeline       = nullptr;
+    ResourceHeap*       boundResourceHeap   = nullptr;
+
+    /* Bind the entire ring buffer and offset the vertices by the region, since vertex buffer offsets are not available for all renderers */
+    commandBuffer_->SetVertexBuffer(*buffer_);
+
+    for (const auto& batch : batches_)
+    {
+        if (batch.pipeline != boundPipeline)
+        {
+            commandBuffer_->SetGraphicsPipeline(*batch.pipeline);
+            boundPipeline       = batch.pipeline;
+            boundResourceHeap   = nullptr;
+        }
+
+        if (batch.resourceHeap != nullptr && batch.resourceHeap != boundResourceHeap)
+        {
+            commandBuffer_->SetGraphicsResourceHeap(*batch.resourceHeap);
+            boundResourceHeap = batch.resourceHeap;
+        }
+
+        commandBuffer_->Draw(batch.numVertices, static_cast<std::uint32_t>(firstRegionVertex + batch.firstVertex));
+        ++numDrawCalls_;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
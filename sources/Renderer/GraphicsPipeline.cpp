@@ -0,0 +1,25 @@
+/*
+ * GraphicsPipeline.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GraphicsPipeline.h>
+
+
+namespace LLGL
+{
+
+
+bool GraphicsPipeline::IsReady() const
+{
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
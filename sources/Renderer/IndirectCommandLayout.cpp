@@ -0,0 +1,85 @@
+/*
+ * IndirectCommandLayout.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/IndirectCommandLayout.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+static bool IsDrawArgument(const IndirectArgumentType type)
+{
+    return (type == IndirectArgumentType::Draw || type == IndirectArgumentType::DrawIndexed);
+}
+
+static void ValidateIndirectCommandLayoutDesc(const IndirectCommandLayoutDescriptor& desc)
+{
+    if (desc.arguments.empty() || !IsDrawArgument(desc.arguments.back().type))
+        throw std::invalid_argument("last argument of indirect command layout must be a draw argument");
+
+    for (std::size_t i = 0; i + 1 < desc.arguments.size(); ++i)
+    {
+        const auto& argument = desc.arguments[i];
+        if (IsDrawArgument(argument.type))
+            throw std::invalid_argument("indirect command layout must not have more than one draw argument");
+        if (argument.type == IndirectArgumentType::Constants)
+        {
+            if (desc.pipelineLayout == nullptr)
+                throw std::invalid_argument("cannot create indirect command layout with constant arguments but without pipeline layout");
+            if (argument.numValues == 0)
+                throw std::invalid_argument("cannot create indirect command layout with zero 32-bit values for constant argument");
+        }
+    }
+
+    if (desc.stride % 4 != 0)
+        throw std::invalid_argument("stride of indirect command layout must be a multiple of 4, but " + std::to_string(desc.stride) + " was specified");
+}
+
+IndirectCommandLayout::IndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc)
+{
+    ValidateIndirectCommandLayoutDesc(desc);
+
+    /* Accumulate tightly packed argument sizes; the draw argument is always the last one */
+    std::uint32_t size = 0;
+    for (const auto& argument : desc.arguments)
+    {
+        drawOffset_ = size;
+        size += GetArgumentSize(argument);
+    }
+
+    drawType_ = desc.arguments.back().type;
+
+    if (desc.stride == 0)
+        stride_ = size;
+    else if (desc.stride >= size)
+        stride_ = desc.stride;
+    else
+        throw std::invalid_argument("stride of indirect command layout must be at least " + std::to_string(size) + ", but " + std::to_string(desc.stride) + " was specified");
+}
+
+std::uint32_t IndirectCommandLayout::GetArgumentSize(const IndirectArgumentDescriptor& argumentDesc)
+{
+    switch (argumentDesc.type)
+    {
+        case IndirectArgumentType::Draw:            return sizeof(DrawIndirectArguments);
+        case IndirectArgumentType::DrawIndexed:     return sizeof(DrawIndexedIndirectArguments);
+        case IndirectArgumentType::VertexBuffer:    return sizeof(VertexBufferIndirectArguments);
+        case IndirectArgumentType::Constants:       return argumentDesc.numValues * sizeof(std::uint32_t);
+    }
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
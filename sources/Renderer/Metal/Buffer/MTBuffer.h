@@ -0,0 +1,83 @@
+/*
+ * MTBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_BUFFER_H
+#define LLGL_MT_BUFFER_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Buffer.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+
+class MTHeapAllocator;
+
+class MTBuffer final : public Buffer
+{
+
+    public:
+
+        // Creates the buffer with its initial data if it is host visible. The initial data of GPU-private buffers is uploaded by the render system.
+        MTBuffer(id<MTLDevice> device, MTHeapAllocator& heapAllocator, const BufferDescriptor& desc, const void* initialData);
+        ~MTBuffer();
+
+        void SetName(const char* name) override;
+
+        // Writes the specified data into the host-visible buffer.
+        void Write(const void* data, std::size_t dataSize, std::size_t offset);
+
+        // Returns the pointer to the host-visible buffer contents at the specified offset.
+        void* Map(const CPUAccess access, std::uint64_t offset);
+
+        // Returns the native buffer object.
+        inline id<MTLBuffer> GetNative() const
+        {
+            return buffer_;
+        }
+
+        // Returns the size originally specified in the descriptor.
+        inline std::uint64_t GetSize() const
+        {
+            return size_;
+        }
+
+        // Returns true if this buffer is located in shared memory, i.e. it can be accessed by the CPU directly.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
+        // Returns the index type of an index buffer.
+        inline MTLIndexType GetIndexType() const
+        {
+            return indexType_;
+        }
+
+    private:
+
+        id<MTLBuffer>   buffer_         = nil;
+        std::uint64_t   size_           = 0;
+        bool            hostVisible_    = false;
+        MTLIndexType    indexType_      = MTLIndexTypeUInt32;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
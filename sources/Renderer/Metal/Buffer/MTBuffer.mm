@@ -0,0 +1,87 @@
+/*
+ * MTBuffer.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTBuffer.h"
+#include "../MTCore.h"
+#include "../MTTypes.h"
+#include "../MTHeapAllocator.h"
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Returns true if the specified buffer flags require CPU access.
+static bool HasCPUAccess(long flags)
+{
+    return ((flags & (BufferFlags::MapReadWriteAccess | BufferFlags::DynamicUsage | BufferFlags::PersistentMapping)) != 0);
+}
+
+MTBuffer::MTBuffer(id<MTLDevice> device, MTHeapAllocator& heapAllocator, const BufferDescriptor& desc, const void* initialData) :
+    Buffer       { desc.type                },
+    size_        { desc.size                },
+    hostVisible_ { HasCPUAccess(desc.flags) }
+{
+    auto length = static_cast<NSUInteger>(desc.size);
+
+    if (hostVisible_)
+    {
+        /* Allocate buffer in shared memory, which is directly written by the CPU */
+        if (initialData != nullptr)
+            buffer_ = [device newBufferWithBytes:initialData length:length options:MTLResourceStorageModeShared];
+        else
+            buffer_ = [device newBufferWithLength:length options:MTLResourceStorageModeShared];
+        MTThrowIfCreateFailed(buffer_, "MTLBuffer");
+    }
+    else
+    {
+        /* Allocate buffer in GPU-private memory, whose initial data is uploaded by the render system */
+        buffer_ = heapAllocator.NewBuffer(length);
+    }
+
+    if (desc.type == BufferType::Index)
+        indexType_ = MTTypes::Map(desc.indexBuffer.format.GetDataType());
+}
+
+MTBuffer::~MTBuffer()
+{
+    [buffer_ release];
+}
+
+void MTBuffer::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    [buffer_ setLabel:(name != nullptr ? [NSString stringWithUTF8String:name] : nil)];
+    #endif
+}
+
+void MTBuffer::Write(const void* data, std::size_t dataSize, std::size_t offset)
+{
+    if (!hostVisible_)
+        throw std::runtime_error("cannot write GPU-private Metal buffer directly");
+    if (offset + dataSize > size_)
+        throw std::out_of_range("Metal buffer write exceeds buffer size");
+
+    auto dst = reinterpret_cast<char*>([buffer_ contents]);
+    ::memcpy(dst + offset, data, dataSize);
+}
+
+void* MTBuffer::Map(const CPUAccess /*access*/, std::uint64_t offset)
+{
+    if (!hostVisible_)
+        throw std::runtime_error("cannot map Metal buffer that has been created without CPU access flags");
+    return (reinterpret_cast<char*>([buffer_ contents]) + offset);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * MTBufferArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_BUFFER_ARRAY_H
+#define LLGL_MT_BUFFER_ARRAY_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/BufferArray.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class Buffer;
+
+class MTBufferArray final : public BufferArray
+{
+
+    public:
+
+        MTBufferArray(const BufferType type, std::uint32_t numBuffers, Buffer* const * bufferArray);
+
+        // Returns the array of native buffer objects.
+        inline const std::vector<id<MTLBuffer>>& GetBuffers() const
+        {
+            return buffers_;
+        }
+
+        // Returns the array of buffer offsets.
+        inline const std::vector<NSUInteger>& GetOffsets() const
+        {
+            return offsets_;
+        }
+
+        // Returns the array of index types of index buffers.
+        inline const std::vector<MTLIndexType>& GetIndexTypes() const
+        {
+            return indexTypes_;
+        }
+
+    private:
+
+        std::vector<id<MTLBuffer>>  buffers_;
+        std::vector<NSUInteger>     offsets_;
+        std::vector<MTLIndexType>   indexTypes_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,39 @@
+/*
+ * MTBufferArray.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTBufferArray.h"
+#include "MTBuffer.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+MTBufferArray::MTBufferArray(const BufferType type, std::uint32_t numBuffers, Buffer* const * bufferArray) :
+    BufferArray { type }
+{
+    /* Store the native object of each MTBuffer inside the array */
+    buffers_.reserve(numBuffers);
+    offsets_.reserve(numBuffers);
+    indexTypes_.reserve(numBuffers);
+
+    while (auto next = NextArrayResource<MTBuffer>(numBuffers, bufferArray))
+    {
+        buffers_.push_back(next->GetNative());
+        offsets_.push_back(0);
+        indexTypes_.push_back(next->GetIndexType());
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,442 @@
+/*
+ * MTCommandBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_COMMAND_BUFFER_H
+#define LLGL_MT_COMMAND_BUFFER_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/CommandBufferExt.h>
+#include "MTCore.h"
+#include "Buffer/MTBuffer.h"
+#include "../TransientRing.h"
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class MTCommandQueue;
+class MTHeapAllocator;
+class MTRenderContext;
+class MTGraphicsPipeline;
+class MTComputePipeline;
+class MTResourceHeap;
+
+/*
+Metal command buffers can only be committed once, so this class records into a new MTLCommandBuffer after each submission.
+The render, compute, and blit command encoders are created on demand and each of them ends the others.
+The render pass of BeginRenderPass is only encoded with the first command that requires it, so clear commands can be folded into its load actions.
+*/
+class MTCommandBuffer final : public CommandBufferExt
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        MTCommandBuffer(id<MTLDevice> device, MTCommandQueue& commandQueue, MTHeapAllocator& heapAllocator);
+        ~MTCommandBuffer();
+
+        /* ----- Configuration ----- */
+
+        void SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize) override;
+
+        /* ----- Viewport and Scissor ----- */
+
+        void SetViewport(const Viewport& viewport) LLGL_DISPATCH_OVERRIDE;
+        void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
+
+        void SetScissor(const Scissor& scissor) LLGL_DISPATCH_OVERRIDE;
+        void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
+
+        /* ----- Clear ----- */
+
+        void SetClearColor(const ColorRGBAf& color) override;
+        void SetClearDepth(float depth) override;
+        void SetClearStencil(std::uint32_t stencil) override;
+
+        void Clear(long flags) override;
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
+
+        /* ----- Input Assembly ------ */
+
+        void SetVertexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
+        void SetVertexBufferArray(BufferArray& bufferArray) override;
+
+        void SetIndexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
+
+        /* ----- Stream Output Buffers ------ */
+
+        void SetStreamOutputBuffer(Buffer& buffer) override;
+        void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
+
+        void BeginStreamOutput(const PrimitiveType primitiveType) override;
+        void EndStreamOutput() override;
+
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
+        /* ----- Resource Heaps ----- */
+
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constant Buffers ------ */
+
+        void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
+        /* ----- Storage Buffers ----- */
+
+        void SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Textures ----- */
+
+        void SetTexture(Texture& texture, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Samplers ----- */
+
+        void SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
+
+        /* ----- Render Targets ----- */
+
+        void SetRenderTarget(RenderTarget& renderTarget) override;
+        void SetRenderTarget(RenderContext& renderContext) override;
+
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
+        /* ----- Pipeline States ----- */
+
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) LLGL_DISPATCH_OVERRIDE;
+        void SetComputePipeline(ComputePipeline& computePipeline) LLGL_DISPATCH_OVERRIDE;
+
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
+
+        /* ----- Queries ----- */
+
+        void BeginQuery(Query& query) override;
+        void EndQuery(Query& query) override;
+
+        bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
+        void EndRenderCondition() override;
+
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
+        /* ----- Drawing ----- */
+
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) LLGL_DISPATCH_OVERRIDE;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        /* ----- Compute ----- */
+
+        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) LLGL_DISPATCH_OVERRIDE;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
+
+        /* --- Extended functions --- */
+
+        // Ends all command encoders and returns the native command buffer of the current recording, or nil if nothing has been recorded. The returned object is retained by the caller.
+        id<MTLCommandBuffer> EndCommandBuffer();
+
+        // Returns true if this command buffer has begun a render pass on a render context, i.e. it is committed when that render context is presented.
+        inline bool IsPresentable() const
+        {
+            return presentable_;
+        }
+
+    private:
+
+        // Resource that has been bound individually to a slot, see CommandBufferExt.
+        struct BoundResource
+        {
+            id              resource    = nil;
+            NSUInteger      offset      = 0;
+            long            stageFlags  = 0;
+        };
+
+        // States of the current render pass, which are set again when its render command encoder is restarted.
+        struct RenderState
+        {
+            MTGraphicsPipeline*         graphicsPipeline    = nullptr;
+            std::vector<MTLViewport>    viewports;
+            std::vector<MTLScissorRect> scissors;
+            id<MTLBuffer>               vertexBuffers[g_maxNumVertexBuffers];
+            NSUInteger                  vertexOffsets[g_maxNumVertexBuffers];
+            NSUInteger                  numVertexBuffers    = 0;
+            MTResourceHeap*             resourceHeap        = nullptr;
+            std::vector<std::uint32_t>  dynamicOffsets;
+            bool                        hasStencilReference = false;
+            std::uint32_t               stencilReference    = 0;
+            bool                        hasBlendFactor      = false;
+            ColorRGBAf                  blendFactor;
+            bool                        hasDepthBias        = false;
+            DepthBiasDescriptor         depthBias;
+        };
+
+        // States of the current compute pipeline, which are set again when a new compute command encoder is started.
+        struct ComputeState
+        {
+            MTComputePipeline*          computePipeline     = nullptr;
+            MTResourceHeap*             resourceHeap        = nullptr;
+            std::vector<std::uint32_t>  dynamicOffsets;
+        };
+
+    private:
+
+        // Returns the native command buffer of the current recording and creates it on demand.
+        id<MTLCommandBuffer> GetCommandBuffer();
+
+        // Returns the render command encoder of the current render pass and begins it on demand. Throws if there is no render pass.
+        id<MTLRenderCommandEncoder> GetRenderEncoder();
+
+        // Returns the current compute command encoder and creates it on demand.
+        id<MTLComputeCommandEncoder> GetComputeEncoder();
+
+        // Returns the current blit command encoder and creates it on demand.
+        id<MTLBlitCommandEncoder> GetBlitEncoder();
+
+        // Ends the active command encoder (if any). The render pass remains active and is continued with the next render command.
+        void EndActiveEncoder();
+
+        // Starts the render pass with the specified native descriptor, which is copied, and the load actions of the render pass and clear values.
+        void BeginNativeRenderPass(
+            MTLRenderPassDescriptor*    renderPassDesc,
+            NSUInteger                  numColorAttachments,
+            const Extent2D&             extent,
+            const RenderPass*           renderPass,
+            std::uint32_t               numClearValues,
+            const ClearValue*           clearValues
+        );
+
+        // Sets the load actions of the next render command encoder to MTLLoadActionLoad, so a restarted encoder continues the render pass.
+        void ContinueNativeRenderPass();
+
+        void ReleaseRenderPass();
+
+        // Sets all cached states of the current render pass in the new render command encoder.
+        void ApplyRenderState(id<MTLRenderCommandEncoder> renderEncoder);
+
+        // Sets all cached states of the current compute pipeline in the new compute command encoder.
+        void ApplyComputeState(id<MTLComputeCommandEncoder> computeEncoder);
+
+        void ApplyViewports(id<MTLRenderCommandEncoder> renderEncoder);
+        void ApplyScissors(id<MTLRenderCommandEncoder> renderEncoder);
+        void ApplyGraphicsConstants(id<MTLRenderCommandEncoder> renderEncoder);
+        void ApplyComputeConstants(id<MTLComputeCommandEncoder> computeEncoder);
+
+        // Binds all individually bound resources (see CommandBufferExt) to the specified encoder.
+        void ApplyBoundResources(id<MTLRenderCommandEncoder> renderEncoder);
+        void ApplyBoundResources(id<MTLComputeCommandEncoder> computeEncoder);
+
+        // Stores the individually bound resource in the cache and binds it to the active encoder.
+        void BindResource(std::vector<BoundResource>& cache, id resource, NSUInteger offset, std::uint32_t slot, long stageFlags);
+
+        // Returns the offset (in bytes) of the specified index within the current index buffer.
+        NSUInteger GetIndexBufferOffset(std::uint32_t firstIndex) const;
+
+        void CreateTransientBuffer();
+
+        // Closes the transient memory of the current recording, which is recycled when the specified command buffer has been completed.
+        void CloseTransientMemory(id<MTLCommandBuffer> cmdBuffer);
+
+        void ResetStates();
+
+    private:
+
+        id<MTLDevice>                   device_             = nil;
+        MTCommandQueue&                 commandQueue_;
+        MTHeapAllocator&                heapAllocator_;
+
+        id<MTLCommandBuffer>            cmdBuffer_          = nil;
+        id<MTLRenderCommandEncoder>     renderEncoder_      = nil;
+        id<MTLComputeCommandEncoder>    computeEncoder_     = nil;
+        id<MTLBlitCommandEncoder>       blitEncoder_        = nil;
+
+        MTLRenderPassDescriptor*        renderPassDesc_     = nil;  // Render pass of the next render command encoder
+        Extent2D                        framebufferExtent_;
+        NSUInteger                      numColorAttachments_= 0;
+        bool                            pendingClears_      = false;  // Render pass has clear actions that have not been encoded yet
+        bool                            presentable_        = false;
+
+        ColorRGBAf                      clearColor_         = { 0.0f, 0.0f, 0.0f, 0.0f };
+        double                          clearDepth_         = 1.0;
+        std::uint32_t                   clearStencil_       = 0;
+
+        RenderState                     renderState_;
+        ComputeState                    computeState_;
+        MTLPrimitiveType                primitiveType_      = MTLPrimitiveTypeTriangle;
+        MTLSize                         threadGroupSize_    = { 1, 1, 1 };
+
+        std::vector<BoundResource>      boundBuffers_;
+        std::vector<BoundResource>      boundTextures_;
+        std::vector<BoundResource>      boundSamplers_;
+
+        std::vector<char>               graphicsConstants_;
+        std::vector<char>               computeConstants_;
+
+        id<MTLBuffer>                   indexBuffer_        = nil;
+        NSUInteger                      indexBufferOffset_  = 0;
+        MTLIndexType                    indexType_          = MTLIndexTypeUInt32;
+
+        std::unique_ptr<MTBuffer>       transientBuffer_;
+        TransientRing<id<MTLCommandBuffer>> transientRing_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,1579 @@
+/*
+ * MTCommandBuffer.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTCommandBuffer.h"
+#include "MTCommandQueue.h"
+#include "MTRenderContext.h"
+#include "MTTypes.h"
+#include "Buffer/MTBufferArray.h"
+#include "RenderState/MTGraphicsPipeline.h"
+#include "RenderState/MTComputePipeline.h"
+#include "RenderState/MTResourceHeap.h"
+#include "Texture/MTTexture.h"
+#include "Texture/MTSampler.h"
+#include "Texture/MTRenderTarget.h"
+#include "../CheckedCast.h"
+#include <LLGL/RenderPass.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Metal requires 256 bytes alignment for buffer offsets of constant buffers on macOS.
+static const std::uint64_t g_transientAlignment = 256;
+
+// Returns the native clear color, since the clear color of an attachment descriptor is a property that cannot be converted in place.
+static MTLClearColor ToNativeClearColor(const ColorRGBAf& color)
+{
+    MTLClearColor clearColor;
+    MTTypes::Convert(clearColor, color);
+    return clearColor;
+}
+
+MTCommandBuffer::MTCommandBuffer(id<MTLDevice> device, MTCommandQueue& commandQueue, MTHeapAllocator& heapAllocator) :
+    device_        { [device retain] },
+    commandQueue_  { commandQueue    },
+    heapAllocator_ { heapAllocator   }
+{
+    ResetStates();
+}
+
+MTCommandBuffer::~MTCommandBuffer()
+{
+    /* Discard current recording */
+    if (id<MTLCommandBuffer> cmdBuffer = EndCommandBuffer())
+        [cmdBuffer release];
+
+    /* Wait until the GPU has completed all command buffers that still use the transient memory */
+    while (transientRing_.HasClosedSegments())
+    {
+        id<MTLCommandBuffer> cmdBuffer = transientRing_.GetOldestTag();
+        [cmdBuffer waitUntilCompleted];
+        [cmdBuffer release];
+        transientRing_.ReleaseOldest();
+    }
+
+    [device_ release];
+}
+
+/* ----- Configuration ----- */
+
+void MTCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
+{
+    // dummy
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void MTCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    SetViewports(1, &viewport);
+}
+
+void MTCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    renderState_.viewports.resize(numViewports);
+    for (std::uint32_t i = 0; i < numViewports; ++i)
+        MTTypes::Convert(renderState_.viewports[i], viewports[i]);
+
+    if (renderEncoder_ != nil)
+        ApplyViewports(renderEncoder_);
+}
+
+void MTCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    SetScissors(1, &scissor);
+}
+
+void MTCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    renderState_.scissors.resize(numScissors);
+    for (std::uint32_t i = 0; i < numScissors; ++i)
+        MTTypes::Convert(renderState_.scissors[i], scissors[i]);
+
+    if (renderEncoder_ != nil)
+        ApplyScissors(renderEncoder_);
+}
+
+/* ----- Clear ----- */
+
+void MTCommandBuffer::SetClearColor(const ColorRGBAf& color)
+{
+    clearColor_ = color;
+}
+
+void MTCommandBuffer::SetClearDepth(float depth)
+{
+    clearDepth_ = static_cast<double>(depth);
+}
+
+void MTCommandBuffer::SetClearStencil(std::uint32_t stencil)
+{
+    clearStencil_ = stencil;
+}
+
+void MTCommandBuffer::Clear(long flags)
+{
+    if (renderPassDesc_ == nil)
+        throw std::runtime_error("cannot clear attachments outside of a Metal render pass");
+
+    /* Metal can only clear attachments with the load actions of a render command encoder, so a started render pass is restarted */
+    if (renderEncoder_ != nil)
+        EndActiveEncoder();
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for (NSUInteger i = 0; i < numColorAttachments_; ++i)
+        {
+            auto attachment = renderPassDesc_.colorAttachments[i];
+            attachment.loadAction = MTLLoadActionClear;
+            attachment.clearColor = ToNativeClearColor(clearColor_);
+        }
+    }
+
+    if ((flags & ClearFlags::Depth) != 0 && renderPassDesc_.depthAttachment.texture != nil)
+    {
+        renderPassDesc_.depthAttachment.loadAction  = MTLLoadActionClear;
+        renderPassDesc_.depthAttachment.clearDepth  = clearDepth_;
+    }
+
+    if ((flags & ClearFlags::Stencil) != 0 && renderPassDesc_.stencilAttachment.texture != nil)
+    {
+        renderPassDesc_.stencilAttachment.loadAction   = MTLLoadActionClear;
+        renderPassDesc_.stencilAttachment.clearStencil = clearStencil_;
+    }
+
+    pendingClears_ = true;
+}
+
+void MTCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    if (renderPassDesc_ == nil)
+        throw std::runtime_error("cannot clear attachments outside of a Metal render pass");
+
+    if (renderEncoder_ != nil)
+        EndActiveEncoder();
+
+    for (std::uint32_t i = 0; i < numAttachments; ++i)
+    {
+        const auto& attachment = attachments[i];
+        if ((attachment.flags & ClearFlags::Color) != 0)
+        {
+            /* Clear color attachment */
+            if (attachment.colorAttachment < numColorAttachments_)
+            {
+                auto colorAttachment = renderPassDesc_.colorAttachments[attachment.colorAttachment];
+                colorAttachment.loadAction = MTLLoadActionClear;
+                colorAttachment.clearColor = ToNativeClearColor(attachment.clearValue.color);
+            }
+        }
+        else
+        {
+            /* Clear depth and stencil attachments */
+            if ((attachment.flags & ClearFlags::Depth) != 0 && renderPassDesc_.depthAttachment.texture != nil)
+            {
+                renderPassDesc_.depthAttachment.loadAction  = MTLLoadActionClear;
+                renderPassDesc_.depthAttachment.clearDepth  = static_cast<double>(attachment.clearValue.depth);
+            }
+            if ((attachment.flags & ClearFlags::Stencil) != 0 && renderPassDesc_.stencilAttachment.texture != nil)
+            {
+                renderPassDesc_.stencilAttachment.loadAction   = MTLLoadActionClear;
+                renderPassDesc_.stencilAttachment.clearStencil = attachment.clearValue.stencil;
+            }
+        }
+    }
+
+    pendingClears_ = true;
+}
+
+/* ----- Input Assembly ------ */
+
+void MTCommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    SetVertexBuffer(buffer, 0);
+}
+
+void MTCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+
+    renderState_.vertexBuffers[0]   = bufferMT.GetNative();
+    renderState_.vertexOffsets[0]   = static_cast<NSUInteger>(offset);
+    renderState_.numVertexBuffers   = 1;
+
+    if (renderEncoder_ != nil)
+        [renderEncoder_ setVertexBuffer:renderState_.vertexBuffers[0] offset:renderState_.vertexOffsets[0] atIndex:MTVertexBufferIndex(0)];
+}
+
+void MTCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    auto& bufferArrayMT = LLGL_CAST(MTBufferArray&, bufferArray);
+
+    const auto& buffers = bufferArrayMT.GetBuffers();
+    const auto& offsets = bufferArrayMT.GetOffsets();
+
+    renderState_.numVertexBuffers = std::min(buffers.size(), static_cast<std::size_t>(g_maxNumVertexBuffers));
+    for (NSUInteger i = 0; i < renderState_.numVertexBuffers; ++i)
+    {
+        renderState_.vertexBuffers[i] = buffers[i];
+        renderState_.vertexOffsets[i] = offsets[i];
+        if (renderEncoder_ != nil)
+            [renderEncoder_ setVertexBuffer:buffers[i] offset:offsets[i] atIndex:MTVertexBufferIndex(static_cast<std::uint32_t>(i))];
+    }
+}
+
+void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    indexBuffer_        = bufferMT.GetNative();
+    indexBufferOffset_  = 0;
+    indexType_          = bufferMT.GetIndexType();
+}
+
+void MTCommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    indexBuffer_        = bufferMT.GetNative();
+    indexBufferOffset_  = static_cast<NSUInteger>(offset);
+    indexType_          = MTTypes::Map(format.GetDataType());
+}
+
+/* ----- Stream Output Buffers ------ */
+
+void MTCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::EndStreamOutput()
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::PauseStreamOutput()
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::ResumeStreamOutput()
+{
+    // dummy (not supported by Metal)
+}
+
+/* ----- Resource Heaps ----- */
+
+void MTCommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
+
+    renderState_.resourceHeap = &resourceHeapMT;
+    renderState_.dynamicOffsets.assign(dynamicOffsets, dynamicOffsets + numDynamicOffsets);
+
+    if (renderEncoder_ != nil)
+        resourceHeapMT.BindGraphicsResources(renderEncoder_, numDynamicOffsets, dynamicOffsets);
+}
+
+void MTCommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
+
+    computeState_.resourceHeap = &resourceHeapMT;
+    computeState_.dynamicOffsets.assign(dynamicOffsets, dynamicOffsets + numDynamicOffsets);
+
+    if (computeEncoder_ != nil)
+        resourceHeapMT.BindComputeResources(computeEncoder_, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constant Buffers ------ */
+
+void MTCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    BindResource(boundBuffers_, bufferMT.GetNative(), 0, slot, stageFlags);
+}
+
+void MTCommandBuffer::SetConstantBufferRange(
+    Buffer&         buffer,
+    std::uint32_t   slot,
+    std::uint64_t   offset,
+    std::uint64_t   /*size*/,
+    long            stageFlags)
+{
+    /* Metal buffer bindings have no size, so the shader determines the range from the offset */
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    BindResource(boundBuffers_, bufferMT.GetNative(), static_cast<NSUInteger>(offset), slot, stageFlags);
+}
+
+/* ----- Storage Buffers ----- */
+
+void MTCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    BindResource(boundBuffers_, bufferMT.GetNative(), 0, slot, stageFlags);
+}
+
+/* ----- Textures ----- */
+
+void MTCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+    BindResource(boundTextures_, textureMT.GetNative(), 0, slot, stageFlags);
+}
+
+/* ----- Samplers ----- */
+
+void MTCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
+{
+    auto& samplerMT = LLGL_CAST(MTSampler&, sampler);
+    BindResource(boundSamplers_, samplerMT.GetNative(), 0, slot, stageFlags);
+}
+
+/* ----- Constants ----- */
+
+// Writes the data into the constants cache and resizes the cache if necessary.
+static void WriteConstants(std::vector<char>& constants, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    if (constants.size() < offset + size)
+        constants.resize(offset + size, 0);
+    ::memcpy(constants.data() + offset, data, size);
+}
+
+void MTCommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    /* Constants are set with setBytes, which copies the data into the command buffer, so only the cache is updated before the encoder binds it again */
+    if ((stageFlags & (StageFlags::VertexStage | StageFlags::FragmentStage)) != 0)
+    {
+        WriteConstants(graphicsConstants_, offset, size, data);
+        if (renderEncoder_ != nil)
+            ApplyGraphicsConstants(renderEncoder_);
+    }
+    if ((stageFlags & StageFlags::ComputeStage) != 0)
+    {
+        WriteConstants(computeConstants_, offset, size, data);
+        if (computeEncoder_ != nil)
+            ApplyComputeConstants(computeEncoder_);
+    }
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation MTCommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    if (!transientBuffer_)
+        CreateTransientBuffer();
+
+    /* Allocate range from ring buffer and wait for the oldest command buffer while the ring is full */
+    std::uint64_t offset = 0;
+    auto waitFunc = [](id<MTLCommandBuffer> cmdBuffer)
+    {
+        [cmdBuffer waitUntilCompleted];
+        [cmdBuffer release];
+    };
+    if (!transientRing_.AllocateOrWait(size, (alignment > 0 ? alignment : g_transientAlignment), offset, waitFunc))
+        throw std::out_of_range("transient memory allocations of a single Metal command buffer submission exceed ring buffer size");
+
+    TransientAllocation allocation;
+    {
+        allocation.data     = reinterpret_cast<char*>([transientBuffer_->GetNative() contents]) + offset;
+        allocation.buffer   = transientBuffer_.get();
+        allocation.offset   = offset;
+    }
+    return allocation;
+}
+
+/* ----- Render Targets ----- */
+
+void MTCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
+{
+    BeginRenderPass(renderTarget);
+}
+
+void MTCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+{
+    BeginRenderPass(renderContext);
+}
+
+void MTCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    auto& renderTargetMT = LLGL_CAST(MTRenderTarget&, renderTarget);
+    BeginNativeRenderPass(
+        renderTargetMT.GetNativeRenderPass(),
+        renderTargetMT.GetColorFormats().size(),
+        renderTargetMT.GetResolution(),
+        renderPass,
+        numClearValues,
+        clearValues
+    );
+}
+
+void MTCommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    auto& renderContextMT = LLGL_CAST(MTRenderContext&, renderContext);
+
+    /* This command buffer is committed when the render context is presented */
+    renderContextMT.SetPresentCommandBuffer(this);
+    presentable_ = true;
+
+    BeginNativeRenderPass(
+        renderContextMT.GetNativeRenderPass(),
+        1,
+        renderContextMT.GetVideoMode().resolution,
+        renderPass,
+        numClearValues,
+        clearValues
+    );
+}
+
+void MTCommandBuffer::EndRenderPass()
+{
+    if (renderPassDesc_ != nil)
+    {
+        /* Encode render pass without any draw commands if it still has to clear its attachments */
+        if (pendingClears_)
+            GetRenderEncoder();
+        EndActiveEncoder();
+        ReleaseRenderPass();
+    }
+}
+
+void MTCommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    auto& renderTargetMT = LLGL_CAST(MTRenderTarget&, srcRenderTarget);
+    auto& textureMT = LLGL_CAST(MTTexture&, dstTexture);
+
+    /* Multi-sampled attachments are resolved by the store action of the render pass, so the resolved attachment is copied into the destination texture */
+    auto attachment = renderTargetMT.GetNativeRenderPass().colorAttachments[srcColorAttachment];
+    id<MTLTexture> srcTexture = (attachment.resolveTexture != nil ? attachment.resolveTexture : attachment.texture);
+    if (srcTexture == nil)
+        throw std::invalid_argument("cannot resolve Metal render target with invalid color attachment index");
+
+    NSUInteger srcSlice = (attachment.resolveTexture != nil ? attachment.resolveSlice : attachment.slice);
+    NSUInteger srcLevel = (attachment.resolveTexture != nil ? attachment.resolveLevel : attachment.level);
+
+    [GetBlitEncoder()
+        copyFromTexture:            srcTexture
+        sourceSlice:                srcSlice
+        sourceLevel:                srcLevel
+        sourceOrigin:               MTLOriginMake(0, 0, 0)
+        sourceSize:                 MTLSizeMake(std::max<NSUInteger>(1, [srcTexture width] >> srcLevel), std::max<NSUInteger>(1, [srcTexture height] >> srcLevel), 1)
+        toTexture:                  textureMT.GetNative()
+        destinationSlice:           0
+        destinationLevel:           0
+        destinationOrigin:          MTLOriginMake(0, 0, 0)
+    ];
+}
+
+void MTCommandBuffer::DiscardAttachments(long flags)
+{
+    if (renderPassDesc_ == nil)
+        return;
+
+    /* Store actions are specified when the render command encoder is started, so this only affects the encoder of the next render command */
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for (NSUInteger i = 0; i < numColorAttachments_; ++i)
+            renderPassDesc_.colorAttachments[i].storeAction = MTLStoreActionDontCare;
+    }
+    if ((flags & ClearFlags::Depth) != 0)
+        renderPassDesc_.depthAttachment.storeAction = MTLStoreActionDontCare;
+    if ((flags & ClearFlags::Stencil) != 0)
+        renderPassDesc_.stencilAttachment.storeAction = MTLStoreActionDontCare;
+}
+
+/* ----- Pipeline States ----- */
+
+void MTCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    auto& graphicsPipelineMT = LLGL_CAST(MTGraphicsPipeline&, graphicsPipeline);
+
+    renderState_.graphicsPipeline = &graphicsPipelineMT;
+    primitiveType_ = graphicsPipelineMT.GetPrimitiveType();
+
+    /* Static viewports and scissors replace the dynamic ones */
+    if (!graphicsPipelineMT.GetStaticViewports().empty())
+        renderState_.viewports = graphicsPipelineMT.GetStaticViewports();
+    if (!graphicsPipelineMT.GetStaticScissors().empty())
+        renderState_.scissors = graphicsPipelineMT.GetStaticScissors();
+
+    if (renderEncoder_ != nil)
+    {
+        graphicsPipelineMT.Bind(renderEncoder_);
+        ApplyViewports(renderEncoder_);
+        ApplyScissors(renderEncoder_);
+        ApplyGraphicsConstants(renderEncoder_);
+    }
+}
+
+void MTCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    auto& computePipelineMT = LLGL_CAST(MTComputePipeline&, computePipeline);
+
+    computeState_.computePipeline = &computePipelineMT;
+    threadGroupSize_ = computePipelineMT.GetWorkGroupSize();
+
+    if (computeEncoder_ != nil)
+    {
+        computePipelineMT.Bind(computeEncoder_);
+        ApplyComputeConstants(computeEncoder_);
+    }
+}
+
+void MTCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    renderState_.hasStencilReference    = true;
+    renderState_.stencilReference       = reference;
+    if (renderEncoder_ != nil)
+        [renderEncoder_ setStencilReferenceValue:reference];
+}
+
+void MTCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    renderState_.hasBlendFactor = true;
+    renderState_.blendFactor    = color;
+    if (renderEncoder_ != nil)
+        [renderEncoder_ setBlendColorRed:color.r green:color.g blue:color.b alpha:color.a];
+}
+
+void MTCommandBuffer::SetDepthBias(const DepthBiasDescriptor& depthBias)
+{
+    renderState_.hasDepthBias   = true;
+    renderState_.depthBias      = depthBias;
+    if (renderEncoder_ != nil)
+        [renderEncoder_ setDepthBias:depthBias.constantFactor slopeScale:depthBias.slopeFactor clamp:depthBias.clamp];
+}
+
+void MTCommandBuffer::SetDepthBounds(float /*minBounds*/, float /*maxBounds*/)
+{
+    // dummy (depth bounds test is not supported by Metal)
+}
+
+/* ----- Queries ----- */
+
+void MTCommandBuffer::BeginQuery(Query& query)
+{
+    // dummy (queries are not supported by Metal renderer)
+}
+
+void MTCommandBuffer::EndQuery(Query& query)
+{
+    // dummy (queries are not supported by Metal renderer)
+}
+
+bool MTCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    return false;
+}
+
+bool MTCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    return false;
+}
+
+void MTCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::EndRenderCondition()
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    // dummy (queries are not supported by Metal renderer)
+}
+
+void MTCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    // dummy (queries are not supported by Metal renderer)
+}
+
+void MTCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    // dummy (not supported by Metal)
+}
+
+bool MTCommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
+{
+    return false;
+}
+
+void MTCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
+{
+    // dummy (queries are not supported by Metal renderer)
+}
+
+/* ----- Timer Scopes ----- */
+
+void MTCommandBuffer::BeginTimerScope(const char* name)
+{
+    //todo: requires MTLCounterSampleBuffer (macOS 10.15)
+}
+
+void MTCommandBuffer::EndTimerScope()
+{
+    //todo: requires MTLCounterSampleBuffer (macOS 10.15)
+}
+
+bool MTCommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
+{
+    return false;
+}
+
+/* ----- Debug Markers ----- */
+
+void MTCommandBuffer::PushDebugGroup(const char* name)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+        [GetCommandBuffer() pushDebugGroup:[NSString stringWithUTF8String:name]];
+}
+
+void MTCommandBuffer::PopDebugGroup()
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+        [GetCommandBuffer() popDebugGroup];
+}
+
+void MTCommandBuffer::InsertDebugMarker(const char* name)
+{
+    /* Signposts can only be inserted into an active command encoder */
+    NSString* label = [NSString stringWithUTF8String:name];
+    if (renderEncoder_ != nil)
+        [renderEncoder_ insertDebugSignpost:label];
+    else if (computeEncoder_ != nil)
+        [computeEncoder_ insertDebugSignpost:label];
+    else if (blitEncoder_ != nil)
+        [blitEncoder_ insertDebugSignpost:label];
+}
+
+/* ----- Drawing ----- */
+
+void MTCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    [GetRenderEncoder()
+        drawPrimitives: primitiveType_
+        vertexStart:    firstVertex
+        vertexCount:    numVertices
+    ];
+}
+
+void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
+}
+
+void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
+}
+
+void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    [GetRenderEncoder()
+        drawPrimitives: primitiveType_
+        vertexStart:    firstVertex
+        vertexCount:    numVertices
+        instanceCount:  numInstances
+    ];
+}
+
+void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    [GetRenderEncoder()
+        drawPrimitives: primitiveType_
+        vertexStart:    firstVertex
+        vertexCount:    numVertices
+        instanceCount:  numInstances
+        baseInstance:   firstInstance
+    ];
+}
+
+void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    [GetRenderEncoder()
+        drawIndexedPrimitives:  primitiveType_
+        indexCount:             numIndices
+        indexType:              indexType_
+        indexBuffer:            indexBuffer_
+        indexBufferOffset:      GetIndexBufferOffset(firstIndex)
+        instanceCount:          numInstances
+        baseVertex:             vertexOffset
+        baseInstance:           firstInstance
+    ];
+}
+
+void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    [GetRenderEncoder()
+        drawPrimitives:         primitiveType_
+        indirectBuffer:         bufferMT.GetNative()
+        indirectBufferOffset:   static_cast<NSUInteger>(offset)
+    ];
+}
+
+void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    /* Metal has no multi-draw-indirect command, so each command is encoded separately */
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+        DrawIndirect(buffer, offset + static_cast<std::uint64_t>(i) * stride);
+}
+
+void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    [GetRenderEncoder()
+        drawIndexedPrimitives:  primitiveType_
+        indexType:              indexType_
+        indexBuffer:            indexBuffer_
+        indexBufferOffset:      indexBufferOffset_
+        indirectBuffer:         bufferMT.GetNative()
+        indirectBufferOffset:   static_cast<NSUInteger>(offset)
+    ];
+}
+
+void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+        DrawIndexedIndirect(buffer, offset + static_cast<std::uint64_t>(i) * stride);
+}
+
+void MTCommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  layout,
+    Buffer&                 argumentBuffer,
+    std::uint64_t           argumentOffset,
+    std::uint32_t           maxNumCommands,
+    Buffer*                 countBuffer,
+    std::uint64_t           countOffset)
+{
+    // dummy (not supported by Metal, indirect command layouts require D3D12)
+}
+
+void MTCommandBuffer::DrawStreamOutput()
+{
+    // dummy (not supported by Metal)
+}
+
+void MTCommandBuffer::DrawMeshTasks(std::uint32_t /*groupSizeX*/, std::uint32_t /*groupSizeY*/, std::uint32_t /*groupSizeZ*/)
+{
+    // dummy (not supported by Metal renderer)
+}
+
+void MTCommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    // dummy (not supported by Metal renderer)
+}
+
+/* ----- Compute ----- */
+
+void MTCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    [GetComputeEncoder()
+        dispatchThreadgroups:   MTLSizeMake(groupSizeX, groupSizeY, groupSizeZ)
+        threadsPerThreadgroup:  threadGroupSize_
+    ];
+}
+
+void MTCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    [GetComputeEncoder()
+        dispatchThreadgroupsWithIndirectBuffer: bufferMT.GetNative()
+        indirectBufferOffset:                   static_cast<NSUInteger>(offset)
+        threadsPerThreadgroup:                  threadGroupSize_
+    ];
+}
+
+void MTCommandBuffer::DispatchBarrier()
+{
+    // dummy (hazards between dispatches of a serial compute encoder are tracked by Metal)
+}
+
+/* ----- Acceleration Structures ----- */
+
+void MTCommandBuffer::BuildAccelerationStructures(std::uint32_t /*numAccelerationStructures*/, AccelerationStructure* const * /*accelerationStructures*/)
+{
+    // dummy (not supported by Metal renderer)
+}
+
+void MTCommandBuffer::CompactAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/)
+{
+    // dummy (not supported by Metal renderer)
+}
+
+/* ----- Copy ----- */
+
+void MTCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+    auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
+    [GetBlitEncoder()
+        copyFromBuffer:     srcBufferMT.GetNative()
+        sourceOffset:       static_cast<NSUInteger>(srcOffset)
+        toBuffer:           dstBufferMT.GetNative()
+        destinationOffset:  static_cast<NSUInteger>(dstOffset)
+        size:               static_cast<NSUInteger>(size)
+    ];
+}
+
+void MTCommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    // dummy (not supported by Metal, storage buffers have no hidden counters)
+}
+
+void MTCommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    // dummy (not supported by Metal, storage buffers have no hidden counters)
+}
+
+void MTCommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+
+    const auto byte0 = static_cast<std::uint8_t>(value & 0xFF);
+    if (value == byte0 * 0x01010101u)
+    {
+        /* Fill buffer directly if all bytes of the value are equal */
+        [GetBlitEncoder()
+            fillBuffer: dstBufferMT.GetNative()
+            range:      NSMakeRange(static_cast<NSUInteger>(dstOffset), static_cast<NSUInteger>(fillSize))
+            value:      byte0
+        ];
+    }
+    else
+    {
+        /* Metal can only fill buffers with a single byte, so the 32-bit pattern is copied from a temporary buffer (retained by the command buffer) */
+        const auto length = static_cast<NSUInteger>(fillSize);
+        id<MTLBuffer> srcBuffer = [device_ newBufferWithLength:length options:MTLResourceStorageModeShared];
+        MTThrowIfCreateFailed(srcBuffer, "MTLBuffer");
+
+        auto dst = reinterpret_cast<char*>([srcBuffer contents]);
+        for (NSUInteger i = 0; i < length; i += sizeof(value))
+            ::memcpy(dst + i, &value, std::min<NSUInteger>(sizeof(value), length - i));
+
+        [GetBlitEncoder()
+            copyFromBuffer:     srcBuffer
+            sourceOffset:       0
+            toBuffer:           dstBufferMT.GetNative()
+            destinationOffset:  static_cast<NSUInteger>(dstOffset)
+            size:               length
+        ];
+
+        [srcBuffer release];
+    }
+}
+
+void MTCommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
+    auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
+
+    MTLOrigin   srcOrigin, dstOrigin;
+    MTLSize     srcSize, dstSize;
+    NSUInteger  srcFirstSlice = 0, dstFirstSlice = 0, numSlices = 0, dstNumSlices = 0;
+
+    srcTextureMT.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, srcOrigin, srcSize, srcFirstSlice, numSlices);
+    dstTextureMT.GetSubresourceRegion(dstLocation.offset, srcRegion.extent, dstOrigin, dstSize, dstFirstSlice, dstNumSlices);
+
+    auto blitEncoder = GetBlitEncoder();
+    for (NSUInteger i = 0; i < numSlices; ++i)
+    {
+        [blitEncoder
+            copyFromTexture:    srcTextureMT.GetNative()
+            sourceSlice:        srcFirstSlice + i
+            sourceLevel:        srcRegion.mipLevel
+            sourceOrigin:       srcOrigin
+            sourceSize:         srcSize
+            toTexture:          dstTextureMT.GetNative()
+            destinationSlice:   dstFirstSlice + i
+            destinationLevel:   dstLocation.mipLevel
+            destinationOrigin:  dstOrigin
+        ];
+    }
+}
+
+void MTCommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+    id<MTLTexture> textureNative = textureMT.GetNative();
+
+    /* Metal can only clear textures with the load action of a render pass */
+    if (([textureNative usage] & MTLTextureUsageRenderTarget) == 0)
+        throw std::runtime_error("cannot clear Metal texture that has been created without attachment binding flag");
+
+    EndActiveEncoder();
+
+    const bool isDepthStencil   = IsDepthStencilFormat(textureMT.GetFormat());
+    const bool isVolume         = ([textureNative textureType] == MTLTextureType3D);
+
+    MTLRenderPassDescriptor* renderPassDesc = [[MTLRenderPassDescriptor alloc] init];
+
+    for (std::uint32_t mip = 0; mip < subresource.numMipLevels; ++mip)
+    {
+        const auto level        = static_cast<NSUInteger>(subresource.baseMipLevel + mip);
+        const auto firstLayer   = static_cast<NSUInteger>(subresource.baseArrayLayer);
+        const auto numLayers    = (isVolume ? std::max<NSUInteger>(1, [textureNative depth] >> level) : static_cast<NSUInteger>(subresource.numArrayLayers));
+
+        for (NSUInteger layer = (isVolume ? 0 : firstLayer); layer < (isVolume ? numLayers : firstLayer + numLayers); ++layer)
+        {
+            /* Configure attachment for the current subresource */
+            if (isDepthStencil)
+            {
+                renderPassDesc.depthAttachment.texture      = textureNative;
+                renderPassDesc.depthAttachment.level        = level;
+                renderPassDesc.depthAttachment.slice        = (isVolume ? 0 : layer);
+                renderPassDesc.depthAttachment.loadAction   = MTLLoadActionClear;
+                renderPassDesc.depthAttachment.storeAction  = MTLStoreActionStore;
+                renderPassDesc.depthAttachment.clearDepth   = static_cast<double>(clearValue.depth);
+
+                if (MTIsStencilFormat([textureNative pixelFormat]))
+                {
+                    renderPassDesc.stencilAttachment.texture        = textureNative;
+                    renderPassDesc.stencilAttachment.level          = level;
+                    renderPassDesc.stencilAttachment.slice          = (isVolume ? 0 : layer);
+                    renderPassDesc.stencilAttachment.loadAction     = MTLLoadActionClear;
+                    renderPassDesc.stencilAttachment.storeAction    = MTLStoreActionStore;
+                    renderPassDesc.stencilAttachment.clearStencil   = clearValue.stencil;
+                }
+            }
+            else
+            {
+                auto attachment = renderPassDesc.colorAttachments[0];
+                attachment.texture      = textureNative;
+                attachment.level        = level;
+                attachment.slice        = (isVolume ? 0 : layer);
+                attachment.depthPlane   = (isVolume ? layer : 0);
+                attachment.loadAction   = MTLLoadActionClear;
+                attachment.storeAction  = MTLStoreActionStore;
+                attachment.clearColor = ToNativeClearColor(clearValue.color);
+            }
+
+            /* Encode empty render pass that only clears the subresource */
+            id<MTLRenderCommandEncoder> renderEncoder = [GetCommandBuffer() renderCommandEncoderWithDescriptor:renderPassDesc];
+            [renderEncoder endEncoding];
+        }
+    }
+
+    [renderPassDesc release];
+}
+
+// Returns the number of bytes of a single row and image of the specified texture region with tightly packed data.
+static void GetTightDataLayout(const Format format, const MTLSize& size, std::uint32_t rowStride, NSUInteger& bytesPerRow, NSUInteger& bytesPerImage)
+{
+    const auto blockExtent  = FormatBlockExtent(format);
+    const auto numBlocksX   = (size.width  + blockExtent.width  - 1) / blockExtent.width;
+    const auto numBlocksY   = (size.height + blockExtent.height - 1) / blockExtent.height;
+
+    bytesPerRow     = (rowStride > 0 ? static_cast<NSUInteger>(rowStride) : numBlocksX * FormatBlockSize(format));
+    bytesPerImage   = bytesPerRow * numBlocksY;
+}
+
+void MTCommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
+    auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
+
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice = 0, numSlices = 0;
+    dstTextureMT.GetSubresourceRegion(dstRegion.offset, dstRegion.extent, origin, size, firstSlice, numSlices);
+
+    NSUInteger bytesPerRow = 0, bytesPerImage = 0;
+    GetTightDataLayout(dstTextureMT.GetFormat(), size, rowStride, bytesPerRow, bytesPerImage);
+
+    /* Each array layer is copied separately, since the blit command can only address a single slice */
+    auto blitEncoder = GetBlitEncoder();
+    for (NSUInteger i = 0; i < numSlices; ++i)
+    {
+        [blitEncoder
+            copyFromBuffer:         srcBufferMT.GetNative()
+            sourceOffset:           static_cast<NSUInteger>(srcOffset) + i * bytesPerImage * size.depth
+            sourceBytesPerRow:      bytesPerRow
+            sourceBytesPerImage:    bytesPerImage
+            sourceSize:             size
+            toTexture:              dstTextureMT.GetNative()
+            destinationSlice:       firstSlice + i
+            destinationLevel:       dstRegion.mipLevel
+            destinationOrigin:      origin
+        ];
+    }
+}
+
+void MTCommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+    auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
+
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice = 0, numSlices = 0;
+    srcTextureMT.GetSubresourceRegion(srcRegion.offset, srcRegion.extent, origin, size, firstSlice, numSlices);
+
+    NSUInteger bytesPerRow = 0, bytesPerImage = 0;
+    GetTightDataLayout(srcTextureMT.GetFormat(), size, rowStride, bytesPerRow, bytesPerImage);
+
+    auto blitEncoder = GetBlitEncoder();
+    for (NSUInteger i = 0; i < numSlices; ++i)
+    {
+        [blitEncoder
+            copyFromTexture:            srcTextureMT.GetNative()
+            sourceSlice:                firstSlice + i
+            sourceLevel:                srcRegion.mipLevel
+            sourceOrigin:               origin
+            sourceSize:                 size
+            toBuffer:                   dstBufferMT.GetNative()
+            destinationOffset:          static_cast<NSUInteger>(dstOffset) + i * bytesPerImage * size.depth
+            destinationBytesPerRow:     bytesPerRow
+            destinationBytesPerImage:   bytesPerImage
+        ];
+    }
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void MTCommandBuffer::Begin()
+{
+    // dummy (primary command buffers begin their recordings implicitly)
+}
+
+void MTCommandBuffer::End()
+{
+    // dummy (primary command buffers end their recordings implicitly)
+}
+
+void MTCommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    // dummy (secondary command buffers are not supported by Metal renderer)
+}
+
+/* --- Extended functions --- */
+
+id<MTLCommandBuffer> MTCommandBuffer::EndCommandBuffer()
+{
+    EndRenderPass();
+
+    /* Transient memory of this recording is recycled when its command buffer has been completed */
+    if (transientRing_.HasOpenSegment())
+        CloseTransientMemory(GetCommandBuffer());
+
+    id<MTLCommandBuffer> cmdBuffer = cmdBuffer_;
+    cmdBuffer_      = nil;
+    presentable_    = false;
+
+    ResetStates();
+
+    return cmdBuffer;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+id<MTLCommandBuffer> MTCommandBuffer::GetCommandBuffer()
+{
+    if (cmdBuffer_ == nil)
+        cmdBuffer_ = commandQueue_.CreateCommandBuffer();
+    return cmdBuffer_;
+}
+
+id<MTLRenderCommandEncoder> MTCommandBuffer::GetRenderEncoder()
+{
+    if (renderEncoder_ == nil)
+    {
+        if (renderPassDesc_ == nil)
+            throw std::runtime_error("cannot encode Metal render command outside of a render pass");
+
+        EndActiveEncoder();
+
+        renderEncoder_ = [[GetCommandBuffer() renderCommandEncoderWithDescriptor:renderPassDesc_] retain];
+        MTThrowIfCreateFailed(renderEncoder_, "MTLRenderCommandEncoder");
+
+        /* Continue render pass with the next encoder and restore the states of the previous one */
+        ContinueNativeRenderPass();
+        ApplyRenderState(renderEncoder_);
+    }
+    return renderEncoder_;
+}
+
+id<MTLComputeCommandEncoder> MTCommandBuffer::GetComputeEncoder()
+{
+    if (computeEncoder_ == nil)
+    {
+        EndActiveEncoder();
+
+        computeEncoder_ = [[GetCommandBuffer() computeCommandEncoder] retain];
+        MTThrowIfCreateFailed(computeEncoder_, "MTLComputeCommandEncoder");
+
+        ApplyComputeState(computeEncoder_);
+    }
+    return computeEncoder_;
+}
+
+id<MTLBlitCommandEncoder> MTCommandBuffer::GetBlitEncoder()
+{
+    if (blitEncoder_ == nil)
+    {
+        EndActiveEncoder();
+
+        blitEncoder_ = [[GetCommandBuffer() blitCommandEncoder] retain];
+        MTThrowIfCreateFailed(blitEncoder_, "MTLBlitCommandEncoder");
+    }
+    return blitEncoder_;
+}
+
+void MTCommandBuffer::EndActiveEncoder()
+{
+    if (renderEncoder_ != nil)
+    {
+        [renderEncoder_ endEncoding];
+        [renderEncoder_ release];
+        renderEncoder_ = nil;
+    }
+    if (computeEncoder_ != nil)
+    {
+        [computeEncoder_ endEncoding];
+        [computeEncoder_ release];
+        computeEncoder_ = nil;
+    }
+    if (blitEncoder_ != nil)
+    {
+        [blitEncoder_ endEncoding];
+        [blitEncoder_ release];
+        blitEncoder_ = nil;
+    }
+}
+
+// Returns the store action for the specified attachment, which also resolves multi-sampled attachments.
+static MTLStoreAction GetStoreAction(MTLRenderPassAttachmentDescriptor* attachment, const AttachmentStoreOp storeOp)
+{
+    if (attachment.resolveTexture != nil)
+        return (storeOp == AttachmentStoreOp::Store ? MTLStoreActionStoreAndMultisampleResolve : MTLStoreActionMultisampleResolve);
+    else
+        return MTTypes::Map(storeOp);
+}
+
+void MTCommandBuffer::BeginNativeRenderPass(
+    MTLRenderPassDescriptor*    renderPassDesc,
+    NSUInteger                  numColorAttachments,
+    const Extent2D&             extent,
+    const RenderPass*           renderPass,
+    std::uint32_t               numClearValues,
+    const ClearValue*           clearValues)
+{
+    EndRenderPass();
+
+    /* Copy native descriptor, since the load and store actions are modified during the render pass */
+    renderPassDesc_         = [renderPassDesc copy];
+    numColorAttachments_    = numColorAttachments;
+    framebufferExtent_      = extent;
+    pendingClears_          = false;
+
+    /* Clear values are consumed in the order of the attachments with clear operation */
+    std::uint32_t clearValueIndex = 0;
+
+    auto NextClearValue = [&]() -> ClearValue
+    {
+        if (clearValueIndex < numClearValues)
+            return clearValues[clearValueIndex++];
+
+        ClearValue clearValue;
+        {
+            clearValue.color    = clearColor_;
+            clearValue.depth    = static_cast<float>(clearDepth_);
+            clearValue.stencil  = clearStencil_;
+        }
+        return clearValue;
+    };
+
+    const AttachmentOpsDescriptor defaultOps;
+
+    for (NSUInteger i = 0; i < numColorAttachments_; ++i)
+    {
+        auto attachment = renderPassDesc_.colorAttachments[i];
+        const auto& ops = (renderPass != nullptr ? renderPass->GetColorAttachmentOps(static_cast<std::uint32_t>(i)) : defaultOps);
+
+        attachment.loadAction   = MTTypes::Map(ops.loadOp);
+        attachment.storeAction  = GetStoreAction(attachment, ops.storeOp);
+
+        if (ops.loadOp == AttachmentLoadOp::Clear)
+        {
+            attachment.clearColor = ToNativeClearColor(NextClearValue().color);
+            pendingClears_ = true;
+        }
+    }
+
+    const auto& depthOps    = (renderPass != nullptr ? renderPass->GetDesc().depthAttachment : defaultOps);
+    const auto& stencilOps  = (renderPass != nullptr ? renderPass->GetDesc().stencilAttachment : defaultOps);
+
+    if (renderPassDesc_.depthAttachment.texture != nil || renderPassDesc_.stencilAttachment.texture != nil)
+    {
+        /* Depth and stencil components share a single clear value */
+        ClearValue clearValue;
+        if (depthOps.loadOp == AttachmentLoadOp::Clear || stencilOps.loadOp == AttachmentLoadOp::Clear)
+        {
+            clearValue      = NextClearValue();
+            pendingClears_  = true;
+        }
+
+        if (renderPassDesc_.depthAttachment.texture != nil)
+        {
+            renderPassDesc_.depthAttachment.loadAction  = MTTypes::Map(depthOps.loadOp);
+            renderPassDesc_.depthAttachment.storeAction = GetStoreAction(renderPassDesc_.depthAttachment, depthOps.storeOp);
+            renderPassDesc_.depthAttachment.clearDepth  = static_cast<double>(clearValue.depth);
+        }
+
+        if (renderPassDesc_.stencilAttachment.texture != nil)
+        {
+            renderPassDesc_.stencilAttachment.loadAction    = MTTypes::Map(stencilOps.loadOp);
+            renderPassDesc_.stencilAttachment.storeAction   = GetStoreAction(renderPassDesc_.stencilAttachment, stencilOps.storeOp);
+            renderPassDesc_.stencilAttachment.clearStencil  = clearValue.stencil;
+        }
+    }
+}
+
+void MTCommandBuffer::ContinueNativeRenderPass()
+{
+    for (NSUInteger i = 0; i < numColorAttachments_; ++i)
+        renderPassDesc_.colorAttachments[i].loadAction = MTLLoadActionLoad;
+    renderPassDesc_.depthAttachment.loadAction = MTLLoadActionLoad;
+    renderPassDesc_.stencilAttachment.loadAction = MTLLoadActionLoad;
+    pendingClears_ = false;
+}
+
+void MTCommandBuffer::ReleaseRenderPass()
+{
+    [renderPassDesc_ release];
+    renderPassDesc_         = nil;
+    numColorAttachments_    = 0;
+    pendingClears_          = false;
+}
+
+void MTCommandBuffer::ApplyRenderState(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    const auto& state = renderState_;
+
+    if (state.graphicsPipeline != nullptr)
+        state.graphicsPipeline->Bind(renderEncoder);
+
+    ApplyViewports(renderEncoder);
+    ApplyScissors(renderEncoder);
+
+    for (NSUInteger i = 0; i < state.numVertexBuffers; ++i)
+        [renderEncoder setVertexBuffer:state.vertexBuffers[i] offset:state.vertexOffsets[i] atIndex:MTVertexBufferIndex(static_cast<std::uint32_t>(i))];
+
+    /* Dynamic states override the static states of the pipeline */
+    if (state.hasStencilReference)
+        [renderEncoder setStencilReferenceValue:state.stencilReference];
+    if (state.hasBlendFactor)
+        [renderEncoder setBlendColorRed:state.blendFactor.r green:state.blendFactor.g blue:state.blendFactor.b alpha:state.blendFactor.a];
+    if (state.hasDepthBias)
+        [renderEncoder setDepthBias:state.depthBias.constantFactor slopeScale:state.depthBias.slopeFactor clamp:state.depthBias.clamp];
+
+    if (state.resourceHeap != nullptr)
+        state.resourceHeap->BindGraphicsResources(renderEncoder, static_cast<std::uint32_t>(state.dynamicOffsets.size()), state.dynamicOffsets.data());
+
+    ApplyBoundResources(renderEncoder);
+    ApplyGraphicsConstants(renderEncoder);
+}
+
+void MTCommandBuffer::ApplyComputeState(id<MTLComputeCommandEncoder> computeEncoder)
+{
+    const auto& state = computeState_;
+
+    if (state.computePipeline != nullptr)
+        state.computePipeline->Bind(computeEncoder);
+
+    if (state.resourceHeap != nullptr)
+        state.resourceHeap->BindComputeResources(computeEncoder, static_cast<std::uint32_t>(state.dynamicOffsets.size()), state.dynamicOffsets.data());
+
+    ApplyBoundResources(computeEncoder);
+    ApplyComputeConstants(computeEncoder);
+}
+
+void MTCommandBuffer::ApplyViewports(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    const auto& viewports = renderState_.viewports;
+    if (viewports.size() == 1)
+        [renderEncoder setViewport:viewports.front()];
+    else if (viewports.size() > 1)
+    {
+        if (@available(macOS 10.13, iOS 12.0, *))
+            [renderEncoder setViewports:viewports.data() count:viewports.size()];
+        else
+            [renderEncoder setViewport:viewports.front()];
+    }
+}
+
+// Returns the scissor rectangle clamped to the framebuffer, since Metal does not allow scissor rectangles outside the render target.
+static MTLScissorRect ClampScissorRect(const MTLScissorRect& rect, const Extent2D& extent)
+{
+    MTLScissorRect clamped;
+    {
+        clamped.x       = std::min<NSUInteger>(rect.x, extent.width);
+        clamped.y       = std::min<NSUInteger>(rect.y, extent.height);
+        clamped.width   = std::min<NSUInteger>(rect.width, extent.width - clamped.x);
+        clamped.height  = std::min<NSUInteger>(rect.height, extent.height - clamped.y);
+    }
+    return clamped;
+}
+
+void MTCommandBuffer::ApplyScissors(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    const auto& scissors = renderState_.scissors;
+    const auto pipeline = renderState_.graphicsPipeline;
+
+    if (scissors.empty() || (pipeline != nullptr && !pipeline->IsScissorTestEnabled()))
+    {
+        /* Metal has no scissor test switch, so the scissor rectangle covers the entire framebuffer */
+        MTLScissorRect rect = { 0, 0, framebufferExtent_.width, framebufferExtent_.height };
+        [renderEncoder setScissorRect:rect];
+    }
+    else if (scissors.size() == 1)
+        [renderEncoder setScissorRect:ClampScissorRect(scissors.front(), framebufferExtent_)];
+    else
+    {
+        std::vector<MTLScissorRect> rects(scissors.size());
+        for (std::size_t i = 0; i < scissors.size(); ++i)
+            rects[i] = ClampScissorRect(scissors[i], framebufferExtent_);
+
+        if (@available(macOS 10.13, iOS 12.0, *))
+            [renderEncoder setScissorRects:rects.data() count:rects.size()];
+        else
+            [renderEncoder setScissorRect:rects.front()];
+    }
+}
+
+void MTCommandBuffer::ApplyGraphicsConstants(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    const auto pipeline = renderState_.graphicsPipeline;
+    if (graphicsConstants_.empty() || pipeline == nullptr)
+        return;
+
+    const auto& constants = pipeline->GetConstants();
+    if (constants.size == 0)
+        return;
+
+    const auto length = std::min<NSUInteger>(graphicsConstants_.size(), constants.size);
+    if ((constants.stageFlags & StageFlags::VertexStage) != 0)
+        [renderEncoder setVertexBytes:graphicsConstants_.data() length:length atIndex:constants.slot];
+    if ((constants.stageFlags & StageFlags::FragmentStage) != 0)
+        [renderEncoder setFragmentBytes:graphicsConstants_.data() length:length atIndex:constants.slot];
+}
+
+void MTCommandBuffer::ApplyComputeConstants(id<MTLComputeCommandEncoder> computeEncoder)
+{
+    const auto pipeline = computeState_.computePipeline;
+    if (computeConstants_.empty() || pipeline == nullptr)
+        return;
+
+    const auto& constants = pipeline->GetConstants();
+    if (constants.size == 0)
+        return;
+
+    const auto length = std::min<NSUInteger>(computeConstants_.size(), constants.size);
+    [computeEncoder setBytes:computeConstants_.data() length:length atIndex:constants.slot];
+}
+
+void MTCommandBuffer::ApplyBoundResources(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    for (NSUInteger i = 0; i < boundBuffers_.size(); ++i)
+    {
+        const auto& binding = boundBuffers_[i];
+        if ((binding.stageFlags & StageFlags::VertexStage) != 0)
+            [renderEncoder setVertexBuffer:binding.resource offset:binding.offset atIndex:i];
+        if ((binding.stageFlags & StageFlags::FragmentStage) != 0)
+            [renderEncoder setFragmentBuffer:binding.resource offset:binding.offset atIndex:i];
+    }
+    for (NSUInteger i = 0; i < boundTextures_.size(); ++i)
+    {
+        const auto& binding = boundTextures_[i];
+        if ((binding.stageFlags & StageFlags::VertexStage) != 0)
+            [renderEncoder setVertexTexture:binding.resource atIndex:i];
+        if ((binding.stageFlags & StageFlags::FragmentStage) != 0)
+            [renderEncoder setFragmentTexture:binding.resource atIndex:i];
+    }
+    for (NSUInteger i = 0; i < boundSamplers_.size(); ++i)
+    {
+        const auto& binding = boundSamplers_[i];
+        if ((binding.stageFlags & StageFlags::VertexStage) != 0)
+            [renderEncoder setVertexSamplerState:binding.resource atIndex:i];
+        if ((binding.stageFlags & StageFlags::FragmentStage) != 0)
+            [renderEncoder setFragmentSamplerState:binding.resource atIndex:i];
+    }
+}
+
+void MTCommandBuffer::ApplyBoundResources(id<MTLComputeCommandEncoder> computeEncoder)
+{
+    for (NSUInteger i = 0; i < boundBuffers_.size(); ++i)
+    {
+        const auto& binding = boundBuffers_[i];
+        if ((binding.stageFlags & StageFlags::ComputeStage) != 0)
+            [computeEncoder setBuffer:binding.resource offset:binding.offset atIndex:i];
+    }
+    for (NSUInteger i = 0; i < boundTextures_.size(); ++i)
+    {
+        const auto& binding = boundTextures_[i];
+        if ((binding.stageFlags & StageFlags::ComputeStage) != 0)
+            [computeEncoder setTexture:binding.resource atIndex:i];
+    }
+    for (NSUInteger i = 0; i < boundSamplers_.size(); ++i)
+    {
+        const auto& binding = boundSamplers_[i];
+        if ((binding.stageFlags & StageFlags::ComputeStage) != 0)
+            [computeEncoder setSamplerState:binding.resource atIndex:i];
+    }
+}
+
+void MTCommandBuffer::BindResource(std::vector<BoundResource>& cache, id resource, NSUInteger offset, std::uint32_t slot, long stageFlags)
+{
+    if (slot >= cache.size())
+        cache.resize(slot + 1);
+
+    auto& binding = cache[slot];
+    {
+        binding.resource    = resource;
+        binding.offset      = offset;
+        binding.stageFlags  = stageFlags;
+    }
+
+    /* Bind all cached resources to the active encoder; unchanged bindings are filtered by the Metal driver */
+    if (renderEncoder_ != nil)
+        ApplyBoundResources(renderEncoder_);
+    if (computeEncoder_ != nil)
+        ApplyBoundResources(computeEncoder_);
+}
+
+NSUInteger MTCommandBuffer::GetIndexBufferOffset(std::uint32_t firstIndex) const
+{
+    const NSUInteger indexSize = (indexType_ == MTLIndexTypeUInt16 ? 2 : 4);
+    return (indexBufferOffset_ + static_cast<NSUInteger>(firstIndex) * indexSize);
+}
+
+void MTCommandBuffer::CreateTransientBuffer()
+{
+    /* Create host-visible ring buffer, which is persistently mapped by the shared storage mode */
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type     = BufferType::Constant;
+        bufferDesc.size     = g_transientRingSize;
+        bufferDesc.flags    = BufferFlags::DynamicUsage;
+    }
+    transientBuffer_ = std::unique_ptr<MTBuffer>(new MTBuffer(device_, heapAllocator_, bufferDesc, nullptr));
+    transientRing_.Reset(g_transientRingSize);
+}
+
+void MTCommandBuffer::CloseTransientMemory(id<MTLCommandBuffer> cmdBuffer)
+{
+    /* Recycle memory of all command buffers that have been completed already */
+    while (transientRing_.HasClosedSegments())
+    {
+        id<MTLCommandBuffer> oldestCmdBuffer = transientRing_.GetOldestTag();
+        const auto status = [oldestCmdBuffer status];
+        if (status != MTLCommandBufferStatusCompleted && status != MTLCommandBufferStatusError)
+            break;
+        [oldestCmdBuffer release];
+        transientRing_.ReleaseOldest();
+    }
+
+    /* Keep command buffer alive until its segment of the ring has been released */
+    transientRing_.Close([cmdBuffer retain]);
+}
+
+void MTCommandBuffer::ResetStates()
+{
+    renderState_ = RenderState{};
+    for (NSUInteger i = 0; i < g_maxNumVertexBuffers; ++i)
+    {
+        renderState_.vertexBuffers[i] = nil;
+        renderState_.vertexOffsets[i] = 0;
+    }
+
+    computeState_ = ComputeState{};
+
+    primitiveType_      = MTLPrimitiveTypeTriangle;
+    threadGroupSize_    = MTLSizeMake(1, 1, 1);
+
+    boundBuffers_.clear();
+    boundTextures_.clear();
+    boundSamplers_.clear();
+
+    graphicsConstants_.clear();
+    computeConstants_.clear();
+
+    indexBuffer_        = nil;
+    indexBufferOffset_  = 0;
+    indexType_          = MTLIndexTypeUInt32;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
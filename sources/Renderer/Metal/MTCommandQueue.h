@@ -0,0 +1,97 @@
+/*
+ * MTCommandQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_COMMAND_QUEUE_H
+#define LLGL_MT_COMMAND_QUEUE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/CommandQueue.h>
+
+
+namespace LLGL
+{
+
+
+class MTCommandQueue final : public CommandQueue
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        MTCommandQueue(id<MTLDevice> device);
+        ~MTCommandQueue();
+
+        /* ----- Command queues ----- */
+
+        void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence = nullptr, std::uint64_t signalValue = 0) override;
+
+        /* ----- Fences ----- */
+
+        void Submit(Fence& fence) override;
+
+        bool WaitFence(Fence& fence, std::uint64_t timeout) override;
+        void WaitIdle() override;
+
+        /* ----- Timeline fences ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        bool WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout) override;
+
+        /* ----- Extended functions ----- */
+
+        // Returns a new command buffer of this queue. The returned object is retained by the caller.
+        id<MTLCommandBuffer> CreateCommandBuffer();
+
+        // Commits the specified command buffer after all pending uploads, and keeps it as the last command buffer of this queue.
+        void Commit(id<MTLCommandBuffer> cmdBuffer);
+
+        // Returns the blit command encoder all uploads of the render system are batched into until the next commit.
+        id<MTLBlitCommandEncoder> GetUploadEncoder();
+
+        // Commits the pending uploads, if there are any.
+        void FlushUploads();
+
+        // Commits the pending uploads and blocks the CPU until the GPU has completed all committed command buffers.
+        void FlushUploadsAndWait();
+
+        // Returns the native command queue.
+        inline id<MTLCommandQueue> GetNative() const
+        {
+            return queue_;
+        }
+
+    private:
+
+        void SubmitCommandBuffer(CommandBuffer& commandBuffer);
+
+        // Sets the last committed command buffer of this queue.
+        void SetLastCommandBuffer(id<MTLCommandBuffer> cmdBuffer);
+
+    private:
+
+        id<MTLCommandQueue>         queue_              = nil;
+        id<MTLCommandBuffer>        uploadCmdBuffer_    = nil;  // Command buffer of pending uploads, see GetUploadEncoder
+        id<MTLBlitCommandEncoder>   uploadEncoder_      = nil;
+        id<MTLCommandBuffer>        lastCmdBuffer_      = nil;  // Last committed command buffer, see WaitIdle
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,204 @@
+/*
+ * MTCommandQueue.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTCommandQueue.h"
+#include "MTCommandBuffer.h"
+#include "MTCore.h"
+#include "RenderState/MTFence.h"
+#include "../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+MTCommandQueue::MTCommandQueue(id<MTLDevice> device)
+{
+    queue_ = [device newCommandQueue];
+    MTThrowIfCreateFailed(queue_, "MTLCommandQueue");
+}
+
+MTCommandQueue::~MTCommandQueue()
+{
+    FlushUploadsAndWait();
+    [lastCmdBuffer_ release];
+    [queue_ release];
+}
+
+/* ----- Command queues ----- */
+
+void MTCommandQueue::Submit(CommandBuffer& commandBuffer)
+{
+    SubmitCommandBuffer(commandBuffer);
+}
+
+void MTCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence, std::uint64_t signalValue)
+{
+    /* Metal executes command buffers in the order they are committed, so they don't need to be batched */
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        SubmitCommandBuffer(*commandBuffers[i]);
+
+    if (signalFence != nullptr)
+        Signal(*signalFence, signalValue);
+}
+
+/* ----- Fences ----- */
+
+void MTCommandQueue::Submit(Fence& fence)
+{
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    id<MTLCommandBuffer> cmdBuffer = CreateCommandBuffer();
+    {
+        fenceMT.SignalNext(cmdBuffer);
+        Commit(cmdBuffer);
+    }
+    [cmdBuffer release];
+}
+
+bool MTCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
+{
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    return fenceMT.Wait(timeout);
+}
+
+void MTCommandQueue::WaitIdle()
+{
+    FlushUploadsAndWait();
+}
+
+/* ----- Timeline fences ----- */
+
+void MTCommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    id<MTLCommandBuffer> cmdBuffer = CreateCommandBuffer();
+    {
+        fenceMT.Signal(cmdBuffer, value);
+        Commit(cmdBuffer);
+    }
+    [cmdBuffer release];
+}
+
+void MTCommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    /* Let all subsequently committed command buffers wait for the shared event on the GPU */
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    id<MTLCommandBuffer> cmdBuffer = CreateCommandBuffer();
+    {
+        [cmdBuffer encodeWaitForEvent:fenceMT.GetNative() value:value];
+        Commit(cmdBuffer);
+    }
+    [cmdBuffer release];
+}
+
+bool MTCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    return fenceMT.WaitValue(value, timeout);
+}
+
+bool MTCommandQueue::WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout)
+{
+    for (std::uint32_t i = 0; i < numFences; ++i)
+    {
+        auto fenceMT = LLGL_CAST(MTFence*, fences[i]);
+        if (values != nullptr)
+        {
+            if (!fenceMT->WaitValue(values[i], timeout))
+                return false;
+        }
+        else
+        {
+            if (!fenceMT->Wait(timeout))
+                return false;
+        }
+    }
+    return true;
+}
+
+/* ----- Extended functions ----- */
+
+id<MTLCommandBuffer> MTCommandQueue::CreateCommandBuffer()
+{
+    id<MTLCommandBuffer> cmdBuffer = [[queue_ commandBuffer] retain];
+    MTThrowIfCreateFailed(cmdBuffer, "MTLCommandBuffer");
+    return cmdBuffer;
+}
+
+void MTCommandQueue::Commit(id<MTLCommandBuffer> cmdBuffer)
+{
+    FlushUploads();
+    [cmdBuffer commit];
+    SetLastCommandBuffer(cmdBuffer);
+}
+
+id<MTLBlitCommandEncoder> MTCommandQueue::GetUploadEncoder()
+{
+    if (uploadEncoder_ == nil)
+    {
+        uploadCmdBuffer_    = CreateCommandBuffer();
+        uploadEncoder_      = [[uploadCmdBuffer_ blitCommandEncoder] retain];
+    }
+    return uploadEncoder_;
+}
+
+void MTCommandQueue::FlushUploads()
+{
+    if (uploadCmdBuffer_ != nil)
+    {
+        [uploadEncoder_ endEncoding];
+        [uploadEncoder_ release];
+        uploadEncoder_ = nil;
+
+        [uploadCmdBuffer_ commit];
+        SetLastCommandBuffer(uploadCmdBuffer_);
+
+        [uploadCmdBuffer_ release];
+        uploadCmdBuffer_ = nil;
+    }
+}
+
+void MTCommandQueue::FlushUploadsAndWait()
+{
+    FlushUploads();
+    if (lastCmdBuffer_ != nil)
+        [lastCmdBuffer_ waitUntilCompleted];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTCommandQueue::SubmitCommandBuffer(CommandBuffer& commandBuffer)
+{
+    auto& commandBufferMT = LLGL_CAST(MTCommandBuffer&, commandBuffer);
+
+    /* Command buffers that render into a render context are committed when the render context is presented */
+    if (commandBufferMT.IsPresentable())
+        return;
+
+    if (id<MTLCommandBuffer> cmdBuffer = commandBufferMT.EndCommandBuffer())
+    {
+        Commit(cmdBuffer);
+        [cmdBuffer release];
+    }
+}
+
+void MTCommandQueue::SetLastCommandBuffer(id<MTLCommandBuffer> cmdBuffer)
+{
+    [cmdBuffer retain];
+    [lastCmdBuffer_ release];
+    lastCmdBuffer_ = cmdBuffer;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,47 @@
+/*
+ * MTCore.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_CORE_H
+#define LLGL_MT_CORE_H
+
+
+#import <Metal/Metal.h>
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Number of buffer slots in the Metal argument table of each shader stage. Vertex buffers are bound in reverse order from the top, so they do not collide with constant buffers.
+static const NSUInteger g_maxNumVertexBuffers = 31;
+
+// Throws a std::runtime_error exception if 'error' is not nil, and appends the localized description of the error.
+void MTThrowIfFailed(NSError* error, const char* info);
+
+// Throws a std::runtime_error exception if 'object' is nil.
+void MTThrowIfCreateFailed(id object, const char* typeName);
+
+// Returns true if the specified pixel format has a stencil component.
+bool MTIsStencilFormat(MTLPixelFormat pixelFormat);
+
+// Returns the Metal buffer index of the specified vertex input slot, i.e. the vertex buffers are bound in reverse order beginning with index 30.
+inline NSUInteger MTVertexBufferIndex(std::uint32_t inputSlot)
+{
+    return (g_maxNumVertexBuffers - 1 - static_cast<NSUInteger>(inputSlot));
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * MTCore.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTCore.h"
+#include <LLGL/Platform/Platform.h>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+void MTThrowIfFailed(NSError* error, const char* info)
+{
+    if (error != nil)
+    {
+        std::string s = (info != nullptr ? info : "Metal operation failed");
+
+        if (auto desc = [[error localizedDescription] UTF8String])
+        {
+            s += ": ";
+            s += desc;
+        }
+
+        throw std::runtime_error(s);
+    }
+}
+
+void MTThrowIfCreateFailed(id object, const char* typeName)
+{
+    if (object == nil)
+    {
+        std::string s = "failed to create instance of <";
+        s += typeName;
+        s += ">";
+        throw std::runtime_error(s);
+    }
+}
+
+bool MTIsStencilFormat(MTLPixelFormat pixelFormat)
+{
+    switch (pixelFormat)
+    {
+        #ifdef LLGL_OS_MACOS
+        case MTLPixelFormatDepth24Unorm_Stencil8:
+        #endif
+        case MTLPixelFormatDepth32Float_Stencil8:
+        case MTLPixelFormatStencil8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,71 @@
+/*
+ * MTHeapAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_HEAP_ALLOCATOR_H
+#define LLGL_MT_HEAP_ALLOCATOR_H
+
+
+#import <Metal/Metal.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Allocates GPU-private buffers and textures from a pool of MTLHeap blocks.
+Resources that are larger than the block size get their own heap, and if the block size is zero, all resources are allocated directly from the device.
+The heaps use tracked hazards, so no explicit MTLFence synchronization is required between encoders.
+*/
+class MTHeapAllocator
+{
+
+    public:
+
+        MTHeapAllocator(id<MTLDevice> device, std::uint64_t blockSize);
+        ~MTHeapAllocator();
+
+        MTHeapAllocator(const MTHeapAllocator&) = delete;
+        MTHeapAllocator& operator = (const MTHeapAllocator&) = delete;
+
+        // Allocates a new GPU-private buffer. The returned object is retained by the caller.
+        id<MTLBuffer> NewBuffer(NSUInteger length);
+
+        // Allocates a new GPU-private texture. The storage mode of the descriptor is set to MTLStorageModePrivate. The returned object is retained by the caller.
+        id<MTLTexture> NewTexture(MTLTextureDescriptor* texDesc);
+
+        // Returns the total size (in bytes) of all heaps.
+        std::uint64_t GetTotalHeapSize() const;
+
+        // Returns the size (in bytes) that is currently allocated from all heaps.
+        std::uint64_t GetUsedHeapSize() const;
+
+    private:
+
+        // Returns a heap with enough space for the specified size and alignment, or creates a new one.
+        id<MTLHeap> FindOrCreateHeap(NSUInteger size, NSUInteger alignment);
+
+    private:
+
+        id<MTLDevice>           device_     = nil;
+        std::uint64_t           blockSize_  = 0;
+        std::vector<id<MTLHeap>> heaps_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
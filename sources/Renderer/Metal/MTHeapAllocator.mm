@@ -0,0 +1,125 @@
+/*
+ * MTHeapAllocator.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTHeapAllocator.h"
+#include "MTCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+MTHeapAllocator::MTHeapAllocator(id<MTLDevice> device, std::uint64_t blockSize) :
+    device_    { device    },
+    blockSize_ { blockSize }
+{
+}
+
+MTHeapAllocator::~MTHeapAllocator()
+{
+    for (id<MTLHeap> heap : heaps_)
+        [heap release];
+}
+
+id<MTLBuffer> MTHeapAllocator::NewBuffer(NSUInteger length)
+{
+    id<MTLBuffer> buffer = nil;
+
+    if (blockSize_ > 0)
+    {
+        /* Sub-allocate buffer from heap */
+        MTLSizeAndAlign sizeAndAlign = [device_ heapBufferSizeAndAlignWithLength:length options:MTLResourceStorageModePrivate];
+        if (id<MTLHeap> heap = FindOrCreateHeap(sizeAndAlign.size, sizeAndAlign.align))
+            buffer = [heap newBufferWithLength:length options:MTLResourceStorageModePrivate];
+    }
+
+    /* Fall back to device allocation */
+    if (buffer == nil)
+        buffer = [device_ newBufferWithLength:length options:MTLResourceStorageModePrivate];
+
+    MTThrowIfCreateFailed(buffer, "MTLBuffer");
+
+    return buffer;
+}
+
+id<MTLTexture> MTHeapAllocator::NewTexture(MTLTextureDescriptor* texDesc)
+{
+    id<MTLTexture> texture = nil;
+
+    texDesc.storageMode = MTLStorageModePrivate;
+
+    if (blockSize_ > 0)
+    {
+        /* Sub-allocate texture from heap */
+        MTLSizeAndAlign sizeAndAlign = [device_ heapTextureSizeAndAlignWithDescriptor:texDesc];
+        if (id<MTLHeap> heap = FindOrCreateHeap(sizeAndAlign.size, sizeAndAlign.align))
+            texture = [heap newTextureWithDescriptor:texDesc];
+    }
+
+    /* Fall back to device allocation */
+    if (texture == nil)
+        texture = [device_ newTextureWithDescriptor:texDesc];
+
+    MTThrowIfCreateFailed(texture, "MTLTexture");
+
+    return texture;
+}
+
+std::uint64_t MTHeapAllocator::GetTotalHeapSize() const
+{
+    std::uint64_t size = 0;
+    for (id<MTLHeap> heap : heaps_)
+        size += [heap size];
+    return size;
+}
+
+std::uint64_t MTHeapAllocator::GetUsedHeapSize() const
+{
+    std::uint64_t size = 0;
+    for (id<MTLHeap> heap : heaps_)
+        size += [heap usedSize];
+    return size;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+id<MTLHeap> MTHeapAllocator::FindOrCreateHeap(NSUInteger size, NSUInteger alignment)
+{
+    /* Find heap with enough free space */
+    for (id<MTLHeap> heap : heaps_)
+    {
+        if ([heap maxAvailableSizeWithAlignment:alignment] >= size)
+            return heap;
+    }
+
+    /* Create new heap with at least the size of one block */
+    MTLHeapDescriptor* heapDesc = [[MTLHeapDescriptor alloc] init];
+    {
+        heapDesc.size           = std::max<NSUInteger>(static_cast<NSUInteger>(blockSize_), size);
+        heapDesc.storageMode    = MTLStorageModePrivate;
+        if (@available(macOS 10.15, iOS 13.0, *))
+            heapDesc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    }
+    id<MTLHeap> heap = [device_ newHeapWithDescriptor:heapDesc];
+    [heapDesc release];
+
+    if (heap != nil)
+        heaps_.push_back(heap);
+
+    return heap;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,40 @@
+/*
+ * MTModuleInterface.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../ModuleInterface.h"
+#include "MTRenderSystem.h"
+
+
+extern "C"
+{
+
+LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, Metal)()
+{
+    return LLGL_BUILD_ID;
+}
+
+LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, Metal)()
+{
+    return LLGL::RendererID::Metal;
+}
+
+LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, Metal)()
+{
+    return "Metal";
+}
+
+LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, Metal)(const void* renderSystemDesc)
+{
+    auto desc = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+    return new LLGL::MTRenderSystem(*desc);
+}
+
+}
+
+
+
+// ================================================================================
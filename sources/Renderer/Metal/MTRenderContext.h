@@ -0,0 +1,106 @@
+/*
+ * MTRenderContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_RENDER_CONTEXT_H
+#define LLGL_MT_RENDER_CONTEXT_H
+
+
+#import <Metal/Metal.h>
+#import <QuartzCore/CAMetalLayer.h>
+#import <dispatch/dispatch.h>
+
+#include <LLGL/RenderContext.h>
+
+
+namespace LLGL
+{
+
+
+class MTCommandBuffer;
+class MTCommandQueue;
+
+class MTRenderContext final : public RenderContext
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        MTRenderContext(
+            id<MTLDevice>                   device,
+            MTCommandQueue&                 commandQueue,
+            RenderContextDescriptor         desc,
+            const std::shared_ptr<Surface>& surface
+        );
+
+        ~MTRenderContext();
+
+        void Present() override;
+
+        Format QueryColorFormat() const override;
+        Format QueryDepthStencilFormat() const override;
+
+        /* --- Extended functions --- */
+
+        // Sets the command buffer that is committed with the drawable of this render context when it is presented.
+        void SetPresentCommandBuffer(MTCommandBuffer* commandBuffer);
+
+        // Returns the render pass descriptor for the current drawable, which is acquired on demand. This blocks the CPU while all frames in flight are still processed by the GPU.
+        MTLRenderPassDescriptor* GetNativeRenderPass();
+
+        // Returns the pixel format of the drawables.
+        inline MTLPixelFormat GetColorFormat() const
+        {
+            return [metalLayer_ pixelFormat];
+        }
+
+        // Returns the pixel format of the depth-stencil buffer, or MTLPixelFormatInvalid if there is none.
+        inline MTLPixelFormat GetDepthStencilFormat() const
+        {
+            return depthStencilFormat_;
+        }
+
+    private:
+
+        bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
+        bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+
+        void CreateMetalLayer(id<MTLDevice> device, const VsyncDescriptor& vsyncDesc);
+        void CreateDepthStencilBuffer(const VideoModeDescriptor& videoModeDesc);
+        void ReleaseDepthStencilBuffer();
+
+        // Acquires the next drawable of the layer after the oldest frame in flight has been completed.
+        void AcquireNextDrawable();
+
+    private:
+
+        id<MTLDevice>               device_             = nil;
+        MTCommandQueue&             commandQueue_;
+        CAMetalLayer*               metalLayer_         = nil;
+
+        id<CAMetalDrawable>         drawable_           = nil;  // Drawable of the current frame, or nil if it has not been acquired yet
+        MTLRenderPassDescriptor*    renderPassDesc_     = nil;
+
+        id<MTLTexture>              depthStencilBuffer_ = nil;
+        MTLPixelFormat              depthStencilFormat_ = MTLPixelFormatInvalid;
+
+        dispatch_semaphore_t        frameSemaphore_     = nullptr;  // Counts the frames that can be recorded ahead of the GPU
+        std::uint32_t               numFramesInFlight_  = 1;
+
+        MTCommandBuffer*            commandBuffer_      = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,257 @@
+/*
+ * MTRenderContext.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTRenderContext.h"
+#include "MTCommandBuffer.h"
+#include "MTCommandQueue.h"
+#include "MTCore.h"
+#include "MTTypes.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Platform/NativeHandle.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Maximal number of frames that can be recorded ahead of the GPU, which is also the maximal number of drawables of a CAMetalLayer
+static const std::uint32_t g_maxFramesInFlight = 3;
+
+MTRenderContext::MTRenderContext(
+    id<MTLDevice>                   device,
+    MTCommandQueue&                 commandQueue,
+    RenderContextDescriptor         desc,
+    const std::shared_ptr<Surface>& surface)
+:
+    RenderContext      { desc.videoMode, desc.vsync },
+    device_            { [device retain]            },
+    commandQueue_      { commandQueue               },
+    numFramesInFlight_ { std::max(1u, std::min(desc.framesInFlight, g_maxFramesInFlight)) }
+{
+    SetOrCreateSurface(surface, desc.videoMode, nullptr);
+    desc.videoMode = GetVideoMode();
+
+    renderPassDesc_ = [[MTLRenderPassDescriptor alloc] init];
+
+    CreateMetalLayer(device, desc.vsync);
+
+    if (desc.videoMode.depthBits > 0 || desc.videoMode.stencilBits > 0)
+        CreateDepthStencilBuffer(desc.videoMode);
+
+    frameSemaphore_ = dispatch_semaphore_create(static_cast<long>(numFramesInFlight_));
+}
+
+MTRenderContext::~MTRenderContext()
+{
+    /* Return the frame of an acquired drawable that has never been presented */
+    if (drawable_ != nil)
+    {
+        [drawable_ release];
+        dispatch_semaphore_signal(frameSemaphore_);
+    }
+
+    /* Wait until all frames in flight have been completed, since a semaphore must not be released below its initial value */
+    for (std::uint32_t i = 0; i < numFramesInFlight_; ++i)
+        dispatch_semaphore_wait(frameSemaphore_, DISPATCH_TIME_FOREVER);
+    for (std::uint32_t i = 0; i < numFramesInFlight_; ++i)
+        dispatch_semaphore_signal(frameSemaphore_);
+    dispatch_release(frameSemaphore_);
+
+    ReleaseDepthStencilBuffer();
+    [renderPassDesc_ release];
+    [metalLayer_ removeFromSuperlayer];
+    [metalLayer_ release];
+    [device_ release];
+}
+
+void MTRenderContext::Present()
+{
+    if (!commandBuffer_)
+        throw std::runtime_error("no command buffer set to present render context");
+
+    /* Present drawable with the command buffer of this frame, or with an empty one if nothing has been recorded */
+    id<MTLCommandBuffer> cmdBuffer = commandBuffer_->EndCommandBuffer();
+    if (cmdBuffer == nil)
+        cmdBuffer = commandQueue_.CreateCommandBuffer();
+
+    if (drawable_ != nil)
+    {
+        [cmdBuffer presentDrawable:drawable_];
+
+        /* Release frame in flight when the GPU has completed this command buffer */
+        dispatch_semaphore_t frameSemaphore = frameSemaphore_;
+        [cmdBuffer addCompletedHandler:^(id<MTLCommandBuffer>)
+            {
+                dispatch_semaphore_signal(frameSemaphore);
+            }
+        ];
+
+        [drawable_ release];
+        drawable_ = nil;
+        renderPassDesc_.colorAttachments[0].texture = nil;
+    }
+
+    commandQueue_.Commit(cmdBuffer);
+    [cmdBuffer release];
+}
+
+Format MTRenderContext::QueryColorFormat() const
+{
+    return MTTypes::Unmap(GetColorFormat());
+}
+
+Format MTRenderContext::QueryDepthStencilFormat() const
+{
+    return MTTypes::Unmap(depthStencilFormat_);
+}
+
+/* --- Extended functions --- */
+
+void MTRenderContext::SetPresentCommandBuffer(MTCommandBuffer* commandBuffer)
+{
+    commandBuffer_ = commandBuffer;
+}
+
+MTLRenderPassDescriptor* MTRenderContext::GetNativeRenderPass()
+{
+    if (drawable_ == nil)
+        AcquireNextDrawable();
+    return renderPassDesc_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool MTRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
+{
+    const auto& prevVideoMode = GetVideoMode();
+
+    /* Resize drawables of the layer; drawables that have already been acquired keep their size */
+    metalLayer_.drawableSize = CGSizeMake(videoModeDesc.resolution.width, videoModeDesc.resolution.height);
+
+    /* Recreate (or just release) depth-stencil buffer only if its size or format has changed */
+    if (prevVideoMode.resolution  != videoModeDesc.resolution ||
+        prevVideoMode.depthBits   != videoModeDesc.depthBits  ||
+        prevVideoMode.stencilBits != videoModeDesc.stencilBits)
+    {
+        commandQueue_.FlushUploadsAndWait();
+        ReleaseDepthStencilBuffer();
+        if (videoModeDesc.depthBits > 0 || videoModeDesc.stencilBits > 0)
+            CreateDepthStencilBuffer(videoModeDesc);
+    }
+
+    return true;
+}
+
+bool MTRenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
+{
+    #ifdef LLGL_OS_MACOS
+    if (@available(macOS 10.13, *))
+    {
+        metalLayer_.displaySyncEnabled = (vsyncDesc.enabled ? YES : NO);
+        return true;
+    }
+    #endif
+    return false;
+}
+
+void MTRenderContext::CreateMetalLayer(id<MTLDevice> device, const VsyncDescriptor& vsyncDesc)
+{
+    const auto& resolution = GetVideoMode().resolution;
+
+    metalLayer_ = [[CAMetalLayer alloc] init];
+    {
+        metalLayer_.device          = device;
+        metalLayer_.pixelFormat     = MTLPixelFormatBGRA8Unorm;
+        metalLayer_.framebufferOnly = YES;
+        metalLayer_.drawableSize    = CGSizeMake(resolution.width, resolution.height);
+    }
+
+    /* Limit number of drawables to triple buffering */
+    if (@available(macOS 10.13.2, iOS 11.2, *))
+        metalLayer_.maximumDrawableCount = g_maxFramesInFlight;
+
+    NativeHandle nativeHandle;
+    GetSurface().GetNativeHandle(&nativeHandle);
+
+    #ifdef LLGL_OS_MACOS
+
+    if (@available(macOS 10.13, *))
+        metalLayer_.displaySyncEnabled = (vsyncDesc.enabled ? YES : NO);
+
+    /* Make Metal layer the backing layer of the window content view */
+    NSView* contentView = [nativeHandle.window contentView];
+    [contentView setWantsLayer:YES];
+    [contentView setLayer:metalLayer_];
+
+    #else
+
+    /* Add Metal layer on top of the view's layer */
+    metalLayer_.frame           = nativeHandle.view.layer.bounds;
+    metalLayer_.contentsScale   = nativeHandle.view.contentScaleFactor;
+    [nativeHandle.view.layer addSublayer:metalLayer_];
+
+    #endif
+}
+
+void MTRenderContext::CreateDepthStencilBuffer(const VideoModeDescriptor& videoModeDesc)
+{
+    depthStencilFormat_ = (videoModeDesc.stencilBits > 0 ? MTLPixelFormatDepth32Float_Stencil8 : MTLPixelFormatDepth32Float);
+
+    MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
+    {
+        texDesc.textureType = MTLTextureType2D;
+        texDesc.pixelFormat = depthStencilFormat_;
+        texDesc.width       = videoModeDesc.resolution.width;
+        texDesc.height      = videoModeDesc.resolution.height;
+        texDesc.usage       = MTLTextureUsageRenderTarget;
+        texDesc.storageMode = MTLStorageModePrivate;
+    }
+    depthStencilBuffer_ = [device_ newTextureWithDescriptor:texDesc];
+    [texDesc release];
+
+    MTThrowIfCreateFailed(depthStencilBuffer_, "MTLTexture");
+
+    renderPassDesc_.depthAttachment.texture = depthStencilBuffer_;
+    renderPassDesc_.stencilAttachment.texture = (MTIsStencilFormat(depthStencilFormat_) ? depthStencilBuffer_ : nil);
+}
+
+void MTRenderContext::ReleaseDepthStencilBuffer()
+{
+    renderPassDesc_.depthAttachment.texture = nil;
+    renderPassDesc_.stencilAttachment.texture = nil;
+
+    [depthStencilBuffer_ release];
+    depthStencilBuffer_ = nil;
+    depthStencilFormat_ = MTLPixelFormatInvalid;
+}
+
+void MTRenderContext::AcquireNextDrawable()
+{
+    /* Wait until the GPU has completed the oldest frame in flight */
+    dispatch_semaphore_wait(frameSemaphore_, DISPATCH_TIME_FOREVER);
+
+    drawable_ = [[metalLayer_ nextDrawable] retain];
+    if (drawable_ == nil)
+    {
+        dispatch_semaphore_signal(frameSemaphore_);
+        throw std::runtime_error("failed to acquire next drawable from CAMetalLayer");
+    }
+
+    renderPassDesc_.colorAttachments[0].texture = [drawable_ texture];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,242 @@
+/*
+ * MTRenderSystem.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_RENDER_SYSTEM_H
+#define LLGL_MT_RENDER_SYSTEM_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/RenderSystem.h>
+#include "../ContainerTypes.h"
+#include "../TextureReadbackPool.h"
+#include "../StatisticsCounter.h"
+
+#include "MTCommandQueue.h"
+#include "MTCommandBuffer.h"
+#include "MTRenderContext.h"
+#include "MTHeapAllocator.h"
+
+#include "Buffer/MTBuffer.h"
+#include "Buffer/MTBufferArray.h"
+
+#include "Shader/MTShader.h"
+#include "Shader/MTShaderProgram.h"
+
+#include "Texture/MTTexture.h"
+#include "Texture/MTSampler.h"
+#include "Texture/MTRenderTarget.h"
+
+#include "RenderState/MTFence.h"
+#include "RenderState/MTRenderPass.h"
+#include "RenderState/MTPipelineLayout.h"
+#include "RenderState/MTGraphicsPipeline.h"
+#include "RenderState/MTComputePipeline.h"
+#include "RenderState/MTResourceHeap.h"
+
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class MTRenderSystem final : public RenderSystem
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
+        ~MTRenderSystem();
+
+        /* ----- Render Context ----- */
+
+        RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
+
+        void Release(RenderContext& renderContext) override;
+
+        /* ----- Command queues ----- */
+
+        CommandQueue* GetCommandQueue() override;
+
+        /* ----- Command buffers ----- */
+
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+        CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
+
+        void Release(CommandBuffer& commandBuffer) override;
+
+        /* ----- Buffers ------ */
+
+        Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+
+        void Release(Buffer& buffer) override;
+        void Release(BufferArray& bufferArray) override;
+
+        void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+
+        void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
+        void UnmapBuffer(Buffer& buffer) override;
+
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
+        /* ----- Textures ----- */
+
+        Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+
+        void Release(Texture& texture) override;
+
+        void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
+        void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
+
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
+        void GenerateMips(Texture& texture) override;
+        void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
+
+        /* ----- Sampler States ---- */
+
+        Sampler* CreateSampler(const SamplerDescriptor& desc) override;
+
+        void Release(Sampler& sampler) override;
+
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
+        /* ----- Render Targets ----- */
+
+        RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
+
+        void Release(RenderTarget& renderTarget) override;
+
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
+        /* ----- Shader ----- */
+
+        Shader* CreateShader(const ShaderDescriptor& desc) override;
+        ShaderProgram* CreateShaderProgram(const ShaderProgramDescriptor& desc) override;
+
+        void Release(Shader& shader) override;
+        void Release(ShaderProgram& shaderProgram) override;
+
+        /* ----- Pipeline Layouts ----- */
+
+        PipelineLayout* CreatePipelineLayout(const PipelineLayoutDescriptor& desc) override;
+
+        void Release(PipelineLayout& pipelineLayout) override;
+
+        /* ----- Pipeline States ----- */
+
+        GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
+
+        void Release(GraphicsPipeline& graphicsPipeline) override;
+        void Release(ComputePipeline& computePipeline) override;
+
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+
+        /* ----- Queries ----- */
+
+        Query* CreateQuery(const QueryDescriptor& desc) override;
+
+        void Release(Query& query) override;
+
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+    private:
+
+        void QueryDeviceProperties();
+
+        // Returns the maximum length (in bytes) of a single buffer.
+        std::uint64_t GetMaxBufferLength() const;
+
+        // Uploads the specified data into a GPU-private buffer with a temporary staging buffer on the upload encoder of the command queue.
+        void WriteBufferStaged(id<MTLBuffer> dstBuffer, NSUInteger dstOffset, const void* data, NSUInteger dataSize);
+
+        // Uploads the specified tightly packed image data into a texture region with a temporary staging buffer on the upload encoder of the command queue.
+        void WriteTextureStaged(
+            MTTexture&              textureMT,
+            std::uint32_t           mipLevel,
+            const Offset3D&         offset,
+            const Extent3D&         extent,
+            const void*             data,
+            std::size_t             dataSize
+        );
+
+        // Returns a new shared buffer for CPU readbacks. The returned object is retained by the caller.
+        id<MTLBuffer> CreateReadbackBuffer(std::uint64_t size);
+
+        /* ----- Common objects ----- */
+
+        id<MTLDevice>                           device_                 = nil;
+
+        std::unique_ptr<MTHeapAllocator>        heapAllocator_;
+
+        /* ----- Hardware object containers ----- */
+
+        HWObjectContainer<MTRenderContext>      renderContexts_;
+        HWObjectInstance<MTCommandQueue>        commandQueue_;
+        HWObjectContainer<MTCommandBuffer>      commandBuffers_;
+        HWObjectContainer<MTBuffer>             buffers_;
+        HWObjectContainer<MTBufferArray>        bufferArrays_;
+        HWObjectContainer<MTTexture>            textures_;
+        HWObjectContainer<MTSampler>            samplers_;
+        HWObjectContainer<MTRenderTarget>       renderTargets_;
+        HWObjectContainer<MTRenderPass>         renderPasses_;
+        HWObjectContainer<MTShader>             shaders_;
+        HWObjectContainer<MTShaderProgram>      shaderPrograms_;
+        HWObjectContainer<MTPipelineLayout>     pipelineLayouts_;
+        HWObjectContainer<MTGraphicsPipeline>   graphicsPipelines_;
+        HWObjectContainer<MTComputePipeline>    computePipelines_;
+        HWObjectContainer<MTResourceHeap>       resourceHeaps_;
+        HWObjectContainer<MTFence>              fences_;
+
+        StatisticsCounter                       statistics_;            // See LLGL_ENABLE_STATISTICS
+
+        /* ----- Texture and buffer readbacks ----- */
+
+        TextureReadbackPool<id<MTLBuffer>>      textureReadbacks_;      // Shared staging buffers of asynchronous texture readbacks
+        TextureReadbackPool<id<MTLBuffer>>      bufferReadbacks_;       // Shared staging buffers of asynchronous buffer readbacks
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
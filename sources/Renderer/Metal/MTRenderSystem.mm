@@ -0,0 +1,928 @@
+/*
+ * MTRenderSystem.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Platform/Platform.h>
+#include "MTRenderSystem.h"
+#include "MTCore.h"
+#include "MTTypes.h"
+#include "../CheckedCast.h"
+#include "../MipChain.h"
+#include "../../Core/Helper.h"
+#include "../../Core/Assertion.h"
+#include <LLGL/ImageFlags.h>
+#include <cstring>
+#include <algorithm>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Returns the vendor name from the device name, since Metal does not expose the vendor ID of a device.
+static std::string GetMTLDeviceVendorName(NSString* deviceName)
+{
+    static const char* g_vendorNames[] = { "AMD", "Intel", "NVIDIA" };
+
+    const std::string name = [deviceName UTF8String];
+    for (auto vendorName : g_vendorNames)
+    {
+        if (name.find(vendorName) != std::string::npos)
+            return vendorName;
+    }
+
+    return "Apple";
+}
+
+// Returns the tightly packed row and image sizes (in bytes) of the specified texture region (compressed formats are measured in blocks).
+static void GetTightTextureLayout(const Format format, const MTLSize& size, NSUInteger& bytesPerRow, NSUInteger& bytesPerImage)
+{
+    const auto blockExtent  = FormatBlockExtent(format);
+    const auto numBlocksX   = (size.width  + blockExtent.width  - 1) / blockExtent.width;
+    const auto numBlocksY   = (size.height + blockExtent.height - 1) / blockExtent.height;
+
+    bytesPerRow     = numBlocksX * FormatBlockSize(format);
+    bytesPerImage   = bytesPerRow * numBlocksY;
+}
+
+// Encodes a copy from the specified texture region into a tightly packed buffer, one command per array layer.
+static void EncodeCopyTextureToBuffer(
+    id<MTLBlitCommandEncoder>   blitEncoder,
+    const MTTexture&            textureMT,
+    std::uint32_t               mipLevel,
+    const Offset3D&             offset,
+    const Extent3D&             extent,
+    id<MTLBuffer>               dstBuffer,
+    NSUInteger                  bytesPerRow,
+    NSUInteger                  bytesPerImage)
+{
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice  = 0;
+    NSUInteger  numSlices   = 0;
+    textureMT.GetSubresourceRegion(offset, extent, origin, size, firstSlice, numSlices);
+
+    for (NSUInteger i = 0; i < numSlices; ++i)
+    {
+        [blitEncoder
+            copyFromTexture:            textureMT.GetNative()
+            sourceSlice:                firstSlice + i
+            sourceLevel:                static_cast<NSUInteger>(mipLevel)
+            sourceOrigin:               origin
+            sourceSize:                 size
+            toBuffer:                   dstBuffer
+            destinationOffset:          i * bytesPerImage
+            destinationBytesPerRow:     bytesPerRow
+            destinationBytesPerImage:   bytesPerImage
+        ];
+    }
+}
+
+
+/* ----- Common ----- */
+
+MTRenderSystem::MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
+{
+    /* Extract optional renderer configuartion */
+    const MetalRendererConfiguration* rendererConfigMT = nullptr;
+
+    if (renderSystemDesc.rendererConfig != nullptr && renderSystemDesc.rendererConfigSize > 0)
+    {
+        if (renderSystemDesc.rendererConfigSize == sizeof(MetalRendererConfiguration))
+            rendererConfigMT = reinterpret_cast<const MetalRendererConfiguration*>(renderSystemDesc.rendererConfig);
+        else
+            throw std::invalid_argument("invalid renderer configuration structure (expected size of 'MetalRendererConfiguration' structure)");
+    }
+
+    /* Create Metal device of the default GPU */
+    device_ = MTLCreateSystemDefaultDevice();
+    if (device_ == nil)
+        throw std::runtime_error("failed to find Metal device");
+
+    QueryDeviceProperties();
+
+    /* Create heap allocator for GPU-private resources and the command queue interface */
+    heapAllocator_ = MakeUnique<MTHeapAllocator>(
+        device_,
+        (rendererConfigMT != nullptr ? rendererConfigMT->heapBlockSize : MetalRendererConfiguration{}.heapBlockSize)
+    );
+
+    commandQueue_ = MakeUnique<MTCommandQueue>(device_);
+}
+
+MTRenderSystem::~MTRenderSystem()
+{
+    /* Wait until all pending uploads and command buffers have been completed */
+    commandQueue_->WaitIdle();
+
+    /* Release all texture and buffer readback buffers */
+    auto releaseReadbackBuffer = [](id<MTLBuffer>& staging)
+    {
+        [staging release];
+    };
+    textureReadbacks_.Clear(releaseReadbackBuffer);
+    bufferReadbacks_.Clear(releaseReadbackBuffer);
+
+    /* Release all hardware objects before the device is released */
+    renderContexts_.clear();
+    commandBuffers_.clear();
+    buffers_.clear();
+    bufferArrays_.clear();
+    textures_.clear();
+    samplers_.clear();
+    renderTargets_.clear();
+    shaders_.clear();
+    shaderPrograms_.clear();
+    graphicsPipelines_.clear();
+    computePipelines_.clear();
+    resourceHeaps_.clear();
+    fences_.clear();
+
+    commandQueue_.reset();
+    heapAllocator_.reset();
+
+    [device_ release];
+}
+
+/* ----- Render Context ----- */
+
+RenderContext* MTRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
+{
+    return TakeOwnership(renderContexts_, MakeUnique<MTRenderContext>(device_, *commandQueue_, desc, surface));
+}
+
+void MTRenderSystem::Release(RenderContext& renderContext)
+{
+    RemoveFromUniqueSet(renderContexts_, &renderContext);
+}
+
+/* ----- Command queues ----- */
+
+CommandQueue* MTRenderSystem::GetCommandQueue()
+{
+    return commandQueue_.get();
+}
+
+/* ----- Command buffers ----- */
+
+CommandBuffer* MTRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& /*desc*/)
+{
+    return CreateCommandBufferExt();
+}
+
+CommandBufferExt* MTRenderSystem::CreateCommandBufferExt()
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<MTCommandBuffer>(device_, *commandQueue_, *heapAllocator_));
+}
+
+CommandBuffer* MTRenderSystem::CreateSecondaryCommandBuffer()
+{
+    throw std::runtime_error("secondary command buffers are not supported by Metal renderer");
+}
+
+void MTRenderSystem::Release(CommandBuffer& commandBuffer)
+{
+    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+}
+
+/* ----- Buffers ------ */
+
+Buffer* MTRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
+{
+    AssertCreateBuffer(desc, GetMaxBufferLength());
+
+    auto bufferMT = MakeUnique<MTBuffer>(device_, *heapAllocator_, desc, initialData);
+
+    /* Upload initial data of GPU-private buffers via staging buffer */
+    if (initialData != nullptr && !bufferMT->IsHostVisible())
+        WriteBufferStaged(bufferMT->GetNative(), 0, initialData, static_cast<NSUInteger>(desc.size));
+
+    return TakeOwnership(buffers_, std::move(bufferMT));
+}
+
+BufferArray* MTRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+{
+    AssertCreateBufferArray(numBuffers, bufferArray);
+    auto refBufferType = (*bufferArray)->GetType();
+    return TakeOwnership(bufferArrays_, MakeUnique<MTBufferArray>(refBufferType, numBuffers, bufferArray));
+}
+
+void MTRenderSystem::Release(Buffer& buffer)
+{
+    RemoveFromUniqueSet(buffers_, &buffer);
+}
+
+void MTRenderSystem::Release(BufferArray& bufferArray)
+{
+    RemoveFromUniqueSet(bufferArrays_, &bufferArray);
+}
+
+void MTRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    LLGL_STATISTICS_ADD(bytesUploaded, dataSize);
+
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+
+    if (bufferMT.IsHostVisible())
+    {
+        /* Write shared memory directly */
+        bufferMT.Write(data, dataSize, offset);
+    }
+    else
+    {
+        /* Upload data into GPU-private memory via staging buffer */
+        if (offset + dataSize > bufferMT.GetSize())
+            throw std::out_of_range("Metal buffer write exceeds buffer size");
+        WriteBufferStaged(bufferMT.GetNative(), static_cast<NSUInteger>(offset), data, static_cast<NSUInteger>(dataSize));
+    }
+}
+
+void* MTRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+{
+    return MapBuffer(buffer, access, 0, 0);
+}
+
+void* MTRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t /*length*/)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+
+    /* Shared memory is mapped persistently, so the GPU must only complete all pending commands that might access this buffer */
+    commandQueue_->FlushUploadsAndWait();
+
+    return bufferMT.Map(access, offset);
+}
+
+void MTRenderSystem::UnmapBuffer(Buffer& /*buffer*/)
+{
+    // dummy (shared memory is always coherent with the GPU)
+}
+
+std::uint32_t MTRenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
+{
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+
+    if (offset + size > bufferMT.GetSize())
+        throw std::out_of_range("Metal buffer readback exceeds buffer size");
+
+    /* Allocate readback and (re-)create its staging buffer if it is too small */
+    auto readback = bufferReadbacks_.Alloc(size);
+    auto& rb = bufferReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        /* Release previous staging buffer (it is no longer in use since its readback has been retrieved) */
+        if (rb.capacity > 0)
+            [rb.staging release];
+
+        rb.staging  = CreateReadbackBuffer(size);
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.dataSize = size;
+
+    /* Encode copy into the staging buffer, then commit pending uploads and signal fence once the copy has been completed */
+    [commandQueue_->GetUploadEncoder()
+        copyFromBuffer: bufferMT.GetNative()
+        sourceOffset:   static_cast<NSUInteger>(offset)
+        toBuffer:       rb.staging
+        destinationOffset: 0
+        size:           static_cast<NSUInteger>(size)
+    ];
+    commandQueue_->Submit(fence);
+
+    return readback;
+}
+
+void MTRenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    LLGL_ASSERT_PTR(data);
+
+    auto& rb = bufferReadbacks_.Get(readback);
+    AssertBufferReadbackDataSize(dataSize, rb.dataSize);
+
+    /* Wait until the buffer data has been copied into the staging buffer */
+    auto& fenceMT = LLGL_CAST(MTFence&, *rb.fence);
+    fenceMT.Wait(UINT64_MAX);
+
+    ::memcpy(data, [rb.staging contents], static_cast<std::size_t>(rb.dataSize));
+
+    /* Return staging buffer to the pool */
+    bufferReadbacks_.Free(readback);
+}
+
+/* ----- Textures ----- */
+
+Texture* MTRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+{
+    const auto& cfg = GetConfiguration();
+
+    auto textureMT = MakeUnique<MTTexture>(*heapAllocator_, textureDesc);
+
+    /* Determine number of MIP levels that are contained in the initial image data */
+    const auto numInitialMipLevels = (imageDesc != nullptr ? NumMipChainLevels(textureDesc, *imageDesc) : 1u);
+
+    std::uint64_t initialDataSize = 0;
+    for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+        initialDataSize += TextureBufferSize(textureDesc.format, textureMT->QueryMipExtent(mipLevel));
+
+    /* Set up initial image data */
+    const void* initialData = nullptr;
+    ByteBuffer tempImageBuffer;
+
+    if (imageDesc)
+    {
+        /* Check if image data must be converted */
+        ImageFormat dstFormat   = ImageFormat::RGBA;
+        DataType    dstDataType = DataType::Int8;
+
+        if (!IsCompressedFormat(textureDesc.format) && FindSuitableImageFormat(textureDesc.format, dstFormat, dstDataType))
+            tempImageBuffer = ConvertImageBuffer(*imageDesc, dstFormat, dstDataType, cfg.threadCount);
+
+        if (tempImageBuffer)
+            initialData = tempImageBuffer.get();
+        else
+        {
+            AssertImageDataSize(imageDesc->dataSize, static_cast<std::size_t>(initialDataSize));
+            initialData = imageDesc->data;
+        }
+    }
+    else if (cfg.imageInitialization.enabled && !IsDepthStencilFormat(textureDesc.format) && !IsMultiSampleTexture(textureDesc.type))
+    {
+        /* Allocate default image data (depth-stencil and multi-sampled textures are not initialized, since they are written as attachments) */
+        ImageFormat imageFormat = ImageFormat::RGBA;
+        DataType imageDataType = DataType::Float64;
+
+        if (!IsCompressedFormat(textureDesc.format) && FindSuitableImageFormat(textureDesc.format, imageFormat, imageDataType))
+        {
+            const ColorRGBAd fillColor { cfg.imageInitialization.clearValue.color.Cast<double>() };
+            tempImageBuffer = GenerateImageBuffer(imageFormat, imageDataType, TextureSize(textureDesc), fillColor);
+        }
+        else
+            tempImageBuffer = GenerateEmptyByteBuffer(static_cast<std::size_t>(initialDataSize));
+
+        initialData = tempImageBuffer.get();
+    }
+
+    /* Upload all MIP levels that are contained in the initial data */
+    if (initialData != nullptr)
+    {
+        auto srcData = reinterpret_cast<const char*>(initialData);
+
+        for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+        {
+            const auto mipExtent    = textureMT->QueryMipExtent(mipLevel);
+            const auto mipDataSize  = static_cast<std::size_t>(TextureBufferSize(textureDesc.format, mipExtent));
+            WriteTextureStaged(*textureMT, mipLevel, Offset3D{ 0, 0, 0 }, mipExtent, srcData, mipDataSize);
+            srcData += mipDataSize;
+        }
+    }
+
+    return TakeOwnership(textures_, std::move(textureMT));
+}
+
+Texture* MTRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureMT = LLGL_CAST(MTTexture&, sharedTexture);
+    return TakeOwnership(textures_, MakeUnique<MTTexture>(sharedTextureMT, textureViewDesc));
+}
+
+void MTRenderSystem::Release(Texture& texture)
+{
+    RemoveFromUniqueSet(textures_, &texture);
+}
+
+void MTRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc)
+{
+    LLGL_STATISTICS_ADD(bytesUploaded, imageDesc.dataSize);
+
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+
+    /* Determine size of image data for the sub-texture region */
+    const auto format       = textureMT.GetFormat();
+    const auto numTexels    = (subTextureDesc.extent.width * subTextureDesc.extent.height * subTextureDesc.extent.depth);
+    const auto imageSize    = static_cast<std::size_t>(TextureBufferSize(format, subTextureDesc.extent));
+
+    /* Check if image data must be converted */
+    const void* imageData = imageDesc.data;
+    ByteBuffer tempImageBuffer;
+
+    ImageFormat dstFormat   = ImageFormat::RGBA;
+    DataType    dstDataType = DataType::Int8;
+
+    if (!IsCompressedFormat(format) && FindSuitableImageFormat(format, dstFormat, dstDataType))
+        tempImageBuffer = ConvertImageBuffer(imageDesc, dstFormat, dstDataType, GetConfiguration().threadCount);
+
+    if (tempImageBuffer)
+    {
+        const auto srcImageDataSize = numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
+        imageData = tempImageBuffer.get();
+    }
+    else
+        AssertImageDataSize(imageDesc.dataSize, imageSize);
+
+    WriteTextureStaged(textureMT, subTextureDesc.mipLevel, subTextureDesc.offset, subTextureDesc.extent, imageData, imageSize);
+}
+
+void MTRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& textureMT = LLGL_CAST(const MTTexture&, texture);
+
+    const auto format = textureMT.GetFormat();
+
+    if (IsMultiSampleTexture(textureMT.GetType()))
+        throw std::invalid_argument("cannot read multi-sampled texture");
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot read texture with compressed or depth-stencil format");
+    if (mipLevel >= textureMT.GetNumMipLevels())
+        throw std::out_of_range("MIP level out of range for texture readback");
+
+    /* Determine tightly packed layout of the entire MIP level within the readback buffer */
+    const auto extent = textureMT.QueryMipExtent(mipLevel);
+
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice  = 0;
+    NSUInteger  numSlices   = 0;
+    textureMT.GetSubresourceRegion(Offset3D{ 0, 0, 0 }, extent, origin, size, firstSlice, numSlices);
+
+    NSUInteger bytesPerRow = 0, bytesPerImage = 0;
+    GetTightTextureLayout(format, size, bytesPerRow, bytesPerImage);
+
+    /* Copy texture into readback buffer and wait until the GPU has completed the copy */
+    id<MTLBuffer> readbackBuffer = CreateReadbackBuffer(static_cast<std::uint64_t>(bytesPerImage * std::max(numSlices, size.depth)));
+    {
+        EncodeCopyTextureToBuffer(commandQueue_->GetUploadEncoder(), textureMT, mipLevel, Offset3D{ 0, 0, 0 }, extent, readbackBuffer, bytesPerRow, bytesPerImage);
+        commandQueue_->FlushUploadsAndWait();
+
+        CopyTextureReadbackData(
+            imageDesc,
+            format,
+            extent,
+            [readbackBuffer contents],
+            static_cast<std::uint32_t>(bytesPerRow),
+            static_cast<std::uint64_t>(bytesPerImage),
+            GetConfiguration().threadCount
+        );
+    }
+    [readbackBuffer release];
+}
+
+std::uint32_t MTRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+
+    const auto format = textureMT.GetFormat();
+
+    if (IsMultiSampleTexture(textureMT.GetType()))
+        throw std::invalid_argument("cannot read multi-sampled texture asynchronously");
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot read texture with compressed or depth-stencil format asynchronously");
+
+    /* Determine tightly packed layout of the texel data within the staging buffer */
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice  = 0;
+    NSUInteger  numSlices   = 0;
+    textureMT.GetSubresourceRegion(region.offset, region.extent, origin, size, firstSlice, numSlices);
+
+    NSUInteger bytesPerRow = 0, bytesPerImage = 0;
+    GetTightTextureLayout(format, size, bytesPerRow, bytesPerImage);
+
+    const auto dataSize = static_cast<std::uint64_t>(bytesPerImage * std::max(numSlices, size.depth));
+
+    /* Allocate readback and (re-)create its staging buffer if it is too small */
+    auto readback = textureReadbacks_.Alloc(dataSize);
+    auto& rb = textureReadbacks_.Get(readback);
+
+    if (rb.capacity < dataSize)
+    {
+        /* Release previous staging buffer (it is no longer in use since its readback has been retrieved) */
+        if (rb.capacity > 0)
+            [rb.staging release];
+
+        rb.staging  = CreateReadbackBuffer(dataSize);
+        rb.capacity = dataSize;
+    }
+
+    rb.fence        = (&fence);
+    rb.format       = format;
+    rb.extent       = region.extent;
+    rb.rowPitch     = static_cast<std::uint32_t>(bytesPerRow);
+    rb.slicePitch   = static_cast<std::uint64_t>(bytesPerImage);
+
+    /* Encode copy into the staging buffer, then commit pending uploads and signal fence once the copy has been completed */
+    EncodeCopyTextureToBuffer(commandQueue_->GetUploadEncoder(), textureMT, region.mipLevel, region.offset, region.extent, rb.staging, bytesPerRow, bytesPerImage);
+    commandQueue_->Submit(fence);
+
+    return readback;
+}
+
+void MTRenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& rb = textureReadbacks_.Get(readback);
+
+    const auto numTexels = rb.extent.width * rb.extent.height * rb.extent.depth;
+    AssertImageDataSize(imageDesc.dataSize, ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels), "texture readback");
+
+    /* Wait until the texel data has been copied into the staging buffer */
+    auto& fenceMT = LLGL_CAST(MTFence&, *rb.fence);
+    fenceMT.Wait(UINT64_MAX);
+
+    CopyTextureReadbackData(imageDesc, rb.format, rb.extent, [rb.staging contents], rb.rowPitch, rb.slicePitch, GetConfiguration().threadCount);
+
+    /* Return staging buffer to the pool */
+    textureReadbacks_.Free(readback);
+}
+
+void MTRenderSystem::GenerateMips(Texture& texture)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+    if (textureMT.GetNumMipLevels() > 1)
+        [commandQueue_->GetUploadEncoder() generateMipmapsForTexture:textureMT.GetNative()];
+}
+
+void MTRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+
+    const auto maxNumMipLevels      = textureMT.GetNumMipLevels();
+    const auto maxNumArrayLayers    = textureMT.GetNumArrayLayers();
+
+    if (baseMipLevel < maxNumMipLevels && baseArrayLayer < maxNumArrayLayers && numMipLevels > 1 && numArrayLayers > 0)
+    {
+        /* Generate MIP levels on a temporary texture view of the specified subresource, since Metal can only generate the MIP chain of an entire texture */
+        TextureViewDescriptor viewDesc;
+        {
+            viewDesc.type                       = textureMT.GetType();
+            viewDesc.format                     = textureMT.GetFormat();
+            viewDesc.subresource.baseMipLevel   = baseMipLevel;
+            viewDesc.subresource.numMipLevels   = std::min(numMipLevels, maxNumMipLevels - baseMipLevel);
+            viewDesc.subresource.baseArrayLayer = baseArrayLayer;
+            viewDesc.subresource.numArrayLayers = std::min(numArrayLayers, maxNumArrayLayers - baseArrayLayer);
+        }
+        MTTexture textureView { textureMT, viewDesc };
+        [commandQueue_->GetUploadEncoder() generateMipmapsForTexture:textureView.GetNative()];
+    }
+}
+
+/* ----- Sampler States ---- */
+
+Sampler* MTRenderSystem::CreateSampler(const SamplerDescriptor& desc)
+{
+    return TakeOwnership(samplers_, MakeUnique<MTSampler>(device_, desc));
+}
+
+void MTRenderSystem::Release(Sampler& sampler)
+{
+    RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* MTRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    return TakeOwnership(resourceHeaps_, MakeUnique<MTResourceHeap>(desc));
+}
+
+void MTRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
+void MTRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
+    resourceHeapMT.WriteResourceViews(firstDescriptor, numResourceViews, resourceViews);
+}
+
+/* ----- Render Targets ----- */
+
+RenderTarget* MTRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
+{
+    return TakeOwnership(renderTargets_, MakeUnique<MTRenderTarget>(device_, desc));
+}
+
+void MTRenderSystem::Release(RenderTarget& renderTarget)
+{
+    RemoveFromUniqueSet(renderTargets_, &renderTarget);
+}
+
+/* ----- Render Passes ----- */
+
+RenderPass* MTRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    return TakeOwnership(renderPasses_, MakeUnique<MTRenderPass>(desc));
+}
+
+void MTRenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
+/* ----- Shader ----- */
+
+Shader* MTRenderSystem::CreateShader(const ShaderDescriptor& desc)
+{
+    AssertCreateShader(desc);
+    return TakeOwnership(shaders_, MakeUnique<MTShader>(device_, desc));
+}
+
+ShaderProgram* MTRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
+{
+    AssertCreateShaderProgram(desc);
+    return TakeOwnership(shaderPrograms_, MakeUnique<MTShaderProgram>(desc));
+}
+
+void MTRenderSystem::Release(Shader& shader)
+{
+    RemoveFromUniqueSet(shaders_, &shader);
+}
+
+void MTRenderSystem::Release(ShaderProgram& shaderProgram)
+{
+    RemoveFromUniqueSet(shaderPrograms_, &shaderProgram);
+}
+
+/* ----- Pipeline Layouts ----- */
+
+PipelineLayout* MTRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
+{
+    return TakeOwnership(pipelineLayouts_, MakeUnique<MTPipelineLayout>(desc));
+}
+
+void MTRenderSystem::Release(PipelineLayout& pipelineLayout)
+{
+    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+}
+
+/* ----- Pipeline States ----- */
+
+GraphicsPipeline* MTRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
+{
+    /* Use attachment formats of the main render context if the pipeline does not refer to a render target */
+    MTLPixelFormat colorFormat          = MTLPixelFormatBGRA8Unorm;
+    MTLPixelFormat depthStencilFormat   = MTLPixelFormatInvalid;
+
+    if (!renderContexts_.empty())
+    {
+        auto renderContext = renderContexts_.begin()->get();
+        colorFormat         = renderContext->GetColorFormat();
+        depthStencilFormat  = renderContext->GetDepthStencilFormat();
+    }
+
+    return TakeOwnership(graphicsPipelines_, MakeUnique<MTGraphicsPipeline>(device_, desc, colorFormat, depthStencilFormat));
+}
+
+ComputePipeline* MTRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
+{
+    return TakeOwnership(computePipelines_, MakeUnique<MTComputePipeline>(device_, desc));
+}
+
+void MTRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
+{
+    RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+}
+
+void MTRenderSystem::Release(ComputePipeline& computePipeline)
+{
+    RemoveFromUniqueSet(computePipelines_, &computePipeline);
+}
+
+/* ----- Statistics ----- */
+
+bool MTRenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    statistics = statistics_.Query(reset);
+    #ifdef LLGL_ENABLE_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+/* ----- Queries ----- */
+
+Query* MTRenderSystem::CreateQuery(const QueryDescriptor& /*desc*/)
+{
+    throw std::runtime_error("queries are not supported by Metal renderer");
+}
+
+void MTRenderSystem::Release(Query& /*query*/)
+{
+    // dummy (not supported by Metal)
+}
+
+QueryHeap* MTRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& /*desc*/)
+{
+    throw std::runtime_error("query heaps are not supported by Metal renderer");
+}
+
+void MTRenderSystem::Release(QueryHeap& /*queryHeap*/)
+{
+    // dummy (not supported by Metal)
+}
+
+/* ----- Fences ----- */
+
+Fence* MTRenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<MTFence>(device_));
+}
+
+void MTRenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTRenderSystem::QueryDeviceProperties()
+{
+    /* Map device properties to output renderer info */
+    RendererInfo info;
+
+    info.rendererName           = "Metal";
+    info.deviceName             = [[device_ name] UTF8String];
+    info.vendorName             = GetMTLDeviceVendorName([device_ name]);
+    info.shadingLanguageName    = "Metal Shading Language";
+
+    SetRendererInfo(info);
+
+    /* Map device limits to output rendering capabilites */
+    const auto maxThreadsPerThreadgroup = [device_ maxThreadsPerThreadgroup];
+
+    RenderingCapabilities caps;
+    {
+        /* Query common attributes */
+        caps.screenOrigin                               = ScreenOrigin::UpperLeft;
+        caps.clippingRange                              = ClippingRange::ZeroToOne;
+        caps.shadingLanguages                           = { ShadingLanguage::Metal, ShadingLanguage::Metal_1_0, ShadingLanguage::Metal_1_1, ShadingLanguage::Metal_1_2 };
+
+        if (@available(macOS 10.13, iOS 11.0, *))
+            caps.shadingLanguages.push_back(ShadingLanguage::Metal_2_0);
+        if (@available(macOS 10.14, iOS 12.0, *))
+            caps.shadingLanguages.push_back(ShadingLanguage::Metal_2_1);
+        if (@available(macOS 10.15, iOS 13.0, *))
+            caps.shadingLanguages.push_back(ShadingLanguage::Metal_2_2);
+
+        /* Query features */
+        caps.features.hasSecondaryCommandBuffers        = false;
+        caps.features.hasCommandBufferExt               = true;
+        caps.features.hasRenderTargets                  = true;
+        caps.features.has3DTextures                     = true;
+        caps.features.hasCubeTextures                   = true;
+        caps.features.hasArrayTextures                  = true;
+        caps.features.hasMultiSampleTextures            = true;
+        caps.features.hasSamplers                       = true;
+        caps.features.hasConstantBuffers                = true;
+        caps.features.hasStorageBuffers                 = true;
+        caps.features.hasUniforms                       = false;
+        caps.features.hasGeometryShaders                = false;
+        caps.features.hasTessellationShaders            = false;
+        caps.features.hasComputeShaders                 = true;
+        caps.features.hasInstancing                     = true;
+        caps.features.hasOffsetInstancing               = true;
+        caps.features.hasIndirectDrawing                = true;
+        caps.features.hasIndirectCommandLayouts         = false;
+        caps.features.hasViewportArrays                 = false;
+        caps.features.hasConservativeRasterization      = false;
+        caps.features.hasStreamOutputs                  = false;
+        caps.features.hasLogicOp                        = false;
+        caps.features.hasBindlessResources              = false;
+        caps.features.hasDynamicOffsets                 = true;
+        caps.features.hasStaticSamplers                 = false;
+        caps.features.hasTextureViews                   = true;
+
+        #ifdef LLGL_OS_MACOS
+        caps.features.hasCubeArrayTextures              = true;
+        caps.features.hasTextureCompressionBC           = true;
+        caps.features.hasTextureCompressionETC2         = false;
+        caps.features.hasTextureCompressionASTC         = false;
+        #else
+        caps.features.hasCubeArrayTextures              = false;
+        caps.features.hasTextureCompressionBC           = false;
+        caps.features.hasTextureCompressionETC2         = true;
+        caps.features.hasTextureCompressionASTC         = true;
+        #endif
+
+        /* Query limits */
+        caps.limits.lineWidthRange[0]                   = 1.0f;
+        caps.limits.lineWidthRange[1]                   = 1.0f;
+        caps.limits.maxNumTextureArrayLayers            = 2048;
+        caps.limits.maxNumRenderTargetAttachments       = 8;
+        caps.limits.max1DTextureSize                    = 16384;
+        caps.limits.max2DTextureSize                    = 16384;
+        caps.limits.max3DTextureSize                    = 2048;
+        caps.limits.maxCubeTextureSize                  = 16384;
+        caps.limits.maxAnisotropy                       = 16;
+        caps.limits.maxNumComputeShaderWorkGroups[0]    = 65535;
+        caps.limits.maxNumComputeShaderWorkGroups[1]    = 65535;
+        caps.limits.maxNumComputeShaderWorkGroups[2]    = 65535;
+        caps.limits.maxComputeShaderWorkGroupSize[0]    = static_cast<std::uint32_t>(maxThreadsPerThreadgroup.width);
+        caps.limits.maxComputeShaderWorkGroupSize[1]    = static_cast<std::uint32_t>(maxThreadsPerThreadgroup.height);
+        caps.limits.maxComputeShaderWorkGroupSize[2]    = static_cast<std::uint32_t>(maxThreadsPerThreadgroup.depth);
+        caps.limits.maxNumViewports                     = 1;
+        caps.limits.maxViewportSize[0]                  = 16384;
+        caps.limits.maxViewportSize[1]                  = 16384;
+        caps.limits.maxBufferSize                       = GetMaxBufferLength();
+        caps.limits.maxConstantBufferSize               = 65536;
+        caps.limits.maxConstantsSize                    = 4096;
+        caps.limits.constantBufferOffsetAlignment       = 256;
+    }
+    SetRenderingCaps(caps);
+}
+
+std::uint64_t MTRenderSystem::GetMaxBufferLength() const
+{
+    if (@available(macOS 10.14, iOS 12.0, *))
+        return static_cast<std::uint64_t>([device_ maxBufferLength]);
+    else
+        return 256*1024*1024;
+}
+
+void MTRenderSystem::WriteBufferStaged(id<MTLBuffer> dstBuffer, NSUInteger dstOffset, const void* data, NSUInteger dataSize)
+{
+    /* Staging buffer is retained by the upload command buffer until the copy has been completed */
+    id<MTLBuffer> stagingBuffer = [device_ newBufferWithBytes:data length:dataSize options:MTLResourceStorageModeShared];
+    MTThrowIfCreateFailed(stagingBuffer, "MTLBuffer");
+    {
+        [commandQueue_->GetUploadEncoder()
+            copyFromBuffer:     stagingBuffer
+            sourceOffset:       0
+            toBuffer:           dstBuffer
+            destinationOffset:  dstOffset
+            size:               dataSize
+        ];
+    }
+    [stagingBuffer release];
+}
+
+void MTRenderSystem::WriteTextureStaged(
+    MTTexture&          textureMT,
+    std::uint32_t       mipLevel,
+    const Offset3D&     offset,
+    const Extent3D&     extent,
+    const void*         data,
+    std::size_t         dataSize)
+{
+    /* Determine destination region within the texture and tightly packed layout of the image data */
+    MTLOrigin   origin;
+    MTLSize     size;
+    NSUInteger  firstSlice  = 0;
+    NSUInteger  numSlices   = 0;
+    textureMT.GetSubresourceRegion(offset, extent, origin, size, firstSlice, numSlices);
+
+    NSUInteger bytesPerRow = 0, bytesPerImage = 0;
+    GetTightTextureLayout(textureMT.GetFormat(), size, bytesPerRow, bytesPerImage);
+
+    /* Staging buffer is retained by the upload command buffer until the copy has been completed */
+    id<MTLBuffer> stagingBuffer = [device_ newBufferWithBytes:data length:static_cast<NSUInteger>(dataSize) options:MTLResourceStorageModeShared];
+    MTThrowIfCreateFailed(stagingBuffer, "MTLBuffer");
+    {
+        auto uploadEncoder = commandQueue_->GetUploadEncoder();
+        for (NSUInteger i = 0; i < numSlices; ++i)
+        {
+            [uploadEncoder
+                copyFromBuffer:         stagingBuffer
+                sourceOffset:           i * bytesPerImage
+                sourceBytesPerRow:      bytesPerRow
+                sourceBytesPerImage:    bytesPerImage
+                sourceSize:             size
+                toTexture:              textureMT.GetNative()
+                destinationSlice:       firstSlice + i
+                destinationLevel:       static_cast<NSUInteger>(mipLevel)
+                destinationOrigin:      origin
+            ];
+        }
+    }
+    [stagingBuffer release];
+}
+
+id<MTLBuffer> MTRenderSystem::CreateReadbackBuffer(std::uint64_t size)
+{
+    id<MTLBuffer> buffer = [device_ newBufferWithLength:static_cast<NSUInteger>(size) options:MTLResourceStorageModeShared];
+    MTThrowIfCreateFailed(buffer, "MTLBuffer");
+    return buffer;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
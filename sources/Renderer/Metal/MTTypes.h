@@ -0,0 +1,78 @@
+/*
+ * MTTypes.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_TYPES_H
+#define LLGL_MT_TYPES_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/Format.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <LLGL/ColorRGBA.h>
+#include <string>
+
+
+namespace LLGL
+{
+
+namespace MTTypes
+{
+
+
+/* ----- Map functions ----- */
+
+[[noreturn]]
+void MapFailed(const std::string& typeName, const std::string& mtlTypeName);
+
+MTLPixelFormat              Map( const Format               format            );
+MTLVertexFormat             MapVertexFormat( const Format   format            );
+MTLTextureType              Map( const TextureType          textureType       );
+MTLPrimitiveType            Map( const PrimitiveTopology    primitiveTopology );
+MTLCullMode                 Map( const CullMode             cullMode          );
+MTLTriangleFillMode         Map( const PolygonMode          polygonMode       );
+MTLCompareFunction          Map( const CompareOp            compareOp         );
+MTLStencilOperation         Map( const StencilOp            stencilOp         );
+MTLBlendFactor              Map( const BlendOp              blendOp           );
+MTLBlendOperation           Map( const BlendArithmetic      blendArithmetic   );
+MTLSamplerAddressMode       Map( const SamplerAddressMode   addressMode       );
+MTLSamplerMinMagFilter      Map( const SamplerFilter        filter            );
+MTLSamplerMipFilter         MapMipFilter( const SamplerFilter filter          );
+MTLLoadAction               Map( const AttachmentLoadOp     loadOp            );
+MTLStoreAction              Map( const AttachmentStoreOp    storeOp           );
+MTLIndexType                Map( const DataType             indexType         );
+MTLColorWriteMask           Map( const ColorRGBAb&          colorMask         );
+
+#if defined(__MAC_10_15) || defined(__IPHONE_13_0)
+MTLTextureSwizzle           Map( const TextureSwizzle       textureSwizzle    );
+#endif
+
+MTLPrimitiveTopologyClass   MapTopologyClass( const PrimitiveTopology primitiveTopology );
+
+Format                      Unmap( const MTLPixelFormat pixelFormat );
+
+
+/* ----- Convert functions ----- */
+
+void Convert( MTLViewport&      dst, const Viewport&   src );
+void Convert( MTLScissorRect&   dst, const Scissor&    src );
+void Convert( MTLClearColor&    dst, const ColorRGBAf& src );
+
+
+} // /namespace MTTypes
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,578 @@
+/*
+ * MTTypes.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTTypes.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+namespace MTTypes
+{
+
+
+/* ----- Map functions ----- */
+
+[[noreturn]]
+void MapFailed(const std::string& typeName, const std::string& mtlTypeName)
+{
+    throw std::invalid_argument("failed to map <LLGL::" + typeName + "> to <" + mtlTypeName + "> Metal parameter");
+}
+
+MTLPixelFormat Map(const Format format)
+{
+    switch (format)
+    {
+        case Format::Undefined:         return MTLPixelFormatInvalid;
+
+        /* --- Color formats --- */
+        case Format::R8UNorm:           return MTLPixelFormatR8Unorm;
+        case Format::R8SNorm:           return MTLPixelFormatR8Snorm;
+        case Format::R8UInt:            return MTLPixelFormatR8Uint;
+        case Format::R8SInt:            return MTLPixelFormatR8Sint;
+
+        case Format::R16UNorm:          return MTLPixelFormatR16Unorm;
+        case Format::R16SNorm:          return MTLPixelFormatR16Snorm;
+        case Format::R16UInt:           return MTLPixelFormatR16Uint;
+        case Format::R16SInt:           return MTLPixelFormatR16Sint;
+        case Format::R16Float:          return MTLPixelFormatR16Float;
+
+        case Format::R32UInt:           return MTLPixelFormatR32Uint;
+        case Format::R32SInt:           return MTLPixelFormatR32Sint;
+        case Format::R32Float:          return MTLPixelFormatR32Float;
+
+        case Format::RG8UNorm:          return MTLPixelFormatRG8Unorm;
+        case Format::RG8SNorm:          return MTLPixelFormatRG8Snorm;
+        case Format::RG8UInt:           return MTLPixelFormatRG8Uint;
+        case Format::RG8SInt:           return MTLPixelFormatRG8Sint;
+
+        case Format::RG16UNorm:         return MTLPixelFormatRG16Unorm;
+        case Format::RG16SNorm:         return MTLPixelFormatRG16Snorm;
+        case Format::RG16UInt:          return MTLPixelFormatRG16Uint;
+        case Format::RG16SInt:          return MTLPixelFormatRG16Sint;
+        case Format::RG16Float:         return MTLPixelFormatRG16Float;
+
+        case Format::RG32UInt:          return MTLPixelFormatRG32Uint;
+        case Format::RG32SInt:          return MTLPixelFormatRG32Sint;
+        case Format::RG32Float:         return MTLPixelFormatRG32Float;
+
+        case Format::RGBA8UNorm:        return MTLPixelFormatRGBA8Unorm;
+        case Format::RGBA8SNorm:        return MTLPixelFormatRGBA8Snorm;
+        case Format::RGBA8UInt:         return MTLPixelFormatRGBA8Uint;
+        case Format::RGBA8SInt:         return MTLPixelFormatRGBA8Sint;
+
+        case Format::RGBA16UNorm:       return MTLPixelFormatRGBA16Unorm;
+        case Format::RGBA16SNorm:       return MTLPixelFormatRGBA16Snorm;
+        case Format::RGBA16UInt:        return MTLPixelFormatRGBA16Uint;
+        case Format::RGBA16SInt:        return MTLPixelFormatRGBA16Sint;
+        case Format::RGBA16Float:       return MTLPixelFormatRGBA16Float;
+
+        case Format::RGBA32UInt:        return MTLPixelFormatRGBA32Uint;
+        case Format::RGBA32SInt:        return MTLPixelFormatRGBA32Sint;
+        case Format::RGBA32Float:       return MTLPixelFormatRGBA32Float;
+
+        /* --- Reversed color formats --- */
+        case Format::BGRA8UNorm:        return MTLPixelFormatBGRA8Unorm;
+        case Format::BGRA8sRGB:         return MTLPixelFormatBGRA8Unorm_sRGB;
+
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      return MTLPixelFormatRGB10A2Unorm;
+        case Format::RGB10A2UInt:       return MTLPixelFormatRGB10A2Uint;
+        case Format::RG11B10Float:      return MTLPixelFormatRG11B10Float;
+
+        /* --- Depth-stencil formats --- */
+        case Format::D16UNorm:          return MTLPixelFormatDepth16Unorm;
+        case Format::D32Float:          return MTLPixelFormatDepth32Float;
+        #ifdef LLGL_OS_MACOS
+        case Format::D24UNormS8UInt:    return MTLPixelFormatDepth24Unorm_Stencil8;
+        #endif
+        case Format::D32FloatS8X24UInt: return MTLPixelFormatDepth32Float_Stencil8;
+
+        #ifdef LLGL_OS_MACOS
+
+        /* --- Compressed color formats --- */
+        case Format::BC1RGBA:           return MTLPixelFormatBC1_RGBA;
+        case Format::BC2RGBA:           return MTLPixelFormatBC2_RGBA;
+        case Format::BC3RGBA:           return MTLPixelFormatBC3_RGBA;
+        case Format::BC1RGBAsRGB:       return MTLPixelFormatBC1_RGBA_sRGB;
+        case Format::BC2RGBAsRGB:       return MTLPixelFormatBC2_RGBA_sRGB;
+        case Format::BC3RGBAsRGB:       return MTLPixelFormatBC3_RGBA_sRGB;
+        case Format::BC4RUNorm:         return MTLPixelFormatBC4_RUnorm;
+        case Format::BC4RSNorm:         return MTLPixelFormatBC4_RSnorm;
+        case Format::BC5RGUNorm:        return MTLPixelFormatBC5_RGUnorm;
+        case Format::BC5RGSNorm:        return MTLPixelFormatBC5_RGSnorm;
+        case Format::BC6HRGBUFloat:     return MTLPixelFormatBC6H_RGBUfloat;
+        case Format::BC6HRGBSFloat:     return MTLPixelFormatBC6H_RGBFloat;
+        case Format::BC7RGBAUNorm:      return MTLPixelFormatBC7_RGBAUnorm;
+        case Format::BC7RGBAsRGB:       return MTLPixelFormatBC7_RGBAUnorm_sRGB;
+
+        #endif // /LLGL_OS_MACOS
+
+        #if defined(LLGL_OS_IOS) || defined(__MAC_11_0)
+
+        /* --- ETC2/EAC compressed color formats --- */
+        case Format::ETC2RGB8UNorm:     return MTLPixelFormatETC2_RGB8;
+        case Format::ETC2RGB8sRGB:      return MTLPixelFormatETC2_RGB8_sRGB;
+        case Format::ETC2RGB8A1UNorm:   return MTLPixelFormatETC2_RGB8A1;
+        case Format::ETC2RGB8A1sRGB:    return MTLPixelFormatETC2_RGB8A1_sRGB;
+        case Format::ETC2RGBA8UNorm:    return MTLPixelFormatEAC_RGBA8;
+        case Format::ETC2RGBA8sRGB:     return MTLPixelFormatEAC_RGBA8_sRGB;
+        case Format::EACR11UNorm:       return MTLPixelFormatEAC_R11Unorm;
+        case Format::EACR11SNorm:       return MTLPixelFormatEAC_R11Snorm;
+        case Format::EACRG11UNorm:      return MTLPixelFormatEAC_RG11Unorm;
+        case Format::EACRG11SNorm:      return MTLPixelFormatEAC_RG11Snorm;
+
+        /* --- ASTC compressed color formats --- */
+        case Format::ASTC4x4UNorm:      return MTLPixelFormatASTC_4x4_LDR;
+        case Format::ASTC4x4sRGB:       return MTLPixelFormatASTC_4x4_sRGB;
+        case Format::ASTC5x4UNorm:      return MTLPixelFormatASTC_5x4_LDR;
+        case Format::ASTC5x4sRGB:       return MTLPixelFormatASTC_5x4_sRGB;
+        case Format::ASTC5x5UNorm:      return MTLPixelFormatASTC_5x5_LDR;
+        case Format::ASTC5x5sRGB:       return MTLPixelFormatASTC_5x5_sRGB;
+        case Format::ASTC6x5UNorm:      return MTLPixelFormatASTC_6x5_LDR;
+        case Format::ASTC6x5sRGB:       return MTLPixelFormatASTC_6x5_sRGB;
+        case Format::ASTC6x6UNorm:      return MTLPixelFormatASTC_6x6_LDR;
+        case Format::ASTC6x6sRGB:       return MTLPixelFormatASTC_6x6_sRGB;
+        case Format::ASTC8x5UNorm:      return MTLPixelFormatASTC_8x5_LDR;
+        case Format::ASTC8x5sRGB:       return MTLPixelFormatASTC_8x5_sRGB;
+        case Format::ASTC8x6UNorm:      return MTLPixelFormatASTC_8x6_LDR;
+        case Format::ASTC8x6sRGB:       return MTLPixelFormatASTC_8x6_sRGB;
+        case Format::ASTC8x8UNorm:      return MTLPixelFormatASTC_8x8_LDR;
+        case Format::ASTC8x8sRGB:       return MTLPixelFormatASTC_8x8_sRGB;
+        case Format::ASTC10x5UNorm:     return MTLPixelFormatASTC_10x5_LDR;
+        case Format::ASTC10x5sRGB:      return MTLPixelFormatASTC_10x5_sRGB;
+        case Format::ASTC10x6UNorm:     return MTLPixelFormatASTC_10x6_LDR;
+        case Format::ASTC10x6sRGB:      return MTLPixelFormatASTC_10x6_sRGB;
+        case Format::ASTC10x8UNorm:     return MTLPixelFormatASTC_10x8_LDR;
+        case Format::ASTC10x8sRGB:      return MTLPixelFormatASTC_10x8_sRGB;
+        case Format::ASTC10x10UNorm:    return MTLPixelFormatASTC_10x10_LDR;
+        case Format::ASTC10x10sRGB:     return MTLPixelFormatASTC_10x10_sRGB;
+        case Format::ASTC12x10UNorm:    return MTLPixelFormatASTC_12x10_LDR;
+        case Format::ASTC12x10sRGB:     return MTLPixelFormatASTC_12x10_sRGB;
+        case Format::ASTC12x12UNorm:    return MTLPixelFormatASTC_12x12_LDR;
+        case Format::ASTC12x12sRGB:     return MTLPixelFormatASTC_12x12_sRGB;
+
+        #endif // /LLGL_OS_IOS || __MAC_11_0
+
+        default:                        break;
+    }
+    MapFailed("Format", "MTLPixelFormat");
+}
+
+MTLVertexFormat MapVertexFormat(const Format format)
+{
+    switch (format)
+    {
+        case Format::R8UNorm:           return MTLVertexFormatUCharNormalized;
+        case Format::R8SNorm:           return MTLVertexFormatCharNormalized;
+        case Format::R8UInt:            return MTLVertexFormatUChar;
+        case Format::R8SInt:            return MTLVertexFormatChar;
+
+        case Format::R16UNorm:          return MTLVertexFormatUShortNormalized;
+        case Format::R16SNorm:          return MTLVertexFormatShortNormalized;
+        case Format::R16UInt:           return MTLVertexFormatUShort;
+        case Format::R16SInt:           return MTLVertexFormatShort;
+        case Format::R16Float:          return MTLVertexFormatHalf;
+
+        case Format::R32UInt:           return MTLVertexFormatUInt;
+        case Format::R32SInt:           return MTLVertexFormatInt;
+        case Format::R32Float:          return MTLVertexFormatFloat;
+
+        case Format::RG8UNorm:          return MTLVertexFormatUChar2Normalized;
+        case Format::RG8SNorm:          return MTLVertexFormatChar2Normalized;
+        case Format::RG8UInt:           return MTLVertexFormatUChar2;
+        case Format::RG8SInt:           return MTLVertexFormatChar2;
+
+        case Format::RG16UNorm:         return MTLVertexFormatUShort2Normalized;
+        case Format::RG16SNorm:         return MTLVertexFormatShort2Normalized;
+        case Format::RG16UInt:          return MTLVertexFormatUShort2;
+        case Format::RG16SInt:          return MTLVertexFormatShort2;
+        case Format::RG16Float:         return MTLVertexFormatHalf2;
+
+        case Format::RG32UInt:          return MTLVertexFormatUInt2;
+        case Format::RG32SInt:          return MTLVertexFormatInt2;
+        case Format::RG32Float:         return MTLVertexFormatFloat2;
+
+        case Format::RGB8UNorm:         return MTLVertexFormatUChar3Normalized;
+        case Format::RGB8SNorm:         return MTLVertexFormatChar3Normalized;
+        case Format::RGB8UInt:          return MTLVertexFormatUChar3;
+        case Format::RGB8SInt:          return MTLVertexFormatChar3;
+
+        case Format::RGB16UNorm:        return MTLVertexFormatUShort3Normalized;
+        case Format::RGB16SNorm:        return MTLVertexFormatShort3Normalized;
+        case Format::RGB16UInt:         return MTLVertexFormatUShort3;
+        case Format::RGB16SInt:         return MTLVertexFormatShort3;
+        case Format::RGB16Float:        return MTLVertexFormatHalf3;
+
+        case Format::RGB32UInt:         return MTLVertexFormatUInt3;
+        case Format::RGB32SInt:         return MTLVertexFormatInt3;
+        case Format::RGB32Float:        return MTLVertexFormatFloat3;
+
+        case Format::RGBA8UNorm:        return MTLVertexFormatUChar4Normalized;
+        case Format::RGBA8SNorm:        return MTLVertexFormatChar4Normalized;
+        case Format::RGBA8UInt:         return MTLVertexFormatUChar4;
+        case Format::RGBA8SInt:         return MTLVertexFormatChar4;
+
+        case Format::RGBA16UNorm:       return MTLVertexFormatUShort4Normalized;
+        case Format::RGBA16SNorm:       return MTLVertexFormatShort4Normalized;
+        case Format::RGBA16UInt:        return MTLVertexFormatUShort4;
+        case Format::RGBA16SInt:        return MTLVertexFormatShort4;
+        case Format::RGBA16Float:       return MTLVertexFormatHalf4;
+
+        case Format::RGBA32UInt:        return MTLVertexFormatUInt4;
+        case Format::RGBA32SInt:        return MTLVertexFormatInt4;
+        case Format::RGBA32Float:       return MTLVertexFormatFloat4;
+
+        case Format::BGRA8UNorm:        return MTLVertexFormatUChar4Normalized_BGRA;
+        case Format::RGB10A2UNorm:      return MTLVertexFormatUInt1010102Normalized;
+
+        default:                        break;
+    }
+    MapFailed("Format", "MTLVertexFormat");
+}
+
+MTLTextureType Map(const TextureType textureType)
+{
+    switch (textureType)
+    {
+        case TextureType::Texture1D:        return MTLTextureType1D;
+        case TextureType::Texture2D:        return MTLTextureType2D;
+        case TextureType::Texture3D:        return MTLTextureType3D;
+        case TextureType::TextureCube:      return MTLTextureTypeCube;
+        case TextureType::Texture1DArray:   return MTLTextureType1DArray;
+        case TextureType::Texture2DArray:   return MTLTextureType2DArray;
+        case TextureType::TextureCubeArray: return MTLTextureTypeCubeArray;
+        case TextureType::Texture2DMS:      return MTLTextureType2DMultisample;
+        case TextureType::Texture2DMSArray: return MTLTextureType2DMultisampleArray;
+    }
+    MapFailed("TextureType", "MTLTextureType");
+}
+
+MTLPrimitiveType Map(const PrimitiveTopology primitiveTopology)
+{
+    switch (primitiveTopology)
+    {
+        case PrimitiveTopology::PointList:      return MTLPrimitiveTypePoint;
+        case PrimitiveTopology::LineList:       return MTLPrimitiveTypeLine;
+        case PrimitiveTopology::LineStrip:      return MTLPrimitiveTypeLineStrip;
+        case PrimitiveTopology::TriangleList:   return MTLPrimitiveTypeTriangle;
+        case PrimitiveTopology::TriangleStrip:  return MTLPrimitiveTypeTriangleStrip;
+        default:                                break;
+    }
+    MapFailed("PrimitiveTopology", "MTLPrimitiveType");
+}
+
+MTLCullMode Map(const CullMode cullMode)
+{
+    switch (cullMode)
+    {
+        case CullMode::Disabled:    return MTLCullModeNone;
+        case CullMode::Front:       return MTLCullModeFront;
+        case CullMode::Back:        return MTLCullModeBack;
+    }
+    MapFailed("CullMode", "MTLCullMode");
+}
+
+MTLTriangleFillMode Map(const PolygonMode polygonMode)
+{
+    switch (polygonMode)
+    {
+        case PolygonMode::Fill:         return MTLTriangleFillModeFill;
+        case PolygonMode::Wireframe:    return MTLTriangleFillModeLines;
+        case PolygonMode::Points:       break;
+    }
+    MapFailed("PolygonMode", "MTLTriangleFillMode");
+}
+
+MTLCompareFunction Map(const CompareOp compareOp)
+{
+    switch (compareOp)
+    {
+        case CompareOp::Never:          return MTLCompareFunctionNever;
+        case CompareOp::Less:           return MTLCompareFunctionLess;
+        case CompareOp::Equal:          return MTLCompareFunctionEqual;
+        case CompareOp::LessEqual:      return MTLCompareFunctionLessEqual;
+        case CompareOp::Greater:        return MTLCompareFunctionGreater;
+        case CompareOp::NotEqual:       return MTLCompareFunctionNotEqual;
+        case CompareOp::GreaterEqual:   return MTLCompareFunctionGreaterEqual;
+        case CompareOp::Ever:           return MTLCompareFunctionAlways;
+    }
+    MapFailed("CompareOp", "MTLCompareFunction");
+}
+
+MTLStencilOperation Map(const StencilOp stencilOp)
+{
+    switch (stencilOp)
+    {
+        case StencilOp::Keep:       return MTLStencilOperationKeep;
+        case StencilOp::Zero:       return MTLStencilOperationZero;
+        case StencilOp::Replace:    return MTLStencilOperationReplace;
+        case StencilOp::IncClamp:   return MTLStencilOperationIncrementClamp;
+        case StencilOp::DecClamp:   return MTLStencilOperationDecrementClamp;
+        case StencilOp::Invert:     return MTLStencilOperationInvert;
+        case StencilOp::IncWrap:    return MTLStencilOperationIncrementWrap;
+        case StencilOp::DecWrap:    return MTLStencilOperationDecrementWrap;
+    }
+    MapFailed("StencilOp", "MTLStencilOperation");
+}
+
+MTLBlendFactor Map(const BlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BlendOp::Zero:             return MTLBlendFactorZero;
+        case BlendOp::One:              return MTLBlendFactorOne;
+        case BlendOp::SrcColor:         return MTLBlendFactorSourceColor;
+        case BlendOp::InvSrcColor:      return MTLBlendFactorOneMinusSourceColor;
+        case BlendOp::SrcAlpha:         return MTLBlendFactorSourceAlpha;
+        case BlendOp::InvSrcAlpha:      return MTLBlendFactorOneMinusSourceAlpha;
+        case BlendOp::DstColor:         return MTLBlendFactorDestinationColor;
+        case BlendOp::InvDstColor:      return MTLBlendFactorOneMinusDestinationColor;
+        case BlendOp::DstAlpha:         return MTLBlendFactorDestinationAlpha;
+        case BlendOp::InvDstAlpha:      return MTLBlendFactorOneMinusDestinationAlpha;
+        case BlendOp::SrcAlphaSaturate: return MTLBlendFactorSourceAlphaSaturated;
+        case BlendOp::BlendFactor:      return MTLBlendFactorBlendColor;
+        case BlendOp::InvBlendFactor:   return MTLBlendFactorOneMinusBlendColor;
+        case BlendOp::Src1Color:        return MTLBlendFactorSource1Color;
+        case BlendOp::InvSrc1Color:     return MTLBlendFactorOneMinusSource1Color;
+        case BlendOp::Src1Alpha:        return MTLBlendFactorSource1Alpha;
+        case BlendOp::InvSrc1Alpha:     return MTLBlendFactorOneMinusSource1Alpha;
+    }
+    MapFailed("BlendOp", "MTLBlendFactor");
+}
+
+MTLBlendOperation Map(const BlendArithmetic blendArithmetic)
+{
+    switch (blendArithmetic)
+    {
+        case BlendArithmetic::Add:          return MTLBlendOperationAdd;
+        case BlendArithmetic::Subtract:     return MTLBlendOperationSubtract;
+        case BlendArithmetic::RevSubtract:  return MTLBlendOperationReverseSubtract;
+        case BlendArithmetic::Min:          return MTLBlendOperationMin;
+        case BlendArithmetic::Max:          return MTLBlendOperationMax;
+    }
+    MapFailed("BlendArithmetic", "MTLBlendOperation");
+}
+
+MTLSamplerAddressMode Map(const SamplerAddressMode addressMode)
+{
+    switch (addressMode)
+    {
+        case SamplerAddressMode::Repeat:        return MTLSamplerAddressModeRepeat;
+        case SamplerAddressMode::Mirror:        return MTLSamplerAddressModeMirrorRepeat;
+        case SamplerAddressMode::Clamp:         return MTLSamplerAddressModeClampToEdge;
+        case SamplerAddressMode::Border:        return MTLSamplerAddressModeClampToBorderColor;
+        case SamplerAddressMode::MirrorOnce:    return MTLSamplerAddressModeMirrorClampToEdge;
+    }
+    MapFailed("SamplerAddressMode", "MTLSamplerAddressMode");
+}
+
+MTLSamplerMinMagFilter Map(const SamplerFilter filter)
+{
+    switch (filter)
+    {
+        case SamplerFilter::Nearest:    return MTLSamplerMinMagFilterNearest;
+        case SamplerFilter::Linear:     return MTLSamplerMinMagFilterLinear;
+    }
+    MapFailed("SamplerFilter", "MTLSamplerMinMagFilter");
+}
+
+MTLSamplerMipFilter MapMipFilter(const SamplerFilter filter)
+{
+    switch (filter)
+    {
+        case SamplerFilter::Nearest:    return MTLSamplerMipFilterNearest;
+        case SamplerFilter::Linear:     return MTLSamplerMipFilterLinear;
+    }
+    MapFailed("SamplerFilter", "MTLSamplerMipFilter");
+}
+
+MTLLoadAction Map(const AttachmentLoadOp loadOp)
+{
+    switch (loadOp)
+    {
+        case AttachmentLoadOp::Undefined:   return MTLLoadActionDontCare;
+        case AttachmentLoadOp::Load:        return MTLLoadActionLoad;
+        case AttachmentLoadOp::Clear:       return MTLLoadActionClear;
+    }
+    MapFailed("AttachmentLoadOp", "MTLLoadAction");
+}
+
+MTLStoreAction Map(const AttachmentStoreOp storeOp)
+{
+    switch (storeOp)
+    {
+        case AttachmentStoreOp::Undefined:  return MTLStoreActionDontCare;
+        case AttachmentStoreOp::Store:      return MTLStoreActionStore;
+    }
+    MapFailed("AttachmentStoreOp", "MTLStoreAction");
+}
+
+MTLIndexType Map(const DataType indexType)
+{
+    switch (indexType)
+    {
+        case DataType::UInt16:  return MTLIndexTypeUInt16;
+        case DataType::UInt32:  return MTLIndexTypeUInt32;
+        default:                break;
+    }
+    MapFailed("DataType", "MTLIndexType");
+}
+
+MTLColorWriteMask Map(const ColorRGBAb& colorMask)
+{
+    MTLColorWriteMask mask = MTLColorWriteMaskNone;
+    {
+        if (colorMask.r) { mask |= MTLColorWriteMaskRed;   }
+        if (colorMask.g) { mask |= MTLColorWriteMaskGreen; }
+        if (colorMask.b) { mask |= MTLColorWriteMaskBlue;  }
+        if (colorMask.a) { mask |= MTLColorWriteMaskAlpha; }
+    }
+    return mask;
+}
+
+#if defined(__MAC_10_15) || defined(__IPHONE_13_0)
+
+MTLTextureSwizzle Map(const TextureSwizzle textureSwizzle)
+{
+    switch (textureSwizzle)
+    {
+        case TextureSwizzle::Zero:  return MTLTextureSwizzleZero;
+        case TextureSwizzle::One:   return MTLTextureSwizzleOne;
+        case TextureSwizzle::Red:   return MTLTextureSwizzleRed;
+        case TextureSwizzle::Green: return MTLTextureSwizzleGreen;
+        case TextureSwizzle::Blue:  return MTLTextureSwizzleBlue;
+        case TextureSwizzle::Alpha: return MTLTextureSwizzleAlpha;
+    }
+    MapFailed("TextureSwizzle", "MTLTextureSwizzle");
+}
+
+#endif
+
+MTLPrimitiveTopologyClass MapTopologyClass(const PrimitiveTopology primitiveTopology)
+{
+    switch (primitiveTopology)
+    {
+        case PrimitiveTopology::PointList:      return MTLPrimitiveTopologyClassPoint;
+        case PrimitiveTopology::LineList:       return MTLPrimitiveTopologyClassLine;
+        case PrimitiveTopology::LineStrip:      return MTLPrimitiveTopologyClassLine;
+        case PrimitiveTopology::TriangleList:   return MTLPrimitiveTopologyClassTriangle;
+        case PrimitiveTopology::TriangleStrip:  return MTLPrimitiveTopologyClassTriangle;
+        default:                                break;
+    }
+    MapFailed("PrimitiveTopology", "MTLPrimitiveTopologyClass");
+}
+
+Format Unmap(const MTLPixelFormat pixelFormat)
+{
+    switch (pixelFormat)
+    {
+        /* --- Color formats --- */
+        case MTLPixelFormatR8Unorm:                 return Format::R8UNorm;
+        case MTLPixelFormatR8Snorm:                 return Format::R8SNorm;
+        case MTLPixelFormatR8Uint:                  return Format::R8UInt;
+        case MTLPixelFormatR8Sint:                  return Format::R8SInt;
+
+        case MTLPixelFormatR16Unorm:                return Format::R16UNorm;
+        case MTLPixelFormatR16Snorm:                return Format::R16SNorm;
+        case MTLPixelFormatR16Uint:                 return Format::R16UInt;
+        case MTLPixelFormatR16Sint:                 return Format::R16SInt;
+        case MTLPixelFormatR16Float:                return Format::R16Float;
+
+        case MTLPixelFormatR32Uint:                 return Format::R32UInt;
+        case MTLPixelFormatR32Sint:                 return Format::R32SInt;
+        case MTLPixelFormatR32Float:                return Format::R32Float;
+
+        case MTLPixelFormatRG8Unorm:                return Format::RG8UNorm;
+        case MTLPixelFormatRG8Snorm:                return Format::RG8SNorm;
+        case MTLPixelFormatRG8Uint:                 return Format::RG8UInt;
+        case MTLPixelFormatRG8Sint:                 return Format::RG8SInt;
+
+        case MTLPixelFormatRG16Unorm:               return Format::RG16UNorm;
+        case MTLPixelFormatRG16Snorm:               return Format::RG16SNorm;
+        case MTLPixelFormatRG16Uint:                return Format::RG16UInt;
+        case MTLPixelFormatRG16Sint:                return Format::RG16SInt;
+        case MTLPixelFormatRG16Float:               return Format::RG16Float;
+
+        case MTLPixelFormatRG32Uint:                return Format::RG32UInt;
+        case MTLPixelFormatRG32Sint:                return Format::RG32SInt;
+        case MTLPixelFormatRG32Float:               return Format::RG32Float;
+
+        case MTLPixelFormatRGBA8Unorm:              return Format::RGBA8UNorm;
+        case MTLPixelFormatRGBA8Snorm:              return Format::RGBA8SNorm;
+        case MTLPixelFormatRGBA8Uint:               return Format::RGBA8UInt;
+        case MTLPixelFormatRGBA8Sint:               return Format::RGBA8SInt;
+
+        case MTLPixelFormatRGBA16Unorm:             return Format::RGBA16UNorm;
+        case MTLPixelFormatRGBA16Snorm:             return Format::RGBA16SNorm;
+        case MTLPixelFormatRGBA16Uint:              return Format::RGBA16UInt;
+        case MTLPixelFormatRGBA16Sint:              return Format::RGBA16SInt;
+        case MTLPixelFormatRGBA16Float:             return Format::RGBA16Float;
+
+        case MTLPixelFormatRGBA32Uint:              return Format::RGBA32UInt;
+        case MTLPixelFormatRGBA32Sint:              return Format::RGBA32SInt;
+        case MTLPixelFormatRGBA32Float:             return Format::RGBA32Float;
+
+        /* --- Reversed color formats --- */
+        case MTLPixelFormatBGRA8Unorm:              return Format::BGRA8UNorm;
+        case MTLPixelFormatBGRA8Unorm_sRGB:         return Format::BGRA8sRGB;
+
+        /* --- Packed color formats --- */
+        case MTLPixelFormatRGB10A2Unorm:            return Format::RGB10A2UNorm;
+        case MTLPixelFormatRGB10A2Uint:             return Format::RGB10A2UInt;
+        case MTLPixelFormatRG11B10Float:            return Format::RG11B10Float;
+
+        /* --- Depth-stencil formats --- */
+        case MTLPixelFormatDepth16Unorm:            return Format::D16UNorm;
+        case MTLPixelFormatDepth32Float:            return Format::D32Float;
+        #ifdef LLGL_OS_MACOS
+        case MTLPixelFormatDepth24Unorm_Stencil8:   return Format::D24UNormS8UInt;
+        #endif
+        case MTLPixelFormatDepth32Float_Stencil8:   return Format::D32FloatS8X24UInt;
+
+        default:                                    break;
+    }
+    return Format::Undefined;
+}
+
+
+/* ----- Convert functions ----- */
+
+void Convert(MTLViewport& dst, const Viewport& src)
+{
+    dst.originX = static_cast<double>(src.x);
+    dst.originY = static_cast<double>(src.y);
+    dst.width   = static_cast<double>(src.width);
+    dst.height  = static_cast<double>(src.height);
+    dst.znear   = static_cast<double>(src.minDepth);
+    dst.zfar    = static_cast<double>(src.maxDepth);
+}
+
+void Convert(MTLScissorRect& dst, const Scissor& src)
+{
+    dst.x       = static_cast<NSUInteger>(std::max(0, src.x));
+    dst.y       = static_cast<NSUInteger>(std::max(0, src.y));
+    dst.width   = static_cast<NSUInteger>(std::max(0, src.width));
+    dst.height  = static_cast<NSUInteger>(std::max(0, src.height));
+}
+
+void Convert(MTLClearColor& dst, const ColorRGBAf& src)
+{
+    dst = MTLClearColorMake(src.r, src.g, src.b, src.a);
+}
+
+
+} // /namespace MTTypes
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,62 @@
+/*
+ * MTComputePipeline.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_COMPUTE_PIPELINE_H
+#define LLGL_MT_COMPUTE_PIPELINE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/ComputePipeline.h>
+#include <LLGL/ComputePipelineFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+
+
+namespace LLGL
+{
+
+
+class MTComputePipeline final : public ComputePipeline
+{
+
+    public:
+
+        MTComputePipeline(id<MTLDevice> device, const ComputePipelineDescriptor& desc);
+        ~MTComputePipeline();
+
+        // Sets the pipeline state of this pipeline.
+        void Bind(id<MTLComputeCommandEncoder> computeEncoder);
+
+        // Returns the number of threads per work group, which is specified by the compute shader.
+        inline MTLSize GetWorkGroupSize() const
+        {
+            return workGroupSize_;
+        }
+
+        // Returns the layout of the constants (see CommandBuffer::SetConstants).
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
+    private:
+
+        id<MTLComputePipelineState> computePipelineState_   = nil;
+        MTLSize                     workGroupSize_;
+        ConstantsDescriptor         constants_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,63 @@
+/*
+ * MTComputePipeline.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTComputePipeline.h"
+#include "MTPipelineLayout.h"
+#include "../Shader/MTShaderProgram.h"
+#include "../Shader/MTShader.h"
+#include "../MTCore.h"
+#include "../../CheckedCast.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+MTComputePipeline::MTComputePipeline(id<MTLDevice> device, const ComputePipelineDescriptor& desc)
+{
+    if (desc.shaderProgram == nullptr)
+        throw std::invalid_argument("failed to create compute pipeline due to missing shader program");
+
+    auto shaderProgramMT = LLGL_CAST(const MTShaderProgram*, desc.shaderProgram);
+    auto computeShaderMT = shaderProgramMT->GetComputeShader();
+
+    if (computeShaderMT == nullptr)
+        throw std::invalid_argument("cannot create Metal compute pipeline without compute shader");
+
+    workGroupSize_ = computeShaderMT->GetWorkGroupSize();
+
+    if (desc.pipelineLayout != nullptr)
+    {
+        auto pipelineLayoutMT = LLGL_CAST(const MTPipelineLayout*, desc.pipelineLayout);
+        constants_ = pipelineLayoutMT->GetConstants();
+    }
+
+    /* Create compute pipeline state */
+    NSError* error = nil;
+    computePipelineState_ = [device newComputePipelineStateWithFunction:computeShaderMT->GetNative() error:&error];
+
+    MTThrowIfFailed(error, "failed to create Metal compute pipeline state");
+    MTThrowIfCreateFailed(computePipelineState_, "MTLComputePipelineState");
+}
+
+MTComputePipeline::~MTComputePipeline()
+{
+    [computePipelineState_ release];
+}
+
+void MTComputePipeline::Bind(id<MTLComputeCommandEncoder> computeEncoder)
+{
+    [computeEncoder setComputePipelineState:computePipelineState_];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
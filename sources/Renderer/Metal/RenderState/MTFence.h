@@ -0,0 +1,66 @@
+/*
+ * MTFence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_FENCE_H
+#define LLGL_MT_FENCE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Fence.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class MTFence final : public Fence
+{
+
+    public:
+
+        MTFence(id<MTLDevice> device);
+        ~MTFence();
+
+        std::uint64_t GetCompletedValue() override;
+
+        // Encodes a signal of the next value into the specified command buffer and returns that value.
+        std::uint64_t SignalNext(id<MTLCommandBuffer> cmdBuffer);
+
+        // Encodes a signal of the specified value into the specified command buffer.
+        void Signal(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value);
+
+        // Blocks the CPU until the shared event has reached the specified value, or the timeout (in nanoseconds) has expired.
+        bool WaitValue(std::uint64_t value, std::uint64_t timeout);
+
+        // Blocks the CPU until the last value this fence has been signaled with has been reached.
+        bool Wait(std::uint64_t timeout);
+
+        // Returns the native shared event of this fence.
+        inline id<MTLSharedEvent> GetNative() const
+        {
+            return event_;
+        }
+
+    private:
+
+        id<MTLSharedEvent>          event_          = nil;
+        MTLSharedEventListener*     listener_       = nil;
+        std::uint64_t               signaledValue_  = 0;    // Greatest value the shared event is signaled with
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
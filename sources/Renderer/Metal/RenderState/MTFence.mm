@@ -0,0 +1,85 @@
+/*
+ * MTFence.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTFence.h"
+#include "../MTCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+MTFence::MTFence(id<MTLDevice> device)
+{
+    event_ = [device newSharedEvent];
+    MTThrowIfCreateFailed(event_, "MTLSharedEvent");
+    listener_ = [[MTLSharedEventListener alloc] init];
+}
+
+MTFence::~MTFence()
+{
+    [listener_ release];
+    [event_ release];
+}
+
+std::uint64_t MTFence::GetCompletedValue()
+{
+    return [event_ signaledValue];
+}
+
+std::uint64_t MTFence::SignalNext(id<MTLCommandBuffer> cmdBuffer)
+{
+    Signal(cmdBuffer, signaledValue_ + 1);
+    return signaledValue_;
+}
+
+void MTFence::Signal(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value)
+{
+    [cmdBuffer encodeSignalEvent:event_ value:value];
+    signaledValue_ = std::max(signaledValue_, value);
+}
+
+bool MTFence::WaitValue(std::uint64_t value, std::uint64_t timeout)
+{
+    if ([event_ signaledValue] >= value)
+        return true;
+
+    if (timeout == 0)
+        return false;
+
+    /* Wait for the notification of the shared event listener */
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+
+    [event_
+        notifyListener: listener_
+        atValue:        value
+        block:          ^(id<MTLSharedEvent>, std::uint64_t)
+        {
+            dispatch_semaphore_signal(semaphore);
+        }
+    ];
+
+    dispatch_time_t waitTime = (timeout == UINT64_MAX ? DISPATCH_TIME_FOREVER : dispatch_time(DISPATCH_TIME_NOW, static_cast<std::int64_t>(std::min<std::uint64_t>(timeout, INT64_MAX))));
+    const bool result = (dispatch_semaphore_wait(semaphore, waitTime) == 0);
+
+    dispatch_release(semaphore);
+
+    return (result || [event_ signaledValue] >= value);
+}
+
+bool MTFence::Wait(std::uint64_t timeout)
+{
+    return WaitValue(signaledValue_, timeout);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,121 @@
+/*
+ * MTGraphicsPipeline.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_GRAPHICS_PIPELINE_H
+#define LLGL_MT_GRAPHICS_PIPELINE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/GraphicsPipeline.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class MTGraphicsPipeline final : public GraphicsPipeline
+{
+
+    public:
+
+        // Creates the graphics pipeline for the attachment formats of the render target in the descriptor, or the specified render context formats if there is no render target.
+        MTGraphicsPipeline(
+            id<MTLDevice>                       device,
+            const GraphicsPipelineDescriptor&   desc,
+            MTLPixelFormat                      defaultColorFormat,
+            MTLPixelFormat                      defaultDepthStencilFormat
+        );
+
+        ~MTGraphicsPipeline();
+
+        // Sets the pipeline state and all static render states of this pipeline.
+        void Bind(id<MTLRenderCommandEncoder> renderEncoder);
+
+        // Returns the native primitive type for the draw commands.
+        inline MTLPrimitiveType GetPrimitiveType() const
+        {
+            return primitiveType_;
+        }
+
+        // Returns the layout of the constants (see CommandBuffer::SetConstants).
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
+        // Returns true if the scissor test is enabled, otherwise the scissor rectangle must cover the entire framebuffer.
+        inline bool IsScissorTestEnabled() const
+        {
+            return scissorTestEnabled_;
+        }
+
+        // Returns the static viewports of this pipeline, which may be empty.
+        inline const std::vector<MTLViewport>& GetStaticViewports() const
+        {
+            return viewports_;
+        }
+
+        // Returns the static scissor rectangles of this pipeline, which may be empty.
+        inline const std::vector<MTLScissorRect>& GetStaticScissors() const
+        {
+            return scissors_;
+        }
+
+        // Returns the dynamic state flags (see DynamicStateFlags).
+        inline long GetDynamicStates() const
+        {
+            return dynamicStates_;
+        }
+
+    private:
+
+        void CreateRenderPipelineState(
+            id<MTLDevice>                       device,
+            const GraphicsPipelineDescriptor&   desc,
+            MTLPixelFormat                      defaultColorFormat,
+            MTLPixelFormat                      defaultDepthStencilFormat
+        );
+
+        void CreateDepthStencilState(id<MTLDevice> device, const GraphicsPipelineDescriptor& desc);
+
+    private:
+
+        id<MTLRenderPipelineState>  renderPipelineState_    = nil;
+        id<MTLDepthStencilState>    depthStencilState_      = nil;
+
+        MTLPrimitiveType            primitiveType_          = MTLPrimitiveTypeTriangle;
+        MTLCullMode                 cullMode_               = MTLCullModeNone;
+        MTLWinding                  winding_                = MTLWindingClockwise;
+        MTLTriangleFillMode         fillMode_               = MTLTriangleFillModeFill;
+        MTLDepthClipMode            depthClipMode_          = MTLDepthClipModeClip;
+        DepthBiasDescriptor         depthBias_;
+        std::uint32_t               stencilFrontRef_        = 0;
+        std::uint32_t               stencilBackRef_         = 0;
+        ColorRGBAf                  blendFactor_;
+        bool                        scissorTestEnabled_     = false;
+        long                        dynamicStates_          = 0;
+
+        std::vector<MTLViewport>    viewports_;
+        std::vector<MTLScissorRect> scissors_;
+
+        ConstantsDescriptor         constants_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,197 @@
+/*
+ * MTGraphicsPipeline.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTGraphicsPipeline.h"
+#include "MTPipelineLayout.h"
+#include "../Shader/MTShaderProgram.h"
+#include "../Shader/MTShader.h"
+#include "../Texture/MTRenderTarget.h"
+#include "../MTTypes.h"
+#include "../MTCore.h"
+#include "../../CheckedCast.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+MTGraphicsPipeline::MTGraphicsPipeline(
+    id<MTLDevice>                       device,
+    const GraphicsPipelineDescriptor&   desc,
+    MTLPixelFormat                      defaultColorFormat,
+    MTLPixelFormat                      defaultDepthStencilFormat)
+{
+    if (desc.shaderProgram == nullptr)
+        throw std::invalid_argument("failed to create graphics pipeline due to missing shader program");
+
+    /* Store rasterizer states, which are set with the render command encoder */
+    primitiveType_      = MTTypes::Map(desc.primitiveTopology);
+    cullMode_           = MTTypes::Map(desc.rasterizer.cullMode);
+    winding_            = (desc.rasterizer.frontCCW ? MTLWindingCounterClockwise : MTLWindingClockwise);
+    fillMode_           = MTTypes::Map(desc.rasterizer.polygonMode);
+    depthClipMode_      = (desc.rasterizer.depthClampEnabled ? MTLDepthClipModeClamp : MTLDepthClipModeClip);
+    depthBias_          = desc.rasterizer.depthBias;
+    stencilFrontRef_    = desc.stencil.front.reference;
+    stencilBackRef_     = desc.stencil.back.reference;
+    blendFactor_        = desc.blend.blendFactor;
+    scissorTestEnabled_ = desc.rasterizer.scissorTestEnabled;
+    dynamicStates_      = desc.dynamicStates;
+
+    /* Convert static viewports and scissors */
+    viewports_.resize(desc.viewports.size());
+    for (std::size_t i = 0; i < desc.viewports.size(); ++i)
+        MTTypes::Convert(viewports_[i], desc.viewports[i]);
+
+    scissors_.resize(desc.scissors.size());
+    for (std::size_t i = 0; i < desc.scissors.size(); ++i)
+        MTTypes::Convert(scissors_[i], desc.scissors[i]);
+
+    if (desc.pipelineLayout != nullptr)
+    {
+        auto pipelineLayoutMT = LLGL_CAST(const MTPipelineLayout*, desc.pipelineLayout);
+        constants_ = pipelineLayoutMT->GetConstants();
+    }
+
+    CreateRenderPipelineState(device, desc, defaultColorFormat, defaultDepthStencilFormat);
+    CreateDepthStencilState(device, desc);
+}
+
+MTGraphicsPipeline::~MTGraphicsPipeline()
+{
+    [depthStencilState_ release];
+    [renderPipelineState_ release];
+}
+
+void MTGraphicsPipeline::Bind(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    [renderEncoder setRenderPipelineState:renderPipelineState_];
+    [renderEncoder setDepthStencilState:depthStencilState_];
+    [renderEncoder setCullMode:cullMode_];
+    [renderEncoder setFrontFacingWinding:winding_];
+    [renderEncoder setTriangleFillMode:fillMode_];
+    [renderEncoder setDepthClipMode:depthClipMode_];
+
+    if ((dynamicStates_ & DynamicStateFlags::DepthBias) == 0)
+        [renderEncoder setDepthBias:depthBias_.constantFactor slopeScale:depthBias_.slopeFactor clamp:depthBias_.clamp];
+    if ((dynamicStates_ & DynamicStateFlags::StencilReference) == 0)
+        [renderEncoder setStencilFrontReferenceValue:stencilFrontRef_ backReferenceValue:stencilBackRef_];
+    if ((dynamicStates_ & DynamicStateFlags::BlendFactor) == 0)
+        [renderEncoder setBlendColorRed:blendFactor_.r green:blendFactor_.g blue:blendFactor_.b alpha:blendFactor_.a];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static void FillColorAttachmentDesc(MTLRenderPipelineColorAttachmentDescriptor* dst, const BlendDescriptor& blendDesc, const BlendTargetDescriptor& targetDesc)
+{
+    dst.blendingEnabled             = (blendDesc.blendEnabled ? YES : NO);
+    dst.sourceRGBBlendFactor        = MTTypes::Map(targetDesc.srcColor);
+    dst.destinationRGBBlendFactor   = MTTypes::Map(targetDesc.dstColor);
+    dst.rgbBlendOperation           = MTTypes::Map(targetDesc.colorArithmetic);
+    dst.sourceAlphaBlendFactor      = MTTypes::Map(targetDesc.srcAlpha);
+    dst.destinationAlphaBlendFactor = MTTypes::Map(targetDesc.dstAlpha);
+    dst.alphaBlendOperation         = MTTypes::Map(targetDesc.alphaArithmetic);
+    dst.writeMask                   = MTTypes::Map(targetDesc.colorMask);
+}
+
+void MTGraphicsPipeline::CreateRenderPipelineState(
+    id<MTLDevice>                       device,
+    const GraphicsPipelineDescriptor&   desc,
+    MTLPixelFormat                      defaultColorFormat,
+    MTLPixelFormat                      defaultDepthStencilFormat)
+{
+    auto shaderProgramMT = LLGL_CAST(const MTShaderProgram*, desc.shaderProgram);
+
+    if (shaderProgramMT->GetVertexShader() == nullptr)
+        throw std::invalid_argument("cannot create Metal graphics pipeline without vertex shader");
+
+    /* Get attachment formats either from the render target or the render context */
+    std::vector<MTLPixelFormat> colorFormats;
+    MTLPixelFormat depthStencilFormat = defaultDepthStencilFormat;
+
+    if (desc.renderTarget != nullptr)
+    {
+        auto renderTargetMT = LLGL_CAST(const MTRenderTarget*, desc.renderTarget);
+        colorFormats        = renderTargetMT->GetColorFormats();
+        depthStencilFormat  = renderTargetMT->GetDepthStencilFormat();
+    }
+    else
+        colorFormats.push_back(defaultColorFormat);
+
+    MTLRenderPipelineDescriptor* pipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
+    {
+        pipelineDesc.vertexDescriptor       = shaderProgramMT->GetVertexDescriptor();
+        pipelineDesc.vertexFunction         = shaderProgramMT->GetVertexShader()->GetNative();
+        pipelineDesc.fragmentFunction       = (shaderProgramMT->GetFragmentShader() != nullptr ? shaderProgramMT->GetFragmentShader()->GetNative() : nil);
+        pipelineDesc.sampleCount            = desc.rasterizer.multiSampling.SampleCount();
+        pipelineDesc.alphaToCoverageEnabled = (desc.blend.alphaToCoverageEnabled ? YES : NO);
+
+        if (@available(macOS 10.11, iOS 12.0, *))
+            pipelineDesc.inputPrimitiveTopology = MTTypes::MapTopologyClass(desc.primitiveTopology);
+
+        for (std::size_t i = 0; i < colorFormats.size(); ++i)
+        {
+            MTLRenderPipelineColorAttachmentDescriptor* colorAttachmentDesc = pipelineDesc.colorAttachments[i];
+            colorAttachmentDesc.pixelFormat = colorFormats[i];
+            FillColorAttachmentDesc(
+                colorAttachmentDesc,
+                desc.blend,
+                (i < desc.blend.targets.size() ? desc.blend.targets[i] : BlendTargetDescriptor{})
+            );
+        }
+
+        pipelineDesc.depthAttachmentPixelFormat = (depthStencilFormat != MTLPixelFormatStencil8 ? depthStencilFormat : MTLPixelFormatInvalid);
+        if (MTIsStencilFormat(depthStencilFormat))
+            pipelineDesc.stencilAttachmentPixelFormat = depthStencilFormat;
+    }
+
+    NSError* error = nil;
+    renderPipelineState_ = [device newRenderPipelineStateWithDescriptor:pipelineDesc error:&error];
+    [pipelineDesc release];
+
+    MTThrowIfFailed(error, "failed to create Metal render pipeline state");
+    MTThrowIfCreateFailed(renderPipelineState_, "MTLRenderPipelineState");
+}
+
+static void FillStencilDesc(MTLStencilDescriptor* dst, const StencilFaceDescriptor& src)
+{
+    dst.stencilFailureOperation     = MTTypes::Map(src.stencilFailOp);
+    dst.depthFailureOperation       = MTTypes::Map(src.depthFailOp);
+    dst.depthStencilPassOperation   = MTTypes::Map(src.depthPassOp);
+    dst.stencilCompareFunction      = MTTypes::Map(src.compareOp);
+    dst.readMask                    = src.readMask;
+    dst.writeMask                   = src.writeMask;
+}
+
+void MTGraphicsPipeline::CreateDepthStencilState(id<MTLDevice> device, const GraphicsPipelineDescriptor& desc)
+{
+    MTLDepthStencilDescriptor* depthStencilDesc = [[MTLDepthStencilDescriptor alloc] init];
+    {
+        depthStencilDesc.depthCompareFunction   = (desc.depth.testEnabled ? MTTypes::Map(desc.depth.compareOp) : MTLCompareFunctionAlways);
+        depthStencilDesc.depthWriteEnabled      = (desc.depth.writeEnabled ? YES : NO);
+
+        if (desc.stencil.testEnabled)
+        {
+            FillStencilDesc(depthStencilDesc.frontFaceStencil, desc.stencil.front);
+            FillStencilDesc(depthStencilDesc.backFaceStencil, desc.stencil.back);
+        }
+    }
+    depthStencilState_ = [device newDepthStencilStateWithDescriptor:depthStencilDesc];
+    [depthStencilDesc release];
+
+    MTThrowIfCreateFailed(depthStencilState_, "MTLDepthStencilState");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,29 @@
+/*
+ * MTPipelineLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_PIPELINE_LAYOUT_H
+#define LLGL_MT_PIPELINE_LAYOUT_H
+
+
+#include "../../BasicPipelineLayout.h"
+
+
+namespace LLGL
+{
+
+
+using MTPipelineLayout = BasicPipelineLayout;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,29 @@
+/*
+ * MTRenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_RENDER_PASS_H
+#define LLGL_MT_RENDER_PASS_H
+
+
+#include "../../BasicRenderPass.h"
+
+
+namespace LLGL
+{
+
+
+using MTRenderPass = BasicRenderPass;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
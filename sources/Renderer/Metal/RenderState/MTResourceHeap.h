@@ -0,0 +1,87 @@
+/*
+ * MTResourceHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_RESOURCE_HEAP_H
+#define LLGL_MT_RESOURCE_HEAP_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/ResourceHeap.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class ResourceBindingIterator;
+
+/*
+This class binds all resources to the slots of the Metal argument tables within one bind call in the command buffer.
+Constant and storage buffers share the buffer table, sampled and storage textures share the texture table.
+*/
+class MTResourceHeap final : public ResourceHeap
+{
+
+    public:
+
+        MTResourceHeap(const ResourceHeapDescriptor& desc);
+
+        void BindGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t numDynamicOffsets = 0, const std::uint32_t* dynamicOffsets = nullptr);
+        void BindComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t numDynamicOffsets = 0, const std::uint32_t* dynamicOffsets = nullptr);
+
+        // Replaces the specified resource views, starting at the view with index 'firstDescriptor', and rebuilds the native bindings.
+        void WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews);
+
+    private:
+
+        enum class MTResourceKind
+        {
+            Buffer,
+            Texture,
+            Sampler,
+        };
+
+        struct MTResourceBinding
+        {
+            MTResourceKind  kind;
+            long            stageFlags;
+            NSUInteger      slot;
+            id              resource;
+            NSUInteger      offset;
+            std::int32_t    dynamicOffsetIndex; // Index into the dynamic offsets of the bind call, or -1
+        };
+
+        void BuildAllBindings();
+        void BuildBindings(ResourceBindingIterator& resourceIterator, const ResourceType type, const MTResourceKind kind);
+        void AssignDynamicOffsetIndices();
+
+        // Returns the offset of the specified buffer binding with its dynamic offset (if any).
+        NSUInteger GetBufferOffset(const MTResourceBinding& binding, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets) const;
+
+    private:
+
+        std::vector<MTResourceBinding>      bindings_;
+
+        // Resource views and layout bindings the native bindings are built from, so they can be rebuilt after in-place updates.
+        std::vector<ResourceViewDescriptor> resourceViews_;
+        std::vector<BindingDescriptor>      layoutBindings_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
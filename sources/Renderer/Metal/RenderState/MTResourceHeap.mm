@@ -0,0 +1,206 @@
+/*
+ * MTResourceHeap.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTResourceHeap.h"
+#include "MTPipelineLayout.h"
+#include "../Buffer/MTBuffer.h"
+#include "../Texture/MTTexture.h"
+#include "../Texture/MTSampler.h"
+#include "../../ResourceBindingIterator.h"
+#include "../../CheckedCast.h"
+#include <LLGL/ShaderFlags.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+MTResourceHeap::MTResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    /* Get pipeline layout object */
+    auto pipelineLayoutMT = LLGL_CAST(MTPipelineLayout*, desc.pipelineLayout);
+    if (!pipelineLayoutMT)
+        throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
+
+    /* Build native bindings for each resource type */
+    resourceViews_  = desc.resourceViews;
+    layoutBindings_ = pipelineLayoutMT->GetBindings();
+    BuildAllBindings();
+}
+
+void MTResourceHeap::BindGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    for (const auto& binding : bindings_)
+    {
+        const bool vertexStage      = ((binding.stageFlags & StageFlags::VertexStage  ) != 0);
+        const bool fragmentStage    = ((binding.stageFlags & StageFlags::FragmentStage) != 0);
+
+        switch (binding.kind)
+        {
+            case MTResourceKind::Buffer:
+            {
+                auto offset = GetBufferOffset(binding, numDynamicOffsets, dynamicOffsets);
+                if (vertexStage)
+                    [renderEncoder setVertexBuffer:(id<MTLBuffer>)binding.resource offset:offset atIndex:binding.slot];
+                if (fragmentStage)
+                    [renderEncoder setFragmentBuffer:(id<MTLBuffer>)binding.resource offset:offset atIndex:binding.slot];
+            }
+            break;
+
+            case MTResourceKind::Texture:
+            {
+                if (vertexStage)
+                    [renderEncoder setVertexTexture:(id<MTLTexture>)binding.resource atIndex:binding.slot];
+                if (fragmentStage)
+                    [renderEncoder setFragmentTexture:(id<MTLTexture>)binding.resource atIndex:binding.slot];
+            }
+            break;
+
+            case MTResourceKind::Sampler:
+            {
+                if (vertexStage)
+                    [renderEncoder setVertexSamplerState:(id<MTLSamplerState>)binding.resource atIndex:binding.slot];
+                if (fragmentStage)
+                    [renderEncoder setFragmentSamplerState:(id<MTLSamplerState>)binding.resource atIndex:binding.slot];
+            }
+            break;
+        }
+    }
+}
+
+void MTResourceHeap::BindComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    for (const auto& binding : bindings_)
+    {
+        if ((binding.stageFlags & StageFlags::ComputeStage) == 0)
+            continue;
+
+        switch (binding.kind)
+        {
+            case MTResourceKind::Buffer:
+                [computeEncoder
+                    setBuffer:  (id<MTLBuffer>)binding.resource
+                    offset:     GetBufferOffset(binding, numDynamicOffsets, dynamicOffsets)
+                    atIndex:    binding.slot
+                ];
+                break;
+
+            case MTResourceKind::Texture:
+                [computeEncoder setTexture:(id<MTLTexture>)binding.resource atIndex:binding.slot];
+                break;
+
+            case MTResourceKind::Sampler:
+                [computeEncoder setSamplerState:(id<MTLSamplerState>)binding.resource atIndex:binding.slot];
+                break;
+        }
+    }
+}
+
+void MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (static_cast<std::size_t>(firstDescriptor) + numResourceViews > resourceViews_.size())
+        throw std::out_of_range("resource views out of range for resource heap update");
+
+    /* Replace resource views and rebuild native bindings (this only affects subsequent bind calls) */
+    std::copy(resourceViews, resourceViews + numResourceViews, resourceViews_.begin() + firstDescriptor);
+
+    bindings_.clear();
+    BuildAllBindings();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTResourceHeap::BuildAllBindings()
+{
+    ResourceBindingIterator resourceIterator { resourceViews_, layoutBindings_ };
+
+    BuildBindings(resourceIterator, ResourceType::ConstantBuffer, MTResourceKind::Buffer );
+    BuildBindings(resourceIterator, ResourceType::StorageBuffer,  MTResourceKind::Buffer );
+    BuildBindings(resourceIterator, ResourceType::Texture,        MTResourceKind::Texture);
+    BuildBindings(resourceIterator, ResourceType::Sampler,        MTResourceKind::Sampler);
+
+    AssignDynamicOffsetIndices();
+}
+
+// Returns the native object of the specified resource for the respective resource kind.
+static id GetNativeResource(Resource* resource, const ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::ConstantBuffer:
+        case ResourceType::StorageBuffer:
+            return LLGL_CAST(MTBuffer*, resource)->GetNative();
+        case ResourceType::Texture:
+            return LLGL_CAST(MTTexture*, resource)->GetNative();
+        case ResourceType::Sampler:
+            return LLGL_CAST(MTSampler*, resource)->GetNative();
+        default:
+            return nil;
+    }
+}
+
+void MTResourceHeap::BuildBindings(ResourceBindingIterator& resourceIterator, const ResourceType type, const MTResourceKind kind)
+{
+    resourceIterator.Reset(type);
+
+    BindingDescriptor bindingDesc;
+    while (auto resource = resourceIterator.Next(bindingDesc))
+    {
+        MTResourceBinding binding;
+        {
+            binding.kind                = kind;
+            binding.stageFlags          = bindingDesc.stageFlags;
+            binding.slot                = bindingDesc.slot;
+            binding.resource            = GetNativeResource(resource, type);
+            binding.offset              = 0;
+            binding.dynamicOffsetIndex  = ((bindingDesc.flags & BindingFlags::DynamicOffset) != 0 ? 0 : -1);
+        }
+        bindings_.push_back(binding);
+    }
+}
+
+void MTResourceHeap::AssignDynamicOffsetIndices()
+{
+    /* Dynamic offsets are specified in ascending order of their binding slots */
+    std::vector<MTResourceBinding*> dynamicBindings;
+
+    for (auto& binding : bindings_)
+    {
+        if (binding.dynamicOffsetIndex >= 0)
+            dynamicBindings.push_back(&binding);
+    }
+
+    std::stable_sort(
+        dynamicBindings.begin(), dynamicBindings.end(),
+        [](const MTResourceBinding* lhs, const MTResourceBinding* rhs)
+        {
+            return (lhs->slot < rhs->slot);
+        }
+    );
+
+    for (std::size_t i = 0; i < dynamicBindings.size(); ++i)
+        dynamicBindings[i]->dynamicOffsetIndex = static_cast<std::int32_t>(i);
+}
+
+NSUInteger MTResourceHeap::GetBufferOffset(const MTResourceBinding& binding, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets) const
+{
+    if (binding.dynamicOffsetIndex >= 0 && static_cast<std::uint32_t>(binding.dynamicOffsetIndex) < numDynamicOffsets)
+        return binding.offset + dynamicOffsets[binding.dynamicOffsetIndex];
+    return binding.offset;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,73 @@
+/*
+ * MTShader.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_SHADER_H
+#define LLGL_MT_SHADER_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderFlags.h>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+class MTShader final : public Shader
+{
+
+    public:
+
+        MTShader(id<MTLDevice> device, const ShaderDescriptor& desc);
+        ~MTShader();
+
+        bool HasErrors() const override;
+        std::string Disassemble(int flags = 0) override;
+        std::string QueryInfoLog() override;
+
+        // Returns the native shader function, or nil if the shader has errors.
+        inline id<MTLFunction> GetNative() const
+        {
+            return function_;
+        }
+
+        // Returns the number of threads per work group of a compute shader.
+        inline MTLSize GetWorkGroupSize() const
+        {
+            return workGroupSize_;
+        }
+
+    private:
+
+        bool Build(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
+        bool CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
+        bool LoadBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
+
+        // Stores the log of the specified error, and returns true if the error is not nil.
+        bool StoreErrorLog(NSError* error);
+
+    private:
+
+        id<MTLLibrary>  library_        = nil;
+        id<MTLFunction> function_       = nil;
+        MTLSize         workGroupSize_;
+        std::string     errorLog_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,198 @@
+/*
+ * MTShader.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTShader.h"
+#include "../MTCore.h"
+#include "../../ShaderSpecialization.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/Strings.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+MTShader::MTShader(id<MTLDevice> device, const ShaderDescriptor& desc) :
+    Shader          { desc.type },
+    workGroupSize_  { MTLSizeMake(std::max(1u, desc.workGroupSize.width), std::max(1u, desc.workGroupSize.height), std::max(1u, desc.workGroupSize.depth)) }
+{
+    Build(device, desc);
+}
+
+MTShader::~MTShader()
+{
+    [function_ release];
+    [library_ release];
+}
+
+bool MTShader::HasErrors() const
+{
+    return (function_ == nil);
+}
+
+std::string MTShader::Disassemble(int flags)
+{
+    return ""; // dummy
+}
+
+std::string MTShader::QueryInfoLog()
+{
+    return errorLog_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool MTShader::Build(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+{
+    /* Metal has no geometry shaders, tessellation is not expressed by shader stages, and mesh shaders are not supported by this renderer */
+    switch (GetType())
+    {
+        case ShaderType::TessControl:
+        case ShaderType::TessEvaluation:
+        case ShaderType::Geometry:
+        case ShaderType::Amplification:
+        case ShaderType::Mesh:
+            errorLog_ = ToString(GetType());
+            errorLog_ += " shader: shader stage is not supported by Metal";
+            return false;
+        default:
+            break;
+    }
+
+    if (IsShaderSourceCode(shaderDesc.sourceType))
+    {
+        if (!CompileSource(device, shaderDesc))
+            return false;
+    }
+    else
+    {
+        if (!LoadBinary(device, shaderDesc))
+            return false;
+    }
+
+    /* Get shader function by its entry point */
+    if (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0')
+    {
+        errorLog_ += "missing entry point for Metal shader function\n";
+        return false;
+    }
+
+    NSString* entryPoint = [[NSString alloc] initWithUTF8String:shaderDesc.entryPoint];
+    function_ = [library_ newFunctionWithName:entryPoint];
+    [entryPoint release];
+
+    if (function_ == nil)
+    {
+        errorLog_ += "entry point \"";
+        errorLog_ += shaderDesc.entryPoint;
+        errorLog_ += "\" not found in Metal shader library\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+{
+    /* Get shader source */
+    std::string fileContent;
+    const char* sourceCode = nullptr;
+
+    if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
+    {
+        fileContent = ReadFileString(shaderDesc.source);
+        sourceCode  = fileContent.c_str();
+    }
+    else
+        sourceCode = shaderDesc.source;
+
+    /* Inject specialization constants as macro definitions */
+    MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
+
+    if (!shaderDesc.specializationConstants.empty())
+    {
+        NSMutableDictionary* macros = [[NSMutableDictionary alloc] init];
+
+        for (const auto& constant : shaderDesc.specializationConstants)
+        {
+            if (constant.name == nullptr)
+                continue;
+
+            NSString* name  = [[NSString alloc] initWithUTF8String:constant.name];
+            NSString* value = [[NSString alloc] initWithUTF8String:GetSpecializationConstantLiteral(constant).c_str()];
+            [macros setObject:value forKey:name];
+            [value release];
+            [name release];
+        }
+
+        options.preprocessorMacros = macros;
+        [macros release];
+    }
+
+    /* Compile shader library */
+    NSString* source = [[NSString alloc] initWithUTF8String:sourceCode];
+    NSError* error = nil;
+
+    library_ = [device newLibraryWithSource:source options:options error:&error];
+
+    [source release];
+    [options release];
+
+    /* Compiler warnings are reported by the error object as well */
+    StoreErrorLog(error);
+
+    return (library_ != nil);
+}
+
+bool MTShader::LoadBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+{
+    NSError* error = nil;
+
+    if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
+    {
+        /* Load precompiled library from file (*.metallib) */
+        NSString* filename = [[NSString alloc] initWithUTF8String:shaderDesc.source];
+        library_ = [device newLibraryWithFile:filename error:&error];
+        [filename release];
+    }
+    else
+    {
+        /* Load precompiled library from buffer, which is copied into the dispatch data object */
+        dispatch_data_t data = dispatch_data_create(shaderDesc.source, shaderDesc.sourceSize, nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+        library_ = [device newLibraryWithData:data error:&error];
+        dispatch_release(data);
+    }
+
+    StoreErrorLog(error);
+
+    return (library_ != nil);
+}
+
+bool MTShader::StoreErrorLog(NSError* error)
+{
+    if (error != nil)
+    {
+        if (auto desc = [[error localizedDescription] UTF8String])
+        {
+            errorLog_ += desc;
+            errorLog_ += '\n';
+        }
+        return true;
+    }
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
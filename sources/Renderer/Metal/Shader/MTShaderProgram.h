@@ -0,0 +1,95 @@
+/*
+ * MTShaderProgram.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_SHADER_PROGRAM_H
+#define LLGL_MT_SHADER_PROGRAM_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/ShaderProgram.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class MTShader;
+
+class MTShaderProgram final : public ShaderProgram
+{
+
+    public:
+
+        MTShaderProgram(const ShaderProgramDescriptor& desc);
+        ~MTShaderProgram();
+
+        bool HasErrors() const override;
+
+        std::string QueryInfoLog() override;
+
+        bool IsReady() const override;
+
+        ShaderReflectionDescriptor QueryReflectionDesc() const override;
+
+        void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
+        void BindStorageBuffer(const std::string& name, std::uint32_t bindingIndex) override;
+
+        ShaderUniform* LockShaderUniform() override;
+        void UnlockShaderUniform() override;
+
+        /* --- Extended functions --- */
+
+        // Returns the native vertex descriptor, or nil if the program has no vertex formats.
+        inline MTLVertexDescriptor* GetVertexDescriptor() const
+        {
+            return vertexDesc_;
+        }
+
+        // Returns the vertex shader, or null if there is none.
+        inline MTShader* GetVertexShader() const
+        {
+            return vertexShader_;
+        }
+
+        // Returns the fragment shader, or null if there is none.
+        inline MTShader* GetFragmentShader() const
+        {
+            return fragmentShader_;
+        }
+
+        // Returns the compute shader, or null if there is none.
+        inline MTShader* GetComputeShader() const
+        {
+            return computeShader_;
+        }
+
+    private:
+
+        void BuildInputLayout(std::size_t numVertexFormats, const VertexFormat* vertexFormats);
+        void Link(const ShaderProgramDescriptor& desc);
+
+    private:
+
+        MTShader*               vertexShader_   = nullptr;
+        MTShader*               fragmentShader_ = nullptr;
+        MTShader*               computeShader_  = nullptr;
+        MTLVertexDescriptor*    vertexDesc_     = nil;
+        LinkError               linkError_      = LinkError::NoError;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,161 @@
+/*
+ * MTShaderProgram.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTShaderProgram.h"
+#include "MTShader.h"
+#include "../MTTypes.h"
+#include "../MTCore.h"
+#include "../../CheckedCast.h"
+#include <LLGL/VertexFormat.h>
+
+
+namespace LLGL
+{
+
+
+MTShaderProgram::MTShaderProgram(const ShaderProgramDescriptor& desc) :
+    vertexShader_   { LLGL_CAST(MTShader*, desc.vertexShader)   },
+    fragmentShader_ { LLGL_CAST(MTShader*, desc.fragmentShader) },
+    computeShader_  { LLGL_CAST(MTShader*, desc.computeShader)  }
+{
+    BuildInputLayout(desc.vertexFormats.size(), desc.vertexFormats.data());
+    Link(desc);
+}
+
+MTShaderProgram::~MTShaderProgram()
+{
+    [vertexDesc_ release];
+}
+
+bool MTShaderProgram::HasErrors() const
+{
+    return (linkError_ != LinkError::NoError);
+}
+
+std::string MTShaderProgram::QueryInfoLog()
+{
+    if (auto s = ShaderProgram::LinkErrorToString(linkError_))
+        return s;
+    else
+        return "";
+}
+
+bool MTShaderProgram::IsReady() const
+{
+    /* Metal shader libraries are compiled synchronously */
+    return true;
+}
+
+ShaderReflectionDescriptor MTShaderProgram::QueryReflectionDesc() const
+{
+    /* Metal shader functions only expose their arguments with the reflection of a pipeline state */
+    return {}; // dummy
+}
+
+void MTShaderProgram::BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex)
+{
+    //todo
+}
+
+void MTShaderProgram::BindStorageBuffer(const std::string& name, std::uint32_t bindingIndex)
+{
+    //todo
+}
+
+ShaderUniform* MTShaderProgram::LockShaderUniform()
+{
+    return nullptr; // dummy
+}
+
+void MTShaderProgram::UnlockShaderUniform()
+{
+    // dummy
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTShaderProgram::BuildInputLayout(std::size_t numVertexFormats, const VertexFormat* vertexFormats)
+{
+    if (numVertexFormats == 0 || vertexFormats == nullptr)
+        return;
+
+    vertexDesc_ = [[MTLVertexDescriptor alloc] init];
+
+    NSUInteger location = 0;
+
+    for (std::size_t i = 0; i < numVertexFormats; ++i)
+    {
+        const auto& attribs = vertexFormats[i].attributes;
+
+        /* Vertex buffers are bound in reverse order, so they don't collide with constant buffers */
+        auto bufferIndex = MTVertexBufferIndex(vertexFormats[i].inputSlot);
+
+        /* Initialize vertex attribute descriptors */
+        for (const auto& attr : attribs)
+        {
+            MTLVertexAttributeDescriptor* attribDesc = vertexDesc_.attributes[location++];
+            attribDesc.format       = MTTypes::MapVertexFormat(attr.format);
+            attribDesc.offset       = attr.offset;
+            attribDesc.bufferIndex  = bufferIndex;
+        }
+
+        /* Initialize vertex buffer layout descriptor */
+        MTLVertexBufferLayoutDescriptor* layoutDesc = vertexDesc_.layouts[bufferIndex];
+        layoutDesc.stride = vertexFormats[i].stride;
+
+        if (!attribs.empty() && attribs.front().instanceDivisor != 0)
+        {
+            layoutDesc.stepFunction = MTLVertexStepFunctionPerInstance;
+            layoutDesc.stepRate     = attribs.front().instanceDivisor;
+        }
+        else
+        {
+            layoutDesc.stepFunction = MTLVertexStepFunctionPerVertex;
+            layoutDesc.stepRate     = 1;
+        }
+    }
+}
+
+void MTShaderProgram::Link(const ShaderProgramDescriptor& desc)
+{
+    linkError_ = LinkError::NoError;
+
+    Shader* shaders[] =
+    {
+        desc.vertexShader,
+        desc.tessControlShader,
+        desc.tessEvaluationShader,
+        desc.geometryShader,
+        desc.fragmentShader,
+        desc.computeShader,
+    };
+
+    /* Validate native shader functions */
+    for (auto shader : shaders)
+    {
+        if (shader != nullptr && shader->HasErrors())
+        {
+            /* Error: invalid shader function */
+            linkError_ = LinkError::IncompleteAttachments;
+            return;
+        }
+    }
+
+    /* Validate composition of attached shaders */
+    if (!ShaderProgram::ValidateShaderComposition(shaders, sizeof(shaders)/sizeof(shaders[0])))
+        linkError_ = LinkError::InvalidComposition;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
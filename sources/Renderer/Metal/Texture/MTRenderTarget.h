@@ -0,0 +1,85 @@
+/*
+ * MTRenderTarget.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_RENDER_TARGET_H
+#define LLGL_MT_RENDER_TARGET_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/RenderTarget.h>
+#include <LLGL/RenderTargetFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class MTRenderTarget final : public RenderTarget
+{
+
+    public:
+
+        MTRenderTarget(id<MTLDevice> device, const RenderTargetDescriptor& desc);
+        ~MTRenderTarget();
+
+        std::uint32_t GetNumColorAttachments() const override;
+        bool HasDepthAttachment() const override;
+        bool HasStencilAttachment() const override;
+
+        // Returns the native render pass descriptor with all attachments of this render target. The load and store actions are set by the command buffer.
+        inline MTLRenderPassDescriptor* GetNativeRenderPass() const
+        {
+            return renderPassDesc_;
+        }
+
+        // Returns the pixel formats of all color attachments.
+        inline const std::vector<MTLPixelFormat>& GetColorFormats() const
+        {
+            return colorFormats_;
+        }
+
+        // Returns the pixel format of the depth-stencil attachment, or MTLPixelFormatInvalid if there is none.
+        inline MTLPixelFormat GetDepthStencilFormat() const
+        {
+            return depthStencilFormat_;
+        }
+
+        // Returns the number of samples of all attachments.
+        inline NSUInteger GetSampleCount() const
+        {
+            return sampleCount_;
+        }
+
+    private:
+
+        // Creates an internal texture that is not accessible by the client, e.g. for anonymous depth-stencil or multi-sample attachments.
+        id<MTLTexture> CreateInternalTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat, MTLTextureUsage usage);
+
+        void AttachDepthStencil(id<MTLDevice> device, const AttachmentDescriptor& attachmentDesc);
+        void AttachColor(id<MTLDevice> device, const AttachmentDescriptor& attachmentDesc, NSUInteger colorAttachment);
+
+    private:
+
+        MTLRenderPassDescriptor*        renderPassDesc_     = nil;
+        std::vector<MTLPixelFormat>     colorFormats_;
+        MTLPixelFormat                  depthStencilFormat_ = MTLPixelFormatInvalid;
+        NSUInteger                      sampleCount_        = 1;
+        std::vector<id<MTLTexture>>     internalTextures_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
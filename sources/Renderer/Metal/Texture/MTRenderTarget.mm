@@ -0,0 +1,163 @@
+/*
+ * MTRenderTarget.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTRenderTarget.h"
+#include "MTTexture.h"
+#include "../MTTypes.h"
+#include "../MTCore.h"
+#include "../../CheckedCast.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+MTRenderTarget::MTRenderTarget(id<MTLDevice> device, const RenderTargetDescriptor& desc) :
+    RenderTarget { desc.resolution                                                },
+    sampleCount_ { (desc.multiSampling.enabled ? desc.multiSampling.SampleCount() : 1u) }
+{
+    renderPassDesc_ = [[MTLRenderPassDescriptor alloc] init];
+
+    if (desc.numViews > 1)
+        renderPassDesc_.renderTargetArrayLength = desc.numViews;
+
+    /* Attach all color and depth-stencil attachments */
+    NSUInteger colorAttachment = 0;
+
+    for (const auto& attachmentDesc : desc.attachments)
+    {
+        if (attachmentDesc.type == AttachmentType::Color)
+            AttachColor(device, attachmentDesc, colorAttachment++);
+        else
+            AttachDepthStencil(device, attachmentDesc);
+    }
+}
+
+MTRenderTarget::~MTRenderTarget()
+{
+    for (id<MTLTexture> texture : internalTextures_)
+        [texture release];
+    [renderPassDesc_ release];
+}
+
+std::uint32_t MTRenderTarget::GetNumColorAttachments() const
+{
+    return static_cast<std::uint32_t>(colorFormats_.size());
+}
+
+bool MTRenderTarget::HasDepthAttachment() const
+{
+    return (renderPassDesc_.depthAttachment.texture != nil);
+}
+
+bool MTRenderTarget::HasStencilAttachment() const
+{
+    return (renderPassDesc_.stencilAttachment.texture != nil);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+id<MTLTexture> MTRenderTarget::CreateInternalTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat, MTLTextureUsage usage)
+{
+    MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
+    {
+        texDesc.textureType = (sampleCount_ > 1 ? MTLTextureType2DMultisample : MTLTextureType2D);
+        texDesc.pixelFormat = pixelFormat;
+        texDesc.width       = GetResolution().width;
+        texDesc.height      = GetResolution().height;
+        texDesc.sampleCount = sampleCount_;
+        texDesc.usage       = usage;
+        texDesc.storageMode = MTLStorageModePrivate;
+    }
+    id<MTLTexture> texture = [device newTextureWithDescriptor:texDesc];
+    [texDesc release];
+
+    MTThrowIfCreateFailed(texture, "MTLTexture");
+    internalTextures_.push_back(texture);
+
+    return texture;
+}
+
+void MTRenderTarget::AttachDepthStencil(id<MTLDevice> device, const AttachmentDescriptor& attachmentDesc)
+{
+    if (depthStencilFormat_ != MTLPixelFormatInvalid)
+        throw std::invalid_argument("cannot have multiple depth-stencil attachments in Metal render target");
+
+    id<MTLTexture>  texture     = nil;
+    NSUInteger      level       = 0;
+    NSUInteger      slice       = 0;
+
+    if (attachmentDesc.texture != nullptr)
+    {
+        /* Attach depth-stencil texture */
+        auto textureMT = LLGL_CAST(MTTexture*, attachmentDesc.texture);
+        texture = textureMT->GetNative();
+        level   = attachmentDesc.mipLevel;
+        slice   = attachmentDesc.arrayLayer;
+    }
+    else
+    {
+        /* Create anonymous depth-stencil texture, which only lives in tile memory if possible */
+        auto pixelFormat = (attachmentDesc.type == AttachmentType::Depth ? MTLPixelFormatDepth32Float : MTLPixelFormatDepth32Float_Stencil8);
+        texture = CreateInternalTexture(device, pixelFormat, MTLTextureUsageRenderTarget);
+    }
+
+    depthStencilFormat_ = texture.pixelFormat;
+
+    if (attachmentDesc.type != AttachmentType::Stencil)
+    {
+        renderPassDesc_.depthAttachment.texture = texture;
+        renderPassDesc_.depthAttachment.level   = level;
+        renderPassDesc_.depthAttachment.slice   = slice;
+    }
+
+    if (MTIsStencilFormat(depthStencilFormat_))
+    {
+        renderPassDesc_.stencilAttachment.texture   = texture;
+        renderPassDesc_.stencilAttachment.level     = level;
+        renderPassDesc_.stencilAttachment.slice     = slice;
+    }
+}
+
+void MTRenderTarget::AttachColor(id<MTLDevice> device, const AttachmentDescriptor& attachmentDesc, NSUInteger colorAttachment)
+{
+    if (attachmentDesc.texture == nullptr)
+        throw std::invalid_argument("cannot have color attachment in Metal render target without a valid texture");
+
+    auto textureMT = LLGL_CAST(MTTexture*, attachmentDesc.texture);
+    id<MTLTexture> texture = textureMT->GetNative();
+
+    MTLRenderPassColorAttachmentDescriptor* colorAttachmentDesc = renderPassDesc_.colorAttachments[colorAttachment];
+
+    if (sampleCount_ > 1 && texture.sampleCount == 1)
+    {
+        /* Render into internal multi-sample texture and resolve it into the attachment at the end of the render pass */
+        colorAttachmentDesc.texture         = CreateInternalTexture(device, texture.pixelFormat, MTLTextureUsageRenderTarget);
+        colorAttachmentDesc.resolveTexture  = texture;
+        colorAttachmentDesc.resolveLevel    = attachmentDesc.mipLevel;
+        colorAttachmentDesc.resolveSlice    = attachmentDesc.arrayLayer;
+    }
+    else
+    {
+        colorAttachmentDesc.texture         = texture;
+        colorAttachmentDesc.level           = attachmentDesc.mipLevel;
+        colorAttachmentDesc.slice           = attachmentDesc.arrayLayer;
+    }
+
+    colorFormats_.push_back(texture.pixelFormat);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
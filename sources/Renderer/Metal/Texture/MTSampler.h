@@ -0,0 +1,50 @@
+/*
+ * MTSampler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_SAMPLER_H
+#define LLGL_MT_SAMPLER_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Sampler.h>
+#include <LLGL/SamplerFlags.h>
+
+
+namespace LLGL
+{
+
+
+class MTSampler final : public Sampler
+{
+
+    public:
+
+        MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc);
+        ~MTSampler();
+
+        // Returns the native sampler state object.
+        inline id<MTLSamplerState> GetNative() const
+        {
+            return samplerState_;
+        }
+
+    private:
+
+        id<MTLSamplerState> samplerState_ = nil;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
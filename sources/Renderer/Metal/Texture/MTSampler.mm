@@ -0,0 +1,71 @@
+/*
+ * MTSampler.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTSampler.h"
+#include "../MTTypes.h"
+#include "../MTCore.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_OS_MACOS
+
+static MTLSamplerBorderColor GetMTLSamplerBorderColor(const ColorRGBAf& color)
+{
+    if (color.a > 0.5f)
+    {
+        if (color.r <= 0.5f && color.g <= 0.5f && color.b <= 0.5f)
+            return MTLSamplerBorderColorOpaqueBlack;
+        if (color.r > 0.5f && color.g > 0.5f && color.b > 0.5f)
+            return MTLSamplerBorderColorOpaqueWhite;
+    }
+    return MTLSamplerBorderColorTransparentBlack;
+}
+
+#endif // /LLGL_OS_MACOS
+
+MTSampler::MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc)
+{
+    /* Create sampler state */
+    MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
+    {
+        samplerDesc.sAddressMode        = MTTypes::Map(desc.addressModeU);
+        samplerDesc.tAddressMode        = MTTypes::Map(desc.addressModeV);
+        samplerDesc.rAddressMode        = MTTypes::Map(desc.addressModeW);
+        samplerDesc.minFilter           = MTTypes::Map(desc.minFilter);
+        samplerDesc.magFilter           = MTTypes::Map(desc.magFilter);
+        samplerDesc.mipFilter           = (desc.mipMapping ? MTTypes::MapMipFilter(desc.mipMapFilter) : MTLSamplerMipFilterNotMipmapped);
+        samplerDesc.lodMinClamp         = desc.minLOD;
+        samplerDesc.lodMaxClamp         = desc.maxLOD;
+        samplerDesc.maxAnisotropy       = std::max(1u, std::min(16u, desc.maxAnisotropy));
+        samplerDesc.compareFunction     = (desc.compareEnabled ? MTTypes::Map(desc.compareOp) : MTLCompareFunctionNever);
+        samplerDesc.normalizedCoordinates = YES;
+        #ifdef LLGL_OS_MACOS
+        samplerDesc.borderColor         = GetMTLSamplerBorderColor(desc.borderColor);
+        #endif
+    }
+    samplerState_ = [device newSamplerStateWithDescriptor:samplerDesc];
+    [samplerDesc release];
+
+    MTThrowIfCreateFailed(samplerState_, "MTLSamplerState");
+}
+
+MTSampler::~MTSampler()
+{
+    [samplerState_ release];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,101 @@
+/*
+ * MTTexture.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_TEXTURE_H
+#define LLGL_MT_TEXTURE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Texture.h>
+#include <LLGL/TextureFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class MTHeapAllocator;
+
+class MTTexture final : public Texture
+{
+
+    public:
+
+        MTTexture(MTHeapAllocator& heapAllocator, const TextureDescriptor& desc);
+
+        // Creates a texture view that shares the storage of the specified texture.
+        MTTexture(const MTTexture& sharedTexture, const TextureViewDescriptor& desc);
+
+        ~MTTexture();
+
+        Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
+        TextureDescriptor QueryDesc() const override;
+
+        void SetName(const char* name) override;
+
+        // Converts the texture region into a Metal origin, size, and slice range (array layers are specified by the Z component, or Y for 1D-array textures).
+        void GetSubresourceRegion(
+            const Offset3D& offset,
+            const Extent3D& extent,
+            MTLOrigin&      origin,
+            MTLSize&        size,
+            NSUInteger&     firstSlice,
+            NSUInteger&     numSlices
+        ) const;
+
+        // Returns the native texture object.
+        inline id<MTLTexture> GetNative() const
+        {
+            return texture_;
+        }
+
+        // Returns the hardware format of this texture.
+        inline Format GetFormat() const
+        {
+            return format_;
+        }
+
+        // Returns the extent of the first MIP level (does not include the array layer count).
+        inline const Extent3D& GetExtent() const
+        {
+            return extent_;
+        }
+
+        // Returns the number of MIP levels.
+        inline std::uint32_t GetNumMipLevels() const
+        {
+            return numMipLevels_;
+        }
+
+        // Returns the number of array layers (including the faces of cube textures).
+        inline std::uint32_t GetNumArrayLayers() const
+        {
+            return numArrayLayers_;
+        }
+
+    private:
+
+        id<MTLTexture>  texture_        = nil;
+        Format          format_         = Format::Undefined;
+        Extent3D        extent_;
+        std::uint32_t   numMipLevels_   = 0;
+        std::uint32_t   numArrayLayers_ = 0;
+        std::uint32_t   samples_        = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,240 @@
+/*
+ * MTTexture.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTTexture.h"
+#include "../MTTypes.h"
+#include "../MTCore.h"
+#include "../MTHeapAllocator.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Returns the usage flags of the native texture for the specified texture flags.
+static MTLTextureUsage GetMTLTextureUsage(long flags)
+{
+    MTLTextureUsage usage = MTLTextureUsageShaderRead;
+
+    if ((flags & TextureFlags::AttachmentUsage) != 0)
+        usage |= MTLTextureUsageRenderTarget;
+    if ((flags & TextureFlags::StorageUsage) != 0)
+        usage |= MTLTextureUsageShaderWrite;
+    if ((flags & TextureFlags::MutableFormat) != 0)
+        usage |= MTLTextureUsagePixelFormatView;
+
+    return usage;
+}
+
+MTTexture::MTTexture(MTHeapAllocator& heapAllocator, const TextureDescriptor& desc) :
+    Texture         { desc.type                             },
+    format_         { desc.format                           },
+    extent_         { desc.extent                           },
+    numMipLevels_   { (IsMultiSampleTexture(desc.type) ? 1u : NumMipLevels(desc)) },
+    numArrayLayers_ { std::max(1u, desc.arrayLayers)        },
+    samples_        { std::max(1u, desc.samples)            }
+{
+    MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
+    {
+        texDesc.textureType         = MTTypes::Map(desc.type);
+        texDesc.pixelFormat         = MTTypes::Map(desc.format);
+        texDesc.width               = std::max(1u, desc.extent.width);
+        texDesc.height              = (desc.type == TextureType::Texture1D || desc.type == TextureType::Texture1DArray ? 1u : std::max(1u, desc.extent.height));
+        texDesc.depth               = (desc.type == TextureType::Texture3D ? std::max(1u, desc.extent.depth) : 1u);
+        texDesc.mipmapLevelCount    = numMipLevels_;
+        texDesc.sampleCount         = (IsMultiSampleTexture(desc.type) ? samples_ : 1u);
+        texDesc.arrayLength         = (IsCubeTexture(desc.type) ? numArrayLayers_ / 6 : (IsArrayTexture(desc.type) ? numArrayLayers_ : 1u));
+        texDesc.usage               = GetMTLTextureUsage(desc.flags);
+    }
+    texture_ = heapAllocator.NewTexture(texDesc);
+    [texDesc release];
+}
+
+MTTexture::MTTexture(const MTTexture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture         { desc.type                          },
+    format_         { desc.format                        },
+    numMipLevels_   { desc.subresource.numMipLevels      },
+    numArrayLayers_ { desc.subresource.numArrayLayers    },
+    samples_        { sharedTexture.samples_             }
+{
+    /* Store parameters of the subresource this view refers to */
+    const auto& sharedExtent = sharedTexture.GetExtent();
+    extent_.width   = std::max(1u, sharedExtent.width  >> desc.subresource.baseMipLevel);
+    extent_.height  = std::max(1u, sharedExtent.height >> desc.subresource.baseMipLevel);
+    extent_.depth   = std::max(1u, sharedExtent.depth  >> desc.subresource.baseMipLevel);
+
+    /* Create texture view with component swizzle */
+    auto levels = NSMakeRange(desc.subresource.baseMipLevel, desc.subresource.numMipLevels);
+    auto slices = NSMakeRange(desc.subresource.baseArrayLayer, desc.subresource.numArrayLayers);
+
+    #if defined(__MAC_10_15) || defined(__IPHONE_13_0)
+    if (@available(macOS 10.15, iOS 13.0, *))
+    {
+        MTLTextureSwizzleChannels swizzle = MTLTextureSwizzleChannelsMake(
+            MTTypes::Map(desc.swizzle.r),
+            MTTypes::Map(desc.swizzle.g),
+            MTTypes::Map(desc.swizzle.b),
+            MTTypes::Map(desc.swizzle.a)
+        );
+        texture_ = [sharedTexture.GetNative()
+            newTextureViewWithPixelFormat:  MTTypes::Map(desc.format)
+            textureType:                    MTTypes::Map(desc.type)
+            levels:                         levels
+            slices:                         slices
+            swizzle:                        swizzle
+        ];
+    }
+    else
+    #endif
+    {
+        texture_ = [sharedTexture.GetNative()
+            newTextureViewWithPixelFormat:  MTTypes::Map(desc.format)
+            textureType:                    MTTypes::Map(desc.type)
+            levels:                         levels
+            slices:                         slices
+        ];
+    }
+
+    MTThrowIfCreateFailed(texture_, "MTLTexture");
+}
+
+MTTexture::~MTTexture()
+{
+    [texture_ release];
+}
+
+Extent3D MTTexture::QueryMipExtent(std::uint32_t mipLevel) const
+{
+    switch (GetType())
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return
+            {
+                std::max(1u, extent_.width  >> mipLevel),
+                numArrayLayers_,
+                1u
+            };
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            return
+            {
+                std::max(1u, extent_.width  >> mipLevel),
+                std::max(1u, extent_.height >> mipLevel),
+                numArrayLayers_
+            };
+
+        case TextureType::Texture3D:
+            return
+            {
+                std::max(1u, extent_.width  >> mipLevel),
+                std::max(1u, extent_.height >> mipLevel),
+                std::max(1u, extent_.depth  >> mipLevel)
+            };
+    }
+    return { 0u, 0u, 0u };
+}
+
+TextureDescriptor MTTexture::QueryDesc() const
+{
+    TextureDescriptor texDesc;
+
+    texDesc.type        = GetType();
+    texDesc.format      = format_;
+    texDesc.flags       = 0;
+    texDesc.mipLevels   = numMipLevels_;
+
+    switch (texDesc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            texDesc.extent.width    = extent_.width;
+            texDesc.arrayLayers     = numArrayLayers_;
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            texDesc.extent.width    = extent_.width;
+            texDesc.extent.height   = extent_.height;
+            texDesc.arrayLayers     = numArrayLayers_;
+            break;
+
+        case TextureType::Texture3D:
+            texDesc.extent          = extent_;
+            break;
+
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            texDesc.extent.width    = extent_.width;
+            texDesc.extent.height   = extent_.height;
+            texDesc.arrayLayers     = numArrayLayers_;
+            texDesc.samples         = samples_;
+            texDesc.flags           |= TextureFlags::FixedSamples;
+            break;
+    }
+
+    return texDesc;
+}
+
+void MTTexture::SetName(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    /* Texture views are distinct MTLTexture objects, so this never renames the shared texture */
+    [texture_ setLabel:(name != nullptr ? [NSString stringWithUTF8String:name] : nil)];
+    #endif
+}
+
+void MTTexture::GetSubresourceRegion(
+    const Offset3D& offset,
+    const Extent3D& extent,
+    MTLOrigin&      origin,
+    MTLSize&        size,
+    NSUInteger&     firstSlice,
+    NSUInteger&     numSlices) const
+{
+    switch (GetType())
+    {
+        case TextureType::Texture1DArray:
+            firstSlice  = static_cast<NSUInteger>(offset.y);
+            numSlices   = extent.height;
+            origin      = MTLOriginMake(static_cast<NSUInteger>(offset.x), 0, 0);
+            size        = MTLSizeMake(extent.width, 1, 1);
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray: /*pass*/
+        case TextureType::Texture2DMSArray:
+            firstSlice  = static_cast<NSUInteger>(offset.z);
+            numSlices   = extent.depth;
+            origin      = MTLOriginMake(static_cast<NSUInteger>(offset.x), static_cast<NSUInteger>(offset.y), 0);
+            size        = MTLSizeMake(extent.width, extent.height, 1);
+            break;
+
+        default:
+            firstSlice  = 0;
+            numSlices   = 1;
+            origin      = MTLOriginMake(static_cast<NSUInteger>(offset.x), static_cast<NSUInteger>(offset.y), static_cast<NSUInteger>(offset.z));
+            size        = MTLSizeMake(extent.width, extent.height, extent.depth);
+            break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,137 @@
+/*
+ * MipChain.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MipChain.h"
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+// Returns the specified extent shifted by the MIP level (but at least 1)
+static std::uint32_t MipExtent(std::uint32_t extent, std::uint32_t mipLevel)
+{
+    return std::max(1u, extent >> mipLevel);
+}
+
+Extent3D GetMipExtent(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    const auto& extent = textureDesc.extent;
+    switch (textureDesc.type)
+    {
+        case TextureType::Texture1D:
+            return { MipExtent(extent.width, mipLevel), 1u, 1u };
+
+        case TextureType::Texture1DArray:
+            return { MipExtent(extent.width, mipLevel), textureDesc.arrayLayers, 1u };
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DMS:
+            return { MipExtent(extent.width, mipLevel), MipExtent(extent.height, mipLevel), 1u };
+
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            return { MipExtent(extent.width, mipLevel), MipExtent(extent.height, mipLevel), textureDesc.arrayLayers };
+
+        case TextureType::Texture3D:
+            return { MipExtent(extent.width, mipLevel), MipExtent(extent.height, mipLevel), MipExtent(extent.depth, mipLevel) };
+    }
+    return { 0u, 0u, 0u };
+}
+
+std::uint32_t NumMipChainLevels(const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc)
+{
+    if (imageDesc.mipLevels > 1 && !IsMultiSampleTexture(textureDesc.type))
+        return std::min(imageDesc.mipLevels, NumMipLevels(textureDesc));
+    else
+        return 1u;
+}
+
+// Returns the size (in bytes) of the specified MIP level within the MIP-map chain
+static std::size_t GetMipChainLevelSize(const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc, std::uint32_t mipLevel)
+{
+    const auto extent = GetMipExtent(textureDesc, mipLevel);
+    if (IsCompressedFormat(textureDesc.format))
+        return TextureBufferSize(textureDesc.format, extent);
+    else
+        return ImageDataSize(imageDesc.format, imageDesc.dataType, extent.width * extent.height * extent.depth);
+}
+
+SrcImageDescriptor GetMipChainLevel(const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc, std::uint32_t mipLevel)
+{
+    if (imageDesc.mipLevels <= 1 && mipLevel == 0)
+        return imageDesc;
+
+    /* Accumulate the sizes of all preceding MIP levels */
+    std::size_t offset = 0;
+    for (std::uint32_t i = 0; i < mipLevel; ++i)
+        offset += GetMipChainLevelSize(textureDesc, imageDesc, i);
+
+    const auto size = GetMipChainLevelSize(textureDesc, imageDesc, mipLevel);
+
+    if (mipLevel >= imageDesc.mipLevels || (imageDesc.dataSize != 0 && offset + size > imageDesc.dataSize))
+        throw std::invalid_argument("image data size is too small for MIP-map level " + std::to_string(mipLevel) + " of MIP-map chain");
+
+    /* Return descriptor of the single MIP level */
+    SrcImageDescriptor mipImageDesc = imageDesc;
+    {
+        mipImageDesc.data       = (reinterpret_cast<const char*>(imageDesc.data) + offset);
+        mipImageDesc.dataSize   = size;
+        mipImageDesc.mipLevels  = 1;
+    }
+    return mipImageDesc;
+}
+
+SubTextureDescriptor GetSubTextureForImage(const TextureDescriptor& textureDesc, const TextureSubresourceImage& image)
+{
+    SubTextureDescriptor subTextureDesc;
+    {
+        subTextureDesc.mipLevel = image.mipLevel;
+
+        const auto& extent  = textureDesc.extent;
+        const auto  width   = MipExtent(extent.width,  image.mipLevel);
+        const auto  height  = MipExtent(extent.height, image.mipLevel);
+        const auto  depth   = MipExtent(extent.depth,  image.mipLevel);
+        const auto  layer   = static_cast<std::int32_t>(image.baseArrayLayer);
+
+        switch (textureDesc.type)
+        {
+            case TextureType::Texture1D:
+                subTextureDesc.extent = { width, 1, 1 };
+                break;
+            case TextureType::Texture1DArray:
+                subTextureDesc.offset = { 0, layer, 0 };
+                subTextureDesc.extent = { width, image.numArrayLayers, 1 };
+                break;
+            case TextureType::Texture3D:
+                subTextureDesc.extent = { width, height, depth };
+                break;
+            case TextureType::TextureCube:
+            case TextureType::Texture2DArray:
+            case TextureType::TextureCubeArray:
+                subTextureDesc.offset = { 0, 0, layer };
+                subTextureDesc.extent = { width, height, image.numArrayLayers };
+                break;
+            default:
+                subTextureDesc.extent = { width, height, 1 };
+                break;
+        }
+    }
+    return subTextureDesc;
+}
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * MipChain.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MIP_CHAIN_H
+#define LLGL_MIP_CHAIN_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Helper functions for initial image data that contains an entire MIP-map chain (see SrcImageDescriptor::mipLevels).
+All MIP levels are tightly packed one after another, beginning with the first MIP level,
+and each MIP level contains all array layers (or cube faces) of that level.
+*/
+
+// Returns the extent of the specified MIP level of a texture with the specified descriptor (including the array layers, like Texture::QueryMipExtent).
+Extent3D GetMipExtent(const TextureDescriptor& textureDesc, std::uint32_t mipLevel);
+
+// Returns the number of MIP levels that are to be initialized from the specified image descriptor (at least 1).
+std::uint32_t NumMipChainLevels(const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc);
+
+/*
+Returns the image descriptor of the specified MIP level within the MIP-map chain of the specified image descriptor.
+If the image descriptor does not contain a MIP-map chain, it is returned unmodified for the first MIP level.
+Throws std::invalid_argument if the image data size is too small for the specified MIP level.
+*/
+SrcImageDescriptor GetMipChainLevel(const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc, std::uint32_t mipLevel);
+
+// Returns the sub-texture descriptor that covers the specified sub-resource image of a texture with the specified descriptor.
+SubTextureDescriptor GetSubTextureForImage(const TextureDescriptor& textureDesc, const TextureSubresourceImage& image);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
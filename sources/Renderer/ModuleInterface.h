@@ -13,25 +13,60 @@
 #include <LLGL/Export.h>
 
 
+/*
+Returns the name of a module interface procedure.
+Static libraries append the module name, so that several render systems can be linked into the same binary.
+Shared libraries use the plain name, since each module is loaded with its own symbol table.
+*/
+#ifdef LLGL_BUILD_STATIC_LIB
+#   define LLGL_MODULE_PROC(NAME, MODULE) LLGL_RenderSystem_##NAME##_##MODULE
+#else
+#   define LLGL_MODULE_PROC(NAME, MODULE) LLGL_RenderSystem_##NAME
+#endif
+
+// Declares all interface procedures of the specified render system module.
+#define LLGL_DECL_MODULE_INTERFACE(MODULE)                                                  \
+    LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, MODULE)();                                    \
+    LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, MODULE)();                                 \
+    LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, MODULE)();                               \
+    LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, MODULE)(const void* renderSystemDesc)
+
 extern "C"
 {
 
 /*
+Each render system module implements these procedures:
+
+LLGL_RenderSystem_BuildID:
 Returns the build ID number of the render system.
 This depends on the type and version of the used compiler, the debug/release mode, and an internal build version.
 The returned value must be equal to the value of the LLGL_BUILD_ID macro.
 Otherwise the render system might not be loaded correctly.
+
+LLGL_RenderSystem_RendererID:
+Returns the renderer ID (see LLGL::RendererID).
+
+LLGL_RenderSystem_Name:
+Returns the name of this render system module.
+
+LLGL_RenderSystem_Alloc:
+Returns a raw pointer to the allocated render system (allocated with "new" keyword)
 */
-LLGL_EXPORT int LLGL_RenderSystem_BuildID();
 
-// Returns the renderer ID (see LLGL::RendererID).
-LLGL_EXPORT int LLGL_RenderSystem_RendererID();
+#ifdef LLGL_BUILD_STATIC_LIB
+
+LLGL_DECL_MODULE_INTERFACE( OpenGL     );
+LLGL_DECL_MODULE_INTERFACE( OpenGLES3  );
+LLGL_DECL_MODULE_INTERFACE( Vulkan     );
+LLGL_DECL_MODULE_INTERFACE( Direct3D11 );
+LLGL_DECL_MODULE_INTERFACE( Direct3D12 );
+LLGL_DECL_MODULE_INTERFACE( Metal      );
+
+#else
 
-// Returns the name of this render system module.
-LLGL_EXPORT const char* LLGL_RenderSystem_Name();
+LLGL_DECL_MODULE_INTERFACE( Shared );
 
-// Returns a raw pointer to the allocated render system (allocated with "new" keyword)
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc);
+#endif // /LLGL_BUILD_STATIC_LIB
 
 } // /extern "C"
 
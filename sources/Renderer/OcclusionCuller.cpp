@@ -0,0 +1,96 @@
+/*
+ * OcclusionCuller.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/OcclusionCuller.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+OcclusionCuller::OcclusionCuller(RenderSystem& renderSystem, const OcclusionCullerDescriptor& desc) :
+    renderSystem_ { renderSystem    },
+    numObjects_   { desc.numObjects },
+    mode_         { desc.mode       }
+{
+    if (desc.numObjects == 0)
+        throw std::invalid_argument("cannot create occlusion culler with zero objects");
+
+    /* Create query heap with boolean results, so each query can be used as render condition */
+    QueryHeapDescriptor queryHeapDesc;
+    {
+        queryHeapDesc.type          = (desc.conservative ? QueryType::AnySamplesPassedConservative : QueryType::AnySamplesPassed);
+        queryHeapDesc.numQueries    = desc.numObjects;
+    }
+    queryHeap_ = renderSystem_.CreateQueryHeap(queryHeapDesc);
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    renderSystem_.Release(*queryHeap_);
+}
+
+void OcclusionCuller::BeginTest(CommandBuffer& commandBuffer, std::uint32_t object)
+{
+    AssertObjectRange(object, 1);
+    commandBuffer.BeginQuery(*queryHeap_, object);
+}
+
+void OcclusionCuller::EndTest(CommandBuffer& commandBuffer, std::uint32_t object)
+{
+    AssertObjectRange(object, 1);
+    commandBuffer.EndQuery(*queryHeap_, object);
+}
+
+void OcclusionCuller::BeginConditionalDraw(CommandBuffer& commandBuffer, std::uint32_t object)
+{
+    AssertObjectRange(object, 1);
+    commandBuffer.BeginRenderCondition(*queryHeap_, object, mode_);
+}
+
+void OcclusionCuller::EndConditionalDraw(CommandBuffer& commandBuffer)
+{
+    commandBuffer.EndRenderCondition();
+}
+
+void OcclusionCuller::ResolveVisibility(CommandBuffer& commandBuffer, Buffer& dstBuffer, std::uint64_t dstOffset)
+{
+    commandBuffer.ResolveQueries(*queryHeap_, 0, numObjects_, dstBuffer, dstOffset);
+}
+
+bool OcclusionCuller::QueryVisibility(CommandBuffer& commandBuffer, std::uint32_t firstObject, std::uint32_t numObjects, std::uint64_t* visibility)
+{
+    AssertObjectRange(firstObject, numObjects);
+    return commandBuffer.QueryResults(*queryHeap_, firstObject, numObjects, visibility);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void OcclusionCuller::AssertObjectRange(std::uint32_t firstObject, std::uint32_t numObjects) const
+{
+    if (firstObject + numObjects > numObjects_)
+    {
+        throw std::out_of_range(
+            "occlusion culler object range [" + std::to_string(firstObject) + ", " + std::to_string(firstObject + numObjects) +
+            ") exceeds number of objects (" + std::to_string(numObjects_) + ")"
+        );
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -10,12 +10,16 @@
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
+#include <cstring>
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
+const std::uint32_t GLBuffer::numRingRegions;
+
 GLBuffer::GLBuffer(const BufferType type) :
     Buffer { type }
 {
@@ -31,12 +35,194 @@ GLBuffer::GLBuffer(const BufferType type) :
         /* Creates a new GL buffer object (must be bound to a target before it can be used) */
         glGenBuffers(1, &id_);
     }
+
+    /* Names of buffers that have been deleted in other (shared) GL contexts can be reused, so the binding of that name might be out of date */
+    GLStateManager::active->NotifyBufferRelease(id_, GLStateManager::GetBufferTarget(GetType()));
 }
 
 GLBuffer::~GLBuffer()
 {
     glDeleteBuffers(1, &id_);
     GLStateManager::active->NotifyBufferRelease(id_, GLStateManager::GetBufferTarget(GetType()));
+
+    if (counterID_ != 0)
+    {
+        glDeleteBuffers(1, &counterID_);
+        GLStateManager::active->NotifyBufferRelease(counterID_, GLBufferTarget::ATOMIC_COUNTER_BUFFER);
+    }
+
+    #ifdef GL_ARB_transform_feedback2
+    if (transformFeedbackID_ != 0)
+    {
+        glDeleteTransformFeedbacks(1, &transformFeedbackID_);
+        GLStateManager::active->NotifyTransformFeedbackRelease(transformFeedbackID_);
+    }
+    #endif
+}
+
+void GLBuffer::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+    {
+        /* Set or reset label of the GL object (a length of -1 denotes a null-terminated string) */
+        glObjectLabel(GL_BUFFER, GetID(), -1, name);
+    }
+    #endif
+}
+
+void GLBuffer::InitPersistentRing(GLsizeiptr regionSize, GLsizeiptr regionStride, void* mappedData)
+{
+    mappedData_     = reinterpret_cast<char*>(mappedData);
+    regionSize_     = regionSize;
+    regionStride_   = regionStride;
+    currentRegion_  = 0;
+}
+
+char* GLBuffer::MapNextRegion(GLintptr writeOffset, GLsizeiptr writeSize)
+{
+    auto prevData = mappedData_ + GetRegionOffset();
+
+    /* Mark the end of all GPU commands that read from the current region */
+    regionFences_[currentRegion_].Submit();
+
+    /* Advance to next region and wait until the GPU is done with it (it was used two updates ago) */
+    currentRegion_ = (currentRegion_ + 1) % numRingRegions;
+    regionFences_[currentRegion_].Wait(~0ull);
+
+    auto nextData = mappedData_ + GetRegionOffset();
+
+    /* Preserve content outside of the written range */
+    if (writeOffset > 0)
+        std::memcpy(nextData, prevData, static_cast<std::size_t>(writeOffset));
+
+    auto writeEnd = writeOffset + writeSize;
+    if (writeEnd < regionSize_)
+        std::memcpy(nextData + writeEnd, prevData + writeEnd, static_cast<std::size_t>(regionSize_ - writeEnd));
+
+    return nextData;
+}
+
+char* GLBuffer::MapCurrentRegion()
+{
+    regionFences_[currentRegion_].Submit();
+    regionFences_[currentRegion_].Wait(~0ull);
+    return mappedData_ + GetRegionOffset();
+}
+
+void GLBuffer::InitStreamingRing(GLsizeiptr regionSize, GLsizeiptr regionStride, const void* initialData)
+{
+    regionSize_     = regionSize;
+    regionStride_   = regionStride;
+    currentRegion_  = 0;
+
+    shadow_.resize(static_cast<std::size_t>(regionSize));
+    if (initialData)
+        std::memcpy(shadow_.data(), initialData, shadow_.size());
+}
+
+void GLBuffer::WriteNextStreamingRegion(const void* data, GLintptr offset, GLsizeiptr size)
+{
+    #ifdef GL_ARB_map_buffer_range
+
+    /* Merge written range into the shadow, so the content outside of that range is preserved */
+    if (data != nullptr)
+        std::memcpy(&shadow_[static_cast<std::size_t>(offset)], data, static_cast<std::size_t>(size));
+
+    /* Mark the end of all GPU commands that read from the current region */
+    regionFences_[currentRegion_].Submit();
+    regionsPending_[currentRegion_] = true;
+
+    /* Advance to next region */
+    currentRegion_ = (currentRegion_ + 1) % numRingRegions;
+
+    const auto target = GLTypes::Map(GetType());
+    GLStateManager::active->BindBuffer(*this);
+
+    if (regionsPending_[currentRegion_] && !regionFences_[currentRegion_].Wait(0))
+    {
+        /* Orphan entire buffer, so the driver allocates new storage while the GPU still reads from the old one */
+        glBufferData(target, regionStride_ * static_cast<GLsizeiptr>(numRingRegions), nullptr, GL_STREAM_DRAW);
+        for (auto& pending : regionsPending_)
+            pending = false;
+    }
+
+    /* Write shadow into the new region without implicit synchronization, since the GPU is done with it */
+    auto dst = glMapBufferRange(
+        target,
+        GetRegionOffset(),
+        regionSize_,
+        (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)
+    );
+
+    if (!dst)
+        throw std::runtime_error("failed to map region of GL streaming buffer");
+
+    std::memcpy(dst, shadow_.data(), shadow_.size());
+    glUnmapBuffer(target);
+
+    #endif // /GL_ARB_map_buffer_range
+}
+
+char* GLBuffer::MapStreamingShadow(bool writeAccess)
+{
+    shadowWriteMapped_ = writeAccess;
+    return shadow_.data();
+}
+
+void GLBuffer::UnmapStreamingShadow()
+{
+    if (shadowWriteMapped_)
+    {
+        WriteNextStreamingRegion(nullptr, 0, 0);
+        shadowWriteMapped_ = false;
+    }
+}
+
+void GLBuffer::CreateCounter()
+{
+    #ifdef GL_ARB_shader_atomic_counters
+    if (counterID_ != 0)
+        return;
+
+    if (!HasExtension(GLExt::ARB_shader_atomic_counters))
+        throw std::runtime_error("OpenGL extension 'GL_ARB_shader_atomic_counters' is required for append and consume storage buffers");
+
+    const GLuint initialValue = 0;
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glCreateBuffers(1, &counterID_);
+        glNamedBufferData(counterID_, sizeof(initialValue), &initialValue, GL_DYNAMIC_DRAW);
+    }
+    else
+    #endif
+    {
+        glGenBuffers(1, &counterID_);
+        GLStateManager::active->BindBuffer(GLBufferTarget::ATOMIC_COUNTER_BUFFER, counterID_);
+        glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(initialValue), &initialValue, GL_DYNAMIC_DRAW);
+    }
+    #else
+    throw std::runtime_error("append and consume storage buffers are not supported by this OpenGL version");
+    #endif
+}
+
+void GLBuffer::CreateTransformFeedback()
+{
+    #ifdef GL_ARB_transform_feedback2
+    if (transformFeedbackID_ == 0)
+    {
+        glGenTransformFeedbacks(1, &transformFeedbackID_);
+        GLStateManager::active->NotifyTransformFeedbackRelease(transformFeedbackID_);
+    }
+    #endif
+}
+
+void GLBuffer::SetStreamOutputSource(GLuint transformFeedbackID, GLuint stream)
+{
+    streamOutputSourceID_       = transformFeedbackID;
+    streamOutputSourceStream_   = stream;
 }
 
 
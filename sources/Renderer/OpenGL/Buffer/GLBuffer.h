@@ -11,6 +11,8 @@
 
 #include <LLGL/Buffer.h>
 #include "../OpenGL.h"
+#include "../RenderState/GLFence.h"
+#include <vector>
 
 
 namespace LLGL
@@ -25,15 +27,144 @@ class GLBuffer : public Buffer
         GLBuffer(const BufferType type);
         ~GLBuffer();
 
+        void SetName(const char* name) override;
+
+        // Number of regions of a persistently mapped or streaming ring buffer (triple buffering).
+        static const std::uint32_t numRingRegions = 3;
+
+        // Initializes this buffer as persistently mapped ring with 'numRingRegions' regions.
+        void InitPersistentRing(GLsizeiptr regionSize, GLsizeiptr regionStride, void* mappedData);
+
+        /*
+        Advances to the next region of the persistently mapped ring and waits until the GPU has finished reading from it.
+        The content outside of the range [writeOffset, writeOffset + writeSize) is copied from the previous region.
+        Returns the pointer to the beginning of the new region.
+        */
+        char* MapNextRegion(GLintptr writeOffset, GLsizeiptr writeSize);
+
+        // Submits the fence of the current region and waits for it, so the CPU can read the data written by the GPU.
+        char* MapCurrentRegion();
+
+        /*
+        Initializes this buffer as streaming ring with 'numRingRegions' regions in mutable storage (without GL_ARB_buffer_storage, e.g. for OpenGL ES 3).
+        The storage must have been allocated with 'numRingRegions * regionStride' bytes before.
+        */
+        void InitStreamingRing(GLsizeiptr regionSize, GLsizeiptr regionStride, const void* initialData);
+
+        /*
+        Merges the specified data into the CPU shadow of the streaming ring and writes the entire shadow into the next region.
+        The region is mapped with GL_MAP_INVALIDATE_RANGE_BIT and GL_MAP_UNSYNCHRONIZED_BIT, since its fence guarantees that the GPU is done with it.
+        If the GPU is still reading from the next region, the entire buffer is orphaned with glBufferData(NULL) instead of waiting for it.
+        */
+        void WriteNextStreamingRegion(const void* data, GLintptr offset, GLsizeiptr size);
+
+        // Returns the CPU shadow of the streaming ring. With write access, the shadow is written into the next region by UnmapStreamingShadow.
+        char* MapStreamingShadow(bool writeAccess);
+
+        // Writes the CPU shadow into the next region of the streaming ring if it was mapped with write access.
+        void UnmapStreamingShadow();
+
+        // Creates the atomic counter buffer for the hidden counter of an append or consume storage buffer, initialized with zero.
+        void CreateCounter();
+
+        // Creates the transform feedback object of a stream-output buffer (requires GL_ARB_transform_feedback2).
+        void CreateTransformFeedback();
+
+        /*
+        Stores the transform feedback object and vertex stream this buffer has been captured with,
+        so it can be drawn with the GPU-recorded vertex count (see GLCommandBuffer::DrawStreamOutput).
+        */
+        void SetStreamOutputSource(GLuint transformFeedbackID, GLuint stream);
+
         // Returns the hardware buffer ID.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns the ID of the atomic counter buffer, or 0 if this buffer has no hidden counter.
+        inline GLuint GetCounterID() const
+        {
+            return counterID_;
+        }
+
+        // Returns the ID of the transform feedback object of this stream-output buffer, or 0 if GL_ARB_transform_feedback2 is not supported.
+        inline GLuint GetTransformFeedbackID() const
+        {
+            return transformFeedbackID_;
+        }
+
+        // Returns the ID of the transform feedback object this buffer has last been captured with.
+        inline GLuint GetStreamOutputSourceID() const
+        {
+            return streamOutputSourceID_;
+        }
+
+        // Returns the vertex stream this buffer has last been captured with.
+        inline GLuint GetStreamOutputSourceStream() const
+        {
+            return streamOutputSourceStream_;
+        }
+
+        // Returns true if this buffer is a persistently mapped ring.
+        inline bool IsPersistentRing() const
+        {
+            return (mappedData_ != nullptr);
+        }
+
+        // Returns true if this buffer is a streaming ring in mutable storage.
+        inline bool IsStreamingRing() const
+        {
+            return (!shadow_.empty());
+        }
+
+        // Returns true if this buffer is either a persistently mapped ring or a streaming ring, i.e. it must be bound with its region offset.
+        inline bool IsRing() const
+        {
+            return (regionSize_ > 0);
+        }
+
+        // Returns the offset (in bytes) of the current region. This is always 0 if the buffer is not a ring.
+        inline GLintptr GetRegionOffset() const
+        {
+            return static_cast<GLintptr>(currentRegion_) * regionStride_;
+        }
+
+        // Returns the size (in bytes) of each region.
+        inline GLsizeiptr GetRegionSize() const
+        {
+            return regionSize_;
+        }
+
+        // Returns the distance (in bytes) between two regions.
+        inline GLsizeiptr GetRegionStride() const
+        {
+            return regionStride_;
+        }
+
+        // Returns the index of the current region.
+        inline std::uint32_t GetCurrentRegion() const
+        {
+            return currentRegion_;
+        }
+
     private:
 
-        GLuint id_ = 0;
+        GLuint              id_                             = 0;
+        GLuint              counterID_                      = 0;                // Atomic counter buffer of an append or consume storage buffer
+        GLuint              transformFeedbackID_            = 0;                // Transform feedback object of a stream-output buffer
+        GLuint              streamOutputSourceID_           = 0;
+        GLuint              streamOutputSourceStream_       = 0;
+
+        char*               mappedData_                     = nullptr;
+        GLsizeiptr          regionSize_                     = 0;
+        GLsizeiptr          regionStride_                   = 0;
+        std::uint32_t       currentRegion_                  = 0;
+        GLFence             regionFences_[numRingRegions];
+
+        std::vector<char>   shadow_;                                            // CPU shadow of a streaming ring
+        bool                regionsPending_[numRingRegions] = {};               // Regions of a streaming ring whose fences refer to the current storage
+        bool                shadowWriteMapped_              = false;
 
 };
 
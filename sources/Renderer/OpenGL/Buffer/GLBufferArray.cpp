@@ -36,8 +36,13 @@ void GLBufferArray::BuildArray(std::uint32_t numBuffers, Buffer* const * bufferA
     /* Store the ID of each GLBuffer inside the array */
     idArray_.clear();
     idArray_.reserve(numBuffers);
+    bufferArray_.clear();
+    bufferArray_.reserve(numBuffers);
     while (auto next = NextArrayResource<GLBuffer>(numBuffers, bufferArray))
+    {
         idArray_.push_back(next->GetID());
+        bufferArray_.push_back(next);
+    }
 }
 
 
@@ -20,6 +20,7 @@ namespace LLGL
 
 
 class Buffer;
+class GLBuffer;
 
 class GLBufferArray : public BufferArray
 {
@@ -35,13 +36,20 @@ class GLBufferArray : public BufferArray
             return idArray_;
         }
 
+        // Returns the array of buffers, e.g. to determine the stream index of each stream-output buffer.
+        inline const std::vector<GLBuffer*>& GetBufferArray() const
+        {
+            return bufferArray_;
+        }
+
     protected:
 
         void BuildArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
 
     private:
 
-        std::vector<GLuint> idArray_;
+        std::vector<GLuint>     idArray_;
+        std::vector<GLBuffer*>  bufferArray_;
 
 };
 
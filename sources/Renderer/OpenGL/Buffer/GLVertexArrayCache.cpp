@@ -0,0 +1,101 @@
+/*
+ * GLVertexArrayCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLVertexArrayCache.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionLoader.h"
+#include "../RenderState/GLStateManager.h"
+
+
+namespace LLGL
+{
+
+
+// Returns true if all attributes of the specified vertex format have the same instance divisor.
+static bool HasUniformInstanceDivisor(const VertexFormat& format)
+{
+    for (const auto& attrib : format.attributes)
+    {
+        if (attrib.instanceDivisor != format.attributes.front().instanceDivisor)
+            return false;
+    }
+    return true;
+}
+
+// Returns the key of the specified vertex formats, which contains everything a format-only VAO depends on (but not the vertex strides).
+static std::vector<std::uint32_t> GetVertexArrayKey(std::uint32_t numFormats, const VertexFormat* const * formats)
+{
+    std::vector<std::uint32_t> key;
+
+    for (std::uint32_t i = 0; i < numFormats; ++i)
+    {
+        const auto& attribs = formats[i]->attributes;
+
+        key.push_back(static_cast<std::uint32_t>(attribs.size()));
+        key.push_back(attribs.empty() ? 0u : attribs.front().instanceDivisor);
+
+        for (const auto& attrib : attribs)
+        {
+            key.push_back(static_cast<std::uint32_t>(attrib.format));
+            key.push_back(attrib.offset);
+        }
+    }
+
+    return key;
+}
+
+std::shared_ptr<GLVertexArrayObject> GLVertexArrayCache::GetVertexArray(std::uint32_t numFormats, const VertexFormat* const * formats)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    if (!HasExtension(GLExt::ARB_vertex_attrib_binding))
+        return nullptr;
+
+    for (std::uint32_t i = 0; i < numFormats; ++i)
+    {
+        if (!HasUniformInstanceDivisor(*formats[i]))
+            return nullptr;
+    }
+
+    /* Return shared VAO if it is still in use by other buffers */
+    auto& entry = vertexArrays_[GetVertexArrayKey(numFormats, formats)];
+
+    if (auto vao = entry.lock())
+        return vao;
+
+    /* Build new VAO with one vertex buffer binding point per vertex format */
+    auto vao = std::make_shared<GLVertexArrayObject>();
+
+    for (std::uint32_t binding = 0, index = 0; binding < numFormats; ++binding)
+    {
+        const auto& attribs = formats[binding]->attributes;
+
+        for (const auto& attrib : attribs)
+            vao->BuildVertexAttributeFormat(attrib, index++, binding);
+
+        if (!attribs.empty())
+            vao->BuildBindingDivisor(binding, attribs.front().instanceDivisor);
+    }
+    GLVertexArrayObject::FinishBuild();
+
+    entry = vao;
+
+    return vao;
+
+    #else
+
+    return nullptr;
+
+    #endif // /GL_ARB_vertex_attrib_binding
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,56 @@
+/*
+ * GLVertexArrayCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_VERTEX_ARRAY_CACHE_H
+#define LLGL_GL_VERTEX_ARRAY_CACHE_H
+
+
+#include <LLGL/VertexFormat.h>
+#include "GLVertexArrayObject.h"
+#include <memory>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Cache of vertex-array-objects (VAOs) that only specify vertex formats but no vertex buffers (GL_ARB_vertex_attrib_binding).
+All vertex buffers and vertex buffer arrays with the same vertex formats share one VAO,
+and their buffers are bound to the binding points of that VAO with a single 'glBindVertexBuffers' call.
+Each VAO is deleted as soon as the last buffer that refers to it has been released.
+*/
+class GLVertexArrayCache
+{
+
+    public:
+
+        /*
+        Returns the shared VAO for the specified vertex formats, where each format refers to the vertex buffer binding point of the same index.
+        Returns null if VAOs cannot be separated from their vertex buffers, i.e. GL_ARB_vertex_attrib_binding is not supported
+        or the attributes of a vertex format have different instance divisors (which are specified per binding point).
+        */
+        std::shared_ptr<GLVertexArrayObject> GetVertexArray(std::uint32_t numFormats, const VertexFormat* const * formats);
+
+    private:
+
+        std::map<std::vector<std::uint32_t>, std::weak_ptr<GLVertexArrayObject>> vertexArrays_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -12,15 +12,51 @@
 #include "../RenderState/GLStateManager.h"
 #include "../../GLCommon/GLTypes.h"
 #include "../../GLCommon/GLCore.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 
 
 namespace LLGL
 {
 
 
+/*
+Returns true if the specified format is a packed format and stores the GL data type and number of components for the vertex attribute.
+Packed integer formats are not allowed for 'glVertexAttribIPointer', so they are reported as unsupported.
+*/
+static bool GetPackedVertexAttribFormat(const Format format, GLenum& dataType, GLint& components)
+{
+    switch (format)
+    {
+        case Format::RGB10A2UNorm:
+            dataType    = GL_UNSIGNED_INT_2_10_10_10_REV;
+            components  = 4;
+            return true;
+        case Format::RG11B10Float:
+            dataType    = GL_UNSIGNED_INT_10F_11F_11F_REV;
+            components  = 3;
+            return true;
+        case Format::RGB10A2UInt:
+            ThrowNotSupportedExcept(__FUNCTION__, "integral packed vertex attributes");
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
 GLVertexArrayObject::GLVertexArrayObject()
 {
-    glGenVertexArrays(1, &id_);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create new VAO with initialized state (not required to bind it first) */
+        glCreateVertexArrays(1, &id_);
+    }
+    else
+    #endif
+    {
+        glGenVertexArrays(1, &id_);
+    }
 }
 
 GLVertexArrayObject::~GLVertexArrayObject()
@@ -29,8 +65,23 @@ GLVertexArrayObject::~GLVertexArrayObject()
     GLStateManager::active->NotifyVertexArrayRelease(id_);
 }
 
-void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute, std::uint32_t stride, std::uint32_t index)
+void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute, std::uint32_t stride, std::uint32_t index, GLuint bufferID, GLsizeiptr baseOffset)
 {
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Use a separate binding point for each attribute, so the attribute offset can be specified as offset of the VBO binding */
+        glVertexArrayVertexBuffer(id_, index, bufferID, static_cast<GLintptr>(baseOffset + attribute.offset), static_cast<GLsizei>(stride));
+        glVertexArrayBindingDivisor(id_, index, attribute.instanceDivisor);
+        BuildVertexAttributeFormatDSA(attribute, index, index, 0);
+        return;
+    }
+    #endif
+
+    /* Bind VAO and VBO */
+    GLStateManager::active->BindVertexArray(id_);
+    GLStateManager::active->BindBuffer(GLBufferTarget::ARRAY_BUFFER, bufferID);
+
     /* Enable array index in currently bound VAO */
     glEnableVertexAttribArray(index);
 
@@ -38,16 +89,34 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute,
     if (attribute.instanceDivisor > 0)
         glVertexAttribDivisor(index, attribute.instanceDivisor);
 
+    /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
+    const GLsizeiptr offsetPtrSized = baseOffset + attribute.offset;
+
+    auto isNormalizedFormat = IsNormalizedFormat(attribute.format);
+
+    /* Packed formats are specified with a single data type for all components */
+    GLenum  packedDataType      = 0;
+    GLint   packedComponents    = 0;
+
+    if (GetPackedVertexAttribFormat(attribute.format, packedDataType, packedComponents))
+    {
+        glVertexAttribPointer(
+            index,
+            packedComponents,
+            packedDataType,
+            GLBoolean(isNormalizedFormat),
+            stride,
+            reinterpret_cast<const void*>(offsetPtrSized)
+        );
+        return;
+    }
+
     /* Get data type and components of vector type */
     DataType        dataType    = DataType::Float32;
     std::uint32_t   components  = 0;
     SplitFormat(attribute.format, dataType, components);
 
-    auto isNormalizedFormat = IsNormalizedFormat(attribute.format);
-    auto isFloatFormat      = IsFloatFormat(attribute.format);
-
-    /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
-    const GLsizeiptr offsetPtrSized = attribute.offset;
+    auto isFloatFormat = IsFloatFormat(attribute.format);
 
     /* Use currently bound VBO for VertexAttribPointer functions */
     if (!isNormalizedFormat && !isFloatFormat)
@@ -78,6 +147,121 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute,
     }
 }
 
+void GLVertexArrayObject::BuildVertexAttributeFormat(const VertexAttribute& attribute, std::uint32_t index, std::uint32_t bindingIndex)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        BuildVertexAttributeFormatDSA(attribute, index, bindingIndex, attribute.offset);
+        return;
+    }
+    #endif
+
+    /* Enable array index in VAO */
+    GLStateManager::active->BindVertexArray(id_);
+    glEnableVertexAttribArray(index);
+
+    auto isNormalizedFormat = IsNormalizedFormat(attribute.format);
+
+    /* Packed formats are specified with a single data type for all components */
+    GLenum  packedDataType      = 0;
+    GLint   packedComponents    = 0;
+
+    /* Get data type and components of vector type */
+    DataType        dataType    = DataType::Float32;
+    std::uint32_t   components  = 0;
+    SplitFormat(attribute.format, dataType, components);
+
+    auto isFloatFormat = IsFloatFormat(attribute.format);
+
+    /* Specify attribute format relative to the vertex buffer binding point (instance divisors are specified per binding point) */
+    if (GetPackedVertexAttribFormat(attribute.format, packedDataType, packedComponents))
+        glVertexAttribFormat(index, packedComponents, packedDataType, GLBoolean(isNormalizedFormat), attribute.offset);
+    else if (!isNormalizedFormat && !isFloatFormat)
+        glVertexAttribIFormat(index, components, GLTypes::Map(dataType), attribute.offset);
+    else
+        glVertexAttribFormat(index, components, GLTypes::Map(dataType), GLBoolean(isNormalizedFormat), attribute.offset);
+
+    glVertexAttribBinding(index, bindingIndex);
+
+    #else
+
+    ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_vertex_attrib_binding");
+
+    #endif
+}
+
+void GLVertexArrayObject::BuildBindingDivisor(std::uint32_t bindingIndex, std::uint32_t divisor)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glVertexArrayBindingDivisor(id_, bindingIndex, divisor);
+        return;
+    }
+    #endif
+
+    GLStateManager::active->BindVertexArray(id_);
+    glVertexBindingDivisor(bindingIndex, divisor);
+
+    #else
+
+    ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_vertex_attrib_binding");
+
+    #endif
+}
+
+void GLVertexArrayObject::FinishBuild()
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        return;
+    #endif
+    GLStateManager::active->BindVertexArray(0);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLVertexArrayObject::BuildVertexAttributeFormatDSA(const VertexAttribute& attribute, std::uint32_t index, std::uint32_t bindingIndex, GLuint relativeOffset)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+    /* Enable array index in VAO without binding it */
+    glEnableVertexArrayAttrib(id_, index);
+
+    auto isNormalizedFormat = IsNormalizedFormat(attribute.format);
+
+    /* Packed formats are specified with a single data type for all components */
+    GLenum  packedDataType      = 0;
+    GLint   packedComponents    = 0;
+
+    /* Get data type and components of vector type */
+    DataType        dataType    = DataType::Float32;
+    std::uint32_t   components  = 0;
+    SplitFormat(attribute.format, dataType, components);
+
+    auto isFloatFormat = IsFloatFormat(attribute.format);
+
+    /* Specify attribute format relative to the vertex buffer binding point */
+    if (GetPackedVertexAttribFormat(attribute.format, packedDataType, packedComponents))
+        glVertexArrayAttribFormat(id_, index, packedComponents, packedDataType, GLBoolean(isNormalizedFormat), relativeOffset);
+    else if (!isNormalizedFormat && !isFloatFormat)
+        glVertexArrayAttribIFormat(id_, index, components, GLTypes::Map(dataType), relativeOffset);
+    else
+        glVertexArrayAttribFormat(id_, index, components, GLTypes::Map(dataType), GLBoolean(isNormalizedFormat), relativeOffset);
+
+    glVertexArrayAttribBinding(id_, index, bindingIndex);
+
+    #endif
+}
+
 
 } // /namespace LLGL
 
@@ -25,7 +25,20 @@ class GLVertexArrayObject
         GLVertexArrayObject();
         ~GLVertexArrayObject();
 
-        void BuildVertexAttribute(const VertexAttribute& attribute, std::uint32_t stride, std::uint32_t index);
+        // Builds the specified vertex attribute for the specified VBO. The base offset is added to the attribute offset.
+        void BuildVertexAttribute(const VertexAttribute& attribute, std::uint32_t stride, std::uint32_t index, GLuint bufferID, GLsizeiptr baseOffset = 0);
+
+        // Builds the format of the specified vertex attribute for the specified vertex buffer binding point, independently of any VBO (GL_ARB_vertex_attrib_binding).
+        void BuildVertexAttributeFormat(const VertexAttribute& attribute, std::uint32_t index, std::uint32_t bindingIndex);
+
+        // Sets the instance divisor of the specified vertex buffer binding point (GL_ARB_vertex_attrib_binding).
+        void BuildBindingDivisor(std::uint32_t bindingIndex, std::uint32_t divisor);
+
+        /*
+        Unbinds the VAO that has been bound to build the vertex attributes.
+        This is a no-op with GL_ARB_direct_state_access, since the VAO is never bound to be built.
+        */
+        static void FinishBuild();
 
         //! Returns the ID of the hardware vertex-array-object (VAO)
         inline GLuint GetID() const
@@ -35,6 +48,8 @@ class GLVertexArrayObject
 
     private:
 
+        void BuildVertexAttributeFormatDSA(const VertexAttribute& attribute, std::uint32_t index, std::uint32_t bindingIndex, GLuint relativeOffset);
+
         GLuint id_ = 0; //!< Vertex array object ID.
 
 };
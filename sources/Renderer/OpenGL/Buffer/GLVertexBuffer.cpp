@@ -7,33 +7,66 @@
 
 #include "GLVertexBuffer.h"
 #include "../RenderState/GLStateManager.h"
+#include "../../../Core/Helper.h"
+#include "../../../Core/Exception.h"
 
 
 namespace LLGL
 {
 
 
-GLVertexBuffer::GLVertexBuffer() :
-    GLBuffer { BufferType::Vertex }
+GLVertexBuffer::GLVertexBuffer(const BufferType type) :
+    GLBuffer { type }
 {
 }
 
-void GLVertexBuffer::BuildVertexArray(const VertexFormat& vertexFormat)
+void GLVertexBuffer::BuildVertexArray(const VertexFormat& vertexFormat, GLVertexArrayCache& vertexArrayCache)
 {
-    /* Bind VAO */
-    GLStateManager::active->BindVertexArray(GetVaoID());
+    /* Store vertex format (required if this buffer is used in a buffer array) */
+    vertexFormat_ = vertexFormat;
+
+    /* Share VAO with all buffers of the same vertex format, since the buffer and its region offset are bound separately */
+    const VertexFormat* formats[] = { &vertexFormat };
+    if ((sharedVao_ = vertexArrayCache.GetVertexArray(1, formats)) != nullptr)
+        return;
+
+    /* Rings require one VAO per region, since the vertex attribute offsets differ */
+    const auto numVaos = (IsRing() ? GLBuffer::numRingRegions : 1u);
+    while (vaos_.size() < numVaos)
+        vaos_.emplace_back(MakeUnique<GLVertexArrayObject>());
+
+    for (std::uint32_t region = 0; region < numVaos; ++region)
     {
-        /* Bind VBO */
-        GLStateManager::active->BindBuffer(GLBufferTarget::ARRAY_BUFFER, GetID());
+        auto& vao = *vaos_[region];
+        auto baseOffset = static_cast<GLsizeiptr>(region) * (numVaos > 1 ? GetRegionStride() : 0);
 
         /* Build each vertex attribute */
         for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(vertexFormat.attributes.size()); i < n; ++i)
-            vao_.BuildVertexAttribute(vertexFormat.attributes[i], vertexFormat.stride, i);
+            vao.BuildVertexAttribute(vertexFormat.attributes[i], vertexFormat.stride, i, GetID(), baseOffset);
     }
-    GLStateManager::active->BindVertexArray(0);
+    GLVertexArrayObject::FinishBuild();
+}
 
-    /* Store vertex format (required if this buffer is used in a buffer array) */
-    vertexFormat_ = vertexFormat;
+void GLVertexBuffer::BindVertexArray(GLStateManager& stateMngr) const
+{
+    BindVertexArray(stateMngr, 0);
+}
+
+void GLVertexBuffer::BindVertexArray(GLStateManager& stateMngr, GLintptr offset) const
+{
+    if (sharedVao_)
+    {
+        stateMngr.BindVertexArray(sharedVao_->GetID());
+
+        const GLuint    id          = GetID();
+        const GLintptr  baseOffset  = GetRegionOffset() + offset;
+        const GLsizei   stride      = static_cast<GLsizei>(vertexFormat_.stride);
+        stateMngr.BindVertexBuffers(0, 1, &id, &baseOffset, &stride);
+    }
+    else if (offset == 0)
+        stateMngr.BindVertexArray(GetVaoID());
+    else
+        ThrowNotSupportedExcept(__FUNCTION__, "vertex buffer offsets without shared vertex array (GL_ARB_vertex_attrib_binding)");
 }
 
 
@@ -11,25 +11,40 @@
 
 #include "GLBuffer.h"
 #include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class GLStateManager;
+
 class GLVertexBuffer final : public GLBuffer
 {
 
     public:
 
-        GLVertexBuffer();
+        GLVertexBuffer(const BufferType type = BufferType::Vertex);
+
+        // Builds the VAO for this buffer, or takes a shared format-only VAO from the cache if GL_ARB_vertex_attrib_binding is supported.
+        void BuildVertexArray(const VertexFormat& vertexFormat, GLVertexArrayCache& vertexArrayCache);
+
+        // Binds the VAO of this buffer, and binds this buffer to the shared VAO if there is one.
+        void BindVertexArray(GLStateManager& stateMngr) const;
 
-        void BuildVertexArray(const VertexFormat& vertexFormat);
+        // Binds this buffer with the specified offset (in bytes) to the shared VAO. Throws if there is no shared VAO and the offset is non-zero.
+        void BindVertexArray(GLStateManager& stateMngr, GLintptr offset) const;
 
-        //! Returns the ID of the vertex-array-object (VAO)
+        //! Returns the ID of the vertex-array-object (VAO). For persistently mapped rings, this is the VAO of the current region.
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            if (sharedVao_)
+                return sharedVao_->GetID();
+            else
+                return vaos_[GetCurrentRegion() % vaos_.size()]->GetID();
         }
 
         //! Returns the vertex format.
@@ -40,8 +55,9 @@ class GLVertexBuffer final : public GLBuffer
 
     private:
 
-        GLVertexArrayObject vao_;
-        VertexFormat        vertexFormat_;
+        std::vector<std::unique_ptr<GLVertexArrayObject>>   vaos_;
+        std::shared_ptr<GLVertexArrayObject>                sharedVao_;     // Format-only VAO, where this buffer is bound at binding point 0
+        VertexFormat                                        vertexFormat_;
 
 };
 
@@ -20,28 +20,69 @@ GLVertexBufferArray::GLVertexBufferArray() :
 {
 }
 
-void GLVertexBufferArray::BuildVertexArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+void GLVertexBufferArray::BuildVertexArray(std::uint32_t numBuffers, Buffer* const * bufferArray, GLVertexArrayCache& vertexArrayCache)
 {
-    /* Bind VAO */
-    GLStateManager::active->BindVertexArray(GetVaoID());
+    /* Share VAO with all buffer arrays of the same vertex formats, since the buffers are bound separately */
+    std::vector<const VertexFormat*> formats(numBuffers);
+
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+    {
+        auto vertexBufferGL = LLGL_CAST(const GLVertexBuffer*, bufferArray[i]);
+        formats[i] = &(vertexBufferGL->GetVertexFormat());
+    }
+
+    if ((sharedVao_ = vertexArrayCache.GetVertexArray(numBuffers, formats.data())) != nullptr)
+    {
+        /* Store buffers to bind them with their current region offsets (for persistently mapped rings) */
+        BuildArray(numBuffers, bufferArray);
+
+        buffers_.resize(numBuffers);
+        offsets_.resize(numBuffers);
+        strides_.resize(numBuffers);
+
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+        {
+            buffers_[i] = LLGL_CAST(const GLVertexBuffer*, bufferArray[i]);
+            strides_[i] = static_cast<GLsizei>(formats[i]->stride);
+        }
+
+        return;
+    }
+
+    for (std::uint32_t i = 0; numBuffers > 0; --numBuffers)
     {
-        for (std::uint32_t i = 0; numBuffers > 0; --numBuffers)
+        auto vertexBufferGL = LLGL_CAST(GLVertexBuffer*, (*bufferArray));
         {
-            auto vertexBufferGL = LLGL_CAST(GLVertexBuffer*, (*bufferArray));
-            {
-                const auto& vertexFormat = vertexBufferGL->GetVertexFormat();
-
-                /* Bind VBO */
-                GLStateManager::active->BindBuffer(GLBufferTarget::ARRAY_BUFFER, vertexBufferGL->GetID());
-
-                /* Build each vertex attribute */
-                for (std::uint32_t j = 0, n = static_cast<std::uint32_t>(vertexFormat.attributes.size()); j < n; ++j, ++i)
-                    vao_.BuildVertexAttribute(vertexFormat.attributes[j], vertexFormat.stride, i);
-            }
-            ++bufferArray;
+            const auto& vertexFormat = vertexBufferGL->GetVertexFormat();
+
+            /* Build each vertex attribute */
+            for (std::uint32_t j = 0, n = static_cast<std::uint32_t>(vertexFormat.attributes.size()); j < n; ++j, ++i)
+                vao_.BuildVertexAttribute(vertexFormat.attributes[j], vertexFormat.stride, i, vertexBufferGL->GetID());
         }
+        ++bufferArray;
+    }
+    GLVertexArrayObject::FinishBuild();
+}
+
+void GLVertexBufferArray::BindVertexArray(GLStateManager& stateMngr)
+{
+    if (sharedVao_)
+    {
+        stateMngr.BindVertexArray(sharedVao_->GetID());
+
+        for (std::size_t i = 0; i < buffers_.size(); ++i)
+            offsets_[i] = buffers_[i]->GetRegionOffset();
+
+        stateMngr.BindVertexBuffers(
+            0,
+            static_cast<GLsizei>(buffers_.size()),
+            GetIDArray().data(),
+            offsets_.data(),
+            strides_.data()
+        );
     }
-    GLStateManager::active->BindVertexArray(0);
+    else
+        stateMngr.BindVertexArray(GetVaoID());
 }
 
 
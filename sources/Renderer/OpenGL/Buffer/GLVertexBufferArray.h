@@ -11,12 +11,18 @@
 
 #include "GLBufferArray.h"
 #include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class GLStateManager;
+class GLVertexBuffer;
+
 class GLVertexBufferArray final : public GLBufferArray
 {
 
@@ -24,17 +30,26 @@ class GLVertexBufferArray final : public GLBufferArray
 
         GLVertexBufferArray();
 
-        void BuildVertexArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        // Builds the VAO for this buffer array, or takes a shared format-only VAO from the cache if GL_ARB_vertex_attrib_binding is supported.
+        void BuildVertexArray(std::uint32_t numBuffers, Buffer* const * bufferArray, GLVertexArrayCache& vertexArrayCache);
+
+        // Binds the VAO of this buffer array, and binds all buffers to the shared VAO with a single call if there is one.
+        void BindVertexArray(GLStateManager& stateMngr);
 
         //! Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            return (sharedVao_ ? sharedVao_->GetID() : vao_.GetID());
         }
 
     private:
 
-        GLVertexArrayObject vao_;
+        GLVertexArrayObject                     vao_;
+        std::shared_ptr<GLVertexArrayObject>    sharedVao_;     // Format-only VAO, where buffer i is bound at binding point i
+
+        std::vector<const GLVertexBuffer*>      buffers_;
+        std::vector<GLintptr>                   offsets_;
+        std::vector<GLsizei>                    strides_;
 
 };
 
@@ -11,6 +11,10 @@
 #include <LLGL/Log.h>
 #include <functional>
 
+#if defined(__linux__) && defined(LLGL_GL_ENABLE_EGL)
+#   include <EGL/egl.h>
+#endif
+
 
 namespace LLGL
 {
@@ -28,6 +32,12 @@ bool LoadGLProc(T& procAddr, const char* procName)
     #if defined(_WIN32)
     procAddr = reinterpret_cast<T>(wglGetProcAddress(procName));
     #elif defined(__linux__)
+    #ifdef LLGL_GL_ENABLE_EGL
+    /* Headless render systems load their procedures from the current EGL context */
+    if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+        procAddr = reinterpret_cast<T>(eglGetProcAddress(procName));
+    else
+    #endif // /LLGL_GL_ENABLE_EGL
     procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #else
     Log::StdErr() << "OS not supported for loading OpenGL extensions" << std::endl;
@@ -176,6 +186,7 @@ static bool Load_GL_ARB_uniform_buffer_object(bool usePlaceholder)
     LOAD_GLPROC( glGetActiveUniformBlockName );
     LOAD_GLPROC( glUniformBlockBinding       );
     LOAD_GLPROC( glBindBufferBase            );
+    LOAD_GLPROC( glBindBufferRange           );
     return true;
 }
 
@@ -206,6 +217,70 @@ static bool Load_GL_ARB_draw_elements_base_vertex(bool usePlaceholder)
 {
     LOAD_GLPROC( glDrawElementsBaseVertex          );
     LOAD_GLPROC( glDrawElementsInstancedBaseVertex );
+    LOAD_GLPROC( glMultiDrawElementsBaseVertex     );
+    return true;
+}
+
+static bool Load_GL_EXT_multi_draw_arrays(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMultiDrawArrays   );
+    LOAD_GLPROC( glMultiDrawElements );
+    return true;
+}
+
+static bool Load_GL_ARB_invalidate_subdata(bool usePlaceholder)
+{
+    LOAD_GLPROC( glInvalidateTexSubImage    );
+    LOAD_GLPROC( glInvalidateTexImage       );
+    LOAD_GLPROC( glInvalidateBufferSubData  );
+    LOAD_GLPROC( glInvalidateBufferData     );
+    LOAD_GLPROC( glInvalidateFramebuffer    );
+    LOAD_GLPROC( glInvalidateSubFramebuffer );
+    return true;
+}
+
+static bool Load_GL_ARB_copy_buffer(bool usePlaceholder)
+{
+    LOAD_GLPROC( glCopyBufferSubData );
+    return true;
+}
+
+static bool Load_GL_ARB_clear_buffer_object(bool usePlaceholder)
+{
+    LOAD_GLPROC( glClearBufferData    );
+    LOAD_GLPROC( glClearBufferSubData );
+    return true;
+}
+
+static bool Load_GL_ARB_map_buffer_range(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMapBufferRange );
+    return true;
+}
+
+static bool Load_GL_ARB_copy_image(bool usePlaceholder)
+{
+    LOAD_GLPROC( glCopyImageSubData );
+    return true;
+}
+
+static bool Load_GL_ARB_get_texture_sub_image(bool usePlaceholder)
+{
+    LOAD_GLPROC( glGetTextureSubImage );
+    return true;
+}
+
+static bool Load_GL_ARB_draw_indirect(bool usePlaceholder)
+{
+    LOAD_GLPROC( glDrawArraysIndirect   );
+    LOAD_GLPROC( glDrawElementsIndirect );
+    return true;
+}
+
+static bool Load_GL_ARB_multi_draw_indirect(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMultiDrawArraysIndirect   );
+    LOAD_GLPROC( glMultiDrawElementsIndirect );
     return true;
 }
 
@@ -451,6 +526,16 @@ static bool Load_GL_EXT_stencil_two_side(bool usePlaceholder)
 static bool Load_GL_KHR_debug(bool usePlaceholder)
 {
     LOAD_GLPROC( glDebugMessageCallback );
+    LOAD_GLPROC( glDebugMessageInsert   );
+    LOAD_GLPROC( glPushDebugGroup       );
+    LOAD_GLPROC( glPopDebugGroup        );
+    LOAD_GLPROC( glObjectLabel          );
+    return true;
+}
+
+static bool Load_GL_KHR_parallel_shader_compile(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsKHR );
     return true;
 }
 
@@ -498,6 +583,27 @@ static bool Load_GL_NV_transform_feedback(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_transform_feedback2(bool usePlaceholder)
+{
+    LOAD_GLPROC( glBindTransformFeedback    );
+    LOAD_GLPROC( glDeleteTransformFeedbacks );
+    LOAD_GLPROC( glGenTransformFeedbacks    );
+    LOAD_GLPROC( glIsTransformFeedback      );
+    LOAD_GLPROC( glPauseTransformFeedback   );
+    LOAD_GLPROC( glResumeTransformFeedback  );
+    LOAD_GLPROC( glDrawTransformFeedback    );
+    return true;
+}
+
+static bool Load_GL_ARB_transform_feedback3(bool usePlaceholder)
+{
+    LOAD_GLPROC( glDrawTransformFeedbackStream );
+    LOAD_GLPROC( glBeginQueryIndexed           );
+    LOAD_GLPROC( glEndQueryIndexed             );
+    LOAD_GLPROC( glGetQueryIndexediv           );
+    return true;
+}
+
 static bool Load_GL_ARB_sync(bool usePlaceholder)
 {
     LOAD_GLPROC( glFenceSync      );
@@ -555,7 +661,8 @@ static bool Load_GL_ARB_texture_storage_multisample(bool usePlaceholder)
 
 static bool Load_GL_ARB_buffer_storage(bool usePlaceholder)
 {
-    LOAD_GLPROC( glBufferStorage );
+    LOAD_GLPROC( glBufferStorage  );
+    LOAD_GLPROC( glMapBufferRange );
     return true;
 }
 
@@ -585,6 +692,96 @@ static bool Load_GL_ARB_framebuffer_no_attachments(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_bindless_texture(bool usePlaceholder)
+{
+    LOAD_GLPROC( glGetTextureHandleARB          );
+    LOAD_GLPROC( glMakeTextureHandleResidentARB );
+    LOAD_GLPROC( glIsTextureHandleResidentARB   );
+    return true;
+}
+
+static bool Load_GL_ARB_vertex_attrib_binding(bool usePlaceholder)
+{
+    LOAD_GLPROC( glBindVertexBuffer     );
+    LOAD_GLPROC( glVertexAttribFormat   );
+    LOAD_GLPROC( glVertexAttribIFormat  );
+    LOAD_GLPROC( glVertexAttribBinding  );
+    LOAD_GLPROC( glVertexBindingDivisor );
+    return true;
+}
+
+static bool Load_GL_ARB_sparse_texture(bool usePlaceholder)
+{
+    LOAD_GLPROC( glTexPageCommitmentARB );
+    return true;
+}
+
+#ifdef GL_NV_shading_rate_image
+
+static bool Load_GL_NV_shading_rate_image(bool usePlaceholder)
+{
+    LOAD_GLPROC( glBindShadingRateImageNV    );
+    LOAD_GLPROC( glShadingRateImagePaletteNV );
+    LOAD_GLPROC( glShadingRateImageBarrierNV );
+    return true;
+}
+
+#endif
+
+#ifdef GL_OVR_multiview
+
+static bool Load_GL_OVR_multiview(bool usePlaceholder)
+{
+    LOAD_GLPROC( glFramebufferTextureMultiviewOVR );
+    return true;
+}
+
+#endif
+
+static bool Load_GL_ARB_separate_shader_objects(bool usePlaceholder)
+{
+    LOAD_GLPROC( glProgramUniform1i        );
+    LOAD_GLPROC( glProgramUniform2i        );
+    LOAD_GLPROC( glProgramUniform3i        );
+    LOAD_GLPROC( glProgramUniform4i        );
+    LOAD_GLPROC( glProgramUniform1f        );
+    LOAD_GLPROC( glProgramUniform2f        );
+    LOAD_GLPROC( glProgramUniform3f        );
+    LOAD_GLPROC( glProgramUniform4f        );
+    LOAD_GLPROC( glProgramUniform1iv       );
+    LOAD_GLPROC( glProgramUniform2iv       );
+    LOAD_GLPROC( glProgramUniform3iv       );
+    LOAD_GLPROC( glProgramUniform4iv       );
+    LOAD_GLPROC( glProgramUniform1fv       );
+    LOAD_GLPROC( glProgramUniform2fv       );
+    LOAD_GLPROC( glProgramUniform3fv       );
+    LOAD_GLPROC( glProgramUniform4fv       );
+    LOAD_GLPROC( glProgramUniformMatrix2fv );
+    LOAD_GLPROC( glProgramUniformMatrix3fv );
+    LOAD_GLPROC( glProgramUniformMatrix4fv );
+    return true;
+}
+
+#ifdef GL_EXT_depth_bounds_test
+
+static bool Load_GL_EXT_depth_bounds_test(bool usePlaceholder)
+{
+    LOAD_GLPROC( glDepthBoundsEXT );
+    return true;
+}
+
+#endif
+
+#ifdef GL_NV_mesh_shader
+
+static bool Load_GL_NV_mesh_shader(bool usePlaceholder)
+{
+    LOAD_GLPROC( glDrawMeshTasksNV );
+    return true;
+}
+
+#endif
+
 static bool Load_GL_ARB_direct_state_access(bool usePlaceholder)
 {
     LOAD_GLPROC( glCreateTransformFeedbacks                 );
@@ -768,10 +965,13 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_vertex_array_object          );
     ENABLE_GLEXT( ARB_framebuffer_object           );
     ENABLE_GLEXT( ARB_uniform_buffer_object        );
+    ENABLE_GLEXT( ARB_copy_buffer                  );
+    ENABLE_GLEXT( ARB_map_buffer_range             );
 
     /* Enable drawing extensions */
     ENABLE_GLEXT( ARB_draw_instanced               );
     ENABLE_GLEXT( ARB_draw_elements_base_vertex    );
+    ENABLE_GLEXT( EXT_multi_draw_arrays            );
 
     /* Enable shader extensions */
     ENABLE_GLEXT( ARB_shader_objects               );
@@ -779,6 +979,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_tessellation_shader          );
     ENABLE_GLEXT( ARB_get_program_binary           );
     ENABLE_GLEXT( ARB_program_interface_query      );
+    ENABLE_GLEXT( ARB_separate_shader_objects      );
     ENABLE_GLEXT( EXT_gpu_shader4                  );
 
     /* Enable texture extensions */
@@ -805,6 +1006,8 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_draw_buffers                 );
     ENABLE_GLEXT( EXT_draw_buffers2                );
     ENABLE_GLEXT( EXT_transform_feedback           );
+    ENABLE_GLEXT( ARB_transform_feedback2          );
+    ENABLE_GLEXT( ARB_transform_feedback3          );
     ENABLE_GLEXT( ARB_sync                         );
     ENABLE_GLEXT( ARB_polygon_offset_clamp         );
 
@@ -813,6 +1016,9 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( EXT_texture_array                );
     ENABLE_GLEXT( ARB_texture_cube_map_array       );
     ENABLE_GLEXT( ARB_geometry_shader4             );
+    ENABLE_GLEXT( EXT_texture_compression_s3tc     );
+    ENABLE_GLEXT( EXT_texture_sRGB                 );
+    ENABLE_GLEXT( ARB_texture_compression_rgtc     );
 
     #undef ENABLE_GLEXT
 
@@ -845,6 +1051,19 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
         #endif
     };
 
+    auto LoadExtensionDeferred = [&](const std::string& extName, GLExtensionLoadingProc extLoadingProc, GLExt extensionID) -> void
+    {
+        /* Only register OpenGL extension here, its procedures are loaded on first use via 'HasExtension' */
+        auto it = extensions.find(extName);
+        if (it != extensions.end())
+            RegisterDeferredExtension(extensionID, extLoadingProc);
+
+        #ifdef LLGL_GL_ENABLE_EXT_PLACEHOLDERS
+        /* Use dummy procedures until the extension is loaded to detect use without 'HasExtension' check */
+        extLoadingProc(true);
+        #endif
+    };
+
     auto EnableExtension = [&](const std::string& extName, GLExt extensionID) -> void
     {
         /* Try to enable OpenGL extension */
@@ -855,6 +1074,9 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     #define LOAD_GLEXT(NAME) \
         LoadExtension("GL_" + std::string(#NAME), Load_GL_##NAME, GLExt::NAME)
 
+    #define DEFER_GLEXT(NAME) \
+        LoadExtensionDeferred("GL_" + std::string(#NAME), Load_GL_##NAME, GLExt::NAME)
+
     #define ENABLE_GLEXT(NAME) \
         EnableExtension("GL_" + std::string(#NAME), GLExt::NAME)
 
@@ -870,13 +1092,20 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_vertex_buffer_object         );
     LOAD_GLEXT( ARB_vertex_array_object          );
     LOAD_GLEXT( ARB_framebuffer_object           );
+    DEFER_GLEXT( ARB_invalidate_subdata          );
     LOAD_GLEXT( ARB_uniform_buffer_object        );
     LOAD_GLEXT( ARB_shader_storage_buffer_object );
+    DEFER_GLEXT( ARB_copy_buffer                 );
+    DEFER_GLEXT( ARB_clear_buffer_object         );
+    DEFER_GLEXT( ARB_map_buffer_range            );
 
     /* Load drawing extensions */
     LOAD_GLEXT( ARB_draw_instanced               );
     LOAD_GLEXT( ARB_base_instance                );
     LOAD_GLEXT( ARB_draw_elements_base_vertex    );
+    LOAD_GLEXT( EXT_multi_draw_arrays            );
+    LOAD_GLEXT( ARB_draw_indirect                );
+    LOAD_GLEXT( ARB_multi_draw_indirect          );
 
     /* Load shader extensions */
     LOAD_GLEXT( ARB_shader_objects               );
@@ -884,51 +1113,72 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_tessellation_shader          );
     LOAD_GLEXT( ARB_compute_shader               );
     LOAD_GLEXT( ARB_get_program_binary           );
-    LOAD_GLEXT( ARB_program_interface_query      );
-    LOAD_GLEXT( EXT_gpu_shader4                  );
+    DEFER_GLEXT( ARB_program_interface_query     );
+    DEFER_GLEXT( EXT_gpu_shader4                 );
 
     /* Load texture extensions */
     LOAD_GLEXT( ARB_multitexture                 );
     LOAD_GLEXT( EXT_texture3D                    );
-    LOAD_GLEXT( ARB_clear_texture                );
+    DEFER_GLEXT( ARB_clear_texture               );
+    DEFER_GLEXT( ARB_copy_image                  );
+    DEFER_GLEXT( ARB_get_texture_sub_image       );
     LOAD_GLEXT( ARB_texture_compression          );
     LOAD_GLEXT( ARB_texture_multisample          );
     LOAD_GLEXT( ARB_sampler_objects              );
 
     /* Load blending extensions */
-    LOAD_GLEXT( EXT_blend_minmax                 );
+    DEFER_GLEXT( EXT_blend_minmax                );
     LOAD_GLEXT( EXT_blend_func_separate          );
     LOAD_GLEXT( EXT_blend_equation_separate      );
     LOAD_GLEXT( EXT_blend_color                  );
-    LOAD_GLEXT( ARB_draw_buffers_blend           );
+    DEFER_GLEXT( ARB_draw_buffers_blend          );
 
     /* Load misc extensions */
-    LOAD_GLEXT( ARB_viewport_array               );
+    DEFER_GLEXT( ARB_viewport_array              );
     LOAD_GLEXT( ARB_occlusion_query              );
     LOAD_GLEXT( NV_conditional_render            );
-    LOAD_GLEXT( ARB_timer_query                  );
-    LOAD_GLEXT( ARB_multi_bind                   );
+    DEFER_GLEXT( ARB_timer_query                 );
+    DEFER_GLEXT( ARB_multi_bind                  );
     LOAD_GLEXT( EXT_stencil_two_side             );
     LOAD_GLEXT( KHR_debug                        );
+    DEFER_GLEXT( KHR_parallel_shader_compile     );
     LOAD_GLEXT( ARB_clip_control                 );
     LOAD_GLEXT( ARB_draw_buffers                 );
     LOAD_GLEXT( EXT_draw_buffers2                );
     LOAD_GLEXT( EXT_transform_feedback           );
-    LOAD_GLEXT( NV_transform_feedback            );
-    LOAD_GLEXT( ARB_sync                         );
+    DEFER_GLEXT( NV_transform_feedback           );
+    DEFER_GLEXT( ARB_transform_feedback2         );
+    DEFER_GLEXT( ARB_transform_feedback3         );
+    DEFER_GLEXT( ARB_sync                        );
     LOAD_GLEXT( ARB_internalformat_query         );
-    LOAD_GLEXT( ARB_internalformat_query2        );
-    LOAD_GLEXT( ARB_ES2_compatibility            );
-    LOAD_GLEXT( ARB_gl_spirv                     );
-    LOAD_GLEXT( ARB_texture_storage              );
-    LOAD_GLEXT( ARB_texture_storage_multisample  );
+    DEFER_GLEXT( ARB_internalformat_query2       );
+    DEFER_GLEXT( ARB_ES2_compatibility           );
+    DEFER_GLEXT( ARB_gl_spirv                    );
+    DEFER_GLEXT( ARB_texture_storage             );
+    DEFER_GLEXT( ARB_texture_storage_multisample );
     LOAD_GLEXT( ARB_buffer_storage               );
-    LOAD_GLEXT( ARB_polygon_offset_clamp         );
-    LOAD_GLEXT( ARB_texture_view                 );
+    DEFER_GLEXT( ARB_polygon_offset_clamp        );
+    DEFER_GLEXT( ARB_texture_view                );
     LOAD_GLEXT( ARB_shader_image_load_store      );
-    LOAD_GLEXT( ARB_framebuffer_no_attachments   );
+    DEFER_GLEXT( ARB_framebuffer_no_attachments  );
+    DEFER_GLEXT( ARB_bindless_texture            );
+    LOAD_GLEXT( ARB_vertex_attrib_binding        );
+    DEFER_GLEXT( ARB_sparse_texture              );
+    #ifdef GL_NV_shading_rate_image
+    DEFER_GLEXT( NV_shading_rate_image           );
+    #endif
+    #ifdef GL_OVR_multiview
+    DEFER_GLEXT( OVR_multiview                   );
+    #endif
+    DEFER_GLEXT( ARB_separate_shader_objects     );
+    #ifdef GL_EXT_depth_bounds_test
+    DEFER_GLEXT( EXT_depth_bounds_test           );
+    #endif
+    #ifdef GL_NV_mesh_shader
+    DEFER_GLEXT( NV_mesh_shader                  );
+    #endif
     #ifdef LLGL_GL_ENABLE_DSA_EXT
-    LOAD_GLEXT( ARB_direct_state_access          );
+    DEFER_GLEXT( ARB_direct_state_access         );
     #endif
 
     /* Enable extensions without procedures */
@@ -939,8 +1189,21 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( NV_conservative_raster           );
     ENABLE_GLEXT( INTEL_conservative_rasterization );
     ENABLE_GLEXT( ARB_pipeline_statistics_query    );
+    ENABLE_GLEXT( ARB_query_buffer_object          );
+    ENABLE_GLEXT( ARB_shader_atomic_counters       );
+    ENABLE_GLEXT( EXT_texture_compression_s3tc     );
+    ENABLE_GLEXT( EXT_texture_sRGB                 );
+    ENABLE_GLEXT( ARB_texture_compression_rgtc     );
+    ENABLE_GLEXT( ARB_texture_compression_bptc     );
+    ENABLE_GLEXT( ARB_ES3_compatibility            );
+    ENABLE_GLEXT( KHR_texture_compression_astc_ldr );
+    ENABLE_GLEXT( NVX_gpu_memory_info              );
+    ENABLE_GLEXT( ATI_meminfo                      );
+    ENABLE_GLEXT( OVR_multiview2                   );
+    ENABLE_GLEXT( KHR_shader_subgroup              );
 
     #undef LOAD_GLEXT
+    #undef DEFER_GLEXT
     #undef ENABLE_GLEXT
 
     #endif
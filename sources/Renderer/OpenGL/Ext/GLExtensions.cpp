@@ -195,6 +195,12 @@ PFNGLDRAWELEMENTSINSTANCEDPROC                          glDrawElementsInstanced
 
 PFNGLDRAWELEMENTSBASEVERTEXPROC                         glDrawElementsBaseVertex                        = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC                glDrawElementsInstancedBaseVertex               = nullptr;
+PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC                    glMultiDrawElementsBaseVertex                   = nullptr;
+
+/* GL_EXT_multi_draw_arrays */
+
+PFNGLMULTIDRAWARRAYSPROC                                glMultiDrawArrays                               = nullptr;
+PFNGLMULTIDRAWELEMENTSPROC                              glMultiDrawElements                             = nullptr;
 
 /* GL_ARB_base_instance */
 
@@ -202,6 +208,46 @@ PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC                glDrawArraysInstancedBas
 PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC              glDrawElementsInstancedBaseInstance             = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC    glDrawElementsInstancedBaseVertexBaseInstance   = nullptr;
 
+/* GL_ARB_invalidate_subdata */
+
+PFNGLINVALIDATETEXSUBIMAGEPROC                          glInvalidateTexSubImage                         = nullptr;
+PFNGLINVALIDATETEXIMAGEPROC                             glInvalidateTexImage                            = nullptr;
+PFNGLINVALIDATEBUFFERSUBDATAPROC                        glInvalidateBufferSubData                       = nullptr;
+PFNGLINVALIDATEBUFFERDATAPROC                           glInvalidateBufferData                          = nullptr;
+PFNGLINVALIDATEFRAMEBUFFERPROC                          glInvalidateFramebuffer                         = nullptr;
+PFNGLINVALIDATESUBFRAMEBUFFERPROC                       glInvalidateSubFramebuffer                      = nullptr;
+
+/* GL_ARB_copy_buffer */
+
+PFNGLCOPYBUFFERSUBDATAPROC                              glCopyBufferSubData                             = nullptr;
+
+/* GL_ARB_clear_buffer_object */
+
+PFNGLCLEARBUFFERDATAPROC                                glClearBufferData                               = nullptr;
+PFNGLCLEARBUFFERSUBDATAPROC                             glClearBufferSubData                            = nullptr;
+
+/* GL_ARB_map_buffer_range */
+
+PFNGLMAPBUFFERRANGEPROC                                 glMapBufferRange                                = nullptr;
+
+/* GL_ARB_copy_image */
+
+PFNGLCOPYIMAGESUBDATAPROC                               glCopyImageSubData                              = nullptr;
+
+/* GL_ARB_get_texture_sub_image */
+
+PFNGLGETTEXTURESUBIMAGEPROC                             glGetTextureSubImage                            = nullptr;
+
+/* GL_ARB_draw_indirect */
+
+PFNGLDRAWARRAYSINDIRECTPROC                             glDrawArraysIndirect                            = nullptr;
+PFNGLDRAWELEMENTSINDIRECTPROC                           glDrawElementsIndirect                          = nullptr;
+
+/* GL_ARB_multi_draw_indirect */
+
+PFNGLMULTIDRAWARRAYSINDIRECTPROC                        glMultiDrawArraysIndirect                       = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC                      glMultiDrawElementsIndirect                     = nullptr;
+
 /* GL_ARB_shader_objects */
 
 PFNGLCREATESHADERPROC                                   glCreateShader                                  = nullptr;
@@ -318,6 +364,14 @@ PFNGLSTENCILOPSEPARATEPROC                              glStencilOpSeparate
 /* GL_KHR_debug */
 
 PFNGLDEBUGMESSAGECALLBACKPROC                           glDebugMessageCallback                          = nullptr;
+PFNGLDEBUGMESSAGEINSERTPROC                             glDebugMessageInsert                            = nullptr;
+PFNGLPUSHDEBUGGROUPPROC                                 glPushDebugGroup                                = nullptr;
+PFNGLPOPDEBUGGROUPPROC                                  glPopDebugGroup                                 = nullptr;
+PFNGLOBJECTLABELPROC                                    glObjectLabel                                   = nullptr;
+
+/* GL_KHR_parallel_shader_compile */
+
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC                    glMaxShaderCompilerThreadsKHR                   = nullptr;
 
 /* GL_ARB_clip_control */
 
@@ -340,6 +394,23 @@ PFNGLTRANSFORMFEEDBACKVARYINGSNVPROC                    glTransformFeedbackVaryi
 PFNGLGETVARYINGLOCATIONNVPROC                           glGetVaryingLocationNV                          = nullptr;
 PFNGLGETACTIVEVARYINGNVPROC                             glGetActiveVaryingNV                            = nullptr;
 
+/* GL_ARB_transform_feedback2 */
+
+PFNGLBINDTRANSFORMFEEDBACKPROC                          glBindTransformFeedback                         = nullptr;
+PFNGLDELETETRANSFORMFEEDBACKSPROC                       glDeleteTransformFeedbacks                      = nullptr;
+PFNGLGENTRANSFORMFEEDBACKSPROC                          glGenTransformFeedbacks                         = nullptr;
+PFNGLISTRANSFORMFEEDBACKPROC                            glIsTransformFeedback                           = nullptr;
+PFNGLPAUSETRANSFORMFEEDBACKPROC                         glPauseTransformFeedback                        = nullptr;
+PFNGLRESUMETRANSFORMFEEDBACKPROC                        glResumeTransformFeedback                       = nullptr;
+PFNGLDRAWTRANSFORMFEEDBACKPROC                          glDrawTransformFeedback                         = nullptr;
+
+/* GL_ARB_transform_feedback3 */
+
+PFNGLDRAWTRANSFORMFEEDBACKSTREAMPROC                    glDrawTransformFeedbackStream                   = nullptr;
+PFNGLBEGINQUERYINDEXEDPROC                              glBeginQueryIndexed                             = nullptr;
+PFNGLENDQUERYINDEXEDPROC                                glEndQueryIndexed                               = nullptr;
+PFNGLGETQUERYINDEXEDIVPROC                              glGetQueryIndexediv                             = nullptr;
+
 /* GL_ARB_sync */
 
 PFNGLFENCESYNCPROC                                      glFenceSync                                     = nullptr;
@@ -403,6 +474,80 @@ PFNGLMEMORYBARRIERPROC                                  glMemoryBarrier
 PFNGLFRAMEBUFFERPARAMETERIPROC                          glFramebufferParameteri                         = nullptr;
 PFNGLGETFRAMEBUFFERPARAMETERIVPROC                      glGetFramebufferParameteriv                     = nullptr;
 
+/* GL_ARB_bindless_texture */
+
+PFNGLGETTEXTUREHANDLEARBPROC                            glGetTextureHandleARB                           = nullptr;
+PFNGLMAKETEXTUREHANDLERESIDENTARBPROC                   glMakeTextureHandleResidentARB                  = nullptr;
+PFNGLISTEXTUREHANDLERESIDENTARBPROC                     glIsTextureHandleResidentARB                    = nullptr;
+
+/* GL_ARB_vertex_attrib_binding */
+
+PFNGLBINDVERTEXBUFFERPROC                               glBindVertexBuffer                              = nullptr;
+PFNGLVERTEXATTRIBFORMATPROC                             glVertexAttribFormat                            = nullptr;
+PFNGLVERTEXATTRIBIFORMATPROC                            glVertexAttribIFormat                           = nullptr;
+PFNGLVERTEXATTRIBBINDINGPROC                            glVertexAttribBinding                           = nullptr;
+PFNGLVERTEXBINDINGDIVISORPROC                           glVertexBindingDivisor                          = nullptr;
+
+/* GL_ARB_sparse_texture */
+
+PFNGLTEXPAGECOMMITMENTARBPROC                           glTexPageCommitmentARB                          = nullptr;
+
+#ifdef GL_NV_shading_rate_image
+
+/* GL_NV_shading_rate_image */
+
+PFNGLBINDSHADINGRATEIMAGENVPROC                         glBindShadingRateImageNV                        = nullptr;
+PFNGLSHADINGRATEIMAGEPALETTENVPROC                      glShadingRateImagePaletteNV                     = nullptr;
+PFNGLSHADINGRATEIMAGEBARRIERNVPROC                      glShadingRateImageBarrierNV                     = nullptr;
+
+#endif
+
+#ifdef GL_OVR_multiview
+
+/* GL_OVR_multiview */
+
+PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC                 glFramebufferTextureMultiviewOVR                = nullptr;
+
+#endif
+
+/* GL_ARB_separate_shader_objects */
+
+PFNGLPROGRAMUNIFORM1IPROC                               glProgramUniform1i                              = nullptr;
+PFNGLPROGRAMUNIFORM2IPROC                               glProgramUniform2i                              = nullptr;
+PFNGLPROGRAMUNIFORM3IPROC                               glProgramUniform3i                              = nullptr;
+PFNGLPROGRAMUNIFORM4IPROC                               glProgramUniform4i                              = nullptr;
+PFNGLPROGRAMUNIFORM1FPROC                               glProgramUniform1f                              = nullptr;
+PFNGLPROGRAMUNIFORM2FPROC                               glProgramUniform2f                              = nullptr;
+PFNGLPROGRAMUNIFORM3FPROC                               glProgramUniform3f                              = nullptr;
+PFNGLPROGRAMUNIFORM4FPROC                               glProgramUniform4f                              = nullptr;
+PFNGLPROGRAMUNIFORM1IVPROC                              glProgramUniform1iv                             = nullptr;
+PFNGLPROGRAMUNIFORM2IVPROC                              glProgramUniform2iv                             = nullptr;
+PFNGLPROGRAMUNIFORM3IVPROC                              glProgramUniform3iv                             = nullptr;
+PFNGLPROGRAMUNIFORM4IVPROC                              glProgramUniform4iv                             = nullptr;
+PFNGLPROGRAMUNIFORM1FVPROC                              glProgramUniform1fv                             = nullptr;
+PFNGLPROGRAMUNIFORM2FVPROC                              glProgramUniform2fv                             = nullptr;
+PFNGLPROGRAMUNIFORM3FVPROC                              glProgramUniform3fv                             = nullptr;
+PFNGLPROGRAMUNIFORM4FVPROC                              glProgramUniform4fv                             = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX2FVPROC                        glProgramUniformMatrix2fv                       = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX3FVPROC                        glProgramUniformMatrix3fv                       = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX4FVPROC                        glProgramUniformMatrix4fv                       = nullptr;
+
+#ifdef GL_EXT_depth_bounds_test
+
+/* GL_EXT_depth_bounds_test */
+
+PFNGLDEPTHBOUNDSEXTPROC                                 glDepthBoundsEXT                                = nullptr;
+
+#endif
+
+#ifdef GL_NV_mesh_shader
+
+/* GL_NV_mesh_shader */
+
+PFNGLDRAWMESHTASKSNVPROC                                glDrawMeshTasksNV                               = nullptr;
+
+#endif
+
 /* GL_ARB_direct_state_access */
 
 PFNGLCREATETRANSFORMFEEDBACKSPROC                       glCreateTransformFeedbacks                      = nullptr;
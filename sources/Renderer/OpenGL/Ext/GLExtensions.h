@@ -198,6 +198,12 @@ extern PFNGLDRAWELEMENTSINSTANCEDPROC                       glDrawElementsInstan
 
 extern PFNGLDRAWELEMENTSBASEVERTEXPROC                      glDrawElementsBaseVertex;
 extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC             glDrawElementsInstancedBaseVertex;
+extern PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC                 glMultiDrawElementsBaseVertex;
+
+/* GL_EXT_multi_draw_arrays */
+
+extern PFNGLMULTIDRAWARRAYSPROC                             glMultiDrawArrays;
+extern PFNGLMULTIDRAWELEMENTSPROC                           glMultiDrawElements;
 
 /* GL_ARB_base_instance */
 
@@ -205,6 +211,46 @@ extern PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC             glDrawArraysInstance
 extern PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC           glDrawElementsInstancedBaseInstance;
 extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glDrawElementsInstancedBaseVertexBaseInstance;
 
+/* GL_ARB_invalidate_subdata */
+
+extern PFNGLINVALIDATETEXSUBIMAGEPROC                       glInvalidateTexSubImage;
+extern PFNGLINVALIDATETEXIMAGEPROC                          glInvalidateTexImage;
+extern PFNGLINVALIDATEBUFFERSUBDATAPROC                     glInvalidateBufferSubData;
+extern PFNGLINVALIDATEBUFFERDATAPROC                        glInvalidateBufferData;
+extern PFNGLINVALIDATEFRAMEBUFFERPROC                       glInvalidateFramebuffer;
+extern PFNGLINVALIDATESUBFRAMEBUFFERPROC                    glInvalidateSubFramebuffer;
+
+/* GL_ARB_copy_buffer */
+
+extern PFNGLCOPYBUFFERSUBDATAPROC                           glCopyBufferSubData;
+
+/* GL_ARB_clear_buffer_object */
+
+extern PFNGLCLEARBUFFERDATAPROC                             glClearBufferData;
+extern PFNGLCLEARBUFFERSUBDATAPROC                          glClearBufferSubData;
+
+/* GL_ARB_map_buffer_range */
+
+extern PFNGLMAPBUFFERRANGEPROC                              glMapBufferRange;
+
+/* GL_ARB_copy_image */
+
+extern PFNGLCOPYIMAGESUBDATAPROC                            glCopyImageSubData;
+
+/* GL_ARB_get_texture_sub_image */
+
+extern PFNGLGETTEXTURESUBIMAGEPROC                          glGetTextureSubImage;
+
+/* GL_ARB_draw_indirect */
+
+extern PFNGLDRAWARRAYSINDIRECTPROC                          glDrawArraysIndirect;
+extern PFNGLDRAWELEMENTSINDIRECTPROC                        glDrawElementsIndirect;
+
+/* GL_ARB_multi_draw_indirect */
+
+extern PFNGLMULTIDRAWARRAYSINDIRECTPROC                     glMultiDrawArraysIndirect;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC                   glMultiDrawElementsIndirect;
+
 /* GL_ARB_shader_objects */
 
 extern PFNGLCREATESHADERPROC                                glCreateShader;
@@ -321,6 +367,14 @@ extern PFNGLSTENCILOPSEPARATEPROC                           glStencilOpSeparate;
 /* GL_KHR_debug */
 
 extern PFNGLDEBUGMESSAGECALLBACKPROC                        glDebugMessageCallback;
+extern PFNGLDEBUGMESSAGEINSERTPROC                          glDebugMessageInsert;
+extern PFNGLPUSHDEBUGGROUPPROC                              glPushDebugGroup;
+extern PFNGLPOPDEBUGGROUPPROC                               glPopDebugGroup;
+extern PFNGLOBJECTLABELPROC                                 glObjectLabel;
+
+/* GL_KHR_parallel_shader_compile */
+
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC                 glMaxShaderCompilerThreadsKHR;
 
 /* GL_ARB_clip_control */
 
@@ -343,6 +397,23 @@ extern PFNGLTRANSFORMFEEDBACKVARYINGSNVPROC                 glTransformFeedbackV
 extern PFNGLGETVARYINGLOCATIONNVPROC                        glGetVaryingLocationNV;
 extern PFNGLGETACTIVEVARYINGNVPROC                          glGetActiveVaryingNV;
 
+/* GL_ARB_transform_feedback2 */
+
+extern PFNGLBINDTRANSFORMFEEDBACKPROC                       glBindTransformFeedback;
+extern PFNGLDELETETRANSFORMFEEDBACKSPROC                    glDeleteTransformFeedbacks;
+extern PFNGLGENTRANSFORMFEEDBACKSPROC                       glGenTransformFeedbacks;
+extern PFNGLISTRANSFORMFEEDBACKPROC                         glIsTransformFeedback;
+extern PFNGLPAUSETRANSFORMFEEDBACKPROC                      glPauseTransformFeedback;
+extern PFNGLRESUMETRANSFORMFEEDBACKPROC                     glResumeTransformFeedback;
+extern PFNGLDRAWTRANSFORMFEEDBACKPROC                       glDrawTransformFeedback;
+
+/* GL_ARB_transform_feedback3 */
+
+extern PFNGLDRAWTRANSFORMFEEDBACKSTREAMPROC                 glDrawTransformFeedbackStream;
+extern PFNGLBEGINQUERYINDEXEDPROC                           glBeginQueryIndexed;
+extern PFNGLENDQUERYINDEXEDPROC                             glEndQueryIndexed;
+extern PFNGLGETQUERYINDEXEDIVPROC                           glGetQueryIndexediv;
+
 /* GL_ARB_sync */
 
 extern PFNGLFENCESYNCPROC                                   glFenceSync;
@@ -406,6 +477,80 @@ extern PFNGLMEMORYBARRIERPROC                               glMemoryBarrier;
 extern PFNGLFRAMEBUFFERPARAMETERIPROC                       glFramebufferParameteri;
 extern PFNGLGETFRAMEBUFFERPARAMETERIVPROC                   glGetFramebufferParameteriv;
 
+/* GL_ARB_bindless_texture */
+
+extern PFNGLGETTEXTUREHANDLEARBPROC                         glGetTextureHandleARB;
+extern PFNGLMAKETEXTUREHANDLERESIDENTARBPROC                glMakeTextureHandleResidentARB;
+extern PFNGLISTEXTUREHANDLERESIDENTARBPROC                  glIsTextureHandleResidentARB;
+
+/* GL_ARB_vertex_attrib_binding */
+
+extern PFNGLBINDVERTEXBUFFERPROC                            glBindVertexBuffer;
+extern PFNGLVERTEXATTRIBFORMATPROC                          glVertexAttribFormat;
+extern PFNGLVERTEXATTRIBIFORMATPROC                         glVertexAttribIFormat;
+extern PFNGLVERTEXATTRIBBINDINGPROC                         glVertexAttribBinding;
+extern PFNGLVERTEXBINDINGDIVISORPROC                        glVertexBindingDivisor;
+
+/* GL_ARB_sparse_texture */
+
+extern PFNGLTEXPAGECOMMITMENTARBPROC                        glTexPageCommitmentARB;
+
+#ifdef GL_NV_shading_rate_image
+
+/* GL_NV_shading_rate_image */
+
+extern PFNGLBINDSHADINGRATEIMAGENVPROC                      glBindShadingRateImageNV;
+extern PFNGLSHADINGRATEIMAGEPALETTENVPROC                   glShadingRateImagePaletteNV;
+extern PFNGLSHADINGRATEIMAGEBARRIERNVPROC                   glShadingRateImageBarrierNV;
+
+#endif
+
+#ifdef GL_OVR_multiview
+
+/* GL_OVR_multiview */
+
+extern PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC              glFramebufferTextureMultiviewOVR;
+
+#endif
+
+/* GL_ARB_separate_shader_objects */
+
+extern PFNGLPROGRAMUNIFORM1IPROC                            glProgramUniform1i;
+extern PFNGLPROGRAMUNIFORM2IPROC                            glProgramUniform2i;
+extern PFNGLPROGRAMUNIFORM3IPROC                            glProgramUniform3i;
+extern PFNGLPROGRAMUNIFORM4IPROC                            glProgramUniform4i;
+extern PFNGLPROGRAMUNIFORM1FPROC                            glProgramUniform1f;
+extern PFNGLPROGRAMUNIFORM2FPROC                            glProgramUniform2f;
+extern PFNGLPROGRAMUNIFORM3FPROC                            glProgramUniform3f;
+extern PFNGLPROGRAMUNIFORM4FPROC                            glProgramUniform4f;
+extern PFNGLPROGRAMUNIFORM1IVPROC                           glProgramUniform1iv;
+extern PFNGLPROGRAMUNIFORM2IVPROC                           glProgramUniform2iv;
+extern PFNGLPROGRAMUNIFORM3IVPROC                           glProgramUniform3iv;
+extern PFNGLPROGRAMUNIFORM4IVPROC                           glProgramUniform4iv;
+extern PFNGLPROGRAMUNIFORM1FVPROC                           glProgramUniform1fv;
+extern PFNGLPROGRAMUNIFORM2FVPROC                           glProgramUniform2fv;
+extern PFNGLPROGRAMUNIFORM3FVPROC                           glProgramUniform3fv;
+extern PFNGLPROGRAMUNIFORM4FVPROC                           glProgramUniform4fv;
+extern PFNGLPROGRAMUNIFORMMATRIX2FVPROC                     glProgramUniformMatrix2fv;
+extern PFNGLPROGRAMUNIFORMMATRIX3FVPROC                     glProgramUniformMatrix3fv;
+extern PFNGLPROGRAMUNIFORMMATRIX4FVPROC                     glProgramUniformMatrix4fv;
+
+#ifdef GL_EXT_depth_bounds_test
+
+/* GL_EXT_depth_bounds_test */
+
+extern PFNGLDEPTHBOUNDSEXTPROC                              glDepthBoundsEXT;
+
+#endif
+
+#ifdef GL_NV_mesh_shader
+
+/* GL_NV_mesh_shader */
+
+extern PFNGLDRAWMESHTASKSNVPROC                             glDrawMeshTasksNV;
+
+#endif
+
 /* GL_ARB_direct_state_access */
 
 extern PFNGLCREATETRANSFORMFEEDBACKSPROC                    glCreateTransformFeedbacks;
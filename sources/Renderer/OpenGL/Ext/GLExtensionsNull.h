@@ -225,6 +225,12 @@ DECL_GLPROC(void, glDrawElementsInstanced, (GLenum, GLsizei, GLenum, const void*
 
 DECL_GLPROC(void, glDrawElementsBaseVertex, (GLenum, GLsizei, GLenum, const void*, GLint));
 DECL_GLPROC(void, glDrawElementsInstancedBaseVertex, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint));
+DECL_GLPROC(void, glMultiDrawElementsBaseVertex, (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei, const GLint*));
+
+/* GL_EXT_multi_draw_arrays */
+
+DECL_GLPROC(void, glMultiDrawArrays, (GLenum, const GLint*, const GLsizei*, GLsizei));
+DECL_GLPROC(void, glMultiDrawElements, (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei));
 
 /* GL_ARB_base_instance */
 
@@ -232,6 +238,46 @@ DECL_GLPROC(void, glDrawArraysInstancedBaseInstance, (GLenum, GLint, GLsizei, GL
 DECL_GLPROC(void, glDrawElementsInstancedBaseInstance, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLuint));
 DECL_GLPROC(void, glDrawElementsInstancedBaseVertexBaseInstance, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint, GLuint));
 
+/* GL_ARB_invalidate_subdata */
+
+DECL_GLPROC(void, glInvalidateTexSubImage, (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei));
+DECL_GLPROC(void, glInvalidateTexImage, (GLuint, GLint));
+DECL_GLPROC(void, glInvalidateBufferSubData, (GLuint, GLintptr, GLsizeiptr));
+DECL_GLPROC(void, glInvalidateBufferData, (GLuint));
+DECL_GLPROC(void, glInvalidateFramebuffer, (GLenum, GLsizei, const GLenum*));
+DECL_GLPROC(void, glInvalidateSubFramebuffer, (GLenum, GLsizei, const GLenum*, GLint, GLint, GLsizei, GLsizei));
+
+/* GL_ARB_copy_buffer */
+
+DECL_GLPROC(void, glCopyBufferSubData, (GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr));
+
+/* GL_ARB_clear_buffer_object */
+
+DECL_GLPROC(void, glClearBufferData, (GLenum, GLenum, GLenum, GLenum, const void*));
+DECL_GLPROC(void, glClearBufferSubData, (GLenum, GLenum, GLintptr, GLsizeiptr, GLenum, GLenum, const void*));
+
+/* GL_ARB_map_buffer_range */
+
+DECL_GLPROC(void*, glMapBufferRange, (GLenum, GLintptr, GLsizeiptr, GLbitfield));
+
+/* GL_ARB_copy_image */
+
+DECL_GLPROC(void, glCopyImageSubData, (GLuint, GLenum, GLint, GLint, GLint, GLint, GLuint, GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei));
+
+/* GL_ARB_get_texture_sub_image */
+
+DECL_GLPROC(void, glGetTextureSubImage, (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, GLsizei, void*));
+
+/* GL_ARB_draw_indirect */
+
+DECL_GLPROC(void, glDrawArraysIndirect, (GLenum, const void*));
+DECL_GLPROC(void, glDrawElementsIndirect, (GLenum, GLenum, const void*));
+
+/* GL_ARB_multi_draw_indirect */
+
+DECL_GLPROC(void, glMultiDrawArraysIndirect, (GLenum, const void*, GLsizei, GLsizei));
+DECL_GLPROC(void, glMultiDrawElementsIndirect, (GLenum, GLenum, const void*, GLsizei, GLsizei));
+
 /* GL_ARB_shader_objects */
 
 DECL_GLPROC(GLuint, glCreateShader, (GLenum));
@@ -348,6 +394,14 @@ DECL_GLPROC(void, glStencilOpSeparate, (GLenum, GLenum, GLenum, GLenum));
 /* GL_KHR_debug */
 
 DECL_GLPROC(void, glDebugMessageCallback, (GLDEBUGPROC, const void*));
+DECL_GLPROC(void, glDebugMessageInsert, (GLenum, GLenum, GLuint, GLenum, GLsizei, const GLchar*));
+DECL_GLPROC(void, glPushDebugGroup, (GLenum, GLuint, GLsizei, const GLchar*));
+DECL_GLPROC(void, glPopDebugGroup, (void));
+DECL_GLPROC(void, glObjectLabel, (GLenum, GLuint, GLsizei, const GLchar*));
+
+/* GL_KHR_parallel_shader_compile */
+
+DECL_GLPROC(void, glMaxShaderCompilerThreadsKHR, (GLuint));
 
 /* GL_ARB_clip_control */
 
@@ -370,6 +424,23 @@ DECL_GLPROC(void, glTransformFeedbackVaryingsNV, (GLuint, GLsizei, const GLint*,
 DECL_GLPROC(GLint, glGetVaryingLocationNV, (GLuint, const GLchar*));
 DECL_GLPROC(void, glGetActiveVaryingNV, (GLuint, GLuint, GLsizei, GLsizei*, GLsizei*, GLenum*, GLchar*));
 
+/* GL_ARB_transform_feedback2 */
+
+DECL_GLPROC(void, glBindTransformFeedback, (GLenum, GLuint));
+DECL_GLPROC(void, glDeleteTransformFeedbacks, (GLsizei, const GLuint*));
+DECL_GLPROC(void, glGenTransformFeedbacks, (GLsizei, GLuint*));
+DECL_GLPROC(GLboolean, glIsTransformFeedback, (GLuint));
+DECL_GLPROC(void, glPauseTransformFeedback, (void));
+DECL_GLPROC(void, glResumeTransformFeedback, (void));
+DECL_GLPROC(void, glDrawTransformFeedback, (GLenum, GLuint));
+
+/* GL_ARB_transform_feedback3 */
+
+DECL_GLPROC(void, glDrawTransformFeedbackStream, (GLenum, GLuint, GLuint));
+DECL_GLPROC(void, glBeginQueryIndexed, (GLenum, GLuint, GLuint));
+DECL_GLPROC(void, glEndQueryIndexed, (GLenum, GLuint));
+DECL_GLPROC(void, glGetQueryIndexediv, (GLenum, GLuint, GLenum, GLint*));
+
 /* GL_ARB_sync */
 
 DECL_GLPROC(GLsync, glFenceSync, (GLenum, GLbitfield));
@@ -433,6 +504,80 @@ DECL_GLPROC(void, glMemoryBarrier, (GLbitfield));
 DECL_GLPROC(void, glFramebufferParameteri, (GLenum, GLenum, GLint));
 DECL_GLPROC(void, glGetFramebufferParameteriv, (GLenum, GLenum, GLint*));
 
+/* GL_ARB_bindless_texture */
+
+DECL_GLPROC(GLuint64, glGetTextureHandleARB, (GLuint));
+DECL_GLPROC(void, glMakeTextureHandleResidentARB, (GLuint64));
+DECL_GLPROC(GLboolean, glIsTextureHandleResidentARB, (GLuint64));
+
+/* GL_ARB_vertex_attrib_binding */
+
+DECL_GLPROC(void, glBindVertexBuffer, (GLuint, GLuint, GLintptr, GLsizei));
+DECL_GLPROC(void, glVertexAttribFormat, (GLuint, GLint, GLenum, GLboolean, GLuint));
+DECL_GLPROC(void, glVertexAttribIFormat, (GLuint, GLint, GLenum, GLuint));
+DECL_GLPROC(void, glVertexAttribBinding, (GLuint, GLuint));
+DECL_GLPROC(void, glVertexBindingDivisor, (GLuint, GLuint));
+
+/* GL_ARB_sparse_texture */
+
+DECL_GLPROC(void, glTexPageCommitmentARB, (GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLboolean));
+
+#ifdef GL_NV_shading_rate_image
+
+/* GL_NV_shading_rate_image */
+
+DECL_GLPROC(void, glBindShadingRateImageNV, (GLuint));
+DECL_GLPROC(void, glShadingRateImagePaletteNV, (GLuint, GLuint, GLsizei, const GLenum*));
+DECL_GLPROC(void, glShadingRateImageBarrierNV, (GLboolean));
+
+#endif
+
+#ifdef GL_OVR_multiview
+
+/* GL_OVR_multiview */
+
+DECL_GLPROC(void, glFramebufferTextureMultiviewOVR, (GLenum, GLenum, GLuint, GLint, GLint, GLsizei));
+
+#endif
+
+/* GL_ARB_separate_shader_objects */
+
+DECL_GLPROC(void, glProgramUniform1i, (GLuint, GLint, GLint));
+DECL_GLPROC(void, glProgramUniform2i, (GLuint, GLint, GLint, GLint));
+DECL_GLPROC(void, glProgramUniform3i, (GLuint, GLint, GLint, GLint, GLint));
+DECL_GLPROC(void, glProgramUniform4i, (GLuint, GLint, GLint, GLint, GLint, GLint));
+DECL_GLPROC(void, glProgramUniform1f, (GLuint, GLint, GLfloat));
+DECL_GLPROC(void, glProgramUniform2f, (GLuint, GLint, GLfloat, GLfloat));
+DECL_GLPROC(void, glProgramUniform3f, (GLuint, GLint, GLfloat, GLfloat, GLfloat));
+DECL_GLPROC(void, glProgramUniform4f, (GLuint, GLint, GLfloat, GLfloat, GLfloat, GLfloat));
+DECL_GLPROC(void, glProgramUniform1iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform2iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform3iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform4iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform1fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform2fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform3fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform4fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix2fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix3fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix4fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+
+#ifdef GL_EXT_depth_bounds_test
+
+/* GL_EXT_depth_bounds_test */
+
+DECL_GLPROC(void, glDepthBoundsEXT, (GLclampd, GLclampd));
+
+#endif
+
+#ifdef GL_NV_mesh_shader
+
+/* GL_NV_mesh_shader */
+
+DECL_GLPROC(void, glDrawMeshTasksNV, (GLuint, GLuint));
+
+#endif
+
 /* GL_ARB_direct_state_access */
 
 DECL_GLPROC(void, glCreateTransformFeedbacks, (GLsizei, GLuint*));
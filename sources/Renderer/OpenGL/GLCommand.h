@@ -0,0 +1,442 @@
+/*
+ * GLCommand.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_H
+#define LLGL_GL_COMMAND_H
+
+
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/IndexFormat.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Buffer;
+class Texture;
+class BufferArray;
+class ResourceHeap;
+class RenderTarget;
+class RenderContext;
+class RenderPass;
+class GraphicsPipeline;
+class ComputePipeline;
+class Query;
+class QueryHeap;
+
+// Opcodes of the commands that are recorded by a GLDeferredCommandBuffer.
+enum class GLOpcode : std::uint32_t
+{
+    SetGraphicsAPIDependentState,
+    SetViewport,
+    SetViewports,
+    SetScissor,
+    SetScissors,
+    SetClearColor,
+    SetClearDepth,
+    SetClearStencil,
+    Clear,
+    ClearAttachments,
+    SetVertexBuffer,
+    SetVertexBufferOffset,
+    SetVertexBufferArray,
+    SetIndexBuffer,
+    SetIndexBufferOffset,
+    SetStreamOutputBuffer,
+    SetStreamOutputBufferArray,
+    BeginStreamOutput,
+    EndStreamOutput,
+    PauseStreamOutput,
+    ResumeStreamOutput,
+    SetGraphicsResourceHeap,
+    SetComputeResourceHeap,
+    SetConstants,
+    SetRenderTarget,
+    SetRenderContext,
+    BeginRenderPass,
+    EndRenderPass,
+    ResolveRenderTarget,
+    DiscardAttachments,
+    SetGraphicsPipeline,
+    SetComputePipeline,
+    SetShadingRate,
+    SetShadingRateImage,
+    SetStencilReference,
+    SetBlendFactor,
+    SetDepthBias,
+    SetDepthBounds,
+    BeginQuery,
+    EndQuery,
+    BeginRenderCondition,
+    EndRenderCondition,
+    BeginQueryHeap,
+    EndQueryHeap,
+    BeginRenderConditionQueryHeap,
+    ResolveQueries,
+    BeginTimerScope,
+    EndTimerScope,
+    PushDebugGroup,
+    PopDebugGroup,
+    InsertDebugMarker,
+    Draw,
+    DrawInstanced,
+    DrawInstancedBaseInstance,
+    DrawIndexed,
+    DrawIndexedBaseVertex,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedBaseVertex,
+    DrawIndexedInstancedBaseVertexBaseInstance,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    DrawStreamOutput,
+    DrawMeshTasks,
+    Dispatch,
+    DispatchIndirect,
+    DispatchBarrier,
+    CopyBuffer,
+    CopyCounterToBuffer,
+    SetBufferCounter,
+    FillBuffer,
+    CopyTexture,
+    ClearTexture,
+    CopyBufferToTexture,
+    CopyTextureToBuffer,
+};
+
+// Header of each command in the byte stream. The command structure follows directly after the header.
+struct GLCommandHeader
+{
+    GLOpcode        opcode;
+    std::uint32_t   size;   // Size (in bytes) of the entire command including this header
+};
+
+
+/* ----- Command structures ----- */
+
+struct GLCmdGraphicsAPIDependentState
+{
+    OpenGLDependentStateDescriptor  desc;
+};
+
+struct GLCmdViewport
+{
+    Viewport                        viewport;
+};
+
+// Followed by 'numViewports' entries of type 'Viewport'.
+struct GLCmdViewports
+{
+    std::uint32_t                   numViewports;
+};
+
+struct GLCmdScissor
+{
+    Scissor                         scissor;
+};
+
+// Followed by 'numScissors' entries of type 'Scissor'.
+struct GLCmdScissors
+{
+    std::uint32_t                   numScissors;
+};
+
+struct GLCmdClearColor
+{
+    ColorRGBAf                      color;
+};
+
+struct GLCmdClearDepth
+{
+    float                           depth;
+};
+
+struct GLCmdClearStencil
+{
+    std::uint32_t                   stencil;
+};
+
+struct GLCmdClear
+{
+    long                            flags;
+};
+
+// Followed by 'numAttachments' entries of type 'AttachmentClear'.
+struct GLCmdClearAttachments
+{
+    std::uint32_t                   numAttachments;
+};
+
+struct GLCmdBuffer
+{
+    Buffer*                         buffer;
+};
+
+struct GLCmdVertexBufferOffset
+{
+    Buffer*                         buffer;
+    std::uint64_t                   offset;
+};
+
+struct GLCmdIndexBufferOffset
+{
+    Buffer*                         buffer;
+    IndexFormat                     format;
+    std::uint64_t                   offset;
+};
+
+struct GLCmdBufferArray
+{
+    BufferArray*                    bufferArray;
+};
+
+struct GLCmdBeginStreamOutput
+{
+    PrimitiveType                   primitiveType;
+};
+
+// Followed by 'numDynamicOffsets' values of type <std::uint32_t>.
+struct GLCmdResourceHeap
+{
+    ResourceHeap*                   resourceHeap;
+    std::uint32_t                   firstSet;
+    std::uint32_t                   numDynamicOffsets;
+};
+
+// Followed by 'size' bytes of constants.
+struct GLCmdConstants
+{
+    long                            stageFlags;
+    std::uint32_t                   offset;
+    std::uint32_t                   size;
+};
+
+struct GLCmdRenderTarget
+{
+    RenderTarget*                   renderTarget;
+};
+
+struct GLCmdRenderContext
+{
+    RenderContext*                  renderContext;
+};
+
+// Followed by 'numClearValues' entries of type 'ClearValue'. Either 'renderTarget' or 'renderContext' is non-null.
+struct GLCmdBeginRenderPass
+{
+    RenderTarget*                   renderTarget;
+    RenderContext*                  renderContext;
+    const RenderPass*               renderPass;
+    std::uint32_t                   numClearValues;
+};
+
+struct GLCmdResolveRenderTarget
+{
+    RenderTarget*                   srcRenderTarget;
+    Texture*                        dstTexture;
+    std::uint32_t                   srcColorAttachment;
+};
+
+struct GLCmdDiscardAttachments
+{
+    long                            flags;
+};
+
+struct GLCmdGraphicsPipeline
+{
+    GraphicsPipeline*               graphicsPipeline;
+};
+
+struct GLCmdComputePipeline
+{
+    ComputePipeline*                computePipeline;
+};
+
+struct GLCmdSetShadingRate
+{
+    ShadingRate                     rate;
+};
+
+struct GLCmdSetShadingRateImage
+{
+    Texture*                        texture;
+};
+
+struct GLCmdSetStencilReference
+{
+    std::uint32_t                   reference;
+};
+
+struct GLCmdSetBlendFactor
+{
+    ColorRGBAf                      color;
+};
+
+struct GLCmdSetDepthBias
+{
+    DepthBiasDescriptor             depthBias;
+};
+
+struct GLCmdSetDepthBounds
+{
+    float                           minBounds;
+    float                           maxBounds;
+};
+
+struct GLCmdQuery
+{
+    Query*                          query;
+};
+
+struct GLCmdBeginRenderCondition
+{
+    Query*                          query;
+    RenderConditionMode             mode;
+};
+
+struct GLCmdQueryHeap
+{
+    QueryHeap*                      queryHeap;
+    std::uint32_t                   query;
+};
+
+struct GLCmdBeginRenderConditionQueryHeap
+{
+    QueryHeap*                      queryHeap;
+    std::uint32_t                   query;
+    RenderConditionMode             mode;
+};
+
+struct GLCmdResolveQueries
+{
+    QueryHeap*                      queryHeap;
+    std::uint32_t                   firstQuery;
+    std::uint32_t                   numQueries;
+    Buffer*                         dstBuffer;
+    std::uint64_t                   dstOffset;
+};
+
+// Followed by 'nameLength' + 1 characters of the null-terminated scope name.
+struct GLCmdBeginTimerScope
+{
+    std::uint32_t                   nameLength;
+};
+
+// Followed by 'nameLength' + 1 characters of the null-terminated group or marker name.
+struct GLCmdDebugMarker
+{
+    std::uint32_t                   nameLength;
+};
+
+struct GLCmdDraw
+{
+    std::uint32_t                   numVertices;
+    std::uint32_t                   firstVertex;
+    std::uint32_t                   numInstances;
+    std::uint32_t                   firstInstance;
+};
+
+struct GLCmdDrawIndexed
+{
+    std::uint32_t                   numIndices;
+    std::uint32_t                   numInstances;
+    std::uint32_t                   firstIndex;
+    std::int32_t                    vertexOffset;
+    std::uint32_t                   firstInstance;
+};
+
+struct GLCmdDrawIndirect
+{
+    Buffer*                         buffer;
+    std::uint64_t                   offset;
+    std::uint32_t                   numCommands;
+    std::uint32_t                   stride;
+};
+
+struct GLCmdDrawMeshTasks
+{
+    std::uint32_t                   groupSize[3];
+};
+
+struct GLCmdDispatch
+{
+    std::uint32_t                   groupSize[3];
+};
+
+struct GLCmdDispatchIndirect
+{
+    Buffer*                         buffer;
+    std::uint64_t                   offset;
+};
+
+struct GLCmdCopyBuffer
+{
+    Buffer*                         dstBuffer;
+    std::uint64_t                   dstOffset;
+    Buffer*                         srcBuffer;
+    std::uint64_t                   srcOffset;
+    std::uint64_t                   size;
+};
+
+struct GLCmdCopyCounterToBuffer
+{
+    Buffer*                         dstBuffer;
+    std::uint64_t                   dstOffset;
+    Buffer*                         srcBuffer;
+};
+
+struct GLCmdSetBufferCounter
+{
+    Buffer*                         buffer;
+    std::uint32_t                   value;
+};
+
+struct GLCmdFillBuffer
+{
+    Buffer*                         dstBuffer;
+    std::uint64_t                   dstOffset;
+    std::uint64_t                   fillSize;
+    std::uint32_t                   value;
+};
+
+struct GLCmdCopyTexture
+{
+    Texture*                        dstTexture;
+    TextureLocation                 dstLocation;
+    Texture*                        srcTexture;
+    TextureRegion                   srcRegion;
+};
+
+struct GLCmdClearTexture
+{
+    Texture*                        texture;
+    TextureSubresource              subresource;
+    ClearValue                      clearValue;
+};
+
+// Used for both CopyBufferToTexture and CopyTextureToBuffer.
+struct GLCmdCopyBufferTexture
+{
+    Buffer*                         buffer;
+    std::uint64_t                   offset;
+    Texture*                        texture;
+    TextureRegion                   region;
+    std::uint32_t                   rowStride;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,10 +9,16 @@
 #include "GLRenderContext.h"
 #include "../GLCommon/GLTypes.h"
 #include "../GLCommon/GLCore.h"
+#include "../GLCommon/Texture/GLTexSubImage.h"
 #include "Ext/GLExtensions.h"
 #include "Ext/GLExtensionLoader.h"
 #include "../CheckedCast.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <vector>
 #include "../../Core/Assertion.h"
+#include "../../Core/Helper.h"
 
 #include "Shader/GLShaderProgram.h"
 
@@ -29,6 +35,7 @@
 #include "RenderState/GLComputePipeline.h"
 #include "RenderState/GLResourceHeap.h"
 #include "RenderState/GLQuery.h"
+#include "RenderState/GLQueryHeap.h"
 
 
 namespace LLGL
@@ -38,15 +45,41 @@ namespace LLGL
 // Maximal number of viewports for the GL renderer.
 static const std::uint32_t g_maxNumViewportsGL = 16;
 
-GLCommandBuffer::GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateMngr) :
-    stateMngr_ { stateMngr }
+const std::uint32_t GLCommandBuffer::maxConstantsSize;
+
+GLCommandBuffer::GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateMngr, StatisticsCounter& statistics, long flags) :
+    stateMngr_  { stateMngr  },
+    statistics_ { statistics }
+{
+    if ((flags & CommandBufferFlags::MultiDrawBatching) != 0)
+        drawBatch_ = MakeUnique<GLDrawBatch>(*stateMngr_);
+
+    #ifdef LLGL_OPENGL
+    if ((flags & CommandBufferFlags::TimerScopeStatistics) != 0)
+        timerStatistics_ = HasExtension(GLExt::ARB_pipeline_statistics_query);
+    #endif
+}
+
+GLCommandBuffer::~GLCommandBuffer()
 {
+    /* Submit pending draw commands before the draw batch is released */
+    if (drawBatch_)
+        stateMngr_->FlushPendingDrawBatch();
+    if (!timestampQueries_.empty())
+        glDeleteQueries(static_cast<GLsizei>(timestampQueries_.size()), timestampQueries_.data());
+    if (constantsBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &constantsBuffer_);
+        stateMngr_->NotifyBufferRelease(constantsBuffer_, GLBufferTarget::UNIFORM_BUFFER);
+    }
 }
 
 /* ----- Configuration ----- */
 
 void GLCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
 {
+    FlushDrawBatch();
+
     if (stateDesc != nullptr && stateDescSize == sizeof(OpenGLDependentStateDescriptor))
     {
         stateMngr_->SetGraphicsAPIDependentState(
@@ -59,6 +92,8 @@ void GLCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::s
 
 void GLCommandBuffer::SetViewport(const Viewport& viewport)
 {
+    FlushDrawBatch();
+
     /* Setup GL viewport and depth-range */
     GLViewport viewportGL { viewport.x, viewport.y, viewport.width, viewport.height };
     GLDepthRange depthRangeGL { viewport.minDepth, viewport.maxDepth };
@@ -70,6 +105,8 @@ void GLCommandBuffer::SetViewport(const Viewport& viewport)
 
 void GLCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
+    FlushDrawBatch();
+
     GLViewport viewportsGL[g_maxNumViewportsGL];
     GLDepthRange depthRangesGL[g_maxNumViewportsGL];
 
@@ -81,14 +118,16 @@ void GLCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* v
         for (std::uint32_t i = 0; i < n; ++i)
         {
             /* Copy GL viewport data */
-            viewportsGL[i].x        = viewports[i].x;
-            viewportsGL[i].y        = viewports[i].y;
-            viewportsGL[i].width    = viewports[i].width;
-            viewportsGL[i].height   = viewports[i].height;
+            const auto& src = viewports[offset + i];
+
+            viewportsGL[i].x        = src.x;
+            viewportsGL[i].y        = src.y;
+            viewportsGL[i].width    = src.width;
+            viewportsGL[i].height   = src.height;
 
             /* Copy GL depth-range data */
-            depthRangesGL[i].minDepth = static_cast<GLdouble>(viewports[i].minDepth);
-            depthRangesGL[i].maxDepth = static_cast<GLdouble>(viewports[i].maxDepth);
+            depthRangesGL[i].minDepth = static_cast<GLdouble>(src.minDepth);
+            depthRangesGL[i].maxDepth = static_cast<GLdouble>(src.maxDepth);
         }
 
         /* Submit viewports and depth-ranges to state manager */
@@ -99,6 +138,8 @@ void GLCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* v
 
 void GLCommandBuffer::SetScissor(const Scissor& scissor)
 {
+    FlushDrawBatch();
+
     /* Setup and submit GL scissor to state manager */
     GLScissor scissorGL { scissor.x, scissor.y, scissor.width, scissor.height };
     stateMngr_->SetScissor(scissorGL);
@@ -106,6 +147,8 @@ void GLCommandBuffer::SetScissor(const Scissor& scissor)
 
 void GLCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
+    FlushDrawBatch();
+
     GLScissor scissorsGL[g_maxNumViewportsGL];
 
     for (std::uint32_t offset = 0; offset < numScissors; offset += g_maxNumViewportsGL)
@@ -116,10 +159,12 @@ void GLCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scis
         for (std::uint32_t i = 0; i < n; ++i)
         {
             /* Copy GL scissor data */
-            scissorsGL[i].x         = static_cast<GLint>(scissors[i].x);
-            scissorsGL[i].y         = static_cast<GLint>(scissors[i].y);
-            scissorsGL[i].width     = static_cast<GLsizei>(scissors[i].width);
-            scissorsGL[i].height    = static_cast<GLsizei>(scissors[i].height);
+            const auto& src = scissors[offset + i];
+
+            scissorsGL[i].x         = static_cast<GLint>(src.x);
+            scissorsGL[i].y         = static_cast<GLint>(src.y);
+            scissorsGL[i].width     = static_cast<GLsizei>(src.width);
+            scissorsGL[i].height    = static_cast<GLsizei>(src.height);
         }
 
         /* Submit scissors to state manager */
@@ -132,21 +177,26 @@ void GLCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scis
 void GLCommandBuffer::SetClearColor(const ColorRGBAf& color)
 {
     glClearColor(color.r, color.g, color.b, color.a);
+    clearValue_.color = color;
 }
 
 void GLCommandBuffer::SetClearDepth(float depth)
 {
     glClearDepth(depth);
+    clearValue_.depth = depth;
 }
 
 void GLCommandBuffer::SetClearStencil(std::uint32_t stencil)
 {
     glClearStencil(static_cast<GLint>(stencil));
+    clearValue_.stencil = stencil;
 }
 
 //TODO: maybe glColorMask must be set to (1, 1, 1, 1) to clear color correctly
 void GLCommandBuffer::Clear(long flags)
 {
+    FlushDrawBatch();
+
     /* Setup GL clear mask and clear respective buffer */
     GLbitfield mask = 0;
 
@@ -159,6 +209,7 @@ void GLCommandBuffer::Clear(long flags)
     if ((flags & ClearFlags::Depth) != 0)
     {
         stateMngr_->SetDepthMask(GL_TRUE);
+        stateMngr_->InvalidateStateGroup(GLStateGroup::DEPTH);
         mask |= GL_DEPTH_BUFFER_BIT;
     }
 
@@ -174,6 +225,8 @@ void GLCommandBuffer::Clear(long flags)
 //TODO: maybe glColorMask must be set to (1, 1, 1, 1) to clear color correctly
 void GLCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    FlushDrawBatch();
+
     for (; numAttachments-- > 0; ++attachments)
     {
         if ((attachments->flags & ClearFlags::Color) != 0)
@@ -213,20 +266,46 @@ void GLCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 
 void GLCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     /* Bind vertex buffer */
     auto& vertexBufferGL = LLGL_CAST(GLVertexBuffer&, buffer);
-    stateMngr_->BindVertexArray(vertexBufferGL.GetVaoID());
+    vertexBufferGL.BindVertexArray(*stateMngr_);
+
+    /* Store stream-output buffer for DrawStreamOutput */
+    soVertexBuffer_ = (buffer.GetType() == BufferType::StreamOutput ? &vertexBufferGL : nullptr);
+}
+
+void GLCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    /* Bind vertex buffer with offset to shared VAO */
+    auto& vertexBufferGL = LLGL_CAST(GLVertexBuffer&, buffer);
+    vertexBufferGL.BindVertexArray(*stateMngr_, static_cast<GLintptr>(offset));
+
+    soVertexBuffer_ = (buffer.GetType() == BufferType::StreamOutput ? &vertexBufferGL : nullptr);
 }
 
 void GLCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     /* Bind vertex buffer */
     auto& vertexBufferArrayGL = LLGL_CAST(GLVertexBufferArray&, bufferArray);
-    stateMngr_->BindVertexArray(vertexBufferArrayGL.GetVaoID());
+    vertexBufferArrayGL.BindVertexArray(*stateMngr_);
+
+    soVertexBuffer_ = nullptr;
 }
 
 void GLCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& indexBufferGL = LLGL_CAST(GLIndexBuffer&, buffer);
     stateMngr_->BindElementArrayBufferToVAO(indexBufferGL.GetID());
@@ -235,31 +314,101 @@ void GLCommandBuffer::SetIndexBuffer(Buffer& buffer)
     const auto& format = indexBufferGL.GetIndexFormat();
     renderState_.indexBufferDataType    = GLTypes::Map(format.GetDataType());
     renderState_.indexBufferStride      = static_cast<GLsizeiptr>(format.GetFormatSize());
+    renderState_.indexBufferFirstIndex  = 0;
+}
+
+void GLCommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    /* Bind index buffer deferred (can only be bound to the active VAO) */
+    auto& indexBufferGL = LLGL_CAST(GLIndexBuffer&, buffer);
+    stateMngr_->BindElementArrayBufferToVAO(indexBufferGL.GetID());
+
+    /* Store offset as first index, so it is also applied to batched draw commands */
+    renderState_.indexBufferDataType    = GLTypes::Map(format.GetDataType());
+    renderState_.indexBufferStride      = static_cast<GLsizeiptr>(format.GetFormatSize());
+    renderState_.indexBufferFirstIndex  = static_cast<GLuint>(offset / format.GetFormatSize());
 }
 
 /* ----- Constant Buffers ------ */
 
 void GLCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     SetGenericBuffer(GLBufferTarget::UNIFORM_BUFFER, buffer, slot);
 }
 
+void GLCommandBuffer::SetConstantBufferRange(Buffer& buffer, std::uint32_t slot, std::uint64_t offset, std::uint64_t size, long /*stageFlags*/)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBufferRange(
+        GLBufferTarget::UNIFORM_BUFFER,
+        slot,
+        bufferGL.GetID(),
+        static_cast<GLintptr>(bufferGL.GetRegionOffset() + offset),
+        static_cast<GLsizeiptr>(size)
+    );
+}
+
 /* ----- Storage Buffers ------ */
 
 void GLCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
+
+    /* Bind hidden counter of append and consume buffers to the atomic counter buffer of the same slot */
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    if (auto counterID = bufferGL.GetCounterID())
+        stateMngr_->BindBufferBase(GLBufferTarget::ATOMIC_COUNTER_BUFFER, slot, counterID);
 }
 
 /* ----- Stream Output Buffers ------ */
 
 void GLCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    /* Bind transform feedback object of this buffer first, since it holds the transform feedback buffer bindings */
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    #ifdef GL_ARB_transform_feedback2
+    if (auto transformFeedbackID = bufferGL.GetTransformFeedbackID())
+    {
+        stateMngr_->BindTransformFeedback(transformFeedbackID);
+        bufferGL.SetStreamOutputSource(transformFeedbackID, 0);
+    }
+    #endif
+
     SetGenericBuffer(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, buffer, 0);
 }
 
 void GLCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    /* Bind transform feedback object of the first buffer, and record the vertex stream of each buffer by its array index */
+    #ifdef GL_ARB_transform_feedback2
+    auto& bufferArrayGL = LLGL_CAST(GLBufferArray&, bufferArray);
+    const auto& buffers = bufferArrayGL.GetBufferArray();
+    if (auto transformFeedbackID = buffers.front()->GetTransformFeedbackID())
+    {
+        stateMngr_->BindTransformFeedback(transformFeedbackID);
+        for (std::size_t i = 0; i < buffers.size(); ++i)
+            buffers[i]->SetStreamOutputSource(transformFeedbackID, static_cast<GLuint>(i));
+    }
+    #endif
+
     SetGenericBufferArray(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, bufferArray, 0);
 }
 
@@ -275,6 +424,8 @@ static void ErrTransformFeedbackNotSupported(const char* funcName)
 
 void GLCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    FlushDrawBatch();
+
     #ifdef __APPLE__
     glBeginTransformFeedback(GLTypes::Map(primitiveType));
     #else
@@ -289,6 +440,8 @@ void GLCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 
 void GLCommandBuffer::EndStreamOutput()
 {
+    FlushDrawBatch();
+
     #ifdef __APPLE__
     glEndTransformFeedback();
     #else
@@ -301,10 +454,37 @@ void GLCommandBuffer::EndStreamOutput()
     #endif
 }
 
+void GLCommandBuffer::PauseStreamOutput()
+{
+    FlushDrawBatch();
+
+    #ifdef GL_ARB_transform_feedback2
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glPauseTransformFeedback();
+    else
+    #endif
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_transform_feedback2");
+}
+
+void GLCommandBuffer::ResumeStreamOutput()
+{
+    FlushDrawBatch();
+
+    #ifdef GL_ARB_transform_feedback2
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glResumeTransformFeedback();
+    else
+    #endif
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_transform_feedback2");
+}
+
 /* ----- Textures ----- */
 
 void GLCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     /* Bind texture to layer */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     stateMngr_->ActiveTexture(slot);
@@ -315,20 +495,175 @@ void GLCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long /*st
 
 void GLCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
     auto& samplerGL = LLGL_CAST(GLSampler&, sampler);
     stateMngr_->BindSampler(slot, samplerGL.GetID());
 }
 
 /* ----- Resource Heaps ----- */
 
-void GLCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
+void GLCommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    SetResourceHeap(resourceHeap, numDynamicOffsets, dynamicOffsets);
+}
+
+void GLCommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           /*firstSet*/,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+    FlushDrawBatch();
+
+    SetResourceHeap(resourceHeap, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constants ----- */
+
+void GLCommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    FlushDrawBatch();
+
+    auto& constants = ((stageFlags & StageFlags::ComputeStage) != 0 ? computeConstants_ : graphicsConstants_);
+
+    /* Update shadow copy and upload all constants, since a uniform buffer range cannot be updated partially */
+    if (offset + size <= std::min(constants.layout.size, maxConstantsSize))
+    {
+        ::memcpy(constants.data + offset, data, size);
+        UploadConstants(constants);
+    }
+}
+
+//private
+void GLCommandBuffer::UploadConstants(const ConstantsState& constants)
+{
+    static const GLsizeiptr constantsBufferSize = 65536;
+
+    if (constantsBuffer_ == 0)
+    {
+        /* Generate hidden uniform buffer with the first constants */
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        constantsAlignment_ = std::max<GLintptr>(alignment, 4);
+
+        glGenBuffers(1, &constantsBuffer_);
+        stateMngr_->BindBuffer(GLBufferTarget::UNIFORM_BUFFER, constantsBuffer_);
+        glBufferData(GL_UNIFORM_BUFFER, constantsBufferSize, nullptr, GL_STREAM_DRAW);
+    }
+    else
+        stateMngr_->BindBuffer(GLBufferTarget::UNIFORM_BUFFER, constantsBuffer_);
+
+    /* Orphan buffer storage when the ring is full, so the GL does not wait for draw calls that still read the previous ranges */
+    const auto size = static_cast<GLsizeiptr>(constants.layout.size);
+    if (constantsOffset_ + size > constantsBufferSize)
+    {
+        glBufferData(GL_UNIFORM_BUFFER, constantsBufferSize, nullptr, GL_STREAM_DRAW);
+        constantsOffset_ = 0;
+    }
+
+    /* Write constants into next range and bind that range to the slot of the constants */
+    glBufferSubData(GL_UNIFORM_BUFFER, constantsOffset_, size, constants.data);
+    stateMngr_->BindBufferRange(GLBufferTarget::UNIFORM_BUFFER, constants.layout.slot, constantsBuffer_, constantsOffset_, size);
+
+    constantsOffset_ += ((size + constantsAlignment_ - 1) / constantsAlignment_) * constantsAlignment_;
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation GLCommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    if (size == 0)
+        throw std::out_of_range("cannot allocate transient memory of zero size");
+
+    if (transientRing_.GetSize() == 0)
+        CreateTransientBuffer();
+
+    if (alignment == 0)
+        alignment = static_cast<std::uint64_t>(constantsAlignment_);
+
+    /* Wait for the oldest submissions while the ring is full */
+    std::uint64_t offset = 0;
+    auto waitForSubmission = [this](std::uint64_t submission)
+    {
+        transientFence_.WaitValue(submission, ~0ull);
+    };
+
+    if (!transientRing_.AllocateOrWait(size, alignment, offset, waitForSubmission))
+        throw std::out_of_range("transient memory allocations since the last submission exceed the ring buffer of the command buffer");
+
+    /* Record range of CPU shadow, which is uploaded before the next draw or dispatch command */
+    if (!transientShadow_.empty())
+    {
+        const auto writeOffset  = static_cast<GLintptr>(offset);
+        const auto writeSize    = static_cast<GLsizeiptr>(size);
+
+        if (!transientWrites_.empty() && transientWrites_.back().offset + transientWrites_.back().size <= writeOffset)
+            transientWrites_.back().size = writeOffset + writeSize - transientWrites_.back().offset;
+        else
+            transientWrites_.push_back({ writeOffset, writeSize });
+    }
+
+    TransientAllocation allocation;
+    {
+        allocation.data     = transientData_ + offset;
+        allocation.buffer   = transientBuffer_.get();
+        allocation.offset   = offset;
+    }
+    return allocation;
+}
+
+//private
+void GLCommandBuffer::CreateTransientBuffer()
 {
-    SetResourceHeap(resourceHeap);
+    const auto bufferSize = static_cast<GLsizeiptr>(g_transientRingSize);
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    constantsAlignment_ = std::max<GLintptr>(alignment, 4);
+
+    transientBuffer_ = MakeUnique<GLBuffer>(BufferType::Constant);
+    stateMngr_->BindBuffer(*transientBuffer_);
+
+    #ifdef GL_ARB_buffer_storage
+    if (HasExtension(GLExt::ARB_buffer_storage))
+    {
+        /* Allocate immutable storage, which remains mapped for the entire lifetime of the command buffer */
+        const GLbitfield flagsGL = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        glBufferStorage(GL_UNIFORM_BUFFER, bufferSize, nullptr, flagsGL);
+        transientData_ = reinterpret_cast<char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, bufferSize, flagsGL));
+
+        if (!transientData_)
+            throw std::runtime_error("failed to map GL transient ring buffer persistently");
+    }
+    else
+    #endif // /GL_ARB_buffer_storage
+    {
+        /* Allocate mutable storage and write into a CPU shadow, which is uploaded before each draw or dispatch command */
+        glBufferData(GL_UNIFORM_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+        transientShadow_.resize(static_cast<std::size_t>(g_transientRingSize));
+        transientData_ = transientShadow_.data();
+    }
+
+    transientRing_.Reset(g_transientRingSize);
 }
 
-void GLCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
+//private
+void GLCommandBuffer::UploadTransientWrites()
 {
-    SetResourceHeap(resourceHeap);
+    stateMngr_->BindBuffer(*transientBuffer_);
+    for (const auto& write : transientWrites_)
+        glBufferSubData(GL_UNIFORM_BUFFER, write.offset, write.size, transientData_ + write.offset);
+    transientWrites_.clear();
 }
 
 /* ----- Render Targets ----- */
@@ -336,12 +671,103 @@ void GLCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::ui
 //private
 void GLCommandBuffer::BlitBoundRenderTarget()
 {
-    if (boundRenderTarget_)
+    if (boundRenderTarget_ && resolvePending_)
         boundRenderTarget_->BlitOntoFramebuffer();
 }
 
+//private
+void GLCommandBuffer::BeginRenderPassWithState(const RenderPassState& state, std::uint32_t numClearValues, const ClearValue* clearValues)
+{
+    renderPassState_ = state;
+
+    /* Invalidate all attachments whose previous content is not loaded */
+    InvalidateRenderPassAttachments(true);
+
+    /* Clear all attachments with clear operation; clear values are consumed in the order of these attachments */
+    const auto& desc = state.renderPass->GetDesc();
+
+    std::uint32_t clearValueIndex = 0;
+
+    auto NextClearValue = [&]() -> const ClearValue&
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : clearValue_);
+    };
+
+    for (std::uint32_t i = 0; i < state.numColorAttachments; ++i)
+    {
+        if (state.renderPass->GetColorAttachmentOps(i).loadOp == AttachmentLoadOp::Clear)
+            glClearBufferfv(GL_COLOR, static_cast<GLint>(i), NextClearValue().color.Ptr());
+    }
+
+    const bool clearDepth   = (state.hasDepthAttachment && desc.depthAttachment.loadOp == AttachmentLoadOp::Clear);
+    const bool clearStencil = (state.hasStencilAttachment && desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear);
+
+    if (clearDepth || clearStencil)
+    {
+        /* Depth and stencil components share a single clear value */
+        const auto& clearValue = NextClearValue();
+        const auto stencil = static_cast<GLint>(clearValue.stencil);
+
+        if (clearDepth)
+        {
+            stateMngr_->SetDepthMask(GL_TRUE);
+            stateMngr_->InvalidateStateGroup(GLStateGroup::DEPTH);
+        }
+
+        if (clearDepth && clearStencil)
+            glClearBufferfi(GL_DEPTH_STENCIL, 0, clearValue.depth, stencil);
+        else if (clearDepth)
+            glClearBufferfv(GL_DEPTH, 0, &(clearValue.depth));
+        else
+            glClearBufferiv(GL_STENCIL, 0, &stencil);
+    }
+}
+
+//private
+void GLCommandBuffer::InvalidateRenderPassAttachments(bool loadOps)
+{
+    #ifndef __APPLE__
+
+    if (!HasExtension(GLExt::ARB_invalidate_subdata))
+        return;
+
+    const auto& state = renderPassState_;
+    const auto& desc = state.renderPass->GetDesc();
+
+    auto IsUndefined = [loadOps](const AttachmentOpsDescriptor& ops)
+    {
+        return (loadOps ? ops.loadOp == AttachmentLoadOp::Undefined : ops.storeOp == AttachmentStoreOp::Undefined);
+    };
+
+    /* Gather all attachments with undefined content (the default framebuffer uses different attachment names) */
+    static const std::uint32_t maxNumColorAttachments = 32;
+
+    GLenum attachments[maxNumColorAttachments + 2];
+    GLsizei numAttachments = 0;
+
+    for (std::uint32_t i = 0, n = std::min(state.numColorAttachments, maxNumColorAttachments); i < n; ++i)
+    {
+        if (IsUndefined(state.renderPass->GetColorAttachmentOps(i)))
+            attachments[numAttachments++] = (state.defaultFramebuffer ? GL_COLOR : GL_COLOR_ATTACHMENT0 + i);
+    }
+
+    if (state.hasDepthAttachment && IsUndefined(desc.depthAttachment))
+        attachments[numAttachments++] = (state.defaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT);
+
+    if (state.hasStencilAttachment && IsUndefined(desc.stencilAttachment))
+        attachments[numAttachments++] = (state.defaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT);
+
+    if (numAttachments > 0)
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, numAttachments, attachments);
+
+    #endif // /__APPLE__
+}
+
 void GLCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+    FlushDrawBatch();
+
     /* Blit previously bound render target (in case mutli-sampling is used) */
     BlitBoundRenderTarget();
 
@@ -353,13 +779,17 @@ void GLCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
     stateMngr_->NotifyRenderTargetHeight(static_cast<GLint>(renderTarget.GetResolution().height));
 
     /* Store current render target */
-    boundRenderTarget_ = &renderTargetGL;
+    boundRenderTarget_  = &renderTargetGL;
+    resolvePending_     = true;
 
     //TODO: maybe use 'glClipControl(GL_UPPER_LEFT, GL_ZERO_TO_ONE)' to allow better compatibility to D3D
 }
 
 void GLCommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    LLGL_STATISTICS_INC(renderPasses);
+    FlushDrawBatch();
+
     auto& renderContextGL = LLGL_CAST(GLRenderContext&, renderContext);
 
     /* Blit previously bound render target (in case mutli-sampling is used) */
@@ -377,105 +807,347 @@ void GLCommandBuffer::SetRenderTarget(RenderContext& renderContext)
     /* Reset reference to render target */
     boundRenderTarget_ = nullptr;
 
-    //TODO: maybe use 'glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE)' to allow better compatibility to D3D
-}
-
-/* ----- Pipeline States ----- */
-
-void GLCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
-{
-    /* Set graphics pipeline render states */
-    auto& graphicsPipelineGL = LLGL_CAST(GLGraphicsPipeline&, graphicsPipeline);
-    graphicsPipelineGL.Bind(*stateMngr_);
+    /* Track presentations of this render context to determine the end of each timer scope frame */
+    if (timerRenderContext_ != &renderContextGL)
+    {
+        UpdateTimerScopeFrame();
+        timerRenderContext_ = &renderContextGL;
+        timerPresentCount_  = renderContextGL.GetPresentCount();
+    }
 
-    /* Store draw modes */
-    renderState_.drawMode = graphicsPipelineGL.GetDrawMode();
+    //TODO: maybe use 'glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE)' to allow better compatibility to D3D
 }
 
-void GLCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+void GLCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
 {
-    auto& computePipelineGL = LLGL_CAST(GLComputePipeline&, computePipeline);
-    computePipelineGL.Bind(*stateMngr_);
-}
+    FlushDrawBatch();
 
-/* ----- Queries ----- */
+    auto& renderTargetGL = LLGL_CAST(GLRenderTarget&, renderTarget);
 
-void GLCommandBuffer::BeginQuery(Query& query)
-{
-    /* Begin query with internal target */
-    auto& queryGL = LLGL_CAST(GLQuery&, query);
-    queryGL.Begin();
-}
+    SetRenderTarget(renderTarget);
 
-void GLCommandBuffer::EndQuery(Query& query)
-{
-    /* Begin query with internal target */
-    auto& queryGL = LLGL_CAST(GLQuery&, query);
-    queryGL.End();
+    if (renderPass != nullptr)
+    {
+        RenderPassState state;
+        {
+            state.renderPass                = renderPass;
+            state.numColorAttachments       = renderTargetGL.GetNumColorAttachments();
+            state.hasDepthAttachment        = renderTargetGL.HasDepthAttachment();
+            state.hasStencilAttachment      = renderTargetGL.HasStencilAttachment();
+            state.defaultFramebuffer        = false;
+            state.invalidateOnEnd           = !renderTargetGL.HasMultiSampleFramebuffer();
+        }
+        BeginRenderPassWithState(state, numClearValues, clearValues);
+    }
 }
 
-bool GLCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+void GLCommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
 {
-    auto& queryGL = LLGL_CAST(GLQuery&, query);
+    FlushDrawBatch();
 
-    /* Check if query result is available */
-    GLint available = 0;
-    glGetQueryObjectiv(queryGL.GetFirstID(), GL_QUERY_RESULT_AVAILABLE, &available);
+    SetRenderTarget(renderContext);
 
-    if (available != GL_FALSE)
+    if (renderPass != nullptr)
     {
-        if (HasExtension(GLExt::ARB_timer_query))
-        {
-            /* Get query result with 64-bit version */
-            glGetQueryObjectui64v(queryGL.GetFirstID(), GL_QUERY_RESULT, &result);
-        }
-        else
+        const auto& videoMode = renderContext.GetVideoMode();
+        RenderPassState state;
         {
-            /* Get query result with 32-bit version and convert to 64-bit */
-            GLuint result32 = 0;
-            glGetQueryObjectuiv(queryGL.GetFirstID(), GL_QUERY_RESULT, &result32);
-            result = result32;
+            state.renderPass                = renderPass;
+            state.numColorAttachments       = 1;
+            state.hasDepthAttachment        = (videoMode.depthBits > 0);
+            state.hasStencilAttachment      = (videoMode.stencilBits > 0);
+            state.defaultFramebuffer        = true;
+            state.invalidateOnEnd           = true;
         }
-        return true;
+        BeginRenderPassWithState(state, numClearValues, clearValues);
     }
-
-    return false;
 }
 
-bool GLCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+void GLCommandBuffer::EndRenderPass()
 {
-    auto& queryGL = LLGL_CAST(GLQuery&, query);
+    FlushDrawBatch();
 
-    if (HasExtension(GLExt::ARB_pipeline_statistics_query))
+    /* Invalidate all attachments whose content is not stored */
+    if (renderPassState_.renderPass != nullptr)
     {
-        /* Check if query result is available for all query objects */
-        GLint available = 0;
-        for (auto id : queryGL.GetIDs())
+        if (!renderPassState_.invalidateOnEnd)
         {
-            glGetQueryObjectiv(id, GL_QUERY_RESULT_AVAILABLE, &available);
-            if (available == GL_FALSE)
-                return false;
-        }
+            /* Multi-sample render target does not need to be resolved if the content of all its color attachments is undefined */
+            bool storeColor = false;
 
-        /* Parameter setup for 32-bit and 64-bit version of query function */
-        static const std::size_t memberCount = sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t);
+            for (std::uint32_t i = 0; i < renderPassState_.numColorAttachments && !storeColor; ++i)
+                storeColor = (renderPassState_.renderPass->GetColorAttachmentOps(i).storeOp != AttachmentStoreOp::Undefined);
 
-        union
-        {
-            GLuint      ui32;
-            GLuint64    ui64;
+            if (!storeColor)
+                resolvePending_ = false;
         }
-        params[memberCount];
 
-        const auto numResults = std::min(queryGL.GetIDs().size(), memberCount);
+        if (renderPassState_.invalidateOnEnd || !resolvePending_)
+            InvalidateRenderPassAttachments(false);
 
-        if (HasExtension(GLExt::ARB_timer_query))
-        {
-            /* Get query result with 64-bit version */
-            for (std::size_t i = 0; i < numResults; ++i)
-            {
-                params[i].ui64 = 0;
-                glGetQueryObjectui64v(queryGL.GetIDs()[i], GL_QUERY_RESULT, &(params[i].ui64));
+        renderPassState_.renderPass = nullptr;
+    }
+
+    /* Invalidate transient attachments, whose content does not outlive the render pass (multi-sample render targets are resolved into them later) */
+    if (boundRenderTarget_ != nullptr && !boundRenderTarget_->HasMultiSampleFramebuffer())
+        boundRenderTarget_->InvalidateTransientAttachments();
+}
+
+void GLCommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    FlushDrawBatch();
+
+    auto& srcRenderTargetGL = LLGL_CAST(GLRenderTarget&, srcRenderTarget);
+    auto& dstTextureGL      = LLGL_CAST(const GLTexture&, dstTexture);
+
+    srcRenderTargetGL.ResolveColorAttachment(srcColorAttachment, dstTextureGL);
+
+    /* Restore framebuffer of the active render target */
+    stateMngr_->BindFramebuffer(
+        GLFramebufferTarget::DRAW_FRAMEBUFFER,
+        (boundRenderTarget_ != nullptr ? boundRenderTarget_->GetFramebuffer().GetID() : 0)
+    );
+}
+
+void GLCommandBuffer::DiscardAttachments(long flags)
+{
+    FlushDrawBatch();
+
+    /* Discarded color attachments of a multi-sample render target are not resolved */
+    if ((flags & ClearFlags::Color) != 0)
+        resolvePending_ = false;
+
+    #ifndef __APPLE__
+
+    if (!HasExtension(GLExt::ARB_invalidate_subdata))
+        return;
+
+    /* Gather all attachments of the bound framebuffer (the default framebuffer uses different attachment names) */
+    static const std::uint32_t maxNumColorAttachments = 32;
+
+    const bool defaultFramebuffer = (boundRenderTarget_ == nullptr);
+
+    GLenum attachments[maxNumColorAttachments + 2];
+    GLsizei numAttachments = 0;
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        if (defaultFramebuffer)
+            attachments[numAttachments++] = GL_COLOR;
+        else
+        {
+            for (std::uint32_t i = 0, n = std::min(boundRenderTarget_->GetNumColorAttachments(), maxNumColorAttachments); i < n; ++i)
+                attachments[numAttachments++] = GL_COLOR_ATTACHMENT0 + i;
+        }
+    }
+
+    if ((flags & ClearFlags::Depth) != 0)
+        attachments[numAttachments++] = (defaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT);
+
+    if ((flags & ClearFlags::Stencil) != 0)
+        attachments[numAttachments++] = (defaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT);
+
+    if (numAttachments > 0)
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, numAttachments, attachments);
+
+    #endif // /__APPLE__
+}
+
+/* ----- Pipeline States ----- */
+
+void GLCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    LLGL_STATISTICS_INC(pipelineBindings);
+    FlushDrawBatch();
+
+    /* Set graphics pipeline render states */
+    auto& graphicsPipelineGL = LLGL_CAST(GLGraphicsPipeline&, graphicsPipeline);
+    graphicsPipelineGL.Bind(*stateMngr_);
+
+    /* Store draw modes */
+    renderState_.drawMode = graphicsPipelineGL.GetDrawMode();
+
+    /* Store layout of constants */
+    graphicsConstants_.layout = graphicsPipelineGL.GetConstants();
+}
+
+void GLCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    LLGL_STATISTICS_INC(pipelineBindings);
+    FlushDrawBatch();
+
+    auto& computePipelineGL = LLGL_CAST(GLComputePipeline&, computePipeline);
+    computePipelineGL.Bind(*stateMngr_);
+
+    /* Store layout of constants */
+    computeConstants_.layout = computePipelineGL.GetConstants();
+}
+
+void GLCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    FlushDrawBatch();
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (HasExtension(GLExt::NV_shading_rate_image))
+    {
+        shadingRate_ = rate;
+        if (shadingRateImage_ == 0)
+            UpdateShadingRatePalette();
+    }
+    else
+    #endif
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_NV_shading_rate_image");
+}
+
+void GLCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    FlushDrawBatch();
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (HasExtension(GLExt::NV_shading_rate_image))
+    {
+        if (texture != nullptr)
+        {
+            auto& textureGL = LLGL_CAST(GLTexture&, *texture);
+            shadingRateImage_ = textureGL.GetID();
+        }
+        else
+            shadingRateImage_ = 0;
+
+        glBindShadingRateImageNV(shadingRateImage_);
+        UpdateShadingRatePalette();
+    }
+    else
+    #endif
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_NV_shading_rate_image");
+}
+
+void GLCommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    FlushDrawBatch();
+    stateMngr_->SetStencilRef(static_cast<GLint>(reference));
+
+    /* Invalidate state group, so the next pipeline with a static stencil reference applies it again */
+    stateMngr_->InvalidateStateGroup(GLStateGroup::STENCIL);
+}
+
+void GLCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    FlushDrawBatch();
+    stateMngr_->SetBlendColor(color);
+
+    /* Invalidate state group, so the next pipeline with a static blend factor applies it again */
+    stateMngr_->InvalidateStateGroup(GLStateGroup::BLEND);
+}
+
+void GLCommandBuffer::SetDepthBias(const DepthBiasDescriptor& depthBias)
+{
+    FlushDrawBatch();
+    stateMngr_->SetPolygonOffset(depthBias.slopeFactor, depthBias.constantFactor, depthBias.clamp);
+
+    /* Invalidate state group, so the next pipeline with a static depth bias applies it again */
+    stateMngr_->InvalidateStateGroup(GLStateGroup::RASTERIZER);
+}
+
+void GLCommandBuffer::SetDepthBounds(float minBounds, float maxBounds)
+{
+    FlushDrawBatch();
+    stateMngr_->SetDepthBounds(minBounds, maxBounds);
+
+    /* Invalidate state group, so the next pipeline with static depth bounds applies them again */
+    stateMngr_->InvalidateStateGroup(GLStateGroup::DEPTH);
+}
+
+/* ----- Queries ----- */
+
+void GLCommandBuffer::BeginQuery(Query& query)
+{
+    FlushDrawBatch();
+
+    /* Begin query with internal target */
+    auto& queryGL = LLGL_CAST(GLQuery&, query);
+    queryGL.Begin();
+}
+
+void GLCommandBuffer::EndQuery(Query& query)
+{
+    FlushDrawBatch();
+
+    /* Begin query with internal target */
+    auto& queryGL = LLGL_CAST(GLQuery&, query);
+    queryGL.End();
+}
+
+bool GLCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    auto& queryGL = LLGL_CAST(GLQuery&, query);
+
+    /* Check if query result is available */
+    GLint available = 0;
+    glGetQueryObjectiv(queryGL.GetFirstID(), GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (available != GL_FALSE)
+    {
+        if (HasExtension(GLExt::ARB_timer_query))
+        {
+            /* Get query result with 64-bit version */
+            glGetQueryObjectui64v(queryGL.GetFirstID(), GL_QUERY_RESULT, &result);
+        }
+        else
+        {
+            /* Get query result with 32-bit version and convert to 64-bit */
+            GLuint result32 = 0;
+            glGetQueryObjectuiv(queryGL.GetFirstID(), GL_QUERY_RESULT, &result32);
+            result = result32;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool GLCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    auto& queryGL = LLGL_CAST(GLQuery&, query);
+
+    if (HasExtension(GLExt::ARB_pipeline_statistics_query))
+    {
+        /* Check if query result is available for all query objects */
+        GLint available = 0;
+        for (auto id : queryGL.GetIDs())
+        {
+            glGetQueryObjectiv(id, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == GL_FALSE)
+                return false;
+        }
+
+        /* Parameter setup for 32-bit and 64-bit version of query function */
+        static const std::size_t memberCount = sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t);
+
+        union
+        {
+            GLuint      ui32;
+            GLuint64    ui64;
+        }
+        params[memberCount];
+
+        const auto numResults = std::min(queryGL.GetIDs().size(), memberCount);
+
+        if (HasExtension(GLExt::ARB_timer_query))
+        {
+            /* Get query result with 64-bit version */
+            for (std::size_t i = 0; i < numResults; ++i)
+            {
+                params[i].ui64 = 0;
+                glGetQueryObjectui64v(queryGL.GetIDs()[i], GL_QUERY_RESULT, &(params[i].ui64));
             }
         }
         else
@@ -517,85 +1189,350 @@ bool GLCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineS
 
 void GLCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
 {
+    FlushDrawBatch();
+
     auto& queryGL = LLGL_CAST(GLQuery&, query);
     glBeginConditionalRender(queryGL.GetFirstID(), GLTypes::Map(mode));
 }
 
 void GLCommandBuffer::EndRenderCondition()
 {
+    FlushDrawBatch();
+
     glEndConditionalRender();
 }
 
-/* ----- Drawing ----- */
+void GLCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    FlushDrawBatch();
 
-/*
-NOTE:
-In the following Draw* functions, 'indices' is from type 'GLsizeiptr' to have the same size as a pointer address on either a 32-bit or 64-bit platform.
-The indices actually store the index start offset, but must be passed to GL as a void-pointer, due to an obsolete API.
-*/
+    auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+    queryHeapGL.Begin(query);
+}
 
-void GLCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+void GLCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t /*query*/)
 {
-    glDrawArrays(
-        renderState_.drawMode,
-        static_cast<GLint>(firstVertex),
-        static_cast<GLsizei>(numVertices)
-    );
+    FlushDrawBatch();
+
+    auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+    queryHeapGL.End();
 }
 
-void GLCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+void GLCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
-    const GLsizeiptr indices = firstIndex * renderState_.indexBufferStride;
-    glDrawElements(
-        renderState_.drawMode,
-        static_cast<GLsizei>(numIndices),
-        renderState_.indexBufferDataType,
-        reinterpret_cast<const GLvoid*>(indices)
-    );
+    FlushDrawBatch();
+
+    auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+    glBeginConditionalRender(queryHeapGL.GetID(query), GLTypes::Map(mode));
 }
 
-void GLCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+bool GLCommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
 {
-    const GLsizeiptr indices = firstIndex * renderState_.indexBufferStride;
-    glDrawElementsBaseVertex(
-        renderState_.drawMode,
-        static_cast<GLsizei>(numIndices),
-        renderState_.indexBufferDataType,
-        reinterpret_cast<const GLvoid*>(indices),
-        vertexOffset
-    );
+    auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+
+    /* Check if the results of the entire range are available */
+    if (!queryHeapGL.AreResultsAvailable(firstQuery, numQueries))
+        return false;
+
+    if (HasExtension(GLExt::ARB_timer_query))
+    {
+        /* Get query results with 64-bit version */
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+        {
+            GLuint64 result = 0;
+            glGetQueryObjectui64v(queryHeapGL.GetID(firstQuery + i), GL_QUERY_RESULT, &result);
+            results[i] = result;
+        }
+    }
+    else
+    {
+        /* Get query results with 32-bit version and convert to 64-bit */
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+        {
+            GLuint result32 = 0;
+            glGetQueryObjectuiv(queryHeapGL.GetID(firstQuery + i), GL_QUERY_RESULT, &result32);
+            results[i] = result32;
+        }
+    }
+
+    return true;
 }
 
-void GLCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+void GLCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
 {
-    glDrawArraysInstanced(
-        renderState_.drawMode,
-        static_cast<GLint>(firstVertex),
-        static_cast<GLsizei>(numVertices),
-        static_cast<GLsizei>(numInstances)
-    );
+    FlushDrawBatch();
+
+    #ifdef LLGL_OPENGL
+    if (HasExtension(GLExt::ARB_query_buffer_object))
+    {
+        auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+        auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+
+        /* While a query buffer is bound, the query results are written into that buffer at the offset that is passed as pointer */
+        stateMngr_->BindBuffer(GLBufferTarget::QUERY_BUFFER, dstBufferGL.GetID());
+
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+        {
+            auto offset = static_cast<GLintptr>(dstOffset + i * sizeof(GLuint64));
+            glGetQueryObjectui64v(queryHeapGL.GetID(firstQuery + i), GL_QUERY_RESULT, reinterpret_cast<GLuint64*>(offset));
+        }
+
+        /* Unbind query buffer, so host queries write into client memory again */
+        stateMngr_->BindBuffer(GLBufferTarget::QUERY_BUFFER, 0);
+    }
+    #endif
 }
 
-void GLCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+/* ----- Timer Scopes ----- */
+
+void GLCommandBuffer::BeginTimerScope(const char* name)
 {
-    #ifndef __APPLE__
-    glDrawArraysInstancedBaseInstance(
-        renderState_.drawMode,
-        static_cast<GLint>(firstVertex),
-        static_cast<GLsizei>(numVertices),
-        static_cast<GLsizei>(numInstances),
-        firstInstance
-    );
-    #else
-    ErrUnsupportedGLProc("glDrawArraysInstancedBaseInstance");
+    FlushDrawBatch();
+
+    #ifdef LLGL_OPENGL
+    if (HasExtension(GLExt::ARB_timer_query))
+    {
+        UpdateTimerScopeFrame();
+        EndStatisticsSegment();
+
+        std::uint32_t timestampIndex = 0;
+        if (timerScopes_.BeginScope(name, timestampIndex))
+            WriteTimestamp(timestampIndex);
+
+        BeginStatisticsSegment();
+    }
     #endif
 }
 
-void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+void GLCommandBuffer::EndTimerScope()
 {
-    const GLsizeiptr indices = firstIndex * renderState_.indexBufferStride;
-    glDrawElementsInstanced(
-        renderState_.drawMode,
+    FlushDrawBatch();
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.EndScope(timestampIndex))
+        WriteTimestamp(timestampIndex);
+
+    BeginStatisticsSegment();
+}
+
+bool GLCommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
+{
+    #ifdef LLGL_OPENGL
+    UpdateTimerScopeFrame();
+
+    if (!timerScopes_.HasPendingFrame())
+        return false;
+
+    const auto pendingFrame     = timerScopes_.GetPendingFrame();
+    const auto firstTimestamp   = timerScopes_.GetFirstTimestamp(pendingFrame);
+    const auto numTimestamps    = timerScopes_.GetNumTimestamps(pendingFrame);
+
+    /* Check if all timestamps of the pending frame are available without waiting for the GPU */
+    for (std::uint32_t i = 0; i < numTimestamps; ++i)
+    {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(timestampQueries_[firstTimestamp + i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+            return false;
+    }
+
+    /* Read timestamps (in nanoseconds) and resolve timer scopes */
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto timestamps = scratch_.Allocate<std::uint64_t>(numTimestamps);
+
+    for (std::uint32_t i = 0; i < numTimestamps; ++i)
+    {
+        GLuint64 timestamp = 0;
+        glGetQueryObjectui64v(timestampQueries_[firstTimestamp + i], GL_QUERY_RESULT, &timestamp);
+        timestamps[i] = timestamp;
+    }
+
+    /* Read pipeline statistics of all segments, which are available once the last timestamp is */
+    QueryPipelineStatistics* statistics = nullptr;
+    if (timerStatistics_)
+    {
+        const auto firstSegment = timerScopes_.GetFirstSegment(pendingFrame);
+        const auto numSegments  = timerScopes_.GetNumSegments(pendingFrame);
+
+        statistics = scratch_.Allocate<QueryPipelineStatistics>(numSegments);
+        for (std::uint32_t i = 0; i < numSegments; ++i)
+        {
+            if (!QueryPipelineStatisticsResult(*statisticsQueries_[firstSegment + i], statistics[i]))
+                return false;
+        }
+    }
+
+    timerScopes_.ResolvePendingFrame(timestamps, 1.0, frame, statistics);
+
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+/* ----- Debug Markers ----- */
+
+void GLCommandBuffer::PushDebugGroup(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+    {
+        FlushDrawBatch();
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+    }
+    #endif
+}
+
+void GLCommandBuffer::PopDebugGroup()
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+    {
+        FlushDrawBatch();
+        glPopDebugGroup();
+    }
+    #endif
+}
+
+void GLCommandBuffer::InsertDebugMarker(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+    {
+        FlushDrawBatch();
+        glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_MARKER, 0, GL_DEBUG_SEVERITY_NOTIFICATION, -1, name);
+    }
+    #endif
+}
+
+/* ----- Drawing ----- */
+
+/*
+NOTE:
+In the following Draw* functions, 'indices' is from type 'GLsizeiptr' to have the same size as a pointer address on either a 32-bit or 64-bit platform.
+The indices actually store the index start offset, but must be passed to GL as a void-pointer, due to an obsolete API.
+*/
+
+void GLCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+
+    if (auto drawBatch = GetDrawBatch())
+    {
+        drawBatch->AppendArrays(
+            renderState_.drawMode,
+            static_cast<GLint>(firstVertex),
+            static_cast<GLsizei>(numVertices)
+        );
+        return;
+    }
+
+    glDrawArrays(
+        renderState_.drawMode,
+        static_cast<GLint>(firstVertex),
+        static_cast<GLsizei>(numVertices)
+    );
+}
+
+void GLCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+
+    if (auto drawBatch = GetDrawBatch())
+    {
+        drawBatch->AppendElements(
+            renderState_.drawMode,
+            renderState_.indexBufferDataType,
+            renderState_.indexBufferStride,
+            renderState_.indexBufferFirstIndex + firstIndex,
+            static_cast<GLsizei>(numIndices),
+            0
+        );
+        return;
+    }
+
+    const GLsizeiptr indices = (renderState_.indexBufferFirstIndex + firstIndex) * renderState_.indexBufferStride;
+    glDrawElements(
+        renderState_.drawMode,
+        static_cast<GLsizei>(numIndices),
+        renderState_.indexBufferDataType,
+        reinterpret_cast<const GLvoid*>(indices)
+    );
+}
+
+void GLCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+
+    if (auto drawBatch = GetDrawBatch())
+    {
+        drawBatch->AppendElements(
+            renderState_.drawMode,
+            renderState_.indexBufferDataType,
+            renderState_.indexBufferStride,
+            renderState_.indexBufferFirstIndex + firstIndex,
+            static_cast<GLsizei>(numIndices),
+            vertexOffset
+        );
+        return;
+    }
+
+    const GLsizeiptr indices = (renderState_.indexBufferFirstIndex + firstIndex) * renderState_.indexBufferStride;
+    glDrawElementsBaseVertex(
+        renderState_.drawMode,
+        static_cast<GLsizei>(numIndices),
+        renderState_.indexBufferDataType,
+        reinterpret_cast<const GLvoid*>(indices),
+        vertexOffset
+    );
+}
+
+void GLCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    glDrawArraysInstanced(
+        renderState_.drawMode,
+        static_cast<GLint>(firstVertex),
+        static_cast<GLsizei>(numVertices),
+        static_cast<GLsizei>(numInstances)
+    );
+}
+
+void GLCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    glDrawArraysInstancedBaseInstance(
+        renderState_.drawMode,
+        static_cast<GLint>(firstVertex),
+        static_cast<GLsizei>(numVertices),
+        static_cast<GLsizei>(numInstances),
+        firstInstance
+    );
+    #else
+    ErrUnsupportedGLProc("glDrawArraysInstancedBaseInstance");
+    #endif
+}
+
+void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    const GLsizeiptr indices = (renderState_.indexBufferFirstIndex + firstIndex) * renderState_.indexBufferStride;
+    glDrawElementsInstanced(
+        renderState_.drawMode,
         static_cast<GLsizei>(numIndices),
         renderState_.indexBufferDataType,
         reinterpret_cast<const GLvoid*>(indices),
@@ -605,7 +1542,11 @@ void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    auto indices = static_cast<GLsizeiptr>(firstIndex * renderState_.indexBufferStride);
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    auto indices = static_cast<GLsizeiptr>((renderState_.indexBufferFirstIndex + firstIndex) * renderState_.indexBufferStride);
     glDrawElementsInstancedBaseVertex(
         renderState_.drawMode,
         static_cast<GLsizei>(numIndices),
@@ -618,8 +1559,12 @@ void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
     #ifndef __APPLE__
-    const GLsizeiptr indices = firstIndex * renderState_.indexBufferStride;
+    const GLsizeiptr indices = (renderState_.indexBufferFirstIndex + firstIndex) * renderState_.indexBufferStride;
     glDrawElementsInstancedBaseVertexBaseInstance(
         renderState_.drawMode,
         static_cast<GLsizei>(numIndices),
@@ -634,15 +1579,634 @@ void GLCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
     #endif
 }
 
+void GLCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    glDrawArraysIndirect(
+        renderState_.drawMode,
+        reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset))
+    );
+    #else
+    ErrUnsupportedGLProc("glDrawArraysIndirect");
+    #endif
+}
+
+void GLCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+    {
+        glMultiDrawArraysIndirect(
+            renderState_.drawMode,
+            reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset)),
+            static_cast<GLsizei>(numCommands),
+            static_cast<GLsizei>(stride)
+        );
+    }
+    else
+    {
+        /* Submit draw commands one after another */
+        for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+        {
+            glDrawArraysIndirect(
+                renderState_.drawMode,
+                reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset))
+            );
+        }
+    }
+    #else
+    ErrUnsupportedGLProc("glMultiDrawArraysIndirect");
+    #endif
+}
+
+void GLCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    glDrawElementsIndirect(
+        renderState_.drawMode,
+        renderState_.indexBufferDataType,
+        reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset))
+    );
+    #else
+    ErrUnsupportedGLProc("glDrawElementsIndirect");
+    #endif
+}
+
+void GLCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+    {
+        glMultiDrawElementsIndirect(
+            renderState_.drawMode,
+            renderState_.indexBufferDataType,
+            reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset)),
+            static_cast<GLsizei>(numCommands),
+            static_cast<GLsizei>(stride)
+        );
+    }
+    else
+    {
+        /* Submit draw commands one after another */
+        for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+        {
+            glDrawElementsIndirect(
+                renderState_.drawMode,
+                renderState_.indexBufferDataType,
+                reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(offset))
+            );
+        }
+    }
+    #else
+    ErrUnsupportedGLProc("glMultiDrawElementsIndirect");
+    #endif
+}
+
+void GLCommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  /*layout*/,
+    Buffer&                 /*argumentBuffer*/,
+    std::uint64_t           /*argumentOffset*/,
+    std::uint32_t           /*maxNumCommands*/,
+    Buffer*                 /*countBuffer*/,
+    std::uint64_t           /*countOffset*/)
+{
+    // dummy (not supported by OpenGL, indirect command layouts cannot be created with this renderer)
+}
+
+void GLCommandBuffer::DrawStreamOutput()
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifdef GL_ARB_transform_feedback2
+    if (soVertexBuffer_ != nullptr && soVertexBuffer_->GetStreamOutputSourceID() != 0)
+    {
+        const auto transformFeedbackID  = soVertexBuffer_->GetStreamOutputSourceID();
+        const auto stream               = soVertexBuffer_->GetStreamOutputSourceStream();
+
+        /* Draw with the vertex count that has been recorded for the vertex stream of this buffer */
+        #ifdef GL_ARB_transform_feedback3
+        if (stream > 0)
+        {
+            if (!HasExtension(GLExt::ARB_transform_feedback3))
+                ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_transform_feedback3");
+            glDrawTransformFeedbackStream(renderState_.drawMode, transformFeedbackID, stream);
+        }
+        else
+        #endif
+        {
+            glDrawTransformFeedback(renderState_.drawMode, transformFeedbackID);
+        }
+    }
+    else
+    #endif
+    {
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_ARB_transform_feedback2");
+    }
+}
+
+void GLCommandBuffer::DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+    if (HasExtension(GLExt::NV_mesh_shader))
+    {
+        /* GL_NV_mesh_shader only supports one-dimensional mesh tasks */
+        if (groupSizeY != 1 || groupSizeZ != 1)
+            throw std::invalid_argument("GL_NV_mesh_shader only supports one-dimensional mesh tasks, but groupSizeY or groupSizeZ is not 1");
+        glDrawMeshTasksNV(0, groupSizeX);
+    }
+    else
+    #endif
+        ThrowNotSupportedExcept(__FUNCTION__, "GL_NV_mesh_shader");
+}
+
+void GLCommandBuffer::DrawMeshTasksIndirect(
+    Buffer&         /*buffer*/,
+    std::uint64_t   /*offset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    /* GL_NV_mesh_shader reads indirect arguments as (count, first), which is incompatible with DrawMeshTasksIndirectArguments */
+    ThrowNotSupportedExcept(__FUNCTION__, "indirect mesh tasks");
+}
+
 /* ----- Compute ----- */
 
 void GLCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
 {
+    LLGL_STATISTICS_INC(dispatchCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
     #ifndef __APPLE__
     glDispatchCompute(groupSizeX, groupSizeY, groupSizeZ);
     #endif
 }
 
+void GLCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+    FlushTransientWrites();
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, bufferGL.GetID());
+    glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    #endif
+}
+
+void GLCommandBuffer::DispatchBarrier()
+{
+    #ifndef __APPLE__
+    /* Make storage writes of previous dispatches visible to subsequent dispatches, indirect arguments, and buffer copies */
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    #endif
+}
+
+/* ----- Acceleration Structures ----- */
+
+void GLCommandBuffer::BuildAccelerationStructures(std::uint32_t /*numAccelerationStructures*/, AccelerationStructure* const * /*accelerationStructures*/)
+{
+    // dummy (acceleration structures are not supported by OpenGL)
+}
+
+void GLCommandBuffer::CompactAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/)
+{
+    // dummy (acceleration structures are not supported by OpenGL)
+}
+
+/* ----- Copy ----- */
+
+void GLCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    FlushDrawBatch();
+
+    if (!HasExtension(GLExt::ARB_copy_buffer))
+        ErrUnsupportedGLProc("glCopyBufferSubData");
+
+    auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+    auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
+
+    /* Bind buffers to the copy targets, so the binding points of the pipeline remain unchanged */
+    stateMngr_->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, srcBufferGL.GetID());
+    stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(srcOffset),
+        static_cast<GLintptr>(dstOffset),
+        static_cast<GLsizeiptr>(size)
+    );
+}
+
+void GLCommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    FlushDrawBatch();
+
+    if (!HasExtension(GLExt::ARB_copy_buffer))
+        ErrUnsupportedGLProc("glCopyBufferSubData");
+
+    auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+    auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
+
+    /* Copy value from the atomic counter buffer of the source buffer */
+    stateMngr_->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, srcBufferGL.GetCounterID());
+    stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        0,
+        static_cast<GLintptr>(dstOffset),
+        static_cast<GLsizeiptr>(sizeof(GLuint))
+    );
+}
+
+void GLCommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    FlushDrawBatch();
+
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    const GLuint counterValue = value;
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedBufferSubData(bufferGL.GetCounterID(), 0, sizeof(counterValue), &counterValue);
+    }
+    else
+    #endif
+    {
+        stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, bufferGL.GetCounterID());
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(counterValue), &counterValue);
+    }
+}
+
+void GLCommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    static const std::uint64_t maxChunkSize = 64 * 1024;
+
+    if (fillSize == 0)
+        return;
+
+    FlushDrawBatch();
+
+    auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+
+    #ifndef __APPLE__
+    if (HasExtension(GLExt::ARB_clear_buffer_object))
+    {
+        #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+        if (HasExtension(GLExt::ARB_direct_state_access))
+        {
+            glClearNamedBufferSubData(
+                dstBufferGL.GetID(),
+                GL_R32UI,
+                static_cast<GLintptr>(dstOffset),
+                static_cast<GLsizeiptr>(fillSize),
+                GL_RED_INTEGER,
+                GL_UNSIGNED_INT,
+                &value
+            );
+        }
+        else
+        #endif
+        {
+            stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+            glClearBufferSubData(
+                GL_COPY_WRITE_BUFFER,
+                GL_R32UI,
+                static_cast<GLintptr>(dstOffset),
+                static_cast<GLsizeiptr>(fillSize),
+                GL_RED_INTEGER,
+                GL_UNSIGNED_INT,
+                &value
+            );
+        }
+        return;
+    }
+    #endif
+
+    /* Upload the pattern in chunks if glClearBufferSubData is not available */
+    const auto chunkSize = std::min(fillSize, maxChunkSize);
+    const std::vector<std::uint32_t> pattern(static_cast<std::size_t>(chunkSize / sizeof(std::uint32_t)), value);
+
+    stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+    for (std::uint64_t offset = 0; offset < fillSize; offset += chunkSize)
+    {
+        glBufferSubData(
+            GL_COPY_WRITE_BUFFER,
+            static_cast<GLintptr>(dstOffset + offset),
+            static_cast<GLsizeiptr>(std::min(chunkSize, fillSize - offset)),
+            pattern.data()
+        );
+    }
+}
+
+void GLCommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    if (!HasExtension(GLExt::ARB_copy_image))
+        ErrUnsupportedGLProc("glCopyImageSubData");
+
+    auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
+    auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
+
+    /* Array layers and cube faces are addressed in the same way as in LLGL, i.e. by the Z coordinate (or Y for 1D-array textures) */
+    glCopyImageSubData(
+        srcTextureGL.GetID(),
+        GLTypes::Map(srcTextureGL.GetType()),
+        static_cast<GLint>(srcRegion.mipLevel),
+        srcRegion.offset.x,
+        srcRegion.offset.y,
+        srcRegion.offset.z,
+        dstTextureGL.GetID(),
+        GLTypes::Map(dstTextureGL.GetType()),
+        static_cast<GLint>(dstLocation.mipLevel),
+        dstLocation.offset.x,
+        dstLocation.offset.y,
+        dstLocation.offset.z,
+        static_cast<GLsizei>(srcRegion.extent.width),
+        static_cast<GLsizei>(srcRegion.extent.height),
+        static_cast<GLsizei>(srcRegion.extent.depth)
+    );
+    #else
+    ErrUnsupportedGLProc("glCopyImageSubData");
+    #endif
+}
+
+// Depth-stencil clear value in the layout of GL_FLOAT_32_UNSIGNED_INT_24_8_REV.
+struct GLDepthStencilClearValue
+{
+    GLfloat depth;
+    GLuint  stencil;
+};
+
+void GLCommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    FlushDrawBatch();
+
+    #ifndef __APPLE__
+    if (!HasExtension(GLExt::ARB_clear_texture))
+        ErrUnsupportedGLProc("glClearTexSubImage");
+
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+
+    Format format = Format::Undefined;
+    GLTypes::Unmap(format, textureGL.QueryGLInternalFormat());
+
+    /* Select image format and data type of the clear value by the class of the texture format */
+    GLenum      formatGL    = GL_RGBA;
+    GLenum      typeGL      = GL_FLOAT;
+    const void* data        = clearValue.color.Ptr();
+
+    GLint                       intColor[4];
+    GLuint                      uintColor[4];
+    GLDepthStencilClearValue    depthStencil    = { clearValue.depth, clearValue.stencil };
+
+    if (format == Format::D24UNormS8UInt || format == Format::D32FloatS8X24UInt)
+    {
+        formatGL    = GL_DEPTH_STENCIL;
+        typeGL      = GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
+        data        = &depthStencil;
+    }
+    else if (IsDepthStencilFormat(format))
+    {
+        formatGL    = GL_DEPTH_COMPONENT;
+        data        = &(clearValue.depth);
+    }
+    else if (IsIntegralFormat(format) && !IsNormalizedFormat(format))
+    {
+        DataType        dataType    = DataType::Float32;
+        std::uint32_t   components  = 0;
+
+        formatGL = GL_RGBA_INTEGER;
+        if (SplitFormat(format, dataType, components) && IsIntDataType(dataType))
+        {
+            for (int i = 0; i < 4; ++i)
+                intColor[i] = static_cast<GLint>(clearValue.color[i]);
+            typeGL  = GL_INT;
+            data    = intColor;
+        }
+        else
+        {
+            for (int i = 0; i < 4; ++i)
+                uintColor[i] = static_cast<GLuint>(clearValue.color[i]);
+            typeGL  = GL_UNSIGNED_INT;
+            data    = uintColor;
+        }
+    }
+
+    /* Array layers and cube faces are addressed by the Z coordinate (or Y for 1D-array textures), like in CopyTexture */
+    const auto textureType = textureGL.GetType();
+
+    for (auto mipLevel = subresource.baseMipLevel; mipLevel < subresource.baseMipLevel + subresource.numMipLevels; ++mipLevel)
+    {
+        const auto extent = textureGL.QueryMipExtent(mipLevel);
+
+        GLint   offsetY = 0, offsetZ = 0;
+        GLsizei height  = static_cast<GLsizei>(extent.height);
+        GLsizei depth   = static_cast<GLsizei>(extent.depth);
+
+        if (textureType == TextureType::Texture1DArray)
+        {
+            offsetY = static_cast<GLint>(subresource.baseArrayLayer);
+            height  = static_cast<GLsizei>(subresource.numArrayLayers);
+        }
+        else if (textureType != TextureType::Texture3D)
+        {
+            offsetZ = static_cast<GLint>(subresource.baseArrayLayer);
+            depth   = static_cast<GLsizei>(subresource.numArrayLayers);
+        }
+
+        glClearTexSubImage(
+            textureGL.GetID(),
+            static_cast<GLint>(mipLevel),
+            0,
+            offsetY,
+            offsetZ,
+            static_cast<GLsizei>(extent.width),
+            height,
+            depth,
+            formatGL,
+            typeGL,
+            data
+        );
+    }
+    #else
+    ErrUnsupportedGLProc("glClearTexSubImage");
+    #endif
+}
+
+// Determines the image format and data type that match the hardware format of the specified texture, and returns the texel size (in bytes).
+static std::uint32_t GetTextureImageFormat(const GLTexture& textureGL, ImageFormat& imageFormat, DataType& dataType)
+{
+    return (FormatBitSize(textureGL.QueryImageFormat(imageFormat, dataType)) / 8);
+}
+
+// Returns the buffer offset as pointer argument for GL functions that read from or write to a bound pixel buffer.
+static void* GetPixelBufferOffset(std::uint64_t offset)
+{
+    return reinterpret_cast<void*>(static_cast<std::uintptr_t>(offset));
+}
+
+void GLCommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    FlushDrawBatch();
+
+    auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
+    auto& srcBufferGL  = LLGL_CAST(GLBuffer&, srcBuffer);
+
+    /* Determine image format and layout of the texel data within the buffer */
+    SrcImageDescriptor imageDesc;
+    const auto texelSize    = GetTextureImageFormat(dstTextureGL, imageDesc.format, imageDesc.dataType);
+    const auto rowLength    = rowStride / texelSize;
+    const auto sliceSize    = static_cast<std::uint64_t>(rowLength > 0 ? rowLength : dstRegion.extent.width) * texelSize * dstRegion.extent.height;
+
+    SubTextureDescriptor subTextureDesc;
+    {
+        subTextureDesc.mipLevel = dstRegion.mipLevel;
+        subTextureDesc.offset   = dstRegion.offset;
+        subTextureDesc.extent   = dstRegion.extent;
+    }
+
+    /* While a pixel unpack buffer is bound, the image data pointer is interpreted as offset into that buffer */
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, srcBufferGL.GetID());
+    stateMngr_->BindTexture(dstTextureGL);
+
+    if (rowLength > 0)
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(rowLength));
+
+    if (dstTextureGL.GetType() == TextureType::TextureCube)
+    {
+        /* Write cube faces one by one, since each face has its own texture target */
+        subTextureDesc.extent.depth = 1;
+        for (std::uint32_t face = 0; face < dstRegion.extent.depth; ++face)
+        {
+            subTextureDesc.offset.z = dstRegion.offset.z + static_cast<std::int32_t>(face);
+            imageDesc.data          = GetPixelBufferOffset(srcOffset + sliceSize * face);
+            imageDesc.dataSize      = static_cast<std::size_t>(sliceSize);
+            GLTexSubImageCube(subTextureDesc, imageDesc);
+        }
+    }
+    else
+    {
+        imageDesc.data      = GetPixelBufferOffset(srcOffset);
+        imageDesc.dataSize  = static_cast<std::size_t>(sliceSize * dstRegion.extent.depth);
+        GLTexSubImage(dstTextureGL.GetType(), subTextureDesc, imageDesc);
+    }
+
+    /* Reset pixel storage and unbind pixel unpack buffer, so WriteTexture reads from client memory again */
+    if (rowLength > 0)
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+}
+
+void GLCommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    FlushDrawBatch();
+
+    auto& dstBufferGL  = LLGL_CAST(GLBuffer&, dstBuffer);
+    auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
+
+    /* Determine image format and layout of the texel data within the buffer */
+    ImageFormat imageFormat;
+    DataType    dataType;
+    const auto texelSize    = GetTextureImageFormat(srcTextureGL, imageFormat, dataType);
+    const auto rowLength    = rowStride / texelSize;
+    const auto sliceSize    = static_cast<std::uint64_t>(rowLength > 0 ? rowLength : srcRegion.extent.width) * texelSize * srcRegion.extent.height;
+
+    /* While a pixel pack buffer is bound, the image data pointer is interpreted as offset into that buffer */
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, dstBufferGL.GetID());
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (rowLength > 0)
+        glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(rowLength));
+
+    srcTextureGL.GetTextureSubImage(srcRegion, imageFormat, dataType, static_cast<std::size_t>(sliceSize), GetPixelBufferOffset(dstOffset));
+
+    /* Reset pixel storage and unbind pixel pack buffer, so ReadTexture writes into client memory again */
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    if (rowLength > 0)
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void GLCommandBuffer::Begin()
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+void GLCommandBuffer::End()
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+void GLCommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    FlushDrawBatch();
+
+    // dummy (secondary command buffers are not supported)
+}
+
+/* ----- Extended internal functions ----- */
+
+void GLCommandBuffer::SubmitTransientMemory()
+{
+    if (transientRing_.HasOpenSegment())
+    {
+        transientRing_.Close(++transientSubmission_);
+        transientFence_.Signal(transientSubmission_);
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -650,9 +2214,17 @@ void GLCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSize
 
 void GLCommandBuffer::SetGenericBuffer(const GLBufferTarget bufferTarget, Buffer& buffer, std::uint32_t slot)
 {
-    /* Bind buffer with BindBufferBase */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
-    stateMngr_->BindBufferBase(bufferTarget, slot, bufferGL.GetID());
+    if (bufferGL.IsRing())
+    {
+        /* Bind current region of persistently mapped or streaming ring with BindBufferRange */
+        stateMngr_->BindBufferRange(bufferTarget, slot, bufferGL.GetID(), bufferGL.GetRegionOffset(), bufferGL.GetRegionSize());
+    }
+    else
+    {
+        /* Bind buffer with BindBufferBase */
+        stateMngr_->BindBufferBase(bufferTarget, slot, bufferGL.GetID());
+    }
 }
 
 void GLCommandBuffer::SetGenericBufferArray(const GLBufferTarget bufferTarget, BufferArray& bufferArray, std::uint32_t startSlot)
@@ -667,10 +2239,119 @@ void GLCommandBuffer::SetGenericBufferArray(const GLBufferTarget bufferTarget, B
     );
 }
 
-void GLCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+void GLCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
 {
     auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
-    resourceHeapGL.Bind(*stateMngr_);
+    resourceHeapGL.Bind(*stateMngr_, numDynamicOffsets, dynamicOffsets);
+}
+
+void GLCommandBuffer::UpdateTimerScopeFrame()
+{
+    if (timerRenderContext_ != nullptr && timerRenderContext_->GetPresentCount() != timerPresentCount_)
+    {
+        timerPresentCount_ = timerRenderContext_->GetPresentCount();
+        CloseTimerScopeFrame();
+    }
+}
+
+void GLCommandBuffer::CloseTimerScopeFrame()
+{
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    while (timerScopes_.HasOpenScopes())
+    {
+        if (timerScopes_.EndScope(timestampIndex))
+            WriteTimestamp(timestampIndex);
+    }
+    timerScopes_.CloseFrame();
+}
+
+void GLCommandBuffer::WriteTimestamp(std::uint32_t timestampIndex)
+{
+    #ifdef LLGL_OPENGL
+    if (timestampQueries_.empty())
+    {
+        /* Generate all GL query objects for the timestamps of each timer scope frame */
+        timestampQueries_.resize(TimerScopeRecorder::maxNumTimestamps);
+        glGenQueries(static_cast<GLsizei>(timestampQueries_.size()), timestampQueries_.data());
+    }
+    glQueryCounter(timestampQueries_[timestampIndex], GL_TIMESTAMP);
+    #endif
+}
+
+void GLCommandBuffer::BeginStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerStatistics_ && timerScopes_.BeginSegment(queryIndex))
+    {
+        if (statisticsQueries_.empty())
+            statisticsQueries_.resize(TimerScopeRecorder::maxNumSegments);
+        if (!statisticsQueries_[queryIndex])
+            statisticsQueries_[queryIndex] = MakeUnique<GLQuery>(QueryDescriptor{ QueryType::PipelineStatistics });
+        statisticsQueries_[queryIndex]->Begin();
+    }
+}
+
+void GLCommandBuffer::EndStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerScopes_.EndSegment(queryIndex))
+        statisticsQueries_[queryIndex]->End();
+}
+
+void GLCommandBuffer::FlushDrawBatch()
+{
+    stateMngr_->FlushPendingDrawBatch();
+}
+
+GLDrawBatch* GLCommandBuffer::GetDrawBatch()
+{
+    if (drawBatch_)
+    {
+        stateMngr_->SetPendingDrawBatch(drawBatch_.get());
+        return drawBatch_.get();
+    }
+    else
+    {
+        stateMngr_->FlushPendingDrawBatch();
+        return nullptr;
+    }
+}
+
+void GLCommandBuffer::UpdateShadingRatePalette()
+{
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (shadingRateImage_ != 0)
+    {
+        /* Map each texel value of the shading rate image, i.e. (log2(width) << 2) | log2(height), to its shading rate */
+        static const GLenum g_shadingRatePalette[] =
+        {
+            GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,          // 0x0: 1x1
+            GL_SHADING_RATE_1_INVOCATION_PER_1X2_PIXELS_NV,     // 0x1: 1x2
+            GL_SHADING_RATE_1_INVOCATION_PER_1X2_PIXELS_NV,     // 0x2: 1x4 (clamped to 1x2)
+            GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,          // 0x3: unused
+            GL_SHADING_RATE_1_INVOCATION_PER_2X1_PIXELS_NV,     // 0x4: 2x1
+            GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV,     // 0x5: 2x2
+            GL_SHADING_RATE_1_INVOCATION_PER_2X4_PIXELS_NV,     // 0x6: 2x4
+            GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,          // 0x7: unused
+            GL_SHADING_RATE_1_INVOCATION_PER_2X1_PIXELS_NV,     // 0x8: 4x1 (clamped to 2x1)
+            GL_SHADING_RATE_1_INVOCATION_PER_4X2_PIXELS_NV,     // 0x9: 4x2
+            GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV,     // 0xA: 4x4
+        };
+        glShadingRateImagePaletteNV(0, 0, static_cast<GLsizei>(sizeof(g_shadingRatePalette) / sizeof(GLenum)), g_shadingRatePalette);
+        stateMngr_->Enable(GLStateExt::SHADING_RATE_IMAGE);
+    }
+    else if (shadingRate_ != ShadingRate::Rate1x1)
+    {
+        /* Without shading rate image, all texels are read as zero, so the first palette entry determines the rate of all pixels */
+        const GLenum rate = GLTypes::Map(shadingRate_);
+        glShadingRateImagePaletteNV(0, 0, 1, &rate);
+        stateMngr_->Enable(GLStateExt::SHADING_RATE_IMAGE);
+    }
+    else
+        stateMngr_->Disable(GLStateExt::SHADING_RATE_IMAGE);
+    #endif
 }
 
 
@@ -11,7 +11,15 @@
 
 #include <LLGL/CommandBufferExt.h>
 #include "RenderState/GLState.h"
+#include "RenderState/GLFence.h"
+#include "../TimerScopeRecorder.h"
+#include "../StatisticsCounter.h"
+#include "../ScratchArena.h"
+#include "../TransientRing.h"
+#include "GLDrawBatch.h"
 #include "OpenGL.h"
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -19,7 +27,10 @@ namespace LLGL
 
 
 class GLRenderTarget;
+class GLRenderContext;
 class GLStateManager;
+class GLBuffer;
+class GLQuery;
 
 class GLCommandBuffer final : public CommandBufferExt
 {
@@ -28,7 +39,8 @@ class GLCommandBuffer final : public CommandBufferExt
 
         /* ----- Common ----- */
 
-        GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateManager);
+        GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateManager, StatisticsCounter& statistics, long flags);
+        ~GLCommandBuffer();
 
         /* ----- Configuration ----- */
 
@@ -54,14 +66,24 @@ class GLCommandBuffer final : public CommandBufferExt
         /* ----- Input Assembly ------ */
 
         void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
         void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
 
         /* ----- Constant Buffers ------ */
 
         void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
 
+        void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
         /* ----- Storage Buffers ------ */
 
         void SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
@@ -74,6 +96,9 @@ class GLCommandBuffer final : public CommandBufferExt
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, std::uint32_t layer, long stageFlags = StageFlags::AllStages) override;
@@ -84,19 +109,65 @@ class GLCommandBuffer final : public CommandBufferExt
 
         /* ----- Resource Heaps ----- */
 
-        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t startSlot) override;
-        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t startSlot) override;
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
 
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
@@ -108,6 +179,28 @@ class GLCommandBuffer final : public CommandBufferExt
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
         /* ----- Drawing ----- */
 
         void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
@@ -122,31 +215,203 @@ class GLCommandBuffer final : public CommandBufferExt
         void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
         void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
 
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
+
+        /* ----- Extended internal functions ----- */
+
+        // Closes the segment of transient memory that has been allocated since the last submission, so it is recycled once the GPU has completed it.
+        void SubmitTransientMemory();
 
     private:
 
         struct RenderState
         {
-            GLenum      drawMode            = GL_TRIANGLES;     // Render mode for "glDraw*"
-            GLenum      indexBufferDataType = GL_UNSIGNED_INT;
-            GLsizeiptr  indexBufferStride   = 4;
+            GLenum      drawMode                = GL_TRIANGLES;     // Render mode for "glDraw*"
+            GLenum      indexBufferDataType     = GL_UNSIGNED_INT;
+            GLsizeiptr  indexBufferStride       = 4;
+            GLuint      indexBufferFirstIndex   = 0;                // Offset of the index buffer binding (in units of indices)
         };
 
         void SetGenericBuffer(const GLBufferTarget bufferTarget, Buffer& buffer, std::uint32_t slot);
         void SetGenericBufferArray(const GLBufferTarget bufferTarget, BufferArray& bufferArray, std::uint32_t startSlot);
 
-        void SetResourceHeap(ResourceHeap& resourceHeap);
+        void SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
+
+        // Load and store operations of the current render pass, which has been begun with a RenderPass object.
+        struct RenderPassState
+        {
+            const RenderPass*   renderPass              = nullptr;
+            std::uint32_t       numColorAttachments     = 0;
+            bool                hasDepthAttachment      = false;
+            bool                hasStencilAttachment    = false;
+            bool                defaultFramebuffer      = false;
+            bool                invalidateOnEnd         = false;    // False for multi-sample render targets, since they are resolved after the render pass
+        };
 
         // Blits the currently bound render target
         void BlitBoundRenderTarget();
 
+        // Applies the load operations of the specified render pass state to the bound framebuffer.
+        void BeginRenderPassWithState(const RenderPassState& state, std::uint32_t numClearValues, const ClearValue* clearValues);
+
+        // Invalidates the attachments of the current render pass whose load operations (or store operations) are undefined.
+        void InvalidateRenderPassAttachments(bool loadOps);
+
+        // Closes the current timer scope frame if the render context has been presented since the frame has begun.
+        void UpdateTimerScopeFrame();
+
+        // Ends all open timer scopes and closes the current timer scope frame.
+        void CloseTimerScopeFrame();
+
+        // Records a GL_TIMESTAMP query with the specified timestamp index.
+        void WriteTimestamp(std::uint32_t timestampIndex);
+
+        // Begins a new pipeline statistics segment for the open timer scopes (see CommandBufferFlags::TimerScopeStatistics).
+        void BeginStatisticsSegment();
+
+        // Ends the active pipeline statistics segment of the timer scopes.
+        void EndStatisticsSegment();
+
+        // Submits the pending draw batch of any command buffer, which must be done before all commands except batched draw commands.
+        void FlushDrawBatch();
+
+        // Returns the draw batch for the next draw command if multi-draw batching is enabled, or submits the pending draw batch and returns null otherwise.
+        GLDrawBatch* GetDrawBatch();
+
+        // Updates the shading rate image palette and GL_SHADING_RATE_IMAGE_NV state for the current shading rate and image.
+        void UpdateShadingRatePalette();
+
+        // Maximum size (in bytes) of the constants, which are emulated with a hidden uniform buffer.
+        static const std::uint32_t maxConstantsSize = 128;
+
+        // Constants of either the graphics or compute pipeline, and their CPU shadow copy.
+        struct ConstantsState
+        {
+            ConstantsDescriptor layout;
+            char                data[maxConstantsSize];
+        };
+
+        // Uploads the specified constants into the next range of the hidden uniform buffer and binds that range.
+        void UploadConstants(const ConstantsState& constants);
+
+        // Range of the CPU shadow of the transient ring buffer that has not been uploaded yet.
+        struct TransientWrite
+        {
+            GLintptr    offset;
+            GLsizeiptr  size;
+        };
+
+        // Creates the transient ring buffer with the first transient allocation.
+        void CreateTransientBuffer();
+
+        // Writes the pending ranges of the CPU shadow into the transient ring buffer (only used without GL_ARB_buffer_storage).
+        void UploadTransientWrites();
+
+        // Uploads the pending transient data before a draw or dispatch command reads it.
+        inline void FlushTransientWrites()
+        {
+            if (!transientWrites_.empty())
+                UploadTransientWrites();
+        }
+
         std::shared_ptr<GLStateManager> stateMngr_;
+        StatisticsCounter&              statistics_;
         RenderState                     renderState_;
 
         GLRenderTarget*                 boundRenderTarget_  = nullptr;
+        bool                            resolvePending_     = false;    // True if the bound multi-sample render target is resolved when another render target is bound
+        RenderPassState                 renderPassState_;
+        ClearValue                      clearValue_;                    // Clear values for attachments of a render pass without clear value
+
+        TimerScopeRecorder              timerScopes_;
+        std::vector<GLuint>             timestampQueries_;              // GL_TIMESTAMP queries, generated with the first timer scope
+        const GLRenderContext*          timerRenderContext_ = nullptr;  // Render context whose presentation closes a timer scope frame
+        std::uint64_t                   timerPresentCount_  = 0;
+        bool                            timerStatistics_    = false;    // Timer scopes collect pipeline statistics, see CommandBufferFlags::TimerScopeStatistics
+        std::vector<std::unique_ptr<GLQuery>> statisticsQueries_;       // Pipeline statistics queries of the timer scope segments, generated on demand
+
+        ConstantsState                  graphicsConstants_;
+        ConstantsState                  computeConstants_;
+        GLuint                          constantsBuffer_    = 0;        // Hidden uniform buffer that is used as ring for all constants, generated with the first constants
+        GLintptr                        constantsOffset_    = 0;        // Offset (in bytes) of the next free range within the hidden uniform buffer
+        GLintptr                        constantsAlignment_ = 0;        // Value of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, also used for transient allocations
+
+        std::unique_ptr<GLBuffer>       transientBuffer_;               // Uniform buffer of the transient ring, created with the first transient allocation
+        char*                           transientData_      = nullptr;  // Persistently mapped storage of the transient ring, or its CPU shadow
+        std::vector<char>               transientShadow_;               // CPU shadow of the transient ring, only used without GL_ARB_buffer_storage
+        std::vector<TransientWrite>     transientWrites_;
+        TransientRing<std::uint64_t>    transientRing_;                 // Segments are tagged with the number of their submission
+        GLFence                         transientFence_;                // Timeline fence that is signaled with the number of each submission
+        std::uint64_t                   transientSubmission_ = 0;
+
+        std::unique_ptr<GLDrawBatch>    drawBatch_;                     // Only allocated if CommandBufferFlags::MultiDrawBatching is specified
+        const GLBuffer*                 soVertexBuffer_     = nullptr;  // Stream-output buffer that is bound as vertex buffer, used by DrawStreamOutput
+
+        ShadingRate                     shadingRate_        = ShadingRate::Rate1x1;
+        GLuint                          shadingRateImage_   = 0;        // Texture ID of the shading rate image, or 0 if only the per-draw shading rate is used
+
+        ScratchArena                    scratch_;                       // Transient arrays of single commands
 
 };
 
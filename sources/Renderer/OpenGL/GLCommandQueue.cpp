@@ -6,8 +6,11 @@
  */
 
 #include "GLCommandQueue.h"
+#include "GLCommandBuffer.h"
+#include "GLDeferredCommandBuffer.h"
 #include "../CheckedCast.h"
 #include "RenderState/GLFence.h"
+#include "RenderState/GLStateManager.h"
 
 
 namespace LLGL
@@ -16,15 +19,31 @@ namespace LLGL
 
 /* ----- Command queues ----- */
 
-void GLCommandQueue::Submit(CommandBuffer& /*commandBuffer*/)
+void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
-    // dummy
+    GLStateManager::active->FlushPendingDrawBatch();
+
+    /* Replay deferred command buffers; immediate command buffers have already been executed, so only their transient memory is closed */
+    if (auto deferredCommandBuffer = dynamic_cast<GLDeferredCommandBuffer*>(&commandBuffer))
+        deferredCommandBuffer->Execute();
+    else if (auto commandBufferGL = dynamic_cast<GLCommandBuffer*>(&commandBuffer))
+        commandBufferGL->SubmitTransientMemory();
+}
+
+void GLCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence, std::uint64_t signalValue)
+{
+    /* Command buffers are executed one after another, since there is no native batch submission */
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        GLCommandQueue::Submit(*commandBuffers[i]);
+    if (signalFence != nullptr)
+        GLCommandQueue::Signal(*signalFence, signalValue);
 }
 
 /* ----- Fences ----- */
 
 void GLCommandQueue::Submit(Fence& fence)
 {
+    GLStateManager::active->FlushPendingDrawBatch();
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     fenceGL.Submit();
 }
@@ -37,9 +56,44 @@ bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void GLCommandQueue::WaitIdle()
 {
+    GLStateManager::active->FlushPendingDrawBatch();
     glFinish();
 }
 
+/* ----- Timeline fences ----- */
+
+void GLCommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    GLStateManager::active->FlushPendingDrawBatch();
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    fenceGL.Signal(value);
+}
+
+void GLCommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    GLStateManager::active->FlushPendingDrawBatch();
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    fenceGL.ServerWait(value);
+}
+
+bool GLCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    return fenceGL.WaitValue(value, timeout);
+}
+
+bool GLCommandQueue::WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout)
+{
+    /* Wait for one fence after another (the timeout applies to each fence) */
+    for (std::uint32_t i = 0; i < numFences; ++i)
+    {
+        const bool signaled = (values != nullptr ? WaitFenceValue(*fences[i], values[i], timeout) : WaitFence(*fences[i], timeout));
+        if (!signaled)
+            return false;
+    }
+    return true;
+}
+
 
 } // /namespace LLGL
 
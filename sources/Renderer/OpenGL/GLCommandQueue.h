@@ -24,6 +24,7 @@ class GLCommandQueue final : public CommandQueue
         /* ----- Command queues ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence = nullptr, std::uint64_t signalValue = 0) override;
 
         /* ----- Fences ----- */
 
@@ -32,6 +33,13 @@ class GLCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+        /* ----- Timeline fences ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        bool WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout) override;
+
 };
 
 
@@ -0,0 +1,1347 @@
+/*
+ * GLDeferredCommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLDeferredCommandBuffer.h"
+#include "../../Core/Helper.h"
+#include "../../Core/Exception.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Alignment (in bytes) of all commands and command payloads within the byte stream.
+static const std::size_t g_commandAlignment = 8;
+
+// Returns the payload that follows the specified command structure.
+template <typename TPayload, typename TCommand>
+static TPayload* GetPayload(TCommand* cmd)
+{
+    auto bytes = reinterpret_cast<char*>(cmd) + GetAlignedSize(sizeof(TCommand), g_commandAlignment);
+    return reinterpret_cast<TPayload*>(bytes);
+}
+
+template <typename TPayload, typename TCommand>
+static const TPayload* GetPayload(const TCommand* cmd)
+{
+    auto bytes = reinterpret_cast<const char*>(cmd) + GetAlignedSize(sizeof(TCommand), g_commandAlignment);
+    return reinterpret_cast<const TPayload*>(bytes);
+}
+
+// Copy-constructs the payload elements in place, since not all payload types are trivially copyable.
+template <typename TPayload>
+static void CopyPayload(TPayload* dst, const TPayload* src, std::uint32_t count)
+{
+    for (std::uint32_t i = 0; i < count; ++i)
+        new (&dst[i]) TPayload(src[i]);
+}
+
+GLDeferredCommandBuffer::GLDeferredCommandBuffer(const std::shared_ptr<GLStateManager>& stateManager, StatisticsCounter& statistics, long flags) :
+    executor_ { stateManager, statistics, (flags & CommandBufferFlags::TimerScopeStatistics) }
+{
+}
+
+/* ----- Configuration ----- */
+
+void GLDeferredCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
+{
+    if (stateDesc != nullptr && stateDescSize == sizeof(OpenGLDependentStateDescriptor))
+    {
+        auto cmd = AllocCommand<GLCmdGraphicsAPIDependentState>(GLOpcode::SetGraphicsAPIDependentState);
+        cmd->desc = *reinterpret_cast<const OpenGLDependentStateDescriptor*>(stateDesc);
+    }
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void GLDeferredCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    auto cmd = AllocCommand<GLCmdViewport>(GLOpcode::SetViewport);
+    cmd->viewport = viewport;
+}
+
+void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    auto cmd = AllocCommand<GLCmdViewports>(GLOpcode::SetViewports, sizeof(Viewport) * numViewports);
+    cmd->numViewports = numViewports;
+    std::memcpy(GetPayload<Viewport>(cmd), viewports, sizeof(Viewport) * numViewports);
+}
+
+void GLDeferredCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    auto cmd = AllocCommand<GLCmdScissor>(GLOpcode::SetScissor);
+    cmd->scissor = scissor;
+}
+
+void GLDeferredCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    auto cmd = AllocCommand<GLCmdScissors>(GLOpcode::SetScissors, sizeof(Scissor) * numScissors);
+    cmd->numScissors = numScissors;
+    std::memcpy(GetPayload<Scissor>(cmd), scissors, sizeof(Scissor) * numScissors);
+}
+
+/* ----- Clear ----- */
+
+void GLDeferredCommandBuffer::SetClearColor(const ColorRGBAf& color)
+{
+    auto cmd = AllocCommand<GLCmdClearColor>(GLOpcode::SetClearColor);
+    cmd->color = color;
+}
+
+void GLDeferredCommandBuffer::SetClearDepth(float depth)
+{
+    auto cmd = AllocCommand<GLCmdClearDepth>(GLOpcode::SetClearDepth);
+    cmd->depth = depth;
+}
+
+void GLDeferredCommandBuffer::SetClearStencil(std::uint32_t stencil)
+{
+    auto cmd = AllocCommand<GLCmdClearStencil>(GLOpcode::SetClearStencil);
+    cmd->stencil = stencil;
+}
+
+void GLDeferredCommandBuffer::Clear(long flags)
+{
+    auto cmd = AllocCommand<GLCmdClear>(GLOpcode::Clear);
+    cmd->flags = flags;
+}
+
+void GLDeferredCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    auto cmd = AllocCommand<GLCmdClearAttachments>(GLOpcode::ClearAttachments, sizeof(AttachmentClear) * numAttachments);
+    cmd->numAttachments = numAttachments;
+    CopyPayload(GetPayload<AttachmentClear>(cmd), attachments, numAttachments);
+}
+
+/* ----- Input Assembly ------ */
+
+void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    auto cmd = AllocCommand<GLCmdBuffer>(GLOpcode::SetVertexBuffer);
+    cmd->buffer = &buffer;
+}
+
+void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<GLCmdVertexBufferOffset>(GLOpcode::SetVertexBufferOffset);
+    cmd->buffer = &buffer;
+    cmd->offset = offset;
+}
+
+void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    auto cmd = AllocCommand<GLCmdBufferArray>(GLOpcode::SetVertexBufferArray);
+    cmd->bufferArray = &bufferArray;
+}
+
+void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
+{
+    auto cmd = AllocCommand<GLCmdBuffer>(GLOpcode::SetIndexBuffer);
+    cmd->buffer = &buffer;
+}
+
+void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<GLCmdIndexBufferOffset>(GLOpcode::SetIndexBufferOffset);
+    cmd->buffer = &buffer;
+    cmd->format = format;
+    cmd->offset = offset;
+}
+
+/* ----- Stream Output Buffers ------ */
+
+void GLDeferredCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
+{
+    auto cmd = AllocCommand<GLCmdBuffer>(GLOpcode::SetStreamOutputBuffer);
+    cmd->buffer = &buffer;
+}
+
+void GLDeferredCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
+{
+    auto cmd = AllocCommand<GLCmdBufferArray>(GLOpcode::SetStreamOutputBufferArray);
+    cmd->bufferArray = &bufferArray;
+}
+
+void GLDeferredCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
+{
+    auto cmd = AllocCommand<GLCmdBeginStreamOutput>(GLOpcode::BeginStreamOutput);
+    cmd->primitiveType = primitiveType;
+}
+
+void GLDeferredCommandBuffer::EndStreamOutput()
+{
+    AllocOpcode(GLOpcode::EndStreamOutput);
+}
+
+void GLDeferredCommandBuffer::PauseStreamOutput()
+{
+    AllocOpcode(GLOpcode::PauseStreamOutput);
+}
+
+void GLDeferredCommandBuffer::ResumeStreamOutput()
+{
+    AllocOpcode(GLOpcode::ResumeStreamOutput);
+}
+
+/* ----- Resource Heaps ----- */
+
+void GLDeferredCommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    SetResourceHeap(GLOpcode::SetGraphicsResourceHeap, resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets);
+}
+
+void GLDeferredCommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    SetResourceHeap(GLOpcode::SetComputeResourceHeap, resourceHeap, firstSet, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constants ----- */
+
+void GLDeferredCommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    auto cmd = AllocCommand<GLCmdConstants>(GLOpcode::SetConstants, size);
+    cmd->stageFlags = stageFlags;
+    cmd->offset     = offset;
+    cmd->size       = size;
+    std::memcpy(GetPayload<char>(cmd), data, size);
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation GLDeferredCommandBuffer::AllocateTransient(std::uint64_t /*size*/, std::uint64_t /*alignment*/)
+{
+    /* A recording can be submitted multiple times, so its transient memory could not be recycled after a submission */
+    throw std::runtime_error("transient memory is not supported for GL command buffers with deferred submission");
+}
+
+/* ----- Render Targets ----- */
+
+void GLDeferredCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
+{
+    auto cmd = AllocCommand<GLCmdRenderTarget>(GLOpcode::SetRenderTarget);
+    cmd->renderTarget = &renderTarget;
+}
+
+void GLDeferredCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+{
+    auto cmd = AllocCommand<GLCmdRenderContext>(GLOpcode::SetRenderContext);
+    cmd->renderContext = &renderContext;
+}
+
+void GLDeferredCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    auto cmd = AllocCommand<GLCmdBeginRenderPass>(GLOpcode::BeginRenderPass, sizeof(ClearValue) * numClearValues);
+    cmd->renderTarget   = &renderTarget;
+    cmd->renderContext  = nullptr;
+    cmd->renderPass     = renderPass;
+    cmd->numClearValues = numClearValues;
+    if (numClearValues > 0)
+        CopyPayload(GetPayload<ClearValue>(cmd), clearValues, numClearValues);
+}
+
+void GLDeferredCommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    auto cmd = AllocCommand<GLCmdBeginRenderPass>(GLOpcode::BeginRenderPass, sizeof(ClearValue) * numClearValues);
+    cmd->renderTarget   = nullptr;
+    cmd->renderContext  = &renderContext;
+    cmd->renderPass     = renderPass;
+    cmd->numClearValues = numClearValues;
+    if (numClearValues > 0)
+        CopyPayload(GetPayload<ClearValue>(cmd), clearValues, numClearValues);
+}
+
+void GLDeferredCommandBuffer::EndRenderPass()
+{
+    AllocOpcode(GLOpcode::EndRenderPass);
+}
+
+void GLDeferredCommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    auto cmd = AllocCommand<GLCmdResolveRenderTarget>(GLOpcode::ResolveRenderTarget);
+    cmd->srcRenderTarget    = &srcRenderTarget;
+    cmd->dstTexture         = &dstTexture;
+    cmd->srcColorAttachment = srcColorAttachment;
+}
+
+void GLDeferredCommandBuffer::DiscardAttachments(long flags)
+{
+    auto cmd = AllocCommand<GLCmdDiscardAttachments>(GLOpcode::DiscardAttachments);
+    cmd->flags = flags;
+}
+
+/* ----- Pipeline States ----- */
+
+void GLDeferredCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    auto cmd = AllocCommand<GLCmdGraphicsPipeline>(GLOpcode::SetGraphicsPipeline);
+    cmd->graphicsPipeline = &graphicsPipeline;
+}
+
+void GLDeferredCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    auto cmd = AllocCommand<GLCmdComputePipeline>(GLOpcode::SetComputePipeline);
+    cmd->computePipeline = &computePipeline;
+}
+
+void GLDeferredCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    auto cmd = AllocCommand<GLCmdSetShadingRate>(GLOpcode::SetShadingRate);
+    cmd->rate = rate;
+}
+
+void GLDeferredCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    auto cmd = AllocCommand<GLCmdSetShadingRateImage>(GLOpcode::SetShadingRateImage);
+    cmd->texture = texture;
+}
+
+void GLDeferredCommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    auto cmd = AllocCommand<GLCmdSetStencilReference>(GLOpcode::SetStencilReference);
+    cmd->reference = reference;
+}
+
+void GLDeferredCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    auto cmd = AllocCommand<GLCmdSetBlendFactor>(GLOpcode::SetBlendFactor);
+    cmd->color = color;
+}
+
+void GLDeferredCommandBuffer::SetDepthBias(const DepthBiasDescriptor& depthBias)
+{
+    auto cmd = AllocCommand<GLCmdSetDepthBias>(GLOpcode::SetDepthBias);
+    cmd->depthBias = depthBias;
+}
+
+void GLDeferredCommandBuffer::SetDepthBounds(float minBounds, float maxBounds)
+{
+    auto cmd = AllocCommand<GLCmdSetDepthBounds>(GLOpcode::SetDepthBounds);
+    cmd->minBounds = minBounds;
+    cmd->maxBounds = maxBounds;
+}
+
+/* ----- Queries ----- */
+
+void GLDeferredCommandBuffer::BeginQuery(Query& query)
+{
+    auto cmd = AllocCommand<GLCmdQuery>(GLOpcode::BeginQuery);
+    cmd->query = &query;
+}
+
+void GLDeferredCommandBuffer::EndQuery(Query& query)
+{
+    auto cmd = AllocCommand<GLCmdQuery>(GLOpcode::EndQuery);
+    cmd->query = &query;
+}
+
+bool GLDeferredCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    /* Query results are returned immediately and cannot be recorded */
+    return executor_.QueryResult(query, result);
+}
+
+bool GLDeferredCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    /* Query results are returned immediately and cannot be recorded */
+    return executor_.QueryPipelineStatisticsResult(query, result);
+}
+
+void GLDeferredCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+{
+    auto cmd = AllocCommand<GLCmdBeginRenderCondition>(GLOpcode::BeginRenderCondition);
+    cmd->query  = &query;
+    cmd->mode   = mode;
+}
+
+void GLDeferredCommandBuffer::EndRenderCondition()
+{
+    AllocOpcode(GLOpcode::EndRenderCondition);
+}
+
+void GLDeferredCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto cmd = AllocCommand<GLCmdQueryHeap>(GLOpcode::BeginQueryHeap);
+    cmd->queryHeap  = &queryHeap;
+    cmd->query      = query;
+}
+
+void GLDeferredCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto cmd = AllocCommand<GLCmdQueryHeap>(GLOpcode::EndQueryHeap);
+    cmd->queryHeap  = &queryHeap;
+    cmd->query      = query;
+}
+
+void GLDeferredCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    auto cmd = AllocCommand<GLCmdBeginRenderConditionQueryHeap>(GLOpcode::BeginRenderConditionQueryHeap);
+    cmd->queryHeap  = &queryHeap;
+    cmd->query      = query;
+    cmd->mode       = mode;
+}
+
+bool GLDeferredCommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
+{
+    /* Query results are returned immediately and cannot be recorded */
+    return executor_.QueryResults(queryHeap, firstQuery, numQueries, results);
+}
+
+void GLDeferredCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
+{
+    auto cmd = AllocCommand<GLCmdResolveQueries>(GLOpcode::ResolveQueries);
+    cmd->queryHeap  = &queryHeap;
+    cmd->firstQuery = firstQuery;
+    cmd->numQueries = numQueries;
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+}
+
+/* ----- Timer Scopes ----- */
+
+void GLDeferredCommandBuffer::BeginTimerScope(const char* name)
+{
+    const auto nameLength = (name != nullptr ? std::strlen(name) : 0);
+    auto cmd = AllocCommand<GLCmdBeginTimerScope>(GLOpcode::BeginTimerScope, nameLength + 1);
+    cmd->nameLength = static_cast<std::uint32_t>(nameLength);
+    auto nameCopy = GetPayload<char>(cmd);
+    if (nameLength > 0)
+        std::memcpy(nameCopy, name, nameLength);
+    nameCopy[nameLength] = '\0';
+}
+
+void GLDeferredCommandBuffer::EndTimerScope()
+{
+    AllocOpcode(GLOpcode::EndTimerScope);
+}
+
+bool GLDeferredCommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
+{
+    /* Timer scopes are measured by the executor, whose results are returned immediately */
+    return executor_.QueryTimerScopes(frame);
+}
+
+/* ----- Debug Markers ----- */
+
+void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    AllocDebugMarker(GLOpcode::PushDebugGroup, name);
+    #endif
+}
+
+void GLDeferredCommandBuffer::PopDebugGroup()
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    AllocOpcode(GLOpcode::PopDebugGroup);
+    #endif
+}
+
+void GLDeferredCommandBuffer::InsertDebugMarker(const char* name)
+{
+    #ifdef LLGL_ENABLE_DEBUG_MARKERS
+    AllocDebugMarker(GLOpcode::InsertDebugMarker, name);
+    #endif
+}
+
+/* ----- Drawing ----- */
+
+void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    auto cmd = AllocCommand<GLCmdDraw>(GLOpcode::Draw);
+    cmd->numVertices    = numVertices;
+    cmd->firstVertex    = firstVertex;
+}
+
+void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndexed>(GLOpcode::DrawIndexed);
+    cmd->numIndices     = numIndices;
+    cmd->firstIndex     = firstIndex;
+}
+
+void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndexed>(GLOpcode::DrawIndexedBaseVertex);
+    cmd->numIndices     = numIndices;
+    cmd->firstIndex     = firstIndex;
+    cmd->vertexOffset   = vertexOffset;
+}
+
+void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    auto cmd = AllocCommand<GLCmdDraw>(GLOpcode::DrawInstanced);
+    cmd->numVertices    = numVertices;
+    cmd->firstVertex    = firstVertex;
+    cmd->numInstances   = numInstances;
+}
+
+void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    auto cmd = AllocCommand<GLCmdDraw>(GLOpcode::DrawInstancedBaseInstance);
+    cmd->numVertices    = numVertices;
+    cmd->firstVertex    = firstVertex;
+    cmd->numInstances   = numInstances;
+    cmd->firstInstance  = firstInstance;
+}
+
+void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndexed>(GLOpcode::DrawIndexedInstanced);
+    cmd->numIndices     = numIndices;
+    cmd->numInstances   = numInstances;
+    cmd->firstIndex     = firstIndex;
+}
+
+void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndexed>(GLOpcode::DrawIndexedInstancedBaseVertex);
+    cmd->numIndices     = numIndices;
+    cmd->numInstances   = numInstances;
+    cmd->firstIndex     = firstIndex;
+    cmd->vertexOffset   = vertexOffset;
+}
+
+void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndexed>(GLOpcode::DrawIndexedInstancedBaseVertexBaseInstance);
+    cmd->numIndices     = numIndices;
+    cmd->numInstances   = numInstances;
+    cmd->firstIndex     = firstIndex;
+    cmd->vertexOffset   = vertexOffset;
+    cmd->firstInstance  = firstInstance;
+}
+
+void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    DrawIndirect(buffer, offset, 1, 0);
+}
+
+void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndirect>(GLOpcode::DrawIndirect);
+    cmd->buffer         = &buffer;
+    cmd->offset         = offset;
+    cmd->numCommands    = numCommands;
+    cmd->stride         = stride;
+}
+
+void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    DrawIndexedIndirect(buffer, offset, 1, 0);
+}
+
+void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<GLCmdDrawIndirect>(GLOpcode::DrawIndexedIndirect);
+    cmd->buffer         = &buffer;
+    cmd->offset         = offset;
+    cmd->numCommands    = numCommands;
+    cmd->stride         = stride;
+}
+
+void GLDeferredCommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  /*layout*/,
+    Buffer&                 /*argumentBuffer*/,
+    std::uint64_t           /*argumentOffset*/,
+    std::uint32_t           /*maxNumCommands*/,
+    Buffer*                 /*countBuffer*/,
+    std::uint64_t           /*countOffset*/)
+{
+    // dummy (not supported by OpenGL, indirect command layouts cannot be created with this renderer)
+}
+
+void GLDeferredCommandBuffer::DrawStreamOutput()
+{
+    AllocOpcode(GLOpcode::DrawStreamOutput);
+}
+
+void GLDeferredCommandBuffer::DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    auto cmd = AllocCommand<GLCmdDrawMeshTasks>(GLOpcode::DrawMeshTasks);
+    cmd->groupSize[0] = groupSizeX;
+    cmd->groupSize[1] = groupSizeY;
+    cmd->groupSize[2] = groupSizeZ;
+}
+
+void GLDeferredCommandBuffer::DrawMeshTasksIndirect(
+    Buffer&         /*buffer*/,
+    std::uint64_t   /*offset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    /* GL_NV_mesh_shader reads indirect arguments as (count, first), which is incompatible with DrawMeshTasksIndirectArguments */
+    ThrowNotSupportedExcept(__FUNCTION__, "indirect mesh tasks");
+}
+
+/* ----- Compute ----- */
+
+void GLDeferredCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    auto cmd = AllocCommand<GLCmdDispatch>(GLOpcode::Dispatch);
+    cmd->groupSize[0] = groupSizeX;
+    cmd->groupSize[1] = groupSizeY;
+    cmd->groupSize[2] = groupSizeZ;
+}
+
+void GLDeferredCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<GLCmdDispatchIndirect>(GLOpcode::DispatchIndirect);
+    cmd->buffer = &buffer;
+    cmd->offset = offset;
+}
+
+void GLDeferredCommandBuffer::DispatchBarrier()
+{
+    AllocOpcode(GLOpcode::DispatchBarrier);
+}
+
+/* ----- Acceleration Structures ----- */
+
+void GLDeferredCommandBuffer::BuildAccelerationStructures(std::uint32_t /*numAccelerationStructures*/, AccelerationStructure* const * /*accelerationStructures*/)
+{
+    // dummy (acceleration structures are not supported by OpenGL)
+}
+
+void GLDeferredCommandBuffer::CompactAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/)
+{
+    // dummy (acceleration structures are not supported by OpenGL)
+}
+
+/* ----- Copy ----- */
+
+void GLDeferredCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto cmd = AllocCommand<GLCmdCopyBuffer>(GLOpcode::CopyBuffer);
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+    cmd->srcBuffer  = &srcBuffer;
+    cmd->srcOffset  = srcOffset;
+    cmd->size       = size;
+}
+
+void GLDeferredCommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    auto cmd = AllocCommand<GLCmdCopyCounterToBuffer>(GLOpcode::CopyCounterToBuffer);
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+    cmd->srcBuffer  = &srcBuffer;
+}
+
+void GLDeferredCommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    auto cmd = AllocCommand<GLCmdSetBufferCounter>(GLOpcode::SetBufferCounter);
+    cmd->buffer = &buffer;
+    cmd->value  = value;
+}
+
+void GLDeferredCommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    auto cmd = AllocCommand<GLCmdFillBuffer>(GLOpcode::FillBuffer);
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+    cmd->fillSize   = fillSize;
+    cmd->value      = value;
+}
+
+void GLDeferredCommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto cmd = AllocCommand<GLCmdCopyTexture>(GLOpcode::CopyTexture);
+    cmd->dstTexture     = &dstTexture;
+    cmd->dstLocation    = dstLocation;
+    cmd->srcTexture     = &srcTexture;
+    cmd->srcRegion      = srcRegion;
+}
+
+void GLDeferredCommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    auto cmd = AllocCommand<GLCmdClearTexture>(GLOpcode::ClearTexture);
+    cmd->texture        = &texture;
+    cmd->subresource    = subresource;
+    cmd->clearValue     = clearValue;
+}
+
+void GLDeferredCommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    auto cmd = AllocCommand<GLCmdCopyBufferTexture>(GLOpcode::CopyBufferToTexture);
+    cmd->buffer     = &srcBuffer;
+    cmd->offset     = srcOffset;
+    cmd->texture    = &dstTexture;
+    cmd->region     = dstRegion;
+    cmd->rowStride  = rowStride;
+}
+
+void GLDeferredCommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    auto cmd = AllocCommand<GLCmdCopyBufferTexture>(GLOpcode::CopyTextureToBuffer);
+    cmd->buffer     = &dstBuffer;
+    cmd->offset     = dstOffset;
+    cmd->texture    = &srcTexture;
+    cmd->region     = srcRegion;
+    cmd->rowStride  = rowStride;
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void GLDeferredCommandBuffer::Begin()
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+void GLDeferredCommandBuffer::End()
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+void GLDeferredCommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    // dummy (secondary command buffers are not supported)
+}
+
+/* ----- Extended functions ----- */
+
+void GLDeferredCommandBuffer::Execute()
+{
+    const char* pc  = buffer_.data();
+    const char* end = pc + buffer_.size();
+
+    while (pc < end)
+    {
+        auto header = reinterpret_cast<const GLCommandHeader*>(pc);
+        auto cmd    = pc + sizeof(GLCommandHeader);
+
+        switch (header->opcode)
+        {
+            case GLOpcode::SetGraphicsAPIDependentState:
+            {
+                auto c = reinterpret_cast<const GLCmdGraphicsAPIDependentState*>(cmd);
+                executor_.SetGraphicsAPIDependentState(&(c->desc), sizeof(c->desc));
+            }
+            break;
+
+            case GLOpcode::SetViewport:
+            {
+                auto c = reinterpret_cast<const GLCmdViewport*>(cmd);
+                executor_.SetViewport(c->viewport);
+            }
+            break;
+
+            case GLOpcode::SetViewports:
+            {
+                auto c = reinterpret_cast<const GLCmdViewports*>(cmd);
+                executor_.SetViewports(c->numViewports, GetPayload<Viewport>(c));
+            }
+            break;
+
+            case GLOpcode::SetScissor:
+            {
+                auto c = reinterpret_cast<const GLCmdScissor*>(cmd);
+                executor_.SetScissor(c->scissor);
+            }
+            break;
+
+            case GLOpcode::SetScissors:
+            {
+                auto c = reinterpret_cast<const GLCmdScissors*>(cmd);
+                executor_.SetScissors(c->numScissors, GetPayload<Scissor>(c));
+            }
+            break;
+
+            case GLOpcode::SetClearColor:
+            {
+                auto c = reinterpret_cast<const GLCmdClearColor*>(cmd);
+                executor_.SetClearColor(c->color);
+            }
+            break;
+
+            case GLOpcode::SetClearDepth:
+            {
+                auto c = reinterpret_cast<const GLCmdClearDepth*>(cmd);
+                executor_.SetClearDepth(c->depth);
+            }
+            break;
+
+            case GLOpcode::SetClearStencil:
+            {
+                auto c = reinterpret_cast<const GLCmdClearStencil*>(cmd);
+                executor_.SetClearStencil(c->stencil);
+            }
+            break;
+
+            case GLOpcode::Clear:
+            {
+                auto c = reinterpret_cast<const GLCmdClear*>(cmd);
+                executor_.Clear(c->flags);
+            }
+            break;
+
+            case GLOpcode::ClearAttachments:
+            {
+                auto c = reinterpret_cast<const GLCmdClearAttachments*>(cmd);
+                executor_.ClearAttachments(c->numAttachments, GetPayload<AttachmentClear>(c));
+            }
+            break;
+
+            case GLOpcode::SetVertexBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdBuffer*>(cmd);
+                executor_.SetVertexBuffer(*(c->buffer));
+            }
+            break;
+
+            case GLOpcode::SetVertexBufferOffset:
+            {
+                auto c = reinterpret_cast<const GLCmdVertexBufferOffset*>(cmd);
+                executor_.SetVertexBuffer(*(c->buffer), c->offset);
+            }
+            break;
+
+            case GLOpcode::SetVertexBufferArray:
+            {
+                auto c = reinterpret_cast<const GLCmdBufferArray*>(cmd);
+                executor_.SetVertexBufferArray(*(c->bufferArray));
+            }
+            break;
+
+            case GLOpcode::SetIndexBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdBuffer*>(cmd);
+                executor_.SetIndexBuffer(*(c->buffer));
+            }
+            break;
+
+            case GLOpcode::SetIndexBufferOffset:
+            {
+                auto c = reinterpret_cast<const GLCmdIndexBufferOffset*>(cmd);
+                executor_.SetIndexBuffer(*(c->buffer), c->format, c->offset);
+            }
+            break;
+
+            case GLOpcode::SetStreamOutputBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdBuffer*>(cmd);
+                executor_.SetStreamOutputBuffer(*(c->buffer));
+            }
+            break;
+
+            case GLOpcode::SetStreamOutputBufferArray:
+            {
+                auto c = reinterpret_cast<const GLCmdBufferArray*>(cmd);
+                executor_.SetStreamOutputBufferArray(*(c->bufferArray));
+            }
+            break;
+
+            case GLOpcode::BeginStreamOutput:
+            {
+                auto c = reinterpret_cast<const GLCmdBeginStreamOutput*>(cmd);
+                executor_.BeginStreamOutput(c->primitiveType);
+            }
+            break;
+
+            case GLOpcode::EndStreamOutput:
+            {
+                executor_.EndStreamOutput();
+            }
+            break;
+
+            case GLOpcode::PauseStreamOutput:
+            {
+                executor_.PauseStreamOutput();
+            }
+            break;
+
+            case GLOpcode::ResumeStreamOutput:
+            {
+                executor_.ResumeStreamOutput();
+            }
+            break;
+
+            case GLOpcode::SetGraphicsResourceHeap:
+            {
+                auto c = reinterpret_cast<const GLCmdResourceHeap*>(cmd);
+                executor_.SetGraphicsResourceHeap(*(c->resourceHeap), c->firstSet, c->numDynamicOffsets, GetPayload<std::uint32_t>(c));
+            }
+            break;
+
+            case GLOpcode::SetComputeResourceHeap:
+            {
+                auto c = reinterpret_cast<const GLCmdResourceHeap*>(cmd);
+                executor_.SetComputeResourceHeap(*(c->resourceHeap), c->firstSet, c->numDynamicOffsets, GetPayload<std::uint32_t>(c));
+            }
+            break;
+
+            case GLOpcode::SetConstants:
+            {
+                auto c = reinterpret_cast<const GLCmdConstants*>(cmd);
+                executor_.SetConstants(c->stageFlags, c->offset, c->size, GetPayload<char>(c));
+            }
+            break;
+
+            case GLOpcode::SetRenderTarget:
+            {
+                auto c = reinterpret_cast<const GLCmdRenderTarget*>(cmd);
+                executor_.SetRenderTarget(*(c->renderTarget));
+            }
+            break;
+
+            case GLOpcode::SetRenderContext:
+            {
+                auto c = reinterpret_cast<const GLCmdRenderContext*>(cmd);
+                executor_.SetRenderTarget(*(c->renderContext));
+            }
+            break;
+
+            case GLOpcode::BeginRenderPass:
+            {
+                auto c = reinterpret_cast<const GLCmdBeginRenderPass*>(cmd);
+                if (c->renderTarget != nullptr)
+                    executor_.BeginRenderPass(*(c->renderTarget), c->renderPass, c->numClearValues, GetPayload<ClearValue>(c));
+                else
+                    executor_.BeginRenderPass(*(c->renderContext), c->renderPass, c->numClearValues, GetPayload<ClearValue>(c));
+            }
+            break;
+
+            case GLOpcode::EndRenderPass:
+            {
+                executor_.EndRenderPass();
+            }
+            break;
+
+            case GLOpcode::ResolveRenderTarget:
+            {
+                auto c = reinterpret_cast<const GLCmdResolveRenderTarget*>(cmd);
+                executor_.ResolveRenderTarget(*(c->srcRenderTarget), *(c->dstTexture), c->srcColorAttachment);
+            }
+            break;
+
+            case GLOpcode::DiscardAttachments:
+            {
+                auto c = reinterpret_cast<const GLCmdDiscardAttachments*>(cmd);
+                executor_.DiscardAttachments(c->flags);
+            }
+            break;
+
+            case GLOpcode::SetGraphicsPipeline:
+            {
+                auto c = reinterpret_cast<const GLCmdGraphicsPipeline*>(cmd);
+                executor_.SetGraphicsPipeline(*(c->graphicsPipeline));
+            }
+            break;
+
+            case GLOpcode::SetComputePipeline:
+            {
+                auto c = reinterpret_cast<const GLCmdComputePipeline*>(cmd);
+                executor_.SetComputePipeline(*(c->computePipeline));
+            }
+            break;
+
+            case GLOpcode::SetShadingRate:
+            {
+                auto c = reinterpret_cast<const GLCmdSetShadingRate*>(cmd);
+                executor_.SetShadingRate(c->rate);
+            }
+            break;
+
+            case GLOpcode::SetShadingRateImage:
+            {
+                auto c = reinterpret_cast<const GLCmdSetShadingRateImage*>(cmd);
+                executor_.SetShadingRateImage(c->texture);
+            }
+            break;
+
+            case GLOpcode::SetStencilReference:
+            {
+                auto c = reinterpret_cast<const GLCmdSetStencilReference*>(cmd);
+                executor_.SetStencilReference(c->reference);
+            }
+            break;
+
+            case GLOpcode::SetBlendFactor:
+            {
+                auto c = reinterpret_cast<const GLCmdSetBlendFactor*>(cmd);
+                executor_.SetBlendFactor(c->color);
+            }
+            break;
+
+            case GLOpcode::SetDepthBias:
+            {
+                auto c = reinterpret_cast<const GLCmdSetDepthBias*>(cmd);
+                executor_.SetDepthBias(c->depthBias);
+            }
+            break;
+
+            case GLOpcode::SetDepthBounds:
+            {
+                auto c = reinterpret_cast<const GLCmdSetDepthBounds*>(cmd);
+                executor_.SetDepthBounds(c->minBounds, c->maxBounds);
+            }
+            break;
+
+            case GLOpcode::BeginQuery:
+            {
+                auto c = reinterpret_cast<const GLCmdQuery*>(cmd);
+                executor_.BeginQuery(*(c->query));
+            }
+            break;
+
+            case GLOpcode::EndQuery:
+            {
+                auto c = reinterpret_cast<const GLCmdQuery*>(cmd);
+                executor_.EndQuery(*(c->query));
+            }
+            break;
+
+            case GLOpcode::BeginRenderCondition:
+            {
+                auto c = reinterpret_cast<const GLCmdBeginRenderCondition*>(cmd);
+                executor_.BeginRenderCondition(*(c->query), c->mode);
+            }
+            break;
+
+            case GLOpcode::EndRenderCondition:
+            {
+                executor_.EndRenderCondition();
+            }
+            break;
+
+            case GLOpcode::BeginQueryHeap:
+            {
+                auto c = reinterpret_cast<const GLCmdQueryHeap*>(cmd);
+                executor_.BeginQuery(*(c->queryHeap), c->query);
+            }
+            break;
+
+            case GLOpcode::EndQueryHeap:
+            {
+                auto c = reinterpret_cast<const GLCmdQueryHeap*>(cmd);
+                executor_.EndQuery(*(c->queryHeap), c->query);
+            }
+            break;
+
+            case GLOpcode::BeginRenderConditionQueryHeap:
+            {
+                auto c = reinterpret_cast<const GLCmdBeginRenderConditionQueryHeap*>(cmd);
+                executor_.BeginRenderCondition(*(c->queryHeap), c->query, c->mode);
+            }
+            break;
+
+            case GLOpcode::ResolveQueries:
+            {
+                auto c = reinterpret_cast<const GLCmdResolveQueries*>(cmd);
+                executor_.ResolveQueries(*(c->queryHeap), c->firstQuery, c->numQueries, *(c->dstBuffer), c->dstOffset);
+            }
+            break;
+
+            case GLOpcode::BeginTimerScope:
+            {
+                auto c = reinterpret_cast<const GLCmdBeginTimerScope*>(cmd);
+                executor_.BeginTimerScope(GetPayload<char>(c));
+            }
+            break;
+
+            case GLOpcode::EndTimerScope:
+            {
+                executor_.EndTimerScope();
+            }
+            break;
+
+            case GLOpcode::PushDebugGroup:
+            {
+                auto c = reinterpret_cast<const GLCmdDebugMarker*>(cmd);
+                executor_.PushDebugGroup(GetPayload<char>(c));
+            }
+            break;
+
+            case GLOpcode::PopDebugGroup:
+            {
+                executor_.PopDebugGroup();
+            }
+            break;
+
+            case GLOpcode::InsertDebugMarker:
+            {
+                auto c = reinterpret_cast<const GLCmdDebugMarker*>(cmd);
+                executor_.InsertDebugMarker(GetPayload<char>(c));
+            }
+            break;
+
+            case GLOpcode::Draw:
+            {
+                auto c = reinterpret_cast<const GLCmdDraw*>(cmd);
+                executor_.Draw(c->numVertices, c->firstVertex);
+            }
+            break;
+
+            case GLOpcode::DrawInstanced:
+            {
+                auto c = reinterpret_cast<const GLCmdDraw*>(cmd);
+                executor_.DrawInstanced(c->numVertices, c->firstVertex, c->numInstances);
+            }
+            break;
+
+            case GLOpcode::DrawInstancedBaseInstance:
+            {
+                auto c = reinterpret_cast<const GLCmdDraw*>(cmd);
+                executor_.DrawInstanced(c->numVertices, c->firstVertex, c->numInstances, c->firstInstance);
+            }
+            break;
+
+            case GLOpcode::DrawIndexed:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndexed*>(cmd);
+                executor_.DrawIndexed(c->numIndices, c->firstIndex);
+            }
+            break;
+
+            case GLOpcode::DrawIndexedBaseVertex:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndexed*>(cmd);
+                executor_.DrawIndexed(c->numIndices, c->firstIndex, c->vertexOffset);
+            }
+            break;
+
+            case GLOpcode::DrawIndexedInstanced:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndexed*>(cmd);
+                executor_.DrawIndexedInstanced(c->numIndices, c->numInstances, c->firstIndex);
+            }
+            break;
+
+            case GLOpcode::DrawIndexedInstancedBaseVertex:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndexed*>(cmd);
+                executor_.DrawIndexedInstanced(c->numIndices, c->numInstances, c->firstIndex, c->vertexOffset);
+            }
+            break;
+
+            case GLOpcode::DrawIndexedInstancedBaseVertexBaseInstance:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndexed*>(cmd);
+                executor_.DrawIndexedInstanced(c->numIndices, c->numInstances, c->firstIndex, c->vertexOffset, c->firstInstance);
+            }
+            break;
+
+            case GLOpcode::DrawIndirect:
+            {
+                /* Single commands avoid the multi-draw path */
+                auto c = reinterpret_cast<const GLCmdDrawIndirect*>(cmd);
+                if (c->numCommands == 1)
+                    executor_.DrawIndirect(*c->buffer, c->offset);
+                else
+                    executor_.DrawIndirect(*c->buffer, c->offset, c->numCommands, c->stride);
+            }
+            break;
+
+            case GLOpcode::DrawIndexedIndirect:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawIndirect*>(cmd);
+                if (c->numCommands == 1)
+                    executor_.DrawIndexedIndirect(*c->buffer, c->offset);
+                else
+                    executor_.DrawIndexedIndirect(*c->buffer, c->offset, c->numCommands, c->stride);
+            }
+            break;
+
+            case GLOpcode::DrawStreamOutput:
+            {
+                executor_.DrawStreamOutput();
+            }
+            break;
+
+            case GLOpcode::DrawMeshTasks:
+            {
+                auto c = reinterpret_cast<const GLCmdDrawMeshTasks*>(cmd);
+                executor_.DrawMeshTasks(c->groupSize[0], c->groupSize[1], c->groupSize[2]);
+            }
+            break;
+
+            case GLOpcode::Dispatch:
+            {
+                auto c = reinterpret_cast<const GLCmdDispatch*>(cmd);
+                executor_.Dispatch(c->groupSize[0], c->groupSize[1], c->groupSize[2]);
+            }
+            break;
+
+            case GLOpcode::DispatchIndirect:
+            {
+                auto c = reinterpret_cast<const GLCmdDispatchIndirect*>(cmd);
+                executor_.DispatchIndirect(*c->buffer, c->offset);
+            }
+            break;
+
+            case GLOpcode::DispatchBarrier:
+            {
+                executor_.DispatchBarrier();
+            }
+            break;
+
+            case GLOpcode::CopyBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdCopyBuffer*>(cmd);
+                executor_.CopyBuffer(*c->dstBuffer, c->dstOffset, *c->srcBuffer, c->srcOffset, c->size);
+            }
+            break;
+
+            case GLOpcode::CopyCounterToBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdCopyCounterToBuffer*>(cmd);
+                executor_.CopyCounterToBuffer(*c->dstBuffer, c->dstOffset, *c->srcBuffer);
+            }
+            break;
+
+            case GLOpcode::SetBufferCounter:
+            {
+                auto c = reinterpret_cast<const GLCmdSetBufferCounter*>(cmd);
+                executor_.SetBufferCounter(*c->buffer, c->value);
+            }
+            break;
+
+            case GLOpcode::FillBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdFillBuffer*>(cmd);
+                executor_.FillBuffer(*c->dstBuffer, c->dstOffset, c->fillSize, c->value);
+            }
+            break;
+
+            case GLOpcode::CopyTexture:
+            {
+                auto c = reinterpret_cast<const GLCmdCopyTexture*>(cmd);
+                executor_.CopyTexture(*c->dstTexture, c->dstLocation, *c->srcTexture, c->srcRegion);
+            }
+            break;
+
+            case GLOpcode::ClearTexture:
+            {
+                auto c = reinterpret_cast<const GLCmdClearTexture*>(cmd);
+                executor_.ClearTexture(*c->texture, c->subresource, c->clearValue);
+            }
+            break;
+
+            case GLOpcode::CopyBufferToTexture:
+            {
+                auto c = reinterpret_cast<const GLCmdCopyBufferTexture*>(cmd);
+                executor_.CopyBufferToTexture(*c->texture, c->region, *c->buffer, c->offset, c->rowStride);
+            }
+            break;
+
+            case GLOpcode::CopyTextureToBuffer:
+            {
+                auto c = reinterpret_cast<const GLCmdCopyBufferTexture*>(cmd);
+                executor_.CopyTextureToBuffer(*c->buffer, c->offset, *c->texture, c->region, c->rowStride);
+            }
+            break;
+        }
+
+        pc += header->size;
+    }
+
+    /* Keep recording for re-submission, until the next command is recorded */
+    submitted_ = true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename T>
+T* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t payloadSize)
+{
+    auto size = GetAlignedSize(sizeof(T), g_commandAlignment) + payloadSize;
+    return reinterpret_cast<T*>(AllocCommandBytes(opcode, size));
+}
+
+void GLDeferredCommandBuffer::AllocOpcode(const GLOpcode opcode)
+{
+    AllocCommandBytes(opcode, 0);
+}
+
+char* GLDeferredCommandBuffer::AllocCommandBytes(const GLOpcode opcode, std::size_t size)
+{
+    /* Discard previous recording once it has been submitted */
+    if (submitted_)
+    {
+        buffer_.clear();
+        submitted_ = false;
+    }
+
+    /* Append command header and zero-initialized command structure */
+    auto offset     = buffer_.size();
+    auto cmdSize    = GetAlignedSize(sizeof(GLCommandHeader) + size, g_commandAlignment);
+
+    buffer_.resize(offset + cmdSize);
+
+    auto header = reinterpret_cast<GLCommandHeader*>(&buffer_[offset]);
+    {
+        header->opcode  = opcode;
+        header->size    = static_cast<std::uint32_t>(cmdSize);
+    }
+
+    return (&buffer_[offset] + sizeof(GLCommandHeader));
+}
+
+void GLDeferredCommandBuffer::AllocDebugMarker(const GLOpcode opcode, const char* name)
+{
+    const auto nameLength = (name != nullptr ? std::strlen(name) : 0);
+    auto cmd = AllocCommand<GLCmdDebugMarker>(opcode, nameLength + 1);
+    cmd->nameLength = static_cast<std::uint32_t>(nameLength);
+    auto nameCopy = GetPayload<char>(cmd);
+    if (nameLength > 0)
+        std::memcpy(nameCopy, name, nameLength);
+    nameCopy[nameLength] = '\0';
+}
+
+void GLDeferredCommandBuffer::SetResourceHeap(
+    const GLOpcode          opcode,
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
+{
+    auto cmd = AllocCommand<GLCmdResourceHeap>(opcode, sizeof(std::uint32_t) * numDynamicOffsets);
+    cmd->resourceHeap       = &resourceHeap;
+    cmd->firstSet           = firstSet;
+    cmd->numDynamicOffsets  = numDynamicOffsets;
+    if (numDynamicOffsets > 0)
+        std::memcpy(GetPayload<std::uint32_t>(cmd), dynamicOffsets, sizeof(std::uint32_t) * numDynamicOffsets);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,188 @@
+/*
+ * GLDrawBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLDrawBatch.h"
+#include "Ext/GLExtensions.h"
+#include "Ext/GLExtensionLoader.h"
+#include "RenderState/GLStateManager.h"
+
+
+namespace LLGL
+{
+
+
+// Minimal number of draw commands in a batch to submit them from the indirect buffer instead of the client-side arrays.
+static const GLsizei g_minNumIndirectDraws = 32;
+
+GLDrawBatch::GLDrawBatch(GLStateManager& stateMngr) :
+    stateMngr_ { stateMngr }
+{
+}
+
+GLDrawBatch::~GLDrawBatch()
+{
+    if (indirectBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &indirectBuffer_);
+        stateMngr_.NotifyBufferRelease(indirectBuffer_, GLBufferTarget::DRAW_INDIRECT_BUFFER);
+    }
+}
+
+void GLDrawBatch::AppendArrays(GLenum mode, GLint first, GLsizei count)
+{
+    Prepare(BatchType::Arrays, mode, GL_UNSIGNED_INT, 4);
+    firsts_.push_back(first);
+    counts_.push_back(count);
+    ++numDraws_;
+}
+
+void GLDrawBatch::AppendElements(GLenum mode, GLenum indexType, GLsizeiptr indexStride, GLuint firstIndex, GLsizei count, GLint baseVertex)
+{
+    Prepare(BatchType::Elements, mode, indexType, indexStride);
+    firsts_.push_back(static_cast<GLint>(firstIndex));
+    counts_.push_back(count);
+    baseVertices_.push_back(baseVertex);
+    ++numDraws_;
+}
+
+void GLDrawBatch::Submit()
+{
+    if (numDraws_ > 0)
+    {
+        if (numDraws_ < g_minNumIndirectDraws || !SubmitIndirect())
+        {
+            if (type_ == BatchType::Arrays)
+                SubmitArrays();
+            else
+                SubmitElements();
+        }
+    }
+
+    /* Clear batch but keep the capacity of its arrays */
+    type_       = BatchType::Undefined;
+    numDraws_   = 0;
+    firsts_.clear();
+    counts_.clear();
+    baseVertices_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLDrawBatch::Prepare(BatchType type, GLenum mode, GLenum indexType, GLsizeiptr indexStride)
+{
+    /* Submit previous draw commands if they are incompatible with the next one */
+    if (type_ != type || mode_ != mode || indexType_ != indexType)
+    {
+        Submit();
+        type_           = type;
+        mode_           = mode;
+        indexType_      = indexType;
+        indexStride_    = indexStride;
+    }
+}
+
+void GLDrawBatch::SubmitArrays()
+{
+    if (numDraws_ > 1 && HasExtension(GLExt::EXT_multi_draw_arrays))
+        glMultiDrawArrays(mode_, firsts_.data(), counts_.data(), numDraws_);
+    else
+    {
+        for (GLsizei i = 0; i < numDraws_; ++i)
+            glDrawArrays(mode_, firsts_[i], counts_[i]);
+    }
+}
+
+void GLDrawBatch::SubmitElements()
+{
+    /* Convert first indices into byte offsets, which must be passed to GL as void-pointers */
+    indexOffsets_.resize(static_cast<std::size_t>(numDraws_));
+    for (GLsizei i = 0; i < numDraws_; ++i)
+    {
+        const GLsizeiptr indices = firsts_[i] * indexStride_;
+        indexOffsets_[i] = reinterpret_cast<const GLvoid*>(indices);
+    }
+
+    if (numDraws_ > 1)
+    {
+        glMultiDrawElementsBaseVertex(
+            mode_,
+            counts_.data(),
+            indexType_,
+            indexOffsets_.data(),
+            numDraws_,
+            baseVertices_.data()
+        );
+    }
+    else
+    {
+        glDrawElementsBaseVertex(
+            mode_,
+            counts_.front(),
+            indexType_,
+            indexOffsets_.front(),
+            baseVertices_.front()
+        );
+    }
+}
+
+bool GLDrawBatch::SubmitIndirect()
+{
+    #if defined GL_ARB_multi_draw_indirect && !defined __APPLE__
+
+    if (!HasExtension(GLExt::ARB_multi_draw_indirect))
+        return false;
+
+    /* Convert draw commands into indirect commands */
+    indirectCommands_.resize(static_cast<std::size_t>(numDraws_));
+    for (GLsizei i = 0; i < numDraws_; ++i)
+    {
+        auto& cmd = indirectCommands_[i];
+        {
+            cmd.count           = static_cast<GLuint>(counts_[i]);
+            cmd.instanceCount   = 1;
+            cmd.first           = static_cast<GLuint>(firsts_[i]);
+            cmd.baseVertex      = (type_ == BatchType::Elements ? baseVertices_[i] : 0);
+            cmd.baseInstance    = 0;
+        }
+    }
+
+    /* Upload indirect commands into new storage of the indirect buffer, so the previous batch does not stall the pipeline */
+    if (indirectBuffer_ == 0)
+        glGenBuffers(1, &indirectBuffer_);
+
+    stateMngr_.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, indirectBuffer_);
+    glBufferData(
+        GL_DRAW_INDIRECT_BUFFER,
+        static_cast<GLsizeiptr>(sizeof(IndirectCommand) * indirectCommands_.size()),
+        indirectCommands_.data(),
+        GL_STREAM_DRAW
+    );
+
+    /* Submit all draw commands at once */
+    if (type_ == BatchType::Arrays)
+        glMultiDrawArraysIndirect(mode_, nullptr, numDraws_, sizeof(IndirectCommand));
+    else
+        glMultiDrawElementsIndirect(mode_, indexType_, nullptr, numDraws_, sizeof(IndirectCommand));
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_multi_draw_indirect
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
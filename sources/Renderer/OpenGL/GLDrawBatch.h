@@ -0,0 +1,111 @@
+/*
+ * GLDrawBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_DRAW_BATCH_H
+#define LLGL_GL_DRAW_BATCH_H
+
+
+#include "OpenGL.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class GLStateManager;
+
+/*
+Batch of consecutive draw commands that share all render states, which are submitted with a single multi-draw command.
+Non-indexed draws are submitted with 'glMultiDrawArrays', indexed draws with 'glMultiDrawElementsBaseVertex',
+and large batches with 'glMultiDrawArraysIndirect' or 'glMultiDrawElementsIndirect' from an indirect buffer that is owned by the batch.
+A draw command that cannot be appended to the current batch (i.e. another primitive topology or index type) submits the batch first.
+*/
+class GLDrawBatch
+{
+
+    public:
+
+        GLDrawBatch(GLStateManager& stateMngr);
+        ~GLDrawBatch();
+
+        GLDrawBatch(const GLDrawBatch&) = delete;
+        GLDrawBatch& operator = (const GLDrawBatch&) = delete;
+
+        // Appends a non-indexed draw command.
+        void AppendArrays(GLenum mode, GLint first, GLsizei count);
+
+        // Appends an indexed draw command, where 'firstIndex' is in units of the index type.
+        void AppendElements(GLenum mode, GLenum indexType, GLsizeiptr indexStride, GLuint firstIndex, GLsizei count, GLint baseVertex);
+
+        // Submits all pending draw commands and clears the batch.
+        void Submit();
+
+        // Returns true if there are no pending draw commands.
+        inline bool IsEmpty() const
+        {
+            return (numDraws_ == 0);
+        }
+
+    private:
+
+        enum class BatchType
+        {
+            Undefined,
+            Arrays,
+            Elements,
+        };
+
+        // Layout of 'DrawArraysIndirectCommand' and 'DrawElementsIndirectCommand' of GL_ARB_draw_indirect.
+        struct IndirectCommand
+        {
+            GLuint count;
+            GLuint instanceCount;
+            GLuint first;
+            GLint  baseVertex;      // Base instance for arrays
+            GLuint baseInstance;    // Unused for arrays
+        };
+
+        // Makes the batch compatible with a draw command of the specified type, mode, and index type.
+        void Prepare(BatchType type, GLenum mode, GLenum indexType, GLsizeiptr indexStride);
+
+        void SubmitArrays();
+        void SubmitElements();
+
+        // Submits the pending draw commands from the indirect buffer. Returns false if multi-draw-indirect is not supported.
+        bool SubmitIndirect();
+
+    private:
+
+        GLStateManager&                 stateMngr_;
+
+        BatchType                       type_           = BatchType::Undefined;
+        GLenum                          mode_           = GL_TRIANGLES;
+        GLenum                          indexType_      = GL_UNSIGNED_INT;
+        GLsizeiptr                      indexStride_    = 4;
+        GLsizei                         numDraws_       = 0;
+
+        std::vector<GLint>              firsts_;        // First vertex or first index of each draw command
+        std::vector<GLsizei>            counts_;
+        std::vector<GLint>              baseVertices_;
+        std::vector<const GLvoid*>      indexOffsets_;  // Scratch buffer for the byte offsets of indexed draw commands
+
+        std::vector<IndirectCommand>    indirectCommands_;
+        GLuint                          indirectBuffer_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -12,24 +12,25 @@
 extern "C"
 {
 
-LLGL_EXPORT int LLGL_RenderSystem_BuildID()
+LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, OpenGL)()
 {
     return LLGL_BUILD_ID;
 }
 
-LLGL_EXPORT int LLGL_RenderSystem_RendererID()
+LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, OpenGL)()
 {
     return LLGL::RendererID::OpenGL;
 }
 
-LLGL_EXPORT const char* LLGL_RenderSystem_Name()
+LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, OpenGL)()
 {
     return "OpenGL";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* /*renderSystemDesc*/)
+LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, OpenGL)(const void* renderSystemDesc)
 {
-    return new LLGL::GLRenderSystem();
+    auto desc = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+    return new LLGL::GLRenderSystem(*desc);
 }
 
 } // /extern "C"
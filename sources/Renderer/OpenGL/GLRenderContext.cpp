@@ -6,6 +6,7 @@
  */
 
 #include "GLRenderContext.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -51,7 +52,9 @@ GLRenderContext::GLRenderContext(RenderContextDescriptor desc, const std::shared
 
 void GLRenderContext::Present()
 {
+    stateMngr_->FlushPendingDrawBatch();
     context_->SwapBuffers();
+    ++presentCount_;
 }
 
 Format GLRenderContext::QueryColorFormat() const
@@ -84,6 +87,20 @@ bool GLRenderContext::GLMakeCurrent(GLRenderContext* renderContext)
  * ======= Private: =======
  */
 
+// Returns the swap interval for the specified presentation mode and V-sync (negative intervals enable adaptive V-sync).
+static int GetSwapInterval(const PresentMode presentMode, const VsyncDescriptor& vsyncDesc)
+{
+    const int interval = std::max(1, static_cast<int>(vsyncDesc.interval));
+    switch (presentMode)
+    {
+        case PresentMode::Fifo:         return interval;
+        case PresentMode::FifoRelaxed:  return -interval;
+        case PresentMode::Mailbox:      return 0;
+        case PresentMode::Immediate:    return 0;
+        default:                        return (vsyncDesc.enabled ? static_cast<int>(vsyncDesc.interval) : 0);
+    }
+}
+
 bool GLRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 {
     /* Update context height */
@@ -93,6 +110,10 @@ bool GLRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
     /* Notify GL context of a resize */
     context_->Resize(videoModeDesc.resolution);
 
+    /* Update swap interval for the new presentation mode */
+    if (GetVideoMode().presentMode != videoModeDesc.presentMode)
+        context_->SetSwapInterval(GetSwapInterval(videoModeDesc.presentMode, GetVsync()));
+
     /* Switch fullscreen mode */
     if (!SwitchFullscreenMode(videoModeDesc))
         return false;
@@ -102,8 +123,12 @@ bool GLRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 
 bool GLRenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 {
-    int swapInterval = (vsyncDesc.enabled ? static_cast<int>(vsyncDesc.interval) : 0);
-    return context_->SetSwapInterval(swapInterval);
+    return context_->SetSwapInterval(GetSwapInterval(GetVideoMode().presentMode, vsyncDesc));
+}
+
+bool GLRenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    return context_->QueryFrameStatistics(frameStats);
 }
 
 void GLRenderContext::InitRenderStates()
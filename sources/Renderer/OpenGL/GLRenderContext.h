@@ -50,6 +50,18 @@ class GLRenderContext final : public RenderContext
             return stateMngr_;
         }
 
+        // Returns the platform specific GL context of this render context.
+        inline GLContext& GetGLContext() const
+        {
+            return *context_;
+        }
+
+        // Returns the number of times this render context has been presented.
+        inline std::uint64_t GetPresentCount() const
+        {
+            return presentCount_;
+        }
+
     private:
 
         struct RenderState
@@ -61,6 +73,7 @@ class GLRenderContext final : public RenderContext
 
         bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+        bool OnQueryFrameStatistics(FrameStatistics& frameStats) override;
 
         void InitRenderStates();
 
@@ -79,6 +92,8 @@ class GLRenderContext final : public RenderContext
 
         GLint                           contextHeight_      = 0;
 
+        std::uint64_t                   presentCount_       = 0;
+
 };
 
 
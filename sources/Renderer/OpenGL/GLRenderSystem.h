@@ -12,22 +12,32 @@
 #include <LLGL/RenderSystem.h>
 #include "Ext/GLExtensionLoader.h"
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
+#include "../TextureReadbackPool.h"
+#include "../StatisticsCounter.h"
 
 #include "GLCommandQueue.h"
 #include "GLCommandBuffer.h"
+#include "GLDeferredCommandBuffer.h"
 #include "GLRenderContext.h"
 
 #include "Buffer/GLBuffer.h"
 #include "Buffer/GLBufferArray.h"
+#include "Buffer/GLVertexArrayCache.h"
 
 #include "Shader/GLShader.h"
 #include "Shader/GLShaderProgram.h"
+#include "Shader/GLProgramCache.h"
 
 #include "Texture/GLTexture.h"
 #include "Texture/GLSampler.h"
 #include "Texture/GLRenderTarget.h"
+#include "Texture/GLMipGenerator.h"
+#include "Texture/GLPixelUnpackRing.h"
 
 #include "RenderState/GLQuery.h"
+#include "RenderState/GLQueryHeap.h"
+#include "RenderState/GLRenderPass.h"
 #include "RenderState/GLFence.h"
 #include "RenderState/GLPipelineLayout.h"
 #include "RenderState/GLGraphicsPipeline.h"
@@ -38,6 +48,9 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <map>
+#include <mutex>
+#include <thread>
 
 
 namespace LLGL
@@ -54,6 +67,9 @@ class GLRenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
+        GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
+        ~GLRenderSystem();
+
         void SetConfiguration(const RenderSystemConfiguration& config) override;
 
         /* ----- Render Context ----- */
@@ -68,8 +84,9 @@ class GLRenderSystem final : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
         CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -84,20 +101,32 @@ class GLRenderSystem final : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
 
         void Release(Texture& texture) override;
 
         void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
 
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
 
+        bool QuerySparseTileShape(const Format format, const TextureType type, Extent3D& tileShape) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& region, bool commit) override;
+        void SetTextureMinLOD(Texture& texture, float minLOD) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -110,12 +139,20 @@ class GLRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
 
         void Release(RenderTarget& renderTarget) override;
 
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& desc) override;
@@ -138,18 +175,33 @@ class GLRenderSystem final : public RenderSystem
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+        bool QueryMemoryStatistics(MemoryStatistics& statistics) override;
+        bool QueryTimestampCalibration(TimestampCalibration& calibration) override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
 
         void Release(Query& query) override;
 
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
         /* ----- Fences ----- */
 
         Fence* CreateFence() override;
 
         void Release(Fence& fence) override;
 
+        /* ----- Worker threads ----- */
+
+        bool AttachWorkerThread() override;
+        void DetachWorkerThread() override;
+
     protected:
 
         RenderContext* AddRenderContext(std::unique_ptr<GLRenderContext>&& renderContext, const RenderContextDescriptor& desc);
@@ -164,6 +216,27 @@ class GLRenderSystem final : public RenderSystem
 
         GLRenderContext* GetSharedRenderContext() const;
 
+        // Returns the GL context all other contexts share their objects with, i.e. the headless context or the first render context, or null if there is none.
+        GLContext* GetSharedGLContext() const;
+
+        // Creates and activates the offscreen GL context for headless mode, see OpenGLRendererConfiguration::headless.
+        void CreateHeadlessContext(const ProfileOpenGLDescriptor& profile);
+
+        // Returns true if the calling thread has been attached as worker thread.
+        bool IsWorkerThread();
+
+        // Returns the program binary cache, or null if it is disabled or not supported.
+        const GLProgramCache* GetProgramCache();
+
+        // Returns the single-pass MIP-map generator if it is enabled and supports the specified texture, or null otherwise.
+        GLMipGenerator* GetMipGenerator(const GLTexture& textureGL);
+
+        // Returns the staging ring buffer for texture uploads if it is enabled and supported on the calling thread, or null otherwise.
+        GLPixelUnpackRing* GetPixelUnpackRing();
+
+        // Writes all MIP levels after the first one of the initial image data, if it contains a MIP-map chain.
+        void WriteTextureMipChain(GLTexture& textureGL, const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc);
+
         void GenerateMipsPrimary(GLuint texID, const TextureType texType);
         void GenerateSubMipsWithFBO(GLTexture& textureGL, const Extent3D& extent, GLint baseMipLevel, GLint numMipLevels, GLint baseArrayLayer, GLint numArrayLayers);
         void GenerateSubMipsWithTextureView(GLTexture& textureGL, GLuint baseMipLevel, GLuint numMipLevels, GLuint baseArrayLayer, GLuint numArrayLayers);
@@ -180,16 +253,20 @@ class GLRenderSystem final : public RenderSystem
         };
         #endif // /LLGL_ENABLE_CUSTOM_SUB_MIPGEN
 
+        std::unique_ptr<GLContext>              headlessContext_;       // Offscreen GL context in headless mode, which must outlive all other objects
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<GLRenderContext>      renderContexts_;
         HWObjectInstance<GLCommandQueue>        commandQueue_;
-        HWObjectContainer<GLCommandBuffer>      commandBuffers_;
+        HWObjectContainer<CommandBuffer>        commandBuffers_;
         HWObjectContainer<GLBuffer>             buffers_;
         HWObjectContainer<GLBufferArray>        bufferArrays_;
         HWObjectContainer<GLTexture>            textures_;
         HWObjectContainer<GLSampler>            samplers_;
+        SamplerCache                            samplerCache_;          // Shares sampler objects between identical sampler descriptors
         HWObjectContainer<GLRenderTarget>       renderTargets_;
+        HWObjectContainer<GLRenderPass>         renderPasses_;
         HWObjectContainer<GLShader>             shaders_;
         HWObjectContainer<GLShaderProgram>      shaderPrograms_;
         HWObjectContainer<GLPipelineLayout>     pipelineLayouts_;
@@ -197,10 +274,28 @@ class GLRenderSystem final : public RenderSystem
         HWObjectContainer<GLComputePipeline>    computePipelines_;
         HWObjectContainer<GLResourceHeap>       resourceHeaps_;
         HWObjectContainer<GLQuery>              queries_;
+        HWObjectContainer<GLQueryHeap>          queryHeaps_;
         HWObjectContainer<GLFence>              fences_;
 
         DebugCallback                           debugCallback_;
 
+        RenderingLimits                         limits_;                // Copy of the rendering limits, which does not enforce the deferred capability queries
+
+        TextureReadbackPool<GLuint>             textureReadbacks_;      // Pixel pack buffers of asynchronous texture readbacks
+        TextureReadbackPool<GLuint>             bufferReadbacks_;       // Copy buffers of asynchronous buffer readbacks
+
+        GLVertexArrayCache                      vertexArrayCache_;      // Format-only VAOs shared between vertex buffers (GL_ARB_vertex_attrib_binding)
+
+        StatisticsCounter                       statistics_;            // Shared with all command buffers, see LLGL_ENABLE_STATISTICS
+
+        std::map<std::thread::id, std::unique_ptr<GLContext>> workerContexts_;  // Worker contexts of all attached worker threads, see AttachWorkerThread
+        std::mutex                              workerContextsMutex_;
+        std::mutex                              resourcesMutex_;        // Guards the buffer and texture containers, which can be modified by worker threads
+
+        std::unique_ptr<GLProgramCache>         programCache_;          // Created on demand, see RenderSystemConfiguration::shaderCacheDirectory
+        std::unique_ptr<GLMipGenerator>         mipGenerator_;          // Created on demand, see RenderSystemConfiguration::singlePassMipGeneration
+        std::unique_ptr<GLPixelUnpackRing>      pixelUnpackRing_;       // Created on demand, see RenderSystemConfiguration::textureStagingBufferSize
+
         #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
         MipGenerationFBOPair                    mipGenerationFBOPair_;
         #endif // /LLGL_ENABLE_CUSTOM_SUB_MIPGEN
@@ -9,10 +9,16 @@
 #include "Ext/GLExtensions.h"
 #include "../CheckedCast.h"
 #include "../../Core/Helper.h"
+#include "../../Core/Assertion.h"
 #include "../GLCommon/GLTypes.h"
+#include "../GLCommon/GLCore.h"
 #include "Buffer/GLVertexBuffer.h"
 #include "Buffer/GLIndexBuffer.h"
 #include "Buffer/GLVertexBufferArray.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -76,6 +82,131 @@ static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, co
     }
 }
 
+// Returns true if the specified buffer can be stored as ring of regions.
+static bool IsRingBuffer(const BufferDescriptor& desc)
+{
+    return
+    (
+        (desc.flags & BufferFlags::PersistentMapping) != 0 &&
+        (desc.type == BufferType::Vertex || desc.type == BufferType::Constant)
+    );
+}
+
+// Returns the distance (in bytes) between two regions of a ring. Each region must start at an offset that can be used with 'glBindBufferRange'.
+static GLsizeiptr GetRingRegionStride(const BufferDescriptor& desc)
+{
+    GLint offsetAlignment = 1;
+    if (desc.type == BufferType::Constant)
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+    const auto regionSize   = static_cast<GLsizeiptr>(desc.size);
+    const auto alignment    = static_cast<GLsizeiptr>(std::max(1, offsetAlignment));
+
+    return ((regionSize + alignment - 1) / alignment) * alignment;
+}
+
+#ifdef GL_ARB_buffer_storage
+
+static void GLBufferStoragePersistentRing(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
+{
+    const auto regionSize   = static_cast<GLsizeiptr>(desc.size);
+    const auto regionStride = GetRingRegionStride(desc);
+    const auto bufferSize   = regionStride * static_cast<GLsizeiptr>(GLBuffer::numRingRegions);
+
+    /* Allocate immutable storage, which remains mapped for the entire lifetime of the buffer */
+    GLbitfield flagsGL = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+    if ((desc.flags & BufferFlags::MapReadAccess) != 0)
+        flagsGL |= GL_MAP_READ_BIT;
+
+    void* mappedData = nullptr;
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedBufferStorage(bufferGL.GetID(), bufferSize, nullptr, flagsGL);
+        mappedData = glMapNamedBufferRange(bufferGL.GetID(), 0, bufferSize, flagsGL);
+    }
+    else
+    #endif
+    {
+        GLStateManager::active->BindBuffer(bufferGL);
+        glBufferStorage(GetGLBufferTarget(bufferGL), bufferSize, nullptr, flagsGL);
+        mappedData = glMapBufferRange(GetGLBufferTarget(bufferGL), 0, bufferSize, flagsGL);
+    }
+
+    if (!mappedData)
+        throw std::runtime_error("failed to map GL buffer persistently");
+
+    /* Initialize all regions with the initial data */
+    if (initialData)
+    {
+        for (std::uint32_t i = 0; i < GLBuffer::numRingRegions; ++i)
+            std::memcpy(reinterpret_cast<char*>(mappedData) + i * regionStride, initialData, static_cast<std::size_t>(regionSize));
+    }
+
+    bufferGL.InitPersistentRing(regionSize, regionStride, mappedData);
+}
+
+#endif // /GL_ARB_buffer_storage
+
+#ifdef GL_ARB_map_buffer_range
+
+// Allocates a streaming ring in mutable storage, which is used without GL_ARB_buffer_storage (e.g. for OpenGL ES 3).
+static void GLBufferStorageStreamingRing(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
+{
+    const auto regionSize   = static_cast<GLsizeiptr>(desc.size);
+    const auto regionStride = GetRingRegionStride(desc);
+    const auto bufferSize   = regionStride * static_cast<GLsizeiptr>(GLBuffer::numRingRegions);
+    const auto target       = GetGLBufferTarget(bufferGL);
+
+    /* Allocate mutable storage with a usage hint for data that is written once and used a few times */
+    GLStateManager::active->BindBuffer(bufferGL);
+    glBufferData(target, bufferSize, nullptr, GL_STREAM_DRAW);
+
+    /* Initialize the first region with the initial data (all other regions are written from the shadow before they are used) */
+    if (initialData)
+        glBufferSubData(target, 0, regionSize, initialData);
+
+    bufferGL.InitStreamingRing(regionSize, regionStride, initialData);
+}
+
+#endif // /GL_ARB_map_buffer_range
+
+// Allocates the storage of the specified buffer, either as persistently mapped ring, as streaming ring, or as regular buffer storage.
+// Returns true if the specified buffer is an append or consume storage buffer with a hidden counter.
+static bool HasBufferCounter(const BufferDescriptor& desc)
+{
+    return
+    (
+        desc.type == BufferType::Storage &&
+        (desc.storageBuffer.storageType == StorageBufferType::AppendStructuredBuffer ||
+         desc.storageBuffer.storageType == StorageBufferType::ConsumeStructuredBuffer)
+    );
+}
+
+static void GLBufferStorageOrRing(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
+{
+    if (IsRingBuffer(desc))
+    {
+        #ifdef GL_ARB_buffer_storage
+        if (HasExtension(GLExt::ARB_buffer_storage))
+        {
+            GLBufferStoragePersistentRing(bufferGL, desc, initialData);
+            return;
+        }
+        #endif
+
+        #ifdef GL_ARB_map_buffer_range
+        if (HasExtension(GLExt::ARB_map_buffer_range) && HasExtension(GLExt::ARB_sync))
+        {
+            GLBufferStorageStreamingRing(bufferGL, desc, initialData);
+            return;
+        }
+        #endif
+    }
+    GLBufferStorage(bufferGL, desc, initialData);
+}
+
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
@@ -85,12 +216,38 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
     {
         case BufferType::Vertex:
         {
+            /* Vertex array objects are not shared between GL contexts */
+            if (IsWorkerThread())
+                throw std::runtime_error("cannot create vertex buffer on OpenGL worker thread");
+
             /* Create vertex buffer and build vertex array */
             auto bufferGL = MakeUnique<GLVertexBuffer>();
+            {
+                GLBufferStorageOrRing(*bufferGL, desc, initialData);
+                bufferGL->BuildVertexArray(desc.vertexBuffer.format, vertexArrayCache_);
+            }
+            std::lock_guard<std::mutex> guard { resourcesMutex_ };
+            return TakeOwnership(buffers_, std::move(bufferGL));
+        }
+        break;
+
+        case BufferType::StreamOutput:
+        {
+            /* Stream-output buffers can also be drawn as vertex buffers, but only with a vertex format */
+            const bool hasVertexFormat = !desc.vertexBuffer.format.attributes.empty();
+            if (hasVertexFormat && IsWorkerThread())
+                throw std::runtime_error("cannot create stream-output buffer with vertex format on OpenGL worker thread");
+
+            /* Create stream-output buffer with its own transform feedback object, so its vertex count is recorded by the GPU */
+            auto bufferGL = MakeUnique<GLVertexBuffer>(BufferType::StreamOutput);
             {
                 GLBufferStorage(*bufferGL, desc, initialData);
-                bufferGL->BuildVertexArray(desc.vertexBuffer.format);
+                if (hasVertexFormat)
+                    bufferGL->BuildVertexArray(desc.vertexBuffer.format, vertexArrayCache_);
+                if (HasExtension(GLExt::ARB_transform_feedback2))
+                    bufferGL->CreateTransformFeedback();
             }
+            std::lock_guard<std::mutex> guard { resourcesMutex_ };
             return TakeOwnership(buffers_, std::move(bufferGL));
         }
         break;
@@ -102,6 +259,7 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
             {
                 GLBufferStorage(*bufferGL, desc, initialData);
             }
+            std::lock_guard<std::mutex> guard { resourcesMutex_ };
             return TakeOwnership(buffers_, std::move(bufferGL));
         }
         break;
@@ -111,8 +269,11 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
             /* Create generic buffer */
             auto bufferGL = MakeUnique<GLBuffer>(desc.type);
             {
-                GLBufferStorage(*bufferGL, desc, initialData);
+                GLBufferStorageOrRing(*bufferGL, desc, initialData);
+                if (HasBufferCounter(desc))
+                    bufferGL->CreateCounter();
             }
+            std::lock_guard<std::mutex> guard { resourcesMutex_ };
             return TakeOwnership(buffers_, std::move(bufferGL));
         }
     }
@@ -127,7 +288,7 @@ BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
     {
         /* Create vertex buffer array and build VAO */
         auto vertexBufferArray = MakeUnique<GLVertexBufferArray>();
-        vertexBufferArray->BuildVertexArray(numBuffers, bufferArray);
+        vertexBufferArray->BuildVertexArray(numBuffers, bufferArray, vertexArrayCache_);
         return TakeOwnership(bufferArrays_, std::move(vertexBufferArray));
     }
 
@@ -137,6 +298,7 @@ BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 void GLRenderSystem::Release(Buffer& buffer)
 {
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -149,8 +311,28 @@ void GLRenderSystem::Release(BufferArray& bufferArray)
 
 void GLRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_STATISTICS_ADD(bytesUploaded, dataSize);
+
+    /* Submit pending draw commands that might still read the previous buffer content */
+    GLStateManager::active->FlushPendingDrawBatch();
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
 
+    if (bufferGL.IsPersistentRing())
+    {
+        /* Write data into next region of persistently mapped ring */
+        auto dst = bufferGL.MapNextRegion(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize));
+        std::memcpy(dst + offset, data, dataSize);
+        return;
+    }
+
+    if (bufferGL.IsStreamingRing())
+    {
+        /* Write data into next region of streaming ring */
+        bufferGL.WriteNextStreamingRegion(data, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize));
+        return;
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -176,8 +358,25 @@ void GLRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t d
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    GLStateManager::active->FlushPendingDrawBatch();
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
 
+    if (bufferGL.IsPersistentRing())
+    {
+        /* Return next region for write access (content of current region is preserved), or current region for read-only access */
+        if (access == CPUAccess::ReadOnly)
+            return bufferGL.MapCurrentRegion();
+        else
+            return bufferGL.MapNextRegion(0, 0);
+    }
+
+    if (bufferGL.IsStreamingRing())
+    {
+        /* Return shadow of streaming ring, which is written into the next region when the buffer is unmapped */
+        return bufferGL.MapStreamingShadow(access != CPUAccess::ReadOnly);
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -191,10 +390,89 @@ void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
     }
 }
 
+#ifdef GL_ARB_map_buffer_range
+
+static GLbitfield GetGLMapBufferRangeAccess(const CPUAccess access)
+{
+    switch (access)
+    {
+        case CPUAccess::ReadOnly:   return GL_MAP_READ_BIT;
+        case CPUAccess::WriteOnly:  return GL_MAP_WRITE_BIT;
+        case CPUAccess::ReadWrite:  return (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+    }
+    return 0;
+}
+
+#endif
+
+void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    GLStateManager::active->FlushPendingDrawBatch();
+
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    if (bufferGL.IsPersistentRing())
+    {
+        /* Only preserve the content outside of the mapped range for write-only access */
+        if (access == CPUAccess::ReadOnly)
+            return bufferGL.MapCurrentRegion() + offset;
+        else if (access == CPUAccess::WriteOnly)
+            return bufferGL.MapNextRegion(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(length)) + offset;
+        else
+            return bufferGL.MapNextRegion(0, 0) + offset;
+    }
+
+    if (bufferGL.IsStreamingRing())
+        return bufferGL.MapStreamingShadow(access != CPUAccess::ReadOnly) + offset;
+
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+        if (HasExtension(GLExt::ARB_direct_state_access))
+        {
+            return glMapNamedBufferRange(
+                bufferGL.GetID(),
+                static_cast<GLintptr>(offset),
+                static_cast<GLsizeiptr>(length),
+                GetGLMapBufferRangeAccess(access)
+            );
+        }
+        else
+        #endif
+        {
+            GLStateManager::active->BindBuffer(bufferGL);
+            return glMapBufferRange(
+                GetGLBufferTarget(bufferGL),
+                static_cast<GLintptr>(offset),
+                static_cast<GLsizeiptr>(length),
+                GetGLMapBufferRangeAccess(access)
+            );
+        }
+    }
+    #endif // /GL_ARB_map_buffer_range
+
+    /* Map entire buffer as fallback */
+    if (auto data = reinterpret_cast<char*>(MapBuffer(buffer, access)))
+        return data + offset;
+
+    return nullptr;
+}
+
 void GLRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
 
+    /* Persistently mapped rings remain mapped */
+    if (bufferGL.IsPersistentRing())
+        return;
+
+    if (bufferGL.IsStreamingRing())
+    {
+        bufferGL.UnmapStreamingShadow();
+        return;
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -208,6 +486,70 @@ void GLRenderSystem::UnmapBuffer(Buffer& buffer)
     }
 }
 
+std::uint32_t GLRenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
+{
+    GLStateManager::active->FlushPendingDrawBatch();
+
+    if (!HasExtension(GLExt::ARB_copy_buffer))
+        ErrUnsupportedGLProc("glCopyBufferSubData");
+
+    auto& bufferGL  = LLGL_CAST(GLBuffer&, buffer);
+    auto& fenceGL   = LLGL_CAST(GLFence&, fence);
+
+    /* Allocate readback and (re-)allocate its copy buffer if it is too small */
+    auto readback = bufferReadbacks_.Alloc(size);
+    auto& rb = bufferReadbacks_.Get(readback);
+
+    if (rb.staging == 0)
+        glGenBuffers(1, &rb.staging);
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, rb.staging);
+
+    if (rb.capacity < size)
+    {
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        rb.capacity = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.dataSize = size;
+
+    /* Copy range into the readback buffer, which does not block the CPU since the data remains in GPU memory (rings are read from their current region) */
+    const auto srcOffset = static_cast<GLintptr>(offset) + (bufferGL.IsRing() ? bufferGL.GetRegionOffset() : 0);
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, bufferGL.GetID());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, 0, static_cast<GLsizeiptr>(size));
+
+    /* Submit fence after the copy command */
+    fenceGL.Submit();
+
+    return readback;
+}
+
+void GLRenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    LLGL_ASSERT_PTR(data);
+
+    auto& rb = bufferReadbacks_.Get(readback);
+    AssertBufferReadbackDataSize(dataSize, rb.dataSize);
+
+    /* Wait until the buffer data has been copied into the readback buffer */
+    auto& fenceGL = LLGL_CAST(GLFence&, *rb.fence);
+    fenceGL.Wait(~0ull);
+
+    /* Map readback buffer and copy buffer data into the output */
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, rb.staging);
+
+    if (auto mappedData = glMapBuffer(GL_COPY_READ_BUFFER, GL_READ_ONLY))
+    {
+        ::memcpy(data, mappedData, static_cast<std::size_t>(rb.dataSize));
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+    }
+
+    /* Return readback buffer to the pool */
+    bufferReadbacks_.Free(readback);
+}
+
 
 } // /namespace LLGL
 
@@ -14,6 +14,8 @@
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 #include "GLRenderingCaps.h"
+#include <LLGL/Timer.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -22,10 +24,43 @@ namespace LLGL
 
 /* ----- Render System ----- */
 
+GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
+{
+    /* Extract optional renderer configuartion */
+    const OpenGLRendererConfiguration* rendererConfigGL = nullptr;
+
+    if (renderSystemDesc.rendererConfig != nullptr && renderSystemDesc.rendererConfigSize > 0)
+    {
+        if (renderSystemDesc.rendererConfigSize == sizeof(OpenGLRendererConfiguration))
+            rendererConfigGL = reinterpret_cast<const OpenGLRendererConfiguration*>(renderSystemDesc.rendererConfig);
+        else
+            throw std::invalid_argument("invalid renderer configuration structure (expected size of 'OpenGLRendererConfiguration' structure)");
+    }
+
+    /* Create offscreen GL context in headless mode, which takes the place of the render contexts */
+    if (rendererConfigGL != nullptr && rendererConfigGL->headless)
+        CreateHeadlessContext(rendererConfigGL->profileOpenGL);
+}
+
+GLRenderSystem::~GLRenderSystem()
+{
+    /* Release readback buffers while the GL context is still alive */
+    textureReadbacks_.Clear([](GLuint& buffer) { glDeleteBuffers(1, &buffer); });
+    bufferReadbacks_.Clear([](GLuint& buffer) { glDeleteBuffers(1, &buffer); });
+    mipGenerator_.reset();
+    pixelUnpackRing_.reset();
+}
+
 void GLRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 {
     RenderSystem::SetConfiguration(config);
     GLTexImageInitialization(config.imageInitialization);
+
+    /* Program cache is re-created on demand with the new cache directory */
+    programCache_.reset();
+
+    /* Staging ring buffer is re-created on demand with the new size */
+    pixelUnpackRing_.reset();
 }
 
 /* ----- Render Context ----- */
@@ -36,8 +71,41 @@ GLRenderContext* GLRenderSystem::GetSharedRenderContext() const
     return (!renderContexts_.empty() ? renderContexts_.begin()->get() : nullptr);
 }
 
+// private
+GLContext* GLRenderSystem::GetSharedGLContext() const
+{
+    if (headlessContext_)
+        return headlessContext_.get();
+    if (auto sharedContext = GetSharedRenderContext())
+        return &(sharedContext->GetGLContext());
+    return nullptr;
+}
+
+// private
+bool GLRenderSystem::IsWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+    return (workerContexts_.find(std::this_thread::get_id()) != workerContexts_.end());
+}
+
+// private
+const GLProgramCache* GLRenderSystem::GetProgramCache()
+{
+    /* Program binaries are only valid for the driver they were retrieved from, so the renderer info must be available */
+    if (!programCache_)
+    {
+        const auto& cacheDirectory = GetConfiguration().shaderCacheDirectory;
+        if (!cacheDirectory.empty() && GetSharedGLContext() != nullptr && HasExtension(GLExt::ARB_get_program_binary))
+            programCache_ = MakeUnique<GLProgramCache>(cacheDirectory, GetRendererInfo());
+    }
+    return programCache_.get();
+}
+
 RenderContext* GLRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
 {
+    /* Objects of the headless context cannot be shared with window-based GL contexts */
+    if (headlessContext_)
+        throw std::runtime_error("cannot create OpenGL render context in headless mode");
     return AddRenderContext(MakeUnique<GLRenderContext>(desc, surface, GetSharedRenderContext()), desc);
 }
 
@@ -55,18 +123,39 @@ CommandQueue* GLRenderSystem::GetCommandQueue()
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* GLRenderSystem::CreateCommandBuffer()
+CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return CreateCommandBufferExt();
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+    {
+        /* Get state manager from shared GL context */
+        if (auto sharedContext = GetSharedGLContext())
+            return TakeOwnership(commandBuffers_, MakeUnique<GLDeferredCommandBuffer>(sharedContext->GetStateManager(), statistics_, desc.flags));
+        else
+            throw std::runtime_error("cannot create OpenGL command buffer without active render context or headless mode");
+    }
+    else
+    {
+        /* Get state manager from shared GL context */
+        if (auto sharedContext = GetSharedGLContext())
+            return TakeOwnership(commandBuffers_, MakeUnique<GLCommandBuffer>(sharedContext->GetStateManager(), statistics_, desc.flags));
+        else
+            throw std::runtime_error("cannot create OpenGL command buffer without active render context or headless mode");
+    }
 }
 
 CommandBufferExt* GLRenderSystem::CreateCommandBufferExt()
 {
-    /* Get state manager from shared render context */
-    if (auto sharedContext = GetSharedRenderContext())
-        return TakeOwnership(commandBuffers_, MakeUnique<GLCommandBuffer>(sharedContext->GetStateManager()));
+    /* Get state manager from shared GL context */
+    if (auto sharedContext = GetSharedGLContext())
+        return TakeOwnership(commandBuffers_, MakeUnique<GLCommandBuffer>(sharedContext->GetStateManager(), statistics_, 0));
     else
-        throw std::runtime_error("cannot create OpenGL command buffer without active render context");
+        throw std::runtime_error("cannot create OpenGL command buffer without active render context or headless mode");
+}
+
+CommandBuffer* GLRenderSystem::CreateSecondaryCommandBuffer()
+{
+    /* Secondary command buffers are not supported */
+    return nullptr;
 }
 
 void GLRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -87,15 +176,22 @@ void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
     LLGL_ASSERT_FEATURE_SUPPORT(hasSamplers);
-    auto sampler = MakeUnique<GLSampler>();
-    sampler->SetDesc(desc);
-    return TakeOwnership(samplers_, std::move(sampler));
+    return samplerCache_.GetOrCreate(
+        desc,
+        [&]()
+        {
+            auto sampler = MakeUnique<GLSampler>();
+            sampler->SetDesc(desc);
+            return TakeOwnership(samplers_, std::move(sampler));
+        }
+    );
 }
 
 void GLRenderSystem::Release(Sampler& sampler)
 {
-    auto& samplerGL = LLGL_CAST(GLSampler&, sampler);
-    RemoveFromUniqueSet(samplers_, &sampler);
+    /* Only destroy sampler when it is no longer shared with other identical sampler descriptors */
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
 }
 
 /* ----- Resource Heaps ----- */
@@ -110,6 +206,12 @@ void GLRenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+void GLRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
+    resourceHeapGL.WriteResourceViews(firstDescriptor, numResourceViews, resourceViews);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
@@ -125,6 +227,18 @@ void GLRenderSystem::Release(RenderTarget& renderTarget)
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
+/* ----- Render Passes ----- */
+
+RenderPass* GLRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    return TakeOwnership(renderPasses_, MakeUnique<GLRenderPass>(desc));
+}
+
+void GLRenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
 /* ----- Shader ----- */
 
 Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
@@ -144,18 +258,23 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
         case ShaderType::Compute:
             LLGL_ASSERT_FEATURE_SUPPORT(hasComputeShaders);
             break;
+        case ShaderType::Amplification:
+        case ShaderType::Mesh:
+            LLGL_ASSERT_FEATURE_SUPPORT(hasMeshShaders);
+            break;
         default:
             break;
     }
 
     /* Make and return shader object */
-    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc));
+    /* Defer compilation if the shader program might be restored from the program binary cache */
+    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc, (GetProgramCache() != nullptr)));
 }
 
 ShaderProgram* GLRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
     AssertCreateShaderProgram(desc);
-    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc));
+    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc, GetProgramCache()));
 }
 
 void GLRenderSystem::Release(Shader& shader)
@@ -185,7 +304,7 @@ void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 GraphicsPipeline* GLRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
-    return TakeOwnership(graphicsPipelines_, MakeUnique<GLGraphicsPipeline>(desc, GetRenderingCaps().limits));
+    return TakeOwnership(graphicsPipelines_, MakeUnique<GLGraphicsPipeline>(desc, limits_));
 }
 
 ComputePipeline* GLRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
@@ -203,6 +322,88 @@ void GLRenderSystem::Release(ComputePipeline& computePipeline)
     RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+/* ----- Statistics ----- */
+
+bool GLRenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    statistics = statistics_.Query(reset);
+    #ifdef LLGL_ENABLE_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+bool GLRenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    statistics.heaps.clear();
+
+    MemoryHeapStatistics heap;
+    heap.deviceLocal = true;
+
+    #ifdef GL_NVX_gpu_memory_info
+    if (HasExtension(GLExt::NVX_gpu_memory_info))
+    {
+        /* Query dedicated video memory and currently available video memory (in KB) */
+        GLint dedicatedMemoryKB = 0, totalAvailableMemoryKB = 0, currentAvailableMemoryKB = 0;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &dedicatedMemoryKB);
+        glGetIntegerv(GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &totalAvailableMemoryKB);
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &currentAvailableMemoryKB);
+
+        heap.size   = static_cast<std::uint64_t>(dedicatedMemoryKB) * 1024;
+        heap.budget = static_cast<std::uint64_t>(totalAvailableMemoryKB) * 1024;
+        heap.usage  = static_cast<std::uint64_t>(std::max(0, totalAvailableMemoryKB - currentAvailableMemoryKB)) * 1024;
+
+        statistics.heaps.push_back(heap);
+        return true;
+    }
+    #endif // /GL_NVX_gpu_memory_info
+
+    #ifdef GL_ATI_meminfo
+    if (HasExtension(GLExt::ATI_meminfo))
+    {
+        /* Query free memory (in KB) for texture objects, which is the first of four values */
+        GLint freeMemoryKB[4] = {};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, freeMemoryKB);
+
+        heap.budget = static_cast<std::uint64_t>(freeMemoryKB[0]) * 1024;
+
+        statistics.heaps.push_back(heap);
+        return true;
+    }
+    #endif // /GL_ATI_meminfo
+
+    return false;
+}
+
+bool GLRenderSystem::QueryTimestampCalibration(TimestampCalibration& calibration)
+{
+    #ifdef GL_TIMESTAMP
+    if (HasExtension(GLExt::ARB_timer_query) && HasExtension(GLExt::ARB_sync))
+    {
+        /*
+        GL has no combined query for CPU and GPU time, so the GPU time (in nanoseconds) is sampled right after the CPU time.
+        The deviation between both includes the round-trip of glGetInteger64v, which usually implies a pipeline flush.
+        */
+        const std::uint64_t cpuTimestampBegin = Timer::Tick();
+        GLint64 gpuTimestamp = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTimestamp);
+        const std::uint64_t cpuTimestampEnd = Timer::Tick();
+
+        const std::uint64_t cpuFrequency = Timer::GetTickFrequency();
+
+        calibration.cpuTimestamp    = cpuTimestampBegin;
+        calibration.gpuTimestamp    = static_cast<std::uint64_t>(gpuTimestamp);
+        calibration.gpuFrequency    = 1000000000ull;
+        calibration.maxDeviation    = (cpuTimestampEnd - cpuTimestampBegin) * 1000000000ull / cpuFrequency;
+
+        return true;
+    }
+    #endif // /GL_TIMESTAMP
+
+    return false;
+}
+
 /* ----- Queries ----- */
 
 Query* GLRenderSystem::CreateQuery(const QueryDescriptor& desc)
@@ -215,18 +416,71 @@ void GLRenderSystem::Release(Query& query)
     RemoveFromUniqueSet(queries_, &query);
 }
 
+QueryHeap* GLRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<GLQueryHeap>(desc));
+}
+
+void GLRenderSystem::Release(QueryHeap& queryHeap)
+{
+    RemoveFromUniqueSet(queryHeaps_, &queryHeap);
+}
+
 /* ----- Fences ----- */
 
 Fence* GLRenderSystem::CreateFence()
 {
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
     return TakeOwnership(fences_, MakeUnique<GLFence>());
 }
 
 void GLRenderSystem::Release(Fence& fence)
 {
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Worker threads ----- */
+
+bool GLRenderSystem::AttachWorkerThread()
+{
+    auto sharedContext = GetSharedGLContext();
+    if (!sharedContext)
+        throw std::runtime_error("cannot attach OpenGL worker thread without active render context or headless mode");
+
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+
+    auto& workerContext = workerContexts_[std::this_thread::get_id()];
+    if (!workerContext)
+    {
+        /* Create worker context that shares all objects with the render contexts, and make it current for the calling thread */
+        workerContext = GLContext::CreateWorker(*sharedContext);
+        if (!GLContext::MakeCurrent(workerContext.get()))
+        {
+            workerContext.reset();
+            workerContexts_.erase(std::this_thread::get_id());
+            return false;
+        }
+        workerContext->GetStateManager()->DetermineExtensionsAndLimits();
+    }
+
+    return true;
+}
+
+void GLRenderSystem::DetachWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerContextsMutex_ };
+
+    auto it = workerContexts_.find(std::this_thread::get_id());
+    if (it != workerContexts_.end())
+    {
+        /* Make sure all uploads have been issued before the worker context is destroyed */
+        glFlush();
+        GLContext::MakeCurrent(nullptr);
+        workerContexts_.erase(it);
+    }
+}
+
 
 /*
  * ======= Protected: =======
@@ -255,6 +509,21 @@ RenderContext* GLRenderSystem::AddRenderContext(std::unique_ptr<GLRenderContext>
  * ======= Private: =======
  */
 
+void GLRenderSystem::CreateHeadlessContext(const ProfileOpenGLDescriptor& profile)
+{
+    headlessContext_ = GLContext::CreateHeadless(profile);
+    if (!GLContext::MakeCurrent(headlessContext_.get()))
+        throw std::runtime_error("failed to make headless OpenGL context current");
+
+    /* Load all OpenGL extensions, just like for the first render context */
+    LoadGLExtensions(profile);
+    commandQueue_ = MakeUnique<GLCommandQueue>();
+
+    /* Use uniform clipping space */
+    GLStateManager::active->DetermineExtensionsAndLimits();
+    GLStateManager::active->SetClipControl(GL_UPPER_LEFT, GL_ZERO_TO_ONE);
+}
+
 void GLRenderSystem::LoadGLExtensions(const ProfileOpenGLDescriptor& profileDesc)
 {
     /* Load OpenGL extensions if not already done */
@@ -266,6 +535,12 @@ void GLRenderSystem::LoadGLExtensions(const ProfileOpenGLDescriptor& profileDesc
         auto extensions = QueryExtensions(coreProfile);
         LoadAllExtensions(extensions, coreProfile);
 
+        #ifdef GL_KHR_parallel_shader_compile
+        /* Let the driver decide how many threads are used to compile and link shaders in the background */
+        if (HasExtension(GLExt::KHR_parallel_shader_compile))
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        #endif // /GL_KHR_parallel_shader_compile
+
         /* Query and store all renderer information and capabilities */
         QueryRendererInfo();
         QueryRenderingCaps();
@@ -338,6 +613,15 @@ void GLRenderSystem::QueryRenderingCaps()
     RenderingCapabilities caps;
     GLQueryRenderingCaps(caps);
     SetRenderingCaps(caps);
+    limits_ = caps.limits;
+
+    /* Defer query of the texture format table, which requires one GL query per format */
+    SetDeferredRenderingCaps(
+        [](RenderingCapabilities& caps)
+        {
+            GLQueryTextureFormats(caps.textureFormats);
+        }
+    );
 }
 
 
@@ -11,8 +11,11 @@
 #include "../GLCommon/Texture/GLTexSubImage.h"
 #include "Ext/GLExtensions.h"
 #include "../CheckedCast.h"
+#include "../MipChain.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
+#include <algorithm>
+#include <cmath>
 
 
 namespace LLGL
@@ -29,76 +32,205 @@ static GLint GetGlTextureMinFilter(const TextureDescriptor& textureDesc)
         return GL_LINEAR;
 }
 
-Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+// Allocates the immutable storage of a sparse texture without physical memory (requires GL_ARB_sparse_texture and GL_ARB_texture_storage).
+static void GLTexStorageSparse(GLuint texID, const TextureDescriptor& textureDesc)
 {
-    auto texture = MakeUnique<GLTexture>(textureDesc.type);
+    #if defined GL_ARB_sparse_texture && defined GL_ARB_texture_storage
 
-    /* Bind texture */
-    GLStateManager::active->BindTexture(*texture);
+    if (!HasExtension(GLExt::ARB_sparse_texture) || !HasExtension(GLExt::ARB_texture_storage))
+        throw std::runtime_error("sparse textures are not supported (GL_ARB_sparse_texture)");
 
-    /* Initialize texture parameters for the first time */
-    auto target = GLTypes::Map(textureDesc.type);
+    const auto target           = GLTypes::Map(textureDesc.type);
+    const auto mipLevels        = static_cast<GLsizei>(NumMipLevels(textureDesc));
+    const auto internalFormat   = GLTypes::Map(textureDesc.format);
+    const auto sx               = static_cast<GLsizei>(textureDesc.extent.width);
+    const auto sy               = static_cast<GLsizei>(textureDesc.extent.height);
 
-    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GetGlTextureMinFilter(textureDesc));
-    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    /* Determine depth of the storage (3D extent or number of array layers) */
+    GLsizei sz = 1;
 
-    /* Build texture storage and upload image dataa */
     switch (textureDesc.type)
     {
-        case TextureType::Texture1D:
-            GLTexImage1D(textureDesc, imageDesc);
-            break;
-
         case TextureType::Texture2D:
-            GLTexImage2D(textureDesc, imageDesc);
+        case TextureType::TextureCube:
             break;
 
         case TextureType::Texture3D:
-            LLGL_ASSERT_FEATURE_SUPPORT(has3DTextures);
-            GLTexImage3D(textureDesc, imageDesc);
+            sz = static_cast<GLsizei>(textureDesc.extent.depth);
             break;
 
-        case TextureType::TextureCube:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasCubeTextures);
-            GLTexImageCube(textureDesc, imageDesc);
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            sz = static_cast<GLsizei>(textureDesc.arrayLayers);
             break;
 
-        case TextureType::Texture1DArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
-            GLTexImage1DArray(textureDesc, imageDesc);
+        default:
+            throw std::invalid_argument("failed to create sparse texture with texture type other than 2D, 3D, cube, 2D array, or cube array");
             break;
+    }
 
-        case TextureType::Texture2DArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
-            GLTexImage2DArray(textureDesc, imageDesc);
-            break;
+    const bool is2DStorage = (textureDesc.type == TextureType::Texture2D || textureDesc.type == TextureType::TextureCube);
 
-        case TextureType::TextureCubeArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasCubeArrayTextures);
-            GLTexImageCubeArray(textureDesc, imageDesc);
-            break;
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Use the first virtual page size, which is reported by QuerySparseTileShape */
+        glTextureParameteri(texID, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+        glTextureParameteri(texID, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
 
-        case TextureType::Texture2DMS:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasMultiSampleTextures);
-            GLTexImage2DMS(textureDesc);
-            break;
+        if (is2DStorage)
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, sy);
+        else
+            glTextureStorage3D(texID, mipLevels, internalFormat, sx, sy, sz);
+    }
+    else
+    #endif
+    {
+        /* Use the first virtual page size, which is reported by QuerySparseTileShape */
+        glTexParameteri(target, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+        glTexParameteri(target, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
 
-        case TextureType::Texture2DMSArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasMultiSampleTextures);
-            GLTexImage2DMSArray(textureDesc);
-            break;
+        if (is2DStorage)
+            glTexStorage2D(target, mipLevels, internalFormat, sx, sy);
+        else
+            glTexStorage3D(target, mipLevels, internalFormat, sx, sy, sz);
+    }
 
-        default:
-            throw std::invalid_argument("failed to create texture with invalid texture type");
-            break;
+    #else
+
+    throw std::runtime_error("sparse textures are not supported (GL_ARB_sparse_texture)");
+
+    #endif // /GL_ARB_sparse_texture && GL_ARB_texture_storage
+}
+
+Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+{
+    auto texture = MakeUnique<GLTexture>(textureDesc.type, textureDesc.flags);
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Initialize texture parameters for the first time without binding the texture */
+        glTextureParameteri(texture->GetID(), GL_TEXTURE_MIN_FILTER, GetGlTextureMinFilter(textureDesc));
+        glTextureParameteri(texture->GetID(), GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    else
+    #endif
+    {
+        /* Bind texture */
+        GLStateManager::active->BindTexture(*texture);
+
+        /* Initialize texture parameters for the first time */
+        auto target = GLTypes::Map(textureDesc.type);
+
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GetGlTextureMinFilter(textureDesc));
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     }
 
+    /* Build sparse texture storage, whose memory is committed with 'CommitTextureTiles' */
+    if ((textureDesc.flags & TextureFlags::Sparse) != 0)
+    {
+        if (imageDesc != nullptr)
+            throw std::invalid_argument("cannot create sparse texture with initial image data");
+
+        GLTexStorageSparse(texture->GetID(), textureDesc);
+
+        std::lock_guard<std::mutex> guard { resourcesMutex_ };
+        return TakeOwnership(textures_, std::move(texture));
+    }
+
+    /* Use only the first MIP level of the initial image data to build the texture storage */
+    const SrcImageDescriptor* mipChainDesc = imageDesc;
+    SrcImageDescriptor baseImageDesc;
+
+    if (mipChainDesc != nullptr)
+    {
+        baseImageDesc   = GetMipChainLevel(textureDesc, *mipChainDesc, 0);
+        imageDesc       = (&baseImageDesc);
+    }
+
+    /* Build texture storage and upload image dataa */
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Allocate immutable texture storage without binding the texture */
+        GLTextureStorage(texture->GetID(), textureDesc, imageDesc);
+    }
+    else
+    #endif
+    {
+        switch (textureDesc.type)
+        {
+            case TextureType::Texture1D:
+                GLTexImage1D(textureDesc, imageDesc);
+                break;
+
+            case TextureType::Texture2D:
+                GLTexImage2D(textureDesc, imageDesc);
+                break;
+
+            case TextureType::Texture3D:
+                LLGL_ASSERT_FEATURE_SUPPORT(has3DTextures);
+                GLTexImage3D(textureDesc, imageDesc);
+                break;
+
+            case TextureType::TextureCube:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasCubeTextures);
+                GLTexImageCube(textureDesc, imageDesc);
+                break;
+
+            case TextureType::Texture1DArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
+                GLTexImage1DArray(textureDesc, imageDesc);
+                break;
+
+            case TextureType::Texture2DArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
+                GLTexImage2DArray(textureDesc, imageDesc);
+                break;
+
+            case TextureType::TextureCubeArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasCubeArrayTextures);
+                GLTexImageCubeArray(textureDesc, imageDesc);
+                break;
+
+            case TextureType::Texture2DMS:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasMultiSampleTextures);
+                GLTexImage2DMS(textureDesc);
+                break;
+
+            case TextureType::Texture2DMSArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasMultiSampleTextures);
+                GLTexImage2DMSArray(textureDesc);
+                break;
+
+            default:
+                throw std::invalid_argument("failed to create texture with invalid texture type");
+                break;
+        }
+    }
+
+    /* Upload remaining MIP levels of the initial image data */
+    if (mipChainDesc != nullptr)
+        WriteTextureMipChain(*texture, textureDesc, *mipChainDesc);
+
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
+    return TakeOwnership(textures_, std::move(texture));
+}
+
+Texture* GLRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureGL = LLGL_CAST(GLTexture&, sharedTexture);
+    auto texture = MakeUnique<GLTexture>(sharedTextureGL, textureViewDesc);
+
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
     return TakeOwnership(textures_, std::move(texture));
 }
 
 void GLRenderSystem::Release(Texture& texture)
 {
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    std::lock_guard<std::mutex> guard { resourcesMutex_ };
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -106,55 +238,88 @@ void GLRenderSystem::Release(Texture& texture)
 
 void GLRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc)
 {
-    /* Bind texture and write texture sub data */
+    LLGL_STATISTICS_ADD(bytesUploaded, imageDesc.dataSize);
+
+    /* Submit pending draw commands that might still read the previous texture content */
+    GLStateManager::active->FlushPendingDrawBatch();
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
-    GLStateManager::active->BindTexture(textureGL);
 
-    /* Write data into specific texture type */
-    switch (texture.GetType())
+    /* Stream image data through staging ring buffer, so the GPU reads the data from the buffer offset asynchronously */
+    auto imageDescGL = imageDesc;
+    auto pixelUnpackRing = GetPixelUnpackRing();
+    GLintptr stagingOffset = 0;
+
+    if (pixelUnpackRing != nullptr && pixelUnpackRing->Write(imageDesc.data, imageDesc.dataSize, stagingOffset))
     {
-        case TextureType::Texture1D:
-            GLTexSubImage1D(subTextureDesc, imageDesc);
-            break;
+        GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, pixelUnpackRing->GetID());
+        imageDescGL.data = reinterpret_cast<const void*>(stagingOffset);
+    }
+    else
+        pixelUnpackRing = nullptr;
 
-        case TextureType::Texture2D:
-            GLTexSubImage2D(subTextureDesc, imageDesc);
-            break;
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Write texture sub data without binding the texture */
+        GLTextureSubImage(textureGL.GetID(), texture.GetType(), subTextureDesc, imageDescGL);
+    }
+    else
+    #endif
+    {
+        /* Bind texture and write data into specific texture type */
+        GLStateManager::active->BindTexture(textureGL);
 
-        case TextureType::Texture3D:
-            LLGL_ASSERT_FEATURE_SUPPORT(has3DTextures);
-            GLTexSubImage3D(subTextureDesc, imageDesc);
-            break;
+        switch (texture.GetType())
+        {
+            case TextureType::Texture1D:
+                GLTexSubImage1D(subTextureDesc, imageDescGL);
+                break;
 
-        case TextureType::TextureCube:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasCubeTextures);
-            GLTexSubImageCube(subTextureDesc, imageDesc);
-            break;
+            case TextureType::Texture2D:
+                GLTexSubImage2D(subTextureDesc, imageDescGL);
+                break;
 
-        case TextureType::Texture1DArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
-            GLTexSubImage1DArray(subTextureDesc, imageDesc);
-            break;
+            case TextureType::Texture3D:
+                LLGL_ASSERT_FEATURE_SUPPORT(has3DTextures);
+                GLTexSubImage3D(subTextureDesc, imageDescGL);
+                break;
 
-        case TextureType::Texture2DArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
-            GLTexSubImage2DArray(subTextureDesc, imageDesc);
-            break;
+            case TextureType::TextureCube:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasCubeTextures);
+                GLTexSubImageCube(subTextureDesc, imageDescGL);
+                break;
 
-        case TextureType::TextureCubeArray:
-            LLGL_ASSERT_FEATURE_SUPPORT(hasCubeArrayTextures);
-            GLTexSubImageCubeArray(subTextureDesc, imageDesc);
-            break;
+            case TextureType::Texture1DArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
+                GLTexSubImage1DArray(subTextureDesc, imageDescGL);
+                break;
 
-        default:
-            break;
+            case TextureType::Texture2DArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasArrayTextures);
+                GLTexSubImage2DArray(subTextureDesc, imageDescGL);
+                break;
+
+            case TextureType::TextureCubeArray:
+                LLGL_ASSERT_FEATURE_SUPPORT(hasCubeArrayTextures);
+                GLTexSubImageCubeArray(subTextureDesc, imageDescGL);
+                break;
+
+            default:
+                break;
+        }
     }
+
+    if (pixelUnpackRing != nullptr)
+        GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
 }
 
 void GLRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
 {
     LLGL_ASSERT_PTR(imageDesc.data);
 
+    GLStateManager::active->FlushPendingDrawBatch();
+
     auto& textureGL = LLGL_CAST(const GLTexture&, texture);
 
     /* Read image data from texture */
@@ -185,16 +350,115 @@ void GLRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel,
     }
 }
 
+std::uint32_t GLRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    auto& fenceGL   = LLGL_CAST(GLFence&, fence);
+
+    if (IsMultiSampleTexture(textureGL.GetType()))
+        throw std::invalid_argument("cannot read multi-sampled texture asynchronously");
+
+    /* Determine tightly packed layout of the texel data */
+    ImageFormat imageFormat;
+    DataType    dataType;
+    const auto format       = textureGL.QueryImageFormat(imageFormat, dataType);
+    const auto rowPitch     = region.extent.width * (FormatBitSize(format) / 8);
+    const auto slicePitch   = static_cast<std::uint64_t>(rowPitch) * region.extent.height;
+    const auto size         = slicePitch * region.extent.depth;
+
+    /* Allocate readback and (re-)allocate its pixel pack buffer if it is too small */
+    auto readback = textureReadbacks_.Alloc(size);
+    auto& rb = textureReadbacks_.Get(readback);
+
+    if (rb.staging == 0)
+        glGenBuffers(1, &rb.staging);
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, rb.staging);
+
+    if (rb.capacity < size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        rb.capacity = size;
+    }
+
+    rb.fence        = (&fence);
+    rb.format       = format;
+    rb.extent       = region.extent;
+    rb.rowPitch     = rowPitch;
+    rb.slicePitch   = slicePitch;
+
+    /* Read texel data into the pixel pack buffer, which does not block the CPU since the data remains in GPU memory */
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    textureGL.GetTextureSubImage(region, imageFormat, dataType, static_cast<std::size_t>(slicePitch), nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+
+    /* Submit fence after the read command */
+    fenceGL.Submit();
+
+    return readback;
+}
+
+void GLRenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& rb = textureReadbacks_.Get(readback);
+
+    const auto numTexels = rb.extent.width * rb.extent.height * rb.extent.depth;
+    AssertImageDataSize(imageDesc.dataSize, ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels), "texture readback");
+
+    /* Wait until the texel data has been written into the pixel pack buffer */
+    auto& fenceGL = LLGL_CAST(GLFence&, *rb.fence);
+    fenceGL.Wait(~0ull);
+
+    /* Map pixel pack buffer and copy texel data into the output image */
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, rb.staging);
+
+    if (auto mappedData = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
+    {
+        CopyTextureReadbackData(imageDesc, rb.format, rb.extent, mappedData, rb.rowPitch, rb.slicePitch, GetConfiguration().threadCount);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+
+    /* Return pixel pack buffer to the pool */
+    textureReadbacks_.Free(readback);
+}
+
 void GLRenderSystem::GenerateMips(Texture& texture)
 {
+    GLStateManager::active->FlushPendingDrawBatch();
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
-    GenerateMipsPrimary(textureGL.GetID(), textureGL.GetType());
+    if (auto mipGenerator = GetMipGenerator(textureGL))
+        mipGenerator->GenerateMips(textureGL);
+    else
+        GenerateMipsPrimary(textureGL.GetID(), textureGL.GetType());
 }
 
 void GLRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
     if (numMipLevels > 0 && numArrayLayers > 0)
     {
+        GLStateManager::active->FlushPendingDrawBatch();
+
+        auto& textureGL = LLGL_CAST(GLTexture&, texture);
+        if (auto mipGenerator = GetMipGenerator(textureGL))
+        {
+            /* Generate MIP-maps in single-pass compute shader process */
+            mipGenerator->GenerateMips(
+                textureGL,
+                static_cast<GLuint>(baseMipLevel),
+                static_cast<GLuint>(numMipLevels),
+                static_cast<GLuint>(baseArrayLayer),
+                static_cast<GLuint>(numArrayLayers)
+            );
+            return;
+        }
+
         #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
 
         if (texture.GetType() == TextureType::Texture3D)
@@ -205,7 +469,6 @@ void GLRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
         else
         {
             /* Generate MIP-maps in custom sub generation process */
-            auto& textureGL = LLGL_CAST(GLTexture&, texture);
             auto extent = textureGL.QueryMipExtent(baseMipLevel);
 
             GenerateSubMipsWithFBO(
@@ -224,8 +487,6 @@ void GLRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
         if (HasExtension(GLExt::ARB_texture_view))
         {
             /* Generate MIP-maps in GL_ARB_texture_view extension process */
-            auto& textureGL = LLGL_CAST(GLTexture&, texture);
-
             GenerateSubMipsWithTextureView(
                 textureGL,
                 static_cast<GLuint>(baseMipLevel),
@@ -246,10 +507,178 @@ void GLRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
 }
 
 
+bool GLRenderSystem::QuerySparseTileShape(const Format format, const TextureType type, Extent3D& tileShape)
+{
+    #if defined GL_ARB_sparse_texture && defined GL_ARB_internalformat_query
+
+    if (!GetRenderingCaps().features.hasSparseTextures)
+        return false;
+
+    switch (type)
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture3D:
+        case TextureType::TextureCube:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            break;
+        default:
+            return false;
+    }
+
+    /* Query first virtual page size, which is used for all sparse textures */
+    const auto target           = GLTypes::Map(type);
+    const auto internalFormat   = GLTypes::Map(format);
+
+    GLint numPageSizes = 0;
+    glGetInternalformativ(target, internalFormat, GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &numPageSizes);
+
+    if (numPageSizes <= 0)
+        return false;
+
+    GLint pageSize[3] = { 0, 0, 0 };
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &pageSize[0]);
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &pageSize[1]);
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &pageSize[2]);
+
+    if (pageSize[0] <= 0 || pageSize[1] <= 0 || pageSize[2] <= 0)
+        return false;
+
+    tileShape.width     = static_cast<std::uint32_t>(pageSize[0]);
+    tileShape.height    = static_cast<std::uint32_t>(pageSize[1]);
+    tileShape.depth     = static_cast<std::uint32_t>(pageSize[2]);
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_sparse_texture && GL_ARB_internalformat_query
+}
+
+void GLRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& region, bool commit)
+{
+    #ifdef GL_ARB_sparse_texture
+
+    if (!HasExtension(GLExt::ARB_sparse_texture))
+        throw std::runtime_error("sparse textures are not supported (GL_ARB_sparse_texture)");
+
+    /* Submit pending draw commands that might still read from the decommitted tiles */
+    GLStateManager::active->FlushPendingDrawBatch();
+
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    GLStateManager::active->BindTexture(textureGL);
+
+    /* Array layers and cube faces are specified by the Z-offset like for 'glTexSubImage3D' */
+    glTexPageCommitmentARB(
+        GLTypes::Map(texture.GetType()),
+        static_cast<GLint>(region.mipLevel),
+        region.offset.x,
+        region.offset.y,
+        region.offset.z,
+        static_cast<GLsizei>(region.extent.width),
+        static_cast<GLsizei>(region.extent.height),
+        static_cast<GLsizei>(region.extent.depth),
+        (commit ? GL_TRUE : GL_FALSE)
+    );
+
+    #else
+
+    throw std::runtime_error("sparse textures are not supported (GL_ARB_sparse_texture)");
+
+    #endif // /GL_ARB_sparse_texture
+}
+
+void GLRenderSystem::SetTextureMinLOD(Texture& texture, float minLOD)
+{
+    /* Submit pending draw commands that must still sample the previous MIP-map range */
+    GLStateManager::active->FlushPendingDrawBatch();
+
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    GLStateManager::active->BindTexture(textureGL);
+
+    /*
+    The minimum LOD of sampler objects overrides the one of the texture object,
+    so the level of detail is clamped with the base level, which is rounded up to keep non-resident MIP-map levels out of range
+    */
+    const auto baseLevel = static_cast<GLint>(std::ceil(std::max(0.0f, minLOD)));
+    glTexParameteri(GLTypes::Map(texture.GetType()), GL_TEXTURE_BASE_LEVEL, baseLevel);
+}
+
+
 /*
  * ======= Private: =======
  */
 
+GLMipGenerator* GLRenderSystem::GetMipGenerator(const GLTexture& textureGL)
+{
+    if (!GetConfiguration().singlePassMipGeneration)
+        return nullptr;
+
+    if (!HasExtension(GLExt::ARB_compute_shader) || !HasExtension(GLExt::ARB_shader_image_load_store) || !HasExtension(GLExt::ARB_shader_storage_buffer_object))
+        return nullptr;
+
+    if (!GLMipGenerator::IsTextureSupported(textureGL))
+        return nullptr;
+
+    if (!mipGenerator_)
+        mipGenerator_ = MakeUnique<GLMipGenerator>();
+
+    return mipGenerator_.get();
+}
+
+GLPixelUnpackRing* GLRenderSystem::GetPixelUnpackRing()
+{
+    if (GetConfiguration().textureStagingBufferSize == 0)
+        return nullptr;
+
+    if (!HasExtension(GLExt::ARB_buffer_storage))
+        return nullptr;
+
+    /* Worker threads upload directly, since the ring buffer is not synchronized between threads */
+    if (IsWorkerThread())
+        return nullptr;
+
+    if (!pixelUnpackRing_)
+        pixelUnpackRing_ = MakeUnique<GLPixelUnpackRing>(GetConfiguration().textureStagingBufferSize);
+
+    return pixelUnpackRing_.get();
+}
+
+void GLRenderSystem::WriteTextureMipChain(GLTexture& textureGL, const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc)
+{
+    const auto numMipLevels = NumMipChainLevels(textureDesc, imageDesc);
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        auto mipImageDesc = GetMipChainLevel(textureDesc, imageDesc, mipLevel);
+
+        SubTextureDescriptor subTextureDesc;
+        {
+            subTextureDesc.mipLevel = mipLevel;
+            subTextureDesc.extent   = GetMipExtent(textureDesc, mipLevel);
+        }
+
+        if (textureDesc.type == TextureType::TextureCube)
+        {
+            /* Write each cube face individually */
+            const auto numFaces = subTextureDesc.extent.depth;
+            mipImageDesc.dataSize /= numFaces;
+            subTextureDesc.extent.depth = 1;
+
+            for (std::uint32_t face = 0; face < numFaces; ++face)
+            {
+                subTextureDesc.offset.z = static_cast<std::int32_t>(face);
+                WriteTexture(textureGL, subTextureDesc, mipImageDesc);
+                mipImageDesc.data = (reinterpret_cast<const char*>(mipImageDesc.data) + mipImageDesc.dataSize);
+            }
+        }
+        else
+            WriteTexture(textureGL, subTextureDesc, mipImageDesc);
+    }
+}
+
 void GLRenderSystem::GenerateMipsPrimary(GLuint texID, const TextureType texType)
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
@@ -10,6 +10,7 @@
 #include "../GLCommon/GLExtensionRegistry.h"
 #include "../GLCommon/GLTypes.h"
 #include "../../Core/Helper.h"
+#include <LLGL/ShaderFlags.h>
 #include <cstdint>
 #include <limits>
 
@@ -79,7 +80,7 @@ static std::vector<ShadingLanguage> GLQueryShadingLanguages()
 
     #if defined GL_ARB_gl_spirv && defined GL_ARB_ES2_compatibility
 
-    if (HasExtension(GLExt::ARB_gl_spirv) && HasExtension(GLExt::ARB_ES2_compatibility))
+    if (IsExtensionSupported(GLExt::ARB_gl_spirv) && IsExtensionSupported(GLExt::ARB_ES2_compatibility))
     {
         /* Query supported shader binary formats */
         GLint numBinaryFormats = 0;
@@ -156,6 +157,9 @@ static std::vector<Format> GetDefaultSupportedGLTextureFormats()
         Format::RGBA32UInt,
         Format::RGBA32SInt,
         Format::RGBA32Float,
+        Format::RGB10A2UNorm,
+        Format::RGB10A2UInt,
+        Format::RG11B10Float,
         Format::D16UNorm,
         Format::D32Float,
         Format::D24UNormS8UInt,
@@ -171,6 +175,13 @@ static void GLGetRenderingAttribs(RenderingCapabilities& caps)
     caps.shadingLanguages   = GLQueryShadingLanguages();
 }
 
+// Appends all formats from 'first' to 'last' (inclusive) to the list of supported texture formats.
+static void GLAppendTextureFormatRange(std::vector<Format>& textureFormats, const Format first, const Format last)
+{
+    for (auto i = static_cast<int>(first); i <= static_cast<int>(last); ++i)
+        textureFormats.push_back(static_cast<Format>(i));
+}
+
 static void GLGetSupportedTextureFormats(std::vector<Format>& textureFormats)
 {
     textureFormats = GetDefaultSupportedGLTextureFormats();
@@ -196,34 +207,36 @@ static void GLGetSupportedTextureFormats(std::vector<Format>& textureFormats)
 
     #endif
 
+    /* Add compressed formats by their respective extension, since GL_COMPRESSED_TEXTURE_FORMATS is not required to enumerate all of them */
     #ifdef GL_EXT_texture_compression_s3tc
+    if (HasExtension(GLExt::EXT_texture_compression_s3tc))
+    {
+        GLAppendTextureFormatRange(textureFormats, Format::BC1RGB, Format::BC3RGBA);
+        #ifdef GL_EXT_texture_sRGB
+        if (HasExtension(GLExt::EXT_texture_sRGB))
+            GLAppendTextureFormatRange(textureFormats, Format::BC1RGBAsRGB, Format::BC3RGBAsRGB);
+        #endif
+    }
+    #endif
 
-    const auto numCompressedTexFormats = GLGetUInt(GL_NUM_COMPRESSED_TEXTURE_FORMATS);
+    #ifdef GL_ARB_texture_compression_rgtc
+    if (HasExtension(GLExt::ARB_texture_compression_rgtc))
+        GLAppendTextureFormatRange(textureFormats, Format::BC4RUNorm, Format::BC5RGSNorm);
+    #endif
 
-    std::vector<GLint> compressedTexFormats(numCompressedTexFormats);
-    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, compressedTexFormats.data());
+    #ifdef GL_ARB_texture_compression_bptc
+    if (HasExtension(GLExt::ARB_texture_compression_bptc))
+        GLAppendTextureFormatRange(textureFormats, Format::BC6HRGBUFloat, Format::BC7RGBAsRGB);
+    #endif
 
-    for (GLint format : compressedTexFormats)
-    {
-        switch (format)
-        {
-            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
-                textureFormats.push_back(Format::BC1RGB);
-                break;
-            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
-                textureFormats.push_back(Format::BC1RGBA);
-                break;
-            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
-                textureFormats.push_back(Format::BC2RGBA);
-                break;
-            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
-                textureFormats.push_back(Format::BC3RGBA);
-                break;
-            default:
-                break;
-        }
-    }
+    #ifdef GL_ARB_ES3_compatibility
+    if (HasExtension(GLExt::ARB_ES3_compatibility))
+        GLAppendTextureFormatRange(textureFormats, Format::ETC2RGB8UNorm, Format::EACRG11SNorm);
+    #endif
 
+    #ifdef GL_KHR_texture_compression_astc_ldr
+    if (HasExtension(GLExt::KHR_texture_compression_astc_ldr))
+        GLAppendTextureFormatRange(textureFormats, Format::ASTC4x4UNorm, Format::ASTC12x12sRGB);
     #endif
 }
 
@@ -231,27 +244,97 @@ static void GLGetSupportedFeatures(RenderingFeatures& features)
 {
     /* Query all boolean capabilies by their respective OpenGL extension */
     features.hasCommandBufferExt            = true;
-    features.hasRenderTargets               = HasExtension(GLExt::ARB_framebuffer_object);
-    features.has3DTextures                  = HasExtension(GLExt::EXT_texture3D);
-    features.hasCubeTextures                = HasExtension(GLExt::ARB_texture_cube_map);
-    features.hasArrayTextures               = HasExtension(GLExt::EXT_texture_array);
-    features.hasCubeArrayTextures           = HasExtension(GLExt::ARB_texture_cube_map_array);
-    features.hasMultiSampleTextures         = HasExtension(GLExt::ARB_texture_multisample);
-    features.hasSamplers                    = HasExtension(GLExt::ARB_sampler_objects);
-    features.hasConstantBuffers             = HasExtension(GLExt::ARB_uniform_buffer_object);
-    features.hasStorageBuffers              = HasExtension(GLExt::ARB_shader_storage_buffer_object);
-    features.hasUniforms                    = HasExtension(GLExt::ARB_shader_objects);
-    features.hasGeometryShaders             = HasExtension(GLExt::ARB_geometry_shader4);
-    features.hasTessellationShaders         = HasExtension(GLExt::ARB_tessellation_shader);
-    features.hasComputeShaders              = HasExtension(GLExt::ARB_compute_shader);
-    features.hasInstancing                  = HasExtension(GLExt::ARB_draw_instanced);
-    features.hasOffsetInstancing            = HasExtension(GLExt::ARB_base_instance);
-    features.hasViewportArrays              = HasExtension(GLExt::ARB_viewport_array);
-    features.hasConservativeRasterization   = ( HasExtension(GLExt::NV_conservative_raster) || HasExtension(GLExt::INTEL_conservative_rasterization) );
-    features.hasStreamOutputs               = ( HasExtension(GLExt::EXT_transform_feedback) || HasExtension(GLExt::NV_transform_feedback) );
+    features.hasRenderTargets               = IsExtensionSupported(GLExt::ARB_framebuffer_object);
+    features.has3DTextures                  = IsExtensionSupported(GLExt::EXT_texture3D);
+    features.hasCubeTextures                = IsExtensionSupported(GLExt::ARB_texture_cube_map);
+    features.hasArrayTextures               = IsExtensionSupported(GLExt::EXT_texture_array);
+    features.hasCubeArrayTextures           = IsExtensionSupported(GLExt::ARB_texture_cube_map_array);
+    features.hasMultiSampleTextures         = IsExtensionSupported(GLExt::ARB_texture_multisample);
+    features.hasTextureCompressionBC        = ( IsExtensionSupported(GLExt::EXT_texture_compression_s3tc) && IsExtensionSupported(GLExt::ARB_texture_compression_rgtc) && IsExtensionSupported(GLExt::ARB_texture_compression_bptc) );
+    features.hasTextureCompressionETC2      = IsExtensionSupported(GLExt::ARB_ES3_compatibility);
+    features.hasTextureCompressionASTC      = IsExtensionSupported(GLExt::KHR_texture_compression_astc_ldr);
+    features.hasSamplers                    = IsExtensionSupported(GLExt::ARB_sampler_objects);
+    features.hasConstantBuffers             = IsExtensionSupported(GLExt::ARB_uniform_buffer_object);
+    features.hasStorageBuffers              = IsExtensionSupported(GLExt::ARB_shader_storage_buffer_object);
+    features.hasUniforms                    = IsExtensionSupported(GLExt::ARB_shader_objects);
+    features.hasGeometryShaders             = IsExtensionSupported(GLExt::ARB_geometry_shader4);
+    features.hasTessellationShaders         = IsExtensionSupported(GLExt::ARB_tessellation_shader);
+    features.hasComputeShaders              = IsExtensionSupported(GLExt::ARB_compute_shader);
+    features.hasInstancing                  = IsExtensionSupported(GLExt::ARB_draw_instanced);
+    features.hasOffsetInstancing            = IsExtensionSupported(GLExt::ARB_base_instance);
+    features.hasIndirectDrawing             = IsExtensionSupported(GLExt::ARB_draw_indirect);
+    features.hasViewportArrays              = IsExtensionSupported(GLExt::ARB_viewport_array);
+    features.hasConservativeRasterization   = ( IsExtensionSupported(GLExt::NV_conservative_raster) || IsExtensionSupported(GLExt::INTEL_conservative_rasterization) );
+    features.hasStreamOutputs               = ( IsExtensionSupported(GLExt::EXT_transform_feedback) || IsExtensionSupported(GLExt::NV_transform_feedback) );
     features.hasLogicOp                     = true;
+    features.hasBindlessResources           = IsExtensionSupported(GLExt::ARB_bindless_texture);
+    features.hasDynamicOffsets              = IsExtensionSupported(GLExt::ARB_uniform_buffer_object);
+    features.hasSparseTextures              = ( IsExtensionSupported(GLExt::ARB_sparse_texture) && IsExtensionSupported(GLExt::ARB_texture_storage) && IsExtensionSupported(GLExt::ARB_internalformat_query) );
+    features.hasTextureViews                = ( IsExtensionSupported(GLExt::ARB_texture_view) && IsExtensionSupported(GLExt::ARB_texture_storage) );
+    features.hasTextureMinLOD               = true;
+    features.hasTimelineFences              = IsExtensionSupported(GLExt::ARB_sync);
+    features.hasMultiView                   = ( IsExtensionSupported(GLExt::OVR_multiview) && IsExtensionSupported(GLExt::OVR_multiview2) );
+
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    /* Per-draw shading rates are emulated with the palette of GL_NV_shading_rate_image */
+    features.hasVariableRateShading         = IsExtensionSupported(GLExt::NV_shading_rate_image);
+    features.hasAdditionalShadingRates      = IsExtensionSupported(GLExt::NV_shading_rate_image);
+    features.hasShadingRateImage            = IsExtensionSupported(GLExt::NV_shading_rate_image);
+    features.hasDepthBoundsTest             = IsExtensionSupported(GLExt::EXT_depth_bounds_test);
+    features.hasMeshShaders                 = IsExtensionSupported(GLExt::NV_mesh_shader);
+    #endif
+
+    #ifdef GL_KHR_shader_subgroup
+    features.hasSubgroups                   = IsExtensionSupported(GLExt::KHR_shader_subgroup);
+    #endif
+}
+
+#ifdef GL_KHR_shader_subgroup
+
+static void GLGetSubgroupLimits(RenderingLimits& limits)
+{
+    limits.minSubgroupSize = GLGetUInt(GL_SUBGROUP_SIZE_KHR);
+    limits.maxSubgroupSize = limits.minSubgroupSize;
+
+    /* Map supported shader stages */
+    const auto stages = GLGetUInt(GL_SUBGROUP_SUPPORTED_STAGES_KHR);
+
+    if ((stages & GL_VERTEX_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::VertexStage;
+    if ((stages & GL_TESS_CONTROL_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::TessControlStage;
+    if ((stages & GL_TESS_EVALUATION_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::TessEvaluationStage;
+    if ((stages & GL_GEOMETRY_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::GeometryStage;
+    if ((stages & GL_FRAGMENT_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::FragmentStage;
+    if ((stages & GL_COMPUTE_SHADER_BIT) != 0)
+        limits.subgroupStageFlags |= StageFlags::ComputeStage;
+
+    /* Map supported subgroup operations */
+    const auto features = GLGetUInt(GL_SUBGROUP_SUPPORTED_FEATURES_KHR);
+
+    if ((features & GL_SUBGROUP_FEATURE_BASIC_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Basic;
+    if ((features & GL_SUBGROUP_FEATURE_VOTE_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Vote;
+    if ((features & GL_SUBGROUP_FEATURE_ARITHMETIC_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Arithmetic;
+    if ((features & GL_SUBGROUP_FEATURE_BALLOT_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Ballot;
+    if ((features & GL_SUBGROUP_FEATURE_SHUFFLE_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Shuffle;
+    if ((features & GL_SUBGROUP_FEATURE_SHUFFLE_RELATIVE_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::ShuffleRelative;
+    if ((features & GL_SUBGROUP_FEATURE_CLUSTERED_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Clustered;
+    if ((features & GL_SUBGROUP_FEATURE_QUAD_BIT_KHR) != 0)
+        limits.subgroupOperations |= SubgroupFlags::Quad;
 }
 
+#endif // /GL_KHR_shader_subgroup
+
 static void GLGetFeatureLimits(RenderingLimits& limits)
 {
     /* Determine minimal line width range for both aliased and smooth lines */
@@ -289,6 +372,39 @@ static void GLGetFeatureLimits(RenderingLimits& limits)
     /* Set maximum buffer size to maximum value for <GLsizei> (used in 'glBufferData') */
     limits.maxBufferSize          = static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max());
     limits.maxConstantBufferSize  = static_cast<std::uint64_t>(GLGetUInt(GL_MAX_UNIFORM_BLOCK_SIZE));
+
+    /* Constants are emulated with a hidden uniform buffer, so use the same minimum as for Vulkan push constants */
+    limits.maxConstantsSize       = 128u;
+
+    if (HasExtension(GLExt::ARB_uniform_buffer_object))
+        limits.constantBufferOffsetAlignment = GLGetUInt(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (HasExtension(GLExt::NV_shading_rate_image))
+        limits.shadingRateImageTileSize = GLGetUInt(GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV);
+    #endif
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+    if (HasExtension(GLExt::NV_mesh_shader))
+    {
+        /* GL_NV_mesh_shader only supports one-dimensional mesh tasks */
+        limits.maxMeshTaskWorkGroups[0] = GLGetUInt(GL_MAX_DRAW_MESH_TASKS_COUNT_NV);
+        limits.maxMeshTaskWorkGroups[1] = 1;
+        limits.maxMeshTaskWorkGroups[2] = 1;
+        limits.maxMeshOutputVertices    = GLGetUInt(GL_MAX_MESH_OUTPUT_VERTICES_NV);
+        limits.maxMeshOutputPrimitives  = GLGetUInt(GL_MAX_MESH_OUTPUT_PRIMITIVES_NV);
+    }
+    #endif
+
+    #ifdef GL_OVR_multiview
+    if (HasExtension(GLExt::OVR_multiview) && HasExtension(GLExt::OVR_multiview2))
+        limits.maxNumViews = GLGetUInt(GL_MAX_VIEWS_OVR);
+    #endif
+
+    #ifdef GL_KHR_shader_subgroup
+    if (HasExtension(GLExt::KHR_shader_subgroup))
+        GLGetSubgroupLimits(limits);
+    #endif
 }
 
 static void GLGetTextureLimits(const RenderingFeatures& features, RenderingLimits& limits)
@@ -359,12 +475,16 @@ static void GLGetTextureLimits(const RenderingFeatures& features, RenderingLimit
 void GLQueryRenderingCaps(RenderingCapabilities& caps)
 {
     GLGetRenderingAttribs(caps);
-    GLGetSupportedTextureFormats(caps.textureFormats);
     GLGetSupportedFeatures(caps.features);
     GLGetFeatureLimits(caps.limits);
     GLGetTextureLimits(caps.features, caps.limits);
 }
 
+void GLQueryTextureFormats(std::vector<Format>& textureFormats)
+{
+    GLGetSupportedTextureFormats(textureFormats);
+}
+
 
 } // /namespace LLGL
 
@@ -16,9 +16,12 @@ namespace LLGL
 {
 
 
-// Queries all OpenGL rendering capacilities.
+// Queries all OpenGL rendering capacilities except the supported texture formats.
 void GLQueryRenderingCaps(RenderingCapabilities& caps);
 
+// Queries the supported texture formats. This is deferred until the capabilities are accessed, since each format is queried individually.
+void GLQueryTextureFormats(std::vector<Format>& textureFormats);
+
 
 } // /namespace LLGL
 
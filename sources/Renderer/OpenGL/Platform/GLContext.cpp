@@ -12,7 +12,8 @@ namespace LLGL
 {
 
 
-static GLContext* g_activeGLContext = nullptr;
+// Active GL context of each thread, since a GL context is always current for the calling thread only.
+static thread_local GLContext* g_activeGLContext = nullptr;
 
 GLContext::GLContext(GLContext* sharedContext)
 {
@@ -27,6 +28,12 @@ GLContext::~GLContext()
     // dummy
 }
 
+bool GLContext::QueryFrameStatistics(FrameStatistics& frameStats)
+{
+    /* Frame statistics are not supported by default */
+    return false;
+}
+
 bool GLContext::MakeCurrent(GLContext* context)
 {
     bool result = true;
@@ -30,10 +30,23 @@ class GLContext
         // Creates a platform specific GLContext instance.
         static std::unique_ptr<GLContext> Create(const RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext);
 
+        /*
+        Creates a platform specific GLContext instance for a worker thread, which shares all GL objects with the specified context.
+        In contrast to shared render contexts, a worker context always has its own hardware context and its own state manager.
+        The new context is not made current.
+        */
+        static std::unique_ptr<GLContext> CreateWorker(GLContext& sharedContext);
+
+        /*
+        Creates a platform specific GLContext instance without any window or display server (Linux: surfaceless EGL context).
+        Throws an exception if headless GL contexts are not supported on this platform. The new context is not made current.
+        */
+        static std::unique_ptr<GLContext> CreateHeadless(const ProfileOpenGLDescriptor& profile);
+
         // Makes the specified GLContext current. If null, the current context will be deactivated.
         static bool MakeCurrent(GLContext* context);
 
-        // Returns the active GLContext instance.
+        // Returns the active GLContext instance of the calling thread.
         static GLContext* Active();
 
         // Sets the swap interval for vsync (Win32: wglSwapIntervalEXT, X11: glXSwapIntervalSGI).
@@ -45,6 +58,9 @@ class GLContext
         // Resizes the GL context. This is called after the context surface has been resized.
         virtual void Resize(const Extent2D& resolution) = 0;
 
+        // Queries the swap and vertical refresh counters of the context surface (X11: GLX_OML_sync_control). Returns false if not supported.
+        virtual bool QueryFrameStatistics(FrameStatistics& frameStats);
+
         inline const std::shared_ptr<GLStateManager>& GetStateManager() const
         {
             return stateMngr_;
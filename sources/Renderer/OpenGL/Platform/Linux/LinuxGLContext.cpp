@@ -6,12 +6,14 @@
  */
 
 #include "LinuxGLContext.h"
+#include "LinuxGLHeadlessContext.h"
 #include "../../Ext/GLExtensions.h"
 #include "../../Ext/GLExtensionLoader.h"
 #include "../../../CheckedCast.h"
 #include "../../../../Core/Helper.h"
 #include <LLGL/Log.h>
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -39,6 +41,24 @@ std::unique_ptr<GLContext> GLContext::Create(const RenderContextDescriptor& desc
     return MakeUnique<LinuxGLContext>(desc, surface, sharedContextGLX);
 }
 
+std::unique_ptr<GLContext> GLContext::CreateWorker(GLContext& sharedContext)
+{
+    #ifdef LLGL_GL_ENABLE_EGL
+    if (auto sharedContextEGL = dynamic_cast<LinuxGLHeadlessContext*>(&sharedContext))
+        return MakeUnique<LinuxGLHeadlessContext>(*sharedContextEGL);
+    #endif // /LLGL_GL_ENABLE_EGL
+    return MakeUnique<LinuxGLContext>(LLGL_CAST(LinuxGLContext&, sharedContext));
+}
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(const ProfileOpenGLDescriptor& profile)
+{
+    #ifdef LLGL_GL_ENABLE_EGL
+    return MakeUnique<LinuxGLHeadlessContext>(profile);
+    #else
+    throw std::runtime_error("headless OpenGL contexts on Linux require a surfaceless EGL context (LLGL_GL_ENABLE_EGL)");
+    #endif // /LLGL_GL_ENABLE_EGL
+}
+
 
 /*
  * LinuxGLContext class
@@ -52,6 +72,19 @@ LinuxGLContext::LinuxGLContext(const RenderContextDescriptor& desc, Surface& sur
     CreateContext(desc, nativeHandle, sharedContext);
 }
 
+LinuxGLContext::LinuxGLContext(LinuxGLContext& sharedContext) :
+    GLContext { nullptr                 },
+    display_  { sharedContext.display_  },
+    wnd_      { sharedContext.wnd_      },
+    visual_   { sharedContext.visual_   },
+    profile_  { sharedContext.profile_  }
+{
+    /* Create worker context with the same profile as the shared context, but don't make it current yet */
+    CreateGLXContext(sharedContext.glc_);
+    if (!glc_)
+        throw std::runtime_error("failed to create OpenGL worker context on X11 client");
+}
+
 LinuxGLContext::~LinuxGLContext()
 {
     DeleteContext();
@@ -77,6 +110,48 @@ void LinuxGLContext::Resize(const Extent2D& resolution)
     //TODO...
 }
 
+// Returns true if the specified extension is in the space separated list of GLX extensions of the display.
+static bool HasGLXExtension(::Display* display, int screen, const char* name)
+{
+    const char* extensions = glXQueryExtensionsString(display, screen);
+    if (extensions == nullptr)
+        return false;
+
+    const auto nameLen = std::strlen(name);
+    for (const char* s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+    {
+        if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+bool LinuxGLContext::QueryFrameStatistics(FrameStatistics& frameStats)
+{
+    /* Load GLX extension "glXGetSyncValuesOML" once to query the swap buffer count (SBC) and media stream count (MSC) */
+    if (!syncControlLoaded_)
+    {
+        if (HasGLXExtension(display_, visual_->screen, "GLX_OML_sync_control"))
+            glXGetSyncValuesOML_ = reinterpret_cast<GLXGetSyncValuesOMLProc>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXGetSyncValuesOML")));
+        syncControlLoaded_ = true;
+    }
+
+    if (glXGetSyncValuesOML_ == nullptr)
+        return false;
+
+    std::int64_t ust = 0, msc = 0, sbc = 0;
+    if (!glXGetSyncValuesOML_(display_, wnd_, &ust, &msc, &sbc))
+        return false;
+
+    /* The unadjusted system time (UST) of the most recent vertical blank is in microseconds */
+    frameStats.presentID        = static_cast<std::uint64_t>(sbc);
+    frameStats.syncRefreshCount = static_cast<std::uint64_t>(msc);
+    frameStats.syncTime         = static_cast<std::uint64_t>(ust) * 1000;
+
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -87,7 +162,7 @@ bool LinuxGLContext::Activate(bool activate)
     if (activate)
         return glXMakeCurrent(display_, wnd_, glc_);
     else
-        return glXMakeCurrent(nullptr, 0, 0);
+        return glXMakeCurrent(display_, None, nullptr);
 }
 
 void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, const NativeHandle& nativeHandle, LinuxGLContext* sharedContext)
@@ -103,12 +178,20 @@ void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, c
         throw std::invalid_argument("failed to create OpenGL context on X11 client, due to missing arguments");
 
     /* Create OpenGL context with X11 lib */
-    const auto& profileDesc = contextDesc.profileOpenGL;
+    profile_ = contextDesc.profileOpenGL;
+    CreateGLXContext(glcShared);
 
-    if (profileDesc.contextProfile == OpenGLContextProfile::CoreProfile)
+    /* Make new OpenGL context current */
+    if (glXMakeCurrent(display_, wnd_, glc_) != True)
+        Log::StdErr() << "failed to make OpenGL render context current (glXMakeCurrent)" << std::endl;
+}
+
+void LinuxGLContext::CreateGLXContext(GLXContext glcShared)
+{
+    if (profile_.contextProfile == OpenGLContextProfile::CoreProfile)
     {
         /* Create core profile */
-        glc_ = CreateContextCoreProfile(glcShared, profileDesc.majorVersion, profileDesc.minorVersion);
+        glc_ = CreateContextCoreProfile(glcShared, profile_.majorVersion, profile_.minorVersion);
     }
 
     if (!glc_)
@@ -116,10 +199,6 @@ void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, c
         /* Create compatibility profile */
         glc_ = CreateContextCompatibilityProfile(glcShared);
     }
-
-    /* Make new OpenGL context current */
-    if (glXMakeCurrent(display_, wnd_, glc_) != True)
-        Log::StdErr() << "failed to make OpenGL render context current (glXMakeCurrent)" << std::endl;
 }
 
 void LinuxGLContext::DeleteContext()
@@ -181,7 +260,7 @@ GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int ma
                 None
             };
 
-            auto glc = glXCreateContextAttribsARB(display_, fbcList[0], nullptr, True, contextAttribs);
+            auto glc = glXCreateContextAttribsARB(display_, fbcList[0], glcShared, True, contextAttribs);
 
             XFree(fbcList);
 
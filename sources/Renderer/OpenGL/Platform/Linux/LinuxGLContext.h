@@ -27,15 +27,20 @@ class LinuxGLContext : public GLContext
         LinuxGLContext(const RenderContextDescriptor& desc, Surface& surface, LinuxGLContext* sharedContext);
         ~LinuxGLContext();
 
+        // Creates a worker context that shares all GL objects with the specified context and activates it for the same window.
+        LinuxGLContext(LinuxGLContext& sharedContext);
+
         bool SetSwapInterval(int interval) override;
         bool SwapBuffers() override;
         void Resize(const Extent2D& resolution) override;
+        bool QueryFrameStatistics(FrameStatistics& frameStats) override;
 
     private:
 
         bool Activate(bool activate) override;
 
         void CreateContext(const RenderContextDescriptor& contextDesc, const NativeHandle& nativeHandle, LinuxGLContext* sharedContext);
+        void CreateGLXContext(GLXContext glcShared);
         void DeleteContext();
 
         GLXContext CreateContextCoreProfile(GLXContext glcShared, int major, int minor);
@@ -46,6 +51,14 @@ class LinuxGLContext : public GLContext
         XVisualInfo*    visual_     = nullptr;
         GLXContext      glc_        = nullptr;
 
+        // Procedure of the GLX extension "glXGetSyncValuesOML" (GLX_OML_sync_control).
+        using GLXGetSyncValuesOMLProc = Bool (*)(::Display*, GLXDrawable, std::int64_t*, std::int64_t*, std::int64_t*);
+
+        bool                    syncControlLoaded_      = false;
+        GLXGetSyncValuesOMLProc glXGetSyncValuesOML_    = nullptr;  // Null if GLX_OML_sync_control is not supported
+
+        ProfileOpenGLDescriptor profile_;
+
 };
 
 
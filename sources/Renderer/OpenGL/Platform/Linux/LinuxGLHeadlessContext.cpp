@@ -0,0 +1,213 @@
+/*
+ * LinuxGLHeadlessContext.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+#include "LinuxGLHeadlessContext.h"
+#include <EGL/eglext.h>
+#include <LLGL/Log.h>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#ifndef EGL_CONTEXT_MAJOR_VERSION_KHR
+#define EGL_CONTEXT_MAJOR_VERSION_KHR 0x3098
+#endif
+
+#ifndef EGL_CONTEXT_MINOR_VERSION_KHR
+#define EGL_CONTEXT_MINOR_VERSION_KHR 0x30FB
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR 0x30FD
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR
+#define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR 0x00000001
+#endif
+
+typedef EGLDisplay (*EGLGETPLATFORMDISPLAYEXTPROC)(EGLenum, void*, const EGLint*);
+
+// Returns true if the specified space separated EGL extension string contains the specified extension name.
+static bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (extensions == nullptr)
+        return false;
+
+    const auto nameLen = std::strlen(name);
+
+    for (auto s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+    {
+        if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+LinuxGLHeadlessContext::LinuxGLHeadlessContext(const ProfileOpenGLDescriptor& profile) :
+    GLContext    { nullptr },
+    ownsDisplay_ { true    },
+    profile_     { profile }
+{
+    CreateDisplay();
+    CreateEGLContext(EGL_NO_CONTEXT);
+}
+
+LinuxGLHeadlessContext::LinuxGLHeadlessContext(LinuxGLHeadlessContext& sharedContext) :
+    GLContext { nullptr                 },
+    display_  { sharedContext.display_  },
+    config_   { sharedContext.config_   },
+    profile_  { sharedContext.profile_  }
+{
+    /* Create worker context with the same profile as the shared context, but don't make it current yet */
+    CreateEGLContext(sharedContext.context_);
+}
+
+LinuxGLHeadlessContext::~LinuxGLHeadlessContext()
+{
+    if (context_ != EGL_NO_CONTEXT)
+        eglDestroyContext(display_, context_);
+    if (ownsDisplay_)
+        eglTerminate(display_);
+}
+
+bool LinuxGLHeadlessContext::SetSwapInterval(int interval)
+{
+    /* Headless contexts have no swap chain */
+    return false;
+}
+
+bool LinuxGLHeadlessContext::SwapBuffers()
+{
+    /* Headless contexts have no back buffer to present */
+    return false;
+}
+
+void LinuxGLHeadlessContext::Resize(const Extent2D& resolution)
+{
+    // dummy
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxGLHeadlessContext::Activate(bool activate)
+{
+    if (activate)
+        return (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_) == EGL_TRUE);
+    else
+        return (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE);
+}
+
+void LinuxGLHeadlessContext::CreateDisplay()
+{
+    /* Prefer the surfaceless platform, which does not connect to any display server */
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        auto eglGetPlatformDisplayEXT = reinterpret_cast<EGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (eglGetPlatformDisplayEXT != nullptr)
+            display_ = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+
+    if (display_ == EGL_NO_DISPLAY)
+        display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    if (display_ == EGL_NO_DISPLAY || eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+        throw std::runtime_error("failed to initialize EGL display for headless OpenGL context");
+
+    if (!HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+    {
+        eglTerminate(display_);
+        throw std::runtime_error("cannot create headless OpenGL context without EGL_KHR_surfaceless_context extension");
+    }
+
+    /* Choose any configuration that supports desktop OpenGL, since all rendering goes into framebuffer objects */
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       0,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    if (eglChooseConfig(display_, configAttribs, &config_, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+    {
+        eglTerminate(display_);
+        throw std::runtime_error("failed to choose EGL configuration for headless OpenGL context");
+    }
+}
+
+void LinuxGLHeadlessContext::CreateEGLContext(EGLContext sharedContext)
+{
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        throw std::runtime_error("failed to bind desktop OpenGL API for EGL");
+
+    if (profile_.contextProfile == OpenGLContextProfile::CoreProfile)
+    {
+        /* Create core profile */
+        context_ = CreateContextWithProfile(sharedContext, profile_);
+    }
+
+    if (context_ == EGL_NO_CONTEXT)
+    {
+        /* Create compatibility profile */
+        context_ = eglCreateContext(display_, config_, sharedContext, nullptr);
+    }
+
+    if (context_ == EGL_NO_CONTEXT)
+        throw std::runtime_error("failed to create headless OpenGL context with EGL");
+}
+
+EGLContext LinuxGLHeadlessContext::CreateContextWithProfile(EGLContext sharedContext, const ProfileOpenGLDescriptor& profile)
+{
+    /* Use the same default version as for GLX, since 'glGetIntegerv' can not be used until a valid GL context has been created */
+    int major = profile.majorVersion;
+    int minor = profile.minorVersion;
+
+    if (major < 0 || minor < 0)
+    {
+        major = 3;
+        minor = 2;
+    }
+
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR,          major,
+        EGL_CONTEXT_MINOR_VERSION_KHR,          minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+
+    auto context = eglCreateContext(display_, config_, sharedContext, contextAttribs);
+
+    if (context == EGL_NO_CONTEXT)
+        Log::StdErr() << "failed to create OpenGL core profile" << std::endl;
+
+    return context;
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+
+// ================================================================================
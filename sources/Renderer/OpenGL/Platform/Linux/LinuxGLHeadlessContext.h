@@ -0,0 +1,69 @@
+/*
+ * LinuxGLHeadlessContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+#define LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+#include "../GLContext.h"
+#include <EGL/egl.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Offscreen GL context for headless render systems, which neither depends on a window nor on a display server.
+This is a surfaceless EGL context (EGL_KHR_surfaceless_context), i.e. it can only render into framebuffer objects.
+*/
+class LinuxGLHeadlessContext : public GLContext
+{
+
+    public:
+
+        LinuxGLHeadlessContext(const ProfileOpenGLDescriptor& profile);
+        ~LinuxGLHeadlessContext();
+
+        // Creates a worker context that shares all GL objects with the specified context.
+        LinuxGLHeadlessContext(LinuxGLHeadlessContext& sharedContext);
+
+        bool SetSwapInterval(int interval) override;
+        bool SwapBuffers() override;
+        void Resize(const Extent2D& resolution) override;
+
+    private:
+
+        bool Activate(bool activate) override;
+
+        void CreateDisplay();
+        void CreateEGLContext(EGLContext sharedContext);
+
+        EGLContext CreateContextWithProfile(EGLContext sharedContext, const ProfileOpenGLDescriptor& profile);
+
+        EGLDisplay              display_        = EGL_NO_DISPLAY;
+        EGLConfig               config_         = nullptr;
+        EGLContext              context_        = EGL_NO_CONTEXT;
+        bool                    ownsDisplay_    = false;    // Only the primary context terminates the EGL display, worker contexts share it
+
+        ProfileOpenGLDescriptor profile_;
+
+};
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+#endif
+
+
+
+// ================================================================================
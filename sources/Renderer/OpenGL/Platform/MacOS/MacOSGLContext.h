@@ -28,6 +28,9 @@ class MacOSGLContext : public GLContext
         MacOSGLContext(const RenderContextDescriptor& desc, Surface& surface, MacOSGLContext* sharedContext);
         ~MacOSGLContext();
 
+        // Creates a worker context without a view that shares all GL objects with the specified context.
+        MacOSGLContext(MacOSGLContext& sharedContext);
+
         bool SetSwapInterval(int interval) override;
         bool SwapBuffers() override;
         void Resize(const Extent2D& resolution) override;
@@ -23,6 +23,16 @@ std::unique_ptr<GLContext> GLContext::Create(const RenderContextDescriptor& desc
     return MakeUnique<MacOSGLContext>(desc, surface, sharedContextGLNS);
 }
 
+std::unique_ptr<GLContext> GLContext::CreateWorker(GLContext& sharedContext)
+{
+    return MakeUnique<MacOSGLContext>(LLGL_CAST(MacOSGLContext&, sharedContext));
+}
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(const ProfileOpenGLDescriptor& profile)
+{
+    throw std::runtime_error("headless OpenGL contexts are not supported on MacOS");
+}
+
 MacOSGLContext::MacOSGLContext(const RenderContextDescriptor& desc, Surface& surface, MacOSGLContext* sharedContext) :
     LLGL::GLContext { sharedContext }
 {
@@ -34,6 +44,16 @@ MacOSGLContext::MacOSGLContext(const RenderContextDescriptor& desc, Surface& sur
     CreateNSGLContext(nativeHandle, sharedContext);
 }
 
+MacOSGLContext::MacOSGLContext(MacOSGLContext& sharedContext) :
+    LLGL::GLContext { nullptr }
+{
+    /* Create new NS-OpenGL context with the pixel format of the shared context, but don't make it current yet */
+    pixelFormat_ = [sharedContext.pixelFormat_ retain];
+    ctx_ = [[NSOpenGLContext alloc] initWithFormat:pixelFormat_ shareContext:sharedContext.ctx_];
+    if (!ctx_)
+        throw std::runtime_error("failed to create NSOpenGLContext for worker thread");
+}
+
 MacOSGLContext::~MacOSGLContext()
 {
     DeleteNSGLContext();
@@ -63,8 +83,16 @@ void MacOSGLContext::Resize(const Extent2D& resolution)
 
 bool MacOSGLContext::Activate(bool activate)
 {
-    [ctx_ makeCurrentContext];
-    [ctx_ setView:[wnd_ contentView]];
+    if (activate)
+    {
+        [ctx_ makeCurrentContext];
+
+        /* Worker contexts have no view */
+        if (wnd_ != nullptr)
+            [ctx_ setView:[wnd_ contentView]];
+    }
+    else
+        [NSOpenGLContext clearCurrentContext];
     return true;
 }
 
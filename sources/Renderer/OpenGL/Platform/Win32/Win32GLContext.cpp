@@ -29,6 +29,16 @@ std::unique_ptr<GLContext> GLContext::Create(const RenderContextDescriptor& desc
     return MakeUnique<Win32GLContext>(desc, surface, sharedContextWGL);
 }
 
+std::unique_ptr<GLContext> GLContext::CreateWorker(GLContext& sharedContext)
+{
+    return MakeUnique<Win32GLContext>(LLGL_CAST(Win32GLContext&, sharedContext));
+}
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(const ProfileOpenGLDescriptor& profile)
+{
+    throw std::runtime_error("headless OpenGL contexts are not supported on Win32");
+}
+
 
 /*
  * Win32GLContext class
@@ -48,6 +58,14 @@ Win32GLContext::Win32GLContext(const RenderContextDescriptor& desc, Surface& sur
         CreateContext(nullptr);
 }
 
+Win32GLContext::Win32GLContext(Win32GLContext& sharedContext) :
+    GLContext { nullptr                 },
+    desc_     { sharedContext.desc_     },
+    surface_  { sharedContext.surface_  }
+{
+    CreateWorkerContext(sharedContext);
+}
+
 Win32GLContext::~Win32GLContext()
 {
     DeleteContext();
@@ -198,6 +216,29 @@ void Win32GLContext::CreateContext(Win32GLContext* sharedContext)
     //QueryGLVersion();
 }
 
+void Win32GLContext::CreateWorkerContext(Win32GLContext& sharedContext)
+{
+    /* Use device context and pixel format of the shared context, since a pixel format can be chosen only once for a Win32 window */
+    pixelFormat_    = sharedContext.pixelFormat_;
+    hDC_            = sharedContext.hDC_;
+
+    /* Create own hardware context with the same profile as the shared context, but don't make it current yet */
+    if (desc_.profileOpenGL.contextProfile != OpenGLContextProfile::CompatibilityProfile && wglCreateContextAttribsARB != nullptr)
+        hGLRC_ = CreateExtContextProfile(sharedContext.hGLRC_);
+    else
+    {
+        hGLRC_ = CreateStdContextProfile();
+        if (hGLRC_ && !wglShareLists(sharedContext.hGLRC_, hGLRC_))
+        {
+            DeleteGLContext(hGLRC_);
+            throw std::runtime_error("failed to share resources with OpenGL worker context");
+        }
+    }
+
+    if (!hGLRC_)
+        throw std::runtime_error("failed to create OpenGL worker context");
+}
+
 void Win32GLContext::DeleteContext()
 {
     if (!hasSharedContext_)
@@ -27,6 +27,9 @@ class Win32GLContext : public GLContext
         Win32GLContext(const RenderContextDescriptor& desc, Surface& surface, Win32GLContext* sharedContext);
         ~Win32GLContext();
 
+        // Creates a worker context that shares all GL objects with the specified context and activates it for the same device context.
+        Win32GLContext(Win32GLContext& sharedContext);
+
         bool SetSwapInterval(int interval) override;
         bool SwapBuffers() override;
         void Resize(const Extent2D& resolution) override;
@@ -36,6 +39,7 @@ class Win32GLContext : public GLContext
         bool Activate(bool activate) override;
 
         void CreateContext(Win32GLContext* sharedContext);
+        void CreateWorkerContext(Win32GLContext& sharedContext);
         void DeleteContext();
 
         void DeleteGLContext(HGLRC& renderContext);
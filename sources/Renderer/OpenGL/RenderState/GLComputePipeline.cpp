@@ -8,6 +8,7 @@
 #include "GLComputePipeline.h"
 #include "GLStateManager.h"
 #include "../Shader/GLShaderProgram.h"
+#include "GLPipelineLayout.h"
 #include "../../CheckedCast.h"
 
 
@@ -21,6 +22,10 @@ GLComputePipeline::GLComputePipeline(const ComputePipelineDescriptor& desc)
     shaderProgram_ = LLGL_CAST(GLShaderProgram*, desc.shaderProgram);
     if (!shaderProgram_)
         throw std::invalid_argument("failed to create compute pipeline due to missing shader program");
+
+    /* Store layout of constants */
+    if (auto pipelineLayoutGL = LLGL_CAST(GLPipelineLayout*, desc.pipelineLayout))
+        constants_ = pipelineLayoutGL->GetConstants();
 }
 
 void GLComputePipeline::Bind(GLStateManager& stateMngr)
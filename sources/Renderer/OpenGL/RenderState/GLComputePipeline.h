@@ -10,6 +10,7 @@
 
 
 #include <LLGL/ComputePipeline.h>
+#include <LLGL/PipelineLayoutFlags.h>
 
 
 namespace LLGL
@@ -28,9 +29,16 @@ class GLComputePipeline final : public ComputePipeline
 
         void Bind(GLStateManager& stateMngr);
 
+        // Returns the layout of the constants from the pipeline layout.
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
     private:
 
-        GLShaderProgram* shaderProgram_ = nullptr;
+        GLShaderProgram*    shaderProgram_  = nullptr;
+        ConstantsDescriptor constants_;
 
 };
 
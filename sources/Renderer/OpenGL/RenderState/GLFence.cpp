@@ -8,6 +8,8 @@
 #include "GLFence.h"
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLExtensionRegistry.h"
+#include <chrono>
+#include <thread>
 
 
 namespace LLGL
@@ -17,6 +19,15 @@ namespace LLGL
 GLFence::~GLFence()
 {
     Release();
+    for (const auto& signal : timelineSignals_)
+        glDeleteSync(signal.sync);
+}
+
+std::uint64_t GLFence::GetCompletedValue()
+{
+    std::lock_guard<std::mutex> guard { timelineMutex_ };
+    PollTimelineSignals();
+    return completedValue_;
 }
 
 void GLFence::Submit()
@@ -25,6 +36,9 @@ void GLFence::Submit()
     {
         Release();
         sync_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        /* Flush the fence command, so it can be waited for in other GL contexts (e.g. fences of worker threads) */
+        glFlush();
     }
 }
 
@@ -32,6 +46,10 @@ bool GLFence::Wait(GLuint64 timeout)
 {
     if (HasExtension(GLExt::ARB_sync))
     {
+        /* Fence that has never been submitted is always signaled */
+        if (!sync_)
+            return true;
+
         GLenum result = glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
         return (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
     }
@@ -42,6 +60,77 @@ bool GLFence::Wait(GLuint64 timeout)
     }
 }
 
+void GLFence::Signal(std::uint64_t value)
+{
+    if (HasExtension(GLExt::ARB_sync))
+    {
+        auto sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        /* Flush the fence command, so it can be waited for in other GL contexts */
+        glFlush();
+
+        std::lock_guard<std::mutex> guard { timelineMutex_ };
+        timelineSignals_.push_back({ value, sync });
+    }
+    else
+    {
+        glFinish();
+        std::lock_guard<std::mutex> guard { timelineMutex_ };
+        completedValue_ = value;
+    }
+}
+
+void GLFence::ServerWait(std::uint64_t value)
+{
+    std::lock_guard<std::mutex> guard { timelineMutex_ };
+
+    PollTimelineSignals();
+    if (completedValue_ >= value)
+        return;
+
+    /* Let the GL server wait without blocking the client */
+    if (auto sync = FindTimelineSync(value))
+        glWaitSync(sync, 0, GL_TIMEOUT_IGNORED);
+}
+
+bool GLFence::WaitValue(std::uint64_t value, GLuint64 timeout)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> guard { timelineMutex_ };
+
+            PollTimelineSignals();
+            if (completedValue_ >= value)
+                return true;
+
+            /* Wait for the sync object if the value has already been signaled by any thread */
+            if (auto sync = FindTimelineSync(value))
+            {
+                GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+                if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+                {
+                    PollTimelineSignals();
+                    return true;
+                }
+                return false;
+            }
+        }
+
+        /* Otherwise, wait until another thread signals the value */
+        if (timeout != ~0ull)
+        {
+            auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+            if (static_cast<GLuint64>(elapsedTime.count()) >= timeout)
+                return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -56,6 +145,33 @@ void GLFence::Release()
     }
 }
 
+void GLFence::PollTimelineSignals()
+{
+    /* Sync objects are signaled in order, so stop at the first one that is still pending */
+    while (!timelineSignals_.empty())
+    {
+        const auto& signal = timelineSignals_.front();
+
+        GLenum result = glClientWaitSync(signal.sync, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            break;
+
+        completedValue_ = signal.value;
+        glDeleteSync(signal.sync);
+        timelineSignals_.pop_front();
+    }
+}
+
+GLsync GLFence::FindTimelineSync(std::uint64_t value) const
+{
+    for (const auto& signal : timelineSignals_)
+    {
+        if (signal.value >= value)
+            return signal.sync;
+    }
+    return 0;
+}
+
 
 } // /namespace LLGL
 
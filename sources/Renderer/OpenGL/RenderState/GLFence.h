@@ -11,6 +11,8 @@
 
 #include <LLGL/Fence.h>
 #include "../OpenGL.h"
+#include <deque>
+#include <mutex>
 
 
 namespace LLGL
@@ -24,14 +26,43 @@ class GLFence final : public Fence
 
         ~GLFence();
 
+        std::uint64_t GetCompletedValue() override;
+
         void Submit();
         bool Wait(GLuint64 timeout);
 
+        // Inserts a sync object for the specified timeline value into the command stream.
+        void Signal(std::uint64_t value);
+
+        // Lets the GL server wait for the first sync object that signals the specified timeline value (see glWaitSync).
+        void ServerWait(std::uint64_t value);
+
+        // Blocks the CPU until the specified timeline value has been signaled, or the timeout (in nanoseconds) has expired.
+        bool WaitValue(std::uint64_t value, GLuint64 timeout);
+
+    private:
+
+        struct TimelineSignal
+        {
+            std::uint64_t   value;
+            GLsync          sync;
+        };
+
     private:
 
         void Release();
 
-        GLsync sync_ = 0;
+        // Removes all timeline signals that have been passed by the GPU. The timeline mutex must be locked.
+        void PollTimelineSignals();
+
+        // Returns the sync object of the first pending timeline signal with the specified value or greater, or null if there is no such signal.
+        GLsync FindTimelineSync(std::uint64_t value) const;
+
+        GLsync                      sync_           = 0;
+
+        std::mutex                  timelineMutex_;                 // Timelines can be signaled and waited for by different threads (e.g. worker threads)
+        std::deque<TimelineSignal>  timelineSignals_;
+        std::uint64_t               completedValue_ = 0;
 
 };
 
@@ -6,11 +6,15 @@
  */
 
 #include "GLGraphicsPipeline.h"
+#include "GLPipelineLayout.h"
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLTypes.h"
 #include "../../GLCommon/GLCore.h"
 #include "../../CheckedCast.h"
 #include <LLGL/GraphicsPipelineFlags.h>
+#include <map>
+#include <mutex>
+#include <string>
 
 
 namespace LLGL
@@ -94,6 +98,33 @@ static bool IsPolygonOffsetEnabled(const DepthBiasDescriptor& desc)
     return (desc.slopeFactor != 0.0f || desc.constantFactor != 0.0f);
 }
 
+// Appends the raw bytes of the specified value to the key of a state group.
+template <typename T>
+void AppendStateKey(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Returns the unique ID of the specified state group key. IDs are never reused, so they remain valid after their pipelines have been released.
+static std::uint32_t GetStateGroupID(GLStateGroup group, std::string&& key)
+{
+    static std::mutex                           stateGroupMutex;
+    static std::map<std::string, std::uint32_t> stateGroupIDs;
+
+    /* Prefix key with state group, so equal keys of different groups do not share the same ID */
+    key.insert(key.begin(), static_cast<char>(group));
+
+    std::lock_guard<std::mutex> guard { stateGroupMutex };
+    auto it = stateGroupIDs.find(key);
+    if (it != stateGroupIDs.end())
+        return it->second;
+
+    /* Zero is reserved for invalid state groups */
+    const auto id = static_cast<std::uint32_t>(stateGroupIDs.size() + 1);
+    stateGroupIDs[std::move(key)] = id;
+    return id;
+}
+
 
 /* ----- GLGraphicsPipeline class ----- */
 
@@ -105,6 +136,10 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     if (!shaderProgram_)
         throw std::invalid_argument("failed to create graphics pipeline due to missing shader program");
 
+    /* Store layout of constants */
+    if (auto pipelineLayoutGL = LLGL_CAST(GLPipelineLayout*, desc.pipelineLayout))
+        constants_ = pipelineLayoutGL->GetConstants();
+
     /* Convert input-assembler state */
     drawMode_ = GLTypes::Map(desc.primitiveTopology);
 
@@ -130,10 +165,28 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     depthMask_              = (desc.depth.writeEnabled ? GL_TRUE : GL_FALSE);
     depthFunc_              = GLTypes::Map(desc.depth.compareOp);
 
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    depthBoundsEnabled_     = desc.depth.boundsTestEnabled;
+    depthBoundsDynamic_     = ((desc.dynamicStates & DynamicStateFlags::DepthBounds) != 0);
+    if (depthBoundsEnabled_ && !depthBoundsDynamic_)
+    {
+        depthBounds_[0] = desc.depth.boundsMin;
+        depthBounds_[1] = desc.depth.boundsMax;
+    }
+    #endif
+
     /* Convert stencil state */
     stencilTestEnabled_     = desc.stencil.testEnabled;
     Convert(stencilFront_, desc.stencil.front);
     Convert(stencilBack_, desc.stencil.back);
+    stencilRefDynamic_      = ((desc.dynamicStates & DynamicStateFlags::StencilReference) != 0);
+
+    if (stencilRefDynamic_)
+    {
+        /* Ignore static reference values, so they don't distinguish the stencil state group */
+        stencilFront_.ref   = 0;
+        stencilBack_.ref    = 0;
+    }
 
     /* Convert rasterizer state */
     polygonMode_            = GLTypes::Map(desc.rasterizer.polygonMode);
@@ -144,7 +197,8 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     multiSampleEnabled_     = desc.rasterizer.multiSampling.enabled;
     lineSmoothEnabled_      = desc.rasterizer.antiAliasedLineEnabled;
     lineWidth_              = desc.rasterizer.lineWidth;
-    polygonOffsetEnabled_   = IsPolygonOffsetEnabled(desc.rasterizer.depthBias);
+    depthBiasDynamic_       = ((desc.dynamicStates & DynamicStateFlags::DepthBias) != 0);
+    polygonOffsetEnabled_   = (depthBiasDynamic_ || IsPolygonOffsetEnabled(desc.rasterizer.depthBias));
     polygonOffsetMode_      = PolygonModeToPolygonOffset(desc.rasterizer.polygonMode);
     polygonOffsetFactor_    = desc.rasterizer.depthBias.slopeFactor;
     polygonOffsetUnits_     = desc.rasterizer.depthBias.constantFactor;
@@ -157,7 +211,7 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     /* Convert blend state */
     blendEnabled_           = desc.blend.blendEnabled;
     blendColor_             = desc.blend.blendFactor;
-    blendColorNeeded_       = IsBlendColorNeeded(desc.blend);
+    blendColorNeeded_       = ((desc.dynamicStates & DynamicStateFlags::BlendFactor) == 0 && IsBlendColorNeeded(desc.blend));
     Convert(blendStates_, desc.blend.targets);
     sampleAlphaToCoverage_  = desc.blend.alphaToCoverageEnabled;
 
@@ -167,6 +221,8 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
         logicOpEnabled_ = true;
         logicOp_        = GLTypes::Map(desc.blend.logicOp);
     }
+
+    BuildStateGroupIDs();
 }
 
 void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
@@ -179,7 +235,26 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
     if (patchVertices_ > 0)
         stateMngr.SetPatchVertices(patchVertices_);
 
-    /* Setup depth state */
+    /* Only apply the state groups that differ from the previously bound graphics pipeline */
+    if (stateMngr.SetStateGroup(GLStateGroup::DEPTH, depthStateID_))
+        BindDepthState(stateMngr);
+    if (stateMngr.SetStateGroup(GLStateGroup::STENCIL, stencilStateID_))
+        BindStencilState(stateMngr);
+    if (stateMngr.SetStateGroup(GLStateGroup::RASTERIZER, rasterizerStateID_))
+        BindRasterizerState(stateMngr);
+    if (stateMngr.SetStateGroup(GLStateGroup::BLEND, blendStateID_))
+        BindBlendState(stateMngr);
+    if (stateMngr.SetStateGroup(GLStateGroup::LOGIC_OP, logicOpStateID_))
+        BindLogicOpState(stateMngr);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLGraphicsPipeline::BindDepthState(GLStateManager& stateMngr)
+{
     if (depthTestEnabled_)
     {
         stateMngr.Enable(GLState::DEPTH_TEST);
@@ -190,17 +265,40 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
 
     stateMngr.SetDepthMask(depthMask_);
 
-    /* Setup stencil state */
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    stateMngr.Set(GLStateExt::DEPTH_BOUNDS_TEST, depthBoundsEnabled_);
+    if (depthBoundsEnabled_ && !depthBoundsDynamic_)
+        stateMngr.SetDepthBounds(depthBounds_[0], depthBounds_[1]);
+    #endif
+}
+
+void GLGraphicsPipeline::BindStencilState(GLStateManager& stateMngr)
+{
     if (stencilTestEnabled_)
     {
         stateMngr.Enable(GLState::STENCIL_TEST);
-        stateMngr.SetStencilState(GL_FRONT, stencilFront_);
-        stateMngr.SetStencilState(GL_BACK, stencilBack_);
+        if (stencilRefDynamic_)
+        {
+            /* Keep the stencil reference value of the command buffer */
+            auto front  = stencilFront_;
+            auto back   = stencilBack_;
+            front.ref   = stateMngr.GetStencilRef();
+            back.ref    = stateMngr.GetStencilRef();
+            stateMngr.SetStencilState(GL_FRONT, front);
+            stateMngr.SetStencilState(GL_BACK, back);
+        }
+        else
+        {
+            stateMngr.SetStencilState(GL_FRONT, stencilFront_);
+            stateMngr.SetStencilState(GL_BACK, stencilBack_);
+        }
     }
     else
         stateMngr.Disable(GLState::STENCIL_TEST);
+}
 
-    /* Setup rasterizer state */
+void GLGraphicsPipeline::BindRasterizerState(GLStateManager& stateMngr)
+{
     stateMngr.SetPolygonMode(polygonMode_);
     stateMngr.SetFrontFace(frontFace_);
 
@@ -215,7 +313,8 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
     if (polygonOffsetEnabled_)
     {
         stateMngr.Enable(polygonOffsetMode_);
-        stateMngr.SetPolygonOffset(polygonOffsetFactor_, polygonOffsetUnits_, polygonOffsetClamp_);
+        if (!depthBiasDynamic_)
+            stateMngr.SetPolygonOffset(polygonOffsetFactor_, polygonOffsetUnits_, polygonOffsetClamp_);
     }
     else
         stateMngr.Disable(polygonOffsetMode_);
@@ -229,8 +328,10 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
     #ifdef LLGL_GL_ENABLE_VENDOR_EXT
     stateMngr.Set(GLStateExt::CONSERVATIVE_RASTERIZATION, conservativeRaster_);
     #endif
+}
 
-    /* Setup blend state */
+void GLGraphicsPipeline::BindBlendState(GLStateManager& stateMngr)
+{
     stateMngr.Set(GLState::BLEND, blendEnabled_);
     stateMngr.SetBlendStates(blendStates_, blendEnabled_);
 
@@ -239,8 +340,10 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
 
     if (multiSampleEnabled_)
         stateMngr.Set(GLState::SAMPLE_ALPHA_TO_COVERAGE, sampleAlphaToCoverage_);
+}
 
-    /* Setup color logic operation */
+void GLGraphicsPipeline::BindLogicOpState(GLStateManager& stateMngr)
+{
     if (logicOpEnabled_)
     {
         stateMngr.Enable(GLState::COLOR_LOGIC_OP);
@@ -250,6 +353,89 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
         stateMngr.Disable(GLState::COLOR_LOGIC_OP);
 }
 
+void GLGraphicsPipeline::BuildStateGroupIDs()
+{
+    /* Build key of depth state (the depth function is ignored if the depth test is disabled) */
+    std::string depthKey;
+    {
+        AppendStateKey(depthKey, depthTestEnabled_);
+        AppendStateKey(depthKey, depthMask_);
+        if (depthTestEnabled_)
+            AppendStateKey(depthKey, depthFunc_);
+        #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+        AppendStateKey(depthKey, depthBoundsEnabled_);
+        if (depthBoundsEnabled_)
+        {
+            AppendStateKey(depthKey, depthBoundsDynamic_);
+            AppendStateKey(depthKey, depthBounds_);
+        }
+        #endif
+    }
+    depthStateID_ = GetStateGroupID(GLStateGroup::DEPTH, std::move(depthKey));
+
+    /* Build key of stencil state (the stencil faces are ignored if the stencil test is disabled) */
+    std::string stencilKey;
+    {
+        AppendStateKey(stencilKey, stencilTestEnabled_);
+        if (stencilTestEnabled_)
+        {
+            AppendStateKey(stencilKey, stencilRefDynamic_);
+            AppendStateKey(stencilKey, stencilFront_);
+            AppendStateKey(stencilKey, stencilBack_);
+        }
+    }
+    stencilStateID_ = GetStateGroupID(GLStateGroup::STENCIL, std::move(stencilKey));
+
+    /* Build key of rasterizer state */
+    std::string rasterizerKey;
+    {
+        AppendStateKey(rasterizerKey, polygonMode_);
+        AppendStateKey(rasterizerKey, frontFace_);
+        AppendStateKey(rasterizerKey, cullFace_);
+        AppendStateKey(rasterizerKey, polygonOffsetEnabled_);
+        AppendStateKey(rasterizerKey, polygonOffsetMode_);
+        AppendStateKey(rasterizerKey, depthBiasDynamic_);
+        if (polygonOffsetEnabled_ && !depthBiasDynamic_)
+        {
+            AppendStateKey(rasterizerKey, polygonOffsetFactor_);
+            AppendStateKey(rasterizerKey, polygonOffsetUnits_);
+            AppendStateKey(rasterizerKey, polygonOffsetClamp_);
+        }
+        AppendStateKey(rasterizerKey, scissorTestEnabled_);
+        AppendStateKey(rasterizerKey, depthClampEnabled_);
+        AppendStateKey(rasterizerKey, multiSampleEnabled_);
+        AppendStateKey(rasterizerKey, lineSmoothEnabled_);
+        AppendStateKey(rasterizerKey, lineWidth_);
+        #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+        AppendStateKey(rasterizerKey, conservativeRaster_);
+        #endif
+    }
+    rasterizerStateID_ = GetStateGroupID(GLStateGroup::RASTERIZER, std::move(rasterizerKey));
+
+    /* Build key of blend state (alpha-to-coverage is only applied with multi-sampling) */
+    std::string blendKey;
+    {
+        AppendStateKey(blendKey, blendEnabled_);
+        for (const auto& state : blendStates_)
+            AppendStateKey(blendKey, state);
+        AppendStateKey(blendKey, blendColorNeeded_);
+        if (blendColorNeeded_)
+            AppendStateKey(blendKey, blendColor_);
+        AppendStateKey(blendKey, multiSampleEnabled_);
+        if (multiSampleEnabled_)
+            AppendStateKey(blendKey, sampleAlphaToCoverage_);
+    }
+    blendStateID_ = GetStateGroupID(GLStateGroup::BLEND, std::move(blendKey));
+
+    /* Build key of color logic operation state */
+    std::string logicOpKey;
+    {
+        AppendStateKey(logicOpKey, logicOpEnabled_);
+        if (logicOpEnabled_)
+            AppendStateKey(logicOpKey, logicOp_);
+    }
+    logicOpStateID_ = GetStateGroupID(GLStateGroup::LOGIC_OP, std::move(logicOpKey));
+}
 
 } // /namespace LLGL
 
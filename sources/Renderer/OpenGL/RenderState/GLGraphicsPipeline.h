@@ -14,6 +14,7 @@
 #include "../Shader/GLShaderProgram.h"
 #include <LLGL/GraphicsPipeline.h>
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include <vector>
 
 
@@ -39,10 +40,28 @@ class GLGraphicsPipeline final : public GraphicsPipeline
             return drawMode_;
         }
 
+        // Returns the layout of the constants from the pipeline layout.
+        inline const ConstantsDescriptor& GetConstants() const
+        {
+            return constants_;
+        }
+
+    private:
+
+        void BindDepthState(GLStateManager& stateMngr);
+        void BindStencilState(GLStateManager& stateMngr);
+        void BindRasterizerState(GLStateManager& stateMngr);
+        void BindBlendState(GLStateManager& stateMngr);
+        void BindLogicOpState(GLStateManager& stateMngr);
+
+        // Determines the IDs of all state groups, which are equal for all pipelines with equal states of the respective group.
+        void BuildStateGroupIDs();
+
     private:
 
         // shader state
         GLShaderProgram*        shaderProgram_          = nullptr;
+        ConstantsDescriptor     constants_;
 
         // input-assembler state
         GLenum                  drawMode_               = GL_TRIANGLES;
@@ -53,10 +72,17 @@ class GLGraphicsPipeline final : public GraphicsPipeline
         GLboolean               depthMask_              = false;    // glDepthMask(GL_TRUE)
         GLenum                  depthFunc_              = GL_LESS;
 
+        #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+        bool                    depthBoundsEnabled_     = false;    // glEnable(GL_DEPTH_BOUNDS_TEST_EXT)
+        GLfloat                 depthBounds_[2]         = { 0.0f, 1.0f };
+        bool                    depthBoundsDynamic_     = false;    // DynamicStateFlags::DepthBounds
+        #endif
+
         // stencil state
         bool                    stencilTestEnabled_     = false;    // glEnable(GL_STENCIL_TEST)
         GLStencil               stencilFront_;
         GLStencil               stencilBack_;
+        bool                    stencilRefDynamic_      = false;    // DynamicStateFlags::StencilReference
 
         // rasterizer state
         GLenum                  polygonMode_            = GL_FILL;
@@ -72,6 +98,7 @@ class GLGraphicsPipeline final : public GraphicsPipeline
         GLfloat                 polygonOffsetFactor_    = 0.0f;
         GLfloat                 polygonOffsetUnits_     = 0.0f;
         GLfloat                 polygonOffsetClamp_     = 0.0f;
+        bool                    depthBiasDynamic_       = false;    // DynamicStateFlags::DepthBias
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
         bool                    conservativeRaster_     = false;    // glEnable(GL_CONSERVATIVE_RASTERIZATION_NV/INTEL)
@@ -88,6 +115,13 @@ class GLGraphicsPipeline final : public GraphicsPipeline
         bool                    logicOpEnabled_         = false;
         GLenum                  logicOp_                = GL_COPY;
 
+        // state group IDs, see GLStateManager::SetStateGroup
+        std::uint32_t           depthStateID_           = 0;
+        std::uint32_t           stencilStateID_         = 0;
+        std::uint32_t           rasterizerStateID_      = 0;
+        std::uint32_t           blendStateID_           = 0;
+        std::uint32_t           logicOpStateID_         = 0;
+
 };
 
 
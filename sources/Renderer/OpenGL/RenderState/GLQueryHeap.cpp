@@ -0,0 +1,73 @@
+/*
+ * GLQueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLQueryHeap.h"
+#include "../Ext/GLExtensions.h"
+
+
+namespace LLGL
+{
+
+
+static GLenum MapQueryHeapType(const QueryType queryType)
+{
+    switch (queryType)
+    {
+        #ifdef LLGL_OPENGL
+        case QueryType::SamplesPassed:                  return GL_SAMPLES_PASSED;
+        #else
+        case QueryType::SamplesPassed:                  return GL_ANY_SAMPLES_PASSED;
+        #endif
+        case QueryType::AnySamplesPassed:               return GL_ANY_SAMPLES_PASSED;
+        case QueryType::AnySamplesPassedConservative:   return GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+        default:                                        return 0;
+    }
+}
+
+GLQueryHeap::GLQueryHeap(const QueryHeapDescriptor& desc) :
+    QueryHeap { desc                        },
+    target_   { MapQueryHeapType(desc.type) }
+{
+    /* Generate all GL query objects at once */
+    ids_.resize(desc.numQueries);
+    glGenQueries(static_cast<GLsizei>(ids_.size()), ids_.data());
+}
+
+GLQueryHeap::~GLQueryHeap()
+{
+    glDeleteQueries(static_cast<GLsizei>(ids_.size()), ids_.data());
+}
+
+void GLQueryHeap::Begin(std::uint32_t query)
+{
+    glBeginQuery(target_, ids_[query]);
+}
+
+void GLQueryHeap::End()
+{
+    glEndQuery(target_);
+}
+
+bool GLQueryHeap::AreResultsAvailable(std::uint32_t firstQuery, std::uint32_t numQueries) const
+{
+    /* Results become available in order, but check each query since they can be ended in any order */
+    for (std::uint32_t i = 0; i < numQueries; ++i)
+    {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(ids_[firstQuery + i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+            return false;
+    }
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
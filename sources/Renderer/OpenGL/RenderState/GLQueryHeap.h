@@ -0,0 +1,62 @@
+/*
+ * GLQueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_QUERY_HEAP_H
+#define LLGL_GL_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLQueryHeap final : public QueryHeap
+{
+
+    public:
+
+        GLQueryHeap(const QueryHeapDescriptor& desc);
+        ~GLQueryHeap();
+
+        void Begin(std::uint32_t query);
+        void End();
+
+        // Returns true if the results of all queries in the specified range are available.
+        bool AreResultsAvailable(std::uint32_t firstQuery, std::uint32_t numQueries) const;
+
+        // Returns the hardware query ID of the specified query.
+        inline GLuint GetID(std::uint32_t query) const
+        {
+            return ids_[query];
+        }
+
+        // Returns the GL query target of all queries in this heap.
+        inline GLenum GetTarget() const
+        {
+            return target_;
+        }
+
+    private:
+
+        std::vector<GLuint> ids_;
+        GLenum              target_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
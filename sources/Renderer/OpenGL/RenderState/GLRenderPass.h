@@ -0,0 +1,29 @@
+/*
+ * GLRenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_RENDER_PASS_H
+#define LLGL_GL_RENDER_PASS_H
+
+
+#include "../../BasicRenderPass.h"
+
+
+namespace LLGL
+{
+
+
+using GLRenderPass = BasicRenderPass;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,6 +13,9 @@
 #include "../Texture/GLTexture.h"
 #include "../../CheckedCast.h"
 #include "../../ResourceBindingIterator.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -66,6 +69,7 @@ struct GLResourceBinding
     GLuint          slot;
     GLuint          object;
     GLTextureTarget target;
+    GLenum          format; // Internal format of image textures
 };
 
 
@@ -82,16 +86,18 @@ GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
 
     /* Validate binding descriptors */
     const auto& bindings = pipelineLayoutGL->GetBindings();
-    if (desc.resourceViews.size() != bindings.size())
+    if (desc.resourceViews.size() != ResourceBindingIterator::GetNumResourceViews(bindings))
         throw std::invalid_argument("failed to create resource heap due to mismatch between number of resources and bindings");
 
     /* Build buffer segments */
-    ResourceBindingIterator resourceIterator { desc.resourceViews, bindings };
+    resourceViews_  = desc.resourceViews;
+    bindings_       = bindings;
+    BuildSegments();
+}
 
-    BuildConstantBufferSegments(resourceIterator);
-    BuildStorageBufferSegments(resourceIterator);
-    BuildTextureSegments(resourceIterator);
-    BuildSamplerSegments(resourceIterator);
+GLResourceHeap::~GLResourceHeap()
+{
+    ReleaseBindlessBuffers();
 }
 
 static void BindBuffersBaseSegment(GLStateManager& stateMngr, std::int8_t*& byteAlignedBuffer, const GLBufferTarget bufferTarget)
@@ -122,6 +128,20 @@ static void BindTexturesSegment(GLStateManager& stateMngr, std::int8_t*& byteAli
     byteAlignedBuffer += segment->segmentSize;
 }
 
+static void BindImageTexturesSegment(GLStateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
+{
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment2*>(byteAlignedBuffer);
+    {
+        stateMngr.BindImageTextures(
+            segment->first,
+            segment->count,
+            reinterpret_cast<const GLuint*>(byteAlignedBuffer + segment->offsetEnd0),
+            reinterpret_cast<const GLenum*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment2))
+        );
+    }
+    byteAlignedBuffer += segment->segmentSize;
+}
+
 static void BindSamplersSegment(GLStateManager& stateMngr, std::int8_t*& byteAlignedBuffer)
 {
     const auto segment = reinterpret_cast<const GLResourceViewHeapSegment1*>(byteAlignedBuffer);
@@ -135,7 +155,7 @@ static void BindSamplersSegment(GLStateManager& stateMngr, std::int8_t*& byteAli
     byteAlignedBuffer += segment->segmentSize;
 }
 
-void GLResourceHeap::Bind(GLStateManager& stateMngr)
+void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
 {
     auto byteAlignedBuffer = buffer_.data();
 
@@ -143,30 +163,116 @@ void GLResourceHeap::Bind(GLStateManager& stateMngr)
     for (std::uint8_t i = 0; i < segmentationHeader_.numConstantBufferSegments; ++i)
         BindBuffersBaseSegment(stateMngr, byteAlignedBuffer, GLBufferTarget::UNIFORM_BUFFER);
 
+    /* Bind all constant buffers with dynamic offsets in ranges of consecutive slots (missing offsets are treated as zero) */
+    const auto numDynamicBuffers = dynamicBuffers_.slots.size();
+
+    for (std::size_t i = 0; i < numDynamicBuffers; ++i)
+        dynamicBuffers_.offsets[i] = (i < numDynamicOffsets ? static_cast<GLintptr>(dynamicOffsets[i]) : 0);
+
+    for (std::size_t begin = 0, end = 0; begin < numDynamicBuffers; begin = end)
+    {
+        for (end = begin + 1; end < numDynamicBuffers && dynamicBuffers_.slots[end] == dynamicBuffers_.slots[end - 1] + 1; ++end);
+        stateMngr.BindBuffersRange(
+            GLBufferTarget::UNIFORM_BUFFER,
+            dynamicBuffers_.slots[begin],
+            static_cast<GLsizei>(end - begin),
+            &(dynamicBuffers_.buffers[begin]),
+            &(dynamicBuffers_.offsets[begin]),
+            &(dynamicBuffers_.sizes[begin])
+        );
+    }
+
     /* Bind all shader storage buffers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numStorageBufferSegments; ++i)
         BindBuffersBaseSegment(stateMngr, byteAlignedBuffer, GLBufferTarget::SHADER_STORAGE_BUFFER);
 
+    /* Bind all hidden counters of append and consume buffers */
+    for (std::uint8_t i = 0; i < segmentationHeader_.numCounterBufferSegments; ++i)
+        BindBuffersBaseSegment(stateMngr, byteAlignedBuffer, GLBufferTarget::ATOMIC_COUNTER_BUFFER);
+
+    /* Bind all buffers of bindless texture handles */
+    for (const auto& bindlessBuffer : bindlessBuffers_)
+        stateMngr.BindBufferBase(GLBufferTarget::SHADER_STORAGE_BUFFER, bindlessBuffer.slot, bindlessBuffer.buffer);
+
     /* Bind all textures */
     for (std::uint8_t i = 0; i < segmentationHeader_.numTextureSegments; ++i)
         BindTexturesSegment(stateMngr, byteAlignedBuffer);
 
+    /* Bind all storage textures to their image units */
+    for (std::uint8_t i = 0; i < segmentationHeader_.numImageTextureSegments; ++i)
+        BindImageTexturesSegment(stateMngr, byteAlignedBuffer);
+
     /* Bind all samplers */
     for (std::uint8_t i = 0; i < segmentationHeader_.numSamplerSegments; ++i)
         BindSamplersSegment(stateMngr, byteAlignedBuffer);
 }
 
 
+void GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (static_cast<std::size_t>(firstDescriptor) + numResourceViews > resourceViews_.size())
+        throw std::out_of_range("resource views out of range for resource heap update");
+
+    /* Replace resource views */
+    std::copy(resourceViews, resourceViews + numResourceViews, resourceViews_.begin() + firstDescriptor);
+
+    /* Rebuild all segments, since their layout depends on the resources (e.g. storage usage of textures and hidden counters of buffers) */
+    ReleaseBindlessBuffers();
+
+    segmentationHeader_ = SegmentationHeader{};
+    buffer_.clear();
+    dynamicBuffers_ = GLDynamicBuffers{};
+
+    BuildSegments();
+}
+
+
 /*
  * ======= Private: =======
  */
 
+void GLResourceHeap::BuildSegments()
+{
+    ResourceBindingIterator resourceIterator { resourceViews_, bindings_ };
+
+    BuildConstantBufferSegments(resourceIterator);
+    BuildDynamicConstantBuffers(resourceIterator);
+    BuildStorageBufferSegments(resourceIterator);
+    BuildCounterBufferSegments(resourceIterator);
+    BuildBindlessTextureBuffers(resourceIterator);
+    BuildTextureSegments(resourceIterator);
+    BuildImageTextureSegments(resourceIterator);
+    BuildSamplerSegments(resourceIterator);
+}
+
+void GLResourceHeap::ReleaseBindlessBuffers()
+{
+    /* Texture handles are released together with their textures, so only the handle buffers must be deleted */
+    for (const auto& bindlessBuffer : bindlessBuffers_)
+    {
+        glDeleteBuffers(1, &(bindlessBuffer.buffer));
+        GLStateManager::active->NotifyBufferRelease(bindlessBuffer.buffer, GLBufferTarget::SHADER_STORAGE_BUFFER);
+    }
+    bindlessBuffers_.clear();
+}
+
 using GLResourceBindingFunc = std::function<GLResourceBinding(Resource* resource, std::uint32_t slot)>;
 
+// Returns true if bindless texture bindings are stored as texture handles rather than bound to consecutive texture units.
+static bool HasBindlessTextureHandles()
+{
+    #ifdef GL_ARB_bindless_texture
+    return HasExtension(GLExt::ARB_bindless_texture);
+    #else
+    return false;
+    #endif
+}
+
 static std::vector<GLResourceBinding> CollectGLResourceBindings(
     ResourceBindingIterator&        resourceIterator,
     const ResourceType              resourceType,
-    const GLResourceBindingFunc&    resourceFunc)
+    const GLResourceBindingFunc&    resourceFunc,
+    long                            ignoredBindingFlags = 0)
 {
     /* Collect all binding points of the specified resource type */
     BindingDescriptor bindingDesc;
@@ -176,7 +282,10 @@ static std::vector<GLResourceBinding> CollectGLResourceBindings(
     resourceBindings.reserve(resourceIterator.GetCount());
 
     while (auto resource = resourceIterator.Next(bindingDesc))
-        resourceBindings.push_back(resourceFunc(resource, bindingDesc.slot));
+    {
+        if ((bindingDesc.flags & ignoredBindingFlags) == 0)
+            resourceBindings.push_back(resourceFunc(resource, bindingDesc.slot));
+    }
 
     /* Sort resources by slot index */
     std::sort(
@@ -192,15 +301,16 @@ static std::vector<GLResourceBinding> CollectGLResourceBindings(
 
 void GLResourceHeap::BuildBufferSegments(ResourceBindingIterator& resourceIterator, const ResourceType resourceType, std::uint8_t& numSegments)
 {
-    /* Collect all buffers */
+    /* Collect all buffers (except the constant buffers that are bound with a dynamic offset) */
     auto resourceBindings = CollectGLResourceBindings(
         resourceIterator,
         resourceType,
         [](Resource* resource, std::uint32_t slot) -> GLResourceBinding
         {
             auto bufferGL = LLGL_CAST(GLBuffer*, resource);
-            return { slot, bufferGL->GetID(), GLTextureTarget::TEXTURE_1D };
-        }
+            return { slot, bufferGL->GetID(), GLTextureTarget::TEXTURE_1D, 0 };
+        },
+        BindingFlags::DynamicOffset
     );
 
     /* Build all resource segments for type <GLResourceViewHeapSegment1> */
@@ -216,22 +326,142 @@ void GLResourceHeap::BuildConstantBufferSegments(ResourceBindingIterator& resour
     BuildBufferSegments(resourceIterator, ResourceType::ConstantBuffer, segmentationHeader_.numConstantBufferSegments);
 }
 
+void GLResourceHeap::BuildDynamicConstantBuffers(ResourceBindingIterator& resourceIterator)
+{
+    struct GLDynamicBuffer
+    {
+        GLuint      slot;
+        GLuint      buffer;
+        GLsizeiptr  size;
+    };
+
+    /* Collect all constant buffers that are bound with a dynamic offset */
+    BindingDescriptor bindingDesc;
+    resourceIterator.Reset(ResourceType::ConstantBuffer);
+
+    std::vector<GLDynamicBuffer> dynamicBuffers;
+
+    while (auto resource = resourceIterator.Next(bindingDesc))
+    {
+        if ((bindingDesc.flags & BindingFlags::DynamicOffset) != 0)
+        {
+            auto bufferGL = LLGL_CAST(GLBuffer*, resource);
+            dynamicBuffers.push_back({ bindingDesc.slot, bufferGL->GetID(), static_cast<GLsizeiptr>(bindingDesc.dynamicRangeSize) });
+        }
+    }
+
+    /* Sort buffers by slot index, since the dynamic offsets are specified in that order */
+    std::sort(
+        dynamicBuffers.begin(), dynamicBuffers.end(),
+        [](const GLDynamicBuffer& lhs, const GLDynamicBuffer& rhs)
+        {
+            return (lhs.slot < rhs.slot);
+        }
+    );
+
+    /* Store buffers as separate arrays, so consecutive slots can be bound at once */
+    for (const auto& dynamicBuffer : dynamicBuffers)
+    {
+        dynamicBuffers_.slots.push_back(dynamicBuffer.slot);
+        dynamicBuffers_.buffers.push_back(dynamicBuffer.buffer);
+        dynamicBuffers_.sizes.push_back(dynamicBuffer.size);
+    }
+    dynamicBuffers_.offsets.resize(dynamicBuffers.size(), 0);
+}
+
 void GLResourceHeap::BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator)
 {
     BuildBufferSegments(resourceIterator, ResourceType::StorageBuffer, segmentationHeader_.numStorageBufferSegments);
 }
 
+void GLResourceHeap::BuildCounterBufferSegments(ResourceBindingIterator& resourceIterator)
+{
+    /* Collect atomic counter buffers of all append and consume buffers, which are bound to the same slot as their storage buffer */
+    auto resourceBindings = CollectGLResourceBindings(
+        resourceIterator,
+        ResourceType::StorageBuffer,
+        [](Resource* resource, std::uint32_t slot) -> GLResourceBinding
+        {
+            auto bufferGL = LLGL_CAST(GLBuffer*, resource);
+            return { slot, bufferGL->GetCounterID(), GLTextureTarget::TEXTURE_1D, 0 };
+        }
+    );
+
+    /* Remove all storage buffers without hidden counter */
+    RemoveAllFromListIf(
+        resourceBindings,
+        [](const GLResourceBinding& binding)
+        {
+            return (binding.object == 0);
+        }
+    );
+
+    /* Build all resource segments for type <GLResourceViewHeapSegment1> */
+    BuildAllSegments(
+        resourceBindings,
+        std::bind(&GLResourceHeap::BuildSegment1, this, std::placeholders::_1, std::placeholders::_2),
+        segmentationHeader_.numCounterBufferSegments
+    );
+}
+
+void GLResourceHeap::BuildBindlessTextureBuffers(ResourceBindingIterator& resourceIterator)
+{
+    #ifdef GL_ARB_bindless_texture
+
+    if (!HasBindlessTextureHandles())
+        return;
+
+    /* Collect texture handles of all bindless texture bindings, one buffer per binding */
+    BindingDescriptor bindingDesc;
+    std::uint32_t arrayElement = 0;
+    std::vector<GLuint64> handles;
+
+    resourceIterator.Reset(ResourceType::Texture);
+
+    while (auto resource = resourceIterator.Next(bindingDesc, &arrayElement))
+    {
+        if ((bindingDesc.flags & BindingFlags::Bindless) == 0)
+            continue;
+
+        /* Make texture handle resident (residency is not reference counted, so handles of shared textures are only made resident once) */
+        auto textureGL = LLGL_CAST(GLTexture*, resource);
+        auto handle = glGetTextureHandleARB(textureGL->GetID());
+
+        if (!glIsTextureHandleResidentARB(handle))
+            glMakeTextureHandleResidentARB(handle);
+
+        handles.push_back(handle);
+
+        /* Create buffer after the last array element */
+        if (arrayElement + 1 == bindingDesc.arraySize)
+        {
+            GLBindlessBuffer bindlessBuffer;
+            {
+                bindlessBuffer.slot = bindingDesc.slot - arrayElement;
+                glGenBuffers(1, &(bindlessBuffer.buffer));
+                GLStateManager::active->BindBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, bindlessBuffer.buffer);
+                glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(sizeof(GLuint64) * handles.size()), handles.data(), GL_STATIC_DRAW);
+            }
+            bindlessBuffers_.push_back(bindlessBuffer);
+            handles.clear();
+        }
+    }
+
+    #endif // /GL_ARB_bindless_texture
+}
+
 void GLResourceHeap::BuildTextureSegments(ResourceBindingIterator& resourceIterator)
 {
-    /* Collect all textures */
+    /* Collect all textures (except the bindless textures that are accessed by their handles) */
     auto resourceBindings = CollectGLResourceBindings(
         resourceIterator,
         ResourceType::Texture,
         [](Resource* resource, std::uint32_t slot) -> GLResourceBinding
         {
             auto textureGL = LLGL_CAST(GLTexture*, resource);
-            return { slot, textureGL->GetID(), GLStateManager::GetTextureTarget(textureGL->GetType()) };
-        }
+            return { slot, textureGL->GetID(), GLStateManager::GetTextureTarget(textureGL->GetType()), 0 };
+        },
+        (HasBindlessTextureHandles() ? BindingFlags::Bindless : 0)
     );
 
     /* Build all resource segments for type <GLResourceViewHeapSegment2> */
@@ -242,6 +472,40 @@ void GLResourceHeap::BuildTextureSegments(ResourceBindingIterator& resourceItera
     );
 }
 
+void GLResourceHeap::BuildImageTextureSegments(ResourceBindingIterator& resourceIterator)
+{
+    /* Collect all textures with storage usage, which are also bound to the image unit of their slot */
+    auto resourceBindings = CollectGLResourceBindings(
+        resourceIterator,
+        ResourceType::Texture,
+        [](Resource* resource, std::uint32_t slot) -> GLResourceBinding
+        {
+            auto textureGL = LLGL_CAST(GLTexture*, resource);
+            if ((textureGL->GetFlags() & TextureFlags::StorageUsage) != 0)
+                return { slot, textureGL->GetID(), GLTextureTarget::TEXTURE_1D, textureGL->QueryGLInternalFormat() };
+            else
+                return { slot, 0, GLTextureTarget::TEXTURE_1D, 0 };
+        },
+        BindingFlags::Bindless
+    );
+
+    /* Remove all textures without storage usage */
+    RemoveAllFromListIf(
+        resourceBindings,
+        [](const GLResourceBinding& binding)
+        {
+            return (binding.object == 0);
+        }
+    );
+
+    /* Build all resource segments for type <GLResourceViewHeapSegment2> with internal formats instead of texture targets */
+    BuildAllSegments(
+        resourceBindings,
+        std::bind(&GLResourceHeap::BuildImageSegment, this, std::placeholders::_1, std::placeholders::_2),
+        segmentationHeader_.numImageTextureSegments
+    );
+}
+
 void GLResourceHeap::BuildSamplerSegments(ResourceBindingIterator& resourceIterator)
 {
     /* Collect all samplers */
@@ -251,7 +515,7 @@ void GLResourceHeap::BuildSamplerSegments(ResourceBindingIterator& resourceItera
         [](Resource* resource, std::uint32_t slot) -> GLResourceBinding
         {
             auto samplerGL = LLGL_CAST(GLSampler*, resource);
-            return { slot, samplerGL->GetID(), GLTextureTarget::TEXTURE_1D };
+            return { slot, samplerGL->GetID(), GLTextureTarget::TEXTURE_1D, 0 };
         }
     );
 
@@ -351,6 +615,37 @@ void GLResourceHeap::BuildSegment2(GLResourceBindingIter it, GLsizei count)
         segmentIDs[i] = it->object;
 }
 
+void GLResourceHeap::BuildImageSegment(GLResourceBindingIter it, GLsizei count)
+{
+    std::size_t startOffset = buffer_.size();
+
+    /* Allocate space for segment */
+    const auto segmentOffsetEnd0    = sizeof(GLResourceViewHeapSegment2) + sizeof(GLenum) * count;
+    const auto segmentSize          = segmentOffsetEnd0 + sizeof(GLuint) * count;
+    buffer_.resize(startOffset + segmentSize);
+
+    /* Write segment header */
+    auto segment = reinterpret_cast<GLResourceViewHeapSegment2*>(&buffer_[startOffset]);
+    {
+        segment->segmentSize    = segmentSize;
+        segment->offsetEnd0     = segmentOffsetEnd0;
+        segment->first          = it->slot;
+        segment->count          = count;
+    }
+
+    /* Write first part of segment body (of type <GLenum>) */
+    auto segmentFormats = reinterpret_cast<GLenum*>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment2)]);
+    auto begin = it;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+        segmentFormats[i] = it->format;
+
+    /* Write second part of segment body (of type <GLuint>) */
+    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[startOffset + segmentOffsetEnd0]);
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+        segmentIDs[i] = it->object;
+}
+
 
 } // /namespace LLGL
 
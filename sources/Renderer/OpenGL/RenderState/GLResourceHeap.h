@@ -11,9 +11,12 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include "../OpenGL.h"
 #include <vector>
 #include <functional>
+#include <cstdint>
 
 
 namespace LLGL
@@ -34,19 +37,30 @@ class GLResourceHeap final : public ResourceHeap
     public:
 
         GLResourceHeap(const ResourceHeapDescriptor& desc);
+        ~GLResourceHeap();
 
-        // Binds this resource heap with the specified GL state manager.
-        void Bind(GLStateManager& stateMngr);
+        // Binds this resource heap with the specified GL state manager and the dynamic offsets for all uniform buffers with a dynamic offset.
+        void Bind(GLStateManager& stateMngr, std::uint32_t numDynamicOffsets = 0, const std::uint32_t* dynamicOffsets = nullptr);
+
+        // Replaces the specified resource views, starting at the view with index 'firstDescriptor', and rebuilds the binding segments.
+        void WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews);
 
     private:
 
         using GLResourceBindingIter = std::vector<GLResourceBinding>::const_iterator;
         using BuildSegmentFunc = std::function<void(GLResourceBindingIter begin, GLsizei count)>;
 
+        void BuildSegments();
+        void ReleaseBindlessBuffers();
+
         void BuildBufferSegments(ResourceBindingIterator& resourceIterator, const ResourceType resourceType, std::uint8_t& numSegments);
         void BuildConstantBufferSegments(ResourceBindingIterator& resourceIterator);
+        void BuildDynamicConstantBuffers(ResourceBindingIterator& resourceIterator);
         void BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator);
+        void BuildCounterBufferSegments(ResourceBindingIterator& resourceIterator);
+        void BuildBindlessTextureBuffers(ResourceBindingIterator& resourceIterator);
         void BuildTextureSegments(ResourceBindingIterator& resourceIterator);
+        void BuildImageTextureSegments(ResourceBindingIterator& resourceIterator);
         void BuildSamplerSegments(ResourceBindingIterator& resourceIterator);
 
         void BuildAllSegments(
@@ -57,18 +71,43 @@ class GLResourceHeap final : public ResourceHeap
 
         void BuildSegment1(GLResourceBindingIter it, GLsizei count);
         void BuildSegment2(GLResourceBindingIter it, GLsizei count);
+        void BuildImageSegment(GLResourceBindingIter it, GLsizei count);
 
         // Header structure to describe all segments within the raw buffer.
         struct SegmentationHeader
         {
             std::uint8_t numConstantBufferSegments  = 0;
             std::uint8_t numStorageBufferSegments   = 0;
+            std::uint8_t numCounterBufferSegments   = 0;
             std::uint8_t numTextureSegments         = 0;
+            std::uint8_t numImageTextureSegments    = 0;
             std::uint8_t numSamplerSegments         = 0;
         };
 
-        SegmentationHeader          segmentationHeader_;
-        std::vector<std::int8_t>    buffer_;
+        // Shader storage buffer with the 64-bit texture handles of a bindless texture binding (GL_ARB_bindless_texture).
+        struct GLBindlessBuffer
+        {
+            GLuint slot     = 0;
+            GLuint buffer   = 0;
+        };
+
+        // Uniform buffers that are bound with a dynamic offset, i.e. with 'glBindBuffersRange', sorted by binding slot.
+        struct GLDynamicBuffers
+        {
+            std::vector<GLuint>     slots;
+            std::vector<GLuint>     buffers;
+            std::vector<GLsizeiptr> sizes;
+            std::vector<GLintptr>   offsets;    // Dynamic offsets of the last bind call
+        };
+
+        SegmentationHeader                  segmentationHeader_;
+        std::vector<std::int8_t>            buffer_;
+        std::vector<GLBindlessBuffer>       bindlessBuffers_;
+        GLDynamicBuffers                    dynamicBuffers_;
+
+        // Resource views and bindings the segments are built from, so they can be rebuilt after in-place updates.
+        std::vector<ResourceViewDescriptor> resourceViews_;
+        std::vector<BindingDescriptor>      bindings_;
 
 };
 
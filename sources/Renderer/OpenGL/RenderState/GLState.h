@@ -59,6 +59,8 @@ enum class GLState
 enum class GLStateExt
 {
     CONSERVATIVE_RASTERIZATION = 0, // either NV or INTEL extension
+    SHADING_RATE_IMAGE,             // NV extension only
+    DEPTH_BOUNDS_TEST,              // EXT extension only
 };
 
 #endif
@@ -103,6 +105,16 @@ enum class GLTextureTarget
     TEXTURE_2D_MULTISAMPLE_ARRAY,
 };
 
+// Groups of fixed-function states that are applied together by a graphics pipeline (see GLGraphicsPipeline::Bind).
+enum class GLStateGroup
+{
+    DEPTH = 0,
+    STENCIL,
+    RASTERIZER,
+    BLEND,
+    LOGIC_OP,
+};
+
 
 /* ----- Structures ----- */
 
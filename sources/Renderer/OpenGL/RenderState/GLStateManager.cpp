@@ -11,6 +11,8 @@
 #include "../../GLCommon/GLTypes.h"
 #include "../../../Core/Helper.h"
 #include "../../../Core/Assertion.h"
+#include "../GLDrawBatch.h"
+#include <mutex>
 
 
 namespace LLGL
@@ -118,20 +120,55 @@ static void InvalidateBoundGLObject(GLuint& boundId, const GLuint releasedObject
         boundId = g_GLInvalidId;
 }
 
+/*
+Calls 'bindRange(first, count, offset)' for each maximal contiguous range of the binding points [first, first + count) that are not already bound,
+where 'offset' is the index of the range within the input arrays. 'isBound(index, offset)' must return false for binding points that are not tracked.
+This narrows a multi-bind call down to the minimal number of contiguous ranges of bindings that have changed.
+*/
+template <typename TIsBound, typename TBindRange>
+static void ForEachUnboundRange(GLuint first, GLsizei count, const TIsBound& isBound, const TBindRange& bindRange)
+{
+    for (GLsizei begin = 0; begin < count;)
+    {
+        /* Skip bindings that are already bound */
+        if (isBound(first + static_cast<GLuint>(begin), begin))
+        {
+            ++begin;
+            continue;
+        }
+
+        /* Find end of the range of changed bindings */
+        auto end = begin + 1;
+        while (end < count && !isBound(first + static_cast<GLuint>(end), end))
+            ++end;
+
+        bindRange(first + static_cast<GLuint>(begin), end - begin, begin);
+        begin = end;
+    }
+}
+
 
 /* ----- Common ----- */
 
 static std::vector<GLStateManager*> g_GLStateManagerList;
+static std::mutex                   g_GLStateManagerListMutex;  // State managers of worker contexts are created on other threads
 
-GLStateManager* GLStateManager::active = nullptr;
+thread_local GLStateManager* GLStateManager::active = nullptr;
 
 GLStateManager::GLStateManager()
 {
     /* Initialize all states with zero */
     Fill(renderState_.values, false);
     Fill(bufferState_.boundBuffers, 0);
+    for (auto& boundBufferBases : bufferState_.boundBufferBases)
+        Fill(boundBufferBases, 0);
+    for (auto& boundBufferOffsets : bufferState_.boundBufferOffsets)
+        Fill(boundBufferOffsets, 0);
+    for (auto& boundBufferSizes : bufferState_.boundBufferSizes)
+        Fill(boundBufferSizes, 0);
     Fill(framebufferState_.boundFramebuffers, 0);
     Fill(samplerState_.boundSamplers, 0);
+    Fill(imageState_.boundImageTextures, 0);
 
     for (auto& layer : textureState_.layers)
         Fill(layer.boundTextures, 0);
@@ -142,11 +179,13 @@ GLStateManager::GLStateManager()
     GLStateManager::active = this;
 
     /* Store state manager in global list */
+    std::lock_guard<std::mutex> guard { g_GLStateManagerListMutex };
     g_GLStateManagerList.push_back(this);
 }
 
 GLStateManager::~GLStateManager()
 {
+    std::lock_guard<std::mutex> guard { g_GLStateManagerListMutex };
     RemoveFromList(g_GLStateManagerList, this);
 }
 
@@ -401,7 +440,7 @@ void GLStateManager::SetScissorArray(GLuint first, GLsizei count, GLScissor* sci
         if (emulateClipControl_ && !apiDependentState_.originLowerLeft)
         {
             for (GLsizei i = 0; i < count; ++i)
-                AdjustScissor(scissors[0]);
+                AdjustScissor(scissors[i]);
         }
 
         glScissorArrayv(first, count, reinterpret_cast<const GLint*>(scissors));
@@ -485,6 +524,21 @@ void GLStateManager::SetDepthFunc(GLenum func)
     }
 }
 
+void GLStateManager::SetDepthBounds(GLfloat zmin, GLfloat zmax)
+{
+    #ifdef GL_EXT_depth_bounds_test
+    if (HasExtension(GLExt::EXT_depth_bounds_test))
+    {
+        if (commonState_.depthBounds[0] != zmin || commonState_.depthBounds[1] != zmax)
+        {
+            commonState_.depthBounds[0] = zmin;
+            commonState_.depthBounds[1] = zmax;
+            glDepthBoundsEXT(zmin, zmax);
+        }
+    }
+    #endif
+}
+
 void GLStateManager::SetStencilState(GLenum face, const GLStencil& state)
 {
     switch (face)
@@ -527,6 +581,16 @@ void GLStateManager::SetStencilState(GLenum face, GLStencil& to, const GLStencil
     }
 }
 
+void GLStateManager::SetStencilRef(GLint ref)
+{
+    auto front  = commonState_.stencil[0];
+    auto back   = commonState_.stencil[1];
+    front.ref   = ref;
+    back.ref    = ref;
+    SetStencilState(GL_FRONT, commonState_.stencil[0], front);
+    SetStencilState(GL_BACK, commonState_.stencil[1], back);
+}
+
 // <face> parameter must always be 'GL_FRONT_AND_BACK' since GL 3.2+
 void GLStateManager::SetPolygonMode(GLenum mode)
 {
@@ -542,7 +606,7 @@ void GLStateManager::SetPolygonOffset(GLfloat factor, GLfloat units, GLfloat cla
     #ifdef GL_ARB_polygon_offset_clamp
     if (HasExtension(GLExt::ARB_polygon_offset_clamp))
     {
-        if (commonState_.offsetFactor != factor || commonState_.offsetUnits != units)
+        if (commonState_.offsetFactor != factor || commonState_.offsetUnits != units || commonState_.offsetClamp != clamp)
         {
             commonState_.offsetFactor   = factor;
             commonState_.offsetUnits    = units;
@@ -667,37 +731,105 @@ void GLStateManager::BindBufferBase(GLBufferTarget target, GLuint index, GLuint
     auto targetIdx = static_cast<std::size_t>(target);
     glBindBufferBase(g_bufferTargetsEnum[targetIdx], index, buffer);
     bufferState_.boundBuffers[targetIdx] = buffer;
+    StoreBoundBufferBase(targetIdx, index, buffer, 0, 0);
 }
 
 void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers)
 {
-    /* Always bind buffers with a base index */
     auto targetIdx = static_cast<std::size_t>(target);
     auto targetGL = g_bufferTargetsEnum[targetIdx];
 
-    #ifdef GL_ARB_multi_bind
-    if (HasExtension(GLExt::ARB_multi_bind))
-    {
-        /*
-        Bind buffer array, but don't reset the currently bound buffer.
-        The spec. of GL_ARB_multi_bind says, that the generic binding point is not modified by this function!
-        */
-        glBindBuffersBase(targetGL, first, count, buffers);
-    }
-    else
-    #endif
-    if (count > 0)
-    {
-        /* Bind each individual buffer, and store last bound buffer */
-        bufferState_.boundBuffers[targetIdx] = buffers[count - 1];
+    /* Only bind the ranges of buffers that have changed (buffers that are bound with a range must be bound again) */
+    ForEachUnboundRange(
+        first,
+        count,
+        [&](GLuint index, GLsizei i)
+        {
+            return
+            (
+                index < numBufferBaseBindings                                   &&
+                bufferState_.boundBufferBases[targetIdx][index] == buffers[i]   &&
+                bufferState_.boundBufferSizes[targetIdx][index] == 0
+            );
+        },
+        [&](GLuint rangeFirst, GLsizei rangeCount, GLsizei i)
+        {
+            for (GLsizei j = 0; j < rangeCount; ++j)
+                StoreBoundBufferBase(targetIdx, rangeFirst + static_cast<GLuint>(j), buffers[i + j], 0, 0);
+
+            #ifdef GL_ARB_multi_bind
+            if (HasExtension(GLExt::ARB_multi_bind))
+            {
+                /*
+                Bind buffer array, but don't reset the currently bound buffer.
+                The spec. of GL_ARB_multi_bind says, that the generic binding point is not modified by this function!
+                */
+                glBindBuffersBase(targetGL, rangeFirst, rangeCount, &buffers[i]);
+            }
+            else
+            #endif
+            {
+                /* Bind each individual buffer, and store last bound buffer */
+                for (GLsizei j = 0; j < rangeCount; ++j)
+                    glBindBufferBase(targetGL, rangeFirst + static_cast<GLuint>(j), buffers[i + j]);
+                bufferState_.boundBuffers[targetIdx] = buffers[i + rangeCount - 1];
+            }
+        }
+    );
+}
+
+void GLStateManager::BindBufferRange(GLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    /* Only bind buffer range if it has changed */
+    auto targetIdx = static_cast<std::size_t>(target);
+    if (IsBufferRangeBound(targetIdx, index, buffer, offset, size))
+        return;
+
+    glBindBufferRange(g_bufferTargetsEnum[targetIdx], index, buffer, offset, size);
+    bufferState_.boundBuffers[targetIdx] = buffer;
+    StoreBoundBufferBase(targetIdx, index, buffer, offset, size);
+}
+
+void GLStateManager::BindBuffersRange(
+    GLBufferTarget      target,
+    GLuint              first,
+    GLsizei             count,
+    const GLuint*       buffers,
+    const GLintptr*     offsets,
+    const GLsizeiptr*   sizes)
+{
+    auto targetIdx = static_cast<std::size_t>(target);
+    auto targetGL = g_bufferTargetsEnum[targetIdx];
 
-        while (count-- > 0)
+    /* Only bind the buffer ranges that have changed */
+    ForEachUnboundRange(
+        first,
+        count,
+        [&](GLuint index, GLsizei i)
+        {
+            return IsBufferRangeBound(targetIdx, index, buffers[i], offsets[i], sizes[i]);
+        },
+        [&](GLuint rangeFirst, GLsizei rangeCount, GLsizei i)
         {
-            glBindBufferBase(targetGL, first, *buffers);
-            ++buffers;
-            ++first;
+            for (GLsizei j = 0; j < rangeCount; ++j)
+                StoreBoundBufferBase(targetIdx, rangeFirst + static_cast<GLuint>(j), buffers[i + j], offsets[i + j], sizes[i + j]);
+
+            #ifdef GL_ARB_multi_bind
+            if (HasExtension(GLExt::ARB_multi_bind))
+            {
+                /* Bind all buffer ranges at once (the generic binding point is not modified) */
+                glBindBuffersRange(targetGL, rangeFirst, rangeCount, &buffers[i], &offsets[i], &sizes[i]);
+            }
+            else
+            #endif
+            {
+                /* Bind each individual buffer range, and store last bound buffer */
+                for (GLsizei j = 0; j < rangeCount; ++j)
+                    glBindBufferRange(targetGL, rangeFirst + static_cast<GLuint>(j), buffers[i + j], offsets[i + j], sizes[i + j]);
+                bufferState_.boundBuffers[targetIdx] = buffers[i + rangeCount - 1];
+            }
         }
-    }
+    );
 }
 
 void GLStateManager::BindVertexArray(GLuint vertexArray)
@@ -726,6 +858,28 @@ void GLStateManager::BindVertexArray(GLuint vertexArray)
     }
 }
 
+void GLStateManager::BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    /* Vertex buffer bindings are part of the VAO state and don't modify the generic GL_ARRAY_BUFFER binding */
+    #ifdef GL_ARB_multi_bind
+    if (HasExtension(GLExt::ARB_multi_bind))
+    {
+        /* Bind all vertex buffers at once */
+        glBindVertexBuffers(first, count, buffers, offsets, strides);
+    }
+    else
+    #endif
+    {
+        /* Bind each vertex buffer individually */
+        for (GLsizei i = 0; i < count; ++i)
+            glBindVertexBuffer(first + static_cast<GLuint>(i), buffers[i], offsets[i], strides[i]);
+    }
+
+    #endif // /GL_ARB_vertex_attrib_binding
+}
+
 void GLStateManager::NotifyVertexArrayRelease(GLuint vertexArray)
 {
     InvalidateBoundGLObject(vertexArrayState_.boundVertexArray, vertexArray);
@@ -769,6 +923,37 @@ void GLStateManager::NotifyBufferRelease(GLuint buffer, GLBufferTarget target)
 {
     auto targetIdx = static_cast<std::size_t>(target);
     InvalidateBoundGLObject(bufferState_.boundBuffers[targetIdx], buffer);
+
+    /* Deleted buffers are unbound from all indexed binding points of any target */
+    for (auto& boundBufferBases : bufferState_.boundBufferBases)
+    {
+        for (auto& boundBuffer : boundBufferBases)
+            InvalidateBoundGLObject(boundBuffer, buffer);
+    }
+}
+
+void GLStateManager::BindTransformFeedback(GLuint transformFeedback)
+{
+    #ifdef GL_ARB_transform_feedback2
+    if (bufferState_.boundTransformFeedback != transformFeedback)
+    {
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, transformFeedback);
+        bufferState_.boundTransformFeedback = transformFeedback;
+
+        /* Indexed transform feedback buffer bindings belong to the transform feedback object, so they are unknown now */
+        InvalidateBufferBases(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER);
+    }
+    #endif
+}
+
+void GLStateManager::NotifyTransformFeedbackRelease(GLuint transformFeedback)
+{
+    /* Deleting the bound transform feedback object reverts the binding to the default object */
+    if (transformFeedback != 0 && bufferState_.boundTransformFeedback == transformFeedback)
+    {
+        bufferState_.boundTransformFeedback = 0;
+        InvalidateBufferBases(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER);
+    }
 }
 
 /* ----- Framebuffer ----- */
@@ -872,36 +1057,46 @@ void GLStateManager::BindTexture(GLTextureTarget target, GLuint texture)
 
 void GLStateManager::BindTextures(GLuint first, GLsizei count, const GLTextureTarget* targets, const GLuint* textures)
 {
-    #ifdef GL_ARB_multi_bind
-    if (HasExtension(GLExt::ARB_multi_bind))
-    {
-        /* Store bound textures */
-        for (GLsizei i = 0; i < count; ++i)
+    /* Only bind the ranges of texture layers that have changed */
+    ForEachUnboundRange(
+        first,
+        count,
+        [&](GLuint layer, GLsizei i)
         {
             auto targetIdx = static_cast<std::size_t>(targets[i]);
-            textureState_.layers[i].boundTextures[targetIdx] = textures[i];
-        }
-
-        /*
-        Bind all textures at once, but don't reset the currently active texture layer.
-        The spec. of GL_ARB_multi_bind states that the active texture slot is not modified by this function.
-        see https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_multi_bind.txt
-        */
-        glBindTextures(first, count, textures);
-    }
-    else
-    #endif
-    {
-        /* Bind each texture layer individually */
-        while (count-- > 0)
+            return (layer < numTextureLayers && textureState_.layers[layer].boundTextures[targetIdx] == textures[i]);
+        },
+        [&](GLuint rangeFirst, GLsizei rangeCount, GLsizei i)
         {
-            ActiveTexture(first);
-            BindTexture(*targets, *textures);
-            ++targets;
-            ++textures;
-            ++first;
+            #ifdef GL_ARB_multi_bind
+            if (HasExtension(GLExt::ARB_multi_bind))
+            {
+                /* Store bound textures */
+                for (GLsizei j = 0; j < rangeCount && rangeFirst + j < numTextureLayers; ++j)
+                {
+                    auto targetIdx = static_cast<std::size_t>(targets[i + j]);
+                    textureState_.layers[rangeFirst + j].boundTextures[targetIdx] = textures[i + j];
+                }
+
+                /*
+                Bind all textures at once, but don't reset the currently active texture layer.
+                The spec. of GL_ARB_multi_bind states that the active texture slot is not modified by this function.
+                see https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_multi_bind.txt
+                */
+                glBindTextures(rangeFirst, rangeCount, &textures[i]);
+            }
+            else
+            #endif
+            {
+                /* Bind each texture layer individually */
+                for (GLsizei j = 0; j < rangeCount; ++j)
+                {
+                    ActiveTexture(rangeFirst + static_cast<GLuint>(j));
+                    BindTexture(targets[i + j], textures[i + j]);
+                }
+            }
         }
-    }
+    );
 }
 
 void GLStateManager::PushBoundTexture(std::uint32_t layer, GLTextureTarget target)
@@ -944,6 +1139,54 @@ void GLStateManager::NotifyTextureRelease(GLuint texture, GLTextureTarget target
     auto targetIdx = static_cast<std::size_t>(target);
     for (auto& layer : textureState_.layers)
         InvalidateBoundGLObject(layer.boundTextures[targetIdx], texture);
+    for (auto& boundImageTexture : imageState_.boundImageTextures)
+        InvalidateBoundGLObject(boundImageTexture, texture);
+}
+
+/* ----- Image ----- */
+
+void GLStateManager::BindImageTextures(GLuint first, GLsizei count, const GLuint* textures, const GLenum* formats)
+{
+    /* Only bind the ranges of image units that have changed */
+    ForEachUnboundRange(
+        first,
+        count,
+        [&](GLuint unit, GLsizei i)
+        {
+            return (unit < numImageUnits && imageState_.boundImageTextures[unit] == textures[i]);
+        },
+        [&](GLuint rangeFirst, GLsizei rangeCount, GLsizei i)
+        {
+            for (GLsizei j = 0; j < rangeCount && rangeFirst + j < numImageUnits; ++j)
+                imageState_.boundImageTextures[rangeFirst + j] = textures[i + j];
+
+            #ifdef GL_ARB_multi_bind
+            if (HasExtension(GLExt::ARB_multi_bind))
+            {
+                /* Bind all images at once (MIP level 0, all layers, read/write access, and internal format of each texture) */
+                glBindImageTextures(rangeFirst, rangeCount, &textures[i]);
+            }
+            else
+            #endif
+            {
+                #ifdef GL_ARB_shader_image_load_store
+                /* Bind each image individually with the same parameters as glBindImageTextures (format must be valid even to unbind an image) */
+                for (GLsizei j = 0; j < rangeCount; ++j)
+                {
+                    glBindImageTexture(
+                        rangeFirst + static_cast<GLuint>(j),
+                        textures[i + j],
+                        0,
+                        GL_TRUE,
+                        0,
+                        GL_READ_WRITE,
+                        (formats[i + j] != 0 ? formats[i + j] : GL_R8)
+                    );
+                }
+                #endif // /GL_ARB_shader_image_load_store
+            }
+        }
+    );
 }
 
 /* ----- Sampler ----- */
@@ -963,23 +1206,34 @@ void GLStateManager::BindSampler(GLuint layer, GLuint sampler)
 
 void GLStateManager::BindSamplers(GLuint first, GLsizei count, const GLuint* samplers)
 {
-    #ifdef GL_ARB_multi_bind
-    if (count >= 2 && HasExtension(GLExt::ARB_multi_bind))
-    {
-        /* Bind all samplers at once */
-        glBindSamplers(first, count, samplers);
-
-        /* Store bound samplers */
-        for (GLsizei i = 0; i < count; ++i)
-            samplerState_.boundSamplers[i] = samplers[i];
-    }
-    else
-    #endif
-    {
-        /* Bind each sampler individually */
-        for (GLsizei i = 0; i < count; ++i)
-            BindSampler(first + static_cast<GLuint>(i), samplers[i]);
-    }
+    /* Only bind the ranges of samplers that have changed */
+    ForEachUnboundRange(
+        first,
+        count,
+        [&](GLuint layer, GLsizei i)
+        {
+            return (layer < numTextureLayers && samplerState_.boundSamplers[layer] == samplers[i]);
+        },
+        [&](GLuint rangeFirst, GLsizei rangeCount, GLsizei i)
+        {
+            for (GLsizei j = 0; j < rangeCount && rangeFirst + j < numTextureLayers; ++j)
+                samplerState_.boundSamplers[rangeFirst + j] = samplers[i + j];
+
+            #ifdef GL_ARB_multi_bind
+            if (rangeCount >= 2 && HasExtension(GLExt::ARB_multi_bind))
+            {
+                /* Bind the range of samplers at once */
+                glBindSamplers(rangeFirst, rangeCount, &samplers[i]);
+            }
+            else
+            #endif
+            {
+                /* Bind each sampler individually */
+                for (GLsizei j = 0; j < rangeCount; ++j)
+                    glBindSampler(rangeFirst + static_cast<GLuint>(j), samplers[i + j]);
+            }
+        }
+    );
 }
 
 void GLStateManager::NotifySamplerRelease(GLuint sampler)
@@ -1015,6 +1269,17 @@ void GLStateManager::NotifyShaderProgramRelease(GLuint program)
     InvalidateBoundGLObject(shaderState_.boundProgram, program);
 }
 
+/* ----- Draw batch ----- */
+
+void GLStateManager::SetPendingDrawBatch(GLDrawBatch* drawBatch)
+{
+    if (pendingDrawBatch_ != drawBatch)
+    {
+        FlushPendingDrawBatch();
+        pendingDrawBatch_ = drawBatch;
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -1036,6 +1301,35 @@ void GLStateManager::SetActiveTextureLayer(std::uint32_t layer)
     activeTextureLayer_ = &(textureState_.layers[textureState_.activeTexture]);
 }
 
+bool GLStateManager::IsBufferRangeBound(std::size_t targetIdx, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) const
+{
+    return
+    (
+        index < numBufferBaseBindings                                   &&
+        bufferState_.boundBufferBases[targetIdx][index]     == buffer   &&
+        bufferState_.boundBufferOffsets[targetIdx][index]   == offset   &&
+        bufferState_.boundBufferSizes[targetIdx][index]     == size
+    );
+}
+
+void GLStateManager::InvalidateBufferBases(GLBufferTarget target)
+{
+    const auto targetIdx = static_cast<std::size_t>(target);
+    Fill(bufferState_.boundBufferBases[targetIdx], 0);
+    Fill(bufferState_.boundBufferOffsets[targetIdx], 0);
+    Fill(bufferState_.boundBufferSizes[targetIdx], 0);
+}
+
+void GLStateManager::StoreBoundBufferBase(std::size_t targetIdx, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    if (index < numBufferBaseBindings)
+    {
+        bufferState_.boundBufferBases[targetIdx][index]     = buffer;
+        bufferState_.boundBufferOffsets[targetIdx][index]   = offset;
+        bufferState_.boundBufferSizes[targetIdx][index]     = size;
+    }
+}
+
 void GLStateManager::DetermineLimits()
 {
     glGetIntegerv(GL_MAX_VIEWPORTS, &limits_.maxViewports);
@@ -1051,11 +1345,19 @@ void GLStateManager::DetermineLimits()
     limits_.lineWidthRange[1] = std::min(aliasedLineRange[1], smoothLineRange[1]);
 }
 
+void GLStateManager::SubmitPendingDrawBatch()
+{
+    /* Reset pending draw batch first, since submitting it modifies the GL state again */
+    auto drawBatch = pendingDrawBatch_;
+    pendingDrawBatch_ = nullptr;
+    drawBatch->Submit();
+}
+
 #ifdef LLGL_GL_ENABLE_VENDOR_EXT
 
 void GLStateManager::DetermineVendorSpecificExtensions()
 {
-    #if defined GL_NV_conservative_raster || defined GL_INTEL_conservative_rasterization
+    #if defined GL_NV_conservative_raster || defined GL_INTEL_conservative_rasterization || defined GL_NV_shading_rate_image || defined GL_EXT_depth_bounds_test
 
     /* Initialize extenstion states */
     auto InitStateExt = [&](GLStateExt state, const GLExt extension, GLenum cap)
@@ -1079,6 +1381,16 @@ void GLStateManager::DetermineVendorSpecificExtensions()
     InitStateExt(GLStateExt::CONSERVATIVE_RASTERIZATION, GLExt::INTEL_conservative_rasterization, GL_CONSERVATIVE_RASTERIZATION_INTEL);
     #endif
 
+    #ifdef GL_NV_shading_rate_image
+    // see https://www.khronos.org/registry/OpenGL/extensions/NV/NV_shading_rate_image.txt
+    InitStateExt(GLStateExt::SHADING_RATE_IMAGE, GLExt::NV_shading_rate_image, GL_SHADING_RATE_IMAGE_NV);
+    #endif
+
+    #ifdef GL_EXT_depth_bounds_test
+    // see https://www.khronos.org/registry/OpenGL/extensions/EXT/EXT_depth_bounds_test.txt
+    InitStateExt(GLStateExt::DEPTH_BOUNDS_TEST, GLExt::EXT_depth_bounds_test, GL_DEPTH_BOUNDS_TEST_EXT);
+    #endif
+
     #endif
 }
 
@@ -23,6 +23,8 @@ namespace LLGL
 {
 
 
+class GLDrawBatch;
+
 // OpenGL state machine manager that tries to reduce GL state changes.
 class GLStateManager
 {
@@ -34,8 +36,8 @@ class GLStateManager
         GLStateManager();
         ~GLStateManager();
 
-        // Active state manager. Each GL context has its own states, thus its own state manager.
-        static GLStateManager* active;
+        // Active state manager of the calling thread. Each GL context has its own states, thus its own state manager.
+        static thread_local GLStateManager* active;
 
         // Queries all supported and available GL extensions and limitations, then stores it internally (must be called once a GL context has been created).
         void DetermineExtensionsAndLimits();
@@ -87,7 +89,20 @@ class GLStateManager
 
         void SetClipControl(GLenum origin, GLenum depth);
         void SetDepthFunc(GLenum func);
+
+        // Sets the range of the depth bounds test (GL_EXT_depth_bounds_test).
+        void SetDepthBounds(GLfloat zmin, GLfloat zmax);
+
         void SetStencilState(GLenum face, const GLStencil& state);
+
+        // Sets the stencil reference value of both faces and keeps the remaining stencil states.
+        void SetStencilRef(GLint ref);
+
+        // Returns the stencil reference value of the front face.
+        inline GLint GetStencilRef() const
+        {
+            return commonState_.stencil[0].ref;
+        }
         void SetPolygonMode(GLenum mode);
         void SetPolygonOffset(GLfloat factor, GLfloat units, GLfloat clamp);
         void SetCullFace(GLenum face);
@@ -105,9 +120,14 @@ class GLStateManager
         void BindBuffer(GLBufferTarget target, GLuint buffer);
         void BindBufferBase(GLBufferTarget target, GLuint index, GLuint buffer);
         void BindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers);
+        void BindBufferRange(GLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+        void BindBuffersRange(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes);
 
         void BindVertexArray(GLuint vertexArray);
 
+        // Binds the specified vertex buffers to the binding points of the currently bound VAO (GL_ARB_vertex_attrib_binding).
+        void BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides);
+
         void NotifyVertexArrayRelease(GLuint vertexArray);
 
         /**
@@ -123,6 +143,11 @@ class GLStateManager
 
         void NotifyBufferRelease(GLuint buffer, GLBufferTarget target);
 
+        // Binds the specified transform feedback object (GL_ARB_transform_feedback2). The indexed GL_TRANSFORM_FEEDBACK_BUFFER bindings are part of its state.
+        void BindTransformFeedback(GLuint transformFeedback);
+
+        void NotifyTransformFeedbackRelease(GLuint transformFeedback);
+
         /* ----- Framebuffer ----- */
 
         void BindFramebuffer(GLFramebufferTarget target, GLuint framebuffer);
@@ -155,6 +180,11 @@ class GLStateManager
 
         void NotifyTextureRelease(GLuint texture, GLTextureTarget target);
 
+        /* ----- Image ----- */
+
+        // Binds the entire MIP level 0 of the specified textures (with all layers) with read/write access to the image units [first, first + count).
+        void BindImageTextures(GLuint first, GLsizei count, const GLuint* textures, const GLenum* formats);
+
         /* ----- Sampler ----- */
 
         void BindSampler(GLuint layer, GLuint sampler);
@@ -171,6 +201,38 @@ class GLStateManager
 
         void NotifyShaderProgramRelease(GLuint program);
 
+        /* ----- Draw batch ----- */
+
+        // Sets the draw batch whose draw commands are pending. The previous pending draw batch is submitted if it differs from the new one.
+        void SetPendingDrawBatch(GLDrawBatch* drawBatch);
+
+        // Submits the pending draw batch. This must be called before any GL state is modified or any GL command is issued outside of the pending draw batch.
+        inline void FlushPendingDrawBatch()
+        {
+            if (pendingDrawBatch_ != nullptr)
+                SubmitPendingDrawBatch();
+        }
+
+        /* ----- State groups ----- */
+
+        // Stores the ID of the specified state group, and returns true if it differs from the previous ID, i.e. if the states of this group must be applied.
+        inline bool SetStateGroup(GLStateGroup group, std::uint32_t id)
+        {
+            auto& boundID = stateGroupIDs_[static_cast<std::size_t>(group)];
+            if (boundID != id)
+            {
+                boundID = id;
+                return true;
+            }
+            return false;
+        }
+
+        // Invalidates the specified state group, so it is applied by the next graphics pipeline. This must be called when a state of this group is modified outside of a graphics pipeline.
+        inline void InvalidateStateGroup(GLStateGroup group)
+        {
+            stateGroupIDs_[static_cast<std::size_t>(group)] = 0;
+        }
+
     private:
 
         /* ----- Functions ----- */
@@ -185,8 +247,16 @@ class GLStateManager
 
         void SetActiveTextureLayer(std::uint32_t layer);
 
+        bool IsBufferRangeBound(std::size_t targetIdx, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) const;
+        void StoreBoundBufferBase(std::size_t targetIdx, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        // Resets the cached indexed bindings of the specified buffer target, so the next bind calls are not skipped.
+        void InvalidateBufferBases(GLBufferTarget target);
+
         void DetermineLimits();
 
+        void SubmitPendingDrawBatch();
+
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
         void DetermineVendorSpecificExtensions();
         #endif
@@ -194,13 +264,16 @@ class GLStateManager
         /* ----- Constants ----- */
 
         static const std::uint32_t numTextureLayers         = 32;
+        static const std::uint32_t numBufferBaseBindings    = 32;
+        static const std::uint32_t numImageUnits            = 8;
         static const std::uint32_t numStates                = (static_cast<std::uint32_t>(GLState::PROGRAM_POINT_SIZE) + 1);
         static const std::uint32_t numBufferTargets         = (static_cast<std::uint32_t>(GLBufferTarget::UNIFORM_BUFFER) + 1);
         static const std::uint32_t numFramebufferTargets    = (static_cast<std::uint32_t>(GLFramebufferTarget::READ_FRAMEBUFFER) + 1);
         static const std::uint32_t numTextureTargets        = (static_cast<std::uint32_t>(GLTextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY) + 1);
+        static const std::uint32_t numStateGroups           = (static_cast<std::uint32_t>(GLStateGroup::LOGIC_OP) + 1);
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
-        static const std::uint32_t numStatesExt             = (static_cast<std::uint32_t>(GLStateExt::CONSERVATIVE_RASTERIZATION) + 1);
+        static const std::uint32_t numStatesExt             = (static_cast<std::uint32_t>(GLStateExt::DEPTH_BOUNDS_TEST) + 1);
         #endif
 
         /* ----- Structures ----- */
@@ -216,6 +289,7 @@ class GLStateManager
         struct GLCommonState
         {
             GLenum      depthFunc       = GL_LESS;
+            GLfloat     depthBounds[2]  = { 0.0f, 1.0f };
             GLStencil   stencil[2];
             GLenum      polygonMode     = GL_FILL;
             GLfloat     offsetFactor    = 0.0f;
@@ -268,6 +342,13 @@ class GLStateManager
 
             std::array<GLuint, numBufferTargets>    boundBuffers;
             std::stack<StackEntry>                  boundBufferStack;
+
+            // Buffers bound to the indexed binding points of each target, and their ranges (zero size for entire buffers)
+            std::array<std::array<GLuint, numBufferBaseBindings>, numBufferTargets>     boundBufferBases;
+            std::array<std::array<GLintptr, numBufferBaseBindings>, numBufferTargets>   boundBufferOffsets;
+            std::array<std::array<GLsizeiptr, numBufferBaseBindings>, numBufferTargets> boundBufferSizes;
+
+            GLuint                                  boundTransformFeedback = 0;
         };
 
         struct GLFramebufferState
@@ -323,6 +404,11 @@ class GLStateManager
             std::array<GLuint, numTextureLayers> boundSamplers;
         };
 
+        struct GLImageState
+        {
+            std::array<GLuint, numImageUnits> boundImageTextures;
+        };
+
         /* ----- Members ----- */
 
         GLLimits                        limits_;
@@ -338,6 +424,7 @@ class GLStateManager
         GLVertexArrayState              vertexArrayState_;
         GLShaderState                   shaderState_;
         GLSamplerState                  samplerState_;
+        GLImageState                    imageState_;
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
         GLRenderStateExt                renderStateExt_;
@@ -348,6 +435,10 @@ class GLStateManager
         bool                            emulateClipControl_ = false;
         GLint                           renderTargetHeight_ = 0;
 
+        GLDrawBatch*                    pendingDrawBatch_   = nullptr;
+
+        std::array<std::uint32_t, numStateGroups> stateGroupIDs_ = {};   // IDs of the bound state groups (zero if invalid), see GLGraphicsPipeline::Bind
+
 };
 
 
@@ -0,0 +1,148 @@
+/*
+ * GLProgramCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLProgramCache.h"
+#include "../Ext/GLExtensions.h"
+#include "../../../Core/Helper.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Header of each program cache entry, followed by the program binary.
+struct GLProgramCacheHeader
+{
+    char            magic[4];       // "LLPC"
+    std::uint32_t   version;        // Cache format version, see 'g_programCacheVersion'
+    std::uint64_t   key;            // Hash of the program key and driver strings
+    std::uint32_t   binaryFormat;   // Binary format returned by glGetProgramBinary
+    std::uint32_t   size;           // Size of the program binary (in bytes)
+};
+
+static const char           g_programCacheMagic[4]  = { 'L', 'L', 'P', 'C' };
+static const std::uint32_t  g_programCacheVersion   = 1;
+
+
+/*
+ * GLProgramCache class
+ */
+
+GLProgramCache::GLProgramCache(const std::string& cacheDirectory, const RendererInfo& rendererInfo) :
+    directory_  { cacheDirectory    },
+    driverHash_ { g_hashOffsetBasis }
+{
+    /* Append path separator */
+    if (!directory_.empty() && directory_.back() != '/' && directory_.back() != '\\')
+        directory_ += '/';
+
+    /* Hash driver strings, so entries are invalidated when the driver is updated */
+    AccumulateHash(driverHash_, rendererInfo.rendererName.c_str());
+    AccumulateHash(driverHash_, rendererInfo.deviceName.c_str());
+    AccumulateHash(driverHash_, rendererInfo.vendorName.c_str());
+    AccumulateHash(driverHash_, rendererInfo.shadingLanguageName.c_str());
+}
+
+bool GLProgramCache::Load(GLuint program, std::uint64_t key) const
+{
+    #ifdef GL_ARB_get_program_binary
+
+    std::ifstream file { GetFilename(key), std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Read and validate header */
+    GLProgramCacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_programCacheMagic, sizeof(g_programCacheMagic)) != 0 ||
+        header.version != g_programCacheVersion ||
+        header.key != (key ^ driverHash_) ||
+        header.size == 0)
+    {
+        return false;
+    }
+
+    /* Read program binary; a truncated entry is treated as a cache miss */
+    std::vector<char> binary(header.size);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+        return false;
+
+    /* Load program binary, which can still be rejected by the driver */
+    glProgramBinary(program, static_cast<GLenum>(header.binaryFormat), binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    return (status != GL_FALSE);
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_get_program_binary
+}
+
+void GLProgramCache::Store(GLuint program, std::uint64_t key) const
+{
+    #ifdef GL_ARB_get_program_binary
+
+    /* Retrieve program binary */
+    GLint binaryLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    std::vector<char> binary(static_cast<std::size_t>(binaryLength));
+    GLsizei binarySize      = 0;
+    GLenum  binaryFormat    = 0;
+    glGetProgramBinary(program, binaryLength, &binarySize, &binaryFormat, binary.data());
+    if (binarySize <= 0)
+        return;
+
+    /* Write header and program binary */
+    std::ofstream file { GetFilename(key), (std::ios_base::binary | std::ios_base::trunc) };
+    if (!file.good())
+        return;
+
+    GLProgramCacheHeader header;
+    {
+        std::memcpy(header.magic, g_programCacheMagic, sizeof(g_programCacheMagic));
+        header.version      = g_programCacheVersion;
+        header.key          = (key ^ driverHash_);
+        header.binaryFormat = static_cast<std::uint32_t>(binaryFormat);
+        header.size         = static_cast<std::uint32_t>(binarySize);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), static_cast<std::streamsize>(binarySize));
+
+    #endif // /GL_ARB_get_program_binary
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::string GLProgramCache::GetFilename(std::uint64_t key) const
+{
+    return directory_ + ToHex(key ^ driverHash_) + ".glbin";
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,57 @@
+/*
+ * GLProgramCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PROGRAM_CACHE_H
+#define LLGL_GL_PROGRAM_CACHE_H
+
+
+#include <LLGL/RenderSystemFlags.h>
+#include "../OpenGL.h"
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+On-disk cache for linked GL shader program binaries (requires GL_ARB_get_program_binary).
+Each cache entry is a single file whose name is a hash of the program key and the driver strings,
+since program binaries are only valid for the exact driver they were retrieved from.
+*/
+class GLProgramCache
+{
+
+    public:
+
+        GLProgramCache(const std::string& cacheDirectory, const RendererInfo& rendererInfo);
+
+        // Loads the program binary of the specified key into the program object. Returns true if the program has been linked successfully.
+        bool Load(GLuint program, std::uint64_t key) const;
+
+        // Stores the binary of the specified linked program object. Failures are ignored, since the cache is optional.
+        void Store(GLuint program, std::uint64_t key) const;
+
+    private:
+
+        std::string GetFilename(std::uint64_t key) const;
+
+        std::string     directory_;
+        std::uint64_t   driverHash_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include "../../GLCommon/GLTypes.h"
+#include "../../ShaderSpecialization.h"
 #include "../../../Core/Helper.h"
 #include "../../../Core/Exception.h"
 #include <vector>
@@ -20,11 +21,14 @@ namespace LLGL
 {
 
 
-GLShader::GLShader(const ShaderDescriptor& desc) :
+GLShader::GLShader(const ShaderDescriptor& desc, bool deferCompilation) :
     Shader { desc.type }
 {
     id_ = glCreateShader(GLTypes::Map(desc.type));
     Build(desc);
+
+    if (!deferCompilation)
+        FlushCompilation();
 }
 
 GLShader::~GLShader()
@@ -34,6 +38,8 @@ GLShader::~GLShader()
 
 bool GLShader::HasErrors() const
 {
+    FlushCompilation();
+
     GLint status = 0;
     glGetShaderiv(id_, GL_COMPILE_STATUS, &status);
     return (status == GL_FALSE);
@@ -46,6 +52,8 @@ std::string GLShader::Disassemble(int flags)
 
 std::string GLShader::QueryInfoLog()
 {
+    FlushCompilation();
+
     /* Query info log length */
     GLint infoLogLength = 0;
     glGetShaderiv(id_, GL_INFO_LOG_LENGTH, &infoLogLength);
@@ -67,6 +75,15 @@ std::string GLShader::QueryInfoLog()
     return "";
 }
 
+void GLShader::FlushCompilation() const
+{
+    if (compilePending_)
+    {
+        glCompileShader(id_);
+        compilePending_ = false;
+    }
+}
+
 
 /*
  * ======= Protected: =======
@@ -87,8 +104,51 @@ bool GLShader::MoveStreamOutputFormat(StreamOutputFormat& streamOutputFormat)
  * ======= Private: =======
  */
 
+// Inserts the macro definitions of all named specialization constants after the '#version' directive (or at the beginning if there is no such directive).
+static void InsertSpecializationConstantMacros(std::string& source, const std::vector<ShaderSpecializationConstant>& constants)
+{
+    std::string macros;
+
+    for (const auto& constant : constants)
+    {
+        if (constant.name != nullptr)
+        {
+            macros += "#define ";
+            macros += constant.name;
+            macros += ' ';
+            macros += GetSpecializationConstantLiteral(constant);
+            macros += '\n';
+        }
+    }
+
+    if (macros.empty())
+        return;
+
+    /* The '#version' directive must be the first statement, so insert the macros at the beginning of the next line */
+    std::size_t pos = 0;
+    const auto versionPos = source.find("#version");
+    if (versionPos != std::string::npos)
+    {
+        pos = source.find('\n', versionPos);
+        if (pos == std::string::npos)
+        {
+            source += '\n';
+            pos = source.size();
+        }
+        else
+            ++pos;
+    }
+
+    source.insert(pos, macros);
+}
+
 void GLShader::Build(const ShaderDescriptor& shaderDesc)
 {
+    /* Initialize hash with shader type */
+    hash_ = g_hashOffsetBasis;
+    const auto type = static_cast<std::uint32_t>(shaderDesc.type);
+    AccumulateHash(hash_, &type, sizeof(type));
+
     if (IsShaderSourceCode(shaderDesc.sourceType))
         CompileSource(shaderDesc);
     else
@@ -106,14 +166,27 @@ void GLShader::CompileSource(const ShaderDescriptor& shaderDesc)
         fileContent = ReadFileString(shaderDesc.source);
         strings[0]  = fileContent.c_str();
     }
+    else if (!shaderDesc.specializationConstants.empty())
+    {
+        /* Copy source code to inject the specialization constants */
+        fileContent = (shaderDesc.sourceSize > 0 ? std::string(shaderDesc.source, shaderDesc.sourceSize) : std::string(shaderDesc.source));
+    }
     else
     {
         strings[0] = shaderDesc.source;
     }
 
-    /* Load shader source code, then compile shader */
+    if (!shaderDesc.specializationConstants.empty())
+    {
+        InsertSpecializationConstantMacros(fileContent, shaderDesc.specializationConstants);
+        strings[0] = fileContent.c_str();
+    }
+
+    /* Load shader source code, and mark shader to be compiled */
     glShaderSource(id_, 1, strings, nullptr);
-    glCompileShader(id_);
+    compilePending_ = true;
+
+    AccumulateHash(hash_, strings[0]);
 
     /* Store stream-output format */
     streamOutputFormat_ = shaderDesc.streamOutput.format;
@@ -148,7 +221,22 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
 
         /* Specialize for the default "main" function in a SPIR-V module  */
         const char* entryPoint = (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0' ? "main" : shaderDesc.entryPoint);
-        glSpecializeShader(id_, entryPoint, 0, nullptr, nullptr);
+
+        const auto numConstants = shaderDesc.specializationConstants.size();
+        std::vector<GLuint> constantIndices(numConstants), constantValues(numConstants);
+
+        for (std::size_t i = 0; i < numConstants; ++i)
+        {
+            constantIndices[i]  = shaderDesc.specializationConstants[i].id;
+            constantValues[i]   = shaderDesc.specializationConstants[i].value;
+        }
+
+        glSpecializeShader(id_, entryPoint, static_cast<GLuint>(numConstants), constantIndices.data(), constantValues.data());
+
+        AccumulateHash(hash_, binaryBuffer, static_cast<std::size_t>(binaryLength));
+        AccumulateHash(hash_, entryPoint);
+        AccumulateHash(hash_, constantIndices.data(), numConstants * sizeof(GLuint));
+        AccumulateHash(hash_, constantValues.data(), numConstants * sizeof(GLuint));
 
         /* Store stream-output format */
         streamOutputFormat_ = shaderDesc.streamOutput.format;
@@ -11,6 +11,7 @@
 
 #include <LLGL/Shader.h>
 #include "../OpenGL.h"
+#include <cstdint>
 
 
 namespace LLGL
@@ -22,7 +23,12 @@ class GLShader final : public Shader
 
     public:
 
-        GLShader(const ShaderDescriptor& desc);
+        /*
+        Creates the shader object and loads its source or binary code.
+        If 'deferCompilation' is true, the source code is not compiled until it is required,
+        so a shader program that is restored from the program binary cache never compiles its shaders.
+        */
+        GLShader(const ShaderDescriptor& desc, bool deferCompilation = false);
         ~GLShader();
 
         bool HasErrors() const override;
@@ -37,6 +43,15 @@ class GLShader final : public Shader
             return id_;
         }
 
+        // Compiles the shader source if its compilation has been deferred.
+        void FlushCompilation() const;
+
+        // Returns the hash of the shader type and its source or binary code, used as key for the program binary cache.
+        inline std::uint64_t GetHash() const
+        {
+            return hash_;
+        }
+
     protected:
 
         friend class GLShaderProgram;
@@ -49,9 +64,12 @@ class GLShader final : public Shader
         void CompileSource(const ShaderDescriptor& shaderDesc);
         void LoadBinary(const ShaderDescriptor& shaderDesc);
 
-        GLuint              id_ = 0;
+        GLuint              id_                 = 0;
         StreamOutputFormat  streamOutputFormat_;
 
+        std::uint64_t       hash_               = 0;
+        mutable bool        compilePending_     = false;
+
 };
 
 
@@ -7,10 +7,12 @@
 
 #include "GLShaderProgram.h"
 #include "GLShader.h"
+#include "GLProgramCache.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Exception.h"
+#include "../../../Core/Helper.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../GLCommon/GLTypes.h"
 #include <LLGL/VertexFormat.h>
@@ -23,7 +25,7 @@ namespace LLGL
 {
 
 
-GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
+GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache) :
     id_      { glCreateProgram() },
     uniform_ { id_               }
 {
@@ -33,8 +35,10 @@ GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
     Attach(desc.geometryShader);
     Attach(desc.fragmentShader);
     Attach(desc.computeShader);
+    Attach(desc.amplificationShader);
+    Attach(desc.meshShader);
     BuildInputLayout(desc.vertexFormats.size(), desc.vertexFormats.data());
-    Link();
+    Link(desc, programCache);
 }
 
 GLShaderProgram::~GLShaderProgram()
@@ -73,6 +77,20 @@ std::string GLShaderProgram::QueryInfoLog()
     return "";
 }
 
+bool GLShaderProgram::IsReady() const
+{
+    #ifdef GL_KHR_parallel_shader_compile
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+    {
+        /* Query completion status without blocking, link status would wait for the driver's compiler threads */
+        GLint status = 0;
+        glGetProgramiv(id_, GL_COMPLETION_STATUS_KHR, &status);
+        return (status != GL_FALSE);
+    }
+    #endif // /GL_KHR_parallel_shader_compile
+    return true;
+}
+
 ShaderReflectionDescriptor GLShaderProgram::QueryReflectionDesc() const
 {
     ShaderReflectionDescriptor reflection;
@@ -99,6 +117,10 @@ void GLShaderProgram::BindConstantBuffer(const std::string& name, std::uint32_t
 void GLShaderProgram::BindStorageBuffer(const std::string& name, std::uint32_t bindingIndex)
 {
     #ifndef __APPLE__
+    /* Storage block indices can only be queried with program interface queries, whose entry points are loaded on first use */
+    if (!HasExtension(GLExt::ARB_program_interface_query))
+        throw std::runtime_error("failed to bind storage buffer, because GL_ARB_program_interface_query is not supported");
+
     /* Query shader storage block index and bind it to the specified binding index */
     auto blockIndex = glGetProgramResourceIndex(id_, GL_SHADER_STORAGE_BLOCK, name.c_str());
     if (blockIndex != GL_INVALID_INDEX)
@@ -112,14 +134,19 @@ void GLShaderProgram::BindStorageBuffer(const std::string& name, std::uint32_t b
 
 ShaderUniform* GLShaderProgram::LockShaderUniform()
 {
-    GLStateManager::active->PushShaderProgram();
-    GLStateManager::active->BindShaderProgram(id_);
+    /* Only bind shader program if uniforms cannot be set directly */
+    if (!uniform_.HasDirectAccess())
+    {
+        GLStateManager::active->PushShaderProgram();
+        GLStateManager::active->BindShaderProgram(id_);
+    }
     return (&uniform_);
 }
 
 void GLShaderProgram::UnlockShaderUniform()
 {
-    GLStateManager::active->PopShaderProgram();
+    if (!uniform_.HasDirectAccess())
+        GLStateManager::active->PopShaderProgram();
 }
 
 
@@ -187,8 +214,10 @@ void GLShaderProgram::BuildInputLayout(std::size_t numVertexFormats, const Verte
     }
 }
 
-void GLShaderProgram::Link()
+void GLShaderProgram::Link(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache)
 {
+    const auto cacheKey = (programCache != nullptr ? GetCacheKey(desc) : 0);
+
     /* Check if transform-feedback varyings must be specified (before or after shader linking) */
     if (!streamOutputFormat_.attributes.empty())
     {
@@ -198,7 +227,7 @@ void GLShaderProgram::Link()
         #endif
         {
             BuildTransformFeedbackVaryingsEXT(streamOutputFormat_.attributes);
-            glLinkProgram(id_);
+            LinkProgram(desc, programCache, cacheKey);
             return;
         }
 
@@ -206,7 +235,7 @@ void GLShaderProgram::Link()
         /* For GL_NV_transform_feedback (Vendor specific) the varyings must be specified AFTER linking */
         if (HasExtension(GLExt::NV_transform_feedback))
         {
-            glLinkProgram(id_);
+            LinkProgram(desc, programCache, cacheKey);
             BuildTransformFeedbackVaryingsNV(streamOutputFormat_.attributes);
             return;
         }
@@ -214,9 +243,92 @@ void GLShaderProgram::Link()
     }
 
     /* Just link shader program */
+    LinkProgram(desc, programCache, cacheKey);
+}
+
+// Compiles the specified shader if its compilation has been deferred.
+static void FlushShaderCompilation(Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderGL = LLGL_CAST(GLShader*, shader);
+        shaderGL->FlushCompilation();
+    }
+}
+
+void GLShaderProgram::LinkProgram(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache, std::uint64_t cacheKey)
+{
+    /* Try to restore program binary from cache, which makes compilation of the deferred shaders obsolete */
+    if (programCache != nullptr && programCache->Load(id_, cacheKey))
+        return;
+
+    /* Compile all shaders whose compilation has been deferred */
+    FlushShaderCompilation(desc.vertexShader);
+    FlushShaderCompilation(desc.tessControlShader);
+    FlushShaderCompilation(desc.tessEvaluationShader);
+    FlushShaderCompilation(desc.geometryShader);
+    FlushShaderCompilation(desc.fragmentShader);
+    FlushShaderCompilation(desc.computeShader);
+    FlushShaderCompilation(desc.amplificationShader);
+    FlushShaderCompilation(desc.meshShader);
+
+    #ifdef GL_ARB_get_program_binary
+    if (programCache != nullptr)
+    {
+        /* Link program with retrievable binary and store it in the cache */
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(id_);
+        if (!HasErrors())
+            programCache->Store(id_, cacheKey);
+        return;
+    }
+    #endif // /GL_ARB_get_program_binary
+
     glLinkProgram(id_);
 }
 
+// Accumulates the hash of the specified shader if it is not null.
+static void AccumulateShaderHash(std::uint64_t& hash, Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderGL = LLGL_CAST(GLShader*, shader);
+        const auto shaderHash = shaderGL->GetHash();
+        AccumulateHash(hash, &shaderHash, sizeof(shaderHash));
+    }
+}
+
+std::uint64_t GLShaderProgram::GetCacheKey(const ShaderProgramDescriptor& desc) const
+{
+    auto hash = g_hashOffsetBasis;
+
+    /* Hash all shaders */
+    AccumulateShaderHash(hash, desc.vertexShader);
+    AccumulateShaderHash(hash, desc.tessControlShader);
+    AccumulateShaderHash(hash, desc.tessEvaluationShader);
+    AccumulateShaderHash(hash, desc.geometryShader);
+    AccumulateShaderHash(hash, desc.fragmentShader);
+    AccumulateShaderHash(hash, desc.computeShader);
+    AccumulateShaderHash(hash, desc.amplificationShader);
+    AccumulateShaderHash(hash, desc.meshShader);
+
+    /* Hash vertex attribute names in the order of their locations (see BuildInputLayout) */
+    for (const auto& vertexFormat : desc.vertexFormats)
+    {
+        for (const auto& attrib : vertexFormat.attributes)
+        {
+            AccumulateHash(hash, attrib.name.c_str());
+            AccumulateHash(hash, &(attrib.semanticIndex), sizeof(attrib.semanticIndex));
+        }
+    }
+
+    /* Hash transform-feedback varyings, which are part of the linked program */
+    for (const auto& attrib : streamOutputFormat_.attributes)
+        AccumulateHash(hash, attrib.name.c_str());
+
+    return hash;
+}
+
 bool GLShaderProgram::QueryActiveAttribs(
     GLenum attribCountType, GLenum attribNameLengthType,
     GLint& numAttribs, GLint& maxNameLength, std::vector<char>& nameBuffer) const
@@ -242,8 +354,24 @@ void GLShaderProgram::BuildTransformFeedbackVaryingsEXT(const std::vector<Stream
     std::vector<const GLchar*> varyings;
     varyings.reserve(attributes.size());
 
+    #ifdef GL_ARB_transform_feedback3
+    const bool hasNextBuffer = HasExtension(GLExt::ARB_transform_feedback3);
+    #else
+    const bool hasNextBuffer = false;
+    #endif
+
+    std::uint8_t outputSlot = 0;
+
     for (const auto& attr : attributes)
+    {
+        /* Advance to the next transform feedback buffer with the "gl_NextBuffer" pseudo varying (attributes must be sorted by output slot) */
+        if (hasNextBuffer)
+        {
+            for (; outputSlot < attr.outputSlot; ++outputSlot)
+                varyings.push_back("gl_NextBuffer");
+        }
         varyings.push_back(attr.name.c_str());
+    }
 
     glTransformFeedbackVaryings(id_, static_cast<GLsizei>(varyings.size()), varyings.data(), GL_INTERLEAVED_ATTRIBS);
 }
@@ -535,6 +663,10 @@ void GLShaderProgram::QueryStorageBuffers(ShaderReflectionDescriptor& reflection
 {
     #ifndef __APPLE__
 
+    /* Storage blocks can only be reflected with program interface queries, whose entry points are loaded on first use */
+    if (!HasExtension(GLExt::ARB_program_interface_query))
+        return;
+
     /* Query number of shader storage blocks */
     GLenum properties[3] = { 0 };
     properties[0] = GL_NUM_ACTIVE_VARIABLES;
@@ -18,18 +18,23 @@ namespace LLGL
 {
 
 
+class GLProgramCache;
+
 class GLShaderProgram final : public ShaderProgram
 {
 
     public:
 
-        GLShaderProgram(const ShaderProgramDescriptor& desc);
+        // Creates and links the shader program, or restores it from the specified program binary cache (if not null).
+        GLShaderProgram(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache = nullptr);
         ~GLShaderProgram();
 
         bool HasErrors() const override;
 
         std::string QueryInfoLog() override;
 
+        bool IsReady() const override;
+
         ShaderReflectionDescriptor QueryReflectionDesc() const override;
 
         void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
@@ -54,7 +59,10 @@ class GLShaderProgram final : public ShaderProgram
 
         void Attach(Shader* shader);
         void BuildInputLayout(std::size_t numVertexFormats, const VertexFormat* vertexFormats);
-        void Link();
+        void Link(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache);
+        void LinkProgram(const ShaderProgramDescriptor& desc, const GLProgramCache* programCache, std::uint64_t cacheKey);
+
+        std::uint64_t GetCacheKey(const ShaderProgramDescriptor& desc) const;
 
         bool QueryActiveAttribs(
             GLenum attribCountType, GLenum attribNameLengthType,
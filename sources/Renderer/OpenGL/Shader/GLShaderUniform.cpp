@@ -7,205 +7,284 @@
 
 #include "GLShaderUniform.h"
 #include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include "../../GLCommon/GLTypes.h"
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
 {
 
 
+/*
+Sets the uniform with glProgramUniform* if uniforms can be set directly (GL_ARB_separate_shader_objects),
+or with glUniform* for the currently bound shader program otherwise.
+*/
+#define LLGL_GL_UNIFORM(SUFFIX, LOCATION, ...)                          \
+    {                                                                   \
+        if (directAccess_)                                              \
+            glProgramUniform##SUFFIX(program_, LOCATION, __VA_ARGS__);  \
+        else                                                            \
+            glUniform##SUFFIX(LOCATION, __VA_ARGS__);                   \
+    }
+
 GLShaderUniform::GLShaderUniform(GLuint program) :
-    program_ { program }
+    program_      { program                                           },
+    directAccess_ { HasExtension(GLExt::ARB_separate_shader_objects) }
 {
 }
 
 void GLShaderUniform::SetUniform1i(const UniformLocation location, int value0)
 {
-    glUniform1i(static_cast<GLint>(location), value0);
+    LLGL_GL_UNIFORM(1i, static_cast<GLint>(location), value0);
 }
 
 void GLShaderUniform::SetUniform2i(const UniformLocation location, int value0, int value1)
 {
-    glUniform2i(static_cast<GLint>(location), value0, value1);
+    LLGL_GL_UNIFORM(2i, static_cast<GLint>(location), value0, value1);
 }
 
 void GLShaderUniform::SetUniform3i(const UniformLocation location, int value0, int value1, int value2)
 {
-    glUniform3i(static_cast<GLint>(location), value0, value1, value2);
+    LLGL_GL_UNIFORM(3i, static_cast<GLint>(location), value0, value1, value2);
 }
 
 void GLShaderUniform::SetUniform4i(const UniformLocation location, int value0, int value1, int value2, int value3)
 {
-    glUniform4i(static_cast<GLint>(location), value0, value1, value2, value3);
+    LLGL_GL_UNIFORM(4i, static_cast<GLint>(location), value0, value1, value2, value3);
 }
 
 void GLShaderUniform::SetUniform1f(const UniformLocation location, float value0)
 {
-    glUniform1f(static_cast<GLint>(location), value0);
+    LLGL_GL_UNIFORM(1f, static_cast<GLint>(location), value0);
 }
 
 void GLShaderUniform::SetUniform2f(const UniformLocation location, float value0, float value1)
 {
-    glUniform2f(static_cast<GLint>(location), value0, value1);
+    LLGL_GL_UNIFORM(2f, static_cast<GLint>(location), value0, value1);
 }
 
 void GLShaderUniform::SetUniform3f(const UniformLocation location, float value0, float value1, float value2)
 {
-    glUniform3f(static_cast<GLint>(location), value0, value1, value2);
+    LLGL_GL_UNIFORM(3f, static_cast<GLint>(location), value0, value1, value2);
 }
 
 void GLShaderUniform::SetUniform4f(const UniformLocation location, float value0, float value1, float value2, float value3)
 {
-    glUniform4f(static_cast<GLint>(location), value0, value1, value2, value3);
+    LLGL_GL_UNIFORM(4f, static_cast<GLint>(location), value0, value1, value2, value3);
 }
 
 void GLShaderUniform::SetUniform1iv(const UniformLocation location, const int* value, std::size_t count)
 {
-    glUniform1iv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(1iv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2iv(const UniformLocation location, const int* value, std::size_t count)
 {
-    glUniform2iv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(2iv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform3iv(const UniformLocation location, const int* value, std::size_t count)
 {
-    glUniform3iv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(3iv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform4iv(const UniformLocation location, const int* value, std::size_t count)
 {
-    glUniform4iv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(4iv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform1fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniform1fv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(1fv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniform2fv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(2fv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform3fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniform3fv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(3fv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform4fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniform4fv(static_cast<GLint>(location), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(4fv, static_cast<GLint>(location), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2x2fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniformMatrix2fv(static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix2fv, static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
 }
 
 void GLShaderUniform::SetUniform3x3fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniformMatrix3fv(static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix3fv, static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
 }
 
 void GLShaderUniform::SetUniform4x4fv(const UniformLocation location, const float* value, std::size_t count)
 {
-    glUniformMatrix4fv(static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix4fv, static_cast<GLint>(location), static_cast<GLsizei>(count), GL_FALSE, value);
 }
 
 void GLShaderUniform::SetUniform1i(const char* name, int value0)
 {
-    glUniform1i(GetLocation(name), value0);
+    LLGL_GL_UNIFORM(1i, GetLocation(name), value0);
 }
 
 void GLShaderUniform::SetUniform2i(const char* name, int value0, int value1)
 {
-    glUniform2i(GetLocation(name), value0, value1);
+    LLGL_GL_UNIFORM(2i, GetLocation(name), value0, value1);
 }
 
 void GLShaderUniform::SetUniform3i(const char* name, int value0, int value1, int value2)
 {
-    glUniform3i(GetLocation(name), value0, value1, value2);
+    LLGL_GL_UNIFORM(3i, GetLocation(name), value0, value1, value2);
 }
 
 void GLShaderUniform::SetUniform4i(const char* name, int value0, int value1, int value2, int value3)
 {
-    glUniform4i(GetLocation(name), value0, value1, value2, value3);
+    LLGL_GL_UNIFORM(4i, GetLocation(name), value0, value1, value2, value3);
 }
 
 void GLShaderUniform::SetUniform1f(const char* name, float value0)
 {
-    glUniform1f(GetLocation(name), value0);
+    LLGL_GL_UNIFORM(1f, GetLocation(name), value0);
 }
 
 void GLShaderUniform::SetUniform2f(const char* name, float value0, float value1)
 {
-    glUniform2f(GetLocation(name), value0, value1);
+    LLGL_GL_UNIFORM(2f, GetLocation(name), value0, value1);
 }
 
 void GLShaderUniform::SetUniform3f(const char* name, float value0, float value1, float value2)
 {
-    glUniform3f(GetLocation(name), value0, value1, value2);
+    LLGL_GL_UNIFORM(3f, GetLocation(name), value0, value1, value2);
 }
 
 void GLShaderUniform::SetUniform4f(const char* name, float value0, float value1, float value2, float value3)
 {
-    glUniform4f(GetLocation(name), value0, value1, value2, value3);
+    LLGL_GL_UNIFORM(4f, GetLocation(name), value0, value1, value2, value3);
 }
 
 void GLShaderUniform::SetUniform1iv(const char* name, const int* value, std::size_t count)
 {
-    glUniform1iv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(1iv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2iv(const char* name, const int* value, std::size_t count)
 {
-    glUniform2iv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(2iv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform3iv(const char* name, const int* value, std::size_t count)
 {
-    glUniform3iv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(3iv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform4iv(const char* name, const int* value, std::size_t count)
 {
-    glUniform4iv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(4iv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform1fv(const char* name, const float* value, std::size_t count)
 {
-    glUniform1fv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(1fv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2fv(const char* name, const float* value, std::size_t count)
 {
-    glUniform2fv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(2fv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform3fv(const char* name, const float* value, std::size_t count)
 {
-    glUniform3fv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(3fv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform4fv(const char* name, const float* value, std::size_t count)
 {
-    glUniform4fv(GetLocation(name), static_cast<GLsizei>(count), value);
+    LLGL_GL_UNIFORM(4fv, GetLocation(name), static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniform2x2fv(const char* name, const float* value, std::size_t count)
 {
-    glUniformMatrix2fv(GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix2fv, GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
 }
 
 void GLShaderUniform::SetUniform3x3fv(const char* name, const float* value, std::size_t count)
 {
-    glUniformMatrix3fv(GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix3fv, GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
 }
 
 void GLShaderUniform::SetUniform4x4fv(const char* name, const float* value, std::size_t count)
 {
-    glUniformMatrix4fv(GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
+    LLGL_GL_UNIFORM(Matrix4fv, GetLocation(name), static_cast<GLsizei>(count), GL_FALSE, value);
+}
+
+// Returns the number of 4-byte components of the specified uniform type, or 0 if the type is not supported for SetUniforms.
+static std::size_t GetUniformComponentCount(const UniformType type)
+{
+    switch (type)
+    {
+        case UniformType::Float1:   return 1;
+        case UniformType::Float2:   return 2;
+        case UniformType::Float3:   return 3;
+        case UniformType::Float4:   return 4;
+        case UniformType::Int1:     return 1;
+        case UniformType::Int2:     return 2;
+        case UniformType::Int3:     return 3;
+        case UniformType::Int4:     return 4;
+        case UniformType::Bool1:    return 1;
+        case UniformType::Bool2:    return 2;
+        case UniformType::Bool3:    return 3;
+        case UniformType::Bool4:    return 4;
+        case UniformType::Float2x2: return 4;
+        case UniformType::Float3x3: return 9;
+        case UniformType::Float4x4: return 16;
+        case UniformType::Sampler:  return 1;
+        case UniformType::Image:    return 1;
+        default:                    return 0;
+    }
+}
+
+void GLShaderUniform::SetUniforms(std::size_t numUniforms, const UniformLocation* locations, const void* data, std::size_t dataSize)
+{
+    /* Resolve uniform types on first use */
+    if (entries_.empty())
+        BuildUniformEntries();
+
+    auto byteData = reinterpret_cast<const char*>(data);
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < numUniforms; ++i)
+    {
+        /* Get uniform type and array size by location */
+        const auto location = locations[i];
+        if (location < 0 || static_cast<std::size_t>(location) >= entries_.size() || entries_[location].count == 0)
+            throw std::invalid_argument("cannot set uniform with invalid location: " + std::to_string(location));
+
+        const auto& entry = entries_[location];
+        const auto numComponents = GetUniformComponentCount(entry.type);
+        if (numComponents == 0)
+            throw std::invalid_argument("cannot set uniform of unsupported type at location " + std::to_string(location));
+
+        /* Validate remaining data size */
+        const auto size = numComponents * 4 * static_cast<std::size_t>(entry.count);
+        if (offset + size > dataSize)
+        {
+            throw std::invalid_argument(
+                "insufficient data size to set uniforms (" + std::to_string(dataSize) +
+                " bytes specified, but at least " + std::to_string(offset + size) + " are required)"
+            );
+        }
+
+        SetUniformEntry(location, entry, byteData + offset);
+        offset += size;
+    }
 }
 
 
@@ -218,6 +297,71 @@ GLint GLShaderUniform::GetLocation(const char* name) const
     return glGetUniformLocation(program_, name);
 }
 
+void GLShaderUniform::BuildUniformEntries()
+{
+    /* Query number of active uniforms and maximal name length */
+    GLint numUniforms = 0, maxNameLength = 0;
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &numUniforms);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    if (numUniforms <= 0 || maxNameLength <= 0)
+        return;
+
+    std::vector<GLchar> name(static_cast<std::size_t>(maxNameLength), '\0');
+
+    for (GLuint i = 0; i < static_cast<GLuint>(numUniforms); ++i)
+    {
+        /* Query uniform name, type, and array size */
+        GLsizei nameLength  = 0;
+        GLint   size        = 0;
+        GLenum  type        = 0;
+        glGetActiveUniform(program_, i, maxNameLength, &nameLength, &size, &type, name.data());
+
+        /* Uniforms in uniform blocks have no location */
+        const auto location = glGetUniformLocation(program_, name.data());
+        if (location < 0)
+            continue;
+
+        /* Store uniform entry by its location */
+        if (static_cast<std::size_t>(location) >= entries_.size())
+            entries_.resize(static_cast<std::size_t>(location) + 1);
+
+        auto& entry = entries_[location];
+        GLTypes::Unmap(entry.type, type);
+        entry.count = size;
+    }
+}
+
+void GLShaderUniform::SetUniformEntry(GLint location, const UniformEntry& entry, const void* data)
+{
+    auto floats = reinterpret_cast<const GLfloat*>(data);
+    auto ints   = reinterpret_cast<const GLint*>(data);
+
+    switch (entry.type)
+    {
+        case UniformType::Float1:   LLGL_GL_UNIFORM(1fv, location, entry.count, floats); break;
+        case UniformType::Float2:   LLGL_GL_UNIFORM(2fv, location, entry.count, floats); break;
+        case UniformType::Float3:   LLGL_GL_UNIFORM(3fv, location, entry.count, floats); break;
+        case UniformType::Float4:   LLGL_GL_UNIFORM(4fv, location, entry.count, floats); break;
+        case UniformType::Int1:
+        case UniformType::Bool1:
+        case UniformType::Sampler:
+        case UniformType::Image:    LLGL_GL_UNIFORM(1iv, location, entry.count, ints); break;
+        case UniformType::Int2:
+        case UniformType::Bool2:    LLGL_GL_UNIFORM(2iv, location, entry.count, ints); break;
+        case UniformType::Int3:
+        case UniformType::Bool3:    LLGL_GL_UNIFORM(3iv, location, entry.count, ints); break;
+        case UniformType::Int4:
+        case UniformType::Bool4:    LLGL_GL_UNIFORM(4iv, location, entry.count, ints); break;
+        case UniformType::Float2x2: LLGL_GL_UNIFORM(Matrix2fv, location, entry.count, GL_FALSE, floats); break;
+        case UniformType::Float3x3: LLGL_GL_UNIFORM(Matrix3fv, location, entry.count, GL_FALSE, floats); break;
+        case UniformType::Float4x4: LLGL_GL_UNIFORM(Matrix4fv, location, entry.count, GL_FALSE, floats); break;
+        default:                    break;
+    }
+}
+
+#undef LLGL_GL_UNIFORM
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/ShaderUniform.h>
 #include "../OpenGL.h"
+#include <vector>
 
 
 namespace LLGL
@@ -72,11 +73,32 @@ class GLShaderUniform final : public ShaderUniform
         void SetUniform3x3fv(const char* name, const float* value, std::size_t count = 1) override;
         void SetUniform4x4fv(const char* name, const float* value, std::size_t count = 1) override;
 
+        void SetUniforms(std::size_t numUniforms, const UniformLocation* locations, const void* data, std::size_t dataSize) override;
+
+    public:
+
+        // Returns true if uniforms are set with glProgramUniform*, i.e. the shader program does not need to be bound.
+        inline bool HasDirectAccess() const
+        {
+            return directAccess_;
+        }
+
     private:
 
+        struct UniformEntry
+        {
+            UniformType type    = UniformType::Undefined;
+            GLsizei     count   = 0;
+        };
+
         GLint GetLocation(const char* name) const;
 
-        GLuint program_ = 0;
+        void BuildUniformEntries();
+        void SetUniformEntry(GLint location, const UniformEntry& entry, const void* data);
+
+        GLuint                      program_        = 0;
+        bool                        directAccess_   = false;
+        std::vector<UniformEntry>   entries_;                   // Uniform types and array sizes indexed by location
 
 };
 
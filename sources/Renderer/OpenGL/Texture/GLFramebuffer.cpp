@@ -9,6 +9,7 @@
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
+#include <stdexcept>
 
 
 namespace LLGL
@@ -40,7 +41,17 @@ GLFramebuffer& GLFramebuffer::operator = (GLFramebuffer&& rhs)
 void GLFramebuffer::GenFramebuffer()
 {
     DeleteFramebuffer();
-    glGenFramebuffers(1, &id_);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create new framebuffer object with initialized state (not required to bind it first) */
+        glCreateFramebuffers(1, &id_);
+    }
+    else
+    #endif
+    {
+        glGenFramebuffers(1, &id_);
+    }
 }
 
 void GLFramebuffer::DeleteFramebuffer()
@@ -65,27 +76,154 @@ void GLFramebuffer::Unbind(const GLFramebufferTarget target) const
 
 void GLFramebuffer::AttachTexture1D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel)
 {
-    glFramebufferTexture1D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedFramebufferTexture(GetID(), attachment, textureID, mipLevel);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferTexture1D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel);
+    }
 }
 
 void GLFramebuffer::AttachTexture2D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel)
 {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        if (textureTarget >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && textureTarget <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+        {
+            /* Attach cube face as layer, since named framebuffers have no texture target parameter */
+            glNamedFramebufferTextureLayer(GetID(), attachment, textureID, mipLevel, static_cast<GLint>(textureTarget - GL_TEXTURE_CUBE_MAP_POSITIVE_X));
+        }
+        else
+            glNamedFramebufferTexture(GetID(), attachment, textureID, mipLevel);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel);
+    }
 }
 
 void GLFramebuffer::AttachTexture3D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel, GLint zOffset)
 {
-    glFramebufferTexture3D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel, zOffset);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedFramebufferTextureLayer(GetID(), attachment, textureID, mipLevel, zOffset);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferTexture3D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, mipLevel, zOffset);
+    }
 }
 
 void GLFramebuffer::AttachTextureLayer(GLenum attachment, GLuint textureID, GLint mipLevel, GLint layer)
 {
-    glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, textureID, mipLevel, layer);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedFramebufferTextureLayer(GetID(), attachment, textureID, mipLevel, layer);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, textureID, mipLevel, layer);
+    }
+}
+
+void GLFramebuffer::AttachTextureMultiview(GLenum attachment, GLuint textureID, GLint mipLevel, GLint baseViewIndex, GLsizei numViews)
+{
+    #ifdef GL_OVR_multiview
+    if (HasExtension(GLExt::OVR_multiview))
+    {
+        /* GL_OVR_multiview has no DSA version, so the framebuffer must always be bound */
+        Bind();
+        glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, attachment, textureID, mipLevel, baseViewIndex, numViews);
+    }
+    else
+    #endif
+    {
+        throw std::runtime_error("multiview rendering is not supported (GL_OVR_multiview)");
+    }
+}
+
+void GLFramebuffer::AttachTextureLayered(GLenum attachment, GLuint textureID, GLint mipLevel)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedFramebufferTexture(GetID(), attachment, textureID, mipLevel);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferTexture(GL_FRAMEBUFFER, attachment, textureID, mipLevel);
+    }
 }
 
 void GLFramebuffer::AttachRenderbuffer(GLenum attachment, GLuint renderbufferID)
 {
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbufferID);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedFramebufferRenderbuffer(GetID(), attachment, GL_RENDERBUFFER, renderbufferID);
+    }
+    else
+    #endif
+    {
+        Bind();
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbufferID);
+    }
+}
+
+void GLFramebuffer::DrawBuffers(GLsizei count, const GLenum* buffers)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        if (count == 0)
+            glNamedFramebufferDrawBuffer(GetID(), GL_NONE);
+        else if (count == 1)
+            glNamedFramebufferDrawBuffer(GetID(), buffers[0]);
+        else
+            glNamedFramebufferDrawBuffers(GetID(), count, buffers);
+    }
+    else
+    #endif
+    {
+        Bind();
+        if (count == 0)
+            glDrawBuffer(GL_NONE);
+        else if (count == 1)
+            glDrawBuffer(buffers[0]);
+        else
+            glDrawBuffers(count, buffers);
+    }
+}
+
+GLenum GLFramebuffer::CheckStatus() const
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        return glCheckNamedFramebufferStatus(GetID(), GL_FRAMEBUFFER);
+    }
+    else
+    #endif
+    {
+        Bind();
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    }
 }
 
 void GLFramebuffer::Blit(GLint width, GLint height, GLenum mask)
@@ -122,12 +260,25 @@ bool GLFramebuffer::FramebufferParameters(
     #ifdef GL_ARB_framebuffer_no_attachments
     if (HasExtension(GLExt::ARB_framebuffer_no_attachments))
     {
-        GLStateManager::active->BindFramebuffer(GLFramebufferTarget::FRAMEBUFFER, GetID());
-        glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_WIDTH, width);
-        glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_HEIGHT, height);
-        glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_LAYERS, layers);
-        glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_SAMPLES, samples);
-        glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_FIXED_SAMPLE_LOCATIONS, fixedSampleLocations);
+        #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+        if (HasExtension(GLExt::ARB_direct_state_access))
+        {
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_WIDTH, width);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_HEIGHT, height);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_LAYERS, layers);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_SAMPLES, samples);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_FIXED_SAMPLE_LOCATIONS, fixedSampleLocations);
+        }
+        else
+        #endif
+        {
+            Bind();
+            glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_WIDTH, width);
+            glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_HEIGHT, height);
+            glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_LAYERS, layers);
+            glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_SAMPLES, samples);
+            glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_FIXED_SAMPLE_LOCATIONS, fixedSampleLocations);
+        }
         return true;
     }
     #endif // /GL_ARB_framebuffer_no_attachments
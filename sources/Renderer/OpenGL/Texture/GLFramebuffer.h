@@ -38,12 +38,26 @@ class GLFramebuffer
         void Bind(const GLFramebufferTarget target = GLFramebufferTarget::FRAMEBUFFER) const;
         void Unbind(const GLFramebufferTarget target = GLFramebufferTarget::FRAMEBUFFER) const;
 
-        static void AttachTexture1D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel);
-        static void AttachTexture2D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel);
-        static void AttachTexture3D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel, GLint zOffset);
-        static void AttachTextureLayer(GLenum attachment, GLuint textureID, GLint mipLevel, GLint layer);
-
-        static void AttachRenderbuffer(GLenum attachment, GLuint renderbufferID);
+        /*
+        Attaches the specified texture or renderbuffer to this framebuffer.
+        With GL_ARB_direct_state_access, the currently bound framebuffer is not modified.
+        */
+        void AttachTexture1D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel);
+        void AttachTexture2D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel);
+        void AttachTexture3D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel, GLint zOffset);
+        void AttachTextureLayer(GLenum attachment, GLuint textureID, GLint mipLevel, GLint layer);
+        void AttachTextureMultiview(GLenum attachment, GLuint textureID, GLint mipLevel, GLint baseViewIndex, GLsizei numViews);
+
+        // Attaches all array layers (or depth slices) of the texture for layered rendering, i.e. the layer is selected by gl_Layer.
+        void AttachTextureLayered(GLenum attachment, GLuint textureID, GLint mipLevel);
+
+        void AttachRenderbuffer(GLenum attachment, GLuint renderbufferID);
+
+        // Specifies the draw buffers of this framebuffer.
+        void DrawBuffers(GLsizei count, const GLenum* buffers);
+
+        // Returns the completeness status of this framebuffer, i.e. GL_FRAMEBUFFER_COMPLETE on success.
+        GLenum CheckStatus() const;
 
         static void Blit(GLint width, GLint height, GLenum mask);
 
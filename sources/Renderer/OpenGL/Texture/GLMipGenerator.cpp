@@ -0,0 +1,461 @@
+/*
+ * GLMipGenerator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLMipGenerator.h"
+#include "GLTexture.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLTypes.h"
+#include <LLGL/TextureFlags.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal constants
+ */
+
+// Number of MIP levels each work group reduces its 64x64 tile to.
+static const GLuint g_numLevelsPerTile = 6;
+
+#ifndef __APPLE__
+
+// Barriers for all kinds of accesses to the generated MIP levels and the counters after a dispatch.
+static const GLbitfield g_mipGenerationBarriers =
+(
+    GL_TEXTURE_FETCH_BARRIER_BIT        |
+    GL_SHADER_IMAGE_ACCESS_BARRIER_BIT  |
+    GL_TEXTURE_UPDATE_BARRIER_BIT       |
+    GL_FRAMEBUFFER_BARRIER_BIT          |
+    GL_PIXEL_BUFFER_BARRIER_BIT         |
+    GL_SHADER_STORAGE_BARRIER_BIT
+);
+
+#endif // /__APPLE__
+
+/*
+Compute shader to generate up to NUM_IMAGES MIP levels with a single dispatch.
+Each work group of 16x16 threads reduces a 64x64 tile of the source MIP level down to a single texel, keeping the intermediate levels in shared memory.
+The last work group of each array layer that finishes then reduces the sixth generated MIP level (at most 64x64 texels) down to the last MIP level.
+*/
+static const char* g_mipGenerationShaderSource = R"(
+layout(local_size_x = 16, local_size_y = 16) in;
+
+#ifdef ARRAY_TEXTURE
+#   define SAMPLER_TYPE sampler2DArray
+#   define IMAGE_TYPE   image2DArray
+#   define COORD(POS)   ivec3(POS, layer)
+#else
+#   define SAMPLER_TYPE sampler2D
+#   define IMAGE_TYPE   image2D
+#   define COORD(POS)   (POS)
+#endif
+
+layout(binding = 0) uniform SAMPLER_TYPE srcTex;
+layout(IMAGE_FORMAT, binding = 0) coherent uniform IMAGE_TYPE dstMips[NUM_IMAGES];
+
+layout(std430, binding = 0) buffer Counters
+{
+    uint counters[];
+};
+
+uniform int srcLevel;
+uniform int numLevels;
+uniform int baseLayer;
+uniform int numGroups;
+
+shared vec4 tile[16][16];
+shared bool isLastGroup;
+
+int layer = 0;
+
+void GroupSync()
+{
+    memoryBarrierShared();
+    barrier();
+}
+
+ivec2 MipSize(int level)
+{
+    return imageSize(dstMips[level]).xy;
+}
+
+void Store(int level, ivec2 pos, vec4 color)
+{
+    if (level < numLevels && all(lessThan(pos, MipSize(level))))
+        imageStore(dstMips[level], COORD(pos), color);
+}
+
+vec4 Load(ivec2 pos, bool fromImage)
+{
+    #if NUM_IMAGES > 6
+    if (fromImage)
+        return imageLoad(dstMips[5], COORD(min(pos, MipSize(5) - 1)));
+    #endif
+    return texelFetch(srcTex, COORD(min(pos, textureSize(srcTex, srcLevel).xy - 1)), srcLevel);
+}
+
+vec4 Load2x2(ivec2 pos, bool fromImage)
+{
+    return 0.25 * (
+        Load(pos,               fromImage) +
+        Load(pos + ivec2(1, 0), fromImage) +
+        Load(pos + ivec2(0, 1), fromImage) +
+        Load(pos + ivec2(1, 1), fromImage)
+    );
+}
+
+void DownsampleTile(ivec2 groupPos, int firstLevel, bool fromImage)
+{
+    ivec2 tid = ivec2(gl_LocalInvocationID.xy);
+
+    // First level: each thread reduces 4x4 source texels into 2x2 texels
+    ivec2 dstPos = groupPos * 32 + tid * 2;
+    vec4 color = vec4(0.0);
+
+    for (int y = 0; y < 2; ++y)
+    {
+        for (int x = 0; x < 2; ++x)
+        {
+            ivec2 pos = dstPos + ivec2(x, y);
+            vec4 texel = Load2x2(pos * 2, fromImage);
+            Store(firstLevel, pos, texel);
+            color += texel;
+        }
+    }
+
+    // Second level: each thread writes a single texel
+    color *= 0.25;
+    Store(firstLevel + 1, groupPos * 16 + tid, color);
+    tile[tid.y][tid.x] = color;
+
+    // Remaining levels: halve the tile in shared memory per level
+    for (int i = 2, n = 8; i < 6; ++i, n /= 2)
+    {
+        GroupSync();
+        bool active = all(lessThan(tid, ivec2(n)));
+        if (active)
+        {
+            ivec2 pos = tid * 2;
+            color = 0.25 * (
+                tile[pos.y    ][pos.x    ] +
+                tile[pos.y    ][pos.x + 1] +
+                tile[pos.y + 1][pos.x    ] +
+                tile[pos.y + 1][pos.x + 1]
+            );
+        }
+        GroupSync();
+        if (active)
+        {
+            tile[tid.y][tid.x] = color;
+            Store(firstLevel + i, groupPos * n + tid, color);
+        }
+    }
+}
+
+void main()
+{
+    layer = baseLayer + int(gl_WorkGroupID.z);
+
+    DownsampleTile(ivec2(gl_WorkGroupID.xy), 0, false);
+
+    #if NUM_IMAGES > 6
+    if (numLevels > 6)
+    {
+        // Make the sixth level visible to the last work group, then count the finished work groups of this array layer
+        memoryBarrierImage();
+        barrier();
+
+        if (gl_LocalInvocationIndex == 0)
+            isLastGroup = (atomicAdd(counters[gl_WorkGroupID.z], 1u) == uint(numGroups - 1));
+
+        GroupSync();
+
+        if (isLastGroup)
+        {
+            // Reset counter for the next dispatch
+            if (gl_LocalInvocationIndex == 0)
+                counters[gl_WorkGroupID.z] = 0u;
+
+            DownsampleTile(ivec2(0), 6, true);
+        }
+    }
+    #endif
+}
+)";
+
+
+/*
+ * GLMipGenerator class
+ */
+
+GLMipGenerator::GLMipGenerator()
+{
+    /* Each generated MIP level requires its own image unit */
+    #ifndef __APPLE__
+    glGetIntegerv(GL_MAX_COMPUTE_IMAGE_UNIFORMS, &maxNumImages_);
+    #endif
+    maxNumImages_ = std::max(1, std::min(maxNumImages_, static_cast<GLint>(g_numLevelsPerTile * 2)));
+}
+
+GLMipGenerator::~GLMipGenerator()
+{
+    for (const auto& program : programs_)
+        glDeleteProgram(program.id);
+    if (counterBuffer_ != 0)
+        glDeleteBuffers(1, &counterBuffer_);
+}
+
+// Returns the GLSL image format qualifier for the specified internal format, or null if the format can not be used for image load/store.
+static const char* GetImageFormatQualifier(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+        case GL_R8:             return "r8";
+        case GL_RG8:            return "rg8";
+        case GL_RGBA8:          return "rgba8";
+        case GL_RGBA16:         return "rgba16";
+        case GL_RGB10_A2:       return "rgb10_a2";
+        case GL_R16F:           return "r16f";
+        case GL_RG16F:          return "rg16f";
+        case GL_RGBA16F:        return "rgba16f";
+        case GL_R32F:           return "r32f";
+        case GL_RG32F:          return "rg32f";
+        case GL_RGBA32F:        return "rgba32f";
+        case GL_R11F_G11F_B10F: return "r11f_g11f_b10f";
+        default:                return nullptr;
+    }
+}
+
+bool GLMipGenerator::IsTextureSupported(const GLTexture& textureGL)
+{
+    /* sRGB formats are excluded, since they can not be bound to image units */
+    switch (textureGL.GetType())
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            return (GetImageFormatQualifier(textureGL.QueryGLInternalFormat()) != nullptr);
+        default:
+            return false;
+    }
+}
+
+void GLMipGenerator::GenerateMips(const GLTexture& textureGL)
+{
+    const auto extent = textureGL.QueryMipExtent(0);
+    const auto texTarget = GLStateManager::GetTextureTarget(textureGL.GetType());
+
+    /* Query number of MIP levels of immutable texture storage, otherwise assume the full MIP chain */
+    GLint numMipLevels = 0;
+    #ifndef __APPLE__
+    GLStateManager::active->PushBoundTexture(texTarget);
+    {
+        GLStateManager::active->BindTexture(textureGL);
+        glGetTexParameteriv(GLTypes::Map(textureGL.GetType()), GL_TEXTURE_IMMUTABLE_LEVELS, &numMipLevels);
+    }
+    GLStateManager::active->PopBoundTexture();
+    #endif
+
+    if (numMipLevels == 0)
+        numMipLevels = static_cast<GLint>(NumMipLevels(extent.width, extent.height));
+
+    GenerateMips(textureGL, 0, static_cast<GLuint>(numMipLevels), 0, extent.depth);
+}
+
+void GLMipGenerator::GenerateMips(const GLTexture& textureGL, GLuint baseMipLevel, GLuint numMipLevels, GLuint baseArrayLayer, GLuint numArrayLayers)
+{
+    #ifndef __APPLE__
+    const bool arrayTexture = (textureGL.GetType() == TextureType::Texture2DArray);
+    if (!arrayTexture)
+    {
+        baseArrayLayer = 0;
+        numArrayLayers = 1;
+    }
+
+    const auto  internalFormat  = textureGL.QueryGLInternalFormat();
+    const auto  baseExtent      = textureGL.QueryMipExtent(baseMipLevel);
+    const auto& program         = GetOrCreateProgram(internalFormat, arrayTexture);
+    const auto  texTarget       = GLStateManager::GetTextureTarget(textureGL.GetType());
+
+    ReserveCounters(numArrayLayers);
+
+    GLStateManager::active->PushShaderProgram();
+    GLStateManager::active->PushBoundTexture(0, texTarget);
+    {
+        GLStateManager::active->BindShaderProgram(program.id);
+        GLStateManager::active->ActiveTexture(0);
+        GLStateManager::active->BindTexture(texTarget, textureGL.GetID());
+        GLStateManager::active->BindBufferBase(GLBufferTarget::SHADER_STORAGE_BUFFER, 0, counterBuffer_);
+
+        glUniform1i(program.baseLayerLoc, static_cast<GLint>(baseArrayLayer));
+
+        for (GLuint srcLevel = baseMipLevel; srcLevel + 1 < baseMipLevel + numMipLevels;)
+        {
+            /* Determine extent of the first MIP level that is generated by this dispatch */
+            const auto shift    = srcLevel + 1 - baseMipLevel;
+            const auto width    = std::max(1u, baseExtent.width  >> shift);
+            const auto height   = std::max(1u, baseExtent.height >> shift);
+
+            /* Generate as many MIP levels as there are image units, but the last work group can only reduce a single 64x64 tile */
+            auto numLevels = std::min(baseMipLevel + numMipLevels - srcLevel - 1, static_cast<GLuint>(maxNumImages_));
+            if (width > 64*32 || height > 64*32)
+                numLevels = std::min(numLevels, g_numLevelsPerTile);
+
+            const auto numGroupsX = (width  + 31) / 32;
+            const auto numGroupsY = (height + 31) / 32;
+
+            /* Bind each generated MIP level to its own image unit */
+            for (GLuint i = 0; i < numLevels; ++i)
+            {
+                glBindImageTexture(
+                    i,
+                    textureGL.GetID(),
+                    static_cast<GLint>(srcLevel + 1 + i),
+                    (arrayTexture ? GL_TRUE : GL_FALSE),
+                    0,
+                    GL_READ_WRITE,
+                    internalFormat
+                );
+            }
+
+            glUniform1i(program.srcLevelLoc, static_cast<GLint>(srcLevel));
+            glUniform1i(program.numLevelsLoc, static_cast<GLint>(numLevels));
+            glUniform1i(program.numGroupsLoc, static_cast<GLint>(numGroupsX * numGroupsY));
+
+            glDispatchCompute(numGroupsX, numGroupsY, numArrayLayers);
+            glMemoryBarrier(g_mipGenerationBarriers);
+
+            srcLevel += numLevels;
+        }
+    }
+    GLStateManager::active->PopBoundTexture();
+    GLStateManager::active->PopShaderProgram();
+    #endif // /__APPLE__
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the info log of the specified shader or program object.
+static std::string GetInfoLog(GLuint object, bool isProgram)
+{
+    GLint infoLogLength = 0;
+    if (isProgram)
+        glGetProgramiv(object, GL_INFO_LOG_LENGTH, &infoLogLength);
+    else
+        glGetShaderiv(object, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+    if (infoLogLength > 0)
+    {
+        /* Store info log in byte buffer (because GL writes its own null-terminator character) */
+        std::vector<char> infoLog(static_cast<std::size_t>(infoLogLength), '\0');
+        if (isProgram)
+            glGetProgramInfoLog(object, infoLogLength, nullptr, infoLog.data());
+        else
+            glGetShaderInfoLog(object, infoLogLength, nullptr, infoLog.data());
+        return std::string(infoLog.data());
+    }
+
+    return "";
+}
+
+const GLMipGenerator::Program& GLMipGenerator::GetOrCreateProgram(GLenum internalFormat, bool arrayTexture)
+{
+    /* Find program for the specified format */
+    for (const auto& program : programs_)
+    {
+        if (program.internalFormat == internalFormat && program.arrayTexture == arrayTexture)
+            return program;
+    }
+
+    auto formatQualifier = GetImageFormatQualifier(internalFormat);
+    if (!formatQualifier)
+        throw std::invalid_argument("cannot generate MIP-maps with compute shader for texture format without image load/store support");
+
+    /* Compile compute shader with the image format and number of image units */
+    const std::string header =
+    (
+        std::string("#version 430\n") +
+        (arrayTexture ? "#define ARRAY_TEXTURE\n" : "") +
+        "#define IMAGE_FORMAT " + formatQualifier + "\n" +
+        "#define NUM_IMAGES " + std::to_string(maxNumImages_) + "\n"
+    );
+
+    const GLchar* sources[] = { header.c_str(), g_mipGenerationShaderSource };
+
+    auto shader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(shader, 2, sources, nullptr);
+    glCompileShader(shader);
+
+    GLint status = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        auto infoLog = GetInfoLog(shader, false);
+        glDeleteShader(shader);
+        throw std::runtime_error("failed to compile MIP-map generation compute shader:\n" + infoLog);
+    }
+
+    /* Link program and release shader object */
+    Program program;
+    {
+        program.internalFormat  = internalFormat;
+        program.arrayTexture    = arrayTexture;
+        program.id              = glCreateProgram();
+    }
+    glAttachShader(program.id, shader);
+    glLinkProgram(program.id);
+    glDetachShader(program.id, shader);
+    glDeleteShader(shader);
+
+    glGetProgramiv(program.id, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        auto infoLog = GetInfoLog(program.id, true);
+        glDeleteProgram(program.id);
+        throw std::runtime_error("failed to link MIP-map generation compute shader:\n" + infoLog);
+    }
+
+    program.srcLevelLoc     = glGetUniformLocation(program.id, "srcLevel");
+    program.numLevelsLoc    = glGetUniformLocation(program.id, "numLevels");
+    program.baseLayerLoc    = glGetUniformLocation(program.id, "baseLayer");
+    program.numGroupsLoc    = glGetUniformLocation(program.id, "numGroups");
+
+    programs_.push_back(program);
+    return programs_.back();
+}
+
+void GLMipGenerator::ReserveCounters(GLuint numArrayLayers)
+{
+    if (numArrayLayers > numCounters_)
+    {
+        /* Re-create counter buffer initialized with zeros; the shader resets each counter after use */
+        if (counterBuffer_ == 0)
+            glGenBuffers(1, &counterBuffer_);
+
+        std::vector<GLuint> initialCounters(numArrayLayers, 0);
+
+        GLStateManager::active->BindBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, counterBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(sizeof(GLuint) * numArrayLayers), initialCounters.data(), GL_DYNAMIC_DRAW);
+
+        numCounters_ = numArrayLayers;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
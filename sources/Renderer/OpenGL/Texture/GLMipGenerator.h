@@ -0,0 +1,80 @@
+/*
+ * GLMipGenerator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_MIP_GENERATOR_H
+#define LLGL_GL_MIP_GENERATOR_H
+
+
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLTexture;
+
+/*
+Single-pass MIP-map generator with a built-in compute shader (requires GL_ARB_compute_shader, GL_ARB_shader_image_load_store, and GL_ARB_shader_storage_buffer_object).
+Each work group reduces a 64x64 tile of the source MIP level down to a single texel (i.e. six MIP levels) in shared memory,
+and the last work group that finishes (determined by an atomic counter) reduces the remaining 64x64 texels down to the last MIP level.
+This generates up to twelve MIP levels with a single dispatch, instead of one blit and one barrier per MIP level.
+*/
+class GLMipGenerator
+{
+
+    public:
+
+        GLMipGenerator();
+        ~GLMipGenerator();
+
+        GLMipGenerator(const GLMipGenerator&) = delete;
+        GLMipGenerator& operator = (const GLMipGenerator&) = delete;
+
+        // Returns true if the MIP-maps of the specified texture can be generated with this class (only 2D and 2D array textures with uncompressed color formats).
+        static bool IsTextureSupported(const GLTexture& textureGL);
+
+        // Generates all MIP levels of the specified texture from its first MIP level.
+        void GenerateMips(const GLTexture& textureGL);
+
+        // Generates the MIP levels in the range [baseMipLevel + 1, baseMipLevel + numMipLevels) from MIP level 'baseMipLevel'.
+        void GenerateMips(const GLTexture& textureGL, GLuint baseMipLevel, GLuint numMipLevels, GLuint baseArrayLayer, GLuint numArrayLayers);
+
+    private:
+
+        struct Program
+        {
+            GLenum  internalFormat  = 0;
+            bool    arrayTexture    = false;
+            GLuint  id              = 0;
+            GLint   srcLevelLoc     = -1;
+            GLint   numLevelsLoc    = -1;
+            GLint   baseLayerLoc    = -1;
+            GLint   numGroupsLoc    = -1;
+        };
+
+        const Program& GetOrCreateProgram(GLenum internalFormat, bool arrayTexture);
+        void ReserveCounters(GLuint numArrayLayers);
+
+        std::vector<Program>    programs_;
+        GLint                   maxNumImages_       = 0;
+
+        GLuint                  counterBuffer_      = 0;    // Atomic counters of finished work groups (one per array layer)
+        GLuint                  numCounters_        = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
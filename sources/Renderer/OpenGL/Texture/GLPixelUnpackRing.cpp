@@ -0,0 +1,94 @@
+/*
+ * GLPixelUnpackRing.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLPixelUnpackRing.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Alignment (in bytes) of each write offset, which covers the size of all pixel formats
+static const std::size_t g_writeAlignment = 16;
+
+const std::uint32_t GLPixelUnpackRing::numSegments;
+
+GLPixelUnpackRing::GLPixelUnpackRing(std::size_t size) :
+    segmentSize_ { (size / numSegments) & ~(g_writeAlignment - 1) }
+{
+    #ifdef GL_ARB_buffer_storage
+
+    const auto bufferSize   = static_cast<GLsizeiptr>(segmentSize_ * numSegments);
+    const auto flagsGL      = static_cast<GLbitfield>(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+    /* Create pixel unpack buffer with immutable storage and map it persistently */
+    glGenBuffers(1, &id_);
+    GLStateManager::active->NotifyBufferRelease(id_, GLBufferTarget::PIXEL_UNPACK_BUFFER);
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, id_);
+    {
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, flagsGL);
+        mappedData_ = reinterpret_cast<char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bufferSize, flagsGL));
+    }
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+
+    if (!mappedData_)
+        throw std::runtime_error("failed to map GL pixel unpack buffer persistently");
+
+    #else
+
+    throw std::runtime_error("persistently mapped GL pixel unpack buffers are not supported (GL_ARB_buffer_storage)");
+
+    #endif // /GL_ARB_buffer_storage
+}
+
+GLPixelUnpackRing::~GLPixelUnpackRing()
+{
+    /* Deleting the buffer also unmaps it */
+    glDeleteBuffers(1, &id_);
+    GLStateManager::active->NotifyBufferRelease(id_, GLBufferTarget::PIXEL_UNPACK_BUFFER);
+}
+
+bool GLPixelUnpackRing::Write(const void* data, std::size_t dataSize, GLintptr& offset)
+{
+    if (dataSize == 0 || dataSize > segmentSize_)
+        return false;
+
+    /* Advance to next segment if the data does not fit into the current one */
+    auto writeOffset = (writeOffset_ + g_writeAlignment - 1) & ~(g_writeAlignment - 1);
+
+    if (writeOffset + dataSize > (currentSegment_ + 1) * segmentSize_)
+    {
+        /* Mark the end of all uploads that read from the current segment */
+        segmentFences_[currentSegment_].Submit();
+
+        /* Wait until the GPU is done with the next segment (it was used 'numSegments - 1' segments ago) */
+        currentSegment_ = (currentSegment_ + 1) % numSegments;
+        segmentFences_[currentSegment_].Wait(~0ull);
+
+        writeOffset = currentSegment_ * segmentSize_;
+    }
+
+    /* Copy data into mapped buffer (coherent mapping, so no explicit flush is required) */
+    std::memcpy(mappedData_ + writeOffset, data, dataSize);
+
+    writeOffset_    = writeOffset + dataSize;
+    offset          = static_cast<GLintptr>(writeOffset);
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,73 @@
+/*
+ * GLPixelUnpackRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PIXEL_UNPACK_RING_H
+#define LLGL_GL_PIXEL_UNPACK_RING_H
+
+
+#include "../OpenGL.h"
+#include "../RenderState/GLFence.h"
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Persistently mapped pixel unpack buffer (requires GL_ARB_buffer_storage) that is used as staging ring for texture uploads.
+The buffer is divided into 'numSegments' segments that are filled linearly. When an upload does not fit into the current segment anymore,
+a fence is submitted for that segment and the ring advances to the next segment, waiting only until the GPU has finished reading from it.
+The texture data is then copied asynchronously by the GPU, instead of a synchronous copy by the driver inside 'glTexSubImage*'.
+*/
+class GLPixelUnpackRing
+{
+
+    public:
+
+        // Number of segments of the ring buffer.
+        static const std::uint32_t numSegments = 4;
+
+        GLPixelUnpackRing(std::size_t size);
+        ~GLPixelUnpackRing();
+
+        GLPixelUnpackRing(const GLPixelUnpackRing&) = delete;
+        GLPixelUnpackRing& operator = (const GLPixelUnpackRing&) = delete;
+
+        /*
+        Copies the specified data into the ring buffer and returns the offset (in bytes) of that data within the buffer in 'offset'.
+        Returns false if the data is larger than a single segment, in which case the data must be uploaded directly.
+        */
+        bool Write(const void* data, std::size_t dataSize, GLintptr& offset);
+
+        // Returns the hardware buffer ID of the pixel unpack buffer.
+        inline GLuint GetID() const
+        {
+            return id_;
+        }
+
+    private:
+
+        GLuint          id_             = 0;
+        char*           mappedData_     = nullptr;
+        std::size_t     segmentSize_    = 0;
+        std::size_t     writeOffset_    = 0;
+        std::uint32_t   currentSegment_ = 0;
+        GLFence         segmentFences_[numSegments];
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -40,9 +40,23 @@ static void ErrTooManyColorAttachments(std::size_t numColorAttchments)
     );
 }
 
-static void ValidateFramebufferStatus(const char* info)
+static void ValidateMultiViewAttachments(const RenderTargetDescriptor& desc)
 {
-    auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (desc.multiSampling.SampleCount() > 1)
+        throw std::invalid_argument("cannot create multiview render target with multi-sampling");
+
+    for (const auto& attachmentDesc : desc.attachments)
+    {
+        if (attachmentDesc.texture == nullptr)
+            throw std::invalid_argument("cannot create multiview render target with attachment without a valid texture");
+        if (attachmentDesc.texture->GetType() != TextureType::Texture2DArray)
+            throw std::invalid_argument("cannot create multiview render target with attachment of a texture type other than Texture2DArray");
+    }
+}
+
+static void ValidateFramebufferStatus(const GLFramebuffer& framebuffer, const char* info)
+{
+    auto status = framebuffer.CheckStatus();
     GLThrowIfFailed(status, GL_FRAMEBUFFER_COMPLETE, info);
 }
 
@@ -69,8 +83,17 @@ static std::size_t CountColorAttachments(const std::vector<AttachmentDescriptor>
 
 GLRenderTarget::GLRenderTarget(const RenderTargetDescriptor& desc) :
     RenderTarget  { desc.resolution                                        },
-    multiSamples_ { static_cast<GLsizei>(desc.multiSampling.SampleCount()) }
+    multiSamples_ { static_cast<GLsizei>(desc.multiSampling.SampleCount()) },
+    numViews_     { static_cast<GLsizei>(desc.numViews)                    }
 {
+    if (numViews_ > 1)
+        ValidateMultiViewAttachments(desc);
+
+    /* Layered attachments cannot be resolved from multi-sampled renderbuffers */
+    numLayers_ = ValidateAttachmentLayers(desc);
+    if (numLayers_ > 1 && HasMultiSampling() && !desc.customMultiSampling)
+        throw std::invalid_argument("cannot create layered render target with multi-sampling, except for custom multi-sampling");
+
     framebuffer_.GenFramebuffer();
     if (desc.attachments.empty())
         CreateFramebufferWithNoAttachments(desc);
@@ -147,11 +170,69 @@ void GLRenderTarget::BlitOntoScreen(std::size_t colorAttachmentIndex)
     }
 }
 
+/*
+Blit the specified attachment from the multi-sample framebuffer (read), or from
+the main framebuffer if custom multi-sampling is used, into the destination texture (draw)
+*/
+void GLRenderTarget::ResolveColorAttachment(std::uint32_t colorAttachment, const GLTexture& dstTexture)
+{
+    if (colorAttachment < colorAttachments_.size())
+    {
+        if (!framebufferResolve_)
+            framebufferResolve_.GenFramebuffer();
+
+        switch (dstTexture.GetType())
+        {
+            case TextureType::Texture1D:
+                framebufferResolve_.AttachTexture1D(GL_COLOR_ATTACHMENT0, GL_TEXTURE_1D, dstTexture.GetID(), 0);
+                break;
+            case TextureType::TextureCube:
+                framebufferResolve_.AttachTexture2D(GL_COLOR_ATTACHMENT0, GLTypes::ToTextureCubeMap(0), dstTexture.GetID(), 0);
+                break;
+            case TextureType::Texture3D:
+            case TextureType::Texture1DArray:
+            case TextureType::Texture2DArray:
+            case TextureType::TextureCubeArray:
+                framebufferResolve_.AttachTextureLayer(GL_COLOR_ATTACHMENT0, dstTexture.GetID(), 0, 0);
+                break;
+            default:
+                framebufferResolve_.AttachTexture2D(GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, dstTexture.GetID(), 0);
+                break;
+        }
+
+        GLStateManager::active->BindFramebuffer(GLFramebufferTarget::DRAW_FRAMEBUFFER, framebufferResolve_.GetID());
+        {
+            GLStateManager::active->BindFramebuffer(GLFramebufferTarget::READ_FRAMEBUFFER, GetFramebuffer().GetID());
+            {
+                glReadBuffer(colorAttachments_[colorAttachment]);
+                GLFramebuffer::Blit(
+                    static_cast<GLint>(GetResolution().width),
+                    static_cast<GLint>(GetResolution().height),
+                    GL_COLOR_BUFFER_BIT
+                );
+            }
+            GLStateManager::active->BindFramebuffer(GLFramebufferTarget::READ_FRAMEBUFFER, 0);
+        }
+        GLStateManager::active->BindFramebuffer(GLFramebufferTarget::DRAW_FRAMEBUFFER, 0);
+    }
+}
+
 const GLFramebuffer& GLRenderTarget::GetFramebuffer() const
 {
     return (framebufferMS_.Valid() ? framebufferMS_ : framebuffer_);
 }
 
+void GLRenderTarget::InvalidateTransientAttachments()
+{
+    #ifndef __APPLE__
+
+    /* Let tile-based GPUs discard transient attachments instead of writing them back to video memory */
+    if (!transientAttachments_.empty() && HasExtension(GLExt::ARB_invalidate_subdata))
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLsizei>(transientAttachments_.size()), transientAttachments_.data());
+
+    #endif // /__APPLE__
+}
+
 
 /*
  * ======= Private: =======
@@ -170,38 +251,31 @@ void GLRenderTarget::CreateFramebufferWithAttachments(const RenderTargetDescript
     /* Reserve storage for color attachment slots */
     colorAttachments_.reserve(numColorAttachments);
 
-    /* Bind primary FBO */
-    GLStateManager::active->BindFramebuffer(GLFramebufferTarget::FRAMEBUFFER, framebuffer_.GetID());
+    /* Attach to primary FBO */
+    if (framebufferMS_)
     {
-        if (framebufferMS_)
-        {
-            /* Only attach textures (renderbuffers are only attached to multi-sampled FBO) */
-            AttachAllTextures(desc.attachments, internalFormats);
-        }
-        else
-        {
-            /* Attach all depth-stencil buffers and textures if multi-sampling is disabled */
-            AttachAllDepthStencilBuffers(desc.attachments);
-            AttachAllTextures(desc.attachments, internalFormats);
-            SetDrawBuffers();
-        }
-
-        /* Validate framebuffer status */
-        ValidateFramebufferStatus("color attachment to framebuffer object (FBO) failed");
+        /* Only attach textures (renderbuffers are only attached to multi-sampled FBO) */
+        AttachAllTextures(desc.attachments, internalFormats);
+    }
+    else
+    {
+        /* Attach all depth-stencil buffers and textures if multi-sampling is disabled */
+        AttachAllDepthStencilBuffers(framebuffer_, desc.attachments);
+        AttachAllTextures(desc.attachments, internalFormats);
+        SetDrawBuffers(framebuffer_);
     }
 
+    /* Validate framebuffer status */
+    ValidateFramebufferStatus(framebuffer_, "color attachment to framebuffer object (FBO) failed");
+
     /* Create renderbuffers for multi-sampled render-target */
     if (framebufferMS_)
     {
-        /* Bind multi-sampled FBO */
-        GLStateManager::active->BindFramebuffer(GLFramebufferTarget::FRAMEBUFFER, framebufferMS_.GetID());
-        {
-            /* Create depth-stencil attachmnets */
-            AttachAllDepthStencilBuffers(desc.attachments);
+        /* Create depth-stencil attachmnets */
+        AttachAllDepthStencilBuffers(framebufferMS_, desc.attachments);
 
-            /* Create all renderbuffers as storage source for multi-sampled render target */
-            CreateRenderbuffersMS(internalFormats);
-        }
+        /* Create all renderbuffers as storage source for multi-sampled render target */
+        CreateRenderbuffersMS(internalFormats);
     }
 }
 
@@ -222,9 +296,6 @@ void GLRenderTarget::CreateFramebufferWithNoAttachments(const RenderTargetDescri
     else
     #endif // /GL_ARB_framebuffer_no_attachments
     {
-        /* Bind primary FBO */
-        GLStateManager::active->BindFramebuffer(GLFramebufferTarget::FRAMEBUFFER, framebuffer_.GetID());
-
         /* Create dummy renderbuffer attachment */
         renderbuffer_.GenRenderbuffer();
         renderbuffer_.Storage(
@@ -239,7 +310,7 @@ void GLRenderTarget::CreateFramebufferWithNoAttachments(const RenderTargetDescri
     }
 
     /* Validate framebuffer status */
-    ValidateFramebufferStatus("initializing default parameters for framebuffer object (FBO) failed");
+    ValidateFramebufferStatus(framebuffer_, "initializing default parameters for framebuffer object (FBO) failed");
 }
 
 void GLRenderTarget::AttachAllTextures(const std::vector<AttachmentDescriptor>& attachmentDescs, GLenum* internalFormats)
@@ -256,7 +327,7 @@ void GLRenderTarget::AttachAllTextures(const std::vector<AttachmentDescriptor>&
     }
 }
 
-void GLRenderTarget::AttachAllDepthStencilBuffers(const std::vector<AttachmentDescriptor>& attachmentDescs)
+void GLRenderTarget::AttachAllDepthStencilBuffers(GLFramebuffer& framebuffer, const std::vector<AttachmentDescriptor>& attachmentDescs)
 {
     for (const auto& attachmentDesc : attachmentDescs)
     {
@@ -269,48 +340,37 @@ void GLRenderTarget::AttachAllDepthStencilBuffers(const std::vector<AttachmentDe
                     throw std::invalid_argument("cannot have color attachment in render target without a valid texture");
                     break;
                 case AttachmentType::Depth:
-                    AttachDepthBuffer();
+                    AttachDepthBuffer(framebuffer);
                     break;
                 case AttachmentType::DepthStencil:
-                    AttachDepthStencilBuffer();
+                    AttachDepthStencilBuffer(framebuffer);
                     break;
                 case AttachmentType::Stencil:
-                    AttachStencilBuffer();
+                    AttachStencilBuffer(framebuffer);
                     break;
             }
         }
     }
 }
 
-void GLRenderTarget::AttachDepthBuffer()
+void GLRenderTarget::AttachDepthBuffer(GLFramebuffer& framebuffer)
 {
-    CreateAndAttachRenderbuffer(GL_DEPTH_COMPONENT, GL_DEPTH_ATTACHMENT);
+    CreateAndAttachRenderbuffer(framebuffer, GL_DEPTH_COMPONENT, GL_DEPTH_ATTACHMENT);
     blitMask_ |= (GL_DEPTH_BUFFER_BIT);
 }
 
-void GLRenderTarget::AttachStencilBuffer()
+void GLRenderTarget::AttachStencilBuffer(GLFramebuffer& framebuffer)
 {
-    CreateAndAttachRenderbuffer(GL_STENCIL_INDEX, GL_STENCIL_ATTACHMENT);
+    CreateAndAttachRenderbuffer(framebuffer, GL_STENCIL_INDEX, GL_STENCIL_ATTACHMENT);
     blitMask_ |= (GL_STENCIL_BUFFER_BIT);
 }
 
-void GLRenderTarget::AttachDepthStencilBuffer()
+void GLRenderTarget::AttachDepthStencilBuffer(GLFramebuffer& framebuffer)
 {
-    CreateAndAttachRenderbuffer(GL_DEPTH_STENCIL, GL_DEPTH_STENCIL_ATTACHMENT);
+    CreateAndAttachRenderbuffer(framebuffer, GL_DEPTH_STENCIL, GL_DEPTH_STENCIL_ATTACHMENT);
     blitMask_ |= (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
-// Returns the GL internal format for the specified texture object
-static GLint GetTexInternalFormat(const GLTexture& textureGL)
-{
-    GLint internalFormat = GL_RGBA;
-    {
-        GLStateManager::active->BindTexture(textureGL);
-        glGetTexLevelParameteriv(GLTypes::Map(textureGL.GetType()), 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
-    }
-    return internalFormat;
-}
-
 void GLRenderTarget::AttachTexture(Texture& texture, const AttachmentDescriptor& attachmentDesc, GLenum& internalFormat)
 {
     /* Get OpenGL texture object */
@@ -322,34 +382,54 @@ void GLRenderTarget::AttachTexture(Texture& texture, const AttachmentDescriptor&
     ValidateMipResolution(texture, mipLevel);
 
     /* Make color or depth-stencil attachment */
-    internalFormat = static_cast<GLenum>(GetTexInternalFormat(textureGL));
+    internalFormat = textureGL.QueryGLInternalFormat();
     auto attachment = MakeFramebufferAttachment(internalFormat);
 
+    /* Keep track of transient attachments, whose content is invalidated after each render pass */
+    if ((textureGL.GetFlags() & TextureFlags::Transient) != 0)
+        transientAttachments_.push_back(attachment);
+
+    /* Attach consecutive array layers of texture to framebuffer for multiview rendering */
+    if (numViews_ > 1)
+    {
+        framebuffer_.AttachTextureMultiview(attachment, textureID, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer), numViews_);
+        return;
+    }
+
+    /* Attach all array layers of texture to framebuffer for layered rendering */
+    if (numLayers_ > 1)
+    {
+        if (attachmentDesc.arrayLayer != 0)
+            throw std::invalid_argument("cannot attach array layers of texture to layered GL render target with a first array layer other than 0");
+        framebuffer_.AttachTextureLayered(attachment, textureID, static_cast<GLint>(mipLevel));
+        return;
+    }
+
     /* Attach texture to framebuffer */
     switch (texture.GetType())
     {
         case TextureType::Texture1D:
-            GLFramebuffer::AttachTexture1D(attachment, GL_TEXTURE_1D, textureID, static_cast<GLint>(mipLevel));
+            framebuffer_.AttachTexture1D(attachment, GL_TEXTURE_1D, textureID, static_cast<GLint>(mipLevel));
             break;
         case TextureType::Texture2D:
-            GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_2D, textureID, static_cast<GLint>(mipLevel));
+            framebuffer_.AttachTexture2D(attachment, GL_TEXTURE_2D, textureID, static_cast<GLint>(mipLevel));
             break;
         case TextureType::Texture3D:
-            GLFramebuffer::AttachTexture3D(attachment, GL_TEXTURE_3D, textureID, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
+            framebuffer_.AttachTexture3D(attachment, GL_TEXTURE_3D, textureID, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
             break;
         case TextureType::TextureCube:
-            GLFramebuffer::AttachTexture2D(attachment, GLTypes::ToTextureCubeMap(attachmentDesc.arrayLayer), textureID, static_cast<GLint>(mipLevel));
+            framebuffer_.AttachTexture2D(attachment, GLTypes::ToTextureCubeMap(attachmentDesc.arrayLayer), textureID, static_cast<GLint>(mipLevel));
             break;
         case TextureType::Texture1DArray:
         case TextureType::Texture2DArray:
         case TextureType::TextureCubeArray:
-            GLFramebuffer::AttachTextureLayer(attachment, textureID, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
+            framebuffer_.AttachTextureLayer(attachment, textureID, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
             break;
         case TextureType::Texture2DMS:
-            GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_2D_MULTISAMPLE, textureID, 0);
+            framebuffer_.AttachTexture2D(attachment, GL_TEXTURE_2D_MULTISAMPLE, textureID, 0);
             break;
         case TextureType::Texture2DMSArray:
-            GLFramebuffer::AttachTextureLayer(attachment, textureID, 0, static_cast<GLint>(attachmentDesc.arrayLayer));
+            framebuffer_.AttachTextureLayer(attachment, textureID, 0, static_cast<GLint>(attachmentDesc.arrayLayer));
             break;
     }
 }
@@ -364,10 +444,10 @@ void GLRenderTarget::CreateRenderbuffersMS(const GLenum* internalFormats)
         CreateRenderbufferMS(colorAttachments_[i], internalFormats[i]);
 
     /* Set draw buffers for this framebuffer is multi-sampling is enabled */
-    SetDrawBuffers();
+    SetDrawBuffers(framebufferMS_);
 
     /* Validate framebuffer status */
-    ValidateFramebufferStatus("color attachments to multi-sample framebuffer object (FBO) failed");
+    ValidateFramebufferStatus(framebufferMS_, "color attachments to multi-sample framebuffer object (FBO) failed");
 }
 
 void GLRenderTarget::CreateRenderbufferMS(GLenum attachment, GLenum internalFormat)
@@ -379,7 +459,7 @@ void GLRenderTarget::CreateRenderbufferMS(GLenum attachment, GLenum internalForm
         InitRenderbufferStorage(renderbuffer, internalFormat);
 
         /* Attach renderbuffer to multi-sample framebuffer */
-        GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer.GetID());
+        framebufferMS_.AttachRenderbuffer(attachment, renderbuffer.GetID());
     }
     renderbuffersMS_.emplace_back(std::move(renderbuffer));
 }
@@ -394,7 +474,7 @@ void GLRenderTarget::InitRenderbufferStorage(GLRenderbuffer& renderbuffer, GLenu
     );
 }
 
-void GLRenderTarget::CreateAndAttachRenderbuffer(GLenum internalFormat, GLenum attachment)
+void GLRenderTarget::CreateAndAttachRenderbuffer(GLFramebuffer& framebuffer, GLenum internalFormat, GLenum attachment)
 {
     if (!renderbuffer_)
     {
@@ -405,7 +485,7 @@ void GLRenderTarget::CreateAndAttachRenderbuffer(GLenum internalFormat, GLenum a
         InitRenderbufferStorage(renderbuffer_, internalFormat);
 
         /* Attach renderbuffer to framebuffer (or multi-sample framebuffer if multi-sampling is used) */
-        GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer_.GetID());
+        framebuffer.AttachRenderbuffer(attachment, renderbuffer_.GetID());
     }
     else
         ErrDepthAttachmentFailed();
@@ -445,18 +525,13 @@ GLenum GLRenderTarget::MakeFramebufferAttachment(GLenum internalFormat)
     }
 }
 
-void GLRenderTarget::SetDrawBuffers()
+void GLRenderTarget::SetDrawBuffers(GLFramebuffer& framebuffer)
 {
     /*
     Tell OpenGL which buffers are to be written when drawing operations are performed.
     Each color attachment has its own draw buffer.
     */
-    if (colorAttachments_.empty())
-        glDrawBuffer(GL_NONE);
-    else if (colorAttachments_.size() == 1)
-        glDrawBuffer(colorAttachments_.front());
-    else
-        glDrawBuffers(static_cast<GLsizei>(colorAttachments_.size()), colorAttachments_.data());
+    framebuffer.DrawBuffers(static_cast<GLsizei>(colorAttachments_.size()), colorAttachments_.data());
 }
 
 bool GLRenderTarget::HasMultiSampling() const
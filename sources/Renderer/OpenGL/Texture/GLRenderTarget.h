@@ -41,33 +41,45 @@ class GLRenderTarget final : public RenderTarget
         // Blits the specified color attachment from the framebuffer onto the screen.
         void BlitOntoScreen(std::size_t colorAttachmentIndex);
 
+        // Resolves (or rather blits) the specified color attachment into the first MIP-map level and array layer of the specified texture.
+        void ResolveColorAttachment(std::uint32_t colorAttachment, const GLTexture& dstTexture);
+
         // Returns the active framebuffer (i.e. either the default framebuffer or the multi-sample framebuffer).
         const GLFramebuffer& GetFramebuffer() const;
 
+        // Invalidates the content of all attachments with textures that were created with TextureFlags::Transient. The primary framebuffer must be bound to GL_DRAW_FRAMEBUFFER.
+        void InvalidateTransientAttachments();
+
+        // Returns true if this render target has a multi-sample framebuffer, which is resolved when another render target is bound.
+        inline bool HasMultiSampleFramebuffer() const
+        {
+            return framebufferMS_.Valid();
+        }
+
     private:
 
         void CreateFramebufferWithAttachments(const RenderTargetDescriptor& desc);
         void CreateFramebufferWithNoAttachments(const RenderTargetDescriptor& desc);
 
         void AttachAllTextures(const std::vector<AttachmentDescriptor>& attachmentDescs, GLenum* internalFormats);
-        void AttachAllDepthStencilBuffers(const std::vector<AttachmentDescriptor>& attachmentDescs);
+        void AttachAllDepthStencilBuffers(GLFramebuffer& framebuffer, const std::vector<AttachmentDescriptor>& attachmentDescs);
 
-        void AttachDepthBuffer();
-        void AttachStencilBuffer();
-        void AttachDepthStencilBuffer();
+        void AttachDepthBuffer(GLFramebuffer& framebuffer);
+        void AttachStencilBuffer(GLFramebuffer& framebuffer);
+        void AttachDepthStencilBuffer(GLFramebuffer& framebuffer);
         void AttachTexture(Texture& texture, const AttachmentDescriptor& attachmentDesc, GLenum& internalFormat);
 
         void InitRenderbufferStorage(GLRenderbuffer& renderbuffer, GLenum internalFormat);
 
-        void CreateAndAttachRenderbuffer(GLenum internalFormat, GLenum attachment);
+        void CreateAndAttachRenderbuffer(GLFramebuffer& framebuffer, GLenum internalFormat, GLenum attachment);
 
         GLenum MakeFramebufferAttachment(GLenum internalFormat);
 
         void CreateRenderbuffersMS(const GLenum* internalFormats);
         void CreateRenderbufferMS(GLenum attachment, GLenum internalFormat);
 
-        // Sets the draw buffers for the currently bound FBO.
-        void SetDrawBuffers();
+        // Sets the draw buffers for the specified FBO.
+        void SetDrawBuffers(GLFramebuffer& framebuffer);
 
         bool HasMultiSampling() const;
         bool HasCustomMultiSampling() const;
@@ -79,6 +91,7 @@ class GLRenderTarget final : public RenderTarget
 
         GLFramebuffer               framebuffer_;   // primary FBO
         GLFramebuffer               framebufferMS_; // secondary FBO for multi-sampling
+        GLFramebuffer               framebufferResolve_; // FBO for explicit resolves, generated with the first call to 'ResolveColorAttachment'
 
         GLRenderbuffer              renderbuffer_;
 
@@ -90,8 +103,11 @@ class GLRenderTarget final : public RenderTarget
         std::vector<GLRenderbuffer> renderbuffersMS_;
 
         std::vector<GLenum>         colorAttachments_;
+        std::vector<GLenum>         transientAttachments_;  // Attachment points of textures with TextureFlags::Transient
 
         GLsizei                     multiSamples_       = 0;
+        GLsizei                     numViews_           = 0;
+        std::uint32_t               numLayers_          = 1;    // Number of array layers for layered rendering, or 1 if the render target is not layered
         GLbitfield                  blitMask_           = 0;
 
 };
@@ -8,6 +8,7 @@
 #include "GLRenderbuffer.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 
 
 namespace LLGL
@@ -39,7 +40,17 @@ GLRenderbuffer& GLRenderbuffer::operator = (GLRenderbuffer&& rhs)
 void GLRenderbuffer::GenRenderbuffer()
 {
     DeleteRenderbuffer();
-    glGenRenderbuffers(1, &id_);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create new renderbuffer object with initialized state (not required to bind it first) */
+        glCreateRenderbuffers(1, &id_);
+    }
+    else
+    #endif
+    {
+        glGenRenderbuffers(1, &id_);
+    }
 }
 
 void GLRenderbuffer::DeleteRenderbuffer()
@@ -54,14 +65,27 @@ void GLRenderbuffer::DeleteRenderbuffer()
 
 void GLRenderbuffer::Storage(GLenum internalFormat, GLsizei width, GLsizei height, GLsizei samples)
 {
-    /* Bind renderbuffer */
-    GLStateManager::active->BindRenderbuffer(id_);
-
-    /* Initialize renderbuffer storage */
-    if (samples > 1)
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, width, height);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Initialize renderbuffer storage directly using DSA */
+        if (samples > 1)
+            glNamedRenderbufferStorageMultisample(id_, samples, internalFormat, width, height);
+        else
+            glNamedRenderbufferStorage(id_, internalFormat, width, height);
+    }
     else
-        glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+    #endif
+    {
+        /* Bind renderbuffer */
+        GLStateManager::active->BindRenderbuffer(id_);
+
+        /* Initialize renderbuffer storage */
+        if (samples > 1)
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, width, height);
+        else
+            glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+    }
 }
 
 
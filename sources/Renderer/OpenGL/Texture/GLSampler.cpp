@@ -8,6 +8,7 @@
 #include "GLSampler.h"
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLTypes.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 #include "../RenderState/GLStateManager.h"
 
 
@@ -26,6 +27,14 @@ GLSampler::~GLSampler()
     GLStateManager::active->NotifySamplerRelease(id_);
 }
 
+void GLSampler::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+        glObjectLabel(GL_SAMPLER, GetID(), -1, name);
+    #endif
+}
+
 static GLenum GetGLSamplerMinFilter(const SamplerDescriptor& desc)
 {
     if (desc.mipMapping)
@@ -25,6 +25,8 @@ class GLSampler final : public Sampler
         GLSampler();
         ~GLSampler();
 
+        void SetName(const char* name) override;
+
         void SetDesc(const SamplerDescriptor& desc);
 
         //! Returns the hardware sampler ID.
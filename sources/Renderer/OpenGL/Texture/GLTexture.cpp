@@ -8,16 +8,19 @@
 #include "GLTexture.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../GLCommon/GLTypes.h"
+#include "../../GLCommon/GLCore.h"
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
-GLTexture::GLTexture(const TextureType type) :
-    Texture { type }
+GLTexture::GLTexture(const TextureType type, long flags) :
+    Texture { type  },
+    flags_  { flags }
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
@@ -31,6 +34,73 @@ GLTexture::GLTexture(const TextureType type) :
         /* Create new GL texture object (must be bound to a target before it can be used) */
         glGenTextures(1, &id_);
     }
+
+    /* Names of textures that have been deleted in other (shared) GL contexts can be reused, so the binding of that name might be out of date */
+    GLStateManager::active->NotifyTextureRelease(id_, GLStateManager::GetTextureTarget(GetType()));
+}
+
+GLTexture::GLTexture(const GLTexture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture { desc.type            },
+    flags_  { sharedTexture.flags_ }
+{
+    #ifdef GL_ARB_texture_view
+
+    if (!HasExtension(GLExt::ARB_texture_view))
+        throw std::runtime_error("texture views are not supported (GL_ARB_texture_view)");
+
+    /* Texture views require a new texture name that has never been bound, so 'glCreateTextures' cannot be used here */
+    glGenTextures(1, &id_);
+    GLStateManager::active->NotifyTextureRelease(id_, GLStateManager::GetTextureTarget(GetType()));
+
+    /*
+    Create texture view as storage alias from the shared texture.
+    Note: texture views can only be created with textures that have been allocated with glTexStorage!
+    */
+    glTextureView(
+        id_,
+        GLTypes::Map(desc.type),
+        sharedTexture.GetID(),
+        GLTypes::Map(desc.format),
+        desc.subresource.baseMipLevel,
+        desc.subresource.numMipLevels,
+        desc.subresource.baseArrayLayer,
+        desc.subresource.numArrayLayers
+    );
+
+    /* Initialize texture parameters of the view, which are not shared with the texture */
+    const GLint minFilter = (desc.subresource.numMipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Texture view has been initialized with its target by 'glTextureView', so it can be modified without binding it */
+        glTextureParameteri(id_, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(id_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(id_, GL_TEXTURE_SWIZZLE_R, GLTypes::Map(desc.swizzle.r));
+        glTextureParameteri(id_, GL_TEXTURE_SWIZZLE_G, GLTypes::Map(desc.swizzle.g));
+        glTextureParameteri(id_, GL_TEXTURE_SWIZZLE_B, GLTypes::Map(desc.swizzle.b));
+        glTextureParameteri(id_, GL_TEXTURE_SWIZZLE_A, GLTypes::Map(desc.swizzle.a));
+    }
+    else
+    #endif
+    {
+        GLStateManager::active->BindTexture(*this);
+
+        const auto target = GLTypes::Map(desc.type);
+
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_SWIZZLE_R, GLTypes::Map(desc.swizzle.r));
+        glTexParameteri(target, GL_TEXTURE_SWIZZLE_G, GLTypes::Map(desc.swizzle.g));
+        glTexParameteri(target, GL_TEXTURE_SWIZZLE_B, GLTypes::Map(desc.swizzle.b));
+        glTexParameteri(target, GL_TEXTURE_SWIZZLE_A, GLTypes::Map(desc.swizzle.a));
+    }
+
+    #else
+
+    throw std::runtime_error("texture views are not supported (GL_ARB_texture_view)");
+
+    #endif // /GL_ARB_texture_view
 }
 
 GLTexture::~GLTexture()
@@ -39,6 +109,14 @@ GLTexture::~GLTexture()
     GLStateManager::active->NotifyTextureRelease(id_, GLStateManager::GetTextureTarget(GetType()));
 }
 
+void GLTexture::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined LLGL_OPENGL
+    if (HasExtension(GLExt::KHR_debug))
+        glObjectLabel(GL_TEXTURE, GetID(), -1, name);
+    #endif
+}
+
 static GLenum GLGetTextureParamTarget(const TextureType type)
 {
     switch (type)
@@ -133,6 +211,79 @@ GLenum GLTexture::QueryGLInternalFormat() const
     return static_cast<GLenum>(internalFormat);
 }
 
+Format GLTexture::QueryImageFormat(ImageFormat& imageFormat, DataType& dataType) const
+{
+    Format format = Format::Undefined;
+    GLTypes::Unmap(format, QueryGLInternalFormat());
+
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format) || !FindSuitableImageFormat(format, imageFormat, dataType))
+        throw std::invalid_argument("cannot transfer texel data of texture with compressed, depth-stencil, or unknown format");
+
+    return format;
+}
+
+void GLTexture::GetTextureSubImage(const TextureRegion& region, const ImageFormat imageFormat, const DataType dataType, std::size_t sliceSize, void* data)
+{
+    #ifndef __APPLE__
+    if (HasExtension(GLExt::ARB_get_texture_sub_image))
+    {
+        glGetTextureSubImage(
+            id_,
+            static_cast<GLint>(region.mipLevel),
+            region.offset.x,
+            region.offset.y,
+            region.offset.z,
+            static_cast<GLsizei>(region.extent.width),
+            static_cast<GLsizei>(region.extent.height),
+            static_cast<GLsizei>(region.extent.depth),
+            GLTypes::Map(imageFormat),
+            GLTypes::Map(dataType),
+            static_cast<GLsizei>(sliceSize * region.extent.depth),
+            data
+        );
+    }
+    else
+    #endif
+    {
+        /* Without GL_ARB_get_texture_sub_image, only entire MIP-map levels (or entire cube faces) can be read */
+        const auto mipExtent    = QueryMipExtent(region.mipLevel);
+        const bool isCube       = (GetType() == TextureType::TextureCube);
+
+        if ( region.offset.x != 0 || region.offset.y != 0 || (!isCube && region.offset.z != 0) ||
+             region.extent.width != mipExtent.width || region.extent.height != mipExtent.height ||
+             (!isCube && region.extent.depth != mipExtent.depth) )
+        {
+            ErrUnsupportedGLProc("glGetTextureSubImage");
+        }
+
+        GLStateManager::active->BindTexture(*this);
+
+        if (isCube)
+        {
+            for (std::uint32_t face = 0; face < region.extent.depth; ++face)
+            {
+                glGetTexImage(
+                    GLTypes::ToTextureCubeMap(static_cast<std::uint32_t>(region.offset.z) + face),
+                    static_cast<GLint>(region.mipLevel),
+                    GLTypes::Map(imageFormat),
+                    GLTypes::Map(dataType),
+                    reinterpret_cast<char*>(data) + sliceSize * face
+                );
+            }
+        }
+        else
+        {
+            glGetTexImage(
+                GLTypes::Map(GetType()),
+                static_cast<GLint>(region.mipLevel),
+                GLTypes::Map(imageFormat),
+                GLTypes::Map(dataType),
+                data
+            );
+        }
+    }
+}
+
 
 /*
  * ======= Private: =======
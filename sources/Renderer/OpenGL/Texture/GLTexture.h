@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Texture.h>
+#include <LLGL/ImageFlags.h>
 #include "../OpenGL.h"
 
 
@@ -22,27 +23,50 @@ class GLTexture final : public Texture
 
     public:
 
-        GLTexture(const TextureType type);
+        GLTexture(const TextureType type, long flags);
+
+        // Creates a texture view that shares the immutable storage of the specified texture (requires GL_ARB_texture_view).
+        GLTexture(const GLTexture& sharedTexture, const TextureViewDescriptor& desc);
+
         ~GLTexture();
 
         Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
 
         TextureDescriptor QueryDesc() const override;
 
+        void SetName(const char* name) override;
+
         // Queries the GL_TEXTURE_INTERNAL_FORMAT parameter of this texture.
         GLenum QueryGLInternalFormat() const;
 
+        // Queries the hardware format and the matching image format and data type. Throws std::invalid_argument for compressed and depth-stencil formats.
+        Format QueryImageFormat(ImageFormat& imageFormat, DataType& dataType) const;
+
+        /*
+        Reads the texel data of the specified region into client memory, or into the pixel pack buffer that is currently bound.
+        'sliceSize' specifies the size (in bytes) of each slice within the output data, which is required to read cube faces one by one.
+        Without GL_ARB_get_texture_sub_image, only entire MIP-map levels (or entire cube faces) can be read.
+        */
+        void GetTextureSubImage(const TextureRegion& region, const ImageFormat imageFormat, const DataType dataType, std::size_t sliceSize, void* data);
+
         // Returns the hardware texture ID.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns the creation flags of this texture (see TextureFlags), which texture views inherit from their shared texture.
+        inline long GetFlags() const
+        {
+            return flags_;
+        }
+
     private:
 
         void QueryTexParams(GLint* internalFormat, GLint* extent) const;
 
-        GLuint id_ = 0;
+        GLuint  id_     = 0;
+        long    flags_  = 0;
 
 };
 
@@ -13,22 +13,22 @@
 extern "C"
 {
 
-LLGL_EXPORT int LLGL_RenderSystem_BuildID()
+LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, OpenGLES3)()
 {
     return LLGL_BUILD_ID;
 }
 
-LLGL_EXPORT int LLGL_RenderSystem_RendererID()
+LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, OpenGLES3)()
 {
     return LLGL::RendererID::OpenGLES3;
 }
 
-LLGL_EXPORT const char* LLGL_RenderSystem_Name()
+LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, OpenGLES3)()
 {
     return "OpenGL ES";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc)
+LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, OpenGLES3)(const void* renderSystemDesc)
 {
     return nullptr;//new LLGL::GLES3RenderSystem();
 }
@@ -0,0 +1,600 @@
+/*
+ * PipelineManifest.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/PipelineManifest.h>
+#include <LLGL/RenderSystem.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Header of a manifest file, followed by the entries, each with a 32-bit size and the encoded descriptor.
+struct PipelineManifestHeader
+{
+    char            magic[4];   // "LLPM"
+    std::uint32_t   version;    // Manifest format version, see 'g_manifestVersion'
+    std::uint32_t   numEntries;
+};
+
+static const char           g_manifestMagic[4]  = { 'L', 'L', 'P', 'M' };
+static const std::uint32_t  g_manifestVersion   = 2;
+
+// Tags of the encoded descriptors. Lower case tags refer to objects by pointer and are never recorded.
+static const char           g_tagGraphics       = 'G';
+static const char           g_tagCompute        = 'C';
+static const char           g_tagGraphicsLocal  = 'g';
+static const char           g_tagComputeLocal   = 'c';
+
+
+/*
+ * Internal functions
+ */
+
+template <typename T>
+static void EncodeValue(std::string& s, const T& value)
+{
+    s.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static void EncodeEnum(std::string& s, const T& value)
+{
+    EncodeValue(s, static_cast<std::uint32_t>(value));
+}
+
+static void EncodeBool(std::string& s, bool value)
+{
+    s.push_back(value ? 1 : 0);
+}
+
+// Decodes values from an encoded descriptor and keeps track of whether the descriptor was large enough.
+class PipelineDecoder
+{
+
+    public:
+
+        PipelineDecoder(const std::string& s) :
+            s_ { s }
+        {
+        }
+
+        template <typename T>
+        void Value(T& value)
+        {
+            if (pos_ + sizeof(value) <= s_.size())
+                ::memcpy(&value, &s_[pos_], sizeof(value));
+            else
+                valid_ = false;
+            pos_ += sizeof(value);
+        }
+
+        template <typename T>
+        void Enum(T& value)
+        {
+            std::uint32_t n = 0;
+            Value(n);
+            value = static_cast<T>(n);
+        }
+
+        void Bool(bool& value)
+        {
+            char c = 0;
+            Value(c);
+            value = (c != 0);
+        }
+
+        // Returns true if all values have been decoded and the entire descriptor has been consumed.
+        bool Finish() const
+        {
+            return (valid_ && pos_ == s_.size());
+        }
+
+    private:
+
+        const std::string&  s_;
+        std::size_t         pos_    = 1; // Skip tag
+        bool                valid_  = true;
+
+};
+
+static void EncodeStencilFace(std::string& s, const StencilFaceDescriptor& desc)
+{
+    EncodeEnum(s, desc.stencilFailOp);
+    EncodeEnum(s, desc.depthFailOp);
+    EncodeEnum(s, desc.depthPassOp);
+    EncodeEnum(s, desc.compareOp);
+    EncodeValue(s, desc.readMask);
+    EncodeValue(s, desc.writeMask);
+    EncodeValue(s, desc.reference);
+}
+
+static void DecodeStencilFace(PipelineDecoder& d, StencilFaceDescriptor& desc)
+{
+    d.Enum(desc.stencilFailOp);
+    d.Enum(desc.depthFailOp);
+    d.Enum(desc.depthPassOp);
+    d.Enum(desc.compareOp);
+    d.Value(desc.readMask);
+    d.Value(desc.writeMask);
+    d.Value(desc.reference);
+}
+
+// Encodes all states of the graphics pipeline descriptor except the object references.
+static void EncodeGraphicsStates(std::string& s, const GraphicsPipelineDescriptor& desc)
+{
+    EncodeEnum(s, desc.primitiveTopology);
+
+    EncodeValue(s, static_cast<std::uint32_t>(desc.viewports.size()));
+    for (const auto& viewport : desc.viewports)
+        EncodeValue(s, viewport);
+
+    EncodeValue(s, static_cast<std::uint32_t>(desc.scissors.size()));
+    for (const auto& scissor : desc.scissors)
+        EncodeValue(s, scissor);
+
+    EncodeBool(s, desc.depth.testEnabled);
+    EncodeBool(s, desc.depth.writeEnabled);
+    EncodeEnum(s, desc.depth.compareOp);
+    EncodeBool(s, desc.depth.boundsTestEnabled);
+    EncodeValue(s, desc.depth.boundsMin);
+    EncodeValue(s, desc.depth.boundsMax);
+
+    EncodeBool(s, desc.stencil.testEnabled);
+    EncodeStencilFace(s, desc.stencil.front);
+    EncodeStencilFace(s, desc.stencil.back);
+
+    EncodeEnum(s, desc.rasterizer.polygonMode);
+    EncodeEnum(s, desc.rasterizer.cullMode);
+    EncodeValue(s, desc.rasterizer.depthBias.constantFactor);
+    EncodeValue(s, desc.rasterizer.depthBias.slopeFactor);
+    EncodeValue(s, desc.rasterizer.depthBias.clamp);
+    EncodeBool(s, desc.rasterizer.multiSampling.enabled);
+    EncodeValue(s, desc.rasterizer.multiSampling.samples);
+    EncodeBool(s, desc.rasterizer.frontCCW);
+    EncodeBool(s, desc.rasterizer.depthClampEnabled);
+    EncodeBool(s, desc.rasterizer.scissorTestEnabled);
+    EncodeBool(s, desc.rasterizer.antiAliasedLineEnabled);
+    EncodeBool(s, desc.rasterizer.conservativeRasterization);
+    EncodeValue(s, desc.rasterizer.lineWidth);
+
+    EncodeBool(s, desc.blend.blendEnabled);
+    EncodeValue(s, desc.blend.blendFactor.r);
+    EncodeValue(s, desc.blend.blendFactor.g);
+    EncodeValue(s, desc.blend.blendFactor.b);
+    EncodeValue(s, desc.blend.blendFactor.a);
+    EncodeBool(s, desc.blend.alphaToCoverageEnabled);
+    EncodeEnum(s, desc.blend.logicOp);
+
+    EncodeValue(s, static_cast<std::uint32_t>(desc.blend.targets.size()));
+    for (const auto& target : desc.blend.targets)
+    {
+        EncodeEnum(s, target.srcColor);
+        EncodeEnum(s, target.dstColor);
+        EncodeEnum(s, target.colorArithmetic);
+        EncodeEnum(s, target.srcAlpha);
+        EncodeEnum(s, target.dstAlpha);
+        EncodeEnum(s, target.alphaArithmetic);
+        EncodeBool(s, target.colorMask.r);
+        EncodeBool(s, target.colorMask.g);
+        EncodeBool(s, target.colorMask.b);
+        EncodeBool(s, target.colorMask.a);
+    }
+
+    EncodeValue(s, static_cast<std::int64_t>(desc.dynamicStates));
+}
+
+static void DecodeGraphicsStates(PipelineDecoder& d, GraphicsPipelineDescriptor& desc)
+{
+    std::uint32_t n = 0;
+
+    d.Enum(desc.primitiveTopology);
+
+    d.Value(n);
+    desc.viewports.resize(std::min(n, 256u));
+    for (auto& viewport : desc.viewports)
+        d.Value(viewport);
+
+    d.Value(n);
+    desc.scissors.resize(std::min(n, 256u));
+    for (auto& scissor : desc.scissors)
+        d.Value(scissor);
+
+    d.Bool(desc.depth.testEnabled);
+    d.Bool(desc.depth.writeEnabled);
+    d.Enum(desc.depth.compareOp);
+    d.Bool(desc.depth.boundsTestEnabled);
+    d.Value(desc.depth.boundsMin);
+    d.Value(desc.depth.boundsMax);
+
+    d.Bool(desc.stencil.testEnabled);
+    DecodeStencilFace(d, desc.stencil.front);
+    DecodeStencilFace(d, desc.stencil.back);
+
+    d.Enum(desc.rasterizer.polygonMode);
+    d.Enum(desc.rasterizer.cullMode);
+    d.Value(desc.rasterizer.depthBias.constantFactor);
+    d.Value(desc.rasterizer.depthBias.slopeFactor);
+    d.Value(desc.rasterizer.depthBias.clamp);
+    d.Bool(desc.rasterizer.multiSampling.enabled);
+    d.Value(desc.rasterizer.multiSampling.samples);
+    d.Bool(desc.rasterizer.frontCCW);
+    d.Bool(desc.rasterizer.depthClampEnabled);
+    d.Bool(desc.rasterizer.scissorTestEnabled);
+    d.Bool(desc.rasterizer.antiAliasedLineEnabled);
+    d.Bool(desc.rasterizer.conservativeRasterization);
+    d.Value(desc.rasterizer.lineWidth);
+
+    d.Bool(desc.blend.blendEnabled);
+    d.Value(desc.blend.blendFactor.r);
+    d.Value(desc.blend.blendFactor.g);
+    d.Value(desc.blend.blendFactor.b);
+    d.Value(desc.blend.blendFactor.a);
+    d.Bool(desc.blend.alphaToCoverageEnabled);
+    d.Enum(desc.blend.logicOp);
+
+    d.Value(n);
+    desc.blend.targets.resize(std::min(n, 8u));
+    for (auto& target : desc.blend.targets)
+    {
+        d.Enum(target.srcColor);
+        d.Enum(target.dstColor);
+        d.Enum(target.colorArithmetic);
+        d.Enum(target.srcAlpha);
+        d.Enum(target.dstAlpha);
+        d.Enum(target.alphaArithmetic);
+        d.Bool(target.colorMask.r);
+        d.Bool(target.colorMask.g);
+        d.Bool(target.colorMask.b);
+        d.Bool(target.colorMask.a);
+    }
+
+    std::int64_t dynamicStates = 0;
+    d.Value(dynamicStates);
+    desc.dynamicStates = static_cast<long>(dynamicStates);
+}
+
+
+
+/*
+ * PipelineManifest class
+ */
+
+PipelineManifest::PipelineManifest(RenderSystem& renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+PipelineManifest::~PipelineManifest()
+{
+    for (auto pipeline : graphicsPipelines_)
+        renderSystem_.Release(*pipeline);
+    for (auto pipeline : computePipelines_)
+        renderSystem_.Release(*pipeline);
+}
+
+void PipelineManifest::RegisterShaderProgram(std::uint64_t id, ShaderProgram& shaderProgram)
+{
+    shaderPrograms_.Register(id, &shaderProgram);
+}
+
+void PipelineManifest::RegisterPipelineLayout(std::uint64_t id, PipelineLayout& pipelineLayout)
+{
+    pipelineLayouts_.Register(id, &pipelineLayout);
+}
+
+void PipelineManifest::RegisterRenderTarget(std::uint64_t id, RenderTarget& renderTarget)
+{
+    renderTargets_.Register(id, &renderTarget);
+}
+
+GraphicsPipeline* PipelineManifest::GetGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
+{
+    std::string key;
+    const bool recordable = EncodeGraphicsPipeline(desc, key);
+
+    /* Return previously created pipeline, or create a new one */
+    auto& entry = pipelines_[key];
+    if (entry.graphicsPipeline == nullptr)
+    {
+        entry.graphicsPipeline = renderSystem_.CreateGraphicsPipeline(desc);
+        graphicsPipelines_.push_back(entry.graphicsPipeline);
+    }
+
+    if (recordable)
+        RecordEntry(key);
+
+    return entry.graphicsPipeline;
+}
+
+ComputePipeline* PipelineManifest::GetComputePipeline(const ComputePipelineDescriptor& desc)
+{
+    std::string key;
+    const bool recordable = EncodeComputePipeline(desc, key);
+
+    /* Return previously created pipeline, or create a new one */
+    auto& entry = pipelines_[key];
+    if (entry.computePipeline == nullptr)
+    {
+        entry.computePipeline = renderSystem_.CreateComputePipeline(desc);
+        computePipelines_.push_back(entry.computePipeline);
+    }
+
+    if (recordable)
+        RecordEntry(key);
+
+    return entry.computePipeline;
+}
+
+std::size_t PipelineManifest::Prewarm()
+{
+    std::size_t numCreated = 0;
+
+    for (const auto& key : entries_)
+    {
+        auto& entry = pipelines_[key];
+        if (key[0] == g_tagGraphics && entry.graphicsPipeline == nullptr)
+        {
+            /* Create graphics pipeline in the background, if all objects it refers to are registered */
+            GraphicsPipelineDescriptor desc;
+            if (DecodeGraphicsPipeline(key, desc))
+            {
+                entry.graphicsPipeline = renderSystem_.CreateGraphicsPipelineAsync(desc);
+                graphicsPipelines_.push_back(entry.graphicsPipeline);
+                ++numCreated;
+            }
+        }
+        else if (key[0] == g_tagCompute && entry.computePipeline == nullptr)
+        {
+            /* Create compute pipeline, if all objects it refers to are registered */
+            ComputePipelineDescriptor desc;
+            if (DecodeComputePipeline(key, desc))
+            {
+                entry.computePipeline = renderSystem_.CreateComputePipeline(desc);
+                computePipelines_.push_back(entry.computePipeline);
+                ++numCreated;
+            }
+        }
+    }
+
+    return numCreated;
+}
+
+void PipelineManifest::Clear()
+{
+    for (auto& it : pipelines_)
+        it.second.recorded = false;
+    entries_.clear();
+}
+
+bool PipelineManifest::Save(const std::string& filename) const
+{
+    std::ofstream file { filename, std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Write header */
+    PipelineManifestHeader header;
+    {
+        ::memcpy(header.magic, g_manifestMagic, sizeof(g_manifestMagic));
+        header.version      = g_manifestVersion;
+        header.numEntries   = static_cast<std::uint32_t>(entries_.size());
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    /* Write entries */
+    for (const auto& key : entries_)
+    {
+        const auto size = static_cast<std::uint32_t>(key.size());
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(key.data(), static_cast<std::streamsize>(key.size()));
+    }
+
+    return file.good();
+}
+
+bool PipelineManifest::Load(const std::string& filename)
+{
+    std::ifstream file { filename, std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Read and validate header */
+    PipelineManifestHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_manifestMagic, sizeof(g_manifestMagic)) != 0 || header.version != g_manifestVersion)
+        return false;
+
+    /* Read all entries first, so an invalid file does not add any entries */
+    std::vector<std::string> keys;
+    keys.reserve(header.numEntries);
+
+    for (std::uint32_t i = 0; i < header.numEntries; ++i)
+    {
+        std::uint32_t size = 0;
+        if (!file.read(reinterpret_cast<char*>(&size), sizeof(size)) || size == 0)
+            return false;
+
+        std::string key(size, '\0');
+        if (!file.read(&key[0], static_cast<std::streamsize>(size)))
+            return false;
+
+        if (key[0] != g_tagGraphics && key[0] != g_tagCompute)
+            return false;
+
+        keys.push_back(std::move(key));
+    }
+
+    for (const auto& key : keys)
+        RecordEntry(key);
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void PipelineManifest::ObjectRegistry::Register(std::uint64_t id, void* obj)
+{
+    if (id == 0)
+        throw std::invalid_argument("cannot register object in pipeline manifest with zero identifier");
+
+    /* Replace previous object with the same identifier */
+    auto it = objects.find(id);
+    if (it != objects.end())
+        ids.erase(it->second);
+
+    objects[id] = obj;
+    ids[obj]    = id;
+}
+
+std::uint64_t PipelineManifest::ObjectRegistry::FindID(const void* obj) const
+{
+    auto it = ids.find(obj);
+    return (it != ids.end() ? it->second : 0);
+}
+
+void* PipelineManifest::ObjectRegistry::FindObject(std::uint64_t id) const
+{
+    auto it = objects.find(id);
+    return (it != objects.end() ? it->second : nullptr);
+}
+
+bool PipelineManifest::EncodeGraphicsPipeline(const GraphicsPipelineDescriptor& desc, std::string& key) const
+{
+    /* Find identifiers of all objects; null pointers are encoded as zero */
+    const auto shaderProgramID  = shaderPrograms_.FindID(desc.shaderProgram);
+    const auto pipelineLayoutID = (desc.pipelineLayout != nullptr ? pipelineLayouts_.FindID(desc.pipelineLayout) : 0);
+    const auto renderTargetID   = (desc.renderTarget != nullptr ? renderTargets_.FindID(desc.renderTarget) : 0);
+
+    const bool recordable =
+    (
+        shaderProgramID != 0 &&
+        (desc.pipelineLayout == nullptr || pipelineLayoutID != 0) &&
+        (desc.renderTarget == nullptr || renderTargetID != 0)
+    );
+
+    /* Encode object references by identifier, or by pointer if any object is not registered */
+    if (recordable)
+    {
+        key.push_back(g_tagGraphics);
+        EncodeValue(key, shaderProgramID);
+        EncodeValue(key, pipelineLayoutID);
+        EncodeValue(key, renderTargetID);
+    }
+    else
+    {
+        key.push_back(g_tagGraphicsLocal);
+        EncodeValue(key, desc.shaderProgram);
+        EncodeValue(key, desc.pipelineLayout);
+        EncodeValue(key, desc.renderTarget);
+    }
+
+    EncodeGraphicsStates(key, desc);
+
+    return recordable;
+}
+
+bool PipelineManifest::EncodeComputePipeline(const ComputePipelineDescriptor& desc, std::string& key) const
+{
+    /* Find identifiers of all objects; null pointers are encoded as zero */
+    const auto shaderProgramID  = shaderPrograms_.FindID(desc.shaderProgram);
+    const auto pipelineLayoutID = (desc.pipelineLayout != nullptr ? pipelineLayouts_.FindID(desc.pipelineLayout) : 0);
+
+    const bool recordable = (shaderProgramID != 0 && (desc.pipelineLayout == nullptr || pipelineLayoutID != 0));
+
+    /* Encode object references by identifier, or by pointer if any object is not registered */
+    if (recordable)
+    {
+        key.push_back(g_tagCompute);
+        EncodeValue(key, shaderProgramID);
+        EncodeValue(key, pipelineLayoutID);
+    }
+    else
+    {
+        key.push_back(g_tagComputeLocal);
+        EncodeValue(key, desc.shaderProgram);
+        EncodeValue(key, desc.pipelineLayout);
+    }
+
+    return recordable;
+}
+
+bool PipelineManifest::DecodeGraphicsPipeline(const std::string& key, GraphicsPipelineDescriptor& desc) const
+{
+    PipelineDecoder d { key };
+
+    std::uint64_t shaderProgramID = 0, pipelineLayoutID = 0, renderTargetID = 0;
+    d.Value(shaderProgramID);
+    d.Value(pipelineLayoutID);
+    d.Value(renderTargetID);
+
+    DecodeGraphicsStates(d, desc);
+
+    if (!d.Finish())
+        return false;
+
+    /* Resolve object references; all referenced objects must be registered */
+    desc.shaderProgram  = static_cast<ShaderProgram*>(shaderPrograms_.FindObject(shaderProgramID));
+    desc.pipelineLayout = static_cast<PipelineLayout*>(pipelineLayouts_.FindObject(pipelineLayoutID));
+    desc.renderTarget   = static_cast<RenderTarget*>(renderTargets_.FindObject(renderTargetID));
+
+    return
+    (
+        desc.shaderProgram != nullptr &&
+        (pipelineLayoutID == 0 || desc.pipelineLayout != nullptr) &&
+        (renderTargetID == 0 || desc.renderTarget != nullptr)
+    );
+}
+
+bool PipelineManifest::DecodeComputePipeline(const std::string& key, ComputePipelineDescriptor& desc) const
+{
+    PipelineDecoder d { key };
+
+    std::uint64_t shaderProgramID = 0, pipelineLayoutID = 0;
+    d.Value(shaderProgramID);
+    d.Value(pipelineLayoutID);
+
+    if (!d.Finish())
+        return false;
+
+    /* Resolve object references; all referenced objects must be registered */
+    desc.shaderProgram  = static_cast<ShaderProgram*>(shaderPrograms_.FindObject(shaderProgramID));
+    desc.pipelineLayout = static_cast<PipelineLayout*>(pipelineLayouts_.FindObject(pipelineLayoutID));
+
+    return (desc.shaderProgram != nullptr && (pipelineLayoutID == 0 || desc.pipelineLayout != nullptr));
+}
+
+void PipelineManifest::RecordEntry(const std::string& key)
+{
+    /* Record each descriptor only once */
+    auto it = pipelines_.find(key);
+    if (it == pipelines_.end() || !it->second.recorded)
+    {
+        pipelines_[key].recorded = true;
+        entries_.push_back(key);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,108 @@
+/*
+ * PresentThread.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "PresentThread.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+PresentThread::PresentThread(std::size_t capacity) :
+    capacity_ { std::max(capacity, std::size_t(1)) }
+{
+    thread_ = std::thread(&PresentThread::Run, this);
+}
+
+PresentThread::~PresentThread()
+{
+    {
+        std::unique_lock<std::mutex> lock { mutex_ };
+        taskDone_.wait(lock, [this]() { return (tasks_.empty() && !busy_); });
+        quit_ = true;
+    }
+    taskAvailable_.notify_one();
+    thread_.join();
+}
+
+void PresentThread::Enqueue(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> lock { mutex_ };
+        taskDone_.wait(lock, [this]() { return (tasks_.size() < capacity_); });
+        RethrowTaskException();
+        tasks_.emplace_back(std::move(task));
+    }
+    taskAvailable_.notify_one();
+}
+
+void PresentThread::Flush()
+{
+    std::unique_lock<std::mutex> lock { mutex_ };
+    taskDone_.wait(lock, [this]() { return (tasks_.empty() && !busy_); });
+    RethrowTaskException();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void PresentThread::Run()
+{
+    std::unique_lock<std::mutex> lock { mutex_ };
+    while (true)
+    {
+        taskAvailable_.wait(lock, [this]() { return (quit_ || !tasks_.empty()); });
+        if (quit_)
+            break;
+
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+
+        /* Execute task without holding the lock, unless a previous task has failed */
+        if (!exception_)
+        {
+            busy_ = true;
+            lock.unlock();
+
+            std::exception_ptr exception;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            lock.lock();
+            exception_  = exception;
+            busy_       = false;
+        }
+
+        taskDone_.notify_all();
+    }
+}
+
+void PresentThread::RethrowTaskException()
+{
+    if (exception_)
+    {
+        auto exception = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
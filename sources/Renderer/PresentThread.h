@@ -0,0 +1,81 @@
+/*
+ * PresentThread.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PRESENT_THREAD_H
+#define LLGL_PRESENT_THREAD_H
+
+
+#include <LLGL/Export.h>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Dedicated thread that executes the blocking part of RenderContext::Present (see RenderContextDescriptor::threadedPresent).
+Tasks are handed over with a bounded queue and executed in order. The first exception a task throws is rethrown by the next call to 'Enqueue' or 'Flush',
+and all subsequent tasks are discarded until then. The backends must call 'Flush' before they access anything the pending tasks use, e.g. the swap-chain.
+*/
+class LLGL_EXPORT PresentThread
+{
+
+    public:
+
+        // Starts the thread. 'capacity' specifies the maximum number of pending tasks, before 'Enqueue' blocks.
+        PresentThread(std::size_t capacity = 1);
+
+        // Waits until all pending tasks have been executed and joins the thread. Exceptions of pending tasks are discarded.
+        ~PresentThread();
+
+        PresentThread(const PresentThread&) = delete;
+        PresentThread& operator = (const PresentThread&) = delete;
+
+        // Hands the specified task over to the thread. Blocks while the queue is full.
+        void Enqueue(std::function<void()> task);
+
+        // Blocks until all pending tasks have been executed.
+        void Flush();
+
+    private:
+
+        void Run();
+
+        // Rethrows and clears the exception of a previous task, if any. The mutex must be locked.
+        void RethrowTaskException();
+
+    private:
+
+        std::size_t                         capacity_   = 1;
+        std::deque<std::function<void()>>   tasks_;
+        bool                                busy_       = false;    // Thread is currently executing a task
+        bool                                quit_       = false;
+        std::exception_ptr                  exception_;
+
+        std::mutex                          mutex_;
+        std::condition_variable             taskAvailable_;
+        std::condition_variable             taskDone_;
+        std::thread                         thread_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,44 @@
+/*
+ * QueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/QueryHeap.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static void ValidateQueryHeapDesc(const QueryHeapDescriptor& desc)
+{
+    if (desc.numQueries == 0)
+        throw std::invalid_argument("cannot create query heap with zero queries");
+
+    switch (desc.type)
+    {
+        case QueryType::SamplesPassed:
+        case QueryType::AnySamplesPassed:
+        case QueryType::AnySamplesPassedConservative:
+            break;
+        default:
+            throw std::invalid_argument("query heaps only support occlusion queries");
+    }
+}
+
+QueryHeap::QueryHeap(const QueryHeapDescriptor& desc) :
+    type_       { desc.type       },
+    numQueries_ { desc.numQueries }
+{
+    ValidateQueryHeapDesc(desc);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,177 @@
+/*
+ * ReleaseQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RELEASE_QUEUE_H
+#define LLGL_RELEASE_QUEUE_H
+
+
+#include "ContainerTypes.h"
+#include <functional>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Queue of hardware objects whose destruction is deferred until the GPU no longer references them.
+Released objects are pending until the next frame is submitted with 'Submit', which assigns the fence value of that frame to them,
+and they are destroyed with 'Collect' once the GPU has completed that fence value.
+Fence values must be monotonically increasing, and all work submitted before a fence value must be completed when that value is reached.
+Objects can be released from any thread, while 'Submit', 'Collect', and 'Clear' must be called from the thread that submits the frames.
+*/
+class ReleaseQueue
+{
+
+    public:
+
+        ReleaseQueue() = default;
+
+        ReleaseQueue(const ReleaseQueue&) = delete;
+        ReleaseQueue& operator = (const ReleaseQueue&) = delete;
+
+        // Takes the ownership of the specified entry from the container and defers its destruction. The entry must be null or refer to an object of type T (or a sub type).
+        template <typename T, typename TBase>
+        void Release(HWObjectContainer<T>& cont, const TBase* entry)
+        {
+            Release(cont, entry, [](T&) {});
+        }
+
+        // Same as above, but calls the specified function with the object right before it is destroyed (e.g. to release its device memory).
+        template <typename T, typename TBase, typename Finalizer>
+        void Release(HWObjectContainer<T>& cont, const TBase* entry, Finalizer finalizer)
+        {
+            if (auto object = cont.Take(static_cast<const T*>(entry)))
+            {
+                auto ptr = object.release();
+                std::lock_guard<std::mutex> guard { pendingMutex_ };
+                pending_.emplace_back(
+                    [ptr, finalizer]()
+                    {
+                        finalizer(*ptr);
+                        delete ptr;
+                    }
+                );
+            }
+        }
+
+        // Assigns the specified fence value to all objects that have been released since the previous call.
+        void Submit(std::uint64_t fenceValue)
+        {
+            std::lock_guard<std::mutex> guard { pendingMutex_ };
+            for (auto& entry : pending_)
+            {
+                entry.fenceValue = fenceValue;
+                submitted_.push_back(std::move(entry));
+            }
+            pending_.clear();
+        }
+
+        // Destroys all submitted objects whose fence value is less than or equal to the specified completed fence value.
+        void Collect(std::uint64_t completedFenceValue)
+        {
+            while (!submitted_.empty() && submitted_.front().fenceValue <= completedFenceValue)
+                submitted_.pop_front();
+        }
+
+        // Destroys all objects immediately. This must only be called when the GPU is idle.
+        void Clear()
+        {
+            submitted_.clear();
+            std::vector<Entry> pending;
+            {
+                std::lock_guard<std::mutex> guard { pendingMutex_ };
+                pending.swap(pending_);
+            }
+        }
+
+        // Returns true if there are objects that have not been submitted yet.
+        inline bool HasPending() const
+        {
+            std::lock_guard<std::mutex> guard { pendingMutex_ };
+            return !pending_.empty();
+        }
+
+    private:
+
+        // Move-only entry that destroys its object when the entry is destroyed.
+        class Entry
+        {
+
+            public:
+
+                Entry(std::function<void()>&& destroy) :
+                    destroy_ { std::move(destroy) }
+                {
+                }
+
+                Entry(Entry&& rhs) :
+                    fenceValue { rhs.fenceValue }
+                {
+                    destroy_.swap(rhs.destroy_);
+                }
+
+                Entry& operator = (Entry&& rhs)
+                {
+                    if (this != &rhs)
+                    {
+                        Destroy();
+                        fenceValue = rhs.fenceValue;
+                        destroy_.swap(rhs.destroy_);
+                    }
+                    return *this;
+                }
+
+                Entry(const Entry&) = delete;
+                Entry& operator = (const Entry&) = delete;
+
+                ~Entry()
+                {
+                    Destroy();
+                }
+
+            public:
+
+                std::uint64_t           fenceValue  = 0;
+
+            private:
+
+                void Destroy()
+                {
+                    if (destroy_)
+                    {
+                        destroy_();
+                        destroy_ = nullptr;
+                    }
+                }
+
+                std::function<void()>   destroy_;
+
+        };
+
+    private:
+
+        mutable std::mutex  pendingMutex_;  // Guards 'pending_' against concurrent releases
+        std::vector<Entry>  pending_;       // Objects released since the last submission
+        std::deque<Entry>   submitted_;     // Objects in order of their fence values
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
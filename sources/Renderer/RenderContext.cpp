@@ -11,6 +11,7 @@
 #include <LLGL/Display.h>
 #include "CheckedCast.h"
 #include "../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -23,6 +24,66 @@ RenderContext::RenderContext(const VideoModeDescriptor& initialVideoMode, const
 {
 }
 
+void RenderContext::WaitForNextFrame()
+{
+    // dummy
+}
+
+bool RenderContext::QueryFrameStatistics(FrameStatistics& frameStats)
+{
+    FrameStatistics current;
+    if (!OnQueryFrameStatistics(current))
+        return false;
+
+    const auto& prev = frameStats_;
+
+    /* Derive refresh duration from the vertical blanks since the previous query if the renderer does not provide it */
+    if (current.refreshDuration == 0)
+    {
+        if (prev.syncTime > 0 && current.syncTime > prev.syncTime && current.syncRefreshCount > prev.syncRefreshCount)
+            current.refreshDuration = (current.syncTime - prev.syncTime) / (current.syncRefreshCount - prev.syncRefreshCount);
+        else
+            current.refreshDuration = prev.refreshDuration;
+    }
+
+    /* Estimate present time from the most recent vertical blank if the renderer does not provide it */
+    if (current.presentTime == 0 && current.presentRefreshCount > 0 && current.syncTime > 0 && current.refreshDuration > 0)
+    {
+        if (current.syncRefreshCount >= current.presentRefreshCount)
+            current.presentTime = current.syncTime - (current.syncRefreshCount - current.presentRefreshCount) * current.refreshDuration;
+    }
+
+    /* Accumulate missed vertical blanks, since each frame is expected to be displayed 'interval' refresh cycles after its predecessor */
+    current.missedVblanks = prev.missedVblanks;
+
+    if (prev.presentID > 0 && current.presentID > prev.presentID)
+    {
+        std::uint64_t numRefreshes = 0;
+
+        if (prev.presentRefreshCount > 0 && current.presentRefreshCount > prev.presentRefreshCount)
+            numRefreshes = current.presentRefreshCount - prev.presentRefreshCount;
+        else if (prev.presentTime > 0 && current.presentTime > prev.presentTime && current.refreshDuration > 0)
+            numRefreshes = (current.presentTime - prev.presentTime + current.refreshDuration / 2) / current.refreshDuration;
+        else if (prev.syncRefreshCount > 0 && current.syncRefreshCount > prev.syncRefreshCount)
+            numRefreshes = current.syncRefreshCount - prev.syncRefreshCount;
+
+        const auto interval         = static_cast<std::uint64_t>(vsyncDesc_.enabled ? std::max(1u, vsyncDesc_.interval) : 1u);
+        const auto numExpected      = (current.presentID - prev.presentID) * interval;
+
+        if (numRefreshes > numExpected)
+            current.missedVblanks += numRefreshes - numExpected;
+    }
+
+    /* Only move on to the new statistics when another frame reached the display, so the refreshes in between are accumulated */
+    if (prev.presentID == 0 || current.presentID != prev.presentID)
+        frameStats_ = current;
+    else
+        frameStats_.refreshDuration = current.refreshDuration;
+
+    frameStats = current;
+    return true;
+}
+
 static bool IsVideoModeValid(const VideoModeDescriptor& videoModeDesc)
 {
     return (videoModeDesc.resolution.width > 0 && videoModeDesc.resolution.height > 0 && videoModeDesc.swapChainSize > 0);
@@ -60,6 +121,12 @@ bool RenderContext::SetVsync(const VsyncDescriptor& vsyncDesc)
  * ======= Protected: =======
  */
 
+bool RenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    /* Frame statistics are not supported by default */
+    return false;
+}
+
 void RenderContext::SetOrCreateSurface(const std::shared_ptr<Surface>& surface, VideoModeDescriptor videoModeDesc, const void* windowContext)
 {
     if (surface)
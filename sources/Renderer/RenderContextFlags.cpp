@@ -40,7 +40,8 @@ LLGL_EXPORT bool operator == (const VideoModeDescriptor& lhs, const VideoModeDes
         LLGL_COMPARE_MEMBER_EQ( depthBits         ) &&
         LLGL_COMPARE_MEMBER_EQ( stencilBits       ) &&
         LLGL_COMPARE_MEMBER_EQ( fullscreen        ) &&
-        LLGL_COMPARE_MEMBER_EQ( swapChainSize     )
+        LLGL_COMPARE_MEMBER_EQ( swapChainSize     ) &&
+        LLGL_COMPARE_MEMBER_EQ( presentMode       )
     );
 }
 
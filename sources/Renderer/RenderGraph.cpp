@@ -0,0 +1,395 @@
+/*
+ * RenderGraph.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderGraph.h>
+#include <LLGL/RenderSystem.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+RenderGraph::RenderGraph(RenderSystem& renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+    ReleaseResources();
+}
+
+std::uint32_t RenderGraph::DeclareTexture(const TextureDescriptor& textureDesc)
+{
+    AssertNotCompiled(__FUNCTION__);
+
+    TransientTexture transient;
+    {
+        transient.desc          = textureDesc;
+        transient.desc.flags    |= TextureFlags::AttachmentUsage;
+    }
+    transientTextures_.push_back(transient);
+
+    return static_cast<std::uint32_t>(transientTextures_.size() - 1);
+}
+
+void RenderGraph::ExportTexture(std::uint32_t texture)
+{
+    AssertNotCompiled(__FUNCTION__);
+    GetTransientTexture(texture);
+    transientTextures_[texture].exported = true;
+}
+
+void RenderGraph::AddPass(const RenderGraphPassDescriptor& passDesc)
+{
+    AssertNotCompiled(__FUNCTION__);
+
+    if (!passDesc.execute)
+        throw std::invalid_argument("cannot add render graph pass without execute callback");
+    if (passDesc.renderContext == nullptr && passDesc.colorAttachments.empty() && passDesc.depthStencilAttachment == Constants::invalidRenderGraphTexture)
+        throw std::invalid_argument("cannot add render graph pass without any attachments or render context");
+
+    const auto pass = static_cast<std::uint32_t>(passes_.size());
+
+    /* Inputs must have been written by an earlier pass, before this pass writes any attachment */
+    for (auto texture : passDesc.inputs)
+    {
+        if (!GetTransientTexture(texture).written)
+            throw std::invalid_argument("render graph pass reads texture " + std::to_string(texture) + " before it has been written");
+        UseTexture(texture, pass, false);
+    }
+
+    if (passDesc.renderContext == nullptr)
+    {
+        for (auto texture : passDesc.colorAttachments)
+            UseTexture(texture, pass, true);
+        if (passDesc.depthStencilAttachment != Constants::invalidRenderGraphTexture)
+            UseTexture(passDesc.depthStencilAttachment, pass, true);
+    }
+
+    Pass passEntry;
+    {
+        passEntry.desc = passDesc;
+    }
+    passes_.push_back(passEntry);
+}
+
+void RenderGraph::Compile()
+{
+    if (compiled_)
+        return;
+
+    AssignPhysicalTextures();
+
+    for (std::uint32_t pass = 0; pass < passes_.size(); ++pass)
+        CreatePassResources(pass);
+
+    compiled_ = true;
+}
+
+void RenderGraph::Execute(CommandBuffer& commandBuffer)
+{
+    if (!compiled_)
+        throw std::logic_error("cannot execute render graph that has not been compiled");
+
+    for (auto& pass : passes_)
+    {
+        const auto& desc = pass.desc;
+
+        const auto numClearValues   = (desc.clear ? static_cast<std::uint32_t>(desc.clearValues.size()) : 0u);
+        const auto clearValues      = (numClearValues > 0 ? desc.clearValues.data() : nullptr);
+
+        if (desc.renderContext != nullptr)
+            commandBuffer.BeginRenderPass(*desc.renderContext, pass.renderPass, numClearValues, clearValues);
+        else
+            commandBuffer.BeginRenderPass(*pass.renderTarget, pass.renderPass, numClearValues, clearValues);
+        {
+            desc.execute(commandBuffer);
+        }
+        commandBuffer.EndRenderPass();
+    }
+}
+
+void RenderGraph::Reset()
+{
+    ReleaseResources();
+    transientTextures_.clear();
+    passes_.clear();
+    compiled_ = false;
+}
+
+Texture* RenderGraph::GetTexture(std::uint32_t texture) const
+{
+    if (!compiled_)
+        throw std::logic_error("cannot query texture of render graph that has not been compiled");
+    if (!GetTransientTexture(texture).written)
+        throw std::invalid_argument("cannot query texture " + std::to_string(texture) + " that is never written by any render graph pass");
+    return GetPhysicalTexture(texture);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void RenderGraph::AssertNotCompiled(const char* funcName) const
+{
+    if (compiled_)
+        throw std::logic_error("cannot modify render graph after it has been compiled (in '" + std::string(funcName) + "')");
+}
+
+const RenderGraph::TransientTexture& RenderGraph::GetTransientTexture(std::uint32_t texture) const
+{
+    if (texture >= transientTextures_.size())
+        throw std::invalid_argument("invalid render graph texture identifier: " + std::to_string(texture));
+    return transientTextures_[texture];
+}
+
+Texture* RenderGraph::GetPhysicalTexture(std::uint32_t texture) const
+{
+    return physicalTextures_[transientTextures_[texture].physical].texture;
+}
+
+void RenderGraph::UseTexture(std::uint32_t texture, std::uint32_t pass, bool write)
+{
+    GetTransientTexture(texture);
+
+    auto& transient = transientTextures_[texture];
+    if (!transient.written)
+    {
+        if (write)
+        {
+            transient.firstPass = pass;
+            transient.written   = true;
+        }
+    }
+    transient.lastPass = pass;
+}
+
+// Returns true if the specified textures can share the same physical texture.
+static bool AreTextureDescsCompatible(const TextureDescriptor& lhs, const TextureDescriptor& rhs)
+{
+    return
+    (
+        lhs.type                == rhs.type                 &&
+        lhs.format              == rhs.format               &&
+        lhs.flags               == rhs.flags                &&
+        lhs.extent.width        == rhs.extent.width         &&
+        lhs.extent.height       == rhs.extent.height        &&
+        lhs.extent.depth        == rhs.extent.depth         &&
+        lhs.arrayLayers         == rhs.arrayLayers          &&
+        lhs.mipLevels           == rhs.mipLevels            &&
+        lhs.samples             == rhs.samples
+    );
+}
+
+void RenderGraph::AssignPhysicalTextures()
+{
+    const auto endOfGraph = static_cast<std::uint32_t>(passes_.size());
+
+    /* Process transient textures in the order of their first use */
+    std::vector<std::uint32_t> order;
+    order.reserve(transientTextures_.size());
+
+    for (std::uint32_t i = 0; i < transientTextures_.size(); ++i)
+    {
+        if (transientTextures_[i].written)
+            order.push_back(i);
+    }
+
+    std::stable_sort(
+        order.begin(),
+        order.end(),
+        [this](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (transientTextures_[lhs].firstPass < transientTextures_[rhs].firstPass);
+        }
+    );
+
+    for (auto i : order)
+    {
+        auto& transient = transientTextures_[i];
+        const auto lastPass = (transient.exported ? endOfGraph : transient.lastPass);
+
+        /* Find physical texture whose lifetime has ended before this transient texture is written for the first time */
+        auto physical = static_cast<std::uint32_t>(physicalTextures_.size());
+
+        for (std::uint32_t j = 0; j < physicalTextures_.size(); ++j)
+        {
+            const auto& other = physicalTextures_[j];
+            if (other.lastPass < transient.firstPass && AreTextureDescsCompatible(other.desc, transient.desc))
+            {
+                physical = j;
+                break;
+            }
+        }
+
+        if (physical == physicalTextures_.size())
+        {
+            PhysicalTexture physicalTexture;
+            {
+                physicalTexture.desc    = transient.desc;
+                physicalTexture.texture = renderSystem_.CreateTexture(transient.desc);
+            }
+            physicalTextures_.push_back(physicalTexture);
+        }
+
+        physicalTextures_[physical].lastPass = lastPass;
+        transient.physical = physical;
+    }
+}
+
+AttachmentOpsDescriptor RenderGraph::GetAttachmentOps(std::uint32_t texture, std::uint32_t pass) const
+{
+    const auto& transient   = transientTextures_[texture];
+    const auto& desc        = passes_[pass].desc;
+
+    AttachmentOpsDescriptor ops;
+    {
+        /* Don't load the previous content when the attachment is written for the first time, since it might belong to an aliased texture */
+        if (transient.firstPass == pass)
+            ops.loadOp = (desc.clear ? AttachmentLoadOp::Clear : AttachmentLoadOp::Undefined);
+
+        /* Don't store the content when the attachment is not used by any later pass */
+        if (transient.lastPass == pass && !transient.exported)
+            ops.storeOp = AttachmentStoreOp::Undefined;
+    }
+    return ops;
+}
+
+RenderPassDescriptor RenderGraph::GetRenderPassDesc(std::uint32_t pass) const
+{
+    const auto& desc = passes_[pass].desc;
+
+    RenderPassDescriptor renderPassDesc;
+
+    if (desc.renderContext != nullptr)
+    {
+        /* Load render context only if it has been written by an earlier pass */
+        auto firstContextPass = std::find_if(
+            passes_.begin(),
+            passes_.end(),
+            [&desc](const Pass& other)
+            {
+                return (other.desc.renderContext == desc.renderContext);
+            }
+        );
+
+        if (firstContextPass == passes_.begin() + pass)
+        {
+            AttachmentOpsDescriptor ops;
+            ops.loadOp = (desc.clear ? AttachmentLoadOp::Clear : AttachmentLoadOp::Undefined);
+
+            renderPassDesc.colorAttachments     = { ops };
+            renderPassDesc.depthAttachment      = ops;
+            renderPassDesc.stencilAttachment    = ops;
+        }
+    }
+    else
+    {
+        for (auto texture : desc.colorAttachments)
+            renderPassDesc.colorAttachments.push_back(GetAttachmentOps(texture, pass));
+
+        if (desc.depthStencilAttachment != Constants::invalidRenderGraphTexture)
+        {
+            renderPassDesc.depthAttachment      = GetAttachmentOps(desc.depthStencilAttachment, pass);
+            renderPassDesc.stencilAttachment    = renderPassDesc.depthAttachment;
+        }
+    }
+
+    return renderPassDesc;
+}
+
+// Returns the attachment type for the specified depth-stencil format.
+static AttachmentType GetDepthStencilAttachmentType(const Format format)
+{
+    switch (format)
+    {
+        case Format::D24UNormS8UInt:
+        case Format::D32FloatS8X24UInt:
+            return AttachmentType::DepthStencil;
+        default:
+            return AttachmentType::Depth;
+    }
+}
+
+void RenderGraph::CreatePassResources(std::uint32_t pass)
+{
+    auto& passEntry = passes_[pass];
+    const auto& desc = passEntry.desc;
+
+    passEntry.renderPass = renderSystem_.CreateRenderPass(GetRenderPassDesc(pass));
+
+    if (desc.renderContext == nullptr)
+    {
+        /* Create render target with the physical textures of all attachments */
+        RenderTargetDescriptor renderTargetDesc;
+
+        for (auto texture : desc.colorAttachments)
+        {
+            renderTargetDesc.attachments.push_back(
+                AttachmentDescriptor { AttachmentType::Color, GetPhysicalTexture(texture) }
+            );
+        }
+
+        if (desc.depthStencilAttachment != Constants::invalidRenderGraphTexture)
+        {
+            const auto& transient = transientTextures_[desc.depthStencilAttachment];
+            renderTargetDesc.attachments.push_back(
+                AttachmentDescriptor { GetDepthStencilAttachmentType(transient.desc.format), GetPhysicalTexture(desc.depthStencilAttachment) }
+            );
+        }
+
+        /* Derive resolution and multi-sampling from the first attachment */
+        const auto& firstDesc = transientTextures_[
+            desc.colorAttachments.empty() ? desc.depthStencilAttachment : desc.colorAttachments.front()
+        ].desc;
+
+        renderTargetDesc.resolution = { firstDesc.extent.width, firstDesc.extent.height };
+
+        if (IsMultiSampleTexture(firstDesc.type))
+        {
+            renderTargetDesc.multiSampling          = MultiSamplingDescriptor { firstDesc.samples };
+            renderTargetDesc.customMultiSampling    = true;
+        }
+
+        passEntry.renderTarget = renderSystem_.CreateRenderTarget(renderTargetDesc);
+    }
+}
+
+void RenderGraph::ReleaseResources()
+{
+    for (auto& pass : passes_)
+    {
+        if (pass.renderTarget != nullptr)
+        {
+            renderSystem_.Release(*pass.renderTarget);
+            pass.renderTarget = nullptr;
+        }
+        if (pass.renderPass != nullptr)
+        {
+            renderSystem_.Release(*pass.renderPass);
+            pass.renderPass = nullptr;
+        }
+    }
+
+    for (auto& physical : physicalTextures_)
+        renderSystem_.Release(*physical.texture);
+
+    physicalTextures_.clear();
+    compiled_ = false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,388 @@
+/*
+ * RenderModuleCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "RenderModuleCache.h"
+#include <LLGL/RenderSystem.h>
+#include "BuildID.h"
+#include "../Platform/Module.h"
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- File format ----- */
+
+// Magic number of the cache file ("LLMC")
+static const std::uint32_t g_cacheFileMagic     = 0x434D4C4C;
+static const std::uint32_t g_cacheFileVersion   = 1;
+
+/*
+Header of the cache file. All entries are invalidated if the build ID or the layout of the capability structures change.
+The header is followed by 'numEntries' entries, each with the module name, module file size, renderer info, and capabilities.
+*/
+struct CacheFileHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int32_t  buildID;
+    std::uint32_t featuresSize;
+    std::uint32_t limitsSize;
+    std::uint32_t numEntries;
+};
+
+template <typename T>
+static void WriteValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(std::istream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return stream.good();
+}
+
+static void WriteString(std::ostream& stream, const std::string& s)
+{
+    WriteValue(stream, static_cast<std::uint32_t>(s.size()));
+    stream.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+static bool ReadString(std::istream& stream, std::string& s)
+{
+    std::uint32_t size = 0;
+    if (!ReadValue(stream, size) || size > 0xFFFF)
+        return false;
+    s.resize(size);
+    stream.read(&s[0], static_cast<std::streamsize>(size));
+    return stream.good();
+}
+
+template <typename T>
+static void WriteEnumArray(std::ostream& stream, const std::vector<T>& values)
+{
+    WriteValue(stream, static_cast<std::uint32_t>(values.size()));
+    for (auto value : values)
+        WriteValue(stream, static_cast<std::uint32_t>(value));
+}
+
+template <typename T>
+static bool ReadEnumArray(std::istream& stream, std::vector<T>& values)
+{
+    std::uint32_t size = 0;
+    if (!ReadValue(stream, size) || size > 0xFFFF)
+        return false;
+    values.resize(size);
+    for (auto& value : values)
+    {
+        std::uint32_t v = 0;
+        if (!ReadValue(stream, v))
+            return false;
+        value = static_cast<T>(v);
+    }
+    return true;
+}
+
+// Returns the size of the file of the specified module, or 0 if it does not exist or if the module is linked statically.
+static std::uint64_t GetModuleFileSize(const std::string& moduleName)
+{
+    #ifdef LLGL_BUILD_STATIC_LIB
+    return 0;
+    #else
+    std::ifstream file { Module::GetModuleFilename(moduleName), (std::ios_base::binary | std::ios_base::ate) };
+    if (file.good())
+    {
+        auto size = file.tellg();
+        if (size > 0)
+            return static_cast<std::uint64_t>(size);
+    }
+    return 0;
+    #endif
+}
+
+
+/* ----- RenderModuleCache class ----- */
+
+RenderModuleCache& RenderModuleCache::Get()
+{
+    static RenderModuleCache instance;
+    return instance;
+}
+
+std::vector<std::string> RenderModuleCache::FindModules(const std::vector<std::string>& knownModules)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Gather modules that have neither been probed in this process nor been cached for their current module file */
+    std::vector<std::string> pendingModules;
+    for (const auto& m : knownModules)
+    {
+        if (std::find(probedModules_.begin(), probedModules_.end(), m) != probedModules_.end())
+            continue;
+
+        if (auto entry = FindEntry(m))
+        {
+            if (entry->moduleFileSize != 0 && entry->moduleFileSize == GetModuleFileSize(m))
+            {
+                probedModules_.push_back(m);
+                probedAvailable_.push_back(true);
+                continue;
+            }
+        }
+
+        pendingModules.push_back(m);
+    }
+
+    /* Probe all pending modules in parallel */
+    if (!pendingModules.empty())
+    {
+        std::unique_ptr<bool[]> available { new bool[pendingModules.size()] };
+
+        ThreadPool::Get().ParallelFor(
+            pendingModules.size(),
+            1,
+            pendingModules.size(),
+            [&pendingModules, &available](std::size_t begin, std::size_t end)
+            {
+                for (auto i = begin; i < end; ++i)
+                    available[i] = Module::IsAvailable(Module::GetModuleFilename(pendingModules[i]));
+            }
+        );
+
+        for (std::size_t i = 0; i < pendingModules.size(); ++i)
+        {
+            probedModules_.push_back(pendingModules[i]);
+            probedAvailable_.push_back(available[i]);
+        }
+    }
+
+    /* Return available modules in the order of the known modules */
+    std::vector<std::string> modules;
+
+    for (const auto& m : knownModules)
+    {
+        auto it = std::find(probedModules_.begin(), probedModules_.end(), m);
+        if (it != probedModules_.end() && probedAvailable_[static_cast<std::size_t>(it - probedModules_.begin())])
+            modules.push_back(m);
+    }
+
+    return modules;
+}
+
+void RenderModuleCache::SetFilename(const std::string& filename)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    filename_ = filename;
+    entries_.clear();
+    if (!filename_.empty())
+        ReadFile();
+}
+
+bool RenderModuleCache::Query(const std::string& moduleName, RendererInfo* info, RenderingCapabilities* caps)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    if (auto entry = FindEntry(moduleName))
+    {
+        /* Ignore entries of modules that have been modified since they were cached */
+        if (entry->moduleFileSize == GetModuleFileSize(moduleName))
+        {
+            if (info != nullptr)
+                *info = entry->info;
+            if (caps != nullptr)
+                *caps = entry->caps;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool IsEqualRendererInfo(const RendererInfo& lhs, const RendererInfo& rhs)
+{
+    return
+    (
+        lhs.rendererName        == rhs.rendererName         &&
+        lhs.deviceName          == rhs.deviceName           &&
+        lhs.vendorName          == rhs.vendorName           &&
+        lhs.shadingLanguageName == rhs.shadingLanguageName
+    );
+}
+
+// Compares the capabilities bytewise; differences in padding bytes only lead to a redundant write of the cache file
+static bool IsEqualRenderingCaps(const RenderingCapabilities& lhs, const RenderingCapabilities& rhs)
+{
+    return
+    (
+        lhs.screenOrigin        == rhs.screenOrigin         &&
+        lhs.clippingRange       == rhs.clippingRange        &&
+        lhs.shadingLanguages    == rhs.shadingLanguages     &&
+        lhs.textureFormats      == rhs.textureFormats       &&
+        std::memcmp(&lhs.features, &rhs.features, sizeof(RenderingFeatures)) == 0 &&
+        std::memcmp(&lhs.limits, &rhs.limits, sizeof(RenderingLimits)) == 0
+    );
+}
+
+void RenderModuleCache::Store(const std::string& moduleName, const RenderSystem& renderSystem)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* A module that has been loaded successfully is available */
+    auto it = std::find(probedModules_.begin(), probedModules_.end(), moduleName);
+    if (it == probedModules_.end())
+    {
+        probedModules_.push_back(moduleName);
+        probedAvailable_.push_back(true);
+    }
+    else
+        probedAvailable_[static_cast<std::size_t>(it - probedModules_.begin())] = true;
+
+    if (filename_.empty())
+        return;
+
+    /* Ignore renderers whose info is not available yet, e.g. OpenGL before its first render context has been created */
+    const auto& info = renderSystem.GetRendererInfo();
+    if (info.rendererName.empty())
+        return;
+
+    const auto& caps = renderSystem.GetRenderingCaps();
+
+    /* Only update cache file if the entry has changed, e.g. after a driver update */
+    const auto moduleFileSize = GetModuleFileSize(moduleName);
+
+    auto entry = FindEntry(moduleName);
+    if (entry != nullptr)
+    {
+        if (entry->moduleFileSize == moduleFileSize && IsEqualRendererInfo(entry->info, info) && IsEqualRenderingCaps(entry->caps, caps))
+            return;
+    }
+    else
+    {
+        entries_.push_back({});
+        entry = &(entries_.back());
+        entry->moduleName = moduleName;
+    }
+
+    entry->moduleFileSize   = moduleFileSize;
+    entry->info             = info;
+    entry->caps             = caps;
+
+    WriteFile();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+RenderModuleCache::Entry* RenderModuleCache::FindEntry(const std::string& moduleName)
+{
+    for (auto& entry : entries_)
+    {
+        if (entry.moduleName == moduleName)
+            return &entry;
+    }
+    return nullptr;
+}
+
+void RenderModuleCache::ReadFile()
+{
+    std::ifstream file { filename_, std::ios_base::binary };
+    if (!file.good())
+        return;
+
+    /* Discard entire cache if the header does not match this build */
+    CacheFileHeader header;
+    if (!ReadValue(file, header))
+        return;
+
+    if (header.magic        != g_cacheFileMagic         ||
+        header.version      != g_cacheFileVersion       ||
+        header.buildID      != LLGL_BUILD_ID            ||
+        header.featuresSize != sizeof(RenderingFeatures) ||
+        header.limitsSize   != sizeof(RenderingLimits))
+    {
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < header.numEntries; ++i)
+    {
+        Entry entry;
+
+        std::int32_t screenOrigin = 0, clippingRange = 0;
+
+        if (!ReadString(file, entry.moduleName)                     ||
+            !ReadValue(file, entry.moduleFileSize)                  ||
+            !ReadString(file, entry.info.rendererName)              ||
+            !ReadString(file, entry.info.deviceName)                ||
+            !ReadString(file, entry.info.vendorName)                ||
+            !ReadString(file, entry.info.shadingLanguageName)       ||
+            !ReadValue(file, screenOrigin)                          ||
+            !ReadValue(file, clippingRange)                         ||
+            !ReadEnumArray(file, entry.caps.shadingLanguages)       ||
+            !ReadEnumArray(file, entry.caps.textureFormats)         ||
+            !ReadValue(file, entry.caps.features)                   ||
+            !ReadValue(file, entry.caps.limits))
+        {
+            /* Discard all entries of a corrupted cache file */
+            entries_.clear();
+            return;
+        }
+
+        entry.caps.screenOrigin     = static_cast<ScreenOrigin>(screenOrigin);
+        entry.caps.clippingRange    = static_cast<ClippingRange>(clippingRange);
+
+        entries_.push_back(std::move(entry));
+    }
+}
+
+void RenderModuleCache::WriteFile() const
+{
+    std::ofstream file { filename_, std::ios_base::binary };
+    if (!file.good())
+        return;
+
+    CacheFileHeader header;
+    {
+        header.magic        = g_cacheFileMagic;
+        header.version      = g_cacheFileVersion;
+        header.buildID      = LLGL_BUILD_ID;
+        header.featuresSize = sizeof(RenderingFeatures);
+        header.limitsSize   = sizeof(RenderingLimits);
+        header.numEntries   = static_cast<std::uint32_t>(entries_.size());
+    }
+    WriteValue(file, header);
+
+    for (const auto& entry : entries_)
+    {
+        WriteString(file, entry.moduleName);
+        WriteValue(file, entry.moduleFileSize);
+        WriteString(file, entry.info.rendererName);
+        WriteString(file, entry.info.deviceName);
+        WriteString(file, entry.info.vendorName);
+        WriteString(file, entry.info.shadingLanguageName);
+        WriteValue(file, static_cast<std::int32_t>(entry.caps.screenOrigin));
+        WriteValue(file, static_cast<std::int32_t>(entry.caps.clippingRange));
+        WriteEnumArray(file, entry.caps.shadingLanguages);
+        WriteEnumArray(file, entry.caps.textureFormats);
+        WriteValue(file, entry.caps.features);
+        WriteValue(file, entry.caps.limits);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
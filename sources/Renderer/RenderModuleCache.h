@@ -0,0 +1,95 @@
+/*
+ * RenderModuleCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_MODULE_CACHE_H
+#define LLGL_RENDER_MODULE_CACHE_H
+
+
+#include <LLGL/RenderSystemFlags.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+
+/*
+Process-wide cache of render system modules.
+The availability of each module is only probed once per process, and all modules are probed in parallel.
+If a cache file has been specified, the renderer info and capabilities of each module are persisted whenever a render system has been loaded,
+so they can be queried later without loading the module or creating a device. Cached modules are reported as available without being probed,
+as long as the size of their module file did not change.
+*/
+class RenderModuleCache
+{
+
+    public:
+
+        RenderModuleCache(const RenderModuleCache&) = delete;
+        RenderModuleCache& operator = (const RenderModuleCache&) = delete;
+
+        // Returns the process-wide module cache.
+        static RenderModuleCache& Get();
+
+        // Returns the available modules among the specified known modules, in the same order.
+        std::vector<std::string> FindModules(const std::vector<std::string>& knownModules);
+
+        // Sets the filename of the persistent cache and reads all valid entries from it. An empty filename disables the persistent cache.
+        void SetFilename(const std::string& filename);
+
+        // Retrieves the cached renderer info and capabilities of the specified module. Returns false if there is no valid entry.
+        bool Query(const std::string& moduleName, RendererInfo* info, RenderingCapabilities* caps);
+
+        // Stores the renderer info and capabilities of the specified render system and writes the persistent cache if they changed.
+        // The capabilities are only queried if the persistent cache is enabled, so deferred capability queries are not enforced otherwise.
+        void Store(const std::string& moduleName, const RenderSystem& renderSystem);
+
+    private:
+
+        struct Entry
+        {
+            std::string             moduleName;
+            std::uint64_t           moduleFileSize  = 0;    // Size of the module file to detect a modified module
+            RendererInfo            info;
+            RenderingCapabilities   caps;
+        };
+
+    private:
+
+        RenderModuleCache() = default;
+
+        Entry* FindEntry(const std::string& moduleName);
+
+        void ReadFile();
+        void WriteFile() const;
+
+    private:
+
+        std::mutex                  mutex_;
+        std::string                 filename_;
+        std::vector<Entry>          entries_;
+
+        /* Availability of each probed module within this process */
+        std::vector<std::string>    probedModules_;
+        std::vector<bool>           probedAvailable_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,51 @@
+/*
+ * RenderPass.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderPass.h>
+
+
+namespace LLGL
+{
+
+
+RenderPass::RenderPass(const RenderPassDescriptor& desc) :
+    desc_ { desc }
+{
+}
+
+const AttachmentOpsDescriptor& RenderPass::GetColorAttachmentOps(std::uint32_t colorAttachment) const
+{
+    static const AttachmentOpsDescriptor defaultOps;
+    if (colorAttachment < desc_.colorAttachments.size())
+        return desc_.colorAttachments[colorAttachment];
+    else
+        return defaultOps;
+}
+
+std::uint32_t RenderPass::GetNumClearAttachments(std::uint32_t numColorAttachments, bool hasDepthStencil) const
+{
+    std::uint32_t n = 0;
+
+    for (std::uint32_t i = 0; i < numColorAttachments; ++i)
+    {
+        if (GetColorAttachmentOps(i).loadOp == AttachmentLoadOp::Clear)
+            ++n;
+    }
+
+    /* Depth and stencil components share a single clear value */
+    if (hasDepthStencil && (desc_.depthAttachment.loadOp == AttachmentLoadOp::Clear || desc_.stencilAttachment.loadOp == AttachmentLoadOp::Clear))
+        ++n;
+
+    return n;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -6,14 +6,20 @@
  */
 
 #include "../Platform/Module.h"
+#include "../Platform/MappedFile.h"
 #include "../Core/Helper.h"
+#include "../Core/HostAllocator.h"
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Log.h>
 #include "BuildID.h"
+#include "RenderModuleCache.h"
+#include "MipChain.h"
 
 #include <LLGL/RenderSystem.h>
+#include <algorithm>
 #include <array>
 #include <map>
+#include <fstream>
 
 #ifdef LLGL_ENABLE_DEBUG_LAYER
 #   include "DebugLayer/DbgRenderSystem.h"
@@ -30,10 +36,89 @@ namespace LLGL
 
 /* ----- Render system ----- */
 
-static std::map<RenderSystem*, std::unique_ptr<Module>> g_renderSystemModules;
+// Module of a loaded render system and the name it has been loaded with
+struct RenderSystemModule
+{
+    std::string             moduleName;
+    std::unique_ptr<Module> module;
+};
+
+static std::map<RenderSystem*, RenderSystemModule> g_renderSystemModules;
+
+#ifdef LLGL_BUILD_STATIC_LIB
+
+// Interface procedures of a render system module that has been linked statically.
+struct StaticModule
+{
+    const char* moduleName;
+    int         (*buildID)();
+    int         (*rendererID)();
+    const char* (*name)();
+    void*       (*alloc)(const void*);
+};
+
+#define LLGL_STATIC_MODULE(MODULE)              \
+    {                                           \
+        #MODULE,                                \
+        LLGL_MODULE_PROC(BuildID, MODULE),      \
+        LLGL_MODULE_PROC(RendererID, MODULE),   \
+        LLGL_MODULE_PROC(Name, MODULE),         \
+        LLGL_MODULE_PROC(Alloc, MODULE)         \
+    }
+
+// All render system modules that have been linked statically (in the same order as the known modules in 'FindModules')
+static const StaticModule g_staticModules[] =
+{
+    #ifdef LLGL_STATIC_MODULE_OPENGLES3
+    LLGL_STATIC_MODULE( OpenGLES3 ),
+    #endif
+    #ifdef LLGL_STATIC_MODULE_OPENGL
+    LLGL_STATIC_MODULE( OpenGL ),
+    #endif
+    #ifdef LLGL_STATIC_MODULE_VULKAN
+    LLGL_STATIC_MODULE( Vulkan ),
+    #endif
+    #ifdef LLGL_STATIC_MODULE_DIRECT3D11
+    LLGL_STATIC_MODULE( Direct3D11 ),
+    #endif
+    #ifdef LLGL_STATIC_MODULE_DIRECT3D12
+    LLGL_STATIC_MODULE( Direct3D12 ),
+    #endif
+    #ifdef LLGL_STATIC_MODULE_METAL
+    LLGL_STATIC_MODULE( Metal ),
+    #endif
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+#undef LLGL_STATIC_MODULE
+
+// Returns the statically linked render system module with the specified name, or null if there is no such module.
+static const StaticModule* FindStaticModule(const std::string& moduleName)
+{
+    for (auto module = g_staticModules; module->moduleName != nullptr; ++module)
+    {
+        if (moduleName == module->moduleName)
+            return module;
+    }
+    return nullptr;
+}
+
+#endif // /LLGL_BUILD_STATIC_LIB
 
 std::vector<std::string> RenderSystem::FindModules()
 {
+    #ifdef LLGL_BUILD_STATIC_LIB
+
+    /* Return all modules that have been linked statically */
+    std::vector<std::string> modules;
+
+    for (auto module = g_staticModules; module->moduleName != nullptr; ++module)
+        modules.push_back(module->moduleName);
+
+    return modules;
+
+    #else
+
     /* Iterate over all known modules and return those that are available on the current platform */
     const std::vector<std::string> knownModules
     {
@@ -55,15 +140,19 @@ std::vector<std::string> RenderSystem::FindModules()
         #endif
     };
 
-    std::vector<std::string> modules;
+    return RenderModuleCache::Get().FindModules(knownModules);
 
-    for (const auto& m : knownModules)
-    {
-        if (Module::IsAvailable(Module::GetModuleFilename(m)))
-            modules.push_back(m);
-    }
+    #endif // /LLGL_BUILD_STATIC_LIB
+}
 
-    return modules;
+void RenderSystem::SetModuleCacheFilename(const std::string& filename)
+{
+    RenderModuleCache::Get().SetFilename(filename);
+}
+
+bool RenderSystem::QueryRendererCaps(const std::string& moduleName, RenderingCapabilities& caps, RendererInfo* info)
+{
+    return RenderModuleCache::Get().Query(moduleName, info, &caps);
 }
 
 #ifndef LLGL_BUILD_STATIC_LIB
@@ -123,22 +212,31 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
 {
     #ifdef LLGL_BUILD_STATIC_LIB
 
+    /* Find statically linked render system module */
+    auto module = FindStaticModule(renderSystemDesc.moduleName);
+    if (!module)
+        throw std::runtime_error("render system module has not been linked statically: \"" + renderSystemDesc.moduleName + "\"");
+
     /*
     Verify build ID from render system module to detect a module,
     that has compiled with a different compiler (type, version, debug/release mode etc.)
     */
-    if (LLGL_RenderSystem_BuildID() != LLGL_BUILD_ID)
+    if (module->buildID() != LLGL_BUILD_ID)
         throw std::runtime_error("build ID mismatch in render system module");
 
-    /* Allocate render system */
-    auto renderSystem   = std::unique_ptr<RenderSystem>(reinterpret_cast<RenderSystem*>(LLGL_RenderSystem_Alloc()));
+    /* Allocate render system and all of its objects with the host allocator */
+    SetHostAllocator(renderSystemDesc.allocator);
+
+    auto renderSystem   = std::unique_ptr<RenderSystem>(reinterpret_cast<RenderSystem*>(module->alloc(&renderSystemDesc)));
 
-    if (profiler != nullptr || debugger != nullptr)
+    RenderModuleCache::Get().Store(renderSystemDesc.moduleName, *renderSystem);
+
+    if (profiler != nullptr || debugger != nullptr || !renderSystemDesc.captureFilename.empty())
     {
         #ifdef LLGL_ENABLE_DEBUG_LAYER
 
         /* Create debug layer render system */
-        renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger);
+        renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger, renderSystemDesc.captureFilename);
 
         #else
 
@@ -147,8 +245,8 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
         #endif // /LLGL_ENABLE_DEBUG_LAYER
     }
 
-    renderSystem->name_         = LLGL_RenderSystem_Name();
-    renderSystem->rendererID_   = LLGL_RenderSystem_RendererID();
+    renderSystem->name_         = module->name();
+    renderSystem->rendererID_   = module->rendererID();
 
     /* Return new render system and unique pointer */
     return renderSystem;
@@ -168,15 +266,20 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
 
     try
     {
-        /* Allocate render system */
+        /* Allocate render system and all of its objects with the host allocator */
+        SetHostAllocator(renderSystemDesc.allocator);
+
         auto renderSystem = std::unique_ptr<RenderSystem>(LoadRenderSystem(*module, moduleFilename, renderSystemDesc));
 
-        if (profiler != nullptr || debugger != nullptr)
+        /* Persist renderer info and capabilities for subsequent queries without a device */
+        RenderModuleCache::Get().Store(renderSystemDesc.moduleName, *renderSystem);
+
+        if (profiler != nullptr || debugger != nullptr || !renderSystemDesc.captureFilename.empty())
         {
             #ifdef LLGL_ENABLE_DEBUG_LAYER
 
             /* Create debug layer render system */
-            renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger);
+            renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger, renderSystemDesc.captureFilename);
 
             #else
 
@@ -189,7 +292,9 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
         renderSystem->rendererID_   = LoadRenderSystemRendererID(*module);
 
         /* Store new module inside internal map */
-        g_renderSystemModules[renderSystem.get()] = std::move(module);
+        auto& entry = g_renderSystemModules[renderSystem.get()];
+        entry.moduleName    = renderSystemDesc.moduleName;
+        entry.module        = std::move(module);
 
         /* Return new render system and unique pointer */
         return renderSystem;
@@ -197,7 +302,7 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
     catch (const std::exception&)
     {
         /* Keep module, otherwise the exception's vtable might be corrupted because it's part of the module */
-        g_renderSystemModules[nullptr] = std::move(module);
+        g_renderSystemModules[nullptr].module = std::move(module);
         throw;
     }
 
@@ -209,16 +314,401 @@ void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
     auto it = g_renderSystemModules.find(renderSystem.get());
     if (it != g_renderSystemModules.end())
     {
+        /* Store capabilities of renderers that only query them with the first render context */
+        RenderModuleCache::Get().Store(it->second.moduleName, *renderSystem);
+
         renderSystem.release();
         g_renderSystemModules.erase(it);
     }
 }
 
+void* RenderSystem::operator new (std::size_t size)
+{
+    return AllocateHostMemory(size);
+}
+
+void RenderSystem::operator delete (void* ptr)
+{
+    FreeHostMemory(ptr);
+}
+
+const RenderingCapabilities& RenderSystem::GetRenderingCaps() const
+{
+    /* Complete capabilities with the deferred query on first access */
+    if (capsDeferred_.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> guard { capsMutex_ };
+        if (capsQuery_)
+        {
+            capsQuery_(caps_);
+            capsQuery_ = nullptr;
+            capsDeferred_.store(false, std::memory_order_release);
+        }
+    }
+    return caps_;
+}
+
 void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 {
     config_ = config;
 }
 
+/* ----- Command queues ----- */
+
+CommandQueue* RenderSystem::GetCommandQueue(const QueueType type)
+{
+    /* Only the graphics queue is supported by default */
+    return (type == QueueType::Graphics ? GetCommandQueue() : nullptr);
+}
+
+/* ----- Buffers ----- */
+
+// Default size (in bytes) of each chunk that is uploaded by CreateBufferFromFile (fits multiple times into the default Vulkan staging ring)
+static const std::size_t g_defaultBufferChunkSize = 1024 * 1024;
+
+Buffer* RenderSystem::CreateBufferFromFile(const BufferDescriptor& desc, const std::string& filename, std::uint64_t offset, std::size_t chunkSize)
+{
+    /* Map file into memory and validate range */
+    auto file = MappedFile::Open(filename);
+
+    const auto fileSize = static_cast<std::uint64_t>(file->GetSize());
+    if (offset > fileSize || desc.size > fileSize - offset)
+    {
+        throw std::invalid_argument(
+            "cannot create buffer with size of " + std::to_string(desc.size) + " bytes at offset " + std::to_string(offset) +
+            " from file with size of " + std::to_string(fileSize) + " bytes: \"" + filename + "\""
+        );
+    }
+
+    /* Create buffer without initial data */
+    auto buffer = CreateBuffer(desc, nullptr);
+
+    const auto data         = reinterpret_cast<const char*>(file->GetData()) + offset;
+    const auto fileOffset   = static_cast<std::size_t>(offset);
+    const auto size         = static_cast<std::size_t>(desc.size);
+
+    if (chunkSize == 0)
+        chunkSize = g_defaultBufferChunkSize;
+
+    try
+    {
+        file->Prefetch(fileOffset, std::min(chunkSize, size));
+
+        for (std::size_t pos = 0; pos < size; pos += chunkSize)
+        {
+            const auto len = std::min(chunkSize, size - pos);
+
+            /* Read next chunk ahead while the current chunk is copied into staging memory */
+            if (pos + len < size)
+                file->Prefetch(fileOffset + pos + len, std::min(chunkSize, size - pos - len));
+
+            WriteBuffer(*buffer, data + pos, len, pos);
+
+            /* Release pages of the current chunk, since the data has been copied into staging memory */
+            file->Discard(fileOffset + pos, len);
+        }
+    }
+    catch (...)
+    {
+        Release(*buffer);
+        throw;
+    }
+
+    return buffer;
+}
+
+/* ----- Textures ----- */
+
+Texture* RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, std::uint32_t numImages, const TextureSubresourceImage* images)
+{
+    /* Find image that covers all array layers of the first MIP-map level to initialize the texture with */
+    const TextureSubresourceImage* baseImage = nullptr;
+
+    for (std::uint32_t i = 0; i < numImages; ++i)
+    {
+        if (images[i].mipLevel == 0 && images[i].baseArrayLayer == 0 && images[i].numArrayLayers >= textureDesc.arrayLayers)
+        {
+            baseImage = &images[i];
+            break;
+        }
+    }
+
+    Texture* texture = nullptr;
+
+    if (baseImage != nullptr)
+        texture = CreateTexture(textureDesc, &(baseImage->image));
+    else
+    {
+        /* Create texture without default initialization, since all MIP-map levels are written afterwards */
+        const auto prevConfig = GetConfiguration();
+        {
+            auto config = prevConfig;
+            config.imageInitialization.enabled = false;
+            SetConfiguration(config);
+        }
+        try
+        {
+            texture = CreateTexture(textureDesc, nullptr);
+        }
+        catch (...)
+        {
+            SetConfiguration(prevConfig);
+            throw;
+        }
+        SetConfiguration(prevConfig);
+    }
+
+    /* Write all remaining images directly into the texture with a single upload */
+    std::vector<SubTextureImage> regions;
+    regions.reserve(numImages);
+
+    for (std::uint32_t i = 0; i < numImages; ++i)
+    {
+        if (&images[i] != baseImage)
+            regions.push_back({ GetSubTextureForImage(textureDesc, images[i]), images[i].image });
+    }
+
+    if (!regions.empty())
+        WriteTextureRegions(*texture, static_cast<std::uint32_t>(regions.size()), regions.data());
+
+    return texture;
+}
+
+// Determines the image format and data type that describes the texel data of the specified hardware format as it is.
+static void GetUploadImageFormat(const Format format, ImageFormat& imageFormat, DataType& dataType)
+{
+    if (!FindSuitableImageFormat(format, imageFormat, dataType))
+    {
+        switch (format)
+        {
+            case Format::BGRA8UNorm:    /*pass*/
+            case Format::BGRA8UInt:     /*pass*/
+            case Format::BGRA8sRGB:
+                imageFormat = ImageFormat::BGRA;
+                dataType    = DataType::UInt8;
+                break;
+
+            case Format::BGRA8SNorm:    /*pass*/
+            case Format::BGRA8SInt:
+                imageFormat = ImageFormat::BGRA;
+                dataType    = DataType::Int8;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void RenderSystem::WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions)
+{
+    /* Write each region individually, but submit all upload commands at once */
+    BeginUploadBatch();
+    try
+    {
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+            WriteTexture(texture, regions[i].subTexture, regions[i].image);
+    }
+    catch (...)
+    {
+        EndUploadBatch();
+        throw;
+    }
+    EndUploadBatch();
+}
+
+TextureUploadMemory RenderSystem::BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc)
+{
+    if (uploadTexture_ != nullptr)
+        throw std::runtime_error("cannot begin texture upload while another texture upload is in progress");
+
+    const auto textureDesc = texture.QueryDesc();
+    if (IsMultiSampleTexture(textureDesc.type) || IsDepthStencilFormat(textureDesc.format))
+        throw std::invalid_argument("cannot upload texture with multi-sampled type or depth-stencil format");
+
+    /* Allocate tightly packed CPU buffer, which is passed to WriteTexture with the hardware format of the texture */
+    const auto& extent = subTextureDesc.extent;
+
+    TextureUploadMemory memory;
+    {
+        memory.rowPitch     = TextureBufferSize(textureDesc.format, Extent3D{ extent.width, 1, 1 });
+        memory.slicePitch   = TextureBufferSize(textureDesc.format, Extent3D{ extent.width, extent.height, 1 });
+    }
+    uploadBuffer_.resize(TextureBufferSize(textureDesc.format, extent));
+    memory.data = uploadBuffer_.data();
+
+    uploadTexture_  = (&texture);
+    uploadRegion_   = subTextureDesc;
+
+    return memory;
+}
+
+void RenderSystem::EndTextureUpload()
+{
+    if (uploadTexture_ == nullptr)
+        throw std::runtime_error("cannot end texture upload without a preceding call to BeginTextureUpload");
+
+    /* Write staging buffer into texture as it is (no conversion takes place, since the image format matches the hardware format) */
+    SrcImageDescriptor imageDesc;
+    {
+        GetUploadImageFormat(uploadTexture_->QueryDesc().format, imageDesc.format, imageDesc.dataType);
+        imageDesc.data      = uploadBuffer_.data();
+        imageDesc.dataSize  = uploadBuffer_.size();
+    }
+    auto texture = uploadTexture_;
+    uploadTexture_ = nullptr;
+
+    WriteTexture(*texture, uploadRegion_, imageDesc);
+}
+
+bool RenderSystem::QuerySparseTileShape(const Format /*format*/, const TextureType /*type*/, Extent3D& /*tileShape*/)
+{
+    /* Sparse textures are not supported by default */
+    return false;
+}
+
+void RenderSystem::CommitTextureTiles(Texture& /*texture*/, const TextureRegion& /*region*/, bool /*commit*/)
+{
+    throw std::runtime_error("sparse textures are not supported by this renderer");
+}
+
+void RenderSystem::SetTextureMinLOD(Texture& /*texture*/, float /*minLOD*/)
+{
+    throw std::runtime_error("texture min-LOD clamping is not supported by this renderer");
+}
+
+/* ----- Pipeline States ----- */
+
+GraphicsPipeline* RenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    /* Asynchronous pipeline creation is not supported by default */
+    return CreateGraphicsPipeline(desc);
+}
+
+/* ----- Pipeline Caches ----- */
+
+std::vector<char> RenderSystem::GetPipelineCacheData() const
+{
+    /* Pipeline caches are not supported by default */
+    return {};
+}
+
+bool RenderSystem::SetPipelineCacheData(const void* /*data*/, std::size_t /*dataSize*/)
+{
+    /* Pipeline caches are not supported by default */
+    return false;
+}
+
+bool RenderSystem::SavePipelineCache(const std::string& filename) const
+{
+    auto blob = GetPipelineCacheData();
+    if (!blob.empty())
+    {
+        std::ofstream file { filename, std::ios_base::binary };
+        if (file.good())
+        {
+            file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            return file.good();
+        }
+    }
+    return false;
+}
+
+bool RenderSystem::LoadPipelineCache(const std::string& filename)
+{
+    std::ifstream file { filename, (std::ios_base::binary | std::ios_base::ate) };
+    if (file.good())
+    {
+        /* Read entire file into blob */
+        auto fileSize = static_cast<std::size_t>(file.tellg());
+        std::vector<char> blob(fileSize);
+
+        file.seekg(0);
+        file.read(blob.data(), static_cast<std::streamsize>(fileSize));
+
+        if (file.good() && !blob.empty())
+            return SetPipelineCacheData(blob.data(), blob.size());
+    }
+    return false;
+}
+
+/* ----- Statistics ----- */
+
+bool RenderSystem::QueryStatistics(RenderingStatistics& statistics, bool /*reset*/)
+{
+    /* Statistics are not supported by default */
+    statistics = {};
+    return false;
+}
+
+bool RenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    /* Memory statistics are not supported by default */
+    statistics.heaps.clear();
+    return false;
+}
+
+bool RenderSystem::QueryTimestampCalibration(TimestampCalibration& calibration)
+{
+    /* Calibrated timestamps are not supported by default */
+    return false;
+}
+
+bool RenderSystem::QueryResourceMemoryReport(ResourceMemoryReport& report, char separator)
+{
+    /* Resource memory reports are only supported by the debug layer, which tracks the names and sizes of all resources */
+    return false;
+}
+
+/* ----- Indirect Command Layouts ----- */
+
+IndirectCommandLayout* RenderSystem::CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& /*desc*/)
+{
+    throw std::runtime_error("indirect command layouts are not supported by this renderer");
+}
+
+void RenderSystem::Release(IndirectCommandLayout& /*indirectCommandLayout*/)
+{
+    // dummy (indirect command layouts cannot be created with the default implementation)
+}
+
+/* ----- Acceleration Structures ----- */
+
+AccelerationStructure* RenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& /*desc*/)
+{
+    throw std::runtime_error("acceleration structures are not supported by this renderer");
+}
+
+void RenderSystem::Release(AccelerationStructure& /*accelerationStructure*/)
+{
+    // dummy (acceleration structures cannot be created with the default implementation)
+}
+
+/* ----- Upload batches ----- */
+
+void RenderSystem::BeginUploadBatch()
+{
+    // dummy
+}
+
+void RenderSystem::EndUploadBatch()
+{
+    // dummy
+}
+
+/* ----- Worker threads ----- */
+
+bool RenderSystem::AttachWorkerThread()
+{
+    /* Worker threads are not supported by default */
+    return false;
+}
+
+void RenderSystem::DetachWorkerThread()
+{
+    // dummy
+}
+
 
 /*
  * ======= Protected: =======
@@ -234,6 +724,18 @@ void RenderSystem::SetRenderingCaps(const RenderingCapabilities& caps)
     caps_ = caps;
 }
 
+void RenderSystem::SetDeferredRenderingCaps(const std::function<void(RenderingCapabilities& caps)>& query)
+{
+    std::lock_guard<std::mutex> guard { capsMutex_ };
+    capsQuery_ = query;
+    capsDeferred_.store(static_cast<bool>(query), std::memory_order_release);
+}
+
+void RenderSystem::SetVideoAdapters(const std::vector<VideoAdapterDescriptor>& videoAdapters)
+{
+    videoAdapters_ = videoAdapters;
+}
+
 void RenderSystem::AssertCreateBuffer(const BufferDescriptor& desc, std::uint64_t maxSize)
 {
     if (desc.type < BufferType::Vertex || desc.type > BufferType::StreamOutput)
@@ -313,6 +815,8 @@ void RenderSystem::AssertCreateShaderProgram(const ShaderProgramDescriptor& desc
     AssertShaderType(desc.geometryShader,       "geometryShader",       ShaderType::Geometry,       "Geometry"      );
     AssertShaderType(desc.fragmentShader,       "fragmentShader",       ShaderType::Fragment,       "Fragment"      );
     AssertShaderType(desc.computeShader,        "computeShader",        ShaderType::Compute,        "Compute"       );
+    AssertShaderType(desc.amplificationShader,  "amplificationShader",  ShaderType::Amplification,  "Amplification" );
+    AssertShaderType(desc.meshShader,           "meshShader",           ShaderType::Mesh,           "Mesh"          );
 
     if (desc.computeShader != nullptr)
     {
@@ -320,13 +824,33 @@ void RenderSystem::AssertCreateShaderProgram(const ShaderProgramDescriptor& desc
              desc.tessControlShader    != nullptr ||
              desc.tessEvaluationShader != nullptr ||
              desc.geometryShader       != nullptr ||
-             desc.fragmentShader       != nullptr )
+             desc.fragmentShader       != nullptr ||
+             desc.amplificationShader  != nullptr ||
+             desc.meshShader           != nullptr )
         {
             throw std::invalid_argument(
                 "cannot create shader program with 'computeShader' in conjunction with any other shader"
             );
         }
     }
+    else if (desc.meshShader != nullptr || desc.amplificationShader != nullptr)
+    {
+        if (desc.meshShader == nullptr)
+            throw std::invalid_argument("cannot create shader program with 'amplificationShader' but without mesh shader");
+
+        if ( desc.vertexShader         != nullptr ||
+             desc.tessControlShader    != nullptr ||
+             desc.tessEvaluationShader != nullptr ||
+             desc.geometryShader       != nullptr )
+        {
+            throw std::invalid_argument(
+                "cannot create shader program with 'meshShader' in conjunction with vertex, tessellation, or geometry shaders"
+            );
+        }
+
+        if (!desc.vertexFormats.empty())
+            throw std::invalid_argument("cannot create shader program with 'meshShader' and non-empty vertex formats");
+    }
     else
     {
         if (desc.vertexShader == nullptr)
@@ -366,6 +890,17 @@ void RenderSystem::AssertImageDataSize(std::size_t dataSize, std::size_t require
     }
 }
 
+void RenderSystem::AssertBufferReadbackDataSize(std::size_t dataSize, std::uint64_t requiredDataSize)
+{
+    if (static_cast<std::uint64_t>(dataSize) < requiredDataSize)
+    {
+        throw std::invalid_argument(
+            "output data size is too small for buffer readback (" + std::to_string(requiredDataSize) +
+            " byte(s) are required, but only " + std::to_string(dataSize) + " is specified)"
+        );
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,36 @@
+/*
+ * RenderSystemChild.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderSystemChild.h>
+#include "../Core/HostAllocator.h"
+
+
+namespace LLGL
+{
+
+
+void* RenderSystemChild::operator new (std::size_t size)
+{
+    return AllocateHostMemory(size);
+}
+
+void RenderSystemChild::operator delete (void* ptr)
+{
+    FreeHostMemory(ptr);
+}
+
+void RenderSystemChild::SetName(const char* name)
+{
+    /* Debug names are ignored by default */
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -76,12 +76,16 @@ LLGL_EXPORT bool ValidateRenderingCaps(
         }
 
     LLGL_VALIDATE_FEATURE( hasCommandBufferExt,          "extended command buffer"    );
+    LLGL_VALIDATE_FEATURE( hasSecondaryCommandBuffers,   "secondary command buffers"  );
     LLGL_VALIDATE_FEATURE( hasRenderTargets,             "render targets"             );
     LLGL_VALIDATE_FEATURE( has3DTextures,                "3D textures"                );
     LLGL_VALIDATE_FEATURE( hasCubeTextures,              "cube textures"              );
     LLGL_VALIDATE_FEATURE( hasArrayTextures,             "array textures"             );
     LLGL_VALIDATE_FEATURE( hasCubeArrayTextures,         "cube array textures"        );
     LLGL_VALIDATE_FEATURE( hasMultiSampleTextures,       "multi-sample textures"      );
+    LLGL_VALIDATE_FEATURE( hasTextureCompressionBC,      "BC texture compression"     );
+    LLGL_VALIDATE_FEATURE( hasTextureCompressionETC2,    "ETC2 texture compression"   );
+    LLGL_VALIDATE_FEATURE( hasTextureCompressionASTC,    "ASTC texture compression"   );
     LLGL_VALIDATE_FEATURE( hasSamplers,                  "samplers"                   );
     LLGL_VALIDATE_FEATURE( hasConstantBuffers,           "constant buffers"           );
     LLGL_VALIDATE_FEATURE( hasStorageBuffers,            "storage buffers"            );
@@ -91,10 +95,29 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_FEATURE( hasComputeShaders,            "compute shaders"            );
     LLGL_VALIDATE_FEATURE( hasInstancing,                "instancing"                 );
     LLGL_VALIDATE_FEATURE( hasOffsetInstancing,          "offset instancing"          );
+    LLGL_VALIDATE_FEATURE( hasIndirectDrawing,           "indirect drawing"           );
+    LLGL_VALIDATE_FEATURE( hasIndirectCommandLayouts,    "indirect command layouts"   );
     LLGL_VALIDATE_FEATURE( hasViewportArrays,            "viewport arrays"            );
     LLGL_VALIDATE_FEATURE( hasConservativeRasterization, "conservative rasterization" );
+    LLGL_VALIDATE_FEATURE( hasDepthBoundsTest,           "depth bounds test"          );
+    LLGL_VALIDATE_FEATURE( hasMeshShaders,               "mesh shaders"               );
+    LLGL_VALIDATE_FEATURE( hasRayQueries,                "ray queries"                );
     LLGL_VALIDATE_FEATURE( hasStreamOutputs,             "stream outputs"             );
     LLGL_VALIDATE_FEATURE( hasLogicOp,                   "logic fragment operations"  );
+    LLGL_VALIDATE_FEATURE( hasBindlessResources,         "bindless resources"         );
+    LLGL_VALIDATE_FEATURE( hasDynamicOffsets,            "dynamic offsets"            );
+    LLGL_VALIDATE_FEATURE( hasStaticSamplers,            "static samplers"            );
+    LLGL_VALIDATE_FEATURE( hasSparseTextures,            "sparse textures"            );
+    LLGL_VALIDATE_FEATURE( hasTextureViews,              "texture views"              );
+    LLGL_VALIDATE_FEATURE( hasTextureMinLOD,             "texture min-LOD clamping"   );
+    LLGL_VALIDATE_FEATURE( hasTimelineFences,            "timeline fences"            );
+    LLGL_VALIDATE_FEATURE( hasComputeQueue,              "compute queue"              );
+    LLGL_VALIDATE_FEATURE( hasBackgroundQueue,           "background queue"           );
+    LLGL_VALIDATE_FEATURE( hasVariableRateShading,       "variable rate shading"      );
+    LLGL_VALIDATE_FEATURE( hasAdditionalShadingRates,    "additional shading rates"   );
+    LLGL_VALIDATE_FEATURE( hasShadingRateImage,          "shading rate images"        );
+    LLGL_VALIDATE_FEATURE( hasMultiView,                 "multiview rendering"        );
+    LLGL_VALIDATE_FEATURE( hasSubgroups,                 "subgroup operations"        );
 
     #undef LLGL_VALIDATE_FEATURE
 
@@ -154,13 +177,33 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[0],  "compute shader work group size on X-axis"  );
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[1],  "compute shader work group size on Y-axis"  );
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[2],  "compute shader work group size on Z-axis"  );
+    LLGL_VALIDATE_LIMIT( maxMeshTaskWorkGroups[0],          "mesh task work group count on X-axis"      );
+    LLGL_VALIDATE_LIMIT( maxMeshTaskWorkGroups[1],          "mesh task work group count on Y-axis"      );
+    LLGL_VALIDATE_LIMIT( maxMeshTaskWorkGroups[2],          "mesh task work group count on Z-axis"      );
+    LLGL_VALIDATE_LIMIT( maxMeshOutputVertices,             "mesh shader output vertex count"           );
+    LLGL_VALIDATE_LIMIT( maxMeshOutputPrimitives,           "mesh shader output primitive count"        );
     LLGL_VALIDATE_LIMIT( maxNumViewports,                   "viewport count"                            );
     LLGL_VALIDATE_LIMIT( maxViewportSize[0],                "viewport width"                            );
     LLGL_VALIDATE_LIMIT( maxViewportSize[1],                "viewport height"                           );
     LLGL_VALIDATE_LIMIT( maxBufferSize,                     "buffer size"                               );
     LLGL_VALIDATE_LIMIT( maxConstantBufferSize,             "constant buffer size"                      );
+    LLGL_VALIDATE_LIMIT( maxConstantsSize,                  "constants size"                            );
+    LLGL_VALIDATE_LIMIT( maxNumViews,                       "view count"                                );
 
     #undef LLGL_VALIDATE_LIMIT
+
+    /* Validate bitmasks of limits */
+    #define LLGL_VALIDATE_LIMIT_FLAGS(ATTRIB, INFO)                                                     \
+        if ((requiredCaps.limits.ATTRIB & presentCaps.limits.ATTRIB) != requiredCaps.limits.ATTRIB)     \
+        {                                                                                               \
+            bool continueValidation = ReportValidationFailure(callback, INFO " not supported", #ATTRIB);\
+            LLGL_CONTINUE_VALIDATION_IF(continueValidation);                                            \
+        }
+
+    LLGL_VALIDATE_LIMIT_FLAGS( subgroupStageFlags,  "subgroup shader stages"  );
+    LLGL_VALIDATE_LIMIT_FLAGS( subgroupOperations,  "subgroup operations"     );
+
+    #undef LLGL_VALIDATE_LIMIT_FLAGS
     #undef LLGL_CONTINUE_VALIDATION_IF
 
     return result;
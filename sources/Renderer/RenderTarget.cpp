@@ -54,6 +54,71 @@ void RenderTarget::ValidateMipResolution(const Texture& texture, std::uint32_t m
     ValidateResolution({ size.width, size.height });
 }
 
+// Returns the number of array layers of the specified texture that can be attached, or the number of depth slices for 3D textures.
+static std::uint32_t GetNumAttachableLayers(const Texture& texture, std::uint32_t mipLevel)
+{
+    const auto extent = texture.QueryMipExtent(mipLevel);
+    switch (texture.GetType())
+    {
+        case TextureType::Texture1DArray:   return extent.height;
+        case TextureType::Texture3D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray: return extent.depth;
+        default:                            return 1;
+    }
+}
+
+std::uint32_t RenderTarget::ValidateAttachmentLayers(const RenderTargetDescriptor& desc)
+{
+    std::uint32_t numLayers = 1;
+
+    for (const auto& attachment : desc.attachments)
+    {
+        if (attachment.numArrayLayers == 0)
+            throw std::invalid_argument("invalid number of array layers for render target attachment (zero is specified)");
+
+        if (attachment.numArrayLayers > 1)
+        {
+            if (attachment.texture == nullptr)
+                throw std::invalid_argument("cannot have layered render target attachment without a valid texture");
+
+            /* Validate array layers against the texture (MIP level of multi-sample textures is ignored) */
+            const auto mipLevel = (IsMultiSampleTexture(attachment.texture->GetType()) ? 0u : attachment.mipLevel);
+            const auto maxLayers = GetNumAttachableLayers(*attachment.texture, mipLevel);
+
+            if (attachment.arrayLayer + attachment.numArrayLayers > maxLayers)
+            {
+                throw std::invalid_argument(
+                    "array layers of render target attachment out of range (" + std::to_string(attachment.arrayLayer) + " + " +
+                    std::to_string(attachment.numArrayLayers) + " are specified, but texture has " + std::to_string(maxLayers) + ")"
+                );
+            }
+
+            if (numLayers > 1 && numLayers != attachment.numArrayLayers)
+                throw std::invalid_argument("mismatch between number of array layers of layered render target attachments");
+
+            numLayers = attachment.numArrayLayers;
+        }
+    }
+
+    if (numLayers > 1)
+    {
+        /* All attachments must be layered, which is not possible for depth-stencil buffers without a texture */
+        for (const auto& attachment : desc.attachments)
+        {
+            if (attachment.numArrayLayers != numLayers)
+                throw std::invalid_argument("cannot mix layered and non-layered render target attachments");
+        }
+
+        if (desc.numViews > 1)
+            throw std::invalid_argument("cannot combine layered rendering with multiview rendering in render target");
+    }
+
+    return numLayers;
+}
+
 
 } // /namespace LLGL
 
@@ -8,57 +8,178 @@
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/Strings.h>
 #include <LLGL/Log.h>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <thread>
 
 
 namespace LLGL
 {
 
 
+/*
+Message that has been posted by a single thread. Records are only created by their thread (the producer)
+and are never removed before the debugger is destroyed, so the flushing thread (the consumer) can traverse them without a lock.
+*/
+struct MessageRecord
+{
+    bool                        isError     = false;
+    int                         type        = 0;
+    std::string                 text;
+    const char*                 source      = "";
+    std::atomic<std::size_t>    pending     { 0 };      // Occurrences since the previous flush
+    std::atomic<bool>           blocked     { false };  // Set by the consumer once the merged message has been blocked
+    MessageRecord*              next        = nullptr;
+};
+
+struct RenderingDebugger::ThreadBuffer
+{
+    ~ThreadBuffer()
+    {
+        while (auto record = records.load())
+        {
+            records.store(record->next);
+            delete record;
+        }
+    }
+
+    std::thread::id                                 threadID;
+    const char*                                     source  = "";
+    std::unordered_map<std::string, MessageRecord*> errors;             // Only accessed by the producer
+    std::unordered_map<std::string, MessageRecord*> warnings;           // Only accessed by the producer
+    std::atomic<MessageRecord*>                     records { nullptr };
+    ThreadBuffer*                                   next    = nullptr;
+};
+
+// Unique identifier for each debugger, so a thread never confuses a destroyed debugger with a new one at the same address
+static std::atomic<std::uint64_t> g_debuggerIDCounter { 0 };
+
+RenderingDebugger::RenderingDebugger() :
+    id_            { ++g_debuggerIDCounter },
+    threadBuffers_ { nullptr               }
+{
+}
+
 RenderingDebugger::~RenderingDebugger()
 {
+    while (auto buffer = threadBuffers_.load())
+    {
+        threadBuffers_.store(buffer->next);
+        delete buffer;
+    }
 }
 
 void RenderingDebugger::SetSource(const char* source)
 {
-    source_ = (source != nullptr ? source : "");
+    GetThreadBuffer().source = (source != nullptr ? source : "");
 }
 
-void RenderingDebugger::PostError(const ErrorType type, const std::string& message)
+// Records one occurrence of the specified message in the specified lookup table of the calling thread.
+static void PostMessageRecord(
+    std::unordered_map<std::string, MessageRecord*>&    lookup,
+    std::atomic<MessageRecord*>&                        records,
+    bool                                                isError,
+    int                                                 type,
+    const std::string&                                  message,
+    const char*                                         source)
 {
-    auto it = errors_.find(message);
-    if (it != errors_.end())
+    auto it = lookup.find(message);
+    if (it != lookup.end())
     {
-        if (!it->second.IsBlocked())
-        {
-            it->second.IncOccurrence();
-            OnError(type, it->second);
-        }
+        /* Only increment occurrence counter of repeated messages */
+        if (!it->second->blocked.load(std::memory_order_relaxed))
+            it->second->pending.fetch_add(1, std::memory_order_release);
     }
     else
     {
-        errors_[message] = Message { message, source_ };
-        OnError(type, errors_[message]);
+        /* Publish new record to the consumer; this thread is the only one that modifies this list */
+        auto record = new MessageRecord();
+        {
+            record->isError = isError;
+            record->type    = type;
+            record->text    = message;
+            record->source  = source;
+            record->pending.store(1, std::memory_order_relaxed);
+            record->next    = records.load(std::memory_order_relaxed);
+        }
+        records.store(record, std::memory_order_release);
+        lookup[message] = record;
     }
 }
 
+void RenderingDebugger::PostError(const ErrorType type, const std::string& message)
+{
+    auto& buffer = GetThreadBuffer();
+    PostMessageRecord(buffer.errors, buffer.records, true, static_cast<int>(type), message, buffer.source);
+}
+
 void RenderingDebugger::PostWarning(const WarningType type, const std::string& message)
 {
-    auto it = warnings_.find(message);
-    if (it != warnings_.end())
+    auto& buffer = GetThreadBuffer();
+    PostMessageRecord(buffer.warnings, buffer.records, false, static_cast<int>(type), message, buffer.source);
+}
+
+void RenderingDebugger::FlushMessages()
+{
+    /* Merge the records of all threads into one message per text */
+    std::vector<std::pair<Message*, const MessageRecord*>> mergedMessages;
+
+    for (auto buffer = threadBuffers_.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next)
     {
-        if (!it->second.IsBlocked())
+        for (auto record = buffer->records.load(std::memory_order_acquire); record != nullptr; record = record->next)
         {
-            it->second.IncOccurrence();
-            OnWarning(type, it->second);
+            auto occurrences = record->pending.exchange(0, std::memory_order_acquire);
+            if (occurrences == 0)
+                continue;
+
+            auto& messages  = (record->isError ? errors_ : warnings_);
+            auto it         = messages.find(record->text);
+
+            if (it == messages.end())
+            {
+                it = messages.insert({ record->text, Message{ record->text, record->source } }).first;
+                it->second.IncOccurrence(occurrences - 1);
+            }
+            else if (!it->second.IsBlocked())
+                it->second.IncOccurrence(occurrences);
+
+            auto msg = &(it->second);
+
+            if (msg->IsBlocked())
+            {
+                /* Stop recording this message on the producer thread */
+                record->blocked.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                auto merged = std::find_if(
+                    mergedMessages.begin(), mergedMessages.end(),
+                    [msg](const std::pair<Message*, const MessageRecord*>& entry) { return (entry.first == msg); }
+                );
+                if (merged == mergedMessages.end())
+                    mergedMessages.push_back({ msg, record });
+            }
         }
     }
-    else
+
+    /* Invoke callbacks once for each merged message */
+    for (const auto& entry : mergedMessages)
     {
-        warnings_[message] = Message { message, source_ };
-        OnWarning(type, warnings_[message]);
+        if (entry.second->isError)
+            OnError(static_cast<ErrorType>(entry.second->type), *entry.first);
+        else
+            OnWarning(static_cast<WarningType>(entry.second->type), *entry.first);
     }
 }
 
+void RenderingDebugger::SetValidationSampling(const ValidationSamplingDescriptor& desc)
+{
+    validationSampling_ = desc;
+    if (validationSampling_.drawInterval == 0)
+        validationSampling_.drawInterval = 1;
+}
+
 
 /*
  * ====== Protected: =======
@@ -66,17 +187,54 @@ void RenderingDebugger::PostWarning(const WarningType type, const std::string& m
 
 void RenderingDebugger::OnError(ErrorType type, Message& message)
 {
-    Log::StdErr() << "ERROR (" << LLGL::ToString(type) << "): in '" << message.GetSource() << "': " << message.GetText() << std::endl;
+    LLGL_LOG(Error, std::string("ERROR (") + LLGL::ToString(type) + "): in '" + message.GetSource() + "': " + message.GetText());
     message.Block();
 }
 
 void RenderingDebugger::OnWarning(WarningType type, Message& message)
 {
-    Log::StdErr() << "WARNING (" << LLGL::ToString(type) << "): in '" << message.GetSource() << "': " << message.GetText() << std::endl;
+    LLGL_LOG(Warning, std::string("WARNING (") + LLGL::ToString(type) + "): in '" + message.GetSource() + "': " + message.GetText());
     message.Block();
 }
 
 
+/*
+ * ====== Private: =======
+ */
+
+RenderingDebugger::ThreadBuffer& RenderingDebugger::GetThreadBuffer()
+{
+    /* Cached message buffer of the calling thread for the debugger it has used most recently */
+    static thread_local std::uint64_t   cachedOwner     = 0;
+    static thread_local ThreadBuffer*   cachedBuffer    = nullptr;
+
+    if (cachedOwner == id_)
+        return *cachedBuffer;
+
+    /* Find buffer of the calling thread, which it has created when it used this debugger before */
+    const auto threadID = std::this_thread::get_id();
+    auto buffer = threadBuffers_.load(std::memory_order_acquire);
+
+    while (buffer != nullptr && buffer->threadID != threadID)
+        buffer = buffer->next;
+
+    if (buffer == nullptr)
+    {
+        /* Push new buffer to the list of all threads (lock-free) */
+        buffer = new ThreadBuffer();
+        buffer->threadID    = threadID;
+        buffer->next        = threadBuffers_.load(std::memory_order_relaxed);
+        while (!threadBuffers_.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    cachedOwner     = id_;
+    cachedBuffer    = buffer;
+
+    return *buffer;
+}
+
+
 /*
  * Message class
  */
@@ -98,9 +256,9 @@ void RenderingDebugger::Message::BlockAfter(std::size_t occurrences)
         Block();
 }
 
-void RenderingDebugger::Message::IncOccurrence()
+void RenderingDebugger::Message::IncOccurrence(std::size_t count)
 {
-    ++occurrences_;
+    occurrences_ += count;
 }
 
 
@@ -6,12 +6,94 @@
  */
 
 #include <LLGL/RenderingProfiler.h>
+#include <LLGL/Timer.h>
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+// Returns the current time (in nanoseconds) of the steady clock.
+static std::uint64_t GetSteadyClockTime()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+// Writes the specified string as JSON string literal.
+static void WriteJSONString(std::ostream& stream, const char* s)
+{
+    stream << '"';
+    for (; *s != '\0'; ++s)
+    {
+        switch (*s)
+        {
+            case '"':   stream << "\\\""; break;
+            case '\\':  stream << "\\\\"; break;
+            case '\n':  stream << "\\n"; break;
+            case '\t':  stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*s) >= 0x20)
+                    stream << *s;
+                break;
+        }
+    }
+    stream << '"';
+}
+
+// Writes the specified timestamp (in nanoseconds) in microseconds, as required by the trace event format.
+static void WriteJSONTime(std::ostream& stream, std::uint64_t t)
+{
+    stream << (t / 1000) << '.';
+    auto frac = t % 1000;
+    if (frac < 100)
+        stream << '0';
+    if (frac < 10)
+        stream << '0';
+    stream << frac;
+}
+
+// Writes a single statistics value as JSON argument; invalid values are omitted
+static void WriteJSONStatistic(std::ostream& stream, const char* name, std::uint64_t value)
+{
+    if (value != Constants::invalidQueryResult)
+        stream << ",\"" << name << "\":" << value;
+}
+
+static void WriteJSONStatistics(std::ostream& stream, const QueryPipelineStatistics& statistics)
+{
+    WriteJSONStatistic(stream, "primitivesGenerated",           statistics.numPrimitivesGenerated);
+    WriteJSONStatistic(stream, "verticesSubmitted",             statistics.numVerticesSubmitted);
+    WriteJSONStatistic(stream, "primitivesSubmitted",           statistics.numPrimitivesSubmitted);
+    WriteJSONStatistic(stream, "vertexShaderInvocations",       statistics.numVertexShaderInvocations);
+    WriteJSONStatistic(stream, "tessControlShaderInvocations",  statistics.numTessControlShaderInvocations);
+    WriteJSONStatistic(stream, "tessEvalShaderInvocations",     statistics.numTessEvaluationShaderInvocations);
+    WriteJSONStatistic(stream, "geometryShaderInvocations",     statistics.numGeometryShaderInvocations);
+    WriteJSONStatistic(stream, "fragmentShaderInvocations",     statistics.numFragmentShaderInvocations);
+    WriteJSONStatistic(stream, "computeShaderInvocations",      statistics.numComputeShaderInvocations);
+    WriteJSONStatistic(stream, "geometryPrimitivesGenerated",   statistics.numGeometryPrimitivesGenerated);
+    WriteJSONStatistic(stream, "clippingInputPrimitives",       statistics.numClippingInputPrimitives);
+    WriteJSONStatistic(stream, "clippingOutputPrimitives",      statistics.numClippingOutputPrimitives);
+}
+
+// Converts the specified ticks with the specified frequency into nanoseconds.
+static std::uint64_t TicksToNanoseconds(std::uint64_t ticks, std::uint64_t frequency)
+{
+    /* Split conversion into seconds and remainder to avoid an overflow of the 64-bit integer */
+    return (ticks / frequency) * 1000000000ull + (ticks % frequency) * 1000000000ull / frequency;
+}
+
+RenderingProfiler::RenderingProfiler() :
+    epoch_ { GetSteadyClockTime() }
+{
+}
+
+
 void RenderingProfiler::ResetCounters()
 {
     writeBuffer.Reset();
@@ -166,6 +248,233 @@ void RenderingProfiler::RecordDrawCall(const PrimitiveTopology topology, Counter
 }
 
 
+void RenderingProfiler::EnableEventLog(bool enable)
+{
+    eventLogEnabled_ = enable;
+    if (enable)
+        frameStartTime_ = GetTimestamp();
+}
+
+std::uint64_t RenderingProfiler::GetTimestamp() const
+{
+    return GetSteadyClockTime() - epoch_;
+}
+
+void RenderingProfiler::RecordEvent(const char* name, const char* category, std::uint64_t startTime, std::uint64_t endTime)
+{
+    if (!eventLogEnabled_)
+        return;
+
+    Event event;
+    {
+        event.name      = name;
+        event.category  = category;
+        event.startTime = startTime;
+        event.duration  = (endTime > startTime ? endTime - startTime : 0);
+        event.frame     = frame_;
+    }
+    events_.push_back(std::move(event));
+}
+
+void RenderingProfiler::RecordTimerScopes(const TimerScopeFrame& timerScopeFrame, const TimestampCalibration* calibration)
+{
+    if (!eventLogEnabled_)
+        return;
+
+    const auto numScopes = timerScopeFrame.scopes.size();
+    std::vector<std::uint64_t> startTimes(numScopes, 0);
+
+    if (calibration != nullptr && calibration->gpuFrequency > 0)
+    {
+        /* Determine offset between the clock of Timer::Tick and the steady clock of this profiler by sampling both back-to-back */
+        const auto tickFrequency        = Timer::GetTickFrequency();
+        const auto clockOffset          = static_cast<double>(GetTimestamp()) - static_cast<double>(TicksToNanoseconds(Timer::Tick(), tickFrequency));
+        const auto cpuTime              = static_cast<double>(TicksToNanoseconds(calibration->cpuTimestamp, tickFrequency)) + clockOffset;
+        const auto nanosecondsPerTick   = 1000000000.0 / static_cast<double>(calibration->gpuFrequency);
+
+        /* Place each scope at its absolute begin time, relative to the calibrated pair of timestamps */
+        for (std::size_t i = 0; i < numScopes; ++i)
+        {
+            const auto gpuDelta     = static_cast<std::int64_t>(timerScopeFrame.scopes[i].beginTimestamp - calibration->gpuTimestamp);
+            const auto startTime    = cpuTime + static_cast<double>(gpuDelta) * nanosecondsPerTick;
+            startTimes[i] = (startTime > 0.0 ? static_cast<std::uint64_t>(startTime) : 0);
+        }
+    }
+    else
+    {
+        /* Reconstruct start times: each scope begins where its previous sibling ended, root scopes begin at the start of the frame */
+        std::vector<std::uint64_t> nextStartTime(numScopes, 0);
+        std::uint64_t nextRootStartTime = frameStartTime_;
+
+        for (std::size_t i = 0; i < numScopes; ++i)
+        {
+            const auto& scope = timerScopeFrame.scopes[i];
+
+            if (scope.parent < i)
+            {
+                startTimes[i] = nextStartTime[scope.parent];
+                nextStartTime[scope.parent] += scope.elapsedTime;
+            }
+            else
+            {
+                startTimes[i] = nextRootStartTime;
+                nextRootStartTime += scope.elapsedTime;
+            }
+
+            nextStartTime[i] = startTimes[i];
+        }
+    }
+
+    for (std::size_t i = 0; i < numScopes; ++i)
+    {
+        const auto& scope = timerScopeFrame.scopes[i];
+
+        Event event;
+        {
+            event.name      = scope.name;
+            event.category  = "GPU";
+            event.startTime = startTimes[i];
+            event.duration  = scope.elapsedTime;
+            event.frame     = frame_;
+            event.depth     = scope.depth;
+            event.gpu       = true;
+        }
+
+        if (scope.hasStatistics)
+        {
+            event.statistics    = scope.statistics;
+            event.hasStatistics = true;
+        }
+
+        events_.push_back(std::move(event));
+    }
+}
+
+void RenderingProfiler::RecordFrameStatistics(const FrameStatistics& frameStats)
+{
+    if (!eventLogEnabled_)
+        return;
+
+    missedVblanks_ = frameStats.missedVblanks;
+
+    /* Ignore frames that have already been recorded and frames that reached the display before the profiler has been created */
+    if (frameStats.presentID == lastPresentID_ || frameStats.presentTime <= epoch_)
+        return;
+
+    lastPresentID_ = frameStats.presentID;
+
+    Event event;
+    {
+        event.name      = "Present " + std::to_string(frameStats.presentID);
+        event.category  = "Display";
+        event.startTime = frameStats.presentTime - epoch_;
+        event.duration  = frameStats.refreshDuration;
+        event.frame     = frame_;
+        event.display   = true;
+    }
+    events_.push_back(std::move(event));
+}
+
+void RenderingProfiler::NextFrame()
+{
+    if (eventLogEnabled_)
+    {
+        /* Store counters of the finished frame */
+        FrameCounters counters;
+        {
+            counters.frame          = frame_;
+            counters.endTime        = GetTimestamp();
+            counters.drawCalls      = drawCalls;
+            counters.triangles      = renderedTriangles;
+            counters.bindings       = GetNumBindings();
+            counters.missedVblanks  = missedVblanks_;
+        }
+        frameCounters_.push_back(counters);
+        frameStartTime_ = counters.endTime;
+    }
+
+    ++frame_;
+
+    /* Discard events of frames that are no longer kept in the event log */
+    while (!events_.empty() && events_.front().frame + maxEventLogFrames <= frame_)
+        events_.pop_front();
+    while (!frameCounters_.empty() && frameCounters_.front().frame + maxEventLogFrames <= frame_)
+        frameCounters_.pop_front();
+}
+
+void RenderingProfiler::ClearEvents()
+{
+    events_.clear();
+    frameCounters_.clear();
+}
+
+void RenderingProfiler::WriteTrace(std::ostream& stream) const
+{
+    static const int cpuThreadID = 1;
+    static const int gpuThreadID = 2;
+    static const int displayThreadID = 3;
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    /* Write track names */
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << cpuThreadID << ",\"args\":{\"name\":\"CPU\"}},\n";
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << gpuThreadID << ",\"args\":{\"name\":\"GPU\"}},\n";
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << displayThreadID << ",\"args\":{\"name\":\"Display\"}}";
+
+    /* Write complete events */
+    for (const auto& event : events_)
+    {
+        stream << ",\n{\"name\":";
+        WriteJSONString(stream, event.name.c_str());
+        stream << ",\"cat\":";
+        WriteJSONString(stream, event.category);
+        stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (event.gpu ? gpuThreadID : event.display ? displayThreadID : cpuThreadID) << ",\"ts\":";
+        WriteJSONTime(stream, event.startTime);
+        stream << ",\"dur\":";
+        WriteJSONTime(stream, event.duration);
+        stream << ",\"args\":{\"frame\":" << event.frame;
+        if (event.hasStatistics)
+            WriteJSONStatistics(stream, event.statistics);
+        stream << "}}";
+    }
+
+    /* Write counter events */
+    for (const auto& counters : frameCounters_)
+    {
+        stream << ",\n{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,\"ts\":";
+        WriteJSONTime(stream, counters.endTime);
+        stream << ",\"args\":{\"drawCalls\":" << counters.drawCalls;
+        stream << ",\"triangles\":" << counters.triangles;
+        stream << ",\"bindings\":" << counters.bindings;
+        stream << ",\"missedVblanks\":" << counters.missedVblanks << "}}";
+    }
+
+    stream << "\n]}\n";
+}
+
+void RenderingProfiler::WriteTraceFile(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.good())
+        throw std::runtime_error("failed to create trace file: " + filename);
+    WriteTrace(file);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+RenderingProfiler::Counter::ValueType RenderingProfiler::GetNumBindings() const
+{
+    return
+    (
+        setVertexBuffer + setIndexBuffer + setConstantBuffer + setStorageBuffer + setStreamOutputBuffer +
+        setGraphicsPipeline + setComputePipeline + setTexture + setSampler + setRenderTarget
+    );
+}
+
+
 } // /namespace LLGL
 
 
@@ -18,13 +18,15 @@ ResourceBindingIterator::ResourceBindingIterator(
     const std::vector<BindingDescriptor>& bindings) :
         resourceViews_ { resourceViews                                   },
         bindings_      { bindings                                        },
-        count_         { std::min(resourceViews.size(), bindings.size()) }
+        count_         { std::min(resourceViews.size(), GetNumResourceViews(bindings)) }
 {
 }
 
 void ResourceBindingIterator::Reset(const ResourceType typesOfInterest, long stagesOfInterest)
 {
     iterator_           = 0;
+    viewIterator_       = 0;
+    arrayElement_       = 0;
     typeOfInterest_     = typesOfInterest;
     stagesOfInterest_   = stagesOfInterest;
 }
@@ -41,6 +43,7 @@ static const char* ResourceTypeToString(const ResourceType t)
         case ResourceType::StreamOutputBuffer:  return "StreamOutputBuffer";
         case ResourceType::Texture:             return "Texture";
         case ResourceType::Sampler:             return "Sampler";
+        case ResourceType::AccelerationStructure:   return "AccelerationStructure";
         default:                                return "Undefined";
     }
 }
@@ -54,24 +57,50 @@ static void ErrNullPointerResource(const ResourceType t)
     );
 }
 
-Resource* ResourceBindingIterator::Next(BindingDescriptor& bindingDesc)
+// Returns the number of resource views that are consumed by the specified binding.
+static std::uint32_t GetNumResourceViewsForBinding(const BindingDescriptor& binding)
 {
-    while (iterator_ < count_)
+    return ((binding.flags & BindingFlags::Bindless) != 0 ? std::max(binding.arraySize, 1u) : 1u);
+}
+
+std::size_t ResourceBindingIterator::GetNumResourceViews(const std::vector<BindingDescriptor>& bindings)
+{
+    std::size_t n = 0;
+    for (const auto& binding : bindings)
+        n += GetNumResourceViewsForBinding(binding);
+    return n;
+}
+
+Resource* ResourceBindingIterator::Next(BindingDescriptor& bindingDesc, std::uint32_t* arrayElement)
+{
+    while (iterator_ < bindings_.size() && viewIterator_ < count_)
     {
+        const auto& binding = bindings_[iterator_];
+
+        /* Move to next binding after the last array element */
+        const auto element = arrayElement_;
+        const auto viewIndex = viewIterator_++;
+
+        if (++arrayElement_ >= GetNumResourceViewsForBinding(binding))
+        {
+            arrayElement_ = 0;
+            ++iterator_;
+        }
+
         /* Search for resource type of interest */
-        auto resourceType = bindings_[iterator_].type;
-        if (resourceType == typeOfInterest_ && (bindings_[iterator_].stageFlags & stagesOfInterest_) != 0)
+        if (binding.type == typeOfInterest_ && (binding.stageFlags & stagesOfInterest_) != 0)
         {
             /* Check for null pointer exception */
-            if (auto resource = resourceViews_[iterator_].resource)
+            if (auto resource = resourceViews_[viewIndex].resource)
             {
-                bindingDesc = bindings_[iterator_];
-                ++iterator_;
+                bindingDesc = binding;
+                bindingDesc.slot += element;
+                if (arrayElement != nullptr)
+                    *arrayElement = element;
                 return resource;
             }
-            ErrNullPointerResource(resourceType);
+            ErrNullPointerResource(binding.type);
         }
-        ++iterator_;
     }
     return nullptr;
 }
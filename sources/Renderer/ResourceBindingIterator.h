@@ -33,8 +33,11 @@ class LLGL_EXPORT ResourceBindingIterator
         // Resets the iteration process for the specified type of interest.
         void Reset(const ResourceType typesOfInterest, long stagesOfInterest = StageFlags::AllStages);
 
-        // Returns the next resource of the current type of interest, or null if there are no more resources of that type.
-        Resource* Next(BindingDescriptor& bindingDesc);
+        /*
+        Returns the next resource of the current type of interest, or null if there are no more resources of that type.
+        The elements of a bindless binding are returned one by one with consecutive slots, and 'arrayElement' receives the element index (if non-null).
+        */
+        Resource* Next(BindingDescriptor& bindingDesc, std::uint32_t* arrayElement = nullptr);
 
         // Returns the number of all resource.
         inline std::size_t GetCount() const
@@ -42,11 +45,16 @@ class LLGL_EXPORT ResourceBindingIterator
             return count_;
         }
 
+        // Returns the number of resource views that are consumed by the specified bindings (bindless bindings consume one view per array element).
+        static std::size_t GetNumResourceViews(const std::vector<BindingDescriptor>& bindings);
+
     private:
 
         const std::vector<ResourceViewDescriptor>&  resourceViews_;
         const std::vector<BindingDescriptor>&       bindings_;
         std::size_t                                 iterator_           = 0;
+        std::size_t                                 viewIterator_       = 0;
+        std::uint32_t                               arrayElement_       = 0;
         std::size_t                                 count_              = 0;
         ResourceType                                typeOfInterest_     = ResourceType::Undefined;
         long                                        stagesOfInterest_   = StageFlags::AllStages;
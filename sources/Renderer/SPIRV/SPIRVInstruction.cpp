@@ -135,6 +135,19 @@ std::uint32_t SPIRVInstruction::FindASCIIEndOffset(std::uint32_t offset) const
     return offset;
 }
 
+SPIRVStringView SPIRVInstruction::GetStringView(std::uint32_t offset) const
+{
+    SPIRVStringView view;
+    view.data = GetASCII(offset);
+
+    /* Count characters up to the null terminator or the end of the operands */
+    const auto maxLength = (numOperands - offset) * 4;
+    while (view.length < maxLength && view.data[view.length] != '\0')
+        ++view.length;
+
+    return view;
+}
+
 
 } // /namespace LLGL
 
@@ -17,6 +17,13 @@ namespace LLGL
 {
 
 
+// Non-owning view of an ASCII string literal within a SPIR-V shader module.
+struct SPIRVStringView
+{
+    const char*     data    = nullptr;
+    std::uint32_t   length  = 0;        // Number of characters without the null terminator
+};
+
 // SPIR-V shader module instruction structure.
 struct SPIRVInstruction
 {
@@ -47,6 +54,9 @@ struct SPIRVInstruction
     // Returns the operand offset after the end of the ASCII string operands beginning at the specified offset.
     std::uint32_t FindASCIIEndOffset(std::uint32_t offset) const;
 
+    // Returns the operands as ASCII string view into the shader module, which never exceeds the operands of this instruction.
+    SPIRVStringView GetStringView(std::uint32_t offset) const;
+
     spv::Op         opCode      = spv::Op::OpNop;   // Instruction op-code. By default OpNop.
     spv::Id         type        = 0;                // Type ID number. By default 0.
     spv::Id         result      = 0;                // Result ID number. By default 0.
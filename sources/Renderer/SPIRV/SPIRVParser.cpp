@@ -27,9 +27,13 @@ void SPIRVParser::Parse(const void* byteCode, std::size_t byteCodeSize)
         throw std::invalid_argument("size of SPIR-V shader byte code must be a multiple of 4 bytes");
 
     /* Convert byte code pointer to word pointer */
-    auto words      = reinterpret_cast<const std::uint32_t*>(byteCode);
-    auto numWords   = static_cast<std::uint32_t>(byteCodeSize / 4);
+    Parse(reinterpret_cast<const std::uint32_t*>(byteCode), byteCodeSize / 4);
+}
 
+void SPIRVParser::Parse(const std::uint32_t* words, std::size_t numWords)
+{
+    if (!words)
+        throw std::invalid_argument("SPIR-V shader module must not be a null pointer");
     if (numWords < 5)
         throw std::invalid_argument("too few words in SPIR-V shader module");
 
@@ -45,7 +49,7 @@ void SPIRVParser::Parse(const void* byteCode, std::size_t byteCodeSize)
     OnParseHeader(header);
 
     /* Parse instructions */
-    for (std::uint32_t i = 5; i < numWords;)
+    for (std::size_t i = 5; i < numWords;)
     {
         /* Parse next instruction */
         SPIRVInstruction instr;
@@ -56,6 +60,10 @@ void SPIRVParser::Parse(const void* byteCode, std::size_t byteCodeSize)
             auto wordCount  = (firstWord >> spv::WordCountShift);
             instr.opCode    = static_cast<spv::Op>(firstWord & spv::OpCodeMask);
 
+            /* Validate word count, since all operands refer directly into the shader module */
+            if (wordCount == 0 || wordCount - 1 > numWords - i)
+                throw std::invalid_argument("invalid word count of instruction in SPIR-V shader module");
+
             --wordCount;
 
             auto lookup = GetSPIRVLookup(instr.opCode);
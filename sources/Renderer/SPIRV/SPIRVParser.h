@@ -38,6 +38,9 @@ class SPIRVParser
         // Parses the specified SPIR-V shader byte code and throws an std::invalid_argument exception if the byte code is invalid.
         void Parse(const void* byteCode, std::size_t byteCodeSize);
 
+        // Parses the specified SPIR-V shader module words in place, i.e. all instructions refer directly into the specified words.
+        void Parse(const std::uint32_t* words, std::size_t numWords);
+
     protected:
 
         // Callback function for the SPIR-V shader module header.
@@ -6,18 +6,78 @@
  */
 
 #include "SPIRVReflect.h"
-#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
+/*
+ * Internal structures
+ */
+
+// Header of each reflection cache file, followed by the uniforms, the varyings, and the string table.
+struct SPIRVReflectionHeader
+{
+    char            magic[4];       // "LLSR"
+    std::uint32_t   version;        // Cache format version, see 'g_reflectionCacheVersion'
+    std::uint64_t   moduleHash;     // Hash of the SPIR-V module the reflection belongs to
+    std::uint32_t   numUniforms;
+    std::uint32_t   numVaryings;
+    std::uint32_t   namesSize;      // Size of the string table (in bytes)
+    std::uint32_t   reserved;       // Always zero
+};
+
+static const char           g_reflectionCacheMagic[4]   = { 'L', 'L', 'S', 'R' };
+static const std::uint32_t  g_reflectionCacheVersion    = 2;
+
+// Storage class of SPV_KHR_storage_buffer_storage_class, which is not part of every SPIR-V header version
+static const std::uint32_t  g_storageClassStorageBuffer = 12;
+
+
+/*
+ * SPIRVReflection structure
+ */
+
+void SPIRVReflection::Clear()
+{
+    uniforms.clear();
+    varyings.clear();
+    names.clear();
+}
+
+
+/*
+ * SPIRVReflect class
+ */
+
+void SPIRVReflect::Reflect(const std::uint32_t* words, std::size_t numWords, SPIRVReflection& reflection)
+{
+    Parse(words, numWords);
+    WriteReflection(reflection);
+}
+
+void SPIRVReflect::Reflect(const void* byteCode, std::size_t byteCodeSize, SPIRVReflection& reflection)
+{
+    Parse(byteCode, byteCodeSize);
+    WriteReflection(reflection);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
 void SPIRVReflect::OnParseHeader(const SPIRVHeader& header)
 {
+    SPIRVParser::OnParseHeader(header);
+
+    /* Reset per-ID storage, which only re-allocates if the ID-bound exceeds its capacity */
     idBound_ = header.idBound;
-    if (idBound_ > 0)
-        names_.resize(idBound_);
+    ids_.assign(idBound_, IdEntry{});
 }
 
 void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
@@ -30,6 +90,21 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpDecorate:
             OpDecorate(instr);
             break;
+        case spv::Op::OpVariable:
+            OpVariable(instr);
+            break;
+        case spv::Op::OpTypePointer:
+        case spv::Op::OpTypeArray:
+        case spv::Op::OpTypeRuntimeArray:
+        case spv::Op::OpTypeStruct:
+        case spv::Op::OpTypeImage:
+        case spv::Op::OpTypeSampledImage:
+        case spv::Op::OpTypeSampler:
+            OpType(instr);
+            break;
+        case spv::Op::OpConstant:
+            OpConstant(instr);
+            break;
         default:
             break;
     }
@@ -37,53 +112,190 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
 
 void SPIRVReflect::OpName(const Instr& instr)
 {
-    SetName(instr.GetUInt32(0), instr.GetASCII(1));
+    GetEntry(instr.GetUInt32(0)).name = instr.GetStringView(1);
 }
 
 void SPIRVReflect::OpDecorate(const Instr& instr)
 {
+    auto& entry = GetEntry(instr.GetUInt32(0));
+
     auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(1));
     switch (decoration)
     {
         case spv::Decoration::Binding:
-            OpDecorateBinding(instr);
+            entry.flags         |= HasBinding;
+            entry.bindingPoint  = instr.GetUInt32(2);
+            break;
+        case spv::Decoration::DescriptorSet:
+            entry.descriptorSet = instr.GetUInt32(2);
             break;
         case spv::Decoration::Location:
-            OpDecorateLocation(instr);
+            entry.flags         |= HasLocation;
+            entry.location      = instr.GetUInt32(2);
+            break;
+        case spv::Decoration::Block:
+            entry.flags         |= IsBlock;
+            break;
+        case spv::Decoration::BufferBlock:
+            entry.flags         |= IsBufferBlock;
+            break;
+        default:
+            break;
+    }
+}
+
+void SPIRVReflect::OpVariable(const Instr& instr)
+{
+    auto& entry = GetEntry(instr.result);
+    entry.opCode    = instr.opCode;
+    entry.typeId    = instr.type;
+    entry.value     = instr.GetUInt32(0);
+}
+
+void SPIRVReflect::OpType(const Instr& instr)
+{
+    auto& entry = GetEntry(instr.result);
+    entry.opCode = instr.opCode;
+
+    switch (instr.opCode)
+    {
+        case spv::Op::OpTypePointer:
+            entry.value     = instr.GetUInt32(0);
+            entry.typeId    = instr.GetUInt32(1);
+            break;
+        case spv::Op::OpTypeArray:
+            entry.typeId    = instr.GetUInt32(0);
+            entry.value     = instr.GetUInt32(1);
+            break;
+        case spv::Op::OpTypeRuntimeArray:
+            entry.typeId    = instr.GetUInt32(0);
+            break;
+        default:
+            break;
+    }
+}
+
+void SPIRVReflect::OpConstant(const Instr& instr)
+{
+    auto& entry = GetEntry(instr.result);
+    entry.opCode    = instr.opCode;
+    entry.typeId    = instr.type;
+    entry.value     = instr.GetUInt32(0);
+}
+
+const SPIRVReflect::IdEntry* SPIRVReflect::ResolveUniformType(const IdEntry& variable, SPIRVReflection::Uniform& uniform) const
+{
+    if (variable.opCode != spv::Op::OpVariable)
+        return nullptr;
+
+    /* Get pointee type of the variable */
+    auto pointer = FindEntry(variable.typeId);
+    if (pointer == nullptr || pointer->opCode != spv::Op::OpTypePointer)
+        return nullptr;
+
+    /* Unroll array dimensions; runtime arrays do not add to the array size */
+    auto type = FindEntry(pointer->typeId);
+
+    while (type != nullptr && (type->opCode == spv::Op::OpTypeArray || type->opCode == spv::Op::OpTypeRuntimeArray))
+    {
+        if (type->opCode == spv::Op::OpTypeArray)
+        {
+            auto length = FindEntry(type->value);
+            if (length != nullptr && length->opCode == spv::Op::OpConstant && length->value > 0)
+                uniform.arraySize *= length->value;
+        }
+        type = FindEntry(type->typeId);
+    }
+
+    if (type == nullptr)
+        return nullptr;
+
+    /* Determine resource type by the innermost type and the storage class */
+    switch (type->opCode)
+    {
+        case spv::Op::OpTypeStruct:
+            if (variable.value == g_storageClassStorageBuffer || (type->flags & IsBufferBlock) != 0)
+                uniform.type = ResourceType::StorageBuffer;
+            else if (variable.value == static_cast<std::uint32_t>(spv::StorageClass::Uniform))
+                uniform.type = ResourceType::ConstantBuffer;
+            break;
+        case spv::Op::OpTypeImage:
+        case spv::Op::OpTypeSampledImage:
+            uniform.type = ResourceType::Texture;
+            break;
+        case spv::Op::OpTypeSampler:
+            uniform.type = ResourceType::Sampler;
             break;
         default:
             break;
     }
+
+    return type;
 }
 
-void SPIRVReflect::OpDecorateBinding(const Instr& instr)
+// Appends the specified name to the string table and returns its offset, or 0 for an empty name.
+static std::uint32_t AppendName(std::vector<char>& names, const SPIRVStringView& name)
 {
-    auto id         = instr.GetUInt32(0);
-    auto& variable  = uniforms_[id];
+    if (name.length == 0)
+        return 0;
 
-    variable.name           = GetName(id);
-    variable.bindingPoint   = instr.GetUInt32(2);
+    const auto offset = static_cast<std::uint32_t>(names.size());
+    names.insert(names.end(), name.data, name.data + name.length);
+    names.push_back('\0');
+
+    return offset;
 }
 
-void SPIRVReflect::OpDecorateLocation(const Instr& instr)
+void SPIRVReflect::WriteReflection(SPIRVReflection& reflection) const
 {
-    auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
+    reflection.Clear();
+    reflection.names.push_back('\0');
+
+    for (std::uint32_t id = 0; id < idBound_; ++id)
+    {
+        const auto& entry = ids_[id];
 
-    variable.name       = GetName(id);
-    variable.location   = instr.GetUInt32(2);
+        if ((entry.flags & HasBinding) != 0)
+        {
+            SPIRVReflection::Uniform uniform;
+            {
+                uniform.id              = id;
+                uniform.descriptorSet   = entry.descriptorSet;
+                uniform.bindingPoint    = entry.bindingPoint;
+            }
+
+            /* Uniform blocks without instance name are named after their block type */
+            auto type = ResolveUniformType(entry, uniform);
+            if (entry.name.length == 0 && type != nullptr)
+                uniform.name = AppendName(reflection.names, type->name);
+            else
+                uniform.name = AppendName(reflection.names, entry.name);
+
+            reflection.uniforms.push_back(uniform);
+        }
+        else if ((entry.flags & HasLocation) != 0)
+        {
+            SPIRVReflection::Varying varying;
+            {
+                varying.id              = id;
+                varying.location        = entry.location;
+                varying.name            = AppendName(reflection.names, entry.name);
+                varying.input           = (entry.opCode == spv::Op::OpVariable && entry.value == static_cast<std::uint32_t>(spv::StorageClass::Input) ? 1 : 0);
+            }
+            reflection.varyings.push_back(varying);
+        }
+    }
 }
 
-void SPIRVReflect::SetName(spv::Id id, const char* name)
+SPIRVReflect::IdEntry& SPIRVReflect::GetEntry(spv::Id id)
 {
     AssertIdBound(id);
-    names_[id] = name;
+    return ids_[id];
 }
 
-const char* SPIRVReflect::GetName(spv::Id id) const
+const SPIRVReflect::IdEntry* SPIRVReflect::FindEntry(spv::Id id) const
 {
-    AssertIdBound(id);
-    return names_[id];
+    return (id < idBound_ ? &(ids_[id]) : nullptr);
 }
 
 void SPIRVReflect::AssertIdBound(spv::Id id) const
@@ -98,6 +310,76 @@ void SPIRVReflect::AssertIdBound(spv::Id id) const
 }
 
 
+/*
+ * Global functions
+ */
+
+bool ReadSPIRVReflection(const std::string& filename, std::uint64_t moduleHash, SPIRVReflection& reflection)
+{
+    std::ifstream file { filename, std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Read and validate header */
+    SPIRVReflectionHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_reflectionCacheMagic, sizeof(g_reflectionCacheMagic)) != 0 ||
+        header.version != g_reflectionCacheVersion ||
+        header.moduleHash != moduleHash ||
+        header.namesSize == 0)
+    {
+        return false;
+    }
+
+    /* Read entries and string table; a truncated file is treated as a cache miss */
+    reflection.uniforms.resize(header.numUniforms);
+    reflection.varyings.resize(header.numVaryings);
+    reflection.names.resize(header.namesSize);
+
+    if (!file.read(reinterpret_cast<char*>(reflection.uniforms.data()), static_cast<std::streamsize>(header.numUniforms * sizeof(SPIRVReflection::Uniform))) ||
+        !file.read(reinterpret_cast<char*>(reflection.varyings.data()), static_cast<std::streamsize>(header.numVaryings * sizeof(SPIRVReflection::Varying))) ||
+        !file.read(reflection.names.data(), static_cast<std::streamsize>(header.namesSize)))
+    {
+        reflection.Clear();
+        return false;
+    }
+
+    /* String table must be null-terminated, so all names are valid C strings */
+    if (reflection.names.back() != '\0')
+    {
+        reflection.Clear();
+        return false;
+    }
+
+    return true;
+}
+
+void WriteSPIRVReflection(const std::string& filename, std::uint64_t moduleHash, const SPIRVReflection& reflection)
+{
+    std::ofstream file { filename, (std::ios_base::binary | std::ios_base::trunc) };
+    if (!file.good())
+        return;
+
+    /* Write header, entries, and string table */
+    SPIRVReflectionHeader header;
+    {
+        std::memcpy(header.magic, g_reflectionCacheMagic, sizeof(g_reflectionCacheMagic));
+        header.version      = g_reflectionCacheVersion;
+        header.moduleHash   = moduleHash;
+        header.numUniforms  = static_cast<std::uint32_t>(reflection.uniforms.size());
+        header.numVaryings  = static_cast<std::uint32_t>(reflection.varyings.size());
+        header.namesSize    = static_cast<std::uint32_t>(reflection.names.size());
+        header.reserved     = 0;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(reflection.uniforms.data()), static_cast<std::streamsize>(reflection.uniforms.size() * sizeof(SPIRVReflection::Uniform)));
+    file.write(reinterpret_cast<const char*>(reflection.varyings.data()), static_cast<std::streamsize>(reflection.varyings.size() * sizeof(SPIRVReflection::Varying)));
+    file.write(reflection.names.data(), static_cast<std::streamsize>(reflection.names.size()));
+}
+
+
 } // /namespace LLGL
 
 
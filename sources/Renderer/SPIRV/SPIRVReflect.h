@@ -10,59 +10,127 @@
 
 
 #include "SPIRVParser.h"
+#include <LLGL/ResourceFlags.h>
 #include <vector>
-#include <map>
+#include <string>
 
 
 namespace LLGL
 {
 
 
-// SPIR-V shader module parser.
+/*
+Compact reflection of a SPIR-V shader module, which can be cached in a binary file next to the module (see WriteSPIRVReflection).
+All names are stored in a single null-terminated string table, and each entry refers to its name by offset into that table.
+*/
+struct SPIRVReflection
+{
+    struct Uniform
+    {
+        std::uint32_t   id              = 0;
+        std::uint32_t   descriptorSet   = 0;
+        std::uint32_t   bindingPoint    = 0;
+        std::uint32_t   arraySize       = 1;    // Product of all array dimensions, or 1 for runtime arrays
+        ResourceType    type            = ResourceType::Undefined;
+        std::uint32_t   name            = 0;    // Offset into 'names'
+    };
+
+    struct Varying
+    {
+        std::uint32_t   id              = 0;
+        std::uint32_t   location        = 0;
+        std::uint32_t   name            = 0;    // Offset into 'names'
+        std::uint32_t   input           = 0;    // Non-zero for shader inputs, zero for shader outputs
+    };
+
+    // Removes all entries but keeps the allocated memory.
+    void Clear();
+
+    // Returns the null-terminated name at the specified offset into the string table.
+    inline const char* GetName(std::uint32_t offset) const
+    {
+        return (offset < names.size() ? &(names[offset]) : "");
+    }
+
+    std::vector<Uniform>    uniforms;
+    std::vector<Varying>    varyings;
+    std::vector<char>       names;      // String table, which always begins with an empty string for unnamed entries
+};
+
+/*
+Streaming SPIR-V shader module reflector.
+Names are only referenced as string views into the shader module while it is parsed, and the per-ID storage is reused for each module,
+so reflecting many modules with the same instance only allocates when a module exceeds the largest ID-bound so far.
+*/
 class SPIRVReflect : public SPIRVParser
 {
 
-    protected:
+    public:
 
-        struct Uniform
-        {
-            const char*     name            = nullptr;
-            std::uint32_t   bindingPoint    = 0;
-            std::uint32_t   descriptorSet   = 0;
-        };
+        // Reflects the specified SPIR-V shader module words into the output, and throws an std::invalid_argument exception if the module is invalid.
+        void Reflect(const std::uint32_t* words, std::size_t numWords, SPIRVReflection& reflection);
 
-        struct Varying
-        {
-            const char*     name        = nullptr;
-            std::uint32_t   location    = 0;
-            bool            input       = false;
-        };
+        // Reflects the specified SPIR-V shader byte code into the output, and throws an std::invalid_argument exception if the byte code is invalid.
+        void Reflect(const void* byteCode, std::size_t byteCodeSize, SPIRVReflection& reflection);
 
     private:
 
         using Instr = SPIRVInstruction;
 
+        enum IdFlags : std::uint32_t
+        {
+            HasBinding      = (1 << 0),
+            HasLocation     = (1 << 1),
+            IsBlock         = (1 << 2),
+            IsBufferBlock   = (1 << 3),
+        };
+
+        // Reflection state of a single ID number.
+        struct IdEntry
+        {
+            SPIRVStringView name;
+            spv::Op         opCode          = spv::Op::OpNop;   // Instruction that declared this ID (only recorded for types, constants, and variables)
+            std::uint32_t   flags           = 0;
+            std::uint32_t   descriptorSet   = 0;
+            std::uint32_t   bindingPoint    = 0;
+            std::uint32_t   location        = 0;
+            std::uint32_t   typeId          = 0;                // Type of variables and constants, pointee type of pointers, element type of arrays
+            std::uint32_t   value           = 0;                // Storage class of variables and pointers, length ID of arrays, value of constants
+        };
+
         void OnParseHeader(const SPIRVHeader& header) override;
         void OnParseInstruction(const SPIRVInstruction& instr) override;
 
         void OpName(const Instr& instr);
         void OpDecorate(const Instr& instr);
-        void OpDecorateBinding(const Instr& instr);
-        void OpDecorateLocation(const Instr& instr);
+        void OpVariable(const Instr& instr);
+        void OpType(const Instr& instr);
+        void OpConstant(const Instr& instr);
 
-        void SetName(spv::Id id, const char* name);
-        const char* GetName(spv::Id id) const;
+        // Determines the resource type and array size of the specified uniform variable, and returns the entry of its innermost type (or null).
+        const IdEntry* ResolveUniformType(const IdEntry& variable, SPIRVReflection::Uniform& uniform) const;
 
-        void AssertIdBound(spv::Id id) const;
+        // Writes all reflected IDs in ascending order into the output.
+        void WriteReflection(SPIRVReflection& reflection) const;
+
+        IdEntry& GetEntry(spv::Id id);
+
+        // Returns the entry of the specified ID, or null if the ID is out of range.
+        const IdEntry* FindEntry(spv::Id id) const;
 
-        std::uint32_t               idBound_    = 0;
-        std::vector<const char*>    names_;
+        void AssertIdBound(spv::Id id) const;
 
-        std::map<spv::Id, Uniform>  uniforms_;
-        std::map<spv::Id, Varying>  varyings_;
+        std::uint32_t           idBound_    = 0;
+        std::vector<IdEntry>    ids_;
 
 };
 
+// Reads the reflection of the SPIR-V module with the specified hash from a cache file. Returns false if the file is missing, corrupted, or outdated.
+bool ReadSPIRVReflection(const std::string& filename, std::uint64_t moduleHash, SPIRVReflection& reflection);
+
+// Writes the reflection of the SPIR-V module with the specified hash into a cache file. Failures are ignored, since the cache is optional.
+void WriteSPIRVReflection(const std::string& filename, std::uint64_t moduleHash, const SPIRVReflection& reflection);
+
 
 } // /namespace LLGL
 
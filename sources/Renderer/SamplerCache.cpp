@@ -0,0 +1,183 @@
+/*
+ * SamplerCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SamplerCache.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static bool HasBorderAddressMode(const SamplerDescriptor& desc)
+{
+    return
+    (
+        desc.addressModeU == SamplerAddressMode::Border ||
+        desc.addressModeV == SamplerAddressMode::Border ||
+        desc.addressModeW == SamplerAddressMode::Border
+    );
+}
+
+// Returns the specified descriptor with default values for all attributes that don't affect the sampler state.
+static SamplerDescriptor NormalizeSamplerDesc(const SamplerDescriptor& desc)
+{
+    SamplerDescriptor normDesc = desc;
+
+    if (!desc.mipMapping)
+        normDesc.mipMapFilter = SamplerFilter::Linear;
+    if (!desc.compareEnabled)
+        normDesc.compareOp = CompareOp::Less;
+    if (!HasBorderAddressMode(desc))
+        normDesc.borderColor = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    /* Replace negative zeros, so the hash is equal for all values that compare equal */
+    normDesc.mipMapLODBias  += 0.0f;
+    normDesc.minLOD         += 0.0f;
+    normDesc.maxLOD         += 0.0f;
+    for (std::size_t i = 0; i < 4; ++i)
+        normDesc.borderColor[i] += 0.0f;
+
+    return normDesc;
+}
+
+static bool CompareSamplerDescEqual(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs)
+{
+    return
+    (
+        lhs.addressModeU    == rhs.addressModeU     &&
+        lhs.addressModeV    == rhs.addressModeV     &&
+        lhs.addressModeW    == rhs.addressModeW     &&
+        lhs.minFilter       == rhs.minFilter        &&
+        lhs.magFilter       == rhs.magFilter        &&
+        lhs.mipMapFilter    == rhs.mipMapFilter     &&
+        lhs.mipMapping      == rhs.mipMapping       &&
+        lhs.mipMapLODBias   == rhs.mipMapLODBias    &&
+        lhs.minLOD          == rhs.minLOD           &&
+        lhs.maxLOD          == rhs.maxLOD           &&
+        lhs.maxAnisotropy   == rhs.maxAnisotropy    &&
+        lhs.compareEnabled  == rhs.compareEnabled   &&
+        lhs.compareOp       == rhs.compareOp        &&
+        lhs.borderColor.r   == rhs.borderColor.r    &&
+        lhs.borderColor.g   == rhs.borderColor.g    &&
+        lhs.borderColor.b   == rhs.borderColor.b    &&
+        lhs.borderColor.a   == rhs.borderColor.a
+    );
+}
+
+// Combines the specified value into the hash (FNV-1a over a 32-bit word).
+static void HashCombine(std::size_t& seed, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i, value >>= 8)
+    {
+        seed ^= static_cast<std::size_t>(value & 0xFF);
+        seed *= static_cast<std::size_t>(16777619u);
+    }
+}
+
+static void HashCombine(std::size_t& seed, float value)
+{
+    std::uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+    HashCombine(seed, bits);
+}
+
+// Returns the hash of the specified normalized sampler descriptor.
+static std::size_t HashSamplerDesc(const SamplerDescriptor& desc)
+{
+    std::size_t seed = static_cast<std::size_t>(2166136261u);
+
+    HashCombine(seed, static_cast<std::uint32_t>(desc.addressModeU));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.addressModeV));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.addressModeW));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.minFilter));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.magFilter));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.mipMapFilter));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.mipMapping));
+    HashCombine(seed, desc.mipMapLODBias);
+    HashCombine(seed, desc.minLOD);
+    HashCombine(seed, desc.maxLOD);
+    HashCombine(seed, desc.maxAnisotropy);
+    HashCombine(seed, static_cast<std::uint32_t>(desc.compareEnabled));
+    HashCombine(seed, static_cast<std::uint32_t>(desc.compareOp));
+
+    for (std::size_t i = 0; i < 4; ++i)
+        HashCombine(seed, desc.borderColor[i]);
+
+    return seed;
+}
+
+// private
+Sampler* SamplerCache::Acquire(const SamplerDescriptor& desc)
+{
+    const auto normDesc = NormalizeSamplerDesc(desc);
+    const auto range    = entries_.equal_range(HashSamplerDesc(normDesc));
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (CompareSamplerDescEqual(it->second.desc, normDesc))
+        {
+            ++(it->second.refCount);
+            return it->second.sampler;
+        }
+    }
+
+    return nullptr;
+}
+
+// private
+void SamplerCache::Insert(const SamplerDescriptor& desc, Sampler* sampler)
+{
+    if (sampler != nullptr)
+    {
+        const auto normDesc = NormalizeSamplerDesc(desc);
+        const auto hash     = HashSamplerDesc(normDesc);
+        entries_.insert({ hash, Entry{ normDesc, sampler, 1u } });
+        hashes_[sampler] = hash;
+    }
+}
+
+bool SamplerCache::Release(const Sampler& sampler)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Samplers that are not cached are not shared */
+    auto hashIt = hashes_.find(&sampler);
+    if (hashIt == hashes_.end())
+        return true;
+
+    const auto range = entries_.equal_range(hashIt->second);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.sampler == &sampler)
+        {
+            if (--(it->second.refCount) > 0)
+                return false;
+            entries_.erase(it);
+            break;
+        }
+    }
+
+    hashes_.erase(hashIt);
+
+    return true;
+}
+
+void SamplerCache::Clear()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    entries_.clear();
+    hashes_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
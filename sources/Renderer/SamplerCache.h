@@ -0,0 +1,98 @@
+/*
+ * SamplerCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SAMPLER_CACHE_H
+#define LLGL_SAMPLER_CACHE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Sampler.h>
+#include <LLGL/SamplerFlags.h>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Reference counted cache of sampler states, which is shared by all backends.
+Identical sampler descriptors return the same sampler object (i.e. the same native sampler state),
+which keeps the number of unique samplers low (e.g. D3D11 is limited to 4096 sampler states)
+and lets the redundant-bind filtering of the backends detect equal samplers by their address.
+The cache does not own the samplers: they remain in the object container of the render system,
+and are only destroyed when 'Release' reports that the last reference has been released.
+All functions are thread-safe, so samplers can be created and released on worker threads.
+*/
+class LLGL_EXPORT SamplerCache
+{
+
+    public:
+
+        SamplerCache() = default;
+
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator = (const SamplerCache&) = delete;
+
+        /*
+        Returns the cached sampler for the specified descriptor and increments its reference counter.
+        Otherwise, the sampler is created with the specified factory (which returns the new sampler or null) and inserted into the cache.
+        */
+        template <typename Factory>
+        Sampler* GetOrCreate(const SamplerDescriptor& desc, Factory factory)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            if (auto sampler = Acquire(desc))
+                return sampler;
+            auto sampler = factory();
+            Insert(desc, sampler);
+            return sampler;
+        }
+
+        // Decrements the reference counter of the specified sampler. Returns true if the sampler is no longer referenced and must be destroyed.
+        bool Release(const Sampler& sampler);
+
+        // Removes all samplers from the cache (without destroying them).
+        void Clear();
+
+    private:
+
+        // Returns the cached sampler for the specified descriptor and increments its reference counter, or null if there is no such sampler.
+        Sampler* Acquire(const SamplerDescriptor& desc);
+
+        // Inserts the specified sampler with a reference counter of one. Null pointers are ignored.
+        void Insert(const SamplerDescriptor& desc, Sampler* sampler);
+
+    private:
+
+        struct Entry
+        {
+            SamplerDescriptor   desc;
+            Sampler*            sampler;
+            std::uint32_t       refCount;
+        };
+
+    private:
+
+        std::mutex                                          mutex_;     // Guards both maps; held while a new sampler is created, so identical descriptors never create two samplers
+        std::unordered_multimap<std::size_t, Entry>         entries_;   // Cached samplers by the hash of their normalized descriptor
+        std::unordered_map<const Sampler*, std::size_t>     hashes_;    // Hash of each cached sampler to find its entry on release
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
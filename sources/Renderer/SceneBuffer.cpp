@@ -0,0 +1,149 @@
+/*
+ * SceneBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/SceneBuffer.h>
+#include <LLGL/RenderSystem.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+SceneBuffer::SceneBuffer(RenderSystem& renderSystem, const SceneBufferDescriptor& desc, const void* initialData) :
+    renderSystem_  { renderSystem       },
+    elementSize_   { desc.elementSize   },
+    mergeDistance_ { desc.mergeDistance }
+{
+    if (desc.elementSize == 0)
+        throw std::invalid_argument("cannot create scene buffer with zero element size");
+    if (desc.buffer.size == 0 || desc.buffer.size % desc.elementSize != 0)
+    {
+        throw std::invalid_argument(
+            "cannot create scene buffer with size of " + std::to_string(desc.buffer.size) +
+            " bytes, which is not a non-zero multiple of the element size of " + std::to_string(desc.elementSize) + " bytes"
+        );
+    }
+
+    const auto numElements = desc.buffer.size / desc.elementSize;
+    if (numElements > UINT32_MAX)
+        throw std::invalid_argument("cannot create scene buffer with more than 2^32-1 elements");
+
+    numElements_ = static_cast<std::uint32_t>(numElements);
+
+    /* Initialize CPU shadow with the initial data, so that merged ranges never upload undefined memory */
+    shadow_.resize(static_cast<std::size_t>(desc.buffer.size));
+    if (initialData != nullptr)
+        ::memcpy(shadow_.data(), initialData, shadow_.size());
+
+    /* Create persistent buffer, which is only written partially */
+    auto bufferDesc = desc.buffer;
+    bufferDesc.flags &= ~BufferFlags::DynamicUsage;
+    buffer_ = renderSystem_.CreateBuffer(bufferDesc, shadow_.data());
+}
+
+SceneBuffer::~SceneBuffer()
+{
+    renderSystem_.Release(*buffer_);
+}
+
+void SceneBuffer::WriteElements(std::uint32_t firstElement, std::uint32_t numElements, const void* data)
+{
+    auto dst = MapElements(firstElement, numElements);
+    ::memcpy(dst, data, static_cast<std::size_t>(numElements) * elementSize_);
+}
+
+void* SceneBuffer::MapElements(std::uint32_t firstElement, std::uint32_t numElements)
+{
+    if (firstElement > numElements_ || numElements > numElements_ - firstElement)
+    {
+        throw std::out_of_range(
+            "scene buffer element range [" + std::to_string(firstElement) + ", " + std::to_string(static_cast<std::uint64_t>(firstElement) + numElements) +
+            ") out of bounds (" + std::to_string(numElements_) + " elements)"
+        );
+    }
+
+    MarkDirty(firstElement, numElements);
+
+    return &shadow_[static_cast<std::size_t>(firstElement) * elementSize_];
+}
+
+std::uint64_t SceneBuffer::Flush()
+{
+    if (dirtyRanges_.empty())
+        return 0;
+
+    /* Sort dirty ranges and merge overlapping or nearby ranges */
+    std::sort(
+        dirtyRanges_.begin(),
+        dirtyRanges_.end(),
+        [](const ElementRange& lhs, const ElementRange& rhs)
+        {
+            return (lhs.begin < rhs.begin);
+        }
+    );
+
+    std::size_t numRanges = 0;
+    for (const auto& range : dirtyRanges_)
+    {
+        if (numRanges > 0 && range.begin <= static_cast<std::uint64_t>(dirtyRanges_[numRanges - 1].end) + mergeDistance_)
+            dirtyRanges_[numRanges - 1].end = std::max(dirtyRanges_[numRanges - 1].end, range.end);
+        else
+            dirtyRanges_[numRanges++] = range;
+    }
+
+    /* Upload merged ranges from the CPU shadow */
+    std::uint64_t uploadSize = 0;
+
+    for (std::size_t i = 0; i < numRanges; ++i)
+    {
+        const auto offset   = static_cast<std::size_t>(dirtyRanges_[i].begin) * elementSize_;
+        const auto size     = static_cast<std::size_t>(dirtyRanges_[i].end - dirtyRanges_[i].begin) * elementSize_;
+        renderSystem_.WriteBuffer(*buffer_, &shadow_[offset], size, offset);
+        uploadSize += size;
+    }
+
+    dirtyRanges_.clear();
+
+    return uploadSize;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void SceneBuffer::MarkDirty(std::uint32_t firstElement, std::uint32_t numElements)
+{
+    if (numElements == 0)
+        return;
+
+    const auto lastElement = firstElement + numElements;
+
+    /* Extend the previous range for sequential writes, which is the common case */
+    if (!dirtyRanges_.empty())
+    {
+        auto& prev = dirtyRanges_.back();
+        if (firstElement >= prev.begin && firstElement <= prev.end)
+        {
+            prev.end = std::max(prev.end, lastElement);
+            return;
+        }
+    }
+
+    dirtyRanges_.push_back({ firstElement, lastElement });
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
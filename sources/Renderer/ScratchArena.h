@@ -0,0 +1,164 @@
+/*
+ * ScratchArena.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SCRATCH_ARENA_H
+#define LLGL_SCRATCH_ARENA_H
+
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Linear allocator for transient arrays of trivial types, which are only used for the duration of a single command
+(e.g. query results or converted copy regions) and replaces temporary std::vector objects in these code paths.
+Allocations are not released individually, but all at once by rewinding the arena (see 'Reset' and 'ScratchArena::Scope').
+The memory blocks are kept, and once all allocations have been released, multiple blocks are merged into a single block,
+so subsequent allocations do not require any heap allocation as long as they do not exceed the previous peak size.
+*/
+class ScratchArena
+{
+
+    public:
+
+        // Restores the allocation offset of the arena when it goes out of scope, i.e. releases all allocations of this scope.
+        class Scope
+        {
+
+            public:
+
+                Scope(ScratchArena& arena) :
+                    arena_  { arena              },
+                    block_  { arena.blockIndex_  },
+                    offset_ { arena.blockOffset_ }
+                {
+                }
+
+                ~Scope()
+                {
+                    if (block_ == 0 && offset_ == 0)
+                        arena_.Reset();
+                    else
+                    {
+                        arena_.blockIndex_  = block_;
+                        arena_.blockOffset_ = offset_;
+                    }
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator = (const Scope&) = delete;
+
+            private:
+
+                ScratchArena&   arena_;
+                std::size_t     block_  = 0;
+                std::size_t     offset_ = 0;
+
+        };
+
+    public:
+
+        ScratchArena() = default;
+
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator = (const ScratchArena&) = delete;
+
+        // Returns uninitialized memory for the specified number of elements, which remains valid until the arena is rewound.
+        template <typename T>
+        T* Allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "ScratchArena only supports trivially destructible types");
+            return reinterpret_cast<T*>(AllocateBytes(sizeof(T) * count, alignof(T)));
+        }
+
+        // Returns memory for the specified elements, which are copied into the arena.
+        template <typename T>
+        T* Copy(const T* first, std::size_t count)
+        {
+            auto elements = Allocate<T>(count);
+            std::copy(first, first + count, elements);
+            return elements;
+        }
+
+        // Releases all allocations and merges all memory blocks into one, whose size is the sum of all previous blocks.
+        void Reset()
+        {
+            if (blocks_.size() > 1)
+            {
+                std::size_t size = 0;
+                for (const auto& block : blocks_)
+                    size += block.size;
+
+                blocks_.clear();
+                AppendBlock(size);
+            }
+            blockIndex_     = 0;
+            blockOffset_    = 0;
+        }
+
+    private:
+
+        // Minimal size (in bytes) of each memory block.
+        static const std::size_t minBlockSize = 4096;
+
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t             size;
+        };
+
+        void* AllocateBytes(std::size_t size, std::size_t alignment)
+        {
+            for (; blockIndex_ < blocks_.size(); ++blockIndex_, blockOffset_ = 0)
+            {
+                /* Allocate from current block if the aligned range fits into it */
+                auto& block = blocks_[blockIndex_];
+                auto offset = (blockOffset_ + alignment - 1) / alignment * alignment;
+                if (offset + size <= block.size)
+                {
+                    blockOffset_ = offset + size;
+                    return (block.data.get() + offset);
+                }
+            }
+
+            /* Append new block that is at least twice as large as the previous one */
+            AppendBlock(std::max(size + alignment, blocks_.empty() ? minBlockSize : blocks_.back().size * 2));
+            blockIndex_ = blocks_.size() - 1;
+            blockOffset_ = 0;
+
+            return AllocateBytes(size, alignment);
+        }
+
+        void AppendBlock(std::size_t size)
+        {
+            blocks_.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+        }
+
+    private:
+
+        std::vector<Block>  blocks_;
+        std::size_t         blockIndex_     = 0;
+        std::size_t         blockOffset_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -27,6 +27,8 @@ long Shader::GetStageFlags() const
         case ShaderType::Geometry:          return StageFlags::GeometryStage;
         case ShaderType::Fragment:          return StageFlags::FragmentStage;
         case ShaderType::Compute:           return StageFlags::ComputeStage;
+        case ShaderType::Amplification:     return StageFlags::AmplificationStage;
+        case ShaderType::Mesh:              return StageFlags::MeshStage;
     }
     return 0;
 }
@@ -28,6 +28,8 @@ bool ShaderProgram::ValidateShaderComposition(Shader* const * shaders, std::size
         BitGeom = (1 << static_cast<int>( ShaderType::Geometry       )),
         BitFrag = (1 << static_cast<int>( ShaderType::Fragment       )),
         BitComp = (1 << static_cast<int>( ShaderType::Compute        )),
+        BitAmpl = (1 << static_cast<int>( ShaderType::Amplification  )),
+        BitMesh = (1 << static_cast<int>( ShaderType::Mesh           )),
     };
 
     /* Determine which shader types are attached */
@@ -59,6 +61,10 @@ bool ShaderProgram::ValidateShaderComposition(Shader* const * shaders, std::size
         case (BitVert | BitTesc | BitTese |           BitFrag):
         case (BitVert | BitTesc | BitTese | BitGeom | BitFrag):
         case (BitComp):
+        case (          BitMesh          ):
+        case (          BitMesh | BitFrag):
+        case (BitAmpl | BitMesh          ):
+        case (BitAmpl | BitMesh | BitFrag):
             return true;
     }
 
@@ -0,0 +1,69 @@
+/*
+ * ShaderSpecialization.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ShaderSpecialization.h"
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+std::string GetSpecializationConstantLiteral(const ShaderSpecializationConstant& constant)
+{
+    switch (constant.type)
+    {
+        case DataType::Int32:
+        {
+            return std::to_string(static_cast<std::int32_t>(constant.value));
+        }
+
+        case DataType::UInt32:
+        {
+            return std::to_string(constant.value) + "u";
+        }
+
+        case DataType::Float32:
+        {
+            float value = 0.0f;
+            std::memcpy(&value, &(constant.value), sizeof(value));
+
+            if (!std::isfinite(value))
+                throw std::invalid_argument("cannot define shader specialization constant with non-finite floating-point value");
+
+            /* Print all significant digits, so the value survives the round trip through the shader compiler */
+            std::ostringstream s;
+            s.imbue(std::locale::classic());
+            s << std::setprecision(std::numeric_limits<float>::max_digits10) << value;
+
+            /* Append fractional part to integral values, so they are parsed as floating-point literals */
+            auto literal = s.str();
+            if (literal.find_first_of(".e") == std::string::npos)
+                literal += ".0";
+
+            return literal;
+        }
+
+        default:
+        {
+            throw std::invalid_argument("shader specialization constant must be of type Int32, UInt32, or Float32");
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
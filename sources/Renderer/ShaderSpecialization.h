@@ -0,0 +1,34 @@
+/*
+ * ShaderSpecialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SHADER_SPECIALIZATION_H
+#define LLGL_SHADER_SPECIALIZATION_H
+
+
+#include <LLGL/ShaderFlags.h>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+Returns the value of the specified specialization constant as literal for a macro definition in GLSL or HLSL source code (e.g. "-4", "4u", or "0.5").
+Throws std::invalid_argument if the data type is not supported or the floating-point value is not finite.
+*/
+std::string GetSpecializationConstantLiteral(const ShaderSpecializationConstant& constant);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * StatisticsCounter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_STATISTICS_COUNTER_H
+#define LLGL_STATISTICS_COUNTER_H
+
+
+#include <LLGL/RenderingStatistics.h>
+#include <atomic>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_ENABLE_STATISTICS
+
+#define LLGL_STATISTICS_ADD(COUNTER, VALUE) \
+    statistics_.COUNTER.fetch_add(static_cast<std::uint64_t>(VALUE), std::memory_order_relaxed)
+
+#else
+
+#define LLGL_STATISTICS_ADD(COUNTER, VALUE)
+
+#endif
+
+#define LLGL_STATISTICS_INC(COUNTER) \
+    LLGL_STATISTICS_ADD(COUNTER, 1)
+
+/*
+Atomic counters of the rendering statistics, which are shared between a render system and all of its command buffers.
+The counters are only modified by the LLGL_STATISTICS_* macros (with relaxed memory order), which expand to nothing
+unless LLGL is compiled with the "LLGL_ENABLE_STATISTICS" flag, so the statistics have no cost in regular builds.
+The macros require the statistics counter (or a reference to it) named 'statistics_' in the current scope.
+*/
+class StatisticsCounter
+{
+
+    public:
+
+        StatisticsCounter() = default;
+
+        StatisticsCounter(const StatisticsCounter&) = delete;
+        StatisticsCounter& operator = (const StatisticsCounter&) = delete;
+
+        // Returns the current values of all counters and resets them to zero if 'reset' is true.
+        RenderingStatistics Query(bool reset)
+        {
+            RenderingStatistics statistics;
+            {
+                statistics.drawCalls        = Load(drawCalls, reset);
+                statistics.dispatchCalls    = Load(dispatchCalls, reset);
+                statistics.resourceBindings = Load(resourceBindings, reset);
+                statistics.pipelineBindings = Load(pipelineBindings, reset);
+                statistics.renderPasses     = Load(renderPasses, reset);
+                statistics.bytesUploaded    = Load(bytesUploaded, reset);
+            }
+            return statistics;
+        }
+
+    public:
+
+        std::atomic<std::uint64_t> drawCalls        { 0 };
+        std::atomic<std::uint64_t> dispatchCalls    { 0 };
+        std::atomic<std::uint64_t> resourceBindings { 0 };
+        std::atomic<std::uint64_t> pipelineBindings { 0 };
+        std::atomic<std::uint64_t> renderPasses     { 0 };
+        std::atomic<std::uint64_t> bytesUploaded    { 0 };
+
+    private:
+
+        static std::uint64_t Load(std::atomic<std::uint64_t>& counter, bool reset)
+        {
+            return (reset ? counter.exchange(0, std::memory_order_relaxed) : counter.load(std::memory_order_relaxed));
+        }
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
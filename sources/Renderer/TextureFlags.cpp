@@ -46,6 +46,19 @@ std::uint32_t TextureBufferSize(const Format format, std::uint32_t numTexels)
     return ((FormatBitSize(format) * numTexels) / 8);
 }
 
+LLGL_EXPORT std::uint32_t TextureBufferSize(const Format format, const Extent3D& extent)
+{
+    if (IsCompressedFormat(format))
+    {
+        /* Determine number of blocks that are required to cover each slice of the region */
+        const auto blockExtent  = FormatBlockExtent(format);
+        const auto numBlocksX   = (extent.width  + blockExtent.width  - 1) / blockExtent.width;
+        const auto numBlocksY   = (extent.height + blockExtent.height - 1) / blockExtent.height;
+        return (numBlocksX * numBlocksY * extent.depth * FormatBlockSize(format));
+    }
+    return TextureBufferSize(format, extent.width * extent.height * extent.depth);
+}
+
 LLGL_EXPORT std::uint32_t TextureSize(const TextureDescriptor& textureDesc)
 {
     const auto& extent = textureDesc.extent;
@@ -0,0 +1,108 @@
+/*
+ * TextureReadbackPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TextureReadbackPool.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Gathers the rows of all slices into a tightly packed destination buffer.
+static void GatherTextureRows(
+    char*           dst,
+    const char*     src,
+    std::size_t     rowSize,
+    std::uint32_t   numRows,
+    std::uint32_t   numSlices,
+    std::uint32_t   srcRowPitch,
+    std::uint64_t   srcSlicePitch)
+{
+    for (std::uint32_t slice = 0; slice < numSlices; ++slice)
+    {
+        auto srcSlice = src + static_cast<std::size_t>(srcSlicePitch * slice);
+        for (std::uint32_t row = 0; row < numRows; ++row)
+        {
+            ::memcpy(dst, srcSlice + static_cast<std::size_t>(srcRowPitch) * row, rowSize);
+            dst += rowSize;
+        }
+    }
+}
+
+LLGL_EXPORT void CopyTextureReadbackData(
+    const DstImageDescriptor&   imageDesc,
+    const Format                format,
+    const Extent3D&             extent,
+    const void*                 srcData,
+    std::uint32_t               srcRowPitch,
+    std::uint64_t               srcSlicePitch,
+    std::size_t                 threadCount)
+{
+    ImageFormat srcFormat;
+    DataType    srcDataType;
+    if (!FindSuitableImageFormat(format, srcFormat, srcDataType))
+        throw std::invalid_argument("cannot read texture with unsupported format for texture readback");
+
+    /* Validate output image size */
+    const auto numTexels    = extent.width * extent.height * extent.depth;
+    const auto rowSize      = static_cast<std::size_t>(extent.width) * (FormatBitSize(format) / 8);
+    const auto srcImageSize = rowSize * extent.height * extent.depth;
+    const auto dstImageSize = static_cast<std::size_t>(ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels));
+
+    if (imageDesc.data == nullptr || imageDesc.dataSize < dstImageSize)
+        throw std::invalid_argument("output image data buffer too small for texture readback");
+
+    const bool isTightlyPacked = (srcRowPitch == rowSize && srcSlicePitch == rowSize * extent.height);
+
+    if (srcFormat == imageDesc.format && srcDataType == imageDesc.dataType)
+    {
+        /* Copy mapped data directly into the output buffer */
+        GatherTextureRows(
+            reinterpret_cast<char*>(imageDesc.data),
+            reinterpret_cast<const char*>(srcData),
+            rowSize,
+            extent.height,
+            extent.depth,
+            srcRowPitch,
+            srcSlicePitch
+        );
+    }
+    else
+    {
+        /* Gather rows into a temporary buffer if the mapped data has any padding */
+        ByteBuffer tempData;
+        if (!isTightlyPacked)
+        {
+            tempData = GenerateEmptyByteBuffer(srcImageSize, false);
+            GatherTextureRows(
+                tempData.get(),
+                reinterpret_cast<const char*>(srcData),
+                rowSize,
+                extent.height,
+                extent.depth,
+                srcRowPitch,
+                srcSlicePitch
+            );
+            srcData = tempData.get();
+        }
+
+        /* Convert tightly packed data into the requested format */
+        ConvertImageBuffer(
+            SrcImageDescriptor { srcFormat, srcDataType, srcData, srcImageSize },
+            DstImageDescriptor { imageDesc.format, imageDesc.dataType, imageDesc.data, dstImageSize },
+            threadCount
+        );
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,137 @@
+/*
+ * TextureReadbackPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_READBACK_POOL_H
+#define LLGL_TEXTURE_READBACK_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Fence.h>
+#include <LLGL/Format.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Types.h>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Helper class to manage the staging resources of asynchronous texture and buffer readbacks (see RenderSystem::ReadTextureAsync and RenderSystem::ReadBufferAsync).
+Each readback is identified by its index within the pool. When its result has been retrieved, the readback keeps its staging resource,
+so it can be reused by a subsequent readback of equal or smaller size without allocating any GPU memory.
+The template parameter 'T' denotes the backend specific staging resource.
+*/
+template <typename T>
+class TextureReadbackPool
+{
+
+    public:
+
+        struct Readback
+        {
+            T               staging;
+            std::uint64_t   capacity    = 0;        // Size (in bytes) of the staging resource, or 0 if it has not been created yet
+            Fence*          fence       = nullptr;
+            Format          format      = Format::Undefined;
+            Extent3D        extent;
+            std::uint32_t   rowPitch    = 0;        // Distance (in bytes) between two rows within the staging resource
+            std::uint64_t   slicePitch  = 0;        // Distance (in bytes) between two slices (or array layers) within the staging resource
+            std::uint64_t   dataSize    = 0;        // Size (in bytes) of the readback data (only used for buffer readbacks)
+            bool            pending     = false;
+        };
+
+        // Allocates a readback for the specified staging size, and prefers the smallest free staging resource that is large enough.
+        // If the returned readback has a capacity less than 'size', its staging resource must be (re-)created by the caller.
+        std::uint32_t Alloc(std::uint64_t size)
+        {
+            auto numReadbacks = static_cast<std::uint32_t>(readbacks_.size());
+            auto index = numReadbacks;
+
+            for (std::uint32_t i = 0; i < numReadbacks; ++i)
+            {
+                const auto& rb = readbacks_[i];
+                if (!rb.pending)
+                {
+                    if (index == numReadbacks)
+                        index = i;
+                    else if (rb.capacity >= size && (readbacks_[index].capacity < size || rb.capacity < readbacks_[index].capacity))
+                        index = i;
+                }
+            }
+
+            if (index == numReadbacks)
+                readbacks_.resize(numReadbacks + 1);
+
+            readbacks_[index].pending = true;
+
+            return index;
+        }
+
+        // Returns the pending readback with the specified identifier.
+        Readback& Get(std::uint32_t readback)
+        {
+            if (readback >= readbacks_.size() || !readbacks_[readback].pending)
+                throw std::invalid_argument("invalid readback identifier: " + std::to_string(readback));
+            return readbacks_[readback];
+        }
+
+        // Returns the specified readback to the pool and keeps its staging resource for later use.
+        void Free(std::uint32_t readback)
+        {
+            auto& rb = Get(readback);
+            rb.pending  = false;
+            rb.fence    = nullptr;
+        }
+
+        // Releases all staging resources with the specified function.
+        template <typename TReleaseFunc>
+        void Clear(TReleaseFunc releaseFunc)
+        {
+            for (auto& rb : readbacks_)
+            {
+                if (rb.capacity > 0)
+                    releaseFunc(rb.staging);
+            }
+            readbacks_.clear();
+        }
+
+    private:
+
+        std::vector<Readback> readbacks_;
+
+};
+
+
+/*
+Copies the texel data of a texture readback from mapped staging memory into the output image (tightly packed).
+The data is converted if the image format or data type of 'imageDesc' differ from the texture format.
+Throws std::invalid_argument if the output image buffer is too small.
+*/
+LLGL_EXPORT void CopyTextureReadbackData(
+    const DstImageDescriptor&   imageDesc,
+    const Format                format,
+    const Extent3D&             extent,
+    const void*                 srcData,
+    std::uint32_t               srcRowPitch,
+    std::uint64_t               srcSlicePitch,
+    std::size_t                 threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
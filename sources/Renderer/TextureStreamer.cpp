@@ -0,0 +1,296 @@
+/*
+ * TextureStreamer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureStreamer.h>
+#include <LLGL/RenderSystem.h>
+#include "MipChain.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Returns the size (in bytes) of the image data of the specified MIP-map level.
+static std::uint64_t GetMipLevelSize(const std::vector<TextureSubresourceImage>& images)
+{
+    std::uint64_t size = 0;
+    for (const auto& image : images)
+        size += image.image.dataSize;
+    return size;
+}
+
+// Returns the texture region that covers all array layers of the specified MIP-map level.
+static TextureRegion GetMipLevelRegion(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    TextureRegion region;
+    {
+        region.mipLevel = mipLevel;
+        region.extent   = GetMipExtent(textureDesc, mipLevel);
+    }
+    return region;
+}
+
+
+/* ----- Common ----- */
+
+TextureStreamer::TextureStreamer(RenderSystem& renderSystem, std::uint64_t uploadBudget) :
+    renderSystem_ { renderSystem },
+    uploadBudget_ { uploadBudget }
+{
+    const auto& features = renderSystem.GetRenderingCaps().features;
+    if (!features.hasTextureMinLOD)
+        throw std::runtime_error("texture streaming requires texture min-LOD clamping");
+    sparseSupported_ = features.hasSparseTextures;
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    for (auto& it : textures_)
+        renderSystem_.Release(*it.first);
+}
+
+Texture* TextureStreamer::CreateTexture(
+    const TextureDescriptor&        textureDesc,
+    std::uint32_t                   numImages,
+    const TextureSubresourceImage*  images,
+    std::uint32_t                   numResidentMipLevels)
+{
+    if (IsMultiSampleTexture(textureDesc.type))
+        throw std::invalid_argument("cannot stream multi-sampled texture");
+
+    /* Sort images by their MIP-map levels */
+    StreamingTexture entry;
+    {
+        entry.desc              = textureDesc;
+        entry.desc.mipLevels    = NumMipLevels(textureDesc);
+        entry.sparse            = ((textureDesc.flags & TextureFlags::Sparse) != 0 && sparseSupported_);
+
+        if (!entry.sparse)
+            entry.desc.flags &= ~TextureFlags::Sparse;
+
+        entry.mipImages.resize(entry.desc.mipLevels);
+
+        for (std::uint32_t i = 0; i < numImages; ++i)
+        {
+            if (images[i].mipLevel < entry.desc.mipLevels)
+                entry.mipImages[images[i].mipLevel].push_back(images[i]);
+        }
+    }
+
+    const auto lastMipLevel = entry.desc.mipLevels - 1;
+    if (entry.mipImages[lastMipLevel].empty())
+        throw std::invalid_argument("cannot stream texture without image data for its smallest MIP-map level");
+
+    /* Create texture without default initialization, since only the resident MIP-map levels are written */
+    const auto prevConfig = renderSystem_.GetConfiguration();
+    {
+        auto config = prevConfig;
+        config.imageInitialization.enabled = false;
+        renderSystem_.SetConfiguration(config);
+    }
+
+    Texture* texture = nullptr;
+    try
+    {
+        texture = renderSystem_.CreateTexture(entry.desc, nullptr);
+    }
+    catch (...)
+    {
+        renderSystem_.SetConfiguration(prevConfig);
+        throw;
+    }
+    renderSystem_.SetConfiguration(prevConfig);
+
+    /* Upload the lowest MIP-map levels, beginning with the smallest one, and clamp the sampling to them */
+    try
+    {
+        entry.residentMipLevel = lastMipLevel;
+        residentSize_ += UploadMipLevel(*texture, entry, lastMipLevel);
+
+        for (std::uint32_t i = 1; i < numResidentMipLevels && entry.residentMipLevel > 0; ++i)
+        {
+            const auto mipLevel = entry.residentMipLevel - 1;
+            if (entry.mipImages[mipLevel].empty())
+                break;
+            residentSize_ += UploadMipLevel(*texture, entry, mipLevel);
+            entry.residentMipLevel = mipLevel;
+        }
+
+        renderSystem_.SetTextureMinLOD(*texture, static_cast<float>(entry.residentMipLevel));
+    }
+    catch (...)
+    {
+        renderSystem_.Release(*texture);
+        throw;
+    }
+
+    textures_[texture] = std::move(entry);
+
+    return texture;
+}
+
+void TextureStreamer::Release(Texture& texture)
+{
+    auto it = textures_.find(&texture);
+    if (it == textures_.end())
+        throw std::invalid_argument("cannot release texture that was not created by this texture streamer");
+
+    /* Subtract all resident MIP-map levels from the resident size */
+    const auto& entry = it->second;
+    for (auto mipLevel = entry.residentMipLevel; mipLevel < entry.desc.mipLevels; ++mipLevel)
+        residentSize_ -= GetMipLevelSize(entry.mipImages[mipLevel]);
+
+    renderSystem_.Release(texture);
+    textures_.erase(it);
+}
+
+void TextureStreamer::RequestMipLevel(Texture& texture, std::uint32_t mipLevel, float priority)
+{
+    auto& entry = GetStreamingTexture(texture);
+    entry.requestedMipLevel = std::min(mipLevel, entry.desc.mipLevels - 1);
+    entry.priority          = priority;
+}
+
+std::uint32_t TextureStreamer::Update()
+{
+    using Candidate = std::pair<Texture*, StreamingTexture*>;
+
+    std::vector<Candidate> candidates;
+
+    for (auto& it : textures_)
+    {
+        auto& entry = it.second;
+
+        /* Evict MIP-map levels of sparse textures that are no longer demanded */
+        if (entry.sparse && entry.requestedMipLevel > entry.residentMipLevel)
+            EvictMipLevels(*it.first, entry);
+
+        if (entry.requestedMipLevel < entry.residentMipLevel)
+            candidates.push_back({ it.first, &entry });
+    }
+
+    /* Stream textures with higher priority first, and textures that are further away from their demand first among equal priorities */
+    std::stable_sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const Candidate& lhs, const Candidate& rhs)
+        {
+            if (lhs.second->priority != rhs.second->priority)
+                return (lhs.second->priority > rhs.second->priority);
+            return (lhs.second->residentMipLevel > rhs.second->residentMipLevel);
+        }
+    );
+
+    /* Upload one MIP-map level per texture and pass, until the budget is exhausted or all demands are satisfied */
+    std::uint32_t   numUploads  = 0;
+    std::uint64_t   uploadSize  = 0;
+    bool            progress    = true;
+
+    while (progress)
+    {
+        progress = false;
+
+        for (const auto& candidate : candidates)
+        {
+            auto& texture   = *candidate.first;
+            auto& entry     = *candidate.second;
+
+            if (entry.requestedMipLevel >= entry.residentMipLevel)
+                continue;
+
+            const auto mipLevel = entry.residentMipLevel - 1;
+            if (entry.mipImages[mipLevel].empty())
+                continue;
+
+            if (numUploads > 0 && uploadSize + GetMipLevelSize(entry.mipImages[mipLevel]) > uploadBudget_)
+                return numUploads;
+
+            /* Upload MIP-map level and extend the sampling to it */
+            const auto size = UploadMipLevel(texture, entry, mipLevel);
+            renderSystem_.SetTextureMinLOD(texture, static_cast<float>(mipLevel));
+
+            entry.residentMipLevel = mipLevel;
+            residentSize_ += size;
+            uploadSize += size;
+            ++numUploads;
+            progress = true;
+        }
+    }
+
+    return numUploads;
+}
+
+std::uint32_t TextureStreamer::GetResidentMipLevel(const Texture& texture) const
+{
+    return GetStreamingTexture(texture).residentMipLevel;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+TextureStreamer::StreamingTexture& TextureStreamer::GetStreamingTexture(const Texture& texture)
+{
+    auto it = textures_.find(const_cast<Texture*>(&texture));
+    if (it == textures_.end())
+        throw std::invalid_argument("texture was not created by this texture streamer");
+    return it->second;
+}
+
+const TextureStreamer::StreamingTexture& TextureStreamer::GetStreamingTexture(const Texture& texture) const
+{
+    auto it = textures_.find(const_cast<Texture*>(&texture));
+    if (it == textures_.end())
+        throw std::invalid_argument("texture was not created by this texture streamer");
+    return it->second;
+}
+
+std::uint64_t TextureStreamer::UploadMipLevel(Texture& texture, StreamingTexture& entry, std::uint32_t mipLevel)
+{
+    /* Commit memory of the entire MIP-map level before it is written */
+    if (entry.sparse)
+        renderSystem_.CommitTextureTiles(texture, GetMipLevelRegion(entry.desc, mipLevel), true);
+
+    /* Write all images of the MIP-map level (e.g. one per array layer) with a single upload */
+    const auto& images = entry.mipImages[mipLevel];
+
+    std::vector<SubTextureImage> regions;
+    regions.reserve(images.size());
+
+    for (const auto& image : images)
+        regions.push_back({ GetSubTextureForImage(entry.desc, image), image.image });
+
+    renderSystem_.WriteTextureRegions(texture, static_cast<std::uint32_t>(regions.size()), regions.data());
+
+    return GetMipLevelSize(images);
+}
+
+void TextureStreamer::EvictMipLevels(Texture& texture, StreamingTexture& entry)
+{
+    /* Clamp the sampling before the memory is decommitted */
+    const auto evictedMipLevel = entry.residentMipLevel;
+    entry.residentMipLevel = entry.requestedMipLevel;
+    renderSystem_.SetTextureMinLOD(texture, static_cast<float>(entry.residentMipLevel));
+
+    for (auto mipLevel = evictedMipLevel; mipLevel < entry.residentMipLevel; ++mipLevel)
+    {
+        renderSystem_.CommitTextureTiles(texture, GetMipLevelRegion(entry.desc, mipLevel), false);
+        residentSize_ -= GetMipLevelSize(entry.mipImages[mipLevel]);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,229 @@
+/*
+ * TimerScopeRecorder.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TimerScopeRecorder.h"
+
+
+namespace LLGL
+{
+
+
+const std::uint32_t TimerScopeRecorder::maxNumFrames;
+const std::uint32_t TimerScopeRecorder::maxNumScopesPerFrame;
+const std::uint32_t TimerScopeRecorder::maxNumTimestampsPerFrame;
+const std::uint32_t TimerScopeRecorder::maxNumTimestamps;
+const std::uint32_t TimerScopeRecorder::maxNumSegmentsPerFrame;
+const std::uint32_t TimerScopeRecorder::maxNumSegments;
+
+bool TimerScopeRecorder::BeginScope(const char* name, std::uint32_t& timestampIndex)
+{
+    auto& frame = frames_[currentFrame_];
+
+    /* Ignore scope if the timestamps of this frame are exhausted */
+    if (numIgnoredScopes_ > 0 || frame.scopes.size() >= maxNumScopesPerFrame)
+    {
+        ++numIgnoredScopes_;
+        return false;
+    }
+
+    /* Append new scope as child of the innermost open scope */
+    const auto scopeIndex = static_cast<std::uint32_t>(frame.scopes.size());
+
+    Scope scope;
+    {
+        scope.name      = (name != nullptr ? name : "");
+        scope.parent    = (scopeStack_.empty() ? Constants::invalidTimerScope : scopeStack_.back());
+        scope.depth     = static_cast<std::uint32_t>(scopeStack_.size());
+        scope.ended     = false;
+    }
+    frame.scopes.push_back(std::move(scope));
+    scopeStack_.push_back(scopeIndex);
+
+    timestampIndex = GetFirstTimestamp(currentFrame_) + scopeIndex * 2;
+
+    return true;
+}
+
+bool TimerScopeRecorder::EndScope(std::uint32_t& timestampIndex)
+{
+    /* Ignored scopes are always the innermost ones */
+    if (numIgnoredScopes_ > 0)
+    {
+        --numIgnoredScopes_;
+        return false;
+    }
+
+    if (scopeStack_.empty())
+        return false;
+
+    const auto scopeIndex = scopeStack_.back();
+    scopeStack_.pop_back();
+
+    frames_[currentFrame_].scopes[scopeIndex].ended = true;
+
+    timestampIndex = GetFirstTimestamp(currentFrame_) + scopeIndex * 2 + 1;
+
+    return true;
+}
+
+bool TimerScopeRecorder::BeginSegment(std::uint32_t& queryIndex)
+{
+    if (scopeStack_.empty())
+        return false;
+
+    auto& frame = frames_[currentFrame_];
+
+    /* Without a segment, the statistics of the open scopes would be incomplete */
+    if (frame.segments.size() >= maxNumSegmentsPerFrame)
+    {
+        frame.segmentsExhausted = true;
+        return false;
+    }
+
+    queryIndex = GetFirstSegment(currentFrame_) + static_cast<std::uint32_t>(frame.segments.size());
+    frame.segments.push_back(scopeStack_.back());
+    segmentActive_ = true;
+
+    return true;
+}
+
+bool TimerScopeRecorder::EndSegment(std::uint32_t& queryIndex)
+{
+    if (!segmentActive_)
+        return false;
+
+    queryIndex = GetFirstSegment(currentFrame_) + static_cast<std::uint32_t>(frames_[currentFrame_].segments.size()) - 1;
+    segmentActive_ = false;
+
+    return true;
+}
+
+bool TimerScopeRecorder::CloseFrame()
+{
+    /* Scopes that are still open remain without result */
+    scopeStack_.clear();
+    numIgnoredScopes_ = 0;
+    segmentActive_ = false;
+
+    auto& frame = frames_[currentFrame_];
+    frame.index = frameCounter_++;
+
+    if (frame.scopes.empty())
+        return false;
+
+    /* Move on to the next frame of the ring, and discard the oldest pending frame if it occupies that frame */
+    ++numPendingFrames_;
+    currentFrame_ = (currentFrame_ + 1) % maxNumFrames;
+
+    if (numPendingFrames_ == maxNumFrames)
+        DiscardPendingFrame();
+
+    frames_[currentFrame_].scopes.clear();
+    frames_[currentFrame_].segments.clear();
+    frames_[currentFrame_].segmentsExhausted = false;
+
+    return true;
+}
+
+static const std::size_t g_numStatisticsMembers = sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t);
+
+// Adds the specified pipeline statistics to the destination; members that are not supported by any of them remain invalid.
+static void AccumulateStatistics(QueryPipelineStatistics& dst, const QueryPipelineStatistics& src)
+{
+    auto dstMembers = reinterpret_cast<std::uint64_t*>(&dst);
+    auto srcMembers = reinterpret_cast<const std::uint64_t*>(&src);
+
+    for (std::size_t i = 0; i < g_numStatisticsMembers; ++i)
+    {
+        if (srcMembers[i] == Constants::invalidQueryResult)
+            dstMembers[i] = Constants::invalidQueryResult;
+        else if (dstMembers[i] != Constants::invalidQueryResult)
+            dstMembers[i] += srcMembers[i];
+    }
+}
+
+static void ResetStatistics(QueryPipelineStatistics& stats)
+{
+    auto members = reinterpret_cast<std::uint64_t*>(&stats);
+    for (std::size_t i = 0; i < g_numStatisticsMembers; ++i)
+        members[i] = 0;
+}
+
+void TimerScopeRecorder::ResolvePendingFrame(
+    const std::uint64_t*            timestamps,
+    double                          nanosecondsPerTick,
+    TimerScopeFrame&                frame,
+    const QueryPipelineStatistics*  segmentStatistics)
+{
+    const auto& src = frames_[pendingFrame_];
+    const auto numScopes = src.scopes.size();
+
+    frame.index = src.index;
+    frame.scopes.resize(numScopes);
+
+    for (std::size_t i = 0; i < numScopes; ++i)
+    {
+        const auto& srcScope = src.scopes[i];
+        auto& dstScope = frame.scopes[i];
+
+        dstScope.name   = srcScope.name;
+        dstScope.parent = srcScope.parent;
+        dstScope.depth  = srcScope.depth;
+
+        /* Convert timestamp difference from ticks to nanoseconds */
+        const auto begin    = timestamps[i*2];
+        const auto end      = timestamps[i*2 + 1];
+
+        if (srcScope.ended && end > begin)
+            dstScope.elapsedTime = static_cast<std::uint64_t>(static_cast<double>(end - begin) * nanosecondsPerTick + 0.5);
+        else
+            dstScope.elapsedTime = 0;
+
+        dstScope.beginTimestamp = begin;
+
+        dstScope.hasStatistics = false;
+    }
+
+    if (segmentStatistics != nullptr && !src.segmentsExhausted)
+    {
+        /* Accumulate the statistics of each segment into its innermost scope and all of its parents */
+        for (auto& dstScope : frame.scopes)
+        {
+            dstScope.hasStatistics = true;
+            ResetStatistics(dstScope.statistics);
+        }
+
+        for (std::size_t i = 0, n = src.segments.size(); i < n; ++i)
+        {
+            for (auto scope = src.segments[i]; scope != Constants::invalidTimerScope; scope = src.scopes[scope].parent)
+                AccumulateStatistics(frame.scopes[scope].statistics, segmentStatistics[i]);
+        }
+    }
+
+    DiscardPendingFrame();
+}
+
+void TimerScopeRecorder::DiscardPendingFrame()
+{
+    if (numPendingFrames_ > 0)
+    {
+        pendingFrame_ = (pendingFrame_ + 1) % maxNumFrames;
+        --numPendingFrames_;
+    }
+}
+
+std::uint32_t TimerScopeRecorder::GetNumTimestamps(std::uint32_t frame) const
+{
+    return static_cast<std::uint32_t>(frames_[frame].scopes.size() * 2);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,166 @@
+/*
+ * TimerScopeRecorder.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TIMER_SCOPE_RECORDER_H
+#define LLGL_TIMER_SCOPE_RECORDER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/QueryFlags.h>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Helper class to record the hierarchy of GPU timer scopes for a ring of frames.
+The backends write the actual timestamps into their native query pools, which are partitioned into one range of timestamps per frame:
+scope 'i' of frame 'f' uses the timestamps '(f * maxNumTimestampsPerFrame + i*2)' for its begin and '+1' for its end.
+Pipeline statistics queries cannot be nested, so they are recorded in consecutive segments instead (see CommandBufferFlags::TimerScopeStatistics):
+the backends end the active segment and begin a new one whenever a scope begins or ends, and each segment is accumulated into all scopes that are open during that segment.
+Segment 's' of frame 'f' uses the statistics query '(f * maxNumSegmentsPerFrame + s)'.
+*/
+class LLGL_EXPORT TimerScopeRecorder
+{
+
+    public:
+
+        // Number of frames in the ring. Pending frames are discarded, when their range of timestamps is needed for a new frame.
+        static const std::uint32_t maxNumFrames             = 4;
+
+        // Maximum number of timer scopes per frame.
+        static const std::uint32_t maxNumScopesPerFrame     = 256;
+
+        static const std::uint32_t maxNumTimestampsPerFrame = maxNumScopesPerFrame * 2;
+        static const std::uint32_t maxNumTimestamps         = maxNumFrames * maxNumTimestampsPerFrame;
+
+        // Maximum number of pipeline statistics segments per frame. Scopes of frames with more segments have no statistics.
+        static const std::uint32_t maxNumSegmentsPerFrame   = 128;
+
+        static const std::uint32_t maxNumSegments           = maxNumFrames * maxNumSegmentsPerFrame;
+
+        // Begins a new scope in the current frame and returns the index of its begin timestamp. Returns false if the frame is full.
+        bool BeginScope(const char* name, std::uint32_t& timestampIndex);
+
+        // Ends the innermost scope and returns the index of its end timestamp. Returns false if the scope has not been recorded.
+        bool EndScope(std::uint32_t& timestampIndex);
+
+        // Begins a new pipeline statistics segment for the open scopes and returns the index of its query. Returns false if no scope is open or the frame is full.
+        bool BeginSegment(std::uint32_t& queryIndex);
+
+        // Ends the active pipeline statistics segment and returns the index of its query. Returns false if no segment is active.
+        bool EndSegment(std::uint32_t& queryIndex);
+
+        // Closes the current frame and returns true if it has any scopes, in which case it becomes the newest pending frame.
+        // All open scopes and the active segment must be ended before (see HasOpenScopes), otherwise they remain without result.
+        bool CloseFrame();
+
+        // Converts the timestamps and the optional pipeline statistics of each segment of the oldest pending frame into the output frame,
+        // and removes it from the pending frames.
+        void ResolvePendingFrame(
+            const std::uint64_t*            timestamps,
+            double                          nanosecondsPerTick,
+            TimerScopeFrame&                frame,
+            const QueryPipelineStatistics*  segmentStatistics = nullptr
+        );
+
+        // Removes the oldest pending frame without resolving it, e.g. when its timestamps are invalid.
+        void DiscardPendingFrame();
+
+        // Returns the number of timestamps that are used by the specified frame.
+        std::uint32_t GetNumTimestamps(std::uint32_t frame) const;
+
+        // Returns the index of the first timestamp of the specified frame.
+        inline std::uint32_t GetFirstTimestamp(std::uint32_t frame) const
+        {
+            return (frame * maxNumTimestampsPerFrame);
+        }
+
+        // Returns the number of pipeline statistics segments that are used by the specified frame.
+        inline std::uint32_t GetNumSegments(std::uint32_t frame) const
+        {
+            return static_cast<std::uint32_t>(frames_[frame].segments.size());
+        }
+
+        // Returns the index of the first pipeline statistics query of the specified frame.
+        inline std::uint32_t GetFirstSegment(std::uint32_t frame) const
+        {
+            return (frame * maxNumSegmentsPerFrame);
+        }
+
+        // Returns the ring index of the current frame.
+        inline std::uint32_t GetCurrentFrame() const
+        {
+            return currentFrame_;
+        }
+
+        // Returns the ring index of the oldest pending frame. Only valid if HasPendingFrame returns true.
+        inline std::uint32_t GetPendingFrame() const
+        {
+            return pendingFrame_;
+        }
+
+        // Returns true if there is any closed frame whose results have not been resolved.
+        inline bool HasPendingFrame() const
+        {
+            return (numPendingFrames_ > 0);
+        }
+
+        // Returns true if the current frame has any scopes that have not been ended yet.
+        inline bool HasOpenScopes() const
+        {
+            return (!scopeStack_.empty() || numIgnoredScopes_ > 0);
+        }
+
+        // Returns true if the current frame has no scopes.
+        inline bool IsCurrentFrameEmpty() const
+        {
+            return frames_[currentFrame_].scopes.empty();
+        }
+
+    private:
+
+        struct Scope
+        {
+            std::string     name;
+            std::uint32_t   parent;
+            std::uint32_t   depth;
+            bool            ended;
+        };
+
+        struct Frame
+        {
+            std::uint64_t               index               = 0;
+            std::vector<Scope>          scopes;
+            std::vector<std::uint32_t>  segments;                   // Innermost open scope of each pipeline statistics segment
+            bool                        segmentsExhausted   = false;
+        };
+
+        Frame                       frames_[maxNumFrames];
+        std::uint32_t               currentFrame_       = 0;
+        std::uint32_t               pendingFrame_       = 0;
+        std::uint32_t               numPendingFrames_   = 0;
+        std::uint64_t               frameCounter_       = 0;
+
+        std::vector<std::uint32_t>  scopeStack_;                // Indices of the open scopes of the current frame
+        std::uint32_t               numIgnoredScopes_   = 0;    // Number of open scopes that did not fit into the current frame
+        bool                        segmentActive_      = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,177 @@
+/*
+ * TransientRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TRANSIENT_RING_H
+#define LLGL_TRANSIENT_RING_H
+
+
+#include <deque>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Default size (in bytes) of the transient ring buffer of each command buffer (see CommandBuffer::AllocateTransient).
+static const std::uint64_t g_transientRingSize = 4ull * 1024ull * 1024ull;
+
+/*
+Offset allocator for a ring buffer of transient data, which does not own any memory itself.
+All allocations since the last call to 'Close' form the open segment, which is closed with a tag once its commands have been submitted,
+e.g. the fence value of the submission. Closed segments are released in the same order, so a renderer only has to wait for the tag of the oldest segment
+when the ring is full. Each backend maps the offsets into its own persistently mapped buffer.
+*/
+template <typename TTag>
+class TransientRing
+{
+
+    public:
+
+        // Releases all segments and resizes the ring to the specified size (in bytes).
+        void Reset(std::uint64_t size)
+        {
+            segments_.clear();
+            size_       = size;
+            head_       = 0;
+            used_       = 0;
+            openBytes_  = 0;
+        }
+
+        // Allocates a range of 'size' bytes at an offset that is a multiple of 'alignment'. Returns false if the ring has not enough free space left.
+        bool Allocate(std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset)
+        {
+            if (size == 0 || size > size_)
+                return false;
+
+            /* Start at the beginning again when the ring is empty */
+            if (used_ == 0)
+                head_ = 0;
+
+            const auto tail     = (head_ + size_ - used_) % size_;
+            const auto aligned  = (head_ + alignment - 1) / alignment * alignment;
+
+            std::uint64_t consumed = 0;
+
+            if (used_ < size_ && head_ >= tail)
+            {
+                /* Free space is [head, size) and [0, tail); wrap around if the range does not fit into the end of the ring */
+                if (aligned + size <= size_)
+                {
+                    offset      = aligned;
+                    consumed    = aligned + size - head_;
+                }
+                else if (size <= tail)
+                {
+                    offset      = 0;
+                    consumed    = size_ - head_ + size;
+                }
+                else
+                    return false;
+            }
+            else if (used_ < size_ && aligned + size <= tail)
+            {
+                /* Free space is [head, tail) */
+                offset      = aligned;
+                consumed    = aligned + size - head_;
+            }
+            else
+                return false;
+
+            head_       = (offset + size) % size_;
+            used_       += consumed;
+            openBytes_  += consumed;
+
+            return true;
+        }
+
+        /*
+        Allocates a range like 'Allocate', but releases the oldest closed segments while the ring is full.
+        'waitFunc' is called with the tag of each such segment before it is released and must block until the GPU is done with it.
+        Returns false if the allocations of the open segment alone exceed the ring.
+        */
+        template <typename TWaitFunc>
+        bool AllocateOrWait(std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset, const TWaitFunc& waitFunc)
+        {
+            while (!Allocate(size, alignment, offset))
+            {
+                if (segments_.empty())
+                    return false;
+                waitFunc(segments_.front().tag);
+                ReleaseOldest();
+            }
+            return true;
+        }
+
+        // Closes the open segment with the specified tag. This has no effect if nothing has been allocated since the last call.
+        void Close(const TTag& tag)
+        {
+            if (openBytes_ > 0)
+            {
+                segments_.push_back({ tag, openBytes_ });
+                openBytes_ = 0;
+            }
+        }
+
+        // Releases the memory of the oldest closed segment.
+        void ReleaseOldest()
+        {
+            used_ -= segments_.front().bytes;
+            segments_.pop_front();
+        }
+
+        // Returns the tag of the oldest closed segment. The ring must have at least one closed segment.
+        inline const TTag& GetOldestTag() const
+        {
+            return segments_.front().tag;
+        }
+
+        // Returns true if the ring has any closed segment that has not been released yet.
+        inline bool HasClosedSegments() const
+        {
+            return !segments_.empty();
+        }
+
+        // Returns true if anything has been allocated since the last call to 'Close'.
+        inline bool HasOpenSegment() const
+        {
+            return (openBytes_ > 0);
+        }
+
+        // Returns the size (in bytes) of the ring, or zero if it has not been initialized yet.
+        inline std::uint64_t GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        struct Segment
+        {
+            TTag            tag;
+            std::uint64_t   bytes;  // Number of bytes this segment occupies in the ring, including the padding of its allocations
+        };
+
+    private:
+
+        std::deque<Segment> segments_;
+        std::uint64_t       size_       = 0;
+        std::uint64_t       head_       = 0;
+        std::uint64_t       used_       = 0;    // Number of bytes between the tail and the head of the ring
+        std::uint64_t       openBytes_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
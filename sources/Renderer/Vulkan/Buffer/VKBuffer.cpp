@@ -39,7 +39,7 @@ VKBufferWithRequirements& VKBufferWithRequirements::operator = (VKBufferWithRequ
 void VKBufferWithRequirements::Create(const VKPtr<VkDevice>& device, const VkBufferCreateInfo& createInfo)
 {
     /* Create buffer object */
-    auto result = vkCreateBuffer(device, &createInfo, nullptr, buffer.ReleaseAndGetAddressOf());
+    auto result = vkCreateBuffer(device, &createInfo, VKGetAllocationCallbacks(), buffer.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan buffer");
 
     /* Query memory requirements */
@@ -58,6 +58,7 @@ void VKBufferWithRequirements::Release()
 
 VKBuffer::VKBuffer(const BufferType type, const VKPtr<VkDevice>& device, const VkBufferCreateInfo& createInfo) :
     Buffer            { type            },
+    device_           { device          },
     bufferObj_        { device          },
     bufferObjStaging_ { device          },
     size_             { createInfo.size }
@@ -65,12 +66,26 @@ VKBuffer::VKBuffer(const BufferType type, const VKPtr<VkDevice>& device, const V
     bufferObj_.Create(device, createInfo);
 }
 
-void VKBuffer::BindToMemory(VkDevice device, VKDeviceMemoryRegion* memoryRegion)
+void VKBuffer::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    VKSetObjectName(device_, VK_OBJECT_TYPE_BUFFER, reinterpret_cast<std::uint64_t>(GetVkBuffer()), name);
+    #endif
+}
+
+void VKBuffer::SetCounterOffset(VkDeviceSize offset)
+{
+    hasCounter_     = true;
+    counterOffset_  = offset;
+}
+
+void VKBuffer::BindToMemory(VkDevice device, VKDeviceMemoryRegion* memoryRegion, bool hostVisible)
 {
     if (memoryRegion)
     {
         memoryRegion_ = memoryRegion;
         memoryRegion_->BindBuffer(device, GetVkBuffer());
+        hostVisible_ = hostVisible;
     }
 }
 
@@ -80,22 +95,24 @@ void VKBuffer::TakeStagingBuffer(VKBufferWithRequirements&& buffer, VKDeviceMemo
     memoryRegionStaging_ = memoryRegionStaging;
 }
 
-void* VKBuffer::Map(VkDevice device, const CPUAccess access)
+void* VKBuffer::Map(VkDevice device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize size)
 {
-    if (memoryRegionStaging_)
+    auto memoryRegion = (hostVisible_ ? memoryRegion_ : memoryRegionStaging_);
+    if (memoryRegion)
     {
-        mappingCPUAccess_ = access;
-        return memoryRegionStaging_->GetParentChunk()->Map(
-            device, memoryRegionStaging_->GetOffset(), memoryRegionStaging_->GetSize()
-        );
+        mappingCPUAccess_   = access;
+        mappedOffset_       = offset;
+        mappedSize_         = size;
+        return memoryRegion->GetParentChunk()->Map(device, memoryRegion->GetOffset() + offset, size);
     }
     return nullptr;
 }
 
 void VKBuffer::Unmap(VkDevice device)
 {
-    if (memoryRegionStaging_)
-        memoryRegionStaging_->GetParentChunk()->Unmap(device);
+    auto memoryRegion = (hostVisible_ ? memoryRegion_ : memoryRegionStaging_);
+    if (memoryRegion)
+        memoryRegion->GetParentChunk()->Unmap(device);
 }
 
 void VKBuffer::UpdateStagingBuffer(VkDevice device, const void* data, VkDeviceSize dataSize, VkDeviceSize offset)
@@ -41,15 +41,21 @@ class VKBuffer : public Buffer
 
         VKBuffer(const BufferType type, const VKPtr<VkDevice>& device, const VkBufferCreateInfo& createInfo);
 
-        void BindToMemory(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
+        void SetName(const char* name) override;
+
+        void BindToMemory(VkDevice device, VKDeviceMemoryRegion* memoryRegion, bool hostVisible = false);
         void TakeStagingBuffer(VKBufferWithRequirements&& buffer, VKDeviceMemoryRegion* memoryRegionStaging);
 
-        void* Map(VkDevice device, const CPUAccess access);
+        // Maps the specified range of the staging buffer, or of the hardware buffer if it is host visible.
+        void* Map(VkDevice device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
         // Updates the staging buffer (if it was created).
         void UpdateStagingBuffer(VkDevice device, const void* data, VkDeviceSize dataSize, VkDeviceSize offset = 0);
 
+        // Stores the offset of the hidden counter of an append or consume storage buffer, which is stored behind the elements.
+        void SetCounterOffset(VkDeviceSize offset);
+
         // Returns the hardware buffer object.
         inline VkBuffer GetVkBuffer() const
         {
@@ -80,6 +86,36 @@ class VKBuffer : public Buffer
             return mappingCPUAccess_;
         }
 
+        // Returns the offset of the range previously set when "Map" was called.
+        inline VkDeviceSize GetMappedOffset() const
+        {
+            return mappedOffset_;
+        }
+
+        // Returns the size of the range previously set when "Map" was called.
+        inline VkDeviceSize GetMappedSize() const
+        {
+            return mappedSize_;
+        }
+
+        // Returns true if the hardware buffer is allocated in host visible device memory, i.e. it is mapped without staging buffer.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
+        // Returns true if this buffer has a hidden counter (append or consume storage buffer).
+        inline bool HasCounter() const
+        {
+            return hasCounter_;
+        }
+
+        // Returns the offset (in bytes) of the hidden 32-bit counter.
+        inline VkDeviceSize GetCounterOffset() const
+        {
+            return counterOffset_;
+        }
+
         // Returns the region of the hardware device memory.
         inline VKDeviceMemoryRegion* GetMemoryRegion() const
         {
@@ -94,6 +130,8 @@ class VKBuffer : public Buffer
 
     private:
 
+        VkDevice                    device_                 = VK_NULL_HANDLE;
+
         VKBufferWithRequirements    bufferObj_;
         VKDeviceMemoryRegion*       memoryRegion_           = nullptr;
 
@@ -101,7 +139,14 @@ class VKBuffer : public Buffer
         VKDeviceMemoryRegion*       memoryRegionStaging_    = nullptr;
 
         VkDeviceSize                size_                   = 0;
+        bool                        hostVisible_            = false;
+
         CPUAccess                   mappingCPUAccess_       = CPUAccess::ReadOnly;
+        VkDeviceSize                mappedOffset_           = 0;
+        VkDeviceSize                mappedSize_             = 0;
+
+        bool                        hasCounter_             = false;
+        VkDeviceSize                counterOffset_          = 0;
 
 };
 
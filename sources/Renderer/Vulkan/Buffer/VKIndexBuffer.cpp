@@ -13,20 +13,9 @@ namespace LLGL
 {
 
 
-static VkIndexType MapIndexType(const DataType dataType)
-{
-    switch (dataType)
-    {
-        case DataType::UInt16:  return VK_INDEX_TYPE_UINT16;
-        case DataType::UInt32:  return VK_INDEX_TYPE_UINT32;
-        default:                break;
-    }
-    VKTypes::MapFailed("DataType", "VkIndexType");
-}
-
 VKIndexBuffer::VKIndexBuffer(const VKPtr<VkDevice>& device, const VkBufferCreateInfo& createInfo, const IndexFormat& indexFormat) :
     VKBuffer   { BufferType::Index, device, createInfo   },
-    indexType_ { MapIndexType(indexFormat.GetDataType()) }
+    indexType_ { VKTypes::Map(indexFormat.GetDataType()) }
 {
 }
 
@@ -34,6 +34,22 @@ bool LoadVKProc(VkInstance instance, T& procAddr, const char* procName)
     return true;
 }
 
+template <typename T>
+bool LoadVKDeviceProc(VkDevice device, T& procAddr, const char* procName)
+{
+    /* Load Vulkan device procedure address */
+    procAddr = reinterpret_cast<T>(vkGetDeviceProcAddr(device, procName));
+
+    /* Check for errors */
+    if (!procAddr)
+    {
+        Log::StdErr() << "failed to load Vulkan procedure: " << procName << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 /* --- Hardware buffer extensions --- */
 
 #define LOAD_VKPROC(NAME)                   \
@@ -50,8 +66,155 @@ static bool Load_VK_KHR_win32_surface(VkInstance instance)
 
 #endif // /LLGL_OS_WIN32
 
+/* --- Optional instance extensions --- */
+
+#ifdef VK_KHR_get_physical_device_properties2
+
+static bool Load_VK_KHR_get_physical_device_properties2(VkInstance instance)
+{
+    LOAD_VKPROC( vkGetPhysicalDeviceProperties2KHR       );
+    LOAD_VKPROC( vkGetPhysicalDeviceMemoryProperties2KHR );
+    return true;
+}
+
+#endif // /VK_KHR_get_physical_device_properties2
+
+#ifdef VK_EXT_debug_utils
+
+static bool Load_VK_EXT_debug_utils(VkInstance instance)
+{
+    LOAD_VKPROC( vkCmdBeginDebugUtilsLabelEXT  );
+    LOAD_VKPROC( vkCmdEndDebugUtilsLabelEXT    );
+    LOAD_VKPROC( vkCmdInsertDebugUtilsLabelEXT );
+    LOAD_VKPROC( vkSetDebugUtilsObjectNameEXT  );
+    return true;
+}
+
+#endif // /VK_EXT_debug_utils
+
 #undef LOAD_VKPROC
 
+/* --- Optional device extensions --- */
+
+#define LOAD_VKDEVICEPROC(NAME)                     \
+    if (!LoadVKDeviceProc(device, NAME, #NAME))     \
+        return false
+
+#ifdef VK_KHR_descriptor_update_template
+
+static bool Load_VK_KHR_descriptor_update_template(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCreateDescriptorUpdateTemplateKHR  );
+    LOAD_VKDEVICEPROC( vkDestroyDescriptorUpdateTemplateKHR );
+    LOAD_VKDEVICEPROC( vkUpdateDescriptorSetWithTemplateKHR );
+    return true;
+}
+
+#endif // /VK_KHR_descriptor_update_template
+
+#ifdef VK_KHR_timeline_semaphore
+
+static bool Load_VK_KHR_timeline_semaphore(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkGetSemaphoreCounterValueKHR );
+    LOAD_VKDEVICEPROC( vkWaitSemaphoresKHR           );
+    return true;
+}
+
+#endif // /VK_KHR_timeline_semaphore
+
+#ifdef VK_KHR_fragment_shading_rate
+
+static bool Load_VK_KHR_fragment_shading_rate(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCmdSetFragmentShadingRateKHR );
+    return true;
+}
+
+#endif // /VK_KHR_fragment_shading_rate
+
+#ifdef VK_KHR_draw_indirect_count
+
+static bool Load_VK_KHR_draw_indirect_count(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCmdDrawIndirectCountKHR        );
+    LOAD_VKDEVICEPROC( vkCmdDrawIndexedIndirectCountKHR );
+    return true;
+}
+
+#endif // /VK_KHR_draw_indirect_count
+
+#ifdef VK_EXT_conditional_rendering
+
+static bool Load_VK_EXT_conditional_rendering(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCmdBeginConditionalRenderingEXT );
+    LOAD_VKDEVICEPROC( vkCmdEndConditionalRenderingEXT   );
+    return true;
+}
+
+#endif // /VK_EXT_conditional_rendering
+
+#ifdef VK_EXT_mesh_shader
+
+static bool Load_VK_EXT_mesh_shader(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCmdDrawMeshTasksEXT         );
+    LOAD_VKDEVICEPROC( vkCmdDrawMeshTasksIndirectEXT );
+    return true;
+}
+
+#endif // /VK_EXT_mesh_shader
+
+#ifdef VK_KHR_buffer_device_address
+
+static bool Load_VK_KHR_buffer_device_address(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkGetBufferDeviceAddressKHR );
+    return true;
+}
+
+#endif // /VK_KHR_buffer_device_address
+
+#ifdef VK_KHR_acceleration_structure
+
+static bool Load_VK_KHR_acceleration_structure(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkCreateAccelerationStructureKHR              );
+    LOAD_VKDEVICEPROC( vkDestroyAccelerationStructureKHR             );
+    LOAD_VKDEVICEPROC( vkGetAccelerationStructureBuildSizesKHR       );
+    LOAD_VKDEVICEPROC( vkGetAccelerationStructureDeviceAddressKHR    );
+    LOAD_VKDEVICEPROC( vkCmdBuildAccelerationStructuresKHR           );
+    LOAD_VKDEVICEPROC( vkCmdCopyAccelerationStructureKHR             );
+    LOAD_VKDEVICEPROC( vkCmdWriteAccelerationStructuresPropertiesKHR );
+    return true;
+}
+
+#endif // /VK_KHR_acceleration_structure
+
+#ifdef VK_GOOGLE_display_timing
+
+static bool Load_VK_GOOGLE_display_timing(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkGetRefreshCycleDurationGOOGLE   );
+    LOAD_VKDEVICEPROC( vkGetPastPresentationTimingGOOGLE );
+    return true;
+}
+
+#endif // /VK_GOOGLE_display_timing
+
+#ifdef VK_EXT_calibrated_timestamps
+
+static bool Load_VK_EXT_calibrated_timestamps(VkDevice device)
+{
+    LOAD_VKDEVICEPROC( vkGetCalibratedTimestampsEXT );
+    return true;
+}
+
+#endif // /VK_EXT_calibrated_timestamps
+
+#undef LOAD_VKDEVICEPROC
+
 
 /* --- Common extension loading functions --- */
 
@@ -92,6 +255,92 @@ bool AreExtensionsLoaded()
     return g_extAlreadyLoaded;
 }
 
+bool LoadInstanceExtension(VkInstance instance, const std::string& extensionName)
+{
+    #ifdef VK_KHR_get_physical_device_properties2
+    if (extensionName == VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)
+        return Load_VK_KHR_get_physical_device_properties2(instance);
+    #endif
+    #ifdef VK_EXT_debug_utils
+    if (extensionName == VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+        return Load_VK_EXT_debug_utils(instance);
+    #endif
+    return false;
+}
+
+bool LoadDeviceExtension(VkDevice device, const std::string& extensionName)
+{
+    #ifdef VK_KHR_descriptor_update_template
+    if (extensionName == VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)
+        return Load_VK_KHR_descriptor_update_template(device);
+    #endif
+    #ifdef VK_KHR_timeline_semaphore
+    if (extensionName == VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)
+        return Load_VK_KHR_timeline_semaphore(device);
+    #endif
+    #ifdef VK_KHR_fragment_shading_rate
+    if (extensionName == VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+        return Load_VK_KHR_fragment_shading_rate(device);
+    #endif
+    #ifdef VK_KHR_draw_indirect_count
+    if (extensionName == VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)
+        return Load_VK_KHR_draw_indirect_count(device);
+    #endif
+    #ifdef VK_EXT_conditional_rendering
+    if (extensionName == VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME)
+        return Load_VK_EXT_conditional_rendering(device);
+    #endif
+    #ifdef VK_EXT_mesh_shader
+    if (extensionName == VK_EXT_MESH_SHADER_EXTENSION_NAME)
+        return Load_VK_EXT_mesh_shader(device);
+    #endif
+    #ifdef VK_KHR_buffer_device_address
+    if (extensionName == VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME)
+        return Load_VK_KHR_buffer_device_address(device);
+    #endif
+    #ifdef VK_KHR_acceleration_structure
+    if (extensionName == VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)
+        return Load_VK_KHR_acceleration_structure(device);
+    #endif
+    #if defined VK_KHR_ray_query && defined VK_KHR_acceleration_structure && defined VK_KHR_buffer_device_address
+    if (extensionName == VK_KHR_RAY_QUERY_EXTENSION_NAME)
+    {
+        /* Ray queries have no procedures, but they are only usable with acceleration structures and buffer device addresses */
+        return (vkCmdBuildAccelerationStructuresKHR != nullptr && vkGetBufferDeviceAddressKHR != nullptr);
+    }
+    #endif
+    #ifdef VK_GOOGLE_display_timing
+    if (extensionName == VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME)
+        return Load_VK_GOOGLE_display_timing(device);
+    #endif
+    #ifdef VK_EXT_calibrated_timestamps
+    if (extensionName == VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+        return Load_VK_EXT_calibrated_timestamps(device);
+    #endif
+    #ifdef VK_EXT_conservative_rasterization
+    if (extensionName == VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME)
+    {
+        /* Conservative rasterization has no procedures, it only extends the rasterization state of graphics pipelines */
+        return true;
+    }
+    #endif
+    #ifdef VK_KHR_multiview
+    if (extensionName == VK_KHR_MULTIVIEW_EXTENSION_NAME)
+    {
+        /* Multiview has no procedures, but its limits are queried with an instance extension */
+        return true;
+    }
+    #endif
+    #if defined VK_EXT_memory_budget && defined VK_KHR_get_physical_device_properties2
+    if (extensionName == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)
+    {
+        /* Memory budget has no procedures, but is queried with an instance extension */
+        return (vkGetPhysicalDeviceMemoryProperties2KHR != nullptr);
+    }
+    #endif
+    return false;
+}
+
 
 } // /namespace LLGL
 
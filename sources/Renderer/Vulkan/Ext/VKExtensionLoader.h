@@ -10,6 +10,7 @@
 
 
 #include "../Vulkan.h"
+#include <string>
 
 
 namespace LLGL
@@ -30,6 +31,18 @@ void LoadAllExtensions(VkInstance instance);
 //! Returns true if all available extensions have been loaded.
 bool AreExtensionsLoaded();
 
+/**
+Loads the procedures of the specified optional instance extension, which must have been enabled for the specified instance.
+\return True if all procedures of the extension have been loaded, or false if the extension is unknown or its procedures could not be loaded.
+*/
+bool LoadInstanceExtension(VkInstance instance, const std::string& extensionName);
+
+/**
+Loads the procedures of the specified optional device extension, which must have been enabled for the specified device.
+\return True if all procedures of the extension have been loaded, or false if the extension is unknown or its procedures could not be loaded.
+*/
+bool LoadDeviceExtension(VkDevice device, const std::string& extensionName);
+
 
 } // /namespace LLGL
 
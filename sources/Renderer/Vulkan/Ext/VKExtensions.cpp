@@ -25,6 +25,101 @@ PFN_vkCreateWin32SurfaceKHR vkCreateWin32SurfaceKHR = nullptr;
 #endif
 
 
+/* Optional instance extensions */
+
+#ifdef VK_KHR_get_physical_device_properties2
+
+PFN_vkGetPhysicalDeviceProperties2KHR        vkGetPhysicalDeviceProperties2KHR        = nullptr;
+PFN_vkGetPhysicalDeviceMemoryProperties2KHR  vkGetPhysicalDeviceMemoryProperties2KHR  = nullptr;
+
+#endif
+
+#ifdef VK_EXT_debug_utils
+
+PFN_vkCmdBeginDebugUtilsLabelEXT    vkCmdBeginDebugUtilsLabelEXT    = nullptr;
+PFN_vkCmdEndDebugUtilsLabelEXT      vkCmdEndDebugUtilsLabelEXT      = nullptr;
+PFN_vkCmdInsertDebugUtilsLabelEXT   vkCmdInsertDebugUtilsLabelEXT   = nullptr;
+PFN_vkSetDebugUtilsObjectNameEXT    vkSetDebugUtilsObjectNameEXT    = nullptr;
+
+#endif
+
+
+/* Optional device extensions */
+
+#ifdef VK_KHR_descriptor_update_template
+
+PFN_vkCreateDescriptorUpdateTemplateKHR  vkCreateDescriptorUpdateTemplateKHR  = nullptr;
+PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplateKHR = nullptr;
+PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplateKHR = nullptr;
+
+#endif
+
+#ifdef VK_KHR_timeline_semaphore
+
+PFN_vkGetSemaphoreCounterValueKHR        vkGetSemaphoreCounterValueKHR        = nullptr;
+PFN_vkWaitSemaphoresKHR                  vkWaitSemaphoresKHR                  = nullptr;
+
+#endif
+
+#ifdef VK_KHR_fragment_shading_rate
+
+PFN_vkCmdSetFragmentShadingRateKHR       vkCmdSetFragmentShadingRateKHR       = nullptr;
+
+#endif
+
+#ifdef VK_KHR_draw_indirect_count
+
+PFN_vkCmdDrawIndirectCountKHR            vkCmdDrawIndirectCountKHR            = nullptr;
+PFN_vkCmdDrawIndexedIndirectCountKHR     vkCmdDrawIndexedIndirectCountKHR     = nullptr;
+
+#endif
+
+#ifdef VK_EXT_conditional_rendering
+
+PFN_vkCmdBeginConditionalRenderingEXT    vkCmdBeginConditionalRenderingEXT    = nullptr;
+PFN_vkCmdEndConditionalRenderingEXT      vkCmdEndConditionalRenderingEXT      = nullptr;
+
+#endif
+
+#ifdef VK_EXT_mesh_shader
+
+PFN_vkCmdDrawMeshTasksEXT                vkCmdDrawMeshTasksEXT                = nullptr;
+PFN_vkCmdDrawMeshTasksIndirectEXT        vkCmdDrawMeshTasksIndirectEXT        = nullptr;
+
+#endif
+
+#ifdef VK_KHR_buffer_device_address
+
+PFN_vkGetBufferDeviceAddressKHR                  vkGetBufferDeviceAddressKHR                  = nullptr;
+
+#endif
+
+#ifdef VK_KHR_acceleration_structure
+
+PFN_vkCreateAccelerationStructureKHR             vkCreateAccelerationStructureKHR             = nullptr;
+PFN_vkDestroyAccelerationStructureKHR            vkDestroyAccelerationStructureKHR            = nullptr;
+PFN_vkGetAccelerationStructureBuildSizesKHR      vkGetAccelerationStructureBuildSizesKHR      = nullptr;
+PFN_vkGetAccelerationStructureDeviceAddressKHR   vkGetAccelerationStructureDeviceAddressKHR   = nullptr;
+PFN_vkCmdBuildAccelerationStructuresKHR          vkCmdBuildAccelerationStructuresKHR          = nullptr;
+PFN_vkCmdCopyAccelerationStructureKHR            vkCmdCopyAccelerationStructureKHR            = nullptr;
+PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
+
+#endif
+
+#ifdef VK_GOOGLE_display_timing
+
+PFN_vkGetRefreshCycleDurationGOOGLE      vkGetRefreshCycleDurationGOOGLE      = nullptr;
+PFN_vkGetPastPresentationTimingGOOGLE    vkGetPastPresentationTimingGOOGLE    = nullptr;
+
+#endif
+
+#ifdef VK_EXT_calibrated_timestamps
+
+PFN_vkGetCalibratedTimestampsEXT         vkGetCalibratedTimestampsEXT         = nullptr;
+
+#endif
+
+
 } // /namespace LLGL
 
 
@@ -29,6 +29,101 @@ extern PFN_vkCreateWin32SurfaceKHR vkCreateWin32SurfaceKHR;
 #endif
 
 
+/* Optional instance extensions */
+
+#ifdef VK_KHR_get_physical_device_properties2
+
+extern PFN_vkGetPhysicalDeviceProperties2KHR        vkGetPhysicalDeviceProperties2KHR;
+extern PFN_vkGetPhysicalDeviceMemoryProperties2KHR  vkGetPhysicalDeviceMemoryProperties2KHR;
+
+#endif
+
+#ifdef VK_EXT_debug_utils
+
+extern PFN_vkCmdBeginDebugUtilsLabelEXT     vkCmdBeginDebugUtilsLabelEXT;
+extern PFN_vkCmdEndDebugUtilsLabelEXT       vkCmdEndDebugUtilsLabelEXT;
+extern PFN_vkCmdInsertDebugUtilsLabelEXT    vkCmdInsertDebugUtilsLabelEXT;
+extern PFN_vkSetDebugUtilsObjectNameEXT     vkSetDebugUtilsObjectNameEXT;
+
+#endif
+
+
+/* Optional device extensions */
+
+#ifdef VK_KHR_descriptor_update_template
+
+extern PFN_vkCreateDescriptorUpdateTemplateKHR  vkCreateDescriptorUpdateTemplateKHR;
+extern PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplateKHR;
+extern PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplateKHR;
+
+#endif
+
+#ifdef VK_KHR_timeline_semaphore
+
+extern PFN_vkGetSemaphoreCounterValueKHR        vkGetSemaphoreCounterValueKHR;
+extern PFN_vkWaitSemaphoresKHR                  vkWaitSemaphoresKHR;
+
+#endif
+
+#ifdef VK_KHR_fragment_shading_rate
+
+extern PFN_vkCmdSetFragmentShadingRateKHR       vkCmdSetFragmentShadingRateKHR;
+
+#endif
+
+#ifdef VK_KHR_draw_indirect_count
+
+extern PFN_vkCmdDrawIndirectCountKHR            vkCmdDrawIndirectCountKHR;
+extern PFN_vkCmdDrawIndexedIndirectCountKHR     vkCmdDrawIndexedIndirectCountKHR;
+
+#endif
+
+#ifdef VK_EXT_conditional_rendering
+
+extern PFN_vkCmdBeginConditionalRenderingEXT    vkCmdBeginConditionalRenderingEXT;
+extern PFN_vkCmdEndConditionalRenderingEXT      vkCmdEndConditionalRenderingEXT;
+
+#endif
+
+#ifdef VK_EXT_mesh_shader
+
+extern PFN_vkCmdDrawMeshTasksEXT                vkCmdDrawMeshTasksEXT;
+extern PFN_vkCmdDrawMeshTasksIndirectEXT        vkCmdDrawMeshTasksIndirectEXT;
+
+#endif
+
+#ifdef VK_KHR_buffer_device_address
+
+extern PFN_vkGetBufferDeviceAddressKHR                  vkGetBufferDeviceAddressKHR;
+
+#endif
+
+#ifdef VK_KHR_acceleration_structure
+
+extern PFN_vkCreateAccelerationStructureKHR             vkCreateAccelerationStructureKHR;
+extern PFN_vkDestroyAccelerationStructureKHR            vkDestroyAccelerationStructureKHR;
+extern PFN_vkGetAccelerationStructureBuildSizesKHR      vkGetAccelerationStructureBuildSizesKHR;
+extern PFN_vkGetAccelerationStructureDeviceAddressKHR   vkGetAccelerationStructureDeviceAddressKHR;
+extern PFN_vkCmdBuildAccelerationStructuresKHR          vkCmdBuildAccelerationStructuresKHR;
+extern PFN_vkCmdCopyAccelerationStructureKHR            vkCmdCopyAccelerationStructureKHR;
+extern PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR;
+
+#endif
+
+#ifdef VK_GOOGLE_display_timing
+
+extern PFN_vkGetRefreshCycleDurationGOOGLE      vkGetRefreshCycleDurationGOOGLE;
+extern PFN_vkGetPastPresentationTimingGOOGLE    vkGetPastPresentationTimingGOOGLE;
+
+#endif
+
+#ifdef VK_EXT_calibrated_timestamps
+
+extern PFN_vkGetCalibratedTimestampsEXT         vkGetCalibratedTimestampsEXT;
+
+#endif
+
+
 } // /namespace LLGL
 
 
@@ -14,12 +14,17 @@ namespace LLGL
 {
 
 
-VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
-    deviceMemory_    { device, vkFreeMemory },
-    size_            { size                 },
-    memoryTypeIndex_ { memoryTypeIndex      },
-    maxNewBlockSize_ { size                 }
+VKDeviceMemory::VKDeviceMemory(
+    const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex, VulkanDeviceMemoryAllocator allocator, bool deviceAddress) :
+        deviceMemory_    { device, vkFreeMemory },
+        size_            { size                 },
+        memoryTypeIndex_ { memoryTypeIndex      },
+        maxNewBlockSize_ { size                 }
 {
+    /* Create TLSF allocator if this strategy is selected */
+    if (allocator == VulkanDeviceMemoryAllocator::TLSF)
+        tlsf_ = MakeUnique<VKDeviceMemoryTLSF>(size);
+
     /* Allocate device memory */
     VkMemoryAllocateInfo allocInfo;
     {
@@ -28,7 +33,21 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
         allocInfo.allocationSize    = size;
         allocInfo.memoryTypeIndex   = memoryTypeIndex;
     }
-    auto result = vkAllocateMemory(device, &allocInfo, nullptr, deviceMemory_.ReleaseAndGetAddressOf());
+
+    /* Buffers with a device address (e.g. inputs of acceleration structures) must be bound to memory that has been allocated for device addresses */
+    #ifdef VK_KHR_buffer_device_address
+    VkMemoryAllocateFlagsInfoKHR allocFlagsInfo;
+    if (deviceAddress)
+    {
+        allocFlagsInfo.sType        = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+        allocFlagsInfo.pNext        = nullptr;
+        allocFlagsInfo.flags        = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+        allocFlagsInfo.deviceMask   = 0;
+        allocInfo.pNext             = &allocFlagsInfo;
+    }
+    #endif // /VK_KHR_buffer_device_address
+
+    auto result = vkAllocateMemory(device, &allocInfo, VKGetAllocationCallbacks(), deviceMemory_.ReleaseAndGetAddressOf());
 
     if (result != VK_SUCCESS)
     {
@@ -37,23 +56,40 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
     }
 }
 
-void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
+void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize /*size*/)
 {
-    void* data = nullptr;
+    std::lock_guard<std::mutex> guard { mapMutex_ };
 
-    auto result = vkMapMemory(device, deviceMemory_, offset, size, 0, &data);
-    VKThrowIfFailed(result, "failed to map Vulkan buffer into CPU memory space");
+    /* A memory object must not be mapped twice, so map the entire chunk on first use */
+    if (mapCounter_ == 0)
+    {
+        void* data = nullptr;
+        auto result = vkMapMemory(device, deviceMemory_, 0, VK_WHOLE_SIZE, 0, &data);
+        VKThrowIfFailed(result, "failed to map Vulkan buffer into CPU memory space");
+        mappedData_ = reinterpret_cast<char*>(data);
+    }
 
-    return data;
+    ++mapCounter_;
+
+    return (mappedData_ + offset);
 }
 
 void VKDeviceMemory::Unmap(VkDevice device)
 {
-    vkUnmapMemory(device, deviceMemory_);
+    std::lock_guard<std::mutex> guard { mapMutex_ };
+
+    if (mapCounter_ > 0 && --mapCounter_ == 0)
+    {
+        vkUnmapMemory(device, deviceMemory_);
+        mappedData_ = nullptr;
+    }
 }
 
 VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
 {
+    if (tlsf_)
+        return AllocTLSFBlock(size, alignment);
+
     if (size > 0 && alignment > 0)
     {
         /* Adjust size and offset by alignment */
@@ -86,7 +122,9 @@ VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize a
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
+    if (tlsf_)
+        ReleaseTLSFBlock(region);
+    else if (region)
     {
         /* Increase maximal size of fragmented blocks */
         maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
@@ -109,21 +147,51 @@ void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 
 bool VKDeviceMemory::IsEmpty() const
 {
-    return blocks_.empty();
+    if (tlsf_)
+        return (tlsf_->GetNumUsedBlocks() == 0);
+    else
+        return blocks_.empty();
 }
 
 VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
 {
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+    if (tlsf_)
+        return tlsf_->GetMaxAllocationSize();
+    else
+        return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
-    details.numChunks               += 1;
-    details.numBlocks               += blocks_.size();
-    details.numFragments            += fragmentedBlocks_.size();
-    details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
-    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    VkDeviceSize freeSize = 0, maxFreeSize = 0;
+
+    if (tlsf_)
+    {
+        freeSize    = tlsf_->GetFreeSize();
+        maxFreeSize = tlsf_->GetMaxFreeBlockSize();
+
+        details.numBlocks               += tlsf_->GetNumUsedBlocks();
+        details.numFragments            += tlsf_->GetNumFreeBlocks();
+        details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxFreeSize);
+        details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFreeSize);
+    }
+    else
+    {
+        freeSize = GetSize();
+        for (const auto& block : blocks_)
+            freeSize -= block->GetSize();
+        maxFreeSize = GetMaxFreeRegionSize();
+
+        details.numBlocks               += blocks_.size();
+        details.numFragments            += fragmentedBlocks_.size();
+        details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
+        details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    }
+
+    details.numChunks           += 1;
+    details.totalSize           += GetSize();
+    details.freeSize            += freeSize;
+    details.fragmentedFreeSize  += (freeSize - maxFreeSize);
 }
 
 #ifdef LLGL_DEBUG
@@ -178,6 +246,12 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
 
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
+    if (tlsf_)
+    {
+        s << "<TLSF: " << tlsf_->GetNumUsedBlocks() << " blocks>";
+        return;
+    }
+
     VKDeviceMemoryRegion* prevBlock = nullptr;
     for (const auto& block : blocks_)
     {
@@ -188,6 +262,12 @@ void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
+    if (tlsf_)
+    {
+        s << "<TLSF: " << tlsf_->GetNumFreeBlocks() << " free blocks>";
+        return;
+    }
+
     VKDeviceMemoryRegion* prevBlock = nullptr;
     for (const auto& block : fragmentedBlocks_)
     {
@@ -211,6 +291,65 @@ VkDeviceSize VKDeviceMemory::GetNextOffset() const
         return blocks_.back()->GetOffsetWithSize();
 }
 
+VKDeviceMemoryRegion* VKDeviceMemory::AllocTLSFBlock(VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (size > 0 && alignment > 0)
+    {
+        /* Allocate block with aligned size from TLSF allocator */
+        const auto alignedSize = GetAlignedSize(size, alignment);
+
+        VkDeviceSize alignedOffset = 0;
+        const auto block = tlsf_->Allocate(alignedSize, alignment, alignedOffset);
+
+        if (block != VKDeviceMemoryTLSF::invalidBlock)
+        {
+            /* Reuse region object of this block index or make a new one */
+            if (block >= tlsfBlocks_.size())
+                tlsfBlocks_.resize(block + 1);
+
+            auto& region = tlsfBlocks_[block];
+            if (region)
+                region->MoveAt(alignedSize, alignedOffset);
+            else
+                region = MakeUniqueBlock(alignedSize, alignedOffset);
+
+            region->SetAllocatorBlock(block);
+
+            return region.get();
+        }
+    }
+    return nullptr;
+}
+
+void VKDeviceMemory::ReleaseTLSFBlock(VKDeviceMemoryRegion* region)
+{
+    if (region)
+    {
+        const auto block = region->GetAllocatorBlock();
+        if (block < tlsfBlocks_.size() && tlsfBlocks_[block].get() == region)
+        {
+            tlsf_->Release(block);
+            region->SetAllocatorBlock(VKDeviceMemoryTLSF::invalidBlock);
+        }
+    }
+}
+
+VkDeviceSize VKDeviceMemory::GetMaxFreeRegionSize() const
+{
+    /* All memory behind the last block is free, so fragments there are part of this region */
+    const auto nextOffset = GetNextOffset();
+
+    VkDeviceSize maxSize = GetSize() - nextOffset;
+
+    for (const auto& block : fragmentedBlocks_)
+    {
+        if (block->GetOffset() < nextOffset)
+            maxSize = std::max(maxSize, block->GetSize());
+    }
+
+    return maxSize;
+}
+
 std::unique_ptr<VKDeviceMemoryRegion> VKDeviceMemory::MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
 {
     return MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_);
@@ -266,19 +405,17 @@ VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemory
     auto regionRef = region.get();
 
     /* Add block by insertion sort */
-    if (!blocks_.empty())
+    for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
     {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
+        if ((*it)->GetOffset() < region->GetOffset())
         {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
+            blocks_.insert(it.base(), std::move(region));
+            return regionRef;
         }
     }
-    else
-        blocks_.emplace_back(std::move(region));
+
+    /* Insert block at the front if all other blocks have a higher offset (or the list is empty) */
+    blocks_.insert(blocks_.begin(), std::move(region));
 
     return regionRef;
 }
@@ -10,11 +10,14 @@
 
 
 #include "VKDeviceMemoryRegion.h"
+#include "VKDeviceMemoryTLSF.h"
 #include "../VKPtr.h"
+#include <LLGL/RenderSystemFlags.h>
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #ifdef LLGL_DEBUG
 #   include <ostream>
@@ -33,6 +36,10 @@ struct VKDeviceMemoryDetails
     std::size_t     numFragments            = 0;
     VkDeviceSize    maxNewBlockSize         = 0;
     VkDeviceSize    maxFragmentedBlockSize  = 0;
+    VkDeviceSize    totalSize               = 0;    // Accumulated size of all chunks.
+    VkDeviceSize    freeSize                = 0;    // Accumulated size of all free memory.
+    VkDeviceSize    fragmentedFreeSize      = 0;    // Accumulated size of free memory outside of the largest free block of each chunk.
+    double          fragmentation           = 0.0;  // Ratio of fragmented free memory to all free memory in the range [0, 1].
 };
 
 // An instance of this class holds a single VkDeviceMemory allocation chunk.
@@ -41,14 +48,22 @@ class VKDeviceMemory
 
     public:
 
-        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory(
+            const VKPtr<VkDevice>& device,
+            VkDeviceSize size,
+            std::uint32_t memoryTypeIndex,
+            VulkanDeviceMemoryAllocator allocator = VulkanDeviceMemoryAllocator::Linear,
+            bool deviceAddress = false
+        );
 
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
 
-        VKDeviceMemory(VKDeviceMemory&&) = default;
-        VKDeviceMemory& operator = (VKDeviceMemory&&) = default;
-
+        /*
+        Maps the specified range of this device memory chunk into CPU memory space.
+        The entire chunk is mapped once and stays mapped until each call to 'Map' has been matched by a call to 'Unmap',
+        so different regions of the same chunk can be mapped by multiple threads concurrently.
+        */
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
@@ -97,6 +112,15 @@ class VKDeviceMemory
         // Returns the next offset after the last block.
         VkDeviceSize GetNextOffset() const;
 
+        // Allocates a new block with the TLSF allocator.
+        VKDeviceMemoryRegion* AllocTLSFBlock(VkDeviceSize size, VkDeviceSize alignment);
+
+        // Releases the specified block from the TLSF allocator.
+        void ReleaseTLSFBlock(VKDeviceMemoryRegion* region);
+
+        // Returns the size of the largest free region (for the linear allocator).
+        VkDeviceSize GetMaxFreeRegionSize() const;
+
         // Makes a new device memory block.
         std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
 
@@ -137,6 +161,13 @@ class VKDeviceMemory
         VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
         std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
 
+        std::mutex                                          mapMutex_;
+        std::uint32_t                                       mapCounter_             = 0;
+        char*                                               mappedData_             = nullptr;
+
+        std::unique_ptr<VKDeviceMemoryTLSF>                 tlsf_;
+        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  tlsfBlocks_;       // Indexed by TLSF block index
+
 };
 
 
@@ -15,11 +15,18 @@ namespace LLGL
 
 
 VKDeviceMemoryManager::VKDeviceMemoryManager(
-    const VKPtr<VkDevice>& device, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize minAllocationSize, bool reduceFragmentation) :
+    const VKPtr<VkDevice>&                  device,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            minAllocationSize,
+    bool                                    reduceFragmentation,
+    VulkanDeviceMemoryAllocator             allocator,
+    bool                                    deviceAddress) :
         device_              { device              },
         memoryProperties_    { memoryProperties    },
         minAllocationSize_   { minAllocationSize   },
-        reduceFragmentation_ { reduceFragmentation }
+        reduceFragmentation_ { reduceFragmentation },
+        allocator_           { allocator           },
+        deviceAddress_       { deviceAddress       }
 {
 }
 
@@ -29,10 +36,21 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(VkDeviceSize size, VkDevic
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
     const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    auto& pool = pools_[memoryTypeIndex];
+    std::lock_guard<std::mutex> guard { pool.mutex };
+
+    /* Try to allocate region within a suitable chunk */
+    for (const auto& chunk : pool.chunks)
+    {
+        if (chunk->GetMaxAllocationSize() >= alignedSize)
+        {
+            if (auto region = chunk->Allocate(size, alignment, reduceFragmentation_))
+                return region;
+        }
+    }
+
+    /* Allocate region within a new chunk */
+    return AllocChunk(pool, allocationSize, memoryTypeIndex)->Allocate(size, alignment, reduceFragmentation_);
 }
 
 void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
@@ -41,6 +59,9 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
     {
         if (auto chunk = region->GetParentChunk())
         {
+            auto& pool = pools_[chunk->GetMemoryTypeIndex()];
+            std::lock_guard<std::mutex> guard { pool.mutex };
+
             /* Release block in chunk */
             chunk->Release(region);
 
@@ -48,7 +69,7 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
             if (chunk->IsEmpty())
             {
                 RemoveFromListIf(
-                    chunks_,
+                    pool.chunks,
                     [chunk](std::unique_ptr<VKDeviceMemory>& entry)
                     {
                         return (entry.get() == chunk);
@@ -63,35 +84,63 @@ VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 {
     VKDeviceMemoryDetails details;
     {
-        for (const auto& chunk : chunks_)
-            chunk->AccumDetails(details);
+        for (const auto& pool : pools_)
+        {
+            std::lock_guard<std::mutex> guard { pool.mutex };
+            for (const auto& chunk : pool.chunks)
+                chunk->AccumDetails(details);
+        }
+
+        if (details.freeSize > 0)
+            details.fragmentation = static_cast<double>(details.fragmentedFreeSize) / static_cast<double>(details.freeSize);
     }
     return details;
 }
 
+void VKDeviceMemoryManager::AccumHeapStatistics(MemoryHeapStatistics* heaps) const
+{
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount; ++i)
+    {
+        std::lock_guard<std::mutex> guard { pools_[i].mutex };
+        for (const auto& chunk : pools_[i].chunks)
+        {
+            VKDeviceMemoryDetails details;
+            chunk->AccumDetails(details);
+
+            auto& heap = heaps[memoryProperties_.memoryTypes[i].heapIndex];
+            heap.allocatedBytes += details.totalSize;
+            heap.usedBytes      += (details.totalSize - details.freeSize);
+        }
+    }
+}
+
 #ifdef LLGL_DEBUG
 
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
 {
     std::size_t i = 0;
-    for (const auto& chunk : chunks_)
+    for (const auto& pool : pools_)
     {
-        s << "chunk[" << (i++) << "]:";
+        std::lock_guard<std::mutex> guard { pool.mutex };
+        for (const auto& chunk : pool.chunks)
+        {
+            s << "chunk[" << (i++) << "]:";
 
-        if (!title.empty())
-            s << " \"" << title << '\"';
+            if (!title.empty())
+                s << " \"" << title << '\"';
 
-        s << '\n';
-        s << "  size             = " << chunk->GetSize() << '\n';
-        s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
+            s << '\n';
+            s << "  size             = " << chunk->GetSize() << '\n';
+            s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
 
-        s << "  blocks           = ";
-        chunk->PrintBlocks(s);
-        s << '\n';
+            s << "  blocks           = ";
+            chunk->PrintBlocks(s);
+            s << '\n';
 
-        s << "  fragmentedBlocks = ";
-        chunk->PrintFragmentedBlocks(s);
-        s << '\n';
+            s << "  fragmentedBlocks = ";
+            chunk->PrintFragmentedBlocks(s);
+            s << '\n';
+        }
     }
 }
 
@@ -102,27 +151,24 @@ void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& titl
  * ======= Private: =======
  */
 
-std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
+bool VKDeviceMemoryManager::HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
 {
-    return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount; ++i)
+    {
+        if ((memoryTypeBits & (1 << i)) != 0 && (memoryProperties_.memoryTypes[i].propertyFlags & properties) == properties)
+            return true;
+    }
+    return false;
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
+std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
+VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(ChunkPool& pool, VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
-    {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
-    }
-
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+    return TakeOwnership(pool.chunks, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex, allocator_, deviceAddress_));
 }
 
 
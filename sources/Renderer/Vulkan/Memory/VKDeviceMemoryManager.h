@@ -13,8 +13,10 @@
 #include "../VKPtr.h"
 #include "VKDeviceMemory.h"
 #include "VKDeviceMemoryRegion.h"
+#include <LLGL/RenderingStatistics.h>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 
 namespace LLGL
@@ -26,6 +28,8 @@ Vulkan device memory manager. Memory allocations are stored in a small hierarchy
  - Chunk: denotes a single Vulkan memory allocation of type VkDeviceMemory
  - Block: denotes one of multiple regions inside a chunk of type VkBuffer
  - Region: denotes a sub-range inside a block and holds a reference to the VkBuffer and its offset and size (both of type VkDeviceSize).
+Chunks are kept in a separate pool for each memory type, and each pool has its own lock,
+so threads that allocate different kinds of memory (e.g. staging and device-local memory) do not contend with each other.
 */
 class VKDeviceMemoryManager
 {
@@ -36,7 +40,9 @@ class VKDeviceMemoryManager
             const VKPtr<VkDevice>& device,
             const VkPhysicalDeviceMemoryProperties& memoryProperties,
             VkDeviceSize minAllocationSize,
-            bool reduceFragmentation
+            bool reduceFragmentation,
+            VulkanDeviceMemoryAllocator allocator = VulkanDeviceMemoryAllocator::Linear,
+            bool deviceAddress = false
         );
 
         VKDeviceMemoryManager(const VKDeviceMemoryManager&) = delete;
@@ -48,9 +54,15 @@ class VKDeviceMemoryManager
         // Releases the specified device memory block.
         void Release(VKDeviceMemoryRegion* region);
 
-        // Queries the memory details of all chunks.
+        // Returns true if there is a memory type with the specified type bits and properties (e.g. to query support for lazily allocated memory).
+        bool HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
+
+        // Queries the memory details of all chunks, including the fragmentation ratio.
         VKDeviceMemoryDetails QueryDetails() const;
 
+        // Accumulates the allocated and used memory of all chunks into their memory heaps; the output array must have an entry for each memory heap.
+        void AccumHeapStatistics(MemoryHeapStatistics* heaps) const;
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s, const std::string& title = "") const;
@@ -68,19 +80,30 @@ class VKDeviceMemoryManager
         // Finds a memory type index for the specified attributes.
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
-        // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
-        VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
+    private:
+
+        // Chunks of a single memory type.
+        struct ChunkPool
+        {
+            mutable std::mutex                              mutex;
+            std::vector<std::unique_ptr<VKDeviceMemory>>    chunks;
+        };
+
+    private:
+
+        // Allocates a new VkDeviceMemory chunk of the specified size and memory type. The pool must be locked by the caller.
+        VKDeviceMemory* AllocChunk(ChunkPool& pool, VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
 
         const VKPtr<VkDevice>&                          device_;
         VkPhysicalDeviceMemoryProperties                memoryProperties_;
 
         VkDeviceSize                                    minAllocationSize_      = 1024*1024;
         bool                                            reduceFragmentation_    = false;
+        VulkanDeviceMemoryAllocator                     allocator_              = VulkanDeviceMemoryAllocator::Linear;
+        bool                                            deviceAddress_          = false;    // Allocate all chunks with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR.
 
-        std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        ChunkPool                                       pools_[VK_MAX_MEMORY_TYPES];    // Indexed by memory type index
 
 };
 
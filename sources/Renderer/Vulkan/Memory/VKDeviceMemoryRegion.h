@@ -73,12 +73,25 @@ class VKDeviceMemoryRegion
         // Sets the new size and offset.
         void MoveAt(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
 
+        // Sets the index of the block within the TLSF allocator of the parent chunk.
+        inline void SetAllocatorBlock(std::uint32_t block)
+        {
+            allocatorBlock_ = block;
+        }
+
+        // Returns the index of the block within the TLSF allocator of the parent chunk.
+        inline std::uint32_t GetAllocatorBlock() const
+        {
+            return allocatorBlock_;
+        }
+
     private:
 
         VKDeviceMemory* deviceMemory_       = nullptr;
         VkDeviceSize    size_               = 0;
         VkDeviceSize    offset_             = 0;
         std::uint32_t   memoryTypeIndex_    = 0;
+        std::uint32_t   allocatorBlock_     = ~0u;
 
 };
 
@@ -0,0 +1,394 @@
+/*
+ * VKDeviceMemoryTLSF.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDeviceMemoryTLSF.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Returns the index of the most significant bit (value must not be zero).
+static std::uint32_t FindLastSetBit(std::uint64_t value)
+{
+    #if defined _MSC_VER && defined _WIN64
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(value));
+    #else
+    std::uint32_t index = 0;
+    while (value >>= 1)
+        ++index;
+    return index;
+    #endif
+}
+
+// Returns the index of the least significant bit (value must not be zero).
+static std::uint32_t FindFirstSetBit(std::uint64_t value)
+{
+    #if defined _MSC_VER && defined _WIN64
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(__builtin_ctzll(value));
+    #else
+    std::uint32_t index = 0;
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+
+/* ----- VKDeviceMemoryTLSF class ----- */
+
+const std::uint32_t VKDeviceMemoryTLSF::invalidBlock;
+
+VKDeviceMemoryTLSF::VKDeviceMemoryTLSF(VkDeviceSize size)
+{
+    for (auto& lists : freeLists_)
+        std::fill(std::begin(lists), std::end(lists), invalidBlock);
+
+    /* Start with a single free block that spans the entire chunk */
+    if (size > 0)
+        InsertFreeBlock(MakeBlock(0, size));
+}
+
+std::uint32_t VKDeviceMemoryTLSF::Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+{
+    if (size == 0 || alignment == 0)
+        return invalidBlock;
+
+    /* Search for a block that is large enough for the requested size plus the worst case alignment padding */
+    const auto searchSize = size + (alignment - 1);
+    if (searchSize < size)
+        return invalidBlock;
+
+    auto block = FindFreeBlock(size, alignment, searchSize);
+    if (block == invalidBlock)
+        return invalidBlock;
+
+    RemoveFreeBlock(block);
+
+    /* Split off padding at the front of the block to satisfy the alignment */
+    const auto alignedOffset = GetAlignedSize(blocks_[block].offset, alignment);
+    if (alignedOffset > blocks_[block].offset)
+    {
+        auto upper = SplitBlock(block, alignedOffset - blocks_[block].offset);
+        InsertFreeBlock(block);
+        block = upper;
+    }
+
+    /* Split off remaining space at the end of the block */
+    if (blocks_[block].size > size)
+        InsertFreeBlock(SplitBlock(block, size));
+
+    blocks_[block].free = false;
+    ++numUsedBlocks_;
+
+    offset = blocks_[block].offset;
+    return block;
+}
+
+void VKDeviceMemoryTLSF::Release(std::uint32_t block)
+{
+    if (block >= blocks_.size() || blocks_[block].free)
+        return;
+
+    --numUsedBlocks_;
+
+    /* Merge with lower physical neighbor */
+    auto prev = blocks_[block].prevPhys;
+    if (prev != invalidBlock && blocks_[prev].free)
+    {
+        RemoveFreeBlock(prev);
+        MergeBlocks(prev, block);
+        block = prev;
+    }
+
+    /* Merge with upper physical neighbor */
+    auto next = blocks_[block].nextPhys;
+    if (next != invalidBlock && blocks_[next].free)
+    {
+        RemoveFreeBlock(next);
+        MergeBlocks(block, next);
+    }
+
+    InsertFreeBlock(block);
+}
+
+VkDeviceSize VKDeviceMemoryTLSF::GetMaxAllocationSize() const
+{
+    if (flBitmap_ == 0)
+        return 0;
+
+    /* Return upper bound of the highest non-empty free list */
+    const auto fl = FindLastSetBit(flBitmap_);
+    const auto sl = FindLastSetBit(slBitmaps_[fl]);
+
+    if (fl == 0)
+        return sl;
+
+    const auto flShift = fl + slLog2 - 1;
+    const auto base    = (VkDeviceSize(1) << flShift);
+    const auto step    = (VkDeviceSize(1) << (flShift - slLog2));
+
+    return base + step * (sl + 1) - 1;
+}
+
+VkDeviceSize VKDeviceMemoryTLSF::GetMaxFreeBlockSize() const
+{
+    VkDeviceSize maxSize = 0;
+
+    if (flBitmap_ != 0)
+    {
+        /* Only the blocks in the highest non-empty free list can be the largest ones */
+        const auto fl = FindLastSetBit(flBitmap_);
+        const auto sl = FindLastSetBit(slBitmaps_[fl]);
+
+        for (auto block = freeLists_[fl][sl]; block != invalidBlock; block = blocks_[block].nextFree)
+            maxSize = std::max(maxSize, blocks_[block].size);
+    }
+
+    return maxSize;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKDeviceMemoryTLSF::MappingInsert(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl)
+{
+    if (size < slCount)
+    {
+        /* Small blocks are mapped linearly into the first list */
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size);
+    }
+    else
+    {
+        const auto msb = FindLastSetBit(size);
+        fl = msb - slLog2 + 1;
+        sl = static_cast<std::uint32_t>(size >> (msb - slLog2)) - slCount;
+    }
+}
+
+void VKDeviceMemoryTLSF::MappingSearch(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl)
+{
+    /* Round size up to the next list, so any block in that list is large enough */
+    if (size >= slCount)
+    {
+        const auto roundUp = (VkDeviceSize(1) << (FindLastSetBit(size) - slLog2)) - 1;
+        if (size + roundUp < size)
+        {
+            fl = flCount;
+            sl = 0;
+            return;
+        }
+        size += roundUp;
+    }
+    MappingInsert(size, fl, sl);
+}
+
+bool VKDeviceMemoryTLSF::FindFreeList(std::uint32_t& fl, std::uint32_t& sl) const
+{
+    if (fl >= flCount)
+        return false;
+
+    /* Search second level bitmap of the same first level */
+    auto slMap = (slBitmaps_[fl] & (~0u << sl));
+
+    if (slMap == 0)
+    {
+        /* Search first level bitmap for the next larger list */
+        if (fl + 1 >= flCount)
+            return false;
+
+        const auto flMap = (flBitmap_ & (~std::uint64_t(0) << (fl + 1)));
+        if (flMap == 0)
+            return false;
+
+        fl      = FindFirstSetBit(flMap);
+        slMap   = slBitmaps_[fl];
+    }
+
+    sl = FindFirstSetBit(slMap);
+    return true;
+}
+
+std::uint32_t VKDeviceMemoryTLSF::FindFreeBlock(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize searchSize) const
+{
+    std::uint32_t fl = 0, sl = 0;
+
+    /* Find the next list whose blocks are all large enough (good-fit) */
+    MappingSearch(searchSize, fl, sl);
+    if (FindFreeList(fl, sl))
+        return freeLists_[fl][sl];
+
+    /*
+    Otherwise, check the first block of the lists the search size and the requested size belong to,
+    e.g. for a new chunk with a single block of the exact size
+    */
+    const VkDeviceSize sizes[] = { searchSize, size };
+
+    for (auto s : sizes)
+    {
+        MappingInsert(s, fl, sl);
+        auto block = freeLists_[fl][sl];
+        if (block != invalidBlock)
+        {
+            const auto& blockRef = blocks_[block];
+            if (GetAlignedSize(blockRef.offset, alignment) + size <= blockRef.offset + blockRef.size)
+                return block;
+        }
+    }
+
+    return invalidBlock;
+}
+
+std::uint32_t VKDeviceMemoryTLSF::MakeBlock(VkDeviceSize offset, VkDeviceSize size)
+{
+    std::uint32_t block = 0;
+
+    /* Reuse unused block entry or append a new one */
+    if (!unusedBlocks_.empty())
+    {
+        block = unusedBlocks_.back();
+        unusedBlocks_.pop_back();
+        blocks_[block] = Block{};
+    }
+    else
+    {
+        block = static_cast<std::uint32_t>(blocks_.size());
+        blocks_.emplace_back();
+    }
+
+    blocks_[block].offset   = offset;
+    blocks_[block].size     = size;
+
+    return block;
+}
+
+void VKDeviceMemoryTLSF::DeleteBlock(std::uint32_t block)
+{
+    blocks_[block] = Block{};
+    unusedBlocks_.push_back(block);
+}
+
+void VKDeviceMemoryTLSF::InsertFreeBlock(std::uint32_t block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MappingInsert(blocks_[block].size, fl, sl);
+
+    /* Insert block at the front of its free list */
+    auto& head = freeLists_[fl][sl];
+    {
+        blocks_[block].free     = true;
+        blocks_[block].prevFree = invalidBlock;
+        blocks_[block].nextFree = head;
+    }
+    if (head != invalidBlock)
+        blocks_[head].prevFree = block;
+    head = block;
+
+    /* Mark free list as non-empty */
+    flBitmap_       |= (std::uint64_t(1) << fl);
+    slBitmaps_[fl]  |= (1u << sl);
+
+    ++numFreeBlocks_;
+    freeSize_ += blocks_[block].size;
+}
+
+void VKDeviceMemoryTLSF::RemoveFreeBlock(std::uint32_t block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MappingInsert(blocks_[block].size, fl, sl);
+
+    /* Unlink block from its free list */
+    auto prev = blocks_[block].prevFree;
+    auto next = blocks_[block].nextFree;
+
+    if (prev != invalidBlock)
+        blocks_[prev].nextFree = next;
+    else
+        freeLists_[fl][sl] = next;
+
+    if (next != invalidBlock)
+        blocks_[next].prevFree = prev;
+
+    blocks_[block].free     = false;
+    blocks_[block].prevFree = invalidBlock;
+    blocks_[block].nextFree = invalidBlock;
+
+    /* Mark free list as empty if this was the last block */
+    if (freeLists_[fl][sl] == invalidBlock)
+    {
+        slBitmaps_[fl] &= ~(1u << sl);
+        if (slBitmaps_[fl] == 0)
+            flBitmap_ &= ~(std::uint64_t(1) << fl);
+    }
+
+    --numFreeBlocks_;
+    freeSize_ -= blocks_[block].size;
+}
+
+std::uint32_t VKDeviceMemoryTLSF::SplitBlock(std::uint32_t block, VkDeviceSize size)
+{
+    /* Create upper block from the remaining space (must be done before any reference into the container is taken) */
+    auto upper = MakeBlock(blocks_[block].offset + size, blocks_[block].size - size);
+
+    auto& lowerBlock = blocks_[block];
+    auto& upperBlock = blocks_[upper];
+
+    /* Link upper block between this block and its physical successor */
+    upperBlock.prevPhys = block;
+    upperBlock.nextPhys = lowerBlock.nextPhys;
+
+    if (lowerBlock.nextPhys != invalidBlock)
+        blocks_[lowerBlock.nextPhys].prevPhys = upper;
+
+    lowerBlock.nextPhys = upper;
+    lowerBlock.size     = size;
+
+    return upper;
+}
+
+void VKDeviceMemoryTLSF::MergeBlocks(std::uint32_t lower, std::uint32_t upper)
+{
+    auto& lowerBlock = blocks_[lower];
+    auto& upperBlock = blocks_[upper];
+
+    lowerBlock.size     += upperBlock.size;
+    lowerBlock.nextPhys = upperBlock.nextPhys;
+
+    if (upperBlock.nextPhys != invalidBlock)
+        blocks_[upperBlock.nextPhys].prevPhys = lower;
+
+    DeleteBlock(upper);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
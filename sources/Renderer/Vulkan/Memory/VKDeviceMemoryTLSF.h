@@ -0,0 +1,130 @@
+/*
+ * VKDeviceMemoryTLSF.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DEVICE_MEMORY_TLSF_H
+#define LLGL_VK_DEVICE_MEMORY_TLSF_H
+
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Two-Level Segregated Fit (TLSF) allocator for offsets within a single device memory chunk.
+Free blocks are kept in segregated lists, which are indexed by a first level (power of two) and a second level (linear subdivision).
+Both allocation and release run in constant time, independent of the number of blocks.
+Blocks are identified by an index, which remains valid until the block is released.
+*/
+class VKDeviceMemoryTLSF
+{
+
+    public:
+
+        static const std::uint32_t invalidBlock = ~0u;
+
+        VKDeviceMemoryTLSF(VkDeviceSize size);
+
+        // Allocates a block of the specified size and alignment, and returns its index or 'invalidBlock' on failure.
+        std::uint32_t Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+
+        // Releases the specified block and merges it with its physical neighbors.
+        void Release(std::uint32_t block);
+
+        // Returns an upper bound of the size that can be allocated (without alignment).
+        VkDeviceSize GetMaxAllocationSize() const;
+
+        // Returns the size of the largest free block (this has linear complexity).
+        VkDeviceSize GetMaxFreeBlockSize() const;
+
+        // Returns the number of allocated blocks.
+        inline std::size_t GetNumUsedBlocks() const
+        {
+            return numUsedBlocks_;
+        }
+
+        // Returns the number of free blocks.
+        inline std::size_t GetNumFreeBlocks() const
+        {
+            return numFreeBlocks_;
+        }
+
+        // Returns the accumulated size of all free blocks.
+        inline VkDeviceSize GetFreeSize() const
+        {
+            return freeSize_;
+        }
+
+    private:
+
+        static const std::uint32_t slLog2       = 4;
+        static const std::uint32_t slCount      = (1u << slLog2);
+        static const std::uint32_t flCount      = (64u - slLog2 + 1u);
+
+        struct Block
+        {
+            VkDeviceSize    offset      = 0;
+            VkDeviceSize    size        = 0;
+            std::uint32_t   prevPhys    = invalidBlock;
+            std::uint32_t   nextPhys    = invalidBlock;
+            std::uint32_t   prevFree    = invalidBlock;
+            std::uint32_t   nextFree    = invalidBlock;
+            bool            free        = false;
+        };
+
+    private:
+
+        // Maps the specified size to its first and second level index.
+        static void MappingInsert(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl);
+
+        // Maps the specified size to the first and second level index of the next list whose blocks are all large enough.
+        static void MappingSearch(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl);
+
+        // Finds the first free list at or above the specified index. Returns false if there is no such list.
+        bool FindFreeList(std::uint32_t& fl, std::uint32_t& sl) const;
+
+        // Finds a free block for the specified size and alignment, and returns 'invalidBlock' if there is none.
+        std::uint32_t FindFreeBlock(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize searchSize) const;
+
+        std::uint32_t MakeBlock(VkDeviceSize offset, VkDeviceSize size);
+        void DeleteBlock(std::uint32_t block);
+
+        void InsertFreeBlock(std::uint32_t block);
+        void RemoveFreeBlock(std::uint32_t block);
+
+        // Splits the specified block at the specified relative offset and returns the index of the upper part.
+        std::uint32_t SplitBlock(std::uint32_t block, VkDeviceSize size);
+
+        // Merges the upper block into the lower block and deletes the upper block.
+        void MergeBlocks(std::uint32_t lower, std::uint32_t upper);
+
+        std::vector<Block>          blocks_;
+        std::vector<std::uint32_t>  unusedBlocks_;
+
+        std::uint64_t               flBitmap_                   = 0;
+        std::uint32_t               slBitmaps_[flCount]         = {};
+        std::uint32_t               freeLists_[flCount][slCount];
+
+        std::size_t                 numUsedBlocks_              = 0;
+        std::size_t                 numFreeBlocks_              = 0;
+        VkDeviceSize                freeSize_                   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
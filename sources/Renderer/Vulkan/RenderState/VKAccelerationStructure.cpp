@@ -0,0 +1,326 @@
+/*
+ * VKAccelerationStructure.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKAccelerationStructure.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../Ext/VKExtensions.h"
+#include "../VKCore.h"
+#include "../VKTypes.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+#ifdef VK_KHR_acceleration_structure
+
+static VkBuildAccelerationStructureFlagsKHR GetVkBuildFlags(long flags)
+{
+    VkBuildAccelerationStructureFlagsKHR buildFlags = 0;
+
+    if ((flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        buildFlags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+    if ((flags & AccelerationStructureFlags::PreferFastTrace) != 0)
+        buildFlags |= VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+    if ((flags & AccelerationStructureFlags::PreferFastBuild) != 0)
+        buildFlags |= VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR;
+
+    return buildFlags;
+}
+
+static VkDeviceAddress GetVkBufferDeviceAddress(VkDevice device, Buffer* buffer, std::uint64_t offset)
+{
+    auto bufferVK = LLGL_CAST(VKBuffer*, buffer);
+
+    VkBufferDeviceAddressInfoKHR addressInfo;
+    {
+        addressInfo.sType   = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext   = nullptr;
+        addressInfo.buffer  = bufferVK->GetVkBuffer();
+    }
+    return vkGetBufferDeviceAddressKHR(device, &addressInfo) + static_cast<VkDeviceAddress>(offset);
+}
+
+VKAccelerationStructure::VKAccelerationStructure(
+    const VKPtr<VkDevice>&                  device,
+    VKDeviceMemoryManager&                  deviceMemoryMngr,
+    VkDeviceSize                            scratchAlignment,
+    const AccelerationStructureDescriptor&  desc)
+:
+    AccelerationStructure   { desc.type, desc.flags                         },
+    device_                 { device                                        },
+    storageBuffer_          { device                                        },
+    scratchBuffer_          { device                                        },
+    accelerationStructure_  { device, vkDestroyAccelerationStructureKHR     },
+    compactedSizeQueryPool_ { device, vkDestroyQueryPool                    }
+{
+    /* Initialize build info without scratch memory to query the build sizes */
+    buildInfo_.sType                        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+    buildInfo_.pNext                        = nullptr;
+    buildInfo_.type                         = (desc.type == AccelerationStructureType::TopLevel ? VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR : VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR);
+    buildInfo_.flags                        = GetVkBuildFlags(desc.flags);
+    buildInfo_.mode                         = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo_.srcAccelerationStructure     = VK_NULL_HANDLE;
+    buildInfo_.dstAccelerationStructure     = VK_NULL_HANDLE;
+    buildInfo_.geometryCount                = 0;
+    buildInfo_.pGeometries                  = nullptr;
+    buildInfo_.ppGeometries                 = nullptr;
+    buildInfo_.scratchData.deviceAddress    = 0;
+
+    if (desc.compactedSize > 0)
+    {
+        /* Destinations of a compaction only need storage for the compacted size, they are never built */
+        CreateStorageBuffer(device, deviceMemoryMngr, static_cast<VkDeviceSize>(desc.compactedSize));
+        CreateNativeAccelerationStructure(device, static_cast<VkDeviceSize>(desc.compactedSize));
+    }
+    else
+    {
+        CreateGeometries(device, desc);
+
+        /* Query sizes for the storage and scratch buffer with the maximum primitive count of each geometry */
+        std::vector<std::uint32_t> maxPrimitiveCounts(buildRanges_.size());
+        for (std::size_t i = 0; i < buildRanges_.size(); ++i)
+            maxPrimitiveCounts[i] = buildRanges_[i].primitiveCount;
+
+        VkAccelerationStructureBuildSizesInfoKHR sizeInfo;
+        {
+            sizeInfo.sType                      = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+            sizeInfo.pNext                      = nullptr;
+            sizeInfo.accelerationStructureSize  = 0;
+            sizeInfo.updateScratchSize          = 0;
+            sizeInfo.buildScratchSize           = 0;
+        }
+        vkGetAccelerationStructureBuildSizesKHR(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo_, maxPrimitiveCounts.data(), &sizeInfo);
+
+        CreateStorageBuffer(device, deviceMemoryMngr, sizeInfo.accelerationStructureSize);
+        CreateScratchBuffer(device, deviceMemoryMngr, sizeInfo.buildScratchSize, scratchAlignment);
+        CreateNativeAccelerationStructure(device, sizeInfo.accelerationStructureSize);
+
+        if ((desc.flags & AccelerationStructureFlags::AllowCompaction) != 0)
+            CreateCompactedSizeQueryPool(device);
+    }
+
+    buildInfo_.dstAccelerationStructure = accelerationStructure_;
+
+    /* Query device address to reference bottom-level acceleration structures in instance buffers */
+    VkAccelerationStructureDeviceAddressInfoKHR addressInfo;
+    {
+        addressInfo.sType                   = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext                   = nullptr;
+        addressInfo.accelerationStructure   = accelerationStructure_;
+    }
+    deviceAddress_ = vkGetAccelerationStructureDeviceAddressKHR(device, &addressInfo);
+}
+
+void VKAccelerationStructure::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    VKSetObjectName(device_, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, reinterpret_cast<std::uint64_t>(GetVkAccelerationStructure()), name);
+    #endif
+}
+
+std::uint64_t VKAccelerationStructure::GetDeviceAddress() const
+{
+    return static_cast<std::uint64_t>(deviceAddress_);
+}
+
+std::uint64_t VKAccelerationStructure::QueryCompactedSize()
+{
+    if (compactedSizeQueryPool_.Get() == VK_NULL_HANDLE || !compactedSizeQueryWritten_)
+        return 0;
+
+    /* Return zero if the last build has not been completed yet, instead of waiting for the GPU */
+    VkDeviceSize compactedSize = 0;
+    auto result = vkGetQueryPoolResults(
+        device_,
+        compactedSizeQueryPool_,
+        0,
+        1,
+        sizeof(compactedSize),
+        &compactedSize,
+        sizeof(compactedSize),
+        VK_QUERY_RESULT_64_BIT
+    );
+    return (result == VK_SUCCESS ? static_cast<std::uint64_t>(compactedSize) : 0);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKAccelerationStructure::CreateGeometries(const VKPtr<VkDevice>& device, const AccelerationStructureDescriptor& desc)
+{
+    if (desc.type == AccelerationStructureType::TopLevel)
+    {
+        /* Top-level acceleration structures have a single geometry with all instances */
+        VkAccelerationStructureGeometryKHR geometry;
+        {
+            geometry.sType                                  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+            geometry.pNext                                  = nullptr;
+            geometry.geometryType                           = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+            geometry.geometry.instances.sType               = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+            geometry.geometry.instances.pNext               = nullptr;
+            geometry.geometry.instances.arrayOfPointers     = VK_FALSE;
+            geometry.geometry.instances.data.deviceAddress  = GetVkBufferDeviceAddress(device, desc.instanceBuffer, desc.instanceOffset);
+            geometry.flags                                  = 0;
+        }
+        geometries_.push_back(geometry);
+
+        VkAccelerationStructureBuildRangeInfoKHR buildRange;
+        {
+            buildRange.primitiveCount   = desc.numInstances;
+            buildRange.primitiveOffset  = 0;
+            buildRange.firstVertex      = 0;
+            buildRange.transformOffset  = 0;
+        }
+        buildRanges_.push_back(buildRange);
+    }
+    else
+    {
+        geometries_.reserve(desc.geometries.size());
+        buildRanges_.reserve(desc.geometries.size());
+
+        for (const auto& triangles : desc.geometries)
+        {
+            const bool indexed = (triangles.indexBuffer != nullptr);
+
+            VkAccelerationStructureGeometryKHR geometry;
+            {
+                geometry.sType                                      = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+                geometry.pNext                                      = nullptr;
+                geometry.geometryType                               = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+                geometry.geometry.triangles.sType                   = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+                geometry.geometry.triangles.pNext                   = nullptr;
+                geometry.geometry.triangles.vertexFormat            = VKTypes::Map(triangles.vertexFormat);
+                geometry.geometry.triangles.vertexData.deviceAddress = GetVkBufferDeviceAddress(device, triangles.vertexBuffer, triangles.vertexOffset);
+                geometry.geometry.triangles.vertexStride            = triangles.vertexStride;
+                geometry.geometry.triangles.maxVertex               = (triangles.numVertices > 0 ? triangles.numVertices - 1 : 0);
+                if (indexed)
+                {
+                    geometry.geometry.triangles.indexType               = (triangles.indexFormat == Format::R16UInt ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+                    geometry.geometry.triangles.indexData.deviceAddress = GetVkBufferDeviceAddress(device, triangles.indexBuffer, triangles.indexOffset);
+                }
+                else
+                {
+                    geometry.geometry.triangles.indexType               = VK_INDEX_TYPE_NONE_KHR;
+                    geometry.geometry.triangles.indexData.deviceAddress = 0;
+                }
+                geometry.geometry.triangles.transformData.deviceAddress = 0;
+                geometry.flags                                      = (triangles.opaque ? VK_GEOMETRY_OPAQUE_BIT_KHR : 0);
+            }
+            geometries_.push_back(geometry);
+
+            VkAccelerationStructureBuildRangeInfoKHR buildRange;
+            {
+                buildRange.primitiveCount   = (indexed ? triangles.numIndices : triangles.numVertices) / 3;
+                buildRange.primitiveOffset  = 0;
+                buildRange.firstVertex      = 0;
+                buildRange.transformOffset  = 0;
+            }
+            buildRanges_.push_back(buildRange);
+        }
+    }
+
+    buildInfo_.geometryCount    = static_cast<std::uint32_t>(geometries_.size());
+    buildInfo_.pGeometries      = geometries_.data();
+}
+
+void VKAccelerationStructure::CreateStorageBuffer(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size;
+        createInfo.usage                    = (VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR);
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    storageBuffer_.Create(device, createInfo);
+
+    const auto& requirements = storageBuffer_.requirements;
+    memoryRegion_ = deviceMemoryMngr.Allocate(requirements.size, requirements.alignment, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    memoryRegion_->BindBuffer(device, storageBuffer_.buffer);
+}
+
+void VKAccelerationStructure::CreateScratchBuffer(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize size, VkDeviceSize alignment)
+{
+    /* Reserve additional space to align the scratch address, since the buffer address itself is only aligned to the memory requirements */
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size + alignment - 1;
+        createInfo.usage                    = (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR);
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    scratchBuffer_.Create(device, createInfo);
+
+    const auto& requirements = scratchBuffer_.requirements;
+    memoryRegionScratch_ = deviceMemoryMngr.Allocate(requirements.size, requirements.alignment, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    memoryRegionScratch_->BindBuffer(device, scratchBuffer_.buffer);
+
+    VkBufferDeviceAddressInfoKHR addressInfo;
+    {
+        addressInfo.sType   = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext   = nullptr;
+        addressInfo.buffer  = scratchBuffer_.buffer;
+    }
+    buildInfo_.scratchData.deviceAddress = GetAlignedSize(vkGetBufferDeviceAddressKHR(device, &addressInfo), alignment);
+}
+
+void VKAccelerationStructure::CreateNativeAccelerationStructure(const VKPtr<VkDevice>& device, VkDeviceSize size)
+{
+    VkAccelerationStructureCreateInfoKHR createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+        createInfo.pNext            = nullptr;
+        createInfo.createFlags      = 0;
+        createInfo.buffer           = storageBuffer_.buffer;
+        createInfo.offset           = 0;
+        createInfo.size             = size;
+        createInfo.type             = buildInfo_.type;
+        createInfo.deviceAddress    = 0;
+    }
+    auto result = vkCreateAccelerationStructureKHR(device, &createInfo, VKGetAllocationCallbacks(), accelerationStructure_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan acceleration structure");
+}
+
+void VKAccelerationStructure::CreateCompactedSizeQueryPool(const VKPtr<VkDevice>& device)
+{
+    VkQueryPoolCreateInfo createInfo;
+    {
+        createInfo.sType                = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.queryType            = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        createInfo.queryCount           = 1;
+        createInfo.pipelineStatistics   = 0;
+    }
+    auto result = vkCreateQueryPool(device, &createInfo, VKGetAllocationCallbacks(), compactedSizeQueryPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan query pool for compacted size of acceleration structure");
+}
+
+#endif // /VK_KHR_acceleration_structure
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
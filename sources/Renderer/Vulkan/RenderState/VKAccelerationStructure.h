@@ -0,0 +1,130 @@
+/*
+ * VKAccelerationStructure.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_ACCELERATION_STRUCTURE_H
+#define LLGL_VK_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+#include "../Buffer/VKBuffer.h"
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+#ifdef VK_KHR_acceleration_structure
+
+class VKDeviceMemoryManager;
+
+/*
+Acceleration structure with its own storage and scratch buffer, so that multiple acceleration structures can be built within the same command.
+The build inputs are resolved to device addresses once on creation, so the input buffers must not be released as long as this object is built from them.
+*/
+class VKAccelerationStructure final : public AccelerationStructure
+{
+
+    public:
+
+        VKAccelerationStructure(
+            const VKPtr<VkDevice>&                  device,
+            VKDeviceMemoryManager&                  deviceMemoryMngr,
+            VkDeviceSize                            scratchAlignment,
+            const AccelerationStructureDescriptor&  desc
+        );
+
+        void SetName(const char* name) override;
+
+        std::uint64_t GetDeviceAddress() const override;
+        std::uint64_t QueryCompactedSize() override;
+
+        // Returns the build info for all geometries and the native acceleration structure as destination.
+        inline const VkAccelerationStructureBuildGeometryInfoKHR& GetBuildGeometryInfo() const
+        {
+            return buildInfo_;
+        }
+
+        // Returns the array of build ranges, one for each geometry of the build info.
+        inline const VkAccelerationStructureBuildRangeInfoKHR* GetBuildRangeInfos() const
+        {
+            return buildRanges_.data();
+        }
+
+        // Returns the native acceleration structure object.
+        inline VkAccelerationStructureKHR GetVkAccelerationStructure() const
+        {
+            return accelerationStructure_.Get();
+        }
+
+        // Returns the query pool for the compacted size, or VK_NULL_HANDLE if compaction is not allowed.
+        inline VkQueryPool GetCompactedSizeQueryPool() const
+        {
+            return compactedSizeQueryPool_.Get();
+        }
+
+        // Marks the compacted size query as written by a command buffer, so it can be read with QueryCompactedSize.
+        inline void MarkCompactedSizeQueryWritten()
+        {
+            compactedSizeQueryWritten_ = true;
+        }
+
+        // Returns the region of the device memory for the storage buffer.
+        inline VKDeviceMemoryRegion* GetMemoryRegion() const
+        {
+            return memoryRegion_;
+        }
+
+        // Returns the region of the device memory for the scratch buffer.
+        inline VKDeviceMemoryRegion* GetMemoryRegionScratch() const
+        {
+            return memoryRegionScratch_;
+        }
+
+    private:
+
+        void CreateGeometries(const VKPtr<VkDevice>& device, const AccelerationStructureDescriptor& desc);
+        void CreateStorageBuffer(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize size);
+        void CreateScratchBuffer(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize size, VkDeviceSize alignment);
+        void CreateNativeAccelerationStructure(const VKPtr<VkDevice>& device, VkDeviceSize size);
+        void CreateCompactedSizeQueryPool(const VKPtr<VkDevice>& device);
+
+    private:
+
+        VkDevice                                                device_                     = VK_NULL_HANDLE;
+
+        VKBufferWithRequirements                                storageBuffer_;
+        VKDeviceMemoryRegion*                                   memoryRegion_               = nullptr;
+
+        VKBufferWithRequirements                                scratchBuffer_;
+        VKDeviceMemoryRegion*                                   memoryRegionScratch_        = nullptr;
+
+        VKPtr<VkAccelerationStructureKHR>                       accelerationStructure_;
+        VkDeviceAddress                                         deviceAddress_              = 0;
+
+        std::vector<VkAccelerationStructureGeometryKHR>         geometries_;
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR>   buildRanges_;
+        VkAccelerationStructureBuildGeometryInfoKHR             buildInfo_;
+
+        VKPtr<VkQueryPool>                                      compactedSizeQueryPool_;
+        bool                                                    compactedSizeQueryWritten_  = false;
+
+};
+
+#endif // /VK_KHR_acceleration_structure
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
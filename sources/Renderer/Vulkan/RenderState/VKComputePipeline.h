@@ -19,13 +19,17 @@ namespace LLGL
 
 
 class VKShaderProgram;
+class VKPipelineLayout;
 
 class VKComputePipeline final : public ComputePipeline
 {
 
     public:
 
-        VKComputePipeline(const VKPtr<VkDevice>& device, const ComputePipelineDescriptor& desc, VkPipelineLayout defaultPipelineLayout);
+        VKComputePipeline(
+            const VKPtr<VkDevice>& device, const ComputePipelineDescriptor& desc,
+            VkPipelineLayout defaultPipelineLayout, VkPipelineCache pipelineCache
+        );
 
         inline VkPipeline GetVkPipeline() const
         {
@@ -37,13 +41,26 @@ class VKComputePipeline final : public ComputePipeline
             return pipelineLayout_;
         }
 
+        // Returns the pipeline layout this pipeline has been created with, or null if it uses the default pipeline layout.
+        inline const VKPipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayoutVK_;
+        }
+
+        inline VkShaderStageFlags GetConstantsStageFlags() const
+        {
+            return constantsStageFlags_;
+        }
+
     private:
 
-        void CreateComputePipeline(const ComputePipelineDescriptor& desc);
+        void CreateComputePipeline(const ComputePipelineDescriptor& desc, VkPipelineCache pipelineCache);
 
-        VkDevice            device_         = VK_NULL_HANDLE;
-        VkPipelineLayout    pipelineLayout_ = VK_NULL_HANDLE;
-        VKPtr<VkPipeline>   pipeline_;
+        VkDevice                device_                 = VK_NULL_HANDLE;
+        VkPipelineLayout        pipelineLayout_         = VK_NULL_HANDLE;
+        const VKPipelineLayout* pipelineLayoutVK_       = nullptr;
+        VkShaderStageFlags      constantsStageFlags_    = 0;
+        VKPtr<VkPipeline>       pipeline_;
 
 };
 
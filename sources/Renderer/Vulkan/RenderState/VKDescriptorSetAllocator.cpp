@@ -0,0 +1,191 @@
+/*
+ * VKDescriptorSetAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDescriptorSetAllocator.h"
+#include "../VKCore.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Maximal number of descriptor sets per descriptor pool
+static const std::uint32_t g_maxNumSetsPerPool          = 256;
+
+// Number of descriptors per descriptor type within a pool (unless a single descriptor set requires more)
+static const std::uint32_t g_numDescriptorsPerPool      = 4096;
+
+// Maximal bucket index, i.e. a single descriptor set can have up to 2^31 descriptors
+static const std::uint32_t g_maxBucket                  = 31;
+
+// All descriptor types that are supported for resource heaps (acceleration structures must be the last entry, since they are only enabled with ray queries)
+static const VkDescriptorType g_descriptorPoolTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    #ifdef VK_KHR_acceleration_structure
+    VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+    #endif
+};
+
+static const std::size_t g_numDescriptorPoolTypes = sizeof(g_descriptorPoolTypes)/sizeof(g_descriptorPoolTypes[0]);
+
+VKDescriptorSetAllocator::VKDescriptorSetAllocator(const VKPtr<VkDevice>& device, bool accelerationStructures) :
+    device_         { device                  },
+    numPoolTypes_   { g_numDescriptorPoolTypes }
+{
+    #ifdef VK_KHR_acceleration_structure
+    if (!accelerationStructures)
+        --numPoolTypes_;
+    #endif
+}
+
+VKDescriptorSetAllocator::~VKDescriptorSetAllocator()
+{
+    for (const auto& pools : buckets_)
+    {
+        for (const auto& pool : pools)
+            vkDestroyDescriptorPool(device_, pool.pool, VKGetAllocationCallbacks());
+    }
+}
+
+VKDescriptorSetAllocation VKDescriptorSetAllocator::Allocate(VkDescriptorSetLayout setLayout, std::uint32_t numDescriptors)
+{
+    /* Find bucket for the smallest power of two that is greater than or equal to the number of descriptors */
+    VKDescriptorSetAllocation allocation;
+
+    while (allocation.bucket < g_maxBucket && (1u << allocation.bucket) < numDescriptors)
+        ++allocation.bucket;
+
+    if (allocation.bucket >= buckets_.size())
+        buckets_.resize(allocation.bucket + 1);
+
+    auto& pools = buckets_[allocation.bucket];
+
+    /* Allocate descriptor set from the first pool of this bucket that is not exhausted */
+    for (std::size_t i = 0; i < pools.size(); ++i)
+    {
+        if (AllocateFromPool(pools[i], setLayout, allocation.descriptorSet))
+        {
+            allocation.poolIndex = static_cast<std::uint32_t>(i);
+            return allocation;
+        }
+    }
+
+    /* Create new descriptor pool for this bucket */
+    pools.push_back(CreateDescriptorPool(allocation.bucket));
+
+    if (!AllocateFromPool(pools.back(), setLayout, allocation.descriptorSet))
+        throw std::runtime_error("failed to allocate Vulkan descriptor set from new descriptor pool");
+
+    allocation.poolIndex = static_cast<std::uint32_t>(pools.size() - 1);
+
+    return allocation;
+}
+
+void VKDescriptorSetAllocator::Free(const VKDescriptorSetAllocation& allocation)
+{
+    if (allocation.descriptorSet == VK_NULL_HANDLE)
+        return;
+
+    auto& pool = buckets_[allocation.bucket][allocation.poolIndex];
+
+    if (--pool.numSets == 0)
+    {
+        /* Reset entire pool once it is unused, which also avoids fragmentation */
+        auto result = vkResetDescriptorPool(device_, pool.pool, 0);
+        VKThrowIfFailed(result, "failed to reset Vulkan descriptor pool");
+    }
+    else
+    {
+        auto result = vkFreeDescriptorSets(device_, pool.pool, 1, &(allocation.descriptorSet));
+        VKThrowIfFailed(result, "failed to release Vulkan descriptor set");
+    }
+}
+
+VKDescriptorInfo* VKDescriptorSetAllocator::GetDescriptorInfoScratch(std::size_t numDescriptorInfos)
+{
+    if (scratch_.size() < numDescriptorInfos)
+        scratch_.resize(numDescriptorInfos);
+    return scratch_.data();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKDescriptorSetAllocator::DescriptorPool VKDescriptorSetAllocator::CreateDescriptorPool(std::uint32_t bucket)
+{
+    /* Determine number of descriptor sets and descriptors for this bucket */
+    DescriptorPool pool;
+    pool.maxSets = std::max(1u, std::min(g_maxNumSetsPerPool, (g_numDescriptorsPerPool >> bucket)));
+
+    const auto numDescriptors = pool.maxSets * (1u << bucket);
+
+    /* Initialize descriptor pool sizes */
+    VkDescriptorPoolSize poolSizes[g_numDescriptorPoolTypes];
+
+    for (std::size_t i = 0; i < numPoolTypes_; ++i)
+    {
+        poolSizes[i].type               = g_descriptorPoolTypes[i];
+        poolSizes[i].descriptorCount    = numDescriptors;
+    }
+
+    /* Create descriptor pool that allows descriptor sets to be released individually */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolCreateInfo.maxSets          = pool.maxSets;
+        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(numPoolTypes_);
+        poolCreateInfo.pPoolSizes       = poolSizes;
+    }
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, VKGetAllocationCallbacks(), &(pool.pool));
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+
+    return pool;
+}
+
+bool VKDescriptorSetAllocator::AllocateFromPool(DescriptorPool& pool, VkDescriptorSetLayout setLayout, VkDescriptorSet& descriptorSet)
+{
+    if (pool.numSets >= pool.maxSets)
+        return false;
+
+    /* Allocate descriptor set */
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = pool.pool;
+        allocInfo.descriptorSetCount    = 1;
+        allocInfo.pSetLayouts           = &setLayout;
+    }
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSet);
+
+    /* Pools can still be exhausted by fragmentation, which is not an error here */
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY_KHR || result == VK_ERROR_FRAGMENTED_POOL)
+        return false;
+
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+    ++pool.numSets;
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,88 @@
+/*
+ * VKDescriptorSetAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DESCRIPTOR_SET_ALLOCATOR_H
+#define LLGL_VK_DESCRIPTOR_SET_ALLOCATOR_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "../VKContainers.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Descriptor set that has been allocated by the descriptor set allocator.
+struct VKDescriptorSetAllocation
+{
+    VkDescriptorSet descriptorSet   = VK_NULL_HANDLE;
+    std::uint32_t   bucket          = 0;
+    std::uint32_t   poolIndex       = 0;
+};
+
+/*
+Allocator for the descriptor sets of all resource heaps, which shares its descriptor pools between all resource heaps.
+Descriptor sets are allocated from pools of the bucket for the smallest power of two that fits the number of descriptors of the set,
+so creating a resource heap only requires a new descriptor pool once all pools of its bucket are exhausted.
+Descriptor pools without any remaining descriptor sets are reset, which makes them available again without fragmentation.
+*/
+class VKDescriptorSetAllocator
+{
+
+    public:
+
+        // Descriptor pools only provide acceleration structures if the respective extension has been enabled.
+        VKDescriptorSetAllocator(const VKPtr<VkDevice>& device, bool accelerationStructures = false);
+        ~VKDescriptorSetAllocator();
+
+        VKDescriptorSetAllocator(const VKDescriptorSetAllocator&) = delete;
+        VKDescriptorSetAllocator& operator = (const VKDescriptorSetAllocator&) = delete;
+
+        // Allocates a descriptor set with the specified layout, which contains the specified number of descriptors in total.
+        VKDescriptorSetAllocation Allocate(VkDescriptorSetLayout setLayout, std::uint32_t numDescriptors);
+
+        // Returns the specified descriptor set to its pool. The GPU must no longer reference this descriptor set.
+        void Free(const VKDescriptorSetAllocation& allocation);
+
+        // Returns a scratch buffer for the specified number of descriptor infos, which is valid until the next call.
+        VKDescriptorInfo* GetDescriptorInfoScratch(std::size_t numDescriptorInfos);
+
+    private:
+
+        struct DescriptorPool
+        {
+            VkDescriptorPool    pool        = VK_NULL_HANDLE;
+            std::uint32_t       numSets     = 0;
+            std::uint32_t       maxSets     = 0;
+        };
+
+        DescriptorPool CreateDescriptorPool(std::uint32_t bucket);
+
+        bool AllocateFromPool(DescriptorPool& pool, VkDescriptorSetLayout setLayout, VkDescriptorSet& descriptorSet);
+
+    private:
+
+        VkDevice                                    device_         = VK_NULL_HANDLE;
+        std::size_t                                 numPoolTypes_   = 0;    // Number of entries of the descriptor pool types that are used for each pool.
+        std::vector<std::vector<DescriptorPool>>    buckets_;
+        std::vector<VKDescriptorInfo>               scratch_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
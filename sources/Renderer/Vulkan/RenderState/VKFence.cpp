@@ -7,14 +7,20 @@
 
 #include "VKFence.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include <stdexcept>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-VKFence::VKFence(const VKPtr<VkDevice>& device) :
-    fence_ { device, vkDestroyFence }
+VKFence::VKFence(const VKPtr<VkDevice>& device, bool hasTimelineSemaphores) :
+    device_                 { device                     },
+    fence_                  { device, vkDestroyFence     },
+    timelineSemaphore_      { device, vkDestroySemaphore },
+    hasTimelineSemaphores_  { hasTimelineSemaphores      }
 {
     VkFenceCreateInfo createInfo;
     {
@@ -22,13 +28,14 @@ VKFence::VKFence(const VKPtr<VkDevice>& device) :
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
     }
-    auto result = vkCreateFence(device, &createInfo, nullptr, fence_.ReleaseAndGetAddressOf());
+    auto result = vkCreateFence(device, &createInfo, VKGetAllocationCallbacks(), fence_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan fence");
 }
 
 void VKFence::Reset(VkDevice device)
 {
     vkResetFences(device, 1, &fence_);
+    isSubmitted_ = true;
 }
 
 bool VKFence::Wait(VkDevice device, std::uint64_t timeout)
@@ -36,6 +43,112 @@ bool VKFence::Wait(VkDevice device, std::uint64_t timeout)
     return (vkWaitForFences(device, 1, &fence_, VK_TRUE, timeout) == VK_SUCCESS);
 }
 
+std::uint64_t VKFence::GetCompletedValue()
+{
+    #ifdef VK_KHR_timeline_semaphore
+
+    /* Timeline semaphore that has never been used has not been signaled yet */
+    if (timelineSemaphore_.Get() == VK_NULL_HANDLE)
+        return 0;
+
+    std::uint64_t value = 0;
+    auto result = vkGetSemaphoreCounterValueKHR(device_, timelineSemaphore_, &value);
+    VKThrowIfFailed(result, "failed to query Vulkan timeline semaphore value");
+
+    return value;
+
+    #else
+
+    return 0;
+
+    #endif // /VK_KHR_timeline_semaphore
+}
+
+bool VKFence::WaitValue(std::uint64_t value, std::uint64_t timeout)
+{
+    #ifdef VK_KHR_timeline_semaphore
+
+    VkSemaphore semaphore = GetTimelineSemaphore();
+
+    VkSemaphoreWaitInfoKHR waitInfo;
+    {
+        waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.pNext          = nullptr;
+        waitInfo.flags          = 0;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &semaphore;
+        waitInfo.pValues        = &value;
+    }
+    return (vkWaitSemaphoresKHR(device_, &waitInfo, timeout) == VK_SUCCESS);
+
+    #else
+
+    return false;
+
+    #endif // /VK_KHR_timeline_semaphore
+}
+
+VkSemaphore VKFence::GetTimelineSemaphore()
+{
+    #ifdef VK_KHR_timeline_semaphore
+
+    if (timelineSemaphore_.Get() == VK_NULL_HANDLE)
+    {
+        if (!hasTimelineSemaphores_)
+            throw std::runtime_error("Vulkan timeline fences are not supported (VK_KHR_timeline_semaphore)");
+
+        /* Create timeline semaphore with initial value 0 */
+        VkSemaphoreTypeCreateInfoKHR typeCreateInfo;
+        {
+            typeCreateInfo.sType            = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            typeCreateInfo.pNext            = nullptr;
+            typeCreateInfo.semaphoreType    = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            typeCreateInfo.initialValue     = 0;
+        }
+        VkSemaphoreCreateInfo createInfo;
+        {
+            createInfo.sType                = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext                = &typeCreateInfo;
+            createInfo.flags                = 0;
+        }
+        auto result = vkCreateSemaphore(device_, &createInfo, VKGetAllocationCallbacks(), timelineSemaphore_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan timeline semaphore");
+    }
+
+    return timelineSemaphore_;
+
+    #else
+
+    throw std::runtime_error("Vulkan timeline fences are not supported (VK_KHR_timeline_semaphore)");
+
+    #endif // /VK_KHR_timeline_semaphore
+}
+
+VkSemaphore VKFence::PrepareSignal(std::uint64_t value)
+{
+    signaledValue_ = std::max(signaledValue_, value);
+    return GetTimelineSemaphore();
+}
+
+bool VKFence::IsIdle()
+{
+    if (isSubmitted_ && vkGetFenceStatus(device_, fence_) != VK_SUCCESS)
+        return false;
+    if (timelineSemaphore_.Get() != VK_NULL_HANDLE && GetCompletedValue() < signaledValue_)
+        return false;
+    return true;
+}
+
+void VKFence::Recycle()
+{
+    /* Timeline semaphores cannot be reset to their initial value, so the semaphore is created on demand again */
+    timelineSemaphore_.Release();
+    signaledValue_ = 0;
+
+    vkResetFences(device_, 1, &fence_);
+    isSubmitted_ = false;
+}
+
 
 } // /namespace LLGL
 
@@ -23,11 +23,29 @@ class VKFence final : public Fence
 
     public:
 
-        VKFence(const VKPtr<VkDevice>& device);
+        VKFence(const VKPtr<VkDevice>& device, bool hasTimelineSemaphores);
 
+        std::uint64_t GetCompletedValue() override;
+
+        // Resets the hardware fence before it is submitted to a queue.
         void Reset(VkDevice device);
         bool Wait(VkDevice device, std::uint64_t timeout);
 
+        // Blocks the CPU until the timeline semaphore has reached the specified value, or the timeout (in nanoseconds) has expired.
+        bool WaitValue(std::uint64_t value, std::uint64_t timeout);
+
+        // Returns the timeline semaphore of this fence, which is created on demand (requires VK_KHR_timeline_semaphore).
+        VkSemaphore GetTimelineSemaphore();
+
+        // Returns the timeline semaphore of this fence and records the specified value it is about to be signaled with.
+        VkSemaphore PrepareSignal(std::uint64_t value);
+
+        // Returns true if the GPU has completed all submissions and signals of this fence, i.e. the fence can be recycled.
+        bool IsIdle();
+
+        // Resets this fence to the state of a newly created fence for recycling. The fence must be idle.
+        void Recycle();
+
         inline VkFence GetHardwareFence() const
         {
             return fence_;
@@ -35,7 +53,12 @@ class VKFence final : public Fence
 
     private:
 
-        VKPtr<VkFence> fence_;
+        VkDevice                device_                 = VK_NULL_HANDLE;
+        VKPtr<VkFence>          fence_;
+        VKPtr<VkSemaphore>      timelineSemaphore_;
+        bool                    hasTimelineSemaphores_  = false;
+        bool                    isSubmitted_            = false;    // Hardware fence has been submitted since it was created or recycled
+        std::uint64_t           signaledValue_          = 0;        // Greatest value the timeline semaphore is signaled with
 
 };
 
@@ -12,7 +12,9 @@
 #include "../VKTypes.h"
 #include "../VKCore.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/TaskQueue.h"
 #include <cstddef>
+#include <memory>
 #include <LLGL/GraphicsPipelineFlags.h>
 
 
@@ -21,20 +23,23 @@ namespace LLGL
 
 
 VKGraphicsPipeline::VKGraphicsPipeline(
-    const VKPtr<VkDevice>& device, VkRenderPass renderPass, VkPipelineLayout defaultPipelineLayout,
-    const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent) :
-        device_            { device                             },
-        renderPass_        { renderPass                         },
-        pipelineLayout_    { defaultPipelineLayout              },
-        pipeline_          { device, vkDestroyPipeline          },
-        scissorEnabled_    { desc.rasterizer.scissorTestEnabled },
-        hasDynamicScissor_ { desc.scissors.empty()              }
+    const VKPtr<VkDevice>& device, VkRenderPass renderPass, VkPipelineLayout defaultPipelineLayout, VkPipelineCache pipelineCache,
+    const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, bool async) :
+        device_             { device                             },
+        renderPass_         { renderPass                         },
+        pipelineLayout_     { defaultPipelineLayout              },
+        pipeline_           { device, vkDestroyPipeline          },
+        scissorEnabled_     { desc.rasterizer.scissorTestEnabled },
+        hasDynamicScissor_  { desc.scissors.empty()              },
+        hasDynamicViewport_ { desc.viewports.empty()             }
 {
     /* Get pipeline layout object */
     if (desc.pipelineLayout)
     {
         auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
-        pipelineLayout_ = pipelineLayoutVK->GetVkPipelineLayout();
+        pipelineLayout_     = pipelineLayoutVK->GetVkPipelineLayout();
+        pipelineLayoutVK_   = pipelineLayoutVK;
+        constantsStages_    = pipelineLayoutVK->GetConstantsStageFlags();
     }
 
     /* Use render pass from render target if it's specified */
@@ -45,7 +50,29 @@ VKGraphicsPipeline::VKGraphicsPipeline(
     }
 
     /* Create Vulkan graphics pipeline object */
-    CreateGraphicsPipeline(desc, limits, extent);
+    if (async)
+        CreateGraphicsPipelineAsync(desc, limits, extent, pipelineCache);
+    else
+        CreateGraphicsPipeline(desc, limits, extent, pipelineCache);
+}
+
+VKGraphicsPipeline::~VKGraphicsPipeline()
+{
+    /* Pipeline must not be destroyed while it is still being created */
+    if (createTask_.valid())
+        createTask_.wait();
+}
+
+bool VKGraphicsPipeline::IsReady() const
+{
+    return IsFutureReady(createTask_);
+}
+
+VkPipeline VKGraphicsPipeline::GetVkPipeline() const
+{
+    if (createTask_.valid())
+        createTask_.get();
+    return pipeline_.Get();
 }
 
 
@@ -130,12 +157,29 @@ static void CreateViewportState(
     createInfo.pScissors = scissorsVK.data();
 }
 
-static void CreateRasterizerState(const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, VkPipelineRasterizationStateCreateInfo& createInfo)
+#ifdef VK_EXT_conservative_rasterization
+
+static void CreateConservativeRasterizationState(VkPipelineRasterizationConservativeStateCreateInfoEXT& createInfo)
+{
+    createInfo.sType                            = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT;
+    createInfo.pNext                            = nullptr;
+    createInfo.flags                            = 0;
+    createInfo.conservativeRasterizationMode    = VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT;
+    createInfo.extraPrimitiveOverestimationSize = 0.0f;
+}
+
+#endif
+
+static void CreateRasterizerState(
+    const GraphicsPipelineDescriptor&       desc,
+    const VKGraphicsPipelineLimits&         limits,
+    VkPipelineRasterizationStateCreateInfo& createInfo,
+    const void*                             next = nullptr)
 {
     auto shaderProgramVK = LLGL_CAST(VKShaderProgram*, desc.shaderProgram);
 
     createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    createInfo.pNext                    = nullptr;
+    createInfo.pNext                    = next;
     createInfo.flags                    = 0;
     createInfo.depthClampEnable         = VKBoolean(desc.rasterizer.depthClampEnabled);
     createInfo.rasterizerDiscardEnable  = VKBoolean(!shaderProgramVK->HasFragmentShader());
@@ -146,7 +190,7 @@ static void CreateRasterizerState(const GraphicsPipelineDescriptor& desc, const
     #else
     createInfo.frontFace                = (desc.rasterizer.frontCCW ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE);
     #endif
-    createInfo.depthBiasEnable          = VKBoolean(desc.rasterizer.depthBias.clamp != 0.0f);
+    createInfo.depthBiasEnable          = VKBoolean(desc.rasterizer.depthBias.clamp != 0.0f || (desc.dynamicStates & DynamicStateFlags::DepthBias) != 0);
     createInfo.depthBiasConstantFactor  = desc.rasterizer.depthBias.constantFactor;
     createInfo.depthBiasClamp           = desc.rasterizer.depthBias.clamp;
     createInfo.depthBiasSlopeFactor     = desc.rasterizer.depthBias.slopeFactor;
@@ -205,12 +249,12 @@ static void CreateDepthStencilState(const GraphicsPipelineDescriptor& desc, VkPi
     createInfo.depthTestEnable          = VKBoolean(desc.depth.testEnabled);
     createInfo.depthWriteEnable         = VKBoolean(desc.depth.writeEnabled);
     createInfo.depthCompareOp           = VKTypes::Map(desc.depth.compareOp);
-    createInfo.depthBoundsTestEnable    = VKBoolean(!desc.rasterizer.depthClampEnabled);
+    createInfo.depthBoundsTestEnable    = VKBoolean(desc.depth.boundsTestEnabled);
     createInfo.stencilTestEnable        = VKBoolean(desc.stencil.testEnabled);
     CreateStencilOpState(desc.stencil.front, createInfo.front);
     CreateStencilOpState(desc.stencil.back, createInfo.back);
-    createInfo.minDepthBounds           = 0.0f;
-    createInfo.maxDepthBounds           = 1.0f;
+    createInfo.minDepthBounds           = desc.depth.boundsMin;
+    createInfo.maxDepthBounds           = desc.depth.boundsMax;
 }
 
 static void CreateColorBlendAttachmentState(VkPipelineColorBlendAttachmentState& createInfo, const BlendTargetDescriptor& desc, VkBool32 blendEnable)
@@ -277,12 +321,28 @@ static void CreateColorBlendState(const BlendDescriptor& desc, VkPipelineColorBl
     createInfo.blendConstants[3]    = desc.blendFactor.a;
 }
 
-static void CreateDynamicState(const GraphicsPipelineDescriptor& desc, VkPipelineDynamicStateCreateInfo& createInfo, std::vector<VkDynamicState>& dynamicStatesVK)
+static void CreateDynamicState(
+    const GraphicsPipelineDescriptor&   desc,
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineDynamicStateCreateInfo&   createInfo,
+    std::vector<VkDynamicState>&        dynamicStatesVK)
 {
     if (desc.viewports.empty())
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_VIEWPORT);
     if (desc.scissors.empty())
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_SCISSOR);
+    if ((desc.dynamicStates & DynamicStateFlags::StencilReference) != 0)
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_REFERENCE);
+    if ((desc.dynamicStates & DynamicStateFlags::BlendFactor) != 0)
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_BLEND_CONSTANTS);
+    if ((desc.dynamicStates & DynamicStateFlags::DepthBias) != 0)
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
+    if ((desc.dynamicStates & DynamicStateFlags::DepthBounds) != 0)
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_BOUNDS);
+    #ifdef VK_KHR_fragment_shading_rate
+    if (limits.dynamicShadingRate)
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR);
+    #endif
 
     createInfo.sType                = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     createInfo.pNext                = nullptr;
@@ -291,7 +351,8 @@ static void CreateDynamicState(const GraphicsPipelineDescriptor& desc, VkPipelin
     createInfo.pDynamicStates       = (dynamicStatesVK.empty() ? nullptr : dynamicStatesVK.data());
 }
 
-void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent)
+void VKGraphicsPipeline::CreateGraphicsPipeline(
+    const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, VkPipelineCache pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(VKShaderProgram*, desc.shaderProgram);
@@ -301,6 +362,9 @@ void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor
     /* Get shader stages */
     auto shaderStageCreateInfos = shaderProgramVK->GetShaderStageCreateInfos();
 
+    /* Mesh shader pipelines have no vertex input and input assembly state */
+    const bool isMeshPipeline = shaderProgramVK->HasMeshShader();
+
     /* Initialize vertex input descriptor */
     VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo;
     shaderProgramVK->FillVertexInputStateCreateInfo(vertexInputCreateInfo);
@@ -319,9 +383,20 @@ void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor
     VkPipelineViewportStateCreateInfo viewportState;
     CreateViewportState(desc, extent, viewportState, viewportsVK, scissorsVK);
 
-    /* Initialize rasterizer state */
+    /* Initialize rasterizer state (conservative rasterization extends it if enabled) */
     VkPipelineRasterizationStateCreateInfo rasterizerState;
-    CreateRasterizerState(desc, limits, rasterizerState);
+    #ifdef VK_EXT_conservative_rasterization
+    VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeState;
+    if (desc.rasterizer.conservativeRasterization && limits.conservativeRasterization)
+    {
+        CreateConservativeRasterizationState(conservativeState);
+        CreateRasterizerState(desc, limits, rasterizerState, &conservativeState);
+    }
+    else
+    #endif
+    {
+        CreateRasterizerState(desc, limits, rasterizerState);
+    }
 
     /* Initialize multi-sample state */
     VkPipelineMultisampleStateCreateInfo multisampleState;
@@ -339,7 +414,7 @@ void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor
     /* Initialize dynamic state */
     std::vector<VkDynamicState> dynamicStatesVK;
     VkPipelineDynamicStateCreateInfo dynamicState;
-    CreateDynamicState(desc, dynamicState, dynamicStatesVK);
+    CreateDynamicState(desc, limits, dynamicState, dynamicStatesVK);
 
     /* Create graphics pipeline state object */
     VkGraphicsPipelineCreateInfo createInfo;
@@ -349,9 +424,9 @@ void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor
         createInfo.flags                        = 0;
         createInfo.stageCount                   = static_cast<std::uint32_t>(shaderStageCreateInfos.size());
         createInfo.pStages                      = shaderStageCreateInfos.data();
-        createInfo.pVertexInputState            = (&vertexInputCreateInfo);
-        createInfo.pInputAssemblyState          = (&inputAssembly);
-        createInfo.pTessellationState           = (inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
+        createInfo.pVertexInputState            = (isMeshPipeline ? nullptr : &vertexInputCreateInfo);
+        createInfo.pInputAssemblyState          = (isMeshPipeline ? nullptr : &inputAssembly);
+        createInfo.pTessellationState           = (!isMeshPipeline && inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
         createInfo.pViewportState               = (&viewportState);
         createInfo.pRasterizationState          = (&rasterizerState);
         createInfo.pMultisampleState            = (&multisampleState);
@@ -364,10 +439,24 @@ void VKGraphicsPipeline::CreateGraphicsPipeline(const GraphicsPipelineDescriptor
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device_, VK_NULL_HANDLE, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
+    auto result = vkCreateGraphicsPipelines(device_, pipelineCache, 1, &createInfo, VKGetAllocationCallbacks(), pipeline_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
 }
 
+void VKGraphicsPipeline::CreateGraphicsPipelineAsync(
+    const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, VkPipelineCache pipelineCache)
+{
+    /* Copy descriptor for the worker thread (vkCreateGraphicsPipelines is thread-safe and the pipeline cache is internally synchronized) */
+    auto ownedDesc = std::make_shared<GraphicsPipelineDescriptor>(desc);
+
+    createTask_ = TaskQueue::Get().Enqueue(
+        [this, ownedDesc, limits, extent, pipelineCache]()
+        {
+            CreateGraphicsPipeline(*ownedDesc, limits, extent, pipelineCache);
+        }
+    );
+}
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,7 @@
 #include <LLGL/GraphicsPipeline.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include <future>
 
 
 namespace LLGL
@@ -23,10 +24,13 @@ struct VKGraphicsPipelineLimits
 {
     float lineWidthRange[2];
     float lineWidthGranularity;
+    bool  dynamicShadingRate        = false;    // Pipelines are created with dynamic fragment shading rate (VK_KHR_fragment_shading_rate)
+    bool  conservativeRasterization = false;    // Pipelines can enable conservative rasterization (VK_EXT_conservative_rasterization)
 };
 
 struct GraphicsPipelineDescriptor;
 class VKShaderProgram;
+class VKPipelineLayout;
 
 class VKGraphicsPipeline final : public GraphicsPipeline
 {
@@ -34,15 +38,15 @@ class VKGraphicsPipeline final : public GraphicsPipeline
     public:
 
         VKGraphicsPipeline(
-            const VKPtr<VkDevice>& device, VkRenderPass renderPass, VkPipelineLayout defaultPipelineLayout,
-            const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent
+            const VKPtr<VkDevice>& device, VkRenderPass renderPass, VkPipelineLayout defaultPipelineLayout, VkPipelineCache pipelineCache,
+            const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, bool async = false
         );
+        ~VKGraphicsPipeline();
 
-        // Returns the VkPipeline Vulkan object.
-        inline VkPipeline GetVkPipeline() const
-        {
-            return pipeline_.Get();
-        }
+        bool IsReady() const override;
+
+        // Returns the VkPipeline Vulkan object. This waits until the pipeline has been created if it was created asynchronously.
+        VkPipeline GetVkPipeline() const;
 
         // Returns the VkPipelineLayout Vulkan object.
         inline VkPipelineLayout GetVkPipelineLayout() const
@@ -50,6 +54,18 @@ class VKGraphicsPipeline final : public GraphicsPipeline
             return pipelineLayout_;
         }
 
+        // Returns the pipeline layout this pipeline has been created with, or null if it uses the default pipeline layout.
+        inline const VKPipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayoutVK_;
+        }
+
+        // Returns the shader stages of the push constant range from the pipeline layout.
+        inline VkShaderStageFlags GetConstantsStageFlags() const
+        {
+            return constantsStages_;
+        }
+
         // Returns true if scissors are enabled.
         inline bool IsScissorEnabled() const
         {
@@ -62,17 +78,34 @@ class VKGraphicsPipeline final : public GraphicsPipeline
             return hasDynamicScissor_;
         }
 
+        // Returns true if this graphics pipeline has dynamic viewport state enabled (allows 'vkCmdSetViewport' commands).
+        inline bool HasDynamicViewport() const
+        {
+            return hasDynamicViewport_;
+        }
+
     private:
 
-        void CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent);
+        void CreateGraphicsPipeline(
+            const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, VkPipelineCache pipelineCache
+        );
+
+        void CreateGraphicsPipelineAsync(
+            const GraphicsPipelineDescriptor& desc, const VKGraphicsPipelineLimits& limits, const VkExtent2D& extent, VkPipelineCache pipelineCache
+        );
+
+        VkDevice                device_             = VK_NULL_HANDLE;
+        VkRenderPass            renderPass_         = VK_NULL_HANDLE;
+        VkPipelineLayout        pipelineLayout_     = VK_NULL_HANDLE;
+        const VKPipelineLayout* pipelineLayoutVK_   = nullptr;
+        VkShaderStageFlags      constantsStages_    = 0;
+        VKPtr<VkPipeline>       pipeline_;
 
-        VkDevice            device_             = VK_NULL_HANDLE;
-        VkRenderPass        renderPass_         = VK_NULL_HANDLE;
-        VkPipelineLayout    pipelineLayout_     = VK_NULL_HANDLE;
-        VKPtr<VkPipeline>   pipeline_;
+        bool                    scissorEnabled_     = false;
+        bool                    hasDynamicScissor_  = false;
+        bool                    hasDynamicViewport_ = false;
 
-        bool                scissorEnabled_     = false;
-        bool                hasDynamicScissor_  = false;
+        std::shared_future<void> createTask_;
 
 };
 
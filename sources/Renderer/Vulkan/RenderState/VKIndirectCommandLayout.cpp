@@ -0,0 +1,28 @@
+/*
+ * VKIndirectCommandLayout.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKIndirectCommandLayout.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+VKIndirectCommandLayout::VKIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc) :
+    IndirectCommandLayout { desc }
+{
+    if (desc.arguments.size() > 1)
+        throw std::runtime_error("Vulkan indirect command layouts cannot change vertex buffers or constants per draw");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
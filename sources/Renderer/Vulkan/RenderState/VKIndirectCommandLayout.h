@@ -0,0 +1,40 @@
+/*
+ * VKIndirectCommandLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_INDIRECT_COMMAND_LAYOUT_H
+#define LLGL_VK_INDIRECT_COMMAND_LAYOUT_H
+
+
+#include <LLGL/IndirectCommandLayout.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Indirect command layout that is emulated with regular indirect draw commands.
+Since device generated commands (VK_NV_device_generated_commands) are not supported, only layouts with a single draw argument can be created.
+*/
+class VKIndirectCommandLayout final : public IndirectCommandLayout
+{
+
+    public:
+
+        VKIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc);
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
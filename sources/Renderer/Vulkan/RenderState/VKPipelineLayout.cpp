@@ -8,6 +8,10 @@
 #include "VKPipelineLayout.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
+#include "../VKContainers.h"
+#include "../../../Core/Helper.h"
+#include "../Ext/VKExtensions.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -31,6 +35,12 @@ static VkShaderStageFlags GetVkShaderStageFlags(long flags)
         bitmask |= VK_SHADER_STAGE_FRAGMENT_BIT;
     if ((flags & StageFlags::ComputeStage) != 0)
         bitmask |= VK_SHADER_STAGE_COMPUTE_BIT;
+    #ifdef VK_EXT_mesh_shader
+    if ((flags & StageFlags::AmplificationStage) != 0)
+        bitmask |= VK_SHADER_STAGE_TASK_BIT_EXT;
+    if ((flags & StageFlags::MeshStage) != 0)
+        bitmask |= VK_SHADER_STAGE_MESH_BIT_EXT;
+    #endif
 
     return bitmask;
 }
@@ -38,15 +48,33 @@ static VkShaderStageFlags GetVkShaderStageFlags(long flags)
 //TODO:
 // looks like 'VkDescriptorSetLayoutBinding::descriptorCount' can only be greater than 1
 // for arrays in a shader (e.g. array of uniform buffers), but not for multiple binding points.
+// Returns the Vulkan descriptor type for the specified binding, which depends on its flags for dynamic offsets.
+static VkDescriptorType GetVkDescriptorType(const BindingDescriptor& binding)
+{
+    if (binding.type == ResourceType::ConstantBuffer && (binding.flags & BindingFlags::DynamicOffset) != 0)
+        return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    else
+        return VKTypes::Map(binding.type);
+}
+
 static void Convert(VkDescriptorSetLayoutBinding& dst, const BindingDescriptor& src)
 {
     dst.binding             = src.slot;
-    dst.descriptorType      = VKTypes::Map(src.type);
+    dst.descriptorType      = GetVkDescriptorType(src);
     dst.descriptorCount     = src.arraySize;
     dst.stageFlags          = GetVkShaderStageFlags(src.stageFlags);
     dst.pImmutableSamplers  = nullptr;
 }
 
+static void Convert(VkDescriptorSetLayoutBinding& dst, const StaticSamplerDescriptor& src, const VkSampler& sampler)
+{
+    dst.binding             = src.slot;
+    dst.descriptorType      = VK_DESCRIPTOR_TYPE_SAMPLER;
+    dst.descriptorCount     = 1;
+    dst.stageFlags          = GetVkShaderStageFlags(src.stageFlags);
+    dst.pImmutableSamplers  = &sampler;
+}
+
 /*static void Convert(VkDescriptorPoolSize& dst, const BindingDescriptor& src)
 {
     dst.type            = VKTypes::Map(src.type);
@@ -58,18 +86,27 @@ TODO:
 maybe move the VkPipelineLayout object into "VKGraphicsPipeline",
 in this case the "PipelineLayout" interface might need a renaming
 */
-VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc) :
-    device_              { device                               },
-    pipelineLayout_      { device, vkDestroyPipelineLayout      },
-    descriptorSetLayout_ { device, vkDestroyDescriptorSetLayout }
+VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc, bool useUpdateTemplate) :
+    device_                 { device                                        },
+    pipelineLayout_         { device, vkDestroyPipelineLayout               },
+    descriptorSetLayout_    { device, vkDestroyDescriptorSetLayout          }
+    #ifdef VK_KHR_descriptor_update_template
+    ,updateTemplate_        { device, vkDestroyDescriptorUpdateTemplateKHR  }
+    #endif
 {
     /* Initialize all descriptor-set layout bindings */
     const auto numBindings = desc.bindings.size();
-    std::vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings);
+    std::vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings + desc.staticSamplers.size());
 
     for (std::size_t i = 0; i < numBindings; ++i)
         Convert(layoutBindings[i], desc.bindings[i]);
 
+    /* Append immutable samplers after all other bindings, so they don't need any descriptor writes in the resource heaps */
+    CreateStaticSamplers(device, desc.staticSamplers);
+
+    for (std::size_t i = 0; i < desc.staticSamplers.size(); ++i)
+        Convert(layoutBindings[numBindings + i], desc.staticSamplers[i], staticSamplerHandles_[i]);
+
     /* Create descriptor set layout */
     VkDescriptorSetLayoutCreateInfo descSetCreateInfo;
     {
@@ -79,12 +116,23 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
         descSetCreateInfo.bindingCount  = static_cast<std::uint32_t>(layoutBindings.size());
         descSetCreateInfo.pBindings     = layoutBindings.data();
     }
-    auto result = vkCreateDescriptorSetLayout(device, &descSetCreateInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
+    auto result = vkCreateDescriptorSetLayout(device, &descSetCreateInfo, VKGetAllocationCallbacks(), descriptorSetLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout");
 
     /* Create pipeline layout */
     VkDescriptorSetLayout setLayouts[] = { descriptorSetLayout_.Get() };
 
+    /* Declare constants as one push constant range */
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = GetVkShaderStageFlags(desc.constants.stageFlags);
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = desc.constants.size;
+    }
+
+    if (desc.constants.size > 0)
+        constantsStageFlags_ = pushConstantRange.stageFlags;
+
     VkPipelineLayoutCreateInfo layoutCreateInfo;
     {
         layoutCreateInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -92,16 +140,84 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
         layoutCreateInfo.flags                  = 0;
         layoutCreateInfo.setLayoutCount         = 1;
         layoutCreateInfo.pSetLayouts            = setLayouts;
-        layoutCreateInfo.pushConstantRangeCount = 0;
-        layoutCreateInfo.pPushConstantRanges    = nullptr;
+        layoutCreateInfo.pushConstantRangeCount = (desc.constants.size > 0 ? 1u : 0u);
+        layoutCreateInfo.pPushConstantRanges    = (desc.constants.size > 0 ? &pushConstantRange : nullptr);
     }
-    result = vkCreatePipelineLayout(device, &layoutCreateInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
+    result = vkCreatePipelineLayout(device, &layoutCreateInfo, VKGetAllocationCallbacks(), pipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan pipeline layout");
 
     /* Create list of binding points (for later pass to 'VkWriteDescriptorSet::dstBinding') */
     bindings_.reserve(numBindings);
     for (const auto& binding : desc.bindings)
-        bindings_.push_back({ binding.slot, VKTypes::Map(binding.type) });
+    {
+        const auto numResourceViews = ((binding.flags & BindingFlags::Bindless) != 0 ? std::max(binding.arraySize, 1u) : 1u);
+        bindings_.push_back({ binding.slot, GetVkDescriptorType(binding), numResourceViews, binding.dynamicRangeSize });
+        numResourceViews_ += numResourceViews;
+    }
+
+    /* Create descriptor update template to write all descriptors of a resource heap at once */
+    if (useUpdateTemplate && !bindings_.empty())
+        CreateDescriptorUpdateTemplate();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKPipelineLayout::CreateStaticSamplers(const VKPtr<VkDevice>& device, const std::vector<StaticSamplerDescriptor>& staticSamplers)
+{
+    staticSamplers_.reserve(staticSamplers.size());
+    staticSamplerHandles_.reserve(staticSamplers.size());
+
+    for (const auto& staticSampler : staticSamplers)
+    {
+        staticSamplers_.emplace_back(MakeUnique<VKSampler>(device, staticSampler.sampler));
+        staticSamplerHandles_.push_back(staticSamplers_.back()->GetVkSampler());
+    }
+}
+
+void VKPipelineLayout::CreateDescriptorUpdateTemplate()
+{
+    #ifdef VK_KHR_descriptor_update_template
+
+    /* Each binding reads its resource views from consecutive 'VKDescriptorInfo' entries */
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> entries(bindings_.size());
+
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < bindings_.size(); ++i)
+    {
+        auto& entry = entries[i];
+        {
+            entry.dstBinding        = bindings_[i].dstBinding;
+            entry.dstArrayElement   = 0;
+            entry.descriptorCount   = bindings_[i].numResourceViews;
+            entry.descriptorType    = bindings_[i].descriptorType;
+            entry.offset            = offset;
+            entry.stride            = sizeof(VKDescriptorInfo);
+        }
+        offset += sizeof(VKDescriptorInfo) * bindings_[i].numResourceViews;
+    }
+
+    /* Create descriptor update template for the descriptor set layout */
+    VkDescriptorUpdateTemplateCreateInfoKHR createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.descriptorUpdateEntryCount   = static_cast<std::uint32_t>(entries.size());
+        createInfo.pDescriptorUpdateEntries     = entries.data();
+        createInfo.templateType                 = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+        createInfo.descriptorSetLayout          = descriptorSetLayout_.Get();
+        createInfo.pipelineBindPoint            = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        createInfo.pipelineLayout               = VK_NULL_HANDLE;
+        createInfo.set                          = 0;
+    }
+    auto result = vkCreateDescriptorUpdateTemplateKHR(device_, &createInfo, VKGetAllocationCallbacks(), updateTemplate_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor update template");
+
+    #endif // /VK_KHR_descriptor_update_template
 }
 
 
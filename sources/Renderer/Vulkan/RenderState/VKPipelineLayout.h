@@ -13,7 +13,9 @@
 #include <LLGL/PipelineLayoutFlags.h>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include "../Texture/VKSampler.h"
 #include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -24,6 +26,8 @@ struct VKLayoutBinding
 {
     std::uint32_t       dstBinding;
     VkDescriptorType    descriptorType;
+    std::uint32_t       numResourceViews;   // Number of resource views for this binding (array size for bindless bindings, otherwise 1)
+    std::uint32_t       dynamicRangeSize;   // Buffer range for descriptors of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
 };
 
 class VKPipelineLayout final : public PipelineLayout
@@ -31,7 +35,7 @@ class VKPipelineLayout final : public PipelineLayout
 
     public:
 
-        VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc);
+        VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc, bool useUpdateTemplate = false);
 
         inline VkPipelineLayout GetVkPipelineLayout() const
         {
@@ -49,13 +53,56 @@ class VKPipelineLayout final : public PipelineLayout
             return bindings_;
         }
 
+        // Returns the shader stages of the push constant range, or 0 if this layout has no constants.
+        inline VkShaderStageFlags GetConstantsStageFlags() const
+        {
+            return constantsStageFlags_;
+        }
+
+        // Returns the total number of resource views of all bindings.
+        inline std::uint32_t GetNumResourceViews() const
+        {
+            return numResourceViews_;
+        }
+
+        // Returns the total number of descriptors of the descriptor set layout, i.e. all resource views and immutable samplers.
+        inline std::uint32_t GetNumDescriptors() const
+        {
+            return (numResourceViews_ + static_cast<std::uint32_t>(staticSamplers_.size()));
+        }
+
+        #ifdef VK_KHR_descriptor_update_template
+
+        // Returns the descriptor update template, which reads one 'VKDescriptorInfo' entry per resource view, or VK_NULL_HANDLE if templates are not supported.
+        inline VkDescriptorUpdateTemplateKHR GetVkDescriptorUpdateTemplate() const
+        {
+            return updateTemplate_.Get();
+        }
+
+        #endif
+
+    private:
+
+        void CreateStaticSamplers(const VKPtr<VkDevice>& device, const std::vector<StaticSamplerDescriptor>& staticSamplers);
+        void CreateDescriptorUpdateTemplate();
+
     private:
 
         VkDevice                        device_                 = VK_NULL_HANDLE;
+
+        std::vector<std::unique_ptr<VKSampler>> staticSamplers_;        // Immutable samplers, declared before the layouts so they outlive them
+        std::vector<VkSampler>                  staticSamplerHandles_;  // Native handles of the immutable samplers for 'pImmutableSamplers'
+
         VKPtr<VkPipelineLayout>         pipelineLayout_;
         VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
 
         std::vector<VKLayoutBinding>    bindings_;
+        std::uint32_t                   numResourceViews_       = 0;
+        VkShaderStageFlags              constantsStageFlags_    = 0;
+
+        #ifdef VK_KHR_descriptor_update_template
+        VKPtr<VkDescriptorUpdateTemplateKHR> updateTemplate_;
+        #endif
 
 };
 
@@ -50,7 +50,7 @@ VKQuery::VKQuery(const VKPtr<VkDevice>& device, const QueryDescriptor& desc) :
         createInfo.queryCount           = 1;
         createInfo.pipelineStatistics   = GetPipelineStatisticsFlags(desc);
     }
-    auto result = vkCreateQueryPool(device, &createInfo, nullptr, queryPool_.ReleaseAndGetAddressOf());
+    auto result = vkCreateQueryPool(device, &createInfo, VKGetAllocationCallbacks(), queryPool_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan query pool");
 }
 
@@ -0,0 +1,56 @@
+/*
+ * VKQueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKQueryHeap.h"
+#include "../VKCore.h"
+#include "../VKTypes.h"
+#include "../VKStagingRing.h"
+
+
+namespace LLGL
+{
+
+
+VKQueryHeap::VKQueryHeap(const VKPtr<VkDevice>& device, VKStagingRing& stagingRing, const QueryHeapDescriptor& desc) :
+    QueryHeap    { desc                       },
+    stagingRing_ { stagingRing                },
+    queryPool_   { device, vkDestroyQueryPool }
+{
+    /* Create query pool object with all queries of the heap */
+    VkQueryPoolCreateInfo createInfo;
+    {
+        createInfo.sType                = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.queryType            = VKTypes::Map(desc.type);
+        createInfo.queryCount           = desc.numQueries;
+        createInfo.pipelineStatistics   = 0;
+    }
+    auto result = vkCreateQueryPool(device, &createInfo, VKGetAllocationCallbacks(), queryPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan query pool");
+
+    /* Queries must be reset before their first use */
+    ResetQueries(0, desc.numQueries);
+}
+
+void VKQueryHeap::ResetQueries(std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    vkCmdResetQueryPool(stagingRing_.GetCommandBuffer(), queryPool_, firstQuery, numQueries);
+}
+
+VkQueryControlFlags VKQueryHeap::GetControlFlags() const
+{
+    /* Only 'SamplesPassed' requires the exact number of samples */
+    return (GetType() == QueryType::SamplesPassed ? VK_QUERY_CONTROL_PRECISE_BIT : 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
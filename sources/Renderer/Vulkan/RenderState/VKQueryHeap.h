@@ -0,0 +1,57 @@
+/*
+ * VKQueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_QUERY_HEAP_H
+#define LLGL_VK_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+
+
+namespace LLGL
+{
+
+
+class VKStagingRing;
+
+class VKQueryHeap final : public QueryHeap
+{
+
+    public:
+
+        VKQueryHeap(const VKPtr<VkDevice>& device, VKStagingRing& stagingRing, const QueryHeapDescriptor& desc);
+
+        // Records a reset of the specified range of queries into the staging ring, which is submitted before the next frame.
+        void ResetQueries(std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        // Returns the query control flags for vkCmdBeginQuery.
+        VkQueryControlFlags GetControlFlags() const;
+
+        // Returns the Vulkan VkQueryPool object.
+        inline VkQueryPool GetVkQueryPool() const
+        {
+            return queryPool_.Get();
+        }
+
+    private:
+
+        VKStagingRing&      stagingRing_;
+        VKPtr<VkQueryPool>  queryPool_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
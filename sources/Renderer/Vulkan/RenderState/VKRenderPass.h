@@ -0,0 +1,29 @@
+/*
+ * VKRenderPass.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_RENDER_PASS_H
+#define LLGL_VK_RENDER_PASS_H
+
+
+#include "../../BasicRenderPass.h"
+
+
+namespace LLGL
+{
+
+
+using VKRenderPass = BasicRenderPass;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,297 @@
+/*
+ * VKRenderPassCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKRenderPassCache.h"
+#include "../VKCore.h"
+#include <LLGL/CommandBufferFlags.h>
+
+
+namespace LLGL
+{
+
+
+VKRenderPassCache::VKRenderPassCache(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+static const AttachmentOpsDescriptor& GetColorOps(const RenderPassDescriptor& desc, std::size_t colorAttachment)
+{
+    static const AttachmentOpsDescriptor defaultOps;
+    return (colorAttachment < desc.colorAttachments.size() ? desc.colorAttachments[colorAttachment] : defaultOps);
+}
+
+static void AppendOpsSignature(std::vector<std::uint32_t>& signature, const AttachmentOpsDescriptor& ops)
+{
+    signature.push_back(static_cast<std::uint32_t>(ops.loadOp));
+    signature.push_back(static_cast<std::uint32_t>(ops.storeOp));
+}
+
+// Returns the signature of the framebuffer layout and the attachment operations; color attachments that are not specified use the default operations.
+static std::vector<std::uint32_t> GetRenderPassSignature(const VKRenderPassLayout& layout, const RenderPassDescriptor& desc)
+{
+    std::vector<std::uint32_t> signature;
+    signature.reserve(6 + layout.colorFormats.size() * 3 + 4);
+
+    signature.push_back(static_cast<std::uint32_t>(layout.colorFormats.size()));
+    signature.push_back(static_cast<std::uint32_t>(layout.colorFinalLayout));
+    signature.push_back(static_cast<std::uint32_t>(layout.depthStencilFormat));
+    signature.push_back(static_cast<std::uint32_t>(layout.depthStencilFinalLayout));
+    signature.push_back(static_cast<std::uint32_t>(layout.samples));
+    signature.push_back(layout.viewMask);
+
+    for (std::size_t i = 0; i < layout.colorFormats.size(); ++i)
+    {
+        signature.push_back(static_cast<std::uint32_t>(layout.colorFormats[i]));
+        AppendOpsSignature(signature, GetColorOps(desc, i));
+    }
+
+    /* Operations of the depth-stencil attachment are irrelevant if the layout has none */
+    if (layout.depthStencilFormat != VK_FORMAT_UNDEFINED)
+    {
+        AppendOpsSignature(signature, desc.depthAttachment);
+        AppendOpsSignature(signature, desc.stencilAttachment);
+    }
+
+    return signature;
+}
+
+VkRenderPass VKRenderPassCache::Get(const VKRenderPassLayout& layout, const RenderPassDescriptor& desc)
+{
+    auto signature = GetRenderPassSignature(layout, desc);
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Find render pass with equal framebuffer layout and operations for all attachments */
+    auto it = renderPasses_.find(signature);
+    if (it != renderPasses_.end())
+        return it->second.Get();
+
+    /* Create new render pass and only insert it into the cache on success */
+    VKPtr<VkRenderPass> renderPass { device_, vkDestroyRenderPass };
+    CreateVkRenderPass(layout, desc, renderPass);
+
+    it = renderPasses_.emplace(std::move(signature), std::move(renderPass)).first;
+    return it->second.Get();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static VkAttachmentLoadOp GetVkLoadOp(const AttachmentLoadOp loadOp)
+{
+    switch (loadOp)
+    {
+        case AttachmentLoadOp::Undefined:   return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        case AttachmentLoadOp::Load:        return VK_ATTACHMENT_LOAD_OP_LOAD;
+        case AttachmentLoadOp::Clear:       return VK_ATTACHMENT_LOAD_OP_CLEAR;
+    }
+    return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+}
+
+static VkAttachmentStoreOp GetVkStoreOp(const AttachmentStoreOp storeOp)
+{
+    switch (storeOp)
+    {
+        case AttachmentStoreOp::Undefined:  return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        case AttachmentStoreOp::Store:      return VK_ATTACHMENT_STORE_OP_STORE;
+    }
+    return VK_ATTACHMENT_STORE_OP_STORE;
+}
+
+void VKRenderPassCache::CreateVkRenderPass(const VKRenderPassLayout& layout, const RenderPassDescriptor& desc, VKPtr<VkRenderPass>& renderPass)
+{
+    const auto numColorAttachments  = static_cast<std::uint32_t>(layout.colorFormats.size());
+    const bool hasDepthStencil      = (layout.depthStencilFormat != VK_FORMAT_UNDEFINED);
+    const auto numAttachments       = numColorAttachments + (hasDepthStencil ? 1u : 0u);
+
+    /* Initialize attachment descriptors: color attachments first, then the depth-stencil attachment */
+    std::vector<VkAttachmentDescription> attachmentDescs(numAttachments);
+    std::vector<VkAttachmentReference> attachmentRefs(numAttachments);
+
+    for (std::uint32_t i = 0; i < numColorAttachments; ++i)
+    {
+        const auto& ops = GetColorOps(desc, i);
+
+        /* The previous image layout is only required if the previous content is loaded */
+        auto& attachmentDesc = attachmentDescs[i];
+        {
+            attachmentDesc.flags            = 0;
+            attachmentDesc.format           = layout.colorFormats[i];
+            attachmentDesc.samples          = layout.samples;
+            attachmentDesc.loadOp           = GetVkLoadOp(ops.loadOp);
+            attachmentDesc.storeOp          = GetVkStoreOp(ops.storeOp);
+            attachmentDesc.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachmentDesc.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachmentDesc.initialLayout    = (ops.loadOp == AttachmentLoadOp::Load ? layout.colorFinalLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+            attachmentDesc.finalLayout      = layout.colorFinalLayout;
+        }
+        auto& attachmentRef = attachmentRefs[i];
+        {
+            attachmentRef.attachment        = i;
+            attachmentRef.layout            = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+    }
+
+    if (hasDepthStencil)
+    {
+        const bool loadDepthStencil = (desc.depthAttachment.loadOp == AttachmentLoadOp::Load || desc.stencilAttachment.loadOp == AttachmentLoadOp::Load);
+
+        auto& attachmentDesc = attachmentDescs[numColorAttachments];
+        {
+            attachmentDesc.flags            = 0;
+            attachmentDesc.format           = layout.depthStencilFormat;
+            attachmentDesc.samples          = layout.samples;
+            attachmentDesc.loadOp           = GetVkLoadOp(desc.depthAttachment.loadOp);
+            attachmentDesc.storeOp          = GetVkStoreOp(desc.depthAttachment.storeOp);
+            attachmentDesc.stencilLoadOp    = GetVkLoadOp(desc.stencilAttachment.loadOp);
+            attachmentDesc.stencilStoreOp   = GetVkStoreOp(desc.stencilAttachment.storeOp);
+            attachmentDesc.initialLayout    = (loadDepthStencil ? layout.depthStencilFinalLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+            attachmentDesc.finalLayout      = layout.depthStencilFinalLayout;
+        }
+        auto& attachmentRef = attachmentRefs[numColorAttachments];
+        {
+            attachmentRef.attachment        = numColorAttachments;
+            attachmentRef.layout            = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+    }
+
+    /* Initialize sub-pass descriptor */
+    VkSubpassDescription subpassDesc;
+    {
+        subpassDesc.flags                   = 0;
+        subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpassDesc.inputAttachmentCount    = 0;
+        subpassDesc.pInputAttachments       = nullptr;
+        subpassDesc.colorAttachmentCount    = numColorAttachments;
+        subpassDesc.pColorAttachments       = (numColorAttachments > 0 ? attachmentRefs.data() : nullptr);
+        subpassDesc.pResolveAttachments     = nullptr;
+        subpassDesc.pDepthStencilAttachment = (hasDepthStencil ? &(attachmentRefs[numColorAttachments]) : nullptr);
+        subpassDesc.preserveAttachmentCount = 0;
+        subpassDesc.pPreserveAttachments    = nullptr;
+    }
+
+    /* Initialize sub-pass dependencies */
+    const bool sampleDepthStencil = (hasDepthStencil && layout.depthStencilFinalLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    VkSubpassDependency subpassDeps[2];
+    std::uint32_t numSubpassDeps = 1;
+    {
+        subpassDeps[0].srcSubpass           = VK_SUBPASS_EXTERNAL;
+        subpassDeps[0].dstSubpass           = 0;
+        subpassDeps[0].srcStageMask         = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        subpassDeps[0].dstStageMask         = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        subpassDeps[0].srcAccessMask        = 0;
+        subpassDeps[0].dstAccessMask        = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        subpassDeps[0].dependencyFlags      = 0;
+    }
+
+    if (sampleDepthStencil)
+    {
+        /* Depth tests must wait until previous shader reads of the depth-stencil texture are done */
+        subpassDeps[0].srcStageMask         |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        subpassDeps[0].dstStageMask         |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        subpassDeps[0].dstAccessMask        |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        /* Shaders of subsequent commands must wait until depth writes are done, so they can sample the depth-stencil texture */
+        auto& subpassDep = subpassDeps[numSubpassDeps++];
+        {
+            subpassDep.srcSubpass           = 0;
+            subpassDep.dstSubpass           = VK_SUBPASS_EXTERNAL;
+            subpassDep.srcStageMask         = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            subpassDep.dstStageMask         = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            subpassDep.srcAccessMask        = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            subpassDep.dstAccessMask        = VK_ACCESS_SHADER_READ_BIT;
+            subpassDep.dependencyFlags      = 0;
+        }
+    }
+
+    /* Broadcast all draw commands to the views of the framebuffer for multiview rendering (VK_KHR_multiview) */
+    const void* createInfoNext = nullptr;
+
+    #ifdef VK_KHR_multiview
+    VkRenderPassMultiviewCreateInfoKHR multiviewInfo;
+    if (layout.viewMask != 0)
+    {
+        multiviewInfo.sType                 = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO_KHR;
+        multiviewInfo.pNext                 = nullptr;
+        multiviewInfo.subpassCount          = 1;
+        multiviewInfo.pViewMasks            = &(layout.viewMask);
+        multiviewInfo.dependencyCount       = 0;
+        multiviewInfo.pViewOffsets          = nullptr;
+        multiviewInfo.correlationMaskCount  = 1;
+        multiviewInfo.pCorrelationMasks     = &(layout.viewMask);
+        createInfoNext = &multiviewInfo;
+    }
+    #endif // /VK_KHR_multiview
+
+    /* Create render pass */
+    VkRenderPassCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        createInfo.pNext                    = createInfoNext;
+        createInfo.flags                    = 0;
+        createInfo.attachmentCount          = numAttachments;
+        createInfo.pAttachments             = attachmentDescs.data();
+        createInfo.subpassCount             = 1;
+        createInfo.pSubpasses               = (&subpassDesc);
+        createInfo.dependencyCount          = numSubpassDeps;
+        createInfo.pDependencies            = subpassDeps;
+    }
+    auto result = vkCreateRenderPass(device_, &createInfo, VKGetAllocationCallbacks(), renderPass.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan render pass");
+}
+
+
+/*
+ * VKRenderPassSet class
+ */
+
+void VKRenderPassSet::Reset(VKRenderPassCache& cache, const VKRenderPassLayout& layout, const RenderPassDescriptor& defaultDesc)
+{
+    cache_              = &cache;
+    layout_             = layout;
+    defaultDesc_        = defaultDesc;
+    defaultRenderPass_  = cache.Get(layout, defaultDesc);
+    resumeRenderPass_   = cache.Get(layout, RenderPassDescriptor{});
+}
+
+VkRenderPass VKRenderPassSet::Get(const RenderPass* renderPass)
+{
+    if (renderPass == nullptr)
+        return defaultRenderPass_;
+    return cache_->Get(layout_, renderPass->GetDesc());
+}
+
+VkRenderPass VKRenderPassSet::GetWithClear(long clearFlags)
+{
+    /* Replace the load operations of the default render pass for all selected attachments */
+    auto desc = defaultDesc_;
+
+    if ((clearFlags & ClearFlags::Color) != 0)
+    {
+        desc.colorAttachments.resize(layout_.colorFormats.size());
+        for (auto& ops : desc.colorAttachments)
+            ops.loadOp = AttachmentLoadOp::Clear;
+    }
+
+    if ((clearFlags & ClearFlags::Depth) != 0)
+        desc.depthAttachment.loadOp = AttachmentLoadOp::Clear;
+    if ((clearFlags & ClearFlags::Stencil) != 0)
+        desc.stencilAttachment.loadOp = AttachmentLoadOp::Clear;
+
+    return cache_->Get(layout_, desc);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
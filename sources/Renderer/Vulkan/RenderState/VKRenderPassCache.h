@@ -0,0 +1,117 @@
+/*
+ * VKRenderPassCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_RENDER_PASS_CACHE_H
+#define LLGL_VK_RENDER_PASS_CACHE_H
+
+
+#include <LLGL/RenderPass.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Attachment formats, sample count, final image layouts, and multiview mask of a framebuffer, for which the native render passes are created.
+struct VKRenderPassLayout
+{
+    std::vector<VkFormat>   colorFormats;
+    VkImageLayout           colorFinalLayout        = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    VkFormat                depthStencilFormat      = VK_FORMAT_UNDEFINED;
+    VkImageLayout           depthStencilFinalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL; // Shader-read layout if the depth-stencil attachment is sampled afterwards
+    VkSampleCountFlagBits   samples                 = VK_SAMPLE_COUNT_1_BIT;
+    std::uint32_t           viewMask                = 0; // Bit mask of views for multiview rendering, or 0 if multiview rendering is disabled
+};
+
+/*
+Device-wide cache of native render passes, keyed by the framebuffer layout and the load and store operations of all attachments.
+Render targets and render contexts with the same framebuffer layout share their render passes,
+so graphics pipelines that are created against any of them are created against the same native render pass.
+*/
+class VKRenderPassCache
+{
+
+    public:
+
+        VKRenderPassCache(const VKPtr<VkDevice>& device);
+
+        // Returns the native render pass for the specified framebuffer layout and attachment operations, and creates it on demand. This is thread safe.
+        VkRenderPass Get(const VKRenderPassLayout& layout, const RenderPassDescriptor& desc);
+
+    private:
+
+        void CreateVkRenderPass(const VKRenderPassLayout& layout, const RenderPassDescriptor& desc, VKPtr<VkRenderPass>& renderPass);
+
+        const VKPtr<VkDevice>&                                      device_;
+
+        std::mutex                                                  mutex_;
+        std::map<std::vector<std::uint32_t>, VKPtr<VkRenderPass>>   renderPasses_;  // Render passes by signature of framebuffer layout and attachment operations
+
+};
+
+/*
+Native render passes of a single framebuffer layout, i.e. of a render target or a render context.
+All these render passes are compatible to each other, i.e. they can all be used with the framebuffers of their render target (or render context).
+*/
+class VKRenderPassSet
+{
+
+    public:
+
+        // Stores the framebuffer layout and looks up the default and resume render passes in the specified cache.
+        void Reset(VKRenderPassCache& cache, const VKRenderPassLayout& layout, const RenderPassDescriptor& defaultDesc);
+
+        // Returns the native render pass for the specified render pass, or the default render pass if 'renderPass' is null.
+        VkRenderPass Get(const RenderPass* renderPass);
+
+        // Returns the native render pass with the operations of the default render pass, except that the attachments selected by 'clearFlags' are cleared.
+        VkRenderPass GetWithClear(long clearFlags);
+
+        // Returns the native render pass that is used when no RenderPass object is specified (e.g. for SetRenderTarget).
+        inline VkRenderPass GetDefault() const
+        {
+            return defaultRenderPass_;
+        }
+
+        // Returns the native render pass that loads and stores all attachments, which is used to resume an interrupted render pass.
+        inline VkRenderPass GetResume() const
+        {
+            return resumeRenderPass_;
+        }
+
+        // Returns the framebuffer layout of all render passes in this set.
+        inline const VKRenderPassLayout& GetLayout() const
+        {
+            return layout_;
+        }
+
+    private:
+
+        VKRenderPassCache*      cache_              = nullptr;
+        VKRenderPassLayout      layout_;
+        RenderPassDescriptor    defaultDesc_;
+
+        VkRenderPass            defaultRenderPass_  = VK_NULL_HANDLE;
+        VkRenderPass            resumeRenderPass_   = VK_NULL_HANDLE;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
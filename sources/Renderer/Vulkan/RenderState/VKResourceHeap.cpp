@@ -7,24 +7,25 @@
 
 #include "VKResourceHeap.h"
 #include "VKPipelineLayout.h"
+#include "VKAccelerationStructure.h"
 #include "../Buffer/VKBuffer.h"
 #include "../Texture/VKSampler.h"
 #include "../Texture/VKTexture.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
 #include "../VKContainers.h"
+#include "../Ext/VKExtensions.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
-#include <map>
 
 
 namespace LLGL
 {
 
 
-VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc) :
-    device_         { device                          },
-    descriptorPool_ { device, vkDestroyDescriptorPool }
+VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, VKDescriptorSetAllocator& descriptorSetAllocator, const ResourceHeapDescriptor& desc) :
+    device_                 { device                 },
+    descriptorSetAllocator_ { descriptorSetAllocator }
 {
     /* Get pipeline layout object */
     auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
@@ -34,28 +35,45 @@ VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeap
     pipelineLayout_ = pipelineLayoutVK->GetVkPipelineLayout();
 
     /* Validate binding descriptors */
-    const auto& bindings = pipelineLayoutVK->GetBindings();
-    if (desc.resourceViews.size() != bindings.size())
+    if (desc.resourceViews.size() != pipelineLayoutVK->GetNumResourceViews())
         throw std::invalid_argument("failed to create resource vied heap due to mismatch between number of resources and bindings");
 
-    /* Create resource descriptor pool */
-    CreateDescriptorPool(desc, bindings);
+    bindings_           = pipelineLayoutVK->GetBindings();
+    numResourceViews_   = desc.resourceViews.size();
 
-    /* Create resource descriptor set for pipeline layout */
-    VkDescriptorSetLayout setLayouts[] = { pipelineLayoutVK->GetVkDescriptorSetLayout() };
-    CreateDescriptorSets(1, setLayouts);
+    /* Allocate resource descriptor set for pipeline layout from the shared descriptor pools */
+    allocation_ = descriptorSetAllocator_.Allocate(pipelineLayoutVK->GetVkDescriptorSetLayout(), pipelineLayoutVK->GetNumDescriptors());
 
-    /* Update write descriptors in descriptor set */
-    UpdateDescriptorSets(desc, bindings);
+    /* Update write descriptors in descriptor set (and return the descriptor set to its pool on failure) */
+    try
+    {
+        #ifdef VK_KHR_descriptor_update_template
+        if (pipelineLayoutVK->GetVkDescriptorUpdateTemplate() != VK_NULL_HANDLE)
+            UpdateDescriptorSetWithTemplate(desc, *pipelineLayoutVK);
+        else
+        #endif
+            UpdateDescriptorSets(desc.resourceViews.data(), 0, numResourceViews_);
+    }
+    catch (...)
+    {
+        descriptorSetAllocator_.Free(allocation_);
+        throw;
+    }
 }
 
 VKResourceHeap::~VKResourceHeap()
 {
-    //INFO: is automatically deleted when pool is deleted
-    #if 0
-    auto result = vkFreeDescriptorSets(device_, descriptorPool_, 1, &descriptorSet_);
-    VKThrowIfFailed(result, "failed to release Vulkan descriptor sets");
-    #endif
+    /* Return descriptor set to its pool (the render system defers releasing resource heaps until the GPU no longer uses them) */
+    descriptorSetAllocator_.Free(allocation_);
+}
+
+void VKResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    if (static_cast<std::size_t>(firstDescriptor) + numResourceViews > numResourceViews_)
+        throw std::out_of_range("resource views out of range for resource heap update");
+
+    /* Overwrite only the affected descriptors; the descriptor set must not be in use by any pending command buffer */
+    UpdateDescriptorSets(resourceViews, firstDescriptor, numResourceViews);
 }
 
 
@@ -63,119 +81,105 @@ VKResourceHeap::~VKResourceHeap()
  * ======= Private: =======
  */
 
-static std::uint32_t AccumDescriptorPoolSizes(
-    VkDescriptorType type,
-    std::vector<VkDescriptorPoolSize>::iterator it,
-    std::vector<VkDescriptorPoolSize>::iterator itEnd)
-{
-    std::uint32_t descriptorCount = it->descriptorCount;
-
-    for (++it; it != itEnd; ++it)
-    {
-        if (it->type == type)
-        {
-            descriptorCount += it->descriptorCount;
-            it->descriptorCount = 0;
-        }
-    }
-
-    return descriptorCount;
-}
-
-static void CompressDescriptorPoolSizes(std::vector<VkDescriptorPoolSize>& poolSizes)
+static void ThrowInvalidDescriptorType(VkDescriptorType descriptorType)
 {
-    /* Accumulate all descriptors of the same type */
-    for (auto it = poolSizes.begin(); it != poolSizes.end(); ++it)
-        it->descriptorCount = AccumDescriptorPoolSizes(it->type, it, poolSizes.end());
-
-    /* Remove all remaining pool sizes with zero descriptors */
-    RemoveAllFromListIf(
-        poolSizes,
-        [](const VkDescriptorPoolSize& dps)
-        {
-            return (dps.descriptorCount == 0);
-        }
+    throw std::invalid_argument(
+        "invalid descriptor type to create ResourceHeap object: 0x" +
+        ToHex(static_cast<std::uint32_t>(descriptorType))
     );
 }
 
-void VKResourceHeap::CreateDescriptorPool(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings)
+static void GetDescriptorInfoForSampler(const ResourceViewDescriptor& resourceViewDesc, VkDescriptorImageInfo& imageInfo)
 {
-    /* Initialize descriptor pool sizes */
-    std::vector<VkDescriptorPoolSize> poolSizes(desc.resourceViews.size());
-    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
+    auto samplerVK = LLGL_CAST(VKSampler*, resourceViewDesc.resource);
     {
-        poolSizes[i].type               = bindings[i].descriptorType;
-        poolSizes[i].descriptorCount    = 1;
+        imageInfo.sampler       = samplerVK->GetVkSampler();
+        imageInfo.imageView     = VK_NULL_HANDLE;
+        imageInfo.imageLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
     }
+}
 
-    /* Compress pool sizes by merging equal types with accumulated number of descriptors */
-    CompressDescriptorPoolSizes(poolSizes);
-
-    /* Create descriptor pool */
-    VkDescriptorPoolCreateInfo poolCreateInfo;
+static void GetDescriptorInfoForTexture(const ResourceViewDescriptor& resourceViewDesc, VkDescriptorImageInfo& imageInfo)
+{
+    auto textureVK = LLGL_CAST(VKTexture*, resourceViewDesc.resource);
     {
-        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
-        poolCreateInfo.maxSets          = 1;
-        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
-        poolCreateInfo.pPoolSizes       = poolSizes.data();
+        imageInfo.sampler       = VK_NULL_HANDLE;
+        imageInfo.imageView     = textureVK->GetVkImageView();
+        imageInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
-    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, descriptorPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
 }
 
-void VKResourceHeap::CreateDescriptorSets(std::uint32_t numSetLayouts, const VkDescriptorSetLayout* setLayouts)
+static void GetDescriptorInfoForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VkDescriptorBufferInfo& bufferInfo)
 {
-    descriptorSets_.resize(1, VK_NULL_HANDLE);
-
-    /* Allocate descriptor set */
-    VkDescriptorSetAllocateInfo allocInfo;
+    auto bufferVK = LLGL_CAST(VKBuffer*, resourceViewDesc.resource);
     {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.descriptorPool        = descriptorPool_;
-        allocInfo.descriptorSetCount    = numSetLayouts;
-        allocInfo.pSetLayouts           = setLayouts;
+        bufferInfo.buffer   = bufferVK->GetVkBuffer();
+        bufferInfo.offset   = 0;
+
+        /* Buffers with a dynamic offset only expose the specified range, which is shifted by the offset at bind time */
+        if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+            bufferInfo.range = binding.dynamicRangeSize;
+        else
+            bufferInfo.range = bufferVK->GetSize();
     }
-    auto result = vkAllocateDescriptorSets(device_, &allocInfo, descriptorSets_.data());
-    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
 }
 
-void VKResourceHeap::UpdateDescriptorSets(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings)
+#ifdef VK_KHR_acceleration_structure
+
+static void GetDescriptorInfoForAccelerationStructure(const ResourceViewDescriptor& resourceViewDesc, VkAccelerationStructureKHR& accelerationStructure)
+{
+    auto accelerationStructureVK = LLGL_CAST(VKAccelerationStructure*, resourceViewDesc.resource);
+    accelerationStructure = accelerationStructureVK->GetVkAccelerationStructure();
+}
+
+#endif // /VK_KHR_acceleration_structure
+
+void VKResourceHeap::UpdateDescriptorSets(const ResourceViewDescriptor* resourceViews, std::size_t firstView, std::size_t numViews)
 {
     /* Allocate local storage for buffer and image descriptors */
-    const auto numResourceViewsMax = std::min(desc.resourceViews.size(), bindings.size());
+    VKWriteDescriptorContainer container { numViews };
 
-    VKWriteDescriptorContainer container { numResourceViewsMax };
+    /* Each array element of a bindless binding is written with its own write descriptor */
+    const auto endView = firstView + numViews;
+    std::size_t viewIndex = 0;
 
-    for (std::size_t i = 0; i < numResourceViewsMax; ++i)
+    for (const auto& binding : bindings_)
     {
-        /* Get resource view information */
-        const auto& rvDesc = desc.resourceViews[i];
-        auto descriptorType = bindings[i].descriptorType;
-
-        switch (descriptorType)
+        for (std::uint32_t arrayElement = 0; arrayElement < binding.numResourceViews; ++arrayElement, ++viewIndex)
         {
-            case VK_DESCRIPTOR_TYPE_SAMPLER:
-                FillWriteDescriptorForSampler(rvDesc, bindings[i], container);
-                break;
-
-            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-                FillWriteDescriptorForTexture(rvDesc, bindings[i], container);
-                break;
-
-            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-                FillWriteDescriptorForBuffer(rvDesc, bindings[i], container);
-                break;
-
-            default:
-                throw std::invalid_argument(
-                    "invalid descriptor type to create ResourceHeap object: 0x" +
-                    ToHex(static_cast<std::uint32_t>(descriptorType))
-                );
-                break;
+            /* Skip all resource views outside of the specified range */
+            if (viewIndex < firstView || viewIndex >= endView)
+                continue;
+
+            /* Get resource view information */
+            const auto& rvDesc = resourceViews[viewIndex - firstView];
+
+            switch (binding.descriptorType)
+            {
+                case VK_DESCRIPTOR_TYPE_SAMPLER:
+                    FillWriteDescriptorForSampler(rvDesc, binding, arrayElement, container);
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                    FillWriteDescriptorForTexture(rvDesc, binding, arrayElement, container);
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                    FillWriteDescriptorForBuffer(rvDesc, binding, arrayElement, container);
+                    break;
+
+                #ifdef VK_KHR_acceleration_structure
+                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                    FillWriteDescriptorForAccelerationStructure(rvDesc, binding, arrayElement, container);
+                    break;
+                #endif
+
+                default:
+                    ThrowInvalidDescriptorType(binding.descriptorType);
+                    break;
+            }
         }
     }
 
@@ -191,24 +195,73 @@ void VKResourceHeap::UpdateDescriptorSets(const ResourceHeapDescriptor& desc, co
     }
 }
 
-void VKResourceHeap::FillWriteDescriptorForSampler(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container)
+void VKResourceHeap::UpdateDescriptorSetWithTemplate(const ResourceHeapDescriptor& desc, const VKPipelineLayout& pipelineLayoutVK)
 {
-    auto samplerVK = LLGL_CAST(VKSampler*, resourceViewDesc.resource);
+    #ifdef VK_KHR_descriptor_update_template
 
-    /* Initialize image information */
-    auto imageInfo = container.NextImageInfo();
+    /* Write descriptor information of all resource views into one contiguous array, as expected by the update template */
+    auto descriptorInfos = descriptorSetAllocator_.GetDescriptorInfoScratch(desc.resourceViews.size());
+
+    std::size_t viewIndex = 0;
+
+    for (const auto& binding : pipelineLayoutVK.GetBindings())
     {
-        imageInfo->sampler          = samplerVK->GetVkSampler();
-        imageInfo->imageView        = VK_NULL_HANDLE;
-        imageInfo->imageLayout      = VK_IMAGE_LAYOUT_UNDEFINED;
+        for (std::uint32_t arrayElement = 0; arrayElement < binding.numResourceViews; ++arrayElement, ++viewIndex)
+        {
+            const auto& rvDesc = desc.resourceViews[viewIndex];
+
+            switch (binding.descriptorType)
+            {
+                case VK_DESCRIPTOR_TYPE_SAMPLER:
+                    GetDescriptorInfoForSampler(rvDesc, descriptorInfos[viewIndex].imageInfo);
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                    GetDescriptorInfoForTexture(rvDesc, descriptorInfos[viewIndex].imageInfo);
+                    break;
+
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                    GetDescriptorInfoForBuffer(rvDesc, binding, descriptorInfos[viewIndex].bufferInfo);
+                    break;
+
+                #ifdef VK_KHR_acceleration_structure
+                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                    GetDescriptorInfoForAccelerationStructure(rvDesc, descriptorInfos[viewIndex].accelerationStructure);
+                    break;
+                #endif
+
+                default:
+                    ThrowInvalidDescriptorType(binding.descriptorType);
+                    break;
+            }
+        }
     }
 
+    /* Update entire descriptor set with a single call */
+    vkUpdateDescriptorSetWithTemplateKHR(
+        device_,
+        allocation_.descriptorSet,
+        pipelineLayoutVK.GetVkDescriptorUpdateTemplate(),
+        descriptorInfos
+    );
+
+    #endif // /VK_KHR_descriptor_update_template
+}
+
+void VKResourceHeap::FillWriteDescriptorForSampler(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container)
+{
+    /* Initialize image information */
+    auto imageInfo = container.NextImageInfo();
+    GetDescriptorInfoForSampler(resourceViewDesc, *imageInfo);
+
     /* Initialize write descriptor */
     auto writeDesc = container.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[0];//numResourceViews];
+        writeDesc->dstSet           = allocation_.descriptorSet;
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -217,24 +270,18 @@ void VKResourceHeap::FillWriteDescriptorForSampler(const ResourceViewDescriptor&
     }
 }
 
-void VKResourceHeap::FillWriteDescriptorForTexture(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container)
+void VKResourceHeap::FillWriteDescriptorForTexture(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container)
 {
-    auto textureVK = LLGL_CAST(VKTexture*, resourceViewDesc.resource);
-
     /* Initialize image information */
     auto imageInfo = container.NextImageInfo();
-    {
-        imageInfo->sampler       = VK_NULL_HANDLE;
-        imageInfo->imageView     = textureVK->GetVkImageView();
-        imageInfo->imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    }
+    GetDescriptorInfoForTexture(resourceViewDesc, *imageInfo);
 
     /* Initialize write descriptor */
     auto writeDesc = container.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[0];//numResourceViews];
+        writeDesc->dstSet           = allocation_.descriptorSet;
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -243,32 +290,52 @@ void VKResourceHeap::FillWriteDescriptorForTexture(const ResourceViewDescriptor&
     }
 }
 
-void VKResourceHeap::FillWriteDescriptorForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container)
+void VKResourceHeap::FillWriteDescriptorForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container)
 {
-    auto bufferVK = LLGL_CAST(VKBuffer*, resourceViewDesc.resource);
-
     /* Initialize buffer information */
     auto bufferInfo = container.NextBufferInfo();
+    GetDescriptorInfoForBuffer(resourceViewDesc, binding, *bufferInfo);
+
+    /* Initialize write descriptor */
+    auto writeDesc = container.NextWriteDescriptor();
     {
-        bufferInfo->buffer    = bufferVK->GetVkBuffer();
-        bufferInfo->offset    = 0;
-        bufferInfo->range     = bufferVK->GetSize();
+        writeDesc->dstSet           = allocation_.descriptorSet;
+        writeDesc->dstBinding       = binding.dstBinding;
+        writeDesc->dstArrayElement  = arrayElement;
+        writeDesc->descriptorCount  = 1;
+        writeDesc->descriptorType   = binding.descriptorType;
+        writeDesc->pImageInfo       = nullptr;
+        writeDesc->pBufferInfo      = bufferInfo;
+        writeDesc->pTexelBufferView = nullptr;
     }
+}
+
+#ifdef VK_KHR_acceleration_structure
+
+void VKResourceHeap::FillWriteDescriptorForAccelerationStructure(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container)
+{
+    /* Initialize acceleration structure information, which is passed via the extension chain of the write descriptor */
+    VkAccelerationStructureKHR accelerationStructure = VK_NULL_HANDLE;
+    GetDescriptorInfoForAccelerationStructure(resourceViewDesc, accelerationStructure);
+    auto accelerationStructureInfo = container.NextAccelerationStructureInfo(accelerationStructure);
 
     /* Initialize write descriptor */
     auto writeDesc = container.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[0];//numResourceViews];
+        writeDesc->pNext            = accelerationStructureInfo;
+        writeDesc->dstSet           = allocation_.descriptorSet;
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = nullptr;
-        writeDesc->pBufferInfo      = bufferInfo;
+        writeDesc->pBufferInfo      = nullptr;
         writeDesc->pTexelBufferView = nullptr;
     }
 }
 
+#endif // /VK_KHR_acceleration_structure
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,8 @@
 #include <LLGL/ResourceHeap.h>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include "VKDescriptorSetAllocator.h"
+#include "VKPipelineLayout.h"
 #include <vector>
 
 
@@ -21,14 +23,13 @@ namespace LLGL
 
 class VKBuffer;
 struct VKWriteDescriptorContainer;
-struct VKLayoutBinding;
 
 class VKResourceHeap final : public ResourceHeap
 {
 
     public:
 
-        VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc);
+        VKResourceHeap(const VKPtr<VkDevice>& device, VKDescriptorSetAllocator& descriptorSetAllocator, const ResourceHeapDescriptor& desc);
         ~VKResourceHeap();
 
         inline VkPipelineLayout GetVkPipelineLayout() const
@@ -36,30 +37,32 @@ class VKResourceHeap final : public ResourceHeap
             return pipelineLayout_;
         }
 
-        inline VkDescriptorPool GetVkDescriptorPool() const
+        inline const VkDescriptorSet& GetVkDescriptorSet() const
         {
-            return descriptorPool_.Get();
+            return allocation_.descriptorSet;
         }
 
-        inline const std::vector<VkDescriptorSet>& GetVkDescriptorSets() const
-        {
-            return descriptorSets_;
-        }
+        // Writes the specified resource views into the descriptor set, starting at the view with index 'firstDescriptor'.
+        void WriteResourceViews(std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews);
 
     private:
 
-        void CreateDescriptorPool(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings);
-        void CreateDescriptorSets(std::uint32_t numSetLayouts, const VkDescriptorSetLayout* setLayouts);
-        void UpdateDescriptorSets(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings);
-
-        void FillWriteDescriptorForSampler(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
-        void FillWriteDescriptorForTexture(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
-        void FillWriteDescriptorForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
-
-        VkDevice                        device_         = VK_NULL_HANDLE;
-        VkPipelineLayout                pipelineLayout_ = VK_NULL_HANDLE;
-        VKPtr<VkDescriptorPool>         descriptorPool_;
-        std::vector<VkDescriptorSet>    descriptorSets_;
+        void UpdateDescriptorSets(const ResourceViewDescriptor* resourceViews, std::size_t firstView, std::size_t numViews);
+        void UpdateDescriptorSetWithTemplate(const ResourceHeapDescriptor& desc, const VKPipelineLayout& pipelineLayoutVK);
+
+        void FillWriteDescriptorForSampler(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container);
+        void FillWriteDescriptorForTexture(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container);
+        void FillWriteDescriptorForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container);
+        #ifdef VK_KHR_acceleration_structure
+        void FillWriteDescriptorForAccelerationStructure(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, std::uint32_t arrayElement, VKWriteDescriptorContainer& container);
+        #endif
+
+        VkDevice                        device_             = VK_NULL_HANDLE;
+        VKDescriptorSetAllocator&       descriptorSetAllocator_;
+        VkPipelineLayout                pipelineLayout_     = VK_NULL_HANDLE;
+        VKDescriptorSetAllocation       allocation_;
+        std::vector<VKLayoutBinding>    bindings_;                              // Copy of the pipeline layout bindings for in-place updates
+        std::size_t                     numResourceViews_   = 0;
 
 };
 
@@ -0,0 +1,134 @@
+/*
+ * VKTransientDescriptorPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKTransientDescriptorPool.h"
+#include "../VKCore.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Maximal number of descriptor sets per descriptor pool
+static const std::uint32_t g_maxNumTransientSetsPerPool = 256;
+
+// Number of descriptors per descriptor type within a pool
+static const std::uint32_t g_numTransientDescriptorsPerPool = 1024;
+
+// All descriptor types that can be bound individually, see CommandBufferExt
+static const VkDescriptorType g_transientDescriptorPoolTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+VKTransientDescriptorPool::VKTransientDescriptorPool(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+VKTransientDescriptorPool::~VKTransientDescriptorPool()
+{
+    for (auto pool : pools_)
+        vkDestroyDescriptorPool(device_, pool, VKGetAllocationCallbacks());
+}
+
+VkDescriptorSet VKTransientDescriptorPool::Allocate(VkDescriptorSetLayout setLayout)
+{
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    /* Allocate descriptor set from the current pool, or continue with the next pool if it is exhausted */
+    for (; currentPool_ < pools_.size(); ++currentPool_)
+    {
+        if (AllocateFromPool(pools_[currentPool_], setLayout, descriptorSet))
+            return descriptorSet;
+    }
+
+    /* Create new descriptor pool */
+    pools_.push_back(CreateDescriptorPool());
+
+    if (!AllocateFromPool(pools_.back(), setLayout, descriptorSet))
+        throw std::runtime_error("failed to allocate Vulkan descriptor set from new transient descriptor pool");
+
+    return descriptorSet;
+}
+
+void VKTransientDescriptorPool::Reset()
+{
+    /* Only the pools up to the current one have been used since the last reset */
+    for (std::size_t i = 0; i < pools_.size() && i <= currentPool_; ++i)
+    {
+        auto result = vkResetDescriptorPool(device_, pools_[i], 0);
+        VKThrowIfFailed(result, "failed to reset Vulkan descriptor pool");
+    }
+    currentPool_ = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VkDescriptorPool VKTransientDescriptorPool::CreateDescriptorPool()
+{
+    /* Initialize descriptor pool sizes */
+    VkDescriptorPoolSize poolSizes[sizeof(g_transientDescriptorPoolTypes)/sizeof(g_transientDescriptorPoolTypes[0])];
+
+    for (std::size_t i = 0; i < sizeof(g_transientDescriptorPoolTypes)/sizeof(g_transientDescriptorPoolTypes[0]); ++i)
+    {
+        poolSizes[i].type               = g_transientDescriptorPoolTypes[i];
+        poolSizes[i].descriptorCount    = g_numTransientDescriptorsPerPool;
+    }
+
+    /* Create descriptor pool without individual release of descriptor sets, since the entire pool is reset at once */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = 0;
+        poolCreateInfo.maxSets          = g_maxNumTransientSetsPerPool;
+        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(sizeof(poolSizes)/sizeof(poolSizes[0]));
+        poolCreateInfo.pPoolSizes       = poolSizes;
+    }
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, VKGetAllocationCallbacks(), &pool);
+    VKThrowIfFailed(result, "failed to create Vulkan transient descriptor pool");
+
+    return pool;
+}
+
+bool VKTransientDescriptorPool::AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout setLayout, VkDescriptorSet& descriptorSet)
+{
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = pool;
+        allocInfo.descriptorSetCount    = 1;
+        allocInfo.pSetLayouts           = &setLayout;
+    }
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSet);
+
+    /* Exhausted pools are not an error here */
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY_KHR || result == VK_ERROR_FRAGMENTED_POOL)
+        return false;
+
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * VKTransientDescriptorPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_TRANSIENT_DESCRIPTOR_POOL_H
+#define LLGL_VK_TRANSIENT_DESCRIPTOR_POOL_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Descriptor pools for transient descriptor sets, which are only valid for a single recording of a command buffer.
+All descriptor sets are released at once by resetting the pools, so the pools are recycled with each recording
+and new pools are only created when all previous pools are exhausted within one recording.
+*/
+class VKTransientDescriptorPool
+{
+
+    public:
+
+        VKTransientDescriptorPool(const VKPtr<VkDevice>& device);
+        ~VKTransientDescriptorPool();
+
+        VKTransientDescriptorPool(const VKTransientDescriptorPool&) = delete;
+        VKTransientDescriptorPool& operator = (const VKTransientDescriptorPool&) = delete;
+
+        // Allocates a descriptor set with the specified layout, which is valid until the next call to Reset.
+        VkDescriptorSet Allocate(VkDescriptorSetLayout setLayout);
+
+        // Releases all descriptor sets. The GPU must no longer reference any of them.
+        void Reset();
+
+    private:
+
+        VkDescriptorPool CreateDescriptorPool();
+
+        bool AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout setLayout, VkDescriptorSet& descriptorSet);
+
+    private:
+
+        VkDevice                        device_         = VK_NULL_HANDLE;
+        std::vector<VkDescriptorPool>   pools_;
+        std::size_t                     currentPool_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
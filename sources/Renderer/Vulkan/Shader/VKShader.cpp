@@ -11,10 +11,6 @@
 #include "../../../Core/Helper.h"
 #include <LLGL/Strings.h>
 
-#ifdef LLGL_ENABLE_SPIRV_REFLECT
-#   include "../../SPIRV/SPIRVReflect.h"
-#endif
-
 
 namespace LLGL
 {
@@ -70,7 +66,7 @@ void VKShader::FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& create
     createInfo.stage                = VKTypes::Map(GetType());
     createInfo.module               = shaderModule_;
     createInfo.pName                = entryPoint_.c_str();
-    createInfo.pSpecializationInfo  = nullptr;
+    createInfo.pSpecializationInfo  = (specializationEntries_.empty() ? nullptr : &specializationInfo_);
 }
 
 
@@ -80,6 +76,8 @@ void VKShader::FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& create
 
 bool VKShader::Build(const ShaderDescriptor& shaderDesc)
 {
+    StoreSpecializationConstants(shaderDesc.specializationConstants);
+
     if (IsShaderSourceCode(shaderDesc.sourceType))
         return CompileSource(shaderDesc);
     else
@@ -119,12 +117,25 @@ bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
 
     try
     {
-        /* Parse shader module */
-        SPIRVReflect reflect;
-        reflect.Parse(binaryBuffer, binaryLength);
-
-        /* Store reflection data */
-        //TODO...
+        /* Binary files have their reflection cached next to them, which is only re-generated when the module changes */
+        std::uint64_t moduleHash = g_hashOffsetBasis;
+        std::string cacheFilename;
+
+        if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
+        {
+            AccumulateHash(moduleHash, binaryBuffer, binaryLength);
+            cacheFilename = std::string(shaderDesc.source) + ".refl";
+        }
+
+        if (cacheFilename.empty() || !ReadSPIRVReflection(cacheFilename, moduleHash, reflection_))
+        {
+            /* Reflect shader module in place */
+            SPIRVReflect reflect;
+            reflect.Reflect(binaryBuffer, binaryLength, reflection_);
+
+            if (!cacheFilename.empty())
+                WriteSPIRVReflection(cacheFilename, moduleHash, reflection_);
+        }
     }
     catch (const std::exception& e)
     {
@@ -159,7 +170,7 @@ bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
         createInfo.codeSize = binaryLength;
         createInfo.pCode    = reinterpret_cast<const std::uint32_t*>(binaryBuffer);
     }
-    auto result = vkCreateShaderModule(device_, &createInfo, nullptr, shaderModule_.ReleaseAndGetAddressOf());
+    auto result = vkCreateShaderModule(device_, &createInfo, VKGetAllocationCallbacks(), shaderModule_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan shader module");
 
     loadBinaryResult_ = LoadBinaryResult::Successful;
@@ -168,6 +179,28 @@ bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
 }
 
 
+void VKShader::StoreSpecializationConstants(const std::vector<ShaderSpecializationConstant>& constants)
+{
+    /* Store all constants as 32-bit values, which are referenced by the map entries */
+    const auto numConstants = static_cast<std::uint32_t>(constants.size());
+
+    specializationEntries_.resize(numConstants);
+    specializationData_.resize(numConstants);
+
+    for (std::uint32_t i = 0; i < numConstants; ++i)
+    {
+        specializationEntries_[i].constantID    = constants[i].id;
+        specializationEntries_[i].offset        = i * sizeof(std::uint32_t);
+        specializationEntries_[i].size          = sizeof(std::uint32_t);
+        specializationData_[i]                  = constants[i].value;
+    }
+
+    specializationInfo_.mapEntryCount   = numConstants;
+    specializationInfo_.pMapEntries     = specializationEntries_.data();
+    specializationInfo_.dataSize        = numConstants * sizeof(std::uint32_t);
+    specializationInfo_.pData           = specializationData_.data();
+}
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,11 @@
 #include <LLGL/Shader.h>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include <vector>
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include "../../SPIRV/SPIRVReflect.h"
+#endif
 
 
 namespace LLGL
@@ -39,6 +44,16 @@ class VKShader final : public Shader
             return shaderModule_;
         }
 
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+        // Returns the reflection of the SPIR-V shader module.
+        inline const SPIRVReflection& GetReflection() const
+        {
+            return reflection_;
+        }
+
+        #endif // /LLGL_ENABLE_SPIRV_REFLECT
+
     private:
 
         // Note: "Success" is a reserved macro by X11 lib.
@@ -54,13 +69,23 @@ class VKShader final : public Shader
         bool CompileSource(const ShaderDescriptor& shaderDesc);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        void StoreSpecializationConstants(const std::vector<ShaderSpecializationConstant>& constants);
+
         VkDevice                device_             = VK_NULL_HANDLE;
         VKPtr<VkShaderModule>   shaderModule_;
         LoadBinaryResult        loadBinaryResult_   = LoadBinaryResult::Undefined;
 
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+        SPIRVReflection         reflection_;        // Loaded from the reflection cache next to binary files if it is up to date
+        #endif
+
         std::string             entryPoint_;
         std::string             errorLog_;
 
+        std::vector<VkSpecializationMapEntry>   specializationEntries_;
+        std::vector<std::uint32_t>              specializationData_;
+        VkSpecializationInfo                    specializationInfo_;
+
 };
 
 
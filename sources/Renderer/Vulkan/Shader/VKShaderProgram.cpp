@@ -13,6 +13,7 @@
 #include <LLGL/VertexFormat.h>
 #include <vector>
 #include <set>
+#include <algorithm>
 
 
 namespace LLGL
@@ -27,6 +28,8 @@ VKShaderProgram::VKShaderProgram(const ShaderProgramDescriptor& desc)
     Attach(desc.geometryShader);
     Attach(desc.fragmentShader);
     Attach(desc.computeShader);
+    Attach(desc.amplificationShader);
+    Attach(desc.meshShader);
     BuildInputLayout(desc.vertexFormats.size(), desc.vertexFormats.data());
     Link();
 }
@@ -44,9 +47,76 @@ std::string VKShaderProgram::QueryInfoLog()
         return "";
 }
 
+bool VKShaderProgram::IsReady() const
+{
+    /* SPIR-V shader modules are not compiled asynchronously */
+    return true;
+}
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+// Merges the uniforms of the specified shader into the resource views, so each binding slot is only listed once with the stages of all shaders that use it.
+static void MergeResourceViews(std::vector<ShaderReflectionDescriptor::ResourceView>& resourceViews, const VKShader& shader)
+{
+    const auto& reflection = shader.GetReflection();
+
+    for (const auto& uniform : reflection.uniforms)
+    {
+        if (uniform.type == ResourceType::Undefined)
+            continue;
+
+        auto it = std::find_if(
+            resourceViews.begin(), resourceViews.end(),
+            [&uniform](const ShaderReflectionDescriptor::ResourceView& resourceView)
+            {
+                return (resourceView.slot == uniform.bindingPoint);
+            }
+        );
+
+        if (it != resourceViews.end())
+        {
+            it->stageFlags |= shader.GetStageFlags();
+            it->arraySize   = std::max(it->arraySize, uniform.arraySize);
+        }
+        else
+        {
+            ShaderReflectionDescriptor::ResourceView resourceView;
+            {
+                resourceView.name       = reflection.GetName(uniform.name);
+                resourceView.type       = uniform.type;
+                resourceView.stageFlags = shader.GetStageFlags();
+                resourceView.slot       = uniform.bindingPoint;
+                resourceView.arraySize  = uniform.arraySize;
+            }
+            resourceViews.push_back(resourceView);
+        }
+    }
+}
+
+#endif // /LLGL_ENABLE_SPIRV_REFLECT
+
 ShaderReflectionDescriptor VKShaderProgram::QueryReflectionDesc() const
 {
-    return {}; //TODO
+    ShaderReflectionDescriptor reflection;
+
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+    /* Derive minimal set of resource views with the visibility of all stages that use them */
+    for (auto shader : shaders_)
+        MergeResourceViews(reflection.resourceViews, *shader);
+
+    /* Sort resource views by binding slot, so identical layouts of different programs result in the same pipeline layout */
+    std::sort(
+        reflection.resourceViews.begin(), reflection.resourceViews.end(),
+        [](const ShaderReflectionDescriptor::ResourceView& lhs, const ShaderReflectionDescriptor::ResourceView& rhs)
+        {
+            return (lhs.slot < rhs.slot);
+        }
+    );
+
+    #endif // /LLGL_ENABLE_SPIRV_REFLECT
+
+    return reflection;
 }
 
 void VKShaderProgram::BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex)
@@ -121,6 +191,16 @@ bool VKShaderProgram::HasFragmentShader() const
     return false;
 }
 
+bool VKShaderProgram::HasMeshShader() const
+{
+    for (auto shader : shaders_)
+    {
+        if (shader->GetType() == ShaderType::Mesh)
+            return true;
+    }
+    return false;
+}
+
 
 /*
  * ======= Private: =======
@@ -32,6 +32,8 @@ class VKShaderProgram final : public ShaderProgram
 
         std::string QueryInfoLog() override;
 
+        bool IsReady() const override;
+
         ShaderReflectionDescriptor QueryReflectionDesc() const override;
 
         void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
@@ -49,6 +51,7 @@ class VKShaderProgram final : public ShaderProgram
         void FillVertexInputStateCreateInfo(VkPipelineVertexInputStateCreateInfo& createInfo) const;
 
         bool HasFragmentShader() const;
+        bool HasMeshShader() const;
 
     private:
 
@@ -55,11 +55,11 @@ void VKDepthStencilBuffer::CreateDepthStencil(
         1,                                          // array layers
         0,                                          // create flags
         samplesFlags,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+        (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
     );
 
-    /* Allocate device memory region */
-    AllocateMemoryRegion(deviceMemoryMngr);
+    /* Allocate device memory region (depth-stencil buffers are only accessed as attachments, so they can stay in tile memory) */
+    AllocateMemoryRegion(deviceMemoryMngr, true);
 
     /* Create depth-stencil image view */
     CreateVkImageView(
@@ -24,7 +24,7 @@ VKImageWrapper::~VKImageWrapper()
 {
 }
 
-void VKImageWrapper::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr)
+void VKImageWrapper::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool transient)
 {
     auto device = deviceMemoryMngr.GetVkDevice();
 
@@ -32,12 +32,18 @@ void VKImageWrapper::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMng
     VkMemoryRequirements requirements;
     vkGetImageMemoryRequirements(device, image_, &requirements);
 
+    /* Keep transient attachments in tile memory on tile-based GPUs, which only commit lazily allocated memory on demand */
+    VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    if (transient && deviceMemoryMngr.HasMemoryType(requirements.memoryTypeBits, properties | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+        properties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
     /* Allocate device memory */
     memoryRegion_ = deviceMemoryMngr.Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        properties
     );
 
     /* Bind image to device memory region */
@@ -71,7 +77,8 @@ void VKImageWrapper::CreateVkImage(
     std::uint32_t           numArrayLayers,
     VkImageCreateFlags      createFlags,
     VkSampleCountFlagBits   samplesFlags,
-    VkImageUsageFlags       usageFlags)
+    VkImageUsageFlags       usageFlags,
+    const std::vector<std::uint32_t>* sharedQueueFamilies)
 {
     /* Create image object */
     VkImageCreateInfo createInfo;
@@ -87,12 +94,22 @@ void VKImageWrapper::CreateVkImage(
         createInfo.samples                  = samplesFlags;
         createInfo.tiling                   = VK_IMAGE_TILING_OPTIMAL;
         createInfo.usage                    = usageFlags;
+        createInfo.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    if (sharedQueueFamilies != nullptr && sharedQueueFamilies->size() > 1)
+    {
+        /* Share image with dedicated compute and transfer queues, so no queue family ownership transfers are required */
+        createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies->size());
+        createInfo.pQueueFamilyIndices      = sharedQueueFamilies->data();
+    }
+    else
+    {
         createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
         createInfo.queueFamilyIndexCount    = 0;
         createInfo.pQueueFamilyIndices      = nullptr;
-        createInfo.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
     }
-    VkResult result = vkCreateImage(device, &createInfo, nullptr, image_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateImage(device, &createInfo, VKGetAllocationCallbacks(), image_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan image");
 }
 
@@ -110,7 +127,8 @@ void VKImageWrapper::CreateVkImageView(
     std::uint32_t       numMipLevels,
     std::uint32_t       baseArrayLayer,
     std::uint32_t       numArrayLayers,
-    VkImageView*        imageViewRef)
+    VkImageView*        imageViewRef,
+    const VkComponentMapping* components) const
 {
     /* Create image view object */
     VkImageViewCreateInfo createInfo;
@@ -121,17 +139,22 @@ void VKImageWrapper::CreateVkImageView(
         createInfo.image                            = image_;
         createInfo.viewType                         = viewType;
         createInfo.format                           = format;
-        createInfo.components.r                     = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.g                     = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.b                     = VK_COMPONENT_SWIZZLE_IDENTITY;
-        createInfo.components.a                     = VK_COMPONENT_SWIZZLE_IDENTITY;
+        if (components != nullptr)
+            createInfo.components                   = *components;
+        else
+        {
+            createInfo.components.r                 = VK_COMPONENT_SWIZZLE_IDENTITY;
+            createInfo.components.g                 = VK_COMPONENT_SWIZZLE_IDENTITY;
+            createInfo.components.b                 = VK_COMPONENT_SWIZZLE_IDENTITY;
+            createInfo.components.a                 = VK_COMPONENT_SWIZZLE_IDENTITY;
+        }
         createInfo.subresourceRange.aspectMask      = aspectFlags;
         createInfo.subresourceRange.baseMipLevel    = baseMipLevel;
         createInfo.subresourceRange.levelCount      = numMipLevels;
         createInfo.subresourceRange.baseArrayLayer  = baseArrayLayer;
         createInfo.subresourceRange.layerCount      = numArrayLayers;
     }
-    VkResult result = vkCreateImageView(device, &createInfo, nullptr, imageViewRef);
+    VkResult result = vkCreateImageView(device, &createInfo, VKGetAllocationCallbacks(), imageViewRef);
     VKThrowIfFailed(result, "failed to create Vulkan image view");
 }
 
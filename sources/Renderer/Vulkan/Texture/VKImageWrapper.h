@@ -12,6 +12,7 @@
 #include <LLGL/Texture.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include <vector>
 #include <cstdint>
 
 
@@ -30,7 +31,8 @@ class VKImageWrapper
         VKImageWrapper(const VKPtr<VkDevice>& device);
         virtual ~VKImageWrapper();
 
-        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
+        // Allocates device-local memory for the image; transient attachments prefer lazily allocated memory if available.
+        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool transient = false);
         void ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
@@ -44,7 +46,8 @@ class VKImageWrapper
             std::uint32_t           numArrayLayers,
             VkImageCreateFlags      createFlags,
             VkSampleCountFlagBits   samplesFlags,
-            VkImageUsageFlags       usageFlags
+            VkImageUsageFlags       usageFlags,
+            const std::vector<std::uint32_t>* sharedQueueFamilies = nullptr
         );
 
         void ReleaseVkImage();
@@ -58,8 +61,9 @@ class VKImageWrapper
             std::uint32_t       numMipLevels,
             std::uint32_t       baseArrayLayer,
             std::uint32_t       numArrayLayers,
-            VkImageView*        imageViewRef
-        );
+            VkImageView*        imageViewRef,
+            const VkComponentMapping* components = nullptr
+        ) const;
 
         // Returns the Vulkan image object.
         inline VkImage GetVkImage() const
@@ -19,14 +19,19 @@ namespace LLGL
 {
 
 
-VKRenderTarget::VKRenderTarget(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const RenderTargetDescriptor& desc) :
+VKRenderTarget::VKRenderTarget(
+    const VKPtr<VkDevice>&          device,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
+    VKRenderPassCache&              renderPassCache,
+    const RenderTargetDescriptor&   desc)
+:
     RenderTarget        { desc.resolution              },
     framebuffer_        { device, vkDestroyFramebuffer },
-    renderPass_         { device, vkDestroyRenderPass  },
     depthStencilBuffer_ { device                       }
 {
-    CreateRenderPass(device, deviceMemoryMngr, desc);
-    CreateFramebuffer(device, desc);
+    const auto numLayers = ValidateAttachmentLayers(desc);
+    CreateRenderPass(deviceMemoryMngr, renderPassCache, desc);
+    CreateFramebuffer(device, desc, numLayers);
 }
 
 std::uint32_t VKRenderTarget::GetNumColorAttachments() const
@@ -36,14 +41,14 @@ std::uint32_t VKRenderTarget::GetNumColorAttachments() const
 
 bool VKRenderTarget::HasDepthAttachment() const
 {
-    auto format = depthStencilBuffer_.GetVkFormat();
-    return (format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D24_UNORM_S8_UINT);
+    auto format = renderPassSet_.GetLayout().depthStencilFormat;
+    return (format != VK_FORMAT_UNDEFINED && (VKGetImageAspectByFormat(format) & VK_IMAGE_ASPECT_DEPTH_BIT) != 0);
 }
 
 bool VKRenderTarget::HasStencilAttachment() const
 {
-    auto format = depthStencilBuffer_.GetVkFormat();
-    return (format == VK_FORMAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT);
+    auto format = renderPassSet_.GetLayout().depthStencilFormat;
+    return (format != VK_FORMAT_UNDEFINED && (VKGetImageAspectByFormat(format) & VK_IMAGE_ASPECT_STENCIL_BIT) != 0);
 }
 
 void VKRenderTarget::ReleaseDeviceMemoryResources(VKDeviceMemoryManager& deviceMemoryMngr)
@@ -74,26 +79,18 @@ static VkFormat GetDepthAttachmentVkFormat(const AttachmentType type)
     throw std::invalid_argument("unknown attachment type to render target that has no texture");
 }
 
-static bool HasStencilComponent(const AttachmentType type)
+void VKRenderTarget::CreateRenderPass(VKDeviceMemoryManager& deviceMemoryMngr, VKRenderPassCache& renderPassCache, const RenderTargetDescriptor& desc)
 {
-    return (type == AttachmentType::Stencil || type == AttachmentType::DepthStencil);
-}
-
-void VKRenderTarget::CreateRenderPass(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const RenderTargetDescriptor& desc)
-{
-    /* Initialize attachment descriptors */
-    std::vector<VkAttachmentDescription> attachmentDescs(desc.attachments.size());
+    /* Determine framebuffer layout: color attachments in the order of their descriptors, and at most one depth-stencil attachment */
+    VKRenderPassLayout layout;
 
-    for (std::size_t i = 0; i < desc.attachments.size(); ++i)
+    for (const auto& attachment : desc.attachments)
     {
-        const auto& attachmentSrc = desc.attachments[i];
-        auto&       attachmentDst = attachmentDescs[i];
-
         /* Initialize format and sample count flags */
         VkFormat                format          = VK_FORMAT_UNDEFINED;
         VkSampleCountFlagBits   samplesFlags    = VK_SAMPLE_COUNT_1_BIT; //TODO: multi-sampling
 
-        if (auto texture = attachmentSrc.texture)
+        if (auto texture = attachment.texture)
         {
             /* Get format from texture */
             auto textureVK = LLGL_CAST(VKTexture*, texture);
@@ -101,8 +98,12 @@ void VKRenderTarget::CreateRenderPass(const VKPtr<VkDevice>& device, VKDeviceMem
         }
         else
         {
+            /* Anonymous depth-stencil buffers only have a single array layer, which cannot be broadcast to multiple views */
+            if (desc.numViews > 1)
+                throw std::invalid_argument("cannot create multiview render target with attachment without a valid texture");
+
             /* Create depth-stencil buffer */
-            format = GetDepthAttachmentVkFormat(attachmentSrc.type);
+            format = GetDepthAttachmentVkFormat(attachment.type);
 
             if (depthStencilBuffer_.GetVkFormat() == VK_FORMAT_UNDEFINED)
                 depthStencilBuffer_.CreateDepthStencil(deviceMemoryMngr, GetResolution(), format, samplesFlags);
@@ -110,140 +111,95 @@ void VKRenderTarget::CreateRenderPass(const VKPtr<VkDevice>& device, VKDeviceMem
                 ErrDepthAttachmentFailed();
         }
 
-        /* Write attachment descriptor */
-        attachmentDst.flags            = 0;
-        attachmentDst.format           = format;
-        attachmentDst.samples          = samplesFlags;
-        attachmentDst.loadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDst.storeOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentDst.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDst.stencilStoreOp    = (HasStencilComponent(attachmentSrc.type) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
-        attachmentDst.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachmentDst.finalLayout      = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    }
-
-    /* Initialize attachment reference */
-    std::vector<VkAttachmentReference> attachmentsRefs(desc.attachments.size());
-
-    numColorAttachments_ = 0;
-    std::size_t depthAttachmentIndex = ~0;
-    bool hasDSVAttachment = false;
-
-    for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(desc.attachments.size()); i < n; ++i)
-    {
-        if (desc.attachments[i].type == AttachmentType::Color)
+        if (attachment.type == AttachmentType::Color)
+            layout.colorFormats.push_back(format);
+        else if (layout.depthStencilFormat == VK_FORMAT_UNDEFINED)
         {
-            auto& attachmentRef = attachmentsRefs[numColorAttachments_++];
-            {
-                attachmentRef.attachment    = i;
-                attachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            }
+            layout.depthStencilFormat = format;
+
+            /* Depth-stencil textures remain in shader-read layout after each render pass like color attachments, so they can be sampled without copying */
+            if (attachment.texture != nullptr)
+                layout.depthStencilFinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         }
         else
-        {
-            if (!hasDSVAttachment)
-            {
-                auto& attachmentRef = attachmentsRefs.back();
-                {
-                    attachmentRef.attachment    = i;
-                    attachmentRef.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-                }
-                depthAttachmentIndex = (attachmentsRefs.size() - 1);
-                hasDSVAttachment = true;
-            }
-            else
-                throw std::invalid_argument("cannot have more than one depth-stencil attachment for render target");
-        }
+            throw std::invalid_argument("cannot have more than one depth-stencil attachment for render target");
     }
 
-    /* Initialize sub-pass descriptor */
-    VkSubpassDescription subpassDesc;
-    {
-        subpassDesc.flags                   = 0;
-        subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpassDesc.inputAttachmentCount    = 0;
-        subpassDesc.pInputAttachments       = nullptr;
-        subpassDesc.colorAttachmentCount    = numColorAttachments_;
-        subpassDesc.pColorAttachments       = attachmentsRefs.data();
-        subpassDesc.pResolveAttachments     = nullptr;
-        subpassDesc.pDepthStencilAttachment = (depthAttachmentIndex < attachmentsRefs.size() ? &(attachmentsRefs[depthAttachmentIndex]) : nullptr);
-        subpassDesc.preserveAttachmentCount = 0;
-        subpassDesc.pPreserveAttachments    = nullptr;
-    }
+    numColorAttachments_ = static_cast<std::uint32_t>(layout.colorFormats.size());
 
-    /* Initialize sub-pass dependency */
-    VkSubpassDependency subpassDep;
-    {
-        subpassDep.srcSubpass               = VK_SUBPASS_EXTERNAL;
-        subpassDep.dstSubpass               = 0;
-        subpassDep.srcStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDep.dstStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDep.srcAccessMask            = 0;
-        subpassDep.dstAccessMask            = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        subpassDep.dependencyFlags          = 0;
-    }
+    /* Color attachments remain in shader-read layout after each render pass, so they can be sampled afterwards */
+    layout.colorFinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-    /* Create swap-chain render pass */
-    VkRenderPassCreateInfo createInfo;
+    /* Broadcast draw commands to all views for multiview rendering */
+    if (desc.numViews > 1)
     {
-        createInfo.sType                    = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
-        createInfo.flags                    = 0;
-        createInfo.attachmentCount          = static_cast<std::uint32_t>(attachmentDescs.size());
-        createInfo.pAttachments             = attachmentDescs.data();
-        createInfo.subpassCount             = 1;
-        createInfo.pSubpasses               = (&subpassDesc);
-        createInfo.dependencyCount          = 1;
-        createInfo.pDependencies            = (&subpassDep);
+        if (desc.numViews > 32)
+            throw std::invalid_argument("cannot create multiview render target with more than 32 views");
+        layout.viewMask = (desc.numViews < 32 ? (1u << desc.numViews) - 1u : ~0u);
     }
-    auto result = vkCreateRenderPass(device, &createInfo, nullptr, renderPass_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan render pass");
+
+    /* Get default render pass that loads and stores all attachments; it is shared with all render targets of the same layout */
+    renderPassSet_.Reset(renderPassCache, layout, RenderPassDescriptor{});
 }
 
-void VKRenderTarget::CreateFramebuffer(const VKPtr<VkDevice>& device, const RenderTargetDescriptor& desc)
+void VKRenderTarget::CreateFramebuffer(const VKPtr<VkDevice>& device, const RenderTargetDescriptor& desc, std::uint32_t numLayers)
 {
     /* Create image view for each attachment */
     imageViews_.resize(desc.attachments.size(), VKPtr<VkImageView> { device, vkDestroyImageView });
 
+    /* Framebuffer attachments must match the order of the render pass attachments, i.e. the depth-stencil attachment comes last */
     std::vector<VkImageView> imageViewRefs(desc.attachments.size());
 
     std::uint32_t numAttachments = 0;
+    VkImageView depthStencilView = VK_NULL_HANDLE;
 
-    for (const auto& attachment : desc.attachments)
+    for (std::size_t i = 0; i < desc.attachments.size(); ++i)
     {
+        const auto& attachment = desc.attachments[i];
+
+        VkImageView imageView = VK_NULL_HANDLE;
+
         if (attachment.texture)
         {
             auto textureVK = LLGL_CAST(VKTexture*, attachment.texture);
 
-            /* Create new image view for MIP-level and array layer specified in attachment descriptor */
+            /* Depth slices of 3D textures can only be attached as 2D-array views if the image was created with VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT */
+            if (numLayers > 1 && textureVK->GetType() == TextureType::Texture3D)
+                throw std::invalid_argument("cannot attach depth slices of 3D texture to layered Vulkan render target");
+
+            /*
+            Create new image view for MIP-level and array layers specified in attachment descriptor;
+            multiview renders into one array layer per view, and layered rendering into the layer selected by the shader
+            */
             textureVK->CreateImageView(
                 device,
                 attachment.mipLevel,
                 1,
                 attachment.arrayLayer,
-                1,
-                imageViews_[numAttachments].ReleaseAndGetAddressOf()
+                (desc.numViews > 1 ? desc.numViews : attachment.numArrayLayers),
+                imageViews_[i].ReleaseAndGetAddressOf()
             );
-
-            /* Add image view to attachments */
-            imageViewRefs[numAttachments] = imageViews_[numAttachments].Get();
+            imageView = imageViews_[i].Get();
 
             /* Validate texture resolution to render target (to validate correlation between attachments) */
             ValidateMipResolution(*textureVK, attachment.mipLevel);
-
-            /* Next attachment index */
-            ++numAttachments;
         }
         else
         {
-            /* Add depth-stencil image view to attachments */
-            imageViewRefs[numAttachments] = depthStencilBuffer_.GetVkImageView();
-
-            /* Next attachment index */
-            ++numAttachments;
+            /* Use depth-stencil image view */
+            imageView = depthStencilBuffer_.GetVkImageView();
         }
+
+        /* Add image view to attachments */
+        if (attachment.type == AttachmentType::Color)
+            imageViewRefs[numAttachments++] = imageView;
+        else
+            depthStencilView = imageView;
     }
 
+    if (depthStencilView != VK_NULL_HANDLE)
+        imageViewRefs[numAttachments++] = depthStencilView;
+
     if (numAttachments == 0)
         throw std::runtime_error("failed to create render target without attachments");
 
@@ -253,14 +209,14 @@ void VKRenderTarget::CreateFramebuffer(const VKPtr<VkDevice>& device, const Rend
         createInfo.sType            = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         createInfo.pNext            = nullptr;
         createInfo.flags            = 0;
-        createInfo.renderPass       = renderPass_;
+        createInfo.renderPass       = renderPassSet_.GetDefault();
         createInfo.attachmentCount  = numAttachments;
         createInfo.pAttachments     = imageViewRefs.data();
         createInfo.width            = GetResolution().width;
         createInfo.height           = GetResolution().height;
-        createInfo.layers           = 1;
+        createInfo.layers           = numLayers; // Must be 1 for multiview render passes, whose views select the array layers instead
     }
-    VkResult result = vkCreateFramebuffer(device, &createInfo, nullptr, framebuffer_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateFramebuffer(device, &createInfo, VKGetAllocationCallbacks(), framebuffer_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan framebuffer");
 }
 
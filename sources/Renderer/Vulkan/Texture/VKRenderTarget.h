@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include "VKDepthStencilBuffer.h"
+#include "../RenderState/VKRenderPassCache.h"
 
 
 namespace LLGL
@@ -24,7 +25,12 @@ class VKRenderTarget final : public RenderTarget
 
     public:
 
-        VKRenderTarget(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const RenderTargetDescriptor& desc);
+        VKRenderTarget(
+            const VKPtr<VkDevice>&          device,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
+            VKRenderPassCache&              renderPassCache,
+            const RenderTargetDescriptor&   desc
+        );
 
         std::uint32_t GetNumColorAttachments() const override;
         bool HasDepthAttachment() const override;
@@ -38,10 +44,16 @@ class VKRenderTarget final : public RenderTarget
             return framebuffer_;
         }
 
-        // Returns the Vulkan render pass object.
+        // Returns the default Vulkan render pass object, which loads and stores all attachments.
         inline VkRenderPass GetVkRenderPass() const
         {
-            return renderPass_;
+            return renderPassSet_.GetDefault();
+        }
+
+        // Returns the set of all Vulkan render passes that are used with this render target.
+        inline VKRenderPassSet& GetRenderPassSet()
+        {
+            return renderPassSet_;
         }
 
         // Returns the render target resolution as VkExtent2D.
@@ -52,11 +64,11 @@ class VKRenderTarget final : public RenderTarget
 
     private:
 
-        void CreateRenderPass(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const RenderTargetDescriptor& desc);
-        void CreateFramebuffer(const VKPtr<VkDevice>& device, const RenderTargetDescriptor& desc);
+        void CreateRenderPass(VKDeviceMemoryManager& deviceMemoryMngr, VKRenderPassCache& renderPassCache, const RenderTargetDescriptor& desc);
+        void CreateFramebuffer(const VKPtr<VkDevice>& device, const RenderTargetDescriptor& desc, std::uint32_t numLayers);
 
         VKPtr<VkFramebuffer>            framebuffer_;
-        VKPtr<VkRenderPass>             renderPass_;
+        VKRenderPassSet                 renderPassSet_;
 
         std::vector<VKPtr<VkImageView>> imageViews_;
 
@@ -37,6 +37,7 @@ static VkBorderColor GetVkBorderColor(const ColorRGBAf& color)
 }
 
 VKSampler::VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& desc) :
+    device_  { device                   },
     sampler_ { device, vkDestroySampler }
 {
     /* Create sampler state */
@@ -75,10 +76,17 @@ VKSampler::VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& des
             createInfo.maxLod       = 0.25f;
         }
     }
-    VkResult result = vkCreateSampler(device, &createInfo, nullptr, sampler_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateSampler(device, &createInfo, VKGetAllocationCallbacks(), sampler_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan sampler");
 }
 
+void VKSampler::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    VKSetObjectName(device_, VK_OBJECT_TYPE_SAMPLER, reinterpret_cast<std::uint64_t>(GetVkSampler()), name);
+    #endif
+}
+
 
 } // /namespace LLGL
 
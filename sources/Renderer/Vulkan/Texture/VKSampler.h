@@ -25,6 +25,8 @@ class VKSampler final : public Sampler
 
         VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& desc);
 
+        void SetName(const char* name) override;
+
         // Returns the Vulkan sampler object.
         inline VkSampler GetVkSampler() const
         {
@@ -33,6 +35,7 @@ class VKSampler final : public Sampler
 
     private:
 
+        VkDevice         device_    = VK_NULL_HANDLE;
         VKPtr<VkSampler> sampler_;
 
 };
@@ -17,15 +17,63 @@ namespace LLGL
 
 
 VKTexture::VKTexture(
-    const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const TextureDescriptor& desc) :
+    const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, const TextureDescriptor& desc, const std::vector<std::uint32_t>* sharedQueueFamilies) :
         Texture       { desc.type                  },
+        device_       { device                     },
         imageWrapper_ { device                     },
         imageView_    { device, vkDestroyImageView },
         format_       { VKTypes::Map(desc.format)  }
 {
     /* Create Vulkan image and allocate memory region */
-    CreateImage(device, desc);
-    imageWrapper_.AllocateMemoryRegion(deviceMemoryMngr);
+    CreateImage(device, desc, sharedQueueFamilies);
+    imageWrapper_.AllocateMemoryRegion(deviceMemoryMngr, ((desc.flags & TextureFlags::Transient) != 0));
+}
+
+// Returns the image aspect to sample the specified format, i.e. only the depth aspect for depth-stencil formats.
+static VkImageAspectFlags GetVkImageViewAspect(const Format format)
+{
+    if (IsDepthStencilFormat(format))
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+    return VK_IMAGE_ASPECT_COLOR_BIT;
+}
+
+VKTexture::VKTexture(const VKPtr<VkDevice>& device, const VKTexture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture         { desc.type                  },
+    device_         { device                     },
+    imageWrapper_   { device                     },
+    imageView_      { device, vkDestroyImageView },
+    sharedTexture_  { &sharedTexture             },
+    format_         { VKTypes::Map(desc.format)  }
+{
+    /* Store parameters of the subresource this view refers to */
+    const auto& sharedExtent = sharedTexture.GetVkExtent();
+
+    extent_.width   = std::max(1u, sharedExtent.width  >> desc.subresource.baseMipLevel);
+    extent_.height  = std::max(1u, sharedExtent.height >> desc.subresource.baseMipLevel);
+    extent_.depth   = std::max(1u, sharedExtent.depth  >> desc.subresource.baseMipLevel);
+    numMipLevels_   = desc.subresource.numMipLevels;
+    numArrayLayers_ = desc.subresource.numArrayLayers;
+
+    /* Create image view with component swizzle for the image of the shared texture */
+    VkComponentMapping components;
+    {
+        components.r = VKTypes::Map(desc.swizzle.r);
+        components.g = VKTypes::Map(desc.swizzle.g);
+        components.b = VKTypes::Map(desc.swizzle.b);
+        components.a = VKTypes::Map(desc.swizzle.a);
+    }
+    sharedTexture.imageWrapper_.CreateVkImageView(
+        device,
+        VKTypes::Map(desc.type),
+        format_,
+        GetVkImageViewAspect(desc.format),
+        desc.subresource.baseMipLevel,
+        desc.subresource.numMipLevels,
+        desc.subresource.baseArrayLayer,
+        desc.subresource.numArrayLayers,
+        imageView_.ReleaseAndGetAddressOf(),
+        &components
+    );
 }
 
 Extent3D VKTexture::QueryMipExtent(std::uint32_t mipLevel) const
@@ -112,6 +160,32 @@ TextureDescriptor VKTexture::QueryDesc() const
     return texDesc;
 }
 
+void VKTexture::SetName(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    if (sharedTexture_ != nullptr)
+    {
+        /* Only name the image view of a texture view, since its image belongs to the shared texture */
+        VKSetObjectName(device_, VK_OBJECT_TYPE_IMAGE_VIEW, reinterpret_cast<std::uint64_t>(GetVkImageView()), name);
+    }
+    else
+    {
+        VKSetObjectName(device_, VK_OBJECT_TYPE_IMAGE, reinterpret_cast<std::uint64_t>(GetVkImage()), name);
+    }
+    #endif
+}
+
+// Returns the image view type for framebuffer attachments, i.e. faces of cube textures are attached as 2D-array views.
+static VkImageViewType GetAttachmentVkImageViewType(const TextureType type)
+{
+    switch (type)
+    {
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray: return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        default:                            return VKTypes::Map(type);
+    }
+}
+
 void VKTexture::CreateImageView(
     VkDevice        device,
     std::uint32_t   baseMipLevel,
@@ -122,9 +196,9 @@ void VKTexture::CreateImageView(
 {
     imageWrapper_.CreateVkImageView(
         device,
-        VKTypes::Map(GetType()),
+        GetAttachmentVkImageViewType(GetType()),
         format_,
-        VK_IMAGE_ASPECT_COLOR_BIT,
+        VKGetImageAspectByFormat(format_),
         baseMipLevel,
         numMipLevels,
         baseArrayLayer,
@@ -135,7 +209,61 @@ void VKTexture::CreateImageView(
 
 void VKTexture::CreateInternalImageView(VkDevice device)
 {
-    CreateImageView(device, 0, GetNumMipLevels(), 0, GetNumArrayLayers(), imageView_.ReleaseAndGetAddressOf());
+    /* Shaders can only sample a single aspect, i.e. only the depth aspect of depth-stencil formats */
+    auto aspectMask = VKGetImageAspectByFormat(format_);
+    if ((aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT) != 0)
+        aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+    imageWrapper_.CreateVkImageView(
+        device,
+        VKTypes::Map(GetType()),
+        format_,
+        aspectMask,
+        0,
+        GetNumMipLevels(),
+        0,
+        GetNumArrayLayers(),
+        imageView_.ReleaseAndGetAddressOf()
+    );
+}
+
+void VKTexture::GetSubresourceRegion(
+    std::uint32_t               mipLevel,
+    const Offset3D&             offset,
+    const Extent3D&             extent,
+    VkImageSubresourceLayers&   subresource,
+    VkOffset3D&                 imageOffset,
+    VkExtent3D&                 imageExtent) const
+{
+    subresource.aspectMask  = VKGetImageAspectByFormat(format_);
+    subresource.mipLevel    = mipLevel;
+
+    switch (GetType())
+    {
+        case TextureType::Texture1DArray:
+            subresource.baseArrayLayer  = static_cast<std::uint32_t>(offset.y);
+            subresource.layerCount      = extent.height;
+            imageOffset                 = { offset.x, 0, 0 };
+            imageExtent                 = { extent.width, 1u, 1u };
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray: /*pass*/
+        case TextureType::Texture2DMSArray:
+            subresource.baseArrayLayer  = static_cast<std::uint32_t>(offset.z);
+            subresource.layerCount      = extent.depth;
+            imageOffset                 = { offset.x, offset.y, 0 };
+            imageExtent                 = { extent.width, extent.height, 1u };
+            break;
+
+        default:
+            subresource.baseArrayLayer  = 0;
+            subresource.layerCount      = 1;
+            imageOffset                 = { offset.x, offset.y, offset.z };
+            imageExtent                 = { extent.width, extent.height, extent.depth };
+            break;
+    }
 }
 
 
@@ -151,6 +279,8 @@ static VkImageCreateFlags GetVkImageCreateFlags(const TextureDescriptor& desc)
         createFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
     if (desc.type == TextureType::Texture2DArray || desc.type == TextureType::Texture2DMSArray)
         createFlags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT_KHR;
+    if ((desc.flags & TextureFlags::MutableFormat) != 0)
+        createFlags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
 
     return createFlags;
 }
@@ -238,11 +368,20 @@ static VkSampleCountFlagBits GetVkImageSampleCountFlags(const TextureDescriptor&
 
 static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
 {
-    VkImageUsageFlags usageFlags = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    /*
+    Transient attachments only allow attachment usage, so they are never copied.
+    INPUT_ATTACHMENT_BIT is required for the shader-read layout that all textures rest in between render passes.
+    */
+    if ((desc.flags & TextureFlags::Transient) != 0)
+    {
+        if (IsDepthStencilFormat(desc.format))
+            return (VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT);
+        else
+            return (VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT);
+    }
 
-    /* Enable TRANSFER_SRC_BIT image usage when MIP-maps are enabled */
-    if (IsMipMappedTexture(desc))
-        usageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    /* Images can always be the source and destination of copy commands (TRANSFER_SRC_BIT is also required to generate MIP-maps) */
+    VkImageUsageFlags usageFlags = (VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
 
     /* Enable either color or depth-stencil ATTACHMENT_BIT image usage when attachment usage is enabled */
     if ((desc.flags & TextureFlags::AttachmentUsage) != 0)
@@ -264,7 +403,7 @@ static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
     return usageFlags;
 }
 
-void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
+void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc, const std::vector<std::uint32_t>* sharedQueueFamilies)
 {
     /* Setup texture parameters */
     auto imageType  = GetVkImageType(desc.type);
@@ -283,7 +422,8 @@ void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
         numArrayLayers_,
         GetVkImageCreateFlags(desc),
         GetVkImageSampleCountFlags(desc),
-        GetVkImageUsageFlags(desc)
+        GetVkImageUsageFlags(desc),
+        sharedQueueFamilies
     );
 }
 
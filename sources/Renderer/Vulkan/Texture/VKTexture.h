@@ -31,12 +31,23 @@ class VKTexture final : public Texture
         VKTexture(
             const VKPtr<VkDevice>& device,
             VKDeviceMemoryManager& deviceMemoryMngr,
-            const TextureDescriptor& desc
+            const TextureDescriptor& desc,
+            const std::vector<std::uint32_t>* sharedQueueFamilies = nullptr
+        );
+
+        // Creates a texture view that shares the image of the specified texture. The view has its own image view but no image or device memory.
+        VKTexture(
+            const VKPtr<VkDevice>& device,
+            const VKTexture& sharedTexture,
+            const TextureViewDescriptor& desc
         );
 
         Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
         TextureDescriptor QueryDesc() const override;
 
+        void SetName(const char* name) override;
+
+        // Creates an image view with all aspects of the texture format for the specified subresource, e.g. for framebuffer attachments.
         void CreateImageView(
             VkDevice        device,
             std::uint32_t   baseMipLevel,
@@ -46,12 +57,23 @@ class VKTexture final : public Texture
             VkImageView*    imageViewRef
         );
 
+        // Creates the image view for sampling the entire texture (only the depth aspect for depth-stencil formats).
         void CreateInternalImageView(VkDevice device);
 
-        // Returns the Vulkan image object.
+        // Converts the texture region into Vulkan image subresource layers, offset, and extent (array layers are specified by the Z component, or Y for 1D-array textures).
+        void GetSubresourceRegion(
+            std::uint32_t               mipLevel,
+            const Offset3D&             offset,
+            const Extent3D&             extent,
+            VkImageSubresourceLayers&   subresource,
+            VkOffset3D&                 imageOffset,
+            VkExtent3D&                 imageExtent
+        ) const;
+
+        // Returns the Vulkan image object (for texture views, this is the image of the shared texture).
         inline VkImage GetVkImage() const
         {
-            return imageWrapper_.GetVkImage();
+            return (sharedTexture_ != nullptr ? sharedTexture_->GetVkImage() : imageWrapper_.GetVkImage());
         }
 
         // Returns the internal Vulkan image view object (created with 'CreateInternalImageView').
@@ -84,7 +106,7 @@ class VKTexture final : public Texture
             return numArrayLayers_;
         }
 
-        // Returns the region of the hardware device memory.
+        // Returns the region of the hardware device memory (null for texture views).
         inline VKDeviceMemoryRegion* GetMemoryRegion() const
         {
             return imageWrapper_.GetMemoryRegion();
@@ -92,10 +114,12 @@ class VKTexture final : public Texture
 
     private:
 
-        void CreateImage(VkDevice device, const TextureDescriptor& desc);
+        void CreateImage(VkDevice device, const TextureDescriptor& desc, const std::vector<std::uint32_t>* sharedQueueFamilies);
 
+        VkDevice                device_         = VK_NULL_HANDLE;
         VKImageWrapper          imageWrapper_;
         VKPtr<VkImageView>      imageView_;
+        const VKTexture*        sharedTexture_  = nullptr;
 
         VkFormat                format_         = VK_FORMAT_UNDEFINED;
         VkExtent3D              extent_;
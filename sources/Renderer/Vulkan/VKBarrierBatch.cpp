@@ -0,0 +1,232 @@
+/*
+ * VKBarrierBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKBarrierBatch.h"
+
+
+namespace LLGL
+{
+
+
+/* Shader stages that are always supported, i.e. without geometry or tessellation shader features */
+static const VkPipelineStageFlags g_shaderStages =
+(
+    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT     |
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT   |
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+);
+
+// Returns the memory access of the specified layout.
+static VkAccessFlags GetLayoutAccessMask(VkImageLayout layout)
+{
+    switch (layout)
+    {
+        case VK_IMAGE_LAYOUT_UNDEFINED:                         return 0;
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:              return VK_ACCESS_TRANSFER_READ_BIT;
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:              return VK_ACCESS_TRANSFER_WRITE_BIT;
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:          return VK_ACCESS_SHADER_READ_BIT;
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:          return (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:  return (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:                   return VK_ACCESS_MEMORY_READ_BIT;
+        default:                                                return (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+    }
+}
+
+// Returns the pipeline stages that access an image in the specified layout.
+static VkPipelineStageFlags GetLayoutStageMask(VkImageLayout layout, bool srcStage)
+{
+    switch (layout)
+    {
+        case VK_IMAGE_LAYOUT_UNDEFINED:                         return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:              return VK_PIPELINE_STAGE_TRANSFER_BIT;
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:              return VK_PIPELINE_STAGE_TRANSFER_BIT;
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:          return g_shaderStages;
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:          return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:  return (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:                   return (srcStage ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        default:                                                return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+}
+
+static bool IsRangeOverlapping(std::uint32_t base0, std::uint32_t count0, std::uint32_t base1, std::uint32_t count1)
+{
+    return (base0 < base1 + count1 && base1 < base0 + count0);
+}
+
+static bool IsSubresourceRangeOverlapping(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+{
+    return
+    (
+        (lhs.aspectMask & rhs.aspectMask) != 0                                                      &&
+        IsRangeOverlapping(lhs.baseMipLevel, lhs.levelCount, rhs.baseMipLevel, rhs.levelCount)      &&
+        IsRangeOverlapping(lhs.baseArrayLayer, lhs.layerCount, rhs.baseArrayLayer, rhs.layerCount)
+    );
+}
+
+static bool IsSubresourceRangeEqual(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+{
+    return
+    (
+        lhs.aspectMask      == rhs.aspectMask       &&
+        lhs.baseMipLevel    == rhs.baseMipLevel     &&
+        lhs.levelCount      == rhs.levelCount       &&
+        lhs.baseArrayLayer  == rhs.baseArrayLayer   &&
+        lhs.layerCount      == rhs.layerCount
+    );
+}
+
+void VKBarrierBatch::TransitionImageLayout(
+    VkImage                         image,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    const VkImageSubresourceRange&  subresourceRange)
+{
+    /* Search pending transitions of the current barrier command for the same image */
+    const std::size_t first = (splits_.empty() ? 0 : splits_.back());
+
+    for (auto i = first; i < imageBarriers_.size(); ++i)
+    {
+        auto& barrier = imageBarriers_[i];
+
+        if (barrier.image != image || !IsSubresourceRangeOverlapping(barrier.subresourceRange, subresourceRange))
+            continue;
+
+        if (IsSubresourceRangeEqual(barrier.subresourceRange, subresourceRange) && barrier.newLayout == oldLayout)
+        {
+            if (barrier.oldLayout == newLayout)
+            {
+                /* Replace round trip by a memory barrier, since the commands before and after this batch might still depend on each other */
+                InsertMemoryBarrier(
+                    GetLayoutStageMask(barrier.oldLayout, true),
+                    GetLayoutAccessMask(barrier.oldLayout),
+                    GetLayoutStageMask(newLayout, false),
+                    GetLayoutAccessMask(newLayout)
+                );
+                imageBarriers_.erase(imageBarriers_.begin() + i);
+            }
+            else
+            {
+                /* Merge consecutive transitions into one */
+                barrier.newLayout       = newLayout;
+                barrier.dstAccessMask   = GetLayoutAccessMask(newLayout);
+            }
+            return;
+        }
+
+        /* Overlapping transitions must be recorded with separate barrier commands */
+        splits_.push_back(imageBarriers_.size());
+        break;
+    }
+
+    /* Append new image barrier */
+    VkImageMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = GetLayoutAccessMask(oldLayout);
+        barrier.dstAccessMask       = GetLayoutAccessMask(newLayout);
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image               = image;
+        barrier.subresourceRange    = subresourceRange;
+    }
+    imageBarriers_.push_back(barrier);
+}
+
+void VKBarrierBatch::InsertMemoryBarrier(
+    VkPipelineStageFlags    srcStageMask,
+    VkAccessFlags           srcAccessMask,
+    VkPipelineStageFlags    dstStageMask,
+    VkAccessFlags           dstAccessMask)
+{
+    memorySrcStageMask_     |= srcStageMask;
+    memorySrcAccessMask_    |= srcAccessMask;
+    memoryDstStageMask_     |= dstStageMask;
+    memoryDstAccessMask_    |= dstAccessMask;
+    hasMemoryBarrier_       = true;
+}
+
+void VKBarrierBatch::Flush(VkCommandBuffer commandBuffer)
+{
+    if (IsEmpty())
+        return;
+
+    /* Record one barrier command per split; the memory barrier is recorded with the last one */
+    std::size_t first = 0;
+
+    for (auto split : splits_)
+    {
+        if (split > first)
+            RecordBarriers(commandBuffer, first, split, false);
+        first = split;
+    }
+
+    RecordBarriers(commandBuffer, first, imageBarriers_.size(), hasMemoryBarrier_);
+
+    /* Reset batch */
+    imageBarriers_.clear();
+    splits_.clear();
+
+    memorySrcStageMask_     = 0;
+    memoryDstStageMask_     = 0;
+    memorySrcAccessMask_    = 0;
+    memoryDstAccessMask_    = 0;
+    hasMemoryBarrier_       = false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKBarrierBatch::RecordBarriers(VkCommandBuffer commandBuffer, std::size_t first, std::size_t last, bool includeMemoryBarrier)
+{
+    if (first == last && !includeMemoryBarrier)
+        return;
+
+    /* Accumulate pipeline stages of all barriers */
+    VkPipelineStageFlags srcStageMask = 0;
+    VkPipelineStageFlags dstStageMask = 0;
+
+    for (auto i = first; i < last; ++i)
+    {
+        srcStageMask |= GetLayoutStageMask(imageBarriers_[i].oldLayout, true);
+        dstStageMask |= GetLayoutStageMask(imageBarriers_[i].newLayout, false);
+    }
+
+    VkMemoryBarrier memoryBarrier;
+
+    if (includeMemoryBarrier)
+    {
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = memorySrcAccessMask_;
+        memoryBarrier.dstAccessMask = memoryDstAccessMask_;
+
+        srcStageMask |= memorySrcStageMask_;
+        dstStageMask |= memoryDstStageMask_;
+    }
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        (srcStageMask != 0 ? srcStageMask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+        (dstStageMask != 0 ? dstStageMask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+        0,
+        (includeMemoryBarrier ? 1u : 0u), (includeMemoryBarrier ? &memoryBarrier : nullptr),
+        0, nullptr,
+        static_cast<std::uint32_t>(last - first), (last > first ? &(imageBarriers_[first]) : nullptr)
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,82 @@
+/*
+ * VKBarrierBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_BARRIER_BATCH_H
+#define LLGL_VK_BARRIER_BATCH_H
+
+
+#include "Vulkan.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Collects image layout transitions and memory barriers, which are recorded with a single 'vkCmdPipelineBarrier' call by 'Flush'.
+Access masks and pipeline stages are derived from the image layouts.
+Consecutive transitions of the same subresource range are merged (A -> B -> C becomes A -> C), and round trips (A -> B -> A) are
+replaced by a memory barrier. Transitions of overlapping but different subresource ranges are split into separate barrier calls,
+since the order of transitions within a single call is undefined.
+*/
+class VKBarrierBatch
+{
+
+    public:
+
+        // Appends a layout transition for the specified subresource range of an image.
+        void TransitionImageLayout(
+            VkImage                         image,
+            VkImageLayout                   oldLayout,
+            VkImageLayout                   newLayout,
+            const VkImageSubresourceRange&  subresourceRange
+        );
+
+        // Appends a global memory barrier. All memory barriers of a batch are combined into one.
+        void InsertMemoryBarrier(
+            VkPipelineStageFlags    srcStageMask,
+            VkAccessFlags           srcAccessMask,
+            VkPipelineStageFlags    dstStageMask,
+            VkAccessFlags           dstAccessMask
+        );
+
+        // Records all pending barriers into the specified command buffer and clears the batch.
+        void Flush(VkCommandBuffer commandBuffer);
+
+        // Returns true if there are no pending barriers.
+        inline bool IsEmpty() const
+        {
+            return (imageBarriers_.empty() && !hasMemoryBarrier_);
+        }
+
+    private:
+
+        // Records the image barriers in the range [first, last) with a single barrier command, optionally including the memory barrier.
+        void RecordBarriers(VkCommandBuffer commandBuffer, std::size_t first, std::size_t last, bool includeMemoryBarrier);
+
+        std::vector<VkImageMemoryBarrier>   imageBarriers_;
+        std::vector<std::size_t>            splits_;                        // Indices into 'imageBarriers_' where a new barrier command begins
+
+        VkPipelineStageFlags                memorySrcStageMask_     = 0;
+        VkPipelineStageFlags                memoryDstStageMask_     = 0;
+        VkAccessFlags                       memorySrcAccessMask_    = 0;
+        VkAccessFlags                       memoryDstAccessMask_    = 0;
+        bool                                hasMemoryBarrier_       = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
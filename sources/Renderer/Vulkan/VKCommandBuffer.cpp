@@ -10,15 +10,25 @@
 #include "VKTypes.h"
 #include "RenderState/VKGraphicsPipeline.h"
 #include "RenderState/VKComputePipeline.h"
+#include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKResourceHeap.h"
 #include "RenderState/VKQuery.h"
+#include "RenderState/VKQueryHeap.h"
+#include "RenderState/VKAccelerationStructure.h"
+#include "RenderState/VKRenderPassCache.h"
 #include "Texture/VKSampler.h"
+#include "Texture/VKTexture.h"
 #include "Texture/VKRenderTarget.h"
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
 #include "Buffer/VKIndexBuffer.h"
+#include "Ext/VKExtensions.h"
 #include "../CheckedCast.h"
+#include "../../Core/Helper.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -27,19 +37,86 @@ namespace LLGL
 
 static const std::uint32_t g_maxNumViewportsPerBatch = 16;
 
-VKCommandBuffer::VKCommandBuffer(const VKPtr<VkDevice>& device, VkQueue graphicsQueue, std::size_t bufferCount, const QueueFamilyIndices& queueFamilyIndices) :
+VKCommandBuffer::VKCommandBuffer(
+    const VKPtr<VkDevice>&                  device,
+    std::size_t                             bufferCount,
+    const QueueFamilyIndices&               queueFamilyIndices,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    float                                   timestampPeriod,
+    VkDeviceSize                            constantBufferOffsetAlignment,
+    bool                                    multiDrawIndirect,
+    StatisticsCounter&                      statistics,
+    const QueueType                         queueType,
+    long                                    flags)
+:
+    device_             { device                                        },
+    statistics_         { statistics                                    },
+    commandPool_        { device, vkDestroyCommandPool                  },
+    queuePresentFamily_ { queueFamilyIndices.presentFamily              },
+    timerQueryPool_     { device, vkDestroyQueryPool                    },
+    timestampPeriod_    { timestampPeriod                               },
+    statisticsQueryPool_{ device, vkDestroyQueryPool                    },
+    timerStatistics_    { ((flags & CommandBufferFlags::TimerScopeStatistics) != 0) },
+    memoryProperties_   { &memoryProperties                             },
+    transientAlignment_ { std::max<VkDeviceSize>(1, constantBufferOffsetAlignment) },
+    transientMemory_    { device, vkFreeMemory                          },
+    multiDrawIndirect_  { multiDrawIndirect                             },
+    queueType_          { queueType                                     }
+{
+    CreateCommandPool(queueType == QueueType::Compute ? queueFamilyIndices.computeFamily : queueFamilyIndices.graphicsFamily);
+    CreateCommandBuffers(bufferCount);
+    CreateRecordingFences(bufferCount);
+    CreateTimerQueryPool();
+    if (timerStatistics_)
+        CreateStatisticsQueryPool();
+    executedSecondaries_.resize(bufferCount);
+    transientSlotSubmissions_.resize(bufferCount, 0);
+
+    /* Create one pool of transient descriptor sets for each primary command buffer */
+    transientDescriptorPools_.reserve(bufferCount);
+    for (std::size_t i = 0; i < bufferCount; ++i)
+        transientDescriptorPools_.emplace_back(MakeUnique<VKTransientDescriptorPool>(device));
+
+    /* Compute command buffers are not bound to a render context, so their first recording begins immediately */
+    if (queueType == QueueType::Compute)
+    {
+        SetFrameIndex(0);
+        BeginCommandBuffer();
+    }
+}
+
+VKCommandBuffer::VKCommandBuffer(const VKPtr<VkDevice>& device, const QueueFamilyIndices& queueFamilyIndices, bool multiDrawIndirect, StatisticsCounter& statistics) :
     device_             { device                           },
+    statistics_         { statistics                       },
     commandPool_        { device, vkDestroyCommandPool     },
-    queuePresentFamily_ { queueFamilyIndices.presentFamily }
+    commandBuffer_      { VK_NULL_HANDLE                   },
+    recordingFence_     { VK_NULL_HANDLE                   },
+    queuePresentFamily_ { queueFamilyIndices.presentFamily },
+    timerQueryPool_     { device, vkDestroyQueryPool       },
+    statisticsQueryPool_{ device, vkDestroyQueryPool       },
+    multiDrawIndirect_  { multiDrawIndirect                }
 {
-    CreateCommandPool(queueFamilyIndices.graphicsFamily);
-    CreateCommandBuffers(bufferCount);
-    CreateRecordingFences(graphicsQueue, bufferCount);
+    secondaryPool_ = std::make_shared<VKSecondaryCommandPool>(device, queueFamilyIndices.graphicsFamily);
+
+    /* Secondary command buffers only keep track of their current recording */
+    commandBufferActiveList_.resize(1);
+    commandBufferActiveIt_ = commandBufferActiveList_.begin();
 }
 
 VKCommandBuffer::~VKCommandBuffer()
 {
-    vkFreeCommandBuffers(device_, commandPool_, static_cast<std::uint32_t>(commandBufferList_.size()), commandBufferList_.data());
+    if (IsSecondary())
+    {
+        /* Release current recording; it remains alive as long as any primary command buffer references it */
+        if (commandBuffer_ != VK_NULL_HANDLE)
+            secondaryPool_->Release(commandBuffer_);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < executedSecondaries_.size(); ++i)
+            ReleaseExecutedSecondaries(i);
+        vkFreeCommandBuffers(device_, commandPool_, static_cast<std::uint32_t>(commandBufferList_.size()), commandBufferList_.data());
+    }
 }
 
 /* ----- Configuration ----- */
@@ -82,7 +159,15 @@ void VKCommandBuffer::SetViewport(const Viewport& viewport)
         /* Convert viewport to VkViewport type */
         VkViewport viewportVK;
         VKTypes::Convert(viewportVK, viewport);
+
+        /* Ignore redundant viewport updates */
+        if (bindingCache_.viewportValid && ::memcmp(&bindingCache_.viewport, &viewportVK, sizeof(viewportVK)) == 0)
+            return;
+
         vkCmdSetViewport(commandBuffer_, 0, 1, &viewportVK);
+
+        bindingCache_.viewport      = viewportVK;
+        bindingCache_.viewportValid = true;
     }
 }
 
@@ -110,6 +195,9 @@ void VKCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* v
             vkCmdSetViewport(commandBuffer_, first, count, viewportsVK);
         }
     }
+
+    /* Only single viewports are cached */
+    bindingCache_.viewportValid = false;
 }
 
 void VKCommandBuffer::SetScissor(const Scissor& scissor)
@@ -118,7 +206,15 @@ void VKCommandBuffer::SetScissor(const Scissor& scissor)
     {
         VkRect2D scissorVK;
         VKTypes::Convert(scissorVK, scissor);
+
+        /* Ignore redundant scissor updates */
+        if (bindingCache_.scissorValid && ::memcmp(&bindingCache_.scissor, &scissorVK, sizeof(scissorVK)) == 0)
+            return;
+
         vkCmdSetScissor(commandBuffer_, 0, 1, &scissorVK);
+
+        bindingCache_.scissor       = scissorVK;
+        bindingCache_.scissorValid  = true;
     }
 }
 
@@ -138,6 +234,9 @@ void VKCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scis
 
             vkCmdSetScissor(commandBuffer_, first, count, scissorsVK);
         }
+
+        /* Only single scissors are cached */
+        bindingCache_.scissorValid = false;
     }
 }
 
@@ -178,6 +277,13 @@ static VkImageAspectFlags GetDepthStencilAspectMask(long flags)
 
 void VKCommandBuffer::Clear(long flags)
 {
+    /* Clear attachments with the load operations of the render pass, if nothing has been recorded since SetRenderTarget */
+    if (renderPassPending_)
+    {
+        BeginPendingRenderPass(flags);
+        return;
+    }
+
     VkClearAttachment attachments[g_maxNumAttachments];
 
     std::uint32_t numAttachments = 0;
@@ -262,18 +368,37 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 /* ----- Input Assembly ------ */
 
 void VKCommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    SetVertexBuffer(buffer, 0);
+}
+
+void VKCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    if (bindingCache_.vertexBuffers == &bufferVK && bindingCache_.vertexBufferOffset == offset)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
     VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
-    VkDeviceSize offsets[] = { 0 };
+    VkDeviceSize offsets[] = { offset };
 
     vkCmdBindVertexBuffers(commandBuffer_, 0, 1, buffers, offsets);
+
+    bindingCache_.vertexBuffers         = &bufferVK;
+    bindingCache_.vertexBufferOffset    = offset;
 }
 
 void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& bufferArrayVK = LLGL_CAST(VKBufferArray&, bufferArray);
+
+    if (bindingCache_.vertexBuffers == &bufferArrayVK)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
     vkCmdBindVertexBuffers(
         commandBuffer_,
         0,
@@ -281,12 +406,36 @@ void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         bufferArrayVK.GetBuffers().data(),
         bufferArrayVK.GetOffsets().data()
     );
+
+    bindingCache_.vertexBuffers         = &bufferArrayVK;
+    bindingCache_.vertexBufferOffset    = 0;
 }
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
     auto& indexBufferVK = LLGL_CAST(VKIndexBuffer&, buffer);
-    vkCmdBindIndexBuffer(commandBuffer_, indexBufferVK.GetVkBuffer(), 0, indexBufferVK.GetIndexType());
+    BindIndexBuffer(indexBufferVK.GetVkBuffer(), 0, indexBufferVK.GetIndexType());
+}
+
+void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset)
+{
+    auto& indexBufferVK = LLGL_CAST(VKIndexBuffer&, buffer);
+    BindIndexBuffer(indexBufferVK.GetVkBuffer(), offset, VKTypes::Map(format.GetDataType()));
+}
+
+//private
+void VKCommandBuffer::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+    if (bindingCache_.indexBuffer == buffer && bindingCache_.indexBufferOffset == offset && bindingCache_.indexType == indexType)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    vkCmdBindIndexBuffer(commandBuffer_, buffer, offset, indexType);
+
+    bindingCache_.indexBuffer       = buffer;
+    bindingCache_.indexBufferOffset = offset;
+    bindingCache_.indexType         = indexType;
 }
 
 /* ----- Stream Output Buffers ------ */
@@ -311,87 +460,327 @@ void VKCommandBuffer::EndStreamOutput()
     //todo
 }
 
+void VKCommandBuffer::PauseStreamOutput()
+{
+    //todo
+}
+
+void VKCommandBuffer::ResumeStreamOutput()
+{
+    //todo
+}
+
 /* ----- Resource Heaps ----- */
 
 //private
-void VKCommandBuffer::BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet)
+void VKCommandBuffer::BindResourceHeap(
+    VKResourceHeap&         resourceHeapVK,
+    VkPipelineBindPoint     bindingPoint,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
+    /* Ignore redundant descriptor set bindings (dynamic offsets are not cached) */
+    const bool isGraphics = (bindingPoint == VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+    auto& cachedDescriptorSet   = (isGraphics ? bindingCache_.graphicsDescriptorSet : bindingCache_.computeDescriptorSet);
+    auto& cachedFirstSet        = (isGraphics ? bindingCache_.graphicsFirstSet      : bindingCache_.computeFirstSet     );
+
+    const auto descriptorSet = resourceHeapVK.GetVkDescriptorSet();
+
+    if (numDynamicOffsets == 0 && cachedDescriptorSet == descriptorSet && cachedFirstSet == firstSet)
+        return;
+
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    /* Dynamic offsets are already in the order of the binding numbers, as required by Vulkan */
     vkCmdBindDescriptorSets(
         commandBuffer_,
         bindingPoint,
         resourceHeapVK.GetVkPipelineLayout(),
         firstSet,
-        static_cast<std::uint32_t>(resourceHeapVK.GetVkDescriptorSets().size()),
-        resourceHeapVK.GetVkDescriptorSets().data(),
-        0,
-        nullptr
+        1,
+        &descriptorSet,
+        numDynamicOffsets,
+        dynamicOffsets
     );
+
+    cachedDescriptorSet = (numDynamicOffsets == 0 ? descriptorSet : VK_NULL_HANDLE);
+    cachedFirstSet      = firstSet;
 }
 
-void VKCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void VKCommandBuffer::SetGraphicsResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
     auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
-    BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_GRAPHICS, firstSet);
+    BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_GRAPHICS, firstSet, numDynamicOffsets, dynamicOffsets);
 }
 
-void VKCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
+void VKCommandBuffer::SetComputeResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
     auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
-    BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_COMPUTE, firstSet);
+    BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_COMPUTE, firstSet, numDynamicOffsets, dynamicOffsets);
+}
+
+/* ----- Constant Buffers ------ */
+
+void VKCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    VKDescriptorInfo info;
+    {
+        info.bufferInfo.buffer  = bufferVK.GetVkBuffer();
+        info.bufferInfo.offset  = 0;
+        info.bufferInfo.range   = VK_WHOLE_SIZE;
+    }
+    BindResource(&ResourceBindings::constantBuffers, slot, stageFlags, info);
+}
+
+void VKCommandBuffer::SetConstantBufferRange(
+    Buffer&         buffer,
+    std::uint32_t   slot,
+    std::uint64_t   offset,
+    std::uint64_t   size,
+    long            stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    VKDescriptorInfo info;
+    {
+        info.bufferInfo.buffer  = bufferVK.GetVkBuffer();
+        info.bufferInfo.offset  = offset;
+        info.bufferInfo.range   = size;
+    }
+    BindResource(&ResourceBindings::constantBuffers, slot, stageFlags, info);
+}
+
+/* ----- Storage Buffers ----- */
+
+void VKCommandBuffer::SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    VKDescriptorInfo info;
+    {
+        info.bufferInfo.buffer  = bufferVK.GetVkBuffer();
+        info.bufferInfo.offset  = 0;
+        info.bufferInfo.range   = VK_WHOLE_SIZE;
+    }
+    BindResource(&ResourceBindings::storageBuffers, slot, stageFlags, info);
+}
+
+/* ----- Textures ----- */
+
+void VKCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    VKDescriptorInfo info;
+    {
+        info.imageInfo.sampler      = VK_NULL_HANDLE;
+        info.imageInfo.imageView    = textureVK.GetVkImageView();
+        info.imageInfo.imageLayout  = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    BindResource(&ResourceBindings::textures, slot, stageFlags, info);
+}
+
+/* ----- Samplers ----- */
+
+void VKCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
+{
+    LLGL_STATISTICS_INC(resourceBindings);
+
+    auto& samplerVK = LLGL_CAST(VKSampler&, sampler);
+
+    VKDescriptorInfo info;
+    {
+        info.imageInfo.sampler      = samplerVK.GetVkSampler();
+        info.imageInfo.imageView    = VK_NULL_HANDLE;
+        info.imageInfo.imageLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    BindResource(&ResourceBindings::samplers, slot, stageFlags, info);
+}
+
+/* ----- Constants ----- */
+
+void VKCommandBuffer::SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data)
+{
+    /* Push constants for all stages of the push constant range, as required by the Vulkan spec */
+    if ((stageFlags & StageFlags::ComputeStage) != 0)
+    {
+        if (computeConstantsStages_ != 0)
+            vkCmdPushConstants(commandBuffer_, computePipelineLayout_, computeConstantsStages_, offset, size, data);
+    }
+    else
+    {
+        if (graphicsConstantsStages_ != 0)
+            vkCmdPushConstants(commandBuffer_, graphicsPipelineLayout_, graphicsConstantsStages_, offset, size, data);
+    }
+}
+
+/* ----- Transient Memory ----- */
+
+TransientAllocation VKCommandBuffer::AllocateTransient(std::uint64_t size, std::uint64_t alignment)
+{
+    /* Secondary command buffers are not submitted by themselves, so their transient memory could not be tracked */
+    if (IsSecondary())
+        throw std::runtime_error("transient memory is not supported for secondary Vulkan command buffers");
+
+    if (!transientBuffer_)
+        CreateTransientBuffer();
+
+    /* Allocate range from ring buffer and wait for the oldest primary command buffer while the ring is full */
+    std::uint64_t offset = 0;
+    auto waitFunc = [this](std::uint64_t submission)
+    {
+        WaitForTransientMemory(submission);
+    };
+    if (!transientRing_.AllocateOrWait(size, (alignment > 0 ? alignment : transientAlignment_), offset, waitFunc))
+        throw std::out_of_range("transient memory allocations of a single Vulkan command buffer submission exceed ring buffer size");
+
+    TransientAllocation allocation;
+    {
+        allocation.data     = transientData_ + offset;
+        allocation.buffer   = transientBuffer_.get();
+        allocation.offset   = offset;
+    }
+    return allocation;
 }
 
 /* ----- Render Targets ----- */
 
 void VKCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
-    auto& renderTargetVK = LLGL_CAST(VKRenderTarget&, renderTarget);
+    BeginRenderPass(renderTarget);
+}
 
-    /* Begin command buffer and render pass */
-    if (!IsCommandBufferActive())
-        BeginCommandBuffer();
+void VKCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+{
+    BeginRenderPass(renderContext);
+}
 
-    /* Set new render pass */
-    SetRenderPass(
-        renderTargetVK.GetVkRenderPass(),
-        renderTargetVK.GetVkFramebuffer(),
-        renderTargetVK.GetVkExtent()
-    );
+void VKCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    LLGL_STATISTICS_INC(renderPasses);
+
+    auto& renderTargetVK = LLGL_CAST(VKRenderTarget&, renderTarget);
 
     /* Store information about framebuffer attachments */
     numColorAttachments_    = (renderTargetVK.GetNumColorAttachments());
     hasDSVAttachment_       = (renderTargetVK.HasDepthAttachment() || renderTargetVK.HasStencilAttachment());
+
+    if (IsSecondary())
+    {
+        /* Begin recording within the render pass of the render target; load and store operations are applied by the primary command buffer */
+        BeginSecondaryCommandBuffer(
+            renderTargetVK.GetVkRenderPass(),
+            renderTargetVK.GetVkFramebuffer(),
+            renderTargetVK.GetVkExtent()
+        );
+    }
+    else
+    {
+        /* Begin command buffer and render pass */
+        if (!IsCommandBufferActive())
+            BeginCommandBuffer();
+
+        BeginRenderPassWithSet(
+            renderTargetVK.GetRenderPassSet(),
+            renderTargetVK.GetVkFramebuffer(),
+            renderTargetVK.GetVkExtent(),
+            renderPass,
+            numClearValues,
+            clearValues
+        );
+    }
 }
 
 /*
 TODO:
 BeginCommandBuffer at this point is only a workaround!
-Maybe it can be integrated into a Begin/EndRenderPass function with a new interface "RenderPass".
 */
-void VKCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+void VKCommandBuffer::BeginRenderPass(
+    RenderContext&      renderContext,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
 {
-    auto& renderContextVK = LLGL_CAST(VKRenderContext&, renderContext);
-
-    //TODO:
-    //  this must be done for all command buffers at the end of the "VKRenderContext::Present" function
-    /* Switch internal command buffer for the respective render context presentation index */
-    renderContextVK.SetPresentCommandBuffer(this);
-
-    /* Begin command buffer and render pass */
-    if (!IsCommandBufferActive())
-        BeginCommandBuffer();
+    LLGL_STATISTICS_INC(renderPasses);
 
-    /* Set new render pass */
-    SetRenderPass(
-        renderContextVK.GetSwapChainRenderPass(),
-        renderContextVK.GetSwapChainFramebuffer(),
-        renderContextVK.GetSwapChainExtent()
-    );
+    auto& renderContextVK = LLGL_CAST(VKRenderContext&, renderContext);
 
     /* Store information about framebuffer attachments */
     numColorAttachments_    = 1;
     hasDSVAttachment_       = renderContextVK.HasDepthStencilBuffer();
+
+    if (IsSecondary())
+    {
+        /* Begin recording within the swap-chain render pass; the framebuffer is unknown, since it changes with each presentation */
+        BeginSecondaryCommandBuffer(
+            renderContextVK.GetSwapChainRenderPass(),
+            VK_NULL_HANDLE,
+            renderContextVK.GetSwapChainExtent()
+        );
+    }
+    else
+    {
+        //TODO:
+        //  this must be done for all command buffers at the end of the "VKRenderContext::Present" function
+        /* Switch internal command buffer for the current frame in flight of the respective render context */
+        renderContextVK.SetPresentCommandBuffer(this);
+        presentable_ = true;
+
+        /* Begin command buffer and render pass */
+        if (!IsCommandBufferActive())
+            BeginCommandBuffer();
+
+        BeginRenderPassWithSet(
+            renderContextVK.GetRenderPassSet(),
+            renderContextVK.GetSwapChainFramebuffer(),
+            renderContextVK.GetSwapChainExtent(),
+            renderPass,
+            numClearValues,
+            clearValues
+        );
+    }
+}
+
+void VKCommandBuffer::EndRenderPass()
+{
+    /* Secondary command buffers only continue the render pass of the primary command buffer */
+    if (!IsSecondary())
+        SetRenderPassNull();
+}
+
+void VKCommandBuffer::ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment)
+{
+    // dummy (render targets do not support multi-sampling yet)
 }
 
+void VKCommandBuffer::DiscardAttachments(long flags)
+{
+    // dummy (attachments are only discarded by the store operations of the render pass)
+}
 
 /* ----- Pipeline States ----- */
 
@@ -399,8 +788,30 @@ void VKCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
     auto& graphicsPipelineVK = LLGL_CAST(VKGraphicsPipeline&, graphicsPipeline);
 
-    /* Bind graphics pipeline */
-    vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineVK.GetVkPipeline());
+    /* Bind graphics pipeline unless it is already bound */
+    if (bindingCache_.graphicsPipeline != &graphicsPipelineVK)
+    {
+        LLGL_STATISTICS_INC(pipelineBindings);
+
+        vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineVK.GetVkPipeline());
+        bindingCache_.graphicsPipeline = &graphicsPipelineVK;
+
+        /* Static viewport and scissor states of the pipeline overwrite the previous dynamic states */
+        if (!graphicsPipelineVK.HasDynamicViewport())
+            bindingCache_.viewportValid = false;
+        if (!graphicsPipelineVK.HasDynamicScissor())
+            bindingCache_.scissorValid = false;
+    }
+
+    graphicsPipelineLayout_     = graphicsPipelineVK.GetVkPipelineLayout();
+    graphicsConstantsStages_    = graphicsPipelineVK.GetConstantsStageFlags();
+
+    /* Individual resource bindings must be written into a new descriptor set if the pipeline layout changed */
+    if (graphicsPipelineLayoutVK_ != graphicsPipelineVK.GetPipelineLayout())
+    {
+        graphicsPipelineLayoutVK_   = graphicsPipelineVK.GetPipelineLayout();
+        graphicsBindings_.dirty     = true;
+    }
 
     /* Scissor rectangle must be updated (if scissor test is disabled) */
     scissorEnabled_ = graphicsPipelineVK.IsScissorEnabled();
@@ -414,6 +825,9 @@ void VKCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
         }
         vkCmdSetScissor(commandBuffer_, 0, 1, &scissorRect);
 
+        bindingCache_.scissor       = scissorRect;
+        bindingCache_.scissorValid  = true;
+
         /* Avoid scissor update with each graphics pipeline binding (as long as render pass does not change) */
         scissorRectInvalidated_ = false;
     }
@@ -422,7 +836,67 @@ void VKCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 void VKCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
     auto& computePipelineVK = LLGL_CAST(VKComputePipeline&, computePipeline);
-    vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineVK.GetVkPipeline());
+
+    /* Bind compute pipeline unless it is already bound */
+    if (bindingCache_.computePipeline != &computePipelineVK)
+    {
+        LLGL_STATISTICS_INC(pipelineBindings);
+
+        vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineVK.GetVkPipeline());
+        bindingCache_.computePipeline = &computePipelineVK;
+    }
+
+    computePipelineLayout_  = computePipelineVK.GetVkPipelineLayout();
+    computeConstantsStages_ = computePipelineVK.GetConstantsStageFlags();
+
+    if (computePipelineLayoutVK_ != computePipelineVK.GetPipelineLayout())
+    {
+        computePipelineLayoutVK_    = computePipelineVK.GetPipelineLayout();
+        computeBindings_.dirty      = true;
+    }
+}
+
+void VKCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    #ifdef VK_KHR_fragment_shading_rate
+    if (vkCmdSetFragmentShadingRateKHR != nullptr)
+    {
+        /* Decode fragment size from the shading rate, i.e. (log2(width) << 2) | log2(height) */
+        const auto value = static_cast<std::uint32_t>(rate);
+        const VkExtent2D fragmentSize { (1u << ((value >> 2) & 0x3)), (1u << (value & 0x3)) };
+        const VkFragmentShadingRateCombinerOpKHR combinerOps[2] =
+        {
+            VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+            VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+        };
+        vkCmdSetFragmentShadingRateKHR(commandBuffer_, &fragmentSize, combinerOps);
+    }
+    #endif
+}
+
+void VKCommandBuffer::SetShadingRateImage(Texture* /*texture*/)
+{
+    //todo: requires a fragment shading rate attachment in the render pass (VkFragmentShadingRateAttachmentInfoKHR)
+}
+
+void VKCommandBuffer::SetStencilReference(std::uint32_t reference)
+{
+    vkCmdSetStencilReference(commandBuffer_, VK_STENCIL_FACE_FRONT_AND_BACK, reference);
+}
+
+void VKCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    vkCmdSetBlendConstants(commandBuffer_, color.Ptr());
+}
+
+void VKCommandBuffer::SetDepthBias(const DepthBiasDescriptor& depthBias)
+{
+    vkCmdSetDepthBias(commandBuffer_, depthBias.constantFactor, depthBias.clamp, depthBias.slopeFactor);
+}
+
+void VKCommandBuffer::SetDepthBounds(float minBounds, float maxBounds)
+{
+    vkCmdSetDepthBounds(commandBuffer_, minBounds, maxBounds);
 }
 
 /* ----- Queries ----- */
@@ -437,6 +911,7 @@ void VKCommandBuffer::BeginQuery(Query& query)
     if (query.GetType() == QueryType::SamplesPassed)
         flags |= VK_QUERY_CONTROL_PRECISE_BIT;
 
+    FlushPendingRenderPass();
     vkCmdBeginQuery(commandBuffer_, queryVK.GetVkQueryPool(), 0, flags);
 }
 
@@ -466,12 +941,31 @@ bool VKCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
     return true;
 }
 
+// Number of 64-bit values of a pipeline statistics query with all statistics flags (see GetPipelineStatisticsFlags in VKQuery.cpp)
+static const std::uint32_t g_numPipelineStatistics = 11;
+
+static void Convert(QueryPipelineStatistics& dst, const std::uint64_t* src)
+{
+    dst.numPrimitivesGenerated              = 0;
+    dst.numVerticesSubmitted                = src[ 0]; // VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT
+    dst.numPrimitivesSubmitted              = src[ 1]; // VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT
+    dst.numVertexShaderInvocations          = src[ 2]; // VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+    dst.numTessControlShaderInvocations     = src[ 8]; // VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT
+    dst.numTessEvaluationShaderInvocations  = src[ 9]; // VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT
+    dst.numGeometryShaderInvocations        = src[ 3]; // VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT
+    dst.numFragmentShaderInvocations        = src[ 7]; // VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    dst.numComputeShaderInvocations         = src[10]; // VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT
+    dst.numGeometryPrimitivesGenerated      = src[ 4]; // VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT
+    dst.numClippingInputPrimitives          = src[ 5]; // VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT
+    dst.numClippingOutputPrimitives         = src[ 6]; // VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT
+}
+
 bool VKCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
 {
     auto& queryVK = LLGL_CAST(VKQuery&, query);
 
     /* Store results in intermediate memory */
-    std::uint64_t intermediateResults[11];
+    std::uint64_t intermediateResults[g_numPipelineStatistics];
 
     auto stateResult = vkGetQueryPoolResults(
         device_, queryVK.GetVkQueryPool(), 0, 1,
@@ -486,100 +980,943 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineS
     VKThrowIfFailed(stateResult, "failed to retrieve results from Vulkan query pool");
 
     /* Copy result to output parameter */
-    result.numPrimitivesGenerated               = 0;
-    result.numVerticesSubmitted                 = intermediateResults[ 0]; // VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT
-    result.numPrimitivesSubmitted               = intermediateResults[ 1]; // VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT
-    result.numVertexShaderInvocations           = intermediateResults[ 2]; // VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
-    result.numTessControlShaderInvocations      = intermediateResults[ 8]; // VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT
-    result.numTessEvaluationShaderInvocations   = intermediateResults[ 9]; // VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT
-    result.numGeometryShaderInvocations         = intermediateResults[ 3]; // VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT
-    result.numFragmentShaderInvocations         = intermediateResults[ 7]; // VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
-    result.numComputeShaderInvocations          = intermediateResults[10]; // VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT
-    result.numGeometryPrimitivesGenerated       = intermediateResults[ 4]; // VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT
-    result.numClippingInputPrimitives           = intermediateResults[ 5]; // VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT
-    result.numClippingOutputPrimitives          = intermediateResults[ 6]; // VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT
+    Convert(result, intermediateResults);
 
     return true;
 }
 
 void VKCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
 {
-    //todo
+    auto& queryVK = LLGL_CAST(VKQuery&, query);
+    BeginRenderConditionWithQueryPool(queryVK.GetVkQueryPool(), 0, mode);
 }
 
 void VKCommandBuffer::EndRenderCondition()
 {
-    //todo
+    #ifdef VK_EXT_conditional_rendering
+    if (renderConditionActive_)
+        vkCmdEndConditionalRenderingEXT(commandBuffer_);
+    #endif
+    renderConditionActive_      = false;
+    renderConditionEmulated_    = false;
 }
 
-/* ----- Drawing ----- */
-
-void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+void VKCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
-    vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+    BeginRenderConditionWithQueryPool(queryHeapVK.GetVkQueryPool(), query, mode);
 }
 
-void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+void VKCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+    FlushPendingRenderPass();
+    vkCmdBeginQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query, queryHeapVK.GetControlFlags());
 }
 
-void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+void VKCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+    vkCmdEndQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query);
 }
 
-void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+bool VKCommandBuffer::QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results)
 {
-    vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
-}
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
-void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
-{
-    vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
-}
+    /* Store results of the entire range directly into the output array */
+    auto stateResult = vkGetQueryPoolResults(
+        device_, queryHeapVK.GetVkQueryPool(), firstQuery, numQueries,
+        static_cast<std::size_t>(numQueries) * sizeof(std::uint64_t), results, sizeof(std::uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    );
 
-void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
-{
-    vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
-}
+    /* Check if results are not ready yet */
+    if (stateResult == VK_NOT_READY)
+        return false;
 
-void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
-{
-    vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
+    VKThrowIfFailed(stateResult, "failed to retrieve results from Vulkan query pool");
+
+    /* Reset queries for their next use, since their results have been consumed */
+    queryHeapVK.ResetQueries(firstQuery, numQueries);
+
+    return true;
 }
 
-void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+void VKCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset)
 {
-    vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
-}
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
-/* ----- Compute ----- */
+    /* Query pool commands are not allowed inside a render pass */
+    const bool insideRenderPass = (renderPass_ != VK_NULL_HANDLE);
 
-void VKCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
-{
-    vkCmdDispatch(commandBuffer_, groupSizeX, groupSizeY, groupSizeZ);
-}
+    if (insideRenderPass)
+        EndVkRenderPass();
 
-/* --- Extended functions --- */
+    /* Copy all results with a single command (the GPU waits for the results), then reset the queries for their next use */
+    vkCmdCopyQueryPoolResults(
+        commandBuffer_, queryHeapVK.GetVkQueryPool(), firstQuery, numQueries,
+        dstBufferVK.GetVkBuffer(), dstOffset, sizeof(std::uint64_t),
+        (VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT)
+    );
+    vkCmdResetQueryPool(commandBuffer_, queryHeapVK.GetVkQueryPool(), firstQuery, numQueries);
 
-void VKCommandBuffer::SetPresentIndex(std::uint32_t idx)
-{
-    commandBuffer_          = commandBufferList_[idx];
-    commandBufferActiveIt_  = commandBufferActiveList_.begin() + idx;
-    recordingFence_         = recordingFenceList_[idx];
+    /* Resume render pass without applying its load operations again */
+    if (insideRenderPass)
+    {
+        renderPass_ = resumeRenderPass_;
+        BeginVkRenderPass(renderPass_, framebuffer_, framebufferExtent_);
+    }
 }
 
-bool VKCommandBuffer::IsCommandBufferActive() const
-{
-    return *commandBufferActiveIt_;
-}
+/* ----- Timer Scopes ----- */
 
-void VKCommandBuffer::BeginCommandBuffer()
+void VKCommandBuffer::BeginTimerScope(const char* name)
 {
-    /* Wait for fence before recording */
-    vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
-    vkResetFences(device_, 1, &recordingFence_);
+    /* Secondary command buffers have no timestamp queries */
+    if (IsSecondary())
+        return;
+
+    if (!IsCommandBufferActive())
+        BeginCommandBuffer();
+
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.BeginScope(name, timestampIndex))
+        vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timerQueryPool_, timestampIndex);
+
+    BeginStatisticsSegment();
+}
+
+void VKCommandBuffer::EndTimerScope()
+{
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    if (timerScopes_.EndScope(timestampIndex))
+        vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timerQueryPool_, timestampIndex);
+
+    BeginStatisticsSegment();
+}
+
+bool VKCommandBuffer::QueryTimerScopes(TimerScopeFrame& frame)
+{
+    if (!timerScopes_.HasPendingFrame())
+        return false;
+
+    const auto pendingFrame     = timerScopes_.GetPendingFrame();
+    const auto firstTimestamp   = timerScopes_.GetFirstTimestamp(pendingFrame);
+    const auto numTimestamps    = timerScopes_.GetNumTimestamps(pendingFrame);
+
+    /* Retrieve timestamps of the pending frame without waiting for the GPU */
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto timestamps = scratch_.Allocate<std::uint64_t>(numTimestamps);
+
+    auto result = vkGetQueryPoolResults(
+        device_, timerQueryPool_, firstTimestamp, numTimestamps,
+        numTimestamps * sizeof(std::uint64_t), timestamps, sizeof(std::uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    );
+
+    /* Check if results are not ready yet */
+    if (result == VK_NOT_READY)
+        return false;
+
+    VKThrowIfFailed(result, "failed to retrieve timer scope results from Vulkan query pool");
+
+    /* Retrieve pipeline statistics of all segments */
+    QueryPipelineStatistics* statistics = nullptr;
+    const auto numSegments = timerScopes_.GetNumSegments(pendingFrame);
+
+    if (timerStatistics_ && numSegments > 0)
+    {
+        auto data = scratch_.Allocate<std::uint64_t>(numSegments * g_numPipelineStatistics);
+
+        result = vkGetQueryPoolResults(
+            device_, statisticsQueryPool_, timerScopes_.GetFirstSegment(pendingFrame), numSegments,
+            numSegments * g_numPipelineStatistics * sizeof(std::uint64_t), data, g_numPipelineStatistics * sizeof(std::uint64_t),
+            VK_QUERY_RESULT_64_BIT
+        );
+
+        if (result == VK_NOT_READY)
+            return false;
+
+        VKThrowIfFailed(result, "failed to retrieve timer scope statistics from Vulkan query pool");
+
+        statistics = scratch_.Allocate<QueryPipelineStatistics>(numSegments);
+        for (std::uint32_t i = 0; i < numSegments; ++i)
+            Convert(statistics[i], data + i * g_numPipelineStatistics);
+    }
+
+    timerScopes_.ResolvePendingFrame(timestamps, static_cast<double>(timestampPeriod_), frame, statistics);
+
+    return true;
+}
+
+/* ----- Debug Markers ----- */
+
+#if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+
+static VkDebugUtilsLabelEXT MakeVkDebugUtilsLabel(const char* name)
+{
+    VkDebugUtilsLabelEXT labelInfo;
+    {
+        labelInfo.sType         = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+        labelInfo.pNext         = nullptr;
+        labelInfo.pLabelName    = (name != nullptr ? name : "");
+        labelInfo.color[0]      = 0.0f;
+        labelInfo.color[1]      = 0.0f;
+        labelInfo.color[2]      = 0.0f;
+        labelInfo.color[3]      = 0.0f;
+    }
+    return labelInfo;
+}
+
+#endif // /LLGL_ENABLE_DEBUG_MARKERS && VK_EXT_debug_utils
+
+void VKCommandBuffer::PushDebugGroup(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    if (vkCmdBeginDebugUtilsLabelEXT != nullptr)
+    {
+        if (!IsCommandBufferActive())
+            BeginCommandBuffer();
+
+        auto labelInfo = MakeVkDebugUtilsLabel(name);
+        vkCmdBeginDebugUtilsLabelEXT(commandBuffer_, &labelInfo);
+    }
+    #endif
+}
+
+void VKCommandBuffer::PopDebugGroup()
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    if (vkCmdEndDebugUtilsLabelEXT != nullptr)
+        vkCmdEndDebugUtilsLabelEXT(commandBuffer_);
+    #endif
+}
+
+void VKCommandBuffer::InsertDebugMarker(const char* name)
+{
+    #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+    if (vkCmdInsertDebugUtilsLabelEXT != nullptr)
+    {
+        if (!IsCommandBufferActive())
+            BeginCommandBuffer();
+
+        auto labelInfo = MakeVkDebugUtilsLabel(name);
+        vkCmdInsertDebugUtilsLabelEXT(commandBuffer_, &labelInfo);
+    }
+    #endif
+}
+
+/* ----- Drawing ----- */
+
+void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDraw(numVertices, 1, firstVertex, 0);
+}
+
+void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDrawIndexed(numIndices, 1, firstIndex, 0, 0);
+}
+
+void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDrawIndexed(numIndices, 1, firstIndex, vertexOffset, 0);
+}
+
+void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDraw(numVertices, numInstances, firstVertex, 0);
+}
+
+void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDraw(numVertices, numInstances, firstVertex, firstInstance);
+}
+
+void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDrawIndexed(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDrawIndexed(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    RecordDrawIndexed(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+}
+
+void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    #ifdef VK_KHR_draw_indirect_count
+    if (renderConditionEmulated_)
+    {
+        /* Take the draw count from the query result of the emulated render condition */
+        vkCmdDrawIndirectCountKHR(
+            commandBuffer_, bufferVK.GetVkBuffer(), offset,
+            transientBuffer_->GetVkBuffer(), renderConditionOffset_, 1, sizeof(VkDrawIndirectCommand)
+        );
+        return;
+    }
+    #endif // /VK_KHR_draw_indirect_count
+
+    vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+}
+
+void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    if (multiDrawIndirect_)
+        vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+    else
+    {
+        /* Submit draw commands one after another, since 'drawCount' must not be greater than 1 without the 'multiDrawIndirect' feature */
+        for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+            vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+    }
+}
+
+void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    #ifdef VK_KHR_draw_indirect_count
+    if (renderConditionEmulated_)
+    {
+        /* Take the draw count from the query result of the emulated render condition */
+        vkCmdDrawIndexedIndirectCountKHR(
+            commandBuffer_, bufferVK.GetVkBuffer(), offset,
+            transientBuffer_->GetVkBuffer(), renderConditionOffset_, 1, sizeof(VkDrawIndexedIndirectCommand)
+        );
+        return;
+    }
+    #endif // /VK_KHR_draw_indirect_count
+
+    vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+}
+
+void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    FlushPendingRenderPass();
+    FlushGraphicsResourceBindings();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    if (multiDrawIndirect_)
+        vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+    else
+    {
+        for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+            vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+    }
+}
+
+void VKCommandBuffer::ExecuteIndirect(
+    IndirectCommandLayout&  layout,
+    Buffer&                 argumentBuffer,
+    std::uint64_t           argumentOffset,
+    std::uint32_t           maxNumCommands,
+    Buffer*                 countBuffer,
+    std::uint64_t           countOffset)
+{
+    /* Emulated layouts only consist of a single draw argument, so the commands are regular indirect draw commands */
+    const auto indexed  = (layout.GetDrawType() == IndirectArgumentType::DrawIndexed);
+    const auto stride   = layout.GetStride();
+    const auto offset   = argumentOffset + layout.GetDrawOffset();
+
+    if (countBuffer == nullptr)
+    {
+        if (indexed)
+            VKCommandBuffer::DrawIndexedIndirect(argumentBuffer, offset, maxNumCommands, stride);
+        else
+            VKCommandBuffer::DrawIndirect(argumentBuffer, offset, maxNumCommands, stride);
+        return;
+    }
+
+    #ifdef VK_KHR_draw_indirect_count
+    if (vkCmdDrawIndexedIndirectCountKHR != nullptr)
+    {
+        LLGL_STATISTICS_ADD(drawCalls, maxNumCommands);
+
+        FlushPendingRenderPass();
+        FlushGraphicsResourceBindings();
+        auto& argumentBufferVK  = LLGL_CAST(VKBuffer&, argumentBuffer);
+        auto& countBufferVK     = LLGL_CAST(VKBuffer&, *countBuffer);
+        if (indexed)
+            vkCmdDrawIndexedIndirectCountKHR(commandBuffer_, argumentBufferVK.GetVkBuffer(), offset, countBufferVK.GetVkBuffer(), countOffset, maxNumCommands, stride);
+        else
+            vkCmdDrawIndirectCountKHR(commandBuffer_, argumentBufferVK.GetVkBuffer(), offset, countBufferVK.GetVkBuffer(), countOffset, maxNumCommands, stride);
+        return;
+    }
+    #endif // /VK_KHR_draw_indirect_count
+
+    throw std::runtime_error("indirect commands with count buffer require the Vulkan extension VK_KHR_draw_indirect_count");
+}
+
+void VKCommandBuffer::DrawStreamOutput()
+{
+    //todo: requires VK_EXT_transform_feedback (vkCmdDrawIndirectByteCountEXT)
+}
+
+void VKCommandBuffer::DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_STATISTICS_INC(drawCalls);
+
+    #ifdef VK_EXT_mesh_shader
+    if (vkCmdDrawMeshTasksEXT != nullptr)
+    {
+        FlushPendingRenderPass();
+        FlushGraphicsResourceBindings();
+        vkCmdDrawMeshTasksEXT(commandBuffer_, groupSizeX, groupSizeY, groupSizeZ);
+    }
+    #endif
+}
+
+void VKCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_STATISTICS_ADD(drawCalls, numCommands);
+
+    #ifdef VK_EXT_mesh_shader
+    if (vkCmdDrawMeshTasksIndirectEXT != nullptr)
+    {
+        FlushPendingRenderPass();
+        FlushGraphicsResourceBindings();
+        auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+        if (multiDrawIndirect_)
+            vkCmdDrawMeshTasksIndirectEXT(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+        else
+        {
+            /* Submit draw commands one after another, since 'drawCount' must not be greater than 1 without the 'multiDrawIndirect' feature */
+            for (std::uint32_t i = 0; i < numCommands; ++i, offset += stride)
+                vkCmdDrawMeshTasksIndirectEXT(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+        }
+    }
+    #endif
+}
+
+/* ----- Compute ----- */
+
+void VKCommandBuffer::Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    FlushComputeResourceBindings();
+    vkCmdDispatch(commandBuffer_, groupSizeX, groupSizeY, groupSizeZ);
+}
+
+void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_STATISTICS_INC(dispatchCalls);
+
+    FlushComputeResourceBindings();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
+}
+
+void VKCommandBuffer::DispatchBarrier()
+{
+    /* Make the shader writes of previous dispatches visible to subsequent dispatches and indirect arguments (copy commands insert their own barriers) */
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT), (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+}
+
+/* ----- Acceleration Structures ----- */
+
+void VKCommandBuffer::BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures)
+{
+    #ifdef VK_KHR_acceleration_structure
+    if (numAccelerationStructures == 0)
+        return;
+
+    /* Build all acceleration structures with a single command, since each of them has its own scratch buffer */
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos(numAccelerationStructures);
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> buildRanges(numAccelerationStructures);
+
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureVK = LLGL_CAST(VKAccelerationStructure*, accelerationStructures[i]);
+        buildInfos[i]   = accelerationStructureVK->GetBuildGeometryInfo();
+        buildRanges[i]  = accelerationStructureVK->GetBuildRangeInfos();
+    }
+
+    /* Make previous writes to the inputs visible to the build, and the build visible to subsequent commands (e.g. ray queries or another build) */
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR)
+    );
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdBuildAccelerationStructuresKHR(commandBuffer_, numAccelerationStructures, buildInfos.data(), buildRanges.data());
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+
+    /* Write compacted sizes of all acceleration structures that allow compaction */
+    for (std::uint32_t i = 0; i < numAccelerationStructures; ++i)
+    {
+        auto accelerationStructureVK = LLGL_CAST(VKAccelerationStructure*, accelerationStructures[i]);
+        if (auto queryPool = accelerationStructureVK->GetCompactedSizeQueryPool())
+        {
+            const VkAccelerationStructureKHR nativeAccelerationStructure = accelerationStructureVK->GetVkAccelerationStructure();
+            vkCmdResetQueryPool(commandBuffer_, queryPool, 0, 1);
+            vkCmdWriteAccelerationStructuresPropertiesKHR(
+                commandBuffer_,
+                1,
+                &nativeAccelerationStructure,
+                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                queryPool,
+                0
+            );
+            accelerationStructureVK->MarkCompactedSizeQueryWritten();
+        }
+    }
+    #endif // /VK_KHR_acceleration_structure
+}
+
+void VKCommandBuffer::CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure)
+{
+    #ifdef VK_KHR_acceleration_structure
+    auto& dstAccelerationStructureVK = LLGL_CAST(VKAccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelerationStructureVK = LLGL_CAST(VKAccelerationStructure&, srcAccelerationStructure);
+
+    VkCopyAccelerationStructureInfoKHR copyInfo;
+    {
+        copyInfo.sType  = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+        copyInfo.pNext  = nullptr;
+        copyInfo.src    = srcAccelerationStructureVK.GetVkAccelerationStructure();
+        copyInfo.dst    = dstAccelerationStructureVK.GetVkAccelerationStructure();
+        copyInfo.mode   = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+    }
+
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, (VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR)
+    );
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdCopyAccelerationStructureKHR(commandBuffer_, &copyInfo);
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+    #endif // /VK_KHR_acceleration_structure
+}
+
+/* ----- Copy ----- */
+
+static VkImageSubresourceRange GetVkImageSubresourceRange(const VkImageSubresourceLayers& subresource)
+{
+    VkImageSubresourceRange subresourceRange;
+    {
+        subresourceRange.aspectMask     = subresource.aspectMask;
+        subresourceRange.baseMipLevel   = subresource.mipLevel;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+        subresourceRange.layerCount     = subresource.layerCount;
+    }
+    return subresourceRange;
+}
+
+// Converts the row stride (in bytes) into the buffer row length (in texels) of a Vulkan buffer-image copy.
+static std::uint32_t GetVkBufferRowLength(const VKTexture& textureVK, std::uint32_t rowStride)
+{
+    if (rowStride > 0)
+    {
+        const auto texelSize = FormatBitSize(VKTypes::Unmap(textureVK.GetVkFormat())) / 8;
+        if (texelSize > 0)
+            return (rowStride / texelSize);
+    }
+    return 0;
+}
+
+void VKCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+    auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+
+    VkBufferCopy region;
+    {
+        region.srcOffset    = srcOffset;
+        region.dstOffset    = dstOffset;
+        region.size         = size;
+    }
+
+    /* Make previous writes visible to the transfer, and the result of the transfer visible to subsequent commands */
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+}
+
+void VKCommandBuffer::CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer)
+{
+    auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+
+    /* Hidden counter is stored behind the elements of the source buffer */
+    CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcBufferVK.GetCounterOffset(), sizeof(std::uint32_t));
+}
+
+void VKCommandBuffer::SetBufferCounter(Buffer& buffer, std::uint32_t value)
+{
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT),
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT
+    );
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdFillBuffer(commandBuffer_, bufferVK.GetVkBuffer(), bufferVK.GetCounterOffset(), sizeof(std::uint32_t), value);
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+}
+
+void VKCommandBuffer::FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value)
+{
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT),
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT
+    );
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), dstOffset, fillSize, value);
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.Flush(commandBuffer_);
+}
+
+void VKCommandBuffer::CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
+    auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
+
+    VkImageCopy region;
+    VkExtent3D  dstExtent;
+    srcTextureVK.GetSubresourceRegion(srcRegion.mipLevel, srcRegion.offset, srcRegion.extent, region.srcSubresource, region.srcOffset, region.extent);
+    dstTextureVK.GetSubresourceRegion(dstLocation.mipLevel, dstLocation.offset, srcRegion.extent, region.dstSubresource, region.dstOffset, dstExtent);
+
+    const auto srcImage = srcTextureVK.GetVkImage();
+    const auto dstImage = dstTextureVK.GetVkImage();
+    const auto srcRange = GetVkImageSubresourceRange(region.srcSubresource);
+    const auto dstRange = GetVkImageSubresourceRange(region.dstSubresource);
+
+    /* Transfer both subresources out of their sampling-ready state for the duration of the copy */
+    barriers_.TransitionImageLayout(srcImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcRange);
+    barriers_.TransitionImageLayout(dstImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstRange);
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdCopyImage(
+            commandBuffer_,
+            srcImage,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            dstImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &region
+        );
+    }
+    barriers_.TransitionImageLayout(srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, srcRange);
+    barriers_.TransitionImageLayout(dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, dstRange);
+    barriers_.Flush(commandBuffer_);
+}
+
+// Converts the color of the specified clear value into a Vulkan clear color, whose components are integers for integer formats.
+static VkClearColorValue GetVkClearColorValue(const Format format, const ColorRGBAf& color)
+{
+    VkClearColorValue clearColor;
+
+    const bool      isInteger   = (IsIntegralFormat(format) && !IsNormalizedFormat(format));
+    DataType        dataType    = DataType::Float32;
+    std::uint32_t   components  = 0;
+
+    if (isInteger && SplitFormat(format, dataType, components) && IsIntDataType(dataType))
+    {
+        for (int i = 0; i < 4; ++i)
+            clearColor.int32[i] = static_cast<std::int32_t>(color[i]);
+    }
+    else if (isInteger)
+    {
+        for (int i = 0; i < 4; ++i)
+            clearColor.uint32[i] = static_cast<std::uint32_t>(color[i]);
+    }
+    else
+    {
+        for (int i = 0; i < 4; ++i)
+            clearColor.float32[i] = color[i];
+    }
+
+    return clearColor;
+}
+
+void VKCommandBuffer::ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue)
+{
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    const auto image    = textureVK.GetVkImage();
+    const auto format   = textureVK.GetVkFormat();
+
+    VkImageSubresourceRange range;
+    {
+        range.aspectMask        = VKGetImageAspectByFormat(format);
+        range.baseMipLevel      = subresource.baseMipLevel;
+        range.levelCount        = subresource.numMipLevels;
+        range.baseArrayLayer    = subresource.baseArrayLayer;
+        range.layerCount        = subresource.numArrayLayers;
+    }
+
+    /* Transfer subresource out of its sampling-ready state for the duration of the clear */
+    barriers_.TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
+    barriers_.Flush(commandBuffer_);
+    {
+        if ((range.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) != 0)
+        {
+            const auto clearColor = GetVkClearColorValue(VKTypes::Unmap(format), clearValue.color);
+            vkCmdClearColorImage(commandBuffer_, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+        }
+        else
+        {
+            const VkClearDepthStencilValue clearDepthStencil{ clearValue.depth, clearValue.stencil };
+            vkCmdClearDepthStencilImage(commandBuffer_, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearDepthStencil, 1, &range);
+        }
+    }
+    barriers_.TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, range);
+    barriers_.Flush(commandBuffer_);
+}
+
+void VKCommandBuffer::CopyBufferToTexture(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride)
+{
+    auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
+    auto& srcBufferVK  = LLGL_CAST(VKBuffer&, srcBuffer);
+
+    VkBufferImageCopy region;
+    {
+        region.bufferOffset         = srcOffset;
+        region.bufferRowLength      = GetVkBufferRowLength(dstTextureVK, rowStride);
+        region.bufferImageHeight    = 0;
+        dstTextureVK.GetSubresourceRegion(dstRegion.mipLevel, dstRegion.offset, dstRegion.extent, region.imageSubresource, region.imageOffset, region.imageExtent);
+    }
+
+    const auto dstImage = dstTextureVK.GetVkImage();
+    const auto dstRange = GetVkImageSubresourceRange(region.imageSubresource);
+
+    barriers_.InsertMemoryBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+    barriers_.TransitionImageLayout(dstImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstRange);
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdCopyBufferToImage(commandBuffer_, srcBufferVK.GetVkBuffer(), dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+    barriers_.TransitionImageLayout(dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, dstRange);
+    barriers_.Flush(commandBuffer_);
+}
+
+void VKCommandBuffer::CopyTextureToBuffer(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride)
+{
+    auto& dstBufferVK  = LLGL_CAST(VKBuffer&, dstBuffer);
+    auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
+
+    VkBufferImageCopy region;
+    {
+        region.bufferOffset         = dstOffset;
+        region.bufferRowLength      = GetVkBufferRowLength(srcTextureVK, rowStride);
+        region.bufferImageHeight    = 0;
+        srcTextureVK.GetSubresourceRegion(srcRegion.mipLevel, srcRegion.offset, srcRegion.extent, region.imageSubresource, region.imageOffset, region.imageExtent);
+    }
+
+    const auto srcImage = srcTextureVK.GetVkImage();
+    const auto srcRange = GetVkImageSubresourceRange(region.imageSubresource);
+
+    barriers_.InsertMemoryBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    barriers_.TransitionImageLayout(srcImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcRange);
+    barriers_.Flush(commandBuffer_);
+    {
+        vkCmdCopyImageToBuffer(commandBuffer_, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstBufferVK.GetVkBuffer(), 1, &region);
+    }
+    barriers_.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+    );
+    barriers_.TransitionImageLayout(srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, srcRange);
+    barriers_.Flush(commandBuffer_);
+}
+
+/* ----- Secondary Command Buffers ----- */
+
+void VKCommandBuffer::Begin()
+{
+    if (IsSecondary())
+    {
+        /* Close current recording, so the next render pass acquires a new native command buffer */
+        if (IsCommandBufferActive())
+            EndCommandBuffer();
+        secondaryEnded_ = false;
+    }
+}
+
+void VKCommandBuffer::End()
+{
+    if (IsSecondary())
+    {
+        /* Keep current recording until the next call to Begin */
+        FinishSecondaryCommandBuffer();
+        secondaryEnded_ = true;
+    }
+}
+
+void VKCommandBuffer::ExecuteCommands(CommandBuffer& secondaryCommandBuffer)
+{
+    auto& secondaryCommandBufferVK = LLGL_CAST(VKCommandBuffer&, secondaryCommandBuffer);
+
+    if (IsSecondary())
+        throw std::runtime_error("cannot execute Vulkan secondary command buffer within another secondary command buffer");
+    if (!secondaryCommandBufferVK.IsSecondary())
+        throw std::invalid_argument("cannot execute Vulkan primary command buffer as secondary command buffer");
+    if (renderPass_ == VK_NULL_HANDLE)
+        throw std::runtime_error("cannot execute Vulkan secondary command buffer outside of a render pass");
+
+    auto commandBuffer = secondaryCommandBufferVK.FinishSecondaryCommandBuffer();
+
+    /* Restart render pass for secondary command buffer contents, since the subpass contents cannot be mixed */
+    EndVkRenderPass();
+    renderPass_ = resumeRenderPass_;
+    BeginVkRenderPass(renderPass_, framebuffer_, framebufferExtent_, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    {
+        vkCmdExecuteCommands(commandBuffer_, 1, &commandBuffer);
+    }
+    EndVkRenderPass();
+    BeginVkRenderPass(renderPass_, framebuffer_, framebufferExtent_);
+
+    /* Keep recording alive until this command buffer has been completed */
+    secondaryCommandBufferVK.secondaryPool_->AddRef(commandBuffer);
+    executedSecondaries_[commandBufferIndex_].push_back({ secondaryCommandBufferVK.secondaryPool_, commandBuffer });
+
+    /* Dynamic states and bindings are undefined after the secondary command buffer */
+    scissorRectInvalidated_ = true;
+    ResetBindingCache();
+}
+
+/* --- Extended functions --- */
+
+void VKCommandBuffer::SetFrameIndex(std::uint32_t idx)
+{
+    /* Render contexts may have more frames in flight than this command buffer has primary command buffers */
+    idx %= static_cast<std::uint32_t>(commandBufferList_.size());
+
+    commandBuffer_          = commandBufferList_[idx];
+    commandBufferActiveIt_  = commandBufferActiveList_.begin() + idx;
+    recordingFence_         = recordingFenceList_[idx];
+    commandBufferIndex_     = idx;
+}
+
+bool VKCommandBuffer::IsCommandBufferActive() const
+{
+    return *commandBufferActiveIt_;
+}
+
+void VKCommandBuffer::BeginCommandBuffer()
+{
+    /* Wait for fence before recording */
+    vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
+    vkResetFences(device_, 1, &recordingFence_);
+
+    /* Secondary command buffers and transient memory of the previous recording are no longer in use */
+    ReleaseExecutedSecondaries(commandBufferIndex_);
+    ReleaseTransientMemory(transientSlotSubmissions_[commandBufferIndex_]);
+    scratch_.Reset();
+
+    /* Descriptor sets of the previous recording are no longer in use; individual bindings must be written into new sets */
+    transientDescriptorPools_[commandBufferIndex_]->Reset();
+    graphicsBindings_.dirty = true;
+    computeBindings_.dirty  = true;
 
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
@@ -592,6 +1929,28 @@ void VKCommandBuffer::BeginCommandBuffer()
     auto result = vkBeginCommandBuffer(commandBuffer_, &beginInfo);
     VKThrowIfFailed(result, "failed to begin Vulkan command buffer");
 
+    ResetBindingCache();
+
+    ResetShadingRate();
+
+    /* Reset timestamp queries of the current timer scope frame (this must be recorded outside of a render pass) */
+    vkCmdResetQueryPool(
+        commandBuffer_,
+        timerQueryPool_,
+        timerScopes_.GetFirstTimestamp(timerScopes_.GetCurrentFrame()),
+        TimerScopeRecorder::maxNumTimestampsPerFrame
+    );
+
+    if (timerStatistics_)
+    {
+        vkCmdResetQueryPool(
+            commandBuffer_,
+            statisticsQueryPool_,
+            timerScopes_.GetFirstSegment(timerScopes_.GetCurrentFrame()),
+            TimerScopeRecorder::maxNumSegmentsPerFrame
+        );
+    }
+
     /* Store activity state */
     *commandBufferActiveIt_ = true;
 }
@@ -602,19 +1961,31 @@ void VKCommandBuffer::EndCommandBuffer()
     auto result = vkEndCommandBuffer(commandBuffer_);
     VKThrowIfFailed(result, "failed to end Vulkan command buffer");
 
+    /* Tag transient memory of this recording with the primary command buffer it is submitted with */
+    if (transientRing_.HasOpenSegment())
+    {
+        transientRing_.Close(++transientSubmission_);
+        transientSlotSubmissions_[commandBufferIndex_] = transientSubmission_;
+    }
+
     /* Store activity state */
     *commandBufferActiveIt_ = false;
 }
 
-void VKCommandBuffer::SetRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent)
+void VKCommandBuffer::SetRenderPass(
+    VkRenderPass        renderPass,
+    VkFramebuffer       framebuffer,
+    const VkExtent2D&   extent,
+    std::uint32_t       numClearValues,
+    const VkClearValue* clearValues)
 {
     if (renderPass_)
-        EndRenderPass();
+        EndVkRenderPass();
 
     if (renderPass != VK_NULL_HANDLE)
     {
         /* Begin new render pass */
-        BeginRenderPass(renderPass, framebuffer, extent);
+        BeginVkRenderPass(renderPass, framebuffer, extent, VK_SUBPASS_CONTENTS_INLINE, numClearValues, clearValues);
 
         /* Store render pass and framebuffer attributes */
         renderPass_             = renderPass;
@@ -624,12 +1995,25 @@ void VKCommandBuffer::SetRenderPass(VkRenderPass renderPass, VkFramebuffer frame
     }
 }
 
+void VKCommandBuffer::CloseTimerScopeFrame()
+{
+    EndStatisticsSegment();
+
+    std::uint32_t timestampIndex = 0;
+    while (timerScopes_.HasOpenScopes())
+    {
+        if (timerScopes_.EndScope(timestampIndex))
+            vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timerQueryPool_, timestampIndex);
+    }
+    timerScopes_.CloseFrame();
+}
+
 void VKCommandBuffer::SetRenderPassNull()
 {
     if (renderPass_)
     {
         /* End current render pass */
-        EndRenderPass();
+        EndVkRenderPass();
 
         /* Reset render pass and framebuffer attributes */
         renderPass_     = VK_NULL_HANDLE;
@@ -638,7 +2022,13 @@ void VKCommandBuffer::SetRenderPassNull()
 }
 
 //private
-void VKCommandBuffer::BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent)
+void VKCommandBuffer::BeginVkRenderPass(
+    VkRenderPass        renderPass,
+    VkFramebuffer       framebuffer,
+    const VkExtent2D&   extent,
+    VkSubpassContents   contents,
+    std::uint32_t       numClearValues,
+    const VkClearValue* clearValues)
 {
     /* Record begin of render pass */
     VkRenderPassBeginInfo beginInfo;
@@ -649,17 +2039,342 @@ void VKCommandBuffer::BeginRenderPass(VkRenderPass renderPass, VkFramebuffer fra
         beginInfo.framebuffer       = framebuffer;
         beginInfo.renderArea.offset = { 0, 0 };
         beginInfo.renderArea.extent = extent;
-        beginInfo.clearValueCount   = 0;//1;
-        beginInfo.pClearValues      = nullptr;//(&clearValue_);
+        beginInfo.clearValueCount   = numClearValues;
+        beginInfo.pClearValues      = clearValues;
     }
-    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    /* Pipeline statistics queries must not span across the boundaries of a render pass */
+    EndStatisticsSegment();
+    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, contents);
+
+    /* Secondary command buffers cannot be executed while a query is active (this would require inherited queries) */
+    if (contents == VK_SUBPASS_CONTENTS_INLINE)
+        BeginStatisticsSegment();
 }
 
 //private
-void VKCommandBuffer::EndRenderPass()
+void VKCommandBuffer::BeginPendingRenderPass(long clearFlags)
+{
+    VkClearValue clearValuesVK[g_maxNumAttachments];
+    std::uint32_t numClearValuesVK = 0;
+
+    if (clearFlags != 0)
+    {
+        /* Switch to the compatible render pass that clears the selected attachments */
+        renderPass_ = renderPassSet_->GetWithClear(clearFlags);
+
+        /* Provide clear values for all attachments: first color attachments, then depth-stencil attachment */
+        for (std::uint32_t i = 0, n = std::min(numColorAttachments_, g_maxNumColorAttachments); i < n; ++i)
+            clearValuesVK[numClearValuesVK++].color = clearColor_;
+        if (hasDSVAttachment_)
+            clearValuesVK[numClearValuesVK++].depthStencil = clearDepthStencil_;
+    }
+
+    renderPassPending_ = false;
+    BeginVkRenderPass(renderPass_, framebuffer_, framebufferExtent_, VK_SUBPASS_CONTENTS_INLINE, numClearValuesVK, clearValuesVK);
+}
+
+//private
+void VKCommandBuffer::EndVkRenderPass()
 {
+    /* A deferred render pass must still be recorded to apply its load operations and layout transitions */
+    FlushPendingRenderPass();
+
     /* Record and of render pass */
+    EndStatisticsSegment();
     vkCmdEndRenderPass(commandBuffer_);
+    BeginStatisticsSegment();
+}
+
+//private
+void VKCommandBuffer::BeginRenderPassWithSet(
+    VKRenderPassSet&    renderPassSet,
+    VkFramebuffer       framebuffer,
+    const VkExtent2D&   extent,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    VkClearValue clearValuesVK[g_maxNumAttachments];
+    std::uint32_t numClearValuesVK = 0;
+
+    if (renderPass != nullptr)
+    {
+        /* Consume clear values for all attachments with clear operation: first color attachments, then depth-stencil attachment */
+        const auto& desc = renderPass->GetDesc();
+
+        std::uint32_t clearValueIndex = 0;
+
+        for (std::uint32_t i = 0, n = std::min(numColorAttachments_, g_maxNumColorAttachments); i < n; ++i)
+        {
+            auto& dst = clearValuesVK[numClearValuesVK++];
+            if (renderPass->GetColorAttachmentOps(i).loadOp == AttachmentLoadOp::Clear && clearValueIndex < numClearValues)
+            {
+                const auto& src = clearValues[clearValueIndex++];
+                dst.color.float32[0] = src.color.r;
+                dst.color.float32[1] = src.color.g;
+                dst.color.float32[2] = src.color.b;
+                dst.color.float32[3] = src.color.a;
+            }
+            else
+                dst.color = clearColor_;
+        }
+
+        if (hasDSVAttachment_)
+        {
+            auto& dst = clearValuesVK[numClearValuesVK++];
+            const bool clearDepthStencil = (desc.depthAttachment.loadOp == AttachmentLoadOp::Clear || desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear);
+            if (clearDepthStencil && clearValueIndex < numClearValues)
+            {
+                const auto& src = clearValues[clearValueIndex++];
+                dst.depthStencil.depth      = src.depth;
+                dst.depthStencil.stencil    = src.stencil;
+            }
+            else
+                dst.depthStencil = clearDepthStencil_;
+        }
+    }
+
+    if (renderPass == nullptr)
+    {
+        /* Defer begin of the default render pass, so a subsequent Clear can be folded into its load operations */
+        SetRenderPassNull();
+        renderPass_             = renderPassSet.GetDefault();
+        framebuffer_            = framebuffer;
+        framebufferExtent_      = extent;
+        scissorRectInvalidated_ = true;
+        renderPassPending_      = true;
+    }
+    else
+    {
+        /* Begin native render pass with the load and store operations of the render pass object */
+        SetRenderPass(renderPassSet.Get(renderPass), framebuffer, extent, numClearValuesVK, clearValuesVK);
+    }
+
+    renderPassSet_      = &renderPassSet;
+    resumeRenderPass_   = renderPassSet.GetResume();
+}
+
+//private
+void VKCommandBuffer::BeginSecondaryCommandBuffer(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent)
+{
+    if (IsCommandBufferActive())
+    {
+        /* Render pass is inherited for the entire recording */
+        if (renderPass != renderPass_)
+            throw std::runtime_error("cannot change render pass of Vulkan secondary command buffer during recording");
+        return;
+    }
+
+    if (secondaryEnded_)
+        throw std::runtime_error("cannot record into Vulkan secondary command buffer that has been ended without beginning a new recording");
+
+    /* Release previous recording and take next native command buffer from the pool */
+    if (commandBuffer_ != VK_NULL_HANDLE)
+        secondaryPool_->Release(commandBuffer_);
+    commandBuffer_ = secondaryPool_->Acquire();
+
+    /* Begin recording as continuation of the render pass */
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    {
+        inheritanceInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext                   = nullptr;
+        inheritanceInfo.renderPass              = renderPass;
+        inheritanceInfo.subpass                 = 0;
+        inheritanceInfo.framebuffer             = framebuffer;
+        inheritanceInfo.occlusionQueryEnable    = VK_FALSE;
+        inheritanceInfo.queryFlags              = 0;
+        inheritanceInfo.pipelineStatistics      = 0;
+    }
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo  = (&inheritanceInfo);
+    }
+    auto result = vkBeginCommandBuffer(commandBuffer_, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin Vulkan secondary command buffer");
+
+    ResetBindingCache();
+
+    ResetShadingRate();
+
+    /* Store activity state and render pass attributes */
+    *commandBufferActiveIt_ = true;
+    renderPass_             = renderPass;
+    framebuffer_            = framebuffer;
+    framebufferExtent_      = extent;
+    scissorRectInvalidated_ = true;
+}
+
+//private
+//private
+void VKCommandBuffer::BindResource(std::vector<BoundResource> ResourceBindings::*resources, std::uint32_t slot, long stageFlags, const VKDescriptorInfo& info)
+{
+    if (IsSecondary())
+        throw std::runtime_error("cannot bind individual resources in secondary Vulkan command buffer");
+
+    auto StoreResource = [slot, &info](ResourceBindings& bindings, std::vector<BoundResource>& table)
+    {
+        if (slot >= table.size())
+            table.resize(slot + 1);
+        table[slot].info    = info;
+        table[slot].bound   = true;
+        bindings.dirty      = true;
+    };
+
+    if ((stageFlags & StageFlags::AllGraphicsStages) != 0)
+        StoreResource(graphicsBindings_, graphicsBindings_.*resources);
+    if ((stageFlags & StageFlags::ComputeStage) != 0)
+        StoreResource(computeBindings_, computeBindings_.*resources);
+}
+
+//private
+void VKCommandBuffer::FlushResourceBindings(ResourceBindings& bindings, const VKPipelineLayout* pipelineLayoutVK, VkPipelineBindPoint bindingPoint)
+{
+    bindings.dirty = false;
+
+    /* Individual bindings are only written for pipelines with a layout that has any bindings at all */
+    if (pipelineLayoutVK == nullptr || pipelineLayoutVK->GetBindings().empty())
+        return;
+
+    if (bindings.constantBuffers.empty() && bindings.storageBuffers.empty() && bindings.textures.empty() && bindings.samplers.empty())
+        return;
+
+    const auto& layoutBindings  = pipelineLayoutVK->GetBindings();
+    const auto  numBindings     = layoutBindings.size();
+
+    auto descriptorSet = transientDescriptorPools_[commandBufferIndex_]->Allocate(pipelineLayoutVK->GetVkDescriptorSetLayout());
+
+    struct DynamicOffset
+    {
+        std::uint32_t binding;
+        std::uint32_t offset;
+    };
+
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto writes         = scratch_.Allocate<VkWriteDescriptorSet>(numBindings);
+    auto infos          = scratch_.Allocate<VKDescriptorInfo>(numBindings);
+    auto dynamicOffsets = scratch_.Allocate<DynamicOffset>(numBindings);
+
+    std::uint32_t numWrites         = 0;
+    std::uint32_t numDynamicOffsets = 0;
+
+    for (const auto& binding : layoutBindings)
+    {
+        /* Select binding table by descriptor type */
+        std::vector<BoundResource>* table = nullptr;
+        switch (binding.descriptorType)
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:                table = &(bindings.samplers);        break;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:          table = &(bindings.textures);        break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC: table = &(bindings.constantBuffers); break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:         table = &(bindings.storageBuffers);  break;
+            default:                                                                             break;
+        }
+
+        const bool isDynamic    = (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+        const bool isBound      = (table != nullptr && binding.dstBinding < table->size() && (*table)[binding.dstBinding].bound);
+
+        /* Each dynamic binding consumes a dynamic offset, even if no resource has been bound to it */
+        if (isDynamic)
+        {
+            dynamicOffsets[numDynamicOffsets].binding   = binding.dstBinding;
+            dynamicOffsets[numDynamicOffsets].offset    = (isBound ? static_cast<std::uint32_t>((*table)[binding.dstBinding].info.bufferInfo.offset) : 0);
+            ++numDynamicOffsets;
+        }
+
+        if (!isBound)
+            continue;
+
+        /* Write descriptor for first array element */
+        auto& info = infos[numWrites];
+        info = (*table)[binding.dstBinding].info;
+
+        if (isDynamic)
+        {
+            /* Buffer range of dynamic uniform buffers is selected by the dynamic offset */
+            if (binding.dynamicRangeSize != 0)
+                info.bufferInfo.range = binding.dynamicRangeSize;
+            info.bufferInfo.offset = 0;
+        }
+
+        auto& write = writes[numWrites++];
+        {
+            write.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext             = nullptr;
+            write.dstSet            = descriptorSet;
+            write.dstBinding        = binding.dstBinding;
+            write.dstArrayElement   = 0;
+            write.descriptorCount   = 1;
+            write.descriptorType    = binding.descriptorType;
+            write.pImageInfo        = &(info.imageInfo);
+            write.pBufferInfo       = &(info.bufferInfo);
+            write.pTexelBufferView  = nullptr;
+        }
+    }
+
+    if (numWrites > 0)
+        vkUpdateDescriptorSets(device_, numWrites, writes, 0, nullptr);
+
+    /* Dynamic offsets must be in the order of the binding numbers */
+    std::sort(
+        dynamicOffsets,
+        dynamicOffsets + numDynamicOffsets,
+        [](const DynamicOffset& lhs, const DynamicOffset& rhs)
+        {
+            return (lhs.binding < rhs.binding);
+        }
+    );
+
+    auto offsets = scratch_.Allocate<std::uint32_t>(numDynamicOffsets);
+    for (std::uint32_t i = 0; i < numDynamicOffsets; ++i)
+        offsets[i] = dynamicOffsets[i].offset;
+
+    vkCmdBindDescriptorSets(
+        commandBuffer_,
+        bindingPoint,
+        pipelineLayoutVK->GetVkPipelineLayout(),
+        0,
+        1,
+        &descriptorSet,
+        numDynamicOffsets,
+        offsets
+    );
+
+    /* Transient descriptor set replaces the cached resource heap binding */
+    if (bindingPoint == VK_PIPELINE_BIND_POINT_GRAPHICS)
+        bindingCache_.graphicsDescriptorSet = VK_NULL_HANDLE;
+    else
+        bindingCache_.computeDescriptorSet = VK_NULL_HANDLE;
+}
+
+void VKCommandBuffer::ResetShadingRate()
+{
+    /* Dynamic states are not inherited, so the initial shading rate must be set at the beginning of each recording */
+    #ifdef VK_KHR_fragment_shading_rate
+    if (vkCmdSetFragmentShadingRateKHR != nullptr)
+        SetShadingRate(ShadingRate::Rate1x1);
+    #endif
+}
+
+//private
+VkCommandBuffer VKCommandBuffer::FinishSecondaryCommandBuffer()
+{
+    if (IsCommandBufferActive())
+        EndCommandBuffer();
+    else if (commandBuffer_ == VK_NULL_HANDLE)
+        throw std::runtime_error("cannot execute Vulkan secondary command buffer that has not been recorded");
+    return commandBuffer_;
+}
+
+//private
+void VKCommandBuffer::ReleaseExecutedSecondaries(std::size_t idx)
+{
+    for (auto& secondary : executedSecondaries_[idx])
+        secondary.pool->Release(secondary.commandBuffer);
+    executedSecondaries_[idx].clear();
 }
 
 
@@ -677,7 +2392,7 @@ void VKCommandBuffer::CreateCommandPool(std::uint32_t queueFamilyIndex)
         createInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
         createInfo.queueFamilyIndex = queueFamilyIndex;
     }
-    auto result = vkCreateCommandPool(device_, &createInfo, nullptr, commandPool_.ReleaseAndGetAddressOf());
+    auto result = vkCreateCommandPool(device_, &createInfo, VKGetAllocationCallbacks(), commandPool_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan command pool");
 }
 
@@ -704,7 +2419,7 @@ void VKCommandBuffer::CreateCommandBuffers(std::size_t bufferCount)
     commandBufferActiveIt_ = commandBufferActiveList_.end();
 }
 
-void VKCommandBuffer::CreateRecordingFences(VkQueue graphicsQueue, std::size_t numFences)
+void VKCommandBuffer::CreateRecordingFences(std::size_t numFences)
 {
     recordingFenceList_.resize(numFences, VKPtr<VkFence> { device_, vkDestroyFence });
 
@@ -712,120 +2427,298 @@ void VKCommandBuffer::CreateRecordingFences(VkQueue graphicsQueue, std::size_t n
     {
         createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         createInfo.pNext = nullptr;
-        createInfo.flags = 0;
+        createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
     }
 
     for (auto& fence : recordingFenceList_)
     {
-        /* Create fence for command buffer recording */
-        auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
+        /* Create fence for command buffer recording in signaled state, so no queue submission is required */
+        auto result = vkCreateFence(device_, &createInfo, VKGetAllocationCallbacks(), fence.ReleaseAndGetAddressOf());
         VKThrowIfFailed(result, "failed to create Vulkan fence");
-
-        /* Initial fence signal */
-        vkQueueSubmit(graphicsQueue, 0, nullptr, fence);
     }
 
     recordingFence_ = recordingFenceList_.front().Get();
 }
 
-void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
+void VKCommandBuffer::CreateTimerQueryPool()
 {
-    if (numAttachments > 0)
+    VkQueryPoolCreateInfo createInfo;
     {
-        /* Clear framebuffer attachments at the entire image region */
-        VkClearRect clearRect;
-        {
-            clearRect.rect.offset.x     = 0;
-            clearRect.rect.offset.y     = 0;
-            clearRect.rect.extent       = framebufferExtent_;
-            clearRect.baseArrayLayer    = 0;
-            clearRect.layerCount        = 1;
-        }
-        vkCmdClearAttachments(commandBuffer_, numAttachments, attachments, 1, &clearRect);
+        createInfo.sType                = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.queryType            = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount           = TimerScopeRecorder::maxNumTimestamps;
+        createInfo.pipelineStatistics   = 0;
+    }
+    auto result = vkCreateQueryPool(device_, &createInfo, VKGetAllocationCallbacks(), timerQueryPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan query pool for timer scopes");
+}
+
+void VKCommandBuffer::CreateStatisticsQueryPool()
+{
+    VkQueryPoolCreateInfo createInfo;
+    {
+        createInfo.sType                = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.queryType            = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        createInfo.queryCount           = TimerScopeRecorder::maxNumSegments;
+        createInfo.pipelineStatistics   =
+        (
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT                     |
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT                   |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT                   |
+            VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT                 |
+            VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT                  |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT                        |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT                         |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT                 |
+            VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT         |
+            VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT  |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT
+        );
     }
+    auto result = vkCreateQueryPool(device_, &createInfo, VKGetAllocationCallbacks(), statisticsQueryPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan query pool for timer scope statistics");
 }
 
-//TODO: current unused; previously used for 'Clear' function
-#if 0
+void VKCommandBuffer::BeginStatisticsSegment()
+{
+    std::uint32_t queryIndex = 0;
+    if (timerStatistics_ && timerScopes_.BeginSegment(queryIndex))
+        vkCmdBeginQuery(commandBuffer_, statisticsQueryPool_, queryIndex, 0);
+}
 
-void VKCommandBuffer::BeginClearImage(
-    VkImageMemoryBarrier& clearToPresentBarrier, VkImage image, const VkImageAspectFlags clearFlags,
-    const VkClearColorValue* clearColor, const VkClearDepthStencilValue* clearDepthStencil)
+void VKCommandBuffer::EndStatisticsSegment()
 {
-    /* Initialize image subresource range */
-    VkImageSubresourceRange subresourceRange;
+    std::uint32_t queryIndex = 0;
+    if (timerScopes_.EndSegment(queryIndex))
+        vkCmdEndQuery(commandBuffer_, statisticsQueryPool_, queryIndex);
+}
+
+void VKCommandBuffer::BeginRenderConditionWithQueryPool(VkQueryPool queryPool, std::uint32_t query, const RenderConditionMode mode)
+{
+    /* Secondary command buffers have no transient memory and do not inherit conditional rendering, so their draw commands are never discarded */
+    if (IsSecondary())
+        return;
+
+    const bool inverted = (mode >= RenderConditionMode::WaitInverted);
+    const bool wait     =
+    (
+        mode == RenderConditionMode::Wait           ||
+        mode == RenderConditionMode::ByRegionWait   ||
+        mode == RenderConditionMode::WaitInverted   ||
+        mode == RenderConditionMode::ByRegionWaitInverted
+    );
+
+    #ifdef VK_EXT_conditional_rendering
+    const bool nativeCondition = (vkCmdBeginConditionalRenderingEXT != nullptr);
+    #else
+    const bool nativeCondition = false;
+    #endif
+
+    /* Without native conditional rendering, the query result is used as draw count, which cannot be inverted */
+    if (!nativeCondition)
     {
-        subresourceRange.aspectMask     = clearFlags;
-        subresourceRange.baseMipLevel   = 0;
-        subresourceRange.levelCount     = 1;
-        subresourceRange.baseArrayLayer = 0;
-        subresourceRange.layerCount     = 1;
+        #ifdef VK_KHR_draw_indirect_count
+        if (vkCmdDrawIndirectCountKHR == nullptr || inverted)
+            return;
+        #else
+        return;
+        #endif
     }
 
-    /* Initialize pre-barrier */
-    VkImageMemoryBarrier presentToClearBarrier;
+    /*
+    Allocate transient memory for the 32-bit query result. Without waiting, the result is not written if it is not available yet,
+    so it is initialized with a non-zero value to let the draw commands pass in that case
+    */
+    auto allocation = AllocateTransient(sizeof(std::uint32_t), sizeof(std::uint32_t));
+    *reinterpret_cast<std::uint32_t*>(allocation.data) = 1;
+
+    /* Query pool commands are not allowed inside a render pass */
+    const bool insideRenderPass = (renderPass_ != VK_NULL_HANDLE);
+
+    if (insideRenderPass)
+        EndVkRenderPass();
+
+    vkCmdCopyQueryPoolResults(
+        commandBuffer_, queryPool, query, 1,
+        transientBuffer_->GetVkBuffer(), allocation.offset, sizeof(std::uint32_t),
+        (wait ? VK_QUERY_RESULT_WAIT_BIT : 0)
+    );
+
+    /* Make the query result visible to the stage that reads the render condition */
+    #ifdef VK_EXT_conditional_rendering
+    if (nativeCondition)
+    {
+        barriers_.InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT, VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT
+        );
+    }
+    else
+    #endif // /VK_EXT_conditional_rendering
     {
-        presentToClearBarrier.sType                 = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        presentToClearBarrier.pNext                 = nullptr;
-        presentToClearBarrier.srcAccessMask         = VK_ACCESS_MEMORY_READ_BIT;
-        presentToClearBarrier.dstAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
-        presentToClearBarrier.oldLayout             = VK_IMAGE_LAYOUT_UNDEFINED;
-        presentToClearBarrier.newLayout             = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        presentToClearBarrier.srcQueueFamilyIndex   = queuePresentFamily_;
-        presentToClearBarrier.dstQueueFamilyIndex   = queuePresentFamily_;
-        presentToClearBarrier.image                 = image;
-        presentToClearBarrier.subresourceRange      = subresourceRange;
+        barriers_.InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+        );
     }
+    barriers_.Flush(commandBuffer_);
 
-    /* Initialize post-barrier */
+    /* Resume render pass without applying its load operations again */
+    if (insideRenderPass)
     {
-        clearToPresentBarrier.sType                 = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        clearToPresentBarrier.pNext                 = nullptr;
-        clearToPresentBarrier.srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
-        clearToPresentBarrier.dstAccessMask         = VK_ACCESS_MEMORY_READ_BIT;
-        clearToPresentBarrier.oldLayout             = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        clearToPresentBarrier.newLayout             = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        clearToPresentBarrier.srcQueueFamilyIndex   = queuePresentFamily_;
-        clearToPresentBarrier.dstQueueFamilyIndex   = queuePresentFamily_;
-        clearToPresentBarrier.image                 = image;
-        clearToPresentBarrier.subresourceRange      = subresourceRange;
+        renderPass_ = resumeRenderPass_;
+        BeginVkRenderPass(renderPass_, framebuffer_, framebufferExtent_);
     }
 
-    /* Record barrier and clear color commands */
-    vkCmdPipelineBarrier(
-        commandBuffer_,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &presentToClearBarrier
-    );
+    #ifdef VK_EXT_conditional_rendering
+    if (nativeCondition)
+    {
+        VkConditionalRenderingBeginInfoEXT beginInfo;
+        {
+            beginInfo.sType     = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+            beginInfo.pNext     = nullptr;
+            beginInfo.buffer    = transientBuffer_->GetVkBuffer();
+            beginInfo.offset    = allocation.offset;
+            beginInfo.flags     = (inverted ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0);
+        }
+        vkCmdBeginConditionalRenderingEXT(commandBuffer_, &beginInfo);
+        renderConditionActive_ = true;
+        return;
+    }
+    #endif // /VK_EXT_conditional_rendering
 
-    if ((clearFlags & VK_IMAGE_ASPECT_COLOR_BIT) != 0)
-        vkCmdClearColorImage(commandBuffer_, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, clearColor, 1, &subresourceRange);
-    if ((clearFlags & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0)
-        vkCmdClearDepthStencilImage(commandBuffer_, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, clearDepthStencil, 1, &subresourceRange);
+    /* Record subsequent draw commands as indirect draws, whose draw count is the query result (clamped to one) */
+    renderConditionEmulated_    = true;
+    renderConditionOffset_      = allocation.offset;
 }
 
-void VKCommandBuffer::EndClearImage(VkImageMemoryBarrier& clearToPresentBarrier)
+void VKCommandBuffer::DrawConditional(const VkDrawIndirectCommand& args)
 {
-    vkCmdPipelineBarrier(
-        commandBuffer_,                         // VkCommandBuffer
-        VK_PIPELINE_STAGE_TRANSFER_BIT,         // source stage
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,   // destination stage
-        0,                                      // no dependencie flags
-        0, nullptr,                             // no memory barriers
-        0, nullptr,                             // no buffer memory barriers
-        1, &clearToPresentBarrier               // image memory barriers
+    #ifdef VK_KHR_draw_indirect_count
+    auto allocation = AllocateTransient(sizeof(args), sizeof(std::uint32_t));
+    ::memcpy(allocation.data, &args, sizeof(args));
+    vkCmdDrawIndirectCountKHR(
+        commandBuffer_, transientBuffer_->GetVkBuffer(), allocation.offset,
+        transientBuffer_->GetVkBuffer(), renderConditionOffset_, 1, sizeof(args)
     );
+    #endif // /VK_KHR_draw_indirect_count
 }
 
-#endif
+void VKCommandBuffer::DrawIndexedConditional(const VkDrawIndexedIndirectCommand& args)
+{
+    #ifdef VK_KHR_draw_indirect_count
+    auto allocation = AllocateTransient(sizeof(args), sizeof(std::uint32_t));
+    ::memcpy(allocation.data, &args, sizeof(args));
+    vkCmdDrawIndexedIndirectCountKHR(
+        commandBuffer_, transientBuffer_->GetVkBuffer(), allocation.offset,
+        transientBuffer_->GetVkBuffer(), renderConditionOffset_, 1, sizeof(args)
+    );
+    #endif // /VK_KHR_draw_indirect_count
+}
+
+void VKCommandBuffer::CreateTransientBuffer()
+{
+    /* Create ring buffer object */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = g_transientRingSize;
+        createInfo.usage                    = (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+
+    /* Query results of render conditions are copied into transient memory */
+    #ifdef VK_EXT_conditional_rendering
+    if (vkCmdBeginConditionalRenderingEXT != nullptr)
+        createInfo.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+    #endif
+
+    auto buffer = MakeUnique<VKBuffer>(BufferType::Constant, device_, createInfo);
+
+    /* Allocate dedicated device memory, so it can be mapped persistently */
+    const auto& requirements = buffer->GetRequirements();
+
+    VkMemoryAllocateInfo allocInfo;
+    {
+        allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext             = nullptr;
+        allocInfo.allocationSize    = requirements.size;
+        allocInfo.memoryTypeIndex   = VKFindMemoryType(
+            *memoryProperties_,
+            requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+    }
+    auto result = vkAllocateMemory(device_, &allocInfo, VKGetAllocationCallbacks(), transientMemory_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to allocate Vulkan device memory for transient ring buffer");
+
+    result = vkBindBufferMemory(device_, buffer->GetVkBuffer(), transientMemory_, 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan transient ring buffer to device memory");
+
+    /* Map entire ring buffer persistently */
+    void* data = nullptr;
+    result = vkMapMemory(device_, transientMemory_, 0, VK_WHOLE_SIZE, 0, &data);
+    VKThrowIfFailed(result, "failed to map Vulkan transient ring buffer into CPU memory space");
+
+    transientBuffer_    = std::move(buffer);
+    transientData_      = reinterpret_cast<char*>(data);
+    transientRing_.Reset(g_transientRingSize);
+}
+
+void VKCommandBuffer::ReleaseTransientMemory(std::uint64_t submission)
+{
+    while (transientRing_.HasClosedSegments() && transientRing_.GetOldestTag() <= submission)
+        transientRing_.ReleaseOldest();
+}
+
+void VKCommandBuffer::WaitForTransientMemory(std::uint64_t submission)
+{
+    for (std::size_t i = 0; i < transientSlotSubmissions_.size(); ++i)
+    {
+        if (transientSlotSubmissions_[i] == submission)
+        {
+            VkFence fence = recordingFenceList_[i].Get();
+            vkWaitForFences(device_, 1, &fence, VK_TRUE, UINT64_MAX);
+            return;
+        }
+    }
+}
+
+void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
+{
+    FlushPendingRenderPass();
+
+    if (numAttachments > 0)
+    {
+        /* Clear framebuffer attachments at the entire image region */
+        VkClearRect clearRect;
+        {
+            clearRect.rect.offset.x     = 0;
+            clearRect.rect.offset.y     = 0;
+            clearRect.rect.extent       = framebufferExtent_;
+            clearRect.baseArrayLayer    = 0;
+            clearRect.layerCount        = 1;
+        }
+        vkCmdClearAttachments(commandBuffer_, numAttachments, attachments, 1, &clearRect);
+    }
+}
 
 
 } // /namespace LLGL
 
 
+/* Implement non-virtual command buffer functions for LLGL_BACKEND=Vulkan */
+#define LLGL_DIRECT_DISPATCH_CLASS VKCommandBuffer
+#include "../DirectDispatch.h"
+
+
 
 // ================================================================================
@@ -9,12 +9,22 @@
 #define LLGL_VK_COMMAND_BUFFER_H
 
 
-#include <LLGL/CommandBuffer.h>
+#include <LLGL/CommandBufferExt.h>
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "VKSecondaryCommandPool.h"
+#include "VKBarrierBatch.h"
+#include "VKContainers.h"
+#include "RenderState/VKTransientDescriptorPool.h"
+#include "Buffer/VKBuffer.h"
+#include "../TimerScopeRecorder.h"
+#include "../StatisticsCounter.h"
+#include "../ScratchArena.h"
+#include "../TransientRing.h"
 
 #include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -22,15 +32,33 @@ namespace LLGL
 
 
 class VKResourceHeap;
+class VKRenderPassSet;
+class VKPipelineLayout;
 
-class VKCommandBuffer final : public CommandBuffer
+class VKCommandBuffer final : public CommandBufferExt
 {
 
     public:
 
         /* ----- Common ----- */
 
-        VKCommandBuffer(const VKPtr<VkDevice>& device, VkQueue graphicsQueue, std::size_t bufferCount, const QueueFamilyIndices& queueFamilyIndices);
+        // Constructs a primary command buffer. Compute command buffers are always in recording state, see VKCommandQueue::Submit.
+        VKCommandBuffer(
+            const VKPtr<VkDevice>&                  device,
+            std::size_t                             bufferCount,
+            const QueueFamilyIndices&               queueFamilyIndices,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            float                                   timestampPeriod,
+            VkDeviceSize                            constantBufferOffsetAlignment,
+            bool                                    multiDrawIndirect,
+            StatisticsCounter&                      statistics,
+            const QueueType                         queueType           = QueueType::Graphics,
+            long                                    flags               = 0
+        );
+
+        // Constructs a secondary command buffer with its own command pool.
+        VKCommandBuffer(const VKPtr<VkDevice>& device, const QueueFamilyIndices& queueFamilyIndices, bool multiDrawIndirect, StatisticsCounter& statistics);
+
         ~VKCommandBuffer();
 
         /* ----- Configuration ----- */
@@ -39,10 +67,10 @@ class VKCommandBuffer final : public CommandBuffer
 
         /* ----- Viewport and Scissor ----- */
 
-        void SetViewport(const Viewport& viewport) override;
+        void SetViewport(const Viewport& viewport) LLGL_DISPATCH_OVERRIDE;
         void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
 
-        void SetScissor(const Scissor& scissor) override;
+        void SetScissor(const Scissor& scissor) LLGL_DISPATCH_OVERRIDE;
         void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
 
         /* ----- Clear ----- */
@@ -56,10 +84,12 @@ class VKCommandBuffer final : public CommandBuffer
 
         /* ----- Input Assembly ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetVertexBuffer(Buffer& buffer, std::uint64_t offset) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer) LLGL_DISPATCH_OVERRIDE;
+        void SetIndexBuffer(Buffer& buffer, const IndexFormat& format, std::uint64_t offset) override;
 
         /* ----- Stream Output Buffers ------ */
 
@@ -69,20 +99,93 @@ class VKCommandBuffer final : public CommandBuffer
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Resource Heaps ----- */
 
-        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
-        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet = 0) override;
+        void SetGraphicsResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        void SetComputeResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           firstSet            = 0,
+            std::uint32_t           numDynamicOffsets   = 0,
+            const std::uint32_t*    dynamicOffsets      = nullptr
+        ) override;
+
+        /* ----- Constant Buffers ------ */
+
+        void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        void SetConstantBufferRange(
+            Buffer&         buffer,
+            std::uint32_t   slot,
+            std::uint64_t   offset,
+            std::uint64_t   size,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
+        /* ----- Storage Buffers ----- */
+
+        void SetStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Textures ----- */
+
+        void SetTexture(Texture& texture, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Samplers ----- */
+
+        void SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+
+        /* ----- Constants ----- */
+
+        void SetConstants(long stageFlags, std::uint32_t offset, std::uint32_t size, const void* data) override;
+
+        /* ----- Transient Memory ----- */
+
+        TransientAllocation AllocateTransient(std::uint64_t size, std::uint64_t alignment = 0) override;
 
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void BeginRenderPass(
+            RenderContext&      renderContext,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        void ResolveRenderTarget(RenderTarget& srcRenderTarget, Texture& dstTexture, std::uint32_t srcColorAttachment = 0) override;
+        void DiscardAttachments(long flags) override;
+
         /* ----- Pipeline States ----- */
 
-        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
-        void SetComputePipeline(ComputePipeline& computePipeline) override;
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) LLGL_DISPATCH_OVERRIDE;
+        void SetComputePipeline(ComputePipeline& computePipeline) LLGL_DISPATCH_OVERRIDE;
+
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetStencilReference(std::uint32_t reference) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetDepthBias(const DepthBiasDescriptor& depthBias) override;
+        void SetDepthBounds(float minBounds, float maxBounds) override;
 
         /* ----- Queries ----- */
 
@@ -95,36 +198,127 @@ class VKCommandBuffer final : public CommandBuffer
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode) override;
+
+        bool QueryResults(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* results) override;
+
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, Buffer& dstBuffer, std::uint64_t dstOffset) override;
+
+        /* ----- Timer Scopes ----- */
+
+        void BeginTimerScope(const char* name) override;
+        void EndTimerScope() override;
+
+        bool QueryTimerScopes(TimerScopeFrame& frame) override;
+
+        /* ----- Debug Markers ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+        void InsertDebugMarker(const char* name) override;
+
         /* ----- Drawing ----- */
 
-        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) LLGL_DISPATCH_OVERRIDE;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) LLGL_DISPATCH_OVERRIDE;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) LLGL_DISPATCH_OVERRIDE;
+
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) override;
-        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+        void ExecuteIndirect(
+            IndirectCommandLayout&  layout,
+            Buffer&                 argumentBuffer,
+            std::uint64_t           argumentOffset,
+            std::uint32_t           maxNumCommands,
+            Buffer*                 countBuffer     = nullptr,
+            std::uint64_t           countOffset     = 0
+        ) override;
 
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) override;
-        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) override;
+        void DrawStreamOutput() override;
 
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
-        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
+        void DrawMeshTasks(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
         /* ----- Compute ----- */
 
-        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) override;
+        void Dispatch(std::uint32_t groupSizeX, std::uint32_t groupSizeY, std::uint32_t groupSizeZ) LLGL_DISPATCH_OVERRIDE;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DispatchBarrier() override;
+
+        /* ----- Acceleration Structures ----- */
+
+        void BuildAccelerationStructures(std::uint32_t numAccelerationStructures, AccelerationStructure* const * accelerationStructures) override;
+        void CompactAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure) override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        void CopyCounterToBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer) override;
+        void SetBufferCounter(Buffer& buffer, std::uint32_t value) override;
+        void FillBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, std::uint64_t fillSize, std::uint32_t value) override;
+        void CopyTexture(Texture& dstTexture, const TextureLocation& dstLocation, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ClearTexture(Texture& texture, const TextureSubresource& subresource, const ClearValue& clearValue) override;
+
+        void CopyBufferToTexture(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        void CopyTextureToBuffer(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0
+        ) override;
+
+        /* ----- Secondary Command Buffers ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void ExecuteCommands(CommandBuffer& secondaryCommandBuffer) override;
 
         /* --- Extended functions --- */
 
-        void SetPresentIndex(std::uint32_t idx);
+        // Switches to the primary command buffer and recording fence of the specified frame in flight.
+        void SetFrameIndex(std::uint32_t idx);
 
         bool IsCommandBufferActive() const;
 
         void BeginCommandBuffer();
         void EndCommandBuffer();
 
-        void SetRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent);
+        void SetRenderPass(
+            VkRenderPass        renderPass,
+            VkFramebuffer       framebuffer,
+            const VkExtent2D&   extent,
+            std::uint32_t       numClearValues  = 0,
+            const VkClearValue* clearValues     = nullptr
+        );
         void SetRenderPassNull();
 
+        // Ends all open timer scopes and closes the current timer scope frame. Must be called before the command buffer is submitted for presentation.
+        void CloseTimerScopeFrame();
+
         // Returns the native VkCommandBuffer object.
         inline VkCommandBuffer GetVkCommandBuffer() const
         {
@@ -137,29 +331,198 @@ class VKCommandBuffer final : public CommandBuffer
             return recordingFence_;
         }
 
+        // Returns the index of the current primary command buffer.
+        inline std::uint32_t GetFrameIndex() const
+        {
+            return static_cast<std::uint32_t>(commandBufferIndex_);
+        }
+
+        // Returns the type of command queue this command buffer is submitted to.
+        inline QueueType GetQueueType() const
+        {
+            return queueType_;
+        }
+
+        // Returns true if this is a secondary command buffer.
+        inline bool IsSecondary() const
+        {
+            return (secondaryPool_ != nullptr);
+        }
+
+        // Returns true if this command buffer has begun a render pass on a render context, i.e. it is submitted when that render context is presented.
+        inline bool IsPresentable() const
+        {
+            return presentable_;
+        }
+
+    private:
+
+        // Resource that has been bound individually to a slot, see CommandBufferExt.
+        struct BoundResource
+        {
+            VKDescriptorInfo    info;
+            bool                bound   = false;
+        };
+
+        // Last bound objects and parameters of the current native command buffer, to filter redundant binding commands.
+        struct BindingCache
+        {
+            const void*         graphicsPipeline        = nullptr;
+            const void*         computePipeline         = nullptr;
+            VkDescriptorSet     graphicsDescriptorSet   = VK_NULL_HANDLE;
+            std::uint32_t       graphicsFirstSet        = 0;
+            VkDescriptorSet     computeDescriptorSet    = VK_NULL_HANDLE;
+            std::uint32_t       computeFirstSet         = 0;
+            const void*         vertexBuffers           = nullptr;  // Buffer or buffer array bound to the first vertex input slot
+            VkDeviceSize        vertexBufferOffset      = 0;
+            VkBuffer            indexBuffer             = VK_NULL_HANDLE;
+            VkDeviceSize        indexBufferOffset       = 0;
+            VkIndexType         indexType               = VK_INDEX_TYPE_UINT16;
+            bool                viewportValid           = false;
+            VkViewport          viewport;
+            bool                scissorValid            = false;
+            VkRect2D            scissor;
+        };
+
+        // Individually bound resources of one pipeline bind point, which are written into a transient descriptor set before the next draw or dispatch command.
+        struct ResourceBindings
+        {
+            std::vector<BoundResource>  constantBuffers;
+            std::vector<BoundResource>  storageBuffers;
+            std::vector<BoundResource>  textures;
+            std::vector<BoundResource>  samplers;
+            bool                        dirty           = false;
+        };
+
     private:
 
         void CreateCommandPool(std::uint32_t queueFamilyIndex);
         void CreateCommandBuffers(std::size_t bufferCount);
-        void CreateRecordingFences(VkQueue graphicsQueue, std::size_t numFences);
+        void CreateRecordingFences(std::size_t numFences);
+        void CreateTimerQueryPool();
+        void CreateStatisticsQueryPool();
+
+        // Begins a new pipeline statistics segment for the open timer scopes (see CommandBufferFlags::TimerScopeStatistics).
+        void BeginStatisticsSegment();
+
+        // Ends the active pipeline statistics segment of the timer scopes.
+        void EndStatisticsSegment();
+
+        // Creates the transient ring buffer in host visible memory with the first transient allocation.
+        void CreateTransientBuffer();
+
+        // Releases the transient memory of all submissions up to and including the specified one.
+        void ReleaseTransientMemory(std::uint64_t submission);
+
+        // Blocks the CPU until the primary command buffer of the specified submission of transient memory has been completed.
+        void WaitForTransientMemory(std::uint64_t submission);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
-        //TODO: current unused; previously used for 'Clear' function
-        #if 0
-        void BeginClearImage(
-            VkImageMemoryBarrier& clearToPresentBarrier, VkImage image, const VkImageAspectFlags clearFlags,
-            const VkClearColorValue* clearColor, const VkClearDepthStencilValue* clearDepthStencil
+        void BindResourceHeap(
+            VKResourceHeap&         resourceHeapVK,
+            VkPipelineBindPoint     bindingPoint,
+            std::uint32_t           firstSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets
         );
-        void EndClearImage(VkImageMemoryBarrier& clearToPresentBarrier);
-        #endif
 
-        void BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet);
+        void BeginVkRenderPass(
+            VkRenderPass        renderPass,
+            VkFramebuffer       framebuffer,
+            const VkExtent2D&   extent,
+            VkSubpassContents   contents        = VK_SUBPASS_CONTENTS_INLINE,
+            std::uint32_t       numClearValues  = 0,
+            const VkClearValue* clearValues     = nullptr
+        );
+        void EndVkRenderPass();
+
+        // Begins a native render pass from the specified set, and converts the clear values for the attachments with clear operation.
+        void BeginRenderPassWithSet(
+            VKRenderPassSet&    renderPassSet,
+            VkFramebuffer       framebuffer,
+            const VkExtent2D&   extent,
+            const RenderPass*   renderPass,
+            std::uint32_t       numClearValues,
+            const ClearValue*   clearValues
+        );
+
+        // Begins recording of a secondary command buffer that continues the specified render pass.
+        void BeginSecondaryCommandBuffer(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent);
+
+        // Stores the specified resource in the binding tables of all pipeline bind points that are selected by the stage flags.
+        void BindResource(std::vector<BoundResource> ResourceBindings::*resources, std::uint32_t slot, long stageFlags, const VKDescriptorInfo& info);
+
+        // Writes the individually bound resources into a transient descriptor set and binds it for the specified pipeline layout.
+        void FlushResourceBindings(ResourceBindings& bindings, const VKPipelineLayout* pipelineLayoutVK, VkPipelineBindPoint bindingPoint);
+
+        // Begins the native render pass whose begin has been deferred by SetRenderTarget, and clears the attachments selected by 'clearFlags' with its load operations.
+        void BeginPendingRenderPass(long clearFlags);
+
+        // Begins the deferred native render pass (if any) before commands are recorded that must be inside of a render pass.
+        inline void FlushPendingRenderPass()
+        {
+            if (renderPassPending_)
+                BeginPendingRenderPass(0);
+        }
+
+        inline void FlushGraphicsResourceBindings()
+        {
+            if (graphicsBindings_.dirty)
+                FlushResourceBindings(graphicsBindings_, graphicsPipelineLayoutVK_, VK_PIPELINE_BIND_POINT_GRAPHICS);
+        }
+
+        inline void FlushComputeResourceBindings()
+        {
+            if (computeBindings_.dirty)
+                FlushResourceBindings(computeBindings_, computePipelineLayoutVK_, VK_PIPELINE_BIND_POINT_COMPUTE);
+        }
+
+        // Resets the dynamic fragment shading rate to 1x1 if VK_KHR_fragment_shading_rate is enabled.
+        void ResetShadingRate();
+
+        // Copies the result of the specified occlusion query into transient memory and begins a render condition with it.
+        void BeginRenderConditionWithQueryPool(VkQueryPool queryPool, std::uint32_t query, const RenderConditionMode mode);
+
+        // Records an indirect draw command from transient memory, whose draw count is the query result of the emulated render condition.
+        void DrawConditional(const VkDrawIndirectCommand& args);
+        void DrawIndexedConditional(const VkDrawIndexedIndirectCommand& args);
+
+        // Records a draw command, which is discarded by the emulated render condition if its query result is zero.
+        inline void RecordDraw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstVertex, std::uint32_t firstInstance)
+        {
+            if (renderConditionEmulated_)
+                DrawConditional(VkDrawIndirectCommand{ numVertices, numInstances, firstVertex, firstInstance });
+            else
+                vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
+        }
+
+        // Records an indexed draw command, which is discarded by the emulated render condition if its query result is zero.
+        inline void RecordDrawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+        {
+            if (renderConditionEmulated_)
+                DrawIndexedConditional(VkDrawIndexedIndirectCommand{ numIndices, numInstances, firstIndex, vertexOffset, firstInstance });
+            else
+                vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        }
+
+        // Binds the specified index buffer unless it is already bound with the same offset and index type.
+        void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+
+        // Invalidates all cached bindings, e.g. when a new native command buffer is recorded or after secondary command buffers have been executed.
+        inline void ResetBindingCache()
+        {
+            bindingCache_ = BindingCache{};
+        }
+
+        // Ends recording of this secondary command buffer (if active) and returns the recorded native command buffer.
+        VkCommandBuffer FinishSecondaryCommandBuffer();
 
-        void BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, const VkExtent2D& extent);
-        void EndRenderPass();
+        // Releases all secondary command buffers that have been executed with the specified command buffer index.
+        void ReleaseExecutedSecondaries(std::size_t idx);
 
         const VKPtr<VkDevice>&          device_;
+        StatisticsCounter&              statistics_;
         VKPtr<VkCommandPool>            commandPool_;
 
         std::vector<VkCommandBuffer>    commandBufferList_;
@@ -173,6 +536,9 @@ class VKCommandBuffer final : public CommandBuffer
         VkClearDepthStencilValue        clearDepthStencil_          = { 1.0f, 0 };
 
         VkRenderPass                    renderPass_                 = VK_NULL_HANDLE;
+        VkRenderPass                    resumeRenderPass_           = VK_NULL_HANDLE;   // Render pass that preserves all attachments, to resume an interrupted render pass
+        VKRenderPassSet*                renderPassSet_              = nullptr;          // Render passes of the current framebuffer layout
+        bool                            renderPassPending_          = false;            // Specifies whether the begin of 'renderPass_' has been deferred, so a Clear can be folded into its load operations
         bool                            renderPassActive_           = false;
         VkFramebuffer                   framebuffer_                = VK_NULL_HANDLE;
         VkExtent2D                      framebufferExtent_          = { 0, 0 };
@@ -188,6 +554,64 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool                            scissorEnabled_             = false;
         bool                            scissorRectInvalidated_     = false;
+        bool                            secondaryEnded_             = false;    // Specifies whether the recording of this secondary command buffer has been ended explicitly
+
+        BindingCache                    bindingCache_;
+
+        /* Pipeline layouts and push constant stages of the bound graphics and compute pipelines */
+        VkPipelineLayout                graphicsPipelineLayout_     = VK_NULL_HANDLE;
+        VkShaderStageFlags              graphicsConstantsStages_    = 0;
+        VkPipelineLayout                computePipelineLayout_      = VK_NULL_HANDLE;
+        VkShaderStageFlags              computeConstantsStages_     = 0;
+
+        /* Individual resource bindings of the extended command buffer interface and the layouts of the bound pipelines they are written for */
+        ResourceBindings                graphicsBindings_;
+        ResourceBindings                computeBindings_;
+        const VKPipelineLayout*         graphicsPipelineLayoutVK_   = nullptr;
+        const VKPipelineLayout*         computePipelineLayoutVK_    = nullptr;
+
+        /* Transient descriptor sets for the individual resource bindings, one pool for each primary command buffer */
+        std::vector<std::unique_ptr<VKTransientDescriptorPool>> transientDescriptorPools_;
+
+        std::size_t                     commandBufferIndex_         = 0;
+
+        /* Secondary command buffers executed with each primary command buffer, released once its fence has been signaled */
+        std::vector<std::vector<VKSecondaryCommandBufferRef>> executedSecondaries_;
+
+        /* Command pool of a secondary command buffer (null for primary command buffers) */
+        std::shared_ptr<VKSecondaryCommandPool> secondaryPool_;
+
+        /* Timestamp queries of the timer scopes, partitioned into one range for each timer scope frame */
+        TimerScopeRecorder              timerScopes_;
+        VKPtr<VkQueryPool>              timerQueryPool_;
+        float                           timestampPeriod_            = 1.0f;     // Number of nanoseconds per timestamp tick
+
+        /* Pipeline statistics queries of the timer scope segments (only if CommandBufferFlags::TimerScopeStatistics is specified) */
+        VKPtr<VkQueryPool>              statisticsQueryPool_;
+        bool                            timerStatistics_            = false;
+
+        VKBarrierBatch                  barriers_;                              // Pipeline barriers around the copy commands
+
+        /* Persistently mapped buffer for transient memory, whose segments are recycled once the fences of their primary command buffers have been signaled */
+        const VkPhysicalDeviceMemoryProperties* memoryProperties_   = nullptr;
+        VkDeviceSize                    transientAlignment_         = 1;        // Default alignment, i.e. the minimal constant buffer offset alignment
+        VKPtr<VkDeviceMemory>           transientMemory_;
+        std::unique_ptr<VKBuffer>       transientBuffer_;
+        char*                           transientData_              = nullptr;
+        TransientRing<std::uint64_t>    transientRing_;                         // Segments are tagged with the number of their submission
+        std::uint64_t                   transientSubmission_        = 0;
+        std::vector<std::uint64_t>      transientSlotSubmissions_;              // Last submission of transient memory with each primary command buffer
+
+        ScratchArena                    scratch_;                               // Transient arrays of single commands, reset when recording begins
+
+        /* Render condition with VK_EXT_conditional_rendering, or its emulation with the query result as draw count of VK_KHR_draw_indirect_count */
+        bool                            renderConditionActive_      = false;    // Specifies whether native conditional rendering has been begun
+        bool                            renderConditionEmulated_    = false;    // Specifies whether draw commands are recorded as indirect draws with a draw count
+        VkDeviceSize                    renderConditionOffset_      = 0;        // Offset of the 32-bit query result in the transient buffer
+
+        bool                            multiDrawIndirect_          = false;    // Specifies whether indirect draw commands can have a draw count greater than 1
+        QueueType                       queueType_                  = QueueType::Graphics;
+        bool                            presentable_                = false;    // Command buffers that never render into a render context are submitted explicitly by the command queue
 
 };
 
@@ -6,17 +6,25 @@
  */
 
 #include "VKCommandQueue.h"
+#include "VKStagingRing.h"
+#include "VKTransferQueue.h"
+#include "VKCommandBuffer.h"
 #include "RenderState/VKFence.h"
+#include "Ext/VKExtensions.h"
 #include "../CheckedCast.h"
+#include "../ReleaseQueue.h"
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQueue) :
-    device_        { device        },
-    graphicsQueue_ { graphicsQueue }
+VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, VKStagingRing& stagingRing, bool isComputeQueue) :
+    device_         { device         },
+    queue_          { queue          },
+    stagingRing_    { stagingRing    },
+    isComputeQueue_ { isComputeQueue }
 {
 }
 
@@ -24,16 +32,136 @@ VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQu
 
 void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
-    //TODO
+    CommandBuffer* commandBuffers[] = { &commandBuffer };
+    Submit(1, commandBuffers);
+}
+
+void VKCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence, std::uint64_t signalValue)
+{
+    /* Close all command buffers that have anything to submit */
+    submitCommandBuffers_.clear();
+    vkCommandBuffers_.clear();
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferVK = LLGL_CAST(VKCommandBuffer*, commandBuffers[i]);
+        if (PrepareCommandBuffer(*commandBufferVK))
+        {
+            submitCommandBuffers_.push_back(commandBufferVK);
+            vkCommandBuffers_.push_back(commandBufferVK->GetVkCommandBuffer());
+        }
+    }
+
+    if (submitCommandBuffers_.empty())
+    {
+        if (signalFence != nullptr)
+            Signal(*signalFence, signalValue);
+        return;
+    }
+
+    /* Submit pending resource uploads, so they can be waited for by a timeline fence of the graphics queue */
+    stagingRing_.Flush();
+    AppendTransferWait();
+
+    /* Submit all command buffers in a single batch, waiting for all timeline fences the command queue has been waiting for */
+    pendingWaitStages_.assign(pendingWaitSemaphores_.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = nullptr;
+        submitInfo.waitSemaphoreCount   = static_cast<std::uint32_t>(pendingWaitSemaphores_.size());
+        submitInfo.pWaitSemaphores      = pendingWaitSemaphores_.data();
+        submitInfo.pWaitDstStageMask    = pendingWaitStages_.data();
+        submitInfo.commandBufferCount   = static_cast<std::uint32_t>(vkCommandBuffers_.size());
+        submitInfo.pCommandBuffers      = vkCommandBuffers_.data();
+        submitInfo.signalSemaphoreCount = 0;
+        submitInfo.pSignalSemaphores    = nullptr;
+    }
+
+    #ifdef VK_KHR_timeline_semaphore
+
+    /* Signal the timeline fence with the same batch, instead of an additional submission */
+    VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+    if (signalFence != nullptr)
+    {
+        auto fenceVK = LLGL_CAST(VKFence*, signalFence);
+        signalSemaphore = fenceVK->PrepareSignal(signalValue);
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &signalSemaphore;
+    }
+
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+    if (!pendingWaitSemaphores_.empty() || signalFence != nullptr)
+    {
+        timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.pNext                      = nullptr;
+        timelineInfo.waitSemaphoreValueCount    = static_cast<std::uint32_t>(pendingWaitValues_.size());
+        timelineInfo.pWaitSemaphoreValues       = pendingWaitValues_.data();
+        timelineInfo.signalSemaphoreValueCount  = submitInfo.signalSemaphoreCount;
+        timelineInfo.pSignalSemaphoreValues     = &signalValue;
+        submitInfo.pNext                        = &timelineInfo;
+    }
+
+    #else
+
+    if (signalFence != nullptr)
+        throw std::runtime_error("Vulkan timeline fences are not supported (VK_KHR_timeline_semaphore)");
+
+    #endif // /VK_KHR_timeline_semaphore
+
+    /* Only a single fence can be passed to a submission, so the queue submit fences of all other command buffers are submitted without any commands */
+    {
+        auto lock = LockQueue();
+
+        auto result = vkQueueSubmit(queue_, 1, &submitInfo, submitCommandBuffers_.back()->GetQueueSubmitFence());
+        VKThrowIfFailed(result, (isComputeQueue_ ? "failed to submit Vulkan compute queue" : "failed to submit Vulkan graphics queue"));
+
+        for (std::size_t i = 0; i + 1 < submitCommandBuffers_.size(); ++i)
+            vkQueueSubmit(queue_, 0, nullptr, submitCommandBuffers_[i]->GetQueueSubmitFence());
+    }
+
+    pendingWaitSemaphores_.clear();
+    pendingWaitValues_.clear();
+
+    /* Without a render context, released objects are destroyed once the GPU has completed this submission */
+    if (releaseQueue_ != nullptr)
+    {
+        if (releaseQueue_->HasPending())
+            releaseQueue_->Submit(stagingRing_.Signal());
+        releaseQueue_->Collect(stagingRing_.PollCompletedValue());
+    }
+
+    for (auto commandBufferVK : submitCommandBuffers_)
+    {
+        /* Switch to the next primary command buffer, which waits until its previous submission has been completed */
+        commandBufferVK->SetFrameIndex(commandBufferVK->GetFrameIndex() + 1);
+
+        /* Compute command buffers begin their next recording immediately, graphics command buffers with their next render pass */
+        if (isComputeQueue_)
+            commandBufferVK->BeginCommandBuffer();
+    }
 }
 
 /* ----- Fences ----- */
 
 void VKCommandQueue::Submit(Fence& fence)
 {
+    /* Submit fences of worker threads to the transfer queue, so they are signaled once the uploads of the worker thread have been completed */
+    if (transferQueue_ != nullptr && transferQueue_->IsWorkerThread())
+    {
+        transferQueue_->Submit(fence);
+        return;
+    }
+
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
     fenceVK.Reset(device_);
-    vkQueueSubmit(graphicsQueue_, 0, nullptr, fenceVK.GetHardwareFence());
+
+    /* Submit pending resource uploads, so the fence is signaled after they have been completed */
+    stagingRing_.Flush();
+
+    auto lock = LockQueue();
+    vkQueueSubmit(queue_, 0, nullptr, fenceVK.GetHardwareFence());
 }
 
 bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
@@ -44,7 +172,191 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void VKCommandQueue::WaitIdle()
 {
-    vkQueueWaitIdle(graphicsQueue_);
+    stagingRing_.WaitIdle();
+
+    auto lock = LockQueue();
+    vkQueueWaitIdle(queue_);
+}
+
+/* ----- Timeline fences ----- */
+
+void VKCommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    #ifdef VK_KHR_timeline_semaphore
+
+    if (transferQueue_ != nullptr && transferQueue_->IsWorkerThread())
+    {
+        transferQueue_->Signal(fence, value);
+        return;
+    }
+
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    VkSemaphore semaphore = fenceVK.PrepareSignal(value);
+
+    /* Submit pending resource uploads, so the timeline is signaled after they have been completed */
+    stagingRing_.Flush();
+
+    /* Submit empty batch that signals the timeline semaphore after all previously submitted commands */
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+    {
+        timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.pNext                      = nullptr;
+        timelineInfo.waitSemaphoreValueCount    = 0;
+        timelineInfo.pWaitSemaphoreValues       = nullptr;
+        timelineInfo.signalSemaphoreValueCount  = 1;
+        timelineInfo.pSignalSemaphoreValues     = &value;
+    }
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                        = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                        = &timelineInfo;
+        submitInfo.waitSemaphoreCount           = 0;
+        submitInfo.pWaitSemaphores              = nullptr;
+        submitInfo.pWaitDstStageMask            = nullptr;
+        submitInfo.commandBufferCount           = 0;
+        submitInfo.pCommandBuffers              = nullptr;
+        submitInfo.signalSemaphoreCount         = 1;
+        submitInfo.pSignalSemaphores            = &semaphore;
+    }
+    auto lock = LockQueue();
+    auto result = vkQueueSubmit(queue_, 1, &submitInfo, VK_NULL_HANDLE);
+    VKThrowIfFailed(result, "failed to signal Vulkan timeline semaphore");
+
+    #else
+
+    throw std::runtime_error("Vulkan timeline fences are not supported (VK_KHR_timeline_semaphore)");
+
+    #endif // /VK_KHR_timeline_semaphore
+}
+
+void VKCommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    /* Semaphore waits only apply to the batch they are submitted with, so defer the wait to the next command buffer submission */
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    pendingWaitSemaphores_.push_back(fenceVK.GetTimelineSemaphore());
+    pendingWaitValues_.push_back(value);
+}
+
+bool VKCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    return fenceVK.WaitValue(value, timeout);
+}
+
+bool VKCommandQueue::WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout)
+{
+    if (numFences == 0)
+        return true;
+
+    if (values != nullptr)
+    {
+        #ifdef VK_KHR_timeline_semaphore
+
+        /* Wait for all timeline semaphores with a single call (local array, since multiple threads may wait concurrently) */
+        std::vector<VkSemaphore> semaphores(numFences);
+        for (std::uint32_t i = 0; i < numFences; ++i)
+        {
+            auto fenceVK = LLGL_CAST(VKFence*, fences[i]);
+            semaphores[i] = fenceVK->GetTimelineSemaphore();
+        }
+
+        VkSemaphoreWaitInfoKHR waitInfo;
+        {
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext          = nullptr;
+            waitInfo.flags          = 0;
+            waitInfo.semaphoreCount = numFences;
+            waitInfo.pSemaphores    = semaphores.data();
+            waitInfo.pValues        = values;
+        }
+        return (vkWaitSemaphoresKHR(device_, &waitInfo, timeout) == VK_SUCCESS);
+
+        #else
+
+        return false;
+
+        #endif // /VK_KHR_timeline_semaphore
+    }
+    else
+    {
+        /* Wait for all hardware fences with a single call */
+        std::vector<VkFence> hwFences(numFences);
+        for (std::uint32_t i = 0; i < numFences; ++i)
+        {
+            auto fenceVK = LLGL_CAST(VKFence*, fences[i]);
+            hwFences[i] = fenceVK->GetHardwareFence();
+        }
+        return (vkWaitForFences(device_, numFences, hwFences.data(), VK_TRUE, timeout) == VK_SUCCESS);
+    }
+}
+
+/* ----- Extended functions ----- */
+
+void VKCommandQueue::TakePendingWaits(std::vector<VkSemaphore>& semaphores, std::vector<std::uint64_t>& values)
+{
+    AppendTransferWait();
+    semaphores.insert(semaphores.end(), pendingWaitSemaphores_.begin(), pendingWaitSemaphores_.end());
+    values.insert(values.end(), pendingWaitValues_.begin(), pendingWaitValues_.end());
+    pendingWaitSemaphores_.clear();
+    pendingWaitValues_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKCommandQueue::PrepareCommandBuffer(VKCommandBuffer& commandBufferVK)
+{
+    if (isComputeQueue_)
+    {
+        if (commandBufferVK.GetQueueType() != QueueType::Compute)
+            throw std::invalid_argument("cannot submit Vulkan command buffer to compute queue that has not been created for the compute queue");
+    }
+    else
+    {
+        if (commandBufferVK.GetQueueType() != QueueType::Graphics)
+            throw std::invalid_argument("cannot submit Vulkan command buffer to graphics queue that has been created for the compute queue");
+
+        /* Command buffers that render into a render context are submitted when the render context is presented */
+        if (commandBufferVK.IsPresentable())
+            return false;
+
+        /* Graphics command buffers begin their recording with the first render pass, so there is nothing to submit otherwise */
+        if (!commandBufferVK.IsCommandBufferActive())
+            return false;
+
+        commandBufferVK.SetRenderPassNull();
+    }
+
+    /* End timer scope frame and command buffer */
+    commandBufferVK.CloseTimerScopeFrame();
+    commandBufferVK.EndCommandBuffer();
+
+    return true;
+}
+
+std::unique_lock<std::mutex> VKCommandQueue::LockQueue()
+{
+    /* Only the graphics queue can be used by the present thread */
+    if (isComputeQueue_)
+        return std::unique_lock<std::mutex>{};
+    return std::unique_lock<std::mutex>{ stagingRing_.GetQueueMutex() };
+}
+
+void VKCommandQueue::AppendTransferWait()
+{
+    if (transferQueue_ != nullptr)
+    {
+        /* Wait for the uploads of worker threads on the GPU, which are shared concurrently with the transfer queue family */
+        const auto value = transferQueue_->Flush();
+        if (value > transferWaitValue_)
+        {
+            pendingWaitSemaphores_.push_back(transferQueue_->GetTimelineSemaphore());
+            pendingWaitValues_.push_back(value);
+            transferWaitValue_ = value;
+        }
+    }
 }
 
 
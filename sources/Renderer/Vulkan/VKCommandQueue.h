@@ -14,12 +14,19 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKFence.h"
+#include <vector>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
+class VKStagingRing;
+class VKTransferQueue;
+class VKCommandBuffer;
+class ReleaseQueue;
+
 class VKCommandQueue final : public CommandQueue
 {
 
@@ -27,11 +34,12 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQueue);
+        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, VKStagingRing& stagingRing, bool isComputeQueue = false);
 
         /* ----- Command queues ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const* commandBuffers, Fence* signalFence = nullptr, std::uint64_t signalValue = 0) override;
 
         /* ----- Fences ----- */
 
@@ -40,10 +48,59 @@ class VKCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+        /* ----- Timeline fences ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        bool WaitFences(std::uint32_t numFences, Fence* const* fences, const std::uint64_t* values, std::uint64_t timeout) override;
+
+        /* ----- Extended functions ----- */
+
+        // Appends the timeline semaphores (and their values) the next queue submission must wait for, and clears the pending waits.
+        void TakePendingWaits(std::vector<VkSemaphore>& semaphores, std::vector<std::uint64_t>& values);
+
+        // Sets the transfer queue of worker threads, whose uploads are waited for by each submission of this queue.
+        inline void SetTransferQueue(VKTransferQueue* transferQueue)
+        {
+            transferQueue_ = transferQueue;
+        }
+
+        // Sets the queue of released objects, which is collected by each explicit submission of the graphics queue (i.e. when no render context is presented).
+        inline void SetReleaseQueue(ReleaseQueue* releaseQueue)
+        {
+            releaseQueue_ = releaseQueue;
+        }
+
+    private:
+
+        // Validates the queue type of the command buffer and ends its recording. Returns false if the command buffer has nothing to submit.
+        bool PrepareCommandBuffer(VKCommandBuffer& commandBufferVK);
+
+        // Locks the mutex that guards the graphics queue against the present thread. Compute queues are not locked.
+        std::unique_lock<std::mutex> LockQueue();
+
+        // Appends a pending wait for all uploads that have been submitted to the transfer queue since the last submission.
+        void AppendTransferWait();
+
     private:
 
-        VkDevice    device_;
-        VkQueue     graphicsQueue_  = VK_NULL_HANDLE;
+        VkDevice                            device_;
+        VkQueue                             queue_          = VK_NULL_HANDLE;
+        VKStagingRing&                      stagingRing_;
+        bool                                isComputeQueue_ = false;    // Compute queues submit their command buffers explicitly, graphics queues submit them with the render context unless they are not presentable
+
+        std::vector<VkSemaphore>            pendingWaitSemaphores_;     // Timeline semaphores of CommandQueue::Wait, see TakePendingWaits
+        std::vector<std::uint64_t>          pendingWaitValues_;
+        std::vector<VkPipelineStageFlags>   pendingWaitStages_;
+
+        std::vector<VKCommandBuffer*>       submitCommandBuffers_;      // Command buffers of the current batch, see Submit(std::uint32_t, CommandBuffer* const*, Fence*, std::uint64_t)
+        std::vector<VkCommandBuffer>        vkCommandBuffers_;
+
+        VKTransferQueue*                    transferQueue_      = nullptr;  // Transfer queue of worker threads (optional), see SetTransferQueue
+        std::uint64_t                       transferWaitValue_  = 0;        // Last timeline value of the transfer queue this queue has waited for
+
+        ReleaseQueue*                       releaseQueue_       = nullptr;  // Released objects of the render system (graphics queue only), see SetReleaseQueue
 
 };
 
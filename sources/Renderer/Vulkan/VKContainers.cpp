@@ -23,6 +23,32 @@ VKWriteDescriptorContainer::VKWriteDescriptorContainer(std::size_t numResourceVi
 {
 }
 
+#ifdef VK_KHR_acceleration_structure
+
+VkWriteDescriptorSetAccelerationStructureKHR* VKWriteDescriptorContainer::NextAccelerationStructureInfo(VkAccelerationStructureKHR accelerationStructure)
+{
+    /* Acceleration structure infos are only allocated on demand, since they are rarely used */
+    if (accelerationStructureInfos.empty())
+    {
+        accelerationStructureInfos.resize(writeDescriptors.size());
+        accelerationStructures.resize(writeDescriptors.size());
+    }
+
+    auto index = numAccelerationStructureInfos++;
+    accelerationStructures[index] = accelerationStructure;
+
+    auto info = (&accelerationStructureInfos[index]);
+    {
+        info->sType                         = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+        info->pNext                         = nullptr;
+        info->accelerationStructureCount    = 1;
+        info->pAccelerationStructures       = &accelerationStructures[index];
+    }
+    return info;
+}
+
+#endif // /VK_KHR_acceleration_structure
+
 VkDescriptorBufferInfo* VKWriteDescriptorContainer::NextBufferInfo()
 {
     return &(bufferInfos[numBufferInfos++]);
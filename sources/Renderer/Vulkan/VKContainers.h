@@ -27,6 +27,9 @@ struct VKWriteDescriptorContainer
     VkDescriptorBufferInfo* NextBufferInfo();
     VkDescriptorImageInfo* NextImageInfo();
     VkWriteDescriptorSet* NextWriteDescriptor();
+    #ifdef VK_KHR_acceleration_structure
+    VkWriteDescriptorSetAccelerationStructureKHR* NextAccelerationStructureInfo(VkAccelerationStructureKHR accelerationStructure);
+    #endif
 
     std::vector<VkDescriptorBufferInfo> bufferInfos;
     std::uint32_t                       numBufferInfos      = 0;
@@ -36,6 +39,22 @@ struct VKWriteDescriptorContainer
 
     std::vector<VkWriteDescriptorSet>   writeDescriptors;
     std::uint32_t                       numWriteDescriptors = 0;
+
+    #ifdef VK_KHR_acceleration_structure
+    std::vector<VkWriteDescriptorSetAccelerationStructureKHR>   accelerationStructureInfos;
+    std::vector<VkAccelerationStructureKHR>                     accelerationStructures;
+    std::uint32_t                                               numAccelerationStructureInfos = 0;
+    #endif
+};
+
+// Descriptor information of a single resource view, as it is laid out for descriptor update templates.
+union VKDescriptorInfo
+{
+    VkDescriptorImageInfo       imageInfo;
+    VkDescriptorBufferInfo      bufferInfo;
+    #ifdef VK_KHR_acceleration_structure
+    VkAccelerationStructureKHR  accelerationStructure;
+    #endif
 };
 
 
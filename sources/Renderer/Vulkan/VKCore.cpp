@@ -6,6 +6,7 @@
  */
 
 #include "VKCore.h"
+#include "Ext/VKExtensions.h"
 #include "../../Core/Helper.h"
 #include "../../Core/HelperMacros.h"
 
@@ -98,6 +99,82 @@ VkBool32 VKBoolean(bool value)
     return (value ? VK_TRUE : VK_FALSE);
 }
 
+static VKAPI_ATTR void* VKAPI_CALL VKAllocationFunction(
+    void* userData, std::size_t size, std::size_t alignment, VkSystemAllocationScope /*allocationScope*/)
+{
+    return reinterpret_cast<AllocatorInterface*>(userData)->Allocate(size, alignment);
+}
+
+static VKAPI_ATTR void* VKAPI_CALL VKReallocationFunction(
+    void* userData, void* original, std::size_t size, std::size_t alignment, VkSystemAllocationScope /*allocationScope*/)
+{
+    return reinterpret_cast<AllocatorInterface*>(userData)->Reallocate(original, size, alignment);
+}
+
+static VKAPI_ATTR void VKAPI_CALL VKFreeFunction(void* userData, void* memory)
+{
+    reinterpret_cast<AllocatorInterface*>(userData)->Free(memory);
+}
+
+static VkAllocationCallbacks    g_allocationCallbacks;
+static bool                     g_allocationCallbacksEnabled = false;
+
+void VKSetAllocator(AllocatorInterface* allocator)
+{
+    if (allocator != nullptr)
+    {
+        g_allocationCallbacks.pUserData             = allocator;
+        g_allocationCallbacks.pfnAllocation         = VKAllocationFunction;
+        g_allocationCallbacks.pfnReallocation       = VKReallocationFunction;
+        g_allocationCallbacks.pfnFree               = VKFreeFunction;
+        g_allocationCallbacks.pfnInternalAllocation = nullptr;
+        g_allocationCallbacks.pfnInternalFree       = nullptr;
+        g_allocationCallbacksEnabled = true;
+    }
+    else
+        g_allocationCallbacksEnabled = false;
+}
+
+const VkAllocationCallbacks* VKGetAllocationCallbacks()
+{
+    return (g_allocationCallbacksEnabled ? &g_allocationCallbacks : nullptr);
+}
+
+VkImageAspectFlags VKGetImageAspectByFormat(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_D16_UNORM:           return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_X8_D24_UNORM_PACK32: return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_D32_SFLOAT:          return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:             return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:   return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D24_UNORM_S8_UINT:   return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:  return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:                            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+#ifdef VK_EXT_debug_utils
+
+void VKSetObjectName(VkDevice device, VkObjectType objectType, std::uint64_t objectHandle, const char* name)
+{
+    if (vkSetDebugUtilsObjectNameEXT != nullptr && objectHandle != 0)
+    {
+        VkDebugUtilsObjectNameInfoEXT nameInfo;
+        {
+            nameInfo.sType          = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+            nameInfo.pNext          = nullptr;
+            nameInfo.objectType     = objectType;
+            nameInfo.objectHandle   = objectHandle;
+            nameInfo.pObjectName    = name;
+        }
+        vkSetDebugUtilsObjectNameEXT(device, &nameInfo);
+    }
+}
+
+#endif // /VK_EXT_debug_utils
+
 
 /* ----- Query Functions ----- */
 
@@ -10,6 +10,7 @@
 
 
 #include "Vulkan.h"
+#include <LLGL/AllocatorInterface.h>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -38,10 +39,12 @@ struct QueueFamilyIndices
         {
             std::uint32_t graphicsFamily;
             std::uint32_t presentFamily;
-            //std::uint32_t transferFamily;
         };
     };
 
+    std::uint32_t computeFamily     = invalidIndex; // Dedicated compute family without graphics capabilities (optional)
+    std::uint32_t transferFamily    = invalidIndex; // Dedicated transfer family without graphics and compute capabilities (optional)
+
     inline bool Complete() const
     {
         return (graphicsFamily != invalidIndex && presentFamily != invalidIndex);
@@ -67,6 +70,22 @@ std::string VKApiVersionToString(std::uint32_t version);
 // Converts the boolean value into a VkBool322 value.
 VkBool32 VKBoolean(bool value);
 
+// Sets the host allocator that is forwarded to all Vulkan functions as allocation callbacks. Null restores the driver's allocator.
+void VKSetAllocator(AllocatorInterface* allocator);
+
+// Returns the allocation callbacks for all Vulkan functions, or null if the driver's allocator is used.
+const VkAllocationCallbacks* VKGetAllocationCallbacks();
+
+// Returns the image aspect of the specified format, i.e. depth and/or stencil for depth-stencil formats, and color for all other formats.
+VkImageAspectFlags VKGetImageAspectByFormat(VkFormat format);
+
+#ifdef VK_EXT_debug_utils
+
+// Sets the debug name of the specified Vulkan object with vkSetDebugUtilsObjectNameEXT. Has no effect if VK_EXT_debug_utils has not been loaded.
+void VKSetObjectName(VkDevice device, VkObjectType objectType, std::uint64_t objectHandle, const char* name);
+
+#endif
+
 
 
 /* ----- Query Functions ----- */
@@ -12,22 +12,22 @@
 extern "C"
 {
 
-LLGL_EXPORT int LLGL_RenderSystem_BuildID()
+LLGL_EXPORT int LLGL_MODULE_PROC(BuildID, Vulkan)()
 {
     return LLGL_BUILD_ID;
 }
 
-LLGL_EXPORT int LLGL_RenderSystem_RendererID()
+LLGL_EXPORT int LLGL_MODULE_PROC(RendererID, Vulkan)()
 {
     return LLGL::RendererID::Vulkan;
 }
 
-LLGL_EXPORT const char* LLGL_RenderSystem_Name()
+LLGL_EXPORT const char* LLGL_MODULE_PROC(Name, Vulkan)()
 {
     return "Vulkan";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc)
+LLGL_EXPORT void* LLGL_MODULE_PROC(Alloc, Vulkan)(const void* renderSystemDesc)
 {
     auto desc = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
     return new LLGL::VKRenderSystem(*desc);
@@ -9,8 +9,8 @@
 #define LLGL_VK_PTR_H
 
 
+#include "VKCore.h"
 #include <functional>
-#include <vulkan/vulkan.h>
 
 
 namespace LLGL
@@ -25,31 +25,31 @@ class VKPtr
     public:
 
         VKPtr() :
-            VKPtr { [](T, VkAllocationCallbacks*) {} }
+            VKPtr { [](T, const VkAllocationCallbacks*) {} }
         {
         }
 
-        VKPtr(const std::function<void(T, VkAllocationCallbacks*)>& deleter)
+        VKPtr(const std::function<void(T, const VkAllocationCallbacks*)>& deleter)
         {
             deleter_ = [=](T obj)
             {
-                deleter(obj, nullptr);
+                deleter(obj, VKGetAllocationCallbacks());
             };
         }
 
-        VKPtr(const VKPtr<VkInstance>& instance, const std::function<void(VkInstance, T, VkAllocationCallbacks*)>& deleter)
+        VKPtr(const VKPtr<VkInstance>& instance, const std::function<void(VkInstance, T, const VkAllocationCallbacks*)>& deleter)
         {
             deleter_ = [&instance, deleter](T obj)
             {
-                deleter(instance, obj, nullptr);
+                deleter(instance, obj, VKGetAllocationCallbacks());
             };
         }
 
-        VKPtr(const VKPtr<VkDevice>& device, const std::function<void(VkDevice, T, VkAllocationCallbacks*)>& deleter)
+        VKPtr(const VKPtr<VkDevice>& device, const std::function<void(VkDevice, T, const VkAllocationCallbacks*)>& deleter)
         {
             deleter_ = [&device, deleter](T obj)
             {
-                deleter(device, obj, nullptr);
+                deleter(device, obj, VKGetAllocationCallbacks());
             };
         }
 
@@ -7,11 +7,15 @@
 
 #include "VKRenderContext.h"
 #include "VKCommandBuffer.h"
+#include "VKStagingRing.h"
+#include "VKCommandQueue.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "../ReleaseQueue.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include "../../Core/Helper.h"
+#include <algorithm>
 #include <set>
 
 
@@ -26,11 +30,65 @@ static const std::vector<const char*> g_deviceExtensions
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
 
+// Maximal number of frames that can be recorded ahead of the GPU
+static const std::uint32_t g_maxFramesInFlight = 3;
+
+// Returns true if the procedures of the extension VK_GOOGLE_display_timing have been loaded.
+static bool HasDisplayTiming()
+{
+    #ifdef VK_GOOGLE_display_timing
+    return (vkGetRefreshCycleDurationGOOGLE != nullptr && vkGetPastPresentationTimingGOOGLE != nullptr);
+    #else
+    return false;
+    #endif
+}
+
+// Presents the specified swap-chain image once the semaphore has been signaled. The queue must be locked.
+static void PresentSwapChainImage(VkQueue queue, VkSwapchainKHR swapChain, std::uint32_t imageIndex, VkSemaphore waitSemaphore, std::uint32_t presentID)
+{
+    VkPresentInfoKHR presentInfo;
+    {
+        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext               = nullptr;
+        presentInfo.waitSemaphoreCount  = 1;
+        presentInfo.pWaitSemaphores     = &waitSemaphore;
+        presentInfo.swapchainCount      = 1;
+        presentInfo.pSwapchains         = &swapChain;
+        presentInfo.pImageIndices       = &imageIndex;
+        presentInfo.pResults            = nullptr;
+    }
+
+    #ifdef VK_GOOGLE_display_timing
+    /* Tag the presentation with an ID, so its timing can be queried with vkGetPastPresentationTimingGOOGLE (zero disables the timing) */
+    VkPresentTimeGOOGLE presentTime;
+    VkPresentTimesInfoGOOGLE presentTimesInfo;
+    if (presentID != 0)
+    {
+        presentTime.presentID               = presentID;
+        presentTime.desiredPresentTime      = 0;
+
+        presentTimesInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+        presentTimesInfo.pNext              = nullptr;
+        presentTimesInfo.swapchainCount     = 1;
+        presentTimesInfo.pTimes             = &presentTime;
+
+        presentInfo.pNext                   = &presentTimesInfo;
+    }
+    #endif // /VK_GOOGLE_display_timing
+
+    auto result = vkQueuePresentKHR(queue, &presentInfo);
+    VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
+}
+
 VKRenderContext::VKRenderContext(
     const VKPtr<VkInstance>& instance,
     VkPhysicalDevice physicalDevice,
     const VKPtr<VkDevice>& device,
     VKDeviceMemoryManager& deviceMemoryMngr,
+    VKStagingRing& stagingRing,
+    ReleaseQueue& releaseQueue,
+    VKCommandQueue& commandQueue,
+    VKRenderPassCache& renderPassCache,
     RenderContextDescriptor desc,
     const std::shared_ptr<Surface>& surface) :
         RenderContext        { desc.videoMode, desc.vsync    },
@@ -38,10 +96,14 @@ VKRenderContext::VKRenderContext(
         physicalDevice_      { physicalDevice                },
         device_              { device                        },
         deviceMemoryMngr_    { deviceMemoryMngr              },
+        stagingRing_         { stagingRing                   },
+        releaseQueue_        { releaseQueue                  },
+        commandQueue_        { commandQueue                  },
         surface_             { instance, vkDestroySurfaceKHR },
         swapChain_           { device, vkDestroySwapchainKHR },
-        swapChainRenderPass_ { device, vkDestroyRenderPass   },
-        depthStencilBuffer_  { device                        }
+        renderPassCache_     { renderPassCache               },
+        depthStencilBuffer_  { device                        },
+        numFramesInFlight_   { std::max(1u, std::min(desc.framesInFlight, g_maxFramesInFlight)) }
 {
     SetOrCreateSurface(surface, desc.videoMode, nullptr);
     desc.videoMode = GetVideoMode();
@@ -54,10 +116,15 @@ VKRenderContext::VKRenderContext(
 
     CreateSwapChainRenderPass();
     CreateSwapChain(desc.videoMode, desc.vsync);
+
+    /* Start thread for swap-chain presentation */
+    if (desc.threadedPresent)
+        presentThread_ = MakeUnique<PresentThread>();
 }
 
 VKRenderContext::~VKRenderContext()
 {
+    StopPresentThread();
     ReleaseDepthStencilBuffer();
 }
 
@@ -66,51 +133,112 @@ void VKRenderContext::Present()
     if (!commandBuffer_)
         throw std::runtime_error("no command buffer set to present render context");
 
-    /* End command buffer and render pass */
+    /* End render pass, timer scope frame, and command buffer */
     commandBuffer_->SetRenderPassNull();
+    commandBuffer_->CloseTimerScopeFrame();
     commandBuffer_->EndCommandBuffer();
 
-    /* Initialize semaphorse */
-    VkSemaphore waitSemaphorse[] = { imageAvailableSemaphore_ };
-    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    VkSemaphore signalSemaphorse[] = { renderFinishedSemaphore_ };
+    /* Wait until the present thread has presented the previous frame and acquired the image of this frame */
+    FlushPresentThread();
+
+    /* Initialize semaphorse: wait for the swap-chain image and for all timeline fences the command queue has been waiting for */
+    waitSemaphores_.assign(1, imageAvailableSemaphores_[currentFrame_]);
+    waitValues_.assign(1, 0);
+    commandQueue_.TakePendingWaits(waitSemaphores_, waitValues_);
+
+    waitStages_.assign(waitSemaphores_.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    waitStages_[0] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+    VkSemaphore signalSemaphorse[] = { renderFinishedSemaphores_[currentFrame_] };
     VkCommandBuffer commandBuffers[] = { commandBuffer_->GetVkCommandBuffer() };
 
-    /* Submit command buffer to graphics queue */
+    /* Submit pending resource uploads first, so they are executed before the commands of this frame */
+    stagingRing_.Flush();
+
+    /* Submit command buffer to graphics queue (the wait values are ignored for the binary semaphores) */
     VkSubmitInfo submitInfo;
     {
         submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.pNext                = nullptr;
-        submitInfo.waitSemaphoreCount   = 1;
-        submitInfo.pWaitSemaphores      = waitSemaphorse;
-        submitInfo.pWaitDstStageMask    = waitStages;
+        submitInfo.waitSemaphoreCount   = static_cast<std::uint32_t>(waitSemaphores_.size());
+        submitInfo.pWaitSemaphores      = waitSemaphores_.data();
+        submitInfo.pWaitDstStageMask    = waitStages_.data();
         submitInfo.commandBufferCount   = 1;
         submitInfo.pCommandBuffers      = commandBuffers;
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores    = signalSemaphorse;
     }
+
+    #ifdef VK_KHR_timeline_semaphore
+    const std::uint64_t signalValues[] = { 0 };
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+    if (waitSemaphores_.size() > 1)
+    {
+        timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.pNext                      = nullptr;
+        timelineInfo.waitSemaphoreValueCount    = static_cast<std::uint32_t>(waitValues_.size());
+        timelineInfo.pWaitSemaphoreValues       = waitValues_.data();
+        timelineInfo.signalSemaphoreValueCount  = 1;
+        timelineInfo.pSignalSemaphoreValues     = signalValues;
+        submitInfo.pNext                        = &timelineInfo;
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
     auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, commandBuffer_->GetQueueSubmitFence());
     VKThrowIfFailed(result, "failed to submit Vulkan graphics queue");
 
-    /* Present result on screen */
-    VkSwapchainKHR swapChains[] = { swapChain_ };
+    /* Destroy the objects released during this frame once the GPU has completed it, and those of previous frames that have been completed already */
+    if (releaseQueue_.HasPending())
+        releaseQueue_.Submit(stagingRing_.Signal());
+    releaseQueue_.Collect(stagingRing_.PollCompletedValue());
 
-    VkPresentInfoKHR presentInfo;
+    /* Move on to the next frame */
+    const auto presentFrame = currentFrame_;
+    const auto presentID    = (HasDisplayTiming() ? ++presentID_ : 0u);
+    currentFrame_ = (currentFrame_ + 1) % numFramesInFlight_;
+
+    commandBuffer_->SetFrameIndex(currentFrame_);
+    VkFence frameFence = commandBuffer_->GetQueueSubmitFence();
+
+    if (presentThread_)
     {
-        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pNext               = nullptr;
-        presentInfo.waitSemaphoreCount  = 1;
-        presentInfo.pWaitSemaphores     = signalSemaphorse;
-        presentInfo.swapchainCount      = 1;
-        presentInfo.pSwapchains         = swapChains;
-        presentInfo.pImageIndices       = &presentImageIndex_;
-        presentInfo.pResults            = nullptr;
+        /* Wait until the GPU has completed the frame that last used the semaphores and command buffer of the next frame */
+        vkWaitForFences(device_, 1, &frameFence, VK_TRUE, UINT64_MAX);
+
+        /* Hand presentation and acquisition of the next image over to the present thread, so the caller can record the next frame while they block */
+        VkDevice        device                  = device_;
+        VkQueue         presentQueue            = presentQueue_;
+        VkSwapchainKHR  swapChain               = swapChain_;
+        VkSemaphore     renderFinishedSemaphore = renderFinishedSemaphores_[presentFrame];
+        VkSemaphore     imageAvailableSemaphore = imageAvailableSemaphores_[currentFrame_];
+        std::mutex*     queueMutex              = &(stagingRing_.GetQueueMutex());
+        std::uint32_t*  presentImageIndex       = &presentImageIndex_;
+
+        presentThread_->Enqueue(
+            [=]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock { *queueMutex };
+                    PresentSwapChainImage(presentQueue, swapChain, *presentImageIndex, renderFinishedSemaphore, presentID);
+                }
+                vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, presentImageIndex);
+            }
+        );
     }
-    result = vkQueuePresentKHR(presentQueue_, &presentInfo);
-    VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
+    else
+    {
+        /* Present result on screen */
+        {
+            std::lock_guard<std::mutex> lock { stagingRing_.GetQueueMutex() };
+            PresentSwapChainImage(presentQueue_, swapChain_, presentImageIndex_, renderFinishedSemaphores_[presentFrame], presentID);
+        }
 
-    /* Get image index for next presentation */
-    AcquireNextPresentImage();
+        /* Wait until the GPU has completed the frame that last used the semaphores and command buffer of the next frame */
+        vkWaitForFences(device_, 1, &frameFence, VK_TRUE, UINT64_MAX);
+
+        /* Get image index for next presentation */
+        AcquireNextPresentImage();
+    }
 }
 
 Format VKRenderContext::QueryColorFormat() const
@@ -128,7 +256,30 @@ Format VKRenderContext::QueryDepthStencilFormat() const
 void VKRenderContext::SetPresentCommandBuffer(VKCommandBuffer* commandBuffer)
 {
     commandBuffer_ = commandBuffer;
-    commandBuffer_->SetPresentIndex(presentImageIndex_);
+    commandBuffer_->SetFrameIndex(currentFrame_);
+}
+
+VkFramebuffer VKRenderContext::GetSwapChainFramebuffer()
+{
+    FlushPresentThread();
+    return swapChainFramebuffers_[presentImageIndex_].Get();
+}
+
+VkImage VKRenderContext::GetSwapChainImage()
+{
+    FlushPresentThread();
+    return swapChainImages_[presentImageIndex_];
+}
+
+void VKRenderContext::FlushPresentThread()
+{
+    if (presentThread_)
+        presentThread_->Flush();
+}
+
+void VKRenderContext::StopPresentThread()
+{
+    presentThread_.reset();
 }
 
 bool VKRenderContext::HasDepthStencilBuffer() const
@@ -145,19 +296,27 @@ bool VKRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 {
     const auto& prevVideoMode = GetVideoMode();
 
-    /* Wait until graphics queue is idle before resources are destroyed and recreated */
+    /* Wait until the present thread and the graphics queue are idle before resources are destroyed and recreated */
+    FlushPresentThread();
     vkQueueWaitIdle(graphicsQueue_);
 
-    /* Recreate presenting semaphores and Vulkan surface */
+    /* Recreate presenting semaphores, since the last acquired image might have left one of them signaled */
     CreatePresentSemaphores();
-    CreateGpuSurface();
 
-    /* Recreate (or just release) depth-stencil buffer */
-    ReleaseDepthStencilBuffer();
-    if (videoModeDesc.depthBits > 0 || videoModeDesc.stencilBits > 0)
-        CreateDepthStencilBuffer(videoModeDesc);
+    /* Keep Vulkan surface (it only depends on the window), but query its new capabilities */
+    surfaceSupportDetails_ = VKQuerySurfaceSupport(physicalDevice_, surface_);
 
-    /* Recreate only swap-chain but keep render pass (independent of swap-chain object) */
+    /* Recreate (or just release) depth-stencil buffer only if its size or format has changed */
+    if (prevVideoMode.resolution  != videoModeDesc.resolution ||
+        prevVideoMode.depthBits   != videoModeDesc.depthBits  ||
+        prevVideoMode.stencilBits != videoModeDesc.stencilBits)
+    {
+        ReleaseDepthStencilBuffer();
+        if (videoModeDesc.depthBits > 0 || videoModeDesc.stencilBits > 0)
+            CreateDepthStencilBuffer(videoModeDesc);
+    }
+
+    /* Recreate only swap-chain (from the previous one) but keep render pass (independent of swap-chain object) */
     CreateSwapChain(videoModeDesc, GetVsync());
 
     /* Switch fullscreen mode */
@@ -170,10 +329,60 @@ bool VKRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 bool VKRenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 {
     /* Recreate swap-chain with new vsnyc settings */
+    FlushPresentThread();
     CreateSwapChain(GetVideoMode(), vsyncDesc);
     return true;
 }
 
+bool VKRenderContext::OnQueryFrameStatistics(FrameStatistics& frameStats)
+{
+    #ifdef VK_GOOGLE_display_timing
+
+    if (!HasDisplayTiming())
+        return false;
+
+    /* Host access to the swap-chain must be synchronized with the present thread */
+    FlushPresentThread();
+
+    /* Take the most recent of all presentation timings that became available since the previous query (each timing is only reported once) */
+    std::uint32_t numTimings = 0;
+    if (vkGetPastPresentationTimingGOOGLE(device_, swapChain_, &numTimings, nullptr) != VK_SUCCESS)
+        return false;
+
+    if (numTimings > 0)
+    {
+        presentTimings_.resize(numTimings);
+        auto result = vkGetPastPresentationTimingGOOGLE(device_, swapChain_, &numTimings, presentTimings_.data());
+        if (result != VK_SUCCESS && result != VK_INCOMPLETE)
+            return false;
+
+        for (std::uint32_t i = 0; i < numTimings; ++i)
+        {
+            if (presentTimings_[i].presentID > lastPresentTiming_.presentID)
+                lastPresentTiming_ = presentTimings_[i];
+        }
+    }
+
+    if (lastPresentTiming_.presentID == 0)
+        return false;
+
+    VkRefreshCycleDurationGOOGLE refreshCycle;
+    if (vkGetRefreshCycleDurationGOOGLE(device_, swapChain_, &refreshCycle) == VK_SUCCESS)
+        frameStats.refreshDuration = refreshCycle.refreshDuration;
+
+    /* Actual present times of VK_GOOGLE_display_timing are in nanoseconds of CLOCK_MONOTONIC */
+    frameStats.presentID    = lastPresentTiming_.presentID;
+    frameStats.presentTime  = lastPresentTiming_.actualPresentTime;
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /VK_GOOGLE_display_timing
+}
+
 void VKRenderContext::CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore)
 {
     /* Create semaphore (no flags) */
@@ -183,15 +392,23 @@ void VKRenderContext::CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore)
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
     }
-    auto result = vkCreateSemaphore(device_, &createInfo, nullptr, semaphore.ReleaseAndGetAddressOf());
+    auto result = vkCreateSemaphore(device_, &createInfo, VKGetAllocationCallbacks(), semaphore.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan semaphore");
 }
 
 void VKRenderContext::CreatePresentSemaphores()
 {
-    /* Create presentation semaphorse */
-    CreateGpuSemaphore(imageAvailableSemaphore_);
-    CreateGpuSemaphore(renderFinishedSemaphore_);
+    /* Create presentation semaphorse for each frame in flight */
+    imageAvailableSemaphores_.resize(numFramesInFlight_, VKPtr<VkSemaphore> { device_, vkDestroySemaphore });
+    renderFinishedSemaphores_.resize(numFramesInFlight_, VKPtr<VkSemaphore> { device_, vkDestroySemaphore });
+
+    for (std::uint32_t i = 0; i < numFramesInFlight_; ++i)
+    {
+        CreateGpuSemaphore(imageAvailableSemaphores_[i]);
+        CreateGpuSemaphore(renderFinishedSemaphores_[i]);
+    }
+
+    currentFrame_ = 0;
 }
 
 void VKRenderContext::CreateGpuSurface()
@@ -214,7 +431,7 @@ void VKRenderContext::CreateGpuSurface()
         createInfo.hinstance    = GetModuleHandle(NULL);
         createInfo.hwnd         = nativeHandle.window;
     }
-    auto result = vkCreateWin32SurfaceKHR(instance_, &createInfo, nullptr, surface_.ReleaseAndGetAddressOf());
+    auto result = vkCreateWin32SurfaceKHR(instance_, &createInfo, VKGetAllocationCallbacks(), surface_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Win32 surface for Vulkan render context");
 
     #elif defined LLGL_OS_LINUX
@@ -227,7 +444,7 @@ void VKRenderContext::CreateGpuSurface()
         createInfo.dpy      = nativeHandle.display;
         createInfo.window   = nativeHandle.window;
     }
-    auto result = vkCreateXlibSurfaceKHR(instance_, &createInfo, nullptr, surface_.ReleaseAndGetAddressOf());
+    auto result = vkCreateXlibSurfaceKHR(instance_, &createInfo, VKGetAllocationCallbacks(), surface_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Xlib surface for Vulkan render context");
 
     #endif
@@ -239,84 +456,25 @@ void VKRenderContext::CreateGpuSurface()
 
 void VKRenderContext::CreateSwapChainRenderPass()
 {
-    VkAttachmentDescription attachments[2];
-
-    /* Initialize color attachment */
-    attachments[0].flags                = 0;
-    attachments[0].format               = swapChainFormat_.format;
-    attachments[0].samples              = VK_SAMPLE_COUNT_1_BIT;
-    attachments[0].loadOp               = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachments[0].storeOp              = VK_ATTACHMENT_STORE_OP_STORE;
-    attachments[0].stencilLoadOp        = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachments[0].stencilStoreOp       = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachments[0].initialLayout        = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachments[0].finalLayout          = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    if (HasDepthStencilBuffer())
-    {
-        /* Initialize depth-stencil attachment */
-        attachments[1].flags                = 0;
-        attachments[1].format               = depthStencilBuffer_.GetVkFormat();
-        attachments[1].samples              = VK_SAMPLE_COUNT_1_BIT;
-        attachments[1].loadOp               = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[1].storeOp              = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[1].stencilLoadOp        = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[1].stencilStoreOp       = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[1].initialLayout        = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[1].finalLayout          = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    }
-
-    /* Initialize color attachment reference */
-    VkAttachmentReference colorAttachmentRef;
-    {
-        colorAttachmentRef.attachment       = 0;
-        colorAttachmentRef.layout           = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
-
-    /* Initialize depth-stencil attachment reference */
-    VkAttachmentReference depthAttachmentRef;
+    /* Initialize framebuffer layout with a single color attachment, that is presented after each render pass */
+    VKRenderPassLayout layout;
     {
-        depthAttachmentRef.attachment       = 1;
-        depthAttachmentRef.layout           = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    }
-
-    /* Initialize sub-pass descriptor */
-    VkSubpassDescription subpassDesc = {};
-    {
-        subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpassDesc.colorAttachmentCount    = 1;
-        subpassDesc.pColorAttachments       = (&colorAttachmentRef);
+        layout.colorFormats         = { swapChainFormat_.format };
+        layout.colorFinalLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
         if (HasDepthStencilBuffer())
-            subpassDesc.pDepthStencilAttachment = (&depthAttachmentRef);
+            layout.depthStencilFormat = depthStencilBuffer_.GetVkFormat();
     }
 
-    /* Initialize sub-pass dependency */
-    VkSubpassDependency subpassDep;
+    /* Create default render pass, which discards the previous content of the back buffer and stencil buffer */
+    RenderPassDescriptor defaultDesc;
     {
-        subpassDep.srcSubpass               = VK_SUBPASS_EXTERNAL;
-        subpassDep.dstSubpass               = 0;
-        subpassDep.srcStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDep.dstStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDep.srcAccessMask            = 0;
-        subpassDep.dstAccessMask            = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        subpassDep.dependencyFlags          = 0;
+        defaultDesc.colorAttachments            = { AttachmentOpsDescriptor{} };
+        defaultDesc.colorAttachments[0].loadOp  = AttachmentLoadOp::Undefined;
+        defaultDesc.depthAttachment.loadOp      = AttachmentLoadOp::Undefined;
+        defaultDesc.stencilAttachment.loadOp    = AttachmentLoadOp::Undefined;
+        defaultDesc.stencilAttachment.storeOp   = AttachmentStoreOp::Undefined;
     }
-
-    /* Create swap-chain render pass */
-    VkRenderPassCreateInfo createInfo;
-    {
-        createInfo.sType                    = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
-        createInfo.flags                    = 0;
-        createInfo.attachmentCount          = (HasDepthStencilBuffer() ? 2 : 1);
-        createInfo.pAttachments             = attachments;
-        createInfo.subpassCount             = 1;
-        createInfo.pSubpasses               = (&subpassDesc);
-        createInfo.dependencyCount          = 1;
-        createInfo.pDependencies            = (&subpassDep);
-    }
-    auto result = vkCreateRenderPass(device_, &createInfo, nullptr, swapChainRenderPass_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan swap-chain render pass");
+    renderPassSet_.Reset(renderPassCache_, layout, defaultDesc);
 }
 
 void VKRenderContext::CreateSwapChain(const VideoModeDescriptor& videoModeDesc, const VsyncDescriptor& vsyncDesc)
@@ -341,7 +499,10 @@ void VKRenderContext::CreateSwapChain(const VideoModeDescriptor& videoModeDesc,
     vkGetDeviceQueue(device_, queueFamilyIndices.presentFamily, 0, &presentQueue_);
 
     /* Pick swap-chain presentation mode (with v-sync parameters) */
-    auto presentMode = PickSwapPresentMode(surfaceSupportDetails_.presentModes, vsyncDesc);
+    auto presentMode = PickSwapPresentMode(surfaceSupportDetails_.presentModes, videoModeDesc.presentMode, vsyncDesc);
+
+    /* Retire previous swap-chain, so the driver can reuse its resources for the new one; it is destroyed at the end of this function */
+    VKPtr<VkSwapchainKHR> oldSwapChain { std::move(swapChain_) };
 
     /* Create swap-chain */
     VkSwapchainCreateInfoKHR createInfo;
@@ -374,9 +535,9 @@ void VKRenderContext::CreateSwapChain(const VideoModeDescriptor& videoModeDesc,
         createInfo.compositeAlpha               = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
         createInfo.presentMode                  = presentMode;
         createInfo.clipped                      = VK_TRUE;
-        createInfo.oldSwapchain                 = VK_NULL_HANDLE;
+        createInfo.oldSwapchain                 = oldSwapChain.Get();
     }
-    auto result = vkCreateSwapchainKHR(device_, &createInfo, nullptr, swapChain_.ReleaseAndGetAddressOf());
+    auto result = vkCreateSwapchainKHR(device_, &createInfo, VKGetAllocationCallbacks(), swapChain_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan swap-chain");
 
     /* Query swap-chain images */
@@ -420,7 +581,7 @@ void VKRenderContext::CreateSwapChainImageViews()
             createInfo.subresourceRange.baseArrayLayer  = 0;
             createInfo.subresourceRange.layerCount      = 1;
         }
-        auto result = vkCreateImageView(device_, &createInfo, nullptr, swapChainImageViews_[i].ReleaseAndGetAddressOf());
+        auto result = vkCreateImageView(device_, &createInfo, VKGetAllocationCallbacks(), swapChainImageViews_[i].ReleaseAndGetAddressOf());
         VKThrowIfFailed(result, "failed to create Vulkan swap-chain image view");
     }
 }
@@ -441,7 +602,7 @@ void VKRenderContext::CreateSwapChainFramebuffers()
         createInfo.sType            = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         createInfo.pNext            = nullptr;
         createInfo.flags            = 0;
-        createInfo.renderPass       = swapChainRenderPass_;
+        createInfo.renderPass       = renderPassSet_.GetDefault();
         createInfo.attachmentCount  = (HasDepthStencilBuffer() ? 2 : 1);
         createInfo.pAttachments     = attachments;
         createInfo.width            = swapChainExtent_.width;
@@ -455,7 +616,7 @@ void VKRenderContext::CreateSwapChainFramebuffers()
         attachments[0] = swapChainImageViews_[i].Get();
 
         /* Create framebuffer */
-        auto result = vkCreateFramebuffer(device_, &createInfo, nullptr, swapChainFramebuffers_[i].ReleaseAndGetAddressOf());
+        auto result = vkCreateFramebuffer(device_, &createInfo, VKGetAllocationCallbacks(), swapChainFramebuffers_[i].ReleaseAndGetAddressOf());
         VKThrowIfFailed(result, "failed to create Vulkan swap-chain framebuffer");
     }
 }
@@ -492,8 +653,28 @@ VkSurfaceFormatKHR VKRenderContext::PickSwapSurfaceFormat(const std::vector<VkSu
     return surfaceFormats.front();
 }
 
-VkPresentModeKHR VKRenderContext::PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, const VsyncDescriptor& vsyncDesc) const
+// Returns the Vulkan presentation mode for the specified explicit mode (PresentMode::Default is not mapped).
+static VkPresentModeKHR ToVkPresentMode(const PresentMode presentMode)
 {
+    switch (presentMode)
+    {
+        case PresentMode::FifoRelaxed:  return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        case PresentMode::Mailbox:      return VK_PRESENT_MODE_MAILBOX_KHR;
+        case PresentMode::Immediate:    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+        default:                        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+}
+
+VkPresentModeKHR VKRenderContext::PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, const PresentMode presentMode, const VsyncDescriptor& vsyncDesc) const
+{
+    if (presentMode != PresentMode::Default)
+    {
+        /* Use explicit presentation mode if available, otherwise fall back to FIFO (which is always available) */
+        const auto mode = ToVkPresentMode(presentMode);
+        if (std::find(presentModes.begin(), presentModes.end(), mode) != presentModes.end())
+            return mode;
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
     if (!vsyncDesc.enabled)
     {
         /* Check if MAILBOX or IMMEDIATE presentation mode is available, to avoid vertical synchronization */
@@ -546,7 +727,7 @@ void VKRenderContext::AcquireNextPresentImage()
         device_,
         swapChain_,
         UINT64_MAX,
-        imageAvailableSemaphore_,
+        imageAvailableSemaphores_[currentFrame_],
         VK_NULL_HANDLE,
         &presentImageIndex_
     );
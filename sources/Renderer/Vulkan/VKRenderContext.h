@@ -14,6 +14,8 @@
 #include "VKCore.h"
 #include "VKPtr.h"
 #include "Texture/VKDepthStencilBuffer.h"
+#include "RenderState/VKRenderPassCache.h"
+#include "../PresentThread.h"
 #include <memory>
 #include <vector>
 
@@ -25,6 +27,9 @@ namespace LLGL
 class VKCommandBuffer;
 class VKDeviceMemoryManager;
 class VKDeviceMemoryRegion;
+class VKStagingRing;
+class VKCommandQueue;
+class ReleaseQueue;
 
 class VKRenderContext final : public RenderContext
 {
@@ -38,6 +43,10 @@ class VKRenderContext final : public RenderContext
             VkPhysicalDevice physicalDevice,
             const VKPtr<VkDevice>& device,
             VKDeviceMemoryManager& deviceMemoryMngr,
+            VKStagingRing& stagingRing,
+            ReleaseQueue& releaseQueue,
+            VKCommandQueue& commandQueue,
+            VKRenderPassCache& renderPassCache,
             RenderContextDescriptor desc,
             const std::shared_ptr<Surface>& surface
         );
@@ -53,29 +62,36 @@ class VKRenderContext final : public RenderContext
 
         void SetPresentCommandBuffer(VKCommandBuffer* commandBuffer);
 
-        inline const VKPtr<VkRenderPass>& GetSwapChainRenderPass() const
+        // Returns the default swap-chain render pass, which discards the previous content of the back buffer.
+        inline VkRenderPass GetSwapChainRenderPass() const
         {
-            return swapChainRenderPass_;
+            return renderPassSet_.GetDefault();
         }
 
-        // Returns the number of images the swap chain has.
-        inline size_t GetSwapChainSize() const
+        // Returns the set of all Vulkan render passes that are used with the swap-chain.
+        inline VKRenderPassSet& GetRenderPassSet()
         {
-            return swapChainImages_.size();
+            return renderPassSet_;
         }
 
-        // Returns the active VkFramebuffer object from the swap chain.
-        inline VkFramebuffer GetSwapChainFramebuffer() const
+        // Returns the number of frames that can be recorded ahead of the GPU, which is also the number of primary command buffers per command buffer.
+        inline std::uint32_t GetNumFramesInFlight() const
         {
-            return swapChainFramebuffers_[presentImageIndex_].Get();
+            return numFramesInFlight_;
         }
 
-        // Returns the active VkImage object from the swap chain.
-        inline VkImage GetSwapChainImage() const
+        // Returns the number of images the swap chain has.
+        inline size_t GetSwapChainSize() const
         {
-            return swapChainImages_[presentImageIndex_];
+            return swapChainImages_.size();
         }
 
+        // Returns the active VkFramebuffer object from the swap chain. Waits until the present thread has acquired the image (if enabled).
+        VkFramebuffer GetSwapChainFramebuffer();
+
+        // Returns the active VkImage object from the swap chain. Waits until the present thread has acquired the image (if enabled).
+        VkImage GetSwapChainImage();
+
         // Returns the 2D extend (i.e. resolution) of the swap chain.
         inline const VkExtent2D& GetSwapChainExtent() const
         {
@@ -85,10 +101,17 @@ class VKRenderContext final : public RenderContext
         // Returns true if this render context has a depth-stencil buffer.
         bool HasDepthStencilBuffer() const;
 
+        // Waits until the present thread (if enabled) has presented all previous frames and acquired the next image.
+        void FlushPresentThread();
+
+        // Finishes all pending presentations and stops the present thread. Errors of pending presentations are discarded.
+        void StopPresentThread();
+
     private:
 
         bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+        bool OnQueryFrameStatistics(FrameStatistics& frameStats) override;
 
         void CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore);
         void CreatePresentSemaphores();
@@ -103,7 +126,7 @@ class VKRenderContext final : public RenderContext
         void ReleaseDepthStencilBuffer();
 
         VkSurfaceFormatKHR PickSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& surfaceFormats) const;
-        VkPresentModeKHR PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, const VsyncDescriptor& vsyncDesc) const;
+        VkPresentModeKHR PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, const PresentMode presentMode, const VsyncDescriptor& vsyncDesc) const;
         VkExtent2D PickSwapExtent(const VkSurfaceCapabilitiesKHR& surfaceCaps, std::uint32_t width, std::uint32_t height) const;
         VkFormat PickDepthStencilFormat() const;
         VkFormat PickDepthFormat() const;
@@ -117,12 +140,16 @@ class VKRenderContext final : public RenderContext
         const VKPtr<VkDevice>&              device_;
 
         VKDeviceMemoryManager&              deviceMemoryMngr_;
+        VKStagingRing&                      stagingRing_;
+        ReleaseQueue&                       releaseQueue_;              // Objects released by the render system, destroyed once the frame they were released in has been completed
+        VKCommandQueue&                     commandQueue_;              // Provides the timeline semaphores the frame must wait for, see CommandQueue::Wait
 
         VKPtr<VkSurfaceKHR>                 surface_;
         SurfaceSupportDetails               surfaceSupportDetails_;
 
         VKPtr<VkSwapchainKHR>               swapChain_;
-        VKPtr<VkRenderPass>                 swapChainRenderPass_;
+        VKRenderPassCache&                  renderPassCache_;           // Device-wide cache the swap-chain render passes are shared with
+        VKRenderPassSet                     renderPassSet_;
         VkSurfaceFormatKHR                  swapChainFormat_;
         VkExtent2D                          swapChainExtent_            = { 0, 0 };
         std::vector<VkImage>                swapChainImages_;
@@ -135,11 +162,27 @@ class VKRenderContext final : public RenderContext
         VkQueue                             graphicsQueue_              = VK_NULL_HANDLE;
         VkQueue                             presentQueue_               = VK_NULL_HANDLE;
 
-        VKPtr<VkSemaphore>                  imageAvailableSemaphore_;
-        VKPtr<VkSemaphore>                  renderFinishedSemaphore_;
+        /* Presentation semaphores per frame in flight */
+        std::vector<VKPtr<VkSemaphore>>     imageAvailableSemaphores_;
+        std::vector<VKPtr<VkSemaphore>>     renderFinishedSemaphores_;
+        std::uint32_t                       numFramesInFlight_          = 1;
+        std::uint32_t                       currentFrame_               = 0;
+
+        std::vector<VkSemaphore>            waitSemaphores_;            // Semaphores of the current frame submission, kept to avoid allocations per frame
+        std::vector<std::uint64_t>          waitValues_;
+        std::vector<VkPipelineStageFlags>   waitStages_;
 
         VKCommandBuffer*                    commandBuffer_              = nullptr;
 
+        std::unique_ptr<PresentThread>      presentThread_;             // Presents the swap-chain if RenderContextDescriptor::threadedPresent is enabled
+
+        std::uint32_t                       presentID_                  = 0;        // ID of the most recent presentation, only used with VK_GOOGLE_display_timing
+
+        #ifdef VK_GOOGLE_display_timing
+        std::vector<VkPastPresentationTimingGOOGLE> presentTimings_;
+        VkPastPresentationTimingGOOGLE              lastPresentTiming_  = {};       // Most recent presentation timing, see OnQueryFrameStatistics
+        #endif
+
 };
 
 
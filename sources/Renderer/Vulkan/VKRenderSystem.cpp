@@ -12,12 +12,19 @@
 #include "Memory/VKDeviceMemory.h"
 #include "Buffer/VKIndexBuffer.h"
 #include "../CheckedCast.h"
+#include "../MipChain.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Vendor.h"
+#include "../../Core/Assertion.h"
+#include "../../Core/TaskQueue.h"
 #include "../GLCommon/GLTypes.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include <LLGL/Log.h>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <set>
 
 //#define TEST_VULKAN_MEMORY_MNGR
 #ifdef TEST_VULKAN_MEMORY_MNGR
@@ -47,12 +54,21 @@ static void DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCall
         func(instance, callback, allocator);
 }
 
-static VkBufferUsageFlags GetVkBufferUsageFlags(long bufferFlags)
+static VkBufferUsageFlags GetVkBufferUsageFlags(long bufferFlags, bool hasRayQueries)
 {
-    if ((bufferFlags & BufferFlags::MapReadAccess) != 0)
-        return VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    else
-        return VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    /* Buffers can always be the source and destination of copy commands (TRANSFER_SRC_BIT is also required for read access) */
+    VkBufferUsageFlags usage = (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    if ((bufferFlags & BufferFlags::IndirectArguments) != 0)
+        usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    #ifdef VK_KHR_acceleration_structure
+    /* Inputs of acceleration structures are referenced by their device address */
+    if (hasRayQueries && (bufferFlags & BufferFlags::AccelerationStructureInput) != 0)
+        usage |= (VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR);
+    #endif
+
+    return usage;
 }
 
 static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long bufferFlags)
@@ -63,16 +79,76 @@ static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long bufferFlags)
         return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 }
 
-static void FillBufferCreateInfo(VkBufferCreateInfo& createInfo, VkDeviceSize size, VkBufferUsageFlags usage)
+// Returns true if the specified buffer is an append or consume storage buffer with a hidden counter.
+static bool HasBufferCounter(const BufferDescriptor& desc)
+{
+    return
+    (
+        desc.type == BufferType::Storage &&
+        (desc.storageBuffer.storageType == StorageBufferType::AppendStructuredBuffer ||
+         desc.storageBuffer.storageType == StorageBufferType::ConsumeStructuredBuffer)
+    );
+}
+
+/*
+Returns true if the specified buffer can be allocated in device local memory that is also host visible (e.g. with resizable BAR).
+Without resizable BAR, such a heap is usually limited to 256 MB, so it is only used for buffers that are small compared to the heap.
+*/
+static bool IsHostVisibleDeviceLocalMemorySuitable(const VkPhysicalDeviceMemoryProperties& memoryProperties, std::uint32_t memoryTypeBits, VkDeviceSize size)
+{
+    const VkMemoryPropertyFlags properties = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        /* Only check the first suitable memory type, since this is the one the device memory manager allocates from */
+        const auto& memoryType = memoryProperties.memoryTypes[i];
+        if ((memoryTypeBits & (1 << i)) != 0 && (memoryType.propertyFlags & properties) == properties)
+            return (size <= memoryProperties.memoryHeaps[memoryType.heapIndex].size / 4);
+    }
+
+    return false;
+}
+
+static void FillBufferCreateInfo(
+    VkBufferCreateInfo&                 createInfo,
+    VkDeviceSize                        size,
+    VkBufferUsageFlags                  usage,
+    const std::vector<std::uint32_t>*   sharedQueueFamilies = nullptr)
 {
     createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     createInfo.pNext                    = nullptr;
     createInfo.flags                    = 0;
     createInfo.size                     = size;
     createInfo.usage                    = usage;
-    createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
-    createInfo.queueFamilyIndexCount    = 0;
-    createInfo.pQueueFamilyIndices      = nullptr;
+
+    if (sharedQueueFamilies != nullptr && sharedQueueFamilies->size() > 1)
+    {
+        /* Share buffer between the graphics and compute queue families to avoid queue family ownership transfers */
+        createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies->size());
+        createInfo.pQueueFamilyIndices      = sharedQueueFamilies->data();
+    }
+    else
+    {
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+}
+
+// Returns the index of a queue family that supports all required but none of the excluded commands, or QueueFamilyIndices::invalidIndex if there is none.
+static std::uint32_t FindDedicatedQueueFamily(VkPhysicalDevice physicalDevice, VkQueueFlags requiredFlags, VkQueueFlags excludedFlags)
+{
+    auto queueFamilies = VKQueryQueueFamilyProperties(physicalDevice);
+
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(queueFamilies.size()); ++i)
+    {
+        const auto& family = queueFamilies[i];
+        if (family.queueCount > 0 && (family.queueFlags & requiredFlags) == requiredFlags && (family.queueFlags & excludedFlags) == 0)
+            return i;
+    }
+
+    return QueueFamilyIndices::invalidIndex;
 }
 
 #ifdef TEST_VULKAN_MEMORY_MNGR
@@ -125,16 +201,68 @@ static void TestVulkanMemoryMngr(VKDeviceMemoryManager& mngr)
 
 /* ----- Common ----- */
 
+// Number of primary command buffers per compute command buffer, so the next submission can be recorded while the previous one is executed
+static const std::size_t g_numComputeCommandBuffers = 2;
+
+// Number of primary command buffers per graphics command buffer that is created without a render context (headless mode)
+static const std::size_t g_numOffscreenCommandBuffers = 2;
+
 static const std::vector<const char*> g_deviceExtensions
 {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME,
     VK_KHR_MAINTENANCE1_EXTENSION_NAME,
 };
 
+// Device extensions that are only enabled if the physical device supports them
+static const std::vector<const char*> g_optionalDeviceExtensions
+{
+    #ifdef VK_KHR_descriptor_update_template
+    VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
+    #endif
+    #ifdef VK_KHR_timeline_semaphore
+    VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_memory_budget
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+    #endif
+    #ifdef VK_KHR_multiview
+    VK_KHR_MULTIVIEW_EXTENSION_NAME,
+    #endif
+    #ifdef VK_KHR_fragment_shading_rate
+    VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME,
+    #endif
+    #ifdef VK_KHR_draw_indirect_count
+    VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_conditional_rendering
+    VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_shader_viewport_index_layer
+    VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME,
+    #endif
+    #ifdef VK_GOOGLE_display_timing
+    VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_calibrated_timestamps
+    VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_conservative_rasterization
+    VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME,
+    #endif
+    #ifdef VK_EXT_mesh_shader
+    VK_EXT_MESH_SHADER_EXTENSION_NAME,
+    #endif
+    #ifdef VK_KHR_acceleration_structure
+    VK_KHR_RAY_QUERY_EXTENSION_NAME,
+    #endif
+};
+
 VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     instance_            { vkDestroyInstance                        },
     device_              { vkDestroyDevice                          },
-    debugReportCallback_ { instance_, DestroyDebugReportCallbackEXT }
+    debugReportCallback_ { instance_, DestroyDebugReportCallbackEXT },
+    pipelineCache_       { device_, vkDestroyPipelineCache          },
+    renderPassCache_     { device_                                  }
 {
     /* Extract optional renderer configuartion */
     const VulkanRendererConfiguration* rendererConfigVK= nullptr;
@@ -151,24 +279,104 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     debugLayerEnabled_ = true;
     #endif
 
+    /* Forward host allocator to all Vulkan functions */
+    VKSetAllocator(renderSystemDesc.allocator);
+
     /* Create Vulkan instance and device objects */
     CreateInstance(rendererConfigVK != nullptr ? &(rendererConfigVK->application) : nullptr);
     LoadExtensions();
 
-    if (!PickPhysicalDevice())
+    if (!PickPhysicalDevice(renderSystemDesc))
         throw std::runtime_error("failed to find physical device with Vulkan support");
 
     QueryDeviceProperties();
     CreateLogicalDevice();
-    CreateStagingCommandResources();
-    CreateDefaultPipelineLayout();
-
-    /* Create device memory manager */
-    deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
-        device_,
-        memoryProperties_,
-        (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
-        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
+
+    /*
+    Create uploads of worker threads on dedicated transfer queue asynchronously,
+    since allocating its staging memory does not depend on the remaining device objects
+    */
+    const auto stagingRingSize = static_cast<VkDeviceSize>(rendererConfigVK != nullptr ? rendererConfigVK->stagingRingSize : 4*1024*1024);
+
+    std::shared_future<void> transferUploadsReady;
+    if (transferQueue_ != VK_NULL_HANDLE)
+    {
+        transferUploadsReady = TaskQueue::Get().Enqueue(
+            [this, stagingRingSize]()
+            {
+                transferUploads_ = MakeUnique<VKTransferQueue>(
+                    device_,
+                    transferQueue_,
+                    queueFamilyIndices_.transferFamily,
+                    memoryProperties_,
+                    stagingRingSize
+                );
+            }
+        );
+    }
+
+    try
+    {
+        CreateDefaultPipelineLayout();
+        CreatePipelineCache();
+
+        /* Create device memory manager */
+        deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
+            device_,
+            memoryProperties_,
+            (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
+            (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false),
+            (rendererConfigVK != nullptr ? rendererConfigVK->deviceMemoryAllocator : VulkanDeviceMemoryAllocator::Linear),
+            hasRayQueries_
+        );
+
+        /* Create staging ring for asynchronous resource uploads */
+        stagingRing_ = MakeUnique<VKStagingRing>(
+            device_,
+            graphicsQueue_,
+            queueFamilyIndices_.graphicsFamily,
+            *deviceMemoryMngr_,
+            memoryProperties_,
+            stagingRingSize
+        );
+
+        /* Create shared descriptor pools for resource heaps */
+        descriptorSetAllocator_ = MakeUnique<VKDescriptorSetAllocator>(device_, hasRayQueries_);
+
+        /* Create command queue interface */
+        commandQueue_ = MakeUnique<VKCommandQueue>(device_, graphicsQueue_, *stagingRing_);
+        commandQueue_->SetReleaseQueue(&releaseQueue_);
+
+        if (computeQueue_ != VK_NULL_HANDLE)
+            computeCommandQueue_ = MakeUnique<VKCommandQueue>(device_, computeQueue_, *stagingRing_, true);
+        if (backgroundQueue_ != VK_NULL_HANDLE)
+            backgroundCommandQueue_ = MakeUnique<VKCommandQueue>(device_, backgroundQueue_, *stagingRing_, true);
+    }
+    catch (...)
+    {
+        /* Transfer queue task must not outlive this object */
+        if (transferUploadsReady.valid())
+            transferUploadsReady.wait();
+        throw;
+    }
+
+    /* Wait for uploads of worker threads on dedicated transfer queue, which are waited for by all other queues */
+    if (transferUploadsReady.valid())
+    {
+        transferUploadsReady.get();
+        commandQueue_->SetTransferQueue(transferUploads_.get());
+        if (computeCommandQueue_)
+            computeCommandQueue_->SetTransferQueue(transferUploads_.get());
+        if (backgroundCommandQueue_)
+            backgroundCommandQueue_->SetTransferQueue(transferUploads_.get());
+    }
+
+    /* Defer query of the texture format table, which requires one query per format */
+    SetDeferredRenderingCaps(
+        [this](RenderingCapabilities& caps)
+        {
+            QueryTextureFormats(caps.textureFormats);
+        }
     );
 
     #ifdef TEST_VULKAN_MEMORY_MNGR
@@ -178,9 +386,26 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
 
 VKRenderSystem::~VKRenderSystem()
 {
-    /* Release resource and wait until device becomes idle */
-    ReleaseStagingCommandResources();
+    /* Finish pending presentations, since the queues must not be accessed by other threads while the device becomes idle */
+    for (auto& renderContext : renderContexts_)
+        renderContext->StopPresentThread();
+
+    /* Wait until all pending uploads have been completed and device becomes idle */
+    stagingRing_->WaitIdle();
+    if (transferUploads_)
+        transferUploads_->WaitIdle();
     vkDeviceWaitIdle(device_);
+
+    /* Destroy all deferred objects, since the device is idle now */
+    releaseQueue_.Clear();
+
+    /* Release device memory of all texture and buffer readback buffers */
+    auto releaseReadbackBuffer = [this](ReadbackBuffer& staging)
+    {
+        deviceMemoryMngr_->Release(staging.memoryRegion);
+    };
+    textureReadbacks_.Clear(releaseReadbackBuffer);
+    bufferReadbacks_.Clear(releaseReadbackBuffer);
 }
 
 /* ----- Render Context ----- */
@@ -189,7 +414,7 @@ RenderContext* VKRenderSystem::CreateRenderContext(const RenderContextDescriptor
 {
     return TakeOwnership(
         renderContexts_,
-        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, desc, surface)
+        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, *stagingRing_, releaseQueue_, *commandQueue_, renderPassCache_, desc, surface)
     );
 }
 
@@ -205,26 +430,67 @@ CommandQueue* VKRenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* VKRenderSystem::GetCommandQueue(const QueueType type)
+{
+    switch (type)
+    {
+        case QueueType::Graphics:   return commandQueue_.get();
+        case QueueType::Compute:    return computeCommandQueue_.get();
+        case QueueType::Background: return backgroundCommandQueue_.get();
+    }
+    return nullptr;
+}
+
 /* ----- Command buffers ----- */
 
-CommandBuffer* VKRenderSystem::CreateCommandBuffer()
+CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    auto mainContext = renderContexts_.begin()->get();
+    if (desc.queueType == QueueType::Compute || desc.queueType == QueueType::Background)
+    {
+        if (computeQueue_ == VK_NULL_HANDLE)
+            throw std::runtime_error("cannot create Vulkan command buffer for compute queue (no dedicated compute queue family or VK_KHR_timeline_semaphore)");
+        if (desc.queueType == QueueType::Background && backgroundQueue_ == VK_NULL_HANDLE)
+            throw std::runtime_error("cannot create Vulkan command buffer for background queue (dedicated compute queue family has only one queue)");
+
+        /* Background queue is the second queue of the compute family, so its command buffers share the compute command pools */
+        return TakeOwnership(
+            commandBuffers_,
+            MakeUnique<VKCommandBuffer>(device_, g_numComputeCommandBuffers, queueFamilyIndices_, memoryProperties_, timestampPeriod_, constantBufferOffsetAlignment_, (features_.multiDrawIndirect != VK_FALSE), statistics_, QueueType::Compute)
+        );
+    }
+
+    /* Pipeline statistics of timer scopes require the respective device feature */
+    auto flags = desc.flags;
+    if (features_.pipelineStatisticsQuery == VK_FALSE)
+        flags &= ~CommandBufferFlags::TimerScopeStatistics;
+
+    /* Without a render context, command buffers can only render into render targets and are submitted by the command queue */
+    const auto bufferCount = (renderContexts_.empty() ? g_numOffscreenCommandBuffers : renderContexts_.begin()->get()->GetNumFramesInFlight());
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(device_, graphicsQueue_, mainContext->GetSwapChainSize(), queueFamilyIndices_)
+        MakeUnique<VKCommandBuffer>(device_, bufferCount, queueFamilyIndices_, memoryProperties_, timestampPeriod_, constantBufferOffsetAlignment_, (features_.multiDrawIndirect != VK_FALSE), statistics_, QueueType::Graphics, flags)
     );
 }
 
 CommandBufferExt* VKRenderSystem::CreateCommandBufferExt()
 {
-    /* Extended command buffers are not spported */
-    return nullptr;
+    /* Extended command buffers write their individual bindings into transient descriptor sets */
+    const auto bufferCount = (renderContexts_.empty() ? g_numOffscreenCommandBuffers : renderContexts_.begin()->get()->GetNumFramesInFlight());
+    return TakeOwnership(
+        commandBuffers_,
+        MakeUnique<VKCommandBuffer>(device_, bufferCount, queueFamilyIndices_, memoryProperties_, timestampPeriod_, constantBufferOffsetAlignment_, (features_.multiDrawIndirect != VK_FALSE), statistics_)
+    );
+}
+
+CommandBuffer* VKRenderSystem::CreateSecondaryCommandBuffer()
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<VKCommandBuffer>(device_, queueFamilyIndices_, (features_.multiDrawIndirect != VK_FALSE), statistics_));
 }
 
 void VKRenderSystem::Release(CommandBuffer& commandBuffer)
 {
-    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+    /* Defer destruction until the frames that might still execute this command buffer have been completed */
+    releaseQueue_.Release(commandBuffers_, &commandBuffer);
 }
 
 /* ----- Buffers ------ */
@@ -235,46 +501,65 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    FillBufferCreateInfo(
-        stagingCreateInfo,
-        static_cast<VkDeviceSize>(desc.size),
-        GetStagingVkBufferUsageFlags(desc.flags)
-    );
-
-    VKBufferWithRequirements stagingBuffer { device_ };
-    VKDeviceMemoryRegion* memoryRegionStaging = nullptr;
-
-    std::tie(stagingBuffer, memoryRegionStaging) = CreateStagingBuffer(stagingCreateInfo, initialData, static_cast<std::size_t>(desc.size));
-
     /* Create device buffer */
-    auto buffer = CreateHardwareBuffer(desc, GetVkBufferUsageFlags(desc.flags));
+    auto buffer = CreateHardwareBuffer(desc, GetVkBufferUsageFlags(desc.flags, hasRayQueries_));
 
-    /* Allocate device memory */
+    /* Allocate device memory (buffers with CPU access are mapped directly if device local memory is also host visible) */
     const auto& requirements = buffer->GetRequirements();
 
+    const bool hostVisible =
+    (
+        (desc.flags & g_stagingBufferRelatedFlags) != 0 &&
+        IsHostVisibleDeviceLocalMemorySuitable(memoryProperties_, requirements.memoryTypeBits, requirements.size)
+    );
+
     auto memoryRegion = deviceMemoryMngr_->Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        (hostVisible ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     );
 
-    buffer->BindToMemory(device_, memoryRegion);
+    buffer->BindToMemory(device_, memoryRegion, hostVisible);
 
-    /* Copy staging buffer into hardware buffer */
-    CopyBuffer(stagingBuffer.buffer, buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
-
-    if ((desc.flags & g_stagingBufferRelatedFlags) != 0)
+    if (!hostVisible && (desc.flags & g_stagingBufferRelatedFlags) != 0)
     {
+        /* Create persistent staging buffer for CPU access */
+        VkBufferCreateInfo stagingCreateInfo;
+        FillBufferCreateInfo(
+            stagingCreateInfo,
+            static_cast<VkDeviceSize>(desc.size),
+            GetStagingVkBufferUsageFlags(desc.flags)
+        );
+
+        VKBufferWithRequirements stagingBuffer { device_ };
+        VKDeviceMemoryRegion* memoryRegionStaging = nullptr;
+
+        std::tie(stagingBuffer, memoryRegionStaging) = CreateStagingBuffer(stagingCreateInfo, initialData, static_cast<std::size_t>(desc.size));
+
+        /* Copy staging buffer into hardware buffer (worker threads upload the initial data via the transfer queue instead) */
+        if (initialData != nullptr)
+        {
+            if (IsWorkerThread())
+                transferUploads_->WriteBuffer(buffer->GetVkBuffer(), 0, initialData, static_cast<VkDeviceSize>(desc.size));
+            else
+                CopyBuffer(stagingBuffer.buffer, buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
+        }
+
         /* Store ownership of staging buffer */
         buffer->TakeStagingBuffer(std::move(stagingBuffer), memoryRegionStaging);
     }
-    else
+    else if (initialData != nullptr)
     {
-        /* Release staging buffer */
-        deviceMemoryMngr_->Release(memoryRegionStaging);
+        /* Upload initial data via staging ring */
+        WriteBufferInternal(buffer->GetVkBuffer(), 0, initialData, static_cast<VkDeviceSize>(desc.size));
+    }
+
+    if (buffer->HasCounter())
+    {
+        /* Initialize hidden counter with zero */
+        const std::uint32_t initialCount = 0;
+        WriteBufferInternal(buffer->GetVkBuffer(), buffer->GetCounterOffset(), &initialCount, sizeof(initialCount));
     }
 
     return buffer;
@@ -289,11 +574,16 @@ BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void VKRenderSystem::Release(Buffer& buffer)
 {
-    /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
-    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
-    deviceMemoryMngr_->Release(bufferVK.GetMemoryRegion());
-    deviceMemoryMngr_->Release(bufferVK.GetMemoryRegionStaging());
-    RemoveFromUniqueSet(buffers_, &buffer);
+    /* Defer destruction until pending uploads and frames that might still refer to this buffer have been completed */
+    releaseQueue_.Release(
+        buffers_, &buffer,
+        [this](VKBuffer& bufferVK)
+        {
+            /* Release device memory regions for primary buffer and internal staging buffer before the buffer object is released */
+            deviceMemoryMngr_->Release(bufferVK.GetMemoryRegion());
+            deviceMemoryMngr_->Release(bufferVK.GetMemoryRegionStaging());
+        }
+    );
 }
 
 void VKRenderSystem::Release(BufferArray& bufferArray)
@@ -303,66 +593,132 @@ void VKRenderSystem::Release(BufferArray& bufferArray)
 
 void VKRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_STATISTICS_ADD(bytesUploaded, dataSize);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
-    auto memorySize     = static_cast<VkDeviceSize>(dataSize);
-    auto memoryOffset   = static_cast<VkDeviceSize>(offset);
+    /*
+    Always upload via staging ring (even if the buffer has its own staging buffer),
+    to avoid overwriting the staging buffer while a previous copy command is still pending
+    */
+    WriteBufferInternal(
+        bufferVK.GetVkBuffer(),
+        static_cast<VkDeviceSize>(offset),
+        data,
+        static_cast<VkDeviceSize>(dataSize)
+    );
+}
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
-    {
-        /* Copy data to staging buffer memory */
-        bufferVK.UpdateStagingBuffer(device_, data, memorySize, memoryOffset);
+void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+{
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    return MapBuffer(buffer, access, 0, bufferVK.GetSize());
+}
 
-        /* Copy staging buffer into hardware buffer */
-        CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), memorySize, memoryOffset, memoryOffset);
-    }
-    else
-    {
-        /* Create staging buffer */
-        VkBufferCreateInfo stagingCreateInfo;
-        FillBufferCreateInfo(
-            stagingCreateInfo,
-            static_cast<VkDeviceSize>(dataSize),
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
-        );
+void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    AssertBufferCPUAccess(bufferVK);
 
-        VKBufferWithRequirements stagingBuffer { device_ };
-        VKDeviceMemoryRegion* memoryRegionStaging = nullptr;
+    /*
+    Copy mapped range of GPU local buffer into staging buffer (host visible buffers are mapped directly).
+    This is also required for write-only access, because WriteBuffer does not update the staging buffer
+    and UnmapBuffer copies the entire mapped range back into the GPU local buffer.
+    */
+    if (!bufferVK.IsHostVisible())
+        CopyBuffer(bufferVK.GetVkBuffer(), bufferVK.GetStagingVkBuffer(), length, offset, offset);
 
-        std::tie(stagingBuffer, memoryRegionStaging) = CreateStagingBuffer(stagingCreateInfo, data, dataSize);
+    /* Wait until pending copy commands from and into the buffer have been completed */
+    stagingRing_->WaitIdle();
 
-        /* Copy staging buffer into hardware buffer */
-        CopyBuffer(stagingBuffer.buffer, bufferVK.GetVkBuffer(), memorySize, 0, memoryOffset);
+    /* Host visible buffers are mapped directly, so wait for all submitted command buffers that might still read or write the buffer */
+    if (bufferVK.IsHostVisible())
+        WaitForQueuesIdle();
 
-        /* Release device memory region */
-        deviceMemoryMngr_->Release(memoryRegionStaging);
-    }
+    /* Map staging buffer or host visible buffer */
+    return bufferVK.Map(device_, access, offset, length);
 }
 
-void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     AssertBufferCPUAccess(bufferVK);
 
-    /* Copy GPU local buffer into staging buffer for read accces */
-    if (access != CPUAccess::WriteOnly)
-        CopyBuffer(bufferVK.GetVkBuffer(), bufferVK.GetStagingVkBuffer(), bufferVK.GetSize());
+    /* Unmap staging buffer or host visible buffer */
+    bufferVK.Unmap(device_);
 
-    /* Map staging buffer */
-    return bufferVK.Map(device_, access);
+    /* Copy mapped range of staging buffer into GPU local buffer for write access */
+    if (!bufferVK.IsHostVisible() && bufferVK.GetMappingCPUAccess() != CPUAccess::ReadOnly)
+        CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), bufferVK.GetMappedSize(), bufferVK.GetMappedOffset(), bufferVK.GetMappedOffset());
 }
 
-void VKRenderSystem::UnmapBuffer(Buffer& buffer)
+std::uint32_t VKRenderSystem::ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
-    AssertBufferCPUAccess(bufferVK);
 
-    /* Unmap staging buffer */
-    bufferVK.Unmap(device_);
+    /* Allocate readback and (re-)create its staging buffer if it is too small */
+    auto readback = bufferReadbacks_.Alloc(size);
+    auto& rb = bufferReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        /* Release previous staging buffer (it is no longer in use since its readback has been retrieved) */
+        if (rb.capacity > 0)
+        {
+            deviceMemoryMngr_->Release(rb.staging.memoryRegion);
+            rb.staging.buffer.reset();
+        }
 
-    /* Copy staging buffer into GPU local buffer for write access */
-    if (bufferVK.GetMappingCPUAccess() != CPUAccess::ReadOnly)
-        CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), bufferVK.GetSize());
+        VkBufferCreateInfo stagingCreateInfo;
+        {
+            stagingCreateInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            stagingCreateInfo.pNext                 = nullptr;
+            stagingCreateInfo.flags                 = 0;
+            stagingCreateInfo.size                  = static_cast<VkDeviceSize>(size);
+            stagingCreateInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            stagingCreateInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+            stagingCreateInfo.queueFamilyIndexCount = 0;
+            stagingCreateInfo.pQueueFamilyIndices   = nullptr;
+        }
+        auto staging = CreateStagingBuffer(stagingCreateInfo);
+
+        rb.staging.buffer       = MakeUnique<VKBufferWithRequirements>(std::move(std::get<0>(staging)));
+        rb.staging.memoryRegion = std::get<1>(staging);
+        rb.capacity             = size;
+    }
+
+    rb.fence    = (&fence);
+    rb.dataSize = size;
+
+    /* Record copy into the staging buffer, then submit staging commands and signal fence once the copy has been completed */
+    CopyBuffer(bufferVK.GetVkBuffer(), rb.staging.buffer->buffer, static_cast<VkDeviceSize>(size), static_cast<VkDeviceSize>(offset), 0);
+    commandQueue_->Submit(fence);
+
+    return readback;
+}
+
+void VKRenderSystem::ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize)
+{
+    LLGL_ASSERT_PTR(data);
+
+    auto& rb = bufferReadbacks_.Get(readback);
+    AssertBufferReadbackDataSize(dataSize, rb.dataSize);
+
+    /* Wait until the buffer data has been copied into the staging buffer */
+    auto& fenceVK = LLGL_CAST(VKFence&, *rb.fence);
+    fenceVK.Wait(device_, UINT64_MAX);
+
+    /* Map staging buffer (host-coherent) and copy buffer data into the output */
+    auto deviceMemory = rb.staging.memoryRegion->GetParentChunk();
+
+    if (auto mappedData = deviceMemory->Map(device_, rb.staging.memoryRegion->GetOffset(), static_cast<VkDeviceSize>(rb.dataSize)))
+    {
+        ::memcpy(data, mappedData, static_cast<std::size_t>(rb.dataSize));
+        deviceMemory->Unmap(device_);
+    }
+
+    /* Return staging buffer to the pool */
+    bufferReadbacks_.Free(readback);
 }
 
 /* ----- Textures ----- */
@@ -397,13 +753,74 @@ static std::uint32_t GetTextureLayertCount(const TextureDescriptor& desc)
     }
 }
 
+// Returns the alignment of MIP levels within a staging buffer, i.e. the least common multiple of 4 and the texel (or block) size
+static VkDeviceSize GetStagingMipAlignment(const Format format)
+{
+    const VkDeviceSize texelSize = (IsCompressedFormat(format) ? FormatBlockSize(format) : std::max(1u, FormatBitSize(format) / 8));
+    if (texelSize % 4 == 0)
+        return texelSize;
+    else if (texelSize % 2 == 0)
+        return texelSize * 2;
+    else
+        return texelSize * 4;
+}
+
 Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
     const auto& cfg = GetConfiguration();
 
-    /* Determine size of image for staging buffer */
-    const auto imageSize        = TextureSize(textureDesc);
-    const auto initialDataSize  = static_cast<VkDeviceSize>(TextureBufferSize(textureDesc.format, imageSize));
+    /* Transient attachments have no transfer usage, so they can neither be uploaded nor initialized */
+    const bool isTransient = ((textureDesc.flags & TextureFlags::Transient) != 0);
+    if (isTransient && imageDesc != nullptr)
+        throw std::invalid_argument("cannot create transient texture with initial image data");
+
+    /* Determine number of MIP levels that are contained in the initial image data */
+    const auto numInitialMipLevels  = (imageDesc != nullptr ? NumMipChainLevels(textureDesc, *imageDesc) : 1u);
+    const auto imageExtent          = GetTextureVkExtent(textureDesc);
+    const auto layerCount           = GetTextureLayertCount(textureDesc);
+    const auto mipAlignment         = GetStagingMipAlignment(textureDesc.format);
+
+    /*
+    Determine size of image for staging buffer (compressed formats are measured in blocks),
+    and the copy region of each MIP level, whose buffer offset must be aligned within the staging buffer
+    */
+    std::vector<VkBufferImageCopy> regions(numInitialMipLevels);
+    std::vector<VkDeviceSize> mipDataSizes(numInitialMipLevels);
+
+    std::uint32_t   imageSize       = 0;
+    VkDeviceSize    initialDataSize = 0;
+    VkDeviceSize    stagingDataSize = 0;
+
+    for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+    {
+        const VkExtent3D mipExtent
+        {
+            std::max(1u, imageExtent.width  >> mipLevel),
+            std::max(1u, imageExtent.height >> mipLevel),
+            std::max(1u, imageExtent.depth  >> mipLevel)
+        };
+
+        auto& region = regions[mipLevel];
+        {
+            region.bufferOffset                     = (stagingDataSize + mipAlignment - 1) / mipAlignment * mipAlignment;
+            region.bufferRowLength                  = 0;
+            region.bufferImageHeight                = 0;
+            region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel        = mipLevel;
+            region.imageSubresource.baseArrayLayer  = 0;
+            region.imageSubresource.layerCount      = layerCount;
+            region.imageOffset                      = { 0, 0, 0 };
+            region.imageExtent                      = mipExtent;
+        }
+
+        mipDataSizes[mipLevel] = static_cast<VkDeviceSize>(
+            TextureBufferSize(textureDesc.format, { mipExtent.width, mipExtent.height, mipExtent.depth }) * layerCount
+        );
+
+        imageSize       += (mipLevel == 0 ? TextureSize(textureDesc) : mipExtent.width * mipExtent.height * mipExtent.depth * layerCount);
+        initialDataSize += mipDataSizes[mipLevel];
+        stagingDataSize = region.bufferOffset + mipDataSizes[mipLevel];
+    }
 
     /* Set up initial image data */
     const void* initialData = nullptr;
@@ -415,7 +832,7 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         ImageFormat dstFormat   = ImageFormat::RGBA;
         DataType    dstDataType = DataType::Int8;
 
-        if (FindSuitableImageFormat(textureDesc.format, dstFormat, dstDataType))
+        if (!IsCompressedFormat(textureDesc.format) && FindSuitableImageFormat(textureDesc.format, dstFormat, dstDataType))
         {
             /* Convert image format (will be null if no conversion is necessary) */
             tempImageBuffer = ConvertImageBuffer(*imageDesc, dstFormat, dstDataType, cfg.threadCount);
@@ -441,13 +858,13 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             initialData = imageDesc->data;
         }
     }
-    else if (cfg.imageInitialization.enabled)
+    else if (cfg.imageInitialization.enabled && !IsDepthStencilFormat(textureDesc.format) && !isTransient)
     {
-        /* Allocate default image data */
+        /* Allocate default image data (depth-stencil and transient textures are not initialized, since they are written as attachments) */
         ImageFormat imageFormat = ImageFormat::RGBA;
         DataType imageDataType = DataType::Float64;
 
-        if (FindSuitableImageFormat(textureDesc.format, imageFormat, imageDataType))
+        if (!IsCompressedFormat(textureDesc.format) && FindSuitableImageFormat(textureDesc.format, imageFormat, imageDataType))
         {
             const ColorRGBAd fillColor { cfg.imageInitialization.clearValue.color.Cast<double>() };
             tempImageBuffer = GenerateImageBuffer(imageFormat, imageDataType, imageSize, fillColor);
@@ -458,41 +875,64 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         initialData = tempImageBuffer.get();
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    FillBufferCreateInfo(stagingCreateInfo, initialDataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT); // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.flags)
-
-    VKBufferWithRequirements stagingBuffer { device_ };
-    VKDeviceMemoryRegion* memoryRegionStaging = nullptr;
-
-    std::tie(stagingBuffer, memoryRegionStaging) = CreateStagingBuffer(
-        stagingCreateInfo,
-        initialData,
-        static_cast<std::size_t>(initialDataSize)
-    );
-
     /* Create device texture */
-    auto textureVK      = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
+    auto textureVK      = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc, &sharedQueueFamilies_);
 
     auto image          = textureVK->GetVkImage();
     auto mipLevels      = textureVK->GetNumMipLevels();
     auto arrayLayers    = textureVK->GetNumArrayLayers();
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto formatVK = VKTypes::Map(textureDesc.format);
-    TransitionImageLayout(image, formatVK, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, arrayLayers);
+    /* Re-arrange initial data for the staging copy */
+    if (initialData != nullptr)
     {
-        CopyBufferToImage(
-            stagingBuffer.buffer,
-            image,
-            GetTextureVkExtent(textureDesc),
-            GetTextureLayertCount(textureDesc)
-        );
+        if (stagingDataSize != initialDataSize)
+        {
+            /* Re-arrange tightly packed MIP levels to their aligned buffer offsets */
+            auto stagingData = GenerateEmptyByteBuffer(static_cast<std::size_t>(stagingDataSize), false);
+            auto srcData = reinterpret_cast<const char*>(initialData);
+
+            for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+            {
+                const auto mipDataSize = static_cast<std::size_t>(mipDataSizes[mipLevel]);
+                ::memcpy(stagingData.get() + regions[mipLevel].bufferOffset, srcData, mipDataSize);
+                srcData += mipDataSize;
+            }
+
+            tempImageBuffer = std::move(stagingData);
+            initialData     = tempImageBuffer.get();
+        }
+    }
+
+    if (IsWorkerThread())
+    {
+        /* Initialize image on the transfer queue, so worker threads never record into the staging ring of the render thread */
+        VkImageSubresourceRange subresourceRange;
+        {
+            subresourceRange.aspectMask     = VKGetImageAspectByFormat(VKTypes::Map(textureDesc.format));
+            subresourceRange.baseMipLevel   = 0;
+            subresourceRange.levelCount     = mipLevels;
+            subresourceRange.baseArrayLayer = 0;
+            subresourceRange.layerCount     = arrayLayers;
+        }
+        transferUploads_->InitImage(image, numInitialMipLevels, regions.data(), subresourceRange, initialData, stagingDataSize);
     }
-    TransitionImageLayout(image, formatVK, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, arrayLayers);
+    else
+    {
+        /* Upload all MIP levels with a single staging copy, then transfer image into sampling-ready state */
+        auto formatVK = VKTypes::Map(textureDesc.format);
 
-    /* Release staging buffer */
-    deviceMemoryMngr_->Release(memoryRegionStaging);
+        if (initialData != nullptr)
+        {
+            TransitionImageLayout(image, formatVK, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, arrayLayers);
+            stagingRing_->WriteImage(image, numInitialMipLevels, regions.data(), initialData, stagingDataSize);
+            TransitionImageLayout(image, formatVK, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, arrayLayers);
+        }
+        else
+        {
+            /* Images without initial data skip the transfer layout (transient attachments do not even support it) */
+            TransitionImageLayout(image, formatVK, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels, arrayLayers);
+        }
+    }
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -500,17 +940,268 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     return TakeOwnership(textures_, std::move(textureVK));
 }
 
+Texture* VKRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureVK = LLGL_CAST(VKTexture&, sharedTexture);
+    return TakeOwnership(textures_, MakeUnique<VKTexture>(device_, sharedTextureVK, textureViewDesc));
+}
+
 void VKRenderSystem::Release(Texture& texture)
 {
-    /* Release device memory region, then release texture object */
-    auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
-    RemoveFromUniqueSet(textures_, &texture);
+    /* Defer destruction until pending uploads and frames that might still refer to this texture have been completed */
+    releaseQueue_.Release(
+        textures_, &texture,
+        [this](VKTexture& textureVK)
+        {
+            /* Release device memory region before the texture object is released */
+            deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
+        }
+    );
+}
+
+// Returns the image subresource, offset, and extent for the specified sub-texture region
+static void GetSubTextureVkRegion(const TextureType type, const SubTextureDescriptor& desc, VkBufferImageCopy& region)
+{
+    region.bufferOffset                     = 0;
+    region.bufferRowLength                  = 0;
+    region.bufferImageHeight                = 0;
+    region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel        = desc.mipLevel;
+
+    switch (type)
+    {
+        case TextureType::Texture1DArray:
+            region.imageSubresource.baseArrayLayer  = static_cast<std::uint32_t>(desc.offset.y);
+            region.imageSubresource.layerCount      = desc.extent.height;
+            region.imageOffset                      = { desc.offset.x, 0, 0 };
+            region.imageExtent                      = { desc.extent.width, 1u, 1u };
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray: /*pass*/
+        case TextureType::Texture2DMSArray:
+            region.imageSubresource.baseArrayLayer  = static_cast<std::uint32_t>(desc.offset.z);
+            region.imageSubresource.layerCount      = desc.extent.depth;
+            region.imageOffset                      = { desc.offset.x, desc.offset.y, 0 };
+            region.imageExtent                      = { desc.extent.width, desc.extent.height, 1u };
+            break;
+
+        default:
+            region.imageSubresource.baseArrayLayer  = 0;
+            region.imageSubresource.layerCount      = 1;
+            region.imageOffset                      = { desc.offset.x, desc.offset.y, desc.offset.z };
+            region.imageExtent                      = { desc.extent.width, desc.extent.height, desc.extent.depth };
+            break;
+    }
 }
 
 void VKRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc)
 {
-    //todo
+    LLGL_STATISTICS_ADD(bytesUploaded, imageDesc.dataSize);
+
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    /* Determine size of image data for the sub-texture region and convert image data if necessary */
+    const auto format       = VKTypes::Unmap(textureVK.GetVkFormat());
+    const auto imageSize    = static_cast<VkDeviceSize>(TextureBufferSize(format, subTextureDesc.extent));
+
+    ByteBuffer tempImageBuffer;
+    const void* imageData = GetTextureUploadData(format, subTextureDesc.extent, imageDesc, tempImageBuffer);
+
+    /* Determine destination region within the image */
+    VkBufferImageCopy region;
+    GetSubTextureVkRegion(texture.GetType(), subTextureDesc, region);
+
+    VkImageSubresourceRange subresourceRange;
+    {
+        subresourceRange.aspectMask     = region.imageSubresource.aspectMask;
+        subresourceRange.baseMipLevel   = region.imageSubresource.mipLevel;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = region.imageSubresource.baseArrayLayer;
+        subresourceRange.layerCount     = region.imageSubresource.layerCount;
+    }
+
+    /* Upload image data via staging ring, then transfer subresource back into sampling-ready state */
+    auto image = textureVK.GetVkImage();
+
+    if (IsWorkerThread())
+    {
+        transferUploads_->WriteImage(image, region, subresourceRange, imageData, imageSize);
+        return;
+    }
+
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+    {
+        stagingRing_->WriteImage(image, region, imageData, imageSize);
+    }
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+}
+
+void VKRenderSystem::WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions)
+{
+    /* Worker threads upload via the transfer queue, so they use the default implementation that writes each region individually */
+    if (IsWorkerThread())
+    {
+        RenderSystem::WriteTextureRegions(texture, numRegions, regions);
+        return;
+    }
+
+    if (numRegions == 0)
+        return;
+
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    const auto format       = VKTypes::Unmap(textureVK.GetVkFormat());
+    const auto alignment    = GetStagingMipAlignment(format);
+
+    /* Determine the copy region of each sub-texture with an aligned offset within the staging memory, and the range of all affected subresources */
+    std::vector<VkBufferImageCopy>  copyRegions(numRegions);
+    std::vector<ByteBuffer>         tempImageBuffers(numRegions);
+    std::vector<const void*>        imageData(numRegions);
+    std::vector<VkDeviceSize>       imageSizes(numRegions);
+
+    VkDeviceSize            stagingDataSize = 0;
+    VkImageSubresourceRange subresourceRange;
+
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        LLGL_STATISTICS_ADD(bytesUploaded, regions[i].image.dataSize);
+
+        const auto& subTextureDesc = regions[i].subTexture;
+
+        imageData[i]    = GetTextureUploadData(format, subTextureDesc.extent, regions[i].image, tempImageBuffers[i]);
+        imageSizes[i]   = static_cast<VkDeviceSize>(TextureBufferSize(format, subTextureDesc.extent));
+
+        auto& region = copyRegions[i];
+        GetSubTextureVkRegion(textureVK.GetType(), subTextureDesc, region);
+        region.bufferOffset = (stagingDataSize + alignment - 1) / alignment * alignment;
+        stagingDataSize = region.bufferOffset + imageSizes[i];
+
+        const auto& subresource = region.imageSubresource;
+        if (i == 0)
+        {
+            subresourceRange.aspectMask     = subresource.aspectMask;
+            subresourceRange.baseMipLevel   = subresource.mipLevel;
+            subresourceRange.levelCount     = 1;
+            subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+            subresourceRange.layerCount     = subresource.layerCount;
+        }
+        else
+        {
+            const auto mipLevelEnd      = std::max(subresourceRange.baseMipLevel + subresourceRange.levelCount, subresource.mipLevel + 1);
+            const auto arrayLayerEnd    = std::max(subresourceRange.baseArrayLayer + subresourceRange.layerCount, subresource.baseArrayLayer + subresource.layerCount);
+            subresourceRange.baseMipLevel   = std::min(subresourceRange.baseMipLevel, subresource.mipLevel);
+            subresourceRange.levelCount     = mipLevelEnd - subresourceRange.baseMipLevel;
+            subresourceRange.baseArrayLayer = std::min(subresourceRange.baseArrayLayer, subresource.baseArrayLayer);
+            subresourceRange.layerCount     = arrayLayerEnd - subresourceRange.baseArrayLayer;
+        }
+    }
+
+    /* Copy image data of all regions into a single staging allocation */
+    VkBuffer        srcBuffer   = VK_NULL_HANDLE;
+    VkDeviceSize    srcOffset   = 0;
+
+    auto stagingData = static_cast<char*>(stagingRing_->MapStagingMemory(stagingDataSize, srcBuffer, srcOffset));
+    {
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            ::memcpy(stagingData + copyRegions[i].bufferOffset, imageData[i], static_cast<std::size_t>(imageSizes[i]));
+            copyRegions[i].bufferOffset += srcOffset;
+        }
+    }
+    stagingRing_->UnmapStagingMemory();
+
+    /* Record a single copy command for all regions, enclosed by one layout transition of all affected subresources */
+    auto image = textureVK.GetVkImage();
+
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+    {
+        vkCmdCopyBufferToImage(
+            stagingRing_->GetCommandBuffer(),
+            srcBuffer,
+            image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            numRegions,
+            copyRegions.data()
+        );
+    }
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+}
+
+TextureUploadMemory VKRenderSystem::BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc)
+{
+    /* Worker threads upload via the dedicated transfer queue, so they use the default implementation that ends with WriteTexture */
+    if (IsWorkerThread())
+        return RenderSystem::BeginTextureUpload(texture, subTextureDesc);
+
+    if (textureUpload_.texture != nullptr)
+        throw std::runtime_error("cannot begin texture upload while another texture upload is in progress");
+
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    const auto format = VKTypes::Unmap(textureVK.GetVkFormat());
+    if (IsMultiSampleTexture(textureVK.GetType()) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot upload texture with multi-sampled type or depth-stencil format");
+
+    /* Allocate tightly packed staging memory (i.e. 'bufferRowLength' and 'bufferImageHeight' are zero) from the staging ring */
+    const auto& extent = subTextureDesc.extent;
+
+    GetSubTextureVkRegion(textureVK.GetType(), subTextureDesc, textureUpload_.region);
+    textureUpload_.size = static_cast<VkDeviceSize>(TextureBufferSize(format, extent));
+
+    TextureUploadMemory memory;
+    {
+        memory.data         = stagingRing_->MapStagingMemory(textureUpload_.size, textureUpload_.srcBuffer, textureUpload_.region.bufferOffset);
+        memory.rowPitch     = TextureBufferSize(format, Extent3D{ extent.width, 1, 1 });
+        memory.slicePitch   = TextureBufferSize(format, Extent3D{ extent.width, extent.height, 1 });
+    }
+    textureUpload_.texture = (&textureVK);
+
+    return memory;
+}
+
+void VKRenderSystem::EndTextureUpload()
+{
+    if (textureUpload_.texture == nullptr)
+    {
+        /* Upload has been started on a worker thread with the default implementation */
+        RenderSystem::EndTextureUpload();
+        return;
+    }
+
+    LLGL_STATISTICS_ADD(bytesUploaded, textureUpload_.size);
+
+    stagingRing_->UnmapStagingMemory();
+
+    const auto& region = textureUpload_.region;
+
+    VkImageSubresourceRange subresourceRange;
+    {
+        subresourceRange.aspectMask     = region.imageSubresource.aspectMask;
+        subresourceRange.baseMipLevel   = region.imageSubresource.mipLevel;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = region.imageSubresource.baseArrayLayer;
+        subresourceRange.layerCount     = region.imageSubresource.layerCount;
+    }
+
+    /* Record copy from staging memory into the current batch of the staging ring, then transfer subresource back into sampling-ready state */
+    auto image = textureUpload_.texture->GetVkImage();
+
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+    {
+        vkCmdCopyBufferToImage(
+            stagingRing_->GetCommandBuffer(),
+            textureUpload_.srcBuffer,
+            image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &region
+        );
+    }
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+
+    textureUpload_.texture = nullptr;
 }
 
 void VKRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
@@ -518,6 +1209,131 @@ void VKRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel,
     //todo
 }
 
+std::uint32_t VKRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence)
+{
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    const auto format = VKTypes::Unmap(textureVK.GetVkFormat());
+
+    if (IsMultiSampleTexture(textureVK.GetType()))
+        throw std::invalid_argument("cannot read multi-sampled texture asynchronously");
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot read texture with compressed or depth-stencil format asynchronously");
+
+    /* Determine tightly packed layout of the texel data within the staging buffer */
+    const auto rowPitch     = region.extent.width * (FormatBitSize(format) / 8);
+    const auto slicePitch   = static_cast<std::uint64_t>(rowPitch) * region.extent.height;
+    const auto size         = slicePitch * region.extent.depth;
+
+    /* Allocate readback and (re-)create its staging buffer if it is too small */
+    auto readback = textureReadbacks_.Alloc(size);
+    auto& rb = textureReadbacks_.Get(readback);
+
+    if (rb.capacity < size)
+    {
+        /* Release previous staging buffer (it is no longer in use since its readback has been retrieved) */
+        if (rb.capacity > 0)
+        {
+            deviceMemoryMngr_->Release(rb.staging.memoryRegion);
+            rb.staging.buffer.reset();
+        }
+
+        VkBufferCreateInfo stagingCreateInfo;
+        {
+            stagingCreateInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            stagingCreateInfo.pNext                 = nullptr;
+            stagingCreateInfo.flags                 = 0;
+            stagingCreateInfo.size                  = static_cast<VkDeviceSize>(size);
+            stagingCreateInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            stagingCreateInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+            stagingCreateInfo.queueFamilyIndexCount = 0;
+            stagingCreateInfo.pQueueFamilyIndices   = nullptr;
+        }
+        auto staging = CreateStagingBuffer(stagingCreateInfo);
+
+        rb.staging.buffer       = MakeUnique<VKBufferWithRequirements>(std::move(std::get<0>(staging)));
+        rb.staging.memoryRegion = std::get<1>(staging);
+        rb.capacity             = size;
+    }
+
+    rb.fence        = (&fence);
+    rb.format       = format;
+    rb.extent       = region.extent;
+    rb.rowPitch     = rowPitch;
+    rb.slicePitch   = slicePitch;
+
+    /* Determine source region within the image */
+    VkBufferImageCopy copyRegion;
+    {
+        copyRegion.bufferOffset         = 0;
+        copyRegion.bufferRowLength      = 0;
+        copyRegion.bufferImageHeight    = 0;
+        textureVK.GetSubresourceRegion(
+            region.mipLevel,
+            region.offset,
+            region.extent,
+            copyRegion.imageSubresource,
+            copyRegion.imageOffset,
+            copyRegion.imageExtent
+        );
+    }
+
+    VkImageSubresourceRange subresourceRange;
+    {
+        subresourceRange.aspectMask     = copyRegion.imageSubresource.aspectMask;
+        subresourceRange.baseMipLevel   = copyRegion.imageSubresource.mipLevel;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = copyRegion.imageSubresource.baseArrayLayer;
+        subresourceRange.layerCount     = copyRegion.imageSubresource.layerCount;
+    }
+
+    /* Record copy into the staging buffer, then transfer subresource back into sampling-ready state */
+    auto image = textureVK.GetVkImage();
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, subresourceRange);
+    {
+        vkCmdCopyImageToBuffer(
+            stagingRing_->GetCommandBuffer(),
+            image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            rb.staging.buffer->buffer,
+            1,
+            &copyRegion
+        );
+    }
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+
+    /* Submit staging commands and signal fence once the copy has been completed */
+    commandQueue_->Submit(fence);
+
+    return readback;
+}
+
+void VKRenderSystem::ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    auto& rb = textureReadbacks_.Get(readback);
+
+    const auto numTexels = rb.extent.width * rb.extent.height * rb.extent.depth;
+    AssertImageDataSize(imageDesc.dataSize, ImageDataSize(imageDesc.format, imageDesc.dataType, numTexels), "texture readback");
+
+    /* Wait until the texel data has been copied into the staging buffer */
+    auto& fenceVK = LLGL_CAST(VKFence&, *rb.fence);
+    fenceVK.Wait(device_, UINT64_MAX);
+
+    /* Map staging buffer (host-coherent) and copy texel data into the output image */
+    auto deviceMemory = rb.staging.memoryRegion->GetParentChunk();
+
+    if (auto mappedData = deviceMemory->Map(device_, rb.staging.memoryRegion->GetOffset(), static_cast<VkDeviceSize>(rb.slicePitch * rb.extent.depth)))
+    {
+        CopyTextureReadbackData(imageDesc, rb.format, rb.extent, mappedData, rb.rowPitch, rb.slicePitch, GetConfiguration().threadCount);
+        deviceMemory->Unmap(device_);
+    }
+
+    /* Return staging buffer to the pool */
+    textureReadbacks_.Free(readback);
+}
+
 void VKRenderSystem::GenerateMips(Texture& texture)
 {
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
@@ -535,7 +1351,7 @@ void VKRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
 
     const auto maxNumMipLevels      = textureVK.GetNumMipLevels();
-    const auto maxNumArrayLayers    = std::uint32_t(1u); //TODO...
+    const auto maxNumArrayLayers    = textureVK.GetNumArrayLayers();
 
     if (baseMipLevel < maxNumMipLevels && baseArrayLayer < maxNumArrayLayers && numMipLevels > 0 && numArrayLayers > 0)
     {
@@ -553,39 +1369,71 @@ void VKRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
 
 Sampler* VKRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, desc));
+    return samplerCache_.GetOrCreate(
+        desc,
+        [&]()
+        {
+            return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, desc));
+        }
+    );
 }
 
 void VKRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    /* Only destroy sampler when it is no longer shared with other identical sampler descriptors */
+    if (samplerCache_.Release(sampler))
+        releaseQueue_.Release(samplers_, &sampler);
 }
 
 /* ----- Resource Heaps ----- */
 
 ResourceHeap* VKRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, desc));
+    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, *descriptorSetAllocator_, desc));
 }
 
 void VKRenderSystem::Release(ResourceHeap& resourceHeap)
 {
-    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+    releaseQueue_.Release(resourceHeaps_, &resourceHeap);
+}
+
+void VKRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews)
+{
+    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
+    resourceHeapVK.WriteResourceViews(firstDescriptor, numResourceViews, resourceViews);
 }
 
 /* ----- Render Targets ----- */
 
 RenderTarget* VKRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
-    return TakeOwnership(renderTargets_, MakeUnique<VKRenderTarget>(device_, *deviceMemoryMngr_, desc));
+    return TakeOwnership(renderTargets_, MakeUnique<VKRenderTarget>(device_, *deviceMemoryMngr_, renderPassCache_, desc));
 }
 
 void VKRenderSystem::Release(RenderTarget& renderTarget)
 {
-    /* Release device memory region, then release texture object */
-    auto& renderTargetVL = LLGL_CAST(VKRenderTarget&, renderTarget);
-    renderTargetVL.ReleaseDeviceMemoryResources(*deviceMemoryMngr_);
-    RemoveFromUniqueSet(renderTargets_, &renderTarget);
+    /* Defer destruction until the frames that might still render into this render target have been completed */
+    releaseQueue_.Release(
+        renderTargets_, &renderTarget,
+        [this](VKRenderTarget& renderTargetVK)
+        {
+            /* Release device memory region before the render target object is released */
+            renderTargetVK.ReleaseDeviceMemoryResources(*deviceMemoryMngr_);
+        }
+    );
+}
+
+/* ----- Render Passes ----- */
+
+RenderPass* VKRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    return TakeOwnership(renderPasses_, MakeUnique<VKRenderPass>(desc));
+}
+
+void VKRenderSystem::Release(RenderPass& renderPass)
+{
+    /* Native render passes are owned by the render targets and render contexts, so they remain valid for pending command buffers */
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
 }
 
 /* ----- Shader ----- */
@@ -614,72 +1462,343 @@ void VKRenderSystem::Release(ShaderProgram& shaderProgram)
 
 /* ----- Pipeline Layouts ----- */
 
+// Returns the key of the specified pipeline layout descriptor, which contains everything the Vulkan pipeline layout depends on (but not the resource names).
+static std::vector<std::uint32_t> GetPipelineLayoutKey(const PipelineLayoutDescriptor& desc)
+{
+    std::vector<std::uint32_t> key;
+
+    key.reserve(desc.bindings.size() * 6 + 3);
+
+    for (const auto& binding : desc.bindings)
+    {
+        key.push_back(static_cast<std::uint32_t>(binding.type));
+        key.push_back(static_cast<std::uint32_t>(binding.stageFlags));
+        key.push_back(binding.slot);
+        key.push_back(binding.arraySize);
+        key.push_back(static_cast<std::uint32_t>(binding.flags));
+        key.push_back(binding.dynamicRangeSize);
+    }
+
+    key.push_back(desc.constants.size);
+    key.push_back(static_cast<std::uint32_t>(desc.constants.stageFlags));
+    key.push_back(desc.constants.slot);
+
+    return key;
+}
+
 PipelineLayout* VKRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
 {
-    return TakeOwnership(pipelineLayouts_, MakeUnique<VKPipelineLayout>(device_, desc));
+    /* Share pipeline layout with all previous ones of identical descriptors */
+    auto& entry = sharedPipelineLayouts_[GetPipelineLayoutKey(desc)];
+
+    if (entry.pipelineLayout == nullptr)
+    {
+        entry.pipelineLayout    = TakeOwnership(pipelineLayouts_, MakeUnique<VKPipelineLayout>(device_, desc, hasDescriptorUpdateTemplates_));
+        entry.numRefs           = 0;
+    }
+
+    ++entry.numRefs;
+
+    return entry.pipelineLayout;
 }
 
 void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
-    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+    for (auto it = sharedPipelineLayouts_.begin(); it != sharedPipelineLayouts_.end(); ++it)
+    {
+        if (it->second.pipelineLayout == &pipelineLayout)
+        {
+            /* Only release pipeline layout if it is no longer shared */
+            if (--it->second.numRefs > 0)
+                return;
+            sharedPipelineLayouts_.erase(it);
+            break;
+        }
+    }
+    releaseQueue_.Release(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
 
 GraphicsPipeline* VKRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
-    if (renderContexts_.empty())
-        throw std::runtime_error("cannot create graphics pipeline without a render context");
-
-    auto renderContext = renderContexts_.begin()->get();
-    auto renderPassVK = renderContext->GetSwapChainRenderPass().Get();
+    return CreateGraphicsPipelineWithMode(desc, false);
+}
 
-    return TakeOwnership(
-        graphicsPipelines_,
-        MakeUnique<VKGraphicsPipeline>(
-            device_, renderPassVK, defaultPipelineLayout_,
-            desc, gfxPipelineLimits_, renderContext->GetSwapChainExtent()
-        )
-    );
+GraphicsPipeline* VKRenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    return CreateGraphicsPipelineWithMode(desc, true);
 }
 
 ComputePipeline* VKRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
 {
-    return TakeOwnership(computePipelines_, MakeUnique<VKComputePipeline>(device_, desc, defaultPipelineLayout_));
+    return TakeOwnership(computePipelines_, MakeUnique<VKComputePipeline>(device_, desc, defaultPipelineLayout_, pipelineCache_));
 }
 
 void VKRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
-    RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+    releaseQueue_.Release(graphicsPipelines_, &graphicsPipeline);
+}
+
+void VKRenderSystem::Release(ComputePipeline& computePipeline)
+{
+    releaseQueue_.Release(computePipelines_, &computePipeline);
+}
+
+/* ----- Pipeline Caches ----- */
+
+std::vector<char> VKRenderSystem::GetPipelineCacheData() const
+{
+    /* Query size of pipeline cache blob */
+    std::size_t dataSize = 0;
+    auto result = vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, nullptr);
+    VKThrowIfFailed(result, "failed to query size of Vulkan pipeline cache data");
+
+    /* Retrieve pipeline cache blob */
+    std::vector<char> data(dataSize);
+    if (dataSize > 0)
+    {
+        result = vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, data.data());
+        VKThrowIfFailed(result, "failed to retrieve Vulkan pipeline cache data");
+        data.resize(dataSize);
+    }
+
+    return data;
+}
+
+bool VKRenderSystem::SetPipelineCacheData(const void* data, std::size_t dataSize)
+{
+    if (!IsPipelineCacheCompatible(data, dataSize))
+        return false;
+
+    /* Create temporary pipeline cache with initial data */
+    VKPtr<VkPipelineCache> srcPipelineCache { device_, vkDestroyPipelineCache };
+
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = dataSize;
+        createInfo.pInitialData     = data;
+    }
+    auto result = vkCreatePipelineCache(device_, &createInfo, VKGetAllocationCallbacks(), srcPipelineCache.ReleaseAndGetAddressOf());
+    if (result != VK_SUCCESS)
+        return false;
+
+    /* Merge temporary cache into primary pipeline cache, which is used by all pipelines */
+    VkPipelineCache srcPipelineCaches[] = { srcPipelineCache.Get() };
+    result = vkMergePipelineCaches(device_, pipelineCache_, 1, srcPipelineCaches);
+
+    return (result == VK_SUCCESS);
+}
+
+/* ----- Statistics ----- */
+
+bool VKRenderSystem::QueryStatistics(RenderingStatistics& statistics, bool reset)
+{
+    statistics = statistics_.Query(reset);
+    #ifdef LLGL_ENABLE_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+bool VKRenderSystem::QueryMemoryStatistics(MemoryStatistics& statistics)
+{
+    /* Initialize statistics for each memory heap of the physical device */
+    statistics.heaps.assign(memoryProperties_.memoryHeapCount, MemoryHeapStatistics{});
+
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+    {
+        const auto& heapVK = memoryProperties_.memoryHeaps[i];
+        statistics.heaps[i].deviceLocal = ((heapVK.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+        statistics.heaps[i].size        = heapVK.size;
+    }
+
+    deviceMemoryMngr_->AccumHeapStatistics(statistics.heaps.data());
+
+    #ifdef VK_EXT_memory_budget
+    if (hasMemoryBudget_)
+    {
+        /* Query memory budget and usage of this process from the operating system */
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+        {
+            budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+            budgetProperties.pNext = nullptr;
+        }
+        VkPhysicalDeviceMemoryProperties2KHR memoryProperties;
+        {
+            memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+            memoryProperties.pNext = &budgetProperties;
+        }
+        vkGetPhysicalDeviceMemoryProperties2KHR(physicalDevice_, &memoryProperties);
+
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+        {
+            statistics.heaps[i].budget  = budgetProperties.heapBudget[i];
+            statistics.heaps[i].usage   = budgetProperties.heapUsage[i];
+        }
+    }
+    #endif // /VK_EXT_memory_budget
+
+    return true;
+}
+
+bool VKRenderSystem::QueryTimestampCalibration(TimestampCalibration& calibration)
+{
+    #ifdef VK_EXT_calibrated_timestamps
+    if (hasCalibratedTimestamps_)
+    {
+        /* Select the host time domain that matches the clock of Timer::Tick */
+        #if defined LLGL_OS_WIN32
+        const VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+        #elif defined LLGL_OS_LINUX
+        const VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT;
+        #else
+        return false;
+        #endif
+
+        #if defined LLGL_OS_WIN32 || defined LLGL_OS_LINUX
+
+        /* Sample device and host timestamps at once; fails if the host time domain is not calibrateable */
+        VkCalibratedTimestampInfoEXT timestampInfos[2];
+        {
+            timestampInfos[0].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+            timestampInfos[0].pNext         = nullptr;
+            timestampInfos[0].timeDomain    = VK_TIME_DOMAIN_DEVICE_EXT;
+            timestampInfos[1].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+            timestampInfos[1].pNext         = nullptr;
+            timestampInfos[1].timeDomain    = hostTimeDomain;
+        }
+        std::uint64_t timestamps[2] = { 0, 0 };
+        std::uint64_t maxDeviation  = 0;
+
+        if (vkGetCalibratedTimestampsEXT(device_, 2, timestampInfos, timestamps, &maxDeviation) != VK_SUCCESS)
+            return false;
+
+        calibration.cpuTimestamp    = timestamps[1];
+        calibration.gpuTimestamp    = timestamps[0];
+        calibration.gpuFrequency    = static_cast<std::uint64_t>(1.0e9 / static_cast<double>(timestampPeriod_) + 0.5);
+        calibration.maxDeviation    = maxDeviation;
+
+        return true;
+
+        #endif
+    }
+    #endif // /VK_EXT_calibrated_timestamps
+
+    /* Calibrated timestamps are not supported without VK_EXT_calibrated_timestamps */
+    return false;
+}
+
+/* ----- Queries ----- */
+
+Query* VKRenderSystem::CreateQuery(const QueryDescriptor& desc)
+{
+    return TakeOwnership(queries_, MakeUnique<VKQuery>(device_, desc));
+}
+
+void VKRenderSystem::Release(Query& query)
+{
+    releaseQueue_.Release(queries_, &query);
+}
+
+QueryHeap* VKRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<VKQueryHeap>(device_, *stagingRing_, desc));
+}
+
+void VKRenderSystem::Release(QueryHeap& queryHeap)
+{
+    /* Defer destruction until pending query resets and frames that might still refer to this query heap have been completed */
+    releaseQueue_.Release(queryHeaps_, &queryHeap);
+}
+
+/* ----- Indirect Command Layouts ----- */
+
+IndirectCommandLayout* VKRenderSystem::CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc)
+{
+    return TakeOwnership(indirectCommandLayouts_, MakeUnique<VKIndirectCommandLayout>(desc));
+}
+
+void VKRenderSystem::Release(IndirectCommandLayout& indirectCommandLayout)
+{
+    /* Emulated layouts have no native object, so they can be destroyed immediately */
+    RemoveFromUniqueSet(indirectCommandLayouts_, &indirectCommandLayout);
+}
+
+/* ----- Acceleration Structures ----- */
+
+AccelerationStructure* VKRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& desc)
+{
+    #ifdef VK_KHR_acceleration_structure
+    if (hasRayQueries_)
+        return TakeOwnership(accelerationStructures_, MakeUnique<VKAccelerationStructure>(device_, *deviceMemoryMngr_, accelerationStructureScratchAlignment_, desc));
+    #endif
+    return RenderSystem::CreateAccelerationStructure(desc);
+}
+
+void VKRenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    #ifdef VK_KHR_acceleration_structure
+    /* Defer destruction until frames that might still build or trace this acceleration structure have been completed */
+    releaseQueue_.Release(
+        accelerationStructures_, &accelerationStructure,
+        [this](VKAccelerationStructure& accelerationStructureVK)
+        {
+            deviceMemoryMngr_->Release(accelerationStructureVK.GetMemoryRegion());
+            deviceMemoryMngr_->Release(accelerationStructureVK.GetMemoryRegionScratch());
+        }
+    );
+    #endif
+}
+
+/* ----- Fences ----- */
+
+Fence* VKRenderSystem::CreateFence()
+{
+    /* Recycle a previously released fence before a new native fence is created */
+    if (auto fence = fencePool_.Acquire())
+        return TakeOwnership(fences_, std::move(fence));
+    return TakeOwnership(fences_, MakeUnique<VKFence>(device_, hasTimelineSemaphores_));
 }
 
-void VKRenderSystem::Release(ComputePipeline& computePipeline)
+void VKRenderSystem::Release(Fence& fence)
 {
-    RemoveFromUniqueSet(computePipelines_, &computePipeline);
+    fencePool_.Release(fences_, &fence);
 }
 
-/* ----- Queries ----- */
+/* ----- Upload batches ----- */
 
-Query* VKRenderSystem::CreateQuery(const QueryDescriptor& desc)
+void VKRenderSystem::BeginUploadBatch()
 {
-    return TakeOwnership(queries_, MakeUnique<VKQuery>(device_, desc));
+    ++uploadBatchDepth_;
 }
 
-void VKRenderSystem::Release(Query& query)
+void VKRenderSystem::EndUploadBatch()
 {
-    RemoveFromUniqueSet(queries_, &query);
+    /* All uploads have been recorded into the current batch of the staging ring, so submit it once the outermost upload batch has been ended */
+    if (uploadBatchDepth_ > 0 && --uploadBatchDepth_ == 0)
+        stagingRing_->Flush();
 }
 
-/* ----- Fences ----- */
+/* ----- Worker threads ----- */
 
-Fence* VKRenderSystem::CreateFence()
+bool VKRenderSystem::AttachWorkerThread()
 {
-    return TakeOwnership(fences_, MakeUnique<VKFence>(device_));
+    /* Worker threads can only upload resources if there is a dedicated transfer queue */
+    if (!transferUploads_)
+        return false;
+    transferUploads_->AttachWorkerThread();
+    return true;
 }
 
-void VKRenderSystem::Release(Fence& fence)
+void VKRenderSystem::DetachWorkerThread()
 {
-    RemoveFromUniqueSet(fences_, &fence);
+    if (transferUploads_)
+        transferUploads_->DetachWorkerThread();
 }
 
 
@@ -763,9 +1882,13 @@ void VKRenderSystem::CreateInstance(const ApplicationDescriptor* applicationDesc
     }
 
     /* Create Vulkan instance */
-    VkResult result = vkCreateInstance(&instanceInfo, nullptr, instance_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateInstance(&instanceInfo, VKGetAllocationCallbacks(), instance_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan instance");
 
+    /* Load procedures of optional instance extensions */
+    for (auto name : extensionNames)
+        LoadInstanceExtension(instance_, name);
+
     if (debugLayerEnabled_)
         CreateDebugReportCallback();
 }
@@ -776,7 +1899,7 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL VKDebugCallback(
     const char* layerPrefix, const char* message, void* userData)
 {
     //auto renderSystemVK = reinterpret_cast<VKRenderSystem*>(userData);
-    Log::StdErr() << message << std::endl;
+    LLGL_LOG(Warning, message);
     return VK_FALSE;
 }
 
@@ -800,7 +1923,7 @@ void VKRenderSystem::CreateDebugReportCallback()
         createInfo.pfnCallback  = VKDebugCallback;
         createInfo.pUserData    = reinterpret_cast<void*>(this);
     }
-    auto result = CreateDebugReportCallbackEXT(instance_, &createInfo, nullptr, debugReportCallback_.ReleaseAndGetAddressOf());
+    auto result = CreateDebugReportCallbackEXT(instance_, &createInfo, VKGetAllocationCallbacks(), debugReportCallback_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan debug report callback");
 }
 
@@ -809,13 +1932,55 @@ void VKRenderSystem::LoadExtensions()
     LoadAllExtensions(instance_);
 }
 
-bool VKRenderSystem::PickPhysicalDevice()
+void VKRenderSystem::QueryVideoAdapters(const std::vector<VkPhysicalDevice>& devices)
 {
-    /* Query all physical devices and pick suitable */
-    auto devices = VKQueryPhysicalDevices(instance_);
+    std::vector<VideoAdapterDescriptor> videoAdapterDescs;
 
     for (const auto& dev : devices)
     {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(dev, &properties);
+
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(dev, &memoryProperties);
+
+        /* Setup adapter information (video memory is the size of all device local memory heaps) */
+        VideoAdapterDescriptor videoAdapterDesc;
+        {
+            const std::string deviceName = properties.deviceName;
+            videoAdapterDesc.name   = std::wstring(deviceName.begin(), deviceName.end());
+            videoAdapterDesc.vendor = GetVendorByID(static_cast<unsigned short>(properties.vendorID));
+
+            for (std::uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i)
+            {
+                if ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0)
+                    videoAdapterDesc.videoMemory += static_cast<std::uint64_t>(memoryProperties.memoryHeaps[i].size);
+            }
+        }
+        videoAdapterDescs.push_back(videoAdapterDesc);
+    }
+
+    SetVideoAdapters(videoAdapterDescs);
+}
+
+// Returns true if the specified physical device is a discrete GPU.
+static bool IsPhysicalDeviceDiscrete(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device, &properties);
+    return (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+}
+
+bool VKRenderSystem::PickPhysicalDevice(const RenderSystemDescriptor& renderSystemDesc)
+{
+    /* Query all physical devices */
+    auto devices = VKQueryPhysicalDevices(instance_);
+    QueryVideoAdapters(devices);
+
+    /* Pick explicitly selected device if it is suitable */
+    if (renderSystemDesc.adapterIndex < devices.size())
+    {
+        const auto dev = devices[renderSystemDesc.adapterIndex];
         if (IsPhysicalDeviceSuitable(dev))
         {
             physicalDevice_ = dev;
@@ -823,7 +1988,17 @@ bool VKRenderSystem::PickPhysicalDevice()
         }
     }
 
-    return false;
+    /* Otherwise, pick first suitable discrete GPU, or first suitable device if there is no discrete GPU */
+    for (const auto& dev : devices)
+    {
+        if (IsPhysicalDeviceSuitable(dev))
+        {
+            if (physicalDevice_ == VK_NULL_HANDLE || (IsPhysicalDeviceDiscrete(dev) && !IsPhysicalDeviceDiscrete(physicalDevice_)))
+                physicalDevice_ = dev;
+        }
+    }
+
+    return (physicalDevice_ != VK_NULL_HANDLE);
 }
 
 void VKRenderSystem::QueryDeviceProperties()
@@ -849,21 +2024,27 @@ void VKRenderSystem::QueryDeviceProperties()
     /* Map limits to output rendering capabilites */
     const auto& limits = properties.limits;
 
+    timestampPeriod_ = limits.timestampPeriod;
+
     RenderingCapabilities caps;
     {
         /* Query common attributes */
         caps.screenOrigin                               = ScreenOrigin::UpperLeft;
         caps.clippingRange                              = ClippingRange::ZeroToOne;
         caps.shadingLanguages                           = { ShadingLanguage::SPIRV, ShadingLanguage::SPIRV_100 };
-        //caps.textureFormats                             = ; //???
 
         /* Query features */
+        caps.features.hasSecondaryCommandBuffers        = true;
+        caps.features.hasCommandBufferExt               = true;
         caps.features.hasRenderTargets                  = true;
         caps.features.has3DTextures                     = true;
         caps.features.hasCubeTextures                   = true;
         caps.features.hasArrayTextures                  = true;
         caps.features.hasCubeArrayTextures              = (features_.imageCubeArray != VK_FALSE);
         caps.features.hasMultiSampleTextures            = true;
+        caps.features.hasTextureCompressionBC           = (features_.textureCompressionBC != VK_FALSE);
+        caps.features.hasTextureCompressionETC2         = (features_.textureCompressionETC2 != VK_FALSE);
+        caps.features.hasTextureCompressionASTC         = (features_.textureCompressionASTC_LDR != VK_FALSE);
         caps.features.hasSamplers                       = true;
         caps.features.hasConstantBuffers                = true;
         caps.features.hasStorageBuffers                 = true;
@@ -873,10 +2054,17 @@ void VKRenderSystem::QueryDeviceProperties()
         caps.features.hasComputeShaders                 = true;
         caps.features.hasInstancing                     = true;
         caps.features.hasOffsetInstancing               = true;
+        caps.features.hasIndirectDrawing                = true;
+        caps.features.hasIndirectCommandLayouts         = true;
         caps.features.hasViewportArrays                 = (features_.multiViewport != VK_FALSE);
         caps.features.hasConservativeRasterization      = false;
+        caps.features.hasDepthBoundsTest                = (features_.depthBounds != VK_FALSE);
         caps.features.hasStreamOutputs                  = false;
         caps.features.hasLogicOp                        = true;
+        caps.features.hasBindlessResources              = (features_.shaderSampledImageArrayDynamicIndexing != VK_FALSE);
+        caps.features.hasDynamicOffsets                 = true;
+        caps.features.hasStaticSamplers                 = true;
+        caps.features.hasTextureViews                   = true;
 
         /* Query limits */
         caps.limits.lineWidthRange[0]                   = limits.lineWidthRange[0];
@@ -900,8 +2088,14 @@ void VKRenderSystem::QueryDeviceProperties()
         caps.limits.maxViewportSize[1]                  = limits.maxViewportDimensions[1];
         caps.limits.maxBufferSize                       = std::numeric_limits<VkDeviceSize>::max();
         caps.limits.maxConstantBufferSize               = limits.maxUniformBufferRange;
+        caps.limits.maxConstantsSize                    = limits.maxPushConstantsSize;
+        caps.limits.constantBufferOffsetAlignment       = static_cast<std::uint32_t>(limits.minUniformBufferOffsetAlignment);
+
+        /* Query subgroup properties (requires Vulkan 1.1 device) */
+        QuerySubgroupProperties(properties.apiVersion, caps);
     }
     SetRenderingCaps(caps);
+    constantBufferOffsetAlignment_ = caps.limits.constantBufferOffsetAlignment;
 
     /* Store graphics pipeline spcific limitations */
     gfxPipelineLimits_.lineWidthRange[0]    = limits.lineWidthRange[0];
@@ -909,86 +2103,574 @@ void VKRenderSystem::QueryDeviceProperties()
     gfxPipelineLimits_.lineWidthGranularity = limits.lineWidthGranularity;
 }
 
+void VKRenderSystem::QueryTextureFormats(std::vector<Format>& textureFormats)
+{
+    for (int i = static_cast<int>(Format::R8UNorm); i <= static_cast<int>(Format::ASTC12x12sRGB); ++i)
+    {
+        const auto format = static_cast<Format>(i);
+
+        VkFormat formatVK;
+        try
+        {
+            formatVK = VKTypes::Map(format);
+        }
+        catch (const std::invalid_argument&)
+        {
+            continue;
+        }
+
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice_, formatVK, &formatProperties);
+
+        if ((formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0)
+            textureFormats.push_back(format);
+    }
+}
+
+std::uint32_t VKRenderSystem::QueryMaxMultiviewViewCount()
+{
+    #if defined VK_KHR_multiview && defined VK_KHR_get_physical_device_properties2
+    if (vkGetPhysicalDeviceProperties2KHR != nullptr)
+    {
+        VkPhysicalDeviceMultiviewPropertiesKHR multiviewProperties;
+        {
+            multiviewProperties.sType                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_PROPERTIES_KHR;
+            multiviewProperties.pNext                       = nullptr;
+            multiviewProperties.maxMultiviewViewCount       = 0;
+            multiviewProperties.maxMultiviewInstanceIndex   = 0;
+        }
+        VkPhysicalDeviceProperties2KHR properties;
+        {
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            properties.pNext = &multiviewProperties;
+        }
+        vkGetPhysicalDeviceProperties2KHR(physicalDevice_, &properties);
+        return multiviewProperties.maxMultiviewViewCount;
+    }
+    #endif
+
+    /* Return minimum of 'maxMultiviewViewCount' that is guaranteed by the specification */
+    return 6;
+}
+
+void VKRenderSystem::QueryMeshShaderLimits(RenderingLimits& limits)
+{
+    #if defined VK_EXT_mesh_shader && defined VK_KHR_get_physical_device_properties2
+    if (vkGetPhysicalDeviceProperties2KHR != nullptr)
+    {
+        VkPhysicalDeviceMeshShaderPropertiesEXT meshShaderProperties = {};
+        {
+            meshShaderProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+            meshShaderProperties.pNext = nullptr;
+        }
+        VkPhysicalDeviceProperties2KHR properties;
+        {
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            properties.pNext = &meshShaderProperties;
+        }
+        vkGetPhysicalDeviceProperties2KHR(physicalDevice_, &properties);
+
+        /* Mesh tasks are launched for either the task or the mesh shader, so take the lower limit of both */
+        for (int i = 0; i < 3; ++i)
+            limits.maxMeshTaskWorkGroups[i] = std::min(meshShaderProperties.maxTaskWorkGroupCount[i], meshShaderProperties.maxMeshWorkGroupCount[i]);
+
+        limits.maxMeshOutputVertices    = meshShaderProperties.maxMeshOutputVertices;
+        limits.maxMeshOutputPrimitives  = meshShaderProperties.maxMeshOutputPrimitives;
+    }
+    #endif
+}
+
+VkDeviceSize VKRenderSystem::QueryAccelerationStructureScratchAlignment()
+{
+    #if defined VK_KHR_acceleration_structure && defined VK_KHR_get_physical_device_properties2
+    if (vkGetPhysicalDeviceProperties2KHR != nullptr)
+    {
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR accelerationStructureProperties = {};
+        {
+            accelerationStructureProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+            accelerationStructureProperties.pNext = nullptr;
+        }
+        VkPhysicalDeviceProperties2KHR properties;
+        {
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            properties.pNext = &accelerationStructureProperties;
+        }
+        vkGetPhysicalDeviceProperties2KHR(physicalDevice_, &properties);
+        return std::max<VkDeviceSize>(accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment, 1);
+    }
+    #endif
+
+    /* Return maximum of 'minAccelerationStructureScratchOffsetAlignment' that is allowed by the specification */
+    return 256;
+}
+
+#ifdef VK_VERSION_1_1
+
+static long GetSubgroupStageFlags(VkShaderStageFlags stageFlags)
+{
+    long flags = 0;
+
+    if ((stageFlags & VK_SHADER_STAGE_VERTEX_BIT) != 0)
+        flags |= StageFlags::VertexStage;
+    if ((stageFlags & VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT) != 0)
+        flags |= StageFlags::TessControlStage;
+    if ((stageFlags & VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) != 0)
+        flags |= StageFlags::TessEvaluationStage;
+    if ((stageFlags & VK_SHADER_STAGE_GEOMETRY_BIT) != 0)
+        flags |= StageFlags::GeometryStage;
+    if ((stageFlags & VK_SHADER_STAGE_FRAGMENT_BIT) != 0)
+        flags |= StageFlags::FragmentStage;
+    if ((stageFlags & VK_SHADER_STAGE_COMPUTE_BIT) != 0)
+        flags |= StageFlags::ComputeStage;
+    #ifdef VK_EXT_mesh_shader
+    if ((stageFlags & VK_SHADER_STAGE_TASK_BIT_EXT) != 0)
+        flags |= StageFlags::AmplificationStage;
+    if ((stageFlags & VK_SHADER_STAGE_MESH_BIT_EXT) != 0)
+        flags |= StageFlags::MeshStage;
+    #endif
+
+    return flags;
+}
+
+static long GetSubgroupOperations(VkSubgroupFeatureFlags featureFlags)
+{
+    long flags = 0;
+
+    if ((featureFlags & VK_SUBGROUP_FEATURE_BASIC_BIT) != 0)
+        flags |= SubgroupFlags::Basic;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_VOTE_BIT) != 0)
+        flags |= SubgroupFlags::Vote;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_ARITHMETIC_BIT) != 0)
+        flags |= SubgroupFlags::Arithmetic;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_BALLOT_BIT) != 0)
+        flags |= SubgroupFlags::Ballot;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_SHUFFLE_BIT) != 0)
+        flags |= SubgroupFlags::Shuffle;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_SHUFFLE_RELATIVE_BIT) != 0)
+        flags |= SubgroupFlags::ShuffleRelative;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_CLUSTERED_BIT) != 0)
+        flags |= SubgroupFlags::Clustered;
+    if ((featureFlags & VK_SUBGROUP_FEATURE_QUAD_BIT) != 0)
+        flags |= SubgroupFlags::Quad;
+
+    return flags;
+}
+
+#endif // /VK_VERSION_1_1
+
+void VKRenderSystem::QuerySubgroupProperties(std::uint32_t apiVersion, RenderingCapabilities& caps)
+{
+    #if defined VK_VERSION_1_1 && defined VK_KHR_get_physical_device_properties2
+    /* VkPhysicalDeviceSubgroupProperties must only be chained for devices that support Vulkan 1.1 */
+    if (vkGetPhysicalDeviceProperties2KHR != nullptr && apiVersion >= VK_API_VERSION_1_1)
+    {
+        VkPhysicalDeviceSubgroupProperties subgroupProperties;
+        {
+            subgroupProperties.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+            subgroupProperties.pNext                        = nullptr;
+            subgroupProperties.subgroupSize                 = 0;
+            subgroupProperties.supportedStages              = 0;
+            subgroupProperties.supportedOperations          = 0;
+            subgroupProperties.quadOperationsInAllStages    = VK_FALSE;
+        }
+        VkPhysicalDeviceProperties2KHR properties;
+        {
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            properties.pNext = &subgroupProperties;
+        }
+        vkGetPhysicalDeviceProperties2KHR(physicalDevice_, &properties);
+
+        if (subgroupProperties.subgroupSize > 0 && subgroupProperties.supportedOperations != 0)
+        {
+            caps.features.hasSubgroups      = true;
+            caps.limits.minSubgroupSize     = subgroupProperties.subgroupSize;
+            caps.limits.maxSubgroupSize     = subgroupProperties.subgroupSize;
+            caps.limits.subgroupStageFlags  = GetSubgroupStageFlags(subgroupProperties.supportedStages);
+            caps.limits.subgroupOperations  = GetSubgroupOperations(subgroupProperties.supportedOperations);
+        }
+    }
+    #endif
+}
+
 // Device-only layers are deprecated -> set 'enabledLayerCount' and 'ppEnabledLayerNames' members to zero during device creation.
 // see https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#extended-functionality-device-layer-deprecation
 void VKRenderSystem::CreateLogicalDevice()
 {
     /* Initialize queue create description */
     queueFamilyIndices_ = VKFindQueueFamilies(physicalDevice_, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT));
+    queueFamilyIndices_.computeFamily   = FindDedicatedQueueFamily(physicalDevice_, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+    queueFamilyIndices_.transferFamily  = FindDedicatedQueueFamily(physicalDevice_, VK_QUEUE_TRANSFER_BIT, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<std::uint32_t> uniqueQueueFamilies = { queueFamilyIndices_.graphicsFamily, queueFamilyIndices_.presentFamily };
 
-    float queuePriority = 1.0f;
+    if (queueFamilyIndices_.computeFamily != QueueFamilyIndices::invalidIndex)
+        uniqueQueueFamilies.insert(queueFamilyIndices_.computeFamily);
+    if (queueFamilyIndices_.transferFamily != QueueFamilyIndices::invalidIndex)
+        uniqueQueueFamilies.insert(queueFamilyIndices_.transferFamily);
+
+    /* Request a second queue with the lowest priority from the dedicated compute family for background work (if available) */
+    hasBackgroundQueueSlot_ = false;
+    if (queueFamilyIndices_.computeFamily != QueueFamilyIndices::invalidIndex)
+    {
+        auto queueFamilies = VKQueryQueueFamilyProperties(physicalDevice_);
+        hasBackgroundQueueSlot_ = (queueFamilies[queueFamilyIndices_.computeFamily].queueCount >= 2);
+    }
+
+    const float queuePriorities[2] = { 1.0f, 0.0f };
     for (auto family : uniqueQueueFamilies)
     {
+        const bool withBackgroundQueue = (hasBackgroundQueueSlot_ && family == queueFamilyIndices_.computeFamily);
         VkDeviceQueueCreateInfo info;
         {
             info.sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             info.pNext              = nullptr;
             info.flags              = 0;
             info.queueFamilyIndex   = family;
-            info.queueCount         = 1;
-            info.pQueuePriorities   = &queuePriority;
+            info.queueCount         = (withBackgroundQueue ? 2 : 1);
+            info.pQueuePriorities   = queuePriorities;
         }
         queueCreateInfos.push_back(info);
     }
 
+    /* Enable all required device extensions and the supported optional device extensions */
+    std::vector<const char*> extensionNames = g_deviceExtensions;
+    std::vector<const char*> optionalExtensionNames;
+
+    for (auto name : g_optionalDeviceExtensions)
+    {
+        #ifdef VK_KHR_fragment_shading_rate
+        if (std::string(name) == VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+        {
+            /* Fragment shading rates depend on render pass 2, which depends on multiview and maintenance2 (all of them are core in Vulkan 1.2) */
+            const std::vector<const char*> dependencies
+            {
+                VK_KHR_MULTIVIEW_EXTENSION_NAME,
+                VK_KHR_MAINTENANCE2_EXTENSION_NAME,
+                VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+                VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME,
+            };
+            if (CheckDeviceExtensionSupport(physicalDevice_, dependencies))
+            {
+                /* Skip dependencies that have already been enabled as optional extensions on their own (e.g. multiview) */
+                for (auto dependency : dependencies)
+                {
+                    if (std::find(optionalExtensionNames.begin(), optionalExtensionNames.end(), dependency) == optionalExtensionNames.end())
+                        optionalExtensionNames.push_back(dependency);
+                }
+            }
+            continue;
+        }
+        #endif // /VK_KHR_fragment_shading_rate
+        #ifdef VK_EXT_mesh_shader
+        if (std::string(name) == VK_EXT_MESH_SHADER_EXTENSION_NAME)
+        {
+            /* Mesh shaders depend on SPIR-V 1.4, which depends on shader float controls (both are core in Vulkan 1.2) */
+            const std::vector<const char*> dependencies
+            {
+                VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME,
+                VK_KHR_SPIRV_1_4_EXTENSION_NAME,
+                VK_EXT_MESH_SHADER_EXTENSION_NAME,
+            };
+            if (CheckDeviceExtensionSupport(physicalDevice_, dependencies))
+            {
+                for (auto dependency : dependencies)
+                {
+                    if (std::find(optionalExtensionNames.begin(), optionalExtensionNames.end(), dependency) == optionalExtensionNames.end())
+                        optionalExtensionNames.push_back(dependency);
+                }
+            }
+            continue;
+        }
+        #endif // /VK_EXT_mesh_shader
+        #ifdef VK_KHR_acceleration_structure
+        if (std::string(name) == VK_KHR_RAY_QUERY_EXTENSION_NAME)
+        {
+            /*
+            Ray queries depend on acceleration structures, which depend on buffer device addresses, descriptor indexing, and deferred host operations,
+            and ray queries also depend on SPIR-V 1.4 (all except acceleration structures and ray queries are core in Vulkan 1.2)
+            */
+            const std::vector<const char*> dependencies
+            {
+                VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+                VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+                VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+                VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
+                VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME,
+                VK_KHR_SPIRV_1_4_EXTENSION_NAME,
+                VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
+                VK_KHR_RAY_QUERY_EXTENSION_NAME,
+            };
+            if (CheckDeviceExtensionSupport(physicalDevice_, dependencies))
+            {
+                for (auto dependency : dependencies)
+                {
+                    if (std::find(optionalExtensionNames.begin(), optionalExtensionNames.end(), dependency) == optionalExtensionNames.end())
+                        optionalExtensionNames.push_back(dependency);
+                }
+            }
+            continue;
+        }
+        #endif // /VK_KHR_acceleration_structure
+        if (CheckDeviceExtensionSupport(physicalDevice_, { name }))
+            optionalExtensionNames.push_back(name);
+    }
+
+    extensionNames.insert(extensionNames.end(), optionalExtensionNames.begin(), optionalExtensionNames.end());
+
+    /* Enable timeline semaphores, which must be supported by all devices that support the extension */
+    const void* createInfoNext = nullptr;
+
+    #ifdef VK_KHR_timeline_semaphore
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
+    {
+        timelineSemaphoreFeatures.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.pNext             = nullptr;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)
+            createInfoNext = &timelineSemaphoreFeatures;
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
+    /* Enable pipeline fragment shading rates, which must be supported by all devices that support the extension */
+    #ifdef VK_KHR_fragment_shading_rate
+    VkPhysicalDeviceFragmentShadingRateFeaturesKHR fragmentShadingRateFeatures;
+    {
+        fragmentShadingRateFeatures.sType                           = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR;
+        fragmentShadingRateFeatures.pNext                           = const_cast<void*>(createInfoNext);
+        fragmentShadingRateFeatures.pipelineFragmentShadingRate     = VK_TRUE;
+        fragmentShadingRateFeatures.primitiveFragmentShadingRate    = VK_FALSE;
+        fragmentShadingRateFeatures.attachmentFragmentShadingRate   = VK_FALSE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+            createInfoNext = &fragmentShadingRateFeatures;
+    }
+    #endif // /VK_KHR_fragment_shading_rate
+
+    /* Enable multiview rendering, which must be supported by all devices that support the extension */
+    #ifdef VK_KHR_multiview
+    VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures;
+    {
+        multiviewFeatures.sType                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR;
+        multiviewFeatures.pNext                         = const_cast<void*>(createInfoNext);
+        multiviewFeatures.multiview                     = VK_TRUE;
+        multiviewFeatures.multiviewGeometryShader       = VK_FALSE;
+        multiviewFeatures.multiviewTessellationShader   = VK_FALSE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_KHR_MULTIVIEW_EXTENSION_NAME)
+            createInfoNext = &multiviewFeatures;
+    }
+    #endif // /VK_KHR_multiview
+
+    /* Enable conditional rendering in primary command buffers, which must be supported by all devices that support the extension */
+    #ifdef VK_EXT_conditional_rendering
+    VkPhysicalDeviceConditionalRenderingFeaturesEXT conditionalRenderingFeatures;
+    {
+        conditionalRenderingFeatures.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+        conditionalRenderingFeatures.pNext                          = const_cast<void*>(createInfoNext);
+        conditionalRenderingFeatures.conditionalRendering           = VK_TRUE;
+        conditionalRenderingFeatures.inheritedConditionalRendering  = VK_FALSE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME)
+            createInfoNext = &conditionalRenderingFeatures;
+    }
+    #endif // /VK_EXT_conditional_rendering
+
+    /* Enable task and mesh shaders, which must be supported by all devices that support the extension */
+    #ifdef VK_EXT_mesh_shader
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures;
+    {
+        meshShaderFeatures.sType                                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        meshShaderFeatures.pNext                                    = const_cast<void*>(createInfoNext);
+        meshShaderFeatures.taskShader                               = VK_TRUE;
+        meshShaderFeatures.meshShader                               = VK_TRUE;
+        meshShaderFeatures.multiviewMeshShader                      = VK_FALSE;
+        meshShaderFeatures.primitiveFragmentShadingRateMeshShader   = VK_FALSE;
+        meshShaderFeatures.meshShaderQueries                        = VK_FALSE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_EXT_MESH_SHADER_EXTENSION_NAME)
+            createInfoNext = &meshShaderFeatures;
+    }
+    #endif // /VK_EXT_mesh_shader
+
+    /* Enable buffer device addresses, acceleration structures, and ray queries, which must be supported by all devices that support the extensions */
+    #ifdef VK_KHR_acceleration_structure
+    VkPhysicalDeviceBufferDeviceAddressFeaturesKHR bufferDeviceAddressFeatures;
+    {
+        bufferDeviceAddressFeatures.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+        bufferDeviceAddressFeatures.pNext                            = nullptr;
+        bufferDeviceAddressFeatures.bufferDeviceAddress              = VK_TRUE;
+        bufferDeviceAddressFeatures.bufferDeviceAddressCaptureReplay = VK_FALSE;
+        bufferDeviceAddressFeatures.bufferDeviceAddressMultiDevice   = VK_FALSE;
+    }
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures;
+    {
+        accelerationStructureFeatures.sType                                                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+        accelerationStructureFeatures.pNext                                                 = nullptr;
+        accelerationStructureFeatures.accelerationStructure                                 = VK_TRUE;
+        accelerationStructureFeatures.accelerationStructureCaptureReplay                    = VK_FALSE;
+        accelerationStructureFeatures.accelerationStructureIndirectBuild                    = VK_FALSE;
+        accelerationStructureFeatures.accelerationStructureHostCommands                     = VK_FALSE;
+        accelerationStructureFeatures.descriptorBindingAccelerationStructureUpdateAfterBind = VK_FALSE;
+    }
+    VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures;
+    {
+        rayQueryFeatures.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
+        rayQueryFeatures.pNext      = nullptr;
+        rayQueryFeatures.rayQuery   = VK_TRUE;
+    }
+    for (auto name : optionalExtensionNames)
+    {
+        if (std::string(name) == VK_KHR_RAY_QUERY_EXTENSION_NAME)
+        {
+            bufferDeviceAddressFeatures.pNext   = const_cast<void*>(createInfoNext);
+            accelerationStructureFeatures.pNext = &bufferDeviceAddressFeatures;
+            rayQueryFeatures.pNext              = &accelerationStructureFeatures;
+            createInfoNext = &rayQueryFeatures;
+        }
+    }
+    #endif // /VK_KHR_acceleration_structure
+
     /* Create logical device */
     VkDeviceCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
+        createInfo.pNext                    = createInfoNext;
         createInfo.flags                    = 0;
         createInfo.queueCreateInfoCount     = static_cast<std::uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos        = queueCreateInfos.data();
         createInfo.enabledLayerCount        = 0;
         createInfo.ppEnabledLayerNames      = nullptr;
-        createInfo.enabledExtensionCount    = static_cast<std::uint32_t>(g_deviceExtensions.size());
-        createInfo.ppEnabledExtensionNames  = g_deviceExtensions.data();
+        createInfo.enabledExtensionCount    = static_cast<std::uint32_t>(extensionNames.size());
+        createInfo.ppEnabledExtensionNames  = extensionNames.data();
         createInfo.pEnabledFeatures         = &features_;
     }
-    VkResult result = vkCreateDevice(physicalDevice_, &createInfo, nullptr, device_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateDevice(physicalDevice_, &createInfo, VKGetAllocationCallbacks(), device_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan logical device");
 
-    /* Query device graphics queue */
-    vkGetDeviceQueue(device_, queueFamilyIndices_.graphicsFamily, 0, &graphicsQueue_);
+    /* Load procedures of optional device extensions */
+    for (auto name : optionalExtensionNames)
+    {
+        if (LoadDeviceExtension(device_, name))
+        {
+            #ifdef VK_KHR_descriptor_update_template
+            if (std::string(name) == VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)
+                hasDescriptorUpdateTemplates_ = true;
+            #endif
+            #ifdef VK_KHR_timeline_semaphore
+            if (std::string(name) == VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)
+                hasTimelineSemaphores_ = true;
+            #endif
+            #ifdef VK_EXT_memory_budget
+            if (std::string(name) == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)
+                hasMemoryBudget_ = true;
+            #endif
+            #ifdef VK_KHR_fragment_shading_rate
+            if (std::string(name) == VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+                gfxPipelineLimits_.dynamicShadingRate = true;
+            #endif
+            #ifdef VK_KHR_multiview
+            if (std::string(name) == VK_KHR_MULTIVIEW_EXTENSION_NAME)
+                hasMultiView_ = true;
+            #endif
+            #ifdef VK_EXT_calibrated_timestamps
+            if (std::string(name) == VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+                hasCalibratedTimestamps_ = true;
+            #endif
+            #ifdef VK_EXT_conservative_rasterization
+            if (std::string(name) == VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME)
+                gfxPipelineLimits_.conservativeRasterization = true;
+            #endif
+            #ifdef VK_EXT_mesh_shader
+            if (std::string(name) == VK_EXT_MESH_SHADER_EXTENSION_NAME)
+                hasMeshShaders_ = true;
+            #endif
+            #ifdef VK_KHR_acceleration_structure
+            if (std::string(name) == VK_KHR_RAY_QUERY_EXTENSION_NAME)
+                hasRayQueries_ = true;
+            #endif
+        }
+    }
 
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, graphicsQueue_);
-}
+    /* Timeline fences depend on the enabled extensions, so they are added after the rendering capabilities have been queried */
+    if (hasTimelineSemaphores_)
+    {
+        auto caps = GetRenderingCaps();
+        caps.features.hasTimelineFences = true;
+        caps.features.hasComputeQueue   = (queueFamilyIndices_.computeFamily != QueueFamilyIndices::invalidIndex);
+        caps.features.hasBackgroundQueue = hasBackgroundQueueSlot_;
+        SetRenderingCaps(caps);
+    }
 
-void VKRenderSystem::CreateStagingCommandResources()
-{
-    /* Create staging command pool */
-    VkCommandPoolCreateInfo createInfo;
+    if (gfxPipelineLimits_.dynamicShadingRate)
     {
-        createInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        createInfo.pNext            = nullptr;
-        createInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        createInfo.queueFamilyIndex = queueFamilyIndices_.graphicsFamily;
+        auto caps = GetRenderingCaps();
+        caps.features.hasVariableRateShading = true;
+        SetRenderingCaps(caps);
     }
-    auto result = vkCreateCommandPool(device_, &createInfo, nullptr, stagingCommandPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan command pool for staging buffers");
 
-    /* Allocate staging command buffer */
-    VkCommandBufferAllocateInfo allocInfo;
+    if (gfxPipelineLimits_.conservativeRasterization)
     {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.commandPool           = stagingCommandPool_;
-        allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandBufferCount    = 1;
+        auto caps = GetRenderingCaps();
+        caps.features.hasConservativeRasterization = true;
+        SetRenderingCaps(caps);
     }
-    result = vkAllocateCommandBuffers(device_, &allocInfo, &stagingCommandBuffer_);
-    VKThrowIfFailed(result, "failed to create Vulkan command buffer for staging buffers");
-}
 
-void VKRenderSystem::ReleaseStagingCommandResources()
-{
-    /* Release staging command buffer */
-    vkFreeCommandBuffers(device_, stagingCommandPool_, 1, &stagingCommandBuffer_);
-    stagingCommandBuffer_ = VK_NULL_HANDLE;
+    if (hasMultiView_)
+    {
+        auto caps = GetRenderingCaps();
+        caps.features.hasMultiView  = true;
+        caps.limits.maxNumViews     = QueryMaxMultiviewViewCount();
+        SetRenderingCaps(caps);
+    }
+
+    if (hasMeshShaders_)
+    {
+        auto caps = GetRenderingCaps();
+        caps.features.hasMeshShaders = true;
+        QueryMeshShaderLimits(caps.limits);
+        SetRenderingCaps(caps);
+    }
+
+    if (hasRayQueries_)
+    {
+        auto caps = GetRenderingCaps();
+        caps.features.hasRayQueries = true;
+        SetRenderingCaps(caps);
+        accelerationStructureScratchAlignment_ = QueryAccelerationStructureScratchAlignment();
+    }
+
+    /* Query device graphics queue */
+    vkGetDeviceQueue(device_, queueFamilyIndices_.graphicsFamily, 0, &graphicsQueue_);
+
+    /* Query dedicated compute queue, which can only be synchronized with the graphics queue by timeline semaphores */
+    if (GetRenderingCaps().features.hasComputeQueue)
+    {
+        vkGetDeviceQueue(device_, queueFamilyIndices_.computeFamily, 0, &computeQueue_);
+        if (hasBackgroundQueueSlot_)
+            vkGetDeviceQueue(device_, queueFamilyIndices_.computeFamily, 1, &backgroundQueue_);
+        sharedQueueFamilies_ = { queueFamilyIndices_.graphicsFamily, queueFamilyIndices_.computeFamily };
+    }
+
+    /* Query dedicated transfer queue for worker threads, which is synchronized with the other queues by timeline semaphores as well */
+    if (hasTimelineSemaphores_ && queueFamilyIndices_.transferFamily != QueueFamilyIndices::invalidIndex)
+    {
+        vkGetDeviceQueue(device_, queueFamilyIndices_.transferFamily, 0, &transferQueue_);
+        if (sharedQueueFamilies_.empty())
+            sharedQueueFamilies_.push_back(queueFamilyIndices_.graphicsFamily);
+        sharedQueueFamilies_.push_back(queueFamilyIndices_.transferFamily);
+    }
 }
 
 void VKRenderSystem::CreateDefaultPipelineLayout()
@@ -997,10 +2679,50 @@ void VKRenderSystem::CreateDefaultPipelineLayout()
     {
         layoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     }
-    auto result = vkCreatePipelineLayout(device_, &layoutCreateInfo, nullptr, defaultPipelineLayout_.ReleaseAndGetAddressOf());
+    auto result = vkCreatePipelineLayout(device_, &layoutCreateInfo, VKGetAllocationCallbacks(), defaultPipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan default pipeline layout");
 }
 
+void VKRenderSystem::CreatePipelineCache()
+{
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = 0;
+        createInfo.pInitialData     = nullptr;
+    }
+    auto result = vkCreatePipelineCache(device_, &createInfo, VKGetAllocationCallbacks(), pipelineCache_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+}
+
+// see https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#pipelines-cache-header
+bool VKRenderSystem::IsPipelineCacheCompatible(const void* data, std::size_t dataSize) const
+{
+    /* Pipeline cache header: length (4 bytes), version (4 bytes), vendor ID (4 bytes), device ID (4 bytes), UUID (VK_UUID_SIZE bytes) */
+    static const std::size_t headerSize = sizeof(std::uint32_t)*4 + VK_UUID_SIZE;
+
+    if (data == nullptr || dataSize < headerSize)
+        return false;
+
+    std::uint32_t header[4];
+    ::memcpy(header, data, sizeof(header));
+
+    if (header[0] < headerSize || header[1] != static_cast<std::uint32_t>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE))
+        return false;
+
+    /* Compare vendor ID, device ID, and cache UUID with selected physical device */
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice_, &properties);
+
+    if (header[2] != properties.vendorID || header[3] != properties.deviceID)
+        return false;
+
+    auto uuid = reinterpret_cast<const std::uint8_t*>(data) + sizeof(header);
+    return (::memcmp(uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+}
+
 bool VKRenderSystem::IsLayerRequired(const std::string& name) const
 {
     //TODO: make this statically optional
@@ -1011,6 +2733,11 @@ bool VKRenderSystem::IsLayerRequired(const std::string& name) const
     return false;
 }
 
+bool VKRenderSystem::IsWorkerThread() const
+{
+    return (transferUploads_ && transferUploads_->IsWorkerThread());
+}
+
 bool VKRenderSystem::IsExtensionRequired(const std::string& name) const
 {
     return
@@ -1023,6 +2750,12 @@ bool VKRenderSystem::IsExtensionRequired(const std::string& name) const
         || name == VK_KHR_XLIB_SURFACE_EXTENSION_NAME
         #endif
         || (debugLayerEnabled_ && name == VK_EXT_DEBUG_REPORT_EXTENSION_NAME)
+        #ifdef VK_KHR_get_physical_device_properties2
+        || name == VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME
+        #endif
+        #if defined LLGL_ENABLE_DEBUG_MARKERS && defined VK_EXT_debug_utils
+        || name == VK_EXT_DEBUG_UTILS_EXTENSION_NAME
+        #endif
     );
 }
 
@@ -1054,6 +2787,36 @@ std::uint32_t VKRenderSystem::FindMemoryType(std::uint32_t memoryTypeBits, VkMem
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
+GraphicsPipeline* VKRenderSystem::CreateGraphicsPipelineWithMode(const GraphicsPipelineDescriptor& desc, bool async)
+{
+    VkRenderPass renderPassVK = VK_NULL_HANDLE;
+    VkExtent2D extent = { 0, 0 };
+
+    if (!renderContexts_.empty())
+    {
+        /* Use render pass and default viewport of the main render context */
+        auto renderContext = renderContexts_.begin()->get();
+        renderPassVK    = renderContext->GetSwapChainRenderPass();
+        extent          = renderContext->GetSwapChainExtent();
+    }
+    else if (desc.renderTarget != nullptr)
+    {
+        /* Use default viewport of the render target in headless mode (its render pass is selected by the pipeline itself) */
+        auto renderTargetVK = LLGL_CAST(VKRenderTarget*, desc.renderTarget);
+        extent = renderTargetVK->GetVkExtent();
+    }
+    else
+        throw std::runtime_error("cannot create graphics pipeline without a render context or render target");
+
+    return TakeOwnership(
+        graphicsPipelines_,
+        MakeUnique<VKGraphicsPipeline>(
+            device_, renderPassVK, defaultPipelineLayout_, pipelineCache_,
+            desc, gfxPipelineLimits_, extent, async
+        )
+    );
+}
+
 VKBuffer* VKRenderSystem::CreateHardwareBuffer(const BufferDescriptor& desc, VkBufferUsageFlags usage)
 {
     /* Create hardware buffer */
@@ -1063,28 +2826,37 @@ VKBuffer* VKRenderSystem::CreateHardwareBuffer(const BufferDescriptor& desc, VkB
     {
         case BufferType::Vertex:
         {
-            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT));
+            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT), &sharedQueueFamilies_);
             return TakeOwnership(buffers_, MakeUnique<VKBuffer>(BufferType::Vertex, device_, createInfo));
         }
         break;
 
         case BufferType::Index:
         {
-            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_INDEX_BUFFER_BIT));
+            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_INDEX_BUFFER_BIT), &sharedQueueFamilies_);
             return TakeOwnership(buffers_, MakeUnique<VKIndexBuffer>(device_, createInfo, desc.indexBuffer.format));
         }
         break;
 
         case BufferType::Constant:
         {
-            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT));
+            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), &sharedQueueFamilies_);
             return TakeOwnership(buffers_, MakeUnique<VKBuffer>(BufferType::Constant, device_, createInfo));
         }
         break;
 
         case BufferType::Storage:
         {
-            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT));
+            if (HasBufferCounter(desc))
+            {
+                /* Store hidden counter of append and consume buffers behind the elements */
+                const auto counterOffset = ((static_cast<VkDeviceSize>(desc.size) + 3) & ~static_cast<VkDeviceSize>(3));
+                FillBufferCreateInfo(createInfo, counterOffset + sizeof(std::uint32_t), (usage | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT), &sharedQueueFamilies_);
+                auto bufferVK = MakeUnique<VKBuffer>(BufferType::Storage, device_, createInfo);
+                bufferVK->SetCounterOffset(counterOffset);
+                return TakeOwnership(buffers_, std::move(bufferVK));
+            }
+            FillBufferCreateInfo(createInfo, static_cast<VkDeviceSize>(desc.size), (usage | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT), &sharedQueueFamilies_);
             return TakeOwnership(buffers_, MakeUnique<VKBuffer>(BufferType::Storage, device_, createInfo));
         }
         break;
@@ -1131,89 +2903,59 @@ std::tuple<VKBufferWithRequirements, VKDeviceMemoryRegion*> VKRenderSystem::Crea
     return std::make_tuple(std::move(stagingBuffer), memoryRegionStaging);
 }
 
-void VKRenderSystem::BeginStagingCommands()
+void VKRenderSystem::TransitionImageLayout(
+    VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, std::uint32_t numMipLevels, std::uint32_t numArrayLayers)
 {
-    /* Begin command buffer record */
-    VkCommandBufferBeginInfo beginInfo;
+    VkImageSubresourceRange subresourceRange;
     {
-        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.pNext             = nullptr;
-        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        beginInfo.pInheritanceInfo  = nullptr;
+        subresourceRange.aspectMask     = VKGetImageAspectByFormat(format);
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = numMipLevels;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = numArrayLayers;
     }
-    auto result = vkBeginCommandBuffer(stagingCommandBuffer_, &beginInfo);
-    VKThrowIfFailed(result, "failed to begin recording Vulkan command buffer");
+    TransitionImageLayout(image, oldLayout, newLayout, subresourceRange);
 }
 
-void VKRenderSystem::EndStagingCommands()
+void VKRenderSystem::TransitionImageLayout(
+    VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, const VkImageSubresourceRange& subresourceRange)
 {
-    /* End command buffer record */
-    vkEndCommandBuffer(stagingCommandBuffer_);
-
-    /* Submit command buffer to queue */
-    VkSubmitInfo submitInfo = {};
-    {
-        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount   = 1;
-        submitInfo.pCommandBuffers      = (&stagingCommandBuffer_);
-    }
-    vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue_);
+    /* Append transition to the pending barriers of the staging ring, which are flushed before the next staging command */
+    stagingRing_->TransitionImageLayout(image, oldLayout, newLayout, subresourceRange);
 }
 
-void VKRenderSystem::TransitionImageLayout(
-    VkImage image, VkFormat /*format*/, VkImageLayout oldLayout, VkImageLayout newLayout, std::uint32_t numMipLevels, std::uint32_t numArrayLayers)
+const void* VKRenderSystem::GetTextureUploadData(const Format format, const Extent3D& extent, const SrcImageDescriptor& imageDesc, ByteBuffer& tempImageBuffer)
 {
-    BeginStagingCommands();
+    /* Check if image data must be converted */
+    ImageFormat dstFormat   = ImageFormat::RGBA;
+    DataType    dstDataType = DataType::Int8;
 
-    /* Initialize image memory barrier descriptor */
-    VkImageMemoryBarrier barrier;
-    {
-        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.pNext                           = nullptr;
-        barrier.srcAccessMask                   = 0;
-        barrier.dstAccessMask                   = 0;
-        barrier.oldLayout                       = oldLayout;
-        barrier.newLayout                       = newLayout;
-        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image                           = image;
-        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel   = 0;
-        barrier.subresourceRange.levelCount     = numMipLevels;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount     = numArrayLayers;
-    }
+    if (!IsCompressedFormat(format) && FindSuitableImageFormat(format, dstFormat, dstDataType))
+        tempImageBuffer = ConvertImageBuffer(imageDesc, dstFormat, dstDataType, GetConfiguration().threadCount);
 
-    /* Initialize pipeline state flags */
-    VkPipelineStageFlags srcStageMask = 0;
-    VkPipelineStageFlags dstStageMask = 0;
-
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-    {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+    if (tempImageBuffer)
     {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        const auto numTexels        = (extent.width * extent.height * extent.depth);
+        const auto srcImageDataSize = numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
+        return tempImageBuffer.get();
     }
 
-    /* Record image barrier command */
-    vkCmdPipelineBarrier(stagingCommandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(TextureBufferSize(format, extent)));
+    return imageDesc.data;
+}
 
-    EndStagingCommands();
+void VKRenderSystem::WriteBufferInternal(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    /* Record uploads of worker threads into the transfer queue and all others into the staging ring of the render thread */
+    if (IsWorkerThread())
+        transferUploads_->WriteBuffer(dstBuffer, dstOffset, data, dataSize);
+    else
+        stagingRing_->WriteBuffer(dstBuffer, dstOffset, data, dataSize);
 }
 
 void VKRenderSystem::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset)
 {
-    BeginStagingCommands();
-
     /* Record copy command */
     VkBufferCopy region;
     {
@@ -1221,161 +2963,106 @@ void VKRenderSystem::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDevice
         region.dstOffset    = dstOffset;
         region.size         = size;
     }
-    vkCmdCopyBuffer(stagingCommandBuffer_, srcBuffer, dstBuffer, 1, &region);
-
-    EndStagingCommands();
+    vkCmdCopyBuffer(stagingRing_->GetCommandBuffer(), srcBuffer, dstBuffer, 1, &region);
 }
 
-void VKRenderSystem::CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, const VkExtent3D& extent, std::uint32_t numLayers)
+void VKRenderSystem::WaitForQueuesIdle()
 {
-    BeginStagingCommands();
-
-    /* Record copy command */
-    VkBufferImageCopy region;
-    {
-        region.bufferOffset                     = 0;
-        region.bufferRowLength                  = 0;
-        region.bufferImageHeight                = 0;
-        region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel        = 0;
-        region.imageSubresource.baseArrayLayer  = 0;
-        region.imageSubresource.layerCount      = numLayers;
-        region.imageOffset                      = { 0, 0, 0 };
-        region.imageExtent                      = extent;
-    }
-    vkCmdCopyBufferToImage(stagingCommandBuffer_, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    EndStagingCommands();
+    vkQueueWaitIdle(graphicsQueue_);
+    if (computeQueue_ != VK_NULL_HANDLE)
+        vkQueueWaitIdle(computeQueue_);
+    if (backgroundQueue_ != VK_NULL_HANDLE)
+        vkQueueWaitIdle(backgroundQueue_);
 }
 
 void VKRenderSystem::AssertBufferCPUAccess(const VKBuffer& bufferVK)
 {
-    if (bufferVK.GetStagingVkBuffer() == VK_NULL_HANDLE)
+    if (!bufferVK.IsHostVisible() && bufferVK.GetStagingVkBuffer() == VK_NULL_HANDLE)
         throw std::runtime_error("hardware buffer was not created with CPU access (missing staging VkBuffer)");
 }
 
-//TODO: add parameters
 void VKRenderSystem::GenerateMipsPrimary(VKTexture& textureVK, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
     /* Get Vulkan image object */
     auto image  = textureVK.GetVkImage();
     auto extent = textureVK.GetVkExtent();
 
-    TransitionImageLayout(image, VK_FORMAT_UNDEFINED, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, numMipLevels, numArrayLayers);
+    /* Determine extent of the base MIP level, which is the source of all other MIP levels */
+    extent.width    = std::max(1u, extent.width  >> baseMipLevel);
+    extent.height   = std::max(1u, extent.height >> baseMipLevel);
+    extent.depth    = std::max(1u, extent.depth  >> baseMipLevel);
+
+    VkImageSubresourceRange subresourceRange;
+    {
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = baseMipLevel;
+        subresourceRange.levelCount     = numMipLevels;
+        subresourceRange.baseArrayLayer = baseArrayLayer;
+        subresourceRange.layerCount     = numArrayLayers;
+    }
 
-    BeginStagingCommands();
+    /* Keep content of the base MIP level */
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
 
-    /* Initialize image memory barrier */
-    VkImageMemoryBarrier barrier;
+    /*
+    Blit each MIP-map from previous (lower) MIP level.
+    All array layers are blitted at once, so there is only a single barrier chain per MIP level instead of one per array layer.
+    */
+    subresourceRange.levelCount = 1;
 
-    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.pNext                           = nullptr;
-    barrier.srcAccessMask                   = 0;
-    barrier.dstAccessMask                   = 0;
-    barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image                           = image;
-    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel   = 0;
-    barrier.subresourceRange.levelCount     = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount     = 1;
+    auto currExtent = extent;
 
-    /* Blit each MIP-map from previous (lower) MIP level */
-    for (std::uint32_t arrayLayer = 0; arrayLayer < numArrayLayers; ++arrayLayer)
+    for (std::uint32_t mipLevel = baseMipLevel + 1; mipLevel < baseMipLevel + numMipLevels; ++mipLevel)
     {
-        auto currExtent = extent;
+        /* Determine extent of next MIP level */
+        auto nextExtent = currExtent;
+
+        nextExtent.width    = std::max(1u, currExtent.width  / 2);
+        nextExtent.height   = std::max(1u, currExtent.height / 2);
+        nextExtent.depth    = std::max(1u, currExtent.depth  / 2);
+
+        /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
+        subresourceRange.baseMipLevel = mipLevel - 1;
+        TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, subresourceRange);
+
+        /* Blit previous MIP level into next higher MIP level (with smaller extent) */
+        VkImageBlit blit;
+
+        blit.srcSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel        = mipLevel - 1;
+        blit.srcSubresource.baseArrayLayer  = baseArrayLayer;
+        blit.srcSubresource.layerCount      = numArrayLayers;
+        blit.srcOffsets[0]                  = { 0, 0, 0 };
+        blit.srcOffsets[1].x                = static_cast<std::int32_t>(currExtent.width);
+        blit.srcOffsets[1].y                = static_cast<std::int32_t>(currExtent.height);
+        blit.srcOffsets[1].z                = static_cast<std::int32_t>(currExtent.depth);
+        blit.dstSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel        = mipLevel;
+        blit.dstSubresource.baseArrayLayer  = baseArrayLayer;
+        blit.dstSubresource.layerCount      = numArrayLayers;
+        blit.dstOffsets[0]                  = { 0, 0, 0 };
+        blit.dstOffsets[1].x                = static_cast<std::int32_t>(nextExtent.width);
+        blit.dstOffsets[1].y                = static_cast<std::int32_t>(nextExtent.height);
+        blit.dstOffsets[1].z                = static_cast<std::int32_t>(nextExtent.depth);
+
+        vkCmdBlitImage(
+            stagingRing_->GetCommandBuffer(),
+            image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR
+        );
 
-        for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
-        {
-            /* Determine extent of next MIP level */
-            auto nextExtent = currExtent;
-
-            nextExtent.width    = std::max(1u, currExtent.width  / 2);
-            nextExtent.height   = std::max(1u, currExtent.height / 2);
-            nextExtent.depth    = std::max(1u, currExtent.depth  / 2);
-
-            /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
-            barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.subresourceRange.baseMipLevel   = mipLevel - 1;
-            barrier.subresourceRange.baseArrayLayer = arrayLayer;
-
-            vkCmdPipelineBarrier(
-                stagingCommandBuffer_,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
-            );
-
-            /* Blit previous MIP level into next higher MIP level (with smaller extent) */
-            VkImageBlit blit;
-
-            blit.srcSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.srcSubresource.mipLevel        = mipLevel - 1;
-            blit.srcSubresource.baseArrayLayer  = arrayLayer;
-            blit.srcSubresource.layerCount      = 1;
-            blit.srcOffsets[0]                  = { 0, 0, 0 };
-            blit.srcOffsets[1].x                = static_cast<std::int32_t>(currExtent.width);
-            blit.srcOffsets[1].y                = static_cast<std::int32_t>(currExtent.height);
-            blit.srcOffsets[1].z                = static_cast<std::int32_t>(currExtent.depth);
-            blit.dstSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.dstSubresource.mipLevel        = mipLevel;
-            blit.dstSubresource.baseArrayLayer  = arrayLayer;
-            blit.dstSubresource.layerCount      = 1;
-            blit.dstOffsets[0]                  = { 0, 0, 0 };
-            blit.dstOffsets[1].x                = static_cast<std::int32_t>(nextExtent.width);
-            blit.dstOffsets[1].y                = static_cast<std::int32_t>(nextExtent.height);
-            blit.dstOffsets[1].z                = static_cast<std::int32_t>(nextExtent.depth);
-
-            vkCmdBlitImage(
-                stagingCommandBuffer_,
-                image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                1, &blit,
-                VK_FILTER_LINEAR
-            );
-
-            /* Transition previous MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-            barrier.srcAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
-            barrier.oldLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            vkCmdPipelineBarrier(
-                stagingCommandBuffer_,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
-            );
-
-            /* Reduce image extent to next MIP level */
-            currExtent = nextExtent;
-        }
+        /* Transition previous MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
+        TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
 
-        /* Transition last MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-        barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
-        barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.subresourceRange.baseMipLevel   = numMipLevels - 1;
-
-        vkCmdPipelineBarrier(
-            stagingCommandBuffer_,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
+        /* Reduce image extent to next MIP level */
+        currExtent = nextExtent;
     }
 
-    EndStagingCommands();
+    /* Transition last MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
+    subresourceRange.baseMipLevel = baseMipLevel + numMipLevels - 1;
+    TransitionImageLayout(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
 }
 
 
@@ -13,11 +13,18 @@
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
+#include "../ReleaseQueue.h"
+#include "../FencePool.h"
+#include "../StatisticsCounter.h"
+#include "../TextureReadbackPool.h"
 #include "Memory/VKDeviceMemoryManager.h"
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
 #include "VKRenderContext.h"
+#include "VKStagingRing.h"
+#include "VKTransferQueue.h"
 
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
@@ -30,16 +37,23 @@
 #include "Texture/VKRenderTarget.h"
 
 #include "RenderState/VKQuery.h"
+#include "RenderState/VKQueryHeap.h"
+#include "RenderState/VKIndirectCommandLayout.h"
+#include "RenderState/VKAccelerationStructure.h"
+#include "RenderState/VKRenderPass.h"
+#include "RenderState/VKRenderPassCache.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKGraphicsPipeline.h"
 #include "RenderState/VKComputePipeline.h"
 #include "RenderState/VKResourceHeap.h"
+#include "RenderState/VKDescriptorSetAllocator.h"
 
 #include <string>
 #include <memory>
 #include <vector>
 #include <set>
+#include <map>
 #include <tuple>
 
 
@@ -66,11 +80,13 @@ class VKRenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetCommandQueue(const QueueType type) override;
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
         CommandBufferExt* CreateCommandBufferExt() override;
+        CommandBuffer* CreateSecondaryCommandBuffer() override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -85,17 +101,29 @@ class VKRenderSystem final : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        std::uint32_t ReadBufferAsync(Buffer& buffer, std::uint64_t offset, std::uint64_t size, Fence& fence) override;
+        void ReadBufferAsyncResult(std::uint32_t readback, void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
 
         void Release(Texture& texture) override;
 
         void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const SrcImageDescriptor& imageDesc) override;
+        void WriteTextureRegions(Texture& texture, std::uint32_t numRegions, const SubTextureImage* regions) override;
+
+        TextureUploadMemory BeginTextureUpload(Texture& texture, const SubTextureDescriptor& subTextureDesc) override;
+        void EndTextureUpload() override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
 
+        std::uint32_t ReadTextureAsync(Texture& texture, const TextureRegion& region, Fence& fence) override;
+        void ReadTextureAsyncResult(std::uint32_t readback, const DstImageDescriptor& imageDesc) override;
+
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
 
@@ -111,12 +139,20 @@ class VKRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        void WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, std::uint32_t numResourceViews, const ResourceViewDescriptor* resourceViews) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
 
         void Release(RenderTarget& renderTarget) override;
 
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& desc) override;
+
+        void Release(RenderPass& renderPass) override;
+
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& desc) override;
@@ -134,38 +170,85 @@ class VKRenderSystem final : public RenderSystem
         /* ----- Pipeline States ----- */
 
         GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        GraphicsPipeline* CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc) override;
         ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
 
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        /* ----- Pipeline Caches ----- */
+
+        std::vector<char> GetPipelineCacheData() const override;
+        bool SetPipelineCacheData(const void* data, std::size_t dataSize) override;
+
+        /* ----- Statistics ----- */
+
+        bool QueryStatistics(RenderingStatistics& statistics, bool reset = true) override;
+        bool QueryMemoryStatistics(MemoryStatistics& statistics) override;
+        bool QueryTimestampCalibration(TimestampCalibration& calibration) override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
 
         void Release(Query& query) override;
 
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& desc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
+        /* ----- Indirect Command Layouts ----- */
+
+        IndirectCommandLayout* CreateIndirectCommandLayout(const IndirectCommandLayoutDescriptor& desc) override;
+
+        void Release(IndirectCommandLayout& indirectCommandLayout) override;
+
+        /* ----- Acceleration Structures ----- */
+
+        AccelerationStructure* CreateAccelerationStructure(const AccelerationStructureDescriptor& desc) override;
+
+        void Release(AccelerationStructure& accelerationStructure) override;
+
         /* ----- Fences ----- */
 
         Fence* CreateFence() override;
 
         void Release(Fence& fence) override;
 
+        /* ----- Upload batches ----- */
+
+        void BeginUploadBatch() override;
+        void EndUploadBatch() override;
+
+        /* ----- Worker threads ----- */
+
+        bool AttachWorkerThread() override;
+        void DetachWorkerThread() override;
+
     private:
 
         void CreateInstance(const ApplicationDescriptor* applicationDesc);
         void CreateDebugReportCallback();
         void LoadExtensions();
-        bool PickPhysicalDevice();
+        void QueryVideoAdapters(const std::vector<VkPhysicalDevice>& devices);
+        bool PickPhysicalDevice(const RenderSystemDescriptor& renderSystemDesc);
         void QueryDeviceProperties();
+        void QueryTextureFormats(std::vector<Format>& textureFormats);
+        std::uint32_t QueryMaxMultiviewViewCount();
+        void QueryMeshShaderLimits(RenderingLimits& limits);
+        VkDeviceSize QueryAccelerationStructureScratchAlignment();
+        void QuerySubgroupProperties(std::uint32_t apiVersion, RenderingCapabilities& caps);
         void CreateLogicalDevice();
 
-        void CreateStagingCommandResources();
-        void ReleaseStagingCommandResources();
-
         void CreateDefaultPipelineLayout();
+        void CreatePipelineCache();
+
+        bool IsPipelineCacheCompatible(const void* data, std::size_t dataSize) const;
 
         bool IsLayerRequired(const std::string& name) const;
+
+        // Returns true if the calling thread has been attached as worker thread.
+        bool IsWorkerThread() const;
         bool IsExtensionRequired(const std::string& name) const;
         bool IsPhysicalDeviceSuitable(VkPhysicalDevice device) const;
         bool CheckDeviceExtensionSupport(VkPhysicalDevice device, const std::vector<const char*>& extensionNames) const;
@@ -174,21 +257,33 @@ class VKRenderSystem final : public RenderSystem
 
         VKBuffer* CreateHardwareBuffer(const BufferDescriptor& desc, VkBufferUsageFlags usage = 0);
 
+        GraphicsPipeline* CreateGraphicsPipelineWithMode(const GraphicsPipelineDescriptor& desc, bool async);
+
         std::tuple<VKBufferWithRequirements, VKDeviceMemoryRegion*> CreateStagingBuffer(
             const VkBufferCreateInfo& stagingCreateInfo, const void* initialData = nullptr, std::size_t initialDataSize = 0
         );
 
-        void BeginStagingCommands();
-        void EndStagingCommands();
-
         void TransitionImageLayout(
             VkImage image, VkFormat format,
             VkImageLayout oldLayout, VkImageLayout newLayout,
             std::uint32_t numMipLevels, std::uint32_t numArrayLayers
         );
 
+        void TransitionImageLayout(
+            VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+            const VkImageSubresourceRange& subresourceRange
+        );
+
+        // Returns the image data of a sub-texture in the hardware format of the texture, which is converted into 'tempImageBuffer' if necessary.
+        const void* GetTextureUploadData(const Format format, const Extent3D& extent, const SrcImageDescriptor& imageDesc, ByteBuffer& tempImageBuffer);
+
+        // Uploads the specified data into a buffer via the transfer queue if the calling thread is a worker thread, or via the staging ring otherwise.
+        void WriteBufferInternal(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
         void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
-        void CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, const VkExtent3D& extent, std::uint32_t numLayers);
+
+        // Waits until the graphics queue and the optional compute queues are idle, e.g. before a host visible buffer is mapped directly.
+        void WaitForQueuesIdle();
 
         void AssertBufferCPUAccess(const VKBuffer& bufferVK);
 
@@ -208,17 +303,34 @@ class VKRenderSystem final : public RenderSystem
         QueueFamilyIndices                      queueFamilyIndices_;
         VkPhysicalDeviceMemoryProperties        memoryProperties_;
         VkPhysicalDeviceFeatures                features_;
+        float                                   timestampPeriod_        = 1.0f;
+        std::uint32_t                           constantBufferOffsetAlignment_ = 0;
 
         VkQueue                                 graphicsQueue_          = VK_NULL_HANDLE;
-
-        VKPtr<VkCommandPool>                    stagingCommandPool_;
-        VkCommandBuffer                         stagingCommandBuffer_   = VK_NULL_HANDLE;
+        VkQueue                                 computeQueue_           = VK_NULL_HANDLE;   // Dedicated compute queue (optional), see RenderingFeatures::hasComputeQueue
+        VkQueue                                 backgroundQueue_        = VK_NULL_HANDLE;   // Second queue of the dedicated compute family with lowest priority (optional), see RenderingFeatures::hasBackgroundQueue
+        VkQueue                                 transferQueue_          = VK_NULL_HANDLE;   // Dedicated transfer queue for worker threads (optional), see AttachWorkerThread
+        std::vector<std::uint32_t>              sharedQueueFamilies_;                       // Queue families all buffers and textures are shared with (empty if there are no dedicated queues)
 
         VKPtr<VkPipelineLayout>                 defaultPipelineLayout_;
+        VKPtr<VkPipelineCache>                  pipelineCache_;
+        VKRenderPassCache                       renderPassCache_;                           // Native render passes shared by all render targets and render contexts with the same framebuffer layout
 
         bool                                    debugLayerEnabled_      = false;
+        bool                                    hasDescriptorUpdateTemplates_ = false;
+        bool                                    hasTimelineSemaphores_        = false;
+        bool                                    hasMemoryBudget_              = false;
+        bool                                    hasMultiView_                 = false;
+        bool                                    hasCalibratedTimestamps_      = false;
+        bool                                    hasMeshShaders_               = false;
+        bool                                    hasRayQueries_                = false;   // Acceleration structures, ray queries, and buffer device addresses are enabled
+        VkDeviceSize                            accelerationStructureScratchAlignment_ = 1;
+        bool                                    hasBackgroundQueueSlot_       = false;   // Dedicated compute family provides a second queue for background work
 
         std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::unique_ptr<VKStagingRing>          stagingRing_;
+        std::unique_ptr<VKTransferQueue>        transferUploads_;                           // Uploads of worker threads on the dedicated transfer queue (optional)
+        std::unique_ptr<VKDescriptorSetAllocator> descriptorSetAllocator_;   // Shared descriptor pools for all resource heaps
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
@@ -226,12 +338,16 @@ class VKRenderSystem final : public RenderSystem
 
         HWObjectContainer<VKRenderContext>      renderContexts_;
         HWObjectInstance<VKCommandQueue>        commandQueue_;
+        HWObjectInstance<VKCommandQueue>        computeCommandQueue_;
+        HWObjectInstance<VKCommandQueue>        backgroundCommandQueue_;
         HWObjectContainer<VKCommandBuffer>      commandBuffers_;
         HWObjectContainer<VKBuffer>             buffers_;
         HWObjectContainer<VKBufferArray>        bufferArrays_;
         HWObjectContainer<VKTexture>            textures_;
         HWObjectContainer<VKSampler>            samplers_;
+        SamplerCache                            samplerCache_;          // Shares sampler objects between identical sampler descriptors
         HWObjectContainer<VKRenderTarget>       renderTargets_;
+        HWObjectContainer<VKRenderPass>         renderPasses_;
         HWObjectContainer<VKShader>             shaders_;
         HWObjectContainer<VKShaderProgram>      shaderPrograms_;
         HWObjectContainer<VKPipelineLayout>     pipelineLayouts_;
@@ -239,7 +355,51 @@ class VKRenderSystem final : public RenderSystem
         HWObjectContainer<VKComputePipeline>    computePipelines_;
         HWObjectContainer<VKResourceHeap>       resourceHeaps_;
         HWObjectContainer<VKQuery>              queries_;
+        HWObjectContainer<VKQueryHeap>          queryHeaps_;
+        HWObjectContainer<VKIndirectCommandLayout> indirectCommandLayouts_;
+        #ifdef VK_KHR_acceleration_structure
+        HWObjectContainer<VKAccelerationStructure> accelerationStructures_;
+        #endif
         HWObjectContainer<VKFence>              fences_;
+        FencePool<VKFence>                      fencePool_;             // Released fences that are recycled by CreateFence
+
+        struct SharedPipelineLayout
+        {
+            VKPipelineLayout*   pipelineLayout;
+            std::uint32_t       numRefs;
+        };
+
+        std::map<std::vector<std::uint32_t>, SharedPipelineLayout> sharedPipelineLayouts_;  // Pipeline layouts with identical descriptors are shared across pipelines
+
+        ReleaseQueue                            releaseQueue_;          // Released objects the GPU might still reference, destroyed once their frame has been completed
+
+        StatisticsCounter                       statistics_;            // Shared with all command buffers, see LLGL_ENABLE_STATISTICS
+
+        /* ----- Texture and buffer readbacks ----- */
+
+        // Host-visible staging buffer of an asynchronous texture or buffer readback.
+        struct ReadbackBuffer
+        {
+            std::unique_ptr<VKBufferWithRequirements>   buffer;
+            VKDeviceMemoryRegion*                       memoryRegion    = nullptr;
+        };
+
+        TextureReadbackPool<ReadbackBuffer>         textureReadbacks_;
+        TextureReadbackPool<ReadbackBuffer>         bufferReadbacks_;
+
+        /* ----- Texture uploads ----- */
+
+        // Pending texture upload from staging memory of the staging ring, see BeginTextureUpload.
+        struct TextureUpload
+        {
+            VKTexture*          texture     = nullptr;
+            VkBuffer            srcBuffer   = VK_NULL_HANDLE;
+            VkBufferImageCopy   region;
+            VkDeviceSize        size        = 0;
+        };
+
+        TextureUpload                           textureUpload_;
+        std::uint32_t                           uploadBatchDepth_       = 0;    // Number of nested upload batches, see BeginUploadBatch
 
 };
 
@@ -0,0 +1,90 @@
+/*
+ * VKSecondaryCommandPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKSecondaryCommandPool.h"
+#include "VKCore.h"
+
+
+namespace LLGL
+{
+
+
+VKSecondaryCommandPool::VKSecondaryCommandPool(const VKPtr<VkDevice>& device, std::uint32_t queueFamilyIndex) :
+    device_      { device                       },
+    commandPool_ { device, vkDestroyCommandPool }
+{
+    /* Create command pool (command buffers are reset implicitly by 'vkBeginCommandBuffer') */
+    VkCommandPoolCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        createInfo.queueFamilyIndex = queueFamilyIndex;
+    }
+    auto result = vkCreateCommandPool(device_, &createInfo, VKGetAllocationCallbacks(), commandPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan command pool for secondary command buffers");
+}
+
+VkCommandBuffer VKSecondaryCommandPool::Acquire()
+{
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+    /* Take command buffer from free list */
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        if (!freeCommandBuffers_.empty())
+        {
+            commandBuffer = freeCommandBuffers_.back();
+            freeCommandBuffers_.pop_back();
+            refCounts_[commandBuffer] = 1;
+            return commandBuffer;
+        }
+    }
+
+    /* Allocate new command buffer (the pool itself is only accessed by its owner) */
+    VkCommandBufferAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.commandPool           = commandPool_;
+        allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount    = 1;
+    }
+    auto result = vkAllocateCommandBuffers(device_, &allocInfo, &commandBuffer);
+    VKThrowIfFailed(result, "failed to allocate Vulkan secondary command buffer");
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+    refCounts_[commandBuffer] = 1;
+
+    return commandBuffer;
+}
+
+void VKSecondaryCommandPool::AddRef(VkCommandBuffer commandBuffer)
+{
+    std::lock_guard<std::mutex> lock { mutex_ };
+    ++refCounts_[commandBuffer];
+}
+
+void VKSecondaryCommandPool::Release(VkCommandBuffer commandBuffer)
+{
+    std::lock_guard<std::mutex> lock { mutex_ };
+
+    auto it = refCounts_.find(commandBuffer);
+    if (it != refCounts_.end() && --(it->second) == 0)
+    {
+        /* Recycle command buffer; it is reset with its next recording */
+        refCounts_.erase(it);
+        freeCommandBuffers_.push_back(commandBuffer);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,77 @@
+/*
+ * VKSecondaryCommandPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_SECONDARY_COMMAND_POOL_H
+#define LLGL_VK_SECONDARY_COMMAND_POOL_H
+
+
+#include "Vulkan.h"
+#include "VKPtr.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Command pool for the secondary command buffers of a single VKCommandBuffer instance.
+Each secondary VKCommandBuffer has its own pool, so it can be recorded on a worker thread without any synchronization with other command buffers.
+Native command buffers are reference counted: a recording is referenced by its secondary command buffer until the next recording begins,
+and by each primary command buffer that executes it until the primary command buffer has been completed on the GPU.
+Only the reference counts and the list of free command buffers are guarded by a mutex.
+*/
+class VKSecondaryCommandPool
+{
+
+    public:
+
+        VKSecondaryCommandPool(const VKPtr<VkDevice>& device, std::uint32_t queueFamilyIndex);
+
+        VKSecondaryCommandPool(const VKSecondaryCommandPool&) = delete;
+        VKSecondaryCommandPool& operator = (const VKSecondaryCommandPool&) = delete;
+
+        // Returns an unreferenced native command buffer with a reference count of 1. Must only be called by the owner of this pool.
+        VkCommandBuffer Acquire();
+
+        // Increments the reference count of the specified native command buffer.
+        void AddRef(VkCommandBuffer commandBuffer);
+
+        // Decrements the reference count of the specified native command buffer, and recycles it when the reference count reaches zero.
+        void Release(VkCommandBuffer commandBuffer);
+
+    private:
+
+        const VKPtr<VkDevice>&                              device_;
+        VKPtr<VkCommandPool>                                commandPool_;
+
+        std::mutex                                          mutex_;
+        std::vector<VkCommandBuffer>                        freeCommandBuffers_;
+        std::unordered_map<VkCommandBuffer, std::uint32_t>  refCounts_;
+
+};
+
+// Reference to a secondary command buffer recording, which has been executed by a primary command buffer.
+struct VKSecondaryCommandBufferRef
+{
+    std::shared_ptr<VKSecondaryCommandPool> pool;
+    VkCommandBuffer                         commandBuffer;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,514 @@
+/*
+ * VKStagingRing.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingRing.h"
+#include "VKCore.h"
+#include "Memory/VKDeviceMemoryManager.h"
+#include "Memory/VKDeviceMemory.h"
+#include "Memory/VKDeviceMemoryRegion.h"
+#include "../../Core/Helper.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+VKStagingRing::StagingBuffer::StagingBuffer(VKBufferWithRequirements&& buffer, VKDeviceMemoryRegion* memoryRegion) :
+    buffer       { std::move(buffer) },
+    memoryRegion { memoryRegion      }
+{
+}
+
+VKStagingRing::VKStagingRing(
+    const VKPtr<VkDevice>&                  device,
+    VkQueue                                 queue,
+    std::uint32_t                           queueFamilyIndex,
+    VKDeviceMemoryManager&                  deviceMemoryMngr,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            ringSize,
+    std::uint32_t                           numBatches) :
+        device_           { device                        },
+        queue_            { queue                         },
+        deviceMemoryMngr_ { deviceMemoryMngr              },
+        commandPool_      { device, vkDestroyCommandPool  },
+        ringBuffer_       { device, vkDestroyBuffer       },
+        ringMemory_       { device, vkFreeMemory          }
+{
+    CreateCommandPool(queueFamilyIndex);
+    CreateBatches(std::max(1u, numBatches));
+    if (ringSize > 0)
+        CreateRingBuffer(memoryProperties, ringSize);
+}
+
+VKStagingRing::~VKStagingRing()
+{
+    WaitIdle();
+    if (ringData_ != nullptr)
+        vkUnmapMemory(device_, ringMemory_);
+}
+
+VkCommandBuffer VKStagingRing::GetCommandBuffer()
+{
+    auto commandBuffer = GetRecordingBatch().commandBuffer;
+    barriers_.Flush(commandBuffer);
+    return commandBuffer;
+}
+
+void VKStagingRing::TransitionImageLayout(
+    VkImage                         image,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    const VkImageSubresourceRange&  subresourceRange)
+{
+    /* Make sure the current batch is recording, so the pending barriers are submitted with it */
+    GetRecordingBatch();
+    barriers_.TransitionImageLayout(image, oldLayout, newLayout, subresourceRange);
+}
+
+void VKStagingRing::WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    if (data == nullptr || dataSize == 0)
+        return;
+
+    /* Copy data into staging memory */
+    VkBuffer        srcBuffer = VK_NULL_HANDLE;
+    VkDeviceSize    srcOffset = 0;
+    WriteStagingMemory(data, dataSize, srcBuffer, srcOffset);
+
+    /* Record copy command */
+    VkBufferCopy region;
+    {
+        region.srcOffset    = srcOffset;
+        region.dstOffset    = dstOffset;
+        region.size         = dataSize;
+    }
+    vkCmdCopyBuffer(GetCommandBuffer(), srcBuffer, dstBuffer, 1, &region);
+}
+
+void VKStagingRing::WriteImage(VkImage dstImage, const VkBufferImageCopy& region, const void* data, VkDeviceSize dataSize)
+{
+    auto regionWithOffset = region;
+    regionWithOffset.bufferOffset = 0;
+    WriteImage(dstImage, 1, &regionWithOffset, data, dataSize);
+}
+
+void VKStagingRing::WriteImage(VkImage dstImage, std::uint32_t numRegions, const VkBufferImageCopy* regions, const void* data, VkDeviceSize dataSize)
+{
+    if (data == nullptr || dataSize == 0 || numRegions == 0)
+        return;
+
+    /* Copy data into staging memory */
+    VkBuffer        srcBuffer = VK_NULL_HANDLE;
+    VkDeviceSize    srcOffset = 0;
+    WriteStagingMemory(data, dataSize, srcBuffer, srcOffset);
+
+    /* Record a single copy command for all regions */
+    ScratchArena::Scope scratchScope { scratch_ };
+    auto regionsWithOffset = scratch_.Copy(regions, numRegions);
+
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        regionsWithOffset[i].bufferOffset += srcOffset;
+
+    vkCmdCopyBufferToImage(
+        GetCommandBuffer(),
+        srcBuffer,
+        dstImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        numRegions,
+        regionsWithOffset
+    );
+}
+
+std::uint64_t VKStagingRing::Flush()
+{
+    auto& batch = batches_[currentBatch_];
+
+    if (batch.recording)
+    {
+        /* Make all transfer writes visible to subsequent submissions on the same queue and to the host (together with the pending transitions) */
+        barriers_.InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+            VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_HOST_READ_BIT
+        );
+        barriers_.Flush(batch.commandBuffer);
+
+        auto result = vkEndCommandBuffer(batch.commandBuffer);
+        VKThrowIfFailed(result, "failed to end recording of Vulkan staging command buffer");
+
+        /* Submit batch to queue without waiting for its completion */
+        VkSubmitInfo submitInfo = {};
+        {
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount   = 1;
+            submitInfo.pCommandBuffers      = (&batch.commandBuffer);
+        }
+
+        /* Signal timeline semaphore with the value of this batch, so other queues can wait for it on the GPU */
+        #ifdef VK_KHR_timeline_semaphore
+        const std::uint64_t signalValue = submittedValue_ + 1;
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+        if (timelineSemaphore_ != VK_NULL_HANDLE)
+        {
+            timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.signalSemaphoreValueCount  = 1;
+            timelineInfo.pSignalSemaphoreValues     = &signalValue;
+            submitInfo.pNext                        = &timelineInfo;
+            submitInfo.signalSemaphoreCount         = 1;
+            submitInfo.pSignalSemaphores            = &timelineSemaphore_;
+        }
+        #endif // /VK_KHR_timeline_semaphore
+
+        {
+            std::lock_guard<std::mutex> lock { queueMutex_ };
+            result = vkQueueSubmit(queue_, 1, &submitInfo, batch.fence);
+        }
+        VKThrowIfFailed(result, "failed to submit Vulkan staging command buffer");
+
+        batch.recording = false;
+        batch.inFlight  = true;
+        batch.value     = ++submittedValue_;
+        batch.ringEnd   = ringHead_;
+
+        /* Move on to next batch in the ring */
+        currentBatch_ = (currentBatch_ + 1) % batches_.size();
+    }
+
+    return submittedValue_;
+}
+
+std::uint64_t VKStagingRing::Signal()
+{
+    /* Begin an empty batch if necessary, so the submission has its own fence */
+    GetRecordingBatch();
+    return Flush();
+}
+
+void VKStagingRing::WaitIdle()
+{
+    Flush();
+    while (RetireOldestBatch())
+    {
+        /* Retire all in-flight batches from oldest to newest */
+    }
+}
+
+std::uint64_t VKStagingRing::PollCompletedValue()
+{
+    RetireCompletedBatches();
+    return completedValue_;
+}
+
+bool VKStagingRing::HasPendingWork() const
+{
+    return (batches_[currentBatch_].recording || completedValue_ < submittedValue_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKStagingRing::CreateCommandPool(std::uint32_t queueFamilyIndex)
+{
+    VkCommandPoolCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        createInfo.queueFamilyIndex = queueFamilyIndex;
+    }
+    auto result = vkCreateCommandPool(device_, &createInfo, VKGetAllocationCallbacks(), commandPool_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan command pool for staging buffers");
+}
+
+void VKStagingRing::CreateBatches(std::uint32_t numBatches)
+{
+    /* Allocate staging command buffers */
+    std::vector<VkCommandBuffer> commandBuffers(numBatches);
+
+    VkCommandBufferAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.commandPool           = commandPool_;
+        allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount    = numBatches;
+    }
+    auto result = vkAllocateCommandBuffers(device_, &allocInfo, commandBuffers.data());
+    VKThrowIfFailed(result, "failed to allocate Vulkan command buffers for staging buffers");
+
+    /* Create one fence for each batch */
+    fences_.resize(numBatches, VKPtr<VkFence> { device_, vkDestroyFence });
+    batches_.resize(numBatches);
+
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+    }
+
+    for (std::uint32_t i = 0; i < numBatches; ++i)
+    {
+        result = vkCreateFence(device_, &createInfo, VKGetAllocationCallbacks(), fences_[i].ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence for staging buffers");
+
+        batches_[i].commandBuffer   = commandBuffers[i];
+        batches_[i].fence           = fences_[i].Get();
+    }
+}
+
+void VKStagingRing::CreateRingBuffer(const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize ringSize)
+{
+    /* Create ring buffer object */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = ringSize;
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    auto result = vkCreateBuffer(device_, &createInfo, VKGetAllocationCallbacks(), ringBuffer_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan staging ring buffer");
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device_, ringBuffer_, &requirements);
+
+    /* Allocate dedicated device memory, so it can be mapped persistently */
+    VkMemoryAllocateInfo allocInfo;
+    {
+        allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext             = nullptr;
+        allocInfo.allocationSize    = requirements.size;
+        allocInfo.memoryTypeIndex   = VKFindMemoryType(
+            memoryProperties,
+            requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+    }
+    result = vkAllocateMemory(device_, &allocInfo, VKGetAllocationCallbacks(), ringMemory_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to allocate Vulkan device memory for staging ring buffer");
+
+    result = vkBindBufferMemory(device_, ringBuffer_, ringMemory_, 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan staging ring buffer to device memory");
+
+    /* Map entire ring buffer persistently */
+    void* data = nullptr;
+    result = vkMapMemory(device_, ringMemory_, 0, VK_WHOLE_SIZE, 0, &data);
+    VKThrowIfFailed(result, "failed to map Vulkan staging ring buffer into CPU memory space");
+
+    ringData_       = reinterpret_cast<char*>(data);
+    ringSize_       = ringSize;
+    ringAlignment_  = std::max(ringAlignment_, requirements.alignment);
+}
+
+VKStagingRing::Batch& VKStagingRing::GetRecordingBatch()
+{
+    auto& batch = batches_[currentBatch_];
+
+    if (!batch.recording)
+    {
+        /* Recycle ring entry if it's still in flight */
+        RetireCompletedBatches();
+        if (batch.inFlight)
+        {
+            vkWaitForFences(device_, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+            RetireBatch(batch);
+        }
+
+        vkResetFences(device_, 1, &batch.fence);
+
+        /* Begin command buffer record */
+        VkCommandBufferBeginInfo beginInfo;
+        {
+            beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext             = nullptr;
+            beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo  = nullptr;
+        }
+        auto result = vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+        VKThrowIfFailed(result, "failed to begin recording Vulkan staging command buffer");
+
+        /* Uploads must not overwrite resources that are still in use by previously submitted commands (recorded with the first transitions) */
+        barriers_.InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_ACCESS_MEMORY_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT
+        );
+
+        batch.recording = true;
+    }
+
+    return batch;
+}
+
+void* VKStagingRing::MapStagingMemory(VkDeviceSize dataSize, VkBuffer& srcBuffer, VkDeviceSize& srcOffset)
+{
+    /* Make sure the current batch is recording, so the ring region is associated with it */
+    GetRecordingBatch();
+
+    if (ringData_ != nullptr && AllocRingRegion(dataSize, srcOffset))
+    {
+        /* Return region within persistently mapped ring buffer */
+        srcBuffer = ringBuffer_.Get();
+        return (ringData_ + srcOffset);
+    }
+    else
+    {
+        /* Create dedicated staging buffer, which is released once the current batch has been retired */
+        VkBufferCreateInfo createInfo;
+        {
+            createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            createInfo.pNext                    = nullptr;
+            createInfo.flags                    = 0;
+            createInfo.size                     = dataSize;
+            createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
+        VKBufferWithRequirements stagingBuffer { device_ };
+        stagingBuffer.Create(device_, createInfo);
+
+        auto memoryRegion = deviceMemoryMngr_.Allocate(
+            stagingBuffer.requirements.size,
+            stagingBuffer.requirements.alignment,
+            stagingBuffer.requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+
+        memoryRegion->BindBuffer(device_, stagingBuffer.buffer);
+
+        /* Keep device memory mapped until 'UnmapStagingMemory' is called */
+        auto deviceMemory = memoryRegion->GetParentChunk();
+        auto memory = deviceMemory->Map(device_, memoryRegion->GetOffset(), dataSize);
+        if (memory != nullptr)
+            mappedChunk_ = deviceMemory;
+
+        srcBuffer = stagingBuffer.buffer.Get();
+        srcOffset = 0;
+
+        batches_[currentBatch_].stagingBuffers.emplace_back(std::move(stagingBuffer), memoryRegion);
+
+        return memory;
+    }
+}
+
+void VKStagingRing::UnmapStagingMemory()
+{
+    /* Only dedicated staging buffers must be unmapped, the ring buffer is mapped persistently */
+    if (mappedChunk_ != nullptr)
+    {
+        mappedChunk_->Unmap(device_);
+        mappedChunk_ = nullptr;
+    }
+}
+
+void VKStagingRing::WriteStagingMemory(const void* data, VkDeviceSize dataSize, VkBuffer& srcBuffer, VkDeviceSize& srcOffset)
+{
+    if (auto memory = MapStagingMemory(dataSize, srcBuffer, srcOffset))
+        ::memcpy(memory, data, static_cast<std::size_t>(dataSize));
+    UnmapStagingMemory();
+}
+
+bool VKStagingRing::AllocRingRegion(VkDeviceSize size, VkDeviceSize& offset)
+{
+    /* Reject allocations that would occupy more than half of the ring, to keep the ring available for small uploads */
+    if (size > ringSize_ / 2)
+        return false;
+
+    while (true)
+    {
+        /* Determine aligned position within ring; wrap around to the beginning if the region does not fit until the end */
+        auto pos        = ringHead_ % ringSize_;
+        auto alignedPos = GetAlignedSize(pos, ringAlignment_);
+
+        if (alignedPos + size > ringSize_)
+            alignedPos = ringSize_;
+
+        auto padding    = alignedPos - pos;
+        auto start      = (alignedPos == ringSize_ ? 0 : alignedPos);
+
+        if (ringHead_ + padding + size - ringTail_ <= ringSize_)
+        {
+            ringHead_ += padding + size;
+            offset = start;
+            return true;
+        }
+
+        /* Wait for oldest batch to free ring space; if the current batch occupies the ring, submit it first */
+        if (!RetireOldestBatch())
+        {
+            if (batches_[currentBatch_].recording)
+            {
+                Flush();
+                GetRecordingBatch();
+            }
+            else
+                return false;
+        }
+    }
+}
+
+void VKStagingRing::RetireCompletedBatches()
+{
+    for (auto& batch : batches_)
+    {
+        if (batch.inFlight && vkGetFenceStatus(device_, batch.fence) == VK_SUCCESS)
+            RetireBatch(batch);
+    }
+}
+
+bool VKStagingRing::RetireOldestBatch()
+{
+    /* Find in-flight batch with lowest timeline value */
+    Batch* oldest = nullptr;
+
+    for (auto& batch : batches_)
+    {
+        if (batch.inFlight && (oldest == nullptr || batch.value < oldest->value))
+            oldest = &batch;
+    }
+
+    if (oldest != nullptr)
+    {
+        vkWaitForFences(device_, 1, &(oldest->fence), VK_TRUE, UINT64_MAX);
+        RetireBatch(*oldest);
+        return true;
+    }
+
+    return false;
+}
+
+void VKStagingRing::RetireBatch(Batch& batch)
+{
+    /* Release dedicated staging buffers */
+    for (auto& stagingBuffer : batch.stagingBuffers)
+        deviceMemoryMngr_.Release(stagingBuffer.memoryRegion);
+    batch.stagingBuffers.clear();
+
+    /* Free ring space up to the end of this batch */
+    ringTail_       = std::max(ringTail_, batch.ringEnd);
+    completedValue_ = std::max(completedValue_, batch.value);
+    batch.inFlight  = false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
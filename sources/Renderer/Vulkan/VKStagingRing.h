@@ -0,0 +1,206 @@
+/*
+ * VKStagingRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_RING_H
+#define LLGL_VK_STAGING_RING_H
+
+
+#include "Vulkan.h"
+#include "VKPtr.h"
+#include "VKBarrierBatch.h"
+#include "Buffer/VKBuffer.h"
+#include "../ScratchArena.h"
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryManager;
+class VKDeviceMemory;
+class VKDeviceMemoryRegion;
+
+/*
+Ring of staging command buffers for asynchronous resource uploads.
+All upload commands are recorded into the current batch, which is submitted without blocking the CPU
+(either explicitly with 'Flush' or implicitly before the next frame is submitted).
+Each batch is retired by its own fence and identified by a monotonically increasing timeline value.
+Small uploads are sub-allocated from a persistently mapped host-visible ring buffer;
+uploads that do not fit into the ring use a dedicated staging buffer, which is released when its batch has been retired.
+Layout transitions are collected in a barrier batch, which is flushed right before the next recorded command.
+*/
+class VKStagingRing
+{
+
+    public:
+
+        VKStagingRing(
+            const VKPtr<VkDevice>& device,
+            VkQueue queue,
+            std::uint32_t queueFamilyIndex,
+            VKDeviceMemoryManager& deviceMemoryMngr,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            VkDeviceSize ringSize,
+            std::uint32_t numBatches = 3
+        );
+        ~VKStagingRing();
+
+        VKStagingRing(const VKStagingRing&) = delete;
+        VKStagingRing& operator = (const VKStagingRing&) = delete;
+
+        // Returns the command buffer of the current batch, begins recording if necessary, and flushes all pending barriers.
+        VkCommandBuffer GetCommandBuffer();
+
+        // Appends a layout transition to the pending barriers, which are flushed before the next command is recorded.
+        void TransitionImageLayout(
+            VkImage                         image,
+            VkImageLayout                   oldLayout,
+            VkImageLayout                   newLayout,
+            const VkImageSubresourceRange&  subresourceRange
+        );
+
+        // Copies the specified data into staging memory and records a copy command into the destination buffer.
+        void WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
+        // Copies the specified data into staging memory and records a copy command into the destination image (the 'bufferOffset' member of 'region' is ignored).
+        void WriteImage(VkImage dstImage, const VkBufferImageCopy& region, const void* data, VkDeviceSize dataSize);
+
+        // Copies the specified data into staging memory once and records a single copy command for all regions (the 'bufferOffset' member of each region is relative to 'data').
+        void WriteImage(VkImage dstImage, std::uint32_t numRegions, const VkBufferImageCopy* regions, const void* data, VkDeviceSize dataSize);
+
+        /*
+        Allocates staging memory for the current batch and returns a CPU pointer to it, which remains valid until 'UnmapStagingMemory' is called.
+        The copy command that reads from this memory must be recorded into the current batch (see 'GetCommandBuffer') before any other staging memory is allocated.
+        */
+        void* MapStagingMemory(VkDeviceSize dataSize, VkBuffer& srcBuffer, VkDeviceSize& srcOffset);
+
+        // Unmaps the staging memory of the last call to 'MapStagingMemory'.
+        void UnmapStagingMemory();
+
+        // Submits the current batch without waiting for its completion, and returns the timeline value of the last submitted batch.
+        std::uint64_t Flush();
+
+        // Submits the current batch even if no commands have been recorded, and returns its timeline value (reached once all previously submitted work of the queue has been completed).
+        std::uint64_t Signal();
+
+        // Submits the current batch and blocks the CPU until all batches have been completed.
+        void WaitIdle();
+
+        // Retires all completed batches without blocking, and returns the timeline value of the last completed batch.
+        std::uint64_t PollCompletedValue();
+
+        // Returns true if there are recorded or in-flight upload commands.
+        bool HasPendingWork() const;
+
+        // Sets the timeline semaphore that is signaled with the timeline value of each submitted batch (VK_KHR_timeline_semaphore).
+        inline void SetTimelineSemaphore(VkSemaphore semaphore)
+        {
+            timelineSemaphore_ = semaphore;
+        }
+
+        // Returns the timeline value of the last submitted batch.
+        inline std::uint64_t GetSubmittedValue() const
+        {
+            return submittedValue_;
+        }
+
+        // Returns the timeline value of the last completed batch (all batches with a lower or equal value have been completed as well).
+        inline std::uint64_t GetCompletedValue() const
+        {
+            return completedValue_;
+        }
+
+        // Returns the mutex that guards the queue of this ring against concurrent presentation on the present thread (see RenderContextDescriptor::threadedPresent).
+        inline std::mutex& GetQueueMutex()
+        {
+            return queueMutex_;
+        }
+
+    private:
+
+        struct StagingBuffer
+        {
+            StagingBuffer(VKBufferWithRequirements&& buffer, VKDeviceMemoryRegion* memoryRegion);
+
+            VKBufferWithRequirements    buffer;
+            VKDeviceMemoryRegion*       memoryRegion    = nullptr;
+        };
+
+        struct Batch
+        {
+            VkCommandBuffer             commandBuffer   = VK_NULL_HANDLE;
+            VkFence                     fence           = VK_NULL_HANDLE;
+            std::uint64_t               value           = 0;
+            VkDeviceSize                ringEnd         = 0;
+            bool                        recording       = false;
+            bool                        inFlight        = false;
+            std::vector<StagingBuffer>  stagingBuffers;
+        };
+
+    private:
+
+        void CreateCommandPool(std::uint32_t queueFamilyIndex);
+        void CreateBatches(std::uint32_t numBatches);
+        void CreateRingBuffer(const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize ringSize);
+
+        // Returns the current batch and begins recording if necessary.
+        Batch& GetRecordingBatch();
+
+        // Writes the specified data into staging memory and returns the staging buffer and offset to copy from.
+        void WriteStagingMemory(const void* data, VkDeviceSize dataSize, VkBuffer& srcBuffer, VkDeviceSize& srcOffset);
+
+        // Tries to allocate a region within the ring buffer, and waits for in-flight batches if the ring is full.
+        bool AllocRingRegion(VkDeviceSize size, VkDeviceSize& offset);
+
+        // Retires all batches whose fences have been signaled (non-blocking).
+        void RetireCompletedBatches();
+
+        // Waits for the oldest in-flight batch and retires it. Returns false if there is no batch in flight.
+        bool RetireOldestBatch();
+
+        void RetireBatch(Batch& batch);
+
+        const VKPtr<VkDevice>&      device_;
+        VkQueue                     queue_              = VK_NULL_HANDLE;
+        std::mutex                  queueMutex_;
+        VKDeviceMemoryManager&      deviceMemoryMngr_;
+
+        VKPtr<VkCommandPool>        commandPool_;
+        std::vector<VKPtr<VkFence>> fences_;
+        std::vector<Batch>          batches_;
+        std::size_t                 currentBatch_       = 0;
+        VKBarrierBatch              barriers_;                      // Pending barriers of the current batch
+        ScratchArena                scratch_;                       // Transient copy regions
+
+        VKPtr<VkBuffer>             ringBuffer_;
+        VKPtr<VkDeviceMemory>       ringMemory_;
+        char*                       ringData_           = nullptr;
+        VkDeviceSize                ringSize_           = 0;
+        VkDeviceSize                ringAlignment_      = 16;
+        VkDeviceSize                ringHead_           = 0;
+        VkDeviceSize                ringTail_           = 0;
+
+        std::uint64_t               submittedValue_     = 0;
+        std::uint64_t               completedValue_     = 0;
+        VkSemaphore                 timelineSemaphore_  = VK_NULL_HANDLE;   // Optional timeline semaphore, see SetTimelineSemaphore
+
+        VKDeviceMemory*             mappedChunk_        = nullptr;          // Device memory of a dedicated staging buffer, see MapStagingMemory
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
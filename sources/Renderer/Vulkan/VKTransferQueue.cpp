@@ -0,0 +1,210 @@
+/*
+ * VKTransferQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKTransferQueue.h"
+
+
+namespace LLGL
+{
+
+
+VKTransferQueue::VKTransferQueue(
+    const VKPtr<VkDevice>&                  device,
+    VkQueue                                 queue,
+    std::uint32_t                           queueFamilyIndex,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            ringSize) :
+        deviceMemoryMngr_ { device, memoryProperties, 1024*1024, false                                },
+        stagingRing_      { device, queue, queueFamilyIndex, deviceMemoryMngr_, memoryProperties, ringSize },
+        commandQueue_     { device, queue, stagingRing_                                              },
+        timelineFence_    { device, true                                                             }
+{
+    /* Let each upload batch signal the timeline semaphore, which is created here to be accessible without synchronization */
+    timelineSemaphore_ = timelineFence_.GetTimelineSemaphore();
+    stagingRing_.SetTimelineSemaphore(timelineSemaphore_);
+}
+
+void VKTransferQueue::AttachWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerThreadsMutex_ };
+    workerThreads_.insert(std::this_thread::get_id());
+}
+
+void VKTransferQueue::DetachWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerThreadsMutex_ };
+
+    auto it = workerThreads_.find(std::this_thread::get_id());
+    if (it != workerThreads_.end())
+    {
+        /* Make sure all uploads have been submitted before the worker thread terminates */
+        Flush();
+        workerThreads_.erase(it);
+    }
+}
+
+bool VKTransferQueue::IsWorkerThread()
+{
+    std::lock_guard<std::mutex> guard { workerThreadsMutex_ };
+    return (workerThreads_.find(std::this_thread::get_id()) != workerThreads_.end());
+}
+
+void VKTransferQueue::WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    stagingRing_.WriteBuffer(dstBuffer, dstOffset, data, dataSize);
+}
+
+void VKTransferQueue::WriteImage(
+    VkImage                         dstImage,
+    const VkBufferImageCopy&        region,
+    const VkImageSubresourceRange&  subresourceRange,
+    const void*                     data,
+    VkDeviceSize                    dataSize)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /*
+    Transition subresource into transfer layout and back. Stages and access masks are limited to the transfer stage,
+    since the dependencies with the other queues are resolved by the timeline semaphore
+    */
+    RecordImageBarrier(
+        dstImage,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        0,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        subresourceRange
+    );
+    {
+        stagingRing_.WriteImage(dstImage, region, data, dataSize);
+    }
+    RecordImageBarrier(
+        dstImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        0,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        subresourceRange
+    );
+}
+
+void VKTransferQueue::InitImage(
+    VkImage                         dstImage,
+    std::uint32_t                   numRegions,
+    const VkBufferImageCopy*        regions,
+    const VkImageSubresourceRange&  subresourceRange,
+    const void*                     data,
+    VkDeviceSize                    dataSize)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Images without initial data skip the transfer layout (transient attachments do not even support it) */
+    if (data == nullptr)
+    {
+        RecordImageBarrier(
+            dstImage,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            0,
+            0,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            subresourceRange
+        );
+        return;
+    }
+
+    /* Discard previous content, since the image has not been used by any queue yet */
+    RecordImageBarrier(
+        dstImage,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        0,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        subresourceRange
+    );
+    stagingRing_.WriteImage(dstImage, numRegions, regions, data, dataSize);
+    RecordImageBarrier(
+        dstImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        0,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        subresourceRange
+    );
+}
+
+void VKTransferQueue::Submit(Fence& fence)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    commandQueue_.Submit(fence);
+}
+
+void VKTransferQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    commandQueue_.Signal(fence, value);
+}
+
+std::uint64_t VKTransferQueue::Flush()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return stagingRing_.Flush();
+}
+
+void VKTransferQueue::WaitIdle()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    stagingRing_.WaitIdle();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKTransferQueue::RecordImageBarrier(
+    VkImage                         image,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    VkAccessFlags                   srcAccessMask,
+    VkAccessFlags                   dstAccessMask,
+    VkPipelineStageFlags            srcStageMask,
+    VkPipelineStageFlags            dstStageMask,
+    const VkImageSubresourceRange&  subresourceRange)
+{
+    VkImageMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccessMask;
+        barrier.dstAccessMask       = dstAccessMask;
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image               = image;
+        barrier.subresourceRange    = subresourceRange;
+    }
+    vkCmdPipelineBarrier(stagingRing_.GetCommandBuffer(), srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,133 @@
+/*
+ * VKTransferQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_TRANSFER_QUEUE_H
+#define LLGL_VK_TRANSFER_QUEUE_H
+
+
+#include "Vulkan.h"
+#include "VKPtr.h"
+#include "VKStagingRing.h"
+#include "VKCommandQueue.h"
+#include "RenderState/VKFence.h"
+#include "Memory/VKDeviceMemoryManager.h"
+#include <thread>
+#include <mutex>
+#include <set>
+
+
+namespace LLGL
+{
+
+
+/*
+Dedicated transfer queue for the resource uploads of worker threads (see RenderSystem::AttachWorkerThread).
+Uploads are recorded into a separate staging ring on a queue family without graphics and compute capabilities,
+whose device memory is managed independently of the render thread. Each batch signals a timeline semaphore with its value,
+which the graphics and compute queues wait for on the GPU, so uploads never stall the submissions of the render thread.
+All resources are shared concurrently between the queue families, so no queue family ownership transfers are required.
+All functions are thread-safe.
+*/
+class VKTransferQueue
+{
+
+    public:
+
+        VKTransferQueue(
+            const VKPtr<VkDevice>& device,
+            VkQueue queue,
+            std::uint32_t queueFamilyIndex,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            VkDeviceSize ringSize
+        );
+
+        VKTransferQueue(const VKTransferQueue&) = delete;
+        VKTransferQueue& operator = (const VKTransferQueue&) = delete;
+
+        // Registers the calling thread as worker thread, whose uploads are recorded into this transfer queue.
+        void AttachWorkerThread();
+
+        // Submits all uploads and unregisters the calling thread.
+        void DetachWorkerThread();
+
+        // Returns true if the calling thread has been registered as worker thread.
+        bool IsWorkerThread();
+
+        // Copies the specified data into staging memory and records a copy command into the destination buffer.
+        void WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
+        // Records an upload into the specified subresource of an image, which is in shader-read-only layout before and after the upload.
+        void WriteImage(
+            VkImage                         dstImage,
+            const VkBufferImageCopy&        region,
+            const VkImageSubresourceRange&  subresourceRange,
+            const void*                     data,
+            VkDeviceSize                    dataSize
+        );
+
+        // Records the initialization of a new image, which is in undefined layout before and in shader-read-only layout after the upload. The data is optional.
+        void InitImage(
+            VkImage                         dstImage,
+            std::uint32_t                   numRegions,
+            const VkBufferImageCopy*        regions,
+            const VkImageSubresourceRange&  subresourceRange,
+            const void*                     data,
+            VkDeviceSize                    dataSize
+        );
+
+        // Submits all uploads and the specified fence to the transfer queue (see CommandQueue::Submit(Fence&)).
+        void Submit(Fence& fence);
+
+        // Submits all uploads and signals the specified timeline fence on the transfer queue (see CommandQueue::Signal).
+        void Signal(Fence& fence, std::uint64_t value);
+
+        // Submits all uploads and returns the value the timeline semaphore will be signaled with once they have been completed.
+        std::uint64_t Flush();
+
+        // Submits all uploads and blocks the CPU until they have been completed.
+        void WaitIdle();
+
+        // Returns the timeline semaphore that is signaled with the value of each submitted upload batch.
+        inline VkSemaphore GetTimelineSemaphore() const
+        {
+            return timelineSemaphore_;
+        }
+
+    private:
+
+        void RecordImageBarrier(
+            VkImage                         image,
+            VkImageLayout                   oldLayout,
+            VkImageLayout                   newLayout,
+            VkAccessFlags                   srcAccessMask,
+            VkAccessFlags                   dstAccessMask,
+            VkPipelineStageFlags            srcStageMask,
+            VkPipelineStageFlags            dstStageMask,
+            const VkImageSubresourceRange&  subresourceRange
+        );
+
+        std::mutex                  mutex_;                 // Guards the staging ring, the memory manager, and the queue
+        VKDeviceMemoryManager       deviceMemoryMngr_;      // Memory manager for large staging buffers, independent of the render thread
+        VKStagingRing               stagingRing_;
+        VKCommandQueue              commandQueue_;
+        VKFence                     timelineFence_;
+        VkSemaphore                 timelineSemaphore_      = VK_NULL_HANDLE;
+
+        std::mutex                  workerThreadsMutex_;
+        std::set<std::thread::id>   workerThreads_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
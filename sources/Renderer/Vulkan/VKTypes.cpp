@@ -35,6 +35,12 @@ VkShaderStageFlagBits Map(const ShaderType shaderType)
         case ShaderType::Geometry:          return VK_SHADER_STAGE_GEOMETRY_BIT;
         case ShaderType::Fragment:          return VK_SHADER_STAGE_FRAGMENT_BIT;
         case ShaderType::Compute:           return VK_SHADER_STAGE_COMPUTE_BIT;
+        #ifdef VK_EXT_mesh_shader
+        case ShaderType::Amplification:     return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case ShaderType::Mesh:              return VK_SHADER_STAGE_MESH_BIT_EXT;
+        #else
+        default:                            break;
+        #endif
     }
     MapFailed("ShaderType", "VkShaderStageFlagBits");
 }
@@ -119,6 +125,11 @@ VkFormat Map(const Format format)
         case Format::BGRA8SInt:         return VK_FORMAT_B8G8R8A8_SINT;
         case Format::BGRA8sRGB:         return VK_FORMAT_B8G8R8A8_SRGB;
 
+        /* --- Packed color formats --- */
+        case Format::RGB10A2UNorm:      return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+        case Format::RGB10A2UInt:       return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+        case Format::RG11B10Float:      return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+
         /* --- Depth-stencil formats --- */
         case Format::D16UNorm:          return VK_FORMAT_D16_UNORM;
         case Format::D32Float:          return VK_FORMAT_D32_SFLOAT;
@@ -130,6 +141,59 @@ VkFormat Map(const Format format)
         case Format::BC1RGBA:           return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
         case Format::BC2RGBA:           return VK_FORMAT_BC2_UNORM_BLOCK;
         case Format::BC3RGBA:           return VK_FORMAT_BC3_UNORM_BLOCK;
+        case Format::BC1RGBAsRGB:       return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case Format::BC2RGBAsRGB:       return VK_FORMAT_BC2_SRGB_BLOCK;
+        case Format::BC3RGBAsRGB:       return VK_FORMAT_BC3_SRGB_BLOCK;
+        case Format::BC4RUNorm:         return VK_FORMAT_BC4_UNORM_BLOCK;
+        case Format::BC4RSNorm:         return VK_FORMAT_BC4_SNORM_BLOCK;
+        case Format::BC5RGUNorm:        return VK_FORMAT_BC5_UNORM_BLOCK;
+        case Format::BC5RGSNorm:        return VK_FORMAT_BC5_SNORM_BLOCK;
+        case Format::BC6HRGBUFloat:     return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case Format::BC6HRGBSFloat:     return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case Format::BC7RGBAUNorm:      return VK_FORMAT_BC7_UNORM_BLOCK;
+        case Format::BC7RGBAsRGB:       return VK_FORMAT_BC7_SRGB_BLOCK;
+
+        /* --- ETC2/EAC compressed color formats --- */
+        case Format::ETC2RGB8UNorm:     return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+        case Format::ETC2RGB8sRGB:      return VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK;
+        case Format::ETC2RGB8A1UNorm:   return VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
+        case Format::ETC2RGB8A1sRGB:    return VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK;
+        case Format::ETC2RGBA8UNorm:    return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        case Format::ETC2RGBA8sRGB:     return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
+        case Format::EACR11UNorm:       return VK_FORMAT_EAC_R11_UNORM_BLOCK;
+        case Format::EACR11SNorm:       return VK_FORMAT_EAC_R11_SNORM_BLOCK;
+        case Format::EACRG11UNorm:      return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+        case Format::EACRG11SNorm:      return VK_FORMAT_EAC_R11G11_SNORM_BLOCK;
+
+        /* --- ASTC compressed color formats --- */
+        case Format::ASTC4x4UNorm:      return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        case Format::ASTC4x4sRGB:       return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+        case Format::ASTC5x4UNorm:      return VK_FORMAT_ASTC_5x4_UNORM_BLOCK;
+        case Format::ASTC5x4sRGB:       return VK_FORMAT_ASTC_5x4_SRGB_BLOCK;
+        case Format::ASTC5x5UNorm:      return VK_FORMAT_ASTC_5x5_UNORM_BLOCK;
+        case Format::ASTC5x5sRGB:       return VK_FORMAT_ASTC_5x5_SRGB_BLOCK;
+        case Format::ASTC6x5UNorm:      return VK_FORMAT_ASTC_6x5_UNORM_BLOCK;
+        case Format::ASTC6x5sRGB:       return VK_FORMAT_ASTC_6x5_SRGB_BLOCK;
+        case Format::ASTC6x6UNorm:      return VK_FORMAT_ASTC_6x6_UNORM_BLOCK;
+        case Format::ASTC6x6sRGB:       return VK_FORMAT_ASTC_6x6_SRGB_BLOCK;
+        case Format::ASTC8x5UNorm:      return VK_FORMAT_ASTC_8x5_UNORM_BLOCK;
+        case Format::ASTC8x5sRGB:       return VK_FORMAT_ASTC_8x5_SRGB_BLOCK;
+        case Format::ASTC8x6UNorm:      return VK_FORMAT_ASTC_8x6_UNORM_BLOCK;
+        case Format::ASTC8x6sRGB:       return VK_FORMAT_ASTC_8x6_SRGB_BLOCK;
+        case Format::ASTC8x8UNorm:      return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
+        case Format::ASTC8x8sRGB:       return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
+        case Format::ASTC10x5UNorm:     return VK_FORMAT_ASTC_10x5_UNORM_BLOCK;
+        case Format::ASTC10x5sRGB:      return VK_FORMAT_ASTC_10x5_SRGB_BLOCK;
+        case Format::ASTC10x6UNorm:     return VK_FORMAT_ASTC_10x6_UNORM_BLOCK;
+        case Format::ASTC10x6sRGB:      return VK_FORMAT_ASTC_10x6_SRGB_BLOCK;
+        case Format::ASTC10x8UNorm:     return VK_FORMAT_ASTC_10x8_UNORM_BLOCK;
+        case Format::ASTC10x8sRGB:      return VK_FORMAT_ASTC_10x8_SRGB_BLOCK;
+        case Format::ASTC10x10UNorm:    return VK_FORMAT_ASTC_10x10_UNORM_BLOCK;
+        case Format::ASTC10x10sRGB:     return VK_FORMAT_ASTC_10x10_SRGB_BLOCK;
+        case Format::ASTC12x10UNorm:    return VK_FORMAT_ASTC_12x10_UNORM_BLOCK;
+        case Format::ASTC12x10sRGB:     return VK_FORMAT_ASTC_12x10_SRGB_BLOCK;
+        case Format::ASTC12x12UNorm:    return VK_FORMAT_ASTC_12x12_UNORM_BLOCK;
+        case Format::ASTC12x12sRGB:     return VK_FORMAT_ASTC_12x12_SRGB_BLOCK;
     }
     MapFailed("Format", "VkFormat");
 }
@@ -308,10 +372,14 @@ VkDescriptorType Map(ResourceType resourceViewType)
 {
     switch (resourceViewType)
     {
-        case ResourceType::Sampler:         return VK_DESCRIPTOR_TYPE_SAMPLER;
-        case ResourceType::Texture:         return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-        case ResourceType::ConstantBuffer:  return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        case ResourceType::StorageBuffer:   return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case ResourceType::Sampler:                 return VK_DESCRIPTOR_TYPE_SAMPLER;
+        case ResourceType::Texture:                 return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        case ResourceType::ConstantBuffer:          return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        case ResourceType::StorageBuffer:           return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        #ifdef VK_KHR_acceleration_structure
+        case ResourceType::AccelerationStructure:   return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        #endif
+        default:                                    break;
     }
     MapFailed("LayoutBindingType", "VkDescriptorType");
 }
@@ -331,6 +399,31 @@ VkQueryType Map(const QueryType queryType)
     MapFailed("QueryType", "VkQueryType");
 }
 
+VkComponentSwizzle Map(const TextureSwizzle textureSwizzle)
+{
+    switch (textureSwizzle)
+    {
+        case TextureSwizzle::Zero:  return VK_COMPONENT_SWIZZLE_ZERO;
+        case TextureSwizzle::One:   return VK_COMPONENT_SWIZZLE_ONE;
+        case TextureSwizzle::Red:   return VK_COMPONENT_SWIZZLE_R;
+        case TextureSwizzle::Green: return VK_COMPONENT_SWIZZLE_G;
+        case TextureSwizzle::Blue:  return VK_COMPONENT_SWIZZLE_B;
+        case TextureSwizzle::Alpha: return VK_COMPONENT_SWIZZLE_A;
+    }
+    MapFailed("TextureSwizzle", "VkComponentSwizzle");
+}
+
+VkIndexType Map(const DataType indexType)
+{
+    switch (indexType)
+    {
+        case DataType::UInt16:  return VK_INDEX_TYPE_UINT16;
+        case DataType::UInt32:  return VK_INDEX_TYPE_UINT32;
+        default:                break;
+    }
+    MapFailed("DataType", "VkIndexType");
+}
+
 Format Unmap(const VkFormat format)
 {
     switch (format)
@@ -409,6 +502,11 @@ Format Unmap(const VkFormat format)
         case VK_FORMAT_B8G8R8A8_SINT:           return Format::BGRA8SInt;
         case VK_FORMAT_B8G8R8A8_SRGB:           return Format::BGRA8sRGB;
 
+        /* --- Packed color formats --- */
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:    return Format::RGB10A2UNorm;
+        case VK_FORMAT_A2B10G10R10_UINT_PACK32:     return Format::RGB10A2UInt;
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:     return Format::RG11B10Float;
+
         /* --- Depth-stencil formats --- */
         case VK_FORMAT_D16_UNORM:               return Format::D16UNorm;
         case VK_FORMAT_D32_SFLOAT:              return Format::D32Float;
@@ -416,10 +514,63 @@ Format Unmap(const VkFormat format)
         case VK_FORMAT_D32_SFLOAT_S8_UINT:      return Format::D32FloatS8X24UInt;
 
         /* --- Compressed color formats --- */
-        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:     return Format::BC1RGB;
-        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:    return Format::BC1RGBA;
-        case VK_FORMAT_BC2_UNORM_BLOCK:         return Format::BC2RGBA;
-        case VK_FORMAT_BC3_UNORM_BLOCK:         return Format::BC3RGBA;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:          return Format::BC1RGB;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:         return Format::BC1RGBA;
+        case VK_FORMAT_BC2_UNORM_BLOCK:              return Format::BC2RGBA;
+        case VK_FORMAT_BC3_UNORM_BLOCK:              return Format::BC3RGBA;
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:          return Format::BC1RGBAsRGB;
+        case VK_FORMAT_BC2_SRGB_BLOCK:               return Format::BC2RGBAsRGB;
+        case VK_FORMAT_BC3_SRGB_BLOCK:               return Format::BC3RGBAsRGB;
+        case VK_FORMAT_BC4_UNORM_BLOCK:              return Format::BC4RUNorm;
+        case VK_FORMAT_BC4_SNORM_BLOCK:              return Format::BC4RSNorm;
+        case VK_FORMAT_BC5_UNORM_BLOCK:              return Format::BC5RGUNorm;
+        case VK_FORMAT_BC5_SNORM_BLOCK:              return Format::BC5RGSNorm;
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:            return Format::BC6HRGBUFloat;
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:            return Format::BC6HRGBSFloat;
+        case VK_FORMAT_BC7_UNORM_BLOCK:              return Format::BC7RGBAUNorm;
+        case VK_FORMAT_BC7_SRGB_BLOCK:               return Format::BC7RGBAsRGB;
+
+        /* --- ETC2/EAC compressed color formats --- */
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:      return Format::ETC2RGB8UNorm;
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:       return Format::ETC2RGB8sRGB;
+        case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:    return Format::ETC2RGB8A1UNorm;
+        case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:     return Format::ETC2RGB8A1sRGB;
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:    return Format::ETC2RGBA8UNorm;
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:     return Format::ETC2RGBA8sRGB;
+        case VK_FORMAT_EAC_R11_UNORM_BLOCK:          return Format::EACR11UNorm;
+        case VK_FORMAT_EAC_R11_SNORM_BLOCK:          return Format::EACR11SNorm;
+        case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:       return Format::EACRG11UNorm;
+        case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:       return Format::EACRG11SNorm;
+
+        /* --- ASTC compressed color formats --- */
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:         return Format::ASTC4x4UNorm;
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:          return Format::ASTC4x4sRGB;
+        case VK_FORMAT_ASTC_5x4_UNORM_BLOCK:         return Format::ASTC5x4UNorm;
+        case VK_FORMAT_ASTC_5x4_SRGB_BLOCK:          return Format::ASTC5x4sRGB;
+        case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:         return Format::ASTC5x5UNorm;
+        case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:          return Format::ASTC5x5sRGB;
+        case VK_FORMAT_ASTC_6x5_UNORM_BLOCK:         return Format::ASTC6x5UNorm;
+        case VK_FORMAT_ASTC_6x5_SRGB_BLOCK:          return Format::ASTC6x5sRGB;
+        case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:         return Format::ASTC6x6UNorm;
+        case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:          return Format::ASTC6x6sRGB;
+        case VK_FORMAT_ASTC_8x5_UNORM_BLOCK:         return Format::ASTC8x5UNorm;
+        case VK_FORMAT_ASTC_8x5_SRGB_BLOCK:          return Format::ASTC8x5sRGB;
+        case VK_FORMAT_ASTC_8x6_UNORM_BLOCK:         return Format::ASTC8x6UNorm;
+        case VK_FORMAT_ASTC_8x6_SRGB_BLOCK:          return Format::ASTC8x6sRGB;
+        case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:         return Format::ASTC8x8UNorm;
+        case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:          return Format::ASTC8x8sRGB;
+        case VK_FORMAT_ASTC_10x5_UNORM_BLOCK:        return Format::ASTC10x5UNorm;
+        case VK_FORMAT_ASTC_10x5_SRGB_BLOCK:         return Format::ASTC10x5sRGB;
+        case VK_FORMAT_ASTC_10x6_UNORM_BLOCK:        return Format::ASTC10x6UNorm;
+        case VK_FORMAT_ASTC_10x6_SRGB_BLOCK:         return Format::ASTC10x6sRGB;
+        case VK_FORMAT_ASTC_10x8_UNORM_BLOCK:        return Format::ASTC10x8UNorm;
+        case VK_FORMAT_ASTC_10x8_SRGB_BLOCK:         return Format::ASTC10x8sRGB;
+        case VK_FORMAT_ASTC_10x10_UNORM_BLOCK:       return Format::ASTC10x10UNorm;
+        case VK_FORMAT_ASTC_10x10_SRGB_BLOCK:        return Format::ASTC10x10sRGB;
+        case VK_FORMAT_ASTC_12x10_UNORM_BLOCK:       return Format::ASTC12x10UNorm;
+        case VK_FORMAT_ASTC_12x10_SRGB_BLOCK:        return Format::ASTC12x10sRGB;
+        case VK_FORMAT_ASTC_12x12_UNORM_BLOCK:       return Format::ASTC12x12UNorm;
+        case VK_FORMAT_ASTC_12x12_SRGB_BLOCK:        return Format::ASTC12x12sRGB;
 
         default:                                return Format::Undefined;
     }
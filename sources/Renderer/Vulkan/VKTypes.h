@@ -15,6 +15,7 @@
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/GraphicsPipelineFlags.h>
 #include <LLGL/Format.h>
+#include <LLGL/TextureFlags.h>
 #include <LLGL/SamplerFlags.h>
 #include <LLGL/QueryFlags.h>
 
@@ -45,6 +46,8 @@ VkBlendOp               Map( const BlendArithmetic      blendArithmetic   );
 VkSamplerAddressMode    Map( const SamplerAddressMode   addressMode       );
 VkDescriptorType        Map( const ResourceType         resourceViewType  );
 VkQueryType             Map( const QueryType            queryType         );
+VkComponentSwizzle      Map( const TextureSwizzle       textureSwizzle    );
+VkIndexType             Map( const DataType             indexType         );
 
 Format                  Unmap( const VkFormat format );
 
@@ -0,0 +1,199 @@
+/*
+ * Test10_SceneBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/SceneBuffer.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <vector>
+
+
+struct Element
+{
+    std::uint32_t id;
+    std::uint32_t value[3];
+};
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error("check failed: " + message);
+}
+
+static Element MakeElement(std::uint32_t id, std::uint32_t value)
+{
+    return Element { id, { value, value + 1, value + 2 } };
+}
+
+// Writes the specified element into the scene buffer and into the expected CPU copy.
+static void WriteElement(LLGL::SceneBuffer& sceneBuffer, std::vector<Element>& expected, std::uint32_t index, std::uint32_t value)
+{
+    expected[index] = MakeElement(index, value);
+    sceneBuffer.WriteElements(index, 1, &expected[index]);
+}
+
+// Reads the GPU buffer back and compares it with the expected elements.
+static void CheckBufferContent(LLGL::RenderSystem& renderer, LLGL::SceneBuffer& sceneBuffer, const std::vector<Element>& expected, const std::string& message)
+{
+    renderer.GetCommandQueue()->WaitIdle();
+
+    auto mappedBuffer = renderer.MapBuffer(sceneBuffer.GetBuffer(), LLGL::CPUAccess::ReadOnly);
+    Check(mappedBuffer != nullptr, message + ": map buffer");
+
+    const bool equal = (std::memcmp(mappedBuffer, expected.data(), expected.size() * sizeof(Element)) == 0);
+    renderer.UnmapBuffer(sceneBuffer.GetBuffer());
+
+    Check(equal, message + ": buffer content");
+}
+
+void Test_DirtyRanges(LLGL::RenderSystem& renderer)
+{
+    const std::uint32_t numElements = 64;
+
+    std::vector<Element> expected(numElements);
+    for (std::uint32_t i = 0; i < numElements; ++i)
+        expected[i] = MakeElement(i, i * 10);
+
+    LLGL::SceneBufferDescriptor sceneDesc;
+    {
+        sceneDesc.buffer.type   = LLGL::BufferType::Storage;
+        sceneDesc.buffer.size   = sizeof(Element) * numElements;
+        sceneDesc.buffer.flags  = LLGL::BufferFlags::MapReadAccess;
+        sceneDesc.elementSize   = sizeof(Element);
+        sceneDesc.mergeDistance = 4;
+    }
+    LLGL::SceneBuffer sceneBuffer { renderer, sceneDesc, expected.data() };
+
+    Check(sceneBuffer.GetNumElements() == numElements, "number of elements");
+    Check(!sceneBuffer.IsDirty(), "initially clean");
+    Check(sceneBuffer.Flush() == 0, "flush without changes");
+    CheckBufferContent(renderer, sceneBuffer, expected, "initial data");
+
+    /* Ranges within the merge distance are uploaded together with the clean elements between them: [2, 8) */
+    WriteElement(sceneBuffer, expected, 2, 1000);
+    WriteElement(sceneBuffer, expected, 7, 1001);
+    Check(sceneBuffer.IsDirty(), "dirty after write");
+    Check(sceneBuffer.Flush() == 6 * sizeof(Element), "merge nearby ranges");
+    Check(!sceneBuffer.IsDirty(), "clean after flush");
+    CheckBufferContent(renderer, sceneBuffer, expected, "nearby ranges");
+
+    /* Ranges beyond the merge distance are uploaded separately: [10, 11) and [20, 21) */
+    WriteElement(sceneBuffer, expected, 10, 1002);
+    WriteElement(sceneBuffer, expected, 20, 1003);
+    Check(sceneBuffer.Flush() == 2 * sizeof(Element), "keep distant ranges apart");
+    CheckBufferContent(renderer, sceneBuffer, expected, "distant ranges");
+
+    /* Unsorted and overlapping writes: [30, 36) and [50, 52) */
+    WriteElement(sceneBuffer, expected, 50, 1004);
+    WriteElement(sceneBuffer, expected, 33, 1005);
+    WriteElement(sceneBuffer, expected, 30, 1006);
+    WriteElement(sceneBuffer, expected, 51, 1007);
+    WriteElement(sceneBuffer, expected, 35, 1008);
+    WriteElement(sceneBuffer, expected, 33, 1009);
+    Check(sceneBuffer.Flush() == 8 * sizeof(Element), "merge unsorted and overlapping ranges");
+    CheckBufferContent(renderer, sceneBuffer, expected, "unsorted ranges");
+
+    /* Sequential writes extend a single range, and mapped elements are marked dirty: [60, 64) */
+    for (std::uint32_t i = 60; i < 63; ++i)
+        WriteElement(sceneBuffer, expected, i, 2000 + i);
+
+    expected[63] = MakeElement(63, 3000);
+    auto mapped = reinterpret_cast<Element*>(sceneBuffer.MapElements(63, 1));
+    *mapped = expected[63];
+
+    Check(sceneBuffer.Flush() == 4 * sizeof(Element), "sequential and mapped writes");
+    CheckBufferContent(renderer, sceneBuffer, expected, "sequential and mapped writes");
+
+    /* Empty writes do not mark anything dirty */
+    sceneBuffer.WriteElements(10, 0, &expected[10]);
+    Check(!sceneBuffer.IsDirty(), "empty write");
+
+    std::cout << "scene buffer dirty ranges: ok" << std::endl;
+}
+
+void Test_InvalidArguments(LLGL::RenderSystem& renderer)
+{
+    LLGL::SceneBufferDescriptor sceneDesc;
+    {
+        sceneDesc.buffer.type   = LLGL::BufferType::Storage;
+        sceneDesc.buffer.size   = sizeof(Element) * 8;
+        sceneDesc.elementSize   = sizeof(Element);
+    }
+    LLGL::SceneBuffer sceneBuffer { renderer, sceneDesc };
+
+    auto IsOutOfRange = [&sceneBuffer](std::uint32_t firstElement, std::uint32_t numElements) -> bool
+    {
+        try
+        {
+            sceneBuffer.MapElements(firstElement, numElements);
+        }
+        catch (const std::out_of_range&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    Check(IsOutOfRange(8, 1), "element after the end");
+    Check(IsOutOfRange(4, 5), "range across the end");
+    Check(IsOutOfRange(1, UINT32_MAX), "range with overflowing end");
+    Check(!sceneBuffer.IsDirty(), "failed writes do not mark anything dirty");
+
+    auto IsInvalidDesc = [&renderer](std::uint64_t size, std::uint32_t elementSize) -> bool
+    {
+        LLGL::SceneBufferDescriptor desc;
+        {
+            desc.buffer.type    = LLGL::BufferType::Storage;
+            desc.buffer.size    = size;
+            desc.elementSize    = elementSize;
+        }
+        try
+        {
+            LLGL::SceneBuffer invalidSceneBuffer { renderer, desc };
+        }
+        catch (const std::invalid_argument&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    Check(IsInvalidDesc(64, 0), "zero element size");
+    Check(IsInvalidDesc(0, 16), "zero buffer size");
+    Check(IsInvalidDesc(60, 16), "buffer size not a multiple of the element size");
+
+    std::cout << "scene buffer invalid arguments: ok" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module
+        auto renderer = LLGL::RenderSystem::Load(argc > 1 ? argv[1] : "OpenGL");
+
+        // Create render context, since some renderers (e.g. OpenGL) cannot create any buffer without one
+        LLGL::RenderContextDescriptor contextDesc;
+        contextDesc.videoMode.resolution = { 320, 240 };
+
+        renderer->CreateRenderContext(contextDesc);
+
+        Test_DirtyRanges(*renderer);
+        Test_InvalidArguments(*renderer);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        #ifdef _WIN32
+        system("pause");
+        #endif
+        return 1;
+    }
+    return 0;
+}
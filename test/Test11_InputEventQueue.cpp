@@ -0,0 +1,230 @@
+/*
+ * Test11_InputEventQueue.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/InputEventQueue.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <memory>
+
+
+// Window without a native counterpart, which only forwards the posted events to its listeners.
+class TestWindow : public LLGL::Window
+{
+
+    public:
+
+        void GetNativeHandle(void* nativeHandle) const override {}
+
+        LLGL::Extent2D GetContentSize() const override { return {}; }
+
+        bool AdaptForVideoMode(LLGL::VideoModeDescriptor& videoModeDesc) override { return false; }
+
+        void Recreate() override {}
+
+        void SetPosition(const LLGL::Offset2D& position) override {}
+
+        LLGL::Offset2D GetPosition() const override { return {}; }
+
+        void SetSize(const LLGL::Extent2D& size, bool useClientArea = true) override {}
+
+        LLGL::Extent2D GetSize(bool useClientArea = true) const override { return {}; }
+
+        void SetTitle(const std::wstring& title) override {}
+
+        std::wstring GetTitle() const override { return L""; }
+
+        void Show(bool show = true) override {}
+
+        bool IsShown() const override { return false; }
+
+        void SetDesc(const LLGL::WindowDescriptor& desc) override {}
+
+        LLGL::WindowDescriptor GetDesc() const override { return {}; }
+
+    protected:
+
+        void OnProcessEvents() override {}
+
+};
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error("check failed: " + message);
+}
+
+static LLGL::InputEvent PopEvent(LLGL::InputEventQueue& queue, LLGL::Window& sender, LLGL::InputEventType type, const std::string& message)
+{
+    LLGL::InputEvent event;
+    Check(queue.Pop(event), message + ": pop event");
+    Check(event.type == type, message + ": event type");
+    Check(event.sender == &sender, message + ": event sender");
+    return event;
+}
+
+void Test_Capacity()
+{
+    Check(LLGL::InputEventQueue{}.GetCapacity() == 1024, "default capacity");
+    Check(LLGL::InputEventQueue{ 0 }.GetCapacity() == 2, "minimal capacity");
+    Check(LLGL::InputEventQueue{ 16 }.GetCapacity() == 16, "power of two capacity");
+    Check(LLGL::InputEventQueue{ 17 }.GetCapacity() == 32, "rounded up capacity");
+
+    std::cout << "input event queue capacity: ok" << std::endl;
+}
+
+void Test_EventPayloads()
+{
+    using LLGL::InputEventType;
+
+    TestWindow window;
+    auto queue = std::make_shared<LLGL::InputEventQueue>(16);
+    window.AddEventListener(queue);
+
+    LLGL::InputEvent event;
+    Check(!queue->Pop(event), "pop from empty queue");
+
+    window.PostKeyDown(LLGL::Key::A);
+    window.PostKeyUp(LLGL::Key::Escape);
+    window.PostDoubleClick(LLGL::Key::LButton);
+    window.PostChar(L'x');
+    window.PostWheelMotion(-3);
+    window.PostLocalMotion({ 12, 34 });
+    window.PostGlobalMotion({ -5, 7 });
+    window.PostResize({ 640, 480 });
+    window.PostGetFocus();
+    window.PostLoseFocus();
+
+    /* Events must be popped in the same order they have been posted */
+    std::uint64_t prevTimestamp = 0;
+
+    auto PopNext = [&](InputEventType type, const std::string& message) -> LLGL::InputEvent
+    {
+        auto event = PopEvent(*queue, window, type, message);
+        Check(event.timestamp >= prevTimestamp, message + ": monotonic timestamp");
+        prevTimestamp = event.timestamp;
+        return event;
+    };
+
+    Check(PopNext(InputEventType::KeyDown, "key down").keyCode == LLGL::Key::A, "key down: key code");
+    Check(PopNext(InputEventType::KeyUp, "key up").keyCode == LLGL::Key::Escape, "key up: key code");
+    Check(PopNext(InputEventType::DoubleClick, "double click").keyCode == LLGL::Key::LButton, "double click: key code");
+    Check(PopNext(InputEventType::Char, "char").chr == L'x', "char: character");
+    Check(PopNext(InputEventType::WheelMotion, "wheel motion").wheelMotion == -3, "wheel motion: motion");
+
+    event = PopNext(InputEventType::LocalMotion, "local motion");
+    Check(event.offset.x == 12 && event.offset.y == 34, "local motion: position");
+
+    event = PopNext(InputEventType::GlobalMotion, "global motion");
+    Check(event.offset.x == -5 && event.offset.y == 7, "global motion: motion");
+
+    event = PopNext(InputEventType::Resize, "resize");
+    Check(event.size.width == 640 && event.size.height == 480, "resize: size");
+
+    PopNext(InputEventType::GetFocus, "get focus");
+    PopNext(InputEventType::LoseFocus, "lose focus");
+
+    Check(!queue->Pop(event), "pop after all events");
+    Check(queue->GetNumDroppedEvents() == 0, "no dropped events");
+
+    std::cout << "input event queue payloads: ok" << std::endl;
+}
+
+void Test_DroppedEvents()
+{
+    TestWindow window;
+    auto queue = std::make_shared<LLGL::InputEventQueue>(4);
+    window.AddEventListener(queue);
+
+    /* Only the first four events fit into the queue, the newer ones are dropped */
+    for (int i = 0; i < 7; ++i)
+        window.PostWheelMotion(i);
+
+    Check(queue->GetNumDroppedEvents() == 3, "number of dropped events");
+
+    LLGL::InputEvent event;
+    for (int i = 0; i < 4; ++i)
+    {
+        event = PopEvent(*queue, window, LLGL::InputEventType::WheelMotion, "full queue");
+        Check(event.wheelMotion == i, "full queue: oldest events are kept");
+    }
+    Check(!queue->Pop(event), "full queue: pop after all events");
+
+    /* Popped slots can be reused */
+    window.PostWheelMotion(100);
+    event = PopEvent(*queue, window, LLGL::InputEventType::WheelMotion, "reused slot");
+    Check(event.wheelMotion == 100, "reused slot: motion");
+    Check(queue->GetNumDroppedEvents() == 3, "reused slot: no additional dropped events");
+
+    std::cout << "input event queue dropped events: ok" << std::endl;
+}
+
+void Test_ProducerConsumer()
+{
+    const int numEvents = 200000;
+
+    TestWindow window;
+    auto queue = std::make_shared<LLGL::InputEventQueue>(64);
+    window.AddEventListener(queue);
+
+    /* Producer thread posts sequential motions while the main thread consumes them */
+    std::thread producer(
+        [&window]()
+        {
+            for (int i = 0; i < numEvents; ++i)
+                window.PostWheelMotion(i);
+        }
+    );
+
+    int numReceived = 0, prevMotion = -1;
+    bool ordered = true;
+
+    auto ConsumeEvents = [&]()
+    {
+        LLGL::InputEvent event;
+        while (queue->Pop(event))
+        {
+            if (event.type != LLGL::InputEventType::WheelMotion || event.wheelMotion <= prevMotion)
+                ordered = false;
+            prevMotion = event.wheelMotion;
+            ++numReceived;
+        }
+    };
+
+    while (static_cast<std::uint64_t>(numReceived) + queue->GetNumDroppedEvents() < static_cast<std::uint64_t>(numEvents))
+        ConsumeEvents();
+
+    producer.join();
+    ConsumeEvents();
+
+    /* Dropped events may leave gaps, but every received event must be in order and nothing may get lost */
+    Check(ordered, "concurrent events in order");
+    Check(static_cast<std::uint64_t>(numReceived) + queue->GetNumDroppedEvents() == static_cast<std::uint64_t>(numEvents), "concurrent events received or dropped");
+
+    std::cout << "input event queue producer/consumer: ok" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        Test_Capacity();
+        Test_EventPayloads();
+        Test_DroppedEvents();
+        Test_ProducerConsumer();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        #ifdef _WIN32
+        system("pause");
+        #endif
+        return 1;
+    }
+    return 0;
+}
@@ -6,7 +6,18 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/TextureFlags.h>
+#include "../sources/Core/Float16Compressor.h"
 #include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <limits>
+#include <cmath>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,13 +119,558 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+void Test_ConvertBenchmarkEntry(LLGL::ImageFormat srcFormat, LLGL::DataType srcDataType, LLGL::ImageFormat dstFormat, LLGL::DataType dstDataType, const char* name)
+{
+    const std::size_t numPixels = 2048*2048;
+    const int numIterations = 10;
+
+    std::vector<char> srcBuffer(numPixels * LLGL::ImageFormatSize(srcFormat) * LLGL::DataTypeSize(srcDataType), 0);
+    std::vector<char> dstBuffer(numPixels * LLGL::ImageFormatSize(dstFormat) * LLGL::DataTypeSize(dstDataType), 0);
+
+    LLGL::SrcImageDescriptor srcDesc { srcFormat, srcDataType, srcBuffer.data(), srcBuffer.size() };
+    LLGL::DstImageDescriptor dstDesc { dstFormat, dstDataType, dstBuffer.data(), dstBuffer.size() };
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < numIterations; ++i)
+        LLGL::ConvertImageBuffer(srcDesc, dstDesc, 1);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    auto megaBytes = static_cast<double>(srcBuffer.size() * numIterations) / (1024.0 * 1024.0);
+
+    std::cout << name << ": " << (megaBytes / seconds) << " MB/s" << std::endl;
+}
+
+void Test_ConvertBenchmark()
+{
+    using LLGL::ImageFormat;
+    using LLGL::DataType;
+
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::UInt8,   ImageFormat::RGBA, DataType::Float32, "UInt8   -> Float32");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::UInt8,   "Float32 -> UInt8  ");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::UInt16,  ImageFormat::RGBA, DataType::Float32, "UInt16  -> Float32");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::UInt16,  "Float32 -> UInt16 ");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::Float16, ImageFormat::RGBA, DataType::Float32, "Float16 -> Float32");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::Float16, "Float32 -> Float16");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGB,  DataType::UInt8,   ImageFormat::RGBA, DataType::UInt8,   "RGB     -> RGBA   ");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGB,  DataType::UInt8,   ImageFormat::BGRA, DataType::UInt8,   "RGB     -> BGRA   ");
+    Test_ConvertBenchmarkEntry(ImageFormat::RGBA, DataType::UInt8,   ImageFormat::BGRA, DataType::UInt8,   "RGBA    -> BGRA   ");
+}
+
+// Fills the buffer with random values of the specified data type (floating-point values are kept in the range [0, 1], so the conversions are exact in both paths).
+void FillRandomImageData(std::vector<char>& buffer, LLGL::DataType dataType, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<int> unormDist(0, 65535);
+
+    switch (dataType)
+    {
+        case LLGL::DataType::Float32:
+        {
+            auto values = reinterpret_cast<float*>(buffer.data());
+            for (std::size_t i = 0; i < buffer.size() / sizeof(float); ++i)
+                values[i] = static_cast<float>(unormDist(rng)) / 65535.0f;
+        }
+        break;
+
+        case LLGL::DataType::Float16:
+        {
+            /* Sign bit cleared and exponent below 15 (i.e. values in the range [0, 1)), which excludes infinities and NaNs */
+            auto values = reinterpret_cast<std::uint16_t*>(buffer.data());
+            for (std::size_t i = 0; i < buffer.size() / sizeof(std::uint16_t); ++i)
+                values[i] = static_cast<std::uint16_t>(unormDist(rng) % 0x3C00);
+        }
+        break;
+
+        default:
+        {
+            for (auto& byte : buffer)
+                byte = static_cast<char>(byteDist(rng));
+        }
+        break;
+    }
+}
+
+/*
+Compares the output of ConvertImageBuffer against a reference that is converted one element at a time.
+Single components (or single pixels if the formats differ) are too small for any vectorized kernel,
+so the reference only runs through the scalar paths, while the full conversion uses the SIMD kernels for all but the tails.
+*/
+void Test_ConvertSIMDEntry(LLGL::ImageFormat srcFormat, LLGL::DataType srcDataType, LLGL::ImageFormat dstFormat, LLGL::DataType dstDataType, const char* name)
+{
+    std::mt19937 rng { 1234 };
+
+    const std::size_t srcPixelSize  = LLGL::ImageFormatSize(srcFormat) * LLGL::DataTypeSize(srcDataType);
+    const std::size_t dstPixelSize  = LLGL::ImageFormatSize(dstFormat) * LLGL::DataTypeSize(dstDataType);
+
+    /* Odd sizes, so every thread ends with a scalar tail */
+    for (std::size_t numPixels : { 1u, 7u, 33u, 1021u })
+    {
+        std::vector<char> srcBuffer(numPixels * srcPixelSize);
+        FillRandomImageData(srcBuffer, srcDataType, rng);
+
+        /* Convert reference one element at a time */
+        std::vector<char> refBuffer(numPixels * dstPixelSize);
+
+        const bool perComponent = (srcFormat == dstFormat);
+        const auto elemFormat   = (perComponent ? LLGL::ImageFormat::R : srcFormat);
+        const auto numElements  = (perComponent ? numPixels * LLGL::ImageFormatSize(srcFormat) : numPixels);
+        const auto srcElemSize  = (perComponent ? LLGL::DataTypeSize(srcDataType) : srcPixelSize);
+        const auto dstElemSize  = (perComponent ? LLGL::DataTypeSize(dstDataType) : dstPixelSize);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            LLGL::SrcImageDescriptor srcDesc { elemFormat, srcDataType, &srcBuffer[i * srcElemSize], srcElemSize };
+            LLGL::DstImageDescriptor dstDesc { (perComponent ? elemFormat : dstFormat), dstDataType, &refBuffer[i * dstElemSize], dstElemSize };
+            LLGL::ConvertImageBuffer(srcDesc, dstDesc, 1);
+        }
+
+        /* Convert entire buffer with and without multi-threading */
+        for (std::size_t threadCount : { 1u, 3u })
+        {
+            std::vector<char> dstBuffer(numPixels * dstPixelSize);
+
+            LLGL::SrcImageDescriptor srcDesc { srcFormat, srcDataType, srcBuffer.data(), srcBuffer.size() };
+            LLGL::DstImageDescriptor dstDesc { dstFormat, dstDataType, dstBuffer.data(), dstBuffer.size() };
+            LLGL::ConvertImageBuffer(srcDesc, dstDesc, threadCount);
+
+            if (std::memcmp(dstBuffer.data(), refBuffer.data(), dstBuffer.size()) != 0)
+            {
+                throw std::runtime_error(
+                    std::string(name) + ": SIMD and scalar conversion differ (" + std::to_string(numPixels) +
+                    " pixels, " + std::to_string(threadCount) + " threads)"
+                );
+            }
+        }
+    }
+
+    std::cout << name << ": ok" << std::endl;
+}
+
+void Test_ConvertSIMD()
+{
+    using LLGL::ImageFormat;
+    using LLGL::DataType;
+
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::UInt8,   ImageFormat::RGBA, DataType::Float32, "UInt8   -> Float32");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::UInt8,   "Float32 -> UInt8  ");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::UInt16,  ImageFormat::RGBA, DataType::Float32, "UInt16  -> Float32");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::UInt16,  "Float32 -> UInt16 ");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::Float16, ImageFormat::RGBA, DataType::Float32, "Float16 -> Float32");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::Float32, ImageFormat::RGBA, DataType::Float16, "Float32 -> Float16");
+    Test_ConvertSIMDEntry(ImageFormat::RGB,  DataType::UInt8,   ImageFormat::RGBA, DataType::UInt8,   "RGB     -> RGBA   ");
+    Test_ConvertSIMDEntry(ImageFormat::RGB,  DataType::UInt8,   ImageFormat::BGRA, DataType::UInt8,   "RGB     -> BGRA   ");
+    Test_ConvertSIMDEntry(ImageFormat::RGBA, DataType::UInt8,   ImageFormat::BGRA, DataType::UInt8,   "RGBA    -> BGRA   ");
+}
+
+// Returns true if the specified 16-bit float is a NaN, whose payload bits may differ between the vectorized and the scalar path.
+bool IsFloat16NaN(std::uint16_t value)
+{
+    return ((value & 0x7C00) == 0x7C00 && (value & 0x03FF) != 0);
+}
+
+void Test_Float16Array()
+{
+    /* Every 16-bit pattern, plus an odd tail so the scalar path runs after the vectorized one */
+    const std::size_t count = 65536 + 7;
+
+    std::vector<std::uint16_t> halves(count);
+    for (std::size_t i = 0; i < count; ++i)
+        halves[i] = static_cast<std::uint16_t>(i);
+
+    std::vector<float> floats(count);
+    LLGL::DecompressFloat16Array(halves.data(), floats.data(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float expected = LLGL::DecompressFloat16(halves[i]);
+        if (IsFloat16NaN(halves[i]) ? !std::isnan(floats[i]) : std::memcmp(&floats[i], &expected, sizeof(float)) != 0)
+            throw std::runtime_error("DecompressFloat16Array differs from DecompressFloat16 for bit pattern " + std::to_string(halves[i]));
+    }
+
+    /* Compress the exact values, values between them, and values outside the 16-bit range */
+    std::vector<float> inputs = floats;
+    for (std::size_t i = 0; i + 1 < 65536; ++i)
+        inputs.push_back(std::nextafter(floats[i], floats[i + 1]));
+
+    const float specials[] =
+    {
+        0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65519.0f, 65520.0f, 1.0e10f, -1.0e10f, 5.96e-8f, 2.98e-8f, 1.0e-30f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::max()
+    };
+    inputs.insert(inputs.end(), std::begin(specials), std::end(specials));
+
+    std::vector<std::uint16_t> compressed(inputs.size());
+    LLGL::CompressFloat16Array(inputs.data(), compressed.data(), inputs.size());
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        const auto expected = LLGL::CompressFloat16(inputs[i]);
+        if (IsFloat16NaN(expected) ? !IsFloat16NaN(compressed[i]) : compressed[i] != expected)
+            throw std::runtime_error("CompressFloat16Array differs from CompressFloat16 for input " + std::to_string(inputs[i]));
+    }
+
+    std::cout << "Float16 arrays: ok" << std::endl;
+}
+
+// Exact sRGB transfer functions in double precision.
+double ExactSRGBToLinear(double value)
+{
+    return (value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+}
+
+double ExactLinearToSRGB(double value)
+{
+    return (value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055);
+}
+
+void Test_SRGBConversion()
+{
+    /* Decode every 8-bit value as color and as alpha (257 pixels, so the last one ends in a scalar tail) */
+    const std::size_t numPixels = 257;
+
+    std::vector<std::uint8_t> srgb(numPixels * 4);
+    for (std::size_t i = 0; i < srgb.size(); ++i)
+        srgb[i] = static_cast<std::uint8_t>(i / 4);
+
+    std::vector<float> linear(srgb.size());
+    LLGL::DecodeSRGBImageBuffer(
+        LLGL::SrcImageDescriptor { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, srgb.data(), srgb.size() },
+        LLGL::DstImageDescriptor { LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, linear.data(), linear.size() * sizeof(float) }
+    );
+
+    for (std::size_t i = 0; i < srgb.size(); ++i)
+    {
+        const double value      = static_cast<double>(srgb[i]) / 255.0;
+        const double expected   = (i % 4 == 3 ? value : ExactSRGBToLinear(value));
+        if (std::abs(linear[i] - expected) > 1.0e-6)
+            throw std::runtime_error("DecodeSRGBImageBuffer is inexact for component " + std::to_string(i));
+    }
+
+    /* Decoding and encoding again must restore every 8-bit value */
+    std::vector<std::uint8_t> roundTrip(srgb.size());
+    LLGL::EncodeSRGBImageBuffer(
+        LLGL::SrcImageDescriptor { LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, linear.data(), linear.size() * sizeof(float) },
+        LLGL::DstImageDescriptor { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, roundTrip.data(), roundTrip.size() }
+    );
+
+    if (roundTrip != srgb)
+        throw std::runtime_error("EncodeSRGBImageBuffer does not restore the decoded sRGB values");
+
+    /* Encode a sweep of linear values including values outside [0, 1], which must be clamped */
+    const std::size_t numValues = 4099 * 3;
+
+    std::vector<float> sweep(numValues);
+    for (std::size_t i = 0; i < numValues; ++i)
+        sweep[i] = -0.1f + 1.2f * static_cast<float>(i) / static_cast<float>(numValues - 1);
+
+    for (std::size_t threadCount : { 1u, 3u })
+    {
+        std::vector<std::uint8_t> encoded(numValues);
+        LLGL::EncodeSRGBImageBuffer(
+            LLGL::SrcImageDescriptor { LLGL::ImageFormat::RGB, LLGL::DataType::Float32, sweep.data(), sweep.size() * sizeof(float) },
+            LLGL::DstImageDescriptor { LLGL::ImageFormat::RGB, LLGL::DataType::UInt8, encoded.data(), encoded.size() },
+            threadCount
+        );
+
+        for (std::size_t i = 0; i < numValues; ++i)
+        {
+            /* The vectorized approximation may differ by one step from the exact conversion */
+            const double clamped    = std::max(0.0, std::min(static_cast<double>(sweep[i]), 1.0));
+            const int expected      = static_cast<int>(ExactLinearToSRGB(clamped) * 255.0 + 0.5);
+            if (std::abs(static_cast<int>(encoded[i]) - expected) > 1)
+                throw std::runtime_error("EncodeSRGBImageBuffer differs by more than one step for input " + std::to_string(sweep[i]));
+        }
+    }
+
+    std::cout << "sRGB conversion: ok" << std::endl;
+}
+
+// Decodes an 8-byte BC1 color block into RGBA8 pixels (3-color mode with transparent black if color0 <= color1).
+void DecodeBC1Block(const std::uint8_t* src, std::uint8_t (&pixels)[16][4])
+{
+    const unsigned c0 = src[0] | (src[1] << 8);
+    const unsigned c1 = src[2] | (src[3] << 8);
+
+    int palette[4][4];
+    for (int i = 0; i < 2; ++i)
+    {
+        const unsigned c = (i == 0 ? c0 : c1);
+        const int r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        palette[i][0] = (r << 3) | (r >> 2);
+        palette[i][1] = (g << 2) | (g >> 4);
+        palette[i][2] = (b << 3) | (b >> 2);
+        palette[i][3] = 255;
+    }
+
+    for (int c = 0; c < 3; ++c)
+    {
+        if (c0 > c1)
+        {
+            palette[2][c] = (2*palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2*palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = (c0 > c1 ? 255 : 0);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int index = (src[4 + i/4] >> (2*(i % 4))) & 0x3;
+        for (int c = 0; c < 4; ++c)
+            pixels[i][c] = static_cast<std::uint8_t>(palette[index][c]);
+    }
+}
+
+// Decodes an 8-byte BC4 block into the specified channel of RGBA8 pixels.
+void DecodeBC4Block(const std::uint8_t* src, std::uint8_t (&pixels)[16][4], int channel)
+{
+    const int v0 = src[0], v1 = src[1];
+
+    int palette[8] = { v0, v1 };
+    for (int i = 1; i < 7; ++i)
+    {
+        if (v0 > v1)
+            palette[i + 1] = ((7 - i)*v0 + i*v1) / 7;
+        else if (i < 5)
+            palette[i + 1] = ((5 - i)*v0 + i*v1) / 5;
+    }
+    if (v0 <= v1)
+    {
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i)
+        bits |= (static_cast<std::uint64_t>(src[2 + i]) << (8*i));
+
+    for (int i = 0; i < 16; ++i)
+        pixels[i][channel] = static_cast<std::uint8_t>(palette[(bits >> (3*i)) & 0x7]);
+}
+
+// Decodes a 16-byte BC7 block into RGBA8 pixels (only mode 6, which is the only mode the encoder writes).
+void DecodeBC7Block(const std::uint8_t* src, std::uint8_t (&pixels)[16][4])
+{
+    std::size_t bitPos = 0;
+    auto ReadBits = [src, &bitPos](int numBits) -> int
+    {
+        int value = 0;
+        for (int i = 0; i < numBits; ++i, ++bitPos)
+            value |= ((src[bitPos / 8] >> (bitPos % 8)) & 0x1) << i;
+        return value;
+    };
+
+    if (ReadBits(7) != (1 << 6))
+        throw std::runtime_error("BC7 block is not encoded in mode 6");
+
+    int endpoints[2][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        endpoints[0][c] = ReadBits(7);
+        endpoints[1][c] = ReadBits(7);
+    }
+    for (int e = 0; e < 2; ++e)
+    {
+        const int pbit = ReadBits(1);
+        for (int c = 0; c < 4; ++c)
+            endpoints[e][c] = (endpoints[e][c] << 1) | pbit;
+    }
+
+    static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    for (int i = 0; i < 16; ++i)
+    {
+        const int index = ReadBits(i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c)
+            pixels[i][c] = static_cast<std::uint8_t>(((64 - weights[index])*endpoints[0][c] + weights[index]*endpoints[1][c] + 32) >> 6);
+    }
+}
+
+// Decodes the specified BC image into RGBA8 pixels (channels that are not stored by the format are set to 0, and alpha to 255).
+std::vector<std::uint8_t> DecodeBCImage(const std::uint8_t* src, LLGL::Format format, const LLGL::Extent3D& extent)
+{
+    std::vector<std::uint8_t> image(extent.width * extent.height * extent.depth * 4);
+
+    const std::uint32_t numBlocksX = (extent.width + 3) / 4;
+    const std::uint32_t numBlocksY = (extent.height + 3) / 4;
+
+    for (std::uint32_t z = 0; z < extent.depth; ++z)
+    {
+        for (std::uint32_t by = 0; by < numBlocksY; ++by)
+        {
+            for (std::uint32_t bx = 0; bx < numBlocksX; ++bx)
+            {
+                std::uint8_t pixels[16][4] = {};
+                for (auto& pixel : pixels)
+                    pixel[3] = 255;
+
+                switch (format)
+                {
+                    case LLGL::Format::BC1RGB:
+                    case LLGL::Format::BC1RGBA:
+                        DecodeBC1Block(src, pixels);
+                        break;
+                    case LLGL::Format::BC2RGBA:
+                        DecodeBC1Block(src + 8, pixels);
+                        for (int i = 0; i < 16; ++i)
+                            pixels[i][3] = static_cast<std::uint8_t>(((src[i/2] >> (4*(i % 2))) & 0xF) * 17);
+                        break;
+                    case LLGL::Format::BC3RGBA:
+                        DecodeBC1Block(src + 8, pixels);
+                        DecodeBC4Block(src, pixels, 3);
+                        break;
+                    case LLGL::Format::BC4RUNorm:
+                        DecodeBC4Block(src, pixels, 0);
+                        break;
+                    case LLGL::Format::BC5RGUNorm:
+                        DecodeBC4Block(src, pixels, 0);
+                        DecodeBC4Block(src + 8, pixels, 1);
+                        break;
+                    case LLGL::Format::BC7RGBAUNorm:
+                        DecodeBC7Block(src, pixels);
+                        break;
+                    default:
+                        throw std::runtime_error("cannot decode BC format");
+                }
+                src += LLGL::FormatBlockSize(format);
+
+                /* Write pixels that are inside the image */
+                for (std::uint32_t i = 0; i < 16; ++i)
+                {
+                    const auto x = bx*4 + i % 4;
+                    const auto y = by*4 + i / 4;
+                    if (x < extent.width && y < extent.height)
+                        std::copy(pixels[i], pixels[i] + 4, &image[((z*extent.height + y)*extent.width + x)*4]);
+                }
+            }
+        }
+    }
+
+    return image;
+}
+
+void Test_BCCompressionEntry(
+    LLGL::Format                        format,
+    const std::vector<std::uint8_t>&    image,
+    const LLGL::Extent3D&               extent,
+    int                                 numChannels,
+    double                              maxRMSE,
+    const char*                         name)
+{
+    LLGL::SrcImageDescriptor srcDesc { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), image.size() };
+
+    auto compressed = LLGL::CompressImageBuffer(srcDesc, extent, format, 1);
+    if (!compressed)
+        throw std::runtime_error(std::string(name) + ": compression returned no data");
+
+    /* Multi-threading must not change the output */
+    const auto bufferSize = LLGL::TextureBufferSize(format, extent);
+    auto compressedMT = LLGL::CompressImageBuffer(srcDesc, extent, format, 3);
+    if (std::memcmp(compressed.get(), compressedMT.get(), bufferSize) != 0)
+        throw std::runtime_error(std::string(name) + ": multi-threaded compression differs");
+
+    /* Compare decoded image against source image */
+    const auto decoded = DecodeBCImage(reinterpret_cast<const std::uint8_t*>(compressed.get()), format, extent);
+
+    double sumSqError = 0.0;
+    for (std::size_t i = 0; i < image.size(); ++i)
+    {
+        if (static_cast<int>(i % 4) < numChannels)
+        {
+            const double diff = static_cast<double>(decoded[i]) - static_cast<double>(image[i]);
+            sumSqError += diff * diff;
+        }
+    }
+
+    const double rmse = std::sqrt(sumSqError / static_cast<double>(image.size() / 4 * numChannels));
+    if (rmse > maxRMSE)
+        throw std::runtime_error(std::string(name) + ": RMSE " + std::to_string(rmse) + " exceeds " + std::to_string(maxRMSE));
+
+    std::cout << name << ": ok (RMSE " << rmse << ")" << std::endl;
+}
+
+void Test_BCCompression()
+{
+    using LLGL::Format;
+
+    /*
+    Gradients with some noise; the extent is not a multiple of 4, so the edge blocks are padded.
+    The error limits are slightly above the errors of the current encoder, so they catch regressions and broken blocks.
+    */
+    const LLGL::Extent3D extent { 29, 13, 2 };
+
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<int> noise(-4, 4);
+
+    std::vector<std::uint8_t> image(extent.width * extent.height * extent.depth * 4);
+    for (std::uint32_t z = 0; z < extent.depth; ++z)
+    {
+        for (std::uint32_t y = 0; y < extent.height; ++y)
+        {
+            for (std::uint32_t x = 0; x < extent.width; ++x)
+            {
+                const int base[4] =
+                {
+                    static_cast<int>(x * 255 / extent.width),
+                    static_cast<int>(y * 255 / extent.height),
+                    static_cast<int>(z * 128 + (x + y) * 2),
+                    static_cast<int>(255 - (x * y) % 256),
+                };
+                for (int c = 0; c < 4; ++c)
+                    image[((z*extent.height + y)*extent.width + x)*4 + c] = static_cast<std::uint8_t>(std::max(0, std::min(base[c] + noise(rng), 255)));
+            }
+        }
+    }
+
+    Test_BCCompressionEntry(Format::BC1RGB,       image, extent, 3, 7.0, "BC1RGB      ");
+    Test_BCCompressionEntry(Format::BC2RGBA,      image, extent, 4, 7.0, "BC2RGBA     ");
+    Test_BCCompressionEntry(Format::BC3RGBA,      image, extent, 4, 7.0, "BC3RGBA     ");
+    Test_BCCompressionEntry(Format::BC4RUNorm,    image, extent, 1, 2.0, "BC4RUNorm   ");
+    Test_BCCompressionEntry(Format::BC5RGUNorm,   image, extent, 2, 2.5, "BC5RGUNorm  ");
+    Test_BCCompressionEntry(Format::BC7RGBAUNorm, image, extent, 4, 7.0, "BC7RGBAUNorm");
+
+    /* Pixels with alpha below 128 must decode as transparent black in BC1 with alpha */
+    std::vector<std::uint8_t> cutout(image);
+    for (std::size_t i = 0; i < cutout.size(); i += 4)
+        cutout[i + 3] = ((i / 4) % 3 == 0 ? 0 : 255);
+
+    auto compressed = LLGL::CompressImageBuffer(
+        LLGL::SrcImageDescriptor { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, cutout.data(), cutout.size() },
+        extent,
+        Format::BC1RGBA
+    );
+    const auto decoded = DecodeBCImage(reinterpret_cast<const std::uint8_t*>(compressed.get()), Format::BC1RGBA, extent);
+
+    for (std::size_t i = 0; i < cutout.size(); i += 4)
+    {
+        const bool transparent = (cutout[i + 3] < 128);
+        if (transparent ? (decoded[i + 3] != 0) : (decoded[i + 3] != 255))
+            throw std::runtime_error("BC1RGBA: punch-through alpha is wrong for pixel " + std::to_string(i / 4));
+    }
+
+    std::cout << "BC1RGBA punch-through alpha: ok" << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     try
     {
         //Test_PixelOperations();
         //Test_Blit();
+        Test_ConvertSIMD();
+        Test_Float16Array();
+        Test_SRGBConversion();
+        Test_BCCompression();
         Test_Resize();
+        //Test_ConvertBenchmark();
     }
     catch (const std::exception& e)
     {
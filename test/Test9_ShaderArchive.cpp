@@ -0,0 +1,232 @@
+/*
+ * Test9_ShaderArchive.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ShaderArchive.h>
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error("check failed: " + message);
+}
+
+static std::vector<char> MakeData(const char* text)
+{
+    return std::vector<char>(text, text + std::strlen(text));
+}
+
+static LLGL::ShaderArchiveEntry MakeEntry(
+    const char*             key,
+    LLGL::ShaderType        type,
+    LLGL::ShadingLanguage   language,
+    LLGL::ShaderSourceType  sourceType,
+    const char*             data,
+    const char*             entryPoint  = "",
+    const char*             profile     = "")
+{
+    LLGL::ShaderArchiveEntry entry;
+    {
+        entry.key           = key;
+        entry.type          = type;
+        entry.language      = language;
+        entry.sourceType    = sourceType;
+        entry.entryPoint    = entryPoint;
+        entry.profile       = profile;
+        entry.data          = MakeData(data);
+    }
+    return entry;
+}
+
+static std::vector<char> ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string& filename, const std::vector<char>& data)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+static bool LoadFails(const std::string& filename)
+{
+    try
+    {
+        LLGL::ShaderArchive archive { filename };
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+static void CheckShaderDesc(
+    const LLGL::ShaderArchive&                  archive,
+    const char*                                 key,
+    const std::vector<LLGL::ShadingLanguage>&   languages,
+    const LLGL::ShaderArchiveEntry&             expected)
+{
+    const auto desc = archive.GetShaderDesc(key, languages);
+
+    Check(desc.type == expected.type, std::string(key) + ": shader type");
+    Check(desc.sourceType == expected.sourceType, std::string(key) + ": source type");
+    Check(desc.sourceSize == expected.data.size(), std::string(key) + ": source size");
+    Check(std::memcmp(desc.source, expected.data.data(), expected.data.size()) == 0, std::string(key) + ": source data");
+
+    if (expected.sourceType == LLGL::ShaderSourceType::CodeString)
+        Check(desc.source[desc.sourceSize] == '\0', std::string(key) + ": null terminator");
+
+    if (expected.entryPoint.empty())
+        Check(desc.entryPoint == nullptr, std::string(key) + ": empty entry point");
+    else
+        Check(desc.entryPoint != nullptr && expected.entryPoint == desc.entryPoint, std::string(key) + ": entry point");
+
+    if (expected.profile.empty())
+        Check(desc.profile == nullptr, std::string(key) + ": empty profile");
+    else
+        Check(desc.profile != nullptr && expected.profile == desc.profile, std::string(key) + ": profile");
+}
+
+void Test_RoundTrip()
+{
+    using LLGL::ShaderType;
+    using LLGL::ShadingLanguage;
+    using LLGL::ShaderSourceType;
+
+    const std::vector<LLGL::ShaderArchiveEntry> entries
+    {
+        MakeEntry("Scene.Vertex",           ShaderType::Vertex,         ShadingLanguage::GLSL,  ShaderSourceType::CodeString,   "void main() {}"),
+        MakeEntry("Scene.Vertex",           ShaderType::Vertex,         ShadingLanguage::HLSL,  ShaderSourceType::BinaryBuffer, "DXBC-VS", "VS", "vs_5_0"),
+        MakeEntry("Scene.Fragment",         ShaderType::Fragment,       ShadingLanguage::HLSL,  ShaderSourceType::BinaryBuffer, "DXBC-PS", "PS", "ps_5_0"),
+        MakeEntry("Scene.Amplification",    ShaderType::Amplification,  ShadingLanguage::SPIRV, ShaderSourceType::BinaryBuffer, "SPIRV-TASK", "main"),
+        MakeEntry("Scene.Mesh",             ShaderType::Mesh,           ShadingLanguage::SPIRV, ShaderSourceType::BinaryBuffer, "SPIRV-MESH", "main"),
+        MakeEntry("Compute",                ShaderType::Compute,        ShadingLanguage::GLSL,  ShaderSourceType::CodeString,   "layout(local_size_x = 1) in; void main() {}"),
+    };
+
+    Check(LLGL::ShaderArchive::Save("Test9.llsa", entries), "save archive");
+
+    LLGL::ShaderArchive archive { "Test9.llsa" };
+    Check(archive.GetNumEntries() == entries.size(), "number of entries");
+
+    /* Entries with the same key keep their order, so the first supported language wins */
+    CheckShaderDesc(archive, "Scene.Vertex", { ShadingLanguage::HLSL, ShadingLanguage::GLSL }, entries[0]);
+    CheckShaderDesc(archive, "Scene.Vertex", { ShadingLanguage::HLSL }, entries[1]);
+    CheckShaderDesc(archive, "Scene.Fragment", { ShadingLanguage::HLSL }, entries[2]);
+    CheckShaderDesc(archive, "Scene.Amplification", { ShadingLanguage::SPIRV }, entries[3]);
+    CheckShaderDesc(archive, "Scene.Mesh", { ShadingLanguage::SPIRV }, entries[4]);
+    CheckShaderDesc(archive, "Compute", { ShadingLanguage::GLSL }, entries[5]);
+
+    Check(archive.HasShader("Scene.Mesh", ShadingLanguage::SPIRV), "HasShader with existing key");
+    Check(!archive.HasShader("Scene.Mesh", ShadingLanguage::GLSL), "HasShader with other language");
+    Check(!archive.HasShader("Scene.Geometry", ShadingLanguage::SPIRV), "HasShader with missing key");
+
+    LLGL::ShaderDescriptor desc;
+    Check(!archive.FindShaderDesc("Scene.Fragment", { ShadingLanguage::GLSL }, desc), "FindShaderDesc with unsupported language");
+
+    std::cout << "shader archive round trip: ok" << std::endl;
+}
+
+void Test_InvalidEntries()
+{
+    auto entry = MakeEntry("Scene.Vertex", LLGL::ShaderType::Vertex, LLGL::ShadingLanguage::GLSL, LLGL::ShaderSourceType::CodeString, "void main() {}");
+
+    auto SaveFails = [](const LLGL::ShaderArchiveEntry& entry) -> bool
+    {
+        try
+        {
+            LLGL::ShaderArchive::Save("Test9-invalid.llsa", { entry });
+        }
+        catch (const std::invalid_argument&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    /* Save must reject the same shader types that Load rejects */
+    auto invalidType = entry;
+    invalidType.type = static_cast<LLGL::ShaderType>(static_cast<int>(LLGL::ShaderType::Mesh) + 1);
+    Check(SaveFails(invalidType), "save entry with invalid shader type");
+
+    auto invalidSourceType = entry;
+    invalidSourceType.sourceType = LLGL::ShaderSourceType::CodeFile;
+    Check(SaveFails(invalidSourceType), "save entry with invalid source type");
+
+    auto emptyKey = entry;
+    emptyKey.key.clear();
+    Check(SaveFails(emptyKey), "save entry with empty key");
+
+    auto emptyData = entry;
+    emptyData.data.clear();
+    Check(SaveFails(emptyData), "save entry without data");
+
+    std::cout << "shader archive invalid entries: ok" << std::endl;
+}
+
+void Test_MalformedFiles()
+{
+    auto entry = MakeEntry("Scene.Vertex", LLGL::ShaderType::Vertex, LLGL::ShadingLanguage::GLSL, LLGL::ShaderSourceType::CodeString, "void main() {}");
+    Check(LLGL::ShaderArchive::Save("Test9-single.llsa", { entry }), "save archive");
+
+    const auto original = ReadFile("Test9-single.llsa");
+
+    /* Byte offsets of the first entry and its fields (see layout in ShaderArchive.cpp) */
+    const std::size_t entryOffset       = 16;
+    const std::size_t typeOffset        = entryOffset + 4;
+    const std::size_t dataOffsetOffset  = entryOffset + 24;
+    const std::size_t dataSizeOffset    = entryOffset + 32;
+
+    auto CheckCorrupted = [&original](std::size_t offset, const void* value, std::size_t size, const char* message)
+    {
+        auto data = original;
+        std::memcpy(&data[offset], value, size);
+        WriteFile("Test9-corrupted.llsa", data);
+        Check(LoadFails("Test9-corrupted.llsa"), message);
+    };
+
+    const auto maxSize = std::numeric_limits<std::uint64_t>::max();
+    CheckCorrupted(dataSizeOffset, &maxSize, sizeof(maxSize), "load blob with maximal size");
+
+    const auto largeOffset = std::numeric_limits<std::uint64_t>::max() - 4;
+    CheckCorrupted(dataOffsetOffset, &largeOffset, sizeof(largeOffset), "load blob with out of range offset");
+
+    const auto invalidType = static_cast<std::uint32_t>(LLGL::ShaderType::Mesh) + 1;
+    CheckCorrupted(typeOffset, &invalidType, sizeof(invalidType), "load entry with invalid shader type");
+
+    /* Truncated files must be rejected as well */
+    WriteFile("Test9-corrupted.llsa", std::vector<char>(original.begin(), original.end() - 1));
+    Check(LoadFails("Test9-corrupted.llsa"), "load truncated archive");
+
+    std::cout << "shader archive malformed files: ok" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        Test_RoundTrip();
+        Test_InvalidEntries();
+        Test_MalformedFiles();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        #ifdef _WIN32
+        system("pause");
+        #endif
+        return 1;
+    }
+    return 0;
+}